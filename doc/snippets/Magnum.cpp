@@ -23,21 +23,35 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/Directory.h>
+
 #include "Magnum/AbstractShaderProgram.h"
 #include "Magnum/Buffer.h"
+#include "Magnum/CommandBuffer.h"
 #include "Magnum/Context.h"
 #include "Magnum/CubeMapTexture.h"
 #include "Magnum/DefaultFramebuffer.h"
+#include "Magnum/DeletionQueue.h"
+#include "Magnum/DrawPacket.h"
 #include "Magnum/Extensions.h"
 #include "Magnum/Framebuffer.h"
 #include "Magnum/Image.h"
+#include "Magnum/MemoryTracker.h"
 #include "Magnum/Mesh.h"
 #include "Magnum/PixelFormat.h"
 #include "Magnum/Renderer.h"
+#if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+#include "Magnum/RenderPass.h"
+#endif
 #include "Magnum/Renderbuffer.h"
 #include "Magnum/Shader.h"
 #include "Magnum/Texture.h"
 #include "Magnum/TextureFormat.h"
+#ifndef MAGNUM_TARGET_GLES
+#include "Magnum/MaterialTextureArray.h"
+#include "Magnum/TextureUploadQueue.h"
+#endif
 #include "Magnum/Version.h"
 #include "Magnum/Math/Matrix4.h"
 #include "Magnum/MeshTools/Interleave.h"
@@ -51,6 +65,11 @@
 #include "Magnum/SampleQuery.h"
 #endif
 
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+#include "Magnum/FramebufferReadback.h"
+#include "Magnum/ShaderProgramCache.h"
+#endif
+
 #ifndef MAGNUM_TARGET_WEBGL
 #include "Magnum/DebugOutput.h"
 #ifndef CORRADE_TARGET_ANDROID
@@ -61,6 +80,7 @@
 
 #ifndef MAGNUM_TARGET_GLES2
 #include "Magnum/BufferImage.h"
+#include "Magnum/Fence.h"
 #include "Magnum/PrimitiveQuery.h"
 #include "Magnum/TextureArray.h"
 #include "Magnum/TransformFeedback.h"
@@ -75,6 +95,8 @@
 
 #ifndef MAGNUM_TARGET_GLES
 #include "Magnum/RectangleTexture.h"
+#include "Magnum/SparseTextureStreamer.h"
+#include "Magnum/StreamingBuffer.h"
 #endif
 
 using namespace Magnum;
@@ -310,6 +332,71 @@ mesh.draw(shader);
 }
 #endif
 
+#ifndef MAGNUM_TARGET_GLES
+{
+/* [AbstractShaderProgram-async] */
+struct MyShader: AbstractShaderProgram {
+    explicit MyShader(const std::string& defines) {
+        Shader vert{Version::GL430, Shader::Type::Vertex};
+        Shader frag{Version::GL430, Shader::Type::Fragment};
+        vert.addSource(defines).addFile("MyShader.vert");
+        frag.addSource(defines).addFile("MyShader.frag");
+
+        /* Only submit the work, don't wait for the result */
+        Shader::submitCompile({vert, frag});
+        attachShaders({vert, frag});
+        submitLink();
+    }
+
+    void finish() { CORRADE_INTERNAL_ASSERT_OUTPUT(checkLink()); }
+};
+
+std::vector<MyShader> variants;
+variants.emplace_back("#define TEXTURED\n");
+variants.emplace_back("#define TEXTURED\n#define LIT\n");
+
+// load meshes and textures while the driver compiles ...
+
+for(MyShader& shader: variants) {
+    while(!shader.isLinkFinished()) {
+        // draw a loading screen ...
+    }
+    shader.finish();
+}
+/* [AbstractShaderProgram-async] */
+}
+
+{
+/* [AbstractShaderProgram-binary] */
+struct MyShader: AbstractShaderProgram {
+    explicit MyShader(const ShaderProgramCache& cache) {
+        Shader vert{Version::GL430, Shader::Type::Vertex};
+        Shader frag{Version::GL430, Shader::Type::Fragment};
+        vert.addFile("MyShader.vert");
+        frag.addFile("MyShader.frag");
+
+        /* Warm start, if the driver accepts the cached binary */
+        const std::string key = cache.key({vert, frag});
+        std::pair<GLenum, Containers::Array<char>> binary = cache.load(key);
+        if(setBinary(binary.first, binary.second)) return;
+
+        /* Cold start, compile and save the binary for the next time */
+        CORRADE_INTERNAL_ASSERT_OUTPUT(Shader::compile({vert, frag}));
+        attachShaders({vert, frag});
+        setRetrievableBinary(true);
+        CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+        binary = this->binary();
+        cache.save(key, binary.first, binary.second);
+    }
+};
+
+ShaderProgramCache cache{Utility::Directory::join(
+    Utility::Directory::configurationDir("MyApplication"), "shaders")};
+MyShader shader{cache};
+/* [AbstractShaderProgram-binary] */
+}
+#endif
+
 {
 Framebuffer framebuffer{{}};
 /* [AbstractFramebuffer-read1] */
@@ -374,6 +461,47 @@ for(std::size_t i: {7, 27, 56, 128}) {
 CORRADE_INTERNAL_ASSERT_OUTPUT(buffer.unmap());
 /* [Buffer-flush] */
 }
+
+#ifndef MAGNUM_TARGET_GLES
+{
+Buffer buffer;
+/* [Buffer-storage-persistent] */
+buffer.setStorage(3*200*sizeof(Vector3),
+    Buffer::StorageFlag::MapWrite|Buffer::StorageFlag::MapPersistent);
+Containers::ArrayView<Vector3> data = Containers::arrayCast<Vector3>(buffer.map(0,
+    3*200*sizeof(Vector3), Buffer::MapFlag::Write|Buffer::MapFlag::Persistent|
+    Buffer::MapFlag::FlushExplicit));
+CORRADE_INTERNAL_ASSERT(data);
+
+/* Each frame write to a different third of the buffer and flush it */
+std::size_t frame{};
+const std::size_t offset = (frame % 3)*200;
+for(std::size_t i = 0; i != 200; ++i)
+    data[offset + i] = {/*...*/};
+buffer.flushMappedRange(offset*sizeof(Vector3), 200*sizeof(Vector3));
+/* [Buffer-storage-persistent] */
+}
+
+{
+Mesh mesh;
+Shaders::Phong shader;
+/* [StreamingBuffer-usage] */
+StreamingBuffer vertices{1024*sizeof(Vector3)};
+
+/* Every frame */
+std::pair<Containers::ArrayView<char>, GLintptr> allocation =
+    vertices.allocate(64*sizeof(Vector3));
+Containers::ArrayView<Vector3> data = Containers::arrayCast<Vector3>(allocation.first);
+for(Vector3& d: data)
+    d = {/*...*/};
+mesh.setCount(data.size())
+    .addVertexBuffer(vertices.buffer(), allocation.second, Shaders::Phong::Position{});
+mesh.draw(shader);
+
+vertices.nextFrame();
+/* [StreamingBuffer-usage] */
+}
+#endif
 #endif
 
 {
@@ -728,6 +856,265 @@ group.pop();
 }
 #endif
 
+{
+Mesh mesh;
+struct: AbstractShaderProgram {} shader;
+/* [Renderer-state-block] */
+Renderer::StateBlock opaque, transparent;
+opaque.setFeature(Renderer::Feature::DepthTest, true)
+    .setFeature(Renderer::Feature::Blending, false)
+    .setDepthMask(true);
+transparent.setFeature(Renderer::Feature::DepthTest, true)
+    .setFeature(Renderer::Feature::Blending, true)
+    .setBlendFunction(Renderer::BlendFunction::SourceAlpha,
+                      Renderer::BlendFunction::OneMinusSourceAlpha)
+    .setDepthMask(false);
+
+/* Only the depth mask and blending state is touched when switching */
+Renderer::apply(opaque);
+mesh.draw(shader);
+Renderer::apply(transparent);
+mesh.draw(shader);
+/* [Renderer-state-block] */
+}
+
+{
+Mesh mesh;
+struct: AbstractShaderProgram {} shader;
+Texture2D texture;
+Renderer::StateBlock opaque;
+std::size_t objectCount{};
+UnsignedLong sortKeyForObject(std::size_t);
+/* [CommandBuffer-usage] */
+/* On a worker thread */
+CommandBuffer commands;
+for(std::size_t i = 0; i != objectCount; ++i) {
+    commands.begin(sortKeyForObject(i))
+        .applyState(opaque)
+        .bindTexture(0, texture)
+        .draw(mesh, shader);
+}
+commands.sort();
+
+/* On the thread owning the GL context */
+commands.replay();
+/* [CommandBuffer-usage] */
+}
+
+{
+Mesh rocks, trees;
+struct: AbstractShaderProgram {} shader;
+Texture2D rockTexture, treeTexture;
+/* [DrawPacket-usage] */
+/* Once, after the static geometry is set up */
+std::vector<DrawPacket> packets;
+packets.emplace_back(rocks, shader, TextureBindingSet{0, {&rockTexture}});
+packets.emplace_back(trees, shader, TextureBindingSet{0, {&treeTexture}});
+
+/* Each frame */
+DrawPacket::submit(Containers::arrayView(packets.data(), packets.size()));
+/* [DrawPacket-usage] */
+}
+
+#if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+{
+bool running{};
+void drawScene();
+/* [RenderPass-usage] */
+RenderPass<DefaultFramebuffer> pass{defaultFramebuffer};
+pass.setAttachment(DefaultFramebuffer::InvalidationAttachment::Color,
+        RenderPassLoadAction::Clear, RenderPassStoreAction::Store)
+    .setAttachment(DefaultFramebuffer::InvalidationAttachment::Depth,
+        RenderPassLoadAction::Clear, RenderPassStoreAction::DontCare)
+    .setAttachment(DefaultFramebuffer::InvalidationAttachment::Stencil,
+        RenderPassLoadAction::DontCare, RenderPassStoreAction::DontCare);
+
+while(running) {
+    pass.begin();
+    drawScene();
+    pass.end();
+}
+
+/* Assuming four bytes per pixel in each attachment */
+Debug{} << "Saved approximately"
+    << (pass.skippedLoadPixelCount() + pass.skippedStorePixelCount())*4/1024
+    << "kB of tile memory traffic";
+/* [RenderPass-usage] */
+}
+#endif
+
+{
+void loadMoreTextures();
+/* [MemoryTracker-usage] */
+MemoryTracker& tracker = Context::current().memoryTracker();
+
+/* Stream in more textures only if there's enough space left, keeping
+   64 MB in reserve */
+const std::size_t available = tracker.driverAvailableMemory();
+if(available > 64*1024*1024) loadMoreTextures();
+
+/* Print where the memory went, split by object type and label */
+tracker.printAllocations();
+Debug{} << "Textures use" << tracker.allocatedSize(MemoryObjectType::Texture)
+    << "bytes, at most" << tracker.peakAllocatedSize(MemoryObjectType::Texture);
+/* [MemoryTracker-usage] */
+}
+
+{
+Buffer chunkVertices;
+Texture2D chunkTexture;
+auto swapBuffers = []{};
+/* [DeletionQueue-usage] */
+DeletionQueue& queue = Context::current().deletionQueue();
+
+/* On a streaming thread, when a chunk gets discarded */
+queue.add(std::move(chunkVertices));
+queue.add(std::move(chunkTexture));
+
+/* On the context thread, once per frame */
+swapBuffers();
+queue.process();
+/* [DeletionQueue-usage] */
+}
+
+#ifndef MAGNUM_TARGET_GLES
+{
+Texture2D diffuse, normal;
+Buffer materials;
+/* [AbstractTexture-bindless] */
+diffuse.setStorage(1, TextureFormat::RGBA8, {256, 256});
+normal.setStorage(1, TextureFormat::RGBA8, {256, 256});
+// upload the data ...
+
+/* The handles are passed to the shader as uvec2 or sampler2D members of a
+   uniform block */
+const GLuint64 handles[]{diffuse.handle(), normal.handle()};
+materials.setData(handles, BufferUsage::StaticDraw);
+AbstractTexture::makeResident({&diffuse, &normal});
+/* [AbstractTexture-bindless] */
+}
+#endif
+
+#ifndef MAGNUM_TARGET_GLES
+{
+Texture2DArray tiles;
+struct Tile {
+    Int layer;
+    std::string filename;
+};
+std::vector<Tile> visibleTiles;
+void decodeTile(const std::string&, Containers::ArrayView<char>);
+bool running{};
+/* [TextureUploadQueue-usage] */
+/* Four 1 MB staging buffers decoded by two threads */
+TextureUploadQueue queue{1024*1024, 4, 2};
+
+for(const Tile& tile: visibleTiles) {
+    queue.enqueue(tiles, 0, {0, 0, tile.layer},
+        PixelFormat::RGBA, PixelType::UnsignedByte, {512, 512},
+        [tile](Containers::ArrayView<char> data) {
+            decodeTile(tile.filename, data);
+        });
+}
+
+while(running) {
+    for(UnsignedInt id: queue.update()) {
+        // the upload with this ID is now complete ...
+        static_cast<void>(id);
+    }
+
+    // draw the frame ...
+}
+/* [TextureUploadQueue-usage] */
+}
+#endif
+
+#ifndef MAGNUM_TARGET_GLES
+{
+std::vector<SparseTextureStreamer::Page> readFeedback();
+void decodeTerrainPage(const SparseTextureStreamer::Page&, Containers::ArrayView<char>);
+Texture2D minLevels;
+bool running{};
+/* [SparseTextureStreamer-usage] */
+/* 64k x 64k virtual texture, at most 2048 pages resident at a time */
+const Vector2i pageSize = Texture2D::sparsePageSize(TextureFormat::RGBA8);
+Texture2D terrain;
+terrain.setSparse()
+    .setStorage(17, TextureFormat::RGBA8, Vector2i{65536});
+
+TextureUploadQueue queue{std::size_t(pageSize.product()*4), 8, 4};
+SparseTextureStreamer streamer{terrain, queue, Vector2i{65536}, 17, pageSize,
+    PixelFormat::RGBA, PixelType::UnsignedByte, 2048, decodeTerrainPage};
+
+while(running) {
+    /* Pages written to the feedback buffer in the previous frame */
+    const std::vector<SparseTextureStreamer::Page> feedback = readFeedback();
+    streamer.request(Containers::arrayView(feedback.data(), feedback.size()));
+    streamer.update(queue.update());
+    minLevels.setSubImage(0, {}, streamer.minLevelTable());
+
+    // draw the frame, clamping the LOD to minLevels ...
+}
+/* [SparseTextureStreamer-usage] */
+}
+#endif
+
+#ifndef MAGNUM_TARGET_GLES
+{
+struct Material {
+    std::string diffuseFilename;
+    Int layer;
+};
+std::vector<Material> materials;
+void decodeDiffuse(const std::string&, Containers::ArrayView<char>);
+bool running{};
+/* [MaterialTextureArray-usage] */
+TextureUploadQueue queue{512*512*4, 4, 2};
+MaterialTextureArray diffuse{queue, TextureFormat::RGBA8, {512, 512}, 256};
+
+for(Material& material: materials) {
+    const std::string filename = material.diffuseFilename;
+    material.layer = diffuse.add(PixelFormat::RGBA, PixelType::UnsignedByte,
+        [filename](Containers::ArrayView<char> data) {
+            decodeDiffuse(filename, data);
+        });
+}
+
+while(running) {
+    diffuse.update(queue.update());
+
+    // put material.layer into per-instance data of drawables whose material
+    // layer isReady(), bind diffuse.texture() once and draw them all ...
+}
+/* [MaterialTextureArray-usage] */
+}
+#endif
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+{
+Framebuffer framebuffer{{}};
+Range2Di viewport;
+bool running{};
+void encodeVideoFrame(const ImageView2D&);
+/* [FramebufferReadback-usage] */
+FramebufferReadback readback{PixelFormat::RGBA, PixelType::UnsignedByte};
+
+while(running) {
+    // draw the frame ...
+
+    /* Drops the frame if all slots are still busy */
+    readback.read(framebuffer, viewport);
+
+    /* Consume whatever the GPU already finished */
+    while(readback.isNextAvailable()) {
+        encodeVideoFrame(readback.mapNext());
+        readback.unmap();
+    }
+}
+/* [FramebufferReadback-usage] */
+}
+#endif
+
 {
 struct MyShader {
     enum: UnsignedInt {
@@ -976,6 +1363,22 @@ CORRADE_COMPARE(Magnum::Renderer::error(), Magnum::Renderer::Error::NoError);
 };
 #endif
 
+#ifndef MAGNUM_TARGET_GLES2
+{
+Buffer buffer;
+/* [Fence-usage] */
+Fence fence;
+buffer.setSubData(0, {/*...*/});
+// rendering using the buffer...
+fence.insert();
+
+// later, before updating the buffer again
+if(!fence.isSignaled())
+    fence.clientWait(std::chrono::milliseconds{5});
+/* [Fence-usage] */
+}
+#endif
+
 #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
 {
 /* [PrimitiveQuery-usage] */
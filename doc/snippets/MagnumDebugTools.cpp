@@ -0,0 +1,152 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <fstream>
+#include <thread>
+
+#include "Magnum/DefaultFramebuffer.h"
+#include "Magnum/Timeline.h"
+#include "Magnum/DebugTools/Profiler.h"
+#ifndef MAGNUM_TARGET_WEBGL
+#include "Magnum/DebugTools/FrameProfiler.h"
+#endif
+
+using namespace Magnum;
+
+int main() {
+
+{
+DebugTools::Profiler p;
+void cullScene();
+void drawScene();
+/* [Profiler-nested] */
+DebugTools::Profiler::Section draw = p.addSection("Drawing");
+DebugTools::Profiler::Section culling = p.addSection("Culling", draw);
+
+p.start(draw);
+p.begin(culling);
+cullScene();
+p.end();
+drawScene();
+p.start();
+/* [Profiler-nested] */
+}
+
+{
+DebugTools::Profiler p;
+bool running{};
+void streamAssets();
+/* [Profiler-threads] */
+DebugTools::Profiler::Section streaming = p.addSection("Streaming");
+DebugTools::Profiler::Recorder& recorder = p.addRecorder();
+
+std::thread worker{[&]() {
+    while(running) {
+        recorder.begin(streaming);
+        streamAssets();
+        recorder.end();
+    }
+}};
+/* [Profiler-threads] */
+worker.join();
+}
+
+#ifndef MAGNUM_TARGET_WEBGL
+{
+bool running{};
+void updatePhysics();
+void drawShadows();
+void drawScene();
+void swapBuffers();
+/* [FrameProfiler-usage] */
+DebugTools::FrameProfiler profiler;
+DebugTools::FrameProfiler::Section physics = profiler.addSection("Physics");
+DebugTools::FrameProfiler::Section draw = profiler.addSection("Draw");
+DebugTools::FrameProfiler::Section shadows = profiler.addSection("Shadows", draw);
+DebugTools::FrameProfiler::Section scene = profiler.addSection("Scene", draw);
+
+while(running) {
+    profiler.begin(physics);
+    updatePhysics();
+    profiler.end();
+
+    profiler.begin(draw);
+    defaultFramebuffer.clear(FramebufferClear::Color|FramebufferClear::Depth);
+    profiler.begin(shadows);
+    drawShadows();
+    profiler.end();
+    profiler.begin(scene);
+    drawScene();
+    profiler.end();
+    profiler.end();
+
+    swapBuffers();
+    profiler.nextFrame();
+}
+
+profiler.printStatistics();
+/* [FrameProfiler-usage] */
+}
+
+{
+DebugTools::FrameProfiler profiler;
+DebugTools::FrameProfiler::Section draw = profiler.addSection("Draw");
+bool running{};
+std::size_t drawCallCount{};
+void drawScene();
+void swapBuffers();
+/* [FrameProfiler-trace] */
+std::ofstream trace{"trace.json"};
+profiler.setTraceOutput(&trace);
+
+while(running) {
+    profiler.begin(draw);
+    drawScene();
+    profiler.end();
+    profiler.addCounter("Draw calls", drawCallCount);
+
+    swapBuffers();
+    profiler.nextFrame();
+}
+
+/* Terminates the JSON array */
+profiler.setTraceOutput(nullptr);
+/* [FrameProfiler-trace] */
+}
+#endif
+
+{
+DebugTools::Profiler profiler;
+/* [Timeline-hitchCallback] */
+Timeline timeline;
+timeline.setFrameHistorySize(120)
+    .setHitchCallback(1.0f/20.0f, [](Float duration, UnsignedLong frame, void* userData) {
+        Warning{} << "Frame" << frame << "took" << duration*1000.0f << "ms";
+        static_cast<DebugTools::Profiler*>(userData)->printStatistics();
+    }, &profiler);
+/* [Timeline-hitchCallback] */
+}
+
+}
@@ -24,12 +24,18 @@
 */
 
 #include "Magnum/Buffer.h"
+#include "Magnum/ThreadPool.h"
 #include "Magnum/Math/Color.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/MeshTools/Codec.h"
 #include "Magnum/MeshTools/CombineIndexedArrays.h"
 #include "Magnum/MeshTools/CompressIndices.h"
 #include "Magnum/MeshTools/Duplicate.h"
 #include "Magnum/MeshTools/GenerateFlatNormals.h"
+#include "Magnum/MeshTools/GenerateWireframeVertexIndices.h"
 #include "Magnum/MeshTools/Interleave.h"
+#include "Magnum/MeshTools/Optimize.h"
+#include "Magnum/MeshTools/Pack.h"
 #include "Magnum/MeshTools/RemoveDuplicates.h"
 #include "Magnum/MeshTools/Transform.h"
 
@@ -81,6 +87,34 @@ Containers::Array<UnsignedShort> indexData =
 /* [compressIndicesAs] */
 }
 
+{
+/* [encodeVertexBuffer] */
+std::vector<Vector3> positions;
+std::vector<UnsignedInt> indices;
+
+/* Quantize and reorder the data so neighboring vertices are similar */
+std::vector<Math::Vector3<UnsignedShort>> packed(positions.size());
+Range3D range = MeshTools::packPositionsInto(
+    Containers::arrayView(positions.data(), positions.size()),
+    Containers::arrayView(packed.data(), packed.size()));
+MeshTools::optimizeVertexCacheInPlace(
+    Containers::arrayView(indices.data(), indices.size()), packed.size());
+
+/* Encode for storage or transfer */
+Containers::Array<char> vertexData = MeshTools::encodeVertexBuffer(
+    {reinterpret_cast<const char*>(packed.data()), packed.size()*6}, 6);
+Containers::Array<char> indexData = MeshTools::encodeIndexBuffer(
+    Containers::arrayView(indices.data(), indices.size()));
+
+/* ... and decode on the other side */
+Containers::Optional<Containers::Array<char>> decoded =
+    MeshTools::decodeVertexBuffer(vertexData);
+/* [encodeVertexBuffer] */
+static_cast<void>(range);
+static_cast<void>(indexData);
+static_cast<void>(decoded);
+}
+
 {
 /* [generateFlatNormals] */
 std::vector<UnsignedInt> vertexIndices;
@@ -93,6 +127,19 @@ std::tie(normalIndices, normals) =
 /* [generateFlatNormals] */
 }
 
+{
+/* [generateWireframeVertexIndices] */
+std::vector<UnsignedInt> indices;
+std::vector<Vector3> positions;
+
+std::vector<UnsignedInt> mapping;
+std::vector<Float> vertexIndices;
+std::tie(mapping, vertexIndices) =
+    MeshTools::generateWireframeVertexIndices(indices, positions.size());
+positions = MeshTools::duplicate(mapping, positions);
+/* [generateWireframeVertexIndices] */
+}
+
 {
 struct MyShader {
     typedef Attribute<0, Vector3> Position;
@@ -121,6 +168,20 @@ auto data = MeshTools::interleave(positions, weights, 2, vertexColors, 1);
 /* [interleave2] */
 }
 
+{
+/* [interleaveInto-buffer] */
+std::vector<Vector3> positions;
+std::vector<Vector3> normals;
+
+Buffer vertexBuffer;
+MeshTools::interleaveInto(vertexBuffer, BufferUsage::StaticDraw, positions, normals);
+
+/* Or in parallel, for large meshes */
+ThreadPool pool;
+MeshTools::interleaveInto(vertexBuffer, BufferUsage::StaticDraw, pool, positions, normals);
+/* [interleaveInto-buffer] */
+}
+
 {
 /* [removeDuplicates1] */
 std::vector<UnsignedInt> indices;
@@ -24,11 +24,17 @@
 */
 
 #include <thread>
+#include <vector>
+#include <Magnum/Buffer.h>
+#include <Magnum/Fence.h>
+#include <Magnum/Renderer.h>
 #include <Magnum/Platform/WindowlessEglApplication.h>
 #include <Magnum/Platform/Context.h>
 
 using namespace Magnum;
 
+namespace A {
+
 /* [thread] */
 int main() {
     Platform::WindowlessGLContext glContext{{}};
@@ -45,3 +51,76 @@ int main() {
     worker.join();
 }
 /* [thread] */
+
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+namespace B {
+
+/* [thread-shared] */
+int main() {
+    Platform::WindowlessGLContext glContext{{}};
+    Platform::WindowlessGLContext workerGLContext{
+        Platform::WindowlessGLContext::Configuration{}
+            .setSharedContext(glContext.glContext())};
+    glContext.makeCurrent();
+    Platform::Context context;
+
+    Buffer buffer;
+    Fence uploaded;
+
+    std::thread worker{[&]{
+        workerGLContext.makeCurrent();
+        Platform::Context workerContext;
+
+        // Load and decode the data ...
+        std::vector<char> data;
+        buffer.setData(data, BufferUsage::StaticDraw);
+
+        /* Signal the main context that the data are there */
+        uploaded.insert();
+        Renderer::flush();
+    }};
+
+    // Independent main application code here ...
+
+    worker.join();
+
+    /* Make the GPU wait for the upload before the buffer is used */
+    uploaded.wait();
+
+    // Use the buffer here ...
+}
+/* [thread-shared] */
+
+}
+#endif
+
+#ifndef MAGNUM_TARGET_WEBGL
+namespace C {
+
+/* [devices] */
+int main() {
+    /* Create one context on every GPU, no X server needed */
+    std::vector<Platform::WindowlessEglContext> glContexts;
+    for(UnsignedInt i = 0; i != Platform::WindowlessEglContext::deviceCount(); ++i)
+        glContexts.emplace_back(Platform::WindowlessEglContext::Configuration{}
+            .setDevice(i));
+
+    /* Each GPU processes its own share of the jobs in a dedicated thread */
+    std::vector<std::thread> workers;
+    for(std::size_t i = 0; i != glContexts.size(); ++i)
+        workers.emplace_back([&glContexts, i]{
+            glContexts[i].makeCurrent();
+            Platform::Context context;
+
+            // Render every glContexts.size()-th job to an offscreen
+            // framebuffer and read the result back ...
+        });
+
+    for(std::thread& worker: workers) worker.join();
+}
+/* [devices] */
+
+}
+#endif
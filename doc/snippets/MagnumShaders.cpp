@@ -24,17 +24,26 @@
 */
 
 #include <numeric>
+#include <vector>
+#include <Corrade/Containers/Array.h>
 
 #include "Magnum/Buffer.h"
 #include "Magnum/DefaultFramebuffer.h"
 #include "Magnum/Mesh.h"
+#include "Magnum/Renderer.h"
+#include "Magnum/Std140.h"
 #include "Magnum/Texture.h"
 #include "Magnum/Math/Color.h"
 #include "Magnum/MeshTools/Duplicate.h"
+#include "Magnum/MeshTools/GenerateWireframeVertexIndices.h"
 #include "Magnum/Shaders/DistanceFieldVector.h"
 #include "Magnum/Shaders/Flat.h"
 #include "Magnum/Shaders/MeshVisualizer.h"
 #include "Magnum/Shaders/Phong.h"
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+#include "Magnum/Shaders/PhongLightGrid.h"
+#endif
+#include "Magnum/Shaders/ShaderCache.h"
 #include "Magnum/Shaders/Vector.h"
 #include "Magnum/Shaders/VertexColor.h"
 
@@ -202,6 +211,60 @@ mesh.draw(shader);
 /* [Flat-usage-textured2] */
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+{
+Mesh mesh;
+std::size_t objectCount{};
+Matrix4* transformationProjectionMatrices{};
+Color4* colors{};
+/* [Flat-usage-uniform-buffers] */
+/* Fill data for all draws, each aligned as required by the driver */
+const std::size_t stride = Std140::alignedStride(
+    sizeof(Shaders::Flat3D::DrawUniform), Buffer::uniformOffsetAlignment());
+Containers::Array<char> data{Containers::ValueInit, objectCount*stride};
+for(std::size_t i = 0; i != objectCount; ++i)
+    *reinterpret_cast<Shaders::Flat3D::DrawUniform*>(data.data() + i*stride) =
+        Shaders::Flat3D::DrawUniform{transformationProjectionMatrices[i], colors[i]};
+
+Buffer uniforms{Buffer::TargetHint::Uniform};
+uniforms.setData(data, BufferUsage::DynamicDraw);
+
+/* Each draw then needs just a range bind */
+Shaders::Flat3D shader{Shaders::Flat3D::Flag::UniformBuffers};
+for(std::size_t i = 0; i != objectCount; ++i) {
+    shader.bindDrawBuffer(uniforms, i*stride, sizeof(Shaders::Flat3D::DrawUniform));
+    mesh.draw(shader);
+}
+/* [Flat-usage-uniform-buffers] */
+}
+#endif
+
+{
+Mesh mesh;
+Matrix4 projectionMatrix;
+/* [Flat-usage-instancing] */
+struct Instance {
+    Matrix4 transformationMatrix;
+    Color4 color;
+} instanceData[100]{
+    // ...
+};
+
+Buffer instances;
+instances.setData(instanceData, BufferUsage::DynamicDraw);
+mesh.addVertexBufferInstanced(instances, 1, 0,
+        Shaders::Flat3D::TransformationMatrix{},
+        Shaders::Flat3D::Color{Shaders::Flat3D::Color::Components::Four})
+    .setInstanceCount(Containers::arraySize(instanceData));
+
+Shaders::Flat3D shader{Shaders::Flat3D::Flag::InstancedTransformation|
+                       Shaders::Flat3D::Flag::InstancedColor};
+shader.setTransformationProjectionMatrix(projectionMatrix);
+
+mesh.draw(shader);
+/* [Flat-usage-instancing] */
+}
+
 {
 /* [MeshVisualizer-usage-geom1] */
 struct Vertex {
@@ -278,6 +341,34 @@ mesh.addVertexBuffer(vertices, 0, Shaders::MeshVisualizer::Position{});
 /* [MeshVisualizer-usage-no-geom] */
 }
 
+{
+/* [MeshVisualizer-usage-vertex-index-attribute] */
+std::vector<UnsignedInt> indices{
+    // ...
+};
+std::vector<Vector3> positions{
+    // ...
+};
+
+/* Assign vertex indices, duplicating vertices where needed */
+std::vector<UnsignedInt> mapping;
+std::vector<Float> vertexIndex;
+std::tie(mapping, vertexIndex) =
+    MeshTools::generateWireframeVertexIndices(indices, positions.size());
+
+Buffer vertices, vertexIndices, indexBuffer;
+vertices.setData(MeshTools::duplicate(mapping, positions), BufferUsage::StaticDraw);
+vertexIndices.setData(vertexIndex, BufferUsage::StaticDraw);
+indexBuffer.setData(indices, BufferUsage::StaticDraw);
+
+Mesh mesh;
+mesh.setCount(indices.size())
+    .addVertexBuffer(vertices, 0, Shaders::MeshVisualizer::Position{})
+    .addVertexBuffer(vertexIndices, 0, Shaders::MeshVisualizer::VertexIndex{})
+    .setIndexBuffer(indexBuffer, 0, Mesh::IndexType::UnsignedInt);
+/* [MeshVisualizer-usage-vertex-index-attribute] */
+}
+
 #if !defined(__GNUC__) || defined(__clang__) || __GNUC__*100 + __GNUC_MINOR__ >= 500
 {
 /* [Phong-usage-colored1] */
@@ -365,6 +456,126 @@ shader.bindTextures(&ambientAlphaTexture, &diffuseAlphaTexture, nullptr)
 /* [Phong-usage-alpha] */
 }
 
+{
+Mesh mesh;
+Matrix4 cameraMatrix, projectionMatrix;
+/* [Phong-usage-instancing] */
+struct Instance {
+    Matrix4 transformationMatrix;
+    Color4 color;
+} instanceData[100]{
+    // ...
+};
+
+Buffer instances;
+instances.setData(instanceData, BufferUsage::DynamicDraw);
+mesh.addVertexBufferInstanced(instances, 1, 0,
+        Shaders::Phong::TransformationMatrix{},
+        Shaders::Phong::Color{Shaders::Phong::Color::Components::Four})
+    .setInstanceCount(Containers::arraySize(instanceData));
+
+Shaders::Phong shader{Shaders::Phong::Flag::InstancedTransformation|
+                      Shaders::Phong::Flag::InstancedColor};
+shader.setLightPosition({5.0f, 5.0f, 7.0f})
+    .setTransformationMatrix(cameraMatrix)
+    .setNormalMatrix(cameraMatrix.rotation())
+    .setProjectionMatrix(projectionMatrix);
+
+mesh.draw(shader);
+/* [Phong-usage-instancing] */
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+{
+Mesh mesh;
+Matrix4 cameraMatrix, projectionMatrix;
+/* [Phong-usage-skinning] */
+struct Vertex {
+    Vector3 position;
+    Vector3 normal;
+    Vector4ui jointIds;
+    Vector4 weights;
+};
+Vertex data[60]{
+    // ...
+};
+
+Buffer vertices;
+vertices.setData(data, BufferUsage::StaticDraw);
+mesh.addVertexBuffer(vertices, 0,
+    Shaders::Phong::Position{},
+    Shaders::Phong::Normal{},
+    Shaders::Phong::JointIds{},
+    Shaders::Phong::Weights{});
+
+Shaders::Phong shader{Shaders::Phong::Flag::Skinning, 32};
+Buffer joints{Buffer::TargetHint::Uniform};
+
+// each frame
+Matrix4 jointMatrices[32];
+// ... fill the palette with animated joint transformations ...
+joints.setData(jointMatrices, BufferUsage::StreamDraw);
+shader.bindJointBuffer(joints)
+    .setTransformationMatrix(cameraMatrix)
+    .setNormalMatrix(cameraMatrix.rotation())
+    .setProjectionMatrix(projectionMatrix);
+mesh.draw(shader);
+/* [Phong-usage-skinning] */
+}
+#endif
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+{
+Mesh mesh;
+Matrix4 cameraMatrix, projectionMatrix;
+std::vector<Vector3> lightPositions;
+std::vector<Color3> lightColors;
+/* [Phong-usage-tiled-lights] */
+Shaders::PhongLightGrid grid;
+Shaders::Phong shader{Shaders::Phong::Flag::TiledLights};
+
+// each frame
+std::vector<Shaders::PhongLight> lights;
+for(std::size_t i = 0; i != lightPositions.size(); ++i)
+    lights.emplace_back(cameraMatrix.transformPoint(lightPositions[i]), 2.5f,
+        lightColors[i]);
+grid.setLights(projectionMatrix, defaultFramebuffer.viewport().size(),
+    Containers::arrayView(lights.data(), lights.size()));
+
+shader.bindLightGrid(grid)
+    .setLightColor(0x000000_rgbf)
+    .setTransformationMatrix(cameraMatrix)
+    .setNormalMatrix(cameraMatrix.rotation())
+    .setProjectionMatrix(projectionMatrix);
+mesh.draw(shader);
+/* [Phong-usage-tiled-lights] */
+}
+#endif
+
+{
+Mesh mesh;
+Matrix4 transformationMatrix, projectionMatrix;
+/* [Phong-usage-depth-only] */
+Shaders::Phong depthShader{Shaders::Phong::Flag::DepthOnly};
+Shaders::Phong shader;
+
+/* Depth pre-pass */
+Renderer::setColorMask(false, false, false, false);
+depthShader.setTransformationMatrix(transformationMatrix)
+    .setProjectionMatrix(projectionMatrix);
+mesh.draw(depthShader);
+
+/* Shading only the visible fragments */
+Renderer::setColorMask(true, true, true, true);
+Renderer::setDepthMask(false);
+Renderer::setDepthFunction(Renderer::DepthFunction::LessOrEqual);
+shader.setTransformationMatrix(transformationMatrix)
+    .setNormalMatrix(transformationMatrix.rotation())
+    .setProjectionMatrix(projectionMatrix);
+mesh.draw(shader);
+/* [Phong-usage-depth-only] */
+}
+
 #if !defined(__GNUC__) || defined(__clang__) || __GNUC__*100 + __GNUC_MINOR__ >= 500
 {
 /* [Vector-usage1] */
@@ -429,4 +640,19 @@ mesh.draw(shader);
 }
 #endif
 
+{
+/* [ShaderCache-usage] */
+Shaders::ShaderCache cache;
+cache.precompile<Shaders::Phong>({
+    {}, Shaders::Phong::Flag::DiffuseTexture,
+    Shaders::Phong::Flag::DiffuseTexture|Shaders::Phong::Flag::SpecularTexture});
+
+// ...
+
+/* Returns the already compiled variant */
+Shaders::Phong& shader = cache.get<Shaders::Phong>(Shaders::Phong::Flag::DiffuseTexture);
+/* [ShaderCache-usage] */
+static_cast<void>(shader);
+}
+
 }
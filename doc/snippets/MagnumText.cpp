@@ -23,9 +23,13 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include "Magnum/Image.h"
+#include "Magnum/Shaders/DistanceFieldVector.h"
 #include "Magnum/Shaders/Vector.h"
 #include "Magnum/Text/AbstractFont.h"
 #include "Magnum/Text/DistanceFieldGlyphCache.h"
+#include "Magnum/Text/DynamicGlyphCache.h"
+#include "Magnum/Text/MultiChannelDistanceFieldGlyphCache.h"
 #include "Magnum/Text/Renderer.h"
 
 using namespace Magnum;
@@ -33,6 +37,20 @@ using namespace Magnum::Math::Literals;
 
 int main() {
 
+{
+std::unique_ptr<Text::AbstractFont> font;
+Text::GlyphCache cache{Vector2i{512}};
+/* [AbstractFont-layout-cache] */
+/* Remember up to 256 most recently laid out strings */
+font->setLayoutCacheSize(256);
+
+/* Laid out only on the first call, taken from the cache afterwards */
+Text::Renderer2D renderer{*font, cache, 0.15f};
+renderer.reserve(16, BufferUsage::DynamicDraw, BufferUsage::StaticDraw);
+renderer.render("Menu");
+/* [AbstractFont-layout-cache] */
+}
+
 {
 /* [DistanceFieldGlyphCache-usage] */
 std::unique_ptr<Text::AbstractFont> font;
@@ -43,6 +61,45 @@ font->fillGlyphCache(cache, "abcdefghijklmnopqrstuvwxyz"
 /* [DistanceFieldGlyphCache-usage] */
 }
 
+{
+struct GlyphImage {
+    UnsignedInt glyph;
+    Vector2i position;
+    Range2Di rectangle;
+    Image2D image;
+};
+/* [MultiChannelDistanceFieldGlyphCache-usage] */
+/* Glyph images generated offline from glyph outlines, already scaled to the
+   cache texture size */
+std::vector<GlyphImage> images;
+
+Text::MultiChannelDistanceFieldGlyphCache cache{Vector2i{2048}, Vector2i{256}, 16};
+for(const GlyphImage& i: images) {
+    cache.insert(i.glyph, i.position, i.rectangle);
+    cache.setDistanceFieldImage(i.rectangle.min()/8, i.image);
+}
+
+/* Render with a median of the three channels */
+Shaders::DistanceFieldVector2D shader{Shaders::DistanceFieldVector2D::Flag::MultiChannel};
+shader.bindVectorTexture(cache.texture());
+/* [MultiChannelDistanceFieldGlyphCache-usage] */
+}
+
+{
+std::string text;
+/* [DynamicGlyphCache-usage] */
+std::unique_ptr<Text::AbstractFont> font;
+Text::DynamicGlyphCache cache{Vector2i{512}};
+Text::Renderer2D renderer{*font, cache, 0.15f};
+renderer.reserve(256, BufferUsage::DynamicDraw, BufferUsage::StaticDraw);
+
+/* Each frame, rasterize glyphs that aren't in the cache yet */
+cache.nextFrame();
+cache.prepare(*font, text);
+renderer.render(text);
+/* [DynamicGlyphCache-usage] */
+}
+
 {
 /* [GlyphCache-usage] */
 std::unique_ptr<Text::AbstractFont> font;
@@ -97,4 +154,53 @@ renderer.mesh().draw(shader);
 /* [Renderer-usage2] */
 }
 
+{
+Matrix3 projectionMatrix;
+std::unique_ptr<Text::AbstractFont> font;
+Text::GlyphCache cache{Vector2i{512}};
+Shaders::Vector2D shader;
+/* [BatchRenderer-usage] */
+/* Initialize the batch and reserve memory for glyphs of all labels */
+Text::BatchRenderer2D batch{*font, cache, 0.05f, Text::Alignment::MiddleCenter};
+batch.reserve(4096, BufferUsage::DynamicDraw, BufferUsage::StaticDraw);
+
+/* Add the labels, keep their IDs for later updates */
+UnsignedInt title = batch.addLabel("Score", Matrix3::translation({0.0f, 0.9f}), 0xffffff_rgbf);
+UnsignedInt score = batch.addLabel("0", Matrix3::translation({0.0f, 0.8f}), 0xffcc00_rgbf);
+
+/* Change the labels, upload at most once per frame */
+batch.setLabelText(score, "1500");
+batch.setLabelTransformation(title, Matrix3::translation({0.0f, 0.95f}));
+batch.update();
+
+/* Draw the whole batch, one draw call for each distinct color */
+shader.setTransformationProjectionMatrix(projectionMatrix)
+    .bindVectorTexture(cache.texture());
+batch.draw(shader);
+/* [BatchRenderer-usage] */
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+{
+Matrix3 projectionMatrix;
+std::unique_ptr<Text::AbstractFont> font;
+Text::GlyphCache cache{Vector2i{512}};
+/* [Renderer-instanced] */
+/* The shader expands each glyph instance to a quad */
+Shaders::Vector2D shader{Shaders::Vector2D::Flag::InstancedGlyphs};
+
+Text::InstancedRenderer2D renderer{*font, cache, 0.15f, Text::Alignment::LineCenter};
+renderer.reserve(32, BufferUsage::DynamicDraw);
+
+/* Each update uploads just one record per glyph */
+renderer.render("Hello World Countdown: 10");
+
+shader.setTransformationProjectionMatrix(projectionMatrix)
+    .setColor(0xffffff_rgbf)
+    .bindVectorTexture(cache.texture());
+renderer.mesh().draw(shader);
+/* [Renderer-instanced] */
+}
+#endif
+
 }
@@ -0,0 +1,54 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <tuple>
+
+#include "Magnum/TextureTools/Atlas.h"
+
+using namespace Magnum;
+
+int main() {
+
+{
+std::vector<Vector2i> spriteSizes;
+Vector2i newSpriteSize;
+/* [AtlasPacker] */
+/* Pack all sprites known up front, allowing them to be rotated and spread
+   over more pages if they don't fit into one */
+TextureTools::AtlasPacker packer{Vector2i{1024}, Vector2i{1},
+    TextureTools::AtlasPacker::Flag::AllowRotation|
+    TextureTools::AtlasPacker::Flag::MultiplePages};
+std::vector<std::tuple<Int, Range2Di, bool>> sprites = packer.add(spriteSizes);
+
+/* Add more sprites later */
+Int page;
+Range2Di rectangle;
+bool rotated;
+std::tie(page, rectangle, rotated) = packer.add(newSpriteSize);
+/* [AtlasPacker] */
+static_cast<void>(sprites);
+}
+
+}
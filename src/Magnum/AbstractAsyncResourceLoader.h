@@ -0,0 +1,337 @@
+#ifndef Magnum_AbstractAsyncResourceLoader_h
+#define Magnum_AbstractAsyncResourceLoader_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::AbstractAsyncResourceLoader
+ */
+
+#include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <vector>
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include <thread>
+#endif
+#include <Corrade/Containers/Optional.h>
+
+#include "Magnum/AbstractResourceLoader.h"
+
+namespace Magnum {
+
+/**
+@brief Base for asynchronous resource loaders
+
+Splits loading of each resource into two steps --- decoding, which is done on
+worker threads, and uploading, which is done on the thread calling
+@ref update(), usually the one with the GL context. Requests coming from
+@ref ResourceManager::get() are put into a queue, the resources are in the
+@ref ResourceState::Loading state (or @ref ResourceState::LoadingFallback)
+until they are uploaded, so @ref ResourceManager::get() never blocks on the
+loading itself.
+
+@section AbstractAsyncResourceLoader-subclassing Subclassing
+
+Implement @ref doDecode() returning the decoded data, such as an image read
+from a file, or an empty optional if the resource was not found, and
+@ref doUpload() that creates the resource from the decoded data and passes it
+to @ref set():
+
+@code{.cpp}
+class TextureResourceLoader: public AbstractAsyncResourceLoader<Texture2D, Trade::ImageData2D> {
+    Containers::Optional<Trade::ImageData2D> doDecode(ResourceKey key) override {
+        // Read and decode the file, on a worker thread...
+    }
+
+    void doUpload(ResourceKey key, Trade::ImageData2D&& image) override {
+        // On the thread calling update()
+        Texture2D* texture = new Texture2D;
+        texture->setStorage(1, TextureFormat::RGBA8, image.size())
+            .setSubImage(0, {}, image);
+        set(key, texture, ResourceDataState::Final, ResourcePolicy::Resident);
+    }
+};
+@endcode
+
+@ref doDecode() is called from worker threads and thus has to be
+thread-safe, it shouldn't access the manager nor call @ref set().
+@ref doUpload() and @ref setNotFound() for resources that failed to decode
+are called only from @ref update().
+
+@section AbstractAsyncResourceLoader-priorities Priorities
+
+Requests having higher priority are decoded and uploaded first, new requests
+have priority @cpp 0.0f @ce. The priorities can be changed with
+@ref setPriority() or re-ranked all at once, for example every frame based on
+distance from the camera:
+
+@code{.cpp}
+loader.updatePriorities([&](ResourceKey key) {
+    return -(positions[key] - cameraPosition).dot();
+});
+loader.update(4);
+@endcode
+
+@section AbstractAsyncResourceLoader-threading Threading
+
+Because the worker threads call virtual functions, a subclass that may be
+destroyed while a decode is in progress has to call @ref stop() in its
+destructor. On platforms without thread support (such as
+@ref CORRADE_TARGET_EMSCRIPTEN "Emscripten") the decoding is done in
+@ref update() on the calling thread.
+*/
+template<class T, class Decoded> class AbstractAsyncResourceLoader: public AbstractResourceLoader<T> {
+    public:
+        /**
+         * @brief Constructor
+         * @param threadCount   Count of worker threads
+         *
+         * Expects that @p threadCount is non-zero. Ignored on platforms
+         * without thread support.
+         */
+        explicit AbstractAsyncResourceLoader(UnsignedInt threadCount = 1);
+
+        /**
+         * @brief Destructor
+         *
+         * Calls @ref stop().
+         */
+        ~AbstractAsyncResourceLoader();
+
+        /**
+         * @brief Set priority of a queued request
+         *
+         * If the resource is not queued anymore, the function does nothing.
+         * @see @ref updatePriorities()
+         */
+        void setPriority(ResourceKey key, Float priority);
+
+        /**
+         * @brief Update priorities of all queued requests
+         *
+         * Calls @p priority for each request that wasn't decoded yet and
+         * each decoded that wasn't uploaded yet.
+         */
+        void updatePriorities(const std::function<Float(ResourceKey)>& priority);
+
+        /**
+         * @brief Count of pending requests
+         *
+         * Requests that are queued, being decoded or waiting for upload.
+         */
+        std::size_t pendingCount() const;
+
+        /**
+         * @brief Upload decoded resources
+         * @param maxCount  Max count of resources to upload
+         *
+         * Calls @ref doUpload() for at most @p maxCount decoded resources
+         * with the highest priority and @ref setNotFound() for resources that
+         * failed to decode. On platforms without thread support, decodes at
+         * most @p maxCount queued requests first.
+         */
+        void update(std::size_t maxCount = ~std::size_t{});
+
+        /**
+         * @brief Stop the worker threads
+         *
+         * Waits for decodes in progress to finish, queued requests are
+         * not decoded anymore. Decoded resources can be still uploaded with
+         * @ref update(). Calling the function again does nothing.
+         */
+        void stop();
+
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    private:
+    #else
+    protected:
+    #endif
+        /**
+         * @brief Decode the resource
+         *
+         * Called from a worker thread. Return an empty optional if the
+         * resource was not found.
+         */
+        virtual Containers::Optional<Decoded> doDecode(ResourceKey key) = 0;
+
+        /**
+         * @brief Upload the resource
+         *
+         * Called from @ref update(). The implementation is expected to call
+         * @ref set().
+         */
+        virtual void doUpload(ResourceKey key, Decoded&& decoded) = 0;
+
+    private:
+        struct Request {
+            ResourceKey key;
+            Float priority;
+            Containers::Optional<Decoded> decoded;
+        };
+        typedef std::unique_lock<std::mutex> Lock;
+
+        void doLoad(ResourceKey key) override final;
+        void doLoadBatch(Containers::ArrayView<const ResourceKey> keys) override final;
+
+        /* Takes the request with highest priority out of given list */
+        static Request takeTop(std::vector<Request>& requests);
+
+        void decodeTop(Lock& lock);
+
+        mutable std::mutex _mutex;
+        std::condition_variable _wakeUp;
+        std::vector<Request> _queued, _decoded, _notFound;
+        std::size_t _decodingCount{};
+        bool _stop{};
+        #ifndef CORRADE_TARGET_EMSCRIPTEN
+        std::vector<std::thread> _workers;
+        #endif
+};
+
+template<class T, class Decoded> AbstractAsyncResourceLoader<T, Decoded>::AbstractAsyncResourceLoader(const UnsignedInt threadCount) {
+    CORRADE_ASSERT(threadCount, "AbstractAsyncResourceLoader: expected at least one thread", );
+
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    _workers.reserve(threadCount);
+    for(UnsignedInt i = 0; i != threadCount; ++i) _workers.emplace_back([this]() {
+        Lock lock{_mutex};
+        for(;;) {
+            _wakeUp.wait(lock, [this]() { return _stop || !_queued.empty(); });
+            if(_stop) return;
+            decodeTop(lock);
+        }
+    });
+    #else
+    static_cast<void>(threadCount);
+    #endif
+}
+
+template<class T, class Decoded> AbstractAsyncResourceLoader<T, Decoded>::~AbstractAsyncResourceLoader() {
+    stop();
+}
+
+template<class T, class Decoded> void AbstractAsyncResourceLoader<T, Decoded>::stop() {
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    {
+        Lock lock{_mutex};
+        _stop = true;
+    }
+    _wakeUp.notify_all();
+    for(std::thread& worker: _workers) worker.join();
+    _workers.clear();
+    #else
+    Lock lock{_mutex};
+    _stop = true;
+    #endif
+}
+
+template<class T, class Decoded> void AbstractAsyncResourceLoader<T, Decoded>::doLoad(const ResourceKey key) {
+    {
+        Lock lock{_mutex};
+        _queued.push_back(Request{key, 0.0f, {}});
+    }
+    _wakeUp.notify_one();
+}
+
+template<class T, class Decoded> void AbstractAsyncResourceLoader<T, Decoded>::doLoadBatch(const Containers::ArrayView<const ResourceKey> keys) {
+    /* Queue all at once so the workers can start on them in parallel */
+    {
+        Lock lock{_mutex};
+        for(const ResourceKey key: keys)
+            _queued.push_back(Request{key, 0.0f, {}});
+    }
+    _wakeUp.notify_all();
+}
+
+template<class T, class Decoded> auto AbstractAsyncResourceLoader<T, Decoded>::takeTop(std::vector<Request>& requests) -> Request {
+    auto top = std::max_element(requests.begin(), requests.end(), [](const Request& a, const Request& b) {
+        return a.priority < b.priority;
+    });
+    Request request = std::move(*top);
+    /* Move the last one in place of the taken one, the order doesn't matter */
+    if(top != requests.end() - 1) *top = std::move(requests.back());
+    requests.pop_back();
+    return request;
+}
+
+template<class T, class Decoded> void AbstractAsyncResourceLoader<T, Decoded>::decodeTop(Lock& lock) {
+    Request request = takeTop(_queued);
+    ++_decodingCount;
+
+    lock.unlock();
+    request.decoded = doDecode(request.key);
+    lock.lock();
+
+    --_decodingCount;
+    (request.decoded ? _decoded : _notFound).push_back(std::move(request));
+}
+
+template<class T, class Decoded> void AbstractAsyncResourceLoader<T, Decoded>::setPriority(const ResourceKey key, const Float priority) {
+    Lock lock{_mutex};
+    for(std::vector<Request>* requests: {&_queued, &_decoded})
+        for(Request& request: *requests)
+            if(request.key == key) request.priority = priority;
+}
+
+template<class T, class Decoded> void AbstractAsyncResourceLoader<T, Decoded>::updatePriorities(const std::function<Float(ResourceKey)>& priority) {
+    Lock lock{_mutex};
+    for(std::vector<Request>* requests: {&_queued, &_decoded})
+        for(Request& request: *requests)
+            request.priority = priority(request.key);
+}
+
+template<class T, class Decoded> std::size_t AbstractAsyncResourceLoader<T, Decoded>::pendingCount() const {
+    Lock lock{_mutex};
+    return _queued.size() + _decodingCount + _decoded.size() + _notFound.size();
+}
+
+template<class T, class Decoded> void AbstractAsyncResourceLoader<T, Decoded>::update(const std::size_t maxCount) {
+    std::vector<Request> upload, notFound;
+    {
+        Lock lock{_mutex};
+
+        #ifdef CORRADE_TARGET_EMSCRIPTEN
+        for(std::size_t i = 0; i != maxCount && !_stop && !_queued.empty(); ++i)
+            decodeTop(lock);
+        #endif
+
+        std::swap(notFound, _notFound);
+        for(std::size_t i = 0; i != maxCount && !_decoded.empty(); ++i)
+            upload.push_back(takeTop(_decoded));
+    }
+
+    /* Call the manager and the upload without the lock held, so the workers
+       can continue in the meantime */
+    for(Request& request: notFound)
+        this->setNotFound(request.key);
+    for(Request& request: upload)
+        doUpload(request.key, std::move(*request.decoded));
+}
+
+}
+
+#endif
@@ -137,6 +137,9 @@ void AbstractFramebuffer::bindImplementationSingle(FramebufferTarget) {
     /* Binding the framebuffer finally creates it */
     _flags |= ObjectFlag::Created;
     glBindFramebuffer(GL_FRAMEBUFFER, _id);
+    #ifdef MAGNUM_BUILD_STATISTICS
+    ++Context::current().statisticsInternal().framebufferBindCount;
+    #endif
 }
 #endif
 
@@ -157,6 +160,9 @@ void AbstractFramebuffer::bindImplementationDefault(FramebufferTarget target) {
     /* Binding the framebuffer finally creates it */
     _flags |= ObjectFlag::Created;
     glBindFramebuffer(GLenum(target), _id);
+    #ifdef MAGNUM_BUILD_STATISTICS
+    ++Context::current().statisticsInternal().framebufferBindCount;
+    #endif
 }
 
 FramebufferTarget AbstractFramebuffer::bindInternal() {
@@ -368,7 +368,9 @@ class MAGNUM_EXPORT AbstractFramebuffer {
          *
          * See @ref read(const Range2Di&, Image2D&) for more information. The
          * storage is not reallocated if it is large enough to contain the new
-         * data, which means that @p usage might get ignored.
+         * data, which means that @p usage might get ignored. See
+         * @ref FramebufferReadback for a way to read the data without
+         * stalling the pipeline.
          * @requires_gles30 Pixel buffer objects are not available in OpenGL ES
          *      2.0.
          * @requires_webgl20 Pixel buffer objects are not available in WebGL
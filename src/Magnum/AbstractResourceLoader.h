@@ -30,6 +30,7 @@
  */
 
 #include <string>
+#include <Corrade/Containers/ArrayView.h>
 
 #include "Magnum/ResourceManager.h"
 
@@ -152,21 +153,32 @@ template<class T> class AbstractResourceLoader {
          */
         void load(ResourceKey key);
 
+        /**
+         * @brief Request a batch of resources to be loaded
+         *
+         * Same as calling @ref load(ResourceKey) for each key, but passes all
+         * of them to @ref doLoadBatch() at once, so the implementation can
+         * for example read resources stored in the same file only once.
+         * @see @ref ResourceLoadBatch
+         */
+        void load(Containers::ArrayView<const ResourceKey> keys);
+
     protected:
         /**
          * @brief Set loaded resource to resource manager
          *
          * Also increments count of loaded resources. Parameter @p state must
          * be either @ref ResourceDataState::Mutable or
-         * @ref ResourceDataState::Final. See @ref ResourceManager::set() for
+         * @ref ResourceDataState::Final, @p size is used only for
+         * @ref ResourcePolicy::Budgeted. See @ref ResourceManager::set() for
          * more information.
          * @see @ref loadedCount()
          */
-        void set(ResourceKey key, T* data, ResourceDataState state, ResourcePolicy policy);
+        void set(ResourceKey key, T* data, ResourceDataState state, ResourcePolicy policy, std::size_t size = 0);
 
         /** @overload */
-        template<class U> void set(ResourceKey key, U&& data, ResourceDataState state, ResourcePolicy policy) {
-            set(key, new typename std::decay<U>::type(std::forward<U>(data)), state, policy);
+        template<class U> void set(ResourceKey key, U&& data, ResourceDataState state, ResourcePolicy policy, std::size_t size = 0) {
+            set(key, new typename std::decay<U>::type(std::forward<U>(data)), state, policy, size);
         }
 
         /**
@@ -193,6 +205,14 @@ template<class T> class AbstractResourceLoader {
          */
         void setNotFound(ResourceKey key);
 
+        /**
+         * @brief Unload resource data
+         *
+         * See @ref ResourceManager::unload() for more information.
+         * @see @ref doEvict()
+         */
+        void unload(ResourceKey key);
+
     #ifndef DOXYGEN_GENERATING_OUTPUT
     private:
     #else
@@ -212,6 +232,25 @@ template<class T> class AbstractResourceLoader {
          */
         virtual void doLoad(ResourceKey key) = 0;
 
+        /**
+         * @brief Implementation for @ref load(Containers::ArrayView<const ResourceKey>)
+         *
+         * Default implementation calls @ref doLoad() for each key.
+         */
+        virtual void doLoadBatch(Containers::ArrayView<const ResourceKey> keys);
+
+        /**
+         * @brief Evict a budgeted resource
+         *
+         * Called by the manager for least recently used resources with
+         * @ref ResourcePolicy::Budgeted when the budget is exceeded, see
+         * @ref ResourceManager-budget for more information. Default
+         * implementation calls @ref unload(), reimplement it for example to
+         * @ref set() a lower-resolution version of the resource with a
+         * smaller size cost instead.
+         */
+        virtual void doEvict(ResourceKey key);
+
     private:
         #ifndef DOXYGEN_GENERATING_OUTPUT /* https://bugzilla.gnome.org/show_bug.cgi?id=776986 */
         friend Implementation::ResourceManagerData<T>;
@@ -229,25 +268,43 @@ template<class T> AbstractResourceLoader<T>::~AbstractResourceLoader() {
 
 template<class T> std::string AbstractResourceLoader<T>::doName(ResourceKey) const { return {}; }
 
+template<class T> void AbstractResourceLoader<T>::doLoadBatch(const Containers::ArrayView<const ResourceKey> keys) {
+    for(const ResourceKey key: keys) doLoad(key);
+}
+
+template<class T> void AbstractResourceLoader<T>::doEvict(const ResourceKey key) { unload(key); }
+
 template<class T> void AbstractResourceLoader<T>::load(ResourceKey key) {
     ++_requestedCount;
     /** @todo What policy for loading resources? */
-    manager->set(key, nullptr, ResourceDataState::Loading, ResourcePolicy::Resident);
+    manager->set(key, nullptr, ResourceDataState::Loading, ResourcePolicy::Resident, 0);
 
     doLoad(key);
 }
 
-template<class T> void AbstractResourceLoader<T>::set(ResourceKey key, T* data, ResourceDataState state, ResourcePolicy policy) {
+template<class T> void AbstractResourceLoader<T>::load(const Containers::ArrayView<const ResourceKey> keys) {
+    _requestedCount += keys.size();
+    for(const ResourceKey key: keys)
+        manager->set(key, nullptr, ResourceDataState::Loading, ResourcePolicy::Resident, 0);
+
+    doLoadBatch(keys);
+}
+
+template<class T> void AbstractResourceLoader<T>::set(ResourceKey key, T* data, ResourceDataState state, ResourcePolicy policy, std::size_t size) {
     CORRADE_ASSERT(state == ResourceDataState::Mutable || state == ResourceDataState::Final,
         "AbstractResourceLoader::set(): state must be either Mutable or Final", );
     ++_loadedCount;
-    manager->set(key, data, state, policy);
+    manager->set(key, data, state, policy, size);
 }
 
 template<class T> inline void AbstractResourceLoader<T>::setNotFound(ResourceKey key) {
     ++_notFoundCount;
     /** @todo What policy for notfound resources? */
-    manager->set(key, nullptr, ResourceDataState::NotFound, ResourcePolicy::Resident);
+    manager->set(key, nullptr, ResourceDataState::NotFound, ResourcePolicy::Resident, 0);
+}
+
+template<class T> inline void AbstractResourceLoader<T>::unload(ResourceKey key) {
+    manager->unload(key);
 }
 
 }
@@ -342,7 +342,12 @@ void AbstractShaderProgram::dispatchCompute(const Vector3ui& workgroupCount) {
 void AbstractShaderProgram::use() {
     /* Use only if the program isn't already in use */
     GLuint& current = Context::current().state().shaderProgram->current;
-    if(current != _id) glUseProgram(current = _id);
+    if(current == _id) return;
+
+    glUseProgram(current = _id);
+    #ifdef MAGNUM_BUILD_STATISTICS
+    ++Context::current().statisticsInternal().programSwitchCount;
+    #endif
 }
 
 void AbstractShaderProgram::attachShader(Shader& shader) {
@@ -396,10 +401,17 @@ void AbstractShaderProgram::transformFeedbackVaryingsImplementationDanglingWorka
 #endif
 
 bool AbstractShaderProgram::link(std::initializer_list<std::reference_wrapper<AbstractShaderProgram>> shaders) {
-    bool allSuccess = true;
+    submitLink(shaders);
+    return checkLink(shaders);
+}
 
+void AbstractShaderProgram::submitLink(std::initializer_list<std::reference_wrapper<AbstractShaderProgram>> shaders) {
     /* Invoke (possibly parallel) linking on all shaders */
     for(AbstractShaderProgram& shader: shaders) glLinkProgram(shader._id);
+}
+
+bool AbstractShaderProgram::checkLink(std::initializer_list<std::reference_wrapper<AbstractShaderProgram>> shaders) {
+    bool allSuccess = true;
 
     /* After linking phase, check status of all shaders */
     Int i = 1;
@@ -438,6 +450,46 @@ bool AbstractShaderProgram::link(std::initializer_list<std::reference_wrapper<Ab
     return allSuccess;
 }
 
+bool AbstractShaderProgram::isLinkFinished() {
+    #ifndef MAGNUM_TARGET_WEBGL
+    if(!Context::current().isExtensionSupported<Extensions::GL::KHR::parallel_shader_compile>())
+        return true;
+
+    GLint finished;
+    glGetProgramiv(_id, GL_COMPLETION_STATUS_KHR, &finished);
+    return finished == GL_TRUE;
+    #else
+    return true;
+    #endif
+}
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+std::pair<GLenum, Containers::Array<char>> AbstractShaderProgram::binary() {
+    GLint size;
+    glGetProgramiv(_id, GL_PROGRAM_BINARY_LENGTH, &size);
+
+    GLenum format{};
+    Containers::Array<char> data{std::size_t(size)};
+    if(size) {
+        GLsizei length;
+        glGetProgramBinary(_id, size, &length, &format, data);
+        CORRADE_INTERNAL_ASSERT(length == size);
+    }
+
+    return {format, std::move(data)};
+}
+
+bool AbstractShaderProgram::setBinary(const GLenum format, const Containers::ArrayView<const void> data) {
+    if(data.empty()) return false;
+
+    glProgramBinary(_id, format, data.data(), data.size());
+
+    GLint success;
+    glGetProgramiv(_id, GL_LINK_STATUS, &success);
+    return success;
+}
+#endif
+
 Int AbstractShaderProgram::uniformLocationInternal(const Containers::ArrayView<const char> name) {
     const GLint location = glGetUniformLocation(_id, name);
     if(location == -1)
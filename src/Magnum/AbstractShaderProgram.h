@@ -387,6 +387,29 @@ See also @ref Attribute::DataType enum for additional type options.
     @ref Matrix2x4, @ref Matrix4x2, @ref Matrix3x4 and @ref Matrix4x3) are not
     available in WebGL 1.0.
 
+@section AbstractShaderProgram-async Asynchronous compilation and linking
+
+Querying compilation or link status forces the driver to wait until the
+operation is finished. If there are many programs to create, it's better to
+only submit the work in the constructor using @ref Shader::submitCompile()
+and @ref submitLink() and check the status later. If
+@extension{KHR,parallel_shader_compile} is supported, the driver compiles
+and links in background threads and @ref isLinkFinished() can be used to
+poll for completion without blocking:
+
+@snippet Magnum.cpp AbstractShaderProgram-async
+
+@section AbstractShaderProgram-binary Program binary caching
+
+A linked program can be retrieved in a driver-specific binary form with
+@ref binary() and later restored with @ref setBinary(), skipping the
+compilation and linking completely. The binary is valid only for the same
+driver and the driver may reject it at any time (e.g. after an update), in
+which case the program has to be compiled again. See @ref ShaderProgramCache
+for a helper that stores the binaries on disk:
+
+@snippet Magnum.cpp AbstractShaderProgram-binary
+
 @section AbstractShaderProgram-performance-optimization Performance optimizations
 
 The engine tracks currently used shader program to avoid unnecessary calls to
@@ -414,6 +437,9 @@ class MAGNUM_EXPORT AbstractShaderProgram: public AbstractObject {
     friend TransformFeedback;
     #endif
     friend Implementation::ShaderProgramState;
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    friend ResourceRestoreCache;
+    #endif
 
     public:
         #ifndef MAGNUM_TARGET_GLES2
@@ -731,6 +757,17 @@ class MAGNUM_EXPORT AbstractShaderProgram: public AbstractObject {
         void dispatchCompute(const Vector3ui& workgroupCount);
         #endif
 
+        /**
+         * @brief Whether linking is finished
+         *
+         * Doesn't block. If @extension{KHR,parallel_shader_compile} is not
+         * supported, the linking is done synchronously and this function
+         * always returns @cpp true @ce.
+         * @see @ref submitLink(), @fn_gl_keyword{GetProgram} with
+         *      @def_gl_extension{COMPLETION_STATUS,KHR,parallel_shader_compile}
+         */
+        bool isLinkFinished();
+
     protected:
         /**
          * @brief Link the shader
@@ -740,13 +777,39 @@ class MAGNUM_EXPORT AbstractShaderProgram: public AbstractObject {
          * output. All attached shaders must be compiled with
          * @ref Shader::compile() before linking. The operation is batched in a
          * way that allows the driver to link multiple shaders simultaneously
-         * (i.e. in multiple threads).
+         * (i.e. in multiple threads). Equivalent to calling
+         * @ref submitLink() followed by @ref checkLink().
          * @see @fn_gl_keyword{LinkProgram}, @fn_gl_keyword{GetProgram} with
          *      @def_gl{LINK_STATUS} and @def_gl{INFO_LOG_LENGTH},
          *      @fn_gl_keyword{GetProgramInfoLog}
          */
         static bool link(std::initializer_list<std::reference_wrapper<AbstractShaderProgram>> shaders);
 
+        /**
+         * @brief Submit shaders for linking
+         *
+         * Starts linking, but doesn't query the link status, which would
+         * force the driver to wait until the linking finishes. The attached
+         * shaders don't need to be finished compiling yet, in which case the
+         * driver waits for them internally. Poll @ref isLinkFinished() to
+         * check whether the linking is done and call @ref checkLink()
+         * afterwards.
+         * @see @ref AbstractShaderProgram-async, @fn_gl_keyword{LinkProgram}
+         */
+        static void submitLink(std::initializer_list<std::reference_wrapper<AbstractShaderProgram>> shaders);
+
+        /**
+         * @brief Check link status
+         *
+         * Checks status of shaders previously submitted with
+         * @ref submitLink() and prints linker messages, if any. Returns
+         * @cpp false @ce if linking of any shader failed, @cpp true @ce if
+         * everything succeeded. Blocks until the linking is finished.
+         * @see @fn_gl_keyword{GetProgram} with @def_gl{LINK_STATUS} and
+         *      @def_gl{INFO_LOG_LENGTH}, @fn_gl_keyword{GetProgramInfoLog}
+         */
+        static bool checkLink(std::initializer_list<std::reference_wrapper<AbstractShaderProgram>> shaders);
+
         #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
         /**
          * @brief Allow retrieving program binary
@@ -762,6 +825,44 @@ class MAGNUM_EXPORT AbstractShaderProgram: public AbstractObject {
         void setRetrievableBinary(bool enabled) {
             glProgramParameteri(_id, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, enabled ? GL_TRUE : GL_FALSE);
         }
+
+        /**
+         * @brief Program binary
+         *
+         * Returns binary format and driver-specific binary representation of
+         * a successfully linked program. Call @ref setRetrievableBinary()
+         * before linking to ensure the binary is available. If the driver
+         * doesn't provide the binary, returns an empty array.
+         * @see @ref AbstractShaderProgram-binary, @ref setBinary(),
+         *      @fn_gl_keyword{GetProgram} with @def_gl{PROGRAM_BINARY_LENGTH},
+         *      @fn_gl_keyword{GetProgramBinary}
+         * @requires_gl41 Extension @extension{ARB,get_program_binary}
+         * @requires_gles30 Extension @extension{OES,get_program_binary} is
+         *      not supported in OpenGL ES 2.0.
+         * @requires_gles Binary program representations are not supported in
+         *      WebGL.
+         */
+        std::pair<GLenum, Containers::Array<char>> binary();
+
+        /**
+         * @brief Set program binary
+         *
+         * Loads program previously retrieved using @ref binary(), replacing
+         * the need to attach shaders and link. Returns @cpp true @ce if the binary
+         * was accepted and the program is linked, @cpp false @ce if @p data
+         * are empty or the driver rejected them. Unlike @ref link(), no
+         * messages are printed on failure, as rejected binaries are expected
+         * (e.g. after a driver update) and the program should be compiled
+         * from sources instead.
+         * @see @ref AbstractShaderProgram-binary, @fn_gl_keyword{ProgramBinary},
+         *      @fn_gl_keyword{GetProgram} with @def_gl{LINK_STATUS}
+         * @requires_gl41 Extension @extension{ARB,get_program_binary}
+         * @requires_gles30 Extension @extension{OES,get_program_binary} is
+         *      not supported in OpenGL ES 2.0.
+         * @requires_gles Binary program representations are not supported in
+         *      WebGL.
+         */
+        bool setBinary(GLenum format, Containers::ArrayView<const void> data);
         #endif
 
         #ifndef MAGNUM_TARGET_WEBGL
@@ -924,6 +1025,24 @@ class MAGNUM_EXPORT AbstractShaderProgram: public AbstractObject {
          */
         bool link() { return link({*this}); }
 
+        /**
+         * @brief Submit the shader for linking
+         *
+         * Submits single shader for linking, see
+         * @ref submitLink(std::initializer_list<std::reference_wrapper<AbstractShaderProgram>>)
+         * for more information.
+         */
+        void submitLink() { submitLink({*this}); }
+
+        /**
+         * @brief Check link status of the shader
+         *
+         * Checks link status of single shader, see
+         * @ref checkLink(std::initializer_list<std::reference_wrapper<AbstractShaderProgram>>)
+         * for more information.
+         */
+        bool checkLink() { return checkLink({*this}); }
+
         /**
          * @brief Get uniform location
          * @param name          Uniform name
@@ -34,9 +34,11 @@
 #include "Magnum/Context.h"
 #include "Magnum/Extensions.h"
 #include "Magnum/Image.h"
+#include "Magnum/MemoryTracker.h"
 #include "Magnum/PixelFormat.h"
 #include "Magnum/TextureFormat.h"
 #include "Magnum/Math/Color.h"
+#include "Magnum/Math/Functions.h"
 #include "Magnum/Math/Range.h"
 
 #ifndef MAGNUM_TARGET_WEBGL
@@ -180,6 +182,9 @@ void AbstractTexture::bindImplementationMulti(const GLint firstTextureUnit, Cont
     /** @todo VLAs */
     Containers::Array<GLuint> ids{textures ? textures.size() : 0};
     bool different = false;
+    #ifdef MAGNUM_BUILD_STATISTICS
+    UnsignedLong changed = 0;
+    #endif
     for(std::size_t i = 0; i != textures.size(); ++i) {
         const GLuint id = textures && textures[i] ? textures[i]->_id : 0;
 
@@ -190,12 +195,20 @@ void AbstractTexture::bindImplementationMulti(const GLint firstTextureUnit, Cont
 
         if(textureState.bindings[firstTextureUnit + i].second != id) {
             different = true;
+            #ifdef MAGNUM_BUILD_STATISTICS
+            ++changed;
+            #endif
             textureState.bindings[firstTextureUnit + i].second = id;
         }
     }
 
     /* Avoid doing the binding if there is nothing different */
-    if(different) glBindTextures(firstTextureUnit, textures.size(), ids);
+    if(!different) return;
+
+    glBindTextures(firstTextureUnit, textures.size(), ids);
+    #ifdef MAGNUM_BUILD_STATISTICS
+    Context::current().statisticsInternal().textureBindCount += changed;
+    #endif
 }
 #endif
 
@@ -236,6 +249,10 @@ AbstractTexture::~AbstractTexture() {
     /* Moved out or not deleting on destruction, nothing to do */
     if(!_id || !(_flags & ObjectFlag::DeleteOnDestruction)) return;
 
+    #ifndef MAGNUM_TARGET_GLES
+    if(_resident) glMakeTextureHandleNonResidentARB(_handle);
+    #endif
+
     /* Remove all bindings */
     for(auto& binding: Context::current().state().texture->bindings) {
         /* MSVC 2015 needs the parentheses around */
@@ -252,6 +269,8 @@ AbstractTexture::~AbstractTexture() {
     }
     #endif
 
+    Context::current().memoryTracker().remove(MemoryObjectType::Texture, _id);
+
     glDeleteTextures(1, &_id);
 }
 
@@ -276,10 +295,82 @@ std::string AbstractTexture::label() {
 AbstractTexture& AbstractTexture::setLabelInternal(const Containers::ArrayView<const char> label) {
     createIfNotAlready();
     Context::current().state().debug->labelImplementation(GL_TEXTURE, _id, label);
+    Context::current().memoryTracker().setLabel(MemoryObjectType::Texture, _id, {label.data(), label.size()});
     return *this;
 }
 #endif
 
+void AbstractTexture::trackStorage(const GLsizei levels, const TextureFormat internalFormat, const Vector3i& size, const GLsizei samples) {
+    /* Sparse textures occupy only the committed pages, which aren't known
+       here, so don't report the whole virtual size */
+    #ifndef MAGNUM_TARGET_GLES
+    if(_sparse) return;
+    #endif
+
+    /* Array layers don't get smaller with increasing mip level, cube map
+       faces are tracked as separate slots to match trackImage() */
+    Vector3i minSize{1};
+    #ifndef MAGNUM_TARGET_GLES
+    if(_target == GL_TEXTURE_1D_ARRAY) minSize.y() = size.y();
+    #endif
+    #ifndef MAGNUM_TARGET_GLES2
+    if(_target == GL_TEXTURE_2D_ARRAY) minSize.z() = size.z();
+    #endif
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    if(_target == GL_TEXTURE_CUBE_MAP_ARRAY) minSize.z() = size.z();
+    #endif
+    const std::size_t faceCount = _target == GL_TEXTURE_CUBE_MAP ? 6 : 1;
+
+    const Float pixelSize = MemoryTracker::pixelSize(internalFormat)*samples;
+    std::vector<std::size_t> slotSizes;
+    slotSizes.reserve(levels*faceCount);
+    for(GLsizei level = 0; level != levels; ++level) {
+        const std::size_t levelSize = std::size_t(pixelSize*Math::max(size >> level, minSize).product());
+        for(std::size_t face = 0; face != faceCount; ++face)
+            slotSizes.push_back(levelSize);
+    }
+
+    Context::current().memoryTracker().setAllocation(MemoryObjectType::Texture, _id, slotSizes);
+}
+
+void AbstractTexture::trackImage(const GLenum target, const GLint level, const std::size_t size) {
+    std::size_t slot = level;
+    if(_target == GL_TEXTURE_CUBE_MAP && target != GL_TEXTURE_CUBE_MAP)
+        slot = level*6 + (target - GL_TEXTURE_CUBE_MAP_POSITIVE_X);
+
+    Context::current().memoryTracker().setSlotAllocation(MemoryObjectType::Texture, _id, slot, size);
+}
+
+#ifndef MAGNUM_TARGET_GLES
+GLuint64 AbstractTexture::handle() {
+    if(!_handle) {
+        createIfNotAlready();
+        _handle = glGetTextureHandleARB(_id);
+    }
+
+    return _handle;
+}
+
+void AbstractTexture::makeResident() {
+    if(_resident) return;
+
+    glMakeTextureHandleResidentARB(handle());
+    _resident = true;
+}
+
+void AbstractTexture::makeResident(std::initializer_list<AbstractTexture*> textures) {
+    for(AbstractTexture* const texture: textures) if(texture)
+        texture->makeResident();
+}
+
+void AbstractTexture::makeNonResident() {
+    if(!_resident) return;
+
+    glMakeTextureHandleNonResidentARB(_handle);
+    _resident = false;
+}
+#endif
+
 #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
 void AbstractTexture::unbindImage(const Int imageUnit) {
     Implementation::TextureState& textureState = *Context::current().state().texture;
@@ -345,6 +436,9 @@ void AbstractTexture::bind(Int textureUnit) {
     /* Update state tracker, bind the texture to the unit */
     textureState.bindings[textureUnit] = {_target, _id};
     (this->*textureState.bindImplementation)(textureUnit);
+    #ifdef MAGNUM_BUILD_STATISTICS
+    ++Context::current().statisticsInternal().textureBindCount;
+    #endif
 }
 
 void AbstractTexture::bindImplementationDefault(GLint textureUnit) {
@@ -492,6 +586,50 @@ void AbstractTexture::setDepthStencilMode(const Sampler::DepthStencilMode mode)
 }
 #endif
 
+#ifndef MAGNUM_TARGET_GLES
+Int AbstractTexture::sparsePageSizeCount(const GLenum target, const TextureFormat format) {
+    GLint value;
+    glGetInternalformativ(target, GLenum(format), GL_NUM_VIRTUAL_PAGE_SIZES_ARB, 1, &value);
+    return value;
+}
+
+Vector3i AbstractTexture::sparsePageSize(const GLenum target, const TextureFormat format, const Int index) {
+    const Int count = sparsePageSizeCount(target, format);
+    CORRADE_ASSERT(index < count,
+        "AbstractTexture::sparsePageSize(): index" << index << "out of range for" << count << "page sizes", {});
+
+    /* The queries return all page sizes at once */
+    Containers::Array<GLint> x{std::size_t(count)}, y{std::size_t(count)}, z{std::size_t(count)};
+    glGetInternalformativ(target, GLenum(format), GL_VIRTUAL_PAGE_SIZE_X_ARB, count, x);
+    glGetInternalformativ(target, GLenum(format), GL_VIRTUAL_PAGE_SIZE_Y_ARB, count, y);
+    glGetInternalformativ(target, GLenum(format), GL_VIRTUAL_PAGE_SIZE_Z_ARB, count, z);
+    return {x[index], y[index], z[index]};
+}
+
+void AbstractTexture::setSparse(const bool sparse) {
+    _sparse = sparse;
+    (this->*Context::current().state().texture->parameteriImplementation)(GL_TEXTURE_SPARSE_ARB, sparse);
+}
+
+void AbstractTexture::setSparsePageSizeIndex(const Int index) {
+    (this->*Context::current().state().texture->parameteriImplementation)(GL_VIRTUAL_PAGE_SIZE_INDEX_ARB, index);
+}
+
+void AbstractTexture::pageCommitment(const GLint level, const Vector3i& offset, const Vector3i& size, const bool commit) {
+    (this->*Context::current().state().texture->pageCommitmentImplementation)(level, offset, size, commit);
+}
+
+void AbstractTexture::pageCommitmentImplementationDefault(const GLint level, const Vector3i& offset, const Vector3i& size, const GLboolean commit) {
+    bindInternal();
+    glTexPageCommitmentARB(_target, level, offset.x(), offset.y(), offset.z(), size.x(), size.y(), size.z(), commit);
+}
+
+void AbstractTexture::pageCommitmentImplementationDSAEXT(const GLint level, const Vector3i& offset, const Vector3i& size, const GLboolean commit) {
+    _flags |= ObjectFlag::Created;
+    glTexturePageCommitmentEXT(_id, level, offset.x(), offset.y(), offset.z(), size.x(), size.y(), size.z(), commit);
+}
+#endif
+
 void AbstractTexture::invalidateImage(const Int level) {
     (this->*Context::current().state().texture->invalidateImageImplementation)(level);
 }
@@ -540,6 +678,9 @@ void AbstractTexture::bindInternal() {
     /* Binding the texture finally creates it */
     _flags |= ObjectFlag::Created;
     glBindTexture(_target, _id);
+    #ifdef MAGNUM_BUILD_STATISTICS
+    ++Context::current().statisticsInternal().textureBindCount;
+    #endif
 }
 
 #if !defined(MAGNUM_TARGET_GLES) || defined(MAGNUM_TARGET_GLES2)
@@ -1967,26 +2108,31 @@ Vector3i AbstractTexture::DataHelper<3>::imageSize(AbstractTexture& texture, con
 #ifndef MAGNUM_TARGET_GLES
 void AbstractTexture::DataHelper<1>::setStorage(AbstractTexture& texture, const GLsizei levels, const TextureFormat internalFormat, const Math::Vector< 1, GLsizei >& size) {
     (texture.*Context::current().state().texture->storage1DImplementation)(levels, internalFormat, size);
+    texture.trackStorage(levels, internalFormat, {size[0], 1, 1});
 }
 #endif
 
 void AbstractTexture::DataHelper<2>::setStorage(AbstractTexture& texture, const GLsizei levels, const TextureFormat internalFormat, const Vector2i& size) {
     (texture.*Context::current().state().texture->storage2DImplementation)(levels, internalFormat, size);
+    texture.trackStorage(levels, internalFormat, {size, 1});
 }
 
 #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
 void AbstractTexture::DataHelper<3>::setStorage(AbstractTexture& texture, const GLsizei levels, const TextureFormat internalFormat, const Vector3i& size) {
     (texture.*Context::current().state().texture->storage3DImplementation)(levels, internalFormat, size);
+    texture.trackStorage(levels, internalFormat, size);
 }
 #endif
 
 #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
 void AbstractTexture::DataHelper<2>::setStorageMultisample(AbstractTexture& texture, const GLsizei samples, const TextureFormat internalFormat, const Vector2i& size, const GLboolean fixedSampleLocations) {
     (texture.*Context::current().state().texture->storage2DMultisampleImplementation)(samples, internalFormat, size, fixedSampleLocations);
+    texture.trackStorage(1, internalFormat, {size, 1}, samples);
 }
 
 void AbstractTexture::DataHelper<3>::setStorageMultisample(AbstractTexture& texture, const GLsizei samples, const TextureFormat internalFormat, const Vector3i& size, const GLboolean fixedSampleLocations) {
     (texture.*Context::current().state().texture->storage3DMultisampleImplementation)(samples, internalFormat, size, fixedSampleLocations);
+    texture.trackStorage(1, internalFormat, size, samples);
 }
 #endif
 
@@ -1996,6 +2142,7 @@ void AbstractTexture::DataHelper<1>::setImage(AbstractTexture& texture, const GL
     image.storage().applyUnpack();
     texture.bindInternal();
     glTexImage1D(texture._target, level, GLint(internalFormat), image.size()[0], 0, GLenum(image.format()), GLenum(image.type()), image.data());
+    texture.trackImage(texture._target, level, std::size_t(MemoryTracker::pixelSize(internalFormat)*image.size()[0]));
 }
 
 void AbstractTexture::DataHelper<1>::setCompressedImage(AbstractTexture& texture, const GLint level, const CompressedImageView1D& image) {
@@ -2003,6 +2150,7 @@ void AbstractTexture::DataHelper<1>::setCompressedImage(AbstractTexture& texture
     image.storage().applyUnpack();
     texture.bindInternal();
     glCompressedTexImage1D(texture._target, level, GLenum(image.format()), image.size()[0], 0, Implementation::occupiedCompressedImageDataSize(image, image.data().size()), image.data());
+    texture.trackImage(texture._target, level, Implementation::occupiedCompressedImageDataSize(image, image.data().size()));
 }
 
 void AbstractTexture::DataHelper<1>::setImage(AbstractTexture& texture, const GLint level, const TextureFormat internalFormat, BufferImage1D& image) {
@@ -2010,6 +2158,7 @@ void AbstractTexture::DataHelper<1>::setImage(AbstractTexture& texture, const GL
     image.storage().applyUnpack();
     texture.bindInternal();
     glTexImage1D(texture._target, level, GLint(internalFormat), image.size()[0], 0, GLenum(image.format()), GLenum(image.type()), nullptr);
+    texture.trackImage(texture._target, level, std::size_t(MemoryTracker::pixelSize(internalFormat)*image.size()[0]));
 }
 
 void AbstractTexture::DataHelper<1>::setCompressedImage(AbstractTexture& texture, const GLint level, CompressedBufferImage1D& image) {
@@ -2017,6 +2166,7 @@ void AbstractTexture::DataHelper<1>::setCompressedImage(AbstractTexture& texture
     image.storage().applyUnpack();
     texture.bindInternal();
     glCompressedTexImage1D(texture._target, level, GLenum(image.format()), image.size()[0], 0, Implementation::occupiedCompressedImageDataSize(image, image.dataSize()), nullptr);
+    texture.trackImage(texture._target, level, Implementation::occupiedCompressedImageDataSize(image, image.dataSize()));
 }
 
 void AbstractTexture::DataHelper<1>::setSubImage(AbstractTexture& texture, const GLint level, const Math::Vector<1, GLint>& offset, const ImageView1D& image) {
@@ -2054,6 +2204,7 @@ void AbstractTexture::DataHelper<2>::setImage(AbstractTexture& texture, const GL
         + Implementation::pixelStorageSkipOffset(image)
         #endif
         , image.storage());
+    texture.trackImage(target, level, std::size_t(MemoryTracker::pixelSize(internalFormat)*image.size().product()));
 }
 
 void AbstractTexture::DataHelper<2>::setCompressedImage(AbstractTexture& texture, const GLenum target, const GLint level, const CompressedImageView2D& image) {
@@ -2067,6 +2218,7 @@ void AbstractTexture::DataHelper<2>::setCompressedImage(AbstractTexture& texture
     #endif
     texture.bindInternal();
     glCompressedTexImage2D(target, level, GLenum(image.format()), image.size().x(), image.size().y(), 0, Implementation::occupiedCompressedImageDataSize(image, image.data().size()), image.data());
+    texture.trackImage(target, level, Implementation::occupiedCompressedImageDataSize(image, image.data().size()));
 }
 
 #ifndef MAGNUM_TARGET_GLES2
@@ -2075,6 +2227,7 @@ void AbstractTexture::DataHelper<2>::setImage(AbstractTexture& texture, const GL
     image.storage().applyUnpack();
     texture.bindInternal();
     glTexImage2D(target, level, GLint(internalFormat), image.size().x(), image.size().y(), 0, GLenum(image.format()), GLenum(image.type()), nullptr);
+    texture.trackImage(target, level, std::size_t(MemoryTracker::pixelSize(internalFormat)*image.size().product()));
 }
 
 void AbstractTexture::DataHelper<2>::setCompressedImage(AbstractTexture& texture, const GLenum target, const GLint level, CompressedBufferImage2D& image) {
@@ -2086,6 +2239,7 @@ void AbstractTexture::DataHelper<2>::setCompressedImage(AbstractTexture& texture
     #endif
     texture.bindInternal();
     glCompressedTexImage2D(target, level, GLenum(image.format()), image.size().x(), image.size().y(), 0, Implementation::occupiedCompressedImageDataSize(image, image.dataSize()), nullptr);
+    texture.trackImage(target, level, Implementation::occupiedCompressedImageDataSize(image, image.dataSize()));
 }
 #endif
 
@@ -2142,6 +2296,7 @@ void AbstractTexture::DataHelper<3>::setImage(AbstractTexture& texture, const GL
         + Implementation::pixelStorageSkipOffset(image)
         #endif
         , image.storage());
+    texture.trackImage(texture._target, level, std::size_t(MemoryTracker::pixelSize(internalFormat)*image.size().product()));
 }
 
 void AbstractTexture::DataHelper<3>::setCompressedImage(AbstractTexture& texture, const GLint level, const CompressedImageView3D& image) {
@@ -2159,6 +2314,7 @@ void AbstractTexture::DataHelper<3>::setCompressedImage(AbstractTexture& texture
     #else
     glCompressedTexImage3DOES(texture._target, level, GLenum(image.format()), image.size().x(), image.size().y(), image.size().z(), 0, Implementation::occupiedCompressedImageDataSize(image, image.data().size()), image.data());
     #endif
+    texture.trackImage(texture._target, level, Implementation::occupiedCompressedImageDataSize(image, image.data().size()));
 }
 #endif
 
@@ -2168,6 +2324,7 @@ void AbstractTexture::DataHelper<3>::setImage(AbstractTexture& texture, const GL
     image.storage().applyUnpack();
     texture.bindInternal();
     glTexImage3D(texture._target, level, GLint(internalFormat), image.size().x(), image.size().y(), image.size().z(), 0, GLenum(image.format()), GLenum(image.type()), nullptr);
+    texture.trackImage(texture._target, level, std::size_t(MemoryTracker::pixelSize(internalFormat)*image.size().product()));
 }
 
 void AbstractTexture::DataHelper<3>::setCompressedImage(AbstractTexture& texture, const GLint level, CompressedBufferImage3D& image) {
@@ -2179,6 +2336,7 @@ void AbstractTexture::DataHelper<3>::setCompressedImage(AbstractTexture& texture
     #endif
     texture.bindInternal();
     glCompressedTexImage3D(texture._target, level, GLenum(image.format()), image.size().x(), image.size().y(), image.size().z(), 0, Implementation::occupiedCompressedImageDataSize(image, image.dataSize()), nullptr);
+    texture.trackImage(texture._target, level, Implementation::occupiedCompressedImageDataSize(image, image.dataSize()));
 }
 #endif
 
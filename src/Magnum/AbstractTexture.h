@@ -66,6 +66,19 @@ information and usage examples.
 submitted to @ref Texture::setSubImage() "*Texture::setSubImage()", see its
 documentation for details.
 
+@section AbstractTexture-bindless Bindless textures
+
+If @extension{ARB,bindless_texture} is available, the texture can be accessed
+in shaders through a 64-bit @ref handle() instead of being bound to a texture
+unit. The handles can be packed into uniform or shader storage buffers
+together with other per-draw data, after the handles are made resident using
+@ref makeResident() no texture binding is needed for the draws:
+
+@snippet Magnum.cpp AbstractTexture-bindless
+
+The texture becomes immutable once its handle is created, so fully set it up
+before querying the handle.
+
 @section AbstractTexture-performance-optimization Performance optimizations and security
 
 The engine tracks currently bound textures and images in all available texture
@@ -132,6 +145,7 @@ functions do nothing.
 @todo Query for immutable levels (@extension{ARB,ES3_compatibility})
 */
 class MAGNUM_EXPORT AbstractTexture: public AbstractObject {
+    friend DeletionQueue;
     friend Implementation::TextureState;
     friend AbstractFramebuffer;
     friend CubeMapTexture;
@@ -405,6 +419,73 @@ class MAGNUM_EXPORT AbstractTexture: public AbstractObject {
          */
         void bind(Int textureUnit);
 
+        #ifndef MAGNUM_TARGET_GLES
+        /**
+         * @brief Bindless texture handle
+         *
+         * The handle can be passed to shaders through uniform or shader
+         * storage buffers as a 64-bit value, removing the need to bind the
+         * texture before each draw. Before use in a shader, the handle has to
+         * be made resident using @ref makeResident(). The handle is queried
+         * only once and then cached.
+         * @attention After the handle is created, the texture state and
+         *      storage is immutable. Configure the texture and upload all
+         *      data before calling this function.
+         * @see @ref AbstractTexture-bindless, @fn_gl_extension_keyword{GetTextureHandle,ARB,bindless_texture}
+         * @requires_extension Extension @extension{ARB,bindless_texture}
+         * @requires_gl Bindless textures are not available in OpenGL ES and
+         *      WebGL.
+         */
+        GLuint64 handle();
+
+        /**
+         * @brief Whether the texture handle is resident
+         *
+         * Returns the residency state tracked by the engine, doesn't result in
+         * any GL call.
+         * @see @ref makeResident(), @ref makeNonResident()
+         * @requires_extension Extension @extension{ARB,bindless_texture}
+         * @requires_gl Bindless textures are not available in OpenGL ES and
+         *      WebGL.
+         */
+        bool isResident() const { return _resident; }
+
+        /**
+         * @brief Make the texture handle resident
+         *
+         * Makes @ref handle() accessible to shaders. If the handle is already
+         * resident, the function does nothing. Resident handles are made
+         * non-resident on texture destruction.
+         * @see @ref AbstractTexture-bindless, @ref makeResident(std::initializer_list<AbstractTexture*>),
+         *      @fn_gl_extension_keyword{MakeTextureHandleResident,ARB,bindless_texture}
+         * @requires_extension Extension @extension{ARB,bindless_texture}
+         * @requires_gl Bindless textures are not available in OpenGL ES and
+         *      WebGL.
+         */
+        void makeResident();
+
+        /**
+         * @brief Make multiple texture handles resident
+         *
+         * Equivalent to calling @ref makeResident() on all @p textures.
+         * @requires_extension Extension @extension{ARB,bindless_texture}
+         * @requires_gl Bindless textures are not available in OpenGL ES and
+         *      WebGL.
+         */
+        static void makeResident(std::initializer_list<AbstractTexture*> textures);
+
+        /**
+         * @brief Make the texture handle non-resident
+         *
+         * If the handle is not resident, the function does nothing.
+         * @see @fn_gl_extension_keyword{MakeTextureHandleNonResident,ARB,bindless_texture}
+         * @requires_extension Extension @extension{ARB,bindless_texture}
+         * @requires_gl Bindless textures are not available in OpenGL ES and
+         *      WebGL.
+         */
+        void makeNonResident();
+        #endif
+
     #ifdef DOXYGEN_GENERATING_OUTPUT
     private:
     #else
@@ -414,6 +495,8 @@ class MAGNUM_EXPORT AbstractTexture: public AbstractObject {
 
         #ifndef MAGNUM_TARGET_GLES
         static Int compressedBlockDataSize(GLenum target, TextureFormat format);
+        static Int sparsePageSizeCount(GLenum target, TextureFormat format);
+        static Vector3i sparsePageSize(GLenum target, TextureFormat format, Int index);
         #endif
 
         #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
@@ -484,6 +567,12 @@ class MAGNUM_EXPORT AbstractTexture: public AbstractObject {
         void invalidateImage(Int level);
         void generateMipmap();
 
+        #ifndef MAGNUM_TARGET_GLES
+        void setSparse(bool sparse);
+        void setSparsePageSizeIndex(Int index);
+        void pageCommitment(GLint level, const Vector3i& offset, const Vector3i& size, bool commit);
+        #endif
+
         #ifndef MAGNUM_TARGET_GLES
         template<UnsignedInt dimensions> void image(GLint level, Image<dimensions>& image);
         template<UnsignedInt dimensions> void image(GLint level, BufferImage<dimensions>& image, BufferUsage usage);
@@ -580,6 +669,10 @@ class MAGNUM_EXPORT AbstractTexture: public AbstractObject {
         void MAGNUM_LOCAL mipmapImplementationDSAEXT();
         #endif
 
+        /* Memory tracking, called from DataHelper */
+        void MAGNUM_LOCAL trackStorage(GLsizei levels, TextureFormat internalFormat, const Vector3i& size, GLsizei samples = 1);
+        void MAGNUM_LOCAL trackImage(GLenum target, GLint level, std::size_t size);
+
         #ifndef MAGNUM_TARGET_GLES
         void MAGNUM_LOCAL storageImplementationFallback(GLsizei levels, TextureFormat internalFormat, const Math::Vector<1, GLsizei>& size);
         void MAGNUM_LOCAL storageImplementationDefault(GLsizei levels, TextureFormat internalFormat, const Math::Vector<1, GLsizei>& size);
@@ -703,8 +796,17 @@ class MAGNUM_EXPORT AbstractTexture: public AbstractObject {
         void MAGNUM_LOCAL invalidateSubImageImplementationARB(GLint level, const Vector3i& offset, const Vector3i& size);
         #endif
 
+        #ifndef MAGNUM_TARGET_GLES
+        void MAGNUM_LOCAL pageCommitmentImplementationDefault(GLint level, const Vector3i& offset, const Vector3i& size, GLboolean commit);
+        void MAGNUM_LOCAL pageCommitmentImplementationDSAEXT(GLint level, const Vector3i& offset, const Vector3i& size, GLboolean commit);
+        #endif
+
         GLuint _id;
         ObjectFlags _flags;
+        #ifndef MAGNUM_TARGET_GLES
+        bool _resident{}, _sparse{};
+        GLuint64 _handle{};
+        #endif
 };
 
 #ifndef DOXYGEN_GENERATING_OUTPUT
@@ -810,8 +912,16 @@ template<> struct MAGNUM_EXPORT AbstractTexture::DataHelper<3> {
 };
 #endif
 
-inline AbstractTexture::AbstractTexture(AbstractTexture&& other) noexcept: _target{other._target}, _id{other._id}, _flags{other._flags} {
+inline AbstractTexture::AbstractTexture(AbstractTexture&& other) noexcept: _target{other._target}, _id{other._id}, _flags{other._flags}
+    #ifndef MAGNUM_TARGET_GLES
+    , _resident{other._resident}, _handle{other._handle}
+    #endif
+{
     other._id = 0;
+    #ifndef MAGNUM_TARGET_GLES
+    other._resident = false;
+    other._handle = 0;
+    #endif
 }
 
 inline AbstractTexture& AbstractTexture::operator=(AbstractTexture&& other) noexcept {
@@ -819,12 +929,20 @@ inline AbstractTexture& AbstractTexture::operator=(AbstractTexture&& other) noex
     swap(_target, other._target);
     swap(_id, other._id);
     swap(_flags, other._flags);
+    #ifndef MAGNUM_TARGET_GLES
+    swap(_resident, other._resident);
+    swap(_handle, other._handle);
+    #endif
     return *this;
 }
 
 inline GLuint AbstractTexture::release() {
     const GLuint id = _id;
     _id = 0;
+    #ifndef MAGNUM_TARGET_GLES
+    _resident = false;
+    _handle = 0;
+    #endif
     return id;
 }
 
@@ -25,10 +25,14 @@
 
 #include "AbstractImporter.h"
 
+#include <algorithm>
+#include <tuple>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Utility/Assert.h>
 #include <Corrade/Utility/Directory.h>
 
+#include "Magnum/Implementation/mapFile.h"
+
 #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
 #include "Magnum/Audio/configure.h"
 #endif
@@ -36,7 +40,7 @@
 namespace Magnum { namespace Audio {
 
 std::string AbstractImporter::pluginInterface() {
-    return "cz.mosra.magnum.Audio.AbstractImporter/0.1";
+    return "cz.mosra.magnum.Audio.AbstractImporter/0.2";
 }
 
 #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
@@ -59,6 +63,9 @@ AbstractImporter::AbstractImporter(PluginManager::Manager<AbstractImporter>& man
 
 AbstractImporter::AbstractImporter(PluginManager::AbstractManager& manager, const std::string& plugin): PluginManager::AbstractManagingPlugin<AbstractImporter>{manager, plugin} {}
 
+/* The derived destructor is already done with the mapping at this point */
+AbstractImporter::~AbstractImporter() { unmapFile(); }
+
 bool AbstractImporter::openData(Containers::ArrayView<const char> data) {
     CORRADE_ASSERT(features() & Feature::OpenData,
         "Audio::AbstractImporter::openData(): feature not supported", {});
@@ -72,6 +79,19 @@ void AbstractImporter::doOpenData(Containers::ArrayView<const char>) {
     CORRADE_ASSERT(false, "Audio::AbstractImporter::openData(): feature advertised but not implemented", );
 }
 
+bool AbstractImporter::openMemory(Containers::ArrayView<const char> memory) {
+    CORRADE_ASSERT((features() & Feature::OpenMemory) == Feature::OpenMemory,
+        "Audio::AbstractImporter::openMemory(): feature not supported", {});
+
+    close();
+    doOpenMemory(memory);
+    return isOpened();
+}
+
+void AbstractImporter::doOpenMemory(Containers::ArrayView<const char> memory) {
+    doOpenData(memory);
+}
+
 bool AbstractImporter::openFile(const std::string& filename) {
     close();
     doOpenFile(filename);
@@ -81,6 +101,17 @@ bool AbstractImporter::openFile(const std::string& filename) {
 void AbstractImporter::doOpenFile(const std::string& filename) {
     CORRADE_ASSERT(features() & Feature::OpenData, "Audio::AbstractImporter::openFile(): not implemented", );
 
+    /* Map the file, if the importer can work with it directly. If the
+       opening fails, the mapping is not needed anymore. */
+    if((features() & Feature::OpenMemory) == Feature::OpenMemory) {
+        std::tie(_mappedData, _mappedSize) = Magnum::Implementation::mapFile(filename);
+        if(_mappedData) {
+            doOpenMemory({_mappedData, _mappedSize});
+            if(!isOpened()) unmapFile();
+            return;
+        }
+    }
+
     /* Open file */
     if(!Utility::Directory::fileExists(filename)) {
         Error() << "Trade::AbstractImporter::openFile(): cannot open file" << filename;
@@ -95,6 +126,16 @@ void AbstractImporter::close() {
         doClose();
         CORRADE_INTERNAL_ASSERT(!isOpened());
     }
+
+    unmapFile();
+}
+
+void AbstractImporter::unmapFile() {
+    if(!_mappedData) return;
+
+    Magnum::Implementation::unmapFile(_mappedData, _mappedSize);
+    _mappedData = nullptr;
+    _mappedSize = 0;
 }
 
 Buffer::Format AbstractImporter::format() const {
@@ -112,4 +153,76 @@ Containers::Array<char> AbstractImporter::data() {
     return doData();
 }
 
+UnsignedInt AbstractImporter::frameSize() const {
+    CORRADE_ASSERT(isOpened(), "Audio::AbstractImporter::frameSize(): no file opened", {});
+
+    switch(doFormat()) {
+        case Buffer::Format::Mono8:
+        case Buffer::Format::MonoALaw:
+        case Buffer::Format::MonoMuLaw:
+            return 1;
+        case Buffer::Format::Mono16:
+        case Buffer::Format::Stereo8:
+        case Buffer::Format::StereoALaw:
+        case Buffer::Format::StereoMuLaw:
+        case Buffer::Format::Rear8:
+            return 2;
+        case Buffer::Format::Stereo16:
+        case Buffer::Format::MonoFloat:
+        case Buffer::Format::Quad8:
+        case Buffer::Format::Rear16:
+            return 4;
+        case Buffer::Format::Surround51Channel8:
+            return 6;
+        case Buffer::Format::Surround61Channel8:
+            return 7;
+        case Buffer::Format::StereoFloat:
+        case Buffer::Format::MonoDouble:
+        case Buffer::Format::Quad16:
+        case Buffer::Format::Rear32:
+        case Buffer::Format::Surround71Channel8:
+            return 8;
+        case Buffer::Format::Surround51Channel16:
+            return 12;
+        case Buffer::Format::Surround61Channel16:
+            return 14;
+        case Buffer::Format::StereoDouble:
+        case Buffer::Format::Quad32:
+        case Buffer::Format::Surround71Channel16:
+            return 16;
+        case Buffer::Format::Surround51Channel32:
+            return 24;
+        case Buffer::Format::Surround61Channel32:
+            return 28;
+        case Buffer::Format::Surround71Channel32:
+            return 32;
+    }
+
+    CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+std::size_t AbstractImporter::frameCount() {
+    CORRADE_ASSERT(isOpened(), "Audio::AbstractImporter::frameCount(): no file opened", {});
+    return doFrameCount();
+}
+
+std::size_t AbstractImporter::doFrameCount() {
+    return doData().size()/frameSize();
+}
+
+Containers::Array<char> AbstractImporter::readFrames(const std::size_t offset, const std::size_t count) {
+    CORRADE_ASSERT(isOpened(), "Audio::AbstractImporter::readFrames(): no file opened", nullptr);
+    const std::size_t frameCount = doFrameCount();
+    CORRADE_ASSERT(offset <= frameCount, "Audio::AbstractImporter::readFrames(): offset" << offset << "out of range for" << frameCount << "frames", nullptr);
+    return doReadFrames(offset, std::min(count, frameCount - offset));
+}
+
+Containers::Array<char> AbstractImporter::doReadFrames(const std::size_t offset, const std::size_t count) {
+    const Containers::Array<char> data = doData();
+    const std::size_t frameSize = this->frameSize();
+    Containers::Array<char> out{count*frameSize};
+    std::copy_n(data.begin() + offset*frameSize, out.size(), out.begin());
+    return out;
+}
+
 }}
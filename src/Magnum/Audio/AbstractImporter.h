@@ -48,6 +48,9 @@ importer plugins.
 Plugin implements function @ref doFeatures(), @ref doIsOpened(), one of or both
 @ref doOpenData() and @ref doOpenFile() functions, function @ref doClose() and
 data access functions @ref doFormat(), @ref doFrequency() and @ref doData().
+Importers that can decode parts of the file without processing all of it
+should also implement @ref doFrameCount() and @ref doReadFrames(), the default
+implementations go through @ref doData().
 
 You don't need to do most of the redundant sanity checks, these things are
 checked by the implementation:
@@ -57,6 +60,11 @@ checked by the implementation:
     is any file opened.
 -   Function @ref doOpenData() is called only if @ref Feature::OpenData is
     supported.
+-   Function @ref doOpenMemory() is called only if @ref Feature::OpenMemory
+    is supported.
+-   Function @ref doReadFrames() is called only with @p offset not larger
+    than @ref frameCount() and @p count clamped so the range doesn't go past
+    the end.
 -   All `do*()` implementations working on opened file are called only if
     there is any file opened.
 
@@ -74,7 +82,15 @@ class MAGNUM_AUDIO_EXPORT AbstractImporter: public PluginManager::AbstractManagi
          */
         enum class Feature: UnsignedByte {
             /** Opening files from raw data using @ref openData() */
-            OpenData = 1 << 0
+            OpenData = 1 << 0,
+
+            /**
+             * Opening data that stays in scope using @ref openMemory(),
+             * without copying it. If supported, @ref openFile() maps the file
+             * into memory instead of reading it. Implies
+             * @ref Feature::OpenData.
+             */
+            OpenMemory = OpenData|(1 << 1)
         };
 
         /**
@@ -88,7 +104,7 @@ class MAGNUM_AUDIO_EXPORT AbstractImporter: public PluginManager::AbstractManagi
          * @brief Plugin interface
          *
          * @code{.cpp}
-         * "cz.mosra.magnum.Audio.AbstractImporter/0.1"
+         * "cz.mosra.magnum.Audio.AbstractImporter/0.2"
          * @endcode
          */
         static std::string pluginInterface();
@@ -120,6 +136,8 @@ class MAGNUM_AUDIO_EXPORT AbstractImporter: public PluginManager::AbstractManagi
         /** @brief Plugin manager constructor */
         explicit AbstractImporter(PluginManager::AbstractManager& manager, const std::string& plugin);
 
+        ~AbstractImporter();
+
         /** @brief Features supported by this importer */
         Features features() const { return doFeatures(); }
 
@@ -136,11 +154,29 @@ class MAGNUM_AUDIO_EXPORT AbstractImporter: public PluginManager::AbstractManagi
          */
         bool openData(Containers::ArrayView<const char> data);
 
+        /**
+         * @brief Open memory
+         *
+         * Closes previous file, if it was opened, and tries to open given
+         * memory. Unlike @ref openData(), the importer doesn't make a copy
+         * of @p memory and may reference it until the file is closed, so the
+         * memory is expected to stay in scope and unchanged until then.
+         * Available only if @ref Feature::OpenMemory is supported. Returns
+         * @cpp true @ce on success, @cpp false @ce otherwise.
+         * @see @ref features(), @ref openFile()
+         */
+        bool openMemory(Containers::ArrayView<const char> memory);
+
         /**
          * @brief Open file
          *
          * Closes previous file, if it was opened, and tries to open given
          * file. Returns @cpp true @ce on success, @cpp false @ce otherwise.
+         *
+         * If @ref Feature::OpenMemory is supported and the platform allows
+         * it, the file is memory-mapped instead of being read into memory,
+         * so only the parts accessed through @ref readFrames() are paged in.
+         * The mapping is released on @ref close().
          * @see @ref features(), @ref openData()
          */
         bool openFile(const std::string& filename);
@@ -159,6 +195,36 @@ class MAGNUM_AUDIO_EXPORT AbstractImporter: public PluginManager::AbstractManagi
         /** @brief Sample data */
         Containers::Array<char> data();
 
+        /**
+         * @brief Frame size
+         *
+         * Size of one frame in bytes, i.e. one sample for all channels,
+         * calculated from @ref format().
+         * @see @ref frameCount(), @ref readFrames()
+         */
+        UnsignedInt frameSize() const;
+
+        /**
+         * @brief Frame count
+         *
+         * Count of frames available through @ref readFrames().
+         * @see @ref frameSize()
+         */
+        std::size_t frameCount();
+
+        /**
+         * @brief Read a range of frames
+         *
+         * Returns sample data of @p count frames starting at frame
+         * @p offset, clamped to @ref frameCount(). Expects that @p offset is
+         * not larger than @ref frameCount(). Together with
+         * @ref Feature::OpenMemory this allows streaming long tracks from
+         * disk in chunks, for example into a queue of @ref Buffer instances,
+         * without having the whole decoded file in memory.
+         * @see @ref data()
+         */
+        Containers::Array<char> readFrames(std::size_t offset, std::size_t count);
+
         /*@}*/
 
     #ifndef DOXYGEN_GENERATING_OUTPUT
@@ -175,11 +241,22 @@ class MAGNUM_AUDIO_EXPORT AbstractImporter: public PluginManager::AbstractManagi
         /** @brief Implementation for @ref openData() */
         virtual void doOpenData(Containers::ArrayView<const char> data);
 
+        /**
+         * @brief Implementation for @ref openMemory()
+         *
+         * Default implementation calls @ref doOpenData(). It's allowed to
+         * keep @p memory referenced until @ref doClose() is called.
+         */
+        virtual void doOpenMemory(Containers::ArrayView<const char> memory);
+
         /**
          * @brief Implementation for @ref openFile()
          *
-         * If @ref Feature::OpenData is supported, default implementation opens
-         * the file and calls @ref doOpenData() with its contents.
+         * If @ref Feature::OpenMemory is supported, default implementation
+         * maps the file into memory and calls @ref doOpenMemory() with the
+         * mapping. Otherwise, or if the file can't be mapped and
+         * @ref Feature::OpenData is supported, it reads the file and calls
+         * @ref doOpenData() with its contents.
          */
         virtual void doOpenFile(const std::string& filename);
 
@@ -194,6 +271,28 @@ class MAGNUM_AUDIO_EXPORT AbstractImporter: public PluginManager::AbstractManagi
 
         /** @brief Implementation for @ref data() */
         virtual Containers::Array<char> doData() = 0;
+
+        /**
+         * @brief Implementation for @ref frameCount()
+         *
+         * Default implementation divides size of @ref doData() by
+         * @ref frameSize().
+         */
+        virtual std::size_t doFrameCount();
+
+        /**
+         * @brief Implementation for @ref readFrames()
+         *
+         * Default implementation copies given range out of @ref doData().
+         */
+        virtual Containers::Array<char> doReadFrames(std::size_t offset, std::size_t count);
+
+    private:
+        void unmapFile();
+
+        /* File mapped by the default doOpenFile() implementation */
+        const char* _mappedData{};
+        std::size_t _mappedSize{};
 };
 
 }}
@@ -36,8 +36,10 @@ namespace Magnum { namespace Audio {
 #ifndef DOXYGEN_GENERATING_OUTPUT
 class AbstractImporter;
 class Buffer;
+class CommandQueue;
 class Context;
 class Source;
+class StreamingSource;
 /* Renderer used only statically */
 #endif
 
@@ -53,6 +55,10 @@ template<UnsignedInt> class Listener;
 typedef Listener<2> Listener2D;
 typedef Listener<3> Listener3D;
 
+template<UnsignedInt> class PlayableOcclusion;
+typedef PlayableOcclusion<2> PlayableOcclusion2D;
+typedef PlayableOcclusion<3> PlayableOcclusion3D;
+
 }}
 
 #endif
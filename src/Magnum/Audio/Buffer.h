@@ -228,6 +228,15 @@ class Buffer {
         /** @brief OpenAL buffer ID */
         ALuint id() const { return _id; }
 
+        /**
+         * @brief Duration in seconds
+         *
+         * Calculated from buffer size, sample format and frequency.
+         * @see @fn_al_keyword{GetBufferi} with @def_al{SIZE}, @def_al{BITS},
+         *      @def_al{CHANNELS} and @def_al{FREQUENCY}
+         */
+        Float duration() const;
+
         /**
          * @brief Set buffer data
          * @param format    Sample format
@@ -259,6 +268,16 @@ inline Buffer& Buffer::operator=(Buffer&& other) {
     return *this;
 }
 
+inline Float Buffer::duration() const {
+    ALint size, bits, channels, frequency;
+    alGetBufferi(_id, AL_SIZE, &size);
+    alGetBufferi(_id, AL_BITS, &bits);
+    alGetBufferi(_id, AL_CHANNELS, &channels);
+    alGetBufferi(_id, AL_FREQUENCY, &frequency);
+    if(!bits || !channels || !frequency) return 0.0f;
+    return Float(size*8/(bits*channels))/Float(frequency);
+}
+
 }}
 
 #endif
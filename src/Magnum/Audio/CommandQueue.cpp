@@ -0,0 +1,313 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "CommandQueue.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include <thread>
+#endif
+#include <al.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Audio/Source.h"
+#include "Magnum/Math/Functions.h"
+
+namespace Magnum { namespace Audio {
+
+namespace {
+    typedef std::unique_lock<std::mutex> Lock;
+    typedef std::chrono::steady_clock Clock;
+
+    enum class Type: UnsignedByte {
+        Play, Pause, Stop, Rewind, Fade, Crossfade
+    };
+
+    struct Command {
+        Type type;
+        std::vector<ALuint> ids;
+        Float gain, duration;
+        CommandQueue::Curve curve;
+    };
+
+    struct Fade {
+        ALuint id;
+        Float from, to, duration;
+        CommandQueue::Curve curve;
+        bool stopAtEnd;
+        Clock::time_point start;
+    };
+
+    Float curveValue(const CommandQueue::Curve curve, const Float t) {
+        switch(curve) {
+            case CommandQueue::Curve::Linear: return t;
+            case CommandQueue::Curve::EaseIn: return t*t;
+            case CommandQueue::Curve::EaseOut: return 1.0f - (1.0f - t)*(1.0f - t);
+            case CommandQueue::Curve::SmoothStep: return t*t*(3.0f - 2.0f*t);
+        }
+
+        CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+    }
+}
+
+struct CommandQueue::State {
+    explicit State(Float interval): interval{std::chrono::duration_cast<Clock::duration>(std::chrono::duration<Float>{interval})} {}
+
+    /* Executes submitted commands and steps the fades. Called without the
+       mutex locked, the fades are accessed only by the executing side. */
+    void execute(std::vector<Command>& commands);
+    void stepFades(Clock::time_point now);
+    void startFade(ALuint id, Float to, Float duration, Curve curve, bool stopAtEnd, Clock::time_point now);
+    void abandonFades(const std::vector<ALuint>& ids);
+
+    const Clock::duration interval;
+    std::vector<Fade> fades;
+
+    mutable std::mutex mutex;
+    std::condition_variable wakeUp, done;
+    std::vector<Command> commands;
+    bool idle{true};
+    bool stop{};
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    std::thread worker;
+    #endif
+};
+
+void CommandQueue::State::startFade(const ALuint id, const Float to, const Float duration, const Curve curve, const bool stopAtEnd, const Clock::time_point now) {
+    /* A new fade replaces the previous one and continues from the current
+       gain */
+    abandonFades({id});
+
+    Float from;
+    alGetSourcef(id, AL_GAIN, &from);
+    fades.push_back(Fade{id, from, to, duration, curve, stopAtEnd, now});
+}
+
+void CommandQueue::State::abandonFades(const std::vector<ALuint>& ids) {
+    fades.erase(std::remove_if(fades.begin(), fades.end(), [&ids](const Fade& fade) {
+        return std::find(ids.begin(), ids.end(), fade.id) != ids.end();
+    }), fades.end());
+}
+
+void CommandQueue::State::execute(std::vector<Command>& commands) {
+    const Clock::time_point now = Clock::now();
+    for(Command& command: commands) {
+        const ALsizei count = command.ids.size();
+        switch(command.type) {
+            case Type::Play:
+                alSourcePlayv(count, command.ids.data());
+                break;
+            case Type::Pause:
+                alSourcePausev(count, command.ids.data());
+                break;
+            case Type::Stop:
+                abandonFades(command.ids);
+                alSourceStopv(count, command.ids.data());
+                break;
+            case Type::Rewind:
+                alSourceRewindv(count, command.ids.data());
+                break;
+            case Type::Fade:
+                for(ALuint id: command.ids)
+                    startFade(id, command.gain, command.duration, command.curve, false, now);
+                break;
+            case Type::Crossfade:
+                abandonFades({command.ids[1]});
+                alSourcef(command.ids[1], AL_GAIN, 0.0f);
+                alSourcePlay(command.ids[1]);
+                startFade(command.ids[0], 0.0f, command.duration, command.curve, true, now);
+                startFade(command.ids[1], command.gain, command.duration, command.curve, false, now);
+                break;
+        }
+    }
+    commands.clear();
+
+    stepFades(now);
+}
+
+void CommandQueue::State::stepFades(const Clock::time_point now) {
+    for(auto it = fades.begin(); it != fades.end(); ) {
+        const Float elapsed = std::chrono::duration<Float>(now - it->start).count();
+        const Float t = it->duration > 0.0f ? Math::min(elapsed/it->duration, 1.0f) : 1.0f;
+        alSourcef(it->id, AL_GAIN, Math::lerp(it->from, it->to, curveValue(it->curve, t)));
+
+        if(t < 1.0f) {
+            ++it;
+            continue;
+        }
+
+        if(it->stopAtEnd) alSourceStop(it->id);
+        it = fades.erase(it);
+    }
+}
+
+CommandQueue::CommandQueue(const Float interval): _state{new State{interval}} {
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    State& state = *_state;
+    state.worker = std::thread{[&state]() {
+        std::vector<Command> commands;
+        Lock lock{state.mutex};
+        for(;;) {
+            /* Sleep until there's something to do. With fades in progress,
+               wake up every interval to step them. */
+            if(state.fades.empty())
+                state.wakeUp.wait(lock, [&state]() { return state.stop || !state.commands.empty(); });
+            else
+                state.wakeUp.wait_for(lock, state.interval, [&state]() { return state.stop || !state.commands.empty(); });
+
+            /* Execute what's left before exiting */
+            const bool stop = state.stop;
+            std::swap(commands, state.commands);
+            lock.unlock();
+            state.execute(commands);
+            lock.lock();
+
+            state.idle = state.commands.empty() && state.fades.empty();
+            if(state.idle) state.done.notify_all();
+            if(stop) break;
+        }
+    }};
+    #endif
+}
+
+CommandQueue::~CommandQueue() {
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    {
+        Lock lock{_state->mutex};
+        _state->stop = true;
+    }
+    _state->wakeUp.notify_one();
+    _state->worker.join();
+    #else
+    update();
+    #endif
+}
+
+CommandQueue& CommandQueue::submit(const UnsignedByte type, std::vector<UnsignedInt>&& ids, const Float gain, const Float duration, const Curve curve) {
+    {
+        Lock lock{_state->mutex};
+        _state->commands.push_back(Command{Type(type), std::move(ids), gain, duration, curve});
+        _state->idle = false;
+    }
+    _state->wakeUp.notify_one();
+    return *this;
+}
+
+namespace {
+    template<class Sources> std::vector<UnsignedInt> sourceIds(const Sources& sources) {
+        std::vector<UnsignedInt> ids;
+        ids.reserve(sources.size());
+        for(const Source& source: sources) ids.push_back(source.id());
+        return ids;
+    }
+}
+
+CommandQueue& CommandQueue::play(const std::initializer_list<std::reference_wrapper<Source>> sources) {
+    return submit(UnsignedByte(Type::Play), sourceIds(sources));
+}
+
+CommandQueue& CommandQueue::play(const std::vector<std::reference_wrapper<Source>>& sources) {
+    return submit(UnsignedByte(Type::Play), sourceIds(sources));
+}
+
+CommandQueue& CommandQueue::pause(const std::initializer_list<std::reference_wrapper<Source>> sources) {
+    return submit(UnsignedByte(Type::Pause), sourceIds(sources));
+}
+
+CommandQueue& CommandQueue::pause(const std::vector<std::reference_wrapper<Source>>& sources) {
+    return submit(UnsignedByte(Type::Pause), sourceIds(sources));
+}
+
+CommandQueue& CommandQueue::stop(const std::initializer_list<std::reference_wrapper<Source>> sources) {
+    return submit(UnsignedByte(Type::Stop), sourceIds(sources));
+}
+
+CommandQueue& CommandQueue::stop(const std::vector<std::reference_wrapper<Source>>& sources) {
+    return submit(UnsignedByte(Type::Stop), sourceIds(sources));
+}
+
+CommandQueue& CommandQueue::rewind(const std::initializer_list<std::reference_wrapper<Source>> sources) {
+    return submit(UnsignedByte(Type::Rewind), sourceIds(sources));
+}
+
+CommandQueue& CommandQueue::rewind(const std::vector<std::reference_wrapper<Source>>& sources) {
+    return submit(UnsignedByte(Type::Rewind), sourceIds(sources));
+}
+
+CommandQueue& CommandQueue::fade(const std::initializer_list<std::reference_wrapper<Source>> sources, const Float gain, const Float duration, const Curve curve) {
+    return submit(UnsignedByte(Type::Fade), sourceIds(sources), gain, duration, curve);
+}
+
+CommandQueue& CommandQueue::fade(const std::vector<std::reference_wrapper<Source>>& sources, const Float gain, const Float duration, const Curve curve) {
+    return submit(UnsignedByte(Type::Fade), sourceIds(sources), gain, duration, curve);
+}
+
+CommandQueue& CommandQueue::crossfade(Source& from, Source& to, const Float gain, const Float duration, const Curve curve) {
+    return submit(UnsignedByte(Type::Crossfade), {from.id(), to.id()}, gain, duration, curve);
+}
+
+bool CommandQueue::isFinished() const {
+    Lock lock{_state->mutex};
+    return _state->idle;
+}
+
+void CommandQueue::finish() {
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    Lock lock{_state->mutex};
+    _state->done.wait(lock, [this]() { return _state->idle; });
+    #else
+    while(!isFinished()) update();
+    #endif
+}
+
+void CommandQueue::update() {
+    #ifdef CORRADE_TARGET_EMSCRIPTEN
+    std::vector<Command> commands;
+    std::swap(commands, _state->commands);
+    _state->execute(commands);
+    _state->idle = _state->commands.empty() && _state->fades.empty();
+    #endif
+}
+
+Debug& operator<<(Debug& debug, const CommandQueue::Curve value) {
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case CommandQueue::Curve::value: return debug << "Audio::CommandQueue::Curve::" #value;
+        _c(Linear)
+        _c(EaseIn)
+        _c(EaseOut)
+        _c(SmoothStep)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "Audio::CommandQueue::Curve(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
+}
+
+}}
@@ -0,0 +1,237 @@
+#ifndef Magnum_Audio_CommandQueue_h
+#define Magnum_Audio_CommandQueue_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Audio::CommandQueue
+ */
+
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <vector>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Audio/Audio.h"
+#include "Magnum/Audio/visibility.h"
+
+namespace Magnum { namespace Audio {
+
+/**
+@brief Audio command queue
+
+Executes batched playback commands and gain fades on a dedicated thread, so
+fades don't need to be driven from the main loop and their timing doesn't
+depend on the frame rate. Commands are executed in the order in which they
+were submitted:
+
+@code{.cpp}
+Audio::CommandQueue queue;
+
+// Start all layers of the music at once, with the second one silent
+queue.play({base, drums});
+queue.fade(drums, 0.0f, 0.0f);
+
+// ... later, fade the drums in over two seconds
+queue.fade(drums, 1.0f, 2.0f, Audio::CommandQueue::Curve::SmoothStep);
+
+// ... and crossfade to another track, stopping the old one at the end
+queue.crossfade(base, boss, 1.0f, 3.0f);
+@endcode
+
+Playing, pausing, stopping and rewinding a set of sources is done with a
+single @fn_al{SourcePlayv} and similar calls, which start all sources in the
+same mixing update. Fades are updated in steps of the interval passed to the
+constructor, measured with a steady clock. Starting a fade on a source that
+is already fading replaces the previous fade, the new one starts from the
+current gain.
+
+@section Audio-CommandQueue-threading Threading
+
+The commands can be submitted from any thread. OpenAL is called from the
+queue thread, which relies on the OpenAL 1.1 guarantee of a process-wide
+current context and thread-safe API calls. The queue stores only OpenAL
+source IDs, so the @ref Source instances have to stay alive until their
+commands and fades are done, use @ref finish() to wait for that. Don't set
+gain of a fading source directly, as it gets overwritten by the fade on the
+next step. On platforms without thread support (such as
+@ref CORRADE_TARGET_EMSCRIPTEN "Emscripten") the commands are executed in
+@ref update(), which has to be called periodically, on the calling thread.
+*/
+class MAGNUM_AUDIO_EXPORT CommandQueue {
+    public:
+        /**
+         * @brief Fade curve
+         *
+         * @see @ref fade(), @ref crossfade()
+         */
+        enum class Curve: UnsignedByte {
+            /** Gain changes linearly with time */
+            Linear,
+
+            /** Slow start, quadratic */
+            EaseIn,
+
+            /** Slow end, quadratic */
+            EaseOut,
+
+            /** Slow start and end, cubic Hermite */
+            SmoothStep
+        };
+
+        /**
+         * @brief Constructor
+         * @param interval  Interval between fade steps, in seconds
+         *
+         * Spawns the queue thread.
+         */
+        explicit CommandQueue(Float interval = 0.005f);
+
+        /** @brief Copying is not allowed */
+        CommandQueue(const CommandQueue&) = delete;
+
+        /** @brief Moving is not allowed */
+        CommandQueue(CommandQueue&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Stops the queue thread. Commands that weren't executed yet are
+         * executed, fades in progress are abandoned with the gain at their
+         * last step.
+         */
+        ~CommandQueue();
+
+        /** @brief Copying is not allowed */
+        CommandQueue& operator=(const CommandQueue&) = delete;
+
+        /** @brief Moving is not allowed */
+        CommandQueue& operator=(CommandQueue&&) = delete;
+
+        /**
+         * @brief Play a set of sources
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref Source::play(std::initializer_list<std::reference_wrapper<Source>>)
+         */
+        CommandQueue& play(std::initializer_list<std::reference_wrapper<Source>> sources);
+        CommandQueue& play(const std::vector<std::reference_wrapper<Source>>& sources); /**< @overload */
+
+        /**
+         * @brief Pause a set of sources
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref Source::pause(std::initializer_list<std::reference_wrapper<Source>>)
+         */
+        CommandQueue& pause(std::initializer_list<std::reference_wrapper<Source>> sources);
+        CommandQueue& pause(const std::vector<std::reference_wrapper<Source>>& sources); /**< @overload */
+
+        /**
+         * @brief Stop a set of sources
+         * @return Reference to self (for method chaining)
+         *
+         * Also abandons fades in progress on these sources.
+         * @see @ref Source::stop(std::initializer_list<std::reference_wrapper<Source>>)
+         */
+        CommandQueue& stop(std::initializer_list<std::reference_wrapper<Source>> sources);
+        CommandQueue& stop(const std::vector<std::reference_wrapper<Source>>& sources); /**< @overload */
+
+        /**
+         * @brief Rewind a set of sources
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref Source::rewind(std::initializer_list<std::reference_wrapper<Source>>)
+         */
+        CommandQueue& rewind(std::initializer_list<std::reference_wrapper<Source>> sources);
+        CommandQueue& rewind(const std::vector<std::reference_wrapper<Source>>& sources); /**< @overload */
+
+        /**
+         * @brief Fade gain of a set of sources
+         * @param sources   Sources to fade
+         * @param gain      Target gain
+         * @param duration  Fade duration in seconds
+         * @param curve     Fade curve
+         * @return Reference to self (for method chaining)
+         *
+         * Each source fades from its current gain at the time the command is
+         * executed. With zero @p duration the gain is set immediately.
+         * @see @ref Source::setGain()
+         */
+        CommandQueue& fade(std::initializer_list<std::reference_wrapper<Source>> sources, Float gain, Float duration, Curve curve = Curve::Linear);
+        CommandQueue& fade(const std::vector<std::reference_wrapper<Source>>& sources, Float gain, Float duration, Curve curve = Curve::Linear); /**< @overload */
+
+        /**
+         * @brief Crossfade between two sources
+         * @param from      Source to fade out
+         * @param to        Source to fade in
+         * @param gain      Target gain of @p to
+         * @param duration  Crossfade duration in seconds
+         * @param curve     Fade curve
+         * @return Reference to self (for method chaining)
+         *
+         * Sets gain of @p to to zero and starts playing it, then fades @p from
+         * to zero and @p to to @p gain at the same time. At the end, @p from
+         * is stopped.
+         */
+        CommandQueue& crossfade(Source& from, Source& to, Float gain, Float duration, Curve curve = Curve::Linear);
+
+        /**
+         * @brief Wait until all commands and fades are done
+         *
+         * Blocks the calling thread. On platforms without thread support it
+         * calls @ref update() until everything is done.
+         */
+        void finish();
+
+        /**
+         * @brief Whether all commands and fades are done
+         *
+         * @see @ref finish()
+         */
+        bool isFinished() const;
+
+        /**
+         * @brief Execute the commands on the calling thread
+         *
+         * Has to be called periodically on platforms without thread support,
+         * does nothing elsewhere.
+         */
+        void update();
+
+    private:
+        struct State;
+
+        CommandQueue& submit(UnsignedByte type, std::vector<UnsignedInt>&& ids, Float gain = 0.0f, Float duration = 0.0f, Curve curve = Curve::Linear);
+
+        std::unique_ptr<State> _state;
+};
+
+/** @debugoperatorclassenum{CommandQueue,CommandQueue::Curve} */
+MAGNUM_AUDIO_EXPORT Debug& operator<<(Debug& debug, CommandQueue::Curve value);
+
+}}
+
+#endif
@@ -197,6 +197,12 @@ std::string Context::hrtfSpecifierString() const {
     return Utility::String::fromArray(alcGetString(_device, ALC_HRTF_SPECIFIER_SOFT));
 }
 
+Int Context::frequency() const {
+    Int frequency;
+    alcGetIntegerv(_device, ALC_FREQUENCY, 1, &frequency);
+    return frequency;
+}
+
 std::string Context::deviceSpecifierString() const {
     return alcGetString(_device, ALC_DEVICE_SPECIFIER);
 }
@@ -212,6 +212,16 @@ class MAGNUM_AUDIO_EXPORT Context {
          */
         std::string hrtfSpecifierString() const;
 
+        /**
+         * @brief Output frequency
+         *
+         * Frequency the device is mixing at, in Hz. Converting buffer data
+         * to it with @ref Audio::convert() avoids resampling at runtime.
+         * @see @ref Configuration::setFrequency(), @fn_alc{GetIntegerv}
+         *      with @def_alc_keyword{FREQUENCY}
+         */
+        Int frequency() const;
+
         #ifdef MAGNUM_BUILD_DEPRECATED
         /** @brief @copybrief hrtfSpecifierString()
          * @deprecated Use @ref hrtfSpecifierString() instead.
@@ -0,0 +1,211 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Conversion.h"
+
+#include <cstring>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Math/Functions.h"
+
+namespace Magnum { namespace Audio {
+
+namespace {
+
+struct FormatInfo {
+    UnsignedInt channelCount;
+    /* 1 is unsigned 8-bit, 2 signed 16-bit, 4 float and 8 double */
+    UnsignedInt sampleSize;
+};
+
+bool formatInfo(const Buffer::Format format, FormatInfo& info) {
+    switch(format) {
+        case Buffer::Format::Mono8: info = {1, 1}; return true;
+        case Buffer::Format::Mono16: info = {1, 2}; return true;
+        case Buffer::Format::MonoFloat: info = {1, 4}; return true;
+        case Buffer::Format::MonoDouble: info = {1, 8}; return true;
+        case Buffer::Format::Stereo8: info = {2, 1}; return true;
+        case Buffer::Format::Stereo16: info = {2, 2}; return true;
+        case Buffer::Format::StereoFloat: info = {2, 4}; return true;
+        case Buffer::Format::StereoDouble: info = {2, 8}; return true;
+        default: return false;
+    }
+}
+
+/* The loops below are kept trivial so the compiler can vectorize them */
+
+Containers::Array<Float> decode(const FormatInfo& info, const Containers::ArrayView<const char> data) {
+    const std::size_t count = data.size()/info.sampleSize;
+    Containers::Array<Float> out{Containers::NoInit, count};
+    Float* const o = out.data();
+    switch(info.sampleSize) {
+        case 1: {
+            const UnsignedByte* const in = reinterpret_cast<const UnsignedByte*>(data.data());
+            for(std::size_t i = 0; i != count; ++i)
+                o[i] = (Float(in[i]) - 128.0f)/128.0f;
+        } break;
+        case 2: {
+            const Short* const in = reinterpret_cast<const Short*>(data.data());
+            for(std::size_t i = 0; i != count; ++i)
+                o[i] = Float(in[i])/32768.0f;
+        } break;
+        case 4:
+            std::memcpy(o, data.data(), count*4);
+            break;
+        case 8: {
+            const Double* const in = reinterpret_cast<const Double*>(data.data());
+            for(std::size_t i = 0; i != count; ++i)
+                o[i] = Float(in[i]);
+        } break;
+    }
+    return out;
+}
+
+Containers::Array<char> encode(const FormatInfo& info, const Containers::ArrayView<const Float> samples) {
+    const std::size_t count = samples.size();
+    Containers::Array<char> out{Containers::NoInit, count*info.sampleSize};
+    const Float* const in = samples.data();
+    switch(info.sampleSize) {
+        case 1: {
+            UnsignedByte* const o = reinterpret_cast<UnsignedByte*>(out.data());
+            for(std::size_t i = 0; i != count; ++i)
+                o[i] = UnsignedByte(Math::clamp(in[i]*128.0f + 128.5f, 0.0f, 255.0f));
+        } break;
+        case 2: {
+            Short* const o = reinterpret_cast<Short*>(out.data());
+            for(std::size_t i = 0; i != count; ++i)
+                o[i] = Short(Math::round(Math::clamp(in[i]*32768.0f, -32768.0f, 32767.0f)));
+        } break;
+        case 4:
+            std::memcpy(out.data(), in, count*4);
+            break;
+        case 8: {
+            Double* const o = reinterpret_cast<Double*>(out.data());
+            for(std::size_t i = 0; i != count; ++i)
+                o[i] = Double(in[i]);
+        } break;
+    }
+    return out;
+}
+
+Containers::Array<Float> remix(Containers::Array<Float>&& samples, const UnsignedInt sourceChannelCount, const UnsignedInt targetChannelCount) {
+    if(sourceChannelCount == targetChannelCount) return std::move(samples);
+
+    /* Mono to stereo */
+    if(targetChannelCount == 2) {
+        Containers::Array<Float> out{Containers::NoInit, samples.size()*2};
+        for(std::size_t i = 0; i != samples.size(); ++i)
+            out[2*i] = out[2*i + 1] = samples[i];
+        return out;
+    }
+
+    /* Stereo to mono */
+    Containers::Array<Float> out{Containers::NoInit, samples.size()/2};
+    for(std::size_t i = 0; i != out.size(); ++i)
+        out[i] = (samples[2*i] + samples[2*i + 1])*0.5f;
+    return out;
+}
+
+Containers::Array<Float> resampleFrames(Containers::Array<Float>&& samples, const UnsignedInt channelCount, const UnsignedInt sourceFrequency, const UnsignedInt targetFrequency) {
+    const std::size_t sourceFrameCount = samples.size()/channelCount;
+    if(sourceFrequency == targetFrequency || !sourceFrameCount)
+        return std::move(samples);
+
+    const std::size_t targetFrameCount = Math::max(std::size_t(UnsignedLong(sourceFrameCount)*targetFrequency/sourceFrequency), std::size_t{1});
+    const Double step = Double(sourceFrequency)/Double(targetFrequency);
+
+    Containers::Array<Float> out{Containers::NoInit, targetFrameCount*channelCount};
+    for(std::size_t i = 0; i != targetFrameCount; ++i) {
+        const Double position = i*step;
+        const std::size_t a = Math::min(std::size_t(position), sourceFrameCount - 1);
+        const std::size_t b = Math::min(a + 1, sourceFrameCount - 1);
+        const Float t = Float(position - Double(a));
+        for(UnsignedInt c = 0; c != channelCount; ++c)
+            out[i*channelCount + c] = Math::lerp(samples[a*channelCount + c], samples[b*channelCount + c], t);
+    }
+    return out;
+}
+
+}
+
+Containers::Array<char> convertFormat(const Buffer::Format sourceFormat, const Containers::ArrayView<const char> data, const Buffer::Format targetFormat) {
+    FormatInfo source, target;
+    CORRADE_ASSERT(formatInfo(sourceFormat, source),
+        "Audio::convertFormat(): unsupported source format" << sourceFormat, nullptr);
+    CORRADE_ASSERT(formatInfo(targetFormat, target),
+        "Audio::convertFormat(): unsupported target format" << targetFormat, nullptr);
+    CORRADE_ASSERT(data.size() % (source.channelCount*source.sampleSize) == 0,
+        "Audio::convertFormat(): data size" << data.size() << "is not divisible by frame size" << source.channelCount*source.sampleSize, nullptr);
+
+    const Containers::Array<Float> samples = remix(decode(source, data), source.channelCount, target.channelCount);
+    return encode(target, samples);
+}
+
+Containers::Array<char> resample(const Buffer::Format format, const Containers::ArrayView<const char> data, const UnsignedInt sourceFrequency, const UnsignedInt targetFrequency) {
+    FormatInfo info;
+    CORRADE_ASSERT(formatInfo(format, info),
+        "Audio::resample(): unsupported format" << format, nullptr);
+    CORRADE_ASSERT(data.size() % (info.channelCount*info.sampleSize) == 0,
+        "Audio::resample(): data size" << data.size() << "is not divisible by frame size" << info.channelCount*info.sampleSize, nullptr);
+    CORRADE_ASSERT(sourceFrequency && targetFrequency,
+        "Audio::resample(): expected non-zero frequencies", nullptr);
+
+    const Containers::Array<Float> samples = resampleFrames(decode(info, data), info.channelCount, sourceFrequency, targetFrequency);
+    return encode(info, samples);
+}
+
+Containers::Array<char> convert(const Buffer::Format sourceFormat, const Containers::ArrayView<const char> data, const UnsignedInt sourceFrequency, const Buffer::Format targetFormat, const UnsignedInt targetFrequency) {
+    FormatInfo source, target;
+    CORRADE_ASSERT(formatInfo(sourceFormat, source),
+        "Audio::convert(): unsupported source format" << sourceFormat, nullptr);
+    CORRADE_ASSERT(formatInfo(targetFormat, target),
+        "Audio::convert(): unsupported target format" << targetFormat, nullptr);
+    CORRADE_ASSERT(data.size() % (source.channelCount*source.sampleSize) == 0,
+        "Audio::convert(): data size" << data.size() << "is not divisible by frame size" << source.channelCount*source.sampleSize, nullptr);
+    CORRADE_ASSERT(sourceFrequency && targetFrequency,
+        "Audio::convert(): expected non-zero frequencies", nullptr);
+
+    /* Nothing to do, just copy */
+    if(sourceFormat == targetFormat && sourceFrequency == targetFrequency) {
+        Containers::Array<char> out{Containers::NoInit, data.size()};
+        std::memcpy(out.data(), data.data(), data.size());
+        return out;
+    }
+
+    /* Down-mix first so there's less to resample, up-mix last */
+    Containers::Array<Float> samples = decode(source, data);
+    if(target.channelCount < source.channelCount) {
+        samples = remix(std::move(samples), source.channelCount, target.channelCount);
+        samples = resampleFrames(std::move(samples), target.channelCount, sourceFrequency, targetFrequency);
+    } else {
+        samples = resampleFrames(std::move(samples), source.channelCount, sourceFrequency, targetFrequency);
+        samples = remix(std::move(samples), source.channelCount, target.channelCount);
+    }
+    return encode(target, samples);
+}
+
+}}
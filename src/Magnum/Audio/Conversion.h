@@ -0,0 +1,89 @@
+#ifndef Magnum_Audio_Conversion_h
+#define Magnum_Audio_Conversion_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::Audio::convertFormat(), @ref Magnum::Audio::resample(), @ref Magnum::Audio::convert()
+ */
+
+#include <Corrade/Containers/Containers.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Audio/Buffer.h"
+#include "Magnum/Audio/visibility.h"
+
+namespace Magnum { namespace Audio {
+
+/**
+@brief Convert sample format
+
+The data are converted sample by sample, mono is duplicated into both
+channels of stereo and stereo is down-mixed into mono by averaging the two
+channels. Float samples are clamped to the @f$ [-1, 1] @f$ range when
+converting to integer formats. Supported formats are
+@ref Buffer::Format::Mono8, @ref Buffer::Format::Mono16,
+@ref Buffer::Format::MonoFloat, @ref Buffer::Format::MonoDouble and their
+stereo counterparts, expects that @p data size is divisible by the frame
+size.
+@see @ref resample(), @ref convert()
+*/
+MAGNUM_AUDIO_EXPORT Containers::Array<char> convertFormat(Buffer::Format sourceFormat, Containers::ArrayView<const char> data, Buffer::Format targetFormat);
+
+/**
+@brief Resample data to another frequency
+
+Uses linear interpolation. Supports the same formats as @ref convertFormat(),
+expects that both frequencies are non-zero.
+@see @ref convert()
+*/
+MAGNUM_AUDIO_EXPORT Containers::Array<char> resample(Buffer::Format format, Containers::ArrayView<const char> data, UnsignedInt sourceFrequency, UnsignedInt targetFrequency);
+
+/**
+@brief Convert sample format and resample data to another frequency
+
+Equivalent to @ref convertFormat() followed by @ref resample(), but done in
+a single pass through an intermediate float representation. Useful for
+converting imported data once to the format and frequency of the device, so
+OpenAL doesn't need to do that each time the buffer is played. Uploading a
+positional sound as mono also makes it actually positional, as OpenAL
+spatializes only mono buffers:
+
+@code{.cpp}
+Audio::Buffer buffer;
+buffer.setData(Audio::Buffer::Format::Mono16,
+    Audio::convert(importer->format(), importer->data(), importer->frequency(),
+        Audio::Buffer::Format::Mono16, context.frequency()),
+    context.frequency());
+@endcode
+
+If both the formats and frequencies are the same, the data are just copied.
+@see @ref Context::frequency()
+*/
+MAGNUM_AUDIO_EXPORT Containers::Array<char> convert(Buffer::Format sourceFormat, Containers::ArrayView<const char> data, UnsignedInt sourceFrequency, Buffer::Format targetFormat, UnsignedInt targetFrequency);
+
+}}
+
+#endif
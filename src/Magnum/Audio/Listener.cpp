@@ -82,19 +82,23 @@ template<UnsignedInt dimensions> void Listener<dimensions>::update(std::initiali
         Renderer::setListenerGain(_gain);
     }
 
-    /* Add all objects of the Playables in the PlayableGroups to a vector to
-       later setClean() */
-    std::vector<std::reference_wrapper<AbstractObject<dimensions, Float>>> objects;
-
-    objects.push_back(this->object());
+    /* Add all dirty objects of the Playables in the PlayableGroups to a
+       vector to later setClean(). Clean objects would be skipped anyway. */
+    _dirtyObjects.clear();
+    _dirtyObjects.push_back(this->object());
     for(PlayableGroup<dimensions>& group : groups) {
         for(UnsignedInt i = 0; i < group.size(); ++i) {
-            objects.push_back(group[i].object());
+            if(group[i].object().isDirty())
+                _dirtyObjects.push_back(group[i].object());
         }
     }
 
     /* Use the more performant way to set multiple objects clean */
-    AbstractObject<dimensions, Float>::setClean(objects);
+    AbstractObject<dimensions, Float>::setClean(_dirtyObjects);
+
+    /* Issue the AL calls for playables that changed */
+    for(PlayableGroup<dimensions>& group : groups)
+        group.updateSources();
 }
 
 /* On non-MinGW Windows the instantiations are already marked with extern
@@ -187,6 +187,9 @@ template <UnsignedInt dimensions> class Listener: public SceneGraph::AbstractFea
 
         Matrix4 _soundTransformation;
         Float _gain;
+
+        /* Scratch storage reused in update() */
+        std::vector<std::reference_wrapper<SceneGraph::AbstractObject<dimensions, Float>>> _dirtyObjects;
 };
 
 
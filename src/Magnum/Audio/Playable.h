@@ -68,8 +68,24 @@ Position of the source will be updated to the translation of `object` when
 @ref SceneGraph::Object::setClean() is called, which is done in
 @ref Audio::Listener::update() or @ref Audio::PlayableGroup::setClean() for example.
 
+For playables in a @ref PlayableGroup, the OpenAL calls are deferred to
+@ref PlayableGroup::updateSources(), which is called from both of the above
+and updates only the properties that actually changed. Playables without a
+group update the source directly in the clean.
+
 To manage multiple Playables at once, use @ref PlayableGroup.
 
+@section Audio-Playable-virtual Virtual voices
+
+Playables constructed in a @ref PlayableGroup with a voice limit don't own an
+OpenAL source. Instead, the group assigns pooled sources only to the most
+audible playables in @ref PlayableGroup::updateVoices(), the others are
+*virtual* --- they remember their buffer, looping and playback offset, so
+they can resume from the right position once they become audible again. For
+such playables, control playback through @ref setBuffer(), @ref setLooping(),
+@ref play() and @ref stop() instead of the @ref source() directly, as the
+source may be taken away at any @ref PlayableGroup::updateVoices() call.
+
 -   @ref Playable2D
 -   @ref Playable3D
 
@@ -77,6 +93,7 @@ To manage multiple Playables at once, use @ref PlayableGroup.
 */
 template<UnsignedInt dimensions> class Playable: public SceneGraph::AbstractGroupedFeature<dimensions, Playable<dimensions>, Float> {
     friend PlayableGroup<dimensions>;
+    friend PlayableOcclusion<dimensions>;
 
     public:
 
@@ -96,17 +113,117 @@ template<UnsignedInt dimensions> class Playable: public SceneGraph::AbstractGrou
             SceneGraph::AbstractGroupedFeature<dimensions, Playable<dimensions>, Float>(object, group),
             _fwd(0.0f),
             _gain(1.0f),
-            _source()
+            _source{group && group->voiceCount() ? Source{NoCreate} : Source{}}
         {
             SceneGraph::AbstractFeature<dimensions, Float>::setCachedTransformations(SceneGraph::CachedTransformation::Absolute);
             _fwd[dimensions - 1] = -1;
         }
 
-        /** @brief Source which is managed by this feature */
+        /**
+         * @brief Destructor
+         *
+         * If the playable has a source assigned from a voice pool, the source
+         * is stopped and returned back to the pool.
+         */
+        ~Playable();
+
+        /**
+         * @brief Source which is managed by this feature
+         *
+         * If the playable is virtual, the source has no underlying OpenAL
+         * object.
+         * @see @ref isVirtual()
+         */
         Source& source() {
             return _source;
         }
 
+        /**
+         * @brief Whether the playable is virtual
+         *
+         * Always @cpp false @ce for playables in groups without a voice
+         * limit.
+         * @see @ref Audio-Playable-virtual, @ref PlayableGroup::voiceCount()
+         */
+        bool isVirtual() const { return !_source.id(); }
+
+        /**
+         * @brief Set buffer to play
+         * @return Reference to self (for method chaining)
+         *
+         * Remembered also while the playable is virtual. Default is
+         * @cpp nullptr @ce.
+         * @see @ref Source::setBuffer()
+         */
+        Playable& setBuffer(Buffer* buffer) {
+            _buffer = buffer;
+            if(!isVirtual()) _source.setBuffer(buffer);
+            return *this;
+        }
+
+        /**
+         * @brief Set whether to loop the buffer
+         * @return Reference to self (for method chaining)
+         *
+         * Remembered also while the playable is virtual. Default is
+         * @cpp false @ce.
+         * @see @ref Source::setLooping()
+         */
+        Playable& setLooping(bool loop) {
+            _looping = loop;
+            if(!isVirtual()) _source.setLooping(loop);
+            return *this;
+        }
+
+        /**
+         * @brief Play from the beginning
+         * @return Reference to self (for method chaining)
+         *
+         * A virtual playable gets a source assigned in the next
+         * @ref PlayableGroup::updateVoices() call, if it's audible enough.
+         * @see @ref Source::play()
+         */
+        Playable& play() {
+            _playing = true;
+            _offset = 0.0f;
+            if(!isVirtual()) _source.play();
+            return *this;
+        }
+
+        /**
+         * @brief Stop playing
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref Source::stop()
+         */
+        Playable& stop() {
+            _playing = false;
+            _offset = 0.0f;
+            if(!isVirtual()) _source.stop();
+            return *this;
+        }
+
+        /**
+         * @brief Whether the playable is playing
+         *
+         * For a virtual playable it's the software-tracked state, updated in
+         * @ref PlayableGroup::updateVoices().
+         */
+        bool isPlaying() const {
+            return isVirtual() ? _playing : _source.state() == Source::State::Playing;
+        }
+
+        /**
+         * @brief Playback offset in seconds
+         *
+         * For a virtual playable it's the software-tracked offset, updated in
+         * @ref PlayableGroup::updateVoices().
+         * @see @ref Source::offsetInSeconds()
+         */
+        Float offsetInSeconds() const {
+            return isVirtual() ? _offset : _source.offsetInSeconds();
+        }
+
         /** @brief Gain */
         Float gain() const {
             return _gain;
@@ -116,7 +233,7 @@ template<UnsignedInt dimensions> class Playable: public SceneGraph::AbstractGrou
          * @brief Set gain of the playable and source respecting the PlayableGroups gain
          * @return Reference to self (for method chaining)
          *
-         * The sources gain is computed as @cpp sourceGain = playableGain*groupGain @ce.
+         * The sources gain is computed as @cpp sourceGain = playableGain*groupGain*occlusionGain @ce.
          * Default for the playables gain is @cpp 1.0f @ce.
          * @see @ref PlayableGroup::setGain(), @ref Source::setGain()
          */
@@ -126,6 +243,17 @@ template<UnsignedInt dimensions> class Playable: public SceneGraph::AbstractGrou
             return *this;
         }
 
+        /**
+         * @brief Occlusion gain
+         *
+         * Factor by which the source gain is attenuated due to occluders
+         * between the playable and the listener, updated by
+         * @ref PlayableOcclusion::update(). Default is @cpp 1.0f @ce, meaning
+         * no attenuation.
+         * @see @ref Audio-PlayableOcclusion
+         */
+        Float occlusionGain() const { return _occlusionGain; }
+
         /**
          * @brief Group containing this playable
          *
@@ -145,27 +273,65 @@ template<UnsignedInt dimensions> class Playable: public SceneGraph::AbstractGrou
             if(playables()) {
                 position = playables()->soundTransformation().transformVector(position);
             }
-            _source.setPosition(position);
-            _source.setDirection(Vector3::pad(absoluteTransformationMatrix.rotation()*_fwd));
+            const Vector3 direction = Vector3::pad(absoluteTransformationMatrix.rotation()*_fwd);
+
+            /* Record only what actually changed, the group then issues the AL
+               calls in a batch */
+            if(position != _position) {
+                _position = position;
+                _dirty |= PositionDirty;
+            }
+            if(direction != _direction) {
+                _direction = direction;
+                _dirty |= DirectionDirty;
+            }
+            if(!playables()) updateSource();
 
             /** @todo velocity */
         }
 
+        /* Issue AL calls for position and direction changed since last time */
+        void updateSource() {
+            if(!isVirtual()) {
+                if(_dirty & PositionDirty) _source.setPosition(_position);
+                if(_dirty & DirectionDirty) _source.setDirection(_direction);
+            }
+            _dirty = 0;
+        }
+
         /* Update the gain of the underlying source to reflect changes in _group and/or _gain.
            Called in Playable::setGain() and PlayableGroup::setGain() */
         void cleanGain() {
-            if(playables()) {
-                _source.setGain(_gain*playables()->gain());
-            } else {
-                _source.setGain(_gain);
-            }
+            if(!isVirtual()) _source.setGain(effectiveGain());
+        }
+
+        Float effectiveGain() const {
+            return (playables() ? _gain*playables()->gain() : _gain)*_occlusionGain;
         }
 
         VectorTypeFor<dimensions, Float> _fwd;
         Float _gain;
+        Float _occlusionGain{1.0f};
         Source _source;
+
+        /* State kept for virtual voices */
+        Buffer* _buffer{};
+        Vector3 _position, _direction;
+        Float _offset{};
+        bool _looping{}, _playing{};
+
+        enum: UnsignedByte {
+            PositionDirty = 1 << 0,
+            DirectionDirty = 1 << 1
+        };
+        UnsignedByte _dirty{};
 };
 
+template<UnsignedInt dimensions> Playable<dimensions>::~Playable() {
+    if(!isVirtual() && playables() && playables()->voiceCount())
+        playables()->releaseVoice(*this);
+}
+
 /**
  * @brief Playable for two dimensional float scenes
  *
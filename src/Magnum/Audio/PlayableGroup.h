@@ -30,16 +30,22 @@
  * @brief Class @ref Magnum::Audio::PlayableGroup, typedef @ref Magnum::Audio::PlayableGroup2D, @ref Magnum::Audio::PlayableGroup3D
  */
 
+#include <algorithm>
+#include <cmath>
 #include <functional>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <Magnum/SceneGraph/AbstractObject.h>
 #include <Magnum/SceneGraph/SceneGraph.h>
 #include <Magnum/SceneGraph/FeatureGroup.h>
+#include <Magnum/Math/Functions.h>
 
 #include "Magnum/Audio/Audio.h"
+#include "Magnum/Audio/Buffer.h"
 #include "Magnum/Audio/Playable.h"
+#include "Magnum/Audio/Renderer.h"
 #include "Magnum/Audio/Source.h"
 #include "Magnum/Audio/visibility.h"
 
@@ -72,6 +78,35 @@ For two dimensional scenes simply replace `3D` with `2D`. When using a
 @ref Listener, prefer @ref Listener::update() over
 @ref PlayableGroup::setClean().
 
+@section Audio-PlayableGroup-voices Voice limit
+
+OpenAL implementations support only a limited count of sources playing at
+the same time, usually in the range of 32 to 256. When constructing the group
+with @ref PlayableGroup(UnsignedInt), it creates a fixed pool of sources and
+the playables constructed in it don't own any source. Every
+@ref updateVoices() call ranks playing playables by their audibility and gives
+the pooled sources only to the most audible ones, the rest is kept
+@ref Audio-Playable-virtual "virtual", with its playback offset advanced in
+software:
+
+@code{.cpp}
+PlayableGroup3D group{32};
+Playable3D playable{object, &group};
+playable.setBuffer(&buffer)
+    .setLooping(true)
+    .play();
+
+// ... and every frame:
+listener.update({group});
+group.updateVoices(timeDelta);
+@endcode
+
+Audibility is estimated as the playable gain multiplied by group gain and
+attenuated by distance from @ref Renderer::listenerPosition() using the
+default @def_al{INVERSE_DISTANCE_CLAMPED} model with reference distance and
+rolloff factor equal to @cpp 1.0f @ce. Playables that were created outside of
+the group and own a source shouldn't be added to a group with a voice limit.
+
 -   @ref PlayableGroup2D
 -   @ref PlayableGroup3D
 
@@ -88,12 +123,65 @@ template<UnsignedInt dimensions> class PlayableGroup: public SceneGraph::Feature
             _gain{1.0f}
         {}
 
+        /**
+         * @brief Construct with a voice limit
+         * @param voiceCount    Count of sources in the voice pool
+         *
+         * Creates @p voiceCount sources up front and assigns them to most
+         * audible playables in @ref updateVoices(). Passing @cpp 0 @ce is
+         * equivalent to @ref PlayableGroup().
+         * @see @ref Audio-PlayableGroup-voices
+         */
+        explicit PlayableGroup(UnsignedInt voiceCount): PlayableGroup{} {
+            _voiceCount = voiceCount;
+            _voices.reserve(voiceCount);
+            for(UnsignedInt i = 0; i != voiceCount; ++i)
+                _voices.emplace_back();
+        }
+
+        /**
+         * @brief Voice limit
+         *
+         * If @cpp 0 @ce, each playable owns its source and all of them are
+         * playing.
+         */
+        UnsignedInt voiceCount() const { return _voiceCount; }
+
+        /**
+         * @brief Count of free voices in the pool
+         *
+         * @see @ref voiceCount()
+         */
+        std::size_t freeVoiceCount() const { return _voices.size(); }
+
+        /**
+         * @brief Update voice assignment
+         * @param timeDelta     Time elapsed since the last call, in seconds
+         *
+         * Advances playback offset of virtual playables, takes sources away
+         * from playables that are no longer among @ref voiceCount() most
+         * audible ones and assigns them to the ones that became audible,
+         * restoring their buffer, looping, gain, position, direction and
+         * offset. Call after @ref setClean() or @ref Listener::update() so
+         * the playables have up-to-date positions. Does nothing if the group
+         * has no voice limit.
+         * @see @ref Audio-PlayableGroup-voices
+         */
+        void updateVoices(Float timeDelta);
+
         /**
          * @brief Play all sound sources in this group
          * @return Reference to self (for method chaining)
-         * @see @ref Source::play()
+         *
+         * Virtual playables get a source assigned in the next
+         * @ref updateVoices() call, if they are audible enough.
+         * @see @ref Source::play(), @ref Playable::play()
          */
         PlayableGroup<dimensions>& play() {
+            for(UnsignedInt i = 0; i < this->size(); ++i) {
+                (*this)[i]._playing = true;
+                (*this)[i]._offset = 0.0f;
+            }
             Source::play(sources());
             return *this;
         }
@@ -114,6 +202,10 @@ template<UnsignedInt dimensions> class PlayableGroup: public SceneGraph::Feature
          * @see @ref Source::stop()
          */
         PlayableGroup& stop() {
+            for(UnsignedInt i = 0; i < this->size(); ++i) {
+                (*this)[i]._playing = false;
+                (*this)[i]._offset = 0.0f;
+            }
             Source::stop(sources());
             return *this;
         }
@@ -154,23 +246,53 @@ template<UnsignedInt dimensions> class PlayableGroup: public SceneGraph::Feature
 
         /**
          * @brief Set all contained Playables clean
+         *
+         * Cleans objects of all playables that are dirty and then calls
+         * @ref updateSources().
          * @see @ref AbstractObject::setClean()
          */
         void setClean();
 
+        /**
+         * @brief Update sources of changed playables
+         *
+         * Issues OpenAL calls only for playables whose position or direction
+         * changed since the last call, and only for the properties that
+         * changed. Called from @ref setClean() and @ref Listener::update(),
+         * you need to call it explicitly only when cleaning the objects in
+         * some other way. Changing source position or direction directly
+         * through @ref Playable::source() is not tracked.
+         */
+        void updateSources() {
+            for(UnsignedInt i = 0; i < this->size(); ++i)
+                if((*this)[i]._dirty) (*this)[i].updateSource();
+        }
+
     private:
 
-        /* @brief Sources of all Playables in this group */
+        /* @brief Sources of all non-virtual Playables in this group */
         std::vector<std::reference_wrapper<Source>> sources() {
             std::vector<std::reference_wrapper<Source>> srcs;
             srcs.reserve(this->size());
             for(UnsignedInt i = 0; i < this->size(); ++i)
-                srcs.push_back((*this)[i].source());
+                if(!(*this)[i].isVirtual()) srcs.push_back((*this)[i].source());
             return srcs;
         }
 
+        /* Stops the source of given playable and puts it back to the pool */
+        void releaseVoice(Playable<dimensions>& playable) {
+            playable._source.stop();
+            playable._source.setBuffer(nullptr);
+            _voices.push_back(std::move(playable._source));
+        }
+
         Matrix4 _soundTransform;
         Float _gain;
+        UnsignedInt _voiceCount{};
+        std::vector<Source> _voices;
+
+        /* Scratch storage reused in setClean() */
+        std::vector<std::reference_wrapper<SceneGraph::AbstractObject<dimensions, Float>>> _dirtyObjects;
 };
 
 template<UnsignedInt dimensions> inline PlayableGroup<dimensions>& PlayableGroup<dimensions>::setSoundTransformation(const Matrix4& matrix) {
@@ -185,14 +307,90 @@ template<UnsignedInt dimensions> inline PlayableGroup<dimensions>& PlayableGroup
     return *this;
 }
 
-template<UnsignedInt dimensions> inline void PlayableGroup<dimensions>::setClean() {
-    std::vector<std::reference_wrapper<SceneGraph::AbstractObject<dimensions, Float>>> objects;
-    objects.reserve(this->size());
+template<UnsignedInt dimensions> void PlayableGroup<dimensions>::updateVoices(const Float timeDelta) {
+    if(!_voiceCount) return;
+
+    const Vector3 listenerPosition = Renderer::listenerPosition();
+
+    /* Advance offsets of virtual voices, detect real voices that finished and
+       collect audibility of all playing ones */
+    std::vector<std::pair<Float, UnsignedInt>> playing;
+    playing.reserve(this->size());
+    for(UnsignedInt i = 0; i < this->size(); ++i) {
+        Playable<dimensions>& playable = (*this)[i];
+
+        if(playable.isVirtual()) {
+            if(!playable._playing) continue;
+
+            const Float duration = playable._buffer ? playable._buffer->duration() : 0.0f;
+            playable._offset += timeDelta;
+            if(playable._offset >= duration) {
+                if(playable._looping && duration > 0.0f)
+                    playable._offset = std::fmod(playable._offset, duration);
+                else {
+                    playable._playing = false;
+                    playable._offset = 0.0f;
+                    continue;
+                }
+            }
+        } else if(playable._source.state() != Source::State::Playing) {
+            playable._playing = false;
+            continue;
+        }
+
+        /* Inverse distance clamped model with reference distance and rolloff
+           factor equal to 1 */
+        const Float distance = (playable._position - listenerPosition).length();
+        playing.emplace_back(playable.effectiveGain()/Math::max(distance, 1.0f), i);
+    }
+
+    /* Partition the most audible ones to the front */
+    const std::size_t audibleCount = Math::min(std::size_t(_voiceCount), playing.size());
+    if(audibleCount < playing.size())
+        std::nth_element(playing.begin(), playing.begin() + audibleCount, playing.end(),
+            [](const std::pair<Float, UnsignedInt>& a, const std::pair<Float, UnsignedInt>& b) {
+                return a.first > b.first;
+            });
+    std::vector<bool> audible(this->size());
+    for(std::size_t i = 0; i != audibleCount; ++i)
+        audible[playing[i].second] = true;
+
+    /* Take voices away first so there are enough of them in the pool */
+    for(UnsignedInt i = 0; i < this->size(); ++i) {
+        Playable<dimensions>& playable = (*this)[i];
+        if(audible[i] || playable.isVirtual()) continue;
+
+        playable._offset = playable._playing ? playable._source.offsetInSeconds() : 0.0f;
+        releaseVoice(playable);
+    }
+
+    for(std::size_t i = 0; i != audibleCount; ++i) {
+        Playable<dimensions>& playable = (*this)[playing[i].second];
+        if(!playable.isVirtual()) continue;
+
+        playable._source = std::move(_voices.back());
+        _voices.pop_back();
+        playable._source.setBuffer(playable._buffer)
+            .setLooping(playable._looping)
+            .setGain(playable.effectiveGain())
+            .setPosition(playable._position)
+            .setDirection(playable._direction)
+            .setOffsetInSeconds(playable._offset)
+            .play();
+    }
+}
 
+template<UnsignedInt dimensions> inline void PlayableGroup<dimensions>::setClean() {
+    /* Clean objects are skipped by setClean() anyway, don't even put them in
+       the list */
+    _dirtyObjects.clear();
     for(UnsignedInt i = 0; i < this->size(); ++i)
-        objects.push_back((*this)[i].object());
+        if((*this)[i].object().isDirty()) _dirtyObjects.push_back((*this)[i].object());
+
+    if(!_dirtyObjects.empty())
+        SceneGraph::AbstractObject<dimensions, Float>::setClean(_dirtyObjects);
 
-    SceneGraph::AbstractObject<dimensions, Float>::setClean(objects);
+    updateSources();
 }
 
 /**
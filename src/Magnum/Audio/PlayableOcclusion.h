@@ -0,0 +1,221 @@
+#ifndef Magnum_Audio_PlayableOcclusion_h
+#define Magnum_Audio_PlayableOcclusion_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Audio::PlayableOcclusion, typedef @ref Magnum::Audio::PlayableOcclusion2D, @ref Magnum::Audio::PlayableOcclusion3D
+ */
+
+#include <cmath>
+#include <vector>
+
+#include <Magnum/ThreadPool.h>
+#include <Magnum/Math/Constants.h>
+#include <Magnum/Shapes/ShapeGroup.h>
+
+#include "Magnum/Audio/Audio.h"
+#include "Magnum/Audio/Playable.h"
+#include "Magnum/Audio/PlayableGroup.h"
+
+namespace Magnum { namespace Audio {
+
+/**
+@brief Playable occlusion
+
+Attenuates playables that are occluded from the listener by shapes in a
+@ref Shapes::ShapeGroup.
+
+@section Audio-PlayableOcclusion-usage Usage
+
+Every @ref update() call accumulates the elapsed time and once the configured
+@ref updateInterval() passes, a line segment from the listener to each
+playing playable in the group is tested against the occluders in a single
+batch using @ref Shapes::ShapeGroup::occluderCounts(). The
+@ref Playable::occlusionGain() is then set to @ref transmission() raised to
+the count of occluders crossed by the segment and multiplied into the source
+gain:
+
+@code{.cpp}
+Shapes::ShapeGroup3D walls;
+PlayableGroup3D group;
+PlayableOcclusion3D occlusion{walls};
+occlusion.setUpdateInterval(0.2f)
+    .setTransmission(0.3f);
+
+// ... and every frame:
+listener.update({group});
+occlusion.update(group, listenerObject.absoluteTransformationMatrix().translation(), timeDelta);
+@endcode
+
+The occlusion changes slowly compared to position updates, so the pass runs
+at a lower rate than the frame rate, 10 times per second by default. With the
+@ref update(PlayableGroup<dimensions>&, const VectorTypeFor<dimensions, Float>&, Float, ThreadPool&)
+overload the segment tests are distributed over threads of a
+@ref ThreadPool. The occluders are cleaned on the calling thread before that.
+
+When used together with a @ref Audio-PlayableGroup-voices "voice limit",
+call it before @ref PlayableGroup::updateVoices() so occluded playables are
+less likely to take a voice from unoccluded ones. The occlusion is computed
+from positions of the playable and listener objects, in the space of the
+occluder shapes, independently of @ref PlayableGroup::soundTransformation().
+
+-   @ref PlayableOcclusion2D
+-   @ref PlayableOcclusion3D
+
+@see @ref Playable, @ref PlayableGroup
+*/
+template<UnsignedInt dimensions> class PlayableOcclusion {
+    public:
+        /**
+         * @brief Constructor
+         * @param occluders     Shapes occluding the playables
+         */
+        explicit PlayableOcclusion(Shapes::ShapeGroup<dimensions>& occluders): _occluders(occluders) {}
+
+        /** @brief Occluders */
+        Shapes::ShapeGroup<dimensions>& occluders() { return _occluders; }
+
+        /** @brief Update interval */
+        Float updateInterval() const { return _updateInterval; }
+
+        /**
+         * @brief Set update interval
+         * @return Reference to self (for method chaining)
+         *
+         * Time in seconds between occlusion passes. Default is
+         * @cpp 0.1f @ce. Setting it to @cpp 0.0f @ce makes every
+         * @ref update() call run the pass.
+         */
+        PlayableOcclusion<dimensions>& setUpdateInterval(Float seconds) {
+            _updateInterval = seconds;
+            return *this;
+        }
+
+        /** @brief Transmission */
+        Float transmission() const { return _transmission; }
+
+        /**
+         * @brief Set transmission
+         * @return Reference to self (for method chaining)
+         *
+         * Fraction of the gain passing through a single occluder, expected to
+         * be in range @f$ [0, 1] @f$. Default is @cpp 0.5f @ce.
+         */
+        PlayableOcclusion<dimensions>& setTransmission(Float transmission) {
+            _transmission = transmission;
+            return *this;
+        }
+
+        /**
+         * @brief Update occlusion of playables
+         * @param playables         Playables to update
+         * @param listenerPosition  Listener position in the space of
+         *      occluders
+         * @param timeDelta         Time elapsed since the last call, in
+         *      seconds
+         * @return @cpp true @ce if the occlusion pass was done,
+         *      @cpp false @ce if the @ref updateInterval() didn't pass yet
+         *
+         * The first call always does the pass. Playables that are not
+         * playing are skipped and keep their previous
+         * @ref Playable::occlusionGain().
+         */
+        bool update(PlayableGroup<dimensions>& playables, const VectorTypeFor<dimensions, Float>& listenerPosition, Float timeDelta) {
+            return updateInternal(playables, listenerPosition, timeDelta, nullptr);
+        }
+
+        /**
+         * @brief Update occlusion of playables in parallel
+         *
+         * Same as @ref update(PlayableGroup<dimensions>&, const VectorTypeFor<dimensions, Float>&, Float),
+         * but the segment tests are distributed over threads of @p pool
+         * using @ref Shapes::ShapeGroup::occluderCounts(const VectorTypeFor<dimensions, Float>&, const std::vector<VectorTypeFor<dimensions, Float>>&, ThreadPool&).
+         */
+        bool update(PlayableGroup<dimensions>& playables, const VectorTypeFor<dimensions, Float>& listenerPosition, Float timeDelta, ThreadPool& pool) {
+            return updateInternal(playables, listenerPosition, timeDelta, &pool);
+        }
+
+    private:
+        bool updateInternal(PlayableGroup<dimensions>& playables, const VectorTypeFor<dimensions, Float>& listenerPosition, Float timeDelta, ThreadPool* pool);
+
+        Shapes::ShapeGroup<dimensions>& _occluders;
+        Float _updateInterval{0.1f}, _transmission{0.5f};
+        Float _sinceUpdate{Constants::inf()};
+
+        /* Scratch storage reused in every pass */
+        std::vector<UnsignedInt> _playing;
+        std::vector<VectorTypeFor<dimensions, Float>> _positions;
+};
+
+template<UnsignedInt dimensions> bool PlayableOcclusion<dimensions>::updateInternal(PlayableGroup<dimensions>& playables, const VectorTypeFor<dimensions, Float>& listenerPosition, const Float timeDelta, ThreadPool* const pool) {
+    _sinceUpdate += timeDelta;
+    if(_sinceUpdate < _updateInterval) return false;
+    _sinceUpdate = 0.0f;
+
+    /* Gather positions of all playing playables, computing the absolute
+       transformation touches the objects so it's done on this thread */
+    _playing.clear();
+    _positions.clear();
+    for(UnsignedInt i = 0; i < playables.size(); ++i) {
+        if(!playables[i].isPlaying()) continue;
+        _playing.push_back(i);
+        _positions.push_back(playables[i].object().absoluteTransformationMatrix().translation());
+    }
+
+    const std::vector<UnsignedInt> counts = pool ?
+        _occluders.occluderCounts(listenerPosition, _positions, *pool) :
+        _occluders.occluderCounts(listenerPosition, _positions);
+
+    /* Touch the sources only for playables whose occlusion changed */
+    for(std::size_t i = 0; i != _playing.size(); ++i) {
+        Playable<dimensions>& playable = playables[_playing[i]];
+        const Float gain = counts[i] ? std::pow(_transmission, Float(counts[i])) : 1.0f;
+        if(gain == playable._occlusionGain) continue;
+
+        playable._occlusionGain = gain;
+        playable.cleanGain();
+    }
+
+    return true;
+}
+
+/**
+ * @brief Playable occlusion for two dimensional float scenes
+ *
+ * @see @ref PlayableOcclusion3D
+ */
+typedef PlayableOcclusion<2> PlayableOcclusion2D;
+
+/**
+ * @brief Playable occlusion for three dimensional float scenes
+ *
+ * @see @ref PlayableOcclusion2D
+ */
+typedef PlayableOcclusion<3> PlayableOcclusion3D;
+
+}}
+
+#endif
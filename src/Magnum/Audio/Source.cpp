@@ -26,13 +26,12 @@
 #include "Source.h"
 
 #include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/Assert.h>
 
 #include "Magnum/Audio/Buffer.h"
 
 namespace Magnum { namespace Audio {
 
-/** @todo C++14: use VLA to avoid unnecessary allocations */
-
 Source& Source::setBuffer(Buffer* buffer) {
     alSourcei(_id, AL_BUFFER, buffer ? buffer->id() : 0);
     return *this;
@@ -40,60 +39,90 @@ Source& Source::setBuffer(Buffer* buffer) {
 
 namespace {
 
-Containers::Array<ALuint> sourceIds(const std::initializer_list<std::reference_wrapper<Source>>& sources) {
-    Containers::Array<ALuint> ids(sources.size());
-    for(auto it = sources.begin(); it != sources.end(); ++it)
-        ids[it-sources.begin()] = it->get().id();
+Containers::Array<ALuint> bufferIds(const std::initializer_list<std::reference_wrapper<Buffer>>& buffers) {
+    Containers::Array<ALuint> ids(buffers.size());
+    for(auto it = buffers.begin(); it != buffers.end(); ++it)
+        ids[it-buffers.begin()] = it->get().id();
     return ids;
 }
 
-Containers::Array<ALuint> sourceIds(const std::vector<std::reference_wrapper<Source>>& sources) {
-    Containers::Array<ALuint> ids(sources.size());
-    for(auto it = sources.begin(); it != sources.end(); ++it)
-        ids[it-sources.begin()] = it->get().id();
+Containers::Array<ALuint> bufferIds(const std::vector<std::reference_wrapper<Buffer>>& buffers) {
+    Containers::Array<ALuint> ids(buffers.size());
+    for(auto it = buffers.begin(); it != buffers.end(); ++it)
+        ids[it-buffers.begin()] = it->get().id();
     return ids;
 }
 
+/* Calls given function with an array of source IDs. Small batches are put
+   on stack to avoid an allocation on every call. */
+template<class Sources, class Function> void callWithSourceIds(const Sources& sources, Function function) {
+    ALuint stackIds[32];
+    Containers::Array<ALuint> heapIds;
+    ALuint* ids = stackIds;
+    if(sources.size() > Containers::arraySize(stackIds)) {
+        heapIds = Containers::Array<ALuint>{sources.size()};
+        ids = heapIds;
+    }
+
+    std::size_t i = 0;
+    for(const Source& source: sources) ids[i++] = source.id();
+    function(ALsizei(sources.size()), ids);
+}
+
+}
+
+Source& Source::queueBuffers(std::initializer_list<std::reference_wrapper<Buffer>> buffers) {
+    const auto ids = bufferIds(buffers);
+    alSourceQueueBuffers(_id, ids.size(), ids);
+    return *this;
+}
+
+Source& Source::queueBuffers(const std::vector<std::reference_wrapper<Buffer>>& buffers) {
+    const auto ids = bufferIds(buffers);
+    alSourceQueueBuffers(_id, ids.size(), ids);
+    return *this;
+}
+
+Source& Source::unqueueBuffers(const Int count) {
+    CORRADE_ASSERT(count <= processedBufferCount(),
+        "Audio::Source::unqueueBuffers(): can't unqueue" << count << "buffers, only" << processedBufferCount() << "processed", *this);
+
+    /* The IDs are not needed, the buffers are unqueued in FIFO order */
+    Containers::Array<ALuint> ids(count);
+    alSourceUnqueueBuffers(_id, count, ids);
+    return *this;
 }
 
 void Source::play(std::initializer_list<std::reference_wrapper<Source>> sources) {
-    const auto ids = sourceIds(sources);
-    alSourcePlayv(ids.size(), ids);
+    callWithSourceIds(sources, [](ALsizei count, const ALuint* ids) { alSourcePlayv(count, ids); });
 }
 
 void Source::play(const std::vector<std::reference_wrapper<Source>>& sources) {
-    const auto ids = sourceIds(sources);
-    alSourcePlayv(ids.size(), ids);
+    callWithSourceIds(sources, [](ALsizei count, const ALuint* ids) { alSourcePlayv(count, ids); });
 }
 
 void Source::pause(std::initializer_list<std::reference_wrapper<Source>> sources) {
-    const auto ids = sourceIds(sources);
-    alSourcePausev(ids.size(), ids);
+    callWithSourceIds(sources, [](ALsizei count, const ALuint* ids) { alSourcePausev(count, ids); });
 }
 
 void Source::pause(const std::vector<std::reference_wrapper<Source>>& sources) {
-    const auto ids = sourceIds(sources);
-    alSourcePausev(ids.size(), ids);
+    callWithSourceIds(sources, [](ALsizei count, const ALuint* ids) { alSourcePausev(count, ids); });
 }
 
 void Source::stop(std::initializer_list<std::reference_wrapper<Source>> sources) {
-    const auto ids = sourceIds(sources);
-    alSourceStopv(ids.size(), ids);
+    callWithSourceIds(sources, [](ALsizei count, const ALuint* ids) { alSourceStopv(count, ids); });
 }
 
 void Source::stop(const std::vector<std::reference_wrapper<Source>>& sources) {
-    const auto ids = sourceIds(sources);
-    alSourceStopv(ids.size(), ids);
+    callWithSourceIds(sources, [](ALsizei count, const ALuint* ids) { alSourceStopv(count, ids); });
 }
 
 void Source::rewind(std::initializer_list<std::reference_wrapper<Source>> sources) {
-    const auto ids = sourceIds(sources);
-    alSourceRewindv(ids.size(), ids);
+    callWithSourceIds(sources, [](ALsizei count, const ALuint* ids) { alSourceRewindv(count, ids); });
 }
 
 void Source::rewind(const std::vector<std::reference_wrapper<Source>>& sources) {
-    const auto ids = sourceIds(sources);
-    alSourceRewindv(ids.size(), ids);
+    callWithSourceIds(sources, [](ALsizei count, const ALuint* ids) { alSourceRewindv(count, ids); });
 }
 
 Debug& operator<<(Debug& debug, const Source::State value) {
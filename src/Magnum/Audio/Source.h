@@ -36,6 +36,7 @@
 #include <al.h>
 
 #include "Magnum/Magnum.h"
+#include "Magnum/Tags.h"
 #include "Magnum/Audio/Audio.h"
 #include "Magnum/Audio/visibility.h"
 #include "Magnum/Math/Vector3.h"
@@ -45,8 +46,11 @@ namespace Magnum { namespace Audio {
 /**
 @brief Source
 
-Manages positional audio source.
-@todo Expose convenient API for buffer queuing
+Manages positional audio source. A source either plays a single buffer
+attached using @ref setBuffer() or a queue of buffers set up using
+@ref queueBuffers(), which are played one after another. See
+@ref StreamingSource for a class managing the queue and refilling it with
+data from an @ref AbstractImporter.
 */
 class MAGNUM_AUDIO_EXPORT Source {
     public:
@@ -58,6 +62,15 @@ class MAGNUM_AUDIO_EXPORT Source {
          */
         explicit Source() { alGenSources(1, &_id); }
 
+        /**
+         * @brief Construct without creating the underlying OpenAL object
+         *
+         * The constructed instance is equivalent to moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         */
+        explicit Source(NoCreateT) noexcept: _id{} {}
+
         /**
          * @brief Destructor
          *
@@ -490,8 +503,8 @@ class MAGNUM_AUDIO_EXPORT Source {
         /**
          * @brief Source type
          *
-         * @see @ref setBuffer(), @fn_al_keyword{GetSourcei} with
-         *      @def_al{SOURCE_TYPE}
+         * @see @ref setBuffer(), @ref queueBuffers(),
+         *      @fn_al_keyword{GetSourcei} with @def_al{SOURCE_TYPE}
          */
         Type type() const;
 
@@ -507,6 +520,53 @@ class MAGNUM_AUDIO_EXPORT Source {
          */
         Source& setBuffer(Buffer* buffer);
 
+        /**
+         * @brief Queue buffers
+         * @return Reference to self (for method chaining)
+         *
+         * Appends the buffers to the end of the queue, changes source type to
+         * @ref Type::Streaming. The buffers must be already filled with data
+         * and all buffers in the queue must have the same format. The
+         * buffers have to stay alive until they're unqueued again.
+         * @see @ref unqueueBuffers(), @ref queuedBufferCount(),
+         *      @fn_al_keyword{SourceQueueBuffers}
+         */
+        Source& queueBuffers(std::initializer_list<std::reference_wrapper<Buffer>> buffers);
+        Source& queueBuffers(const std::vector<std::reference_wrapper<Buffer>>& buffers); /**< @overload */
+
+        /**
+         * @brief Unqueue processed buffers
+         * @return Reference to self (for method chaining)
+         *
+         * Removes @p count buffers from the front of the queue. The buffers
+         * are unqueued in the order they were queued in, so the caller
+         * knows which buffers are free to be refilled. Expects that
+         * @p count is not larger than @ref processedBufferCount().
+         * @see @ref queueBuffers(), @fn_al_keyword{SourceUnqueueBuffers}
+         */
+        Source& unqueueBuffers(Int count);
+
+        /**
+         * @brief Count of queued buffers
+         *
+         * Includes also buffers that were already processed, but not
+         * unqueued yet.
+         * @see @ref processedBufferCount(), @fn_al_keyword{GetSourcei} with
+         *      @def_al{BUFFERS_QUEUED}
+         */
+        Int queuedBufferCount() const;
+
+        /**
+         * @brief Count of processed buffers
+         *
+         * Count of buffers at the front of the queue that were already
+         * played and can be unqueued. All queued buffers are marked as
+         * processed when the source gets stopped.
+         * @see @ref queuedBufferCount(), @ref unqueueBuffers(),
+         *      @fn_al_keyword{GetSourcei} with @def_al{BUFFERS_PROCESSED}
+         */
+        Int processedBufferCount() const;
+
         /*@}*/
 
         /** @{ @name State management */
@@ -724,6 +784,24 @@ inline auto Source::state() const -> State {
     return State(state);
 }
 
+inline auto Source::type() const -> Type {
+    ALint type;
+    alGetSourcei(_id, AL_SOURCE_TYPE, &type);
+    return Type(type);
+}
+
+inline Int Source::queuedBufferCount() const {
+    ALint count;
+    alGetSourcei(_id, AL_BUFFERS_QUEUED, &count);
+    return count;
+}
+
+inline Int Source::processedBufferCount() const {
+    ALint count;
+    alGetSourcei(_id, AL_BUFFERS_PROCESSED, &count);
+    return count;
+}
+
 inline bool Source::isLooping() const {
     ALint looping;
     alGetSourcei(_id, AL_LOOPING, &looping);
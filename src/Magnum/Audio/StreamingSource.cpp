@@ -0,0 +1,224 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "StreamingSource.h"
+
+#include <condition_variable>
+#include <mutex>
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include <thread>
+#endif
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Audio/AbstractImporter.h"
+
+namespace Magnum { namespace Audio {
+
+struct StreamingSource::State {
+    explicit State(AbstractImporter& importer, std::size_t chunkFrameCount, UnsignedInt bufferCount): importer(importer), chunkFrameCount{chunkFrameCount}, bufferCount{bufferCount} {}
+
+    /* Reads the next chunk, returns false if there's nothing more to read.
+       Called without the mutex locked, the offset is accessed only by the
+       reading side. */
+    bool read();
+
+    AbstractImporter& importer;
+    const std::size_t chunkFrameCount;
+    const UnsignedInt bufferCount;
+    std::size_t offset{};
+
+    std::mutex mutex;
+    std::condition_variable wakeUp, done;
+    std::deque<Containers::Array<char>> ready;
+    bool looping{};
+    bool finished{};
+    bool stop{};
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    std::thread worker;
+    #endif
+};
+
+namespace {
+    typedef std::unique_lock<std::mutex> Lock;
+}
+
+bool StreamingSource::State::read() {
+    Containers::Array<char> chunk = importer.readFrames(offset, chunkFrameCount);
+
+    /* At the end, start from the beginning if looping, unless the file is
+       empty */
+    if(chunk.empty() && offset) {
+        bool loop;
+        {
+            Lock lock{mutex};
+            loop = looping;
+        }
+        if(loop) {
+            offset = 0;
+            chunk = importer.readFrames(offset, chunkFrameCount);
+        }
+    }
+
+    Lock lock{mutex};
+    if(chunk.empty()) {
+        finished = true;
+        return false;
+    }
+
+    offset += chunkFrameCount;
+    ready.push_back(std::move(chunk));
+    return true;
+}
+
+StreamingSource::StreamingSource(AbstractImporter& importer, const std::size_t chunkFrameCount, const UnsignedInt bufferCount): _state{new State{importer, chunkFrameCount, bufferCount}} {
+    CORRADE_ASSERT(importer.isOpened(),
+        "Audio::StreamingSource: the importer has no file opened", );
+    CORRADE_ASSERT(chunkFrameCount && bufferCount,
+        "Audio::StreamingSource: expected non-zero chunk frame count and buffer count", );
+
+    _format = importer.format();
+    _frequency = importer.frequency();
+
+    _buffers.reserve(bufferCount);
+    for(UnsignedInt i = 0; i != bufferCount; ++i) _buffers.emplace_back();
+    for(Buffer& buffer: _buffers) _free.push_back(&buffer);
+
+    /* Keep up to bufferCount chunks read ahead. The queued buffers are not
+       counted, so there's always a full set of chunks ready for refill. */
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    State& state = *_state;
+    state.worker = std::thread{[&state]() {
+        Lock lock{state.mutex};
+        for(;;) {
+            state.wakeUp.wait(lock, [&state]() {
+                return state.stop || (!state.finished && state.ready.size() < state.bufferCount);
+            });
+            if(state.stop) return;
+
+            lock.unlock();
+            state.read();
+            lock.lock();
+            state.done.notify_all();
+        }
+    }};
+    #endif
+}
+
+StreamingSource::~StreamingSource() {
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    {
+        std::lock_guard<std::mutex> lock{_state->mutex};
+        _state->stop = true;
+    }
+    _state->wakeUp.notify_all();
+    _state->worker.join();
+    #endif
+
+    /* Stopping marks all queued buffers as processed */
+    _source.stop();
+    _source.unqueueBuffers(_source.processedBufferCount());
+}
+
+bool StreamingSource::isLooping() const {
+    std::lock_guard<std::mutex> lock{_state->mutex};
+    return _state->looping;
+}
+
+StreamingSource& StreamingSource::setLooping(const bool looping) {
+    {
+        std::lock_guard<std::mutex> lock{_state->mutex};
+        _state->looping = looping;
+    }
+    return *this;
+}
+
+bool StreamingSource::isFinished() const {
+    std::lock_guard<std::mutex> lock{_state->mutex};
+    return _state->finished && _state->ready.empty() && _queued.empty();
+}
+
+void StreamingSource::play() {
+    /* Wait until there's enough data to fill the free buffers or until
+       everything is read */
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    {
+        Lock lock{_state->mutex};
+        _state->done.wait(lock, [this]() {
+            return _state->finished || _state->ready.size() >= _free.size();
+        });
+    }
+    #endif
+
+    _playing = true;
+    update();
+    if(_source.state() != Source::State::Playing) _source.play();
+}
+
+void StreamingSource::pause() {
+    _playing = false;
+    _source.pause();
+}
+
+void StreamingSource::update() {
+    /* Move the processed buffers to the free list */
+    const Int processed = _source.processedBufferCount();
+    _source.unqueueBuffers(processed);
+    for(Int i = 0; i != processed; ++i) {
+        _free.push_back(_queued.front());
+        _queued.pop_front();
+    }
+
+    #ifdef CORRADE_TARGET_EMSCRIPTEN
+    /* No worker thread, read the chunks here */
+    while(_state->ready.size() < _free.size() && _state->read()) {}
+    #endif
+
+    queueReady();
+
+    /* If the source ran out of data while playing, restart it */
+    if(_playing && !_queued.empty() && _source.state() != Source::State::Playing)
+        _source.play();
+}
+
+void StreamingSource::queueReady() {
+    std::vector<std::reference_wrapper<Buffer>> buffers;
+    {
+        std::lock_guard<std::mutex> lock{_state->mutex};
+        while(!_free.empty() && !_state->ready.empty()) {
+            Buffer& buffer = *_free.back();
+            _free.pop_back();
+            buffer.setData(_format, Containers::ArrayView<const char>{_state->ready.front()}, _frequency);
+            _state->ready.pop_front();
+            _queued.push_back(&buffer);
+            buffers.push_back(buffer);
+        }
+    }
+    _state->wakeUp.notify_one();
+
+    if(!buffers.empty()) _source.queueBuffers(buffers);
+}
+
+}}
@@ -0,0 +1,188 @@
+#ifndef Magnum_Audio_StreamingSource_h
+#define Magnum_Audio_StreamingSource_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Audio::StreamingSource
+ */
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "Magnum/Audio/Buffer.h"
+#include "Magnum/Audio/Source.h"
+
+namespace Magnum { namespace Audio {
+
+/**
+@brief Streaming source
+
+Plays sample data from an @ref AbstractImporter through a small ring of
+@ref Buffer instances queued on a @ref Source, instead of uploading the whole
+file into a single buffer. The data are read with
+@ref AbstractImporter::readFrames() on a worker thread, so with an importer
+supporting @ref AbstractImporter::Feature::OpenMemory only a few chunks of
+the file are in memory at any time:
+
+@code{.cpp}
+std::unique_ptr<Audio::AbstractImporter> importer = manager.instantiate("WavAudioImporter");
+importer->openFile("music.wav");
+
+Audio::StreamingSource music{*importer};
+music.setLooping(true)
+    .play();
+
+// in the main loop
+music.update();
+@endcode
+
+With the default parameters, a 16-bit stereo track occupies four buffers of
+64 kB in OpenAL memory, regardless of its length. The @ref update() function
+has to be called periodically, at least once per duration of one chunk, to
+refill the processed buffers --- otherwise the source runs out of data and
+stops. It gets restarted on the next @ref update() call, which is audible as a
+gap.
+
+@section Audio-StreamingSource-threading Threading
+
+All functions have to be called from the same thread, only the reading is
+done on the worker thread. The importer is accessed from the worker thread
+for the whole lifetime of this instance and thus it must not be used directly
+until the instance is destroyed. OpenAL is called only from the thread
+calling @ref update(). On platforms without thread support (such as
+@ref CORRADE_TARGET_EMSCRIPTEN "Emscripten") the chunks are read in
+@ref update() on the calling thread.
+*/
+class MAGNUM_AUDIO_EXPORT StreamingSource {
+    public:
+        /**
+         * @brief Constructor
+         * @param importer          Importer to read the data from
+         * @param chunkFrameCount   Count of frames in one buffer
+         * @param bufferCount       Count of buffers in the queue
+         *
+         * Expects that the importer has a file opened and that both
+         * @p chunkFrameCount and @p bufferCount are non-zero. Spawns the
+         * worker thread, which immediately starts reading the first chunks.
+         * The importer is expected to stay alive for the whole lifetime of
+         * this instance.
+         */
+        explicit StreamingSource(AbstractImporter& importer, std::size_t chunkFrameCount = 16384, UnsignedInt bufferCount = 4);
+
+        /** @brief Copying is not allowed */
+        StreamingSource(const StreamingSource&) = delete;
+
+        /** @brief Moving is not allowed */
+        StreamingSource(StreamingSource&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Stops the source and the worker thread.
+         */
+        ~StreamingSource();
+
+        /** @brief Copying is not allowed */
+        StreamingSource& operator=(const StreamingSource&) = delete;
+
+        /** @brief Moving is not allowed */
+        StreamingSource& operator=(StreamingSource&&) = delete;
+
+        /**
+         * @brief Underlying source
+         *
+         * Use it to set up position, gain and other properties. Don't attach
+         * or queue any buffers on it directly.
+         */
+        Source& source() { return _source; }
+
+        /** @brief Whether the playback loops */
+        bool isLooping() const;
+
+        /**
+         * @brief Set looping
+         * @return Reference to self (for method chaining)
+         *
+         * If enabled, the reading continues from the beginning after
+         * reaching the end of the file. Default is @cpp false @ce. Unlike
+         * @ref Source::setLooping(), this loops the whole file, not just the
+         * queued buffers.
+         */
+        StreamingSource& setLooping(bool looping);
+
+        /**
+         * @brief Whether the playback is finished
+         *
+         * Returns @cpp true @ce if all data were read and played and the
+         * looping is disabled.
+         */
+        bool isFinished() const;
+
+        /**
+         * @brief Play
+         *
+         * Waits until the first buffers are filled, queues them and starts
+         * the playback. Calling it on a paused source resumes the playback.
+         * @see @ref pause(), @ref update()
+         */
+        void play();
+
+        /**
+         * @brief Pause
+         *
+         * The source isn't restarted by @ref update() until @ref play() is
+         * called again.
+         */
+        void pause();
+
+        /**
+         * @brief Refill the queue
+         *
+         * Unqueues the processed buffers, refills them with the chunks read
+         * since the last call and queues them again. If the source ran out of
+         * data while playing, restarts it. Doesn't block.
+         */
+        void update();
+
+    private:
+        struct State;
+
+        MAGNUM_AUDIO_LOCAL void queueReady();
+
+        std::unique_ptr<State> _state;
+        Buffer::Format _format;
+        UnsignedInt _frequency;
+        std::vector<Buffer> _buffers;
+        std::vector<Buffer*> _free;
+        std::deque<Buffer*> _queued;
+        Source _source;
+        bool _playing{};
+};
+
+}}
+
+#endif
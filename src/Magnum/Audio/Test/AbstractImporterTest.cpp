@@ -23,8 +23,10 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <sstream>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
 #include <Corrade/Utility/Directory.h>
 
 #include "Magnum/Audio/AbstractImporter.h"
@@ -37,10 +39,18 @@ struct AbstractImporterTest: TestSuite::Tester {
     explicit AbstractImporterTest();
 
     void openFile();
+    void openMemory();
+
+    void readFrames();
+    void readFramesOutOfRange();
 };
 
 AbstractImporterTest::AbstractImporterTest() {
-    addTests({&AbstractImporterTest::openFile});
+    addTests({&AbstractImporterTest::openFile,
+              &AbstractImporterTest::openMemory,
+
+              &AbstractImporterTest::readFrames,
+              &AbstractImporterTest::readFramesOutOfRange});
 }
 
 void AbstractImporterTest::openFile() {
@@ -71,6 +81,81 @@ void AbstractImporterTest::openFile() {
     CORRADE_VERIFY(importer.isOpened());
 }
 
+void AbstractImporterTest::openMemory() {
+    class MemoryImporter: public Audio::AbstractImporter {
+        private:
+            Features doFeatures() const override { return Feature::OpenMemory; }
+            bool doIsOpened() const override { return opened; }
+            void doClose() override { opened = false; }
+
+            void doOpenData(Containers::ArrayView<const char> data) override {
+                opened = (data.size() == 1 && data[0] == '\xa5');
+            }
+
+            Buffer::Format doFormat() const override { return {}; }
+            UnsignedInt doFrequency() const override { return {}; }
+            Corrade::Containers::Array<char> doData() override { return nullptr; }
+
+            bool opened = false;
+    };
+
+    /* doOpenMemory() should call doOpenData() */
+    const char data[]{'\xa5'};
+    MemoryImporter importer;
+    CORRADE_VERIFY(importer.openMemory(data));
+    CORRADE_VERIFY(importer.isOpened());
+
+    /* doOpenFile() should map the file and call doOpenMemory() */
+    importer.close();
+    CORRADE_VERIFY(!importer.isOpened());
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(AUDIO_TEST_DIR, "file.bin")));
+    CORRADE_VERIFY(importer.isOpened());
+}
+
+namespace {
+
+class StereoImporter: public Audio::AbstractImporter {
+    private:
+        Features doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        Buffer::Format doFormat() const override { return Buffer::Format::Stereo16; }
+        UnsignedInt doFrequency() const override { return 44100; }
+        Corrade::Containers::Array<char> doData() override {
+            Containers::Array<char> out{12};
+            for(std::size_t i = 0; i != out.size(); ++i) out[i] = i;
+            return out;
+        }
+};
+
+}
+
+void AbstractImporterTest::readFrames() {
+    /* The default implementations should go through doData() */
+    StereoImporter importer;
+    CORRADE_COMPARE(importer.frameSize(), 4);
+    CORRADE_COMPARE(importer.frameCount(), 3);
+    CORRADE_COMPARE_AS(importer.readFrames(1, 1),
+        (Containers::Array<char>{Containers::InPlaceInit, {4, 5, 6, 7}}),
+        TestSuite::Compare::Container<Containers::ArrayView<const char>>);
+
+    /* The count is clamped */
+    CORRADE_COMPARE_AS(importer.readFrames(2, 5),
+        (Containers::Array<char>{Containers::InPlaceInit, {8, 9, 10, 11}}),
+        TestSuite::Compare::Container<Containers::ArrayView<const char>>);
+    CORRADE_COMPARE(importer.readFrames(3, 5).size(), 0);
+}
+
+void AbstractImporterTest::readFramesOutOfRange() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    StereoImporter importer;
+    importer.readFrames(4, 1);
+    CORRADE_COMPARE(out.str(), "Audio::AbstractImporter::readFrames(): offset 4 out of range for 3 frames\n");
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Audio::Test::AbstractImporterTest)
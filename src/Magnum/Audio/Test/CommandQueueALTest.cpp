@@ -0,0 +1,139 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Audio/Buffer.h"
+#include "Magnum/Audio/CommandQueue.h"
+#include "Magnum/Audio/Context.h"
+#include "Magnum/Audio/Source.h"
+
+namespace Magnum { namespace Audio { namespace Test {
+
+struct CommandQueueALTest: TestSuite::Tester {
+    explicit CommandQueueALTest();
+
+    void playStop();
+    void fade();
+    void fadeZeroDuration();
+    void fadeReplace();
+    void crossfade();
+
+    Context _context;
+    Buffer _buffer;
+};
+
+CommandQueueALTest::CommandQueueALTest() {
+    addTests({&CommandQueueALTest::playStop,
+              &CommandQueueALTest::fade,
+              &CommandQueueALTest::fadeZeroDuration,
+              &CommandQueueALTest::fadeReplace,
+              &CommandQueueALTest::crossfade});
+
+    /* A second of silence, sources are looping it so they don't stop on
+       their own */
+    char data[22050]{};
+    _buffer.setData(Buffer::Format::Mono8, data, 22050);
+}
+
+void CommandQueueALTest::playStop() {
+    Source a, b;
+    a.setBuffer(&_buffer).setLooping(true);
+    b.setBuffer(&_buffer).setLooping(true);
+
+    CommandQueue queue;
+    CORRADE_VERIFY(queue.isFinished());
+
+    queue.play({a, b});
+    queue.finish();
+    CORRADE_VERIFY(queue.isFinished());
+    CORRADE_COMPARE(a.state(), Source::State::Playing);
+    CORRADE_COMPARE(b.state(), Source::State::Playing);
+
+    queue.pause({a})
+        .stop({b});
+    queue.finish();
+    CORRADE_COMPARE(a.state(), Source::State::Paused);
+    CORRADE_COMPARE(b.state(), Source::State::Stopped);
+
+    queue.rewind({a, b});
+    queue.finish();
+    CORRADE_COMPARE(a.state(), Source::State::Initial);
+    CORRADE_COMPARE(b.state(), Source::State::Initial);
+}
+
+void CommandQueueALTest::fade() {
+    Source a;
+    a.setBuffer(&_buffer).setLooping(true);
+
+    CommandQueue queue;
+    queue.play({a})
+        .fade({a}, 0.25f, 0.05f, CommandQueue::Curve::SmoothStep);
+    CORRADE_VERIFY(!queue.isFinished());
+    queue.finish();
+    CORRADE_COMPARE(a.gain(), 0.25f);
+    CORRADE_COMPARE(a.state(), Source::State::Playing);
+}
+
+void CommandQueueALTest::fadeZeroDuration() {
+    Source a;
+
+    CommandQueue queue;
+    queue.fade({a}, 0.5f, 0.0f);
+    queue.finish();
+    CORRADE_COMPARE(a.gain(), 0.5f);
+}
+
+void CommandQueueALTest::fadeReplace() {
+    Source a;
+
+    /* The second fade replaces the first one, which would otherwise take
+       a whole minute */
+    CommandQueue queue;
+    queue.fade({a}, 0.0f, 60.0f)
+        .fade({a}, 0.75f, 0.02f, CommandQueue::Curve::EaseOut);
+    queue.finish();
+    CORRADE_COMPARE(a.gain(), 0.75f);
+}
+
+void CommandQueueALTest::crossfade() {
+    Source a, b;
+    a.setBuffer(&_buffer).setLooping(true);
+    b.setBuffer(&_buffer).setLooping(true);
+
+    CommandQueue queue;
+    queue.play({a})
+        .crossfade(a, b, 0.5f, 0.05f, CommandQueue::Curve::EaseIn);
+    queue.finish();
+
+    CORRADE_COMPARE(a.gain(), 0.0f);
+    CORRADE_COMPARE(a.state(), Source::State::Stopped);
+    CORRADE_COMPARE(b.gain(), 0.5f);
+    CORRADE_COMPARE(b.state(), Source::State::Playing);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Audio::Test::CommandQueueALTest)
@@ -36,13 +36,15 @@ struct ContextALTest: TestSuite::Tester {
 
     void extensionsString();
     void isExtensionEnabled();
+    void frequency();
 
     Context _context;
 };
 
 ContextALTest::ContextALTest() {
     addTests({&ContextALTest::extensionsString,
-              &ContextALTest::isExtensionEnabled});
+              &ContextALTest::isExtensionEnabled,
+              &ContextALTest::frequency});
 }
 
 void ContextALTest::extensionsString() {
@@ -55,6 +57,10 @@ void ContextALTest::isExtensionEnabled() {
     CORRADE_VERIFY(Context::current().isExtensionSupported<Extensions::ALC::EXT::ENUMERATION>());
 }
 
+void ContextALTest::frequency() {
+    CORRADE_VERIFY(_context.frequency() > 0);
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Audio::Test::ContextALTest)
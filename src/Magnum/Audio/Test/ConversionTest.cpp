@@ -0,0 +1,197 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+
+#include "Magnum/Audio/Conversion.h"
+
+namespace Magnum { namespace Audio { namespace Test {
+
+struct ConversionTest: TestSuite::Tester {
+    explicit ConversionTest();
+
+    void format8To16();
+    void format16To8();
+    void formatFloatTo16();
+    void formatStereoToMono();
+    void formatMonoToStereo();
+    void formatUnsupported();
+    void formatInvalidSize();
+
+    void resampleUp();
+    void resampleDown();
+    void resampleStereo();
+    void resampleZeroFrequency();
+
+    void convert();
+    void convertPassthrough();
+};
+
+ConversionTest::ConversionTest() {
+    addTests({&ConversionTest::format8To16,
+              &ConversionTest::format16To8,
+              &ConversionTest::formatFloatTo16,
+              &ConversionTest::formatStereoToMono,
+              &ConversionTest::formatMonoToStereo,
+              &ConversionTest::formatUnsupported,
+              &ConversionTest::formatInvalidSize,
+
+              &ConversionTest::resampleUp,
+              &ConversionTest::resampleDown,
+              &ConversionTest::resampleStereo,
+              &ConversionTest::resampleZeroFrequency,
+
+              &ConversionTest::convert,
+              &ConversionTest::convertPassthrough});
+}
+
+void ConversionTest::format8To16() {
+    const UnsignedByte data[]{0, 64, 128, 255};
+    const Containers::Array<char> out = convertFormat(Buffer::Format::Mono8,
+        Containers::arrayCast<const char>(Containers::arrayView(data)), Buffer::Format::Mono16);
+    CORRADE_COMPARE_AS(Containers::arrayCast<const Short>(out),
+        (Containers::Array<Short>{Containers::InPlaceInit, {-32768, -16384, 0, 32512}}),
+        TestSuite::Compare::Container<Containers::ArrayView<const Short>>);
+}
+
+void ConversionTest::format16To8() {
+    const Short data[]{-32768, -16384, 0, 32512, 32767};
+    const Containers::Array<char> out = convertFormat(Buffer::Format::Mono16,
+        Containers::arrayCast<const char>(Containers::arrayView(data)), Buffer::Format::Mono8);
+    CORRADE_COMPARE_AS(Containers::arrayCast<const UnsignedByte>(out),
+        (Containers::Array<UnsignedByte>{Containers::InPlaceInit, {0, 64, 128, 255, 255}}),
+        TestSuite::Compare::Container<Containers::ArrayView<const UnsignedByte>>);
+}
+
+void ConversionTest::formatFloatTo16() {
+    /* Out-of-range values are clamped */
+    const Float data[]{0.5f, -0.25f, 2.0f, -2.0f};
+    const Containers::Array<char> out = convertFormat(Buffer::Format::MonoFloat,
+        Containers::arrayCast<const char>(Containers::arrayView(data)), Buffer::Format::Mono16);
+    CORRADE_COMPARE_AS(Containers::arrayCast<const Short>(out),
+        (Containers::Array<Short>{Containers::InPlaceInit, {16384, -8192, 32767, -32768}}),
+        TestSuite::Compare::Container<Containers::ArrayView<const Short>>);
+}
+
+void ConversionTest::formatStereoToMono() {
+    const Short data[]{100, 300, -200, 0, 32767, 32767};
+    const Containers::Array<char> out = convertFormat(Buffer::Format::Stereo16,
+        Containers::arrayCast<const char>(Containers::arrayView(data)), Buffer::Format::Mono16);
+    CORRADE_COMPARE_AS(Containers::arrayCast<const Short>(out),
+        (Containers::Array<Short>{Containers::InPlaceInit, {200, -100, 32767}}),
+        TestSuite::Compare::Container<Containers::ArrayView<const Short>>);
+}
+
+void ConversionTest::formatMonoToStereo() {
+    const Short data[]{100, -200};
+    const Containers::Array<char> out = convertFormat(Buffer::Format::Mono16,
+        Containers::arrayCast<const char>(Containers::arrayView(data)), Buffer::Format::StereoFloat);
+    CORRADE_COMPARE_AS(Containers::arrayCast<const Float>(out),
+        (Containers::Array<Float>{Containers::InPlaceInit, {100.0f/32768.0f, 100.0f/32768.0f, -200.0f/32768.0f, -200.0f/32768.0f}}),
+        TestSuite::Compare::Container<Containers::ArrayView<const Float>>);
+}
+
+void ConversionTest::formatUnsupported() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    const char data[4]{};
+    convertFormat(Buffer::Format::Quad8, data, Buffer::Format::Mono8);
+    convertFormat(Buffer::Format::Mono8, data, Buffer::Format::MonoMuLaw);
+    CORRADE_COMPARE(out.str(),
+        "Audio::convertFormat(): unsupported source format Audio::Buffer::Format::Quad8\n"
+        "Audio::convertFormat(): unsupported target format Audio::Buffer::Format::MonoMuLaw\n");
+}
+
+void ConversionTest::formatInvalidSize() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    const char data[3]{};
+    convertFormat(Buffer::Format::Stereo8, data, Buffer::Format::Mono8);
+    CORRADE_COMPARE(out.str(), "Audio::convertFormat(): data size 3 is not divisible by frame size 2\n");
+}
+
+void ConversionTest::resampleUp() {
+    const Short data[]{0, 100, 200, 300};
+    const Containers::Array<char> out = resample(Buffer::Format::Mono16,
+        Containers::arrayCast<const char>(Containers::arrayView(data)), 11025, 22050);
+    CORRADE_COMPARE_AS(Containers::arrayCast<const Short>(out),
+        (Containers::Array<Short>{Containers::InPlaceInit, {0, 50, 100, 150, 200, 250, 300, 300}}),
+        TestSuite::Compare::Container<Containers::ArrayView<const Short>>);
+}
+
+void ConversionTest::resampleDown() {
+    const Short data[]{0, 100, 200, 300, 400, 500};
+    const Containers::Array<char> out = resample(Buffer::Format::Mono16,
+        Containers::arrayCast<const char>(Containers::arrayView(data)), 44100, 14700);
+    CORRADE_COMPARE_AS(Containers::arrayCast<const Short>(out),
+        (Containers::Array<Short>{Containers::InPlaceInit, {0, 300}}),
+        TestSuite::Compare::Container<Containers::ArrayView<const Short>>);
+}
+
+void ConversionTest::resampleStereo() {
+    /* Channels are interpolated separately */
+    const Float data[]{0.0f, 1.0f, 0.5f, 0.0f};
+    const Containers::Array<char> out = resample(Buffer::Format::StereoFloat,
+        Containers::arrayCast<const char>(Containers::arrayView(data)), 1, 2);
+    CORRADE_COMPARE_AS(Containers::arrayCast<const Float>(out),
+        (Containers::Array<Float>{Containers::InPlaceInit, {0.0f, 1.0f, 0.25f, 0.5f, 0.5f, 0.0f, 0.5f, 0.0f}}),
+        TestSuite::Compare::Container<Containers::ArrayView<const Float>>);
+}
+
+void ConversionTest::resampleZeroFrequency() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    const char data[2]{};
+    resample(Buffer::Format::Mono8, data, 0, 44100);
+    CORRADE_COMPARE(out.str(), "Audio::resample(): expected non-zero frequencies\n");
+}
+
+void ConversionTest::convert() {
+    /* Stereo 8-bit at half the frequency to mono 16-bit */
+    const UnsignedByte data[]{0, 128, 192, 192};
+    const Containers::Array<char> out = Audio::convert(Buffer::Format::Stereo8,
+        Containers::arrayCast<const char>(Containers::arrayView(data)), 22050, Buffer::Format::Mono16, 44100);
+    CORRADE_COMPARE_AS(Containers::arrayCast<const Short>(out),
+        (Containers::Array<Short>{Containers::InPlaceInit, {-16384, 0, 16384, 16384}}),
+        TestSuite::Compare::Container<Containers::ArrayView<const Short>>);
+}
+
+void ConversionTest::convertPassthrough() {
+    const char data[]{1, 2, 3, 4};
+    const Containers::Array<char> out = Audio::convert(Buffer::Format::Stereo16, data, 44100, Buffer::Format::Stereo16, 44100);
+    CORRADE_VERIFY(out.data() != data);
+    CORRADE_COMPARE_AS(out, (Containers::Array<char>{Containers::InPlaceInit, {1, 2, 3, 4}}),
+        TestSuite::Compare::Container<Containers::ArrayView<const char>>);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Audio::Test::ConversionTest)
@@ -26,8 +26,10 @@
 
 #include <Corrade/TestSuite/Tester.h>
 
+#include "Magnum/Audio/Buffer.h"
 #include "Magnum/Audio/Context.h"
 #include "Magnum/Audio/Playable.h"
+#include "Magnum/Audio/Renderer.h"
 #include "Magnum/SceneGraph/Scene.h"
 #include "Magnum/SceneGraph/Object.h"
 #include "Magnum/SceneGraph/MatrixTransformation3D.h"
@@ -42,13 +44,19 @@ struct PlayableALTest: TestSuite::Tester {
 
     void feature();
     void group();
+    void groupUpdateOnlyChanged();
+    void groupVoices();
+    void groupVoicesVirtualOffset();
 
     Context _context;
 };
 
 PlayableALTest::PlayableALTest() {
     addTests({&PlayableALTest::feature,
-              &PlayableALTest::group});
+              &PlayableALTest::group,
+              &PlayableALTest::groupUpdateOnlyChanged,
+              &PlayableALTest::groupVoices,
+              &PlayableALTest::groupVoicesVirtualOffset});
 }
 
 void PlayableALTest::feature() {
@@ -91,6 +99,128 @@ void PlayableALTest::group() {
     group.stop();
 }
 
+void PlayableALTest::groupUpdateOnlyChanged() {
+    Scene3D scene;
+    Object3D object{&scene};
+    PlayableGroup3D group;
+    Playable3D playable{object, &group};
+
+    object.translate(Vector3::xAxis(3.0f));
+    group.setClean();
+    CORRADE_COMPARE(playable.source().position(), Vector3::xAxis(3.0f));
+
+    /* Overwrite the position behind the playable's back. Cleaning an object
+       whose transformation didn't change doesn't touch the source at all. */
+    playable.source().setPosition(Vector3{});
+    object.setDirty();
+    group.setClean();
+    CORRADE_COMPARE(playable.source().position(), Vector3{});
+
+    /* Actual change gets propagated */
+    object.translate(Vector3::yAxis(1.0f));
+    group.setClean();
+    CORRADE_COMPARE(playable.source().position(), (Vector3{3.0f, 1.0f, 0.0f}));
+}
+
+void PlayableALTest::groupVoices() {
+    Renderer::setListenerPosition(Vector3{});
+
+    /* One second of silence */
+    Buffer buffer;
+    char data[22050]{};
+    buffer.setData(Buffer::Format::Mono8, data, 22050);
+    CORRADE_COMPARE(buffer.duration(), 1.0f);
+
+    Scene3D scene;
+    Object3D near{&scene}, far{&scene};
+    near.translate(Vector3::xAxis(2.0f));
+    far.translate(Vector3::xAxis(20.0f));
+
+    PlayableGroup3D group{1};
+    Playable3D a{near, &group}, b{far, &group};
+    CORRADE_COMPARE(group.voiceCount(), 1);
+    CORRADE_COMPARE(group.freeVoiceCount(), 1);
+    CORRADE_VERIFY(a.isVirtual());
+    CORRADE_VERIFY(b.isVirtual());
+
+    a.setBuffer(&buffer).setLooping(true).play();
+    b.setBuffer(&buffer).setLooping(true).play();
+    group.setClean();
+    group.updateVoices(0.0f);
+
+    /* Only the nearer one gets the voice */
+    CORRADE_VERIFY(!a.isVirtual());
+    CORRADE_VERIFY(b.isVirtual());
+    CORRADE_COMPARE(group.freeVoiceCount(), 0);
+    CORRADE_COMPARE(a.source().position(), Vector3::xAxis(2.0f));
+    CORRADE_VERIFY(a.isPlaying());
+    CORRADE_VERIFY(b.isPlaying());
+
+    /* Swap the distances, the voice moves over */
+    near.translate(Vector3::xAxis(30.0f));
+    group.setClean();
+    group.updateVoices(0.0f);
+    CORRADE_VERIFY(a.isVirtual());
+    CORRADE_VERIFY(!b.isVirtual());
+    CORRADE_COMPARE(b.source().position(), Vector3::xAxis(20.0f));
+    CORRADE_VERIFY(a.isPlaying());
+
+    /* Lowering the gain makes it less audible than the other */
+    b.setGain(0.01f);
+    group.updateVoices(0.0f);
+    CORRADE_VERIFY(!a.isVirtual());
+    CORRADE_VERIFY(b.isVirtual());
+
+    /* Stopped playables don't need any voice */
+    a.stop();
+    b.stop();
+    group.updateVoices(0.0f);
+    CORRADE_VERIFY(a.isVirtual());
+    CORRADE_VERIFY(b.isVirtual());
+    CORRADE_COMPARE(group.freeVoiceCount(), 1);
+}
+
+void PlayableALTest::groupVoicesVirtualOffset() {
+    Buffer buffer;
+    char data[22050]{};
+    buffer.setData(Buffer::Format::Mono8, data, 22050);
+
+    Scene3D scene;
+    Object3D object{&scene};
+
+    /* Two playables at the same place sharing one voice */
+    PlayableGroup3D group{1};
+    Playable3D a{object, &group}, b{object, &group};
+    a.setBuffer(&buffer).setLooping(true).play();
+    b.setBuffer(&buffer).play();
+    b.setGain(0.5f);
+    group.updateVoices(0.0f);
+    CORRADE_VERIFY(!a.isVirtual());
+    CORRADE_VERIFY(b.isVirtual());
+
+    group.updateVoices(0.75f);
+    CORRADE_COMPARE(b.offsetInSeconds(), 0.75f);
+    CORRADE_VERIFY(b.isPlaying());
+
+    /* Non-looping virtual voice finishes on its own */
+    group.updateVoices(0.5f);
+    CORRADE_VERIFY(!b.isPlaying());
+    CORRADE_COMPARE(b.offsetInSeconds(), 0.0f);
+
+    /* Destroying a playable returns its voice to the pool */
+    {
+        PlayableGroup3D group2{1};
+        {
+            Playable3D c{object, &group2};
+            c.setBuffer(&buffer).play();
+            group2.updateVoices(0.0f);
+            CORRADE_VERIFY(!c.isVirtual());
+            CORRADE_COMPARE(group2.freeVoiceCount(), 0);
+        }
+        CORRADE_COMPARE(group2.freeVoiceCount(), 1);
+    }
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Audio::Test::PlayableALTest)
@@ -0,0 +1,250 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <memory>
+#include <vector>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/ThreadPool.h"
+#include "Magnum/Audio/Buffer.h"
+#include "Magnum/Audio/Context.h"
+#include "Magnum/Audio/PlayableOcclusion.h"
+#include "Magnum/Audio/Renderer.h"
+#include "Magnum/SceneGraph/Scene.h"
+#include "Magnum/SceneGraph/Object.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/Shapes/AxisAlignedBox.h"
+#include "Magnum/Shapes/Shape.h"
+
+namespace Magnum { namespace Audio { namespace Test {
+
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+
+struct PlayableOcclusionALTest: TestSuite::Tester {
+    explicit PlayableOcclusionALTest();
+
+    void occlusion();
+    void occlusionParallel();
+    void updateInterval();
+    void sourceGain();
+    void voices();
+
+    Context _context;
+};
+
+PlayableOcclusionALTest::PlayableOcclusionALTest() {
+    addTests({&PlayableOcclusionALTest::occlusion,
+              &PlayableOcclusionALTest::occlusionParallel,
+              &PlayableOcclusionALTest::updateInterval,
+              &PlayableOcclusionALTest::sourceGain,
+              &PlayableOcclusionALTest::voices});
+}
+
+namespace {
+
+/* Two walls perpendicular to the X axis, at 5 and 10 */
+struct Walls {
+    explicit Walls(Scene3D& scene): a{&scene}, b{&scene},
+        wallA{a, {{4.5f, -2.0f, -2.0f}, {5.5f, 2.0f, 2.0f}}, &shapes},
+        wallB{b, {{9.5f, -2.0f, -2.0f}, {10.5f, 2.0f, 2.0f}}, &shapes} {}
+
+    Shapes::ShapeGroup3D shapes;
+    Object3D a, b;
+    Shapes::Shape<Shapes::AxisAlignedBox3D> wallA, wallB;
+};
+
+}
+
+void PlayableOcclusionALTest::occlusion() {
+    Scene3D scene;
+    Walls walls{scene};
+
+    Object3D front{&scene}, middle{&scene}, back{&scene};
+    front.translate(Vector3::xAxis(3.0f));
+    middle.translate(Vector3::xAxis(7.0f));
+    back.translate(Vector3::xAxis(15.0f));
+
+    /* Virtual voices, so the test doesn't need to play anything */
+    PlayableGroup3D group{1};
+    Playable3D a{front, &group}, b{middle, &group}, c{back, &group}, stopped{back, &group};
+    a.play();
+    b.play();
+    c.play();
+    CORRADE_COMPARE(stopped.occlusionGain(), 1.0f);
+
+    PlayableOcclusion3D occlusion{walls.shapes};
+    CORRADE_VERIFY(&occlusion.occluders() == &walls.shapes);
+    CORRADE_COMPARE(occlusion.transmission(), 0.5f);
+    CORRADE_VERIFY(occlusion.update(group, {}, 0.0f));
+    CORRADE_COMPARE(a.occlusionGain(), 1.0f);
+    CORRADE_COMPARE(b.occlusionGain(), 0.5f);
+    CORRADE_COMPARE(c.occlusionGain(), 0.25f);
+
+    /* Not playing ones are not touched */
+    CORRADE_COMPARE(stopped.occlusionGain(), 1.0f);
+
+    /* Moving the listener behind the first wall */
+    occlusion.setUpdateInterval(0.0f)
+        .setTransmission(0.1f);
+    CORRADE_VERIFY(occlusion.update(group, Vector3::xAxis(6.0f), 0.0f));
+    CORRADE_COMPARE(a.occlusionGain(), 0.1f);
+    CORRADE_COMPARE(b.occlusionGain(), 1.0f);
+    CORRADE_COMPARE(c.occlusionGain(), 0.1f);
+}
+
+void PlayableOcclusionALTest::occlusionParallel() {
+    Scene3D scene;
+    Walls walls{scene};
+
+    /* Many playables in a grid behind and in front of the walls, owned by
+       the objects */
+    PlayableGroup3D group{4};
+    std::vector<std::unique_ptr<Object3D>> objects;
+    std::vector<Playable3D*> playables;
+    for(Int x = 0; x != 20; ++x) for(Int y = -5; y != 5; ++y) {
+        objects.emplace_back(new Object3D{&scene});
+        objects.back()->translate({x*1.0f + 0.25f, y*1.0f, 0.0f});
+        playables.push_back(new Playable3D{*objects.back(), &group});
+        playables.back()->play();
+    }
+
+    PlayableOcclusion3D occlusion{walls.shapes};
+    occlusion.setUpdateInterval(0.0f);
+    CORRADE_VERIFY(occlusion.update(group, {}, 0.0f));
+    std::vector<Float> expected;
+    for(Playable3D* playable: playables) expected.push_back(playable->occlusionGain());
+
+    /* Some are occluded, some not */
+    CORRADE_COMPARE(expected.front(), 1.0f);
+    CORRADE_COMPARE(playables[10*17 + 5]->occlusionGain(), 0.25f);
+
+    ThreadPool pool{4};
+    occlusion.setTransmission(0.25f);
+    CORRADE_VERIFY(occlusion.update(group, {}, 0.0f, pool));
+    occlusion.setTransmission(0.5f);
+    CORRADE_VERIFY(occlusion.update(group, {}, 0.0f, pool));
+    for(std::size_t i = 0; i != playables.size(); ++i)
+        CORRADE_COMPARE(playables[i]->occlusionGain(), expected[i]);
+}
+
+void PlayableOcclusionALTest::updateInterval() {
+    Scene3D scene;
+    Walls walls{scene};
+
+    Object3D object{&scene};
+    object.translate(Vector3::xAxis(7.0f));
+    PlayableGroup3D group{1};
+    Playable3D playable{object, &group};
+    playable.play();
+
+    PlayableOcclusion3D occlusion{walls.shapes};
+    occlusion.setUpdateInterval(0.5f);
+    CORRADE_COMPARE(occlusion.updateInterval(), 0.5f);
+
+    /* The first update is always done */
+    CORRADE_VERIFY(occlusion.update(group, {}, 0.0f));
+    CORRADE_COMPARE(playable.occlusionGain(), 0.5f);
+
+    /* Then only once the interval passes */
+    object.translate(Vector3::xAxis(-4.0f));
+    CORRADE_VERIFY(!occlusion.update(group, {}, 0.2f));
+    CORRADE_VERIFY(!occlusion.update(group, {}, 0.2f));
+    CORRADE_COMPARE(playable.occlusionGain(), 0.5f);
+    CORRADE_VERIFY(occlusion.update(group, {}, 0.2f));
+    CORRADE_COMPARE(playable.occlusionGain(), 1.0f);
+}
+
+void PlayableOcclusionALTest::sourceGain() {
+    /* One second of silence */
+    Buffer buffer;
+    char data[22050]{};
+    buffer.setData(Buffer::Format::Mono8, data, 22050);
+
+    Scene3D scene;
+    Walls walls{scene};
+
+    Object3D object{&scene};
+    object.translate(Vector3::xAxis(12.0f));
+    PlayableGroup3D group;
+    Playable3D playable{object, &group};
+    playable.setGain(0.5f);
+    playable.source().setBuffer(&buffer)
+        .setLooping(true)
+        .play();
+
+    PlayableOcclusion3D occlusion{walls.shapes};
+    CORRADE_VERIFY(occlusion.update(group, {}, 0.0f));
+    CORRADE_COMPARE(playable.occlusionGain(), 0.25f);
+    CORRADE_COMPARE(playable.source().gain(), 0.125f);
+
+    /* Gain of the playable and the group is combined with the occlusion */
+    group.setGain(0.5f);
+    CORRADE_COMPARE(playable.source().gain(), 0.0625f);
+    playable.setGain(1.0f);
+    CORRADE_COMPARE(playable.source().gain(), 0.125f);
+
+    playable.source().stop();
+}
+
+void PlayableOcclusionALTest::voices() {
+    Renderer::setListenerPosition(Vector3{});
+
+    /* One second of silence */
+    Buffer buffer;
+    char data[22050]{};
+    buffer.setData(Buffer::Format::Mono8, data, 22050);
+
+    Scene3D scene;
+    Walls walls{scene};
+
+    /* The near one is behind a wall, the far one is in the other direction
+       and not occluded */
+    Object3D near{&scene}, far{&scene};
+    near.translate(Vector3::xAxis(6.0f));
+    far.translate(Vector3::xAxis(-10.0f));
+
+    PlayableGroup3D group{1};
+    Playable3D a{near, &group}, b{far, &group};
+    a.setBuffer(&buffer).setLooping(true).play();
+    b.setBuffer(&buffer).setLooping(true).play();
+    group.setClean();
+    group.updateVoices(0.0f);
+    CORRADE_VERIFY(!a.isVirtual());
+    CORRADE_VERIFY(b.isVirtual());
+
+    /* With the occlusion the far one is more audible */
+    PlayableOcclusion3D occlusion{walls.shapes};
+    occlusion.setTransmission(0.1f);
+    CORRADE_VERIFY(occlusion.update(group, {}, 0.0f));
+    group.updateVoices(0.0f);
+    CORRADE_VERIFY(a.isVirtual());
+    CORRADE_VERIFY(!b.isVirtual());
+    CORRADE_COMPARE(b.source().gain(), 1.0f);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Audio::Test::PlayableOcclusionALTest)
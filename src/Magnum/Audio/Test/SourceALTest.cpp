@@ -25,6 +25,7 @@
 
 #include <Corrade/TestSuite/Tester.h>
 
+#include "Magnum/Audio/Buffer.h"
 #include "Magnum/Audio/Context.h"
 #include "Magnum/Audio/Source.h"
 
@@ -46,6 +47,7 @@ struct SourceALTest: TestSuite::Tester {
     void minGain();
     void coneAnglesAndGain();
     void rolloffFactor();
+    void queueBuffers();
 
     Context _context;
 };
@@ -63,7 +65,8 @@ SourceALTest::SourceALTest() {
               &SourceALTest::maxGain,
               &SourceALTest::minGain,
               &SourceALTest::coneAnglesAndGain,
-              &SourceALTest::rolloffFactor});
+              &SourceALTest::rolloffFactor,
+              &SourceALTest::queueBuffers});
 }
 
 void SourceALTest::construct() {
@@ -168,6 +171,27 @@ void SourceALTest::rolloffFactor() {
     CORRADE_COMPARE(source.rolloffFactor(), fact);
 }
 
+void SourceALTest::queueBuffers() {
+    const char data[]{25, 90, 12, 24};
+    Buffer a, b;
+    a.setData(Buffer::Format::Mono8, data, 22050);
+    b.setData(Buffer::Format::Mono8, data, 22050);
+
+    Source source;
+    source.queueBuffers({a, b});
+    CORRADE_VERIFY(source.type() == Source::Type::Streaming);
+    CORRADE_COMPARE(source.queuedBufferCount(), 2);
+    CORRADE_COMPARE(source.processedBufferCount(), 0);
+
+    /* Stopping marks all buffers as processed */
+    source.play();
+    source.stop();
+    CORRADE_COMPARE(source.processedBufferCount(), 2);
+
+    source.unqueueBuffers(2);
+    CORRADE_COMPARE(source.queuedBufferCount(), 0);
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Audio::Test::SourceALTest)
@@ -0,0 +1,127 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <chrono>
+#include <thread>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Audio/AbstractImporter.h"
+#include "Magnum/Audio/Context.h"
+#include "Magnum/Audio/StreamingSource.h"
+
+namespace Magnum { namespace Audio { namespace Test {
+
+struct StreamingSourceALTest: TestSuite::Tester {
+    explicit StreamingSourceALTest();
+
+    void construct();
+    void play();
+    void playToEnd();
+    void looping();
+
+    Context _context;
+};
+
+StreamingSourceALTest::StreamingSourceALTest() {
+    addTests({&StreamingSourceALTest::construct,
+              &StreamingSourceALTest::play,
+              &StreamingSourceALTest::playToEnd,
+              &StreamingSourceALTest::looping});
+}
+
+namespace {
+
+/* Ten frames of 8-bit mono */
+class Importer: public Audio::AbstractImporter {
+    private:
+        Features doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        Buffer::Format doFormat() const override { return Buffer::Format::Mono8; }
+        UnsignedInt doFrequency() const override { return 22050; }
+        Containers::Array<char> doData() override {
+            Containers::Array<char> out{10};
+            for(std::size_t i = 0; i != out.size(); ++i) out[i] = i*25;
+            return out;
+        }
+};
+
+}
+
+void StreamingSourceALTest::construct() {
+    Importer importer;
+    StreamingSource source{importer, 4, 2};
+    CORRADE_VERIFY(source.source().id() != 0);
+    CORRADE_VERIFY(!source.isLooping());
+    CORRADE_VERIFY(!source.isFinished());
+}
+
+void StreamingSourceALTest::play() {
+    Importer importer;
+    StreamingSource source{importer, 4, 2};
+
+    /* The first two chunks get queued right away */
+    source.play();
+    CORRADE_VERIFY(source.source().type() == Source::Type::Streaming);
+    CORRADE_COMPARE(source.source().queuedBufferCount(), 2);
+    CORRADE_VERIFY(!source.isFinished());
+}
+
+void StreamingSourceALTest::playToEnd() {
+    Importer importer;
+    StreamingSource source{importer, 4, 2};
+    source.play();
+
+    /* The whole thing is less than a millisecond long */
+    for(std::size_t i = 0; i != 1000 && !source.isFinished(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+        source.update();
+    }
+
+    CORRADE_VERIFY(source.isFinished());
+    CORRADE_COMPARE(source.source().queuedBufferCount(), 0);
+}
+
+void StreamingSourceALTest::looping() {
+    Importer importer;
+    StreamingSource source{importer, 4, 2};
+    source.setLooping(true)
+        .play();
+    CORRADE_VERIFY(source.isLooping());
+
+    /* Never finishes */
+    for(std::size_t i = 0; i != 10; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+        source.update();
+    }
+
+    CORRADE_VERIFY(!source.isFinished());
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Audio::Test::StreamingSourceALTest)
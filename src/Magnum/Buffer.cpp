@@ -30,6 +30,7 @@
 
 #include "Magnum/Context.h"
 #include "Magnum/Extensions.h"
+#include "Magnum/MemoryTracker.h"
 
 #include "Implementation/State.h"
 #include "Implementation/BufferState.h"
@@ -184,6 +185,8 @@ Buffer::~Buffer() {
     for(std::size_t i = 1; i != Implementation::BufferState::TargetCount; ++i)
         if(bindings[i] == _id) bindings[i] = 0;
 
+    Context::current().memoryTracker().remove(MemoryObjectType::Buffer, _id);
+
     glDeleteBuffers(1, &_id);
 }
 
@@ -216,6 +219,7 @@ Buffer& Buffer::setLabelInternal(const Containers::ArrayView<const char> label)
     #else
     Context::current().state().debug->labelImplementation(GL_BUFFER_KHR, _id, label);
     #endif
+    Context::current().memoryTracker().setLabel(MemoryObjectType::Buffer, _id, {label.data(), label.size()});
     return *this;
 }
 #endif
@@ -296,11 +300,29 @@ Containers::Array<char> Buffer::data() {
 
 Buffer& Buffer::setData(const Containers::ArrayView<const void> data, const BufferUsage usage) {
     (this->*Context::current().state().buffer->dataImplementation)(data.size(), data, usage);
+    Context::current().memoryTracker().setAllocation(MemoryObjectType::Buffer, _id, data.size());
+    #ifdef MAGNUM_BUILD_STATISTICS
+    if(data.data()) Context::current().statisticsInternal().bufferUploadSize += data.size();
+    #endif
+    return *this;
+}
+
+#ifndef MAGNUM_TARGET_GLES
+Buffer& Buffer::setStorage(const Containers::ArrayView<const void> data, const StorageFlags flags) {
+    (this->*Context::current().state().buffer->storageImplementation)(data.size(), data, flags);
+    Context::current().memoryTracker().setAllocation(MemoryObjectType::Buffer, _id, data.size());
+    #ifdef MAGNUM_BUILD_STATISTICS
+    if(data.data()) Context::current().statisticsInternal().bufferUploadSize += data.size();
+    #endif
     return *this;
 }
+#endif
 
 Buffer& Buffer::setSubData(const GLintptr offset, const Containers::ArrayView<const void> data) {
     (this->*Context::current().state().buffer->subDataImplementation)(offset, data.size(), data);
+    #ifdef MAGNUM_BUILD_STATISTICS
+    Context::current().statisticsInternal().bufferUploadSize += data.size();
+    #endif
     return *this;
 }
 
@@ -465,6 +487,21 @@ void Buffer::dataImplementationDSAEXT(GLsizeiptr size, const GLvoid* data, Buffe
 }
 #endif
 
+#ifndef MAGNUM_TARGET_GLES
+void Buffer::storageImplementationDefault(GLsizeiptr size, const GLvoid* data, StorageFlags flags) {
+    glBufferStorage(GLenum(bindSomewhereInternal(_targetHint)), size, data, GLbitfield(flags));
+}
+
+void Buffer::storageImplementationDSA(const GLsizeiptr size, const GLvoid* const data, const StorageFlags flags) {
+    glNamedBufferStorage(_id, size, data, GLbitfield(flags));
+}
+
+void Buffer::storageImplementationDSAEXT(GLsizeiptr size, const GLvoid* data, StorageFlags flags) {
+    _flags |= ObjectFlag::Created;
+    glNamedBufferStorageEXT(_id, size, data, GLbitfield(flags));
+}
+#endif
+
 void Buffer::subDataImplementationDefault(GLintptr offset, GLsizeiptr size, const GLvoid* data) {
     glBufferSubData(GLenum(bindSomewhereInternal(_targetHint)), offset, size, data);
 }
@@ -594,6 +631,9 @@ Debug& operator<<(Debug& debug, Buffer::TargetHint value) {
         #endif
         #endif
         _c(ElementArray)
+        #ifndef MAGNUM_TARGET_GLES
+        _c(Parameter)
+        #endif
         #ifndef MAGNUM_TARGET_GLES2
         _c(PixelPack)
         _c(PixelUnpack)
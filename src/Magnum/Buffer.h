@@ -174,6 +174,22 @@ memory operations performed by OpenGL on unmapping. Example:
 
 @snippet Magnum.cpp Buffer-flush
 
+@section Buffer-data-storage Immutable storage and persistent mapping
+
+If @extension{ARB,buffer_storage} (part of OpenGL 4.4) is available, the
+buffer can be allocated with @ref setStorage() instead of @ref setData().
+Size of such buffer can't be changed later, which allows the driver to skip
+reallocation checks, and the @ref StorageFlags put an upper bound on how the
+buffer will be accessed. With @ref StorageFlag::MapPersistent the buffer can
+stay mapped for its whole lifetime using @ref MapFlag::Persistent, avoiding
+repeated map and unmap calls when streaming vertex, instance or uniform data
+every frame. Without @ref MapFlag::Coherent the writes need to be made
+visible to the GPU explicitly using @ref flushMappedRange(). In both cases
+the application is responsible for not overwriting memory that is still
+being read by the GPU, for example by fencing each frame's region:
+
+@snippet Magnum.cpp Buffer-storage-persistent
+
 @section Buffer-webgl-restrictions WebGL restrictions
 
 Buffers in @ref MAGNUM_TARGET_WEBGL "WebGL" need to be bound only to one unique
@@ -220,6 +236,7 @@ by OpenGL in order to preserve the data. If running on OpenGL ES or extension
 functions do nothing.
  */
 class MAGNUM_EXPORT Buffer: public AbstractObject {
+    friend DeletionQueue;
     friend Implementation::BufferState;
 
     public:
@@ -287,6 +304,17 @@ class MAGNUM_EXPORT Buffer: public AbstractObject {
             /** Used for storing vertex indices. */
             ElementArray = GL_ELEMENT_ARRAY_BUFFER,
 
+            #ifndef MAGNUM_TARGET_GLES
+            /**
+             * Used for supplying draw count for indirect drawing. See
+             * @ref Mesh::drawIndirect(AbstractShaderProgram&, Buffer&, GLintptr, Buffer&, GLintptr, Int, GLsizei).
+             * @requires_gl46 Extension @extension{ARB,indirect_parameters}
+             * @requires_gl Indirect draw count is not available in OpenGL ES
+             *      or WebGL.
+             */
+            Parameter = GL_PARAMETER_BUFFER,
+            #endif
+
             #ifndef MAGNUM_TARGET_GLES2
             /**
              * Target for pixel pack operations.
@@ -494,9 +522,32 @@ class MAGNUM_EXPORT Buffer: public AbstractObject {
              * before mapping.
              */
             #ifndef MAGNUM_TARGET_GLES2
-            Unsynchronized = GL_MAP_UNSYNCHRONIZED_BIT
+            Unsynchronized = GL_MAP_UNSYNCHRONIZED_BIT,
             #else
-            Unsynchronized = GL_MAP_UNSYNCHRONIZED_BIT_EXT
+            Unsynchronized = GL_MAP_UNSYNCHRONIZED_BIT_EXT,
+            #endif
+
+            #ifndef MAGNUM_TARGET_GLES
+            /**
+             * The buffer can stay mapped while it's used by the GPU. Requires
+             * the storage to be allocated using @ref setStorage() with
+             * @ref StorageFlag::MapPersistent.
+             * @requires_gl44 Extension @extension{ARB,buffer_storage}
+             * @requires_gl Persistent mapping is not available in OpenGL ES
+             *      and WebGL.
+             */
+            Persistent = GL_MAP_PERSISTENT_BIT,
+
+            /**
+             * Writes to a persistently mapped buffer are visible to the GPU
+             * without calling @ref flushMappedRange(). Requires the storage to
+             * be allocated using @ref setStorage() with
+             * @ref StorageFlag::MapCoherent.
+             * @requires_gl44 Extension @extension{ARB,buffer_storage}
+             * @requires_gl Coherent mapping is not available in OpenGL ES
+             *      and WebGL.
+             */
+            Coherent = GL_MAP_COHERENT_BIT
             #endif
         };
 
@@ -512,6 +563,53 @@ class MAGNUM_EXPORT Buffer: public AbstractObject {
         typedef Containers::EnumSet<MapFlag> MapFlags;
         #endif
 
+        #ifndef MAGNUM_TARGET_GLES
+        /**
+         * @brief Immutable storage flag
+         *
+         * @see @ref StorageFlags, @ref setStorage()
+         * @requires_gl44 Extension @extension{ARB,buffer_storage}
+         * @requires_gl Immutable buffer storage is not available in OpenGL ES
+         *      and WebGL.
+         */
+        enum class StorageFlag: GLbitfield {
+            /** Allow the buffer to be mapped for reading. */
+            MapRead = GL_MAP_READ_BIT,
+
+            /** Allow the buffer to be mapped for writing. */
+            MapWrite = GL_MAP_WRITE_BIT,
+
+            /**
+             * Allow the buffer to be mapped with @ref MapFlag::Persistent.
+             * Requires @ref StorageFlag::MapRead or @ref StorageFlag::MapWrite
+             * as well.
+             */
+            MapPersistent = GL_MAP_PERSISTENT_BIT,
+
+            /**
+             * Allow the buffer to be mapped with @ref MapFlag::Coherent.
+             * Requires @ref StorageFlag::MapPersistent as well.
+             */
+            MapCoherent = GL_MAP_COHERENT_BIT,
+
+            /** Allow updating the contents using @ref setSubData(). */
+            DynamicStorage = GL_DYNAMIC_STORAGE_BIT,
+
+            /** Prefer the storage to be in client memory. */
+            ClientStorage = GL_CLIENT_STORAGE_BIT
+        };
+
+        /**
+         * @brief Immutable storage flags
+         *
+         * @see @ref setStorage()
+         * @requires_gl44 Extension @extension{ARB,buffer_storage}
+         * @requires_gl Immutable buffer storage is not available in OpenGL ES
+         *      and WebGL.
+         */
+        typedef Containers::EnumSet<StorageFlag> StorageFlags;
+        #endif
+
         #ifndef MAGNUM_TARGET_GLES
         /**
          * @brief Minimal supported mapping alignment
@@ -1031,6 +1129,45 @@ class MAGNUM_EXPORT Buffer: public AbstractObject {
             return *this;
         }
 
+        #ifndef MAGNUM_TARGET_GLES
+        /**
+         * @brief Set immutable buffer storage
+         * @param data      Data
+         * @param flags     Storage flags
+         * @return Reference to self (for method chaining)
+         *
+         * After calling this function the buffer size can't be changed and
+         * neither @ref setData() nor @ref setStorage() can be called again.
+         * The contents can be updated using @ref setSubData() only if
+         * @ref StorageFlag::DynamicStorage is set and mapped only with flags
+         * allowed by @p flags. See @ref Buffer-data-storage for more
+         * information. If neither @extension{ARB,direct_state_access} (part
+         * of OpenGL 4.5) nor @extension{EXT,direct_state_access} desktop
+         * extension is available, the buffer is bound to hinted target before
+         * the operation (if not already).
+         * @see @ref setTargetHint(), @fn_gl2_keyword{NamedBufferStorage,BufferStorage},
+         *      @fn_gl_extension_keyword{NamedBufferStorage,EXT,direct_state_access},
+         *      eventually @fn_gl{BindBuffer} and @fn_gl_keyword{BufferStorage}
+         * @requires_gl44 Extension @extension{ARB,buffer_storage}
+         * @requires_gl Immutable buffer storage is not available in OpenGL ES
+         *      and WebGL.
+         */
+        Buffer& setStorage(Containers::ArrayView<const void> data, StorageFlags flags);
+
+        /**
+         * @brief Set immutable buffer storage without initializing it
+         * @param size      Size in bytes
+         * @param flags     Storage flags
+         * @return Reference to self (for method chaining)
+         *
+         * Equivalent to calling @ref setStorage(Containers::ArrayView<const void>, StorageFlags)
+         * with @cpp nullptr @ce data of @p size bytes.
+         */
+        Buffer& setStorage(std::size_t size, StorageFlags flags) {
+            return setStorage({nullptr, size}, flags);
+        }
+        #endif
+
         /**
          * @brief Set buffer subdata
          * @param offset    Byte offset in the buffer
@@ -1281,6 +1418,12 @@ class MAGNUM_EXPORT Buffer: public AbstractObject {
         void MAGNUM_LOCAL dataImplementationDSAEXT(GLsizeiptr size, const GLvoid* data, BufferUsage usage);
         #endif
 
+        #ifndef MAGNUM_TARGET_GLES
+        void MAGNUM_LOCAL storageImplementationDefault(GLsizeiptr size, const GLvoid* data, StorageFlags flags);
+        void MAGNUM_LOCAL storageImplementationDSA(GLsizeiptr size, const GLvoid* data, StorageFlags flags);
+        void MAGNUM_LOCAL storageImplementationDSAEXT(GLsizeiptr size, const GLvoid* data, StorageFlags flags);
+        #endif
+
         void MAGNUM_LOCAL subDataImplementationDefault(GLintptr offset, GLsizeiptr size, const GLvoid* data);
         #ifndef MAGNUM_TARGET_GLES
         void MAGNUM_LOCAL subDataImplementationDSA(GLintptr offset, GLsizeiptr size, const GLvoid* data);
@@ -1332,6 +1475,10 @@ class MAGNUM_EXPORT Buffer: public AbstractObject {
 CORRADE_ENUMSET_OPERATORS(Buffer::MapFlags)
 #endif
 
+#ifndef MAGNUM_TARGET_GLES
+CORRADE_ENUMSET_OPERATORS(Buffer::StorageFlags)
+#endif
+
 /** @debugoperatorclassenum{Magnum::Buffer,Magnum::Buffer::TargetHint} */
 MAGNUM_EXPORT Debug& operator<<(Debug& debug, Buffer::TargetHint value);
 
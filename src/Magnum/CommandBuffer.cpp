@@ -0,0 +1,224 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "CommandBuffer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/AbstractFramebuffer.h"
+#include "Magnum/AbstractTexture.h"
+#include "Magnum/Buffer.h"
+#include "Magnum/DrawPacket.h"
+#include "Magnum/Mesh.h"
+#include "Magnum/MeshView.h"
+
+namespace Magnum {
+
+CommandBuffer::CommandBuffer() = default;
+
+CommandBuffer::CommandBuffer(CommandBuffer&&) noexcept = default;
+
+CommandBuffer& CommandBuffer::operator=(CommandBuffer&&) noexcept = default;
+
+std::vector<UnsignedLong> CommandBuffer::sortKeys() const {
+    std::vector<UnsignedLong> out;
+    out.reserve(_segments.size());
+    for(const Segment& segment: _segments) out.push_back(segment.sortKey);
+    return out;
+}
+
+CommandBuffer& CommandBuffer::reserve(const std::size_t commandCount, const std::size_t segmentCount) {
+    _commands.reserve(commandCount);
+    _segments.reserve(segmentCount);
+    return *this;
+}
+
+CommandBuffer& CommandBuffer::clear() {
+    _commands.clear();
+    _segments.clear();
+    _data.clear();
+    return *this;
+}
+
+CommandBuffer& CommandBuffer::begin(const UnsignedLong sortKey) {
+    /* Reuse the last segment if it's still empty */
+    if(!_segments.empty() && _segments.back().begin == _segments.back().end)
+        _segments.back().sortKey = sortKey;
+    else _segments.push_back({sortKey, _commands.size(), _commands.size()});
+    return *this;
+}
+
+CommandBuffer::Command& CommandBuffer::addCommand(const CommandType type) {
+    /* Implicit first segment */
+    if(_segments.empty()) _segments.push_back({0, 0, 0});
+
+    _commands.push_back({type, 0, 0, nullptr, nullptr, 0, 0, 0});
+    /* Segments are always appended at the end, so only the last one can
+       grow */
+    _segments.back().end = _commands.size();
+    return _commands.back();
+}
+
+CommandBuffer& CommandBuffer::bindFramebuffer(AbstractFramebuffer& framebuffer) {
+    addCommand(CommandType::BindFramebuffer).object = &framebuffer;
+    return *this;
+}
+
+CommandBuffer& CommandBuffer::bindTexture(const Int textureUnit, AbstractTexture& texture) {
+    Command& command = addCommand(CommandType::BindTexture);
+    command.index = textureUnit;
+    command.object = &texture;
+    return *this;
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+CommandBuffer& CommandBuffer::bindBuffer(const Buffer::Target target, const UnsignedInt index, Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    Command& command = addCommand(CommandType::BindBuffer);
+    command.index = index;
+    command.object = &buffer;
+    command.offset = offset;
+    command.size = size;
+    command.target = GLenum(target);
+    return *this;
+}
+#endif
+
+CommandBuffer& CommandBuffer::setBufferSubData(Buffer& buffer, const GLintptr offset, const Containers::ArrayView<const void> data) {
+    Command& command = addCommand(CommandType::SetBufferSubData);
+    command.object = &buffer;
+    command.offset = offset;
+    command.size = data.size();
+    command.dataOffset = _data.size();
+    _data.resize(_data.size() + data.size());
+    if(data.size()) std::memcpy(_data.data() + command.dataOffset, data.data(), data.size());
+    return *this;
+}
+
+CommandBuffer& CommandBuffer::applyState(const Renderer::StateBlock& state) {
+    addCommand(CommandType::ApplyState).object = const_cast<Renderer::StateBlock*>(&state);
+    return *this;
+}
+
+CommandBuffer& CommandBuffer::draw(Mesh& mesh, AbstractShaderProgram& shader) {
+    Command& command = addCommand(CommandType::DrawMesh);
+    command.object = &mesh;
+    command.shader = &shader;
+    return *this;
+}
+
+CommandBuffer& CommandBuffer::draw(MeshView& mesh, AbstractShaderProgram& shader) {
+    Command& command = addCommand(CommandType::DrawMeshView);
+    command.object = &mesh;
+    command.shader = &shader;
+    return *this;
+}
+
+CommandBuffer& CommandBuffer::draw(const DrawPacket& packet) {
+    Command& command = addCommand(CommandType::SubmitDrawPacket);
+    command.object = const_cast<DrawPacket*>(&packet);
+    return *this;
+}
+
+CommandBuffer& CommandBuffer::sort() {
+    std::stable_sort(_segments.begin(), _segments.end(), [](const Segment& a, const Segment& b) {
+        return a.sortKey < b.sortKey;
+    });
+    return *this;
+}
+
+void CommandBuffer::replaySegment(const Segment& segment) const {
+    /* Previous packet in an uninterrupted sequence of packet submissions */
+    const DrawPacket* previousPacket = nullptr;
+
+    for(std::size_t i = segment.begin; i != segment.end; ++i) {
+        const Command& command = _commands[i];
+        if(command.type != CommandType::SubmitDrawPacket) previousPacket = nullptr;
+
+        switch(command.type) {
+            case CommandType::BindFramebuffer:
+                static_cast<AbstractFramebuffer*>(command.object)->bind();
+                continue;
+            case CommandType::BindTexture:
+                static_cast<AbstractTexture*>(command.object)->bind(command.index);
+                continue;
+            #ifndef MAGNUM_TARGET_GLES2
+            case CommandType::BindBuffer:
+                static_cast<Buffer*>(command.object)->bind(Buffer::Target(command.target), command.index, command.offset, command.size);
+                continue;
+            #endif
+            case CommandType::SetBufferSubData:
+                static_cast<Buffer*>(command.object)->setSubData(command.offset, {_data.data() + command.dataOffset, std::size_t(command.size)});
+                continue;
+            case CommandType::ApplyState:
+                Renderer::apply(*static_cast<const Renderer::StateBlock*>(command.object));
+                continue;
+            case CommandType::DrawMesh:
+                static_cast<Mesh*>(command.object)->draw(*command.shader);
+                continue;
+            case CommandType::DrawMeshView:
+                static_cast<MeshView*>(command.object)->draw(*command.shader);
+                continue;
+            case CommandType::SubmitDrawPacket: {
+                const DrawPacket& packet = *static_cast<const DrawPacket*>(command.object);
+                if(packet.isEmpty()) continue;
+                packet.submitInternal(previousPacket);
+                previousPacket = &packet;
+            } continue;
+        }
+
+        CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+    }
+}
+
+void CommandBuffer::replay() const {
+    for(const Segment& segment: _segments) replaySegment(segment);
+}
+
+void CommandBuffer::replay(std::initializer_list<std::reference_wrapper<const CommandBuffer>> buffers) {
+    replay(Containers::arrayView(buffers.begin(), buffers.size()));
+}
+
+void CommandBuffer::replay(const Containers::ArrayView<const std::reference_wrapper<const CommandBuffer>> buffers) {
+    /* Gather segments of all buffers. Stable sort preserves the order of
+       buffers for equal keys. */
+    std::vector<std::pair<const CommandBuffer*, const Segment*>> segments;
+    std::size_t segmentCount = 0;
+    for(const CommandBuffer& buffer: buffers) segmentCount += buffer._segments.size();
+    segments.reserve(segmentCount);
+    for(const CommandBuffer& buffer: buffers)
+        for(const Segment& segment: buffer._segments)
+            segments.emplace_back(&buffer, &segment);
+
+    std::stable_sort(segments.begin(), segments.end(), [](const std::pair<const CommandBuffer*, const Segment*>& a, const std::pair<const CommandBuffer*, const Segment*>& b) {
+        return a.second->sortKey < b.second->sortKey;
+    });
+
+    for(const std::pair<const CommandBuffer*, const Segment*>& segment: segments)
+        segment.first->replaySegment(*segment.second);
+}
+
+}
@@ -0,0 +1,305 @@
+#ifndef Magnum_CommandBuffer_h
+#define Magnum_CommandBuffer_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::CommandBuffer
+ */
+
+#include <functional>
+#include <initializer_list>
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/OpenGL.h"
+#include "Magnum/Renderer.h"
+#include "Magnum/visibility.h"
+
+#ifndef MAGNUM_TARGET_GLES2
+#include "Magnum/Buffer.h"
+#endif
+
+namespace Magnum {
+
+/**
+@brief Recorded render command stream
+
+Records framebuffer and texture binding, buffer updates, renderer state
+changes and draws into a compact command stream without touching OpenGL.
+Recording doesn't need a current context, so scene traversal can be done on
+any thread, each thread filling its own buffer. The recorded commands are then
+submitted on the thread owning the GL context using @ref replay():
+
+@snippet Magnum.cpp CommandBuffer-usage
+
+@section CommandBuffer-sorting Sorting
+
+The commands are grouped into segments, each started with @ref begin() and
+having a sort key. Commands recorded before the first @ref begin() belong to
+an implicit segment with key @cpp 0 @ce. The @ref sort() function reorders
+whole segments by their key, keeping commands inside each segment in the
+order they were recorded and keeping the recording order for segments with
+equal keys. The key can be used for example to group draws by shader and
+material to minimize state changes or to order transparent objects
+back-to-front. The @ref replay(std::initializer_list<std::reference_wrapper<const CommandBuffer>>)
+overload merges segments of multiple buffers recorded in parallel and
+submits them sorted together.
+
+@section CommandBuffer-lifetime Object lifetime
+
+Only references to the meshes, shaders, textures, framebuffers, buffers, draw
+packets and state blocks are recorded, so they have to be kept alive and
+unmodified from other threads until the buffer is replayed. Data passed to
+@ref setBufferSubData() are copied into the command buffer.
+*/
+class MAGNUM_EXPORT CommandBuffer {
+    public:
+        /** @brief Constructor */
+        explicit CommandBuffer();
+
+        /** @brief Copying is not allowed */
+        CommandBuffer(const CommandBuffer&) = delete;
+
+        /** @brief Move constructor */
+        CommandBuffer(CommandBuffer&&) noexcept;
+
+        /** @brief Copying is not allowed */
+        CommandBuffer& operator=(const CommandBuffer&) = delete;
+
+        /** @brief Move assignment */
+        CommandBuffer& operator=(CommandBuffer&&) noexcept;
+
+        /** @brief Whether there are no recorded commands */
+        bool isEmpty() const { return _commands.empty(); }
+
+        /** @brief Count of recorded commands */
+        std::size_t commandCount() const { return _commands.size(); }
+
+        /**
+         * @brief Count of segments
+         *
+         * Includes the implicit first segment if any commands were recorded
+         * before the first call to @ref begin().
+         */
+        std::size_t segmentCount() const { return _segments.size(); }
+
+        /**
+         * @brief Sort keys of all segments
+         *
+         * In the order in which the segments will be replayed.
+         */
+        std::vector<UnsignedLong> sortKeys() const;
+
+        /**
+         * @brief Size of copied data
+         *
+         * Total size of data recorded with @ref setBufferSubData().
+         */
+        std::size_t dataSize() const { return _data.size(); }
+
+        /**
+         * @brief Reserve memory
+         * @return Reference to self (for method chaining)
+         *
+         * Reserves memory for given count of commands and segments to avoid
+         * reallocations during recording.
+         */
+        CommandBuffer& reserve(std::size_t commandCount, std::size_t segmentCount);
+
+        /**
+         * @brief Clear the buffer
+         * @return Reference to self (for method chaining)
+         *
+         * Removes all recorded commands, segments and data, but keeps the
+         * allocated memory for recording the next frame.
+         */
+        CommandBuffer& clear();
+
+        /**
+         * @brief Begin a new segment
+         * @return Reference to self (for method chaining)
+         *
+         * All subsequent commands are part of the new segment until next call
+         * to this function. See @ref CommandBuffer-sorting for more
+         * information.
+         */
+        CommandBuffer& begin(UnsignedLong sortKey);
+
+        /**
+         * @brief Record framebuffer binding
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref AbstractFramebuffer::bind()
+         */
+        CommandBuffer& bindFramebuffer(AbstractFramebuffer& framebuffer);
+
+        /**
+         * @brief Record texture binding
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref AbstractTexture::bind()
+         */
+        CommandBuffer& bindTexture(Int textureUnit, AbstractTexture& texture);
+
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Record indexed buffer range binding
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref Buffer::bind(Target, UnsignedInt, GLintptr, GLsizeiptr)
+         * @requires_gl30 Extension @extension{EXT,transform_feedback}
+         * @requires_gl31 Extension @extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Transform feedback and uniform buffers are not
+         *      available in OpenGL ES 2.0.
+         * @requires_webgl20 Transform feedback and uniform buffers are not
+         *      available in WebGL 1.0.
+         */
+        CommandBuffer& bindBuffer(Buffer::Target target, UnsignedInt index, Buffer& buffer, GLintptr offset, GLsizeiptr size);
+        #endif
+
+        /**
+         * @brief Record buffer data update
+         * @return Reference to self (for method chaining)
+         *
+         * The @p data are copied into the command buffer. Useful for updating
+         * uniform buffers with per-draw data.
+         * @see @ref Buffer::setSubData()
+         */
+        CommandBuffer& setBufferSubData(Buffer& buffer, GLintptr offset, Containers::ArrayView<const void> data);
+
+        /**
+         * @brief Record renderer state change
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref Renderer::apply()
+         */
+        CommandBuffer& applyState(const Renderer::StateBlock& state);
+
+        /**
+         * @brief Record mesh draw
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref Mesh::draw(AbstractShaderProgram&)
+         */
+        CommandBuffer& draw(Mesh& mesh, AbstractShaderProgram& shader);
+
+        /**
+         * @brief Record mesh view draw
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref MeshView::draw(AbstractShaderProgram&)
+         */
+        CommandBuffer& draw(MeshView& mesh, AbstractShaderProgram& shader);
+
+        /**
+         * @brief Record draw packet submission
+         * @return Reference to self (for method chaining)
+         *
+         * Consecutive packets are submitted the same way as with
+         * @ref DrawPacket::submit(Containers::ArrayView<const DrawPacket>),
+         * skipping uniform buffer bindings that are the same as in the
+         * previous packet.
+         * @see @ref DrawPacket::sortKey()
+         */
+        CommandBuffer& draw(const DrawPacket& packet);
+
+        /**
+         * @brief Sort the segments
+         * @return Reference to self (for method chaining)
+         *
+         * Stable-sorts the segments by their key. See
+         * @ref CommandBuffer-sorting for more information.
+         */
+        CommandBuffer& sort();
+
+        /**
+         * @brief Replay the commands
+         *
+         * Executes all recorded commands in the segment order. Has to be
+         * called on the thread with current OpenGL context. The buffer is
+         * left untouched, so it can be replayed any number of times.
+         */
+        void replay() const;
+
+        /**
+         * @brief Replay multiple command buffers
+         *
+         * Merges segments of all @p buffers, stable-sorts them by their key
+         * and executes them. Segments with equal keys are executed in the
+         * order of @p buffers.
+         */
+        static void replay(std::initializer_list<std::reference_wrapper<const CommandBuffer>> buffers);
+
+        /** @overload */
+        static void replay(Containers::ArrayView<const std::reference_wrapper<const CommandBuffer>> buffers);
+
+    private:
+        enum class CommandType: UnsignedByte {
+            BindFramebuffer,
+            BindTexture,
+            #ifndef MAGNUM_TARGET_GLES2
+            BindBuffer,
+            #endif
+            SetBufferSubData,
+            ApplyState,
+            DrawMesh,
+            DrawMeshView,
+            SubmitDrawPacket
+        };
+
+        struct Command {
+            CommandType type;
+            /* Texture unit or buffer binding index */
+            UnsignedInt index;
+            /* Buffer binding target */
+            GLenum target;
+            void* object;
+            /* Shader for draws, unused otherwise */
+            AbstractShaderProgram* shader;
+            /* Buffer offset and size of the bound range or updated data */
+            GLintptr offset;
+            GLsizeiptr size;
+            /* Offset of copied data for buffer updates */
+            std::size_t dataOffset;
+        };
+
+        struct Segment {
+            UnsignedLong sortKey;
+            std::size_t begin, end;
+        };
+
+        Command& addCommand(CommandType type);
+        void replaySegment(const Segment& segment) const;
+
+        std::vector<Command> _commands;
+        std::vector<Segment> _segments;
+        std::vector<char> _data;
+};
+
+}
+
+#endif
@@ -31,9 +31,11 @@
 #include <iostream> /* for initialization log redirection */
 #include <string>
 #include <unordered_map>
+#include <Corrade/Containers/ArrayView.h>
 #include <Corrade/Containers/EnumSet.hpp>
 #include <Corrade/Utility/Arguments.h>
 #include <Corrade/Utility/Debug.h>
+#include <Corrade/Utility/Directory.h>
 #include <Corrade/Utility/String.h>
 
 #include "Magnum/AbstractFramebuffer.h"
@@ -44,8 +46,10 @@
 #include "Magnum/BufferTexture.h"
 #endif
 #include "Magnum/DefaultFramebuffer.h"
+#include "Magnum/DeletionQueue.h"
 #include "Magnum/Extensions.h"
 #include "Magnum/Framebuffer.h"
+#include "Magnum/MemoryTracker.h"
 #include "Magnum/Mesh.h"
 #include "Magnum/Renderbuffer.h"
 #include "Magnum/Renderer.h"
@@ -84,6 +88,7 @@ const std::vector<Extension>& Extension::extensions(Version version) {
         _extension(GL,ARB,sparse_buffer),
         _extension(GL,ARB,ES3_2_compatibility),
         _extension(GL,ATI,texture_mirror_once),
+        _extension(GL,ATI,meminfo),
         _extension(GL,EXT,texture_filter_anisotropic),
         _extension(GL,EXT,texture_compression_s3tc),
         _extension(GL,EXT,texture_mirror_clamp),
@@ -96,7 +101,9 @@ const std::vector<Extension>& Extension::extensions(Version version) {
         _extension(GL,KHR,texture_compression_astc_ldr),
         _extension(GL,KHR,texture_compression_astc_hdr),
         _extension(GL,KHR,blend_equation_advanced),
-        _extension(GL,KHR,blend_equation_advanced_coherent)};
+        _extension(GL,KHR,blend_equation_advanced_coherent),
+        _extension(GL,KHR,parallel_shader_compile),
+        _extension(GL,NVX,gpu_memory_info)};
     static const std::vector<Extension> extensions300{
         _extension(GL,ARB,map_buffer_range),
         _extension(GL,ARB,color_buffer_float),
@@ -293,6 +300,7 @@ const std::vector<Extension>& Extension::extensions(Version version) {
         _extension(GL,KHR,blend_equation_advanced_coherent),
         _extension(GL,KHR,context_flush_control),
         _extension(GL,KHR,no_error),
+        _extension(GL,KHR,parallel_shader_compile),
         _extension(GL,NV,read_buffer_front),
         _extension(GL,NV,read_depth),
         _extension(GL,NV,read_stencil),
@@ -450,18 +458,27 @@ Context& Context::current() {
     return *currentContext;
 }
 
+void Context::makeCurrent(Context* const context) {
+    currentContext = context;
+}
+
 Context::Context(NoCreateT, Int argc, const char** argv, void functionLoader()): _functionLoader{functionLoader}, _version{Version::None} {
     /* Parse arguments */
     Utility::Arguments args{"magnum"};
     args.addOption("disable-workarounds")
         .setHelp("disable-workarounds", "driver workarounds to disable\n      (see http://doc.magnum.graphics/magnum/opengl-workarounds.html for detailed info)", "LIST")
         .addOption("disable-extensions").setHelp("disable-extensions", "OpenGL extensions to disable", "LIST")
+        .addOption("context-cache").setHelp("context-cache", "file to cache detected extensions in", "FILE")
         .addOption("log", "default").setHelp("log", "Console logging", "default|quiet")
         .setFromEnvironment("disable-workarounds")
         .setFromEnvironment("disable-extensions")
+        .setFromEnvironment("context-cache")
         .setFromEnvironment("log")
         .parse(argc, argv);
 
+    /* File to cache the extension list in */
+    _contextCache = args.value("context-cache");
+
     /* Decide whether to display initialization log */
     _displayInitializationLog = !(args.value("log") == "quiet" || args.value("log") == "QUIET");
 
@@ -482,6 +499,9 @@ Context::Context(Context&& other): _version{other._version},
     _extensionStatus{other._extensionStatus},
     _supportedExtensions{std::move(other._supportedExtensions)},
     _state{other._state},
+    #ifdef MAGNUM_BUILD_STATISTICS
+    _statistics(other._statistics),
+    #endif
     _detectedDrivers{std::move(other._detectedDrivers)}
 {
     other._state = nullptr;
@@ -489,6 +509,10 @@ Context::Context(Context&& other): _version{other._version},
 }
 
 Context::~Context() {
+    /* Delete objects that are still queued, the GL functions can be called
+       only if this context is current */
+    if(_state && currentContext == this) _state->deletionQueue->flush();
+
     delete _state;
 
     if(currentContext == this) currentContext = nullptr;
@@ -648,19 +672,25 @@ bool Context::tryCreate() {
         for(const Extension& extension: Extension::extensions(versions[i]))
             _extensionStatus.set(extension.index());
 
-    /* List of extensions from future versions (extensions from current and
-       previous versions should be supported automatically, so we don't need
-       to check for them) */
-    std::unordered_map<std::string, Extension> futureExtensions;
-    for(std::size_t i = future; i != versions.size(); ++i)
-        for(const Extension& extension: Extension::extensions(versions[i]))
-            futureExtensions.emplace(extension.string(), extension);
-
-    /* Check for presence of future and vendor extensions */
-    const std::vector<std::string> extensions = extensionStrings();
+    /* Hashmap of all known extensions for fast lookup. It doesn't depend on
+       the context so it's built only once and then shared by all contexts
+       created in the process. */
+    static const std::unordered_map<std::string, Extension> allExtensions = [&versions]() {
+        std::unordered_map<std::string, Extension> allExtensions;
+        for(const auto version: versions)
+            for(const Extension& extension: Extension::extensions(version))
+                allExtensions.emplace(extension.string(), extension);
+        return allExtensions;
+    }();
+
+    /* Check for presence of future and vendor extensions. Extensions from
+       current and previous versions are already marked as supported, so we
+       don't need to check for them. */
+    const std::vector<std::string> extensions = _contextCache.empty() ?
+        extensionStrings() : cachedExtensionStrings();
     for(const std::string& extension: extensions) {
-        const auto found = futureExtensions.find(extension);
-        if(found != futureExtensions.end()) {
+        const auto found = allExtensions.find(extension);
+        if(found != allExtensions.end() && !_extensionStatus[found->second.index()]) {
             _supportedExtensions.push_back(found->second);
             _extensionStatus.set(found->second.index());
         }
@@ -694,12 +724,6 @@ bool Context::tryCreate() {
     if(!_disabledExtensions.empty()) {
         Debug{output} << "Disabling extensions:";
 
-        /* Put remaining extensions into the hashmap for faster lookup */
-        std::unordered_map<std::string, Extension> allExtensions{std::move(futureExtensions)};
-        for(std::size_t i = 0; i != future; ++i)
-            for(const Extension& extension: Extension::extensions(versions[i]))
-                allExtensions.emplace(extension.string(), extension);
-
         /* Disable extensions that are known and supported and print a message
            for each */
         for(auto&& extension: _disabledExtensions) {
@@ -730,6 +754,32 @@ bool Context::tryCreate() {
     return true;
 }
 
+std::vector<std::string> Context::cachedExtensionStrings() const {
+    /* The cache is valid only for the same driver, so it's keyed with vendor,
+       renderer and version string */
+    const std::string key = vendorString() + '\n' + rendererString() + '\n' + versionString() + '\n';
+
+    /* Cache exists and matches the driver, use it */
+    if(Utility::Directory::fileExists(_contextCache)) {
+        const std::string data = Utility::Directory::readString(_contextCache);
+        if(data.size() >= key.size() && data.compare(0, key.size(), key) == 0)
+            return Utility::String::splitWithoutEmptyParts(data.substr(key.size()), '\n');
+    }
+
+    /* Otherwise query the extensions and (re)create the cache. Failure to
+       write it is not fatal, the detection just happens again next time. */
+    std::vector<std::string> extensions = extensionStrings();
+    std::string data = key;
+    for(const std::string& extension: extensions) {
+        data += extension;
+        data += '\n';
+    }
+    if(!Utility::Directory::write(_contextCache, Containers::ArrayView<const void>{data.data(), data.size()}))
+        Warning() << "Context: cannot write extension cache to" << _contextCache;
+
+    return extensions;
+}
+
 std::string Context::vendorString() const {
     return Utility::String::fromArray(reinterpret_cast<const char*>(glGetString(GL_VENDOR)));
 }
@@ -852,6 +902,14 @@ Version Context::supportedVersion(std::initializer_list<Version> versions) const
     #endif
 }
 
+MemoryTracker& Context::memoryTracker() {
+    return *_state->memoryTracker;
+}
+
+DeletionQueue& Context::deletionQueue() {
+    return *_state->deletionQueue;
+}
+
 void Context::resetState(const States states) {
     if(states & State::Buffers)
         _state->buffer->reset();
@@ -867,7 +925,8 @@ void Context::resetState(const States states) {
         _state->renderer->packPixelStorage.reset();
     }
 
-    /* Nothing to reset for renderer yet */
+    if(states & State::Renderer)
+        _state->renderer->reset();
 
     if(states & State::Shaders) {
         /* Nothing to reset for shaders */
@@ -116,7 +116,8 @@ class. Usage:
 
 @code{.sh}
 <application> [--magnum-help] [--magnum-disable-workarounds LIST]
-              [--magnum-disable-extensions LIST] ...
+              [--magnum-disable-extensions LIST] [--magnum-context-cache FILE]
+              ...
 @endcode
 
 Arguments:
@@ -127,11 +128,32 @@ Arguments:
     @ref opengl-workarounds for detailed info) (environment: `MAGNUM_DISABLE_WORKAROUNDS`)
 -   `--magnum-disable-extensions LIST` --- OpenGL extensions to disable
     (environment: `MAGNUM_DISABLE_EXTENSIONS`)
+-   `--magnum-context-cache FILE` --- file to cache the list of driver
+    extensions in (environment: `MAGNUM_CONTEXT_CACHE`). See
+    @ref Context-extension-cache for more information.
 
 Note that all options are prefixed with `--magnum-` to avoid conflicts with
 options passed to the application itself. Options that don't have this prefix
 are completely ignored, see documentation of the
 @ref Utility-Arguments-delegating "Utility::Arguments" class for details.
+
+@subsection Context-extension-cache Extension cache
+
+On drivers exposing several hundreds of extensions, querying all extension
+strings is a significant part of context creation, which is apparent mainly
+with many short-lived processes such as batch renderers. If the
+`--magnum-context-cache` option is set, the list of extension strings is saved
+to given file on first run and subsequent runs read it from there instead of
+querying the driver. The file is keyed with @ref vendorString(),
+@ref rendererString() and @ref versionString(), so it gets automatically
+recreated after a driver update or when run on different hardware:
+
+@code{.sh}
+MAGNUM_CONTEXT_CACHE=/tmp/magnum-context-cache ./my-batch-renderer
+@endcode
+
+The lookup of known extensions is done through a hashmap that's built only
+once per process and shared by all created contexts.
 */
 class MAGNUM_EXPORT Context {
     public:
@@ -362,10 +384,26 @@ class MAGNUM_EXPORT Context {
          * Expect that there is current context. If Magnum is built with
          * @ref MAGNUM_BUILD_MULTITHREADED, current context is thread-local
          * instead of global (the default).
-         * @see @ref hasCurrent()
+         * @see @ref hasCurrent(), @ref makeCurrent()
          */
         static Context& current();
 
+        /**
+         * @brief Make a context current
+         *
+         * Sets @p context as the current context, making @ref current()
+         * return it and all OpenGL wrappers use its state tracker. Passing
+         * @cpp nullptr @ce makes no context current. This function doesn't
+         * make the underlying OpenGL context current, that has to be done
+         * through the windowing toolkit before. Useful when switching
+         * between more contexts on a single thread; if Magnum is built with
+         * @ref MAGNUM_BUILD_MULTITHREADED, each thread has its own current
+         * context, so contexts living on worker threads don't need to be
+         * switched. See @ref platform-windowless-contexts-shared for more
+         * information.
+         */
+        static void makeCurrent(Context* context);
+
         /** @brief Copying is not allowed */
         Context(const Context&) = delete;
 
@@ -617,11 +655,82 @@ class MAGNUM_EXPORT Context {
          */
         DetectedDrivers detectedDriver();
 
+        /**
+         * @brief GPU memory allocation tracker
+         *
+         * Tracks memory allocated by buffers, textures and renderbuffers
+         * created in this context. See @ref MemoryTracker for more
+         * information.
+         */
+        MemoryTracker& memoryTracker();
+
+        /**
+         * @brief Deferred object deletion queue
+         *
+         * Accepts buffers, textures and meshes from any thread and deletes
+         * them on the context thread once the GPU is done with them. See
+         * @ref DeletionQueue for more information.
+         */
+        DeletionQueue& deletionQueue();
+
+        #ifdef MAGNUM_BUILD_STATISTICS
+        /**
+         * @brief Call and state change statistics
+         *
+         * Counts of GL calls and state changes that actually reached the
+         * driver, i.e. excluding the ones skipped by the state tracker.
+         * Accumulated since context creation or since the last call to
+         * @ref resetStatistics(), usually once per frame.
+         * @see @ref statistics()
+         */
+        struct Statistics {
+            /**
+             * Draw calls. Multi-draw and indirect draw calls are counted as
+             * one.
+             */
+            UnsignedLong drawCallCount;
+
+            /** Shader program switches */
+            UnsignedLong programSwitchCount;
+
+            /**
+             * Texture binds, counting each texture unit with a changed
+             * binding
+             */
+            UnsignedLong textureBindCount;
+
+            /** Bytes uploaded through buffer data and buffer storage setup */
+            UnsignedLong bufferUploadSize;
+
+            /** Framebuffer binds */
+            UnsignedLong framebufferBindCount;
+        };
+
+        /**
+         * @brief Call and state change statistics
+         *
+         * Available only if Magnum is built with the `BUILD_STATISTICS`
+         * CMake option, otherwise the counting has no overhead at all.
+         * @see @ref MAGNUM_BUILD_STATISTICS, @ref building
+         */
+        const Statistics& statistics() const { return _statistics; }
+
+        /**
+         * @brief Reset call and state change statistics
+         *
+         * Sets all counters in @ref statistics() to zero.
+         */
+        void resetStatistics() { _statistics = Statistics{}; }
+        #endif
+
     #ifdef DOXYGEN_GENERATING_OUTPUT
     private:
     #endif
         bool isDriverWorkaroundDisabled(const std::string& workaround);
         Implementation::State& state() { return *_state; }
+        #ifdef MAGNUM_BUILD_STATISTICS
+        Statistics& statisticsInternal() { return _statistics; }
+        #endif
 
         /* This function is called from MeshState constructor, which means the
            state() pointer is not ready yet so we have to pass it directly */
@@ -638,6 +747,7 @@ class MAGNUM_EXPORT Context {
         bool tryCreate();
         void create();
         void disableDriverWorkaround(const std::string& workaround);
+        std::vector<std::string> cachedExtensionStrings() const;
 
         /* Defined in Implementation/driverSpecific.cpp */
         MAGNUM_LOCAL void setupDriverWorkarounds();
@@ -658,12 +768,16 @@ class MAGNUM_EXPORT Context {
         std::vector<Extension> _supportedExtensions;
 
         Implementation::State* _state;
+        #ifdef MAGNUM_BUILD_STATISTICS
+        Statistics _statistics{};
+        #endif
 
         Containers::Optional<DetectedDrivers> _detectedDrivers;
 
         /* True means known and disabled, false means known */
         std::vector<std::pair<std::string, bool>> _driverWorkarounds;
         std::vector<std::string> _disabledExtensions;
+        std::string _contextCache;
         bool _displayInitializationLog;
 };
 
@@ -671,6 +785,7 @@ class MAGNUM_EXPORT Context {
 CORRADE_ENUMSET_OPERATORS(Context::Flags)
 #endif
 CORRADE_ENUMSET_OPERATORS(Context::DetectedDrivers)
+CORRADE_ENUMSET_OPERATORS(Context::States)
 
 #ifndef MAGNUM_TARGET_WEBGL
 /** @debugoperatorclassenum{Magnum::Context,Magnum::Context::Flag} */
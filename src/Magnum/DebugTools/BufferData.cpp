@@ -34,5 +34,30 @@ void bufferSubData(Buffer& buffer, GLintptr offset, GLsizeiptr size, void* outpu
     buffer.unmap();
 }
 
-}}}
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+AsyncBufferData::AsyncBufferData(Buffer& buffer, const GLintptr offset, const GLsizeiptr size): _size(size) {
+    if(!size) return;
+
+    _staging.setData({nullptr, _size}, BufferUsage::StreamRead);
+    Buffer::copy(buffer, _staging, offset, 0, size);
+    _fence.insert();
+}
+
+bool AsyncBufferData::isReady() {
+    return _fence.isSignaled();
+}
+
+void AsyncBufferData::wait() {
+    while(_fence.clientWait(std::chrono::seconds{1}) == Fence::WaitResult::TimeoutExpired);
+}
+
+void AsyncBufferData::dataInto(void* const output) {
+    wait();
+    Implementation::bufferSubData(_staging, 0, _size, output);
+}
+#endif
+
+}}
 #endif
@@ -27,7 +27,7 @@
 
 #ifndef MAGNUM_TARGET_WEBGL
 /** @file
- * @brief Function @ref Magnum::DebugTools::bufferData(), @ref Magnum::DebugTools::bufferSubData()
+ * @brief Function @ref Magnum::DebugTools::bufferData(), @ref Magnum::DebugTools::bufferSubData(), @ref Magnum::DebugTools::bufferDataAsync(), @ref Magnum::DebugTools::bufferSubDataAsync(), class @ref Magnum::DebugTools::AsyncBufferData
  */
 #endif
 
@@ -36,6 +36,10 @@
 #include "Magnum/Buffer.h"
 #include "Magnum/DebugTools/visibility.h"
 
+#ifndef MAGNUM_TARGET_GLES2
+#include "Magnum/Fence.h"
+#endif
+
 #ifndef MAGNUM_TARGET_WEBGL
 namespace Magnum { namespace DebugTools {
 
@@ -73,6 +77,117 @@ template<class T = char> Containers::Array<T> inline bufferData(Buffer& buffer)
     return bufferSubData<T>(buffer, 0, bufferSize/sizeof(T));
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+/**
+@brief Asynchronous buffer data readback
+
+Handle returned by @ref bufferSubDataAsync() and @ref bufferDataAsync(). The
+data are copied on the GPU into a staging buffer and a @ref Fence is inserted
+after the copy, so neither the creation nor @ref isReady() block. Retrieving
+the data with @ref data() only maps the staging buffer, waiting for the fence
+first if the copy isn't finished yet:
+
+@code{.cpp}
+DebugTools::AsyncBufferData readback = DebugTools::bufferDataAsync(buffer);
+
+// ... submit other work, poll readback.isReady() in later frames
+
+Containers::Array<Int> data = readback.data<Int>();
+@endcode
+
+@requires_gl31 Extension @extension{ARB,copy_buffer}
+@requires_gl32 Extension @extension{ARB,sync}
+@requires_gles30 Buffer copying and sync objects are not available in OpenGL
+    ES 2.0.
+@requires_gles Buffer mapping is not available in WebGL.
+*/
+class MAGNUM_DEBUGTOOLS_EXPORT AsyncBufferData {
+    public:
+        /**
+         * @brief Constructor
+         * @param buffer    Buffer to read from
+         * @param offset    Offset in the buffer, in bytes
+         * @param size      Data size, in bytes
+         *
+         * Allocates a staging buffer of @p size bytes, copies the data into
+         * it using @ref Buffer::copy() and inserts a fence. Doesn't block.
+         */
+        explicit AsyncBufferData(Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /** @brief Data size in bytes */
+        std::size_t size() const { return _size; }
+
+        /**
+         * @brief Whether the data are ready
+         *
+         * Polls the fence, doesn't block.
+         * @see @ref Fence::isSignaled()
+         */
+        bool isReady();
+
+        /**
+         * @brief Wait until the data are ready
+         *
+         * Blocks until the fence is signaled. Called implicitly by
+         * @ref data().
+         * @see @ref Fence::clientWait()
+         */
+        void wait();
+
+        /**
+         * @brief Retrieve the data
+         *
+         * Calls @ref wait() and then copies the staging buffer contents to
+         * client memory. Expects that @ref size() is divisible by size of
+         * @p T. Can be called more than once.
+         */
+        template<class T = char> Containers::Array<T> data() {
+            CORRADE_ASSERT(_size%sizeof(T) == 0, "DebugTools::AsyncBufferData::data(): the data size is" << _size << "bytes, which can't be expressed as array of types with size" << sizeof(T), nullptr);
+            Containers::Array<T> out{_size/sizeof(T)};
+            if(_size) dataInto(out);
+            return out;
+        }
+
+    private:
+        void dataInto(void* output);
+
+        Buffer _staging;
+        Fence _fence;
+        std::size_t _size;
+};
+
+/**
+@brief Asynchronous buffer subdata
+
+Non-blocking alternative to @ref bufferSubData(), see @ref AsyncBufferData for
+more information. The @p offset is in bytes, @p size is in count of @p T
+elements.
+@requires_gl31 Extension @extension{ARB,copy_buffer}
+@requires_gl32 Extension @extension{ARB,sync}
+@requires_gles30 Buffer copying and sync objects are not available in OpenGL
+    ES 2.0.
+@requires_gles Buffer mapping is not available in WebGL.
+*/
+template<class T = char> inline AsyncBufferData bufferSubDataAsync(Buffer& buffer, GLintptr offset, GLsizeiptr size) {
+    return AsyncBufferData{buffer, offset, GLsizeiptr(size*sizeof(T))};
+}
+
+/**
+@brief Asynchronous buffer data
+
+Non-blocking alternative to @ref bufferData(), see @ref AsyncBufferData for
+more information.
+@requires_gl31 Extension @extension{ARB,copy_buffer}
+@requires_gl32 Extension @extension{ARB,sync}
+@requires_gles30 Buffer copying and sync objects are not available in OpenGL
+    ES 2.0.
+@requires_gles Buffer mapping is not available in WebGL.
+*/
+inline AsyncBufferData bufferDataAsync(Buffer& buffer) {
+    return AsyncBufferData{buffer, 0, buffer.size()};
+}
+#endif
+
 }}
 #else
 #error this header is not available in WebGL build
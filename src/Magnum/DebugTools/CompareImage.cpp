@@ -25,12 +25,14 @@
 
 #include "CompareImage.h"
 
+#include <atomic>
 #include <map>
 #include <sstream>
 #include <vector>
 
 #include "Magnum/ImageView.h"
 #include "Magnum/PixelFormat.h"
+#include "Magnum/ThreadPool.h"
 #include "Magnum/Math/Functions.h"
 #include "Magnum/Math/Color.h"
 #include "Magnum/Math/Algorithms/KahanSum.h"
@@ -183,6 +185,149 @@ std::tuple<std::vector<Float>, Float, Float> calculateImageDelta(const ImageView
     return std::make_tuple(delta, max, mean);
 }
 
+namespace {
+
+std::size_t pixelChannelCount(const PixelFormat format) {
+    if(
+        #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+        format == PixelFormat::Red
+        #endif
+        #ifndef MAGNUM_TARGET_GLES2
+        || format == PixelFormat::RedInteger
+        #else
+        #ifndef MAGNUM_TARGET_WEBGL
+        ||
+        #endif
+        format == PixelFormat::Luminance
+        #endif
+        )
+        return 1;
+    else if(
+        #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+        format == PixelFormat::RG
+        #endif
+        #ifndef MAGNUM_TARGET_GLES2
+        || format == PixelFormat::RGInteger
+        #else
+        #ifndef MAGNUM_TARGET_WEBGL
+        ||
+        #endif
+        format == PixelFormat::LuminanceAlpha
+        #endif
+        )
+        return 2;
+    else if(format == PixelFormat::RGB
+        #ifndef MAGNUM_TARGET_GLES2
+        || format == PixelFormat::RGBInteger
+        #endif
+        )
+        return 3;
+    else if(format == PixelFormat::RGBA
+        #ifndef MAGNUM_TARGET_GLES2
+        || format == PixelFormat::RGBAInteger
+        #endif
+        )
+        return 4;
+
+    CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+template<std::size_t size, class T> bool isImageDeltaWithinThresholds(const ImageView2D& actual, const ImageView2D& expected, const Float maxThreshold, const Float meanThreshold, ThreadPool* const pool) {
+    /* Precalculate parameters for pixel access */
+    Math::Vector2<std::size_t> dataOffset, dataSize;
+
+    std::tie(dataOffset, dataSize, std::ignore) = actual.dataProperties();
+    const char* const actualPixels = actual.data() + dataOffset.sum();
+    const std::size_t actualStride = dataSize.x();
+
+    std::tie(dataOffset, dataSize, std::ignore) = expected.dataProperties();
+    const char* const expectedPixels = expected.data() + dataOffset.sum();
+    const std::size_t expectedStride = dataSize.x();
+
+    const std::size_t width = expected.size().x();
+    const std::size_t height = expected.size().y();
+
+    /* Each row has its own sum so the threads don't need to synchronize.
+       Summing in doubles to not lose precision on large images -- that would
+       result in having false negatives. */
+    std::vector<Double> rowSums(height);
+    std::atomic<bool> aboveMaxThreshold{false};
+    const auto job = [&](const std::size_t begin, const std::size_t end) {
+        for(std::size_t y = begin; y != end; ++y) {
+            /* Some other row is already above the threshold, the comparison
+               fails anyway */
+            if(aboveMaxThreshold.load(std::memory_order_relaxed)) return;
+
+            /* Plain loops over contiguous channel data without any
+               indirection, so the compiler is able to vectorize them */
+            const T* const actualRow = reinterpret_cast<const T*>(actualPixels + actualStride*y);
+            const T* const expectedRow = reinterpret_cast<const T*>(expectedPixels + expectedStride*y);
+            Float rowMax{};
+            Double rowSum{};
+            for(std::size_t x = 0; x != width; ++x) {
+                Float value{};
+                for(std::size_t c = 0; c != size; ++c)
+                    value += Math::abs(Float(actualRow[x*size + c]) - Float(expectedRow[x*size + c]));
+                value /= size;
+                rowMax = Math::max(rowMax, value);
+                rowSum += value;
+            }
+
+            if(rowMax > maxThreshold) {
+                aboveMaxThreshold.store(true, std::memory_order_relaxed);
+                return;
+            }
+
+            rowSums[y] = rowSum;
+        }
+    };
+
+    /* Chunks of roughly 64k pixels */
+    const std::size_t chunkSize = Math::max(std::size_t{65536}/Math::max(width, std::size_t{1}), std::size_t{1});
+    if(pool && height) pool->parallelFor(height, chunkSize, job);
+    else job(0, height);
+
+    if(aboveMaxThreshold) return false;
+
+    Double sum{};
+    for(const Double rowSum: rowSums) sum += rowSum;
+    return !(Float(sum/(width*height)) > meanThreshold);
+}
+
+template<class T> bool isImageDeltaWithinThresholds(const ImageView2D& actual, const ImageView2D& expected, const Float maxThreshold, const Float meanThreshold, ThreadPool* const pool) {
+    switch(pixelChannelCount(expected.format())) {
+        case 1: return isImageDeltaWithinThresholds<1, T>(actual, expected, maxThreshold, meanThreshold, pool);
+        case 2: return isImageDeltaWithinThresholds<2, T>(actual, expected, maxThreshold, meanThreshold, pool);
+        case 3: return isImageDeltaWithinThresholds<3, T>(actual, expected, maxThreshold, meanThreshold, pool);
+        case 4: return isImageDeltaWithinThresholds<4, T>(actual, expected, maxThreshold, meanThreshold, pool);
+    }
+
+    CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+}
+
+bool isImageDeltaWithinThresholds(const ImageView2D& actual, const ImageView2D& expected, const Float maxThreshold, const Float meanThreshold, ThreadPool* const pool) {
+    if(expected.type() == PixelType::UnsignedByte)
+        return isImageDeltaWithinThresholds<UnsignedByte>(actual, expected, maxThreshold, meanThreshold, pool);
+    else if(expected.type() == PixelType::UnsignedShort)
+        return isImageDeltaWithinThresholds<UnsignedShort>(actual, expected, maxThreshold, meanThreshold, pool);
+    else if(expected.type() == PixelType::UnsignedInt)
+        return isImageDeltaWithinThresholds<UnsignedInt>(actual, expected, maxThreshold, meanThreshold, pool);
+    #ifndef MAGNUM_TARGET_GLES2
+    else if(expected.type() == PixelType::Byte)
+        return isImageDeltaWithinThresholds<Byte>(actual, expected, maxThreshold, meanThreshold, pool);
+    else if(expected.type() == PixelType::Short)
+        return isImageDeltaWithinThresholds<Short>(actual, expected, maxThreshold, meanThreshold, pool);
+    else if(expected.type() == PixelType::Int)
+        return isImageDeltaWithinThresholds<Int>(actual, expected, maxThreshold, meanThreshold, pool);
+    #endif
+    else if(expected.type() == PixelType::Float)
+        return isImageDeltaWithinThresholds<Float>(actual, expected, maxThreshold, meanThreshold, pool);
+
+    CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
 namespace {
     /* Done by printing an white to black gradient using one of the online
        ASCII converters. Yes, I'm lazy. Another one could be " .,:;ox%#@". */
@@ -384,7 +529,7 @@ namespace Corrade { namespace TestSuite {
 
 using namespace Magnum;
 
-Comparator<DebugTools::CompareImage>::Comparator(Float maxThreshold, Float meanThreshold): _maxThreshold{maxThreshold}, _meanThreshold{meanThreshold} {
+Comparator<DebugTools::CompareImage>::Comparator(Float maxThreshold, Float meanThreshold, ThreadPool* pool): _maxThreshold{maxThreshold}, _meanThreshold{meanThreshold}, _pool{pool} {
     CORRADE_ASSERT(meanThreshold <= maxThreshold,
         "DebugTools::CompareImage: maxThreshold can't be smaller than meanThreshold", );
 }
@@ -448,6 +593,13 @@ bool Comparator<DebugTools::CompareImage>::operator()(const ImageView2D& actual,
         "DebugTools::CompareImage: format" << expected.format() << Debug::nospace << "/" << expected.type() << "is not supported", {});
     #endif
 
+    /* Check the thresholds first without saving the per-pixel deltas,
+       possibly in parallel and bailing out as soon as any pixel is above the
+       max threshold. Only if the images differ, calculate the full delta
+       image for the diagnostic message. */
+    if(DebugTools::Implementation::isImageDeltaWithinThresholds(actual, expected, _maxThreshold, _meanThreshold, _pool))
+        return true;
+
     std::vector<Float> delta;
     std::tie(delta, _max, _mean) = DebugTools::Implementation::calculateImageDelta(actual, expected);
 
@@ -41,6 +41,8 @@ namespace Magnum { namespace DebugTools {
 namespace Implementation {
     MAGNUM_DEBUGTOOLS_EXPORT std::tuple<std::vector<Float>, Float, Float> calculateImageDelta(const ImageView2D& actual, const ImageView2D& expected);
 
+    MAGNUM_DEBUGTOOLS_EXPORT bool isImageDeltaWithinThresholds(const ImageView2D& actual, const ImageView2D& expected, Float maxThreshold, Float meanThreshold, ThreadPool* pool);
+
     MAGNUM_DEBUGTOOLS_EXPORT void printDeltaImage(Debug& out, const std::vector<Float>& delta, const Vector2i& size, Float max, Float maxThreshold, Float meanThreshold);
 
     MAGNUM_DEBUGTOOLS_EXPORT void printPixelDeltas(Debug& out, const std::vector<Float>& delta, const ImageView2D& actual, const ImageView2D& expected, Float maxThreshold, Float meanThreshold, std::size_t maxCount);
@@ -57,7 +59,7 @@ namespace Corrade { namespace TestSuite {
 
 template<> class MAGNUM_DEBUGTOOLS_EXPORT Comparator<Magnum::DebugTools::CompareImage> {
     public:
-        explicit Comparator(Magnum::Float maxThreshold, Magnum::Float meanThreshold);
+        explicit Comparator(Magnum::Float maxThreshold, Magnum::Float meanThreshold, Magnum::ThreadPool* pool = nullptr);
 
         /*implicit*/ Comparator(): Comparator{0.0f, 0.0f} {}
 
@@ -75,6 +77,7 @@ template<> class MAGNUM_DEBUGTOOLS_EXPORT Comparator<Magnum::DebugTools::Compare
         };
 
         Magnum::Float _maxThreshold, _meanThreshold;
+        Magnum::ThreadPool* _pool;
 
         State _state{};
         const Magnum::ImageView2D *_actualImage, *_expectedImage;
@@ -138,6 +141,31 @@ printed as characters of different perceived brightness. Blocks with delta over
 the max threshold are colored red, blocks with delta over the mean threshold
 are colored yellow. The delta list contains X,Y pixel position (with origin at
 bottom left), actual and expected pixel value and calculated delta.
+
+@section DebugTools-CompareImage-performance Performance
+
+The thresholds are first checked without storing any per-pixel data, stopping
+as soon as a pixel above the max threshold is found. Only if the comparison
+fails, the full delta image is calculated for the diagnostic output, so
+passing comparisons don't allocate anything proportional to the image size.
+For large image suites, pass a @ref ThreadPool to the
+@ref CompareImage(Float, Float, ThreadPool&) constructor to split the check
+by image rows among multiple threads. The pool can be shared by all
+comparisons in the test:
+
+@code{.cpp}
+struct RenderingTest: TestSuite::Tester {
+    // ...
+
+    ThreadPool pool;
+};
+
+void RenderingTest::scene() {
+    // ...
+
+    CORRADE_COMPARE_WITH(actual, expected, (DebugTools::CompareImage{1.5f, 0.01f, pool}));
+}
+@endcode
 */
 class CompareImage {
     public:
@@ -150,6 +178,21 @@ class CompareImage {
          */
         explicit CompareImage(Float maxThreshold, Float meanThreshold): _c{maxThreshold, meanThreshold} {}
 
+        /**
+         * @brief Construct with a thread pool
+         * @param maxThreshold  Max threshold. If any pixel has delta above
+         *      this value, this comparison fails
+         * @param meanThreshold Mean threshold. If mean delta over all pixels
+         *      is above this value, the comparison fails
+         * @param pool          Thread pool used for checking the thresholds
+         *
+         * Same as @ref CompareImage(Float, Float), but the thresholds are
+         * checked in parallel using @p pool. The result and the diagnostic
+         * output are the same. The pool is expected to be alive for the
+         * whole comparison.
+         */
+        explicit CompareImage(Float maxThreshold, Float meanThreshold, ThreadPool& pool): _c{maxThreshold, meanThreshold, &pool} {}
+
         /**
          * @brief Implicit constructor
          *
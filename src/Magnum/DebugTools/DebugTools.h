@@ -44,7 +44,17 @@ typedef ObjectRenderer<2> ObjectRenderer2D;
 typedef ObjectRenderer<3> ObjectRenderer3D;
 class ObjectRendererOptions;
 
+#ifndef MAGNUM_TARGET_WEBGL
+class FrameProfiler;
+#endif
+
+class PerformanceHud;
 class Profiler;
+
+template<UnsignedInt> class RendererBatch;
+typedef RendererBatch<2> RendererBatch2D;
+typedef RendererBatch<3> RendererBatch3D;
+
 class ResourceManager;
 
 template<UnsignedInt> class ShapeRenderer;
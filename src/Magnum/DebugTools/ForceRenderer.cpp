@@ -27,11 +27,14 @@
 
 #include "Magnum/Buffer.h"
 #include "Magnum/Mesh.h"
+#include "Magnum/DebugTools/RendererBatch.h"
 #include "Magnum/DebugTools/ResourceManager.h"
 #include "Magnum/SceneGraph/Camera.h"
 #include "Magnum/Shaders/Flat.h"
 
+#include "Implementation/ForceRendererMesh.h"
 #include "Implementation/ForceRendererTransformation.h"
+#include "Implementation/InstanceBuffer.h"
 
 namespace Magnum { namespace DebugTools {
 
@@ -56,26 +59,17 @@ constexpr std::array<UnsignedByte, 6> indices{{
 
 }
 
-template<UnsignedInt dimensions> ForceRenderer<dimensions>::ForceRenderer(SceneGraph::AbstractObject<dimensions, Float>& object, const VectorTypeFor<dimensions, Float>& forcePosition, const VectorTypeFor<dimensions, Float>& force, ResourceKey options, SceneGraph::DrawableGroup<dimensions, Float>* drawables): SceneGraph::Drawable<dimensions, Float>(object, drawables), _forcePosition(forcePosition), _force(force), _options(ResourceManager::instance().get<ForceRendererOptions>(options)) {
-    /* Shader */
-    _shader = ResourceManager::instance().get<AbstractShaderProgram, Shaders::Flat<dimensions>>(shaderKey<dimensions>());
-    if(!_shader) ResourceManager::instance().set<AbstractShaderProgram>(_shader.key(), new Shaders::Flat<dimensions>);
+namespace Implementation {
 
-    /* Mesh and vertex buffer */
-    _mesh = ResourceManager::instance().get<Mesh>("force");
-    _vertexBuffer = ResourceManager::instance().get<Buffer>("force-vertices");
-    _indexBuffer = ResourceManager::instance().get<Buffer>("force-indices");
-    if(_mesh) return;
-
-    /* Create the mesh */
+template<UnsignedInt dimensions> void createForceRendererMesh(Resource<Mesh>& meshResource, Resource<Buffer>& vertexBufferResource, Resource<Buffer>& indexBufferResource, Resource<Buffer>& instanceBufferResource) {
     Buffer* vertexBuffer = new Buffer{Buffer::TargetHint::Array};
     Buffer* indexBuffer = new Buffer{Buffer::TargetHint::ElementArray};
 
-    _vertexBuffer->setData(positions, BufferUsage::StaticDraw);
-    ResourceManager::instance().set(_vertexBuffer.key(), vertexBuffer, ResourceDataState::Final, ResourcePolicy::Manual);
+    vertexBuffer->setData(positions, BufferUsage::StaticDraw);
+    ResourceManager::instance().set(vertexBufferResource.key(), vertexBuffer, ResourceDataState::Final, ResourcePolicy::Manual);
 
-    _indexBuffer->setData(indices, BufferUsage::StaticDraw);
-    ResourceManager::instance().set(_indexBuffer.key(), indexBuffer, ResourceDataState::Final, ResourcePolicy::Manual);
+    indexBuffer->setData(indices, BufferUsage::StaticDraw);
+    ResourceManager::instance().set(indexBufferResource.key(), indexBuffer, ResourceDataState::Final, ResourcePolicy::Manual);
 
     Mesh* mesh = new Mesh;
     mesh->setPrimitive(MeshPrimitive::Lines)
@@ -83,14 +77,48 @@ template<UnsignedInt dimensions> ForceRenderer<dimensions>::ForceRenderer(SceneG
         .addVertexBuffer(*vertexBuffer, 0,
             typename Shaders::Flat<dimensions>::Position(Shaders::Flat<dimensions>::Position::Components::Two))
         .setIndexBuffer(*indexBuffer, 0, Mesh::IndexType::UnsignedByte, 0, positions.size());
-    ResourceManager::instance().set(_mesh.key(), mesh, ResourceDataState::Final, ResourcePolicy::Manual);
+    createInstanceBuffer<dimensions>(*mesh, instanceBufferResource);
+    ResourceManager::instance().set(meshResource.key(), mesh, ResourceDataState::Final, ResourcePolicy::Manual);
+}
+
+template void createForceRendererMesh<2>(Resource<Mesh>&, Resource<Buffer>&, Resource<Buffer>&, Resource<Buffer>&);
+template void createForceRendererMesh<3>(Resource<Mesh>&, Resource<Buffer>&, Resource<Buffer>&, Resource<Buffer>&);
+
+}
+
+template<UnsignedInt dimensions> ForceRenderer<dimensions>::ForceRenderer(SceneGraph::AbstractObject<dimensions, Float>& object, const VectorTypeFor<dimensions, Float>& forcePosition, const VectorTypeFor<dimensions, Float>& force, ResourceKey options, SceneGraph::DrawableGroup<dimensions, Float>* drawables): SceneGraph::Drawable<dimensions, Float>(object, drawables), _forcePosition(forcePosition), _force(force), _options(ResourceManager::instance().get<ForceRendererOptions>(options)), _batch{} {
+    /* Shader */
+    _shader = ResourceManager::instance().get<AbstractShaderProgram, Shaders::Flat<dimensions>>(shaderKey<dimensions>());
+    if(!_shader) ResourceManager::instance().set<AbstractShaderProgram>(_shader.key(), new Shaders::Flat<dimensions>);
+
+    createResources();
+}
+
+template<UnsignedInt dimensions> ForceRenderer<dimensions>::ForceRenderer(SceneGraph::AbstractObject<dimensions, Float>& object, const VectorTypeFor<dimensions, Float>& forcePosition, const VectorTypeFor<dimensions, Float>& force, ResourceKey options, RendererBatch<dimensions>& batch): SceneGraph::Drawable<dimensions, Float>(object, &batch), _forcePosition(forcePosition), _force(force), _options(ResourceManager::instance().get<ForceRendererOptions>(options)), _batch{&batch} {
+    /* The shader is owned by the batch */
+    createResources();
+}
+
+template<UnsignedInt dimensions> void ForceRenderer<dimensions>::createResources() {
+    _mesh = ResourceManager::instance().get<Mesh>(Implementation::ForceRendererMesh<dimensions>::mesh());
+    _vertexBuffer = ResourceManager::instance().get<Buffer>(Implementation::ForceRendererMesh<dimensions>::vertexBuffer());
+    _indexBuffer = ResourceManager::instance().get<Buffer>(Implementation::ForceRendererMesh<dimensions>::indexBuffer());
+    _instanceBuffer = ResourceManager::instance().get<Buffer>(Implementation::ForceRendererMesh<dimensions>::instanceBuffer());
+    if(!_mesh) Implementation::createForceRendererMesh<dimensions>(_mesh, _vertexBuffer, _indexBuffer, _instanceBuffer);
 }
 
 /* To avoid deleting pointers to incomplete type on destruction of Resource members */
 template<UnsignedInt dimensions> ForceRenderer<dimensions>::~ForceRenderer() = default;
 
 template<UnsignedInt dimensions> void ForceRenderer<dimensions>::draw(const MatrixTypeFor<dimensions, Float>& transformationMatrix, SceneGraph::Camera<dimensions, Float>& camera) {
-    _shader->setTransformationProjectionMatrix(camera.projectionMatrix()*Implementation::forceRendererTransformation<dimensions>(transformationMatrix.transformPoint(_forcePosition), _force)*MatrixTypeFor<dimensions, Float>::scaling(VectorTypeFor<dimensions, Float>{_options->scale()}))
+    const MatrixTypeFor<dimensions, Float> matrix = Implementation::forceRendererTransformation<dimensions>(transformationMatrix.transformPoint(_forcePosition), _force)*MatrixTypeFor<dimensions, Float>::scaling(VectorTypeFor<dimensions, Float>{_options->scale()});
+
+    if(_batch) {
+        _batch->add(*_mesh, _instanceBuffer, matrix, _options->color());
+        return;
+    }
+
+    _shader->setTransformationProjectionMatrix(camera.projectionMatrix()*matrix)
         .setColor(_options->color());
     _mesh->draw(*_shader);
 }
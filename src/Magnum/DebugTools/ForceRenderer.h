@@ -32,6 +32,7 @@
 #include "Magnum/Resource.h"
 #include "Magnum/Math/Color.h"
 #include "Magnum/SceneGraph/Drawable.h"
+#include "Magnum/DebugTools/DebugTools.h"
 #include "Magnum/Shaders/Shaders.h"
 #include "Magnum/DebugTools/visibility.h"
 
@@ -126,9 +127,26 @@ template<UnsignedInt dimensions> class MAGNUM_DEBUGTOOLS_EXPORT ForceRenderer: p
          */
         ForceRenderer(SceneGraph::AbstractObject<dimensions, Float>&, const VectorTypeFor<dimensions, Float>&, VectorTypeFor<dimensions, Float>&&, ResourceKey = ResourceKey(), SceneGraph::DrawableGroup<dimensions, Float>* = nullptr) = delete;
 
+        /**
+         * @brief Construct a batched renderer
+         *
+         * Like @ref ForceRenderer(SceneGraph::AbstractObject<dimensions, Float>&, const VectorTypeFor<dimensions, Float>&, const VectorTypeFor<dimensions, Float>&, ResourceKey, SceneGraph::DrawableGroup<dimensions, Float>*),
+         * but the arrow is drawn as a part of @p batch. See
+         * @ref RendererBatch for more information.
+         */
+        explicit ForceRenderer(SceneGraph::AbstractObject<dimensions, Float>& object, const VectorTypeFor<dimensions, Float>& forcePosition, const VectorTypeFor<dimensions, Float>& force, ResourceKey options, RendererBatch<dimensions>& batch);
+
+        /**
+         * You have to pass reference to existing force instance, as the
+         * renderer uses the current value when rendering.
+         */
+        ForceRenderer(SceneGraph::AbstractObject<dimensions, Float>&, const VectorTypeFor<dimensions, Float>&, VectorTypeFor<dimensions, Float>&&, ResourceKey, RendererBatch<dimensions>&) = delete;
+
         ~ForceRenderer();
 
     private:
+        void createResources();
+
         void draw(const MatrixTypeFor<dimensions, Float>& transformationMatrix, SceneGraph::Camera<dimensions, Float>& camera) override;
 
         const VectorTypeFor<dimensions, Float> _forcePosition;
@@ -137,7 +155,8 @@ template<UnsignedInt dimensions> class MAGNUM_DEBUGTOOLS_EXPORT ForceRenderer: p
         Resource<ForceRendererOptions> _options;
         Resource<AbstractShaderProgram, Shaders::Flat<dimensions>> _shader;
         Resource<Mesh> _mesh;
-        Resource<Buffer> _vertexBuffer, _indexBuffer;
+        Resource<Buffer> _vertexBuffer, _indexBuffer, _instanceBuffer;
+        RendererBatch<dimensions>* _batch;
 };
 
 /** @brief Two-dimensional force renderer */
@@ -0,0 +1,263 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "FrameProfiler.h"
+
+#include <ostream>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+
+namespace Magnum { namespace DebugTools {
+
+using namespace std::chrono;
+
+namespace {
+
+/* Trace event timestamps are in microseconds, printing them with fixed
+   precision as the default float formatting loses it on long captures */
+void writeTime(std::ostream& out, const Long time) {
+    const char fraction[]{char('0' + time/100%10), char('0' + time/10%10), char('0' + time%10), '\0'};
+    out << time/1000 << '.' << fraction;
+}
+
+void writeString(std::ostream& out, const std::string& string) {
+    out << '"';
+    for(const char c: string) {
+        if(c == '"' || c == '\\') out << '\\' << c;
+        else if(static_cast<unsigned char>(c) < 0x20) out << ' ';
+        else out << c;
+    }
+    out << '"';
+}
+
+}
+
+FrameProfiler::FrameProfiler(const std::size_t latency):
+    #ifndef MAGNUM_TARGET_GLES
+    _gpuTimeAvailable{Context::current().isExtensionSupported<Extensions::GL::ARB::timer_query>()}
+    #else
+    _gpuTimeAvailable{Context::current().isExtensionSupported<Extensions::GL::EXT::disjoint_timer_query>()}
+    #endif
+{
+    CORRADE_ASSERT(latency, "DebugTools::FrameProfiler: latency is expected to be at least one frame", );
+    _frames.resize(latency);
+}
+
+auto FrameProfiler::addSection(const std::string& name, const Section parent) -> Section {
+    CORRADE_ASSERT(parent == NoParent || parent < _sections.size(),
+        "DebugTools::FrameProfiler::addSection(): parent" << parent << "out of range for" << _sections.size() << "sections", {});
+    CORRADE_ASSERT(_stack.empty(),
+        "DebugTools::FrameProfiler::addSection(): can't add a section while another is running", {});
+
+    _sections.push_back({name, parent});
+    _cpuTotal.push_back(nanoseconds::zero());
+    _gpuTotal.push_back(nanoseconds::zero());
+    _gpuLast.push_back(nanoseconds::zero());
+    return _sections.size() - 1;
+}
+
+std::string FrameProfiler::sectionName(const Section section) const {
+    CORRADE_ASSERT(section < _sections.size(),
+        "DebugTools::FrameProfiler::sectionName(): section" << section << "out of range for" << _sections.size() << "sections", {});
+    return _sections[section].name;
+}
+
+auto FrameProfiler::sectionParent(const Section section) const -> Section {
+    CORRADE_ASSERT(section < _sections.size(),
+        "DebugTools::FrameProfiler::sectionParent(): section" << section << "out of range for" << _sections.size() << "sections", {});
+    return _sections[section].parent;
+}
+
+void FrameProfiler::begin(const Section section) {
+    CORRADE_ASSERT(section < _sections.size(),
+        "DebugTools::FrameProfiler::begin(): section" << section << "out of range for" << _sections.size() << "sections", );
+
+    Frame& frame = _frames[_currentFrame];
+    CORRADE_ASSERT(_sections[section].parent == (_stack.empty() ? NoParent : frame.records[_stack.back()].section),
+        "DebugTools::FrameProfiler::begin(): section" << _sections[section].name << "is not a child of the running section", );
+
+    const std::size_t id = frame.records.size();
+    _stack.push_back(id);
+
+    if(_gpuTimeAvailable) {
+        while(frame.queries.size() < 2*(id + 1))
+            frame.queries.emplace_back(TimeQuery::Target::Timestamp);
+        frame.queries[2*id].timestamp();
+    }
+
+    frame.records.push_back({section, high_resolution_clock::now(), {}});
+}
+
+void FrameProfiler::end() {
+    CORRADE_ASSERT(!_stack.empty(),
+        "DebugTools::FrameProfiler::end(): no section is running", );
+
+    Frame& frame = _frames[_currentFrame];
+    const std::size_t id = _stack.back();
+    _stack.pop_back();
+
+    frame.records[id].cpuEnd = high_resolution_clock::now();
+    if(_gpuTimeAvailable) frame.queries[2*id + 1].timestamp();
+}
+
+void FrameProfiler::nextFrame() {
+    CORRADE_ASSERT(_stack.empty(),
+        "DebugTools::FrameProfiler::nextFrame(): section" << _sections[_frames[_currentFrame].records[_stack.back()].section].name << "is still running", );
+
+    /* CPU times of current frame are known right away */
+    for(const Record& record: _frames[_currentFrame].records) {
+        const nanoseconds duration = duration_cast<nanoseconds>(record.cpuEnd - record.cpuBegin);
+        _cpuTotal[record.section] += duration;
+        /* Sections that ended before the trace started are not exported */
+        if(_traceOutput && record.cpuBegin >= _traceBegin) traceEvent(_sections[record.section].name, 0,
+            duration_cast<nanoseconds>(record.cpuBegin - _traceBegin).count(),
+            duration.count());
+    }
+    ++_cpuFrameCount;
+
+    if(_traceOutput) {
+        for(const Counter& counter: _counters) {
+            *_traceOutput << ",\n{\"name\":";
+            writeString(*_traceOutput, counter.name);
+            *_traceOutput << ",\"ph\":\"C\",\"ts\":";
+            writeTime(*_traceOutput, duration_cast<nanoseconds>(counter.time - _traceBegin).count());
+            *_traceOutput << ",\"pid\":0,\"args\":{\"value\":" << counter.value << "}}";
+        }
+        _counters.clear();
+    }
+
+    /* Advance to next frame in the ring and retrieve its GPU times, issued
+       latency() frames ago. Queries complete in order, so if the last one is
+       available, all others are as well. */
+    _currentFrame = (_currentFrame + 1) % _frames.size();
+    Frame& frame = _frames[_currentFrame];
+    if(_gpuTimeAvailable && !frame.records.empty()) {
+        if(frame.queries[2*frame.records.size() - 1].resultAvailable()) {
+            /* Frames issued before the trace started are not exported. The
+               first exported one defines alignment of the GPU track. */
+            const bool trace = _traceOutput && frame.records.front().cpuBegin >= _traceBegin;
+            if(trace && !_traceGpuAligned) {
+                _traceGpuBegin = Long(frame.queries[0].result<UnsignedLong>()) - duration_cast<nanoseconds>(frame.records.front().cpuBegin - _traceBegin).count();
+                _traceGpuAligned = true;
+            }
+
+            _gpuLast.assign(_sections.size(), nanoseconds::zero());
+            for(std::size_t i = 0; i != frame.records.size(); ++i) {
+                const UnsignedLong begin = frame.queries[2*i].result<UnsignedLong>();
+                const UnsignedLong end = frame.queries[2*i + 1].result<UnsignedLong>();
+                _gpuTotal[frame.records[i].section] += nanoseconds(end - begin);
+                _gpuLast[frame.records[i].section] += nanoseconds(end - begin);
+                if(trace) traceEvent(_sections[frame.records[i].section].name, 1,
+                    Long(begin) - _traceGpuBegin, Long(end - begin));
+            }
+            ++_gpuFrameCount;
+        }
+    }
+
+    frame.records.clear();
+}
+
+nanoseconds FrameProfiler::cpuDuration(const Section section) const {
+    CORRADE_ASSERT(section < _sections.size(),
+        "DebugTools::FrameProfiler::cpuDuration(): section" << section << "out of range for" << _sections.size() << "sections", {});
+    return _cpuFrameCount ? _cpuTotal[section]/nanoseconds::rep(_cpuFrameCount) : nanoseconds::zero();
+}
+
+nanoseconds FrameProfiler::gpuDuration(const Section section) const {
+    CORRADE_ASSERT(section < _sections.size(),
+        "DebugTools::FrameProfiler::gpuDuration(): section" << section << "out of range for" << _sections.size() << "sections", {});
+    return _gpuFrameCount ? _gpuTotal[section]/nanoseconds::rep(_gpuFrameCount) : nanoseconds::zero();
+}
+
+nanoseconds FrameProfiler::lastGpuDuration(const Section section) const {
+    CORRADE_ASSERT(section < _sections.size(),
+        "DebugTools::FrameProfiler::lastGpuDuration(): section" << section << "out of range for" << _sections.size() << "sections", {});
+    return _gpuLast[section];
+}
+
+void FrameProfiler::addCounter(const std::string& name, const Double value) {
+    if(!_traceOutput) return;
+    _counters.push_back({name, value, high_resolution_clock::now()});
+}
+
+FrameProfiler& FrameProfiler::setTraceOutput(std::ostream* const output) {
+    CORRADE_ASSERT(_stack.empty(),
+        "DebugTools::FrameProfiler::setTraceOutput(): can't change the output while a section is running", *this);
+
+    if(_traceOutput) *_traceOutput << "\n]\n";
+
+    _traceOutput = output;
+    _traceGpuAligned = false;
+    _counters.clear();
+    if(!_traceOutput) return *this;
+
+    _traceBegin = high_resolution_clock::now();
+    *_traceOutput << "[\n"
+        "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":0,\"args\":{\"name\":\"CPU\"}},\n"
+        "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":1,\"args\":{\"name\":\"GPU\"}}";
+    return *this;
+}
+
+void FrameProfiler::traceEvent(const std::string& name, const UnsignedInt track, const Long begin, const Long duration) {
+    *_traceOutput << ",\n{\"name\":";
+    writeString(*_traceOutput, name);
+    *_traceOutput << ",\"ph\":\"X\",\"ts\":";
+    writeTime(*_traceOutput, begin);
+    *_traceOutput << ",\"dur\":";
+    writeTime(*_traceOutput, duration);
+    *_traceOutput << ",\"pid\":0,\"tid\":" << track << "}";
+}
+
+void FrameProfiler::resetStatistics() {
+    _cpuTotal.assign(_sections.size(), nanoseconds::zero());
+    _gpuTotal.assign(_sections.size(), nanoseconds::zero());
+    _cpuFrameCount = _gpuFrameCount = 0;
+}
+
+void FrameProfiler::printStatistics() const {
+    Debug() << "Statistics for" << _cpuFrameCount << "frames," << _gpuFrameCount << "with GPU times:";
+    printStatistics(NoParent, 1);
+}
+
+void FrameProfiler::printStatistics(const Section parent, const UnsignedInt depth) const {
+    for(Section i = 0; i != _sections.size(); ++i) {
+        if(_sections[i].parent != parent) continue;
+
+        {
+            Debug d;
+            d << std::string(2*depth - 1, ' ') << _sections[i].name << "CPU"
+              << duration_cast<microseconds>(cpuDuration(i)).count() << u8"µs";
+            if(_gpuTimeAvailable)
+                d << "GPU" << duration_cast<microseconds>(gpuDuration(i)).count() << u8"µs";
+        }
+
+        printStatistics(i, depth + 1);
+    }
+}
+
+}}
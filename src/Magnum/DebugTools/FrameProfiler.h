@@ -0,0 +1,305 @@
+#ifndef Magnum_DebugTools_FrameProfiler_h
+#define Magnum_DebugTools_FrameProfiler_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef MAGNUM_TARGET_WEBGL
+/** @file
+ * @brief Class @ref Magnum::DebugTools::FrameProfiler
+ */
+#endif
+
+#include <chrono>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include "Magnum/TimeQuery.h"
+#include "Magnum/DebugTools/visibility.h"
+
+#ifndef MAGNUM_TARGET_WEBGL
+namespace Magnum { namespace DebugTools {
+
+/**
+@brief Hierarchical CPU and GPU frame profiler
+
+Unlike @ref Profiler, which measures only CPU time of a flat list of sections,
+this class measures both CPU and GPU time of nested sections. Sections are
+registered upfront together with their parent and then each frame enclosed in
+@ref begin() and @ref end() calls:
+
+@snippet MagnumDebugTools.cpp FrameProfiler-usage
+
+GPU time is measured using @ref TimeQuery::Target::Timestamp queries issued
+at the beginning and end of each section. To avoid stalling the pipeline,
+the queries are kept in a ring of @ref latency() frames and results of each
+frame are retrieved only once the ring wraps around back to it in
+@ref nextFrame(). If the results are not available even at that point, GPU
+times of given frame are discarded and the frame is not counted in
+@ref gpuFrameCount(). CPU times of each frame are accumulated right in
+@ref nextFrame().
+
+If timer queries are not supported, only CPU times are measured, see
+@ref isGpuTimeAvailable().
+
+@section DebugTools-FrameProfiler-trace Trace export
+
+Besides averaged statistics, the profiler can stream all measured sections
+and counters in the
+[Chrome Trace Event format](https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU)
+for analysis in `chrome://tracing` or [Perfetto UI](https://ui.perfetto.dev/).
+Events of each frame are written to the stream in @ref nextFrame(), so the
+memory use doesn't grow with capture length:
+
+@snippet MagnumDebugTools.cpp FrameProfiler-trace
+
+CPU sections are on one track and GPU sections on another, arriving
+@ref latency() frames later. GPU timestamps use a different clock, so the GPU
+track is aligned to start together with the CPU counterpart of the first
+retrieved GPU section. Values passed to @ref addCounter() are exported as
+counter events.
+
+@requires_gl33 Extension @extension{ARB,timer_query} for GPU time
+    measurement.
+@requires_es_extension Extension @extension{EXT,disjoint_timer_query} for GPU
+    time measurement.
+@requires_gles Time queries are not available in WebGL.
+
+@todo Handle `GL_GPU_DISJOINT_EXT` on ES
+*/
+class MAGNUM_DEBUGTOOLS_EXPORT FrameProfiler {
+    public:
+        /**
+         * @brief Section ID
+         *
+         * @see @ref addSection(), @ref begin()
+         */
+        typedef UnsignedInt Section;
+
+        /**
+         * @brief No parent section
+         *
+         * @see @ref addSection()
+         */
+        static const Section NoParent = ~Section{};
+
+        /**
+         * @brief Constructor
+         * @param latency   Count of frames after which the GPU times are
+         *      retrieved
+         *
+         * Expects that @p latency is at least @cpp 1 @ce. Requires a current
+         * OpenGL context.
+         */
+        explicit FrameProfiler(std::size_t latency = 3);
+
+        /** @brief Copying is not allowed */
+        FrameProfiler(const FrameProfiler&) = delete;
+
+        /** @brief Copying is not allowed */
+        FrameProfiler& operator=(const FrameProfiler&) = delete;
+
+        /** @brief Frame latency of GPU time retrieval */
+        std::size_t latency() const { return _frames.size(); }
+
+        /**
+         * @brief Whether GPU time is measured
+         *
+         * Returns @cpp false @ce if neither @extension{ARB,timer_query} (part
+         * of OpenGL 3.3) nor @extension{EXT,disjoint_timer_query} on OpenGL
+         * ES is supported.
+         */
+        bool isGpuTimeAvailable() const { return _gpuTimeAvailable; }
+
+        /**
+         * @brief Add named section
+         * @param name      Section name
+         * @param parent    Parent section or @ref NoParent for a top-level
+         *      section
+         *
+         * Expects that @p parent is either @ref NoParent or an already added
+         * section and that no section is currently running.
+         */
+        Section addSection(const std::string& name, Section parent = NoParent);
+
+        /** @brief Count of added sections */
+        std::size_t sectionCount() const { return _sections.size(); }
+
+        /** @brief Section name */
+        std::string sectionName(Section section) const;
+
+        /** @brief Section parent */
+        Section sectionParent(Section section) const;
+
+        /**
+         * @brief Begin a section
+         *
+         * Expects that the section parent is the currently running section
+         * or that no section is running if the section is top-level. A
+         * section can be begun more than once in a frame, in that case the
+         * times are summed.
+         */
+        void begin(Section section);
+
+        /**
+         * @brief End currently running section
+         *
+         * Expects that a section is running.
+         */
+        void end();
+
+        /**
+         * @brief Advance to next frame
+         *
+         * Call at the end of each frame. Accumulates CPU times of current
+         * frame and retrieves GPU times of a frame issued @ref latency()
+         * frames ago. Expects that no section is running.
+         */
+        void nextFrame();
+
+        /** @brief Count of frames with retrieved CPU times */
+        std::size_t cpuFrameCount() const { return _cpuFrameCount; }
+
+        /** @brief Count of frames with retrieved GPU times */
+        std::size_t gpuFrameCount() const { return _gpuFrameCount; }
+
+        /**
+         * @brief Average CPU time spent in given section per frame
+         *
+         * Includes time spent in child sections. Returns zero duration if
+         * no frame was measured yet.
+         */
+        std::chrono::nanoseconds cpuDuration(Section section) const;
+
+        /**
+         * @brief Average GPU time spent in given section per frame
+         *
+         * Includes time spent in child sections. Returns zero duration if
+         * no frame was measured yet or if GPU time is not available.
+         */
+        std::chrono::nanoseconds gpuDuration(Section section) const;
+
+        /**
+         * @brief GPU time spent in given section in last retrieved frame
+         *
+         * Unlike @ref gpuDuration() this is not averaged, which makes it
+         * suitable for controllers reacting to the frame time such as
+         * @ref DynamicResolution. The value changes only when
+         * @ref gpuFrameCount() gets incremented and is not affected by
+         * @ref resetStatistics(). Includes time spent in child sections.
+         * Returns zero duration if no frame was retrieved yet, if the section
+         * wasn't begun in that frame or if GPU time is not available.
+         */
+        std::chrono::nanoseconds lastGpuDuration(Section section) const;
+
+        /**
+         * @brief Add a counter value
+         *
+         * The value is exported at current time if trace output is set,
+         * otherwise the call does nothing.
+         * @see @ref setTraceOutput()
+         */
+        void addCounter(const std::string& name, Double value);
+
+        /** @brief Trace output */
+        std::ostream* traceOutput() const { return _traceOutput; }
+
+        /**
+         * @brief Set trace output
+         * @return Reference to self (for method chaining)
+         *
+         * Starts writing a JSON array of trace events into @p output. If
+         * there already was an output, the array is terminated there first.
+         * Pass @cpp nullptr @ce to stop the export --- the stream is
+         * expected to be alive until then. Flushing is left on the stream.
+         * Expects that no section is running.
+         */
+        FrameProfiler& setTraceOutput(std::ostream* output);
+
+        /**
+         * @brief Reset the statistics
+         *
+         * GPU times of frames that are already in flight are still
+         * accumulated when they get retrieved.
+         */
+        void resetStatistics();
+
+        /**
+         * @brief Print statistics
+         *
+         * Prints average CPU and GPU time of all sections, with child sections
+         * indented under their parents.
+         */
+        void printStatistics() const;
+
+    private:
+        struct SectionData {
+            std::string name;
+            Section parent;
+        };
+
+        struct Record {
+            Section section;
+            std::chrono::high_resolution_clock::time_point cpuBegin, cpuEnd;
+        };
+
+        struct Frame {
+            std::vector<Record> records;
+            /* Two queries for each record, the pool only grows */
+            std::vector<TimeQuery> queries;
+        };
+
+        struct Counter {
+            std::string name;
+            Double value;
+            std::chrono::high_resolution_clock::time_point time;
+        };
+
+        void traceEvent(const std::string& name, UnsignedInt track, Long begin, Long duration);
+
+        void printStatistics(Section parent, UnsignedInt depth) const;
+
+        bool _gpuTimeAvailable;
+        std::size_t _currentFrame{}, _cpuFrameCount{}, _gpuFrameCount{};
+        std::vector<SectionData> _sections;
+        std::vector<Frame> _frames;
+        /* Indices into records of current frame */
+        std::vector<std::size_t> _stack;
+        std::vector<std::chrono::nanoseconds> _cpuTotal, _gpuTotal, _gpuLast;
+
+        std::ostream* _traceOutput{};
+        bool _traceGpuAligned{};
+        std::chrono::high_resolution_clock::time_point _traceBegin;
+        /* GPU timestamp corresponding to begin of the trace, in ns */
+        Long _traceGpuBegin{};
+        std::vector<Counter> _counters;
+};
+
+}}
+#else
+#error this header is not available in WebGL build
+#endif
+
+#endif
@@ -33,11 +33,11 @@
 
 namespace Magnum { namespace DebugTools { namespace Implementation {
 
-AbstractBoxRenderer<2>::AbstractBoxRenderer(): AbstractShapeRenderer<2>("box2d", "box2d-vertices", {}) {
+AbstractBoxRenderer<2>::AbstractBoxRenderer(): AbstractShapeRenderer<2>("box2d", "box2d-vertices", {}, "box2d-instances") {
     if(!wireframeMesh) AbstractShapeRenderer<2>::createResources(Primitives::squareWireframe());
 }
 
-AbstractBoxRenderer<3>::AbstractBoxRenderer(): AbstractShapeRenderer<3>("box3d", "box3d-vertices", "box3d-indices") {
+AbstractBoxRenderer<3>::AbstractBoxRenderer(): AbstractShapeRenderer<3>("box3d", "box3d-vertices", "box3d-indices", "box3d-instances") {
     if(!wireframeMesh) AbstractShapeRenderer<3>::createResources(Primitives::cubeWireframe());
 }
 
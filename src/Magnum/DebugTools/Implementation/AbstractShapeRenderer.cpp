@@ -30,12 +30,16 @@
 #include "Magnum/AbstractShaderProgram.h"
 #include "Magnum/Buffer.h"
 #include "Magnum/Mesh.h"
+#include "Magnum/MeshView.h"
+#include "Magnum/DebugTools/RendererBatch.h"
 #include "Magnum/DebugTools/ResourceManager.h"
 #include "Magnum/MeshTools/CompressIndices.h"
 #include "Magnum/Shaders/Flat.h"
 #include "Magnum/Trade/MeshData2D.h"
 #include "Magnum/Trade/MeshData3D.h"
 
+#include "InstanceBuffer.h"
+
 namespace Magnum { namespace DebugTools { namespace Implementation {
 
 namespace {
@@ -44,9 +48,9 @@ template<UnsignedInt dimensions> ResourceKey shaderKey();
 template<> inline ResourceKey shaderKey<2>() { return ResourceKey("FlatShader2D"); }
 template<> inline ResourceKey shaderKey<3>() { return ResourceKey("FlatShader3D"); }
 
-template<UnsignedInt dimensions> void create(typename MeshData<dimensions>::Type&, Resource<Mesh>&, Resource<Buffer>&, Resource<Buffer>&);
+template<UnsignedInt dimensions> void create(typename MeshData<dimensions>::Type&, Resource<Mesh>&, Resource<Buffer>&, Resource<Buffer>&, Resource<Buffer>&);
 
-template<> void create<2>(Trade::MeshData2D& data, Resource<Mesh>& meshResource, Resource<Buffer>& vertexBufferResource, Resource<Buffer>& indexBufferResource) {
+template<> void create<2>(Trade::MeshData2D& data, Resource<Mesh>& meshResource, Resource<Buffer>& vertexBufferResource, Resource<Buffer>& indexBufferResource, Resource<Buffer>& instanceBufferResource) {
     /* Vertex buffer */
     Buffer* buffer = new Buffer{Buffer::TargetHint::Array};
     buffer->setData(data.positions(0), BufferUsage::StaticDraw);
@@ -56,6 +60,7 @@ template<> void create<2>(Trade::MeshData2D& data, Resource<Mesh>& meshResource,
     Mesh* mesh = new Mesh;
     mesh->setPrimitive(data.primitive())
         .addVertexBuffer(*buffer, 0, Shaders::Flat2D::Position());
+    createInstanceBuffer<2>(*mesh, instanceBufferResource);
     ResourceManager::instance().set(meshResource.key(), mesh, ResourceDataState::Final, ResourcePolicy::Manual);
 
     /* Index buffer, if needed, if not, resource key doesn't have to be set */
@@ -78,7 +83,7 @@ template<> void create<2>(Trade::MeshData2D& data, Resource<Mesh>& meshResource,
     } else mesh->setCount(data.positions(0).size());
 }
 
-template<> void create<3>(Trade::MeshData3D& data, Resource<Mesh>& meshResource, Resource<Buffer>& vertexBufferResource, Resource<Buffer>& indexBufferResource) {
+template<> void create<3>(Trade::MeshData3D& data, Resource<Mesh>& meshResource, Resource<Buffer>& vertexBufferResource, Resource<Buffer>& indexBufferResource, Resource<Buffer>& instanceBufferResource) {
     /* Vertex buffer */
     Buffer* vertexBuffer = new Buffer{Buffer::TargetHint::Array};
     vertexBuffer->setData(data.positions(0), BufferUsage::StaticDraw);
@@ -88,6 +93,7 @@ template<> void create<3>(Trade::MeshData3D& data, Resource<Mesh>& meshResource,
     Mesh* mesh = new Mesh;
     mesh->setPrimitive(data.primitive())
         .addVertexBuffer(*vertexBuffer, 0, Shaders::Flat3D::Position());
+    createInstanceBuffer<3>(*mesh, instanceBufferResource);
     ResourceManager::instance().set(meshResource.key(), mesh, ResourceDataState::Final, ResourcePolicy::Manual);
 
     /* Index buffer, if needed, if not, resource key doesn't have to be set */
@@ -112,11 +118,12 @@ template<> void create<3>(Trade::MeshData3D& data, Resource<Mesh>& meshResource,
 
 }
 
-template<UnsignedInt dimensions> AbstractShapeRenderer<dimensions>::AbstractShapeRenderer(ResourceKey meshKey, ResourceKey vertexBufferKey, ResourceKey indexBufferKey) {
+template<UnsignedInt dimensions> AbstractShapeRenderer<dimensions>::AbstractShapeRenderer(ResourceKey meshKey, ResourceKey vertexBufferKey, ResourceKey indexBufferKey, ResourceKey instanceBufferKey) {
     wireframeShader = ResourceManager::instance().get<AbstractShaderProgram, Shaders::Flat<dimensions>>(shaderKey<dimensions>());
     wireframeMesh = ResourceManager::instance().get<Mesh>(meshKey);
     vertexBuffer = ResourceManager::instance().get<Buffer>(vertexBufferKey);
     indexBuffer = ResourceManager::instance().get<Buffer>(indexBufferKey);
+    instanceBuffer = ResourceManager::instance().get<Buffer>(instanceBufferKey);
 
     if(!wireframeShader) ResourceManager::instance().set<AbstractShaderProgram>(shaderKey<dimensions>(),
         new Shaders::Flat<dimensions>, ResourceDataState::Final, ResourcePolicy::Resident);
@@ -125,7 +132,29 @@ template<UnsignedInt dimensions> AbstractShapeRenderer<dimensions>::AbstractShap
 template<UnsignedInt dimensions> AbstractShapeRenderer<dimensions>::~AbstractShapeRenderer() = default;
 
 template<UnsignedInt dimensions> void AbstractShapeRenderer<dimensions>::createResources(typename MeshData<dimensions>::Type data) {
-    create<dimensions>(data, wireframeMesh, vertexBuffer, indexBuffer);
+    create<dimensions>(data, wireframeMesh, vertexBuffer, indexBuffer, instanceBuffer);
+}
+
+template<UnsignedInt dimensions> void AbstractShapeRenderer<dimensions>::drawMesh(RendererBatch<dimensions>* const batch, const MatrixTypeFor<dimensions, Float>& transformationProjectionMatrix, const Color4& color) {
+    if(batch) {
+        batch->add(*wireframeMesh, instanceBuffer, transformationProjectionMatrix, color);
+        return;
+    }
+
+    wireframeShader->setTransformationProjectionMatrix(transformationProjectionMatrix)
+        .setColor(color);
+    wireframeMesh->draw(*wireframeShader);
+}
+
+template<UnsignedInt dimensions> void AbstractShapeRenderer<dimensions>::drawMesh(RendererBatch<dimensions>* const batch, MeshView& view, const MatrixTypeFor<dimensions, Float>& transformationProjectionMatrix, const Color4& color) {
+    if(batch) {
+        batch->add(view, instanceBuffer, transformationProjectionMatrix, color);
+        return;
+    }
+
+    wireframeShader->setTransformationProjectionMatrix(transformationProjectionMatrix)
+        .setColor(color);
+    view.draw(*wireframeShader);
 }
 
 template class AbstractShapeRenderer<2>;
@@ -27,6 +27,7 @@
 
 #include "Magnum/DimensionTraits.h"
 #include "Magnum/Resource.h"
+#include "Magnum/Math/Color.h"
 #include "Magnum/DebugTools/DebugTools.h"
 #include "Magnum/SceneGraph/SceneGraph.h"
 #include "Magnum/Shaders/Shaders.h"
@@ -47,20 +48,26 @@ template<> struct MeshData<3> { typedef Trade::MeshData3D Type; };
 
 template<UnsignedInt dimensions> class AbstractShapeRenderer {
     public:
-        AbstractShapeRenderer(ResourceKey mesh, ResourceKey vertexBuffer, ResourceKey indexBuffer);
+        AbstractShapeRenderer(ResourceKey mesh, ResourceKey vertexBuffer, ResourceKey indexBuffer, ResourceKey instanceBuffer);
         virtual ~AbstractShapeRenderer();
 
-        virtual void draw(Resource<ShapeRendererOptions>& options, const MatrixTypeFor<dimensions, Float>& projectionMatrix) = 0;
+        /* If batch is not nullptr, the projection matrix contains just the
+           camera matrix and the primitives are added to the batch */
+        virtual void draw(Resource<ShapeRendererOptions>& options, const MatrixTypeFor<dimensions, Float>& projectionMatrix, RendererBatch<dimensions>* batch) = 0;
 
     protected:
         /* Call only if the mesh resource isn't already present */
         void createResources(typename MeshData<dimensions>::Type data);
 
+        /* Draws the wireframe mesh or its view or adds it to the batch */
+        void drawMesh(RendererBatch<dimensions>* batch, const MatrixTypeFor<dimensions, Float>& transformationProjectionMatrix, const Color4& color);
+        void drawMesh(RendererBatch<dimensions>* batch, MeshView& view, const MatrixTypeFor<dimensions, Float>& transformationProjectionMatrix, const Color4& color);
+
         Resource<AbstractShaderProgram, Shaders::Flat<dimensions>> wireframeShader;
         Resource<Mesh> wireframeMesh;
 
     private:
-        Resource<Buffer> indexBuffer, vertexBuffer;
+        Resource<Buffer> indexBuffer, vertexBuffer, instanceBuffer;
 };
 
 }}}
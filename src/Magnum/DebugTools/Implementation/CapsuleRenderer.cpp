@@ -39,7 +39,7 @@
 
 namespace Magnum { namespace DebugTools { namespace Implementation {
 
-AbstractCapsuleRenderer<2>::AbstractCapsuleRenderer(): AbstractShapeRenderer<2>("capsule2d", "capsule2d-vertices", "capsule2d-indices") {
+AbstractCapsuleRenderer<2>::AbstractCapsuleRenderer(): AbstractShapeRenderer<2>("capsule2d", "capsule2d-vertices", "capsule2d-indices", "capsule2d-instances") {
     constexpr UnsignedInt rings = 10;
     if(!wireframeMesh) createResources(Primitives::capsule2DWireframe(rings, 1, 1.0f));
 
@@ -68,7 +68,7 @@ AbstractCapsuleRenderer<2>::AbstractCapsuleRenderer(): AbstractShapeRenderer<2>(
     }
 }
 
-AbstractCapsuleRenderer<3>::AbstractCapsuleRenderer(): AbstractShapeRenderer<3>("capsule3d", "capsule3d-vertices", "capsule3d-indices") {
+AbstractCapsuleRenderer<3>::AbstractCapsuleRenderer(): AbstractShapeRenderer<3>("capsule3d", "capsule3d-vertices", "capsule3d-indices", "capsule3d-instances") {
     constexpr UnsignedInt rings = 10;
     constexpr UnsignedInt segments = 40;
     if(!wireframeMesh) createResources(Primitives::capsule3DWireframe(rings, 1, segments, 1.0f));
@@ -104,21 +104,17 @@ AbstractCapsuleRenderer<3>::~AbstractCapsuleRenderer() = default;
 
 template<UnsignedInt dimensions> CapsuleRenderer<dimensions>::CapsuleRenderer(const Shapes::Implementation::AbstractShape<dimensions>& capsule): capsule(static_cast<const Shapes::Implementation::Shape<Shapes::Capsule<dimensions>>&>(capsule).shape) {}
 
-template<UnsignedInt dimensions> void CapsuleRenderer<dimensions>::draw(Resource<ShapeRendererOptions>& options, const MatrixTypeFor<dimensions, Float>& projectionMatrix) {
+template<UnsignedInt dimensions> void CapsuleRenderer<dimensions>::draw(Resource<ShapeRendererOptions>& options, const MatrixTypeFor<dimensions, Float>& projectionMatrix, RendererBatch<dimensions>* const batch) {
     std::array<MatrixTypeFor<dimensions, Float>, 3> transformations = Implementation::capsuleRendererTransformation<dimensions>(capsule.a(), capsule.b(), capsule.radius());
-    AbstractShapeRenderer<dimensions>::wireframeShader->setColor(options->color());
 
     /* Bottom */
-    AbstractShapeRenderer<dimensions>::wireframeShader->setTransformationProjectionMatrix(projectionMatrix*transformations[0]);
-    AbstractCapsuleRenderer<dimensions>::bottom->draw(*AbstractShapeRenderer<dimensions>::wireframeShader);
+    AbstractShapeRenderer<dimensions>::drawMesh(batch, *AbstractCapsuleRenderer<dimensions>::bottom, projectionMatrix*transformations[0], options->color());
 
     /* Cylinder */
-    AbstractShapeRenderer<dimensions>::wireframeShader->setTransformationProjectionMatrix(projectionMatrix*transformations[1]);
-    AbstractCapsuleRenderer<dimensions>::cylinder->draw(*AbstractShapeRenderer<dimensions>::wireframeShader);
+    AbstractShapeRenderer<dimensions>::drawMesh(batch, *AbstractCapsuleRenderer<dimensions>::cylinder, projectionMatrix*transformations[1], options->color());
 
     /* Top */
-    AbstractShapeRenderer<dimensions>::wireframeShader->setTransformationProjectionMatrix(projectionMatrix*transformations[2]);
-    AbstractCapsuleRenderer<dimensions>::top->draw(*AbstractShapeRenderer<dimensions>::wireframeShader);
+    AbstractShapeRenderer<dimensions>::drawMesh(batch, *AbstractCapsuleRenderer<dimensions>::top, projectionMatrix*transformations[2], options->color());
 }
 
 template class CapsuleRenderer<2>;
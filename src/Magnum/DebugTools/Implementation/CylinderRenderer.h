@@ -48,7 +48,7 @@ template<UnsignedInt dimensions> class CylinderRenderer: public AbstractCylinder
         explicit CylinderRenderer(const Shapes::Implementation::AbstractShape<dimensions>& cylinder);
         CylinderRenderer(const Shapes::Implementation::AbstractShape<dimensions>&&) = delete;
 
-        void draw(Resource<ShapeRendererOptions>& options, const MatrixTypeFor<dimensions, Float>& projectionMatrix) override;
+        void draw(Resource<ShapeRendererOptions>& options, const MatrixTypeFor<dimensions, Float>& projectionMatrix, RendererBatch<dimensions>* batch) override;
 
     private:
         const Shapes::Cylinder<dimensions>& cylinder;
@@ -0,0 +1,55 @@
+#ifndef Magnum_DebugTools_Implementation_ForceRendererMesh_h
+#define Magnum_DebugTools_Implementation_ForceRendererMesh_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/Resource.h"
+
+namespace Magnum { namespace DebugTools { namespace Implementation {
+
+/* Arrow mesh used by ForceRenderer and by batched ObjectRenderer. The mesh is
+   dimension-specific because of the instanced attributes. */
+template<UnsignedInt> struct ForceRendererMesh;
+
+template<> struct ForceRendererMesh<2> {
+    static ResourceKey mesh() { return {"force2d"}; }
+    static ResourceKey vertexBuffer() { return {"force2d-vertices"}; }
+    static ResourceKey indexBuffer() { return {"force2d-indices"}; }
+    static ResourceKey instanceBuffer() { return {"force2d-instances"}; }
+};
+
+template<> struct ForceRendererMesh<3> {
+    static ResourceKey mesh() { return {"force3d"}; }
+    static ResourceKey vertexBuffer() { return {"force3d-vertices"}; }
+    static ResourceKey indexBuffer() { return {"force3d-indices"}; }
+    static ResourceKey instanceBuffer() { return {"force3d-instances"}; }
+};
+
+/* Call only if the mesh resource isn't already present */
+template<UnsignedInt dimensions> void createForceRendererMesh(Resource<Mesh>& mesh, Resource<Buffer>& vertexBuffer, Resource<Buffer>& indexBuffer, Resource<Buffer>& instanceBuffer);
+
+}}}
+
+#endif
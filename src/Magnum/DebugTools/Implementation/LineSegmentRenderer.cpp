@@ -46,20 +46,22 @@ namespace {
     template<> inline ResourceKey vertexBufferKey<2>() { return ResourceKey("line2d-vertices"); }
     template<> inline ResourceKey vertexBufferKey<3>() { return ResourceKey("line3d-vertices"); }
 
+    template<UnsignedInt dimensions> ResourceKey instanceBufferKey();
+    template<> inline ResourceKey instanceBufferKey<2>() { return ResourceKey("line2d-instances"); }
+    template<> inline ResourceKey instanceBufferKey<3>() { return ResourceKey("line3d-instances"); }
+
     template<UnsignedInt dimensions> typename MeshData<dimensions>::Type meshData();
     template<> inline Trade::MeshData2D meshData<2>() { return Primitives::line2D(); }
     template<> inline Trade::MeshData3D meshData<3>() { return Primitives::line3D(); }
 }
 
-template<UnsignedInt dimensions> LineSegmentRenderer<dimensions>::LineSegmentRenderer(const Shapes::Implementation::AbstractShape<dimensions>& line): AbstractShapeRenderer<dimensions>(meshKey<dimensions>(), vertexBufferKey<dimensions>(), {}), line(static_cast<const Shapes::Implementation::Shape<Shapes::LineSegment<dimensions>>&>(line).shape) {
+template<UnsignedInt dimensions> LineSegmentRenderer<dimensions>::LineSegmentRenderer(const Shapes::Implementation::AbstractShape<dimensions>& line): AbstractShapeRenderer<dimensions>(meshKey<dimensions>(), vertexBufferKey<dimensions>(), {}, instanceBufferKey<dimensions>()), line(static_cast<const Shapes::Implementation::Shape<Shapes::LineSegment<dimensions>>&>(line).shape) {
     if(!AbstractShapeRenderer<dimensions>::wireframeMesh) AbstractShapeRenderer<dimensions>::createResources(meshData<dimensions>());
 }
 
-template<UnsignedInt dimensions> void LineSegmentRenderer<dimensions>::draw(Resource<ShapeRendererOptions>& options, const MatrixTypeFor<dimensions, Float>& projectionMatrix) {
-    AbstractShapeRenderer<dimensions>::wireframeShader->setTransformationProjectionMatrix(projectionMatrix*
-        Implementation::lineSegmentRendererTransformation<dimensions>(line.a(), line.b()))
-        .setColor(options->color());
-    AbstractShapeRenderer<dimensions>::wireframeMesh->draw(*AbstractShapeRenderer<dimensions>::wireframeShader);
+template<UnsignedInt dimensions> void LineSegmentRenderer<dimensions>::draw(Resource<ShapeRendererOptions>& options, const MatrixTypeFor<dimensions, Float>& projectionMatrix, RendererBatch<dimensions>* const batch) {
+    AbstractShapeRenderer<dimensions>::drawMesh(batch, projectionMatrix*
+        Implementation::lineSegmentRendererTransformation<dimensions>(line.a(), line.b()), options->color());
 }
 
 template class LineSegmentRenderer<2>;
@@ -44,22 +44,24 @@ namespace {
     template<> inline ResourceKey vertexBufferKey<2>() { return ResourceKey("point2d-vertices"); }
     template<> inline ResourceKey vertexBufferKey<3>() { return ResourceKey("point3d-vertices"); }
 
+    template<UnsignedInt dimensions> ResourceKey instanceBufferKey();
+    template<> inline ResourceKey instanceBufferKey<2>() { return ResourceKey("point2d-instances"); }
+    template<> inline ResourceKey instanceBufferKey<3>() { return ResourceKey("point3d-instances"); }
+
     template<UnsignedInt dimensions> typename MeshData<dimensions>::Type meshData();
     template<> inline Trade::MeshData2D meshData<2>() { return Primitives::crosshair2D(); }
     template<> inline Trade::MeshData3D meshData<3>() { return Primitives::crosshair3D(); }
 }
 
-template<UnsignedInt dimensions> PointRenderer<dimensions>::PointRenderer(const Shapes::Implementation::AbstractShape<dimensions>& point): AbstractShapeRenderer<dimensions>(meshKey<dimensions>(), vertexBufferKey<dimensions>(), {}), point(static_cast<const Shapes::Implementation::Shape<Shapes::Point<dimensions>>&>(point).shape) {
+template<UnsignedInt dimensions> PointRenderer<dimensions>::PointRenderer(const Shapes::Implementation::AbstractShape<dimensions>& point): AbstractShapeRenderer<dimensions>(meshKey<dimensions>(), vertexBufferKey<dimensions>(), {}, instanceBufferKey<dimensions>()), point(static_cast<const Shapes::Implementation::Shape<Shapes::Point<dimensions>>&>(point).shape) {
     if(!AbstractShapeRenderer<dimensions>::wireframeMesh) AbstractShapeRenderer<dimensions>::createResources(meshData<dimensions>());
 }
 
-template<UnsignedInt dimensions> void PointRenderer<dimensions>::draw(Resource<ShapeRendererOptions>& options, const MatrixTypeFor<dimensions, Float>& projectionMatrix) {
+template<UnsignedInt dimensions> void PointRenderer<dimensions>::draw(Resource<ShapeRendererOptions>& options, const MatrixTypeFor<dimensions, Float>& projectionMatrix, RendererBatch<dimensions>* const batch) {
     /* Half scale, because the point is 2x2(x2) */
-    AbstractShapeRenderer<dimensions>::wireframeShader->setTransformationProjectionMatrix(projectionMatrix*
+    AbstractShapeRenderer<dimensions>::drawMesh(batch, projectionMatrix*
         MatrixTypeFor<dimensions, Float>::translation(point.position())*
-        MatrixTypeFor<dimensions, Float>::scaling(VectorTypeFor<dimensions, Float>{options->pointSize()/2}))
-        .setColor(options->color());
-    AbstractShapeRenderer<dimensions>::wireframeMesh->draw(*AbstractShapeRenderer<dimensions>::wireframeShader);
+        MatrixTypeFor<dimensions, Float>::scaling(VectorTypeFor<dimensions, Float>{options->pointSize()/2}), options->color());
 }
 
 template class PointRenderer<2>;
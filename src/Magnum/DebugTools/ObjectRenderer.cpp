@@ -27,6 +27,8 @@
 
 #include "Magnum/Buffer.h"
 #include "Magnum/Mesh.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/DebugTools/RendererBatch.h"
 #include "Magnum/DebugTools/ResourceManager.h"
 #include "Magnum/MeshTools/CompressIndices.h"
 #include "Magnum/MeshTools/Interleave.h"
@@ -36,6 +38,8 @@
 #include "Magnum/Trade/MeshData2D.h"
 #include "Magnum/Trade/MeshData3D.h"
 
+#include "Implementation/ForceRendererMesh.h"
+
 namespace Magnum { namespace DebugTools {
 
 namespace {
@@ -48,6 +52,17 @@ template<> struct Renderer<2> {
     static ResourceKey indexBuffer() { return {"object2d-indices"}; }
     static ResourceKey mesh() { return {"object2d"}; }
     static Trade::MeshData2D meshData() { return Primitives::axis2D(); }
+
+    /* Transformations of the arrow mesh to the axes and their colors, used
+       when batched */
+    static std::array<std::pair<Matrix3, Color4>, 2> axes() {
+        return {{
+            {Matrix3{}, Color4{1.0f, 0.0f, 0.0f}},
+            {Matrix3{{ 0.0f, 1.0f, 0.0f},
+                     {-1.0f, 0.0f, 0.0f},
+                     { 0.0f, 0.0f, 1.0f}}, Color4{0.0f, 1.0f, 0.0f}}
+        }};
+    }
 };
 
 template<> struct Renderer<3> {
@@ -56,12 +71,27 @@ template<> struct Renderer<3> {
     static ResourceKey indexBuffer() { return {"object3d-indices"}; }
     static ResourceKey mesh() { return {"object3d"}; }
     static Trade::MeshData3D meshData() { return Primitives::axis3D(); }
+
+    static std::array<std::pair<Matrix4, Color4>, 3> axes() {
+        return {{
+            {Matrix4{}, Color4{1.0f, 0.0f, 0.0f}},
+            {Matrix4{{ 0.0f, 1.0f, 0.0f, 0.0f},
+                     {-1.0f, 0.0f, 0.0f, 0.0f},
+                     { 0.0f, 0.0f, 1.0f, 0.0f},
+                     { 0.0f, 0.0f, 0.0f, 1.0f}}, Color4{0.0f, 1.0f, 0.0f}},
+            /* The arrow head has to be in the XZ plane to match axis3D() */
+            {Matrix4{{0.0f, 0.0f, 1.0f, 0.0f},
+                     {1.0f, 0.0f, 0.0f, 0.0f},
+                     {0.0f, 1.0f, 0.0f, 0.0f},
+                     {0.0f, 0.0f, 0.0f, 1.0f}}, Color4{0.0f, 0.0f, 1.0f}}
+        }};
+    }
 };
 
 }
 
 /* Doxygen gets confused when using {} to initialize parent object */
-template<UnsignedInt dimensions> ObjectRenderer<dimensions>::ObjectRenderer(SceneGraph::AbstractObject<dimensions, Float>& object, ResourceKey options, SceneGraph::DrawableGroup<dimensions, Float>* drawables): SceneGraph::Drawable<dimensions, Float>(object, drawables), _options{ResourceManager::instance().get<ObjectRendererOptions>(options)} {
+template<UnsignedInt dimensions> ObjectRenderer<dimensions>::ObjectRenderer(SceneGraph::AbstractObject<dimensions, Float>& object, ResourceKey options, SceneGraph::DrawableGroup<dimensions, Float>* drawables): SceneGraph::Drawable<dimensions, Float>(object, drawables), _options{ResourceManager::instance().get<ObjectRendererOptions>(options)}, _batch{} {
     /* Shader */
     _shader = ResourceManager::instance().get<AbstractShaderProgram, Shaders::VertexColor<dimensions>>(Renderer<dimensions>::shader());
     if(!_shader) ResourceManager::instance().set<AbstractShaderProgram>(_shader.key(), new Shaders::VertexColor<dimensions>);
@@ -94,11 +124,29 @@ template<UnsignedInt dimensions> ObjectRenderer<dimensions>::ObjectRenderer(Scen
     ResourceManager::instance().set<Mesh>(_mesh.key(), mesh, ResourceDataState::Final, ResourcePolicy::Manual);
 }
 
+template<UnsignedInt dimensions> ObjectRenderer<dimensions>::ObjectRenderer(SceneGraph::AbstractObject<dimensions, Float>& object, ResourceKey options, RendererBatch<dimensions>& batch): SceneGraph::Drawable<dimensions, Float>(object, &batch), _options{ResourceManager::instance().get<ObjectRendererOptions>(options)}, _batch{&batch} {
+    /* The vertex-colored axis mesh can't be drawn with the batch shader, so
+       the axes are drawn as three instances of the force renderer arrow */
+    _mesh = ResourceManager::instance().get<Mesh>(Implementation::ForceRendererMesh<dimensions>::mesh());
+    _vertexBuffer = ResourceManager::instance().get<Buffer>(Implementation::ForceRendererMesh<dimensions>::vertexBuffer());
+    _indexBuffer = ResourceManager::instance().get<Buffer>(Implementation::ForceRendererMesh<dimensions>::indexBuffer());
+    _instanceBuffer = ResourceManager::instance().get<Buffer>(Implementation::ForceRendererMesh<dimensions>::instanceBuffer());
+    if(!_mesh) Implementation::createForceRendererMesh<dimensions>(_mesh, _vertexBuffer, _indexBuffer, _instanceBuffer);
+}
+
 /* To avoid deleting pointers to incomplete type on destruction of Resource members */
 template<UnsignedInt dimensions> ObjectRenderer<dimensions>::~ObjectRenderer() = default;
 
 template<UnsignedInt dimensions> void ObjectRenderer<dimensions>::draw(const MatrixTypeFor<dimensions, Float>& transformationMatrix, SceneGraph::Camera<dimensions, Float>& camera) {
-    _shader->setTransformationProjectionMatrix(camera.projectionMatrix()*transformationMatrix*MatrixTypeFor<dimensions, Float>::scaling(VectorTypeFor<dimensions, Float>{_options->size()}));
+    const MatrixTypeFor<dimensions, Float> matrix = transformationMatrix*MatrixTypeFor<dimensions, Float>::scaling(VectorTypeFor<dimensions, Float>{_options->size()});
+
+    if(_batch) {
+        for(const auto& axis: Renderer<dimensions>::axes())
+            _batch->add(*_mesh, _instanceBuffer, matrix*axis.first, axis.second);
+        return;
+    }
+
+    _shader->setTransformationProjectionMatrix(camera.projectionMatrix()*matrix);
     _mesh->draw(*_shader);
 }
 
@@ -31,6 +31,7 @@
 
 #include "Magnum/Resource.h"
 #include "Magnum/SceneGraph/Drawable.h"
+#include "Magnum/DebugTools/DebugTools.h"
 #include "Magnum/Shaders/Shaders.h"
 #include "Magnum/DebugTools/visibility.h"
 
@@ -98,6 +99,15 @@ template<UnsignedInt dimensions> class MAGNUM_DEBUGTOOLS_EXPORT ObjectRenderer:
          */
         explicit ObjectRenderer(SceneGraph::AbstractObject<dimensions, Float>& object, ResourceKey options = ResourceKey(), SceneGraph::DrawableGroup<dimensions, Float>* drawables = nullptr);
 
+        /**
+         * @brief Construct a batched renderer
+         *
+         * Like @ref ObjectRenderer(SceneGraph::AbstractObject<dimensions, Float>&, ResourceKey, SceneGraph::DrawableGroup<dimensions, Float>*),
+         * but the axes are drawn as a part of @p batch. See
+         * @ref RendererBatch for more information.
+         */
+        explicit ObjectRenderer(SceneGraph::AbstractObject<dimensions, Float>& object, ResourceKey options, RendererBatch<dimensions>& batch);
+
         ~ObjectRenderer();
 
     private:
@@ -106,7 +116,8 @@ template<UnsignedInt dimensions> class MAGNUM_DEBUGTOOLS_EXPORT ObjectRenderer:
         Resource<ObjectRendererOptions> _options;
         Resource<AbstractShaderProgram, Shaders::VertexColor<dimensions>> _shader;
         Resource<Mesh> _mesh;
-        Resource<Buffer> _vertexBuffer, _indexBuffer;
+        Resource<Buffer> _vertexBuffer, _indexBuffer, _instanceBuffer;
+        RendererBatch<dimensions>* _batch;
 };
 
 /** @brief Two-dimensional object renderer */
@@ -0,0 +1,319 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "PerformanceHud.h"
+
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Context.h"
+#include "Magnum/MemoryTracker.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/Text/GlyphCache.h"
+
+#ifndef MAGNUM_TARGET_WEBGL
+#include "Magnum/DebugTools/FrameProfiler.h"
+#endif
+
+namespace Magnum { namespace DebugTools {
+
+namespace {
+
+/* All colors are premultiplied */
+const Color4 BackgroundColor{0.0f, 0.0f, 0.0f, 0.6f};
+const Color4 BudgetColor{0.5f, 0.5f, 0.5f, 0.5f};
+const Color4 GoodColor{0.3f, 0.8f, 0.3f, 1.0f};
+const Color4 WarningColor{0.9f, 0.8f, 0.2f, 1.0f};
+const Color4 BadColor{0.9f, 0.25f, 0.2f, 1.0f};
+const Color4 CpuColor{0.3f, 0.6f, 1.0f, 1.0f};
+const Color4 GpuColor{1.0f, 0.6f, 0.2f, 1.0f};
+const Color4 TextColor{1.0f};
+
+/* Layout, relative to font size */
+constexpr Float Padding = 0.5f;
+constexpr Float GraphHeight = 4.0f;
+constexpr Float GraphBarWidth = 1.0f/6.0f;
+constexpr Float MinimalWidth = 20.0f;
+constexpr Float RowHeight = 1.5f;
+constexpr Float RowBarHeight = 0.15f;
+constexpr Float RowTextOffset = 0.5f;
+
+template<class T> void addQuad(std::vector<T>& vertices, const Range2D& rectangle, const Color4& color) {
+    vertices.push_back({rectangle.bottomLeft(), color});
+    vertices.push_back({rectangle.bottomRight(), color});
+    vertices.push_back({rectangle.topRight(), color});
+    vertices.push_back({rectangle.bottomLeft(), color});
+    vertices.push_back({rectangle.topRight(), color});
+    vertices.push_back({rectangle.topLeft(), color});
+}
+
+Float milliseconds(const std::chrono::nanoseconds duration) {
+    return duration.count()/1.0e6f;
+}
+
+}
+
+PerformanceHud::PerformanceHud(Text::AbstractFont& font, Text::GlyphCache& cache, const Float fontSize, const std::size_t historySize): _cache(cache), _fontSize{fontSize}, _frameBudget{1.0f/60.0f}, _textUpdateInterval{0.25f}, _memoryBudget{},
+    #ifndef MAGNUM_TARGET_WEBGL
+    _frameProfiler{},
+    #endif
+    _history(historySize), _historyPosition{}, _frameCount{}, _sinceTextUpdate{}, _intervalMaximum{}, _intervalFrameCount{},
+    #ifdef MAGNUM_BUILD_STATISTICS
+    _previousStatistics{Context::current().statistics()}, _intervalStatistics{},
+    #endif
+    _rowCount{}, _vertexBuffer{Buffer::TargetHint::Array}, _vertexCapacity{}, _text{font, cache, fontSize}
+{
+    CORRADE_ASSERT(historySize, "DebugTools::PerformanceHud: expected non-zero history size", );
+
+    _mesh.setPrimitive(MeshPrimitive::Triangles)
+        .addVertexBuffer(_vertexBuffer, 0,
+            Shaders::VertexColor2D::Position{},
+            Shaders::VertexColor2D::Color{Shaders::VertexColor2D::Color::Components::Four});
+
+    /* Lay out the rows so rectangle() is correct from the start */
+    updateText();
+}
+
+PerformanceHud::~PerformanceHud() = default;
+
+PerformanceHud& PerformanceHud::setFrameBudget(const Float seconds) {
+    _frameBudget = seconds;
+    return *this;
+}
+
+PerformanceHud& PerformanceHud::setTextUpdateInterval(const Float seconds) {
+    _textUpdateInterval = seconds;
+    return *this;
+}
+
+#ifndef MAGNUM_TARGET_WEBGL
+PerformanceHud& PerformanceHud::setFrameProfiler(FrameProfiler* const profiler) {
+    _frameProfiler = profiler;
+    updateText();
+    return *this;
+}
+#endif
+
+PerformanceHud& PerformanceHud::setMemoryBudget(const std::size_t bytes) {
+    _memoryBudget = bytes;
+    return *this;
+}
+
+void PerformanceHud::addFrame(const Float duration) {
+    _history[_historyPosition] = duration;
+    _historyPosition = (_historyPosition + 1) % _history.size();
+    ++_frameCount;
+
+    _sinceTextUpdate += duration;
+    _intervalMaximum = Math::max(_intervalMaximum, duration);
+    ++_intervalFrameCount;
+
+    /* Differences to the previous frame. If the counters are lower than
+       previously, they were reset in the meantime. */
+    #ifdef MAGNUM_BUILD_STATISTICS
+    const Context::Statistics& current = Context::current().statistics();
+    auto delta = [](const UnsignedLong current, const UnsignedLong previous) {
+        return current >= previous ? current - previous : current;
+    };
+    _intervalStatistics.drawCallCount += delta(current.drawCallCount, _previousStatistics.drawCallCount);
+    _intervalStatistics.programSwitchCount += delta(current.programSwitchCount, _previousStatistics.programSwitchCount);
+    _intervalStatistics.textureBindCount += delta(current.textureBindCount, _previousStatistics.textureBindCount);
+    _intervalStatistics.bufferUploadSize += delta(current.bufferUploadSize, _previousStatistics.bufferUploadSize);
+    _intervalStatistics.framebufferBindCount += delta(current.framebufferBindCount, _previousStatistics.framebufferBindCount);
+    _previousStatistics = current;
+    #endif
+
+    if(_sinceTextUpdate >= _textUpdateInterval) updateText();
+}
+
+Float PerformanceHud::frameTime() const {
+    if(!_frameCount) return 0.0f;
+    return _history[(_historyPosition + _history.size() - 1) % _history.size()];
+}
+
+Float PerformanceHud::averageFrameTime() const {
+    if(!_frameCount) return 0.0f;
+
+    /* Frames not added yet are zero */
+    Float sum = 0.0f;
+    for(const Float duration: _history) sum += duration;
+    return sum/Math::min(_frameCount, _history.size());
+}
+
+Float PerformanceHud::maximumFrameTime() const {
+    Float maximum = 0.0f;
+    for(const Float duration: _history) maximum = Math::max(maximum, duration);
+    return maximum;
+}
+
+Float PerformanceHud::graphWidth() const {
+    return _history.size()*GraphBarWidth*_fontSize;
+}
+
+Range2D PerformanceHud::rectangle() const {
+    const Float width = Math::max(graphWidth(), MinimalWidth*_fontSize) + 2.0f*Padding*_fontSize;
+    const Float height = (2.0f*Padding + GraphHeight + _rowCount*RowHeight)*_fontSize;
+    return {{}, {width, height}};
+}
+
+void PerformanceHud::updateText() {
+    std::vector<std::string> rows;
+    _bars.clear();
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(2);
+
+    /* Frame times averaged over the interval */
+    if(_intervalFrameCount) {
+        const Float average = _sinceTextUpdate/_intervalFrameCount;
+        out << "frame: " << average*1000.0f << " ms, max "
+            << _intervalMaximum*1000.0f << " ms, "
+            << std::setprecision(1) << (average > 0.0f ? 1.0f/average : 0.0f) << " FPS";
+    } else out << "frame: -";
+    rows.push_back(out.str());
+
+    /* GL call counters per frame */
+    #ifdef MAGNUM_BUILD_STATISTICS
+    {
+        const UnsignedLong frames = Math::max(_intervalFrameCount, 1u);
+        out.str({});
+        out << std::setprecision(1)
+            << "draws: " << _intervalStatistics.drawCallCount/frames
+            << ", programs: " << _intervalStatistics.programSwitchCount/frames
+            << ", textures: " << _intervalStatistics.textureBindCount/frames
+            << ", framebuffers: " << _intervalStatistics.framebufferBindCount/frames
+            << ", upload: " << _intervalStatistics.bufferUploadSize/frames/1024.0f << " kB";
+        rows.push_back(out.str());
+        _intervalStatistics = {};
+    }
+    #endif
+
+    /* GPU memory */
+    {
+        MemoryTracker& tracker = Context::current().memoryTracker();
+        const std::size_t allocated = tracker.allocatedSize();
+        const std::size_t budget = _memoryBudget ? _memoryBudget : tracker.driverTotalMemory();
+        out.str({});
+        out << std::setprecision(1) << "memory: " << allocated/1048576.0f << " MB";
+        if(budget) {
+            const Float ratio = Float(allocated)/budget;
+            out << " / " << budget/1048576.0f << " MB";
+            _bars.push_back({UnsignedInt(rows.size()), 0, ratio, ratio > 0.9f ? BadColor : GoodColor});
+        }
+        rows.push_back(out.str());
+    }
+
+    /* Top-level profiler sections */
+    #ifndef MAGNUM_TARGET_WEBGL
+    if(_frameProfiler) for(FrameProfiler::Section i = 0; i != _frameProfiler->sectionCount(); ++i) {
+        if(_frameProfiler->sectionParent(i) != FrameProfiler::NoParent) continue;
+
+        const Float cpu = milliseconds(_frameProfiler->cpuDuration(i));
+        out.str({});
+        out << std::setprecision(2) << _frameProfiler->sectionName(i) << ": cpu " << cpu << " ms";
+        _bars.push_back({UnsignedInt(rows.size()), 0, cpu/(_frameBudget*1000.0f), CpuColor});
+        if(_frameProfiler->isGpuTimeAvailable()) {
+            const Float gpu = milliseconds(_frameProfiler->gpuDuration(i));
+            out << ", gpu " << gpu << " ms";
+            _bars.push_back({UnsignedInt(rows.size()), 1, gpu/(_frameBudget*1000.0f), GpuColor});
+        }
+        rows.push_back(out.str());
+    }
+    #endif
+
+    _sinceTextUpdate = 0.0f;
+    _intervalMaximum = 0.0f;
+    _intervalFrameCount = 0;
+
+    /* Make sure all text fits, assuming one glyph per byte */
+    std::size_t glyphCount = 0;
+    for(const std::string& row: rows) glyphCount += row.size();
+    if(glyphCount > _text.capacity())
+        _text.reserve(Math::max(UnsignedInt(glyphCount), 2*_text.capacity()), BufferUsage::DynamicDraw, BufferUsage::StaticDraw);
+
+    /* If the rows are the same, update just the text, otherwise lay out
+       everything again */
+    if(rows.size() == _rowCount && _text.labelCount() == _rowCount) {
+        for(UnsignedInt i = 0; i != rows.size(); ++i)
+            _text.setLabelText(i, rows[i]);
+    } else {
+        _rowCount = UnsignedInt(rows.size());
+        _text.clear();
+        for(UnsignedInt i = 0; i != rows.size(); ++i) {
+            const Float y = (Padding + GraphHeight + (_rowCount - i - 1)*RowHeight + RowTextOffset)*_fontSize;
+            _text.addLabel(rows[i], Matrix3::translation({Padding*_fontSize, y}), TextColor);
+        }
+    }
+}
+
+void PerformanceHud::draw(const Matrix3& transformationProjectionMatrix) {
+    const Range2D bounds = rectangle();
+    const Float padding = Padding*_fontSize;
+    const Float graphHeight = GraphHeight*_fontSize;
+    const Float barWidth = GraphBarWidth*_fontSize;
+    const Float rowWidth = bounds.sizeX() - 2.0f*padding;
+
+    _vertices.clear();
+    addQuad(_vertices, bounds, BackgroundColor);
+
+    /* Frame graph, oldest frame first. Budget is in the middle. */
+    for(std::size_t i = 0; i != _history.size(); ++i) {
+        const Float duration = _history[(_historyPosition + i) % _history.size()];
+        if(duration <= 0.0f) continue;
+
+        const Float height = Math::min(duration/(2.0f*_frameBudget), 1.0f)*graphHeight;
+        const Float x = padding + i*barWidth;
+        addQuad(_vertices, {{x, padding}, {x + barWidth, padding + height}},
+            duration > 1.5f*_frameBudget ? BadColor :
+            duration > _frameBudget ? WarningColor : GoodColor);
+    }
+    const Float budget = padding + graphHeight*0.5f;
+    addQuad(_vertices, {{padding, budget}, {padding + graphWidth(), budget + Math::max(1.0f, _fontSize/12.0f)}}, BudgetColor);
+
+    /* Bars in text rows */
+    for(const Bar& bar: _bars) {
+        const Float y = (Padding + GraphHeight + (_rowCount - bar.row - 1)*RowHeight + bar.slot*RowBarHeight*1.5f)*_fontSize;
+        addQuad(_vertices, {{padding, y}, {padding + Math::min(bar.ratio, 1.0f)*rowWidth, y + RowBarHeight*_fontSize}}, bar.color);
+    }
+
+    /* Upload everything at once, reallocating only if it doesn't fit */
+    if(_vertices.size() > _vertexCapacity) {
+        _vertexCapacity = _vertices.size();
+        _vertexBuffer.setData(_vertices, BufferUsage::DynamicDraw);
+    } else _vertexBuffer.setSubData(0, _vertices);
+    _mesh.setCount(_vertices.size());
+
+    _colorShader.setTransformationProjectionMatrix(transformationProjectionMatrix);
+    _mesh.draw(_colorShader);
+
+    _text.update();
+    _textShader.setTransformationProjectionMatrix(transformationProjectionMatrix)
+        .bindVectorTexture(_cache.texture());
+    _text.draw(_textShader);
+}
+
+}}
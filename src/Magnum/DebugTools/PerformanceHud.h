@@ -0,0 +1,294 @@
+#ifndef Magnum_DebugTools_PerformanceHud_h
+#define Magnum_DebugTools_PerformanceHud_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::DebugTools::PerformanceHud
+ */
+
+#include <string>
+#include <vector>
+
+#include "Magnum/Buffer.h"
+#include "Magnum/Mesh.h"
+#include "Magnum/DebugTools/DebugTools.h"
+#include "Magnum/DebugTools/visibility.h"
+#include "Magnum/Shaders/Vector.h"
+#include "Magnum/Shaders/VertexColor.h"
+#include "Magnum/Text/Renderer.h"
+
+#ifdef MAGNUM_BUILD_STATISTICS
+#include "Magnum/Context.h"
+#endif
+
+namespace Magnum { namespace DebugTools {
+
+/**
+@brief On-screen performance overlay
+
+Renders a graph of recent frame times, CPU and GPU time bars of top-level
+@ref FrameProfiler sections, GL call counters and GPU memory use directly
+into the framebuffer, for platforms where console output of
+@ref Profiler::printStatistics() is not accessible. Feed it with frame
+durations once per frame and draw it on top of everything else:
+
+@code{.cpp}
+DebugTools::PerformanceHud hud{*font, *glyphCache, 12.0f};
+hud.setFrameProfiler(&profiler)
+    .setMemoryBudget(512*1024*1024);
+
+// in the draw event
+hud.addFrame(timeline.previousFrameDuration());
+Renderer::enable(Renderer::Feature::Blending);
+hud.draw(Matrix3::projection(Vector2{defaultFramebuffer.viewport().size()})*
+         Matrix3::translation(-Vector2{defaultFramebuffer.viewport().size()}/2.0f));
+@endcode
+
+The overlay is laid out in units equivalent to pixels with a one-to-one
+projection, with origin in its bottom left corner. Use the transformation
+passed to @ref draw() to position it and @ref rectangle() to query its size.
+The glyph cache is expected to contain at least letters, digits and
+punctuation of the font. The colors are premultiplied, so the blending
+function is expected to be @ref Renderer::BlendFunction::One and
+@ref Renderer::BlendFunction::OneMinusSourceAlpha, same as for rendering
+text.
+
+@section DebugTools-PerformanceHud-performance Performance
+
+The overlay is designed to stay enabled in production builds:
+
+-   The frame graph, section bars and background are all in a single mesh
+    of colored quads, regenerated and uploaded with a single
+    @ref Buffer::setSubData() call each frame.
+-   All text is in a single @ref Text::BatchRenderer2D with one color, so it
+    is also drawn with a single draw call. Text is laid out again only once
+    per @ref textUpdateInterval(), showing values averaged over that
+    interval.
+-   Values are gathered from @ref FrameProfiler, @ref MemoryTracker and
+    @ref Context::statistics(), which are already collected, no additional
+    GL queries are issued.
+
+All in all, drawing the overlay costs two draw calls, one buffer upload and
+a few microseconds of CPU time on frames where the text isn't updated.
+
+@section DebugTools-PerformanceHud-counters Counters
+
+If Magnum is built with @ref MAGNUM_BUILD_STATISTICS, the overlay shows
+count of draw calls, program switches and texture binds and the uploaded
+buffer size per frame, calculated as a difference of
+@ref Context::statistics() between consecutive @ref addFrame() calls. It
+works regardless of whether the statistics are reset every frame with
+@ref Context::resetStatistics() or not.
+
+GPU memory is taken from @ref MemoryTracker::allocatedSize() and shown
+against the budget set with @ref setMemoryBudget() or, if no budget is set,
+against @ref MemoryTracker::driverTotalMemory(), if available.
+*/
+class MAGNUM_DEBUGTOOLS_EXPORT PerformanceHud {
+    public:
+        /**
+         * @brief Constructor
+         * @param font          Font
+         * @param cache         Glyph cache
+         * @param fontSize      Font size
+         * @param historySize   Count of frames in the frame graph
+         *
+         * Expects that @p historySize is not zero. Requires a current
+         * OpenGL context.
+         */
+        explicit PerformanceHud(Text::AbstractFont& font, Text::GlyphCache& cache, Float fontSize, std::size_t historySize = 120);
+
+        /** @brief Copying is not allowed */
+        PerformanceHud(const PerformanceHud&) = delete;
+
+        /** @brief Copying is not allowed */
+        PerformanceHud& operator=(const PerformanceHud&) = delete;
+
+        ~PerformanceHud();
+
+        /** @brief Count of frames in the frame graph */
+        std::size_t historySize() const { return _history.size(); }
+
+        /** @brief Frame time budget in seconds */
+        Float frameBudget() const { return _frameBudget; }
+
+        /**
+         * @brief Set frame time budget in seconds
+         * @return Reference to self (for method chaining)
+         *
+         * The budget is shown as a line in the middle of the frame graph,
+         * frames over budget are drawn in yellow and frames over one and
+         * half of the budget in red. Section bars span the whole width of
+         * the overlay at full budget. Default is @cpp 1.0f/60.0f @ce.
+         */
+        PerformanceHud& setFrameBudget(Float seconds);
+
+        /** @brief Text update interval in seconds */
+        Float textUpdateInterval() const { return _textUpdateInterval; }
+
+        /**
+         * @brief Set text update interval in seconds
+         * @return Reference to self (for method chaining)
+         *
+         * Sum of frame durations passed to @ref addFrame() after which the
+         * text is laid out again. Default is @cpp 0.25f @ce.
+         */
+        PerformanceHud& setTextUpdateInterval(Float seconds);
+
+        #if !defined(MAGNUM_TARGET_WEBGL) || defined(DOXYGEN_GENERATING_OUTPUT)
+        /** @brief Frame profiler */
+        FrameProfiler* frameProfiler() const { return _frameProfiler; }
+
+        /**
+         * @brief Set frame profiler
+         * @return Reference to self (for method chaining)
+         *
+         * If non-null, CPU and GPU times of all top-level sections are shown,
+         * averaged as reported by @ref FrameProfiler::cpuDuration() and
+         * @ref FrameProfiler::gpuDuration(). The profiler is expected to
+         * outlive the overlay or be unset before being destroyed. Default
+         * is @cpp nullptr @ce.
+         * @requires_gles Time queries are not available in WebGL.
+         */
+        PerformanceHud& setFrameProfiler(FrameProfiler* profiler);
+        #endif
+
+        /** @brief GPU memory budget in bytes */
+        std::size_t memoryBudget() const { return _memoryBudget; }
+
+        /**
+         * @brief Set GPU memory budget in bytes
+         * @return Reference to self (for method chaining)
+         *
+         * If zero (the default), @ref MemoryTracker::driverTotalMemory() is
+         * used, if available. See @ref DebugTools-PerformanceHud-counters
+         * for more information.
+         */
+        PerformanceHud& setMemoryBudget(std::size_t bytes);
+
+        /**
+         * @brief Add a frame
+         *
+         * Call once per frame with duration of the previous frame in seconds,
+         * for example @ref Timeline::previousFrameDuration(). Updates the
+         * frame graph and, if @ref textUpdateInterval() elapsed since the
+         * last update, the text.
+         */
+        void addFrame(Float duration);
+
+        /** @brief Count of added frames */
+        std::size_t frameCount() const { return _frameCount; }
+
+        /**
+         * @brief Duration of last added frame in seconds
+         *
+         * Returns @cpp 0.0f @ce if no frame was added yet.
+         */
+        Float frameTime() const;
+
+        /**
+         * @brief Average frame duration in seconds
+         *
+         * Average of the frames currently in the graph. Returns
+         * @cpp 0.0f @ce if no frame was added yet.
+         */
+        Float averageFrameTime() const;
+
+        /**
+         * @brief Maximal frame duration in seconds
+         *
+         * Maximum of the frames currently in the graph. Returns
+         * @cpp 0.0f @ce if no frame was added yet.
+         */
+        Float maximumFrameTime() const;
+
+        /**
+         * @brief Overlay rectangle
+         *
+         * Bounds of the overlay before applying the transformation passed
+         * to @ref draw(). The height depends on the count of shown rows, so
+         * it changes when a profiler is set or its sections change.
+         */
+        Range2D rectangle() const;
+
+        /**
+         * @brief Draw the overlay
+         * @param transformationProjectionMatrix Transformation and
+         *      projection matrix
+         *
+         * Uploads the frame graph and bars and draws them, then draws the
+         * text. See @ref DebugTools-PerformanceHud-performance for more
+         * information.
+         */
+        void draw(const Matrix3& transformationProjectionMatrix);
+
+    private:
+        struct Vertex {
+            Vector2 position;
+            Color4 color;
+        };
+
+        /* Bar in a text row, slot 0 is the lower one, 1 the upper one */
+        struct Bar {
+            UnsignedInt row, slot;
+            Float ratio;
+            Color4 color;
+        };
+
+        void updateText();
+        Float graphWidth() const;
+
+        Text::GlyphCache& _cache;
+        Float _fontSize;
+        Float _frameBudget, _textUpdateInterval;
+        std::size_t _memoryBudget;
+        #ifndef MAGNUM_TARGET_WEBGL
+        FrameProfiler* _frameProfiler;
+        #endif
+
+        std::vector<Float> _history;
+        std::size_t _historyPosition, _frameCount;
+        Float _sinceTextUpdate, _intervalMaximum;
+        UnsignedInt _intervalFrameCount;
+        #ifdef MAGNUM_BUILD_STATISTICS
+        Context::Statistics _previousStatistics, _intervalStatistics;
+        #endif
+
+        UnsignedInt _rowCount;
+        std::vector<Bar> _bars;
+        std::vector<Vertex> _vertices;
+
+        Buffer _vertexBuffer;
+        Mesh _mesh;
+        std::size_t _vertexCapacity;
+        Shaders::VertexColor2D _colorShader;
+        Shaders::Vector2D _textShader;
+        Text::BatchRenderer2D _text;
+};
+
+}}
+
+#endif
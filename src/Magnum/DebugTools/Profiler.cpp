@@ -26,7 +26,6 @@
 #include "Profiler.h"
 
 #include <algorithm>
-#include <numeric>
 #include <Corrade/Utility/Assert.h>
 #include <Corrade/Utility/Debug.h>
 
@@ -36,12 +35,31 @@ using namespace std::chrono;
 
 namespace Magnum { namespace DebugTools {
 
+Profiler::Profiler(): _enabled(false), _measureDuration(60), _currentFrame(0), _frameCount(0), _sections{"Other"}, _parents{otherSection}, _currentSection(otherSection) {}
+
+Profiler::~Profiler() = default;
+
 Profiler::Section Profiler::addSection(const std::string& name) {
     CORRADE_ASSERT(!_enabled, "Profiler: cannot add section when profiling is enabled", 0);
     _sections.push_back(name);
+    /* Top-level sections and the "Other" section are their own parents */
+    _parents.push_back(_sections.size()-1);
     return _sections.size()-1;
 }
 
+Profiler::Section Profiler::addSection(const std::string& name, const Section parent) {
+    CORRADE_ASSERT(!_enabled, "Profiler: cannot add section when profiling is enabled", 0);
+    CORRADE_ASSERT(parent < _sections.size(), "Profiler: unknown parent section passed to addSection()", 0);
+    _sections.push_back(name);
+    _parents.push_back(parent);
+    return _sections.size()-1;
+}
+
+Profiler::Recorder& Profiler::addRecorder(const std::size_t capacity) {
+    _recorders.emplace_back(new Recorder{*this, capacity});
+    return *_recorders.back();
+}
+
 void Profiler::setMeasureDuration(std::size_t frames) {
     CORRADE_ASSERT(!_enabled, "Profiler: cannot set measure duration when profiling is enabled", );
     _measureDuration = frames;
@@ -52,6 +70,7 @@ void Profiler::enable() {
     _frameData.assign(_measureDuration*_sections.size(), high_resolution_clock::duration::zero());
     _totalData.assign(_sections.size(), high_resolution_clock::duration::zero());
     _frameCount = 0;
+    _nested.clear();
 }
 
 void Profiler::disable() {
@@ -75,6 +94,27 @@ void Profiler::stop() {
     _previousTime = high_resolution_clock::time_point();
 }
 
+void Profiler::begin(const Section section) {
+    if(!_enabled) return;
+    CORRADE_ASSERT(section < _sections.size(), "Profiler: unknown section passed to begin()", );
+    CORRADE_ASSERT(_parents[section] != section && _parents[section] == (_nested.empty() ? _currentSection : _nested.back().first),
+        "Profiler: section" << _sections[section] << "is not a child of the running section", );
+
+    _nested.emplace_back(section, high_resolution_clock::now());
+}
+
+void Profiler::end() {
+    if(!_enabled) return;
+    CORRADE_ASSERT(!_nested.empty(), "Profiler: no section begun before calling end()", );
+
+    add(_nested.back().first, high_resolution_clock::now() - _nested.back().second);
+    _nested.pop_back();
+}
+
+void Profiler::add(const Section section, const high_resolution_clock::duration duration) {
+    _frameData[_currentFrame*_sections.size()+section] += duration;
+}
+
 void Profiler::save() {
     auto now = high_resolution_clock::now();
 
@@ -87,7 +127,17 @@ void Profiler::save() {
 }
 
 void Profiler::nextFrame() {
+    /* Drain the recorders even if disabled so they don't overflow */
+    for(const std::unique_ptr<Recorder>& recorder: _recorders) {
+        const std::size_t head = recorder->_head.load(std::memory_order_acquire);
+        std::size_t tail = recorder->_tail.load(std::memory_order_relaxed);
+        for(; tail != head; tail = (tail + 1) % recorder->_data.size())
+            if(_enabled) add(recorder->_data[tail].section, recorder->_data[tail].duration);
+        recorder->_tail.store(tail, std::memory_order_release);
+    }
+
     if(!_enabled) return;
+    CORRADE_ASSERT(_nested.empty(), "Profiler: section" << _sections[_nested.back().first] << "is still running in nextFrame()", );
 
     /* Next frame index */
     std::size_t nextFrame = (_currentFrame+1) % _measureDuration;
@@ -108,17 +158,97 @@ void Profiler::nextFrame() {
     if(_frameCount < _measureDuration) ++_frameCount;
 }
 
+Profiler::Statistics Profiler::statistics(const Section section) const {
+    CORRADE_ASSERT(section < _sections.size(), "Profiler: unknown section passed to statistics()", {});
+
+    /* The current frame occupies one slot of the ring, so at most
+       _measureDuration - 1 finished frames are available, right before it */
+    Statistics out{};
+    const std::size_t count = std::min(_frameCount, _measureDuration - 1);
+    if(!count) return out;
+
+    std::vector<high_resolution_clock::duration> times;
+    times.reserve(count);
+    for(std::size_t i = 0; i != count; ++i) {
+        const std::size_t frame = (_currentFrame + _measureDuration - 1 - i) % _measureDuration;
+        times.push_back(_frameData[frame*_sections.size()+section]);
+    }
+    std::sort(times.begin(), times.end());
+
+    /* Nearest-rank percentiles */
+    for(const high_resolution_clock::duration time: times) out.average += time;
+    out.average /= count;
+    out.minimum = times.front();
+    out.maximum = times.back();
+    out.median = times[(times.size() + 1)/2 - 1];
+    out.percentile99 = times[(times.size()*99 + 99)/100 - 1];
+    return out;
+}
+
+std::size_t Profiler::droppedCount() const {
+    std::size_t count = 0;
+    for(const std::unique_ptr<Recorder>& recorder: _recorders)
+        count += recorder->droppedCount();
+    return count;
+}
+
 void Profiler::printStatistics() {
     if(!_enabled) return;
 
-    std::vector<std::size_t> totalSorted(_sections.size());
-    std::iota(totalSorted.begin(), totalSorted.end(), 0);
+    Debug() << "Statistics for last" << _frameCount << "frames (average, min, max, p50, p99):";
+    printStatistics(otherSection, 1);
+}
+
+void Profiler::printStatistics(const Section parent, const UnsignedInt depth) const {
+    /* Top-level sections have themselves as parents, so they are listed as
+       children of the "Other" section on the first level */
+    std::vector<std::size_t> totalSorted;
+    for(std::size_t i = 0; i != _sections.size(); ++i)
+        if(depth == 1 ? _parents[i] == i : (_parents[i] == parent && i != parent))
+            totalSorted.push_back(i);
 
     std::sort(totalSorted.begin(), totalSorted.end(), [this](std::size_t i, std::size_t j){return _totalData[i] > _totalData[j];});
 
-    Debug() << "Statistics for last" << _measureDuration << "frames:";
-    for(std::size_t i = 0; i != _sections.size(); ++i)
-        Debug() << " " << _sections[totalSorted[i]] << duration_cast<microseconds>(_totalData[totalSorted[i]]).count()/_frameCount << u8"µs";
+    for(const std::size_t i: totalSorted) {
+        const Statistics s = statistics(i);
+        Debug() << std::string(2*depth - 1, ' ') << _sections[i]
+            << duration_cast<microseconds>(s.average).count()
+            << duration_cast<microseconds>(s.minimum).count()
+            << duration_cast<microseconds>(s.maximum).count()
+            << duration_cast<microseconds>(s.median).count()
+            << duration_cast<microseconds>(s.percentile99).count() << u8"µs";
+        printStatistics(i, depth + 1);
+    }
+}
+
+Profiler::Recorder::Recorder(const Profiler& profiler, const std::size_t capacity): _profiler(profiler), _data(capacity + 1) {}
+
+void Profiler::Recorder::begin(const Section section) {
+    CORRADE_ASSERT(section < _profiler._sections.size(), "Profiler::Recorder: unknown section passed to begin()", );
+    CORRADE_ASSERT(_profiler._parents[section] == section || (!_stack.empty() && _profiler._parents[section] == _stack.back().first),
+        "Profiler::Recorder: section" << _profiler._sections[section] << "is not a child of the running section", );
+
+    _stack.emplace_back(section, high_resolution_clock::now());
+}
+
+void Profiler::Recorder::end() {
+    CORRADE_ASSERT(!_stack.empty(), "Profiler::Recorder: no section begun before calling end()", );
+
+    const high_resolution_clock::duration duration = high_resolution_clock::now() - _stack.back().second;
+    const Section section = _stack.back().first;
+    _stack.pop_back();
+
+    /* Single producer, single consumer: only this thread writes the head and
+       only the profiler thread writes the tail */
+    const std::size_t head = _head.load(std::memory_order_relaxed);
+    const std::size_t next = (head + 1) % _data.size();
+    if(next == _tail.load(std::memory_order_acquire)) {
+        _dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    _data[head] = {section, duration};
+    _head.store(next, std::memory_order_release);
 }
 
 }}
@@ -29,8 +29,10 @@
  * @brief Class @ref Magnum::DebugTools::Profiler
  */
 
+#include <atomic>
 #include <chrono>
 #include <initializer_list>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -98,7 +100,35 @@ It's possible to start profiler only for certain parts of the code and then
 stop it again using @ref stop(), if you are not interested in profiling the
 rest.
 
-@todo Some unit testing
+For measuring GPU time see @ref FrameProfiler.
+
+@section DebugTools-Profiler-nested Nested sections
+
+Sections added with a parent using @ref addSection(const std::string&, Section)
+can be measured inside their parent using @ref begin() and @ref end(). Unlike
+@ref start(), these don't end the currently running section, so the parent
+time includes time of its children:
+
+@snippet MagnumDebugTools.cpp Profiler-nested
+
+@section DebugTools-Profiler-threads Measuring other threads
+
+The functions above are meant to be called only from a single thread. For
+measuring sections on worker threads, create a @ref Recorder for each thread
+using @ref addRecorder(). The recorder writes measured durations into a
+lock-free ring buffer without touching any state shared with other threads
+and the profiler collects them in @ref nextFrame(), attributing them to the
+frame that is being finished:
+
+@snippet MagnumDebugTools.cpp Profiler-threads
+
+@section DebugTools-Profiler-statistics Statistics
+
+Besides average, @ref statistics() and @ref printStatistics() report minimal
+and maximal per-frame time of each section and its 50th and 99th percentile
+over the last @ref setMeasureDuration() "measure duration" frames, as
+averages alone hide occasional spikes.
+
 @todo More time intervals
 */
 class MAGNUM_DEBUGTOOLS_EXPORT Profiler {
@@ -117,7 +147,39 @@ class MAGNUM_DEBUGTOOLS_EXPORT Profiler {
          */
         static const Section otherSection = 0;
 
-        explicit Profiler(): _enabled(false), _measureDuration(60), _currentFrame(0), _frameCount(0), _sections{"Other"}, _currentSection(otherSection) {}
+        /**
+         * @brief Section statistics
+         *
+         * @see @ref statistics()
+         */
+        struct Statistics {
+            /** @brief Average time per frame */
+            std::chrono::high_resolution_clock::duration average;
+
+            /** @brief Minimal time per frame */
+            std::chrono::high_resolution_clock::duration minimum;
+
+            /** @brief Maximal time per frame */
+            std::chrono::high_resolution_clock::duration maximum;
+
+            /** @brief Median (50th percentile) of time per frame */
+            std::chrono::high_resolution_clock::duration median;
+
+            /** @brief 99th percentile of time per frame */
+            std::chrono::high_resolution_clock::duration percentile99;
+        };
+
+        class Recorder;
+
+        explicit Profiler();
+
+        /** @brief Copying is not allowed */
+        Profiler(const Profiler&) = delete;
+
+        /** @brief Copying is not allowed */
+        Profiler& operator=(const Profiler&) = delete;
+
+        ~Profiler();
 
         /**
          * @brief Set measure duration
@@ -136,6 +198,27 @@ class MAGNUM_DEBUGTOOLS_EXPORT Profiler {
          */
         Section addSection(const std::string& name);
 
+        /**
+         * @brief Add named nested section
+         *
+         * The section can be measured only using @ref begin() and
+         * @ref Recorder::begin() while @p parent is running. Expects that
+         * @p parent is an already added section.
+         * @attention This function cannot be called if profiling is enabled.
+         */
+        Section addSection(const std::string& name, Section parent);
+
+        /**
+         * @brief Add a recorder for measuring on another thread
+         * @param capacity  Capacity of the ring buffer in measured sections
+         *
+         * The returned reference stays valid for the whole profiler
+         * lifetime. If the recorder measures more sections than @p capacity
+         * between two calls to @ref nextFrame(), the excessive measurements
+         * are dropped and counted in @ref droppedCount().
+         */
+        Recorder& addRecorder(std::size_t capacity = 1024);
+
         /**
          * @brief Whether profiling is enabled
          *
@@ -184,6 +267,24 @@ class MAGNUM_DEBUGTOOLS_EXPORT Profiler {
          */
         void stop();
 
+        /**
+         * @brief Begin nested section
+         *
+         * Expects that the section was added with a parent and the parent is
+         * either currently started using @ref start() or begun using
+         * @ref begin(). Doesn't end currently running section.
+         * @note Does nothing if profiling is disabled.
+         */
+        void begin(Section section);
+
+        /**
+         * @brief End nested section
+         *
+         * Expects that a section was begun using @ref begin().
+         * @note Does nothing if profiling is disabled.
+         */
+        void end();
+
         /**
          * @brief Save data from previous frame and advance to another
          *
@@ -192,24 +293,114 @@ class MAGNUM_DEBUGTOOLS_EXPORT Profiler {
          */
         void nextFrame();
 
+        /**
+         * @brief Count of measured frames
+         *
+         * At most the measure duration.
+         */
+        std::size_t frameCount() const { return _frameCount; }
+
+        /**
+         * @brief Statistics of given section
+         *
+         * Calculated from the finished frames, at most one less than the
+         * measure duration. If no frame was finished yet, all values are
+         * zero.
+         */
+        Statistics statistics(Section section) const;
+
+        /**
+         * @brief Count of dropped measurements
+         *
+         * Sum of all measurements dropped by recorders because their ring
+         * buffer was full.
+         * @see @ref addRecorder()
+         */
+        std::size_t droppedCount() const;
+
         /**
          * @brief Print statistics
          *
-         * Prints statistics about previous frame ordered by duration.
+         * Prints average, minimum, maximum, 50th and 99th percentile of each
+         * section over previous frames ordered by average duration, with
+         * nested sections indented under their parents.
          * @note Does nothing if profiling is disabled.
          */
         void printStatistics();
 
     private:
         void save();
+        void add(Section section, std::chrono::high_resolution_clock::duration duration);
+        void printStatistics(Section parent, UnsignedInt depth) const;
 
         bool _enabled;
         std::size_t _measureDuration, _currentFrame, _frameCount;
         std::vector<std::string> _sections;
+        std::vector<Section> _parents;
         std::vector<std::chrono::high_resolution_clock::duration> _frameData;
         std::vector<std::chrono::high_resolution_clock::duration> _totalData;
         std::chrono::high_resolution_clock::time_point _previousTime;
         Section _currentSection;
+        std::vector<std::pair<Section, std::chrono::high_resolution_clock::time_point>> _nested;
+        std::vector<std::unique_ptr<Recorder>> _recorders;
+};
+
+/**
+@brief Profiler recorder
+
+Measures sections on a thread different from the one calling
+@ref Profiler::nextFrame(). Created using @ref Profiler::addRecorder(). Each
+instance is expected to be used by only one thread at a time. Measured
+durations are passed to the profiler through a single-producer
+single-consumer lock-free ring buffer.
+*/
+class MAGNUM_DEBUGTOOLS_EXPORT Profiler::Recorder {
+    public:
+        #ifndef DOXYGEN_GENERATING_OUTPUT
+        explicit Recorder(const Profiler& profiler, std::size_t capacity);
+        #endif
+
+        /** @brief Copying is not allowed */
+        Recorder(const Recorder&) = delete;
+
+        /** @brief Copying is not allowed */
+        Recorder& operator=(const Recorder&) = delete;
+
+        /** @brief Ring buffer capacity */
+        std::size_t capacity() const { return _data.size() - 1; }
+
+        /**
+         * @brief Begin a section
+         *
+         * Expects that the section is either top-level or its parent is
+         * currently begun on this recorder. Sections can be nested.
+         */
+        void begin(Section section);
+
+        /**
+         * @brief End a section
+         *
+         * Expects that a section was begun using @ref begin(). The duration
+         * is attributed to the frame that gets finished by next call to
+         * @ref Profiler::nextFrame().
+         */
+        void end();
+
+        /** @brief Count of measurements dropped because the buffer was full */
+        std::size_t droppedCount() const { return _dropped.load(std::memory_order_relaxed); }
+
+    private:
+        friend Profiler;
+
+        struct Measurement {
+            Section section;
+            std::chrono::high_resolution_clock::duration duration;
+        };
+
+        const Profiler& _profiler;
+        std::vector<Measurement> _data;
+        std::atomic<std::size_t> _head{}, _tail{}, _dropped{};
+        std::vector<std::pair<Section, std::chrono::high_resolution_clock::time_point>> _stack;
 };
 
 }}
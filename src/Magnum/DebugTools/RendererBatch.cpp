@@ -0,0 +1,180 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "RendererBatch.h"
+
+#include "Magnum/Buffer.h"
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/Mesh.h"
+#include "Magnum/MeshView.h"
+#include "Magnum/DebugTools/ResourceManager.h"
+#include "Magnum/SceneGraph/Camera.h"
+#include "Magnum/Shaders/Flat.h"
+
+#include "Implementation/InstanceBuffer.h"
+
+namespace Magnum { namespace DebugTools {
+
+namespace Implementation {
+
+bool isInstancingSupported() {
+    #ifndef MAGNUM_TARGET_GLES
+    return Context::current().isExtensionSupported<Extensions::GL::ARB::instanced_arrays>();
+    #elif defined(MAGNUM_TARGET_GLES2)
+    return Context::current().isExtensionSupported<Extensions::GL::ANGLE::instanced_arrays>()
+        #ifndef MAGNUM_TARGET_WEBGL
+        || (Context::current().isExtensionSupported<Extensions::GL::EXT::instanced_arrays>() &&
+            Context::current().isExtensionSupported<Extensions::GL::EXT::draw_instanced>())
+        || (Context::current().isExtensionSupported<Extensions::GL::NV::instanced_arrays>() &&
+            Context::current().isExtensionSupported<Extensions::GL::NV::draw_instanced>())
+        #endif
+        ;
+    #else
+    return true;
+    #endif
+}
+
+template<UnsignedInt dimensions> void createInstanceBuffer(Mesh& mesh, Resource<Buffer>& instanceBufferResource) {
+    if(!isInstancingSupported()) return;
+
+    /* The data are uploaded by RendererBatch::draw() every frame */
+    Buffer* instanceBuffer = new Buffer{Buffer::TargetHint::Array};
+    mesh.addVertexBufferInstanced(*instanceBuffer, 1, 0,
+        typename Shaders::Flat<dimensions>::TransformationMatrix{},
+        typename Shaders::Flat<dimensions>::Color{Shaders::Flat<dimensions>::Color::Components::Four});
+    ResourceManager::instance().set(instanceBufferResource.key(), instanceBuffer, ResourceDataState::Final, ResourcePolicy::Manual);
+}
+
+template void createInstanceBuffer<2>(Mesh&, Resource<Buffer>&);
+template void createInstanceBuffer<3>(Mesh&, Resource<Buffer>&);
+
+}
+
+namespace {
+
+template<UnsignedInt dimensions> ResourceKey shaderKey();
+template<> inline ResourceKey shaderKey<2>() { return ResourceKey("FlatShader2D"); }
+template<> inline ResourceKey shaderKey<3>() { return ResourceKey("FlatShader3D"); }
+
+template<UnsignedInt dimensions> ResourceKey instancedShaderKey();
+template<> inline ResourceKey instancedShaderKey<2>() { return ResourceKey("FlatShaderInstanced2D"); }
+template<> inline ResourceKey instancedShaderKey<3>() { return ResourceKey("FlatShaderInstanced3D"); }
+
+}
+
+template<UnsignedInt dimensions> RendererBatch<dimensions>::RendererBatch(): _instanceCount{}, _drawCallCount{} {
+    _shader = ResourceManager::instance().get<AbstractShaderProgram, Shaders::Flat<dimensions>>(shaderKey<dimensions>());
+    if(!_shader) ResourceManager::instance().set<AbstractShaderProgram>(_shader.key(),
+        new Shaders::Flat<dimensions>, ResourceDataState::Final, ResourcePolicy::Resident);
+
+    if(!Implementation::isInstancingSupported()) return;
+
+    _instancedShader = ResourceManager::instance().get<AbstractShaderProgram, Shaders::Flat<dimensions>>(instancedShaderKey<dimensions>());
+    if(!_instancedShader) ResourceManager::instance().set<AbstractShaderProgram>(_instancedShader.key(),
+        new Shaders::Flat<dimensions>{typename Shaders::Flat<dimensions>::Flags{Shaders::Flat<dimensions>::Flag::InstancedTransformation}|Shaders::Flat<dimensions>::Flag::InstancedColor},
+        ResourceDataState::Final, ResourcePolicy::Resident);
+}
+
+/* To avoid deleting pointers to incomplete type on destruction of Resource members */
+template<UnsignedInt dimensions> RendererBatch<dimensions>::~RendererBatch() = default;
+
+template<UnsignedInt dimensions> void RendererBatch<dimensions>::add(Mesh& mesh, Buffer* const instanceBuffer, const MatrixTypeFor<dimensions, Float>& transformationMatrix, const Color4& color) {
+    addInternal(&mesh, nullptr, instanceBuffer, transformationMatrix, color);
+}
+
+template<UnsignedInt dimensions> void RendererBatch<dimensions>::add(MeshView& mesh, Buffer* const instanceBuffer, const MatrixTypeFor<dimensions, Float>& transformationMatrix, const Color4& color) {
+    addInternal(nullptr, &mesh, instanceBuffer, transformationMatrix, color);
+}
+
+template<UnsignedInt dimensions> void RendererBatch<dimensions>::addInternal(Mesh* const mesh, MeshView* const view, Buffer* const instanceBuffer, const MatrixTypeFor<dimensions, Float>& transformationMatrix, const Color4& color) {
+    /* There's only a handful of primitive types, so linear search is the
+       fastest option */
+    Batch* batch = nullptr;
+    for(Batch& i: _batches) if(i.mesh == mesh && i.view == view) {
+        batch = &i;
+        break;
+    }
+
+    /* Batches are kept across frames to avoid reallocating the instance
+       arrays */
+    if(!batch) {
+        _batches.push_back({mesh, view, instanceBuffer, {}});
+        batch = &_batches.back();
+
+    /* The mesh resource might have been recreated since the last frame at the
+       same address */
+    } else if(batch->instances.empty()) batch->instanceBuffer = instanceBuffer;
+
+    batch->instances.push_back({transformationMatrix, color});
+}
+
+template<UnsignedInt dimensions> std::size_t RendererBatch<dimensions>::draw(SceneGraph::Camera<dimensions, Float>& camera) {
+    for(Batch& batch: _batches) batch.instances.clear();
+    _instanceCount = 0;
+    _drawCallCount = 0;
+
+    /* Collect the instances */
+    camera.draw(*this);
+
+    if(_instancedShader)
+        _instancedShader->setTransformationProjectionMatrix(camera.projectionMatrix());
+
+    for(Batch& batch: _batches) {
+        if(batch.instances.empty()) continue;
+        _instanceCount += batch.instances.size();
+
+        /* Single instanced draw call */
+        if(_instancedShader && batch.instanceBuffer) {
+            batch.instanceBuffer->setData(batch.instances, BufferUsage::StreamDraw);
+            const Int count = Int(batch.instances.size());
+            if(batch.view) batch.view->setInstanceCount(count)
+                .draw(*_instancedShader);
+            else batch.mesh->setInstanceCount(count)
+                .draw(*_instancedShader);
+            ++_drawCallCount;
+
+            /* Reset the instance count back so the mesh can be drawn
+               non-batched again */
+            if(batch.view) batch.view->setInstanceCount(1);
+            else batch.mesh->setInstanceCount(1);
+
+        /* Fallback, draw the instances one by one */
+        } else for(const InstanceData& instance: batch.instances) {
+            _shader->setTransformationProjectionMatrix(camera.projectionMatrix()*instance.transformationMatrix)
+                .setColor(instance.color);
+            if(batch.view) batch.view->draw(*_shader);
+            else batch.mesh->draw(*_shader);
+            ++_drawCallCount;
+        }
+    }
+
+    return _drawCallCount;
+}
+
+template class RendererBatch<2>;
+template class RendererBatch<3>;
+
+}}
@@ -0,0 +1,155 @@
+#ifndef Magnum_DebugTools_RendererBatch_h
+#define Magnum_DebugTools_RendererBatch_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::DebugTools::RendererBatch, typedef @ref Magnum::DebugTools::RendererBatch2D, @ref Magnum::DebugTools::RendererBatch3D
+ */
+
+#include <vector>
+
+#include "Magnum/Resource.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/SceneGraph/Drawable.h"
+#include "Magnum/Shaders/Shaders.h"
+#include "Magnum/DebugTools/visibility.h"
+
+namespace Magnum { namespace DebugTools {
+
+/**
+@brief Batch of debug renderers
+
+Drawable group for @ref ObjectRenderer, @ref ForceRenderer and
+@ref ShapeRenderer instances. Renderers added to the batch don't draw
+themselves, instead they put their primitives into per-mesh instance lists,
+which are then streamed into an instance buffer and drawn with a single
+instanced draw call for each primitive type. Drawing thousands of debugged
+objects thus costs only a handful of draw calls instead of one or more draw
+calls per object.
+
+@section DebugTools-RendererBatch-usage Basic usage
+
+Create the batch instead of a plain @ref SceneGraph::DrawableGroup and pass it
+to the renderer constructors. The batch has to be drawn using @ref draw(), as
+drawing the group via @ref SceneGraph::Camera::draw() only collects the
+instances:
+
+@code{.cpp}
+DebugTools::RendererBatch3D debugBatch;
+
+for(Object3D* object: objects)
+    new DebugTools::ObjectRenderer3D{*object, "my", debugBatch};
+
+// ...
+debugBatch.draw(camera);
+@endcode
+
+All primitives are drawn using @ref Shaders::Flat with
+@ref Shaders::Flat::Flag::InstancedTransformation and
+@ref Shaders::Flat::Flag::InstancedColor. If instanced drawing isn't
+supported, the collected instances are drawn one by one, which is still
+cheaper than drawing the renderers separately, as the shader and mesh state
+is changed only once per primitive type.
+
+@see @ref RendererBatch2D, @ref RendererBatch3D
+@requires_gl33 Extension @extension{ARB,instanced_arrays} for instanced
+    drawing, falls back to separate draw calls otherwise.
+@requires_gles30 Extension @extension{ANGLE,instanced_arrays},
+    @extension{EXT,instanced_arrays} or @extension{NV,instanced_arrays} in
+    OpenGL ES 2.0 for instanced drawing, falls back to separate draw calls
+    otherwise.
+@requires_webgl20 Extension @webgl_extension{ANGLE,instanced_arrays} in WebGL
+    1.0 for instanced drawing, falls back to separate draw calls otherwise.
+*/
+template<UnsignedInt dimensions> class MAGNUM_DEBUGTOOLS_EXPORT RendererBatch: public SceneGraph::DrawableGroup<dimensions, Float> {
+    public:
+        /** @brief Constructor */
+        explicit RendererBatch();
+
+        ~RendererBatch();
+
+        /**
+         * @brief Instance count
+         *
+         * Count of primitives collected by last call to @ref draw().
+         */
+        std::size_t instanceCount() const { return _instanceCount; }
+
+        /**
+         * @brief Draw call count
+         *
+         * Count of draw calls issued by last call to @ref draw().
+         */
+        std::size_t drawCallCount() const { return _drawCallCount; }
+
+        /**
+         * @brief Draw the batch
+         * @return Count of issued draw calls
+         *
+         * Collects primitives of all renderers in the batch using
+         * @ref SceneGraph::Camera::draw(), uploads them with
+         * @ref BufferUsage::StreamDraw and draws each primitive type with a
+         * single instanced draw call.
+         */
+        std::size_t draw(SceneGraph::Camera<dimensions, Float>& camera);
+
+        #ifndef DOXYGEN_GENERATING_OUTPUT
+        /* Used by the renderers to submit their primitives. The
+           transformation is relative to the camera, instance buffer is
+           nullptr if instancing is not supported. */
+        void add(Mesh& mesh, Buffer* instanceBuffer, const MatrixTypeFor<dimensions, Float>& transformationMatrix, const Color4& color);
+        void add(MeshView& mesh, Buffer* instanceBuffer, const MatrixTypeFor<dimensions, Float>& transformationMatrix, const Color4& color);
+        #endif
+
+    private:
+        struct InstanceData {
+            MatrixTypeFor<dimensions, Float> transformationMatrix;
+            Color4 color;
+        };
+
+        struct Batch {
+            Mesh* mesh;
+            MeshView* view;
+            Buffer* instanceBuffer;
+            std::vector<InstanceData> instances;
+        };
+
+        void addInternal(Mesh* mesh, MeshView* view, Buffer* instanceBuffer, const MatrixTypeFor<dimensions, Float>& transformationMatrix, const Color4& color);
+
+        Resource<AbstractShaderProgram, Shaders::Flat<dimensions>> _shader, _instancedShader;
+        std::vector<Batch> _batches;
+        std::size_t _instanceCount, _drawCallCount;
+};
+
+/** @brief Two-dimensional renderer batch */
+typedef RendererBatch<2> RendererBatch2D;
+
+/** @brief Three-dimensional renderer batch */
+typedef RendererBatch<3> RendererBatch3D;
+
+}}
+
+#endif
@@ -25,6 +25,7 @@
 
 #include "ShapeRenderer.h"
 
+#include "Magnum/DebugTools/RendererBatch.h"
 #include "Magnum/DebugTools/ResourceManager.h"
 #include "Magnum/Shapes/Composition.h"
 #include "Magnum/Shapes/Shape.h"
@@ -114,7 +115,11 @@ template<> void createDebugMesh(ShapeRenderer<3>& renderer, const Shapes::Implem
 
 }
 
-template<UnsignedInt dimensions> ShapeRenderer<dimensions>::ShapeRenderer(Shapes::AbstractShape<dimensions>& shape, ResourceKey options, SceneGraph::DrawableGroup<dimensions, Float>* drawables): SceneGraph::Drawable<dimensions, Float>(shape.object(), drawables), _options(ResourceManager::instance().get<ShapeRendererOptions>(options)) {
+template<UnsignedInt dimensions> ShapeRenderer<dimensions>::ShapeRenderer(Shapes::AbstractShape<dimensions>& shape, ResourceKey options, SceneGraph::DrawableGroup<dimensions, Float>* drawables): SceneGraph::Drawable<dimensions, Float>(shape.object(), drawables), _options(ResourceManager::instance().get<ShapeRendererOptions>(options)), _batch{} {
+    Implementation::createDebugMesh(*this, Shapes::Implementation::getAbstractShape(shape));
+}
+
+template<UnsignedInt dimensions> ShapeRenderer<dimensions>::ShapeRenderer(Shapes::AbstractShape<dimensions>& shape, ResourceKey options, RendererBatch<dimensions>& batch): SceneGraph::Drawable<dimensions, Float>(shape.object(), &batch), _options(ResourceManager::instance().get<ShapeRendererOptions>(options)), _batch{&batch} {
     Implementation::createDebugMesh(*this, Shapes::Implementation::getAbstractShape(shape));
 }
 
@@ -123,8 +128,9 @@ template<UnsignedInt dimensions> ShapeRenderer<dimensions>::~ShapeRenderer() {
 }
 
 template<UnsignedInt dimensions> void ShapeRenderer<dimensions>::draw(const MatrixTypeFor<dimensions, Float>&, SceneGraph::Camera<dimensions, Float>& camera) {
-    const MatrixTypeFor<dimensions, Float> projectionMatrix = camera.projectionMatrix()*camera.cameraMatrix();
-    for(auto i: _renderers) i->draw(_options, projectionMatrix);
+    /* The batch applies the projection matrix on its own */
+    const MatrixTypeFor<dimensions, Float> projectionMatrix = _batch ? camera.cameraMatrix() : camera.projectionMatrix()*camera.cameraMatrix();
+    for(auto i: _renderers) i->draw(_options, projectionMatrix, _batch);
 }
 
 template class ShapeRenderer<2>;
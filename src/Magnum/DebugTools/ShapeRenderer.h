@@ -32,6 +32,7 @@
 #include "Magnum/Resource.h"
 #include "Magnum/Math/Color.h"
 #include "Magnum/SceneGraph/Drawable.h"
+#include "Magnum/DebugTools/DebugTools.h"
 #include "Magnum/Shapes/Shapes.h"
 #include "Magnum/Shapes/shapeImplementation.h"
 #include "Magnum/DebugTools/visibility.h"
@@ -158,6 +159,15 @@ template<UnsignedInt dimensions> class MAGNUM_DEBUGTOOLS_EXPORT ShapeRenderer: p
          */
         explicit ShapeRenderer(Shapes::AbstractShape<dimensions>& shape, ResourceKey options = ResourceKey(), SceneGraph::DrawableGroup<dimensions, Float>* drawables = nullptr);
 
+        /**
+         * @brief Construct a batched renderer
+         *
+         * Like @ref ShapeRenderer(Shapes::AbstractShape<dimensions>&, ResourceKey, SceneGraph::DrawableGroup<dimensions, Float>*),
+         * but the shape is drawn as a part of @p batch. See
+         * @ref RendererBatch for more information.
+         */
+        explicit ShapeRenderer(Shapes::AbstractShape<dimensions>& shape, ResourceKey options, RendererBatch<dimensions>& batch);
+
         ~ShapeRenderer();
 
     private:
@@ -165,6 +175,7 @@ template<UnsignedInt dimensions> class MAGNUM_DEBUGTOOLS_EXPORT ShapeRenderer: p
 
         Resource<ShapeRendererOptions> _options;
         std::vector<Implementation::AbstractShapeRenderer<dimensions>*> _renderers;
+        RendererBatch<dimensions>* _batch;
 };
 
 /** @brief Two-dimensional shape renderer */
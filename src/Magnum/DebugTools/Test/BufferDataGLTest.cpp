@@ -35,11 +35,24 @@ struct BufferDataGLTest: Magnum::OpenGLTester {
 
     void data();
     void subData();
+
+    #ifndef MAGNUM_TARGET_GLES2
+    void dataAsync();
+    void subDataAsync();
+    void emptyAsync();
+    #endif
 };
 
 BufferDataGLTest::BufferDataGLTest() {
     addTests({&BufferDataGLTest::data,
-              &BufferDataGLTest::subData});
+              &BufferDataGLTest::subData,
+
+              #ifndef MAGNUM_TARGET_GLES2
+              &BufferDataGLTest::dataAsync,
+              &BufferDataGLTest::subDataAsync,
+              &BufferDataGLTest::emptyAsync,
+              #endif
+              });
 }
 
 namespace {
@@ -64,6 +77,52 @@ void BufferDataGLTest::subData() {
         TestSuite::Compare::Container);
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+void BufferDataGLTest::dataAsync() {
+    Buffer buffer;
+    buffer.setData(Data, BufferUsage::StaticDraw);
+    AsyncBufferData readback = bufferDataAsync(buffer);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(readback.size(), sizeof(Data));
+
+    /* Modifying the source buffer after the copy doesn't affect the result */
+    constexpr Int Zeros[5]{};
+    buffer.setData(Zeros, BufferUsage::StaticDraw);
+
+    const Containers::Array<Int> contents = readback.data<Int>();
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(readback.isReady());
+    CORRADE_COMPARE_AS(contents, Containers::arrayView(Data),
+        TestSuite::Compare::Container);
+}
+
+void BufferDataGLTest::subDataAsync() {
+    Buffer buffer;
+    buffer.setData(Data, BufferUsage::StaticDraw);
+    AsyncBufferData readback = bufferSubDataAsync<Int>(buffer, 4, 3);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(readback.size(), 3*sizeof(Int));
+
+    readback.wait();
+    CORRADE_VERIFY(readback.isReady());
+    const Containers::Array<Int> contents = readback.data<Int>();
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE_AS(contents, Containers::arrayView(Data).slice(1, 4),
+        TestSuite::Compare::Container);
+}
+
+void BufferDataGLTest::emptyAsync() {
+    Buffer buffer;
+    buffer.setData(Data, BufferUsage::StaticDraw);
+    AsyncBufferData readback = bufferSubDataAsync<Int>(buffer, 4, 0);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /* Nothing to wait for */
+    CORRADE_VERIFY(readback.isReady());
+    CORRADE_VERIFY(!readback.data<Int>());
+}
+#endif
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::DebugTools::Test::BufferDataGLTest)
@@ -25,11 +25,13 @@
 
 #include <sstream>
 #include <numeric>
+#include <Corrade/Containers/Array.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
 
 #include "Magnum/ImageView.h"
 #include "Magnum/PixelFormat.h"
+#include "Magnum/ThreadPool.h"
 #include "Magnum/DebugTools/CompareImage.h"
 #include "Magnum/Math/Functions.h"
 #include "Magnum/Math/Color.h"
@@ -41,6 +43,8 @@ struct CompareImageTest: TestSuite::Tester {
 
     void calculateDelta();
     void calculateDeltaStorage();
+    void withinThresholds();
+    void withinThresholdsThreaded();
 
     void deltaImage();
     void deltaImageScaling();
@@ -56,11 +60,14 @@ struct CompareImageTest: TestSuite::Tester {
     void compareAboveThresholds();
     void compareAboveMaxThreshold();
     void compareAboveMeanThreshold();
+    void compareThreaded();
 };
 
 CompareImageTest::CompareImageTest() {
     addTests({&CompareImageTest::calculateDelta,
               &CompareImageTest::calculateDeltaStorage,
+              &CompareImageTest::withinThresholds,
+              &CompareImageTest::withinThresholdsThreaded,
 
               &CompareImageTest::deltaImage,
               &CompareImageTest::deltaImageScaling,
@@ -75,7 +82,8 @@ CompareImageTest::CompareImageTest() {
               &CompareImageTest::compareSameZeroThreshold,
               &CompareImageTest::compareAboveThresholds,
               &CompareImageTest::compareAboveMaxThreshold,
-              &CompareImageTest::compareAboveMeanThreshold});
+              &CompareImageTest::compareAboveMeanThreshold,
+              &CompareImageTest::compareThreaded});
 }
 
 namespace {
@@ -162,6 +170,49 @@ void CompareImageTest::calculateDeltaStorage() {
     CORRADE_COMPARE(mean, 18.5f);
 }
 
+void CompareImageTest::withinThresholds() {
+    /* Max delta is 39, mean 18.5 */
+    CORRADE_VERIFY(Implementation::isImageDeltaWithinThresholds(ActualRgb, ExpectedRgb, 39.0f, 18.5f, nullptr));
+    CORRADE_VERIFY(!Implementation::isImageDeltaWithinThresholds(ActualRgb, ExpectedRgb, 38.9f, 18.5f, nullptr));
+    CORRADE_VERIFY(!Implementation::isImageDeltaWithinThresholds(ActualRgb, ExpectedRgb, 39.0f, 18.4f, nullptr));
+
+    CORRADE_VERIFY(Implementation::isImageDeltaWithinThresholds(ActualRed, ExpectedRed, 1.0f, 0.21f, nullptr));
+    CORRADE_VERIFY(!Implementation::isImageDeltaWithinThresholds(ActualRed, ExpectedRed, 0.5f, 0.21f, nullptr));
+}
+
+namespace {
+    /* A gradient with a few rows differing, large enough to be split into
+       multiple chunks */
+    Containers::Array<UnsignedByte> gradientData(const Vector2i& size, const Int differentRow, const UnsignedByte difference) {
+        Containers::Array<UnsignedByte> data{std::size_t(size.product()*4)};
+        for(Int y = 0; y != size.y(); ++y) for(Int x = 0; x != size.x(); ++x) {
+            UnsignedByte* const pixel = data.data() + (y*size.x() + x)*4;
+            pixel[0] = UnsignedByte(x);
+            pixel[1] = UnsignedByte(y);
+            pixel[2] = 0x40 + (y == differentRow ? difference : 0);
+            pixel[3] = 0xff;
+        }
+        return data;
+    }
+}
+
+void CompareImageTest::withinThresholdsThreaded() {
+    const Vector2i size{512, 300};
+    const Containers::Array<UnsignedByte> expectedData = gradientData(size, -1, 0);
+    const Containers::Array<UnsignedByte> actualData = gradientData(size, 277, 16);
+    const ImageView2D expected{PixelFormat::RGBA, PixelType::UnsignedByte, size, expectedData};
+    const ImageView2D actual{PixelFormat::RGBA, PixelType::UnsignedByte, size, actualData};
+
+    ThreadPool pool{4};
+
+    /* Max delta is 16/4 = 4, mean is 4/300 */
+    for(ThreadPool* p: {static_cast<ThreadPool*>(nullptr), &pool}) {
+        CORRADE_VERIFY(Implementation::isImageDeltaWithinThresholds(actual, expected, 4.0f, 0.014f, p));
+        CORRADE_VERIFY(!Implementation::isImageDeltaWithinThresholds(actual, expected, 3.9f, 0.014f, p));
+        CORRADE_VERIFY(!Implementation::isImageDeltaWithinThresholds(actual, expected, 4.0f, 0.013f, p));
+    }
+}
+
 void CompareImageTest::deltaImage() {
     std::ostringstream out;
     Debug d{&out, Debug::Flag::DisableColors};
@@ -390,6 +441,33 @@ void CompareImageTest::compareAboveMeanThreshold() {
         "          [1,0] #5647ec, expected #5610ed (Δ = 18.6667)\n");
 }
 
+void CompareImageTest::compareThreaded() {
+    ThreadPool pool{3};
+
+    const Vector2i size{512, 300};
+    const Containers::Array<UnsignedByte> expectedData = gradientData(size, -1, 0);
+    const Containers::Array<UnsignedByte> actualData = gradientData(size, 13, 40);
+    const ImageView2D expected{PixelFormat::RGBA, PixelType::UnsignedByte, size, expectedData};
+    const ImageView2D actual{PixelFormat::RGBA, PixelType::UnsignedByte, size, actualData};
+
+    CORRADE_VERIFY((TestSuite::Comparator<CompareImage>{10.0f, 0.1f, &pool}(actual, expected)));
+
+    /* The diagnostic is the same as when comparing serially */
+    std::stringstream serialOut, threadedOut;
+    {
+        TestSuite::Comparator<CompareImage> compare{5.0f, 0.1f};
+        CORRADE_VERIFY(!compare(actual, expected));
+        Debug d{&serialOut, Debug::Flag::DisableColors};
+        compare.printErrorMessage(d, "a", "b");
+    } {
+        TestSuite::Comparator<CompareImage> compare{5.0f, 0.1f, &pool};
+        CORRADE_VERIFY(!compare(actual, expected));
+        Debug d{&threadedOut, Debug::Flag::DisableColors};
+        compare.printErrorMessage(d, "a", "b");
+    }
+    CORRADE_COMPARE(threadedOut.str(), serialOut.str());
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::DebugTools::Test::CompareImageTest)
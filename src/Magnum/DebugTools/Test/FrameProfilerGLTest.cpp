@@ -0,0 +1,330 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <thread>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+
+#include "Magnum/DefaultFramebuffer.h"
+#include "Magnum/Renderer.h"
+#include "Magnum/OpenGLTester.h"
+#include "Magnum/DebugTools/FrameProfiler.h"
+
+namespace Magnum { namespace DebugTools { namespace Test {
+
+struct FrameProfilerGLTest: Magnum::OpenGLTester {
+    explicit FrameProfilerGLTest();
+
+    void construct();
+    void addSection();
+
+    void cpuTime();
+    void nested();
+    void gpuTime();
+    void gpuTimeLatency();
+    void resetStatistics();
+
+    void printStatistics();
+
+    void trace();
+    void traceGpu();
+    void traceCounterWithoutOutput();
+};
+
+FrameProfilerGLTest::FrameProfilerGLTest() {
+    addTests({&FrameProfilerGLTest::construct,
+              &FrameProfilerGLTest::addSection,
+
+              &FrameProfilerGLTest::cpuTime,
+              &FrameProfilerGLTest::nested,
+              &FrameProfilerGLTest::gpuTime,
+              &FrameProfilerGLTest::gpuTimeLatency,
+              &FrameProfilerGLTest::resetStatistics,
+
+              &FrameProfilerGLTest::printStatistics,
+
+              &FrameProfilerGLTest::trace,
+              &FrameProfilerGLTest::traceGpu,
+              &FrameProfilerGLTest::traceCounterWithoutOutput});
+}
+
+void FrameProfilerGLTest::construct() {
+    FrameProfiler profiler{5};
+    MAGNUM_VERIFY_NO_ERROR();
+
+    CORRADE_COMPARE(profiler.latency(), 5);
+    CORRADE_COMPARE(profiler.sectionCount(), 0);
+    CORRADE_COMPARE(profiler.cpuFrameCount(), 0);
+    CORRADE_COMPARE(profiler.gpuFrameCount(), 0);
+}
+
+void FrameProfilerGLTest::addSection() {
+    FrameProfiler profiler;
+    const FrameProfiler::Section a = profiler.addSection("A");
+    const FrameProfiler::Section b = profiler.addSection("B", a);
+
+    CORRADE_COMPARE(profiler.sectionCount(), 2);
+    CORRADE_COMPARE(profiler.sectionName(a), "A");
+    CORRADE_COMPARE(profiler.sectionParent(a), FrameProfiler::NoParent);
+    CORRADE_COMPARE(profiler.sectionName(b), "B");
+    CORRADE_COMPARE(profiler.sectionParent(b), a);
+
+    /* Nothing measured yet */
+    CORRADE_COMPARE(profiler.cpuDuration(a).count(), 0);
+    CORRADE_COMPARE(profiler.gpuDuration(b).count(), 0);
+    CORRADE_COMPARE(profiler.lastGpuDuration(b).count(), 0);
+}
+
+void FrameProfilerGLTest::cpuTime() {
+    FrameProfiler profiler;
+    const FrameProfiler::Section a = profiler.addSection("A");
+    const FrameProfiler::Section b = profiler.addSection("B");
+
+    for(std::size_t i = 0; i != 2; ++i) {
+        profiler.begin(a);
+        std::this_thread::sleep_for(std::chrono::milliseconds{2});
+        profiler.end();
+        profiler.nextFrame();
+    }
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(profiler.cpuFrameCount(), 2);
+    CORRADE_COMPARE_AS(profiler.cpuDuration(a).count(), 2000000,
+        TestSuite::Compare::GreaterOrEqual);
+    CORRADE_COMPARE(profiler.cpuDuration(b).count(), 0);
+}
+
+void FrameProfilerGLTest::nested() {
+    FrameProfiler profiler;
+    const FrameProfiler::Section parent = profiler.addSection("Parent");
+    const FrameProfiler::Section child = profiler.addSection("Child", parent);
+
+    profiler.begin(parent);
+    std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    profiler.begin(child);
+    std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    profiler.end();
+    /* Same section begun twice in a frame gets summed */
+    profiler.begin(child);
+    std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    profiler.end();
+    profiler.end();
+    profiler.nextFrame();
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE_AS(profiler.cpuDuration(child).count(), 2000000,
+        TestSuite::Compare::GreaterOrEqual);
+    CORRADE_COMPARE_AS(profiler.cpuDuration(parent).count(), profiler.cpuDuration(child).count() + 1000000,
+        TestSuite::Compare::GreaterOrEqual);
+}
+
+void FrameProfilerGLTest::gpuTime() {
+    FrameProfiler profiler{1};
+    if(!profiler.isGpuTimeAvailable())
+        CORRADE_SKIP("Timer queries are not supported.");
+
+    const FrameProfiler::Section clear = profiler.addSection("Clear");
+
+    profiler.begin(clear);
+    for(std::size_t i = 0; i != 16; ++i)
+        defaultFramebuffer.clear(FramebufferClear::Color|FramebufferClear::Depth);
+    profiler.end();
+    Renderer::finish();
+
+    /* With latency of one frame the results are retrieved right away */
+    profiler.nextFrame();
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(profiler.cpuFrameCount(), 1);
+    CORRADE_COMPARE(profiler.gpuFrameCount(), 1);
+    CORRADE_COMPARE_AS(profiler.gpuDuration(clear).count(), 0,
+        TestSuite::Compare::Greater);
+    /* Only one frame, so the last is the same as the average */
+    CORRADE_COMPARE(profiler.lastGpuDuration(clear).count(), profiler.gpuDuration(clear).count());
+}
+
+void FrameProfilerGLTest::gpuTimeLatency() {
+    FrameProfiler profiler{3};
+    if(!profiler.isGpuTimeAvailable())
+        CORRADE_SKIP("Timer queries are not supported.");
+
+    const FrameProfiler::Section clear = profiler.addSection("Clear");
+
+    for(std::size_t i = 0; i != 2; ++i) {
+        profiler.begin(clear);
+        defaultFramebuffer.clear(FramebufferClear::Color);
+        profiler.end();
+        Renderer::finish();
+        profiler.nextFrame();
+    }
+
+    /* GPU times of first frame are retrieved only after third frame */
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(profiler.cpuFrameCount(), 2);
+    CORRADE_COMPARE(profiler.gpuFrameCount(), 0);
+
+    profiler.begin(clear);
+    defaultFramebuffer.clear(FramebufferClear::Color);
+    profiler.end();
+    profiler.nextFrame();
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(profiler.cpuFrameCount(), 3);
+    CORRADE_COMPARE(profiler.gpuFrameCount(), 1);
+}
+
+void FrameProfilerGLTest::resetStatistics() {
+    FrameProfiler profiler;
+    const FrameProfiler::Section a = profiler.addSection("A");
+
+    profiler.begin(a);
+    std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    profiler.end();
+    profiler.nextFrame();
+    CORRADE_COMPARE(profiler.cpuFrameCount(), 1);
+    CORRADE_VERIFY(profiler.cpuDuration(a).count());
+
+    profiler.resetStatistics();
+    CORRADE_COMPARE(profiler.cpuFrameCount(), 0);
+    CORRADE_COMPARE(profiler.gpuFrameCount(), 0);
+    CORRADE_COMPARE(profiler.cpuDuration(a).count(), 0);
+}
+
+void FrameProfilerGLTest::printStatistics() {
+    FrameProfiler profiler;
+    const FrameProfiler::Section draw = profiler.addSection("Draw");
+    profiler.addSection("Physics");
+    const FrameProfiler::Section shadows = profiler.addSection("Shadows", draw);
+
+    profiler.begin(draw);
+    profiler.begin(shadows);
+    profiler.end();
+    profiler.end();
+    profiler.nextFrame();
+
+    std::ostringstream out;
+    {
+        Debug redirectOutput{&out};
+        profiler.printStatistics();
+    }
+
+    /* Children are printed indented right after their parent */
+    const std::string printed = out.str();
+    CORRADE_VERIFY(printed.find("Statistics for 1 frames") == 0);
+    const std::size_t drawPosition = printed.find("\n  Draw CPU");
+    const std::size_t shadowsPosition = printed.find("\n    Shadows CPU");
+    const std::size_t physicsPosition = printed.find("\n  Physics CPU");
+    CORRADE_VERIFY(drawPosition != std::string::npos);
+    CORRADE_VERIFY(shadowsPosition != std::string::npos);
+    CORRADE_VERIFY(physicsPosition != std::string::npos);
+    CORRADE_VERIFY(drawPosition < shadowsPosition);
+    CORRADE_VERIFY(shadowsPosition < physicsPosition);
+}
+
+void FrameProfilerGLTest::trace() {
+    FrameProfiler profiler;
+    const FrameProfiler::Section draw = profiler.addSection("Draw \"all\"");
+
+    /* Section finished before the trace started is not exported */
+    profiler.begin(draw);
+    profiler.end();
+
+    std::ostringstream out;
+    profiler.setTraceOutput(&out);
+    CORRADE_COMPARE(profiler.traceOutput(), &out);
+
+    profiler.begin(draw);
+    profiler.end();
+    profiler.addCounter("Draw calls", 42);
+    profiler.nextFrame();
+
+    profiler.setTraceOutput(nullptr);
+    CORRADE_VERIFY(!profiler.traceOutput());
+    MAGNUM_VERIFY_NO_ERROR();
+
+    const std::string trace = out.str();
+    CORRADE_VERIFY(trace.find("[\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":0,\"args\":{\"name\":\"CPU\"}}") == 0);
+    CORRADE_VERIFY(trace.find("{\"name\":\"Draw calls\",\"ph\":\"C\",\"ts\":") != std::string::npos);
+    CORRADE_VERIFY(trace.find(",\"pid\":0,\"args\":{\"value\":42}}") != std::string::npos);
+    CORRADE_COMPARE(trace.substr(trace.size() - 3), "\n]\n");
+
+    /* Name is escaped and exported only once */
+    const std::string event = "{\"name\":\"Draw \\\"all\\\"\",\"ph\":\"X\",\"ts\":";
+    const std::size_t position = trace.find(event);
+    CORRADE_VERIFY(position != std::string::npos);
+    CORRADE_VERIFY(trace.find(event, position + 1) == std::string::npos);
+    CORRADE_VERIFY(trace.find(",\"pid\":0,\"tid\":0}", position) != std::string::npos);
+}
+
+void FrameProfilerGLTest::traceGpu() {
+    FrameProfiler profiler{1};
+    if(!profiler.isGpuTimeAvailable())
+        CORRADE_SKIP("Timer queries are not supported.");
+
+    const FrameProfiler::Section clear = profiler.addSection("Clear");
+
+    std::ostringstream out;
+    profiler.setTraceOutput(&out);
+
+    profiler.begin(clear);
+    defaultFramebuffer.clear(FramebufferClear::Color);
+    profiler.end();
+    Renderer::finish();
+    profiler.nextFrame();
+
+    profiler.setTraceOutput(nullptr);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /* The first GPU event is aligned to its CPU counterpart */
+    const std::string trace = out.str();
+    const std::string event = "{\"name\":\"Clear\",\"ph\":\"X\",\"ts\":";
+    const std::size_t cpu = trace.find(event);
+    const std::size_t gpu = trace.find(event, cpu + 1);
+    CORRADE_VERIFY(cpu != std::string::npos);
+    CORRADE_VERIFY(gpu != std::string::npos);
+    CORRADE_VERIFY(trace.find(",\"tid\":1}", gpu) != std::string::npos);
+    const std::size_t cpuTs = cpu + event.size();
+    const std::size_t gpuTs = gpu + event.size();
+    CORRADE_COMPARE(trace.substr(gpuTs, trace.find(',', gpuTs) - gpuTs),
+                    trace.substr(cpuTs, trace.find(',', cpuTs) - cpuTs));
+}
+
+void FrameProfilerGLTest::traceCounterWithoutOutput() {
+    FrameProfiler profiler;
+
+    /* Does nothing, doesn't accumulate anything for a later trace */
+    profiler.addCounter("Draw calls", 42);
+
+    std::ostringstream out;
+    profiler.setTraceOutput(&out);
+    profiler.nextFrame();
+    profiler.setTraceOutput(nullptr);
+
+    CORRADE_VERIFY(out.str().find("Draw calls") == std::string::npos);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::DebugTools::Test::FrameProfilerGLTest)
@@ -0,0 +1,215 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+
+#include "Magnum/OpenGLTester.h"
+#include "Magnum/DebugTools/PerformanceHud.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/Text/AbstractFont.h"
+#include "Magnum/Text/GlyphCache.h"
+
+#ifndef MAGNUM_TARGET_WEBGL
+#include "Magnum/DebugTools/FrameProfiler.h"
+#endif
+
+namespace Magnum { namespace DebugTools { namespace Test {
+
+struct PerformanceHudGLTest: Magnum::OpenGLTester {
+    explicit PerformanceHudGLTest();
+
+    void construct();
+    void constructZeroHistory();
+
+    void addFrame();
+    void addFrameHistoryWrap();
+
+    #ifndef MAGNUM_TARGET_WEBGL
+    void frameProfiler();
+    #endif
+
+    void draw();
+};
+
+PerformanceHudGLTest::PerformanceHudGLTest() {
+    addTests({&PerformanceHudGLTest::construct,
+              &PerformanceHudGLTest::constructZeroHistory,
+
+              &PerformanceHudGLTest::addFrame,
+              &PerformanceHudGLTest::addFrameHistoryWrap,
+
+              #ifndef MAGNUM_TARGET_WEBGL
+              &PerformanceHudGLTest::frameProfiler,
+              #endif
+
+              &PerformanceHudGLTest::draw});
+}
+
+namespace {
+
+class TestLayouter: public Text::AbstractLayouter {
+    public:
+        explicit TestLayouter(Float size, std::size_t glyphCount): AbstractLayouter(glyphCount), _size(size) {}
+
+    private:
+        std::tuple<Range2D, Range2D, Vector2> doRenderGlyph(UnsignedInt) override {
+            return std::make_tuple(
+                Range2D({}, Vector2{0.5f, 1.0f}*_size),
+                Range2D({}, Vector2{1.0f}),
+                Vector2::xAxis(0.6f*_size));
+        }
+
+        Float _size;
+};
+
+class TestFont: public Text::AbstractFont {
+    Features doFeatures() const override { return Feature::OpenData; }
+
+    bool doIsOpened() const override { return true; }
+    void doClose() override {}
+
+    UnsignedInt doGlyphId(char32_t) override { return 0; }
+    Vector2 doGlyphAdvance(UnsignedInt) override { return {}; }
+
+    std::unique_ptr<Text::AbstractLayouter> doLayout(const Text::GlyphCache&, const Float size, const std::string& text) override {
+        return std::unique_ptr<Text::AbstractLayouter>(new TestLayouter(size, text.size()));
+    }
+};
+
+}
+
+void PerformanceHudGLTest::construct() {
+    TestFont font;
+    Text::GlyphCache cache{Vector2i{16}};
+    PerformanceHud hud{font, cache, 12.0f, 60};
+    MAGNUM_VERIFY_NO_ERROR();
+
+    CORRADE_COMPARE(hud.historySize(), 60);
+    CORRADE_COMPARE(hud.frameBudget(), 1.0f/60.0f);
+    CORRADE_COMPARE(hud.textUpdateInterval(), 0.25f);
+    CORRADE_COMPARE(hud.memoryBudget(), 0);
+    #ifndef MAGNUM_TARGET_WEBGL
+    CORRADE_VERIFY(!hud.frameProfiler());
+    #endif
+    CORRADE_COMPARE(hud.frameCount(), 0);
+    CORRADE_COMPARE(hud.frameTime(), 0.0f);
+    CORRADE_COMPARE(hud.averageFrameTime(), 0.0f);
+    CORRADE_COMPARE(hud.maximumFrameTime(), 0.0f);
+
+    /* There's at least the graph and one row of text */
+    CORRADE_COMPARE(hud.rectangle().bottomLeft(), Vector2{});
+    CORRADE_VERIFY(hud.rectangle().sizeX() >= 60*2.0f);
+    CORRADE_VERIFY(hud.rectangle().sizeY() > 4*12.0f + 1.5f*12.0f);
+}
+
+void PerformanceHudGLTest::constructZeroHistory() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    TestFont font;
+    Text::GlyphCache cache{Vector2i{16}};
+    PerformanceHud hud{font, cache, 12.0f, 0};
+    CORRADE_COMPARE(out.str(), "DebugTools::PerformanceHud: expected non-zero history size\n");
+}
+
+void PerformanceHudGLTest::addFrame() {
+    TestFont font;
+    Text::GlyphCache cache{Vector2i{16}};
+    PerformanceHud hud{font, cache, 12.0f, 4};
+    hud.setFrameBudget(0.02f)
+        .setTextUpdateInterval(0.5f)
+        .setMemoryBudget(1024*1024);
+    CORRADE_COMPARE(hud.frameBudget(), 0.02f);
+    CORRADE_COMPARE(hud.textUpdateInterval(), 0.5f);
+    CORRADE_COMPARE(hud.memoryBudget(), 1024*1024);
+
+    hud.addFrame(0.01f);
+    hud.addFrame(0.03f);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    CORRADE_COMPARE(hud.frameCount(), 2);
+    CORRADE_COMPARE(hud.frameTime(), 0.03f);
+    CORRADE_COMPARE(hud.averageFrameTime(), 0.02f);
+    CORRADE_COMPARE(hud.maximumFrameTime(), 0.03f);
+}
+
+void PerformanceHudGLTest::addFrameHistoryWrap() {
+    TestFont font;
+    Text::GlyphCache cache{Vector2i{16}};
+    PerformanceHud hud{font, cache, 12.0f, 3};
+
+    /* The 0.5 frame falls out of the history */
+    for(Float duration: {0.5f, 0.01f, 0.02f, 0.03f}) hud.addFrame(duration);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    CORRADE_COMPARE(hud.frameCount(), 4);
+    CORRADE_COMPARE(hud.frameTime(), 0.03f);
+    CORRADE_COMPARE(hud.averageFrameTime(), 0.02f);
+    CORRADE_COMPARE(hud.maximumFrameTime(), 0.03f);
+}
+
+#ifndef MAGNUM_TARGET_WEBGL
+void PerformanceHudGLTest::frameProfiler() {
+    TestFont font;
+    Text::GlyphCache cache{Vector2i{16}};
+    PerformanceHud hud{font, cache, 12.0f};
+    const Float height = hud.rectangle().sizeY();
+
+    FrameProfiler profiler;
+    const FrameProfiler::Section scene = profiler.addSection("scene");
+    profiler.addSection("shadows", scene);
+    profiler.addSection("ui");
+
+    /* Two top-level sections add two rows */
+    hud.setFrameProfiler(&profiler);
+    CORRADE_COMPARE(hud.frameProfiler(), &profiler);
+    CORRADE_COMPARE(hud.rectangle().sizeY(), height + 2*1.5f*12.0f);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    hud.setFrameProfiler(nullptr);
+    CORRADE_COMPARE(hud.rectangle().sizeY(), height);
+}
+#endif
+
+void PerformanceHudGLTest::draw() {
+    TestFont font;
+    Text::GlyphCache cache{Vector2i{16}};
+    PerformanceHud hud{font, cache, 12.0f, 16};
+    hud.setMemoryBudget(1024*1024);
+
+    /* Frames under, slightly over and way over budget, enough to update the
+       text several times */
+    for(std::size_t i = 0; i != 40; ++i) {
+        hud.addFrame(i % 3 == 0 ? 0.05f : i % 3 == 1 ? 0.02f : 0.01f);
+        hud.draw(Matrix3::projection(Vector2{640.0f, 480.0f}));
+    }
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(hud.frameCount(), 40);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::DebugTools::Test::PerformanceHudGLTest)
@@ -0,0 +1,283 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <thread>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/DebugTools/Profiler.h"
+
+namespace Magnum { namespace DebugTools { namespace Test {
+
+struct ProfilerTest: Corrade::TestSuite::Tester {
+    explicit ProfilerTest();
+
+    void addSection();
+    void sections();
+    void nested();
+    void disabled();
+
+    void recorder();
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    void recorderThread();
+    #endif
+    void recorderOverflow();
+
+    void statistics();
+    void statisticsEmpty();
+    void printStatistics();
+};
+
+ProfilerTest::ProfilerTest() {
+    addTests({&ProfilerTest::addSection,
+              &ProfilerTest::sections,
+              &ProfilerTest::nested,
+              &ProfilerTest::disabled,
+
+              &ProfilerTest::recorder,
+              #ifndef CORRADE_TARGET_EMSCRIPTEN
+              &ProfilerTest::recorderThread,
+              #endif
+              &ProfilerTest::recorderOverflow,
+
+              &ProfilerTest::statistics,
+              &ProfilerTest::statisticsEmpty,
+              &ProfilerTest::printStatistics});
+}
+
+using namespace std::chrono;
+
+namespace {
+    void sleepFor(const Int ms) { std::this_thread::sleep_for(milliseconds{ms}); }
+}
+
+void ProfilerTest::addSection() {
+    Profiler p;
+    CORRADE_COMPARE(p.addSection("A"), 1);
+    CORRADE_COMPARE(p.addSection("B", 1), 2);
+    CORRADE_COMPARE(p.addSection("C"), 3);
+}
+
+void ProfilerTest::sections() {
+    Profiler p;
+    p.setMeasureDuration(4);
+    const Profiler::Section a = p.addSection("A");
+    p.enable();
+
+    p.start(a);
+    sleepFor(2);
+    p.start();
+    p.stop();
+    p.nextFrame();
+
+    CORRADE_COMPARE(p.frameCount(), 1);
+    CORRADE_COMPARE_AS(duration_cast<microseconds>(p.statistics(a).average).count(), 2000,
+        Corrade::TestSuite::Compare::GreaterOrEqual);
+}
+
+void ProfilerTest::nested() {
+    Profiler p;
+    p.setMeasureDuration(4);
+    const Profiler::Section parent = p.addSection("Parent");
+    const Profiler::Section child = p.addSection("Child", parent);
+    p.enable();
+
+    p.start(parent);
+    sleepFor(1);
+    p.begin(child);
+    sleepFor(2);
+    p.end();
+    p.stop();
+    p.nextFrame();
+
+    /* Beginning a nested section doesn't end the parent */
+    const Profiler::Statistics parentStatistics = p.statistics(parent);
+    const Profiler::Statistics childStatistics = p.statistics(child);
+    CORRADE_COMPARE_AS(duration_cast<microseconds>(childStatistics.average).count(), 2000,
+        Corrade::TestSuite::Compare::GreaterOrEqual);
+    CORRADE_COMPARE_AS(duration_cast<microseconds>(parentStatistics.average).count(),
+        duration_cast<microseconds>(childStatistics.average).count() + 1000,
+        Corrade::TestSuite::Compare::GreaterOrEqual);
+}
+
+void ProfilerTest::disabled() {
+    Profiler p;
+    const Profiler::Section parent = p.addSection("Parent");
+    const Profiler::Section child = p.addSection("Child", parent);
+
+    /* None of these do anything */
+    p.start(parent);
+    p.begin(child);
+    p.end();
+    p.stop();
+    p.nextFrame();
+    p.printStatistics();
+
+    CORRADE_COMPARE(p.frameCount(), 0);
+}
+
+void ProfilerTest::recorder() {
+    Profiler p;
+    p.setMeasureDuration(4);
+    const Profiler::Section a = p.addSection("A");
+    const Profiler::Section b = p.addSection("B", a);
+    Profiler::Recorder& recorder = p.addRecorder(16);
+    CORRADE_COMPARE(recorder.capacity(), 16);
+    p.enable();
+
+    recorder.begin(a);
+    sleepFor(1);
+    recorder.begin(b);
+    sleepFor(1);
+    recorder.end();
+    recorder.end();
+    p.nextFrame();
+
+    CORRADE_COMPARE(p.droppedCount(), 0);
+    CORRADE_COMPARE_AS(duration_cast<microseconds>(p.statistics(b).average).count(), 1000,
+        Corrade::TestSuite::Compare::GreaterOrEqual);
+    CORRADE_COMPARE_AS(duration_cast<microseconds>(p.statistics(a).average).count(), 2000,
+        Corrade::TestSuite::Compare::GreaterOrEqual);
+}
+
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+void ProfilerTest::recorderThread() {
+    Profiler p;
+    p.setMeasureDuration(4);
+    const Profiler::Section a = p.addSection("A");
+    Profiler::Recorder& recorder = p.addRecorder();
+    p.enable();
+
+    std::thread worker{[&recorder, a]() {
+        for(std::size_t i = 0; i != 3; ++i) {
+            recorder.begin(a);
+            sleepFor(1);
+            recorder.end();
+        }
+    }};
+    worker.join();
+    p.nextFrame();
+
+    CORRADE_COMPARE(p.droppedCount(), 0);
+    CORRADE_COMPARE_AS(duration_cast<microseconds>(p.statistics(a).average).count(), 3000,
+        Corrade::TestSuite::Compare::GreaterOrEqual);
+}
+#endif
+
+void ProfilerTest::recorderOverflow() {
+    Profiler p;
+    const Profiler::Section a = p.addSection("A");
+    Profiler::Recorder& recorder = p.addRecorder(2);
+    p.enable();
+
+    for(std::size_t i = 0; i != 5; ++i) {
+        recorder.begin(a);
+        recorder.end();
+    }
+
+    CORRADE_COMPARE(recorder.droppedCount(), 3);
+    CORRADE_COMPARE(p.droppedCount(), 3);
+
+    /* After draining there's space again */
+    p.nextFrame();
+    recorder.begin(a);
+    recorder.end();
+    CORRADE_COMPARE(p.droppedCount(), 3);
+}
+
+void ProfilerTest::statistics() {
+    Profiler p;
+    p.setMeasureDuration(11);
+    const Profiler::Section a = p.addSection("A");
+    p.enable();
+
+    /* Nine fast frames and one spike */
+    for(std::size_t i = 0; i != 10; ++i) {
+        p.start(a);
+        if(i == 4) sleepFor(20);
+        p.stop();
+        p.nextFrame();
+    }
+
+    const Profiler::Statistics s = p.statistics(a);
+    CORRADE_COMPARE_AS(duration_cast<milliseconds>(s.maximum).count(), 20,
+        Corrade::TestSuite::Compare::GreaterOrEqual);
+    CORRADE_COMPARE_AS(duration_cast<milliseconds>(s.percentile99).count(), 20,
+        Corrade::TestSuite::Compare::GreaterOrEqual);
+    CORRADE_COMPARE_AS(duration_cast<milliseconds>(s.median).count(), 20,
+        Corrade::TestSuite::Compare::Less);
+    CORRADE_COMPARE_AS(duration_cast<milliseconds>(s.minimum).count(), 20,
+        Corrade::TestSuite::Compare::Less);
+    CORRADE_VERIFY(s.minimum <= s.median);
+    CORRADE_VERIFY(s.median <= s.average);
+    CORRADE_VERIFY(s.average <= s.maximum);
+}
+
+void ProfilerTest::statisticsEmpty() {
+    Profiler p;
+    const Profiler::Section a = p.addSection("A");
+    p.enable();
+
+    const Profiler::Statistics s = p.statistics(a);
+    CORRADE_COMPARE(s.average.count(), 0);
+    CORRADE_COMPARE(s.minimum.count(), 0);
+    CORRADE_COMPARE(s.maximum.count(), 0);
+    CORRADE_COMPARE(s.median.count(), 0);
+    CORRADE_COMPARE(s.percentile99.count(), 0);
+}
+
+void ProfilerTest::printStatistics() {
+    Profiler p;
+    const Profiler::Section a = p.addSection("A");
+    const Profiler::Section b = p.addSection("B", a);
+    p.addSection("C");
+    p.enable();
+
+    p.start(a);
+    p.begin(b);
+    sleepFor(1);
+    p.end();
+    p.stop();
+    p.nextFrame();
+
+    std::ostringstream out;
+    {
+        Debug redirectOutput{&out};
+        p.printStatistics();
+    }
+
+    /* A took the longest, so it's listed first, with B indented under it */
+    const std::string printed = out.str();
+    CORRADE_VERIFY(printed.find("Statistics for last 1 frames (average, min, max, p50, p99):\n  A ") == 0);
+    CORRADE_VERIFY(printed.find("\n    B ") != std::string::npos);
+    CORRADE_VERIFY(printed.find("\n  C ") != std::string::npos);
+    CORRADE_VERIFY(printed.find("\n  Other ") != std::string::npos);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::DebugTools::Test::ProfilerTest)
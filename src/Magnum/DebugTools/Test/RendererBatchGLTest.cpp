@@ -0,0 +1,222 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/Framebuffer.h"
+#include "Magnum/Image.h"
+#include "Magnum/OpenGLTester.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Renderbuffer.h"
+#include "Magnum/RenderbufferFormat.h"
+#include "Magnum/DebugTools/ForceRenderer.h"
+#include "Magnum/DebugTools/ObjectRenderer.h"
+#include "Magnum/DebugTools/RendererBatch.h"
+#include "Magnum/DebugTools/ResourceManager.h"
+#include "Magnum/SceneGraph/Camera.h"
+#include "Magnum/SceneGraph/MatrixTransformation2D.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Object.h"
+#include "Magnum/SceneGraph/Scene.h"
+
+namespace Magnum { namespace DebugTools { namespace Test {
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation2D> Object2D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation2D> Scene2D;
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+struct RendererBatchGLTest: Magnum::OpenGLTester {
+    explicit RendererBatchGLTest();
+
+    void construct();
+    void empty();
+    void objectRenderer();
+    void forceRenderer();
+    void mixed();
+
+    private:
+        ResourceManager _manager;
+};
+
+RendererBatchGLTest::RendererBatchGLTest() {
+    addTests({&RendererBatchGLTest::construct,
+              &RendererBatchGLTest::empty,
+              &RendererBatchGLTest::objectRenderer,
+              &RendererBatchGLTest::forceRenderer,
+              &RendererBatchGLTest::mixed});
+}
+
+namespace {
+
+bool instancingSupported() {
+    #ifndef MAGNUM_TARGET_GLES
+    return Context::current().isExtensionSupported<Extensions::GL::ARB::instanced_arrays>();
+    #elif defined(MAGNUM_TARGET_GLES2)
+    return Context::current().isExtensionSupported<Extensions::GL::ANGLE::instanced_arrays>()
+        #ifndef MAGNUM_TARGET_WEBGL
+        || (Context::current().isExtensionSupported<Extensions::GL::EXT::instanced_arrays>() &&
+            Context::current().isExtensionSupported<Extensions::GL::EXT::draw_instanced>())
+        || (Context::current().isExtensionSupported<Extensions::GL::NV::instanced_arrays>() &&
+            Context::current().isExtensionSupported<Extensions::GL::NV::draw_instanced>())
+        #endif
+        ;
+    #else
+    return true;
+    #endif
+}
+
+}
+
+void RendererBatchGLTest::construct() {
+    {
+        RendererBatch2D batch;
+        CORRADE_COMPARE(batch.size(), 0);
+        CORRADE_COMPARE(batch.instanceCount(), 0);
+        CORRADE_COMPARE(batch.drawCallCount(), 0);
+    }
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void RendererBatchGLTest::empty() {
+    Scene3D scene;
+    Object3D cameraObject{&scene};
+    SceneGraph::Camera3D camera{cameraObject};
+
+    RendererBatch3D batch;
+    CORRADE_COMPARE(batch.draw(camera), 0);
+    CORRADE_COMPARE(batch.instanceCount(), 0);
+    CORRADE_COMPARE(batch.drawCallCount(), 0);
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void RendererBatchGLTest::objectRenderer() {
+    Renderbuffer renderbuffer;
+    renderbuffer.setStorage(RenderbufferFormat::RGBA8, Vector2i{16});
+    Framebuffer framebuffer{{{}, Vector2i{16}}};
+    framebuffer.attachRenderbuffer(Framebuffer::ColorAttachment{0}, renderbuffer)
+        .clear(FramebufferClear::Color)
+        .bind();
+
+    _manager.set("big", ObjectRendererOptions{}.setSize(8.0f));
+
+    /* Pixel centers are at half-integer positions, move the object there so
+       the axes are rasterized to a single row and column */
+    Scene2D scene;
+    Object2D cameraObject{&scene};
+    SceneGraph::Camera2D camera{cameraObject};
+    camera.setProjectionMatrix(Matrix3::projection({16.0f, 16.0f}));
+
+    Object2D object{&scene};
+    object.translate({0.5f, 0.5f});
+
+    RendererBatch2D batch;
+    new ObjectRenderer2D{object, "big", batch};
+    CORRADE_COMPARE(batch.size(), 1);
+
+    batch.draw(camera);
+    CORRADE_COMPARE(batch.instanceCount(), 2);
+    CORRADE_COMPARE(batch.drawCallCount(), instancingSupported() ? 1 : 2);
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /* Red X axis, green Y axis, the same as with the non-batched renderer */
+    Image2D image = framebuffer.read({{}, Vector2i{16}}, {PixelFormat::RGBA, PixelType::UnsignedByte});
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(image.data<Color4ub>()[8*16 + 12], (Color4ub{255, 0, 0, 255}));
+    CORRADE_COMPARE(image.data<Color4ub>()[12*16 + 8], (Color4ub{0, 255, 0, 255}));
+    CORRADE_COMPARE(image.data<Color4ub>()[4*16 + 4], (Color4ub{0, 0, 0, 0}));
+}
+
+void RendererBatchGLTest::forceRenderer() {
+    Scene3D scene;
+    Object3D cameraObject{&scene};
+    SceneGraph::Camera3D camera{cameraObject};
+
+    const Vector3 force{0.0f, 1.0f, 0.0f};
+
+    RendererBatch3D batch;
+    std::vector<Object3D*> objects;
+    for(std::size_t i = 0; i != 100; ++i) {
+        objects.push_back(new Object3D{&scene});
+        objects.back()->translate(Vector3::xAxis(Float(i)));
+        new ForceRenderer3D{*objects.back(), {}, force, {}, batch};
+    }
+
+    #ifdef MAGNUM_BUILD_STATISTICS
+    Context::current().resetStatistics();
+    #endif
+
+    batch.draw(camera);
+    CORRADE_COMPARE(batch.instanceCount(), 100);
+    CORRADE_COMPARE(batch.drawCallCount(), instancingSupported() ? 1 : 100);
+
+    #ifdef MAGNUM_BUILD_STATISTICS
+    CORRADE_COMPARE(Context::current().statistics().drawCallCount, batch.drawCallCount());
+    #endif
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /* Drawing again reuses the batches */
+    batch.draw(camera);
+    CORRADE_COMPARE(batch.instanceCount(), 100);
+    CORRADE_COMPARE(batch.drawCallCount(), instancingSupported() ? 1 : 100);
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void RendererBatchGLTest::mixed() {
+    Scene3D scene;
+    Object3D cameraObject{&scene};
+    SceneGraph::Camera3D camera{cameraObject};
+
+    const Vector3 force{0.0f, 1.0f, 0.0f};
+
+    /* Object and force renderers share the arrow mesh */
+    RendererBatch3D batch;
+    Object3D a{&scene}, b{&scene};
+    new ObjectRenderer3D{a, {}, batch};
+    new ObjectRenderer3D{b, {}, batch};
+    new ForceRenderer3D{a, {}, force, {}, batch};
+
+    batch.draw(camera);
+    CORRADE_COMPARE(batch.instanceCount(), 7);
+    CORRADE_COMPARE(batch.drawCallCount(), instancingSupported() ? 1 : 7);
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /* Non-batched renderer can be still used aside */
+    SceneGraph::DrawableGroup3D drawables;
+    new ForceRenderer3D{b, {}, force, {}, &drawables};
+    camera.draw(drawables);
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::DebugTools::Test::RendererBatchGLTest)
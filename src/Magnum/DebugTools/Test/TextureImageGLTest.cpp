@@ -54,6 +54,11 @@ struct TextureImageGLTest: OpenGLTester {
     void subImageCubeBuffer();
     #endif
 
+    #ifndef MAGNUM_TARGET_GLES2
+    void subImage2DAsync();
+    void subImageCubeAsync();
+    #endif
+
     #ifndef MAGNUM_TARGET_GLES2
     void subImage2DUInt();
     void subImage2DFloat();
@@ -71,6 +76,11 @@ TextureImageGLTest::TextureImageGLTest() {
               &TextureImageGLTest::subImageCubeBuffer,
               #endif
 
+              #ifndef MAGNUM_TARGET_GLES2
+              &TextureImageGLTest::subImage2DAsync,
+              &TextureImageGLTest::subImageCubeAsync,
+              #endif
+
               #ifndef MAGNUM_TARGET_GLES2
               &TextureImageGLTest::subImage2DUInt,
               &TextureImageGLTest::subImage2DFloat,
@@ -159,6 +169,50 @@ void TextureImageGLTest::subImageCubeBuffer() {
     CORRADE_COMPARE_AS(data, Containers::arrayView(Data2D),
         TestSuite::Compare::Container);
 }
+
+void TextureImageGLTest::subImage2DAsync() {
+    Texture2D texture;
+    texture.setImage(0, TextureFormat::RGBA8, ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte, Vector2i{2}, Data2D});
+
+    AsyncTextureImage readback = textureSubImageAsync(texture, 0, {{}, Vector2i{2}}, {PixelFormat::RGBA, PixelType::UnsignedByte});
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(readback.size(), Vector2i{2});
+
+    /* Retrieving the image waits for the fence */
+    Image2D image = readback.image();
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(readback.isReady());
+    CORRADE_COMPARE(image.size(), Vector2i{2});
+    CORRADE_COMPARE(image.format(), PixelFormat::RGBA);
+    CORRADE_COMPARE(image.type(), PixelType::UnsignedByte);
+    CORRADE_COMPARE_AS(Containers::arrayCast<UnsignedByte>(image.data()),
+        Containers::arrayView(Data2D), TestSuite::Compare::Container);
+
+    /* Can be retrieved again */
+    Image2D again = readback.image();
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE_AS(Containers::arrayCast<UnsignedByte>(again.data()),
+        Containers::arrayView(Data2D), TestSuite::Compare::Container);
+}
+
+void TextureImageGLTest::subImageCubeAsync() {
+    ImageView2D view{PixelFormat::RGBA, PixelType::UnsignedByte, Vector2i{2}, Data2D};
+
+    CubeMapTexture texture;
+    texture.setImage(CubeMapCoordinate::PositiveX, 0, TextureFormat::RGBA8, view)
+           .setImage(CubeMapCoordinate::NegativeX, 0, TextureFormat::RGBA8, view)
+           .setImage(CubeMapCoordinate::PositiveY, 0, TextureFormat::RGBA8, view)
+           .setImage(CubeMapCoordinate::NegativeY, 0, TextureFormat::RGBA8, view)
+           .setImage(CubeMapCoordinate::PositiveZ, 0, TextureFormat::RGBA8, view)
+           .setImage(CubeMapCoordinate::NegativeZ, 0, TextureFormat::RGBA8, view);
+
+    AsyncTextureImage readback = textureSubImageAsync(texture, CubeMapCoordinate::PositiveX, 0, {{}, Vector2i{2}}, {PixelFormat::RGBA, PixelType::UnsignedByte});
+    Image2D image = readback.image();
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(image.size(), Vector2i{2});
+    CORRADE_COMPARE_AS(Containers::arrayCast<UnsignedByte>(image.data()),
+        Containers::arrayView(Data2D), TestSuite::Compare::Container);
+}
 #endif
 
 #ifndef MAGNUM_TARGET_GLES2
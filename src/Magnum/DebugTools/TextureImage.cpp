@@ -25,6 +25,8 @@
 
 #include "TextureImage.h"
 
+#include <algorithm>
+
 #ifndef MAGNUM_TARGET_GLES2
 #include "Magnum/BufferImage.h"
 #endif
@@ -217,4 +219,41 @@ BufferImage2D textureSubImage(CubeMapTexture& texture, const CubeMapCoordinate c
 }
 #endif
 
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+AsyncTextureImage::AsyncTextureImage(BufferImage2D&& image): _image{std::move(image)} {
+    _fence.insert();
+}
+
+bool AsyncTextureImage::isReady() {
+    return _fence.isSignaled();
+}
+
+void AsyncTextureImage::wait() {
+    while(_fence.clientWait(std::chrono::seconds{1}) == Fence::WaitResult::TimeoutExpired);
+}
+
+Image2D AsyncTextureImage::image() {
+    wait();
+
+    Containers::Array<char> data{_image.dataSize()};
+    if(_image.dataSize()) {
+        const Containers::ArrayView<const char> mapped = _image.buffer().mapRead(0, _image.dataSize());
+        std::copy(mapped.begin(), mapped.end(), data.begin());
+        _image.buffer().unmap();
+    }
+
+    return Image2D{_image.storage(), _image.format(), _image.type(), _image.size(), std::move(data)};
+}
+
+AsyncTextureImage textureSubImageAsync(Texture2D& texture, const Int level, const Range2Di& range, BufferImage2D&& image) {
+    textureSubImage(texture, level, range, image, BufferUsage::StreamRead);
+    return AsyncTextureImage{std::move(image)};
+}
+
+AsyncTextureImage textureSubImageAsync(CubeMapTexture& texture, const CubeMapCoordinate coordinate, const Int level, const Range2Di& range, BufferImage2D&& image) {
+    textureSubImage(texture, coordinate, level, range, image, BufferUsage::StreamRead);
+    return AsyncTextureImage{std::move(image)};
+}
+#endif
+
 }}
@@ -26,12 +26,17 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::DebugTools::textureSubImage()
+ * @brief Function @ref Magnum::DebugTools::textureSubImage(), @ref Magnum::DebugTools::textureSubImageAsync(), class @ref Magnum::DebugTools::AsyncTextureImage
  */
 
 #include "Magnum/Magnum.h"
 #include "Magnum/DebugTools/visibility.h"
 
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+#include "Magnum/BufferImage.h"
+#include "Magnum/Fence.h"
+#endif
+
 namespace Magnum { namespace DebugTools {
 
 /**
@@ -138,6 +143,111 @@ BufferImage2D image = DebugTools::textureSubImage(texture, CubeMapCoordinate::Po
 MAGNUM_DEBUGTOOLS_EXPORT BufferImage2D textureSubImage(CubeMapTexture& texture, CubeMapCoordinate coordinate, Int level, const Range2Di& range, BufferImage2D&& image, BufferUsage usage);
 #endif
 
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+/**
+@brief Asynchronous texture image readback
+
+Handle returned by @ref textureSubImageAsync(). The texture range is read into
+a pixel buffer using @ref textureSubImage(Texture2D&, Int, const Range2Di&, BufferImage2D&, BufferUsage)
+and a @ref Fence is inserted after the read, so neither the creation nor
+@ref isReady() block. Retrieving the image with @ref image() only maps the
+pixel buffer, waiting for the fence first if the read isn't finished yet:
+
+@code{.cpp}
+DebugTools::AsyncTextureImage readback = DebugTools::textureSubImageAsync(
+    texture, 0, rect, {PixelFormat::RGBA, PixelType::UnsignedByte});
+
+// ... submit other work, poll readback.isReady() in later frames
+
+Image2D image = readback.image();
+@endcode
+
+The same pixel format restrictions as for the
+@ref textureSubImage(Texture2D&, Int, const Range2Di&, BufferImage2D&, BufferUsage)
+variant apply, in particular @ref PixelType::Float is not reinterpreted on
+OpenGL ES.
+@requires_gl30 Extension @extension{ARB,pixel_buffer_object} and
+    @extension{ARB,map_buffer_range}
+@requires_gl32 Extension @extension{ARB,sync}
+@requires_gles30 Pixel buffer objects and sync objects are not available in
+    OpenGL ES 2.0.
+@requires_gles Buffer mapping is not available in WebGL.
+*/
+class MAGNUM_DEBUGTOOLS_EXPORT AsyncTextureImage {
+    public:
+        /**
+         * @brief Constructor
+         * @param image     Buffer image with the read already issued into it
+         *
+         * Inserts a fence after the read. Doesn't block. Usually you'd use
+         * @ref textureSubImageAsync() instead.
+         */
+        explicit AsyncTextureImage(BufferImage2D&& image);
+
+        /** @brief Image size */
+        Vector2i size() const { return _image.size(); }
+
+        /**
+         * @brief Whether the image is ready
+         *
+         * Polls the fence, doesn't block.
+         * @see @ref Fence::isSignaled()
+         */
+        bool isReady();
+
+        /**
+         * @brief Wait until the image is ready
+         *
+         * Blocks until the fence is signaled. Called implicitly by
+         * @ref image().
+         * @see @ref Fence::clientWait()
+         */
+        void wait();
+
+        /**
+         * @brief Retrieve the image
+         *
+         * Calls @ref wait() and then copies the pixel buffer contents to
+         * client memory. Can be called more than once.
+         */
+        Image2D image();
+
+    private:
+        BufferImage2D _image;
+        Fence _fence;
+};
+
+/**
+@brief Asynchronously read range of given texture mip level
+
+Non-blocking alternative to @ref textureSubImage(Texture2D&, Int, const Range2Di&, Image2D&&),
+see @ref AsyncTextureImage for more information. Only storage, format and type
+of @p image are used.
+@requires_gl30 Extension @extension{ARB,pixel_buffer_object} and
+    @extension{ARB,map_buffer_range}
+@requires_gl32 Extension @extension{ARB,sync}
+@requires_gles30 Pixel buffer objects and sync objects are not available in
+    OpenGL ES 2.0.
+@requires_gles Buffer mapping is not available in WebGL.
+*/
+MAGNUM_DEBUGTOOLS_EXPORT AsyncTextureImage textureSubImageAsync(Texture2D& texture, Int level, const Range2Di& range, BufferImage2D&& image);
+
+/**
+@brief Asynchronously read range of given cube map texture coordinate mip level
+
+Non-blocking alternative to @ref textureSubImage(CubeMapTexture&, CubeMapCoordinate, Int, const Range2Di&, Image2D&&),
+see @ref AsyncTextureImage for more information. Only storage, format and type
+of @p image are used.
+@requires_gl30 Extension @extension{ARB,pixel_buffer_object} and
+    @extension{ARB,map_buffer_range}
+@requires_gl32 Extension @extension{ARB,sync}
+@requires_gles30 Pixel buffer objects and sync objects are not available in
+    OpenGL ES 2.0.
+@requires_gles Buffer mapping is not available in WebGL.
+*/
+MAGNUM_DEBUGTOOLS_EXPORT AsyncTextureImage textureSubImageAsync(CubeMapTexture& texture, CubeMapCoordinate coordinate, Int level, const Range2Di& range, BufferImage2D&& image);
+#endif
+
 }}
 
 #endif
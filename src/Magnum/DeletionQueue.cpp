@@ -0,0 +1,206 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "DeletionQueue.h"
+
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/AbstractTexture.h"
+#include "Magnum/Buffer.h"
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/MemoryTracker.h"
+#include "Magnum/Mesh.h"
+#include "Magnum/Implementation/State.h"
+#include "Magnum/Implementation/BufferState.h"
+#include "Magnum/Implementation/MeshState.h"
+#include "Magnum/Implementation/TextureState.h"
+
+namespace Magnum {
+
+DeletionQueue::DeletionQueue() = default;
+
+DeletionQueue::~DeletionQueue() = default;
+
+void DeletionQueue::add(const Type type, const GLuint id) {
+    if(!id) return;
+
+    std::lock_guard<std::mutex> lock{_mutex};
+    _pending.push_back(Object{type, id});
+}
+
+void DeletionQueue::add(Buffer&& buffer) {
+    const bool owned = !!(buffer._flags & ObjectFlag::DeleteOnDestruction);
+    const GLuint id = buffer.release();
+    if(owned) add(Type::Buffer, id);
+}
+
+void DeletionQueue::add(AbstractTexture&& texture) {
+    const bool owned = !!(texture._flags & ObjectFlag::DeleteOnDestruction);
+    const GLuint id = texture.release();
+    if(owned) add(Type::Texture, id);
+}
+
+void DeletionQueue::add(Mesh&& mesh) {
+    const bool owned = !!(mesh._flags & ObjectFlag::DeleteOnDestruction);
+    const GLuint id = mesh.release();
+    if(owned) add(Type::Mesh, id);
+}
+
+std::size_t DeletionQueue::pendingCount() const {
+    std::lock_guard<std::mutex> lock{_mutex};
+    return _pending.size();
+}
+
+std::size_t DeletionQueue::inFlightCount() const {
+    #ifndef MAGNUM_TARGET_GLES2
+    return _inFlightCount;
+    #else
+    return 0;
+    #endif
+}
+
+std::size_t DeletionQueue::process() {
+    /* Take the pending objects out so the lock isn't held during GL calls */
+    std::vector<Object> pending;
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        std::swap(pending, _pending);
+    }
+
+    std::size_t count = 0;
+
+    #ifndef MAGNUM_TARGET_GLES2
+    #ifndef MAGNUM_TARGET_GLES
+    if(Context::current().isExtensionSupported<Extensions::GL::ARB::sync>())
+    #endif
+    {
+        if(!pending.empty()) {
+            _inFlightCount += pending.size();
+            _batches.push_back(Batch{Fence{}, std::move(pending)});
+            _batches.back().fence.insert();
+        }
+
+        /* Fences are signaled in order, so stop on the first that isn't */
+        while(!_batches.empty() && _batches.front().fence.isSignaled()) {
+            deleteObjects(_batches.front().objects);
+            count += _batches.front().objects.size();
+            _inFlightCount -= _batches.front().objects.size();
+            _batches.pop_front();
+        }
+
+        return count;
+    }
+    #endif
+
+    /* No sync objects, let the driver take care of the objects that are
+       still in use */
+    deleteObjects(pending);
+    return count + pending.size();
+}
+
+std::size_t DeletionQueue::flush() {
+    std::vector<Object> pending;
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        std::swap(pending, _pending);
+    }
+
+    std::size_t count = 0;
+
+    #ifndef MAGNUM_TARGET_GLES2
+    for(const Batch& batch: _batches) {
+        deleteObjects(batch.objects);
+        count += batch.objects.size();
+    }
+    _batches.clear();
+    _inFlightCount = 0;
+    #endif
+
+    deleteObjects(pending);
+    return count + pending.size();
+}
+
+void DeletionQueue::deleteObjects(const std::vector<Object>& objects) {
+    if(objects.empty()) return;
+
+    Implementation::State& state = Context::current().state();
+
+    /* Remove the objects from the state tracker first, otherwise a newly
+       created object that reuses the ID would be considered already bound */
+    for(const Object& object: objects) switch(object.type) {
+        case Type::Buffer:
+            for(std::size_t i = 1; i != Implementation::BufferState::TargetCount; ++i)
+                if(state.buffer->bindings[i] == object.id)
+                    state.buffer->bindings[i] = 0;
+
+            state.memoryTracker->remove(MemoryObjectType::Buffer, object.id);
+            glDeleteBuffers(1, &object.id);
+            break;
+
+        case Type::Texture:
+            for(auto& binding: state.texture->bindings) {
+                /* libstdc++ since GCC 6.3 can't handle just = {} (ambiguous
+                   overload of operator=) */
+                if(binding.second == object.id) binding = std::pair<GLenum, GLuint>{};
+            }
+
+            #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+            for(auto& binding: state.texture->imageBindings)
+                if(std::get<0>(binding) == object.id) binding = {};
+            #endif
+
+            state.memoryTracker->remove(MemoryObjectType::Texture, object.id);
+            glDeleteTextures(1, &object.id);
+            break;
+
+        case Type::Mesh:
+            if(state.mesh->currentVAO == object.id)
+                state.mesh->currentVAO = 0;
+
+            #ifndef MAGNUM_TARGET_GLES2
+            glDeleteVertexArrays(1, &object.id);
+            #else
+            glDeleteVertexArraysOES(1, &object.id);
+            #endif
+            break;
+    }
+}
+
+Debug& operator<<(Debug& debug, const DeletionQueue::Type value) {
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case DeletionQueue::Type::value: return debug << "DeletionQueue::Type::" #value;
+        _c(Buffer)
+        _c(Texture)
+        _c(Mesh)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "DeletionQueue::Type(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
+}
+
+}
@@ -0,0 +1,215 @@
+#ifndef Magnum_DeletionQueue_h
+#define Magnum_DeletionQueue_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::DeletionQueue
+ */
+
+#include <deque>
+#include <mutex>
+#include <vector>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/OpenGL.h"
+#include "Magnum/visibility.h"
+
+#ifndef MAGNUM_TARGET_GLES2
+#include "Magnum/Fence.h"
+#endif
+
+namespace Magnum {
+
+/**
+@brief Deferred OpenGL object deletion queue
+
+Destroying a @ref Buffer, a texture or a @ref Mesh is allowed only on the
+thread the context is current on and the deletion may stall if the GPU still
+uses the object. The deletion queue accepts released objects or raw object IDs
+from any thread and deletes them later on the context thread, once a fence
+inserted after them got signaled. There is one instance per context,
+accessible through @ref Context::deletionQueue():
+
+@snippet Magnum.cpp DeletionQueue-usage
+
+The @ref add() functions are thread-safe and don't call any OpenGL functions,
+so they can be called from a worker thread that was given a reference to the
+queue. Objects that were not marked with @ref ObjectFlag::DeleteOnDestruction
+(for example ones created with @ref Buffer::wrap()) are only released and not
+deleted.
+
+Call @ref process() on the context thread, usually once per frame after
+swapping buffers. It moves all pending IDs into a new batch guarded by a
+@ref Fence and then deletes all batches whose fence is already signaled,
+skipping the rest until the next call. If @extension{ARB,sync} is not
+available or on OpenGL ES 2.0 and WebGL 1.0, the pending objects are deleted
+directly in @ref process(). Call @ref flush() to delete everything immediately,
+it's done automatically on @ref Context destruction.
+
+Deleted objects are also removed from the internal state tracker and from
+@ref MemoryTracker. Note that bindless texture handles of a texture added to
+the queue become invalid once the texture is deleted.
+*/
+class MAGNUM_EXPORT DeletionQueue {
+    public:
+        /**
+         * @brief Object type
+         *
+         * @see @ref add(Type, GLuint)
+         */
+        enum class Type: UnsignedByte {
+            Buffer = 0,     /**< @ref Magnum::Buffer "Buffer" */
+            Texture = 1,    /**< Any texture */
+            Mesh = 2        /**< @ref Magnum::Mesh "Mesh" (vertex array object) */
+        };
+
+        /**
+         * @brief Constructor
+         *
+         * Used internally by @ref Context, use @ref Context::deletionQueue()
+         * to access the instance for current context.
+         */
+        explicit DeletionQueue();
+
+        /** @brief Copying is not allowed */
+        DeletionQueue(const DeletionQueue&) = delete;
+
+        /** @brief Moving is not allowed */
+        DeletionQueue(DeletionQueue&&) = delete;
+
+        ~DeletionQueue();
+
+        /** @brief Copying is not allowed */
+        DeletionQueue& operator=(const DeletionQueue&) = delete;
+
+        /** @brief Moving is not allowed */
+        DeletionQueue& operator=(DeletionQueue&&) = delete;
+
+        /**
+         * @brief Add an object ID to the queue
+         *
+         * Thread-safe. IDs equal to `0` are ignored.
+         * @see @ref Buffer::release(), @ref AbstractTexture::release(),
+         *      @ref Mesh::release()
+         */
+        void add(Type type, GLuint id);
+
+        /**
+         * @brief Add a buffer to the queue
+         *
+         * Thread-safe. Releases the buffer and adds its ID to the queue if
+         * it was marked with @ref ObjectFlag::DeleteOnDestruction.
+         */
+        void add(Buffer&& buffer);
+
+        /**
+         * @brief Add a texture to the queue
+         *
+         * Thread-safe. Releases the texture and adds its ID to the queue if
+         * it was marked with @ref ObjectFlag::DeleteOnDestruction.
+         */
+        void add(AbstractTexture&& texture);
+
+        /**
+         * @brief Add a mesh to the queue
+         *
+         * Thread-safe. Releases the mesh and adds its vertex array object ID
+         * to the queue if it was marked with
+         * @ref ObjectFlag::DeleteOnDestruction. If vertex array objects are
+         * not used, the mesh has no GL object and nothing is added.
+         */
+        void add(Mesh&& mesh);
+
+        /**
+         * @brief Count of objects waiting for the next @ref process() call
+         *
+         * Thread-safe.
+         */
+        std::size_t pendingCount() const;
+
+        /**
+         * @brief Count of objects waiting for their fence
+         *
+         * Objects that were already processed, but whose fence was not
+         * signaled yet. Always `0` if @extension{ARB,sync} is not available
+         * and on OpenGL ES 2.0 and WebGL 1.0.
+         */
+        std::size_t inFlightCount() const;
+
+        /**
+         * @brief Process the queue
+         * @return Count of deleted objects
+         *
+         * Has to be called on the context thread. Inserts a fence after all
+         * pending objects and deletes all objects whose fence is already
+         * signaled. Batches are deleted in the order they were processed,
+         * the first batch with a fence that's not signaled yet stops the
+         * deletion.
+         * @see @ref Fence::insert(), @ref Fence::isSignaled(),
+         *      @fn_gl_keyword{DeleteBuffers}, @fn_gl_keyword{DeleteTextures},
+         *      @fn_gl_keyword{DeleteVertexArrays}
+         */
+        std::size_t process();
+
+        /**
+         * @brief Delete all queued objects immediately
+         * @return Count of deleted objects
+         *
+         * Has to be called on the context thread. Deletes pending objects as
+         * well as objects waiting for their fence. Called automatically on
+         * @ref Context destruction.
+         */
+        std::size_t flush();
+
+    private:
+        struct Object {
+            Type type;
+            GLuint id;
+        };
+
+        #ifndef MAGNUM_TARGET_GLES2
+        struct Batch {
+            Fence fence;
+            std::vector<Object> objects;
+        };
+        #endif
+
+        MAGNUM_LOCAL static void deleteObjects(const std::vector<Object>& objects);
+
+        mutable std::mutex _mutex;
+        std::vector<Object> _pending;
+        #ifndef MAGNUM_TARGET_GLES2
+        std::deque<Batch> _batches;
+        std::size_t _inFlightCount{};
+        #endif
+};
+
+/** @debugoperatorclassenum{Magnum::DeletionQueue,Magnum::DeletionQueue::Type} */
+MAGNUM_EXPORT Debug& operator<<(Debug& debug, DeletionQueue::Type value);
+
+}
+
+#endif
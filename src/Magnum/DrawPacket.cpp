@@ -0,0 +1,306 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "DrawPacket.h"
+
+#include "Magnum/AbstractShaderProgram.h"
+#include "Magnum/AbstractTexture.h"
+#include "Magnum/Buffer.h"
+#include "Magnum/Context.h"
+#include "Magnum/Mesh.h"
+#include "Magnum/MeshView.h"
+#include "Magnum/Implementation/State.h"
+#include "Magnum/Implementation/MeshState.h"
+#include "Magnum/Implementation/ShaderProgramState.h"
+
+namespace Magnum {
+
+/* The draws are done directly with given GL function, the selection is done
+   only once in initialize(). Keep in sync with Mesh::drawInternal(). */
+struct DrawPacket::Draws {
+    static void generic(const DrawPacket& packet) {
+        packet.drawGeneric();
+    }
+
+    static void arrays(const DrawPacket& packet) {
+        glDrawArrays(packet._primitive, packet._baseVertex, packet._count);
+    }
+
+    static void elements(const DrawPacket& packet) {
+        glDrawElements(packet._primitive, packet._count, packet._indexType, reinterpret_cast<GLvoid*>(packet._indexOffset));
+    }
+
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    static void elementsRange(const DrawPacket& packet) {
+        glDrawRangeElements(packet._primitive, packet._indexStart, packet._indexEnd, packet._count, packet._indexType, reinterpret_cast<GLvoid*>(packet._indexOffset));
+    }
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    static void elementsBaseVertex(const DrawPacket& packet) {
+        glDrawElementsBaseVertex(packet._primitive, packet._count, packet._indexType, reinterpret_cast<GLvoid*>(packet._indexOffset), packet._baseVertex);
+    }
+
+    static void elementsRangeBaseVertex(const DrawPacket& packet) {
+        glDrawRangeElementsBaseVertex(packet._primitive, packet._indexStart, packet._indexEnd, packet._count, packet._indexType, reinterpret_cast<GLvoid*>(packet._indexOffset), packet._baseVertex);
+    }
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES2
+    static void arraysInstanced(const DrawPacket& packet) {
+        glDrawArraysInstanced(packet._primitive, packet._baseVertex, packet._count, packet._instanceCount);
+    }
+
+    static void elementsInstanced(const DrawPacket& packet) {
+        glDrawElementsInstanced(packet._primitive, packet._count, packet._indexType, reinterpret_cast<GLvoid*>(packet._indexOffset), packet._instanceCount);
+    }
+    #endif
+
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    static void elementsInstancedBaseVertex(const DrawPacket& packet) {
+        glDrawElementsInstancedBaseVertex(packet._primitive, packet._count, packet._indexType, reinterpret_cast<GLvoid*>(packet._indexOffset), packet._instanceCount, packet._baseVertex);
+    }
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    static void arraysInstancedBaseInstance(const DrawPacket& packet) {
+        glDrawArraysInstancedBaseInstance(packet._primitive, packet._baseVertex, packet._count, packet._instanceCount, packet._baseInstance);
+    }
+
+    static void elementsInstancedBaseInstance(const DrawPacket& packet) {
+        glDrawElementsInstancedBaseInstance(packet._primitive, packet._count, packet._indexType, reinterpret_cast<GLvoid*>(packet._indexOffset), packet._instanceCount, packet._baseInstance);
+    }
+
+    static void elementsInstancedBaseVertexBaseInstance(const DrawPacket& packet) {
+        glDrawElementsInstancedBaseVertexBaseInstance(packet._primitive, packet._count, packet._indexType, reinterpret_cast<GLvoid*>(packet._indexOffset), packet._instanceCount, packet._baseVertex, packet._baseInstance);
+    }
+    #endif
+};
+
+DrawPacket::DrawPacket(Mesh& mesh, AbstractShaderProgram& shader, const TextureBindingSet& textures
+    #ifndef MAGNUM_TARGET_GLES2
+    , std::initializer_list<UniformBuffer> uniformBuffers
+    #endif
+    ): _program{shader.id()}, _vao{}, _mesh{&mesh}, _primitive{GLenum(mesh._primitive)}, _indexType{GLenum(mesh._indexType)}, _count{mesh._count}, _baseVertex{mesh._baseVertex}, _instanceCount{mesh._instanceCount},
+    #ifndef MAGNUM_TARGET_GLES
+    _baseInstance{mesh._baseInstance},
+    #endif
+    #ifndef MAGNUM_TARGET_GLES2
+    _indexStart{mesh._indexStart}, _indexEnd{mesh._indexEnd},
+    #endif
+    _indexOffset{mesh._indexOffset}, _textures{textures}
+{
+    #ifndef MAGNUM_TARGET_GLES2
+    _uniformBuffers.reserve(uniformBuffers.size());
+    for(const UniformBuffer& buffer: uniformBuffers)
+        _uniformBuffers.push_back({buffer.index, buffer.buffer->id(), buffer.offset, buffer.size});
+    #endif
+
+    initialize();
+}
+
+DrawPacket::DrawPacket(MeshView& mesh, AbstractShaderProgram& shader, const TextureBindingSet& textures
+    #ifndef MAGNUM_TARGET_GLES2
+    , std::initializer_list<UniformBuffer> uniformBuffers
+    #endif
+    ): _program{shader.id()}, _vao{}, _mesh{&mesh._original.get()}, _primitive{GLenum(_mesh->_primitive)}, _indexType{GLenum(_mesh->_indexType)}, _count{mesh._count}, _baseVertex{mesh._baseVertex}, _instanceCount{mesh._instanceCount},
+    #ifndef MAGNUM_TARGET_GLES
+    _baseInstance{mesh._baseInstance},
+    #endif
+    #ifndef MAGNUM_TARGET_GLES2
+    _indexStart{mesh._indexStart}, _indexEnd{mesh._indexEnd},
+    #endif
+    _indexOffset{mesh._indexOffset}, _textures{textures}
+{
+    #ifndef MAGNUM_TARGET_GLES2
+    _uniformBuffers.reserve(uniformBuffers.size());
+    for(const UniformBuffer& buffer: uniformBuffers)
+        _uniformBuffers.push_back({buffer.index, buffer.buffer->id(), buffer.offset, buffer.size});
+    #endif
+
+    initialize();
+}
+
+void DrawPacket::initialize() {
+    _indexed = !!_mesh->_indexBuffer;
+
+    /* Nothing to draw */
+    if(!_count || !_instanceCount) {
+        _draw = nullptr;
+        return;
+    }
+
+    /* Fall back to the generic code path by default */
+    _draw = Draws::generic;
+
+    /* Direct draws are possible only if the mesh has its own VAO, otherwise
+       the attributes (or the shared vertex format buffers) have to be
+       specified on every draw */
+    if(Context::current().state().mesh->bindImplementation != &Mesh::bindImplementationVAO)
+        return;
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    if(_mesh->_vertexFormatShared) return;
+    #endif
+
+    void(*draw)(const DrawPacket&) = nullptr;
+
+    /* Non-instanced mesh */
+    if(_instanceCount == 1) {
+        if(!_indexed)
+            draw = Draws::arrays;
+        else if(_baseVertex) {
+            #ifndef MAGNUM_TARGET_GLES
+            draw = _indexEnd ? Draws::elementsRangeBaseVertex : Draws::elementsBaseVertex;
+            #endif
+        } else {
+            #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+            draw = _indexEnd ? Draws::elementsRange : Draws::elements;
+            #else
+            draw = Draws::elements;
+            #endif
+        }
+
+    /* Instanced mesh */
+    } else {
+        #ifndef MAGNUM_TARGET_GLES2
+        if(!_indexed) {
+            #ifndef MAGNUM_TARGET_GLES
+            draw = _baseInstance ? Draws::arraysInstancedBaseInstance : Draws::arraysInstanced;
+            #else
+            draw = Draws::arraysInstanced;
+            #endif
+        } else if(_baseVertex) {
+            #ifndef MAGNUM_TARGET_GLES
+            draw = _baseInstance ? Draws::elementsInstancedBaseVertexBaseInstance : Draws::elementsInstancedBaseVertex;
+            #elif !defined(MAGNUM_TARGET_WEBGL)
+            draw = Draws::elementsInstancedBaseVertex;
+            #endif
+        } else {
+            #ifndef MAGNUM_TARGET_GLES
+            draw = _baseInstance ? Draws::elementsInstancedBaseInstance : Draws::elementsInstanced;
+            #else
+            draw = Draws::elementsInstanced;
+            #endif
+        }
+        #endif
+    }
+
+    /* Unsupported combinations (such as base vertex on ES) go through the
+       generic path, which asserts */
+    if(!draw) return;
+
+    _draw = draw;
+    _vao = _mesh->_id;
+}
+
+void DrawPacket::drawGeneric() const {
+    #ifndef MAGNUM_TARGET_GLES
+    _mesh->drawInternal(_count, _baseVertex, _instanceCount, _baseInstance, _indexOffset, _indexStart, _indexEnd);
+    #elif !defined(MAGNUM_TARGET_GLES2)
+    _mesh->drawInternal(_count, _baseVertex, _instanceCount, _indexOffset, _indexStart, _indexEnd);
+    #else
+    _mesh->drawInternal(_count, _baseVertex, _instanceCount, _indexOffset);
+    #endif
+}
+
+UnsignedLong DrawPacket::sortKey() const {
+    const AbstractTexture* const texture = _textures.size() ? _textures.textures()[0] : nullptr;
+    return (UnsignedLong(_program & 0xffffff) << 40)|
+           (UnsignedLong((texture ? texture->id() : 0) & 0xfffff) << 20)|
+           (UnsignedLong(_vao & 0xfffff));
+}
+
+void DrawPacket::submit() const {
+    submitInternal(nullptr);
+}
+
+void DrawPacket::submit(const Containers::ArrayView<const DrawPacket> packets) {
+    const DrawPacket* previous = nullptr;
+    for(const DrawPacket& packet: packets) {
+        if(packet.isEmpty()) continue;
+        packet.submitInternal(previous);
+        previous = &packet;
+    }
+}
+
+void DrawPacket::submit(std::initializer_list<std::reference_wrapper<const DrawPacket>> packets) {
+    const DrawPacket* previous = nullptr;
+    for(const DrawPacket& packet: packets) {
+        if(packet.isEmpty()) continue;
+        packet.submitInternal(previous);
+        previous = &packet;
+    }
+}
+
+void DrawPacket::submitInternal(const DrawPacket* const previous) const {
+    /* Nothing to draw, exit without touching any state */
+    if(!_draw) return;
+
+    Implementation::State& state = Context::current().state();
+
+    GLuint& currentProgram = state.shaderProgram->current;
+    if(currentProgram != _program) {
+        glUseProgram(currentProgram = _program);
+        #ifdef MAGNUM_BUILD_STATISTICS
+        ++Context::current().statisticsInternal().programSwitchCount;
+        #endif
+    }
+
+    if(_textures.size()) _textures.bind();
+
+    #ifndef MAGNUM_TARGET_GLES2
+    /* Indexed buffer bindings are not tracked, the only thing that can be
+       skipped are bindings done by the previous packet in the list */
+    for(std::size_t i = 0; i != _uniformBuffers.size(); ++i) {
+        const UniformBufferBinding& binding = _uniformBuffers[i];
+        if(previous && i < previous->_uniformBuffers.size()) {
+            const UniformBufferBinding& previousBinding = previous->_uniformBuffers[i];
+            if(previousBinding.index == binding.index && previousBinding.id == binding.id && previousBinding.offset == binding.offset && previousBinding.size == binding.size)
+                continue;
+        }
+
+        glBindBufferRange(GL_UNIFORM_BUFFER, binding.index, binding.id, binding.offset, binding.size);
+    }
+    #else
+    static_cast<void>(previous);
+    #endif
+
+    /* Generic path, binds the mesh and updates statistics on its own */
+    if(!_vao) {
+        _draw(*this);
+        return;
+    }
+
+    GLuint& currentVAO = state.mesh->currentVAO;
+    if(currentVAO != _vao) Mesh::bindVAOImplementationVAO(_vao);
+
+    _draw(*this);
+
+    #ifdef MAGNUM_BUILD_STATISTICS
+    ++Context::current().statisticsInternal().drawCallCount;
+    #endif
+}
+
+}
@@ -0,0 +1,224 @@
+#ifndef Magnum_DrawPacket_h
+#define Magnum_DrawPacket_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::DrawPacket
+ */
+
+#include <functional>
+#include <initializer_list>
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/OpenGL.h"
+#include "Magnum/TextureBindingSet.h"
+#include "Magnum/visibility.h"
+
+namespace Magnum {
+
+/**
+@brief Pre-baked draw packet
+
+Combination of a mesh, a shader, a texture set and uniform buffer ranges
+compiled into a compact immutable structure. @ref Mesh::draw() derives the
+draw call from mesh properties on every call, the packet does that only once
+on construction and @ref submit() then just makes the shader current, binds
+the textures, uniform buffer ranges and the vertex array object and calls the
+pre-selected draw function:
+
+@snippet Magnum.cpp DrawPacket-usage
+
+The @ref submit(Containers::ArrayView<const DrawPacket>) overload submits a
+list of packets in a tight loop, skipping uniform buffer ranges that are the
+same as in the previous packet. Shader program, texture and vertex array
+object bindings are diffed against the state tracker in both cases. The
+packet can be also recorded into a @ref CommandBuffer using
+@ref CommandBuffer::draw(const DrawPacket&), ordered by @ref sortKey().
+
+@section DrawPacket-lifetime Packet lifetime
+
+The packet captures mesh properties such as vertex and index count, instance
+count and index buffer offset at the time it's constructed, so it has to be
+recreated when the mesh changes. The mesh, shader, textures and buffers are
+only referenced and have to stay alive for as long as the packet is used.
+Uniform values set directly on the shader are not part of the packet, use
+uniform buffers for per-packet data.
+
+On configurations where meshes don't use vertex array objects, use a shared
+vertex format or where the draw call needs a driver-specific entry point
+(instanced draws on OpenGL ES 2.0) the packet falls back to the same code
+path as @ref Mesh::draw(), it just skips the per-call state derivation.
+*/
+class MAGNUM_EXPORT DrawPacket {
+    friend CommandBuffer;
+
+    public:
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Uniform buffer range
+         *
+         * @requires_gl31 Extension @extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        struct UniformBuffer {
+            UnsignedInt index;  /**< Uniform buffer binding index */
+            Buffer* buffer;     /**< Buffer */
+            GLintptr offset;    /**< Offset of the range */
+            GLsizeiptr size;    /**< Size of the range */
+        };
+        #endif
+
+        /**
+         * @brief Submit a list of packets
+         *
+         * Equivalent to calling @ref submit() on all packets in order, but
+         * uniform buffer bindings that are the same as in the previous
+         * packet are skipped.
+         */
+        static void submit(Containers::ArrayView<const DrawPacket> packets);
+
+        /** @overload */
+        static void submit(std::initializer_list<std::reference_wrapper<const DrawPacket>> packets);
+
+        /**
+         * @brief Constructor
+         * @param mesh              Mesh to draw
+         * @param shader            Shader to draw the mesh with
+         * @param textures          Textures to bind
+         * @param uniformBuffers    Uniform buffer ranges to bind. Not
+         *      available on OpenGL ES 2.0 and WebGL 1.0.
+         *
+         * Captures current state of the mesh and selects the draw function.
+         * Doesn't call any OpenGL function.
+         */
+        explicit DrawPacket(Mesh& mesh, AbstractShaderProgram& shader, const TextureBindingSet& textures = TextureBindingSet{}
+            #ifndef MAGNUM_TARGET_GLES2
+            , std::initializer_list<UniformBuffer> uniformBuffers = {}
+            #endif
+            );
+
+        /**
+         * @brief Construct from a mesh view
+         *
+         * Same as above, but uses vertex and index range from given view.
+         */
+        explicit DrawPacket(MeshView& mesh, AbstractShaderProgram& shader, const TextureBindingSet& textures = TextureBindingSet{}
+            #ifndef MAGNUM_TARGET_GLES2
+            , std::initializer_list<UniformBuffer> uniformBuffers = {}
+            #endif
+            );
+
+        /**
+         * @brief Whether the packet is empty
+         *
+         * Returns @cpp true @ce if vertex or instance count is zero, in which
+         * case @ref submit() does nothing.
+         */
+        bool isEmpty() const { return !_draw; }
+
+        /** @brief Shader program ID */
+        GLuint shaderId() const { return _program; }
+
+        /**
+         * @brief Vertex array object ID
+         *
+         * Returns @cpp 0 @ce if the packet goes through the @ref Mesh::draw()
+         * code path.
+         */
+        GLuint meshId() const { return _vao; }
+
+        /** @brief Vertex or index count */
+        Int count() const { return _count; }
+
+        /** @brief Instance count */
+        Int instanceCount() const { return _instanceCount; }
+
+        /** @brief Textures */
+        const TextureBindingSet& textures() const { return _textures; }
+
+        /**
+         * @brief Sort key
+         *
+         * Shader program ID in the upper 24 bits, ID of the first texture in
+         * the set in the next 20 bits and vertex array object ID in the lower
+         * 20 bits, suitable for @ref CommandBuffer::begin() to group packets
+         * by state. IDs that don't fit are truncated.
+         */
+        UnsignedLong sortKey() const;
+
+        /**
+         * @brief Submit the packet
+         *
+         * Has to be called on the context thread.
+         * @see @fn_gl_keyword{UseProgram}, @fn_gl_keyword{BindBufferRange},
+         *      @fn_gl_keyword{BindVertexArray}, @fn_gl_keyword{DrawArrays},
+         *      @fn_gl_keyword{DrawElements} and their variants
+         */
+        void submit() const;
+
+    private:
+        struct Draws;
+
+        #ifndef MAGNUM_TARGET_GLES2
+        struct UniformBufferBinding {
+            UnsignedInt index;
+            GLuint id;
+            GLintptr offset;
+            GLsizeiptr size;
+        };
+        #endif
+
+        void MAGNUM_LOCAL initialize();
+        void MAGNUM_LOCAL drawGeneric() const;
+        void MAGNUM_LOCAL submitInternal(const DrawPacket* previous) const;
+
+        void(*_draw)(const DrawPacket&);
+        GLuint _program, _vao;
+        Mesh* _mesh;
+        GLenum _primitive, _indexType;
+        Int _count, _baseVertex, _instanceCount;
+        #ifndef MAGNUM_TARGET_GLES
+        UnsignedInt _baseInstance;
+        #endif
+        #ifndef MAGNUM_TARGET_GLES2
+        UnsignedInt _indexStart, _indexEnd;
+        #endif
+        GLintptr _indexOffset;
+        bool _indexed;
+
+        TextureBindingSet _textures;
+        #ifndef MAGNUM_TARGET_GLES2
+        std::vector<UniformBufferBinding> _uniformBuffers;
+        #endif
+};
+
+}
+
+#endif
@@ -0,0 +1,120 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "DynamicResolution.h"
+
+#include <cmath>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Functions.h"
+
+#if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+#include "Magnum/AbstractFramebuffer.h"
+#endif
+
+namespace Magnum {
+
+DynamicResolution::DynamicResolution(const Vector2i& outputSize, const std::chrono::nanoseconds targetFrameTime): _outputSize{outputSize}, _targetFrameTime{targetFrameTime} {}
+
+DynamicResolution& DynamicResolution::setOutputSize(const Vector2i& size) {
+    _outputSize = size;
+    return *this;
+}
+
+DynamicResolution& DynamicResolution::setTargetFrameTime(const std::chrono::nanoseconds time) {
+    _targetFrameTime = time;
+    return *this;
+}
+
+DynamicResolution& DynamicResolution::setScaleRange(const Float min, const Float max) {
+    CORRADE_ASSERT(min > 0.0f && min <= max,
+        "DynamicResolution::setScaleRange(): invalid range" << min << max, *this);
+    _minScale = min;
+    _maxScale = max;
+    _scale = Math::clamp(_scale, min, max);
+    return *this;
+}
+
+DynamicResolution& DynamicResolution::setSmoothing(const Float smoothing) {
+    CORRADE_ASSERT(smoothing >= 0.0f && smoothing < 1.0f,
+        "DynamicResolution::setSmoothing(): expected a value in range [0, 1) but got" << smoothing, *this);
+    _smoothing = smoothing;
+    return *this;
+}
+
+DynamicResolution& DynamicResolution::setHysteresis(const Float hysteresis) {
+    _hysteresis = hysteresis;
+    return *this;
+}
+
+DynamicResolution& DynamicResolution::setHeadroom(const Float headroom) {
+    CORRADE_ASSERT(headroom > 0.0f && headroom <= 1.0f,
+        "DynamicResolution::setHeadroom(): expected a value in range (0, 1] but got" << headroom, *this);
+    _headroom = headroom;
+    return *this;
+}
+
+DynamicResolution& DynamicResolution::setGranularity(const Int granularity) {
+    CORRADE_ASSERT(granularity > 0,
+        "DynamicResolution::setGranularity(): expected a positive value but got" << granularity, *this);
+    _granularity = granularity;
+    return *this;
+}
+
+bool DynamicResolution::update(const std::chrono::nanoseconds gpuFrameTime) {
+    /* The first measurement initializes the smoothed value */
+    if(_smoothedFrameTime == std::chrono::nanoseconds::zero())
+        _smoothedFrameTime = gpuFrameTime;
+    else _smoothedFrameTime = std::chrono::nanoseconds{Long(_smoothing*_smoothedFrameTime.count() + (1.0f - _smoothing)*gpuFrameTime.count())};
+
+    /* Nothing measured (or a broken measurement), keep the scale */
+    if(_smoothedFrameTime <= std::chrono::nanoseconds::zero()) return false;
+
+    /* Frame time is roughly proportional to pixel count, which is
+       proportional to the scale squared */
+    const Float ideal = Math::clamp(_scale*std::sqrt(_headroom*Float(_targetFrameTime.count())/Float(_smoothedFrameTime.count())), _minScale, _maxScale);
+    if(std::abs(ideal - _scale) <= _hysteresis) return false;
+
+    const Vector2i previousSize = renderSize();
+    _scale = ideal;
+    return renderSize() != previousSize;
+}
+
+Vector2i DynamicResolution::renderSize() const {
+    const Vector2i size = Math::max(Vector2i{Math::round(Vector2{_outputSize}*_scale/Float(_granularity))}*_granularity, _granularity);
+    return Math::min(size, Math::max(Vector2i{Vector2{_outputSize}*_maxScale}, 1));
+}
+
+Range2Di DynamicResolution::viewport() const {
+    return {{}, renderSize()};
+}
+
+#if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+void DynamicResolution::upscale(AbstractFramebuffer& source, AbstractFramebuffer& destination) const {
+    AbstractFramebuffer::blit(source, destination, viewport(), destination.viewport(), FramebufferBlit::Color, FramebufferBlitFilter::Linear);
+}
+#endif
+
+}
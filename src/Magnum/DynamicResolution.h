@@ -0,0 +1,253 @@
+#ifndef Magnum_DynamicResolution_h
+#define Magnum_DynamicResolution_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::DynamicResolution
+ */
+
+#include <chrono>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/visibility.h"
+
+namespace Magnum {
+
+/**
+@brief Dynamic resolution controller
+
+Trades render resolution for frame time in fill-rate-bound scenes. The scene is
+rendered into intermediate targets of @ref renderSize(), which is a fraction
+of the output size given by @ref scale(), and then upscaled to the output
+framebuffer with @ref upscale(). Each frame, @ref update() is fed with
+measured GPU frame time and adjusts the scale so the frame time stays under
+the target --- for example @cpp 16.6 @ce ms for 60 Hz:
+
+@code{.cpp}
+DebugTools::FrameProfiler profiler;
+DebugTools::FrameProfiler::Section frame = profiler.addSection("frame");
+RenderTargetPool pool;
+DynamicResolution resolution{defaultFramebuffer.viewport().size(),
+    std::chrono::microseconds{16600}};
+
+// each frame
+profiler.begin(frame);
+Texture2D& color = pool.acquireTexture(TextureFormat::RGBA8, resolution.renderSize());
+Framebuffer framebuffer{resolution.viewport()};
+framebuffer.attachTexture(Framebuffer::ColorAttachment{0}, color, 0);
+// render the scene into framebuffer ...
+resolution.upscale(framebuffer, defaultFramebuffer);
+pool.release(color);
+profiler.end();
+
+profiler.nextFrame();
+pool.nextFrame();
+if(profiler.gpuFrameCount() != lastGpuFrameCount) {
+    lastGpuFrameCount = profiler.gpuFrameCount();
+    resolution.update(profiler.lastGpuDuration(frame));
+}
+@endcode
+
+@section DynamicResolution-controller Controller
+
+Fill-rate-bound frame time is roughly proportional to pixel count, so the
+scale needed to hit the target is the current scale multiplied by a square
+root of the target to measured time ratio. To avoid reacting to single
+spikes, the measured time is first exponentially smoothed, see
+@ref setSmoothing(). The scale is then changed only if it differs from the
+ideal value by more than @ref hysteresis() and it's always clamped to
+@ref minScale() and @ref maxScale(). The controller aims slightly below the
+target to have some headroom, see @ref setHeadroom().
+
+The render size is rounded to a multiple of @ref granularity() pixels. Apart
+from being friendlier to the hardware, this means the scale fluctuating
+slightly doesn't result in a new render target size each frame, so
+@ref RenderTargetPool can keep reusing the same targets.
+
+If the GPU time measurement lags behind, for example when using
+@ref DebugTools::FrameProfiler, which retrieves GPU times a few frames later,
+the scale reacts to every change with that delay. A higher smoothing factor
+then helps against oscillating.
+*/
+class MAGNUM_EXPORT DynamicResolution {
+    public:
+        /**
+         * @brief Constructor
+         * @param outputSize        Size of the output framebuffer
+         * @param targetFrameTime   Target GPU frame time
+         *
+         * The initial scale is @ref maxScale().
+         */
+        explicit DynamicResolution(const Vector2i& outputSize, std::chrono::nanoseconds targetFrameTime);
+
+        /** @brief Output size */
+        Vector2i outputSize() const { return _outputSize; }
+
+        /**
+         * @brief Set output size
+         * @return Reference to self (for method chaining)
+         *
+         * Call when the output framebuffer is resized. The scale is kept.
+         */
+        DynamicResolution& setOutputSize(const Vector2i& size);
+
+        /** @brief Target GPU frame time */
+        std::chrono::nanoseconds targetFrameTime() const { return _targetFrameTime; }
+
+        /**
+         * @brief Set target GPU frame time
+         * @return Reference to self (for method chaining)
+         */
+        DynamicResolution& setTargetFrameTime(std::chrono::nanoseconds time);
+
+        /** @brief Minimal scale */
+        Float minScale() const { return _minScale; }
+
+        /** @brief Maximal scale */
+        Float maxScale() const { return _maxScale; }
+
+        /**
+         * @brief Set scale range
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @cpp 0 < min <= max @ce. Current scale is clamped to
+         * the new range. Default is @cpp 0.5f @ce to @cpp 1.0f @ce. The
+         * maximum can be larger than @cpp 1.0f @ce for supersampling.
+         */
+        DynamicResolution& setScaleRange(Float min, Float max);
+
+        /** @brief Smoothing factor */
+        Float smoothing() const { return _smoothing; }
+
+        /**
+         * @brief Set smoothing factor
+         * @return Reference to self (for method chaining)
+         *
+         * Weight of the previous smoothed frame time when a new one gets
+         * measured. Expects a value in range @f$ [0, 1) @f$, @cpp 0.0f @ce
+         * means no smoothing. Default is @cpp 0.75f @ce.
+         */
+        DynamicResolution& setSmoothing(Float smoothing);
+
+        /** @brief Hysteresis */
+        Float hysteresis() const { return _hysteresis; }
+
+        /**
+         * @brief Set hysteresis
+         * @return Reference to self (for method chaining)
+         *
+         * Scale is changed only if the ideal scale differs from current by
+         * more than given value. Default is @cpp 0.05f @ce.
+         */
+        DynamicResolution& setHysteresis(Float hysteresis);
+
+        /** @brief Headroom */
+        Float headroom() const { return _headroom; }
+
+        /**
+         * @brief Set headroom
+         * @return Reference to self (for method chaining)
+         *
+         * Fraction of @ref targetFrameTime() the controller aims at. Expects
+         * a value in range @f$ (0, 1] @f$. Default is @cpp 0.9f @ce.
+         */
+        DynamicResolution& setHeadroom(Float headroom);
+
+        /** @brief Render size granularity */
+        Int granularity() const { return _granularity; }
+
+        /**
+         * @brief Set render size granularity
+         * @return Reference to self (for method chaining)
+         *
+         * Expects a positive value. Default is @cpp 8 @ce.
+         */
+        DynamicResolution& setGranularity(Int granularity);
+
+        /** @brief Current scale */
+        Float scale() const { return _scale; }
+
+        /**
+         * @brief Smoothed GPU frame time
+         *
+         * Returns zero duration if @ref update() wasn't called yet.
+         */
+        std::chrono::nanoseconds smoothedFrameTime() const { return _smoothedFrameTime; }
+
+        /**
+         * @brief Update the scale
+         * @param gpuFrameTime  Measured GPU frame time
+         * @return Whether @ref renderSize() changed
+         *
+         * Call once for each new measurement. The measured time is expected
+         * to be rendered with current @ref renderSize().
+         */
+        bool update(std::chrono::nanoseconds gpuFrameTime);
+
+        /**
+         * @brief Render size
+         *
+         * @ref outputSize() multiplied by @ref scale() and rounded to a
+         * multiple of @ref granularity(), but at least @ref granularity() and
+         * at most @ref outputSize() multiplied by @ref maxScale().
+         */
+        Vector2i renderSize() const;
+
+        /**
+         * @brief Render viewport
+         *
+         * Range from origin to @ref renderSize().
+         */
+        Range2Di viewport() const;
+
+        #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+        /**
+         * @brief Upscale to output framebuffer
+         *
+         * Blits @ref viewport() of @p source to the whole
+         * @ref AbstractFramebuffer::viewport() "viewport" of @p destination
+         * with @ref FramebufferBlitFilter::Linear. For better quality,
+         * render a fullscreen pass sampling the render target with a custom
+         * upscaling filter instead.
+         * @requires_gl30 Extension @extension{ARB,framebuffer_object}
+         * @requires_gles30 Extension @extension{ANGLE,framebuffer_blit} or
+         *      @extension{NV,framebuffer_blit} in OpenGL ES 2.0.
+         * @requires_webgl20 Framebuffer blit is not available in WebGL 1.0.
+         */
+        void upscale(AbstractFramebuffer& source, AbstractFramebuffer& destination) const;
+        #endif
+
+    private:
+        Vector2i _outputSize;
+        std::chrono::nanoseconds _targetFrameTime, _smoothedFrameTime{};
+        Float _minScale{0.5f}, _maxScale{1.0f}, _smoothing{0.75f}, _hysteresis{0.05f}, _headroom{0.9f}, _scale{1.0f};
+        Int _granularity{8};
+};
+
+}
+
+#endif
@@ -217,6 +217,7 @@ namespace AMD {
     _extension(132,GL,ARB,texture_filter_anisotropic,   GL210, GL460) // #195
 } namespace ATI {
     _extension(133,GL,ATI,texture_mirror_once,          GL210,  None) // #221
+    _extension(134,GL,ATI,meminfo,                      GL210,  None) // #359
 } namespace EXT {
     _extension(140,GL,EXT,texture_filter_anisotropic,   GL210,  None) // #187
     _extension(141,GL,EXT,texture_compression_s3tc,     GL210,  None) // #198
@@ -249,11 +250,14 @@ namespace AMD {
     _extension(166,GL,KHR,blend_equation_advanced,      GL210,  None) // #174
     _extension(167,GL,KHR,blend_equation_advanced_coherent, GL210, None) // #174
     _extension(168,GL,KHR,no_error,                     GL210,  None) // #175
+    _extension(172,GL,KHR,parallel_shader_compile,      GL210,  None) // #192
 } namespace NV {
     _extension(169,GL,NV,primitive_restart,             GL210, GL310) // #285
     _extension(170,GL,NV,depth_buffer_float,            GL210, GL300) // #334
     _extension(171,GL,NV,conditional_render,            GL210, GL300) // #346
     /* NV_draw_texture not supported */                               // #430
+} namespace NVX {
+    _extension(173,GL,NVX,gpu_memory_info,              GL210,  None) // #438
 }
 /* IMPORTANT: if this line is > 329 (73 + size), don't forget to update array size in Context.h */
 #elif defined(MAGNUM_TARGET_WEBGL)
@@ -399,6 +403,7 @@ namespace ANDROID {
     _extension( 76,GL,KHR,robust_buffer_access_behavior, GLES200, GLES320) // #189
     _extension( 77,GL,KHR,context_flush_control,    GLES200,    None) // #191
     _extension( 78,GL,KHR,no_error,                 GLES200,    None) // #243
+    _extension( 79,GL,KHR,parallel_shader_compile,  GLES200,    None) // #288
 } namespace NV {
     #ifdef MAGNUM_TARGET_GLES2
     _extension( 80,GL,NV,draw_buffers,              GLES200, GLES300) // #91
@@ -0,0 +1,82 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Fence.h"
+
+#include <Corrade/Utility/Debug.h>
+
+namespace Magnum {
+
+Fence::~Fence() {
+    /* Moved out or not inserted yet, nothing to do */
+    if(!_sync) return;
+
+    glDeleteSync(_sync);
+}
+
+Fence& Fence::insert() {
+    if(_sync) glDeleteSync(_sync);
+    _sync = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    return *this;
+}
+
+bool Fence::isSignaled() {
+    if(!_sync) return true;
+
+    GLint status;
+    glGetSynciv(_sync, GL_SYNC_STATUS, 1, nullptr, &status);
+    return status == GL_SIGNALED;
+}
+
+Fence::WaitResult Fence::clientWait(const std::chrono::nanoseconds timeout) {
+    if(!_sync) return WaitResult::AlreadySignaled;
+
+    return WaitResult(glClientWaitSync(_sync, GL_SYNC_FLUSH_COMMANDS_BIT, GLuint64(timeout.count())));
+}
+
+void Fence::wait() {
+    if(!_sync) return;
+
+    glWaitSync(_sync, 0, GL_TIMEOUT_IGNORED);
+}
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+Debug& operator<<(Debug& debug, const Fence::WaitResult value) {
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case Fence::WaitResult::value: return debug << "Fence::WaitResult::" #value;
+        _c(AlreadySignaled)
+        _c(ConditionSatisfied)
+        _c(TimeoutExpired)
+        _c(WaitFailed)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "Fence::WaitResult(" << Debug::nospace << reinterpret_cast<void*>(GLenum(value)) << Debug::nospace << ")";
+}
+#endif
+
+}
@@ -0,0 +1,183 @@
+#ifndef Magnum_Fence_h
+#define Magnum_Fence_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef MAGNUM_TARGET_GLES2
+/** @file
+ * @brief Class @ref Magnum::Fence
+ */
+#endif
+
+#include <chrono>
+#include <utility>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/OpenGL.h"
+#include "Magnum/visibility.h"
+
+#ifndef MAGNUM_TARGET_GLES2
+namespace Magnum {
+
+/**
+@brief Fence sync object
+
+Allows the application to find out when the GPU finished executing all
+commands submitted before the fence was inserted, for example to know when
+a region of a persistently mapped @ref Buffer can be overwritten again
+without stalling the pipeline or orphaning the buffer. The fence is empty
+after construction, insert it into the command stream using @ref insert():
+
+@snippet Magnum.cpp Fence-usage
+
+Then either poll it with @ref isSignaled(), block the client until it is
+signaled with @ref clientWait() or make the GL server wait for it with
+@ref wait(). Calling @ref insert() again replaces the previous sync object
+with a new one. See @ref StreamingBuffer for a higher-level abstraction built
+on top of this class.
+
+@requires_gl32 Extension @extension{ARB,sync}
+@requires_gles30 Sync objects are not available in OpenGL ES 2.0.
+@requires_webgl20 Sync objects are not available in WebGL 1.0.
+*/
+class MAGNUM_EXPORT Fence {
+    public:
+        /**
+         * @brief Client wait result
+         *
+         * @see @ref clientWait()
+         */
+        enum class WaitResult: GLenum {
+            /** The fence was already signaled when the wait started */
+            AlreadySignaled = GL_ALREADY_SIGNALED,
+
+            /** The fence got signaled before the timeout expired */
+            ConditionSatisfied = GL_CONDITION_SATISFIED,
+
+            /** The timeout expired before the fence got signaled */
+            TimeoutExpired = GL_TIMEOUT_EXPIRED,
+
+            /** An error occured */
+            WaitFailed = GL_WAIT_FAILED
+        };
+
+        /**
+         * @brief Constructor
+         *
+         * Creates an empty fence, no OpenGL object is created until
+         * @ref insert() is called.
+         */
+        explicit Fence() noexcept: _sync{} {}
+
+        /** @brief Copying is not allowed */
+        Fence(const Fence&) = delete;
+
+        /** @brief Move constructor */
+        Fence(Fence&& other) noexcept: _sync{other._sync} {
+            other._sync = {};
+        }
+
+        /**
+         * @brief Destructor
+         *
+         * Deletes the sync object, if any.
+         * @see @fn_gl_keyword{DeleteSync}
+         */
+        ~Fence();
+
+        /** @brief Copying is not allowed */
+        Fence& operator=(const Fence&) = delete;
+
+        /** @brief Move assignment */
+        Fence& operator=(Fence&& other) noexcept {
+            std::swap(_sync, other._sync);
+            return *this;
+        }
+
+        /** @brief OpenGL sync object or @cpp nullptr @ce if empty */
+        GLsync id() const { return _sync; }
+
+        /**
+         * @brief Whether the fence is empty
+         *
+         * Returns @cpp true @ce if @ref insert() wasn't called yet.
+         */
+        bool isEmpty() const { return !_sync; }
+
+        /**
+         * @brief Insert the fence into the command stream
+         * @return Reference to self (for method chaining)
+         *
+         * Deletes the previous sync object, if any, and creates a new one
+         * that gets signaled once all preceding commands are finished.
+         * @see @fn_gl_keyword{FenceSync} with
+         *      @def_gl{SYNC_GPU_COMMANDS_COMPLETE}, @fn_gl_keyword{DeleteSync}
+         */
+        Fence& insert();
+
+        /**
+         * @brief Whether the fence is signaled
+         *
+         * Doesn't block. Returns @cpp true @ce also for an empty fence, as
+         * there's nothing to wait for.
+         * @see @fn_gl_keyword{GetSync} with @def_gl{SYNC_STATUS}
+         */
+        bool isSignaled();
+
+        /**
+         * @brief Block the client until the fence is signaled
+         * @param timeout   Maximal time to wait
+         *
+         * Flushes the command stream before waiting, so the wait doesn't
+         * deadlock if the fence wasn't submitted yet. Returns
+         * @ref WaitResult::AlreadySignaled for an empty fence.
+         * @see @fn_gl_keyword{ClientWaitSync} with
+         *      @def_gl{SYNC_FLUSH_COMMANDS_BIT}
+         */
+        WaitResult clientWait(std::chrono::nanoseconds timeout);
+
+        /**
+         * @brief Make the GL server wait for the fence
+         *
+         * Doesn't block the client, only the subsequent GL commands are not
+         * executed before the fence is signaled. Does nothing for an empty
+         * fence.
+         * @see @fn_gl_keyword{WaitSync}
+         */
+        void wait();
+
+    private:
+        GLsync _sync;
+};
+
+/** @debugoperatorclassenum{Magnum::Fence,Magnum::Fence::WaitResult} */
+MAGNUM_EXPORT Debug& operator<<(Debug& debug, Fence::WaitResult value);
+
+}
+#else
+#error this header is not available in OpenGL ES 2.0 build
+#endif
+
+#endif
@@ -0,0 +1,107 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "FrameAllocator.h"
+
+#include <cstdint>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Math/Functions.h"
+
+namespace Magnum {
+
+namespace {
+    #ifdef MAGNUM_BUILD_MULTITHREADED
+    #if !defined(CORRADE_GCC47_COMPATIBILITY) && !defined(CORRADE_TARGET_APPLE)
+    thread_local
+    #else
+    __thread
+    #endif
+    #endif
+    FrameAllocator* currentAllocator = nullptr;
+}
+
+FrameAllocator* FrameAllocator::current() { return currentAllocator; }
+
+FrameAllocator::FrameAllocator(const std::size_t capacity): _initialCapacity{capacity}, _current{}, _end{}, _usedSize{} {}
+
+FrameAllocator::~FrameAllocator() {
+    if(currentAllocator == this) currentAllocator = nullptr;
+}
+
+FrameAllocator& FrameAllocator::makeCurrent() {
+    currentAllocator = this;
+    return *this;
+}
+
+std::size_t FrameAllocator::capacity() const {
+    if(_blocks.empty()) return _initialCapacity;
+
+    std::size_t capacity = 0;
+    for(const Containers::Array<char>& block: _blocks) capacity += block.size();
+    return capacity;
+}
+
+void* FrameAllocator::allocate(const std::size_t size, const std::size_t alignment) {
+    CORRADE_ASSERT(alignment && !(alignment & (alignment - 1)),
+        "FrameAllocator::allocate(): expected alignment to be a power of two but got" << alignment, nullptr);
+
+    if(!size) return nullptr;
+
+    std::uintptr_t data = (reinterpret_cast<std::uintptr_t>(_current) + alignment - 1) & ~(alignment - 1);
+
+    /* Not enough space (or no block yet), allocate a new block. It's always
+       at least twice as large as the previous one so the count of blocks
+       stays logarithmic. */
+    if(!_current || data + size > reinterpret_cast<std::uintptr_t>(_end)) {
+        const std::size_t blockSize = Math::max(
+            _blocks.empty() ? _initialCapacity : _blocks.back().size()*2,
+            size + alignment - 1);
+        _blocks.emplace_back(blockSize);
+        _current = _blocks.back();
+        _end = _current + blockSize;
+        data = (reinterpret_cast<std::uintptr_t>(_current) + alignment - 1) & ~(alignment - 1);
+    }
+
+    _usedSize += data + size - reinterpret_cast<std::uintptr_t>(_current);
+    _current = reinterpret_cast<char*>(data + size);
+    return reinterpret_cast<void*>(data);
+}
+
+void FrameAllocator::reset() {
+    /* Merge all blocks into one so next frame fits without growing */
+    if(_blocks.size() > 1) {
+        const std::size_t size = capacity();
+        _blocks.clear();
+        _blocks.emplace_back(size);
+    }
+
+    _current = _blocks.empty() ? nullptr : _blocks.front().data();
+    _end = _blocks.empty() ? nullptr : _blocks.front().data() + _blocks.front().size();
+    _usedSize = 0;
+}
+
+}
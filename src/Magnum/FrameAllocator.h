@@ -0,0 +1,280 @@
+#ifndef Magnum_FrameAllocator_h
+#define Magnum_FrameAllocator_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::FrameAllocator, @ref Magnum::FrameAllocatorAdapter
+ */
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <vector>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/visibility.h"
+
+namespace Magnum {
+
+/**
+@brief Per-frame linear allocator
+
+Hands out transient memory for the duration of a single frame by bumping a
+pointer in a contiguous block, without any locking or bookkeeping per
+allocation. Individual allocations are never freed, instead everything is
+released at once with @ref reset(), usually at frame boundary. Setting the
+allocator to a @ref Timeline using @ref Timeline::setFrameAllocator() resets
+it on every @ref Timeline::nextFrame():
+
+@code{.cpp}
+FrameAllocator allocator;
+timeline.setFrameAllocator(&allocator);
+
+// in the draw event
+Containers::ArrayView<UnsignedInt> visible = allocator.allocate<UnsignedInt>(count);
+@endcode
+
+When an allocation doesn't fit into the current memory block, a new block of
+twice the size is allocated. On @ref reset() all blocks are merged into a
+single one large enough for everything allocated during the previous frame,
+so after a few frames the allocator settles on a single block and doesn't
+touch the system allocator at all.
+
+@section FrameAllocator-current Per-thread allocators and use in other subsystems
+
+The allocator is not thread-safe, each thread that needs transient memory
+should have its own instance. Subsystems that allocate temporary storage on
+every frame, such as @ref Text::BatchRenderer::update(), take memory from the
+@ref current() allocator through @ref FrameAllocatorAdapter and fall back to
+the system allocator if there's none. There's no current allocator by
+default, an allocator is made current for the calling thread explicitly with
+@ref makeCurrent():
+
+@code{.cpp}
+FrameAllocator allocator;
+timeline.setFrameAllocator(&allocator);
+allocator.makeCurrent();
+@endcode
+
+As the adapter never frees anything, the current allocator grows with every
+allocation until it's reset. Make an allocator current only if something
+resets it regularly, such as the @ref Timeline above. Use the adapter for your
+own temporary containers as well:
+
+@code{.cpp}
+std::vector<Vector3, FrameAllocatorAdapter<Vector3>> positions;
+positions.reserve(count);
+@endcode
+
+Memory taken from the allocator has to be released before @ref reset() is
+called, which for memory taken from @ref current() means not keeping it
+across frames.
+*/
+class MAGNUM_EXPORT FrameAllocator {
+    public:
+        /**
+         * @brief Current allocator for this thread
+         *
+         * Returns @cpp nullptr @ce if no allocator was made current in this
+         * thread using @ref makeCurrent(). See @ref FrameAllocator-current
+         * for more information.
+         */
+        static FrameAllocator* current();
+
+        /**
+         * @brief Constructor
+         * @param capacity  Size of the first memory block in bytes
+         *
+         * The memory is allocated on first call to @ref allocate(). The
+         * allocator is not made @ref current(), use @ref makeCurrent() for
+         * that.
+         */
+        explicit FrameAllocator(std::size_t capacity = 65536);
+
+        /** @brief Copying is not allowed */
+        FrameAllocator(const FrameAllocator&) = delete;
+
+        /** @brief Moving is not allowed */
+        FrameAllocator(FrameAllocator&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * If the allocator is @ref current(), there's no current allocator
+         * in this thread afterwards.
+         */
+        ~FrameAllocator();
+
+        /** @brief Copying is not allowed */
+        FrameAllocator& operator=(const FrameAllocator&) = delete;
+
+        /** @brief Moving is not allowed */
+        FrameAllocator& operator=(FrameAllocator&&) = delete;
+
+        /**
+         * @brief Make the allocator current for this thread
+         * @return Reference to self (for method chaining)
+         *
+         * Replaces the previous @ref current() allocator, if any. The
+         * allocator is then used by all subsystems taking temporary memory
+         * through @ref FrameAllocatorAdapter, so it has to be regularly
+         * @ref reset(), for example by @ref Timeline::setFrameAllocator(),
+         * otherwise it grows indefinitely. See @ref FrameAllocator-current
+         * for more information.
+         */
+        FrameAllocator& makeCurrent();
+
+        /**
+         * @brief Total size of all memory blocks in bytes
+         *
+         * Before the first allocation this is the capacity passed to the
+         * constructor.
+         */
+        std::size_t capacity() const;
+
+        /** @brief Count of memory blocks */
+        std::size_t blockCount() const { return _blocks.size(); }
+
+        /**
+         * @brief Size of memory used since last reset in bytes
+         *
+         * Includes alignment padding, but not the unused space at the end
+         * of blocks that had to be skipped when allocating a new block.
+         */
+        std::size_t usedSize() const { return _usedSize; }
+
+        /**
+         * @brief Allocate memory
+         *
+         * Returns memory of at least @p size bytes aligned to @p alignment,
+         * which is expected to be a power of two. The memory is valid until
+         * next @ref reset(). Returns @cpp nullptr @ce if @p size is zero.
+         */
+        void* allocate(std::size_t size, std::size_t alignment = 2*sizeof(void*));
+
+        /**
+         * @brief Allocate an array
+         *
+         * The elements are default-constructed, which means trivial types
+         * are left uninitialized. The type is expected to be trivially
+         * destructible, as no destructors are ever called.
+         */
+        template<class T> Containers::ArrayView<T> allocate(std::size_t count);
+
+        /**
+         * @brief Release all memory
+         *
+         * All memory returned from @ref allocate() is invalidated. If more
+         * than one block was allocated since the last reset, the blocks are
+         * replaced with a single one of size equal to @ref capacity().
+         * @see @ref Timeline::setFrameAllocator()
+         */
+        void reset();
+
+    private:
+        std::size_t _initialCapacity;
+        std::vector<Containers::Array<char>> _blocks;
+        char* _current;
+        char* _end;
+        std::size_t _usedSize;
+};
+
+/**
+@brief Standard allocator adapter for @ref FrameAllocator
+
+Makes it possible to use @ref FrameAllocator in STL containers. Deallocation
+does nothing, the memory is released on @ref FrameAllocator::reset(). If
+constructed with a @cpp nullptr @ce allocator, which is the case with the
+default constructor when there's no @ref FrameAllocator::current() allocator,
+uses the default system allocator instead. See
+@ref FrameAllocator-current for an example.
+*/
+template<class T> class FrameAllocatorAdapter {
+    public:
+        typedef T value_type; /**< @brief Value type */
+
+        /**
+         * @brief Constructor
+         *
+         * By default takes the @ref FrameAllocator::current() allocator.
+         */
+        /*implicit*/ FrameAllocatorAdapter(FrameAllocator* allocator = FrameAllocator::current()) noexcept: _allocator{allocator} {}
+
+        /** @brief Construct from adapter of another type */
+        template<class U> /*implicit*/ FrameAllocatorAdapter(const FrameAllocatorAdapter<U>& other) noexcept: _allocator{other.allocator()} {}
+
+        /**
+         * @brief Underlying allocator
+         *
+         * If @cpp nullptr @ce, the system allocator is used.
+         */
+        FrameAllocator* allocator() const { return _allocator; }
+
+        /** @brief Allocate memory for @p count elements */
+        T* allocate(std::size_t count) {
+            return static_cast<T*>(_allocator ?
+                _allocator->allocate(count*sizeof(T), alignof(T)) :
+                ::operator new(count*sizeof(T)));
+        }
+
+        /** @brief Deallocate memory */
+        void deallocate(T* data, std::size_t) {
+            if(!_allocator) ::operator delete(data);
+        }
+
+    private:
+        FrameAllocator* _allocator;
+};
+
+/** @relates FrameAllocatorAdapter
+@brief Equality comparison
+
+Adapters are equal if they use the same allocator.
+*/
+template<class T, class U> inline bool operator==(const FrameAllocatorAdapter<T>& a, const FrameAllocatorAdapter<U>& b) {
+    return a.allocator() == b.allocator();
+}
+
+/** @relates FrameAllocatorAdapter
+@brief Non-equality comparison
+*/
+template<class T, class U> inline bool operator!=(const FrameAllocatorAdapter<T>& a, const FrameAllocatorAdapter<U>& b) {
+    return a.allocator() != b.allocator();
+}
+
+template<class T> Containers::ArrayView<T> FrameAllocator::allocate(const std::size_t count) {
+    static_assert(std::is_trivially_destructible<T>::value,
+        "type stored in frame allocator has to be trivially destructible");
+    T* const data = static_cast<T*>(allocate(count*sizeof(T), alignof(T)));
+    for(std::size_t i = 0; i != count; ++i) new(data + i) T;
+    return {data, count};
+}
+
+}
+
+#endif
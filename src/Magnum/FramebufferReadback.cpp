@@ -0,0 +1,100 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "FramebufferReadback.h"
+
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/AbstractFramebuffer.h"
+
+namespace Magnum {
+
+FramebufferReadback::FramebufferReadback(const PixelStorage storage, const PixelFormat format, const PixelType type, const UnsignedInt slotCount): _nextRead{}, _pendingCount{}, _mapped{} {
+    CORRADE_ASSERT(slotCount >= 2,
+        "FramebufferReadback: expected at least two slots, got" << slotCount, );
+
+    _slots.reserve(slotCount);
+    for(UnsignedInt i = 0; i != slotCount; ++i)
+        _slots.emplace_back(storage, format, type);
+}
+
+FramebufferReadback::FramebufferReadback(FramebufferReadback&& other) noexcept: _slots{std::move(other._slots)}, _nextRead{other._nextRead}, _pendingCount{other._pendingCount}, _mapped{other._mapped} {
+    other._nextRead = other._pendingCount = 0;
+    other._mapped = false;
+}
+
+FramebufferReadback::~FramebufferReadback() {
+    if(_mapped) unmap();
+}
+
+FramebufferReadback& FramebufferReadback::operator=(FramebufferReadback&& other) noexcept {
+    using std::swap;
+    swap(_slots, other._slots);
+    swap(_nextRead, other._nextRead);
+    swap(_pendingCount, other._pendingCount);
+    swap(_mapped, other._mapped);
+    return *this;
+}
+
+bool FramebufferReadback::read(AbstractFramebuffer& framebuffer, const Range2Di& rectangle) {
+    /* All slots are waiting for the GPU or for the user, drop the read */
+    if(_pendingCount == _slots.size()) return false;
+
+    /* Reallocates the buffer only if the size changed */
+    Slot& slot = _slots[_nextRead];
+    framebuffer.read(rectangle, slot.image, BufferUsage::StreamRead);
+    slot.fence.insert();
+
+    _nextRead = (_nextRead + 1) % _slots.size();
+    ++_pendingCount;
+    return true;
+}
+
+bool FramebufferReadback::isNextAvailable() {
+    if(!_pendingCount || _mapped) return false;
+
+    const std::size_t next = (_nextRead + _slots.size() - _pendingCount) % _slots.size();
+    return _slots[next].fence.isSignaled();
+}
+
+ImageView2D FramebufferReadback::mapNext() {
+    if(!isNextAvailable()) return ImageView2D{PixelFormat{}, PixelType{}, {}};
+
+    BufferImage2D& image = _slots[(_nextRead + _slots.size() - _pendingCount) % _slots.size()].image;
+    const Containers::ArrayView<const char> data = image.buffer().mapRead(0, image.dataSize());
+    _mapped = true;
+    return ImageView2D{image.storage(), image.format(), image.type(), image.size(), data};
+}
+
+void FramebufferReadback::unmap() {
+    CORRADE_ASSERT(_mapped,
+        "FramebufferReadback::unmap(): no slot is mapped", );
+
+    _slots[(_nextRead + _slots.size() - _pendingCount) % _slots.size()].image.buffer().unmap();
+    _mapped = false;
+    --_pendingCount;
+}
+
+}
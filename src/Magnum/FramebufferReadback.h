@@ -0,0 +1,172 @@
+#ifndef Magnum_FramebufferReadback_h
+#define Magnum_FramebufferReadback_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+/** @file
+ * @brief Class @ref Magnum::FramebufferReadback
+ */
+#endif
+
+#include <vector>
+
+#include "Magnum/BufferImage.h"
+#include "Magnum/Fence.h"
+#include "Magnum/ImageView.h"
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+namespace Magnum {
+
+/**
+@brief Asynchronous framebuffer readback
+
+Reads framebuffer contents into a ring of @ref BufferImage2D instances, each
+guarded by a @ref Fence, and gives access to the data only after the GPU
+finished writing them, so the render loop never waits for the readback:
+
+@snippet Magnum.cpp FramebufferReadback-usage
+
+Each @ref read() call issues @ref AbstractFramebuffer::read(const Range2Di&, BufferImage2D&, BufferUsage)
+into the next free slot and inserts a fence after it. The @ref mapNext()
+function maps the oldest pending slot if its fence is already signaled and
+returns an empty view otherwise. After the data are consumed, @ref unmap()
+frees the slot for another read. If all slots are pending, @ref read() does
+nothing and returns @cpp false @ce --- the frame is dropped instead of
+stalling. With three slots, the data are typically available two frames
+after the read was issued.
+
+@requires_gl30 Extension @extension{ARB,pixel_buffer_object} and
+    @extension{ARB,map_buffer_range}
+@requires_gl32 Extension @extension{ARB,sync}
+@requires_gles30 Pixel buffer objects and sync objects are not available in
+    OpenGL ES 2.0.
+@requires_gles Buffer mapping is not available in WebGL.
+*/
+class MAGNUM_EXPORT FramebufferReadback {
+    public:
+        /**
+         * @brief Constructor
+         * @param storage       Storage of pixel data
+         * @param format        Format of pixel data
+         * @param type          Data type of pixel data
+         * @param slotCount     Count of slots in the ring
+         *
+         * Expects that @p slotCount is at least two. Buffers for the slots
+         * are allocated on the first @ref read() into them.
+         */
+        explicit FramebufferReadback(PixelStorage storage, PixelFormat format, PixelType type, UnsignedInt slotCount = 3);
+
+        /** @overload
+         * Similar to the above, but uses default @ref PixelStorage parameters.
+         */
+        explicit FramebufferReadback(PixelFormat format, PixelType type, UnsignedInt slotCount = 3): FramebufferReadback{{}, format, type, slotCount} {}
+
+        /** @brief Copying is not allowed */
+        FramebufferReadback(const FramebufferReadback&) = delete;
+
+        /** @brief Move constructor */
+        FramebufferReadback(FramebufferReadback&&) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Unmaps the currently mapped slot, if any.
+         */
+        ~FramebufferReadback();
+
+        /** @brief Copying is not allowed */
+        FramebufferReadback& operator=(const FramebufferReadback&) = delete;
+
+        /** @brief Move assignment */
+        FramebufferReadback& operator=(FramebufferReadback&&) noexcept;
+
+        /** @brief Count of slots in the ring */
+        UnsignedInt slotCount() const { return _slots.size(); }
+
+        /**
+         * @brief Count of pending reads
+         *
+         * Reads that were issued but not yet released with @ref unmap().
+         */
+        UnsignedInt pendingCount() const { return _pendingCount; }
+
+        /**
+         * @brief Read framebuffer contents
+         * @return @cpp false @ce if all slots are pending and the read was
+         *      dropped, @cpp true @ce otherwise
+         *
+         * Doesn't block.
+         * @see @ref AbstractFramebuffer::read(const Range2Di&, BufferImage2D&, BufferUsage)
+         */
+        bool read(AbstractFramebuffer& framebuffer, const Range2Di& rectangle);
+
+        /**
+         * @brief Whether the oldest pending read is available
+         *
+         * Polls the fence of the oldest pending slot, doesn't block. Returns
+         * @cpp false @ce if there are no pending reads or if a slot is
+         * currently mapped.
+         * @see @ref Fence::isSignaled()
+         */
+        bool isNextAvailable();
+
+        /**
+         * @brief Map the oldest pending read
+         *
+         * If @ref isNextAvailable() is @cpp true @ce, maps the buffer of the
+         * oldest pending slot for reading and returns a view on it, otherwise
+         * returns an image view with @cpp nullptr @ce data. The data stay
+         * valid until @ref unmap() is called.
+         */
+        ImageView2D mapNext();
+
+        /**
+         * @brief Unmap the currently mapped read
+         *
+         * Frees the slot for another @ref read(). Expects that a slot is
+         * mapped.
+         */
+        void unmap();
+
+    private:
+        struct Slot {
+            explicit Slot(PixelStorage storage, PixelFormat format, PixelType type): image{storage, format, type} {}
+
+            BufferImage2D image;
+            Fence fence;
+        };
+
+        std::vector<Slot> _slots;
+        UnsignedInt _nextRead, _pendingCount;
+        bool _mapped;
+};
+
+}
+#else
+#error this header is not available in OpenGL ES 2.0 and WebGL build
+#endif
+
+#endif
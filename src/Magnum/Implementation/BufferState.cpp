@@ -49,9 +49,12 @@ const Buffer::TargetHint BufferState::targetForIndex[] = {
     Buffer::TargetHint::DispatchIndirect,
     Buffer::TargetHint::DrawIndirect,
     Buffer::TargetHint::ShaderStorage,
-    Buffer::TargetHint::Texture
+    Buffer::TargetHint::Texture,
     #endif
     #endif
+    #ifndef MAGNUM_TARGET_GLES
+    Buffer::TargetHint::Parameter
+    #endif
 };
 
 std::size_t BufferState::indexForTarget(Buffer::TargetHint target) {
@@ -73,6 +76,9 @@ std::size_t BufferState::indexForTarget(Buffer::TargetHint target) {
         case Buffer::TargetHint::Texture:           return 13;
         #endif
         #endif
+        #ifndef MAGNUM_TARGET_GLES
+        case Buffer::TargetHint::Parameter:         return 14;
+        #endif
     }
 
     CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
@@ -109,6 +115,7 @@ BufferState::BufferState(Context& context, std::vector<std::string>& extensions)
         getParameterImplementation = &Buffer::getParameterImplementationDSA;
         getSubDataImplementation = &Buffer::getSubDataImplementationDSA;
         dataImplementation = &Buffer::dataImplementationDSA;
+        storageImplementation = &Buffer::storageImplementationDSA;
         subDataImplementation = &Buffer::subDataImplementationDSA;
         mapImplementation = &Buffer::mapImplementationDSA;
         mapRangeImplementation = &Buffer::mapRangeImplementationDSA;
@@ -121,6 +128,7 @@ BufferState::BufferState(Context& context, std::vector<std::string>& extensions)
         getParameterImplementation = &Buffer::getParameterImplementationDSAEXT;
         getSubDataImplementation = &Buffer::getSubDataImplementationDSAEXT;
         dataImplementation = &Buffer::dataImplementationDSAEXT;
+        storageImplementation = &Buffer::storageImplementationDSAEXT;
         subDataImplementation = &Buffer::subDataImplementationDSAEXT;
         mapImplementation = &Buffer::mapImplementationDSAEXT;
         mapRangeImplementation = &Buffer::mapRangeImplementationDSAEXT;
@@ -137,6 +145,9 @@ BufferState::BufferState(Context& context, std::vector<std::string>& extensions)
         getSubDataImplementation = &Buffer::getSubDataImplementationDefault;
         #endif
         dataImplementation = &Buffer::dataImplementationDefault;
+        #ifndef MAGNUM_TARGET_GLES
+        storageImplementation = &Buffer::storageImplementationDefault;
+        #endif
         subDataImplementation = &Buffer::subDataImplementationDefault;
         #ifndef MAGNUM_TARGET_WEBGL
         mapImplementation = &Buffer::mapImplementationDefault;
@@ -31,7 +31,9 @@ namespace Magnum { namespace Implementation {
 
 struct BufferState {
     enum: std::size_t {
-        #ifndef MAGNUM_TARGET_WEBGL
+        #ifndef MAGNUM_TARGET_GLES
+        TargetCount = 14+1
+        #elif !defined(MAGNUM_TARGET_WEBGL)
         TargetCount = 13+1
         #elif !defined(MAGNUM_TARGET_GLES2) && defined(MAGNUM_TARGET_WEBGL)
         TargetCount = 8+1
@@ -59,6 +61,9 @@ struct BufferState {
     void(Buffer::*getSubDataImplementation)(GLintptr, GLsizeiptr, GLvoid*);
     #endif
     void(Buffer::*dataImplementation)(GLsizeiptr, const GLvoid*, BufferUsage);
+    #ifndef MAGNUM_TARGET_GLES
+    void(Buffer::*storageImplementation)(GLsizeiptr, const GLvoid*, Buffer::StorageFlags);
+    #endif
     void(Buffer::*subDataImplementation)(GLintptr, GLsizeiptr, const GLvoid*);
     void(Buffer::*invalidateImplementation)();
     void(Buffer::*invalidateSubImplementation)(GLintptr, GLsizeiptr);
@@ -179,6 +179,12 @@ MeshState::~MeshState() {
     /* If the default VAO was created, we need to delete it to avoid leaks */
     if(defaultVAO) glDeleteVertexArrays(1, &defaultVAO);
     #endif
+
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    /* Delete VAOs of shared vertex formats */
+    for(const SharedVertexFormat& format: sharedVertexFormats)
+        glDeleteVertexArrays(1, &format.vao);
+    #endif
 }
 
 void MeshState::reset() {
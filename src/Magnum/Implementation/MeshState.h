@@ -34,6 +34,30 @@ namespace Magnum { namespace Implementation {
 
 struct ContextState;
 
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+/* Vertex format shared among meshes, see Mesh::shareVertexFormat() */
+struct SharedVertexFormat {
+    struct Attribute {
+        GLuint location;
+        GLuint binding;
+        GLuint relativeOffset;
+        GLint size;
+        GLenum type;
+        DynamicAttribute::Kind kind;
+    };
+
+    std::vector<Attribute> attributes;
+    std::vector<GLuint> divisors; /* one for each binding */
+    GLuint vao;
+};
+
+inline bool operator==(const SharedVertexFormat::Attribute& a, const SharedVertexFormat::Attribute& b) {
+    return a.location == b.location && a.binding == b.binding &&
+        a.relativeOffset == b.relativeOffset && a.size == b.size &&
+        a.type == b.type && a.kind == b.kind;
+}
+#endif
+
 struct MeshState {
     explicit MeshState(Context& context, ContextState& contextState, std::vector<std::string>& extensions);
     ~MeshState();
@@ -56,7 +80,7 @@ struct MeshState {
     #endif
 
     #ifdef MAGNUM_TARGET_GLES
-    void(*multiDrawImplementation)(std::initializer_list<std::reference_wrapper<MeshView>>);
+    void(*multiDrawImplementation)(Containers::ArrayView<const std::reference_wrapper<MeshView>>);
     #endif
 
     void(*bindVAOImplementation)(GLuint);
@@ -74,6 +98,10 @@ struct MeshState {
     #endif
     GLint maxElementsIndices, maxElementsVertices;
     #endif
+
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    std::vector<SharedVertexFormat> sharedVertexFormats;
+    #endif
 };
 
 }}
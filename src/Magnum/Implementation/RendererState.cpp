@@ -85,6 +85,74 @@ RendererState::RendererState(Context& context, std::vector<std::string>& extensi
     #endif
 }
 
+std::size_t RendererState::indexForFeature(const Renderer::Feature feature) {
+    switch(feature) {
+        case Renderer::Feature::Blending:               return 0;
+        case Renderer::Feature::DepthTest:              return 1;
+        case Renderer::Feature::Dithering:              return 2;
+        case Renderer::Feature::FaceCulling:            return 3;
+        case Renderer::Feature::PolygonOffsetFill:      return 4;
+        case Renderer::Feature::ScissorTest:            return 5;
+        case Renderer::Feature::StencilTest:            return 6;
+        #ifndef MAGNUM_TARGET_GLES2
+        case Renderer::Feature::RasterizerDiscard:      return 7;
+        #endif
+        #ifndef MAGNUM_TARGET_WEBGL
+        case Renderer::Feature::BlendAdvancedCoherent:  return 8;
+        case Renderer::Feature::DebugOutput:            return 9;
+        case Renderer::Feature::DebugOutputSynchronous: return 10;
+        case Renderer::Feature::FramebufferSRGB:        return 11;
+        case Renderer::Feature::PolygonOffsetLine:      return 12;
+        case Renderer::Feature::PolygonOffsetPoint:     return 13;
+        #endif
+        #ifndef MAGNUM_TARGET_GLES
+        case Renderer::Feature::DepthClamp:             return 14;
+        case Renderer::Feature::LogicOperation:         return 15;
+        case Renderer::Feature::Multisampling:          return 16;
+        case Renderer::Feature::ProgramPointSize:       return 17;
+        case Renderer::Feature::SeamlessCubeMapTexture: return 18;
+        #endif
+    }
+
+    /* Features not listed in the enum are passed through untracked */
+    return FeatureCount;
+}
+
+void RendererState::reset() {
+    for(Tracked<GLboolean, 1>& feature: features) feature.engaged = false;
+    clearColor.engaged = false;
+    clearDepth.engaged = false;
+    clearStencil.engaged = false;
+    frontFace.engaged = false;
+    faceCullingMode.engaged = false;
+    #ifndef MAGNUM_TARGET_GLES
+    provokingVertex.engaged = false;
+    #endif
+    #ifndef MAGNUM_TARGET_WEBGL
+    polygonMode.engaged = false;
+    #endif
+    polygonOffset.engaged = false;
+    lineWidth.engaged = false;
+    #ifndef MAGNUM_TARGET_GLES
+    pointSize.engaged = false;
+    #endif
+    scissor.engaged = false;
+    for(std::size_t i: {0, 1}) {
+        stencilFunction[i].engaged = false;
+        stencilOperation[i].engaged = false;
+        stencilMask[i].engaged = false;
+    }
+    depthFunction.engaged = false;
+    colorMask.engaged = false;
+    depthMask.engaged = false;
+    blendEquation.engaged = false;
+    blendFunction.engaged = false;
+    blendColor.engaged = false;
+    #ifndef MAGNUM_TARGET_GLES
+    logicOperation.engaged = false;
+    #endif
+}
+
 RendererState::PixelStorage::PixelStorage():
     alignment{4}
     #if !(defined(MAGNUM_TARGET_GLES2) && defined(MAGNUM_TARGET_WEBGL))
@@ -25,8 +25,11 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <algorithm>
+#include <initializer_list>
 #include <string>
 #include <vector>
+#include <Corrade/Utility/Assert.h>
 
 #include "Magnum/Renderer.h"
 #include "Magnum/Math/Vector3.h"
@@ -69,6 +72,62 @@ struct RendererState {
     };
 
     PixelStorage packPixelStorage, unpackPixelStorage;
+
+    /* Shadowed render state. The value is submitted to GL only if it differs
+       from the previous one or if the previous value is not known, which is
+       the case initially and after reset(). */
+    template<class T, std::size_t size> struct Tracked {
+        /* Returns true if the value changed and should be submitted */
+        bool update(std::initializer_list<T> values) {
+            CORRADE_INTERNAL_ASSERT(values.size() == size);
+            if(engaged && std::equal(values.begin(), values.end(), value))
+                return false;
+            std::copy(values.begin(), values.end(), value);
+            return engaged = true;
+        }
+
+        T value[size];
+        bool engaged{};
+    };
+
+    enum: std::size_t { FeatureCount = 19 };
+
+    /* Returns FeatureCount for features that are not tracked */
+    static std::size_t indexForFeature(Renderer::Feature feature);
+
+    void reset();
+
+    Tracked<GLboolean, 1> features[FeatureCount];
+    Tracked<GLfloat, 4> clearColor;
+    Tracked<GLfloat, 1> clearDepth;
+    Tracked<GLint, 1> clearStencil;
+    Tracked<GLenum, 1> frontFace;
+    Tracked<GLenum, 1> faceCullingMode;
+    #ifndef MAGNUM_TARGET_GLES
+    Tracked<GLenum, 1> provokingVertex;
+    #endif
+    #ifndef MAGNUM_TARGET_WEBGL
+    Tracked<GLenum, 1> polygonMode;
+    #endif
+    Tracked<GLfloat, 2> polygonOffset;
+    Tracked<GLfloat, 1> lineWidth;
+    #ifndef MAGNUM_TARGET_GLES
+    Tracked<GLfloat, 1> pointSize;
+    #endif
+    Tracked<GLint, 4> scissor;
+    /* Front and back face */
+    Tracked<GLuint, 3> stencilFunction[2];
+    Tracked<GLenum, 3> stencilOperation[2];
+    Tracked<GLuint, 1> stencilMask[2];
+    Tracked<GLenum, 1> depthFunction;
+    Tracked<GLboolean, 4> colorMask;
+    Tracked<GLboolean, 1> depthMask;
+    Tracked<GLenum, 2> blendEquation;
+    Tracked<GLenum, 4> blendFunction;
+    Tracked<GLfloat, 4> blendColor;
+    #ifndef MAGNUM_TARGET_GLES
+    Tracked<GLenum, 1> logicOperation;
+    #endif
 };
 
 }}
@@ -28,7 +28,9 @@
 #include <algorithm>
 
 #include "Magnum/Context.h"
+#include "Magnum/DeletionQueue.h"
 #include "Magnum/Extensions.h"
+#include "Magnum/MemoryTracker.h"
 
 #include "BufferState.h"
 #include "ContextState.h"
@@ -62,10 +64,12 @@ State::State(Context& context, std::ostream* const out) {
 
     buffer.reset(new BufferState{context, extensions});
     this->context.reset(new ContextState{context, extensions});
+    deletionQueue.reset(new DeletionQueue);
     #ifndef MAGNUM_TARGET_WEBGL
     debug.reset(new DebugState{context, extensions});
     #endif
     framebuffer.reset(new FramebufferState{context, extensions});
+    memoryTracker.reset(new MemoryTracker);
     mesh.reset(new MeshState{context, *this->context, extensions});
     #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
     query.reset(new QueryState{context, extensions});
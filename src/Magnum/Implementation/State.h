@@ -60,10 +60,12 @@ struct State {
 
     std::unique_ptr<BufferState> buffer;
     std::unique_ptr<ContextState> context;
+    std::unique_ptr<DeletionQueue> deletionQueue;
     #ifndef MAGNUM_TARGET_WEBGL
     std::unique_ptr<DebugState> debug;
     #endif
     std::unique_ptr<FramebufferState> framebuffer;
+    std::unique_ptr<MemoryTracker> memoryTracker;
     std::unique_ptr<MeshState> mesh;
     #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
     std::unique_ptr<QueryState> query;
@@ -245,6 +245,15 @@ TextureState::TextureState(Context& context, std::vector<std::string>& extension
         invalidateSubImageImplementation = &AbstractTexture::invalidateSubImageImplementationNoOp;
     }
 
+    /* Sparse texture page commitment implementation. There's no ARB DSA
+       variant of the function. */
+    #ifndef MAGNUM_TARGET_GLES
+    if(context.isExtensionSupported<Extensions::GL::EXT::direct_state_access>())
+        pageCommitmentImplementation = &AbstractTexture::pageCommitmentImplementationDSAEXT;
+    else
+        pageCommitmentImplementation = &AbstractTexture::pageCommitmentImplementationDefault;
+    #endif
+
     #ifndef MAGNUM_TARGET_GLES
     /* Compressed cubemap image size query implementation (extensions added
        above) */
@@ -101,6 +101,9 @@ struct TextureState {
     #endif
     void(AbstractTexture::*invalidateImageImplementation)(GLint);
     void(AbstractTexture::*invalidateSubImageImplementation)(GLint, const Vector3i&, const Vector3i&);
+    #ifndef MAGNUM_TARGET_GLES
+    void(AbstractTexture::*pageCommitmentImplementation)(GLint, const Vector3i&, const Vector3i&, GLboolean);
+    #endif
 
     #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
     void(BufferTexture::*setBufferImplementation)(BufferTextureFormat, Buffer&);
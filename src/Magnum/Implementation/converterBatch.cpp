@@ -0,0 +1,76 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "converterBatch.h"
+
+#include <Corrade/Utility/Debug.h>
+#include <Corrade/Utility/Directory.h>
+#include <Corrade/Utility/String.h>
+
+namespace Magnum { namespace Implementation {
+
+Containers::Optional<std::vector<BatchEntry>> parseBatchManifest(const std::string& filename, const std::string& outputDirectory) {
+    if(!Utility::Directory::fileExists(filename)) {
+        Error() << "Cannot open batch manifest" << filename;
+        return Containers::NullOpt;
+    }
+
+    std::vector<BatchEntry> entries;
+    const std::vector<std::string> lines = Utility::String::splitWithoutEmptyParts(Utility::Directory::readString(filename), '\n');
+    for(std::size_t i = 0; i != lines.size(); ++i) {
+        /* Drop the CR from Windows line endings */
+        std::string line = lines[i];
+        if(!line.empty() && line.back() == '\r') line.pop_back();
+        if(line.empty() || line[0] == '#') continue;
+
+        std::size_t separator = line.find('\t');
+        if(separator == std::string::npos) separator = line.find(' ');
+        if(separator == std::string::npos || separator == 0 || separator + 1 == line.size()) {
+            Error() << "Invalid batch manifest entry" << line << "in" << filename;
+            return Containers::NullOpt;
+        }
+
+        std::string output = line.substr(separator + 1);
+        if(!outputDirectory.empty()) output = Utility::Directory::join(outputDirectory, output);
+        entries.push_back({line.substr(0, separator), std::move(output)});
+    }
+
+    return entries;
+}
+
+std::unique_lock<std::mutex> lockIfProxyPlugin(std::mutex& mutex, const std::string& plugin) {
+    return Utility::String::beginsWith(plugin, "Any") ?
+        std::unique_lock<std::mutex>{mutex} : std::unique_lock<std::mutex>{};
+}
+
+void printBatchSummary(const std::size_t succeeded, const std::size_t failed, const std::size_t dataBytes, const Double seconds) {
+    Debug d;
+    d << "Converted" << succeeded << "files";
+    if(failed) d << "(" << Debug::nospace << failed << "failed)";
+    d << "in" << seconds << "seconds";
+    if(seconds > 0.0) d << Debug::nospace << "," << succeeded/seconds << "files/s and" << dataBytes/(seconds*1024.0*1024.0) << "MB/s of image data";
+}
+
+}}
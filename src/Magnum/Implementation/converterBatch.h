@@ -0,0 +1,62 @@
+#ifndef Magnum_Implementation_converterBatch_h
+#define Magnum_Implementation_converterBatch_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <mutex>
+#include <string>
+#include <vector>
+#include <Corrade/Containers/Optional.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/visibility.h"
+
+namespace Magnum { namespace Implementation {
+
+/* Input and output file of a single batch conversion job */
+struct BatchEntry {
+    std::string input, output;
+};
+
+/* Parses a batch conversion manifest used by the magnum-imageconverter and
+   magnum-distancefieldconverter utilities. Each non-empty line that doesn't
+   start with a `#` contains an input and an output filename separated by a
+   tab or, if there's no tab, by a space. Relative output filenames are taken
+   relative to outputDirectory. Prints a message and returns NullOpt on
+   error. */
+MAGNUM_EXPORT Containers::Optional<std::vector<BatchEntry>> parseBatchManifest(const std::string& filename, const std::string& outputDirectory);
+
+/* The Any* proxy plugins instantiate the concrete plugin through the shared
+   plugin manager on every file, which isn't thread-safe. Returns a lock on
+   given mutex if given plugin is one of them, an empty lock otherwise. */
+MAGNUM_EXPORT std::unique_lock<std::mutex> lockIfProxyPlugin(std::mutex& mutex, const std::string& plugin);
+
+/* Prints count of processed files, failures and throughput of a batch
+   conversion, dataBytes being the total size of the decoded images */
+MAGNUM_EXPORT void printBatchSummary(std::size_t succeeded, std::size_t failed, std::size_t dataBytes, Double seconds);
+
+}}
+
+#endif
@@ -0,0 +1,100 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "mapFile.h"
+
+#include <Corrade/configure.h>
+
+#if defined(CORRADE_TARGET_UNIX) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#elif defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT)
+#define WIN32_LEAN_AND_MEAN 1
+#define VC_EXTRALEAN
+#include <windows.h>
+#include <Corrade/Utility/Unicode.h>
+#endif
+
+namespace Magnum { namespace Implementation {
+
+#if defined(CORRADE_TARGET_UNIX) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+std::pair<const char*, std::size_t> mapFile(const std::string& filename) {
+    const int fd = open(filename.data(), O_RDONLY);
+    if(fd == -1) return {};
+
+    /* Empty files can't be mapped */
+    struct stat info;
+    if(fstat(fd, &info) == -1 || !S_ISREG(info.st_mode) || !info.st_size) {
+        close(fd);
+        return {};
+    }
+
+    /* The mapping stays valid after closing the descriptor */
+    const std::size_t size = info.st_size;
+    void* const data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if(data == MAP_FAILED) return {};
+
+    return {static_cast<const char*>(data), size};
+}
+
+void unmapFile(const char* const data, const std::size_t size) {
+    munmap(const_cast<char*>(data), size);
+}
+#elif defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT)
+std::pair<const char*, std::size_t> mapFile(const std::string& filename) {
+    HANDLE file = CreateFileW(Utility::Unicode::widen(filename).data(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if(file == INVALID_HANDLE_VALUE) return {};
+
+    /* Empty files can't be mapped */
+    LARGE_INTEGER size;
+    if(!GetFileSizeEx(file, &size) || !size.QuadPart) {
+        CloseHandle(file);
+        return {};
+    }
+
+    /* The view stays valid after closing both handles */
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if(!mapping) return {};
+    const void* const data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if(!data) return {};
+
+    return {static_cast<const char*>(data), std::size_t(size.QuadPart)};
+}
+
+void unmapFile(const char* const data, std::size_t) {
+    UnmapViewOfFile(data);
+}
+#else
+std::pair<const char*, std::size_t> mapFile(const std::string&) { return {}; }
+
+void unmapFile(const char*, std::size_t) {}
+#endif
+
+}}
@@ -95,6 +95,17 @@ Magnum contexts. Enabled by default.
 #define MAGNUM_BUILD_MULTITHREADED
 #undef MAGNUM_BUILD_MULTITHREADED
 
+/**
+@brief Build with call and state change statistics
+
+Defined if the library is built with counting of GL calls and state changes,
+available through @ref Magnum::Context::statistics() "Context::statistics()".
+Disabled by default.
+@see @ref building, @ref cmake
+*/
+#define MAGNUM_BUILD_STATISTICS
+#undef MAGNUM_BUILD_STATISTICS
+
 /**
 @brief OpenGL ES target
 
@@ -298,6 +309,30 @@ Equivalent to GLSL @glsl ivec4 @ce.
 */
 typedef Math::Vector4<Int> Vector4i;
 
+/**
+@brief Two-component half-float vector
+
+Storage-only type, see @ref Math::Half for more information.
+@see @ref Math::unpackHalfInto(), @ref Math::packHalfInto()
+*/
+typedef Math::Vector2<Half> Vector2h;
+
+/**
+@brief Three-component half-float vector
+
+Storage-only type, see @ref Math::Half for more information.
+@see @ref Math::unpackHalfInto(), @ref Math::packHalfInto()
+*/
+typedef Math::Vector3<Half> Vector3h;
+
+/**
+@brief Four-component half-float vector
+
+Storage-only type, see @ref Math::Half for more information.
+@see @ref Math::unpackHalfInto(), @ref Math::packHalfInto()
+*/
+typedef Math::Vector4<Half> Vector4h;
+
 /** @brief Three-component (RGB) float color */
 typedef Math::Color3<Float> Color3;
 
@@ -324,6 +359,22 @@ typedef Math::Color3<UnsignedByte> Color3ub;
 */
 typedef Math::Color4<UnsignedByte> Color4ub;
 
+/**
+@brief Three-component (RGB) half-float color
+
+Storage-only type, see @ref Math::Half for more information. Convert to
+@ref Color3 for calculations.
+*/
+typedef Math::Color3<Half> Color3h;
+
+/**
+@brief Four-component (RGBA) half-float color
+
+Storage-only type, see @ref Math::Half for more information. Convert to
+@ref Color4 for calculations.
+*/
+typedef Math::Color4<Half> Color4h;
+
 /**
 @brief 3x3 float transformation matrix
 
@@ -693,8 +744,11 @@ typedef CompressedBufferImage<3> CompressedBufferImage3D;
 #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
 class BufferTexture;
 enum class BufferTextureFormat: GLenum;
+class FramebufferReadback;
+class ShaderProgramCache;
 #endif
 
+class CommandBuffer;
 class Context;
 
 class CubeMapTexture;
@@ -705,9 +759,15 @@ class CubeMapTextureArray;
 
 /* DebugOutput, DebugMessage, DebugGroup used only statically */
 /* DefaultFramebuffer is available only through global instance */
+class DeletionQueue;
 /* DimensionTraits forward declaration is not needed */
 
+class DrawPacket;
+class DynamicResolution;
+
 class Extension;
+class FrameAllocator;
+template<class> class FrameAllocatorAdapter;
 class Framebuffer;
 
 #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
@@ -735,6 +795,13 @@ typedef CompressedImageView<1> CompressedImageView1D;
 typedef CompressedImageView<2> CompressedImageView2D;
 typedef CompressedImageView<3> CompressedImageView3D;
 
+#ifndef MAGNUM_TARGET_GLES
+class MaterialTextureArray;
+#endif
+
+enum class MemoryObjectType: UnsignedByte;
+class MemoryTracker;
+
 enum class MeshPrimitive: GLenum;
 
 class Mesh;
@@ -756,6 +823,10 @@ class PixelStorage;
 class CompressedPixelStorage;
 #endif
 
+#ifndef MAGNUM_TARGET_GLES2
+class Fence;
+#endif
+
 /* ObjectFlag, ObjectFlags are used only in conjunction with *::wrap() function */
 
 class PrimitiveQuery;
@@ -769,16 +840,30 @@ class RectangleTexture;
 class Renderbuffer;
 enum class RenderbufferFormat: GLenum;
 
+#if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+template<class> class RenderPass;
+enum class RenderPassLoadAction: UnsignedByte;
+enum class RenderPassStoreAction: UnsignedByte;
+class RenderTargetPool;
+#endif
+
 enum class ResourceState: UnsignedByte;
 enum class ResourceDataState: UnsignedByte;
 enum class ResourcePolicy: UnsignedByte;
+template<class T, class U = T> class PinnedResource;
 template<class T, class U = T> class Resource;
 class ResourceKey;
+class ResourceLoadBatch;
 template<class...> class ResourceManager;
+class ResourceRestoreCache;
 
 class Sampler;
 class Shader;
 
+#ifndef MAGNUM_TARGET_GLES
+class StreamingBuffer;
+#endif
+
 template<UnsignedInt> class Texture;
 #ifndef MAGNUM_TARGET_GLES
 typedef Texture<1> Texture1D;
@@ -796,7 +881,13 @@ typedef TextureArray<1> Texture1DArray;
 typedef TextureArray<2> Texture2DArray;
 #endif
 
+class TextureBindingSet;
 enum class TextureFormat: GLenum;
+#ifndef MAGNUM_TARGET_GLES
+class TextureUploadQueue;
+#endif
+
+class ThreadPool;
 
 #ifndef MAGNUM_TARGET_GLES2
 class TransformFeedback;
@@ -0,0 +1,153 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MaterialTextureArray.h"
+
+#include <unordered_map>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/ImageView.h"
+#include "Magnum/Texture.h"
+#include "Magnum/TextureArray.h"
+#include "Magnum/Math/Vector3.h"
+
+namespace Magnum {
+
+namespace {
+
+enum class LayerState: UnsignedByte {
+    Free,
+    Pending,
+    Ready
+};
+
+}
+
+struct MaterialTextureArray::State {
+    explicit State(TextureUploadQueue& queue): queue(queue) {}
+
+    TextureUploadQueue& queue;
+    Texture2DArray texture;
+    Vector2i size;
+    Int levelCount;
+
+    std::vector<LayerState> layers;
+    /* Free layers, the lowest on top */
+    std::vector<Int> free;
+    /* Upload ID to layer */
+    std::unordered_map<UnsignedInt, Int> uploads;
+};
+
+MaterialTextureArray::MaterialTextureArray(TextureUploadQueue& queue, const TextureFormat format, const Vector2i& size, const Int layerCount, const Int levelCount): _state{new State{queue}} {
+    CORRADE_ASSERT(layerCount, "MaterialTextureArray: expected non-zero layer count", );
+
+    State& state = *_state;
+    state.size = size;
+    state.levelCount = levelCount;
+    state.layers.resize(layerCount, LayerState::Free);
+    state.free.reserve(layerCount);
+    for(Int i = layerCount; i != 0; --i) state.free.push_back(i - 1);
+
+    state.texture.setStorage(levelCount, format, {size, layerCount});
+}
+
+MaterialTextureArray::~MaterialTextureArray() = default;
+
+Texture2DArray& MaterialTextureArray::texture() { return _state->texture; }
+
+Vector2i MaterialTextureArray::size() const { return _state->size; }
+
+Int MaterialTextureArray::layerCount() const { return _state->layers.size(); }
+
+Int MaterialTextureArray::levelCount() const { return _state->levelCount; }
+
+Int MaterialTextureArray::allocatedLayerCount() const {
+    return _state->layers.size() - _state->free.size();
+}
+
+Int MaterialTextureArray::pendingLayerCount() const { return _state->uploads.size(); }
+
+bool MaterialTextureArray::isAllocated(const Int layer) const {
+    CORRADE_ASSERT(layer >= 0 && std::size_t(layer) < _state->layers.size(),
+        "MaterialTextureArray::isAllocated(): layer" << layer << "out of range for" << _state->layers.size() << "layers", {});
+    return _state->layers[layer] != LayerState::Free;
+}
+
+bool MaterialTextureArray::isReady(const Int layer) const {
+    CORRADE_ASSERT(layer >= 0 && std::size_t(layer) < _state->layers.size(),
+        "MaterialTextureArray::isReady(): layer" << layer << "out of range for" << _state->layers.size() << "layers", {});
+    return _state->layers[layer] == LayerState::Ready;
+}
+
+Int MaterialTextureArray::add(const PixelFormat format, const PixelType type, TextureUploadQueue::Decoder decoder) {
+    State& state = *_state;
+    CORRADE_ASSERT(Implementation::imageDataSize(ImageView2D{format, type, state.size}) <= state.queue.slotSize(),
+        "MaterialTextureArray::add(): layer data size" << Implementation::imageDataSize(ImageView2D{format, type, state.size}) << "doesn't fit into slot size" << state.queue.slotSize(), -1);
+
+    if(state.free.empty()) return -1;
+
+    const Int layer = state.free.back();
+    state.free.pop_back();
+    state.layers[layer] = LayerState::Pending;
+    state.uploads.emplace(state.queue.enqueue(state.texture, 0, {0, 0, layer}, format, type, state.size, std::move(decoder)), layer);
+    return layer;
+}
+
+void MaterialTextureArray::remove(const Int layer) {
+    State& state = *_state;
+    CORRADE_ASSERT(layer >= 0 && std::size_t(layer) < state.layers.size() && state.layers[layer] != LayerState::Free,
+        "MaterialTextureArray::remove(): layer" << layer << "is not allocated", );
+    CORRADE_ASSERT(state.layers[layer] == LayerState::Ready,
+        "MaterialTextureArray::remove(): layer" << layer << "has a pending upload", );
+
+    state.layers[layer] = LayerState::Free;
+
+    /* Keep the lowest free layer on top so the used layers stay compact */
+    auto it = state.free.begin();
+    while(it != state.free.end() && *it > layer) ++it;
+    state.free.insert(it, layer);
+}
+
+void MaterialTextureArray::update(const Containers::ArrayView<const UnsignedInt> completedUploads) {
+    State& state = *_state;
+
+    bool completed = false;
+    for(const UnsignedInt id: completedUploads) {
+        auto found = state.uploads.find(id);
+        if(found == state.uploads.end()) continue;
+
+        state.layers[found->second] = LayerState::Ready;
+        state.uploads.erase(found);
+        completed = true;
+    }
+
+    if(completed && state.levelCount > 1) state.texture.generateMipmap();
+}
+
+void MaterialTextureArray::update(const std::vector<UnsignedInt>& completedUploads) {
+    update(Containers::ArrayView<const UnsignedInt>{completedUploads.data(), completedUploads.size()});
+}
+
+}
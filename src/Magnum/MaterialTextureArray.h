@@ -0,0 +1,196 @@
+#ifndef Magnum_MaterialTextureArray_h
+#define Magnum_MaterialTextureArray_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef MAGNUM_TARGET_GLES
+/** @file
+ * @brief Class @ref Magnum::MaterialTextureArray
+ */
+#endif
+
+#include <memory>
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/TextureUploadQueue.h"
+#include "Magnum/visibility.h"
+
+#ifndef MAGNUM_TARGET_GLES
+namespace Magnum {
+
+/**
+@brief Texture array layer manager for batched material textures
+
+Stores same-sized material textures in layers of a single @ref Texture2DArray,
+so drawables with different materials can be drawn with a single texture bind
+and, with a per-instance layer index, in a single instanced draw call. Each
+@ref add() allocates a free layer and enqueues an upload of its data through a
+@ref TextureUploadQueue. The returned layer index is then passed to the shader,
+usually as part of the per-instance data, and the layer is sampled once
+@ref isReady() returns @cpp true @ce:
+
+@snippet Magnum.cpp MaterialTextureArray-usage
+
+Layers that are no longer needed are returned to the pool with @ref remove()
+and get reused by subsequent @ref add() calls. The layer count is fixed at
+construction time --- if there's no free layer, @ref add() returns
+@cpp -1 @ce and the material has to use a separate texture or another array.
+
+Only the first level is uploaded. If the array has more than one level, the
+remaining levels are regenerated using @ref Texture2DArray::generateMipmap()
+in the @ref update() in which some uploads complete, which regenerates all
+layers at once. For textures that change often it's thus better to use
+arrays with a single level.
+
+@section MaterialTextureArray-threading Threading
+
+All functions have to be called from the thread owning the GL context, only
+the decoder functions are executed on the worker threads of the
+@ref TextureUploadQueue. The queue has to be kept alive for the whole lifetime
+of the instance.
+
+@requires_gl44 Extension @extension{ARB,buffer_storage}
+@requires_gl Persistent mapping is not available in OpenGL ES and WebGL.
+*/
+class MAGNUM_EXPORT MaterialTextureArray {
+    public:
+        /**
+         * @brief Constructor
+         * @param queue         Upload queue
+         * @param format        Internal texture format
+         * @param size          Size of one layer
+         * @param layerCount    Count of layers
+         * @param levelCount    Count of levels
+         *
+         * Allocates the texture storage using
+         * @ref Texture2DArray::setStorage(). Expects that @p layerCount is
+         * non-zero.
+         */
+        explicit MaterialTextureArray(TextureUploadQueue& queue, TextureFormat format, const Vector2i& size, Int layerCount, Int levelCount = 1);
+
+        /** @brief Copying is not allowed */
+        MaterialTextureArray(const MaterialTextureArray&) = delete;
+
+        /** @brief Moving is not allowed */
+        MaterialTextureArray(MaterialTextureArray&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Uploads that are still pending have to complete before the
+         * texture is destroyed, call @ref TextureUploadQueue::finish()
+         * first.
+         */
+        ~MaterialTextureArray();
+
+        /** @brief Copying is not allowed */
+        MaterialTextureArray& operator=(const MaterialTextureArray&) = delete;
+
+        /** @brief Moving is not allowed */
+        MaterialTextureArray& operator=(MaterialTextureArray&&) = delete;
+
+        /** @brief Underlying texture array */
+        Texture2DArray& texture();
+
+        /** @brief Size of one layer */
+        Vector2i size() const;
+
+        /** @brief Count of layers */
+        Int layerCount() const;
+
+        /** @brief Count of levels */
+        Int levelCount() const;
+
+        /**
+         * @brief Count of allocated layers
+         *
+         * Includes layers with pending uploads.
+         */
+        Int allocatedLayerCount() const;
+
+        /** @brief Count of layers with pending uploads */
+        Int pendingLayerCount() const;
+
+        /** @brief Whether given layer is allocated */
+        bool isAllocated(Int layer) const;
+
+        /**
+         * @brief Whether given layer is ready for sampling
+         *
+         * Returns @cpp true @ce if the layer is allocated and its upload is
+         * complete.
+         */
+        bool isReady(Int layer) const;
+
+        /**
+         * @brief Add a material texture
+         * @param format        Format of pixel data
+         * @param type          Data type of pixel data
+         * @param decoder       Function writing the pixel data of the first
+         *      level
+         * @return Allocated layer or @cpp -1 @ce if there's no free layer
+         *
+         * The decoder gets a view on memory for tightly packed pixel data of
+         * @ref size() with default @ref PixelStorage parameters. Expects that
+         * the data fit into @ref TextureUploadQueue::slotSize().
+         */
+        Int add(PixelFormat format, PixelType type, TextureUploadQueue::Decoder decoder);
+
+        /**
+         * @brief Remove a material texture
+         *
+         * Returns the layer to the pool. Doesn't touch the texture data.
+         * Expects that the layer is allocated and its upload is complete.
+         */
+        void remove(Int layer);
+
+        /**
+         * @brief Advance the uploads
+         * @param completedUploads  IDs returned by
+         *      @ref TextureUploadQueue::update()
+         *
+         * Marks layers whose upload is complete as ready and regenerates
+         * mip levels if needed. IDs of uploads not issued by this instance
+         * are ignored, so the queue can be shared with other users.
+         */
+        void update(Containers::ArrayView<const UnsignedInt> completedUploads);
+
+        /** @overload */
+        void update(const std::vector<UnsignedInt>& completedUploads);
+
+    private:
+        struct State;
+
+        std::unique_ptr<State> _state;
+};
+
+}
+#else
+#error this header is available only in desktop OpenGL build
+#endif
+
+#endif
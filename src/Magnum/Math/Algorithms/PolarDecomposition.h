@@ -0,0 +1,80 @@
+#ifndef Magnum_Math_Algorithms_PolarDecomposition_h
+#define Magnum_Math_Algorithms_PolarDecomposition_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::Math::Algorithms::polarDecomposition(), @ref Magnum::Math::Algorithms::polarDecompositionInto()
+ */
+
+#include "Magnum/Math/Algorithms/Svd.h"
+
+namespace Magnum { namespace Math { namespace Algorithms {
+
+/**
+@brief Polar decomposition of a 3x3 matrix
+
+Decomposes @p matrix into a rotation @f$ R @f$ and a symmetric stretch
+@f$ S @f$ so that @f[
+    M = R S
+@f]
+
+Calculated from @ref svd3x3() as @f$ R = U V^T @f$ and
+@f$ S = V \Sigma V^T @f$. As both @f$ U @f$ and @f$ V @f$ are proper
+rotations, @f$ R @f$ is always a rotation as well and any reflection present
+in @p matrix ends up in @f$ S @f$. Useful for extracting rotation from a
+matrix with non-uniform scaling or shear, for example in deformation or
+animation blending.
+@see @ref polarDecompositionInto()
+*/
+template<class T> std::pair<Matrix3x3<T>, Matrix3x3<T>> polarDecomposition(const Matrix3x3<T>& matrix) {
+    Matrix3x3<T> u{NoInit};
+    Vector3<T> w{NoInit};
+    Matrix3x3<T> v{NoInit};
+    std::tie(u, w, v) = svd3x3(matrix);
+
+    const Matrix3x3<T> vt = v.transposed();
+    Matrix3x3<T> vw{NoInit};
+    for(std::size_t i = 0; i != 3; ++i) vw[i] = v[i]*w[i];
+    return {u*vt, vw*vt};
+}
+
+/**
+@brief Polar decomposition of an array of 3x3 matrices
+
+Equivalent to calling @ref polarDecomposition() on each item of
+@p matrices, putting the results to @p rotations and @p stretches. Expects
+that all views have the same size.
+*/
+template<class T> void polarDecompositionInto(const Corrade::Containers::ArrayView<const Matrix3x3<T>> matrices, const Corrade::Containers::ArrayView<Matrix3x3<T>> rotations, const Corrade::Containers::ArrayView<Matrix3x3<T>> stretches) {
+    CORRADE_ASSERT(matrices.size() == rotations.size() && matrices.size() == stretches.size(),
+        "Math::Algorithms::polarDecompositionInto(): expected" << matrices.size() << "items in all views but got" << rotations.size() << "and" << stretches.size(), );
+    for(std::size_t i = 0; i != matrices.size(); ++i)
+        std::tie(rotations[i], stretches[i]) = polarDecomposition(matrices[i]);
+}
+
+}}}
+
+#endif
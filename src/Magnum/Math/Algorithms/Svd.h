@@ -26,13 +26,18 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::Math::Algorithms::svd()
+ * @brief Function @ref Magnum::Math::Algorithms::svd(), @ref Magnum::Math::Algorithms::svd3x3(), @ref Magnum::Math::Algorithms::svd3x3Into()
  */
 
+#include <limits>
 #include <tuple>
+#include <utility>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Utility/Assert.h>
 
 #include "Magnum/Math/Functions.h"
 #include "Magnum/Math/Matrix.h"
+#include "Magnum/Math/Vector3.h"
 
 namespace Magnum { namespace Math { namespace Algorithms {
 
@@ -53,6 +58,52 @@ template<class T> constexpr T smallestDelta();
 template<> constexpr Float smallestDelta<Float>() { return 1.0e-32f; }
 template<> constexpr Double smallestDelta<Double>() { return 1.0e-64; }
 
+/* Cyclic Jacobi eigenvalue iteration on a symmetric 3x3 matrix. On output
+   the diagonal of s contains the eigenvalues and columns of v the
+   corresponding eigenvectors. Usually converges in four or five sweeps. */
+template<class T> void jacobiEigen3x3(Matrix<3, T>& s, Matrix<3, T>& v) {
+    constexpr std::size_t maxSweeps = 12;
+    constexpr T epsilonSquared = std::numeric_limits<T>::epsilon()*std::numeric_limits<T>::epsilon();
+    v = Matrix<3, T>{IdentityInit};
+
+    for(std::size_t sweep = 0; sweep != maxSweeps; ++sweep) {
+        const T offdiagonal = Math::pow<2>(s[1][0]) + Math::pow<2>(s[2][0]) + Math::pow<2>(s[2][1]);
+        const T diagonal = Math::pow<2>(s[0][0]) + Math::pow<2>(s[1][1]) + Math::pow<2>(s[2][2]);
+        if(offdiagonal <= diagonal*epsilonSquared) break;
+
+        for(std::size_t p = 0; p != 2; ++p) for(std::size_t q = p + 1; q != 3; ++q) {
+            const T spq = s[q][p];
+            if(spq == T(0)) continue;
+
+            /* Rotation annihilating the (p, q) element, the smaller of the
+               two angles */
+            const T theta = (s[q][q] - s[p][p])/(T(2)*spq);
+            const T t = (theta >= T(0) ? T(1) : T(-1))/(std::abs(theta) + std::sqrt(theta*theta + T(1)));
+            const T c = T(1)/std::sqrt(t*t + T(1));
+            const T sn = t*c;
+
+            for(std::size_t k = 0; k != 3; ++k) {
+                const T skp = s[p][k];
+                const T skq = s[q][k];
+                s[p][k] = c*skp - sn*skq;
+                s[q][k] = sn*skp + c*skq;
+            }
+            for(std::size_t k = 0; k != 3; ++k) {
+                const T spk = s[k][p];
+                const T sqk = s[k][q];
+                s[k][p] = c*spk - sn*sqk;
+                s[k][q] = sn*spk + c*sqk;
+            }
+            for(std::size_t k = 0; k != 3; ++k) {
+                const T vkp = v[p][k];
+                const T vkq = v[q][k];
+                v[p][k] = c*vkp - sn*vkq;
+                v[q][k] = sn*vkp + c*vkq;
+            }
+        }
+    }
+}
+
 }
 
 /**
@@ -332,6 +383,78 @@ template<std::size_t cols, std::size_t rows, class T> std::tuple<RectangularMatr
     return std::make_tuple(m, q, v);
 }
 
+/**
+@brief Singular Value Decomposition of a 3x3 matrix
+
+Unlike the generic @ref svd(), which is written for arbitrary sizes, this
+is a specialized variant for the common 3x3 case, used for example for
+rigid point set registration or in @ref polarDecomposition(). Returns
+@f$ U @f$, diagonal of @f$ \Sigma @f$ and non-transposed @f$ V @f$ such that
+@f[
+    M = U \Sigma V^T
+@f]
+
+Differently from @ref svd(), both @f$ U @f$ and @f$ V @f$ are always proper
+rotations (i.e., with determinant @f$ 1 @f$) and the singular values are
+sorted by magnitude, largest first. If the determinant of @f$ M @f$ is
+negative, the last singular value is negative. The eigenvectors of
+@f$ M^T M @f$ are calculated using cyclic Jacobi rotations and @f$ U @f$ is
+then orthonormalized from @f$ M V @f$, handling rank-deficient matrices
+without any special input. Because of going through @f$ M^T M @f$, the
+relative precision of singular values much smaller than the largest one is
+lower than with @ref svd().
+@see @ref svd3x3Into()
+*/
+template<class T> std::tuple<Matrix3x3<T>, Vector3<T>, Matrix3x3<T>> svd3x3(const Matrix3x3<T>& m) {
+    Matrix3x3<T> s = m.transposed()*m;
+    Matrix3x3<T> v{NoInit};
+    Implementation::jacobiEigen3x3(s, v);
+
+    /* Sort by eigenvalue, then ensure V is a rotation */
+    Vector3<T> eigenvalues{s[0][0], s[1][1], s[2][2]};
+    for(std::size_t i = 0; i != 2; ++i) for(std::size_t j = 0; j != 2 - i; ++j) {
+        if(eigenvalues[j] >= eigenvalues[j + 1]) continue;
+        std::swap(eigenvalues[j], eigenvalues[j + 1]);
+        std::swap(v[j], v[j + 1]);
+    }
+    if(dot(cross(Vector3<T>{v[0]}, Vector3<T>{v[1]}), Vector3<T>{v[2]}) < T(0))
+        v[2] = -v[2];
+
+    /* Columns of M V are the columns of U scaled by singular values,
+       orthonormalize them. The last column is always a cross product of the
+       first two, so the determinant of M ends up in the sign of the last
+       singular value. */
+    const Matrix3x3<T> b = m*v;
+    const T length0 = b[0].length();
+    const Vector3<T> u0 = length0 > T(0) ? Vector3<T>{b[0]/length0} : Vector3<T>::xAxis();
+    const Vector3<T> b1 = Vector3<T>{b[1]} - u0*dot(u0, Vector3<T>{b[1]});
+    const T length1 = b1.length();
+    Vector3<T> u1{NoInit};
+    if(length1 > std::numeric_limits<T>::epsilon()*length0)
+        u1 = b1/length1;
+    else
+        u1 = cross(u0, std::abs(u0.x()) < T(0.9) ? Vector3<T>::xAxis() : Vector3<T>::yAxis()).normalized();
+    const Vector3<T> u2 = cross(u0, u1);
+
+    return std::make_tuple(Matrix3x3<T>{u0, u1, u2},
+        Vector3<T>{dot(u0, Vector3<T>{b[0]}), dot(u1, Vector3<T>{b[1]}), dot(u2, Vector3<T>{b[2]})}, v);
+}
+
+/**
+@brief Singular Value Decomposition of an array of 3x3 matrices
+
+Equivalent to calling @ref svd3x3() on each item of @p matrices, putting
+the results to @p u, @p w and @p v. There are no dependencies between the
+iterations, so large batches can be split among threads, for example using
+@ref ThreadPool. Expects that all views have the same size.
+*/
+template<class T> void svd3x3Into(const Corrade::Containers::ArrayView<const Matrix3x3<T>> matrices, const Corrade::Containers::ArrayView<Matrix3x3<T>> u, const Corrade::Containers::ArrayView<Vector3<T>> w, const Corrade::Containers::ArrayView<Matrix3x3<T>> v) {
+    CORRADE_ASSERT(matrices.size() == u.size() && matrices.size() == w.size() && matrices.size() == v.size(),
+        "Math::Algorithms::svd3x3Into(): expected" << matrices.size() << "items in all views but got" << u.size() << Corrade::Utility::Debug::nospace << "," << w.size() << "and" << v.size(), );
+    for(std::size_t i = 0; i != matrices.size(); ++i)
+        std::tie(u[i], w[i], v[i]) = svd3x3(matrices[i]);
+}
+
 }}}
 
 #endif
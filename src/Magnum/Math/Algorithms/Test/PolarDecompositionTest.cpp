@@ -0,0 +1,104 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Algorithms/PolarDecomposition.h"
+
+namespace Magnum { namespace Math { namespace Algorithms { namespace Test {
+
+struct PolarDecompositionTest: Corrade::TestSuite::Tester {
+    explicit PolarDecompositionTest();
+
+    void test();
+    void reflection();
+    void array();
+};
+
+typedef Math::Matrix3x3<Float> Matrix3x3;
+typedef Math::Vector3<Float> Vector3;
+
+PolarDecompositionTest::PolarDecompositionTest() {
+    addTests({&PolarDecompositionTest::test,
+              &PolarDecompositionTest::reflection,
+              &PolarDecompositionTest::array});
+}
+
+void PolarDecompositionTest::test() {
+    /* Rotation around Z by 90° combined with a non-uniform scale and shear */
+    const Matrix3x3 rotation{
+        Vector3{0.0f, 1.0f, 0.0f},
+        Vector3{-1.0f, 0.0f, 0.0f},
+        Vector3{0.0f, 0.0f, 1.0f}};
+    const Matrix3x3 stretch{
+        Vector3{2.0f, 0.5f, 0.0f},
+        Vector3{0.5f, 3.0f, 0.0f},
+        Vector3{0.0f, 0.0f, 1.5f}};
+
+    Matrix3x3 r{NoInit}, s{NoInit};
+    std::tie(r, s) = Algorithms::polarDecomposition(rotation*stretch);
+    CORRADE_COMPARE(r, rotation);
+    CORRADE_COMPARE(s, stretch);
+    CORRADE_COMPARE(r*s, rotation*stretch);
+}
+
+void PolarDecompositionTest::reflection() {
+    const Matrix3x3 a = Matrix3x3::fromDiagonal({1.0f, -2.0f, 3.0f});
+
+    Matrix3x3 r{NoInit}, s{NoInit};
+    std::tie(r, s) = Algorithms::polarDecomposition(a);
+
+    /* The rotation is proper, the reflection ends up in the stretch */
+    CORRADE_COMPARE(r*r.transposed(), Matrix3x3{IdentityInit});
+    CORRADE_COMPARE(r.determinant(), 1.0f);
+    CORRADE_COMPARE(s, s.transposed());
+    CORRADE_COMPARE(r*s, a);
+}
+
+void PolarDecompositionTest::array() {
+    const Matrix3x3 matrices[]{
+        Matrix3x3{IdentityInit},
+        Matrix3x3::fromDiagonal({1.0f, -2.0f, 3.0f}),
+        Matrix3x3{Vector3{2.0f, -1.0f, 3.0f},
+                  Vector3{4.0f, 5.0f, -2.0f},
+                  Vector3{-1.0f, 0.0f, 1.0f}}};
+    Matrix3x3 rotations[3];
+    Matrix3x3 stretches[3];
+    Algorithms::polarDecompositionInto<Float>(matrices, rotations, stretches);
+
+    for(std::size_t i = 0; i != 3; ++i) {
+        Matrix3x3 r{NoInit}, s{NoInit};
+        std::tie(r, s) = Algorithms::polarDecomposition(matrices[i]);
+        CORRADE_COMPARE(rotations[i], r);
+        CORRADE_COMPARE(stretches[i], s);
+    }
+
+    CORRADE_COMPARE(rotations[0], Matrix3x3{IdentityInit});
+    CORRADE_COMPARE(stretches[0], Matrix3x3{IdentityInit});
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Algorithms::Test::PolarDecompositionTest)
@@ -33,6 +33,9 @@ struct SvdTest: Corrade::TestSuite::Tester {
     explicit SvdTest();
 
     template<class T> void test();
+    template<class T> void test3x3();
+    void test3x3RankDeficient();
+    void test3x3Array();
 };
 
 template<class T> using Matrix5x8 = RectangularMatrix<5, 8, T>;
@@ -43,7 +46,11 @@ template<class T> using Vector5 = Vector<5, T>;
 
 SvdTest::SvdTest() {
     addTests<SvdTest>({&SvdTest::test<Float>,
-                       &SvdTest::test<Double>});
+                       &SvdTest::test<Double>,
+                       &SvdTest::test3x3<Float>,
+                       &SvdTest::test3x3<Double>,
+                       &SvdTest::test3x3RankDeficient,
+                       &SvdTest::test3x3Array});
 }
 
 template<class T> void SvdTest::test() {
@@ -91,6 +98,84 @@ template<class T> void SvdTest::test() {
     }
 }
 
+template<class T> void SvdTest::test3x3() {
+    setTestCaseName(std::is_same<T, Double>::value ? "test3x3<Double>" : "test3x3<Float>");
+
+    /* Negative determinant, so the last singular value is negative */
+    const Matrix3x3<T> a{
+        Vector3<T>{T{ 2}, T{-1}, T{ 3}},
+        Vector3<T>{T{ 4}, T{ 5}, T{-2}},
+        Vector3<T>{T{-1}, T{ 0}, T{ 1}}};
+
+    Matrix3x3<T> u{NoInit};
+    Vector3<T> w{NoInit};
+    Matrix3x3<T> v{NoInit};
+    std::tie(u, w, v) = Algorithms::svd3x3(a);
+
+    /* Test composition */
+    CORRADE_COMPARE(u*Matrix3x3<T>::fromDiagonal(w)*v.transposed(), a);
+
+    /* Both U and V are proper rotations */
+    CORRADE_COMPARE(u*u.transposed(), Matrix3x3<T>{IdentityInit});
+    CORRADE_COMPARE(v*v.transposed(), Matrix3x3<T>{IdentityInit});
+    CORRADE_COMPARE(u.determinant(), T{1});
+    CORRADE_COMPARE(v.determinant(), T{1});
+
+    /* Sorted by magnitude, sign of the determinant in the last value */
+    CORRADE_VERIFY(w[0] >= std::abs(w[1]));
+    CORRADE_VERIFY(w[1] >= std::abs(w[2]));
+    CORRADE_COMPARE(w[0]*w[1]*w[2], a.determinant());
+}
+
+void SvdTest::test3x3RankDeficient() {
+    /* Third column is a sum of the first two */
+    const Matrix3x3<Float> a{
+        Vector3<Float>{1.0f, 2.0f, 0.0f},
+        Vector3<Float>{0.0f, 1.0f, 3.0f},
+        Vector3<Float>{1.0f, 3.0f, 3.0f}};
+
+    Matrix3x3<Float> u{NoInit};
+    Vector3<Float> w{NoInit};
+    Matrix3x3<Float> v{NoInit};
+    std::tie(u, w, v) = Algorithms::svd3x3(a);
+
+    CORRADE_COMPARE(u*Matrix3x3<Float>::fromDiagonal(w)*v.transposed(), a);
+    CORRADE_COMPARE(u*u.transposed(), Matrix3x3<Float>{IdentityInit});
+    CORRADE_COMPARE(v*v.transposed(), Matrix3x3<Float>{IdentityInit});
+    CORRADE_COMPARE(w[2] + 1.0f, 1.0f);
+
+    /* Zero matrix */
+    std::tie(u, w, v) = Algorithms::svd3x3(Matrix3x3<Float>{ZeroInit});
+    CORRADE_COMPARE(w, Vector3<Float>{});
+    CORRADE_COMPARE(u*u.transposed(), Matrix3x3<Float>{IdentityInit});
+    CORRADE_COMPARE(v, Matrix3x3<Float>{IdentityInit});
+}
+
+void SvdTest::test3x3Array() {
+    const Matrix3x3<Float> matrices[]{
+        Matrix3x3<Float>{IdentityInit},
+        Matrix3x3<Float>::fromDiagonal({3.0f, -2.0f, 0.5f}),
+        Matrix3x3<Float>{Vector3<Float>{2.0f, -1.0f, 3.0f},
+                         Vector3<Float>{4.0f, 5.0f, -2.0f},
+                         Vector3<Float>{-1.0f, 0.0f, 1.0f}}};
+    Matrix3x3<Float> u[3];
+    Vector3<Float> w[3];
+    Matrix3x3<Float> v[3];
+    Algorithms::svd3x3Into<Float>(matrices, u, w, v);
+
+    for(std::size_t i = 0; i != 3; ++i) {
+        Matrix3x3<Float> expectedU{NoInit};
+        Vector3<Float> expectedW{NoInit};
+        Matrix3x3<Float> expectedV{NoInit};
+        std::tie(expectedU, expectedW, expectedV) = Algorithms::svd3x3(matrices[i]);
+        CORRADE_COMPARE(u[i], expectedU);
+        CORRADE_COMPARE(w[i], expectedW);
+        CORRADE_COMPARE(v[i], expectedV);
+    }
+
+    CORRADE_COMPARE(w[1], (Vector3<Float>{3.0f, 2.0f, -0.5f}));
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Math::Algorithms::Test::SvdTest)
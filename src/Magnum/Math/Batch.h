@@ -0,0 +1,189 @@
+#ifndef Magnum_Math_Batch_h
+#define Magnum_Math_Batch_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::Math::normalizeInPlace(), @ref Magnum::Math::dotInto(), @ref Magnum::Math::transformInPlace(), @ref Magnum::Math::lerpInto(), @ref Magnum::Math::clampInPlace(), @ref Magnum::Math::slerpInto(), @ref Magnum::Math::join(Containers::ArrayView<const T>), @ref Magnum::Math::intersectsInto()
+ *
+ * Counterparts to the math functions that operate on whole contiguous arrays
+ * at once, so MeshTools, Shapes or animation code doesn't need to write the
+ * loops by hand. The loops have no dependencies between iterations, which
+ * allows the compiler to vectorize them for the instruction set the project
+ * is built for; with @ref MAGNUM_MATH_SIMD defined the matrix transformations
+ * also use the explicit SSE / NEON implementation. The views are expected to
+ * be non-overlapping unless said otherwise.
+ */
+
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Quaternion.h"
+#include "Magnum/Math/Range.h"
+
+namespace Magnum { namespace Math {
+
+/**
+@brief Normalize vectors in-place
+
+Equivalent to calling @ref Vector::normalized() on each item. Accepts any
+vector type.
+*/
+template<class T> void normalizeInPlace(const Corrade::Containers::ArrayView<T> vectors) {
+    for(T& vector: vectors)
+        vector *= typename T::Type(1)/std::sqrt(dot(vector, vector));
+}
+
+/**
+@brief Dot products of pairs of vectors
+
+Equivalent to calling @ref dot(const Vector<size, T>&, const Vector<size, T>&)
+on each pair of @p a and @p b, putting results to @p out. Expects that all
+views have the same size.
+*/
+template<class T> void dotInto(const Corrade::Containers::ArrayView<const T> a, const Corrade::Containers::ArrayView<const T> b, const Corrade::Containers::ArrayView<typename T::Type> out) {
+    CORRADE_ASSERT(a.size() == b.size() && a.size() == out.size(),
+        "Math::dotInto(): expected" << a.size() << "items in all views but got" << b.size() << "and" << out.size(), );
+    for(std::size_t i = 0; i != out.size(); ++i)
+        out[i] = dot(a[i], b[i]);
+}
+
+/**
+@brief Transform vectors in-place using given matrix
+
+Equivalent to multiplying each vector with the matrix, for example
+@ref Matrix4 with @ref Vector4. For transforming three-component points or
+vectors with a four-by-four matrix see @ref Matrix4::transformPoint(),
+@ref Matrix4::transformVector() and the batch functions in
+@ref Magnum/MeshTools/Transform.h.
+*/
+template<std::size_t size, class T, class U> void transformInPlace(const RectangularMatrix<size, size, T>& matrix, const Corrade::Containers::ArrayView<U> vectors) {
+    for(U& vector: vectors) vector = U(matrix*vector);
+}
+
+/**
+@brief Linear interpolation of pairs of values
+
+Equivalent to calling @ref lerp(const T&, const T&, U) on each pair of @p a
+and @p b with the same @p t, putting the results to @p out. Expects that all
+views have the same size. The @p out view can be the same as @p a or @p b.
+*/
+template<class T, class U> void lerpInto(const Corrade::Containers::ArrayView<const T> a, const Corrade::Containers::ArrayView<const T> b, const U t, const Corrade::Containers::ArrayView<T> out) {
+    CORRADE_ASSERT(a.size() == b.size() && a.size() == out.size(),
+        "Math::lerpInto(): expected" << a.size() << "items in all views but got" << b.size() << "and" << out.size(), );
+    for(std::size_t i = 0; i != out.size(); ++i)
+        out[i] = lerp(a[i], b[i], t);
+}
+
+/**
+@brief Clamp values in-place
+
+Equivalent to calling @ref clamp() on each item. Works both with scalars and
+vectors, for vectors @p min and @p max can be either vectors or scalars.
+*/
+template<class T, class U> void clampInPlace(const Corrade::Containers::ArrayView<T> values, const U& min, const U& max) {
+    for(T& value: values) value = T(clamp(value, min, max));
+}
+
+/**
+@brief Spherical linear interpolation of pairs of quaternions
+
+Equivalent to calling @ref slerp(const Quaternion<T>&, const Quaternion<T>&, T)
+on each pair of @p a and @p b with the same @p t, putting the results to
+@p out. Expects that all quaternions are normalized and that all views have
+the same size. The @p out view can be the same as @p a or @p b.
+*/
+template<class T> void slerpInto(const Corrade::Containers::ArrayView<const Quaternion<T>> a, const Corrade::Containers::ArrayView<const Quaternion<T>> b, const T t, const Corrade::Containers::ArrayView<Quaternion<T>> out) {
+    CORRADE_ASSERT(a.size() == b.size() && a.size() == out.size(),
+        "Math::slerpInto(): expected" << a.size() << "items in all views but got" << b.size() << "and" << out.size(), );
+    for(std::size_t i = 0; i != out.size(); ++i)
+        out[i] = slerp(a[i], b[i], t);
+}
+
+/**
+@brief Spherical linear interpolation of pairs of quaternions with separate interpolation factors
+
+Same as above, but with a separate interpolation factor for each pair, for
+example when evaluating many animation tracks at once. Expects that @p t has
+the same size as the other views.
+*/
+template<class T> void slerpInto(const Corrade::Containers::ArrayView<const Quaternion<T>> a, const Corrade::Containers::ArrayView<const Quaternion<T>> b, const Corrade::Containers::ArrayView<const T> t, const Corrade::Containers::ArrayView<Quaternion<T>> out) {
+    CORRADE_ASSERT(a.size() == b.size() && a.size() == t.size() && a.size() == out.size(),
+        "Math::slerpInto(): expected" << a.size() << "items in all views but got" << b.size() << Corrade::Utility::Debug::nospace << "," << t.size() << "and" << out.size(), );
+    for(std::size_t i = 0; i != out.size(); ++i)
+        out[i] = slerp(a[i], b[i], t[i]);
+}
+
+/**
+@brief Join a list of ranges
+
+Equivalent to calling @ref join(const Range<dimensions, T>&, const Range<dimensions, T>&)
+on all items, e.g. for merging bounds of mesh clusters or children of a BVH
+node. Empty ranges are skipped, if all of them are empty, a zero range is
+returned. Works with @ref Range as well as its subclasses.
+@see @ref MeshTools::bounds()
+*/
+template<class T> T join(const Corrade::Containers::ArrayView<const T> ranges) {
+    std::size_t i = 0;
+    while(i != ranges.size() && ranges[i].min() == ranges[i].max()) ++i;
+    if(i == ranges.size()) return {};
+
+    auto min = ranges[i].min(), max = ranges[i].max();
+    for(++i; i != ranges.size(); ++i) {
+        if(ranges[i].min() == ranges[i].max()) continue;
+        min = Math::min(min, ranges[i].min());
+        max = Math::max(max, ranges[i].max());
+    }
+
+    return {min, max};
+}
+
+/**
+@brief Intersection tests of a list of ranges with a range
+
+Equivalent to calling @ref intersects(const Range<dimensions, T>&, const Range<dimensions, T>&)
+on each of @p ranges and @p range, putting the results to @p out. The tests
+are done separately for each dimension without early exits, so the loop
+doesn't contain any branches. Expects that @p out has the same size as
+@p ranges. Works with @ref Range as well as its subclasses.
+*/
+template<class T> void intersectsInto(const Corrade::Containers::ArrayView<const T> ranges, const T& range, const Corrade::Containers::ArrayView<bool> out) {
+    CORRADE_ASSERT(ranges.size() == out.size(),
+        "Math::intersectsInto(): expected" << ranges.size() << "items in the output but got" << out.size(), );
+    typedef typename std::decay<decltype(range.min())>::type VectorType;
+    const VectorType min = range.min(), max = range.max();
+    for(std::size_t i = 0; i != ranges.size(); ++i) {
+        const VectorType a = ranges[i].min(), b = ranges[i].max();
+        bool result = true;
+        for(std::size_t j = 0; j != VectorType::Size; ++j)
+            result &= (b[j] > min[j]) & (a[j] < max[j]);
+        out[i] = result;
+    }
+}
+
+}}
+
+#endif
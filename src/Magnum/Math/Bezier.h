@@ -30,7 +30,10 @@
  * @brief Class @ref Magnum::Math::Bezier, alias @ref Magnum::Math::QuadraticBezier, @ref Magnum::Math::QuadraticBezier2D, @ref Magnum::Math::QuadraticBezier3D, @ref Magnum::Math::CubicBezier, @ref Magnum::Math::CubicBezier2D, @ref Magnum::Math::CubicBezier3D
  */
 
+#include <algorithm>
 #include <array>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Utility/Assert.h>
 
 #include "Magnum/Math/Vector.h"
 
@@ -48,6 +51,36 @@ namespace Implementation {
 
 Implementation of M-order N-dimensional
 [Bézier Curve](https://en.wikipedia.org/wiki/B%C3%A9zier_curve).
+
+@section Math-Bezier-batch Evaluating many points at once
+
+While @ref value() and @ref tangent() are convenient for evaluating a single
+point, they go through all De Casteljau intermediate points each time. When
+sampling the curve at many positions, use @ref valueInto() and
+@ref tangentInto() instead --- these convert the control points to
+@ref polynomialCoefficients() once and then evaluate each point using just
+@ref Order multiply-adds.
+
+For traversing the curve with constant speed, fill a table of cumulative
+arc lengths at uniformly spaced curve parameters using @ref arcLengthsInto()
+once and then convert distances along the curve to curve parameters using
+@ref arcLengthParametersInto(), which does only a binary search and a linear
+interpolation in the table for each distance:
+
+@code{.cpp}
+CubicBezier2D curve{...};
+Float lengths[64];
+curve.arcLengthsInto(lengths);
+
+Float distances[1000];
+for(std::size_t i = 0; i != 1000; ++i) distances[i] = lengths[63]*i/999.0f;
+
+Float t[1000];
+Math::Vector<2, Float> points[1000];
+CubicBezier2D::arcLengthParametersInto(lengths, distances, t);
+curve.valueInto(t, points);
+@endcode
+
 @see @ref QuadraticBezier, @ref CubicBezier, @ref QuadraticBezier2D,
     @ref QuadraticBezier3D, @ref CubicBezier2D, @ref CubicBezier3D
 */
@@ -154,6 +187,142 @@ template<UnsignedInt order, UnsignedInt dimensions, class T> class Bezier {
             return {left, right};
         }
 
+        /**
+         * @brief Tangent of the curve at given position
+         *
+         * Returns derivative of the curve with respect to the interpolation
+         * factor, calculated from the last two De Casteljau's intermediate
+         * points. The result is not normalized.
+         * @see @ref tangentInto()
+         */
+        Vector<dimensions, T> tangent(Float t) const {
+            const auto iPoints = calculateIntermediatePoints(t);
+            return T(order)*(iPoints[1][order - 1] - iPoints[0][order - 1]);
+        }
+
+        /**
+         * @brief Polynomial coefficients
+         *
+         * Returns coefficients @f$ \boldsymbol{c}_k @f$ of the curve in
+         * power basis, such that @f[
+         *      \boldsymbol{B}(t) = \sum_{k = 0}^{n} \boldsymbol{c}_k t^k
+         * @f]
+         *
+         * Evaluating the polynomial is cheaper than De Casteljau's algorithm,
+         * but numerically less stable for high orders.
+         * @see @ref valueInto(), @ref tangentInto()
+         */
+        std::array<Vector<dimensions, T>, order + 1> polynomialCoefficients() const {
+            std::array<Vector<dimensions, T>, order + 1> coefficients;
+            T binomialNK = T(1);
+            for(std::size_t k = 0; k <= order; ++k) {
+                Vector<dimensions, T> sum;
+                T binomialKI = T(1);
+                for(std::size_t i = 0; i <= k; ++i) {
+                    sum += ((k - i) % 2 ? -binomialKI : binomialKI)*_data[i];
+                    binomialKI = binomialKI*T(k - i)/T(i + 1);
+                }
+                coefficients[k] = binomialNK*sum;
+                binomialNK = binomialNK*T(order - k)/T(k + 1);
+            }
+            return coefficients;
+        }
+
+        /**
+         * @brief Interpolate the curve at given list of positions
+         *
+         * Equivalent to calling @ref value() for each item of @p t and
+         * putting the result into @p out, but evaluated using Horner's
+         * scheme on @ref polynomialCoefficients() calculated only once.
+         * Expects that both views have the same size.
+         * @see @ref tangentInto()
+         */
+        void valueInto(Corrade::Containers::ArrayView<const T> t, Corrade::Containers::ArrayView<Vector<dimensions, T>> out) const {
+            CORRADE_ASSERT(t.size() == out.size(),
+                "Math::Bezier::valueInto(): expected" << t.size() << "items in the output view but got" << out.size(), );
+            const std::array<Vector<dimensions, T>, order + 1> coefficients = polynomialCoefficients();
+            for(std::size_t i = 0; i != t.size(); ++i) {
+                Vector<dimensions, T> value = coefficients[order];
+                for(std::size_t k = order; k != 0; --k)
+                    value = value*t[i] + coefficients[k - 1];
+                out[i] = value;
+            }
+        }
+
+        /**
+         * @brief Tangent of the curve at given list of positions
+         *
+         * Equivalent to calling @ref tangent() for each item of @p t and
+         * putting the result into @p out, but evaluated using Horner's
+         * scheme on derivative of @ref polynomialCoefficients() calculated
+         * only once. Expects that both views have the same size.
+         * @see @ref valueInto()
+         */
+        void tangentInto(Corrade::Containers::ArrayView<const T> t, Corrade::Containers::ArrayView<Vector<dimensions, T>> out) const {
+            CORRADE_ASSERT(t.size() == out.size(),
+                "Math::Bezier::tangentInto(): expected" << t.size() << "items in the output view but got" << out.size(), );
+            const std::array<Vector<dimensions, T>, order> coefficients = derivativeCoefficients();
+            for(std::size_t i = 0; i != t.size(); ++i)
+                out[i] = evaluateDerivative(coefficients, t[i]);
+        }
+
+        /**
+         * @brief Fill a table of cumulative arc lengths
+         *
+         * Item @f$ i @f$ of @p lengths is set to length of the curve between
+         * @f$ t = 0 @f$ and @f$ t = \frac{i}{n - 1} @f$, where @f$ n @f$ is
+         * size of the view, so the first item is always zero and the last
+         * is length of the whole curve. Length of each segment is
+         * calculated using three-point Gauss-Legendre quadrature of the
+         * tangent length, which is exact for straight lines and quadratic
+         * curves with collinear control points. Expects that the view has
+         * at least two items.
+         * @see @ref arcLengthParametersInto()
+         */
+        void arcLengthsInto(Corrade::Containers::ArrayView<T> lengths) const {
+            CORRADE_ASSERT(lengths.size() >= 2,
+                "Math::Bezier::arcLengthsInto(): expected at least two items but got" << lengths.size(), );
+            const std::array<Vector<dimensions, T>, order> coefficients = derivativeCoefficients();
+            const T step = T(1)/T(lengths.size() - 1);
+            const T offset = step*T(0.5)*std::sqrt(T(0.6));
+            lengths[0] = T(0);
+            for(std::size_t i = 1; i != lengths.size(); ++i) {
+                const T middle = step*(T(i) - T(0.5));
+                lengths[i] = lengths[i - 1] + step*T(0.5)*(
+                    T(5)/T(9)*evaluateDerivative(coefficients, middle - offset).length() +
+                    T(8)/T(9)*evaluateDerivative(coefficients, middle).length() +
+                    T(5)/T(9)*evaluateDerivative(coefficients, middle + offset).length());
+            }
+        }
+
+        /**
+         * @brief Convert distances along the curve to curve parameters
+         * @param lengths       Table of cumulative arc lengths filled by
+         *      @ref arcLengthsInto()
+         * @param distances     Distances along the curve
+         * @param t             Where to put the curve parameters
+         *
+         * Finds the table segment containing each distance using binary
+         * search and interpolates linearly in it. Distances outside of the
+         * range of the table are clamped. Expects that the table has at
+         * least two items and that @p distances and @p t have the same
+         * size.
+         */
+        static void arcLengthParametersInto(Corrade::Containers::ArrayView<const T> lengths, Corrade::Containers::ArrayView<const T> distances, Corrade::Containers::ArrayView<T> t) {
+            CORRADE_ASSERT(lengths.size() >= 2,
+                "Math::Bezier::arcLengthParametersInto(): expected at least two items in the table but got" << lengths.size(), );
+            CORRADE_ASSERT(distances.size() == t.size(),
+                "Math::Bezier::arcLengthParametersInto(): expected" << distances.size() << "items in the output view but got" << t.size(), );
+            const T step = T(1)/T(lengths.size() - 1);
+            for(std::size_t i = 0; i != distances.size(); ++i) {
+                const T* const found = std::upper_bound(lengths.begin() + 1, lengths.end() - 1, distances[i]);
+                const std::size_t segment = found - lengths.begin() - 1;
+                const T segmentLength = lengths[segment + 1] - lengths[segment];
+                const T factor = segmentLength > T(0) ? (distances[i] - lengths[segment])/segmentLength : T(0);
+                t[i] = (T(segment) + std::min(std::max(factor, T(0)), T(1)))*step;
+            }
+        }
+
     private:
         /* Implementation for Bezier<order, dimensions, T>::Bezier(const Bezier<order, dimensions, U>&) */
         template<class U, std::size_t ...sequence> constexpr explicit Bezier(Implementation::Sequence<sequence...>, const Bezier<order, dimensions, U>& other) noexcept: _data{Vector<dimensions, T>(other._data[sequence])...} {}
@@ -162,6 +331,22 @@ template<UnsignedInt order, UnsignedInt dimensions, class T> class Bezier {
         /* MSVC 2015 can't handle {} here */
         template<class U, std::size_t ...sequence> constexpr explicit Bezier(Implementation::Sequence<sequence...>, U): _data{Vector<dimensions, T>((static_cast<void>(sequence), U{typename U::Init{}}))...} {}
 
+        /* Power basis coefficients of the derivative */
+        std::array<Vector<dimensions, T>, order> derivativeCoefficients() const {
+            const std::array<Vector<dimensions, T>, order + 1> coefficients = polynomialCoefficients();
+            std::array<Vector<dimensions, T>, order> out;
+            for(std::size_t k = 0; k != order; ++k)
+                out[k] = T(k + 1)*coefficients[k + 1];
+            return out;
+        }
+
+        static Vector<dimensions, T> evaluateDerivative(const std::array<Vector<dimensions, T>, order>& coefficients, const T t) {
+            Vector<dimensions, T> value = coefficients[order - 1];
+            for(std::size_t k = order - 1; k != 0; --k)
+                value = value*t + coefficients[k - 1];
+            return value;
+        }
+
         /* Calculates and returns all intermediate points generated when using De Casteljau's algorithm */
         std::array<Bezier<order, dimensions, T>, order + 1> calculateIntermediatePoints(Float t) const {
             std::array<Bezier<order, dimensions, T>, order + 1> iPoints;
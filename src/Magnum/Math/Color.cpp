@@ -25,10 +25,92 @@
 
 #include "Color.h"
 
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+
 namespace Magnum { namespace Math {
 
 namespace {
     constexpr const char Hex[]{"0123456789abcdef"};
+
+    /* Linear value for each 8-bit sRGB value. Thanks to the conversion being
+       monotonic, the same table gives the lower bound of the linear range
+       that packs to given sRGB value, with toSrgb<UnsignedByte>() being
+       Integral(toSrgb()*255). */
+    struct SrgbTable {
+        SrgbTable() {
+            for(std::size_t i = 0; i != 256; ++i)
+                linear[i] = Color3<Float>::fromSrgb(Vector3<Float>{unpack<Float, UnsignedByte>(i)}).r();
+        }
+
+        Float linear[256];
+    };
+
+    const SrgbTable& srgbTable() {
+        static const SrgbTable table;
+        return table;
+    }
+
+    inline UnsignedByte toSrgb(const Float* const linear, const Float value) {
+        /* Fixed number of steps without any branches. Values below zero and
+           NaNs end up as 0, values above one as 255. */
+        UnsignedInt i = 0;
+        for(UnsignedInt step = 128; step; step >>= 1)
+            i += value >= linear[i + step] ? step : 0;
+        return UnsignedByte(i);
+    }
+}
+
+void fromSrgbInto(const Corrade::Containers::ArrayView<const Color3<UnsignedByte>> srgb, const Corrade::Containers::ArrayView<Color3<Float>> out) {
+    CORRADE_ASSERT(srgb.size() == out.size(),
+        "Math::fromSrgbInto(): expected" << srgb.size() << "items in the output view but got" << out.size(), );
+
+    const Float* const linear = srgbTable().linear;
+    for(std::size_t i = 0; i != srgb.size(); ++i)
+        out[i] = {linear[srgb[i].r()], linear[srgb[i].g()], linear[srgb[i].b()]};
+}
+
+void fromSrgbAlphaInto(const Corrade::Containers::ArrayView<const Color4<UnsignedByte>> srgbAlpha, const Corrade::Containers::ArrayView<Color4<Float>> out) {
+    CORRADE_ASSERT(srgbAlpha.size() == out.size(),
+        "Math::fromSrgbAlphaInto(): expected" << srgbAlpha.size() << "items in the output view but got" << out.size(), );
+
+    const Float* const linear = srgbTable().linear;
+    for(std::size_t i = 0; i != srgbAlpha.size(); ++i)
+        out[i] = {linear[srgbAlpha[i].r()], linear[srgbAlpha[i].g()], linear[srgbAlpha[i].b()], unpack<Float, UnsignedByte>(srgbAlpha[i].a())};
+}
+
+void toSrgbInto(const Corrade::Containers::ArrayView<const Color3<Float>> rgb, const Corrade::Containers::ArrayView<Color3<UnsignedByte>> out) {
+    CORRADE_ASSERT(rgb.size() == out.size(),
+        "Math::toSrgbInto(): expected" << rgb.size() << "items in the output view but got" << out.size(), );
+
+    const Float* const linear = srgbTable().linear;
+    for(std::size_t i = 0; i != rgb.size(); ++i)
+        out[i] = {toSrgb(linear, rgb[i].r()), toSrgb(linear, rgb[i].g()), toSrgb(linear, rgb[i].b())};
+}
+
+void toSrgbAlphaInto(const Corrade::Containers::ArrayView<const Color4<Float>> rgba, const Corrade::Containers::ArrayView<Color4<UnsignedByte>> out) {
+    CORRADE_ASSERT(rgba.size() == out.size(),
+        "Math::toSrgbAlphaInto(): expected" << rgba.size() << "items in the output view but got" << out.size(), );
+
+    const Float* const linear = srgbTable().linear;
+    for(std::size_t i = 0; i != rgba.size(); ++i)
+        out[i] = {toSrgb(linear, rgba[i].r()), toSrgb(linear, rgba[i].g()), toSrgb(linear, rgba[i].b()), pack<UnsignedByte, Float>(rgba[i].a())};
+}
+
+void fromHsvInto(const Corrade::Containers::ArrayView<const Color3<Float>::Hsv> hsv, const Corrade::Containers::ArrayView<Color3<Float>> out) {
+    CORRADE_ASSERT(hsv.size() == out.size(),
+        "Math::fromHsvInto(): expected" << hsv.size() << "items in the output view but got" << out.size(), );
+
+    for(std::size_t i = 0; i != hsv.size(); ++i)
+        out[i] = Color3<Float>::fromHsv(hsv[i]);
+}
+
+void toHsvInto(const Corrade::Containers::ArrayView<const Color3<Float>> rgb, const Corrade::Containers::ArrayView<Color3<Float>::Hsv> out) {
+    CORRADE_ASSERT(rgb.size() == out.size(),
+        "Math::toHsvInto(): expected" << rgb.size() << "items in the output view but got" << out.size(), );
+
+    for(std::size_t i = 0; i != rgb.size(); ++i)
+        out[i] = rgb[i].toHsv();
 }
 
 Corrade::Utility::Debug& operator<<(Corrade::Utility::Debug& debug, const Color3<UnsignedByte>& value) {
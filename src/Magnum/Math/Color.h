@@ -30,6 +30,7 @@
  */
 
 #include <tuple>
+#include <Corrade/Containers/ArrayView.h>
 
 #include "Magnum/Math/Matrix.h"
 #include "Magnum/Math/Packing.h"
@@ -203,6 +204,10 @@ template<class T> constexpr typename std::enable_if<std::is_floating_point<T>::v
 template<class T> constexpr typename std::enable_if<std::is_integral<T>::value, T>::type fullChannel() {
     return Implementation::bitMax<T>();
 }
+/* 1.0 in half-float representation */
+template<class T> constexpr typename std::enable_if<std::is_same<T, Half>::value, T>::type fullChannel() {
+    return T{UnsignedShort(0x3c00)};
+}
 
 }
 
@@ -1178,6 +1183,84 @@ inline Color4<Float> operator "" _srgbaf(unsigned long long value) {
 
 }
 
+/**
+@brief Convert an array of 8-bit sRGB colors to linear RGB
+@param[in]  srgb    Input sRGB colors
+@param[out] out     Where to put the linear RGB colors
+
+Equivalent to calling @ref Color3::fromSrgb(const Vector3<Integral>&) on each
+item, but using a 256-entry lookup table instead of evaluating
+@ref std::pow() for each channel. Expects that both views have the same size.
+Pixel data of an @ref Magnum::Image2D "Image2D" or
+@ref Magnum::ImageView2D "ImageView2D" with
+@ref Magnum::PixelFormat::RGB "PixelFormat::RGB" and
+@ref Magnum::PixelType::UnsignedByte "PixelType::UnsignedByte" can be passed
+here through @ref Corrade::Containers::arrayCast() if the rows are tightly
+packed.
+@see @ref toSrgbInto()
+*/
+MAGNUM_EXPORT void fromSrgbInto(Corrade::Containers::ArrayView<const Color3<UnsignedByte>> srgb, Corrade::Containers::ArrayView<Color3<Float>> out);
+
+/**
+@brief Convert an array of 8-bit sRGB + alpha colors to linear RGBA
+@param[in]  srgbAlpha   Input sRGB + alpha colors
+@param[out] out         Where to put the linear RGBA colors
+
+Equivalent to calling @ref Color4::fromSrgbAlpha(const Vector4<Integral>&) on
+each item, see @ref fromSrgbInto() for more information. The alpha channel is
+only unpacked, without any conversion.
+*/
+MAGNUM_EXPORT void fromSrgbAlphaInto(Corrade::Containers::ArrayView<const Color4<UnsignedByte>> srgbAlpha, Corrade::Containers::ArrayView<Color4<Float>> out);
+
+/**
+@brief Convert an array of linear RGB colors to 8-bit sRGB
+@param[in]  rgb     Input linear RGB colors
+@param[out] out     Where to put the sRGB colors
+
+Equivalent to calling @ref Color3::toSrgb() on each item, but instead of
+evaluating @ref std::pow() for each channel the output value is found with a
+fixed-length branchless binary search in the same 256-entry table that's
+used by @ref fromSrgbInto(), which means the two are exact inverses of each
+other. The result matches the scalar conversion except for values within
+floating-point precision of a boundary between two output values. Unlike
+with the scalar variant, values outside of the @f$ [0, 1] @f$ range are
+clamped. Expects that both views have the same size.
+*/
+MAGNUM_EXPORT void toSrgbInto(Corrade::Containers::ArrayView<const Color3<Float>> rgb, Corrade::Containers::ArrayView<Color3<UnsignedByte>> out);
+
+/**
+@brief Convert an array of linear RGBA colors to 8-bit sRGB + alpha
+@param[in]  rgba    Input linear RGBA colors
+@param[out] out     Where to put the sRGB + alpha colors
+
+Equivalent to calling @ref Color4::toSrgbAlpha() on each item, see
+@ref toSrgbInto() for more information. The alpha channel is only packed,
+without any conversion.
+*/
+MAGNUM_EXPORT void toSrgbAlphaInto(Corrade::Containers::ArrayView<const Color4<Float>> rgba, Corrade::Containers::ArrayView<Color4<UnsignedByte>> out);
+
+/**
+@brief Convert an array of HSV values to linear RGB
+@param[in]  hsv     Input HSV values
+@param[out] out     Where to put the linear RGB colors
+
+Equivalent to calling @ref Color3::fromHsv() on each item. Expects that both
+views have the same size.
+@see @ref toHsvInto()
+*/
+MAGNUM_EXPORT void fromHsvInto(Corrade::Containers::ArrayView<const Color3<Float>::Hsv> hsv, Corrade::Containers::ArrayView<Color3<Float>> out);
+
+/**
+@brief Convert an array of linear RGB colors to HSV
+@param[in]  rgb     Input linear RGB colors
+@param[out] out     Where to put the HSV values
+
+Equivalent to calling @ref Color3::toHsv() on each item. Expects that both
+views have the same size.
+@see @ref fromHsvInto()
+*/
+MAGNUM_EXPORT void toHsvInto(Corrade::Containers::ArrayView<const Color3<Float>> rgb, Corrade::Containers::ArrayView<Color3<Float>::Hsv> out);
+
 /**
 @debugoperator{Color3}
 
@@ -255,8 +255,8 @@ template<class T> class Complex {
          *
          * @see @ref operator+=(const Complex<T>&)
          */
-        Complex<T> operator+(const Complex<T>& other) const {
-            return Complex<T>(*this) += other;
+        constexpr Complex<T> operator+(const Complex<T>& other) const {
+            return {_real + other._real, _imaginary + other._imaginary};
         }
 
         /**
@@ -266,7 +266,7 @@ template<class T> class Complex {
          *      -c = -a -ib
          * @f]
          */
-        Complex<T> operator-() const {
+        constexpr Complex<T> operator-() const {
             return {-_real, -_imaginary};
         }
 
@@ -288,8 +288,8 @@ template<class T> class Complex {
          *
          * @see @ref operator-=(const Complex<T>&)
          */
-        Complex<T> operator-(const Complex<T>& other) const {
-            return Complex<T>(*this) -= other;
+        constexpr Complex<T> operator-(const Complex<T>& other) const {
+            return {_real - other._real, _imaginary - other._imaginary};
         }
 
         /**
@@ -310,8 +310,8 @@ template<class T> class Complex {
          *
          * @see @ref operator*=(T)
          */
-        Complex<T> operator*(T scalar) const {
-            return Complex<T>(*this) *= scalar;
+        constexpr Complex<T> operator*(T scalar) const {
+            return {_real*scalar, _imaginary*scalar};
         }
 
         /**
@@ -332,8 +332,8 @@ template<class T> class Complex {
          *
          * @see @ref operator/=(T)
          */
-        Complex<T> operator/(T scalar) const {
-            return Complex<T>(*this) /= scalar;
+        constexpr Complex<T> operator/(T scalar) const {
+            return {_real/scalar, _imaginary/scalar};
         }
 
         /**
@@ -343,7 +343,7 @@ template<class T> class Complex {
          *      c_0 c_1 = (a_0 + ib_0)(a_1 + ib_1) = (a_0 a_1 - b_0 b_1) + i(a_1 b_0 + a_0 b_1)
          * @f]
          */
-        Complex<T> operator*(const Complex<T>& other) const {
+        constexpr Complex<T> operator*(const Complex<T>& other) const {
             return {_real*other._real - _imaginary*other._imaginary,
                     _imaginary*other._real + _real*other._imaginary};
         }
@@ -387,7 +387,7 @@ template<class T> class Complex {
          *      c^* = a - ib
          * @f]
          */
-        Complex<T> conjugated() const {
+        constexpr Complex<T> conjugated() const {
             return {_real, -_imaginary};
         }
 
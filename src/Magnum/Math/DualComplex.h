@@ -79,7 +79,7 @@ template<class T> class DualComplex: public Dual<Complex<T>> {
          *      @ref DualQuaternion::translation(), @ref Vector2::xAxis(),
          *      @ref Vector2::yAxis()
          */
-        static DualComplex<T> translation(const Vector2<T>& vector) {
+        constexpr static DualComplex<T> translation(const Vector2<T>& vector) {
             return {{}, {vector.x(), vector.y()}};
         }
 
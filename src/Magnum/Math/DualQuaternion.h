@@ -138,8 +138,8 @@ template<class T> class DualQuaternion: public Dual<Quaternion<T>> {
          *      @ref DualComplex::translation(), @ref Vector3::xAxis(),
          *      @ref Vector3::yAxis(), @ref Vector3::zAxis()
          */
-        static DualQuaternion<T> translation(const Vector3<T>& vector) {
-            return {{}, {vector/T(2), T(0)}};
+        constexpr static DualQuaternion<T> translation(const Vector3<T>& vector) {
+            return {{}, {{vector.x()/T(2), vector.y()/T(2), vector.z()/T(2)}, T(0)}};
         }
 
         /**
@@ -0,0 +1,184 @@
+#ifndef Magnum_Math_FastFunctions_h
+#define Magnum_Math_FastFunctions_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Namespace @ref Magnum::Math::Fast
+ */
+
+#include <cstring>
+#include <utility>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Angle.h"
+#include "Magnum/Math/Functions.h"
+
+namespace Magnum { namespace Math { namespace Fast {
+
+/**
+@brief Approximate sine and cosine
+
+The angle is reduced to @f$ [-\frac{\pi}{4}, \frac{\pi}{4}] @f$ using a
+three-part Cody-Waite reduction and both values are calculated with a
+minimax polynomial. Absolute error is below @f$ 1.0 \cdot 10^{-7} @f$ for
+@f$ |x| < 1000 @f$ and below @f$ 1.0 \cdot 10^{-6} @f$ for
+@f$ |x| < 10^5 @f$; larger angles lose precision in the reduction.
+@see @ref Math::sincos(), @ref sincosInto()
+*/
+inline std::pair<Float, Float> sincos(const Rad<Float> angle) {
+    const Float x = Float(angle);
+    const Float n = std::floor(x*0.636619772f + 0.5f);
+    const Float r = ((x - n*1.5703125f) - n*4.837512969970703125e-4f) - n*7.549789954891882e-8f;
+    const Float z = r*r;
+    const Float s = r + r*z*(-1.6666654611e-1f + z*(8.3321608736e-3f + z*-1.9515295891e-4f));
+    const Float c = 1.0f - 0.5f*z + z*z*(4.166664568298827e-2f + z*(-1.388731625493765e-3f + z*2.443315711809948e-5f));
+
+    /* Quadrant selection, 1 and 3 swap sine and cosine, 2 and 3 flip sign of
+       sine, 1 and 2 flip sign of cosine */
+    const Int quadrant = Int(n) & 3;
+    const Float sine = quadrant & 1 ? c : s;
+    const Float cosine = quadrant & 1 ? s : c;
+    return {quadrant & 2 ? -sine : sine, (quadrant + 1) & 2 ? -cosine : cosine};
+}
+
+/**
+@brief Approximate sine
+
+Same precision as @ref sincos().
+@see @ref Math::sin()
+*/
+inline Float sin(const Rad<Float> angle) { return Fast::sincos(angle).first; }
+
+/**
+@brief Approximate cosine
+
+Same precision as @ref sincos().
+@see @ref Math::cos()
+*/
+inline Float cos(const Rad<Float> angle) { return Fast::sincos(angle).second; }
+
+/**
+@brief Approximate inverse square root
+
+Initial approximation from the bit pattern refined with two Newton-Raphson
+iterations. Relative error is below @f$ 5.0 \cdot 10^{-6} @f$ for all
+positive normalized inputs.
+@see @ref Math::sqrtInverted(), @ref invsqrtInto()
+*/
+inline Float invsqrt(const Float value) {
+    UnsignedInt bits;
+    std::memcpy(&bits, &value, sizeof(Float));
+    bits = 0x5f3759df - (bits >> 1);
+    Float out;
+    std::memcpy(&out, &bits, sizeof(Float));
+
+    const Float half = 0.5f*value;
+    out *= 1.5f - half*out*out;
+    out *= 1.5f - half*out*out;
+    return out;
+}
+
+/**
+@brief Approximate square root
+
+Calculated as @f$ x \sqrt{x}^{-1} @f$ using @ref invsqrt(), so it has the
+same relative error. Returns @cpp 0.0f @ce for zero input.
+@see @ref Math::sqrt()
+*/
+inline Float sqrt(const Float value) { return value*invsqrt(value); }
+
+/**
+@brief Approximate natural exponential
+
+The input is reduced to @f$ x = n \ln 2 + r @f$ with
+@f$ |r| \le \frac{\ln 2}{2} @f$, @f$ e^r @f$ is calculated with a
+degree-seven polynomial and the result is scaled by @f$ 2^n @f$ directly in
+the exponent bits. Relative error is below @f$ 1.0 \cdot 10^{-7} @f$ in the
+@f$ [-87, 88] @f$ range, inputs outside of it are clamped to it, so the
+result never underflows to a denormal or overflows to infinity.
+@see @ref expInto()
+*/
+inline Float exp(Float value) {
+    value = Math::clamp(value, -87.0f, 88.0f);
+    const Float n = std::floor(value*1.44269504f + 0.5f);
+    const Float r = (value - n*0.693359375f) + n*2.12194440e-4f;
+    const Float y = (((((1.9875691500e-4f*r + 1.3981999507e-3f)*r + 8.3334519073e-3f)*r + 4.1665795894e-2f)*r + 1.6666665459e-1f)*r + 5.0000001201e-1f)*r*r + r + 1.0f;
+
+    const UnsignedInt bits = UnsignedInt(Int(n) + 127) << 23;
+    Float scale;
+    std::memcpy(&scale, &bits, sizeof(Float));
+    return y*scale;
+}
+
+/**
+@brief Approximate sine and cosine of an array of angles
+
+Equivalent to calling @ref sincos() on each item of @p angles, putting the
+results to @p sines and @p cosines. Expects that all views have the same
+size.
+*/
+inline void sincosInto(const Corrade::Containers::ArrayView<const Rad<Float>> angles, const Corrade::Containers::ArrayView<Float> sines, const Corrade::Containers::ArrayView<Float> cosines) {
+    CORRADE_ASSERT(angles.size() == sines.size() && angles.size() == cosines.size(),
+        "Math::Fast::sincosInto(): expected" << angles.size() << "items in all views but got" << sines.size() << "and" << cosines.size(), );
+    for(std::size_t i = 0; i != angles.size(); ++i) {
+        const std::pair<Float, Float> sinecosine = Fast::sincos(angles[i]);
+        sines[i] = sinecosine.first;
+        cosines[i] = sinecosine.second;
+    }
+}
+
+/**
+@brief Approximate inverse square root of an array of values
+
+Equivalent to calling @ref invsqrt() on each item of @p values, putting the
+results to @p out. Expects that both views have the same size. The @p out
+view can be the same as @p values.
+*/
+inline void invsqrtInto(const Corrade::Containers::ArrayView<const Float> values, const Corrade::Containers::ArrayView<Float> out) {
+    CORRADE_ASSERT(values.size() == out.size(),
+        "Math::Fast::invsqrtInto(): expected" << values.size() << "items in the output view but got" << out.size(), );
+    for(std::size_t i = 0; i != values.size(); ++i)
+        out[i] = Fast::invsqrt(values[i]);
+}
+
+/**
+@brief Approximate natural exponential of an array of values
+
+Equivalent to calling @ref exp() on each item of @p values, putting the
+results to @p out. Expects that both views have the same size. The @p out
+view can be the same as @p values.
+*/
+inline void expInto(const Corrade::Containers::ArrayView<const Float> values, const Corrade::Containers::ArrayView<Float> out) {
+    CORRADE_ASSERT(values.size() == out.size(),
+        "Math::Fast::expInto(): expected" << values.size() << "items in the output view but got" << out.size(), );
+    for(std::size_t i = 0; i != values.size(); ++i)
+        out[i] = Fast::exp(values[i]);
+}
+
+}}}
+
+#endif
@@ -30,6 +30,9 @@
  * @brief Namespace @ref Magnum::Math::Geometry::Intersection
  */
 
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Utility/Assert.h>
+
 #include "Magnum/Math/Frustum.h"
 #include "Magnum/Math/Geometry/Distance.h"
 #include "Magnum/Math/Range.h"
@@ -169,6 +172,134 @@ of the frustum, since checking the corners is less efficient.
 */
 template<class T> bool boxFrustum(const Range3D<T>& box, const Frustum<T>& frustum);
 
+/**
+@brief Intersection of a sphere and a camera frustum
+@param sphereCenter Sphere center
+@param sphereRadius Sphere radius
+@param frustum      Frustum planes with normals pointing outwards
+
+Returns @cpp true @ce if the sphere intersects with the camera frustum.
+
+Checks for each plane of the frustum whether the sphere center lies behind the
+plane farther than the sphere radius. The planes don't need to be normalized,
+the comparison is done on squared distances scaled by the plane normal length
+to avoid a square root. Similarly to @ref boxFrustum(), spheres overlapping
+merely the corners of the frustum are considered as intersecting.
+*/
+template<class T> bool sphereFrustum(const Vector3<T>& sphereCenter, T sphereRadius, const Frustum<T>& frustum);
+
+/**
+@brief Intersection of an array of spheres and a camera frustum
+@param sphereCenters    Sphere centers
+@param sphereRadii      Sphere radii
+@param frustum          Frustum planes with normals pointing outwards
+@param visible          Where to put the result
+@return Count of spheres intersecting the frustum
+
+Equivalent to calling @ref sphereFrustum() on each sphere and putting the
+result into @p visible, but with the frustum planes converted to a
+structure-of-arrays layout only once and the loop over them done without
+any early exit so the compiler can vectorize it. Expects that all views
+have the same size.
+@see @ref boxesFrustumInto()
+*/
+template<class T> std::size_t spheresFrustumInto(Corrade::Containers::ArrayView<const Vector3<T>> sphereCenters, Corrade::Containers::ArrayView<const T> sphereRadii, const Frustum<T>& frustum, Corrade::Containers::ArrayView<bool> visible);
+
+/**
+@brief Intersection of an array of spheres and a camera frustum with plane caching
+@param sphereCenters    Sphere centers
+@param sphereRadii      Sphere radii
+@param frustum          Frustum planes with normals pointing outwards
+@param visible          Where to put the result
+@param planeCache       Index of the plane that rejected given sphere the
+    last time
+@return Count of spheres intersecting the frustum
+
+Exploits temporal coherence when the same set of spheres is tested against
+a slowly moving frustum every frame. For each sphere the plane at given
+index in @p planeCache is tested first; if it still rejects the sphere, the
+remaining planes are not tested at all. Otherwise all planes are tested and
+the index of the first plane rejecting the sphere is stored back to
+@p planeCache. Values outside of the @f$ [0, 5] @f$ range mean there's no
+information about given sphere, the cache can be thus initialized with
+anything. Expects that all views have the same size.
+*/
+template<class T> std::size_t spheresFrustumInto(Corrade::Containers::ArrayView<const Vector3<T>> sphereCenters, Corrade::Containers::ArrayView<const T> sphereRadii, const Frustum<T>& frustum, Corrade::Containers::ArrayView<bool> visible, Corrade::Containers::ArrayView<UnsignedByte> planeCache);
+
+/**
+@brief Intersection of an array of axis-aligned boxes and a camera frustum
+@param boxes        Axis-aligned boxes
+@param frustum      Frustum planes with normals pointing outwards
+@param visible      Where to put the result
+@return Count of boxes intersecting the frustum
+
+Gives the same result as calling @ref boxFrustum() on each box, but instead
+of testing all eight corners against each plane only the corner farthest
+along the plane normal is tested, calculated from box center and half-size.
+Similarly to @ref spheresFrustumInto(), the planes are converted to a
+structure-of-arrays layout only once and the loop over them is done without
+any early exit. Expects that both views have the same size.
+*/
+template<class T> std::size_t boxesFrustumInto(Corrade::Containers::ArrayView<const Range3D<T>> boxes, const Frustum<T>& frustum, Corrade::Containers::ArrayView<bool> visible);
+
+/**
+@brief Intersection of an array of axis-aligned boxes and a camera frustum with plane caching
+
+Same as @ref boxesFrustumInto(Corrade::Containers::ArrayView<const Range3D<T>>, const Frustum<T>&, Corrade::Containers::ArrayView<bool>),
+but exploiting temporal coherence using @p planeCache the same way as
+@ref spheresFrustumInto(Corrade::Containers::ArrayView<const Vector3<T>>, Corrade::Containers::ArrayView<const T>, const Frustum<T>&, Corrade::Containers::ArrayView<bool>, Corrade::Containers::ArrayView<UnsignedByte>).
+*/
+template<class T> std::size_t boxesFrustumInto(Corrade::Containers::ArrayView<const Range3D<T>> boxes, const Frustum<T>& frustum, Corrade::Containers::ArrayView<bool> visible, Corrade::Containers::ArrayView<UnsignedByte> planeCache);
+
+namespace Implementation {
+
+/* Frustum planes in a structure-of-arrays layout, with normal lengths
+   precalculated for the sphere test */
+template<class T> struct FrustumPlanes {
+    explicit FrustumPlanes(const Frustum<T>& frustum) {
+        for(std::size_t i = 0; i != 6; ++i) {
+            x[i] = frustum[i].x();
+            y[i] = frustum[i].y();
+            z[i] = frustum[i].z();
+            w[i] = frustum[i].w();
+            absX[i] = std::abs(x[i]);
+            absY[i] = std::abs(y[i]);
+            absZ[i] = std::abs(z[i]);
+            lengthSquared[i] = x[i]*x[i] + y[i]*y[i] + z[i]*z[i];
+        }
+    }
+
+    /* The sphere is entirely in front of the plane, same as in
+       sphereFrustum() */
+    bool sphereOutside(std::size_t i, const Vector3<T>& center, const T radiusSquared) const {
+        const T distance = x[i]*center.x() + y[i]*center.y() + z[i]*center.z() + w[i];
+        return distance < T(0) && distance*distance > radiusSquared*lengthSquared[i];
+    }
+
+    /* The corner farthest along the plane normal is in front of it */
+    bool boxOutside(std::size_t i, const Vector3<T>& center, const Vector3<T>& halfSize) const {
+        return x[i]*center.x() + y[i]*center.y() + z[i]*center.z() + w[i] +
+            absX[i]*halfSize.x() + absY[i]*halfSize.y() + absZ[i]*halfSize.z() < T(0);
+    }
+
+    T x[6], y[6], z[6], w[6], absX[6], absY[6], absZ[6], lengthSquared[6];
+};
+
+/* Tests the cached plane first, then all of them in order, updating the
+   cache with the first rejecting one */
+template<class F> bool outsideCached(UnsignedByte& cache, F outside) {
+    if(cache < 6 && outside(cache)) return true;
+
+    for(UnsignedByte i = 0; i != 6; ++i) if(outside(i)) {
+        cache = i;
+        return true;
+    }
+
+    return false;
+}
+
+}
+
 template<class T> bool pointFrustum(const Vector3<T>& point, const Frustum<T>& frustum) {
     for(const Vector4<T>& plane: frustum.planes()) {
         /* The point is in front of one of the frustum planes (normals point
@@ -202,6 +333,94 @@ template<class T> bool boxFrustum(const Range3D<T>& box, const Frustum<T>& frust
     return true;
 }
 
+template<class T> bool sphereFrustum(const Vector3<T>& sphereCenter, const T sphereRadius, const Frustum<T>& frustum) {
+    const T radiusSquared = sphereRadius*sphereRadius;
+    for(const Vector4<T>& plane: frustum.planes()) {
+        const T distance = Distance::pointPlaneScaled<T>(sphereCenter, plane);
+
+        /* The sphere is entirely in front of one of the frustum planes */
+        if(distance < T(0) && distance*distance > radiusSquared*plane.xyz().dot())
+            return false;
+    }
+
+    return true;
+}
+
+template<class T> std::size_t spheresFrustumInto(const Corrade::Containers::ArrayView<const Vector3<T>> sphereCenters, const Corrade::Containers::ArrayView<const T> sphereRadii, const Frustum<T>& frustum, const Corrade::Containers::ArrayView<bool> visible) {
+    CORRADE_ASSERT(sphereCenters.size() == sphereRadii.size() && sphereCenters.size() == visible.size(),
+        "Math::Geometry::Intersection::spheresFrustumInto(): expected" << sphereCenters.size() << "items in all views but got" << sphereRadii.size() << "and" << visible.size(), {});
+
+    const Implementation::FrustumPlanes<T> planes{frustum};
+    std::size_t count = 0;
+    for(std::size_t i = 0; i != sphereCenters.size(); ++i) {
+        const T radiusSquared = sphereRadii[i]*sphereRadii[i];
+        bool outside = false;
+        for(std::size_t j = 0; j != 6; ++j)
+            outside |= planes.sphereOutside(j, sphereCenters[i], radiusSquared);
+        visible[i] = !outside;
+        count += !outside;
+    }
+
+    return count;
+}
+
+template<class T> std::size_t spheresFrustumInto(const Corrade::Containers::ArrayView<const Vector3<T>> sphereCenters, const Corrade::Containers::ArrayView<const T> sphereRadii, const Frustum<T>& frustum, const Corrade::Containers::ArrayView<bool> visible, const Corrade::Containers::ArrayView<UnsignedByte> planeCache) {
+    CORRADE_ASSERT(sphereCenters.size() == sphereRadii.size() && sphereCenters.size() == visible.size() && sphereCenters.size() == planeCache.size(),
+        "Math::Geometry::Intersection::spheresFrustumInto(): expected" << sphereCenters.size() << "items in all views but got" << sphereRadii.size() << Corrade::Utility::Debug::nospace << "," << visible.size() << "and" << planeCache.size(), {});
+
+    const Implementation::FrustumPlanes<T> planes{frustum};
+    std::size_t count = 0;
+    for(std::size_t i = 0; i != sphereCenters.size(); ++i) {
+        const Vector3<T>& center = sphereCenters[i];
+        const T radiusSquared = sphereRadii[i]*sphereRadii[i];
+        const bool outside = Implementation::outsideCached(planeCache[i], [&](std::size_t j) {
+            return planes.sphereOutside(j, center, radiusSquared);
+        });
+        visible[i] = !outside;
+        count += !outside;
+    }
+
+    return count;
+}
+
+template<class T> std::size_t boxesFrustumInto(const Corrade::Containers::ArrayView<const Range3D<T>> boxes, const Frustum<T>& frustum, const Corrade::Containers::ArrayView<bool> visible) {
+    CORRADE_ASSERT(boxes.size() == visible.size(),
+        "Math::Geometry::Intersection::boxesFrustumInto(): expected" << boxes.size() << "items in the output view but got" << visible.size(), {});
+
+    const Implementation::FrustumPlanes<T> planes{frustum};
+    std::size_t count = 0;
+    for(std::size_t i = 0; i != boxes.size(); ++i) {
+        const Vector3<T> center = boxes[i].center();
+        const Vector3<T> halfSize = boxes[i].size()*T(0.5);
+        bool outside = false;
+        for(std::size_t j = 0; j != 6; ++j)
+            outside |= planes.boxOutside(j, center, halfSize);
+        visible[i] = !outside;
+        count += !outside;
+    }
+
+    return count;
+}
+
+template<class T> std::size_t boxesFrustumInto(const Corrade::Containers::ArrayView<const Range3D<T>> boxes, const Frustum<T>& frustum, const Corrade::Containers::ArrayView<bool> visible, const Corrade::Containers::ArrayView<UnsignedByte> planeCache) {
+    CORRADE_ASSERT(boxes.size() == visible.size() && boxes.size() == planeCache.size(),
+        "Math::Geometry::Intersection::boxesFrustumInto(): expected" << boxes.size() << "items in all views but got" << visible.size() << "and" << planeCache.size(), {});
+
+    const Implementation::FrustumPlanes<T> planes{frustum};
+    std::size_t count = 0;
+    for(std::size_t i = 0; i != boxes.size(); ++i) {
+        const Vector3<T> center = boxes[i].center();
+        const Vector3<T> halfSize = boxes[i].size()*T(0.5);
+        const bool outside = Implementation::outsideCached(planeCache[i], [&](std::size_t j) {
+            return planes.boxOutside(j, center, halfSize);
+        });
+        visible[i] = !outside;
+        count += !outside;
+    }
+
+    return count;
+}
+
 }}}}
 
 #endif
@@ -24,6 +24,7 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <sstream>
 #include <Corrade/TestSuite/Tester.h>
 
 #include "Magnum/Math/Geometry/Intersection.h"
@@ -38,6 +39,13 @@ struct IntersectionTest: Corrade::TestSuite::Tester {
 
     void pointFrustum();
     void boxFrustum();
+    void sphereFrustum();
+
+    void spheresFrustumArray();
+    void spheresFrustumArrayCached();
+    void boxesFrustumArray();
+    void boxesFrustumArrayCached();
+    void frustumArraySizeMismatch();
 };
 
 typedef Math::Vector2<Float> Vector2;
@@ -52,7 +60,14 @@ IntersectionTest::IntersectionTest() {
               &IntersectionTest::lineLine,
 
               &IntersectionTest::pointFrustum,
-              &IntersectionTest::boxFrustum});
+              &IntersectionTest::boxFrustum,
+              &IntersectionTest::sphereFrustum,
+
+              &IntersectionTest::spheresFrustumArray,
+              &IntersectionTest::spheresFrustumArrayCached,
+              &IntersectionTest::boxesFrustumArray,
+              &IntersectionTest::boxesFrustumArrayCached,
+              &IntersectionTest::frustumArraySizeMismatch});
 }
 
 void IntersectionTest::planeLine() {
@@ -140,6 +155,132 @@ void IntersectionTest::boxFrustum() {
     CORRADE_VERIFY(!Intersection::boxFrustum(Range3D{Vector3{-10.0f}, Vector3{-5.0f}}, frustum));
 }
 
+void IntersectionTest::sphereFrustum() {
+    /* Non-normalized planes to verify the distance gets scaled correctly */
+    const Frustum frustum{
+        {2.0f, 0.0f, 0.0f, 0.0f},
+        {-2.0f, 0.0f, 0.0f, 20.0f},
+        {0.0f, 1.0f, 0.0f, 0.0f},
+        {0.0f, -1.0f, 0.0f, 10.0f},
+        {0.0f, 0.0f, 1.0f, 0.0f},
+        {0.0f, 0.0f, -1.0f, 10.0f}};
+
+    /* Sphere inside */
+    CORRADE_VERIFY(Intersection::sphereFrustum({5.0f, 5.0f, 5.0f}, 1.0f, frustum));
+    /* Center outside, but the sphere overlaps */
+    CORRADE_VERIFY(Intersection::sphereFrustum({-1.5f, 5.0f, 5.0f}, 2.0f, frustum));
+    CORRADE_VERIFY(Intersection::sphereFrustum({11.5f, 5.0f, 5.0f}, 2.0f, frustum));
+    /* Bigger than frustum */
+    CORRADE_VERIFY(Intersection::sphereFrustum({5.0f, 5.0f, 5.0f}, 100.0f, frustum));
+    /* Outside of frustum */
+    CORRADE_VERIFY(!Intersection::sphereFrustum({-2.5f, 5.0f, 5.0f}, 2.0f, frustum));
+    CORRADE_VERIFY(!Intersection::sphereFrustum({12.5f, 5.0f, 5.0f}, 2.0f, frustum));
+    CORRADE_VERIFY(!Intersection::sphereFrustum({5.0f, 5.0f, 100.0f}, 1.0f, frustum));
+}
+
+namespace {
+    /* Non-normalized planes to verify the distance gets scaled correctly */
+    constexpr Frustum ArrayFrustum{
+        {2.0f, 0.0f, 0.0f, 0.0f},
+        {-2.0f, 0.0f, 0.0f, 20.0f},
+        {0.0f, 1.0f, 0.0f, 0.0f},
+        {0.0f, -1.0f, 0.0f, 10.0f},
+        {0.0f, 0.0f, 1.0f, 0.0f},
+        {0.0f, 0.0f, -1.0f, 10.0f}};
+
+    const Vector3 SphereCenters[]{
+        {5.0f, 5.0f, 5.0f},
+        {-1.5f, 5.0f, 5.0f},
+        {11.5f, 5.0f, 5.0f},
+        {5.0f, 5.0f, 5.0f},
+        {-2.5f, 5.0f, 5.0f},
+        {12.5f, 5.0f, 5.0f},
+        {5.0f, 5.0f, 100.0f}};
+    const Float SphereRadii[]{1.0f, 2.0f, 2.0f, 100.0f, 2.0f, 2.0f, 1.0f};
+
+    const Range3D Boxes[]{
+        {Vector3{1.0f}, Vector3{2.0f}},
+        {Vector3{-100.0f}, Vector3{100.0f}},
+        {Vector3{-10.0f}, Vector3{-5.0f}},
+        {Vector3{9.5f, 1.0f, 1.0f}, Vector3{10.5f, 2.0f, 2.0f}},
+        {Vector3{10.5f, 1.0f, 1.0f}, Vector3{11.5f, 2.0f, 2.0f}},
+        {Vector3{1.0f, 1.0f, 10.5f}, Vector3{2.0f, 2.0f, 11.5f}}};
+}
+
+void IntersectionTest::spheresFrustumArray() {
+    bool visible[7];
+    CORRADE_COMPARE(Intersection::spheresFrustumInto<Float>(SphereCenters, SphereRadii, ArrayFrustum, visible), 4);
+
+    for(std::size_t i = 0; i != 7; ++i)
+        CORRADE_COMPARE(visible[i], Intersection::sphereFrustum(SphereCenters[i], SphereRadii[i], ArrayFrustum));
+}
+
+void IntersectionTest::spheresFrustumArrayCached() {
+    /* Out-of-range values mean no information */
+    UnsignedByte cache[]{0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff};
+    bool visible[7];
+    CORRADE_COMPARE(Intersection::spheresFrustumInto<Float>(SphereCenters, SphereRadii, ArrayFrustum, visible, cache), 4);
+
+    for(std::size_t i = 0; i != 7; ++i)
+        CORRADE_COMPARE(visible[i], Intersection::sphereFrustum(SphereCenters[i], SphereRadii[i], ArrayFrustum));
+
+    /* The rejecting planes are remembered, visible spheres stay untouched */
+    CORRADE_COMPARE(cache[0], 0xff);
+    CORRADE_COMPARE(cache[4], 0);
+    CORRADE_COMPARE(cache[5], 1);
+    CORRADE_COMPARE(cache[6], 5);
+
+    /* Same result the second time, with a stale cache entry as well */
+    cache[0] = 3;
+    CORRADE_COMPARE(Intersection::spheresFrustumInto<Float>(SphereCenters, SphereRadii, ArrayFrustum, visible, cache), 4);
+    for(std::size_t i = 0; i != 7; ++i)
+        CORRADE_COMPARE(visible[i], Intersection::sphereFrustum(SphereCenters[i], SphereRadii[i], ArrayFrustum));
+    CORRADE_COMPARE(cache[0], 3);
+    CORRADE_COMPARE(cache[6], 5);
+}
+
+void IntersectionTest::boxesFrustumArray() {
+    bool visible[6];
+    CORRADE_COMPARE(Intersection::boxesFrustumInto<Float>(Boxes, ArrayFrustum, visible), 3);
+
+    for(std::size_t i = 0; i != 6; ++i)
+        CORRADE_COMPARE(visible[i], Intersection::boxFrustum(Boxes[i], ArrayFrustum));
+}
+
+void IntersectionTest::boxesFrustumArrayCached() {
+    UnsignedByte cache[]{0xff, 0xff, 0xff, 0xff, 0xff, 0xff};
+    bool visible[6];
+    CORRADE_COMPARE(Intersection::boxesFrustumInto<Float>(Boxes, ArrayFrustum, visible, cache), 3);
+
+    for(std::size_t i = 0; i != 6; ++i)
+        CORRADE_COMPARE(visible[i], Intersection::boxFrustum(Boxes[i], ArrayFrustum));
+
+    CORRADE_COMPARE(cache[2], 0);
+    CORRADE_COMPARE(cache[4], 1);
+    CORRADE_COMPARE(cache[5], 5);
+
+    CORRADE_COMPARE(Intersection::boxesFrustumInto<Float>(Boxes, ArrayFrustum, visible, cache), 3);
+    for(std::size_t i = 0; i != 6; ++i)
+        CORRADE_COMPARE(visible[i], Intersection::boxFrustum(Boxes[i], ArrayFrustum));
+}
+
+void IntersectionTest::frustumArraySizeMismatch() {
+    bool visible[3];
+    UnsignedByte cache[2];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Intersection::spheresFrustumInto<Float>({SphereCenters, 3}, {SphereRadii, 2}, ArrayFrustum, visible);
+    Intersection::spheresFrustumInto<Float>({SphereCenters, 3}, {SphereRadii, 3}, ArrayFrustum, visible, cache);
+    Intersection::boxesFrustumInto<Float>({Boxes, 2}, ArrayFrustum, visible);
+    Intersection::boxesFrustumInto<Float>({Boxes, 3}, ArrayFrustum, visible, cache);
+    CORRADE_COMPARE(out.str(),
+        "Math::Geometry::Intersection::spheresFrustumInto(): expected 3 items in all views but got 2 and 3\n"
+        "Math::Geometry::Intersection::spheresFrustumInto(): expected 3 items in all views but got 3, 3 and 2\n"
+        "Math::Geometry::Intersection::boxesFrustumInto(): expected 2 items in the output view but got 3\n"
+        "Math::Geometry::Intersection::boxesFrustumInto(): expected 3 items in all views but got 3 and 2\n");
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Math::Geometry::Test::IntersectionTest)
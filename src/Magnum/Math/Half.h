@@ -26,7 +26,7 @@
 */
 
 /** @file
- * @brief Class @ref Magnum::Math::Half, literal @link Magnum::Math::Literals::operator""_h() @endlink
+ * @brief Class @ref Magnum::Math::Half, literal @link Magnum::Math::Literals::operator""_h() @endlink, function @ref Magnum::Math::unpackHalfInto(Containers::ArrayView<const Vector2<Half>>, Containers::ArrayView<Vector2<Float>>), @ref Magnum::Math::packHalfInto(Containers::ArrayView<const Vector2<Float>>, Containers::ArrayView<Vector2<Half>>)
  */
 
 #include "Magnum/Math/Packing.h"
@@ -69,6 +69,25 @@ Debug{} << a;                                // prints {3.14159, -1.4142, 1.618}
 Debug{} << Math::Vector3<UnsignedShort>{a};  // prints {16968, 48552, 15993}
 @endcode
 
+The @ref Magnum::Vector2h, @ref Magnum::Vector3h, @ref Magnum::Vector4h,
+@ref Magnum::Color3h and @ref Magnum::Color4h typedefs are provided for
+storing vertex, animation or pixel data at half the memory. Whole arrays of
+them can be converted to and from 32-bit floats with
+@ref unpackHalfInto(Containers::ArrayView<const Vector3<Half>>, Containers::ArrayView<Vector3<Float>>)
+and @ref packHalfInto(Containers::ArrayView<const Vector3<Float>>, Containers::ArrayView<Vector3<Half>>)
+and such data can be used directly as vertex attributes with
+@ref Attribute::DataType::HalfFloat, for example:
+
+@code{.cpp}
+Containers::Array<Vector3h> positions{vertexCount};
+Math::packHalfInto(floatPositions, positions);
+
+Buffer buffer;
+buffer.setData(positions, BufferUsage::StaticDraw);
+mesh.addVertexBuffer(buffer, 0, Shaders::Phong::Position{
+    Shaders::Phong::Position::DataType::HalfFloat});
+@endcode
+
 @see @ref Magnum::Half
 */
 class Half {
@@ -162,6 +181,52 @@ inline Half operator "" _h(long double value) { return Half(Float(value)); }
 
 }
 
+/**
+@brief Unpack an array of half-float vectors into 32-bit float representation
+
+Equivalent to calling @ref unpackHalfInto(Containers::ArrayView<const UnsignedShort>, Containers::ArrayView<Float>)
+on all vector components, so the hardware conversion is used where available.
+Arrays of @ref Color3 / @ref Color4 can be passed to the
+@ref Vector3 / @ref Vector4 overloads. Expects that both views have the same
+size.
+@see @ref packHalfInto(Containers::ArrayView<const Vector2<Float>>, Containers::ArrayView<Vector2<Half>>)
+*/
+MAGNUM_EXPORT void unpackHalfInto(Corrade::Containers::ArrayView<const Vector2<Half>> in, Corrade::Containers::ArrayView<Vector2<Float>> out);
+
+/** @overload */
+MAGNUM_EXPORT void unpackHalfInto(Corrade::Containers::ArrayView<const Vector3<Half>> in, Corrade::Containers::ArrayView<Vector3<Float>> out);
+
+/** @overload */
+MAGNUM_EXPORT void unpackHalfInto(Corrade::Containers::ArrayView<const Vector4<Half>> in, Corrade::Containers::ArrayView<Vector4<Float>> out);
+
+/**
+@brief Pack an array of 32-bit float vectors into half-float representation
+
+Equivalent to calling @ref packHalfInto(Containers::ArrayView<const Float>, Containers::ArrayView<UnsignedShort>)
+on all vector components. Arrays of @ref Color3 / @ref Color4 can be passed to
+the @ref Vector3 / @ref Vector4 overloads. Expects that both views have the
+same size.
+@see @ref unpackHalfInto(Containers::ArrayView<const Vector2<Half>>, Containers::ArrayView<Vector2<Float>>)
+*/
+MAGNUM_EXPORT void packHalfInto(Corrade::Containers::ArrayView<const Vector2<Float>> in, Corrade::Containers::ArrayView<Vector2<Half>> out);
+
+/** @overload */
+MAGNUM_EXPORT void packHalfInto(Corrade::Containers::ArrayView<const Vector3<Float>> in, Corrade::Containers::ArrayView<Vector3<Half>> out);
+
+/** @overload */
+MAGNUM_EXPORT void packHalfInto(Corrade::Containers::ArrayView<const Vector4<Float>> in, Corrade::Containers::ArrayView<Vector4<Half>> out);
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+/* Half is a storage type with no arithmetic, so it has just the
+   floating-point type for conversions and a name. Needed to make Color3<Half>
+   and Color4<Half> usable. */
+template<> struct TypeTraits<Half>: Implementation::TypeTraitsDefault<Half> {
+    typedef Float FloatingPointType;
+
+    constexpr static const char* name() { return "Half"; }
+};
+#endif
+
 /** @debugoperator{Half} */
 inline Corrade::Utility::Debug& operator<<(Corrade::Utility::Debug& debug, Half value) {
     return debug << Float(value);
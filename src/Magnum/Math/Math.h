@@ -34,6 +34,49 @@
 
 #include "Magnum/Types.h"
 
+#ifdef DOXYGEN_GENERATING_OUTPUT
+/**
+@brief Enable SIMD implementation of hot math operations
+
+Not defined by the library itself. If defined before including any math
+header (preferably for the whole project using
+@cmake target_compile_definitions() @ce), multiplication of
+@ref Magnum::Math::Matrix4 "Matrix4<Float>" with matrices and vectors and
+multiplication of @ref Magnum::Math::Quaternion "Quaternion<Float>" (and thus
+also @ref Magnum::Math::DualQuaternion "DualQuaternion<Float>") is done using
+SSE or NEON intrinsics, if the target architecture supports them. The API and
+memory layout of all types stays the same and the operations are done in the
+same order as in the generic implementation. As the macro changes the
+generated inline code, it should be defined consistently for all translation
+units.
+@see @ref MAGNUM_MATH_SIMD_SSE, @ref MAGNUM_MATH_SIMD_NEON
+*/
+#define MAGNUM_MATH_SIMD
+#undef MAGNUM_MATH_SIMD
+
+/**
+@brief SSE math implementation
+
+Defined if @ref MAGNUM_MATH_SIMD is defined and the target supports SSE.
+*/
+#define MAGNUM_MATH_SIMD_SSE
+#undef MAGNUM_MATH_SIMD_SSE
+
+/**
+@brief NEON math implementation
+
+Defined if @ref MAGNUM_MATH_SIMD is defined and the target supports NEON.
+*/
+#define MAGNUM_MATH_SIMD_NEON
+#undef MAGNUM_MATH_SIMD_NEON
+#elif defined(MAGNUM_MATH_SIMD)
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define MAGNUM_MATH_SIMD_SSE
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define MAGNUM_MATH_SIMD_NEON
+#endif
+#endif
+
 namespace Magnum { namespace Math {
 
 /** @todo Denormals to zero */
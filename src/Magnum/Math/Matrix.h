@@ -35,6 +35,7 @@ namespace Magnum { namespace Math {
 
 namespace Implementation {
     template<std::size_t, class> struct MatrixDeterminant;
+    template<std::size_t, class> struct MatrixInverse;
 }
 
 /**
@@ -152,19 +153,48 @@ template<std::size_t size, class T> class Matrix: public RectangularMatrix<size,
          */
         T determinant() const { return Implementation::MatrixDeterminant<size, T>()(*this); }
 
+        /**
+         * @brief Matrix of cofactors
+         *
+         * A cofactor matrix @f$ C @f$ of a matrix @f$ A @f$ is defined as the
+         * following, with @f$ \mathcal{M}_{ij} @f$ being a determinant of a
+         * matrix without @f$ i @f$-th column and @f$ j @f$-th row, see
+         * @ref ij(): @f[
+         *      c_{ij} = (-1)^{i + j} \mathcal{M}_{ij}
+         * @f]
+         *
+         * For a 3x3 matrix the comatrix is equal to the inverse transpose
+         * multiplied by the determinant, which makes it a cheaper alternative
+         * for calculating normal matrices. See also
+         * @ref Matrix4::normalMatrix().
+         * @see @ref adjugate(), @ref inverted()
+         */
+        Matrix<size, T> comatrix() const;
+
+        /**
+         * @brief Adjugate matrix
+         *
+         * Transpose of @ref comatrix(), used for example to calculate an
+         * @ref inverted() matrix.
+         */
+        Matrix<size, T> adjugate() const;
+
         /**
          * @brief Inverted matrix
          *
          * Computed using Cramer's rule: @f[
          *      A^{-1} = \frac{1}{\det(A)} Adj(A)
          * @f]
-         * See @ref invertedOrthogonal(), @ref Matrix3::invertedRigid() and
-         * @ref Matrix4::invertedRigid() which are faster alternatives for
-         * particular matrix types.
+         * For 4x4 matrices the adjugate is calculated from shared 2x2
+         * subdeterminants using the Laplace expansion theorem instead of
+         * sixteen separate 3x3 determinants. See @ref invertedOrthogonal(),
+         * @ref Matrix3::invertedAffine(), @ref Matrix3::invertedRigid(),
+         * @ref Matrix4::invertedAffine() and @ref Matrix4::invertedRigid()
+         * which are faster alternatives for particular matrix types.
          * @see @ref Algorithms::gaussJordanInverted()
          * @m_keyword{inverse(),GLSL inverse(),}
          */
-        Matrix<size, T> inverted() const;
+        Matrix<size, T> inverted() const { return Implementation::MatrixInverse<size, T>()(*this); }
 
         /**
          * @brief Inverted orthogonal matrix
@@ -262,6 +292,8 @@ MAGNUM_MATRIX_OPERATOR_IMPLEMENTATION(Matrix<size, T>)
                                                                             \
     Type<T> transposed() const { return Matrix<size, T>::transposed(); }    \
     constexpr VectorType<T> diagonal() const { return Matrix<size, T>::diagonal(); } \
+    Type<T> comatrix() const { return Matrix<size, T>::comatrix(); }        \
+    Type<T> adjugate() const { return Matrix<size, T>::adjugate(); }        \
     Type<T> inverted() const { return Matrix<size, T>::inverted(); }        \
     Type<T> invertedOrthogonal() const {                                    \
         return Matrix<size, T>::invertedOrthogonal();                       \
@@ -282,6 +314,14 @@ template<std::size_t size, class T> T MatrixDeterminant<size, T>::operator()(con
     return out;
 }
 
+template<class T> struct MatrixDeterminant<3, T> {
+    constexpr T operator()(const Matrix<3, T>& m) const {
+        return m[0][0]*(m[1][1]*m[2][2] - m[2][1]*m[1][2]) -
+               m[1][0]*(m[0][1]*m[2][2] - m[2][1]*m[0][2]) +
+               m[2][0]*(m[0][1]*m[1][2] - m[1][1]*m[0][2]);
+    }
+};
+
 template<class T> struct MatrixDeterminant<2, T> {
     constexpr T operator()(const Matrix<2, T>& m) const {
         return m[0][0]*m[1][1] - m[1][0]*m[0][1];
@@ -294,6 +334,61 @@ template<class T> struct MatrixDeterminant<1, T> {
     }
 };
 
+template<std::size_t size, class T> struct MatrixInverse {
+    Matrix<size, T> operator()(const Matrix<size, T>& m) const {
+        Matrix<size, T> out{NoInit};
+
+        const T determinant = m.determinant();
+
+        for(std::size_t col = 0; col != size; ++col)
+            for(std::size_t row = 0; row != size; ++row)
+                out[col][row] = (((row+col) & 1) ? -1 : 1)*m.ij(row, col).determinant()/determinant;
+
+        return out;
+    }
+};
+
+/* The 3x3 minors share the 2x2 subdeterminants of the upper and lower half,
+   so calculate them just once. As (A^T)^-1 = (A^-1)^T, the same expansion
+   works regardless of whether it's operating on columns or rows. */
+template<class T> struct MatrixInverse<4, T> {
+    Matrix<4, T> operator()(const Matrix<4, T>& a) const {
+        const T s0 = a[0][0]*a[1][1] - a[1][0]*a[0][1];
+        const T s1 = a[0][0]*a[1][2] - a[1][0]*a[0][2];
+        const T s2 = a[0][0]*a[1][3] - a[1][0]*a[0][3];
+        const T s3 = a[0][1]*a[1][2] - a[1][1]*a[0][2];
+        const T s4 = a[0][1]*a[1][3] - a[1][1]*a[0][3];
+        const T s5 = a[0][2]*a[1][3] - a[1][2]*a[0][3];
+
+        const T c5 = a[2][2]*a[3][3] - a[3][2]*a[2][3];
+        const T c4 = a[2][1]*a[3][3] - a[3][1]*a[2][3];
+        const T c3 = a[2][1]*a[3][2] - a[3][1]*a[2][2];
+        const T c2 = a[2][0]*a[3][3] - a[3][0]*a[2][3];
+        const T c1 = a[2][0]*a[3][2] - a[3][0]*a[2][2];
+        const T c0 = a[2][0]*a[3][1] - a[3][0]*a[2][1];
+
+        const T invDeterminant = T(1)/(s0*c5 - s1*c4 + s2*c3 + s3*c2 - s4*c1 + s5*c0);
+
+        return {
+            Vector<4, T>{( a[1][1]*c5 - a[1][2]*c4 + a[1][3]*c3),
+                         (-a[0][1]*c5 + a[0][2]*c4 - a[0][3]*c3),
+                         ( a[3][1]*s5 - a[3][2]*s4 + a[3][3]*s3),
+                         (-a[2][1]*s5 + a[2][2]*s4 - a[2][3]*s3)}*invDeterminant,
+            Vector<4, T>{(-a[1][0]*c5 + a[1][2]*c2 - a[1][3]*c1),
+                         ( a[0][0]*c5 - a[0][2]*c2 + a[0][3]*c1),
+                         (-a[3][0]*s5 + a[3][2]*s2 - a[3][3]*s1),
+                         ( a[2][0]*s5 - a[2][2]*s2 + a[2][3]*s1)}*invDeterminant,
+            Vector<4, T>{( a[1][0]*c4 - a[1][1]*c2 + a[1][3]*c0),
+                         (-a[0][0]*c4 + a[0][1]*c2 - a[0][3]*c0),
+                         ( a[3][0]*s4 - a[3][1]*s2 + a[3][3]*s0),
+                         (-a[2][0]*s4 + a[2][1]*s2 - a[2][3]*s0)}*invDeterminant,
+            Vector<4, T>{(-a[1][0]*c3 + a[1][1]*c1 - a[1][2]*c0),
+                         ( a[0][0]*c3 - a[0][1]*c1 + a[0][2]*c0),
+                         (-a[3][0]*s3 + a[3][1]*s1 - a[3][2]*s0),
+                         ( a[2][0]*s3 - a[2][1]*s1 + a[2][2]*s0)}*invDeterminant};
+    }
+};
+
 }
 #endif
 
@@ -322,14 +417,22 @@ template<std::size_t size, class T> Matrix<size-1, T> Matrix<size, T>::ij(const
     return out;
 }
 
-template<std::size_t size, class T> Matrix<size, T> Matrix<size, T>::inverted() const {
+template<std::size_t size, class T> Matrix<size, T> Matrix<size, T>::comatrix() const {
     Matrix<size, T> out{NoInit};
 
-    const T _determinant = determinant();
+    for(std::size_t col = 0; col != size; ++col)
+        for(std::size_t row = 0; row != size; ++row)
+            out[col][row] = (((row+col) & 1) ? -1 : 1)*ij(col, row).determinant();
+
+    return out;
+}
+
+template<std::size_t size, class T> Matrix<size, T> Matrix<size, T>::adjugate() const {
+    Matrix<size, T> out{NoInit};
 
     for(std::size_t col = 0; col != size; ++col)
         for(std::size_t row = 0; row != size; ++row)
-            out[col][row] = (((row+col) & 1) ? -1 : 1)*ij(row, col).determinant()/_determinant;
+            out[col][row] = (((row+col) & 1) ? -1 : 1)*ij(row, col).determinant();
 
     return out;
 }
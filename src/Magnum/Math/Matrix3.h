@@ -177,8 +177,10 @@ template<class T> class Matrix3: public Matrix3x3<T> {
          *      @ref Matrix4::perspectiveProjection()
          * @m_keywords{gluOrtho2D()}
          */
-        static Matrix3<T> projection(const Vector2<T>& size) {
-            return scaling(2.0f/size);
+        constexpr static Matrix3<T> projection(const Vector2<T>& size) {
+            return {{T(2)/size.x(),          T(0), T(0)},
+                    {         T(0), T(2)/size.y(), T(0)},
+                    {         T(0),          T(0), T(1)}};
         }
 
         /**
@@ -376,6 +378,23 @@ template<class T> class Matrix3: public Matrix3x3<T> {
          */
         Matrix3<T> invertedRigid() const;
 
+        /**
+         * @brief Inverted affine transformation matrix
+         *
+         * Expects that the last row is @f$ (0, \cdots, 0, 1) @f$, i.e. the
+         * matrix doesn't contain any projection. Faster than the general
+         * algorithm in @ref inverted(), as only the upper-left 2x2 part
+         * needs to be inverted, but unlike @ref invertedRigid() works
+         * also for matrices with non-uniform scaling and shear. @f[
+         *      A^{-1} = \begin{pmatrix} (A^{2,2})^{-1} & (A^{2,2})^{-1} \begin{pmatrix} -a_{2,0} \\ -a_{2,1} \end{pmatrix} \\ \begin{array}{cc} 0 & 0 \end{array} & 1 \end{pmatrix}
+         * @f]
+         * @f$ A^{i, j} @f$ is matrix without i-th row and j-th column, see
+         * @ref ij()
+         * @see @ref rotationScaling(), @ref translation() const,
+         *      @ref Matrix4::invertedAffine()
+         */
+        Matrix3<T> invertedAffine() const;
+
         /**
          * @brief Transform 2D vector with the matrix
          *
@@ -422,6 +441,14 @@ template<class T> Matrix3<T> Matrix3<T>::rotation(const Rad<T> angle) {
             {   T(0),   T(0), T(1)}};
 }
 
+template<class T> inline Matrix3<T> Matrix3<T>::invertedAffine() const {
+    CORRADE_ASSERT(this->row(2) == Vector3<T>(T(0), T(0), T(1)),
+        "Math::Matrix3::invertedAffine(): the matrix doesn't represent affine transformation", {});
+
+    const Matrix2x2<T> inverseRotationScaling = rotationScaling().inverted();
+    return from(inverseRotationScaling, inverseRotationScaling*-translation());
+}
+
 template<class T> inline Matrix3<T> Matrix3<T>::invertedRigid() const {
     CORRADE_ASSERT(isRigidTransformation(),
         "Math::Matrix3::invertedRigid(): the matrix doesn't represent rigid transformation", {});
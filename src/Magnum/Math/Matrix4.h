@@ -274,7 +274,12 @@ template<class T> class Matrix4: public Matrix4x4<T> {
          * @see @ref perspectiveProjection(), @ref Matrix3::projection()
          * @m_keywords{gluOrtho()}
          */
-        static Matrix4<T> orthographicProjection(const Vector2<T>& size, T near, T far);
+        constexpr static Matrix4<T> orthographicProjection(const Vector2<T>& size, T near, T far) {
+            return {{T(2)/size.x(),          T(0),                            T(0), T(0)},
+                    {         T(0), T(2)/size.y(),                            T(0), T(0)},
+                    {         T(0),          T(0),               T(2)/(near - far), T(0)},
+                    {         T(0),          T(0), near*(T(2)/(near - far)) - T(1), T(1)}};
+        }
 
         /**
          * @brief 3D perspective projection matrix
@@ -303,7 +308,17 @@ template<class T> class Matrix4: public Matrix4x4<T> {
          *      @ref Constants::inf()
          * @m_keywords{gluPerspective()}
          */
-        static Matrix4<T> perspectiveProjection(const Vector2<T>& size, T near, T far);
+        constexpr static Matrix4<T> perspectiveProjection(const Vector2<T>& size, T near, T far) {
+            return far == Constants<T>::inf() ?
+                Matrix4<T>{{T(2)*near/size.x(),               T(0),       T(0),  T(0)},
+                           {              T(0), T(2)*near/size.y(),       T(0),  T(0)},
+                           {              T(0),               T(0),      T(-1), T(-1)},
+                           {              T(0),               T(0), T(-2)*near,  T(0)}} :
+                Matrix4<T>{{T(2)*near/size.x(),               T(0),                                  T(0),  T(0)},
+                           {              T(0), T(2)*near/size.y(),                                  T(0),  T(0)},
+                           {              T(0),               T(0),      (far + near)*(T(1)/(near - far)), T(-1)},
+                           {              T(0),               T(0), T(2)*far*near*(T(1)/(near - far)),  T(0)}};
+        }
 
         /**
          * @brief 3D perspective projection matrix
@@ -553,6 +568,40 @@ template<class T> class Matrix4: public Matrix4x4<T> {
          */
         Matrix4<T> invertedRigid() const;
 
+        /**
+         * @brief Inverted affine transformation matrix
+         *
+         * Expects that the last row is @f$ (0, \cdots, 0, 1) @f$, i.e. the
+         * matrix doesn't contain any projection. Faster than the general
+         * algorithm in @ref inverted(), as only the upper-left 3x3 part
+         * needs to be inverted, but unlike @ref invertedRigid() works
+         * also for matrices with non-uniform scaling and shear. @f[
+         *      A^{-1} = \begin{pmatrix} (A^{3,3})^{-1} & (A^{3,3})^{-1} \begin{pmatrix} -a_{3,0} \\ -a_{3,1} \\ -a_{3,2} \\ \end{pmatrix} \\ \begin{array}{ccc} 0 & 0 & 0 \end{array} & 1 \end{pmatrix}
+         * @f]
+         * @f$ A^{i, j} @f$ is matrix without i-th row and j-th column, see
+         * @ref ij()
+         * @see @ref rotationScaling(), @ref translation() const,
+         *      @ref Matrix3::invertedAffine()
+         */
+        Matrix4<T> invertedAffine() const;
+
+        /**
+         * @brief Normal matrix
+         *
+         * Matrix for transforming normals, equivalent to an inverse transpose
+         * of @ref rotationScaling(), but calculated as its
+         * @ref comatrix() instead, which is significantly cheaper. The
+         * result differs from the inverse transpose by the (absolute value of
+         * the) determinant, so the transformed normals need to be
+         * renormalized, which is usually done anyway. The sign is adjusted so
+         * normals point the right way also for transformations that flip the
+         * handedness. @f[
+         *      N = \operatorname{sign}(\det(A^{3,3})) C(A^{3,3})
+         * @f]
+         * @see @ref rotation() const, @ref invertedAffine()
+         */
+        Matrix3x3<T> normalMatrix() const;
+
         /**
          * @brief Transform 3D vector with the matrix
          *
@@ -659,33 +708,6 @@ template<class T> Matrix4<T> Matrix4<T>::reflection(const Vector3<T>& normal) {
     return from(Matrix3x3<T>() - T(2)*normal*RectangularMatrix<1, 3, T>(normal).transposed(), {});
 }
 
-template<class T> Matrix4<T> Matrix4<T>::orthographicProjection(const Vector2<T>& size, const T near, const T far) {
-    const Vector2<T> xyScale = T(2.0)/size;
-    const T zScale = T(2.0)/(near-far);
-
-    return {{xyScale.x(),        T(0),             T(0), T(0)},
-            {       T(0), xyScale.y(),             T(0), T(0)},
-            {       T(0),        T(0),           zScale, T(0)},
-            {       T(0),        T(0), near*zScale-T(1), T(1)}};
-}
-
-template<class T> Matrix4<T> Matrix4<T>::perspectiveProjection(const Vector2<T>& size, const T near, const T far) {
-    const Vector2<T> xyScale = 2*near/size;
-
-    if(far == Constants<T>::inf()) {
-        return {{xyScale.x(),        T(0),                 T(0),  T(0)},
-                {       T(0), xyScale.y(),                 T(0),  T(0)},
-                {       T(0),        T(0),                T(-1), T(-1)},
-                {       T(0),        T(0),           T(-2)*near,  T(0)}};
-    } else {
-        const T zScale = T(1.0)/(near-far);
-        return {{xyScale.x(),        T(0),                 T(0),  T(0)},
-                {       T(0), xyScale.y(),                 T(0),  T(0)},
-                {       T(0),        T(0),    (far+near)*zScale, T(-1)},
-                {       T(0),        T(0), T(2)*far*near*zScale,  T(0)}};
-    }
-}
-
 template<class T> Matrix4<T> Matrix4<T>::lookAt(const Vector3<T>& eye, const Vector3<T>& target, const Vector3<T>& up) {
     const Vector3<T> backward = (eye - target).normalized();
     const Vector3<T> right = cross(up, backward).normalized();
@@ -710,6 +732,21 @@ template<class T> T Matrix4<T>::uniformScalingSquared() const {
     return scalingSquared;
 }
 
+template<class T> Matrix4<T> Matrix4<T>::invertedAffine() const {
+    CORRADE_ASSERT(this->row(3) == Vector4<T>(T(0), T(0), T(0), T(1)),
+        "Math::Matrix4::invertedAffine(): the matrix doesn't represent affine transformation", {});
+
+    const Matrix3x3<T> inverseRotationScaling = rotationScaling().inverted();
+    return from(inverseRotationScaling, inverseRotationScaling*-translation());
+}
+
+template<class T> Matrix3x3<T> Matrix4<T>::normalMatrix() const {
+    const Matrix3x3<T> cofactors = rotationScaling().comatrix();
+
+    /* Determinant is a dot product of any column with its cofactors */
+    return dot((*this)[0].xyz(), cofactors[0]) < T(0) ? -cofactors : cofactors;
+}
+
 template<class T> Matrix4<T> Matrix4<T>::invertedRigid() const {
     CORRADE_ASSERT(isRigidTransformation(),
         "Math::Matrix4::invertedRigid(): the matrix doesn't represent rigid transformation", {});
@@ -25,6 +25,19 @@
 
 #include "Packing.h"
 
+#include <cstring>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Math/Half.h"
+#include "Magnum/Math/Vector4.h"
+
+#if defined(__F16C__)
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
 namespace Magnum { namespace Math {
 
 namespace {
@@ -101,4 +114,132 @@ UnsignedShort packHalf(const Float value) {
     return h;
 }
 
+template<class Integral> void unpackInto(const Corrade::Containers::ArrayView<const Integral> in, const Corrade::Containers::ArrayView<Float> out) {
+    CORRADE_ASSERT(in.size() == out.size(),
+        "Math::unpackInto(): expected output size" << in.size() << "but got" << out.size(), );
+
+    /* Pointers instead of views so the compiler sees through the loop */
+    const Integral* const src = in.data();
+    Float* const dst = out.data();
+    for(std::size_t i = 0; i != in.size(); ++i)
+        dst[i] = unpack<Float, Integral>(src[i]);
+}
+
+template<class Integral> void packInto(const Corrade::Containers::ArrayView<const Float> in, const Corrade::Containers::ArrayView<Integral> out) {
+    CORRADE_ASSERT(in.size() == out.size(),
+        "Math::packInto(): expected output size" << in.size() << "but got" << out.size(), );
+
+    const Float* const src = in.data();
+    Integral* const dst = out.data();
+    for(std::size_t i = 0; i != in.size(); ++i)
+        dst[i] = pack<Integral, Float>(src[i]);
+}
+
+namespace {
+
+#if defined(__F16C__)
+constexpr std::size_t HalfBatch = 8;
+
+inline void unpackHalfBatch(const UnsignedShort* const in, Float* const out) {
+    _mm256_storeu_ps(out, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in))));
+}
+
+inline void packHalfBatch(const Float* const in, UnsignedShort* const out) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm256_cvtps_ph(_mm256_loadu_ps(in), _MM_FROUND_TO_NEAREST_INT));
+}
+#elif defined(__aarch64__)
+constexpr std::size_t HalfBatch = 4;
+
+inline void unpackHalfBatch(const UnsignedShort* const in, Float* const out) {
+    vst1q_f32(out, vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(in))));
+}
+
+inline void packHalfBatch(const Float* const in, UnsignedShort* const out) {
+    vst1_u16(out, vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(in))));
+}
+#endif
+
+}
+
+void unpackHalfInto(const Corrade::Containers::ArrayView<const UnsignedShort> in, const Corrade::Containers::ArrayView<Float> out) {
+    CORRADE_ASSERT(in.size() == out.size(),
+        "Math::unpackHalfInto(): expected output size" << in.size() << "but got" << out.size(), );
+
+    #if defined(__F16C__) || defined(__aarch64__)
+    std::size_t i = 0;
+    for(; i + HalfBatch <= in.size(); i += HalfBatch)
+        unpackHalfBatch(in.data() + i, out.data() + i);
+
+    /* Convert the remainder through a padded temporary so all values go
+       through the same code path */
+    if(i != in.size()) {
+        UnsignedShort src[HalfBatch]{};
+        Float dst[HalfBatch];
+        std::memcpy(src, in.data() + i, (in.size() - i)*sizeof(UnsignedShort));
+        unpackHalfBatch(src, dst);
+        std::memcpy(out.data() + i, dst, (in.size() - i)*sizeof(Float));
+    }
+    #else
+    for(std::size_t i = 0; i != in.size(); ++i)
+        out[i] = unpackHalf(in[i]);
+    #endif
+}
+
+void packHalfInto(const Corrade::Containers::ArrayView<const Float> in, const Corrade::Containers::ArrayView<UnsignedShort> out) {
+    CORRADE_ASSERT(in.size() == out.size(),
+        "Math::packHalfInto(): expected output size" << in.size() << "but got" << out.size(), );
+
+    #if defined(__F16C__) || defined(__aarch64__)
+    std::size_t i = 0;
+    for(; i + HalfBatch <= in.size(); i += HalfBatch)
+        packHalfBatch(in.data() + i, out.data() + i);
+
+    if(i != in.size()) {
+        Float src[HalfBatch]{};
+        UnsignedShort dst[HalfBatch];
+        std::memcpy(src, in.data() + i, (in.size() - i)*sizeof(Float));
+        packHalfBatch(src, dst);
+        std::memcpy(out.data() + i, dst, (in.size() - i)*sizeof(UnsignedShort));
+    }
+    #else
+    for(std::size_t i = 0; i != in.size(); ++i)
+        out[i] = packHalf(in[i]);
+    #endif
+}
+
+/* The vector variants are just the scalar variants operating on all
+   components, the types are standard-layout so the cast is safe */
+void unpackHalfInto(const Corrade::Containers::ArrayView<const Vector2<Half>> in, const Corrade::Containers::ArrayView<Vector2<Float>> out) {
+    unpackHalfInto(Corrade::Containers::arrayCast<const UnsignedShort>(in), Corrade::Containers::arrayCast<Float>(out));
+}
+
+void unpackHalfInto(const Corrade::Containers::ArrayView<const Vector3<Half>> in, const Corrade::Containers::ArrayView<Vector3<Float>> out) {
+    unpackHalfInto(Corrade::Containers::arrayCast<const UnsignedShort>(in), Corrade::Containers::arrayCast<Float>(out));
+}
+
+void unpackHalfInto(const Corrade::Containers::ArrayView<const Vector4<Half>> in, const Corrade::Containers::ArrayView<Vector4<Float>> out) {
+    unpackHalfInto(Corrade::Containers::arrayCast<const UnsignedShort>(in), Corrade::Containers::arrayCast<Float>(out));
+}
+
+void packHalfInto(const Corrade::Containers::ArrayView<const Vector2<Float>> in, const Corrade::Containers::ArrayView<Vector2<Half>> out) {
+    packHalfInto(Corrade::Containers::arrayCast<const Float>(in), Corrade::Containers::arrayCast<UnsignedShort>(out));
+}
+
+void packHalfInto(const Corrade::Containers::ArrayView<const Vector3<Float>> in, const Corrade::Containers::ArrayView<Vector3<Half>> out) {
+    packHalfInto(Corrade::Containers::arrayCast<const Float>(in), Corrade::Containers::arrayCast<UnsignedShort>(out));
+}
+
+void packHalfInto(const Corrade::Containers::ArrayView<const Vector4<Float>> in, const Corrade::Containers::ArrayView<Vector4<Half>> out) {
+    packHalfInto(Corrade::Containers::arrayCast<const Float>(in), Corrade::Containers::arrayCast<UnsignedShort>(out));
+}
+
+template void unpackInto<UnsignedByte>(Corrade::Containers::ArrayView<const UnsignedByte>, Corrade::Containers::ArrayView<Float>);
+template void unpackInto<Byte>(Corrade::Containers::ArrayView<const Byte>, Corrade::Containers::ArrayView<Float>);
+template void unpackInto<UnsignedShort>(Corrade::Containers::ArrayView<const UnsignedShort>, Corrade::Containers::ArrayView<Float>);
+template void unpackInto<Short>(Corrade::Containers::ArrayView<const Short>, Corrade::Containers::ArrayView<Float>);
+template void packInto<UnsignedByte>(Corrade::Containers::ArrayView<const Float>, Corrade::Containers::ArrayView<UnsignedByte>);
+template void packInto<Byte>(Corrade::Containers::ArrayView<const Float>, Corrade::Containers::ArrayView<Byte>);
+template void packInto<UnsignedShort>(Corrade::Containers::ArrayView<const Float>, Corrade::Containers::ArrayView<UnsignedShort>);
+template void packInto<Short>(Corrade::Containers::ArrayView<const Float>, Corrade::Containers::ArrayView<Short>);
+
 }}
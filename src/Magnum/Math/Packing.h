@@ -26,9 +26,11 @@
 */
 
 /** @file
- * @brief Functions @ref Magnum::Math::pack(), @ref Magnum::Math::unpack(), @ref Magnum::Math::packHalf(), @ref Magnum::Math::unpackHalf()
+ * @brief Functions @ref Magnum::Math::pack(), @ref Magnum::Math::unpack(), @ref Magnum::Math::packHalf(), @ref Magnum::Math::unpackHalf(), @ref Magnum::Math::packInto(), @ref Magnum::Math::unpackInto(), @ref Magnum::Math::packHalfInto(), @ref Magnum::Math::unpackHalfInto()
  */
 
+#include <Corrade/Containers/ArrayView.h>
+
 #include "Magnum/Math/Functions.h"
 
 namespace Magnum { namespace Math {
@@ -241,6 +243,70 @@ template<std::size_t size> Vector<size, Float> unpackHalf(const Vector<size, Uns
     return out;
 }
 
+/**
+@brief Unpack an array of integral values into a floating-point representation
+@param[in] in   Integral values
+@param[out] out Where to put the floating-point values
+
+Equivalent to calling @ref unpack() on each item, but written so the compiler
+can vectorize the conversion. The @p Integral type can be
+@ref Magnum::UnsignedByte "UnsignedByte", @ref Magnum::Byte "Byte",
+@ref Magnum::UnsignedShort "UnsignedShort" or @ref Magnum::Short "Short".
+Vector or pixel data can be converted by casting them to an array of
+components first using @ref Corrade::Containers::arrayCast(). Expects that
+both views have the same size.
+@see @ref packInto(), @ref unpackHalfInto()
+*/
+template<class Integral> MAGNUM_EXPORT void unpackInto(Corrade::Containers::ArrayView<const Integral> in, Corrade::Containers::ArrayView<Float> out);
+
+/**
+@brief Pack an array of floating-point values into an integer representation
+@param[in] in   Floating-point values
+@param[out] out Where to put the integral values
+
+Equivalent to calling @ref pack() on each item, but written so the compiler can
+vectorize the conversion. Supported types and requirements are the same as in
+@ref unpackInto(); similarly to @ref pack() the result for values outside of
+the normalized range is undefined.
+*/
+template<class Integral> MAGNUM_EXPORT void packInto(Corrade::Containers::ArrayView<const Float> in, Corrade::Containers::ArrayView<Integral> out);
+
+/**
+@brief Unpack an array of half-float values into 32-bit float representation
+@param[in] in   Half-float values
+@param[out] out Where to put the 32-bit float values
+
+Equivalent to calling @ref unpackHalf() on each item. If the library is built
+for a CPU with the F16C instruction set (e.g. with `-mf16c` or `-march=native`
+on x86) or for ARM64, hardware conversion instructions are used for eight or
+four values at a time. Expects that both views have the same size.
+@see @ref packHalfInto()
+*/
+MAGNUM_EXPORT void unpackHalfInto(Corrade::Containers::ArrayView<const UnsignedShort> in, Corrade::Containers::ArrayView<Float> out);
+
+/**
+@brief Pack an array of 32-bit float values into half-float representation
+@param[in] in   32-bit float values
+@param[out] out Where to put the half-float values
+
+Equivalent to calling @ref packHalf() on each item, with hardware conversion
+used under the same conditions as in @ref unpackHalfInto(). Similarly to
+@ref packHalf(), the rounding mode is unspecified and may differ between the
+scalar and hardware implementation. Expects that both views have the same size.
+*/
+MAGNUM_EXPORT void packHalfInto(Corrade::Containers::ArrayView<const Float> in, Corrade::Containers::ArrayView<UnsignedShort> out);
+
+#if defined(CORRADE_TARGET_WINDOWS) && !defined(__MINGW32__)
+extern template MAGNUM_EXPORT void unpackInto<UnsignedByte>(Corrade::Containers::ArrayView<const UnsignedByte>, Corrade::Containers::ArrayView<Float>);
+extern template MAGNUM_EXPORT void unpackInto<Byte>(Corrade::Containers::ArrayView<const Byte>, Corrade::Containers::ArrayView<Float>);
+extern template MAGNUM_EXPORT void unpackInto<UnsignedShort>(Corrade::Containers::ArrayView<const UnsignedShort>, Corrade::Containers::ArrayView<Float>);
+extern template MAGNUM_EXPORT void unpackInto<Short>(Corrade::Containers::ArrayView<const Short>, Corrade::Containers::ArrayView<Float>);
+extern template MAGNUM_EXPORT void packInto<UnsignedByte>(Corrade::Containers::ArrayView<const Float>, Corrade::Containers::ArrayView<UnsignedByte>);
+extern template MAGNUM_EXPORT void packInto<Byte>(Corrade::Containers::ArrayView<const Float>, Corrade::Containers::ArrayView<Byte>);
+extern template MAGNUM_EXPORT void packInto<UnsignedShort>(Corrade::Containers::ArrayView<const Float>, Corrade::Containers::ArrayView<UnsignedShort>);
+extern template MAGNUM_EXPORT void packInto<Short>(Corrade::Containers::ArrayView<const Float>, Corrade::Containers::ArrayView<Short>);
+#endif
+
 }}
 
 #endif
@@ -290,8 +290,8 @@ template<class T> class Quaternion {
          *
          * @see @ref operator+=()
          */
-        Quaternion<T> operator+(const Quaternion<T>& other) const {
-            return Quaternion<T>(*this) += other;
+        constexpr Quaternion<T> operator+(const Quaternion<T>& other) const {
+            return {{_vector.x() + other._vector.x(), _vector.y() + other._vector.y(), _vector.z() + other._vector.z()}, _scalar + other._scalar};
         }
 
         /**
@@ -301,7 +301,9 @@ template<class T> class Quaternion {
          *      -q = [-\boldsymbol q_V, -q_S]
          * @f]
          */
-        Quaternion<T> operator-() const { return {-_vector, -_scalar}; }
+        constexpr Quaternion<T> operator-() const {
+            return {{-_vector.x(), -_vector.y(), -_vector.z()}, -_scalar};
+        }
 
         /**
          * @brief Subtract and assign quaternion
@@ -321,8 +323,8 @@ template<class T> class Quaternion {
          *
          * @see @ref operator-=()
          */
-        Quaternion<T> operator-(const Quaternion<T>& other) const {
-            return Quaternion<T>(*this) -= other;
+        constexpr Quaternion<T> operator-(const Quaternion<T>& other) const {
+            return {{_vector.x() - other._vector.x(), _vector.y() - other._vector.y(), _vector.z() - other._vector.z()}, _scalar - other._scalar};
         }
 
         /**
@@ -343,8 +345,8 @@ template<class T> class Quaternion {
          *
          * @see @ref operator*=(T)
          */
-        Quaternion<T> operator*(T scalar) const {
-            return Quaternion<T>(*this) *= scalar;
+        constexpr Quaternion<T> operator*(T scalar) const {
+            return {{_vector.x()*scalar, _vector.y()*scalar, _vector.z()*scalar}, _scalar*scalar};
         }
 
         /**
@@ -365,8 +367,8 @@ template<class T> class Quaternion {
          *
          * @see @ref operator/=(T)
          */
-        Quaternion<T> operator/(T scalar) const {
-            return Quaternion<T>(*this) /= scalar;
+        constexpr Quaternion<T> operator/(T scalar) const {
+            return {{_vector.x()/scalar, _vector.y()/scalar, _vector.z()/scalar}, _scalar/scalar};
         }
 
         /**
@@ -417,7 +419,9 @@ template<class T> class Quaternion {
          *      q^* = [-\boldsymbol q_V, q_S]
          * @f]
          */
-        Quaternion<T> conjugated() const { return {-_vector, _scalar}; }
+        constexpr Quaternion<T> conjugated() const {
+            return {{-_vector.x(), -_vector.y(), -_vector.z()}, _scalar};
+        }
 
         /**
          * @brief Inverted quaternion
@@ -601,6 +605,43 @@ template<class T> inline Quaternion<T> Quaternion<T>::operator*(const Quaternion
             _scalar*other._scalar - Math::dot(_vector, other._vector)};
 }
 
+#if defined(MAGNUM_MATH_SIMD_SSE) || defined(MAGNUM_MATH_SIMD_NEON)
+/* The vector part is calculated in the same order as above, the fourth lane
+   is ignored and the scalar part is calculated separately */
+template<> inline Quaternion<Float> Quaternion<Float>::operator*(const Quaternion<Float>& other) const {
+    const Float a[]{_vector.x(), _vector.y(), _vector.z(), _scalar};
+    const Float b[]{other._vector.x(), other._vector.y(), other._vector.z(), other._scalar};
+    Float out[4];
+
+    #ifdef MAGNUM_MATH_SIMD_SSE
+    const __m128 va = _mm_loadu_ps(a);
+    const __m128 vb = _mm_loadu_ps(b);
+    const __m128 yzxA = _mm_shuffle_ps(va, va, _MM_SHUFFLE(3, 0, 2, 1));
+    const __m128 yzxB = _mm_shuffle_ps(vb, vb, _MM_SHUFFLE(3, 0, 2, 1));
+    const __m128 cross = _mm_sub_ps(_mm_mul_ps(va, yzxB), _mm_mul_ps(vb, yzxA));
+    const __m128 r = _mm_add_ps(
+        _mm_add_ps(_mm_mul_ps(_mm_set1_ps(_scalar), vb), _mm_mul_ps(_mm_set1_ps(other._scalar), va)),
+        _mm_shuffle_ps(cross, cross, _MM_SHUFFLE(3, 0, 2, 1)));
+    _mm_storeu_ps(out, r);
+    #else
+    const float32x4_t va = vld1q_f32(a);
+    const float32x4_t vb = vld1q_f32(b);
+    /* (y, z, x, *) swizzle, NEON has no generic shuffle */
+    const float32x4_t yzxA = vsetq_lane_f32(a[0], vextq_f32(va, va, 1), 2);
+    const float32x4_t yzxB = vsetq_lane_f32(b[0], vextq_f32(vb, vb, 1), 2);
+    const float32x4_t cross = vsubq_f32(vmulq_f32(va, yzxB), vmulq_f32(vb, yzxA));
+    const float32x4_t yzxCross = vsetq_lane_f32(vgetq_lane_f32(cross, 0), vextq_f32(cross, cross, 1), 2);
+    const float32x4_t r = vaddq_f32(
+        vaddq_f32(vmulq_n_f32(vb, _scalar), vmulq_n_f32(va, other._scalar)),
+        yzxCross);
+    vst1q_f32(out, r);
+    #endif
+
+    return {{out[0], out[1], out[2]},
+            _scalar*other._scalar - Math::dot(_vector, other._vector)};
+}
+#endif
+
 template<class T> inline Quaternion<T> Quaternion<T>::invertedNormalized() const {
     CORRADE_ASSERT(isNormalized(), "Math::Quaternion::invertedNormalized(): quaternion must be normalized", {});
     return conjugated();
@@ -540,6 +540,18 @@ template<UnsignedInt dimensions, class T> inline Range<dimensions, T> join(const
     return {min(a.min(), b.min()), max(a.max(), b.max())};
 }
 
+/** @relatesalso Range
+@brief Whether two ranges intersect
+
+Returns @cpp true @ce if the ranges have a non-empty intersection. Same as
+with @ref Range::contains(), the maximal coordinate is not considered to be a
+part of the range, so ranges that only touch each other don't intersect.
+@see @ref intersectsInto()
+*/
+template<UnsignedInt dimensions, class T> inline bool intersects(const Range<dimensions, T>& a, const Range<dimensions, T>& b) {
+    return (a.max() > b.min()).all() && (a.min() < b.max()).all();
+}
+
 /** @debugoperator{Range} */
 template<UnsignedInt dimensions, class T> Corrade::Utility::Debug& operator<<(Corrade::Utility::Debug& debug, const Range<dimensions, T>& value) {
     debug << "Range({" << Corrade::Utility::Debug::nospace << value.min()[0];
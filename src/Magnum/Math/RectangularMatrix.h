@@ -31,6 +31,12 @@
 
 #include "Magnum/Math/Vector.h"
 
+#ifdef MAGNUM_MATH_SIMD_SSE
+#include <xmmintrin.h>
+#elif defined(MAGNUM_MATH_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
 namespace Magnum { namespace Math {
 
 namespace Implementation {
@@ -731,14 +737,53 @@ template<std::size_t cols, std::size_t rows, class T> inline RectangularMatrix<c
     return out;
 }
 
-template<std::size_t cols, std::size_t rows, class T> template<std::size_t size> inline RectangularMatrix<size, rows, T> RectangularMatrix<cols, rows, T>::operator*(const RectangularMatrix<size, cols, T>& other) const {
-    RectangularMatrix<size, rows, T> out{ZeroInit};
+namespace Implementation {
+    template<std::size_t size, std::size_t cols, std::size_t rows, class T> inline void multiplyMatrixInto(RectangularMatrix<size, rows, T>& out, const RectangularMatrix<cols, rows, T>& a, const RectangularMatrix<size, cols, T>& b) {
+        for(std::size_t col = 0; col != size; ++col)
+            for(std::size_t row = 0; row != rows; ++row)
+                for(std::size_t pos = 0; pos != cols; ++pos)
+                    out[col][row] += a[pos][row]*b[col][pos];
+    }
 
-    for(std::size_t col = 0; col != size; ++col)
-        for(std::size_t row = 0; row != rows; ++row)
-            for(std::size_t pos = 0; pos != cols; ++pos)
-                out[col][row] += _data[pos][row]*other._data[col][pos];
+    #if defined(MAGNUM_MATH_SIMD_SSE) || defined(MAGNUM_MATH_SIMD_NEON)
+    /* Four-row float matrix times anything, which covers Matrix4*Matrix4 and
+       Matrix4*Vector4. Each output column is a linear combination of the
+       columns of the left matrix, summed in the same order as above. */
+    template<std::size_t size> inline void multiplyMatrixInto(RectangularMatrix<size, 4, Float>& out, const RectangularMatrix<4, 4, Float>& a, const RectangularMatrix<size, 4, Float>& b) {
+        #ifdef MAGNUM_MATH_SIMD_SSE
+        const __m128 a0 = _mm_loadu_ps(a[0].data());
+        const __m128 a1 = _mm_loadu_ps(a[1].data());
+        const __m128 a2 = _mm_loadu_ps(a[2].data());
+        const __m128 a3 = _mm_loadu_ps(a[3].data());
+        for(std::size_t col = 0; col != size; ++col) {
+            const Float* const c = b[col].data();
+            __m128 r = _mm_mul_ps(a0, _mm_set1_ps(c[0]));
+            r = _mm_add_ps(r, _mm_mul_ps(a1, _mm_set1_ps(c[1])));
+            r = _mm_add_ps(r, _mm_mul_ps(a2, _mm_set1_ps(c[2])));
+            r = _mm_add_ps(r, _mm_mul_ps(a3, _mm_set1_ps(c[3])));
+            _mm_storeu_ps(out[col].data(), r);
+        }
+        #else
+        const float32x4_t a0 = vld1q_f32(a[0].data());
+        const float32x4_t a1 = vld1q_f32(a[1].data());
+        const float32x4_t a2 = vld1q_f32(a[2].data());
+        const float32x4_t a3 = vld1q_f32(a[3].data());
+        for(std::size_t col = 0; col != size; ++col) {
+            const Float* const c = b[col].data();
+            float32x4_t r = vmulq_n_f32(a0, c[0]);
+            r = vmlaq_n_f32(r, a1, c[1]);
+            r = vmlaq_n_f32(r, a2, c[2]);
+            r = vmlaq_n_f32(r, a3, c[3]);
+            vst1q_f32(out[col].data(), r);
+        }
+        #endif
+    }
+    #endif
+}
 
+template<std::size_t cols, std::size_t rows, class T> template<std::size_t size> inline RectangularMatrix<size, rows, T> RectangularMatrix<cols, rows, T>::operator*(const RectangularMatrix<size, cols, T>& other) const {
+    RectangularMatrix<size, rows, T> out{ZeroInit};
+    Implementation::multiplyMatrixInto(out, *this, other);
     return out;
 }
 
@@ -0,0 +1,292 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Batch.h"
+#include "Magnum/Math/Matrix4.h"
+
+namespace Magnum { namespace Math { namespace Test {
+
+struct BatchTest: Corrade::TestSuite::Tester {
+    explicit BatchTest();
+
+    void normalizeInPlace();
+    void dotInto();
+    void dotIntoWrongSize();
+    void transformInPlace();
+    void lerpInto();
+    void lerpIntoSameView();
+    void clampInPlace();
+    void clampInPlaceVector();
+    void slerpInto();
+    void slerpIntoSeparateFactors();
+    void slerpIntoWrongSize();
+    void join();
+    void joinEmpty();
+    void intersectsInto();
+    void intersectsIntoWrongSize();
+};
+
+typedef Math::Vector3<Float> Vector3;
+typedef Math::Vector4<Float> Vector4;
+typedef Math::Matrix4<Float> Matrix4;
+typedef Math::Quaternion<Float> Quaternion;
+typedef Math::Deg<Float> Deg;
+typedef Math::Range3D<Float> Range3D;
+
+BatchTest::BatchTest() {
+    addTests({&BatchTest::normalizeInPlace,
+              &BatchTest::dotInto,
+              &BatchTest::dotIntoWrongSize,
+              &BatchTest::transformInPlace,
+              &BatchTest::lerpInto,
+              &BatchTest::lerpIntoSameView,
+              &BatchTest::clampInPlace,
+              &BatchTest::clampInPlaceVector,
+              &BatchTest::slerpInto,
+              &BatchTest::slerpIntoSeparateFactors,
+              &BatchTest::slerpIntoWrongSize,
+              &BatchTest::join,
+              &BatchTest::joinEmpty,
+              &BatchTest::intersectsInto,
+              &BatchTest::intersectsIntoWrongSize});
+}
+
+void BatchTest::normalizeInPlace() {
+    Vector3 vectors[]{
+        {3.0f, 0.0f, 4.0f},
+        {0.0f, -2.0f, 0.0f},
+        {1.0f, 1.0f, 1.0f}
+    };
+    Math::normalizeInPlace(Corrade::Containers::arrayView(vectors));
+
+    CORRADE_COMPARE(vectors[0], (Vector3{0.6f, 0.0f, 0.8f}));
+    CORRADE_COMPARE(vectors[1], (Vector3{0.0f, -1.0f, 0.0f}));
+    CORRADE_COMPARE(vectors[2], Vector3{1.0f}/std::sqrt(3.0f));
+}
+
+void BatchTest::dotInto() {
+    const Vector3 a[]{
+        {1.0f, 2.0f, 3.0f},
+        {0.5f, 0.0f, -1.0f}
+    };
+    const Vector3 b[]{
+        {4.0f, -5.0f, 6.0f},
+        {2.0f, 7.0f, 3.0f}
+    };
+    Float out[2];
+    Math::dotInto<Vector3>(a, b, out);
+
+    CORRADE_COMPARE(out[0], 12.0f);
+    CORRADE_COMPARE(out[1], -2.0f);
+}
+
+void BatchTest::dotIntoWrongSize() {
+    std::ostringstream out;
+    Corrade::Utility::Error redirectError{&out};
+
+    const Vector3 a[3]{};
+    const Vector3 b[3]{};
+    Float result[2];
+    Math::dotInto<Vector3>(a, b, result);
+    CORRADE_COMPARE(out.str(), "Math::dotInto(): expected 3 items in all views but got 3 and 2\n");
+}
+
+void BatchTest::transformInPlace() {
+    const Matrix4 matrix = Matrix4::translation({1.0f, 2.0f, 3.0f})*Matrix4::rotationZ(Deg(90.0f));
+    const Vector4 original[]{
+        {1.0f, 0.0f, 0.0f, 1.0f},
+        {0.0f, 1.0f, 5.0f, 0.0f},
+        {-2.0f, 4.0f, 1.0f, 1.0f}
+    };
+    Vector4 vectors[3];
+    for(std::size_t i = 0; i != 3; ++i) vectors[i] = original[i];
+    Math::transformInPlace(matrix, Corrade::Containers::arrayView(vectors));
+
+    for(std::size_t i = 0; i != 3; ++i)
+        CORRADE_COMPARE(vectors[i], matrix*original[i]);
+    CORRADE_COMPARE(vectors[0], (Vector4{1.0f, 3.0f, 3.0f, 1.0f}));
+}
+
+void BatchTest::lerpInto() {
+    const Vector3 a[]{
+        {0.0f, 2.0f, 4.0f},
+        {-1.0f, 1.0f, 0.0f}
+    };
+    const Vector3 b[]{
+        {2.0f, 4.0f, 0.0f},
+        {1.0f, -1.0f, 8.0f}
+    };
+    Vector3 out[2];
+    Math::lerpInto<Vector3>(a, b, 0.25f, out);
+
+    CORRADE_COMPARE(out[0], (Vector3{0.5f, 2.5f, 3.0f}));
+    CORRADE_COMPARE(out[1], (Vector3{-0.5f, 0.5f, 2.0f}));
+}
+
+void BatchTest::lerpIntoSameView() {
+    Float a[]{0.0f, 10.0f, -4.0f};
+    const Float b[]{1.0f, 20.0f, 4.0f};
+    Math::lerpInto<Float>(a, b, 0.5f, a);
+
+    CORRADE_COMPARE(a[0], 0.5f);
+    CORRADE_COMPARE(a[1], 15.0f);
+    CORRADE_COMPARE(a[2], 0.0f);
+}
+
+void BatchTest::clampInPlace() {
+    Float values[]{-3.0f, 0.5f, 7.0f};
+    Math::clampInPlace(Corrade::Containers::arrayView(values), 0.0f, 1.0f);
+
+    CORRADE_COMPARE(values[0], 0.0f);
+    CORRADE_COMPARE(values[1], 0.5f);
+    CORRADE_COMPARE(values[2], 1.0f);
+}
+
+void BatchTest::clampInPlaceVector() {
+    Vector3 values[]{
+        {-3.0f, 0.5f, 7.0f},
+        {0.25f, 2.0f, -1.0f}
+    };
+    Math::clampInPlace(Corrade::Containers::arrayView(values), 0.0f, 1.0f);
+    CORRADE_COMPARE(values[0], (Vector3{0.0f, 0.5f, 1.0f}));
+    CORRADE_COMPARE(values[1], (Vector3{0.25f, 1.0f, 0.0f}));
+
+    Math::clampInPlace(Corrade::Containers::arrayView(values), Vector3{0.5f, 0.0f, 0.0f}, Vector3{1.0f, 0.5f, 0.5f});
+    CORRADE_COMPARE(values[0], (Vector3{0.5f, 0.5f, 0.5f}));
+    CORRADE_COMPARE(values[1], (Vector3{0.5f, 0.5f, 0.0f}));
+}
+
+void BatchTest::slerpInto() {
+    const Quaternion a[]{
+        Quaternion::rotation(Deg(0.0f), Vector3::zAxis()),
+        Quaternion::rotation(Deg(30.0f), Vector3::xAxis())
+    };
+    const Quaternion b[]{
+        Quaternion::rotation(Deg(90.0f), Vector3::zAxis()),
+        Quaternion::rotation(Deg(-30.0f), Vector3::xAxis())
+    };
+    Quaternion out[2];
+    Math::slerpInto<Float>(a, b, 0.5f, out);
+
+    CORRADE_COMPARE(out[0], Quaternion::rotation(Deg(45.0f), Vector3::zAxis()));
+    CORRADE_COMPARE(out[1], Quaternion{});
+}
+
+void BatchTest::slerpIntoSeparateFactors() {
+    const Quaternion a[]{
+        Quaternion::rotation(Deg(0.0f), Vector3::zAxis()),
+        Quaternion::rotation(Deg(0.0f), Vector3::zAxis())
+    };
+    const Quaternion b[]{
+        Quaternion::rotation(Deg(90.0f), Vector3::zAxis()),
+        Quaternion::rotation(Deg(90.0f), Vector3::zAxis())
+    };
+    const Float t[]{0.5f, 1.0f/3.0f};
+    Quaternion out[2];
+    Math::slerpInto<Float>(a, b, t, out);
+
+    CORRADE_COMPARE(out[0], Quaternion::rotation(Deg(45.0f), Vector3::zAxis()));
+    CORRADE_COMPARE(out[1], Quaternion::rotation(Deg(30.0f), Vector3::zAxis()));
+}
+
+void BatchTest::slerpIntoWrongSize() {
+    std::ostringstream out;
+    Corrade::Utility::Error redirectError{&out};
+
+    const Quaternion a[2];
+    const Quaternion b[2];
+    const Float t[3]{};
+    Quaternion result[2];
+    Math::slerpInto<Float>(a, b, 0.5f, Corrade::Containers::ArrayView<Quaternion>{result, 1});
+    Math::slerpInto<Float>(a, b, t, result);
+    CORRADE_COMPARE(out.str(),
+        "Math::slerpInto(): expected 2 items in all views but got 2 and 1\n"
+        "Math::slerpInto(): expected 2 items in all views but got 2, 3 and 2\n");
+}
+
+void BatchTest::join() {
+    const Range3D ranges[]{
+        {{1.0f, 2.0f, 3.0f}, {2.0f, 4.0f, 5.0f}},
+        /* Empty, skipped */
+        {{-10.0f, 10.0f, 0.0f}, {-10.0f, 10.0f, 0.0f}},
+        {{0.5f, 3.0f, -1.0f}, {1.5f, 3.5f, 4.0f}},
+        {{1.0f, 2.0f, 0.0f}, {7.0f, 2.5f, 1.0f}}
+    };
+
+    CORRADE_COMPARE(Math::join<Range3D>(ranges),
+        (Range3D{{0.5f, 2.0f, -1.0f}, {7.0f, 4.0f, 5.0f}}));
+    CORRADE_COMPARE(Math::join<Range3D>(ranges),
+        Range3D{Math::join(Math::join(Math::join(ranges[0], ranges[1]), ranges[2]), ranges[3])});
+}
+
+void BatchTest::joinEmpty() {
+    const Range3D ranges[]{
+        {{-10.0f, 10.0f, 0.0f}, {-10.0f, 10.0f, 0.0f}},
+        {{1.0f, 2.0f, 3.0f}, {1.0f, 2.0f, 3.0f}}
+    };
+
+    CORRADE_COMPARE(Math::join<Range3D>(ranges), Range3D{});
+    CORRADE_COMPARE(Math::join<Range3D>(nullptr), Range3D{});
+}
+
+void BatchTest::intersectsInto() {
+    const Range3D ranges[]{
+        {{0.0f, 0.0f, 0.0f}, {2.0f, 2.0f, 2.0f}},
+        {{3.0f, 0.0f, 0.0f}, {4.0f, 1.0f, 1.0f}},
+        /* Touching */
+        {{-1.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 1.0f}},
+        {{0.5f, 0.5f, -5.0f}, {0.6f, 0.6f, 5.0f}},
+        /* Overlapping only in two dimensions */
+        {{0.0f, 0.0f, 2.0f}, {1.0f, 1.0f, 3.0f}}
+    };
+    const Range3D range{{0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 1.0f}};
+
+    bool out[5];
+    Math::intersectsInto<Range3D>(ranges, range, out);
+    for(std::size_t i = 0; i != 5; ++i)
+        CORRADE_COMPARE(out[i], Math::intersects(ranges[i], range));
+    CORRADE_VERIFY(out[0]);
+    CORRADE_VERIFY(!out[1]);
+    CORRADE_VERIFY(!out[2]);
+    CORRADE_VERIFY(out[3]);
+    CORRADE_VERIFY(!out[4]);
+}
+
+void BatchTest::intersectsIntoWrongSize() {
+    std::ostringstream out;
+    Corrade::Utility::Error redirectError{&out};
+
+    const Range3D ranges[3];
+    bool result[2];
+    Math::intersectsInto<Range3D>(ranges, {}, result);
+    CORRADE_COMPARE(out.str(), "Math::intersectsInto(): expected 3 items in the output but got 2\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Test::BatchTest)
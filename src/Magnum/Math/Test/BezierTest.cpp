@@ -81,6 +81,12 @@ struct BezierTest : Corrade::TestSuite::Tester {
     void subdivideLinear();
     void subdivideQuadratic();
     void subdivideCubic();
+    void tangent();
+    void polynomialCoefficients();
+    void valueArray();
+    void tangentArray();
+    void arcLengths();
+    void arcLengthParameters();
 
     void debug();
     void configuration();
@@ -104,6 +110,12 @@ BezierTest::BezierTest() {
               &BezierTest::subdivideLinear,
               &BezierTest::subdivideQuadratic,
               &BezierTest::subdivideCubic,
+              &BezierTest::tangent,
+              &BezierTest::polynomialCoefficients,
+              &BezierTest::valueArray,
+              &BezierTest::tangentArray,
+              &BezierTest::arcLengths,
+              &BezierTest::arcLengthParameters,
 
               &BezierTest::debug,
               &BezierTest::configuration});
@@ -274,6 +286,98 @@ void BezierTest::subdivideCubic() {
     CORRADE_COMPARE(right, (CubicBezier2D{Vector2{7.10938f, 6.57812f}, Vector2{13.4375f, 8.6875f}, Vector2{16.25f, -2.0f}, Vector2{5.0f, -20.0f}}));
 }
 
+void BezierTest::tangent() {
+    LinearBezier2D linear{Vector2{0.0f, 0.0f}, Vector2{20.0f, 4.0f}};
+    CORRADE_COMPARE(linear.tangent(0.3f), (Vector2{20.0f, 4.0f}));
+
+    /* B'(t) = 2(1 - t)(P1 - P0) + 2t(P2 - P1) */
+    QuadraticBezier2D quadratic{Vector2{0.0f, 0.0f}, Vector2{10.0f, 15.0f}, Vector2{20.0f, 4.0f}};
+    CORRADE_COMPARE(quadratic.tangent(0.0f), (Vector2{20.0f, 30.0f}));
+    CORRADE_COMPARE(quadratic.tangent(1.0f), (Vector2{20.0f, -22.0f}));
+    CORRADE_COMPARE(quadratic.tangent(0.5f), (Vector2{20.0f, 4.0f}));
+
+    CubicBezier2D cubic{Vector2{0.0f, 0.0f}, Vector2{10.0f, 15.0f}, Vector2{20.0f, 4.0f}, Vector2{5.0f, -20.0f}};
+    CORRADE_COMPARE(cubic.tangent(0.0f), (Vector2{30.0f, 45.0f}));
+    CORRADE_COMPARE(cubic.tangent(1.0f), (Vector2{-45.0f, -72.0f}));
+}
+
+void BezierTest::polynomialCoefficients() {
+    CubicBezier2D bezier{Vector2{0.0f, 0.0f}, Vector2{10.0f, 15.0f}, Vector2{20.0f, 4.0f}, Vector2{5.0f, -20.0f}};
+
+    /* c0 = P0, c1 = 3(P1 - P0), c2 = 3(P0 - 2P1 + P2),
+       c3 = -P0 + 3P1 - 3P2 + P3 */
+    const std::array<Math::Vector<2, Float>, 4> coefficients = bezier.polynomialCoefficients();
+    CORRADE_COMPARE(coefficients[0], (Vector2{0.0f, 0.0f}));
+    CORRADE_COMPARE(coefficients[1], (Vector2{30.0f, 45.0f}));
+    CORRADE_COMPARE(coefficients[2], (Vector2{0.0f, -78.0f}));
+    CORRADE_COMPARE(coefficients[3], (Vector2{-25.0f, 13.0f}));
+}
+
+void BezierTest::valueArray() {
+    CubicBezier2D bezier{Vector2{0.0f, 0.0f}, Vector2{10.0f, 15.0f}, Vector2{20.0f, 4.0f}, Vector2{5.0f, -20.0f}};
+
+    const Float t[]{0.0f, 0.2f, 0.5f, 0.75f, 1.0f};
+    Math::Vector<2, Float> out[5];
+    bezier.valueInto(t, out);
+
+    for(std::size_t i = 0; i != 5; ++i)
+        CORRADE_COMPARE(out[i], bezier.value(t[i]));
+    CORRADE_COMPARE(out[1], (Vector2{5.8f, 5.984f}));
+    CORRADE_COMPARE(out[4], bezier[3]);
+}
+
+void BezierTest::tangentArray() {
+    CubicBezier2D bezier{Vector2{0.0f, 0.0f}, Vector2{10.0f, 15.0f}, Vector2{20.0f, 4.0f}, Vector2{5.0f, -20.0f}};
+
+    const Float t[]{0.0f, 0.2f, 0.5f, 0.75f, 1.0f};
+    Math::Vector<2, Float> out[5];
+    bezier.tangentInto(t, out);
+
+    for(std::size_t i = 0; i != 5; ++i)
+        CORRADE_COMPARE(out[i], bezier.tangent(t[i]));
+}
+
+void BezierTest::arcLengths() {
+    /* Straight line with the speed increasing linearly, length of the first
+       half being a quarter of the total */
+    QuadraticBezier2D bezier{Vector2{0.0f, 0.0f}, Vector2{0.0f, 0.0f}, Vector2{3.0f, 4.0f}};
+
+    Float lengths[5];
+    bezier.arcLengthsInto(lengths);
+    CORRADE_COMPARE(lengths[0], 0.0f);
+    CORRADE_COMPARE(lengths[1], 0.3125f);
+    CORRADE_COMPARE(lengths[2], 1.25f);
+    CORRADE_COMPARE(lengths[3], 2.8125f);
+    CORRADE_COMPARE(lengths[4], 5.0f);
+
+    /* A curved one, compared to a dense polyline approximation */
+    CubicBezier2D cubic{Vector2{0.0f, 0.0f}, Vector2{10.0f, 15.0f}, Vector2{20.0f, 4.0f}, Vector2{5.0f, -20.0f}};
+    Float cubicLengths[32];
+    cubic.arcLengthsInto(cubicLengths);
+    Double polyline = 0.0;
+    for(std::size_t i = 0; i != 1000; ++i)
+        polyline += (cubic.value((i + 1)/1000.0f) - cubic.value(i/1000.0f)).length();
+    CORRADE_VERIFY(std::abs(cubicLengths[31] - polyline) < 0.01);
+}
+
+void BezierTest::arcLengthParameters() {
+    QuadraticBezier2D bezier{Vector2{0.0f, 0.0f}, Vector2{0.0f, 0.0f}, Vector2{3.0f, 4.0f}};
+
+    Float lengths[5];
+    bezier.arcLengthsInto(lengths);
+
+    /* Exact table values, interpolated, out of range */
+    const Float distances[]{0.0f, 1.25f, 5.0f, 2.03125f, -1.0f, 6.0f};
+    Float t[6];
+    QuadraticBezier2D::arcLengthParametersInto(lengths, distances, t);
+    CORRADE_COMPARE(t[0], 0.0f);
+    CORRADE_COMPARE(t[1], 0.5f);
+    CORRADE_COMPARE(t[2], 1.0f);
+    CORRADE_COMPARE(t[3], 0.625f);
+    CORRADE_COMPARE(t[4], 0.0f);
+    CORRADE_COMPARE(t[5], 1.0f);
+}
+
 void BezierTest::debug() {
     std::ostringstream out;
     Debug(&out) << CubicBezier2D{Vector2{0.0f, 1.0f}, Vector2{1.5f, -0.3f}, Vector2{2.1f, 0.5f}, Vector2{0.0f, 2.0f}};
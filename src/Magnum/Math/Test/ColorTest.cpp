@@ -96,6 +96,11 @@ struct ColorTest: Corrade::TestSuite::Tester {
     void fromSrgbDefaultAlpha();
     void srgbMonotonic();
     void srgbLiterals();
+    void fromSrgbArray();
+    void toSrgbArray();
+    void toSrgbArrayClamped();
+    void srgbAlphaArray();
+    void hsvArray();
 
     void xyz();
     void fromXyzDefaultAlpha();
@@ -148,6 +153,11 @@ ColorTest::ColorTest() {
 
     addTests({&ColorTest::fromSrgbDefaultAlpha,
               &ColorTest::srgbLiterals,
+              &ColorTest::fromSrgbArray,
+              &ColorTest::toSrgbArray,
+              &ColorTest::toSrgbArrayClamped,
+              &ColorTest::srgbAlphaArray,
+              &ColorTest::hsvArray,
 
               &ColorTest::xyz,
               &ColorTest::fromXyzDefaultAlpha,
@@ -690,6 +700,81 @@ void ColorTest::srgbLiterals() {
     CORRADE_COMPARE(0x33b27fcc_srgbaf, (Color4{0.0331048f, 0.445201f, 0.212231f, 0.8f}));
 }
 
+void ColorTest::fromSrgbArray() {
+    Color3ub in[256];
+    for(std::size_t i = 0; i != 256; ++i)
+        in[i] = {UnsignedByte(i), UnsignedByte(255 - i), UnsignedByte(i*7)};
+    Color3 out[256];
+    Math::fromSrgbInto(in, out);
+
+    /* The table should give exactly the same results as the scalar code */
+    for(std::size_t i = 0; i != 256; ++i)
+        CORRADE_COMPARE(out[i], Color3::fromSrgb(in[i]));
+}
+
+void ColorTest::toSrgbArray() {
+    /* Roundtrip should be exact for all values */
+    Color3ub in[256];
+    for(std::size_t i = 0; i != 256; ++i)
+        in[i] = {UnsignedByte(i), UnsignedByte(255 - i), UnsignedByte(i*7)};
+    Color3 linear[256];
+    Color3ub out[256];
+    Math::fromSrgbInto(in, linear);
+    Math::toSrgbInto(linear, out);
+    for(std::size_t i = 0; i != 256; ++i)
+        CORRADE_COMPARE(out[i], in[i]);
+
+    /* Values in between the boundaries give the same result as the scalar
+       code */
+    Color3 between[255];
+    Color3ub betweenOut[255];
+    for(std::size_t i = 0; i != 255; ++i)
+        between[i] = Color3::fromSrgb(Vector3{(i + 0.5f)/255.0f});
+    Math::toSrgbInto(between, betweenOut);
+    for(std::size_t i = 0; i != 255; ++i) {
+        CORRADE_COMPARE(betweenOut[i], between[i].toSrgb<UnsignedByte>());
+        CORRADE_COMPARE(betweenOut[i], Color3ub{UnsignedByte(i)});
+    }
+}
+
+void ColorTest::toSrgbArrayClamped() {
+    const Color3 in[]{{-1.0f, 0.0f, 1.0f}, {2.0f, -0.0001f, 1.0001f}};
+    Color3ub out[2];
+    Math::toSrgbInto(in, out);
+
+    CORRADE_COMPARE(out[0], (Color3ub{0, 0, 255}));
+    CORRADE_COMPARE(out[1], (Color3ub{255, 0, 255}));
+}
+
+void ColorTest::srgbAlphaArray() {
+    const Color4ub in[]{{0xf3, 0x2a, 0x80, 0x23}, {0x00, 0xff, 0x10, 0xff}};
+    Color4 linear[2];
+    Color4ub out[2];
+    Math::fromSrgbAlphaInto(in, linear);
+    Math::toSrgbAlphaInto(linear, out);
+
+    CORRADE_COMPARE(linear[0], Color4::fromSrgbAlpha(in[0]));
+    CORRADE_COMPARE(linear[1], Color4::fromSrgbAlpha(in[1]));
+    CORRADE_COMPARE(out[0], in[0]);
+    CORRADE_COMPARE(out[1], in[1]);
+}
+
+void ColorTest::hsvArray() {
+    using namespace Literals;
+
+    const Color3 in[]{{0.107177f, 0.160481f, 0.427f}, {1.0f, 0.5f, 0.0f}};
+    Color3::Hsv hsv[2];
+    Color3 out[2];
+    Math::toHsvInto(in, hsv);
+    Math::fromHsvInto(hsv, out);
+
+    CORRADE_COMPARE(std::get<0>(hsv[0]), 230.0_degf);
+    CORRADE_COMPARE(std::get<1>(hsv[0]), 0.749f);
+    CORRADE_COMPARE(std::get<2>(hsv[0]), 0.427f);
+    CORRADE_COMPARE(out[0], in[0]);
+    CORRADE_COMPARE(out[1], in[1]);
+}
+
 void ColorTest::xyz() {
     /* Verified using http://colormine.org/convert/rgb-to-xyz and
        http://www.easyrgb.com/index.php?X=CALC. The results have slight
@@ -262,36 +262,42 @@ template<class T> void ComplexTest::isNormalizedEpsilon() {
 }
 
 void ComplexTest::addSubtract() {
-    Complex a( 1.7f, -3.7f);
-    Complex b(-3.6f,  0.2f);
-    Complex c(-1.9f, -3.5f);
-
-    CORRADE_COMPARE(a + b, c);
-    CORRADE_COMPARE(c - b, a);
+    constexpr Complex a( 1.7f, -3.7f);
+    constexpr Complex b(-3.6f,  0.2f);
+    constexpr Complex c(-1.9f, -3.5f);
+
+    constexpr Complex added = a + b;
+    constexpr Complex subtracted = c - b;
+    CORRADE_COMPARE(added, c);
+    CORRADE_COMPARE(subtracted, a);
 }
 
 void ComplexTest::negated() {
-    CORRADE_COMPARE(-Complex(2.5f, -7.4f), Complex(-2.5f, 7.4f));
+    constexpr Complex negated = -Complex(2.5f, -7.4f);
+    CORRADE_COMPARE(negated, Complex(-2.5f, 7.4f));
 }
 
 void ComplexTest::multiplyDivideScalar() {
-    Complex a( 2.5f, -0.5f);
-    Complex b(-7.5f,  1.5f);
+    constexpr Complex a( 2.5f, -0.5f);
+    constexpr Complex b(-7.5f,  1.5f);
 
-    CORRADE_COMPARE(a*-3.0f, b);
+    constexpr Complex multiplied = a*-3.0f;
+    constexpr Complex divided = b/-3.0f;
+    CORRADE_COMPARE(multiplied, b);
     CORRADE_COMPARE(-3.0f*a, b);
-    CORRADE_COMPARE(b/-3.0f, a);
+    CORRADE_COMPARE(divided, a);
 
     Complex c(-0.8f, 4.0f);
     CORRADE_COMPARE(-2.0f/a, c);
 }
 
 void ComplexTest::multiply() {
-    Complex a( 5.0f,   3.0f);
-    Complex b( 6.0f,  -7.0f);
+    constexpr Complex a( 5.0f,   3.0f);
+    constexpr Complex b( 6.0f,  -7.0f);
     Complex c(51.0f, -17.0f);
 
-    CORRADE_COMPARE(a*b, c);
+    constexpr Complex ab = a*b;
+    CORRADE_COMPARE(ab, c);
     CORRADE_COMPARE(b*a, c);
 }
 
@@ -331,7 +337,8 @@ template<class T> void ComplexTest::normalizedIterative() {
 }
 
 void ComplexTest::conjugated() {
-    CORRADE_COMPARE(Complex(-3.0f, 4.5f).conjugated(), Complex(-3.0f, -4.5f));
+    constexpr Complex conjugated = Complex(-3.0f, 4.5f).conjugated();
+    CORRADE_COMPARE(conjugated, Complex(-3.0f, -4.5f));
 }
 
 void ComplexTest::inverted() {
@@ -56,6 +56,8 @@ namespace Test {
 struct DualQuaternionTest: Corrade::TestSuite::Tester {
     explicit DualQuaternionTest();
 
+    void implementation();
+
     void construct();
     void constructVectorScalar();
     void constructIdentity();
@@ -104,7 +106,9 @@ typedef Math::Vector3<Float> Vector3;
 using namespace Literals;
 
 DualQuaternionTest::DualQuaternionTest() {
-    addTests({&DualQuaternionTest::construct,
+    addTests({&DualQuaternionTest::implementation,
+
+              &DualQuaternionTest::construct,
               &DualQuaternionTest::constructVectorScalar,
               &DualQuaternionTest::constructIdentity,
               &DualQuaternionTest::constructZero,
@@ -146,6 +150,23 @@ DualQuaternionTest::DualQuaternionTest() {
               &DualQuaternionTest::debug});
 }
 
+void DualQuaternionTest::implementation() {
+    #if defined(MAGNUM_MATH_SIMD_SSE) || defined(MAGNUM_MATH_SIMD_NEON)
+    constexpr bool simd = true;
+    #else
+    constexpr bool simd = false;
+    #endif
+
+    #ifdef MAGNUM_MATH_SIMD
+    #if !defined(__SSE__) && !defined(_M_X64) && !(defined(_M_IX86_FP) && _M_IX86_FP >= 1) && !defined(__ARM_NEON) && !defined(__ARM_NEON__)
+    CORRADE_SKIP("Neither SSE nor NEON is available on this target.");
+    #endif
+    CORRADE_VERIFY(simd);
+    #else
+    CORRADE_VERIFY(!simd);
+    #endif
+}
+
 void DualQuaternionTest::construct() {
     constexpr DualQuaternion a = {{{1.0f, 2.0f, 3.0f}, -4.0f}, {{0.5f, -3.1f, 3.3f}, 2.0f}};
     CORRADE_COMPARE(a, DualQuaternion({{1.0f, 2.0f, 3.0f}, -4.0f}, {{0.5f, -3.1f, 3.3f}, 2.0f}));
@@ -400,8 +421,8 @@ void DualQuaternionTest::rotation() {
 }
 
 void DualQuaternionTest::translation() {
-    Vector3 vec(1.0f, -3.5f, 0.5f);
-    DualQuaternion q = DualQuaternion::translation(vec);
+    constexpr Vector3 vec(1.0f, -3.5f, 0.5f);
+    constexpr DualQuaternion q = DualQuaternion::translation(vec);
     CORRADE_COMPARE(q.length(), 1.0f);
     CORRADE_COMPARE(q, DualQuaternion({}, {{0.5f, -1.75f, 0.25f}, 0.0f}));
     CORRADE_COMPARE(q.translation(), vec);
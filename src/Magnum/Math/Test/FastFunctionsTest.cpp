@@ -0,0 +1,253 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/FastFunctions.h"
+
+namespace Magnum { namespace Math { namespace Test {
+
+struct FastFunctionsTest: Corrade::TestSuite::Tester {
+    explicit FastFunctionsTest();
+
+    void sincos();
+    void sincosLarge();
+    void sinCos();
+    void invsqrt();
+    void sqrt();
+    void exp();
+    void expClamped();
+
+    void sincosInto();
+    void sincosIntoWrongSize();
+    void invsqrtInto();
+    void expInto();
+    void expIntoWrongSize();
+
+    void benchmarkSincos();
+    void benchmarkSincosFast();
+    void benchmarkExp();
+    void benchmarkExpFast();
+};
+
+typedef Math::Rad<Float> Rad;
+typedef Math::Deg<Float> Deg;
+
+FastFunctionsTest::FastFunctionsTest() {
+    addTests({&FastFunctionsTest::sincos,
+              &FastFunctionsTest::sincosLarge,
+              &FastFunctionsTest::sinCos,
+              &FastFunctionsTest::invsqrt,
+              &FastFunctionsTest::sqrt,
+              &FastFunctionsTest::exp,
+              &FastFunctionsTest::expClamped,
+
+              &FastFunctionsTest::sincosInto,
+              &FastFunctionsTest::sincosIntoWrongSize,
+              &FastFunctionsTest::invsqrtInto,
+              &FastFunctionsTest::expInto,
+              &FastFunctionsTest::expIntoWrongSize});
+
+    addBenchmarks({&FastFunctionsTest::benchmarkSincos,
+                   &FastFunctionsTest::benchmarkSincosFast,
+                   &FastFunctionsTest::benchmarkExp,
+                   &FastFunctionsTest::benchmarkExpFast}, 100);
+}
+
+void FastFunctionsTest::sincos() {
+    /* Go through all quadrants in both directions */
+    Float maxError = 0.0f;
+    for(Int i = -20000; i <= 20000; ++i) {
+        const Float angle = i*0.00157f;
+        const std::pair<Float, Float> sincos = Math::Fast::sincos(Rad(angle));
+        maxError = Math::max(maxError, std::abs(sincos.first - Float(std::sin(Double(angle)))));
+        maxError = Math::max(maxError, std::abs(sincos.second - Float(std::cos(Double(angle)))));
+    }
+
+    CORRADE_VERIFY(maxError < 1.0e-7f);
+
+    /* Exact values at quadrant boundaries */
+    CORRADE_COMPARE(Math::Fast::sincos(Rad(0.0f)).first, 0.0f);
+    CORRADE_COMPARE(Math::Fast::sincos(Rad(0.0f)).second, 1.0f);
+    CORRADE_COMPARE(Math::Fast::sincos(Deg(90.0f)).first, 1.0f);
+    CORRADE_COMPARE(Math::Fast::sincos(Deg(180.0f)).second, -1.0f);
+    CORRADE_COMPARE(Math::Fast::sincos(Deg(-90.0f)).first, -1.0f);
+}
+
+void FastFunctionsTest::sincosLarge() {
+    Float maxError = 0.0f;
+    for(Int i = -10000; i <= 10000; ++i) {
+        const Float angle = i*9.9997f;
+        const std::pair<Float, Float> sincos = Math::Fast::sincos(Rad(angle));
+        maxError = Math::max(maxError, std::abs(sincos.first - Float(std::sin(Double(angle)))));
+        maxError = Math::max(maxError, std::abs(sincos.second - Float(std::cos(Double(angle)))));
+    }
+
+    CORRADE_VERIFY(maxError < 1.0e-6f);
+}
+
+void FastFunctionsTest::sinCos() {
+    CORRADE_COMPARE(Math::Fast::sin(Deg(30.0f)), 0.5f);
+    CORRADE_COMPARE(Math::Fast::cos(Deg(60.0f)), 0.5f);
+    CORRADE_COMPARE(Math::Fast::sin(Rad(2.5f)), Math::Fast::sincos(Rad(2.5f)).first);
+    CORRADE_COMPARE(Math::Fast::cos(Rad(2.5f)), Math::Fast::sincos(Rad(2.5f)).second);
+}
+
+void FastFunctionsTest::invsqrt() {
+    Float maxError = 0.0f;
+    for(Float value = 1.0e-30f; value < 1.0e30f; value *= 1.001f)
+        maxError = Math::max(maxError, Float(std::abs(Math::Fast::invsqrt(value)*std::sqrt(Double(value)) - 1.0)));
+
+    CORRADE_VERIFY(maxError < 5.0e-6f);
+    CORRADE_COMPARE(Math::Fast::invsqrt(16.0f), 0.25f);
+}
+
+void FastFunctionsTest::sqrt() {
+    CORRADE_COMPARE(Math::Fast::sqrt(0.0f), 0.0f);
+    CORRADE_COMPARE(Math::Fast::sqrt(16.0f), 4.0f);
+    CORRADE_COMPARE(Math::Fast::sqrt(2.0f), Constants<Float>::sqrt2());
+}
+
+void FastFunctionsTest::exp() {
+    Float maxError = 0.0f;
+    /* The range ends aren't representable exactly and would get clamped */
+    for(Int i = -86999; i <= 87999; ++i) {
+        const Float value = i*0.001f;
+        maxError = Math::max(maxError, Float(std::abs(Math::Fast::exp(value)/std::exp(Double(value)) - 1.0)));
+    }
+
+    CORRADE_VERIFY(maxError < 1.0e-7f);
+    CORRADE_COMPARE(Math::Fast::exp(0.0f), 1.0f);
+    CORRADE_COMPARE(Math::Fast::exp(1.0f), Constants<Float>::e());
+}
+
+void FastFunctionsTest::expClamped() {
+    /* No underflow to denormals or overflow to infinity */
+    CORRADE_COMPARE(Math::Fast::exp(-1000.0f), Math::Fast::exp(-87.0f));
+    CORRADE_COMPARE(Math::Fast::exp(1000.0f), Math::Fast::exp(88.0f));
+    CORRADE_VERIFY(Math::Fast::exp(-1000.0f) > 0.0f);
+    CORRADE_VERIFY(Math::Fast::exp(1000.0f) != Constants<Float>::inf());
+}
+
+void FastFunctionsTest::sincosInto() {
+    const Rad angles[]{Rad(0.0f), Deg(90.0f), Rad(2.5f), Rad(-1234.5f), Deg(-30.0f)};
+    Float sines[5];
+    Float cosines[5];
+    Math::Fast::sincosInto(angles, sines, cosines);
+
+    for(std::size_t i = 0; i != 5; ++i) {
+        CORRADE_COMPARE(sines[i], Math::Fast::sin(angles[i]));
+        CORRADE_COMPARE(cosines[i], Math::Fast::cos(angles[i]));
+    }
+}
+
+void FastFunctionsTest::sincosIntoWrongSize() {
+    const Rad angles[3]{};
+    Float sines[3];
+    Float cosines[2];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Math::Fast::sincosInto(angles, sines, cosines);
+    CORRADE_COMPARE(out.str(), "Math::Fast::sincosInto(): expected 3 items in all views but got 3 and 2\n");
+}
+
+void FastFunctionsTest::invsqrtInto() {
+    Float values[]{1.0f, 4.0f, 0.25f, 100.0f};
+    Math::Fast::invsqrtInto(values, values);
+
+    CORRADE_COMPARE(values[0], 1.0f);
+    CORRADE_COMPARE(values[1], 0.5f);
+    CORRADE_COMPARE(values[2], 2.0f);
+    CORRADE_COMPARE(values[3], 0.1f);
+}
+
+void FastFunctionsTest::expInto() {
+    const Float values[]{0.0f, 1.0f, -2.5f, 10.0f};
+    Float out[4];
+    Math::Fast::expInto(values, out);
+
+    for(std::size_t i = 0; i != 4; ++i)
+        CORRADE_COMPARE(out[i], Math::Fast::exp(values[i]));
+}
+
+void FastFunctionsTest::expIntoWrongSize() {
+    const Float values[3]{};
+    Float out[4];
+
+    std::ostringstream o;
+    Error redirectError{&o};
+    Math::Fast::expInto(values, out);
+    CORRADE_COMPARE(o.str(), "Math::Fast::expInto(): expected 3 items in the output view but got 4\n");
+}
+
+void FastFunctionsTest::benchmarkSincos() {
+    Float out = 0.0f;
+    CORRADE_BENCHMARK(100)
+        for(std::uint_fast16_t i = 0; i != 1000; ++i) {
+            const std::pair<Float, Float> sincos = Math::sincos(Rad(i*0.01f));
+            out += sincos.first + sincos.second;
+        }
+
+    /* To avoid optimizing things out */
+    CORRADE_VERIFY(out);
+}
+
+void FastFunctionsTest::benchmarkSincosFast() {
+    Float out = 0.0f;
+    CORRADE_BENCHMARK(100)
+        for(std::uint_fast16_t i = 0; i != 1000; ++i) {
+            const std::pair<Float, Float> sincos = Math::Fast::sincos(Rad(i*0.01f));
+            out += sincos.first + sincos.second;
+        }
+
+    /* To avoid optimizing things out */
+    CORRADE_VERIFY(out);
+}
+
+void FastFunctionsTest::benchmarkExp() {
+    Float out = 0.0f;
+    CORRADE_BENCHMARK(100)
+        for(std::uint_fast16_t i = 0; i != 1000; ++i)
+            out += std::exp(i*0.01f);
+
+    /* To avoid optimizing things out */
+    CORRADE_VERIFY(out);
+}
+
+void FastFunctionsTest::benchmarkExpFast() {
+    Float out = 0.0f;
+    CORRADE_BENCHMARK(100)
+        for(std::uint_fast16_t i = 0; i != 1000; ++i)
+            out += Math::Fast::exp(i*0.01f);
+
+    /* To avoid optimizing things out */
+    CORRADE_VERIFY(out);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Test::FastFunctionsTest)
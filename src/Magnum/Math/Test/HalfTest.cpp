@@ -24,9 +24,14 @@
 */
 
 #include <sstream>
+#include <vector>
+#include <Corrade/Containers/Array.h>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
 
+#include "Magnum/Math/Color.h"
 #include "Magnum/Math/Half.h"
+#include "Magnum/Math/Packing.h"
 #include "Magnum/Math/Vector3.h"
 
 namespace Magnum { namespace Math { namespace Test {
@@ -37,19 +42,28 @@ struct HalfTest: Corrade::TestSuite::Tester {
     void unpack();
     void pack();
     void repack();
+    void unpackArray();
+    void packArray();
+    void packArrayRemainder();
+    void unpackVectorArray();
+    void packVectorArray();
 
     void unpack1k();
     void unpack1kNaive();
     void unpack1kTable();
+    void unpack1kArray();
     void pack1k();
     void pack1kNaive();
     void pack1kTable();
+    void pack1kArray();
 
     void constructDefault();
     void constructValue();
     void constructData();
     void constructNoInit();
     void constructCopy();
+    void constructVector();
+    void constructColor();
 
     void compare();
     void compareNaN();
@@ -78,6 +92,15 @@ struct HalfTest: Corrade::TestSuite::Tester {
 };
 
 typedef Math::Constants<Float> Constants;
+typedef Math::Vector2<Float> Vector2;
+typedef Math::Vector3<Float> Vector3;
+typedef Math::Vector4<Float> Vector4;
+typedef Math::Color4<Float> Color4;
+typedef Math::Vector2<Half> Vector2h;
+typedef Math::Vector3<Half> Vector3h;
+typedef Math::Vector4<Half> Vector4h;
+typedef Math::Color3<Half> Color3h;
+typedef Math::Color4<Half> Color4h;
 
 HalfTest::HalfTest() {
     addTests({&HalfTest::unpack,
@@ -85,19 +108,29 @@ HalfTest::HalfTest() {
 
     addRepeatedTests({&HalfTest::repack}, 65536);
 
+    addTests({&HalfTest::unpackArray,
+              &HalfTest::packArray,
+              &HalfTest::packArrayRemainder,
+              &HalfTest::unpackVectorArray,
+              &HalfTest::packVectorArray});
+
     addBenchmarks({
         &HalfTest::unpack1k,
         &HalfTest::unpack1kNaive,
         &HalfTest::unpack1kTable,
+        &HalfTest::unpack1kArray,
         &HalfTest::pack1k,
         &HalfTest::pack1kNaive,
-        &HalfTest::pack1kTable}, 100);
+        &HalfTest::pack1kTable,
+        &HalfTest::pack1kArray}, 100);
 
     addTests({&HalfTest::constructDefault,
               &HalfTest::constructValue,
               &HalfTest::constructData,
               &HalfTest::constructNoInit,
               &HalfTest::constructCopy,
+              &HalfTest::constructVector,
+              &HalfTest::constructColor,
 
               &HalfTest::compare});
 
@@ -438,6 +471,96 @@ void HalfTest::repack() {
     }
 }
 
+void HalfTest::unpackArray() {
+    /* Go through all possible halves, the vectorized path should give
+       exactly the same results as the scalar one */
+    Corrade::Containers::Array<UnsignedShort> in{65536};
+    for(std::size_t i = 0; i != in.size(); ++i) in[i] = i;
+    Corrade::Containers::Array<Float> out{in.size()};
+    Math::unpackHalfInto(in, out);
+
+    for(std::size_t i = 0; i != in.size(); ++i) {
+        const Float expected = Math::unpackHalf(in[i]);
+        if(expected != expected) CORRADE_VERIFY(out[i] != out[i]);
+        else CORRADE_COMPARE(out[i], expected);
+    }
+}
+
+void HalfTest::packArray() {
+    /* All halves except NaNs should roundtrip also in the batch variant */
+    std::vector<Float> in;
+    std::vector<UnsignedShort> expected;
+    for(std::size_t i = 0; i != 65536; ++i) {
+        const Float value = Math::unpackHalf(i);
+        if(value != value) continue;
+        in.push_back(value);
+        expected.push_back(i);
+    }
+
+    std::vector<UnsignedShort> out(in.size());
+    Math::packHalfInto({in.data(), in.size()}, {out.data(), out.size()});
+    CORRADE_COMPARE_AS(out, expected, Corrade::TestSuite::Compare::Container);
+}
+
+void HalfTest::packArrayRemainder() {
+    /* Sizes that aren't a multiple of the batch size go partially through the
+       scalar/padded path */
+    const Float in[]{1.0f, -2.5f, 65504.0f, 0.0f, -0.0f, 0.5f, 3.14159f, 1.0e-5f, 100000.0f, -1.0f, 2.0f};
+    UnsignedShort out[Corrade::Containers::arraySize(in)];
+    Float unpacked[Corrade::Containers::arraySize(in)];
+    for(std::size_t size: {std::size_t{0}, std::size_t{1}, std::size_t{3}, std::size_t{7}, std::size_t{9}, std::size_t{11}}) {
+        Math::packHalfInto({in, size}, {out, size});
+        for(std::size_t i = 0; i != size; ++i)
+            CORRADE_COMPARE(out[i], Math::packHalf(in[i]));
+
+        Math::unpackHalfInto({out, size}, {unpacked, size});
+        for(std::size_t i = 0; i != size; ++i)
+            CORRADE_COMPARE(unpacked[i], Math::unpackHalf(out[i]));
+    }
+}
+
+void HalfTest::unpackVectorArray() {
+    using namespace Literals;
+
+    const Vector3h in[]{
+        {1.0_h, -2.5_h, 0.5_h},
+        {65504.0_h, 0.0_h, -0.0_h},
+        {3.14159_h, -1.0_h, 2.0_h}};
+    Vector3 out[3];
+    Math::unpackHalfInto(in, out);
+    for(std::size_t i = 0; i != 3; ++i)
+        CORRADE_COMPARE(out[i], Vector3{in[i]});
+
+    /* Colors go through the same overload */
+    const Color4h colors[]{{0.25_h, 0.5_h, 0.75_h}, {1.0_h, 0.0_h, 0.5_h, 0.5_h}};
+    Color4 colorsOut[2];
+    Math::unpackHalfInto(colors, colorsOut);
+    CORRADE_COMPARE(colorsOut[0], (Color4{0.25f, 0.5f, 0.75f, 1.0f}));
+    CORRADE_COMPARE(colorsOut[1], (Color4{1.0f, 0.0f, 0.5f, 0.5f}));
+}
+
+void HalfTest::packVectorArray() {
+    /* Sizes that aren't a multiple of the batch size, similarly to
+       packArrayRemainder() */
+    const Vector2 in2[]{{1.0f, -2.5f}, {0.5f, 3.14159f}, {1.0e-5f, 100000.0f}};
+    Vector2h out2[3];
+    Math::packHalfInto(in2, out2);
+    for(std::size_t i = 0; i != 3; ++i)
+        CORRADE_COMPARE(out2[i], Vector2h{in2[i]});
+
+    const Vector4 in4[]{{1.0f, -2.5f, 65504.0f, 0.0f}, {-0.0f, 0.5f, 3.14159f, -1.0f}, {2.0f, 4.0f, 8.0f, 16.0f}};
+    Vector4h out4[3];
+    Math::packHalfInto(in4, out4);
+    for(std::size_t i = 0; i != 3; ++i)
+        CORRADE_COMPARE(out4[i], Vector4h{in4[i]});
+
+    /* Roundtrip back */
+    Vector4 unpacked4[3];
+    Math::unpackHalfInto(out4, unpacked4);
+    CORRADE_COMPARE(unpacked4[0], (Vector4{1.0f, -2.5f, 65504.0f, 0.0f}));
+    CORRADE_COMPARE(unpacked4[2], (Vector4{2.0f, 4.0f, 8.0f, 16.0f}));
+}
+
 void HalfTest::pack1k() {
     UnsignedInt out = 0;
     CORRADE_BENCHMARK(100)
@@ -468,6 +591,21 @@ void HalfTest::pack1kTable() {
     CORRADE_VERIFY(out);
 }
 
+void HalfTest::pack1kArray() {
+    Float in[1000];
+    for(std::uint_fast16_t i = 0; i != 1000; ++i) in[i] = Float(i)*65;
+    UnsignedShort out[1000];
+
+    UnsignedInt sum = 0;
+    CORRADE_BENCHMARK(100) {
+        Math::packHalfInto(in, out);
+        sum += out[999];
+    }
+
+    /* To avoid optimizing things out */
+    CORRADE_VERIFY(sum);
+}
+
 void HalfTest::unpack1k() {
     Float out = 0.0f;
     CORRADE_BENCHMARK(100)
@@ -498,6 +636,21 @@ void HalfTest::unpack1kTable() {
     CORRADE_VERIFY(out);
 }
 
+void HalfTest::unpack1kArray() {
+    UnsignedShort in[1000];
+    for(std::uint_fast16_t i = 0; i != 1000; ++i) in[i] = i*65;
+    Float out[1000];
+
+    Float sum = 0.0f;
+    CORRADE_BENCHMARK(100) {
+        Math::unpackHalfInto(in, out);
+        sum += out[999];
+    }
+
+    /* To avoid optimizing things out */
+    CORRADE_VERIFY(sum);
+}
+
 void HalfTest::constructDefault() {
     constexpr Half a;
     CORRADE_COMPARE(Float(a), 0.0f);
@@ -562,6 +715,36 @@ void HalfTest::constructCopy() {
     CORRADE_VERIFY(std::is_nothrow_copy_assignable<Half>::value);
 }
 
+void HalfTest::constructVector() {
+    using namespace Literals;
+
+    const Vector3h a{3.5_h, -1.0_h, 0.5_h};
+    CORRADE_COMPARE(Vector3{a}, (Vector3{3.5f, -1.0f, 0.5f}));
+    CORRADE_COMPARE(Vector3h{Vector3{a}}, a);
+    CORRADE_COMPARE(Math::Vector3<UnsignedShort>{a}, (Math::Vector3<UnsignedShort>{0x4300, 0xbc00, 0x3800}));
+
+    /* Half the size of a float vector */
+    CORRADE_COMPARE(sizeof(Vector2h), 4);
+    CORRADE_COMPARE(sizeof(Vector3h), 6);
+    CORRADE_COMPARE(sizeof(Vector4h), 8);
+    CORRADE_COMPARE(TypeTraits<Half>::name(), std::string{"Half"});
+}
+
+void HalfTest::constructColor() {
+    using namespace Literals;
+
+    /* Alpha defaults to 1.0 */
+    const Color4h a{0.25_h, 0.5_h, 0.75_h};
+    CORRADE_COMPARE(a.a(), 1.0_h);
+
+    const Color4h b{Color3h{0.25_h, 0.5_h, 0.75_h}};
+    CORRADE_COMPARE(b, a);
+
+    const Color4h c{Color4{0.25f, 0.5f, 0.75f, 0.5f}};
+    CORRADE_COMPARE(Color4{c}, (Color4{0.25f, 0.5f, 0.75f, 0.5f}));
+    CORRADE_COMPARE(sizeof(Color4h), 8);
+}
+
 void HalfTest::compare() {
     constexpr Half a{UnsignedShort(0x4300)};
     constexpr Half b{UnsignedShort(0x4301)};
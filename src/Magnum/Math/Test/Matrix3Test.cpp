@@ -85,6 +85,7 @@ struct Matrix3Test: Corrade::TestSuite::Tester {
     void uniformScalingPart();
     void vectorParts();
     void invertedRigid();
+    void invertedAffine();
     void transform();
 
     void debug();
@@ -125,6 +126,7 @@ Matrix3Test::Matrix3Test() {
               &Matrix3Test::uniformScalingPart,
               &Matrix3Test::vectorParts,
               &Matrix3Test::invertedRigid,
+              &Matrix3Test::invertedAffine,
               &Matrix3Test::transform,
 
               &Matrix3Test::debug,
@@ -336,7 +338,8 @@ void Matrix3Test::projection() {
                      {     0.0f, 2.0f/3.0f, 0.0f},
                      {     0.0f,      0.0f, 1.0f});
 
-    CORRADE_COMPARE(Matrix3::projection({4.0f, 3.0f}), expected);
+    constexpr Matrix3 actual = Matrix3::projection({4.0f, 3.0f});
+    CORRADE_COMPARE(actual, expected);
 }
 
 void Matrix3Test::fromParts() {
@@ -463,6 +466,23 @@ void Matrix3Test::invertedRigid() {
     CORRADE_COMPARE(actual.invertedRigid(), actual.inverted());
 }
 
+void Matrix3Test::invertedAffine() {
+    Matrix3 actual = Matrix3::rotation(Deg(-74.0f))*
+                     Matrix3::scaling({2.0f, -0.5f})*
+                     Matrix3::translation({2.0f, -3.0f});
+    Matrix3 expected = Matrix3::translation({-2.0f, 3.0f})*
+                       Matrix3::scaling({0.5f, -2.0f})*
+                       Matrix3::rotation(Deg(74.0f));
+
+    std::ostringstream o;
+    Error redirectError{&o};
+    Matrix3{Vector3{1.0f}, Vector3{1.0f}, Vector3{1.0f}}.invertedAffine();
+    CORRADE_COMPARE(o.str(), "Math::Matrix3::invertedAffine(): the matrix doesn't represent affine transformation\n");
+
+    CORRADE_COMPARE(actual.invertedAffine(), expected);
+    CORRADE_COMPARE(actual.invertedAffine(), actual.inverted());
+}
+
 void Matrix3Test::transform() {
     Matrix3 a = Matrix3::translation({1.0f, -5.0f})*Matrix3::rotation(Deg(90.0f));
     Vector2 v(1.0f, -2.0f);
@@ -62,6 +62,8 @@ namespace Test {
 struct Matrix4Test: Corrade::TestSuite::Tester {
     explicit Matrix4Test();
 
+    void implementation();
+
     void construct();
     void constructIdentity();
     void constructZero();
@@ -98,6 +100,8 @@ struct Matrix4Test: Corrade::TestSuite::Tester {
     void uniformScalingPart();
     void vectorParts();
     void invertedRigid();
+    void invertedAffine();
+    void normalMatrix();
     void transform();
     void transformProjection();
 
@@ -115,7 +119,9 @@ typedef Math::Vector4<Float> Vector4;
 typedef Math::Constants<Float> Constants;
 
 Matrix4Test::Matrix4Test() {
-    addTests({&Matrix4Test::construct,
+    addTests({&Matrix4Test::implementation,
+
+              &Matrix4Test::construct,
               &Matrix4Test::constructIdentity,
               &Matrix4Test::constructZero,
               &Matrix4Test::constructNoInit,
@@ -151,6 +157,8 @@ Matrix4Test::Matrix4Test() {
               &Matrix4Test::uniformScalingPart,
               &Matrix4Test::vectorParts,
               &Matrix4Test::invertedRigid,
+              &Matrix4Test::invertedAffine,
+              &Matrix4Test::normalMatrix,
               &Matrix4Test::transform,
               &Matrix4Test::transformProjection,
 
@@ -158,6 +166,23 @@ Matrix4Test::Matrix4Test() {
               &Matrix4Test::configuration});
 }
 
+void Matrix4Test::implementation() {
+    #if defined(MAGNUM_MATH_SIMD_SSE) || defined(MAGNUM_MATH_SIMD_NEON)
+    constexpr bool simd = true;
+    #else
+    constexpr bool simd = false;
+    #endif
+
+    #ifdef MAGNUM_MATH_SIMD
+    #if !defined(__SSE__) && !defined(_M_X64) && !(defined(_M_IX86_FP) && _M_IX86_FP >= 1) && !defined(__ARM_NEON) && !defined(__ARM_NEON__)
+    CORRADE_SKIP("Neither SSE nor NEON is available on this target.");
+    #endif
+    CORRADE_VERIFY(simd);
+    #else
+    CORRADE_VERIFY(!simd);
+    #endif
+}
+
 void Matrix4Test::construct() {
     constexpr Matrix4 a = {{3.0f,  5.0f, 8.0f, -3.0f},
                            {4.5f,  4.0f, 7.0f,  2.0f},
@@ -427,7 +452,7 @@ void Matrix4Test::orthographicProjection() {
                      {0.0f, 0.5f,   0.0f, 0.0f},
                      {0.0f, 0.0f, -0.25f, 0.0f},
                      {0.0f, 0.0f, -1.25f, 1.0f});
-    Matrix4 actual = Matrix4::orthographicProjection({5.0f, 4.0f}, 1.0f, 9.0f);
+    constexpr Matrix4 actual = Matrix4::orthographicProjection({5.0f, 4.0f}, 1.0f, 9.0f);
     CORRADE_COMPARE(actual, expected);
 
     /* NDC is left-handed, so point on near plane should be -1, far +1 */
@@ -440,7 +465,7 @@ void Matrix4Test::perspectiveProjection() {
                      {0.0f, 7.111111f,         0.0f,  0.0f},
                      {0.0f,      0.0f,  -1.9411764f, -1.0f},
                      {0.0f,      0.0f, -94.1176452f,  0.0f});
-    Matrix4 actual = Matrix4::perspectiveProjection({16.0f, 9.0f}, 32.0f, 100.0f);
+    constexpr Matrix4 actual = Matrix4::perspectiveProjection({16.0f, 9.0f}, 32.0f, 100.0f);
     CORRADE_COMPARE(actual, expected);
 
     /* NDC is left-handed, so point on near plane should be -1, far +1 */
@@ -453,7 +478,7 @@ void Matrix4Test::perspectiveProjectionInfiniteFar() {
                      {0.0f, 7.111111f,   0.0f,  0.0f},
                      {0.0f,      0.0f,  -1.0f, -1.0f},
                      {0.0f,      0.0f, -64.0f,  0.0f});
-    Matrix4 actual = Matrix4::perspectiveProjection({16.0f, 9.0f}, 32.0f, Constants::inf());
+    constexpr Matrix4 actual = Matrix4::perspectiveProjection({16.0f, 9.0f}, 32.0f, Constants::inf());
     CORRADE_COMPARE(actual, expected);
 
     /* NDC is left-handed, so point on near plane should be -1 and a *vector*
@@ -615,6 +640,48 @@ void Matrix4Test::invertedRigid() {
     CORRADE_COMPARE(actual.invertedRigid(), actual.inverted());
 }
 
+void Matrix4Test::invertedAffine() {
+    Matrix4 actual = Matrix4::rotation(Deg(-74.0f), Vector3(-1.0f, 0.5f, 2.0f).normalized())*
+                     Matrix4::scaling({2.0f, -0.5f, 4.0f})*
+                     Matrix4::translation({1.0f, 2.0f, -3.0f});
+    Matrix4 expected = Matrix4::translation({-1.0f, -2.0f, 3.0f})*
+                       Matrix4::scaling({0.5f, -2.0f, 0.25f})*
+                       Matrix4::rotation(Deg(74.0f), Vector3(-1.0f, 0.5f, 2.0f).normalized());
+
+    std::ostringstream o;
+    Error redirectError{&o};
+    Matrix4::perspectiveProjection(Deg(35.0f), 1.0f, 0.1f, 100.0f).invertedAffine();
+    CORRADE_COMPARE(o.str(), "Math::Matrix4::invertedAffine(): the matrix doesn't represent affine transformation\n");
+
+    CORRADE_COMPARE(actual.invertedAffine(), expected);
+    CORRADE_COMPARE(actual.invertedAffine(), actual.inverted());
+}
+
+void Matrix4Test::normalMatrix() {
+    Matrix4 a = Matrix4::rotation(Deg(-74.0f), Vector3(-1.0f, 0.5f, 2.0f).normalized())*
+                Matrix4::scaling({2.0f, 0.5f, 4.0f})*
+                Matrix4::translation({1.0f, 2.0f, -3.0f});
+
+    /* Same as inverse transpose, up to the scale factor */
+    Matrix3x3 expected = a.rotationScaling().inverted().transposed();
+    CORRADE_COMPARE(a.normalMatrix(), expected*a.rotationScaling().determinant());
+
+    /* Normals transformed with both are the same after normalization */
+    const Vector3 normal = Vector3{1.0f, -1.0f, 0.5f}.normalized();
+    CORRADE_COMPARE((a.normalMatrix()*normal).normalized(), (expected*normal).normalized());
+
+    /* Flipped handedness, the normals shouldn't get flipped by the negative
+       determinant */
+    Matrix4 b = a*Matrix4::scaling({-1.0f, 1.0f, 1.0f});
+    Matrix3x3 expectedFlipped = b.rotationScaling().inverted().transposed();
+    CORRADE_COMPARE((b.normalMatrix()*normal).normalized(), (expectedFlipped*normal).normalized());
+
+    /* For rigid transformations it's equal to the rotation part */
+    Matrix4 c = Matrix4::rotation(Deg(-74.0f), Vector3(-1.0f, 0.5f, 2.0f).normalized())*
+                Matrix4::translation({1.0f, 2.0f, -3.0f});
+    CORRADE_COMPARE(c.normalMatrix(), c.rotation());
+}
+
 void Matrix4Test::transform() {
     Matrix4 a = Matrix4::translation({1.0f, -5.0f, 3.5f})*Matrix4::rotation(Deg(90.0f), Vector3::zAxis());
     Vector3 v(1.0f, -2.0f, 5.5f);
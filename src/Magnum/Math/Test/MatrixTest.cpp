@@ -74,7 +74,10 @@ struct MatrixTest: Corrade::TestSuite::Tester {
     void trace();
     void ij();
     void determinant();
+    void comatrix();
+    void adjugate();
     void inverted();
+    void inverted3x3();
     void invertedOrthogonal();
 
     void subclassTypes();
@@ -108,7 +111,10 @@ MatrixTest::MatrixTest() {
               &MatrixTest::trace,
               &MatrixTest::ij,
               &MatrixTest::determinant,
+              &MatrixTest::comatrix,
+              &MatrixTest::adjugate,
               &MatrixTest::inverted,
+              &MatrixTest::inverted3x3,
               &MatrixTest::invertedOrthogonal,
 
               &MatrixTest::subclassTypes,
@@ -317,6 +323,30 @@ void MatrixTest::determinant() {
     CORRADE_COMPARE(m.determinant(), -2);
 }
 
+void MatrixTest::comatrix() {
+    Matrix3x3 m{Vector3{3.0f,  5.0f, 8.0f},
+                Vector3{4.0f,  4.0f, 7.0f},
+                Vector3{7.0f, -1.0f, 8.0f}};
+
+    Matrix3x3 expected{Vector3{ 39.0f,  17.0f, -32.0f},
+                       Vector3{-48.0f, -32.0f,  38.0f},
+                       Vector3{  3.0f,  11.0f,  -8.0f}};
+
+    CORRADE_COMPARE(m.comatrix(), expected);
+    CORRADE_COMPARE(m.determinant(), -54.0f);
+    CORRADE_COMPARE(m.comatrix(), m.inverted().transposed()*m.determinant());
+}
+
+void MatrixTest::adjugate() {
+    Matrix4x4 m(Vector4(3.0f,  5.0f, 8.0f, 4.0f),
+                Vector4(4.0f,  4.0f, 7.0f, 3.0f),
+                Vector4(7.0f, -1.0f, 8.0f, 0.0f),
+                Vector4(9.0f,  4.0f, 5.0f, 9.0f));
+
+    CORRADE_COMPARE(m.adjugate(), m.comatrix().transposed());
+    CORRADE_COMPARE(m.adjugate()*m, Matrix4x4(IdentityInit, m.determinant()));
+}
+
 void MatrixTest::inverted() {
     Matrix4x4 m(Vector4(3.0f,  5.0f, 8.0f, 4.0f),
                 Vector4(4.0f,  4.0f, 7.0f, 3.0f),
@@ -334,6 +364,17 @@ void MatrixTest::inverted() {
     CORRADE_COMPARE(_inverse*m, Matrix4x4());
 }
 
+void MatrixTest::inverted3x3() {
+    /* Goes through the generic cofactor path, unlike the 4x4 variant */
+    Matrix3x3 m{Vector3{3.0f,  5.0f, 8.0f},
+                Vector3{4.0f,  4.0f, 7.0f},
+                Vector3{7.0f, -1.0f, 8.0f}};
+
+    Matrix3x3 inverse = m.inverted();
+    CORRADE_COMPARE(inverse, m.adjugate()/-54.0f);
+    CORRADE_COMPARE(inverse*m, Matrix3x3());
+}
+
 void MatrixTest::invertedOrthogonal() {
     std::ostringstream o;
     Error redirectError{&o};
@@ -377,6 +418,8 @@ void MatrixTest::subclassTypes() {
 
     CORRADE_VERIFY((std::is_same<decltype(c.transposed()), Mat2>::value));
     CORRADE_VERIFY((std::is_same<decltype(c.diagonal()), Vec2>::value));
+    CORRADE_VERIFY((std::is_same<decltype(c.comatrix()), Mat2>::value));
+    CORRADE_VERIFY((std::is_same<decltype(c.adjugate()), Mat2>::value));
     CORRADE_VERIFY((std::is_same<decltype(c.inverted()), Mat2>::value));
     CORRADE_VERIFY((std::is_same<decltype(c.invertedOrthogonal()), Mat2>::value));
 }
@@ -44,6 +44,9 @@ struct PackingTest: Corrade::TestSuite::Tester {
     void reunpackSinged();
     void unpackTypeDeduction();
 
+    void unpackArray();
+    void packArray();
+
     /* Half (un)pack functions are tested and benchmarked in HalfTest.cpp,
        because there's involved comparison and benchmarks to ground truth */
 };
@@ -61,7 +64,10 @@ PackingTest::PackingTest() {
               &PackingTest::packSigned,
               &PackingTest::reunpackUnsinged,
               &PackingTest::reunpackSinged,
-              &PackingTest::unpackTypeDeduction});
+              &PackingTest::unpackTypeDeduction,
+
+              &PackingTest::unpackArray,
+              &PackingTest::packArray});
 }
 
 void PackingTest::bitMax() {
@@ -279,6 +285,64 @@ void PackingTest::unpackTypeDeduction() {
     CORRADE_COMPARE((Math::unpack<Float, Byte>('\x7F')), 1.0f);
 }
 
+void PackingTest::unpackArray() {
+    const UnsignedByte a[]{0, 1, 127, 128, 254, 255};
+    const Byte b[]{-128, -127, -1, 0, 1, 127};
+    const UnsignedShort c[]{0, 1, 32767, 65534, 65535};
+    const Short d[]{-32768, -32767, -1, 0, 1, 32767};
+    Float out[6];
+
+    Math::unpackInto<UnsignedByte>(a, out);
+    for(std::size_t i = 0; i != 6; ++i)
+        CORRADE_COMPARE(out[i], (Math::unpack<Float, UnsignedByte>(a[i])));
+    Math::unpackInto<Byte>(b, out);
+    for(std::size_t i = 0; i != 6; ++i)
+        CORRADE_COMPARE(out[i], (Math::unpack<Float, Byte>(b[i])));
+    Math::unpackInto<UnsignedShort>(c, {out, 5});
+    for(std::size_t i = 0; i != 5; ++i)
+        CORRADE_COMPARE(out[i], (Math::unpack<Float, UnsignedShort>(c[i])));
+    Math::unpackInto<Short>(d, out);
+    for(std::size_t i = 0; i != 6; ++i)
+        CORRADE_COMPARE(out[i], (Math::unpack<Float, Short>(d[i])));
+
+    /* Signed types are clamped to -1 */
+    CORRADE_COMPARE(out[0], -1.0f);
+}
+
+void PackingTest::packArray() {
+    const Float in[]{-1.5f, -1.0f, -0.5f, 0.0f, 0.25f, 0.5f, 1.0f, 1.5f};
+    UnsignedByte a[8];
+    Byte b[8];
+    UnsignedShort c[8];
+    Short d[8];
+
+    /* Values outside of the range are expected to be clamped by the caller,
+       same as with the scalar variant */
+    Math::packInto<UnsignedByte>({in + 3, 4}, {a, 4});
+    Math::packInto<Byte>({in + 1, 6}, {b, 6});
+    Math::packInto<UnsignedShort>({in + 3, 4}, {c, 4});
+    Math::packInto<Short>({in + 1, 6}, {d, 6});
+    for(std::size_t i = 0; i != 4; ++i) {
+        CORRADE_COMPARE(a[i], (Math::pack<UnsignedByte, Float>(in[i + 3])));
+        CORRADE_COMPARE(c[i], (Math::pack<UnsignedShort, Float>(in[i + 3])));
+    }
+    for(std::size_t i = 0; i != 6; ++i) {
+        CORRADE_COMPARE(b[i], (Math::pack<Byte, Float>(in[i + 1])));
+        CORRADE_COMPARE(d[i], (Math::pack<Short, Float>(in[i + 1])));
+    }
+
+    /* Repacking all 8-bit values gives the same result as the scalar
+       variant */
+    UnsignedByte all[256];
+    for(std::size_t i = 0; i != 256; ++i) all[i] = i;
+    Float unpacked[256];
+    UnsignedByte repacked[256];
+    Math::unpackInto<UnsignedByte>(all, unpacked);
+    Math::packInto<UnsignedByte>(unpacked, repacked);
+    for(std::size_t i = 0; i != 256; ++i)
+        CORRADE_COMPARE(repacked[i], (Math::pack<UnsignedByte, Float>(unpacked[i])));
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Math::Test::PackingTest)
@@ -55,6 +55,8 @@ namespace Test {
 struct QuaternionTest: Corrade::TestSuite::Tester {
     explicit QuaternionTest();
 
+    void implementation();
+
     void construct();
     void constructIdentity();
     void constructZero();
@@ -103,7 +105,9 @@ typedef Math::Vector3<Float> Vector3;
 typedef Math::Vector4<Float> Vector4;
 
 QuaternionTest::QuaternionTest() {
-    addTests({&QuaternionTest::construct,
+    addTests({&QuaternionTest::implementation,
+
+              &QuaternionTest::construct,
               &QuaternionTest::constructIdentity,
               &QuaternionTest::constructZero,
               &QuaternionTest::constructNoInit,
@@ -146,6 +150,23 @@ QuaternionTest::QuaternionTest() {
               &QuaternionTest::debug});
 }
 
+void QuaternionTest::implementation() {
+    #if defined(MAGNUM_MATH_SIMD_SSE) || defined(MAGNUM_MATH_SIMD_NEON)
+    constexpr bool simd = true;
+    #else
+    constexpr bool simd = false;
+    #endif
+
+    #ifdef MAGNUM_MATH_SIMD
+    #if !defined(__SSE__) && !defined(_M_X64) && !(defined(_M_IX86_FP) && _M_IX86_FP >= 1) && !defined(__ARM_NEON) && !defined(__ARM_NEON__)
+    CORRADE_SKIP("Neither SSE nor NEON is available on this target.");
+    #endif
+    CORRADE_VERIFY(simd);
+    #else
+    CORRADE_VERIFY(!simd);
+    #endif
+}
+
 void QuaternionTest::construct() {
     constexpr Quaternion a = {{1.0f, 2.0f, 3.0f}, -4.0f};
     CORRADE_COMPARE(a, Quaternion({1.0f, 2.0f, 3.0f}, -4.0f));
@@ -266,25 +287,30 @@ template<class T> void QuaternionTest::isNormalizedEpsilon() {
 }
 
 void QuaternionTest::addSubtract() {
-    Quaternion a({ 1.0f, 3.0f, -2.0f}, -4.0f);
-    Quaternion b({-0.5f, 1.4f,  3.0f}, 12.0f);
-    Quaternion c({ 0.5f, 4.4f,  1.0f},  8.0f);
+    constexpr Quaternion a({ 1.0f, 3.0f, -2.0f}, -4.0f);
+    constexpr Quaternion b({-0.5f, 1.4f,  3.0f}, 12.0f);
+    constexpr Quaternion c({ 0.5f, 4.4f,  1.0f},  8.0f);
 
-    CORRADE_COMPARE(a + b, c);
-    CORRADE_COMPARE(c - b, a);
+    constexpr Quaternion added = a + b;
+    constexpr Quaternion subtracted = c - b;
+    CORRADE_COMPARE(added, c);
+    CORRADE_COMPARE(subtracted, a);
 }
 
 void QuaternionTest::negated() {
-    CORRADE_COMPARE(-Quaternion({1.0f, 2.0f, -3.0f}, -4.0f), Quaternion({-1.0f, -2.0f, 3.0f}, 4.0f));
+    constexpr Quaternion negated = -Quaternion({1.0f, 2.0f, -3.0f}, -4.0f);
+    CORRADE_COMPARE(negated, Quaternion({-1.0f, -2.0f, 3.0f}, 4.0f));
 }
 
 void QuaternionTest::multiplyDivideScalar() {
-    Quaternion a({ 1.0f,  3.0f, -2.0f}, -4.0f);
-    Quaternion b({-1.5f, -4.5f,  3.0f},  6.0f);
+    constexpr Quaternion a({ 1.0f,  3.0f, -2.0f}, -4.0f);
+    constexpr Quaternion b({-1.5f, -4.5f,  3.0f},  6.0f);
 
-    CORRADE_COMPARE(a*-1.5f, b);
+    constexpr Quaternion multiplied = a*-1.5f;
+    constexpr Quaternion divided = b/-1.5f;
+    CORRADE_COMPARE(multiplied, b);
     CORRADE_COMPARE(-1.5f*a, b);
-    CORRADE_COMPARE(b/-1.5f, a);
+    CORRADE_COMPARE(divided, a);
 
     CORRADE_COMPARE(2.0f/a, Quaternion({2.0f, 0.666666f, -1.0f}, -0.5f));
 }
@@ -329,8 +355,8 @@ template<class T> void QuaternionTest::normalizedIterative() {
 }
 
 void QuaternionTest::conjugated() {
-    CORRADE_COMPARE(Quaternion({ 1.0f,  3.0f, -2.0f}, -4.0f).conjugated(),
-                    Quaternion({-1.0f, -3.0f,  2.0f}, -4.0f));
+    constexpr Quaternion conjugated = Quaternion({ 1.0f,  3.0f, -2.0f}, -4.0f).conjugated();
+    CORRADE_COMPARE(conjugated, Quaternion({-1.0f, -3.0f,  2.0f}, -4.0f));
 }
 
 void QuaternionTest::inverted() {
@@ -116,6 +116,7 @@ struct RangeTest: Corrade::TestSuite::Tester {
 
     void contains();
     void join();
+    void intersects();
 
     void subclassTypes();
     void subclass();
@@ -153,6 +154,7 @@ RangeTest::RangeTest() {
 
               &RangeTest::contains,
               &RangeTest::join,
+              &RangeTest::intersects,
 
               &RangeTest::subclassTypes,
               &RangeTest::subclass,
@@ -486,6 +488,21 @@ void RangeTest::join() {
     CORRADE_COMPARE(Math::join(c, a), a);
 }
 
+void RangeTest::intersects() {
+    Range2Di a{{34, 23}, {47, 30}};
+
+    CORRADE_VERIFY(Math::intersects(a, {{40, 20}, {50, 25}}));
+    CORRADE_VERIFY(Math::intersects(a, {{35, 24}, {36, 25}}));
+    CORRADE_VERIFY(Math::intersects(a, {{0, 0}, {100, 100}}));
+
+    /* Touching ranges don't intersect */
+    CORRADE_VERIFY(!Math::intersects(a, {{47, 23}, {50, 30}}));
+    CORRADE_VERIFY(!Math::intersects(a, {{20, 10}, {34, 23}}));
+
+    /* Only one dimension overlapping */
+    CORRADE_VERIFY(!Math::intersects(a, {{40, 31}, {41, 40}}));
+}
+
 template<class T> class BasicRect: public Math::Range<2, T> {
     public:
         template<class ...U> constexpr BasicRect(U&&... args): Math::Range<2, T>{args...} {}
@@ -57,6 +57,8 @@ namespace Test {
 struct RectangularMatrixTest: Corrade::TestSuite::Tester {
     explicit RectangularMatrixTest();
 
+    void implementation();
+
     void construct();
     void constructDefault();
     void constructNoInit();
@@ -109,7 +111,9 @@ typedef Vector<3, Int> Vector3i;
 typedef Vector<2, Int> Vector2i;
 
 RectangularMatrixTest::RectangularMatrixTest() {
-    addTests({&RectangularMatrixTest::construct,
+    addTests({&RectangularMatrixTest::implementation,
+
+              &RectangularMatrixTest::construct,
               &RectangularMatrixTest::constructDefault,
               &RectangularMatrixTest::constructNoInit,
               &RectangularMatrixTest::constructOneValue,
@@ -146,6 +150,23 @@ RectangularMatrixTest::RectangularMatrixTest() {
               &RectangularMatrixTest::configuration});
 }
 
+void RectangularMatrixTest::implementation() {
+    #if defined(MAGNUM_MATH_SIMD_SSE) || defined(MAGNUM_MATH_SIMD_NEON)
+    constexpr bool simd = true;
+    #else
+    constexpr bool simd = false;
+    #endif
+
+    #ifdef MAGNUM_MATH_SIMD
+    #if !defined(__SSE__) && !defined(_M_X64) && !(defined(_M_IX86_FP) && _M_IX86_FP >= 1) && !defined(__ARM_NEON) && !defined(__ARM_NEON__)
+    CORRADE_SKIP("Neither SSE nor NEON is available on this target.");
+    #endif
+    CORRADE_VERIFY(simd);
+    #else
+    CORRADE_VERIFY(!simd);
+    #endif
+}
+
 void RectangularMatrixTest::construct() {
     constexpr Matrix3x4 a = {Vector4(1.0f,  2.0f,  3.0f,  4.0f),
                              Vector4(5.0f,  6.0f,  7.0f,  8.0f),
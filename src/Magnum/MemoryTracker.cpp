@@ -0,0 +1,427 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MemoryTracker.h"
+
+#include <algorithm>
+#include <map>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/TextureFormat.h"
+
+#ifndef MAGNUM_TARGET_GLES
+/* Not in the generated GL headers, the values are in KiB */
+#ifndef GL_GPU_MEMORY_INFO_DEDICATED_VIDMEM_NVX
+#define GL_GPU_MEMORY_INFO_DEDICATED_VIDMEM_NVX 0x9047
+#endif
+#ifndef GL_GPU_MEMORY_INFO_CURRENT_AVAILABLE_VIDMEM_NVX
+#define GL_GPU_MEMORY_INFO_CURRENT_AVAILABLE_VIDMEM_NVX 0x9049
+#endif
+#ifndef GL_TEXTURE_FREE_MEMORY_ATI
+#define GL_TEXTURE_FREE_MEMORY_ATI 0x87FC
+#endif
+#endif
+
+namespace Magnum {
+
+MemoryTracker::MemoryTracker() = default;
+
+MemoryTracker::~MemoryTracker() = default;
+
+std::size_t MemoryTracker::allocationCount() const {
+    std::size_t count = 0;
+    for(const auto& object: _objects) if(object.second.size) ++count;
+    return count;
+}
+
+std::size_t MemoryTracker::allocatedSize(const std::string& label) const {
+    std::size_t size = 0;
+    for(const auto& object: _objects)
+        if(object.second.label == label) size += object.second.size;
+    return size;
+}
+
+MemoryTracker& MemoryTracker::resetPeakAllocatedSize() {
+    _peakAllocatedSize = _allocatedSize;
+    for(std::size_t i = 0; i != 3; ++i)
+        _typePeakAllocatedSize[i] = _typeAllocatedSize[i];
+    return *this;
+}
+
+std::vector<MemoryTracker::Allocation> MemoryTracker::allocations() const {
+    std::vector<Allocation> out;
+    out.reserve(_objects.size());
+    for(const auto& object: _objects) {
+        if(!object.second.size) continue;
+        out.push_back(Allocation{MemoryObjectType(object.first >> 32), GLuint(object.first & 0xffffffffu), object.second.size, object.second.label});
+    }
+
+    /* Largest first, ties sorted by type and ID to have a stable order */
+    std::sort(out.begin(), out.end(), [](const Allocation& a, const Allocation& b) {
+        if(a.size != b.size) return a.size > b.size;
+        if(a.type != b.type) return a.type < b.type;
+        return a.id < b.id;
+    });
+    return out;
+}
+
+void MemoryTracker::printAllocations() const {
+    Debug{} << "Allocated GPU memory:" << _allocatedSize << "bytes, peak" << _peakAllocatedSize << "bytes";
+    for(UnsignedByte i = 0; i != 3; ++i)
+        Debug{} << "   " << MemoryObjectType(i) << Debug::nospace << ":" << _typeAllocatedSize[i] << "bytes, peak" << _typePeakAllocatedSize[i] << "bytes";
+
+    std::map<std::string, std::size_t> labels;
+    for(const auto& object: _objects)
+        if(object.second.size) labels[object.second.label] += object.second.size;
+    if(!labels.empty()) {
+        Debug{} << "Allocated GPU memory by label:";
+        for(const auto& label: labels)
+            Debug{} << "   " << (label.first.empty() ? "(no label)" : label.first) << Debug::nospace << ":" << label.second << "bytes";
+    }
+
+    const std::vector<Allocation> all = allocations();
+    if(!all.empty()) {
+        Debug{} << "GPU memory allocations:";
+        for(const Allocation& allocation: all) {
+            Debug d;
+            d << "   " << allocation.type << allocation.id;
+            if(!allocation.label.empty()) d << allocation.label;
+            d << Debug::nospace << ":" << allocation.size << "bytes";
+        }
+    }
+}
+
+std::size_t MemoryTracker::driverAvailableMemory() const {
+    #ifndef MAGNUM_TARGET_GLES
+    if(Context::current().isExtensionSupported<Extensions::GL::NVX::gpu_memory_info>()) {
+        GLint value{};
+        glGetIntegerv(GL_GPU_MEMORY_INFO_CURRENT_AVAILABLE_VIDMEM_NVX, &value);
+        return std::size_t(value)*1024;
+    }
+
+    if(Context::current().isExtensionSupported<Extensions::GL::ATI::meminfo>()) {
+        /* Total free, largest free block, total auxiliary free, largest
+           auxiliary free block */
+        GLint values[4]{};
+        glGetIntegerv(GL_TEXTURE_FREE_MEMORY_ATI, values);
+        return std::size_t(values[0])*1024;
+    }
+    #endif
+
+    return 0;
+}
+
+std::size_t MemoryTracker::driverTotalMemory() const {
+    /* Get the value, if not already cached */
+    if(_driverTotalMemory == ~std::size_t{}) {
+        _driverTotalMemory = 0;
+
+        #ifndef MAGNUM_TARGET_GLES
+        if(Context::current().isExtensionSupported<Extensions::GL::NVX::gpu_memory_info>()) {
+            GLint value{};
+            glGetIntegerv(GL_GPU_MEMORY_INFO_DEDICATED_VIDMEM_NVX, &value);
+            _driverTotalMemory = std::size_t(value)*1024;
+        }
+        #endif
+    }
+
+    return _driverTotalMemory;
+}
+
+void MemoryTracker::add(const MemoryObjectType type, const std::size_t size) {
+    _allocatedSize += size;
+    _peakAllocatedSize = std::max(_peakAllocatedSize, _allocatedSize);
+    std::size_t& typeSize = _typeAllocatedSize[UnsignedByte(type)];
+    typeSize += size;
+    _typePeakAllocatedSize[UnsignedByte(type)] = std::max(_typePeakAllocatedSize[UnsignedByte(type)], typeSize);
+}
+
+void MemoryTracker::subtract(const MemoryObjectType type, const std::size_t size) {
+    _allocatedSize -= size;
+    _typeAllocatedSize[UnsignedByte(type)] -= size;
+}
+
+void MemoryTracker::setAllocation(const MemoryObjectType type, const GLuint id, const std::size_t size) {
+    setAllocation(type, id, std::vector<std::size_t>{size});
+}
+
+void MemoryTracker::setAllocation(const MemoryObjectType type, const GLuint id, const std::vector<std::size_t>& slotSizes) {
+    Object& object = _objects[key(type, id)];
+
+    /* Subtract the previous allocation first so reallocations don't inflate
+       the peak */
+    subtract(type, object.size);
+    object.slotSizes = slotSizes;
+    object.size = 0;
+    for(std::size_t size: slotSizes) object.size += size;
+    add(type, object.size);
+}
+
+void MemoryTracker::setSlotAllocation(const MemoryObjectType type, const GLuint id, const std::size_t slot, const std::size_t size) {
+    Object& object = _objects[key(type, id)];
+    if(object.slotSizes.size() <= slot) object.slotSizes.resize(slot + 1);
+
+    subtract(type, object.slotSizes[slot]);
+    object.size -= object.slotSizes[slot];
+    object.slotSizes[slot] = size;
+    object.size += size;
+    add(type, size);
+}
+
+void MemoryTracker::setLabel(const MemoryObjectType type, const GLuint id, std::string label) {
+    _objects[key(type, id)].label = std::move(label);
+}
+
+void MemoryTracker::remove(const MemoryObjectType type, const GLuint id) {
+    const auto found = _objects.find(key(type, id));
+    if(found == _objects.end()) return;
+
+    subtract(type, found->second.size);
+    _objects.erase(found);
+}
+
+Float MemoryTracker::pixelSize(const TextureFormat format) {
+    switch(format) {
+        #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+        case TextureFormat::Red:
+        case TextureFormat::R8:
+        #endif
+        #ifndef MAGNUM_TARGET_GLES2
+        case TextureFormat::R8Snorm:
+        case TextureFormat::R8UI:
+        case TextureFormat::R8I:
+        #endif
+        #ifdef MAGNUM_TARGET_GLES2
+        case TextureFormat::Luminance:
+        #endif
+        #ifndef MAGNUM_TARGET_GLES
+        case TextureFormat::R3B3G2:
+        case TextureFormat::RGBA2:
+        #endif
+        #ifndef MAGNUM_TARGET_WEBGL
+        case TextureFormat::StencilIndex8:
+        #endif
+            return 1.0f;
+
+        #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+        case TextureFormat::RG:
+        case TextureFormat::RG8:
+        case TextureFormat::DepthComponent16:
+        #endif
+        #ifndef MAGNUM_TARGET_GLES2
+        case TextureFormat::RG8Snorm:
+        case TextureFormat::RG8UI:
+        case TextureFormat::RG8I:
+        case TextureFormat::R16UI:
+        case TextureFormat::R16I:
+        case TextureFormat::R16F:
+        #endif
+        #ifndef MAGNUM_TARGET_GLES
+        case TextureFormat::R16:
+        case TextureFormat::R16Snorm:
+        case TextureFormat::RGB4:
+        case TextureFormat::RGB5:
+        #endif
+        #ifdef MAGNUM_TARGET_GLES2
+        case TextureFormat::LuminanceAlpha:
+        #endif
+        case TextureFormat::RGB565:
+        case TextureFormat::RGBA4:
+        case TextureFormat::RGB5A1:
+            return 2.0f;
+
+        #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+        case TextureFormat::RGB8:
+        case TextureFormat::SRGB8:
+        #endif
+        #ifndef MAGNUM_TARGET_GLES2
+        case TextureFormat::RGB8Snorm:
+        case TextureFormat::RGB8UI:
+        case TextureFormat::RGB8I:
+        #endif
+            return 3.0f;
+
+        case TextureFormat::RGB:
+        case TextureFormat::RGBA:
+        #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+        case TextureFormat::RGBA8:
+        case TextureFormat::RGB10A2:
+        case TextureFormat::SRGB8Alpha8:
+        case TextureFormat::DepthComponent24:
+        case TextureFormat::Depth24Stencil8:
+        #endif
+        #ifndef MAGNUM_TARGET_GLES2
+        case TextureFormat::RGBA8Snorm:
+        case TextureFormat::RGBA8UI:
+        case TextureFormat::RGBA8I:
+        case TextureFormat::RG16UI:
+        case TextureFormat::RG16I:
+        case TextureFormat::RG16F:
+        case TextureFormat::R32UI:
+        case TextureFormat::R32I:
+        case TextureFormat::R32F:
+        case TextureFormat::R11FG11FB10F:
+        case TextureFormat::RGB9E5:
+        case TextureFormat::RGB10A2UI:
+        case TextureFormat::DepthComponent32F:
+        #endif
+        #ifndef MAGNUM_TARGET_GLES
+        case TextureFormat::RG16:
+        case TextureFormat::RG16Snorm:
+        #endif
+        #if !defined(MAGNUM_TARGET_GLES) || (defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL))
+        case TextureFormat::RGB10:
+        #endif
+        #if !defined(MAGNUM_TARGET_GLES) || defined(MAGNUM_TARGET_GLES2)
+        case TextureFormat::SRGB:
+        case TextureFormat::SRGBAlpha:
+        #endif
+        #ifndef MAGNUM_TARGET_WEBGL
+        case TextureFormat::DepthComponent32:
+        #endif
+        case TextureFormat::DepthComponent:
+        case TextureFormat::DepthStencil:
+            return 4.0f;
+
+        #ifndef MAGNUM_TARGET_GLES2
+        case TextureFormat::RGB16UI:
+        case TextureFormat::RGB16I:
+        case TextureFormat::RGB16F:
+        #endif
+        #ifndef MAGNUM_TARGET_GLES
+        case TextureFormat::RGB16:
+        case TextureFormat::RGB16Snorm:
+        case TextureFormat::RGB12:
+        case TextureFormat::RGBA12:
+        #endif
+            return 6.0f;
+
+        #ifndef MAGNUM_TARGET_GLES2
+        case TextureFormat::RGBA16UI:
+        case TextureFormat::RGBA16I:
+        case TextureFormat::RGBA16F:
+        case TextureFormat::RG32UI:
+        case TextureFormat::RG32I:
+        case TextureFormat::RG32F:
+        case TextureFormat::Depth32FStencil8:
+        #endif
+        #ifndef MAGNUM_TARGET_GLES
+        case TextureFormat::RGBA16:
+        case TextureFormat::RGBA16Snorm:
+        #endif
+            return 8.0f;
+
+        #ifndef MAGNUM_TARGET_GLES2
+        case TextureFormat::RGB32UI:
+        case TextureFormat::RGB32I:
+        case TextureFormat::RGB32F:
+            return 12.0f;
+
+        case TextureFormat::RGBA32UI:
+        case TextureFormat::RGBA32I:
+        case TextureFormat::RGBA32F:
+            return 16.0f;
+        #endif
+
+        /* Compressed formats, 8 or 16 bytes per 4x4 block */
+        #ifndef MAGNUM_TARGET_GLES
+        case TextureFormat::CompressedRedRgtc1:
+        case TextureFormat::CompressedSignedRedRgtc1:
+        #endif
+        #ifndef MAGNUM_TARGET_GLES2
+        case TextureFormat::CompressedRGB8Etc2:
+        case TextureFormat::CompressedSRGB8Etc2:
+        case TextureFormat::CompressedRGB8PunchthroughAlpha1Etc2:
+        case TextureFormat::CompressedSRGB8PunchthroughAlpha1Etc2:
+        case TextureFormat::CompressedR11Eac:
+        case TextureFormat::CompressedSignedR11Eac:
+        #endif
+        case TextureFormat::CompressedRGBS3tcDxt1:
+        case TextureFormat::CompressedRGBAS3tcDxt1:
+            return 0.5f;
+
+        #ifndef MAGNUM_TARGET_GLES
+        case TextureFormat::CompressedRGRgtc2:
+        case TextureFormat::CompressedSignedRGRgtc2:
+        case TextureFormat::CompressedRGBBptcUnsignedFloat:
+        case TextureFormat::CompressedRGBBptcSignedFloat:
+        case TextureFormat::CompressedRGBABptcUnorm:
+        case TextureFormat::CompressedSRGBAlphaBptcUnorm:
+        #endif
+        #ifndef MAGNUM_TARGET_GLES2
+        case TextureFormat::CompressedRGBA8Etc2Eac:
+        case TextureFormat::CompressedSRGB8Alpha8Etc2Eac:
+        case TextureFormat::CompressedRG11Eac:
+        case TextureFormat::CompressedSignedRG11Eac:
+        #endif
+        case TextureFormat::CompressedRGBAS3tcDxt3:
+        case TextureFormat::CompressedRGBAS3tcDxt5:
+            return 1.0f;
+
+        /* ASTC, 16 bytes per block of varying size */
+        #ifndef MAGNUM_TARGET_WEBGL
+        #define _c(size, area)                                              \
+            case TextureFormat::CompressedRGBAAstc ## size:                 \
+            case TextureFormat::CompressedSRGB8Alpha8Astc ## size:          \
+                return 16.0f/area;
+        _c(4x4, 16)
+        _c(5x4, 20)
+        _c(5x5, 25)
+        _c(6x5, 30)
+        _c(6x6, 36)
+        _c(8x5, 40)
+        _c(8x6, 48)
+        _c(8x8, 64)
+        _c(10x5, 50)
+        _c(10x6, 60)
+        _c(10x8, 80)
+        _c(10x10, 100)
+        _c(12x10, 120)
+        _c(12x12, 144)
+        #undef _c
+        #endif
+
+        /* Generic compressed formats and anything not listed above */
+        default: return 4.0f;
+    }
+}
+
+Debug& operator<<(Debug& debug, const MemoryObjectType value) {
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case MemoryObjectType::value: return debug << "MemoryObjectType::" #value;
+        _c(Buffer)
+        _c(Texture)
+        _c(Renderbuffer)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "MemoryObjectType(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
+}
+
+}
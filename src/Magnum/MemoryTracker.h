@@ -0,0 +1,264 @@
+#ifndef Magnum_MemoryTracker_h
+#define Magnum_MemoryTracker_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::MemoryTracker, enum @ref Magnum::MemoryObjectType
+ */
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/OpenGL.h"
+#include "Magnum/visibility.h"
+
+namespace Magnum {
+
+/**
+@brief Tracked GPU memory object type
+
+@see @ref MemoryTracker
+*/
+enum class MemoryObjectType: UnsignedByte {
+    Buffer = 0,         /**< @ref Magnum::Buffer "Buffer" */
+    Texture = 1,        /**< Any texture */
+    Renderbuffer = 2    /**< @ref Magnum::Renderbuffer "Renderbuffer" */
+};
+
+/** @debugoperatorenum{Magnum::MemoryObjectType} */
+MAGNUM_EXPORT Debug& operator<<(Debug& debug, MemoryObjectType value);
+
+/**
+@brief GPU memory allocation tracker
+
+Keeps track of GPU memory allocated through @ref Buffer::setData(),
+@ref Buffer::setStorage(), @ref Texture::setStorage() "*Texture::setStorage()",
+@ref Texture::setImage() "*Texture::setImage()",
+@ref Texture::setCompressedImage() "*Texture::setCompressedImage()",
+@ref Renderbuffer::setStorage() and @ref Renderbuffer::setStorageMultisample().
+The allocations are released again when the object is destroyed. There is one
+instance per context, accessible through @ref Context::memoryTracker():
+
+@snippet Magnum.cpp MemoryTracker-usage
+
+Each allocation is recorded together with the object label set through
+@ref Buffer::setLabel(), @ref AbstractTexture::setLabel() "*Texture::setLabel()"
+or @ref Renderbuffer::setLabel(), so the totals can be split not only by
+@ref MemoryObjectType, but also by purpose.
+
+@section MemoryTracker-estimates Size estimates
+
+Buffer sizes are exact. Texture and renderbuffer sizes are calculated from the
+internal format, image size, sample count and number of mip levels and are
+only an estimate --- the driver may pad rows, align levels, add compression
+metadata or store formats such as @ref TextureFormat::RGB8 with four bytes per
+pixel. Unsized formats such as @ref TextureFormat::RGBA are counted with four
+bytes per pixel. Compressed images uploaded with
+@ref Texture::setCompressedImage() "*Texture::setCompressedImage()" are counted
+by their actual data size.
+
+Objects created outside of Magnum and wrapped using @ref Buffer::wrap() and
+similar are tracked only once their storage is allocated through Magnum.
+Objects that are not deleted on destruction (for example after
+@ref Buffer::release()) stay tracked, as the GL object is still alive.
+
+@section MemoryTracker-driver Driver-reported memory
+
+Independently of the tracked allocations, @ref driverAvailableMemory() and
+@ref driverTotalMemory() query the memory reported by the driver using
+@extension{NVX,gpu_memory_info} or @extension{ATI,meminfo}. Use them to drive
+streaming budgets. Note that the reported values are for the whole GPU,
+including other applications.
+*/
+class MAGNUM_EXPORT MemoryTracker {
+    public:
+        /**
+         * @brief Allocation
+         *
+         * @see @ref allocations()
+         */
+        struct Allocation {
+            /** @brief Object type */
+            MemoryObjectType type;
+
+            /** @brief OpenGL object ID */
+            GLuint id;
+
+            /** @brief Allocated size in bytes */
+            std::size_t size;
+
+            /** @brief Object label or empty string if no label is set */
+            std::string label;
+        };
+
+        /**
+         * @brief Constructor
+         *
+         * Used internally by @ref Context, use @ref Context::memoryTracker()
+         * to access the instance for current context.
+         */
+        explicit MemoryTracker();
+
+        /** @brief Copying is not allowed */
+        MemoryTracker(const MemoryTracker&) = delete;
+
+        /** @brief Moving is not allowed */
+        MemoryTracker(MemoryTracker&&) = delete;
+
+        ~MemoryTracker();
+
+        /** @brief Copying is not allowed */
+        MemoryTracker& operator=(const MemoryTracker&) = delete;
+
+        /** @brief Moving is not allowed */
+        MemoryTracker& operator=(MemoryTracker&&) = delete;
+
+        /** @brief Count of objects with allocated memory */
+        std::size_t allocationCount() const;
+
+        /**
+         * @brief Total allocated size in bytes
+         *
+         * @see @ref peakAllocatedSize()
+         */
+        std::size_t allocatedSize() const { return _allocatedSize; }
+
+        /** @brief Allocated size of given object type in bytes */
+        std::size_t allocatedSize(MemoryObjectType type) const {
+            return _typeAllocatedSize[UnsignedByte(type)];
+        }
+
+        /**
+         * @brief Allocated size of objects with given label in bytes
+         *
+         * Objects without label are counted for an empty @p label.
+         */
+        std::size_t allocatedSize(const std::string& label) const;
+
+        /**
+         * @brief Peak total allocated size in bytes
+         *
+         * The high-water mark since the tracker creation or since the last
+         * call to @ref resetPeakAllocatedSize().
+         */
+        std::size_t peakAllocatedSize() const { return _peakAllocatedSize; }
+
+        /** @brief Peak allocated size of given object type in bytes */
+        std::size_t peakAllocatedSize(MemoryObjectType type) const {
+            return _typePeakAllocatedSize[UnsignedByte(type)];
+        }
+
+        /**
+         * @brief Reset the high-water marks
+         * @return Reference to self (for method chaining)
+         *
+         * Sets all peak values to the current allocated sizes.
+         */
+        MemoryTracker& resetPeakAllocatedSize();
+
+        /**
+         * @brief All allocations
+         *
+         * Sorted by size, largest first.
+         */
+        std::vector<Allocation> allocations() const;
+
+        /**
+         * @brief Print a summary of all allocations
+         *
+         * Prints totals and peaks per object type, totals per label and then
+         * all allocations sorted by size.
+         */
+        void printAllocations() const;
+
+        /**
+         * @brief Available GPU memory reported by the driver
+         *
+         * Returns currently available dedicated video memory queried using
+         * @extension{NVX,gpu_memory_info} or free texture memory queried
+         * using @extension{ATI,meminfo}, in bytes. If neither extension is
+         * available, returns `0`. The value is not cached, each call results
+         * in an OpenGL query.
+         * @requires_gl Driver memory queries are not available in OpenGL ES
+         *      or WebGL, the function always returns `0` there.
+         */
+        std::size_t driverAvailableMemory() const;
+
+        /**
+         * @brief Total GPU memory reported by the driver
+         *
+         * Returns total dedicated video memory queried using
+         * @extension{NVX,gpu_memory_info}, in bytes. @extension{ATI,meminfo}
+         * doesn't provide the total size, so if it's the only extension
+         * available or if neither is available, returns `0`. The value is
+         * queried only once and cached.
+         * @requires_gl Driver memory queries are not available in OpenGL ES
+         *      or WebGL, the function always returns `0` there.
+         */
+        std::size_t driverTotalMemory() const;
+
+        #ifndef DOXYGEN_GENERATING_OUTPUT
+        /* Used internally by Buffer, AbstractTexture and Renderbuffer. The
+           slots are used by textures to track levels and cube map faces
+           separately, setAllocation() replaces all of them. */
+        void setAllocation(MemoryObjectType type, GLuint id, std::size_t size);
+        void setAllocation(MemoryObjectType type, GLuint id, const std::vector<std::size_t>& slotSizes);
+        void setSlotAllocation(MemoryObjectType type, GLuint id, std::size_t slot, std::size_t size);
+        void setLabel(MemoryObjectType type, GLuint id, std::string label);
+        void remove(MemoryObjectType type, GLuint id);
+
+        /* Estimated size of a pixel in given format, in bytes. Used by
+           AbstractTexture and Renderbuffer. */
+        static Float pixelSize(TextureFormat format);
+        #endif
+
+    private:
+        struct Object {
+            std::vector<std::size_t> slotSizes;
+            std::size_t size{};
+            std::string label;
+        };
+
+        static UnsignedLong key(MemoryObjectType type, GLuint id) {
+            return UnsignedLong(type) << 32 | id;
+        }
+
+        MAGNUM_LOCAL void add(MemoryObjectType type, std::size_t size);
+        MAGNUM_LOCAL void subtract(MemoryObjectType type, std::size_t size);
+
+        std::unordered_map<UnsignedLong, Object> _objects;
+        std::size_t _allocatedSize{},
+            _peakAllocatedSize{},
+            _typeAllocatedSize[3]{},
+            _typePeakAllocatedSize[3]{};
+        mutable std::size_t _driverTotalMemory{~std::size_t{}};
+};
+
+}
+
+#endif
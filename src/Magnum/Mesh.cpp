@@ -59,6 +59,52 @@ struct Mesh::AttributeLayout {
     GLuint divisor;
 };
 
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+struct Mesh::SharedVertexBinding {
+    GLuint buffer;
+    GLintptr offset;
+    GLsizei stride;
+    GLuint divisor;
+};
+
+namespace {
+
+/* Size of a tightly packed attribute, used for converting zero stride to
+   what glBindVertexBuffer() expects */
+GLsizei attributeSize(GLint size, const GLenum type) {
+    #ifndef MAGNUM_TARGET_GLES
+    if(size == GL_BGRA) size = 4;
+    #endif
+
+    switch(type) {
+        case GL_UNSIGNED_INT_2_10_10_10_REV:
+        case GL_INT_2_10_10_10_REV:
+        #ifndef MAGNUM_TARGET_GLES
+        case GL_UNSIGNED_INT_10F_11F_11F_REV:
+        #endif
+            return 4;
+        case GL_UNSIGNED_BYTE:
+        case GL_BYTE:
+            return size;
+        case GL_UNSIGNED_SHORT:
+        case GL_SHORT:
+        case GL_HALF_FLOAT:
+            return 2*size;
+        #ifndef MAGNUM_TARGET_GLES
+        case GL_DOUBLE:
+            return 8*size;
+        #endif
+    }
+
+    return 4*size;
+}
+
+/* Minimal required value of GL_MAX_VERTEX_ATTRIB_RELATIVE_OFFSET */
+constexpr GLintptr MaxRelativeOffset = 2047;
+
+}
+#endif
+
 #ifndef MAGNUM_TARGET_GLES2
 #ifndef MAGNUM_TARGET_WEBGL
 Long Mesh::maxElementIndex()
@@ -111,6 +157,12 @@ Int Mesh::maxElementsVertices() {
 }
 #endif
 
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+Int Mesh::sharedVertexFormatCount() {
+    return Context::current().state().mesh->sharedVertexFormats.size();
+}
+#endif
+
 std::size_t Mesh::indexSize(IndexType type) {
     switch(type) {
         case IndexType::UnsignedByte: return 1;
@@ -121,6 +173,16 @@ std::size_t Mesh::indexSize(IndexType type) {
     CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
 }
 
+UnsignedInt Mesh::primitiveRestartIndex(IndexType type) {
+    switch(type) {
+        case IndexType::UnsignedByte: return 0xffu;
+        case IndexType::UnsignedShort: return 0xffffu;
+        case IndexType::UnsignedInt: return 0xffffffffu;
+    }
+
+    CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
 Mesh::Mesh(const MeshPrimitive primitive): _primitive{primitive}, _flags{ObjectFlag::DeleteOnDestruction}, _count{0}, _baseVertex{0}, _instanceCount{1},
     #ifndef MAGNUM_TARGET_GLES
     _baseInstance{0},
@@ -129,6 +191,9 @@ Mesh::Mesh(const MeshPrimitive primitive): _primitive{primitive}, _flags{ObjectF
     _indexStart(0), _indexEnd(0),
     #endif
     _indexOffset(0), _indexType(IndexType::UnsignedInt), _indexBuffer(nullptr)
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    , _vertexFormatShared{false}, _sharedVertexFormat{-1}
+    #endif
 {
     (this->*Context::current().state().mesh->createImplementation)();
 }
@@ -140,7 +205,11 @@ Mesh::Mesh(NoCreateT) noexcept: _id{0}, _primitive{MeshPrimitive::Triangles}, _f
     #ifndef MAGNUM_TARGET_GLES2
     _indexStart(0), _indexEnd(0),
     #endif
-    _indexOffset(0), _indexType(IndexType::UnsignedInt), _indexBuffer(nullptr) {}
+    _indexOffset(0), _indexType(IndexType::UnsignedInt), _indexBuffer(nullptr)
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    , _vertexFormatShared{false}, _sharedVertexFormat{-1}
+    #endif
+    {}
 
 Mesh::~Mesh() {
     /* Moved out or not deleting on destruction, nothing to do */
@@ -161,6 +230,9 @@ Mesh::Mesh(Mesh&& other) noexcept: _id(other._id), _primitive(other._primitive),
     _indexStart(other._indexStart), _indexEnd(other._indexEnd),
     #endif
     _indexOffset(other._indexOffset), _indexType(other._indexType), _indexBuffer(other._indexBuffer), _attributes(std::move(other._attributes))
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    , _vertexFormatShared{other._vertexFormatShared}, _sharedVertexFormat{other._sharedVertexFormat}, _sharedVertexBindings(std::move(other._sharedVertexBindings))
+    #endif
 {
     other._id = 0;
 }
@@ -184,11 +256,20 @@ Mesh& Mesh::operator=(Mesh&& other) noexcept {
     swap(_indexType, other._indexType);
     swap(_indexBuffer, other._indexBuffer);
     swap(_attributes, other._attributes);
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    swap(_vertexFormatShared, other._vertexFormatShared);
+    swap(_sharedVertexFormat, other._sharedVertexFormat);
+    swap(_sharedVertexBindings, other._sharedVertexBindings);
+    #endif
 
     return *this;
 }
 
-Mesh::Mesh(const GLuint id, const MeshPrimitive primitive, const ObjectFlags flags): _id{id}, _primitive{primitive}, _flags{flags} {}
+Mesh::Mesh(const GLuint id, const MeshPrimitive primitive, const ObjectFlags flags): _id{id}, _primitive{primitive}, _flags{flags}
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    , _vertexFormatShared{false}, _sharedVertexFormat{-1}
+    #endif
+    {}
 
 inline void Mesh::createIfNotAlready() {
     /* If VAO extension is not available, the following is always true */
@@ -223,6 +304,31 @@ Mesh& Mesh::setLabelInternal(const Containers::ArrayView<const char> label) {
 }
 #endif
 
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+Mesh& Mesh::shareVertexFormat() {
+    #ifndef MAGNUM_TARGET_GLES
+    CORRADE_ASSERT(Context::current().isExtensionSupported<Extensions::GL::ARB::vertex_attrib_binding>() && Context::current().isExtensionSupported<Extensions::GL::ARB::vertex_array_object>(),
+        "Mesh::shareVertexFormat():" << Extensions::GL::ARB::vertex_attrib_binding::string() << "is not supported", *this);
+    #else
+    CORRADE_ASSERT(Context::current().isVersionSupported(Version::GLES310),
+        "Mesh::shareVertexFormat(): OpenGL ES 3.1 is not supported", *this);
+    #endif
+
+    if(_vertexFormatShared) return *this;
+
+    /* The own VAO is not needed anymore */
+    if(_id && (_flags & ObjectFlag::DeleteOnDestruction)) {
+        GLuint& current = Context::current().state().mesh->currentVAO;
+        if(current == _id) current = 0;
+        (this->*Context::current().state().mesh->destroyImplementation)();
+    }
+
+    _id = 0;
+    _vertexFormatShared = true;
+    return *this;
+}
+#endif
+
 Mesh& Mesh::addVertexBufferInstanced(Buffer& buffer, const UnsignedInt divisor, const GLintptr offset, const GLsizei stride, const DynamicAttribute& attribute) {
     AttributeLayout l{buffer,
         attribute.location(),
@@ -379,6 +485,10 @@ void Mesh::drawInternal(Int count, Int baseVertex, Int instanceCount, GLintptr i
         }
     }
 
+    #ifdef MAGNUM_BUILD_STATISTICS
+    ++Context::current().statisticsInternal().drawCallCount;
+    #endif
+
     (this->*state.unbindImplementation)();
 }
 
@@ -405,6 +515,10 @@ void Mesh::drawInternal(TransformFeedback& xfb, const UnsignedInt stream, const
         else glDrawTransformFeedbackStreamInstanced(GLenum(_primitive), xfb.id(), stream, instanceCount);
     }
 
+    #ifdef MAGNUM_BUILD_STATISTICS
+    ++Context::current().statisticsInternal().drawCallCount;
+    #endif
+
     (this->*state.unbindImplementation)();
 }
 
@@ -418,6 +532,89 @@ void Mesh::draw(AbstractShaderProgram& shader, TransformFeedback& xfb, UnsignedI
 }
 #endif
 
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+void Mesh::drawIndirect(AbstractShaderProgram& shader, Buffer& buffer, const GLintptr offset) {
+    const Implementation::MeshState& state = *Context::current().state().mesh;
+
+    shader.use();
+
+    buffer.bindInternal(Buffer::TargetHint::DrawIndirect);
+    (this->*state.bindImplementation)();
+
+    /* Non-indexed mesh */
+    if(!_indexBuffer)
+        glDrawArraysIndirect(GLenum(_primitive), reinterpret_cast<const GLvoid*>(offset));
+
+    /* Indexed mesh */
+    else
+        glDrawElementsIndirect(GLenum(_primitive), GLenum(_indexType), reinterpret_cast<const GLvoid*>(offset));
+
+    #ifdef MAGNUM_BUILD_STATISTICS
+    ++Context::current().statisticsInternal().drawCallCount;
+    #endif
+
+    (this->*state.unbindImplementation)();
+}
+
+#ifndef MAGNUM_TARGET_GLES
+void Mesh::drawIndirect(AbstractShaderProgram& shader, Buffer& buffer, const GLintptr offset, const Int drawCount, const GLsizei stride) {
+    /* Nothing to draw, exit without touching any state */
+    if(!drawCount) return;
+
+    const Implementation::MeshState& state = *Context::current().state().mesh;
+
+    shader.use();
+
+    buffer.bindInternal(Buffer::TargetHint::DrawIndirect);
+    (this->*state.bindImplementation)();
+
+    /* Non-indexed meshes */
+    if(!_indexBuffer)
+        glMultiDrawArraysIndirect(GLenum(_primitive), reinterpret_cast<const GLvoid*>(offset), drawCount, stride);
+
+    /* Indexed meshes */
+    else
+        glMultiDrawElementsIndirect(GLenum(_primitive), GLenum(_indexType), reinterpret_cast<const GLvoid*>(offset), drawCount, stride);
+
+    #ifdef MAGNUM_BUILD_STATISTICS
+    ++Context::current().statisticsInternal().drawCallCount;
+    #endif
+
+    (this->*state.unbindImplementation)();
+}
+
+void Mesh::drawIndirect(AbstractShaderProgram& shader, Buffer& buffer, const GLintptr offset, Buffer& countBuffer, const GLintptr countOffset, const Int maxDrawCount, const GLsizei stride) {
+    CORRADE_ASSERT(countOffset % 4 == 0,
+        "Mesh::drawIndirect(): count offset" << countOffset << "is not a multiple of 4", );
+
+    /* Nothing to draw, exit without touching any state */
+    if(!maxDrawCount) return;
+
+    const Implementation::MeshState& state = *Context::current().state().mesh;
+
+    shader.use();
+
+    buffer.bindInternal(Buffer::TargetHint::DrawIndirect);
+    countBuffer.bindInternal(Buffer::TargetHint::Parameter);
+    (this->*state.bindImplementation)();
+
+    /* Non-indexed meshes */
+    if(!_indexBuffer)
+        glMultiDrawArraysIndirectCount(GLenum(_primitive), reinterpret_cast<const GLvoid*>(offset), countOffset, maxDrawCount, stride);
+
+    /* Indexed meshes */
+    else
+        glMultiDrawElementsIndirectCount(GLenum(_primitive), GLenum(_indexType), reinterpret_cast<const GLvoid*>(offset), countOffset, maxDrawCount, stride);
+
+    #ifdef MAGNUM_BUILD_STATISTICS
+    ++Context::current().statisticsInternal().drawCallCount;
+    #endif
+
+    (this->*state.unbindImplementation)();
+}
+#endif
+#endif
+
 void Mesh::bindVAOImplementationDefault(GLuint) {}
 
 void Mesh::bindVAOImplementationVAO(const GLuint id) {
@@ -475,6 +672,16 @@ void Mesh::attributePointerInternal(const Buffer& buffer, const GLuint location,
 }
 
 void Mesh::attributePointerInternal(AttributeLayout& attribute) {
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    /* With shared format the attributes are only recorded, the format is
+       resolved on first draw */
+    if(_vertexFormatShared) {
+        _attributes.push_back(attribute);
+        _sharedVertexFormat = -1;
+        return;
+    }
+    #endif
+
     (this->*Context::current().state().mesh->attributePointerImplementation)(attribute);
 }
 
@@ -571,6 +778,11 @@ void Mesh::vertexAttribDivisorImplementationNV(const GLuint index, const GLuint
 void Mesh::bindIndexBufferImplementationDefault(Buffer&) {}
 
 void Mesh::bindIndexBufferImplementationVAO(Buffer& buffer) {
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    /* Index buffer of meshes with shared format is bound on every draw */
+    if(_vertexFormatShared) return;
+    #endif
+
     bindVAO();
 
     /* Reset ElementArray binding to force explicit glBindBuffer call later */
@@ -590,6 +802,13 @@ void Mesh::bindImplementationDefault() {
 }
 
 void Mesh::bindImplementationVAO() {
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    if(_vertexFormatShared) {
+        bindSharedVertexFormat();
+        return;
+    }
+    #endif
+
     bindVAO();
 }
 
@@ -600,6 +819,88 @@ void Mesh::unbindImplementationDefault() {
 
 void Mesh::unbindImplementationVAO() {}
 
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+void Mesh::resolveSharedVertexFormat() {
+    Implementation::MeshState& state = *Context::current().state().mesh;
+
+    /* Group the attributes into buffer bindings. Attributes from the same
+       buffer with the same stride and divisor which are close enough to each
+       other share one binding, the offset of first attribute is the base
+       offset of the binding. */
+    Implementation::SharedVertexFormat format;
+    _sharedVertexBindings.clear();
+    for(const AttributeLayout& attribute: _attributes) {
+        const GLsizei stride = attribute.stride ? attribute.stride : attributeSize(attribute.size, attribute.type);
+
+        std::size_t binding = 0;
+        for(; binding != _sharedVertexBindings.size(); ++binding) {
+            const SharedVertexBinding& b = _sharedVertexBindings[binding];
+            if(b.buffer == attribute.buffer.id() && b.stride == stride && b.divisor == attribute.divisor && attribute.offset >= b.offset && attribute.offset - b.offset <= MaxRelativeOffset)
+                break;
+        }
+        if(binding == _sharedVertexBindings.size()) {
+            _sharedVertexBindings.push_back({attribute.buffer.id(), attribute.offset, stride, attribute.divisor});
+            format.divisors.push_back(attribute.divisor);
+        }
+
+        format.attributes.push_back({attribute.location, GLuint(binding), GLuint(attribute.offset - _sharedVertexBindings[binding].offset), attribute.size, attribute.type, attribute.kind});
+    }
+
+    /* Find an existing format */
+    for(std::size_t i = 0; i != state.sharedVertexFormats.size(); ++i) {
+        const Implementation::SharedVertexFormat& other = state.sharedVertexFormats[i];
+        if(other.attributes == format.attributes && other.divisors == format.divisors) {
+            _sharedVertexFormat = i;
+            return;
+        }
+    }
+
+    /* Not found, create a new VAO for it */
+    glGenVertexArrays(1, &format.vao);
+    bindVAOImplementationVAO(format.vao);
+    for(const Implementation::SharedVertexFormat::Attribute& attribute: format.attributes) {
+        glEnableVertexAttribArray(attribute.location);
+
+        if(attribute.kind == DynamicAttribute::Kind::Integral)
+            glVertexAttribIFormat(attribute.location, attribute.size, attribute.type, attribute.relativeOffset);
+        #ifndef MAGNUM_TARGET_GLES
+        else if(attribute.kind == DynamicAttribute::Kind::Long)
+            glVertexAttribLFormat(attribute.location, attribute.size, attribute.type, attribute.relativeOffset);
+        #endif
+        else glVertexAttribFormat(attribute.location, attribute.size, attribute.type, attribute.kind == DynamicAttribute::Kind::GenericNormalized, attribute.relativeOffset);
+
+        glVertexAttribBinding(attribute.location, attribute.binding);
+    }
+    for(std::size_t i = 0; i != format.divisors.size(); ++i)
+        if(format.divisors[i]) glVertexBindingDivisor(i, format.divisors[i]);
+
+    _sharedVertexFormat = state.sharedVertexFormats.size();
+    state.sharedVertexFormats.push_back(std::move(format));
+}
+
+void Mesh::bindSharedVertexFormat() {
+    if(_sharedVertexFormat == -1) resolveSharedVertexFormat();
+
+    /* Bind the shared VAO, if not already */
+    Implementation::MeshState& state = *Context::current().state().mesh;
+    const GLuint vao = state.sharedVertexFormats[_sharedVertexFormat].vao;
+    if(state.currentVAO != vao) bindVAOImplementationVAO(vao);
+
+    /* Only the buffers are specified per-mesh */
+    for(std::size_t i = 0; i != _sharedVertexBindings.size(); ++i) {
+        const SharedVertexBinding& binding = _sharedVertexBindings[i];
+        glBindVertexBuffer(i, binding.buffer, binding.offset, binding.stride);
+    }
+
+    /* Index buffer binding is part of the VAO state, so it has to be rebound
+       and the state tracker reset to force explicit glBindBuffer() call */
+    if(_indexBuffer) {
+        Context::current().state().buffer->bindings[Implementation::BufferState::indexForTarget(Buffer::TargetHint::ElementArray)] = 0;
+        _indexBuffer->bindInternal(Buffer::TargetHint::ElementArray);
+    }
+}
+#endif
+
 #ifdef MAGNUM_TARGET_GLES2
 void Mesh::drawArraysInstancedImplementationANGLE(const GLint baseVertex, const GLsizei count, const GLsizei instanceCount) {
     glDrawArraysInstancedANGLE(GLenum(_primitive), baseVertex, count, instanceCount);
@@ -233,8 +233,41 @@ documentation of @ref addVertexBuffer() for more information.
 If index range is specified in @ref setIndexBuffer(), range-based version of
 drawing commands are used on desktop OpenGL and OpenGL ES 3.0. See also
 @ref draw() for more information.
+
+@subsection Mesh-performance-optimization-shared-format Sharing vertex format
+
+Each mesh by default owns a VAO with full attribute pointer specification, so
+many meshes with a common vertex layout will result in many equivalent VAOs
+and each switch between them is a full vertex input state change. If
+@extension{ARB,vertex_attrib_binding} (part of OpenGL 4.3) or OpenGL ES 3.1 is
+available, you can call @ref shareVertexFormat() right after constructing the
+mesh. The mesh then doesn't own any VAO and instead uses one VAO shared by all
+meshes with the same vertex format. Drawing such mesh then means only binding
+the shared VAO (skipped if it's already bound) and then calling
+@fn_gl_keyword{BindVertexBuffer} for each vertex buffer and
+@fn_gl{BindBuffer} for the index buffer:
+
+@code{.cpp}
+Mesh a, b;
+a.shareVertexFormat()
+    .addVertexBuffer(vertices, 0, Shaders::Phong::Position{},
+                                  Shaders::Phong::Normal{});
+b.shareVertexFormat()
+    .addVertexBuffer(vertices, 2048*24, Shaders::Phong::Position{},
+                                        Shaders::Phong::Normal{});
+
+// Prints 1
+Debug{} << Mesh::sharedVertexFormatCount();
+@endcode
+
+Attributes coming from the same buffer with the same stride and divisor are
+put into a single buffer binding, only the base offset and stride are then
+specified per-mesh. Thus meshes differing only in buffers or offsets into
+them still share the format.
  */
 class MAGNUM_EXPORT Mesh: public AbstractObject {
+    friend DeletionQueue;
+    friend DrawPacket;
     friend MeshView;
     friend Implementation::MeshState;
 
@@ -307,6 +340,21 @@ class MAGNUM_EXPORT Mesh: public AbstractObject {
         static Int maxElementsVertices();
         #endif
 
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        /**
+         * @brief Count of shared vertex formats
+         *
+         * Count of distinct vertex formats (and thus VAOs) created for meshes
+         * with @ref shareVertexFormat() enabled in current context. The
+         * formats are created lazily on first draw of a mesh.
+         * @see @ref Mesh-performance-optimization-shared-format
+         * @requires_gles31 Vertex attribute binding is not available in
+         *      OpenGL ES 3.0 and older.
+         * @requires_gles Vertex attribute binding is not available in WebGL.
+         */
+        static Int sharedVertexFormatCount();
+        #endif
+
         /**
          * @brief Size of given index type
          *
@@ -314,6 +362,18 @@ class MAGNUM_EXPORT Mesh: public AbstractObject {
          */
         static std::size_t indexSize(IndexType type);
 
+        /**
+         * @brief Primitive restart index for given index type
+         *
+         * Maximal value representable by given index type, i.e. @cpp 0xff @ce,
+         * @cpp 0xffff @ce or @cpp 0xffffffff @ce. If
+         * @ref Renderer::Feature::PrimitiveRestartFixedIndex is enabled, this
+         * index in the index buffer ends the current primitive and starts a
+         * new one.
+         * @see @ref primitiveRestartIndex() const, @ref MeshTools::stripify()
+         */
+        static UnsignedInt primitiveRestartIndex(IndexType type);
+
         /**
          * @brief Wrap existing OpenGL vertex array object
          * @param id            OpenGL vertex array ID
@@ -398,7 +458,8 @@ class MAGNUM_EXPORT Mesh: public AbstractObject {
          * If neither @extension{ARB,vertex_array_object} (part of OpenGL 3.0)
          * nor OpenGL ES 3.0 / WebGL 2.0 nor @extension{OES,vertex_array_object}
          * in OpenGL ES 2.0 / @webgl_extension{OES,vertex_array_object} in
-         * WebGL 1.0 is available, returns `0`.
+         * WebGL 1.0 is available, returns `0`. Returns `0` also if
+         * @ref shareVertexFormat() was called.
          */
         GLuint id() const { return _id; }
 
@@ -457,6 +518,40 @@ class MAGNUM_EXPORT Mesh: public AbstractObject {
         }
         #endif
 
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        /**
+         * @brief Whether the vertex format is shared with other meshes
+         *
+         * @see @ref shareVertexFormat()
+         * @requires_gles31 Vertex attribute binding is not available in
+         *      OpenGL ES 3.0 and older.
+         * @requires_gles Vertex attribute binding is not available in WebGL.
+         */
+        bool isVertexFormatShared() const { return _vertexFormatShared; }
+
+        /**
+         * @brief Share vertex format with other meshes
+         * @return Reference to self (for method chaining)
+         *
+         * Deletes the VAO owned by this mesh and instead uses a VAO shared by
+         * all meshes with the same vertex format, see
+         * @ref Mesh-performance-optimization-shared-format for more
+         * information. Has to be called before any vertex or index buffer is
+         * added, it's not possible to disable the sharing later. Because the
+         * mesh doesn't own any VAO afterwards, @ref id() returns `0` and
+         * @ref label() / @ref setLabel() can't be used.
+         * @see @ref isVertexFormatShared(), @ref sharedVertexFormatCount(),
+         *      @fn_gl_keyword{VertexAttribFormat},
+         *      @fn_gl_keyword{VertexAttribBinding},
+         *      @fn_gl_keyword{VertexBindingDivisor}
+         * @requires_gl43 Extension @extension{ARB,vertex_attrib_binding}
+         * @requires_gles31 Vertex attribute binding is not available in
+         *      OpenGL ES 3.0 and older.
+         * @requires_gles Vertex attribute binding is not available in WebGL.
+         */
+        Mesh& shareVertexFormat();
+        #endif
+
         /**
          * @brief Whether the mesh is indexed
          *
@@ -471,6 +566,15 @@ class MAGNUM_EXPORT Mesh: public AbstractObject {
          */
         std::size_t indexSize() const { return indexSize(_indexType); }
 
+        /**
+         * @brief Primitive restart index
+         *
+         * @see @ref primitiveRestartIndex(IndexType)
+         */
+        UnsignedInt primitiveRestartIndex() const {
+            return primitiveRestartIndex(_indexType);
+        }
+
         /** @brief Primitive type */
         MeshPrimitive primitive() const { return _primitive; }
 
@@ -758,7 +862,7 @@ class MAGNUM_EXPORT Mesh: public AbstractObject {
          * @see @ref setCount(), @ref setInstanceCount(),
          *      @ref draw(AbstractShaderProgram&, TransformFeedback&, UnsignedInt),
          *      @ref MeshView::draw(AbstractShaderProgram&),
-         *      @ref MeshView::draw(AbstractShaderProgram&, std::initializer_list<std::reference_wrapper<MeshView>>),
+         *      @ref MeshView::draw(AbstractShaderProgram&, Containers::ArrayView<const std::reference_wrapper<MeshView>>),
          *      @fn_gl_keyword{UseProgram}, @fn_gl_keyword{EnableVertexAttribArray},
          *      @fn_gl{BindBuffer}, @fn_gl_keyword{VertexAttribPointer},
          *      @fn_gl_keyword{DisableVertexAttribArray} or @fn_gl_keyword{BindVertexArray},
@@ -824,8 +928,112 @@ class MAGNUM_EXPORT Mesh: public AbstractObject {
         }
         #endif
 
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        /**
+         * @brief Draw the mesh with parameters taken from a buffer
+         * @param shader    Shader to use for drawing
+         * @param buffer    Buffer with the draw command
+         * @param offset    Offset of the draw command in @p buffer
+         *
+         * Expects that the @p shader is compatible with this mesh and is
+         * fully set up. Everything set by @ref setCount(),
+         * @ref setBaseVertex(), @ref setInstanceCount(),
+         * @ref setBaseInstance() and the index range and offset passed to
+         * @ref setIndexBuffer() is ignored, the parameters are taken from
+         * @p buffer instead. For non-indexed meshes the command is four
+         * @ref UnsignedInt values --- vertex count, instance count, first
+         * vertex and base instance, for indexed meshes it's five values ---
+         * index count, instance count, first index, base vertex and base
+         * instance. The command can be written by the GPU, for example by a
+         * culling compute shader, without any roundtrip to the CPU. If
+         * @extension{ARB,vertex_array_object} (part of OpenGL 3.0) or OpenGL
+         * ES 3.0 is available, the associated vertex array object is bound
+         * instead of setting up the mesh from scratch.
+         * @see @ref Buffer::TargetHint::DrawIndirect,
+         *      @fn_gl_keyword{UseProgram}, @fn_gl_keyword{EnableVertexAttribArray},
+         *      @fn_gl{BindBuffer}, @fn_gl_keyword{VertexAttribPointer},
+         *      @fn_gl_keyword{DisableVertexAttribArray} or @fn_gl_keyword{BindVertexArray},
+         *      @fn_gl_keyword{DrawArraysIndirect} or @fn_gl_keyword{DrawElementsIndirect}
+         * @requires_gl40 Extension @extension{ARB,draw_indirect}
+         * @requires_gles31 Indirect drawing is not available in OpenGL ES
+         *      3.0 and older. The base instance value in the command is
+         *      required to be `0` in OpenGL ES.
+         * @requires_gles Indirect drawing is not available in WebGL.
+         */
+        void drawIndirect(AbstractShaderProgram& shader, Buffer& buffer, GLintptr offset = 0);
+
+        /** @overload */
+        void drawIndirect(AbstractShaderProgram&& shader, Buffer& buffer, GLintptr offset = 0) {
+            drawIndirect(shader, buffer, offset);
+        }
+
+        #ifndef MAGNUM_TARGET_GLES
+        /**
+         * @brief Draw the mesh multiple times with parameters taken from a buffer
+         * @param shader    Shader to use for drawing
+         * @param buffer    Buffer with the draw commands
+         * @param offset    Offset of the first draw command in @p buffer
+         * @param drawCount Count of draw commands
+         * @param stride    Distance between consecutive draw commands in
+         *      bytes or @cpp 0 @ce for tightly packed commands
+         *
+         * Performs @p drawCount draws described by consecutive commands in
+         * @p buffer with a single call, see
+         * @ref drawIndirect(AbstractShaderProgram&, Buffer&, GLintptr) for
+         * the command layout. If @p drawCount is @cpp 0 @ce, the function
+         * does nothing.
+         * @see @fn_gl_keyword{MultiDrawArraysIndirect} or
+         *      @fn_gl_keyword{MultiDrawElementsIndirect}
+         * @requires_gl43 Extension @extension{ARB,multi_draw_indirect}
+         * @requires_gl Multi-draw indirect is not available in OpenGL ES or
+         *      WebGL.
+         */
+        void drawIndirect(AbstractShaderProgram& shader, Buffer& buffer, GLintptr offset, Int drawCount, GLsizei stride = 0);
+
+        /** @overload */
+        void drawIndirect(AbstractShaderProgram&& shader, Buffer& buffer, GLintptr offset, Int drawCount, GLsizei stride = 0) {
+            drawIndirect(shader, buffer, offset, drawCount, stride);
+        }
+
+        /**
+         * @brief Draw the mesh multiple times with parameters and count taken from a buffer
+         * @param shader        Shader to use for drawing
+         * @param buffer        Buffer with the draw commands
+         * @param offset        Offset of the first draw command in @p buffer
+         * @param countBuffer   Buffer containing the draw count
+         * @param countOffset   Offset of the draw count in @p countBuffer,
+         *      expected to be a multiple of @cpp 4 @ce
+         * @param maxDrawCount  Upper bound for the draw count
+         * @param stride        Distance between consecutive draw commands in
+         *      bytes or @cpp 0 @ce for tightly packed commands
+         *
+         * Similar to @ref drawIndirect(AbstractShaderProgram&, Buffer&, GLintptr, Int, GLsizei),
+         * but the draw count is an @ref UnsignedInt taken from @p countBuffer,
+         * clamped to @p maxDrawCount. Combined with a culling pass that
+         * appends commands for visible objects and atomically increments the
+         * count, the whole scene can be drawn without the CPU knowing how
+         * many objects are visible.
+         * @see @ref Buffer::TargetHint::Parameter,
+         *      @fn_gl_keyword{MultiDrawArraysIndirectCount} or
+         *      @fn_gl_keyword{MultiDrawElementsIndirectCount}
+         * @requires_gl46 Extension @extension{ARB,indirect_parameters}
+         * @requires_gl Indirect draw count is not available in OpenGL ES or
+         *      WebGL.
+         */
+        void drawIndirect(AbstractShaderProgram& shader, Buffer& buffer, GLintptr offset, Buffer& countBuffer, GLintptr countOffset, Int maxDrawCount, GLsizei stride = 0);
+
+        /** @overload */
+        void drawIndirect(AbstractShaderProgram&& shader, Buffer& buffer, GLintptr offset, Buffer& countBuffer, GLintptr countOffset, Int maxDrawCount, GLsizei stride = 0) {
+            drawIndirect(shader, buffer, offset, countBuffer, countOffset, maxDrawCount, stride);
+        }
+        #endif
+        #endif
+
     private:
         struct MAGNUM_LOCAL AttributeLayout;
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        struct MAGNUM_LOCAL SharedVertexBinding;
+        #endif
 
         explicit Mesh(GLuint id, MeshPrimitive primitive, ObjectFlags flags);
 
@@ -953,6 +1161,11 @@ class MAGNUM_EXPORT Mesh: public AbstractObject {
         void MAGNUM_LOCAL unbindImplementationDefault();
         void MAGNUM_LOCAL unbindImplementationVAO();
 
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        void MAGNUM_LOCAL bindSharedVertexFormat();
+        void MAGNUM_LOCAL resolveSharedVertexFormat();
+        #endif
+
         #ifdef MAGNUM_TARGET_GLES2
         void MAGNUM_LOCAL drawArraysInstancedImplementationANGLE(GLint baseVertex, GLsizei count, GLsizei instanceCount);
         #ifndef MAGNUM_TARGET_WEBGL
@@ -982,6 +1195,11 @@ class MAGNUM_EXPORT Mesh: public AbstractObject {
         Buffer* _indexBuffer;
 
         std::vector<AttributeLayout> _attributes;
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        bool _vertexFormatShared;
+        Int _sharedVertexFormat;
+        std::vector<SharedVertexBinding> _sharedVertexBindings;
+        #endif
 };
 
 /** @debugoperatorenum{Magnum::MeshPrimitive} */
@@ -0,0 +1,193 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Bounds.h"
+
+#include <vector>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/ThreadPool.h"
+#include "Magnum/Math/Functions.h"
+
+#if defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+/* Points processed by one thread at a time */
+constexpr std::size_t ChunkSize = 16384;
+
+/* Extends min and max with given range of points */
+void boundsInto(const StridedArrayView<const Vector3> positions, std::size_t begin, const std::size_t end, Vector3& min, Vector3& max) {
+    #if defined(__SSE__) || defined(_M_X64) || defined(__aarch64__)
+    /* Four contiguous points are exactly three four-component registers,
+       [x0 y0 z0 x1] [y1 z1 x2 y2] [z2 x3 y3 z3]. The registers are reduced
+       separately and the lanes are combined to the three components only at
+       the end. */
+    if(positions.stride() == sizeof(Vector3) && end - begin >= 4) {
+        const Float* data = positions.data()->data() + begin*3;
+        const Float init[]{min.x(), min.y(), min.z(), max.x(), max.y(), max.z()};
+        const Float initMin[]{init[0], init[1], init[2], init[0],
+                              init[1], init[2], init[0], init[1],
+                              init[2], init[0], init[1], init[2]};
+        const Float initMax[]{init[3], init[4], init[5], init[3],
+                              init[4], init[5], init[3], init[4],
+                              init[5], init[3], init[4], init[5]};
+        Float outMin[12], outMax[12];
+
+        #if defined(__SSE__) || defined(_M_X64)
+        __m128 min0 = _mm_loadu_ps(initMin), min1 = _mm_loadu_ps(initMin + 4), min2 = _mm_loadu_ps(initMin + 8);
+        __m128 max0 = _mm_loadu_ps(initMax), max1 = _mm_loadu_ps(initMax + 4), max2 = _mm_loadu_ps(initMax + 8);
+        for(; begin + 4 <= end; begin += 4, data += 12) {
+            const __m128 a = _mm_loadu_ps(data);
+            const __m128 b = _mm_loadu_ps(data + 4);
+            const __m128 c = _mm_loadu_ps(data + 8);
+            min0 = _mm_min_ps(min0, a);
+            min1 = _mm_min_ps(min1, b);
+            min2 = _mm_min_ps(min2, c);
+            max0 = _mm_max_ps(max0, a);
+            max1 = _mm_max_ps(max1, b);
+            max2 = _mm_max_ps(max2, c);
+        }
+        _mm_storeu_ps(outMin, min0);
+        _mm_storeu_ps(outMin + 4, min1);
+        _mm_storeu_ps(outMin + 8, min2);
+        _mm_storeu_ps(outMax, max0);
+        _mm_storeu_ps(outMax + 4, max1);
+        _mm_storeu_ps(outMax + 8, max2);
+        #else
+        float32x4_t min0 = vld1q_f32(initMin), min1 = vld1q_f32(initMin + 4), min2 = vld1q_f32(initMin + 8);
+        float32x4_t max0 = vld1q_f32(initMax), max1 = vld1q_f32(initMax + 4), max2 = vld1q_f32(initMax + 8);
+        for(; begin + 4 <= end; begin += 4, data += 12) {
+            const float32x4_t a = vld1q_f32(data);
+            const float32x4_t b = vld1q_f32(data + 4);
+            const float32x4_t c = vld1q_f32(data + 8);
+            min0 = vminq_f32(min0, a);
+            min1 = vminq_f32(min1, b);
+            min2 = vminq_f32(min2, c);
+            max0 = vmaxq_f32(max0, a);
+            max1 = vmaxq_f32(max1, b);
+            max2 = vmaxq_f32(max2, c);
+        }
+        vst1q_f32(outMin, min0);
+        vst1q_f32(outMin + 4, min1);
+        vst1q_f32(outMin + 8, min2);
+        vst1q_f32(outMax, max0);
+        vst1q_f32(outMax + 4, max1);
+        vst1q_f32(outMax + 8, max2);
+        #endif
+
+        /* Lane i of the registers contains component i%3 */
+        for(std::size_t i = 0; i != 12; ++i) {
+            min[i%3] = Math::min(min[i%3], outMin[i]);
+            max[i%3] = Math::max(max[i%3], outMax[i]);
+        }
+    }
+    #endif
+
+    for(std::size_t i = begin; i != end; ++i) {
+        min = Math::min(min, positions[i]);
+        max = Math::max(max, positions[i]);
+    }
+}
+
+Range3D boundsInternal(const StridedArrayView<const Vector3> positions, ThreadPool* const pool) {
+    if(!positions.size()) return {};
+
+    Vector3 min = positions[0], max = positions[0];
+    if(!pool || positions.size() <= ChunkSize) {
+        boundsInto(positions, 1, positions.size(), min, max);
+        return {min, max};
+    }
+
+    /* Each chunk is reduced separately, the results are joined at the end */
+    std::vector<Range3D> partial((positions.size() + ChunkSize - 1)/ChunkSize, Range3D{min, max});
+    pool->parallelFor(positions.size(), ChunkSize, [&](const std::size_t begin, const std::size_t end) {
+        Range3D& range = partial[begin/ChunkSize];
+        boundsInto(positions, begin, end, range.min(), range.max());
+    });
+
+    for(const Range3D& range: partial) {
+        min = Math::min(min, range.min());
+        max = Math::max(max, range.max());
+    }
+
+    return {min, max};
+}
+
+void mortonCodesInternal(const StridedArrayView<const Vector3> positions, const Range3D& bounds, const Containers::ArrayView<UnsignedInt> out, const std::size_t begin, const std::size_t end) {
+    /* Avoid division by zero for flat bounds */
+    const Vector3 size = bounds.size();
+    const Vector3 scale{size.x() == 0.0f ? 0.0f : 1023.0f/size.x(),
+                        size.y() == 0.0f ? 0.0f : 1023.0f/size.y(),
+                        size.z() == 0.0f ? 0.0f : 1023.0f/size.z()};
+
+    for(std::size_t i = begin; i != end; ++i)
+        out[i] = mortonCode(Vector3ui{Math::clamp((positions[i] - bounds.min())*scale, 0.0f, 1023.0f)});
+}
+
+}
+
+Range3D bounds(const StridedArrayView<const Vector3> positions) {
+    return boundsInternal(positions, nullptr);
+}
+
+Range3D bounds(const StridedArrayView<const Vector3> positions, ThreadPool& pool) {
+    return boundsInternal(positions, &pool);
+}
+
+Range2D bounds(const StridedArrayView<const Vector2> positions) {
+    if(!positions.size()) return {};
+
+    Vector2 min = positions[0], max = positions[0];
+    for(std::size_t i = 1; i != positions.size(); ++i) {
+        min = Math::min(min, positions[i]);
+        max = Math::max(max, positions[i]);
+    }
+
+    return {min, max};
+}
+
+void mortonCodesInto(const StridedArrayView<const Vector3> positions, const Range3D& bounds, const Containers::ArrayView<UnsignedInt> out) {
+    CORRADE_ASSERT(positions.size() == out.size(),
+        "MeshTools::mortonCodesInto(): expected output size" << positions.size() << "but got" << out.size(), );
+    mortonCodesInternal(positions, bounds, out, 0, positions.size());
+}
+
+void mortonCodesInto(const StridedArrayView<const Vector3> positions, const Range3D& bounds, const Containers::ArrayView<UnsignedInt> out, ThreadPool& pool) {
+    CORRADE_ASSERT(positions.size() == out.size(),
+        "MeshTools::mortonCodesInto(): expected output size" << positions.size() << "but got" << out.size(), );
+    pool.parallelFor(positions.size(), ChunkSize, [&](const std::size_t begin, const std::size_t end) {
+        mortonCodesInternal(positions, bounds, out, begin, end);
+    });
+}
+
+}}
@@ -0,0 +1,115 @@
+#ifndef Magnum_MeshTools_Bounds_h
+#define Magnum_MeshTools_Bounds_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::bounds(), @ref Magnum::MeshTools::mortonCode(), @ref Magnum::MeshTools::mortonCodesInto()
+ */
+
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/MeshTools/StridedArrayView.h"
+#include "Magnum/MeshTools/visibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Bounds of a set of 3D points
+
+Returns a range spanning minimal and maximal coordinates of all
+@p positions, suitable e.g. as bounds of a mesh or a BVH node. For contiguous
+views the minimum and maximum are calculated four points at a time using SSE
+or NEON, if the target supports it. Returns a zero range if @p positions are
+empty.
+@see @ref Math::join(Containers::ArrayView<const T>)
+*/
+MAGNUM_MESHTOOLS_EXPORT Range3D bounds(StridedArrayView<const Vector3> positions);
+
+/**
+@brief Bounds of a set of 3D points in parallel
+
+Same as @ref bounds(StridedArrayView<const Vector3>), but splits the points
+into blocks that are processed by threads of @p pool and then joins the
+results. The result is equal to the serial version.
+*/
+MAGNUM_MESHTOOLS_EXPORT Range3D bounds(StridedArrayView<const Vector3> positions, ThreadPool& pool);
+
+/**
+@brief Bounds of a set of 2D points
+
+Returns a range spanning minimal and maximal coordinates of all
+@p positions. Returns a zero range if @p positions are empty.
+*/
+MAGNUM_MESHTOOLS_EXPORT Range2D bounds(StridedArrayView<const Vector2> positions);
+
+/**
+@brief Morton code of quantized coordinates
+
+Interleaves lower 10 bits of each coordinate into a 30-bit code, with bits of
+the X coordinate being the most significant. Points close to each other in
+space mostly have codes close to each other, so sorting primitives by Morton
+codes of their centroids gives a good order for building a bounding volume
+hierarchy bottom-up.
+@see @ref mortonCodesInto()
+*/
+inline UnsignedInt mortonCode(const Vector3ui& coordinates) {
+    /* Spread the lower 10 bits so there are two zero bits between each */
+    auto expand = [](UnsignedInt v) {
+        v = (v*0x00010001u) & 0xff0000ffu;
+        v = (v*0x00000101u) & 0x0f00f00fu;
+        v = (v*0x00000011u) & 0xc30c30c3u;
+        v = (v*0x00000005u) & 0x49249249u;
+        return v;
+    };
+    return expand(coordinates.x() & 0x3ff) << 2 |
+           expand(coordinates.y() & 0x3ff) << 1 |
+           expand(coordinates.z() & 0x3ff);
+}
+
+/**
+@brief Morton codes of a set of points
+
+Quantizes each of @p positions to a 1024x1024x1024 grid spanning @p bounds
+and puts its @ref mortonCode() into @p out. Points outside of @p bounds are
+clamped to it. Expects that @p out has the same size as @p positions.
+Usually, @p bounds are calculated by @ref bounds() or @ref Math::join() of
+per-primitive bounds beforehand.
+*/
+MAGNUM_MESHTOOLS_EXPORT void mortonCodesInto(StridedArrayView<const Vector3> positions, const Range3D& bounds, Containers::ArrayView<UnsignedInt> out);
+
+/**
+@brief Morton codes of a set of points in parallel
+
+Same as @ref mortonCodesInto(StridedArrayView<const Vector3>, const Range3D&, Containers::ArrayView<UnsignedInt>),
+but distributes the points among threads of @p pool.
+*/
+MAGNUM_MESHTOOLS_EXPORT void mortonCodesInto(StridedArrayView<const Vector3> positions, const Range3D& bounds, Containers::ArrayView<UnsignedInt> out, ThreadPool& pool);
+
+}}
+
+#endif
@@ -0,0 +1,135 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "BufferArena.h"
+
+#include <iterator>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+
+namespace Magnum { namespace MeshTools {
+
+BufferArena::Pool::Pool(const Buffer::TargetHint target, const std::size_t capacity, const BufferUsage usage): buffer{target}, capacity{capacity}, used{} {
+    if(!capacity) return;
+
+    buffer.setData({nullptr, capacity}, usage);
+    freeRanges.emplace(0, capacity);
+}
+
+Containers::Optional<std::size_t> BufferArena::Pool::allocate(const std::size_t size, const std::size_t alignment) {
+    /* Find the smallest free range that fits the aligned size */
+    auto best = freeRanges.end();
+    std::size_t bestOffset{};
+    for(auto it = freeRanges.begin(); it != freeRanges.end(); ++it) {
+        const std::size_t offset = (it->first + alignment - 1)/alignment*alignment;
+        if(offset + size > it->first + it->second) continue;
+        if(best == freeRanges.end() || it->second < best->second) {
+            best = it;
+            bestOffset = offset;
+        }
+    }
+
+    if(best == freeRanges.end()) return Containers::NullOpt;
+
+    /* Split the range, putting back the padding in front and the remainder
+       after */
+    const std::size_t begin = best->first;
+    const std::size_t end = best->first + best->second;
+    freeRanges.erase(best);
+    if(bestOffset != begin) freeRanges.emplace(begin, bestOffset - begin);
+    if(bestOffset + size != end) freeRanges.emplace(bestOffset + size, end - bestOffset - size);
+
+    used += size;
+    return bestOffset;
+}
+
+void BufferArena::Pool::free(std::size_t offset, std::size_t size) {
+    CORRADE_ASSERT(offset + size <= capacity,
+        "MeshTools::BufferArena::free(): range" << offset << "+" << size << "out of bounds for capacity" << capacity, );
+
+    /* Merge with the following free range, if adjacent */
+    auto next = freeRanges.lower_bound(offset);
+    CORRADE_ASSERT(next == freeRanges.end() || next->first >= offset + size,
+        "MeshTools::BufferArena::free(): range at" << offset << "is not allocated", );
+    used -= size;
+    if(next != freeRanges.end() && next->first == offset + size) {
+        size += next->second;
+        next = freeRanges.erase(next);
+    }
+
+    /* Merge with the preceding free range, if adjacent */
+    if(next != freeRanges.begin()) {
+        auto previous = std::prev(next);
+        CORRADE_ASSERT(previous->first + previous->second <= offset,
+            "MeshTools::BufferArena::free(): range at" << offset << "is not allocated", );
+        if(previous->first + previous->second == offset) {
+            previous->second += size;
+            return;
+        }
+    }
+
+    freeRanges.emplace_hint(next, offset, size);
+}
+
+BufferArena::BufferArena(const std::size_t vertexCapacity, const std::size_t indexCapacity, const BufferUsage usage): _vertices{Buffer::TargetHint::Array, vertexCapacity, usage}, _indices{Buffer::TargetHint::ElementArray, indexCapacity, usage} {}
+
+BufferArena::BufferArena(BufferArena&&) noexcept = default;
+
+BufferArena::~BufferArena() = default;
+
+BufferArena& BufferArena::operator=(BufferArena&&) noexcept = default;
+
+Containers::Optional<BufferArena::Allocation> BufferArena::allocate(const std::size_t vertexSize, const std::size_t vertexAlignment, const std::size_t indexSize, const std::size_t indexAlignment) {
+    CORRADE_ASSERT(vertexSize && vertexAlignment && indexAlignment,
+        "MeshTools::BufferArena::allocate(): expected non-zero vertex size and alignments", Containers::NullOpt);
+
+    Allocation allocation{};
+    allocation.vertexSize = vertexSize;
+    allocation.indexSize = indexSize;
+
+    const Containers::Optional<std::size_t> vertexOffset = _vertices.allocate(vertexSize, vertexAlignment);
+    if(!vertexOffset) return Containers::NullOpt;
+    allocation.vertexOffset = *vertexOffset;
+
+    /* Undo the vertex allocation if the indices don't fit */
+    if(indexSize) {
+        const Containers::Optional<std::size_t> indexOffset = _indices.allocate(indexSize, indexAlignment);
+        if(!indexOffset) {
+            _vertices.free(*vertexOffset, vertexSize);
+            return Containers::NullOpt;
+        }
+        allocation.indexOffset = *indexOffset;
+    }
+
+    return allocation;
+}
+
+void BufferArena::free(const Allocation& allocation) {
+    _vertices.free(allocation.vertexOffset, allocation.vertexSize);
+    if(allocation.indexSize)
+        _indices.free(allocation.indexOffset, allocation.indexSize);
+}
+
+}}
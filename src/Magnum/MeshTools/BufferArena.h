@@ -0,0 +1,182 @@
+#ifndef Magnum_MeshTools_BufferArena_h
+#define Magnum_MeshTools_BufferArena_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::MeshTools::BufferArena
+ */
+
+#include <map>
+#include <Corrade/Containers/Optional.h>
+
+#include "Magnum/Buffer.h"
+#include "Magnum/MeshTools/visibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Shared vertex and index buffer arena
+
+Suballocates vertex and index data of many meshes from two large buffers
+instead of creating a pair of buffer objects for each mesh. This reduces
+driver overhead and allows the meshes to be batched together, for example
+with the shared vertex format described in
+@ref Mesh-performance-optimization-shared-format. The arena is used by the
+@ref compile(const Trade::MeshData3D&, BufferArena&, CompileFlags) family of
+functions:
+
+@code{.cpp}
+MeshTools::BufferArena arena{16*1024*1024, 4*1024*1024};
+
+Mesh sphere{NoCreate};
+MeshTools::BufferArena::Allocation allocation;
+std::tie(sphere, allocation) = std::move(*MeshTools::compile(Primitives::icosphereSolid(3), arena));
+
+// ...
+
+arena.free(allocation);
+@endcode
+
+Both buffers have a fixed capacity specified in the constructor, as growing
+them would mean changing buffer IDs referenced by already compiled meshes.
+Free space is tracked in a list ordered by offset. Allocation picks the
+smallest free range that fits the requested size and alignment, freed ranges
+are merged with adjacent free ranges to limit fragmentation. Allocated data
+are never moved.
+*/
+class MAGNUM_MESHTOOLS_EXPORT BufferArena {
+    public:
+        /**
+         * @brief Allocation
+         *
+         * @see @ref allocate(), @ref free()
+         */
+        struct Allocation {
+            std::size_t vertexOffset;   /**< Offset in the vertex buffer */
+            std::size_t vertexSize;     /**< Size in the vertex buffer */
+
+            /** Offset in the index buffer, valid only if @ref indexSize is not @cpp 0 @ce */
+            std::size_t indexOffset;
+            std::size_t indexSize;      /**< Size in the index buffer */
+        };
+
+        /**
+         * @brief Constructor
+         * @param vertexCapacity    Capacity of the vertex buffer in bytes
+         * @param indexCapacity     Capacity of the index buffer in bytes
+         * @param usage             Usage of both buffers
+         *
+         * Allocates storage for both buffers with uninitialized contents. If
+         * @p indexCapacity is @cpp 0 @ce, no storage is allocated for the
+         * index buffer and only non-indexed meshes can be put into the arena.
+         */
+        explicit BufferArena(std::size_t vertexCapacity, std::size_t indexCapacity, BufferUsage usage = BufferUsage::StaticDraw);
+
+        /** @brief Copying is not allowed */
+        BufferArena(const BufferArena&) = delete;
+
+        /** @brief Move constructor */
+        BufferArena(BufferArena&&) noexcept;
+
+        ~BufferArena();
+
+        /** @brief Copying is not allowed */
+        BufferArena& operator=(const BufferArena&) = delete;
+
+        /** @brief Move assignment */
+        BufferArena& operator=(BufferArena&&) noexcept;
+
+        /** @brief Vertex buffer */
+        Buffer& vertexBuffer() { return _vertices.buffer; }
+
+        /** @brief Index buffer */
+        Buffer& indexBuffer() { return _indices.buffer; }
+
+        /** @brief Vertex buffer capacity in bytes */
+        std::size_t vertexCapacity() const { return _vertices.capacity; }
+
+        /** @brief Index buffer capacity in bytes */
+        std::size_t indexCapacity() const { return _indices.capacity; }
+
+        /**
+         * @brief Size of allocated vertex data in bytes
+         *
+         * Doesn't include padding needed for alignment.
+         */
+        std::size_t vertexUsage() const { return _vertices.used; }
+
+        /**
+         * @brief Size of allocated index data in bytes
+         *
+         * Doesn't include padding needed for alignment.
+         */
+        std::size_t indexUsage() const { return _indices.used; }
+
+        /**
+         * @brief Allocate vertex and index ranges
+         * @param vertexSize        Size of vertex data in bytes
+         * @param vertexAlignment   Alignment of vertex data offset. Doesn't
+         *      need to be a power of two, so a vertex stride can be used to
+         *      be able to address the data with @ref Mesh::setBaseVertex().
+         * @param indexSize         Size of index data in bytes. If
+         *      @cpp 0 @ce, no index range is allocated.
+         * @param indexAlignment    Alignment of index data offset
+         *
+         * Either both ranges are allocated or none. If there's not enough
+         * contiguous space in either of the buffers, returns
+         * @ref Containers::NullOpt. Expects that @p vertexSize is not zero
+         * and both alignments are not zero.
+         * @see @ref free()
+         */
+        Containers::Optional<Allocation> allocate(std::size_t vertexSize, std::size_t vertexAlignment, std::size_t indexSize = 0, std::size_t indexAlignment = 1);
+
+        /**
+         * @brief Free an allocation
+         *
+         * The ranges are made available for subsequent allocations, the
+         * buffer data are left untouched. Expects that the ranges are
+         * currently allocated.
+         */
+        void free(const Allocation& allocation);
+
+    private:
+        struct Pool {
+            explicit Pool(Buffer::TargetHint target, std::size_t capacity, BufferUsage usage);
+
+            Containers::Optional<std::size_t> allocate(std::size_t size, std::size_t alignment);
+            void free(std::size_t offset, std::size_t size);
+
+            Buffer buffer;
+            std::size_t capacity, used;
+            std::map<std::size_t, std::size_t> freeRanges; /* offset -> size */
+        };
+
+        Pool _vertices, _indices;
+};
+
+}}
+
+#endif
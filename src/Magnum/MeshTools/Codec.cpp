@@ -0,0 +1,483 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Codec.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+constexpr UnsignedByte VertexMagic = 0xa0;
+constexpr UnsignedByte IndexMagic = 0xe0;
+constexpr std::size_t VertexHeaderSize = 6;
+constexpr std::size_t IndexHeaderSize = 5;
+constexpr std::size_t IndexFifoSize = 14;
+
+/* Payload size of a group for given width code and value count, only the
+   last group in a block has less than 16 values */
+inline std::size_t groupPayloadSize(const UnsignedInt code, const std::size_t count) {
+    if(code == 0) return 0;
+    const std::size_t valuesPerByte = 8 >> code;
+    return (count + valuesPerByte - 1)/valuesPerByte;
+}
+
+std::size_t vertexBlockSize(const std::size_t stride) {
+    /* Keep a block around 8 kB so the decoded data stay in L1 cache while
+       all lanes are being filled, always in whole groups of 16 */
+    return std::max(std::size_t{16}, std::min(std::size_t{256}, (8192/stride) & ~std::size_t{15}));
+}
+
+void writeUnsignedInt(std::vector<char>& out, const UnsignedInt value) {
+    for(std::size_t i = 0; i != 4; ++i) out.push_back(char(value >> (i*8)));
+}
+
+UnsignedInt readUnsignedInt(const char* const data) {
+    UnsignedInt value = 0;
+    for(std::size_t i = 0; i != 4; ++i)
+        value |= UnsignedInt(UnsignedByte(data[i])) << (i*8);
+    return value;
+}
+
+inline UnsignedByte zigzag(const UnsignedByte value) {
+    return UnsignedByte((value << 1) ^ (Byte(value) >> 7));
+}
+
+inline UnsignedByte unzigzag(const UnsignedByte value) {
+    return UnsignedByte((value >> 1) ^ -Int(value & 1));
+}
+
+inline UnsignedInt zigzag(const Int value) {
+    return (UnsignedInt(value) << 1) ^ UnsignedInt(value >> 31);
+}
+
+inline UnsignedInt unzigzag(const UnsignedInt value) {
+    return (value >> 1) ^ UnsignedInt(-Int(value & 1));
+}
+
+void writeGroup(std::vector<char>& out, const UnsignedByte* const values, const UnsignedInt code, const std::size_t count) {
+    if(code == 0) return;
+    if(code == 3) {
+        out.insert(out.end(), values, values + count);
+        return;
+    }
+
+    const std::size_t bits = code == 1 ? 2 : 4;
+    const std::size_t valuesPerByte = 8/bits;
+    for(std::size_t i = 0; i < count; i += valuesPerByte) {
+        UnsignedByte byte = 0;
+        for(std::size_t j = 0; j != valuesPerByte; ++j)
+            byte |= values[i + j] << (j*bits);
+        out.push_back(char(byte));
+    }
+}
+
+void readGroup(const char* const in, const UnsignedInt code, const std::size_t count, UnsignedByte* const values) {
+    if(code == 0) {
+        std::fill_n(values, 16, 0);
+        return;
+    }
+    if(code == 3) {
+        std::memcpy(values, in, count);
+        return;
+    }
+
+    const std::size_t bits = code == 1 ? 2 : 4;
+    const std::size_t valuesPerByte = 8/bits;
+    const UnsignedByte mask = (1 << bits) - 1;
+    for(std::size_t i = 0; i < count; i += valuesPerByte) {
+        const UnsignedByte byte = in[i/valuesPerByte];
+        for(std::size_t j = 0; j != valuesPerByte; ++j)
+            values[i + j] = (byte >> (j*bits)) & mask;
+    }
+}
+
+void writeVarint(std::vector<char>& out, UnsignedInt value) {
+    while(value >= 0x80) {
+        out.push_back(char(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(char(value));
+}
+
+bool readVarint(const char*& in, const char* const end, UnsignedInt& out) {
+    UnsignedInt value = 0;
+    for(std::size_t shift = 0; shift != 35 && in != end; shift += 7) {
+        const UnsignedByte byte = *in++;
+        value |= UnsignedInt(byte & 0x7f) << shift;
+        if(!(byte & 0x80)) {
+            out = value;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/* Undoes the zigzag and delta encoding of one lane, writing the values to
+   every stride-th byte of the output. Returns the last value. */
+UnsignedByte decodeDeltas(const UnsignedByte* const deltas, const std::size_t count, UnsignedByte value, char* const out, const std::size_t stride) {
+    std::size_t i = 0;
+
+    #if defined(__SSE2__) || defined(_M_X64) || defined(__aarch64__)
+    /* Sixteen values at a time: unzigzag, inclusive prefix sum in four
+       shift-and-add steps and then the running value is added. Byte
+       arithmetic wraps around the same way as in the scalar code below. */
+    alignas(16) UnsignedByte values[16];
+    for(; i + 16 <= count; i += 16) {
+        #if defined(__SSE2__) || defined(_M_X64)
+        __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(deltas + i));
+        d = _mm_xor_si128(
+            _mm_and_si128(_mm_srli_epi16(d, 1), _mm_set1_epi8(0x7f)),
+            _mm_sub_epi8(_mm_setzero_si128(), _mm_and_si128(d, _mm_set1_epi8(1))));
+        d = _mm_add_epi8(d, _mm_slli_si128(d, 1));
+        d = _mm_add_epi8(d, _mm_slli_si128(d, 2));
+        d = _mm_add_epi8(d, _mm_slli_si128(d, 4));
+        d = _mm_add_epi8(d, _mm_slli_si128(d, 8));
+        d = _mm_add_epi8(d, _mm_set1_epi8(char(value)));
+        _mm_store_si128(reinterpret_cast<__m128i*>(values), d);
+        #else
+        const uint8x16_t zero = vdupq_n_u8(0);
+        uint8x16_t d = vld1q_u8(deltas + i);
+        d = veorq_u8(vshrq_n_u8(d, 1),
+            vsubq_u8(zero, vandq_u8(d, vdupq_n_u8(1))));
+        d = vaddq_u8(d, vextq_u8(zero, d, 15));
+        d = vaddq_u8(d, vextq_u8(zero, d, 14));
+        d = vaddq_u8(d, vextq_u8(zero, d, 12));
+        d = vaddq_u8(d, vextq_u8(zero, d, 8));
+        d = vaddq_u8(d, vdupq_n_u8(value));
+        vst1q_u8(values, d);
+        #endif
+
+        if(stride == 1) std::memcpy(out + i, values, 16);
+        else for(std::size_t j = 0; j != 16; ++j)
+            out[(i + j)*stride] = char(values[j]);
+        value = values[15];
+    }
+    #endif
+
+    for(; i != count; ++i) {
+        value += unzigzag(deltas[i]);
+        out[i*stride] = char(value);
+    }
+
+    return value;
+}
+
+inline void moveToFront(UnsignedInt* const fifo, const std::size_t position, const UnsignedInt index) {
+    std::copy_backward(fifo, fifo + position, fifo + position + 1);
+    fifo[0] = index;
+}
+
+bool readVertexHeader(const Containers::ArrayView<const char> data, const char* const function, std::size_t& stride, std::size_t& vertexCount) {
+    if(data.size() < VertexHeaderSize || UnsignedByte(data[0]) != VertexMagic) {
+        Error() << function << "invalid header";
+        return false;
+    }
+
+    stride = UnsignedByte(data[1]) + 1;
+    const UnsignedInt count = readUnsignedInt(data + 2);
+    if(count > ~std::size_t{}/stride) {
+        Error() << function << "vertex count" << count << "is too large";
+        return false;
+    }
+    vertexCount = count;
+
+    /* Every lane of every block has at least the group width codes, check
+       that first so a corrupted count doesn't cause a huge allocation */
+    const std::size_t blockSize = vertexBlockSize(stride);
+    const std::size_t remaining = vertexCount%blockSize;
+    const std::size_t minimalSize = VertexHeaderSize + stride*(vertexCount/blockSize*((blockSize/16 + 3)/4) + ((remaining + 15)/16 + 3)/4);
+    if(data.size() < minimalSize) {
+        Error() << function << "expected at least" << minimalSize << "bytes for" << vertexCount << "vertices but got" << data.size();
+        return false;
+    }
+
+    return true;
+}
+
+bool decodeVertexInternal(const Containers::ArrayView<const char> data, const Containers::ArrayView<char> out, const std::size_t stride, const std::size_t vertexCount, const char* const function) {
+    const char* in = data + VertexHeaderSize;
+    const char* const end = data.end();
+
+    const std::size_t blockSize = vertexBlockSize(stride);
+    Containers::Array<UnsignedByte> last{Containers::ValueInit, stride};
+    UnsignedByte deltas[256];
+    for(std::size_t blockBegin = 0; blockBegin < vertexCount; blockBegin += blockSize) {
+        const std::size_t blockEnd = std::min(blockBegin + blockSize, vertexCount);
+        const std::size_t groupCount = (blockEnd - blockBegin + 15)/16;
+        const std::size_t codeSize = (groupCount + 3)/4;
+
+        for(std::size_t lane = 0; lane != stride; ++lane) {
+            if(std::size_t(end - in) < codeSize) {
+                Error() << function << "unexpected end of data";
+                return false;
+            }
+
+            const char* const codes = in;
+            in += codeSize;
+            for(std::size_t group = 0; group != groupCount; ++group) {
+                const UnsignedInt code = (UnsignedByte(codes[group/4]) >> ((group%4)*2)) & 3;
+                const std::size_t count = std::min(std::size_t{16}, blockEnd - blockBegin - group*16);
+                const std::size_t payloadSize = groupPayloadSize(code, count);
+                if(std::size_t(end - in) < payloadSize) {
+                    Error() << function << "unexpected end of data";
+                    return false;
+                }
+
+                readGroup(in, code, count, deltas + group*16);
+                in += payloadSize;
+            }
+
+            last[lane] = decodeDeltas(deltas, blockEnd - blockBegin, last[lane], out + blockBegin*stride + lane, stride);
+        }
+    }
+
+    if(in != end) {
+        Error() << function << "unexpected" << std::size_t(end - in) << "bytes after the data";
+        return false;
+    }
+
+    return true;
+}
+
+bool readIndexHeader(const Containers::ArrayView<const char> data, const char* const function, std::size_t& indexCount) {
+    if(data.size() < IndexHeaderSize || UnsignedByte(data[0]) != IndexMagic) {
+        Error() << function << "invalid header";
+        return false;
+    }
+
+    indexCount = readUnsignedInt(data + 1);
+
+    /* Every index has at least its code, check that first so a corrupted
+       count doesn't cause a huge allocation */
+    const std::size_t minimalSize = IndexHeaderSize + indexCount/2 + indexCount%2;
+    if(data.size() < minimalSize) {
+        Error() << function << "expected at least" << minimalSize << "bytes for" << indexCount << "indices but got" << data.size();
+        return false;
+    }
+
+    return true;
+}
+
+bool decodeIndexInternal(const Containers::ArrayView<const char> data, const Containers::ArrayView<UnsignedInt> out, const char* const function) {
+    const char* const codes = data + IndexHeaderSize;
+    const char* extra = codes + out.size()/2 + out.size()%2;
+    const char* const end = data.end();
+
+    UnsignedInt fifo[IndexFifoSize];
+    std::fill_n(fifo, IndexFifoSize, ~UnsignedInt{});
+    UnsignedInt next = 0, previous = 0;
+    for(std::size_t i = 0; i != out.size(); ++i) {
+        const UnsignedInt code = (UnsignedByte(codes[i/2]) >> ((i%2)*4)) & 0xf;
+
+        UnsignedInt index;
+        std::size_t position = IndexFifoSize - 1;
+        if(code == 0) index = next;
+        else if(code != 15) {
+            position = code - 1;
+            index = fifo[position];
+        } else {
+            UnsignedInt difference;
+            if(!readVarint(extra, end, difference)) {
+                Error() << function << "invalid or truncated escaped index" << i;
+                return false;
+            }
+            index = previous + unzigzag(difference);
+        }
+
+        moveToFront(fifo, position, index);
+        next = std::max(next, index + 1);
+        previous = out[i] = index;
+    }
+
+    if(extra != end) {
+        Error() << function << "unexpected" << std::size_t(end - extra) << "bytes after the data";
+        return false;
+    }
+
+    return true;
+}
+
+}
+
+Containers::Array<char> encodeVertexBuffer(const Containers::ArrayView<const char> data, const std::size_t stride) {
+    CORRADE_ASSERT(stride && stride <= 256,
+        "MeshTools::encodeVertexBuffer(): expected stride between 1 and 256 but got" << stride, {});
+    CORRADE_ASSERT(data.size() % stride == 0,
+        "MeshTools::encodeVertexBuffer(): data size" << data.size() << "is not divisible by stride" << stride, {});
+    const std::size_t vertexCount = data.size()/stride;
+    CORRADE_ASSERT(UnsignedLong(vertexCount) <= 0xffffffffull,
+        "MeshTools::encodeVertexBuffer(): expected at most 2^32-1 vertices but got" << vertexCount, {});
+
+    std::vector<char> out;
+    out.reserve(VertexHeaderSize + data.size() + data.size()/32 + stride);
+    out.push_back(char(VertexMagic));
+    out.push_back(char(stride - 1));
+    writeUnsignedInt(out, UnsignedInt(vertexCount));
+
+    const std::size_t blockSize = vertexBlockSize(stride);
+    Containers::Array<UnsignedByte> last{Containers::ValueInit, stride};
+    UnsignedByte deltas[256];
+    for(std::size_t blockBegin = 0; blockBegin < vertexCount; blockBegin += blockSize) {
+        const std::size_t blockEnd = std::min(blockBegin + blockSize, vertexCount);
+        const std::size_t groupCount = (blockEnd - blockBegin + 15)/16;
+
+        for(std::size_t lane = 0; lane != stride; ++lane) {
+            /* Differences to the same byte of previous vertex, padded with
+               zeros to whole groups. The padding is not stored. */
+            std::fill_n(deltas, groupCount*16, 0);
+            for(std::size_t i = blockBegin; i != blockEnd; ++i) {
+                const UnsignedByte value = data[i*stride + lane];
+                deltas[i - blockBegin] = zigzag(UnsignedByte(value - last[lane]));
+                last[lane] = value;
+            }
+
+            /* Width codes of all groups, four in a byte, followed by the
+               payloads */
+            const std::size_t codeOffset = out.size();
+            out.resize(out.size() + (groupCount + 3)/4);
+            for(std::size_t group = 0; group != groupCount; ++group) {
+                const UnsignedByte* const values = deltas + group*16;
+                const UnsignedByte max = *std::max_element(values, values + 16);
+                const UnsignedInt code = max == 0 ? 0 : max < 4 ? 1 : max < 16 ? 2 : 3;
+                out[codeOffset + group/4] |= char(code << ((group%4)*2));
+                writeGroup(out, values, code, std::min(std::size_t{16}, blockEnd - blockBegin - group*16));
+            }
+        }
+    }
+
+    Containers::Array<char> result{Containers::NoInit, out.size()};
+    std::memcpy(result.data(), out.data(), out.size());
+    return result;
+}
+
+Containers::Optional<Containers::Array<char>> decodeVertexBuffer(const Containers::ArrayView<const char> data) {
+    std::size_t stride, vertexCount;
+    if(!readVertexHeader(data, "MeshTools::decodeVertexBuffer():", stride, vertexCount))
+        return Containers::NullOpt;
+
+    Containers::Array<char> out{Containers::NoInit, stride*vertexCount};
+    if(!decodeVertexInternal(data, out, stride, vertexCount, "MeshTools::decodeVertexBuffer():"))
+        return Containers::NullOpt;
+
+    return std::move(out);
+}
+
+bool decodeVertexBufferInto(const Containers::ArrayView<const char> data, const Containers::ArrayView<char> out) {
+    std::size_t stride, vertexCount;
+    if(!readVertexHeader(data, "MeshTools::decodeVertexBufferInto():", stride, vertexCount))
+        return false;
+
+    if(out.size() != stride*vertexCount) {
+        Error() << "MeshTools::decodeVertexBufferInto(): expected output size" << stride*vertexCount << "but got" << out.size();
+        return false;
+    }
+
+    return decodeVertexInternal(data, out, stride, vertexCount, "MeshTools::decodeVertexBufferInto():");
+}
+
+Containers::Array<char> encodeIndexBuffer(const Containers::ArrayView<const UnsignedInt> indices) {
+    CORRADE_ASSERT(UnsignedLong(indices.size()) <= 0xffffffffull,
+        "MeshTools::encodeIndexBuffer(): expected at most 2^32-1 indices but got" << indices.size(), {});
+
+    /* Header and all codes, two in a byte, followed by the escaped indices */
+    const std::size_t codeSize = indices.size()/2 + indices.size()%2;
+    std::vector<char> out(IndexHeaderSize + codeSize);
+    out.reserve(out.size() + indices.size()/4);
+    out[0] = char(IndexMagic);
+    for(std::size_t i = 0; i != 4; ++i)
+        out[1 + i] = char(UnsignedInt(indices.size()) >> (i*8));
+
+    UnsignedInt fifo[IndexFifoSize];
+    std::fill_n(fifo, IndexFifoSize, ~UnsignedInt{});
+    UnsignedInt next = 0, previous = 0;
+    for(std::size_t i = 0; i != indices.size(); ++i) {
+        const UnsignedInt index = indices[i];
+
+        /* A vertex that wasn't referenced yet, an index that was used
+           recently or, as the last resort, a difference to previous index */
+        UnsignedInt code;
+        std::size_t position = IndexFifoSize - 1;
+        if(index == next) code = 0;
+        else {
+            const UnsignedInt* const found = std::find(fifo, fifo + IndexFifoSize, index);
+            if(found != fifo + IndexFifoSize) {
+                position = found - fifo;
+                code = position + 1;
+            } else {
+                code = 15;
+                writeVarint(out, zigzag(Int(index - previous)));
+            }
+        }
+
+        out[IndexHeaderSize + i/2] |= char(code << ((i%2)*4));
+        moveToFront(fifo, position, index);
+        next = std::max(next, index + 1);
+        previous = index;
+    }
+
+    Containers::Array<char> result{Containers::NoInit, out.size()};
+    std::memcpy(result.data(), out.data(), out.size());
+    return result;
+}
+
+Containers::Optional<Containers::Array<UnsignedInt>> decodeIndexBuffer(const Containers::ArrayView<const char> data) {
+    std::size_t indexCount;
+    if(!readIndexHeader(data, "MeshTools::decodeIndexBuffer():", indexCount))
+        return Containers::NullOpt;
+
+    Containers::Array<UnsignedInt> out{Containers::NoInit, indexCount};
+    if(!decodeIndexInternal(data, out, "MeshTools::decodeIndexBuffer():"))
+        return Containers::NullOpt;
+
+    return std::move(out);
+}
+
+bool decodeIndexBufferInto(const Containers::ArrayView<const char> data, const Containers::ArrayView<UnsignedInt> out) {
+    std::size_t indexCount;
+    if(!readIndexHeader(data, "MeshTools::decodeIndexBufferInto():", indexCount))
+        return false;
+
+    if(out.size() != indexCount) {
+        Error() << "MeshTools::decodeIndexBufferInto(): expected" << indexCount << "indices but got" << out.size();
+        return false;
+    }
+
+    return decodeIndexInternal(data, out, "MeshTools::decodeIndexBufferInto():");
+}
+
+}}
@@ -0,0 +1,137 @@
+#ifndef Magnum_MeshTools_Codec_h
+#define Magnum_MeshTools_Codec_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::encodeVertexBuffer(), @ref Magnum::MeshTools::decodeVertexBuffer(), @ref Magnum::MeshTools::decodeVertexBufferInto(), @ref Magnum::MeshTools::encodeIndexBuffer(), @ref Magnum::MeshTools::decodeIndexBuffer(), @ref Magnum::MeshTools::decodeIndexBufferInto()
+ */
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/visibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Encode interleaved vertex data
+@param data     Interleaved vertex data
+@param stride   Vertex stride, expected to be between @cpp 1 @ce and
+    @cpp 256 @ce and to divide size of @p data
+@return Encoded data
+
+Meant for storing and transferring meshes in a compact form. Every byte of a
+vertex is encoded as a difference to the same byte of the previous vertex,
+converted to unsigned using zigzag encoding so small negative differences
+stay small, and the differences are then packed in groups of 16 using the
+smallest of 0, 2, 4 or 8 bits per value that fits the whole group. Data of
+each byte lane are stored together, so the output can be further compressed
+with a generic compressor. Decode the result with @ref decodeVertexBuffer()
+or @ref decodeVertexBufferInto().
+
+The encoding is lossless and works best with quantized attributes and
+vertices ordered so neighbors are close to each other --- pack the positions
+and normals using @ref packPositionsInto() and @ref packOctahedralInto() and
+order the vertices with @ref optimizeVertexFetchInPlace() first:
+
+@snippet MagnumMeshTools.cpp encodeVertexBuffer
+
+The vertex count and stride are stored in the encoded data. The result is
+at most 6 + @cpp stride @ce bytes plus @cpp 1/32 @ce larger than the input.
+@see @ref encodeIndexBuffer()
+*/
+MAGNUM_MESHTOOLS_EXPORT Containers::Array<char> encodeVertexBuffer(Containers::ArrayView<const char> data, std::size_t stride);
+
+/**
+@brief Decode interleaved vertex data
+@return Decoded data or @ref Containers::NullOpt if the data are invalid
+
+Decodes data produced by @ref encodeVertexBuffer(). The data can come from an
+untrusted source, on invalid or truncated data prints a message to
+@ref Error and returns @ref Containers::NullOpt. The differences are
+accumulated sixteen at a time using SSE2 or NEON instructions, if the target
+supports them.
+@see @ref decodeVertexBufferInto()
+*/
+MAGNUM_MESHTOOLS_EXPORT Containers::Optional<Containers::Array<char>> decodeVertexBuffer(Containers::ArrayView<const char> data);
+
+/**
+@brief Decode interleaved vertex data into existing location
+@return @cpp true @ce on success, @cpp false @ce if the data are invalid
+
+Like @ref decodeVertexBuffer(), but decodes into @p out, for example into a
+mapped @ref Buffer. On invalid data or if size of @p out doesn't match the
+decoded size, prints a message to @ref Error and returns @cpp false @ce.
+Contents of @p out are undefined in that case.
+*/
+MAGNUM_MESHTOOLS_EXPORT bool decodeVertexBufferInto(Containers::ArrayView<const char> data, Containers::ArrayView<char> out);
+
+/**
+@brief Encode index data
+@return Encoded data
+
+Meant for storing and transferring meshes in a compact form, exploiting the
+vertex ordering produced by @ref optimizeVertexCacheInPlace() and
+@ref optimizeVertexFetchInPlace(). Each index is encoded as a 4-bit code ---
+either a reference to a vertex that wasn't used yet and immediately follows
+the highest index so far, or a position in a list of 14 recently used
+indices. Other indices are stored separately as a variable-length zigzag
+encoded difference to the previous index. An index referencing a new or
+recently used vertex thus takes just half a byte, which is the common case
+for vertex-cache-optimized meshes. Decode the result with
+@ref decodeIndexBuffer() or @ref decodeIndexBufferInto().
+
+The index count is stored in the encoded data.
+@see @ref encodeVertexBuffer()
+*/
+MAGNUM_MESHTOOLS_EXPORT Containers::Array<char> encodeIndexBuffer(Containers::ArrayView<const UnsignedInt> indices);
+
+/**
+@brief Decode index data
+@return Decoded indices or @ref Containers::NullOpt if the data are invalid
+
+Decodes data produced by @ref encodeIndexBuffer(). The data can come from an
+untrusted source, on invalid or truncated data prints a message to
+@ref Error and returns @ref Containers::NullOpt.
+@see @ref decodeIndexBufferInto()
+*/
+MAGNUM_MESHTOOLS_EXPORT Containers::Optional<Containers::Array<UnsignedInt>> decodeIndexBuffer(Containers::ArrayView<const char> data);
+
+/**
+@brief Decode index data into existing location
+@return @cpp true @ce on success, @cpp false @ce if the data are invalid
+
+Like @ref decodeIndexBuffer(), but decodes into @p out. On invalid data or if
+size of @p out doesn't match the decoded index count, prints a message to
+@ref Error and returns @cpp false @ce. Contents of @p out are undefined in
+that case.
+*/
+MAGNUM_MESHTOOLS_EXPORT bool decodeIndexBufferInto(Containers::ArrayView<const char> data, Containers::ArrayView<UnsignedInt> out);
+
+}}
+
+#endif
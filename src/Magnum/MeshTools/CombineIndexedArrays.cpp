@@ -25,49 +25,175 @@
 
 #include "CombineIndexedArrays.h"
 
-#include <cstring>
-#include <unordered_map>
+#include <algorithm>
 #include <Corrade/Utility/Assert.h>
-#include <Corrade/Utility/MurmurHash2.h>
+#include <Corrade/Utility/Debug.h>
 
-#include "Magnum/Magnum.h"
+#include "Magnum/ThreadPool.h"
 
 namespace Magnum { namespace MeshTools {
 
+namespace {
+
+/* Interleaving and hashing is done in blocks of this many combinations, so
+   the data touched by one job stay in cache */
+constexpr std::size_t BlockSize = 4096;
+
+}
+
+IndexArrayCombiner::IndexArrayCombiner(): _pool{}, _combinationCount{}, _stride{} {}
+
+IndexArrayCombiner::IndexArrayCombiner(ThreadPool& pool): _pool{&pool}, _combinationCount{}, _stride{} {}
+
+IndexArrayCombiner::~IndexArrayCombiner() = default;
+
+void IndexArrayCombiner::reserve(const std::size_t count, const UnsignedInt stride) {
+    _interleaved.reserve(count*stride);
+    _hashes.reserve(count);
+    _first.reserve(count);
+    _order.reserve(count);
+}
+
+std::size_t IndexArrayCombiner::combineInPlace(const Containers::ArrayView<UnsignedInt> interleavedArrays, const UnsignedInt stride, const Containers::ArrayView<UnsignedInt> combinedIndices) {
+    CORRADE_ASSERT(stride != 0, "MeshTools::IndexArrayCombiner::combineInPlace(): stride can't be zero", {});
+    CORRADE_ASSERT(interleavedArrays.size() % stride == 0, "MeshTools::IndexArrayCombiner::combineInPlace(): array size is not divisible by stride", {});
+    const std::size_t count = interleavedArrays.size()/stride;
+    CORRADE_ASSERT(combinedIndices.size() == count, "MeshTools::IndexArrayCombiner::combineInPlace(): expected" << count << "combined indices but got" << combinedIndices.size(), {});
+    if(!count) return 0;
+
+    UnsignedInt* const data = interleavedArrays.data();
+    _hashes.resize(count);
+    _first.resize(count);
+    _order.resize(count);
+
+    const auto hash = [&](const std::size_t begin, const std::size_t end) {
+        for(std::size_t i = begin; i != end; ++i)
+            _hashes[i] = Implementation::hashIntegers(data + i*stride, stride);
+    };
+    if(_pool) _pool->parallelFor(count, BlockSize, hash);
+    else hash(0, count);
+
+    /* Sort the combinations into partitions by upper bits of the hash,
+       keeping their order inside each partition. Lower bits are used for
+       addressing the table. */
+    const std::size_t partitionCount = _pool ? _pool->threadCount() : 1;
+    _partitionOffsets.assign(partitionCount + 1, 0);
+    for(std::size_t i = 0; i != count; ++i)
+        ++_partitionOffsets[(_hashes[i] >> 40) % partitionCount + 1];
+    for(std::size_t i = 0; i != partitionCount; ++i)
+        _partitionOffsets[i + 1] += _partitionOffsets[i];
+    {
+        std::vector<UnsignedInt> fill(_partitionOffsets.begin(), _partitionOffsets.end() - 1);
+        for(std::size_t i = 0; i != count; ++i)
+            _order[fill[(_hashes[i] >> 40) % partitionCount]++] = i;
+    }
+
+    /* Find first occurence of each combination, each partition with its own
+       table. Tables are kept for next calls. */
+    _tables.resize(partitionCount);
+    const auto findFirst = [&](const std::size_t begin, const std::size_t end) {
+        for(std::size_t partition = begin; partition != end; ++partition) {
+            const std::size_t partitionBegin = _partitionOffsets[partition];
+            const std::size_t partitionEnd = _partitionOffsets[partition + 1];
+
+            Implementation::DuplicateTable& table = _tables[partition];
+            table.reset(partitionEnd - partitionBegin);
+            for(std::size_t j = partitionBegin; j != partitionEnd; ++j) {
+                const UnsignedInt index = _order[j];
+                _first[index] = table.findOrInsert(_hashes[index], index, [&](const UnsignedInt slot) {
+                    return std::equal(data + slot*stride, data + (slot + 1)*stride, data + index*stride);
+                });
+            }
+        }
+    };
+    if(_pool) _pool->parallelFor(partitionCount, 1, findFirst);
+    else findFirst(0, 1);
+
+    /* Merge the partitions, moving first occurences to the front. First
+       occurence of a combination is always before the combination itself, so
+       its new index is already known. */
+    std::size_t unique = 0;
+    for(std::size_t i = 0; i != count; ++i) {
+        if(_first[i] == i) {
+            combinedIndices[i] = unique;
+            if(i != unique) std::copy(data + i*stride, data + (i + 1)*stride, data + unique*stride);
+            ++unique;
+        } else combinedIndices[i] = combinedIndices[_first[i]];
+    }
+
+    return unique;
+}
+
+std::size_t IndexArrayCombiner::interleaveAndCombine(const Containers::ArrayView<const Containers::ArrayView<const UnsignedInt>> arrays, const Containers::ArrayView<UnsignedInt> combinedIndices) {
+    const UnsignedInt stride = arrays.size();
+    CORRADE_ASSERT(stride != 0, "MeshTools::IndexArrayCombiner::interleaveAndCombine(): no arrays given", {});
+    const std::size_t size = arrays[0].size();
+    #if !defined(CORRADE_NO_ASSERT) || defined(CORRADE_GRACEFUL_ASSERT)
+    for(const Containers::ArrayView<const UnsignedInt> array: arrays)
+        CORRADE_ASSERT(array.size() == size, "MeshTools::IndexArrayCombiner::interleaveAndCombine(): the arrays don't have the same size", {});
+    #endif
+    CORRADE_ASSERT(combinedIndices.size() == size, "MeshTools::IndexArrayCombiner::interleaveAndCombine(): expected" << size << "combined indices but got" << combinedIndices.size(), {});
+
+    /* Interleave the arrays block by block, so the output block stays in
+       cache while all arrays are written into it */
+    _interleaved.resize(size*stride);
+    const auto interleave = [&](const std::size_t begin, const std::size_t end) {
+        for(std::size_t offset = 0; offset != stride; ++offset) {
+            const UnsignedInt* const array = arrays[offset].data();
+            for(std::size_t i = begin; i != end; ++i)
+                _interleaved[i*stride + offset] = array[i];
+        }
+    };
+    if(_pool) _pool->parallelFor(size, BlockSize, interleave);
+    else for(std::size_t i = 0; i < size; i += BlockSize)
+        interleave(i, std::min(i + BlockSize, size));
+
+    _stride = stride;
+    _combinationCount = combineInPlace({_interleaved.data(), _interleaved.size()}, stride, combinedIndices);
+    return _combinationCount;
+}
+
 namespace Implementation {
 
-std::pair<std::vector<UnsignedInt>, std::vector<UnsignedInt>> interleaveAndCombineIndexArrays(const std::reference_wrapper<const std::vector<UnsignedInt>>* begin, const std::reference_wrapper<const std::vector<UnsignedInt>>* end) {
-    /* Array stride and size */
-    const UnsignedInt stride = end - begin;
+std::pair<std::vector<UnsignedInt>, std::vector<UnsignedInt>> interleaveAndCombineIndexArrays(const std::reference_wrapper<const std::vector<UnsignedInt>>* begin, const std::reference_wrapper<const std::vector<UnsignedInt>>* end, ThreadPool* const pool) {
     const UnsignedInt inputSize = begin->get().size();
     #if !defined(CORRADE_NO_ASSERT) || defined(CORRADE_GRACEFUL_ASSERT)
     for(auto it = begin; it != end; ++it)
         CORRADE_ASSERT(it->get().size() == inputSize, "MeshTools::combineIndexArrays(): the arrays don't have the same size", {});
     #endif
 
-    /* Interleave the arrays */
+    std::vector<Containers::ArrayView<const UnsignedInt>> arrays;
+    arrays.reserve(end - begin);
+    for(auto it = begin; it != end; ++it)
+        arrays.emplace_back(it->get().data(), it->get().size());
+
+    /* Interleave and combine them */
+    std::vector<UnsignedInt> combinedIndices(inputSize);
+    const auto combine = [&](IndexArrayCombiner& combiner) {
+        combiner.interleaveAndCombine(Containers::ArrayView<const Containers::ArrayView<const UnsignedInt>>{arrays.data(), arrays.size()}, {combinedIndices.data(), combinedIndices.size()});
+        const Containers::ArrayView<const UnsignedInt> combinations = combiner.combinations();
+        return std::vector<UnsignedInt>(combinations.begin(), combinations.end());
+    };
     std::vector<UnsignedInt> interleavedArrays;
-    interleavedArrays.resize(inputSize*stride);
-    for(UnsignedInt offset = 0; offset != stride; ++offset) {
-        const auto& array = (begin+offset)->get();
-        for(UnsignedInt i = 0; i != inputSize; ++i)
-            interleavedArrays[offset + i*stride] = array[i];
+    if(pool) {
+        IndexArrayCombiner combiner{*pool};
+        interleavedArrays = combine(combiner);
+    } else {
+        IndexArrayCombiner combiner;
+        interleavedArrays = combine(combiner);
     }
 
-    /* Combine them */
-    std::vector<UnsignedInt> combinedIndices;
-    std::tie(combinedIndices, interleavedArrays) = MeshTools::combineIndexArrays(interleavedArrays, stride);
-    return {combinedIndices, interleavedArrays};
+    return {std::move(combinedIndices), std::move(interleavedArrays)};
 }
 
-std::vector<UnsignedInt> combineIndexArrays(const std::reference_wrapper<std::vector<UnsignedInt>>* const begin, const std::reference_wrapper<std::vector<UnsignedInt>>* const end) {
+std::vector<UnsignedInt> combineIndexArrays(const std::reference_wrapper<std::vector<UnsignedInt>>* const begin, const std::reference_wrapper<std::vector<UnsignedInt>>* const end, ThreadPool* const pool) {
     /* Interleave and combine the arrays */
     std::vector<UnsignedInt> combinedIndices;
     std::vector<UnsignedInt> interleavedCombinedArrays;
     std::tie(combinedIndices, interleavedCombinedArrays) = Implementation::interleaveAndCombineIndexArrays(
         /* This will bite me hard once. */
         reinterpret_cast<const std::reference_wrapper<const std::vector<UnsignedInt>>*>(begin),
-        reinterpret_cast<const std::reference_wrapper<const std::vector<UnsignedInt>>*>(end));
+        reinterpret_cast<const std::reference_wrapper<const std::vector<UnsignedInt>>*>(end), pool);
 
     /* Update the original indices */
     const UnsignedInt stride = end - begin;
@@ -87,70 +213,30 @@ std::vector<UnsignedInt> combineIndexArrays(const std::reference_wrapper<std::ve
 
 namespace {
 
-class IndexHash {
-    public:
-        explicit IndexHash(const std::vector<UnsignedInt>& indices, UnsignedInt stride): indices(indices), stride(stride) {}
-
-        std::size_t operator()(UnsignedInt key) const {
-            return *reinterpret_cast<const std::size_t*>(Utility::MurmurHash2()(reinterpret_cast<const char*>(indices.data()+key*stride), sizeof(UnsignedInt)*stride).byteArray());
-        }
-
-    private:
-        const std::vector<UnsignedInt>& indices;
-        UnsignedInt stride;
-};
-
-class IndexEqual {
-    public:
-        explicit IndexEqual(const std::vector<UnsignedInt>& indices, UnsignedInt stride): indices(indices), stride(stride) {}
+std::pair<std::vector<UnsignedInt>, std::vector<UnsignedInt>> combineInterleavedIndexArrays(const std::vector<UnsignedInt>& interleavedArrays, const UnsignedInt stride, IndexArrayCombiner& combiner) {
+    CORRADE_ASSERT(stride != 0, "MeshTools::combineIndexArrays(): stride can't be zero", {});
+    CORRADE_ASSERT(interleavedArrays.size() % stride == 0, "MeshTools::combineIndexArrays(): array size is not divisible by stride", {});
 
-        bool operator()(UnsignedInt a, UnsignedInt b) const {
-            return std::memcmp(indices.data()+a*stride, indices.data()+b*stride, sizeof(UnsignedInt)*stride) == 0;
-        }
+    /* Original indices into `interleavedArrays` array were 0, 1, 2, 3, ...,
+       `combinedIndices` contains new ones into the shortened copy */
+    std::vector<UnsignedInt> newInterleavedArrays{interleavedArrays};
+    std::vector<UnsignedInt> combinedIndices(interleavedArrays.size()/stride);
+    const std::size_t count = combiner.combineInPlace({newInterleavedArrays.data(), newInterleavedArrays.size()}, stride, {combinedIndices.data(), combinedIndices.size()});
+    newInterleavedArrays.resize(count*stride);
 
-    private:
-        const std::vector<UnsignedInt>& indices;
-        UnsignedInt stride;
-};
+    return {std::move(combinedIndices), std::move(newInterleavedArrays)};
+}
 
 }
 
 std::pair<std::vector<UnsignedInt>, std::vector<UnsignedInt>> combineIndexArrays(const std::vector<UnsignedInt>& interleavedArrays, const UnsignedInt stride) {
-    CORRADE_ASSERT(stride != 0, "MeshTools::combineIndexArrays(): stride can't be zero", {});
-    CORRADE_ASSERT(interleavedArrays.size() % stride == 0, "MeshTools::combineIndexArrays(): array size is not divisible by stride", {});
-
-    /* Hash map with index combinations, containing just indices into
-       interleavedArrays vector, hashing and comparison is done using IndexHash
-       and IndexEqual functors. Reserving more buckets than necessary (i.e. as
-       if each combination was unique). */
-    std::unordered_map<UnsignedInt, UnsignedInt, IndexHash, IndexEqual> indexCombinations(
-        interleavedArrays.size()/stride,
-        IndexHash(interleavedArrays, stride),
-        IndexEqual(interleavedArrays, stride));
-
-    /* Make the index combinations unique. Original indices into original
-       `interleavedArrays` array were 0, 1, 2, 3, ..., `combinedIndices`
-       contains new ones into new (shorter) `newInterleavedArrays` array. */
-    std::vector<UnsignedInt> combinedIndices;
-    combinedIndices.reserve(interleavedArrays.size()/stride);
-    std::vector<UnsignedInt> newInterleavedArrays;
-    for(std::size_t oldIndex = 0, end = interleavedArrays.size()/stride; oldIndex != end; ++oldIndex) {
-        /* Try to insert new index combination to the map */
-        const auto result = indexCombinations.emplace(oldIndex, indexCombinations.size());
-
-        /* Add the (either new or already existing) index to resulting index array */
-        combinedIndices.push_back(result.first->second);
-
-        /* If this is new combination, copy it to new interleaved arrays */
-        if(result.second) newInterleavedArrays.insert(newInterleavedArrays.end(),
-            interleavedArrays.begin()+oldIndex*stride,
-            interleavedArrays.begin()+(oldIndex+1)*stride);
-    }
-
-    CORRADE_INTERNAL_ASSERT(combinedIndices.size() == interleavedArrays.size()/stride &&
-                            newInterleavedArrays.size() <= interleavedArrays.size());
+    IndexArrayCombiner combiner;
+    return combineInterleavedIndexArrays(interleavedArrays, stride, combiner);
+}
 
-    return {std::move(combinedIndices), std::move(newInterleavedArrays)};
+std::pair<std::vector<UnsignedInt>, std::vector<UnsignedInt>> combineIndexArrays(const std::vector<UnsignedInt>& interleavedArrays, const UnsignedInt stride, ThreadPool& pool) {
+    IndexArrayCombiner combiner{pool};
+    return combineInterleavedIndexArrays(interleavedArrays, stride, combiner);
 }
 
 }}
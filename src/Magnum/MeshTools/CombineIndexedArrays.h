@@ -26,21 +26,136 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::MeshTools::combineIndexArrays(), @ref Magnum::MeshTools::combineIndexedArrays()
+ * @brief Class @ref Magnum::MeshTools::IndexArrayCombiner, function @ref Magnum::MeshTools::combineIndexArrays(), @ref Magnum::MeshTools::combineIndexedArrays()
  */
 
 #include <functional>
+#include <initializer_list>
 #include <tuple>
 #include <vector>
+#include <Corrade/Containers/ArrayView.h>
 #include <Corrade/Utility/Assert.h>
 
-#include "Magnum/Types.h"
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/duplicateTable.h"
 #include "Magnum/MeshTools/visibility.h"
 
 namespace Magnum { namespace MeshTools {
 
+/**
+@brief Index array combiner
+
+Reusable implementation of @ref combineIndexArrays() and
+@ref combineIndexedArrays(). Scratch memory used for hashing is kept between
+calls, so combining index arrays of many meshes in a row (such as when
+importing an OBJ file with separate position, normal and texture coordinate
+indices) doesn't need to allocate for each mesh:
+
+@code{.cpp}
+ThreadPool pool;
+MeshTools::IndexArrayCombiner combiner{pool};
+
+for(std::size_t i = 0; i != meshCount; ++i) {
+    Containers::ArrayView<const UnsignedInt> positionIndices, normalIndices;
+    // fill the views with data for i-th mesh ...
+
+    Containers::Array<UnsignedInt> combinedIndices{positionIndices.size()};
+    const std::size_t count = combiner.interleaveAndCombine(
+        {positionIndices, normalIndices}, combinedIndices);
+
+    // combiner.combinations() contains count pairs of position and normal
+    // indices, use them to create the vertex data ...
+}
+@endcode
+
+When constructed with a @ref ThreadPool, hashing is done in parallel. The
+index combinations are split into partitions by their hash and each
+partition is deduplicated on a separate thread with its own hash table, the
+results then get merged in a single linear pass. The output is the same
+regardless of thread count.
+*/
+class MAGNUM_MESHTOOLS_EXPORT IndexArrayCombiner {
+    public:
+        /** @brief Constructor */
+        explicit IndexArrayCombiner();
+
+        /**
+         * @brief Construct with a thread pool
+         *
+         * The pool is expected to stay in scope for the whole combiner
+         * lifetime.
+         */
+        explicit IndexArrayCombiner(ThreadPool& pool);
+
+        ~IndexArrayCombiner();
+
+        /**
+         * @brief Reserve scratch memory
+         *
+         * Preallocates memory for combining @p count combinations with given
+         * @p stride. Not needed for correct function, but avoids allocations
+         * in the first calls.
+         */
+        void reserve(std::size_t count, UnsignedInt stride);
+
+        /**
+         * @brief Combine interleaved index arrays in place
+         * @param[in,out] interleavedArrays Interleaved index arrays
+         * @param[in] stride                Count of interleaved arrays
+         * @param[out] combinedIndices      Combined index array, expected
+         *      to have size of @p interleavedArrays divided by @p stride
+         * @return Count of unique index combinations
+         *
+         * Unique combinations are moved to the front of
+         * @p interleavedArrays, preserving order of their first occurence,
+         * the rest is left in unspecified state. Otherwise the same as
+         * @ref combineIndexArrays(const std::vector<UnsignedInt>&, UnsignedInt).
+         */
+        std::size_t combineInPlace(Containers::ArrayView<UnsignedInt> interleavedArrays, UnsignedInt stride, Containers::ArrayView<UnsignedInt> combinedIndices);
+
+        /**
+         * @brief Interleave and combine index arrays
+         * @param[in] arrays            Index arrays, all expected to have
+         *      the same size
+         * @param[out] combinedIndices  Combined index array, expected to
+         *      have the same size as all @p arrays
+         * @return Count of unique index combinations
+         *
+         * Interleaves the arrays into internal memory and calls
+         * @ref combineInPlace() on it. The unique combinations are then
+         * available through @ref combinations() until next call.
+         */
+        std::size_t interleaveAndCombine(Containers::ArrayView<const Containers::ArrayView<const UnsignedInt>> arrays, Containers::ArrayView<UnsignedInt> combinedIndices);
+
+        /** @overload */
+        std::size_t interleaveAndCombine(std::initializer_list<Containers::ArrayView<const UnsignedInt>> arrays, Containers::ArrayView<UnsignedInt> combinedIndices) {
+            return interleaveAndCombine(Containers::ArrayView<const Containers::ArrayView<const UnsignedInt>>{arrays.begin(), arrays.size()}, combinedIndices);
+        }
+
+        /**
+         * @brief Unique index combinations
+         *
+         * Interleaved unique combinations from the last call to
+         * @ref interleaveAndCombine(). The j-th index of i-th combination
+         * is at position @cpp i*arrays.size() + j @ce.
+         */
+        Containers::ArrayView<const UnsignedInt> combinations() const {
+            return {_interleaved.data(), _combinationCount*_stride};
+        }
+
+    private:
+        ThreadPool* _pool;
+        std::vector<UnsignedInt> _interleaved;
+        std::size_t _combinationCount;
+        UnsignedInt _stride;
+
+        std::vector<UnsignedLong> _hashes;
+        std::vector<UnsignedInt> _first, _order, _partitionOffsets;
+        std::vector<Implementation::DuplicateTable> _tables;
+};
+
 namespace Implementation {
-    MAGNUM_MESHTOOLS_EXPORT std::vector<UnsignedInt> combineIndexArrays(const std::reference_wrapper<std::vector<UnsignedInt>>* begin, const std::reference_wrapper<std::vector<UnsignedInt>>* end);
+    MAGNUM_MESHTOOLS_EXPORT std::vector<UnsignedInt> combineIndexArrays(const std::reference_wrapper<std::vector<UnsignedInt>>* begin, const std::reference_wrapper<std::vector<UnsignedInt>>* end, ThreadPool* pool);
 }
 
 /**
@@ -86,12 +201,28 @@ internally. See also @ref combineIndexedArrays() which does the vertex data
 reordering automatically.
 */
 inline std::vector<UnsignedInt> combineIndexArrays(const std::vector<std::reference_wrapper<std::vector<UnsignedInt>>>& arrays) {
-    return Implementation::combineIndexArrays(&arrays[0], &arrays[0] + arrays.size());
+    return Implementation::combineIndexArrays(&arrays[0], &arrays[0] + arrays.size(), nullptr);
 }
 
 /** @overload */
 inline std::vector<UnsignedInt> combineIndexArrays(std::initializer_list<std::reference_wrapper<std::vector<UnsignedInt>>> arrays) {
-    return Implementation::combineIndexArrays(arrays.begin(), arrays.end());
+    return Implementation::combineIndexArrays(arrays.begin(), arrays.end(), nullptr);
+}
+
+/**
+@brief Combine index arrays in parallel
+
+Same as @ref combineIndexArrays(const std::vector<std::reference_wrapper<std::vector<UnsignedInt>>>&),
+but with the hashing distributed across threads of @p pool. See
+@ref IndexArrayCombiner for details.
+*/
+inline std::vector<UnsignedInt> combineIndexArrays(const std::vector<std::reference_wrapper<std::vector<UnsignedInt>>>& arrays, ThreadPool& pool) {
+    return Implementation::combineIndexArrays(&arrays[0], &arrays[0] + arrays.size(), &pool);
+}
+
+/** @overload */
+inline std::vector<UnsignedInt> combineIndexArrays(std::initializer_list<std::reference_wrapper<std::vector<UnsignedInt>>> arrays, ThreadPool& pool) {
+    return Implementation::combineIndexArrays(arrays.begin(), arrays.end(), &pool);
 }
 
 /**
@@ -113,13 +244,22 @@ And second pair value is the cleaned up interleaved array:
 
     0 1 2 3 5 4 0 4 1 6 3 1 2 1
 
-@see @ref combineIndexedArrays()
+@see @ref combineIndexedArrays(), @ref IndexArrayCombiner::combineInPlace()
 */
 MAGNUM_MESHTOOLS_EXPORT std::pair<std::vector<UnsignedInt>, std::vector<UnsignedInt>> combineIndexArrays(const std::vector<UnsignedInt>& interleavedArrays, UnsignedInt stride);
 
+/**
+@brief Combine interleaved index arrays in parallel
+
+Same as @ref combineIndexArrays(const std::vector<UnsignedInt>&, UnsignedInt),
+but with the hashing distributed across threads of @p pool. See
+@ref IndexArrayCombiner for details.
+*/
+MAGNUM_MESHTOOLS_EXPORT std::pair<std::vector<UnsignedInt>, std::vector<UnsignedInt>> combineIndexArrays(const std::vector<UnsignedInt>& interleavedArrays, UnsignedInt stride, ThreadPool& pool);
+
 namespace Implementation {
 
-MAGNUM_MESHTOOLS_EXPORT std::pair<std::vector<UnsignedInt>, std::vector<UnsignedInt>> interleaveAndCombineIndexArrays(const std::reference_wrapper<const std::vector<UnsignedInt>>* begin, const std::reference_wrapper<const std::vector<UnsignedInt>>* end);
+MAGNUM_MESHTOOLS_EXPORT std::pair<std::vector<UnsignedInt>, std::vector<UnsignedInt>> interleaveAndCombineIndexArrays(const std::reference_wrapper<const std::vector<UnsignedInt>>* begin, const std::reference_wrapper<const std::vector<UnsignedInt>>* end, ThreadPool* pool);
 
 template<class T> void writeCombinedArray(const UnsignedInt stride, const UnsignedInt offset, const std::vector<UnsignedInt>& interleavedCombinedIndexArrays, std::vector<T>& array) {
     /* Can't use duplicate() here because we aren't accessing the index data sequentially */
@@ -173,7 +313,7 @@ template<class ...T> std::vector<UnsignedInt> combineIndexedArrays(const std::pa
     std::vector<UnsignedInt> combinedIndices;
     std::vector<UnsignedInt> interleavedCombinedIndexArrays;
     auto i = {std::ref(indexedArrays.first)...};
-    std::tie(combinedIndices, interleavedCombinedIndexArrays) = Implementation::interleaveAndCombineIndexArrays(i.begin(), i.end());
+    std::tie(combinedIndices, interleavedCombinedIndexArrays) = Implementation::interleaveAndCombineIndexArrays(i.begin(), i.end(), nullptr);
 
     /* Write combined arrays */
     Implementation::writeCombinedArrays(sizeof...(T), 0, interleavedCombinedIndexArrays, indexedArrays.second...);
@@ -181,6 +321,24 @@ template<class ...T> std::vector<UnsignedInt> combineIndexedArrays(const std::pa
     return combinedIndices;
 }
 
+/**
+@brief Combine indexed arrays in parallel
+
+Same as @ref combineIndexedArrays(const std::pair<const std::vector<UnsignedInt>&, std::vector<T>&>&...),
+but with the hashing distributed across threads of @p pool. See
+@ref IndexArrayCombiner for details.
+*/
+template<class ...T> std::vector<UnsignedInt> combineIndexedArrays(ThreadPool& pool, const std::pair<const std::vector<UnsignedInt>&, std::vector<T>&>&... indexedArrays) {
+    std::vector<UnsignedInt> combinedIndices;
+    std::vector<UnsignedInt> interleavedCombinedIndexArrays;
+    auto i = {std::ref(indexedArrays.first)...};
+    std::tie(combinedIndices, interleavedCombinedIndexArrays) = Implementation::interleaveAndCombineIndexArrays(i.begin(), i.end(), &pool);
+
+    Implementation::writeCombinedArrays(sizeof...(T), 0, interleavedCombinedIndexArrays, indexedArrays.second...);
+
+    return combinedIndices;
+}
+
 }}
 
 #endif
@@ -25,10 +25,16 @@
 
 #include "Compile.h"
 
+#include <Corrade/Utility/Debug.h>
+
 #include "Magnum/Buffer.h"
-#include "Magnum/Math/Vector3.h"
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/Math/Vector4.h"
+#include "Magnum/MeshTools/BufferArena.h"
 #include "Magnum/MeshTools/CompressIndices.h"
-#include "Magnum/MeshTools/Interleave.h"
+#include "Magnum/MeshTools/Pack.h"
+#include "Magnum/Trade/MeshData.h"
 #include "Magnum/Trade/MeshData2D.h"
 #include "Magnum/Trade/MeshData3D.h"
 
@@ -38,131 +44,349 @@
 
 namespace Magnum { namespace MeshTools {
 
-std::tuple<Mesh, std::unique_ptr<Buffer>, std::unique_ptr<Buffer>> compile(const Trade::MeshData2D& meshData, const BufferUsage usage) {
-    Mesh mesh;
-    mesh.setPrimitive(meshData.primitive());
+namespace {
+
+/* View on one attribute inside interleaved vertex data */
+template<class T> StridedArrayView<T> attributeView(Containers::Array<char>& data, const std::size_t offset, const std::size_t stride) {
+    return StridedArrayView<T>{reinterpret_cast<T*>(data.data() + offset), data.size()/stride, stride};
+}
+
+template<class T> Containers::ArrayView<const T> arrayView(const std::vector<T>& data) {
+    return {data.data(), data.size()};
+}
+
+template<class T> void copyInto(const std::vector<T>& in, const StridedArrayView<T> out) {
+    for(std::size_t i = 0; i != in.size(); ++i) out[i] = in[i];
+}
+
+void compileIndices(Mesh& mesh, std::unique_ptr<Buffer>& indexBuffer, const std::vector<UnsignedInt>& indices, const BufferUsage usage) {
+    indexBuffer.reset(new Buffer{Buffer::TargetHint::ElementArray});
+
+    /* Compress directly into the buffer memory */
+    Mesh::IndexType indexType;
+    UnsignedInt indexStart, indexEnd;
+    std::tie(indexType, indexStart, indexEnd) = MeshTools::compressIndices(Containers::ArrayView<const UnsignedInt>{indices.data(), indices.size()}, *indexBuffer, usage);
+    mesh.setCount(indices.size())
+        .setIndexBuffer(*indexBuffer, 0, indexType, indexStart, indexEnd);
+}
 
-    /* Decide about stride and offsets */
-    UnsignedInt stride = sizeof(Shaders::Generic2D::Position::Type);
-    const UnsignedInt normalOffset = sizeof(Shaders::Generic2D::Position::Type);
+struct Layout2D {
+    UnsignedInt positionSize, textureCoordsSize, textureCoordsOffset, stride;
+};
+
+/* Decide about stride and offsets */
+Layout2D layout(const Trade::MeshData2D& meshData, const CompileFlags flags) {
+    Layout2D l;
+    l.positionSize = flags & CompileFlag::HalfFloatPositions ?
+        sizeof(Math::Vector2<UnsignedShort>) : sizeof(Shaders::Generic2D::Position::Type);
+    l.textureCoordsSize = flags & CompileFlag::PackTextureCoordinates ?
+        sizeof(Math::Vector2<UnsignedShort>) : sizeof(Shaders::Generic2D::TextureCoordinates::Type);
+    l.stride = l.positionSize;
+    l.textureCoordsOffset = l.positionSize;
     if(meshData.hasTextureCoords2D())
-        stride += sizeof(Shaders::Generic2D::TextureCoordinates::Type);
+        l.stride += l.textureCoordsSize;
+    return l;
+}
 
-    /* Create vertex buffer */
-    std::unique_ptr<Buffer> vertexBuffer{new Buffer{Buffer::TargetHint::Array}};
+/* Interleaves the vertex data and configures the mesh attributes, starting at
+   given offset in the vertex buffer. Returns the data to upload. */
+Containers::Array<char> compileVertices(Mesh& mesh, Buffer& vertexBuffer, const GLintptr offset, const Trade::MeshData2D& meshData, const CompileFlags flags, const Layout2D& l) {
+    const UnsignedInt positionSize = l.positionSize;
+    const UnsignedInt textureCoordsSize = l.textureCoordsSize;
+    const UnsignedInt textureCoordsOffset = l.textureCoordsOffset;
+    const UnsignedInt stride = l.stride;
+
+    Containers::Array<char> data{Containers::ValueInit, meshData.positions(0).size()*stride};
 
     /* Interleave positions */
-    Containers::Array<char> data = MeshTools::interleave(
-        meshData.positions(0),
-        stride - sizeof(Shaders::Generic2D::Position::Type));
-    mesh.addVertexBuffer(*vertexBuffer, 0,
-        Shaders::Generic2D::Position(),
-        stride - sizeof(Shaders::Generic2D::Position::Type));
+    if(flags & CompileFlag::HalfFloatPositions) {
+        packHalfInto<2>(arrayView(meshData.positions(0)),
+            attributeView<Math::Vector<2, UnsignedShort>>(data, 0, stride));
+        mesh.addVertexBuffer(vertexBuffer, offset,
+            Shaders::Generic2D::Position{Shaders::Generic2D::Position::DataType::HalfFloat},
+            stride - positionSize);
+    } else {
+        copyInto(meshData.positions(0), attributeView<Vector2>(data, 0, stride));
+        mesh.addVertexBuffer(vertexBuffer, offset,
+            Shaders::Generic2D::Position(),
+            stride - positionSize);
+    }
 
     /* Add also texture coordinates, if present */
     if(meshData.hasTextureCoords2D()) {
-        MeshTools::interleaveInto(data,
-            normalOffset,
-            meshData.textureCoords2D(0),
-            stride - normalOffset - sizeof(Shaders::Generic2D::TextureCoordinates::Type));
-        mesh.addVertexBuffer(*vertexBuffer, 0,
-            normalOffset,
-            Shaders::Generic2D::TextureCoordinates(),
-            stride - normalOffset - sizeof(Shaders::Generic2D::TextureCoordinates::Type));
+        if(flags & CompileFlag::PackTextureCoordinates) {
+            packInto<Math::Vector2<UnsignedShort>, Vector2>(arrayView(meshData.textureCoords2D(0)),
+                attributeView<Math::Vector2<UnsignedShort>>(data, textureCoordsOffset, stride));
+            mesh.addVertexBuffer(vertexBuffer, offset,
+                textureCoordsOffset,
+                Shaders::Generic2D::TextureCoordinates{
+                    Shaders::Generic2D::TextureCoordinates::DataType::UnsignedShort,
+                    Shaders::Generic2D::TextureCoordinates::DataOption::Normalized},
+                stride - textureCoordsOffset - textureCoordsSize);
+        } else {
+            copyInto(meshData.textureCoords2D(0), attributeView<Vector2>(data, textureCoordsOffset, stride));
+            mesh.addVertexBuffer(vertexBuffer, offset,
+                textureCoordsOffset,
+                Shaders::Generic2D::TextureCoordinates(),
+                stride - textureCoordsOffset - textureCoordsSize);
+        }
     }
 
-    /* Fill vertex buffer with interleaved data */
-    vertexBuffer->setData(data, usage);
-
-    /* If indexed, fill index buffer and configure indexed mesh */
-    std::unique_ptr<Buffer> indexBuffer;
-    if(meshData.isIndexed()) {
-        Containers::Array<char> indexData;
-        Mesh::IndexType indexType;
-        UnsignedInt indexStart, indexEnd;
-        std::tie(indexData, indexType, indexStart, indexEnd) = MeshTools::compressIndices(meshData.indices());
-
-        indexBuffer.reset(new Buffer{Buffer::TargetHint::ElementArray});
-        indexBuffer->setData(indexData, usage);
-        mesh.setCount(meshData.indices().size())
-            .setIndexBuffer(*indexBuffer, 0, indexType, indexStart, indexEnd);
-
-    /* Else set vertex count */
-    } else mesh.setCount(meshData.positions(0).size());
-
-    return std::make_tuple(std::move(mesh), std::move(vertexBuffer), std::move(indexBuffer));
+    return data;
 }
 
-std::tuple<Mesh, std::unique_ptr<Buffer>, std::unique_ptr<Buffer>> compile(const Trade::MeshData3D& meshData, const BufferUsage usage) {
-    Mesh mesh;
-    mesh.setPrimitive(meshData.primitive());
+struct Layout3D {
+    UnsignedInt positionSize, normalSize, textureCoordsSize, normalOffset, textureCoordsOffset, stride;
+};
 
-    /* Decide about stride and offsets */
-    UnsignedInt stride = sizeof(Shaders::Generic3D::Position::Type);
-    const UnsignedInt normalOffset = sizeof(Shaders::Generic3D::Position::Type);
-    UnsignedInt textureCoordsOffset = sizeof(Shaders::Generic3D::Position::Type);
+/* Decide about stride and offsets. Half-float positions are padded to keep
+   four-byte alignment of the following attributes. */
+Layout3D layout(const Trade::MeshData3D& meshData, const CompileFlags flags) {
+    Layout3D l;
+    l.positionSize = flags & CompileFlag::HalfFloatPositions ?
+        sizeof(Math::Vector4<UnsignedShort>) : sizeof(Shaders::Generic3D::Position::Type);
+    l.normalSize = flags & CompileFlag::PackNormals ?
+        4 : sizeof(Shaders::Generic3D::Normal::Type);
+    l.textureCoordsSize = flags & CompileFlag::PackTextureCoordinates ?
+        sizeof(Math::Vector2<UnsignedShort>) : sizeof(Shaders::Generic3D::TextureCoordinates::Type);
+    l.stride = l.positionSize;
+    l.normalOffset = l.positionSize;
+    l.textureCoordsOffset = l.positionSize;
     if(meshData.hasNormals()) {
-        stride += sizeof(Shaders::Generic3D::Normal::Type);
-        textureCoordsOffset += sizeof(Shaders::Generic3D::Normal::Type);
+        l.stride += l.normalSize;
+        l.textureCoordsOffset += l.normalSize;
     }
     if(meshData.hasTextureCoords2D())
-        stride += sizeof(Shaders::Generic3D::TextureCoordinates::Type);
+        l.stride += l.textureCoordsSize;
+    return l;
+}
 
-    /* Create vertex buffer */
-    std::unique_ptr<Buffer> vertexBuffer{new Buffer{Buffer::TargetHint::Array}};
+Containers::Array<char> compileVertices(Mesh& mesh, Buffer& vertexBuffer, const GLintptr offset, const Trade::MeshData3D& meshData, const CompileFlags flags, const Layout3D& l) {
+    const UnsignedInt positionSize = l.positionSize;
+    const UnsignedInt normalSize = l.normalSize;
+    const UnsignedInt textureCoordsSize = l.textureCoordsSize;
+    const UnsignedInt normalOffset = l.normalOffset;
+    const UnsignedInt textureCoordsOffset = l.textureCoordsOffset;
+    const UnsignedInt stride = l.stride;
+
+    Containers::Array<char> data{Containers::ValueInit, meshData.positions(0).size()*stride};
 
     /* Interleave positions */
-    Containers::Array<char> data = MeshTools::interleave(
-        meshData.positions(0),
-        stride - sizeof(Shaders::Generic3D::Position::Type));
-    mesh.addVertexBuffer(*vertexBuffer, 0,
-        Shaders::Generic3D::Position(),
-        stride - sizeof(Shaders::Generic3D::Position::Type));
+    if(flags & CompileFlag::HalfFloatPositions) {
+        packHalfInto<3>(arrayView(meshData.positions(0)),
+            attributeView<Math::Vector<3, UnsignedShort>>(data, 0, stride));
+        mesh.addVertexBuffer(vertexBuffer, offset,
+            Shaders::Generic3D::Position{Shaders::Generic3D::Position::DataType::HalfFloat},
+            stride - sizeof(Math::Vector3<UnsignedShort>));
+    } else {
+        copyInto(meshData.positions(0), attributeView<Vector3>(data, 0, stride));
+        mesh.addVertexBuffer(vertexBuffer, offset,
+            Shaders::Generic3D::Position(),
+            stride - positionSize);
+    }
 
     /* Add also normals, if present */
     if(meshData.hasNormals()) {
-        MeshTools::interleaveInto(data,
-            normalOffset,
-            meshData.normals(0),
-            stride - normalOffset - sizeof(Shaders::Generic3D::Normal::Type));
-        mesh.addVertexBuffer(*vertexBuffer, 0,
-            normalOffset,
-            Shaders::Generic3D::Normal(),
-            stride - normalOffset - sizeof(Shaders::Generic3D::Normal::Type));
+        if(flags & CompileFlag::PackNormals) {
+            #ifndef MAGNUM_TARGET_GLES2
+            packNormalsInto(arrayView(meshData.normals(0)),
+                attributeView<UnsignedInt>(data, normalOffset, stride));
+            mesh.addVertexBuffer(vertexBuffer, offset + normalOffset, GLsizei(stride),
+                DynamicAttribute{DynamicAttribute::Kind::GenericNormalized,
+                    Shaders::Generic3D::Normal::Location,
+                    DynamicAttribute::Components::Four,
+                    DynamicAttribute::DataType::Int2101010Rev});
+            #else
+            packInto<Math::Vector3<Byte>, Vector3>(arrayView(meshData.normals(0)),
+                attributeView<Math::Vector3<Byte>>(data, normalOffset, stride));
+            mesh.addVertexBuffer(vertexBuffer, offset,
+                normalOffset,
+                Shaders::Generic3D::Normal{
+                    Shaders::Generic3D::Normal::DataType::Byte,
+                    Shaders::Generic3D::Normal::DataOption::Normalized},
+                stride - normalOffset - sizeof(Math::Vector3<Byte>));
+            #endif
+        } else {
+            copyInto(meshData.normals(0), attributeView<Vector3>(data, normalOffset, stride));
+            mesh.addVertexBuffer(vertexBuffer, offset,
+                normalOffset,
+                Shaders::Generic3D::Normal(),
+                stride - normalOffset - normalSize);
+        }
     }
 
     /* Add also texture coordinates, if present */
     if(meshData.hasTextureCoords2D()) {
-        MeshTools::interleaveInto(data,
-            textureCoordsOffset,
-            meshData.textureCoords2D(0),
-            stride - textureCoordsOffset - sizeof(Shaders::Generic3D::TextureCoordinates::Type));
-        mesh.addVertexBuffer(*vertexBuffer, 0,
-            textureCoordsOffset,
-            Shaders::Generic3D::TextureCoordinates(),
-            stride - textureCoordsOffset - sizeof(Shaders::Generic3D::TextureCoordinates::Type));
+        if(flags & CompileFlag::PackTextureCoordinates) {
+            packInto<Math::Vector2<UnsignedShort>, Vector2>(arrayView(meshData.textureCoords2D(0)),
+                attributeView<Math::Vector2<UnsignedShort>>(data, textureCoordsOffset, stride));
+            mesh.addVertexBuffer(vertexBuffer, offset,
+                textureCoordsOffset,
+                Shaders::Generic3D::TextureCoordinates{
+                    Shaders::Generic3D::TextureCoordinates::DataType::UnsignedShort,
+                    Shaders::Generic3D::TextureCoordinates::DataOption::Normalized},
+                stride - textureCoordsOffset - textureCoordsSize);
+        } else {
+            copyInto(meshData.textureCoords2D(0), attributeView<Vector2>(data, textureCoordsOffset, stride));
+            mesh.addVertexBuffer(vertexBuffer, offset,
+                textureCoordsOffset,
+                Shaders::Generic3D::TextureCoordinates(),
+                stride - textureCoordsOffset - textureCoordsSize);
+        }
     }
 
-    /* Fill vertex buffer with interleaved data */
-    vertexBuffer->setData(data, usage);
+    return data;
+}
+
+template<class MeshData> std::tuple<Mesh, std::unique_ptr<Buffer>, std::unique_ptr<Buffer>> compileInternal(const MeshData& meshData, const BufferUsage usage, const CompileFlags flags) {
+    Mesh mesh;
+    mesh.setPrimitive(meshData.primitive());
+
+    /* Create vertex buffer and fill it with interleaved data */
+    std::unique_ptr<Buffer> vertexBuffer{new Buffer{Buffer::TargetHint::Array}};
+    vertexBuffer->setData(compileVertices(mesh, *vertexBuffer, 0, meshData, flags, layout(meshData, flags)), usage);
 
     /* If indexed, fill index buffer and configure indexed mesh */
     std::unique_ptr<Buffer> indexBuffer;
-    if(meshData.isIndexed()) {
-        Containers::Array<char> indexData;
-        Mesh::IndexType indexType;
-        UnsignedInt indexStart, indexEnd;
-        std::tie(indexData, indexType, indexStart, indexEnd) = MeshTools::compressIndices(meshData.indices());
+    if(meshData.isIndexed())
+        compileIndices(mesh, indexBuffer, meshData.indices(), usage);
 
-        indexBuffer.reset(new Buffer{Buffer::TargetHint::ElementArray});
-        indexBuffer->setData(indexData, usage);
+    /* Else set vertex count */
+    else mesh.setCount(meshData.positions(0).size());
+
+    return std::make_tuple(std::move(mesh), std::move(vertexBuffer), std::move(indexBuffer));
+}
+
+template<class MeshData> Containers::Optional<std::tuple<Mesh, BufferArena::Allocation>> compileInternal(const MeshData& meshData, BufferArena& arena, const CompileFlags flags) {
+    const auto l = layout(meshData, flags);
+    const std::size_t vertexCount = meshData.positions(0).size();
+
+    /* Compress the indices first to know how much space they need */
+    Containers::Array<char> indexData;
+    Mesh::IndexType indexType{};
+    UnsignedInt indexStart{}, indexEnd{};
+    if(meshData.isIndexed())
+        std::tie(indexData, indexType, indexStart, indexEnd) = compressIndices(meshData.indices());
+
+    /* Align the vertex data to the stride so they can be addressed with base
+       vertex */
+    const Containers::Optional<BufferArena::Allocation> allocation = arena.allocate(vertexCount*l.stride, l.stride, indexData.size(), indexData.empty() ? 1 : Mesh::indexSize(indexType));
+    if(!allocation) {
+        Error() << "MeshTools::compile(): not enough space in the arena for" << vertexCount*l.stride << "bytes of vertex data and" << indexData.size() << "bytes of index data";
+        return Containers::NullOpt;
+    }
+
+    /* If possible, the attributes point to the beginning of the vertex buffer
+       and the mesh is offset using base vertex, so all meshes of the same
+       layout differ only in draw parameters. Indexed meshes need
+       ARB_draw_elements_base_vertex for that, otherwise the attribute offsets
+       are used. */
+    #ifndef MAGNUM_TARGET_GLES
+    const bool useBaseVertex = !meshData.isIndexed() || Context::current().isExtensionSupported<Extensions::GL::ARB::draw_elements_base_vertex>();
+    #else
+    const bool useBaseVertex = !meshData.isIndexed();
+    #endif
+
+    Mesh mesh;
+    mesh.setPrimitive(meshData.primitive());
+    arena.vertexBuffer().setSubData(allocation->vertexOffset, compileVertices(mesh, arena.vertexBuffer(), useBaseVertex ? 0 : allocation->vertexOffset, meshData, flags, l));
+    if(useBaseVertex) mesh.setBaseVertex(allocation->vertexOffset/l.stride);
+
+    if(meshData.isIndexed()) {
+        arena.indexBuffer().setSubData(allocation->indexOffset, indexData);
         mesh.setCount(meshData.indices().size())
-            .setIndexBuffer(*indexBuffer, 0, indexType, indexStart, indexEnd);
+            .setIndexBuffer(arena.indexBuffer(), allocation->indexOffset, indexType, indexStart, indexEnd);
+    } else mesh.setCount(vertexCount);
 
-    /* Else set vertex count */
-    } else mesh.setCount(meshData.positions(0).size());
+    return std::make_tuple(std::move(mesh), *allocation);
+}
+
+/* Points the attributes into vertex data starting at given offset */
+void addAttributes(Mesh& mesh, Buffer& vertexBuffer, const GLintptr offset, const Trade::MeshData& meshData) {
+    for(UnsignedInt i = 0; i != meshData.attributeCount(); ++i) {
+        const Trade::MeshAttributeData& attribute = meshData.attribute(i);
+
+        UnsignedInt location{};
+        switch(attribute.name()) {
+            case Trade::MeshAttributeName::Position:
+                location = Shaders::Generic3D::Position::Location;
+                break;
+            case Trade::MeshAttributeName::Normal:
+                location = Shaders::Generic3D::Normal::Location;
+                break;
+            case Trade::MeshAttributeName::TextureCoordinates:
+                location = Shaders::Generic3D::TextureCoordinates::Location;
+                break;
+            case Trade::MeshAttributeName::Color:
+                location = Shaders::Generic3D::Color::Location;
+                break;
+        }
+
+        mesh.addVertexBuffer(vertexBuffer, offset + attribute.offset(), GLsizei(attribute.stride()),
+            DynamicAttribute{attribute.kind(), location, attribute.components(), attribute.dataType()});
+    }
+}
+
+}
+
+std::tuple<Mesh, std::unique_ptr<Buffer>, std::unique_ptr<Buffer>> compile(const Trade::MeshData2D& meshData, const BufferUsage usage, const CompileFlags flags) {
+    return compileInternal(meshData, usage, flags);
+}
+
+std::tuple<Mesh, std::unique_ptr<Buffer>, std::unique_ptr<Buffer>> compile(const Trade::MeshData3D& meshData, const BufferUsage usage, const CompileFlags flags) {
+    return compileInternal(meshData, usage, flags);
+}
+
+Containers::Optional<std::tuple<Mesh, BufferArena::Allocation>> compile(const Trade::MeshData2D& meshData, BufferArena& arena, const CompileFlags flags) {
+    return compileInternal(meshData, arena, flags);
+}
+
+Containers::Optional<std::tuple<Mesh, BufferArena::Allocation>> compile(const Trade::MeshData3D& meshData, BufferArena& arena, const CompileFlags flags) {
+    return compileInternal(meshData, arena, flags);
+}
+
+std::tuple<Mesh, std::unique_ptr<Buffer>, std::unique_ptr<Buffer>> compile(const Trade::MeshData& meshData, const BufferUsage usage) {
+    Mesh mesh;
+    mesh.setPrimitive(meshData.primitive());
+
+    /* Upload all vertex data at once and point the attributes into it */
+    std::unique_ptr<Buffer> vertexBuffer{new Buffer{Buffer::TargetHint::Array}};
+    vertexBuffer->setData(meshData.vertexData(), usage);
+    addAttributes(mesh, *vertexBuffer, 0, meshData);
+
+    /* Upload the index data as-is */
+    std::unique_ptr<Buffer> indexBuffer;
+    if(meshData.isIndexed()) {
+        indexBuffer.reset(new Buffer{Buffer::TargetHint::ElementArray});
+        indexBuffer->setData(meshData.indexData(), usage);
+        mesh.setCount(meshData.indexCount())
+            .setIndexBuffer(*indexBuffer, 0, meshData.indexType());
+    } else mesh.setCount(meshData.vertexCount());
 
     return std::make_tuple(std::move(mesh), std::move(vertexBuffer), std::move(indexBuffer));
 }
 
+Containers::Optional<std::tuple<Mesh, BufferArena::Allocation>> compile(const Trade::MeshData& meshData, BufferArena& arena) {
+    /* Attributes can have arbitrary strides, so the data are addressed only
+       using attribute offsets */
+    const Containers::Optional<BufferArena::Allocation> allocation = arena.allocate(meshData.vertexData().size(), 4, meshData.indexData().size(), meshData.isIndexed() ? Mesh::indexSize(meshData.indexType()) : 1);
+    if(!allocation) {
+        Error() << "MeshTools::compile(): not enough space in the arena for" << meshData.vertexData().size() << "bytes of vertex data and" << meshData.indexData().size() << "bytes of index data";
+        return Containers::NullOpt;
+    }
+
+    Mesh mesh;
+    mesh.setPrimitive(meshData.primitive());
+    arena.vertexBuffer().setSubData(allocation->vertexOffset, meshData.vertexData());
+    addAttributes(mesh, arena.vertexBuffer(), allocation->vertexOffset, meshData);
+
+    if(meshData.isIndexed()) {
+        arena.indexBuffer().setSubData(allocation->indexOffset, meshData.indexData());
+        mesh.setCount(meshData.indexCount())
+            .setIndexBuffer(arena.indexBuffer(), allocation->indexOffset, meshData.indexType());
+    } else mesh.setCount(meshData.vertexCount());
+
+    return std::make_tuple(std::move(mesh), *allocation);
+}
+
 }}
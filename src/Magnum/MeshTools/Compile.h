@@ -26,18 +26,59 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::MeshTools::compile()
+ * @brief Function @ref Magnum::MeshTools::compile(), enum @ref Magnum::MeshTools::CompileFlag, enum set @ref Magnum::MeshTools::CompileFlags
  */
 
 #include <tuple>
 #include <memory>
+#include <Corrade/Containers/EnumSet.h>
+#include <Corrade/Containers/Optional.h>
 
 #include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/BufferArena.h"
 #include "Magnum/Trade/Trade.h"
 #include "Magnum/MeshTools/visibility.h"
 
 namespace Magnum { namespace MeshTools {
 
+/**
+@brief Mesh compilation flag
+
+@see @ref CompileFlags, @ref compile()
+*/
+enum class CompileFlag: UnsignedByte {
+    /**
+     * Store positions as half-floats. Halves the size, but the precision is
+     * suitable only for small objects centered around origin. See
+     * @ref packHalfInto() for details.
+     */
+    HalfFloatPositions = 1 << 0,
+
+    /**
+     * Pack normals into signed normalized 10-10-10-2 format, taking four
+     * bytes instead of twelve. See @ref packNormalsInto() for details. On
+     * OpenGL ES 2.0 and WebGL 1.0 the normals are packed into signed
+     * normalized bytes instead.
+     */
+    PackNormals = 1 << 1,
+
+    /**
+     * Pack texture coordinates into unsigned normalized 16-bit values.
+     * Coordinates outside of the @f$ [0, 1] @f$ range get clamped. See
+     * @ref packInto() for details.
+     */
+    PackTextureCoordinates = 1 << 2
+};
+
+/**
+@brief Mesh compilation flags
+
+@see @ref compile()
+*/
+typedef Containers::EnumSet<CompileFlag> CompileFlags;
+
+CORRADE_ENUMSET_OPERATORS(CompileFlags)
+
 /**
 @brief Compile 2D mesh data
 
@@ -45,9 +86,10 @@ Configures mesh for @ref Shaders::Generic2D shader with vertex buffer and
 possibly also index buffer, if the mesh is indexed. Positions are bound to
 @ref Shaders::Generic2D::Position attribute. If the mesh contains texture
 coordinates, they are bound to @ref Shaders::Generic2D::TextureCoordinates
-attribute. No data compression or index optimization (except for index buffer
-packing) is done. The @p usage parameter is used for both vertex and index
-buffer.
+attribute. No index optimization (except for index buffer packing) is done,
+vertex data are packed according to @p flags, with each attribute aligned to
+four bytes. @ref CompileFlag::PackNormals is ignored. The @p usage parameter
+is used for both vertex and index buffer.
 
 The second returned buffer may be @cpp nullptr @ce if the mesh is not indexed.
 
@@ -57,7 +99,7 @@ greater flexibility.
 
 @see @ref shaders-generic
 */
-MAGNUM_MESHTOOLS_EXPORT std::tuple<Mesh, std::unique_ptr<Buffer>, std::unique_ptr<Buffer>> compile(const Trade::MeshData2D& meshData, BufferUsage usage);
+MAGNUM_MESHTOOLS_EXPORT std::tuple<Mesh, std::unique_ptr<Buffer>, std::unique_ptr<Buffer>> compile(const Trade::MeshData2D& meshData, BufferUsage usage, CompileFlags flags = {});
 
 /**
 @brief Compile 3D mesh data
@@ -66,9 +108,11 @@ Configures mesh for @ref Shaders::Generic3D shader with vertex buffer and
 possibly also index buffer, if the mesh is indexed. Positions are bound to
 @ref Shaders::Generic3D::Position attribute. If the mesh contains normals, they
 are bound to @ref Shaders::Generic3D::Normal attribute, texture coordinates are
-bound to @ref Shaders::Generic2D::TextureCoordinates attribute. No data
-compression or index optimization (except for index buffer packing) is done.
-The @p usage parameter is used for both vertex and index buffer.
+bound to @ref Shaders::Generic2D::TextureCoordinates attribute. No index
+optimization (except for index buffer packing) is done, vertex data are
+packed according to @p flags, with each attribute aligned to four bytes.
+Packing all three attributes reduces the vertex size from 32 to 16 bytes. The
+@p usage parameter is used for both vertex and index buffer.
 
 The second returned buffer may be @cpp nullptr @ce if the mesh is not indexed.
 
@@ -78,7 +122,65 @@ greater flexibility.
 
 @see @ref shaders-generic
 */
-MAGNUM_MESHTOOLS_EXPORT std::tuple<Mesh, std::unique_ptr<Buffer>, std::unique_ptr<Buffer>> compile(const Trade::MeshData3D& meshData, BufferUsage usage);
+MAGNUM_MESHTOOLS_EXPORT std::tuple<Mesh, std::unique_ptr<Buffer>, std::unique_ptr<Buffer>> compile(const Trade::MeshData3D& meshData, BufferUsage usage, CompileFlags flags = {});
+
+/**
+@brief Compile generic mesh data
+
+Uploads the vertex data to a vertex buffer and the index data, if the mesh is
+indexed, to an index buffer, each with a single @ref Buffer::setData() call
+and without any conversion. Each attribute is bound to the corresponding
+@ref Shaders::Generic attribute location based on its
+@ref Trade::MeshAttributeName, with the data type described by the
+attribute. The @p usage parameter is used for both vertex and index buffer.
+
+The second returned buffer may be @cpp nullptr @ce if the mesh is not indexed.
+@see @ref shaders-generic
+*/
+MAGNUM_MESHTOOLS_EXPORT std::tuple<Mesh, std::unique_ptr<Buffer>, std::unique_ptr<Buffer>> compile(const Trade::MeshData& meshData, BufferUsage usage);
+
+/**
+@brief Compile 2D mesh data into a buffer arena
+
+Same as @ref compile(const Trade::MeshData2D&, BufferUsage, CompileFlags), but
+instead of creating new buffers the data are uploaded into ranges allocated
+from @p arena using @ref BufferArena::allocate(). The vertex data are aligned
+to the vertex stride and the attributes point to the beginning of
+@ref BufferArena::vertexBuffer(), with the mesh offset using
+@ref Mesh::setBaseVertex(). That's not possible for indexed meshes if
+@extension{ARB,draw_elements_base_vertex} (part of OpenGL 3.2) is not
+supported and in OpenGL ES, in that case the attribute offsets point to the
+allocated range instead. The index data are put at the allocated offset in
+@ref BufferArena::indexBuffer().
+
+The returned allocation should be passed to @ref BufferArena::free() once the
+mesh is not needed anymore. If there's not enough space in the arena, prints a
+message to @ref Error and returns @ref Containers::NullOpt.
+*/
+MAGNUM_MESHTOOLS_EXPORT Containers::Optional<std::tuple<Mesh, BufferArena::Allocation>> compile(const Trade::MeshData2D& meshData, BufferArena& arena, CompileFlags flags = {});
+
+/**
+@brief Compile 3D mesh data into a buffer arena
+
+Same as @ref compile(const Trade::MeshData3D&, BufferUsage, CompileFlags), but
+uploading into ranges allocated from @p arena. See
+@ref compile(const Trade::MeshData2D&, BufferArena&, CompileFlags) for more
+information.
+*/
+MAGNUM_MESHTOOLS_EXPORT Containers::Optional<std::tuple<Mesh, BufferArena::Allocation>> compile(const Trade::MeshData3D& meshData, BufferArena& arena, CompileFlags flags = {});
+
+/**
+@brief Compile generic mesh data into a buffer arena
+
+Same as @ref compile(const Trade::MeshData&, BufferUsage), but uploading into
+ranges allocated from @p arena. Because the attributes can have arbitrary
+strides, the vertex data are aligned only to four bytes and the attributes
+always point into the allocated range instead of using
+@ref Mesh::setBaseVertex(). See
+@ref compile(const Trade::MeshData2D&, BufferArena&, CompileFlags) for more
+information.
+*/
+MAGNUM_MESHTOOLS_EXPORT Containers::Optional<std::tuple<Mesh, BufferArena::Allocation>> compile(const Trade::MeshData& meshData, BufferArena& arena);
 
 }}
 
@@ -29,49 +29,34 @@
 #include <algorithm>
 #include <Corrade/Containers/Array.h>
 
+#include "Magnum/Buffer.h"
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
 #include "Magnum/Math/Functions.h"
 
 namespace Magnum { namespace MeshTools {
 
 namespace {
 
-template<class T> inline Containers::Array<char> compress(const std::vector<UnsignedInt>& indices) {
-    Containers::Array<char> buffer(indices.size()*sizeof(T));
+template<class T, class U> void convertInto(const Containers::ArrayView<const T> indices, char* const out) {
     for(std::size_t i = 0; i != indices.size(); ++i) {
-        T index = static_cast<T>(indices[i]);
-        std::memcpy(buffer.begin()+i*sizeof(T), &index, sizeof(T));
+        const U index = U(indices[i]);
+        std::memcpy(out + i*sizeof(U), &index, sizeof(U));
     }
-
-    return buffer;
 }
 
 }
 
 std::tuple<Containers::Array<char>, Mesh::IndexType, UnsignedInt, UnsignedInt> compressIndices(const std::vector<UnsignedInt>& indices) {
     /** @todo Performance hint when range can be represented by smaller value? */
-    const auto minmax = std::minmax_element(indices.begin(), indices.end());
-    Containers::Array<char> data;
+    const Containers::ArrayView<const UnsignedInt> view{indices.data(), indices.size()};
     Mesh::IndexType type;
-    switch(Math::log(256, *minmax.second)) {
-        case 0:
-            data = compress<UnsignedByte>(indices);
-            type = Mesh::IndexType::UnsignedByte;
-            break;
-        case 1:
-            data = compress<UnsignedShort>(indices);
-            type = Mesh::IndexType::UnsignedShort;
-            break;
-        case 2:
-        case 3:
-            data = compress<UnsignedInt>(indices);
-            type = Mesh::IndexType::UnsignedInt;
-            break;
-
-        default:
-            CORRADE_ASSERT(false, "MeshTools::compressIndices(): no type able to index" << *minmax.second << "elements.", {});
-    }
+    UnsignedInt start, end;
+    std::tie(type, start, end) = compressedIndexType(view);
 
-    return std::make_tuple(std::move(data), type, *minmax.first, *minmax.second);
+    Containers::Array<char> data{indices.size()*Mesh::indexSize(type)};
+    compressIndicesInto(view, type, data);
+    return std::make_tuple(std::move(data), type, start, end);
 }
 
 template<class T> Containers::Array<T> compressIndicesAs(const std::vector<UnsignedInt>& indices) {
@@ -87,8 +72,106 @@ template<class T> Containers::Array<T> compressIndicesAs(const std::vector<Unsig
     return buffer;
 }
 
+template<class T> void compressIndicesInto(const Containers::ArrayView<const UnsignedInt> indices, const Containers::ArrayView<T> out) {
+    CORRADE_ASSERT(out.size() == indices.size(),
+        "MeshTools::compressIndicesInto(): expected output size" << indices.size() << "but got" << out.size(), );
+    #if !defined(CORRADE_NO_ASSERT) || defined(CORRADE_GRACEFUL_ASSERT)
+    if(!indices.empty()) {
+        const UnsignedInt max = *std::max_element(indices.begin(), indices.end());
+        CORRADE_ASSERT(Math::log(256, max) < sizeof(T), "MeshTools::compressIndicesInto(): type too small to represent value" << max, );
+    }
+    #endif
+
+    for(std::size_t i = 0; i != indices.size(); ++i)
+        out[i] = T(indices[i]);
+}
+
+template<class T> std::tuple<Mesh::IndexType, UnsignedInt, UnsignedInt> compressedIndexType(const Containers::ArrayView<const T> indices) {
+    if(indices.empty()) return std::make_tuple(Mesh::IndexType::UnsignedByte, 0u, 0u);
+
+    /* Single pass without branches to keep it vectorizable */
+    T min = indices[0], max = indices[0];
+    for(const T index: indices) {
+        min = Math::min(min, index);
+        max = Math::max(max, index);
+    }
+
+    Mesh::IndexType type;
+    if(max <= 0xff) type = Mesh::IndexType::UnsignedByte;
+    else if(max <= 0xffff) type = Mesh::IndexType::UnsignedShort;
+    else type = Mesh::IndexType::UnsignedInt;
+    return std::make_tuple(type, UnsignedInt(min), UnsignedInt(max));
+}
+
+template<class T> void compressIndicesInto(const Containers::ArrayView<const T> indices, const Mesh::IndexType type, const Containers::ArrayView<char> out) {
+    CORRADE_ASSERT(out.size() == indices.size()*Mesh::indexSize(type),
+        "MeshTools::compressIndicesInto(): expected output size" << indices.size()*Mesh::indexSize(type) << "but got" << out.size(), );
+    #if !defined(CORRADE_NO_ASSERT) || defined(CORRADE_GRACEFUL_ASSERT)
+    if(!indices.empty()) {
+        const UnsignedInt max = *std::max_element(indices.begin(), indices.end());
+        CORRADE_ASSERT(Math::log(256, max) < Mesh::indexSize(type), "MeshTools::compressIndicesInto(): type too small to represent value" << max, );
+    }
+    #endif
+
+    switch(type) {
+        case Mesh::IndexType::UnsignedByte:
+            convertInto<T, UnsignedByte>(indices, out.data());
+            return;
+        case Mesh::IndexType::UnsignedShort:
+            convertInto<T, UnsignedShort>(indices, out.data());
+            return;
+        case Mesh::IndexType::UnsignedInt:
+            convertInto<T, UnsignedInt>(indices, out.data());
+            return;
+    }
+
+    CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+template<class T> std::tuple<Mesh::IndexType, UnsignedInt, UnsignedInt> compressIndices(const Containers::ArrayView<const T> indices, Buffer& buffer, const BufferUsage usage) {
+    const std::tuple<Mesh::IndexType, UnsignedInt, UnsignedInt> range = compressedIndexType(indices);
+    const std::size_t size = indices.size()*Mesh::indexSize(std::get<0>(range));
+
+    #ifndef MAGNUM_TARGET_WEBGL
+    #ifndef MAGNUM_TARGET_GLES
+    if(size && Context::current().isExtensionSupported<Extensions::GL::ARB::map_buffer_range>())
+    #elif defined(MAGNUM_TARGET_GLES2)
+    if(size && Context::current().isExtensionSupported<Extensions::GL::EXT::map_buffer_range>())
+    #else
+    if(size)
+    #endif
+    {
+        buffer.setData({nullptr, size}, usage);
+        const Containers::ArrayView<char> data = buffer.map(0, size, Buffer::MapFlag::Write|Buffer::MapFlag::InvalidateBuffer);
+        if(data) {
+            compressIndicesInto(indices, std::get<0>(range), data);
+            /* If the data got corrupted during unmapping (which can happen
+               e.g. on a mode switch), upload them again the slow way */
+            if(buffer.unmap()) return range;
+        }
+    }
+    #endif
+
+    Containers::Array<char> data{size};
+    compressIndicesInto(indices, std::get<0>(range), data);
+    buffer.setData(data, usage);
+    return range;
+}
+
 template Containers::Array<UnsignedByte> compressIndicesAs(const std::vector<UnsignedInt>& indices);
 template Containers::Array<UnsignedShort> compressIndicesAs(const std::vector<UnsignedInt>& indices);
 template Containers::Array<UnsignedInt> compressIndicesAs(const std::vector<UnsignedInt>& indices);
+template void compressIndicesInto(Containers::ArrayView<const UnsignedInt>, Containers::ArrayView<UnsignedByte>);
+template void compressIndicesInto(Containers::ArrayView<const UnsignedInt>, Containers::ArrayView<UnsignedShort>);
+template void compressIndicesInto(Containers::ArrayView<const UnsignedInt>, Containers::ArrayView<UnsignedInt>);
+template std::tuple<Mesh::IndexType, UnsignedInt, UnsignedInt> compressedIndexType(Containers::ArrayView<const UnsignedByte>);
+template std::tuple<Mesh::IndexType, UnsignedInt, UnsignedInt> compressedIndexType(Containers::ArrayView<const UnsignedShort>);
+template std::tuple<Mesh::IndexType, UnsignedInt, UnsignedInt> compressedIndexType(Containers::ArrayView<const UnsignedInt>);
+template void compressIndicesInto(Containers::ArrayView<const UnsignedByte>, Mesh::IndexType, Containers::ArrayView<char>);
+template void compressIndicesInto(Containers::ArrayView<const UnsignedShort>, Mesh::IndexType, Containers::ArrayView<char>);
+template void compressIndicesInto(Containers::ArrayView<const UnsignedInt>, Mesh::IndexType, Containers::ArrayView<char>);
+template std::tuple<Mesh::IndexType, UnsignedInt, UnsignedInt> compressIndices(Containers::ArrayView<const UnsignedByte>, Buffer&, BufferUsage);
+template std::tuple<Mesh::IndexType, UnsignedInt, UnsignedInt> compressIndices(Containers::ArrayView<const UnsignedShort>, Buffer&, BufferUsage);
+template std::tuple<Mesh::IndexType, UnsignedInt, UnsignedInt> compressIndices(Containers::ArrayView<const UnsignedInt>, Buffer&, BufferUsage);
 
 }}
@@ -26,10 +26,11 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::MeshTools::compressIndices()
+ * @brief Function @ref Magnum::MeshTools::compressIndices(), @ref Magnum::MeshTools::compressIndicesAs(), @ref Magnum::MeshTools::compressIndicesInto(), @ref Magnum::MeshTools::compressedIndexType()
  */
 
 #include <tuple>
+#include <Corrade/Containers/ArrayView.h>
 
 #include "Magnum/Mesh.h"
 #include "Magnum/MeshTools/visibility.h"
@@ -66,14 +67,91 @@ Example usage:
 
 @snippet MagnumMeshTools.cpp compressIndicesAs
 
-@see @ref compressIndices()
+@see @ref compressIndices(), @ref compressIndicesInto()
 */
 template<class T> MAGNUM_MESHTOOLS_EXPORT Containers::Array<T> compressIndicesAs(const std::vector<UnsignedInt>& indices);
 
+/**
+@brief Compress vertex indices as given type into existing storage
+
+Same as @ref compressIndicesAs(), but takes an array view and writes into a
+caller-provided view, for example directly into a mapped index buffer.
+Expects that @p out has the same size as @p indices.
+*/
+template<class T> MAGNUM_MESHTOOLS_EXPORT void compressIndicesInto(Containers::ArrayView<const UnsignedInt> indices, Containers::ArrayView<T> out);
+
+/**
+@brief Smallest index type able to represent given indices
+@param indices  Index array
+@return Index type, smallest and largest index
+
+The @p indices can be of type @ref Magnum::UnsignedByte "UnsignedByte",
+@ref Magnum::UnsignedShort "UnsignedShort" or @ref Magnum::UnsignedInt "UnsignedInt",
+so it's possible to use data coming from an importer directly, without
+expanding them to 32-bit first. For an empty array returns
+@ref Mesh::IndexType::UnsignedByte and a zero range.
+@see @ref compressIndicesInto(Containers::ArrayView<const T>, Mesh::IndexType, Containers::ArrayView<char>)
+*/
+template<class T> MAGNUM_MESHTOOLS_EXPORT std::tuple<Mesh::IndexType, UnsignedInt, UnsignedInt> compressedIndexType(Containers::ArrayView<const T> indices);
+
+/**
+@brief Compress vertex indices of any type into existing storage
+@param[in] indices  Index array
+@param[in] type     Output index type
+@param[out] out     Where to put the compressed indices
+
+Converts @p indices of type @ref Magnum::UnsignedByte "UnsignedByte",
+@ref Magnum::UnsignedShort "UnsignedShort" or @ref Magnum::UnsignedInt "UnsignedInt"
+to @p type, usually the one returned by @ref compressedIndexType(), writing
+them to raw memory such as a mapped index buffer. Expects that @p out is
+exactly @cpp indices.size()*Mesh::indexSize(type) @ce bytes large and that the
+values are representable with @p type.
+*/
+template<class T> MAGNUM_MESHTOOLS_EXPORT void compressIndicesInto(Containers::ArrayView<const T> indices, Mesh::IndexType type, Containers::ArrayView<char> out);
+
+/**
+@brief Compress vertex indices directly into a buffer
+@param[in] indices  Index array
+@param[out] buffer  Index buffer
+@param[in] usage    Buffer usage
+@return Index type, smallest and largest index
+
+Calculates the smallest index type using @ref compressedIndexType(),
+allocates @p buffer storage and writes the compressed indices straight to
+mapped buffer memory, avoiding any temporary allocation. If buffer mapping is
+not available (on WebGL or if @extension{ARB,map_buffer_range} /
+@extension{EXT,map_buffer_range} is not supported), the data are uploaded
+through a temporary array instead. Example usage:
+
+@code{.cpp}
+Containers::ArrayView<const UnsignedShort> indices = ...;
+
+Buffer indexBuffer{Buffer::TargetHint::ElementArray};
+Mesh::IndexType type;
+UnsignedInt start, end;
+std::tie(type, start, end) = MeshTools::compressIndices(indices, indexBuffer, BufferUsage::StaticDraw);
+mesh.setCount(indices.size())
+    .setIndexBuffer(indexBuffer, 0, type, start, end);
+@endcode
+*/
+template<class T> MAGNUM_MESHTOOLS_EXPORT std::tuple<Mesh::IndexType, UnsignedInt, UnsignedInt> compressIndices(Containers::ArrayView<const T> indices, Buffer& buffer, BufferUsage usage);
+
 #if defined(CORRADE_TARGET_WINDOWS) && !defined(__MINGW32__)
 extern template MAGNUM_MESHTOOLS_EXPORT Containers::Array<UnsignedByte> compressIndicesAs<UnsignedByte>(const std::vector<UnsignedInt>& indices);
 extern template MAGNUM_MESHTOOLS_EXPORT Containers::Array<UnsignedShort> compressIndicesAs<UnsignedShort>(const std::vector<UnsignedInt>& indices);
 extern template MAGNUM_MESHTOOLS_EXPORT Containers::Array<UnsignedInt> compressIndicesAs<UnsignedInt>(const std::vector<UnsignedInt>& indices);
+extern template MAGNUM_MESHTOOLS_EXPORT void compressIndicesInto<UnsignedByte>(Containers::ArrayView<const UnsignedInt>, Containers::ArrayView<UnsignedByte>);
+extern template MAGNUM_MESHTOOLS_EXPORT void compressIndicesInto<UnsignedShort>(Containers::ArrayView<const UnsignedInt>, Containers::ArrayView<UnsignedShort>);
+extern template MAGNUM_MESHTOOLS_EXPORT void compressIndicesInto<UnsignedInt>(Containers::ArrayView<const UnsignedInt>, Containers::ArrayView<UnsignedInt>);
+extern template MAGNUM_MESHTOOLS_EXPORT std::tuple<Mesh::IndexType, UnsignedInt, UnsignedInt> compressedIndexType<UnsignedByte>(Containers::ArrayView<const UnsignedByte>);
+extern template MAGNUM_MESHTOOLS_EXPORT std::tuple<Mesh::IndexType, UnsignedInt, UnsignedInt> compressedIndexType<UnsignedShort>(Containers::ArrayView<const UnsignedShort>);
+extern template MAGNUM_MESHTOOLS_EXPORT std::tuple<Mesh::IndexType, UnsignedInt, UnsignedInt> compressedIndexType<UnsignedInt>(Containers::ArrayView<const UnsignedInt>);
+extern template MAGNUM_MESHTOOLS_EXPORT void compressIndicesInto<UnsignedByte>(Containers::ArrayView<const UnsignedByte>, Mesh::IndexType, Containers::ArrayView<char>);
+extern template MAGNUM_MESHTOOLS_EXPORT void compressIndicesInto<UnsignedShort>(Containers::ArrayView<const UnsignedShort>, Mesh::IndexType, Containers::ArrayView<char>);
+extern template MAGNUM_MESHTOOLS_EXPORT void compressIndicesInto<UnsignedInt>(Containers::ArrayView<const UnsignedInt>, Mesh::IndexType, Containers::ArrayView<char>);
+extern template MAGNUM_MESHTOOLS_EXPORT std::tuple<Mesh::IndexType, UnsignedInt, UnsignedInt> compressIndices<UnsignedByte>(Containers::ArrayView<const UnsignedByte>, Buffer&, BufferUsage);
+extern template MAGNUM_MESHTOOLS_EXPORT std::tuple<Mesh::IndexType, UnsignedInt, UnsignedInt> compressIndices<UnsignedShort>(Containers::ArrayView<const UnsignedShort>, Buffer&, BufferUsage);
+extern template MAGNUM_MESHTOOLS_EXPORT std::tuple<Mesh::IndexType, UnsignedInt, UnsignedInt> compressIndices<UnsignedInt>(Containers::ArrayView<const UnsignedInt>, Buffer&, BufferUsage);
 #endif
 
 }}
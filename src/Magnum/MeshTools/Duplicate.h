@@ -26,13 +26,14 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::MeshTools::duplicate()
+ * @brief Function @ref Magnum::MeshTools::duplicate(), @ref Magnum::MeshTools::duplicateInto()
  */
 
 #include <vector>
 #include <Corrade/Utility/Assert.h>
 
 #include "Magnum/Types.h"
+#include "Magnum/MeshTools/StridedArrayView.h"
 
 namespace Magnum { namespace MeshTools {
 
@@ -53,6 +54,22 @@ template<class T> std::vector<T> duplicate(const std::vector<UnsignedInt>& indic
     return out;
 }
 
+/**
+@brief Duplicate data using index array into existing storage
+
+Same as @ref duplicate(), but reads the data from and writes them into
+possibly strided views, for example directly into an attribute of a mapped
+vertex buffer. Expects that @p out has the same size as @p indices.
+*/
+template<class T> void duplicateInto(Containers::ArrayView<const UnsignedInt> indices, StridedArrayView<const T> data, StridedArrayView<T> out) {
+    CORRADE_ASSERT(out.size() == indices.size(),
+        "MeshTools::duplicateInto(): expected output size" << indices.size() << "but got" << out.size(), );
+    for(std::size_t i = 0; i != indices.size(); ++i) {
+        CORRADE_ASSERT(indices[i] < data.size(), "MeshTools::duplicateInto(): index out of range", );
+        out[i] = data[indices[i]];
+    }
+}
+
 }}
 
 #endif
@@ -30,6 +30,10 @@
 namespace Magnum { namespace MeshTools {
 
 void flipFaceWinding(std::vector<UnsignedInt>& indices) {
+    flipFaceWindingInPlace(Containers::ArrayView<UnsignedInt>{indices.data(), indices.size()});
+}
+
+void flipFaceWindingInPlace(const Containers::ArrayView<UnsignedInt> indices) {
     CORRADE_ASSERT(!(indices.size()%3), "MeshTools::flipNormals(): index count is not divisible by 3!", );
 
     using std::swap;
@@ -38,8 +42,12 @@ void flipFaceWinding(std::vector<UnsignedInt>& indices) {
 }
 
 void flipNormals(std::vector<Vector3>& normals) {
-    for(Vector3& normal: normals)
-        normal = -normal;
+    flipNormalsInPlace(Containers::ArrayView<Vector3>{normals.data(), normals.size()});
+}
+
+void flipNormalsInPlace(const StridedArrayView<Vector3> normals) {
+    for(std::size_t i = 0; i != normals.size(); ++i)
+        normals[i] = -normals[i];
 }
 
 }}
@@ -26,12 +26,13 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::MeshTools::flipFaceWinding(), @ref Magnum::MeshTools::flipNormals()
+ * @brief Function @ref Magnum::MeshTools::flipFaceWinding(), @ref Magnum::MeshTools::flipFaceWindingInPlace(), @ref Magnum::MeshTools::flipNormals(), @ref Magnum::MeshTools::flipNormalsInPlace()
  */
 
 #include <vector>
 
 #include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/StridedArrayView.h"
 #include "Magnum/MeshTools/visibility.h"
 
 namespace Magnum { namespace MeshTools {
@@ -48,6 +49,15 @@ but flips only face winding.
 */
 void MAGNUM_MESHTOOLS_EXPORT flipFaceWinding(std::vector<UnsignedInt>& indices);
 
+/**
+@brief Flip face winding in place
+@param[in,out] indices  Index array to operate on
+
+Same as @ref flipFaceWinding(std::vector<UnsignedInt>&), but operates on an
+array view, for example directly on a mapped index buffer.
+*/
+void MAGNUM_MESHTOOLS_EXPORT flipFaceWindingInPlace(Containers::ArrayView<UnsignedInt> indices);
+
 /**
 @brief Flip mesh normals
 @param[in,out] normals  Normal array to operate on
@@ -57,6 +67,15 @@ but flips only normals, not face winding.
 */
 void MAGNUM_MESHTOOLS_EXPORT flipNormals(std::vector<Vector3>& normals);
 
+/**
+@brief Flip mesh normals in place
+@param[in,out] normals  Normal array to operate on
+
+Same as @ref flipNormals(std::vector<Vector3>&), but operates on a possibly
+strided view, for example on normals in interleaved vertex data.
+*/
+void MAGNUM_MESHTOOLS_EXPORT flipNormalsInPlace(StridedArrayView<Vector3> normals);
+
 /**
 @brief Flip mesh normals and face winding
 @param[in,out] indices  Index array to operate on
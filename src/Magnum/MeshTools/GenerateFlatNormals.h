@@ -26,13 +26,14 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::MeshTools::generateFlatNormals()
+ * @brief Function @ref Magnum::MeshTools::generateFlatNormals(), @ref Magnum::MeshTools::generateFlatNormalsInto()
  */
 
 #include <tuple>
 #include <vector>
 
 #include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/StridedArrayView.h"
 #include "Magnum/MeshTools/visibility.h"
 
 namespace Magnum { namespace MeshTools {
@@ -56,6 +57,31 @@ to use the same indices.
 */
 std::tuple<std::vector<UnsignedInt>, std::vector<Vector3>> MAGNUM_MESHTOOLS_EXPORT generateFlatNormals(const std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions);
 
+/**
+@brief Generate flat normals into existing storage
+@param[in] positions    Array of non-indexed triangle vertex positions
+@param[out] normals     Where to put the normals
+
+For each face writes its normal to all three vertices, without removing
+duplicates. Both views can be strided, so the normals can be generated
+directly into interleaved vertex data. Expects that @p positions size is
+divisible by 3 and that @p normals have the same size.
+*/
+void MAGNUM_MESHTOOLS_EXPORT generateFlatNormalsInto(StridedArrayView<const Vector3> positions, StridedArrayView<Vector3> normals);
+
+/**
+@brief Generate flat normals for an indexed mesh into existing storage
+@param[in] indices      Array of triangle face indices
+@param[in] positions    Array of vertex positions
+@param[out] normals     Where to put the normals
+
+Same as above, but for an indexed mesh, writing one normal for each index.
+Usable together with @ref duplicateInto() applied on the other attributes.
+Expects that @p indices size is divisible by 3 and that @p normals have the
+same size.
+*/
+void MAGNUM_MESHTOOLS_EXPORT generateFlatNormalsInto(Containers::ArrayView<const UnsignedInt> indices, StridedArrayView<const Vector3> positions, StridedArrayView<Vector3> normals);
+
 }}
 
 #endif
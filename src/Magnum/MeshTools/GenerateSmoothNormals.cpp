@@ -0,0 +1,159 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "GenerateSmoothNormals.h"
+
+#include <cmath>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Vector3.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+/* Angle between two edges going from the same point, zero if any of them is
+   degenerate */
+Float cornerAngle(const Vector3& a, const Vector3& b) {
+    const Float lengths = a.length()*b.length();
+    if(lengths == 0.0f) return 0.0f;
+    return std::acos(Math::clamp(Math::dot(a, b)/lengths, -1.0f, 1.0f));
+}
+
+/* Normalized face normals and angle-weighted face normals for each corner */
+void faceNormalsAndCornerWeights(const Containers::ArrayView<const UnsignedInt> indices, const StridedArrayView<const Vector3> positions, std::vector<Vector3>& faceNormals, std::vector<Vector3>& weighted) {
+    faceNormals.resize(indices.size()/3);
+    weighted.resize(indices.size());
+    for(std::size_t i = 0; i != indices.size(); i += 3) {
+        const Vector3& p0 = positions[indices[i]];
+        const Vector3& p1 = positions[indices[i + 1]];
+        const Vector3& p2 = positions[indices[i + 2]];
+
+        /* Degenerate faces contribute nothing */
+        const Vector3 normal = Math::cross(p1 - p0, p2 - p0);
+        const Float length = normal.length();
+        if(length == 0.0f) {
+            faceNormals[i/3] = weighted[i] = weighted[i + 1] = weighted[i + 2] = Vector3{};
+            continue;
+        }
+
+        const Vector3 n = normal/length;
+        faceNormals[i/3] = n;
+        weighted[i] = n*cornerAngle(p1 - p0, p2 - p0);
+        weighted[i + 1] = n*cornerAngle(p2 - p1, p0 - p1);
+        weighted[i + 2] = n*cornerAngle(p0 - p2, p1 - p2);
+    }
+}
+
+Vector3 normalizedOrZero(const Vector3& vector) {
+    const Float length = vector.length();
+    return length == 0.0f ? Vector3{} : vector/length;
+}
+
+}
+
+void generateSmoothNormalsInto(const Containers::ArrayView<const UnsignedInt> indices, const StridedArrayView<const Vector3> positions, const StridedArrayView<Vector3> normals) {
+    CORRADE_ASSERT(!(indices.size()%3), "MeshTools::generateSmoothNormalsInto(): index count is not divisible by 3!", );
+    CORRADE_ASSERT(normals.size() == positions.size(),
+        "MeshTools::generateSmoothNormalsInto(): expected" << positions.size() << "normals but got" << normals.size(), );
+
+    std::vector<Vector3> faceNormals, weighted;
+    faceNormalsAndCornerWeights(indices, positions, faceNormals, weighted);
+
+    for(std::size_t i = 0; i != normals.size(); ++i) normals[i] = Vector3{};
+    for(std::size_t i = 0; i != indices.size(); ++i) {
+        CORRADE_ASSERT(indices[i] < positions.size(),
+            "MeshTools::generateSmoothNormalsInto(): index" << indices[i] << "out of range for" << positions.size() << "vertices", );
+        normals[indices[i]] += weighted[i];
+    }
+    for(std::size_t i = 0; i != normals.size(); ++i)
+        normals[i] = normalizedOrZero(normals[i]);
+}
+
+std::vector<Vector3> generateSmoothNormals(const std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions) {
+    std::vector<Vector3> normals(positions.size());
+    generateSmoothNormalsInto({indices.data(), indices.size()}, Containers::ArrayView<const Vector3>{positions.data(), positions.size()}, Containers::ArrayView<Vector3>{normals.data(), normals.size()});
+    return normals;
+}
+
+std::tuple<std::vector<UnsignedInt>, std::vector<Vector3>> generateSmoothNormals(const std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions, const Rad creaseAngle) {
+    CORRADE_ASSERT(!(indices.size()%3), "MeshTools::generateSmoothNormals(): index count is not divisible by 3!", (std::tuple<std::vector<UnsignedInt>, std::vector<Vector3>>()));
+
+    std::vector<Vector3> faceNormals, weighted;
+    faceNormalsAndCornerWeights({indices.data(), indices.size()}, Containers::ArrayView<const Vector3>{positions.data(), positions.size()}, faceNormals, weighted);
+
+    /* Corners belonging to each vertex, in a compressed form. The offsets are
+       first counts shifted by one, then turned into a prefix sum. */
+    std::vector<UnsignedInt> cornerOffsets(positions.size() + 1);
+    for(const UnsignedInt index: indices) {
+        CORRADE_ASSERT(index < positions.size(),
+            "MeshTools::generateSmoothNormals(): index" << index << "out of range for" << positions.size() << "vertices", (std::tuple<std::vector<UnsignedInt>, std::vector<Vector3>>()));
+        ++cornerOffsets[index + 1];
+    }
+    for(std::size_t i = 1; i != cornerOffsets.size(); ++i)
+        cornerOffsets[i] += cornerOffsets[i - 1];
+    std::vector<UnsignedInt> corners(indices.size());
+    {
+        std::vector<UnsignedInt> fill(cornerOffsets.begin(), cornerOffsets.end() - 1);
+        for(std::size_t i = 0; i != indices.size(); ++i)
+            corners[fill[indices[i]]++] = i;
+    }
+
+    const Float cosCrease = Math::cos(creaseAngle);
+    std::vector<UnsignedInt> normalIndices(indices.size());
+    std::vector<Vector3> normals;
+    normals.reserve(positions.size());
+    for(std::size_t vertex = 0; vertex != positions.size(); ++vertex) {
+        const std::size_t firstNormal = normals.size();
+        for(std::size_t i = cornerOffsets[vertex]; i != cornerOffsets[vertex + 1]; ++i) {
+            const UnsignedInt corner = corners[i];
+            const Vector3& faceNormal = faceNormals[corner/3];
+
+            /* Sum contributions of all faces around this vertex that are
+               within the crease angle. The face itself always is. */
+            Vector3 sum;
+            for(std::size_t j = cornerOffsets[vertex]; j != cornerOffsets[vertex + 1]; ++j) {
+                const UnsignedInt other = corners[j];
+                if(other == corner || Math::dot(faceNormal, faceNormals[other/3]) >= cosCrease)
+                    sum += weighted[other];
+            }
+            const Vector3 normal = normalizedOrZero(sum);
+
+            /* Reuse a normal already generated for this vertex, if any. On a
+               smooth surface all corners end up with the same one. */
+            std::size_t found = firstNormal;
+            for(; found != normals.size(); ++found)
+                if(normals[found] == normal) break;
+            if(found == normals.size()) normals.push_back(normal);
+            normalIndices[corner] = found;
+        }
+    }
+
+    return std::make_tuple(std::move(normalIndices), std::move(normals));
+}
+
+}}
@@ -0,0 +1,97 @@
+#ifndef Magnum_MeshTools_GenerateSmoothNormals_h
+#define Magnum_MeshTools_GenerateSmoothNormals_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::generateSmoothNormals(), @ref Magnum::MeshTools::generateSmoothNormalsInto()
+ */
+
+#include <tuple>
+#include <vector>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Angle.h"
+#include "Magnum/MeshTools/StridedArrayView.h"
+#include "Magnum/MeshTools/visibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Generate smooth normals into existing storage
+@param[in] indices      Array of triangle face indices
+@param[in] positions    Array of vertex positions
+@param[out] normals     Where to put the normals
+
+Unlike @ref generateFlatNormalsInto(), the mesh stays indexed --- one normal
+is written for each vertex, calculated as an average of normals of all faces
+sharing given vertex, weighted by the angle the face has at that vertex. This
+makes the result independent on how the surface is triangulated. Vertices that
+are not referenced by any face get a zero normal. The @p normals view can be
+strided, so the normals can be generated directly into interleaved vertex
+data. Expects that @p indices size is divisible by 3 and that @p normals have
+the same size as @p positions.
+
+Only vertices sharing the same index are considered the same, vertices that
+are duplicated because of differing texture coordinates or other attributes
+have their normals calculated separately.
+@see @ref generateSmoothNormals(const std::vector<UnsignedInt>&, const std::vector<Vector3>&, Rad)
+*/
+void MAGNUM_MESHTOOLS_EXPORT generateSmoothNormalsInto(Containers::ArrayView<const UnsignedInt> indices, StridedArrayView<const Vector3> positions, StridedArrayView<Vector3> normals);
+
+/**
+@brief Generate smooth normals
+@param indices      Array of triangle face indices
+@param positions    Array of vertex positions
+
+Allocates a new array and delegates to @ref generateSmoothNormalsInto().
+*/
+std::vector<Vector3> MAGNUM_MESHTOOLS_EXPORT generateSmoothNormals(const std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions);
+
+/**
+@brief Generate smooth normals with a crease angle
+@param indices      Array of triangle face indices
+@param positions    Array of vertex positions
+@param creaseAngle  Maximal angle between two faces that still get a shared
+    normal
+@return Normal indices and vectors
+
+For each face corner averages normals of faces sharing given vertex, weighted
+by their angle at the vertex, but only of faces that form an angle not larger
+than @p creaseAngle with the face of the corner. Hard edges thus keep separate
+normals on either side while smooth areas share a single normal per vertex.
+Duplicates are removed per vertex, so the normal count stays the same as the
+vertex count for a completely smooth mesh and it grows only on creases.
+Similarly to @ref generateFlatNormals(), use @ref combineIndexedArrays() to
+combine the normal and vertex array to use the same indices.
+
+@attention The function requires the mesh to have triangle faces, thus index
+    count must be divisible by 3.
+*/
+std::tuple<std::vector<UnsignedInt>, std::vector<Vector3>> MAGNUM_MESHTOOLS_EXPORT generateSmoothNormals(const std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions, Rad creaseAngle);
+
+}}
+
+#endif
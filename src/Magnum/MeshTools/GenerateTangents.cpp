@@ -0,0 +1,113 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "GenerateTangents.h"
+
+#include <cmath>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Vector4.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+Float cornerAngle(const Vector3& a, const Vector3& b) {
+    const Float lengths = a.length()*b.length();
+    if(lengths == 0.0f) return 0.0f;
+    return std::acos(Math::clamp(Math::dot(a, b)/lengths, -1.0f, 1.0f));
+}
+
+/* Project onto the plane perpendicular to (normalized) normal, normalize */
+Vector3 orthogonalized(const Vector3& vector, const Vector3& normal) {
+    const Vector3 projected = vector - normal*Math::dot(normal, vector);
+    const Float length = projected.length();
+    return length == 0.0f ? Vector3{} : projected/length;
+}
+
+}
+
+void generateTangentsInto(const Containers::ArrayView<const UnsignedInt> indices, const StridedArrayView<const Vector3> positions, const StridedArrayView<const Vector3> normals, const StridedArrayView<const Vector2> textureCoordinates, const StridedArrayView<Vector4> tangents) {
+    CORRADE_ASSERT(!(indices.size()%3), "MeshTools::generateTangentsInto(): index count is not divisible by 3!", );
+    CORRADE_ASSERT(normals.size() == positions.size() && textureCoordinates.size() == positions.size(),
+        "MeshTools::generateTangentsInto(): expected" << positions.size() << "normals and texture coordinates but got" << normals.size() << "and" << textureCoordinates.size(), );
+    CORRADE_ASSERT(tangents.size() == positions.size(),
+        "MeshTools::generateTangentsInto(): expected" << positions.size() << "tangents but got" << tangents.size(), );
+
+    /* Accumulated tangents and bitangents */
+    std::vector<Vector3> accumulated(positions.size()*2);
+    for(std::size_t i = 0; i != indices.size(); i += 3) {
+        const UnsignedInt v[]{indices[i], indices[i + 1], indices[i + 2]};
+        CORRADE_ASSERT(v[0] < positions.size() && v[1] < positions.size() && v[2] < positions.size(),
+            "MeshTools::generateTangentsInto(): index out of range for" << positions.size() << "vertices", );
+
+        const Vector3 p[]{positions[v[0]], positions[v[1]], positions[v[2]]};
+        const Vector2 uv0 = textureCoordinates[v[0]];
+        const Vector3 dp1 = p[1] - p[0], dp2 = p[2] - p[0];
+        const Vector2 duv1 = textureCoordinates[v[1]] - uv0,
+                      duv2 = textureCoordinates[v[2]] - uv0;
+
+        /* Twice the signed area in texture space. Only its sign matters, the
+           magnitude cancels out with the normalization below. */
+        const Float area = duv1.x()*duv2.y() - duv2.x()*duv1.y();
+        if(area == 0.0f) continue;
+        const Float sign = area < 0.0f ? -1.0f : 1.0f;
+        const Vector3 tangent = (dp1*duv2.y() - dp2*duv1.y())*sign;
+        const Vector3 bitangent = (dp2*duv1.x() - dp1*duv2.x())*sign;
+
+        for(std::size_t j = 0; j != 3; ++j) {
+            const Vector3& n = normals[v[j]];
+            const Float angle = cornerAngle(p[(j + 1)%3] - p[j], p[(j + 2)%3] - p[j]);
+            accumulated[v[j]*2] += orthogonalized(tangent, n)*angle;
+            accumulated[v[j]*2 + 1] += orthogonalized(bitangent, n)*angle;
+        }
+    }
+
+    for(std::size_t i = 0; i != positions.size(); ++i) {
+        const Vector3& n = normals[i];
+        Vector3 t = orthogonalized(accumulated[i*2], n);
+
+        /* Nothing contributed, pick any direction perpendicular to the
+           normal */
+        if(t.isZero()) t = orthogonalized(
+            std::abs(n.x()) < 0.9f ? Vector3::xAxis() : Vector3::yAxis(), n);
+
+        tangents[i] = {t, Math::dot(Math::cross(n, t), accumulated[i*2 + 1]) < 0.0f ? -1.0f : 1.0f};
+    }
+}
+
+std::vector<Vector4> generateTangents(const std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions, const std::vector<Vector3>& normals, const std::vector<Vector2>& textureCoordinates) {
+    std::vector<Vector4> tangents(positions.size());
+    generateTangentsInto({indices.data(), indices.size()},
+        Containers::ArrayView<const Vector3>{positions.data(), positions.size()},
+        Containers::ArrayView<const Vector3>{normals.data(), normals.size()},
+        Containers::ArrayView<const Vector2>{textureCoordinates.data(), textureCoordinates.size()},
+        Containers::ArrayView<Vector4>{tangents.data(), tangents.size()});
+    return tangents;
+}
+
+}}
@@ -0,0 +1,80 @@
+#ifndef Magnum_MeshTools_GenerateTangents_h
+#define Magnum_MeshTools_GenerateTangents_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::generateTangents(), @ref Magnum::MeshTools::generateTangentsInto()
+ */
+
+#include <vector>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/StridedArrayView.h"
+#include "Magnum/MeshTools/visibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Generate tangents into existing storage
+@param[in] indices              Array of triangle face indices
+@param[in] positions            Array of vertex positions
+@param[in] normals              Array of vertex normals
+@param[in] textureCoordinates   Array of vertex texture coordinates
+@param[out] tangents            Where to put the tangents
+
+Calculates one tangent for each vertex of an indexed mesh, following the
+conventions of MikkTSpace, which is what most baking tools use:
+
+-   tangent and bitangent direction of each face is calculated from its
+    texture coordinate derivatives,
+-   at each face corner it's projected onto the tangent plane of the vertex
+    normal, normalized and weighted by the angle the face has at that vertex,
+-   the resulting tangent is orthogonalized against the normal and normalized,
+-   the W component contains the bitangent sign, so the bitangent is
+    reconstructed in the shader as @cpp cross(normal, tangent.xyz)*tangent.w @ce.
+
+Unlike MikkTSpace the mesh is not reindexed, so vertices shared by faces with
+mirrored texture mapping should be duplicated beforehand, otherwise their
+tangent will be an average of both sides. Faces with degenerate texture
+coordinates don't contribute. A vertex without any contribution gets an
+arbitrary tangent perpendicular to its normal. All views can be strided, so
+the tangents can be generated directly into interleaved vertex data. Expects
+that @p indices size is divisible by 3 and that @p normals,
+@p textureCoordinates and @p tangents have the same size as @p positions.
+@see @ref generateSmoothNormalsInto()
+*/
+void MAGNUM_MESHTOOLS_EXPORT generateTangentsInto(Containers::ArrayView<const UnsignedInt> indices, StridedArrayView<const Vector3> positions, StridedArrayView<const Vector3> normals, StridedArrayView<const Vector2> textureCoordinates, StridedArrayView<Vector4> tangents);
+
+/**
+@brief Generate tangents
+
+Allocates a new array and delegates to @ref generateTangentsInto().
+*/
+std::vector<Vector4> MAGNUM_MESHTOOLS_EXPORT generateTangents(const std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions, const std::vector<Vector3>& normals, const std::vector<Vector2>& textureCoordinates);
+
+}}
+
+#endif
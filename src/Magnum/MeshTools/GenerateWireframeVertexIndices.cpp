@@ -0,0 +1,97 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "GenerateWireframeVertexIndices.h"
+
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Vector3.h"
+
+namespace Magnum { namespace MeshTools {
+
+std::tuple<std::vector<UnsignedInt>, std::vector<Float>> generateWireframeVertexIndices(std::vector<UnsignedInt>& indices, const UnsignedInt vertexCount) {
+    CORRADE_ASSERT(!(indices.size()%3), "MeshTools::generateWireframeVertexIndices(): index count is not divisible by 3!", (std::tuple<std::vector<UnsignedInt>, std::vector<Float>>()));
+
+    constexpr UnsignedInt NoVertex = ~UnsignedInt{};
+    constexpr UnsignedByte NoCorner = 0xff;
+
+    /* Corner assigned to each output vertex and for each original vertex its
+       variant with given corner, if any */
+    std::vector<UnsignedInt> mapping(vertexCount);
+    for(UnsignedInt i = 0; i != vertexCount; ++i) mapping[i] = i;
+    std::vector<UnsignedByte> corners(vertexCount, NoCorner);
+    std::vector<Math::Vector3<UnsignedInt>> variants(vertexCount, Math::Vector3<UnsignedInt>{NoVertex});
+
+    for(std::size_t i = 0; i != indices.size(); i += 3) {
+        /* Keep already assigned corners that don't collide with a previous
+           vertex of the triangle */
+        bool used[3]{};
+        bool keep[3]{};
+        for(std::size_t j = 0; j != 3; ++j) {
+            CORRADE_ASSERT(indices[i + j] < vertexCount, "MeshTools::generateWireframeVertexIndices(): index" << indices[i + j] << "out of range for" << vertexCount << "vertices", (std::tuple<std::vector<UnsignedInt>, std::vector<Float>>()));
+            const UnsignedByte corner = corners[indices[i + j]];
+            if(corner != NoCorner && !used[corner]) used[corner] = keep[j] = true;
+        }
+
+        /* Assign the remaining vertices a free corner, preferring a variant
+           that already exists */
+        for(std::size_t j = 0; j != 3; ++j) {
+            if(keep[j]) continue;
+
+            /* Triangles not processed yet reference only original vertices */
+            const UnsignedInt original = indices[i + j];
+            std::size_t corner = 0;
+            while(used[corner]) ++corner;
+            for(std::size_t k = corner; k != 3; ++k) if(!used[k] && variants[original][k] != NoVertex) {
+                corner = k;
+                break;
+            }
+            used[corner] = true;
+
+            /* Unassigned original vertex, use it directly */
+            if(corners[original] == NoCorner) {
+                corners[original] = corner;
+                variants[original][corner] = original;
+
+            /* Otherwise create a new variant if there's none yet */
+            } else if(variants[original][corner] == NoVertex) {
+                variants[original][corner] = mapping.size();
+                mapping.push_back(original);
+                corners.push_back(corner);
+            }
+
+            indices[i + j] = variants[original][corner];
+        }
+    }
+
+    /* Vertices not referenced by any triangle get an arbitrary corner */
+    std::vector<Float> vertexIndices(corners.size());
+    for(std::size_t i = 0; i != corners.size(); ++i)
+        vertexIndices[i] = corners[i] == NoCorner ? 0.0f : Float(corners[i]);
+
+    return std::make_tuple(std::move(mapping), std::move(vertexIndices));
+}
+
+}}
@@ -0,0 +1,70 @@
+#ifndef Magnum_MeshTools_GenerateWireframeVertexIndices_h
+#define Magnum_MeshTools_GenerateWireframeVertexIndices_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::generateWireframeVertexIndices()
+ */
+
+#include <tuple>
+#include <vector>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/visibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Generate wireframe vertex indices for an indexed mesh
+@param[in,out] indices  Array of triangle face indices
+@param vertexCount      Vertex count
+@return Vertex mapping and vertex index attribute
+
+Assigns a value of @cpp 0.0f @ce, @cpp 1.0f @ce or @cpp 2.0f @ce to each
+vertex so that the three vertices of every triangle have distinct values,
+suitable for the @ref Shaders::MeshVisualizer::VertexIndex attribute with
+@ref Shaders::MeshVisualizer::Flag::VertexIndexAttribute enabled. That allows
+rendering wireframe of indexed meshes without geometry shaders and without
+converting the mesh to a non-indexed one.
+
+The values are assigned greedily in a single pass over the triangles. Where a
+vertex can't get a value distinct from the rest of the triangle, it's
+duplicated and @p indices are updated to reference the duplicate. The first
+returned array maps each output vertex to the original one, with the first
+@p vertexCount items being identity, use @ref duplicate() with it on all
+vertex attributes. The second array is the vertex index attribute, with the
+same size as the first. Typical meshes need only a few duplicates:
+
+@snippet MagnumMeshTools.cpp generateWireframeVertexIndices
+
+@attention The function requires the mesh to have triangle faces, thus index
+    count must be divisible by 3.
+*/
+std::tuple<std::vector<UnsignedInt>, std::vector<Float>> MAGNUM_MESHTOOLS_EXPORT generateWireframeVertexIndices(std::vector<UnsignedInt>& indices, UnsignedInt vertexCount);
+
+}}
+
+#endif
@@ -0,0 +1,89 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Interleave.h"
+
+#include <cstdint>
+
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+namespace Magnum { namespace MeshTools { namespace Implementation {
+
+void copyNonTemporal(char* destination, const char* source, std::size_t size) {
+    #if defined(__SSE2__) || defined(_M_X64)
+    /* Copy the unaligned head normally, then write whole 16-byte lines with
+       streaming stores that bypass the cache. The data are not read back by
+       the CPU, so there's no point in polluting the cache with them. */
+    const std::size_t head = std::min((16 - (reinterpret_cast<std::uintptr_t>(destination) & 15)) & 15, size);
+    std::memcpy(destination, source, head);
+    destination += head;
+    source += head;
+    size -= head;
+
+    for(; size >= 16; size -= 16, destination += 16, source += 16)
+        _mm_stream_si128(reinterpret_cast<__m128i*>(destination), _mm_loadu_si128(reinterpret_cast<const __m128i*>(source)));
+
+    /* Streaming stores are weakly ordered, make them visible before the
+       buffer gets unmapped on another thread */
+    _mm_sfence();
+    #endif
+
+    /* NEON has no non-temporal store intrinsics, a plain copy is used there
+       and on other platforms. On SSE2 this is just the tail. */
+    std::memcpy(destination, source, size);
+}
+
+Containers::ArrayView<char> mapInterleaveBuffer(Buffer& buffer, const std::size_t size, const BufferUsage usage) {
+    /* Mapping is not available at all, the caller falls back to setData() */
+    #ifdef MAGNUM_TARGET_WEBGL
+    static_cast<void>(buffer);
+    static_cast<void>(size);
+    static_cast<void>(usage);
+    return nullptr;
+    #else
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::map_buffer_range>())
+        return nullptr;
+    #elif defined(MAGNUM_TARGET_GLES2)
+    if(!Context::current().isExtensionSupported<Extensions::GL::EXT::map_buffer_range>())
+        return nullptr;
+    #endif
+
+    buffer.setData({nullptr, size}, usage);
+
+    /* The whole storage is overwritten, so the driver doesn't need to keep
+       the previous contents around */
+    const Containers::ArrayView<char> data = buffer.map(0, size, Buffer::MapFlag::Write|Buffer::MapFlag::InvalidateBuffer);
+    if(!data.data()) return nullptr;
+    return data;
+    #endif
+}
+
+}}}
@@ -29,11 +29,16 @@
  * @brief Function @ref Magnum::MeshTools::interleave(), @ref Magnum::MeshTools::interleaveInto()
  */
 
+#include <algorithm>
 #include <cstring>
+#include <iterator>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Utility/Assert.h>
 
+#include "Magnum/Buffer.h"
 #include "Magnum/Magnum.h"
+#include "Magnum/ThreadPool.h"
+#include "Magnum/MeshTools/visibility.h"
 
 namespace Magnum { namespace MeshTools {
 
@@ -97,6 +102,71 @@ template<class T, class ...U> void writeInterleaved(std::size_t stride, char* st
     writeInterleaved(stride, startingOffset + writeOneInterleaved(stride, startingOffset, first), next...);
 }
 
+/* Copy given vertex range of the data to the buffer, startingOffset points
+   to the first vertex of the range */
+template<class T> typename std::enable_if<!std::is_convertible<T, std::size_t>::value, std::size_t>::type writeOneInterleavedRange(std::size_t stride, char* startingOffset, const T& attributeList, std::size_t begin, std::size_t end) {
+    auto it = attributeList.begin();
+    std::advance(it, begin);
+    for(std::size_t i = 0; i != end - begin; ++i, ++it)
+        std::memcpy(startingOffset + i*stride, reinterpret_cast<const char*>(&*it), sizeof(typename T::value_type));
+
+    return sizeof(typename T::value_type);
+}
+
+/* Skip gap */
+constexpr std::size_t writeOneInterleavedRange(std::size_t, char*, std::size_t gap, std::size_t, std::size_t) { return gap; }
+
+/* References to all attributes, callable on a vertex range. It's a recursive
+   structure instead of a lambda capturing the parameter pack, which isn't
+   supported by all compilers. */
+template<class ...T> struct InterleaveRange;
+template<> struct InterleaveRange<> {
+    void operator()(std::size_t, char*, std::size_t, std::size_t) const {}
+};
+template<class T, class ...U> struct InterleaveRange<T, U...> {
+    void operator()(std::size_t stride, char* startingOffset, std::size_t begin, std::size_t end) const {
+        next(stride, startingOffset + writeOneInterleavedRange(stride, startingOffset, first, begin, end), begin, end);
+    }
+
+    const T& first;
+    InterleaveRange<U...> next;
+};
+
+inline InterleaveRange<> interleaveRange() { return {}; }
+template<class T, class ...U> InterleaveRange<T, U...> interleaveRange(const T& first, const U&... next) {
+    return {first, interleaveRange(next...)};
+}
+
+/* Size of the staging buffer for writing into mapped memory and count of
+   vertices processed by one thread at a time */
+enum: std::size_t {
+    InterleaveStagingSize = 16384,
+    InterleaveChunkSize = 65536
+};
+
+/* Copies memory using SSE2 streaming stores if available, falls back to
+   std::memcpy() otherwise. Defined in Interleave.cpp. */
+MAGNUM_MESHTOOLS_EXPORT void copyNonTemporal(char* destination, const char* source, std::size_t size);
+
+/* Interleave given vertex range into a small zero-initialized staging buffer
+   that stays in cache and copy it to the destination in large contiguous
+   blocks using non-temporal stores where available. Mapped buffer memory is
+   usually write-combined, striding through it one attribute at a time would
+   cause partial writes and reads. */
+template<class ...T> void writeInterleavedStaged(std::size_t stride, char* destination, std::size_t begin, std::size_t end, const InterleaveRange<T...>& range) {
+    const std::size_t blockSize = std::max(std::size_t(InterleaveStagingSize)/stride, std::size_t{1});
+    Containers::Array<char> staging{Containers::ValueInit, blockSize*stride};
+    for(std::size_t i = begin; i < end; i += blockSize) {
+        const std::size_t blockEnd = std::min(i + blockSize, end);
+        range(stride, staging.begin(), i, blockEnd);
+        copyNonTemporal(destination + i*stride, staging.begin(), (blockEnd - i)*stride);
+    }
+}
+
+/* Allocates buffer storage and maps it for writing, returns empty view if
+   mapping is not supported. Defined in Interleave.cpp. */
+MAGNUM_MESHTOOLS_EXPORT Containers::ArrayView<char> mapInterleaveBuffer(Buffer& buffer, std::size_t size, BufferUsage usage);
+
 }
 
 /**
@@ -167,6 +237,104 @@ template<class T, class ...U> void interleaveInto(Containers::ArrayView<char> bu
     Implementation::writeInterleaved(stride, buffer.begin(), first, next...);
 }
 
+/**
+@brief Interleave vertex attributes into existing buffer in parallel
+
+Same as @ref interleaveInto(Containers::ArrayView<char>, const T&, const U&...),
+but the vertices are split into ranges processed by threads of given pool.
+The attribute arrays should have random-access iterators, otherwise each
+thread has to iterate through all vertices preceding its range.
+*/
+template<class T, class ...U> void interleaveInto(Containers::ArrayView<char> buffer, ThreadPool& pool, const T& first, const U&... next) {
+    const std::size_t attributeCount = Implementation::AttributeCount{}(first, next...);
+    const std::size_t stride = Implementation::Stride{}(first, next...);
+    if(!attributeCount || attributeCount == ~std::size_t(0)) return;
+    CORRADE_ASSERT(attributeCount*stride <= buffer.size(), "MeshTools::interleaveInto(): the data buffer is too small, expected" << attributeCount*stride << "but got" << buffer.size(), );
+
+    const auto range = Implementation::interleaveRange(first, next...);
+    char* const data = buffer.begin();
+    pool.parallelFor(attributeCount, Implementation::InterleaveChunkSize, [&range, data, stride](std::size_t begin, std::size_t end) {
+        range(stride, data + begin*stride, begin, end);
+    });
+}
+
+/**
+@brief Interleave vertex attributes directly into a GPU buffer
+@return Count of interleaved vertices
+
+Allocates the storage of @p buffer with given @p usage and interleaves the
+attributes directly into memory mapped with @ref Buffer::map(GLintptr, GLsizeiptr, Buffer::MapFlags),
+saving the temporary allocation and the copy done by
+@ref Buffer::setData(). The data are interleaved in blocks through a small
+staging area and written to the mapped memory sequentially, using
+non-temporal stores on SSE2-capable targets, which is friendly to
+write-combined memory. All gap bytes are set to zero, same as
+with @ref interleave():
+
+@snippet MagnumMeshTools.cpp interleaveInto-buffer
+
+If buffer mapping is not available (WebGL, OpenGL ES 2.0 without
+@extension{EXT,map_buffer_range}) or fails, the function falls back to
+@ref interleave() followed by @ref Buffer::setData().
+@see @ref interleaveInto(Buffer&, BufferUsage, ThreadPool&, const T&, const U&...)
+*/
+template<class T, class ...U> std::size_t interleaveInto(Buffer& buffer, BufferUsage usage, const T& first, const U&... next) {
+    const std::size_t attributeCount = Implementation::AttributeCount{}(first, next...);
+    const std::size_t stride = Implementation::Stride{}(first, next...);
+    if(!attributeCount || attributeCount == ~std::size_t(0)) {
+        buffer.setData({nullptr, 0}, usage);
+        return 0;
+    }
+
+    const Containers::ArrayView<char> data = Implementation::mapInterleaveBuffer(buffer, attributeCount*stride, usage);
+    if(data.empty()) {
+        buffer.setData(interleave(first, next...), usage);
+        return attributeCount;
+    }
+
+    Implementation::writeInterleavedStaged(stride, data.begin(), 0, attributeCount, Implementation::interleaveRange(first, next...));
+    #ifndef MAGNUM_TARGET_WEBGL
+    buffer.unmap();
+    #endif
+    return attributeCount;
+}
+
+/**
+@brief Interleave vertex attributes directly into a GPU buffer in parallel
+@return Count of interleaved vertices
+
+Same as @ref interleaveInto(Buffer&, BufferUsage, const T&, const U&...),
+but the vertices are split into ranges interleaved into the mapped memory by
+threads of given pool. The GL calls are done on the calling thread, which has
+to be the thread the context is current on. See
+@ref interleaveInto(Containers::ArrayView<char>, ThreadPool&, const T&, const U&...)
+for requirements on the attribute arrays.
+*/
+template<class T, class ...U> std::size_t interleaveInto(Buffer& buffer, BufferUsage usage, ThreadPool& pool, const T& first, const U&... next) {
+    const std::size_t attributeCount = Implementation::AttributeCount{}(first, next...);
+    const std::size_t stride = Implementation::Stride{}(first, next...);
+    if(!attributeCount || attributeCount == ~std::size_t(0)) {
+        buffer.setData({nullptr, 0}, usage);
+        return 0;
+    }
+
+    const Containers::ArrayView<char> data = Implementation::mapInterleaveBuffer(buffer, attributeCount*stride, usage);
+    if(data.empty()) {
+        buffer.setData(interleave(first, next...), usage);
+        return attributeCount;
+    }
+
+    const auto range = Implementation::interleaveRange(first, next...);
+    char* const destination = data.begin();
+    pool.parallelFor(attributeCount, Implementation::InterleaveChunkSize, [&range, destination, stride](std::size_t begin, std::size_t end) {
+        Implementation::writeInterleavedStaged(stride, destination, begin, end, range);
+    });
+    #ifndef MAGNUM_TARGET_WEBGL
+    buffer.unmap();
+    #endif
+    return attributeCount;
+}
+
 }}
 
 #endif
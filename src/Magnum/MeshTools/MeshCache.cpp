@@ -0,0 +1,76 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MeshCache.h"
+
+#include "Magnum/Buffer.h"
+#include "Magnum/Mesh.h"
+#include "Magnum/Trade/MeshData2D.h"
+#include "Magnum/Trade/MeshData3D.h"
+
+namespace Magnum { namespace MeshTools {
+
+MeshCache::MeshCache(const BufferUsage usage, const CompileFlags flags): _usage{usage}, _flags{flags} {}
+
+MeshCache::MeshCache(): MeshCache{BufferUsage::StaticDraw} {}
+
+MeshCache::MeshCache(MeshCache&&) noexcept = default;
+
+MeshCache::~MeshCache() = default;
+
+MeshCache& MeshCache::operator=(MeshCache&&) noexcept = default;
+
+void MeshCache::clear() { _entries.clear(); }
+
+MeshCache::Entry* MeshCache::find(const std::string& key) {
+    auto found = _entries.find(key);
+    return found == _entries.end() ? nullptr : &found->second;
+}
+
+MeshCache::Entry& MeshCache::insert(std::string&& key, Trade::MeshData2D&& data) {
+    Entry& entry = _entries[std::move(key)];
+    entry.data2D.reset(new Trade::MeshData2D{std::move(data)});
+    return entry;
+}
+
+MeshCache::Entry& MeshCache::insert(std::string&& key, Trade::MeshData3D&& data) {
+    Entry& entry = _entries[std::move(key)];
+    entry.data3D.reset(new Trade::MeshData3D{std::move(data)});
+    return entry;
+}
+
+Mesh& MeshCache::compiled(Entry& entry) {
+    if(!entry.mesh) {
+        Mesh mesh{NoCreate};
+        std::tie(mesh, entry.vertices, entry.indices) = entry.data2D ?
+            compile(*entry.data2D, _usage, _flags) :
+            compile(*entry.data3D, _usage, _flags);
+        entry.mesh.reset(new Mesh{std::move(mesh)});
+    }
+
+    return *entry.mesh;
+}
+
+}}
@@ -0,0 +1,168 @@
+#ifndef Magnum_MeshTools_MeshCache_h
+#define Magnum_MeshTools_MeshCache_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::MeshTools::MeshCache
+ */
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Trade/Trade.h"
+#include "Magnum/MeshTools/Compile.h"
+#include "Magnum/MeshTools/visibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Cache of generated meshes
+
+Stores results of mesh generator functions such as @ref Primitives::icosphereSolid()
+keyed on the generator and its parameters, so repeated requests for the same
+mesh neither regenerate the data nor upload a duplicate to the GPU:
+
+@code{.cpp}
+MeshTools::MeshCache cache;
+
+// Generated, compiled and uploaded only on the first call
+Mesh& sphere = cache.mesh(Primitives::icosphereSolid, 3);
+
+// Returns the same mesh
+Mesh& sameSphere = cache.mesh(Primitives::icosphereSolid, 3);
+@endcode
+
+The generator can be any function returning either @ref Trade::MeshData2D or
+@ref Trade::MeshData3D. The parameters are converted to types of the generator
+parameters and compared bitwise, thus they have to be plain values such as
+integers, floats, enums or enum sets. Generated data are available through
+@ref data() and are compiled using @ref compile() with usage and flags passed
+in the constructor the first time @ref mesh() is called. Returned references
+stay valid until the cache is cleared or destroyed.
+*/
+class MAGNUM_MESHTOOLS_EXPORT MeshCache {
+    public:
+        /**
+         * @brief Constructor
+         * @param usage     Usage of vertex and index buffers of compiled
+         *      meshes
+         * @param flags     Flags passed to @ref compile()
+         */
+        explicit MeshCache(BufferUsage usage, CompileFlags flags = {});
+
+        /** @brief Construct with @ref BufferUsage::StaticDraw */
+        explicit MeshCache();
+
+        /** @brief Copying is not allowed */
+        MeshCache(const MeshCache&) = delete;
+
+        /** @brief Move constructor */
+        MeshCache(MeshCache&&) noexcept;
+
+        ~MeshCache();
+
+        /** @brief Copying is not allowed */
+        MeshCache& operator=(const MeshCache&) = delete;
+
+        /** @brief Move assignment */
+        MeshCache& operator=(MeshCache&&) noexcept;
+
+        /** @brief Count of cached entries */
+        std::size_t count() const { return _entries.size(); }
+
+        /**
+         * @brief Cached mesh data
+         *
+         * Calls @p generator with @p args if the data for given combination
+         * weren't generated yet, returns the cached data otherwise.
+         */
+        template<class T, class ...GeneratorArgs, class ...Args> const T& data(T(*generator)(GeneratorArgs...), Args&&... args) {
+            return *entry(generator, std::forward<Args>(args)...).template get<T>();
+        }
+
+        /**
+         * @brief Cached compiled mesh
+         *
+         * Like @ref data(), but additionally compiles the data into a mesh if
+         * not already done.
+         */
+        template<class T, class ...GeneratorArgs, class ...Args> Mesh& mesh(T(*generator)(GeneratorArgs...), Args&&... args) {
+            return compiled(entry(generator, std::forward<Args>(args)...));
+        }
+
+        /**
+         * @brief Clear the cache
+         *
+         * Invalidates all returned references.
+         */
+        void clear();
+
+    private:
+        struct Entry {
+            template<class T> const T* get() const;
+
+            std::unique_ptr<Trade::MeshData2D> data2D;
+            std::unique_ptr<Trade::MeshData3D> data3D;
+            std::unique_ptr<Mesh> mesh;
+            std::unique_ptr<Buffer> vertices, indices;
+        };
+
+        template<class T> static void appendKey(std::string& key, const T& value) {
+            key.append(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        template<class T, class ...GeneratorArgs, class ...Args> Entry& entry(T(*generator)(GeneratorArgs...), Args&&... args) {
+            std::string key;
+            appendKey(key, generator);
+            const int expand[]{0, (appendKey<typename std::decay<GeneratorArgs>::type>(key, args), 0)...};
+            static_cast<void>(expand);
+
+            Entry* found = find(key);
+            if(!found) found = &insert(std::move(key), generator(std::forward<Args>(args)...));
+            return *found;
+        }
+
+        Entry* find(const std::string& key);
+        Entry& insert(std::string&& key, Trade::MeshData2D&& data);
+        Entry& insert(std::string&& key, Trade::MeshData3D&& data);
+        Mesh& compiled(Entry& entry);
+
+        BufferUsage _usage;
+        CompileFlags _flags;
+        std::unordered_map<std::string, Entry> _entries;
+};
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+template<> inline const Trade::MeshData2D* MeshCache::Entry::get<Trade::MeshData2D>() const { return data2D.get(); }
+template<> inline const Trade::MeshData3D* MeshCache::Entry::get<Trade::MeshData3D>() const { return data3D.get(); }
+#endif
+
+}}
+
+#endif
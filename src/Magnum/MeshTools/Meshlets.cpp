@@ -0,0 +1,193 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Meshlets.h"
+
+#include <algorithm>
+#include <cmath>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Math/Functions.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+enum: UnsignedInt { NotUsed = ~UnsignedInt{} };
+
+/* Bounding sphere and normal cone of triangles in given range */
+void computeBounds(Meshlet& meshlet, const Containers::ArrayView<const UnsignedInt> indices, const StridedArrayView<const Vector3> positions) {
+    Vector3 min = positions[indices[0]], max = min;
+    for(const UnsignedInt index: indices) {
+        min = Math::min(min, positions[index]);
+        max = Math::max(max, positions[index]);
+    }
+
+    meshlet.center = (min + max)*0.5f;
+    meshlet.radius = 0.0f;
+    for(const UnsignedInt index: indices)
+        meshlet.radius = Math::max(meshlet.radius, (positions[index] - meshlet.center).length());
+
+    /* Cone axis is an average of triangle normals, cutoff the largest angle
+       from it */
+    std::vector<Vector3> normals;
+    normals.reserve(indices.size()/3);
+    Vector3 axis;
+    for(std::size_t i = 0; i != indices.size(); i += 3) {
+        const Vector3& p0 = positions[indices[i]];
+        const Vector3 n = Math::cross(positions[indices[i + 1]] - p0, positions[indices[i + 2]] - p0);
+        const Float length = n.length();
+        if(length == 0.0f) continue;
+
+        normals.push_back(n/length);
+        axis += normals.back();
+    }
+
+    const Float axisLength = axis.length();
+    if(normals.empty() || axisLength == 0.0f) {
+        meshlet.coneAxis = Vector3::zAxis();
+        meshlet.coneCutoff = -1.0f;
+        return;
+    }
+
+    meshlet.coneAxis = axis/axisLength;
+    meshlet.coneCutoff = 1.0f;
+    for(const Vector3& n: normals)
+        meshlet.coneCutoff = Math::min(meshlet.coneCutoff, Math::dot(n, meshlet.coneAxis));
+}
+
+}
+
+std::vector<Meshlet> generateMeshletsInPlace(const Containers::ArrayView<UnsignedInt> indices, const StridedArrayView<const Vector3> positions, const UnsignedInt maxVertices, const UnsignedInt maxTriangles) {
+    CORRADE_ASSERT(!(indices.size()%3), "MeshTools::generateMeshletsInPlace(): index count is not divisible by 3!", {});
+    CORRADE_ASSERT(maxVertices >= 3 && maxTriangles >= 1,
+        "MeshTools::generateMeshletsInPlace(): expected at least 3 vertices and 1 triangle per meshlet but got" << maxVertices << "and" << maxTriangles, {});
+
+    const std::size_t vertexCount = positions.size();
+    const std::size_t triangleCount = indices.size()/3;
+    #ifndef CORRADE_NO_ASSERT
+    for(const UnsignedInt index: indices)
+        CORRADE_ASSERT(index < vertexCount, "MeshTools::generateMeshletsInPlace(): index" << index << "out of range for" << vertexCount << "vertices", {});
+    #endif
+
+    /* Vertex-triangle adjacency */
+    std::vector<UnsignedInt> triangleOffset(vertexCount + 1), triangles(indices.size());
+    for(const UnsignedInt index: indices) ++triangleOffset[index + 1];
+    for(std::size_t i = 0; i != vertexCount; ++i)
+        triangleOffset[i + 1] += triangleOffset[i];
+    {
+        std::vector<UnsignedInt> fill(triangleOffset.begin(), triangleOffset.end() - 1);
+        for(std::size_t i = 0; i != indices.size(); ++i)
+            triangles[fill[indices[i]]++] = i/3;
+    }
+
+    /* Meshlet in which each vertex was last used, for counting new vertices
+       of a candidate triangle */
+    std::vector<UnsignedInt> vertexMeshlet(vertexCount, NotUsed);
+    std::vector<bool> emitted(triangleCount);
+    std::vector<UnsignedInt> output, meshletVertices;
+    output.reserve(indices.size());
+    meshletVertices.reserve(maxVertices);
+
+    std::vector<Meshlet> meshlets;
+    std::size_t cursor = 0;
+    for(;;) {
+        /* Seed a new meshlet with the first triangle not emitted yet */
+        while(cursor != triangleCount && emitted[cursor]) ++cursor;
+        if(cursor == triangleCount) break;
+
+        const UnsignedInt id = meshlets.size();
+        meshlets.push_back(Meshlet{UnsignedInt(output.size()), 0, 0, {}, 0.0f, {}, 0.0f});
+        meshletVertices.clear();
+
+        UnsignedInt triangle = cursor;
+        UnsignedInt meshletTriangles = 0;
+        while(triangle != NotUsed) {
+            /* Add the triangle */
+            emitted[triangle] = true;
+            ++meshletTriangles;
+            for(std::size_t i = 0; i != 3; ++i) {
+                const UnsignedInt v = indices[triangle*3 + i];
+                output.push_back(v);
+                if(vertexMeshlet[v] != id) {
+                    vertexMeshlet[v] = id;
+                    meshletVertices.push_back(v);
+                }
+            }
+            if(meshletTriangles == maxTriangles) break;
+
+            /* Pick an adjacent triangle adding the least new vertices that
+               still fits */
+            triangle = NotUsed;
+            UnsignedInt bestNewVertices = 3;
+            for(const UnsignedInt v: meshletVertices) {
+                for(UnsignedInt j = triangleOffset[v]; j != triangleOffset[v + 1]; ++j) {
+                    const UnsignedInt candidate = triangles[j];
+                    if(emitted[candidate]) continue;
+
+                    UnsignedInt newVertices = 0;
+                    for(std::size_t k = 0; k != 3; ++k)
+                        if(vertexMeshlet[indices[candidate*3 + k]] != id) ++newVertices;
+                    if(meshletVertices.size() + newVertices > maxVertices) continue;
+
+                    if(newVertices < bestNewVertices || (newVertices == bestNewVertices && candidate < triangle)) {
+                        bestNewVertices = newVertices;
+                        triangle = candidate;
+                    }
+                }
+
+                /* Can't get better than this */
+                if(triangle != NotUsed && bestNewVertices == 0) break;
+            }
+        }
+
+        Meshlet& meshlet = meshlets.back();
+        meshlet.indexCount = output.size() - meshlet.indexOffset;
+        meshlet.vertexCount = meshletVertices.size();
+    }
+
+    CORRADE_INTERNAL_ASSERT(output.size() == indices.size());
+    std::copy(output.begin(), output.end(), indices.begin());
+
+    for(Meshlet& meshlet: meshlets)
+        computeBounds(meshlet, indices.slice(meshlet.indexOffset, meshlet.indexOffset + meshlet.indexCount), positions);
+
+    return meshlets;
+}
+
+bool isMeshletBackfacing(const Meshlet& meshlet, const Vector3& cameraPosition) {
+    /* The triangles face too many directions */
+    if(meshlet.coneCutoff <= 0.0f) return false;
+
+    /* All normals are within the cone, the whole meshlet faces away if the
+       direction to any point of the bounding sphere is inside the cone
+       complement */
+    const Vector3 direction = meshlet.center - cameraPosition;
+    const Float sinCutoff = std::sqrt(1.0f - meshlet.coneCutoff*meshlet.coneCutoff);
+    return Math::dot(direction, meshlet.coneAxis) >= direction.length()*sinCutoff + meshlet.radius;
+}
+
+}}
@@ -0,0 +1,136 @@
+#ifndef Magnum_MeshTools_Meshlets_h
+#define Magnum_MeshTools_Meshlets_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Struct @ref Magnum::MeshTools::Meshlet, function @ref Magnum::MeshTools::generateMeshletsInPlace(), @ref Magnum::MeshTools::isMeshletBackfacing()
+ */
+
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/StridedArrayView.h"
+#include "Magnum/MeshTools/visibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Meshlet
+
+Contiguous range of triangles in an index buffer together with its bounds,
+produced by @ref generateMeshletsInPlace().
+*/
+struct Meshlet {
+    /** @brief Offset of the first index */
+    UnsignedInt indexOffset;
+
+    /** @brief Index count */
+    UnsignedInt indexCount;
+
+    /** @brief Count of unique vertices referenced by the indices */
+    UnsignedInt vertexCount;
+
+    /** @brief Bounding sphere center */
+    Vector3 center;
+
+    /** @brief Bounding sphere radius */
+    Float radius;
+
+    /**
+     * @brief Normal cone axis
+     *
+     * Normalized average of triangle normals.
+     */
+    Vector3 coneAxis;
+
+    /**
+     * @brief Normal cone cutoff
+     *
+     * Cosine of the largest angle between @ref coneAxis and any triangle
+     * normal. If zero or negative, the triangles face too many directions
+     * for the meshlet to be culled based on orientation.
+     */
+    Float coneCutoff;
+};
+
+/**
+@brief Partition a mesh into meshlets
+@param[in,out] indices  Triangle indices
+@param[in] positions    Vertex positions
+@param[in] maxVertices  Max count of unique vertices in a meshlet
+@param[in] maxTriangles Max count of triangles in a meshlet
+
+Reorders the triangles so each meshlet occupies a contiguous range of
+@p indices and returns the ranges together with a bounding sphere and a
+normal cone of each meshlet. The meshlets are grown greedily from a seed
+triangle, preferring adjacent triangles that add the least new vertices, so
+they are spatially coherent. The default limits match common recommendations
+for mesh shading hardware, but the meshlets are equally usable for culling on
+the CPU and drawing the visible ranges with @ref MeshView:
+
+@code{.cpp}
+std::vector<MeshTools::Meshlet> meshlets = MeshTools::generateMeshletsInPlace(
+    {indices.data(), indices.size()},
+    Containers::ArrayView<const Vector3>{positions.data(), positions.size()});
+
+// upload the reordered indices ...
+
+for(const MeshTools::Meshlet& meshlet: meshlets) {
+    if(MeshTools::isMeshletBackfacing(meshlet, cameraPosition) ||
+        !frustumContainsSphere(meshlet.center, meshlet.radius)) continue;
+
+    MeshView view{mesh};
+    view.setIndexRange(meshlet.indexOffset)
+        .setCount(meshlet.indexCount)
+        .draw(shader);
+}
+@endcode
+
+Order of triangles inside each meshlet follows the order in which they were
+added, so run @ref optimizeVertexCacheInPlace() first to have a good cache
+behavior inside the meshlets as well. Both @p maxVertices and
+@p maxTriangles are expected to be at least 3 and 1, respectively.
+
+@attention The function requires the mesh to have triangle faces, thus index
+    count must be divisible by 3.
+*/
+MAGNUM_MESHTOOLS_EXPORT std::vector<Meshlet> generateMeshletsInPlace(Containers::ArrayView<UnsignedInt> indices, StridedArrayView<const Vector3> positions, UnsignedInt maxVertices = 64, UnsignedInt maxTriangles = 124);
+
+/**
+@brief Whether a meshlet is backfacing
+
+Returns @cpp true @ce if all triangles of @p meshlet are guaranteed to face
+away from a camera at given position (in the same coordinate system as the
+meshlet), @cpp false @ce otherwise. The test is conservative, taking
+the bounding sphere into account.
+*/
+MAGNUM_MESHTOOLS_EXPORT bool isMeshletBackfacing(const Meshlet& meshlet, const Vector3& cameraPosition);
+
+}}
+
+#endif
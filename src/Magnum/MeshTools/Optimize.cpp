@@ -0,0 +1,330 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Optimize.h"
+
+#include <algorithm>
+#include <cmath>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Math/Vector3.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+enum: UnsignedInt { NotInCache = ~UnsignedInt{} };
+
+/* Simulated FIFO cache, returns true if the vertex was a cache miss */
+class FifoCache {
+    public:
+        explicit FifoCache(UnsignedInt vertexCount, UnsignedInt cacheSize): _timestamps(vertexCount, 0), _time{cacheSize + 1}, _cacheSize{cacheSize} {}
+
+        bool use(UnsignedInt vertex) {
+            if(_time - _timestamps[vertex] <= _cacheSize) return false;
+            _timestamps[vertex] = _time++;
+            return true;
+        }
+
+        void reset() { _time += _cacheSize + 1; }
+
+    private:
+        std::vector<UnsignedInt> _timestamps;
+        UnsignedInt _time, _cacheSize;
+};
+
+}
+
+Float vertexCacheMissRatio(const Containers::ArrayView<const UnsignedInt> indices, const UnsignedInt vertexCount, const UnsignedInt cacheSize) {
+    CORRADE_ASSERT(!(indices.size()%3), "MeshTools::vertexCacheMissRatio(): index count is not divisible by 3!", {});
+    if(indices.empty()) return 0.0f;
+
+    FifoCache cache{vertexCount, cacheSize};
+    std::size_t misses = 0;
+    for(const UnsignedInt index: indices) {
+        CORRADE_ASSERT(index < vertexCount, "MeshTools::vertexCacheMissRatio(): index" << index << "out of range for" << vertexCount << "vertices", {});
+        if(cache.use(index)) ++misses;
+    }
+
+    return Float(misses)/Float(indices.size()/3);
+}
+
+namespace {
+
+/* Vertex score as described in the Forsyth's paper */
+Float vertexScore(const UnsignedInt cachePosition, const UnsignedInt remainingTriangles, const UnsignedInt cacheSize) {
+    /* No triangle needs this vertex anymore */
+    if(!remainingTriangles) return -1.0f;
+
+    Float score = 0.0f;
+    if(cachePosition != NotInCache) {
+        /* Vertices used by the last triangle have a fixed score to not favor
+           reusing them in the next triangle too much */
+        if(cachePosition < 3) score = 0.75f;
+        else score = std::pow(1.0f - Float(cachePosition - 3)/Float(cacheSize - 3), 1.5f);
+    }
+
+    /* Boost vertices with few remaining triangles so they are finished
+       early and don't leave lone triangles behind */
+    return score + 2.0f/std::sqrt(Float(remainingTriangles));
+}
+
+}
+
+void optimizeVertexCacheInPlace(const Containers::ArrayView<UnsignedInt> indices, const UnsignedInt vertexCount, const UnsignedInt cacheSize) {
+    CORRADE_ASSERT(!(indices.size()%3), "MeshTools::optimizeVertexCacheInPlace(): index count is not divisible by 3!", );
+    CORRADE_ASSERT(cacheSize > 3, "MeshTools::optimizeVertexCacheInPlace(): cache size has to be larger than 3", );
+
+    const std::size_t triangleCount = indices.size()/3;
+    if(!triangleCount) return;
+
+    /* Vertex-triangle adjacency, triangles of i-th vertex are in range
+       neighborOffset[i] to neighborOffset[i] + remainingTriangles[i]. Emitted
+       triangles are moved past the range. */
+    std::vector<UnsignedInt> remainingTriangles(vertexCount), neighborOffset(vertexCount + 1), neighbors(indices.size());
+    for(const UnsignedInt index: indices) {
+        CORRADE_ASSERT(index < vertexCount, "MeshTools::optimizeVertexCacheInPlace(): index" << index << "out of range for" << vertexCount << "vertices", );
+        ++remainingTriangles[index];
+    }
+    for(std::size_t i = 0; i != vertexCount; ++i)
+        neighborOffset[i + 1] = neighborOffset[i] + remainingTriangles[i];
+    {
+        std::vector<UnsignedInt> fill(neighborOffset.begin(), neighborOffset.end() - 1);
+        for(std::size_t i = 0; i != indices.size(); ++i)
+            neighbors[fill[indices[i]]++] = i/3;
+    }
+
+    /* Initial scores */
+    std::vector<UnsignedInt> cachePosition(vertexCount, NotInCache);
+    std::vector<Float> vertexScores(vertexCount), triangleScores(triangleCount, 0.0f);
+    for(std::size_t i = 0; i != vertexCount; ++i)
+        vertexScores[i] = vertexScore(NotInCache, remainingTriangles[i], cacheSize);
+    for(std::size_t i = 0; i != indices.size(); ++i)
+        triangleScores[i/3] += vertexScores[indices[i]];
+
+    std::vector<bool> emitted(triangleCount);
+    std::vector<UnsignedInt> output;
+    output.reserve(indices.size());
+
+    /* Cache with room for three new vertices */
+    std::vector<UnsignedInt> cache, newCache;
+    cache.reserve(cacheSize + 3);
+    newCache.reserve(cacheSize + 3);
+
+    std::size_t bestTriangle = std::max_element(triangleScores.begin(), triangleScores.end()) - triangleScores.begin();
+    std::size_t cursor = 0;
+    for(;;) {
+        /* Emit the triangle and remove it from adjacency of its vertices */
+        emitted[bestTriangle] = true;
+        for(std::size_t i = 0; i != 3; ++i) {
+            const UnsignedInt v = indices[bestTriangle*3 + i];
+            output.push_back(v);
+
+            UnsignedInt* const begin = neighbors.data() + neighborOffset[v];
+            UnsignedInt* const end = begin + remainingTriangles[v];
+            std::swap(*std::find(begin, end, bestTriangle), *(end - 1));
+            --remainingTriangles[v];
+        }
+
+        /* Put the triangle vertices to the front of the cache, followed by
+           the previous cache contents */
+        newCache.clear();
+        for(std::size_t i = 0; i != 3; ++i) {
+            const UnsignedInt v = indices[bestTriangle*3 + i];
+            if(std::find(newCache.begin(), newCache.end(), v) == newCache.end())
+                newCache.push_back(v);
+        }
+        for(const UnsignedInt v: cache)
+            if(std::find(newCache.begin(), newCache.end(), v) == newCache.end())
+                newCache.push_back(v);
+
+        /* Vertices that fell out of the cache */
+        for(std::size_t i = cacheSize; i < newCache.size(); ++i)
+            cachePosition[newCache[i]] = NotInCache;
+        if(newCache.size() > cacheSize) newCache.resize(cacheSize);
+        for(std::size_t i = 0; i != newCache.size(); ++i)
+            cachePosition[newCache[i]] = i;
+
+        /* Update scores of all vertices that were or are in the cache and of
+           their remaining triangles, pick the best one from these */
+        Float bestScore = 0.0f;
+        bestTriangle = ~std::size_t{};
+        const auto update = [&](const UnsignedInt v) {
+            const Float score = vertexScore(cachePosition[v], remainingTriangles[v], cacheSize);
+            const Float delta = score - vertexScores[v];
+            vertexScores[v] = score;
+            for(UnsignedInt i = neighborOffset[v], end = neighborOffset[v] + remainingTriangles[v]; i != end; ++i)
+                triangleScores[neighbors[i]] += delta;
+        };
+        for(const UnsignedInt v: cache) if(cachePosition[v] == NotInCache) update(v);
+        for(const UnsignedInt v: newCache) update(v);
+        for(const UnsignedInt v: newCache) {
+            for(UnsignedInt i = neighborOffset[v], end = neighborOffset[v] + remainingTriangles[v]; i != end; ++i) {
+                const UnsignedInt t = neighbors[i];
+                if(triangleScores[t] > bestScore) {
+                    bestScore = triangleScores[t];
+                    bestTriangle = t;
+                }
+            }
+        }
+        std::swap(cache, newCache);
+
+        /* Nothing usable in the cache, continue with the first triangle that
+           wasn't emitted yet */
+        if(bestTriangle == ~std::size_t{}) {
+            while(cursor != triangleCount && emitted[cursor]) ++cursor;
+            if(cursor == triangleCount) break;
+            bestTriangle = cursor;
+        }
+    }
+
+    CORRADE_INTERNAL_ASSERT(output.size() == indices.size());
+    std::copy(output.begin(), output.end(), indices.begin());
+}
+
+void optimizeOverdrawInPlace(const Containers::ArrayView<UnsignedInt> indices, const StridedArrayView<const Vector3> positions, const UnsignedInt cacheSize, const Float threshold) {
+    CORRADE_ASSERT(!(indices.size()%3), "MeshTools::optimizeOverdrawInPlace(): index count is not divisible by 3!", );
+
+    const std::size_t triangleCount = indices.size()/3;
+    if(!triangleCount) return;
+
+    const UnsignedInt vertexCount = positions.size();
+    #ifndef CORRADE_NO_ASSERT
+    for(const UnsignedInt index: indices)
+        CORRADE_ASSERT(index < vertexCount, "MeshTools::optimizeOverdrawInPlace(): index" << index << "out of range for" << vertexCount << "vertices", );
+    #endif
+
+    /* Hard cluster boundaries are at triangles with all vertices missing the
+       cache, as the cache is effectively flushed there anyway. The first
+       boundary is always at the beginning, even if the first triangle is
+       degenerate and thus can't have three misses. */
+    std::vector<std::size_t> hardBoundaries{0};
+    {
+        FifoCache cache{vertexCount, cacheSize};
+        for(std::size_t t = 0; t != triangleCount; ++t) {
+            std::size_t misses = 0;
+            for(std::size_t i = 0; i != 3; ++i)
+                if(cache.use(indices[t*3 + i])) ++misses;
+            if(misses == 3 && t) hardBoundaries.push_back(t);
+        }
+        hardBoundaries.push_back(triangleCount);
+    }
+
+    /* Split each hard cluster further at points where the cache miss ratio
+       of the cluster so far is within the threshold of the whole cluster --
+       breaking the cache there doesn't make the result much worse */
+    std::vector<std::size_t> clusters;
+    {
+        FifoCache cache{vertexCount, cacheSize};
+        for(std::size_t c = 0; c + 1 < hardBoundaries.size(); ++c) {
+            const std::size_t begin = hardBoundaries[c], end = hardBoundaries[c + 1];
+
+            cache.reset();
+            std::size_t clusterMisses = 0;
+            for(std::size_t i = begin*3; i != end*3; ++i)
+                if(cache.use(indices[i])) ++clusterMisses;
+            const Float clusterRatio = Float(clusterMisses)/Float(end - begin);
+
+            cache.reset();
+            clusters.push_back(begin);
+            std::size_t misses = 0, triangles = 0;
+            for(std::size_t t = begin; t + 1 < end; ++t) {
+                for(std::size_t i = 0; i != 3; ++i)
+                    if(cache.use(indices[t*3 + i])) ++misses;
+                ++triangles;
+
+                if(Float(misses)/Float(triangles) <= threshold*clusterRatio) {
+                    clusters.push_back(t + 1);
+                    cache.reset();
+                    misses = triangles = 0;
+                }
+            }
+        }
+        clusters.push_back(triangleCount);
+    }
+
+    /* Mesh centroid */
+    Vector3 meshCentroid;
+    for(std::size_t i = 0; i != vertexCount; ++i)
+        meshCentroid += positions[i];
+    meshCentroid /= Float(vertexCount);
+
+    /* Sort key of each cluster is how much it faces away from the mesh
+       centroid */
+    const std::size_t clusterCount = clusters.size() - 1;
+    std::vector<Float> sortKeys(clusterCount);
+    for(std::size_t c = 0; c != clusterCount; ++c) {
+        Vector3 centroid, normal;
+        Float area = 0.0f;
+        for(std::size_t t = clusters[c]; t != clusters[c + 1]; ++t) {
+            const Vector3& p0 = positions[indices[t*3]];
+            const Vector3& p1 = positions[indices[t*3 + 1]];
+            const Vector3& p2 = positions[indices[t*3 + 2]];
+            const Vector3 n = Math::cross(p1 - p0, p2 - p0);
+            const Float triangleArea = n.length();
+
+            centroid += (p0 + p1 + p2)*(triangleArea/3.0f);
+            normal += n;
+            area += triangleArea;
+        }
+
+        if(area == 0.0f) continue;
+        sortKeys[c] = Math::dot(centroid/area - meshCentroid, normal/area);
+    }
+
+    std::vector<UnsignedInt> order(clusterCount);
+    for(std::size_t i = 0; i != clusterCount; ++i) order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&sortKeys](UnsignedInt a, UnsignedInt b) {
+        return sortKeys[a] > sortKeys[b];
+    });
+
+    std::vector<UnsignedInt> output;
+    output.reserve(indices.size());
+    for(const UnsignedInt c: order)
+        output.insert(output.end(), indices.begin() + clusters[c]*3, indices.begin() + clusters[c + 1]*3);
+
+    CORRADE_INTERNAL_ASSERT(output.size() == indices.size());
+    std::copy(output.begin(), output.end(), indices.begin());
+}
+
+std::vector<UnsignedInt> optimizeVertexFetchInPlace(const Containers::ArrayView<UnsignedInt> indices, const UnsignedInt vertexCount) {
+    std::vector<UnsignedInt> remapping(vertexCount, NotInCache);
+    std::vector<UnsignedInt> order;
+    order.reserve(vertexCount);
+
+    for(UnsignedInt& index: indices) {
+        CORRADE_ASSERT(index < vertexCount, "MeshTools::optimizeVertexFetchInPlace(): index" << index << "out of range for" << vertexCount << "vertices", {});
+        if(remapping[index] == NotInCache) {
+            remapping[index] = order.size();
+            order.push_back(index);
+        }
+        index = remapping[index];
+    }
+
+    return order;
+}
+
+}}
@@ -0,0 +1,136 @@
+#ifndef Magnum_MeshTools_Optimize_h
+#define Magnum_MeshTools_Optimize_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::vertexCacheMissRatio(), @ref Magnum::MeshTools::optimizeVertexCacheInPlace(), @ref Magnum::MeshTools::optimizeOverdrawInPlace(), @ref Magnum::MeshTools::optimizeVertexFetchInPlace()
+ */
+
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/StridedArrayView.h"
+#include "Magnum/MeshTools/visibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Average cache miss ratio of a mesh
+@param indices      Triangle indices
+@param vertexCount  Vertex count
+@param cacheSize    Post-transform vertex cache size
+
+Simulates a FIFO post-transform vertex cache of given size and returns
+average count of cache misses per triangle (ACMR). The value is between
+@cpp 0.5 @ce (theoretical optimum for large regular meshes) and
+@cpp 3.0 @ce (no vertex reuse). Useful for measuring the effect of
+@ref optimizeVertexCacheInPlace(), @ref tipsify() or
+@ref optimizeOverdrawInPlace().
+
+@attention The function requires the mesh to have triangle faces, thus index
+    count must be divisible by 3.
+*/
+Float MAGNUM_MESHTOOLS_EXPORT vertexCacheMissRatio(Containers::ArrayView<const UnsignedInt> indices, UnsignedInt vertexCount, UnsignedInt cacheSize);
+
+/**
+@brief Optimize the mesh for post-transform vertex cache
+@param[in,out] indices  Triangle indices
+@param[in] vertexCount  Vertex count
+@param[in] cacheSize    Size of the simulated vertex cache
+
+Reorders the triangles for better usage of post-transform vertex cache using
+a greedy algorithm scoring the vertices based on their position in a
+simulated LRU cache and count of remaining triangles using them. Algorithm
+used: *Tom Forsyth --- Linear-Speed Vertex Cache Optimisation, 2006,
+https://tomforsyth1000.github.io/papers/fast_vert_cache_opt.html*.
+
+Unlike @ref tipsify(), the result doesn't depend much on the exact cache
+size, which makes it suitable for modern GPUs where the size of the cache is
+unknown or varies with vertex shader output size.
+
+@attention The function requires the mesh to have triangle faces, thus index
+    count must be divisible by 3.
+@see @ref vertexCacheMissRatio(), @ref optimizeOverdrawInPlace(),
+    @ref optimizeVertexFetchInPlace()
+*/
+void MAGNUM_MESHTOOLS_EXPORT optimizeVertexCacheInPlace(Containers::ArrayView<UnsignedInt> indices, UnsignedInt vertexCount, UnsignedInt cacheSize = 32);
+
+/**
+@brief Optimize the mesh for overdraw
+@param[in,out] indices  Triangle indices, ideally already optimized for
+    vertex cache
+@param[in] positions    Vertex positions
+@param[in] cacheSize    Post-transform vertex cache size
+@param[in] threshold    How much can the average cache miss ratio get worse
+
+Splits the index buffer into clusters at points where the vertex cache
+efficiency isn't affected by more than @p threshold and sorts the clusters
+so ones facing outwards from mesh centroid get drawn first, which reduces
+overdraw from any view direction. Algorithm used: *Pedro V. Sander, Diego
+Nehab, and Joshua Barczak --- Fast Triangle Reordering for Vertex Locality
+and Reduced Overdraw, SIGGRAPH 2007*, the same as with @ref tipsify().
+Triangle order inside the clusters is preserved, so run
+@ref optimizeVertexCacheInPlace() first.
+
+@attention The function requires the mesh to have triangle faces, thus index
+    count must be divisible by 3.
+*/
+void MAGNUM_MESHTOOLS_EXPORT optimizeOverdrawInPlace(Containers::ArrayView<UnsignedInt> indices, StridedArrayView<const Vector3> positions, UnsignedInt cacheSize = 32, Float threshold = 1.05f);
+
+/**
+@brief Optimize the mesh for vertex fetch
+@param[in,out] indices  Triangle indices
+@param[in] vertexCount  Vertex count
+@return Original vertex index for each new vertex
+
+Renumbers the vertices in order of their first use in the index buffer, so
+the vertex data are fetched sequentially, and returns the order in which the
+vertex data should be placed. Vertices not referenced by any index are
+omitted. Pass the result to @ref duplicate() or @ref duplicateInto() to
+reorder each vertex attribute:
+
+@code{.cpp}
+std::vector<UnsignedInt> indices;
+std::vector<Vector3> positions;
+std::vector<Vector2> textureCoordinates;
+
+Containers::ArrayView<UnsignedInt> indexView{indices.data(), indices.size()};
+MeshTools::optimizeVertexCacheInPlace(indexView, positions.size());
+std::vector<UnsignedInt> order = MeshTools::optimizeVertexFetchInPlace(indexView, positions.size());
+positions = MeshTools::duplicate(order, positions);
+textureCoordinates = MeshTools::duplicate(order, textureCoordinates);
+@endcode
+
+Run this as the last step, after @ref optimizeVertexCacheInPlace() and
+@ref optimizeOverdrawInPlace().
+*/
+std::vector<UnsignedInt> MAGNUM_MESHTOOLS_EXPORT optimizeVertexFetchInPlace(Containers::ArrayView<UnsignedInt> indices, UnsignedInt vertexCount);
+
+}}
+
+#endif
@@ -0,0 +1,97 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Pack.h"
+
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Math/Range.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/Bounds.h"
+
+namespace Magnum { namespace MeshTools {
+
+void packNormalsInto(const StridedArrayView<const Vector3> normals, const StridedArrayView<UnsignedInt> out) {
+    CORRADE_ASSERT(normals.size() == out.size(),
+        "MeshTools::packNormalsInto(): expected output size" << normals.size() << "but got" << out.size(), );
+
+    for(std::size_t i = 0; i != normals.size(); ++i) {
+        const Math::Vector3<Int> packed = Math::pack<Math::Vector3<Int>, 10>(Math::clamp(normals[i], -1.0f, 1.0f));
+        out[i] = (UnsignedInt(packed.x()) & 0x3ff) |
+                 (UnsignedInt(packed.y()) & 0x3ff) << 10 |
+                 (UnsignedInt(packed.z()) & 0x3ff) << 20;
+    }
+}
+
+namespace {
+
+inline Vector2 signNotZero(const Vector2& v) {
+    return {v.x() >= 0.0f ? 1.0f : -1.0f, v.y() >= 0.0f ? 1.0f : -1.0f};
+}
+
+}
+
+void packOctahedralInto(const StridedArrayView<const Vector3> normals, const StridedArrayView<Math::Vector2<Short>> out) {
+    CORRADE_ASSERT(normals.size() == out.size(),
+        "MeshTools::packOctahedralInto(): expected output size" << normals.size() << "but got" << out.size(), );
+
+    for(std::size_t i = 0; i != normals.size(); ++i) {
+        const Vector3& n = normals[i];
+        Vector2 p = n.xy()/(Math::abs(n.x()) + Math::abs(n.y()) + Math::abs(n.z()));
+        if(n.z() < 0.0f)
+            p = (Vector2{1.0f} - Math::abs(Vector2{p.y(), p.x()}))*signNotZero(p);
+        out[i] = Math::pack<Math::Vector2<Short>>(Math::clamp(p, -1.0f, 1.0f));
+    }
+}
+
+Vector3 unpackOctahedral(const Math::Vector2<Short>& packed) {
+    const Vector2 p = Math::unpack<Vector2>(packed);
+    Vector3 n{p, 1.0f - Math::abs(p.x()) - Math::abs(p.y())};
+    if(n.z() < 0.0f)
+        n.xy() = (Vector2{1.0f} - Math::abs(Vector2{n.y(), n.x()}))*signNotZero(n.xy());
+    return n.normalized();
+}
+
+Range3D packPositionsInto(const StridedArrayView<const Vector3> positions, const StridedArrayView<Math::Vector3<UnsignedShort>> out) {
+    CORRADE_ASSERT(positions.size() == out.size(),
+        "MeshTools::packPositionsInto(): expected output size" << positions.size() << "but got" << out.size(), {});
+    if(!positions.size()) return {};
+
+    const Range3D range = bounds(positions);
+    const Vector3 min = range.min();
+
+    /* Avoid division by zero for flat meshes */
+    const Vector3 size = range.size();
+    const Vector3 scale{size.x() == 0.0f ? 1.0f : size.x(),
+                        size.y() == 0.0f ? 1.0f : size.y(),
+                        size.z() == 0.0f ? 1.0f : size.z()};
+
+    for(std::size_t i = 0; i != positions.size(); ++i)
+        out[i] = Math::pack<Math::Vector3<UnsignedShort>>(Math::clamp((positions[i] - min)/scale, 0.0f, 1.0f));
+
+    return Range3D::fromSize(min, scale);
+}
+
+}}
@@ -0,0 +1,186 @@
+#ifndef Magnum_MeshTools_Pack_h
+#define Magnum_MeshTools_Pack_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::packInto(), @ref Magnum::MeshTools::packHalfInto(), @ref Magnum::MeshTools::packNormalsInto(), @ref Magnum::MeshTools::packOctahedralInto(), @ref Magnum::MeshTools::unpackOctahedral(), @ref Magnum::MeshTools::packPositionsInto()
+ */
+
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Half.h"
+#include "Magnum/Math/Packing.h"
+#include "Magnum/MeshTools/StridedArrayView.h"
+#include "Magnum/MeshTools/visibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Pack floating-point vectors into normalized integral vectors
+@param[in] in   Floating-point vectors
+@param[out] out Integral vectors, expected to have the same size as @p in
+
+Calls @ref Math::pack() on each item, clamping the input to the
+representable range first --- @f$ [0, 1] @f$ for unsigned types and
+@f$ [-1, 1] @f$ for signed types. The output can be then used as attribute
+with @ref Attribute::DataOption::Normalized, for example texture coordinates
+in @ref Math::Vector2 "Math::Vector2<UnsignedShort>" or colors in
+@ref Color4ub:
+
+@code{.cpp}
+std::vector<Color4> colors;
+std::vector<Color4ub> packedColors(colors.size());
+MeshTools::packInto<Color4ub, Color4>(
+    Containers::ArrayView<const Color4>{colors.data(), colors.size()},
+    Containers::ArrayView<Color4ub>{packedColors.data(), packedColors.size()});
+
+mesh.addVertexBuffer(buffer, 0, Shaders::Generic3D::Color{
+    Shaders::Generic3D::Color::Components::Four,
+    Shaders::Generic3D::Color::DataType::UnsignedByte,
+    Shaders::Generic3D::Color::DataOption::Normalized});
+@endcode
+
+@see @ref packHalfInto(), @ref packNormalsInto()
+*/
+template<class Integral, class FloatingPoint> void packInto(const StridedArrayView<const FloatingPoint> in, const StridedArrayView<Integral> out) {
+    CORRADE_ASSERT(in.size() == out.size(),
+        "MeshTools::packInto(): expected output size" << in.size() << "but got" << out.size(), );
+
+    const typename FloatingPoint::Type min = std::is_signed<typename Integral::Type>::value ? -1 : 0;
+    for(std::size_t i = 0; i != in.size(); ++i)
+        out[i] = Math::pack<Integral>(Math::clamp(in[i], min, typename FloatingPoint::Type(1)));
+}
+
+/**
+@brief Pack floating-point vectors into half-floats
+@param[in] in   Floating-point vectors
+@param[out] out Half-float vectors, expected to have the same size as @p in
+
+Calls @ref Math::packHalf() on each item. The output can be then used as
+attribute with @ref Attribute::DataType::HalfFloat. Note that half-floats
+have only 11 bits of mantissa, which is enough for positions of small
+objects centered around origin, but not for large models.
+@see @ref packPositionsInto()
+*/
+template<std::size_t size> void packHalfInto(const StridedArrayView<const Math::Vector<size, Float>> in, const StridedArrayView<Math::Vector<size, UnsignedShort>> out) {
+    CORRADE_ASSERT(in.size() == out.size(),
+        "MeshTools::packHalfInto(): expected output size" << in.size() << "but got" << out.size(), );
+
+    for(std::size_t i = 0; i != in.size(); ++i)
+        out[i] = Math::packHalf(in[i]);
+}
+
+/**
+@overload
+
+Packs into @ref Math::Half vectors such as @ref Vector3h instead of their raw
+underlying representation.
+*/
+template<std::size_t size> void packHalfInto(const StridedArrayView<const Math::Vector<size, Float>> in, const StridedArrayView<Math::Vector<size, Half>> out) {
+    CORRADE_ASSERT(in.size() == out.size(),
+        "MeshTools::packHalfInto(): expected output size" << in.size() << "but got" << out.size(), );
+
+    for(std::size_t i = 0; i != in.size(); ++i)
+        out[i] = Math::Vector<size, Half>{Math::packHalf(in[i])};
+}
+
+/**
+@brief Pack normals into 10-10-10-2 format
+@param[in] normals  Normalized normal vectors
+@param[out] out     Packed normals, expected to have the same size as
+    @p normals
+
+Packs each component into a signed normalized 10-bit value, with the
+remaining two bits set to zero, in layout matching
+@ref DynamicAttribute::DataType::Int2101010Rev. As the format needs four
+components, the attribute has to be specified using @ref DynamicAttribute:
+
+@code{.cpp}
+mesh.addVertexBuffer(buffer, 0, DynamicAttribute{
+    DynamicAttribute::Kind::GenericNormalized,
+    Shaders::Generic3D::Normal::Location,
+    DynamicAttribute::Components::Four,
+    DynamicAttribute::DataType::Int2101010Rev});
+@endcode
+
+The packed normal takes four bytes instead of twelve.
+@see @ref packOctahedralInto()
+*/
+MAGNUM_MESHTOOLS_EXPORT void packNormalsInto(StridedArrayView<const Vector3> normals, StridedArrayView<UnsignedInt> out);
+
+/**
+@brief Pack normals using octahedral encoding
+@param[in] normals  Normalized normal vectors
+@param[out] out     Packed normals, expected to have the same size as
+    @p normals
+
+Projects the normals onto an octahedron and unfolds it to a square, storing
+the result as two signed normalized 16-bit values. The error is
+distributed more evenly than with @ref packNormalsInto() at the same size,
+but the shader needs to decode the normal, see @ref unpackOctahedral() for
+the reference implementation. Algorithm used: *Zina H. Cigolle et al. ---
+A Survey of Efficient Representations for Independent Unit Vectors, JCGT
+2014*.
+*/
+MAGNUM_MESHTOOLS_EXPORT void packOctahedralInto(StridedArrayView<const Vector3> normals, StridedArrayView<Math::Vector2<Short>> out);
+
+/**
+@brief Unpack an octahedral-encoded normal
+
+Inverse to @ref packOctahedralInto(). Returns a normalized vector.
+*/
+MAGNUM_MESHTOOLS_EXPORT Vector3 unpackOctahedral(const Math::Vector2<Short>& packed);
+
+/**
+@brief Quantize positions
+@param[in] positions    Vertex positions
+@param[out] out         Quantized positions, expected to have the same size
+    as @p positions
+@return Bounds of the positions
+
+Maps the positions into their bounding box and stores them as unsigned
+normalized 16-bit values, so the precision is uniform across the whole mesh
+unlike with @ref packHalfInto(). Use the returned bounds to get the
+original positions back, the easiest is to include the dequantization in
+the transformation matrix:
+
+@code{.cpp}
+Range3D bounds = MeshTools::packPositionsInto(positions, packedPositions);
+mesh.addVertexBuffer(buffer, 0, Shaders::Generic3D::Position{
+    Shaders::Generic3D::Position::DataType::UnsignedShort,
+    Shaders::Generic3D::Position::DataOption::Normalized}, 2);
+
+Matrix4 transformation = objectTransformation*
+    Matrix4::translation(bounds.min())*Matrix4::scaling(bounds.size());
+@endcode
+*/
+MAGNUM_MESHTOOLS_EXPORT Range3D packPositionsInto(StridedArrayView<const Vector3> positions, StridedArrayView<Math::Vector3<UnsignedShort>> out);
+
+}}
+
+#endif
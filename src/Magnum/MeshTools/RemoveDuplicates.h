@@ -26,27 +26,168 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::MeshTools::removeDuplicates()
+ * @brief Function @ref Magnum::MeshTools::removeDuplicates(), @ref Magnum::MeshTools::removeDuplicatesInPlace(), @ref Magnum::MeshTools::removeDuplicatesExact(), @ref Magnum::MeshTools::removeDuplicatesExactInPlace()
  */
 
+#include <algorithm>
 #include <limits>
 #include <numeric>
-#include <unordered_map>
 #include <vector>
-#include <Corrade/Utility/MurmurHash2.h>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
 
 #include "Magnum/Magnum.h"
+#include "Magnum/ThreadPool.h"
 #include "Magnum/Math/Functions.h"
+#include "Magnum/MeshTools/duplicateTable.h"
 
 namespace Magnum { namespace MeshTools {
 
 namespace Implementation {
-    template<std::size_t size> class VectorHash {
-        public:
-            std::size_t operator()(const Math::Vector<size, std::size_t>& data) const {
-                return *reinterpret_cast<const std::size_t*>(Utility::MurmurHash2()(reinterpret_cast<const char*>(&data), sizeof(data)).byteArray());
+    /* Moves vectors that are first occurences to the front, keeping their
+       order, and remaps the index array to the new positions. Returns count
+       of unique vectors. */
+    template<class Vector> std::size_t compactDuplicates(const Containers::ArrayView<Vector> data, const std::size_t size, const UnsignedInt* const first, UnsignedInt* const remapping, const Containers::ArrayView<UnsignedInt> indices) {
+        std::size_t unique = 0;
+        for(std::size_t i = 0; i != size; ++i) {
+            if(first[i] == i) {
+                remapping[i] = unique;
+                if(i != unique) data[unique] = data[i];
+                ++unique;
+            } else remapping[i] = remapping[first[i]];
+        }
+
+        for(UnsignedInt& i: indices) i = remapping[i];
+        return unique;
+    }
+
+    template<class Vector> std::size_t removeDuplicatesInPlace(const Containers::ArrayView<Vector> data, const Containers::ArrayView<UnsignedInt> indices, typename Vector::Type epsilon, ThreadPool* const pool) {
+        CORRADE_ASSERT(indices.size() == data.size(),
+            "MeshTools::removeDuplicatesInPlace(): expected" << data.size() << "indices but got" << indices.size(), 0);
+
+        std::iota(indices.begin(), indices.end(), 0);
+        if(data.empty()) return 0;
+
+        /* Get bounds */
+        Vector min = data[0], max = data[0];
+        for(const Vector& v: data) {
+            min = Math::min(v, min);
+            max = Math::max(v, max);
+        }
+
+        /* Make epsilon so large that std::size_t can index all vectors inside
+           the bounds. */
+        epsilon = Math::max(epsilon, typename Vector::Type((max-min).max()/~std::size_t{}));
+
+        /* Each partition handles a distinct subset of hashes with its own
+           table, so the partitions can be processed in parallel and the
+           result doesn't depend on the partitioning */
+        const std::size_t partitionCount = pool ? pool->threadCount() : 1;
+
+        std::vector<Math::Vector<Vector::Size, std::size_t>> keys(data.size());
+        std::vector<UnsignedLong> hashes(data.size());
+        std::vector<UnsignedInt> first(data.size()), remapping(data.size());
+
+        /* First go with original coordinates, then move them by epsilon/2 in
+           each direction. */
+        std::size_t size = data.size();
+        Vector moved;
+        for(std::size_t moving = 0; moving <= Vector::Size; ++moving) {
+            const auto discretize = [&](const std::size_t begin, const std::size_t end) {
+                for(std::size_t i = begin; i != end; ++i) {
+                    keys[i] = Math::Vector<Vector::Size, std::size_t>((data[i] + moved - min)/epsilon);
+                    hashes[i] = hashIntegers(keys[i].data(), Vector::Size);
+                }
+            };
+
+            const auto findFirst = [&](const std::size_t begin, const std::size_t end) {
+                for(std::size_t partition = begin; partition != end; ++partition) {
+                    DuplicateTable table{size/partitionCount};
+                    for(std::size_t i = 0; i != size; ++i)
+                        if((hashes[i] >> 40) % partitionCount == partition)
+                            first[i] = table.findOrInsert(hashes[i], i, [&](const UnsignedInt j) {
+                                return keys[j] == keys[i];
+                            });
+                }
+            };
+
+            if(pool) {
+                pool->parallelFor(size, 4096, discretize);
+                pool->parallelFor(partitionCount, 1, findFirst);
+            } else {
+                discretize(0, size);
+                findFirst(0, 1);
+            }
+
+            size = compactDuplicates(data, size, first.data(), remapping.data(), indices);
+
+            /* Move vertex coordinates by epsilon/2 in next direction */
+            if(moving == Vector::Size) continue;
+            moved = Vector();
+            moved[moving] = epsilon/2;
+        }
+
+        return size;
+    }
+
+    template<class Vector> std::size_t removeDuplicatesExactInPlace(const Containers::ArrayView<Vector> data, const Containers::ArrayView<UnsignedInt> indices) {
+        CORRADE_ASSERT(indices.size() == data.size(),
+            "MeshTools::removeDuplicatesExactInPlace(): expected" << data.size() << "indices but got" << indices.size(), 0);
+
+        std::iota(indices.begin(), indices.end(), 0);
+        if(data.empty()) return 0;
+
+        /* Sort indices lexicographically by the data, equal vectors ordered
+           by their original position */
+        std::vector<UnsignedInt> order(data.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&data](const UnsignedInt a, const UnsignedInt b) {
+            for(std::size_t i = 0; i != Vector::Size; ++i) {
+                if(data[a][i] < data[b][i]) return true;
+                if(data[b][i] < data[a][i]) return false;
             }
-    };
+            return a < b;
+        });
+
+        /* First element of each run of equal vectors is the first occurence */
+        std::vector<UnsignedInt> first(data.size()), remapping(data.size());
+        first[order[0]] = order[0];
+        for(std::size_t i = 1; i != order.size(); ++i)
+            first[order[i]] = data[order[i]] == data[order[i - 1]] ? first[order[i - 1]] : order[i];
+
+        return compactDuplicates(data, data.size(), first.data(), remapping.data(), indices);
+    }
+}
+
+/**
+@brief Remove duplicate floating-point vector data from given array in place
+@param[in,out] data Input data array
+@param[out] indices Index array, expected to have the same size as @p data
+@param[in] epsilon  Epsilon value, vertices nearer than this distance will be
+    melt together
+@return Count of unique vectors
+
+Unique vectors are moved to the front of @p data, preserving order of their
+first occurence, and @p indices are filled with index of the unique vector
+for each original vector. The rest of @p data is left in unspecified state.
+Works directly on a view of the data without any copying, otherwise the same
+as @ref removeDuplicates(std::vector<Vector>&, typename Vector::Type).
+*/
+template<class Vector> std::size_t removeDuplicatesInPlace(const Containers::ArrayView<Vector> data, const Containers::ArrayView<UnsignedInt> indices, typename Vector::Type epsilon = Math::TypeTraits<typename Vector::Type>::epsilon()) {
+    return Implementation::removeDuplicatesInPlace(data, indices, epsilon, nullptr);
+}
+
+/**
+@brief Remove duplicate floating-point vector data from given array in place using a thread pool
+
+Same as @ref removeDuplicatesInPlace(Containers::ArrayView<Vector>, Containers::ArrayView<UnsignedInt>, typename Vector::Type),
+but discretization of the vectors is done in parallel and the lookup is
+partitioned by hash into one independent table per thread. The result is the
+same as with the single-threaded variant.
+*/
+template<class Vector> std::size_t removeDuplicatesInPlace(const Containers::ArrayView<Vector> data, const Containers::ArrayView<UnsignedInt> indices, ThreadPool& pool, typename Vector::Type epsilon = Math::TypeTraits<typename Vector::Type>::epsilon()) {
+    return Implementation::removeDuplicatesInPlace(data, indices, epsilon, &pool);
 }
 
 /**
@@ -58,9 +199,11 @@ namespace Implementation {
 
 Removes duplicate data from the array by collapsing them into buckets of size
 @p epsilon. First vector in given bucket is used, other ones are thrown away,
-no interpolation is done. Note that this function is meant to be used for
-floating-point data (or generally with non-zero @p epsilon), for discrete data
-the usual sorting method is much more efficient.
+no interpolation is done. The buckets are looked up in a flat open-addressing
+hash table, so there's no allocation per unique vector. Note that this
+function is meant to be used for floating-point data (or generally with
+non-zero @p epsilon), for discrete data the sort-based
+@ref removeDuplicatesExact() is more efficient.
 
 If you want to remove duplicate data from already indexed array, first remove
 duplicates as if the array wasn't indexed at all and then use @ref duplicate()
@@ -74,70 +217,58 @@ to combine the resulting index arrays to single index array and reorder the
 data accordingly:
 
 @snippet MagnumMeshTools.cpp removeDuplicates2
+
+@see @ref removeDuplicatesInPlace()
 */
 template<class Vector> std::vector<UnsignedInt> removeDuplicates(std::vector<Vector>& data, typename Vector::Type epsilon = Math::TypeTraits<typename Vector::Type>::epsilon()) {
-    /* Get bounds */
-    Vector min = data[0], max = data[0];
-    for(const auto& v: data) {
-        min = Math::min(v, min);
-        max = Math::max(v, max);
-    }
-
-    /* Make epsilon so large that std::size_t can index all vectors inside the
-       bounds. */
-    epsilon = Math::max(epsilon, typename Vector::Type((max-min).max()/~std::size_t{}));
-
-    /* Resulting index array */
-    std::vector<UnsignedInt> resultIndices(data.size());
-    std::iota(resultIndices.begin(), resultIndices.end(), 0);
-
-    /* Table containing original vector index for each discretized vector.
-       Reserving more buckets than necessary (i.e. as if each vector was
-       unique). */
-    std::unordered_map<Math::Vector<Vector::Size, std::size_t>, UnsignedInt, Implementation::VectorHash<Vector::Size>> table(data.size());
-
-    /* Index array for each pass, new data array */
-    std::vector<UnsignedInt> indices;
-    indices.reserve(data.size());
-
-    /* First go with original coordinates, then move them by epsilon/2 in each
-       direction. */
-    Vector moved;
-    for(std::size_t moving = 0; moving <= Vector::Size; ++moving) {
-        /* Go through all vectors */
-        for(std::size_t i = 0; i != data.size(); ++i) {
-            /* Try to insert new vertex to the table */
-            const Math::Vector<Vector::Size, std::size_t> v((data[i] + moved - min)/epsilon);
-            const auto result = table.emplace(v, table.size());
-
-            /* Add the (either new or already existing) index to index array */
-            indices.push_back(result.first->second);
-
-            /* If this is new combination, copy the data to new (earlier)
-               possition in the array */
-            if(result.second && i != table.size()-1) data[table.size()-1] = data[i];
-        }
+    std::vector<UnsignedInt> indices(data.size());
+    data.resize(removeDuplicatesInPlace(Containers::arrayView(data.data(), data.size()), Containers::arrayView(indices.data(), indices.size()), epsilon));
+    return indices;
+}
 
-        /* Shrink the data array */
-        CORRADE_INTERNAL_ASSERT(data.size() >= table.size());
-        data.resize(table.size());
+/**
+@brief Remove duplicate floating-point vector data from given array using a thread pool
 
-        /* Remap the resulting index array */
-        for(auto& i: resultIndices) i = indices[i];
+Same as @ref removeDuplicates(std::vector<Vector>&, typename Vector::Type),
+but parallelized in the same way as
+@ref removeDuplicatesInPlace(Containers::ArrayView<Vector>, Containers::ArrayView<UnsignedInt>, ThreadPool&, typename Vector::Type).
+*/
+template<class Vector> std::vector<UnsignedInt> removeDuplicates(std::vector<Vector>& data, ThreadPool& pool, typename Vector::Type epsilon = Math::TypeTraits<typename Vector::Type>::epsilon()) {
+    std::vector<UnsignedInt> indices(data.size());
+    data.resize(removeDuplicatesInPlace(Containers::arrayView(data.data(), data.size()), Containers::arrayView(indices.data(), indices.size()), pool, epsilon));
+    return indices;
+}
 
-        /* Finished */
-        if(moving == Vector::Size) continue;
+/**
+@brief Remove exact duplicates of discrete vector data from given array in place
+@param[in,out] data Input data array
+@param[out] indices Index array, expected to have the same size as @p data
+@return Count of unique vectors
 
-        /* Move vertex coordinates by epsilon/2 in next direction */
-        moved = Vector();
-        moved[moving] = epsilon/2;
+Same as @ref removeDuplicatesExact(), but works directly on a view of the data
+without copying. Unique vectors are moved to the front of @p data, preserving
+order of their first occurence, the rest of @p data is left in unspecified
+state.
+*/
+template<class Vector> std::size_t removeDuplicatesExactInPlace(const Containers::ArrayView<Vector> data, const Containers::ArrayView<UnsignedInt> indices) {
+    return Implementation::removeDuplicatesExactInPlace(data, indices);
+}
 
-        /* Clear the structures for next pass */
-        table.clear();
-        indices.clear();
-    }
+/**
+@brief Remove exact duplicates of discrete vector data from given array
+@param[in,out] data Input data array
+@return Index array and unique data
 
-    return resultIndices;
+Sorts the vectors and collapses runs of equal ones, keeping the first
+occurence. Meant for integral or otherwise discrete data where only
+bit-exact duplicates should be removed, for floating-point data with some
+tolerance use @ref removeDuplicates() instead. The output has the same
+layout as with @ref removeDuplicates().
+*/
+template<class Vector> std::vector<UnsignedInt> removeDuplicatesExact(std::vector<Vector>& data) {
+    std::vector<UnsignedInt> indices(data.size());
+    data.resize(removeDuplicatesExactInPlace(Containers::arrayView(data.data(), data.size()), Containers::arrayView(indices.data(), indices.size())));
+    return indices;
 }
 
 }}
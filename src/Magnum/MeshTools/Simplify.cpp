@@ -0,0 +1,250 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Simplify.h"
+
+#include <algorithm>
+#include <cmath>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Math/Vector3.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+/* Symmetric 4x4 matrix describing sum of squared distances to a set of
+   planes, together with sum of their weights */
+struct Quadric {
+    Float a00, a01, a02, a11, a12, a22, b0, b1, b2, c, w;
+
+    /* Plane going through point with given unit normal */
+    static Quadric fromPlane(const Vector3& normal, const Vector3& point, const Float weight) {
+        const Float d = -Math::dot(normal, point);
+        return {
+            weight*normal.x()*normal.x(), weight*normal.x()*normal.y(),
+            weight*normal.x()*normal.z(), weight*normal.y()*normal.y(),
+            weight*normal.y()*normal.z(), weight*normal.z()*normal.z(),
+            weight*normal.x()*d, weight*normal.y()*d, weight*normal.z()*d,
+            weight*d*d, weight};
+    }
+
+    Quadric& operator+=(const Quadric& other) {
+        a00 += other.a00; a01 += other.a01; a02 += other.a02;
+        a11 += other.a11; a12 += other.a12; a22 += other.a22;
+        b0 += other.b0; b1 += other.b1; b2 += other.b2;
+        c += other.c; w += other.w;
+        return *this;
+    }
+
+    /* Weighted mean squared distance of given point to the planes */
+    Float error(const Vector3& p) const {
+        if(w == 0.0f) return 0.0f;
+        const Float x = p.x(), y = p.y(), z = p.z();
+        const Float e =
+            a00*x*x + 2.0f*a01*x*y + 2.0f*a02*x*z +
+            a11*y*y + 2.0f*a12*y*z + a22*z*z +
+            2.0f*(b0*x + b1*y + b2*z) + c;
+        return std::abs(e)/w;
+    }
+};
+
+struct Collapse {
+    Float error;
+    UnsignedInt from, to;
+};
+
+inline UnsignedLong edgeKey(const UnsignedInt a, const UnsignedInt b) {
+    return (UnsignedLong(a) << 32)|b;
+}
+
+}
+
+std::vector<UnsignedInt> simplify(const Containers::ArrayView<const UnsignedInt> indices, const StridedArrayView<const Vector3> positions, const std::size_t targetIndexCount, const Float maxError) {
+    CORRADE_ASSERT(!(indices.size()%3), "MeshTools::simplify(): index count is not divisible by 3!", {});
+
+    const std::size_t vertexCount = positions.size();
+    std::vector<UnsignedInt> result(indices.begin(), indices.end());
+    #ifndef CORRADE_NO_ASSERT
+    for(const UnsignedInt index: result)
+        CORRADE_ASSERT(index < vertexCount, "MeshTools::simplify(): index" << index << "out of range for" << vertexCount << "vertices", {});
+    #endif
+
+    /* Quadrics of all triangles adjacent to each vertex, weighted by
+       triangle area */
+    std::vector<Quadric> quadrics(vertexCount, Quadric{});
+    for(std::size_t i = 0; i != result.size(); i += 3) {
+        const Vector3& p0 = positions[result[i]];
+        const Vector3 n = Math::cross(positions[result[i + 1]] - p0, positions[result[i + 2]] - p0);
+        const Float area = n.length();
+        if(area == 0.0f) continue;
+
+        const Quadric q = Quadric::fromPlane(n/area, p0, area);
+        for(std::size_t j = 0; j != 3; ++j) quadrics[result[i + j]] += q;
+    }
+
+    const Float maxSquaredError = maxError*maxError;
+    std::vector<UnsignedInt> triangleOffset(vertexCount + 1), triangles, remap(vertexCount);
+    std::vector<UnsignedLong> edges;
+    std::vector<Collapse> collapses;
+    std::vector<bool> locked(vertexCount), touched(vertexCount);
+
+    /* Each pass collapses a set of independent edges in order of increasing
+       error, then the adjacency is rebuilt for the next pass */
+    while(result.size() > targetIndexCount) {
+        /* Vertex-triangle adjacency */
+        std::fill(triangleOffset.begin(), triangleOffset.end(), 0);
+        for(const UnsignedInt index: result) ++triangleOffset[index + 1];
+        for(std::size_t i = 0; i != vertexCount; ++i)
+            triangleOffset[i + 1] += triangleOffset[i];
+        triangles.resize(result.size());
+        {
+            std::vector<UnsignedInt> fill(triangleOffset.begin(), triangleOffset.end() - 1);
+            for(std::size_t i = 0; i != result.size(); ++i)
+                triangles[fill[result[i]]++] = i/3;
+        }
+
+        /* Vertices on edges without an opposite half-edge are on the
+           boundary and can't be moved */
+        edges.clear();
+        for(std::size_t i = 0; i != result.size(); i += 3)
+            for(std::size_t j = 0; j != 3; ++j)
+                edges.push_back(edgeKey(result[i + j], result[i + (j + 1)%3]));
+        std::sort(edges.begin(), edges.end());
+        std::fill(locked.begin(), locked.end(), false);
+        for(const UnsignedLong edge: edges) {
+            const UnsignedInt a = edge >> 32, b = edge & 0xffffffffu;
+            if(!std::binary_search(edges.begin(), edges.end(), edgeKey(b, a)))
+                locked[a] = locked[b] = true;
+        }
+
+        /* Cheaper direction of each interior edge. Every such edge is present
+           in both directions, take only one of them. */
+        collapses.clear();
+        for(const UnsignedLong edge: edges) {
+            const UnsignedInt a = edge >> 32, b = edge & 0xffffffffu;
+            if(a > b) continue;
+
+            Quadric q = quadrics[a];
+            q += quadrics[b];
+            const Float errorAB = locked[a] ? Constants::inf() : q.error(positions[b]);
+            const Float errorBA = locked[b] ? Constants::inf() : q.error(positions[a]);
+            if(errorAB == Constants::inf() && errorBA == Constants::inf()) continue;
+
+            if(errorAB <= errorBA) collapses.push_back({errorAB, a, b});
+            else collapses.push_back({errorBA, b, a});
+        }
+        std::sort(collapses.begin(), collapses.end(), [](const Collapse& a, const Collapse& b) {
+            return a.error < b.error;
+        });
+
+        /* Apply the collapses, each one removes two triangles */
+        for(std::size_t i = 0; i != vertexCount; ++i) remap[i] = i;
+        std::fill(touched.begin(), touched.end(), false);
+        const std::size_t trianglesToRemove = (result.size() - targetIndexCount + 2)/3;
+        std::size_t removedTriangles = 0;
+        for(const Collapse& collapse: collapses) {
+            if(collapse.error > maxSquaredError) break;
+            if(touched[collapse.from] || touched[collapse.to]) continue;
+
+            /* Reject collapses that would flip any of the remaining
+               triangles */
+            bool flips = false;
+            std::size_t collapsedTriangles = 0;
+            for(UnsignedInt j = triangleOffset[collapse.from]; j != triangleOffset[collapse.from + 1]; ++j) {
+                const UnsignedInt* const t = result.data() + triangles[j]*3;
+                if(t[0] == collapse.to || t[1] == collapse.to || t[2] == collapse.to) {
+                    ++collapsedTriangles;
+                    continue;
+                }
+
+                Vector3 p[3], q[3];
+                for(std::size_t k = 0; k != 3; ++k) {
+                    p[k] = positions[t[k]];
+                    q[k] = positions[t[k] == collapse.from ? collapse.to : t[k]];
+                }
+                if(Math::dot(Math::cross(p[1] - p[0], p[2] - p[0]), Math::cross(q[1] - q[0], q[2] - q[0])) <= 0.0f) {
+                    flips = true;
+                    break;
+                }
+            }
+            if(flips) continue;
+
+            /* Triangles around the collapsed vertex change, so lock all
+               their vertices for the rest of this pass */
+            for(UnsignedInt j = triangleOffset[collapse.from]; j != triangleOffset[collapse.from + 1]; ++j)
+                for(std::size_t k = 0; k != 3; ++k)
+                    touched[result[triangles[j]*3 + k]] = true;
+
+            remap[collapse.from] = collapse.to;
+            quadrics[collapse.to] += quadrics[collapse.from];
+            removedTriangles += collapsedTriangles;
+            if(removedTriangles >= trianglesToRemove) break;
+        }
+
+        /* Nothing more to collapse */
+        if(!removedTriangles) break;
+
+        /* Remap the indices and remove degenerate triangles */
+        std::size_t out = 0;
+        for(std::size_t i = 0; i != result.size(); i += 3) {
+            const UnsignedInt a = remap[result[i]], b = remap[result[i + 1]], c = remap[result[i + 2]];
+            if(a == b || b == c || a == c) continue;
+            result[out++] = a;
+            result[out++] = b;
+            result[out++] = c;
+        }
+        result.resize(out);
+    }
+
+    return result;
+}
+
+std::vector<std::pair<UnsignedInt, UnsignedInt>> generateLodChain(std::vector<UnsignedInt>& indices, const StridedArrayView<const Vector3> positions, const UnsignedInt levelCount, const Float ratio, const Float maxError) {
+    CORRADE_ASSERT(!(indices.size()%3), "MeshTools::generateLodChain(): index count is not divisible by 3!", {});
+    CORRADE_ASSERT(levelCount, "MeshTools::generateLodChain(): expected at least one level", {});
+    CORRADE_ASSERT(ratio > 0.0f && ratio < 1.0f, "MeshTools::generateLodChain(): expected ratio between 0 and 1 but got" << ratio, {});
+
+    std::vector<std::pair<UnsignedInt, UnsignedInt>> levels;
+    levels.reserve(levelCount);
+    levels.emplace_back(0, indices.size());
+
+    while(levels.size() < levelCount) {
+        const std::pair<UnsignedInt, UnsignedInt> previous = levels.back();
+        const std::size_t targetIndexCount = std::size_t(previous.second*ratio)/3*3;
+
+        /* The view is used only before the indices are modified below */
+        const std::vector<UnsignedInt> level = simplify({indices.data() + previous.first, previous.second}, positions, targetIndexCount, maxError);
+        if(level.empty() || level.size() == previous.second) break;
+
+        levels.emplace_back(indices.size(), level.size());
+        indices.insert(indices.end(), level.begin(), level.end());
+    }
+
+    return levels;
+}
+
+}}
@@ -0,0 +1,116 @@
+#ifndef Magnum_MeshTools_Simplify_h
+#define Magnum_MeshTools_Simplify_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::simplify(), @ref Magnum::MeshTools::generateLodChain()
+ */
+
+#include <utility>
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Constants.h"
+#include "Magnum/MeshTools/StridedArrayView.h"
+#include "Magnum/MeshTools/visibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Simplify the mesh
+@param indices          Triangle indices
+@param positions        Vertex positions
+@param targetIndexCount Index count to reduce the mesh to
+@param maxError         Maximal allowed error
+@return Indices of the simplified mesh, referencing the same vertex data
+
+Reduces the triangle count using iterative edge collapses ordered by
+quadric error metric, as described in *Michael Garland, Paul S. Heckbert ---
+Surface Simplification Using Quadric Error Metrics, SIGGRAPH 1997*. Each edge
+is collapsed into one of its endpoints, so the vertex data don't need to be
+modified and the result only references a subset of the original vertices.
+
+The collapsing stops when the index count drops to @p targetIndexCount or
+when the next collapse would introduce error larger than @p maxError, which
+is an approximate distance from the original surface in the same units as
+@p positions. Because of that, the resulting index count may be larger than
+requested.
+
+Vertices on mesh boundaries are never moved, and collapses that would flip
+orientation of any triangle are rejected. Note that vertices sharing the same
+position but differing in other attributes (i.e., texture seams) are treated
+as separate, so seams are kept intact as well. Use @ref removeDuplicates()
+beforehand to get rid of redundant vertices.
+
+@attention The function requires the mesh to have triangle faces, thus index
+    count must be divisible by 3.
+@see @ref generateLodChain(), @ref optimizeVertexCacheInPlace()
+*/
+std::vector<UnsignedInt> MAGNUM_MESHTOOLS_EXPORT simplify(Containers::ArrayView<const UnsignedInt> indices, StridedArrayView<const Vector3> positions, std::size_t targetIndexCount, Float maxError = Constants::inf());
+
+/**
+@brief Generate a LOD chain
+@param[in,out] indices  Triangle indices
+@param[in] positions    Vertex positions
+@param[in] levelCount   Count of levels including the original mesh
+@param[in] ratio        Index count ratio between two successive levels
+@param[in] maxError     Maximal allowed error of each level
+@return Offset and count of indices in @p indices for each level, first
+    being the original mesh
+
+Successively simplifies the mesh using @ref simplify(), each level
+starting from the previous one, and appends indices of each level to
+@p indices. All levels share the same vertex data, so they can be drawn
+from a single index and vertex buffer using @ref MeshView:
+
+@code{.cpp}
+std::vector<UnsignedInt> indices;
+std::vector<Vector3> positions;
+std::vector<std::pair<UnsignedInt, UnsignedInt>> lods =
+    MeshTools::generateLodChain(indices, positions, 4);
+
+// upload indices and positions to a mesh ...
+
+std::vector<MeshView> views;
+for(const std::pair<UnsignedInt, UnsignedInt>& lod: lods) {
+    views.emplace_back(mesh);
+    views.back().setIndexRange(lod.first)
+        .setCount(lod.second);
+}
+@endcode
+
+Generating stops early if a level can't be simplified further, so the
+returned array might be shorter than @p levelCount.
+
+@attention The function requires the mesh to have triangle faces, thus index
+    count must be divisible by 3.
+*/
+std::vector<std::pair<UnsignedInt, UnsignedInt>> MAGNUM_MESHTOOLS_EXPORT generateLodChain(std::vector<UnsignedInt>& indices, StridedArrayView<const Vector3> positions, UnsignedInt levelCount, Float ratio = 0.5f, Float maxError = Constants::inf());
+
+}}
+
+#endif
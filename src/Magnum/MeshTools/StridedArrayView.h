@@ -0,0 +1,113 @@
+#ifndef Magnum_MeshTools_StridedArrayView_h
+#define Magnum_MeshTools_StridedArrayView_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+/** @file
+ * @brief Class @ref Magnum::MeshTools::StridedArrayView
+ */
+
+#include <cstddef>
+#include <type_traits>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Magnum.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Strided array view
+
+Non-owning view on an array of @p T with arbitrary distance between the
+elements, used by MeshTools functions to read and write a single attribute
+of interleaved vertex data directly, for example in importer memory or in a
+mapped buffer, without copying it to a separate array first. Implicitly
+constructible from a contiguous @ref Corrade::Containers::ArrayView "Containers::ArrayView".
+
+@code{.cpp}
+struct Vertex {
+    Vector3 position;
+    Vector3 normal;
+};
+Containers::ArrayView<Vertex> vertices = ...;
+
+MeshTools::StridedArrayView<Vector3> normals{&vertices[0].normal,
+    vertices.size(), sizeof(Vertex)};
+MeshTools::flipNormalsInPlace(normals);
+@endcode
+*/
+template<class T> class StridedArrayView {
+    public:
+        typedef T Type;     /**< @brief Element type */
+
+        /** @brief Default constructor */
+        constexpr /*implicit*/ StridedArrayView(std::nullptr_t = nullptr) noexcept: _data{}, _size{}, _stride{sizeof(T)} {}
+
+        /**
+         * @brief Constructor
+         * @param data      Pointer to the first element
+         * @param size      Element count
+         * @param stride    Distance between the elements in bytes
+         */
+        constexpr explicit StridedArrayView(T* data, std::size_t size, std::size_t stride) noexcept: _data{data}, _size{size}, _stride{stride} {}
+
+        /** @brief Construct from a contiguous array view */
+        template<class U, class = typename std::enable_if<std::is_convertible<U*, T*>::value && sizeof(U) == sizeof(T)>::type> constexpr /*implicit*/ StridedArrayView(Containers::ArrayView<U> view) noexcept: _data{view.data()}, _size{view.size()}, _stride{sizeof(T)} {}
+
+        /** @brief Construct from a C array */
+        template<class U, std::size_t size, class = typename std::enable_if<std::is_convertible<U*, T*>::value && sizeof(U) == sizeof(T)>::type> constexpr /*implicit*/ StridedArrayView(U(&data)[size]) noexcept: _data{data}, _size{size}, _stride{sizeof(T)} {}
+
+        /** @brief Construct a const view from a mutable one */
+        template<class U, class = typename std::enable_if<std::is_same<const U, T>::value>::type> constexpr /*implicit*/ StridedArrayView(const StridedArrayView<U>& view) noexcept: _data{view.data()}, _size{view.size()}, _stride{view.stride()} {}
+
+        /** @brief Pointer to the first element */
+        constexpr T* data() const { return _data; }
+
+        /** @brief Element count */
+        constexpr std::size_t size() const { return _size; }
+
+        /** @brief Distance between the elements in bytes */
+        constexpr std::size_t stride() const { return _stride; }
+
+        /** @brief Whether the view is empty */
+        constexpr bool empty() const { return !_size; }
+
+        /** @brief Element access */
+        T& operator[](const std::size_t i) const {
+            CORRADE_ASSERT(i < _size, "MeshTools::StridedArrayView::operator[](): index" << i << "out of range for" << _size << "elements", *_data);
+            return *reinterpret_cast<T*>(reinterpret_cast<typename std::conditional<std::is_const<T>::value, const char, char>::type*>(_data) + i*_stride);
+        }
+
+    private:
+        T* _data;
+        std::size_t _size, _stride;
+};
+
+}}
+
+#endif
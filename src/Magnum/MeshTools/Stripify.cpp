@@ -0,0 +1,118 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Stripify.h"
+
+#include <unordered_map>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+inline UnsignedLong edgeKey(const UnsignedInt from, const UnsignedInt to) {
+    return UnsignedLong(from) << 32 | to;
+}
+
+}
+
+std::vector<UnsignedInt> stripify(const std::vector<UnsignedInt>& indices, const UnsignedInt primitiveRestartIndex) {
+    CORRADE_ASSERT(indices.size()%3 == 0,
+        "MeshTools::stripify(): index count not divisible by 3", {});
+
+    /* Triangle containing given directed edge. The triangle on the other side
+       of an edge from a to b is the one containing the edge from b to a. For
+       non-manifold edges only the first triangle is remembered, the others
+       just won't be reachable from their neighbors. */
+    const std::size_t triangleCount = indices.size()/3;
+    std::unordered_map<UnsignedLong, UnsignedInt> edges;
+    edges.reserve(indices.size());
+    for(std::size_t i = 0; i != triangleCount; ++i) {
+        for(std::size_t j = 0; j != 3; ++j) {
+            CORRADE_ASSERT(indices[i*3 + j] != primitiveRestartIndex,
+                "MeshTools::stripify(): index" << i*3 + j << "is equal to the primitive restart index", {});
+            edges.emplace(edgeKey(indices[i*3 + j], indices[i*3 + (j + 1)%3]), i);
+        }
+    }
+
+    std::vector<bool> emitted(triangleCount);
+
+    /* Not yet emitted triangle on the other side of given directed edge or
+       triangleCount if there's none. Returns also the vertex opposite to the
+       edge. */
+    auto neighbor = [&](const UnsignedInt from, const UnsignedInt to, UnsignedInt& opposite) -> std::size_t {
+        auto found = edges.find(edgeKey(to, from));
+        if(found == edges.end() || emitted[found->second]) return triangleCount;
+
+        const UnsignedInt* const triangle = indices.data() + found->second*3;
+        for(std::size_t j = 0; j != 3; ++j) if(triangle[j] == to) {
+            opposite = triangle[(j + 2)%3];
+            break;
+        }
+        return found->second;
+    };
+
+    std::vector<UnsignedInt> out;
+    out.reserve(indices.size() + triangleCount);
+    for(std::size_t start = 0; start != triangleCount; ++start) {
+        if(emitted[start]) continue;
+
+        /* Pick a rotation of the first triangle that allows the strip to
+           continue over its last edge */
+        const UnsignedInt* const triangle = indices.data() + start*3;
+        std::size_t rotation = 0;
+        UnsignedInt opposite{};
+        emitted[start] = true;
+        for(std::size_t j = 0; j != 3; ++j) {
+            if(neighbor(triangle[(j + 1)%3], triangle[(j + 2)%3], opposite) != triangleCount) {
+                rotation = j;
+                break;
+            }
+        }
+
+        if(!out.empty()) out.push_back(primitiveRestartIndex);
+        out.push_back(triangle[rotation]);
+        out.push_back(triangle[(rotation + 1)%3]);
+        out.push_back(triangle[(rotation + 2)%3]);
+
+        /* Odd triangles in a strip have their first two vertices swapped, so
+           the shared edge has to be looked up in the opposite direction to
+           preserve winding */
+        for(bool odd = true; ; odd = !odd) {
+            const UnsignedInt a = out[out.size() - 2];
+            const UnsignedInt b = out.back();
+            const std::size_t next = odd ? neighbor(a, b, opposite) : neighbor(b, a, opposite);
+            if(next == triangleCount) break;
+
+            emitted[next] = true;
+            out.push_back(opposite);
+        }
+    }
+
+    return out;
+}
+
+}}
@@ -0,0 +1,82 @@
+#ifndef Magnum_MeshTools_Stripify_h
+#define Magnum_MeshTools_Stripify_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::stripify()
+ */
+
+#include <vector>
+
+#include "Magnum/Types.h"
+#include "Magnum/MeshTools/visibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Convert a triangle list to triangle strips
+@param indices                  Triangle indices
+@param primitiveRestartIndex    Index separating the strips
+
+Greedily joins adjacent triangles into strips and returns indices of all strips
+concatenated, separated by @p primitiveRestartIndex. The result is meant to be
+drawn as @ref MeshPrimitive::TriangleStrip with
+@ref Renderer::Feature::PrimitiveRestartFixedIndex enabled. Winding of all
+triangles is preserved. New strips are started in the order in which the
+triangles appear in @p indices, so run @ref optimizeVertexCacheInPlace() or
+@ref tipsify() first to have the strips cache-friendly as well.
+
+The restart index should be the maximal value of the index type used for
+drawing, see @ref Mesh::primitiveRestartIndex(). If the mesh has less than
+65535 vertices, use the @ref Mesh::IndexType::UnsignedShort restart index so
+@ref compressIndices() can pack the result to 16-bit indices:
+
+@code{.cpp}
+indices = MeshTools::stripify(indices,
+    Mesh::primitiveRestartIndex(Mesh::IndexType::UnsignedShort));
+
+Containers::Array<char> indexData;
+Mesh::IndexType indexType;
+UnsignedInt indexStart, indexEnd;
+std::tie(indexData, indexType, indexStart, indexEnd) =
+    MeshTools::compressIndices(indices);
+indexBuffer.setData(indexData, BufferUsage::StaticDraw);
+
+Renderer::enable(Renderer::Feature::PrimitiveRestartFixedIndex);
+mesh.setPrimitive(MeshPrimitive::TriangleStrip)
+    .setCount(indices.size())
+    .setIndexBuffer(indexBuffer, 0, indexType, indexStart, indexEnd);
+@endcode
+
+@attention The function requires the mesh to have triangle faces, thus index
+    count must be divisible by 3. None of the indices can be equal to
+    @p primitiveRestartIndex.
+*/
+MAGNUM_MESHTOOLS_EXPORT std::vector<UnsignedInt> stripify(const std::vector<UnsignedInt>& indices, UnsignedInt primitiveRestartIndex);
+
+}}
+
+#endif
@@ -26,12 +26,16 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::MeshTools::subdivide()
+ * @brief Function @ref Magnum::MeshTools::subdivide(), @ref Magnum::MeshTools::subdivideShared()
  */
 
 #include <vector>
+#include <Corrade/Utility/Assert.h>
 #include <Corrade/Utility/Debug.h>
 
+#include "Magnum/Types.h"
+#include "Magnum/MeshTools/duplicateTable.h"
+
 namespace Magnum { namespace MeshTools {
 
 namespace Implementation {
@@ -71,11 +75,71 @@ template<class Vertex, class Interpolator> class Subdivide {
 
 Goes through all triangle faces and subdivides them into four new. Removing
 duplicate vertices in the mesh is up to user.
+@see @ref subdivideShared()
 */
 template<class Vertex, class Interpolator> inline void subdivide(std::vector<UnsignedInt>& indices, std::vector<Vertex>& vertices, Interpolator interpolator) {
     Implementation::Subdivide<Vertex, Interpolator>(indices, vertices)(interpolator);
 }
 
+/**
+@brief Subdivide the mesh, sharing vertices on common edges
+@tparam Vertex          Vertex data type
+@tparam Interpolator    See `interpolator` function parameter
+@param[in,out] indices  Index array to operate on
+@param[in,out] vertices Vertex array to operate on
+@param interpolator     Functor or function pointer which interpolates
+    two adjacent vertices: `Vertex interpolator(Vertex a, Vertex b)`
+
+Same as @ref subdivide(), but remembers the vertex created for each edge and
+reuses it for the adjacent face instead of creating a new one. If the input
+mesh doesn't contain any duplicate vertices, neither does the output, so there
+is no need to call @ref removeDuplicates() afterwards. Edges are identified by
+indices of their endpoints regardless of their direction, so the result is
+watertight only if the faces sharing an edge reference the same vertices.
+Compared to @ref subdivide() the new vertices are ordered by first occurence of
+their edge. The @p interpolator is called only once for each edge, with
+vertices in order of the first face referencing it.
+*/
+template<class Vertex, class Interpolator> void subdivideShared(std::vector<UnsignedInt>& indices, std::vector<Vertex>& vertices, Interpolator interpolator) {
+    CORRADE_ASSERT(!(indices.size()%3), "MeshTools::subdivideShared(): index count is not divisible by 3!", );
+
+    const std::size_t indexCount = indices.size();
+    indices.reserve(indexCount*4);
+
+    /* A closed mesh has 1.5 edges per face, i.e. half the index count. The
+       table maps an edge to the vertex created for it. The hash is a
+       bijection of the edge, so equal hashes mean equal edges. */
+    Implementation::DuplicateTable edgeVertices{indexCount/2};
+    vertices.reserve(vertices.size() + indexCount/2);
+
+    for(std::size_t i = 0; i != indexCount; i += 3) {
+        UnsignedInt newVertices[3];
+        for(int j = 0; j != 3; ++j) {
+            const UnsignedInt a = indices[i+j];
+            const UnsignedInt b = indices[i+(j+1)%3];
+            const UnsignedLong edge = a < b ?
+                (UnsignedLong(a) << 32)|b : (UnsignedLong(b) << 32)|a;
+            const UnsignedInt vertex = vertices.size();
+            newVertices[j] = edgeVertices.findOrInsert(Implementation::hashMix(edge), vertex, [](UnsignedInt) { return true; });
+            if(newVertices[j] == vertex)
+                vertices.push_back(interpolator(vertices[a], vertices[b]));
+        }
+
+        /* Same face layout as in subdivide() */
+        indices.push_back(indices[i]);
+        indices.push_back(newVertices[0]);
+        indices.push_back(newVertices[2]);
+        indices.push_back(newVertices[0]);
+        indices.push_back(indices[i+1]);
+        indices.push_back(newVertices[1]);
+        indices.push_back(newVertices[2]);
+        indices.push_back(newVertices[1]);
+        indices.push_back(indices[i+2]);
+        for(std::size_t j = 0; j != 3; ++j)
+            indices[i+j] = newVertices[j];
+    }
+}
+
 namespace Implementation {
 
 template<class Vertex, class Interpolator> void Subdivide<Vertex, Interpolator>::operator()(Interpolator interpolator) {
@@ -0,0 +1,240 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <vector>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/ThreadPool.h"
+#include "Magnum/MeshTools/Bounds.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+struct BoundsTest: TestSuite::Tester {
+    explicit BoundsTest();
+
+    void bounds();
+    void boundsRemainder();
+    void boundsStrided();
+    void boundsEmpty();
+    void boundsParallel();
+    void bounds2D();
+
+    void mortonCode();
+    void mortonCodesInto();
+    void mortonCodesIntoFlat();
+    void mortonCodesIntoParallel();
+    void mortonCodesIntoWrongSize();
+};
+
+BoundsTest::BoundsTest() {
+    addTests({&BoundsTest::bounds,
+              &BoundsTest::boundsRemainder,
+              &BoundsTest::boundsStrided,
+              &BoundsTest::boundsEmpty,
+              &BoundsTest::boundsParallel,
+              &BoundsTest::bounds2D,
+
+              &BoundsTest::mortonCode,
+              &BoundsTest::mortonCodesInto,
+              &BoundsTest::mortonCodesIntoFlat,
+              &BoundsTest::mortonCodesIntoParallel,
+              &BoundsTest::mortonCodesIntoWrongSize});
+}
+
+namespace {
+
+/* Deterministic pseudo-random points, with each component being the extreme
+   in a different point */
+std::vector<Vector3> points(std::size_t count) {
+    std::vector<Vector3> out;
+    out.reserve(count);
+    UnsignedInt seed = 17;
+    for(std::size_t i = 0; i != count; ++i) {
+        Vector3 point;
+        for(std::size_t j = 0; j != 3; ++j) {
+            seed = seed*1103515245u + 12345u;
+            point[j] = Float((seed >> 16) & 0x7fff)/327.67f - 50.0f;
+        }
+        out.push_back(point);
+    }
+    return out;
+}
+
+Range3D naiveBounds(const std::vector<Vector3>& points) {
+    Vector3 min = points[0], max = points[0];
+    for(const Vector3& point: points) {
+        min = Math::min(min, point);
+        max = Math::max(max, point);
+    }
+    return {min, max};
+}
+
+}
+
+void BoundsTest::bounds() {
+    const Vector3 positions[]{
+        {1.0f, -2.0f, 3.0f},
+        {-4.0f, 5.0f, 0.5f},
+        {0.0f, 0.0f, -6.0f},
+        {2.5f, 1.0f, 1.0f},
+        {0.5f, 7.0f, 2.0f},
+        {-1.0f, -3.0f, 8.0f},
+        {0.0f, 0.0f, 0.0f},
+        {3.0f, 1.0f, 1.0f}
+    };
+
+    CORRADE_COMPARE(MeshTools::bounds(Containers::arrayView(positions)),
+        (Range3D{{-4.0f, -3.0f, -6.0f}, {3.0f, 7.0f, 8.0f}}));
+}
+
+void BoundsTest::boundsRemainder() {
+    /* Extremes in the part that isn't processed four points at a time */
+    std::vector<Vector3> positions = points(39);
+    positions[37] = Vector3{-100.0f};
+    positions[38] = Vector3{100.0f};
+
+    CORRADE_COMPARE(MeshTools::bounds(Containers::arrayView(positions.data(), positions.size())), (Range3D{Vector3{-100.0f}, Vector3{100.0f}}));
+
+    /* Single point */
+    CORRADE_COMPARE(MeshTools::bounds(Containers::arrayView(&positions[5], 1)),
+        (Range3D{positions[5], positions[5]}));
+}
+
+void BoundsTest::boundsStrided() {
+    struct Vertex {
+        Vector3 position;
+        Vector3 normal;
+    } vertices[]{
+        {{1.0f, -2.0f, 3.0f}, Vector3{1000.0f}},
+        {{-4.0f, 5.0f, 0.5f}, Vector3{-1000.0f}},
+        {{0.0f, 0.0f, -6.0f}, {}},
+        {{2.5f, 1.0f, 1.0f}, {}},
+        {{0.5f, 7.0f, 2.0f}, {}}
+    };
+
+    CORRADE_COMPARE(MeshTools::bounds(StridedArrayView<const Vector3>{&vertices[0].position, 5, sizeof(Vertex)}),
+        (Range3D{{-4.0f, -2.0f, -6.0f}, {2.5f, 7.0f, 3.0f}}));
+}
+
+void BoundsTest::boundsEmpty() {
+    CORRADE_COMPARE(MeshTools::bounds(StridedArrayView<const Vector3>{}), Range3D{});
+    CORRADE_COMPARE(MeshTools::bounds(StridedArrayView<const Vector2>{}), Range2D{});
+}
+
+void BoundsTest::boundsParallel() {
+    /* Enough points to be split into multiple chunks */
+    const std::vector<Vector3> positions = points(100003);
+
+    ThreadPool pool{4};
+    const Range3D expected = naiveBounds(positions);
+    CORRADE_COMPARE(MeshTools::bounds(Containers::arrayView(positions.data(), positions.size()), pool), expected);
+    CORRADE_COMPARE(MeshTools::bounds(Containers::arrayView(positions.data(), positions.size())), expected);
+}
+
+void BoundsTest::bounds2D() {
+    const Vector2 positions[]{
+        {1.0f, -2.0f},
+        {-4.0f, 5.0f},
+        {0.5f, 0.0f}
+    };
+
+    CORRADE_COMPARE(MeshTools::bounds(Containers::arrayView(positions)),
+        (Range2D{{-4.0f, -2.0f}, {1.0f, 5.0f}}));
+}
+
+void BoundsTest::mortonCode() {
+    CORRADE_COMPARE(MeshTools::mortonCode({0, 0, 0}), 0);
+    CORRADE_COMPARE(MeshTools::mortonCode({1, 0, 0}), 4);
+    CORRADE_COMPARE(MeshTools::mortonCode({0, 1, 0}), 2);
+    CORRADE_COMPARE(MeshTools::mortonCode({0, 0, 1}), 1);
+    CORRADE_COMPARE(MeshTools::mortonCode({1, 2, 3}), 0x1d);
+    CORRADE_COMPARE(MeshTools::mortonCode({1023, 1023, 1023}), 0x3fffffff);
+
+    /* Bits above the lower ten are ignored */
+    CORRADE_COMPARE(MeshTools::mortonCode({1024 + 1, 0, 0}), 4);
+}
+
+void BoundsTest::mortonCodesInto() {
+    const Vector3 positions[]{
+        {-1.0f, 0.0f, 2.0f},
+        {1.0f, 4.0f, 6.0f},
+        {0.0f, 2.0f, 4.0f},
+        /* Outside of the bounds, clamped */
+        {5.0f, -3.0f, 4.0f}
+    };
+    const Range3D bounds{{-1.0f, 0.0f, 2.0f}, {1.0f, 4.0f, 6.0f}};
+
+    UnsignedInt out[4];
+    MeshTools::mortonCodesInto(positions, bounds, out);
+    CORRADE_COMPARE(out[0], 0);
+    CORRADE_COMPARE(out[1], 0x3fffffff);
+    CORRADE_COMPARE(out[2], MeshTools::mortonCode({511, 511, 511}));
+    CORRADE_COMPARE(out[3], MeshTools::mortonCode({1023, 0, 511}));
+}
+
+void BoundsTest::mortonCodesIntoFlat() {
+    /* Zero size in Y shouldn't cause any division by zero */
+    const Vector3 positions[]{
+        {0.0f, 1.0f, 0.0f},
+        {1.0f, 1.0f, 1.0f}
+    };
+
+    UnsignedInt out[2];
+    MeshTools::mortonCodesInto(positions, MeshTools::bounds(Containers::arrayView(positions)), out);
+    CORRADE_COMPARE(out[0], 0);
+    CORRADE_COMPARE(out[1], MeshTools::mortonCode({1023, 0, 1023}));
+}
+
+void BoundsTest::mortonCodesIntoParallel() {
+    const std::vector<Vector3> positions = points(50001);
+    const Containers::ArrayView<const Vector3> view{positions.data(), positions.size()};
+    const Range3D bounds = MeshTools::bounds(view);
+
+    std::vector<UnsignedInt> serial(positions.size()), parallel(positions.size());
+    MeshTools::mortonCodesInto(view, bounds, Containers::arrayView(serial.data(), serial.size()));
+
+    ThreadPool pool{4};
+    MeshTools::mortonCodesInto(view, bounds, Containers::arrayView(parallel.data(), parallel.size()), pool);
+    CORRADE_VERIFY(serial == parallel);
+}
+
+void BoundsTest::mortonCodesIntoWrongSize() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const Vector3 positions[3]{};
+    UnsignedInt out[2];
+
+    std::ostringstream messages;
+    Error redirectError{&messages};
+    MeshTools::mortonCodesInto(positions, {}, out);
+    CORRADE_COMPARE(messages.str(), "MeshTools::mortonCodesInto(): expected output size 3 but got 2\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::BoundsTest)
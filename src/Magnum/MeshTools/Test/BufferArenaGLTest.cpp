@@ -0,0 +1,283 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+
+#include "Magnum/Mesh.h"
+#include "Magnum/OpenGLTester.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/BufferArena.h"
+#include "Magnum/MeshTools/Compile.h"
+#include "Magnum/Trade/MeshData3D.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+struct BufferArenaGLTest: OpenGLTester {
+    explicit BufferArenaGLTest();
+
+    void construct();
+    void constructNoIndices();
+
+    void allocate();
+    void allocateAligned();
+    void allocateBestFit();
+    void allocateNotEnoughSpace();
+    void allocateIndicesNotEnoughSpace();
+    void free();
+    void freeMerge();
+
+    void compile();
+    void compileIndexed();
+    void compileNotEnoughSpace();
+};
+
+BufferArenaGLTest::BufferArenaGLTest() {
+    addTests({&BufferArenaGLTest::construct,
+              &BufferArenaGLTest::constructNoIndices,
+
+              &BufferArenaGLTest::allocate,
+              &BufferArenaGLTest::allocateAligned,
+              &BufferArenaGLTest::allocateBestFit,
+              &BufferArenaGLTest::allocateNotEnoughSpace,
+              &BufferArenaGLTest::allocateIndicesNotEnoughSpace,
+              &BufferArenaGLTest::free,
+              &BufferArenaGLTest::freeMerge,
+
+              &BufferArenaGLTest::compile,
+              &BufferArenaGLTest::compileIndexed,
+              &BufferArenaGLTest::compileNotEnoughSpace});
+}
+
+void BufferArenaGLTest::construct() {
+    BufferArena arena{1024, 256};
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(arena.vertexBuffer().id() > 0);
+    CORRADE_VERIFY(arena.indexBuffer().id() > 0);
+    CORRADE_COMPARE(arena.vertexCapacity(), 1024);
+    CORRADE_COMPARE(arena.indexCapacity(), 256);
+    CORRADE_COMPARE(arena.vertexUsage(), 0);
+    CORRADE_COMPARE(arena.indexUsage(), 0);
+    CORRADE_COMPARE(arena.vertexBuffer().size(), 1024);
+    CORRADE_COMPARE(arena.indexBuffer().size(), 256);
+}
+
+void BufferArenaGLTest::constructNoIndices() {
+    BufferArena arena{1024, 0};
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(arena.indexCapacity(), 0);
+    CORRADE_VERIFY(arena.allocate(16, 4));
+    CORRADE_VERIFY(!arena.allocate(16, 4, 6, 2));
+}
+
+void BufferArenaGLTest::allocate() {
+    BufferArena arena{1024, 256};
+
+    Containers::Optional<BufferArena::Allocation> a = arena.allocate(100, 4, 30, 2);
+    Containers::Optional<BufferArena::Allocation> b = arena.allocate(200, 4);
+    CORRADE_VERIFY(a);
+    CORRADE_VERIFY(b);
+    CORRADE_COMPARE(a->vertexOffset, 0);
+    CORRADE_COMPARE(a->vertexSize, 100);
+    CORRADE_COMPARE(a->indexOffset, 0);
+    CORRADE_COMPARE(a->indexSize, 30);
+    CORRADE_COMPARE(b->vertexOffset, 100);
+    CORRADE_COMPARE(b->indexSize, 0);
+    CORRADE_COMPARE(arena.vertexUsage(), 300);
+    CORRADE_COMPARE(arena.indexUsage(), 30);
+}
+
+void BufferArenaGLTest::allocateAligned() {
+    BufferArena arena{1024, 256};
+
+    CORRADE_VERIFY(arena.allocate(10, 1, 3, 1));
+
+    /* Alignment doesn't need to be a power of two */
+    Containers::Optional<BufferArena::Allocation> a = arena.allocate(24, 12, 4, 4);
+    CORRADE_VERIFY(a);
+    CORRADE_COMPARE(a->vertexOffset, 12);
+    CORRADE_COMPARE(a->indexOffset, 4);
+
+    /* The padding is available for allocation again */
+    Containers::Optional<BufferArena::Allocation> b = arena.allocate(2, 1, 1, 1);
+    CORRADE_VERIFY(b);
+    CORRADE_COMPARE(b->vertexOffset, 10);
+    CORRADE_COMPARE(b->indexOffset, 3);
+
+    /* Padding is not counted as usage */
+    CORRADE_COMPARE(arena.vertexUsage(), 36);
+    CORRADE_COMPARE(arena.indexUsage(), 8);
+}
+
+void BufferArenaGLTest::allocateBestFit() {
+    BufferArena arena{1024, 0};
+
+    Containers::Optional<BufferArena::Allocation> a = arena.allocate(100, 4);
+    CORRADE_VERIFY(arena.allocate(100, 4));
+    Containers::Optional<BufferArena::Allocation> c = arena.allocate(40, 4);
+    CORRADE_VERIFY(arena.allocate(100, 4));
+    CORRADE_VERIFY(a);
+    CORRADE_VERIFY(c);
+
+    /* Free ranges of 100 and 40 bytes and the 684-byte remainder */
+    arena.free(*a);
+    arena.free(*c);
+
+    /* The smallest range that fits is picked */
+    Containers::Optional<BufferArena::Allocation> d = arena.allocate(32, 4);
+    CORRADE_VERIFY(d);
+    CORRADE_COMPARE(d->vertexOffset, 200);
+    Containers::Optional<BufferArena::Allocation> e = arena.allocate(64, 4);
+    CORRADE_VERIFY(e);
+    CORRADE_COMPARE(e->vertexOffset, 0);
+}
+
+void BufferArenaGLTest::allocateNotEnoughSpace() {
+    BufferArena arena{1024, 256};
+
+    CORRADE_VERIFY(arena.allocate(1000, 4));
+    CORRADE_VERIFY(!arena.allocate(32, 4));
+    CORRADE_COMPARE(arena.vertexUsage(), 1000);
+}
+
+void BufferArenaGLTest::allocateIndicesNotEnoughSpace() {
+    BufferArena arena{1024, 256};
+
+    /* Vertex allocation is undone if indices don't fit */
+    CORRADE_VERIFY(!arena.allocate(512, 4, 512, 2));
+    CORRADE_COMPARE(arena.vertexUsage(), 0);
+    CORRADE_COMPARE(arena.indexUsage(), 0);
+
+    Containers::Optional<BufferArena::Allocation> a = arena.allocate(1024, 4);
+    CORRADE_VERIFY(a);
+    CORRADE_COMPARE(a->vertexOffset, 0);
+}
+
+void BufferArenaGLTest::free() {
+    BufferArena arena{1024, 256};
+
+    Containers::Optional<BufferArena::Allocation> a = arena.allocate(1024, 4, 256, 4);
+    CORRADE_VERIFY(a);
+    CORRADE_VERIFY(!arena.allocate(16, 4));
+
+    arena.free(*a);
+    CORRADE_COMPARE(arena.vertexUsage(), 0);
+    CORRADE_COMPARE(arena.indexUsage(), 0);
+    CORRADE_VERIFY(arena.allocate(1024, 4, 256, 4));
+}
+
+void BufferArenaGLTest::freeMerge() {
+    BufferArena arena{300, 0};
+
+    Containers::Optional<BufferArena::Allocation> a = arena.allocate(100, 4);
+    Containers::Optional<BufferArena::Allocation> b = arena.allocate(100, 4);
+    Containers::Optional<BufferArena::Allocation> c = arena.allocate(100, 4);
+    CORRADE_VERIFY(a && b && c);
+
+    /* Freeing the outer ones doesn't make a contiguous range */
+    arena.free(*a);
+    arena.free(*c);
+    CORRADE_VERIFY(!arena.allocate(200, 4));
+
+    /* Freeing the middle merges all three together */
+    arena.free(*b);
+    Containers::Optional<BufferArena::Allocation> d = arena.allocate(300, 4);
+    CORRADE_VERIFY(d);
+    CORRADE_COMPARE(d->vertexOffset, 0);
+}
+
+namespace {
+
+const Trade::MeshData3D Triangle{MeshPrimitive::Triangles, {}, {{
+    {-1.0f, -1.0f, 0.0f}, {1.0f, -1.0f, 0.0f}, {0.0f, 1.0f, 0.0f}
+}}, {}, {}, {}};
+
+const Trade::MeshData3D IndexedQuad{MeshPrimitive::Triangles, {0, 1, 2, 0, 2, 3}, {{
+    {-1.0f, -1.0f, 0.0f}, {1.0f, -1.0f, 0.0f}, {1.0f, 1.0f, 0.0f}, {-1.0f, 1.0f, 0.0f}
+}}, {}, {}, {}};
+
+}
+
+void BufferArenaGLTest::compile() {
+    BufferArena arena{1024, 256};
+
+    Mesh a{NoCreate}, b{NoCreate};
+    BufferArena::Allocation allocationA, allocationB;
+    std::tie(a, allocationA) = std::move(*MeshTools::compile(Triangle, arena));
+    std::tie(b, allocationB) = std::move(*MeshTools::compile(Triangle, arena));
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(!a.isIndexed());
+    CORRADE_COMPARE(a.count(), 3);
+    CORRADE_COMPARE(allocationA.vertexSize, 3*12);
+    CORRADE_COMPARE(allocationA.indexSize, 0);
+    CORRADE_COMPARE(allocationB.vertexOffset, 3*12);
+
+    /* Non-indexed meshes are addressed using base vertex */
+    CORRADE_COMPARE(a.baseVertex(), 0);
+    CORRADE_COMPARE(b.baseVertex(), 3);
+    CORRADE_COMPARE(arena.vertexUsage(), 2*3*12);
+
+    arena.free(allocationA);
+    arena.free(allocationB);
+    CORRADE_COMPARE(arena.vertexUsage(), 0);
+}
+
+void BufferArenaGLTest::compileIndexed() {
+    BufferArena arena{1024, 256};
+
+    CORRADE_VERIFY(arena.allocate(4, 4, 1, 1));
+
+    Mesh mesh{NoCreate};
+    BufferArena::Allocation allocation;
+    std::tie(mesh, allocation) = std::move(*MeshTools::compile(IndexedQuad, arena));
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(mesh.isIndexed());
+    CORRADE_COMPARE(mesh.count(), 6);
+
+    /* Aligned to the stride and to the (byte) index type */
+    CORRADE_COMPARE(allocation.vertexOffset, 12);
+    CORRADE_COMPARE(allocation.vertexSize, 4*12);
+    CORRADE_COMPARE(allocation.indexOffset, 1);
+    CORRADE_COMPARE(allocation.indexSize, 6);
+    CORRADE_COMPARE(arena.indexUsage(), 1 + 6);
+}
+
+void BufferArenaGLTest::compileNotEnoughSpace() {
+    BufferArena arena{16, 256};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!MeshTools::compile(Triangle, arena));
+    CORRADE_COMPARE(out.str(), "MeshTools::compile(): not enough space in the arena for 36 bytes of vertex data and 0 bytes of index data\n");
+    CORRADE_COMPARE(arena.vertexUsage(), 0);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::BufferArenaGLTest)
@@ -0,0 +1,302 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstring>
+#include <sstream>
+#include <vector>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+
+#include "Magnum/MeshTools/Codec.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+struct CodecTest: TestSuite::Tester {
+    explicit CodecTest();
+
+    void vertex();
+    void vertexSmallDifferences();
+    void vertexEmpty();
+    void vertexInto();
+    void vertexIntoWrongSize();
+    void vertexWrongStride();
+    void vertexInvalid();
+
+    void index();
+    void indexEscaped();
+    void indexEmpty();
+    void indexInto();
+    void indexIntoWrongSize();
+    void indexInvalid();
+};
+
+CodecTest::CodecTest() {
+    addTests({&CodecTest::vertex,
+              &CodecTest::vertexSmallDifferences,
+              &CodecTest::vertexEmpty,
+              &CodecTest::vertexInto,
+              &CodecTest::vertexIntoWrongSize,
+              &CodecTest::vertexWrongStride,
+              &CodecTest::vertexInvalid,
+
+              &CodecTest::index,
+              &CodecTest::indexEscaped,
+              &CodecTest::indexEmpty,
+              &CodecTest::indexInto,
+              &CodecTest::indexIntoWrongSize,
+              &CodecTest::indexInvalid});
+}
+
+namespace {
+
+/* Vertex data with differences between neighbors of varying magnitude,
+   including ones that don't fit into 8 bits */
+std::vector<char> vertexData(const std::size_t stride, const std::size_t vertexCount) {
+    std::vector<char> data(stride*vertexCount);
+    for(std::size_t i = 0; i != vertexCount; ++i)
+        for(std::size_t j = 0; j != stride; ++j)
+            data[i*stride + j] = char(i*(j + 1)/3 + (i*j % 5)*(j % 3 ? 1 : 37));
+    return data;
+}
+
+/* Indices of a triangulated grid, consecutive quads share an edge */
+std::vector<UnsignedInt> gridIndices(const UnsignedInt size) {
+    std::vector<UnsignedInt> indices;
+    for(UnsignedInt y = 0; y != size; ++y) for(UnsignedInt x = 0; x != size; ++x) {
+        const UnsignedInt a = y*(size + 1) + x;
+        indices.insert(indices.end(), {a, a + size + 1, a + 1,
+                                       a + 1, a + size + 1, a + size + 2});
+    }
+    return indices;
+}
+
+}
+
+void CodecTest::vertex() {
+    /* Various strides and counts, including partial groups and blocks */
+    for(std::size_t stride: {1, 3, 12, 32, 255, 256}) {
+        for(std::size_t vertexCount: {1, 15, 17, 300, 2000}) {
+            const std::vector<char> data = vertexData(stride, vertexCount);
+            const Containers::Array<char> encoded = encodeVertexBuffer({data.data(), data.size()}, stride);
+
+            /* Never much larger than the input */
+            CORRADE_VERIFY(encoded.size() <= 6 + stride + data.size() + data.size()/32);
+
+            Containers::Optional<Containers::Array<char>> decoded = decodeVertexBuffer(encoded);
+            CORRADE_VERIFY(decoded);
+            CORRADE_COMPARE_AS(std::vector<char>(decoded->begin(), decoded->end()),
+                data, TestSuite::Compare::Container);
+        }
+    }
+}
+
+void CodecTest::vertexSmallDifferences() {
+    /* A slowly changing 16-bit value and a constant, as with quantized
+       positions of neighboring vertices */
+    std::vector<UnsignedShort> data;
+    for(UnsignedShort i = 0; i != 1024; ++i) {
+        data.push_back(i*3);
+        data.push_back(0);
+    }
+
+    const Containers::Array<char> encoded = encodeVertexBuffer({reinterpret_cast<const char*>(data.data()), data.size()*2}, 4);
+
+    /* Group codes, at most 4 bits for the low byte, at most 2 bits for the
+       high byte and nothing for the constant */
+    CORRADE_VERIFY(encoded.size() <= 6 + 4*(1024/16/4) + 1024/2 + 1024/4);
+
+    Containers::Optional<Containers::Array<char>> decoded = decodeVertexBuffer(encoded);
+    CORRADE_VERIFY(decoded);
+    CORRADE_COMPARE(decoded->size(), data.size()*2);
+    std::vector<UnsignedShort> out(data.size());
+    std::memcpy(out.data(), decoded->data(), decoded->size());
+    CORRADE_COMPARE_AS(out, data, TestSuite::Compare::Container);
+}
+
+void CodecTest::vertexEmpty() {
+    const Containers::Array<char> encoded = encodeVertexBuffer(nullptr, 7);
+    CORRADE_COMPARE(encoded.size(), 6);
+
+    Containers::Optional<Containers::Array<char>> decoded = decodeVertexBuffer(encoded);
+    CORRADE_VERIFY(decoded);
+    CORRADE_VERIFY(decoded->empty());
+}
+
+void CodecTest::vertexInto() {
+    const std::vector<char> data = vertexData(12, 100);
+    const Containers::Array<char> encoded = encodeVertexBuffer({data.data(), data.size()}, 12);
+
+    std::vector<char> out(data.size());
+    CORRADE_VERIFY(decodeVertexBufferInto(encoded, {out.data(), out.size()}));
+    CORRADE_COMPARE_AS(out, data, TestSuite::Compare::Container);
+}
+
+void CodecTest::vertexIntoWrongSize() {
+    const std::vector<char> data = vertexData(12, 100);
+    const Containers::Array<char> encoded = encodeVertexBuffer({data.data(), data.size()}, 12);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    std::vector<char> decoded(data.size() - 12);
+    CORRADE_VERIFY(!decodeVertexBufferInto(encoded, {decoded.data(), decoded.size()}));
+    CORRADE_COMPARE(out.str(), "MeshTools::decodeVertexBufferInto(): expected output size 1200 but got 1188\n");
+}
+
+void CodecTest::vertexWrongStride() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    const char data[12]{};
+    encodeVertexBuffer(data, 0);
+    encodeVertexBuffer(data, 257);
+    encodeVertexBuffer(data, 5);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::encodeVertexBuffer(): expected stride between 1 and 256 but got 0\n"
+        "MeshTools::encodeVertexBuffer(): expected stride between 1 and 256 but got 257\n"
+        "MeshTools::encodeVertexBuffer(): data size 12 is not divisible by stride 5\n");
+}
+
+void CodecTest::vertexInvalid() {
+    const std::vector<char> data = vertexData(12, 100);
+    const Containers::Array<char> encoded = encodeVertexBuffer({data.data(), data.size()}, 12);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    /* Header too short or with a wrong magic */
+    CORRADE_VERIFY(!decodeVertexBuffer({encoded.data(), 5}));
+
+    /* Count too large for the data size */
+    CORRADE_VERIFY(!decodeVertexBuffer({encoded.data(), 12}));
+
+    /* Truncated payload */
+    CORRADE_VERIFY(!decodeVertexBuffer({encoded.data(), encoded.size() - 1}));
+
+    /* Trailing data */
+    std::vector<char> longer(encoded.begin(), encoded.end());
+    longer.push_back(0);
+    CORRADE_VERIFY(!decodeVertexBuffer({longer.data(), longer.size()}));
+
+    /* Index data */
+    const UnsignedInt indices[]{0, 1, 2};
+    CORRADE_VERIFY(!decodeVertexBuffer(encodeIndexBuffer(indices)));
+
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::decodeVertexBuffer(): invalid header\n"
+        "MeshTools::decodeVertexBuffer(): expected at least 30 bytes for 100 vertices but got 12\n"
+        "MeshTools::decodeVertexBuffer(): unexpected end of data\n"
+        "MeshTools::decodeVertexBuffer(): unexpected 1 bytes after the data\n"
+        "MeshTools::decodeVertexBuffer(): invalid header\n");
+}
+
+void CodecTest::index() {
+    const std::vector<UnsignedInt> indices = gridIndices(40);
+    const Containers::Array<char> encoded = encodeIndexBuffer({indices.data(), indices.size()});
+
+    /* Less than a byte per index */
+    CORRADE_VERIFY(encoded.size() < indices.size());
+
+    Containers::Optional<Containers::Array<UnsignedInt>> decoded = decodeIndexBuffer(encoded);
+    CORRADE_VERIFY(decoded);
+    CORRADE_COMPARE_AS(std::vector<UnsignedInt>(decoded->begin(), decoded->end()),
+        indices, TestSuite::Compare::Container);
+}
+
+void CodecTest::indexEscaped() {
+    /* Large jumps in both directions and values at the type boundaries */
+    const UnsignedInt indices[]{
+        0, 1, 2, 0xffffffffu, 15, 0, 1000000, 3, 0xffffffffu, 0xfffffffeu, 4,
+        5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 18, 0};
+    const Containers::Array<char> encoded = encodeIndexBuffer(indices);
+
+    Containers::Optional<Containers::Array<UnsignedInt>> decoded = decodeIndexBuffer(encoded);
+    CORRADE_VERIFY(decoded);
+    CORRADE_COMPARE_AS(std::vector<UnsignedInt>(decoded->begin(), decoded->end()),
+        (std::vector<UnsignedInt>{std::begin(indices), std::end(indices)}),
+        TestSuite::Compare::Container);
+}
+
+void CodecTest::indexEmpty() {
+    const Containers::Array<char> encoded = encodeIndexBuffer(nullptr);
+    CORRADE_COMPARE(encoded.size(), 5);
+
+    Containers::Optional<Containers::Array<UnsignedInt>> decoded = decodeIndexBuffer(encoded);
+    CORRADE_VERIFY(decoded);
+    CORRADE_VERIFY(decoded->empty());
+}
+
+void CodecTest::indexInto() {
+    const std::vector<UnsignedInt> indices = gridIndices(5);
+    const Containers::Array<char> encoded = encodeIndexBuffer({indices.data(), indices.size()});
+
+    std::vector<UnsignedInt> out(indices.size());
+    CORRADE_VERIFY(decodeIndexBufferInto(encoded, {out.data(), out.size()}));
+    CORRADE_COMPARE_AS(out, indices, TestSuite::Compare::Container);
+}
+
+void CodecTest::indexIntoWrongSize() {
+    const std::vector<UnsignedInt> indices = gridIndices(5);
+    const Containers::Array<char> encoded = encodeIndexBuffer({indices.data(), indices.size()});
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    std::vector<UnsignedInt> decoded(indices.size() + 1);
+    CORRADE_VERIFY(!decodeIndexBufferInto(encoded, {decoded.data(), decoded.size()}));
+    CORRADE_COMPARE(out.str(), "MeshTools::decodeIndexBufferInto(): expected 150 indices but got 151\n");
+}
+
+void CodecTest::indexInvalid() {
+    const UnsignedInt indices[]{0, 1, 2, 1000, 0};
+    const Containers::Array<char> encoded = encodeIndexBuffer(indices);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    /* Header too short or with a wrong magic */
+    CORRADE_VERIFY(!decodeIndexBuffer({encoded.data(), 4}));
+
+    /* Count too large for the data size */
+    CORRADE_VERIFY(!decodeIndexBuffer({encoded.data(), 7}));
+
+    /* Truncated escaped index */
+    CORRADE_VERIFY(!decodeIndexBuffer({encoded.data(), encoded.size() - 1}));
+
+    /* Trailing data */
+    std::vector<char> longer(encoded.begin(), encoded.end());
+    longer.push_back(0);
+    CORRADE_VERIFY(!decodeIndexBuffer({longer.data(), longer.size()}));
+
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::decodeIndexBuffer(): invalid header\n"
+        "MeshTools::decodeIndexBuffer(): expected at least 8 bytes for 5 indices but got 7\n"
+        "MeshTools::decodeIndexBuffer(): invalid or truncated escaped index 3\n"
+        "MeshTools::decodeIndexBuffer(): unexpected 1 bytes after the data\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::CodecTest)
@@ -25,9 +25,11 @@
 
 #include <functional>
 #include <sstream>
+#include <tuple>
 #include <Corrade/TestSuite/Tester.h>
 
 #include "Magnum/Magnum.h"
+#include "Magnum/ThreadPool.h"
 #include "Magnum/MeshTools/CombineIndexedArrays.h"
 
 namespace Magnum { namespace MeshTools { namespace Test {
@@ -38,12 +40,24 @@ struct CombineIndexedArraysTest: TestSuite::Tester {
     void wrongIndexCount();
     void indexArrays();
     void indexedArrays();
+    void indexedArraysParallel();
+
+    void combiner();
+    void combinerReuse();
+    void combinerParallel();
+    void combinerWrongSize();
 };
 
 CombineIndexedArraysTest::CombineIndexedArraysTest() {
     addTests({&CombineIndexedArraysTest::wrongIndexCount,
               &CombineIndexedArraysTest::indexArrays,
-              &CombineIndexedArraysTest::indexedArrays});
+              &CombineIndexedArraysTest::indexedArrays,
+              &CombineIndexedArraysTest::indexedArraysParallel,
+
+              &CombineIndexedArraysTest::combiner,
+              &CombineIndexedArraysTest::combinerReuse,
+              &CombineIndexedArraysTest::combinerParallel,
+              &CombineIndexedArraysTest::combinerWrongSize});
 }
 
 void CombineIndexedArraysTest::wrongIndexCount() {
@@ -87,6 +101,111 @@ void CombineIndexedArraysTest::indexedArrays() {
     CORRADE_COMPARE(array3, (std::vector<UnsignedInt>{6, 7}));
 }
 
+void CombineIndexedArraysTest::indexedArraysParallel() {
+    std::vector<UnsignedInt> a{0, 1, 0};
+    std::vector<UnsignedInt> b{3, 4, 3};
+    std::vector<UnsignedInt> array1{ 0, 1 };
+    std::vector<UnsignedInt> array2{ 0, 1, 2, 3, 4 };
+
+    ThreadPool pool{4};
+    std::vector<UnsignedInt> result = MeshTools::combineIndexedArrays(pool,
+        std::make_pair(std::cref(a), std::ref(array1)),
+        std::make_pair(std::cref(b), std::ref(array2)));
+
+    CORRADE_COMPARE(result, (std::vector<UnsignedInt>{0, 1, 0}));
+    CORRADE_COMPARE(array1, (std::vector<UnsignedInt>{0, 1}));
+    CORRADE_COMPARE(array2, (std::vector<UnsignedInt>{3, 4}));
+}
+
+void CombineIndexedArraysTest::combiner() {
+    /* The example from combineIndexArrays() docs */
+    const UnsignedInt positions[]{0, 2, 5, 0, 0, 1, 3, 2, 2};
+    const UnsignedInt normals[]{1, 3, 4, 1, 4, 6, 1, 3, 1};
+    UnsignedInt combinedIndices[9];
+
+    MeshTools::IndexArrayCombiner combiner;
+    CORRADE_COMPARE(combiner.interleaveAndCombine({positions, normals}, combinedIndices), 7);
+    CORRADE_COMPARE(std::vector<UnsignedInt>(combinedIndices, combinedIndices + 9),
+        (std::vector<UnsignedInt>{0, 1, 2, 0, 3, 4, 5, 1, 6}));
+
+    const Containers::ArrayView<const UnsignedInt> combinations = combiner.combinations();
+    CORRADE_COMPARE(std::vector<UnsignedInt>(combinations.begin(), combinations.end()),
+        (std::vector<UnsignedInt>{0, 1, 2, 3, 5, 4, 0, 4, 1, 6, 3, 1, 2, 1}));
+}
+
+void CombineIndexedArraysTest::combinerReuse() {
+    MeshTools::IndexArrayCombiner combiner;
+    combiner.reserve(16, 3);
+
+    {
+        UnsignedInt interleaved[]{0, 1, 2, 3, 0, 1, 0, 1};
+        UnsignedInt combinedIndices[4];
+        CORRADE_COMPARE(combiner.combineInPlace(interleaved, 2, combinedIndices), 2);
+        CORRADE_COMPARE(std::vector<UnsignedInt>(combinedIndices, combinedIndices + 4),
+            (std::vector<UnsignedInt>{0, 1, 0, 0}));
+        CORRADE_COMPARE(std::vector<UnsignedInt>(interleaved, interleaved + 4),
+            (std::vector<UnsignedInt>{0, 1, 2, 3}));
+    }
+
+    /* Second call with different stride and smaller size doesn't get
+       confused by the leftover state */
+    {
+        UnsignedInt interleaved[]{5, 5, 5, 4, 4, 4, 5, 5, 5};
+        UnsignedInt combinedIndices[3];
+        CORRADE_COMPARE(combiner.combineInPlace(interleaved, 3, combinedIndices), 2);
+        CORRADE_COMPARE(std::vector<UnsignedInt>(combinedIndices, combinedIndices + 3),
+            (std::vector<UnsignedInt>{0, 1, 0}));
+        CORRADE_COMPARE(std::vector<UnsignedInt>(interleaved, interleaved + 6),
+            (std::vector<UnsignedInt>{5, 5, 5, 4, 4, 4}));
+    }
+
+    /* Empty input */
+    CORRADE_COMPARE(combiner.combineInPlace(nullptr, 3, nullptr), 0);
+}
+
+void CombineIndexedArraysTest::combinerParallel() {
+    /* Enough data to hit all partitions and several blocks */
+    std::vector<UnsignedInt> interleaved;
+    for(UnsignedInt i = 0; i != 50000; ++i) {
+        interleaved.push_back(i % 101);
+        interleaved.push_back(i % 7);
+        interleaved.push_back(i % 3);
+    }
+
+    std::vector<UnsignedInt> expectedCombined, expectedInterleaved;
+    std::tie(expectedCombined, expectedInterleaved) = MeshTools::combineIndexArrays(interleaved, 3);
+
+    ThreadPool pool{4};
+    std::vector<UnsignedInt> combined, combinedInterleaved;
+    std::tie(combined, combinedInterleaved) = MeshTools::combineIndexArrays(interleaved, 3, pool);
+
+    /* The result doesn't depend on thread count */
+    CORRADE_VERIFY(expectedInterleaved.size() < interleaved.size());
+    CORRADE_COMPARE(combined, expectedCombined);
+    CORRADE_COMPARE(combinedInterleaved, expectedInterleaved);
+}
+
+void CombineIndexedArraysTest::combinerWrongSize() {
+    std::stringstream ss;
+    Error redirectError{&ss};
+
+    MeshTools::IndexArrayCombiner combiner;
+    UnsignedInt interleaved[6]{};
+    UnsignedInt combinedIndices[2];
+    const UnsignedInt a[3]{};
+    const UnsignedInt b[2]{};
+    combiner.combineInPlace(interleaved, 4, combinedIndices);
+    combiner.combineInPlace(interleaved, 3, {combinedIndices, 1});
+    combiner.interleaveAndCombine({a, b}, combinedIndices);
+    combiner.interleaveAndCombine({a, a}, combinedIndices);
+
+    CORRADE_COMPARE(ss.str(),
+        "MeshTools::IndexArrayCombiner::combineInPlace(): array size is not divisible by stride\n"
+        "MeshTools::IndexArrayCombiner::combineInPlace(): expected 2 combined indices but got 1\n"
+        "MeshTools::IndexArrayCombiner::interleaveAndCombine(): the arrays don't have the same size\n"
+        "MeshTools::IndexArrayCombiner::interleaveAndCombine(): expected 3 combined indices but got 2\n");
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::MeshTools::Test::CombineIndexedArraysTest)
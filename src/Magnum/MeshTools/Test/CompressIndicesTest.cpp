@@ -41,6 +41,14 @@ struct CompressIndicesTest: TestSuite::Tester {
     void compressInt();
 
     void compressAsShort();
+    void compressIntoShort();
+
+    void compressedIndexType();
+    void compressedIndexTypeEmpty();
+    void compressIntoRaw();
+    void compressIntoRawWrongSize();
+    void compressIntoRawTooSmall();
+    void compressEmpty();
 };
 
 CompressIndicesTest::CompressIndicesTest() {
@@ -48,7 +56,15 @@ CompressIndicesTest::CompressIndicesTest() {
               &CompressIndicesTest::compressShort,
               &CompressIndicesTest::compressInt,
 
-              &CompressIndicesTest::compressAsShort});
+              &CompressIndicesTest::compressAsShort,
+              &CompressIndicesTest::compressIntoShort,
+
+              &CompressIndicesTest::compressedIndexType,
+              &CompressIndicesTest::compressedIndexTypeEmpty,
+              &CompressIndicesTest::compressIntoRaw,
+              &CompressIndicesTest::compressIntoRawWrongSize,
+              &CompressIndicesTest::compressIntoRawTooSmall,
+              &CompressIndicesTest::compressEmpty});
 }
 
 void CompressIndicesTest::compressChar() {
@@ -125,6 +141,101 @@ void CompressIndicesTest::compressAsShort() {
     CORRADE_COMPARE(out.str(), "MeshTools::compressIndicesAs(): type too small to represent value 65536\n");
 }
 
+void CompressIndicesTest::compressIntoShort() {
+    const UnsignedInt indices[]{123, 456, 7};
+    UnsignedShort out[3];
+    MeshTools::compressIndicesInto<UnsignedShort>(indices, out);
+    CORRADE_COMPARE(out[0], 123);
+    CORRADE_COMPARE(out[1], 456);
+    CORRADE_COMPARE(out[2], 7);
+}
+
+void CompressIndicesTest::compressedIndexType() {
+    const UnsignedShort shorts[]{17, 3, 255, 8};
+    const UnsignedShort shortsLarge[]{17, 256};
+    const UnsignedInt ints[]{70000, 65536};
+    const UnsignedByte bytes[]{5, 4};
+
+    Mesh::IndexType type;
+    UnsignedInt start, end;
+    std::tie(type, start, end) = MeshTools::compressedIndexType<UnsignedShort>(shorts);
+    CORRADE_COMPARE(type, Mesh::IndexType::UnsignedByte);
+    CORRADE_COMPARE(start, 3);
+    CORRADE_COMPARE(end, 255);
+
+    std::tie(type, start, end) = MeshTools::compressedIndexType<UnsignedShort>(shortsLarge);
+    CORRADE_COMPARE(type, Mesh::IndexType::UnsignedShort);
+    CORRADE_COMPARE(start, 17);
+    CORRADE_COMPARE(end, 256);
+
+    std::tie(type, start, end) = MeshTools::compressedIndexType<UnsignedInt>(ints);
+    CORRADE_COMPARE(type, Mesh::IndexType::UnsignedInt);
+    CORRADE_COMPARE(start, 65536);
+    CORRADE_COMPARE(end, 70000);
+
+    std::tie(type, start, end) = MeshTools::compressedIndexType<UnsignedByte>(bytes);
+    CORRADE_COMPARE(type, Mesh::IndexType::UnsignedByte);
+    CORRADE_COMPARE(start, 4);
+    CORRADE_COMPARE(end, 5);
+}
+
+void CompressIndicesTest::compressedIndexTypeEmpty() {
+    Mesh::IndexType type;
+    UnsignedInt start, end;
+    std::tie(type, start, end) = MeshTools::compressedIndexType<UnsignedInt>(nullptr);
+    CORRADE_COMPARE(type, Mesh::IndexType::UnsignedByte);
+    CORRADE_COMPARE(start, 0);
+    CORRADE_COMPARE(end, 0);
+}
+
+void CompressIndicesTest::compressIntoRaw() {
+    /* 16-bit input coming from an importer, written as 8-bit */
+    const UnsignedShort indices[]{1, 2, 3, 0, 4};
+    char out[5];
+    MeshTools::compressIndicesInto<UnsignedShort>(indices, Mesh::IndexType::UnsignedByte, out);
+    CORRADE_COMPARE(std::vector<char>(out, out + 5),
+        (std::vector<char>{ 0x01, 0x02, 0x03, 0x00, 0x04 }));
+
+    /* And expanded to 32-bit */
+    UnsignedInt expanded[5];
+    MeshTools::compressIndicesInto<UnsignedShort>(indices, Mesh::IndexType::UnsignedInt,
+        Containers::arrayCast<char>(Containers::ArrayView<UnsignedInt>{expanded}));
+    CORRADE_COMPARE(std::vector<UnsignedInt>(expanded, expanded + 5),
+        (std::vector<UnsignedInt>{1, 2, 3, 0, 4}));
+}
+
+void CompressIndicesTest::compressIntoRawWrongSize() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    const UnsignedInt indices[]{1, 2, 3};
+    char data[5];
+    MeshTools::compressIndicesInto<UnsignedInt>(indices, Mesh::IndexType::UnsignedShort, data);
+    CORRADE_COMPARE(out.str(), "MeshTools::compressIndicesInto(): expected output size 6 but got 5\n");
+}
+
+void CompressIndicesTest::compressIntoRawTooSmall() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    const UnsignedShort indices[]{1, 256};
+    char data[2];
+    MeshTools::compressIndicesInto<UnsignedShort>(indices, Mesh::IndexType::UnsignedByte, data);
+    CORRADE_COMPARE(out.str(), "MeshTools::compressIndicesInto(): type too small to represent value 256\n");
+}
+
+void CompressIndicesTest::compressEmpty() {
+    Containers::Array<char> data;
+    Mesh::IndexType type;
+    UnsignedInt start, end;
+    std::tie(data, type, start, end) = MeshTools::compressIndices(std::vector<UnsignedInt>{});
+
+    CORRADE_VERIFY(data.empty());
+    CORRADE_COMPARE(type, Mesh::IndexType::UnsignedByte);
+    CORRADE_COMPARE(start, 0);
+    CORRADE_COMPARE(end, 0);
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::MeshTools::Test::CompressIndicesTest)
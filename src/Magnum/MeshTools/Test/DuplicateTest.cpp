@@ -34,10 +34,14 @@ struct DuplicateTest: TestSuite::Tester {
     explicit DuplicateTest();
 
     void duplicate();
+    void duplicateInto();
+    void duplicateIntoStrided();
 };
 
 DuplicateTest::DuplicateTest() {
-    addTests({&DuplicateTest::duplicate});
+    addTests({&DuplicateTest::duplicate,
+              &DuplicateTest::duplicateInto,
+              &DuplicateTest::duplicateIntoStrided});
 }
 
 void DuplicateTest::duplicate() {
@@ -45,6 +49,38 @@ void DuplicateTest::duplicate() {
                     (std::vector<Int>{35, 35, -7, -18, 12, 12}));
 }
 
+void DuplicateTest::duplicateInto() {
+    const UnsignedInt indices[]{1, 1, 0, 3, 2, 2};
+    const Int data[]{-7, 35, 12, -18};
+    Int out[6];
+
+    MeshTools::duplicateInto<Int>(indices, Containers::ArrayView<const Int>{data}, Containers::ArrayView<Int>{out});
+    CORRADE_COMPARE(std::vector<Int>(out, out + 6),
+                    (std::vector<Int>{35, 35, -7, -18, 12, 12}));
+}
+
+void DuplicateTest::duplicateIntoStrided() {
+    struct Vertex {
+        Int value;
+        Float other;
+    };
+
+    const Vertex data[]{{-7, 0.0f}, {35, 1.0f}, {12, 2.0f}};
+    const UnsignedInt indices[]{2, 0, 0, 1};
+    Vertex out[4]{};
+
+    /* Reading from and writing into interleaved data, leaving other members
+       untouched */
+    MeshTools::duplicateInto<Int>(indices,
+        MeshTools::StridedArrayView<const Int>{&data[0].value, 3, sizeof(Vertex)},
+        MeshTools::StridedArrayView<Int>{&out[0].value, 4, sizeof(Vertex)});
+    CORRADE_COMPARE(out[0].value, 12);
+    CORRADE_COMPARE(out[1].value, -7);
+    CORRADE_COMPARE(out[2].value, -7);
+    CORRADE_COMPARE(out[3].value, 35);
+    CORRADE_COMPARE(out[3].other, 0.0f);
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::MeshTools::Test::DuplicateTest)
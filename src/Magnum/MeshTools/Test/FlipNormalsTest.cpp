@@ -37,12 +37,16 @@ struct FlipNormalsTest: TestSuite::Tester {
     void wrongIndexCount();
     void flipFaceWinding();
     void flipNormals();
+    void flipFaceWindingInPlace();
+    void flipNormalsInPlaceStrided();
 };
 
 FlipNormalsTest::FlipNormalsTest() {
     addTests({&FlipNormalsTest::wrongIndexCount,
               &FlipNormalsTest::flipFaceWinding,
-              &FlipNormalsTest::flipNormals});
+              &FlipNormalsTest::flipNormals,
+              &FlipNormalsTest::flipFaceWindingInPlace,
+              &FlipNormalsTest::flipNormalsInPlaceStrided});
 }
 
 void FlipNormalsTest::wrongIndexCount() {
@@ -75,6 +79,33 @@ void FlipNormalsTest::flipNormals() {
                                                    -Vector3::zAxis()}));
 }
 
+void FlipNormalsTest::flipFaceWindingInPlace() {
+    UnsignedInt indices[]{0, 1, 2,
+                          3, 4, 5};
+    MeshTools::flipFaceWindingInPlace(indices);
+    CORRADE_COMPARE(std::vector<UnsignedInt>(indices, indices + 6),
+        (std::vector<UnsignedInt>{0, 2, 1,
+                                  3, 5, 4}));
+}
+
+void FlipNormalsTest::flipNormalsInPlaceStrided() {
+    struct Vertex {
+        Vector3 position;
+        Vector3 normal;
+    } vertices[]{
+        {{1.0f, 2.0f, 3.0f}, Vector3::xAxis()},
+        {{4.0f, 5.0f, 6.0f}, Vector3::yAxis()}
+    };
+
+    MeshTools::flipNormalsInPlace(MeshTools::StridedArrayView<Vector3>{&vertices[0].normal, 2, sizeof(Vertex)});
+    CORRADE_COMPARE(vertices[0].normal, -Vector3::xAxis());
+    CORRADE_COMPARE(vertices[1].normal, -Vector3::yAxis());
+
+    /* Positions are not touched */
+    CORRADE_COMPARE(vertices[0].position, (Vector3{1.0f, 2.0f, 3.0f}));
+    CORRADE_COMPARE(vertices[1].position, (Vector3{4.0f, 5.0f, 6.0f}));
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::MeshTools::Test::FlipNormalsTest)
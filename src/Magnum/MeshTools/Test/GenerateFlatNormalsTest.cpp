@@ -36,11 +36,17 @@ struct GenerateFlatNormalsTest: TestSuite::Tester {
 
     void wrongIndexCount();
     void generate();
+    void generateInto();
+    void generateIntoIndexed();
+    void generateIntoWrongSize();
 };
 
 GenerateFlatNormalsTest::GenerateFlatNormalsTest() {
     addTests({&GenerateFlatNormalsTest::wrongIndexCount,
-              &GenerateFlatNormalsTest::generate});
+              &GenerateFlatNormalsTest::generate,
+              &GenerateFlatNormalsTest::generateInto,
+              &GenerateFlatNormalsTest::generateIntoIndexed,
+              &GenerateFlatNormalsTest::generateIntoWrongSize});
 }
 
 void GenerateFlatNormalsTest::wrongIndexCount() {
@@ -81,6 +87,62 @@ void GenerateFlatNormalsTest::generate() {
     }));
 }
 
+void GenerateFlatNormalsTest::generateInto() {
+    struct Vertex {
+        Vector3 position;
+        Vector3 normal;
+    } vertices[]{
+        {{-1.0f, 0.0f, 0.0f}, {}},
+        {{0.0f, -1.0f, 0.0f}, {}},
+        {{0.0f, 1.0f, 0.0f}, {}},
+        {{0.0f, -1.0f, 0.0f}, {}},
+        {{0.0f, 1.0f, 0.0f}, {}},
+        {{1.0f, 0.0f, 0.0f}, {}}
+    };
+
+    /* Generating directly into interleaved data */
+    MeshTools::generateFlatNormalsInto(
+        MeshTools::StridedArrayView<const Vector3>{&vertices[0].position, 6, sizeof(Vertex)},
+        MeshTools::StridedArrayView<Vector3>{&vertices[0].normal, 6, sizeof(Vertex)});
+    CORRADE_COMPARE(vertices[0].normal, Vector3::zAxis());
+    CORRADE_COMPARE(vertices[1].normal, Vector3::zAxis());
+    CORRADE_COMPARE(vertices[2].normal, Vector3::zAxis());
+    CORRADE_COMPARE(vertices[3].normal, -Vector3::zAxis());
+    CORRADE_COMPARE(vertices[4].normal, -Vector3::zAxis());
+    CORRADE_COMPARE(vertices[5].normal, -Vector3::zAxis());
+}
+
+void GenerateFlatNormalsTest::generateIntoIndexed() {
+    const UnsignedInt indices[]{
+        0, 1, 2,
+        1, 2, 3
+    };
+    const Vector3 positions[]{
+        {-1.0f, 0.0f, 0.0f},
+        {0.0f, -1.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f}
+    };
+    Vector3 normals[6];
+
+    MeshTools::generateFlatNormalsInto(indices, Containers::ArrayView<const Vector3>{positions}, Containers::ArrayView<Vector3>{normals});
+    CORRADE_COMPARE(std::vector<Vector3>(normals, normals + 6), (std::vector<Vector3>{
+        Vector3::zAxis(), Vector3::zAxis(), Vector3::zAxis(),
+        -Vector3::zAxis(), -Vector3::zAxis(), -Vector3::zAxis()
+    }));
+}
+
+void GenerateFlatNormalsTest::generateIntoWrongSize() {
+    std::stringstream ss;
+    Error redirectError{&ss};
+
+    const UnsignedInt indices[]{0, 1, 2};
+    Vector3 positions[3];
+    Vector3 normals[2];
+    MeshTools::generateFlatNormalsInto(indices, Containers::ArrayView<const Vector3>{positions}, Containers::ArrayView<Vector3>{normals});
+    CORRADE_COMPARE(ss.str(), "MeshTools::generateFlatNormalsInto(): expected 3 normals but got 2\n");
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::MeshTools::Test::GenerateFlatNormalsTest)
@@ -0,0 +1,167 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/GenerateSmoothNormals.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+struct GenerateSmoothNormalsTest: TestSuite::Tester {
+    explicit GenerateSmoothNormalsTest();
+
+    void wrongIndexCount();
+    void generate();
+    void generateInto();
+    void generateIntoWrongSize();
+    void generateCrease();
+    void generateCreaseSmooth();
+};
+
+GenerateSmoothNormalsTest::GenerateSmoothNormalsTest() {
+    addTests({&GenerateSmoothNormalsTest::wrongIndexCount,
+              &GenerateSmoothNormalsTest::generate,
+              &GenerateSmoothNormalsTest::generateInto,
+              &GenerateSmoothNormalsTest::generateIntoWrongSize,
+              &GenerateSmoothNormalsTest::generateCrease,
+              &GenerateSmoothNormalsTest::generateCreaseSmooth});
+}
+
+namespace {
+    /* Corner of a cube at origin, with outward normals -X, -Y and -Z. The
+       face in the Z plane is split into two triangles, both having 45° at
+       the origin, so with angle weighting the normal there is still the
+       diagonal. */
+    const std::vector<UnsignedInt> CornerIndices{
+        0, 4, 1,
+        0, 2, 4,
+        0, 3, 2,
+        0, 1, 3
+    };
+
+    const std::vector<Vector3> CornerPositions{
+        {0.0f, 0.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f},
+        {0.0f, 0.0f, 1.0f},
+        {1.0f, 1.0f, 0.0f}
+    };
+
+    const std::vector<Vector3> CornerNormals{
+        Vector3{-1.0f, -1.0f, -1.0f}.normalized(),
+        Vector3{0.0f, -1.0f, -2.0f}.normalized(),
+        Vector3{-1.0f, 0.0f, -2.0f}.normalized(),
+        Vector3{-1.0f, -1.0f, 0.0f}.normalized(),
+        -Vector3::zAxis()
+    };
+}
+
+void GenerateSmoothNormalsTest::wrongIndexCount() {
+    std::stringstream ss;
+    Error redirectError{&ss};
+    std::vector<UnsignedInt> indices;
+    std::vector<Vector3> normals;
+    std::tie(indices, normals) = MeshTools::generateSmoothNormals({
+        0, 1
+    }, {}, Deg(30.0f));
+
+    CORRADE_COMPARE(indices.size(), 0);
+    CORRADE_COMPARE(normals.size(), 0);
+    CORRADE_COMPARE(ss.str(), "MeshTools::generateSmoothNormals(): index count is not divisible by 3!\n");
+}
+
+void GenerateSmoothNormalsTest::generate() {
+    CORRADE_COMPARE(MeshTools::generateSmoothNormals(CornerIndices, CornerPositions), CornerNormals);
+}
+
+void GenerateSmoothNormalsTest::generateInto() {
+    struct Vertex {
+        Vector3 position;
+        Vector3 normal;
+    } vertices[6];
+    for(std::size_t i = 0; i != 5; ++i)
+        vertices[i].position = CornerPositions[i];
+
+    /* Generating directly into interleaved data, the last vertex is not
+       referenced */
+    MeshTools::generateSmoothNormalsInto({CornerIndices.data(), CornerIndices.size()},
+        MeshTools::StridedArrayView<const Vector3>{&vertices[0].position, 6, sizeof(Vertex)},
+        MeshTools::StridedArrayView<Vector3>{&vertices[0].normal, 6, sizeof(Vertex)});
+    for(std::size_t i = 0; i != 5; ++i)
+        CORRADE_COMPARE(vertices[i].normal, CornerNormals[i]);
+    CORRADE_COMPARE(vertices[5].normal, Vector3{});
+}
+
+void GenerateSmoothNormalsTest::generateIntoWrongSize() {
+    std::stringstream ss;
+    Error redirectError{&ss};
+
+    const UnsignedInt indices[]{0, 1, 2};
+    Vector3 positions[3];
+    Vector3 normals[2];
+    MeshTools::generateSmoothNormalsInto(indices, Containers::ArrayView<const Vector3>{positions}, Containers::ArrayView<Vector3>{normals});
+    CORRADE_COMPARE(ss.str(), "MeshTools::generateSmoothNormalsInto(): expected 3 normals but got 2\n");
+}
+
+void GenerateSmoothNormalsTest::generateCrease() {
+    /* All faces are perpendicular, so with a 60° crease each vertex gets a
+       separate normal for each face */
+    std::vector<UnsignedInt> indices;
+    std::vector<Vector3> normals;
+    std::tie(indices, normals) = MeshTools::generateSmoothNormals(CornerIndices, CornerPositions, Deg(60.0f));
+
+    CORRADE_COMPARE(indices.size(), CornerIndices.size());
+    CORRADE_COMPARE(normals.size(), 10);
+
+    const Vector3 faceNormals[]{
+        -Vector3::zAxis(),
+        -Vector3::zAxis(),
+        -Vector3::xAxis(),
+        -Vector3::yAxis()
+    };
+    for(std::size_t i = 0; i != indices.size(); ++i)
+        CORRADE_COMPARE(normals[indices[i]], faceNormals[i/3]);
+
+    /* The two triangles of the Z face share normals on the common edge */
+    CORRADE_COMPARE(indices[0], indices[3]);
+    CORRADE_COMPARE(indices[1], indices[5]);
+}
+
+void GenerateSmoothNormalsTest::generateCreaseSmooth() {
+    /* With a crease angle larger than any angle in the mesh the result is the
+       same as without creases, one normal per vertex */
+    std::vector<UnsignedInt> indices;
+    std::vector<Vector3> normals;
+    std::tie(indices, normals) = MeshTools::generateSmoothNormals(CornerIndices, CornerPositions, Deg(100.0f));
+
+    CORRADE_COMPARE(indices, CornerIndices);
+    CORRADE_COMPARE(normals, CornerNormals);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::GenerateSmoothNormalsTest)
@@ -0,0 +1,165 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Vector4.h"
+#include "Magnum/MeshTools/GenerateTangents.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+struct GenerateTangentsTest: TestSuite::Tester {
+    explicit GenerateTangentsTest();
+
+    void generate();
+    void generateMirrored();
+    void generateTiltedNormal();
+    void generateDegenerate();
+    void generateInto();
+    void generateIntoWrongSize();
+};
+
+GenerateTangentsTest::GenerateTangentsTest() {
+    addTests({&GenerateTangentsTest::generate,
+              &GenerateTangentsTest::generateMirrored,
+              &GenerateTangentsTest::generateTiltedNormal,
+              &GenerateTangentsTest::generateDegenerate,
+              &GenerateTangentsTest::generateInto,
+              &GenerateTangentsTest::generateIntoWrongSize});
+}
+
+namespace {
+    /* A quad in the XY plane */
+    const std::vector<UnsignedInt> QuadIndices{
+        0, 1, 2,
+        0, 2, 3
+    };
+
+    const std::vector<Vector3> QuadPositions{
+        {-1.0f, -1.0f, 0.0f},
+        { 1.0f, -1.0f, 0.0f},
+        { 1.0f,  1.0f, 0.0f},
+        {-1.0f,  1.0f, 0.0f}
+    };
+
+    const std::vector<Vector3> QuadNormals(4, Vector3::zAxis());
+}
+
+void GenerateTangentsTest::generate() {
+    /* Texture coordinates rotated by 90°, so the tangent is along Y */
+    const std::vector<Vector4> tangents = MeshTools::generateTangents(QuadIndices, QuadPositions, QuadNormals, {
+        {0.0f, 1.0f},
+        {0.0f, 0.0f},
+        {1.0f, 0.0f},
+        {1.0f, 1.0f}
+    });
+
+    CORRADE_COMPARE(tangents, std::vector<Vector4>(4, {0.0f, 1.0f, 0.0f, 1.0f}));
+}
+
+void GenerateTangentsTest::generateMirrored() {
+    /* U goes in the opposite direction than X, bitangent stays along Y, which
+       is signalized by the negative W */
+    const std::vector<Vector4> tangents = MeshTools::generateTangents(QuadIndices, QuadPositions, QuadNormals, {
+        {1.0f, 0.0f},
+        {0.0f, 0.0f},
+        {0.0f, 1.0f},
+        {1.0f, 1.0f}
+    });
+
+    CORRADE_COMPARE(tangents, std::vector<Vector4>(4, {-1.0f, 0.0f, 0.0f, -1.0f}));
+}
+
+void GenerateTangentsTest::generateTiltedNormal() {
+    /* The tangent gets orthogonalized against the vertex normal */
+    const std::vector<Vector4> tangents = MeshTools::generateTangents(QuadIndices, QuadPositions,
+        std::vector<Vector3>(4, {0.6f, 0.0f, 0.8f}), {
+        {0.0f, 0.0f},
+        {1.0f, 0.0f},
+        {1.0f, 1.0f},
+        {0.0f, 1.0f}
+    });
+
+    CORRADE_COMPARE(tangents, std::vector<Vector4>(4, {0.8f, 0.0f, -0.6f, 1.0f}));
+}
+
+void GenerateTangentsTest::generateDegenerate() {
+    /* All texture coordinates the same, an arbitrary perpendicular tangent is
+       picked */
+    const std::vector<Vector4> tangents = MeshTools::generateTangents(QuadIndices, QuadPositions, QuadNormals, std::vector<Vector2>(4));
+
+    CORRADE_COMPARE(tangents, std::vector<Vector4>(4, {1.0f, 0.0f, 0.0f, 1.0f}));
+}
+
+void GenerateTangentsTest::generateInto() {
+    struct Vertex {
+        Vector3 position;
+        Vector3 normal;
+        Vector2 textureCoordinates;
+        Vector4 tangent;
+    } vertices[4];
+    const Vector2 textureCoordinates[]{
+        {0.0f, 0.0f},
+        {1.0f, 0.0f},
+        {1.0f, 1.0f},
+        {0.0f, 1.0f}
+    };
+    for(std::size_t i = 0; i != 4; ++i) {
+        vertices[i].position = QuadPositions[i];
+        vertices[i].normal = QuadNormals[i];
+        vertices[i].textureCoordinates = textureCoordinates[i];
+    }
+
+    /* Generating directly into interleaved data */
+    MeshTools::generateTangentsInto({QuadIndices.data(), QuadIndices.size()},
+        MeshTools::StridedArrayView<const Vector3>{&vertices[0].position, 4, sizeof(Vertex)},
+        MeshTools::StridedArrayView<const Vector3>{&vertices[0].normal, 4, sizeof(Vertex)},
+        MeshTools::StridedArrayView<const Vector2>{&vertices[0].textureCoordinates, 4, sizeof(Vertex)},
+        MeshTools::StridedArrayView<Vector4>{&vertices[0].tangent, 4, sizeof(Vertex)});
+    for(std::size_t i = 0; i != 4; ++i)
+        CORRADE_COMPARE(vertices[i].tangent, (Vector4{1.0f, 0.0f, 0.0f, 1.0f}));
+}
+
+void GenerateTangentsTest::generateIntoWrongSize() {
+    std::stringstream ss;
+    Error redirectError{&ss};
+
+    const UnsignedInt indices[]{0, 1, 2};
+    Vector3 positions[3];
+    Vector3 normals[3];
+    Vector2 textureCoordinates[2];
+    Vector4 tangents[3];
+    MeshTools::generateTangentsInto(indices,
+        Containers::ArrayView<const Vector3>{positions},
+        Containers::ArrayView<const Vector3>{normals},
+        Containers::ArrayView<const Vector2>{textureCoordinates},
+        Containers::ArrayView<Vector4>{tangents});
+    CORRADE_COMPARE(ss.str(), "MeshTools::generateTangentsInto(): expected 3 normals and texture coordinates but got 3 and 2\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::GenerateTangentsTest)
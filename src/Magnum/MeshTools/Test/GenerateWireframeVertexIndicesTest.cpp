@@ -0,0 +1,145 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/MeshTools/GenerateWireframeVertexIndices.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+struct GenerateWireframeVertexIndicesTest: TestSuite::Tester {
+    explicit GenerateWireframeVertexIndicesTest();
+
+    void wrongIndexCount();
+    void indexOutOfRange();
+    void generate();
+    void generateDuplicates();
+    void generateDegenerate();
+    void unreferencedVertices();
+};
+
+GenerateWireframeVertexIndicesTest::GenerateWireframeVertexIndicesTest() {
+    addTests({&GenerateWireframeVertexIndicesTest::wrongIndexCount,
+              &GenerateWireframeVertexIndicesTest::indexOutOfRange,
+              &GenerateWireframeVertexIndicesTest::generate,
+              &GenerateWireframeVertexIndicesTest::generateDuplicates,
+              &GenerateWireframeVertexIndicesTest::generateDegenerate,
+              &GenerateWireframeVertexIndicesTest::unreferencedVertices});
+}
+
+void GenerateWireframeVertexIndicesTest::wrongIndexCount() {
+    std::stringstream ss;
+    Error redirectError{&ss};
+    std::vector<UnsignedInt> indices{0, 1};
+    std::vector<UnsignedInt> mapping;
+    std::vector<Float> vertexIndices;
+    std::tie(mapping, vertexIndices) = MeshTools::generateWireframeVertexIndices(indices, 2);
+
+    CORRADE_COMPARE(mapping.size(), 0);
+    CORRADE_COMPARE(vertexIndices.size(), 0);
+    CORRADE_COMPARE(ss.str(), "MeshTools::generateWireframeVertexIndices(): index count is not divisible by 3!\n");
+}
+
+void GenerateWireframeVertexIndicesTest::indexOutOfRange() {
+    std::stringstream ss;
+    Error redirectError{&ss};
+    std::vector<UnsignedInt> indices{0, 1, 3};
+    MeshTools::generateWireframeVertexIndices(indices, 3);
+
+    CORRADE_COMPARE(ss.str(), "MeshTools::generateWireframeVertexIndices(): index 3 out of range for 3 vertices\n");
+}
+
+void GenerateWireframeVertexIndicesTest::generate() {
+    /* Quad made of two triangles, no duplicates needed */
+    std::vector<UnsignedInt> indices{
+        0, 1, 2,
+        0, 2, 3
+    };
+    std::vector<UnsignedInt> mapping;
+    std::vector<Float> vertexIndices;
+    std::tie(mapping, vertexIndices) = MeshTools::generateWireframeVertexIndices(indices, 4);
+
+    CORRADE_COMPARE(indices, (std::vector<UnsignedInt>{
+        0, 1, 2,
+        0, 2, 3
+    }));
+    CORRADE_COMPARE(mapping, (std::vector<UnsignedInt>{0, 1, 2, 3}));
+    CORRADE_COMPARE(vertexIndices, (std::vector<Float>{0.0f, 1.0f, 2.0f, 1.0f}));
+}
+
+void GenerateWireframeVertexIndicesTest::generateDuplicates() {
+    /* Tetrahedron, four vertices all connected to each other can't be
+       assigned just three distinct values */
+    std::vector<UnsignedInt> indices{
+        0, 1, 2,
+        0, 2, 3,
+        0, 3, 1,
+        1, 3, 2
+    };
+    std::vector<UnsignedInt> mapping;
+    std::vector<Float> vertexIndices;
+    std::tie(mapping, vertexIndices) = MeshTools::generateWireframeVertexIndices(indices, 4);
+
+    CORRADE_COMPARE(indices, (std::vector<UnsignedInt>{
+        0, 1, 2,
+        0, 2, 3,
+        0, 3, 4,
+        1, 5, 2
+    }));
+    CORRADE_COMPARE(mapping, (std::vector<UnsignedInt>{0, 1, 2, 3, 1, 3}));
+    CORRADE_COMPARE(vertexIndices, (std::vector<Float>{0.0f, 1.0f, 2.0f, 1.0f, 2.0f, 0.0f}));
+
+    /* Every triangle has all three values */
+    for(std::size_t i = 0; i != indices.size(); i += 3)
+        CORRADE_COMPARE(vertexIndices[indices[i]] + vertexIndices[indices[i + 1]] + vertexIndices[indices[i + 2]], 3.0f);
+}
+
+void GenerateWireframeVertexIndicesTest::generateDegenerate() {
+    /* The same vertex twice in a triangle gets duplicated */
+    std::vector<UnsignedInt> indices{0, 1, 1};
+    std::vector<UnsignedInt> mapping;
+    std::vector<Float> vertexIndices;
+    std::tie(mapping, vertexIndices) = MeshTools::generateWireframeVertexIndices(indices, 2);
+
+    CORRADE_COMPARE(indices, (std::vector<UnsignedInt>{0, 1, 2}));
+    CORRADE_COMPARE(mapping, (std::vector<UnsignedInt>{0, 1, 1}));
+    CORRADE_COMPARE(vertexIndices, (std::vector<Float>{0.0f, 1.0f, 2.0f}));
+}
+
+void GenerateWireframeVertexIndicesTest::unreferencedVertices() {
+    std::vector<UnsignedInt> indices{3, 1, 2};
+    std::vector<UnsignedInt> mapping;
+    std::vector<Float> vertexIndices;
+    std::tie(mapping, vertexIndices) = MeshTools::generateWireframeVertexIndices(indices, 5);
+
+    CORRADE_COMPARE(indices, (std::vector<UnsignedInt>{3, 1, 2}));
+    CORRADE_COMPARE(mapping, (std::vector<UnsignedInt>{0, 1, 2, 3, 4}));
+    CORRADE_COMPARE(vertexIndices, (std::vector<Float>{0.0f, 1.0f, 2.0f, 0.0f, 0.0f}));
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::GenerateWireframeVertexIndicesTest)
@@ -0,0 +1,109 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <vector>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+
+#include "Magnum/Buffer.h"
+#include "Magnum/OpenGLTester.h"
+#include "Magnum/ThreadPool.h"
+#include "Magnum/MeshTools/Interleave.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+struct InterleaveGLTest: OpenGLTester {
+    explicit InterleaveGLTest();
+
+    void buffer();
+    void bufferParallel();
+    void bufferEmpty();
+};
+
+InterleaveGLTest::InterleaveGLTest() {
+    addTests({&InterleaveGLTest::buffer,
+              &InterleaveGLTest::bufferParallel,
+              &InterleaveGLTest::bufferEmpty});
+}
+
+namespace {
+    struct Data {
+        explicit Data(std::size_t count): a(count), b(count) {
+            for(std::size_t i = 0; i != count; ++i) {
+                a[i] = Int(i*7);
+                b[i] = Short(i);
+            }
+        }
+
+        std::vector<Int> a;
+        std::vector<Short> b;
+    };
+}
+
+void InterleaveGLTest::buffer() {
+    /* More than one staging block */
+    const Data data{5003};
+
+    Buffer buffer;
+    CORRADE_COMPARE(MeshTools::interleaveInto(buffer, BufferUsage::StaticDraw, data.a, 2, data.b), 5003);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    CORRADE_COMPARE(buffer.size(), 5003*8);
+
+    /** @todo How to verify the contents in ES? */
+    #ifndef MAGNUM_TARGET_GLES
+    const Containers::Array<char> expected = MeshTools::interleave(data.a, 2, data.b);
+    CORRADE_COMPARE_AS(buffer.data(), expected, TestSuite::Compare::Container);
+    #endif
+}
+
+void InterleaveGLTest::bufferParallel() {
+    /* More than one chunk */
+    const Data data{200003};
+
+    ThreadPool pool{4};
+    Buffer buffer;
+    CORRADE_COMPARE(MeshTools::interleaveInto(buffer, BufferUsage::StaticDraw, pool, data.a, 2, data.b), 200003);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    CORRADE_COMPARE(buffer.size(), 200003*8);
+
+    #ifndef MAGNUM_TARGET_GLES
+    const Containers::Array<char> expected = MeshTools::interleave(data.a, 2, data.b);
+    CORRADE_COMPARE_AS(buffer.data(), expected, TestSuite::Compare::Container);
+    #endif
+}
+
+void InterleaveGLTest::bufferEmpty() {
+    Buffer buffer;
+    CORRADE_COMPARE(MeshTools::interleaveInto(buffer, BufferUsage::StaticDraw, std::vector<Int>{}, 2), 0);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    CORRADE_COMPARE(buffer.size(), 0);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::InterleaveGLTest)
@@ -23,11 +23,13 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <cstring>
 #include <sstream>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/Utility/Endianness.h>
 #include <Corrade/Utility/Debug.h>
 
+#include "Magnum/ThreadPool.h"
 #include "Magnum/MeshTools/Interleave.h"
 
 namespace Magnum { namespace MeshTools { namespace Test {
@@ -43,6 +45,10 @@ struct InterleaveTest: Corrade::TestSuite::Tester {
     void writeGaps();
 
     void interleaveInto();
+    void interleaveIntoParallel();
+    void interleaveIntoParallelGaps();
+
+    void copyNonTemporal();
 };
 
 InterleaveTest::InterleaveTest() {
@@ -53,7 +59,11 @@ InterleaveTest::InterleaveTest() {
               &InterleaveTest::write,
               &InterleaveTest::writeGaps,
 
-              &InterleaveTest::interleaveInto});
+              &InterleaveTest::interleaveInto,
+              &InterleaveTest::interleaveIntoParallel,
+              &InterleaveTest::interleaveIntoParallelGaps,
+
+              &InterleaveTest::copyNonTemporal});
 }
 
 void InterleaveTest::attributeCount() {
@@ -157,6 +167,64 @@ void InterleaveTest::interleaveInto() {
     }
 }
 
+void InterleaveTest::interleaveIntoParallel() {
+    /* Enough vertices to be split into more than one chunk */
+    std::vector<Int> a(200003);
+    std::vector<Short> b(a.size());
+    for(std::size_t i = 0; i != a.size(); ++i) {
+        a[i] = Int(i*7);
+        b[i] = Short(i);
+    }
+
+    const Containers::Array<char> expected = MeshTools::interleave(a, 2, b);
+
+    ThreadPool pool{4};
+    Containers::Array<char> data{Containers::ValueInit, expected.size()};
+    MeshTools::interleaveInto(data, pool, a, 2, b);
+
+    CORRADE_COMPARE(data.size(), a.size()*8);
+    CORRADE_VERIFY(std::memcmp(data.data(), expected.data(), expected.size()) == 0);
+}
+
+void InterleaveTest::interleaveIntoParallelGaps() {
+    Containers::Array<char> data{Containers::InPlaceInit, {
+        0x11, 0x33, 0x55, 0x77, 0x11, 0x33, 0x55, 0x77, 0x11, 0x33, 0x55, 0x77,
+        0x11, 0x33, 0x55, 0x77, 0x11, 0x33, 0x55, 0x77, 0x11, 0x33, 0x55, 0x77}};
+
+    /* Same as interleaveInto(), gaps are left untouched */
+    ThreadPool pool{2};
+    MeshTools::interleaveInto(data, pool, 2, std::vector<Int>{4, 5}, 1, std::vector<Short>{0, 1}, 3);
+
+    if(!Utility::Endianness::isBigEndian()) {
+        /*  _______gap, int___________________, _gap, short_____, _____________gap */
+        CORRADE_COMPARE(std::vector<char>(data.begin(), data.end()), (std::vector<char>{
+            0x11, 0x33, 0x04, 0x00, 0x00, 0x00, 0x55, 0x00, 0x00, 0x33, 0x55, 0x77,
+            0x11, 0x33, 0x05, 0x00, 0x00, 0x00, 0x55, 0x01, 0x00, 0x33, 0x55, 0x77
+        }));
+    } else {
+        /*  _______gap, ___________________int, _gap, _____short, _____________gap */
+        CORRADE_COMPARE(std::vector<char>(data.begin(), data.end()), (std::vector<char>{
+            0x11, 0x33, 0x00, 0x00, 0x00, 0x04, 0x55, 0x00, 0x00, 0x33, 0x55, 0x77,
+            0x11, 0x33, 0x00, 0x00, 0x00, 0x05, 0x55, 0x00, 0x01, 0x33, 0x55, 0x77
+        }));
+    }
+}
+
+void InterleaveTest::copyNonTemporal() {
+    char source[128];
+    for(std::size_t i = 0; i != sizeof(source); ++i) source[i] = char(i*7 + 1);
+
+    /* All combinations of unaligned head, aligned body and a tail */
+    for(std::size_t offset: {0, 1, 15, 16}) for(std::size_t size: {0, 3, 16, 17, 100}) {
+        alignas(16) char destination[128 + 16]{};
+        Implementation::copyNonTemporal(destination + offset, source + 1, size);
+
+        CORRADE_COMPARE(std::memcmp(destination + offset, source + 1, size), 0);
+        for(std::size_t i = 0; i != sizeof(destination); ++i)
+            if(i < offset || i >= offset + size) CORRADE_COMPARE(destination[i], 0);
+    }
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::MeshTools::Test::InterleaveTest)
@@ -0,0 +1,143 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Color.h"
+#include "Magnum/Mesh.h"
+#include "Magnum/MeshTools/MeshCache.h"
+#include "Magnum/Trade/MeshData2D.h"
+#include "Magnum/Trade/MeshData3D.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+struct MeshCacheTest: TestSuite::Tester {
+    explicit MeshCacheTest();
+
+    void data2D();
+    void data3D();
+    void differentGenerators();
+    void clear();
+};
+
+MeshCacheTest::MeshCacheTest() {
+    addTests({&MeshCacheTest::data2D,
+              &MeshCacheTest::data3D,
+              &MeshCacheTest::differentGenerators,
+              &MeshCacheTest::clear});
+}
+
+namespace {
+
+Int generatedCount = 0;
+
+Trade::MeshData2D square(Float size) {
+    ++generatedCount;
+    return Trade::MeshData2D{MeshPrimitive::TriangleFan, {}, {{
+        {-size, -size}, {size, -size}, {size, size}, {-size, size}
+    }}, {}, {}};
+}
+
+Trade::MeshData3D line(UnsignedInt segments, bool closed) {
+    ++generatedCount;
+    std::vector<Vector3> positions;
+    for(UnsignedInt i = 0; i != segments + 1; ++i)
+        positions.push_back(Vector3::xAxis(Float(i)));
+    return Trade::MeshData3D{closed ? MeshPrimitive::LineLoop : MeshPrimitive::LineStrip, {}, {positions}, {}, {}, {}};
+}
+
+Trade::MeshData3D otherLine(UnsignedInt segments, bool closed) {
+    return line(segments, closed);
+}
+
+}
+
+void MeshCacheTest::data2D() {
+    generatedCount = 0;
+    MeshCache cache;
+
+    const Trade::MeshData2D& a = cache.data(square, 1.0f);
+    CORRADE_COMPARE(generatedCount, 1);
+    CORRADE_COMPARE(a.positions(0).size(), 4);
+    CORRADE_COMPARE(a.positions(0)[2], (Vector2{1.0f, 1.0f}));
+
+    /* Same parameters, converted from a different type, give the same data */
+    const Trade::MeshData2D& b = cache.data(square, 1);
+    CORRADE_COMPARE(generatedCount, 1);
+    CORRADE_COMPARE(&b, &a);
+
+    /* Different parameters generate new data */
+    const Trade::MeshData2D& c = cache.data(square, 2.0f);
+    CORRADE_COMPARE(generatedCount, 2);
+    CORRADE_VERIFY(&c != &a);
+    CORRADE_COMPARE(c.positions(0)[2], (Vector2{2.0f, 2.0f}));
+    CORRADE_COMPARE(cache.count(), 2);
+}
+
+void MeshCacheTest::data3D() {
+    generatedCount = 0;
+    MeshCache cache;
+
+    const Trade::MeshData3D& a = cache.data(line, 3, false);
+    const Trade::MeshData3D& b = cache.data(line, 3, true);
+    const Trade::MeshData3D& c = cache.data(line, 3u, false);
+    CORRADE_COMPARE(generatedCount, 2);
+    CORRADE_COMPARE(a.primitive(), MeshPrimitive::LineStrip);
+    CORRADE_COMPARE(b.primitive(), MeshPrimitive::LineLoop);
+    CORRADE_COMPARE(a.positions(0).size(), 4);
+    CORRADE_COMPARE(&c, &a);
+}
+
+void MeshCacheTest::differentGenerators() {
+    generatedCount = 0;
+    MeshCache cache;
+
+    /* Same parameters but different generator is a different entry */
+    const Trade::MeshData3D& a = cache.data(line, 5, false);
+    const Trade::MeshData3D& b = cache.data(otherLine, 5, false);
+    CORRADE_COMPARE(generatedCount, 2);
+    CORRADE_VERIFY(&a != &b);
+    CORRADE_COMPARE(cache.count(), 2);
+}
+
+void MeshCacheTest::clear() {
+    generatedCount = 0;
+    MeshCache cache;
+
+    cache.data(square, 1.0f);
+    cache.data(line, 1, true);
+    CORRADE_COMPARE(cache.count(), 2);
+
+    cache.clear();
+    CORRADE_COMPARE(cache.count(), 0);
+
+    /* Generated again after clearing */
+    cache.data(square, 1.0f);
+    CORRADE_COMPARE(generatedCount, 3);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::MeshCacheTest)
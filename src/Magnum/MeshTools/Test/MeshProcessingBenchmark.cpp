@@ -0,0 +1,193 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <string>
+#include <tuple>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+
+#include "Magnum/Math/Vector2.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/CombineIndexedArrays.h"
+#include "Magnum/MeshTools/CompressIndices.h"
+#include "Magnum/MeshTools/RemoveDuplicates.h"
+#include "Magnum/MeshTools/Tipsify.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+/* Benchmarks on a mesh the size of a typical scanned or sculpted asset. The
+   test case description contains the amount of processed data, divide it by
+   the reported time to get the throughput. */
+
+struct MeshProcessingBenchmark: TestSuite::Tester {
+    explicit MeshProcessingBenchmark();
+
+    void removeDuplicates();
+    void removeDuplicatesExact();
+    void combineIndexedArrays();
+    void tipsify();
+    void compressIndices();
+};
+
+namespace {
+
+constexpr UnsignedInt GridSize = 512;
+constexpr UnsignedInt VertexCount = (GridSize + 1)*(GridSize + 1);
+constexpr UnsignedInt IndexCount = GridSize*GridSize*6;
+
+std::vector<UnsignedInt> gridIndices() {
+    std::vector<UnsignedInt> indices;
+    indices.reserve(IndexCount);
+    for(UnsignedInt y = 0; y != GridSize; ++y) {
+        for(UnsignedInt x = 0; x != GridSize; ++x) {
+            const UnsignedInt i = y*(GridSize + 1) + x;
+            indices.insert(indices.end(), {i, i + 1, i + GridSize + 2,
+                                           i, i + GridSize + 2, i + GridSize + 1});
+        }
+    }
+    return indices;
+}
+
+Vector3 gridPosition(const UnsignedInt i) {
+    const UnsignedInt x = i % (GridSize + 1), y = i/(GridSize + 1);
+    return {Float(x), Float(y), Float((x*7 + y*3) % 11)*0.1f};
+}
+
+/* Flat non-indexed positions, i.e. what an importer gives back before
+   duplicates are removed */
+std::vector<Vector3> flatGridPositions() {
+    std::vector<Vector3> positions;
+    positions.reserve(IndexCount);
+    for(UnsignedInt i: gridIndices()) positions.push_back(gridPosition(i));
+    return positions;
+}
+
+}
+
+MeshProcessingBenchmark::MeshProcessingBenchmark() {
+    addBenchmarks({&MeshProcessingBenchmark::removeDuplicates,
+                   &MeshProcessingBenchmark::removeDuplicatesExact,
+                   &MeshProcessingBenchmark::combineIndexedArrays,
+                   &MeshProcessingBenchmark::tipsify,
+                   &MeshProcessingBenchmark::compressIndices}, 3);
+}
+
+void MeshProcessingBenchmark::removeDuplicates() {
+    setTestCaseDescription(std::to_string(IndexCount) + " vertices");
+
+    const std::vector<Vector3> original = flatGridPositions();
+    std::vector<Vector3> positions;
+    std::vector<UnsignedInt> indices;
+    CORRADE_BENCHMARK(1) {
+        positions = original;
+        indices = MeshTools::removeDuplicates(positions);
+    }
+
+    CORRADE_COMPARE(positions.size(), VertexCount);
+    CORRADE_COMPARE(indices.size(), IndexCount);
+}
+
+void MeshProcessingBenchmark::removeDuplicatesExact() {
+    setTestCaseDescription(std::to_string(IndexCount) + " vertices");
+
+    const std::vector<Vector3> original = flatGridPositions();
+    std::vector<Vector3> positions;
+    std::vector<UnsignedInt> indices;
+    CORRADE_BENCHMARK(1) {
+        positions = original;
+        indices = MeshTools::removeDuplicatesExact(positions);
+    }
+
+    CORRADE_COMPARE(positions.size(), VertexCount);
+    CORRADE_COMPARE(indices.size(), IndexCount);
+}
+
+void MeshProcessingBenchmark::combineIndexedArrays() {
+    setTestCaseDescription(std::to_string(IndexCount) + " vertices, 3 attributes");
+
+    /* Positions indexed by the grid, normals by a per-face scheme and texture
+       coordinates by a narrower tiling, similarly to an OBJ file */
+    std::vector<UnsignedInt> positionIndices = gridIndices();
+    std::vector<UnsignedInt> normalIndices(IndexCount);
+    std::vector<UnsignedInt> textureCoordinateIndices(IndexCount);
+    for(std::size_t i = 0; i != IndexCount; ++i) {
+        normalIndices[i] = i/6 % 64;
+        textureCoordinateIndices[i] = positionIndices[i] % 4096;
+    }
+
+    std::vector<Vector3> originalPositions(VertexCount);
+    for(UnsignedInt i = 0; i != VertexCount; ++i)
+        originalPositions[i] = gridPosition(i);
+    const std::vector<Vector3> originalNormals(64, Vector3::zAxis());
+    const std::vector<Vector2> originalTextureCoordinates(4096);
+
+    std::vector<UnsignedInt> indices;
+    std::vector<Vector3> positions, normals;
+    std::vector<Vector2> textureCoordinates;
+    CORRADE_BENCHMARK(1) {
+        positions = originalPositions;
+        normals = originalNormals;
+        textureCoordinates = originalTextureCoordinates;
+        indices = MeshTools::combineIndexedArrays(
+            std::make_pair(std::cref(positionIndices), std::ref(positions)),
+            std::make_pair(std::cref(normalIndices), std::ref(normals)),
+            std::make_pair(std::cref(textureCoordinateIndices), std::ref(textureCoordinates)));
+    }
+
+    CORRADE_COMPARE(indices.size(), IndexCount);
+    CORRADE_COMPARE_AS(positions.size(), std::size_t(VertexCount), TestSuite::Compare::GreaterOrEqual);
+}
+
+void MeshProcessingBenchmark::tipsify() {
+    setTestCaseDescription(std::to_string(IndexCount/3) + " triangles");
+
+    const std::vector<UnsignedInt> original = gridIndices();
+    std::vector<UnsignedInt> indices;
+    CORRADE_BENCHMARK(1) {
+        indices = original;
+        MeshTools::tipsify(indices, VertexCount, 24);
+    }
+
+    CORRADE_COMPARE(indices.size(), IndexCount);
+}
+
+void MeshProcessingBenchmark::compressIndices() {
+    setTestCaseDescription(std::to_string(IndexCount) + " indices");
+
+    const std::vector<UnsignedInt> indices = gridIndices();
+    Containers::Array<char> data;
+    Mesh::IndexType type;
+    UnsignedInt start, end;
+    CORRADE_BENCHMARK(1)
+        std::tie(data, type, start, end) = MeshTools::compressIndices(indices);
+
+    CORRADE_COMPARE(type, Mesh::IndexType::UnsignedInt);
+    CORRADE_COMPARE(end, VertexCount - 1);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::MeshProcessingBenchmark)
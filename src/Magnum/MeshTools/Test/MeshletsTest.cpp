@@ -0,0 +1,181 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/MeshTools/Meshlets.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+struct MeshletsTest: TestSuite::Tester {
+    explicit MeshletsTest();
+
+    void generate();
+    void generateLimits();
+    void empty();
+    void invalid();
+
+    void backfacing();
+};
+
+MeshletsTest::MeshletsTest() {
+    addTests({&MeshletsTest::generate,
+              &MeshletsTest::generateLimits,
+              &MeshletsTest::empty,
+              &MeshletsTest::invalid,
+
+              &MeshletsTest::backfacing});
+}
+
+namespace {
+
+constexpr UnsignedInt GridSize = 16;
+
+/* Grid in the XY plane facing +Z, two triangles per cell */
+std::vector<Vector3> gridPositions() {
+    std::vector<Vector3> positions;
+    for(UnsignedInt y = 0; y <= GridSize; ++y)
+        for(UnsignedInt x = 0; x <= GridSize; ++x)
+            positions.emplace_back(Float(x), Float(y), 0.0f);
+    return positions;
+}
+
+std::vector<UnsignedInt> gridIndices() {
+    std::vector<UnsignedInt> indices;
+    for(UnsignedInt y = 0; y != GridSize; ++y) {
+        for(UnsignedInt x = 0; x != GridSize; ++x) {
+            const UnsignedInt i = y*(GridSize + 1) + x;
+            indices.insert(indices.end(), {
+                i, i + 1, i + GridSize + 2,
+                i, i + GridSize + 2, i + GridSize + 1});
+        }
+    }
+    return indices;
+}
+
+std::vector<Vector3ui> sortedTriangles(const std::vector<UnsignedInt>& indices) {
+    std::vector<Vector3ui> triangles;
+    for(std::size_t i = 0; i != indices.size(); i += 3)
+        triangles.emplace_back(indices[i], indices[i + 1], indices[i + 2]);
+    std::sort(triangles.begin(), triangles.end(), [](const Vector3ui& a, const Vector3ui& b) {
+        return std::lexicographical_compare(a.data(), a.data() + 3, b.data(), b.data() + 3);
+    });
+    return triangles;
+}
+
+void verifyMeshlets(const std::vector<Meshlet>& meshlets, const std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions, const UnsignedInt maxVertices, const UnsignedInt maxTriangles) {
+    UnsignedInt offset = 0;
+    for(const Meshlet& meshlet: meshlets) {
+        /* Ranges are contiguous and within limits */
+        CORRADE_COMPARE(meshlet.indexOffset, offset);
+        CORRADE_VERIFY(meshlet.indexCount > 0);
+        CORRADE_VERIFY(meshlet.indexCount <= maxTriangles*3);
+        CORRADE_VERIFY(meshlet.vertexCount <= maxVertices);
+        offset += meshlet.indexCount;
+
+        std::vector<UnsignedInt> vertices{indices.begin() + meshlet.indexOffset, indices.begin() + meshlet.indexOffset + meshlet.indexCount};
+        std::sort(vertices.begin(), vertices.end());
+        CORRADE_COMPARE(std::unique(vertices.begin(), vertices.end()) - vertices.begin(), meshlet.vertexCount);
+
+        /* Bounding sphere contains all vertices */
+        for(const UnsignedInt v: vertices)
+            CORRADE_VERIFY((positions[v] - meshlet.center).length() <= meshlet.radius*1.0001f);
+
+        /* Flat grid has all normals pointing up */
+        CORRADE_COMPARE(meshlet.coneAxis, Vector3::zAxis());
+        CORRADE_COMPARE(meshlet.coneCutoff, 1.0f);
+    }
+    CORRADE_COMPARE(offset, indices.size());
+}
+
+}
+
+void MeshletsTest::generate() {
+    const std::vector<Vector3> positions = gridPositions();
+    std::vector<UnsignedInt> indices = gridIndices();
+    const std::vector<Vector3ui> triangles = sortedTriangles(indices);
+
+    const std::vector<Meshlet> meshlets = MeshTools::generateMeshletsInPlace({indices.data(), indices.size()}, Containers::ArrayView<const Vector3>{positions.data(), positions.size()});
+
+    /* 512 triangles, 289 vertices */
+    CORRADE_VERIFY(meshlets.size() >= 5);
+    CORRADE_VERIFY(meshlets.size() < 40);
+    verifyMeshlets(meshlets, indices, positions, 64, 124);
+
+    /* Triangles are only reordered */
+    CORRADE_VERIFY(sortedTriangles(indices) == triangles);
+}
+
+void MeshletsTest::generateLimits() {
+    const std::vector<Vector3> positions = gridPositions();
+    std::vector<UnsignedInt> indices = gridIndices();
+
+    const std::vector<Meshlet> meshlets = MeshTools::generateMeshletsInPlace({indices.data(), indices.size()}, Containers::ArrayView<const Vector3>{positions.data(), positions.size()}, 16, 100);
+    CORRADE_VERIFY(meshlets.size() >= 512/18);
+    verifyMeshlets(meshlets, indices, positions, 16, 100);
+}
+
+void MeshletsTest::empty() {
+    CORRADE_VERIFY(MeshTools::generateMeshletsInPlace(nullptr, nullptr).empty());
+}
+
+void MeshletsTest::invalid() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    UnsignedInt indices[]{0, 1, 2, 0};
+    Vector3 positions[2];
+    MeshTools::generateMeshletsInPlace(indices, positions);
+    MeshTools::generateMeshletsInPlace(nullptr, positions, 2, 10);
+    MeshTools::generateMeshletsInPlace({indices, 3}, positions);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::generateMeshletsInPlace(): index count is not divisible by 3!\n"
+        "MeshTools::generateMeshletsInPlace(): expected at least 3 vertices and 1 triangle per meshlet but got 2 and 10\n"
+        "MeshTools::generateMeshletsInPlace(): index 2 out of range for 2 vertices\n");
+}
+
+void MeshletsTest::backfacing() {
+    Meshlet meshlet{0, 3, 3, {0.0f, 0.0f, 0.0f}, 1.0f, Vector3::zAxis(), 0.9f};
+
+    /* Camera below the meshlet sees only back sides */
+    CORRADE_VERIFY(MeshTools::isMeshletBackfacing(meshlet, {0.0f, 0.0f, -10.0f}));
+
+    /* Camera above or at the side doesn't */
+    CORRADE_VERIFY(!MeshTools::isMeshletBackfacing(meshlet, {0.0f, 0.0f, 10.0f}));
+    CORRADE_VERIFY(!MeshTools::isMeshletBackfacing(meshlet, {10.0f, 0.0f, -1.0f}));
+
+    /* Too close to the sphere to be sure */
+    CORRADE_VERIFY(!MeshTools::isMeshletBackfacing(meshlet, {0.0f, 0.0f, -1.2f}));
+
+    /* Cone too wide */
+    meshlet.coneCutoff = -0.1f;
+    CORRADE_VERIFY(!MeshTools::isMeshletBackfacing(meshlet, {0.0f, 0.0f, -10.0f}));
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::MeshletsTest)
@@ -0,0 +1,325 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <random>
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/Optimize.h"
+#include "Magnum/MeshTools/Tipsify.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+struct OptimizeTest: TestSuite::Tester {
+    explicit OptimizeTest();
+
+    void vertexCacheMissRatio();
+    void vertexCacheMissRatioWrongIndexCount();
+
+    void vertexCache();
+    void vertexCacheEmpty();
+    void vertexCacheWrongIndexCount();
+    void vertexCacheIndexOutOfRange();
+
+    void overdraw();
+    void overdrawDegenerateFirstTriangle();
+    void vertexFetch();
+
+    void benchmarkTipsify();
+    void benchmarkVertexCache();
+    void benchmarkOverdraw();
+    void benchmarkVertexFetch();
+};
+
+OptimizeTest::OptimizeTest() {
+    addTests({&OptimizeTest::vertexCacheMissRatio,
+              &OptimizeTest::vertexCacheMissRatioWrongIndexCount,
+
+              &OptimizeTest::vertexCache,
+              &OptimizeTest::vertexCacheEmpty,
+              &OptimizeTest::vertexCacheWrongIndexCount,
+              &OptimizeTest::vertexCacheIndexOutOfRange,
+
+              &OptimizeTest::overdraw,
+              &OptimizeTest::overdrawDegenerateFirstTriangle,
+              &OptimizeTest::vertexFetch});
+
+    addBenchmarks({&OptimizeTest::benchmarkTipsify,
+                   &OptimizeTest::benchmarkVertexCache,
+                   &OptimizeTest::benchmarkOverdraw,
+                   &OptimizeTest::benchmarkVertexFetch}, 5);
+}
+
+namespace {
+
+constexpr UnsignedInt GridSize = 64;
+
+/* (GridSize + 1)^2 vertices on a slightly curved sheet, two triangles per
+   cell, with triangle order shuffled to have a bad cache behavior */
+std::vector<Vector3> gridPositions() {
+    std::vector<Vector3> positions;
+    positions.reserve((GridSize + 1)*(GridSize + 1));
+    for(UnsignedInt y = 0; y <= GridSize; ++y)
+        for(UnsignedInt x = 0; x <= GridSize; ++x)
+            positions.emplace_back(Float(x), Float(y), Float((x - GridSize/2)*(x - GridSize/2))*0.01f);
+    return positions;
+}
+
+std::vector<UnsignedInt> shuffledGridIndices() {
+    std::vector<Vector3ui> triangles;
+    for(UnsignedInt y = 0; y != GridSize; ++y) {
+        for(UnsignedInt x = 0; x != GridSize; ++x) {
+            const UnsignedInt i = y*(GridSize + 1) + x;
+            triangles.emplace_back(i, i + 1, i + GridSize + 2);
+            triangles.emplace_back(i, i + GridSize + 2, i + GridSize + 1);
+        }
+    }
+
+    std::shuffle(triangles.begin(), triangles.end(), std::minstd_rand{});
+
+    std::vector<UnsignedInt> indices;
+    indices.reserve(triangles.size()*3);
+    for(const Vector3ui& t: triangles)
+        indices.insert(indices.end(), {t[0], t[1], t[2]});
+    return indices;
+}
+
+/* Triangles rotated so the smallest index is first and sorted, to compare
+   that two index buffers contain the same triangles with the same winding */
+std::vector<Vector3ui> canonicalTriangles(const std::vector<UnsignedInt>& indices) {
+    std::vector<Vector3ui> triangles;
+    for(std::size_t i = 0; i != indices.size(); i += 3) {
+        Vector3ui t{indices[i], indices[i + 1], indices[i + 2]};
+        while(t[0] > t[1] || t[0] > t[2]) t = {t[1], t[2], t[0]};
+        triangles.push_back(t);
+    }
+    std::sort(triangles.begin(), triangles.end(), [](const Vector3ui& a, const Vector3ui& b) {
+        return std::lexicographical_compare(a.data(), a.data() + 3, b.data(), b.data() + 3);
+    });
+    return triangles;
+}
+
+}
+
+void OptimizeTest::vertexCacheMissRatio() {
+    const UnsignedInt indices[]{
+        0, 1, 2,
+        2, 1, 3,
+        3, 4, 5,
+        0, 1, 2
+    };
+
+    /* 6 misses for 4 triangles with large enough cache */
+    CORRADE_COMPARE(MeshTools::vertexCacheMissRatio(indices, 6, 16), 1.5f);
+
+    /* With a cache of size 3, the vertex 0, 1 and 2 got evicted before the
+       last triangle */
+    CORRADE_COMPARE(MeshTools::vertexCacheMissRatio(indices, 6, 3), 2.25f);
+
+    CORRADE_COMPARE(MeshTools::vertexCacheMissRatio(nullptr, 6, 3), 0.0f);
+}
+
+void OptimizeTest::vertexCacheMissRatioWrongIndexCount() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    const UnsignedInt indices[]{0, 1};
+    MeshTools::vertexCacheMissRatio(indices, 2, 16);
+    CORRADE_COMPARE(out.str(), "MeshTools::vertexCacheMissRatio(): index count is not divisible by 3!\n");
+}
+
+void OptimizeTest::vertexCache() {
+    const std::vector<Vector3> positions = gridPositions();
+    std::vector<UnsignedInt> indices = shuffledGridIndices();
+    const Containers::ArrayView<UnsignedInt> view{indices.data(), indices.size()};
+
+    const Float before = MeshTools::vertexCacheMissRatio(view, positions.size(), 32);
+    const std::vector<Vector3ui> triangles = canonicalTriangles(indices);
+
+    MeshTools::optimizeVertexCacheInPlace(view, positions.size(), 32);
+    const Float after = MeshTools::vertexCacheMissRatio(view, positions.size(), 32);
+
+    /* The same triangles, just reordered */
+    CORRADE_COMPARE(indices.size(), triangles.size()*3);
+    CORRADE_VERIFY(canonicalTriangles(indices) == triangles);
+
+    /* Shuffled grid is close to 3 misses per triangle, optimized one should
+       be well below 1 */
+    CORRADE_VERIFY(before > 2.0f);
+    CORRADE_VERIFY(after < 1.0f);
+
+    /* And it should be on par with Tipsify */
+    std::vector<UnsignedInt> tipsified = shuffledGridIndices();
+    MeshTools::tipsify(tipsified, positions.size(), 32);
+    const Float tipsify = MeshTools::vertexCacheMissRatio({tipsified.data(), tipsified.size()}, positions.size(), 32);
+    CORRADE_VERIFY(after <= tipsify*1.1f);
+}
+
+void OptimizeTest::vertexCacheEmpty() {
+    /* Shouldn't crash or assert */
+    MeshTools::optimizeVertexCacheInPlace(nullptr, 0);
+    CORRADE_VERIFY(true);
+}
+
+void OptimizeTest::vertexCacheWrongIndexCount() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    UnsignedInt indices[]{0, 1};
+    MeshTools::optimizeVertexCacheInPlace(indices, 2);
+    MeshTools::optimizeVertexCacheInPlace(nullptr, 2, 3);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::optimizeVertexCacheInPlace(): index count is not divisible by 3!\n"
+        "MeshTools::optimizeVertexCacheInPlace(): cache size has to be larger than 3\n");
+}
+
+void OptimizeTest::vertexCacheIndexOutOfRange() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    UnsignedInt indices[]{0, 1, 3};
+    MeshTools::optimizeVertexCacheInPlace(indices, 3);
+    CORRADE_COMPARE(out.str(), "MeshTools::optimizeVertexCacheInPlace(): index 3 out of range for 3 vertices\n");
+}
+
+void OptimizeTest::overdraw() {
+    const std::vector<Vector3> positions = gridPositions();
+    std::vector<UnsignedInt> indices = shuffledGridIndices();
+    const Containers::ArrayView<UnsignedInt> view{indices.data(), indices.size()};
+
+    MeshTools::optimizeVertexCacheInPlace(view, positions.size(), 32);
+    const Float before = MeshTools::vertexCacheMissRatio(view, positions.size(), 32);
+    const std::vector<Vector3ui> triangles = canonicalTriangles(indices);
+
+    MeshTools::optimizeOverdrawInPlace(view, Containers::ArrayView<const Vector3>{positions.data(), positions.size()}, 32, 1.05f);
+    const Float after = MeshTools::vertexCacheMissRatio(view, positions.size(), 32);
+
+    /* Triangles are kept, cache efficiency gets worse only by a bit */
+    CORRADE_VERIFY(canonicalTriangles(indices) == triangles);
+    CORRADE_VERIFY(after <= before*1.1f);
+}
+
+void OptimizeTest::overdrawDegenerateFirstTriangle() {
+    const Vector3 positions[]{
+        {0.0f, 0.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f},
+        {1.0f, 1.0f, 0.0f},
+        {0.0f, 0.0f, 1.0f},
+        {1.0f, 0.0f, 1.0f}
+    };
+
+    /* The first triangle has only two cache misses, so the first hard
+       cluster boundary would be after it if it wasn't always added */
+    std::vector<UnsignedInt> indices{
+        0, 0, 1,
+        2, 3, 4,
+        4, 3, 5
+    };
+    const std::vector<Vector3ui> triangles = canonicalTriangles(indices);
+
+    MeshTools::optimizeOverdrawInPlace({indices.data(), indices.size()}, Containers::ArrayView<const Vector3>{positions}, 32);
+    CORRADE_COMPARE(indices.size(), 9);
+    CORRADE_VERIFY(canonicalTriangles(indices) == triangles);
+}
+
+void OptimizeTest::vertexFetch() {
+    UnsignedInt indices[]{
+        4, 2, 0,
+        2, 4, 5,
+        5, 0, 2
+    };
+
+    const std::vector<UnsignedInt> order = MeshTools::optimizeVertexFetchInPlace(indices, 6);
+
+    /* Vertices are referenced in increasing order, unused vertices 1 and 3
+       are dropped */
+    CORRADE_COMPARE(std::vector<UnsignedInt>(indices, indices + 9), (std::vector<UnsignedInt>{
+        0, 1, 2,
+        1, 0, 3,
+        3, 2, 1}));
+    CORRADE_COMPARE(order, (std::vector<UnsignedInt>{4, 2, 0, 5}));
+}
+
+void OptimizeTest::benchmarkTipsify() {
+    const std::vector<Vector3> positions = gridPositions();
+    const std::vector<UnsignedInt> original = shuffledGridIndices();
+    std::vector<UnsignedInt> indices;
+
+    CORRADE_BENCHMARK(1) {
+        indices = original;
+        MeshTools::tipsify(indices, positions.size(), 32);
+    }
+
+    CORRADE_VERIFY(MeshTools::vertexCacheMissRatio({indices.data(), indices.size()}, positions.size(), 32) < 1.0f);
+}
+
+void OptimizeTest::benchmarkVertexCache() {
+    const std::vector<Vector3> positions = gridPositions();
+    const std::vector<UnsignedInt> original = shuffledGridIndices();
+    std::vector<UnsignedInt> indices;
+
+    CORRADE_BENCHMARK(1) {
+        indices = original;
+        MeshTools::optimizeVertexCacheInPlace({indices.data(), indices.size()}, positions.size(), 32);
+    }
+
+    CORRADE_VERIFY(MeshTools::vertexCacheMissRatio({indices.data(), indices.size()}, positions.size(), 32) < 1.0f);
+}
+
+void OptimizeTest::benchmarkOverdraw() {
+    const std::vector<Vector3> positions = gridPositions();
+    std::vector<UnsignedInt> original = shuffledGridIndices();
+    MeshTools::optimizeVertexCacheInPlace({original.data(), original.size()}, positions.size(), 32);
+    std::vector<UnsignedInt> indices;
+
+    CORRADE_BENCHMARK(1) {
+        indices = original;
+        MeshTools::optimizeOverdrawInPlace({indices.data(), indices.size()}, Containers::ArrayView<const Vector3>{positions.data(), positions.size()}, 32);
+    }
+
+    CORRADE_COMPARE(indices.size(), original.size());
+}
+
+void OptimizeTest::benchmarkVertexFetch() {
+    const std::vector<Vector3> positions = gridPositions();
+    std::vector<UnsignedInt> original = shuffledGridIndices();
+    MeshTools::optimizeVertexCacheInPlace({original.data(), original.size()}, positions.size(), 32);
+    std::vector<UnsignedInt> indices, order;
+
+    CORRADE_BENCHMARK(1) {
+        indices = original;
+        order = MeshTools::optimizeVertexFetchInPlace({indices.data(), indices.size()}, positions.size());
+    }
+
+    CORRADE_COMPARE(order.size(), positions.size());
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::OptimizeTest)
@@ -0,0 +1,194 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/MeshTools/Pack.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+struct PackTest: TestSuite::Tester {
+    explicit PackTest();
+
+    void packUnsigned();
+    void packSigned();
+    void packHalf();
+    void packHalfTyped();
+    void packNormals();
+    void packOctahedral();
+    void packPositions();
+    void packPositionsFlat();
+
+    void wrongSize();
+};
+
+PackTest::PackTest() {
+    addTests({&PackTest::packUnsigned,
+              &PackTest::packSigned,
+              &PackTest::packHalf,
+              &PackTest::packHalfTyped,
+              &PackTest::packNormals,
+              &PackTest::packOctahedral,
+              &PackTest::packPositions,
+              &PackTest::packPositionsFlat,
+
+              &PackTest::wrongSize});
+}
+
+void PackTest::packUnsigned() {
+    const Color4 in[]{
+        {1.0f, 0.0f, 0.5f, 1.0f},
+        {2.0f, -1.0f, 0.25f, 0.0f}
+    };
+    Color4ub out[2];
+    MeshTools::packInto<Color4ub, Color4>(in, out);
+
+    /* Values outside of the range are clamped */
+    CORRADE_COMPARE(out[0], (Color4ub{255, 0, 127, 255}));
+    CORRADE_COMPARE(out[1], (Color4ub{255, 0, 63, 0}));
+}
+
+void PackTest::packSigned() {
+    const Vector2 in[]{
+        {1.0f, -1.0f},
+        {-3.0f, 0.5f}
+    };
+    Math::Vector2<Short> out[2];
+    MeshTools::packInto<Math::Vector2<Short>, Vector2>(in, out);
+
+    CORRADE_COMPARE(out[0], (Math::Vector2<Short>{32767, -32767}));
+    CORRADE_COMPARE(out[1], (Math::Vector2<Short>{-32767, 16383}));
+}
+
+void PackTest::packHalf() {
+    const Vector3 in[]{
+        {1.0f, -2.0f, 0.5f}
+    };
+    Math::Vector<3, UnsignedShort> out[1];
+    MeshTools::packHalfInto<3>(in, out);
+
+    CORRADE_COMPARE(out[0], (Math::Vector<3, UnsignedShort>{0x3c00, 0xc000, 0x3800}));
+}
+
+void PackTest::packHalfTyped() {
+    const Vector3 in[]{
+        {1.0f, -2.0f, 0.5f},
+        {0.0f, 3.5f, -1.0f}
+    };
+    Vector3h out[2];
+    MeshTools::packHalfInto<3>(in, out);
+
+    CORRADE_COMPARE(out[0], (Vector3h{Half{UnsignedShort(0x3c00)}, Half{UnsignedShort(0xc000)}, Half{UnsignedShort(0x3800)}}));
+    CORRADE_COMPARE(Vector3{out[1]}, (Vector3{0.0f, 3.5f, -1.0f}));
+}
+
+void PackTest::packNormals() {
+    const Vector3 in[]{
+        {1.0f, 0.0f, -1.0f},
+        {0.0f, -1.0f, 0.0f}
+    };
+    UnsignedInt out[2];
+    MeshTools::packNormalsInto(in, out);
+
+    /* 511 in lowest bits, -511 (0x201) in highest, alpha is zero */
+    CORRADE_COMPARE(out[0], 0x1ff | 0x201 << 20);
+    CORRADE_COMPARE(out[1], 0x201 << 10);
+}
+
+void PackTest::packOctahedral() {
+    const Vector3 in[]{
+        Vector3::xAxis(),
+        -Vector3::zAxis(),
+        Vector3{1.0f, 1.0f, 1.0f}.normalized(),
+        Vector3{-0.3f, 0.5f, -0.8f}.normalized(),
+        Vector3{0.0f, -0.6f, 0.8f}
+    };
+    Math::Vector2<Short> out[5];
+    MeshTools::packOctahedralInto(in, out);
+
+    for(std::size_t i = 0; i != 5; ++i) {
+        const Vector3 unpacked = MeshTools::unpackOctahedral(out[i]);
+        CORRADE_VERIFY((unpacked - in[i]).length() < 0.0002f);
+    }
+}
+
+void PackTest::packPositions() {
+    const Vector3 in[]{
+        {-1.0f, 2.0f, 10.0f},
+        {3.0f, 4.0f, 20.0f},
+        {1.0f, 3.0f, 15.0f}
+    };
+    Math::Vector3<UnsignedShort> out[3];
+    const Range3D bounds = MeshTools::packPositionsInto(in, out);
+
+    CORRADE_COMPARE(bounds, (Range3D{{-1.0f, 2.0f, 10.0f}, {3.0f, 4.0f, 20.0f}}));
+    CORRADE_COMPARE(out[0], (Math::Vector3<UnsignedShort>{0, 0, 0}));
+    CORRADE_COMPARE(out[1], (Math::Vector3<UnsignedShort>{65535, 65535, 65535}));
+    CORRADE_COMPARE(out[2], (Math::Vector3<UnsignedShort>{32767, 32767, 32767}));
+
+    /* Dequantization gets the original back */
+    const Vector3 dequantized = bounds.min() + Math::unpack<Vector3>(out[2])*bounds.size();
+    CORRADE_VERIFY((dequantized - in[2]).length() < 0.001f);
+}
+
+void PackTest::packPositionsFlat() {
+    const Vector3 in[]{
+        {1.0f, 2.0f, 5.0f},
+        {3.0f, 2.0f, 5.0f}
+    };
+    Math::Vector3<UnsignedShort> out[2];
+    const Range3D bounds = MeshTools::packPositionsInto(in, out);
+
+    /* Zero-sized dimensions don't cause division by zero */
+    CORRADE_COMPARE(bounds, (Range3D{{1.0f, 2.0f, 5.0f}, {3.0f, 3.0f, 6.0f}}));
+    CORRADE_COMPARE(out[1], (Math::Vector3<UnsignedShort>{65535, 0, 0}));
+}
+
+void PackTest::wrongSize() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    Vector3 in[2];
+    UnsignedInt normals[1];
+    Math::Vector2<Short> octahedral[1];
+    Math::Vector3<UnsignedShort> positions[1];
+    Math::Vector3<Byte> bytes[1];
+    MeshTools::packInto<Math::Vector3<Byte>, Vector3>(in, bytes);
+    MeshTools::packNormalsInto(in, normals);
+    MeshTools::packOctahedralInto(in, octahedral);
+    MeshTools::packPositionsInto(in, positions);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::packInto(): expected output size 2 but got 1\n"
+        "MeshTools::packNormalsInto(): expected output size 2 but got 1\n"
+        "MeshTools::packOctahedralInto(): expected output size 2 but got 1\n"
+        "MeshTools::packPositionsInto(): expected output size 2 but got 1\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::PackTest)
@@ -23,9 +23,12 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <sstream>
 #include <Corrade/TestSuite/Tester.h>
 
+#include "Magnum/ThreadPool.h"
 #include "Magnum/Math/Vector2.h"
+#include "Magnum/Math/Vector3.h"
 #include "Magnum/MeshTools/RemoveDuplicates.h"
 
 namespace Magnum { namespace MeshTools { namespace Test {
@@ -34,10 +37,22 @@ struct RemoveDuplicatesTest: TestSuite::Tester {
     explicit RemoveDuplicatesTest();
 
     void removeDuplicates();
+    void removeDuplicatesEmpty();
+    void removeDuplicatesInPlace();
+    void removeDuplicatesInPlaceWrongIndexCount();
+    void removeDuplicatesParallel();
+    void removeDuplicatesExact();
+    void removeDuplicatesExactInPlace();
 };
 
 RemoveDuplicatesTest::RemoveDuplicatesTest() {
-    addTests({&RemoveDuplicatesTest::removeDuplicates});
+    addTests({&RemoveDuplicatesTest::removeDuplicates,
+              &RemoveDuplicatesTest::removeDuplicatesEmpty,
+              &RemoveDuplicatesTest::removeDuplicatesInPlace,
+              &RemoveDuplicatesTest::removeDuplicatesInPlaceWrongIndexCount,
+              &RemoveDuplicatesTest::removeDuplicatesParallel,
+              &RemoveDuplicatesTest::removeDuplicatesExact,
+              &RemoveDuplicatesTest::removeDuplicatesExactInPlace});
 }
 
 void RemoveDuplicatesTest::removeDuplicates() {
@@ -59,6 +74,97 @@ void RemoveDuplicatesTest::removeDuplicates() {
     }));
 }
 
+void RemoveDuplicatesTest::removeDuplicatesEmpty() {
+    std::vector<Vector3> data;
+    CORRADE_VERIFY(MeshTools::removeDuplicates(data).empty());
+    CORRADE_VERIFY(data.empty());
+}
+
+void RemoveDuplicatesTest::removeDuplicatesInPlace() {
+    Vector2i data[]{
+        {1, 0},
+        {2, 1},
+        {0, 4},
+        {1, 5},
+        {1, 0}
+    };
+    UnsignedInt indices[5];
+
+    CORRADE_COMPARE(MeshTools::removeDuplicatesInPlace(Containers::ArrayView<Vector2i>{data}, Containers::ArrayView<UnsignedInt>{indices}, 2), 2);
+    CORRADE_COMPARE(indices[0], 0);
+    CORRADE_COMPARE(indices[1], 0);
+    CORRADE_COMPARE(indices[2], 1);
+    CORRADE_COMPARE(indices[3], 1);
+    CORRADE_COMPARE(indices[4], 0);
+    CORRADE_COMPARE(data[0], (Vector2i{1, 0}));
+    CORRADE_COMPARE(data[1], (Vector2i{0, 4}));
+}
+
+void RemoveDuplicatesTest::removeDuplicatesInPlaceWrongIndexCount() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    Vector2i data[3];
+    UnsignedInt indices[2];
+    MeshTools::removeDuplicatesInPlace(Containers::ArrayView<Vector2i>{data}, Containers::ArrayView<UnsignedInt>{indices});
+    CORRADE_COMPARE(out.str(), "MeshTools::removeDuplicatesInPlace(): expected 3 indices but got 2\n");
+}
+
+void RemoveDuplicatesTest::removeDuplicatesParallel() {
+    /* Grid of points with each point repeated and slightly perturbed, enough
+       of them to span multiple chunks */
+    std::vector<Vector3> data;
+    for(Int x = 0; x != 40; ++x) for(Int y = 0; y != 40; ++y) for(Int z = 0; z != 8; ++z) {
+        data.emplace_back(Float(x), Float(y), Float(z));
+        data.emplace_back(Float(x) + 0.001f, Float(y), Float(z) + 0.001f);
+    }
+    std::vector<Vector3> expectedData = data;
+
+    const std::vector<UnsignedInt> expectedIndices = MeshTools::removeDuplicates(expectedData, 0.01f);
+    CORRADE_COMPARE(expectedData.size(), 40*40*8);
+
+    ThreadPool pool{4};
+    const std::vector<UnsignedInt> indices = MeshTools::removeDuplicates(data, pool, 0.01f);
+    CORRADE_COMPARE(indices, expectedIndices);
+    CORRADE_COMPARE(data, expectedData);
+}
+
+void RemoveDuplicatesTest::removeDuplicatesExact() {
+    std::vector<Vector2i> data{
+        {1, 0},
+        {2, 1},
+        {1, 0},
+        {0, 4},
+        {2, 1},
+        {1, 1}
+    };
+
+    const std::vector<UnsignedInt> indices = MeshTools::removeDuplicatesExact(data);
+    CORRADE_COMPARE(indices, (std::vector<UnsignedInt>{0, 1, 0, 2, 1, 3}));
+    CORRADE_COMPARE(data, (std::vector<Vector2i>{
+        {1, 0},
+        {2, 1},
+        {0, 4},
+        {1, 1}
+    }));
+}
+
+void RemoveDuplicatesTest::removeDuplicatesExactInPlace() {
+    Vector3 data[]{
+        {1.0f, 0.0f, 0.5f},
+        {1.0f, 0.0f, 0.5f},
+        {1.0f, 0.0f, 0.50001f}
+    };
+    UnsignedInt indices[3];
+
+    /* No tolerance, so the last one is kept */
+    CORRADE_COMPARE(MeshTools::removeDuplicatesExactInPlace(Containers::ArrayView<Vector3>{data}, Containers::ArrayView<UnsignedInt>{indices}), 2);
+    CORRADE_COMPARE(indices[0], 0);
+    CORRADE_COMPARE(indices[1], 0);
+    CORRADE_COMPARE(indices[2], 1);
+    CORRADE_COMPARE(data[1], (Vector3{1.0f, 0.0f, 0.50001f}));
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::MeshTools::Test::RemoveDuplicatesTest)
@@ -0,0 +1,184 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/Simplify.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+struct SimplifyTest: TestSuite::Tester {
+    explicit SimplifyTest();
+
+    void flat();
+    void maxError();
+    void empty();
+    void wrongIndexCount();
+    void indexOutOfRange();
+
+    void lodChain();
+    void lodChainInvalid();
+};
+
+SimplifyTest::SimplifyTest() {
+    addTests({&SimplifyTest::flat,
+              &SimplifyTest::maxError,
+              &SimplifyTest::empty,
+              &SimplifyTest::wrongIndexCount,
+              &SimplifyTest::indexOutOfRange,
+
+              &SimplifyTest::lodChain,
+              &SimplifyTest::lodChainInvalid});
+}
+
+namespace {
+
+constexpr UnsignedInt GridSize = 16;
+
+/* Grid in the XY plane with Z given by a function, two triangles per cell */
+template<class F> std::vector<Vector3> gridPositions(F height) {
+    std::vector<Vector3> positions;
+    for(UnsignedInt y = 0; y <= GridSize; ++y)
+        for(UnsignedInt x = 0; x <= GridSize; ++x)
+            positions.emplace_back(Float(x), Float(y), height(Float(x), Float(y)));
+    return positions;
+}
+
+std::vector<UnsignedInt> gridIndices() {
+    std::vector<UnsignedInt> indices;
+    for(UnsignedInt y = 0; y != GridSize; ++y) {
+        for(UnsignedInt x = 0; x != GridSize; ++x) {
+            const UnsignedInt i = y*(GridSize + 1) + x;
+            indices.insert(indices.end(), {
+                i, i + 1, i + GridSize + 2,
+                i, i + GridSize + 2, i + GridSize + 1});
+        }
+    }
+    return indices;
+}
+
+/* Sum of triangle areas, negative if any triangle faces down */
+Float projectedArea(const std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions) {
+    Float area = 0.0f;
+    for(std::size_t i = 0; i != indices.size(); i += 3) {
+        const Vector3& p0 = positions[indices[i]];
+        const Float z = Math::cross(positions[indices[i + 1]] - p0, positions[indices[i + 2]] - p0).z();
+        if(z <= 0.0f) return -1.0f;
+        area += z*0.5f;
+    }
+    return area;
+}
+
+}
+
+void SimplifyTest::flat() {
+    const std::vector<Vector3> positions = gridPositions([](Float, Float) { return 0.0f; });
+    const std::vector<UnsignedInt> indices = gridIndices();
+
+    const std::vector<UnsignedInt> simplified = MeshTools::simplify({indices.data(), indices.size()}, Containers::ArrayView<const Vector3>{positions.data(), positions.size()}, indices.size()/4);
+    CORRADE_VERIFY(simplified.size() < indices.size()/2);
+    CORRADE_VERIFY(!(simplified.size()%3));
+
+    /* Boundary is kept and no triangle is flipped, so the area covered stays
+       the same */
+    CORRADE_COMPARE(projectedArea(simplified, positions), Float(GridSize*GridSize));
+}
+
+void SimplifyTest::maxError() {
+    /* Curved along X, straight along Y */
+    const std::vector<Vector3> positions = gridPositions([](Float x, Float) { return x*x*0.1f; });
+    const std::vector<UnsignedInt> indices = gridIndices();
+
+    const std::vector<UnsignedInt> unlimited = MeshTools::simplify({indices.data(), indices.size()}, Containers::ArrayView<const Vector3>{positions.data(), positions.size()}, 0);
+    const std::vector<UnsignedInt> limited = MeshTools::simplify({indices.data(), indices.size()}, Containers::ArrayView<const Vector3>{positions.data(), positions.size()}, 0, 0.001f);
+
+    /* Collapses along the straight direction are free, so even the limited
+       one is simplified, but not as much as the unlimited one */
+    CORRADE_VERIFY(limited.size() < indices.size());
+    CORRADE_VERIFY(limited.size() > unlimited.size());
+}
+
+void SimplifyTest::empty() {
+    CORRADE_VERIFY(MeshTools::simplify(nullptr, nullptr, 0).empty());
+}
+
+void SimplifyTest::wrongIndexCount() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    const UnsignedInt indices[]{0, 1};
+    MeshTools::simplify(indices, nullptr, 0);
+    CORRADE_COMPARE(out.str(), "MeshTools::simplify(): index count is not divisible by 3!\n");
+}
+
+void SimplifyTest::indexOutOfRange() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    const UnsignedInt indices[]{0, 1, 2};
+    Vector3 positions[2];
+    MeshTools::simplify(indices, Containers::ArrayView<const Vector3>{positions}, 0);
+    CORRADE_COMPARE(out.str(), "MeshTools::simplify(): index 2 out of range for 2 vertices\n");
+}
+
+void SimplifyTest::lodChain() {
+    const std::vector<Vector3> positions = gridPositions([](Float, Float) { return 0.0f; });
+    std::vector<UnsignedInt> indices = gridIndices();
+    const std::size_t originalSize = indices.size();
+
+    const std::vector<std::pair<UnsignedInt, UnsignedInt>> levels = MeshTools::generateLodChain(indices, Containers::ArrayView<const Vector3>{positions.data(), positions.size()}, 3);
+    CORRADE_COMPARE(levels.size(), 3);
+
+    /* First level is the original mesh, the others are appended after each
+       other and are progressively smaller */
+    CORRADE_COMPARE(levels[0].first, 0);
+    CORRADE_COMPARE(levels[0].second, originalSize);
+    for(std::size_t i = 1; i != levels.size(); ++i) {
+        CORRADE_COMPARE(levels[i].first, levels[i - 1].first + levels[i - 1].second);
+        CORRADE_VERIFY(levels[i].second < levels[i - 1].second);
+
+        const std::vector<UnsignedInt> level{indices.begin() + levels[i].first, indices.begin() + levels[i].first + levels[i].second};
+        CORRADE_COMPARE(projectedArea(level, positions), Float(GridSize*GridSize));
+    }
+    CORRADE_COMPARE(indices.size(), levels.back().first + levels.back().second);
+}
+
+void SimplifyTest::lodChainInvalid() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    std::vector<UnsignedInt> indices;
+    MeshTools::generateLodChain(indices, nullptr, 0);
+    MeshTools::generateLodChain(indices, nullptr, 2, 1.0f);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::generateLodChain(): expected at least one level\n"
+        "MeshTools::generateLodChain(): expected ratio between 0 and 1 but got 1\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::SimplifyTest)
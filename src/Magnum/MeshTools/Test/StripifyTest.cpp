@@ -0,0 +1,169 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/MeshTools/Stripify.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+struct StripifyTest: Corrade::TestSuite::Tester {
+    explicit StripifyTest();
+
+    void empty();
+    void quad();
+    void disconnected();
+    void inconsistentWinding();
+    void grid();
+
+    void wrongIndexCount();
+    void restartIndexInInput();
+};
+
+StripifyTest::StripifyTest() {
+    addTests({&StripifyTest::empty,
+              &StripifyTest::quad,
+              &StripifyTest::disconnected,
+              &StripifyTest::inconsistentWinding,
+              &StripifyTest::grid,
+
+              &StripifyTest::wrongIndexCount,
+              &StripifyTest::restartIndexInInput});
+}
+
+namespace {
+
+/* Triangle rotated so the smallest index is first, to compare triangles
+   regardless of which vertex they start with but still with their winding */
+std::vector<UnsignedInt> normalizedTriangle(UnsignedInt a, UnsignedInt b, UnsignedInt c) {
+    if(b < a && b < c) return {b, c, a};
+    if(c < a && c < b) return {c, a, b};
+    return {a, b, c};
+}
+
+/* Convert strips back to a sorted list of triangles */
+std::vector<std::vector<UnsignedInt>> unstripify(const std::vector<UnsignedInt>& strips, UnsignedInt primitiveRestartIndex) {
+    std::vector<std::vector<UnsignedInt>> triangles;
+    std::size_t begin = 0;
+    for(std::size_t i = 0; i <= strips.size(); ++i) {
+        if(i != strips.size() && strips[i] != primitiveRestartIndex) continue;
+
+        for(std::size_t j = begin; j + 2 < i; ++j) {
+            if((j - begin)%2 == 0)
+                triangles.push_back(normalizedTriangle(strips[j], strips[j + 1], strips[j + 2]));
+            else
+                triangles.push_back(normalizedTriangle(strips[j + 1], strips[j], strips[j + 2]));
+        }
+
+        begin = i + 1;
+    }
+
+    std::sort(triangles.begin(), triangles.end());
+    return triangles;
+}
+
+std::vector<std::vector<UnsignedInt>> triangles(const std::vector<UnsignedInt>& indices) {
+    std::vector<std::vector<UnsignedInt>> triangles;
+    for(std::size_t i = 0; i != indices.size(); i += 3)
+        triangles.push_back(normalizedTriangle(indices[i], indices[i + 1], indices[i + 2]));
+    std::sort(triangles.begin(), triangles.end());
+    return triangles;
+}
+
+}
+
+void StripifyTest::empty() {
+    CORRADE_COMPARE(stripify({}, 0xffff), std::vector<UnsignedInt>{});
+}
+
+void StripifyTest::quad() {
+    /*
+        0 --- 1
+        |   / |
+        | /   |
+        2 --- 3
+    */
+    CORRADE_COMPARE(stripify({0, 2, 1, 1, 2, 3}, 0xffff),
+        (std::vector<UnsignedInt>{0, 2, 1, 3}));
+
+    /* The first triangle is rotated so the strip can continue */
+    CORRADE_COMPARE(stripify({1, 0, 2, 1, 2, 3}, 0xffff),
+        (std::vector<UnsignedInt>{0, 2, 1, 3}));
+}
+
+void StripifyTest::disconnected() {
+    CORRADE_COMPARE(stripify({0, 1, 2, 3, 4, 5}, 0xffff),
+        (std::vector<UnsignedInt>{0, 1, 2, 0xffff, 3, 4, 5}));
+}
+
+void StripifyTest::inconsistentWinding() {
+    /* The second triangle has the shared edge in the same direction, joining
+       them into a strip would flip its winding */
+    CORRADE_COMPARE(stripify({0, 2, 1, 2, 1, 3}, 0xff),
+        (std::vector<UnsignedInt>{0, 2, 1, 0xff, 2, 1, 3}));
+}
+
+void StripifyTest::grid() {
+    /* 8x8 grid of quads, each row should end up as a single strip */
+    std::vector<UnsignedInt> indices;
+    for(UnsignedInt y = 0; y != 8; ++y) for(UnsignedInt x = 0; x != 8; ++x) {
+        const UnsignedInt a = y*9 + x;
+        indices.insert(indices.end(), {a, a + 9, a + 1, a + 1, a + 9, a + 10});
+    }
+
+    const std::vector<UnsignedInt> strips = stripify(indices, 0xffff);
+    CORRADE_COMPARE(strips.size(), 8*18 + 7);
+    CORRADE_COMPARE(std::count(strips.begin(), strips.end(), 0xffff), 7);
+    CORRADE_COMPARE(unstripify(strips, 0xffff), triangles(indices));
+}
+
+void StripifyTest::wrongIndexCount() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    stripify({0, 1}, 0xffff);
+    CORRADE_COMPARE(out.str(), "MeshTools::stripify(): index count not divisible by 3\n");
+}
+
+void StripifyTest::restartIndexInInput() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    stripify({0, 1, 2, 3, 0xff, 5}, 0xff);
+    CORRADE_COMPARE(out.str(), "MeshTools::stripify(): index 4 is equal to the primitive restart index\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::StripifyTest)
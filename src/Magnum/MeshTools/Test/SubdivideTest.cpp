@@ -36,6 +36,8 @@ struct SubdivideTest: TestSuite::Tester {
 
     void wrongIndexCount();
     void subdivide();
+    void subdivideSharedWrongIndexCount();
+    void subdivideShared();
 };
 
 namespace {
@@ -48,7 +50,9 @@ inline Vector1 interpolator(Vector1 a, Vector1 b) { return (a[0]+b[0])/2; }
 
 SubdivideTest::SubdivideTest() {
     addTests({&SubdivideTest::wrongIndexCount,
-              &SubdivideTest::subdivide});
+              &SubdivideTest::subdivide,
+              &SubdivideTest::subdivideSharedWrongIndexCount,
+              &SubdivideTest::subdivideShared});
 }
 
 void SubdivideTest::wrongIndexCount() {
@@ -72,6 +76,28 @@ void SubdivideTest::subdivide() {
     CORRADE_COMPARE(indices, (std::vector<UnsignedInt>{4, 5, 6, 7, 8, 9, 0, 4, 6, 4, 1, 5, 6, 5, 2, 1, 7, 9, 7, 2, 8, 9, 8, 3}));
 }
 
+void SubdivideTest::subdivideSharedWrongIndexCount() {
+    std::stringstream ss;
+    Error redirectError{&ss};
+
+    std::vector<Vector1> positions;
+    std::vector<UnsignedInt> indices{0, 1};
+    MeshTools::subdivideShared(indices, positions, interpolator);
+    CORRADE_COMPARE(ss.str(), "MeshTools::subdivideShared(): index count is not divisible by 3!\n");
+}
+
+void SubdivideTest::subdivideShared() {
+    std::vector<Vector1> positions{0, 2, 6, 8};
+    std::vector<UnsignedInt> indices{0, 1, 2, 1, 2, 3};
+    MeshTools::subdivideShared(indices, positions, interpolator);
+
+    CORRADE_COMPARE(indices.size(), 24);
+
+    /* The vertex for the shared edge 1-2 is created only once */
+    CORRADE_VERIFY(positions == (std::vector<Vector1>{0, 2, 6, 8, 1, 4, 3, 7, 5}));
+    CORRADE_COMPARE(indices, (std::vector<UnsignedInt>{4, 5, 6, 5, 7, 8, 0, 4, 6, 4, 1, 5, 6, 5, 2, 1, 5, 8, 5, 2, 7, 8, 7, 3}));
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::MeshTools::Test::SubdivideTest)
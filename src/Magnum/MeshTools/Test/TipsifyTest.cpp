@@ -23,9 +23,14 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <algorithm>
+#include <sstream>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
 
 #include "Magnum/Magnum.h"
+#include "Magnum/ThreadPool.h"
+#include "Magnum/MeshTools/Optimize.h"
 #include "Magnum/MeshTools/Tipsify.h"
 
 namespace Magnum { namespace MeshTools { namespace Test {
@@ -35,6 +40,14 @@ struct TipsifyTest: TestSuite::Tester {
 
     void buildAdjacency();
     void tipsify();
+    void tipsifyInPlace();
+
+    void batch();
+    void batchThreadPool();
+    void batchNotBeneficial();
+    void batchEmpty();
+    void batchCancel();
+    void batchWrongSize();
 };
 
 /*
@@ -83,7 +96,15 @@ namespace {
 
 TipsifyTest::TipsifyTest() {
     addTests({&TipsifyTest::buildAdjacency,
-              &TipsifyTest::tipsify});
+              &TipsifyTest::tipsify,
+              &TipsifyTest::tipsifyInPlace,
+
+              &TipsifyTest::batch,
+              &TipsifyTest::batchThreadPool,
+              &TipsifyTest::batchNotBeneficial,
+              &TipsifyTest::batchEmpty,
+              &TipsifyTest::batchCancel,
+              &TipsifyTest::batchWrongSize});
 }
 
 void TipsifyTest::buildAdjacency() {
@@ -159,6 +180,199 @@ void TipsifyTest::tipsify() {
     }));
 }
 
+void TipsifyTest::tipsifyInPlace() {
+    std::vector<UnsignedInt> expected = Indices;
+    MeshTools::tipsify(expected, VertexCount, 3);
+
+    /* Operating on a plain array gives the same result */
+    UnsignedInt indices[19*3];
+    std::copy(Indices.begin(), Indices.end(), indices);
+    MeshTools::tipsifyInPlace(indices, VertexCount, 3);
+    CORRADE_COMPARE(std::vector<UnsignedInt>(indices, indices + 19*3), expected);
+}
+
+namespace {
+    /* Grid of n*n quads with triangles in a shuffled order */
+    std::vector<UnsignedInt> shuffledGrid(const UnsignedInt n) {
+        std::vector<UnsignedInt> indices;
+        for(UnsignedInt y = 0; y != n; ++y) for(UnsignedInt x = 0; x != n; ++x) {
+            const UnsignedInt a = y*(n + 1) + x;
+            const UnsignedInt c = a + n + 1;
+            indices.insert(indices.end(), {a, a + 1, c, a + 1, c + 1, c});
+        }
+
+        /* Fisher-Yates with a fixed LCG so the result is reproducible */
+        UnsignedInt state = 1;
+        for(std::size_t i = indices.size()/3; i > 1; --i) {
+            state = state*1664525u + 1013904223u;
+            const std::size_t j = state % i;
+            std::swap_ranges(indices.begin() + (i - 1)*3, indices.begin() + i*3, indices.begin() + j*3);
+        }
+        return indices;
+    }
+}
+
+void TipsifyTest::batch() {
+    std::vector<UnsignedInt> a = Indices;
+    std::vector<UnsignedInt> b = shuffledGrid(12);
+    std::vector<UnsignedInt> c = shuffledGrid(5);
+    std::vector<UnsignedInt> expectedA = a, expectedB = b, expectedC = c;
+    MeshTools::tipsify(expectedA, VertexCount, 3);
+    MeshTools::tipsify(expectedB, 13*13, 3);
+    MeshTools::tipsify(expectedC, 6*6, 3);
+
+    const Containers::ArrayView<UnsignedInt> meshes[]{
+        {a.data(), a.size()}, {b.data(), b.size()}, {c.data(), c.size()}};
+    const UnsignedInt vertexCounts[]{VertexCount, 13*13, 6*6};
+    TipsifyStatistics statistics[3];
+
+    MeshTools::TipsifyBatch batch;
+    CORRADE_COMPARE(batch.process(meshes, vertexCounts, 3, statistics), 3);
+
+    /* The same as the one-shot version */
+    CORRADE_VERIFY(statistics[0].processed);
+    CORRADE_VERIFY(statistics[0].applied);
+    CORRADE_COMPARE(a, expectedA);
+    CORRADE_VERIFY(statistics[1].processed);
+    CORRADE_VERIFY(statistics[1].applied);
+    CORRADE_COMPARE(b, expectedB);
+    CORRADE_VERIFY(statistics[2].processed);
+    CORRADE_VERIFY(statistics[2].applied);
+    CORRADE_COMPARE(c, expectedC);
+
+    /* ACMR is the same as calculated by vertexCacheMissRatio() */
+    CORRADE_COMPARE(statistics[0].acmrBefore, MeshTools::vertexCacheMissRatio({Indices.data(), Indices.size()}, VertexCount, 3));
+    CORRADE_COMPARE(statistics[0].acmrAfter, MeshTools::vertexCacheMissRatio({a.data(), a.size()}, VertexCount, 3));
+    CORRADE_COMPARE(statistics[1].acmrAfter, MeshTools::vertexCacheMissRatio({b.data(), b.size()}, 13*13, 3));
+    CORRADE_COMPARE_AS(statistics[1].acmrAfter, statistics[1].acmrBefore, TestSuite::Compare::Less);
+
+    /* ATVR is ACMR scaled by triangle/vertex ratio, at least one */
+    CORRADE_COMPARE(statistics[0].atvrBefore, statistics[0].acmrBefore*19.0f/VertexCount);
+    CORRADE_COMPARE(statistics[1].atvrAfter, statistics[1].acmrAfter*(12*12*2)/(13*13));
+    CORRADE_COMPARE_AS(statistics[1].atvrAfter, statistics[1].atvrBefore, TestSuite::Compare::Less);
+    CORRADE_COMPARE_AS(statistics[1].atvrAfter, 1.0f, TestSuite::Compare::GreaterOrEqual);
+}
+
+void TipsifyTest::batchThreadPool() {
+    std::vector<std::vector<UnsignedInt>> indices;
+    std::vector<UnsignedInt> vertexCounts;
+    for(UnsignedInt i = 0; i != 64; ++i) {
+        indices.push_back(shuffledGrid(2 + i % 13));
+        vertexCounts.push_back((3 + i % 13)*(3 + i % 13));
+    }
+
+    std::vector<std::vector<UnsignedInt>> expected = indices;
+    std::vector<Containers::ArrayView<UnsignedInt>> meshes;
+    for(std::size_t i = 0; i != indices.size(); ++i) {
+        MeshTools::tipsify(expected[i], vertexCounts[i], 8);
+        meshes.emplace_back(indices[i].data(), indices[i].size());
+    }
+
+    ThreadPool pool{4};
+    MeshTools::TipsifyBatch batch{pool};
+    std::vector<TipsifyStatistics> statistics(meshes.size());
+
+    /* Running twice reuses the scratch memory and gives the same result */
+    for(std::size_t run = 0; run != 2; ++run) {
+        std::vector<std::vector<UnsignedInt>> input = indices;
+        for(std::size_t i = 0; i != indices.size(); ++i)
+            meshes[i] = {input[i].data(), input[i].size()};
+
+        CORRADE_COMPARE(batch.process({meshes.data(), meshes.size()}, {vertexCounts.data(), vertexCounts.size()}, 8, {statistics.data(), statistics.size()}), 64);
+        for(std::size_t i = 0; i != indices.size(); ++i) {
+            CORRADE_VERIFY(statistics[i].processed);
+            if(statistics[i].applied) CORRADE_COMPARE(input[i], expected[i]);
+            else CORRADE_COMPARE(input[i], indices[i]);
+        }
+    }
+}
+
+void TipsifyTest::batchNotBeneficial() {
+    /* Already tipsified mesh doesn't get any better */
+    std::vector<UnsignedInt> a = Indices;
+    std::vector<UnsignedInt> b = shuffledGrid(12);
+    MeshTools::tipsify(a, VertexCount, 3);
+    const std::vector<UnsignedInt> originalA = a, originalB = b;
+
+    const Containers::ArrayView<UnsignedInt> meshes[]{
+        {a.data(), a.size()}, {b.data(), b.size()}};
+    const UnsignedInt vertexCounts[]{VertexCount, 13*13};
+    TipsifyStatistics statistics[2];
+
+    MeshTools::TipsifyBatch batch;
+    CORRADE_COMPARE(batch.process(meshes, vertexCounts, 3, statistics), 2);
+    CORRADE_VERIFY(statistics[0].processed);
+    CORRADE_VERIFY(!statistics[0].applied);
+    CORRADE_COMPARE(statistics[0].acmrAfter, statistics[0].acmrBefore);
+    CORRADE_COMPARE(a, originalA);
+    CORRADE_VERIFY(statistics[1].applied);
+
+    /* With a large enough minimal gain nothing gets applied */
+    b = originalB;
+    batch.setMinimalGain(3.0f);
+    CORRADE_COMPARE(batch.minimalGain(), 3.0f);
+    CORRADE_COMPARE(batch.process(meshes, vertexCounts, 3, statistics), 2);
+    CORRADE_VERIFY(statistics[1].processed);
+    CORRADE_VERIFY(!statistics[1].applied);
+    CORRADE_COMPARE_AS(statistics[1].acmrAfter, statistics[1].acmrBefore, TestSuite::Compare::Less);
+    CORRADE_COMPARE(b, originalB);
+}
+
+void TipsifyTest::batchEmpty() {
+    const Containers::ArrayView<UnsignedInt> meshes[1]{};
+    const UnsignedInt vertexCounts[]{0};
+    TipsifyStatistics statistics[1];
+
+    MeshTools::TipsifyBatch batch;
+    CORRADE_COMPARE(batch.process(meshes, vertexCounts, 3, statistics), 1);
+    CORRADE_VERIFY(statistics[0].processed);
+    CORRADE_VERIFY(!statistics[0].applied);
+    CORRADE_COMPARE(statistics[0].acmrBefore, 0.0f);
+    CORRADE_COMPARE(statistics[0].atvrAfter, 0.0f);
+
+    /* No meshes at all */
+    CORRADE_COMPARE(batch.process(nullptr, nullptr, 3, nullptr), 0);
+}
+
+void TipsifyTest::batchCancel() {
+    std::vector<UnsignedInt> a = Indices;
+    const Containers::ArrayView<UnsignedInt> meshes[]{{a.data(), a.size()}};
+    const UnsignedInt vertexCounts[]{VertexCount};
+    TipsifyStatistics statistics[1];
+
+    /* Cancelling with nothing in progress skips the next batch */
+    MeshTools::TipsifyBatch batch;
+    batch.cancel();
+    CORRADE_COMPARE(batch.process(meshes, vertexCounts, 3, statistics), 0);
+    CORRADE_VERIFY(!statistics[0].processed);
+    CORRADE_VERIFY(!statistics[0].applied);
+    CORRADE_COMPARE(a, Indices);
+
+    /* The cancellation was consumed, the batch is usable again */
+    CORRADE_COMPARE(batch.process(meshes, vertexCounts, 3, statistics), 1);
+    CORRADE_VERIFY(statistics[0].processed);
+    CORRADE_VERIFY(statistics[0].applied);
+}
+
+void TipsifyTest::batchWrongSize() {
+    std::stringstream ss;
+    Error redirectError{&ss};
+
+    UnsignedInt a[4]{};
+    const Containers::ArrayView<UnsignedInt> meshes[]{a, {a, 3}};
+    const UnsignedInt vertexCounts[]{1, 1};
+    TipsifyStatistics statistics[2];
+
+    MeshTools::TipsifyBatch batch;
+    batch.process(meshes, {vertexCounts, 1}, 3, statistics);
+    batch.process(meshes, vertexCounts, 3, {statistics, 1});
+    batch.process(meshes, vertexCounts, 3, statistics);
+    CORRADE_COMPARE(ss.str(),
+        "MeshTools::TipsifyBatch::process(): expected 2 vertex counts but got 1\n"
+        "MeshTools::TipsifyBatch::process(): expected 2 statistics but got 1\n"
+        "MeshTools::TipsifyBatch::process(): index count of mesh 0 is not divisible by 3\n");
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::MeshTools::Test::TipsifyTest)
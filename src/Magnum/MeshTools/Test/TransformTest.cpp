@@ -24,10 +24,13 @@
 */
 
 #include <array>
+#include <vector>
 #include <Corrade/TestSuite/Tester.h>
 
 #include "Magnum/Math/Matrix3.h"
+#include "Magnum/Math/Matrix4.h"
 #include "Magnum/Magnum.h"
+#include "Magnum/ThreadPool.h"
 #include "Magnum/MeshTools/Transform.h"
 
 namespace Magnum { namespace MeshTools { namespace Test {
@@ -40,6 +43,14 @@ struct TransformTest: TestSuite::Tester {
 
     void transformPoints2D();
     void transformPoints3D();
+
+    void transformVectorsBatch();
+    void transformPointsBatch();
+    void transformPointsBatchProjective();
+    void transformBatchParallel();
+
+    void benchmarkGeneric();
+    void benchmarkBatch();
 };
 
 TransformTest::TransformTest() {
@@ -47,7 +58,15 @@ TransformTest::TransformTest() {
               &TransformTest::transformVectors3D,
 
               &TransformTest::transformPoints2D,
-              &TransformTest::transformPoints3D});
+              &TransformTest::transformPoints3D,
+
+              &TransformTest::transformVectorsBatch,
+              &TransformTest::transformPointsBatch,
+              &TransformTest::transformPointsBatchProjective,
+              &TransformTest::transformBatchParallel});
+
+    addBenchmarks({&TransformTest::benchmarkGeneric,
+                   &TransformTest::benchmarkBatch}, 10);
 }
 
 constexpr static std::array<Vector2, 2> points2D{{
@@ -116,6 +135,100 @@ void TransformTest::transformPoints3D() {
     CORRADE_COMPARE(quaternion, points3DRotatedTranslated);
 }
 
+namespace {
+    /* Not a multiple of the internal block size to test the remainder
+       handling as well */
+    std::vector<Vector3> manyPoints(std::size_t count = 1000) {
+        std::vector<Vector3> out;
+        out.reserve(count);
+        for(std::size_t i = 0; i != count; ++i)
+            out.emplace_back(Float(i%17) - 8.0f, Float(i%23)*0.5f, Float(i%5) - 2.5f);
+        return out;
+    }
+}
+
+void TransformTest::transformVectorsBatch() {
+    const Matrix4 matrix = Matrix4::rotation(Deg(35.0f), Vector3{1.0f, 1.0f, -1.0f}.normalized())*Matrix4::scaling({2.0f, 0.5f, 1.5f});
+    const Quaternion quaternion = Quaternion::rotation(Deg(-75.0f), Vector3{0.0f, 1.0f, 1.0f}.normalized());
+
+    const std::vector<Vector3> original = manyPoints();
+    std::vector<Vector3> batchMatrix = original;
+    std::vector<Vector3> batchQuaternion = original;
+    MeshTools::transformVectorsInPlace(matrix, Containers::ArrayView<Vector3>{batchMatrix.data(), batchMatrix.size()});
+    MeshTools::transformVectorsInPlace(quaternion, Containers::ArrayView<Vector3>{batchQuaternion.data(), batchQuaternion.size()});
+
+    for(std::size_t i = 0; i != original.size(); ++i) {
+        CORRADE_COMPARE(batchMatrix[i], matrix.transformVector(original[i]));
+        CORRADE_COMPARE(batchQuaternion[i], quaternion.transformVectorNormalized(original[i]));
+    }
+}
+
+void TransformTest::transformPointsBatch() {
+    const Matrix4 matrix = Matrix4::translation({3.0f, -1.0f, 0.5f})*Matrix4::rotationX(Deg(60.0f));
+    const DualQuaternion dualQuaternion = DualQuaternion::translation({-2.0f, 4.0f, 1.0f})*DualQuaternion::rotation(Deg(120.0f), Vector3::yAxis());
+
+    const std::vector<Vector3> original = manyPoints();
+    std::vector<Vector3> batchMatrix = original;
+    std::vector<Vector3> batchDualQuaternion = original;
+    MeshTools::transformPointsInPlace(matrix, Containers::ArrayView<Vector3>{batchMatrix.data(), batchMatrix.size()});
+    MeshTools::transformPointsInPlace(dualQuaternion, Containers::ArrayView<Vector3>{batchDualQuaternion.data(), batchDualQuaternion.size()});
+
+    for(std::size_t i = 0; i != original.size(); ++i) {
+        CORRADE_COMPARE(batchMatrix[i], matrix.transformPoint(original[i]));
+        CORRADE_COMPARE(batchDualQuaternion[i], dualQuaternion.transformPointNormalized(original[i]));
+    }
+}
+
+void TransformTest::transformPointsBatchProjective() {
+    const Matrix4 matrix = Matrix4::perspectiveProjection(Deg(60.0f), 1.5f, 0.1f, 100.0f)*Matrix4::translation(Vector3::zAxis(-30.0f));
+
+    const std::vector<Vector3> original = manyPoints();
+    std::vector<Vector3> batch = original;
+    MeshTools::transformPointsInPlace(matrix, Containers::ArrayView<Vector3>{batch.data(), batch.size()});
+
+    for(std::size_t i = 0; i != original.size(); ++i)
+        CORRADE_COMPARE(batch[i], matrix.transformPoint(original[i]));
+}
+
+void TransformTest::transformBatchParallel() {
+    ThreadPool pool{4};
+
+    const Matrix4 matrix = Matrix4::translation({3.0f, -1.0f, 0.5f})*Matrix4::rotationY(Deg(15.0f));
+    const Quaternion quaternion = Quaternion::rotation(Deg(15.0f), Vector3::yAxis());
+
+    const std::vector<Vector3> original = manyPoints(100000);
+    std::vector<Vector3> points = original, pointsParallel = original;
+    std::vector<Vector3> vectors = original, vectorsParallel = original;
+    MeshTools::transformPointsInPlace(matrix, Containers::ArrayView<Vector3>{points.data(), points.size()});
+    MeshTools::transformPointsInPlace(matrix, Containers::ArrayView<Vector3>{pointsParallel.data(), pointsParallel.size()}, pool);
+    MeshTools::transformVectorsInPlace(quaternion, Containers::ArrayView<Vector3>{vectors.data(), vectors.size()});
+    MeshTools::transformVectorsInPlace(quaternion, Containers::ArrayView<Vector3>{vectorsParallel.data(), vectorsParallel.size()}, pool);
+
+    /* The same code runs on each chunk, so the results are bit-exact */
+    CORRADE_VERIFY(points == pointsParallel);
+    CORRADE_VERIFY(vectors == vectorsParallel);
+}
+
+void TransformTest::benchmarkGeneric() {
+    const Matrix4 matrix = Matrix4::translation({3.0f, -1.0f, 0.5f})*Matrix4::rotationX(Deg(60.0f));
+    std::vector<Vector3> points = manyPoints(100000);
+
+    CORRADE_BENCHMARK(1)
+        MeshTools::transformPointsInPlace(matrix, points);
+
+    CORRADE_VERIFY(!points.empty());
+}
+
+void TransformTest::benchmarkBatch() {
+    const Matrix4 matrix = Matrix4::translation({3.0f, -1.0f, 0.5f})*Matrix4::rotationX(Deg(60.0f));
+    std::vector<Vector3> points = manyPoints(100000);
+
+    CORRADE_BENCHMARK(1)
+        MeshTools::transformPointsInPlace(matrix, Containers::ArrayView<Vector3>{points.data(), points.size()});
+
+    CORRADE_VERIFY(!points.empty());
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::MeshTools::Test::TransformTest)
@@ -25,34 +25,56 @@
 
 #include "Tipsify.h"
 
-#include <stack>
+#include <algorithm>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
 
-namespace Magnum { namespace MeshTools { namespace Implementation {
+#include "Magnum/ThreadPool.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace Implementation {
 
 void Tipsify::operator()(std::size_t cacheSize) {
+    TipsifyScratch scratch;
+    (*this)(cacheSize, scratch);
+
+    /* Copy the optimized indices back into the original view */
+    std::copy(scratch.output.begin(), scratch.output.end(), indices.begin());
+}
+
+void Tipsify::operator()(std::size_t cacheSize, TipsifyScratch& scratch) {
     /* Neighboring triangles for each vertex, per-vertex live triangle count */
-    std::vector<UnsignedInt> liveTriangleCount, neighborPosition, neighbors;
+    std::vector<UnsignedInt>& liveTriangleCount = scratch.liveTriangleCount;
+    std::vector<UnsignedInt>& neighborPosition = scratch.neighborOffset;
+    std::vector<UnsignedInt>& neighbors = scratch.neighbors;
     buildAdjacency(liveTriangleCount, neighborPosition, neighbors);
 
     /* Global time, per-vertex caching timestamps, per-triangle emmited flag */
     UnsignedInt time = cacheSize+1;
-    std::vector<UnsignedInt> timestamp(vertexCount);
-    std::vector<bool> emitted(indices.size()/3);
+    std::vector<UnsignedInt>& timestamp = scratch.timestamp;
+    timestamp.assign(vertexCount, 0);
+    std::vector<bool>& emitted = scratch.emitted;
+    emitted.assign(indices.size()/3, false);
 
     /* Dead-end vertex stack */
-    std::stack<UnsignedInt> deadEndStack;
+    std::vector<UnsignedInt>& deadEndStack = scratch.deadEndStack;
+    deadEndStack.clear();
+
+    /* Array with candidates for next fanning vertex (in 1-ring around
+       fanning vertex) */
+    std::vector<UnsignedInt>& candidates = scratch.candidates;
 
     /* Output index buffer */
-    std::vector<UnsignedInt> outputIndices;
+    std::vector<UnsignedInt>& outputIndices = scratch.output;
+    outputIndices.clear();
     outputIndices.reserve(indices.size());
 
     /* Starting vertex for fanning, cursor */
     UnsignedInt fanningVertex = 0;
     UnsignedInt i = 0;
     while(fanningVertex != 0xFFFFFFFFu) {
-        /* Array with candidates for next fanning vertex (in 1-ring around
-           fanning vertex) */
-        std::vector<UnsignedInt> candidates;
+        candidates.clear();
 
         /* For all neighbors of fanning vertex */
         for(UnsignedInt ti = neighborPosition[fanningVertex], t = neighbors[ti]; ti != neighborPosition[fanningVertex+1]; t = neighbors[++ti]) {
@@ -68,7 +90,7 @@ void Tipsify::operator()(std::size_t cacheSize) {
 
                 /* Add to dead end stack and candidates array */
                 /** @todo Limit size of dead end stack to cache size */
-                deadEndStack.push(v);
+                deadEndStack.push_back(v);
                 candidates.push_back(v);
 
                 /* Decrease live triangle count */
@@ -105,8 +127,8 @@ void Tipsify::operator()(std::size_t cacheSize) {
         if(fanningVertex == 0xFFFFFFFFu) {
             /* Find vertex with live triangles in dead-end stack */
             while(!deadEndStack.empty()) {
-                unsigned int d = deadEndStack.top();
-                deadEndStack.pop();
+                unsigned int d = deadEndStack.back();
+                deadEndStack.pop_back();
 
                 if(!liveTriangleCount[d]) continue;
                 fanningVertex = d;
@@ -124,9 +146,7 @@ void Tipsify::operator()(std::size_t cacheSize) {
         }
     }
 
-    /* Swap original index buffer with optimized */
-    using std::swap;
-    swap(indices, outputIndices);
+    CORRADE_INTERNAL_ASSERT(outputIndices.size() == indices.size());
 }
 
 void Tipsify::buildAdjacency(std::vector<UnsignedInt>& liveTriangleCount, std::vector<UnsignedInt>& neighborOffset, std::vector<UnsignedInt>& neighbors) const {
@@ -158,4 +178,100 @@ void Tipsify::buildAdjacency(std::vector<UnsignedInt>& liveTriangleCount, std::v
         neighbors[neighborOffset[indices[i]+1]++] = i/3;
 }
 
-}}}
+}
+
+namespace {
+
+/* Simulates a FIFO cache the same way as vertexCacheMissRatio(), returns
+   count of cache misses and count of referenced vertices */
+std::pair<std::size_t, std::size_t> simulateFifoCache(const Containers::ArrayView<const UnsignedInt> indices, const UnsignedInt vertexCount, const std::size_t cacheSize, std::vector<UnsignedInt>& timestamp) {
+    timestamp.assign(vertexCount, 0);
+    UnsignedInt time = cacheSize + 1;
+    std::size_t misses = 0, referenced = 0;
+    for(const UnsignedInt index: indices) {
+        if(time - timestamp[index] <= cacheSize) continue;
+
+        /* Timestamps are never zero once set, so this is the first use */
+        if(!timestamp[index]) ++referenced;
+        timestamp[index] = time++;
+        ++misses;
+    }
+
+    return {misses, referenced};
+}
+
+}
+
+TipsifyBatch::TipsifyBatch(): _pool{}, _minimalGain{0.0f}, _cancelled{false} {}
+
+TipsifyBatch::TipsifyBatch(ThreadPool& pool): _pool{&pool}, _minimalGain{0.0f}, _cancelled{false} {}
+
+TipsifyBatch::~TipsifyBatch() = default;
+
+std::size_t TipsifyBatch::process(const Containers::ArrayView<const Containers::ArrayView<UnsignedInt>> meshes, const Containers::ArrayView<const UnsignedInt> vertexCounts, const std::size_t cacheSize, const Containers::ArrayView<TipsifyStatistics> statistics) {
+    CORRADE_ASSERT(vertexCounts.size() == meshes.size(), "MeshTools::TipsifyBatch::process(): expected" << meshes.size() << "vertex counts but got" << vertexCounts.size(), {});
+    CORRADE_ASSERT(statistics.size() == meshes.size(), "MeshTools::TipsifyBatch::process(): expected" << meshes.size() << "statistics but got" << statistics.size(), {});
+    #if !defined(CORRADE_NO_ASSERT) || defined(CORRADE_GRACEFUL_ASSERT)
+    for(std::size_t i = 0; i != meshes.size(); ++i)
+        CORRADE_ASSERT(meshes[i].size() % 3 == 0, "MeshTools::TipsifyBatch::process(): index count of mesh" << i << "is not divisible by 3", {});
+    #endif
+
+    /* There's never more jobs running at the same time than the pool has
+       threads, so one scratch memory for each is enough */
+    const std::size_t scratchCount = _pool ? _pool->threadCount() : 1;
+    if(_scratch.size() < scratchCount) {
+        for(std::size_t i = _scratch.size(); i != scratchCount; ++i)
+            _freeScratch.push_back(i);
+        _scratch.resize(scratchCount);
+    }
+
+    std::atomic<std::size_t> processedCount{0};
+    const auto job = [&](const std::size_t begin, const std::size_t end) {
+        std::size_t scratchIndex;
+        {
+            std::lock_guard<std::mutex> lock{_scratchMutex};
+            CORRADE_INTERNAL_ASSERT(!_freeScratch.empty());
+            scratchIndex = _freeScratch.back();
+            _freeScratch.pop_back();
+        }
+        Implementation::TipsifyScratch& scratch = _scratch[scratchIndex];
+
+        for(std::size_t i = begin; i != end; ++i) {
+            TipsifyStatistics& out = statistics[i];
+            out = TipsifyStatistics{};
+            if(_cancelled) continue;
+
+            const Containers::ArrayView<UnsignedInt> indices = meshes[i];
+            out.processed = true;
+            ++processedCount;
+            if(indices.empty()) continue;
+
+            const std::size_t triangleCount = indices.size()/3;
+            const std::pair<std::size_t, std::size_t> before = simulateFifoCache(indices, vertexCounts[i], cacheSize, scratch.timestamp);
+            Implementation::Tipsify{indices, vertexCounts[i]}(cacheSize, scratch);
+            const std::pair<std::size_t, std::size_t> after = simulateFifoCache({scratch.output.data(), scratch.output.size()}, vertexCounts[i], cacheSize, scratch.timestamp);
+
+            out.acmrBefore = Float(before.first)/Float(triangleCount);
+            out.acmrAfter = Float(after.first)/Float(triangleCount);
+            out.atvrBefore = Float(before.first)/Float(before.second);
+            out.atvrAfter = Float(after.first)/Float(after.second);
+
+            if(out.acmrAfter < out.acmrBefore - _minimalGain) {
+                std::copy(scratch.output.begin(), scratch.output.end(), indices.begin());
+                out.applied = true;
+            }
+        }
+
+        std::lock_guard<std::mutex> lock{_scratchMutex};
+        _freeScratch.push_back(scratchIndex);
+    };
+
+    /* Meshes can differ a lot in size, so distribute them one by one */
+    if(_pool) _pool->parallelFor(meshes.size(), 1, job);
+    else job(0, meshes.size());
+
+    _cancelled = false;
+    return processedCount;
+}
+
+}}
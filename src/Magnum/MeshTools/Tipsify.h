@@ -26,24 +26,43 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::MeshTools::tipsify()
+ * @brief Class @ref Magnum::MeshTools::TipsifyBatch, struct @ref Magnum::MeshTools::TipsifyStatistics, function @ref Magnum::MeshTools::tipsify(), @ref Magnum::MeshTools::tipsifyInPlace()
  */
 
+#include <atomic>
+#include <mutex>
 #include <vector>
+#include <Corrade/Containers/ArrayView.h>
 
-#include "Magnum/Types.h"
+#include "Magnum/Magnum.h"
 #include "Magnum/MeshTools/visibility.h"
 
 namespace Magnum { namespace MeshTools {
 
 namespace Implementation {
 
+/* Scratch memory for Tipsify, kept between runs in TipsifyBatch */
+struct TipsifyScratch {
+    std::vector<UnsignedInt> liveTriangleCount, neighborOffset, neighbors,
+        timestamp, deadEndStack, candidates, output;
+    std::vector<bool> emitted;
+};
+
 class MAGNUM_MESHTOOLS_EXPORT Tipsify {
     public:
-        Tipsify(std::vector<UnsignedInt>& indices, UnsignedInt vertexCount): indices(indices), vertexCount(vertexCount) {}
+        Tipsify(Containers::ArrayView<UnsignedInt> indices, UnsignedInt vertexCount): indices(indices), vertexCount(vertexCount) {}
+        Tipsify(std::vector<UnsignedInt>& indices, UnsignedInt vertexCount): indices{indices.data(), indices.size()}, vertexCount(vertexCount) {}
 
         void operator()(std::size_t cacheSize);
 
+        /**
+         * @brief Calculate the optimized order into scratch memory
+         *
+         * The result is in @cpp scratch.output @ce, the original indices
+         * are not modified.
+         */
+        void operator()(std::size_t cacheSize, TipsifyScratch& scratch);
+
         /**
          * @brief Build vertex-triangle adjacency
          *
@@ -54,7 +73,7 @@ class MAGNUM_MESHTOOLS_EXPORT Tipsify {
         void buildAdjacency(std::vector<UnsignedInt>& liveTriangleCount, std::vector<UnsignedInt>& neighborOffset, std::vector<UnsignedInt>& neighbors) const;
 
     private:
-        std::vector<UnsignedInt>& indices;
+        Containers::ArrayView<UnsignedInt> indices;
         const UnsignedInt vertexCount;
 };
 
@@ -77,6 +96,169 @@ inline void tipsify(std::vector<UnsignedInt>& indices, UnsignedInt vertexCount,
     Implementation::Tipsify(indices, vertexCount)(cacheSize);
 }
 
+/**
+@brief Tipsify the mesh in place
+@param[in,out] indices  Indices array to operate on
+@param[in] vertexCount  Vertex count
+@param[in] cacheSize    Post-transform vertex cache size
+
+Same as @ref tipsify(), but operates on an array view, for example directly
+on a mapped index buffer.
+*/
+inline void tipsifyInPlace(Containers::ArrayView<UnsignedInt> indices, UnsignedInt vertexCount, std::size_t cacheSize) {
+    Implementation::Tipsify(indices, vertexCount)(cacheSize);
+}
+
+/**
+@brief Per-mesh statistics of a @ref TipsifyBatch run
+
+@see @ref TipsifyBatch::process()
+*/
+struct TipsifyStatistics {
+    /**
+     * @brief ACMR of the original index order
+     *
+     * Average count of cache misses per triangle, see
+     * @ref vertexCacheMissRatio().
+     */
+    Float acmrBefore;
+
+    /** @brief ACMR of the tipsified index order */
+    Float acmrAfter;
+
+    /**
+     * @brief ATVR of the original index order
+     *
+     * Average count of vertex shader invocations per referenced vertex.
+     * The value is between @cpp 1.0 @ce (each vertex transformed just once)
+     * and about @cpp 6.0 @ce (no vertex reuse) for regular meshes.
+     */
+    Float atvrBefore;
+
+    /** @brief ATVR of the tipsified index order */
+    Float atvrAfter;
+
+    /**
+     * @brief Whether the mesh was processed
+     *
+     * @cpp false @ce if the batch was cancelled before getting to this
+     * mesh. In that case the other fields are zero.
+     */
+    bool processed;
+
+    /**
+     * @brief Whether the tipsified order was written back
+     *
+     * @cpp false @ce if the mesh wasn't processed or if the gain was
+     * smaller than @ref TipsifyBatch::minimalGain(). In that case the mesh
+     * indices are left untouched.
+     */
+    bool applied;
+};
+
+/**
+@brief Batch tipsifier
+
+Runs @ref tipsifyInPlace() on many meshes, reusing the adjacency and other
+scratch memory between them. For each mesh, the ACMR and ATVR before and
+after is measured on a simulated FIFO cache of the same size and the result
+is written back only if ACMR improved by more than @ref minimalGain(), so
+meshes that don't benefit from the optimization are left untouched:
+
+@code{.cpp}
+ThreadPool pool;
+MeshTools::TipsifyBatch batch{pool};
+
+std::vector<Containers::ArrayView<UnsignedInt>> indices;
+std::vector<UnsignedInt> vertexCounts;
+// fill the views and vertex counts for all meshes ...
+
+std::vector<MeshTools::TipsifyStatistics> statistics(indices.size());
+batch.process({indices.data(), indices.size()},
+    {vertexCounts.data(), vertexCounts.size()}, 24,
+    {statistics.data(), statistics.size()});
+@endcode
+
+When constructed with a @ref ThreadPool, the meshes are distributed among
+the pool threads, each thread having its own scratch memory. A batch
+running on another thread can be stopped using @ref cancel(). The result
+for each mesh is the same as if @ref tipsifyInPlace() was called on it,
+regardless of thread count.
+*/
+class MAGNUM_MESHTOOLS_EXPORT TipsifyBatch {
+    public:
+        /** @brief Constructor */
+        explicit TipsifyBatch();
+
+        /**
+         * @brief Construct with a thread pool
+         *
+         * The pool is expected to stay in scope for the whole batch
+         * lifetime.
+         */
+        explicit TipsifyBatch(ThreadPool& pool);
+
+        ~TipsifyBatch();
+
+        /**
+         * @brief Minimal ACMR gain
+         *
+         * Default is @cpp 0.0f @ce, meaning that the tipsified order is
+         * applied only if it has strictly lower ACMR than the original.
+         */
+        Float minimalGain() const { return _minimalGain; }
+
+        /**
+         * @brief Set minimal ACMR gain
+         * @return Reference to self (for method chaining)
+         *
+         * The tipsified order is written back only if its ACMR is lower
+         * than ACMR of the original order minus @p gain.
+         */
+        TipsifyBatch& setMinimalGain(Float gain) {
+            _minimalGain = gain;
+            return *this;
+        }
+
+        /**
+         * @brief Process the meshes
+         * @param[in,out] meshes    Triangle indices of all meshes
+         * @param[in] vertexCounts  Vertex count for each mesh
+         * @param[in] cacheSize     Post-transform vertex cache size
+         * @param[out] statistics   Statistics for each mesh
+         * @return Count of processed meshes
+         *
+         * Expects that @p vertexCounts and @p statistics have the same size
+         * as @p meshes and that index count of each mesh is divisible by
+         * @cpp 3 @ce. If @ref cancel() is called during the processing,
+         * the remaining meshes are skipped and have
+         * @ref TipsifyStatistics::processed set to @cpp false @ce. With a
+         * thread pool the processed meshes aren't necessarily the first
+         * ones.
+         */
+        std::size_t process(Containers::ArrayView<const Containers::ArrayView<UnsignedInt>> meshes, Containers::ArrayView<const UnsignedInt> vertexCounts, std::size_t cacheSize, Containers::ArrayView<TipsifyStatistics> statistics);
+
+        /**
+         * @brief Cancel the processing
+         *
+         * Can be called from any thread. Meshes that are already being
+         * processed are finished, the rest is skipped. The request is
+         * consumed when @ref process() returns, so if there's no
+         * processing in progress, the next @ref process() call returns
+         * immediately without processing anything.
+         */
+        void cancel() { _cancelled = true; }
+
+    private:
+        ThreadPool* _pool;
+        Float _minimalGain;
+        std::atomic<bool> _cancelled;
+
+        std::mutex _scratchMutex;
+        std::vector<Implementation::TipsifyScratch> _scratch;
+        std::vector<std::size_t> _freeScratch;
+};
+
 }}
 
 #endif
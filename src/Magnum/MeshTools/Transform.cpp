@@ -0,0 +1,141 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Transform.h"
+
+#include "Magnum/ThreadPool.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Matrix4.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+/* The data are processed in fixed-size blocks that are first deinterleaved
+   into SoA arrays on stack. The loops over them have constant coefficients and
+   no dependencies between iterations, so the compiler is able to vectorize
+   them, which it can't do with the stride-3 interleaved layout directly. */
+constexpr std::size_t BlockSize = 256;
+
+template<bool projective, bool translation> void transformBlocks(const Matrix4& matrix, Vector3* const data, const std::size_t size) {
+    const Float m00 = matrix[0][0], m01 = matrix[0][1], m02 = matrix[0][2], m03 = matrix[0][3],
+                m10 = matrix[1][0], m11 = matrix[1][1], m12 = matrix[1][2], m13 = matrix[1][3],
+                m20 = matrix[2][0], m21 = matrix[2][1], m22 = matrix[2][2], m23 = matrix[2][3],
+                m30 = translation ? matrix[3][0] : 0.0f,
+                m31 = translation ? matrix[3][1] : 0.0f,
+                m32 = translation ? matrix[3][2] : 0.0f,
+                m33 = translation ? matrix[3][3] : 1.0f;
+
+    Float x[BlockSize], y[BlockSize], z[BlockSize];
+    for(std::size_t begin = 0; begin < size; begin += BlockSize) {
+        Vector3* const block = data + begin;
+        const std::size_t count = Math::min(BlockSize, size - begin);
+
+        for(std::size_t i = 0; i != count; ++i) {
+            x[i] = block[i].x();
+            y[i] = block[i].y();
+            z[i] = block[i].z();
+        }
+
+        for(std::size_t i = 0; i != count; ++i) {
+            const Float px = x[i], py = y[i], pz = z[i];
+            Float tx = m00*px + m10*py + m20*pz + m30;
+            Float ty = m01*px + m11*py + m21*pz + m31;
+            Float tz = m02*px + m12*py + m22*pz + m32;
+            if(projective) {
+                const Float invW = 1.0f/(m03*px + m13*py + m23*pz + m33);
+                tx *= invW;
+                ty *= invW;
+                tz *= invW;
+            }
+            x[i] = tx;
+            y[i] = ty;
+            z[i] = tz;
+        }
+
+        for(std::size_t i = 0; i != count; ++i)
+            block[i] = {x[i], y[i], z[i]};
+    }
+}
+
+template<bool projective, bool translation> void transformBlocks(const Matrix4& matrix, const Containers::ArrayView<Vector3> data, ThreadPool* const pool) {
+    if(!pool) {
+        transformBlocks<projective, translation>(matrix, data.data(), data.size());
+        return;
+    }
+
+    pool->parallelFor(data.size(), BlockSize*16, [&](const std::size_t begin, const std::size_t end) {
+        transformBlocks<projective, translation>(matrix, data.data() + begin, end - begin);
+    });
+}
+
+/* Whether the last row is (0, 0, 0, 1) and the perspective division can be
+   omitted */
+bool isAffine(const Matrix4& matrix) {
+    return matrix[0][3] == 0.0f && matrix[1][3] == 0.0f && matrix[2][3] == 0.0f && matrix[3][3] == 1.0f;
+}
+
+void transformPointsInternal(const Matrix4& matrix, const Containers::ArrayView<Vector3> points, ThreadPool* const pool) {
+    if(isAffine(matrix))
+        transformBlocks<false, true>(matrix, points, pool);
+    else
+        transformBlocks<true, true>(matrix, points, pool);
+}
+
+}
+
+void transformVectorsInPlace(const Matrix4& matrix, const Containers::ArrayView<Vector3> vectors) {
+    transformBlocks<false, false>(matrix, vectors, nullptr);
+}
+
+void transformVectorsInPlace(const Matrix4& matrix, const Containers::ArrayView<Vector3> vectors, ThreadPool& pool) {
+    transformBlocks<false, false>(matrix, vectors, &pool);
+}
+
+void transformVectorsInPlace(const Quaternion& normalizedQuaternion, const Containers::ArrayView<Vector3> vectors) {
+    transformBlocks<false, false>(Matrix4::from(normalizedQuaternion.toMatrix(), {}), vectors, nullptr);
+}
+
+void transformVectorsInPlace(const Quaternion& normalizedQuaternion, const Containers::ArrayView<Vector3> vectors, ThreadPool& pool) {
+    transformBlocks<false, false>(Matrix4::from(normalizedQuaternion.toMatrix(), {}), vectors, &pool);
+}
+
+void transformPointsInPlace(const Matrix4& matrix, const Containers::ArrayView<Vector3> points) {
+    transformPointsInternal(matrix, points, nullptr);
+}
+
+void transformPointsInPlace(const Matrix4& matrix, const Containers::ArrayView<Vector3> points, ThreadPool& pool) {
+    transformPointsInternal(matrix, points, &pool);
+}
+
+void transformPointsInPlace(const DualQuaternion& normalizedDualQuaternion, const Containers::ArrayView<Vector3> points) {
+    transformBlocks<false, true>(normalizedDualQuaternion.toMatrix(), points, nullptr);
+}
+
+void transformPointsInPlace(const DualQuaternion& normalizedDualQuaternion, const Containers::ArrayView<Vector3> points, ThreadPool& pool) {
+    transformBlocks<false, true>(normalizedDualQuaternion.toMatrix(), points, &pool);
+}
+
+}}
@@ -29,8 +29,12 @@
  * @brief Function @ref Magnum::MeshTools::transformVectorsInPlace(), @ref Magnum::MeshTools::transformVectors(), @ref Magnum::MeshTools::transformPointsInPlace(), @ref Magnum::MeshTools::transformPoints()
  */
 
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Magnum.h"
 #include "Magnum/Math/DualQuaternion.h"
 #include "Magnum/Math/DualComplex.h"
+#include "Magnum/MeshTools/visibility.h"
 
 namespace Magnum { namespace MeshTools {
 
@@ -74,6 +78,44 @@ template<class T, class U> void transformVectorsInPlace(const Math::Matrix4<T>&
     for(auto& vector: vectors) vector = matrix.transformVector(vector);
 }
 
+/**
+@brief Transform contiguous vectors in-place using given matrix
+
+Batch variant of @ref transformVectorsInPlace(const Math::Matrix4<T>&, U&) for
+contiguous arrays of @ref Vector3. The vectors are processed in blocks that
+are deinterleaved to temporary separate arrays of X, Y and Z components first,
+making the inner loop trivially vectorizable by the compiler. Preferred over
+the generic overload when transforming large meshes.
+@see @ref transformPointsInPlace(const Matrix4&, Containers::ArrayView<Vector3>)
+*/
+MAGNUM_MESHTOOLS_EXPORT void transformVectorsInPlace(const Matrix4& matrix, Containers::ArrayView<Vector3> vectors);
+
+/**
+@brief Transform contiguous vectors in-place using given matrix in parallel
+
+Same as @ref transformVectorsInPlace(const Matrix4&, Containers::ArrayView<Vector3>),
+but distributes the blocks among threads of @p pool.
+*/
+MAGNUM_MESHTOOLS_EXPORT void transformVectorsInPlace(const Matrix4& matrix, Containers::ArrayView<Vector3> vectors, ThreadPool& pool);
+
+/**
+@brief Transform contiguous vectors in-place using given quaternion
+
+Converts the quaternion to a rotation matrix once and then does the same as
+@ref transformVectorsInPlace(const Matrix4&, Containers::ArrayView<Vector3>),
+which is considerably faster than applying the quaternion to each vector
+separately. Expects that the quaternion is normalized.
+*/
+MAGNUM_MESHTOOLS_EXPORT void transformVectorsInPlace(const Quaternion& normalizedQuaternion, Containers::ArrayView<Vector3> vectors);
+
+/**
+@brief Transform contiguous vectors in-place using given quaternion in parallel
+
+Same as @ref transformVectorsInPlace(const Quaternion&, Containers::ArrayView<Vector3>),
+but distributes the blocks among threads of @p pool.
+*/
+MAGNUM_MESHTOOLS_EXPORT void transformVectorsInPlace(const Quaternion& normalizedQuaternion, Containers::ArrayView<Vector3> vectors, ThreadPool& pool);
+
 /**
 @brief Transform vectors using given transformation
 
@@ -125,6 +167,42 @@ template<class T, class U> void transformPointsInPlace(const Math::Matrix4<T>& m
     for(auto& point: points) point = matrix.transformPoint(point);
 }
 
+/**
+@brief Transform contiguous points in-place using given matrix
+
+Batch variant of @ref transformPointsInPlace(const Math::Matrix4<T>&, U&) for
+contiguous arrays of @ref Vector3, see
+@ref transformVectorsInPlace(const Matrix4&, Containers::ArrayView<Vector3>)
+for details. If the last row of the matrix is @f$ (0, 0, 0, 1) @f$, the
+perspective division is skipped altogether.
+*/
+MAGNUM_MESHTOOLS_EXPORT void transformPointsInPlace(const Matrix4& matrix, Containers::ArrayView<Vector3> points);
+
+/**
+@brief Transform contiguous points in-place using given matrix in parallel
+
+Same as @ref transformPointsInPlace(const Matrix4&, Containers::ArrayView<Vector3>),
+but distributes the blocks among threads of @p pool.
+*/
+MAGNUM_MESHTOOLS_EXPORT void transformPointsInPlace(const Matrix4& matrix, Containers::ArrayView<Vector3> points, ThreadPool& pool);
+
+/**
+@brief Transform contiguous points in-place using given dual quaternion
+
+Converts the dual quaternion to a transformation matrix once and then does the
+same as @ref transformPointsInPlace(const Matrix4&, Containers::ArrayView<Vector3>).
+Expects that the dual quaternion is normalized.
+*/
+MAGNUM_MESHTOOLS_EXPORT void transformPointsInPlace(const DualQuaternion& normalizedDualQuaternion, Containers::ArrayView<Vector3> points);
+
+/**
+@brief Transform contiguous points in-place using given dual quaternion in parallel
+
+Same as @ref transformPointsInPlace(const DualQuaternion&, Containers::ArrayView<Vector3>),
+but distributes the blocks among threads of @p pool.
+*/
+MAGNUM_MESHTOOLS_EXPORT void transformPointsInPlace(const DualQuaternion& normalizedDualQuaternion, Containers::ArrayView<Vector3> points, ThreadPool& pool);
+
 /**
 @brief Transform points using given transformation
 
@@ -0,0 +1,120 @@
+#ifndef Magnum_MeshTools_duplicateTable_h
+#define Magnum_MeshTools_duplicateTable_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "Magnum/Types.h"
+
+namespace Magnum { namespace MeshTools { namespace Implementation {
+
+/* Hashing and duplicate lookup shared by removeDuplicates(),
+   combineIndexArrays() and subdivideShared() */
+
+/* MurmurHash3 finalizer, so all bits of the hash depend on all bits of the
+   input. It's a bijection, so different inputs never give the same hash. */
+inline UnsignedLong hashMix(UnsignedLong hash) {
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdull;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ull;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+/* FNV-1a over the integers, finalized with hashMix() */
+template<class T> UnsignedLong hashIntegers(const T* const data, const std::size_t count) {
+    UnsignedLong hash = 0xcbf29ce484222325ull;
+    for(std::size_t i = 0; i != count; ++i)
+        hash = (hash ^ UnsignedLong(data[i]))*0x100000001b3ull;
+    return hashMix(hash);
+}
+
+/* Open-addressing hash table with linear probing, mapping a key to index of
+   its first occurence. Stores just the indices and their hashes, the keys
+   are compared by the caller, so they can be anywhere. */
+class DuplicateTable {
+    public:
+        explicit DuplicateTable(std::size_t expectedCount = 0) { reset(expectedCount); }
+
+        /* Removes all entries, reusing the memory if possible */
+        void reset(const std::size_t expectedCount) {
+            std::size_t capacity = 16;
+            while(capacity < expectedCount*2) capacity *= 2;
+            _indices.assign(capacity, Empty);
+            _hashes.resize(capacity);
+            _count = 0;
+        }
+
+        /* Returns index of the first key with given hash for which
+           `equal(index)` returns true, inserting `index` if there's none */
+        template<class Equal> UnsignedInt findOrInsert(const UnsignedLong hash, const UnsignedInt index, Equal equal) {
+            if((_count + 1)*2 > _indices.size()) grow();
+
+            const std::size_t mask = _indices.size() - 1;
+            for(std::size_t i = hash & mask; ; i = (i + 1) & mask) {
+                UnsignedInt& slot = _indices[i];
+                if(slot == Empty) {
+                    slot = index;
+                    _hashes[i] = hash;
+                    ++_count;
+                    return index;
+                }
+
+                if(_hashes[i] == hash && equal(slot)) return slot;
+            }
+        }
+
+    private:
+        enum: UnsignedInt { Empty = ~UnsignedInt{} };
+
+        void grow() {
+            std::vector<UnsignedInt> indices(_indices.size()*2, Empty);
+            std::vector<UnsignedLong> hashes(indices.size());
+            const std::size_t mask = indices.size() - 1;
+            for(std::size_t j = 0; j != _indices.size(); ++j) {
+                if(_indices[j] == Empty) continue;
+
+                std::size_t i = _hashes[j] & mask;
+                while(indices[i] != Empty) i = (i + 1) & mask;
+                indices[i] = _indices[j];
+                hashes[i] = _hashes[j];
+            }
+            std::swap(indices, _indices);
+            std::swap(hashes, _hashes);
+        }
+
+        std::vector<UnsignedInt> _indices;
+        std::vector<UnsignedLong> _hashes;
+        std::size_t _count;
+};
+
+}}}
+
+#endif
@@ -38,8 +38,11 @@
 namespace Magnum {
 
 void MeshView::draw(AbstractShaderProgram& shader, std::initializer_list<std::reference_wrapper<MeshView>> meshes) {
-    /* Why std::initializer_list doesn't have empty()? */
-    if(!meshes.size()) return;
+    draw(shader, Containers::ArrayView<const std::reference_wrapper<MeshView>>{meshes.begin(), meshes.size()});
+}
+
+void MeshView::draw(AbstractShaderProgram& shader, Containers::ArrayView<const std::reference_wrapper<MeshView>> meshes) {
+    if(meshes.empty()) return;
 
     shader.use();
 
@@ -57,8 +60,8 @@ void MeshView::draw(AbstractShaderProgram& shader, std::initializer_list<std::re
 }
 
 #ifndef MAGNUM_TARGET_WEBGL
-void MeshView::multiDrawImplementationDefault(std::initializer_list<std::reference_wrapper<MeshView>> meshes) {
-    CORRADE_INTERNAL_ASSERT(meshes.size());
+void MeshView::multiDrawImplementationDefault(Containers::ArrayView<const std::reference_wrapper<MeshView>> meshes) {
+    CORRADE_INTERNAL_ASSERT(!meshes.empty());
 
     const Implementation::MeshState& state = *Context::current().state().mesh;
 
@@ -119,12 +122,16 @@ void MeshView::multiDrawImplementationDefault(std::initializer_list<std::referen
         }
     }
 
+    #ifdef MAGNUM_BUILD_STATISTICS
+    ++Context::current().statisticsInternal().drawCallCount;
+    #endif
+
     (original.*state.unbindImplementation)();
 }
 #endif
 
 #ifdef MAGNUM_TARGET_GLES
-void MeshView::multiDrawImplementationFallback(std::initializer_list<std::reference_wrapper<MeshView>> meshes) {
+void MeshView::multiDrawImplementationFallback(Containers::ArrayView<const std::reference_wrapper<MeshView>> meshes) {
     for(MeshView& mesh: meshes) {
         /* Nothing to draw in this mesh */
         if(!mesh._count) continue;
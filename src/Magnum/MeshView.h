@@ -31,6 +31,7 @@
 
 #include <functional>
 #include <initializer_list>
+#include <Corrade/Containers/ArrayView.h>
 
 #include "Magnum/Magnum.h"
 #include "Magnum/OpenGL.h"
@@ -57,12 +58,17 @@ You must ensure that the original mesh remains available for whole view
 lifetime.
 */
 class MAGNUM_EXPORT MeshView {
+    friend DrawPacket;
     friend Implementation::MeshState;
 
     public:
         /**
          * @brief Draw multiple meshes at once
          *
+         * The list of views can be assembled at runtime, for example as a
+         * result of visibility culling. Views with zero @ref count() are
+         * skipped.
+         *
          * In OpenGL ES, if @extension2{EXT,multi_draw_arrays,multi_draw_arrays}
          * is not present, the functionality is emulated using sequence of
          * @ref draw(AbstractShaderProgram&) calls.
@@ -84,6 +90,19 @@ class MAGNUM_EXPORT MeshView {
          * @requires_gl Specifying base vertex for indexed meshes is not
          *      available in OpenGL ES or WebGL.
          */
+        static void draw(AbstractShaderProgram& shader, Containers::ArrayView<const std::reference_wrapper<MeshView>> meshes);
+
+        /** @overload */
+        static void draw(AbstractShaderProgram&& shader, Containers::ArrayView<const std::reference_wrapper<MeshView>> meshes) {
+            draw(shader, meshes);
+        }
+
+        /**
+         * @overload
+         *
+         * Convenience alternative to the above for a list of views known at
+         * compile time.
+         */
         static void draw(AbstractShaderProgram& shader, std::initializer_list<std::reference_wrapper<MeshView>> meshes);
 
         /** @overload */
@@ -221,7 +240,7 @@ class MAGNUM_EXPORT MeshView {
          * @brief Draw the mesh
          *
          * See @ref Mesh::draw(AbstractShaderProgram&) for more information.
-         * @see @ref draw(AbstractShaderProgram&, std::initializer_list<std::reference_wrapper<MeshView>>),
+         * @see @ref draw(AbstractShaderProgram&, Containers::ArrayView<const std::reference_wrapper<MeshView>>),
          *      @ref draw(AbstractShaderProgram&, TransformFeedback&, UnsignedInt)
          * @requires_gl32 Extension @extension{ARB,draw_elements_base_vertex}
          *      if the mesh is indexed and @ref baseVertex() is not `0`.
@@ -268,9 +287,9 @@ class MAGNUM_EXPORT MeshView {
 
     private:
         #ifndef MAGNUM_TARGET_WEBGL
-        static MAGNUM_LOCAL void multiDrawImplementationDefault(std::initializer_list<std::reference_wrapper<MeshView>> meshes);
+        static MAGNUM_LOCAL void multiDrawImplementationDefault(Containers::ArrayView<const std::reference_wrapper<MeshView>> meshes);
         #endif
-        static MAGNUM_LOCAL void multiDrawImplementationFallback(std::initializer_list<std::reference_wrapper<MeshView>> meshes);
+        static MAGNUM_LOCAL void multiDrawImplementationFallback(Containers::ArrayView<const std::reference_wrapper<MeshView>> meshes);
 
         std::reference_wrapper<Mesh> _original;
 
@@ -0,0 +1,266 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "PixelConversion.h"
+
+#include <algorithm>
+#include <cstring>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/ThreadPool.h"
+#include "Magnum/Math/Packing.h"
+
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+namespace Magnum {
+
+namespace {
+
+/* Source byte offset of each destination channel, or one of these */
+enum: Int {
+    FillZero = -1,
+    FillMax = -2
+};
+
+/* Storage order of logical channels, R = 0, G = 1, B = 2, A = 3. Luminance
+   is stored as red and provides all three color channels. */
+struct Layout {
+    Int count;
+    Int channels[4];
+    bool luminance;
+};
+
+bool layout(const PixelFormat format, Layout& out) {
+    switch(format) {
+        #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+        case PixelFormat::Red: out = {1, {0}, false}; return true;
+        case PixelFormat::RG: out = {2, {0, 1}, false}; return true;
+        #endif
+        #ifdef MAGNUM_TARGET_GLES2
+        case PixelFormat::Luminance: out = {1, {0}, true}; return true;
+        case PixelFormat::LuminanceAlpha: out = {2, {0, 3}, true}; return true;
+        #endif
+        case PixelFormat::RGB: out = {3, {0, 1, 2}, false}; return true;
+        case PixelFormat::RGBA: out = {4, {0, 1, 2, 3}, false}; return true;
+        #ifndef MAGNUM_TARGET_GLES
+        case PixelFormat::BGR: out = {3, {2, 1, 0}, false}; return true;
+        #endif
+        #ifndef MAGNUM_TARGET_WEBGL
+        case PixelFormat::BGRA: out = {4, {2, 1, 0, 3}, false}; return true;
+        #endif
+        default: return false;
+    }
+}
+
+void channelMap(const Layout& source, const Layout& destination, Int(&map)[4]) {
+    for(Int i = 0; i != destination.count; ++i) {
+        const Int channel = destination.channels[i];
+        map[i] = channel == 3 ? FillMax : FillZero;
+        for(Int j = 0; j != source.count; ++j) {
+            if(source.channels[j] == channel || (source.luminance && source.channels[j] == 0 && channel < 3)) {
+                map[i] = j;
+                break;
+            }
+        }
+    }
+}
+
+void shuffleRow(const char* const src, char* const dst, const std::size_t width, const Int srcCount, const Int dstCount, const Int(&map)[4]) {
+    std::size_t i = 0;
+
+    #if defined(__SSSE3__) || defined(__aarch64__)
+    /* Four pixels at a time. The mask picks a source byte for each
+       destination byte, out-of-range indices produce zero and the fill
+       vector then sets the alpha bytes not present in the source. */
+    alignas(16) UnsignedByte mask[16];
+    alignas(16) UnsignedByte fill[16];
+    std::memset(mask, 0x80, 16);
+    std::memset(fill, 0, 16);
+    for(Int p = 0; p != 4; ++p) for(Int c = 0; c != dstCount; ++c) {
+        if(map[c] >= 0) mask[p*dstCount + c] = UnsignedByte(p*srcCount + map[c]);
+        else if(map[c] == FillMax) fill[p*dstCount + c] = 0xff;
+    }
+    #if defined(__SSSE3__)
+    const __m128i maskV = _mm_load_si128(reinterpret_cast<const __m128i*>(mask));
+    const __m128i fillV = _mm_load_si128(reinterpret_cast<const __m128i*>(fill));
+    #else
+    const uint8x16_t maskV = vld1q_u8(mask);
+    const uint8x16_t fillV = vld1q_u8(fill);
+    #endif
+
+    /* The full 16-byte load can't go past the end of the row */
+    for(; i + 4 <= width && i*srcCount + 16 <= width*srcCount; i += 4) {
+        #if defined(__SSSE3__)
+        const __m128i result = _mm_or_si128(_mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i*srcCount)), maskV), fillV);
+        if(dstCount == 4)
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i*4), result);
+        else {
+            alignas(16) char out[16];
+            _mm_store_si128(reinterpret_cast<__m128i*>(out), result);
+            std::memcpy(dst + i*dstCount, out, 4*dstCount);
+        }
+        #else
+        const uint8x16_t result = vorrq_u8(vqtbl1q_u8(vld1q_u8(reinterpret_cast<const UnsignedByte*>(src + i*srcCount)), maskV), fillV);
+        if(dstCount == 4)
+            vst1q_u8(reinterpret_cast<UnsignedByte*>(dst + i*4), result);
+        else {
+            alignas(16) UnsignedByte out[16];
+            vst1q_u8(out, result);
+            std::memcpy(dst + i*dstCount, out, 4*dstCount);
+        }
+        #endif
+    }
+    #endif
+
+    /* Remaining pixels. Going through a temporary makes this safe also for
+       in-place operation. */
+    for(; i != width; ++i) {
+        char pixel[4];
+        for(Int c = 0; c != dstCount; ++c)
+            pixel[c] = map[c] >= 0 ? src[i*srcCount + map[c]] : map[c] == FillMax ? char(0xff) : 0;
+        std::memcpy(dst + i*dstCount, pixel, dstCount);
+    }
+}
+
+enum class Conversion {
+    Shuffle,
+    UnpackHalf,
+    PackHalf
+};
+
+Image2D convertPixelsInternal(const ImageView2D& image, const PixelFormat format, const PixelType type, ThreadPool* const pool) {
+    Layout source{}, destination{};
+    const bool shuffle = image.type() == PixelType::UnsignedByte && type == PixelType::UnsignedByte && layout(image.format(), source) && layout(format, destination);
+    const bool unpackHalf = image.format() == format && image.type() == PixelType::HalfFloat && type == PixelType::Float;
+    const bool packHalf = image.format() == format && image.type() == PixelType::Float && type == PixelType::HalfFloat;
+    CORRADE_ASSERT(shuffle || unpackHalf || packHalf,
+        "convertPixels(): conversion from" << image.format() << image.type() << "to" << format << type << "is not supported", (Image2D{format, type}));
+    const Conversion conversion = unpackHalf ? Conversion::UnpackHalf :
+        packHalf ? Conversion::PackHalf : Conversion::Shuffle;
+
+    Int map[4]{};
+    if(conversion == Conversion::Shuffle) channelMap(source, destination, map);
+
+    /* Tightly packed output, keeping the default four-byte alignment if
+       possible */
+    const std::size_t width = image.size().x();
+    const std::size_t dstPixelSize = PixelStorage::pixelSize(format, type);
+    const std::size_t dstRowSize = width*dstPixelSize;
+    PixelStorage storage;
+    if(dstRowSize % 4) storage.setAlignment(1);
+    Containers::Array<char> data{dstRowSize*image.size().y()};
+
+    const char* const src = image.data() + std::get<0>(image.dataProperties()).sum();
+    const std::size_t srcRowStride = std::get<1>(image.dataProperties()).x();
+    const std::size_t srcPixelSize = image.pixelSize();
+    const std::size_t componentCount = width*srcPixelSize/(image.type() == PixelType::Float ? 4 : image.type() == PixelType::HalfFloat ? 2 : 1);
+    char* const dst = data.data();
+
+    auto convertRows = [&](const std::size_t begin, const std::size_t end) {
+        for(std::size_t y = begin; y != end; ++y) {
+            const char* const srcRow = src + y*srcRowStride;
+            char* const dstRow = dst + y*dstRowSize;
+            switch(conversion) {
+                case Conversion::Shuffle:
+                    shuffleRow(srcRow, dstRow, width, source.count, destination.count, map);
+                    break;
+                case Conversion::UnpackHalf:
+                    Math::unpackHalfInto({reinterpret_cast<const UnsignedShort*>(srcRow), componentCount}, {reinterpret_cast<Float*>(dstRow), componentCount});
+                    break;
+                case Conversion::PackHalf:
+                    Math::packHalfInto({reinterpret_cast<const Float*>(srcRow), componentCount}, {reinterpret_cast<UnsignedShort*>(dstRow), componentCount});
+                    break;
+            }
+        }
+    };
+
+    /* Chunks of roughly 64 kB so the threads don't fight over cache lines */
+    const std::size_t height = image.size().y();
+    if(pool && height > 1)
+        pool->parallelFor(height, std::max<std::size_t>(1, 65536/(dstRowSize + 1)), convertRows);
+    else convertRows(0, height);
+
+    return Image2D{storage, format, type, image.size(), std::move(data)};
+}
+
+}
+
+Image2D convertPixels(const ImageView2D& image, const PixelFormat format, const PixelType type) {
+    return convertPixelsInternal(image, format, type, nullptr);
+}
+
+Image2D convertPixels(const ImageView2D& image, const PixelFormat format, const PixelType type, ThreadPool& pool) {
+    return convertPixelsInternal(image, format, type, &pool);
+}
+
+void swapRedBlueInPlace(const Containers::ArrayView<char> data, const std::size_t pixelSize) {
+    CORRADE_ASSERT(pixelSize == 3 || pixelSize == 4,
+        "swapRedBlueInPlace(): expected pixel size 3 or 4 but got" << pixelSize, );
+    CORRADE_ASSERT(data.size() % pixelSize == 0,
+        "swapRedBlueInPlace(): data size" << data.size() << "is not divisible by pixel size" << pixelSize, );
+
+    const Int map[4]{2, 1, 0, 3};
+    shuffleRow(data.data(), data.data(), data.size()/pixelSize, pixelSize, pixelSize, map);
+}
+
+void premultiplyAlphaInPlace(Image2D& image) {
+    CORRADE_ASSERT(image.format() == PixelFormat::RGBA
+        #ifndef MAGNUM_TARGET_WEBGL
+        || image.format() == PixelFormat::BGRA
+        #endif
+        , "premultiplyAlphaInPlace(): expected four-channel image but got" << image.format(), );
+    CORRADE_ASSERT(image.type() == PixelType::UnsignedByte || image.type() == PixelType::Float,
+        "premultiplyAlphaInPlace(): expected unsigned byte or float image but got" << image.type(), );
+
+    char* const data = image.data() + std::get<0>(image.dataProperties()).sum();
+    const std::size_t rowStride = std::get<1>(image.dataProperties()).x();
+    const std::size_t width = image.size().x();
+    for(std::size_t y = 0, height = image.size().y(); y != height; ++y) {
+        if(image.type() == PixelType::UnsignedByte) {
+            UnsignedByte* const row = reinterpret_cast<UnsignedByte*>(data + y*rowStride);
+            for(std::size_t i = 0; i != width*4; i += 4) {
+                const UnsignedInt alpha = row[i + 3];
+                for(std::size_t c = 0; c != 3; ++c)
+                    row[i + c] = UnsignedByte((row[i + c]*alpha + 127)/255);
+            }
+        } else {
+            Float* const row = reinterpret_cast<Float*>(data + y*rowStride);
+            for(std::size_t i = 0; i != width*4; i += 4)
+                for(std::size_t c = 0; c != 3; ++c)
+                    row[i + c] *= row[i + 3];
+        }
+    }
+}
+
+}
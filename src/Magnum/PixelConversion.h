@@ -0,0 +1,94 @@
+#ifndef Magnum_PixelConversion_h
+#define Magnum_PixelConversion_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+/** @file
+ * @brief Function @ref Magnum::convertPixels(), @ref Magnum::swapRedBlueInPlace(), @ref Magnum::premultiplyAlphaInPlace()
+ */
+
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/visibility.h"
+
+namespace Magnum {
+
+/**
+@brief Convert pixels to another format and type
+
+Returns a tightly packed copy of @p image in given @p format and @p type. The
+source @ref PixelStorage parameters are respected. Supported are:
+
+-   reordering, dropping and adding channels of @ref PixelType::UnsignedByte
+    data between @ref PixelFormat::Red, @ref PixelFormat::RG,
+    @ref PixelFormat::RGB, @ref PixelFormat::RGBA, @ref PixelFormat::BGR,
+    @ref PixelFormat::BGRA and on OpenGL ES 2.0 also
+    @ref PixelFormat::Luminance and @ref PixelFormat::LuminanceAlpha.
+    Channels missing in the source are filled with @cpp 0 @ce, alpha with
+    @cpp 255 @ce, luminance is expanded to all three color channels.
+-   converting between @ref PixelType::HalfFloat and @ref PixelType::Float
+    with the same format, using @ref Math::unpackHalfInto() and
+    @ref Math::packHalfInto().
+
+Expects that the conversion is one of the above. If the library is built with
+SSSE3 enabled or for ARM64, the 8-bit channel shuffles process four pixels at
+a time using byte shuffle instructions.
+@see @ref swapRedBlueInPlace(), @ref premultiplyAlphaInPlace()
+*/
+MAGNUM_EXPORT Image2D convertPixels(const ImageView2D& image, PixelFormat format, PixelType type);
+
+/**
+@brief Convert pixels to another format and type in parallel
+
+Same as @ref convertPixels(const ImageView2D&, PixelFormat, PixelType), but
+with rows distributed across threads of @p pool.
+*/
+MAGNUM_EXPORT Image2D convertPixels(const ImageView2D& image, PixelFormat format, PixelType type, ThreadPool& pool);
+
+/**
+@brief Swap red and blue channel in place
+
+Converts tightly packed 8-bit RGB(A) pixels to BGR(A) and back. Expects that
+@p pixelSize is either @cpp 3 @ce or @cpp 4 @ce and that size of @p data is
+divisible by it. Unlike @ref convertPixels() it operates on raw memory, which
+makes it usable also for formats not available on the target, such as BGR on
+OpenGL ES.
+*/
+MAGNUM_EXPORT void swapRedBlueInPlace(Containers::ArrayView<char> data, std::size_t pixelSize);
+
+/**
+@brief Premultiply color channels with alpha in place
+
+Expects that @p image is @ref PixelFormat::RGBA or @ref PixelFormat::BGRA with
+either @ref PixelType::UnsignedByte or @ref PixelType::Float. The 8-bit
+channels are rounded to nearest.
+*/
+MAGNUM_EXPORT void premultiplyAlphaInPlace(Image2D& image);
+
+}
+
+#endif
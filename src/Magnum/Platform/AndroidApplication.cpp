@@ -74,7 +74,7 @@ AndroidApplication::AndroidApplication(const Arguments& arguments, NoCreateT): _
 AndroidApplication::~AndroidApplication() {
     eglMakeCurrent(_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
     eglDestroyContext(_display, _glContext);
-    eglDestroySurface(_display, _surface);
+    if(_surface) eglDestroySurface(_display, _surface);
     eglTerminate(_display);
 }
 
@@ -109,22 +109,21 @@ bool AndroidApplication::tryCreateContext(const Configuration& configuration) {
         EGL_NONE
     };
     EGLint configCount;
-    EGLConfig config;
-    if(!eglChooseConfig(_display, configAttributes, &config, 1, &configCount)) {
+    if(!eglChooseConfig(_display, configAttributes, &_config, 1, &configCount)) {
         Error() << "Platform::AndroidApplication::tryCreateContext(): cannot choose EGL config:"
                 << Implementation::eglErrorString(eglGetError());
         return false;
     }
 
-    /* Resize native window and match it to the selected format */
-    EGLint format;
-    CORRADE_INTERNAL_ASSERT_OUTPUT(eglGetConfigAttrib(_display, config, EGL_NATIVE_VISUAL_ID, &format));
-    ANativeWindow_setBuffersGeometry(_state->window,
-        configuration.size().isZero() ? 0 : configuration.size().x(),
-        configuration.size().isZero() ? 0 : configuration.size().y(), format);
+    /* Resize native window and match it to the selected format. Remember
+       both for when the window gets recreated. */
+    CORRADE_INTERNAL_ASSERT_OUTPUT(eglGetConfigAttrib(_display, _config, EGL_NATIVE_VISUAL_ID, &_nativeFormat));
+    _configuredSize = configuration.size();
+    ANativeWindow_setBuffersGeometry(_state->window, _configuredSize.x(), _configuredSize.y(), _nativeFormat);
+    if(configuration.isContextPreserved()) _flags |= Flag::ContextPreserved;
 
     /* Create surface and context */
-    if(!(_surface = eglCreateWindowSurface(_display, config, _state->window, nullptr))) {
+    if(!(_surface = eglCreateWindowSurface(_display, _config, _state->window, nullptr))) {
         Error() << "Platform::AndroidApplication::tryCreateContext(): cannot create EGL window surface:"
                 << Implementation::eglErrorString(eglGetError());
         return false;
@@ -139,7 +138,7 @@ bool AndroidApplication::tryCreateContext(const Configuration& configuration) {
         #endif
         EGL_NONE
     };
-    if(!(_glContext = eglCreateContext(_display, config, EGL_NO_CONTEXT, contextAttributes))) {
+    if(!(_glContext = eglCreateContext(_display, _config, EGL_NO_CONTEXT, contextAttributes))) {
         Error() << "Platform::AndroidApplication::tryCreateContext(): cannot create EGL context:"
                 << Implementation::eglErrorString(eglGetError());
         return false;
@@ -152,6 +151,31 @@ bool AndroidApplication::tryCreateContext(const Configuration& configuration) {
     return _context->tryCreate();
 }
 
+void AndroidApplication::destroySurface() {
+    /* The context stays alive, just not current */
+    eglMakeCurrent(_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    eglDestroySurface(_display, _surface);
+    _surface = {};
+}
+
+bool AndroidApplication::tryRestoreSurface() {
+    ANativeWindow_setBuffersGeometry(_state->window, _configuredSize.x(), _configuredSize.y(), _nativeFormat);
+    if(!(_surface = eglCreateWindowSurface(_display, _config, _state->window, nullptr))) {
+        Error() << "Platform::AndroidApplication: cannot recreate EGL window surface:"
+                << Implementation::eglErrorString(eglGetError());
+        return false;
+    }
+
+    /* Fails with EGL_CONTEXT_LOST if the context didn't survive the pause */
+    if(!eglMakeCurrent(_display, _surface, _surface, _glContext)) {
+        Warning() << "Platform::AndroidApplication: cannot restore EGL context, recreating the application:"
+                  << Implementation::eglErrorString(eglGetError());
+        return false;
+    }
+
+    return true;
+}
+
 Vector2i AndroidApplication::windowSize() {
     return {ANativeWindow_getWidth(_state->window),
             ANativeWindow_getHeight(_state->window)};
@@ -186,16 +210,27 @@ void AndroidApplication::commandEvent(android_app* state, int32_t cmd) {
             break;
 
         case APP_CMD_INIT_WINDOW:
-            /* Create the application */
-            if(!data.instance) {
-                data.instance = data.instancer(state);
-                data.instance->drawEvent();
+            /* Resume the application with a preserved context, if possible */
+            if(data.instance) {
+                if(data.instance->tryRestoreSurface()) {
+                    data.instance->viewportEvent(data.instance->windowSize());
+                    data.instance->drawEvent();
+                    break;
+                }
+
+                data.instance.reset();
             }
+
+            /* Create the application */
+            data.instance = data.instancer(state);
+            data.instance->drawEvent();
             break;
 
         case APP_CMD_TERM_WINDOW:
-            /* Destroy the application */
-            data.instance.reset();
+            /* Keep the application with its context or destroy it */
+            if(data.instance && (data.instance->_flags & Flag::ContextPreserved))
+                data.instance->destroySurface();
+            else data.instance.reset();
             break;
 
         case APP_CMD_GAINED_FOCUS:
@@ -256,7 +291,7 @@ void AndroidApplication::exec(android_app* state, std::unique_ptr<AndroidApplica
         int ident, events;
         android_poll_source* source;
         while((ident = ALooper_pollAll(
-            data.instance && (data.instance->_flags & Flag::Redraw) ? 0 : -1,
+            data.instance && data.instance->_surface && (data.instance->_flags & Flag::Redraw) ? 0 : -1,
             nullptr, &events, reinterpret_cast<void**>(&source))) >= 0)
         {
             /* Process this event OH SIR MAY MY POOR EXISTENCE CALL THIS
@@ -268,9 +303,9 @@ void AndroidApplication::exec(android_app* state, std::unique_ptr<AndroidApplica
             if(state->destroyRequested != 0) return;
         }
 
-        /* Redraw the app if it wants to be redrawn. Frame limiting is done by
-           Android itself */
-        if(data.instance && (data.instance->_flags & Flag::Redraw))
+        /* Redraw the app if it wants to be redrawn and has a window to draw
+           to. Frame limiting is done by Android itself */
+        if(data.instance && data.instance->_surface && (data.instance->_flags & Flag::Redraw))
             data.instance->drawEvent();
     }
 
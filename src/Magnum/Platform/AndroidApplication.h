@@ -127,6 +127,25 @@ If no other application header is included, this class is also aliased to
 @cpp Platform::Application @ce and the macro is aliased to @cpp MAGNUM_APPLICATION_MAIN() @ce
 to simplify porting.
 
+@section Platform-AndroidApplication-resume Pause and resume
+
+When the application goes to background, Android destroys its window. By
+default the whole application instance is destroyed with it and created
+again when the window is restored, which means all GPU resources have to be
+loaded again. With @ref Configuration::setContextPreserved() enabled, only
+the EGL window surface is destroyed and the instance together with the
+OpenGL context and all its resources stays alive. When the window is
+restored, a new surface is created for the same context and
+@ref viewportEvent() and @ref drawEvent() are called. No drawing is done
+while the application has no window.
+
+The context may still get lost while in background, for example when the
+driver needs the memory back. In that case the instance is destroyed and
+created again as if the context wasn't preserved. Use
+@ref ResourceRestoreCache to keep already processed data such as compressed
+textures and program binaries in memory-mapped files so the new instance can
+restore them without decoding and compiling everything again.
+
 @section Platform-AndroidApplication-output-redirection Redirecting output to Android log buffer
 
 The application by default redirects @ref Corrade::Utility::Debug "Debug",
@@ -276,19 +295,26 @@ class AndroidApplication {
         struct LogOutput;
 
         enum class Flag: UnsignedByte {
-            Redraw = 1 << 0
+            Redraw = 1 << 0,
+            ContextPreserved = 1 << 1
         };
         typedef Containers::EnumSet<Flag> Flags;
 
+        void destroySurface();
+        bool tryRestoreSurface();
+
         static void commandEvent(android_app* state, std::int32_t cmd);
         static std::int32_t inputEvent(android_app* state, AInputEvent* event);
 
         android_app* const _state;
         Flags _flags;
 
-        EGLDisplay _display;
-        EGLSurface _surface;
-        EGLContext _glContext;
+        EGLDisplay _display{};
+        EGLConfig _config{};
+        EGLSurface _surface{};
+        EGLContext _glContext{};
+        EGLint _nativeFormat{};
+        Vector2i _configuredSize;
 
         std::unique_ptr<Platform::Context> _context;
         std::unique_ptr<LogOutput> _logOutput;
@@ -344,8 +370,25 @@ class AndroidApplication::Configuration {
          */
         Configuration& setVersion(Version) { return *this; }
 
+        /** @brief Whether the context is preserved when the window is destroyed */
+        bool isContextPreserved() const { return _contextPreserved; }
+
+        /**
+         * @brief Preserve the context when the window is destroyed
+         * @return Reference to self (for method chaining)
+         *
+         * Default is @cpp false @ce, which means the application instance is
+         * destroyed together with the window. See
+         * @ref Platform-AndroidApplication-resume for more information.
+         */
+        Configuration& setContextPreserved(bool preserved) {
+            _contextPreserved = preserved;
+            return *this;
+        }
+
     private:
         Vector2i _size;
+        bool _contextPreserved{};
 };
 
 /**
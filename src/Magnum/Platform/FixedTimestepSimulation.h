@@ -0,0 +1,277 @@
+#ifndef Magnum_Platform_FixedTimestepSimulation_h
+#define Magnum_Platform_FixedTimestepSimulation_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Platform::FixedTimestepSimulation
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include <thread>
+#endif
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Magnum.h"
+
+namespace Magnum { namespace Platform {
+
+/**
+@brief Fixed-timestep simulation
+
+Runs a simulation at a fixed tick rate on a dedicated thread, independently
+of the rate at which the application draws. Each tick produces a snapshot,
+for example with transformations of all objects, and the draw event takes
+the last two of them together with an interpolation factor for blending
+between them. The rendered state is thus one tick behind, but moves smoothly
+regardless of the display refresh rate. Works with any of the
+@ref platform "application classes".
+
+Subclass it and implement @ref doTick(), which advances the simulation state
+stored in the subclass and writes the snapshot:
+
+@code{.cpp}
+struct Snapshot {
+    std::vector<Matrix4> transformations;
+};
+
+class Simulation: public Platform::FixedTimestepSimulation<Snapshot> {
+    public:
+        explicit Simulation(): Platform::FixedTimestepSimulation<Snapshot>{std::chrono::milliseconds{10}} {}
+
+        ~Simulation() { stop(); }
+
+    private:
+        void doTick(Float timestep, Snapshot& snapshot) override {
+            // Advance the physics by timestep...
+            snapshot.transformations = ...;
+        }
+};
+
+void MyApplication::drawEvent() {
+    Snapshot previous, current;
+    const Float t = _simulation.snapshots(previous, current);
+    for(std::size_t i = 0; i != current.transformations.size(); ++i)
+        _drawables[i].setTransformation(Math::lerp(previous.transformations[i], current.transformations[i], t));
+
+    // ...
+
+    redraw();
+}
+@endcode
+
+The simulation thread is started with @ref start() and stopped with
+@ref stop(). Because the thread calls a virtual function, the subclass
+destructor has to call @ref stop(). Passing input to the simulation is up to
+the user, for example through a mutex-guarded queue that @ref doTick()
+consumes.
+
+If a tick takes longer than the timestep, the simulation runs as fast as it
+can until it catches up. On platforms without thread support (such as
+@ref CORRADE_TARGET_EMSCRIPTEN "Emscripten") the ticks that are due are run
+on the calling thread in @ref snapshots().
+*/
+template<class Snapshot> class FixedTimestepSimulation {
+    public:
+        /**
+         * @brief Constructor
+         * @param timestep  Simulation timestep
+         *
+         * Expects that @p timestep is non-zero. Doesn't start the
+         * simulation, call @ref start() for that.
+         */
+        explicit FixedTimestepSimulation(std::chrono::nanoseconds timestep);
+
+        /** @brief Copying is not allowed */
+        FixedTimestepSimulation(const FixedTimestepSimulation<Snapshot>&) = delete;
+
+        /** @brief Copying is not allowed */
+        FixedTimestepSimulation<Snapshot>& operator=(const FixedTimestepSimulation<Snapshot>&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Calls @ref stop().
+         */
+        virtual ~FixedTimestepSimulation();
+
+        /** @brief Simulation timestep */
+        std::chrono::nanoseconds timestep() const { return _timestep; }
+
+        /** @brief Whether the simulation is running */
+        bool isRunning() const { return _running; }
+
+        /** @brief Count of ticks done since the simulation was created */
+        std::size_t tickCount() const { return _tickCount; }
+
+        /**
+         * @brief Start the simulation
+         *
+         * The first tick is done immediately. If the simulation is already
+         * running, does nothing.
+         */
+        void start();
+
+        /**
+         * @brief Stop the simulation
+         *
+         * Waits for the current tick to finish. If the simulation is not
+         * running, does nothing.
+         */
+        void stop();
+
+        /**
+         * @brief Last two snapshots
+         * @param[out] previous     Snapshot produced by the second last tick
+         * @param[out] current      Snapshot produced by the last tick
+         * @return Interpolation factor between @p previous and @p current in
+         *      range @f$ [0, 1] @f$
+         *
+         * The factor is computed from the time elapsed since the last tick
+         * was scheduled. Before the second tick, both snapshots are the
+         * same.
+         */
+        Float snapshots(Snapshot& previous, Snapshot& current);
+
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    private:
+    #else
+    protected:
+    #endif
+        /**
+         * @brief Advance the simulation
+         * @param timestep  Timestep in seconds
+         * @param snapshot  Snapshot to write the result to
+         *
+         * Called from the simulation thread. The @p snapshot contains data
+         * of an earlier tick, so its memory can be reused without
+         * allocating.
+         */
+        virtual void doTick(Float timestep, Snapshot& snapshot) = 0;
+
+    private:
+        typedef std::chrono::steady_clock Clock;
+        typedef std::unique_lock<std::mutex> Lock;
+
+        /* Runs a tick and publishes its snapshot */
+        void tick();
+
+        const std::chrono::nanoseconds _timestep;
+        std::mutex _mutex;
+        std::condition_variable _wakeUp;
+        /* Snapshots are triple-buffered, the simulation writes into _next
+           without holding the lock while the other two are read */
+        Snapshot _snapshots[3];
+        UnsignedByte _previous{0}, _current{1}, _next{2};
+        Clock::time_point _currentTime, _nextTime;
+        std::atomic<std::size_t> _tickCount{};
+        std::atomic<bool> _running{};
+        bool _stop{};
+        #ifndef CORRADE_TARGET_EMSCRIPTEN
+        std::thread _thread;
+        #endif
+};
+
+template<class Snapshot> FixedTimestepSimulation<Snapshot>::FixedTimestepSimulation(const std::chrono::nanoseconds timestep): _timestep{timestep} {
+    CORRADE_ASSERT(timestep.count(), "Platform::FixedTimestepSimulation: expected non-zero timestep", );
+}
+
+template<class Snapshot> FixedTimestepSimulation<Snapshot>::~FixedTimestepSimulation() {
+    stop();
+}
+
+template<class Snapshot> void FixedTimestepSimulation<Snapshot>::start() {
+    if(_running) return;
+    _running = true;
+    _stop = false;
+    _nextTime = Clock::now();
+
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    _thread = std::thread{[this]() {
+        Lock lock{_mutex};
+        for(;;) {
+            /* Sleep until the next tick is due or until stopped */
+            _wakeUp.wait_until(lock, _nextTime, [this]() { return _stop || Clock::now() >= _nextTime; });
+            if(_stop) return;
+
+            lock.unlock();
+            tick();
+            lock.lock();
+        }
+    }};
+    #endif
+}
+
+template<class Snapshot> void FixedTimestepSimulation<Snapshot>::stop() {
+    if(!_running) return;
+
+    {
+        Lock lock{_mutex};
+        _stop = true;
+    }
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    _wakeUp.notify_all();
+    _thread.join();
+    #endif
+    _running = false;
+}
+
+template<class Snapshot> void FixedTimestepSimulation<Snapshot>::tick() {
+    doTick(std::chrono::duration<Float>{_timestep}.count(), _snapshots[_next]);
+
+    Lock lock{_mutex};
+    /* The first tick fills both snapshots so there's nothing to interpolate
+       from a default-constructed one */
+    if(!_tickCount) _snapshots[_current] = _snapshots[_next];
+    const UnsignedByte previous = _previous;
+    _previous = _current;
+    _current = _next;
+    _next = previous;
+    _currentTime = _nextTime;
+    _nextTime += _timestep;
+    ++_tickCount;
+}
+
+template<class Snapshot> Float FixedTimestepSimulation<Snapshot>::snapshots(Snapshot& previous, Snapshot& current) {
+    #ifdef CORRADE_TARGET_EMSCRIPTEN
+    /* Run the ticks that are due on this thread */
+    if(_running) while(Clock::now() >= _nextTime) tick();
+    #endif
+
+    Lock lock{_mutex};
+    previous = _snapshots[_previous];
+    current = _snapshots[_current];
+    if(!_tickCount) return 0.0f;
+    return std::min(std::max(std::chrono::duration<Float>{Clock::now() - _currentTime}/std::chrono::duration<Float>{_timestep}, 0.0f), 1.0f);
+}
+
+}}
+
+#endif
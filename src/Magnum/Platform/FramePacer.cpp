@@ -0,0 +1,113 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "FramePacer.h"
+
+#include <thread>
+
+namespace Magnum { namespace Platform {
+
+FramePacer::FramePacer(): _period{}, _spinThreshold{std::chrono::milliseconds{2}}, _maxFramesInFlight{}, _hasPreviousFrame{}, _metrics{}
+    #ifndef MAGNUM_TARGET_GLES2
+    , _currentFence{}
+    #endif
+    {}
+
+FramePacer::~FramePacer() = default;
+
+FramePacer& FramePacer::setPeriod(const std::chrono::nanoseconds period) {
+    _period = period;
+    return *this;
+}
+
+FramePacer& FramePacer::setSpinThreshold(const std::chrono::nanoseconds threshold) {
+    _spinThreshold = threshold;
+    return *this;
+}
+
+FramePacer& FramePacer::setMaxFramesInFlight(const UnsignedInt count) {
+    _maxFramesInFlight = count;
+    #ifndef MAGNUM_TARGET_GLES2
+    _fences.clear();
+    _fences.resize(count);
+    _currentFence = 0;
+    #endif
+    return *this;
+}
+
+void FramePacer::beginFrame() {
+    Clock::time_point now = Clock::now();
+
+    /* Wait for the deadline, sleeping for the coarse part and spinning for
+       the rest */
+    _metrics.waitTime = {};
+    if(_period.count() && _hasPreviousFrame) {
+        if(now < _deadline) {
+            const Clock::time_point waitBegin = now;
+            if(_deadline - now > _spinThreshold)
+                std::this_thread::sleep_for(_deadline - now - _spinThreshold);
+            while((now = Clock::now()) < _deadline)
+                std::this_thread::yield();
+            _metrics.waitTime = now - waitBegin;
+
+        /* Missed the deadline, schedule the next one from now to avoid a
+           burst of frames catching up */
+        } else {
+            ++_metrics.missedCount;
+            _deadline = now;
+        }
+    } else _deadline = now;
+    _deadline += _period;
+
+    /* Wait until the GPU catches up. Done after the deadline wait, as the GPU
+       has likely finished in the meantime. */
+    _metrics.fenceWaitTime = {};
+    #ifndef MAGNUM_TARGET_GLES2
+    if(_maxFramesInFlight && !_fences[_currentFence].isEmpty()) {
+        const Clock::time_point waitBegin = Clock::now();
+        _fences[_currentFence].clientWait(std::chrono::seconds{1});
+        now = Clock::now();
+        _metrics.fenceWaitTime = now - waitBegin;
+    }
+    #endif
+
+    if(_hasPreviousFrame) _metrics.frameTime = now - _frameBegin;
+    _frameBegin = now;
+    _hasPreviousFrame = true;
+}
+
+void FramePacer::endFrame() {
+    _metrics.workTime = Clock::now() - _frameBegin;
+    ++_metrics.frameCount;
+
+    #ifndef MAGNUM_TARGET_GLES2
+    if(_maxFramesInFlight) {
+        _fences[_currentFence].insert();
+        _currentFence = (_currentFence + 1) % _fences.size();
+    }
+    #endif
+}
+
+}}
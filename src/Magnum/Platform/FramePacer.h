@@ -0,0 +1,207 @@
+#ifndef Magnum_Platform_FramePacer_h
+#define Magnum_Platform_FramePacer_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Platform::FramePacer
+ */
+
+#include <chrono>
+#include <vector>
+
+#include "Magnum/Magnum.h"
+#ifndef MAGNUM_TARGET_GLES2
+#include "Magnum/Fence.h"
+#endif
+
+namespace Magnum { namespace Platform {
+
+/**
+@brief Frame pacer
+
+Used by @ref Sdl2Application and @ref GlfwApplication to schedule frames, but
+can be used standalone in a custom main loop as well. With a period set using
+@ref setPeriod(), @ref beginFrame() waits until the deadline of the next frame
+--- first by sleeping and then by spinning for the last
+@ref spinThreshold() of the wait, as sleep alone usually has a granularity of
+a millisecond or worse. The applications call @ref beginFrame() *before*
+processing input events, so the input is sampled as late as possible before
+drawing instead of a whole frame earlier.
+
+@code{.cpp}
+framePacer()
+    .setPeriod(std::chrono::microseconds{16667})
+    .setMaxFramesInFlight(1);
+@endcode
+
+@section Platform-FramePacer-frames-in-flight Frames in flight
+
+Drivers commonly let the CPU run several frames ahead of the GPU, which adds
+the same amount of frames to the latency between input and the result on
+screen. With @ref setMaxFramesInFlight(), a @ref Fence is inserted in
+@ref endFrame() and @ref beginFrame() waits until the GPU processed all but
+the given count of previous frames.
+
+@section Platform-FramePacer-metrics Metrics
+
+Timing of the last frame is available through @ref metrics() and can be
+passed for example to @ref DebugTools::FrameProfiler::addCounter().
+
+@note Frames in flight are not limited on OpenGL ES 2.0 and WebGL 1.0, as
+    sync objects are not available there.
+*/
+class FramePacer {
+    public:
+        /**
+         * @brief Frame metrics
+         *
+         * @see @ref metrics()
+         */
+        struct Metrics {
+            /** @brief Time between beginnings of the last two frames */
+            std::chrono::nanoseconds frameTime;
+
+            /**
+             * @brief Time spent between @ref beginFrame() and @ref endFrame()
+             * of the last frame
+             */
+            std::chrono::nanoseconds workTime;
+
+            /** @brief Time spent waiting for the frame deadline */
+            std::chrono::nanoseconds waitTime;
+
+            /**
+             * @brief Time spent waiting for the GPU
+             *
+             * @see @ref setMaxFramesInFlight()
+             */
+            std::chrono::nanoseconds fenceWaitTime;
+
+            /** @brief Count of frames */
+            std::size_t frameCount;
+
+            /**
+             * @brief Count of frames that started after their deadline
+             *
+             * Counted only if @ref period() is non-zero.
+             */
+            std::size_t missedCount;
+        };
+
+        /**
+         * @brief Constructor
+         *
+         * No pacing is done by default.
+         */
+        explicit FramePacer();
+
+        /** @brief Copying is not allowed */
+        FramePacer(const FramePacer&) = delete;
+
+        /** @brief Copying is not allowed */
+        FramePacer& operator=(const FramePacer&) = delete;
+
+        ~FramePacer();
+
+        /** @brief Whether any pacing is done */
+        bool isEnabled() const { return _period.count() || _maxFramesInFlight; }
+
+        /** @brief Frame period */
+        std::chrono::nanoseconds period() const { return _period; }
+
+        /**
+         * @brief Set frame period
+         * @return Reference to self (for method chaining)
+         *
+         * If non-zero, @ref beginFrame() waits until given time passes since
+         * the deadline of the previous frame. If a frame misses its deadline,
+         * the next deadline is counted from the actual start, so late frames
+         * aren't followed by a burst of frames catching up. Default is
+         * @cpp 0 @ce, i.e. no waiting.
+         */
+        FramePacer& setPeriod(std::chrono::nanoseconds period);
+
+        /** @brief Spin threshold */
+        std::chrono::nanoseconds spinThreshold() const { return _spinThreshold; }
+
+        /**
+         * @brief Set spin threshold
+         * @return Reference to self (for method chaining)
+         *
+         * How long before the deadline to stop sleeping and spin instead.
+         * Higher values trade CPU time for precision. Default is 2 ms.
+         */
+        FramePacer& setSpinThreshold(std::chrono::nanoseconds threshold);
+
+        /** @brief Max count of frames in flight */
+        UnsignedInt maxFramesInFlight() const { return _maxFramesInFlight; }
+
+        /**
+         * @brief Set max count of frames in flight
+         * @return Reference to self (for method chaining)
+         *
+         * If non-zero, @ref beginFrame() waits until the GPU finished all
+         * frames except the last @p count ones. Default is @cpp 0 @ce, i.e.
+         * driver-controlled. See @ref Platform-FramePacer-frames-in-flight
+         * for more information.
+         */
+        FramePacer& setMaxFramesInFlight(UnsignedInt count);
+
+        /** @brief Metrics of the last frame */
+        const Metrics& metrics() const { return _metrics; }
+
+        /**
+         * @brief Begin a frame
+         *
+         * Waits for the frame deadline and for the GPU, if enabled.
+         */
+        void beginFrame();
+
+        /**
+         * @brief End a frame
+         *
+         * Expected to be called after swapping buffers. Inserts a fence if
+         * @ref maxFramesInFlight() is non-zero.
+         */
+        void endFrame();
+
+    private:
+        typedef std::chrono::steady_clock Clock;
+
+        std::chrono::nanoseconds _period, _spinThreshold;
+        UnsignedInt _maxFramesInFlight;
+        Clock::time_point _deadline, _frameBegin;
+        bool _hasPreviousFrame;
+        Metrics _metrics;
+        #ifndef MAGNUM_TARGET_GLES2
+        std::vector<Fence> _fences;
+        std::size_t _currentFence;
+        #endif
+};
+
+}}
+
+#endif
@@ -166,6 +166,17 @@ int GlfwApplication::exec() {
     while(!glfwWindowShouldClose(_window)) {
         if(_flags & Flag::Redraw) {
             _flags &= ~Flag::Redraw;
+
+            /* Wait for the frame deadline first and then sample input right
+               before drawing */
+            if(_framePacer.isEnabled()) {
+                _framePacer.beginFrame();
+                glfwPollEvents();
+                drawEvent();
+                _framePacer.endFrame();
+                continue;
+            }
+
             drawEvent();
         }
         glfwPollEvents();
@@ -37,6 +37,7 @@
 #include "Magnum/Magnum.h"
 #include "Magnum/Tags.h"
 #include "Magnum/Math/Vector2.h"
+#include "Magnum/Platform/FramePacer.h"
 #include "Magnum/Platform/Platform.h"
 
 /* We must include our own GL headers first to avoid conflicts */
@@ -230,6 +231,9 @@ class GlfwApplication {
         /** @copydoc Sdl2Application::redraw() */
         void redraw() { _flags |= Flag::Redraw; }
 
+        /** @copydoc Sdl2Application::framePacer() */
+        FramePacer& framePacer() { return _framePacer; }
+
     #ifdef DOXYGEN_GENERATING_OUTPUT
     protected:
     #else
@@ -357,6 +361,7 @@ class GlfwApplication {
 
         GLFWwindow* _window;
         std::unique_ptr<Platform::Context> _context;
+        FramePacer _framePacer;
         Flags _flags;
 };
 
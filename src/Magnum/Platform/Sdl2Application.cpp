@@ -30,6 +30,9 @@
 #include <tuple>
 #else
 #include <emscripten/emscripten.h>
+#ifdef __EMSCRIPTEN_PTHREADS__
+#include <emscripten/html5.h>
+#endif
 #endif
 
 #include "Magnum/Version.h"
@@ -238,6 +241,23 @@ bool Sdl2Application::tryCreateContext(const Configuration& configuration) {
     SDL_GL_GetDrawableSize(_window, &drawableSize.x(), &drawableSize.y());
     glViewport(0, 0, drawableSize.x(), drawableSize.y());
     #endif
+    #elif defined(__EMSCRIPTEN_PTHREADS__)
+    /* Running in a worker, create the WebGL context on the OffscreenCanvas
+       transferred to this thread. SDL_SetVideoMode() would be proxied to the
+       main thread and create the context there. */
+    EmscriptenWebGLContextAttributes attributes;
+    emscripten_webgl_init_context_attributes(&attributes);
+    attributes.antialias = configuration.sampleCount() > 1;
+    attributes.explicitSwapControl = true;
+    #ifndef MAGNUM_TARGET_GLES2
+    attributes.majorVersion = 2;
+    #endif
+    if(!(_offscreenGLContext = emscripten_webgl_create_context("#module", &attributes))) {
+        Error() << "Platform::Sdl2Application::tryCreateContext(): cannot create context on the offscreen canvas";
+        return false;
+    }
+    emscripten_set_canvas_element_size("#module", configuration.size().x(), configuration.size().y());
+    emscripten_webgl_make_context_current(_offscreenGLContext);
     #else
     /* Emscripten-specific initialization */
     if(!(_glContext = SDL_SetVideoMode(configuration.size().x(), configuration.size().y(), 24, SDL_OPENGL|SDL_HWSURFACE|SDL_DOUBLEBUF))) {
@@ -252,6 +272,9 @@ bool Sdl2Application::tryCreateContext(const Configuration& configuration) {
         SDL_GL_DeleteContext(_glContext);
         SDL_DestroyWindow(_window);
         _window = nullptr;
+        #elif defined(__EMSCRIPTEN_PTHREADS__)
+        emscripten_webgl_destroy_context(_offscreenGLContext);
+        _offscreenGLContext = {};
         #else
         SDL_FreeSurface(_glContext);
         #endif
@@ -273,6 +296,10 @@ Vector2i Sdl2Application::windowSize() {
     Vector2i size;
     SDL_GetWindowSize(_window, &size.x(), &size.y());
     return size;
+    #elif defined(__EMSCRIPTEN_PTHREADS__)
+    Vector2i size;
+    emscripten_get_canvas_element_size("#module", &size.x(), &size.y());
+    return size;
     #else
     return {_glContext->w, _glContext->h};
     #endif
@@ -281,6 +308,8 @@ Vector2i Sdl2Application::windowSize() {
 void Sdl2Application::swapBuffers() {
     #ifndef CORRADE_TARGET_EMSCRIPTEN
     SDL_GL_SwapWindow(_window);
+    #elif defined(__EMSCRIPTEN_PTHREADS__)
+    emscripten_webgl_commit_frame();
     #else
     SDL_Flip(_glContext);
     #endif
@@ -313,6 +342,8 @@ Sdl2Application::~Sdl2Application() {
     #ifndef CORRADE_TARGET_EMSCRIPTEN
     SDL_GL_DeleteContext(_glContext);
     SDL_DestroyWindow(_window);
+    #elif defined(__EMSCRIPTEN_PTHREADS__)
+    if(_offscreenGLContext) emscripten_webgl_destroy_context(_offscreenGLContext);
     #else
     SDL_FreeSurface(_glContext);
     #endif
@@ -338,13 +369,37 @@ void Sdl2Application::exit() {
     #endif
 }
 
+void Sdl2Application::flushCoalescedInput() {
+    if(!_mouseMoveHistory.empty()) {
+        MouseMoveEvent e{_mouseMoveHistory.back(), _mouseMoveRelativePosition, static_cast<MouseMoveEvent::Button>(_mouseMoveButtons), {_mouseMoveHistory.data(), _mouseMoveHistory.size()}};
+        mouseMoveEvent(e);
+        _mouseMoveHistory.clear();
+    }
+
+    if(!_textInput.empty()) {
+        TextInputEvent e{{_textInput.data(), _textInput.size()}};
+        textInputEvent(e);
+        _textInput.clear();
+    }
+}
+
 void Sdl2Application::mainLoopIteration() {
     #ifndef CORRADE_TARGET_EMSCRIPTEN
     const UnsignedInt timeBefore = _minimalLoopPeriod ? SDL_GetTicks() : 0;
+
+    /* If a frame is going to be drawn, wait for its deadline before
+       processing input, so the input is sampled as late as possible */
+    const bool paced = (_flags & Flag::Redraw) && _framePacer.isEnabled();
+    if(paced) _framePacer.beginFrame();
     #endif
 
     SDL_Event event;
     while(SDL_PollEvent(&event)) {
+        /* Deliver coalesced input before any other event to preserve the
+           ordering */
+        if((_flags & Flag::InputCoalescing) && event.type != SDL_MOUSEMOTION && event.type != SDL_TEXTINPUT)
+            flushCoalescedInput();
+
         switch(event.type) {
             case SDL_WINDOWEVENT:
                 switch(event.window.event) {
@@ -405,6 +460,15 @@ void Sdl2Application::mainLoopIteration() {
             } break;
 
             case SDL_MOUSEMOTION: {
+                if(_flags & Flag::InputCoalescing) {
+                    if(!_textInput.empty()) flushCoalescedInput();
+                    if(_mouseMoveHistory.empty()) _mouseMoveRelativePosition = {};
+                    _mouseMoveHistory.emplace_back(event.motion.x, event.motion.y);
+                    _mouseMoveRelativePosition += Vector2i{event.motion.xrel, event.motion.yrel};
+                    _mouseMoveButtons = event.motion.state;
+                    break;
+                }
+
                 MouseMoveEvent e({event.motion.x, event.motion.y}, {event.motion.xrel, event.motion.yrel}, static_cast<MouseMoveEvent::Button>(event.motion.state));
                 mouseMoveEvent(e);
                 break;
@@ -417,6 +481,12 @@ void Sdl2Application::mainLoopIteration() {
             }
 
             case SDL_TEXTINPUT: {
+                if(_flags & Flag::InputCoalescing) {
+                    if(!_mouseMoveHistory.empty()) flushCoalescedInput();
+                    _textInput += event.text.text;
+                    break;
+                }
+
                 TextInputEvent e{{event.text.text, std::strlen(event.text.text)}};
                 textInputEvent(e);
             } break;
@@ -436,6 +506,8 @@ void Sdl2Application::mainLoopIteration() {
         }
     }
 
+    if(_flags & Flag::InputCoalescing) flushCoalescedInput();
+
     /* Tick event */
     if(!(_flags & Flag::NoTickEvent)) tickEvent();
 
@@ -445,8 +517,10 @@ void Sdl2Application::mainLoopIteration() {
         drawEvent();
 
         #ifndef CORRADE_TARGET_EMSCRIPTEN
+        if(paced) _framePacer.endFrame();
+
         /* If VSync is not enabled, delay to prevent CPU hogging (if set) */
-        if(!(_flags & Flag::VSyncEnabled) && _minimalLoopPeriod) {
+        else if(!(_flags & Flag::VSyncEnabled) && _minimalLoopPeriod) {
             const UnsignedInt loopTime = SDL_GetTicks() - timeBefore;
             if(loopTime < _minimalLoopPeriod)
                 SDL_Delay(_minimalLoopPeriod - loopTime);
@@ -30,6 +30,8 @@
  */
 
 #include <memory>
+#include <string>
+#include <vector>
 #include <Corrade/Corrade.h>
 #include <Corrade/Containers/ArrayView.h>
 #include <Corrade/Containers/EnumSet.h>
@@ -37,6 +39,9 @@
 #include "Magnum/Magnum.h"
 #include "Magnum/Tags.h"
 #include "Magnum/Math/Vector2.h"
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include "Magnum/Platform/FramePacer.h"
+#endif
 #include "Magnum/Platform/Platform.h"
 
 #ifdef CORRADE_TARGET_WINDOWS /* Windows version of SDL2 redefines main(), we don't want that */
@@ -44,6 +49,9 @@
 #endif
 #include <SDL.h>
 #include <SDL_scancode.h>
+#ifdef __EMSCRIPTEN_PTHREADS__
+#include <emscripten/html5.h>
+#endif
 
 #ifdef CORRADE_TARGET_WINDOWS_RT
 #include <SDL_main.h> /* For SDL_WinRTRunApp */
@@ -261,6 +269,27 @@ to JavaScript console. It's possible to pass command-line arguments to
 `/app/?foo=bar&fizz&buzz=3` will go to the app as
 @cb{.py} ['--foo', 'bar', '--fizz', '--buzz', '3'] @ce.
 
+@subsection Platform-Sdl2Application-usage-emscripten-worker Rendering in a Web Worker
+
+By default the application renders on the browser main thread and a long frame
+blocks any interaction with the page. If the application is built with
+pthreads enabled, its @cpp main() @ce can run in a worker and render to an
+@m_class{m-doc-external} [OffscreenCanvas](https://developer.mozilla.org/en-US/docs/Web/API/OffscreenCanvas)
+transferred to it from the main thread. Link the executable with the following
+flags:
+
+@code{.sh}
+-s USE_PTHREADS=1 -s PROXY_TO_PTHREAD=1 -s OFFSCREENCANVAS_SUPPORT=1 \
+    -s OFFSCREENCANVASES_TO_PTHREAD='#module'
+@endcode
+
+The WebGL context is then created directly on the @cb{.html} <canvas id="module"> @ce
+transferred to the worker and @ref swapBuffers() commits the frame to it
+explicitly. Input events are still collected by SDL on the main thread and
+forwarded to the worker when polled, so the event handling doesn't need any
+changes. Not every browser supports OffscreenCanvas with WebGL, check before
+deploying.
+
 @section Platform-Sdl2Application-usage-ios Usage with iOS
 
 A lot of options for iOS build (such as HiDPI/Retina support, supported display
@@ -529,7 +558,8 @@ class Sdl2Application {
          *
          * This setting reduces the main loop frequency in case VSync is
          * not/cannot be enabled or no drawing is done. Default is @cpp 0 @ce
-         * (i.e. looping at maximum frequency).
+         * (i.e. looping at maximum frequency). Ignored for drawn frames if
+         * @ref framePacer() is enabled.
          * @note Not available in @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten",
          *      the browser is managing the frequency instead.
          * @see @ref setSwapInterval()
@@ -537,6 +567,19 @@ class Sdl2Application {
         void setMinimalLoopPeriod(UnsignedInt milliseconds) {
             _minimalLoopPeriod = milliseconds;
         }
+
+        /**
+         * @brief Frame pacer
+         *
+         * If enabled, frames that are going to be drawn wait in
+         * @ref FramePacer::beginFrame() before input events are processed,
+         * so the input is sampled as late as possible, and
+         * @ref FramePacer::endFrame() is called after @ref drawEvent().
+         * Disabled by default. See @ref FramePacer for more information.
+         * @note Not available in @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten",
+         *      the browser is managing the frequency instead.
+         */
+        FramePacer& framePacer() { return _framePacer; }
         #endif
 
         /**
@@ -548,6 +591,33 @@ class Sdl2Application {
          */
         void redraw() { _flags |= Flag::Redraw; }
 
+        /**
+         * @brief Whether input coalescing is enabled
+         *
+         * @see @ref setInputCoalescing()
+         */
+        bool isInputCoalescing() const { return !!(_flags & Flag::InputCoalescing); }
+
+        /**
+         * @brief Enable or disable input coalescing
+         *
+         * If enabled, consecutive mouse move events received in one main
+         * loop iteration are merged into a single @ref mouseMoveEvent() with
+         * the latest position, accumulated
+         * @ref MouseMoveEvent::relativePosition() and all intermediate
+         * positions available through @ref MouseMoveEvent::history().
+         * Similarly, consecutive text input events are merged into a single
+         * @ref textInputEvent(). Events are merged only if no other event is
+         * between them, so the relative order with e.g. mouse presses is
+         * preserved. This significantly reduces the event handling overhead
+         * and redundant @ref redraw() calls with high polling rate mice.
+         * Disabled by default.
+         */
+        void setInputCoalescing(bool enabled) {
+            if(enabled) _flags |= Flag::InputCoalescing;
+            else _flags &= ~Flag::InputCoalescing;
+        }
+
     #ifdef DOXYGEN_GENERATING_OUTPUT
     protected:
     #else
@@ -747,27 +817,41 @@ class Sdl2Application {
             VSyncEnabled = 1 << 1,
             NoTickEvent = 1 << 2,
             #ifndef CORRADE_TARGET_EMSCRIPTEN
-            Exit = 1 << 3
+            Exit = 1 << 3,
             #endif
             #ifdef CORRADE_TARGET_EMSCRIPTEN
-            TextInputActive = 1 << 4
+            TextInputActive = 1 << 4,
             #endif
+            InputCoalescing = 1 << 5
         };
 
         typedef Containers::EnumSet<Flag> Flags;
         CORRADE_ENUMSET_FRIEND_OPERATORS(Flags)
 
+        void flushCoalescedInput();
+
         #ifndef CORRADE_TARGET_EMSCRIPTEN
         SDL_Window* _window;
         SDL_GLContext _glContext;
         UnsignedInt _minimalLoopPeriod;
+        FramePacer _framePacer;
         #else
         SDL_Surface* _glContext;
+        #ifdef __EMSCRIPTEN_PTHREADS__
+        EMSCRIPTEN_WEBGL_CONTEXT_HANDLE _offscreenGLContext{};
+        #endif
         #endif
 
         std::unique_ptr<Platform::Context> _context;
 
         Flags _flags;
+
+        /* Coalesced input, the mouse move is pending if the history is not
+           empty */
+        std::vector<Vector2i> _mouseMoveHistory;
+        Vector2i _mouseMoveRelativePosition;
+        Uint32 _mouseMoveButtons;
+        std::string _textInput;
 };
 
 /**
@@ -1453,6 +1537,16 @@ class Sdl2Application::MouseMoveEvent: public Sdl2Application::InputEvent {
         /** @brief Mouse buttons */
         constexpr Buttons buttons() const { return _buttons; }
 
+        /**
+         * @brief Position history
+         *
+         * If @ref Sdl2Application::setInputCoalescing() "input coalescing" is
+         * enabled, contains positions of all merged mouse move events in
+         * order they arrived, the last one being equal to @ref position().
+         * Empty otherwise.
+         */
+        constexpr Containers::ArrayView<const Vector2i> history() const { return _history; }
+
         /**
          * @brief Modifiers
          *
@@ -1461,10 +1555,11 @@ class Sdl2Application::MouseMoveEvent: public Sdl2Application::InputEvent {
         Modifiers modifiers();
 
     private:
-        constexpr MouseMoveEvent(const Vector2i& position, const Vector2i& relativePosition, Buttons buttons): _position{position}, _relativePosition{relativePosition}, _buttons{buttons}, _modifiersLoaded{false} {}
+        constexpr MouseMoveEvent(const Vector2i& position, const Vector2i& relativePosition, Buttons buttons, Containers::ArrayView<const Vector2i> history = nullptr): _position{position}, _relativePosition{relativePosition}, _buttons{buttons}, _history{history}, _modifiersLoaded{false} {}
 
         const Vector2i _position, _relativePosition;
         const Buttons _buttons;
+        const Containers::ArrayView<const Vector2i> _history;
         bool _modifiersLoaded;
         Modifiers _modifiers;
 };
@@ -35,7 +35,7 @@
 
 namespace Magnum { namespace Platform {
 
-WindowlessCglContext::WindowlessCglContext(const Configuration&, Context*) {
+WindowlessCglContext::WindowlessCglContext(const Configuration& configuration, Context*) {
     int formatCount;
     CGLPixelFormatAttribute attributes32[] = {
         kCGLPFAAccelerated,
@@ -68,7 +68,7 @@ WindowlessCglContext::WindowlessCglContext(const Configuration&, Context*) {
         }
     }
 
-    if(CGLCreateContext(_pixelFormat, nullptr, &_context) != kCGLNoError)
+    if(CGLCreateContext(_pixelFormat, configuration.sharedContext(), &_context) != kCGLNoError)
         Error() << "Platform::WindowlessCglContext: cannot create context";
 }
 
@@ -114,6 +114,16 @@ class WindowlessCglContext {
          */
         bool makeCurrent();
 
+        /**
+         * @brief Underlying OpenGL context
+         *
+         * Use in case you need to call CGL functionality directly or in order
+         * to create a shared context using
+         * @ref Configuration::setSharedContext(). Returns @cpp nullptr @ce in
+         * case the context was not created yet.
+         */
+        CGLContextObj glContext() { return _context; }
+
     private:
         CGLPixelFormatObj _pixelFormat{};
         CGLContextObj _context{};
@@ -130,6 +140,29 @@ class WindowlessCglContext {
 class WindowlessCglContext::Configuration {
     public:
         constexpr /*implicit*/ Configuration() {}
+
+        /** @brief Shared context */
+        CGLContextObj sharedContext() const { return _sharedContext; }
+
+        /**
+         * @brief Set context to share objects with
+         * @return Reference to self (for method chaining)
+         *
+         * When set, the created context will share a subset of OpenGL objects
+         * with @p context, instead of being independent. Many caveats and
+         * limitations apply to shared OpenGL contexts, please consult the
+         * OpenGL specification for details. Default is @cpp nullptr @ce, i.e.
+         * no sharing. See @ref platform-windowless-contexts-shared for more
+         * information.
+         * @see @ref WindowlessCglContext::glContext()
+         */
+        Configuration& setSharedContext(CGLContextObj context) {
+            _sharedContext = context;
+            return *this;
+        }
+
+    private:
+        CGLContextObj _sharedContext{};
 };
 
 /**
@@ -270,6 +303,17 @@ class WindowlessCglApplication {
          */
         virtual int exec() = 0;
 
+        /**
+         * @brief Underlying OpenGL context
+         *
+         * Use in case you need to call CGL functionality directly or in order
+         * to create a shared context using
+         * @ref Configuration::setSharedContext(). Returns @cpp nullptr @ce in
+         * case the context was not created yet.
+         * @see @ref platform-windowless-contexts-shared
+         */
+        CGLContextObj glContext() { return _glContext.glContext(); }
+
     protected:
         /* Nobody will need to have (and delete) WindowlessCglApplication*,
            thus this is faster than public pure virtual destructor */
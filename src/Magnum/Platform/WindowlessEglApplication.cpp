@@ -25,6 +25,8 @@
 
 #include "WindowlessEglApplication.h"
 
+#include <cstring>
+#include <vector>
 #include <Corrade/Utility/Assert.h>
 #include <Corrade/Utility/Debug.h>
 
@@ -35,9 +37,59 @@
 
 namespace Magnum { namespace Platform {
 
+#ifndef MAGNUM_TARGET_WEBGL
+namespace {
+
+/* Returns all EGL devices or nothing if device enumeration or device
+   platform isn't supported. The client extensions are queried on no
+   display. */
+std::vector<EGLDeviceEXT> queryDevices() {
+    const char* const extensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+    if(!extensions ||
+       (!std::strstr(extensions, "EGL_EXT_device_enumeration") && !std::strstr(extensions, "EGL_EXT_device_base")) ||
+       !std::strstr(extensions, "EGL_EXT_platform_device"))
+        return {};
+
+    auto eglQueryDevices = reinterpret_cast<PFNEGLQUERYDEVICESEXTPROC>(eglGetProcAddress("eglQueryDevicesEXT"));
+    if(!eglQueryDevices) return {};
+
+    EGLint count;
+    if(!eglQueryDevices(0, nullptr, &count) || !count) return {};
+
+    std::vector<EGLDeviceEXT> devices(count);
+    if(!eglQueryDevices(count, devices.data(), &count)) return {};
+    devices.resize(count);
+    return devices;
+}
+
+}
+
+UnsignedInt WindowlessEglContext::deviceCount() {
+    return queryDevices().size();
+}
+#endif
+
 WindowlessEglContext::WindowlessEglContext(const Configuration& configuration, Context*) {
-    /* Initialize */
-    _display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    /* Initialize on given device or on the default display */
+    #ifndef MAGNUM_TARGET_WEBGL
+    if(configuration.device() != ~UnsignedInt{}) {
+        const std::vector<EGLDeviceEXT> devices = queryDevices();
+        if(configuration.device() >= devices.size()) {
+            Error() << "Platform::WindowlessEglApplication::tryCreateContext(): requested EGL device" << configuration.device() << "but only" << devices.size() << "found";
+            return;
+        }
+
+        auto eglGetPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+        if(!eglGetPlatformDisplay || !(_display = eglGetPlatformDisplay(EGL_PLATFORM_DEVICE_EXT, devices[configuration.device()], nullptr))) {
+            Error() << "Platform::WindowlessEglApplication::tryCreateContext(): cannot get display of EGL device" << configuration.device() << Debug::nospace << ":" << Implementation::eglErrorString(eglGetError());
+            return;
+        }
+    } else
+    #endif
+    {
+        _display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    }
+
     if(!eglInitialize(_display, nullptr, nullptr)) {
         Error() << "Platform::WindowlessEglApplication::tryCreateContext(): cannot initialize EGL:" << Implementation::eglErrorString(eglGetError());
         return;
@@ -106,28 +158,53 @@ WindowlessEglContext::WindowlessEglContext(const Configuration& configuration, C
 
     #ifdef MAGNUM_TARGET_WEBGL
     static_cast<void>(configuration);
+    #else
+    _sharedContext = configuration.sharedContext() != EGL_NO_CONTEXT;
     #endif
 
-    if(!(_context = eglCreateContext(_display, config, EGL_NO_CONTEXT, attributes))) {
+    if(!(_context = eglCreateContext(_display, config,
+        #ifndef MAGNUM_TARGET_WEBGL
+        configuration.sharedContext(),
+        #else
+        EGL_NO_CONTEXT,
+        #endif
+        attributes)))
+    {
         Error() << "Platform::WindowlessEglApplication::tryCreateContext(): cannot create EGL context:" << Implementation::eglErrorString(eglGetError());
         return;
     }
 }
 
-WindowlessEglContext::WindowlessEglContext(WindowlessEglContext&& other): _display{other._display}, _context{other._context} {
+WindowlessEglContext::WindowlessEglContext(WindowlessEglContext&& other): _display{other._display}, _context{other._context}
+    #ifndef MAGNUM_TARGET_WEBGL
+    , _sharedContext{other._sharedContext}
+    #endif
+{
     other._display = {};
     other._context = {};
 }
 
 WindowlessEglContext::~WindowlessEglContext() {
     if(_context) eglDestroyContext(_display, _context);
-    if(_display) eglTerminate(_display);
+
+    /* The display is the same for all contexts and terminating it would
+       destroy also the context this one is sharing objects with, so leave
+       that to the context that created the sharing group */
+    #ifndef MAGNUM_TARGET_WEBGL
+    if(_display && !_sharedContext)
+    #else
+    if(_display)
+    #endif
+        eglTerminate(_display);
 }
 
 WindowlessEglContext& WindowlessEglContext::operator=(WindowlessEglContext && other) {
     using std::swap;
     swap(other._display, _display);
     swap(other._context, _context);
+    #ifndef MAGNUM_TARGET_WEBGL
+    swap(other._sharedContext, _sharedContext);
+    #endif
     return *this;
 }
 
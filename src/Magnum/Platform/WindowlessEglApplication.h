@@ -62,6 +62,21 @@ class WindowlessEglContext {
     public:
         class Configuration;
 
+        #ifndef MAGNUM_TARGET_WEBGL
+        /**
+         * @brief Count of EGL devices
+         *
+         * Queries @m_class{m-doc-external} [EGL_EXT_device_enumeration](https://www.khronos.org/registry/EGL/extensions/EXT/EGL_EXT_device_enumeration.txt).
+         * Returns @cpp 0 @ce if the extension or
+         * @m_class{m-doc-external} [EGL_EXT_platform_device](https://www.khronos.org/registry/EGL/extensions/EXT/EGL_EXT_platform_device.txt)
+         * is not supported, in which case contexts can be created only on
+         * the default display.
+         * @see @ref Configuration::setDevice()
+         * @requires_gles Device enumeration is not available in WebGL.
+         */
+        static UnsignedInt deviceCount();
+        #endif
+
         /**
          * @brief Constructor
          * @param configuration Context configuration
@@ -111,9 +126,22 @@ class WindowlessEglContext {
          */
         bool makeCurrent();
 
+        /**
+         * @brief Underlying OpenGL context
+         *
+         * Use in case you need to call EGL functionality directly or in order
+         * to create a shared context using
+         * @ref Configuration::setSharedContext(). Returns @cpp nullptr @ce in
+         * case the context was not created yet.
+         */
+        EGLContext glContext() { return _context; }
+
     private:
         EGLDisplay _display{};
         EGLContext _context{};
+        #ifndef MAGNUM_TARGET_WEBGL
+        bool _sharedContext{};
+        #endif
 };
 
 /**
@@ -171,11 +199,61 @@ class WindowlessEglContext::Configuration {
             _flags = flags;
             return *this;
         }
+
+        /**
+         * @brief Shared context
+         *
+         * @requires_gles Context sharing is not available in WebGL.
+         */
+        EGLContext sharedContext() const { return _sharedContext; }
+
+        /**
+         * @brief Set context to share objects with
+         * @return Reference to self (for method chaining)
+         *
+         * When set, the created context will share a subset of OpenGL objects
+         * with @p context, instead of being independent. Many caveats and
+         * limitations apply to shared OpenGL contexts, please consult the
+         * OpenGL specification for details. Default is
+         * @cpp EGL_NO_CONTEXT @ce, i.e. no sharing. See
+         * @ref platform-windowless-contexts-shared for more information.
+         * @see @ref WindowlessEglContext::glContext()
+         * @requires_gles Context sharing is not available in WebGL.
+         */
+        Configuration& setSharedContext(EGLContext context) {
+            _sharedContext = context;
+            return *this;
+        }
+
+        /**
+         * @brief Device ID
+         * @requires_gles Device selection is not available in WebGL.
+         */
+        UnsignedInt device() const { return _device; }
+
+        /**
+         * @brief Set device ID
+         * @return Reference to self (for method chaining)
+         *
+         * If set, the context is created on a display of given EGL device
+         * instead of the default display, which doesn't need any windowing
+         * system to be running. Expects that @p id is less than
+         * @ref WindowlessEglContext::deviceCount(). Default is
+         * @cpp ~UnsignedInt{} @ce, i.e. the default display. See
+         * @ref platform-windowless-contexts-devices for more information.
+         * @requires_gles Device selection is not available in WebGL.
+         */
+        Configuration& setDevice(UnsignedInt id) {
+            _device = id;
+            return *this;
+        }
         #endif
 
     private:
         #ifndef MAGNUM_TARGET_WEBGL
         Flags _flags;
+        EGLContext _sharedContext{EGL_NO_CONTEXT};
+        UnsignedInt _device{~UnsignedInt{}};
         #endif
 };
 
@@ -399,6 +477,17 @@ class WindowlessEglApplication {
          */
         virtual int exec() = 0;
 
+        /**
+         * @brief Underlying OpenGL context
+         *
+         * Use in case you need to call EGL functionality directly or in order
+         * to create a shared context using
+         * @ref Configuration::setSharedContext(). Returns @cpp nullptr @ce in
+         * case the context was not created yet.
+         * @see @ref platform-windowless-contexts-shared
+         */
+        EGLContext glContext() { return _glContext.glContext(); }
+
     protected:
         /* Nobody will need to have (and delete) WindowlessEglApplication*,
            thus this is faster than public pure virtual destructor */
@@ -123,6 +123,16 @@ class WindowlessGlxContext {
          */
         bool makeCurrent();
 
+        /**
+         * @brief Underlying OpenGL context
+         *
+         * Use in case you need to call GLX functionality directly or in order
+         * to create a shared context using
+         * @ref Configuration::setSharedContext(). Returns @cpp nullptr @ce in
+         * case the context was not created yet.
+         */
+        GLXContext glContext() { return _context; }
+
     private:
         Display* _display{};
         GLXPbuffer _pbuffer{};
@@ -175,8 +185,29 @@ class WindowlessGlxContext::Configuration {
             return *this;
         }
 
+        /** @brief Shared context */
+        GLXContext sharedContext() const { return _sharedContext; }
+
+        /**
+         * @brief Set context to share objects with
+         * @return Reference to self (for method chaining)
+         *
+         * When set, the created context will share a subset of OpenGL objects
+         * with @p context, instead of being independent. Many caveats and
+         * limitations apply to shared OpenGL contexts, please consult the
+         * OpenGL specification for details. Default is @cpp nullptr @ce, i.e.
+         * no sharing. See @ref platform-windowless-contexts-shared for more
+         * information.
+         * @see @ref WindowlessGlxContext::glContext()
+         */
+        Configuration& setSharedContext(GLXContext context) {
+            _sharedContext = context;
+            return *this;
+        }
+
     private:
         Flags _flags;
+        GLXContext _sharedContext{};
 };
 
 /**
@@ -319,6 +350,17 @@ class WindowlessGlxApplication {
          */
         virtual int exec() = 0;
 
+        /**
+         * @brief Underlying OpenGL context
+         *
+         * Use in case you need to call GLX functionality directly or in order
+         * to create a shared context using
+         * @ref Configuration::setSharedContext(). Returns @cpp nullptr @ce in
+         * case the context was not created yet.
+         * @see @ref platform-windowless-contexts-shared
+         */
+        GLXContext glContext() { return _glContext.glContext(); }
+
     protected:
         /* Nobody will need to have (and delete) WindowlessGlxApplication*,
            thus this is faster than public pure virtual destructor */
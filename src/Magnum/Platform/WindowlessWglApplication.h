@@ -124,6 +124,16 @@ class WindowlessWglContext {
          */
         bool makeCurrent();
 
+        /**
+         * @brief Underlying OpenGL context
+         *
+         * Use in case you need to call WGL functionality directly or in order
+         * to create a shared context using
+         * @ref Configuration::setSharedContext(). Returns @cpp nullptr @ce in
+         * case the context was not created yet.
+         */
+        HGLRC glContext() { return _context; }
+
     private:
         HWND _window{};
         HDC _deviceContext{};
@@ -176,8 +186,29 @@ class WindowlessWglContext::Configuration {
             return *this;
         }
 
+        /** @brief Shared context */
+        HGLRC sharedContext() const { return _sharedContext; }
+
+        /**
+         * @brief Set context to share objects with
+         * @return Reference to self (for method chaining)
+         *
+         * When set, the created context will share a subset of OpenGL objects
+         * with @p context, instead of being independent. Many caveats and
+         * limitations apply to shared OpenGL contexts, please consult the
+         * OpenGL specification for details. Default is @cpp nullptr @ce, i.e.
+         * no sharing. See @ref platform-windowless-contexts-shared for more
+         * information.
+         * @see @ref WindowlessWglContext::glContext()
+         */
+        Configuration& setSharedContext(HGLRC context) {
+            _sharedContext = context;
+            return *this;
+        }
+
     private:
         Flags _flags;
+        HGLRC _sharedContext{};
 };
 
 /**
@@ -318,6 +349,17 @@ class WindowlessWglApplication {
          */
         virtual int exec() = 0;
 
+        /**
+         * @brief Underlying OpenGL context
+         *
+         * Use in case you need to call WGL functionality directly or in order
+         * to create a shared context using
+         * @ref Configuration::setSharedContext(). Returns @cpp nullptr @ce in
+         * case the context was not created yet.
+         * @see @ref platform-windowless-contexts-shared
+         */
+        HGLRC glContext() { return _glContext.glContext(); }
+
     protected:
         /* Nobody will need to have (and delete) WindowlessWglApplication*,
            thus this is faster than public pure virtual destructor */
@@ -25,51 +25,95 @@
 
 #include "Grid.h"
 
+#include <Corrade/Utility/Assert.h>
+
 #include "Magnum/Mesh.h"
 #include "Magnum/Math/Color.h"
 #include "Magnum/Trade/MeshData3D.h"
 
 namespace Magnum { namespace Primitives {
 
-Trade::MeshData3D grid3DSolid(const Vector2i& subdivisions, const GridFlags flags) {
+namespace {
+
+template<class T> void grid3DSolidIntoImplementation(const Vector2i& subdivisions, const MeshTools::StridedArrayView<Vector3>& positions, const MeshTools::StridedArrayView<Vector3>& normals, const MeshTools::StridedArrayView<Vector2>& textureCoords, const Containers::ArrayView<T> indices) {
     const Vector2i vertexCount = subdivisions + Vector2i{2};
     const Vector2i faceCount = subdivisions + Vector2i{1};
+    const std::size_t count = vertexCount.product();
+
+    CORRADE_ASSERT(positions.empty() || positions.size() == count,
+        "Primitives::grid3DSolidInto(): expected" << count << "positions but got" << positions.size(), );
+    CORRADE_ASSERT(normals.empty() || normals.size() == count,
+        "Primitives::grid3DSolidInto(): expected" << count << "normals but got" << normals.size(), );
+    CORRADE_ASSERT(textureCoords.empty() || textureCoords.size() == count,
+        "Primitives::grid3DSolidInto(): expected" << count << "texture coordinates but got" << textureCoords.size(), );
+    CORRADE_ASSERT(indices.size() == std::size_t(faceCount.product()*6),
+        "Primitives::grid3DSolidInto(): expected" << faceCount.product()*6 << "indices but got" << indices.size(), );
+    CORRADE_ASSERT(count - 1 <= T(~T{}),
+        "Primitives::grid3DSolidInto(): can't index" << count << "vertices with" << sizeof(T)*8 << Debug::nospace << "-bit indices", );
+
+    std::size_t i = 0;
+    for(Int y = 0; y != vertexCount.y(); ++y) {
+        for(Int x = 0; x != vertexCount.x(); ++x, ++i) {
+            const Vector2 position = (Vector2(x, y)/Vector2(faceCount))*2.0f - Vector2{1.0f};
+            if(!positions.empty()) positions[i] = {position, 0.0f};
+            if(!normals.empty()) normals[i] = Vector3::zAxis(1.0f);
+            if(!textureCoords.empty()) textureCoords[i] = position*0.5f + Vector2{0.5f};
+        }
+    }
 
-    std::vector<Vector3> positions;
-    positions.reserve(vertexCount.product());
-    for(Int y = 0; y != vertexCount.y(); ++y)
-        for(Int x = 0; x != vertexCount.x(); ++x)
-            positions.emplace_back((Vector2(x, y)/Vector2(faceCount))*2.0f - Vector2{1.0f}, 0.0f);
-
-    std::vector<UnsignedInt> indices;
-    indices.reserve(faceCount.product()*6);
+    T* out = indices.data();
     for(Int y = 0; y != faceCount.y(); ++y) {
         for(Int x = 0; x != faceCount.x(); ++x) {
             /* 2--1 5
                | / /|
                |/ / |
                0 3--4 */
-            indices.insert(indices.end(), {
-                UnsignedInt(y*vertexCount.x() + x),
-                UnsignedInt((y + 1)*vertexCount.x() + x + 1),
-                UnsignedInt((y + 1)*vertexCount.x() + x + 0),
-                UnsignedInt(y*vertexCount.x() + x),
-                UnsignedInt(y*vertexCount.x() + x + 1),
-                UnsignedInt((y + 1)*vertexCount.x() + x + 1)});
+            *out++ = T(y*vertexCount.x() + x);
+            *out++ = T((y + 1)*vertexCount.x() + x + 1);
+            *out++ = T((y + 1)*vertexCount.x() + x + 0);
+            *out++ = T(y*vertexCount.x() + x);
+            *out++ = T(y*vertexCount.x() + x + 1);
+            *out++ = T((y + 1)*vertexCount.x() + x + 1);
         }
     }
+}
+
+}
+
+std::size_t grid3DSolidVertexCount(const Vector2i& subdivisions) {
+    return (subdivisions + Vector2i{2}).product();
+}
+
+std::size_t grid3DSolidIndexCount(const Vector2i& subdivisions) {
+    return (subdivisions + Vector2i{1}).product()*6;
+}
+
+void grid3DSolidInto(const Vector2i& subdivisions, const MeshTools::StridedArrayView<Vector3>& positions, const MeshTools::StridedArrayView<Vector3>& normals, const MeshTools::StridedArrayView<Vector2>& textureCoords, const Containers::ArrayView<UnsignedShort> indices) {
+    grid3DSolidIntoImplementation(subdivisions, positions, normals, textureCoords, indices);
+}
+
+void grid3DSolidInto(const Vector2i& subdivisions, const MeshTools::StridedArrayView<Vector3>& positions, const MeshTools::StridedArrayView<Vector3>& normals, const MeshTools::StridedArrayView<Vector2>& textureCoords, const Containers::ArrayView<UnsignedInt> indices) {
+    grid3DSolidIntoImplementation(subdivisions, positions, normals, textureCoords, indices);
+}
+
+Trade::MeshData3D grid3DSolid(const Vector2i& subdivisions, const GridFlags flags) {
+    const std::size_t vertexCount = grid3DSolidVertexCount(subdivisions);
+
+    std::vector<Vector3> positions(vertexCount);
+    std::vector<UnsignedInt> indices(grid3DSolidIndexCount(subdivisions));
 
     std::vector<std::vector<Vector3>> normals;
     if(flags & GridFlag::GenerateNormals)
-        normals.emplace_back(positions.size(), Vector3::zAxis(1.0f));
+        normals.emplace_back(vertexCount);
 
     std::vector<std::vector<Vector2>> textureCoordinates;
-    if(flags & GridFlag::GenerateTextureCoords) {
-        textureCoordinates.emplace_back();
-        textureCoordinates[0].reserve(positions.size());
-        for(std::size_t i = 0; i != positions.size(); ++i)
-            textureCoordinates[0].emplace_back(positions[i].xy()*0.5f + Vector2{0.5f});
-    }
+    if(flags & GridFlag::GenerateTextureCoords)
+        textureCoordinates.emplace_back(vertexCount);
+
+    grid3DSolidInto(subdivisions, Containers::arrayView(positions.data(), positions.size()),
+        normals.empty() ? nullptr : MeshTools::StridedArrayView<Vector3>{Containers::arrayView(normals[0].data(), normals[0].size())},
+        textureCoordinates.empty() ? nullptr : MeshTools::StridedArrayView<Vector2>{Containers::arrayView(textureCoordinates[0].data(), textureCoordinates[0].size())},
+        Containers::arrayView(indices.data(), indices.size()));
 
     return Trade::MeshData3D{MeshPrimitive::Triangles, std::move(indices), {std::move(positions)}, std::move(normals), std::move(textureCoordinates), {}, nullptr};
 }
@@ -26,13 +26,15 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::Primitives::grid3DSolid(), @ref Magnum::Primitives::grid3DWireframe()
+ * @brief Function @ref Magnum::Primitives::grid3DSolid(), @ref Magnum::Primitives::grid3DSolidInto(), @ref Magnum::Primitives::grid3DSolidVertexCount(), @ref Magnum::Primitives::grid3DSolidIndexCount(), @ref Magnum::Primitives::grid3DWireframe()
  */
 
+#include <Corrade/Containers/ArrayView.h>
 #include <Corrade/Containers/EnumSet.h>
 
 #include "Magnum/Magnum.h"
 #include "Magnum/Math/Math.h"
+#include "Magnum/MeshTools/StridedArrayView.h"
 #include "Magnum/Primitives/visibility.h"
 #include "Magnum/Trade/Trade.h"
 
@@ -80,6 +82,57 @@ cells horizontally and 4 vertically. In particular, this is different from the
 */
 MAGNUM_PRIMITIVES_EXPORT Trade::MeshData3D grid3DSolid(const Vector2i& subdivisions, GridFlags flags = GridFlag::GenerateNormals);
 
+/**
+@brief Vertex count of a 3D solid grid
+
+Size of vertex views expected by @ref grid3DSolidInto().
+*/
+MAGNUM_PRIMITIVES_EXPORT std::size_t grid3DSolidVertexCount(const Vector2i& subdivisions);
+
+/**
+@brief Index count of a 3D solid grid
+
+Size of the index view expected by @ref grid3DSolidInto().
+*/
+MAGNUM_PRIMITIVES_EXPORT std::size_t grid3DSolidIndexCount(const Vector2i& subdivisions);
+
+/**
+@brief Generate a 3D solid grid into existing views
+
+Produces the same geometry as @ref grid3DSolid(), but writes it directly to
+caller-provided memory, for example into interleaved vertex data in a mapped
+buffer, without any intermediate allocations. Each of @p positions, @p normals
+and @p textureCoords is expected to be either empty, in which case the
+attribute is not generated, or to have @ref grid3DSolidVertexCount() elements.
+The @p indices view is expected to have @ref grid3DSolidIndexCount() elements.
+Indices of an @ref Magnum::UnsignedShort "UnsignedShort" view are usable only
+if the vertex count fits into 16 bits, which is the case for grids with up to
+254x254 subdivisions.
+
+@code{.cpp}
+struct Vertex {
+    Vector3 position;
+    Vector3 normal;
+};
+
+const Vector2i subdivisions{127, 127};
+Containers::Array<Vertex> vertices{Primitives::grid3DSolidVertexCount(subdivisions)};
+Containers::Array<UnsignedShort> indices{Primitives::grid3DSolidIndexCount(subdivisions)};
+Primitives::grid3DSolidInto(subdivisions,
+    {&vertices[0].position, vertices.size(), sizeof(Vertex)},
+    {&vertices[0].normal, vertices.size(), sizeof(Vertex)}, nullptr, indices);
+@endcode
+*/
+MAGNUM_PRIMITIVES_EXPORT void grid3DSolidInto(const Vector2i& subdivisions, const MeshTools::StridedArrayView<Vector3>& positions, const MeshTools::StridedArrayView<Vector3>& normals, const MeshTools::StridedArrayView<Vector2>& textureCoords, Containers::ArrayView<UnsignedShort> indices);
+
+/**
+@brief Generate a 3D solid grid into existing views with 32-bit indices
+
+Same as @ref grid3DSolidInto(const Vector2i&, const MeshTools::StridedArrayView<Vector3>&, const MeshTools::StridedArrayView<Vector3>&, const MeshTools::StridedArrayView<Vector2>&, Containers::ArrayView<UnsignedShort>),
+but without a limit on the vertex count.
+*/
+MAGNUM_PRIMITIVES_EXPORT void grid3DSolidInto(const Vector2i& subdivisions, const MeshTools::StridedArrayView<Vector3>& positions, const MeshTools::StridedArrayView<Vector3>& normals, const MeshTools::StridedArrayView<Vector2>& textureCoords, Containers::ArrayView<UnsignedInt> indices);
+
 /**
 @brief 3D wireframe grid
 
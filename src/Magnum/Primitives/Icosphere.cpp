@@ -27,8 +27,6 @@
 
 #include "Magnum/Mesh.h"
 #include "Magnum/Math/Color.h"
-#include "Magnum/MeshTools/Duplicate.h"
-#include "Magnum/MeshTools/RemoveDuplicates.h"
 #include "Magnum/MeshTools/Subdivide.h"
 #include "Magnum/Trade/MeshData3D.h"
 
@@ -74,12 +72,10 @@ Trade::MeshData3D icosphereSolid(const UnsignedInt subdivisions) {
     };
 
     for(std::size_t i = 0; i != subdivisions; ++i)
-        MeshTools::subdivide(indices, positions, [](const Vector3& a, const Vector3& b) {
+        MeshTools::subdivideShared(indices, positions, [](const Vector3& a, const Vector3& b) {
             return (a+b).normalized();
         });
 
-    indices = MeshTools::duplicate(indices, MeshTools::removeDuplicates(positions));
-
     std::vector<Vector3> normals(positions);
     return Trade::MeshData3D{MeshPrimitive::Triangles, std::move(indices), {std::move(positions)}, {std::move(normals)}, {}, {}, nullptr};
 }
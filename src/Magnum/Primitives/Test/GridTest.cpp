@@ -23,6 +23,7 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <iterator>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
 
@@ -37,12 +38,16 @@ struct GridTest: TestSuite::Tester {
 
     void solid3DWithoutAnything();
     void solid3DWithNormalsAndTextureCoords();
+    void solid3DInto();
+    void solid3DIntoPositionsOnly();
     void wireframe3D();
 };
 
 GridTest::GridTest() {
     addTests({&GridTest::solid3DWithoutAnything,
               &GridTest::solid3DWithNormalsAndTextureCoords,
+              &GridTest::solid3DInto,
+              &GridTest::solid3DIntoPositionsOnly,
               &GridTest::wireframe3D});
 }
 
@@ -285,6 +290,51 @@ void GridTest::solid3DWithNormalsAndTextureCoords() {
     }), TestSuite::Compare::Container);
 }
 
+void GridTest::solid3DInto() {
+    Trade::MeshData3D grid = grid3DSolid({5, 3}, GridFlag::GenerateNormals|GridFlag::GenerateTextureCoords);
+
+    struct Vertex {
+        Vector3 position;
+        Vector3 normal;
+        Vector2 textureCoords;
+    };
+
+    CORRADE_COMPARE(grid3DSolidVertexCount({5, 3}), 28);
+    CORRADE_COMPARE(grid3DSolidIndexCount({5, 3}), 72);
+
+    /* Interleaved output with 16-bit indices gives the same data */
+    Vertex vertices[28];
+    UnsignedShort indices[72];
+    grid3DSolidInto({5, 3},
+        MeshTools::StridedArrayView<Vector3>{&vertices[0].position, 28, sizeof(Vertex)},
+        MeshTools::StridedArrayView<Vector3>{&vertices[0].normal, 28, sizeof(Vertex)},
+        MeshTools::StridedArrayView<Vector2>{&vertices[0].textureCoords, 28, sizeof(Vertex)}, indices);
+
+    for(std::size_t i = 0; i != 28; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(vertices[i].position, grid.positions(0)[i]);
+        CORRADE_COMPARE(vertices[i].normal, grid.normals(0)[i]);
+        CORRADE_COMPARE(vertices[i].textureCoords, grid.textureCoords2D(0)[i]);
+    }
+    for(std::size_t i = 0; i != 72; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(indices[i], grid.indices()[i]);
+    }
+}
+
+void GridTest::solid3DIntoPositionsOnly() {
+    Trade::MeshData3D grid = grid3DSolid({1, 2}, {});
+
+    Vector3 positions[12];
+    UnsignedInt indices[36];
+    grid3DSolidInto({1, 2}, positions, nullptr, nullptr, indices);
+
+    CORRADE_COMPARE_AS((std::vector<Vector3>{std::begin(positions), std::end(positions)}),
+        grid.positions(0), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS((std::vector<UnsignedInt>{std::begin(indices), std::end(indices)}),
+        grid.indices(), TestSuite::Compare::Container);
+}
+
 void GridTest::wireframe3D() {
     Trade::MeshData3D grid = grid3DWireframe({5, 3});
 
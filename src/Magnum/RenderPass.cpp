@@ -0,0 +1,155 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "RenderPass.h"
+
+#include <algorithm>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Context.h"
+#include "Magnum/DefaultFramebuffer.h"
+#include "Magnum/Framebuffer.h"
+#include "Magnum/Implementation/FramebufferState.h"
+#include "Magnum/Implementation/State.h"
+
+namespace Magnum {
+
+namespace {
+
+FramebufferClearMask clearMask(const GLenum attachment) {
+    switch(attachment) {
+        case GL_DEPTH_ATTACHMENT:
+        #ifndef MAGNUM_TARGET_GLES2
+        case GL_DEPTH:
+        #else
+        case GL_DEPTH_EXT:
+        #endif
+            return FramebufferClear::Depth;
+        case GL_STENCIL_ATTACHMENT:
+        #ifndef MAGNUM_TARGET_GLES2
+        case GL_STENCIL:
+        #else
+        case GL_STENCIL_EXT:
+        #endif
+            return FramebufferClear::Stencil;
+    }
+
+    /* Everything else is a color attachment */
+    return FramebufferClear::Color;
+}
+
+}
+
+template<class T> RenderPass<T>::RenderPass(T& framebuffer): _framebuffer(framebuffer) {}
+
+template<class T> RenderPass<T>& RenderPass<T>::setAttachment(const Attachment attachment, const RenderPassLoadAction loadAction, const RenderPassStoreAction storeAction) {
+    CORRADE_ASSERT(!_inProgress,
+        "RenderPass::setAttachment(): the pass is in progress", *this);
+
+    auto found = std::find_if(_attachments.begin(), _attachments.end(), [attachment](const AttachmentData& data) {
+        return data.attachment == GLenum(attachment);
+    });
+    if(found != _attachments.end()) {
+        found->loadAction = loadAction;
+        found->storeAction = storeAction;
+    } else _attachments.push_back({GLenum(attachment), loadAction, storeAction});
+
+    return *this;
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+template<class T> RenderPass<T>& RenderPass<T>::setRectangle(const Range2Di& rectangle) {
+    _rectangle = rectangle;
+    return *this;
+}
+#endif
+
+template<class T> UnsignedLong RenderPass<T>::area() const {
+    #ifndef MAGNUM_TARGET_GLES2
+    if(_rectangle.size().product()) return _rectangle.size().product();
+    #endif
+    return _framebuffer.viewport().size().product();
+}
+
+template<class T> void RenderPass<T>::invalidate(const std::vector<GLenum>& attachments) {
+    #ifndef MAGNUM_TARGET_GLES2
+    if(_rectangle.size().product()) {
+        (_framebuffer.*Context::current().state().framebuffer->invalidateSubImplementation)(attachments.size(), attachments.data(), _rectangle);
+        return;
+    }
+    #endif
+
+    (_framebuffer.*Context::current().state().framebuffer->invalidateImplementation)(attachments.size(), attachments.data());
+}
+
+template<class T> T& RenderPass<T>::begin() {
+    CORRADE_ASSERT(!_inProgress,
+        "RenderPass::begin(): the pass is already in progress", _framebuffer);
+    _inProgress = true;
+
+    _framebuffer.bind();
+
+    std::vector<GLenum> invalidated;
+    FramebufferClearMask clear;
+    for(const AttachmentData& data: _attachments) {
+        if(data.loadAction == RenderPassLoadAction::DontCare)
+            invalidated.push_back(data.attachment);
+        else if(data.loadAction == RenderPassLoadAction::Clear)
+            clear |= clearMask(data.attachment);
+        else continue;
+
+        _skippedLoadPixelCount += area();
+    }
+
+    if(!invalidated.empty()) invalidate(invalidated);
+    if(clear) _framebuffer.clear(clear);
+
+    return _framebuffer;
+}
+
+template<class T> void RenderPass<T>::end() {
+    CORRADE_ASSERT(_inProgress,
+        "RenderPass::end(): the pass is not in progress", );
+    _inProgress = false;
+
+    std::vector<GLenum> invalidated;
+    for(const AttachmentData& data: _attachments)
+        if(data.storeAction == RenderPassStoreAction::DontCare)
+            invalidated.push_back(data.attachment);
+
+    if(invalidated.empty()) return;
+
+    invalidate(invalidated);
+    _skippedStorePixelCount += area()*invalidated.size();
+}
+
+template<class T> void RenderPass<T>::resetStatistics() {
+    _skippedLoadPixelCount = _skippedStorePixelCount = 0;
+}
+
+template class RenderPass<Framebuffer>;
+template class RenderPass<DefaultFramebuffer>;
+
+}
@@ -0,0 +1,241 @@
+#ifndef Magnum_RenderPass_h
+#define Magnum_RenderPass_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+/** @file
+ * @brief Class @ref Magnum::RenderPass, enum @ref Magnum::RenderPassLoadAction, @ref Magnum::RenderPassStoreAction
+ */
+#endif
+
+#include <vector>
+
+#include "Magnum/AbstractFramebuffer.h"
+#include "Magnum/visibility.h"
+
+#if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+namespace Magnum {
+
+/**
+@brief Render pass load action
+
+@see @ref RenderPass::setAttachment()
+*/
+enum class RenderPassLoadAction: UnsignedByte {
+    /** Previous attachment contents are preserved */
+    Load,
+
+    /**
+     * Attachment is cleared at the beginning of the pass using the value
+     * set with @ref Renderer::setClearColor(), @ref Renderer::setClearDepth()
+     * or @ref Renderer::setClearStencil()
+     */
+    Clear,
+
+    /**
+     * Previous attachment contents are not needed and the attachment is
+     * invalidated at the beginning of the pass
+     */
+    DontCare
+};
+
+/**
+@brief Render pass store action
+
+@see @ref RenderPass::setAttachment()
+*/
+enum class RenderPassStoreAction: UnsignedByte {
+    /** Attachment contents are preserved after the pass */
+    Store,
+
+    /**
+     * Attachment contents are not needed after the pass and the attachment
+     * is invalidated at its end
+     */
+    DontCare
+};
+
+/**
+@brief Render pass
+
+Declares what happens with each framebuffer attachment at the beginning and at
+the end of a sequence of draws and issues the corresponding
+@ref AbstractFramebuffer::clear() and @ref Framebuffer::invalidate() /
+@ref DefaultFramebuffer::invalidate() calls automatically. On tiled GPUs
+common in mobile devices this avoids loading attachment contents into tile
+memory at the beginning and writing them back at the end for attachments that
+are not needed --- for example the depth buffer, which is usually not needed
+after the frame is rendered:
+
+@snippet Magnum.cpp RenderPass-usage
+
+Attachments that are not listed in the pass are treated as
+@ref RenderPassLoadAction::Load and @ref RenderPassStoreAction::Store. The
+template is available for @ref Framebuffer and @ref DefaultFramebuffer.
+
+@section RenderPass-rectangle Rendering into a part of the framebuffer
+
+By default the whole attachments are invalidated. If the pass renders only
+into a part of the framebuffer, specify it using @ref setRectangle() to
+invalidate only given rectangle. Note that @ref RenderPassLoadAction::Clear
+is affected only by @ref Renderer::Feature::ScissorTest, not by the
+rectangle.
+
+@section RenderPass-statistics Statistics
+
+The pass counts pixels that didn't need to be loaded at the beginning (either
+because they were cleared or invalidated) and that didn't need to be stored at
+the end of the pass, available through @ref skippedLoadPixelCount() and
+@ref skippedStorePixelCount(). The area is taken from @ref setRectangle() or,
+if not set, from framebuffer @ref AbstractFramebuffer::viewport() "viewport".
+Multiplied by attachment pixel size this gives an estimate of memory
+bandwidth saved on tiled GPUs, which can be printed alongside
+@ref DebugTools::Profiler statistics.
+
+@requires_gl43 Extension @extension{ARB,invalidate_subdata} for
+    invalidation, without it only @ref RenderPassLoadAction::Clear has an
+    effect.
+@requires_gles30 Extension @extension{EXT,discard_framebuffer} for
+    invalidation in OpenGL ES 2.0.
+@requires_webgl20 Framebuffer invalidation is not available in WebGL 1.0.
+*/
+template<class T> class MAGNUM_EXPORT RenderPass {
+    public:
+        /** @brief Attachment type */
+        typedef typename T::InvalidationAttachment Attachment;
+
+        /**
+         * @brief Constructor
+         *
+         * The framebuffer is expected to be alive for the whole lifetime of
+         * the pass.
+         */
+        explicit RenderPass(T& framebuffer);
+
+        /** @brief Framebuffer */
+        T& framebuffer() { return _framebuffer; }
+        const T& framebuffer() const { return _framebuffer; } /**< @overload */
+
+        /**
+         * @brief Set attachment load and store action
+         * @return Reference to self (for method chaining)
+         *
+         * If the attachment was already specified, its actions are replaced.
+         * Expects that the pass is not in progress.
+         */
+        RenderPass<T>& setAttachment(Attachment attachment, RenderPassLoadAction loadAction, RenderPassStoreAction storeAction);
+
+        /** @brief Count of attachments specified in the pass */
+        std::size_t attachmentCount() const { return _attachments.size(); }
+
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Rectangle
+         *
+         * If not set, returns empty range, meaning the whole framebuffer.
+         */
+        Range2Di rectangle() const { return _rectangle; }
+
+        /**
+         * @brief Set rectangle to invalidate
+         * @return Reference to self (for method chaining)
+         *
+         * If set to non-empty range, only given rectangle of attachments is
+         * invalidated. Initial value is empty range, meaning the whole
+         * framebuffer.
+         * @requires_gles30 Only whole attachments can be invalidated in
+         *      OpenGL ES 2.0.
+         */
+        RenderPass<T>& setRectangle(const Range2Di& rectangle);
+        #endif
+
+        /** @brief Whether the pass is in progress */
+        bool isInProgress() const { return _inProgress; }
+
+        /**
+         * @brief Begin the pass
+         * @return The framebuffer for rendering
+         *
+         * Binds the framebuffer for drawing, invalidates all attachments with
+         * @ref RenderPassLoadAction::DontCare and clears all attachments with
+         * @ref RenderPassLoadAction::Clear. Expects that the pass is not
+         * already in progress.
+         * @see @ref AbstractFramebuffer::bind()
+         */
+        T& begin();
+
+        /**
+         * @brief End the pass
+         *
+         * Invalidates all attachments with @ref RenderPassStoreAction::DontCare.
+         * Expects that the pass was begun with @ref begin().
+         */
+        void end();
+
+        /**
+         * @brief Count of pixels that didn't need to be loaded
+         *
+         * Accumulated over all passes since construction or since last call
+         * to @ref resetStatistics().
+         */
+        UnsignedLong skippedLoadPixelCount() const { return _skippedLoadPixelCount; }
+
+        /**
+         * @brief Count of pixels that didn't need to be stored
+         *
+         * Accumulated over all passes since construction or since last call
+         * to @ref resetStatistics().
+         */
+        UnsignedLong skippedStorePixelCount() const { return _skippedStorePixelCount; }
+
+        /** @brief Reset the statistics */
+        void resetStatistics();
+
+    private:
+        struct AttachmentData {
+            GLenum attachment;
+            RenderPassLoadAction loadAction;
+            RenderPassStoreAction storeAction;
+        };
+
+        MAGNUM_LOCAL UnsignedLong area() const;
+        MAGNUM_LOCAL void invalidate(const std::vector<GLenum>& attachments);
+
+        T& _framebuffer;
+        std::vector<AttachmentData> _attachments;
+        #ifndef MAGNUM_TARGET_GLES2
+        Range2Di _rectangle;
+        #endif
+        bool _inProgress{};
+        UnsignedLong _skippedLoadPixelCount{}, _skippedStorePixelCount{};
+};
+
+}
+#else
+#error this header is not available in WebGL 1.0 build
+#endif
+
+#endif
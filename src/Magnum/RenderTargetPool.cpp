@@ -0,0 +1,142 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "RenderTargetPool.h"
+
+#include <algorithm>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Renderbuffer.h"
+#include "Magnum/Texture.h"
+#include "Magnum/TextureFormat.h"
+
+namespace Magnum {
+
+void RenderTargetPool::resolve(Framebuffer& source, AbstractFramebuffer& destination, const Range2Di& rectangle, const FramebufferBlitMask mask, const std::initializer_list<Framebuffer::InvalidationAttachment> invalidate) {
+    AbstractFramebuffer::blit(source, destination, rectangle, rectangle, mask, FramebufferBlitFilter::Nearest);
+    if(invalidate.size()) source.invalidate(invalidate);
+}
+
+void RenderTargetPool::resolve(Framebuffer& source, AbstractFramebuffer& destination, const FramebufferBlitMask mask, const std::initializer_list<Framebuffer::InvalidationAttachment> invalidate) {
+    resolve(source, destination, source.viewport(), mask, invalidate);
+}
+
+RenderTargetPool::RenderTargetPool(const UnsignedInt maxUnusedFrames): _maxUnusedFrames{maxUnusedFrames} {}
+
+RenderTargetPool::RenderTargetPool(RenderTargetPool&&) noexcept = default;
+
+RenderTargetPool::~RenderTargetPool() = default;
+
+RenderTargetPool& RenderTargetPool::operator=(RenderTargetPool&&) noexcept = default;
+
+Texture2D& RenderTargetPool::acquireTexture(const TextureFormat format, const Vector2i& size) {
+    for(TextureEntry& entry: _textures) {
+        if(entry.acquired || entry.format != format || entry.size != size)
+            continue;
+
+        entry.acquired = true;
+        entry.lastUsedFrame = _frame;
+
+        /* Previous contents are not needed anymore */
+        entry.texture->invalidateImage(0);
+        return *entry.texture;
+    }
+
+    std::unique_ptr<Texture2D> texture{new Texture2D};
+    texture->setMinificationFilter(Sampler::Filter::Linear)
+        .setMagnificationFilter(Sampler::Filter::Linear)
+        .setWrapping(Sampler::Wrapping::ClampToEdge)
+        .setStorage(1, format, size);
+    _textures.push_back({std::move(texture), format, size, _frame, true});
+    return *_textures.back().texture;
+}
+
+Renderbuffer& RenderTargetPool::acquireRenderbuffer(const RenderbufferFormat format, const Vector2i& size, const Int samples) {
+    for(RenderbufferEntry& entry: _renderbuffers) {
+        if(entry.acquired || entry.format != format || entry.size != size || entry.samples != samples)
+            continue;
+
+        entry.acquired = true;
+        entry.lastUsedFrame = _frame;
+        return *entry.renderbuffer;
+    }
+
+    std::unique_ptr<Renderbuffer> renderbuffer{new Renderbuffer};
+    if(samples) renderbuffer->setStorageMultisample(samples, format, size);
+    else renderbuffer->setStorage(format, size);
+    _renderbuffers.push_back({std::move(renderbuffer), format, size, samples, _frame, true});
+    return *_renderbuffers.back().renderbuffer;
+}
+
+void RenderTargetPool::release(Texture2D& texture) {
+    auto found = std::find_if(_textures.begin(), _textures.end(), [&texture](const TextureEntry& entry) {
+        return entry.texture.get() == &texture;
+    });
+    CORRADE_ASSERT(found != _textures.end(),
+        "RenderTargetPool::release(): the texture is not from this pool", );
+    CORRADE_ASSERT(found->acquired,
+        "RenderTargetPool::release(): the texture is already released", );
+
+    found->acquired = false;
+    found->lastUsedFrame = _frame;
+}
+
+void RenderTargetPool::release(Renderbuffer& renderbuffer) {
+    auto found = std::find_if(_renderbuffers.begin(), _renderbuffers.end(), [&renderbuffer](const RenderbufferEntry& entry) {
+        return entry.renderbuffer.get() == &renderbuffer;
+    });
+    CORRADE_ASSERT(found != _renderbuffers.end(),
+        "RenderTargetPool::release(): the renderbuffer is not from this pool", );
+    CORRADE_ASSERT(found->acquired,
+        "RenderTargetPool::release(): the renderbuffer is already released", );
+
+    found->acquired = false;
+    found->lastUsedFrame = _frame;
+}
+
+void RenderTargetPool::nextFrame() {
+    ++_frame;
+
+    _textures.erase(std::remove_if(_textures.begin(), _textures.end(), [this](const TextureEntry& entry) {
+        return !entry.acquired && _frame - entry.lastUsedFrame > _maxUnusedFrames;
+    }), _textures.end());
+    _renderbuffers.erase(std::remove_if(_renderbuffers.begin(), _renderbuffers.end(), [this](const RenderbufferEntry& entry) {
+        return !entry.acquired && _frame - entry.lastUsedFrame > _maxUnusedFrames;
+    }), _renderbuffers.end());
+}
+
+std::size_t RenderTargetPool::acquiredTextureCount() const {
+    return std::count_if(_textures.begin(), _textures.end(), [](const TextureEntry& entry) {
+        return entry.acquired;
+    });
+}
+
+std::size_t RenderTargetPool::acquiredRenderbufferCount() const {
+    return std::count_if(_renderbuffers.begin(), _renderbuffers.end(), [](const RenderbufferEntry& entry) {
+        return entry.acquired;
+    });
+}
+
+}
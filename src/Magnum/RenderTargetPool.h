@@ -0,0 +1,268 @@
+#ifndef Magnum_RenderTargetPool_h
+#define Magnum_RenderTargetPool_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+/** @file
+ * @brief Class @ref Magnum::RenderTargetPool
+ */
+#endif
+
+#include <memory>
+#include <vector>
+
+#include "Magnum/Framebuffer.h"
+#include "Magnum/visibility.h"
+
+#if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+namespace Magnum {
+
+/**
+@brief Render target pool
+
+Recycles transient textures and renderbuffers used as framebuffer attachments,
+for example intermediate targets of a post-processing chain. Instead of
+allocating a dedicated target for each pass, the pass acquires a target of
+given format and size from the pool and releases it back once the following
+passes no longer need its contents. Passes that don't overlap then render into
+the same texture or renderbuffer and the chain needs only as many targets as
+there are intermediate results alive at the same time:
+
+@code{.cpp}
+RenderTargetPool pool;
+
+// each frame
+Renderbuffer& color = pool.acquireRenderbuffer(RenderbufferFormat::RGBA8, size, 4);
+Framebuffer multisampled{{{}, size}};
+multisampled.attachRenderbuffer(Framebuffer::ColorAttachment{0}, color);
+// render the scene into multisampled ...
+
+Texture2D& resolved = pool.acquireTexture(TextureFormat::RGBA8, size);
+Framebuffer framebuffer{{{}, size}};
+framebuffer.attachTexture(Framebuffer::ColorAttachment{0}, resolved, 0);
+RenderTargetPool::resolve(multisampled, framebuffer, FramebufferBlit::Color,
+    {Framebuffer::ColorAttachment{0}});
+pool.release(color);
+
+// post-process resolved into pool.acquireTexture() with same format and size,
+// release resolved ...
+
+pool.nextFrame();
+@endcode
+
+Targets are matched by exact format, size and, for renderbuffers, sample
+count. A released target stays in the pool and gets reused in following
+frames; targets that weren't acquired for more than @ref maxUnusedFrames()
+frames are deleted in @ref nextFrame(), so the pool shrinks back after for
+example a window resize. Reused textures are invalidated with
+@ref Texture::invalidateImage() to hint the driver that their previous
+contents are not needed.
+
+Note that the pool aliases whole objects, not memory --- a released target
+can be reused only by a pass requesting the same format and size, as OpenGL
+has no way to place two differently-formatted images into the same memory.
+Targets acquired in the pool are owned by it and stay valid until released
+and evicted or until the pool is destroyed.
+
+@section RenderTargetPool-resolve Multisample resolve
+
+@ref resolve() blits a multisampled framebuffer into a single-sampled one
+using @ref AbstractFramebuffer::blit() and then invalidates given attachments
+of the multisampled framebuffer, as their contents are usually not needed
+after the resolve. On tiled GPUs this avoids writing the multisampled data
+back to memory.
+
+@requires_gl30 Extension @extension{ARB,framebuffer_object} for
+    multisampled renderbuffers and framebuffer blit.
+@requires_gles30 Extension @extension{ANGLE,framebuffer_blit} or
+    @extension{NV,framebuffer_blit} for framebuffer blit and
+    @extension{ANGLE,framebuffer_multisample} or
+    @extension{NV,framebuffer_multisample} for multisampled renderbuffers in
+    OpenGL ES 2.0.
+@requires_webgl20 Framebuffer blit is not available in WebGL 1.0.
+*/
+class MAGNUM_EXPORT RenderTargetPool {
+    public:
+        /**
+         * @brief Resolve multisampled framebuffer
+         * @param source        Multisampled source framebuffer
+         * @param destination   Single-sampled destination framebuffer
+         * @param rectangle     Rectangle to resolve, same in both
+         * @param mask          Which buffers to resolve
+         * @param invalidate    Source attachments to invalidate after the
+         *      resolve
+         *
+         * Calls @ref AbstractFramebuffer::blit() with
+         * @ref FramebufferBlitFilter::Nearest, as required for multisample
+         * resolve, and then @ref Framebuffer::invalidate() on @p source.
+         */
+        static void resolve(Framebuffer& source, AbstractFramebuffer& destination, const Range2Di& rectangle, FramebufferBlitMask mask, std::initializer_list<Framebuffer::InvalidationAttachment> invalidate);
+
+        /**
+         * @brief Resolve whole multisampled framebuffer
+         *
+         * Equivalent to calling @ref resolve(Framebuffer&, AbstractFramebuffer&, const Range2Di&, FramebufferBlitMask, std::initializer_list<Framebuffer::InvalidationAttachment>)
+         * with @p source @ref AbstractFramebuffer::viewport() "viewport" as
+         * the rectangle.
+         */
+        static void resolve(Framebuffer& source, AbstractFramebuffer& destination, FramebufferBlitMask mask, std::initializer_list<Framebuffer::InvalidationAttachment> invalidate);
+
+        /**
+         * @brief Constructor
+         * @param maxUnusedFrames   How many frames a released target is kept
+         *      in the pool without being acquired
+         */
+        explicit RenderTargetPool(UnsignedInt maxUnusedFrames = 2);
+
+        /** @brief Copying is not allowed */
+        RenderTargetPool(const RenderTargetPool&) = delete;
+
+        /** @brief Move constructor */
+        RenderTargetPool(RenderTargetPool&&) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Deletes all targets, including the ones that are still acquired.
+         */
+        ~RenderTargetPool();
+
+        /** @brief Copying is not allowed */
+        RenderTargetPool& operator=(const RenderTargetPool&) = delete;
+
+        /** @brief Move assignment */
+        RenderTargetPool& operator=(RenderTargetPool&&) noexcept;
+
+        /** @brief How many frames a released target is kept in the pool */
+        UnsignedInt maxUnusedFrames() const { return _maxUnusedFrames; }
+
+        /**
+         * @brief Current frame
+         *
+         * Incremented with every @ref nextFrame() call.
+         */
+        UnsignedInt frame() const { return _frame; }
+
+        /**
+         * @brief Acquire a texture
+         *
+         * Returns a released texture with the same format and size or
+         * creates a new one with a single level,
+         * @ref Sampler::Filter::Linear filtering and
+         * @ref Sampler::Wrapping::ClampToEdge wrapping. The texture is owned
+         * by the pool, pass it to @ref release() once its contents are no
+         * longer needed. Texture parameters changed by the user are not
+         * reset when the texture is reused.
+         * @see @ref Texture::setStorage()
+         */
+        Texture2D& acquireTexture(TextureFormat format, const Vector2i& size);
+
+        /**
+         * @brief Acquire a renderbuffer
+         *
+         * Returns a released renderbuffer with the same format, size and
+         * sample count or creates a new one. If @p samples is @cpp 0 @ce,
+         * the renderbuffer is not multisampled. The renderbuffer is owned by
+         * the pool, pass it to @ref release() once its contents are no
+         * longer needed.
+         * @see @ref Renderbuffer::setStorage(),
+         *      @ref Renderbuffer::setStorageMultisample(),
+         *      @ref Renderbuffer::maxSamples()
+         */
+        Renderbuffer& acquireRenderbuffer(RenderbufferFormat format, const Vector2i& size, Int samples = 0);
+
+        /**
+         * @brief Release a texture
+         *
+         * Expects that the texture was acquired from this pool and wasn't
+         * released yet. The texture can be then returned by a subsequent
+         * @ref acquireTexture() call in the same or any later frame.
+         */
+        void release(Texture2D& texture);
+
+        /**
+         * @brief Release a renderbuffer
+         *
+         * Expects that the renderbuffer was acquired from this pool and
+         * wasn't released yet. The renderbuffer can be then returned by a
+         * subsequent @ref acquireRenderbuffer() call in the same or any later
+         * frame.
+         */
+        void release(Renderbuffer& renderbuffer);
+
+        /**
+         * @brief Advance to next frame
+         *
+         * Deletes released targets that weren't acquired for more than
+         * @ref maxUnusedFrames() frames. Targets that are still acquired are
+         * kept.
+         */
+        void nextFrame();
+
+        /** @brief Count of textures in the pool, both acquired and released */
+        std::size_t textureCount() const { return _textures.size(); }
+
+        /** @brief Count of currently acquired textures */
+        std::size_t acquiredTextureCount() const;
+
+        /**
+         * @brief Count of renderbuffers in the pool, both acquired and
+         *      released
+         */
+        std::size_t renderbufferCount() const { return _renderbuffers.size(); }
+
+        /** @brief Count of currently acquired renderbuffers */
+        std::size_t acquiredRenderbufferCount() const;
+
+    private:
+        struct TextureEntry {
+            std::unique_ptr<Texture2D> texture;
+            TextureFormat format;
+            Vector2i size;
+            UnsignedInt lastUsedFrame;
+            bool acquired;
+        };
+
+        struct RenderbufferEntry {
+            std::unique_ptr<Renderbuffer> renderbuffer;
+            RenderbufferFormat format;
+            Vector2i size;
+            Int samples;
+            UnsignedInt lastUsedFrame;
+            bool acquired;
+        };
+
+        UnsignedInt _maxUnusedFrames, _frame{};
+        std::vector<TextureEntry> _textures;
+        std::vector<RenderbufferEntry> _renderbuffers;
+};
+
+}
+#else
+#error this header is not available in WebGL 1.0 build
+#endif
+
+#endif
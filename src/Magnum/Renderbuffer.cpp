@@ -25,8 +25,11 @@
 
 #include "Renderbuffer.h"
 
+#include <algorithm>
+
 #include "Magnum/Context.h"
 #include "Magnum/Extensions.h"
+#include "Magnum/MemoryTracker.h"
 
 #ifndef MAGNUM_TARGET_WEBGL
 #include "Implementation/DebugState.h"
@@ -91,6 +94,8 @@ Renderbuffer::~Renderbuffer() {
     GLuint& binding = Context::current().state().framebuffer->renderbufferBinding;
     if(binding == _id) binding = 0;
 
+    Context::current().memoryTracker().remove(MemoryObjectType::Renderbuffer, _id);
+
     glDeleteRenderbuffers(1, &_id);
 }
 
@@ -114,17 +119,22 @@ std::string Renderbuffer::label() {
 Renderbuffer& Renderbuffer::setLabelInternal(const Containers::ArrayView<const char> label) {
     createIfNotAlready();
     Context::current().state().debug->labelImplementation(GL_RENDERBUFFER, _id, label);
+    Context::current().memoryTracker().setLabel(MemoryObjectType::Renderbuffer, _id, {label.data(), label.size()});
     return *this;
 }
 #endif
 
 void Renderbuffer::setStorage(const RenderbufferFormat internalFormat, const Vector2i& size) {
     (this->*Context::current().state().framebuffer->renderbufferStorageImplementation)(internalFormat, size);
+    Context::current().memoryTracker().setAllocation(MemoryObjectType::Renderbuffer, _id,
+        std::size_t(MemoryTracker::pixelSize(TextureFormat(GLenum(internalFormat)))*size.product()));
 }
 
 #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
 void Renderbuffer::setStorageMultisample(const Int samples, const RenderbufferFormat internalFormat, const Vector2i& size) {
     (this->*Context::current().state().framebuffer->renderbufferStorageMultisampleImplementation)(samples, internalFormat, size);
+    Context::current().memoryTracker().setAllocation(MemoryObjectType::Renderbuffer, _id,
+        std::size_t(MemoryTracker::pixelSize(TextureFormat(GLenum(internalFormat)))*size.product()*std::max(samples, 1)));
 }
 #endif
 
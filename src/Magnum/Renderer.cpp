@@ -35,16 +35,41 @@
 
 namespace Magnum {
 
+namespace {
+
+/* Updates front, back or both tracked values for separate-face state, returns
+   true if any of them changed */
+template<class T, std::size_t size> bool updateFacing(Implementation::RendererState::Tracked<T, size>(&state)[2], const Renderer::PolygonFacing facing, std::initializer_list<T> values) {
+    switch(facing) {
+        case Renderer::PolygonFacing::Front:
+            return state[0].update(values);
+        case Renderer::PolygonFacing::Back:
+            return state[1].update(values);
+        case Renderer::PolygonFacing::FrontAndBack:
+            /* Not short-circuited, both have to be updated */
+            return state[0].update(values) | state[1].update(values);
+    }
+
+    CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+}
+
 void Renderer::enable(const Feature feature) {
-    glEnable(GLenum(feature));
+    setFeature(feature, true);
 }
 
 void Renderer::disable(const Feature feature) {
-    glDisable(GLenum(feature));
+    setFeature(feature, false);
 }
 
 void Renderer::setFeature(const Feature feature, const bool enabled) {
-    enabled ? enable(feature) : disable(feature);
+    Implementation::RendererState& state = *Context::current().state().renderer;
+    const std::size_t index = Implementation::RendererState::indexForFeature(feature);
+    if(index < Implementation::RendererState::FeatureCount && !state.features[index].update({GLboolean(enabled)}))
+        return;
+
+    enabled ? glEnable(GLenum(feature)) : glDisable(GLenum(feature));
 }
 
 void Renderer::setHint(const Hint target, const HintMode mode) {
@@ -52,39 +77,51 @@ void Renderer::setHint(const Hint target, const HintMode mode) {
 }
 
 void Renderer::setClearColor(const Color4& color) {
-    glClearColor(color.r(), color.g(), color.b(), color.a());
+    if(Context::current().state().renderer->clearColor.update({color.r(), color.g(), color.b(), color.a()}))
+        glClearColor(color.r(), color.g(), color.b(), color.a());
 }
 
 #ifndef MAGNUM_TARGET_GLES
 void Renderer::setClearDepth(const Double depth) {
+    /* The tracked value is single-precision, so just forget it */
+    Context::current().state().renderer->clearDepth.engaged = false;
     glClearDepth(depth);
 }
 #endif
 
 void Renderer::setClearDepth(Float depth) {
-    Context::current().state().renderer->clearDepthfImplementation(depth);
+    Implementation::RendererState& state = *Context::current().state().renderer;
+    if(state.clearDepth.update({depth}))
+        state.clearDepthfImplementation(depth);
 }
 
 void Renderer::setClearStencil(const Int stencil) {
-    glClearStencil(stencil);
+    if(Context::current().state().renderer->clearStencil.update({stencil}))
+        glClearStencil(stencil);
 }
 
 void Renderer::setFrontFace(const FrontFace mode) {
-    glFrontFace(GLenum(mode));
+    if(Context::current().state().renderer->frontFace.update({GLenum(mode)}))
+        glFrontFace(GLenum(mode));
 }
 
 void Renderer::setFaceCullingMode(const PolygonFacing mode) {
-    glCullFace(GLenum(mode));
+    if(Context::current().state().renderer->faceCullingMode.update({GLenum(mode)}))
+        glCullFace(GLenum(mode));
 }
 
 #ifndef MAGNUM_TARGET_GLES
 void Renderer::setProvokingVertex(const ProvokingVertex mode) {
-    glProvokingVertex(GLenum(mode));
+    if(Context::current().state().renderer->provokingVertex.update({GLenum(mode)}))
+        glProvokingVertex(GLenum(mode));
 }
 #endif
 
 #ifndef MAGNUM_TARGET_WEBGL
 void Renderer::setPolygonMode(const PolygonMode mode) {
+    if(!Context::current().state().renderer->polygonMode.update({GLenum(mode)}))
+        return;
+
     #ifndef MAGNUM_TARGET_GLES
     glPolygonMode
     #else
@@ -95,85 +132,252 @@ void Renderer::setPolygonMode(const PolygonMode mode) {
 #endif
 
 void Renderer::setPolygonOffset(const Float factor, const Float units) {
-    glPolygonOffset(factor, units);
+    if(Context::current().state().renderer->polygonOffset.update({factor, units}))
+        glPolygonOffset(factor, units);
 }
 
 void Renderer::setLineWidth(const Float width) {
-    glLineWidth(width);
+    if(Context::current().state().renderer->lineWidth.update({width}))
+        glLineWidth(width);
 }
 
 #ifndef MAGNUM_TARGET_GLES
 void Renderer::setPointSize(const Float size) {
-    glPointSize(size);
+    if(Context::current().state().renderer->pointSize.update({size}))
+        glPointSize(size);
 }
 #endif
 
 void Renderer::setScissor(const Range2Di& rectangle) {
-    glScissor(rectangle.left(), rectangle.bottom(), rectangle.sizeX(), rectangle.sizeY());
+    if(Context::current().state().renderer->scissor.update({rectangle.left(), rectangle.bottom(), rectangle.sizeX(), rectangle.sizeY()}))
+        glScissor(rectangle.left(), rectangle.bottom(), rectangle.sizeX(), rectangle.sizeY());
 }
 
 void Renderer::setStencilFunction(const PolygonFacing facing, const StencilFunction function, const Int referenceValue, const UnsignedInt mask) {
-    glStencilFuncSeparate(GLenum(facing), GLenum(function), referenceValue, mask);
+    if(updateFacing(Context::current().state().renderer->stencilFunction, facing, {GLuint(function), GLuint(referenceValue), mask}))
+        glStencilFuncSeparate(GLenum(facing), GLenum(function), referenceValue, mask);
 }
 
 void Renderer::setStencilFunction(const StencilFunction function, const Int referenceValue, const UnsignedInt mask) {
-    glStencilFunc(GLenum(function), referenceValue, mask);
+    if(updateFacing(Context::current().state().renderer->stencilFunction, PolygonFacing::FrontAndBack, {GLuint(function), GLuint(referenceValue), mask}))
+        glStencilFunc(GLenum(function), referenceValue, mask);
 }
 
 void Renderer::setStencilOperation(const PolygonFacing facing, const StencilOperation stencilFail, const StencilOperation depthFail, const StencilOperation depthPass) {
-    glStencilOpSeparate(GLenum(facing), GLenum(stencilFail), GLenum(depthFail), GLenum(depthPass));
+    if(updateFacing(Context::current().state().renderer->stencilOperation, facing, {GLenum(stencilFail), GLenum(depthFail), GLenum(depthPass)}))
+        glStencilOpSeparate(GLenum(facing), GLenum(stencilFail), GLenum(depthFail), GLenum(depthPass));
 }
 
 void Renderer::setStencilOperation(const StencilOperation stencilFail, const StencilOperation depthFail, const StencilOperation depthPass) {
-    glStencilOp(GLenum(stencilFail), GLenum(depthFail), GLenum(depthPass));
+    if(updateFacing(Context::current().state().renderer->stencilOperation, PolygonFacing::FrontAndBack, {GLenum(stencilFail), GLenum(depthFail), GLenum(depthPass)}))
+        glStencilOp(GLenum(stencilFail), GLenum(depthFail), GLenum(depthPass));
 }
 
 void Renderer::setDepthFunction(const DepthFunction function) {
-    glDepthFunc(GLenum(function));
+    if(Context::current().state().renderer->depthFunction.update({GLenum(function)}))
+        glDepthFunc(GLenum(function));
 }
 
 void Renderer::setColorMask(const GLboolean allowRed, const GLboolean allowGreen, const GLboolean allowBlue, const GLboolean allowAlpha) {
-    glColorMask(allowRed, allowGreen, allowBlue, allowAlpha);
+    if(Context::current().state().renderer->colorMask.update({allowRed, allowGreen, allowBlue, allowAlpha}))
+        glColorMask(allowRed, allowGreen, allowBlue, allowAlpha);
 }
 
 void Renderer::setDepthMask(const GLboolean allow) {
-    glDepthMask(allow);
+    if(Context::current().state().renderer->depthMask.update({allow}))
+        glDepthMask(allow);
 }
 
 void Renderer::setStencilMask(const PolygonFacing facing, const UnsignedInt allowBits) {
-    glStencilMaskSeparate(GLenum(facing), allowBits);
+    if(updateFacing(Context::current().state().renderer->stencilMask, facing, {allowBits}))
+        glStencilMaskSeparate(GLenum(facing), allowBits);
 }
 
 void Renderer::setStencilMask(const UnsignedInt allowBits) {
-    glStencilMask(allowBits);
+    if(updateFacing(Context::current().state().renderer->stencilMask, PolygonFacing::FrontAndBack, {allowBits}))
+        glStencilMask(allowBits);
 }
 
 void Renderer::setBlendEquation(const BlendEquation equation) {
-    glBlendEquation(GLenum(equation));
+    if(Context::current().state().renderer->blendEquation.update({GLenum(equation), GLenum(equation)}))
+        glBlendEquation(GLenum(equation));
 }
 
 void Renderer::setBlendEquation(const BlendEquation rgb, const BlendEquation alpha) {
-    glBlendEquationSeparate(GLenum(rgb), GLenum(alpha));
+    if(Context::current().state().renderer->blendEquation.update({GLenum(rgb), GLenum(alpha)}))
+        glBlendEquationSeparate(GLenum(rgb), GLenum(alpha));
 }
 
 void Renderer::setBlendFunction(const BlendFunction source, const BlendFunction destination) {
-    glBlendFunc(GLenum(source), GLenum(destination));
+    if(Context::current().state().renderer->blendFunction.update({GLenum(source), GLenum(destination), GLenum(source), GLenum(destination)}))
+        glBlendFunc(GLenum(source), GLenum(destination));
 }
 
 void Renderer::setBlendFunction(const BlendFunction sourceRgb, const BlendFunction destinationRgb, const BlendFunction sourceAlpha, const BlendFunction destinationAlpha) {
-    glBlendFuncSeparate(GLenum(sourceRgb), GLenum(destinationRgb), GLenum(sourceAlpha), GLenum(destinationAlpha));
+    if(Context::current().state().renderer->blendFunction.update({GLenum(sourceRgb), GLenum(destinationRgb), GLenum(sourceAlpha), GLenum(destinationAlpha)}))
+        glBlendFuncSeparate(GLenum(sourceRgb), GLenum(destinationRgb), GLenum(sourceAlpha), GLenum(destinationAlpha));
 }
 
 void Renderer::setBlendColor(const Color4& color) {
-    glBlendColor(color.r(), color.g(), color.b(), color.a());
+    if(Context::current().state().renderer->blendColor.update({color.r(), color.g(), color.b(), color.a()}))
+        glBlendColor(color.r(), color.g(), color.b(), color.a());
 }
 
 #ifndef MAGNUM_TARGET_GLES
 void Renderer::setLogicOperation(const LogicOperation operation) {
-    glLogicOp(GLenum(operation));
+    if(Context::current().state().renderer->logicOperation.update({GLenum(operation)}))
+        glLogicOp(GLenum(operation));
 }
 #endif
 
+Renderer::StateBlock::StateBlock(): _set{} {}
+
+Renderer::StateBlock& Renderer::StateBlock::setFeature(const Feature feature, const bool enabled) {
+    for(std::pair<Feature, bool>& i: _features) if(i.first == feature) {
+        i.second = enabled;
+        return *this;
+    }
+
+    _features.emplace_back(feature, enabled);
+    return *this;
+}
+
+Renderer::StateBlock& Renderer::StateBlock::setFrontFace(const FrontFace mode) {
+    _frontFace = mode;
+    _set |= FrontFaceSet;
+    return *this;
+}
+
+Renderer::StateBlock& Renderer::StateBlock::setFaceCullingMode(const PolygonFacing mode) {
+    _faceCullingMode = mode;
+    _set |= FaceCullingModeSet;
+    return *this;
+}
+
+Renderer::StateBlock& Renderer::StateBlock::setPolygonOffset(const Float factor, const Float units) {
+    _polygonOffset[0] = factor;
+    _polygonOffset[1] = units;
+    _set |= PolygonOffsetSet;
+    return *this;
+}
+
+Renderer::StateBlock& Renderer::StateBlock::setScissor(const Range2Di& rectangle) {
+    _scissor[0] = rectangle.left();
+    _scissor[1] = rectangle.bottom();
+    _scissor[2] = rectangle.right();
+    _scissor[3] = rectangle.top();
+    _set |= ScissorSet;
+    return *this;
+}
+
+Renderer::StateBlock& Renderer::StateBlock::setStencilFunction(const StencilFunction function, const Int referenceValue, const UnsignedInt mask) {
+    _stencilFunction = function;
+    _stencilReferenceValue = referenceValue;
+    _stencilFunctionMask = mask;
+    _set |= StencilFunctionSet;
+    return *this;
+}
+
+Renderer::StateBlock& Renderer::StateBlock::setStencilOperation(const StencilOperation stencilFail, const StencilOperation depthFail, const StencilOperation depthPass) {
+    _stencilOperation[0] = stencilFail;
+    _stencilOperation[1] = depthFail;
+    _stencilOperation[2] = depthPass;
+    _set |= StencilOperationSet;
+    return *this;
+}
+
+Renderer::StateBlock& Renderer::StateBlock::setDepthFunction(const DepthFunction function) {
+    _depthFunction = function;
+    _set |= DepthFunctionSet;
+    return *this;
+}
+
+Renderer::StateBlock& Renderer::StateBlock::setColorMask(const GLboolean allowRed, const GLboolean allowGreen, const GLboolean allowBlue, const GLboolean allowAlpha) {
+    _colorMask[0] = allowRed;
+    _colorMask[1] = allowGreen;
+    _colorMask[2] = allowBlue;
+    _colorMask[3] = allowAlpha;
+    _set |= ColorMaskSet;
+    return *this;
+}
+
+Renderer::StateBlock& Renderer::StateBlock::setDepthMask(const GLboolean allow) {
+    _depthMask = allow;
+    _set |= DepthMaskSet;
+    return *this;
+}
+
+Renderer::StateBlock& Renderer::StateBlock::setStencilMask(const UnsignedInt allowBits) {
+    _stencilMask = allowBits;
+    _set |= StencilMaskSet;
+    return *this;
+}
+
+Renderer::StateBlock& Renderer::StateBlock::setBlendEquation(const BlendEquation equation) {
+    return setBlendEquation(equation, equation);
+}
+
+Renderer::StateBlock& Renderer::StateBlock::setBlendEquation(const BlendEquation rgb, const BlendEquation alpha) {
+    _blendEquation[0] = rgb;
+    _blendEquation[1] = alpha;
+    _set |= BlendEquationSet;
+    return *this;
+}
+
+Renderer::StateBlock& Renderer::StateBlock::setBlendFunction(const BlendFunction source, const BlendFunction destination) {
+    return setBlendFunction(source, destination, source, destination);
+}
+
+Renderer::StateBlock& Renderer::StateBlock::setBlendFunction(const BlendFunction sourceRgb, const BlendFunction destinationRgb, const BlendFunction sourceAlpha, const BlendFunction destinationAlpha) {
+    _blendFunction[0] = sourceRgb;
+    _blendFunction[1] = destinationRgb;
+    _blendFunction[2] = sourceAlpha;
+    _blendFunction[3] = destinationAlpha;
+    _set |= BlendFunctionSet;
+    return *this;
+}
+
+Renderer::StateBlock& Renderer::StateBlock::setBlendColor(const Color4& color) {
+    _blendColor[0] = color.r();
+    _blendColor[1] = color.g();
+    _blendColor[2] = color.b();
+    _blendColor[3] = color.a();
+    _set |= BlendColorSet;
+    return *this;
+}
+
+void Renderer::apply(const StateBlock& block) {
+    for(const std::pair<Feature, bool>& feature: block._features)
+        setFeature(feature.first, feature.second);
+
+    if(block._set & StateBlock::FrontFaceSet)
+        setFrontFace(block._frontFace);
+    if(block._set & StateBlock::FaceCullingModeSet)
+        setFaceCullingMode(block._faceCullingMode);
+    if(block._set & StateBlock::PolygonOffsetSet)
+        setPolygonOffset(block._polygonOffset[0], block._polygonOffset[1]);
+    if(block._set & StateBlock::ScissorSet)
+        setScissor({{block._scissor[0], block._scissor[1]}, {block._scissor[2], block._scissor[3]}});
+    if(block._set & StateBlock::StencilFunctionSet)
+        setStencilFunction(block._stencilFunction, block._stencilReferenceValue, block._stencilFunctionMask);
+    if(block._set & StateBlock::StencilOperationSet)
+        setStencilOperation(block._stencilOperation[0], block._stencilOperation[1], block._stencilOperation[2]);
+    if(block._set & StateBlock::DepthFunctionSet)
+        setDepthFunction(block._depthFunction);
+    if(block._set & StateBlock::ColorMaskSet)
+        setColorMask(block._colorMask[0], block._colorMask[1], block._colorMask[2], block._colorMask[3]);
+    if(block._set & StateBlock::DepthMaskSet)
+        setDepthMask(block._depthMask);
+    if(block._set & StateBlock::StencilMaskSet)
+        setStencilMask(block._stencilMask);
+    if(block._set & StateBlock::BlendEquationSet)
+        setBlendEquation(block._blendEquation[0], block._blendEquation[1]);
+    if(block._set & StateBlock::BlendFunctionSet)
+        setBlendFunction(block._blendFunction[0], block._blendFunction[1], block._blendFunction[2], block._blendFunction[3]);
+    if(block._set & StateBlock::BlendColorSet)
+        setBlendColor({block._blendColor[0], block._blendColor[1], block._blendColor[2], block._blendColor[3]});
+}
+
 #ifndef MAGNUM_TARGET_WEBGL
 Renderer::ResetNotificationStrategy Renderer::resetNotificationStrategy() {
     #ifndef MAGNUM_TARGET_GLES
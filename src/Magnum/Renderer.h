@@ -29,6 +29,8 @@
  * @brief Class @ref Magnum::Renderer
  */
 
+#include <utility>
+#include <vector>
 #include <Corrade/Containers/EnumSet.h>
 
 #include "Magnum/Magnum.h"
@@ -42,6 +44,20 @@ namespace Implementation { struct RendererState; }
 /** @nosubgrouping
 @brief Global renderer configuration.
 
+@section Renderer-state-tracking State tracking
+
+All setters in this class shadow the value in the current context's state and
+call into GL only if the value differs from the previously set one. Grouping
+setters into a @ref StateBlock and submitting it with @ref apply() thus results
+only in the minimal set of GL calls needed for a transition between two render
+passes:
+
+@snippet Magnum.cpp Renderer-state-block
+
+If the GL state is modified from outside of Magnum, call
+@ref Context::resetState() with @ref Context::State::Renderer to discard the
+shadowed values. See @ref opengl-state-tracking for more information.
+
 @todo @extension{ARB,viewport_array}
 @todo `GL_POINT_SIZE_GRANULARITY`, `GL_POINT_SIZE_RANGE` (?)
 @todo `GL_STEREO`, `GL_DOUBLEBUFFER` (?)
@@ -231,6 +247,22 @@ class MAGNUM_EXPORT Renderer {
             #endif
             #endif
 
+            #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+            /**
+             * Primitive restart with fixed index. If enabled, an index equal
+             * to the maximal value representable by the index type (see
+             * @ref Mesh::primitiveRestartIndex()) ends the current primitive
+             * and starts a new one. Useful for drawing multiple triangle
+             * strips in a single draw call, see @ref MeshTools::stripify().
+             * @requires_gl43 Extension @extension{ARB,ES3_compatibility}
+             * @requires_gles30 Primitive restart is not available in OpenGL
+             *      ES 2.0.
+             * @requires_gles Always enabled in WebGL 2.0, not available in
+             *      WebGL 1.0.
+             */
+            PrimitiveRestartFixedIndex = GL_PRIMITIVE_RESTART_FIXED_INDEX,
+            #endif
+
             #ifndef MAGNUM_TARGET_GLES
             /**
              * Programmable point size. If enabled, the point size is taken
@@ -1338,7 +1370,7 @@ class MAGNUM_EXPORT Renderer {
              *      3.0 and older.
              * @requires_gles Shader storage is not available in WebGL.
              */
-            ShaderStorage = GL_ATOMIC_COUNTER_BARRIER_BIT
+            ShaderStorage = GL_SHADER_STORAGE_BARRIER_BIT
         };
 
         /**
@@ -1616,6 +1648,17 @@ class MAGNUM_EXPORT Renderer {
 
         /*@}*/
 
+        class StateBlock;
+
+        /**
+         * @brief Apply a state block
+         *
+         * Calls the setters corresponding to all values set in @p block. Only
+         * values that differ from the current state result in a GL call.
+         * @see @ref Renderer-state-tracking
+         */
+        static void apply(const StateBlock& block);
+
     private:
         static void MAGNUM_LOCAL initializeContextBasedFunctionality();
 
@@ -1630,6 +1673,189 @@ class MAGNUM_EXPORT Renderer {
         #endif
 };
 
+/**
+@brief Renderer state block
+
+Collection of render state applied at once using @ref Renderer::apply(). Only
+values that were explicitly set are applied, everything else is left
+untouched. The setters have the same semantics as the corresponding
+@ref Renderer setters. Separate-face stencil state, polygon mode and other
+rarely changed values are not part of the block, use @ref Renderer directly
+for these.
+@see @ref Renderer-state-tracking
+*/
+class MAGNUM_EXPORT Renderer::StateBlock {
+    public:
+        /** @brief Constructor */
+        explicit StateBlock();
+
+        /**
+         * @brief Enable or disable a feature
+         * @return Reference to self (for method chaining)
+         *
+         * Setting the same feature again overwrites the previous value.
+         * @see @ref Renderer::setFeature()
+         */
+        StateBlock& setFeature(Feature feature, bool enabled);
+
+        /**
+         * @brief Set front-facing polygon winding
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref Renderer::setFrontFace()
+         */
+        StateBlock& setFrontFace(FrontFace mode);
+
+        /**
+         * @brief Set which polygon facing should be culled
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref Renderer::setFaceCullingMode()
+         */
+        StateBlock& setFaceCullingMode(PolygonFacing mode);
+
+        /**
+         * @brief Set polygon offset
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref Renderer::setPolygonOffset()
+         */
+        StateBlock& setPolygonOffset(Float factor, Float units);
+
+        /**
+         * @brief Set scissor rectangle
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref Renderer::setScissor()
+         */
+        StateBlock& setScissor(const Range2Di& rectangle);
+
+        /**
+         * @brief Set stencil function for both faces
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref Renderer::setStencilFunction(StencilFunction, Int, UnsignedInt)
+         */
+        StateBlock& setStencilFunction(StencilFunction function, Int referenceValue, UnsignedInt mask);
+
+        /**
+         * @brief Set stencil operation for both faces
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref Renderer::setStencilOperation(StencilOperation, StencilOperation, StencilOperation)
+         */
+        StateBlock& setStencilOperation(StencilOperation stencilFail, StencilOperation depthFail, StencilOperation depthPass);
+
+        /**
+         * @brief Set depth function
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref Renderer::setDepthFunction()
+         */
+        StateBlock& setDepthFunction(DepthFunction function);
+
+        /**
+         * @brief Mask color writes
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref Renderer::setColorMask()
+         */
+        StateBlock& setColorMask(GLboolean allowRed, GLboolean allowGreen, GLboolean allowBlue, GLboolean allowAlpha);
+
+        /**
+         * @brief Mask depth writes
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref Renderer::setDepthMask()
+         */
+        StateBlock& setDepthMask(GLboolean allow);
+
+        /**
+         * @brief Mask stencil writes for both faces
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref Renderer::setStencilMask(UnsignedInt)
+         */
+        StateBlock& setStencilMask(UnsignedInt allowBits);
+
+        /**
+         * @brief Set blend equation
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref Renderer::setBlendEquation(BlendEquation)
+         */
+        StateBlock& setBlendEquation(BlendEquation equation);
+
+        /**
+         * @brief Set blend equation separately for RGB and alpha components
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref Renderer::setBlendEquation(BlendEquation, BlendEquation)
+         */
+        StateBlock& setBlendEquation(BlendEquation rgb, BlendEquation alpha);
+
+        /**
+         * @brief Set blend function
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref Renderer::setBlendFunction(BlendFunction, BlendFunction)
+         */
+        StateBlock& setBlendFunction(BlendFunction source, BlendFunction destination);
+
+        /**
+         * @brief Set blend function separately for RGB and alpha components
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref Renderer::setBlendFunction(BlendFunction, BlendFunction, BlendFunction, BlendFunction)
+         */
+        StateBlock& setBlendFunction(BlendFunction sourceRgb, BlendFunction destinationRgb, BlendFunction sourceAlpha, BlendFunction destinationAlpha);
+
+        /**
+         * @brief Set blend color
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref Renderer::setBlendColor()
+         */
+        StateBlock& setBlendColor(const Color4& color);
+
+    private:
+        friend Renderer;
+
+        enum: UnsignedInt {
+            FrontFaceSet = 1 << 0,
+            FaceCullingModeSet = 1 << 1,
+            PolygonOffsetSet = 1 << 2,
+            ScissorSet = 1 << 3,
+            StencilFunctionSet = 1 << 4,
+            StencilOperationSet = 1 << 5,
+            DepthFunctionSet = 1 << 6,
+            ColorMaskSet = 1 << 7,
+            DepthMaskSet = 1 << 8,
+            StencilMaskSet = 1 << 9,
+            BlendEquationSet = 1 << 10,
+            BlendFunctionSet = 1 << 11,
+            BlendColorSet = 1 << 12
+        };
+
+        UnsignedInt _set;
+        std::vector<std::pair<Feature, bool>> _features;
+        FrontFace _frontFace;
+        PolygonFacing _faceCullingMode;
+        Float _polygonOffset[2];
+        Int _scissor[4];
+        StencilFunction _stencilFunction;
+        Int _stencilReferenceValue;
+        UnsignedInt _stencilFunctionMask;
+        StencilOperation _stencilOperation[3];
+        DepthFunction _depthFunction;
+        GLboolean _colorMask[4];
+        GLboolean _depthMask;
+        UnsignedInt _stencilMask;
+        BlendEquation _blendEquation[2];
+        BlendFunction _blendFunction[4];
+        Float _blendColor[4];
+};
+
 #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
 CORRADE_ENUMSET_OPERATORS(Renderer::MemoryBarriers)
 #endif
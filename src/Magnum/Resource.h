@@ -29,6 +29,7 @@
  * @brief Class @ref Magnum::ResourceKey, @ref Magnum::Resource, enum @ref Magnum::ResourceState
  */
 
+#include <atomic>
 #include <Corrade/Utility/Assert.h>
 #include <Corrade/Utility/MurmurHash2.h>
 
@@ -108,6 +109,112 @@ namespace Implementation {
     template<class> class ResourceManagerData;
 }
 
+/**
+@brief Pinned resource
+
+Direct pointer to resource data obtained with @ref Resource::pin(). Unlike
+@ref Resource, accessing the data doesn't check the manager for changes, so
+it's meant to be obtained once for example at the beginning of a frame and
+then used on hot paths such as in draw functions:
+
+@code{.cpp}
+PinnedResource<Mesh> mesh = _mesh.pin();
+PinnedResource<AbstractShaderProgram, MyShader> shader = _shader.pin();
+
+// ...
+
+mesh->draw(*shader);
+@endcode
+
+The pinned resource doesn't hold a reference to the data, so it must not
+outlive the @ref Resource it was obtained from and the resource shouldn't be
+changed in the manager while it's pinned. If asserts are enabled, accessing
+the data checks that the resource wasn't changed since it was pinned.
+*/
+#ifdef DOXYGEN_GENERATING_OUTPUT
+template<class T, class U = T>
+#else
+template<class T, class U>
+#endif
+class PinnedResource {
+    public:
+        /**
+         * @brief Default constructor
+         *
+         * Creates a pinned resource with no data.
+         */
+        constexpr explicit PinnedResource() noexcept: _data{}
+            #ifndef CORRADE_NO_ASSERT
+            , _entry{}, _generation{}
+            #endif
+            {}
+
+        /**
+         * @brief Pointer to resource data
+         *
+         * Returns @cpp nullptr @ce if the resource wasn't loaded when it was
+         * pinned.
+         */
+        operator U*() const {
+            CORRADE_ASSERT(isValid(), "PinnedResource: resource" << _key << "changed since it was pinned", nullptr);
+            return _data;
+        }
+
+        /**
+         * @brief Reference to resource data
+         *
+         * Expects that the resource was loaded when it was pinned.
+         */
+        U& operator*() const {
+            CORRADE_ASSERT(isValid(), "PinnedResource: resource" << _key << "changed since it was pinned", *_data);
+            CORRADE_ASSERT(_data, "PinnedResource: accessing not loaded data", *_data);
+            return *_data;
+        }
+
+        /**
+         * @brief Access to resource data
+         *
+         * Expects that the resource was loaded when it was pinned.
+         */
+        U* operator->() const {
+            CORRADE_ASSERT(isValid(), "PinnedResource: resource" << _key << "changed since it was pinned", nullptr);
+            CORRADE_ASSERT(_data, "PinnedResource: accessing not loaded data", nullptr);
+            return _data;
+        }
+
+    private:
+        #ifndef DOXYGEN_GENERATING_OUTPUT /* https://bugzilla.gnome.org/show_bug.cgi?id=776986 */
+        friend Resource<T, U>;
+        #endif
+
+        explicit PinnedResource(U* data, const typename Implementation::ResourceManagerData<T>::Data* entry, std::size_t generation, ResourceKey key) noexcept: _data{data}
+            #ifndef CORRADE_NO_ASSERT
+            , _entry{entry}, _generation{generation}, _key{key}
+            #endif
+        {
+            #ifdef CORRADE_NO_ASSERT
+            static_cast<void>(entry);
+            static_cast<void>(generation);
+            static_cast<void>(key);
+            #endif
+        }
+
+        #ifndef CORRADE_NO_ASSERT
+        bool isValid() const {
+            return !_entry || _entry->generation.load(std::memory_order_relaxed) == _generation;
+        }
+        #endif
+
+        U* _data;
+        /* The data for the validity check are present only if asserts are
+           enabled, so in release builds it's just a pointer */
+        #ifndef CORRADE_NO_ASSERT
+        const typename Implementation::ResourceManagerData<T>::Data* _entry;
+        std::size_t _generation;
+        ResourceKey _key;
+        #endif
+};
+
 /**
 @brief Resource reference
 
@@ -126,22 +233,22 @@ class Resource {
          * Creates empty resource. Resources are acquired from the manager by
          * calling @ref ResourceManager::get().
          */
-        explicit Resource(): manager(nullptr), lastCheck(0), _state(ResourceState::Final), data(nullptr) {}
+        explicit Resource(): manager(nullptr), entry(nullptr), lastCheck(0), _state(ResourceState::Final), data(nullptr) {}
 
         /** @brief Copy constructor */
-        Resource(const Resource<T, U>& other): manager(other.manager), _key(other._key), lastCheck(other.lastCheck), _state(other._state), data(other.data) {
-            if(manager) manager->incrementReferenceCount(_key);
+        Resource(const Resource<T, U>& other): manager(other.manager), entry(other.entry), _key(other._key), lastCheck(other.lastCheck), _state(other._state), data(other.data) {
+            if(manager) manager->incrementReferenceCount(*entry);
         }
 
         /** @brief Move constructor */
-        Resource(Resource<T, U>&& other): manager(other.manager), _key(other._key), lastCheck(other.lastCheck), _state(other._state), data(other.data) {
+        Resource(Resource<T, U>&& other): manager(other.manager), entry(other.entry), _key(other._key), lastCheck(other.lastCheck), _state(other._state), data(other.data) {
             /** @brief Make other's state well-defined */
             other.manager = nullptr;
         }
 
         /** @brief Destructor */
         ~Resource() {
-            if(manager) manager->decrementReferenceCount(_key);
+            if(manager) manager->decrementReferenceCount(_key, *entry);
         }
 
         /** @brief Copy assignment */
@@ -212,18 +319,31 @@ class Resource {
             return static_cast<U*>(data);
         }
 
+        /**
+         * @brief Pin the resource data
+         *
+         * Returns a direct pointer to current data (or the fallback) that
+         * doesn't check the manager for changes on access. See
+         * @ref PinnedResource for more information.
+         */
+        PinnedResource<T, U> pin() {
+            acquire();
+            return PinnedResource<T, U>{static_cast<U*>(data), entry, lastCheck, _key};
+        }
+
     private:
         #ifndef DOXYGEN_GENERATING_OUTPUT /* https://bugzilla.gnome.org/show_bug.cgi?id=776986 */
         friend Implementation::ResourceManagerData<T>;
         #endif
 
-        Resource(Implementation::ResourceManagerData<T>* manager, ResourceKey key): manager(manager), _key(key), lastCheck(0), _state(ResourceState::NotLoaded), data(nullptr) {
-            manager->incrementReferenceCount(key);
-        }
+        /* lastCheck is set to a value that no generation has, so the data
+           are fetched on first access */
+        Resource(Implementation::ResourceManagerData<T>* manager, ResourceKey key): manager(manager), entry(&manager->acquireData(key)), _key(key), lastCheck(~std::size_t{}), _state(ResourceState::NotLoaded), data(nullptr) {}
 
         void acquire();
 
         Implementation::ResourceManagerData<T>* manager;
+        typename Implementation::ResourceManagerData<T>::Data* entry;
         ResourceKey _key;
         std::size_t lastCheck;
         ResourceState _state;
@@ -231,23 +351,25 @@ class Resource {
 };
 
 template<class T, class U> Resource<T, U>& Resource<T, U>::operator=(const Resource<T, U>& other) {
-    if(manager) manager->decrementReferenceCount(_key);
+    /* Increment first, so self-assignment doesn't free the data */
+    if(other.manager) other.manager->incrementReferenceCount(*other.entry);
+    if(manager) manager->decrementReferenceCount(_key, *entry);
 
     manager = other.manager;
+    entry = other.entry;
     _key = other._key;
     lastCheck = other.lastCheck;
     _state = other._state;
     data = other.data;
-
-    if(manager) manager->incrementReferenceCount(_key);
     return *this;
 }
 
 template<class T, class U> Resource<T, U>& Resource<T, U>::operator=(Resource<T, U>&& other) {
     /** @todo Just swap the values */
-    if(manager) manager->decrementReferenceCount(_key);
+    if(manager) manager->decrementReferenceCount(_key, *entry);
 
     manager = other.manager;
+    entry = other.entry;
     _key = other._key;
     lastCheck = other.lastCheck;
     _state = other._state;
@@ -261,16 +383,20 @@ template<class T, class U> void Resource<T, U>::acquire() {
     /* The data are already final, nothing to do */
     if(_state == ResourceState::Final) return;
 
-    /* Nothing changed since last check */
-    if(manager->lastChange() < lastCheck) return;
+    /* Mark as used for the eviction of budgeted resources */
+    manager->touch(*entry);
 
-    /* Acquire new data and save last check time */
-    const typename Implementation::ResourceManagerData<T>::Data& d = manager->data(_key);
-    lastCheck = manager->lastChange();
+    /* Nothing changed in this resource since last check. Only a single
+       atomic load, without any lookup or lock. */
+    if(entry->generation.load(std::memory_order_acquire) == lastCheck) return;
 
-    /* Try to get the data */
-    data = d.data;
-    _state = static_cast<ResourceState>(d.state);
+    /* Acquire new data and save the generation they belong to */
+    {
+        const typename Implementation::ResourceManagerData<T>::Lock lock{manager->shard(_key).mutex};
+        lastCheck = entry->generation.load(std::memory_order_relaxed);
+        data = entry->data;
+        _state = static_cast<ResourceState>(entry->state);
+    }
 
     /* Data are not available */
     if(!data) {
@@ -0,0 +1,126 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ResourceLoadBatch.h"
+
+#include <algorithm>
+
+namespace Magnum {
+
+namespace Implementation {
+    ResourceLoadBatchEntry::~ResourceLoadBatchEntry() = default;
+}
+
+namespace {
+    bool isStateFinished(const ResourceState state) {
+        return state != ResourceState::NotLoaded &&
+               state != ResourceState::NotLoadedFallback &&
+               state != ResourceState::Loading &&
+               state != ResourceState::LoadingFallback;
+    }
+}
+
+ResourceLoadBatch::ResourceLoadBatch() = default;
+
+ResourceLoadBatch::ResourceLoadBatch(ResourceLoadBatch&&) noexcept = default;
+
+ResourceLoadBatch::~ResourceLoadBatch() = default;
+
+ResourceLoadBatch& ResourceLoadBatch::operator=(ResourceLoadBatch&&) noexcept = default;
+
+std::size_t ResourceLoadBatch::addInternal(std::unique_ptr<Implementation::ResourceLoadBatchEntry>&& entry, const std::initializer_list<std::size_t> dependencies) {
+    entry->dependencies.assign(dependencies.begin(), dependencies.end());
+    _entries.push_back(std::move(entry));
+    _entryFinished.push_back(false);
+    _finished = false;
+    return _entries.size() - 1;
+}
+
+ResourceLoadBatch& ResourceLoadBatch::setFinishedCallback(std::function<void()> callback) {
+    _finishedCallback = std::move(callback);
+    return *this;
+}
+
+ResourceLoadBatch& ResourceLoadBatch::update() {
+    if(_finished) return *this;
+
+    /* Repeat as long as something gets requested, so chains of dependencies
+       served by synchronous loaders are resolved in a single call */
+    std::vector<std::size_t> ready;
+    std::vector<ResourceKey> keys;
+    do {
+        /* Check state of requested resources */
+        for(std::size_t i = 0; i != _entries.size(); ++i) {
+            if(!_entries[i]->requested || _entryFinished[i]) continue;
+
+            const ResourceState state = _entries[i]->state();
+            if(!isStateFinished(state)) continue;
+
+            _entryFinished[i] = true;
+            ++_finishedCount;
+            if(state == ResourceState::NotFound || state == ResourceState::NotFoundFallback)
+                ++_notFoundCount;
+        }
+
+        /* Gather resources that have all dependencies finished */
+        ready.clear();
+        for(std::size_t i = 0; i != _entries.size(); ++i) {
+            if(_entries[i]->requested) continue;
+            if(std::all_of(_entries[i]->dependencies.begin(), _entries[i]->dependencies.end(), [this](std::size_t dependency) { return bool(_entryFinished[dependency]); }))
+                ready.push_back(i);
+        }
+
+        /* Pass resources handled by the same loader to it at once */
+        std::stable_sort(ready.begin(), ready.end(), [this](std::size_t a, std::size_t b) {
+            return std::less<const void*>{}(_entries[a]->loader, _entries[b]->loader);
+        });
+        for(auto it = ready.begin(); it != ready.end(); ) {
+            const void* const loader = _entries[*it]->loader;
+            auto end = it;
+            keys.clear();
+            for(; end != ready.end() && _entries[*end]->loader == loader; ++end)
+                keys.push_back(_entries[*end]->key);
+
+            if(loader) _entries[*it]->load(keys);
+            it = end;
+        }
+
+        /* The loaders already know about the resources, so this doesn't
+           request them again */
+        for(const std::size_t i: ready) {
+            _entries[i]->acquire();
+            _entries[i]->requested = true;
+        }
+    } while(!ready.empty());
+
+    if(_finishedCount == _entries.size()) {
+        _finished = true;
+        if(_finishedCallback) _finishedCallback();
+    }
+
+    return *this;
+}
+
+}
@@ -0,0 +1,222 @@
+#ifndef Magnum_ResourceLoadBatch_h
+#define Magnum_ResourceLoadBatch_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::ResourceLoadBatch
+ */
+
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/ResourceManager.h"
+#include "Magnum/visibility.h"
+
+namespace Magnum {
+
+namespace Implementation {
+    struct MAGNUM_EXPORT ResourceLoadBatchEntry {
+        explicit ResourceLoadBatchEntry(ResourceKey key, const void* loader): key{key}, loader{loader} {}
+
+        virtual ~ResourceLoadBatchEntry();
+
+        /* Passes keys of all entries with the same loader, including this
+           one, to the loader */
+        virtual void load(const std::vector<ResourceKey>& keys) = 0;
+
+        /* Acquires the resource from the manager */
+        virtual void acquire() = 0;
+
+        virtual ResourceState state() = 0;
+
+        ResourceKey key;
+        const void* loader;
+        std::vector<std::size_t> dependencies;
+        bool requested{};
+    };
+
+    template<class T, class ...Types> struct ResourceLoadBatchEntryImplementation: ResourceLoadBatchEntry {
+        explicit ResourceLoadBatchEntryImplementation(ResourceManager<Types...>& manager, ResourceKey key): ResourceLoadBatchEntry{key, manager.template loader<T>()}, manager(manager) {}
+
+        void load(const std::vector<ResourceKey>& keys) override {
+            /* Request only resources that aren't in the manager yet, the
+               rest is handled by get() */
+            std::vector<ResourceKey> missing;
+            for(ResourceKey key: keys) {
+                const ResourceState state = manager.template state<T>(key);
+                if(state == ResourceState::NotLoaded || state == ResourceState::NotLoadedFallback)
+                    missing.push_back(key);
+            }
+            AbstractResourceLoader<T>* const loader = manager.template loader<T>();
+            if(loader && !missing.empty())
+                loader->load(Containers::arrayView(missing.data(), missing.size()));
+        }
+
+        void acquire() override {
+            resource = manager.template get<T>(key);
+        }
+
+        ResourceState state() override { return resource.state(); }
+
+        ResourceManager<Types...>& manager;
+        Resource<T> resource;
+    };
+}
+
+/**
+@brief Batch of resources loaded as a unit
+
+Collects resources that need to be loaded together, such as all resources of
+a level, with dependencies between them, and signals once they are all
+loaded. The batch keeps a @ref Resource reference to each of them, so they
+stay in the @ref ResourceManager at least until the batch is destroyed.
+
+@code{.cpp}
+ResourceLoadBatch batch;
+std::size_t diffuse = batch.add<Texture2D>(manager, "diffuse.png");
+std::size_t normal = batch.add<Texture2D>(manager, "normal.png");
+std::size_t material = batch.add<Material>(manager, "material", {diffuse, normal});
+batch.add<Mesh>(manager, "mesh", {material});
+batch.setFinishedCallback([]() {
+    // Switch to the new level...
+});
+
+// Each frame
+batch.update();
+@endcode
+
+@section ResourceLoadBatch-loading Loading
+
+A resource is requested from the manager in @ref update() once all its
+dependencies are loaded (or not found), resources that don't depend on each
+other are requested in the same @ref update() call. All resources of the same
+type requested in one @ref update() are passed to
+@ref AbstractResourceLoader::load(Containers::ArrayView<const ResourceKey>)
+at once, so the loader can process them in parallel or read resources stored
+in the same file only once. Asynchronous loaders such as
+@ref AbstractAsyncResourceLoader need their own update function to be called
+as well.
+
+Dependencies are expressed through IDs returned from @ref add(), so a
+resource can depend only on resources added before it and the dependencies
+can't have cycles.
+*/
+class MAGNUM_EXPORT ResourceLoadBatch {
+    public:
+        explicit ResourceLoadBatch();
+
+        /** @brief Copying is not allowed */
+        ResourceLoadBatch(const ResourceLoadBatch&) = delete;
+
+        /** @brief Move constructor */
+        ResourceLoadBatch(ResourceLoadBatch&&) noexcept;
+
+        ~ResourceLoadBatch();
+
+        /** @brief Copying is not allowed */
+        ResourceLoadBatch& operator=(const ResourceLoadBatch&) = delete;
+
+        /** @brief Move assignment */
+        ResourceLoadBatch& operator=(ResourceLoadBatch&&) noexcept;
+
+        /**
+         * @brief Add a resource
+         * @param manager       Manager to load the resource from
+         * @param key           Resource key
+         * @param dependencies  IDs of resources that need to be loaded first
+         * @return ID of the resource in the batch
+         *
+         * Expects that all dependencies were already added. The resource is
+         * requested from the manager in a subsequent @ref update().
+         */
+        template<class T, class ...Types> std::size_t add(ResourceManager<Types...>& manager, ResourceKey key, std::initializer_list<std::size_t> dependencies = {}) {
+            for(const std::size_t dependency: dependencies)
+                CORRADE_ASSERT(dependency < _entries.size(),
+                    "ResourceLoadBatch::add(): dependency" << dependency << "out of range for" << _entries.size() << "resources", {});
+            return addInternal(std::unique_ptr<Implementation::ResourceLoadBatchEntry>{new Implementation::ResourceLoadBatchEntryImplementation<T, Types...>{manager, key}}, dependencies);
+        }
+
+        /** @brief Count of resources in the batch */
+        std::size_t count() const { return _entries.size(); }
+
+        /**
+         * @brief Count of finished resources
+         *
+         * Resources that are loaded or weren't found, updated in
+         * @ref update().
+         * @see @ref notFoundCount()
+         */
+        std::size_t finishedCount() const { return _finishedCount; }
+
+        /**
+         * @brief Count of resources that weren't found
+         *
+         * Updated in @ref update().
+         */
+        std::size_t notFoundCount() const { return _notFoundCount; }
+
+        /**
+         * @brief Whether all resources are finished
+         *
+         * Empty batch is finished after the first @ref update().
+         */
+        bool isFinished() const { return _finished; }
+
+        /**
+         * @brief Set callback called when all resources are finished
+         * @return Reference to self (for method chaining)
+         *
+         * The callback is called only once, from @ref update().
+         */
+        ResourceLoadBatch& setFinishedCallback(std::function<void()> callback);
+
+        /**
+         * @brief Update the batch
+         * @return Reference to self (for method chaining)
+         *
+         * Checks state of requested resources, requests resources that have
+         * all dependencies finished and calls the finished callback if all
+         * resources are finished. Once the batch is finished, does
+         * nothing.
+         */
+        ResourceLoadBatch& update();
+
+    private:
+        std::size_t addInternal(std::unique_ptr<Implementation::ResourceLoadBatchEntry>&& entry, std::initializer_list<std::size_t> dependencies);
+
+        std::vector<std::unique_ptr<Implementation::ResourceLoadBatchEntry>> _entries;
+        std::vector<bool> _entryFinished;
+        std::size_t _finishedCount{}, _notFoundCount{};
+        bool _finished{};
+        std::function<void()> _finishedCallback;
+};
+
+}
+
+#endif
@@ -29,7 +29,12 @@
  * @brief Class @ref Magnum::ResourceManager, @ref Magnum::ResourceDataState, @ref Magnum::ResourcePolicy
  */
 
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <tuple>
 #include <unordered_map>
+#include <vector>
 
 #include "Magnum/Resource.h"
 
@@ -85,7 +90,16 @@ enum class ResourcePolicy: UnsignedByte {
     Manual,
 
     /** The resource will be unloaded when last reference to it is gone. */
-    ReferenceCounted
+    ReferenceCounted,
+
+    /**
+     * Same as @ref ResourcePolicy::Manual, but the resource additionally
+     * counts towards the budget set with @ref ResourceManager::setBudget()
+     * and is evicted, least recently used first, when the budget is
+     * exceeded. Can't be combined with @ref ResourceDataState::Final. See
+     * @ref ResourceManager-budget for more information.
+     */
+    Budgeted
 };
 
 template<class> class AbstractResourceLoader;
@@ -96,6 +110,7 @@ namespace Implementation {
 
 template<class T> class ResourceManagerData {
     template<class, class> friend class Magnum::Resource;
+    template<class, class> friend class Magnum::PinnedResource;
     friend AbstractResourceLoader<T>;
 
     public:
@@ -109,7 +124,7 @@ template<class T> class ResourceManagerData {
 
         std::size_t lastChange() const { return _lastChange; }
 
-        std::size_t count() const { return _data.size(); }
+        std::size_t count() const;
 
         std::size_t referenceCount(ResourceKey key) const;
 
@@ -117,7 +132,15 @@ template<class T> class ResourceManagerData {
 
         template<class U> Resource<T, U> get(ResourceKey key);
 
-        void set(ResourceKey key, T* data, ResourceDataState state, ResourcePolicy policy);
+        void set(ResourceKey key, T* data, ResourceDataState state, ResourcePolicy policy, std::size_t size);
+
+        std::size_t budget() const { return _budget; }
+
+        std::size_t budgetUsage() const { return _budgetUsage; }
+
+        void setBudget(std::size_t budget);
+
+        void unload(ResourceKey key);
 
         T* fallback() { return _fallback; }
         const T* fallback() const { return _fallback; }
@@ -126,7 +149,7 @@ template<class T> class ResourceManagerData {
 
         void free();
 
-        void clear() { _data.clear(); }
+        void clear();
 
         AbstractResourceLoader<T>* loader() { return _loader; }
         const AbstractResourceLoader<T>* loader() const { return _loader; }
@@ -136,23 +159,53 @@ template<class T> class ResourceManagerData {
         void setLoader(AbstractResourceLoader<T>* loader);
 
     protected:
-        ResourceManagerData(): _fallback(nullptr), _loader(nullptr), _lastChange(0) {}
+        ResourceManagerData(): _fallback(nullptr), _loader(nullptr), _lastChange(0), _budget(~std::size_t{}), _budgetUsage(0), _evicting(false) {}
 
     private:
         struct Data;
 
-        const Data& data(ResourceKey key) { return _data[key]; }
-
-        void incrementReferenceCount(ResourceKey key) {
-            ++_data[key].referenceCount;
+        /* The data are split into shards by the key hash, each guarded by
+           its own mutex, so accesses to different resources from different
+           threads don't contend on a single lock */
+        struct Shard {
+            mutable std::mutex mutex;
+            std::unordered_map<ResourceKey, Data> data;
+        };
+        typedef std::unique_lock<std::mutex> Lock;
+        enum: std::size_t { ShardBits = 4, ShardCount = 1 << ShardBits };
+
+        /* Fibonacci hashing, as keys constructed directly from an integer
+           aren't hashed at all. Uses the topmost bits, the lowest bits are
+           used for picking the bucket inside the map. */
+        static std::size_t shardIndex(ResourceKey key) {
+            return std::size_t((UnsignedLong(std::hash<ResourceKey>{}(key))*0x9e3779b97f4a7c15ull) >> (64 - ShardBits));
         }
+        Shard& shard(ResourceKey key) { return _shards[shardIndex(key)]; }
+        const Shard& shard(ResourceKey key) const { return _shards[shardIndex(key)]; }
+
+        /* Map nodes have stable addresses and an entry is never erased while
+           it's referenced, so Resource instances keep a pointer to it */
+        Data& acquireData(ResourceKey key);
 
-        void decrementReferenceCount(ResourceKey key);
+        static void incrementReferenceCount(Data& data);
 
-        std::unordered_map<ResourceKey, Data> _data;
+        void decrementReferenceCount(ResourceKey key, Data& data);
+
+        /* Records the access for eviction of budgeted resources. The value of
+           _lastChange is used as a clock, so resources accessed between two
+           set() calls are equally old. */
+        void touch(Data& data) const;
+
+        /* Evicts least recently used budgeted resources until the usage fits
+           into the budget */
+        void evict();
+
+        Shard _shards[ShardCount];
         T* _fallback;
         AbstractResourceLoader<T>* _loader;
-        std::size_t _lastChange;
+        std::atomic<std::size_t> _lastChange;
+        std::atomic<std::size_t> _budget, _budgetUsage;
+        std::atomic<bool> _evicting;
 };
 
 /* Helper class for defining which real types are in the type pack */
@@ -256,6 +309,56 @@ Basic usage is:
 </li>
 </ul>
 
+@section ResourceManager-budget Memory budget
+
+Resources set with @ref ResourcePolicy::Budgeted have a size cost passed to
+@ref set(), for example the amount of memory a texture occupies in VRAM. The
+manager keeps track of the total cost for each type, available through
+@ref budgetUsage(). When it exceeds the limit given by @ref setBudget(), the
+least recently used budgeted resources are evicted until the usage fits into
+the budget again. Resources are considered used when a @ref Resource instance
+accesses them or when they are acquired with @ref get() or updated with
+@ref set(), with the precision of a @ref set() call --- all resources accessed
+between two @ref set() calls are considered equally old.
+
+@code{.cpp}
+manager.setBudget<Texture2D>(512*1024*1024);
+
+Texture2D* texture = new Texture2D;
+// ...
+manager.set(key, texture, ResourceDataState::Mutable, ResourcePolicy::Budgeted,
+    image.data().size());
+@endcode
+
+Evicted resources that are not referenced are removed from the manager,
+referenced resources are reported as @ref ResourceState::NotLoaded (or
+@ref ResourceState::NotLoadedFallback) and the next @ref get() asks the loader
+to load them again. Because @ref Resource instances don't check final
+resources for changes, budgeted resources can't be
+@ref ResourceDataState::Final. If a loader is set, the eviction is done
+through @ref AbstractResourceLoader::doEvict(), which can for example replace
+the resource with a lower-resolution version instead of unloading it.
+
+@section ResourceManager-threading Thread safety
+
+It's possible to call @ref get(), @ref set(), @ref state(),
+@ref referenceCount(), @ref count(), @ref free() and @ref clear() and access
+@ref Resource instances from multiple threads at the same time, so for
+example worker threads can resolve resources while a streaming loader
+@ref set() "set()s" its results. The resources are split into several shards
+by their key, each guarded by its own lock, and reference counts are atomic.
+Each resource carries a generation that's incremented on every @ref set(),
+so @ref Resource instances check only it on access instead of looking the
+resource up again and don't need to lock anything as long as the resource
+didn't change.
+
+Setting new data for a @ref ResourceDataState::Mutable resource deletes the
+previous data, so if other threads are accessing them at the same time, the
+synchronization is up to the user. The @ref setFallback() and
+@ref setLoader() functions are not thread-safe and are meant to be called
+before the manager is accessed from multiple threads. The loader is called
+from the thread calling @ref get().
+
 @see @ref AbstractResourceLoader
 */
 /* Due to too much work involved with explicit template instantiation (all
@@ -330,24 +433,33 @@ template<class... Types> class ResourceManager: private Implementation::Resource
 
         /**
          * @brief Set resource data
+         * @param key       Resource key
+         * @param data      Resource data
+         * @param state     Resource state
+         * @param policy    Resource policy
+         * @param size      Size cost of the resource, used only for
+         *      @ref ResourcePolicy::Budgeted
          * @return Reference to self (for method chaining)
          *
          * Resources with @ref ResourcePolicy::ReferenceCounted are added with
          * zero reference count. It means that all reference counted resources
          * which were only loaded but not used will stay loaded and you need to
-         * explicitly call @ref free() to delete them.
+         * explicitly call @ref free() to delete them. If the @ref budgetUsage()
+         * exceeds the @ref budget() afterwards, least recently used budgeted
+         * resources are evicted, see @ref ResourceManager-budget for more
+         * information.
          * @attention Subsequent updates are not possible if resource state is
          *      already @ref ResourceState::Final.
          * @see @ref referenceCount(), @ref state()
          */
-        template<class T> ResourceManager<Types...>& set(ResourceKey key, T* data, ResourceDataState state, ResourcePolicy policy) {
-            this->Implementation::ResourceManagerData<T>::set(key, data, state, policy);
+        template<class T> ResourceManager<Types...>& set(ResourceKey key, T* data, ResourceDataState state, ResourcePolicy policy, std::size_t size = 0) {
+            this->Implementation::ResourceManagerData<T>::set(key, data, state, policy, size);
             return *this;
         }
 
         /** @overload */
-        template<class U> ResourceManager<Types...>& set(ResourceKey key, U&& data, ResourceDataState state, ResourcePolicy policy) {
-            return set(key, new typename std::decay<U>::type(std::forward<U>(data)), state, policy);
+        template<class U> ResourceManager<Types...>& set(ResourceKey key, U&& data, ResourceDataState state, ResourcePolicy policy, std::size_t size = 0) {
+            return set(key, new typename std::decay<U>::type(std::forward<U>(data)), state, policy, size);
         }
 
         /**
@@ -366,6 +478,56 @@ template<class... Types> class ResourceManager: private Implementation::Resource
             return set(key, new typename std::decay<U>::type(std::forward<U>(data)));
         }
 
+        /**
+         * @brief Budget for given type of resources
+         *
+         * Default is unlimited.
+         * @see @ref budgetUsage(), @ref ResourceManager-budget
+         */
+        template<class T> std::size_t budget() const {
+            return this->Implementation::ResourceManagerData<T>::budget();
+        }
+
+        /**
+         * @brief Set budget for given type of resources
+         * @return Reference to self (for method chaining)
+         *
+         * If current @ref budgetUsage() exceeds the budget, least recently
+         * used resources with @ref ResourcePolicy::Budgeted are evicted. See
+         * @ref ResourceManager-budget for more information.
+         */
+        template<class T> ResourceManager<Types...>& setBudget(std::size_t budget) {
+            this->Implementation::ResourceManagerData<T>::setBudget(budget);
+            return *this;
+        }
+
+        /**
+         * @brief Total size cost of budgeted resources of given type
+         *
+         * Sum of sizes passed to @ref set() for all resources with
+         * @ref ResourcePolicy::Budgeted that weren't evicted.
+         * @see @ref budget(), @ref ResourceManager-budget
+         */
+        template<class T> std::size_t budgetUsage() const {
+            return this->Implementation::ResourceManagerData<T>::budgetUsage();
+        }
+
+        /**
+         * @brief Unload resource data
+         * @return Reference to self (for method chaining)
+         *
+         * Deletes the data of given resource. If the resource is not
+         * referenced, it's removed from the manager, otherwise it's reported
+         * as @ref ResourceState::NotLoaded and the next @ref get() asks the
+         * loader to load it again. Final resources can't be unloaded. This is
+         * what eviction of @ref ResourcePolicy::Budgeted resources does by
+         * default.
+         */
+        template<class T> ResourceManager<Types...>& unload(ResourceKey key) {
+            this->Implementation::ResourceManagerData<T>::unload(key);
+            return *this;
+        }
+
         /** @brief Fallback for not found resources */
         template<class T> T* fallback() {
             return this->Implementation::ResourceManagerData<T>::fallback();
@@ -494,28 +656,41 @@ template<class T> ResourceManagerData<T>::~ResourceManagerData() {
     safeDelete(_fallback);
 }
 
+template<class T> std::size_t ResourceManagerData<T>::count() const {
+    std::size_t count = 0;
+    for(const Shard& s: _shards) {
+        Lock lock{s.mutex};
+        count += s.data.size();
+    }
+    return count;
+}
+
 template<class T> std::size_t ResourceManagerData<T>::referenceCount(const ResourceKey key) const {
-    auto it = _data.find(key);
-    if(it == _data.end()) return 0;
+    const Shard& s = shard(key);
+    Lock lock{s.mutex};
+    auto it = s.data.find(key);
+    if(it == s.data.end()) return 0;
     return it->second.referenceCount;
 }
 
 template<class T> ResourceState ResourceManagerData<T>::state(const ResourceKey key) const {
-    const auto it = _data.find(key);
+    const Shard& s = shard(key);
+    Lock lock{s.mutex};
+    const auto it = s.data.find(key);
 
     /* Resource not loaded */
-    if(it == _data.end() || !it->second.data) {
+    if(it == s.data.end() || !it->second.data) {
         /* Fallback found, add *Fallback to state */
         if(_fallback) {
-            if(it != _data.end() && it->second.state == ResourceDataState::Loading)
+            if(it != s.data.end() && it->second.state == ResourceDataState::Loading)
                 return ResourceState::LoadingFallback;
-            else if(it != _data.end() && it->second.state == ResourceDataState::NotFound)
+            else if(it != s.data.end() && it->second.state == ResourceDataState::NotFound)
                 return ResourceState::NotFoundFallback;
             else return ResourceState::NotLoadedFallback;
         }
 
         /* Fallback not found, loading didn't start yet */
-        if(it == _data.end() || (it->second.state != ResourceDataState::Loading && it->second.state != ResourceDataState::NotFound))
+        if(it == s.data.end() || (it->second.state != ResourceDataState::Loading && it->second.state != ResourceDataState::NotFound))
             return ResourceState::NotLoaded;
     }
 
@@ -524,35 +699,126 @@ template<class T> ResourceState ResourceManagerData<T>::state(const ResourceKey
 }
 
 template<class T> template<class U> Resource<T, U> ResourceManagerData<T>::get(ResourceKey key) {
-    /* Ask loader for the data, if they aren't there yet */
-    if(_loader && _data.find(key) == _data.end())
-        _loader->load(key);
+    /* Ask loader for the data, if they aren't there yet or were evicted. The
+       lock is released before calling the loader, as it calls set(). */
+    if(_loader) {
+        bool found;
+        {
+            const Shard& s = shard(key);
+            Lock lock{s.mutex};
+            const auto it = s.data.find(key);
+            found = it != s.data.end() && !it->second.evicted;
+        }
+        if(!found) _loader->load(key);
+    }
 
     return Resource<T, U>(this, key);
 }
 
-template<class T> void ResourceManagerData<T>::set(const ResourceKey key, T* const data, const ResourceDataState state, const ResourcePolicy policy) {
-    auto it = _data.find(key);
-
+template<class T> void ResourceManagerData<T>::set(const ResourceKey key, T* const data, const ResourceDataState state, const ResourcePolicy policy, const std::size_t size) {
     /* NotFound / Loading state shouldn't have any data */
     CORRADE_ASSERT((data == nullptr) == (state == ResourceDataState::NotFound || state == ResourceDataState::Loading),
         "ResourceManager::set(): data should be null if and only if state is NotFound or Loading", );
 
-    /* Cannot change resource with already final state */
-    CORRADE_ASSERT(it == _data.end() || it->second.state != ResourceDataState::Final,
-        "ResourceManager::set(): cannot change already final resource" << key, );
+    /* Resource instances don't check final data for changes, so they can't
+       be evicted */
+    CORRADE_ASSERT(policy != ResourcePolicy::Budgeted || state != ResourceDataState::Final,
+        "ResourceManager::set(): budgeted resource" << key << "can't be final", );
+
+    {
+        Shard& s = shard(key);
+        Lock lock{s.mutex};
+        auto it = s.data.find(key);
+
+        /* Cannot change resource with already final state */
+        CORRADE_ASSERT(it == s.data.end() || it->second.state != ResourceDataState::Final,
+            "ResourceManager::set(): cannot change already final resource" << key, );
+
+        /* Insert the resource, if not already there */
+        if(it == s.data.end())
+            it = s.data.emplace(std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple()).first;
+
+        /* Otherwise delete previous data */
+        else safeDelete(it->second.data);
+
+        it->second.data = data;
+        it->second.state = state;
+        it->second.policy = policy;
+        it->second.evicted = false;
+
+        /* Only budgeted resources with data count towards the budget */
+        _budgetUsage -= it->second.size;
+        it->second.size = policy == ResourcePolicy::Budgeted && data ? size : 0;
+        _budgetUsage += it->second.size;
+
+        /* Resources referencing this entry pick up the change on next access */
+        it->second.generation.fetch_add(1, std::memory_order_release);
+        ++_lastChange;
+        touch(it->second);
+    }
+
+    evict();
+}
+
+template<class T> void ResourceManagerData<T>::setBudget(const std::size_t budget) {
+    _budget = budget;
+    evict();
+}
+
+template<class T> void ResourceManagerData<T>::unload(const ResourceKey key) {
+    Shard& s = shard(key);
+    Lock lock{s.mutex};
+    auto it = s.data.find(key);
+    if(it == s.data.end() || !it->second.data) return;
 
-    /* Insert the resource, if not already there */
-    if(it == _data.end())
-        it = _data.emplace(key, Data()).first;
+    CORRADE_ASSERT(it->second.state != ResourceDataState::Final,
+        "ResourceManager::unload(): cannot unload final resource" << key, );
 
-    /* Otherwise delete previous data */
-    else safeDelete(it->second.data);
+    _budgetUsage -= it->second.size;
+
+    /* Not referenced, remove it altogether */
+    if(!it->second.referenceCount) {
+        s.data.erase(it);
+        return;
+    }
 
-    it->second.data = data;
-    it->second.state = state;
-    it->second.policy = policy;
-    ++_lastChange;
+    /* Otherwise keep the entry and let the next get() load it again */
+    safeDelete(it->second.data);
+    it->second.data = nullptr;
+    it->second.state = ResourceDataState::Mutable;
+    it->second.size = 0;
+    it->second.evicted = true;
+    it->second.generation.fetch_add(1, std::memory_order_release);
+}
+
+template<class T> void ResourceManagerData<T>::evict() {
+    if(_budgetUsage <= _budget) return;
+
+    /* Another thread is already evicting or we're called recursively from
+       set() inside the loader's doEvict() */
+    if(_evicting.exchange(true)) return;
+
+    /* Gather all budgeted resources, least recently used first. Each is
+       visited only once, so a loader replacing the resource with a smaller
+       version instead of unloading it doesn't cause an endless loop. */
+    std::vector<std::pair<std::size_t, ResourceKey>> candidates;
+    for(const Shard& s: _shards) {
+        Lock lock{s.mutex};
+        for(const auto& data: s.data)
+            if(data.second.size) candidates.emplace_back(data.second.lastUse.load(std::memory_order_relaxed), data.first);
+    }
+    std::sort(candidates.begin(), candidates.end(), [](const std::pair<std::size_t, ResourceKey>& a, const std::pair<std::size_t, ResourceKey>& b) {
+        return a.first < b.first;
+    });
+
+    /* The loader can be called without the lock, as it calls set() */
+    for(const std::pair<std::size_t, ResourceKey>& candidate: candidates) {
+        if(_budgetUsage <= _budget) break;
+        if(_loader) _loader->doEvict(candidate.second);
+        else unload(candidate.second);
+    }
+
+    _evicting = false;
 }
 
 template<class T> void ResourceManagerData<T>::setFallback(T* const data) {
@@ -562,10 +828,22 @@ template<class T> void ResourceManagerData<T>::setFallback(T* const data) {
 
 template<class T> void ResourceManagerData<T>::free() {
     /* Delete all non-referenced non-resident resources */
-    for(auto it = _data.begin(); it != _data.end(); ) {
-        if(it->second.policy != ResourcePolicy::Resident && !it->second.referenceCount)
-            it = _data.erase(it);
-        else ++it;
+    for(Shard& s: _shards) {
+        Lock lock{s.mutex};
+        for(auto it = s.data.begin(); it != s.data.end(); ) {
+            if(it->second.policy != ResourcePolicy::Resident && !it->second.referenceCount) {
+                _budgetUsage -= it->second.size;
+                it = s.data.erase(it);
+            } else ++it;
+        }
+    }
+}
+
+template<class T> void ResourceManagerData<T>::clear() {
+    for(Shard& s: _shards) {
+        Lock lock{s.mutex};
+        for(const auto& data: s.data) _budgetUsage -= data.second.size;
+        s.data.clear();
     }
 }
 
@@ -584,24 +862,50 @@ template<class T> void ResourceManagerData<T>::freeLoader() {
     delete _loader;
 }
 
-template<class T> void ResourceManagerData<T>::decrementReferenceCount(ResourceKey key) {
-    auto it = _data.find(key);
-    CORRADE_INTERNAL_ASSERT(it != _data.end());
+template<class T> auto ResourceManagerData<T>::acquireData(const ResourceKey key) -> Data& {
+    /* Incremented with the lock held so it can't race with the erase in
+       decrementReferenceCount() */
+    Shard& s = shard(key);
+    Lock lock{s.mutex};
+    Data& data = s.data[key];
+    data.referenceCount.fetch_add(1, std::memory_order_relaxed);
+    touch(data);
+    return data;
+}
+
+template<class T> inline void ResourceManagerData<T>::touch(Data& data) const {
+    /* Store only if it changed, to avoid writing the cache line on every
+       access */
+    const std::size_t now = _lastChange.load(std::memory_order_relaxed);
+    if(data.lastUse.load(std::memory_order_relaxed) != now)
+        data.lastUse.store(now, std::memory_order_relaxed);
+}
+
+template<class T> inline void ResourceManagerData<T>::incrementReferenceCount(Data& data) {
+    /* Only called when copying an existing reference, so the count can't be
+       zero and it can't get erased in the meantime */
+    data.referenceCount.fetch_add(1, std::memory_order_relaxed);
+}
 
-    /* Free the resource if it is reference counted */
-    if(--it->second.referenceCount == 0 && it->second.policy == ResourcePolicy::ReferenceCounted)
-        _data.erase(it);
+template<class T> void ResourceManagerData<T>::decrementReferenceCount(const ResourceKey key, Data& data) {
+    /* Not the last reference, nothing else to do */
+    if(data.referenceCount.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+
+    /* Free the resource if it is reference counted. Another thread might have
+       acquired and released it in the meantime, so look it up again instead
+       of touching `data`. */
+    Shard& s = shard(key);
+    Lock lock{s.mutex};
+    auto it = s.data.find(key);
+    if(it != s.data.end() && it->second.referenceCount == 0 && it->second.policy == ResourcePolicy::ReferenceCounted)
+        s.data.erase(it);
 }
 
 template<class T> struct ResourceManagerData<T>::Data {
-    Data(): data(nullptr), state(ResourceDataState::Mutable), policy(ResourcePolicy::Manual), referenceCount(0) {}
+    Data(): data(nullptr), state(ResourceDataState::Mutable), policy(ResourcePolicy::Manual), evicted(false), size(0), referenceCount(0), generation(0), lastUse(0) {}
 
     Data(const Data&) = delete;
-
-    Data(Data&& other): data(other.data), state(other.state), policy(other.policy), referenceCount(other.referenceCount) {
-        other.data = nullptr;
-        other.referenceCount = 0;
-    }
+    Data(Data&&) = delete;
 
     ~Data();
 
@@ -611,7 +915,11 @@ template<class T> struct ResourceManagerData<T>::Data {
     T* data;
     ResourceDataState state;
     ResourcePolicy policy;
-    std::size_t referenceCount;
+    bool evicted;
+    std::size_t size;
+    std::atomic<std::size_t> referenceCount;
+    std::atomic<std::size_t> generation;
+    std::atomic<std::size_t> lastUse;
 };
 
 template<class T> inline ResourceManagerData<T>::Data::~Data() {
@@ -0,0 +1,147 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ResourceRestoreCache.h"
+
+#include <cstring>
+#include <tuple>
+#include <Corrade/Utility/Directory.h>
+
+#include "Magnum/Implementation/mapFile.h"
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+#include "Magnum/AbstractShaderProgram.h"
+#endif
+
+namespace Magnum {
+
+namespace {
+
+/* Image files are the format and size followed by the data */
+struct ImageHeader {
+    UnsignedInt format;
+    Int width;
+    Int height;
+};
+
+static_assert(sizeof(ImageHeader) == 12, "improper size of image header");
+
+}
+
+ResourceRestoreCache::ResourceRestoreCache(std::string directory): _directory{std::move(directory)} {}
+
+ResourceRestoreCache::~ResourceRestoreCache() {
+    for(auto& entry: _entries) release(entry.second);
+}
+
+void ResourceRestoreCache::release(Entry& entry) {
+    if(entry.mapped) Implementation::unmapFile(entry.mapped, entry.mappedSize);
+    entry.mapped = nullptr;
+    entry.mappedSize = 0;
+    entry.read = nullptr;
+}
+
+bool ResourceRestoreCache::save(const std::string& key, const Containers::ArrayView<const void> data) {
+    if(data.empty()) return false;
+
+    if(!Utility::Directory::fileExists(_directory) && !Utility::Directory::mkpath(_directory))
+        return false;
+
+    /* Some platforms don't allow overwriting a mapped file, unmap it first */
+    auto found = _entries.find(key);
+    if(found != _entries.end()) {
+        release(found->second);
+        _entries.erase(found);
+    }
+
+    return Utility::Directory::write(Utility::Directory::join(_directory, key), data);
+}
+
+Containers::ArrayView<const char> ResourceRestoreCache::data(const std::string& key) {
+    auto found = _entries.find(key);
+    if(found == _entries.end()) {
+        const std::string filename = Utility::Directory::join(_directory, key);
+        if(!Utility::Directory::fileExists(filename)) return nullptr;
+
+        Entry entry;
+        std::tie(entry.mapped, entry.mappedSize) = Implementation::mapFile(filename);
+        if(!entry.mapped) {
+            entry.read = Utility::Directory::read(filename);
+            if(entry.read.empty()) return nullptr;
+        }
+
+        found = _entries.emplace(key, std::move(entry)).first;
+    }
+
+    const Entry& entry = found->second;
+    if(entry.mapped) return {entry.mapped, entry.mappedSize};
+    return {entry.read.data(), entry.read.size()};
+}
+
+bool ResourceRestoreCache::saveImage(const std::string& key, const CompressedImageView2D& image) {
+    if(image.data().empty()) return false;
+
+    const ImageHeader header{UnsignedInt(image.format()), image.size().x(), image.size().y()};
+    Containers::Array<char> file{sizeof(ImageHeader) + image.data().size()};
+    std::memcpy(file, &header, sizeof(ImageHeader));
+    std::memcpy(file + sizeof(ImageHeader), image.data(), image.data().size());
+    return save(key, Containers::ArrayView<const void>{file.data(), file.size()});
+}
+
+Containers::Optional<CompressedImageView2D> ResourceRestoreCache::image(const std::string& key) {
+    const Containers::ArrayView<const char> file = data(key);
+    if(file.size() <= sizeof(ImageHeader)) return Containers::NullOpt;
+
+    ImageHeader header;
+    std::memcpy(&header, file.data(), sizeof(ImageHeader));
+    return CompressedImageView2D{CompressedPixelFormat(header.format),
+        {header.width, header.height},
+        {file.data() + sizeof(ImageHeader), file.size() - sizeof(ImageHeader)}};
+}
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+bool ResourceRestoreCache::saveProgram(const std::string& key, AbstractShaderProgram& shader) {
+    const std::pair<GLenum, Containers::Array<char>> binary = shader.binary();
+    if(binary.second.empty()) return false;
+
+    /* The file is the format followed by the binary data */
+    Containers::Array<char> file{sizeof(UnsignedInt) + binary.second.size()};
+    const UnsignedInt format = binary.first;
+    std::memcpy(file, &format, sizeof(UnsignedInt));
+    std::memcpy(file + sizeof(UnsignedInt), binary.second, binary.second.size());
+    return save(key, Containers::ArrayView<const void>{file.data(), file.size()});
+}
+
+bool ResourceRestoreCache::restoreProgram(const std::string& key, AbstractShaderProgram& shader) {
+    const Containers::ArrayView<const char> file = data(key);
+    if(file.size() <= sizeof(UnsignedInt)) return false;
+
+    UnsignedInt format;
+    std::memcpy(&format, file.data(), sizeof(UnsignedInt));
+    return shader.setBinary(GLenum(format), {file.data() + sizeof(UnsignedInt), file.size() - sizeof(UnsignedInt)});
+}
+#endif
+
+}
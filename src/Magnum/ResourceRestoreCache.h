@@ -0,0 +1,201 @@
+#ifndef Magnum_ResourceRestoreCache_h
+#define Magnum_ResourceRestoreCache_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::ResourceRestoreCache
+ */
+
+#include <string>
+#include <unordered_map>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+
+#include "Magnum/ImageView.h"
+#include "Magnum/visibility.h"
+
+namespace Magnum {
+
+/**
+@brief Memory-mapped cache for restoring GPU resources
+
+Keeps CPU copies of already processed resource data in files in a directory,
+so they can be uploaded again quickly after the OpenGL context is lost or the
+application is restarted --- such as on Android, where the context may not
+survive the application going to background (see
+@ref Platform-AndroidApplication-resume). The files are memory-mapped on
+access, so restoring doesn't need any extra copies and the data don't occupy
+the application heap while not needed.
+
+Besides arbitrary data saved with @ref save() and retrieved with @ref data(),
+the cache has convenience functions for compressed images and, except for
+OpenGL ES 2.0 and WebGL, for program binaries:
+
+@code{.cpp}
+ResourceRestoreCache cache{Utility::Directory::join(dataDirectory, "restore")};
+
+Containers::Optional<CompressedImageView2D> image = cache.image("diffuse");
+if(!image) {
+    image = decodeAndCompressTheDiffuseTexture();
+    cache.saveImage("diffuse", *image);
+}
+texture.setCompressedImage(0, *image);
+
+if(!cache.restoreProgram("phong", shader)) {
+    compileAndLinkThePhongShader(shader);
+    cache.saveProgram("phong", shader);
+}
+@endcode
+
+Views returned from @ref data() and @ref image() stay valid until the cache
+is destroyed or the same key is saved again. If memory mapping is not
+available on given platform, the file is read into memory instead. Note that
+the program binary can still be rejected by the driver at any time, for
+example after a driver update, so always provide a fallback that compiles the
+program from sources. See @ref ShaderProgramCache for a cache that has the
+driver identification and shader sources in the key.
+*/
+class MAGNUM_EXPORT ResourceRestoreCache {
+    public:
+        /**
+         * @brief Constructor
+         * @param directory     Directory where to store the data
+         *
+         * The directory is created on first save, if it doesn't exist.
+         */
+        explicit ResourceRestoreCache(std::string directory);
+
+        /** @brief Copying is not allowed */
+        ResourceRestoreCache(const ResourceRestoreCache&) = delete;
+
+        /** @brief Moving is not allowed */
+        ResourceRestoreCache(ResourceRestoreCache&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Unmaps all data, invalidating all views returned from @ref data()
+         * and @ref image().
+         */
+        ~ResourceRestoreCache();
+
+        /** @brief Copying is not allowed */
+        ResourceRestoreCache& operator=(const ResourceRestoreCache&) = delete;
+
+        /** @brief Moving is not allowed */
+        ResourceRestoreCache& operator=(ResourceRestoreCache&&) = delete;
+
+        /** @brief Cache directory */
+        std::string directory() const { return _directory; }
+
+        /**
+         * @brief Save data
+         *
+         * Saves @p data under given @p key, replacing the previous entry.
+         * Views to the previous entry returned from @ref data() or
+         * @ref image() are invalidated. Returns @cpp false @ce if @p data
+         * are empty or the file can't be written, @cpp true @ce otherwise.
+         */
+        bool save(const std::string& key, Containers::ArrayView<const void> data);
+
+        /**
+         * @brief Data
+         *
+         * Returns data saved under given @p key, mapping the file on first
+         * access. If there's no such entry, returns an empty view.
+         */
+        Containers::ArrayView<const char> data(const std::string& key);
+
+        /**
+         * @brief Save compressed image
+         *
+         * Saves format, size and data of the image under given @p key. See
+         * @ref save() for more information.
+         */
+        bool saveImage(const std::string& key, const CompressedImageView2D& image);
+
+        /**
+         * @brief Compressed image
+         *
+         * Returns image saved with @ref saveImage() under given @p key,
+         * pointing to the mapped data. If there's no such entry or the
+         * entry is not an image, returns @ref Containers::NullOpt.
+         */
+        Containers::Optional<CompressedImageView2D> image(const std::string& key);
+
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        /**
+         * @brief Save program binary
+         *
+         * Retrieves binary of linked @p shader using
+         * @ref AbstractShaderProgram::binary() and saves it under given
+         * @p key. The program has to have
+         * @ref AbstractShaderProgram::setRetrievableBinary() enabled before
+         * linking. Returns @cpp false @ce if the binary is empty or the file
+         * can't be written, @cpp true @ce otherwise.
+         * @requires_gl41 Extension @extension{ARB,get_program_binary}
+         * @requires_gles30 Extension @extension{OES,get_program_binary} is
+         *      not supported in OpenGL ES 2.0.
+         * @requires_gles Binary program representations are not supported
+         *      in WebGL.
+         */
+        bool saveProgram(const std::string& key, AbstractShaderProgram& shader);
+
+        /**
+         * @brief Restore program binary
+         *
+         * Uploads binary saved with @ref saveProgram() under given @p key to
+         * @p shader using @ref AbstractShaderProgram::setBinary(). Returns
+         * @cpp false @ce if there's no such entry or the driver rejected the
+         * binary, in which case the program needs to be compiled and linked
+         * from sources.
+         * @requires_gl41 Extension @extension{ARB,get_program_binary}
+         * @requires_gles30 Extension @extension{OES,get_program_binary} is
+         *      not supported in OpenGL ES 2.0.
+         * @requires_gles Binary program representations are not supported
+         *      in WebGL.
+         */
+        bool restoreProgram(const std::string& key, AbstractShaderProgram& shader);
+        #endif
+
+    private:
+        struct Entry {
+            /* Either a mapping or, if mapping is not available, the file
+               contents */
+            const char* mapped{};
+            std::size_t mappedSize{};
+            Containers::Array<char> read;
+        };
+
+        void release(Entry& entry);
+
+        std::string _directory;
+        std::unordered_map<std::string, Entry> _entries;
+};
+
+}
+
+#endif
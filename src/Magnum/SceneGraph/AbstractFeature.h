@@ -42,10 +42,8 @@ namespace Magnum { namespace SceneGraph {
 
 @see @ref scenegraph-features-caching, @ref CachedTransformations,
     @ref AbstractFeature::setCachedTransformations(), @ref AbstractFeature::clean(),
-    @ref AbstractFeature::cleanInverted()
-@todo Provide also simpler representations from which could benefit
-    other transformation implementations, as they won't need to
-    e.g. create transformation matrix from quaternion?
+    @ref AbstractFeature::cleanInverted(),
+    @ref AbstractFeature::cleanTranslation(), @ref AbstractFeature::cleanRigid()
  */
 enum class CachedTransformation: UnsignedByte {
     /**
@@ -62,7 +60,32 @@ enum class CachedTransformation: UnsignedByte {
      * If enabled, @ref AbstractFeature::cleanInverted() is called when
      * cleaning object.
      */
-    InvertedAbsolute = 1 << 1
+    InvertedAbsolute = 1 << 1,
+
+    /**
+     * Absolute transformation is cached as a translation.
+     *
+     * If enabled and the object uses @ref TranslationTransformation,
+     * @ref AbstractFeature::cleanTranslation() is called instead of
+     * @ref AbstractFeature::clean() when cleaning object, avoiding the
+     * conversion to a transformation matrix. Ignored for other
+     * transformation implementations, so it's usually combined with
+     * @ref CachedTransformation::Absolute.
+     */
+    AbsoluteTranslation = 1 << 2,
+
+    /**
+     * Absolute transformation is cached as a dual complex number or dual
+     * quaternion.
+     *
+     * If enabled and the object uses @ref DualComplexTransformation or
+     * @ref DualQuaternionTransformation, @ref AbstractFeature::cleanRigid() is
+     * called instead of @ref AbstractFeature::clean() when cleaning object,
+     * avoiding the conversion to a transformation matrix. Ignored for other
+     * transformation implementations, so it's usually combined with
+     * @ref CachedTransformation::Absolute.
+     */
+    AbsoluteRigid = 1 << 3
 };
 
 /**
@@ -75,6 +98,22 @@ typedef Containers::EnumSet<CachedTransformation> CachedTransformations;
 
 CORRADE_ENUMSET_OPERATORS(CachedTransformations)
 
+namespace Implementation {
+    template<UnsignedInt, class> struct RigidTransformation;
+    template<class T> struct RigidTransformation<2, T> { typedef Math::DualComplex<T> Type; };
+    template<class T> struct RigidTransformation<3, T> { typedef Math::DualQuaternion<T> Type; };
+
+    template<class> struct FeatureCleaner;
+}
+
+/**
+@brief Rigid transformation type for given dimension count
+
+@ref Math::DualComplex in 2D, @ref Math::DualQuaternion in 3D. Used by
+@ref AbstractFeature::cleanRigid().
+*/
+template<UnsignedInt dimensions, class T> using RigidTransformationTypeFor = typename Implementation::RigidTransformation<dimensions, T>::Type;
+
 /**
 @brief Base for object features
 
@@ -273,6 +312,37 @@ template<UnsignedInt dimensions, class T> class AbstractFeature
          */
         virtual void cleanInverted(const MatrixTypeFor<dimensions, T>& invertedAbsoluteTransformationMatrix);
 
+        /**
+         * @brief Clean data based on absolute translation
+         *
+         * When object using @ref TranslationTransformation is cleaned and
+         * @ref CachedTransformation::AbsoluteTranslation is enabled in
+         * @ref setCachedTransformations(), this function is called instead of
+         * @ref clean() to recalculate data based on absolute object
+         * translation.
+         *
+         * Default implementation calls @ref clean() with a translation
+         * matrix.
+         * @see @ref scenegraph-features-caching, @ref cleanRigid()
+         */
+        virtual void cleanTranslation(const VectorTypeFor<dimensions, T>& absoluteTranslation);
+
+        /**
+         * @brief Clean data based on absolute rigid transformation
+         *
+         * When object using @ref DualComplexTransformation or
+         * @ref DualQuaternionTransformation is cleaned and
+         * @ref CachedTransformation::AbsoluteRigid is enabled in
+         * @ref setCachedTransformations(), this function is called instead of
+         * @ref clean() to recalculate data based on absolute object
+         * transformation.
+         *
+         * Default implementation calls @ref clean() with the transformation
+         * converted to a matrix.
+         * @see @ref scenegraph-features-caching, @ref cleanTranslation()
+         */
+        virtual void cleanRigid(const RigidTransformationTypeFor<dimensions, T>& absoluteTransformation);
+
         /*@}*/
 
     private:
@@ -280,6 +350,7 @@ template<UnsignedInt dimensions, class T> class AbstractFeature
         friend Containers::LinkedList<AbstractFeature<dimensions, T>>;
         friend Containers::LinkedListItem<AbstractFeature<dimensions, T>, AbstractObject<dimensions, T>>;
         template<class> friend class Object;
+        template<class> friend struct Implementation::FeatureCleaner;
         #endif
 
         CachedTransformations _cachedTransformations;
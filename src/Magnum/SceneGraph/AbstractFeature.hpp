@@ -29,6 +29,8 @@
  * @brief @ref compilation-speedup-hpp "Template implementation" for @ref AbstractFeature.h
  */
 
+#include "Magnum/Math/DualComplex.h"
+#include "Magnum/Math/DualQuaternion.h"
 #include "Magnum/SceneGraph/AbstractFeature.h"
 
 namespace Magnum { namespace SceneGraph {
@@ -45,6 +47,14 @@ template<UnsignedInt dimensions, class T> void AbstractFeature<dimensions, T>::c
 
 template<UnsignedInt dimensions, class T> void AbstractFeature<dimensions, T>::cleanInverted(const MatrixTypeFor<dimensions, T>&) {}
 
+template<UnsignedInt dimensions, class T> void AbstractFeature<dimensions, T>::cleanTranslation(const VectorTypeFor<dimensions, T>& absoluteTranslation) {
+    clean(MatrixTypeFor<dimensions, T>::translation(absoluteTranslation));
+}
+
+template<UnsignedInt dimensions, class T> void AbstractFeature<dimensions, T>::cleanRigid(const RigidTransformationTypeFor<dimensions, T>& absoluteTransformation) {
+    clean(absoluteTransformation.toMatrix());
+}
+
 }}
 
 #endif
@@ -31,6 +31,7 @@
 
 #include <functional>
 #include <vector>
+#include <Corrade/Containers/ArrayView.h>
 #include <Corrade/Containers/LinkedList.h>
 
 #include "Magnum/DimensionTraits.h"
@@ -174,6 +175,33 @@ template<UnsignedInt dimensions, class T> class AbstractObject
             return doTransformationMatrices(objects, initialTransformationMatrix);
         }
 
+        /**
+         * @brief Transformation matrices of given set of objects relative to this object into existing storage
+         *
+         * Size of @p out is expected to be the same as size of @p objects.
+         * See @ref Object::transformationMatrices(const std::vector<std::reference_wrapper<Object<Transformation>>>&, Containers::ArrayView<MatrixType>, const MatrixType&) const
+         * for more information.
+         * @warning This function cannot check if all objects are of the same
+         *      @ref Object type, use typesafe @ref Object::transformationMatrices()
+         *      when possible.
+         */
+        void transformationMatrices(const std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>>& objects, Containers::ArrayView<MatrixType> out, const MatrixType& initialTransformationMatrix = MatrixType()) const {
+            doTransformationMatrices(objects, out, initialTransformationMatrix, nullptr);
+        }
+
+        /**
+         * @brief Transformation matrices of given set of objects relative to this object computed in parallel
+         *
+         * See @ref Object::transformationMatrices(const std::vector<std::reference_wrapper<Object<Transformation>>>&, Containers::ArrayView<MatrixType>, const MatrixType&, ThreadPool&) const
+         * for more information.
+         * @warning This function cannot check if all objects are of the same
+         *      @ref Object type, use typesafe @ref Object::transformationMatrices()
+         *      when possible.
+         */
+        void transformationMatrices(const std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>>& objects, Containers::ArrayView<MatrixType> out, const MatrixType& initialTransformationMatrix, ThreadPool& pool) const {
+            doTransformationMatrices(objects, out, initialTransformationMatrix, &pool);
+        }
+
         /*@}*/
 
         /**
@@ -192,7 +220,21 @@ template<UnsignedInt dimensions, class T> class AbstractObject
          */
         static void setClean(const std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>>& objects) {
             if(objects.empty()) return;
-            objects.front().get().doSetClean(objects);
+            objects.front().get().doSetClean(objects, nullptr);
+        }
+
+        /**
+         * @brief Clean absolute transformations of given set of objects in parallel
+         *
+         * See @ref Object::setClean(std::vector<std::reference_wrapper<Object<Transformation>>>, ThreadPool&)
+         * for more information.
+         * @warning This function cannot check if all objects are of the same
+         *      @ref Object type, use typesafe @ref Object::setClean() when
+         *      possible.
+         */
+        static void setClean(const std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>>& objects, ThreadPool& pool) {
+            if(objects.empty()) return;
+            objects.front().get().doSetClean(objects, &pool);
         }
 
         /**
@@ -251,11 +293,12 @@ template<UnsignedInt dimensions, class T> class AbstractObject
         virtual MatrixType doTransformationMatrix() const = 0;
         virtual MatrixType doAbsoluteTransformationMatrix() const = 0;
         virtual std::vector<MatrixType> doTransformationMatrices(const std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>>& objects, const MatrixType& initialTransformationMatrix) const = 0;
+        virtual void doTransformationMatrices(const std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>>& objects, Containers::ArrayView<MatrixType> out, const MatrixType& initialTransformationMatrix, ThreadPool* pool) const = 0;
 
         virtual bool doIsDirty() const = 0;
         virtual void doSetDirty() = 0;
         virtual void doSetClean() = 0;
-        virtual void doSetClean(const std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>>& objects) = 0;
+        virtual void doSetClean(const std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>>& objects, ThreadPool* pool) = 0;
 };
 
 /**
@@ -29,6 +29,8 @@
  * @brief @ref compilation-speedup-hpp "Template implementation" for @ref Animable.h and @ref AnimableGroup.h
  */
 
+#include <algorithm>
+
 #include "Magnum/Timeline.h"
 #include "Magnum/Math/Constants.h"
 #include "Magnum/SceneGraph/AnimableGroup.h"
@@ -66,79 +68,116 @@ template<UnsignedInt dimensions, class T> const AnimableGroup<dimensions, T>* An
     return static_cast<const AnimableGroup<dimensions, T>*>(AbstractGroupedFeature<dimensions, Animable<dimensions, T>, T>::group());
 }
 
+template<UnsignedInt dimensions, class T> bool AnimableGroup<dimensions, T>::updateState(Animable<dimensions, T>& animable, const Float time) {
+    /* The animation was stopped recently, just decrease count of running
+       animations if the animation was running before */
+    if(animable._previousState != AnimationState::Stopped && animable._currentState == AnimationState::Stopped) {
+        if(animable._previousState == AnimationState::Running)
+            --_runningCount;
+        animable._previousState = AnimationState::Stopped;
+        animable.animationStopped();
+        return false;
+
+    /* The animation was paused recently, set pause time to previous frame time */
+    } else if(animable._previousState == AnimationState::Running && animable._currentState == AnimationState::Paused) {
+        animable._previousState = AnimationState::Paused;
+        animable._pauseTime = time;
+        --_runningCount;
+        animable.animationPaused();
+        return false;
+
+    /* Skip the rest for not running animations */
+    } else if(animable._currentState != AnimationState::Running) {
+        CORRADE_INTERNAL_ASSERT(animable._previousState == animable._currentState);
+        return false;
+
+    /* The animation was started recently, set start time to previous frame
+       time, reset repeat count */
+    } else if(animable._previousState == AnimationState::Stopped) {
+        animable._previousState = AnimationState::Running;
+        animable._startTime = time;
+        animable._repeats = 0;
+        ++_runningCount;
+        animable.animationStarted();
+
+    /* The animation was resumed recently, add pause duration to start time */
+    } else if(animable._previousState == AnimationState::Paused) {
+        animable._previousState = AnimationState::Running;
+        animable._startTime += time - animable._pauseTime;
+        ++_runningCount;
+        animable.animationResumed();
+    }
+
+    CORRADE_INTERNAL_ASSERT(animable._previousState == AnimationState::Running);
+
+    /* Animation time exceeded duration */
+    if(animable._duration != 0.0f && time-animable._startTime > animable._duration) {
+        /* Not repeated or repeat count exceeded, stop */
+        if(!animable._repeated || animable._repeats + 1 == animable._repeatCount) {
+            animable._previousState = AnimationState::Stopped;
+            animable._currentState = AnimationState::Stopped;
+            --_runningCount;
+            animable.animationStopped();
+            return false;
+        }
+
+        /* Increase repeat count and add duration to startTime */
+        ++animable._repeats;
+        animable._startTime += animable._duration;
+    }
+
+    /* Animation is still running, animation step should be performed */
+    CORRADE_ASSERT(time - animable._startTime >= 0.0f,
+        "SceneGraph::AnimableGroup::step(): animation was started in future - probably wrong time passed", false);
+    return true;
+}
+
 template<UnsignedInt dimensions, class T> void AnimableGroup<dimensions, T>::step(const Float time, const Float delta) {
     if(!_runningCount && !wakeUp) return;
     wakeUp = false;
 
+    CORRADE_ASSERT(delta >= 0.0f,
+        "SceneGraph::AnimableGroup::step(): negative delta passed", );
+
     for(std::size_t i = 0; i != AnimableGroup<dimensions, T>::size(); ++i) {
         Animable<dimensions, T>& animable = (*this)[i];
+        if(updateState(animable, time))
+            animable.animationStep(time - animable._startTime, delta);
+    }
 
-        /* The animation was stopped recently, just decrease count of running
-           animations if the animation was running before */
-        if(animable._previousState != AnimationState::Stopped && animable._currentState == AnimationState::Stopped) {
-            if(animable._previousState == AnimationState::Running)
-                --_runningCount;
-            animable._previousState = AnimationState::Stopped;
-            animable.animationStopped();
-            continue;
+    CORRADE_INTERNAL_ASSERT((_runningCount <= AnimableGroup<dimensions, T>::size()));
+}
 
-        /* The animation was paused recently, set pause time to previous frame time */
-        } else if(animable._previousState == AnimationState::Running && animable._currentState == AnimationState::Paused) {
-            animable._previousState = AnimationState::Paused;
-            animable._pauseTime = time;
-            --_runningCount;
-            animable.animationPaused();
-            continue;
-
-        /* Skip the rest for not running animations */
-        } else if(animable._currentState != AnimationState::Running) {
-            CORRADE_INTERNAL_ASSERT(animable._previousState == animable._currentState);
-            continue;
-
-        /* The animation was started recently, set start time to previous frame
-           time, reset repeat count */
-        } else if(animable._previousState == AnimationState::Stopped) {
-            animable._previousState = AnimationState::Running;
-            animable._startTime = time;
-            animable._repeats = 0;
-            ++_runningCount;
-            animable.animationStarted();
-
-        /* The animation was resumed recently, add pause duration to start time */
-        } else if(animable._previousState == AnimationState::Paused) {
-            animable._previousState = AnimationState::Running;
-            animable._startTime += time - animable._pauseTime;
-            ++_runningCount;
-            animable.animationResumed();
-        }
+template<UnsignedInt dimensions, class T> void AnimableGroup<dimensions, T>::step(const Float time, const Float delta, ThreadPool& pool, const ThreadPool::Schedule schedule) {
+    if(!_runningCount && !wakeUp) return;
+    wakeUp = false;
 
-        CORRADE_INTERNAL_ASSERT(animable._previousState == AnimationState::Running);
-
-        /* Animation time exceeded duration */
-        if(animable._duration != 0.0f && time-animable._startTime > animable._duration) {
-            /* Not repeated or repeat count exceeded, stop */
-            if(!animable._repeated || animable._repeats + 1 == animable._repeatCount) {
-                animable._previousState = AnimationState::Stopped;
-                animable._currentState = AnimationState::Stopped;
-                --_runningCount;
-                animable.animationStopped();
-                continue;
-            }
-
-            /* Increase repeat count and add duration to startTime */
-            ++animable._repeats;
-            animable._startTime += animable._duration;
-        }
+    CORRADE_ASSERT(delta >= 0.0f,
+        "SceneGraph::AnimableGroup::step(): negative delta passed", );
 
-        /* Animation is still running, perform animation step */
-        CORRADE_ASSERT(time - animable._startTime >= 0.0f,
-            "SceneGraph::AnimableGroup::step(): animation was started in future - probably wrong time passed", );
-        CORRADE_ASSERT(delta >= 0.0f,
-            "SceneGraph::AnimableGroup::step(): negative delta passed", );
-        animable.animationStep(time - animable._startTime, delta);
+    /* State changes and the started/stopped/paused/resumed callbacks are
+       processed serially and in order, the same as in the serial variant */
+    _stepped.clear();
+    for(std::size_t i = 0; i != AnimableGroup<dimensions, T>::size(); ++i) {
+        Animable<dimensions, T>& animable = (*this)[i];
+        if(updateState(animable, time)) _stepped.push_back(&animable);
     }
 
     CORRADE_INTERNAL_ASSERT((_runningCount <= AnimableGroup<dimensions, T>::size()));
+
+    /* Mark all objects dirty upfront. Setting a transformation of an already
+       dirty object then doesn't touch anything else than the object itself,
+       so the steps can be safely performed in parallel. */
+    for(Animable<dimensions, T>* animable: _stepped)
+        animable->object().setDirty();
+
+    /* Small enough chunks to balance uneven steps across the threads, but big
+       enough to make the scheduling overhead negligible */
+    const std::size_t chunkSize = std::max(std::size_t{1}, _stepped.size()/(pool.threadCount()*4));
+    pool.parallelFor(_stepped.size(), chunkSize, [this, time, delta](const std::size_t begin, const std::size_t end) {
+        for(std::size_t i = begin; i != end; ++i)
+            _stepped[i]->animationStep(time - _stepped[i]->_startTime, delta);
+    }, schedule);
 }
 
 }}
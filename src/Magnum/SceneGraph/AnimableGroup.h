@@ -29,6 +29,9 @@
  * @brief Class @ref Magnum::SceneGraph::AnimableGroup, alias @ref Magnum::SceneGraph::BasicAnimableGroup2D, @ref Magnum::SceneGraph::BasicAnimableGroup3D, typedef @ref Magnum::SceneGraph::AnimableGroup2D, @ref Magnum::SceneGraph::AnimableGroup3D
  */
 
+#include <vector>
+
+#include "Magnum/ThreadPool.h"
 #include "Magnum/SceneGraph/FeatureGroup.h"
 #include "Magnum/SceneGraph/visibility.h"
 
@@ -67,9 +70,37 @@ template<UnsignedInt dimensions, class T> class AnimableGroup: public FeatureGro
          */
         void step(Float time, Float delta);
 
+        /**
+         * @brief Perform animation step in parallel
+         * @param time      Absolute time (e.g. @ref Timeline::previousFrameTime())
+         * @param delta     Time delta for current frame (e.g. @ref Timeline::previousFrameDuration())
+         * @param pool      Thread pool to use
+         * @param schedule  Scheduling of the animation steps
+         *
+         * Animation state changes and the @ref Animable::animationStarted(),
+         * @ref Animable::animationStopped(), @ref Animable::animationPaused()
+         * and @ref Animable::animationResumed() callbacks are processed
+         * serially on the calling thread, the same as in
+         * @ref step(Float, Float). Objects of all animables that are running
+         * are then marked as dirty and their @ref Animable::animationStep()
+         * is called concurrently using @ref ThreadPool::parallelFor().
+         *
+         * The @ref Animable::animationStep() implementation is allowed to
+         * change only transformation of its own object and mustn't access
+         * any other object in the scene. Each animable in the group has to be
+         * attached to a different object. With @ref ThreadPool::Schedule::Static
+         * the animables are always distributed to the same threads for the
+         * same group and thread count, which is useful for replaying
+         * recorded runs.
+         */
+        void step(Float time, Float delta, ThreadPool& pool, ThreadPool::Schedule schedule = ThreadPool::Schedule::Dynamic);
+
     private:
+        bool updateState(Animable<dimensions, T>& animable, Float time);
+
         std::size_t _runningCount;
         bool wakeUp;
+        std::vector<Animable<dimensions, T>*> _stepped;
 };
 
 /**
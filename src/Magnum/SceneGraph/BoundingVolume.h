@@ -0,0 +1,169 @@
+#ifndef Magnum_SceneGraph_BoundingVolume_h
+#define Magnum_SceneGraph_BoundingVolume_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::BoundingVolume, alias @ref Magnum::SceneGraph::BasicBoundingVolume2D, @ref Magnum::SceneGraph::BasicBoundingVolume3D, typedef @ref Magnum::SceneGraph::BoundingVolume2D, @ref Magnum::SceneGraph::BoundingVolume3D
+ */
+
+#include "Magnum/DimensionTraits.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/SceneGraph/AbstractGroupedFeature.h"
+#include "Magnum/SceneGraph/visibility.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Bounding volume
+
+Axis-aligned bounding box of an object, indexed by a
+@ref BoundingVolumeHierarchy. The box is specified in the local coordinate
+system of the object, the hierarchy keeps the absolute boxes in sync with the
+object transformations using the @ref scenegraph-features-caching "transformation caching"
+mechanism --- only objects that were marked as dirty are refitted when the
+hierarchy is updated.
+
+@code{.cpp}
+SceneGraph::BoundingVolumeHierarchy3D hierarchy;
+
+Object3D* object = new Object3D{&scene};
+new SceneGraph::BoundingVolume3D{*object, {{-1.0f, -1.0f, -1.0f}, {1.0f, 1.0f, 1.0f}}, &hierarchy};
+
+// ...
+for(SceneGraph::BoundingVolume3D* volume: hierarchy.rayQuery(origin, direction)) {
+    // ...
+}
+@endcode
+
+@section SceneGraph-BoundingVolume-explicit-specializations Explicit template specializations
+
+The following specializations are explicitly compiled into @ref SceneGraph
+library. For other specializations (e.g. using @ref Magnum::Double "Double"
+type) you have to use @ref BoundingVolume.hpp implementation file to avoid
+linker errors. See also @ref compilation-speedup-hpp for more information.
+
+-   @ref BoundingVolume2D
+-   @ref BoundingVolume3D
+
+@see @ref scenegraph, @ref BasicBoundingVolume2D, @ref BasicBoundingVolume3D,
+    @ref BoundingVolume2D, @ref BoundingVolume3D, @ref BoundingVolumeHierarchy
+*/
+template<UnsignedInt dimensions, class T> class BoundingVolume: public AbstractGroupedFeature<dimensions, BoundingVolume<dimensions, T>, T> {
+    friend BoundingVolumeHierarchy<dimensions, T>;
+
+    public:
+        /**
+         * @brief Constructor
+         * @param object    Object this bounding volume belongs to
+         * @param box       Bounding box in local coordinate system of the
+         *      object
+         * @param hierarchy Hierarchy this bounding volume belongs to
+         *
+         * Adds the feature to the object and also to the hierarchy, if
+         * specified. Otherwise you can use @ref BoundingVolumeHierarchy::add().
+         */
+        explicit BoundingVolume(AbstractObject<dimensions, T>& object, const RangeTypeFor<dimensions, T>& box, BoundingVolumeHierarchy<dimensions, T>* hierarchy = nullptr);
+
+        /**
+         * @brief Hierarchy containing this bounding volume
+         *
+         * If the bounding volume doesn't belong to any hierarchy, returns
+         * @cpp nullptr @ce.
+         */
+        BoundingVolumeHierarchy<dimensions, T>* hierarchy();
+
+        /** @overload */
+        const BoundingVolumeHierarchy<dimensions, T>* hierarchy() const;
+
+        /** @brief Bounding box in local coordinate system of the object */
+        RangeTypeFor<dimensions, T> box() const { return _box; }
+
+        /**
+         * @brief Set bounding box
+         * @return Reference to self (for method chaining)
+         *
+         * The absolute box gets recalculated on next
+         * @ref BoundingVolumeHierarchy::update().
+         */
+        BoundingVolume<dimensions, T>& setBox(const RangeTypeFor<dimensions, T>& box);
+
+        /**
+         * @brief Absolute bounding box
+         *
+         * Axis-aligned box enclosing @ref box() transformed with absolute
+         * object transformation. Up-to-date only after
+         * @ref BoundingVolumeHierarchy::update() was called.
+         */
+        RangeTypeFor<dimensions, T> absoluteBox() const { return _absoluteBox; }
+
+    private:
+        void markDirty() override;
+        void clean(const MatrixTypeFor<dimensions, T>& absoluteTransformationMatrix) override;
+
+        RangeTypeFor<dimensions, T> _box, _absoluteBox;
+        UnsignedInt _leaf;
+        bool _changed;
+};
+
+/**
+@brief Bounding volume for two-dimensional scenes
+
+Convenience alternative to @cpp BoundingVolume<2, T> @ce. See
+@ref BoundingVolume for more information.
+@see @ref BoundingVolume2D, @ref BasicBoundingVolume3D
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<class T> using BasicBoundingVolume2D = BoundingVolume<2, T>;
+#endif
+
+/**
+@brief Bounding volume for two-dimensional float scenes
+
+@see @ref BoundingVolume3D
+*/
+typedef BasicBoundingVolume2D<Float> BoundingVolume2D;
+
+/**
+@brief Bounding volume for three-dimensional scenes
+
+Convenience alternative to @cpp BoundingVolume<3, T> @ce. See
+@ref BoundingVolume for more information.
+@see @ref BoundingVolume3D, @ref BasicBoundingVolume2D
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<class T> using BasicBoundingVolume3D = BoundingVolume<3, T>;
+#endif
+
+/**
+@brief Bounding volume for three-dimensional float scenes
+
+@see @ref BoundingVolume2D
+*/
+typedef BasicBoundingVolume3D<Float> BoundingVolume3D;
+
+}}
+
+#endif
@@ -0,0 +1,359 @@
+#ifndef Magnum_SceneGraph_BoundingVolume_hpp
+#define Magnum_SceneGraph_BoundingVolume_hpp
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief @ref compilation-speedup-hpp "Template implementation" for @ref BoundingVolume.h and @ref BoundingVolumeHierarchy.h
+ */
+
+#include <algorithm>
+#include <utility>
+
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Geometry/Intersection.h"
+#include "Magnum/SceneGraph/AbstractObject.h"
+#include "Magnum/SceneGraph/BoundingVolume.h"
+#include "Magnum/SceneGraph/BoundingVolumeHierarchy.h"
+
+namespace Magnum { namespace SceneGraph {
+
+namespace Implementation {
+
+/* Math::join() ignores zero-size ranges, which are valid bounding volumes
+   here */
+template<UnsignedInt dimensions, class T> inline Math::Range<dimensions, T> unite(const Math::Range<dimensions, T>& a, const Math::Range<dimensions, T>& b) {
+    return {Math::min(a.min(), b.min()), Math::max(a.max(), b.max())};
+}
+
+template<UnsignedInt dimensions, class T> RangeTypeFor<dimensions, T> transformBox(const MatrixTypeFor<dimensions, T>& transformationMatrix, const RangeTypeFor<dimensions, T>& box) {
+    const VectorTypeFor<dimensions, T> first = transformationMatrix.transformPoint(box.min());
+    VectorTypeFor<dimensions, T> min = first, max = first;
+    for(UnsignedByte c = 1; c != (1 << dimensions); ++c) {
+        const VectorTypeFor<dimensions, T> corner = transformationMatrix.transformPoint(Math::lerp(box.min(), box.max(), Math::BoolVector<dimensions>{c}));
+        min = Math::min(min, corner);
+        max = Math::max(max, corner);
+    }
+
+    return {min, max};
+}
+
+template<UnsignedInt dimensions, class T> inline bool boxBox(const RangeTypeFor<dimensions, T>& a, const RangeTypeFor<dimensions, T>& b) {
+    return (a.min() <= b.max()).all() && (a.max() >= b.min()).all();
+}
+
+template<UnsignedInt dimensions, class T> bool sphereBox(const VectorTypeFor<dimensions, T>& center, const T radiusSquared, const RangeTypeFor<dimensions, T>& box) {
+    T distanceSquared{};
+    for(std::size_t i = 0; i != dimensions; ++i) {
+        if(center[i] < box.min()[i])
+            distanceSquared += Math::pow<2>(box.min()[i] - center[i]);
+        else if(center[i] > box.max()[i])
+            distanceSquared += Math::pow<2>(center[i] - box.max()[i]);
+    }
+
+    return distanceSquared <= radiusSquared;
+}
+
+/* Slab test. Zero direction components give infinite inverse direction; the
+   NaN resulting from origin lying exactly on the slab boundary fails all
+   comparisons and thus doesn't affect the result. */
+template<UnsignedInt dimensions, class T> bool rayBox(const VectorTypeFor<dimensions, T>& origin, const VectorTypeFor<dimensions, T>& inverseDirection, const RangeTypeFor<dimensions, T>& box, T& entry) {
+    T near{}, far = Math::Constants<T>::inf();
+    for(std::size_t i = 0; i != dimensions; ++i) {
+        T a = (box.min()[i] - origin[i])*inverseDirection[i];
+        T b = (box.max()[i] - origin[i])*inverseDirection[i];
+        if(a > b) std::swap(a, b);
+        if(a > near) near = a;
+        if(b < far) far = b;
+    }
+
+    entry = near;
+    return near <= far;
+}
+
+template<class T> inline bool boxFrustum(const Math::Range2D<T>& box, const Math::Frustum<T>& frustum) {
+    return Math::Geometry::Intersection::boxFrustum(Math::Range3D<T>{{box.min(), T(0)}, {box.max(), T(0)}}, frustum);
+}
+
+template<class T> inline bool boxFrustum(const Math::Range3D<T>& box, const Math::Frustum<T>& frustum) {
+    return Math::Geometry::Intersection::boxFrustum(box, frustum);
+}
+
+}
+
+template<UnsignedInt dimensions, class T> BoundingVolume<dimensions, T>::BoundingVolume(AbstractObject<dimensions, T>& object, const RangeTypeFor<dimensions, T>& box, BoundingVolumeHierarchy<dimensions, T>* hierarchy): AbstractGroupedFeature<dimensions, BoundingVolume<dimensions, T>, T>{object}, _box{box}, _leaf{~UnsignedInt{}}, _changed{false} {
+    AbstractFeature<dimensions, T>::setCachedTransformations(CachedTransformation::Absolute);
+    if(hierarchy) hierarchy->add(*this);
+}
+
+template<UnsignedInt dimensions, class T> BoundingVolumeHierarchy<dimensions, T>* BoundingVolume<dimensions, T>::hierarchy() {
+    return static_cast<BoundingVolumeHierarchy<dimensions, T>*>(AbstractGroupedFeature<dimensions, BoundingVolume<dimensions, T>, T>::group());
+}
+
+template<UnsignedInt dimensions, class T> const BoundingVolumeHierarchy<dimensions, T>* BoundingVolume<dimensions, T>::hierarchy() const {
+    return static_cast<const BoundingVolumeHierarchy<dimensions, T>*>(AbstractGroupedFeature<dimensions, BoundingVolume<dimensions, T>, T>::group());
+}
+
+template<UnsignedInt dimensions, class T> BoundingVolume<dimensions, T>& BoundingVolume<dimensions, T>::setBox(const RangeTypeFor<dimensions, T>& box) {
+    _box = box;
+    _absoluteBox = Implementation::transformBox<dimensions, T>(this->object().absoluteTransformationMatrix(), box);
+    _changed = true;
+    if(hierarchy()) hierarchy()->_dirty = true;
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> void BoundingVolume<dimensions, T>::markDirty() {
+    if(hierarchy()) hierarchy()->_dirty = true;
+}
+
+template<UnsignedInt dimensions, class T> void BoundingVolume<dimensions, T>::clean(const MatrixTypeFor<dimensions, T>& absoluteTransformationMatrix) {
+    _absoluteBox = Implementation::transformBox<dimensions, T>(absoluteTransformationMatrix, _box);
+    _changed = true;
+}
+
+template<UnsignedInt dimensions, class T> BoundingVolumeHierarchy<dimensions, T>::BoundingVolumeHierarchy(): _dirty{true} {}
+
+template<UnsignedInt dimensions, class T> BoundingVolumeHierarchy<dimensions, T>::~BoundingVolumeHierarchy() = default;
+
+template<UnsignedInt dimensions, class T> BoundingVolumeHierarchy<dimensions, T>& BoundingVolumeHierarchy<dimensions, T>::add(BoundingVolume<dimensions, T>& volume) {
+    if(volume.hierarchy()) volume.hierarchy()->_dirty = true;
+    FeatureGroup<dimensions, BoundingVolume<dimensions, T>, T>::add(volume);
+    _dirty = true;
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> BoundingVolumeHierarchy<dimensions, T>& BoundingVolumeHierarchy<dimensions, T>::remove(BoundingVolume<dimensions, T>& volume) {
+    FeatureGroup<dimensions, BoundingVolume<dimensions, T>, T>::remove(volume);
+    _dirty = true;
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> void BoundingVolumeHierarchy<dimensions, T>::setClean() {
+    if(this->isEmpty()) return;
+
+    std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>> objects;
+    objects.reserve(this->size());
+    for(std::size_t i = 0; i != this->size(); ++i)
+        objects.push_back((*this)[i].object());
+
+    AbstractObject<dimensions, T>::setClean(objects);
+}
+
+template<UnsignedInt dimensions, class T> bool BoundingVolumeHierarchy<dimensions, T>::hasSameVolumes() const {
+    if(this->size() != _volumes.size()) return false;
+
+    /* Each volume in the group has to map to a distinct leaf, which together
+       with the same count means the membership didn't change */
+    for(std::size_t i = 0; i != this->size(); ++i) {
+        const BoundingVolume<dimensions, T>& volume = (*this)[i];
+        if(volume._leaf >= _nodes.size() || !_nodes[volume._leaf].leaf || _volumes[_nodes[volume._leaf].rightOrVolume] != &volume)
+            return false;
+    }
+
+    return true;
+}
+
+template<UnsignedInt dimensions, class T> void BoundingVolumeHierarchy<dimensions, T>::update() {
+    if(!isDirty()) return;
+
+    setClean();
+
+    if(!hasSameVolumes()) {
+        rebuild();
+        return;
+    }
+
+    /* Update leafs of changed volumes and mark all their parents for refit */
+    for(std::size_t i = 0; i != this->size(); ++i) {
+        BoundingVolume<dimensions, T>& volume = (*this)[i];
+        if(!volume._changed) continue;
+
+        volume._changed = false;
+        _nodes[volume._leaf].bounds = volume._absoluteBox;
+        for(UnsignedInt parent = _nodes[volume._leaf].parent; parent != ~UnsignedInt{} && !_nodes[parent].dirty; parent = _nodes[parent].parent)
+            _nodes[parent].dirty = true;
+    }
+
+    /* Children are always after their parent, so going backwards refits the
+       nodes bottom-up */
+    for(std::size_t i = _nodes.size(); i != 0; --i) {
+        Node& node = _nodes[i - 1];
+        if(!node.dirty) continue;
+
+        node.bounds = Implementation::unite(_nodes[i].bounds, _nodes[node.rightOrVolume].bounds);
+        node.dirty = false;
+    }
+
+    _dirty = false;
+}
+
+template<UnsignedInt dimensions, class T> void BoundingVolumeHierarchy<dimensions, T>::rebuild() {
+    setClean();
+
+    _nodes.clear();
+    _volumes.clear();
+    _volumes.reserve(this->size());
+    for(std::size_t i = 0; i != this->size(); ++i) {
+        BoundingVolume<dimensions, T>& volume = (*this)[i];
+
+        /* Volume added to an object that was already clean, calculate the
+           absolute box explicitly */
+        if(volume._leaf == ~UnsignedInt{} && !volume._changed)
+            volume._absoluteBox = Implementation::transformBox<dimensions, T>(volume.object().absoluteTransformationMatrix(), volume._box);
+
+        volume._changed = false;
+        _volumes.push_back(&volume);
+    }
+
+    if(!_volumes.empty()) {
+        _nodes.reserve(2*_volumes.size() - 1);
+        build(0, _volumes.size(), ~UnsignedInt{});
+    }
+
+    _dirty = false;
+}
+
+template<UnsignedInt dimensions, class T> UnsignedInt BoundingVolumeHierarchy<dimensions, T>::build(const std::size_t begin, const std::size_t end, const UnsignedInt parent) {
+    const UnsignedInt id = _nodes.size();
+
+    if(end - begin == 1) {
+        _nodes.push_back({_volumes[begin]->_absoluteBox, parent, UnsignedInt(begin), true, false});
+        _volumes[begin]->_leaf = id;
+        return id;
+    }
+
+    /* Split along the longest axis of box centers */
+    VectorTypeFor<dimensions, T> min = _volumes[begin]->_absoluteBox.center(), max = min;
+    for(std::size_t i = begin + 1; i != end; ++i) {
+        min = Math::min(min, _volumes[i]->_absoluteBox.center());
+        max = Math::max(max, _volumes[i]->_absoluteBox.center());
+    }
+    const VectorTypeFor<dimensions, T> size = max - min;
+    std::size_t axis = 0;
+    for(std::size_t i = 1; i != dimensions; ++i)
+        if(size[i] > size[axis]) axis = i;
+
+    const std::size_t middle = begin + (end - begin)/2;
+    std::nth_element(_volumes.begin() + begin, _volumes.begin() + middle, _volumes.begin() + end,
+        [axis](const BoundingVolume<dimensions, T>* a, const BoundingVolume<dimensions, T>* b) {
+            return a->_absoluteBox.center()[axis] < b->_absoluteBox.center()[axis];
+        });
+
+    /* Left child is always right after the parent */
+    _nodes.push_back({{}, parent, 0, false, false});
+    build(begin, middle, id);
+    const UnsignedInt right = build(middle, end, id);
+    _nodes[id].bounds = Implementation::unite(_nodes[id + 1].bounds, _nodes[right].bounds);
+    _nodes[id].rightOrVolume = right;
+    return id;
+}
+
+template<UnsignedInt dimensions, class T> template<class Predicate> void BoundingVolumeHierarchy<dimensions, T>::query(const Predicate& predicate, std::vector<BoundingVolume<dimensions, T>*>& out) const {
+    if(_nodes.empty()) return;
+
+    std::vector<UnsignedInt> stack{0};
+    while(!stack.empty()) {
+        const Node& node = _nodes[stack.back()];
+        const UnsignedInt id = stack.back();
+        stack.pop_back();
+
+        if(!predicate(node.bounds)) continue;
+
+        if(node.leaf) out.push_back(_volumes[node.rightOrVolume]);
+        else {
+            stack.push_back(node.rightOrVolume);
+            stack.push_back(id + 1);
+        }
+    }
+}
+
+template<UnsignedInt dimensions, class T> RangeTypeFor<dimensions, T> BoundingVolumeHierarchy<dimensions, T>::bounds() {
+    update();
+    return _nodes.empty() ? RangeTypeFor<dimensions, T>{} : _nodes.front().bounds;
+}
+
+template<UnsignedInt dimensions, class T> std::vector<BoundingVolume<dimensions, T>*> BoundingVolumeHierarchy<dimensions, T>::boxQuery(const RangeTypeFor<dimensions, T>& box) {
+    update();
+
+    std::vector<BoundingVolume<dimensions, T>*> out;
+    query([&box](const RangeTypeFor<dimensions, T>& bounds) {
+        return Implementation::boxBox<dimensions, T>(box, bounds);
+    }, out);
+    return out;
+}
+
+template<UnsignedInt dimensions, class T> std::vector<BoundingVolume<dimensions, T>*> BoundingVolumeHierarchy<dimensions, T>::sphereQuery(const VectorTypeFor<dimensions, T>& center, const T radius) {
+    update();
+
+    const T radiusSquared = radius*radius;
+    std::vector<BoundingVolume<dimensions, T>*> out;
+    query([&center, radiusSquared](const RangeTypeFor<dimensions, T>& bounds) {
+        return Implementation::sphereBox<dimensions, T>(center, radiusSquared, bounds);
+    }, out);
+    return out;
+}
+
+template<UnsignedInt dimensions, class T> std::vector<BoundingVolume<dimensions, T>*> BoundingVolumeHierarchy<dimensions, T>::rayQuery(const VectorTypeFor<dimensions, T>& origin, const VectorTypeFor<dimensions, T>& direction) {
+    update();
+
+    const VectorTypeFor<dimensions, T> inverseDirection = T(1)/direction;
+    std::vector<BoundingVolume<dimensions, T>*> out;
+    query([&origin, &inverseDirection](const RangeTypeFor<dimensions, T>& bounds) {
+        T entry;
+        return Implementation::rayBox<dimensions, T>(origin, inverseDirection, bounds, entry);
+    }, out);
+
+    /* Sort by entry distance */
+    std::vector<std::pair<T, BoundingVolume<dimensions, T>*>> sorted;
+    sorted.reserve(out.size());
+    for(BoundingVolume<dimensions, T>* volume: out) {
+        T entry;
+        Implementation::rayBox<dimensions, T>(origin, inverseDirection, volume->_absoluteBox, entry);
+        sorted.emplace_back(entry, volume);
+    }
+    std::stable_sort(sorted.begin(), sorted.end(),
+        [](const std::pair<T, BoundingVolume<dimensions, T>*>& a, const std::pair<T, BoundingVolume<dimensions, T>*>& b) {
+            return a.first < b.first;
+        });
+    for(std::size_t i = 0; i != sorted.size(); ++i)
+        out[i] = sorted[i].second;
+
+    return out;
+}
+
+template<UnsignedInt dimensions, class T> std::vector<BoundingVolume<dimensions, T>*> BoundingVolumeHierarchy<dimensions, T>::frustumQuery(const Math::Frustum<T>& frustum) {
+    update();
+
+    std::vector<BoundingVolume<dimensions, T>*> out;
+    query([&frustum](const RangeTypeFor<dimensions, T>& bounds) {
+        return Implementation::boxFrustum(bounds, frustum);
+    }, out);
+    return out;
+}
+
+}}
+
+#endif
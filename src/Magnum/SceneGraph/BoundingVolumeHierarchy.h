@@ -0,0 +1,241 @@
+#ifndef Magnum_SceneGraph_BoundingVolumeHierarchy_h
+#define Magnum_SceneGraph_BoundingVolumeHierarchy_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::BoundingVolumeHierarchy, alias @ref Magnum::SceneGraph::BasicBoundingVolumeHierarchy2D, @ref Magnum::SceneGraph::BasicBoundingVolumeHierarchy3D, typedef @ref Magnum::SceneGraph::BoundingVolumeHierarchy2D, @ref Magnum::SceneGraph::BoundingVolumeHierarchy3D
+ */
+
+#include <vector>
+
+#include "Magnum/DimensionTraits.h"
+#include "Magnum/Math/Frustum.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/SceneGraph/FeatureGroup.h"
+#include "Magnum/SceneGraph/visibility.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Bounding volume hierarchy
+
+Spatial index over a group of @ref BoundingVolume features, accelerating ray
+picking, culling and proximity queries. The hierarchy is a binary tree of
+axis-aligned boxes with one bounding volume in each leaf.
+
+The tree is maintained incrementally in @ref update(), which is called
+implicitly by all queries. Only objects that were marked as dirty since the
+last update get their absolute bounding boxes recalculated and only the tree
+nodes above them get refitted, the tree topology is kept. The tree is built
+from scratch only if bounding volumes were added to or removed from the
+hierarchy. If the objects move a lot, the refitted tree might become
+inefficient over time, call @ref rebuild() to build an optimal one again.
+
+See @ref BoundingVolume for an example.
+
+@section SceneGraph-BoundingVolumeHierarchy-explicit-specializations Explicit template specializations
+
+The following specializations are explicitly compiled into @ref SceneGraph
+library. For other specializations (e.g. using @ref Magnum::Double "Double"
+type) you have to use @ref BoundingVolume.hpp implementation file to avoid
+linker errors. See also @ref compilation-speedup-hpp for more information.
+
+-   @ref BoundingVolumeHierarchy2D
+-   @ref BoundingVolumeHierarchy3D
+
+@see @ref scenegraph, @ref BasicBoundingVolumeHierarchy2D,
+    @ref BasicBoundingVolumeHierarchy3D, @ref BoundingVolumeHierarchy2D,
+    @ref BoundingVolumeHierarchy3D
+*/
+template<UnsignedInt dimensions, class T> class BoundingVolumeHierarchy: public FeatureGroup<dimensions, BoundingVolume<dimensions, T>, T> {
+    friend BoundingVolume<dimensions, T>;
+
+    public:
+        /**
+         * @brief Constructor
+         *
+         * Marks the hierarchy as dirty.
+         */
+        explicit BoundingVolumeHierarchy();
+
+        ~BoundingVolumeHierarchy();
+
+        /**
+         * @brief Add bounding volume to the hierarchy
+         * @return Reference to self (for method chaining)
+         *
+         * Marks the hierarchy as dirty.
+         * @see @ref FeatureGroup::add()
+         */
+        BoundingVolumeHierarchy<dimensions, T>& add(BoundingVolume<dimensions, T>& volume);
+
+        /**
+         * @brief Remove bounding volume from the hierarchy
+         * @return Reference to self (for method chaining)
+         *
+         * Marks the hierarchy as dirty.
+         * @see @ref FeatureGroup::remove()
+         */
+        BoundingVolumeHierarchy<dimensions, T>& remove(BoundingVolume<dimensions, T>& volume);
+
+        /**
+         * @brief Whether the hierarchy is dirty
+         *
+         * The hierarchy is dirty if any bounding volume was added or removed,
+         * if the bounding box of any of them was changed or if any of their
+         * objects was marked as dirty.
+         */
+        bool isDirty() const {
+            return _dirty || this->size() != _volumes.size();
+        }
+
+        /**
+         * @brief Update the hierarchy
+         *
+         * Cleans all objects, recalculates absolute bounding boxes of the
+         * changed bounding volumes and refits the tree. If bounding volumes
+         * were added or removed since the last update, the tree is built
+         * from scratch. Does nothing if the hierarchy is not dirty.
+         * @see @ref rebuild()
+         */
+        void update();
+
+        /**
+         * @brief Rebuild the hierarchy
+         *
+         * Cleans all objects and builds the tree from scratch, splitting the
+         * bounding volumes at median of their box centers along the longest
+         * axis.
+         */
+        void rebuild();
+
+        /**
+         * @brief Bounds of the whole hierarchy
+         *
+         * Returns zero range if the hierarchy is empty. Calls @ref update()
+         * first.
+         */
+        RangeTypeFor<dimensions, T> bounds();
+
+        /**
+         * @brief Bounding volumes intersecting given box
+         *
+         * The box is in absolute coordinates. Calls @ref update() first.
+         */
+        std::vector<BoundingVolume<dimensions, T>*> boxQuery(const RangeTypeFor<dimensions, T>& box);
+
+        /**
+         * @brief Bounding volumes intersecting given sphere
+         *
+         * The sphere is in absolute coordinates. Calls @ref update() first.
+         */
+        std::vector<BoundingVolume<dimensions, T>*> sphereQuery(const VectorTypeFor<dimensions, T>& center, T radius);
+
+        /**
+         * @brief Bounding volumes intersected by given ray
+         * @param origin        Ray origin
+         * @param direction     Ray direction, doesn't need to be normalized
+         *
+         * The ray is in absolute coordinates. Returned bounding volumes are
+         * sorted by distance of the point where the ray enters them, the
+         * first one is the nearest. Calls @ref update() first.
+         */
+        std::vector<BoundingVolume<dimensions, T>*> rayQuery(const VectorTypeFor<dimensions, T>& origin, const VectorTypeFor<dimensions, T>& direction);
+
+        /**
+         * @brief Bounding volumes intersecting given frustum
+         *
+         * The frustum is in absolute coordinates, for example
+         * @cpp Frustum::fromMatrix(camera.projectionMatrix()*camera.cameraMatrix()) @ce.
+         * In 2D the boxes are treated as lying in the @f$ z = 0 @f$ plane.
+         * The test is conservative, similarly to
+         * @ref Math::Geometry::Intersection::boxFrustum(). Calls
+         * @ref update() first.
+         */
+        std::vector<BoundingVolume<dimensions, T>*> frustumQuery(const Math::Frustum<T>& frustum);
+
+    private:
+        struct Node {
+            RangeTypeFor<dimensions, T> bounds;
+            UnsignedInt parent;
+            /* Right child for inner nodes (left child is always next to the
+               parent), index into _volumes for leafs */
+            UnsignedInt rightOrVolume;
+            bool leaf;
+            bool dirty;
+        };
+
+        void setClean();
+        bool hasSameVolumes() const;
+        UnsignedInt build(std::size_t begin, std::size_t end, UnsignedInt parent);
+        template<class Predicate> void query(const Predicate& predicate, std::vector<BoundingVolume<dimensions, T>*>& out) const;
+
+        std::vector<Node> _nodes;
+        /* Volumes in order of leafs, kept solely for detecting changes in
+           group membership, never dereferenced if stale */
+        std::vector<BoundingVolume<dimensions, T>*> _volumes;
+        bool _dirty;
+};
+
+/**
+@brief Bounding volume hierarchy for two-dimensional scenes
+
+Convenience alternative to @cpp BoundingVolumeHierarchy<2, T> @ce. See
+@ref BoundingVolumeHierarchy for more information.
+@see @ref BoundingVolumeHierarchy2D, @ref BasicBoundingVolumeHierarchy3D
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<class T> using BasicBoundingVolumeHierarchy2D = BoundingVolumeHierarchy<2, T>;
+#endif
+
+/**
+@brief Bounding volume hierarchy for two-dimensional float scenes
+
+@see @ref BoundingVolumeHierarchy3D
+*/
+typedef BasicBoundingVolumeHierarchy2D<Float> BoundingVolumeHierarchy2D;
+
+/**
+@brief Bounding volume hierarchy for three-dimensional scenes
+
+Convenience alternative to @cpp BoundingVolumeHierarchy<3, T> @ce. See
+@ref BoundingVolumeHierarchy for more information.
+@see @ref BoundingVolumeHierarchy3D, @ref BasicBoundingVolumeHierarchy2D
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<class T> using BasicBoundingVolumeHierarchy3D = BoundingVolumeHierarchy<3, T>;
+#endif
+
+/**
+@brief Bounding volume hierarchy for three-dimensional float scenes
+
+@see @ref BoundingVolumeHierarchy2D
+*/
+typedef BasicBoundingVolumeHierarchy3D<Float> BoundingVolumeHierarchy3D;
+
+}}
+
+#endif
@@ -26,11 +26,17 @@
 */
 
 /** @file
- * @brief Class @ref Magnum::SceneGraph::Camera, enum @ref Magnum::SceneGraph::AspectRatioPolicy, alias @ref Magnum::SceneGraph::BasicCamera2D, @ref Magnum::SceneGraph::BasicCamera3D, typedef @ref Magnum::SceneGraph::Camera2D, @ref Magnum::SceneGraph::Camera3D
+ * @brief Class @ref Magnum::SceneGraph::Camera, enum @ref Magnum::SceneGraph::AspectRatioPolicy, @ref Magnum::SceneGraph::DepthOrder, alias @ref Magnum::SceneGraph::BasicCamera2D, @ref Magnum::SceneGraph::BasicCamera3D, typedef @ref Magnum::SceneGraph::Camera2D, @ref Magnum::SceneGraph::Camera3D
  */
 
+#include <functional>
+#include <vector>
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/DimensionTraits.h"
 #include "Magnum/Math/Matrix3.h"
 #include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Range.h"
 #include "Magnum/SceneGraph/AbstractFeature.h"
 #include "Magnum/SceneGraph/visibility.h"
 
@@ -52,6 +58,25 @@ enum class AspectRatioPolicy: UnsignedByte {
     Clip            /**< Clip on smaller side of view */
 };
 
+/**
+@brief Depth order of drawables with the same sort key
+
+@see @ref Camera::drawSorted()
+*/
+enum class DepthOrder: UnsignedByte {
+    /** Keep the original order */
+    None,
+
+    /**
+     * Nearest objects first, useful for reducing overdraw of opaque
+     * objects
+     */
+    FrontToBack,
+
+    /** Farthest objects first, useful for blending */
+    BackToFront
+};
+
 namespace Implementation {
     template<UnsignedInt dimensions, class T> MatrixTypeFor<dimensions, T> aspectRatioFix(AspectRatioPolicy aspectRatioPolicy, const Math::Vector2<T>& projectionScale, const Vector2i& viewport);
 }
@@ -201,10 +226,73 @@ template<UnsignedInt dimensions, class T> class Camera: public AbstractFeature<d
         /**
          * @brief Draw
          *
-         * Draws given group of drawables.
+         * Draws given group of drawables. Storage for the list of objects
+         * and their transformations is kept in the camera and reused across
+         * calls, so drawing groups of the same or smaller size doesn't
+         * allocate. Because of that it's not allowed to call @ref draw() on
+         * the same camera from inside @ref Drawable::draw().
          */
         virtual void draw(DrawableGroup<dimensions, T>& group);
 
+        /**
+         * @brief Draw with transformations computed in parallel
+         *
+         * Like @ref draw(), but the transformations of all drawables are
+         * computed on @p pool using the parallel
+         * @ref Object::transformationMatrices() overload.
+         * The result is the same as with @ref draw(). The drawing itself is
+         * done serially on the calling thread, so @ref Drawable::draw()
+         * implementations don't need to be thread-safe.
+         */
+        void draw(DrawableGroup<dimensions, T>& group, ThreadPool& pool);
+
+        /**
+         * @brief Draw with frustum culling
+         * @return Count of drawables that were drawn
+         *
+         * Like @ref draw(), but skips drawables which have a bounding box set
+         * using @ref Drawable::setBoundingBox() and the box lies completely
+         * outside of the view frustum given by @ref projectionMatrix(). All
+         * transformations are computed in a single batch first, then all
+         * boxes are transformed to camera space, tested against the frustum
+         * extracted from the projection matrix just once and only the
+         * visible drawables are drawn, in the original order. Drawables
+         * without bounding box are always drawn.
+         *
+         * The test is conservative --- a drawable may be drawn even if it's
+         * not visible, as the camera-space box encloses the rotated original
+         * box, but it's never skipped if any part of its bounding box is
+         * visible.
+         * @see @ref Math::Geometry::Intersection::boxesFrustumInto()
+         */
+        std::size_t drawCulled(DrawableGroup<dimensions, T>& group);
+
+        /**
+         * @brief Draw sorted
+         *
+         * Like @ref draw(), but the drawables are drawn in order of
+         * increasing @ref Drawable::sortKey(). The keys are sorted with a
+         * stable radix sort, passes over bytes that are the same for all keys
+         * are skipped. Drawables with the same key are ordered based on
+         * @p depthOrder, which uses distance of object origin from the camera
+         * along its Z axis. Depth order is ignored in 2D. See
+         * @ref SceneGraph-Drawable-sorting for more information.
+         */
+        void drawSorted(DrawableGroup<dimensions, T>& group, DepthOrder depthOrder = DepthOrder::None);
+
+        /**
+         * @brief Draw depth
+         * @return Count of drawables that were drawn
+         *
+         * Calls @ref Drawable::drawDepth() on all drawables in the group,
+         * culled the same way as in @ref drawCulled() and ordered front to
+         * back, so the depth test rejects as many fragments as possible.
+         * Sort keys are ignored, the order is ignored in 2D. Setting up the
+         * color and depth mask is left to the caller, see
+         * @ref SceneGraph-Drawable-depth-prepass for an example.
+         */
+        std::size_t drawDepth(DrawableGroup<dimensions, T>& group);
+
     private:
         /** Recalculates camera matrix */
         void cleanInverted(const MatrixTypeFor<dimensions, T>& invertedAbsoluteTransformationMatrix) override {
@@ -212,6 +300,8 @@ template<UnsignedInt dimensions, class T> class Camera: public AbstractFeature<d
         }
 
         void fixAspectRatio();
+        bool computeDrawableTransformations(DrawableGroup<dimensions, T>& group, ThreadPool* pool = nullptr);
+        void cullDrawables(DrawableGroup<dimensions, T>& group);
 
         MatrixTypeFor<dimensions, T> _rawProjectionMatrix;
         AspectRatioPolicy _aspectRatioPolicy;
@@ -220,6 +310,18 @@ template<UnsignedInt dimensions, class T> class Camera: public AbstractFeature<d
         MatrixTypeFor<dimensions, T> _cameraMatrix;
 
         Vector2i _viewport;
+
+        /* Scratch storage for draw() and drawCulled() */
+        std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>> _drawableObjects;
+        std::vector<MatrixTypeFor<dimensions, T>> _drawableTransformations;
+
+        /* Scratch storage for drawCulled() and drawDepth() */
+        std::vector<RangeTypeFor<dimensions, T>> _drawableBoxes;
+        Containers::Array<bool> _drawableVisible;
+
+        /* Scratch storage for drawSorted() and drawDepth() */
+        std::vector<UnsignedLong> _drawableSortKeys;
+        std::vector<UnsignedInt> _drawableDepths, _drawableOrder, _drawableOrderScratch;
 };
 
 /**
@@ -29,7 +29,11 @@
  * @brief @ref compilation-speedup-hpp "Template implementation" for @ref Camera.h
  */
 
+#include <cstring>
+#include <utility>
+
 #include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Geometry/Intersection.h"
 #include "Magnum/SceneGraph/Camera.h"
 #include "Magnum/SceneGraph/Drawable.h"
 
@@ -53,6 +57,87 @@ template<UnsignedInt dimensions, class T> MatrixTypeFor<dimensions, T> aspectRat
         Math::Vector2<T>(T(1), relativeAspectRatio.x()/relativeAspectRatio.y()), T(1)));
 }
 
+template<UnsignedInt dimensions, class T> struct CameraCulling;
+
+template<class T> struct CameraCulling<2, T> {
+    /* Axis-aligned box enclosing the transformed box, calculated from
+       transformed center and the half-size projected onto the new axes */
+    static Math::Range2D<T> transformBox(const Math::Matrix3<T>& transformation, const Math::Range2D<T>& box) {
+        const Math::Vector2<T> center = transformation.transformPoint(box.center());
+        const Math::Vector2<T> halfSize = box.size()*T(0.5);
+        const Math::Vector2<T> extent =
+            Math::abs(transformation[0].xy())*halfSize.x() +
+            Math::abs(transformation[1].xy())*halfSize.y();
+        return {center - extent, center + extent};
+    }
+
+    /* Orthographic projection, so it's enough to check that the box projected
+       to clip space doesn't lie completely outside of the [-1, 1] square */
+    static void cullInto(const std::vector<Math::Range2D<T>>& boxes, const Math::Matrix3<T>& projection, const Containers::ArrayView<bool> visible) {
+        for(std::size_t i = 0; i != boxes.size(); ++i) {
+            const Math::Range2D<T> box = transformBox(projection, boxes[i]);
+            visible[i] = !(box.min() > Math::Vector2<T>{T(1)}).any() &&
+                         !(box.max() < Math::Vector2<T>{T(-1)}).any();
+        }
+    }
+};
+
+template<class T> struct CameraCulling<3, T> {
+    static Math::Range3D<T> transformBox(const Math::Matrix4<T>& transformation, const Math::Range3D<T>& box) {
+        const Math::Vector3<T> center = transformation.transformPoint(box.center());
+        const Math::Vector3<T> halfSize = box.size()*T(0.5);
+        const Math::Vector3<T> extent =
+            Math::abs(transformation[0].xyz())*halfSize.x() +
+            Math::abs(transformation[1].xyz())*halfSize.y() +
+            Math::abs(transformation[2].xyz())*halfSize.z();
+        return {center - extent, center + extent};
+    }
+
+    /* The frustum is extracted just once and all camera-space boxes are
+       tested against it in a single batch */
+    static void cullInto(const std::vector<Math::Range3D<T>>& boxes, const Math::Matrix4<T>& projection, const Containers::ArrayView<bool> visible) {
+        Math::Geometry::Intersection::boxesFrustumInto<T>({boxes.data(), boxes.size()}, Math::Frustum<T>::fromMatrix(projection), visible);
+    }
+};
+
+/* Stable LSD radix sort of indices by given keys, one byte per pass */
+template<class Key> void radixSortIndices(const std::vector<Key>& keys, std::vector<UnsignedInt>& order, std::vector<UnsignedInt>& scratch) {
+    if(order.empty()) return;
+
+    scratch.resize(order.size());
+    for(std::size_t shift = 0; shift != sizeof(Key)*8; shift += 8) {
+        std::size_t counts[256]{};
+        for(UnsignedInt i: order) ++counts[(keys[i] >> shift) & 0xff];
+
+        /* All keys have the same byte, the pass wouldn't change anything */
+        if(counts[(keys[order.front()] >> shift) & 0xff] == order.size())
+            continue;
+
+        std::size_t offset = 0;
+        for(std::size_t& count: counts) {
+            const std::size_t current = count;
+            count = offset;
+            offset += current;
+        }
+
+        for(UnsignedInt i: order) scratch[counts[(keys[i] >> shift) & 0xff]++] = i;
+        std::swap(order, scratch);
+    }
+}
+
+/* Maps a float onto an unsigned integer with the same ordering */
+inline UnsignedInt sortableDepth(const Float depth) {
+    UnsignedInt bits;
+    std::memcpy(&bits, &depth, sizeof(bits));
+    return bits & 0x80000000u ? ~bits : bits|0x80000000u;
+}
+
+/* Distance of object origin from the camera, which looks along -Z */
+template<class T> Float drawableDepth(const Math::Matrix3<T>&) { return 0.0f; }
+template<class T> Float drawableDepth(const Math::Matrix4<T>& transformation) {
+    return Float(-transformation.translation().z());
+}
+
 }
 
 template<UnsignedInt dimensions, class T> Camera<dimensions, T>::Camera(AbstractObject<dimensions, T>& object): AbstractFeature<dimensions, T>(object), _aspectRatioPolicy(AspectRatioPolicy::NotPreserved) {
@@ -82,24 +167,122 @@ template<UnsignedInt dimensions, class T> void Camera<dimensions, T>::setViewpor
     fixAspectRatio();
 }
 
-template<UnsignedInt dimensions, class T> void Camera<dimensions, T>::draw(DrawableGroup<dimensions, T>& group) {
+template<UnsignedInt dimensions, class T> bool Camera<dimensions, T>::computeDrawableTransformations(DrawableGroup<dimensions, T>& group, ThreadPool* const pool) {
     AbstractObject<dimensions, T>* scene = AbstractFeature<dimensions, T>::object().scene();
-    CORRADE_ASSERT(scene, "Camera::draw(): cannot draw when camera is not part of any scene", );
+    CORRADE_ASSERT(scene, "Camera::draw(): cannot draw when camera is not part of any scene", false);
 
     /* Compute camera matrix */
     AbstractFeature<dimensions, T>::object().setClean();
 
-    /* Compute transformations of all objects in the group relative to the camera */
-    std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>> objects;
-    objects.reserve(group.size());
+    /* Compute transformations of all objects in the group relative to the
+       camera. The storage is reused across calls to avoid allocations. */
+    _drawableObjects.clear();
+    for(std::size_t i = 0; i != group.size(); ++i)
+        _drawableObjects.push_back(group[i].object());
+    _drawableTransformations.resize(group.size());
+    if(pool) scene->transformationMatrices(_drawableObjects, {_drawableTransformations.data(), _drawableTransformations.size()}, _cameraMatrix, *pool);
+    else scene->transformationMatrices(_drawableObjects, {_drawableTransformations.data(), _drawableTransformations.size()}, _cameraMatrix);
+    return true;
+}
+
+template<UnsignedInt dimensions, class T> void Camera<dimensions, T>::draw(DrawableGroup<dimensions, T>& group) {
+    if(!computeDrawableTransformations(group)) return;
+
+    /* Perform the drawing */
+    for(std::size_t i = 0; i != _drawableTransformations.size(); ++i)
+        group[i].draw(_drawableTransformations[i], *this);
+}
+
+template<UnsignedInt dimensions, class T> void Camera<dimensions, T>::draw(DrawableGroup<dimensions, T>& group, ThreadPool& pool) {
+    if(!computeDrawableTransformations(group, &pool)) return;
+
+    /* Perform the drawing */
+    for(std::size_t i = 0; i != _drawableTransformations.size(); ++i)
+        group[i].draw(_drawableTransformations[i], *this);
+}
+
+template<UnsignedInt dimensions, class T> void Camera<dimensions, T>::cullDrawables(DrawableGroup<dimensions, T>& group) {
+    /* Bring all bounding boxes to camera space */
+    _drawableBoxes.clear();
+    for(std::size_t i = 0; i != _drawableTransformations.size(); ++i) {
+        const Drawable<dimensions, T>& drawable = group[i];
+        if(drawable.hasBoundingBox())
+            _drawableBoxes.push_back(Implementation::CameraCulling<dimensions, T>::transformBox(_drawableTransformations[i], drawable.boundingBox()));
+    }
+
+    /* Cull them all against the projection at once */
+    if(_drawableVisible.size() < _drawableBoxes.size())
+        _drawableVisible = Containers::Array<bool>{_drawableBoxes.size()};
+    Implementation::CameraCulling<dimensions, T>::cullInto(_drawableBoxes, _projectionMatrix, {_drawableVisible.data(), _drawableBoxes.size()});
+
+    /* Gather the visible drawables in the original order, drawables without
+       bounding box are always visible */
+    _drawableOrder.clear();
+    std::size_t box = 0;
+    for(std::size_t i = 0; i != _drawableTransformations.size(); ++i)
+        if(!group[i].hasBoundingBox() || _drawableVisible[box++])
+            _drawableOrder.push_back(UnsignedInt(i));
+}
+
+template<UnsignedInt dimensions, class T> std::size_t Camera<dimensions, T>::drawCulled(DrawableGroup<dimensions, T>& group) {
+    if(!computeDrawableTransformations(group)) return 0;
+
+    cullDrawables(group);
+
+    /* Perform the drawing */
+    for(UnsignedInt i: _drawableOrder)
+        group[i].draw(_drawableTransformations[i], *this);
+
+    return _drawableOrder.size();
+}
+
+template<UnsignedInt dimensions, class T> void Camera<dimensions, T>::drawSorted(DrawableGroup<dimensions, T>& group, const DepthOrder depthOrder) {
+    if(!computeDrawableTransformations(group)) return;
+
+    _drawableOrder.resize(group.size());
+    for(std::size_t i = 0; i != group.size(); ++i)
+        _drawableOrder[i] = UnsignedInt(i);
+
+    /* Sort by depth first, the sort is stable so the subsequent sort by key
+       keeps the depth order for drawables with the same key */
+    if(depthOrder != DepthOrder::None && dimensions == 3) {
+        _drawableDepths.resize(group.size());
+        for(std::size_t i = 0; i != group.size(); ++i) {
+            const UnsignedInt depth = Implementation::sortableDepth(Implementation::drawableDepth(_drawableTransformations[i]));
+            _drawableDepths[i] = depthOrder == DepthOrder::FrontToBack ? depth : ~depth;
+        }
+        Implementation::radixSortIndices(_drawableDepths, _drawableOrder, _drawableOrderScratch);
+    }
+
+    _drawableSortKeys.resize(group.size());
     for(std::size_t i = 0; i != group.size(); ++i)
-        objects.push_back(group[i].object());
-    std::vector<MatrixTypeFor<dimensions, T>> transformations =
-        scene->transformationMatrices(objects, _cameraMatrix);
+        _drawableSortKeys[i] = group[i].sortKey();
+    Implementation::radixSortIndices(_drawableSortKeys, _drawableOrder, _drawableOrderScratch);
+
+    /* Perform the drawing */
+    for(UnsignedInt i: _drawableOrder)
+        group[i].draw(_drawableTransformations[i], *this);
+}
+
+template<UnsignedInt dimensions, class T> std::size_t Camera<dimensions, T>::drawDepth(DrawableGroup<dimensions, T>& group) {
+    if(!computeDrawableTransformations(group)) return 0;
+
+    /* Cull first so only the visible drawables get sorted */
+    cullDrawables(group);
+
+    /* Nearest first */
+    if(dimensions == 3) {
+        _drawableDepths.resize(group.size());
+        for(UnsignedInt i: _drawableOrder)
+            _drawableDepths[i] = Implementation::sortableDepth(Implementation::drawableDepth(_drawableTransformations[i]));
+        Implementation::radixSortIndices(_drawableDepths, _drawableOrder, _drawableOrderScratch);
+    }
 
     /* Perform the drawing */
-    for(std::size_t i = 0; i != transformations.size(); ++i)
-        group[i].draw(transformations[i], *this);
+    for(UnsignedInt i: _drawableOrder)
+        group[i].drawDepth(_drawableTransformations[i], *this);
+
+    return _drawableOrder.size();
 }
 
 }}
@@ -0,0 +1,215 @@
+#ifndef Magnum_SceneGraph_DerivedTransformation_h
+#define Magnum_SceneGraph_DerivedTransformation_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::DerivedTransformation, alias @ref Magnum::SceneGraph::BasicDerivedTransformation2D, @ref Magnum::SceneGraph::BasicDerivedTransformation3D, typedef @ref Magnum::SceneGraph::DerivedTransformation2D, @ref Magnum::SceneGraph::DerivedTransformation3D
+ */
+
+#include "Magnum/DimensionTraits.h"
+#include "Magnum/Math/Matrix.h"
+#include "Magnum/SceneGraph/AbstractFeature.h"
+#include "Magnum/SceneGraph/visibility.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Data derived from absolute object transformation
+
+Caches the absolute transformation matrix of an object together with data
+derived from it --- a normal matrix and a bounding sphere in world space. The
+data are calculated only when the object is cleaned after its transformation
+changed, using the @ref scenegraph-features-caching "transformation caching"
+mechanism, and then shared by all cameras and render passes that draw the
+object, instead of by every @ref Drawable::draw() call.
+
+@code{.cpp}
+class RedCube: public Object3D, public SceneGraph::Drawable3D {
+    public:
+        explicit RedCube(Object3D* parent, SceneGraph::DrawableGroup3D* group): Object3D{parent}, SceneGraph::Drawable3D{*this, group}, _derived{*this} {
+            _derived.setBoundingSphere({}, Constants::sqrt3());
+        }
+
+    private:
+        void draw(const Matrix4& transformationMatrix, SceneGraph::Camera3D& camera) override {
+            _shader.setTransformationMatrix(transformationMatrix)
+                .setNormalMatrix(_derived.normalMatrix(camera.cameraMatrix()))
+                .setProjectionMatrix(camera.projectionMatrix());
+            _mesh.draw(_shader);
+        }
+
+        SceneGraph::DerivedTransformation3D _derived;
+        // ...
+};
+@endcode
+
+The data are up-to-date after the object was cleaned, i.e. after calling
+@ref Object::setClean() or @ref FlatHierarchy::setClean(). @ref Camera::draw()
+cleans all objects it draws before calling @ref Drawable::draw(), so the
+cached data can be used directly in the draw implementation.
+
+@section SceneGraph-DerivedTransformation-explicit-specializations Explicit template specializations
+
+The following specializations are explicitly compiled into @ref SceneGraph
+library. For other specializations (e.g. using @ref Magnum::Double "Double"
+type) you have to use @ref DerivedTransformation.hpp implementation file to
+avoid linker errors. See also @ref compilation-speedup-hpp for more
+information.
+
+-   @ref DerivedTransformation2D
+-   @ref DerivedTransformation3D
+
+@see @ref scenegraph, @ref BasicDerivedTransformation2D,
+    @ref BasicDerivedTransformation3D, @ref DerivedTransformation2D,
+    @ref DerivedTransformation3D
+*/
+template<UnsignedInt dimensions, class T> class DerivedTransformation: public AbstractFeature<dimensions, T> {
+    public:
+        /**
+         * @brief Constructor
+         * @param object    Object to cache the data for
+         *
+         * Marks the object as dirty, so the data are calculated on next
+         * cleaning. The bounding sphere has zero radius and is positioned at
+         * the object origin by default.
+         */
+        explicit DerivedTransformation(AbstractObject<dimensions, T>& object);
+
+        /** @brief Absolute transformation matrix */
+        MatrixTypeFor<dimensions, T> absoluteTransformationMatrix() const {
+            return _absoluteTransformationMatrix;
+        }
+
+        /**
+         * @brief Normal matrix
+         *
+         * Inverted transposed upper-left part of
+         * @ref absoluteTransformationMatrix(), used for transforming normals
+         * to world space.
+         */
+        Math::Matrix<dimensions, T> normalMatrix() const { return _normalMatrix; }
+
+        /**
+         * @brief Normal matrix relative to a camera
+         *
+         * Normal matrix for transformation composed of @p cameraMatrix and
+         * @ref absoluteTransformationMatrix(), such as is passed to
+         * @ref Drawable::draw(). Calculated only as a product of the
+         * upper-left part of @p cameraMatrix and @ref normalMatrix(), which is
+         * exact if the camera matrix is rigid or has only a uniform scaling.
+         * @see @ref Camera::cameraMatrix()
+         */
+        Math::Matrix<dimensions, T> normalMatrix(const MatrixTypeFor<dimensions, T>& cameraMatrix) const {
+            return cameraMatrix.rotationScaling()*_normalMatrix;
+        }
+
+        /** @brief Bounding sphere center in local coordinate system of the object */
+        VectorTypeFor<dimensions, T> boundingSphereCenter() const { return _center; }
+
+        /** @brief Bounding sphere radius in local coordinate system of the object */
+        T boundingSphereRadius() const { return _radius; }
+
+        /**
+         * @brief Set bounding sphere
+         * @return Reference to self (for method chaining)
+         *
+         * The absolute sphere is recalculated immediately from the cached
+         * absolute transformation.
+         */
+        DerivedTransformation<dimensions, T>& setBoundingSphere(const VectorTypeFor<dimensions, T>& center, T radius);
+
+        /**
+         * @brief Absolute bounding sphere center
+         *
+         * @ref boundingSphereCenter() transformed with
+         * @ref absoluteTransformationMatrix().
+         */
+        VectorTypeFor<dimensions, T> absoluteBoundingSphereCenter() const { return _absoluteCenter; }
+
+        /**
+         * @brief Absolute bounding sphere radius
+         *
+         * @ref boundingSphereRadius() multiplied with the largest scaling
+         * factor of @ref absoluteTransformationMatrix(), so the sphere
+         * encloses the transformed local sphere also for non-uniform
+         * scaling.
+         */
+        T absoluteBoundingSphereRadius() const { return _absoluteRadius; }
+
+    private:
+        void clean(const MatrixTypeFor<dimensions, T>& absoluteTransformationMatrix) override;
+        void updateBoundingSphere();
+
+        MatrixTypeFor<dimensions, T> _absoluteTransformationMatrix;
+        Math::Matrix<dimensions, T> _normalMatrix;
+        VectorTypeFor<dimensions, T> _center, _absoluteCenter;
+        T _radius, _absoluteRadius;
+};
+
+/**
+@brief Derived transformation data for two-dimensional scenes
+
+Convenience alternative to @cpp DerivedTransformation<2, T> @ce. See
+@ref DerivedTransformation for more information.
+@see @ref DerivedTransformation2D, @ref BasicDerivedTransformation3D
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<class T> using BasicDerivedTransformation2D = DerivedTransformation<2, T>;
+#endif
+
+/**
+@brief Derived transformation data for two-dimensional float scenes
+
+@see @ref DerivedTransformation3D
+*/
+typedef BasicDerivedTransformation2D<Float> DerivedTransformation2D;
+
+/**
+@brief Derived transformation data for three-dimensional scenes
+
+Convenience alternative to @cpp DerivedTransformation<3, T> @ce. See
+@ref DerivedTransformation for more information.
+@see @ref DerivedTransformation3D, @ref BasicDerivedTransformation2D
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<class T> using BasicDerivedTransformation3D = DerivedTransformation<3, T>;
+#endif
+
+/**
+@brief Derived transformation data for three-dimensional float scenes
+
+@see @ref DerivedTransformation2D
+*/
+typedef BasicDerivedTransformation3D<Float> DerivedTransformation3D;
+
+#if defined(CORRADE_TARGET_WINDOWS) && !defined(__MINGW32__)
+extern template class MAGNUM_SCENEGRAPH_EXPORT DerivedTransformation<2, Float>;
+extern template class MAGNUM_SCENEGRAPH_EXPORT DerivedTransformation<3, Float>;
+#endif
+
+}}
+
+#endif
@@ -0,0 +1,68 @@
+#ifndef Magnum_SceneGraph_DerivedTransformation_hpp
+#define Magnum_SceneGraph_DerivedTransformation_hpp
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief @ref compilation-speedup-hpp "Template implementation" for @ref DerivedTransformation.h
+ */
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/SceneGraph/AbstractObject.h"
+#include "Magnum/SceneGraph/DerivedTransformation.h"
+
+namespace Magnum { namespace SceneGraph {
+
+template<UnsignedInt dimensions, class T> DerivedTransformation<dimensions, T>::DerivedTransformation(AbstractObject<dimensions, T>& object): AbstractFeature<dimensions, T>{object}, _normalMatrix{Math::IdentityInit}, _radius{}, _absoluteRadius{} {
+    AbstractFeature<dimensions, T>::setCachedTransformations(CachedTransformation::Absolute);
+    object.setDirty();
+}
+
+template<UnsignedInt dimensions, class T> DerivedTransformation<dimensions, T>& DerivedTransformation<dimensions, T>::setBoundingSphere(const VectorTypeFor<dimensions, T>& center, const T radius) {
+    _center = center;
+    _radius = radius;
+    updateBoundingSphere();
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> void DerivedTransformation<dimensions, T>::clean(const MatrixTypeFor<dimensions, T>& absoluteTransformationMatrix) {
+    _absoluteTransformationMatrix = absoluteTransformationMatrix;
+    _normalMatrix = absoluteTransformationMatrix.rotationScaling().inverted().transposed();
+    updateBoundingSphere();
+}
+
+template<UnsignedInt dimensions, class T> void DerivedTransformation<dimensions, T>::updateBoundingSphere() {
+    _absoluteCenter = _absoluteTransformationMatrix.transformPoint(_center);
+
+    const Math::Matrix<dimensions, T> rotationScaling = _absoluteTransformationMatrix.rotationScaling();
+    T scaling{};
+    for(std::size_t i = 0; i != dimensions; ++i)
+        scaling = Math::max(scaling, rotationScaling[i].length());
+    _absoluteRadius = _radius*scaling;
+}
+
+}}
+
+#endif
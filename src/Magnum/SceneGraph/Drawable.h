@@ -29,6 +29,8 @@
  * @brief Class @ref Magnum::SceneGraph::Drawable, @ref Magnum::SceneGraph::DrawableGroup, alias @ref Magnum::SceneGraph::BasicDrawable2D, @ref Magnum::SceneGraph::BasicDrawable3D, @ref Magnum::SceneGraph::BasicDrawableGroup2D, @ref Magnum::SceneGraph::BasicDrawableGroup3D, typedef @ref Magnum::SceneGraph::Drawable2D, @ref Magnum::SceneGraph::Drawable3D, @ref Magnum::SceneGraph::DrawableGroup2D, @ref Magnum::SceneGraph::DrawableGroup3D
  */
 
+#include "Magnum/DimensionTraits.h"
+#include "Magnum/Math/Range.h"
 #include "Magnum/SceneGraph/AbstractGroupedFeature.h"
 
 namespace Magnum { namespace SceneGraph {
@@ -160,6 +162,58 @@ void MyApplication::drawEvent() {
 }
 @endcode
 
+@section SceneGraph-Drawable-culling Frustum culling
+
+Drawables can have an axis-aligned bounding box in the local coordinate system
+of their object attached using @ref setBoundingBox(). Drawing a group with
+@ref Camera::drawCulled() then skips all drawables which have a bounding box
+and the box lies completely outside of the camera frustum, drawables without a
+bounding box are always drawn:
+
+@code{.cpp}
+mesh->setBoundingBox({{-1.0f, -1.0f, -1.0f}, {1.0f, 1.0f, 1.0f}});
+
+camera->drawCulled(drawables);
+@endcode
+
+@section SceneGraph-Drawable-sorting Sorting drawables to minimize state changes
+
+Drawables are drawn in the order in which they were added to the group. If
+drawables using the same shader, mesh or material are interleaved, consecutive
+draws keep switching the GL state. Each drawable can have a 64-bit sort key
+set using @ref setSortKey() and @ref Camera::drawSorted() then draws the group
+in order of increasing key. The meaning of the key is up to the application
+--- put the most expensive state change into the highest bits, for example:
+
+@code{.cpp}
+drawable->setSortKey(UnsignedLong(shaderId) << 48|
+                     UnsignedLong(meshId) << 24|
+                     UnsignedLong(materialId));
+
+camera->drawSorted(drawables);
+@endcode
+
+Drawables with the same key are additionally ordered by distance from the
+camera, if requested, otherwise they keep their original order.
+
+@section SceneGraph-Drawable-depth-prepass Depth pre-pass
+
+In scenes with a lot of overdraw it's beneficial to first render only depth
+of all opaque drawables and then draw them again with the depth test set to
+pass only for the nearest fragment, so the expensive shading is done only once
+for each pixel. Reimplement @ref drawDepth() to use a depth-only shader
+variant and draw the group using @ref Camera::drawDepth() first:
+
+@code{.cpp}
+Renderer::setColorMask(false, false, false, false);
+camera->drawDepth(drawables);
+
+Renderer::setColorMask(true, true, true, true);
+Renderer::setDepthMask(false);
+Renderer::setDepthFunction(Renderer::DepthFunction::LessOrEqual);
+camera->draw(drawables);
+@endcode
+
 @section SceneGraph-Drawable-explicit-specializations Explicit template specializations
 
 The following specializations are explicitly compiled into @ref SceneGraph
@@ -199,6 +253,68 @@ template<UnsignedInt dimensions, class T> class Drawable: public AbstractGrouped
             return AbstractGroupedFeature<dimensions, Drawable<dimensions, T>, T>::group();
         }
 
+        /**
+         * @brief Whether the drawable has a bounding box
+         *
+         * @see @ref setBoundingBox(), @ref resetBoundingBox()
+         */
+        bool hasBoundingBox() const { return _hasBoundingBox; }
+
+        /**
+         * @brief Bounding box
+         *
+         * Axis-aligned bounding box in the local coordinate system of the
+         * object. Meaningful only if @ref hasBoundingBox() is @cpp true @ce.
+         */
+        RangeTypeFor<dimensions, T> boundingBox() const { return _boundingBox; }
+
+        /**
+         * @brief Set bounding box
+         * @return Reference to self (for method chaining)
+         *
+         * Used by @ref Camera::drawCulled() to skip drawables outside of the
+         * camera frustum. The box is in the local coordinate system of the
+         * object and needs to enclose everything the drawable draws.
+         * @see @ref resetBoundingBox()
+         */
+        Drawable<dimensions, T>& setBoundingBox(const RangeTypeFor<dimensions, T>& box) {
+            _boundingBox = box;
+            _hasBoundingBox = true;
+            return *this;
+        }
+
+        /**
+         * @brief Reset bounding box
+         * @return Reference to self (for method chaining)
+         *
+         * The drawable won't be culled by @ref Camera::drawCulled(). This is
+         * the default.
+         */
+        Drawable<dimensions, T>& resetBoundingBox() {
+            _hasBoundingBox = false;
+            return *this;
+        }
+
+        /**
+         * @brief Sort key
+         *
+         * Default is @cpp 0 @ce.
+         * @see @ref Camera::drawSorted()
+         */
+        UnsignedLong sortKey() const { return _sortKey; }
+
+        /**
+         * @brief Set sort key
+         * @return Reference to self (for method chaining)
+         *
+         * Used by @ref Camera::drawSorted() to order the drawables. See
+         * @ref SceneGraph-Drawable-sorting for more information.
+         */
+        Drawable<dimensions, T>& setSortKey(UnsignedLong key) {
+            _sortKey = key;
+            return *this;
+        }
+
         /**
          * @brief Draw the object using given camera
          * @param transformationMatrix  Object transformation relative to camera
@@ -208,6 +324,25 @@ template<UnsignedInt dimensions, class T> class Drawable: public AbstractGrouped
          * @ref SceneGraph::Camera::projectionMatrix() "Camera::projectionMatrix()".
          */
         virtual void draw(const MatrixTypeFor<dimensions, T>& transformationMatrix, Camera<dimensions, T>& camera) = 0;
+
+        /**
+         * @brief Draw only depth of the object using given camera
+         * @param transformationMatrix  Object transformation relative to camera
+         * @param camera                Camera
+         *
+         * Called by @ref Camera::drawDepth(). Reimplement to draw the object
+         * with a cheaper depth-only shader such as @ref Shaders::Phong with
+         * @ref Shaders::Phong::Flag::DepthOnly. Default implementation calls
+         * @ref draw().
+         */
+        virtual void drawDepth(const MatrixTypeFor<dimensions, T>& transformationMatrix, Camera<dimensions, T>& camera) {
+            draw(transformationMatrix, camera);
+        }
+
+    private:
+        RangeTypeFor<dimensions, T> _boundingBox;
+        UnsignedLong _sortKey;
+        bool _hasBoundingBox;
 };
 
 /**
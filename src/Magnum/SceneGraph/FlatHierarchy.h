@@ -0,0 +1,397 @@
+#ifndef Magnum_SceneGraph_FlatHierarchy_h
+#define Magnum_SceneGraph_FlatHierarchy_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::FlatHierarchy
+ */
+
+#include <functional>
+#include <string>
+#include <vector>
+#include <Corrade/Containers/Containers.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/DimensionTraits.h"
+#include "Magnum/SceneGraph/SceneGraph.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Flat object hierarchy
+
+Keeps parent indices and local transformations of all objects in a subtree in
+contiguous arrays sorted in depth-first order, with the root object being
+first. Because every parent is stored before all its children, absolute
+transformations of the whole subtree can be computed in a single linear pass
+over the arrays, without chasing the parent/children pointers of particular
+@ref Object instances.
+
+The objects stay the authoritative source of the hierarchy and all usual
+@ref Object and @ref AbstractFeature APIs work as before --- the flat hierarchy
+only mirrors them. Local transformations are fetched from the objects in
+@ref update(), changes to the hierarchy itself (adding, removing or
+reparenting objects) are picked up only after calling @ref rebuild().
+
+@code{.cpp}
+Scene3D scene;
+// ...
+
+SceneGraph::FlatHierarchy<SceneGraph::MatrixTransformation3D> hierarchy{scene};
+
+// each frame
+hierarchy.setClean();
+@endcode
+
+@attention The hierarchy holds pointers to the objects, so it's not allowed to
+    call any function other than @ref rebuild() after some of them were
+    destroyed.
+
+@section SceneGraph-FlatHierarchy-snapshots Snapshots
+
+The whole hierarchy can be saved into a binary blob using @ref snapshot() and
+restored later either into the same hierarchy using @ref restore() or into a
+newly created set of objects using @ref fromSnapshot(). The blob contains the
+parent indices and local transformations as they are stored in the flat
+arrays, so restoring the hierarchy is just a copy of the transformation array
+instead of going through the @ref Object API for each object. Features can
+contribute their own data using a @ref SnapshotSaver and @ref SnapshotLoader,
+which are called for each object in the hierarchy:
+
+@code{.cpp}
+Containers::Array<char> data = hierarchy.snapshot(
+    [](const Object3D& object, std::string& out) {
+        for(auto* feature = object.features().first(); feature; feature = feature->nextFeature())
+            if(auto* body = dynamic_cast<const RigidBody*>(feature)) {
+                const Vector3 velocity = body->velocity();
+                out.append(reinterpret_cast<const char*>(&velocity), sizeof(Vector3));
+            }
+    });
+
+// ...
+
+hierarchy.restore(data, [](Object3D& object, Containers::ArrayView<const char> data) {
+    // ...
+    return true;
+});
+@endcode
+
+When creating the objects in @ref fromSnapshot(), all memory can be
+preallocated in one go using a @ref PoolAllocated object type and a custom
+@ref ObjectFactory:
+
+@code{.cpp}
+SceneGraph::PoolAllocated<ChunkObject>::pool().reserve(100000);
+
+Containers::Optional<SceneGraph::FlatHierarchy<SceneGraph::MatrixTransformation3D>> hierarchy = SceneGraph::FlatHierarchy<SceneGraph::MatrixTransformation3D>::fromSnapshot(scene, data, nullptr,
+    [](Object3D& parent) -> Object3D* { return new ChunkObject{&parent}; });
+@endcode
+
+The blob uses native byte order and type sizes, so it's meant for saving and
+restoring state on the same machine or between machines of the same
+architecture, not as a portable file format.
+
+@section SceneGraph-FlatHierarchy-explicit-specializations Explicit template specializations
+
+The following specializations are explicitly compiled into @ref SceneGraph
+library. For other specializations (e.g. using @ref Magnum::Double "Double"
+type or special transformation class) you have to use @ref FlatHierarchy.hpp
+implementation file to avoid linker errors. See also
+@ref compilation-speedup-hpp for more information.
+
+-   @ref DualComplexTransformation "FlatHierarchy<DualComplexTransformation>"
+-   @ref DualQuaternionTransformation "FlatHierarchy<DualQuaternionTransformation>"
+-   @ref MatrixTransformation2D "FlatHierarchy<MatrixTransformation2D>"
+-   @ref MatrixTransformation3D "FlatHierarchy<MatrixTransformation3D>"
+-   @ref RigidMatrixTransformation2D "FlatHierarchy<RigidMatrixTransformation2D>"
+-   @ref RigidMatrixTransformation3D "FlatHierarchy<RigidMatrixTransformation3D>"
+-   @ref TranslationTransformation2D "FlatHierarchy<TranslationTransformation2D>"
+-   @ref TranslationTransformation3D "FlatHierarchy<TranslationTransformation3D>"
+
+@see @ref Object::transformations()
+*/
+template<class Transformation> class FlatHierarchy {
+    public:
+        /** @brief Matrix type */
+        typedef MatrixTypeFor<Transformation::Dimensions, typename Transformation::Type> MatrixType;
+
+        /** @brief Underlying transformation type */
+        typedef typename Transformation::DataType DataType;
+
+        /** @brief Index of parent of the root object */
+        enum: UnsignedInt { NoParent = ~UnsignedInt{} };
+
+        /**
+         * @brief Snapshot saver
+         *
+         * Called by @ref snapshot() for each object in the hierarchy, appends
+         * data of the object features to the string.
+         */
+        typedef std::function<void(const Object<Transformation>&, std::string&)> SnapshotSaver;
+
+        /**
+         * @brief Snapshot loader
+         *
+         * Called by @ref restore() and @ref fromSnapshot() for each object in
+         * the hierarchy with data saved by @ref SnapshotSaver for given
+         * object. Returning @cpp false @ce aborts the restore.
+         */
+        typedef std::function<bool(Object<Transformation>&, Containers::ArrayView<const char>)> SnapshotLoader;
+
+        /**
+         * @brief Object factory
+         *
+         * Called by @ref fromSnapshot() to create a new object with given
+         * parent.
+         */
+        typedef std::function<Object<Transformation>*(Object<Transformation>&)> ObjectFactory;
+
+        /**
+         * @brief Create objects from a snapshot
+         * @param root      Root to add the objects to
+         * @param data      Data produced by @ref snapshot()
+         * @param loader    Loader for feature data or @cpp nullptr @ce
+         * @param factory   Factory for creating objects or @cpp nullptr @ce
+         *      to create plain @ref Object instances
+         *
+         * Creates all objects of the snapshotted hierarchy except its root as
+         * children of @p root, sets their transformations and calls
+         * @p loader for each of them. Transformation of the snapshotted root
+         * is applied to @p root and @p loader is called for it as well. After
+         * that, a hierarchy for @p root is created. If @p data are invalid,
+         * prints a message to @ref Error and returns
+         * @ref Containers::NullOpt without creating any object. If the
+         * loader fails, the objects created so far are kept and
+         * @ref Containers::NullOpt is returned.
+         */
+        static Containers::Optional<FlatHierarchy<Transformation>> fromSnapshot(Object<Transformation>& root, Containers::ArrayView<const char> data, const SnapshotLoader& loader = nullptr, const ObjectFactory& factory = nullptr);
+
+        /**
+         * @brief Constructor
+         * @param root      Root of the mirrored subtree
+         *
+         * Calls @ref rebuild().
+         */
+        explicit FlatHierarchy(Object<Transformation>& root);
+
+        /**
+         * @brief Construct from flat arrays
+         * @param root              Root to add the objects to
+         * @param parents           Parent indices into the arrays or
+         *      @cpp -1 @ce for direct children of @p root
+         * @param transformations   Transformations relative to parents
+         *
+         * Creates one new @ref Object for each item of the arrays in a single
+         * pass and then calls @ref rebuild(). The arrays are expected to have
+         * the same size and every parent index is expected to be smaller than
+         * index of the object itself, which matches the flat representation
+         * in @ref Trade::SceneData. The created objects are owned by
+         * @p root. If the arrays are in depth-first order, object at index
+         * @cpp i @ce of the arrays is at index @cpp i + 1 @ce in the
+         * hierarchy.
+         * @see @ref Trade-SceneData-flat
+         */
+        explicit FlatHierarchy(Object<Transformation>& root, const std::vector<Int>& parents, const std::vector<MatrixType>& transformations);
+
+        /** @brief Copying is not allowed */
+        FlatHierarchy(const FlatHierarchy<Transformation>&) = delete;
+
+        /** @brief Move constructor */
+        FlatHierarchy(FlatHierarchy<Transformation>&&) = default;
+
+        ~FlatHierarchy();
+
+        /** @brief Copying is not allowed */
+        FlatHierarchy<Transformation>& operator=(const FlatHierarchy<Transformation>&) = delete;
+
+        /** @brief Move assignment */
+        FlatHierarchy<Transformation>& operator=(FlatHierarchy<Transformation>&&) = default;
+
+        /** @brief Root object */
+        Object<Transformation>& root() { return *_objects.front(); }
+        const Object<Transformation>& root() const { return *_objects.front(); } /**< @overload */
+
+        /** @brief Count of objects in the hierarchy, including root */
+        std::size_t size() const { return _objects.size(); }
+
+        /**
+         * @brief Object at given index
+         *
+         * Objects are in depth-first order, index @cpp 0 @ce is the root.
+         */
+        Object<Transformation>& object(std::size_t id) { return *_objects[id]; }
+        const Object<Transformation>& object(std::size_t id) const { return *_objects[id]; } /**< @overload */
+
+        /**
+         * @brief Parent indices
+         *
+         * Parent index of the root is @ref NoParent, every other parent index
+         * is smaller than index of the object itself.
+         */
+        const std::vector<UnsignedInt>& parents() const { return _parents; }
+
+        /**
+         * @brief Subtree sizes
+         *
+         * Count of objects in subtree of each object, including the object
+         * itself. Subtree of object at index @p i spans the range
+         * @cpp [i, i + subtreeSizes()[i]) @ce.
+         */
+        const std::vector<UnsignedInt>& subtreeSizes() const { return _subtreeSizes; }
+
+        /**
+         * @brief Local transformations
+         *
+         * Transformations of all objects relative to their parents, as
+         * fetched by last call to @ref update() or set by
+         * @ref setTransformation().
+         */
+        const std::vector<DataType>& transformations() const { return _transformations; }
+
+        /**
+         * @brief Set local transformation of given object
+         * @return Reference to self (for method chaining)
+         *
+         * Updates both the stored transformation and the object itself.
+         */
+        FlatHierarchy<Transformation>& setTransformation(std::size_t id, const DataType& transformation);
+
+        /**
+         * @brief Fetch local transformations from the objects
+         *
+         * Needs to be called after transformation of some object was changed
+         * directly through the @ref Object API.
+         */
+        void update();
+
+        /**
+         * @brief Rebuild the hierarchy
+         *
+         * Traverses the subtree of the root object and rebuilds all arrays.
+         * Needs to be called after objects were added to, removed from or
+         * reparented in the subtree.
+         */
+        void rebuild();
+
+        /**
+         * @brief Absolute transformations of all objects
+         *
+         * Transformations are relative to parent of the root object and are
+         * premultiplied with @p initialTransformation, if specified. Computed
+         * in one linear pass from stored local transformations, call
+         * @ref update() beforehand if they might be out of date.
+         * @see @ref Object::transformations()
+         */
+        std::vector<DataType> absoluteTransformations(const DataType& initialTransformation = DataType()) const;
+
+        /**
+         * @brief Absolute transformations of all objects computed in parallel
+         *
+         * Subtrees of direct children of the root object are independent of
+         * each other and occupy contiguous ranges in the arrays, so they are
+         * distributed into batches of a similar size, one for each thread of
+         * @p pool, and processed concurrently. The operations done on each
+         * object are the same as in @ref absoluteTransformations(const DataType&) const,
+         * so the result is bit-for-bit equal to it.
+         */
+        std::vector<DataType> absoluteTransformations(const DataType& initialTransformation, ThreadPool& pool) const;
+
+        /**
+         * @brief Absolute transformation matrices of all objects
+         *
+         * Converted from @ref absoluteTransformations().
+         * @see @ref Object::transformationMatrices()
+         */
+        std::vector<MatrixType> absoluteTransformationMatrices(const MatrixType& initialTransformationMatrix = MatrixType()) const;
+
+        /**
+         * @brief Absolute transformation matrices of all objects computed in parallel
+         *
+         * Converted from @ref absoluteTransformations(const DataType&, ThreadPool&) const.
+         */
+        std::vector<MatrixType> absoluteTransformationMatrices(const MatrixType& initialTransformationMatrix, ThreadPool& pool) const;
+
+        /**
+         * @brief Clean absolute transformations of all dirty objects
+         *
+         * Calls @ref update(), computes absolute transformations of all
+         * objects in one pass and then cleans features of all dirty objects
+         * with them. Equivalent to @ref Object::setClean() called on all
+         * objects in the hierarchy, but without walking the hierarchy.
+         */
+        void setClean() { setCleanInternal(nullptr); }
+
+        /**
+         * @brief Clean absolute transformations of all dirty objects in parallel
+         *
+         * Same as @ref setClean(), but the absolute transformations are
+         * computed using @ref absoluteTransformations(const DataType&, ThreadPool&) const.
+         * Features are cleaned serially on the calling thread afterwards, so
+         * their @ref AbstractFeature::clean() implementation doesn't need to
+         * be thread-safe.
+         */
+        void setClean(ThreadPool& pool) { setCleanInternal(&pool); }
+
+        /**
+         * @brief Save a snapshot of the hierarchy
+         * @param saver     Saver for feature data or @cpp nullptr @ce
+         *
+         * Saves parent indices and local transformations of all objects, in
+         * the state of the last @ref update() call, together with data
+         * appended by @p saver for each object.
+         * @see @ref SceneGraph-FlatHierarchy-snapshots
+         */
+        Containers::Array<char> snapshot(const SnapshotSaver& saver = nullptr) const;
+
+        /**
+         * @brief Restore a snapshot of the hierarchy
+         * @param data      Data produced by @ref snapshot()
+         * @param loader    Loader for feature data or @cpp nullptr @ce
+         *
+         * Expects that the snapshot was made from a hierarchy with the same
+         * structure, i.e. the same object count and parent indices. Copies
+         * the transformations from @p data, applies them to the objects and
+         * calls @p loader for each object. On failure prints a message to
+         * @ref Error and returns @cpp false @ce. Nothing is changed if the
+         * data are invalid, if the loader fails, the objects processed so far
+         * stay restored.
+         * @see @ref SceneGraph-FlatHierarchy-snapshots
+         */
+        bool restore(Containers::ArrayView<const char> data, const SnapshotLoader& loader = nullptr);
+
+    private:
+        void computeAbsoluteTransformations(DataType* out, std::size_t begin, std::size_t end) const;
+        void computeAbsoluteTransformations(DataType* out, const DataType& initialTransformation, ThreadPool* pool) const;
+        void setCleanInternal(ThreadPool* pool);
+
+        std::vector<Object<Transformation>*> _objects;
+        std::vector<UnsignedInt> _parents, _subtreeSizes;
+        std::vector<DataType> _transformations;
+};
+
+}}
+
+#endif
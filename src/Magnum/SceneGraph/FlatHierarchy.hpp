@@ -0,0 +1,357 @@
+#ifndef Magnum_SceneGraph_FlatHierarchy_hpp
+#define Magnum_SceneGraph_FlatHierarchy_hpp
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief @ref compilation-speedup-hpp "Template implementation" for @ref FlatHierarchy.h
+ */
+
+#include <cstring>
+#include <utility>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/ThreadPool.h"
+#include "Magnum/SceneGraph/FlatHierarchy.h"
+#include "Magnum/SceneGraph/Object.h"
+
+namespace Magnum { namespace SceneGraph {
+
+namespace Implementation {
+
+/* Snapshot layout: the header, parent indices, offsets of feature data for
+   each object plus one past the end, local transformations and feature data.
+   Everything in native byte order. */
+struct FlatHierarchySnapshotHeader {
+    char magic[4];
+    UnsignedShort dimensions;
+    UnsignedShort dataTypeSize;
+    UnsignedInt objectCount;
+    UnsignedInt featureDataSize;
+};
+
+constexpr const char FlatHierarchySnapshotMagic[4]{'M', 'S', 'S', '1'};
+
+/* Checks the snapshot and returns object count or ~0 if it's invalid */
+template<class Transformation> UnsignedInt checkSnapshot(const char* const function, const Containers::ArrayView<const char> data) {
+    typedef typename Transformation::DataType DataType;
+
+    FlatHierarchySnapshotHeader header;
+    if(data.size() < sizeof(header)) {
+        Error() << "SceneGraph::FlatHierarchy::" << Debug::nospace << function << Debug::nospace << "(): snapshot too short, got" << data.size() << "bytes";
+        return ~UnsignedInt{};
+    }
+
+    std::memcpy(&header, data.data(), sizeof(header));
+    if(std::memcmp(header.magic, FlatHierarchySnapshotMagic, 4) != 0) {
+        Error() << "SceneGraph::FlatHierarchy::" << Debug::nospace << function << Debug::nospace << "(): invalid snapshot signature";
+        return ~UnsignedInt{};
+    }
+
+    if(header.dimensions != Transformation::Dimensions || header.dataTypeSize != sizeof(DataType)) {
+        Error() << "SceneGraph::FlatHierarchy::" << Debug::nospace << function << Debug::nospace << "(): expected a snapshot of" << Transformation::Dimensions << "dimensions and" << sizeof(DataType) << "bytes per transformation but got" << UnsignedInt(header.dimensions) << "and" << UnsignedInt(header.dataTypeSize);
+        return ~UnsignedInt{};
+    }
+
+    const std::size_t expectedSize = sizeof(header) + header.objectCount*(sizeof(UnsignedInt) + sizeof(DataType)) + (header.objectCount + 1)*sizeof(UnsignedInt) + header.featureDataSize;
+    if(!header.objectCount || data.size() != expectedSize) {
+        Error() << "SceneGraph::FlatHierarchy::" << Debug::nospace << function << Debug::nospace << "(): expected" << expectedSize << "bytes for" << header.objectCount << "objects but got" << data.size();
+        return ~UnsignedInt{};
+    }
+
+    /* Parents have to be before children, offsets have to be monotonic */
+    const char* const parents = data.data() + sizeof(header);
+    const char* const offsets = parents + header.objectCount*sizeof(UnsignedInt);
+    UnsignedInt previousOffset;
+    std::memcpy(&previousOffset, offsets, sizeof(UnsignedInt));
+    if(previousOffset != 0) {
+        Error() << "SceneGraph::FlatHierarchy::" << Debug::nospace << function << Debug::nospace << "(): invalid feature data offset";
+        return ~UnsignedInt{};
+    }
+    for(UnsignedInt i = 0; i != header.objectCount; ++i) {
+        UnsignedInt parent, offset;
+        std::memcpy(&parent, parents + i*sizeof(UnsignedInt), sizeof(UnsignedInt));
+        std::memcpy(&offset, offsets + (i + 1)*sizeof(UnsignedInt), sizeof(UnsignedInt));
+        if((i == 0) != (parent == FlatHierarchy<Transformation>::NoParent) || (i && parent >= i) || offset < previousOffset || offset > header.featureDataSize) {
+            Error() << "SceneGraph::FlatHierarchy::" << Debug::nospace << function << Debug::nospace << "(): invalid parent or feature data of object" << i;
+            return ~UnsignedInt{};
+        }
+        previousOffset = offset;
+    }
+
+    return header.objectCount;
+}
+
+/* Calls the loader for all objects, expects the data were checked already */
+template<class Transformation> bool loadSnapshotFeatures(const Containers::ArrayView<const char> data, Object<Transformation>* const* const objects, const UnsignedInt objectCount, const typename FlatHierarchy<Transformation>::SnapshotLoader& loader) {
+    if(!loader) return true;
+
+    const char* const offsets = data.data() + sizeof(FlatHierarchySnapshotHeader) + objectCount*sizeof(UnsignedInt);
+    const char* const featureData = offsets + (objectCount + 1)*sizeof(UnsignedInt) + objectCount*sizeof(typename Transformation::DataType);
+    for(UnsignedInt i = 0; i != objectCount; ++i) {
+        UnsignedInt range[2];
+        std::memcpy(range, offsets + i*sizeof(UnsignedInt), sizeof(range));
+        if(!loader(*objects[i], {featureData + range[0], range[1] - range[0]}))
+            return false;
+    }
+
+    return true;
+}
+
+}
+
+template<class Transformation> FlatHierarchy<Transformation>::FlatHierarchy(Object<Transformation>& root): _objects{&root} {
+    rebuild();
+}
+
+template<class Transformation> FlatHierarchy<Transformation>::FlatHierarchy(Object<Transformation>& root, const std::vector<Int>& parents, const std::vector<MatrixType>& transformations): _objects{&root} {
+    CORRADE_ASSERT(parents.size() == transformations.size(),
+        "SceneGraph::FlatHierarchy: expected" << parents.size() << "transformations but got" << transformations.size(), );
+
+    /* Parents are always before children, so they are already created when
+       a child needs them */
+    std::vector<Object<Transformation>*> created(parents.size());
+    for(std::size_t i = 0; i != parents.size(); ++i) {
+        CORRADE_ASSERT(parents[i] < Int(i),
+            "SceneGraph::FlatHierarchy: parent" << parents[i] << "of object" << i << "is not stored before it", );
+        created[i] = new Object<Transformation>{parents[i] < 0 ? &root : created[parents[i]]};
+        created[i]->setTransformation(Implementation::Transformation<Transformation>::fromMatrix(transformations[i]));
+    }
+
+    rebuild();
+}
+
+template<class Transformation> FlatHierarchy<Transformation>::~FlatHierarchy() = default;
+
+template<class Transformation> Containers::Optional<FlatHierarchy<Transformation>> FlatHierarchy<Transformation>::fromSnapshot(Object<Transformation>& root, const Containers::ArrayView<const char> data, const SnapshotLoader& loader, const ObjectFactory& factory) {
+    const UnsignedInt objectCount = Implementation::checkSnapshot<Transformation>("fromSnapshot", data);
+    if(objectCount == ~UnsignedInt{}) return Containers::NullOpt;
+
+    const char* const parents = data.data() + sizeof(Implementation::FlatHierarchySnapshotHeader);
+    const char* const transformations = parents + (2*objectCount + 1)*sizeof(UnsignedInt);
+
+    /* Parents are always before children, so they are already created when
+       a child needs them */
+    std::vector<Object<Transformation>*> created(objectCount);
+    created[0] = &root;
+    for(UnsignedInt i = 0; i != objectCount; ++i) {
+        if(i) {
+            UnsignedInt parent;
+            std::memcpy(&parent, parents + i*sizeof(UnsignedInt), sizeof(UnsignedInt));
+            created[i] = factory ? factory(*created[parent]) : new Object<Transformation>{created[parent]};
+        }
+
+        DataType transformation;
+        std::memcpy(&transformation, transformations + i*sizeof(DataType), sizeof(DataType));
+        created[i]->setTransformation(transformation);
+    }
+
+    if(!Implementation::loadSnapshotFeatures<Transformation>(data, created.data(), objectCount, loader))
+        return Containers::NullOpt;
+
+    return Containers::Optional<FlatHierarchy<Transformation>>{Containers::InPlaceInit, root};
+}
+
+template<class Transformation> void FlatHierarchy<Transformation>::rebuild() {
+    Object<Transformation>* const root = _objects.front();
+    _objects.clear();
+    _parents.clear();
+
+    /* Depth-first traversal. Children are pushed in reverse so they end up in
+       the arrays in the same order as in the children list. */
+    std::vector<std::pair<Object<Transformation>*, UnsignedInt>> stack;
+    stack.emplace_back(root, UnsignedInt(NoParent));
+    while(!stack.empty()) {
+        const std::pair<Object<Transformation>*, UnsignedInt> top = stack.back();
+        stack.pop_back();
+
+        const UnsignedInt id = _objects.size();
+        _objects.push_back(top.first);
+        _parents.push_back(top.second);
+
+        for(Object<Transformation>* child = top.first->children().last(); child; child = child->previousSibling())
+            stack.emplace_back(child, id);
+    }
+
+    /* Sum subtree sizes from leafs up, parents are always before children */
+    _subtreeSizes.assign(_objects.size(), 1);
+    for(std::size_t i = _objects.size() - 1; i != 0; --i)
+        _subtreeSizes[_parents[i]] += _subtreeSizes[i];
+
+    update();
+}
+
+template<class Transformation> void FlatHierarchy<Transformation>::update() {
+    _transformations.resize(_objects.size());
+    for(std::size_t i = 0; i != _objects.size(); ++i)
+        _transformations[i] = _objects[i]->transformation();
+}
+
+template<class Transformation> FlatHierarchy<Transformation>& FlatHierarchy<Transformation>::setTransformation(const std::size_t id, const DataType& transformation) {
+    CORRADE_ASSERT(id < _objects.size(),
+        "SceneGraph::FlatHierarchy::setTransformation(): index" << id << "out of range for" << _objects.size() << "objects", *this);
+    _transformations[id] = transformation;
+    _objects[id]->setTransformation(transformation);
+    return *this;
+}
+
+template<class Transformation> void FlatHierarchy<Transformation>::computeAbsoluteTransformations(DataType* const out, const std::size_t begin, const std::size_t end) const {
+    for(std::size_t i = begin; i != end; ++i)
+        out[i] = Implementation::Transformation<Transformation>::compose(out[_parents[i]], _transformations[i]);
+}
+
+template<class Transformation> void FlatHierarchy<Transformation>::computeAbsoluteTransformations(DataType* const out, const DataType& initialTransformation, ThreadPool* const pool) const {
+    out[0] = Implementation::Transformation<Transformation>::compose(initialTransformation, _transformations[0]);
+
+    /* Nothing to parallelize */
+    const std::size_t threadCount = pool ? pool->threadCount() : 1;
+    if(threadCount <= 1 || _transformations.size() <= 2) {
+        computeAbsoluteTransformations(out, 1, _transformations.size());
+        return;
+    }
+
+    /* Distribute subtrees of root children into batches of roughly the same
+       size. Objects in each batch depend only on the root or on objects in the
+       same batch. */
+    const std::size_t batchSize = (_transformations.size() - 1 + threadCount - 1)/threadCount;
+    std::vector<std::pair<std::size_t, std::size_t>> batches;
+    std::size_t begin = 1;
+    for(std::size_t child = 1; child != _transformations.size(); child += _subtreeSizes[child]) {
+        const std::size_t end = child + _subtreeSizes[child];
+        if(end - begin >= batchSize) {
+            batches.emplace_back(begin, end);
+            begin = end;
+        }
+    }
+    if(begin != _transformations.size())
+        batches.emplace_back(begin, _transformations.size());
+
+    pool->parallelFor(batches.size(), 1, [this, out, &batches](const std::size_t begin, const std::size_t end) {
+        for(std::size_t i = begin; i != end; ++i)
+            computeAbsoluteTransformations(out, batches[i].first, batches[i].second);
+    });
+}
+
+template<class Transformation> Containers::Array<char> FlatHierarchy<Transformation>::snapshot(const SnapshotSaver& saver) const {
+    /* Collect feature data first to know the total size */
+    std::string featureData;
+    std::vector<UnsignedInt> offsets;
+    offsets.reserve(_objects.size() + 1);
+    offsets.push_back(0);
+    for(Object<Transformation>* object: _objects) {
+        if(saver) saver(*object, featureData);
+        offsets.push_back(featureData.size());
+    }
+
+    const Implementation::FlatHierarchySnapshotHeader header{
+        {Implementation::FlatHierarchySnapshotMagic[0],
+         Implementation::FlatHierarchySnapshotMagic[1],
+         Implementation::FlatHierarchySnapshotMagic[2],
+         Implementation::FlatHierarchySnapshotMagic[3]},
+        UnsignedShort(Transformation::Dimensions), UnsignedShort(sizeof(DataType)),
+        UnsignedInt(_objects.size()), UnsignedInt(featureData.size())};
+
+    Containers::Array<char> out{Containers::NoInit, sizeof(header) + _parents.size()*sizeof(UnsignedInt) + offsets.size()*sizeof(UnsignedInt) + _transformations.size()*sizeof(DataType) + featureData.size()};
+    char* it = out.data();
+    std::memcpy(it, &header, sizeof(header));
+    it += sizeof(header);
+    std::memcpy(it, _parents.data(), _parents.size()*sizeof(UnsignedInt));
+    it += _parents.size()*sizeof(UnsignedInt);
+    std::memcpy(it, offsets.data(), offsets.size()*sizeof(UnsignedInt));
+    it += offsets.size()*sizeof(UnsignedInt);
+    std::memcpy(it, _transformations.data(), _transformations.size()*sizeof(DataType));
+    it += _transformations.size()*sizeof(DataType);
+    std::memcpy(it, featureData.data(), featureData.size());
+
+    return out;
+}
+
+template<class Transformation> bool FlatHierarchy<Transformation>::restore(const Containers::ArrayView<const char> data, const SnapshotLoader& loader) {
+    const UnsignedInt objectCount = Implementation::checkSnapshot<Transformation>("restore", data);
+    if(objectCount == ~UnsignedInt{}) return false;
+
+    const char* const parents = data.data() + sizeof(Implementation::FlatHierarchySnapshotHeader);
+    if(objectCount != _objects.size() || std::memcmp(parents, _parents.data(), objectCount*sizeof(UnsignedInt)) != 0) {
+        Error() << "SceneGraph::FlatHierarchy::restore(): snapshot of" << objectCount << "objects doesn't match hierarchy of" << _objects.size() << "objects";
+        return false;
+    }
+
+    std::memcpy(_transformations.data(), parents + (2*objectCount + 1)*sizeof(UnsignedInt), objectCount*sizeof(DataType));
+    for(std::size_t i = 0; i != _objects.size(); ++i)
+        _objects[i]->setTransformation(_transformations[i]);
+
+    return Implementation::loadSnapshotFeatures<Transformation>(data, _objects.data(), objectCount, loader);
+}
+
+template<class Transformation> auto FlatHierarchy<Transformation>::absoluteTransformations(const DataType& initialTransformation) const -> std::vector<DataType> {
+    std::vector<DataType> out(_transformations.size());
+    computeAbsoluteTransformations(out.data(), initialTransformation, nullptr);
+    return out;
+}
+
+template<class Transformation> auto FlatHierarchy<Transformation>::absoluteTransformations(const DataType& initialTransformation, ThreadPool& pool) const -> std::vector<DataType> {
+    std::vector<DataType> out(_transformations.size());
+    computeAbsoluteTransformations(out.data(), initialTransformation, &pool);
+    return out;
+}
+
+template<class Transformation> auto FlatHierarchy<Transformation>::absoluteTransformationMatrices(const MatrixType& initialTransformationMatrix) const -> std::vector<MatrixType> {
+    const std::vector<DataType> transformations = absoluteTransformations(Implementation::Transformation<Transformation>::fromMatrix(initialTransformationMatrix));
+    std::vector<MatrixType> out(transformations.size());
+    for(std::size_t i = 0; i != transformations.size(); ++i)
+        out[i] = Implementation::Transformation<Transformation>::toMatrix(transformations[i]);
+    return out;
+}
+
+template<class Transformation> auto FlatHierarchy<Transformation>::absoluteTransformationMatrices(const MatrixType& initialTransformationMatrix, ThreadPool& pool) const -> std::vector<MatrixType> {
+    const std::vector<DataType> transformations = absoluteTransformations(Implementation::Transformation<Transformation>::fromMatrix(initialTransformationMatrix), pool);
+    std::vector<MatrixType> out(transformations.size());
+    for(std::size_t i = 0; i != transformations.size(); ++i)
+        out[i] = Implementation::Transformation<Transformation>::toMatrix(transformations[i]);
+    return out;
+}
+
+template<class Transformation> void FlatHierarchy<Transformation>::setCleanInternal(ThreadPool* const pool) {
+    update();
+
+    /* Take absolute transformation of root parent into account */
+    Object<Transformation>* const rootParent = _objects.front()->parent();
+    std::vector<DataType> transformations(_transformations.size());
+    computeAbsoluteTransformations(transformations.data(), rootParent ? rootParent->absoluteTransformation() : DataType(), pool);
+
+    for(std::size_t i = 0; i != _objects.size(); ++i) {
+        if(!_objects[i]->isDirty()) continue;
+
+        _objects[i]->setCleanInternal(transformations[i]);
+        CORRADE_ASSERT(!_objects[i]->isDirty(), "SceneGraph::FlatHierarchy::setClean(): original implementation was not called", );
+    }
+}
+
+}}
+
+#endif
@@ -0,0 +1,153 @@
+#ifndef Magnum_SceneGraph_InstancedDrawable_h
+#define Magnum_SceneGraph_InstancedDrawable_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::InstancedDrawable, alias @ref Magnum::SceneGraph::BasicInstancedDrawable2D, @ref Magnum::SceneGraph::BasicInstancedDrawable3D, typedef @ref Magnum::SceneGraph::InstancedDrawable2D, @ref Magnum::SceneGraph::InstancedDrawable3D
+ */
+
+#include "Magnum/Math/Color.h"
+#include "Magnum/SceneGraph/AbstractGroupedFeature.h"
+#include "Magnum/SceneGraph/visibility.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Instanced drawable
+
+One instance of a mesh drawn by @ref InstancedDrawableGroup. Unlike
+@ref Drawable it doesn't have any @ref Drawable::draw() "draw()" function to
+implement --- all instances in a group share the same mesh and shader and
+differ only in the transformation and color, so the whole group is drawn with
+a single instanced draw call using @ref InstancedDrawableGroup::draw().
+
+@code{.cpp}
+SceneGraph::InstancedDrawableGroup3D instances;
+
+for(std::size_t i = 0; i != 5000; ++i) {
+    Object3D* object = new Object3D{&scene};
+    object->translate(positions[i]);
+    (new SceneGraph::InstancedDrawable3D{*object, &instances})
+        ->setColor(colors[i]);
+}
+@endcode
+
+@section SceneGraph-InstancedDrawable-explicit-specializations Explicit template specializations
+
+The following specializations are explicitly compiled into @ref SceneGraph
+library. For other specializations (e.g. using @ref Magnum::Double "Double"
+type) you have to use @ref InstancedDrawable.hpp implementation file to avoid
+linker errors. See also @ref compilation-speedup-hpp for more information.
+
+-   @ref InstancedDrawable2D
+-   @ref InstancedDrawable3D
+
+@see @ref scenegraph, @ref BasicInstancedDrawable2D,
+    @ref BasicInstancedDrawable3D, @ref InstancedDrawable2D,
+    @ref InstancedDrawable3D, @ref InstancedDrawableGroup
+*/
+template<UnsignedInt dimensions, class T> class InstancedDrawable: public AbstractGroupedFeature<dimensions, InstancedDrawable<dimensions, T>, T> {
+    public:
+        /**
+         * @brief Constructor
+         * @param object    Object this instance belongs to
+         * @param group     Group this instance belongs to
+         *
+         * Adds the feature to the object and also to the group, if specified.
+         * Otherwise you can use @ref InstancedDrawableGroup::add(). The
+         * color is set to white.
+         */
+        explicit InstancedDrawable(AbstractObject<dimensions, T>& object, InstancedDrawableGroup<dimensions, T>* group = nullptr);
+
+        /**
+         * @brief Group containing this instance
+         *
+         * If the instance doesn't belong to any group, returns
+         * @cpp nullptr @ce.
+         */
+        InstancedDrawableGroup<dimensions, T>* instances();
+
+        /** @overload */
+        const InstancedDrawableGroup<dimensions, T>* instances() const;
+
+        /** @brief Instance color */
+        Color4 color() const { return _color; }
+
+        /**
+         * @brief Set instance color
+         * @return Reference to self (for method chaining)
+         *
+         * Passed to the shader as a per-instance attribute, see
+         * @ref InstancedDrawableGroup::InstanceData.
+         */
+        InstancedDrawable<dimensions, T>& setColor(const Color4& color) {
+            _color = color;
+            return *this;
+        }
+
+    private:
+        Color4 _color;
+};
+
+/**
+@brief Instanced drawable for two-dimensional scenes
+
+Convenience alternative to @cpp InstancedDrawable<2, T> @ce. See
+@ref InstancedDrawable for more information.
+@see @ref InstancedDrawable2D, @ref BasicInstancedDrawable3D
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<class T> using BasicInstancedDrawable2D = InstancedDrawable<2, T>;
+#endif
+
+/**
+@brief Instanced drawable for two-dimensional float scenes
+
+@see @ref InstancedDrawable3D
+*/
+typedef BasicInstancedDrawable2D<Float> InstancedDrawable2D;
+
+/**
+@brief Instanced drawable for three-dimensional scenes
+
+Convenience alternative to @cpp InstancedDrawable<3, T> @ce. See
+@ref InstancedDrawable for more information.
+@see @ref InstancedDrawable3D, @ref BasicInstancedDrawable2D
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<class T> using BasicInstancedDrawable3D = InstancedDrawable<3, T>;
+#endif
+
+/**
+@brief Instanced drawable for three-dimensional float scenes
+
+@see @ref InstancedDrawable2D
+*/
+typedef BasicInstancedDrawable3D<Float> InstancedDrawable3D;
+
+}}
+
+#endif
@@ -0,0 +1,107 @@
+#ifndef Magnum_SceneGraph_InstancedDrawable_hpp
+#define Magnum_SceneGraph_InstancedDrawable_hpp
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief @ref compilation-speedup-hpp "Template implementation" for @ref InstancedDrawable.h and @ref InstancedDrawableGroup.h
+ */
+
+#include "Magnum/Buffer.h"
+#include "Magnum/Mesh.h"
+#include "Magnum/SceneGraph/AbstractObject.h"
+#include "Magnum/SceneGraph/Camera.hpp"
+#include "Magnum/SceneGraph/InstancedDrawable.h"
+#include "Magnum/SceneGraph/InstancedDrawableGroup.h"
+
+namespace Magnum { namespace SceneGraph {
+
+template<UnsignedInt dimensions, class T> InstancedDrawable<dimensions, T>::InstancedDrawable(AbstractObject<dimensions, T>& object, InstancedDrawableGroup<dimensions, T>* group): AbstractGroupedFeature<dimensions, InstancedDrawable<dimensions, T>, T>{object, group}, _color{1.0f} {}
+
+template<UnsignedInt dimensions, class T> InstancedDrawableGroup<dimensions, T>* InstancedDrawable<dimensions, T>::instances() {
+    return static_cast<InstancedDrawableGroup<dimensions, T>*>(AbstractGroupedFeature<dimensions, InstancedDrawable<dimensions, T>, T>::group());
+}
+
+template<UnsignedInt dimensions, class T> const InstancedDrawableGroup<dimensions, T>* InstancedDrawable<dimensions, T>::instances() const {
+    return static_cast<const InstancedDrawableGroup<dimensions, T>*>(AbstractGroupedFeature<dimensions, InstancedDrawable<dimensions, T>, T>::group());
+}
+
+template<UnsignedInt dimensions, class T> InstancedDrawableGroup<dimensions, T>::InstancedDrawableGroup(): _hasBoundingBox{false} {}
+
+template<UnsignedInt dimensions, class T> InstancedDrawableGroup<dimensions, T>::~InstancedDrawableGroup() = default;
+
+template<UnsignedInt dimensions, class T> std::size_t InstancedDrawableGroup<dimensions, T>::updateInstanceData(Camera<dimensions, T>& camera) {
+    _instanceData.clear();
+
+    AbstractObject<dimensions, T>* scene = camera.object().scene();
+    CORRADE_ASSERT(scene, "SceneGraph::InstancedDrawableGroup::updateInstanceData(): camera is not part of any scene", 0);
+
+    /* Compute transformations of all instances relative to the camera in one
+       pass. The storage is reused across calls to avoid allocations. */
+    const std::size_t count = this->size();
+    _objects.clear();
+    for(std::size_t i = 0; i != count; ++i)
+        _objects.push_back((*this)[i].object());
+    _transformations.resize(count);
+    scene->transformationMatrices(_objects, {_transformations.data(), _transformations.size()}, camera.cameraMatrix());
+
+    /* Without a bounding box all instances are visible */
+    _instanceData.reserve(count);
+    if(!_hasBoundingBox) {
+        for(std::size_t i = 0; i != count; ++i)
+            _instanceData.push_back({_transformations[i], (*this)[i].color()});
+        return _instanceData.size();
+    }
+
+    /* Otherwise bring the shared box to camera space for each instance and
+       cull all of them at once, same as Camera::drawCulled() */
+    _boxes.resize(count);
+    for(std::size_t i = 0; i != count; ++i)
+        _boxes[i] = Implementation::CameraCulling<dimensions, T>::transformBox(_transformations[i], _boundingBox);
+    if(_visible.size() < count)
+        _visible = Containers::Array<bool>{count};
+    Implementation::CameraCulling<dimensions, T>::cullInto(_boxes, camera.projectionMatrix(), {_visible.data(), count});
+
+    /* Gather the visible instances */
+    for(std::size_t i = 0; i != count; ++i)
+        if(_visible[i])
+            _instanceData.push_back({_transformations[i], (*this)[i].color()});
+
+    return _instanceData.size();
+}
+
+template<UnsignedInt dimensions, class T> std::size_t InstancedDrawableGroup<dimensions, T>::draw(Camera<dimensions, T>& camera, Mesh& mesh, Buffer& instanceBuffer, AbstractShaderProgram& shader) {
+    const std::size_t count = updateInstanceData(camera);
+    if(!count) return 0;
+
+    instanceBuffer.setData(_instanceData, BufferUsage::StreamDraw);
+    mesh.setInstanceCount(Int(count));
+    mesh.draw(shader);
+    return count;
+}
+
+}}
+
+#endif
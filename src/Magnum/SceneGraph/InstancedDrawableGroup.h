@@ -0,0 +1,233 @@
+#ifndef Magnum_SceneGraph_InstancedDrawableGroup_h
+#define Magnum_SceneGraph_InstancedDrawableGroup_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::InstancedDrawableGroup, alias @ref Magnum::SceneGraph::BasicInstancedDrawableGroup2D, @ref Magnum::SceneGraph::BasicInstancedDrawableGroup3D, typedef @ref Magnum::SceneGraph::InstancedDrawableGroup2D, @ref Magnum::SceneGraph::InstancedDrawableGroup3D
+ */
+
+#include <functional>
+#include <vector>
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/DimensionTraits.h"
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/SceneGraph/FeatureGroup.h"
+#include "Magnum/SceneGraph/visibility.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Group of instanced drawables
+
+Draws all @ref InstancedDrawable features in the group with a single instanced
+draw call. Each frame, transformations of all instances relative to the camera
+are gathered together with their colors into one contiguous array of
+@ref InstanceData, which is then streamed into an instance buffer. The mesh is
+expected to have the buffer attached using @ref Mesh::addVertexBufferInstanced()
+with divisor set to @cpp 1 @ce and the shader to take the transformation and
+color as per-instance attributes:
+
+@code{.cpp}
+struct InstancedShader: AbstractShaderProgram {
+    typedef Attribute<0, Vector3> Position;
+    typedef Attribute<1, Matrix4> TransformationMatrix;
+    typedef Attribute<5, Color4> Color;
+
+    // ...
+};
+
+Buffer instanceBuffer;
+mesh.addVertexBufferInstanced(instanceBuffer, 1, 0,
+    InstancedShader::TransformationMatrix{},
+    InstancedShader::Color{});
+
+// each frame
+shader.setProjectionMatrix(camera.projectionMatrix());
+instances.draw(camera, mesh, instanceBuffer, shader);
+@endcode
+
+If a bounding box common to all instances is set using @ref setBoundingBox(),
+instances outside of the camera frustum are not submitted at all, similarly to
+@ref Camera::drawCulled().
+
+@section SceneGraph-InstancedDrawableGroup-explicit-specializations Explicit template specializations
+
+The following specializations are explicitly compiled into @ref SceneGraph
+library. For other specializations (e.g. using @ref Magnum::Double "Double"
+type) you have to use @ref InstancedDrawable.hpp implementation file to avoid
+linker errors. See also @ref compilation-speedup-hpp for more information.
+
+-   @ref InstancedDrawableGroup2D
+-   @ref InstancedDrawableGroup3D
+
+@see @ref scenegraph, @ref BasicInstancedDrawableGroup2D,
+    @ref BasicInstancedDrawableGroup3D, @ref InstancedDrawableGroup2D,
+    @ref InstancedDrawableGroup3D
+*/
+template<UnsignedInt dimensions, class T> class InstancedDrawableGroup: public FeatureGroup<dimensions, InstancedDrawable<dimensions, T>, T> {
+    public:
+        /**
+         * @brief Per-instance data
+         *
+         * Layout of one instance in the instance buffer, tightly packed.
+         */
+        struct InstanceData {
+            /** @brief Transformation matrix relative to the camera */
+            MatrixTypeFor<dimensions, T> transformationMatrix;
+
+            /** @brief Instance color */
+            Color4 color;
+        };
+
+        /** @brief Constructor */
+        explicit InstancedDrawableGroup();
+
+        ~InstancedDrawableGroup();
+
+        /** @brief Whether the group has a bounding box */
+        bool hasBoundingBox() const { return _hasBoundingBox; }
+
+        /**
+         * @brief Bounding box of one instance
+         *
+         * In local coordinate system of instance objects. Returns
+         * zero-sized box on the origin if no bounding box was set.
+         */
+        RangeTypeFor<dimensions, T> boundingBox() const { return _boundingBox; }
+
+        /**
+         * @brief Set bounding box of one instance
+         * @return Reference to self (for method chaining)
+         *
+         * Enables culling of the instances, see @ref updateInstanceData().
+         * @see @ref resetBoundingBox(), @ref Drawable::setBoundingBox()
+         */
+        InstancedDrawableGroup<dimensions, T>& setBoundingBox(const RangeTypeFor<dimensions, T>& box) {
+            _boundingBox = box;
+            _hasBoundingBox = true;
+            return *this;
+        }
+
+        /**
+         * @brief Reset bounding box
+         * @return Reference to self (for method chaining)
+         *
+         * Disables culling of the instances.
+         */
+        InstancedDrawableGroup<dimensions, T>& resetBoundingBox() {
+            _boundingBox = {};
+            _hasBoundingBox = false;
+            return *this;
+        }
+
+        /**
+         * @brief Instance data
+         *
+         * Filled by last call to @ref updateInstanceData() or @ref draw().
+         */
+        const std::vector<InstanceData>& instanceData() const { return _instanceData; }
+
+        /**
+         * @brief Update instance data
+         * @return Count of visible instances
+         *
+         * Computes transformations of all instances relative to @p camera
+         * in a single pass and fills @ref instanceData() with them and
+         * instance colors, in order in which the instances were added to the
+         * group. If a bounding box is set, instances outside of the camera
+         * frustum are skipped. Expects that the camera is part of a scene.
+         */
+        std::size_t updateInstanceData(Camera<dimensions, T>& camera);
+
+        /**
+         * @brief Draw the instances
+         * @return Count of drawn instances
+         *
+         * Calls @ref updateInstanceData(), uploads the data to
+         * @p instanceBuffer with @ref BufferUsage::StreamDraw, sets
+         * @ref Mesh::setInstanceCount() "instance count" of @p mesh and draws
+         * it with @p shader. If no instance is visible, nothing is drawn.
+         * @requires_gl33 Extension @extension{ARB,instanced_arrays}
+         * @requires_gles30 Extension @extension{ANGLE,instanced_arrays},
+         *      @extension{EXT,instanced_arrays} or
+         *      @extension{NV,instanced_arrays} in OpenGL ES 2.0.
+         * @requires_webgl20 Extension @webgl_extension{ANGLE,instanced_arrays}
+         *      in WebGL 1.0.
+         */
+        std::size_t draw(Camera<dimensions, T>& camera, Mesh& mesh, Buffer& instanceBuffer, AbstractShaderProgram& shader);
+
+    private:
+        std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>> _objects;
+        std::vector<MatrixTypeFor<dimensions, T>> _transformations;
+        std::vector<InstanceData> _instanceData;
+        std::vector<RangeTypeFor<dimensions, T>> _boxes;
+        Containers::Array<bool> _visible;
+        RangeTypeFor<dimensions, T> _boundingBox;
+        bool _hasBoundingBox;
+};
+
+/**
+@brief Group of instanced drawables for two-dimensional scenes
+
+Convenience alternative to @cpp InstancedDrawableGroup<2, T> @ce. See
+@ref InstancedDrawableGroup for more information.
+@see @ref InstancedDrawableGroup2D, @ref BasicInstancedDrawableGroup3D
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<class T> using BasicInstancedDrawableGroup2D = InstancedDrawableGroup<2, T>;
+#endif
+
+/**
+@brief Group of instanced drawables for two-dimensional float scenes
+
+@see @ref InstancedDrawableGroup3D
+*/
+typedef BasicInstancedDrawableGroup2D<Float> InstancedDrawableGroup2D;
+
+/**
+@brief Group of instanced drawables for three-dimensional scenes
+
+Convenience alternative to @cpp InstancedDrawableGroup<3, T> @ce. See
+@ref InstancedDrawableGroup for more information.
+@see @ref InstancedDrawableGroup3D, @ref BasicInstancedDrawableGroup2D
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<class T> using BasicInstancedDrawableGroup3D = InstancedDrawableGroup<3, T>;
+#endif
+
+/**
+@brief Group of instanced drawables for three-dimensional float scenes
+
+@see @ref InstancedDrawableGroup2D
+*/
+typedef BasicInstancedDrawableGroup3D<Float> InstancedDrawableGroup3D;
+
+}}
+
+#endif
@@ -0,0 +1,189 @@
+#ifndef Magnum_SceneGraph_Lod_h
+#define Magnum_SceneGraph_Lod_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::BasicLod3D, typedef @ref Magnum::SceneGraph::Lod3D
+ */
+
+#include <vector>
+
+#include "Magnum/SceneGraph/AbstractGroupedFeature.h"
+#include "Magnum/SceneGraph/visibility.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Screen-size based level of detail selection for three-dimensional scenes
+
+Selects a level of detail of an object based on how large its bounding sphere
+is on the screen. The sphere is taken from a @ref DerivedTransformation
+attached to the same object, so it's calculated only once after the object
+transformation changes and shared with everything else that needs it. The
+selection is done for all features in a @ref BasicLodGroup3D "LodGroup3D" at
+once using @ref BasicLodGroup3D::select(), optionally in parallel, and the
+drawable then draws a mesh corresponding to @ref level(). Together with
+@ref MeshTools::generateLodChain() it allows far-away objects to be drawn
+with only a fraction of their vertices:
+
+@code{.cpp}
+class Rock: public Object3D, public SceneGraph::Drawable3D {
+    public:
+        explicit Rock(Object3D* parent, SceneGraph::DrawableGroup3D* drawables, SceneGraph::LodGroup3D* lods, std::vector<MeshView>& views): Object3D{parent}, SceneGraph::Drawable3D{*this, drawables}, _derived{*this}, _lod{*this, _derived, {0.25f, 0.1f, 0.04f}, lods}, _views(views) {
+            _derived.setBoundingSphere({}, 1.0f);
+        }
+
+    private:
+        void draw(const Matrix4& transformationMatrix, SceneGraph::Camera3D& camera) override {
+            _shader.setTransformationProjectionMatrix(camera.projectionMatrix()*transformationMatrix);
+            _views[_lod.level()].draw(_shader);
+        }
+
+        SceneGraph::DerivedTransformation3D _derived;
+        SceneGraph::Lod3D _lod;
+        std::vector<MeshView>& _views;
+        // ...
+};
+
+// each frame
+lods.select(camera, pool);
+camera.draw(drawables);
+@endcode
+
+@section SceneGraph-Lod-size Screen size and thresholds
+
+The screen size is the diameter of the bounding sphere relative to the
+viewport height, calculated from the projection of the sphere center and its
+radius, so a sphere which fills the viewport vertically has size @cpp 1.0 @ce.
+Both perspective and orthographic projections are supported. If the camera is
+inside the sphere, the size is infinite and level @cpp 0 @ce is selected.
+
+The thresholds passed to the constructor are expected to be in a decreasing
+order, level @f$ i @f$ is selected when the screen size is smaller than
+threshold @f$ i - 1 @f$ and not smaller than threshold @f$ i @f$. Levels
+are thus numbered from the most detailed one, the last level is used for all
+sizes below the last threshold.
+
+@section SceneGraph-Lod-hysteresis Hysteresis
+
+To avoid popping when an object screen size oscillates around a threshold,
+a coarser level is selected only after the size drops below the threshold
+scaled by @cpp 1 - h @ce and a finer level only after it gets over the
+threshold scaled by @cpp 1 + h @ce, where @cpp h @ce is
+@ref BasicLodGroup3D::hysteresis(). The first selection after the feature was
+created or after @ref BasicLodGroup3D::reset() doesn't use any hysteresis.
+
+The selected level is remembered per feature, not per camera. When drawing
+the same group with multiple cameras, call @ref BasicLodGroup3D::select()
+before each draw; the hysteresis then works reliably only for one of them.
+
+@section SceneGraph-Lod-explicit-specializations Explicit template specializations
+
+The following specialization is explicitly compiled into @ref SceneGraph
+library. For other specializations (e.g. using @ref Magnum::Double "Double"
+type) you have to use @ref Lod.hpp implementation file to avoid linker
+errors. See also @ref compilation-speedup-hpp for more information.
+
+-   @ref Lod3D
+
+@see @ref scenegraph, @ref Lod3D, @ref LodGroup3D
+*/
+template<class T> class BasicLod3D: public AbstractGroupedFeature<3, BasicLod3D<T>, T> {
+    friend BasicLodGroup3D<T>;
+
+    public:
+        /**
+         * @brief Constructor
+         * @param object        Object this feature belongs to
+         * @param derived       Derived transformation of the same object
+         *      providing the bounding sphere
+         * @param thresholds    Screen size thresholds between the levels,
+         *      in a decreasing order
+         * @param group         Group this feature belongs to
+         *
+         * The level count is one more than the count of @p thresholds.
+         * Expects that @p derived is attached to @p object and that the
+         * thresholds are positive and decreasing. Until the first
+         * @ref BasicLodGroup3D::select(), level @cpp 0 @ce is used.
+         */
+        explicit BasicLod3D(AbstractObject<3, T>& object, const DerivedTransformation<3, T>& derived, std::vector<T> thresholds, BasicLodGroup3D<T>* group = nullptr);
+
+        /** @brief Group containing this feature */
+        BasicLodGroup3D<T>* lods();
+        const BasicLodGroup3D<T>* lods() const; /**< @overload */
+
+        /** @brief Derived transformation providing the bounding sphere */
+        const DerivedTransformation<3, T>& derivedTransformation() const {
+            return _derived;
+        }
+
+        /** @brief Screen size thresholds */
+        const std::vector<T>& thresholds() const { return _thresholds; }
+
+        /** @brief Level count */
+        UnsignedInt levelCount() const { return _thresholds.size() + 1; }
+
+        /**
+         * @brief Selected level
+         *
+         * Level @cpp 0 @ce is the most detailed one. Updated by
+         * @ref BasicLodGroup3D::select().
+         */
+        UnsignedInt level() const { return _level; }
+
+        /**
+         * @brief Screen size from the last selection
+         *
+         * Diameter of the bounding sphere relative to the viewport height.
+         * Infinite if the camera was inside the sphere, @cpp 0 @ce before
+         * the first @ref BasicLodGroup3D::select().
+         */
+        T screenSize() const { return _screenSize; }
+
+    private:
+        void select(T size, T hysteresis);
+
+        const DerivedTransformation<3, T>& _derived;
+        std::vector<T> _thresholds;
+        UnsignedInt _level;
+        T _screenSize;
+        bool _selected;
+};
+
+/**
+@brief Level of detail selection for three-dimensional float scenes
+
+@see @ref BasicLod3D
+*/
+typedef BasicLod3D<Float> Lod3D;
+
+#if defined(CORRADE_TARGET_WINDOWS) && !defined(__MINGW32__)
+extern template class MAGNUM_SCENEGRAPH_EXPORT BasicLod3D<Float>;
+#endif
+
+}}
+
+#endif
@@ -0,0 +1,145 @@
+#ifndef Magnum_SceneGraph_Lod_hpp
+#define Magnum_SceneGraph_Lod_hpp
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief @ref compilation-speedup-hpp "Template implementation" for @ref Lod.h and @ref LodGroup.h
+ */
+
+#include <algorithm>
+
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/SceneGraph/AbstractObject.h"
+#include "Magnum/SceneGraph/Camera.h"
+#include "Magnum/SceneGraph/DerivedTransformation.h"
+#include "Magnum/SceneGraph/Lod.h"
+#include "Magnum/SceneGraph/LodGroup.h"
+
+namespace Magnum { namespace SceneGraph {
+
+template<class T> BasicLod3D<T>::BasicLod3D(AbstractObject<3, T>& object, const DerivedTransformation<3, T>& derived, std::vector<T> thresholds, BasicLodGroup3D<T>* group): AbstractGroupedFeature<3, BasicLod3D<T>, T>{object, group}, _derived(derived), _thresholds{std::move(thresholds)}, _level{0}, _screenSize{T(0)}, _selected{false} {
+    CORRADE_ASSERT(&derived.object() == &object,
+        "SceneGraph::Lod: the derived transformation is not attached to the same object", );
+    #ifndef CORRADE_NO_ASSERT
+    for(std::size_t i = 0; i != _thresholds.size(); ++i) {
+        CORRADE_ASSERT(_thresholds[i] > T(0) && (i == 0 || _thresholds[i] < _thresholds[i - 1]),
+            "SceneGraph::Lod: expected positive decreasing thresholds but got" << _thresholds[i] << "at position" << i, );
+    }
+    #endif
+}
+
+template<class T> BasicLodGroup3D<T>* BasicLod3D<T>::lods() {
+    return static_cast<BasicLodGroup3D<T>*>(AbstractGroupedFeature<3, BasicLod3D<T>, T>::group());
+}
+
+template<class T> const BasicLodGroup3D<T>* BasicLod3D<T>::lods() const {
+    return static_cast<const BasicLodGroup3D<T>*>(AbstractGroupedFeature<3, BasicLod3D<T>, T>::group());
+}
+
+template<class T> void BasicLod3D<T>::select(const T size, const T hysteresis) {
+    _screenSize = size;
+    const UnsignedInt last = _thresholds.size();
+
+    /* First selection, no previous level to stick to */
+    if(!_selected) {
+        _level = 0;
+        while(_level != last && size < _thresholds[_level]) ++_level;
+        _selected = true;
+        return;
+    }
+
+    /* Go to finer levels only if the size got enough over the threshold,
+       coarser only if it got enough under it. At most one of the loops does
+       anything. */
+    while(_level != 0 && size >= _thresholds[_level - 1]*(T(1) + hysteresis))
+        --_level;
+    while(_level != last && size < _thresholds[_level]*(T(1) - hysteresis))
+        ++_level;
+}
+
+template<class T> BasicLodGroup3D<T>& BasicLodGroup3D<T>::setHysteresis(const T hysteresis) {
+    CORRADE_ASSERT(hysteresis >= T(0) && hysteresis < T(1),
+        "SceneGraph::LodGroup::setHysteresis(): expected a value in range [0, 1) but got" << hysteresis, *this);
+    _hysteresis = hysteresis;
+    return *this;
+}
+
+template<class T> Math::Matrix4<T> BasicLodGroup3D<T>::prepare(BasicCamera3D<T>& camera) {
+    /* Clean all objects at once so the bounding spheres are up-to-date. The
+       storage is reused across calls to avoid allocations. */
+    _objects.clear();
+    for(std::size_t i = 0; i != this->size(); ++i)
+        _objects.push_back((*this)[i].object());
+    AbstractObject<3, T>::setClean(_objects);
+
+    return camera.cameraMatrix();
+}
+
+template<class T> void BasicLodGroup3D<T>::selectRange(const Math::Matrix4<T>& cameraMatrix, const Math::Matrix4<T>& projectionMatrix, const std::size_t begin, const std::size_t end) {
+    for(std::size_t i = begin; i != end; ++i) {
+        BasicLod3D<T>& lod = (*this)[i];
+        const DerivedTransformation<3, T>& derived = lod.derivedTransformation();
+        const T radius = derived.absoluteBoundingSphereRadius();
+
+        /* W of the projected center is the distance from the camera for
+           perspective projection and 1 for orthographic */
+        const T w = (projectionMatrix*Math::Vector4<T>{cameraMatrix.transformPoint(derived.absoluteBoundingSphereCenter()), T(1)}).w();
+
+        /* Camera inside the sphere (or the sphere behind the camera) is
+           detected only for perspective, as orthographic has zero there */
+        const T size = w <= radius*Math::abs(projectionMatrix[2][3]) ?
+            Math::Constants<T>::inf() :
+            Math::abs(projectionMatrix[1][1])*radius/w;
+        lod.select(size, _hysteresis);
+    }
+}
+
+template<class T> void BasicLodGroup3D<T>::select(BasicCamera3D<T>& camera) {
+    const Math::Matrix4<T> cameraMatrix = prepare(camera);
+    selectRange(cameraMatrix, camera.projectionMatrix(), 0, this->size());
+}
+
+template<class T> void BasicLodGroup3D<T>::select(BasicCamera3D<T>& camera, ThreadPool& pool, const ThreadPool::Schedule schedule) {
+    const Math::Matrix4<T> cameraMatrix = prepare(camera);
+    const Math::Matrix4<T> projectionMatrix = camera.projectionMatrix();
+
+    /* The selection is cheap, so use bigger chunks than in
+       AnimableGroup::step() to keep the scheduling overhead low */
+    const std::size_t chunkSize = std::max(std::size_t{256}, this->size()/pool.threadCount());
+    pool.parallelFor(this->size(), chunkSize, [this, &cameraMatrix, &projectionMatrix](const std::size_t begin, const std::size_t end) {
+        selectRange(cameraMatrix, projectionMatrix, begin, end);
+    }, schedule);
+}
+
+template<class T> void BasicLodGroup3D<T>::reset() {
+    for(std::size_t i = 0; i != this->size(); ++i)
+        (*this)[i]._selected = false;
+}
+
+}}
+
+#endif
@@ -0,0 +1,123 @@
+#ifndef Magnum_SceneGraph_LodGroup_h
+#define Magnum_SceneGraph_LodGroup_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::BasicLodGroup3D, typedef @ref Magnum::SceneGraph::LodGroup3D
+ */
+
+#include <functional>
+#include <vector>
+
+#include "Magnum/ThreadPool.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/SceneGraph/FeatureGroup.h"
+#include "Magnum/SceneGraph/visibility.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Group of level of detail features for three-dimensional scenes
+
+See @ref BasicLod3D for more information.
+@see @ref scenegraph, @ref LodGroup3D
+*/
+template<class T> class BasicLodGroup3D: public FeatureGroup<3, BasicLod3D<T>, T> {
+    public:
+        /** @brief Constructor */
+        explicit BasicLodGroup3D(): _hysteresis{T(0.1)} {}
+
+        /**
+         * @brief Hysteresis
+         *
+         * @see @ref setHysteresis()
+         */
+        T hysteresis() const { return _hysteresis; }
+
+        /**
+         * @brief Set hysteresis
+         * @return Reference to self (for method chaining)
+         *
+         * Relative amount by which the screen size has to get over or under
+         * a threshold to switch to another level, see
+         * @ref SceneGraph-Lod-hysteresis for details. Expects that the value
+         * is in range @f$ [0, 1) @f$. Default is @cpp 0.1 @ce.
+         */
+        BasicLodGroup3D<T>& setHysteresis(T hysteresis);
+
+        /**
+         * @brief Select levels for given camera
+         *
+         * Cleans objects of all features in the group, calculates screen size
+         * of their bounding spheres using the camera matrix and projection of
+         * @p camera and updates @ref BasicLod3D::level(). Expects that the
+         * camera matrix is rigid.
+         */
+        void select(BasicCamera3D<T>& camera);
+
+        /**
+         * @brief Select levels for given camera in parallel
+         * @param camera    Camera to select the levels for
+         * @param pool      Thread pool to use
+         * @param schedule  Scheduling of the selection
+         *
+         * Objects are cleaned serially on the calling thread, the screen size
+         * calculation and level selection is then done concurrently using
+         * @ref ThreadPool::parallelFor(). The result is the same as with
+         * @ref select(BasicCamera3D<T>&).
+         */
+        void select(BasicCamera3D<T>& camera, ThreadPool& pool, ThreadPool::Schedule schedule = ThreadPool::Schedule::Dynamic);
+
+        /**
+         * @brief Reset the selection state
+         *
+         * The next @ref select() picks the levels without any hysteresis,
+         * useful after a camera cut.
+         */
+        void reset();
+
+    private:
+        Math::Matrix4<T> prepare(BasicCamera3D<T>& camera);
+        void selectRange(const Math::Matrix4<T>& cameraMatrix, const Math::Matrix4<T>& projectionMatrix, std::size_t begin, std::size_t end);
+
+        T _hysteresis;
+        std::vector<std::reference_wrapper<AbstractObject<3, T>>> _objects;
+};
+
+/**
+@brief Group of level of detail features for three-dimensional float scenes
+
+@see @ref BasicLodGroup3D
+*/
+typedef BasicLodGroup3D<Float> LodGroup3D;
+
+#if defined(CORRADE_TARGET_WINDOWS) && !defined(__MINGW32__)
+extern template class MAGNUM_SCENEGRAPH_EXPORT BasicLodGroup3D<Float>;
+#endif
+
+}}
+
+#endif
@@ -41,7 +41,10 @@ namespace Implementation {
     enum class ObjectFlag: UnsignedByte {
         Dirty = 1 << 0,
         Visited = 1 << 1,
-        Joint = 1 << 2
+        Joint = 1 << 2,
+        /* Dirty flag set without propagating it to features and children,
+           used by TrackAnimator to batch the propagation */
+        DirtyDeferred = 1 << 3
     };
 
     typedef Containers::EnumSet<ObjectFlag> ObjectFlags;
@@ -104,7 +107,7 @@ class documentation or @ref compilation-speedup-hpp for more information.
 -   @ref TranslationTransformation3D "Object<TranslationTransformation3D>"
 
 @see @ref Scene, @ref AbstractFeature, @ref AbstractTransformation,
-    @ref DebugTools::ObjectRenderer
+    @ref FlatHierarchy, @ref DebugTools::ObjectRenderer
 @todo Consider using `mutable` for flags to make transformation computation
     available on const refs
 */
@@ -264,6 +267,31 @@ template<class Transformation> class Object: public AbstractObject<Transformatio
          */
         std::vector<MatrixType> transformationMatrices(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects, const MatrixType& initialTransformationMatrix = MatrixType()) const;
 
+        /**
+         * @brief Transformation matrices of given set of objects relative to this object into existing storage
+         *
+         * Like @ref transformationMatrices(const std::vector<std::reference_wrapper<Object<Transformation>>>&, const MatrixType&) const,
+         * but puts the result into @p out, which is expected to have the same
+         * size as @p objects. All temporary data needed for the computation
+         * are stored in the scene and reused across calls, so the function
+         * doesn't allocate if called repeatedly with the same or smaller
+         * object count.
+         */
+        void transformationMatrices(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects, Containers::ArrayView<MatrixType> out, const MatrixType& initialTransformationMatrix = MatrixType()) const;
+
+        /**
+         * @brief Transformation matrices of given set of objects relative to this object computed in parallel
+         *
+         * Like @ref transformationMatrices(const std::vector<std::reference_wrapper<Object<Transformation>>>&, Containers::ArrayView<MatrixType>, const MatrixType&) const,
+         * but the transformations are computed on @p pool. Objects are
+         * first divided into independent paths in the hierarchy on the
+         * calling thread, transformations along the paths are then computed
+         * concurrently and concatenated together at the end. The operations
+         * done on each object are the same as in the serial version, so the
+         * result is bit-for-bit equal to it.
+         */
+        void transformationMatrices(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects, Containers::ArrayView<MatrixType> out, const MatrixType& initialTransformationMatrix, ThreadPool& pool) const;
+
         /**
          * @brief Transformations of given group of objects relative to this object
          *
@@ -281,6 +309,30 @@ template<class Transformation> class Object: public AbstractObject<Transformatio
             #endif
             ) const;
 
+        /**
+         * @brief Transformations of given group of objects relative to this object into existing storage
+         *
+         * Like @ref transformations(std::vector<std::reference_wrapper<Object<Transformation>>>, const typename Transformation::DataType&) const,
+         * but puts the result into @p out, which is expected to have the same
+         * size as @p objects. See @ref transformationMatrices(const std::vector<std::reference_wrapper<Object<Transformation>>>&, Containers::ArrayView<MatrixType>, const MatrixType&) const
+         * for more information.
+         */
+        void transformations(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects, Containers::ArrayView<typename Transformation::DataType> out, const typename Transformation::DataType& initialTransformation =
+            #ifndef CORRADE_MSVC2015_COMPATIBILITY /* I hate this inconsistency */
+            typename Transformation::DataType()
+            #else
+            Transformation::DataType()
+            #endif
+            ) const;
+
+        /**
+         * @brief Transformations of given group of objects relative to this object computed in parallel
+         *
+         * See @ref transformationMatrices(const std::vector<std::reference_wrapper<Object<Transformation>>>&, Containers::ArrayView<MatrixType>, const MatrixType&, ThreadPool&) const
+         * for more information.
+         */
+        void transformations(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects, Containers::ArrayView<typename Transformation::DataType> out, const typename Transformation::DataType& initialTransformation, ThreadPool& pool) const;
+
         /*@}*/
 
         /**
@@ -298,10 +350,32 @@ template<class Transformation> class Object: public AbstractObject<Transformatio
         /* `objects` passed by copy intentionally (to avoid copy internally) */
         static void setClean(std::vector<std::reference_wrapper<Object<Transformation>>> objects);
 
+        /**
+         * @brief Clean absolute transformations of given set of objects in parallel
+         *
+         * Like @ref setClean(std::vector<std::reference_wrapper<Object<Transformation>>>),
+         * but the absolute transformations are computed on @p pool using
+         * @ref transformations(const std::vector<std::reference_wrapper<Object<Transformation>>>&, Containers::ArrayView<typename Transformation::DataType>, const typename Transformation::DataType&, ThreadPool&) const.
+         * Features are cleaned serially on the calling thread afterwards, so
+         * their @ref AbstractFeature::clean() implementation doesn't need to
+         * be thread-safe.
+         */
+        static void setClean(std::vector<std::reference_wrapper<Object<Transformation>>> objects, ThreadPool& pool);
+
         /** @copydoc AbstractObject::isDirty() */
         bool isDirty() const { return !!(flags & Flag::Dirty); }
 
-        /** @copydoc AbstractObject::setDirty() */
+        /**
+         * @brief Set object absolute transformation as dirty
+         *
+         * Calls @ref AbstractFeature::markDirty() on all object features and
+         * recursively calls @ref setDirty() on every child object which is not
+         * already dirty. If the object is already marked as dirty, the
+         * function does nothing. If the object is part of a scene, it's also
+         * put into list of objects to be cleaned by @ref Scene::cleanAll().
+         * @see @ref scenegraph-features-caching, @ref setClean(),
+         *      @ref isDirty()
+         */
         void setDirty();
 
         /**
@@ -333,6 +407,9 @@ template<class Transformation> class Object: public AbstractObject<Transformatio
         friend Containers::LinkedList<Object<Transformation>>;
         friend Containers::LinkedListItem<Object<Transformation>, Object<Transformation>>;
         #endif
+        template<class> friend class FlatHierarchy;
+        template<class> friend class TrackAnimator;
+        friend Scene<Transformation>;
 
         Object<Transformation>* doScene() override final;
         const Object<Transformation>* doScene() const override final;
@@ -348,20 +425,37 @@ template<class Transformation> class Object: public AbstractObject<Transformatio
         }
 
         std::vector<MatrixType> doTransformationMatrices(const std::vector<std::reference_wrapper<AbstractObject<Transformation::Dimensions, typename Transformation::Type>>>& objects, const MatrixType& initialTransformationMatrix) const override final;
+        void doTransformationMatrices(const std::vector<std::reference_wrapper<AbstractObject<Transformation::Dimensions, typename Transformation::Type>>>& objects, Containers::ArrayView<MatrixType> out, const MatrixType& initialTransformationMatrix, ThreadPool* pool) const override final;
+
+        void MAGNUM_SCENEGRAPH_LOCAL transformationMatricesInternal(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects, Containers::ArrayView<MatrixType> out, const MatrixType& initialTransformationMatrix, ThreadPool* pool) const;
+        bool MAGNUM_SCENEGRAPH_LOCAL transformationsInternal(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects, typename Transformation::DataType* out, const typename Transformation::DataType& initialTransformation, ThreadPool* pool) const;
+        void MAGNUM_SCENEGRAPH_LOCAL computeJointTransformationsParallel(const std::vector<std::reference_wrapper<Object<Transformation>>>& jointObjects, std::vector<typename Transformation::DataType>& jointTransformations, const typename Transformation::DataType& initialTransformation, ThreadPool& pool) const;
 
         typename Transformation::DataType MAGNUM_SCENEGRAPH_LOCAL computeJointTransformation(const std::vector<std::reference_wrapper<Object<Transformation>>>& jointObjects, std::vector<typename Transformation::DataType>& jointTransformations, const std::size_t joint, const typename Transformation::DataType& initialTransformation) const;
 
         bool MAGNUM_SCENEGRAPH_LOCAL doIsDirty() const override final { return isDirty(); }
         void MAGNUM_SCENEGRAPH_LOCAL doSetDirty() override final { setDirty(); }
         void MAGNUM_SCENEGRAPH_LOCAL doSetClean() override final { setClean(); }
-        void doSetClean(const std::vector<std::reference_wrapper<AbstractObject<Transformation::Dimensions, typename Transformation::Type>>>& objects) override final;
+        void doSetClean(const std::vector<std::reference_wrapper<AbstractObject<Transformation::Dimensions, typename Transformation::Type>>>& objects, ThreadPool* pool) override final;
+
+        static void MAGNUM_SCENEGRAPH_LOCAL setCleanObjects(std::vector<std::reference_wrapper<Object<Transformation>>>& objects, ThreadPool* pool);
 
+        void MAGNUM_SCENEGRAPH_LOCAL setDirtyInternal();
         void MAGNUM_SCENEGRAPH_LOCAL setCleanInternal(const typename Transformation::DataType& absoluteTransformation);
 
+        void MAGNUM_SCENEGRAPH_LOCAL scheduleClean();
+        void MAGNUM_SCENEGRAPH_LOCAL unscheduleClean();
+
         typedef Implementation::ObjectFlag Flag;
         typedef Implementation::ObjectFlags Flags;
         UnsignedShort counter;
         Flags flags;
+
+        /* Intrusive circular list of objects scheduled for Scene::cleanAll(),
+           with the scene itself being the sentinel. Both are null if the
+           object is not in any list. */
+        Object<Transformation>* _cleanPrevious;
+        Object<Transformation>* _cleanNext;
 };
 
 }}
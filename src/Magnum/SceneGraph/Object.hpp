@@ -31,23 +31,86 @@
 
 #include <algorithm>
 #include <stack>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Utility/Debug.h>
 
+#include "Magnum/ThreadPool.h"
 #include "Magnum/SceneGraph/AbstractTransformation.h"
 #include "Magnum/SceneGraph/Object.h"
 #include "Magnum/SceneGraph/Scene.h"
 
 namespace Magnum { namespace SceneGraph {
 
+namespace Implementation {
+
+/* Passes native transformation representation to features that requested it.
+   Returns false if the feature should get a matrix instead. */
+template<class Transformation> struct FeatureCleaner {
+    static bool clean(AbstractFeature<Transformation::Dimensions, typename Transformation::Type>&, const typename Transformation::DataType&) {
+        return false;
+    }
+};
+
+template<UnsignedInt dimensions, class T, class TranslationType> struct FeatureCleaner<TranslationTransformation<dimensions, T, TranslationType>> {
+    static bool clean(AbstractFeature<dimensions, T>& feature, const VectorTypeFor<dimensions, TranslationType>& absoluteTransformation) {
+        if(!(feature.cachedTransformations() & CachedTransformation::AbsoluteTranslation))
+            return false;
+
+        feature.cleanTranslation(VectorTypeFor<dimensions, T>{absoluteTransformation});
+        return true;
+    }
+};
+
+template<class T> struct FeatureCleaner<BasicDualComplexTransformation<T>> {
+    static bool clean(AbstractFeature<2, T>& feature, const Math::DualComplex<T>& absoluteTransformation) {
+        if(!(feature.cachedTransformations() & CachedTransformation::AbsoluteRigid))
+            return false;
+
+        feature.cleanRigid(absoluteTransformation);
+        return true;
+    }
+};
+
+template<class T> struct FeatureCleaner<BasicDualQuaternionTransformation<T>> {
+    static bool clean(AbstractFeature<3, T>& feature, const Math::DualQuaternion<T>& absoluteTransformation) {
+        if(!(feature.cachedTransformations() & CachedTransformation::AbsoluteRigid))
+            return false;
+
+        feature.cleanRigid(absoluteTransformation);
+        return true;
+    }
+};
+
+}
+
 template<UnsignedInt dimensions, class T> AbstractObject<dimensions, T>::AbstractObject() {}
 template<UnsignedInt dimensions, class T> AbstractObject<dimensions, T>::~AbstractObject() {}
 
 template<UnsignedInt dimensions, class T> AbstractTransformation<dimensions, T>::AbstractTransformation() {}
 
-template<class Transformation> Object<Transformation>::Object(Object<Transformation>* parent): counter(0xFFFFu), flags(Flag::Dirty) {
+template<class Transformation> Object<Transformation>::Object(Object<Transformation>* parent): counter(0xFFFFu), flags(Flag::Dirty), _cleanPrevious{}, _cleanNext{} {
     setParent(parent);
 }
 
-template<class Transformation> Object<Transformation>::~Object() = default;
+template<class Transformation> Object<Transformation>::~Object() {
+    unscheduleClean();
+}
+
+template<class Transformation> Scene<Transformation>::Scene() {
+    this->_cleanPrevious = this->_cleanNext = this;
+}
+
+template<class Transformation> Scene<Transformation>::~Scene() {
+    /* Unlink all objects scheduled for cleaning, so they don't try to unlink
+       themselves from a list that's no longer there when being destroyed */
+    Object<Transformation>* o = this->_cleanNext;
+    while(o != this) {
+        Object<Transformation>* const next = o->_cleanNext;
+        o->_cleanPrevious = o->_cleanNext = nullptr;
+        o = next;
+    }
+    this->_cleanPrevious = this->_cleanNext = nullptr;
+}
 
 template<class Transformation> Scene<Transformation>* Object<Transformation>::scene() {
     Object<Transformation>* p(this);
@@ -96,7 +159,11 @@ template<class Transformation> Object<Transformation>& Object<Transformation>::s
     /* Add the object to list of new parent */
     if(parent) parent->Containers::LinkedList<Object<Transformation>>::insert(this);
 
+    /* Mark the object as dirty and schedule it for cleaning in the new scene
+       (it might have been already dirty and scheduled in the old one) */
+    unscheduleClean();
     setDirty();
+    scheduleClean();
     return *this;
 }
 
@@ -121,18 +188,107 @@ template<class Transformation> void Object<Transformation>::setDirty() {
        nothing to do */
     if(flags & Flag::Dirty) return;
 
+    setDirtyInternal();
+
+    /* Only the topmost object of the dirty subtree needs to be scheduled, the
+       rest is found from it in Scene::cleanAll() */
+    scheduleClean();
+}
+
+template<class Transformation> void Object<Transformation>::setDirtyInternal() {
+    /* The transformation of this object (and all children) is already dirty,
+       nothing to do */
+    if(flags & Flag::Dirty) return;
+
     /* Make all features dirty */
     for(AbstractFeature<Transformation::Dimensions, typename Transformation::Type>& feature: this->features())
         feature.markDirty();
 
     /* Make all children dirty */
     for(Object<Transformation>& child: children())
-        child.setDirty();
+        child.setDirtyInternal();
 
     /* Mark object as dirty */
     flags |= Flag::Dirty;
 }
 
+template<class Transformation> void Object<Transformation>::scheduleClean() {
+    /* Already scheduled (or this is a scene, which is always linked to
+       itself) */
+    if(_cleanNext) return;
+
+    /* Objects outside of any scene are not scheduled */
+    Object<Transformation>* const scene = this->scene();
+    if(!scene) return;
+
+    /* Append to the end of the list */
+    _cleanPrevious = scene->_cleanPrevious;
+    _cleanNext = scene;
+    scene->_cleanPrevious->_cleanNext = this;
+    scene->_cleanPrevious = this;
+}
+
+template<class Transformation> void Object<Transformation>::unscheduleClean() {
+    /* Not scheduled. Scene is the list sentinel, so it's never unscheduled
+       here. */
+    if(!_cleanNext || isScene()) return;
+
+    _cleanPrevious->_cleanNext = _cleanNext;
+    _cleanNext->_cleanPrevious = _cleanPrevious;
+    _cleanPrevious = _cleanNext = nullptr;
+}
+
+template<class Transformation> void Scene<Transformation>::cleanAll() {
+    /* The scene itself is dirty, which means the whole hierarchy is */
+    if(this->isDirty()) cleanSubtree(*this);
+
+    while(this->_cleanNext != this) {
+        Object<Transformation>* const o = this->_cleanNext;
+        o->unscheduleClean();
+
+        /* Already cleaned, either explicitly or as a part of subtree of some
+           previously processed object */
+        if(!o->isDirty()) continue;
+
+        /* The object was moved to another scene in the meantime (as a part of
+           some moved subtree), schedule it there */
+        if(o->scene() != this) {
+            o->scheduleClean();
+            continue;
+        }
+
+        /* Find topmost dirty ancestor and clean whole subtree under it */
+        Object<Transformation>* root = o;
+        while(root->parent() && root->parent()->isDirty())
+            root = root->parent();
+        cleanSubtree(*root);
+    }
+}
+
+template<class Transformation> void Scene<Transformation>::cleanSubtree(Object<Transformation>& root) {
+    /* Parent of the root is clean (or there's no parent) */
+    Object<Transformation>* const parent = root.parent();
+    _cleanStack.clear();
+    _cleanStack.emplace_back(&root, parent ? parent->absoluteTransformation() : typename Transformation::DataType());
+
+    /* Go depth-first from the root, each item in the stack contains absolute
+       transformation of its parent */
+    while(!_cleanStack.empty()) {
+        Object<Transformation>* const o = _cleanStack.back().first;
+        const typename Transformation::DataType absoluteTransformation = Implementation::Transformation<Transformation>::compose(_cleanStack.back().second, o->transformation());
+        _cleanStack.pop_back();
+
+        CORRADE_INTERNAL_ASSERT(o->isDirty());
+        o->setCleanInternal(absoluteTransformation);
+        CORRADE_ASSERT(!o->isDirty(), "SceneGraph::Scene::cleanAll(): original implementation was not called", );
+
+        /* Clean children are roots of clean subtrees (as dirtiness is always
+           propagated down), skip them */
+        for(Object<Transformation>& child: o->children())
+            if(child.isDirty()) _cleanStack.emplace_back(&child, absoluteTransformation);
+    }
+}
+
 template<class Transformation> void Object<Transformation>::setClean() {
     /* The object (and all its parents) are already clean, nothing to do */
     if(!(flags & Flag::Dirty)) return;
@@ -179,6 +335,18 @@ template<class Transformation> auto Object<Transformation>::doTransformationMatr
     return transformationMatrices(std::move(castObjects), initialTransformationMatrix);
 }
 
+template<class Transformation> void Object<Transformation>::doTransformationMatrices(const std::vector<std::reference_wrapper<AbstractObject<Transformation::Dimensions, typename Transformation::Type>>>& objects, const Containers::ArrayView<MatrixType> out, const MatrixType& initialTransformationMatrix, ThreadPool* const pool) const {
+    CORRADE_ASSERT(isScene(), "SceneGraph::Object::transformationMatrices(): currently implemented only for Scene", );
+
+    /* Reuse scene scratch storage for the cast objects as well */
+    std::vector<std::reference_wrapper<Object<Transformation>>>& castObjects = static_cast<const Scene<Transformation>*>(this)->_castObjects;
+    castObjects.clear();
+    /** @todo Ensure this doesn't crash, somehow */
+    for(auto o: objects) castObjects.push_back(static_cast<Object<Transformation>&>(o.get()));
+
+    transformationMatricesInternal(castObjects, out, initialTransformationMatrix, pool);
+}
+
 template<class Transformation> auto Object<Transformation>::transformationMatrices(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects, const MatrixType& initialTransformationMatrix) const -> std::vector<MatrixType> {
     std::vector<typename Transformation::DataType> transformations = this->transformations(std::move(objects), Implementation::Transformation<Transformation>::fromMatrix(initialTransformationMatrix));
     std::vector<MatrixType> transformationMatrices(transformations.size());
@@ -188,6 +356,45 @@ template<class Transformation> auto Object<Transformation>::transformationMatric
     return transformationMatrices;
 }
 
+template<class Transformation> void Object<Transformation>::transformationMatrices(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects, const Containers::ArrayView<MatrixType> out, const MatrixType& initialTransformationMatrix) const {
+    transformationMatricesInternal(objects, out, initialTransformationMatrix, nullptr);
+}
+
+template<class Transformation> void Object<Transformation>::transformationMatrices(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects, const Containers::ArrayView<MatrixType> out, const MatrixType& initialTransformationMatrix, ThreadPool& pool) const {
+    transformationMatricesInternal(objects, out, initialTransformationMatrix, &pool);
+}
+
+template<class Transformation> void Object<Transformation>::transformationMatricesInternal(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects, const Containers::ArrayView<MatrixType> out, const MatrixType& initialTransformationMatrix, ThreadPool* const pool) const {
+    CORRADE_ASSERT(out.size() == objects.size(),
+        "SceneGraph::Object::transformationMatrices(): expected output view of size" << objects.size() << "but got" << out.size(), );
+    CORRADE_ASSERT(isScene(), "SceneGraph::Object::transformationMatrices(): currently implemented only for Scene", );
+
+    std::vector<typename Transformation::DataType>& transformations = static_cast<const Scene<Transformation>*>(this)->_transformations;
+    transformations.resize(objects.size());
+    if(!transformationsInternal(objects, transformations.data(), Implementation::Transformation<Transformation>::fromMatrix(initialTransformationMatrix), pool)) return;
+
+    for(std::size_t i = 0; i != objects.size(); ++i)
+        out[i] = Implementation::Transformation<Transformation>::toMatrix(transformations[i]);
+}
+
+template<class Transformation> std::vector<typename Transformation::DataType> Object<Transformation>::transformations(std::vector<std::reference_wrapper<Object<Transformation>>> objects, const typename Transformation::DataType& initialTransformation) const {
+    std::vector<typename Transformation::DataType> transformations(objects.size());
+    if(!transformationsInternal(objects, transformations.data(), initialTransformation, nullptr)) return {};
+    return transformations;
+}
+
+template<class Transformation> void Object<Transformation>::transformations(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects, const Containers::ArrayView<typename Transformation::DataType> out, const typename Transformation::DataType& initialTransformation) const {
+    CORRADE_ASSERT(out.size() == objects.size(),
+        "SceneGraph::Object::transformations(): expected output view of size" << objects.size() << "but got" << out.size(), );
+    transformationsInternal(objects, out.data(), initialTransformation, nullptr);
+}
+
+template<class Transformation> void Object<Transformation>::transformations(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects, const Containers::ArrayView<typename Transformation::DataType> out, const typename Transformation::DataType& initialTransformation, ThreadPool& pool) const {
+    CORRADE_ASSERT(out.size() == objects.size(),
+        "SceneGraph::Object::transformations(): expected output view of size" << objects.size() << "but got" << out.size(), );
+    transformationsInternal(objects, out.data(), initialTransformation, &pool);
+}
+
 /*
 Computing absolute transformations for given list of objects
 
@@ -201,32 +408,40 @@ divided into two groups:
 Then for all joints their transformation (relative to parent joint) is
 computed and recursively concatenated together. Resulting transformations for
 joints which were originally in `object` list is then returned.
+
+All temporary arrays are stored in the scene and reused across calls, so
+repeated calls with the same (or smaller) object count don't allocate.
+
+With a thread pool, the transformations of paths between joints are computed
+concurrently and only the concatenation of the joint transformations is done
+serially afterwards.
 */
-template<class Transformation> std::vector<typename Transformation::DataType> Object<Transformation>::transformations(std::vector<std::reference_wrapper<Object<Transformation>>> objects, const typename Transformation::DataType& initialTransformation) const {
-    CORRADE_ASSERT(objects.size() < 0xFFFFu, "SceneGraph::Object::transformations(): too large scene", {});
+template<class Transformation> bool Object<Transformation>::transformationsInternal(const std::vector<std::reference_wrapper<Object<Transformation>>>& originalObjects, typename Transformation::DataType* const out, const typename Transformation::DataType& initialTransformation, ThreadPool* const pool) const {
+    CORRADE_ASSERT(originalObjects.size() < 0xFFFFu, "SceneGraph::Object::transformations(): too large scene", false);
+
+    /* Scene object */
+    const Scene<Transformation>* scene = this->scene();
+
+    /* Nearest common ancestor not yet implemented - assert this is done on scene */
+    CORRADE_ASSERT(scene == this, "SceneGraph::Object::transformationMatrices(): currently implemented only for Scene", false);
 
     /* Remember object count for later */
-    std::size_t objectCount = objects.size();
+    std::size_t objectCount = originalObjects.size();
 
     /* Mark all original objects as joints and create initial list of joints
        from them */
-    for(std::size_t i = 0; i != objects.size(); ++i) {
+    for(std::size_t i = 0; i != originalObjects.size(); ++i) {
         /* Multiple occurences of one object in the array, don't overwrite it
            with different counter */
-        if(objects[i].get().counter != 0xFFFFu) continue;
+        if(originalObjects[i].get().counter != 0xFFFFu) continue;
 
-        objects[i].get().counter = UnsignedShort(i);
-        objects[i].get().flags |= Flag::Joint;
+        originalObjects[i].get().counter = UnsignedShort(i);
+        originalObjects[i].get().flags |= Flag::Joint;
     }
-    std::vector<std::reference_wrapper<Object<Transformation>>> jointObjects(objects);
-
-    #if !defined(CORRADE_NO_ASSERT) || defined(CORRADE_GRACEFUL_ASSERT)
-    /* Scene object */
-    const Scene<Transformation>* scene = this->scene();
-    #endif
-
-    /* Nearest common ancestor not yet implemented - assert this is done on scene */
-    CORRADE_ASSERT(scene == this, "SceneGraph::Object::transformationMatrices(): currently implemented only for Scene", {});
+    std::vector<std::reference_wrapper<Object<Transformation>>>& objects = scene->_objects;
+    objects.assign(originalObjects.begin(), originalObjects.end());
+    std::vector<std::reference_wrapper<Object<Transformation>>>& jointObjects = scene->_jointObjects;
+    jointObjects.assign(originalObjects.begin(), originalObjects.end());
 
     /* Mark all objects up the hierarchy as visited */
     auto it = objects.begin();
@@ -244,7 +459,7 @@ template<class Transformation> std::vector<typename Transformation::DataType> Ob
 
         /* If this is root object, remove from list */
         if(!parent) {
-            CORRADE_ASSERT(&it->get() == scene, "SceneGraph::Object::transformations(): the objects are not part of the same tree", {});
+            CORRADE_ASSERT(&it->get() == scene, "SceneGraph::Object::transformations(): the objects are not part of the same tree", false);
             it = objects.erase(it);
 
         /* Parent is an joint or already visited - remove current from list */
@@ -255,7 +470,7 @@ template<class Transformation> std::vector<typename Transformation::DataType> Ob
                list of joint objects */
             if(!(parent->flags & Flag::Joint)) {
                 CORRADE_ASSERT(jointObjects.size() < 0xFFFFu,
-                               "SceneGraph::Object::transformations(): too large scene", {});
+                               "SceneGraph::Object::transformations(): too large scene", false);
                 CORRADE_INTERNAL_ASSERT(parent->counter == 0xFFFFu);
                 parent->counter = UnsignedShort(jointObjects.size());
                 parent->flags |= Flag::Joint;
@@ -270,18 +485,18 @@ template<class Transformation> std::vector<typename Transformation::DataType> Ob
     }
 
     /* Array of absolute transformations in joints */
-    std::vector<typename Transformation::DataType> jointTransformations(jointObjects.size());
+    std::vector<typename Transformation::DataType>& jointTransformations = scene->_jointTransformations;
+    jointTransformations.resize(jointObjects.size());
 
     /* Compute transformations for all joints */
-    for(std::size_t i = 0; i != jointTransformations.size(); ++i)
+    if(pool) computeJointTransformationsParallel(jointObjects, jointTransformations, initialTransformation, *pool);
+    else for(std::size_t i = 0; i != jointTransformations.size(); ++i)
         computeJointTransformation(jointObjects, jointTransformations, i, initialTransformation);
 
-    /* Copy transformation for second or next occurences from first occurence
-       of duplicate object */
-    for(std::size_t i = 0; i != objectCount; ++i) {
-        if(jointObjects[i].get().counter != i)
-            jointTransformations[i] = jointTransformations[jointObjects[i].get().counter];
-    }
+    /* Copy transformations of requested objects to the output, for second or
+       next occurences from first occurence of duplicate object */
+    for(std::size_t i = 0; i != objectCount; ++i)
+        out[i] = jointTransformations[jointObjects[i].get().counter];
 
     /* All visited marks are now cleaned, clean joint marks and counters */
     for(auto i: jointObjects) {
@@ -292,9 +507,7 @@ template<class Transformation> std::vector<typename Transformation::DataType> Ob
         i.get().counter = 0xFFFFu;
     }
 
-    /* Shrink the array to contain only transformations of requested objects and return */
-    jointTransformations.resize(objectCount);
-    return jointTransformations;
+    return true;
 }
 
 template<class Transformation> typename Transformation::DataType Object<Transformation>::computeJointTransformation(const std::vector<std::reference_wrapper<Object<Transformation>>>& jointObjects, std::vector<typename Transformation::DataType>& jointTransformations, const std::size_t joint, const typename Transformation::DataType& initialTransformation) const {
@@ -334,16 +547,100 @@ template<class Transformation> typename Transformation::DataType Object<Transfor
     }
 }
 
-template<class Transformation> void Object<Transformation>::doSetClean(const std::vector<std::reference_wrapper<AbstractObject<Transformation::Dimensions, typename Transformation::Type>>>& objects) {
+template<class Transformation> void Object<Transformation>::computeJointTransformationsParallel(const std::vector<std::reference_wrapper<Object<Transformation>>>& jointObjects, std::vector<typename Transformation::DataType>& jointTransformations, const typename Transformation::DataType& initialTransformation, ThreadPool& pool) const {
+    enum: UnsignedInt {
+        NoJoint = ~UnsignedInt{},
+        Computed = ~UnsignedInt{} - 1
+    };
+
+    const Scene<Transformation>* const scene = static_cast<const Scene<Transformation>*>(this);
+    std::vector<UnsignedInt>& parentJoints = scene->_jointParents;
+    parentJoints.resize(jointObjects.size());
+
+    /* Compute transformations of paths from each joint up to the next joint
+       or root. Objects on the paths which aren't joints belong to exactly one
+       path, so only the job processing given path touches them. Flags of the
+       joints are only read here and their visited marks are cleaned below. */
+    pool.parallelFor(jointObjects.size(), 256, [&](const std::size_t begin, const std::size_t end) {
+        for(std::size_t joint = begin; joint != end; ++joint) {
+            Object<Transformation>* o = &jointObjects[joint].get();
+
+            /* Duplicate occurence, computed by the first one */
+            if(o->counter != joint) continue;
+
+            typename Transformation::DataType transformation = o->transformation();
+            for(;;) {
+                Object<Transformation>* parent = o->parent();
+
+                /* Root object, to be composed with initial transformation */
+                if(!parent) {
+                    CORRADE_INTERNAL_ASSERT(o->isScene());
+                    parentJoints[joint] = NoJoint;
+                    break;
+
+                /* Joint object, to be composed with the joint */
+                } else if(parent->flags & Flag::Joint) {
+                    parentJoints[joint] = parent->counter;
+                    break;
+                }
+
+                /* Else compose transformation with parent, clean its visited
+                   mark and go up the hierarchy */
+                CORRADE_INTERNAL_ASSERT(parent->flags & Flag::Visited);
+                parent->flags &= ~Flag::Visited;
+                transformation = Implementation::Transformation<Transformation>::compose(parent->transformation(), transformation);
+                o = parent;
+            }
+
+            jointTransformations[joint] = transformation;
+        }
+    });
+
+    /* Concatenate the path transformations, parent joints first. The
+       operations are the same as in computeJointTransformation(), so the
+       result is bit-for-bit equal to the serial version. */
+    std::vector<UnsignedInt>& stack = scene->_jointStack;
+    for(std::size_t joint = 0; joint != jointObjects.size(); ++joint) {
+        if(jointObjects[joint].get().counter != joint) continue;
+
+        stack.clear();
+        for(UnsignedInt j = joint; j != NoJoint && parentJoints[j] != Computed; j = parentJoints[j])
+            stack.push_back(j);
+
+        while(!stack.empty()) {
+            const UnsignedInt j = stack.back();
+            stack.pop_back();
+
+            const UnsignedInt parent = parentJoints[j];
+            jointTransformations[j] = parent == NoJoint ?
+                Implementation::Transformation<Transformation>::compose(initialTransformation, jointTransformations[j]) :
+                Implementation::Transformation<Transformation>::compose(jointTransformations[parent], jointTransformations[j]);
+            parentJoints[j] = Computed;
+
+            CORRADE_INTERNAL_ASSERT(jointObjects[j].get().flags & Flag::Visited);
+            jointObjects[j].get().flags &= ~Flag::Visited;
+        }
+    }
+}
+
+template<class Transformation> void Object<Transformation>::doSetClean(const std::vector<std::reference_wrapper<AbstractObject<Transformation::Dimensions, typename Transformation::Type>>>& objects, ThreadPool* const pool) {
     std::vector<std::reference_wrapper<Object<Transformation>>> castObjects;
     castObjects.reserve(objects.size());
     /** @todo Ensure this doesn't crash, somehow */
     for(auto o: objects) castObjects.push_back(static_cast<Object<Transformation>&>(o.get()));
 
-    setClean(std::move(castObjects));
+    setCleanObjects(castObjects, pool);
 }
 
 template<class Transformation> void Object<Transformation>::setClean(std::vector<std::reference_wrapper<Object<Transformation>>> objects) {
+    setCleanObjects(objects, nullptr);
+}
+
+template<class Transformation> void Object<Transformation>::setClean(std::vector<std::reference_wrapper<Object<Transformation>>> objects, ThreadPool& pool) {
+    setCleanObjects(objects, &pool);
+}
+
+template<class Transformation> void Object<Transformation>::setCleanObjects(std::vector<std::reference_wrapper<Object<Transformation>>>& objects, ThreadPool* const pool) {
     /* Remove all clean objects from the list */
     auto firstClean = std::remove_if(objects.begin(), objects.end(), [](Object<Transformation>& o) { return !o.isDirty(); });
     objects.erase(firstClean, objects.end());
@@ -370,7 +667,8 @@ template<class Transformation> void Object<Transformation>::setClean(std::vector
     /* Compute absolute transformations */
     Scene<Transformation>* scene = objects[0].get().scene();
     CORRADE_ASSERT(scene, "Object::setClean(): objects must be part of some scene", );
-    std::vector<typename Transformation::DataType> transformations(scene->transformations(objects));
+    std::vector<typename Transformation::DataType> transformations(objects.size());
+    if(!scene->transformationsInternal(objects, transformations.data(), typename Transformation::DataType(), pool)) return;
 
     /* Go through all objects and clean them */
     for(std::size_t i = 0; i != objects.size(); ++i) {
@@ -389,9 +687,11 @@ template<class Transformation> void Object<Transformation>::setCleanInternal(con
 
     /* Clean all features */
     for(AbstractFeature<Transformation::Dimensions, typename Transformation::Type>& feature: this->features()) {
-        /* Cached absolute transformation, compute it if it wasn't
-            computed already */
-        if(feature.cachedTransformations() & CachedTransformation::Absolute) {
+        /* Cached absolute transformation in native representation, if the
+           feature requested it and the transformation has one. Otherwise
+           compute the matrix if it wasn't computed already. */
+        if(Implementation::FeatureCleaner<Transformation>::clean(feature, absoluteTransformation)) {}
+        else if(feature.cachedTransformations() & CachedTransformation::Absolute) {
             if(!(cached & CachedTransformation::Absolute)) {
                 cached |= CachedTransformation::Absolute;
                 matrix = Implementation::Transformation<Transformation>::toMatrix(absoluteTransformation);
@@ -0,0 +1,99 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ObjectPool.h"
+
+#include <algorithm>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+
+namespace Magnum { namespace SceneGraph {
+
+namespace {
+    struct MaxAlign { long double a; void* b; long long c; };
+}
+
+ObjectPool::ObjectPool(const std::size_t blockSize, const std::size_t chunkBlockCount): _blockSize{(std::max(blockSize, sizeof(FreeBlock)) + alignof(MaxAlign) - 1)/alignof(MaxAlign)*alignof(MaxAlign)}, _chunkBlockCount{chunkBlockCount}, _size{}, _capacity{}, _free{} {
+    CORRADE_ASSERT(chunkBlockCount, "SceneGraph::ObjectPool: chunk block count can't be zero", );
+}
+
+ObjectPool::~ObjectPool() {
+    CORRADE_ASSERT(!_size, "SceneGraph::ObjectPool: destroyed with" << _size << "blocks still allocated", );
+    for(const std::pair<char*, std::size_t>& chunk: _chunks) delete[] chunk.first;
+}
+
+void ObjectPool::grow(const std::size_t count) {
+    char* const chunk = new char[count*_blockSize];
+    _chunks.emplace_back(chunk, count);
+
+    /* Link the blocks in order so they get allocated in memory order */
+    for(std::size_t i = count; i != 0; --i) {
+        FreeBlock* const block = reinterpret_cast<FreeBlock*>(chunk + (i - 1)*_blockSize);
+        block->next = _free;
+        _free = block;
+    }
+
+    _capacity += count;
+}
+
+void ObjectPool::reserve(const std::size_t count) {
+    if(count > _capacity) grow(count - _capacity);
+}
+
+void* ObjectPool::allocate() {
+    if(!_free) grow(_chunkBlockCount);
+
+    FreeBlock* const block = _free;
+    _free = block->next;
+    ++_size;
+    return block;
+}
+
+void ObjectPool::deallocate(void* const block) {
+    #ifndef CORRADE_NO_ASSERT
+    bool found = false;
+    for(const std::pair<char*, std::size_t>& chunk: _chunks) if(block >= chunk.first && block < chunk.first + chunk.second*_blockSize) {
+        found = true;
+        break;
+    }
+    CORRADE_ASSERT(found, "SceneGraph::ObjectPool::deallocate(): block not allocated from this pool", );
+    #endif
+
+    FreeBlock* const freeBlock = static_cast<FreeBlock*>(block);
+    freeBlock->next = _free;
+    _free = freeBlock;
+    --_size;
+}
+
+void ObjectPool::shrink() {
+    if(_size) return;
+
+    for(const std::pair<char*, std::size_t>& chunk: _chunks) delete[] chunk.first;
+    _chunks.clear();
+    _capacity = 0;
+    _free = nullptr;
+}
+
+}}
@@ -0,0 +1,219 @@
+#ifndef Magnum_SceneGraph_ObjectPool_h
+#define Magnum_SceneGraph_ObjectPool_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::ObjectPool, @ref Magnum::SceneGraph::PoolAllocated
+ */
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/SceneGraph/visibility.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Pool of fixed-size memory blocks
+
+Allocates memory for objects and features in large chunks and hands out
+fixed-size blocks from them, so creating and destroying many objects doesn't
+go through the heap for each of them. Freed blocks are kept in a free list and
+reused by subsequent allocations, the chunks are released only on
+destruction or in @ref shrink().
+
+You don't usually need to use this class directly, see @ref PoolAllocated for
+a convenient way to make objects and features allocated from a pool.
+
+The pool is not thread-safe. Destroying the pool while there are still blocks
+allocated from it is an error.
+*/
+class MAGNUM_SCENEGRAPH_EXPORT ObjectPool {
+    public:
+        /**
+         * @brief Constructor
+         * @param blockSize         Size of one block
+         * @param chunkBlockCount   Count of blocks allocated at once when
+         *      the pool runs out of free blocks
+         *
+         * The block size is rounded up to satisfy alignment of all
+         * fundamental types. No memory is allocated until the first call to
+         * @ref allocate() or @ref reserve().
+         */
+        explicit ObjectPool(std::size_t blockSize, std::size_t chunkBlockCount = 1024);
+
+        /** @brief Copying is not allowed */
+        ObjectPool(const ObjectPool&) = delete;
+
+        /** @brief Moving is not allowed */
+        ObjectPool(ObjectPool&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Expects that all blocks were deallocated.
+         */
+        ~ObjectPool();
+
+        /** @brief Copying is not allowed */
+        ObjectPool& operator=(const ObjectPool&) = delete;
+
+        /** @brief Moving is not allowed */
+        ObjectPool& operator=(ObjectPool&&) = delete;
+
+        /** @brief Block size */
+        std::size_t blockSize() const { return _blockSize; }
+
+        /** @brief Count of allocated blocks */
+        std::size_t size() const { return _size; }
+
+        /**
+         * @brief Count of blocks the pool can hold without allocating
+         *
+         * @see @ref reserve()
+         */
+        std::size_t capacity() const { return _capacity; }
+
+        /**
+         * @brief Reserve memory for given count of blocks
+         *
+         * Allocates all the needed memory in a single chunk, so creating
+         * given count of objects doesn't need any further allocation. Does
+         * nothing if the capacity is already large enough.
+         */
+        void reserve(std::size_t count);
+
+        /**
+         * @brief Allocate a block
+         *
+         * Takes a block from the free list, allocating a new chunk if there
+         * are no free blocks.
+         */
+        void* allocate();
+
+        /**
+         * @brief Deallocate a block
+         *
+         * Puts the block back to the free list. Expects that the block was
+         * allocated from this pool.
+         */
+        void deallocate(void* block);
+
+        /**
+         * @brief Release unused memory
+         *
+         * If there are no allocated blocks, frees all chunks. Otherwise does
+         * nothing.
+         */
+        void shrink();
+
+    private:
+        struct FreeBlock { FreeBlock* next; };
+
+        MAGNUM_SCENEGRAPH_LOCAL void grow(std::size_t count);
+
+        std::size_t _blockSize, _chunkBlockCount, _size, _capacity;
+        std::vector<std::pair<char*, std::size_t>> _chunks;
+        FreeBlock* _free;
+};
+
+/**
+@brief Pool allocation policy for objects and features
+
+Adds class-specific @cpp operator new @ce and @cpp operator delete @ce to
+given type, allocating its instances from an @ref ObjectPool shared by all
+instances of the type. Derive your object or feature type from it:
+
+@code{.cpp}
+class ChunkObject: public Object3D, public SceneGraph::PoolAllocated<ChunkObject> {
+    public:
+        explicit ChunkObject(Object3D* parent = nullptr): Object3D{parent} {}
+};
+
+class ChunkDrawable: public SceneGraph::Drawable3D, public SceneGraph::PoolAllocated<ChunkDrawable> {
+    // ...
+};
+@endcode
+
+As objects and features have virtual destructors, their deletion by the
+scene graph goes to the pool as well, so destroying a whole subtree (i.e.,
+deleting its root object) just puts all its blocks back to the free list and
+creating new objects afterwards reuses them without touching the heap. Use
+@ref pool() and @ref ObjectPool::reserve() to preallocate memory for objects
+created in bulk:
+
+@code{.cpp}
+SceneGraph::PoolAllocated<ChunkObject>::pool().reserve(10000);
+
+auto chunk = new ChunkObject{&scene};
+for(std::size_t i = 0; i != 9999; ++i) new ChunkObject{chunk};
+
+// ...
+
+delete chunk; // returns all 10000 blocks to the pool
+@endcode
+
+Subclasses of @p T larger than @p T are allocated on the heap as usual. The
+pool is not thread-safe, same as the rest of the scene graph.
+*/
+template<class T> class PoolAllocated {
+    public:
+        /**
+         * @brief Pool for given type
+         *
+         * Created on first use with block size equal to @cpp sizeof(T) @ce.
+         * The pool is intentionally never destroyed, so objects that are
+         * still alive at program exit (for example in a scene that is a
+         * global variable, destroyed after the pool would be) don't trigger
+         * the @ref ObjectPool::~ObjectPool() assertion and can still be
+         * deallocated. The memory is released by the operating system.
+         */
+        static ObjectPool& pool() {
+            static ObjectPool& pool = *new ObjectPool{sizeof(T)};
+            return pool;
+        }
+
+        #ifndef DOXYGEN_GENERATING_OUTPUT
+        static void* operator new(std::size_t size) {
+            return size <= sizeof(T) ? pool().allocate() : ::operator new(size);
+        }
+
+        static void operator delete(void* block, std::size_t size) {
+            if(size <= sizeof(T)) pool().deallocate(block);
+            else ::operator delete(block);
+        }
+        #endif
+
+    protected:
+        ~PoolAllocated() = default;
+};
+
+}}
+
+#endif
@@ -0,0 +1,258 @@
+#ifndef Magnum_SceneGraph_OcclusionCuller_h
+#define Magnum_SceneGraph_OcclusionCuller_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::BasicOcclusionCuller3D, typedef @ref Magnum::SceneGraph::OcclusionCuller3D
+ */
+#endif
+
+#include <functional>
+#include <unordered_map>
+#include <vector>
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/SampleQuery.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/SceneGraph/SceneGraph.h"
+#include "Magnum/SceneGraph/visibility.h"
+
+#if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Hardware occlusion culler for three-dimensional scenes
+
+Draws a @ref DrawableGroup like @ref Camera::drawCulled(), but additionally
+skips drawables that are hidden behind other drawables. The visibility is
+determined using @ref SampleQuery::Target::AnySamplesPassed queries, which are
+read back asynchronously, at earliest in the next frame, so the CPU never
+waits for the GPU. Each @ref draw() does the following:
+
+1.  Results of all queries that finished since the last frame are collected
+    and the visibility of corresponding drawables updated.
+2.  Drawables outside of the view frustum are skipped the same way as in
+    @ref Camera::drawCulled().
+3.  Drawables that were visible in the last frame are drawn front to back,
+    each wrapped in a query to detect when it becomes occluded.
+4.  With color and depth writes disabled, a bounding box proxy is drawn for
+    every drawable that was occluded in the last frame, wrapped in a query to
+    detect when it becomes visible again.
+5.  Drawables that became occluded only recently are drawn using conditional
+    rendering on the proxy query from the previous step in
+    @ref SampleQuery::ConditionalRenderMode::NoWait mode, so they don't pop
+    out if the result of the last query was just a false positive. On
+    OpenGL ES and WebGL, where conditional rendering isn't available, they are
+    drawn unconditionally instead.
+
+Drawables without a bounding box set using @ref Drawable::setBoundingBox()
+are always drawn and never queried. A drawable is also always considered
+visible when the camera is inside its bounding box, as the proxy would get
+clipped by the near plane in that case.
+
+The proxy is drawn using a function passed in the constructor. It gets a
+transformation projection matrix that transforms a cube from
+@f$ [-1, 1]^3 @f$ to the drawable bounding box in clip space. In the simplest
+case it's enough to draw a @ref Primitives::cubeSolid() mesh with
+@ref Shaders::Flat3D. Depth test is expected to be enabled:
+
+@code{.cpp}
+Mesh cube;
+std::unique_ptr<Buffer> vertices, indices;
+std::tie(cube, vertices, indices) = MeshTools::compile(Primitives::cubeSolid(), BufferUsage::StaticDraw);
+Shaders::Flat3D proxyShader;
+SceneGraph::OcclusionCuller3D culler{[&](const Matrix4& transformationProjection) {
+    proxyShader.setTransformationProjectionMatrix(transformationProjection);
+    cube.draw(proxyShader);
+}};
+
+// each frame
+culler.draw(*camera, drawables);
+@endcode
+
+@section SceneGraph-OcclusionCuller-queries Query pool
+
+All queries are created upfront in the constructor and reused in a ring, the
+pool size is given by @ref queryCount(). A drawable has at most one query in
+flight --- until its result is available, the drawable keeps its last known
+visibility state. If the ring is exhausted, remaining drawables are drawn
+without a query and thus keep their state until the next frame.
+
+Visibility state is remembered only for drawables that were inside the frustum
+in the last frame, a drawable that enters the frustum again is considered
+visible. Call @ref reset() after a camera cut to drop all state.
+
+@section SceneGraph-OcclusionCuller-explicit-specializations Explicit template specializations
+
+The following specialization is explicitly compiled into @ref SceneGraph
+library. For other specializations (e.g. using @ref Magnum::Double "Double"
+type) you have to use @ref OcclusionCuller.hpp implementation file to avoid
+linker errors. See also @ref compilation-speedup-hpp for more information.
+
+-   @ref OcclusionCuller3D
+
+@see @ref scenegraph, @ref OcclusionCuller3D
+@requires_gl33 Extension @extension{ARB,occlusion_query2}
+@requires_gl30 Extension @extension{NV,conditional_render} for drawing of
+    recently occluded drawables, unconditional rendering is used otherwise
+@requires_gles30 Extension @extension{EXT,occlusion_query_boolean} in
+    OpenGL ES 2.0.
+@requires_webgl20 Queries are not available in WebGL 1.0.
+*/
+template<class T> class BasicOcclusionCuller3D {
+    public:
+        /**
+         * @brief Proxy drawer
+         *
+         * Gets a transformation projection matrix of the bounding box proxy.
+         */
+        typedef std::function<void(const Math::Matrix4<T>&)> ProxyDrawer;
+
+        /**
+         * @brief Constructor
+         * @param proxyDrawer   Function drawing the bounding box proxy
+         * @param queryCount    Count of queries in the pool
+         *
+         * Creates all queries upfront, thus it expects an active
+         * @ref Context.
+         */
+        explicit BasicOcclusionCuller3D(ProxyDrawer proxyDrawer, std::size_t queryCount = 1024);
+
+        /** @brief Copying is not allowed */
+        BasicOcclusionCuller3D(const BasicOcclusionCuller3D<T>&) = delete;
+
+        /** @brief Moving is not allowed */
+        BasicOcclusionCuller3D(BasicOcclusionCuller3D<T>&&) = delete;
+
+        ~BasicOcclusionCuller3D();
+
+        /** @brief Copying is not allowed */
+        BasicOcclusionCuller3D<T>& operator=(const BasicOcclusionCuller3D<T>&) = delete;
+
+        /** @brief Moving is not allowed */
+        BasicOcclusionCuller3D<T>& operator=(BasicOcclusionCuller3D<T>&&) = delete;
+
+        /** @brief Count of queries in the pool */
+        std::size_t queryCount() const { return _queries.size(); }
+
+        /** @brief Count of queries that are currently in flight */
+        std::size_t pendingQueryCount() const { return _pendingQueryCount; }
+
+        /**
+         * @brief Count of frames during which occluded drawables are drawn conditionally
+         *
+         * @see @ref setBorderlineFrameCount()
+         */
+        UnsignedInt borderlineFrameCount() const { return _borderlineFrameCount; }
+
+        /**
+         * @brief Set count of frames during which occluded drawables are drawn conditionally
+         * @return Reference to self (for method chaining)
+         *
+         * After a drawable is reported as occluded, it is still drawn using
+         * conditional rendering for given count of frames before it gets
+         * skipped altogether. Setting the value to @cpp 0 @ce skips the
+         * drawables right away. Default is @cpp 2 @ce.
+         */
+        BasicOcclusionCuller3D<T>& setBorderlineFrameCount(UnsignedInt count) {
+            _borderlineFrameCount = count;
+            return *this;
+        }
+
+        /**
+         * @brief Count of drawables that were skipped in last draw
+         *
+         * Drawables outside of the frustum are not counted.
+         */
+        std::size_t occludedCount() const { return _occludedCount; }
+
+        /**
+         * @brief Draw with occlusion culling
+         * @return Count of drawables that were drawn, including drawables
+         *      drawn using conditional rendering
+         *
+         * See @ref BasicOcclusionCuller3D "class documentation" for more
+         * information. Color mask and depth mask are set to
+         * @cpp true @ce at the end if any proxy was drawn.
+         */
+        std::size_t draw(BasicCamera3D<T>& camera, DrawableGroup<3, T>& group);
+
+        /**
+         * @brief Reset visibility state
+         *
+         * All drawables are considered visible in the next frame. Results of
+         * queries that are in flight will be ignored.
+         */
+        void reset();
+
+    private:
+        struct State {
+            UnsignedInt occludedFrames{}, frame{};
+            bool pending{};
+        };
+
+        bool issueQuery(Drawable<3, T>& drawable, State& state, std::size_t& id);
+
+        ProxyDrawer _proxyDrawer;
+        UnsignedInt _borderlineFrameCount{2}, _frame{};
+        std::size_t _occludedCount{};
+
+        /* Query ring */
+        std::vector<SampleQuery> _queries;
+        std::vector<Drawable<3, T>*> _queryDrawables;
+        std::size_t _firstPendingQuery{}, _pendingQueryCount{};
+
+        std::unordered_map<Drawable<3, T>*, State> _states;
+
+        /* Scratch storage for draw() */
+        std::vector<std::reference_wrapper<AbstractObject<3, T>>> _drawableObjects;
+        std::vector<Math::Matrix4<T>> _drawableTransformations;
+        std::vector<Math::Range3D<T>> _drawableBoxes;
+        Containers::Array<bool> _drawableVisible;
+        std::vector<UnsignedInt> _drawableDepths, _visible, _visibleScratch, _occluded;
+        std::vector<std::size_t> _occludedQueries;
+};
+
+/**
+@brief Hardware occlusion culler for three-dimensional float scenes
+
+@see @ref BasicOcclusionCuller3D
+*/
+typedef BasicOcclusionCuller3D<Float> OcclusionCuller3D;
+
+#if defined(CORRADE_TARGET_WINDOWS) && !defined(__MINGW32__)
+extern template class MAGNUM_SCENEGRAPH_EXPORT BasicOcclusionCuller3D<Float>;
+#endif
+
+}}
+#else
+#error this header is not available in WebGL 1.0 build
+#endif
+
+#endif
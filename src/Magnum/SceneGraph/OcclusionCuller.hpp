@@ -0,0 +1,231 @@
+#ifndef Magnum_SceneGraph_OcclusionCuller_hpp
+#define Magnum_SceneGraph_OcclusionCuller_hpp
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+/** @file
+ * @brief @ref compilation-speedup-hpp "Template implementation" for @ref OcclusionCuller.h
+ */
+
+#include <utility>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Renderer.h"
+#include "Magnum/SceneGraph/Camera.hpp"
+#include "Magnum/SceneGraph/Drawable.h"
+#include "Magnum/SceneGraph/OcclusionCuller.h"
+
+namespace Magnum { namespace SceneGraph {
+
+template<class T> BasicOcclusionCuller3D<T>::BasicOcclusionCuller3D(ProxyDrawer proxyDrawer, const std::size_t queryCount): _proxyDrawer{std::move(proxyDrawer)}, _queryDrawables(queryCount) {
+    CORRADE_ASSERT(queryCount, "SceneGraph::OcclusionCuller3D: expected non-zero query count", );
+
+    _queries.reserve(queryCount);
+    for(std::size_t i = 0; i != queryCount; ++i)
+        _queries.emplace_back(SampleQuery::Target::AnySamplesPassed);
+}
+
+template<class T> BasicOcclusionCuller3D<T>::~BasicOcclusionCuller3D() = default;
+
+template<class T> void BasicOcclusionCuller3D<T>::reset() {
+    _states.clear();
+
+    /* The queries can't be cancelled, only forget who they belong to */
+    for(std::size_t i = 0; i != _pendingQueryCount; ++i)
+        _queryDrawables[(_firstPendingQuery + i) % _queries.size()] = nullptr;
+}
+
+template<class T> bool BasicOcclusionCuller3D<T>::issueQuery(Drawable<3, T>& drawable, State& state, std::size_t& id) {
+    /* Ring is full, the drawable will retry next frame */
+    if(_pendingQueryCount == _queries.size()) return false;
+
+    id = (_firstPendingQuery + _pendingQueryCount) % _queries.size();
+    ++_pendingQueryCount;
+    _queryDrawables[id] = &drawable;
+    state.pending = true;
+    return true;
+}
+
+template<class T> std::size_t BasicOcclusionCuller3D<T>::draw(BasicCamera3D<T>& camera, DrawableGroup<3, T>& group) {
+    AbstractObject<3, T>* scene = camera.object().scene();
+    CORRADE_ASSERT(scene, "SceneGraph::OcclusionCuller3D::draw(): cannot draw when camera is not part of any scene", 0);
+
+    ++_frame;
+
+    /* Collect results of finished queries. These finish in the order they
+       were issued, so it's enough to stop at the first one that isn't. */
+    while(_pendingQueryCount) {
+        SampleQuery& query = _queries[_firstPendingQuery];
+        if(!query.resultAvailable()) break;
+
+        const bool visible = query.result<bool>();
+        const auto found = _states.find(_queryDrawables[_firstPendingQuery]);
+        if(found != _states.end()) {
+            State& state = found->second;
+            state.pending = false;
+            if(visible) state.occludedFrames = 0;
+            else if(state.occludedFrames != ~UnsignedInt{}) ++state.occludedFrames;
+        }
+
+        _firstPendingQuery = (_firstPendingQuery + 1) % _queries.size();
+        --_pendingQueryCount;
+    }
+
+    /* Compute transformations of all objects in the group relative to the
+       camera */
+    const Math::Matrix4<T> cameraMatrix = camera.cameraMatrix();
+    const Math::Matrix4<T> projectionMatrix = camera.projectionMatrix();
+    _drawableObjects.clear();
+    for(std::size_t i = 0; i != group.size(); ++i)
+        _drawableObjects.push_back(group[i].object());
+    _drawableTransformations.resize(group.size());
+    scene->transformationMatrices(_drawableObjects, {_drawableTransformations.data(), _drawableTransformations.size()}, cameraMatrix);
+
+    /* Bring all bounding boxes to camera space and cull them against the
+       frustum at once, same as Camera::drawCulled() */
+    _drawableBoxes.clear();
+    for(std::size_t i = 0; i != group.size(); ++i) {
+        const Drawable<3, T>& drawable = group[i];
+        if(drawable.hasBoundingBox())
+            _drawableBoxes.push_back(Implementation::CameraCulling<3, T>::transformBox(_drawableTransformations[i], drawable.boundingBox()));
+    }
+    if(_drawableVisible.size() < _drawableBoxes.size())
+        _drawableVisible = Containers::Array<bool>{_drawableBoxes.size()};
+    Implementation::CameraCulling<3, T>::cullInto(_drawableBoxes, projectionMatrix, {_drawableVisible.data(), _drawableBoxes.size()});
+
+    /* Classify the drawables inside the frustum */
+    _visible.clear();
+    _occluded.clear();
+    std::size_t box = 0;
+    for(std::size_t i = 0; i != group.size(); ++i) {
+        Drawable<3, T>& drawable = group[i];
+        if(!drawable.hasBoundingBox()) {
+            _visible.push_back(UnsignedInt(i));
+            continue;
+        }
+
+        if(!_drawableVisible[box++]) continue;
+
+        State& state = _states[&drawable];
+        state.frame = _frame;
+
+        /* The proxy would be clipped by the near plane if the camera is
+           inside the box */
+        if(state.occludedFrames && drawable.boundingBox().contains(_drawableTransformations[i].inverted().translation()))
+            state.occludedFrames = 0;
+
+        (state.occludedFrames ? _occluded : _visible).push_back(UnsignedInt(i));
+    }
+
+    /* Drop state of drawables that weren't seen in this frame */
+    for(auto it = _states.begin(); it != _states.end(); ) {
+        if(it->second.frame != _frame) it = _states.erase(it);
+        else ++it;
+    }
+
+    /* Draw the visible drawables front to back, so they occlude as much as
+       possible */
+    _drawableDepths.resize(group.size());
+    for(UnsignedInt i: _visible)
+        _drawableDepths[i] = Implementation::sortableDepth(Implementation::drawableDepth(_drawableTransformations[i]));
+    Implementation::radixSortIndices(_drawableDepths, _visible, _visibleScratch);
+
+    std::size_t drawn = 0;
+    for(UnsignedInt i: _visible) {
+        Drawable<3, T>& drawable = group[i];
+        std::size_t query;
+        if(drawable.hasBoundingBox()) {
+            State& state = _states[&drawable];
+            if(!state.pending && issueQuery(drawable, state, query)) {
+                _queries[query].begin();
+                drawable.draw(_drawableTransformations[i], camera);
+                _queries[query].end();
+                ++drawn;
+                continue;
+            }
+        }
+
+        drawable.draw(_drawableTransformations[i], camera);
+        ++drawn;
+    }
+
+    if(_occluded.empty()) {
+        _occludedCount = 0;
+        return drawn;
+    }
+
+    /* Test bounding box proxies of the occluded drawables against the depth
+       buffer filled by the visible ones */
+    Renderer::setColorMask(false, false, false, false);
+    Renderer::setDepthMask(false);
+    _occludedQueries.resize(_occluded.size());
+    for(std::size_t i = 0; i != _occluded.size(); ++i) {
+        Drawable<3, T>& drawable = group[_occluded[i]];
+        State& state = _states[&drawable];
+        std::size_t& query = _occludedQueries[i];
+        if(state.pending || !issueQuery(drawable, state, query)) {
+            query = _queries.size();
+            continue;
+        }
+
+        const Math::Range3D<T> box = drawable.boundingBox();
+        _queries[query].begin();
+        _proxyDrawer(projectionMatrix*_drawableTransformations[_occluded[i]]*Math::Matrix4<T>::translation(box.center())*Math::Matrix4<T>::scaling(box.size()/T(2)));
+        _queries[query].end();
+    }
+    Renderer::setDepthMask(true);
+    Renderer::setColorMask(true, true, true, true);
+
+    /* Draw the recently occluded drawables conditionally on the proxy query,
+       skip the rest */
+    _occludedCount = 0;
+    for(std::size_t i = 0; i != _occluded.size(); ++i) {
+        Drawable<3, T>& drawable = group[_occluded[i]];
+        if(_states[&drawable].occludedFrames > _borderlineFrameCount) {
+            ++_occludedCount;
+            continue;
+        }
+
+        #ifndef MAGNUM_TARGET_GLES
+        const std::size_t query = _occludedQueries[i];
+        if(query != _queries.size()) {
+            _queries[query].beginConditionalRender(SampleQuery::ConditionalRenderMode::NoWait);
+            drawable.draw(_drawableTransformations[_occluded[i]], camera);
+            _queries[query].endConditionalRender();
+        } else
+        #endif
+        {
+            drawable.draw(_drawableTransformations[_occluded[i]], camera);
+        }
+        ++drawn;
+    }
+
+    return drawn;
+}
+
+}}
+
+#endif
@@ -29,6 +29,8 @@
  * @brief Class @ref Magnum::SceneGraph::Scene
  */
 
+#include <utility>
+
 #include "Magnum/SceneGraph/Object.h"
 
 namespace Magnum { namespace SceneGraph {
@@ -38,13 +40,66 @@ namespace Magnum { namespace SceneGraph {
 
 Basically @ref Object which cannot have parent or non-default transformation.
 See @ref scenegraph for introduction.
+
+@section SceneGraph-Scene-explicit-specializations Explicit template specializations
+
+The following specializations are explicitly compiled into @ref SceneGraph
+library. For other specializations (e.g. using @ref Magnum::Double "Double"
+type or special transformation class) you have to use @ref Object.hpp
+implementation file to avoid linker errors. See also
+@ref compilation-speedup-hpp for more information.
+
+-   @ref DualComplexTransformation "Scene<DualComplexTransformation>"
+-   @ref DualQuaternionTransformation "Scene<DualQuaternionTransformation>"
+-   @ref MatrixTransformation2D "Scene<MatrixTransformation2D>"
+-   @ref MatrixTransformation3D "Scene<MatrixTransformation3D>"
+-   @ref RigidMatrixTransformation2D "Scene<RigidMatrixTransformation2D>"
+-   @ref RigidMatrixTransformation3D "Scene<RigidMatrixTransformation3D>"
+-   @ref TranslationTransformation2D "Scene<TranslationTransformation2D>"
+-   @ref TranslationTransformation3D "Scene<TranslationTransformation3D>"
 */
 template<class Transformation> class Scene: public Object<Transformation> {
     public:
-        explicit Scene() = default;
+        explicit Scene();
+
+        /**
+         * @brief Destructor
+         *
+         * Destroys all objects in the scene.
+         */
+        ~Scene();
+
+        /**
+         * @brief Clean all dirty objects in the scene
+         *
+         * Every object that becomes dirty through @ref Object::setDirty()
+         * (which is called also when changing object transformation or
+         * parent) is put into a list kept by the scene. This function goes
+         * through the list and for each object that is still dirty, it finds
+         * its topmost dirty ancestor and cleans the whole dirty subtree
+         * under it, from parents to children. Every dirty object is thus
+         * cleaned exactly once and subtrees not affected by any change since
+         * last call are not touched at all. The list is emptied afterwards.
+         * @see @ref scenegraph-features-caching, @ref Object::setClean()
+         */
+        void cleanAll();
 
     private:
+        #ifndef DOXYGEN_GENERATING_OUTPUT /* https://bugzilla.gnome.org/show_bug.cgi?id=776986 */
+        friend Object<Transformation>;
+        #endif
+
         bool isScene() const override final { return true; }
+
+        void cleanSubtree(Object<Transformation>& root);
+
+        std::vector<std::pair<Object<Transformation>*, typename Transformation::DataType>> _cleanStack;
+
+        /* Scratch storage for Object::transformations() and friends, reused
+           across calls to avoid allocations */
+        mutable std::vector<std::reference_wrapper<Object<Transformation>>> _objects, _jointObjects, _castObjects;
+        mutable std::vector<typename Transformation::DataType> _jointTransformations, _transformations;
+        mutable std::vector<UnsignedInt> _jointParents, _jointStack;
 };
 
 }}
@@ -94,12 +94,30 @@ template<class T> using BasicAnimableGroup3D = AnimableGroup<3, T>;
 typedef BasicAnimableGroup2D<Float> AnimableGroup2D;
 typedef BasicAnimableGroup3D<Float> AnimableGroup3D;
 
+template<UnsignedInt, class> class BoundingVolume;
+template<class T> using BasicBoundingVolume2D = BoundingVolume<2, T>;
+template<class T> using BasicBoundingVolume3D = BoundingVolume<3, T>;
+typedef BasicBoundingVolume2D<Float> BoundingVolume2D;
+typedef BasicBoundingVolume3D<Float> BoundingVolume3D;
+
+template<UnsignedInt, class> class BoundingVolumeHierarchy;
+template<class T> using BasicBoundingVolumeHierarchy2D = BoundingVolumeHierarchy<2, T>;
+template<class T> using BasicBoundingVolumeHierarchy3D = BoundingVolumeHierarchy<3, T>;
+typedef BasicBoundingVolumeHierarchy2D<Float> BoundingVolumeHierarchy2D;
+typedef BasicBoundingVolumeHierarchy3D<Float> BoundingVolumeHierarchy3D;
+
 template<UnsignedInt, class> class Camera;
 template<class T> using BasicCamera2D = Camera<2, T>;
 template<class T> using BasicCamera3D = Camera<3, T>;
 typedef BasicCamera2D<Float> Camera2D;
 typedef BasicCamera3D<Float> Camera3D;
 
+template<UnsignedInt, class> class DerivedTransformation;
+template<class T> using BasicDerivedTransformation2D = DerivedTransformation<2, T>;
+template<class T> using BasicDerivedTransformation3D = DerivedTransformation<3, T>;
+typedef BasicDerivedTransformation2D<Float> DerivedTransformation2D;
+typedef BasicDerivedTransformation3D<Float> DerivedTransformation3D;
+
 template<UnsignedInt, class> class Drawable;
 template<class T> using BasicDrawable2D = Drawable<2, T>;
 template<class T> using BasicDrawable3D = Drawable<3, T>;
@@ -117,18 +135,45 @@ template<class Feature, class T> using BasicFeatureGroup3D = FeatureGroup<3, Fea
 template<class Feature> using FeatureGroup2D = BasicFeatureGroup2D<Feature, Float>;
 template<class Feature> using FeatureGroup3D = BasicFeatureGroup3D<Feature, Float>;
 
+template<class Transformation> class FlatHierarchy;
+
+template<UnsignedInt, class> class InstancedDrawable;
+template<class T> using BasicInstancedDrawable2D = InstancedDrawable<2, T>;
+template<class T> using BasicInstancedDrawable3D = InstancedDrawable<3, T>;
+typedef BasicInstancedDrawable2D<Float> InstancedDrawable2D;
+typedef BasicInstancedDrawable3D<Float> InstancedDrawable3D;
+
+template<UnsignedInt, class> class InstancedDrawableGroup;
+template<class T> using BasicInstancedDrawableGroup2D = InstancedDrawableGroup<2, T>;
+template<class T> using BasicInstancedDrawableGroup3D = InstancedDrawableGroup<3, T>;
+typedef BasicInstancedDrawableGroup2D<Float> InstancedDrawableGroup2D;
+typedef BasicInstancedDrawableGroup3D<Float> InstancedDrawableGroup3D;
+
 template<UnsignedInt dimensions, class T> using DrawableGroup = FeatureGroup<dimensions, Drawable<dimensions, T>, T>;
 template<class T> using BasicDrawableGroup2D = DrawableGroup<2, T>;
 template<class T> using BasicDrawableGroup3D = DrawableGroup<3, T>;
 typedef BasicDrawableGroup2D<Float> DrawableGroup2D;
 typedef BasicDrawableGroup3D<Float> DrawableGroup3D;
 
+template<class> class BasicLod3D;
+typedef BasicLod3D<Float> Lod3D;
+
+template<class> class BasicLodGroup3D;
+typedef BasicLodGroup3D<Float> LodGroup3D;
+
 template<class> class BasicMatrixTransformation2D;
 template<class> class BasicMatrixTransformation3D;
 typedef BasicMatrixTransformation2D<Float> MatrixTransformation2D;
 typedef BasicMatrixTransformation3D<Float> MatrixTransformation3D;
 
 template<class Transformation> class Object;
+class ObjectPool;
+
+#if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+template<class> class BasicOcclusionCuller3D;
+typedef BasicOcclusionCuller3D<Float> OcclusionCuller3D;
+#endif
+template<class> class PoolAllocated;
 
 template<class> class BasicRigidMatrixTransformation2D;
 template<class> class BasicRigidMatrixTransformation3D;
@@ -137,6 +182,8 @@ typedef BasicRigidMatrixTransformation3D<Float> RigidMatrixTransformation3D;
 
 template<class Transformation> class Scene;
 
+template<class Transformation> class TrackAnimator;
+
 template<UnsignedInt, class T, class = T> class TranslationTransformation;
 template<class T, class TranslationType = T> using BasicTranslationTransformation2D = TranslationTransformation<2, T, TranslationType>;
 template<class T, class TranslationType = T> using BasicTranslationTransformation3D = TranslationTransformation<3, T, TranslationType>;
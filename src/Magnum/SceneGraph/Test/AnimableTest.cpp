@@ -23,12 +23,15 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <memory>
 #include <sstream>
+#include <vector>
 #include <Corrade/TestSuite/Tester.h>
 
 #include "Magnum/SceneGraph/Animable.h"
 #include "Magnum/SceneGraph/AnimableGroup.h"
 #include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Scene.h"
 
 namespace Magnum { namespace SceneGraph { namespace Test {
 
@@ -41,6 +44,7 @@ struct AnimableTest: TestSuite::Tester {
     void repeat();
     void stop();
     void pause();
+    void stepParallel();
 
     void deleteWhileRunning();
 
@@ -56,6 +60,7 @@ AnimableTest::AnimableTest() {
               &AnimableTest::repeat,
               &AnimableTest::stop,
               &AnimableTest::pause,
+              &AnimableTest::stepParallel,
 
               &AnimableTest::deleteWhileRunning,
 
@@ -355,6 +360,63 @@ void AnimableTest::pause() {
     CORRADE_COMPARE(animable.time, 2.0f);
 }
 
+void AnimableTest::stepParallel() {
+    class TranslatingAnimable: public SceneGraph::Animable3D {
+        public:
+            TranslatingAnimable(Object3D& object, AnimableGroup3D* group = nullptr): SceneGraph::Animable3D(object, group), _object(object) {
+                setDuration(10.0f);
+            }
+
+            Int started = 0;
+
+        protected:
+            void animationStep(Float t, Float d) override {
+                _object.setTransformation(Matrix4::translation({t, d, 0.0f}));
+            }
+
+            void animationStarted() override { ++started; }
+
+        private:
+            Object3D& _object;
+    };
+
+    Scene<MatrixTransformation3D> scene;
+    AnimableGroup3D group;
+    std::vector<std::unique_ptr<Object3D>> objects;
+    std::vector<std::unique_ptr<TranslatingAnimable>> animables;
+    for(std::size_t i = 0; i != 100; ++i) {
+        objects.emplace_back(new Object3D{&scene});
+        animables.emplace_back(new TranslatingAnimable{*objects.back(), &group});
+    }
+    scene.setClean();
+
+    /* Every other animation is running */
+    for(std::size_t i = 0; i < animables.size(); i += 2)
+        animables[i]->setState(AnimationState::Running);
+
+    ThreadPool pool{4};
+    group.step(5.0f, 0.5f, pool);
+    CORRADE_COMPARE(group.runningCount(), 50);
+    group.step(8.0f, 0.75f, pool, ThreadPool::Schedule::Static);
+    CORRADE_COMPARE(group.runningCount(), 50);
+
+    for(std::size_t i = 0; i != animables.size(); ++i) {
+        if(i % 2 == 0) {
+            CORRADE_COMPARE(animables[i]->started, 1);
+            CORRADE_VERIFY(objects[i]->isDirty());
+            CORRADE_COMPARE(objects[i]->transformation(), Matrix4::translation({3.0f, 0.75f, 0.0f}));
+        } else {
+            CORRADE_COMPARE(animables[i]->started, 0);
+            CORRADE_VERIFY(!objects[i]->isDirty());
+            CORRADE_COMPARE(objects[i]->transformation(), Matrix4{});
+        }
+    }
+
+    /* Exceeding the duration stops everything */
+    group.step(20.0f, 12.0f, pool);
+    CORRADE_COMPARE(group.runningCount(), 0);
+}
+
 void AnimableTest::deleteWhileRunning() {
     Object3D object;
     AnimableGroup3D group;
@@ -0,0 +1,277 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <vector>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/SceneGraph/BoundingVolume.h"
+#include "Magnum/SceneGraph/BoundingVolumeHierarchy.h"
+#include "Magnum/SceneGraph/MatrixTransformation2D.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+struct BoundingVolumeHierarchyTest: TestSuite::Tester {
+    explicit BoundingVolumeHierarchyTest();
+
+    void empty();
+    void absoluteBox();
+    void bounds();
+    void boxQuery();
+    void sphereQuery();
+    void rayQuery();
+    void frustumQuery();
+    void frustumQuery2D();
+    void updateMoved();
+    void updateChangedBox();
+    void updateAddRemove();
+    void rebuild();
+};
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation2D> Object2D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation2D> Scene2D;
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+template<UnsignedInt dimensions> class IdVolume: public BoundingVolume<dimensions, Float> {
+    public:
+        explicit IdVolume(AbstractObject<dimensions, Float>& object, BoundingVolumeHierarchy<dimensions, Float>* hierarchy, Int id): BoundingVolume<dimensions, Float>{object, {VectorTypeFor<dimensions, Float>{-1.0f}, VectorTypeFor<dimensions, Float>{1.0f}}, hierarchy}, id{id} {}
+
+        Int id;
+};
+
+template<UnsignedInt dimensions> std::vector<Int> ids(const std::vector<BoundingVolume<dimensions, Float>*>& volumes, bool sort = true) {
+    std::vector<Int> out;
+    for(BoundingVolume<dimensions, Float>* volume: volumes)
+        out.push_back(static_cast<IdVolume<dimensions>*>(volume)->id);
+    if(sort) std::sort(out.begin(), out.end());
+    return out;
+}
+
+/* Ten unit-sized boxes along the X axis, spaced by 3 units, the first one is
+   at the origin */
+struct Row {
+    explicit Row() {
+        for(Int i = 0; i != 10; ++i) {
+            objects[i] = new Object3D{&scene};
+            objects[i]->translate(Vector3::xAxis(i*3.0f));
+            new IdVolume<3>{*objects[i], &hierarchy, i};
+        }
+    }
+
+    Scene3D scene;
+    Object3D* objects[10];
+    BoundingVolumeHierarchy3D hierarchy;
+};
+
+BoundingVolumeHierarchyTest::BoundingVolumeHierarchyTest() {
+    addTests({&BoundingVolumeHierarchyTest::empty,
+              &BoundingVolumeHierarchyTest::absoluteBox,
+              &BoundingVolumeHierarchyTest::bounds,
+              &BoundingVolumeHierarchyTest::boxQuery,
+              &BoundingVolumeHierarchyTest::sphereQuery,
+              &BoundingVolumeHierarchyTest::rayQuery,
+              &BoundingVolumeHierarchyTest::frustumQuery,
+              &BoundingVolumeHierarchyTest::frustumQuery2D,
+              &BoundingVolumeHierarchyTest::updateMoved,
+              &BoundingVolumeHierarchyTest::updateChangedBox,
+              &BoundingVolumeHierarchyTest::updateAddRemove,
+              &BoundingVolumeHierarchyTest::rebuild});
+}
+
+void BoundingVolumeHierarchyTest::empty() {
+    BoundingVolumeHierarchy3D hierarchy;
+    CORRADE_VERIFY(hierarchy.isDirty());
+
+    CORRADE_COMPARE(hierarchy.bounds(), Range3D{});
+    CORRADE_VERIFY(!hierarchy.isDirty());
+    CORRADE_VERIFY(hierarchy.boxQuery({Vector3{-100.0f}, Vector3{100.0f}}).empty());
+    CORRADE_VERIFY(hierarchy.rayQuery({}, Vector3::xAxis()).empty());
+}
+
+void BoundingVolumeHierarchyTest::absoluteBox() {
+    Scene3D scene;
+    Object3D parent{&scene};
+    parent.translate(Vector3::yAxis(5.0f));
+    Object3D object{&parent};
+    object.scale({2.0f, 1.0f, 1.0f})
+        .rotateZ(Deg(90.0f));
+
+    BoundingVolumeHierarchy3D hierarchy;
+    BoundingVolume3D volume{object, {{0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 1.0f}}, &hierarchy};
+    CORRADE_COMPARE(volume.box(), (Range3D{{0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 1.0f}}));
+    CORRADE_COMPARE(volume.hierarchy(), &hierarchy);
+
+    hierarchy.update();
+    CORRADE_COMPARE(volume.absoluteBox(), (Range3D{{-1.0f, 5.0f, 0.0f}, {0.0f, 7.0f, 1.0f}}));
+}
+
+void BoundingVolumeHierarchyTest::bounds() {
+    Row row;
+    CORRADE_COMPARE(row.hierarchy.bounds(), (Range3D{{-1.0f, -1.0f, -1.0f}, {28.0f, 1.0f, 1.0f}}));
+}
+
+void BoundingVolumeHierarchyTest::boxQuery() {
+    Row row;
+    CORRADE_COMPARE_AS(ids(row.hierarchy.boxQuery({{5.5f, -0.5f, -0.5f}, {9.5f, 0.5f, 0.5f}})),
+        (std::vector<Int>{2, 3}), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(ids(row.hierarchy.boxQuery({{-10.0f, -10.0f, -10.0f}, {100.0f, 10.0f, 10.0f}})),
+        (std::vector<Int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}), TestSuite::Compare::Container);
+    /* Between two boxes */
+    CORRADE_VERIFY(row.hierarchy.boxQuery({{1.5f, -0.5f, -0.5f}, {1.75f, 0.5f, 0.5f}}).empty());
+}
+
+void BoundingVolumeHierarchyTest::sphereQuery() {
+    Row row;
+    CORRADE_COMPARE_AS(ids(row.hierarchy.sphereQuery({12.0f, 0.0f, 0.0f}, 2.5f)),
+        (std::vector<Int>{3, 4, 5}), TestSuite::Compare::Container);
+    /* Close to the box corner, but not touching it */
+    CORRADE_VERIFY(row.hierarchy.sphereQuery({-2.0f, 2.0f, 2.0f}, 1.5f).empty());
+}
+
+void BoundingVolumeHierarchyTest::rayQuery() {
+    Row row;
+
+    /* Sorted by distance from the origin */
+    CORRADE_COMPARE_AS(ids(row.hierarchy.rayQuery({100.0f, 0.0f, 0.0f}, {-1.0f, 0.0f, 0.0f}), false),
+        (std::vector<Int>{9, 8, 7, 6, 5, 4, 3, 2, 1, 0}), TestSuite::Compare::Container);
+    /* The ray starts inside the fourth box */
+    CORRADE_COMPARE_AS(ids(row.hierarchy.rayQuery({9.5f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}), false),
+        (std::vector<Int>{3, 4, 5, 6, 7, 8, 9}), TestSuite::Compare::Container);
+    /* Diagonal through a single box */
+    CORRADE_COMPARE_AS(ids(row.hierarchy.rayQuery({6.0f, 10.0f, 10.0f}, {0.0f, -1.0f, -1.0f})),
+        (std::vector<Int>{2}), TestSuite::Compare::Container);
+    /* Pointing away */
+    CORRADE_VERIFY(row.hierarchy.rayQuery({0.0f, 5.0f, 0.0f}, {0.0f, 1.0f, 0.0f}).empty());
+}
+
+void BoundingVolumeHierarchyTest::frustumQuery() {
+    Row row;
+
+    /* Camera at X = 12, looking down the Z axis, seeing [-1, 1] in X and Y at
+       the distance of 5 units */
+    const Matrix4 projection = Matrix4::perspectiveProjection(Deg(22.619865f), 1.0f, 0.1f, 100.0f);
+    const Matrix4 camera = Matrix4::translation({12.0f, 0.0f, 5.0f}).inverted();
+    CORRADE_COMPARE_AS(ids(row.hierarchy.frustumQuery(Frustum::fromMatrix(projection*camera))),
+        (std::vector<Int>{4}), TestSuite::Compare::Container);
+}
+
+void BoundingVolumeHierarchyTest::frustumQuery2D() {
+    Scene2D scene;
+    BoundingVolumeHierarchy2D hierarchy;
+    Object2D a{&scene};
+    a.translate({-5.0f, 0.0f});
+    new IdVolume<2>{a, &hierarchy, 0};
+    Object2D b{&scene};
+    b.translate({5.0f, 0.0f});
+    new IdVolume<2>{b, &hierarchy, 1};
+
+    /* Sees [0, 10] in X, [-5, 5] in Y and Z */
+    const Matrix4 projection = Matrix4::orthographicProjection({10.0f, 10.0f}, -5.0f, 5.0f);
+    CORRADE_COMPARE_AS(ids(hierarchy.frustumQuery(Frustum::fromMatrix(projection*Matrix4::translation(Vector3::xAxis(-5.0f))))),
+        (std::vector<Int>{1}), TestSuite::Compare::Container);
+}
+
+void BoundingVolumeHierarchyTest::updateMoved() {
+    Row row;
+    row.hierarchy.update();
+    CORRADE_VERIFY(!row.hierarchy.isDirty());
+
+    /* Move the first box up, the hierarchy gets refitted */
+    row.objects[0]->translate(Vector3::yAxis(10.0f));
+    CORRADE_VERIFY(row.hierarchy.isDirty());
+    CORRADE_COMPARE(row.hierarchy.bounds(), (Range3D{{-1.0f, -1.0f, -1.0f}, {28.0f, 11.0f, 1.0f}}));
+    CORRADE_VERIFY(!row.hierarchy.isDirty());
+
+    CORRADE_COMPARE_AS(ids(row.hierarchy.boxQuery({{-1.0f, 9.0f, -1.0f}, {1.0f, 11.0f, 1.0f}})),
+        (std::vector<Int>{0}), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(ids(row.hierarchy.boxQuery({{-2.0f, -2.0f, -2.0f}, {4.0f, 2.0f, 2.0f}})),
+        (std::vector<Int>{1}), TestSuite::Compare::Container);
+
+    /* Moving a parent of an object affects it as well */
+    Object3D* child = new Object3D{row.objects[9]};
+    new IdVolume<3>{*child, &row.hierarchy, 10};
+    row.objects[9]->translate(Vector3::zAxis(-10.0f));
+    CORRADE_COMPARE_AS(ids(row.hierarchy.boxQuery({{26.0f, -1.0f, -11.0f}, {28.0f, 1.0f, -9.0f}})),
+        (std::vector<Int>{9, 10}), TestSuite::Compare::Container);
+}
+
+void BoundingVolumeHierarchyTest::updateChangedBox() {
+    Row row;
+    row.hierarchy.update();
+
+    row.hierarchy[5].setBox({{-1.0f, -1.0f, -1.0f}, {1.0f, 20.0f, 1.0f}});
+    CORRADE_VERIFY(row.hierarchy.isDirty());
+    CORRADE_COMPARE_AS(ids(row.hierarchy.sphereQuery({15.0f, 15.0f, 0.0f}, 1.0f)),
+        (std::vector<Int>{5}), TestSuite::Compare::Container);
+}
+
+void BoundingVolumeHierarchyTest::updateAddRemove() {
+    Row row;
+    row.hierarchy.update();
+
+    /* Added to an object that's already clean */
+    Object3D object{&row.scene};
+    object.translate(Vector3::yAxis(-10.0f));
+    object.setClean();
+    IdVolume<3> volume{object, nullptr, 10};
+    CORRADE_VERIFY(!row.hierarchy.isDirty());
+    row.hierarchy.add(volume);
+    CORRADE_VERIFY(row.hierarchy.isDirty());
+    CORRADE_COMPARE_AS(ids(row.hierarchy.sphereQuery({0.0f, -10.0f, 0.0f}, 0.5f)),
+        (std::vector<Int>{10}), TestSuite::Compare::Container);
+
+    /* Deleting an object removes its volume */
+    delete row.objects[3];
+    CORRADE_VERIFY(row.hierarchy.isDirty());
+    CORRADE_COMPARE_AS(ids(row.hierarchy.boxQuery({{-10.0f, -20.0f, -10.0f}, {100.0f, 10.0f, 10.0f}})),
+        (std::vector<Int>{0, 1, 2, 4, 5, 6, 7, 8, 9, 10}), TestSuite::Compare::Container);
+
+    row.hierarchy.remove(volume);
+    CORRADE_VERIFY(row.hierarchy.isDirty());
+    CORRADE_VERIFY(row.hierarchy.sphereQuery({0.0f, -10.0f, 0.0f}, 0.5f).empty());
+}
+
+void BoundingVolumeHierarchyTest::rebuild() {
+    Row row;
+    row.hierarchy.update();
+
+    /* Shuffle the objects around and rebuild, the queries stay the same */
+    for(Int i = 0; i != 10; ++i)
+        row.objects[i]->setTransformation(Matrix4::translation(Vector3::xAxis((9 - i)*3.0f)));
+    row.hierarchy.rebuild();
+    CORRADE_VERIFY(!row.hierarchy.isDirty());
+
+    CORRADE_COMPARE_AS(ids(row.hierarchy.rayQuery({100.0f, 0.0f, 0.0f}, {-1.0f, 0.0f, 0.0f}), false),
+        (std::vector<Int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}), TestSuite::Compare::Container);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::BoundingVolumeHierarchyTest)
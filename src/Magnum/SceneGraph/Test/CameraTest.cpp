@@ -23,8 +23,11 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <vector>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
 
+#include "Magnum/ThreadPool.h"
 #include "Magnum/SceneGraph/Camera.hpp" /* only for aspectRatioFix(), so it doesn't have to be exported */
 #include "Magnum/SceneGraph/Camera.h"
 #include "Magnum/SceneGraph/Drawable.h"
@@ -46,10 +49,17 @@ struct CameraTest: TestSuite::Tester {
     void projectionSizePerspective();
     void projectionSizeViewport();
     void draw();
+    void drawCulled2D();
+    void drawCulled3D();
+    void drawCulledTransformed();
+    void drawSorted();
+    void drawSortedDepth();
+    void drawDepth();
 };
 
 typedef SceneGraph::Object<SceneGraph::MatrixTransformation2D> Object2D;
 typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation2D> Scene2D;
 typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
 
 CameraTest::CameraTest() {
@@ -61,7 +71,13 @@ CameraTest::CameraTest() {
               &CameraTest::projectionSizeOrthographic,
               &CameraTest::projectionSizePerspective,
               &CameraTest::projectionSizeViewport,
-              &CameraTest::draw});
+              &CameraTest::draw,
+              &CameraTest::drawCulled2D,
+              &CameraTest::drawCulled3D,
+              &CameraTest::drawCulledTransformed,
+              &CameraTest::drawSorted,
+              &CameraTest::drawSortedDepth,
+              &CameraTest::drawDepth});
 }
 
 void CameraTest::fixAspectRatio() {
@@ -208,6 +224,286 @@ void CameraTest::draw() {
     CORRADE_COMPARE(firstTransformation, Matrix4::translation({0.0f, -3.0f, 1.5f})*Matrix4::scaling(Vector3(5.0f)));
     CORRADE_COMPARE(secondTransformation, Matrix4::translation(Vector3::zAxis(1.5f)));
     CORRADE_COMPARE(thirdTransformation, Matrix4());
+
+    /* Transformations computed in parallel give the same result */
+    ThreadPool pool{3};
+    firstTransformation = secondTransformation = thirdTransformation = Matrix4{Math::ZeroInit};
+    camera.draw(group, pool);
+    CORRADE_COMPARE(firstTransformation, Matrix4::translation({0.0f, -3.0f, 1.5f})*Matrix4::scaling(Vector3(5.0f)));
+    CORRADE_COMPARE(secondTransformation, Matrix4::translation(Vector3::zAxis(1.5f)));
+    CORRADE_COMPARE(thirdTransformation, Matrix4());
+}
+
+template<UnsignedInt dimensions> class FlagDrawable: public SceneGraph::Drawable<dimensions, Float> {
+    public:
+        FlagDrawable(AbstractObject<dimensions, Float>& object, DrawableGroup<dimensions, Float>& group, bool& drawn): SceneGraph::Drawable<dimensions, Float>{object, &group}, drawn(drawn) {}
+
+    protected:
+        void draw(const MatrixTypeFor<dimensions, Float>&, Camera<dimensions, Float>&) override {
+            drawn = true;
+        }
+
+    private:
+        bool& drawn;
+};
+
+void CameraTest::drawCulled2D() {
+    DrawableGroup2D group;
+    Scene2D scene;
+
+    /* Visible area is [-2, 2] in both directions */
+    Object2D cameraObject(&scene);
+    Camera2D camera(cameraObject);
+    camera.setProjectionMatrix(Matrix3::projection({4.0f, 4.0f}));
+
+    const Range2D box{Vector2{-0.5f}, Vector2{0.5f}};
+
+    Object2D inside(&scene);
+    inside.translate({1.0f, 0.0f});
+    bool insideDrawn = false;
+    (new FlagDrawable<2>{inside, group, insideDrawn})->setBoundingBox(box);
+
+    Object2D partial(&scene);
+    partial.translate({2.3f, 0.0f});
+    bool partialDrawn = false;
+    (new FlagDrawable<2>{partial, group, partialDrawn})->setBoundingBox(box);
+
+    Object2D outside(&scene);
+    outside.translate({0.0f, -5.0f});
+    bool outsideDrawn = false;
+    (new FlagDrawable<2>{outside, group, outsideDrawn})->setBoundingBox(box);
+
+    /* Outside, but without bounding box */
+    Object2D noBox(&scene);
+    noBox.translate({5.0f, 5.0f});
+    bool noBoxDrawn = false;
+    new FlagDrawable<2>{noBox, group, noBoxDrawn};
+
+    CORRADE_COMPARE(camera.drawCulled(group), 3);
+    CORRADE_VERIFY(insideDrawn);
+    CORRADE_VERIFY(partialDrawn);
+    CORRADE_VERIFY(!outsideDrawn);
+    CORRADE_VERIFY(noBoxDrawn);
+}
+
+void CameraTest::drawCulled3D() {
+    DrawableGroup3D group;
+    Scene3D scene;
+
+    /* Looking along -Z, for Z = -5 the visible area is [-5, 5] in X and Y */
+    Object3D cameraObject(&scene);
+    Camera3D camera(cameraObject);
+    camera.setProjectionMatrix(Matrix4::perspectiveProjection(Deg(90.0f), 1.0f, 0.1f, 100.0f));
+
+    const Range3D box{Vector3{-1.0f}, Vector3{1.0f}};
+
+    Object3D inside(&scene);
+    inside.translate({0.0f, 0.0f, -5.0f});
+    bool insideDrawn = false;
+    (new FlagDrawable<3>{inside, group, insideDrawn})->setBoundingBox(box);
+
+    Object3D partial(&scene);
+    partial.translate({5.5f, 0.0f, -5.0f});
+    bool partialDrawn = false;
+    (new FlagDrawable<3>{partial, group, partialDrawn})->setBoundingBox(box);
+
+    Object3D aside(&scene);
+    aside.translate({50.0f, 0.0f, -5.0f});
+    bool asideDrawn = false;
+    (new FlagDrawable<3>{aside, group, asideDrawn})->setBoundingBox(box);
+
+    Object3D behind(&scene);
+    behind.translate({0.0f, 0.0f, 5.0f});
+    bool behindDrawn = false;
+    (new FlagDrawable<3>{behind, group, behindDrawn})->setBoundingBox(box);
+
+    Object3D tooFar(&scene);
+    tooFar.translate({0.0f, 0.0f, -150.0f});
+    bool tooFarDrawn = false;
+    (new FlagDrawable<3>{tooFar, group, tooFarDrawn})->setBoundingBox(box);
+
+    /* Behind, but the bounding box was removed */
+    Object3D noBox(&scene);
+    noBox.translate({0.0f, 0.0f, 5.0f});
+    bool noBoxDrawn = false;
+    (new FlagDrawable<3>{noBox, group, noBoxDrawn})->setBoundingBox(box).resetBoundingBox();
+
+    CORRADE_COMPARE(camera.drawCulled(group), 3);
+    CORRADE_VERIFY(insideDrawn);
+    CORRADE_VERIFY(partialDrawn);
+    CORRADE_VERIFY(!asideDrawn);
+    CORRADE_VERIFY(!behindDrawn);
+    CORRADE_VERIFY(!tooFarDrawn);
+    CORRADE_VERIFY(noBoxDrawn);
+
+    /* Moving the camera changes what's visible */
+    cameraObject.translate({50.0f, 0.0f, 0.0f});
+    insideDrawn = partialDrawn = asideDrawn = behindDrawn = tooFarDrawn = noBoxDrawn = false;
+    CORRADE_COMPARE(camera.drawCulled(group), 2);
+    CORRADE_VERIFY(!insideDrawn);
+    CORRADE_VERIFY(asideDrawn);
+    CORRADE_VERIFY(noBoxDrawn);
+}
+
+void CameraTest::drawCulledTransformed() {
+    DrawableGroup3D group;
+    Scene3D scene;
+
+    /* Looking along -Z, for Z = -5 the visible area is [-5, 5] in X and Y */
+    Object3D cameraObject(&scene);
+    Camera3D camera(cameraObject);
+    camera.setProjectionMatrix(Matrix4::perspectiveProjection(Deg(90.0f), 1.0f, 0.1f, 100.0f));
+
+    const Range3D box{Vector3{-1.0f}, Vector3{1.0f}};
+
+    /* Rotated box reaches to X = -5.5 + sqrt(2) */
+    Object3D rotated(&scene);
+    rotated.rotateY(Deg(45.0f))
+        .translate({-5.5f, 0.0f, -5.0f});
+    bool rotatedDrawn = false;
+    (new FlagDrawable<3>{rotated, group, rotatedDrawn})->setBoundingBox(box);
+
+    /* Scaled down rotated box reaches only to X = -7 + sqrt(2)/2 */
+    Object3D scaled(&scene);
+    scaled.scale(Vector3{0.5f})
+        .rotateY(Deg(45.0f))
+        .translate({-7.0f, 0.0f, -5.0f});
+    bool scaledDrawn = false;
+    (new FlagDrawable<3>{scaled, group, scaledDrawn})->setBoundingBox(box);
+
+    CORRADE_COMPARE(camera.drawCulled(group), 1);
+    CORRADE_VERIFY(rotatedDrawn);
+    CORRADE_VERIFY(!scaledDrawn);
+}
+
+class IdDrawable: public SceneGraph::Drawable3D {
+    public:
+        IdDrawable(AbstractObject3D& object, DrawableGroup3D& group, std::vector<Int>& order, Int id): SceneGraph::Drawable3D{object, &group}, order(order), id{id} {}
+
+    protected:
+        void draw(const Matrix4&, Camera3D&) override {
+            order.push_back(id);
+        }
+
+    private:
+        std::vector<Int>& order;
+        Int id;
+};
+
+void CameraTest::drawSorted() {
+    DrawableGroup3D group;
+    Scene3D scene;
+    Object3D object(&scene);
+    Camera3D camera(object);
+
+    /* Keys differing in various bytes, equal keys keep their order */
+    std::vector<Int> order;
+    new IdDrawable{object, group, order, 0};
+    (new IdDrawable{object, group, order, 1})->setSortKey(0x0100000000000000ull);
+    (new IdDrawable{object, group, order, 2})->setSortKey(0x0000000000000102ull);
+    (new IdDrawable{object, group, order, 3})->setSortKey(0x0000000000000001ull);
+    (new IdDrawable{object, group, order, 4})->setSortKey(0x0000000000000102ull);
+    (new IdDrawable{object, group, order, 5})->setSortKey(0x0000ff0000000000ull);
+    new IdDrawable{object, group, order, 6};
+
+    camera.drawSorted(group);
+    CORRADE_COMPARE_AS(order, (std::vector<Int>{0, 6, 3, 2, 4, 5, 1}),
+        TestSuite::Compare::Container);
+
+    /* Drawing again gives the same result */
+    order.clear();
+    camera.drawSorted(group);
+    CORRADE_COMPARE_AS(order, (std::vector<Int>{0, 6, 3, 2, 4, 5, 1}),
+        TestSuite::Compare::Container);
+}
+
+void CameraTest::drawSortedDepth() {
+    DrawableGroup3D group;
+    Scene3D scene;
+    Object3D cameraObject(&scene);
+    Camera3D camera(cameraObject);
+
+    Object3D nearObject(&scene);
+    nearObject.translate(Vector3::zAxis(-1.0f));
+    Object3D farObject(&scene);
+    farObject.translate(Vector3::zAxis(-10.0f));
+    Object3D behind(&scene);
+    behind.translate(Vector3::zAxis(5.0f));
+
+    std::vector<Int> order;
+    (new IdDrawable{farObject, group, order, 0})->setSortKey(1);
+    (new IdDrawable{nearObject, group, order, 1})->setSortKey(1);
+    (new IdDrawable{behind, group, order, 2})->setSortKey(1);
+    new IdDrawable{farObject, group, order, 3};
+    new IdDrawable{nearObject, group, order, 4};
+
+    camera.drawSorted(group, DepthOrder::None);
+    CORRADE_COMPARE_AS(order, (std::vector<Int>{3, 4, 0, 1, 2}),
+        TestSuite::Compare::Container);
+
+    order.clear();
+    camera.drawSorted(group, DepthOrder::FrontToBack);
+    CORRADE_COMPARE_AS(order, (std::vector<Int>{4, 3, 2, 1, 0}),
+        TestSuite::Compare::Container);
+
+    order.clear();
+    camera.drawSorted(group, DepthOrder::BackToFront);
+    CORRADE_COMPARE_AS(order, (std::vector<Int>{3, 4, 0, 1, 2}),
+        TestSuite::Compare::Container);
+}
+
+class DepthDrawable: public SceneGraph::Drawable3D {
+    public:
+        DepthDrawable(AbstractObject3D& object, DrawableGroup3D& group, std::vector<Int>& order, Int id): SceneGraph::Drawable3D{object, &group}, order(order), id{id} {}
+
+    protected:
+        void draw(const Matrix4&, Camera3D&) override {
+            order.push_back(-id);
+        }
+
+        void drawDepth(const Matrix4&, Camera3D&) override {
+            order.push_back(id);
+        }
+
+    private:
+        std::vector<Int>& order;
+        Int id;
+};
+
+void CameraTest::drawDepth() {
+    DrawableGroup3D group;
+    Scene3D scene;
+    Object3D cameraObject(&scene);
+    Camera3D camera(cameraObject);
+    camera.setProjectionMatrix(Matrix4::perspectiveProjection(Deg(90.0f), 1.0f, 0.1f, 100.0f));
+
+    Object3D nearObject(&scene);
+    nearObject.translate(Vector3::zAxis(-1.0f));
+    Object3D farObject(&scene);
+    farObject.translate(Vector3::zAxis(-10.0f));
+    Object3D middleObject(&scene);
+    middleObject.translate(Vector3::zAxis(-5.0f));
+    Object3D behind(&scene);
+    behind.translate(Vector3::zAxis(5.0f));
+
+    const Range3D box{Vector3{-1.0f}, Vector3{1.0f}};
+    std::vector<Int> order;
+    (new DepthDrawable{farObject, group, order, 1})->setSortKey(0);
+    (new DepthDrawable{nearObject, group, order, 2})->setSortKey(2);
+    (new DepthDrawable{behind, group, order, 3})->setBoundingBox(box);
+    (new DepthDrawable{middleObject, group, order, 4})->setSortKey(1);
+
+    /* Sort keys are ignored, the culled drawable is skipped */
+    CORRADE_COMPARE(camera.drawDepth(group), 3);
+    CORRADE_COMPARE_AS(order, (std::vector<Int>{2, 4, 1}),
+        TestSuite::Compare::Container);
+
+    /* Drawables without a drawDepth() implementation do a regular draw */
+    order.clear();
+    new IdDrawable{nearObject, group, order, 5};
+    CORRADE_COMPARE(camera.drawDepth(group), 4);
+    CORRADE_COMPARE_AS(order, (std::vector<Int>{2, 5, 4, 1}),
+        TestSuite::Compare::Container);
 }
 
 }}}
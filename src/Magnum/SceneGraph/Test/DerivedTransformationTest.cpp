@@ -0,0 +1,172 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/SceneGraph/DerivedTransformation.h"
+#include "Magnum/SceneGraph/MatrixTransformation2D.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+struct DerivedTransformationTest: TestSuite::Tester {
+    explicit DerivedTransformationTest();
+
+    void construct();
+    void normalMatrix();
+    void normalMatrixCamera();
+    void boundingSphere();
+    void dirty();
+    void twoDimensions();
+};
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation2D> Object2D;
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation2D> Scene2D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+DerivedTransformationTest::DerivedTransformationTest() {
+    addTests({&DerivedTransformationTest::construct,
+              &DerivedTransformationTest::normalMatrix,
+              &DerivedTransformationTest::normalMatrixCamera,
+              &DerivedTransformationTest::boundingSphere,
+              &DerivedTransformationTest::dirty,
+              &DerivedTransformationTest::twoDimensions});
+}
+
+void DerivedTransformationTest::construct() {
+    Scene3D scene;
+    Object3D object{&scene};
+    object.setClean();
+
+    /* Adding the feature marks the object dirty so the data get computed on
+       next clean */
+    DerivedTransformation3D derived{object};
+    CORRADE_VERIFY(object.isDirty());
+    CORRADE_VERIFY(derived.cachedTransformations() == CachedTransformation::Absolute);
+    CORRADE_COMPARE(derived.normalMatrix(), Matrix3x3{Math::IdentityInit});
+    CORRADE_COMPARE(derived.boundingSphereRadius(), 0.0f);
+}
+
+void DerivedTransformationTest::normalMatrix() {
+    Scene3D scene;
+    Object3D parent{&scene};
+    parent.rotateY(Deg(35.0f))
+        .translate({1.0f, -2.0f, 3.0f});
+    Object3D object{&parent};
+    object.scale({2.0f, 0.5f, 3.0f})
+        .rotateX(Deg(-15.0f));
+    DerivedTransformation3D derived{object};
+
+    object.setClean();
+
+    const Matrix4 expected = parent.transformationMatrix()*object.transformationMatrix();
+    CORRADE_COMPARE(derived.absoluteTransformationMatrix(), expected);
+    CORRADE_COMPARE(derived.normalMatrix(), expected.rotationScaling().inverted().transposed());
+}
+
+void DerivedTransformationTest::normalMatrixCamera() {
+    Scene3D scene;
+    Object3D object{&scene};
+    object.scale({1.0f, 4.0f, 0.5f})
+        .rotateZ(Deg(60.0f));
+    DerivedTransformation3D derived{object};
+    object.setClean();
+
+    /* For a rigid camera the camera-relative normal matrix is the same as
+       the full inverse transpose */
+    const Matrix4 cameraMatrix = (Matrix4::translation({0.0f, 1.0f, 5.0f})*Matrix4::rotationY(Deg(25.0f))).invertedRigid();
+    const Matrix4 transformationMatrix = cameraMatrix*object.transformationMatrix();
+    CORRADE_COMPARE(derived.normalMatrix(cameraMatrix), transformationMatrix.rotationScaling().inverted().transposed());
+}
+
+void DerivedTransformationTest::boundingSphere() {
+    Scene3D scene;
+    Object3D object{&scene};
+    object.scale({1.0f, 3.0f, 2.0f})
+        .translate({0.0f, 0.0f, -4.0f});
+    DerivedTransformation3D derived{object};
+    derived.setBoundingSphere({1.0f, 1.0f, 0.0f}, 1.5f);
+
+    CORRADE_COMPARE(derived.boundingSphereCenter(), (Vector3{1.0f, 1.0f, 0.0f}));
+    CORRADE_COMPARE(derived.boundingSphereRadius(), 1.5f);
+
+    object.setClean();
+    CORRADE_COMPARE(derived.absoluteBoundingSphereCenter(), (Vector3{1.0f, 3.0f, -4.0f}));
+    /* Scaled by the largest axis scale */
+    CORRADE_COMPARE(derived.absoluteBoundingSphereRadius(), 4.5f);
+
+    /* Changing the sphere on a clean object updates the absolute values
+       right away */
+    derived.setBoundingSphere({}, 1.0f);
+    CORRADE_VERIFY(!object.isDirty());
+    CORRADE_COMPARE(derived.absoluteBoundingSphereCenter(), (Vector3{0.0f, 0.0f, -4.0f}));
+    CORRADE_COMPARE(derived.absoluteBoundingSphereRadius(), 3.0f);
+}
+
+void DerivedTransformationTest::dirty() {
+    Scene3D scene;
+    Object3D parent{&scene};
+    Object3D object{&parent};
+    DerivedTransformation3D derived{object};
+    derived.setBoundingSphere({}, 1.0f);
+    object.setClean();
+    CORRADE_COMPARE(derived.absoluteTransformationMatrix(), Matrix4{});
+
+    /* Transforming the parent makes the object dirty, the cached data are
+       recomputed on next clean */
+    parent.translate({0.0f, 5.0f, 0.0f})
+        .scale(Vector3{2.0f});
+    CORRADE_VERIFY(object.isDirty());
+    CORRADE_COMPARE(derived.absoluteBoundingSphereRadius(), 1.0f);
+
+    object.setClean();
+    CORRADE_COMPARE(derived.absoluteTransformationMatrix(), parent.transformationMatrix());
+    CORRADE_COMPARE(derived.normalMatrix(), Matrix3x3{Math::IdentityInit}*0.5f);
+    CORRADE_COMPARE(derived.absoluteBoundingSphereCenter(), (Vector3{0.0f, 10.0f, 0.0f}));
+    CORRADE_COMPARE(derived.absoluteBoundingSphereRadius(), 2.0f);
+}
+
+void DerivedTransformationTest::twoDimensions() {
+    Scene2D scene;
+    Object2D object{&scene};
+    object.scale({4.0f, 0.5f})
+        .rotate(Deg(30.0f))
+        .translate({-1.0f, 2.0f});
+    DerivedTransformation2D derived{object};
+    derived.setBoundingSphere({0.0f, 1.0f}, 0.5f);
+    object.setClean();
+
+    const Matrix3 expected = object.transformationMatrix();
+    CORRADE_COMPARE(derived.absoluteTransformationMatrix(), expected);
+    CORRADE_COMPARE(derived.normalMatrix(), expected.rotationScaling().inverted().transposed());
+    CORRADE_COMPARE(derived.absoluteBoundingSphereCenter(), expected.transformPoint({0.0f, 1.0f}));
+    CORRADE_COMPARE(derived.absoluteBoundingSphereRadius(), 2.0f);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::DerivedTransformationTest)
@@ -48,6 +48,8 @@ struct DualQuaternionTransformationTest: TestSuite::Tester {
     void translate();
     void rotate();
     void normalizeRotation();
+
+    void cleanRigid();
 };
 
 DualQuaternionTransformationTest::DualQuaternionTransformationTest() {
@@ -61,7 +63,9 @@ DualQuaternionTransformationTest::DualQuaternionTransformationTest() {
               &DualQuaternionTransformationTest::transform,
               &DualQuaternionTransformationTest::translate,
               &DualQuaternionTransformationTest::rotate,
-              &DualQuaternionTransformationTest::normalizeRotation});
+              &DualQuaternionTransformationTest::normalizeRotation,
+
+              &DualQuaternionTransformationTest::cleanRigid});
 }
 
 void DualQuaternionTransformationTest::fromMatrix() {
@@ -197,6 +201,41 @@ void DualQuaternionTransformationTest::normalizeRotation() {
     CORRADE_COMPARE(o.transformationMatrix(), Matrix4::rotationX(Deg(17.0f)));
 }
 
+void DualQuaternionTransformationTest::cleanRigid() {
+    class CachingFeature: public AbstractFeature3D {
+        public:
+            explicit CachingFeature(AbstractObject3D& object): AbstractFeature3D{object} {
+                setCachedTransformations(CachedTransformation::Absolute|CachedTransformation::AbsoluteRigid);
+            }
+
+            Int cleanCount{}, cleanRigidCount{};
+            DualQuaternion cleanedAbsoluteTransformation;
+
+            void clean(const Matrix4&) override {
+                ++cleanCount;
+            }
+
+            void cleanRigid(const DualQuaternion& absoluteTransformation) override {
+                ++cleanRigidCount;
+                cleanedAbsoluteTransformation = absoluteTransformation;
+            }
+    };
+
+    Scene3D s;
+    Object3D a{&s};
+    a.rotateX(Deg(17.0f));
+    Object3D b{&a};
+    b.translate({1.0f, -0.3f, 2.3f});
+    CachingFeature* feature = new CachingFeature{b};
+
+    /* The native representation is used instead of the matrix */
+    b.setClean();
+    CORRADE_COMPARE(feature->cleanCount, 0);
+    CORRADE_COMPARE(feature->cleanRigidCount, 1);
+    CORRADE_COMPARE(feature->cleanedAbsoluteTransformation,
+        DualQuaternion::rotation(Deg(17.0f), Vector3::xAxis())*DualQuaternion::translation({1.0f, -0.3f, 2.3f}));
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::DualQuaternionTransformationTest)
@@ -0,0 +1,521 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstring>
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+
+#include "Magnum/ThreadPool.h"
+#include "Magnum/SceneGraph/DualQuaternionTransformation.h"
+#include "Magnum/SceneGraph/FlatHierarchy.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+struct FlatHierarchyTest: TestSuite::Tester {
+    explicit FlatHierarchyTest();
+
+    void construct();
+    void constructSubtree();
+    void constructFromArrays();
+    void absoluteTransformations();
+    void absoluteTransformationsParallel();
+    void setTransformation();
+    void update();
+    void rebuild();
+    void setClean();
+    void setCleanSubtree();
+    void setCleanParallel();
+
+    void snapshotRestore();
+    void snapshotRestoreFeatureData();
+    void snapshotRestoreMismatch();
+    void snapshotInvalid();
+    void fromSnapshot();
+    void fromSnapshotFactory();
+};
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+typedef SceneGraph::FlatHierarchy<SceneGraph::MatrixTransformation3D> FlatHierarchy3D;
+
+class CachingObject: public Object3D, AbstractFeature3D {
+    public:
+        CachingObject(Object3D* parent = nullptr): Object3D(parent), AbstractFeature3D(*this) {
+            setCachedTransformations(CachedTransformation::Absolute);
+        }
+
+        Matrix4 cleanedAbsoluteTransformation;
+
+    protected:
+        void clean(const Matrix4& absoluteTransformation) override {
+            cleanedAbsoluteTransformation = absoluteTransformation;
+        }
+};
+
+class ValueObject: public Object3D {
+    public:
+        ValueObject(Object3D* parent = nullptr, Int value = 0): Object3D(parent), value{value} {}
+
+        Int value;
+};
+
+FlatHierarchyTest::FlatHierarchyTest() {
+    addTests({&FlatHierarchyTest::construct,
+              &FlatHierarchyTest::constructSubtree,
+              &FlatHierarchyTest::constructFromArrays,
+              &FlatHierarchyTest::absoluteTransformations,
+              &FlatHierarchyTest::absoluteTransformationsParallel,
+              &FlatHierarchyTest::setTransformation,
+              &FlatHierarchyTest::update,
+              &FlatHierarchyTest::rebuild,
+              &FlatHierarchyTest::setClean,
+              &FlatHierarchyTest::setCleanSubtree,
+              &FlatHierarchyTest::setCleanParallel,
+
+              &FlatHierarchyTest::snapshotRestore,
+              &FlatHierarchyTest::snapshotRestoreFeatureData,
+              &FlatHierarchyTest::snapshotRestoreMismatch,
+              &FlatHierarchyTest::snapshotInvalid,
+              &FlatHierarchyTest::fromSnapshot,
+              &FlatHierarchyTest::fromSnapshotFactory});
+}
+
+void FlatHierarchyTest::construct() {
+    Scene3D s;
+    Object3D a{&s};
+    Object3D aa{&a};
+    Object3D ab{&a};
+    Object3D b{&s};
+    Object3D ba{&b};
+
+    FlatHierarchy3D h{s};
+    CORRADE_COMPARE(h.size(), 6);
+    CORRADE_COMPARE(&h.root(), &s);
+    CORRADE_COMPARE(&h.object(0), &s);
+    CORRADE_COMPARE(&h.object(1), &a);
+    CORRADE_COMPARE(&h.object(2), &aa);
+    CORRADE_COMPARE(&h.object(3), &ab);
+    CORRADE_COMPARE(&h.object(4), &b);
+    CORRADE_COMPARE(&h.object(5), &ba);
+    CORRADE_COMPARE_AS(h.parents(), (std::vector<UnsignedInt>{
+        FlatHierarchy3D::NoParent, 0, 1, 1, 0, 4}), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(h.subtreeSizes(), (std::vector<UnsignedInt>{
+        6, 3, 1, 1, 2, 1}), TestSuite::Compare::Container);
+}
+
+void FlatHierarchyTest::constructSubtree() {
+    Scene3D s;
+    Object3D a{&s};
+    Object3D aa{&a};
+    Object3D b{&s};
+
+    FlatHierarchy3D h{a};
+    CORRADE_COMPARE(h.size(), 2);
+    CORRADE_COMPARE(&h.object(0), &a);
+    CORRADE_COMPARE(&h.object(1), &aa);
+    CORRADE_COMPARE_AS(h.parents(), (std::vector<UnsignedInt>{
+        FlatHierarchy3D::NoParent, 0}), TestSuite::Compare::Container);
+}
+
+void FlatHierarchyTest::constructFromArrays() {
+    Scene3D s;
+    Object3D existing{&s};
+
+    /* Depth-first order, so the objects keep their indices shifted by one */
+    FlatHierarchy3D h{existing, {-1, 0, 0, -1}, {
+        Matrix4::translation(Vector3::xAxis(1.0f)),
+        Matrix4::translation(Vector3::yAxis(2.0f)),
+        Matrix4::scaling(Vector3{3.0f}),
+        Matrix4::translation(Vector3::zAxis(4.0f))}};
+    CORRADE_COMPARE(h.size(), 5);
+    CORRADE_COMPARE(&h.root(), &existing);
+    CORRADE_COMPARE(h.object(1).parent(), &existing);
+    CORRADE_COMPARE(h.object(2).parent(), &h.object(1));
+    CORRADE_COMPARE(h.object(3).parent(), &h.object(1));
+    CORRADE_COMPARE(h.object(4).parent(), &existing);
+    CORRADE_COMPARE_AS(h.parents(), (std::vector<UnsignedInt>{
+        FlatHierarchy3D::NoParent, 0, 1, 1, 0}), TestSuite::Compare::Container);
+    CORRADE_COMPARE(h.object(2).transformation(), Matrix4::translation(Vector3::yAxis(2.0f)));
+    CORRADE_COMPARE(h.object(4).transformation(), Matrix4::translation(Vector3::zAxis(4.0f)));
+    CORRADE_COMPARE(h.object(2).absoluteTransformation(), Matrix4::translation({1.0f, 2.0f, 0.0f}));
+}
+
+void FlatHierarchyTest::absoluteTransformations() {
+    Scene3D s;
+    Object3D a{&s};
+    a.rotateZ(Deg(30.0f));
+    Object3D aa{&a};
+    aa.scale(Vector3(0.5f));
+    Object3D ab{&a};
+    ab.translate(Vector3::xAxis(5.0f));
+    Object3D b{&s};
+    b.translate(Vector3::yAxis(-1.0f));
+
+    const Matrix4 initial = Matrix4::rotationX(Deg(90.0f)).inverted();
+
+    FlatHierarchy3D h{s};
+    CORRADE_COMPARE_AS(h.absoluteTransformations(initial), (std::vector<Matrix4>{
+        initial,
+        initial*Matrix4::rotationZ(Deg(30.0f)),
+        initial*Matrix4::rotationZ(Deg(30.0f))*Matrix4::scaling(Vector3(0.5f)),
+        initial*Matrix4::rotationZ(Deg(30.0f))*Matrix4::translation(Vector3::xAxis(5.0f)),
+        initial*Matrix4::translation(Vector3::yAxis(-1.0f))
+    }), TestSuite::Compare::Container);
+
+    /* Should give the same result as the pointer-based implementation */
+    CORRADE_COMPARE_AS(h.absoluteTransformationMatrices(initial),
+        s.transformationMatrices({s, a, aa, ab, b}, initial),
+        TestSuite::Compare::Container);
+}
+
+void FlatHierarchyTest::absoluteTransformationsParallel() {
+    Scene3D s;
+
+    /* Subtrees of various sizes so the batches are not uniform. The objects
+       are deleted by the scene. */
+    for(std::size_t i = 0; i != 13; ++i) {
+        Object3D* parent = new Object3D{&s};
+        parent->rotateZ(Deg(i*15.0f));
+        for(std::size_t j = 0; j != i; ++j) {
+            parent = new Object3D{parent};
+            parent->translate(Vector3::xAxis(j*0.5f))
+                .scale(Vector3(1.0f + i*0.1f));
+        }
+    }
+
+    const Matrix4 initial = Matrix4::rotationX(Deg(90.0f)).inverted();
+
+    FlatHierarchy3D h{s};
+    const std::vector<Matrix4> serial = h.absoluteTransformations(initial);
+
+    /* Results should be bit-for-bit equal to the serial version, for any
+       thread count. */
+    for(UnsignedInt threadCount: {1, 2, 3, 7, 16}) {
+        ThreadPool pool{threadCount};
+        const std::vector<Matrix4> parallel = h.absoluteTransformations(initial, pool);
+        CORRADE_COMPARE(parallel.size(), serial.size());
+        CORRADE_VERIFY(std::memcmp(parallel.data(), serial.data(), serial.size()*sizeof(Matrix4)) == 0);
+    }
+}
+
+void FlatHierarchyTest::setTransformation() {
+    Scene3D s;
+    Object3D a{&s};
+    Object3D aa{&a};
+
+    FlatHierarchy3D h{s};
+    h.setTransformation(1, Matrix4::translation(Vector3::xAxis(2.0f)));
+
+    /* Both the object and the stored transformation is updated */
+    CORRADE_COMPARE(a.transformation(), Matrix4::translation(Vector3::xAxis(2.0f)));
+    CORRADE_COMPARE(h.transformations()[1], Matrix4::translation(Vector3::xAxis(2.0f)));
+    CORRADE_COMPARE(h.absoluteTransformations()[2], Matrix4::translation(Vector3::xAxis(2.0f)));
+}
+
+void FlatHierarchyTest::update() {
+    Scene3D s;
+    Object3D a{&s};
+
+    FlatHierarchy3D h{s};
+    a.translate(Vector3::xAxis(2.0f));
+    CORRADE_COMPARE(h.transformations()[1], Matrix4{});
+
+    h.update();
+    CORRADE_COMPARE(h.transformations()[1], Matrix4::translation(Vector3::xAxis(2.0f)));
+}
+
+void FlatHierarchyTest::rebuild() {
+    Scene3D s;
+    Object3D a{&s};
+    Object3D b{&s};
+
+    FlatHierarchy3D h{s};
+    CORRADE_COMPARE(h.size(), 3);
+
+    Object3D c{&s};
+    b.setParent(&a);
+    h.rebuild();
+    CORRADE_COMPARE(h.size(), 4);
+    CORRADE_COMPARE(&h.object(1), &a);
+    CORRADE_COMPARE(&h.object(2), &b);
+    CORRADE_COMPARE(&h.object(3), &c);
+    CORRADE_COMPARE_AS(h.parents(), (std::vector<UnsignedInt>{
+        FlatHierarchy3D::NoParent, 0, 1, 0}), TestSuite::Compare::Container);
+}
+
+void FlatHierarchyTest::setClean() {
+    Scene3D s;
+    CachingObject a{&s};
+    a.translate(Vector3::xAxis(3.0f));
+    CachingObject aa{&a};
+    aa.rotateX(Deg(35.0f));
+    CachingObject b{&s};
+    b.scale(Vector3(2.0f));
+
+    FlatHierarchy3D h{s};
+
+    /* Clean one of them before, it shouldn't be touched */
+    b.setClean();
+    b.cleanedAbsoluteTransformation = {};
+
+    h.setClean();
+    CORRADE_VERIFY(!s.isDirty());
+    CORRADE_VERIFY(!a.isDirty());
+    CORRADE_VERIFY(!aa.isDirty());
+    CORRADE_VERIFY(!b.isDirty());
+    CORRADE_COMPARE(a.cleanedAbsoluteTransformation, a.absoluteTransformationMatrix());
+    CORRADE_COMPARE(aa.cleanedAbsoluteTransformation, aa.absoluteTransformationMatrix());
+    CORRADE_COMPARE(b.cleanedAbsoluteTransformation, Matrix4{});
+
+    /* Changes done through the object API are picked up */
+    a.translate(Vector3::yAxis(1.0f));
+    CORRADE_VERIFY(aa.isDirty());
+    h.setClean();
+    CORRADE_VERIFY(!aa.isDirty());
+    CORRADE_COMPARE(aa.cleanedAbsoluteTransformation,
+        Matrix4::translation({3.0f, 1.0f, 0.0f})*Matrix4::rotationX(Deg(35.0f)));
+}
+
+void FlatHierarchyTest::setCleanSubtree() {
+    Scene3D s;
+    Object3D a{&s};
+    a.translate(Vector3::xAxis(3.0f));
+    CachingObject aa{&a};
+    aa.rotateX(Deg(35.0f));
+
+    /* Transformation of the root parent is taken into account */
+    FlatHierarchy3D h{aa};
+    h.setClean();
+    CORRADE_VERIFY(!aa.isDirty());
+    CORRADE_COMPARE(aa.cleanedAbsoluteTransformation,
+        Matrix4::translation(Vector3::xAxis(3.0f))*Matrix4::rotationX(Deg(35.0f)));
+}
+
+void FlatHierarchyTest::setCleanParallel() {
+    Scene3D s;
+    CachingObject a{&s};
+    a.translate(Vector3::xAxis(3.0f));
+    CachingObject aa{&a};
+    aa.rotateX(Deg(35.0f));
+    CachingObject b{&s};
+    b.scale(Vector3(2.0f));
+
+    ThreadPool pool{4};
+    FlatHierarchy3D h{s};
+    h.setClean(pool);
+    CORRADE_VERIFY(!a.isDirty());
+    CORRADE_VERIFY(!aa.isDirty());
+    CORRADE_VERIFY(!b.isDirty());
+    CORRADE_COMPARE(a.cleanedAbsoluteTransformation, a.absoluteTransformationMatrix());
+    CORRADE_COMPARE(aa.cleanedAbsoluteTransformation, aa.absoluteTransformationMatrix());
+    CORRADE_COMPARE(b.cleanedAbsoluteTransformation, b.absoluteTransformationMatrix());
+}
+
+void FlatHierarchyTest::snapshotRestore() {
+    Scene3D s;
+    Object3D a{&s};
+    a.translate(Vector3::xAxis(1.0f));
+    Object3D aa{&a};
+    aa.scale(Vector3(0.5f));
+    Object3D b{&s};
+    b.rotateY(Deg(30.0f));
+
+    FlatHierarchy3D h{s};
+    const Containers::Array<char> data = h.snapshot();
+
+    a.translate(Vector3::yAxis(5.0f));
+    aa.resetTransformation();
+    b.rotateY(Deg(15.0f));
+    h.update();
+
+    CORRADE_VERIFY(h.restore(data));
+    CORRADE_COMPARE(a.transformation(), Matrix4::translation(Vector3::xAxis(1.0f)));
+    CORRADE_COMPARE(aa.transformation(), Matrix4::scaling(Vector3(0.5f)));
+    CORRADE_COMPARE(b.transformation(), Matrix4::rotationY(Deg(30.0f)));
+    CORRADE_COMPARE(h.transformations()[3], Matrix4::rotationY(Deg(30.0f)));
+}
+
+void FlatHierarchyTest::snapshotRestoreFeatureData() {
+    Scene3D s;
+    ValueObject a{&s, 3};
+    ValueObject aa{&a, -17};
+    ValueObject b{&s, 42};
+
+    FlatHierarchy3D h{s};
+    const Containers::Array<char> data = h.snapshot([](const Object3D& object, std::string& out) {
+        /* No data for the scene */
+        if(object.isScene()) return;
+        out.append(reinterpret_cast<const char*>(&static_cast<const ValueObject&>(object).value), sizeof(Int));
+    });
+
+    a.value = aa.value = b.value = 0;
+
+    std::size_t called = 0;
+    CORRADE_VERIFY(h.restore(data, [&called](Object3D& object, Containers::ArrayView<const char> featureData) {
+        ++called;
+        if(object.isScene()) return featureData.empty();
+        if(featureData.size() != sizeof(Int)) return false;
+        std::memcpy(&static_cast<ValueObject&>(object).value, featureData.data(), sizeof(Int));
+        return true;
+    }));
+    CORRADE_COMPARE(called, 4);
+    CORRADE_COMPARE(a.value, 3);
+    CORRADE_COMPARE(aa.value, -17);
+    CORRADE_COMPARE(b.value, 42);
+
+    /* Failing loader aborts the restore */
+    std::ostringstream out;
+    Error redirectError{&out};
+    called = 0;
+    CORRADE_VERIFY(!h.restore(data, [&called](Object3D&, Containers::ArrayView<const char>) {
+        ++called;
+        return false;
+    }));
+    CORRADE_COMPARE(called, 1);
+}
+
+void FlatHierarchyTest::snapshotRestoreMismatch() {
+    Scene3D s;
+    Object3D a{&s};
+    Object3D b{&s};
+
+    FlatHierarchy3D h{s};
+    const Containers::Array<char> data = h.snapshot();
+
+    /* Same object count, different structure */
+    b.setParent(&a);
+    h.rebuild();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!h.restore(data));
+    CORRADE_COMPARE(out.str(), "SceneGraph::FlatHierarchy::restore(): snapshot of 3 objects doesn't match hierarchy of 3 objects\n");
+}
+
+void FlatHierarchyTest::snapshotInvalid() {
+    Scene3D s;
+    Object3D a{&s};
+    FlatHierarchy3D h{s};
+    Containers::Array<char> data = h.snapshot();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!h.restore(data.prefix(15)));
+    CORRADE_VERIFY(!h.restore(data.prefix(data.size() - 1)));
+    CORRADE_VERIFY(!FlatHierarchy3D::fromSnapshot(s, data.prefix(data.size() - 1)));
+
+    /* Different transformation type */
+    {
+        SceneGraph::Scene<SceneGraph::DualQuaternionTransformation> s2;
+        SceneGraph::FlatHierarchy<SceneGraph::DualQuaternionTransformation> h2{s2};
+        CORRADE_VERIFY(!h2.restore(data));
+    }
+
+    /* Parent stored after the child */
+    UnsignedInt parent = 1;
+    std::memcpy(data.data() + 20, &parent, 4);
+    CORRADE_VERIFY(!h.restore(data));
+
+    data[0] = 'X';
+    CORRADE_VERIFY(!h.restore(data));
+
+    CORRADE_COMPARE(out.str(),
+        "SceneGraph::FlatHierarchy::restore(): snapshot too short, got 15 bytes\n"
+        "SceneGraph::FlatHierarchy::restore(): expected 164 bytes for 2 objects but got 163\n"
+        "SceneGraph::FlatHierarchy::fromSnapshot(): expected 164 bytes for 2 objects but got 163\n"
+        "SceneGraph::FlatHierarchy::restore(): expected a snapshot of 3 dimensions and 32 bytes per transformation but got 3 and 64\n"
+        "SceneGraph::FlatHierarchy::restore(): invalid parent or feature data of object 1\n"
+        "SceneGraph::FlatHierarchy::restore(): invalid snapshot signature\n");
+
+    /* Nothing was created */
+    CORRADE_COMPARE(s.children().last(), &a);
+}
+
+void FlatHierarchyTest::fromSnapshot() {
+    Containers::Array<char> data;
+    {
+        Scene3D s;
+        Object3D a{&s};
+        a.translate(Vector3::xAxis(1.0f));
+        Object3D aa{&a};
+        aa.scale(Vector3(0.5f));
+        Object3D b{&s};
+        b.rotateY(Deg(30.0f));
+
+        data = FlatHierarchy3D{s}.snapshot();
+    }
+
+    Scene3D s;
+    std::size_t called = 0;
+    Containers::Optional<FlatHierarchy3D> h = FlatHierarchy3D::fromSnapshot(s, data, [&called](Object3D&, Containers::ArrayView<const char>) {
+        ++called;
+        return true;
+    });
+    CORRADE_VERIFY(h);
+    CORRADE_COMPARE(called, 4);
+    CORRADE_COMPARE(h->size(), 4);
+    CORRADE_COMPARE(&h->root(), &s);
+    CORRADE_COMPARE_AS(h->parents(), (std::vector<UnsignedInt>{
+        FlatHierarchy3D::NoParent, 0, 1, 0}), TestSuite::Compare::Container);
+    CORRADE_COMPARE(h->object(1).transformation(), Matrix4::translation(Vector3::xAxis(1.0f)));
+    CORRADE_COMPARE(h->object(2).absoluteTransformation(), Matrix4::translation(Vector3::xAxis(1.0f))*Matrix4::scaling(Vector3(0.5f)));
+    CORRADE_COMPARE(h->object(3).transformation(), Matrix4::rotationY(Deg(30.0f)));
+}
+
+void FlatHierarchyTest::fromSnapshotFactory() {
+    Containers::Array<char> data;
+    {
+        Scene3D s;
+        ValueObject a{&s, 3};
+        ValueObject aa{&a, -17};
+
+        data = FlatHierarchy3D{s}.snapshot([](const Object3D& object, std::string& out) {
+            if(object.isScene()) return;
+            out.append(reinterpret_cast<const char*>(&static_cast<const ValueObject&>(object).value), sizeof(Int));
+        });
+    }
+
+    Scene3D s;
+    Containers::Optional<FlatHierarchy3D> h = FlatHierarchy3D::fromSnapshot(s, data, [](Object3D& object, Containers::ArrayView<const char> featureData) {
+        if(object.isScene()) return true;
+        std::memcpy(&static_cast<ValueObject&>(object).value, featureData.data(), sizeof(Int));
+        return true;
+    }, [](Object3D& parent) -> Object3D* {
+        return new ValueObject{&parent};
+    });
+    CORRADE_VERIFY(h);
+    CORRADE_COMPARE(h->size(), 3);
+    CORRADE_COMPARE(static_cast<ValueObject&>(h->object(1)).value, 3);
+    CORRADE_COMPARE(static_cast<ValueObject&>(h->object(2)).value, -17);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::FlatHierarchyTest)
@@ -0,0 +1,192 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/SceneGraph/Camera.h"
+#include "Magnum/SceneGraph/InstancedDrawable.h"
+#include "Magnum/SceneGraph/InstancedDrawableGroup.h"
+#include "Magnum/SceneGraph/MatrixTransformation2D.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+struct InstancedDrawableTest: TestSuite::Tester {
+    explicit InstancedDrawableTest();
+
+    void construct();
+    void boundingBox();
+
+    void updateInstanceData2D();
+    void updateInstanceData3D();
+    void updateInstanceDataCulled();
+    void updateInstanceDataRepeated();
+};
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation2D> Object2D;
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation2D> Scene2D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+InstancedDrawableTest::InstancedDrawableTest() {
+    addTests({&InstancedDrawableTest::construct,
+              &InstancedDrawableTest::boundingBox,
+
+              &InstancedDrawableTest::updateInstanceData2D,
+              &InstancedDrawableTest::updateInstanceData3D,
+              &InstancedDrawableTest::updateInstanceDataCulled,
+              &InstancedDrawableTest::updateInstanceDataRepeated});
+}
+
+void InstancedDrawableTest::construct() {
+    Object3D object;
+    InstancedDrawableGroup3D group;
+    InstancedDrawable3D instance{object, &group};
+    CORRADE_VERIFY(instance.instances() == &group);
+    CORRADE_COMPARE(instance.color(), Color4{1.0f});
+    CORRADE_COMPARE(group.size(), 1);
+    CORRADE_VERIFY(group.instanceData().empty());
+
+    instance.setColor(Color4::red());
+    CORRADE_COMPARE(instance.color(), Color4::red());
+}
+
+void InstancedDrawableTest::boundingBox() {
+    InstancedDrawableGroup3D group;
+    CORRADE_VERIFY(!group.hasBoundingBox());
+
+    const Range3D box{Vector3{-1.0f}, Vector3{1.0f}};
+    group.setBoundingBox(box);
+    CORRADE_VERIFY(group.hasBoundingBox());
+    CORRADE_COMPARE(group.boundingBox(), box);
+
+    group.resetBoundingBox();
+    CORRADE_VERIFY(!group.hasBoundingBox());
+    CORRADE_COMPARE(group.boundingBox(), Range3D{});
+}
+
+void InstancedDrawableTest::updateInstanceData2D() {
+    Scene2D scene;
+    Object2D cameraObject{&scene};
+    cameraObject.translate({1.0f, 0.0f});
+    Camera2D camera{cameraObject};
+
+    InstancedDrawableGroup2D group;
+    Object2D a{&scene};
+    a.translate({3.0f, 2.0f});
+    (new InstancedDrawable2D{a, &group})->setColor(Color4::green());
+    Object2D b{&a};
+    b.translate({-1.0f, 0.0f});
+    (new InstancedDrawable2D{b, &group})->setColor(Color4::blue());
+
+    CORRADE_COMPARE(group.updateInstanceData(camera), 2);
+    CORRADE_COMPARE(group.instanceData().size(), 2);
+    CORRADE_COMPARE(group.instanceData()[0].transformationMatrix, Matrix3::translation({2.0f, 2.0f}));
+    CORRADE_COMPARE(group.instanceData()[0].color, Color4::green());
+    CORRADE_COMPARE(group.instanceData()[1].transformationMatrix, Matrix3::translation({1.0f, 2.0f}));
+    CORRADE_COMPARE(group.instanceData()[1].color, Color4::blue());
+}
+
+void InstancedDrawableTest::updateInstanceData3D() {
+    Scene3D scene;
+    Object3D cameraObject{&scene};
+    cameraObject.translate({0.0f, 0.0f, 5.0f});
+    Camera3D camera{cameraObject};
+
+    InstancedDrawableGroup3D group;
+    Object3D a{&scene};
+    a.rotateY(Deg(90.0f));
+    (new InstancedDrawable3D{a, &group})->setColor(Color4::red());
+    Object3D b{&scene};
+    b.translate({1.0f, 2.0f, 3.0f});
+    new InstancedDrawable3D{b, &group};
+
+    CORRADE_COMPARE(group.updateInstanceData(camera), 2);
+    CORRADE_COMPARE(group.instanceData()[0].transformationMatrix, Matrix4::translation({0.0f, 0.0f, -5.0f})*Matrix4::rotationY(Deg(90.0f)));
+    CORRADE_COMPARE(group.instanceData()[0].color, Color4::red());
+    CORRADE_COMPARE(group.instanceData()[1].transformationMatrix, Matrix4::translation({1.0f, 2.0f, -2.0f}));
+    CORRADE_COMPARE(group.instanceData()[1].color, Color4{1.0f});
+}
+
+void InstancedDrawableTest::updateInstanceDataCulled() {
+    Scene3D scene;
+
+    /* Looking along -Z, for Z = -5 the visible area is [-5, 5] in X and Y */
+    Object3D cameraObject{&scene};
+    Camera3D camera{cameraObject};
+    camera.setProjectionMatrix(Matrix4::perspectiveProjection(Deg(90.0f), 1.0f, 0.1f, 100.0f));
+
+    InstancedDrawableGroup3D group;
+    group.setBoundingBox({Vector3{-1.0f}, Vector3{1.0f}});
+
+    Object3D inside{&scene};
+    inside.translate({0.0f, 0.0f, -5.0f});
+    (new InstancedDrawable3D{inside, &group})->setColor(Color4::red());
+
+    Object3D behind{&scene};
+    behind.translate({0.0f, 0.0f, 5.0f});
+    new InstancedDrawable3D{behind, &group};
+
+    Object3D partial{&scene};
+    partial.translate({5.5f, 0.0f, -5.0f});
+    (new InstancedDrawable3D{partial, &group})->setColor(Color4::green());
+
+    Object3D aside{&scene};
+    aside.translate({50.0f, 0.0f, -5.0f});
+    new InstancedDrawable3D{aside, &group};
+
+    CORRADE_COMPARE(group.updateInstanceData(camera), 2);
+    CORRADE_COMPARE(group.instanceData()[0].color, Color4::red());
+    CORRADE_COMPARE(group.instanceData()[1].color, Color4::green());
+    CORRADE_COMPARE(group.instanceData()[1].transformationMatrix, Matrix4::translation({5.5f, 0.0f, -5.0f}));
+
+    /* Without the bounding box everything is submitted */
+    group.resetBoundingBox();
+    CORRADE_COMPARE(group.updateInstanceData(camera), 4);
+}
+
+void InstancedDrawableTest::updateInstanceDataRepeated() {
+    Scene3D scene;
+    Object3D cameraObject{&scene};
+    Camera3D camera{cameraObject};
+
+    InstancedDrawableGroup3D group;
+    Object3D a{&scene};
+    new InstancedDrawable3D{a, &group};
+    CORRADE_COMPARE(group.updateInstanceData(camera), 1);
+
+    /* Added instances and changed transformations are picked up */
+    Object3D b{&scene};
+    new InstancedDrawable3D{b, &group};
+    a.translate({1.0f, 0.0f, 0.0f});
+    CORRADE_COMPARE(group.updateInstanceData(camera), 2);
+    CORRADE_COMPARE(group.instanceData()[0].transformationMatrix, Matrix4::translation({1.0f, 0.0f, 0.0f}));
+    CORRADE_COMPARE(group.instanceData()[1].transformationMatrix, Matrix4{});
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::InstancedDrawableTest)
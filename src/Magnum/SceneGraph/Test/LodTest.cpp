@@ -0,0 +1,342 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <memory>
+#include <sstream>
+#include <vector>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Constants.h"
+#include "Magnum/SceneGraph/Camera.h"
+#include "Magnum/SceneGraph/DerivedTransformation.h"
+#include "Magnum/SceneGraph/Lod.h"
+#include "Magnum/SceneGraph/LodGroup.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+struct LodTest: TestSuite::Tester {
+    explicit LodTest();
+
+    void construct();
+    void constructDifferentObject();
+    void constructInvalidThresholds();
+
+    void selectPerspective();
+    void selectOrthographic();
+    void selectInside();
+    void selectTransformed();
+    void hysteresis();
+    void hysteresisInvalid();
+    void reset();
+    void selectParallel();
+};
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+LodTest::LodTest() {
+    addTests({&LodTest::construct,
+              &LodTest::constructDifferentObject,
+              &LodTest::constructInvalidThresholds,
+
+              &LodTest::selectPerspective,
+              &LodTest::selectOrthographic,
+              &LodTest::selectInside,
+              &LodTest::selectTransformed,
+              &LodTest::hysteresis,
+              &LodTest::hysteresisInvalid,
+              &LodTest::reset,
+              &LodTest::selectParallel});
+}
+
+namespace {
+    struct LodObject: Object3D {
+        explicit LodObject(Object3D* parent, LodGroup3D* group, std::vector<Float> thresholds = {0.25f, 0.1f, 0.04f}): Object3D{parent}, derived{*this}, lod{*this, derived, std::move(thresholds), group} {
+            derived.setBoundingSphere({}, 1.0f);
+        }
+
+        DerivedTransformation3D derived;
+        Lod3D lod;
+    };
+
+    /* 90° field of view, so the sphere size is just 1/distance */
+    Matrix4 perspective() {
+        return Matrix4::perspectiveProjection(Deg(90.0f), 1.0f, 0.01f, 1000.0f);
+    }
+}
+
+void LodTest::construct() {
+    Scene3D scene;
+    LodGroup3D group;
+    LodObject object{&scene, &group};
+
+    CORRADE_COMPARE(object.lod.lods(), &group);
+    CORRADE_COMPARE(&object.lod.derivedTransformation(), &object.derived);
+    CORRADE_COMPARE(object.lod.levelCount(), 4);
+    CORRADE_COMPARE(object.lod.thresholds().size(), 3);
+    CORRADE_COMPARE(object.lod.thresholds()[1], 0.1f);
+    CORRADE_COMPARE(object.lod.level(), 0);
+    CORRADE_COMPARE(object.lod.screenSize(), 0.0f);
+    CORRADE_COMPARE(group.size(), 1);
+    CORRADE_COMPARE(group.hysteresis(), 0.1f);
+}
+
+void LodTest::constructDifferentObject() {
+    Scene3D scene;
+    Object3D a{&scene}, b{&scene};
+    DerivedTransformation3D derived{a};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Lod3D lod{b, derived, {0.5f}};
+    CORRADE_COMPARE(out.str(), "SceneGraph::Lod: the derived transformation is not attached to the same object\n");
+}
+
+void LodTest::constructInvalidThresholds() {
+    Scene3D scene;
+    Object3D object{&scene};
+    DerivedTransformation3D derived{object};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Lod3D a{object, derived, {0.5f, 0.5f}};
+    Lod3D b{object, derived, {-0.5f}};
+    CORRADE_COMPARE(out.str(),
+        "SceneGraph::Lod: expected positive decreasing thresholds but got 0.5 at position 1\n"
+        "SceneGraph::Lod: expected positive decreasing thresholds but got -0.5 at position 0\n");
+}
+
+void LodTest::selectPerspective() {
+    Scene3D scene;
+    Object3D cameraObject{&scene};
+    Camera3D camera{cameraObject};
+    camera.setProjectionMatrix(perspective());
+
+    LodGroup3D group;
+    LodObject a{&scene, &group}, b{&scene, &group}, c{&scene, &group}, d{&scene, &group};
+    a.translate(Vector3::zAxis(-2.0f));
+    b.translate(Vector3::zAxis(-5.0f));
+    c.translate(Vector3::zAxis(-20.0f));
+    d.translate(Vector3::zAxis(-50.0f));
+
+    group.select(camera);
+    CORRADE_COMPARE(a.lod.screenSize(), 0.5f);
+    CORRADE_COMPARE(b.lod.screenSize(), 0.2f);
+    CORRADE_COMPARE(c.lod.screenSize(), 0.05f);
+    CORRADE_COMPARE(d.lod.screenSize(), 0.02f);
+    CORRADE_COMPARE(a.lod.level(), 0);
+    CORRADE_COMPARE(b.lod.level(), 1);
+    CORRADE_COMPARE(c.lod.level(), 2);
+    CORRADE_COMPARE(d.lod.level(), 3);
+
+    /* The objects got cleaned */
+    CORRADE_VERIFY(!a.isDirty());
+    CORRADE_VERIFY(!d.isDirty());
+}
+
+void LodTest::selectOrthographic() {
+    Scene3D scene;
+    Object3D cameraObject{&scene};
+    Camera3D camera{cameraObject};
+    camera.setProjectionMatrix(Matrix4::orthographicProjection({10.0f, 10.0f}, 0.01f, 1000.0f));
+
+    /* The size doesn't depend on distance */
+    LodGroup3D group;
+    LodObject a{&scene, &group}, b{&scene, &group};
+    a.translate(Vector3::zAxis(-2.0f));
+    b.translate(Vector3::zAxis(-500.0f));
+
+    group.select(camera);
+    CORRADE_COMPARE(a.lod.screenSize(), 0.2f);
+    CORRADE_COMPARE(b.lod.screenSize(), 0.2f);
+    CORRADE_COMPARE(a.lod.level(), 1);
+    CORRADE_COMPARE(b.lod.level(), 1);
+}
+
+void LodTest::selectInside() {
+    Scene3D scene;
+    Object3D cameraObject{&scene};
+    Camera3D camera{cameraObject};
+    camera.setProjectionMatrix(perspective());
+
+    /* Camera inside the sphere and a sphere behind the camera, both get the
+       most detailed level */
+    LodGroup3D group;
+    LodObject a{&scene, &group}, b{&scene, &group};
+    a.translate(Vector3::zAxis(-0.5f));
+    b.translate(Vector3::zAxis(30.0f));
+
+    group.select(camera);
+    CORRADE_COMPARE(a.lod.screenSize(), Constants::inf());
+    CORRADE_COMPARE(b.lod.screenSize(), Constants::inf());
+    CORRADE_COMPARE(a.lod.level(), 0);
+    CORRADE_COMPARE(b.lod.level(), 0);
+}
+
+void LodTest::selectTransformed() {
+    Scene3D scene;
+    Object3D cameraObject{&scene};
+    cameraObject.rotateY(Deg(90.0f))
+        .translate({10.0f, 0.0f, 0.0f});
+    Camera3D camera{cameraObject};
+    camera.setProjectionMatrix(perspective());
+
+    /* Camera looks along -X from X = 10, the object is scaled 2x, so it's
+       like a unit sphere at distance 5 */
+    LodGroup3D group;
+    Object3D parent{&scene};
+    parent.scale(Vector3{2.0f});
+    LodObject a{&parent, &group};
+
+    group.select(camera);
+    CORRADE_COMPARE(a.lod.screenSize(), 0.2f);
+    CORRADE_COMPARE(a.lod.level(), 1);
+}
+
+void LodTest::hysteresis() {
+    Scene3D scene;
+    Object3D cameraObject{&scene};
+    Camera3D camera{cameraObject};
+    camera.setProjectionMatrix(perspective());
+
+    LodGroup3D group;
+    group.setHysteresis(0.2f);
+    CORRADE_COMPARE(group.hysteresis(), 0.2f);
+    LodObject a{&scene, &group, {0.25f}};
+
+    /* Size 0.5 */
+    a.translate(Vector3::zAxis(-2.0f));
+    group.select(camera);
+    CORRADE_COMPARE(a.lod.level(), 0);
+
+    /* Size 0.222, under the threshold but not enough */
+    a.resetTransformation().translate(Vector3::zAxis(-4.5f));
+    group.select(camera);
+    CORRADE_COMPARE(a.lod.level(), 0);
+
+    /* Size 0.181, enough under */
+    a.resetTransformation().translate(Vector3::zAxis(-5.5f));
+    group.select(camera);
+    CORRADE_COMPARE(a.lod.level(), 1);
+
+    /* Size 0.286, over the threshold but not enough */
+    a.resetTransformation().translate(Vector3::zAxis(-3.5f));
+    group.select(camera);
+    CORRADE_COMPARE(a.lod.level(), 1);
+
+    /* Size 0.333, enough over */
+    a.resetTransformation().translate(Vector3::zAxis(-3.0f));
+    group.select(camera);
+    CORRADE_COMPARE(a.lod.level(), 0);
+
+    /* Jumping over multiple levels works as well */
+    LodObject b{&scene, &group, {0.25f, 0.1f, 0.04f}};
+    b.translate(Vector3::zAxis(-2.0f));
+    group.select(camera);
+    CORRADE_COMPARE(b.lod.level(), 0);
+    b.resetTransformation().translate(Vector3::zAxis(-100.0f));
+    group.select(camera);
+    CORRADE_COMPARE(b.lod.level(), 3);
+    b.resetTransformation().translate(Vector3::zAxis(-2.0f));
+    group.select(camera);
+    CORRADE_COMPARE(b.lod.level(), 0);
+}
+
+void LodTest::hysteresisInvalid() {
+    LodGroup3D group;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    group.setHysteresis(1.0f);
+    group.setHysteresis(-0.1f);
+    CORRADE_COMPARE(out.str(),
+        "SceneGraph::LodGroup::setHysteresis(): expected a value in range [0, 1) but got 1\n"
+        "SceneGraph::LodGroup::setHysteresis(): expected a value in range [0, 1) but got -0.1\n");
+}
+
+void LodTest::reset() {
+    Scene3D scene;
+    Object3D cameraObject{&scene};
+    Camera3D camera{cameraObject};
+    camera.setProjectionMatrix(perspective());
+
+    LodGroup3D group;
+    group.setHysteresis(0.2f);
+    LodObject a{&scene, &group, {0.25f}};
+    a.translate(Vector3::zAxis(-2.0f));
+    group.select(camera);
+    CORRADE_COMPARE(a.lod.level(), 0);
+
+    /* Size 0.222 stays on level 0 because of the hysteresis, but not after
+       reset */
+    a.resetTransformation().translate(Vector3::zAxis(-4.5f));
+    group.select(camera);
+    CORRADE_COMPARE(a.lod.level(), 0);
+    group.reset();
+    group.select(camera);
+    CORRADE_COMPARE(a.lod.level(), 1);
+}
+
+void LodTest::selectParallel() {
+    Scene3D scene;
+    Object3D cameraObject{&scene};
+    Camera3D camera{cameraObject};
+    camera.setProjectionMatrix(perspective());
+
+    LodGroup3D serial, parallel;
+    std::vector<std::unique_ptr<LodObject>> serialObjects, parallelObjects;
+    for(std::size_t i = 0; i != 1000; ++i) {
+        serialObjects.emplace_back(new LodObject{&scene, &serial});
+        parallelObjects.emplace_back(new LodObject{&scene, &parallel});
+        serialObjects.back()->translate(Vector3::zAxis(-1.5f - i*0.05f));
+        parallelObjects.back()->translate(Vector3::zAxis(-1.5f - i*0.05f));
+    }
+
+    ThreadPool pool{4};
+    serial.select(camera);
+    parallel.select(camera, pool);
+    for(std::size_t i = 0; i != serialObjects.size(); ++i)
+        CORRADE_COMPARE(parallelObjects[i]->lod.level(), serialObjects[i]->lod.level());
+
+    /* All levels were used */
+    CORRADE_COMPARE(parallelObjects.front()->lod.level(), 0);
+    CORRADE_COMPARE(parallelObjects.back()->lod.level(), 3);
+
+    /* Statically scheduled with hysteresis gives the same result as well */
+    for(std::size_t i = 0; i != serialObjects.size(); ++i) {
+        serialObjects[i]->translate(Vector3::zAxis(-2.0f));
+        parallelObjects[i]->translate(Vector3::zAxis(-2.0f));
+    }
+    serial.select(camera);
+    parallel.select(camera, pool, ThreadPool::Schedule::Static);
+    for(std::size_t i = 0; i != serialObjects.size(); ++i)
+        CORRADE_COMPARE(parallelObjects[i]->lod.level(), serialObjects[i]->lod.level());
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::LodTest)
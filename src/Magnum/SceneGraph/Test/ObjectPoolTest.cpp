@@ -0,0 +1,211 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/ObjectPool.h"
+#include "Magnum/SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+struct ObjectPoolTest: TestSuite::Tester {
+    explicit ObjectPoolTest();
+
+    void construct();
+    void allocate();
+    void reserve();
+    void shrink();
+
+    void poolAllocatedObject();
+    void poolAllocatedFeature();
+    void poolAllocatedSubclass();
+};
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+ObjectPoolTest::ObjectPoolTest() {
+    addTests({&ObjectPoolTest::construct,
+              &ObjectPoolTest::allocate,
+              &ObjectPoolTest::reserve,
+              &ObjectPoolTest::shrink,
+
+              &ObjectPoolTest::poolAllocatedObject,
+              &ObjectPoolTest::poolAllocatedFeature,
+              &ObjectPoolTest::poolAllocatedSubclass});
+}
+
+void ObjectPoolTest::construct() {
+    ObjectPool pool{3};
+
+    /* Rounded up to alignment of fundamental types */
+    CORRADE_VERIFY(pool.blockSize() >= sizeof(void*));
+    CORRADE_COMPARE(pool.blockSize() % alignof(long double), 0);
+    CORRADE_COMPARE(pool.size(), 0);
+    CORRADE_COMPARE(pool.capacity(), 0);
+}
+
+void ObjectPoolTest::allocate() {
+    ObjectPool pool{32, 2};
+
+    void* a = pool.allocate();
+    void* b = pool.allocate();
+    CORRADE_COMPARE(pool.size(), 2);
+    CORRADE_COMPARE(pool.capacity(), 2);
+
+    /* Blocks from the same chunk are in memory order */
+    CORRADE_COMPARE(static_cast<char*>(b) - static_cast<char*>(a), 32);
+
+    /* Next allocation needs a new chunk */
+    void* c = pool.allocate();
+    CORRADE_COMPARE(pool.size(), 3);
+    CORRADE_COMPARE(pool.capacity(), 4);
+
+    /* Freed block is reused */
+    pool.deallocate(b);
+    CORRADE_COMPARE(pool.size(), 2);
+    CORRADE_COMPARE(pool.allocate(), b);
+
+    pool.deallocate(a);
+    pool.deallocate(b);
+    pool.deallocate(c);
+    CORRADE_COMPARE(pool.size(), 0);
+    CORRADE_COMPARE(pool.capacity(), 4);
+}
+
+void ObjectPoolTest::reserve() {
+    ObjectPool pool{16, 4};
+
+    pool.reserve(100);
+    CORRADE_COMPARE(pool.capacity(), 100);
+
+    /* Reserving less does nothing */
+    pool.reserve(50);
+    CORRADE_COMPARE(pool.capacity(), 100);
+
+    void* blocks[100];
+    for(void*& block: blocks) block = pool.allocate();
+    CORRADE_COMPARE(pool.size(), 100);
+    CORRADE_COMPARE(pool.capacity(), 100);
+
+    for(void* block: blocks) pool.deallocate(block);
+}
+
+void ObjectPoolTest::shrink() {
+    ObjectPool pool{16, 4};
+
+    void* a = pool.allocate();
+    CORRADE_COMPARE(pool.capacity(), 4);
+
+    /* Not releasing anything while there are allocated blocks */
+    pool.shrink();
+    CORRADE_COMPARE(pool.capacity(), 4);
+
+    pool.deallocate(a);
+    pool.shrink();
+    CORRADE_COMPARE(pool.capacity(), 0);
+
+    /* Can allocate again */
+    pool.deallocate(pool.allocate());
+    CORRADE_COMPARE(pool.capacity(), 4);
+}
+
+class PooledObject: public Object3D, public PoolAllocated<PooledObject> {
+    public:
+        explicit PooledObject(Object3D* parent = nullptr): Object3D{parent} {}
+};
+
+void ObjectPoolTest::poolAllocatedObject() {
+    ObjectPool& pool = PoolAllocated<PooledObject>::pool();
+    CORRADE_COMPARE(pool.size(), 0);
+    pool.reserve(101);
+
+    Scene3D scene;
+    PooledObject* chunk = new PooledObject{&scene};
+    for(std::size_t i = 0; i != 100; ++i)
+        new PooledObject{chunk};
+    CORRADE_COMPARE(pool.size(), 101);
+    CORRADE_COMPARE(pool.capacity(), 101);
+    std::size_t childCount = 0;
+    for(Object3D* child = chunk->children().first(); child; child = child->nextSibling())
+        ++childCount;
+    CORRADE_COMPARE(childCount, 100);
+
+    /* Deleting the subtree root puts everything back to the pool */
+    delete chunk;
+    CORRADE_COMPARE(pool.size(), 0);
+    CORRADE_VERIFY(scene.children().isEmpty());
+
+    /* Objects created through addChild() go to the pool too */
+    PooledObject& child = scene.addChild<PooledObject>();
+    CORRADE_COMPARE(pool.size(), 1);
+    CORRADE_COMPARE(child.parent(), &scene);
+
+    /* Objects owned by the scene get deleted with it */
+    scene.children().clear();
+    CORRADE_COMPARE(pool.size(), 0);
+}
+
+class PooledFeature: public AbstractFeature3D, public PoolAllocated<PooledFeature> {
+    public:
+        explicit PooledFeature(AbstractObject3D& object): AbstractFeature3D{object} {}
+};
+
+void ObjectPoolTest::poolAllocatedFeature() {
+    ObjectPool& pool = PoolAllocated<PooledFeature>::pool();
+
+    {
+        Object3D object;
+        new PooledFeature{object};
+        new PooledFeature{object};
+        CORRADE_COMPARE(pool.size(), 2);
+    }
+
+    /* Features are deleted together with the object */
+    CORRADE_COMPARE(pool.size(), 0);
+}
+
+class LargerPooledObject: public PooledObject {
+    public:
+        explicit LargerPooledObject(Object3D* parent = nullptr): PooledObject{parent} {}
+
+        char data[256];
+};
+
+void ObjectPoolTest::poolAllocatedSubclass() {
+    ObjectPool& pool = PoolAllocated<PooledObject>::pool();
+    CORRADE_COMPARE(pool.size(), 0);
+
+    /* Subclasses that don't fit into the block go to the heap */
+    Object3D* object = new LargerPooledObject;
+    CORRADE_COMPARE(pool.size(), 0);
+    delete object;
+    CORRADE_COMPARE(pool.size(), 0);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::ObjectPoolTest)
@@ -23,9 +23,11 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <cstring>
 #include <sstream>
 #include <Corrade/TestSuite/Tester.h>
 
+#include "Magnum/ThreadPool.h"
 #include "Magnum/SceneGraph/MatrixTransformation3D.h"
 #include "Magnum/SceneGraph/Scene.h"
 
@@ -45,9 +47,13 @@ struct ObjectTest: TestSuite::Tester {
     void transformationsRelative();
     void transformationsOrphan();
     void transformationsDuplicate();
+    void transformationsInto();
+    void transformationsIntoWrongSize();
+    void transformationsParallel();
     void setClean();
     void setCleanListHierarchy();
     void setCleanListBulk();
+    void setCleanListParallel();
 
     void rangeBasedForChildren();
     void rangeBasedForFeatures();
@@ -82,9 +88,13 @@ ObjectTest::ObjectTest() {
               &ObjectTest::transformationsRelative,
               &ObjectTest::transformationsOrphan,
               &ObjectTest::transformationsDuplicate,
+              &ObjectTest::transformationsInto,
+              &ObjectTest::transformationsIntoWrongSize,
+              &ObjectTest::transformationsParallel,
               &ObjectTest::setClean,
               &ObjectTest::setCleanListHierarchy,
               &ObjectTest::setCleanListBulk,
+              &ObjectTest::setCleanListParallel,
 
               &ObjectTest::rangeBasedForChildren,
               &ObjectTest::rangeBasedForFeatures});
@@ -304,6 +314,101 @@ void ObjectTest::transformationsDuplicate() {
     }));
 }
 
+void ObjectTest::transformationsInto() {
+    Scene3D s;
+    Object3D first(&s);
+    first.rotateZ(Deg(30.0f));
+    Object3D second(&first);
+    second.scale(Vector3(0.5f));
+    Object3D third(&first);
+    third.translate(Vector3::xAxis(5.0f));
+
+    Matrix4 initial = Matrix4::rotationX(Deg(90.0f)).inverted();
+    Matrix4 firstExpected = initial*Matrix4::rotationZ(Deg(30.0f));
+    Matrix4 secondExpected = initial*Matrix4::rotationZ(Deg(30.0f))*Matrix4::scaling(Vector3(0.5f));
+    Matrix4 thirdExpected = initial*Matrix4::rotationZ(Deg(30.0f))*Matrix4::translation(Vector3::xAxis(5.0f));
+
+    Matrix4 out[4];
+    s.transformations({second, third, second, first}, out, initial);
+    CORRADE_COMPARE(out[0], secondExpected);
+    CORRADE_COMPARE(out[1], thirdExpected);
+    CORRADE_COMPARE(out[2], secondExpected);
+    CORRADE_COMPARE(out[3], firstExpected);
+
+    /* Calling again with less objects reuses the scratch memory, the result
+       should be still correct */
+    Matrix4 outMatrices[2];
+    s.transformationMatrices({third, first}, outMatrices, initial);
+    CORRADE_COMPARE(outMatrices[0], thirdExpected);
+    CORRADE_COMPARE(outMatrices[1], firstExpected);
+
+    /* Type-erased variant */
+    Matrix4 outAbstract[1];
+    static_cast<AbstractObject3D&>(s).transformationMatrices({second}, outAbstract, initial);
+    CORRADE_COMPARE(outAbstract[0], secondExpected);
+}
+
+void ObjectTest::transformationsIntoWrongSize() {
+    std::ostringstream o;
+    Error redirectError{&o};
+
+    Scene3D s;
+    Object3D first(&s);
+
+    Matrix4 out[2];
+    s.transformations({first}, out);
+    s.transformationMatrices({first}, out);
+    CORRADE_COMPARE(o.str(),
+        "SceneGraph::Object::transformations(): expected output view of size 1 but got 2\n"
+        "SceneGraph::Object::transformationMatrices(): expected output view of size 1 but got 2\n");
+}
+
+void ObjectTest::transformationsParallel() {
+    Scene3D s;
+
+    /* Deep and wide hierarchy with branching at various levels, so there are
+       both long paths and many joints. The objects are deleted by the
+       scene. */
+    std::vector<std::reference_wrapper<Object3D>> objects;
+    std::vector<Object3D*> all{&s};
+    for(std::size_t i = 0; i != 3000; ++i) {
+        Object3D* o = new Object3D{all[(i*7919) % all.size()]};
+        o->rotateZ(Deg(i*1.5f))
+          .translate(Vector3::xAxis(i*0.001f));
+        all.push_back(o);
+        if(i % 5 == 0) objects.push_back(*o);
+    }
+
+    /* Duplicates and the scene itself */
+    objects.push_back(*all[5]);
+    objects.push_back(*all[1]);
+    objects.push_back(s);
+
+    const Matrix4 initial = Matrix4::rotationX(Deg(90.0f)).inverted();
+    std::vector<Matrix4> serial(objects.size());
+    s.transformationMatrices(objects, {serial.data(), serial.size()}, initial);
+
+    /* Results should be bit-for-bit equal to the serial version, for any
+       thread count */
+    for(UnsignedInt threadCount: {1, 2, 7}) {
+        ThreadPool pool{threadCount};
+        std::vector<Matrix4> parallel(objects.size());
+        s.transformationMatrices(objects, {parallel.data(), parallel.size()}, initial, pool);
+        CORRADE_VERIFY(std::memcmp(parallel.data(), serial.data(), serial.size()*sizeof(Matrix4)) == 0);
+
+        /* Type-erased variant */
+        std::vector<std::reference_wrapper<AbstractObject3D>> abstractObjects{objects.begin(), objects.end()};
+        static_cast<AbstractObject3D&>(s).transformationMatrices(abstractObjects, {parallel.data(), parallel.size()}, initial, pool);
+        CORRADE_VERIFY(std::memcmp(parallel.data(), serial.data(), serial.size()*sizeof(Matrix4)) == 0);
+    }
+
+    /* All internal marks are cleaned, so the serial version gives the same
+       result afterwards */
+    std::vector<Matrix4> serialAgain(objects.size());
+    s.transformations(objects, {serialAgain.data(), serialAgain.size()}, initial);
+    CORRADE_VERIFY(std::memcmp(serialAgain.data(), serial.data(), serial.size()*sizeof(Matrix4)) == 0);
+}
+
 void ObjectTest::setClean() {
     Scene3D scene;
 
@@ -484,6 +589,38 @@ void ObjectTest::setCleanListBulk() {
     CORRADE_COMPARE(d.cleanedAbsoluteTransformation, Matrix4::translation(Vector3::zAxis(3.0f))*Matrix4::scaling(Vector3(-2.0f)));
 }
 
+void ObjectTest::setCleanListParallel() {
+    ThreadPool pool{4};
+
+    /* Verify it doesn't crash when passed empty list */
+    Object3D::setClean({}, pool);
+
+    Scene3D scene;
+    Object3D a(&scene);
+    a.rotateY(Deg(15.0f));
+    CachingObject b(&a);
+    b.translate(Vector3::zAxis(3.0f));
+    CachingObject c(&b);
+    c.scale(Vector3(-2.0f));
+    CachingObject d(&scene);
+    d.translate(Vector3::xAxis(1.0f));
+
+    Object3D::setClean({c, d}, pool);
+    CORRADE_VERIFY(!a.isDirty());
+    CORRADE_VERIFY(!b.isDirty());
+    CORRADE_VERIFY(!c.isDirty());
+    CORRADE_VERIFY(!d.isDirty());
+    CORRADE_COMPARE(b.cleanedAbsoluteTransformation, b.absoluteTransformationMatrix());
+    CORRADE_COMPARE(c.cleanedAbsoluteTransformation, c.absoluteTransformationMatrix());
+    CORRADE_COMPARE(d.cleanedAbsoluteTransformation, d.absoluteTransformationMatrix());
+
+    /* Type-erased variant */
+    d.translate(Vector3::yAxis(1.0f));
+    AbstractObject3D::setClean({d}, pool);
+    CORRADE_VERIFY(!d.isDirty());
+    CORRADE_COMPARE(d.cleanedAbsoluteTransformation, Matrix4::translation({1.0f, 1.0f, 0.0f}));
+}
+
 void ObjectTest::rangeBasedForChildren() {
     Scene3D scene;
     Object3D a(&scene);
@@ -0,0 +1,262 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/OpenGLTester.h"
+#include "Magnum/Renderer.h"
+#include "Magnum/SceneGraph/Camera.h"
+#include "Magnum/SceneGraph/Drawable.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/OcclusionCuller.h"
+#include "Magnum/SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+struct OcclusionCullerGLTest: OpenGLTester {
+    explicit OcclusionCullerGLTest();
+
+    void construct();
+    void noBoundingBox();
+    void outsideFrustum();
+    void occluded();
+    void cameraInside();
+    void reset();
+};
+
+OcclusionCullerGLTest::OcclusionCullerGLTest() {
+    addTests({&OcclusionCullerGLTest::construct,
+              &OcclusionCullerGLTest::noBoundingBox,
+              &OcclusionCullerGLTest::outsideFrustum,
+              &OcclusionCullerGLTest::occluded,
+              &OcclusionCullerGLTest::cameraInside,
+              &OcclusionCullerGLTest::reset});
+}
+
+namespace {
+    /* Draws no samples, so its query always reports it as occluded */
+    struct CountingDrawable: Drawable3D {
+        explicit CountingDrawable(Object3D& object, DrawableGroup3D& group, std::size_t& count): Drawable3D{object, &group}, count(count) {}
+
+        void draw(const Matrix4&, Camera3D&) override { ++count; }
+
+        std::size_t& count;
+    };
+}
+
+#ifndef MAGNUM_TARGET_GLES
+typedef Extensions::GL::ARB::occlusion_query2 AnySamplesExtension;
+#else
+typedef Extensions::GL::EXT::occlusion_query_boolean AnySamplesExtension;
+#endif
+
+#define SKIP_IF_QUERIES_NOT_SUPPORTED()                                     \
+    do {                                                                    \
+        if(!Context::current().isExtensionSupported<AnySamplesExtension>()) \
+            CORRADE_SKIP(AnySamplesExtension::string() + std::string(" is not available.")); \
+    } while(false)
+
+void OcclusionCullerGLTest::construct() {
+    SKIP_IF_QUERIES_NOT_SUPPORTED();
+
+    {
+        OcclusionCuller3D culler{[](const Matrix4&) {}, 16};
+        CORRADE_COMPARE(culler.queryCount(), 16);
+        CORRADE_COMPARE(culler.pendingQueryCount(), 0);
+        CORRADE_COMPARE(culler.borderlineFrameCount(), 2);
+        CORRADE_COMPARE(culler.occludedCount(), 0);
+    }
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void OcclusionCullerGLTest::noBoundingBox() {
+    SKIP_IF_QUERIES_NOT_SUPPORTED();
+
+    Scene3D scene;
+    Object3D cameraObject{&scene};
+    Camera3D camera{cameraObject};
+    camera.setProjectionMatrix(Matrix4::perspectiveProjection(Deg(60.0f), 1.0f, 0.1f, 100.0f));
+
+    DrawableGroup3D drawables;
+    std::size_t drawn = 0;
+    Object3D object{&scene};
+    object.translate(Vector3::zAxis(-5.0f));
+    new CountingDrawable{object, drawables, drawn};
+
+    std::size_t proxies = 0;
+    OcclusionCuller3D culler{[&proxies](const Matrix4&) { ++proxies; }, 16};
+    for(std::size_t i = 0; i != 5; ++i) {
+        CORRADE_COMPARE(culler.draw(camera, drawables), 1);
+        Renderer::finish();
+    }
+
+    /* Drawables without a bounding box are never queried */
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(drawn, 5);
+    CORRADE_COMPARE(proxies, 0);
+    CORRADE_COMPARE(culler.pendingQueryCount(), 0);
+    CORRADE_COMPARE(culler.occludedCount(), 0);
+}
+
+void OcclusionCullerGLTest::outsideFrustum() {
+    SKIP_IF_QUERIES_NOT_SUPPORTED();
+
+    Scene3D scene;
+    Object3D cameraObject{&scene};
+    Camera3D camera{cameraObject};
+    camera.setProjectionMatrix(Matrix4::perspectiveProjection(Deg(60.0f), 1.0f, 0.1f, 100.0f));
+
+    DrawableGroup3D drawables;
+    std::size_t drawn = 0;
+    Object3D object{&scene};
+    object.translate(Vector3::zAxis(5.0f));
+    (new CountingDrawable{object, drawables, drawn})->setBoundingBox({Vector3{-1.0f}, Vector3{1.0f}});
+
+    OcclusionCuller3D culler{[](const Matrix4&) {}, 16};
+    CORRADE_COMPARE(culler.draw(camera, drawables), 0);
+
+    /* Frustum-culled drawables aren't counted as occluded */
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(drawn, 0);
+    CORRADE_COMPARE(culler.pendingQueryCount(), 0);
+    CORRADE_COMPARE(culler.occludedCount(), 0);
+}
+
+void OcclusionCullerGLTest::occluded() {
+    SKIP_IF_QUERIES_NOT_SUPPORTED();
+
+    Scene3D scene;
+    Object3D cameraObject{&scene};
+    Camera3D camera{cameraObject};
+    camera.setProjectionMatrix(Matrix4::perspectiveProjection(Deg(60.0f), 1.0f, 0.1f, 100.0f));
+
+    DrawableGroup3D drawables;
+    std::size_t drawn = 0;
+    Object3D object{&scene};
+    object.translate(Vector3::zAxis(-5.0f));
+    (new CountingDrawable{object, drawables, drawn})->setBoundingBox({Vector3{-1.0f}, Vector3{1.0f}});
+
+    std::size_t proxies = 0;
+    Matrix4 proxyTransformationProjection;
+    OcclusionCuller3D culler{[&](const Matrix4& transformationProjection) {
+        ++proxies;
+        proxyTransformationProjection = transformationProjection;
+    }, 16};
+
+    /* First frame, considered visible and queried while drawing */
+    CORRADE_COMPARE(culler.draw(camera, drawables), 1);
+    CORRADE_COMPARE(culler.pendingQueryCount(), 1);
+    CORRADE_COMPARE(proxies, 0);
+    Renderer::finish();
+
+    /* The drawable drew nothing so it's occluded, but still drawn
+       conditionally for the borderline frames */
+    CORRADE_COMPARE(culler.draw(camera, drawables), 1);
+    CORRADE_COMPARE(culler.pendingQueryCount(), 1);
+    CORRADE_COMPARE(proxies, 1);
+    CORRADE_COMPARE(proxyTransformationProjection, camera.projectionMatrix()*Matrix4::translation(Vector3::zAxis(-5.0f)));
+    Renderer::finish();
+
+    CORRADE_COMPARE(culler.draw(camera, drawables), 1);
+    CORRADE_COMPARE(proxies, 2);
+    CORRADE_COMPARE(culler.occludedCount(), 0);
+    Renderer::finish();
+
+    /* Only the proxy is drawn from now on */
+    CORRADE_COMPARE(culler.draw(camera, drawables), 0);
+    CORRADE_COMPARE(proxies, 3);
+    CORRADE_COMPARE(culler.occludedCount(), 1);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(drawn, 3);
+}
+
+void OcclusionCullerGLTest::cameraInside() {
+    SKIP_IF_QUERIES_NOT_SUPPORTED();
+
+    Scene3D scene;
+    Object3D cameraObject{&scene};
+    Camera3D camera{cameraObject};
+    camera.setProjectionMatrix(Matrix4::perspectiveProjection(Deg(60.0f), 1.0f, 0.1f, 100.0f));
+
+    DrawableGroup3D drawables;
+    std::size_t drawn = 0;
+    Object3D object{&scene};
+    object.translate(Vector3::zAxis(-0.5f));
+    (new CountingDrawable{object, drawables, drawn})->setBoundingBox({Vector3{-1.0f}, Vector3{1.0f}});
+
+    std::size_t proxies = 0;
+    OcclusionCuller3D culler{[&proxies](const Matrix4&) { ++proxies; }, 16};
+    culler.setBorderlineFrameCount(0);
+    for(std::size_t i = 0; i != 5; ++i) {
+        CORRADE_COMPARE(culler.draw(camera, drawables), 1);
+        Renderer::finish();
+    }
+
+    /* The query reports it as occluded, but the camera is inside the box */
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(drawn, 5);
+    CORRADE_COMPARE(proxies, 0);
+}
+
+void OcclusionCullerGLTest::reset() {
+    SKIP_IF_QUERIES_NOT_SUPPORTED();
+
+    Scene3D scene;
+    Object3D cameraObject{&scene};
+    Camera3D camera{cameraObject};
+    camera.setProjectionMatrix(Matrix4::perspectiveProjection(Deg(60.0f), 1.0f, 0.1f, 100.0f));
+
+    DrawableGroup3D drawables;
+    std::size_t drawn = 0;
+    Object3D object{&scene};
+    object.translate(Vector3::zAxis(-5.0f));
+    (new CountingDrawable{object, drawables, drawn})->setBoundingBox({Vector3{-1.0f}, Vector3{1.0f}});
+
+    OcclusionCuller3D culler{[](const Matrix4&) {}, 16};
+    culler.setBorderlineFrameCount(0);
+    CORRADE_COMPARE(culler.draw(camera, drawables), 1);
+    Renderer::finish();
+    CORRADE_COMPARE(culler.draw(camera, drawables), 0);
+    CORRADE_COMPARE(culler.occludedCount(), 1);
+
+    /* The in-flight proxy query is ignored, so the drawable is visible
+       again */
+    culler.reset();
+    Renderer::finish();
+    CORRADE_COMPARE(culler.draw(camera, drawables), 1);
+    CORRADE_COMPARE(culler.occludedCount(), 0);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(drawn, 2);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::OcclusionCullerGLTest)
@@ -0,0 +1,197 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/SceneGraph/Animable.h"
+#include "Magnum/SceneGraph/AnimableGroup.h"
+#include "Magnum/SceneGraph/Camera.h"
+#include "Magnum/SceneGraph/Drawable.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+struct SceneGraphBenchmark: TestSuite::Tester {
+    explicit SceneGraphBenchmark();
+
+    void transformations();
+    void setClean();
+    void draw();
+    void step();
+};
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+namespace {
+
+enum: std::size_t { BenchmarkRepeats = 5 };
+
+constexpr struct {
+    const char* name;
+    std::size_t objectCount;
+    std::size_t depth;
+} BenchmarkData[] {
+    {"1k objects, depth 1", 1000, 1},
+    {"1k objects, depth 8", 1000, 8},
+    {"1k objects, depth 32", 1000, 32},
+    {"100k objects, depth 1", 100000, 1},
+    {"100k objects, depth 8", 100000, 8},
+    {"100k objects, depth 32", 100000, 32},
+    {"1M objects, depth 8", 1000000, 8}
+};
+
+/* Chains of given depth attached to the scene root, every object slightly
+   transformed so the math doesn't degenerate to identity multiplications */
+std::vector<Object3D*> populate(Scene3D& scene, const std::size_t objectCount, const std::size_t depth) {
+    std::vector<Object3D*> objects;
+    objects.reserve(objectCount);
+    for(std::size_t i = 0; i != objectCount; ++i) {
+        Object3D* const parent = i % depth ? objects.back() : static_cast<Object3D*>(&scene);
+        objects.push_back(new Object3D{parent});
+        objects.back()->translate(Vector3::xAxis(0.01f*(i % 7)))
+            .rotateY(Deg(Float(i % 11)));
+    }
+    return objects;
+}
+
+struct CountingDrawable: Drawable3D {
+    explicit CountingDrawable(Object3D& object, DrawableGroup3D& group, Float& sum): Drawable3D{object, &group}, _sum(sum) {}
+
+    void draw(const Matrix4& transformationMatrix, Camera3D&) override {
+        _sum += transformationMatrix.translation().x();
+    }
+
+    Float& _sum;
+};
+
+struct CountingAnimable: Animable3D {
+    explicit CountingAnimable(Object3D& object, AnimableGroup3D& group, Float& sum): Animable3D{object, &group}, _sum(sum) {
+        setDuration(1.0f);
+        setRepeated(true);
+        setState(AnimationState::Running);
+    }
+
+    void animationStep(Float time, Float) override { _sum += time; }
+
+    Float& _sum;
+};
+
+}
+
+SceneGraphBenchmark::SceneGraphBenchmark() {
+    addInstancedBenchmarks({&SceneGraphBenchmark::transformations,
+                            &SceneGraphBenchmark::setClean,
+                            &SceneGraphBenchmark::draw,
+                            &SceneGraphBenchmark::step}, 5,
+        Containers::arraySize(BenchmarkData));
+}
+
+void SceneGraphBenchmark::transformations() {
+    const auto& data = BenchmarkData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Scene3D scene;
+    const std::vector<Object3D*> objects = populate(scene, data.objectCount, data.depth);
+    std::vector<std::reference_wrapper<Object3D>> references;
+    references.reserve(objects.size());
+    for(Object3D* o: objects) references.push_back(*o);
+
+    std::vector<Matrix4> transformations;
+    CORRADE_BENCHMARK(BenchmarkRepeats)
+        transformations = scene.transformations(references);
+
+    CORRADE_COMPARE(transformations.size(), data.objectCount);
+}
+
+void SceneGraphBenchmark::setClean() {
+    const auto& data = BenchmarkData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Scene3D scene;
+    const std::vector<Object3D*> objects = populate(scene, data.objectCount, data.depth);
+    std::vector<std::reference_wrapper<Object3D>> references;
+    references.reserve(objects.size());
+    for(Object3D* o: objects) references.push_back(*o);
+
+    /* Dirtying the chain roots dirties the whole hierarchy, which is the
+       worst case for the cache */
+    CORRADE_BENCHMARK(BenchmarkRepeats) {
+        for(std::size_t i = 0; i < objects.size(); i += data.depth)
+            objects[i]->setDirty();
+        Object3D::setClean(references);
+    }
+
+    CORRADE_VERIFY(!objects.back()->isDirty());
+}
+
+void SceneGraphBenchmark::draw() {
+    const auto& data = BenchmarkData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Scene3D scene;
+    const std::vector<Object3D*> objects = populate(scene, data.objectCount, data.depth);
+
+    Float sum{};
+    DrawableGroup3D drawables;
+    for(Object3D* o: objects) new CountingDrawable{*o, drawables, sum};
+
+    Object3D cameraObject{&scene};
+    cameraObject.translate(Vector3::zAxis(10.0f));
+    Camera3D camera{cameraObject};
+
+    CORRADE_BENCHMARK(BenchmarkRepeats)
+        camera.draw(drawables);
+
+    CORRADE_COMPARE(drawables.size(), data.objectCount);
+}
+
+void SceneGraphBenchmark::step() {
+    const auto& data = BenchmarkData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Scene3D scene;
+    const std::vector<Object3D*> objects = populate(scene, data.objectCount, data.depth);
+
+    Float sum{};
+    AnimableGroup3D animables;
+    for(Object3D* o: objects) new CountingAnimable{*o, animables, sum};
+
+    Float time = 0.0f;
+    CORRADE_BENCHMARK(BenchmarkRepeats) {
+        animables.step(time, 1.0f/60.0f);
+        time += 1.0f/60.0f;
+    }
+
+    CORRADE_COMPARE(animables.runningCount(), data.objectCount);
+    CORRADE_VERIFY(sum > 0.0f);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::SceneGraphBenchmark)
@@ -35,14 +35,40 @@ struct SceneTest: TestSuite::Tester {
 
     void transformation();
     void parent();
+
+    void cleanAll();
+    void cleanAllOnlyChanged();
+    void cleanAllDestroyedObject();
+    void cleanAllMovedToAnotherScene();
 };
 
 typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
 typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
 
+class CountingObject: public Object3D, AbstractFeature3D {
+    public:
+        CountingObject(Object3D* parent = nullptr): Object3D(parent), AbstractFeature3D(*this) {
+            setCachedTransformations(CachedTransformation::Absolute);
+        }
+
+        Int cleanCount = 0;
+        Matrix4 cleanedAbsoluteTransformation;
+
+    protected:
+        void clean(const Matrix4& absoluteTransformation) override {
+            ++cleanCount;
+            cleanedAbsoluteTransformation = absoluteTransformation;
+        }
+};
+
 SceneTest::SceneTest() {
     addTests({&SceneTest::transformation,
-              &SceneTest::parent});
+              &SceneTest::parent,
+
+              &SceneTest::cleanAll,
+              &SceneTest::cleanAllOnlyChanged,
+              &SceneTest::cleanAllDestroyedObject,
+              &SceneTest::cleanAllMovedToAnotherScene});
 }
 
 void SceneTest::transformation() {
@@ -65,6 +91,109 @@ void SceneTest::parent() {
     CORRADE_VERIFY(object.children().isEmpty());
 }
 
+void SceneTest::cleanAll() {
+    Scene3D scene;
+    CountingObject a{&scene};
+    a.translate(Vector3::xAxis(3.0f));
+    CountingObject aa{&a};
+    aa.rotateX(Deg(35.0f));
+    CountingObject b{&scene};
+    b.scale(Vector3(2.0f));
+
+    scene.cleanAll();
+    CORRADE_VERIFY(!scene.isDirty());
+    CORRADE_VERIFY(!a.isDirty());
+    CORRADE_VERIFY(!aa.isDirty());
+    CORRADE_VERIFY(!b.isDirty());
+    CORRADE_COMPARE(a.cleanCount, 1);
+    CORRADE_COMPARE(aa.cleanCount, 1);
+    CORRADE_COMPARE(b.cleanCount, 1);
+    CORRADE_COMPARE(a.cleanedAbsoluteTransformation, Matrix4::translation(Vector3::xAxis(3.0f)));
+    CORRADE_COMPARE(aa.cleanedAbsoluteTransformation, Matrix4::translation(Vector3::xAxis(3.0f))*Matrix4::rotationX(Deg(35.0f)));
+    CORRADE_COMPARE(b.cleanedAbsoluteTransformation, Matrix4::scaling(Vector3(2.0f)));
+
+    /* Nothing changed, nothing to do */
+    scene.cleanAll();
+    CORRADE_COMPARE(a.cleanCount, 1);
+    CORRADE_COMPARE(aa.cleanCount, 1);
+    CORRADE_COMPARE(b.cleanCount, 1);
+}
+
+void SceneTest::cleanAllOnlyChanged() {
+    Scene3D scene;
+    CountingObject a{&scene};
+    CountingObject aa{&a};
+    CountingObject aaa{&aa};
+    CountingObject b{&scene};
+    scene.cleanAll();
+
+    /* Changing both a child and its parent should clean the child only once,
+       regardless of the order */
+    aa.translate(Vector3::yAxis(1.0f));
+    a.translate(Vector3::xAxis(1.0f));
+    scene.cleanAll();
+    CORRADE_COMPARE(a.cleanCount, 2);
+    CORRADE_COMPARE(aa.cleanCount, 2);
+    CORRADE_COMPARE(aaa.cleanCount, 2);
+    CORRADE_COMPARE(b.cleanCount, 1);
+    CORRADE_COMPARE(aaa.cleanedAbsoluteTransformation, Matrix4::translation({1.0f, 1.0f, 0.0f}));
+
+    /* Object cleaned explicitly in the meantime is not cleaned again */
+    aaa.translate(Vector3::zAxis(1.0f));
+    aaa.setClean();
+    scene.cleanAll();
+    CORRADE_COMPARE(aaa.cleanCount, 3);
+    CORRADE_COMPARE(aaa.cleanedAbsoluteTransformation, Matrix4::translation({1.0f, 1.0f, 1.0f}));
+}
+
+void SceneTest::cleanAllDestroyedObject() {
+    Scene3D scene;
+    CountingObject a{&scene};
+    scene.cleanAll();
+
+    /* Destroyed objects are removed from the list */
+    {
+        Object3D* b = new Object3D{&a};
+        new Object3D{b};
+        a.translate(Vector3::xAxis(1.0f));
+        b->translate(Vector3::xAxis(1.0f));
+        delete b;
+    }
+
+    scene.cleanAll();
+    CORRADE_COMPARE(a.cleanCount, 2);
+
+    /* Objects still scheduled when the scene is destroyed are fine too */
+    {
+        Scene3D another;
+        Object3D* c = new Object3D{&another};
+        new Object3D{c};
+    }
+}
+
+void SceneTest::cleanAllMovedToAnotherScene() {
+    Scene3D scene;
+    Scene3D another;
+    CountingObject a{&scene};
+    CountingObject aa{&a};
+    scene.cleanAll();
+    another.cleanAll();
+
+    /* The child is scheduled in the first scene, but the parent gets moved
+       away */
+    aa.translate(Vector3::xAxis(1.0f));
+    a.setParent(&another);
+    scene.cleanAll();
+    CORRADE_VERIFY(aa.isDirty());
+    CORRADE_COMPARE(aa.cleanCount, 1);
+
+    another.cleanAll();
+    CORRADE_VERIFY(!a.isDirty());
+    CORRADE_VERIFY(!aa.isDirty());
+    CORRADE_COMPARE(a.cleanCount, 2);
+    CORRADE_COMPARE(aa.cleanCount, 2);
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::SceneTest)
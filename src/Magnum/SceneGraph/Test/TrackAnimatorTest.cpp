@@ -0,0 +1,345 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/SceneGraph/DualComplexTransformation.h"
+#include "Magnum/SceneGraph/DualQuaternionTransformation.h"
+#include "Magnum/SceneGraph/MatrixTransformation2D.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Scene.h"
+#include "Magnum/SceneGraph/TrackAnimator.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+struct TrackAnimatorTest: TestSuite::Tester {
+    explicit TrackAnimatorTest();
+
+    void construct();
+    void addTrack();
+    void addTrackEmpty();
+    void addTrackNotSorted();
+    void invalidTrack();
+
+    void step3D();
+    void step2D();
+    void stepRigid();
+    void stepNotPlaying();
+    void stepPastEnd();
+    void stepLooping();
+    void stepBackwards();
+    void stepSingleKeyframe();
+    void stepDirtyHierarchy();
+};
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation2D> Object2D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation2D> Scene2D;
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+typedef SceneGraph::TrackAnimator<SceneGraph::MatrixTransformation2D> TrackAnimator2D;
+typedef SceneGraph::TrackAnimator<SceneGraph::MatrixTransformation3D> TrackAnimator3D;
+
+TrackAnimatorTest::TrackAnimatorTest() {
+    addTests({&TrackAnimatorTest::construct,
+              &TrackAnimatorTest::addTrack,
+              &TrackAnimatorTest::addTrackEmpty,
+              &TrackAnimatorTest::addTrackNotSorted,
+              &TrackAnimatorTest::invalidTrack,
+
+              &TrackAnimatorTest::step3D,
+              &TrackAnimatorTest::step2D,
+              &TrackAnimatorTest::stepRigid,
+              &TrackAnimatorTest::stepNotPlaying,
+              &TrackAnimatorTest::stepPastEnd,
+              &TrackAnimatorTest::stepLooping,
+              &TrackAnimatorTest::stepBackwards,
+              &TrackAnimatorTest::stepSingleKeyframe,
+              &TrackAnimatorTest::stepDirtyHierarchy});
+}
+
+/* Translation from 0 to 4 along X in two seconds, then back to 0 in another
+   two seconds */
+const std::vector<TrackAnimator3D::Keyframe> TranslationTrack{
+    {0.0f, {}, {}, Vector3{1.0f}},
+    {2.0f, Vector3::xAxis(4.0f), {}, Vector3{1.0f}},
+    {4.0f, {}, {}, Vector3{1.0f}}
+};
+
+void TrackAnimatorTest::construct() {
+    TrackAnimator3D animator;
+    CORRADE_COMPARE(animator.trackCount(), 0);
+    CORRADE_COMPARE(animator.keyframeCount(), 0);
+    CORRADE_COMPARE(animator.playingCount(), 0);
+
+    /* Shouldn't crash */
+    animator.step(1.0f);
+}
+
+void TrackAnimatorTest::addTrack() {
+    Scene3D scene;
+    Object3D a{&scene}, b{&scene};
+
+    TrackAnimator3D animator;
+    CORRADE_COMPARE(animator.addTrack(a, TranslationTrack), 0);
+    CORRADE_COMPARE(animator.addTrack(b, {{0.5f, {}, {}, Vector3{1.0f}}}), 1);
+    CORRADE_COMPARE(animator.trackCount(), 2);
+    CORRADE_COMPARE(animator.keyframeCount(), 4);
+    CORRADE_COMPARE(animator.duration(0), 4.0f);
+    CORRADE_COMPARE(animator.duration(1), 0.5f);
+    CORRADE_VERIFY(!animator.isPlaying(0));
+    CORRADE_VERIFY(!animator.isPlaying(1));
+
+    animator.play(1, 0.0f);
+    CORRADE_VERIFY(!animator.isPlaying(0));
+    CORRADE_VERIFY(animator.isPlaying(1));
+    CORRADE_COMPARE(animator.playingCount(), 1);
+
+    animator.stop(1);
+    CORRADE_VERIFY(!animator.isPlaying(1));
+    CORRADE_COMPARE(animator.playingCount(), 0);
+}
+
+void TrackAnimatorTest::addTrackEmpty() {
+    Scene3D scene;
+    Object3D object{&scene};
+    TrackAnimator3D animator;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    animator.addTrack(object, {});
+    CORRADE_COMPARE(animator.trackCount(), 0);
+    CORRADE_COMPARE(out.str(), "SceneGraph::TrackAnimator::addTrack(): expected at least one keyframe\n");
+}
+
+void TrackAnimatorTest::addTrackNotSorted() {
+    Scene3D scene;
+    Object3D object{&scene};
+    TrackAnimator3D animator;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    animator.addTrack(object, {
+        {0.0f, {}, {}, Vector3{1.0f}},
+        {2.0f, {}, {}, Vector3{1.0f}},
+        {1.0f, {}, {}, Vector3{1.0f}}
+    });
+    CORRADE_COMPARE(animator.trackCount(), 0);
+    CORRADE_COMPARE(out.str(), "SceneGraph::TrackAnimator::addTrack(): keyframe 2 is not sorted by time\n");
+}
+
+void TrackAnimatorTest::invalidTrack() {
+    TrackAnimator3D animator;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    animator.duration(0);
+    animator.isPlaying(1);
+    animator.play(2, 0.0f);
+    animator.stop(3);
+    CORRADE_COMPARE(out.str(),
+        "SceneGraph::TrackAnimator::duration(): index 0 out of range for 0 tracks\n"
+        "SceneGraph::TrackAnimator::isPlaying(): index 1 out of range for 0 tracks\n"
+        "SceneGraph::TrackAnimator::play(): index 2 out of range for 0 tracks\n"
+        "SceneGraph::TrackAnimator::stop(): index 3 out of range for 0 tracks\n");
+}
+
+void TrackAnimatorTest::step3D() {
+    Scene3D scene;
+    Object3D object{&scene};
+
+    TrackAnimator3D animator;
+    animator.addTrack(object, {
+        {0.0f, {}, {}, Vector3{1.0f}},
+        {1.0f, {2.0f, 0.0f, 0.0f}, Quaternion::rotation(Deg(90.0f), Vector3::zAxis()), {1.0f, 3.0f, 1.0f}}
+    });
+    animator.play(0, 10.0f);
+
+    animator.step(10.5f);
+    CORRADE_COMPARE(object.transformationMatrix(),
+        Matrix4::translation({1.0f, 0.0f, 0.0f})*
+        Matrix4::rotationZ(Deg(45.0f))*
+        Matrix4::scaling({1.0f, 2.0f, 1.0f}));
+}
+
+void TrackAnimatorTest::step2D() {
+    Scene2D scene;
+    Object2D object{&scene};
+
+    TrackAnimator2D animator;
+    animator.addTrack(object, {
+        {0.0f, {}, {}, Vector2{1.0f}},
+        {1.0f, {0.0f, 4.0f}, Complex::rotation(Deg(90.0f)), {3.0f, 1.0f}}
+    });
+    animator.play(0, 0.0f);
+
+    animator.step(0.5f);
+    CORRADE_COMPARE(object.transformationMatrix(),
+        Matrix3::translation({0.0f, 2.0f})*
+        Matrix3::rotation(Deg(45.0f))*
+        Matrix3::scaling({2.0f, 1.0f}));
+}
+
+void TrackAnimatorTest::stepRigid() {
+    Scene<SceneGraph::DualQuaternionTransformation> scene;
+    Object<SceneGraph::DualQuaternionTransformation> object{&scene};
+
+    TrackAnimator<SceneGraph::DualQuaternionTransformation> animator;
+    animator.addTrack(object, {
+        {0.0f, {}, {}, Vector3{1.0f}},
+        {2.0f, {0.0f, 0.0f, 2.0f}, Quaternion::rotation(Deg(60.0f), Vector3::xAxis()), Vector3{1.0f}}
+    });
+    animator.play(0, 0.0f);
+
+    animator.step(1.0f);
+    CORRADE_COMPARE(object.transformation(),
+        DualQuaternion::translation({0.0f, 0.0f, 1.0f})*
+        DualQuaternion::rotation(Deg(30.0f), Vector3::xAxis()));
+}
+
+void TrackAnimatorTest::stepNotPlaying() {
+    Scene3D scene;
+    Object3D object{&scene};
+    object.translate(Vector3::yAxis(5.0f));
+
+    TrackAnimator3D animator;
+    animator.addTrack(object, TranslationTrack);
+
+    /* Not touched when not playing */
+    animator.step(1.0f);
+    CORRADE_COMPARE(object.transformationMatrix(), Matrix4::translation(Vector3::yAxis(5.0f)));
+
+    /* Not touched after stopping */
+    animator.play(0, 0.0f);
+    animator.step(1.0f);
+    CORRADE_COMPARE(object.transformationMatrix(), Matrix4::translation(Vector3::xAxis(2.0f)));
+    animator.stop(0);
+    animator.step(2.0f);
+    CORRADE_COMPARE(object.transformationMatrix(), Matrix4::translation(Vector3::xAxis(2.0f)));
+}
+
+void TrackAnimatorTest::stepPastEnd() {
+    Scene3D scene;
+    Object3D object{&scene};
+
+    TrackAnimator3D animator;
+    animator.addTrack(object, {
+        {0.0f, {}, {}, Vector3{1.0f}},
+        {2.0f, Vector3::xAxis(4.0f), {}, Vector3{1.0f}}
+    });
+    animator.play(0, 0.0f);
+
+    /* The last keyframe is applied and the track stops */
+    animator.step(5.0f);
+    CORRADE_COMPARE(object.transformationMatrix(), Matrix4::translation(Vector3::xAxis(4.0f)));
+    CORRADE_VERIFY(!animator.isPlaying(0));
+    CORRADE_COMPARE(animator.playingCount(), 0);
+}
+
+void TrackAnimatorTest::stepLooping() {
+    Scene3D scene;
+    Object3D object{&scene};
+
+    TrackAnimator3D animator;
+    animator.addTrack(object, TranslationTrack);
+    animator.play(0, 1.0f, true);
+
+    /* Second loop, one second in */
+    animator.step(6.0f);
+    CORRADE_COMPARE(object.transformationMatrix(), Matrix4::translation(Vector3::xAxis(2.0f)));
+    CORRADE_VERIFY(animator.isPlaying(0));
+
+    /* Third loop, three seconds in */
+    animator.step(12.0f);
+    CORRADE_COMPARE(object.transformationMatrix(), Matrix4::translation(Vector3::xAxis(2.0f)));
+    CORRADE_VERIFY(animator.isPlaying(0));
+}
+
+void TrackAnimatorTest::stepBackwards() {
+    Scene3D scene;
+    Object3D object{&scene};
+
+    TrackAnimator3D animator;
+    animator.addTrack(object, TranslationTrack);
+    animator.play(0, 0.0f);
+
+    animator.step(3.0f);
+    CORRADE_COMPARE(object.transformationMatrix(), Matrix4::translation(Vector3::xAxis(2.0f)));
+
+    /* Going back in time finds the earlier keyframe again */
+    animator.step(0.5f);
+    CORRADE_COMPARE(object.transformationMatrix(), Matrix4::translation(Vector3::xAxis(1.0f)));
+
+    /* Before the start the first keyframe is used */
+    animator.step(-1.0f);
+    CORRADE_COMPARE(object.transformationMatrix(), Matrix4{});
+}
+
+void TrackAnimatorTest::stepSingleKeyframe() {
+    Scene3D scene;
+    Object3D object{&scene};
+
+    TrackAnimator3D animator;
+    animator.addTrack(object, {{0.0f, Vector3::zAxis(3.0f), {}, Vector3{1.0f}}});
+    animator.play(0, 0.0f, true);
+
+    animator.step(1.0f);
+    CORRADE_COMPARE(object.transformationMatrix(), Matrix4::translation(Vector3::zAxis(3.0f)));
+    CORRADE_VERIFY(!animator.isPlaying(0));
+}
+
+void TrackAnimatorTest::stepDirtyHierarchy() {
+    Scene3D scene;
+    Object3D child{&scene};
+    Object3D grandchild{&child};
+    Object3D leaf{&grandchild};
+    Object3D parent{&scene};
+    child.setParent(&parent);
+
+    /* The child is animated before its parent */
+    TrackAnimator3D animator;
+    animator.addTrack(grandchild, TranslationTrack);
+    animator.addTrack(parent, TranslationTrack);
+    animator.addTrack(grandchild, TranslationTrack);
+    animator.play(0, 0.0f).play(1, 0.0f).play(2, 0.0f);
+
+    leaf.setClean();
+    CORRADE_VERIFY(!parent.isDirty());
+    CORRADE_VERIFY(!leaf.isDirty());
+
+    animator.step(1.0f);
+    CORRADE_VERIFY(parent.isDirty());
+    CORRADE_VERIFY(child.isDirty());
+    CORRADE_VERIFY(grandchild.isDirty());
+    CORRADE_VERIFY(leaf.isDirty());
+
+    scene.cleanAll();
+    CORRADE_VERIFY(!leaf.isDirty());
+    CORRADE_COMPARE(leaf.absoluteTransformationMatrix(), Matrix4::translation(Vector3::xAxis(4.0f)));
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::TrackAnimatorTest)
@@ -49,6 +49,9 @@ struct TranslationTransformationTest: TestSuite::Tester {
     void translate();
 
     void integral();
+
+    void cleanTranslation();
+    void cleanTranslationFallback();
 };
 
 TranslationTransformationTest::TranslationTransformationTest() {
@@ -62,7 +65,10 @@ TranslationTransformationTest::TranslationTransformationTest() {
               &TranslationTransformationTest::transform,
               &TranslationTransformationTest::translate,
 
-              &TranslationTransformationTest::integral});
+              &TranslationTransformationTest::integral,
+
+              &TranslationTransformationTest::cleanTranslation,
+              &TranslationTransformationTest::cleanTranslationFallback});
 }
 
 void TranslationTransformationTest::fromMatrix() {
@@ -139,6 +145,63 @@ void TranslationTransformationTest::integral() {
     CORRADE_COMPARE(o.transformationMatrix(), Matrix3::translation({3.0f, -7.0f}));
 }
 
+void TranslationTransformationTest::cleanTranslation() {
+    class CachingFeature: public AbstractFeature2D {
+        public:
+            explicit CachingFeature(AbstractObject2D& object): AbstractFeature2D{object} {
+                setCachedTransformations(CachedTransformation::Absolute|CachedTransformation::AbsoluteTranslation);
+            }
+
+            Int cleanCount{}, cleanTranslationCount{};
+            Vector2 cleanedAbsoluteTranslation;
+
+            void clean(const Matrix3&) override {
+                ++cleanCount;
+            }
+
+            void cleanTranslation(const Vector2& absoluteTranslation) override {
+                ++cleanTranslationCount;
+                cleanedAbsoluteTranslation = absoluteTranslation;
+            }
+    };
+
+    Scene2D s;
+    Object2D a{&s};
+    a.translate({1.0f, -0.3f});
+    Object2D b{&a};
+    b.translate({-0.5f, 2.0f});
+    CachingFeature* feature = new CachingFeature{b};
+
+    /* The native representation is used instead of the matrix */
+    b.setClean();
+    CORRADE_COMPARE(feature->cleanCount, 0);
+    CORRADE_COMPARE(feature->cleanTranslationCount, 1);
+    CORRADE_COMPARE(feature->cleanedAbsoluteTranslation, (Vector2{0.5f, 1.7f}));
+}
+
+void TranslationTransformationTest::cleanTranslationFallback() {
+    class CachingFeature: public AbstractFeature2D {
+        public:
+            explicit CachingFeature(AbstractObject2D& object): AbstractFeature2D{object} {
+                setCachedTransformations(CachedTransformation::AbsoluteTranslation);
+            }
+
+            Matrix3 cleanedAbsoluteTransformation;
+
+            void clean(const Matrix3& absoluteTransformation) override {
+                cleanedAbsoluteTransformation = absoluteTransformation;
+            }
+    };
+
+    Object2D o;
+    o.translate({1.0f, -0.3f});
+    CachingFeature* feature = new CachingFeature{o};
+
+    /* Default implementation converts the translation to a matrix */
+    o.setClean();
+    CORRADE_COMPARE(feature->cleanedAbsoluteTransformation, Matrix3::translation({1.0f, -0.3f}));
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::TranslationTransformationTest)
@@ -0,0 +1,228 @@
+#ifndef Magnum_SceneGraph_TrackAnimator_h
+#define Magnum_SceneGraph_TrackAnimator_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::TrackAnimator
+ */
+
+#include <vector>
+
+#include "Magnum/DimensionTraits.h"
+#include "Magnum/Math/Complex.h"
+#include "Magnum/Math/Quaternion.h"
+#include "Magnum/SceneGraph/SceneGraph.h"
+
+namespace Magnum { namespace SceneGraph {
+
+namespace Implementation {
+    template<UnsignedInt dimensions, class T> struct TrackAnimatorRotation;
+    template<class T> struct TrackAnimatorRotation<2, T> { typedef Math::Complex<T> Type; };
+    template<class T> struct TrackAnimatorRotation<3, T> { typedef Math::Quaternion<T> Type; };
+}
+
+/**
+@brief Batched keyframe animation of object transformations
+
+Data-oriented alternative to @ref Animable for animating large amounts of
+objects. Instead of calling a virtual @ref Animable::animationStep() for each
+animated object, keyframes of all tracks are stored in contiguous arrays
+(separately for times, translations, rotations and scalings) and
+@ref step() samples all playing tracks in a few tight loops over these arrays,
+one per interpolated component, before writing the resulting transformations to
+the objects in a single final pass.
+
+Each track animates one object with a sequence of translation, rotation and
+scaling keyframes. Translation and scaling are interpolated linearly, 3D
+rotations using @ref Math::slerp(), 2D rotations using normalized linear
+interpolation. The resulting transformation is @f$ \boldsymbol{T} \boldsymbol{R} \boldsymbol{S} @f$,
+converted to the underlying transformation type of the object. Transformation
+types that can't represent scaling (e.g. @ref DualQuaternionTransformation)
+need to have all scaling keyframes set to @cpp 1.0f @ce, translation-only
+transformations need all rotations to be identity.
+
+@code{.cpp}
+SceneGraph::TrackAnimator<SceneGraph::MatrixTransformation3D> animator;
+
+UnsignedInt track = animator.addTrack(*object, {
+    {0.0f, {}, {}, Vector3{1.0f}},
+    {1.0f, Vector3::yAxis(2.0f), Quaternion::rotation(180.0_degf, Vector3::zAxis()), Vector3{1.0f}}
+});
+animator.play(track, timeline.previousFrameTime(), true);
+
+// each frame
+animator.step(timeline.previousFrameTime());
+@endcode
+
+@attention The animator holds pointers to the objects, so they need to
+    outlive it or at least the last call to @ref step().
+
+@section SceneGraph-TrackAnimator-explicit-specializations Explicit template specializations
+
+The following specializations are explicitly compiled into @ref SceneGraph
+library. For other specializations (e.g. using @ref Magnum::Double "Double"
+type or special transformation class) you have to use @ref TrackAnimator.hpp
+implementation file to avoid linker errors. See also
+@ref compilation-speedup-hpp for more information.
+
+-   @ref DualComplexTransformation "TrackAnimator<DualComplexTransformation>"
+-   @ref DualQuaternionTransformation "TrackAnimator<DualQuaternionTransformation>"
+-   @ref MatrixTransformation2D "TrackAnimator<MatrixTransformation2D>"
+-   @ref MatrixTransformation3D "TrackAnimator<MatrixTransformation3D>"
+-   @ref RigidMatrixTransformation2D "TrackAnimator<RigidMatrixTransformation2D>"
+-   @ref RigidMatrixTransformation3D "TrackAnimator<RigidMatrixTransformation3D>"
+-   @ref TranslationTransformation2D "TrackAnimator<TranslationTransformation2D>"
+-   @ref TranslationTransformation3D "TrackAnimator<TranslationTransformation3D>"
+
+@see @ref AnimableGroup
+*/
+template<class Transformation> class TrackAnimator {
+    public:
+        /** @brief Vector type */
+        typedef VectorTypeFor<Transformation::Dimensions, typename Transformation::Type> VectorType;
+
+        /**
+         * @brief Rotation type
+         *
+         * @ref Math::Complex in 2D, @ref Math::Quaternion in 3D.
+         */
+        typedef typename Implementation::TrackAnimatorRotation<Transformation::Dimensions, typename Transformation::Type>::Type RotationType;
+
+        /** @brief Matrix type */
+        typedef MatrixTypeFor<Transformation::Dimensions, typename Transformation::Type> MatrixType;
+
+        /** @brief Keyframe */
+        struct Keyframe {
+            Float time;             /**< Time relative to track start */
+            VectorType translation; /**< Translation */
+            RotationType rotation;  /**< Rotation, expected to be normalized */
+            VectorType scaling;     /**< Scaling */
+        };
+
+        /** @brief Constructor */
+        explicit TrackAnimator();
+
+        /** @brief Copying is not allowed */
+        TrackAnimator(const TrackAnimator<Transformation>&) = delete;
+
+        /** @brief Move constructor */
+        TrackAnimator(TrackAnimator<Transformation>&&) = default;
+
+        ~TrackAnimator();
+
+        /** @brief Copying is not allowed */
+        TrackAnimator<Transformation>& operator=(const TrackAnimator<Transformation>&) = delete;
+
+        /** @brief Move assignment */
+        TrackAnimator<Transformation>& operator=(TrackAnimator<Transformation>&&) = default;
+
+        /** @brief Count of tracks */
+        std::size_t trackCount() const { return _objects.size(); }
+
+        /** @brief Count of keyframes in all tracks */
+        std::size_t keyframeCount() const { return _times.size(); }
+
+        /** @brief Count of currently playing tracks */
+        std::size_t playingCount() const;
+
+        /**
+         * @brief Add a track
+         * @param object    Animated object
+         * @param keyframes Keyframes, sorted by time
+         * @return Track ID
+         *
+         * Expects that there's at least one keyframe and that the keyframes
+         * are sorted by time. The track is initially stopped, use @ref play()
+         * to start it.
+         */
+        UnsignedInt addTrack(Object<Transformation>& object, const std::vector<Keyframe>& keyframes);
+
+        /**
+         * @brief Track duration
+         *
+         * Time of the last keyframe of given track.
+         */
+        Float duration(UnsignedInt track) const;
+
+        /** @brief Whether given track is playing */
+        bool isPlaying(UnsignedInt track) const;
+
+        /**
+         * @brief Play a track
+         * @param track     Track ID
+         * @param startTime Absolute time at which the track starts (e.g.
+         *      @ref Timeline::previousFrameTime())
+         * @param looping   Whether to repeat the track indefinitely
+         * @return Reference to self (for method chaining)
+         *
+         * Non-looping tracks stop after the transformation at the last
+         * keyframe is applied.
+         */
+        TrackAnimator<Transformation>& play(UnsignedInt track, Float startTime, bool looping = false);
+
+        /**
+         * @brief Stop a track
+         * @return Reference to self (for method chaining)
+         *
+         * The object keeps its last sampled transformation.
+         */
+        TrackAnimator<Transformation>& stop(UnsignedInt track);
+
+        /**
+         * @brief Perform animation step
+         * @param time      Absolute time (e.g. @ref Timeline::previousFrameTime())
+         *
+         * Samples all playing tracks at given time and sets the resulting
+         * transformations to their objects. All transformations are written
+         * first and the objects are then marked as dirty in a single pass,
+         * so each dirty subtree is walked only once. If there are no playing
+         * tracks, the function does nothing.
+         */
+        void step(Float time);
+
+    private:
+        /* Keyframes of all tracks, one contiguous range per track */
+        std::vector<Float> _times;
+        std::vector<VectorType> _translations;
+        std::vector<RotationType> _rotations;
+        std::vector<VectorType> _scalings;
+
+        /* Per-track data */
+        std::vector<Object<Transformation>*> _objects;
+        std::vector<UnsignedInt> _offsets, _sizes, _cursors;
+        std::vector<Float> _startTimes;
+        std::vector<UnsignedByte> _states;
+
+        /* Scratch storage for step() */
+        std::vector<UnsignedInt> _sampledTracks, _sampledKeyframes, _sampledNextKeyframes;
+        std::vector<Float> _sampledFactors;
+        std::vector<VectorType> _sampledTranslations, _sampledScalings;
+        std::vector<RotationType> _sampledRotations;
+};
+
+}}
+
+#endif
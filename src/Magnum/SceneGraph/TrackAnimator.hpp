@@ -0,0 +1,219 @@
+#ifndef Magnum_SceneGraph_TrackAnimator_hpp
+#define Magnum_SceneGraph_TrackAnimator_hpp
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief @ref compilation-speedup-hpp "Template implementation" for @ref TrackAnimator.h
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/SceneGraph/Object.h"
+#include "Magnum/SceneGraph/TrackAnimator.h"
+
+namespace Magnum { namespace SceneGraph {
+
+namespace Implementation {
+
+enum: UnsignedByte {
+    TrackStopped,
+    TrackPlaying,
+    TrackLooping
+};
+
+template<class T> inline Math::Complex<T> interpolateRotation(const Math::Complex<T>& a, const Math::Complex<T>& b, const T t) {
+    return ((T(1) - t)*a + t*b).normalized();
+}
+
+template<class T> inline Math::Quaternion<T> interpolateRotation(const Math::Quaternion<T>& a, const Math::Quaternion<T>& b, const T t) {
+    return Math::slerp(a, b, t);
+}
+
+/* Scaling the rotation matrix columns is equivalent to R*S */
+template<class T> inline Math::Matrix3<T> composeTranslationRotationScaling(const Math::Vector2<T>& translation, const Math::Complex<T>& rotation, const Math::Vector2<T>& scaling) {
+    Math::Matrix2x2<T> rotationScaling = rotation.toMatrix();
+    for(std::size_t i = 0; i != 2; ++i) rotationScaling[i] *= scaling[i];
+    return Math::Matrix3<T>::from(rotationScaling, translation);
+}
+
+template<class T> inline Math::Matrix4<T> composeTranslationRotationScaling(const Math::Vector3<T>& translation, const Math::Quaternion<T>& rotation, const Math::Vector3<T>& scaling) {
+    Math::Matrix3x3<T> rotationScaling = rotation.toMatrix();
+    for(std::size_t i = 0; i != 3; ++i) rotationScaling[i] *= scaling[i];
+    return Math::Matrix4<T>::from(rotationScaling, translation);
+}
+
+}
+
+template<class Transformation> TrackAnimator<Transformation>::TrackAnimator() = default;
+
+template<class Transformation> TrackAnimator<Transformation>::~TrackAnimator() = default;
+
+template<class Transformation> std::size_t TrackAnimator<Transformation>::playingCount() const {
+    return _states.size() - std::count(_states.begin(), _states.end(), UnsignedByte(Implementation::TrackStopped));
+}
+
+template<class Transformation> UnsignedInt TrackAnimator<Transformation>::addTrack(Object<Transformation>& object, const std::vector<Keyframe>& keyframes) {
+    CORRADE_ASSERT(!keyframes.empty(),
+        "SceneGraph::TrackAnimator::addTrack(): expected at least one keyframe", {});
+    #ifndef CORRADE_NO_ASSERT
+    for(std::size_t i = 1; i < keyframes.size(); ++i)
+        CORRADE_ASSERT(keyframes[i - 1].time <= keyframes[i].time,
+            "SceneGraph::TrackAnimator::addTrack(): keyframe" << i << "is not sorted by time", {});
+    #endif
+
+    _offsets.push_back(UnsignedInt(_times.size()));
+    _sizes.push_back(UnsignedInt(keyframes.size()));
+    _cursors.push_back(0);
+    _startTimes.push_back(0.0f);
+    _states.push_back(Implementation::TrackStopped);
+    _objects.push_back(&object);
+
+    for(const Keyframe& keyframe: keyframes) {
+        _times.push_back(keyframe.time);
+        _translations.push_back(keyframe.translation);
+        _rotations.push_back(keyframe.rotation);
+        _scalings.push_back(keyframe.scaling);
+    }
+
+    return UnsignedInt(_objects.size() - 1);
+}
+
+template<class Transformation> Float TrackAnimator<Transformation>::duration(const UnsignedInt track) const {
+    CORRADE_ASSERT(track < _objects.size(),
+        "SceneGraph::TrackAnimator::duration(): index" << track << "out of range for" << _objects.size() << "tracks", {});
+    return _times[_offsets[track] + _sizes[track] - 1];
+}
+
+template<class Transformation> bool TrackAnimator<Transformation>::isPlaying(const UnsignedInt track) const {
+    CORRADE_ASSERT(track < _objects.size(),
+        "SceneGraph::TrackAnimator::isPlaying(): index" << track << "out of range for" << _objects.size() << "tracks", {});
+    return _states[track] != Implementation::TrackStopped;
+}
+
+template<class Transformation> TrackAnimator<Transformation>& TrackAnimator<Transformation>::play(const UnsignedInt track, const Float startTime, const bool looping) {
+    CORRADE_ASSERT(track < _objects.size(),
+        "SceneGraph::TrackAnimator::play(): index" << track << "out of range for" << _objects.size() << "tracks", *this);
+    _startTimes[track] = startTime;
+    _states[track] = looping ? Implementation::TrackLooping : Implementation::TrackPlaying;
+    _cursors[track] = 0;
+    return *this;
+}
+
+template<class Transformation> TrackAnimator<Transformation>& TrackAnimator<Transformation>::stop(const UnsignedInt track) {
+    CORRADE_ASSERT(track < _objects.size(),
+        "SceneGraph::TrackAnimator::stop(): index" << track << "out of range for" << _objects.size() << "tracks", *this);
+    _states[track] = Implementation::TrackStopped;
+    return *this;
+}
+
+template<class Transformation> void TrackAnimator<Transformation>::step(const Float time) {
+    /* Find keyframes and interpolation factors for all playing tracks */
+    _sampledTracks.clear();
+    _sampledKeyframes.clear();
+    _sampledNextKeyframes.clear();
+    _sampledFactors.clear();
+    for(std::size_t i = 0; i != _objects.size(); ++i) {
+        if(_states[i] == Implementation::TrackStopped) continue;
+
+        const Float* const times = _times.data() + _offsets[i];
+        const UnsignedInt size = _sizes[i];
+        const Float duration = times[size - 1];
+
+        Float localTime = time - _startTimes[i];
+        if(localTime >= duration) {
+            /* Non-looping tracks stop after applying the last keyframe */
+            if(_states[i] == Implementation::TrackPlaying || duration <= 0.0f) {
+                localTime = duration;
+                _states[i] = Implementation::TrackStopped;
+            } else localTime = std::fmod(localTime, duration);
+        }
+
+        /* Most of the time the animation proceeds forward by a small amount,
+           so continue from the last position. Binary search only if the time
+           went back. */
+        UnsignedInt keyframe = _cursors[i];
+        if(times[keyframe] > localTime)
+            keyframe = std::max(UnsignedInt(std::upper_bound(times, times + size, localTime) - times), 1u) - 1;
+        while(keyframe + 1 < size && times[keyframe + 1] <= localTime)
+            ++keyframe;
+        _cursors[i] = keyframe;
+
+        const UnsignedInt next = keyframe + 1 < size ? keyframe + 1 : keyframe;
+        const Float interval = times[next] - times[keyframe];
+        _sampledTracks.push_back(UnsignedInt(i));
+        _sampledKeyframes.push_back(_offsets[i] + keyframe);
+        _sampledNextKeyframes.push_back(_offsets[i] + next);
+        _sampledFactors.push_back(interval > 0.0f ? Math::clamp((localTime - times[keyframe])/interval, 0.0f, 1.0f) : 0.0f);
+    }
+
+    if(_sampledTracks.empty()) return;
+
+    /* Interpolate each component in a separate pass over contiguous arrays */
+    const std::size_t count = _sampledTracks.size();
+    _sampledTranslations.resize(count);
+    for(std::size_t i = 0; i != count; ++i)
+        _sampledTranslations[i] = Math::lerp(_translations[_sampledKeyframes[i]], _translations[_sampledNextKeyframes[i]], _sampledFactors[i]);
+
+    _sampledRotations.resize(count);
+    for(std::size_t i = 0; i != count; ++i)
+        _sampledRotations[i] = Implementation::interpolateRotation(_rotations[_sampledKeyframes[i]], _rotations[_sampledNextKeyframes[i]], typename Transformation::Type(_sampledFactors[i]));
+
+    _sampledScalings.resize(count);
+    for(std::size_t i = 0; i != count; ++i)
+        _sampledScalings[i] = Math::lerp(_scalings[_sampledKeyframes[i]], _scalings[_sampledNextKeyframes[i]], _sampledFactors[i]);
+
+    /* Compose and write the transformations. Objects that are not dirty yet
+       get only the dirty flag, so the write doesn't walk their features and
+       children. Setting transformation of a scene does nothing, so these are
+       left alone. */
+    for(std::size_t i = 0; i != count; ++i) {
+        Object<Transformation>& object = *_objects[_sampledTracks[i]];
+        if(!object.isScene() && !(object.flags & Implementation::ObjectFlag::Dirty))
+            object.flags |= Implementation::ObjectFlag::Dirty|Implementation::ObjectFlag::DirtyDeferred;
+        object.setTransformation(Implementation::Transformation<Transformation>::fromMatrix(Implementation::composeTranslationRotationScaling(_sampledTranslations[i], _sampledRotations[i], _sampledScalings[i])));
+    }
+
+    /* Then propagate the dirty flag from all written objects in a single
+       pass. Animated children are skipped when propagating from their
+       animated parent as they have the flag already, they get handled on
+       their own. */
+    for(std::size_t i = 0; i != count; ++i) {
+        Object<Transformation>& object = *_objects[_sampledTracks[i]];
+        if(!(object.flags & Implementation::ObjectFlag::DirtyDeferred)) continue;
+        object.flags &= ~(Implementation::ObjectFlag::Dirty|Implementation::ObjectFlag::DirtyDeferred);
+        object.setDirty();
+    }
+}
+
+}}
+
+#endif
@@ -25,16 +25,23 @@
 
 #include "Magnum/SceneGraph/AbstractFeature.hpp"
 #include "Magnum/SceneGraph/Animable.hpp"
+#include "Magnum/SceneGraph/BoundingVolume.hpp"
 #include "Magnum/SceneGraph/Camera.hpp"
+#include "Magnum/SceneGraph/DerivedTransformation.hpp"
 #include "Magnum/SceneGraph/Drawable.hpp"
 #include "Magnum/SceneGraph/DualComplexTransformation.h"
 #include "Magnum/SceneGraph/DualQuaternionTransformation.h"
 #include "Magnum/SceneGraph/FeatureGroup.hpp"
+#include "Magnum/SceneGraph/FlatHierarchy.hpp"
+#include "Magnum/SceneGraph/InstancedDrawable.hpp"
+#include "Magnum/SceneGraph/Lod.hpp"
 #include "Magnum/SceneGraph/MatrixTransformation2D.h"
 #include "Magnum/SceneGraph/MatrixTransformation3D.h"
 #include "Magnum/SceneGraph/Object.hpp"
+#include "Magnum/SceneGraph/OcclusionCuller.hpp"
 #include "Magnum/SceneGraph/RigidMatrixTransformation2D.h"
 #include "Magnum/SceneGraph/RigidMatrixTransformation3D.h"
+#include "Magnum/SceneGraph/TrackAnimator.hpp"
 #include "Magnum/SceneGraph/TranslationTransformation.h"
 
 namespace Magnum { namespace SceneGraph {
@@ -63,12 +70,32 @@ template class MAGNUM_SCENEGRAPH_EXPORT_HPP Animable<3, Float>;
 template class MAGNUM_SCENEGRAPH_EXPORT_HPP AnimableGroup<2, Float>;
 template class MAGNUM_SCENEGRAPH_EXPORT_HPP AnimableGroup<3, Float>;
 
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP BoundingVolume<2, Float>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP BoundingVolume<3, Float>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP BoundingVolumeHierarchy<2, Float>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP BoundingVolumeHierarchy<3, Float>;
+
 template class MAGNUM_SCENEGRAPH_EXPORT_HPP Camera<2, Float>;
 template class MAGNUM_SCENEGRAPH_EXPORT_HPP Camera<3, Float>;
 
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP DerivedTransformation<2, Float>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP DerivedTransformation<3, Float>;
+
 template class MAGNUM_SCENEGRAPH_EXPORT_HPP Drawable<2, Float>;
 template class MAGNUM_SCENEGRAPH_EXPORT_HPP Drawable<3, Float>;
 
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP InstancedDrawable<2, Float>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP InstancedDrawable<3, Float>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP InstancedDrawableGroup<2, Float>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP InstancedDrawableGroup<3, Float>;
+
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP BasicLod3D<Float>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP BasicLodGroup3D<Float>;
+
+#if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP BasicOcclusionCuller3D<Float>;
+#endif
+
 template class MAGNUM_SCENEGRAPH_EXPORT_HPP Object<BasicDualComplexTransformation<Float>>;
 template class MAGNUM_SCENEGRAPH_EXPORT_HPP Object<BasicDualQuaternionTransformation<Float>>;
 template class MAGNUM_SCENEGRAPH_EXPORT_HPP Object<BasicMatrixTransformation2D<Float>>;
@@ -77,6 +104,33 @@ template class MAGNUM_SCENEGRAPH_EXPORT_HPP Object<BasicRigidMatrixTransformatio
 template class MAGNUM_SCENEGRAPH_EXPORT_HPP Object<BasicRigidMatrixTransformation3D<Float>>;
 template class MAGNUM_SCENEGRAPH_EXPORT_HPP Object<TranslationTransformation<2, Float>>;
 template class MAGNUM_SCENEGRAPH_EXPORT_HPP Object<TranslationTransformation<3, Float>>;
+
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP Scene<BasicDualComplexTransformation<Float>>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP Scene<BasicDualQuaternionTransformation<Float>>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP Scene<BasicMatrixTransformation2D<Float>>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP Scene<BasicMatrixTransformation3D<Float>>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP Scene<BasicRigidMatrixTransformation2D<Float>>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP Scene<BasicRigidMatrixTransformation3D<Float>>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP Scene<TranslationTransformation<2, Float>>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP Scene<TranslationTransformation<3, Float>>;
+
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP FlatHierarchy<BasicDualComplexTransformation<Float>>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP FlatHierarchy<BasicDualQuaternionTransformation<Float>>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP FlatHierarchy<BasicMatrixTransformation2D<Float>>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP FlatHierarchy<BasicMatrixTransformation3D<Float>>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP FlatHierarchy<BasicRigidMatrixTransformation2D<Float>>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP FlatHierarchy<BasicRigidMatrixTransformation3D<Float>>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP FlatHierarchy<TranslationTransformation<2, Float>>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP FlatHierarchy<TranslationTransformation<3, Float>>;
+
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP TrackAnimator<BasicDualComplexTransformation<Float>>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP TrackAnimator<BasicDualQuaternionTransformation<Float>>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP TrackAnimator<BasicMatrixTransformation2D<Float>>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP TrackAnimator<BasicMatrixTransformation3D<Float>>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP TrackAnimator<BasicRigidMatrixTransformation2D<Float>>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP TrackAnimator<BasicRigidMatrixTransformation3D<Float>>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP TrackAnimator<TranslationTransformation<2, Float>>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP TrackAnimator<TranslationTransformation<3, Float>>;
 #endif
 
 }}
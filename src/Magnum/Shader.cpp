@@ -748,13 +748,16 @@ Shader& Shader::addFile(const std::string& filename) {
 }
 
 bool Shader::compile(std::initializer_list<std::reference_wrapper<Shader>> shaders) {
-    bool allSuccess = true;
+    submitCompile(shaders);
+    return checkCompile(shaders);
+}
 
+void Shader::submitCompile(std::initializer_list<std::reference_wrapper<Shader>> shaders) {
     /* Allocate large enough array for source pointers and sizes (to avoid
        reallocating it for each of them) */
     std::size_t maxSourceCount = 0;
     for(Shader& shader: shaders) {
-        CORRADE_ASSERT(shader._sources.size() > 1, "Shader::compile(): no files added", false);
+        CORRADE_ASSERT(shader._sources.size() > 1, "Shader::compile(): no files added", );
         maxSourceCount = std::max(shader._sources.size(), maxSourceCount);
     }
     /** @todo ArrayTuple/VLAs */
@@ -773,6 +776,10 @@ bool Shader::compile(std::initializer_list<std::reference_wrapper<Shader>> shade
 
     /* Invoke (possibly parallel) compilation on all shaders */
     for(Shader& shader: shaders) glCompileShader(shader._id);
+}
+
+bool Shader::checkCompile(std::initializer_list<std::reference_wrapper<Shader>> shaders) {
+    bool allSuccess = true;
 
     /* After compilation phase, check status of all shaders */
     Int i = 1;
@@ -811,6 +818,19 @@ bool Shader::compile(std::initializer_list<std::reference_wrapper<Shader>> shade
     return allSuccess;
 }
 
+bool Shader::isCompileFinished() {
+    #ifndef MAGNUM_TARGET_WEBGL
+    if(!Context::current().isExtensionSupported<Extensions::GL::KHR::parallel_shader_compile>())
+        return true;
+
+    GLint finished;
+    glGetShaderiv(_id, GL_COMPLETION_STATUS_KHR, &finished);
+    return finished == GL_TRUE;
+    #else
+    return true;
+    #endif
+}
+
 #ifndef DOXYGEN_GENERATING_OUTPUT
 Debug& operator<<(Debug& debug, const Shader::Type value) {
     switch(value) {
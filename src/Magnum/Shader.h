@@ -493,13 +493,42 @@ class MAGNUM_EXPORT Shader: public AbstractObject {
          * @cpp true @ce if everything succeeded. Compiler messages (if any)
          * are printed to error output. The operation is batched in a way that
          * allows the driver to perform multiple compilations simultaneously
-         * (i.e. in multiple threads).
+         * (i.e. in multiple threads). Equivalent to calling
+         * @ref submitCompile() followed by @ref checkCompile().
          * @see @fn_gl_keyword{ShaderSource}, @fn_gl_keyword{CompileShader},
          *      @fn_gl_keyword{GetShader} with @def_gl{COMPILE_STATUS} and
          *      @def_gl{INFO_LOG_LENGTH}, @fn_gl_keyword{GetShaderInfoLog}
          */
         static bool compile(std::initializer_list<std::reference_wrapper<Shader>> shaders);
 
+        /**
+         * @brief Submit shaders for compilation
+         *
+         * Uploads sources of all shaders and starts the compilation, but
+         * doesn't query compilation status, which would force the driver to
+         * wait until the compilation finishes. Poll @ref isCompileFinished()
+         * to check whether the compilation is done and call
+         * @ref checkCompile() afterwards. If the driver supports
+         * @extension{KHR,parallel_shader_compile}, the compilation is done
+         * in driver threads in the background.
+         * @see @ref AbstractShaderProgram-async,
+         *      @fn_gl_keyword{ShaderSource}, @fn_gl_keyword{CompileShader}
+         */
+        static void submitCompile(std::initializer_list<std::reference_wrapper<Shader>> shaders);
+
+        /**
+         * @brief Check compilation status
+         *
+         * Checks status of shaders previously submitted with
+         * @ref submitCompile() and prints compiler messages, if any.
+         * Returns @cpp false @ce if compilation of any shader failed,
+         * @cpp true @ce if everything succeeded. Blocks until the compilation
+         * is finished.
+         * @see @fn_gl_keyword{GetShader} with @def_gl{COMPILE_STATUS} and
+         *      @def_gl{INFO_LOG_LENGTH}, @fn_gl_keyword{GetShaderInfoLog}
+         */
+        static bool checkCompile(std::initializer_list<std::reference_wrapper<Shader>> shaders);
+
         /**
          * @brief Constructor
          * @param version   Target version
@@ -616,6 +645,17 @@ class MAGNUM_EXPORT Shader: public AbstractObject {
          */
         bool compile() { return compile({*this}); }
 
+        /**
+         * @brief Whether compilation is finished
+         *
+         * Doesn't block. If @extension{KHR,parallel_shader_compile} is not
+         * supported, the compilation is done synchronously and this function
+         * always returns @cpp true @ce.
+         * @see @ref submitCompile(), @fn_gl_keyword{GetShader} with
+         *      @def_gl_extension{COMPLETION_STATUS,KHR,parallel_shader_compile}
+         */
+        bool isCompileFinished();
+
     private:
         Shader& setLabelInternal(Containers::ArrayView<const char> label);
 
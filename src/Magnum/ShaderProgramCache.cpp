@@ -0,0 +1,85 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ShaderProgramCache.h"
+
+#include <cstring>
+#include <Corrade/Utility/Directory.h>
+#include <Corrade/Utility/Sha1.h>
+
+#include "Magnum/Context.h"
+#include "Magnum/Shader.h"
+
+namespace Magnum {
+
+ShaderProgramCache::ShaderProgramCache(std::string directory): _directory{std::move(directory)} {}
+
+std::string ShaderProgramCache::key(std::initializer_list<std::reference_wrapper<const Shader>> shaders) const {
+    const Context& context = Context::current();
+
+    /* Null characters separate the fields so different splits of the same
+       concatenated string don't produce the same hash */
+    Utility::Sha1 sha1;
+    sha1 << context.vendorString() << std::string(1, '\0')
+         << context.rendererString() << std::string(1, '\0')
+         << context.versionString() << std::string(1, '\0');
+    for(const Shader& shader: shaders) {
+        sha1 << std::to_string(GLenum(shader.type())) << std::string(1, '\0');
+        for(const std::string& source: shader.sources())
+            sha1 << source << std::string(1, '\0');
+    }
+
+    return sha1.digest().hexString();
+}
+
+std::pair<GLenum, Containers::Array<char>> ShaderProgramCache::load(const std::string& key) const {
+    const std::string filename = Utility::Directory::join(_directory, key);
+    if(!Utility::Directory::fileExists(filename)) return {};
+
+    /* The file is the format followed by the binary data */
+    Containers::Array<char> file = Utility::Directory::read(filename);
+    if(file.size() <= sizeof(UnsignedInt)) return {};
+
+    UnsignedInt format;
+    std::memcpy(&format, file, sizeof(UnsignedInt));
+    Containers::Array<char> data{file.size() - sizeof(UnsignedInt)};
+    std::memcpy(data, file + sizeof(UnsignedInt), data.size());
+    return {GLenum(format), std::move(data)};
+}
+
+bool ShaderProgramCache::save(const std::string& key, const GLenum format, const Containers::ArrayView<const void> data) const {
+    if(data.empty()) return false;
+
+    if(!Utility::Directory::fileExists(_directory) && !Utility::Directory::mkpath(_directory))
+        return false;
+
+    Containers::Array<char> file{sizeof(UnsignedInt) + data.size()};
+    const UnsignedInt formatValue = format;
+    std::memcpy(file, &formatValue, sizeof(UnsignedInt));
+    std::memcpy(file + sizeof(UnsignedInt), data.data(), data.size());
+    return Utility::Directory::write(Utility::Directory::join(_directory, key), Containers::ArrayView<const void>{file.data(), file.size()});
+}
+
+}
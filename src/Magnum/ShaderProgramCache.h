@@ -0,0 +1,121 @@
+#ifndef Magnum_ShaderProgramCache_h
+#define Magnum_ShaderProgramCache_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+/** @file
+ * @brief Class @ref Magnum::ShaderProgramCache
+ */
+#endif
+
+#include <functional>
+#include <string>
+#include <utility>
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/OpenGL.h"
+#include "Magnum/visibility.h"
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+namespace Magnum {
+
+/**
+@brief On-disk shader program binary cache
+
+Stores program binaries retrieved with @ref AbstractShaderProgram::binary()
+in a directory, keyed on a hash of shader sources and the driver
+identification, so subsequent application runs can skip compilation and
+linking completely:
+
+@snippet Magnum.cpp AbstractShaderProgram-binary
+
+The @ref key() includes @ref Context::vendorString(),
+@ref Context::rendererString() and @ref Context::versionString(), so the
+cached binaries are not used after a driver update. As the driver may still
+reject the binary at any time, always provide a fallback that compiles the
+program from sources.
+
+@requires_gl41 Extension @extension{ARB,get_program_binary}
+@requires_gles30 Extension @extension{OES,get_program_binary} is not
+    supported in OpenGL ES 2.0.
+@requires_gles Binary program representations are not supported in WebGL.
+*/
+class MAGNUM_EXPORT ShaderProgramCache {
+    public:
+        /**
+         * @brief Constructor
+         * @param directory     Directory where to store the binaries
+         *
+         * The directory is created on first @ref save(), if it doesn't
+         * exist.
+         */
+        explicit ShaderProgramCache(std::string directory);
+
+        /** @brief Cache directory */
+        std::string directory() const { return _directory; }
+
+        /**
+         * @brief Cache key for given shaders
+         *
+         * Hash of shader types, shader sources and the driver identification
+         * strings. Requires active context. Note that the key doesn't
+         * include state set before linking with
+         * @ref AbstractShaderProgram::bindAttributeLocation() and similar, so
+         * make sure it's the same for all programs made from the same
+         * sources.
+         */
+        std::string key(std::initializer_list<std::reference_wrapper<const Shader>> shaders) const;
+
+        /**
+         * @brief Load program binary
+         *
+         * Returns binary format and data for given @p key, suitable for
+         * @ref AbstractShaderProgram::setBinary(). If there's no such entry
+         * in the cache, returns an empty array.
+         */
+        std::pair<GLenum, Containers::Array<char>> load(const std::string& key) const;
+
+        /**
+         * @brief Save program binary
+         *
+         * Saves binary format and data retrieved using
+         * @ref AbstractShaderProgram::binary() under given @p key. Returns
+         * @cpp false @ce if @p data are empty or the file can't be written,
+         * @cpp true @ce otherwise.
+         */
+        bool save(const std::string& key, GLenum format, Containers::ArrayView<const void> data) const;
+
+    private:
+        std::string _directory;
+};
+
+}
+#else
+#error this header is not available in OpenGL ES 2.0 and WebGL build
+#endif
+
+#endif
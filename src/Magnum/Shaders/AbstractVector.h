@@ -57,6 +57,42 @@ template<UnsignedInt dimensions> class AbstractVector: public AbstractShaderProg
          */
         typedef typename Generic<dimensions>::TextureCoordinates TextureCoordinates;
 
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Per-instance glyph rectangle
+         *
+         * @ref Vector4 containing bottom left corner position in the XY
+         * components and size in the ZW components, sharing location with
+         * @ref Position. Used instead of @ref Position and
+         * @ref TextureCoordinates if the shader is created with the
+         * `InstancedGlyphs` flag. See @ref Text-Renderer-instanced for more
+         * information.
+         * @requires_gl33 Extension @extension{ARB,instanced_arrays} and
+         *      GLSL 1.30 for @glsl gl_VertexID @ce
+         * @requires_gles30 Neither instanced arrays nor
+         *      @glsl gl_VertexID @ce is available in OpenGL ES 2.0.
+         * @requires_webgl20 Neither instanced arrays nor
+         *      @glsl gl_VertexID @ce is available in WebGL 1.0.
+         */
+        typedef Attribute<Generic<dimensions>::Position::Location, Vector4> GlyphRectangle;
+
+        /**
+         * @brief Per-instance glyph texture rectangle
+         *
+         * @ref Vector4 containing bottom left texture coordinates in the XY
+         * components and top right texture coordinates in the ZW components,
+         * sharing location with @ref TextureCoordinates. Used if the shader
+         * is created with the `InstancedGlyphs` flag.
+         * @requires_gl33 Extension @extension{ARB,instanced_arrays} and
+         *      GLSL 1.30 for @glsl gl_VertexID @ce
+         * @requires_gles30 Neither instanced arrays nor
+         *      @glsl gl_VertexID @ce is available in OpenGL ES 2.0.
+         * @requires_webgl20 Neither instanced arrays nor
+         *      @glsl gl_VertexID @ce is available in WebGL 1.0.
+         */
+        typedef Attribute<Generic<dimensions>::TextureCoordinates::Location, Vector4> GlyphTextureRectangle;
+        #endif
+
         /**
          * @brief Bind vector texture
          * @return Reference to self (for method chaining)
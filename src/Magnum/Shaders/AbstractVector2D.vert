@@ -33,6 +33,7 @@ layout(location = 0)
 #endif
 uniform highp mat3 transformationProjectionMatrix;
 
+#ifndef INSTANCED_GLYPHS
 #ifdef EXPLICIT_ATTRIB_LOCATION
 layout(location = POSITION_ATTRIBUTE_LOCATION)
 #endif
@@ -42,10 +43,31 @@ in highp vec2 position;
 layout(location = TEXTURECOORDINATES_ATTRIBUTE_LOCATION)
 #endif
 in mediump vec2 textureCoordinates;
+#else
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = POSITION_ATTRIBUTE_LOCATION)
+#endif
+in highp vec4 glyphRectangle;
+
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = TEXTURECOORDINATES_ATTRIBUTE_LOCATION)
+#endif
+in mediump vec4 glyphTextureRectangle;
+#endif
 
 out mediump vec2 fragmentTextureCoordinates;
 
 void main() {
+    #ifndef INSTANCED_GLYPHS
     gl_Position.xywz = vec4(transformationProjectionMatrix*vec3(position, 1.0), 0.0);
     fragmentTextureCoordinates = textureCoordinates;
+    #else
+    /* Quad corner derived from vertex ID, in the same order as the
+       non-instanced quads drawn as a triangle strip: top left, bottom left,
+       top right, bottom right */
+    mediump vec2 corner = vec2(float(gl_VertexID >> 1), float(1 - (gl_VertexID & 1)));
+    highp vec2 position = glyphRectangle.xy + corner*glyphRectangle.zw;
+    gl_Position.xywz = vec4(transformationProjectionMatrix*vec3(position, 1.0), 0.0);
+    fragmentTextureCoordinates = mix(glyphTextureRectangle.xy, glyphTextureRectangle.zw, corner);
+    #endif
 }
@@ -69,7 +69,13 @@ out lowp vec4 fragmentColor;
 #endif
 
 void main() {
+    #ifndef MULTI_CHANNEL
     lowp float intensity = texture(vectorTexture, fragmentTextureCoordinates).r;
+    #else
+    /* Median of the three channels */
+    lowp vec3 channels = texture(vectorTexture, fragmentTextureCoordinates).rgb;
+    lowp float intensity = max(min(channels.r, channels.g), min(max(channels.r, channels.g), channels.b));
+    #endif
 
     /* Fill color */
     fragmentColor = smoothstep(outlineRange.x-smoothness, outlineRange.x+smoothness, intensity)*color;
@@ -29,6 +29,8 @@
  * @brief Class @ref Magnum::Shaders::DistanceFieldVector, typedef @ref Magnum::Shaders::DistanceFieldVector2D, @ref Magnum::Shaders::DistanceFieldVector3D
  */
 
+#include <Corrade/Containers/EnumSet.h>
+
 #include "Magnum/DimensionTraits.h"
 #include "Magnum/Math/Color.h"
 #include "Magnum/Math/Matrix3.h"
@@ -38,6 +40,16 @@
 
 namespace Magnum { namespace Shaders {
 
+namespace Implementation {
+    enum class DistanceFieldVectorFlag: UnsignedByte {
+        MultiChannel = 1 << 0,
+        #ifndef MAGNUM_TARGET_GLES2
+        InstancedGlyphs = 1 << 1
+        #endif
+    };
+    typedef Containers::EnumSet<DistanceFieldVectorFlag> DistanceFieldVectorFlags;
+}
+
 /**
 @brief Distance field vector shader
 
@@ -61,6 +73,24 @@ Common rendering setup:
 
 @snippet MagnumShaders.cpp DistanceFieldVector-usage2
 
+@section Shaders-DistanceFieldVector-multi-channel Multi-channel distance fields
+
+Single-channel distance fields round off sharp corners unless the source
+resolution is large. With @ref Flag::MultiChannel the shader takes a median of
+the red, green and blue channel of the texture instead of just the red one,
+which allows the corners to be reconstructed from a multi-channel distance
+field of a much smaller resolution. See @ref Text::MultiChannelDistanceFieldGlyphCache
+for a glyph cache providing such textures.
+
+@section Shaders-DistanceFieldVector-instanced-glyphs Instanced glyphs
+
+With @ref Flag::InstancedGlyphs the shader expects one compact
+@ref GlyphRectangle and @ref GlyphTextureRectangle record per glyph instead of
+four vertices and six indices and expands it to a quad using
+@glsl gl_VertexID @ce. Such meshes are produced by
+@ref Text::Renderer::renderInstanced() and @ref Text::InstancedRenderer, see
+@ref Text-Renderer-instanced for more information.
+
 @see @ref shaders, @ref DistanceFieldVector2D, @ref DistanceFieldVector3D
 @todo Use fragment shader derivations to have proper smoothness in perspective/
     large zoom levels, make it optional as it might have negative performance
@@ -68,7 +98,51 @@ Common rendering setup:
 */
 template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT DistanceFieldVector: public AbstractVector<dimensions> {
     public:
-        explicit DistanceFieldVector();
+        #ifdef DOXYGEN_GENERATING_OUTPUT
+        /**
+         * @brief Flag
+         *
+         * @see @ref Flags, @ref flags()
+         */
+        enum class Flag: UnsignedByte {
+            /**
+             * Treat the texture as a multi-channel distance field and use a
+             * median of its red, green and blue channel as the distance. See
+             * @ref Shaders-DistanceFieldVector-multi-channel for more
+             * information.
+             */
+            MultiChannel = 1 << 0,
+
+            /**
+             * Take glyph quads from per-instance @ref GlyphRectangle and
+             * @ref GlyphTextureRectangle attributes instead of per-vertex
+             * @ref Position and @ref TextureCoordinates. See
+             * @ref Shaders-DistanceFieldVector-instanced-glyphs for more
+             * information.
+             * @requires_gl33 Extension @extension{ARB,instanced_arrays} and
+             *      GLSL 1.30
+             * @requires_gles30 Not available in OpenGL ES 2.0.
+             * @requires_webgl20 Not available in WebGL 1.0.
+             */
+            InstancedGlyphs = 1 << 1
+        };
+
+        /**
+         * @brief Flags
+         *
+         * @see @ref flags()
+         */
+        typedef Containers::EnumSet<Flag> Flags;
+        #else
+        typedef Implementation::DistanceFieldVectorFlag Flag;
+        typedef Implementation::DistanceFieldVectorFlags Flags;
+        #endif
+
+        /**
+         * @brief Constructor
+         * @param flags     Flags
+         */
+        explicit DistanceFieldVector(Flags flags = {});
 
         /**
          * @brief Construct without creating the underlying OpenGL object
@@ -87,6 +161,9 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT DistanceFieldVector
             #endif
             {}
 
+        /** @brief Flags */
+        Flags flags() const { return _flags; }
+
         /**
          * @brief Set transformation and projection matrix
          * @return Reference to self (for method chaining)
@@ -164,6 +241,7 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT DistanceFieldVector
         #endif
 
     private:
+        Flags _flags;
         Int _transformationProjectionMatrixUniform{0},
             _colorUniform{1},
             _outlineColorUniform{2},
@@ -177,6 +255,8 @@ typedef DistanceFieldVector<2> DistanceFieldVector2D;
 /** @brief Three-dimensional distance field vector shader */
 typedef DistanceFieldVector<3> DistanceFieldVector3D;
 
+CORRADE_ENUMSET_OPERATORS(Implementation::DistanceFieldVectorFlags)
+
 }}
 
 #endif
@@ -0,0 +1,113 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "DrawCulling.h"
+
+#include <Corrade/Utility/Resource.h>
+
+#include "Magnum/Buffer.h"
+#include "Magnum/Renderer.h"
+#include "Magnum/Shader.h"
+#include "Magnum/Texture.h"
+
+#include "Implementation/CreateCompatibilityShader.h"
+
+namespace Magnum { namespace Shaders {
+
+namespace {
+    enum: Int { DepthPyramidTextureLayer = 0 };
+
+    enum: Int {
+        ViewportSizeUniform = 2,
+        DrawableCountUniform = 1
+    };
+}
+
+DrawCulling::DrawCulling(const Flags flags): _flags{flags} {
+    #ifdef MAGNUM_BUILD_STATIC
+    /* Import resources on static build, if not already */
+    if(!Utility::Resource::hasGroup("MagnumShaders"))
+        importShaderResources();
+    #endif
+    Utility::Resource rs("MagnumShaders");
+
+    Shader comp = Implementation::createCompatibilityShader(rs, Version::GL430, Shader::Type::Compute);
+    comp.addSource(flags & Flag::HierarchicalZ ? "#define HIERARCHICAL_Z\n" : "")
+        .addSource(flags & Flag::NonIndexed ? "#define NON_INDEXED\n" : "")
+        .addSource(rs.get("DrawCulling.comp"));
+
+    CORRADE_INTERNAL_ASSERT_OUTPUT(comp.compile());
+
+    attachShader(comp);
+
+    CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+
+    /* Default uniform values */
+    setViewProjectionMatrix({});
+}
+
+DrawCulling& DrawCulling::setViewportSize(const Vector2i& size) {
+    CORRADE_ASSERT(_flags & Flag::HierarchicalZ,
+        "Shaders::DrawCulling::setViewportSize(): the shader was not created with hierarchical Z enabled", *this);
+    setUniform(ViewportSizeUniform, size);
+    return *this;
+}
+
+DrawCulling& DrawCulling::bindDepthPyramid(Texture2D& texture) {
+    CORRADE_ASSERT(_flags & Flag::HierarchicalZ,
+        "Shaders::DrawCulling::bindDepthPyramid(): the shader was not created with hierarchical Z enabled", *this);
+    texture.bind(DepthPyramidTextureLayer);
+    return *this;
+}
+
+DrawCulling& DrawCulling::bindDrawableBuffer(Buffer& buffer) {
+    buffer.bind(Buffer::Target::ShaderStorage, DrawableBufferBinding);
+    return *this;
+}
+
+DrawCulling& DrawCulling::bindCommandBuffer(Buffer& buffer) {
+    buffer.bind(Buffer::Target::ShaderStorage, CommandBufferBinding);
+    return *this;
+}
+
+DrawCulling& DrawCulling::bindOutputCommandBuffer(Buffer& buffer) {
+    buffer.bind(Buffer::Target::ShaderStorage, OutputCommandBufferBinding);
+    return *this;
+}
+
+DrawCulling& DrawCulling::bindDrawCountBuffer(Buffer& buffer) {
+    buffer.bind(Buffer::Target::ShaderStorage, DrawCountBufferBinding);
+    return *this;
+}
+
+void DrawCulling::cull(const UnsignedInt drawableCount) {
+    if(!drawableCount) return;
+
+    setUniform(DrawableCountUniform, drawableCount);
+    dispatchCompute({(drawableCount + 63)/64, 1, 1});
+    Renderer::setMemoryBarrier(Renderer::MemoryBarrier::Command);
+}
+
+}}
@@ -0,0 +1,304 @@
+#ifndef Magnum_Shaders_DrawCulling_h
+#define Magnum_Shaders_DrawCulling_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#ifndef MAGNUM_TARGET_GLES
+/** @file
+ * @brief Class @ref Magnum::Shaders::DrawCulling, struct @ref Magnum::Shaders::DrawCullingDrawable
+ */
+#endif
+
+#include <Corrade/Containers/EnumSet.h>
+
+#include "Magnum/AbstractShaderProgram.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/Shaders/visibility.h"
+
+#ifndef MAGNUM_TARGET_GLES
+namespace Magnum { namespace Shaders {
+
+/**
+@brief Drawable for the GPU culling shader
+
+Layout of one drawable in the drawable buffer of @ref DrawCulling, matching
+the @glsl std430 @ce layout of the @glsl Drawables @ce shader storage block.
+@requires_gl43 Extension @extension{ARB,compute_shader} and
+    @extension{ARB,shader_storage_buffer_object}
+@requires_gl Compute culling is available only on desktop OpenGL, as it's
+    meant to be consumed by multi-draw indirect.
+*/
+struct DrawCullingDrawable {
+    /**
+     * @brief Default constructor
+     *
+     * Identity transformation, empty bounds, first command and first
+     * instance.
+     */
+    constexpr /*implicit*/ DrawCullingDrawable() noexcept: command{}, instance{} {}
+
+    /** @brief Constructor */
+    constexpr explicit DrawCullingDrawable(const Matrix4& transformation, const Range3D& bounds, UnsignedInt command, UnsignedInt instance) noexcept: transformation{transformation}, boundsMin{bounds.min()}, command{command}, boundsMax{bounds.max()}, instance{instance} {}
+
+    /** @brief Absolute transformation of the drawable */
+    Matrix4 transformation;
+
+    /** @brief Minimal corner of the bounding box in drawable local space */
+    Vector3 boundsMin;
+
+    /** @brief Index of the draw command in the command buffer */
+    UnsignedInt command;
+
+    /** @brief Maximal corner of the bounding box in drawable local space */
+    Vector3 boundsMax;
+
+    /**
+     * @brief Instance
+     *
+     * Written to the base instance of the output command, so the vertex
+     * shader can fetch per-drawable data using per-instance attributes or
+     * @glsl gl_BaseInstance @ce.
+     */
+    UnsignedInt instance;
+};
+
+static_assert(sizeof(DrawCullingDrawable) == 96, "Improper size of DrawCullingDrawable");
+
+/**
+@brief GPU culling shader
+
+Compute shader that frustum-culls a buffer of @ref DrawCullingDrawable
+structures against the camera and writes draw commands of the visible ones
+into a compacted buffer, together with a draw count. The result can be passed
+directly to @ref Mesh::drawIndirect(AbstractShaderProgram&, Buffer&, GLintptr, Buffer&, GLintptr, Int, GLsizei),
+so the per-drawable work is done entirely on the GPU and the CPU only has to
+upload the drawables once for static geometry.
+
+Each drawable references a draw command in the command buffer, which can be
+shared among many drawables using the same mesh. The command is copied into
+the output with its base instance replaced by @ref DrawCullingDrawable::instance,
+so the vertex shader knows which drawable it's drawing. The commands are
+five @ref UnsignedInt values for indexed meshes or four values with
+@ref Flag::NonIndexed, as described in
+@ref Mesh::drawIndirect(AbstractShaderProgram&, Buffer&, GLintptr). Order of
+the output commands is not defined.
+
+With @ref Flag::HierarchicalZ the drawables are additionally tested against a
+depth pyramid, usually built from the depth buffer of the previous frame with
+@ref TextureTools::DepthPyramid using @ref TextureTools::DepthPyramid::Reduction::Max.
+A drawable is culled if the nearest point of its
+bounding box is behind the farthest depth in the screen area it covers. The
+draw count buffer has to be zeroed before each @ref cull() call:
+
+@code{.cpp}
+Shaders::DrawCulling culling{Shaders::DrawCulling::Flag::HierarchicalZ};
+Buffer drawables, commands, outputCommands, drawCount;
+// fill drawables and commands, allocate outputCommands for all drawables ...
+
+drawCount.setData(std::vector<UnsignedInt>{0}, BufferUsage::StreamDraw);
+culling.setViewProjectionMatrix(camera->projectionMatrix()*camera->cameraMatrix())
+    .setViewportSize(defaultFramebuffer.viewport().size())
+    .bindDepthPyramid(depthPyramid.texture())
+    .bindDrawableBuffer(drawables)
+    .bindCommandBuffer(commands)
+    .bindOutputCommandBuffer(outputCommands)
+    .bindDrawCountBuffer(drawCount)
+    .cull(drawableCount);
+
+mesh.drawIndirect(shader, outputCommands, 0, drawCount, 0, drawableCount);
+@endcode
+
+The test is conservative --- a drawable may be drawn even if it's not visible,
+but it's never culled if any part of its bounding box is visible. Boxes
+crossing the camera plane are never culled by the depth test.
+
+@requires_gl43 Extension @extension{ARB,compute_shader} and
+    @extension{ARB,shader_storage_buffer_object}
+@requires_gl Compute culling is available only on desktop OpenGL, as it's
+    meant to be consumed by multi-draw indirect.
+*/
+class MAGNUM_SHADERS_EXPORT DrawCulling: public AbstractShaderProgram {
+    public:
+        /**
+         * @brief Flag
+         *
+         * @see @ref Flags, @ref flags()
+         */
+        enum class Flag: UnsignedByte {
+            /**
+             * Cull also drawables occluded in a depth pyramid bound using
+             * @ref bindDepthPyramid()
+             */
+            HierarchicalZ = 1 << 0,
+
+            /** Produce four-value commands for non-indexed meshes */
+            NonIndexed = 1 << 1
+        };
+
+        /**
+         * @brief Flags
+         *
+         * @see @ref flags()
+         */
+        typedef Containers::EnumSet<Flag> Flags;
+
+        enum: UnsignedInt {
+            /**
+             * Shader storage binding for the @glsl Drawables @ce block
+             * @see @ref bindDrawableBuffer()
+             */
+            DrawableBufferBinding = 0,
+
+            /**
+             * Shader storage binding for the @glsl Commands @ce block
+             * @see @ref bindCommandBuffer()
+             */
+            CommandBufferBinding = 1,
+
+            /**
+             * Shader storage binding for the @glsl OutputCommands @ce block
+             * @see @ref bindOutputCommandBuffer()
+             */
+            OutputCommandBufferBinding = 2,
+
+            /**
+             * Shader storage binding for the @glsl DrawCount @ce block
+             * @see @ref bindDrawCountBuffer()
+             */
+            DrawCountBufferBinding = 3
+        };
+
+        /**
+         * @brief Constructor
+         * @param flags     Flags
+         */
+        explicit DrawCulling(Flags flags = {});
+
+        /**
+         * @brief Construct without creating the underlying OpenGL object
+         *
+         * The constructed instance is equivalent to moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         *
+         * This function can be safely used for constructing (and later
+         * destructing) objects even without any OpenGL context being active.
+         */
+        explicit DrawCulling(NoCreateT) noexcept: AbstractShaderProgram{NoCreate} {}
+
+        /** @brief Flags */
+        Flags flags() const { return _flags; }
+
+        /**
+         * @brief Set view projection matrix
+         * @return Reference to self (for method chaining)
+         *
+         * Projection matrix multiplied with the camera matrix. Initial value
+         * is an identity matrix.
+         */
+        DrawCulling& setViewProjectionMatrix(const Matrix4& matrix) {
+            setUniform(0, matrix);
+            return *this;
+        }
+
+        /**
+         * @brief Set viewport size
+         * @return Reference to self (for method chaining)
+         *
+         * Size of level zero of the depth pyramid. Expects that
+         * @ref Flag::HierarchicalZ is set.
+         */
+        DrawCulling& setViewportSize(const Vector2i& size);
+
+        /**
+         * @brief Bind depth pyramid
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @ref Flag::HierarchicalZ is set. The texture is
+         * expected to have a full mip chain with farthest depth of each 2x2
+         * block in the next level, such as the one produced by
+         * @ref TextureTools::DepthPyramid.
+         */
+        DrawCulling& bindDepthPyramid(Texture2D& texture);
+
+        /**
+         * @brief Bind drawable buffer
+         * @return Reference to self (for method chaining)
+         *
+         * Buffer with @ref DrawCullingDrawable structures.
+         */
+        DrawCulling& bindDrawableBuffer(Buffer& buffer);
+
+        /**
+         * @brief Bind command buffer
+         * @return Reference to self (for method chaining)
+         *
+         * Buffer with tightly packed draw commands referenced by
+         * @ref DrawCullingDrawable::command.
+         */
+        DrawCulling& bindCommandBuffer(Buffer& buffer);
+
+        /**
+         * @brief Bind output command buffer
+         * @return Reference to self (for method chaining)
+         *
+         * Has to be large enough to contain a command for every drawable.
+         */
+        DrawCulling& bindOutputCommandBuffer(Buffer& buffer);
+
+        /**
+         * @brief Bind draw count buffer
+         * @return Reference to self (for method chaining)
+         *
+         * Has to contain a single zero @ref UnsignedInt before calling
+         * @ref cull(), the count of visible drawables is then atomically
+         * added to it.
+         */
+        DrawCulling& bindDrawCountBuffer(Buffer& buffer);
+
+        /**
+         * @brief Cull the drawables
+         *
+         * Dispatches the compute shader for first @p drawableCount drawables
+         * and puts a @ref Renderer::MemoryBarrier::Command barrier after it,
+         * so the output can be immediately used for indirect drawing.
+         * @see @ref dispatchCompute()
+         */
+        void cull(UnsignedInt drawableCount);
+
+    private:
+        Flags _flags;
+};
+
+CORRADE_ENUMSET_OPERATORS(DrawCulling::Flags)
+
+}}
+#else
+#error this header is available only in desktop OpenGL build
+#endif
+
+#endif
@@ -27,6 +27,7 @@
 
 #include <Corrade/Utility/Resource.h>
 
+#include "Magnum/Buffer.h"
 #include "Magnum/Context.h"
 #include "Magnum/Extensions.h"
 #include "Magnum/Shader.h"
@@ -45,6 +46,11 @@ namespace {
 }
 
 template<UnsignedInt dimensions> Flat<dimensions>::Flat(const Flags flags): _flags(flags) {
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    CORRADE_ASSERT(!(flags & Flag::UniformBuffers) || !(flags & Flag::ShaderStorageBuffers),
+        "Shaders::Flat: uniform buffers and shader storage buffers are mutually exclusive", );
+    #endif
+
     #ifdef MAGNUM_BUILD_STATIC
     /* Import resources on static build, if not already */
     if(!Utility::Resource::hasGroup("MagnumShaders"))
@@ -53,7 +59,18 @@ template<UnsignedInt dimensions> Flat<dimensions>::Flat(const Flags flags): _fla
     Utility::Resource rs("MagnumShaders");
 
     #ifndef MAGNUM_TARGET_GLES
-    const Version version = Context::current().supportedVersion({Version::GL320, Version::GL310, Version::GL300, Version::GL210});
+    /* Uniform blocks need GLSL 1.40, shader storage blocks GLSL 4.30 */
+    const Version version = flags & Flag::ShaderStorageBuffers ? Version::GL430 :
+        flags & Flag::UniformBuffers ?
+        Context::current().supportedVersion({Version::GL320, Version::GL310}) :
+        Context::current().supportedVersion({Version::GL320, Version::GL310, Version::GL300, Version::GL210});
+    #elif !defined(MAGNUM_TARGET_GLES2)
+    const Version version =
+        #ifndef MAGNUM_TARGET_WEBGL
+        flags & Flag::ShaderStorageBuffers ? Version::GLES310 :
+        #endif
+        flags & Flag::UniformBuffers ? Version::GLES300 :
+        Context::current().supportedVersion({Version::GLES300, Version::GLES200});
     #else
     const Version version = Context::current().supportedVersion({Version::GLES300, Version::GLES200});
     #endif
@@ -62,10 +79,28 @@ template<UnsignedInt dimensions> Flat<dimensions>::Flat(const Flags flags): _fla
     Shader frag = Implementation::createCompatibilityShader(rs, version, Shader::Type::Fragment);
 
     vert.addSource(flags & Flag::Textured ? "#define TEXTURED\n" : "")
-        .addSource(rs.get("generic.glsl"))
-        .addSource(rs.get(vertexShaderName<dimensions>()));
+        .addSource(flags & Flag::InstancedTransformation ? "#define INSTANCED_TRANSFORMATION\n" : "")
+        .addSource(flags & Flag::InstancedColor ? "#define INSTANCED_COLOR\n" : "");
     frag.addSource(flags & Flag::Textured ? "#define TEXTURED\n" : "")
-        .addSource(rs.get("Flat.frag"));
+        .addSource(flags & Flag::InstancedColor ? "#define INSTANCED_COLOR\n" : "")
+        .addSource(flags & Flag::AlphaMask ? "#define ALPHA_MASK\n" : "")
+        .addSource(flags & Flag::DepthOnly ? "#define DEPTH_ONLY\n" : "");
+    #ifndef MAGNUM_TARGET_GLES2
+    if(flags & Flag::UniformBuffers) {
+        vert.addSource("#define UNIFORM_BUFFERS\n");
+        frag.addSource("#define UNIFORM_BUFFERS\n")
+            .addSource(dimensions == 2 ? "#define TWO_DIMENSIONS\n" : "");
+    }
+    #endif
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    if(flags & Flag::ShaderStorageBuffers) {
+        vert.addSource("#define SHADER_STORAGE_BUFFERS\n");
+        frag.addSource("#define SHADER_STORAGE_BUFFERS\n");
+    }
+    #endif
+    vert.addSource(rs.get("generic.glsl"))
+        .addSource(rs.get(vertexShaderName<dimensions>()));
+    frag.addSource(rs.get("Flat.frag"));
 
     CORRADE_INTERNAL_ASSERT_OUTPUT(Shader::compile({vert, frag}));
 
@@ -79,29 +114,68 @@ template<UnsignedInt dimensions> Flat<dimensions>::Flat(const Flags flags): _fla
     {
         bindAttributeLocation(Position::Location, "position");
         if(flags & Flag::Textured) bindAttributeLocation(TextureCoordinates::Location, "textureCoordinates");
+        if(flags & Flag::InstancedTransformation) bindAttributeLocation(TransformationMatrix::Location, "instancedTransformationMatrix");
+        if(flags & Flag::InstancedColor) bindAttributeLocation(Color::Location, "instancedColor");
     }
 
     CORRADE_INTERNAL_ASSERT_OUTPUT(link());
 
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    if(!(flags & (Flag::UniformBuffers|Flag::ShaderStorageBuffers)))
+    #elif !defined(MAGNUM_TARGET_GLES2)
+    if(!(flags & Flag::UniformBuffers))
+    #endif
+    {
+        #ifndef MAGNUM_TARGET_GLES
+        if(!Context::current().isExtensionSupported<Extensions::GL::ARB::explicit_uniform_location>(version))
+        #endif
+        {
+            _transformationProjectionMatrixUniform = uniformLocation("transformationProjectionMatrix");
+            if(!(flags & Flag::DepthOnly) || flags & Flag::AlphaMask)
+                _colorUniform = uniformLocation("color");
+        }
+    }
+
+    /* The depth-only variant without alpha mask doesn't use the color, make
+       the setter no-op. GL ignores uniform location -1. */
+    if(flags & Flag::DepthOnly && !(flags & Flag::AlphaMask))
+        _colorUniform = -1;
+
     #ifndef MAGNUM_TARGET_GLES
     if(!Context::current().isExtensionSupported<Extensions::GL::ARB::explicit_uniform_location>(version))
     #endif
     {
-        _transformationProjectionMatrixUniform = uniformLocation("transformationProjectionMatrix");
-        _colorUniform = uniformLocation("color");
+        if(flags & Flag::AlphaMask) _alphaMaskUniform = uniformLocation("alphaMask");
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        if(flags & Flag::ShaderStorageBuffers) _drawOffsetUniform = uniformLocation("drawOffset");
+        #endif
     }
 
     #ifndef MAGNUM_TARGET_GLES
     if(!Context::current().isExtensionSupported<Extensions::GL::ARB::shading_language_420pack>(version))
     #endif
     {
-        if(flags & Flag::Textured) setUniform(uniformLocation("textureData"), TextureLayer);
+        if(flags & Flag::Textured && (!(flags & Flag::DepthOnly) || flags & Flag::AlphaMask))
+            setUniform(uniformLocation("textureData"), TextureLayer);
+        #ifndef MAGNUM_TARGET_GLES2
+        if(flags & Flag::UniformBuffers) setUniformBlockBinding(uniformBlockIndex("FlatDraw"), DrawBufferBinding);
+        #endif
     }
 
-    /* Set defaults in OpenGL ES (for desktop they are set in shader code itself) */
+    /* Set defaults in OpenGL ES (for desktop they are set in shader code
+       itself). With uniform buffers the defaults come from the buffer. */
     #ifdef MAGNUM_TARGET_GLES
-    /* Default to fully opaque white so we can see the texture */
-    if(flags & Flag::Textured) setColor(Color4(1.0f));
+    /* Default to fully opaque white so we can see the texture and instance
+       colors */
+    if(flags & (Flag::Textured|Flag::InstancedColor)
+        #ifndef MAGNUM_TARGET_GLES2
+        && !(flags & Flag::UniformBuffers)
+        #endif
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        && !(flags & Flag::ShaderStorageBuffers)
+        #endif
+    ) setColor(Color4(1.0f));
+    if(flags & Flag::AlphaMask) setAlphaMask(0.5f);
     #endif
 }
 
@@ -110,6 +184,52 @@ template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::bindTexture
     return *this;
 }
 
+template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::setAlphaMask(const Float mask) {
+    CORRADE_ASSERT(_flags & Flag::AlphaMask,
+        "Shaders::Flat::setAlphaMask(): the shader was not created with alpha mask enabled", *this);
+    setUniform(_alphaMaskUniform, mask);
+    return *this;
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::bindDrawBuffer(Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags & Flag::UniformBuffers,
+        "Shaders::Flat::bindDrawBuffer(): the shader was not created with uniform buffers enabled", *this);
+    buffer.bind(Buffer::Target::Uniform, DrawBufferBinding, offset, size);
+    return *this;
+}
+
+template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::bindDrawBuffer(Buffer& buffer) {
+    CORRADE_ASSERT(_flags & Flag::UniformBuffers,
+        "Shaders::Flat::bindDrawBuffer(): the shader was not created with uniform buffers enabled", *this);
+    buffer.bind(Buffer::Target::Uniform, DrawBufferBinding);
+    return *this;
+}
+#endif
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::setDrawOffset(const UnsignedInt offset) {
+    CORRADE_ASSERT(_flags & Flag::ShaderStorageBuffers,
+        "Shaders::Flat::setDrawOffset(): the shader was not created with shader storage buffers enabled", *this);
+    setUniform(_drawOffsetUniform, offset);
+    return *this;
+}
+
+template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::bindDrawStorageBuffer(Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags & Flag::ShaderStorageBuffers,
+        "Shaders::Flat::bindDrawStorageBuffer(): the shader was not created with shader storage buffers enabled", *this);
+    buffer.bind(Buffer::Target::ShaderStorage, DrawStorageBufferBinding, offset, size);
+    return *this;
+}
+
+template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::bindDrawStorageBuffer(Buffer& buffer) {
+    CORRADE_ASSERT(_flags & Flag::ShaderStorageBuffers,
+        "Shaders::Flat::bindDrawStorageBuffer(): the shader was not created with shader storage buffers enabled", *this);
+    buffer.bind(Buffer::Target::ShaderStorage, DrawStorageBufferBinding);
+    return *this;
+}
+#endif
+
 template class Flat<2>;
 template class Flat<3>;
 
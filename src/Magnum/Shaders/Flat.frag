@@ -36,27 +36,73 @@ layout(binding = 0)
 uniform lowp sampler2D textureData;
 #endif
 
+#if !defined(UNIFORM_BUFFERS) && !defined(SHADER_STORAGE_BUFFERS)
 #ifdef EXPLICIT_UNIFORM_LOCATION
 layout(location = 1)
 #endif
 uniform lowp vec4 color
-    #if !defined(GL_ES) && defined(TEXTURED)
+    #if !defined(GL_ES) && (defined(TEXTURED) || defined(INSTANCED_COLOR))
     = vec4(1.0)
     #endif
     ;
+#elif defined(SHADER_STORAGE_BUFFERS)
+/* Read from the shader storage buffer in the vertex shader */
+flat in lowp vec4 color;
+#else
+/* Has to match the block in the vertex shader */
+#ifdef EXPLICIT_BINDING
+layout(std140, binding = 0)
+#else
+layout(std140)
+#endif
+uniform FlatDraw {
+    #ifdef TWO_DIMENSIONS
+    highp mat3 transformationProjectionMatrix;
+    #else
+    highp mat4 transformationProjectionMatrix;
+    #endif
+    lowp vec4 color;
+};
+#endif
+
+#ifdef ALPHA_MASK
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 2)
+#endif
+uniform lowp float alphaMask
+    #ifndef GL_ES
+    = 0.5
+    #endif
+    ;
+#endif
 
 #ifdef TEXTURED
 in mediump vec2 interpolatedTextureCoordinates;
 #endif
 
-#ifdef NEW_GLSL
+#ifdef INSTANCED_COLOR
+in lowp vec4 interpolatedInstancedColor;
+#endif
+
+#if defined(NEW_GLSL) && !defined(DEPTH_ONLY)
 out lowp vec4 fragmentColor;
 #endif
 
 void main() {
-    fragmentColor =
+    lowp vec4 finalColor =
         #ifdef TEXTURED
         texture(textureData, interpolatedTextureCoordinates)*
         #endif
+        #ifdef INSTANCED_COLOR
+        interpolatedInstancedColor*
+        #endif
         color;
+
+    #ifdef ALPHA_MASK
+    if(finalColor.a < alphaMask) discard;
+    #endif
+
+    #ifndef DEPTH_ONLY
+    fragmentColor = finalColor;
+    #endif
 }
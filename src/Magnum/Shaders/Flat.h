@@ -26,24 +26,104 @@
 */
 
 /** @file
- * @brief Class @ref Magnum::Shaders::Flat, typedef @ref Magnum::Shaders::Flat2D, @ref Magnum::Shaders::Flat3D
+ * @brief Class @ref Magnum::Shaders::Flat, @ref Magnum::Shaders::FlatDrawUniform, typedef @ref Magnum::Shaders::Flat2D, @ref Magnum::Shaders::Flat3D, @ref Magnum::Shaders::FlatDrawUniform2D, @ref Magnum::Shaders::FlatDrawUniform3D
  */
 
+#include <Corrade/Utility/Assert.h>
+
 #include "Magnum/AbstractShaderProgram.h"
 #include "Magnum/DimensionTraits.h"
 #include "Magnum/Math/Color.h"
 #include "Magnum/Math/Matrix3.h"
 #include "Magnum/Math/Matrix4.h"
+#include "Magnum/Std140.h"
 #include "Magnum/Shaders/Generic.h"
 #include "Magnum/Shaders/visibility.h"
 
 namespace Magnum { namespace Shaders {
 
 namespace Implementation {
-    enum class FlatFlag: UnsignedByte { Textured = 1 << 0 };
+    enum class FlatFlag: UnsignedByte {
+        Textured = 1 << 0,
+        #ifndef MAGNUM_TARGET_GLES2
+        UniformBuffers = 1 << 1,
+        #endif
+        InstancedTransformation = 1 << 2,
+        InstancedColor = 1 << 3,
+        AlphaMask = 1 << 4,
+        DepthOnly = 1 << 5,
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        ShaderStorageBuffers = 1 << 6
+        #endif
+    };
     typedef Containers::EnumSet<FlatFlag> FlatFlags;
+
+    template<UnsignedInt> struct FlatDrawUniformMatrix;
+    template<> struct FlatDrawUniformMatrix<2> { typedef Std140::Matrix3 Type; };
+    template<> struct FlatDrawUniformMatrix<3> { typedef Matrix4 Type; };
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+/**
+@brief Per-draw uniform block of the flat shader
+
+Layout of the @glsl FlatDraw @ce uniform block used by @ref Flat with
+@ref Flat::Flag::UniformBuffers enabled. The structure is laid out according
+to std140 rules, so an array of these can be directly uploaded to a uniform
+buffer, leaving gaps between the items as needed by
+@ref Buffer::uniformOffsetAlignment(). See
+@ref Shaders-Flat-uniform-buffers for an example.
+
+The layout is the same in a @glsl std430 @ce block, so the structure is also
+an element of the @glsl FlatDraws @ce shader storage buffer used with
+@ref Flat::Flag::ShaderStorageBuffers. There the items are tightly packed
+with no gaps, see @ref Shaders-Flat-shader-storage-buffers.
+@see @ref FlatDrawUniform2D, @ref FlatDrawUniform3D, @ref Std140::alignedStride()
+@requires_gl31 Extension @extension{ARB,uniform_buffer_object}
+@requires_gles30 Uniform buffers are not available in OpenGL ES 2.0.
+@requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+*/
+template<UnsignedInt dimensions> struct FlatDrawUniform {
+    /**
+     * @brief Default constructor
+     *
+     * Sets the matrix to identity and color to fully opaque white.
+     */
+    constexpr /*implicit*/ FlatDrawUniform() noexcept: transformationProjectionMatrix{MatrixTypeFor<dimensions, Float>{}}, color{1.0f} {}
+
+    /** @brief Constructor */
+    constexpr explicit FlatDrawUniform(const MatrixTypeFor<dimensions, Float>& transformationProjectionMatrix, const Color4& color = Color4{1.0f}) noexcept: transformationProjectionMatrix{transformationProjectionMatrix}, color{color} {}
+
+    /**
+     * @brief Transformation and projection matrix
+     *
+     * @ref Std140::Matrix3 in 2D, @ref Magnum::Matrix4 "Matrix4" in 3D.
+     * @see @ref Flat::setTransformationProjectionMatrix()
+     */
+    #ifdef DOXYGEN_GENERATING_OUTPUT
+    T transformationProjectionMatrix;
+    #else
+    typename Implementation::FlatDrawUniformMatrix<dimensions>::Type transformationProjectionMatrix;
+    #endif
+
+    /**
+     * @brief Color
+     *
+     * @see @ref Flat::setColor()
+     */
+    Color4 color;
+};
+
+/** @brief 2D flat shader per-draw uniform block */
+typedef FlatDrawUniform<2> FlatDrawUniform2D;
+
+/** @brief 3D flat shader per-draw uniform block */
+typedef FlatDrawUniform<3> FlatDrawUniform3D;
+
+static_assert(sizeof(FlatDrawUniform2D) == 64, "Improper size of FlatDrawUniform2D");
+static_assert(sizeof(FlatDrawUniform3D) == 80, "Improper size of FlatDrawUniform3D");
+#endif
+
 /**
 @brief Flat shader
 
@@ -83,6 +163,79 @@ Common rendering setup:
 
 @snippet MagnumShaders.cpp Flat-usage-textured2
 
+@subsection Shaders-Flat-uniform-buffers Uniform buffers
+
+With many draws per frame, setting the uniforms one by one becomes a
+bottleneck. If the shader is created with @ref Flag::UniformBuffers, the
+transformation and color are read from the @glsl FlatDraw @ce uniform block
+instead. Data for all draws can be then uploaded into a single buffer, laid
+out as @ref FlatDrawUniform structures, and each draw needs just a single
+@ref bindDrawBuffer() call selecting the range:
+
+@snippet MagnumShaders.cpp Flat-usage-uniform-buffers
+
+@subsection Shaders-Flat-shader-storage-buffers Shader storage buffers
+
+Uniform buffer ranges are limited to @ref AbstractShaderProgram::maxUniformBlockSize(),
+which is only guaranteed to be 16 kB. With @ref Flag::ShaderStorageBuffers the
+shader reads the @ref FlatDrawUniform structures from the @glsl FlatDraws @ce
+shader storage buffer instead, which has no practical size limit, so data for
+all draws in a frame can be uploaded with a single write --- for example into
+a persistently mapped @ref StreamingBuffer --- and bound once with
+@ref bindDrawStorageBuffer(). The items are tightly packed. Each draw then
+only selects its item with @ref setDrawOffset(), and each instance of an
+instanced draw reads the item following the previous one, so the buffer can
+hold also arbitrarily large instance arrays:
+
+@code{.cpp}
+std::vector<Shaders::Flat3D::DrawUniform> draws;
+for(const Object& object: objects)
+    draws.emplace_back(projection*object.transformation(), object.color());
+
+Buffer buffer{Buffer::TargetHint::ShaderStorage};
+buffer.setData(draws, BufferUsage::StreamDraw);
+
+Shaders::Flat3D shader{Shaders::Flat3D::Flag::ShaderStorageBuffers};
+shader.bindDrawStorageBuffer(buffer);
+for(std::size_t i = 0; i != objects.size(); ++i) {
+    shader.setDrawOffset(i);
+    objects[i].mesh().draw(shader);
+}
+@endcode
+
+The color is read in the vertex shader and passed to the fragment shader,
+which thus doesn't need shader storage buffer support. OpenGL ES 3.1 however
+doesn't require vertex shaders to support shader storage blocks either, check
+@ref Shader::maxShaderStorageBlocks() for @ref Shader::Type::Vertex before
+using this flag there.
+
+@subsection Shaders-Flat-instancing Instanced drawing
+
+Many copies of the same mesh can be drawn with a single
+@ref Mesh::draw() call by enabling @ref Flag::InstancedTransformation and/or
+@ref Flag::InstancedColor. The per-instance @ref TransformationMatrix and
+@ref Color attributes are then read from a buffer attached using
+@ref Mesh::addVertexBufferInstanced(). The matrix set via
+@ref setTransformationProjectionMatrix() is applied on top of the per-instance
+transformation, so it usually contains just the projection (and camera)
+matrix, and the per-instance color is multiplied with the color set via
+@ref setColor(), which in this case defaults to fully opaque white. The
+instance data layout matches @ref SceneGraph::InstancedDrawableGroup::InstanceData:
+
+@snippet MagnumShaders.cpp Flat-usage-instancing
+
+@subsection Shaders-Flat-depth-only Alpha masking and depth-only drawing
+
+With @ref Flag::AlphaMask the fragments with alpha of the final color lower
+than @ref setAlphaMask() are discarded. With @ref Flag::DepthOnly the shader
+doesn't produce any color output, which is useful for shadow map rendering or
+for a depth pre-pass. The vertex transformation is declared as
+@glsl invariant @ce, so the depth-only variant produces exactly the same depth
+values as a regular one and the subsequent pass can use
+@ref Renderer::DepthFunction::LessOrEqual or
+@ref Renderer::DepthFunction::Equal. See also
+@ref SceneGraph::Camera::drawDepth() and @ref Shaders-Phong-depth-only.
+
 @see @ref shaders, @ref Flat2D, @ref Flat3D
 */
 template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Flat: public AbstractShaderProgram {
@@ -103,6 +256,35 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Flat: public Abstra
          */
         typedef typename Generic<dimensions>::TextureCoordinates TextureCoordinates;
 
+        /**
+         * @brief Per-instance transformation matrix
+         *
+         * @ref shaders-generic "Generic attribute", @ref Matrix3 in 2D,
+         * @ref Matrix4 in 3D. Used only if @ref Flag::InstancedTransformation
+         * is set.
+         * @requires_gl33 Extension @extension{ARB,instanced_arrays}
+         * @requires_gles30 Extension @extension{ANGLE,instanced_arrays},
+         *      @extension{EXT,instanced_arrays} or
+         *      @extension{NV,instanced_arrays} in OpenGL ES 2.0.
+         * @requires_webgl20 Extension
+         *      @webgl_extension{ANGLE,instanced_arrays} in WebGL 1.0.
+         */
+        typedef typename Generic<dimensions>::TransformationMatrix TransformationMatrix;
+
+        /**
+         * @brief Per-instance color
+         *
+         * @ref shaders-generic "Generic attribute", @ref Color4. Used only if
+         * @ref Flag::InstancedColor is set.
+         * @requires_gl33 Extension @extension{ARB,instanced_arrays}
+         * @requires_gles30 Extension @extension{ANGLE,instanced_arrays},
+         *      @extension{EXT,instanced_arrays} or
+         *      @extension{NV,instanced_arrays} in OpenGL ES 2.0.
+         * @requires_webgl20 Extension
+         *      @webgl_extension{ANGLE,instanced_arrays} in WebGL 1.0.
+         */
+        typedef typename Generic<dimensions>::Color Color;
+
         #ifdef DOXYGEN_GENERATING_OUTPUT
         /**
          * @brief Flag
@@ -110,7 +292,71 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Flat: public Abstra
          * @see @ref Flags, @ref flags()
          */
         enum class Flag: UnsignedByte {
-            Textured = 1 << 0   /**< The shader uses texture instead of color */
+            Textured = 1 << 0,  /**< The shader uses texture instead of color */
+
+            /**
+             * Take the transformation and color from the @glsl FlatDraw @ce
+             * uniform block instead of separate uniforms. See
+             * @ref Shaders-Flat-uniform-buffers for more information.
+             * @requires_gl31 Extension @extension{ARB,uniform_buffer_object}
+             * @requires_gles30 Uniform buffers are not available in OpenGL
+             *      ES 2.0.
+             * @requires_webgl20 Uniform buffers are not available in WebGL
+             *      1.0.
+             */
+            UniformBuffers = 1 << 1,
+
+            /**
+             * Multiply the transformation with a per-instance
+             * @ref TransformationMatrix attribute. See
+             * @ref Shaders-Flat-instancing for more information.
+             * @requires_gl33 Extension @extension{ARB,instanced_arrays}
+             * @requires_gles30 Extension @extension{ANGLE,instanced_arrays},
+             *      @extension{EXT,instanced_arrays} or
+             *      @extension{NV,instanced_arrays} in OpenGL ES 2.0.
+             * @requires_webgl20 Extension
+             *      @webgl_extension{ANGLE,instanced_arrays} in WebGL 1.0.
+             */
+            InstancedTransformation = 1 << 2,
+
+            /**
+             * Multiply the color with a per-instance @ref Color attribute.
+             * See @ref Shaders-Flat-instancing for more information.
+             * @requires_gl33 Extension @extension{ARB,instanced_arrays}
+             * @requires_gles30 Extension @extension{ANGLE,instanced_arrays},
+             *      @extension{EXT,instanced_arrays} or
+             *      @extension{NV,instanced_arrays} in OpenGL ES 2.0.
+             * @requires_webgl20 Extension
+             *      @webgl_extension{ANGLE,instanced_arrays} in WebGL 1.0.
+             */
+            InstancedColor = 1 << 3,
+
+            /**
+             * Discard fragments with alpha lower than the value set via
+             * @ref setAlphaMask(). See @ref Shaders-Flat-depth-only for more
+             * information.
+             */
+            AlphaMask = 1 << 4,
+
+            /**
+             * Don't produce any color output, only depth. The color and
+             * texture are used only if @ref Flag::AlphaMask is set as well.
+             * See @ref Shaders-Flat-depth-only for more information.
+             */
+            DepthOnly = 1 << 5,
+
+            /**
+             * Take the transformation and color from the
+             * @glsl FlatDraws @ce shader storage buffer instead of separate
+             * uniforms. Mutually exclusive with @ref Flag::UniformBuffers. See
+             * @ref Shaders-Flat-shader-storage-buffers for more information.
+             * @requires_gl43 Extension @extension{ARB,shader_storage_buffer_object}
+             * @requires_gles31 Shader storage buffers are not available in
+             *      OpenGL ES 3.0 and older.
+             * @requires_gles Shader storage buffers are not available in
+             *      WebGL.
+             */
+            ShaderStorageBuffers = 1 << 6
         };
 
         /**
@@ -124,6 +370,34 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Flat: public Abstra
         typedef Implementation::FlatFlags Flags;
         #endif
 
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Per-draw uniform block
+         *
+         * Used if @ref Flag::UniformBuffers or
+         * @ref Flag::ShaderStorageBuffers is set.
+         */
+        typedef FlatDrawUniform<dimensions> DrawUniform;
+
+        enum: UnsignedInt {
+            /**
+             * Uniform buffer binding for the @glsl FlatDraw @ce block. Used
+             * if @ref Flag::UniformBuffers is set.
+             * @see @ref bindDrawBuffer()
+             */
+            DrawBufferBinding = 0,
+
+            #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+            /**
+             * Shader storage buffer binding for the @glsl FlatDraws @ce
+             * block. Used if @ref Flag::ShaderStorageBuffers is set.
+             * @see @ref bindDrawStorageBuffer()
+             */
+            DrawStorageBufferBinding = 0
+            #endif
+        };
+        #endif
+
         /**
          * @brief Constructor
          * @param flags     Flags
@@ -148,8 +422,20 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Flat: public Abstra
         /**
          * @brief Set transformation and projection matrix
          * @return Reference to self (for method chaining)
+         *
+         * Expects that neither @ref Flag::UniformBuffers nor
+         * @ref Flag::ShaderStorageBuffers is set, use
+         * @ref FlatDrawUniform::transformationProjectionMatrix instead.
          */
         Flat<dimensions>& setTransformationProjectionMatrix(const MatrixTypeFor<dimensions, Float>& matrix) {
+            #ifndef MAGNUM_TARGET_GLES2
+            CORRADE_ASSERT(!(_flags & Flag::UniformBuffers),
+                "Shaders::Flat::setTransformationProjectionMatrix(): the shader was created with uniform buffers enabled", *this);
+            #endif
+            #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+            CORRADE_ASSERT(!(_flags & Flag::ShaderStorageBuffers),
+                "Shaders::Flat::setTransformationProjectionMatrix(): the shader was created with shader storage buffers enabled", *this);
+            #endif
             setUniform(_transformationProjectionMatrixUniform, matrix);
             return *this;
         }
@@ -158,12 +444,22 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Flat: public Abstra
          * @brief Set color
          * @return Reference to self (for method chaining)
          *
-         * If @ref Flag::Textured is set, default value is
-         * @cpp 0xffffffff_rgbaf @ce and the color will be multiplied with
-         * texture.
+         * If @ref Flag::Textured or @ref Flag::InstancedColor is set, default
+         * value is @cpp 0xffffffff_rgbaf @ce and the color will be multiplied
+         * with the texture and per-instance color. Expects that neither
+         * @ref Flag::UniformBuffers nor @ref Flag::ShaderStorageBuffers is
+         * set, use @ref FlatDrawUniform::color instead.
          * @see @ref bindTexture()
          */
         Flat<dimensions>& setColor(const Color4& color){
+            #ifndef MAGNUM_TARGET_GLES2
+            CORRADE_ASSERT(!(_flags & Flag::UniformBuffers),
+                "Shaders::Flat::setColor(): the shader was created with uniform buffers enabled", *this);
+            #endif
+            #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+            CORRADE_ASSERT(!(_flags & Flag::ShaderStorageBuffers),
+                "Shaders::Flat::setColor(): the shader was created with shader storage buffers enabled", *this);
+            #endif
             setUniform(_colorUniform, color);
             return *this;
         }
@@ -177,6 +473,103 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Flat: public Abstra
          */
         Flat<dimensions>& bindTexture(Texture2D& texture);
 
+        /**
+         * @brief Set alpha mask value
+         * @return Reference to self (for method chaining)
+         *
+         * Fragments with alpha lower than this value are discarded. Expects
+         * that @ref Flag::AlphaMask is set. Initial value is @cpp 0.5f @ce.
+         * Unlike the color, the value is a separate uniform even if
+         * @ref Flag::UniformBuffers is set.
+         */
+        Flat<dimensions>& setAlphaMask(Float mask);
+
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Bind a per-draw uniform buffer range
+         * @param buffer    Buffer containing a @ref DrawUniform
+         * @param offset    Offset of the @ref DrawUniform in @p buffer
+         * @param size      Size of the range, usually
+         *      @cpp sizeof(DrawUniform) @ce
+         * @return Reference to self (for method chaining)
+         *
+         * Equivalent to calling @ref Buffer::bind(Buffer::Target, UnsignedInt, GLintptr, GLsizeiptr)
+         * with @ref Buffer::Target::Uniform and @ref DrawBufferBinding.
+         * Expects that @ref Flag::UniformBuffers is set. The @p offset is
+         * expected to be a multiple of @ref Buffer::uniformOffsetAlignment().
+         * @requires_gl31 Extension @extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        Flat<dimensions>& bindDrawBuffer(Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Bind a per-draw uniform buffer
+         * @return Reference to self (for method chaining)
+         *
+         * Binds the whole @p buffer, which is expected to start with a
+         * @ref DrawUniform. Expects that @ref Flag::UniformBuffers is set.
+         * @requires_gl31 Extension @extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        Flat<dimensions>& bindDrawBuffer(Buffer& buffer);
+        #endif
+
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        /**
+         * @brief Set draw offset
+         * @return Reference to self (for method chaining)
+         *
+         * Index of the @ref DrawUniform in the buffer bound with
+         * @ref bindDrawStorageBuffer() used by the first instance of the
+         * draw, each following instance uses the next item. Expects that
+         * @ref Flag::ShaderStorageBuffers is set. Initial value is
+         * @cpp 0 @ce.
+         * @requires_gl43 Extension @extension{ARB,shader_storage_buffer_object}
+         * @requires_gles31 Shader storage buffers are not available in
+         *      OpenGL ES 3.0 and older.
+         * @requires_gles Shader storage buffers are not available in WebGL.
+         */
+        Flat<dimensions>& setDrawOffset(UnsignedInt offset);
+
+        /**
+         * @brief Bind a per-draw shader storage buffer range
+         * @param buffer    Buffer containing tightly packed @ref DrawUniform
+         *      items
+         * @param offset    Offset of the first item in @p buffer
+         * @param size      Size of the range
+         * @return Reference to self (for method chaining)
+         *
+         * Equivalent to calling @ref Buffer::bind(Buffer::Target, UnsignedInt, GLintptr, GLsizeiptr)
+         * with @ref Buffer::Target::ShaderStorage and
+         * @ref DrawStorageBufferBinding. Expects that
+         * @ref Flag::ShaderStorageBuffers is set. The @p offset is expected
+         * to be a multiple of @ref Buffer::shaderStorageOffsetAlignment().
+         * @requires_gl43 Extension @extension{ARB,shader_storage_buffer_object}
+         * @requires_gles31 Shader storage buffers are not available in
+         *      OpenGL ES 3.0 and older.
+         * @requires_gles Shader storage buffers are not available in WebGL.
+         */
+        Flat<dimensions>& bindDrawStorageBuffer(Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Bind a per-draw shader storage buffer
+         * @return Reference to self (for method chaining)
+         *
+         * Binds the whole @p buffer, which is expected to contain tightly
+         * packed @ref DrawUniform items. Expects that
+         * @ref Flag::ShaderStorageBuffers is set.
+         * @requires_gl43 Extension @extension{ARB,shader_storage_buffer_object}
+         * @requires_gles31 Shader storage buffers are not available in
+         *      OpenGL ES 3.0 and older.
+         * @requires_gles Shader storage buffers are not available in WebGL.
+         */
+        Flat<dimensions>& bindDrawStorageBuffer(Buffer& buffer);
+        #endif
+
         #ifdef MAGNUM_BUILD_DEPRECATED
         /** @brief @copybrief bindTexture()
          * @deprecated Use @ref bindTexture() instead.
@@ -189,7 +582,11 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Flat: public Abstra
     private:
         Flags _flags;
         Int _transformationProjectionMatrixUniform{0},
-            _colorUniform{1};
+            _colorUniform{1},
+            _alphaMaskUniform{2};
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        Int _drawOffsetUniform{3};
+        #endif
 };
 
 /** @brief 2D flat shader */
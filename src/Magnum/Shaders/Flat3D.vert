@@ -28,10 +28,38 @@
 #define out varying
 #endif
 
+#if !defined(UNIFORM_BUFFERS) && !defined(SHADER_STORAGE_BUFFERS)
 #ifdef EXPLICIT_UNIFORM_LOCATION
 layout(location = 0)
 #endif
 uniform highp mat4 transformationProjectionMatrix;
+#elif defined(UNIFORM_BUFFERS)
+#ifdef EXPLICIT_BINDING
+layout(std140, binding = 0)
+#else
+layout(std140)
+#endif
+uniform FlatDraw {
+    highp mat4 transformationProjectionMatrix;
+    lowp vec4 color;
+};
+#else
+struct FlatDrawData {
+    highp mat4 transformationProjectionMatrix;
+    lowp vec4 color;
+};
+
+layout(std430, binding = 0) readonly buffer FlatDraws {
+    FlatDrawData draws[];
+};
+
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 3)
+#endif
+uniform highp uint drawOffset;
+
+flat out lowp vec4 color;
+#endif
 
 #ifdef EXPLICIT_ATTRIB_LOCATION
 layout(location = POSITION_ATTRIBUTE_LOCATION)
@@ -47,8 +75,43 @@ in mediump vec2 textureCoordinates;
 out mediump vec2 interpolatedTextureCoordinates;
 #endif
 
+#ifdef INSTANCED_TRANSFORMATION
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = TRANSFORMATION_MATRIX_ATTRIBUTE_LOCATION)
+#endif
+in highp mat4 instancedTransformationMatrix;
+#endif
+
+#ifdef INSTANCED_COLOR
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = COLOR_ATTRIBUTE_LOCATION)
+#endif
+in lowp vec4 instancedColor;
+
+out lowp vec4 interpolatedInstancedColor;
+#endif
+
+/* So the depth-only variant gives exactly the same depth */
+invariant gl_Position;
+
 void main() {
-    gl_Position = transformationProjectionMatrix*position;
+    #ifdef SHADER_STORAGE_BUFFERS
+    /* Each instance reads its own draw data */
+    highp uint drawId = drawOffset + uint(gl_InstanceID);
+    highp mat4 transformationProjectionMatrix = draws[drawId].transformationProjectionMatrix;
+    color = draws[drawId].color;
+    #endif
+
+    gl_Position = transformationProjectionMatrix*
+        #ifdef INSTANCED_TRANSFORMATION
+        instancedTransformationMatrix*
+        #endif
+        position;
+
+    #ifdef INSTANCED_COLOR
+    /* Per-instance color, if needed */
+    interpolatedInstancedColor = instancedColor;
+    #endif
 
     #ifdef TEXTURED
     /* Texture coordinates, if needed */
@@ -89,6 +89,43 @@ template<UnsignedInt dimensions> struct Generic {
         CORRADE_DEPRECATED("use Color(Components, DataType, DataOptions) instead") constexpr explicit Color(DataType dataType = DataType::Float, DataOptions dataOptions = {});
         #endif
     };
+
+    /**
+     * @brief Per-instance transformation matrix
+     *
+     * @ref Matrix3 in 2D and @ref Matrix4 in 3D, occupying three or four
+     * consecutive locations. Expected to be supplied using
+     * @ref Mesh::addVertexBufferInstanced(). Used by shaders created with
+     * the `InstancedTransformation` flag.
+     * @requires_gl33 Extension @extension{ARB,instanced_arrays}
+     * @requires_gles30 Extension @extension{ANGLE,instanced_arrays},
+     *      @extension{EXT,instanced_arrays} or
+     *      @extension{NV,instanced_arrays} in OpenGL ES 2.0.
+     * @requires_webgl20 Extension @webgl_extension{ANGLE,instanced_arrays}
+     *      in WebGL 1.0.
+     */
+    typedef Attribute<8, T> TransformationMatrix;
+
+    /**
+     * @brief Joint IDs
+     *
+     * @ref Vector4ui, defined only in 3D. IDs of up to four joints affecting
+     * the vertex, indexing the joint matrix palette.
+     * @requires_gl30 Extension @extension{EXT,gpu_shader4}
+     * @requires_gles30 Integer attributes are not available in OpenGL ES 2.0.
+     * @requires_webgl20 Integer attributes are not available in WebGL 1.0.
+     */
+    typedef Attribute<6, Vector4ui> JointIds;
+
+    /**
+     * @brief Joint weights
+     *
+     * @ref Vector4, defined only in 3D. Weights of joints referenced by
+     * @ref JointIds, expected to sum up to @cpp 1.0f @ce.
+     * @requires_gles30 Skinning is not available in OpenGL ES 2.0.
+     * @requires_webgl20 Skinning is not available in WebGL 1.0.
+     */
+    typedef Attribute<7, Vector4> Weights;
 };
 #endif
 
@@ -113,11 +150,17 @@ struct BaseGeneric {
 
 template<> struct Generic<2>: BaseGeneric {
     typedef Attribute<0, Vector2> Position;
+    typedef Attribute<8, Matrix3> TransformationMatrix;
 };
 
 template<> struct Generic<3>: BaseGeneric {
     typedef Attribute<0, Vector3> Position;
     typedef Attribute<2, Vector3> Normal;
+    typedef Attribute<8, Matrix4> TransformationMatrix;
+    #ifndef MAGNUM_TARGET_GLES2
+    typedef Attribute<6, Vector4ui> JointIds;
+    typedef Attribute<7, Vector4> Weights;
+    #endif
 };
 #endif
 
@@ -73,6 +73,7 @@ MeshVisualizer::MeshVisualizer(const Flags flags): _flags{flags} {
 
     vert.addSource(flags & Flag::Wireframe ? "#define WIREFRAME_RENDERING\n" : "")
         .addSource(flags & Flag::NoGeometryShader ? "#define NO_GEOMETRY_SHADER\n" : "")
+        .addSource((flags & Flag::VertexIndexAttribute) == Flag::VertexIndexAttribute ? "#define VERTEX_INDEX_ATTRIBUTE\n" : "")
         #ifdef MAGNUM_TARGET_WEBGL
         .addSource("#define SUBSCRIPTING_WORKAROUND\n")
         #elif defined(MAGNUM_TARGET_GLES2)
@@ -114,7 +115,7 @@ MeshVisualizer::MeshVisualizer(const Flags flags): _flags{flags} {
 
         #if !defined(MAGNUM_TARGET_GLES) || defined(MAGNUM_TARGET_GLES2)
         #ifndef MAGNUM_TARGET_GLES
-        if(!Context::current().isVersionSupported(Version::GL310))
+        if((flags & Flag::VertexIndexAttribute) == Flag::VertexIndexAttribute || !Context::current().isVersionSupported(Version::GL310))
         #endif
         {
             bindAttributeLocation(VertexIndex::Location, "vertexIndex");
@@ -64,6 +64,12 @@ meshes (see @ref MeshTools::duplicate() for possible solution). Additionaly, if
 you have OpenGL < 3.1 or OpenGL ES 2.0, you need to provide also
 @ref VertexIndex attribute.
 
+Alternatively, set @ref Flag::VertexIndexAttribute and provide the
+@ref VertexIndex attribute generated with
+@ref MeshTools::generateWireframeVertexIndices(). That works with indexed
+meshes on all targets and avoids geometry shaders, which are slow on many
+tiled mobile GPUs.
+
 @requires_gles30 Extension @extension{OES,standard_derivatives} for
     wireframe rendering without geometry shaders.
 
@@ -101,6 +107,17 @@ The vertices must be converted to non-indexed array. Mesh setup:
 
 Rendering setup the same as above.
 
+@subsection Shaders-MeshVisualizer-usage-wireframe-vertex-index-attribute Wireframe visualization of indexed meshes using vertex index attribute
+
+The vertex index attribute is generated so that all three vertices of each
+triangle have a different value, duplicating only the few vertices where
+that's not possible. The mesh stays indexed. Mesh setup:
+
+@snippet MagnumShaders.cpp MeshVisualizer-usage-vertex-index-attribute
+
+Rendering setup the same as above, except for passing
+@ref Flag::VertexIndexAttribute to the constructor.
+
 @see @ref shaders
 @todo Understand and add support wireframe width/smoothness without GS
 */
@@ -117,11 +134,14 @@ class MAGNUM_SHADERS_EXPORT MeshVisualizer: public AbstractShaderProgram {
          * @brief Vertex index
          *
          * @ref Magnum::Float "Float", used only in OpenGL < 3.1 and OpenGL ES
-         * 2.0 if @ref Flag::Wireframe is enabled. This attribute (modulo 3)
-         * specifies index of given vertex in triangle, i.e. @cpp 0.0f @ce for
-         * first, @cpp 1.0f @ce for second, @cpp 2.0f @ce for third. In OpenGL
-         * 3.1, OpenGL ES 3.0 and newer this value is provided by the shader
-         * itself, so the attribute is not needed.
+         * 2.0 if @ref Flag::Wireframe is enabled or if
+         * @ref Flag::VertexIndexAttribute is enabled. This attribute (modulo
+         * 3) specifies index of given vertex in triangle, i.e. @cpp 0.0f @ce
+         * for first, @cpp 1.0f @ce for second, @cpp 2.0f @ce for third. In
+         * OpenGL 3.1, OpenGL ES 3.0 and newer this value is provided by the
+         * shader itself for non-indexed meshes, so the attribute is not
+         * needed unless @ref Flag::VertexIndexAttribute is set.
+         * @see @ref MeshTools::generateWireframeVertexIndices()
          */
         typedef Attribute<3, Float> VertexIndex;
 
@@ -147,7 +167,17 @@ class MAGNUM_SHADERS_EXPORT MeshVisualizer: public AbstractShaderProgram {
              * attribute in the mesh. In OpenGL ES enabled alongside
              * @ref Flag::Wireframe.
              */
-            NoGeometryShader = 1 << 1
+            NoGeometryShader = 1 << 1,
+
+            /**
+             * Take the vertex index from the @ref VertexIndex attribute even
+             * on OpenGL 3.1, OpenGL ES 3.0 and newer, which allows rendering
+             * wireframe of indexed meshes without geometry shader. Implies
+             * @ref Flag::NoGeometryShader, use together with
+             * @ref Flag::Wireframe.
+             * @see @ref MeshTools::generateWireframeVertexIndices()
+             */
+            VertexIndexAttribute = (1 << 2)|(1 << 1)
         };
 
         /** @brief Flags */
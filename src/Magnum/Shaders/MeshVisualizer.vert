@@ -39,12 +39,14 @@ layout(location = POSITION_ATTRIBUTE_LOCATION)
 in highp vec4 position;
 
 #if defined(WIREFRAME_RENDERING) && defined(NO_GEOMETRY_SHADER)
-#if (!defined(GL_ES) && __VERSION__ < 140) || (defined(GL_ES) && __VERSION__ < 300)
+#if defined(VERTEX_INDEX_ATTRIBUTE) || (!defined(GL_ES) && __VERSION__ < 140) || (defined(GL_ES) && __VERSION__ < 300)
 #ifdef EXPLICIT_ATTRIB_LOCATION
 layout(location = 3)
 #endif
 in lowp float vertexIndex;
-#define gl_VertexID int(vertexIndex)
+#define vertexId int(vertexIndex)
+#else
+#define vertexId gl_VertexID
 #endif
 
 out vec3 barycentric;
@@ -64,7 +66,7 @@ void main() {
     #elif !defined(NEW_GLSL)
     barycentric[int(mod(vertexIndex, 3.0))] = 1.0;
     #else
-    barycentric[gl_VertexID % 3] = 1.0;
+    barycentric[vertexId % 3] = 1.0;
     #endif
 
     #endif
@@ -0,0 +1,100 @@
+#ifndef Magnum_Shaders_ParticleDrawable_h
+#define Magnum_Shaders_ParticleDrawable_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Shaders::ParticleDrawable
+ */
+
+#include "Magnum/configure.h"
+
+#ifndef MAGNUM_TARGET_GLES2
+#include "Magnum/SceneGraph/AbstractObject.h"
+#include "Magnum/SceneGraph/Camera.h"
+#include "Magnum/SceneGraph/Drawable.h"
+#include "Magnum/Shaders/ParticleSystem.h"
+
+namespace Magnum { namespace Shaders {
+
+/**
+@brief Particle system drawable
+
+Scene graph feature drawing a @ref ParticleSystem with the emitter attached to
+given object. On each draw the emitter transformation is updated to absolute
+transformation of the object and the particles are drawn with projection and
+camera matrix of the camera. Position of the object thus affects only newly
+emitted particles, already emitted particles stay in world space. Stepping
+the simulation is left to the application, ideally after drawing so the new
+particles are emitted from the current object position:
+
+@code{.cpp}
+Shaders::ParticleSystem particles{10000};
+particles.setEmissionRate(2000.0f);
+
+Object3D emitter{&scene};
+Shaders::ParticleDrawable drawable{emitter, particles, &drawables};
+
+// each frame
+camera->draw(drawables);
+particles.update(timeline.previousFrameDuration());
+@endcode
+
+The class is header-only, so using it requires linking to the
+@ref SceneGraph library in addition to this one. The particle system is
+referenced, not owned, and has to stay alive for the whole drawable lifetime.
+
+@requires_gl40 Extension @extension{ARB,transform_feedback2}
+@requires_gles30 Transform feedback is not available in OpenGL ES 2.0.
+@requires_webgl20 Transform feedback is not available in WebGL 1.0.
+*/
+class ParticleDrawable: public SceneGraph::Drawable3D {
+    public:
+        /**
+         * @brief Constructor
+         * @param object    Object holding the emitter
+         * @param system    Particle system to draw
+         * @param drawables Group this drawable belongs to
+         */
+        explicit ParticleDrawable(SceneGraph::AbstractObject3D& object, ParticleSystem& system, SceneGraph::DrawableGroup3D* drawables = nullptr): SceneGraph::Drawable3D{object, drawables}, _system(system) {}
+
+        /** @brief Particle system */
+        ParticleSystem& system() { return _system; }
+
+    private:
+        void draw(const Matrix4&, SceneGraph::Camera3D& camera) override {
+            _system.setEmitterTransformation(object().absoluteTransformationMatrix())
+                .draw(camera.projectionMatrix()*camera.cameraMatrix());
+        }
+
+        ParticleSystem& _system;
+};
+
+}}
+#else
+#error this header is not available in OpenGL ES 2.0 build
+#endif
+
+#endif
@@ -0,0 +1,76 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+uniform highp float timeDelta;
+uniform highp int emitBegin;
+uniform highp int emitCount;
+uniform highp int capacity;
+uniform highp int seed;
+uniform highp mat4 emitterTransformation;
+uniform highp vec3 emitterSize;
+uniform highp vec3 velocity;
+uniform highp float velocitySpread;
+uniform highp vec2 lifetimeRange;
+uniform highp vec3 acceleration;
+
+highp uint hash(highp uint x) {
+    x ^= x >> 16u;
+    x *= 0x7feb352du;
+    x ^= x >> 15u;
+    x *= 0x846ca68bu;
+    x ^= x >> 16u;
+    return x;
+}
+
+highp float random(inout highp uint state) {
+    state = hash(state);
+    return float(state >> 8u)*(1.0/16777216.0);
+}
+
+highp vec3 randomVector(inout highp uint state) {
+    highp float x = random(state);
+    highp float y = random(state);
+    highp float z = random(state);
+    return vec3(x, y, z)*2.0 - vec3(1.0);
+}
+
+/* Particles are emitted in a ring, the emitted range starting at emitBegin
+   and wrapping around capacity. Dead particles have age equal to or larger
+   than their lifetime and aren't simulated anymore. */
+void simulate(highp int index, inout highp vec4 positionAge, inout highp vec4 velocityLifetime) {
+    if((index - emitBegin + capacity) % capacity < emitCount) {
+        highp uint state = hash(uint(index) ^ hash(uint(seed)));
+        highp vec3 position = randomVector(state)*emitterSize;
+        highp vec3 direction = velocity + randomVector(state)*velocitySpread;
+        positionAge = vec4((emitterTransformation*vec4(position, 1.0)).xyz, 0.0);
+        velocityLifetime = vec4(mat3(emitterTransformation)*direction,
+            mix(lifetimeRange.x, lifetimeRange.y, random(state)));
+
+    } else if(positionAge.w < velocityLifetime.w) {
+        velocityLifetime.xyz += acceleration*timeDelta;
+        positionAge.xyz += velocityLifetime.xyz*timeDelta;
+        positionAge.w += timeDelta;
+    }
+}
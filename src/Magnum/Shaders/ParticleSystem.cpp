@@ -0,0 +1,436 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ParticleSystem.h"
+
+#include <vector>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+#include <Corrade/Utility/Resource.h>
+
+#include "Magnum/AbstractShaderProgram.h"
+#include "Magnum/Buffer.h"
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/Mesh.h"
+#include "Magnum/Renderer.h"
+#include "Magnum/Shader.h"
+#include "Magnum/TransformFeedback.h"
+#include "Magnum/Math/Functions.h"
+
+#include "Implementation/CreateCompatibilityShader.h"
+
+namespace Magnum { namespace Shaders {
+
+namespace {
+
+enum: UnsignedInt { ParticleBufferBinding = 0 };
+
+typedef Attribute<0, Vector4> PositionAge;
+typedef Attribute<1, Vector4> VelocityLifetime;
+
+Version transformFeedbackVersion() {
+    #ifndef MAGNUM_TARGET_GLES
+    return Context::current().supportedVersion({Version::GL330, Version::GL310, Version::GL300});
+    #else
+    return Version::GLES300;
+    #endif
+}
+
+bool isComputeSupported() {
+    #ifndef MAGNUM_TARGET_GLES
+    return Context::current().isExtensionSupported<Extensions::GL::ARB::compute_shader>() &&
+        Context::current().isExtensionSupported<Extensions::GL::ARB::shader_storage_buffer_object>();
+    #elif !defined(MAGNUM_TARGET_WEBGL)
+    return Context::current().isVersionSupported(Version::GLES310);
+    #else
+    return false;
+    #endif
+}
+
+class ParticleSimulationShader: public AbstractShaderProgram {
+    public:
+        explicit ParticleSimulationShader(ParticleSystem::Path path);
+
+        ParticleSimulationShader& setTimeDelta(Float timeDelta) {
+            setUniform(_timeDeltaUniform, timeDelta);
+            return *this;
+        }
+
+        ParticleSimulationShader& setEmitRange(UnsignedInt begin, UnsignedInt count) {
+            setUniform(_emitBeginUniform, Int(begin));
+            setUniform(_emitCountUniform, Int(count));
+            return *this;
+        }
+
+        ParticleSimulationShader& setCapacity(UnsignedInt capacity) {
+            setUniform(_capacityUniform, Int(capacity));
+            return *this;
+        }
+
+        ParticleSimulationShader& setSeed(Int seed) {
+            setUniform(_seedUniform, seed);
+            return *this;
+        }
+
+        ParticleSimulationShader& setEmitterTransformation(const Matrix4& transformation) {
+            setUniform(_emitterTransformationUniform, transformation);
+            return *this;
+        }
+
+        ParticleSimulationShader& setEmitterSize(const Vector3& size) {
+            setUniform(_emitterSizeUniform, size);
+            return *this;
+        }
+
+        ParticleSimulationShader& setVelocity(const Vector3& velocity) {
+            setUniform(_velocityUniform, velocity);
+            return *this;
+        }
+
+        ParticleSimulationShader& setVelocitySpread(Float spread) {
+            setUniform(_velocitySpreadUniform, spread);
+            return *this;
+        }
+
+        ParticleSimulationShader& setLifetimeRange(Float min, Float max) {
+            setUniform(_lifetimeRangeUniform, Vector2{min, max});
+            return *this;
+        }
+
+        ParticleSimulationShader& setAcceleration(const Vector3& acceleration) {
+            setUniform(_accelerationUniform, acceleration);
+            return *this;
+        }
+
+    private:
+        Int _timeDeltaUniform,
+            _emitBeginUniform,
+            _emitCountUniform,
+            _capacityUniform,
+            _seedUniform,
+            _emitterTransformationUniform,
+            _emitterSizeUniform,
+            _velocityUniform,
+            _velocitySpreadUniform,
+            _lifetimeRangeUniform,
+            _accelerationUniform;
+};
+
+ParticleSimulationShader::ParticleSimulationShader(const ParticleSystem::Path path) {
+    #ifdef MAGNUM_BUILD_STATIC
+    /* Import resources on static build, if not already */
+    if(!Utility::Resource::hasGroup("MagnumShaders"))
+        importShaderResources();
+    #endif
+    Utility::Resource rs("MagnumShaders");
+
+    #ifndef MAGNUM_TARGET_WEBGL
+    if(path == ParticleSystem::Path::Compute) {
+        #ifndef MAGNUM_TARGET_GLES
+        Shader comp = Implementation::createCompatibilityShader(rs, Version::GL430, Shader::Type::Compute);
+        #else
+        Shader comp = Implementation::createCompatibilityShader(rs, Version::GLES310, Shader::Type::Compute);
+        #endif
+        comp.addSource(rs.get("ParticleSimulation.glsl"))
+            .addSource(rs.get("ParticleSimulation.comp"));
+
+        CORRADE_INTERNAL_ASSERT_OUTPUT(comp.compile());
+
+        attachShader(comp);
+    } else
+    #else
+    static_cast<void>(path);
+    #endif
+    {
+        const Version version = transformFeedbackVersion();
+        Shader vert = Implementation::createCompatibilityShader(rs, version, Shader::Type::Vertex);
+        Shader frag = Implementation::createCompatibilityShader(rs, version, Shader::Type::Fragment);
+        vert.addSource(rs.get("ParticleSimulation.glsl"))
+            .addSource(rs.get("ParticleSimulation.vert"));
+        frag.addSource(rs.get("ParticleSimulation.frag"));
+
+        CORRADE_INTERNAL_ASSERT_OUTPUT(Shader::compile({vert, frag}));
+
+        attachShaders({vert, frag});
+
+        bindAttributeLocation(PositionAge::Location, "positionAge");
+        bindAttributeLocation(VelocityLifetime::Location, "velocityLifetime");
+        setTransformFeedbackOutputs({"outPositionAge", "outVelocityLifetime"}, TransformFeedbackBufferMode::InterleavedAttributes);
+    }
+
+    CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+
+    _timeDeltaUniform = uniformLocation("timeDelta");
+    _emitBeginUniform = uniformLocation("emitBegin");
+    _emitCountUniform = uniformLocation("emitCount");
+    _capacityUniform = uniformLocation("capacity");
+    _seedUniform = uniformLocation("seed");
+    _emitterTransformationUniform = uniformLocation("emitterTransformation");
+    _emitterSizeUniform = uniformLocation("emitterSize");
+    _velocityUniform = uniformLocation("velocity");
+    _velocitySpreadUniform = uniformLocation("velocitySpread");
+    _lifetimeRangeUniform = uniformLocation("lifetimeRange");
+    _accelerationUniform = uniformLocation("acceleration");
+}
+
+class ParticleShader: public AbstractShaderProgram {
+    public:
+        explicit ParticleShader();
+
+        ParticleShader& setTransformationProjectionMatrix(const Matrix4& matrix) {
+            setUniform(_transformationProjectionMatrixUniform, matrix);
+            return *this;
+        }
+
+        ParticleShader& setColor(const Color4& begin, const Color4& end) {
+            setUniform(_colorBeginUniform, begin);
+            setUniform(_colorEndUniform, end);
+            return *this;
+        }
+
+        ParticleShader& setPointSize(Float begin, Float end) {
+            setUniform(_pointSizesUniform, Vector2{begin, end});
+            return *this;
+        }
+
+    private:
+        Int _transformationProjectionMatrixUniform,
+            _colorBeginUniform,
+            _colorEndUniform,
+            _pointSizesUniform;
+};
+
+ParticleShader::ParticleShader() {
+    #ifdef MAGNUM_BUILD_STATIC
+    /* Import resources on static build, if not already */
+    if(!Utility::Resource::hasGroup("MagnumShaders"))
+        importShaderResources();
+    #endif
+    Utility::Resource rs("MagnumShaders");
+
+    const Version version = transformFeedbackVersion();
+    Shader vert = Implementation::createCompatibilityShader(rs, version, Shader::Type::Vertex);
+    Shader frag = Implementation::createCompatibilityShader(rs, version, Shader::Type::Fragment);
+    vert.addSource(rs.get("ParticleSystem.vert"));
+    frag.addSource(rs.get("ParticleSystem.frag"));
+
+    CORRADE_INTERNAL_ASSERT_OUTPUT(Shader::compile({vert, frag}));
+
+    attachShaders({vert, frag});
+
+    bindAttributeLocation(PositionAge::Location, "positionAge");
+    bindAttributeLocation(VelocityLifetime::Location, "velocityLifetime");
+
+    CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+
+    _transformationProjectionMatrixUniform = uniformLocation("transformationProjectionMatrix");
+    _colorBeginUniform = uniformLocation("colorBegin");
+    _colorEndUniform = uniformLocation("colorEnd");
+    _pointSizesUniform = uniformLocation("pointSizes");
+}
+
+}
+
+struct ParticleSystem::State {
+    explicit State(UnsignedInt capacity, Path path): capacity{capacity}, path{path}, simulation{path} {}
+
+    UnsignedInt capacity;
+    Path path;
+    Float emissionRate{},
+        emissionAccumulator{};
+    UnsignedInt pendingEmitCount{},
+        emitCursor{},
+        current{};
+    Int seed{};
+
+    ParticleSimulationShader simulation;
+    ParticleShader shader;
+
+    /* The second buffer, mesh and transform feedback are used only for
+       ping-ponging with Path::TransformFeedback */
+    Buffer buffers[2]{Buffer{NoCreate}, Buffer{NoCreate}};
+    Mesh meshes[2]{Mesh{NoCreate}, Mesh{NoCreate}};
+    TransformFeedback feedbacks[2]{TransformFeedback{NoCreate}, TransformFeedback{NoCreate}};
+};
+
+auto ParticleSystem::defaultPath() -> Path {
+    return isComputeSupported() ? Path::Compute : Path::TransformFeedback;
+}
+
+ParticleSystem::ParticleSystem(const UnsignedInt capacity): ParticleSystem{capacity, defaultPath()} {}
+
+ParticleSystem::ParticleSystem(const UnsignedInt capacity, const Path path) {
+    #ifndef MAGNUM_TARGET_GLES
+    MAGNUM_ASSERT_EXTENSION_SUPPORTED(Extensions::GL::ARB::transform_feedback2);
+    #endif
+    CORRADE_ASSERT(capacity,
+        "Shaders::ParticleSystem: expected non-zero capacity", );
+    CORRADE_ASSERT(path != Path::Compute || isComputeSupported(),
+        "Shaders::ParticleSystem: compute path is not supported", );
+
+    _state.reset(new State{capacity, path});
+
+    /* All particles are initially dead, with zero age and lifetime */
+    const std::vector<Vector4> data(capacity*2);
+    const std::size_t count = path == Path::TransformFeedback ? 2 : 1;
+    for(std::size_t i = 0; i != count; ++i) {
+        _state->buffers[i] = Buffer{};
+        _state->buffers[i].setData(data, BufferUsage::DynamicCopy);
+
+        _state->meshes[i] = Mesh{};
+        _state->meshes[i].setPrimitive(MeshPrimitive::Points)
+            .setCount(capacity)
+            .addVertexBuffer(_state->buffers[i], 0, PositionAge{}, VelocityLifetime{});
+
+        if(path == Path::TransformFeedback) {
+            _state->feedbacks[i] = TransformFeedback{};
+            _state->feedbacks[i].attachBuffer(0, _state->buffers[i]);
+        }
+    }
+
+    /* Default uniform values */
+    _state->simulation.setCapacity(capacity)
+        .setEmitterTransformation({})
+        .setEmitterSize({})
+        .setVelocity({})
+        .setVelocitySpread(0.0f)
+        .setLifetimeRange(1.0f, 1.0f)
+        .setAcceleration({});
+    _state->shader.setColor(Color4{1.0f}, Color4{1.0f, 0.0f})
+        .setPointSize(4.0f, 4.0f);
+}
+
+ParticleSystem::~ParticleSystem() = default;
+
+UnsignedInt ParticleSystem::capacity() const { return _state->capacity; }
+
+auto ParticleSystem::path() const -> Path { return _state->path; }
+
+Float ParticleSystem::emissionRate() const { return _state->emissionRate; }
+
+ParticleSystem& ParticleSystem::setEmissionRate(const Float rate) {
+    _state->emissionRate = rate;
+    return *this;
+}
+
+ParticleSystem& ParticleSystem::setEmitterTransformation(const Matrix4& transformation) {
+    _state->simulation.setEmitterTransformation(transformation);
+    return *this;
+}
+
+ParticleSystem& ParticleSystem::setEmitterSize(const Vector3& size) {
+    _state->simulation.setEmitterSize(size);
+    return *this;
+}
+
+ParticleSystem& ParticleSystem::setVelocity(const Vector3& velocity) {
+    _state->simulation.setVelocity(velocity);
+    return *this;
+}
+
+ParticleSystem& ParticleSystem::setVelocitySpread(const Float spread) {
+    _state->simulation.setVelocitySpread(spread);
+    return *this;
+}
+
+ParticleSystem& ParticleSystem::setLifetimeRange(const Float min, const Float max) {
+    _state->simulation.setLifetimeRange(min, max);
+    return *this;
+}
+
+ParticleSystem& ParticleSystem::setAcceleration(const Vector3& acceleration) {
+    _state->simulation.setAcceleration(acceleration);
+    return *this;
+}
+
+ParticleSystem& ParticleSystem::setColor(const Color4& begin, const Color4& end) {
+    _state->shader.setColor(begin, end);
+    return *this;
+}
+
+ParticleSystem& ParticleSystem::setPointSize(const Float begin, const Float end) {
+    _state->shader.setPointSize(begin, end);
+    return *this;
+}
+
+ParticleSystem& ParticleSystem::emit(const UnsignedInt count) {
+    _state->pendingEmitCount += count;
+    return *this;
+}
+
+ParticleSystem& ParticleSystem::update(const Float timeDelta) {
+    /* Accumulate fractional emission across updates */
+    const Float emitted = _state->emissionAccumulator + _state->emissionRate*timeDelta;
+    const UnsignedInt emittedCount = UnsignedInt(emitted);
+    _state->emissionAccumulator = emitted - Float(emittedCount);
+    const UnsignedInt count = Math::min(emittedCount + _state->pendingEmitCount, _state->capacity);
+    _state->pendingEmitCount = 0;
+
+    _state->simulation.setTimeDelta(timeDelta)
+        .setEmitRange(_state->emitCursor, count)
+        .setSeed(_state->seed++);
+    _state->emitCursor = (_state->emitCursor + count) % _state->capacity;
+
+    #ifndef MAGNUM_TARGET_WEBGL
+    if(_state->path == Path::Compute) {
+        _state->buffers[0].bind(Buffer::Target::ShaderStorage, ParticleBufferBinding);
+        _state->simulation.dispatchCompute({(_state->capacity + 63)/64, 1, 1});
+        Renderer::setMemoryBarrier(Renderer::MemoryBarrier::VertexAttributeArray|Renderer::MemoryBarrier::ShaderStorage);
+        return *this;
+    }
+    #endif
+
+    /* Capture the simulated particles into the other buffer */
+    const UnsignedInt next = _state->current ^ 1;
+    Renderer::enable(Renderer::Feature::RasterizerDiscard);
+    _state->feedbacks[next].begin(_state->simulation, TransformFeedback::PrimitiveMode::Points);
+    _state->meshes[_state->current].draw(_state->simulation);
+    _state->feedbacks[next].end();
+    Renderer::disable(Renderer::Feature::RasterizerDiscard);
+    _state->current = next;
+
+    return *this;
+}
+
+void ParticleSystem::draw(const Matrix4& transformationProjectionMatrix) {
+    _state->shader.setTransformationProjectionMatrix(transformationProjectionMatrix);
+    _state->meshes[_state->current].draw(_state->shader);
+}
+
+Buffer& ParticleSystem::buffer() { return _state->buffers[_state->current]; }
+
+Debug& operator<<(Debug& debug, const ParticleSystem::Path value) {
+    switch(value) {
+        #define _c(v) case ParticleSystem::Path::v: return debug << "Shaders::ParticleSystem::Path::" #v;
+        _c(TransformFeedback)
+        _c(Compute)
+        #undef _c
+    }
+
+    return debug << "Shaders::ParticleSystem::Path(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
+}
+
+}}
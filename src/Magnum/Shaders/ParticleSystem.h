@@ -0,0 +1,310 @@
+#ifndef Magnum_Shaders_ParticleSystem_h
+#define Magnum_Shaders_ParticleSystem_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Shaders::ParticleSystem
+ */
+
+#include "Magnum/configure.h"
+
+#ifndef MAGNUM_TARGET_GLES2
+#include <memory>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Shaders/visibility.h"
+
+namespace Magnum { namespace Shaders {
+
+/**
+@brief GPU particle system
+
+Simulates and draws a fixed-capacity set of point particles entirely on the
+GPU, without any per-frame upload or readback. Particles are emitted from a
+box around the emitter transformation with given initial velocity and random
+spread, accelerated by a constant force and killed after a random lifetime.
+They're drawn as round points with size and color interpolated over the
+particle lifetime.
+
+@code{.cpp}
+Shaders::ParticleSystem particles{10000};
+particles.setEmissionRate(2000.0f)
+    .setEmitterSize({0.1f, 0.0f, 0.1f})
+    .setVelocity({0.0f, 4.0f, 0.0f})
+    .setVelocitySpread(0.5f)
+    .setLifetimeRange(1.5f, 2.5f)
+    .setAcceleration({0.0f, -9.81f, 0.0f})
+    .setEmitterTransformation(Matrix4::translation({0.0f, 1.0f, 0.0f}));
+
+// each frame
+particles.draw(camera->projectionMatrix()*camera->cameraMatrix());
+particles.update(timeline.previousFrameDuration());
+@endcode
+
+Particles are emitted in a ring --- each @ref update() resets the next
+particles after the ones emitted last time, so a particle may get recycled
+before its lifetime ends if the capacity is lower than emission rate
+multiplied by the max lifetime. Drawing is done with blending and depth state
+set by the user, so additive blending without depth writes is usually what
+you want:
+
+@code{.cpp}
+Renderer::enable(Renderer::Feature::Blending);
+Renderer::setBlendFunction(Renderer::BlendFunction::SourceAlpha, Renderer::BlendFunction::One);
+Renderer::setDepthMask(false);
+particles.draw(viewProjectionMatrix);
+Renderer::setDepthMask(true);
+@endcode
+
+In desktop OpenGL @ref Renderer::Feature::ProgramPointSize has to be enabled
+for the point size to take effect. See @ref ParticleDrawable for scene graph
+integration.
+
+### Implementation
+
+With @ref Path::TransformFeedback the particles are stored in two buffers
+that are ping-ponged on each @ref update(), with the simulation running in a
+vertex shader with @ref Renderer::Feature::RasterizerDiscard enabled and its
+output captured using @ref TransformFeedback. With @ref Path::Compute the
+particles are updated in place in a single buffer using a compute shader,
+followed by a @ref Renderer::MemoryBarrier::VertexAttributeArray barrier.
+
+Each particle is stored as two @ref Vector4 values, position with age and
+velocity with lifetime, see @ref buffer() for using it with custom shaders.
+
+@requires_gl40 Extension @extension{ARB,transform_feedback2}
+@requires_gles30 Transform feedback is not available in OpenGL ES 2.0.
+@requires_webgl20 Transform feedback is not available in WebGL 1.0.
+*/
+class MAGNUM_SHADERS_EXPORT ParticleSystem {
+    public:
+        /**
+         * @brief Implementation path
+         *
+         * @see @ref path()
+         */
+        enum class Path: UnsignedByte {
+            /** Vertex shader with captured output and ping-pong buffers */
+            TransformFeedback,
+
+            /**
+             * Compute shader updating the particles in place.
+             * @requires_gl43 Extension @extension{ARB,compute_shader} and
+             *      @extension{ARB,shader_storage_buffer_object}
+             * @requires_gles31 Compute shaders are not available in
+             *      OpenGL ES 3.0 and older.
+             * @requires_gles Compute shaders are not available in WebGL.
+             */
+            Compute
+        };
+
+        /**
+         * @brief Default implementation path
+         *
+         * Returns @ref Path::Compute if compute shaders and shader storage
+         * buffers are supported, @ref Path::TransformFeedback otherwise.
+         */
+        static Path defaultPath();
+
+        /**
+         * @brief Constructor
+         * @param capacity      Max count of live particles
+         *
+         * Uses @ref defaultPath(). All particles are initially dead.
+         */
+        explicit ParticleSystem(UnsignedInt capacity);
+
+        /**
+         * @brief Construct with explicit implementation path
+         *
+         * Expects that @ref Path::Compute is used only if supported, see
+         * @ref defaultPath().
+         */
+        explicit ParticleSystem(UnsignedInt capacity, Path path);
+
+        /** @brief Copying is not allowed */
+        ParticleSystem(const ParticleSystem&) = delete;
+
+        /** @brief Moving is not allowed */
+        ParticleSystem(ParticleSystem&&) = delete;
+
+        ~ParticleSystem();
+
+        /** @brief Copying is not allowed */
+        ParticleSystem& operator=(const ParticleSystem&) = delete;
+
+        /** @brief Moving is not allowed */
+        ParticleSystem& operator=(ParticleSystem&&) = delete;
+
+        /** @brief Max count of live particles */
+        UnsignedInt capacity() const;
+
+        /** @brief Implementation path */
+        Path path() const;
+
+        /** @brief Emission rate */
+        Float emissionRate() const;
+
+        /**
+         * @brief Set emission rate
+         * @return Reference to self (for method chaining)
+         *
+         * Count of particles emitted per second, fractional counts are
+         * accumulated across @ref update() calls. Default is
+         * @cpp 0.0f @ce, i.e. particles are emitted only through
+         * @ref emit().
+         */
+        ParticleSystem& setEmissionRate(Float rate);
+
+        /**
+         * @brief Set emitter transformation
+         * @return Reference to self (for method chaining)
+         *
+         * Position, size and velocity of emitted particles is transformed
+         * with it, already emitted particles are not affected. Default is
+         * identity.
+         */
+        ParticleSystem& setEmitterTransformation(const Matrix4& transformation);
+
+        /**
+         * @brief Set emitter size
+         * @return Reference to self (for method chaining)
+         *
+         * Half-extents of the box in emitter space in which the particles
+         * are emitted. Default is zero, i.e. all particles are emitted from
+         * the emitter origin.
+         */
+        ParticleSystem& setEmitterSize(const Vector3& size);
+
+        /**
+         * @brief Set initial velocity
+         * @return Reference to self (for method chaining)
+         *
+         * In emitter space. Default is zero.
+         */
+        ParticleSystem& setVelocity(const Vector3& velocity);
+
+        /**
+         * @brief Set initial velocity spread
+         * @return Reference to self (for method chaining)
+         *
+         * Max random offset added to each component of the initial velocity.
+         * Default is @cpp 0.0f @ce.
+         */
+        ParticleSystem& setVelocitySpread(Float spread);
+
+        /**
+         * @brief Set lifetime range
+         * @return Reference to self (for method chaining)
+         *
+         * Lifetime of each particle is picked uniformly from the range, in
+         * seconds. Default is @cpp 1.0f @ce for both.
+         */
+        ParticleSystem& setLifetimeRange(Float min, Float max);
+
+        /**
+         * @brief Set acceleration
+         * @return Reference to self (for method chaining)
+         *
+         * Constant acceleration applied to all live particles in world
+         * space, such as gravity. Default is zero.
+         */
+        ParticleSystem& setAcceleration(const Vector3& acceleration);
+
+        /**
+         * @brief Set color
+         * @return Reference to self (for method chaining)
+         *
+         * Color at the beginning and at the end of particle lifetime.
+         * Default is @cpp 0xffffffff_rgbaf @ce and @cpp 0xffffff00_rgbaf @ce.
+         */
+        ParticleSystem& setColor(const Color4& begin, const Color4& end);
+
+        /**
+         * @brief Set point size
+         * @return Reference to self (for method chaining)
+         *
+         * Point size in pixels at the beginning and at the end of particle
+         * lifetime. Default is @cpp 4.0f @ce for both.
+         */
+        ParticleSystem& setPointSize(Float begin, Float end);
+
+        /**
+         * @brief Emit a burst of particles
+         * @return Reference to self (for method chaining)
+         *
+         * The particles are emitted on next @ref update(), in addition to
+         * the ones given by @ref setEmissionRate().
+         */
+        ParticleSystem& emit(UnsignedInt count);
+
+        /**
+         * @brief Update the particles
+         * @param timeDelta     Time since last update, in seconds
+         * @return Reference to self (for method chaining)
+         *
+         * Emits new particles and advances the simulation. At most
+         * @ref capacity() particles are emitted in a single update.
+         */
+        ParticleSystem& update(Float timeDelta);
+
+        /**
+         * @brief Draw the particles
+         * @param transformationProjectionMatrix    World to clip space
+         *      transformation
+         *
+         * Dead particles are moved outside of the clip volume.
+         */
+        void draw(const Matrix4& transformationProjectionMatrix);
+
+        /**
+         * @brief Buffer with current particle state
+         *
+         * Contains @ref capacity() pairs of @ref Vector4, position in world
+         * space with age in seconds in the last component and velocity with
+         * lifetime. A particle is dead if its age is larger or equal to its
+         * lifetime. With @ref Path::TransformFeedback the returned buffer
+         * changes after each @ref update().
+         */
+        Buffer& buffer();
+
+    private:
+        struct State;
+
+        std::unique_ptr<State> _state;
+};
+
+/** @debugoperatorclassenum{ParticleSystem,ParticleSystem::Path} */
+MAGNUM_SHADERS_EXPORT Debug& operator<<(Debug& debug, ParticleSystem::Path value);
+
+}}
+#else
+#error this header is not available in OpenGL ES 2.0 build
+#endif
+
+#endif
@@ -0,0 +1,50 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+uniform highp mat4 transformationProjectionMatrix;
+uniform lowp vec4 colorBegin;
+uniform lowp vec4 colorEnd;
+uniform mediump vec2 pointSizes;
+
+in highp vec4 positionAge;
+in highp vec4 velocityLifetime;
+
+out lowp vec4 interpolatedColor;
+
+void main() {
+    highp float t = velocityLifetime.w > 0.0 ? positionAge.w/velocityLifetime.w : 1.0;
+
+    /* Dead particles are put outside of the clip volume */
+    if(t >= 1.0) {
+        gl_Position = vec4(0.0, 0.0, 2.0, 1.0);
+        gl_PointSize = 1.0;
+        interpolatedColor = vec4(0.0);
+        return;
+    }
+
+    gl_Position = transformationProjectionMatrix*vec4(positionAge.xyz, 1.0);
+    gl_PointSize = mix(pointSizes.x, pointSizes.y, t);
+    interpolatedColor = mix(colorBegin, colorEnd, t);
+}
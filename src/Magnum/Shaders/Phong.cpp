@@ -25,12 +25,17 @@
 
 #include "Phong.h"
 
+#include <string>
 #include <Corrade/Utility/Resource.h>
 
+#include "Magnum/Buffer.h"
 #include "Magnum/Context.h"
 #include "Magnum/Extensions.h"
 #include "Magnum/Shader.h"
 #include "Magnum/Texture.h"
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+#include "Magnum/Shaders/PhongLightGrid.h"
+#endif
 
 #include "Implementation/CreateCompatibilityShader.h"
 
@@ -40,11 +45,22 @@ namespace {
     enum: Int {
         AmbientTextureLayer = 0,
         DiffuseTextureLayer = 1,
-        SpecularTextureLayer = 2
+        SpecularTextureLayer = 2,
+        LightDataTextureLayer = 3,
+        LightTileTextureLayer = 4,
+        LightIndexTextureLayer = 5
     };
 }
 
-Phong::Phong(const Flags flags): _flags(flags) {
+Phong::Phong(const Flags flags, const UnsignedInt jointCount): _flags(flags), _jointCount{jointCount} {
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(flags & Flag::Skinning) == !jointCount,
+        "Shaders::Phong: joint count has to be non-zero if and only if skinning is enabled", );
+    #else
+    CORRADE_ASSERT(!jointCount,
+        "Shaders::Phong: skinning is not available in OpenGL ES 2.0", );
+    #endif
+
     #ifdef MAGNUM_BUILD_STATIC
     /* Import resources on static build, if not already */
     if(!Utility::Resource::hasGroup("MagnumShaders"))
@@ -53,7 +69,20 @@ Phong::Phong(const Flags flags): _flags(flags) {
     Utility::Resource rs("MagnumShaders");
 
     #ifndef MAGNUM_TARGET_GLES
-    const Version version = Context::current().supportedVersion({Version::GL320, Version::GL310, Version::GL300, Version::GL210});
+    /* Shader storage blocks need GLSL 4.30, uniform blocks and buffer
+       textures need GLSL 1.40 */
+    const Version version = flags & Flag::ShaderStorageBuffers ? Version::GL430 :
+        flags & (Flag::Skinning|Flag::TiledLights) ?
+        Context::current().supportedVersion({Version::GL320, Version::GL310}) :
+        Context::current().supportedVersion({Version::GL320, Version::GL310, Version::GL300, Version::GL210});
+    #elif !defined(MAGNUM_TARGET_GLES2)
+    const Version version =
+        #ifndef MAGNUM_TARGET_WEBGL
+        flags & Flag::TiledLights ? Version::GLES320 :
+        flags & Flag::ShaderStorageBuffers ? Version::GLES310 :
+        #endif
+        flags & Flag::Skinning ? Version::GLES300 :
+        Context::current().supportedVersion({Version::GLES300, Version::GLES200});
     #else
     const Version version = Context::current().supportedVersion({Version::GLES300, Version::GLES200});
     #endif
@@ -61,13 +90,31 @@ Phong::Phong(const Flags flags): _flags(flags) {
     Shader vert = Implementation::createCompatibilityShader(rs, version, Shader::Type::Vertex);
     Shader frag = Implementation::createCompatibilityShader(rs, version, Shader::Type::Fragment);
 
-    vert.addSource(flags ? "#define TEXTURED\n" : "")
-        .addSource(rs.get("generic.glsl"))
+    vert.addSource(flags & (Flag::AmbientTexture|Flag::DiffuseTexture|Flag::SpecularTexture) ? "#define TEXTURED\n" : "")
+        .addSource(flags & Flag::InstancedTransformation ? "#define INSTANCED_TRANSFORMATION\n" : "")
+        .addSource(flags & Flag::InstancedColor ? "#define INSTANCED_COLOR\n" : "")
+        .addSource(flags & Flag::DepthOnly ? "#define DEPTH_ONLY\n" : "");
+    #ifndef MAGNUM_TARGET_GLES2
+    if(flags & Flag::Skinning)
+        vert.addSource("#define SKINNING\n#define JOINT_COUNT " + std::to_string(jointCount) + "\n");
+    #endif
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    if(flags & Flag::ShaderStorageBuffers) vert.addSource("#define SHADER_STORAGE_BUFFERS\n");
+    #endif
+    vert.addSource(rs.get("generic.glsl"))
         .addSource(rs.get("Phong.vert"));
     frag.addSource(flags & Flag::AmbientTexture ? "#define AMBIENT_TEXTURE\n" : "")
         .addSource(flags & Flag::DiffuseTexture ? "#define DIFFUSE_TEXTURE\n" : "")
         .addSource(flags & Flag::SpecularTexture ? "#define SPECULAR_TEXTURE\n" : "")
-        .addSource(rs.get("Phong.frag"));
+        .addSource(flags & Flag::InstancedColor ? "#define INSTANCED_COLOR\n" : "")
+        .addSource(flags & Flag::AlphaMask ? "#define ALPHA_MASK\n" : "")
+        .addSource(flags & Flag::DepthOnly ? "#define DEPTH_ONLY\n" : "")
+        .addSource(flags & Flag::MediumPrecision ? "#define MEDIUM_PRECISION\n" : "");
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    if(flags & Flag::TiledLights) frag.addSource("#define TILED_LIGHTS\n");
+    if(flags & Flag::ShaderStorageBuffers) frag.addSource("#define SHADER_STORAGE_BUFFERS\n");
+    #endif
+    frag.addSource(rs.get("Phong.frag"));
 
     CORRADE_INTERNAL_ASSERT_OUTPUT(Shader::compile({vert, frag}));
 
@@ -81,7 +128,16 @@ Phong::Phong(const Flags flags): _flags(flags) {
     {
         bindAttributeLocation(Position::Location, "position");
         bindAttributeLocation(Normal::Location, "normal");
-        if(flags) bindAttributeLocation(TextureCoordinates::Location, "textureCoordinates");
+        if(flags & (Flag::AmbientTexture|Flag::DiffuseTexture|Flag::SpecularTexture))
+            bindAttributeLocation(TextureCoordinates::Location, "textureCoordinates");
+        if(flags & Flag::InstancedTransformation) bindAttributeLocation(TransformationMatrix::Location, "instancedTransformationMatrix");
+        if(flags & Flag::InstancedColor) bindAttributeLocation(Color::Location, "instancedColor");
+        #ifndef MAGNUM_TARGET_GLES2
+        if(flags & Flag::Skinning) {
+            bindAttributeLocation(JointIds::Location, "jointIds");
+            bindAttributeLocation(Weights::Location, "weights");
+        }
+        #endif
     }
 
     CORRADE_INTERNAL_ASSERT_OUTPUT(link());
@@ -90,37 +146,91 @@ Phong::Phong(const Flags flags): _flags(flags) {
     if(!Context::current().isExtensionSupported<Extensions::GL::ARB::explicit_uniform_location>(version))
     #endif
     {
-        _transformationMatrixUniform = uniformLocation("transformationMatrix");
+        /* With shader storage buffers the per-draw values come from the
+           buffer, the remaining locations are reset to -1 below */
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        const bool perDrawUniforms = !(flags & Flag::ShaderStorageBuffers);
+        #else
+        constexpr bool perDrawUniforms = true;
+        #endif
+        if(perDrawUniforms) _transformationMatrixUniform = uniformLocation("transformationMatrix");
         _projectionMatrixUniform = uniformLocation("projectionMatrix");
-        _normalMatrixUniform = uniformLocation("normalMatrix");
-        _lightUniform = uniformLocation("light");
-        _ambientColorUniform = uniformLocation("ambientColor");
-        _diffuseColorUniform = uniformLocation("diffuseColor");
-        _specularColorUniform = uniformLocation("specularColor");
-        _lightColorUniform = uniformLocation("lightColor");
-        _shininessUniform = uniformLocation("shininess");
+        if(!(flags & Flag::DepthOnly)) {
+            _lightUniform = uniformLocation("light");
+            _lightColorUniform = uniformLocation("lightColor");
+            if(perDrawUniforms) {
+                _normalMatrixUniform = uniformLocation("normalMatrix");
+                _ambientColorUniform = uniformLocation("ambientColor");
+                _specularColorUniform = uniformLocation("specularColor");
+                _shininessUniform = uniformLocation("shininess");
+            }
+            #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+            if(flags & Flag::TiledLights) {
+                _lightTileSizeUniform = uniformLocation("lightTileSize");
+                _lightTileCountXUniform = uniformLocation("lightTileCountX");
+            }
+            #endif
+        }
+        if(perDrawUniforms && (!(flags & Flag::DepthOnly) || flags & Flag::AlphaMask))
+            _diffuseColorUniform = uniformLocation("diffuseColor");
+        if(flags & Flag::AlphaMask) _alphaMaskUniform = uniformLocation("alphaMask");
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        if(flags & Flag::ShaderStorageBuffers) _drawOffsetUniform = uniformLocation("drawOffset");
+        #endif
     }
 
     #ifndef MAGNUM_TARGET_GLES
-    if(flags && !Context::current().isExtensionSupported<Extensions::GL::ARB::shading_language_420pack>(version))
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::shading_language_420pack>(version))
     #endif
     {
-        if(flags & Flag::AmbientTexture) setUniform(uniformLocation("ambientTexture"), AmbientTextureLayer);
-        if(flags & Flag::DiffuseTexture) setUniform(uniformLocation("diffuseTexture"), DiffuseTextureLayer);
-        if(flags & Flag::SpecularTexture) setUniform(uniformLocation("specularTexture"), SpecularTextureLayer);
+        /* The depth-only variant uses at most the diffuse texture */
+        if(flags & Flag::AmbientTexture && !(flags & Flag::DepthOnly)) setUniform(uniformLocation("ambientTexture"), AmbientTextureLayer);
+        if(flags & Flag::DiffuseTexture && (!(flags & Flag::DepthOnly) || flags & Flag::AlphaMask)) setUniform(uniformLocation("diffuseTexture"), DiffuseTextureLayer);
+        if(flags & Flag::SpecularTexture && !(flags & Flag::DepthOnly)) setUniform(uniformLocation("specularTexture"), SpecularTextureLayer);
+        #ifndef MAGNUM_TARGET_GLES2
+        if(flags & Flag::Skinning) setUniformBlockBinding(uniformBlockIndex("PhongJoints"), JointBufferBinding);
+        #endif
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        if(flags & Flag::TiledLights && !(flags & Flag::DepthOnly)) {
+            setUniform(uniformLocation("lightData"), LightDataTextureLayer);
+            setUniform(uniformLocation("lightTiles"), LightTileTextureLayer);
+            setUniform(uniformLocation("lightIndices"), LightIndexTextureLayer);
+        }
+        #endif
+    }
+
+    /* The depth-only variant has no lighting, make the setters no-op. GL
+       ignores uniform location -1. */
+    if(flags & Flag::DepthOnly) {
+        _normalMatrixUniform = _lightUniform = _ambientColorUniform =
+            _specularColorUniform = _lightColorUniform = _shininessUniform = -1;
+        if(!(flags & Flag::AlphaMask)) _diffuseColorUniform = -1;
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        _lightTileSizeUniform = _lightTileCountXUniform = -1;
+        #endif
     }
 
+    /* Same for the per-draw setters if the values come from a shader storage
+       buffer */
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    if(flags & Flag::ShaderStorageBuffers)
+        _transformationMatrixUniform = _normalMatrixUniform =
+            _ambientColorUniform = _diffuseColorUniform =
+            _specularColorUniform = _shininessUniform = -1;
+    #endif
+
     /* Set defaults in OpenGL ES (for desktop they are set in shader code itself) */
     #ifdef MAGNUM_TARGET_GLES
     /* Default to fully opaque white so we can see the textures */
     if(flags & Flag::AmbientTexture) setAmbientColor(Color4{1.0f});
     else setAmbientColor(Color4{0.0f, 1.0f});
 
-    if(flags & Flag::DiffuseTexture) setDiffuseColor(Color4{1.0f});
+    if(flags & (Flag::DiffuseTexture|Flag::InstancedColor)) setDiffuseColor(Color4{1.0f});
 
     setSpecularColor(Color4{1.0f});
     setLightColor(Color4{1.0f});
     setShininess(80.0f);
+    if(flags & Flag::AlphaMask) setAlphaMask(0.5f);
     #endif
 }
 
@@ -144,4 +254,59 @@ Phong& Phong::bindTextures(Texture2D* ambient, Texture2D* diffuse, Texture2D* sp
     return *this;
 }
 
+Phong& Phong::setAlphaMask(const Float mask) {
+    CORRADE_ASSERT(_flags & Flag::AlphaMask,
+        "Shaders::Phong::setAlphaMask(): the shader was not created with alpha mask enabled", *this);
+    setUniform(_alphaMaskUniform, mask);
+    return *this;
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+Phong& Phong::bindJointBuffer(Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags & Flag::Skinning,
+        "Shaders::Phong::bindJointBuffer(): the shader was not created with skinning enabled", *this);
+    buffer.bind(Buffer::Target::Uniform, JointBufferBinding, offset, size);
+    return *this;
+}
+
+Phong& Phong::bindJointBuffer(Buffer& buffer) {
+    CORRADE_ASSERT(_flags & Flag::Skinning,
+        "Shaders::Phong::bindJointBuffer(): the shader was not created with skinning enabled", *this);
+    buffer.bind(Buffer::Target::Uniform, JointBufferBinding);
+    return *this;
+}
+#endif
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+Phong& Phong::bindLightGrid(PhongLightGrid& grid) {
+    CORRADE_ASSERT(_flags & Flag::TiledLights,
+        "Shaders::Phong::bindLightGrid(): the shader was not created with tiled lights enabled", *this);
+    AbstractTexture::bind(LightDataTextureLayer, {&grid.lightTexture(), &grid.tileTexture(), &grid.lightIndexTexture()});
+    setUniform(_lightTileSizeUniform, grid.tileSize());
+    setUniform(_lightTileCountXUniform, grid.tileCount().x());
+    return *this;
+}
+
+Phong& Phong::setDrawOffset(const UnsignedInt offset) {
+    CORRADE_ASSERT(_flags & Flag::ShaderStorageBuffers,
+        "Shaders::Phong::setDrawOffset(): the shader was not created with shader storage buffers enabled", *this);
+    setUniform(_drawOffsetUniform, offset);
+    return *this;
+}
+
+Phong& Phong::bindDrawStorageBuffer(Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags & Flag::ShaderStorageBuffers,
+        "Shaders::Phong::bindDrawStorageBuffer(): the shader was not created with shader storage buffers enabled", *this);
+    buffer.bind(Buffer::Target::ShaderStorage, DrawStorageBufferBinding, offset, size);
+    return *this;
+}
+
+Phong& Phong::bindDrawStorageBuffer(Buffer& buffer) {
+    CORRADE_ASSERT(_flags & Flag::ShaderStorageBuffers,
+        "Shaders::Phong::bindDrawStorageBuffer(): the shader was not created with shader storage buffers enabled", *this);
+    buffer.bind(Buffer::Target::ShaderStorage, DrawStorageBufferBinding);
+    return *this;
+}
+#endif
+
 }}
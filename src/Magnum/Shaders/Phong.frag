@@ -42,6 +42,7 @@ uniform lowp vec4 lightColor
     #endif
     ;
 
+#ifndef SHADER_STORAGE_BUFFERS
 #ifdef EXPLICIT_UNIFORM_LOCATION
 layout(location = 8)
 #endif
@@ -50,6 +51,14 @@ uniform mediump float shininess
     = 80.0
     #endif
     ;
+#else
+flat in lowp vec4 diffuseColor;
+#ifndef DEPTH_ONLY
+flat in lowp vec4 ambientColor;
+flat in lowp vec4 specularColor;
+flat in mediump float shininess;
+#endif
+#endif
 
 #ifdef AMBIENT_TEXTURE
 #ifdef EXPLICIT_TEXTURE_LAYER
@@ -58,6 +67,7 @@ layout(binding = 0)
 uniform lowp sampler2D ambientTexture;
 #endif
 
+#ifndef SHADER_STORAGE_BUFFERS
 #ifdef EXPLICIT_UNIFORM_LOCATION
 layout(location = 4)
 #endif
@@ -70,6 +80,7 @@ uniform lowp vec4 ambientColor
     #endif
     #endif
     ;
+#endif
 
 #ifdef DIFFUSE_TEXTURE
 #ifdef EXPLICIT_TEXTURE_LAYER
@@ -78,14 +89,16 @@ layout(binding = 1)
 uniform lowp sampler2D diffuseTexture;
 #endif
 
+#ifndef SHADER_STORAGE_BUFFERS
 #ifdef EXPLICIT_UNIFORM_LOCATION
 layout(location = 5)
 #endif
 uniform lowp vec4 diffuseColor
-    #if !defined(GL_ES) && defined(DIFFUSE_TEXTURE)
+    #if !defined(GL_ES) && (defined(DIFFUSE_TEXTURE) || defined(INSTANCED_COLOR))
     = vec4(1.0)
     #endif
     ;
+#endif
 
 #ifdef SPECULAR_TEXTURE
 #ifdef EXPLICIT_TEXTURE_LAYER
@@ -94,6 +107,7 @@ layout(binding = 2)
 uniform lowp sampler2D specularTexture;
 #endif
 
+#ifndef SHADER_STORAGE_BUFFERS
 #ifdef EXPLICIT_UNIFORM_LOCATION
 layout(location = 6)
 #endif
@@ -102,30 +116,95 @@ uniform lowp vec4 specularColor
     = vec4(1.0)
     #endif
     ;
+#endif
+
+#ifdef ALPHA_MASK
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 11)
+#endif
+uniform lowp float alphaMask
+    #ifndef GL_ES
+    = 0.5
+    #endif
+    ;
+#endif
+
+/* Precision of the single-light calculation. Tiled lights reconstruct the
+   fragment position from the camera direction, which needs highp. */
+#if defined(MEDIUM_PRECISION) && !defined(TILED_LIGHTS)
+#define lightp mediump
+#else
+#define lightp highp
+#endif
 
+#ifndef DEPTH_ONLY
 in mediump vec3 transformedNormal;
-in highp vec3 lightDirection;
-in highp vec3 cameraDirection;
+in lightp vec3 lightDirection;
+in lightp vec3 cameraDirection;
+#endif
 
 #if defined(AMBIENT_TEXTURE) || defined(DIFFUSE_TEXTURE) || defined(SPECULAR_TEXTURE)
 in mediump vec2 interpolatedTextureCoords;
 #endif
 
-#ifdef NEW_GLSL
+#ifdef INSTANCED_COLOR
+in lowp vec4 interpolatedInstancedColor;
+#endif
+
+#if defined(TILED_LIGHTS) && !defined(DEPTH_ONLY)
+#ifdef EXPLICIT_TEXTURE_LAYER
+layout(binding = 3)
+#endif
+uniform highp samplerBuffer lightData;
+
+#ifdef EXPLICIT_TEXTURE_LAYER
+layout(binding = 4)
+#endif
+uniform highp usamplerBuffer lightTiles;
+
+#ifdef EXPLICIT_TEXTURE_LAYER
+layout(binding = 5)
+#endif
+uniform highp usamplerBuffer lightIndices;
+
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 9)
+#endif
+uniform mediump int lightTileSize;
+
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 10)
+#endif
+uniform mediump int lightTileCountX;
+#endif
+
+#if defined(NEW_GLSL) && !defined(DEPTH_ONLY)
 out lowp vec4 color;
 #endif
 
 void main() {
-    lowp const vec4 finalAmbientColor =
-        #ifdef AMBIENT_TEXTURE
-        texture(ambientTexture, interpolatedTextureCoords)*
-        #endif
-        ambientColor;
     lowp const vec4 finalDiffuseColor =
         #ifdef DIFFUSE_TEXTURE
         texture(diffuseTexture, interpolatedTextureCoords)*
         #endif
+        #ifdef INSTANCED_COLOR
+        interpolatedInstancedColor*
+        #endif
         diffuseColor;
+
+    #ifdef ALPHA_MASK
+    if(finalDiffuseColor.a < alphaMask) discard;
+    #endif
+
+    #ifndef DEPTH_ONLY
+    lowp const vec4 finalAmbientColor =
+        #ifdef AMBIENT_TEXTURE
+        texture(ambientTexture, interpolatedTextureCoords)*
+        #endif
+        #ifdef INSTANCED_COLOR
+        interpolatedInstancedColor*
+        #endif
+        ambientColor;
     lowp const vec4 finalSpecularColor =
         #ifdef SPECULAR_TEXTURE
         texture(specularTexture, interpolatedTextureCoords)*
@@ -136,7 +215,7 @@ void main() {
     color = finalAmbientColor;
 
     mediump vec3 normalizedTransformedNormal = normalize(transformedNormal);
-    highp vec3 normalizedLightDirection = normalize(lightDirection);
+    lightp vec3 normalizedLightDirection = normalize(lightDirection);
 
     /* Add diffuse color */
     lowp float intensity = max(0.0, dot(normalizedTransformedNormal, normalizedLightDirection));
@@ -144,8 +223,39 @@ void main() {
 
     /* Add specular color, if needed */
     if(intensity > 0.001) {
-        highp vec3 reflection = reflect(-normalizedLightDirection, normalizedTransformedNormal);
+        lightp vec3 reflection = reflect(-normalizedLightDirection, normalizedTransformedNormal);
         mediump float specularity = pow(max(0.0, dot(normalize(cameraDirection), reflection)), shininess);
         color += finalSpecularColor*specularity;
     }
+
+    #ifdef TILED_LIGHTS
+    /* Add lights from the tile this fragment is in */
+    highp vec3 position = -cameraDirection;
+    highp ivec2 tile = ivec2(gl_FragCoord.xy)/lightTileSize;
+    highp uvec2 tileLights = texelFetch(lightTiles, tile.y*lightTileCountX + tile.x).xy;
+    for(highp uint i = tileLights.x, end = tileLights.x + tileLights.y; i != end; ++i) {
+        highp int lightId = int(texelFetch(lightIndices, int(i)).x);
+        highp vec4 lightPositionRange = texelFetch(lightData, 2*lightId);
+        lowp vec3 tiledLightColor = texelFetch(lightData, 2*lightId + 1).rgb;
+
+        highp vec3 tiledLightVector = lightPositionRange.xyz - position;
+        highp float tiledLightDistance = length(tiledLightVector);
+        if(tiledLightDistance >= lightPositionRange.w) continue;
+
+        /* Smooth falloff reaching zero at the light range */
+        highp float attenuation = 1.0 - tiledLightDistance/lightPositionRange.w;
+        attenuation *= attenuation;
+
+        highp vec3 tiledLightDirection = tiledLightVector/tiledLightDistance;
+        lowp float tiledIntensity = max(0.0, dot(normalizedTransformedNormal, tiledLightDirection));
+        color.rgb += finalDiffuseColor.rgb*tiledLightColor*tiledIntensity*attenuation;
+
+        if(tiledIntensity > 0.001) {
+            highp vec3 reflection = reflect(-tiledLightDirection, normalizedTransformedNormal);
+            mediump float specularity = pow(max(0.0, dot(normalize(cameraDirection), reflection)), shininess);
+            color.rgb += finalSpecularColor.rgb*tiledLightColor*specularity*attenuation;
+        }
+    }
+    #endif
+    #endif
 }
@@ -26,17 +26,94 @@
 */
 
 /** @file
- * @brief Class @ref Magnum::Shaders::Phong
+ * @brief Class @ref Magnum::Shaders::Phong, struct @ref Magnum::Shaders::PhongDrawUniform
  */
 
 #include "Magnum/AbstractShaderProgram.h"
 #include "Magnum/Math/Color.h"
 #include "Magnum/Math/Matrix4.h"
+#include "Magnum/Std140.h"
 #include "Magnum/Shaders/Generic.h"
+#include "Magnum/Shaders/Shaders.h"
 #include "Magnum/Shaders/visibility.h"
 
 namespace Magnum { namespace Shaders {
 
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+/**
+@brief Per-draw shader storage buffer item of the Phong shader
+
+Element of the @glsl PhongDraws @ce shader storage buffer used by @ref Phong
+with @ref Phong::Flag::ShaderStorageBuffers enabled. The structure is laid out
+according to std430 rules, so an array of these can be directly uploaded to
+the buffer with no gaps between the items. See
+@ref Shaders-Phong-shader-storage-buffers for more information.
+@requires_gl43 Extension @extension{ARB,shader_storage_buffer_object}
+@requires_gles31 Shader storage buffers are not available in OpenGL ES 3.0 and
+    older.
+@requires_gles Shader storage buffers are not available in WebGL.
+*/
+struct PhongDrawUniform {
+    /**
+     * @brief Default constructor
+     *
+     * Sets the matrices to identity, ambient color to
+     * @cpp 0x000000ff_rgbaf @ce, diffuse and specular color to
+     * @cpp 0xffffffff_rgbaf @ce and shininess to @cpp 80.0f @ce.
+     */
+    /*implicit*/ PhongDrawUniform() noexcept: ambientColor{0.0f, 1.0f}, diffuseColor{1.0f}, specularColor{1.0f}, shininess{80.0f}, _padding{} {}
+
+    /**
+     * @brief Transformation matrix
+     *
+     * @see @ref Phong::setTransformationMatrix()
+     */
+    Matrix4 transformationMatrix;
+
+    /**
+     * @brief Normal matrix
+     *
+     * @see @ref Phong::setNormalMatrix()
+     */
+    Std140::Matrix3 normalMatrix;
+
+    /**
+     * @brief Ambient color
+     *
+     * @see @ref Phong::setAmbientColor()
+     */
+    Color4 ambientColor;
+
+    /**
+     * @brief Diffuse color
+     *
+     * @see @ref Phong::setDiffuseColor()
+     */
+    Color4 diffuseColor;
+
+    /**
+     * @brief Specular color
+     *
+     * @see @ref Phong::setSpecularColor()
+     */
+    Color4 specularColor;
+
+    /**
+     * @brief Shininess
+     *
+     * @see @ref Phong::setShininess()
+     */
+    Float shininess;
+
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    private:
+        Float _padding[3];
+    #endif
+};
+
+static_assert(sizeof(PhongDrawUniform) == 176, "Improper size of PhongDrawUniform");
+#endif
+
 /**
 @brief Phong shader
 
@@ -86,6 +163,96 @@ part and then separate the alpha like this:
 
 @snippet MagnumShaders.cpp Phong-usage-alpha
 
+@subsection Shaders-Phong-instancing Instanced drawing
+
+Many copies of the same mesh can be drawn with a single @ref Mesh::draw() call
+by enabling @ref Flag::InstancedTransformation and/or @ref Flag::InstancedColor.
+The per-instance @ref TransformationMatrix and @ref Color attributes are then
+read from a buffer attached using @ref Mesh::addVertexBufferInstanced(). The
+matrices set via @ref setTransformationMatrix() and @ref setNormalMatrix() are
+applied on top of the per-instance transformation, so they usually contain
+just the camera matrix and its rotation part. The normals are transformed with
+the upper-left 3x3 part of the per-instance transformation, which is correct
+only if it doesn't contain non-uniform scaling. The per-instance color is
+multiplied with the ambient and diffuse color, the diffuse color defaults to
+fully opaque white in this case. The instance data layout matches
+@ref SceneGraph::InstancedDrawableGroup::InstanceData:
+
+@snippet MagnumShaders.cpp Phong-usage-instancing
+
+@subsection Shaders-Phong-skinning Skinning
+
+If the shader is created with @ref Flag::Skinning, vertex positions and
+normals are deformed by a palette of joint matrices before applying the
+transformation. Each vertex references up to four joints through the
+@ref JointIds attribute, with their influence given by @ref Weights. The
+palette is read from the @glsl PhongJoints @ce uniform block, which is a
+tightly packed array of @ref Magnum::Matrix4 "Matrix4" with size given by the
+joint count passed to the constructor, bound with @ref bindJointBuffer(). The
+vertex buffers thus stay static and only the palette needs to be updated every
+frame, which is a fraction of the vertex data size:
+
+@snippet MagnumShaders.cpp Phong-usage-skinning
+
+Similarly to instancing, the joint matrices are expected to be rigid
+transformations with uniform scaling, as normals are transformed with their
+upper-left 3x3 part.
+
+@subsection Shaders-Phong-tiled-lights Tiled lighting
+
+Besides the single light set via @ref setLightPosition(), the shader created
+with @ref Flag::TiledLights evaluates point lights from a
+@ref PhongLightGrid. The grid splits the viewport into tiles and each fragment
+evaluates only the lights listed in its tile, so a scene with hundreds of
+small lights can be drawn in a single pass. The grid has to be rebuilt with
+@ref PhongLightGrid::setLights() every time the lights or the camera change,
+the lights are specified in camera space:
+
+@snippet MagnumShaders.cpp Phong-usage-tiled-lights
+
+@subsection Shaders-Phong-depth-only Alpha masking and depth pre-pass
+
+With @ref Flag::AlphaMask the fragments with alpha of the final diffuse color
+lower than @ref setAlphaMask() are discarded. With @ref Flag::DepthOnly the
+shader skips all lighting calculation and doesn't produce any color output,
+while still supporting instancing and skinning. In overdraw-heavy scenes the
+depth can be rendered with it first and the full shader then runs only once
+for each visible pixel. The vertex transformation is declared as
+@glsl invariant @ce, so both variants produce exactly the same depth values:
+
+@snippet MagnumShaders.cpp Phong-usage-depth-only
+
+See also @ref SceneGraph::Camera::drawDepth().
+
+@subsection Shaders-Phong-shader-storage-buffers Shader storage buffers
+
+With @ref Flag::ShaderStorageBuffers the transformation, normal matrix and
+material of all draws are read from the @glsl PhongDraws @ce shader storage
+buffer, which is a tightly packed array of @ref PhongDrawUniform bound with
+@ref bindDrawStorageBuffer(). Each draw selects its item with
+@ref setDrawOffset(), each instance of an instanced draw reads the item
+following the previous one, so thousands of objects can share a single buffer
+upload. The projection matrix, light position and light color stay ordinary
+uniforms and @ref setTransformationMatrix(), @ref setNormalMatrix(),
+@ref setAmbientColor(), @ref setDiffuseColor(), @ref setSpecularColor() and
+@ref setShininess() have no effect. See
+@ref Shaders-Flat-shader-storage-buffers for a complete example.
+
+@subsection Shaders-Phong-precision Reduced precision
+
+All colors and texture lookups in the fragment shader are done in
+@glsl lowp @ce or @glsl mediump @ce precision, but light and camera
+directions use @glsl highp @ce to stay accurate for large scenes. Many mobile
+GPUs evaluate @glsl mediump @ce math with up to twice the throughput and with
+lower register pressure, so with @ref Flag::MediumPrecision the per-fragment
+lighting of the single light set via @ref setLightPosition() is done in
+@glsl mediump @ce as well. The output differs from the default by at most one
+or two least significant bits for scenes up to a few hundred units in size,
+but the specular highlight may get noticeably blocky if the light or camera is
+further away. The flag has an effect only on OpenGL ES and WebGL, where the
+precision qualifiers are honored, and it's ignored when combined with
+@ref Flag::TiledLights, which need the camera direction in @glsl highp @ce.
+
 @see @ref shaders
 */
 class MAGNUM_SHADERS_EXPORT Phong: public AbstractShaderProgram {
@@ -113,15 +280,174 @@ class MAGNUM_SHADERS_EXPORT Phong: public AbstractShaderProgram {
          */
         typedef Generic3D::TextureCoordinates TextureCoordinates;
 
+        /**
+         * @brief Per-instance transformation matrix
+         *
+         * @ref shaders-generic "Generic attribute", @ref Matrix4. Used only if
+         * @ref Flag::InstancedTransformation is set.
+         * @requires_gl33 Extension @extension{ARB,instanced_arrays}
+         * @requires_gles30 Extension @extension{ANGLE,instanced_arrays},
+         *      @extension{EXT,instanced_arrays} or
+         *      @extension{NV,instanced_arrays} in OpenGL ES 2.0.
+         * @requires_webgl20 Extension
+         *      @webgl_extension{ANGLE,instanced_arrays} in WebGL 1.0.
+         */
+        typedef Generic3D::TransformationMatrix TransformationMatrix;
+
+        /**
+         * @brief Per-instance color
+         *
+         * @ref shaders-generic "Generic attribute", @ref Color4. Used only if
+         * @ref Flag::InstancedColor is set.
+         * @requires_gl33 Extension @extension{ARB,instanced_arrays}
+         * @requires_gles30 Extension @extension{ANGLE,instanced_arrays},
+         *      @extension{EXT,instanced_arrays} or
+         *      @extension{NV,instanced_arrays} in OpenGL ES 2.0.
+         * @requires_webgl20 Extension
+         *      @webgl_extension{ANGLE,instanced_arrays} in WebGL 1.0.
+         */
+        typedef Generic3D::Color Color;
+
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Joint IDs
+         *
+         * @ref shaders-generic "Generic attribute", @ref Vector4ui. Used only
+         * if @ref Flag::Skinning is set.
+         * @requires_gl31 Extension @extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Skinning is not available in OpenGL ES 2.0.
+         * @requires_webgl20 Skinning is not available in WebGL 1.0.
+         */
+        typedef Generic3D::JointIds JointIds;
+
+        /**
+         * @brief Joint weights
+         *
+         * @ref shaders-generic "Generic attribute", @ref Vector4. Used only if
+         * @ref Flag::Skinning is set.
+         * @requires_gl31 Extension @extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Skinning is not available in OpenGL ES 2.0.
+         * @requires_webgl20 Skinning is not available in WebGL 1.0.
+         */
+        typedef Generic3D::Weights Weights;
+
+        enum: UnsignedInt {
+            /**
+             * Uniform buffer binding for the @glsl PhongJoints @ce block.
+             * Used if @ref Flag::Skinning is set.
+             * @see @ref bindJointBuffer()
+             */
+            JointBufferBinding = 0
+        };
+        #endif
+
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        enum: UnsignedInt {
+            /**
+             * Shader storage buffer binding for the @glsl PhongDraws @ce
+             * block. Used if @ref Flag::ShaderStorageBuffers is set.
+             * @see @ref bindDrawStorageBuffer()
+             */
+            DrawStorageBufferBinding = 0
+        };
+        #endif
+
         /**
          * @brief Flag
          *
          * @see @ref Flags, @ref flags()
          */
-        enum class Flag: UnsignedByte {
+        enum class Flag: UnsignedShort {
             AmbientTexture = 1 << 0,    /**< The shader uses ambient texture instead of color */
             DiffuseTexture = 1 << 1,    /**< The shader uses diffuse texture instead of color */
-            SpecularTexture = 1 << 2    /**< The shader uses specular texture instead of color */
+            SpecularTexture = 1 << 2,   /**< The shader uses specular texture instead of color */
+
+            /**
+             * Multiply the transformation with a per-instance
+             * @ref TransformationMatrix attribute. See
+             * @ref Shaders-Phong-instancing for more information.
+             * @requires_gl33 Extension @extension{ARB,instanced_arrays}
+             * @requires_gles30 Extension @extension{ANGLE,instanced_arrays},
+             *      @extension{EXT,instanced_arrays} or
+             *      @extension{NV,instanced_arrays} in OpenGL ES 2.0.
+             * @requires_webgl20 Extension
+             *      @webgl_extension{ANGLE,instanced_arrays} in WebGL 1.0.
+             */
+            InstancedTransformation = 1 << 3,
+
+            /**
+             * Multiply the ambient and diffuse color with a per-instance
+             * @ref Color attribute. See @ref Shaders-Phong-instancing for
+             * more information.
+             * @requires_gl33 Extension @extension{ARB,instanced_arrays}
+             * @requires_gles30 Extension @extension{ANGLE,instanced_arrays},
+             *      @extension{EXT,instanced_arrays} or
+             *      @extension{NV,instanced_arrays} in OpenGL ES 2.0.
+             * @requires_webgl20 Extension
+             *      @webgl_extension{ANGLE,instanced_arrays} in WebGL 1.0.
+             */
+            InstancedColor = 1 << 4,
+
+            #ifndef MAGNUM_TARGET_GLES2
+            /**
+             * Deform the mesh using a joint matrix palette. See
+             * @ref Shaders-Phong-skinning for more information.
+             * @requires_gl31 Extension @extension{ARB,uniform_buffer_object}
+             * @requires_gles30 Skinning is not available in OpenGL ES 2.0.
+             * @requires_webgl20 Skinning is not available in WebGL 1.0.
+             */
+            Skinning = 1 << 5,
+            #endif
+
+            #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+            /**
+             * Add point lights from a @ref PhongLightGrid bound with
+             * @ref bindLightGrid(). See @ref Shaders-Phong-tiled-lights for
+             * more information.
+             * @requires_gl31 Extension @extension{ARB,texture_buffer_object}
+             * @requires_gles32 Buffer textures are not available in OpenGL
+             *      ES 3.1 and older.
+             * @requires_gles Buffer textures are not available in WebGL.
+             */
+            TiledLights = 1 << 6,
+            #endif
+
+            /**
+             * Discard fragments with alpha of the diffuse color lower than
+             * the value set via @ref setAlphaMask(). See
+             * @ref Shaders-Phong-depth-only for more information.
+             */
+            AlphaMask = 1 << 7,
+
+            /**
+             * Don't produce any color output, only depth. Only the diffuse
+             * color and texture are used and only if @ref Flag::AlphaMask
+             * is set as well, the lighting uniforms have no effect. See
+             * @ref Shaders-Phong-depth-only for more information.
+             */
+            DepthOnly = 1 << 8,
+
+            #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+            /**
+             * Take the per-draw transformation and material from the
+             * @glsl PhongDraws @ce shader storage buffer instead of uniforms.
+             * See @ref Shaders-Phong-shader-storage-buffers for more
+             * information.
+             * @requires_gl43 Extension @extension{ARB,shader_storage_buffer_object}
+             * @requires_gles31 Shader storage buffers are not available in
+             *      OpenGL ES 3.0 and older.
+             * @requires_gles Shader storage buffers are not available in
+             *      WebGL.
+             */
+            ShaderStorageBuffers = 1 << 9,
+            #endif
+
+            /**
+             * Evaluate the per-fragment lighting in @glsl mediump @ce
+             * instead of @glsl highp @ce precision. See
+             * @ref Shaders-Phong-precision for more information.
+             */
+            MediumPrecision = 1 << 10
         };
 
         /**
@@ -133,9 +459,15 @@ class MAGNUM_SHADERS_EXPORT Phong: public AbstractShaderProgram {
 
         /**
          * @brief Constructor
-         * @param flags     Flags
+         * @param flags         Flags
+         * @param jointCount    Size of the joint matrix palette
+         *
+         * The @p jointCount is expected to be non-zero if and only if
+         * @ref Flag::Skinning is set. The whole palette has to fit into
+         * @ref maxUniformBlockSize(), which is guaranteed to be at least
+         * 16 kB, i.e. 256 joints.
          */
-        explicit Phong(Flags flags = {});
+        explicit Phong(Flags flags = {}, UnsignedInt jointCount = 0);
 
         /**
          * @brief Construct without creating the underlying OpenGL object
@@ -152,6 +484,14 @@ class MAGNUM_SHADERS_EXPORT Phong: public AbstractShaderProgram {
         /** @brief Flags */
         Flags flags() const { return _flags; }
 
+        /**
+         * @brief Joint count
+         *
+         * Size of the joint matrix palette, @cpp 0 @ce if @ref Flag::Skinning
+         * is not set.
+         */
+        UnsignedInt jointCount() const { return _jointCount; }
+
         /**
          * @brief Set ambient color
          * @return Reference to self (for method chaining)
@@ -188,9 +528,9 @@ class MAGNUM_SHADERS_EXPORT Phong: public AbstractShaderProgram {
          * @brief Set diffuse color
          * @return Reference to self (for method chaining)
          *
-         * If @ref Flag::DiffuseTexture is set, default value is
-         * @cpp 0xffffffff_rgbaf @ce and the color will be multiplied with
-         * diffuse texture.
+         * If @ref Flag::DiffuseTexture or @ref Flag::InstancedColor is set,
+         * default value is @cpp 0xffffffff_rgbaf @ce and the color will be
+         * multiplied with diffuse texture and per-instance color.
          * @see @ref bindDiffuseTexture()
          */
         Phong& setDiffuseColor(const Color4& color) {
@@ -261,6 +601,106 @@ class MAGNUM_SHADERS_EXPORT Phong: public AbstractShaderProgram {
          */
         Phong& bindTextures(Texture2D* ambient, Texture2D* diffuse, Texture2D* specular);
 
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Bind a joint matrix palette buffer range
+         * @param buffer    Buffer containing @ref jointCount() matrices
+         * @param offset    Offset of the palette in @p buffer
+         * @param size      Size of the range, usually
+         *      @cpp jointCount()*sizeof(Matrix4) @ce
+         * @return Reference to self (for method chaining)
+         *
+         * Equivalent to calling @ref Buffer::bind(Buffer::Target, UnsignedInt, GLintptr, GLsizeiptr)
+         * with @ref Buffer::Target::Uniform and @ref JointBufferBinding.
+         * Expects that @ref Flag::Skinning is set. The @p offset is expected
+         * to be a multiple of @ref Buffer::uniformOffsetAlignment().
+         * @requires_gl31 Extension @extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Skinning is not available in OpenGL ES 2.0.
+         * @requires_webgl20 Skinning is not available in WebGL 1.0.
+         */
+        Phong& bindJointBuffer(Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Bind a joint matrix palette buffer
+         * @return Reference to self (for method chaining)
+         *
+         * Binds the whole @p buffer, which is expected to start with
+         * @ref jointCount() matrices. Expects that @ref Flag::Skinning is
+         * set.
+         * @requires_gl31 Extension @extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Skinning is not available in OpenGL ES 2.0.
+         * @requires_webgl20 Skinning is not available in WebGL 1.0.
+         */
+        Phong& bindJointBuffer(Buffer& buffer);
+        #endif
+
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        /**
+         * @brief Bind a light grid
+         * @return Reference to self (for method chaining)
+         *
+         * Binds the buffer textures of @p grid and sets up tile size and
+         * count. Expects that @ref Flag::TiledLights is set. The grid has to
+         * be built for the same viewport and projection the mesh is drawn
+         * with.
+         * @requires_gl31 Extension @extension{ARB,texture_buffer_object}
+         * @requires_gles32 Buffer textures are not available in OpenGL ES
+         *      3.1 and older.
+         * @requires_gles Buffer textures are not available in WebGL.
+         */
+        Phong& bindLightGrid(PhongLightGrid& grid);
+
+        /**
+         * @brief Set draw offset
+         * @return Reference to self (for method chaining)
+         *
+         * Index of the @ref PhongDrawUniform in the buffer bound with
+         * @ref bindDrawStorageBuffer() used by the first instance of the
+         * draw, each following instance uses the next item. Expects that
+         * @ref Flag::ShaderStorageBuffers is set. Initial value is
+         * @cpp 0 @ce.
+         * @requires_gl43 Extension @extension{ARB,shader_storage_buffer_object}
+         * @requires_gles31 Shader storage buffers are not available in
+         *      OpenGL ES 3.0 and older.
+         * @requires_gles Shader storage buffers are not available in WebGL.
+         */
+        Phong& setDrawOffset(UnsignedInt offset);
+
+        /**
+         * @brief Bind a per-draw shader storage buffer range
+         * @param buffer    Buffer containing tightly packed
+         *      @ref PhongDrawUniform items
+         * @param offset    Offset of the first item in @p buffer
+         * @param size      Size of the range
+         * @return Reference to self (for method chaining)
+         *
+         * Equivalent to calling @ref Buffer::bind(Buffer::Target, UnsignedInt, GLintptr, GLsizeiptr)
+         * with @ref Buffer::Target::ShaderStorage and
+         * @ref DrawStorageBufferBinding. Expects that
+         * @ref Flag::ShaderStorageBuffers is set. The @p offset is expected
+         * to be a multiple of @ref Buffer::shaderStorageOffsetAlignment().
+         * @requires_gl43 Extension @extension{ARB,shader_storage_buffer_object}
+         * @requires_gles31 Shader storage buffers are not available in
+         *      OpenGL ES 3.0 and older.
+         * @requires_gles Shader storage buffers are not available in WebGL.
+         */
+        Phong& bindDrawStorageBuffer(Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Bind a per-draw shader storage buffer
+         * @return Reference to self (for method chaining)
+         *
+         * Binds the whole @p buffer, which is expected to contain tightly
+         * packed @ref PhongDrawUniform items. Expects that
+         * @ref Flag::ShaderStorageBuffers is set.
+         * @requires_gl43 Extension @extension{ARB,shader_storage_buffer_object}
+         * @requires_gles31 Shader storage buffers are not available in
+         *      OpenGL ES 3.0 and older.
+         * @requires_gles Shader storage buffers are not available in WebGL.
+         */
+        Phong& bindDrawStorageBuffer(Buffer& buffer);
+        #endif
+
         #ifdef MAGNUM_BUILD_DEPRECATED
         /** @brief @copybrief bindTextures()
          * @deprecated Use @ref bindTextures() instead.
@@ -296,7 +736,9 @@ class MAGNUM_SHADERS_EXPORT Phong: public AbstractShaderProgram {
          * @return Reference to self (for method chaining)
          *
          * The matrix doesn't need to be normalized, as the renormalization
-         * must be done in the shader anyway.
+         * must be done in the shader anyway. For transformations with
+         * non-uniform scaling use @ref Math::Matrix4::normalMatrix(), for
+         * rigid transformations @ref Math::Matrix4::rotation() is enough.
          */
         Phong& setNormalMatrix(const Matrix3x3& matrix) {
             setUniform(_normalMatrixUniform, matrix);
@@ -332,8 +774,19 @@ class MAGNUM_SHADERS_EXPORT Phong: public AbstractShaderProgram {
             return *this;
         }
 
+        /**
+         * @brief Set alpha mask value
+         * @return Reference to self (for method chaining)
+         *
+         * Fragments with alpha of the diffuse color lower than this value are
+         * discarded. Expects that @ref Flag::AlphaMask is set. Initial value
+         * is @cpp 0.5f @ce.
+         */
+        Phong& setAlphaMask(Float mask);
+
     private:
         Flags _flags;
+        UnsignedInt _jointCount{};
         Int _transformationMatrixUniform{0},
             _projectionMatrixUniform{1},
             _normalMatrixUniform{2},
@@ -342,7 +795,13 @@ class MAGNUM_SHADERS_EXPORT Phong: public AbstractShaderProgram {
             _diffuseColorUniform{5},
             _specularColorUniform{6},
             _lightColorUniform{7},
-            _shininessUniform{8};
+            _shininessUniform{8},
+            _alphaMaskUniform{11};
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        Int _lightTileSizeUniform{9},
+            _lightTileCountXUniform{10},
+            _drawOffsetUniform{12};
+        #endif
 };
 
 CORRADE_ENUMSET_OPERATORS(Phong::Flags)
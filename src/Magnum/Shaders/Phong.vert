@@ -28,20 +28,52 @@
 #define out varying
 #endif
 
+#ifndef SHADER_STORAGE_BUFFERS
 #ifdef EXPLICIT_UNIFORM_LOCATION
 layout(location = 0)
 #endif
 uniform highp mat4 transformationMatrix;
+#endif
 
 #ifdef EXPLICIT_UNIFORM_LOCATION
 layout(location = 1)
 #endif
 uniform highp mat4 projectionMatrix;
 
+#ifndef SHADER_STORAGE_BUFFERS
 #ifdef EXPLICIT_UNIFORM_LOCATION
 layout(location = 2)
 #endif
 uniform mediump mat3 normalMatrix;
+#else
+/* Same layout as Shaders::PhongDrawUniform */
+struct PhongDrawData {
+    highp mat4 transformationMatrix;
+    mediump mat3 normalMatrix;
+    lowp vec4 ambientColor;
+    lowp vec4 diffuseColor;
+    lowp vec4 specularColor;
+    mediump float shininess;
+};
+
+layout(std430, binding = 0) readonly buffer PhongDraws {
+    PhongDrawData draws[];
+};
+
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 12)
+#endif
+uniform highp uint drawOffset;
+
+/* Passed to the fragment shader under the same names as the uniforms they
+   replace, so it doesn't need to access the buffer */
+flat out lowp vec4 diffuseColor;
+#ifndef DEPTH_ONLY
+flat out lowp vec4 ambientColor;
+flat out lowp vec4 specularColor;
+flat out mediump float shininess;
+#endif
+#endif
 
 #ifdef EXPLICIT_UNIFORM_LOCATION
 layout(location = 3)
@@ -67,23 +99,108 @@ in mediump vec2 textureCoords;
 out mediump vec2 interpolatedTextureCoords;
 #endif
 
+#ifndef DEPTH_ONLY
 out mediump vec3 transformedNormal;
 out highp vec3 lightDirection;
 out highp vec3 cameraDirection;
+#endif
+
+#ifdef INSTANCED_TRANSFORMATION
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = TRANSFORMATION_MATRIX_ATTRIBUTE_LOCATION)
+#endif
+in highp mat4 instancedTransformationMatrix;
+#endif
+
+#ifdef INSTANCED_COLOR
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = COLOR_ATTRIBUTE_LOCATION)
+#endif
+in lowp vec4 instancedColor;
+
+out lowp vec4 interpolatedInstancedColor;
+#endif
+
+#ifdef SKINNING
+#ifdef EXPLICIT_BINDING
+layout(std140, binding = 0)
+#else
+layout(std140)
+#endif
+uniform PhongJoints {
+    highp mat4 jointMatrices[JOINT_COUNT];
+};
+
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = JOINT_IDS_ATTRIBUTE_LOCATION)
+#endif
+in mediump uvec4 jointIds;
+
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = WEIGHTS_ATTRIBUTE_LOCATION)
+#endif
+in mediump vec4 weights;
+#endif
+
+/* So the depth-only variant gives exactly the same depth */
+invariant gl_Position;
 
 void main() {
+    #ifdef SHADER_STORAGE_BUFFERS
+    highp uint drawId = drawOffset + uint(gl_InstanceID);
+    highp mat4 transformationMatrix = draws[drawId].transformationMatrix;
+    diffuseColor = draws[drawId].diffuseColor;
+    #ifndef DEPTH_ONLY
+    mediump mat3 normalMatrix = draws[drawId].normalMatrix;
+    ambientColor = draws[drawId].ambientColor;
+    specularColor = draws[drawId].specularColor;
+    shininess = draws[drawId].shininess;
+    #endif
+    #endif
+
+    #ifdef SKINNING
+    /* Blend the joint matrices affecting this vertex */
+    highp mat4 skinMatrix =
+        weights.x*jointMatrices[jointIds.x] +
+        weights.y*jointMatrices[jointIds.y] +
+        weights.z*jointMatrices[jointIds.z] +
+        weights.w*jointMatrices[jointIds.w];
+    #endif
+
     /* Transformed vertex position */
-    highp vec4 transformedPosition4 = transformationMatrix*position;
+    highp vec4 transformedPosition4 = transformationMatrix*
+        #ifdef INSTANCED_TRANSFORMATION
+        instancedTransformationMatrix*
+        #endif
+        #ifdef SKINNING
+        skinMatrix*
+        #endif
+        position;
+
+    #ifndef DEPTH_ONLY
     highp vec3 transformedPosition = transformedPosition4.xyz/transformedPosition4.w;
 
-    /* Transformed normal vector */
-    transformedNormal = normalMatrix*normal;
+    /* Transformed normal vector. The per-instance rotation is extracted from
+       the upper-left 3x3 part (GLSL ES 1.00 has no matrix-from-matrix
+       constructor), which is correct only for rigid transformations with
+       uniform scaling. */
+    transformedNormal = normalMatrix*
+        #ifdef INSTANCED_TRANSFORMATION
+        mat3(instancedTransformationMatrix[0].xyz,
+             instancedTransformationMatrix[1].xyz,
+             instancedTransformationMatrix[2].xyz)*
+        #endif
+        #ifdef SKINNING
+        mat3(skinMatrix[0].xyz, skinMatrix[1].xyz, skinMatrix[2].xyz)*
+        #endif
+        normal;
 
     /* Direction to the light */
     lightDirection = normalize(light - transformedPosition);
 
     /* Direction to the camera */
     cameraDirection = -transformedPosition;
+    #endif
 
     /* Transform the position */
     gl_Position = projectionMatrix*transformedPosition4;
@@ -92,4 +209,9 @@ void main() {
     /* Texture coordinates, if needed */
     interpolatedTextureCoords = textureCoords;
     #endif
+
+    #ifdef INSTANCED_COLOR
+    /* Per-instance color, if needed */
+    interpolatedInstancedColor = instancedColor;
+    #endif
 }
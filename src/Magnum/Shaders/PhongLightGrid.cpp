@@ -0,0 +1,125 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "PhongLightGrid.h"
+
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/BufferTextureFormat.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Range.h"
+
+namespace Magnum { namespace Shaders {
+
+PhongLightGrid::PhongLightGrid(const Int tileSize): _tileSize{tileSize}, _lightBuffer{Buffer::TargetHint::Texture}, _tileBuffer{Buffer::TargetHint::Texture}, _lightIndexBuffer{Buffer::TargetHint::Texture} {
+    CORRADE_ASSERT(tileSize > 0,
+        "Shaders::PhongLightGrid: expected positive tile size, got" << tileSize, );
+}
+
+PhongLightGrid& PhongLightGrid::setLights(const Matrix4& projectionMatrix, const Vector2i& viewportSize, const Containers::ArrayView<const PhongLight> lights) {
+    _tileCount = (viewportSize + Vector2i{_tileSize - 1})/_tileSize;
+    _lightCount = lights.size();
+
+    /* Calculate range of tiles affected by each light, empty range if the
+       light is not visible */
+    const Vector2 tileScale = Vector2{viewportSize}/Float(_tileSize);
+    std::vector<Range2Di> ranges(lights.size());
+    for(std::size_t i = 0; i != lights.size(); ++i) {
+        const PhongLight& light = lights[i];
+
+        /* Completely behind the camera */
+        if(light.position.z() - light.range >= 0.0f) continue;
+
+        /* Intersecting the camera plane, the projection would be degenerate,
+           so just assign it to all tiles */
+        if(light.position.z() + light.range >= 0.0f) {
+            ranges[i] = {{}, _tileCount};
+            continue;
+        }
+
+        /* Project corners of the bounding box */
+        Vector2 min{Constants::inf()}, max{-Constants::inf()};
+        for(UnsignedInt j = 0; j != 8; ++j) {
+            const Vector3 corner = light.position + Vector3{
+                j & 1 ? light.range : -light.range,
+                j & 2 ? light.range : -light.range,
+                j & 4 ? light.range : -light.range};
+            const Vector2 projected = projectionMatrix.transformPoint(corner).xy();
+            min = Math::min(min, projected);
+            max = Math::max(max, projected);
+        }
+
+        /* Outside of the viewport */
+        if(max.x() < -1.0f || max.y() < -1.0f || min.x() > 1.0f || min.y() > 1.0f)
+            continue;
+
+        /* Convert from NDC to tiles, max is exclusive */
+        min = (Math::clamp(min, -1.0f, 1.0f)*0.5f + Vector2{0.5f})*tileScale;
+        max = (Math::clamp(max, -1.0f, 1.0f)*0.5f + Vector2{0.5f})*tileScale;
+        ranges[i] = {Vector2i{Math::floor(min)},
+                     Math::min(Vector2i{Math::floor(max)} + Vector2i{1}, _tileCount)};
+    }
+
+    /* Count lights in each tile */
+    _tiles.assign(_tileCount.product(), {});
+    for(const Range2Di& range: ranges)
+        for(Int y = range.min().y(); y < range.max().y(); ++y)
+            for(Int x = range.min().x(); x < range.max().x(); ++x)
+                ++_tiles[y*_tileCount.x() + x].y();
+
+    /* Calculate offsets of tile lists */
+    UnsignedInt offset = 0;
+    for(Vector2ui& tile: _tiles) {
+        tile.x() = offset;
+        offset += tile.y();
+    }
+
+    /* Fill the tile lists, lights in each tile are sorted by their index */
+    _lightIndices.resize(offset);
+    std::vector<UnsignedInt> filled(_tiles.size());
+    for(std::size_t i = 0; i != ranges.size(); ++i)
+        for(Int y = ranges[i].min().y(); y < ranges[i].max().y(); ++y)
+            for(Int x = ranges[i].min().x(); x < ranges[i].max().x(); ++x) {
+                const std::size_t tile = y*_tileCount.x() + x;
+                _lightIndices[_tiles[tile].x() + filled[tile]++] = UnsignedInt(i);
+            }
+
+    /* Upload everything. The buffers are reattached to the textures as the
+       storage gets reallocated. */
+    _lightBuffer.setData({lights.data(), lights.size()*sizeof(PhongLight)}, BufferUsage::DynamicDraw);
+    _tileBuffer.setData({_tiles.data(), _tiles.size()*sizeof(Vector2ui)}, BufferUsage::DynamicDraw);
+    _lightIndexBuffer.setData({_lightIndices.data(), _lightIndices.size()*sizeof(UnsignedInt)}, BufferUsage::DynamicDraw);
+    _lightTexture.setBuffer(BufferTextureFormat::RGBA32F, _lightBuffer);
+    _tileTexture.setBuffer(BufferTextureFormat::RG32UI, _tileBuffer);
+    _lightIndexTexture.setBuffer(BufferTextureFormat::R32UI, _lightIndexBuffer);
+
+    return *this;
+}
+
+PhongLightGrid& PhongLightGrid::setLights(const Matrix4& projectionMatrix, const Vector2i& viewportSize, const std::initializer_list<PhongLight> lights) {
+    return setLights(projectionMatrix, viewportSize, Containers::ArrayView<const PhongLight>{lights.begin(), lights.size()});
+}
+
+}}
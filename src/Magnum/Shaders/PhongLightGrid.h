@@ -0,0 +1,218 @@
+#ifndef Magnum_Shaders_PhongLightGrid_h
+#define Magnum_Shaders_PhongLightGrid_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+/** @file
+ * @brief Class @ref Magnum::Shaders::PhongLightGrid, struct @ref Magnum::Shaders::PhongLight
+ */
+#endif
+
+#include <initializer_list>
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Buffer.h"
+#include "Magnum/BufferTexture.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Shaders/visibility.h"
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+namespace Magnum { namespace Shaders {
+
+/**
+@brief Point light for the tiled Phong shader
+
+Layout of one light in the light data buffer of @ref PhongLightGrid. The light
+influence falls off smoothly to zero at @ref range.
+@requires_gl31 Extension @extension{ARB,texture_buffer_object}
+@requires_gles32 Extension @extension{ANDROID,extension_pack_es31a} /
+    @extension{EXT,texture_buffer}
+@requires_gles Texture buffers are not available in WebGL.
+*/
+struct PhongLight {
+    /**
+     * @brief Default constructor
+     *
+     * Creates a white light on origin with zero range.
+     */
+    constexpr /*implicit*/ PhongLight() noexcept: range{}, color{1.0f}, _padding{} {}
+
+    /** @brief Constructor */
+    constexpr explicit PhongLight(const Vector3& position, Float range, const Color3& color = Color3{1.0f}) noexcept: position{position}, range{range}, color{color}, _padding{} {}
+
+    /** @brief Position in camera space */
+    Vector3 position;
+
+    /** @brief Distance at which the light influence reaches zero */
+    Float range;
+
+    /** @brief Light color */
+    Color3 color;
+
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    private:
+        Float _padding;
+    #endif
+};
+
+static_assert(sizeof(PhongLight) == 32, "Improper size of PhongLight");
+
+/**
+@brief Screen-space light grid for the Phong shader
+
+Splits the viewport into square tiles and for each tile lists lights that can
+affect pixels in it. Used by @ref Phong with @ref Phong::Flag::TiledLights,
+which evaluates only the lights in the tile of each fragment instead of all of
+them, allowing hundreds of lights to be drawn in a single pass.
+
+The grid is built on the CPU by projecting bounding sphere of each light to
+the screen, so it needs to be updated using @ref setLights() every time the
+lights or the camera change. The result is then uploaded into three buffers
+that are accessed in the shader through buffer textures. See
+@ref Shaders-Phong-tiled-lights for an example.
+
+The tile assignment is conservative --- a light can be listed in a tile even
+if it doesn't affect any pixel in it, but never the other way around. Lights
+intersecting the plane of the camera are assigned to all tiles.
+
+@requires_gl31 Extension @extension{ARB,texture_buffer_object}
+@requires_gles32 Extension @extension{ANDROID,extension_pack_es31a} /
+    @extension{EXT,texture_buffer}
+@requires_gles Texture buffers are not available in WebGL.
+*/
+class MAGNUM_SHADERS_EXPORT PhongLightGrid {
+    public:
+        /**
+         * @brief Constructor
+         * @param tileSize      Size of one square tile in pixels
+         *
+         * Creates the underlying buffers and buffer textures. The grid is
+         * initially empty.
+         */
+        explicit PhongLightGrid(Int tileSize = 16);
+
+        /** @brief Copying is not allowed */
+        PhongLightGrid(const PhongLightGrid&) = delete;
+
+        /** @brief Move constructor */
+        PhongLightGrid(PhongLightGrid&&) noexcept = default;
+
+        /** @brief Copying is not allowed */
+        PhongLightGrid& operator=(const PhongLightGrid&) = delete;
+
+        /** @brief Move assignment */
+        PhongLightGrid& operator=(PhongLightGrid&&) noexcept = default;
+
+        /** @brief Tile size in pixels */
+        Int tileSize() const { return _tileSize; }
+
+        /**
+         * @brief Tile count
+         *
+         * Count of tiles covering viewport passed to the last
+         * @ref setLights() call.
+         */
+        Vector2i tileCount() const { return _tileCount; }
+
+        /**
+         * @brief Light count
+         *
+         * Count of lights passed to the last @ref setLights() call.
+         */
+        std::size_t lightCount() const { return _lightCount; }
+
+        /**
+         * @brief Tile contents
+         *
+         * For each tile contains offset into @ref lightIndices() and count of
+         * lights in the tile. Tiles are ordered row by row from the bottom
+         * left corner of the viewport, matching @glsl gl_FragCoord @ce.
+         */
+        const std::vector<Vector2ui>& tiles() const { return _tiles; }
+
+        /**
+         * @brief Light indices
+         *
+         * Indices of lights in all tiles, referenced from @ref tiles().
+         */
+        const std::vector<UnsignedInt>& lightIndices() const { return _lightIndices; }
+
+        /**
+         * @brief Set lights
+         * @param projectionMatrix  Camera projection matrix
+         * @param viewportSize      Viewport size in pixels
+         * @param lights            Lights in camera space
+         * @return Reference to self (for method chaining)
+         *
+         * Rebuilds the grid and uploads it together with the light data.
+         */
+        PhongLightGrid& setLights(const Matrix4& projectionMatrix, const Vector2i& viewportSize, Containers::ArrayView<const PhongLight> lights);
+
+        /** @overload */
+        PhongLightGrid& setLights(const Matrix4& projectionMatrix, const Vector2i& viewportSize, std::initializer_list<PhongLight> lights);
+
+        /**
+         * @brief Light data texture
+         *
+         * @ref BufferTextureFormat::RGBA32F, two texels for each light.
+         */
+        BufferTexture& lightTexture() { return _lightTexture; }
+
+        /**
+         * @brief Tile texture
+         *
+         * @ref BufferTextureFormat::RG32UI, one texel with contents of
+         * @ref tiles() for each tile.
+         */
+        BufferTexture& tileTexture() { return _tileTexture; }
+
+        /**
+         * @brief Light index texture
+         *
+         * @ref BufferTextureFormat::R32UI with contents of
+         * @ref lightIndices().
+         */
+        BufferTexture& lightIndexTexture() { return _lightIndexTexture; }
+
+    private:
+        Int _tileSize;
+        Vector2i _tileCount;
+        std::size_t _lightCount{};
+        std::vector<Vector2ui> _tiles;
+        std::vector<UnsignedInt> _lightIndices;
+
+        Buffer _lightBuffer, _tileBuffer, _lightIndexBuffer;
+        BufferTexture _lightTexture, _tileTexture, _lightIndexTexture;
+};
+
+}}
+#else
+#error this header is not available in OpenGL ES 2.0 and WebGL build
+#endif
+
+#endif
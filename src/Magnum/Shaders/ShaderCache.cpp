@@ -0,0 +1,55 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ShaderCache.h"
+
+#include <functional>
+
+namespace Magnum { namespace Shaders {
+
+std::size_t ShaderCache::Hash::operator()(const std::pair<std::type_index, UnsignedLong>& key) const {
+    return std::hash<std::type_index>{}(key.first)*31 ^ std::hash<UnsignedLong>{}(key.second);
+}
+
+ShaderCache::ShaderCache() = default;
+
+ShaderCache::ShaderCache(ShaderCache&&) noexcept = default;
+
+ShaderCache::~ShaderCache() = default;
+
+ShaderCache& ShaderCache::operator=(ShaderCache&&) noexcept = default;
+
+void ShaderCache::clear() { _shaders.clear(); }
+
+AbstractShaderProgram* ShaderCache::find(const std::type_index type, const UnsignedLong flags) const {
+    const auto found = _shaders.find({type, flags});
+    return found == _shaders.end() ? nullptr : found->second.get();
+}
+
+AbstractShaderProgram& ShaderCache::add(const std::type_index type, const UnsignedLong flags, std::unique_ptr<AbstractShaderProgram> shader) {
+    return *_shaders.emplace(std::make_pair(type, flags), std::move(shader)).first->second;
+}
+
+}}
@@ -0,0 +1,162 @@
+#ifndef Magnum_Shaders_ShaderCache_h
+#define Magnum_Shaders_ShaderCache_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Shaders::ShaderCache
+ */
+
+#include <initializer_list>
+#include <memory>
+#include <typeindex>
+#include <unordered_map>
+#include <utility>
+
+#include "Magnum/AbstractShaderProgram.h"
+#include "Magnum/Shaders/visibility.h"
+
+namespace Magnum { namespace Shaders {
+
+/**
+@brief Shader variant cache
+
+Owns builtin shaders keyed by shader type and flags and hands out references
+to them, so code that needs the same shader variant in multiple places (such
+as resource loaders creating materials) doesn't compile a new GL program every
+time:
+
+@snippet MagnumShaders.cpp ShaderCache-usage
+
+Shaders are compiled on first @ref get(). Use @ref precompile() to compile a
+known set of variants upfront, for example during application startup, to
+avoid stalls later. The returned references stay valid until @ref clear() is
+called or the cache is destroyed.
+
+The shaders pick GLSL version and code paths based on the current context, so
+the cache is tied to the context that was current when the shaders were
+created. Create one cache per context and make sure the context is current
+when calling @ref get() or @ref precompile(). Only variants that can be
+constructed from flags alone can be cached, shaders with additional
+constructor parameters such as @ref Phong with @ref Phong::Flag::Skinning
+have to be created directly.
+*/
+class MAGNUM_SHADERS_EXPORT ShaderCache {
+    public:
+        /** @brief Constructor */
+        explicit ShaderCache();
+
+        /** @brief Copying is not allowed */
+        ShaderCache(const ShaderCache&) = delete;
+
+        /** @brief Move constructor */
+        ShaderCache(ShaderCache&&) noexcept;
+
+        ~ShaderCache();
+
+        /** @brief Copying is not allowed */
+        ShaderCache& operator=(const ShaderCache&) = delete;
+
+        /** @brief Move assignment */
+        ShaderCache& operator=(ShaderCache&&) noexcept;
+
+        /** @brief Count of cached shader variants */
+        std::size_t size() const { return _shaders.size(); }
+
+        /**
+         * @brief Whether given shader is cached
+         *
+         * For shaders that don't have any flags.
+         */
+        template<class T> bool contains() const {
+            return find(typeid(T), 0);
+        }
+
+        /** @brief Whether given shader variant is cached */
+        template<class T> bool contains(typename T::Flags flags) const {
+            return find(typeid(T), key(flags));
+        }
+
+        /**
+         * @brief Get shader
+         *
+         * For shaders that don't have any flags or for shaders with default
+         * flags. If the shader is not cached yet, it's compiled.
+         */
+        template<class T> T& get() {
+            if(AbstractShaderProgram* const shader = find(typeid(T), 0))
+                return static_cast<T&>(*shader);
+            return static_cast<T&>(add(typeid(T), 0, std::unique_ptr<AbstractShaderProgram>{new T}));
+        }
+
+        /**
+         * @brief Get shader variant
+         *
+         * If the variant is not cached yet, it's compiled.
+         */
+        template<class T> T& get(typename T::Flags flags) {
+            if(AbstractShaderProgram* const shader = find(typeid(T), key(flags)))
+                return static_cast<T&>(*shader);
+            return static_cast<T&>(add(typeid(T), key(flags), std::unique_ptr<AbstractShaderProgram>{new T{flags}}));
+        }
+
+        /**
+         * @brief Precompile shader variants
+         * @return Reference to self (for method chaining)
+         *
+         * Compiles all variants from @p flags that aren't cached yet.
+         * Equivalent to calling @ref get() for each of them.
+         */
+        template<class T> ShaderCache& precompile(std::initializer_list<typename T::Flags> flags) {
+            for(const typename T::Flags f: flags) get<T>(f);
+            return *this;
+        }
+
+        /**
+         * @brief Clear the cache
+         *
+         * Destroys all cached shaders, invalidating all references returned
+         * from @ref get().
+         */
+        void clear();
+
+    private:
+        struct Hash {
+            std::size_t operator()(const std::pair<std::type_index, UnsignedLong>& key) const;
+        };
+
+        template<class Flags> static UnsignedLong key(Flags flags) {
+            return UnsignedLong(typename Flags::UnderlyingType(flags));
+        }
+
+        AbstractShaderProgram* find(std::type_index type, UnsignedLong flags) const;
+        AbstractShaderProgram& add(std::type_index type, UnsignedLong flags, std::unique_ptr<AbstractShaderProgram> shader);
+
+        std::unordered_map<std::pair<std::type_index, UnsignedLong>, std::unique_ptr<AbstractShaderProgram>, Hash> _shaders;
+};
+
+}}
+
+#endif
@@ -42,6 +42,11 @@ template<UnsignedInt> class AbstractVector;
 typedef AbstractVector<2> AbstractVector2D;
 typedef AbstractVector<3> AbstractVector3D;
 
+#ifndef MAGNUM_TARGET_GLES
+class DrawCulling;
+struct DrawCullingDrawable;
+#endif
+
 template<UnsignedInt> class Flat;
 typedef Flat<2> Flat2D;
 typedef Flat<3> Flat3D;
@@ -49,7 +54,17 @@ typedef Flat<3> Flat3D;
 /* Generic is used only statically */
 
 class MeshVisualizer;
+#ifndef MAGNUM_TARGET_GLES2
+class ParticleDrawable;
+class ParticleSystem;
+#endif
 class Phong;
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+struct PhongLight;
+class PhongLightGrid;
+#endif
+
+class ShaderCache;
 
 template<UnsignedInt> class Vector;
 typedef Vector<2> Vector2D;
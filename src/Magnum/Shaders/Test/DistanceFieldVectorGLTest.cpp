@@ -23,7 +23,9 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include "Magnum/Context.h"
 #include "Magnum/OpenGLTester.h"
+#include "Magnum/Version.h"
 #include "Magnum/Shaders/DistanceFieldVector.h"
 
 namespace Magnum { namespace Shaders { namespace Test {
@@ -33,11 +35,24 @@ struct DistanceFieldVectorGLTest: OpenGLTester {
 
     void compile2D();
     void compile3D();
+    void compileMultiChannel2D();
+    void compileMultiChannel3D();
+    #ifndef MAGNUM_TARGET_GLES2
+    void compileInstancedGlyphs2D();
+    void compileInstancedGlyphs3D();
+    #endif
 };
 
 DistanceFieldVectorGLTest::DistanceFieldVectorGLTest() {
     addTests({&DistanceFieldVectorGLTest::compile2D,
-              &DistanceFieldVectorGLTest::compile3D});
+              &DistanceFieldVectorGLTest::compile3D,
+              &DistanceFieldVectorGLTest::compileMultiChannel2D,
+              &DistanceFieldVectorGLTest::compileMultiChannel3D,
+              #ifndef MAGNUM_TARGET_GLES2
+              &DistanceFieldVectorGLTest::compileInstancedGlyphs2D,
+              &DistanceFieldVectorGLTest::compileInstancedGlyphs3D
+              #endif
+              });
 }
 
 void DistanceFieldVectorGLTest::compile2D() {
@@ -60,6 +75,62 @@ void DistanceFieldVectorGLTest::compile3D() {
     }
 }
 
+void DistanceFieldVectorGLTest::compileMultiChannel2D() {
+    Shaders::DistanceFieldVector2D shader{Shaders::DistanceFieldVector2D::Flag::MultiChannel};
+    CORRADE_VERIFY(shader.flags() == Shaders::DistanceFieldVector2D::Flag::MultiChannel);
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+
+void DistanceFieldVectorGLTest::compileMultiChannel3D() {
+    Shaders::DistanceFieldVector3D shader{Shaders::DistanceFieldVector3D::Flag::MultiChannel};
+    CORRADE_VERIFY(shader.flags() == Shaders::DistanceFieldVector3D::Flag::MultiChannel);
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+void DistanceFieldVectorGLTest::compileInstancedGlyphs2D() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isVersionSupported(Version::GL300))
+        CORRADE_SKIP("OpenGL 3.0 is not supported");
+    #endif
+
+    Shaders::DistanceFieldVector2D shader{Shaders::DistanceFieldVector2D::Flag::InstancedGlyphs};
+    CORRADE_VERIFY(shader.flags() == Shaders::DistanceFieldVector2D::Flag::InstancedGlyphs);
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+
+void DistanceFieldVectorGLTest::compileInstancedGlyphs3D() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isVersionSupported(Version::GL300))
+        CORRADE_SKIP("OpenGL 3.0 is not supported");
+    #endif
+
+    Shaders::DistanceFieldVector3D shader{Shaders::DistanceFieldVector3D::Flag::InstancedGlyphs};
+    CORRADE_VERIFY(shader.flags() == Shaders::DistanceFieldVector3D::Flag::InstancedGlyphs);
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+#endif
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Shaders::Test::DistanceFieldVectorGLTest)
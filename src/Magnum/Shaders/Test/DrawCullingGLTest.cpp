@@ -0,0 +1,239 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Buffer.h"
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/OpenGLTester.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Texture.h"
+#include "Magnum/TextureFormat.h"
+#include "Magnum/Math/Angle.h"
+#include "Magnum/Shaders/DrawCulling.h"
+
+namespace Magnum { namespace Shaders { namespace Test {
+
+struct DrawCullingGLTest: OpenGLTester {
+    explicit DrawCullingGLTest();
+
+    void compile();
+    void compileHierarchicalZ();
+    void compileNonIndexed();
+    void constructNoCreate();
+
+    void cullFrustum();
+    void cullNonIndexed();
+    void cullHierarchicalZ();
+    void cullEmpty();
+};
+
+DrawCullingGLTest::DrawCullingGLTest() {
+    addTests({&DrawCullingGLTest::compile,
+              &DrawCullingGLTest::compileHierarchicalZ,
+              &DrawCullingGLTest::compileNonIndexed,
+              &DrawCullingGLTest::constructNoCreate,
+
+              &DrawCullingGLTest::cullFrustum,
+              &DrawCullingGLTest::cullNonIndexed,
+              &DrawCullingGLTest::cullHierarchicalZ,
+              &DrawCullingGLTest::cullEmpty});
+}
+
+namespace {
+    bool checkSupport() {
+        return Context::current().isExtensionSupported<Extensions::GL::ARB::compute_shader>() &&
+            Context::current().isExtensionSupported<Extensions::GL::ARB::shader_storage_buffer_object>();
+    }
+
+    using namespace Math::Literals;
+
+    const Matrix4 Projection = Matrix4::perspectiveProjection(90.0_degf, 1.0f, 0.1f, 100.0f);
+    const Range3D UnitCube{Vector3{-1.0f}, Vector3{1.0f}};
+
+    /* Runs the culling and returns the output commands ordered by their base
+       instance */
+    std::vector<UnsignedInt> cull(DrawCulling& shader, std::initializer_list<DrawCullingDrawable> drawables, std::initializer_list<UnsignedInt> commands, const std::size_t commandSize, Texture2D* depthPyramid = nullptr) {
+        Buffer drawableBuffer, commandBuffer, outputCommandBuffer, drawCountBuffer;
+        drawableBuffer.setData({drawables.begin(), drawables.size()*sizeof(DrawCullingDrawable)}, BufferUsage::StaticDraw);
+        commandBuffer.setData({commands.begin(), commands.size()*sizeof(UnsignedInt)}, BufferUsage::StaticDraw);
+        outputCommandBuffer.setData(std::vector<UnsignedInt>(drawables.size()*commandSize), BufferUsage::StaticDraw);
+        drawCountBuffer.setData(std::vector<UnsignedInt>{0}, BufferUsage::StaticDraw);
+
+        shader.setViewProjectionMatrix(Projection)
+            .bindDrawableBuffer(drawableBuffer)
+            .bindCommandBuffer(commandBuffer)
+            .bindOutputCommandBuffer(outputCommandBuffer)
+            .bindDrawCountBuffer(drawCountBuffer);
+        if(depthPyramid) shader
+            .setViewportSize({4, 4})
+            .bindDepthPyramid(*depthPyramid);
+        shader.cull(drawables.size());
+
+        const UnsignedInt drawCount = Containers::arrayCast<UnsignedInt>(drawCountBuffer.data())[0];
+        const Containers::Array<char> output = outputCommandBuffer.data();
+        const UnsignedInt* const data = reinterpret_cast<const UnsignedInt*>(output.data());
+
+        std::vector<std::vector<UnsignedInt>> sorted;
+        for(std::size_t i = 0; i != drawCount; ++i)
+            sorted.emplace_back(data + i*commandSize, data + (i + 1)*commandSize);
+        std::sort(sorted.begin(), sorted.end(), [](const std::vector<UnsignedInt>& a, const std::vector<UnsignedInt>& b) {
+            return a.back() < b.back();
+        });
+
+        std::vector<UnsignedInt> out;
+        for(const std::vector<UnsignedInt>& command: sorted)
+            out.insert(out.end(), command.begin(), command.end());
+        return out;
+    }
+}
+
+void DrawCullingGLTest::compile() {
+    if(!checkSupport()) CORRADE_SKIP("Compute shaders are not supported.");
+
+    DrawCulling shader;
+    CORRADE_VERIFY(!shader.flags());
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+
+void DrawCullingGLTest::compileHierarchicalZ() {
+    if(!checkSupport()) CORRADE_SKIP("Compute shaders are not supported.");
+
+    DrawCulling shader{DrawCulling::Flag::HierarchicalZ};
+    CORRADE_VERIFY(shader.flags() == DrawCulling::Flag::HierarchicalZ);
+    CORRADE_VERIFY(shader.id());
+}
+
+void DrawCullingGLTest::compileNonIndexed() {
+    if(!checkSupport()) CORRADE_SKIP("Compute shaders are not supported.");
+
+    DrawCulling shader{DrawCulling::Flag::NonIndexed};
+    CORRADE_VERIFY(shader.flags() == DrawCulling::Flag::NonIndexed);
+    CORRADE_VERIFY(shader.id());
+}
+
+void DrawCullingGLTest::constructNoCreate() {
+    {
+        DrawCulling shader{NoCreate};
+        MAGNUM_VERIFY_NO_ERROR();
+        CORRADE_COMPARE(shader.id(), 0);
+    }
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void DrawCullingGLTest::cullFrustum() {
+    if(!checkSupport()) CORRADE_SKIP("Compute shaders are not supported.");
+
+    DrawCulling shader;
+    const std::vector<UnsignedInt> commands = cull(shader, {
+        /* In front of the camera */
+        DrawCullingDrawable{Matrix4::translation(Vector3::zAxis(-5.0f)), UnitCube, 0, 10},
+        /* Behind the camera */
+        DrawCullingDrawable{Matrix4::translation(Vector3::zAxis(5.0f)), UnitCube, 0, 11},
+        /* Far to the left */
+        DrawCullingDrawable{Matrix4::translation({-100.0f, 0.0f, -5.0f}), UnitCube, 0, 12},
+        /* Partially visible, with a different command */
+        DrawCullingDrawable{Matrix4::translation({-5.5f, 0.0f, -5.0f}), UnitCube, 1, 13}
+    }, {36, 1, 0, 0, 0,
+        6, 1, 36, 24, 0}, 5);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(commands, (std::vector<UnsignedInt>{
+        36, 1, 0, 0, 10,
+        6, 1, 36, 24, 13}));
+}
+
+void DrawCullingGLTest::cullNonIndexed() {
+    if(!checkSupport()) CORRADE_SKIP("Compute shaders are not supported.");
+
+    DrawCulling shader{DrawCulling::Flag::NonIndexed};
+    const std::vector<UnsignedInt> commands = cull(shader, {
+        DrawCullingDrawable{Matrix4::translation(Vector3::zAxis(5.0f)), UnitCube, 1, 0},
+        DrawCullingDrawable{Matrix4::translation(Vector3::zAxis(-5.0f)), UnitCube, 1, 1},
+        DrawCullingDrawable{Matrix4::translation(Vector3::zAxis(-10.0f)), UnitCube, 0, 2}
+    }, {3, 1, 0, 0,
+        6, 2, 3, 0}, 4);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(commands, (std::vector<UnsignedInt>{
+        6, 2, 3, 1,
+        3, 1, 0, 2}));
+}
+
+void DrawCullingGLTest::cullHierarchicalZ() {
+    if(!checkSupport()) CORRADE_SKIP("Compute shaders are not supported.");
+
+    /* Depth pyramid of an occluder somewhere between the two boxes, building
+       it is tested in TextureTools::DepthPyramid */
+    const Float depthData[16]{
+        0.95f, 0.95f, 0.95f, 0.95f,
+        0.95f, 0.95f, 0.95f, 0.95f,
+        0.95f, 0.95f, 0.95f, 0.95f,
+        0.95f, 0.95f, 0.95f, 0.95f};
+    Texture2D pyramid;
+    pyramid.setMinificationFilter(Sampler::Filter::Nearest, Sampler::Mipmap::Nearest)
+        .setMagnificationFilter(Sampler::Filter::Nearest)
+        .setStorage(3, TextureFormat::R32F, {4, 4})
+        .setSubImage(0, {}, ImageView2D{PixelFormat::Red, PixelType::Float, {4, 4}, depthData})
+        .setSubImage(1, {}, ImageView2D{PixelFormat::Red, PixelType::Float, {2, 2}, depthData})
+        .setSubImage(2, {}, ImageView2D{PixelFormat::Red, PixelType::Float, {1, 1}, depthData});
+
+    DrawCulling shader{DrawCulling::Flag::HierarchicalZ};
+    const std::vector<UnsignedInt> commands = cull(shader, {
+        /* Depth of the nearest point is around 0.8 */
+        DrawCullingDrawable{Matrix4::translation(Vector3::zAxis(-1.5f)), UnitCube, 0, 0},
+        /* Depth of the nearest point is around 0.999 */
+        DrawCullingDrawable{Matrix4::translation(Vector3::zAxis(-50.0f)), UnitCube, 0, 1},
+        /* Crossing the camera plane, never culled by depth */
+        DrawCullingDrawable{Matrix4::scaling(Vector3{60.0f})*Matrix4::translation(Vector3::zAxis(-0.5f)), UnitCube, 0, 2}
+    }, {36, 1, 0, 0, 0}, 5, &pyramid);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(commands, (std::vector<UnsignedInt>{
+        36, 1, 0, 0, 0,
+        36, 1, 0, 0, 2}));
+}
+
+void DrawCullingGLTest::cullEmpty() {
+    if(!checkSupport()) CORRADE_SKIP("Compute shaders are not supported.");
+
+    DrawCulling shader;
+    CORRADE_COMPARE(cull(shader, {}, {36, 1, 0, 0, 0}, 5), std::vector<UnsignedInt>{});
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Shaders::Test::DrawCullingGLTest)
@@ -23,7 +23,20 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Buffer.h"
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/Framebuffer.h"
+#include "Magnum/Image.h"
+#include "Magnum/Mesh.h"
 #include "Magnum/OpenGLTester.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Renderbuffer.h"
+#include "Magnum/RenderbufferFormat.h"
+#include "Magnum/Shader.h"
+#include "Magnum/Std140.h"
 #include "Magnum/Shaders/Flat.h"
 
 namespace Magnum { namespace Shaders { namespace Test {
@@ -35,13 +48,46 @@ struct FlatGLTest: OpenGLTester {
     void compile3D();
     void compile2DTextured();
     void compile3DTextured();
+    void compile2DInstanced();
+    void compile3DInstanced();
+    void compile2DAlphaMask();
+    void compile3DDepthOnly();
+    void compile3DDepthOnlyAlphaMask();
+
+    #ifndef MAGNUM_TARGET_GLES2
+    void compile2DUniformBuffers();
+    void compile3DUniformBuffers();
+    void drawUniformBuffers();
+    void drawInstanced();
+    #endif
+
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    void drawShaderStorageBuffers();
+    #endif
 };
 
 FlatGLTest::FlatGLTest() {
     addTests({&FlatGLTest::compile2D,
               &FlatGLTest::compile3D,
               &FlatGLTest::compile2DTextured,
-              &FlatGLTest::compile3DTextured});
+              &FlatGLTest::compile3DTextured,
+              &FlatGLTest::compile2DInstanced,
+              &FlatGLTest::compile3DInstanced,
+              &FlatGLTest::compile2DAlphaMask,
+              &FlatGLTest::compile3DDepthOnly,
+              &FlatGLTest::compile3DDepthOnlyAlphaMask,
+
+              #ifndef MAGNUM_TARGET_GLES2
+              &FlatGLTest::compile2DUniformBuffers,
+              &FlatGLTest::compile3DUniformBuffers,
+              &FlatGLTest::drawUniformBuffers,
+              &FlatGLTest::drawInstanced,
+              #endif
+
+              #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+              &FlatGLTest::drawShaderStorageBuffers
+              #endif
+              });
 }
 
 void FlatGLTest::compile2D() {
@@ -84,6 +130,252 @@ void FlatGLTest::compile3DTextured() {
     }
 }
 
+void FlatGLTest::compile2DInstanced() {
+    Shaders::Flat2D shader(Shaders::Flat2D::Flag::InstancedTransformation|Shaders::Flat2D::Flag::InstancedColor);
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+
+void FlatGLTest::compile3DInstanced() {
+    Shaders::Flat3D shader(Shaders::Flat3D::Flag::InstancedTransformation|Shaders::Flat3D::Flag::InstancedColor|Shaders::Flat3D::Flag::Textured);
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+
+void FlatGLTest::compile2DAlphaMask() {
+    Shaders::Flat2D shader(Shaders::Flat2D::Flag::Textured|Shaders::Flat2D::Flag::AlphaMask);
+    shader.setAlphaMask(0.25f);
+    MAGNUM_VERIFY_NO_ERROR();
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+
+void FlatGLTest::compile3DDepthOnly() {
+    Shaders::Flat3D shader(Shaders::Flat3D::Flag::DepthOnly|Shaders::Flat3D::Flag::Textured);
+
+    /* The color setter is a no-op */
+    shader.setColor(Color4{1.0f});
+    MAGNUM_VERIFY_NO_ERROR();
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+
+void FlatGLTest::compile3DDepthOnlyAlphaMask() {
+    Shaders::Flat3D shader(Shaders::Flat3D::Flag::DepthOnly|Shaders::Flat3D::Flag::Textured|Shaders::Flat3D::Flag::AlphaMask);
+    shader.setColor(Color4{1.0f})
+        .setAlphaMask(0.5f);
+    MAGNUM_VERIFY_NO_ERROR();
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+void FlatGLTest::compile2DUniformBuffers() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(Extensions::GL::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+    #endif
+
+    Shaders::Flat2D shader(Shaders::Flat2D::Flag::UniformBuffers|Shaders::Flat2D::Flag::Textured);
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+
+void FlatGLTest::compile3DUniformBuffers() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(Extensions::GL::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+    #endif
+
+    Shaders::Flat3D shader(Shaders::Flat3D::Flag::UniformBuffers);
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+
+void FlatGLTest::drawUniformBuffers() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(Extensions::GL::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+    #endif
+
+    /* Full-screen triangle */
+    const Vector3 positions[] = {
+        {-1.0f, -1.0f, 0.0f},
+        { 3.0f, -1.0f, 0.0f},
+        {-1.0f,  3.0f, 0.0f}
+    };
+    Buffer vertices;
+    vertices.setData(positions, BufferUsage::StaticDraw);
+
+    Mesh mesh;
+    mesh.setCount(3)
+        .addVertexBuffer(vertices, 0, Shaders::Flat3D::Position{});
+
+    /* Two draws in one buffer, each at a properly aligned offset */
+    const std::size_t stride = Std140::alignedStride(sizeof(Shaders::Flat3D::DrawUniform), Buffer::uniformOffsetAlignment());
+    Containers::Array<char> data{Containers::ValueInit, 2*stride};
+    *reinterpret_cast<Shaders::Flat3D::DrawUniform*>(data.data()) = Shaders::Flat3D::DrawUniform{Matrix4{}, Color4{0.0f, 1.0f, 0.0f}};
+    *reinterpret_cast<Shaders::Flat3D::DrawUniform*>(data.data() + stride) = Shaders::Flat3D::DrawUniform{Matrix4{}, Color4{1.0f, 0.0f, 0.0f}};
+    Buffer uniforms{Buffer::TargetHint::Uniform};
+    uniforms.setData(data, BufferUsage::StaticDraw);
+
+    Renderbuffer renderbuffer;
+    renderbuffer.setStorage(RenderbufferFormat::RGBA8, Vector2i{4});
+    Framebuffer framebuffer{{{}, Vector2i{4}}};
+    framebuffer.attachRenderbuffer(Framebuffer::ColorAttachment{0}, renderbuffer)
+        .bind();
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    Shaders::Flat3D shader{Shaders::Flat3D::Flag::UniformBuffers};
+    shader.bindDrawBuffer(uniforms, stride, sizeof(Shaders::Flat3D::DrawUniform));
+    mesh.draw(shader);
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    Image2D image = framebuffer.read({{}, Vector2i{4}}, {PixelFormat::RGBA, PixelType::UnsignedByte});
+    CORRADE_COMPARE(image.data<Color4ub>()[5], (Color4ub{255, 0, 0, 255}));
+}
+
+void FlatGLTest::drawInstanced() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::instanced_arrays>())
+        CORRADE_SKIP(Extensions::GL::ARB::instanced_arrays::string() + std::string(" is not supported"));
+    #endif
+
+    /* Full-screen triangle */
+    const Vector3 positions[] = {
+        {-1.0f, -1.0f, 0.0f},
+        { 3.0f, -1.0f, 0.0f},
+        {-1.0f,  3.0f, 0.0f}
+    };
+    Buffer vertices;
+    vertices.setData(positions, BufferUsage::StaticDraw);
+
+    /* The second instance is moved out of the viewport, so if the
+       per-instance transformation wouldn't be applied, it would overwrite the
+       first one */
+    struct Instance {
+        Matrix4 transformationMatrix;
+        Color4 color;
+    } instanceData[] = {
+        {Matrix4{}, Color4{0.0f, 1.0f, 0.0f}},
+        {Matrix4::translation(Vector3::xAxis(10.0f)), Color4{1.0f, 0.0f, 0.0f}}
+    };
+    Buffer instances;
+    instances.setData(instanceData, BufferUsage::StaticDraw);
+
+    Mesh mesh;
+    mesh.setCount(3)
+        .setInstanceCount(2)
+        .addVertexBuffer(vertices, 0, Shaders::Flat3D::Position{})
+        .addVertexBufferInstanced(instances, 1, 0,
+            Shaders::Flat3D::TransformationMatrix{},
+            Shaders::Flat3D::Color{Shaders::Flat3D::Color::Components::Four});
+
+    Renderbuffer renderbuffer;
+    renderbuffer.setStorage(RenderbufferFormat::RGBA8, Vector2i{4});
+    Framebuffer framebuffer{{{}, Vector2i{4}}};
+    framebuffer.attachRenderbuffer(Framebuffer::ColorAttachment{0}, renderbuffer)
+        .bind();
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /* The uniform color is white by default, so only the instance color is
+       visible */
+    Shaders::Flat3D shader{Shaders::Flat3D::Flag::InstancedTransformation|Shaders::Flat3D::Flag::InstancedColor};
+    shader.setTransformationProjectionMatrix(Matrix4{});
+    mesh.draw(shader);
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    Image2D image = framebuffer.read({{}, Vector2i{4}}, {PixelFormat::RGBA, PixelType::UnsignedByte});
+    CORRADE_COMPARE(image.data<Color4ub>()[5], (Color4ub{0, 255, 0, 255}));
+}
+#endif
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+void FlatGLTest::drawShaderStorageBuffers() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::shader_storage_buffer_object>())
+        CORRADE_SKIP(Extensions::GL::ARB::shader_storage_buffer_object::string() + std::string(" is not supported"));
+    #endif
+    if(Shader::maxShaderStorageBlocks(Shader::Type::Vertex) < 1)
+        CORRADE_SKIP("Shader storage buffers are not supported in vertex shaders");
+
+    /* Full-screen triangle */
+    const Vector3 positions[] = {
+        {-1.0f, -1.0f, 0.0f},
+        { 3.0f, -1.0f, 0.0f},
+        {-1.0f,  3.0f, 0.0f}
+    };
+    Buffer vertices;
+    vertices.setData(positions, BufferUsage::StaticDraw);
+
+    Mesh mesh;
+    mesh.setCount(3)
+        .setInstanceCount(2)
+        .addVertexBuffer(vertices, 0, Shaders::Flat3D::Position{});
+
+    /* Three tightly packed draws, the first is skipped with the draw offset
+       and the second instance is moved out of the viewport, so only the
+       second item is visible */
+    const Shaders::Flat3D::DrawUniform draws[] = {
+        Shaders::Flat3D::DrawUniform{Matrix4{}, Color4{0.0f, 0.0f, 1.0f}},
+        Shaders::Flat3D::DrawUniform{Matrix4{}, Color4{1.0f, 0.0f, 0.0f}},
+        Shaders::Flat3D::DrawUniform{Matrix4::translation(Vector3::xAxis(10.0f)), Color4{0.0f, 1.0f, 0.0f}}
+    };
+    Buffer storage{Buffer::TargetHint::ShaderStorage};
+    storage.setData(draws, BufferUsage::StaticDraw);
+
+    Renderbuffer renderbuffer;
+    renderbuffer.setStorage(RenderbufferFormat::RGBA8, Vector2i{4});
+    Framebuffer framebuffer{{{}, Vector2i{4}}};
+    framebuffer.attachRenderbuffer(Framebuffer::ColorAttachment{0}, renderbuffer)
+        .bind();
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    Shaders::Flat3D shader{Shaders::Flat3D::Flag::ShaderStorageBuffers};
+    shader.bindDrawStorageBuffer(storage)
+        .setDrawOffset(1);
+    mesh.draw(shader);
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    Image2D image = framebuffer.read({{}, Vector2i{4}}, {PixelFormat::RGBA, PixelType::UnsignedByte});
+    CORRADE_COMPARE(image.data<Color4ub>()[5], (Color4ub{255, 0, 0, 255}));
+}
+#endif
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Shaders::Test::FlatGLTest)
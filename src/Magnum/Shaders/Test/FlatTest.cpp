@@ -23,6 +23,7 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <cstddef>
 #include <Corrade/TestSuite/Tester.h>
 
 #include "Magnum/Shaders/Flat.h"
@@ -34,11 +35,22 @@ struct FlatTest: TestSuite::Tester {
 
     void constructNoCreate2D();
     void constructNoCreate3D();
+
+    #ifndef MAGNUM_TARGET_GLES2
+    void drawUniform2D();
+    void drawUniform3D();
+    #endif
 };
 
 FlatTest::FlatTest() {
     addTests({&FlatTest::constructNoCreate2D,
-              &FlatTest::constructNoCreate3D});
+              &FlatTest::constructNoCreate3D,
+
+              #ifndef MAGNUM_TARGET_GLES2
+              &FlatTest::drawUniform2D,
+              &FlatTest::drawUniform3D
+              #endif
+              });
 }
 
 void FlatTest::constructNoCreate2D() {
@@ -59,6 +71,37 @@ void FlatTest::constructNoCreate3D() {
     CORRADE_VERIFY(true);
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+void FlatTest::drawUniform2D() {
+    /* Matches the std140 layout of the FlatDraw block */
+    CORRADE_COMPARE(sizeof(FlatDrawUniform2D), 64);
+    CORRADE_COMPARE(offsetof(FlatDrawUniform2D, transformationProjectionMatrix), 0);
+    CORRADE_COMPARE(offsetof(FlatDrawUniform2D, color), 48);
+
+    const FlatDrawUniform2D a;
+    CORRADE_COMPARE(Matrix3{a.transformationProjectionMatrix}, Matrix3{});
+    CORRADE_COMPARE(a.color, Color4{1.0f});
+
+    const FlatDrawUniform2D b{Matrix3::translation({1.0f, 2.0f}), Color4{0.5f, 0.25f, 0.0f}};
+    CORRADE_COMPARE(Matrix3{b.transformationProjectionMatrix}, Matrix3::translation({1.0f, 2.0f}));
+    CORRADE_COMPARE(b.color, (Color4{0.5f, 0.25f, 0.0f}));
+}
+
+void FlatTest::drawUniform3D() {
+    CORRADE_COMPARE(sizeof(FlatDrawUniform3D), 80);
+    CORRADE_COMPARE(offsetof(FlatDrawUniform3D, transformationProjectionMatrix), 0);
+    CORRADE_COMPARE(offsetof(FlatDrawUniform3D, color), 64);
+
+    constexpr FlatDrawUniform3D a;
+    CORRADE_COMPARE(a.transformationProjectionMatrix, Matrix4{});
+    CORRADE_COMPARE(a.color, Color4{1.0f});
+
+    const FlatDrawUniform3D b{Matrix4::scaling(Vector3{2.0f})};
+    CORRADE_COMPARE(b.transformationProjectionMatrix, Matrix4::scaling(Vector3{2.0f}));
+    CORRADE_COMPARE(b.color, Color4{1.0f});
+}
+#endif
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Shaders::Test::FlatTest)
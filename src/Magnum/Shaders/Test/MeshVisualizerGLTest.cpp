@@ -38,6 +38,7 @@ struct MeshVisualizerGLTest: OpenGLTester {
     void compileWireframeGeometryShader();
     #endif
     void compileWireframeNoGeometryShader();
+    void compileWireframeVertexIndexAttribute();
 };
 
 MeshVisualizerGLTest::MeshVisualizerGLTest() {
@@ -45,7 +46,8 @@ MeshVisualizerGLTest::MeshVisualizerGLTest() {
               #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
               &MeshVisualizerGLTest::compileWireframeGeometryShader,
               #endif
-              &MeshVisualizerGLTest::compileWireframeNoGeometryShader});
+              &MeshVisualizerGLTest::compileWireframeNoGeometryShader,
+              &MeshVisualizerGLTest::compileWireframeVertexIndexAttribute});
 }
 
 void MeshVisualizerGLTest::compile() {
@@ -93,6 +95,16 @@ void MeshVisualizerGLTest::compileWireframeNoGeometryShader() {
     }
 }
 
+void MeshVisualizerGLTest::compileWireframeVertexIndexAttribute() {
+    Shaders::MeshVisualizer shader(Shaders::MeshVisualizer::Flag::Wireframe|Shaders::MeshVisualizer::Flag::VertexIndexAttribute);
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Shaders::Test::MeshVisualizerGLTest)
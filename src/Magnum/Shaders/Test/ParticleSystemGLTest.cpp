@@ -0,0 +1,244 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Buffer.h"
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/OpenGLTester.h"
+#include "Magnum/Shaders/ParticleSystem.h"
+
+namespace Magnum { namespace Shaders { namespace Test {
+
+struct ParticleSystemGLTest: OpenGLTester {
+    explicit ParticleSystemGLTest();
+
+    void construct();
+    void constructCompute();
+
+    void emitTransformFeedback();
+    void emitCompute();
+    void emitWrapAround();
+    void emissionRate();
+    void draw();
+
+    void debugPath();
+};
+
+ParticleSystemGLTest::ParticleSystemGLTest() {
+    addTests({&ParticleSystemGLTest::construct,
+              &ParticleSystemGLTest::constructCompute,
+
+              &ParticleSystemGLTest::emitTransformFeedback,
+              &ParticleSystemGLTest::emitCompute,
+              &ParticleSystemGLTest::emitWrapAround,
+              &ParticleSystemGLTest::emissionRate,
+              &ParticleSystemGLTest::draw,
+
+              &ParticleSystemGLTest::debugPath});
+}
+
+namespace {
+    bool checkSupport() {
+        #ifndef MAGNUM_TARGET_GLES
+        return Context::current().isExtensionSupported<Extensions::GL::ARB::transform_feedback2>();
+        #else
+        return true;
+        #endif
+    }
+
+    #ifndef MAGNUM_TARGET_GLES
+    /* Buffer::data() is not available on ES */
+    std::vector<Vector4> particles(ParticleSystem& system) {
+        const Containers::Array<char> data = system.buffer().data();
+        const Vector4* const begin = reinterpret_cast<const Vector4*>(data.data());
+        return {begin, begin + system.capacity()*2};
+    }
+
+    void verifyEmit(ParticleSystem& system) {
+        system.setEmitterTransformation(Matrix4::translation({1.0f, 2.0f, 3.0f}))
+            .setVelocity({1.0f, 0.0f, 0.0f})
+            .setLifetimeRange(1.0f, 1.0f)
+            .emit(2)
+            .update(0.5f);
+        MAGNUM_VERIFY_NO_ERROR();
+
+        /* Two particles emitted at the emitter position, the rest is dead */
+        std::vector<Vector4> data = particles(system);
+        CORRADE_COMPARE(data[0], (Vector4{1.0f, 2.0f, 3.0f, 0.0f}));
+        CORRADE_COMPARE(data[1], (Vector4{1.0f, 0.0f, 0.0f, 1.0f}));
+        CORRADE_COMPARE(data[2], (Vector4{1.0f, 2.0f, 3.0f, 0.0f}));
+        CORRADE_COMPARE(data[3], (Vector4{1.0f, 0.0f, 0.0f, 1.0f}));
+        CORRADE_COMPARE(data[4], Vector4{});
+        CORRADE_COMPARE(data[5], Vector4{});
+
+        /* Emitted particles move, emitter transformation affects only new
+           particles */
+        system.setEmitterTransformation({})
+            .setAcceleration({0.0f, -2.0f, 0.0f})
+            .update(0.25f);
+        MAGNUM_VERIFY_NO_ERROR();
+
+        data = particles(system);
+        CORRADE_COMPARE(data[0], (Vector4{1.25f, 1.875f, 3.0f, 0.25f}));
+        CORRADE_COMPARE(data[1], (Vector4{1.0f, -0.5f, 0.0f, 1.0f}));
+        CORRADE_COMPARE(data[4], Vector4{});
+
+        /* Dead particles aren't simulated anymore */
+        system.update(1.0f);
+        system.update(1.0f);
+        MAGNUM_VERIFY_NO_ERROR();
+
+        data = particles(system);
+        CORRADE_COMPARE(data[0].w(), 1.25f);
+        CORRADE_COMPARE(data[4], Vector4{});
+    }
+    #endif
+}
+
+void ParticleSystemGLTest::construct() {
+    if(!checkSupport()) CORRADE_SKIP("Transform feedback objects are not supported.");
+
+    ParticleSystem system{16, ParticleSystem::Path::TransformFeedback};
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(system.capacity(), 16);
+    CORRADE_COMPARE(system.path(), ParticleSystem::Path::TransformFeedback);
+    CORRADE_COMPARE(system.emissionRate(), 0.0f);
+    CORRADE_VERIFY(system.buffer().id());
+}
+
+void ParticleSystemGLTest::constructCompute() {
+    if(!checkSupport()) CORRADE_SKIP("Transform feedback objects are not supported.");
+    if(ParticleSystem::defaultPath() != ParticleSystem::Path::Compute)
+        CORRADE_SKIP("Compute shaders are not supported.");
+
+    ParticleSystem system{16};
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(system.path(), ParticleSystem::Path::Compute);
+    CORRADE_VERIFY(system.buffer().id());
+}
+
+void ParticleSystemGLTest::emitTransformFeedback() {
+    #ifdef MAGNUM_TARGET_GLES
+    CORRADE_SKIP("Buffer data queries are not available on OpenGL ES.");
+    #else
+    if(!checkSupport()) CORRADE_SKIP("Transform feedback objects are not supported.");
+
+    ParticleSystem system{3, ParticleSystem::Path::TransformFeedback};
+    verifyEmit(system);
+    #endif
+}
+
+void ParticleSystemGLTest::emitCompute() {
+    #ifdef MAGNUM_TARGET_GLES
+    CORRADE_SKIP("Buffer data queries are not available on OpenGL ES.");
+    #else
+    if(!checkSupport()) CORRADE_SKIP("Transform feedback objects are not supported.");
+    if(ParticleSystem::defaultPath() != ParticleSystem::Path::Compute)
+        CORRADE_SKIP("Compute shaders are not supported.");
+
+    ParticleSystem system{3, ParticleSystem::Path::Compute};
+    verifyEmit(system);
+    #endif
+}
+
+void ParticleSystemGLTest::emitWrapAround() {
+    #ifdef MAGNUM_TARGET_GLES
+    CORRADE_SKIP("Buffer data queries are not available on OpenGL ES.");
+    #else
+    if(!checkSupport()) CORRADE_SKIP("Transform feedback objects are not supported.");
+
+    ParticleSystem system{4};
+    system.setLifetimeRange(10.0f, 10.0f)
+        .emit(3)
+        .update(1.0f)
+        .update(1.0f);
+
+    /* The next emission continues after the last one and wraps around */
+    system.emit(3)
+        .update(1.0f);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    const std::vector<Vector4> data = particles(system);
+    CORRADE_COMPARE(data[0].w(), 0.0f);
+    CORRADE_COMPARE(data[2].w(), 0.0f);
+    CORRADE_COMPARE(data[4].w(), 2.0f);
+    CORRADE_COMPARE(data[6].w(), 0.0f);
+    CORRADE_COMPARE(data[7].w(), 10.0f);
+    #endif
+}
+
+void ParticleSystemGLTest::emissionRate() {
+    #ifdef MAGNUM_TARGET_GLES
+    CORRADE_SKIP("Buffer data queries are not available on OpenGL ES.");
+    #else
+    if(!checkSupport()) CORRADE_SKIP("Transform feedback objects are not supported.");
+
+    ParticleSystem system{4};
+    system.setEmissionRate(3.0f)
+        .setLifetimeRange(10.0f, 10.0f);
+    CORRADE_COMPARE(system.emissionRate(), 3.0f);
+
+    /* 1.5 particles, the fraction is kept for the next update */
+    system.update(0.5f);
+    MAGNUM_VERIFY_NO_ERROR();
+    std::vector<Vector4> data = particles(system);
+    CORRADE_COMPARE(data[1].w(), 10.0f);
+    CORRADE_COMPARE(data[3].w(), 0.0f);
+
+    system.update(0.5f);
+    MAGNUM_VERIFY_NO_ERROR();
+    data = particles(system);
+    CORRADE_COMPARE(data[0].w(), 0.5f);
+    CORRADE_COMPARE(data[3].w(), 10.0f);
+    CORRADE_COMPARE(data[5].w(), 10.0f);
+    CORRADE_COMPARE(data[7].w(), 0.0f);
+    #endif
+}
+
+void ParticleSystemGLTest::draw() {
+    if(!checkSupport()) CORRADE_SKIP("Transform feedback objects are not supported.");
+
+    ParticleSystem system{64};
+    system.setEmissionRate(100.0f)
+        .setVelocitySpread(1.0f)
+        .setLifetimeRange(0.5f, 1.0f);
+    system.update(0.1f);
+    system.draw({});
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void ParticleSystemGLTest::debugPath() {
+    std::ostringstream out;
+    Debug{&out} << ParticleSystem::Path::Compute << ParticleSystem::Path(0xde);
+    CORRADE_COMPARE(out.str(), "Shaders::ParticleSystem::Path::Compute Shaders::ParticleSystem::Path(0xde)\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Shaders::Test::ParticleSystemGLTest)
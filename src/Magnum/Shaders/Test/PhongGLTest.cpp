@@ -23,9 +23,30 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <utility>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+
 #include "Magnum/OpenGLTester.h"
 #include "Magnum/Shaders/Phong.h"
 
+#ifndef MAGNUM_TARGET_GLES2
+#include "Magnum/Buffer.h"
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/Framebuffer.h"
+#include "Magnum/Image.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Mesh.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Renderbuffer.h"
+#include "Magnum/RenderbufferFormat.h"
+#include "Magnum/Renderer.h"
+#include "Magnum/Shader.h"
+#endif
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+#include "Magnum/Shaders/PhongLightGrid.h"
+#endif
+
 namespace Magnum { namespace Shaders { namespace Test {
 
 struct PhongGLTest: OpenGLTester {
@@ -39,6 +60,26 @@ struct PhongGLTest: OpenGLTester {
     void compileAmbientSpecularTexture();
     void compileDiffuseSpecularTexture();
     void compileAmbientDiffuseSpecularTexture();
+    void compileInstanced();
+    void compileAlphaMask();
+    void compileDepthOnly();
+    void compileDepthOnlyAlphaMask();
+    void compileMediumPrecision();
+
+    #ifndef MAGNUM_TARGET_GLES2
+    void drawDepthOnly();
+    void drawAlphaMask();
+    void drawMediumPrecision();
+    void compileSkinning();
+    void drawSkinning();
+    #endif
+
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    void compileTiledLights();
+    void drawTiledLights();
+    void compileShaderStorageBuffers();
+    void compileShaderStorageBuffersDepthOnly();
+    #endif
 };
 
 PhongGLTest::PhongGLTest() {
@@ -49,7 +90,28 @@ PhongGLTest::PhongGLTest() {
               &PhongGLTest::compileAmbientDiffuseTexture,
               &PhongGLTest::compileAmbientSpecularTexture,
               &PhongGLTest::compileDiffuseSpecularTexture,
-              &PhongGLTest::compileAmbientDiffuseSpecularTexture});
+              &PhongGLTest::compileAmbientDiffuseSpecularTexture,
+              &PhongGLTest::compileInstanced,
+              &PhongGLTest::compileAlphaMask,
+              &PhongGLTest::compileDepthOnly,
+              &PhongGLTest::compileDepthOnlyAlphaMask,
+              &PhongGLTest::compileMediumPrecision,
+
+              #ifndef MAGNUM_TARGET_GLES2
+              &PhongGLTest::drawDepthOnly,
+              &PhongGLTest::drawAlphaMask,
+              &PhongGLTest::drawMediumPrecision,
+              &PhongGLTest::compileSkinning,
+              &PhongGLTest::drawSkinning,
+              #endif
+
+              #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+              &PhongGLTest::compileTiledLights,
+              &PhongGLTest::drawTiledLights,
+              &PhongGLTest::compileShaderStorageBuffers,
+              &PhongGLTest::compileShaderStorageBuffersDepthOnly
+              #endif
+              });
 }
 
 void PhongGLTest::compile() {
@@ -132,6 +194,465 @@ void PhongGLTest::compileAmbientDiffuseSpecularTexture() {
     }
 }
 
+void PhongGLTest::compileInstanced() {
+    Shaders::Phong shader(Shaders::Phong::Flag::InstancedTransformation|Shaders::Phong::Flag::InstancedColor|Shaders::Phong::Flag::DiffuseTexture);
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+
+void PhongGLTest::compileAlphaMask() {
+    Shaders::Phong shader(Shaders::Phong::Flag::AlphaMask|Shaders::Phong::Flag::DiffuseTexture);
+    shader.setAlphaMask(0.25f);
+    MAGNUM_VERIFY_NO_ERROR();
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+
+void PhongGLTest::compileDepthOnly() {
+    Shaders::Phong shader(Shaders::Phong::Flag::DepthOnly|Shaders::Phong::Flag::InstancedTransformation|Shaders::Phong::Flag::AmbientTexture);
+
+    /* Lighting setters are a no-op */
+    shader.setAmbientColor(Color4{1.0f})
+        .setDiffuseColor(Color4{1.0f})
+        .setLightPosition({0.0f, 0.0f, 1.0f})
+        .setNormalMatrix(Matrix3x3{})
+        .setTransformationMatrix(Matrix4{})
+        .setProjectionMatrix(Matrix4{});
+    MAGNUM_VERIFY_NO_ERROR();
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+
+void PhongGLTest::compileDepthOnlyAlphaMask() {
+    Shaders::Phong shader(Shaders::Phong::Flag::DepthOnly|Shaders::Phong::Flag::AlphaMask|Shaders::Phong::Flag::DiffuseTexture);
+    shader.setDiffuseColor(Color4{1.0f})
+        .setAlphaMask(0.5f);
+    MAGNUM_VERIFY_NO_ERROR();
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+
+void PhongGLTest::compileMediumPrecision() {
+    Shaders::Phong shader{Shaders::Phong::Flag::MediumPrecision|Shaders::Phong::Flag::DiffuseTexture};
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+void PhongGLTest::drawDepthOnly() {
+    /* Triangle with varying depth covering the whole viewport */
+    struct Vertex {
+        Vector3 position;
+        Vector3 normal;
+    } vertexData[] = {
+        {{-1.0f, -1.0f, -0.9f}, Vector3::zAxis()},
+        {{ 3.0f, -1.0f,  0.3f}, Vector3::zAxis()},
+        {{-1.0f,  3.0f,  0.7f}, Vector3::zAxis()}
+    };
+    Buffer vertices;
+    vertices.setData(vertexData, BufferUsage::StaticDraw);
+
+    Mesh mesh;
+    mesh.setCount(3)
+        .addVertexBuffer(vertices, 0,
+            Shaders::Phong::Position{},
+            Shaders::Phong::Normal{});
+
+    Renderbuffer color, depth;
+    color.setStorage(RenderbufferFormat::RGBA8, Vector2i{4});
+    depth.setStorage(RenderbufferFormat::DepthComponent16, Vector2i{4});
+    Framebuffer framebuffer{{{}, Vector2i{4}}};
+    framebuffer.attachRenderbuffer(Framebuffer::ColorAttachment{0}, color)
+        .attachRenderbuffer(Framebuffer::BufferAttachment::Depth, depth)
+        .clear(FramebufferClear::Color|FramebufferClear::Depth)
+        .bind();
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    const Matrix4 transformation = Matrix4::rotationZ(Deg(15.0f));
+    Shaders::Phong depthShader{Shaders::Phong::Flag::DepthOnly};
+    depthShader.setTransformationMatrix(transformation)
+        .setProjectionMatrix(Matrix4{});
+    Shaders::Phong shader;
+    shader.setAmbientColor(Color4{1.0f, 0.0f, 0.0f, 1.0f})
+        .setDiffuseColor(Color4{0.0f, 0.0f})
+        .setSpecularColor(Color4{0.0f, 0.0f})
+        .setTransformationMatrix(transformation)
+        .setNormalMatrix(transformation.rotationScaling())
+        .setProjectionMatrix(Matrix4{});
+
+    /* Color writes are not masked, the depth-only shader doesn't write any
+       color anyway. With the invariant position both passes produce the same
+       depth, so all fragments pass the equality test. */
+    Renderer::enable(Renderer::Feature::DepthTest);
+    mesh.draw(depthShader);
+    Renderer::setDepthFunction(Renderer::DepthFunction::Equal);
+    Renderer::setDepthMask(false);
+    mesh.draw(shader);
+    Renderer::setDepthMask(true);
+    Renderer::setDepthFunction(Renderer::DepthFunction::Less);
+    Renderer::disable(Renderer::Feature::DepthTest);
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    Image2D image = framebuffer.read({{}, Vector2i{4}}, {PixelFormat::RGBA, PixelType::UnsignedByte});
+    CORRADE_COMPARE(image.data<Color4ub>()[5], (Color4ub{255, 0, 0, 255}));
+}
+
+void PhongGLTest::drawAlphaMask() {
+    struct Vertex {
+        Vector3 position;
+        Vector3 normal;
+    } vertexData[] = {
+        {{-1.0f, -1.0f, 0.0f}, Vector3::zAxis()},
+        {{ 3.0f, -1.0f, 0.0f}, Vector3::zAxis()},
+        {{-1.0f,  3.0f, 0.0f}, Vector3::zAxis()}
+    };
+    Buffer vertices;
+    vertices.setData(vertexData, BufferUsage::StaticDraw);
+
+    Mesh mesh;
+    mesh.setCount(3)
+        .addVertexBuffer(vertices, 0,
+            Shaders::Phong::Position{},
+            Shaders::Phong::Normal{});
+
+    Renderbuffer renderbuffer;
+    renderbuffer.setStorage(RenderbufferFormat::RGBA8, Vector2i{4});
+    Framebuffer framebuffer{{{}, Vector2i{4}}};
+    framebuffer.attachRenderbuffer(Framebuffer::ColorAttachment{0}, renderbuffer)
+        .clear(FramebufferClear::Color)
+        .bind();
+
+    Shaders::Phong shader{Shaders::Phong::Flag::AlphaMask};
+    shader.setAmbientColor(Color4{1.0f, 0.0f, 0.0f, 1.0f})
+        .setDiffuseColor(Color4{0.0f, 0.25f})
+        .setSpecularColor(Color4{0.0f, 0.0f})
+        .setTransformationMatrix(Matrix4{})
+        .setNormalMatrix(Matrix3x3{})
+        .setProjectionMatrix(Matrix4{});
+
+    /* Diffuse alpha below the mask, everything is discarded */
+    shader.setAlphaMask(0.5f);
+    mesh.draw(shader);
+    MAGNUM_VERIFY_NO_ERROR();
+    {
+        Image2D image = framebuffer.read({{}, Vector2i{4}}, {PixelFormat::RGBA, PixelType::UnsignedByte});
+        CORRADE_COMPARE(image.data<Color4ub>()[5], (Color4ub{0, 0, 0, 0}));
+    }
+
+    /* Diffuse alpha above the mask */
+    shader.setAlphaMask(0.125f);
+    mesh.draw(shader);
+    MAGNUM_VERIFY_NO_ERROR();
+    {
+        Image2D image = framebuffer.read({{}, Vector2i{4}}, {PixelFormat::RGBA, PixelType::UnsignedByte});
+        CORRADE_COMPARE(image.data<Color4ub>()[5].r(), 255);
+    }
+}
+
+void PhongGLTest::drawMediumPrecision() {
+    struct Vertex {
+        Vector3 position;
+        Vector3 normal;
+    } vertexData[] = {
+        {{-1.0f, -1.0f, 0.0f}, Vector3{-0.5f, -0.5f, 1.0f}.normalized()},
+        {{ 3.0f, -1.0f, 0.0f}, Vector3{ 0.5f, -0.5f, 1.0f}.normalized()},
+        {{-1.0f,  3.0f, 0.0f}, Vector3{-0.5f,  0.5f, 1.0f}.normalized()}
+    };
+    Buffer vertices;
+    vertices.setData(vertexData, BufferUsage::StaticDraw);
+
+    Mesh mesh;
+    mesh.setCount(3)
+        .addVertexBuffer(vertices, 0,
+            Shaders::Phong::Position{},
+            Shaders::Phong::Normal{});
+
+    Renderbuffer renderbuffer;
+    renderbuffer.setStorage(RenderbufferFormat::RGBA8, Vector2i{16});
+    Framebuffer framebuffer{{{}, Vector2i{16}}};
+    framebuffer.attachRenderbuffer(Framebuffer::ColorAttachment{0}, renderbuffer)
+        .bind();
+
+    /* Draw the same lit triangle with both variants, the results should be
+       nearly the same */
+    const Matrix4 transformation = Matrix4::translation(Vector3::zAxis(-2.0f));
+    Image2D images[]{
+        Image2D{PixelFormat::RGBA, PixelType::UnsignedByte},
+        Image2D{PixelFormat::RGBA, PixelType::UnsignedByte}};
+    for(std::size_t i = 0; i != 2; ++i) {
+        Shaders::Phong shader{i ? Shaders::Phong::Flag::MediumPrecision : Shaders::Phong::Flags{}};
+        shader.setAmbientColor(Color4{0.1f, 0.0f, 0.0f, 1.0f})
+            .setDiffuseColor(Color4{0.2f, 0.5f, 0.8f})
+            .setSpecularColor(Color4{1.0f})
+            .setShininess(20.0f)
+            .setLightPosition({1.0f, 1.0f, 2.0f})
+            .setTransformationMatrix(transformation)
+            .setNormalMatrix(transformation.rotationScaling())
+            .setProjectionMatrix(Matrix4::perspectiveProjection(Deg(60.0f), 1.0f, 0.1f, 10.0f));
+
+        framebuffer.clear(FramebufferClear::Color);
+        mesh.draw(shader);
+        MAGNUM_VERIFY_NO_ERROR();
+
+        framebuffer.read({{}, Vector2i{16}}, images[i]);
+    }
+
+    /* Verify that the test isn't trivial */
+    CORRADE_VERIFY(images[0].data<Color4ub>()[8*16 + 8].b() > 64);
+
+    for(std::size_t i = 0; i != 16*16; ++i) {
+        const Vector4i difference = Math::abs(Vector4i{images[0].data<Color4ub>()[i]} - Vector4i{images[1].data<Color4ub>()[i]});
+        CORRADE_COMPARE_AS(difference.max(), 2, TestSuite::Compare::LessOrEqual);
+    }
+}
+
+void PhongGLTest::compileSkinning() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(Extensions::GL::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+    #endif
+
+    Shaders::Phong shader{Shaders::Phong::Flag::Skinning|Shaders::Phong::Flag::DiffuseTexture, 16};
+    CORRADE_COMPARE(shader.jointCount(), 16);
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+
+void PhongGLTest::drawSkinning() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(Extensions::GL::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+    #endif
+
+    /* Full-screen triangle, all vertices fully influenced by joint 1 */
+    struct Vertex {
+        Vector3 position;
+        Vector3 normal;
+        Vector4ui jointIds;
+        Vector4 weights;
+    } vertexData[] = {
+        {{-1.0f, -1.0f, 0.0f}, Vector3::zAxis(), {0, 1, 0, 0}, {0.0f, 1.0f, 0.0f, 0.0f}},
+        {{ 3.0f, -1.0f, 0.0f}, Vector3::zAxis(), {0, 1, 0, 0}, {0.0f, 1.0f, 0.0f, 0.0f}},
+        {{-1.0f,  3.0f, 0.0f}, Vector3::zAxis(), {0, 1, 0, 0}, {0.0f, 1.0f, 0.0f, 0.0f}}
+    };
+    Buffer vertices;
+    vertices.setData(vertexData, BufferUsage::StaticDraw);
+
+    Mesh mesh;
+    mesh.setCount(3)
+        .addVertexBuffer(vertices, 0,
+            Shaders::Phong::Position{},
+            Shaders::Phong::Normal{},
+            Shaders::Phong::JointIds{},
+            Shaders::Phong::Weights{});
+
+    /* Joint 0 moves the triangle out of the viewport, joint 1 keeps it in
+       place */
+    Matrix4 joints[]{Matrix4::translation(Vector3::xAxis(10.0f)), Matrix4{}};
+    Buffer jointBuffer{Buffer::TargetHint::Uniform};
+    jointBuffer.setData(joints, BufferUsage::DynamicDraw);
+
+    Renderbuffer renderbuffer;
+    renderbuffer.setStorage(RenderbufferFormat::RGBA8, Vector2i{4});
+    Framebuffer framebuffer{{{}, Vector2i{4}}};
+    framebuffer.attachRenderbuffer(Framebuffer::ColorAttachment{0}, renderbuffer)
+        .clear(FramebufferClear::Color)
+        .bind();
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /* Only the ambient color contributes to the output */
+    Shaders::Phong shader{Shaders::Phong::Flag::Skinning, 2};
+    shader.setAmbientColor(Color4{0.0f, 1.0f, 0.0f})
+        .setDiffuseColor(Color4{0.0f, 0.0f})
+        .setSpecularColor(Color4{0.0f, 0.0f})
+        .setTransformationMatrix(Matrix4{})
+        .setNormalMatrix(Matrix3x3{})
+        .setProjectionMatrix(Matrix4{})
+        .bindJointBuffer(jointBuffer);
+    mesh.draw(shader);
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    {
+        Image2D image = framebuffer.read({{}, Vector2i{4}}, {PixelFormat::RGBA, PixelType::UnsignedByte});
+        CORRADE_COMPARE(image.data<Color4ub>()[5], (Color4ub{0, 255, 0, 255}));
+    }
+
+    /* Swapping the joints moves the triangle out */
+    std::swap(joints[0], joints[1]);
+    jointBuffer.setData(joints, BufferUsage::DynamicDraw);
+    framebuffer.clear(FramebufferClear::Color);
+    mesh.draw(shader);
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    {
+        Image2D image = framebuffer.read({{}, Vector2i{4}}, {PixelFormat::RGBA, PixelType::UnsignedByte});
+        CORRADE_COMPARE(image.data<Color4ub>()[5], (Color4ub{}));
+    }
+}
+#endif
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+void PhongGLTest::compileTiledLights() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::texture_buffer_object>())
+        CORRADE_SKIP(Extensions::GL::ARB::texture_buffer_object::string() + std::string(" is not supported"));
+    #else
+    if(!Context::current().isVersionSupported(Version::GLES320))
+        CORRADE_SKIP("OpenGL ES 3.2 is not supported");
+    #endif
+
+    Shaders::Phong shader{Shaders::Phong::Flag::TiledLights|Shaders::Phong::Flag::DiffuseTexture};
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+
+void PhongGLTest::drawTiledLights() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::texture_buffer_object>())
+        CORRADE_SKIP(Extensions::GL::ARB::texture_buffer_object::string() + std::string(" is not supported"));
+    #else
+    if(!Context::current().isVersionSupported(Version::GLES320))
+        CORRADE_SKIP("OpenGL ES 3.2 is not supported");
+    #endif
+
+    /* Full-screen triangle facing the camera */
+    struct Vertex {
+        Vector3 position;
+        Vector3 normal;
+    } vertexData[] = {
+        {{-1.0f, -1.0f, -0.5f}, Vector3::zAxis()},
+        {{ 3.0f, -1.0f, -0.5f}, Vector3::zAxis()},
+        {{-1.0f,  3.0f, -0.5f}, Vector3::zAxis()}
+    };
+    Buffer vertices;
+    vertices.setData(vertexData, BufferUsage::StaticDraw);
+
+    Mesh mesh;
+    mesh.setCount(3)
+        .addVertexBuffer(vertices, 0,
+            Shaders::Phong::Position{},
+            Shaders::Phong::Normal{});
+
+    Renderbuffer renderbuffer;
+    renderbuffer.setStorage(RenderbufferFormat::RGBA8, Vector2i{4});
+    Framebuffer framebuffer{{{}, Vector2i{4}}};
+    framebuffer.attachRenderbuffer(Framebuffer::ColorAttachment{0}, renderbuffer)
+        .clear(FramebufferClear::Color)
+        .bind();
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /* The uniform light is black, so only the tiled lights contribute */
+    Shaders::PhongLightGrid grid{2};
+    Shaders::Phong shader{Shaders::Phong::Flag::TiledLights};
+    shader.setAmbientColor(Color4{0.0f, 1.0f})
+        .setDiffuseColor(Color4{1.0f})
+        .setSpecularColor(Color4{0.0f, 0.0f})
+        .setLightColor(Color4{0.0f, 0.0f})
+        .setLightPosition({0.0f, 0.0f, 1.0f})
+        .setTransformationMatrix(Matrix4{})
+        .setNormalMatrix(Matrix3x3{})
+        .setProjectionMatrix(Matrix4{});
+
+    /* Red light in front of the surface */
+    grid.setLights(Matrix4{}, Vector2i{4}, {
+        Shaders::PhongLight{{0.0f, 0.0f, -0.25f}, 2.0f, Color3{1.0f, 0.0f, 0.0f}}
+    });
+    shader.bindLightGrid(grid);
+    mesh.draw(shader);
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    {
+        Image2D image = framebuffer.read({{}, Vector2i{4}}, {PixelFormat::RGBA, PixelType::UnsignedByte});
+        const Color4ub pixel = image.data<Color4ub>()[5];
+        CORRADE_VERIFY(pixel.r() > 32);
+        CORRADE_COMPARE(pixel.g(), 0);
+        CORRADE_COMPARE(pixel.b(), 0);
+    }
+
+    /* Without any lights in the grid the surface is black */
+    grid.setLights(Matrix4{}, Vector2i{4}, Containers::ArrayView<const Shaders::PhongLight>{});
+    shader.bindLightGrid(grid);
+    framebuffer.clear(FramebufferClear::Color);
+    mesh.draw(shader);
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    {
+        Image2D image = framebuffer.read({{}, Vector2i{4}}, {PixelFormat::RGBA, PixelType::UnsignedByte});
+        CORRADE_COMPARE(image.data<Color4ub>()[5], (Color4ub{0, 0, 0, 255}));
+    }
+}
+
+void PhongGLTest::compileShaderStorageBuffers() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::shader_storage_buffer_object>())
+        CORRADE_SKIP(Extensions::GL::ARB::shader_storage_buffer_object::string() + std::string(" is not supported"));
+    #endif
+    if(Shader::maxShaderStorageBlocks(Shader::Type::Vertex) < 1)
+        CORRADE_SKIP("Shader storage buffers are not supported in vertex shaders");
+
+    Shaders::Phong shader{Shaders::Phong::Flag::ShaderStorageBuffers|Shaders::Phong::Flag::DiffuseTexture|Shaders::Phong::Flag::InstancedColor};
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+
+void PhongGLTest::compileShaderStorageBuffersDepthOnly() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::shader_storage_buffer_object>())
+        CORRADE_SKIP(Extensions::GL::ARB::shader_storage_buffer_object::string() + std::string(" is not supported"));
+    #endif
+    if(Shader::maxShaderStorageBlocks(Shader::Type::Vertex) < 1)
+        CORRADE_SKIP("Shader storage buffers are not supported in vertex shaders");
+
+    Shaders::Phong shader{Shaders::Phong::Flag::ShaderStorageBuffers|Shaders::Phong::Flag::DepthOnly|Shaders::Phong::Flag::AlphaMask};
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+#endif
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Shaders::Test::PhongGLTest)
@@ -0,0 +1,182 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/OpenGLTester.h"
+#include "Magnum/Math/Angle.h"
+#include "Magnum/Shaders/PhongLightGrid.h"
+
+namespace Magnum { namespace Shaders { namespace Test {
+
+struct PhongLightGridGLTest: OpenGLTester {
+    explicit PhongLightGridGLTest();
+
+    void construct();
+    void constructMove();
+
+    void setLights();
+    void setLightsBehindCamera();
+    void setLightsCameraPlane();
+    void setLightsOutside();
+};
+
+PhongLightGridGLTest::PhongLightGridGLTest() {
+    addTests({&PhongLightGridGLTest::construct,
+              &PhongLightGridGLTest::constructMove,
+
+              &PhongLightGridGLTest::setLights,
+              &PhongLightGridGLTest::setLightsBehindCamera,
+              &PhongLightGridGLTest::setLightsCameraPlane,
+              &PhongLightGridGLTest::setLightsOutside});
+}
+
+namespace {
+    bool checkSupport() {
+        #ifndef MAGNUM_TARGET_GLES
+        return Context::current().isExtensionSupported<Extensions::GL::ARB::texture_buffer_object>();
+        #else
+        return Context::current().isVersionSupported(Version::GLES320);
+        #endif
+    }
+
+    using namespace Math::Literals;
+
+    const Matrix4 Projection = Matrix4::perspectiveProjection(90.0_degf, 1.0f, 0.1f, 100.0f);
+}
+
+void PhongLightGridGLTest::construct() {
+    if(!checkSupport()) CORRADE_SKIP("Buffer textures are not supported.");
+
+    PhongLightGrid grid{8};
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(grid.tileSize(), 8);
+    CORRADE_COMPARE(grid.tileCount(), Vector2i{});
+    CORRADE_COMPARE(grid.lightCount(), 0);
+    CORRADE_VERIFY(grid.tiles().empty());
+    CORRADE_VERIFY(grid.lightIndices().empty());
+    CORRADE_VERIFY(grid.lightTexture().id() > 0);
+    CORRADE_VERIFY(grid.tileTexture().id() > 0);
+    CORRADE_VERIFY(grid.lightIndexTexture().id() > 0);
+}
+
+void PhongLightGridGLTest::constructMove() {
+    if(!checkSupport()) CORRADE_SKIP("Buffer textures are not supported.");
+
+    PhongLightGrid a{8};
+    const GLuint id = a.tileTexture().id();
+
+    PhongLightGrid b{std::move(a)};
+    CORRADE_COMPARE(a.tileTexture().id(), 0);
+    CORRADE_COMPARE(b.tileTexture().id(), id);
+    CORRADE_COMPARE(b.tileSize(), 8);
+
+    PhongLightGrid c{16};
+    const GLuint cId = c.tileTexture().id();
+    c = std::move(b);
+    CORRADE_COMPARE(b.tileTexture().id(), cId);
+    CORRADE_COMPARE(c.tileTexture().id(), id);
+    CORRADE_COMPARE(c.tileSize(), 8);
+}
+
+void PhongLightGridGLTest::setLights() {
+    if(!checkSupport()) CORRADE_SKIP("Buffer textures are not supported.");
+
+    /* 4x4 tiles, one light in the center touching the four central tiles,
+       one small light in the bottom left tile */
+    PhongLightGrid grid{8};
+    grid.setLights(Projection, {30, 32}, {
+        PhongLight{{0.0f, 0.0f, -10.0f}, 1.0f, Color3{1.0f, 0.0f, 0.0f}},
+        PhongLight{{-7.5f, -7.5f, -10.0f}, 0.5f}
+    });
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(grid.tileCount(), (Vector2i{4, 4}));
+    CORRADE_COMPARE(grid.lightCount(), 2);
+    CORRADE_COMPARE(grid.tiles().size(), 16);
+
+    /* Bottom left tile has the second light */
+    CORRADE_COMPARE(grid.tiles()[0].y(), 1);
+    CORRADE_COMPARE(grid.lightIndices()[grid.tiles()[0].x()], 1);
+
+    /* Central tiles have the first light */
+    for(const std::size_t tile: {5, 6, 9, 10}) {
+        CORRADE_COMPARE(grid.tiles()[tile].y(), 1);
+        CORRADE_COMPARE(grid.lightIndices()[grid.tiles()[tile].x()], 0);
+    }
+
+    /* The rest is empty */
+    for(const std::size_t tile: {1, 2, 3, 4, 7, 8, 11, 12, 13, 14, 15})
+        CORRADE_COMPARE(grid.tiles()[tile].y(), 0);
+
+    CORRADE_COMPARE(grid.lightIndices().size(), 5);
+}
+
+void PhongLightGridGLTest::setLightsBehindCamera() {
+    if(!checkSupport()) CORRADE_SKIP("Buffer textures are not supported.");
+
+    PhongLightGrid grid{8};
+    grid.setLights(Projection, {32, 32}, {
+        PhongLight{{0.0f, 0.0f, 10.0f}, 1.0f}
+    });
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(grid.lightCount(), 1);
+    CORRADE_VERIFY(grid.lightIndices().empty());
+}
+
+void PhongLightGridGLTest::setLightsCameraPlane() {
+    if(!checkSupport()) CORRADE_SKIP("Buffer textures are not supported.");
+
+    /* Light surrounding the camera affects everything */
+    PhongLightGrid grid{8};
+    grid.setLights(Projection, {32, 32}, {
+        PhongLight{{0.0f, 0.0f, -0.5f}, 1.0f}
+    });
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(grid.lightIndices().size(), 16);
+    for(const Vector2ui& tile: grid.tiles())
+        CORRADE_COMPARE(tile.y(), 1);
+}
+
+void PhongLightGridGLTest::setLightsOutside() {
+    if(!checkSupport()) CORRADE_SKIP("Buffer textures are not supported.");
+
+    /* Light far to the right and above of the view frustum */
+    PhongLightGrid grid{8};
+    grid.setLights(Projection, {32, 32}, {
+        PhongLight{{30.0f, 0.0f, -10.0f}, 1.0f},
+        PhongLight{{0.0f, 30.0f, -10.0f}, 1.0f}
+    });
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(grid.lightIndices().empty());
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Shaders::Test::PhongLightGridGLTest)
@@ -23,6 +23,7 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <cstddef>
 #include <Corrade/TestSuite/Tester.h>
 
 #include "Magnum/Shaders/Phong.h"
@@ -33,10 +34,19 @@ struct PhongTest: TestSuite::Tester {
     explicit PhongTest();
 
     void constructNoCreate();
+
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    void drawUniform();
+    #endif
 };
 
 PhongTest::PhongTest() {
-    addTests({&PhongTest::constructNoCreate});
+    addTests({&PhongTest::constructNoCreate,
+
+              #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+              &PhongTest::drawUniform
+              #endif
+              });
 }
 
 void PhongTest::constructNoCreate() {
@@ -48,6 +58,27 @@ void PhongTest::constructNoCreate() {
     CORRADE_VERIFY(true);
 }
 
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+void PhongTest::drawUniform() {
+    /* Matches the std430 layout of the PhongDrawData struct */
+    CORRADE_COMPARE(sizeof(PhongDrawUniform), 176);
+    CORRADE_COMPARE(offsetof(PhongDrawUniform, transformationMatrix), 0);
+    CORRADE_COMPARE(offsetof(PhongDrawUniform, normalMatrix), 64);
+    CORRADE_COMPARE(offsetof(PhongDrawUniform, ambientColor), 112);
+    CORRADE_COMPARE(offsetof(PhongDrawUniform, diffuseColor), 128);
+    CORRADE_COMPARE(offsetof(PhongDrawUniform, specularColor), 144);
+    CORRADE_COMPARE(offsetof(PhongDrawUniform, shininess), 160);
+
+    const PhongDrawUniform a;
+    CORRADE_COMPARE(a.transformationMatrix, Matrix4{});
+    CORRADE_COMPARE(Matrix3x3{Matrix3{a.normalMatrix}}, Matrix3x3{});
+    CORRADE_COMPARE(a.ambientColor, (Color4{0.0f, 1.0f}));
+    CORRADE_COMPARE(a.diffuseColor, Color4{1.0f});
+    CORRADE_COMPARE(a.specularColor, Color4{1.0f});
+    CORRADE_COMPARE(a.shininess, 80.0f);
+}
+#endif
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Shaders::Test::PhongTest)
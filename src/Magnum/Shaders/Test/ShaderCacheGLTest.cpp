@@ -0,0 +1,143 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/OpenGLTester.h"
+#include "Magnum/Shaders/Flat.h"
+#include "Magnum/Shaders/Phong.h"
+#include "Magnum/Shaders/ShaderCache.h"
+#include "Magnum/Shaders/VertexColor.h"
+
+namespace Magnum { namespace Shaders { namespace Test {
+
+struct ShaderCacheGLTest: OpenGLTester {
+    explicit ShaderCacheGLTest();
+
+    void get();
+    void getNoFlags();
+    void precompile();
+    void clear();
+    void move();
+};
+
+ShaderCacheGLTest::ShaderCacheGLTest() {
+    addTests({&ShaderCacheGLTest::get,
+              &ShaderCacheGLTest::getNoFlags,
+              &ShaderCacheGLTest::precompile,
+              &ShaderCacheGLTest::clear,
+              &ShaderCacheGLTest::move});
+}
+
+void ShaderCacheGLTest::get() {
+    ShaderCache cache;
+    CORRADE_COMPARE(cache.size(), 0);
+    CORRADE_VERIFY(!cache.contains<Phong>(Phong::Flag::DiffuseTexture));
+
+    Phong& a = cache.get<Phong>(Phong::Flag::DiffuseTexture);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(a.flags() == Phong::Flag::DiffuseTexture);
+    CORRADE_VERIFY(cache.contains<Phong>(Phong::Flag::DiffuseTexture));
+    CORRADE_COMPARE(cache.size(), 1);
+
+    /* Same variant gives back the same instance */
+    CORRADE_COMPARE(&cache.get<Phong>(Phong::Flag::DiffuseTexture), &a);
+    CORRADE_COMPARE(cache.size(), 1);
+
+    /* Different flags or different type with the same flag value is a new
+       variant */
+    Phong& b = cache.get<Phong>(Phong::Flag::AmbientTexture);
+    Flat3D& c = cache.get<Flat3D>(Flat3D::Flag::Textured);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(&b != &a);
+    CORRADE_VERIFY(b.flags() == Phong::Flag::AmbientTexture);
+    CORRADE_VERIFY(c.flags() == Flat3D::Flag::Textured);
+    CORRADE_COMPARE(cache.size(), 3);
+}
+
+void ShaderCacheGLTest::getNoFlags() {
+    ShaderCache cache;
+
+    VertexColor3D& a = cache.get<VertexColor3D>();
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(cache.contains<VertexColor3D>());
+    CORRADE_VERIFY(!cache.contains<VertexColor2D>());
+    CORRADE_COMPARE(&cache.get<VertexColor3D>(), &a);
+
+    /* Default flags are the same variant as no flags */
+    Phong& b = cache.get<Phong>();
+    CORRADE_COMPARE(&cache.get<Phong>(Phong::Flags{}), &b);
+    CORRADE_COMPARE(cache.size(), 2);
+}
+
+void ShaderCacheGLTest::precompile() {
+    ShaderCache cache;
+    cache.precompile<Phong>({{}, Phong::Flag::DiffuseTexture, Phong::Flag::DiffuseTexture})
+         .precompile<Flat2D>({{}, Flat2D::Flag::Textured});
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /* Duplicates are compiled only once */
+    CORRADE_COMPARE(cache.size(), 4);
+    CORRADE_VERIFY(cache.contains<Phong>(Phong::Flags{}));
+    CORRADE_VERIFY(cache.contains<Phong>(Phong::Flag::DiffuseTexture));
+    CORRADE_VERIFY(cache.contains<Flat2D>(Flat2D::Flag::Textured));
+    CORRADE_VERIFY(!cache.contains<Flat3D>(Flat3D::Flag::Textured));
+
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(cache.get<Phong>(Phong::Flag::DiffuseTexture).validate().first);
+    }
+}
+
+void ShaderCacheGLTest::clear() {
+    ShaderCache cache;
+    cache.get<Phong>();
+    cache.get<Flat3D>();
+    CORRADE_COMPARE(cache.size(), 2);
+
+    cache.clear();
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(cache.size(), 0);
+    CORRADE_VERIFY(!cache.contains<Phong>());
+}
+
+void ShaderCacheGLTest::move() {
+    ShaderCache a;
+    Phong& shader = a.get<Phong>();
+
+    /* References stay valid after move */
+    ShaderCache b{std::move(a)};
+    CORRADE_COMPARE(b.size(), 1);
+    CORRADE_COMPARE(&b.get<Phong>(), &shader);
+
+    ShaderCache c;
+    c = std::move(b);
+    CORRADE_COMPARE(c.size(), 1);
+    CORRADE_COMPARE(&c.get<Phong>(), &shader);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Shaders::Test::ShaderCacheGLTest)
@@ -0,0 +1,569 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <vector>
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Buffer.h"
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/Framebuffer.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/Mesh.h"
+#include "Magnum/OpenGLTester.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Renderbuffer.h"
+#include "Magnum/RenderbufferFormat.h"
+#include "Magnum/Renderer.h"
+#include "Magnum/Texture.h"
+#include "Magnum/TextureFormat.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/Shaders/DistanceFieldVector.h"
+#include "Magnum/Shaders/Flat.h"
+#include "Magnum/Shaders/MeshVisualizer.h"
+#include "Magnum/Shaders/Phong.h"
+#include "Magnum/Shaders/Vector.h"
+#include "Magnum/Shaders/VertexColor.h"
+
+namespace Magnum { namespace Shaders { namespace Test {
+
+/* Fill rate is measured by drawing several full-screen quads on top of each
+   other into framebuffers of various sizes, vertex throughput by drawing
+   dense grids squeezed into a single pixel of a tiny framebuffer. */
+struct ShadersGLBenchmark: OpenGLTester {
+    explicit ShadersGLBenchmark();
+
+    void phongFill();
+    void phongVertices();
+    void flatFill();
+    void flatVertices();
+    void vertexColorFill();
+    void vertexColorVertices();
+    void meshVisualizerFill();
+    void meshVisualizerVertices();
+    void vectorFill();
+    void vectorVertices();
+    void distanceFieldVectorFill();
+    void distanceFieldVectorVertices();
+};
+
+namespace {
+
+#ifndef MAGNUM_TARGET_GLES
+typedef Extensions::GL::ARB::timer_query TimerQuery;
+#else
+typedef Extensions::GL::EXT::disjoint_timer_query TimerQuery;
+#endif
+
+enum: std::size_t {
+    BenchmarkBatchCount = 10,
+    BenchmarkRepeats = 4,
+    /* Full-screen quads drawn in each repeat of fill rate benchmarks */
+    Overdraw = 8
+};
+
+constexpr struct {
+    const char* name;
+    Int size;
+} FillData[] {
+    {"256x256", 256},
+    {"1024x1024", 1024},
+    {"2048x2048", 2048}
+};
+
+constexpr struct {
+    const char* name;
+    UnsignedInt cells;
+} VertexData[] {
+    {"10k triangles", 71},
+    {"100k triangles", 224},
+    {"1M triangles", 708}
+};
+
+constexpr struct {
+    const char* name;
+    Phong::Flags flags;
+} PhongData[] {
+    {"", {}},
+    {"ambient texture", Phong::Flag::AmbientTexture},
+    {"diffuse texture", Phong::Flag::DiffuseTexture},
+    {"specular texture", Phong::Flag::SpecularTexture},
+    {"all textures", Phong::Flag::AmbientTexture|Phong::Flag::DiffuseTexture|Phong::Flag::SpecularTexture},
+    {"diffuse texture, alpha mask", Phong::Flag::DiffuseTexture|Phong::Flag::AlphaMask},
+    {"medium precision", Phong::Flag::MediumPrecision},
+    {"all textures, medium precision", Phong::Flag::AmbientTexture|Phong::Flag::DiffuseTexture|Phong::Flag::SpecularTexture|Phong::Flag::MediumPrecision},
+    {"depth only", Phong::Flag::DepthOnly}
+};
+
+constexpr struct {
+    const char* name;
+    MeshVisualizer::Flags flags;
+} MeshVisualizerData[] {
+    {"", {}},
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    {"wireframe", MeshVisualizer::Flag::Wireframe},
+    #endif
+    /* The grid is indexed, so the wireframe isn't rendered correctly without
+       a geometry shader, but the amount of work done is the same */
+    #ifndef MAGNUM_TARGET_GLES2
+    {"wireframe w/o a geometry shader", MeshVisualizer::Flag::Wireframe|MeshVisualizer::Flag::NoGeometryShader}
+    #endif
+};
+
+constexpr struct {
+    const char* name;
+    DistanceFieldVector2D::Flags flags;
+} DistanceFieldVectorData[] {
+    {"", {}},
+    {"multi-channel", DistanceFieldVector2D::Flag::MultiChannel}
+};
+
+/* Position, normal, texture coordinates and color, which covers inputs of
+   all 3D shaders. The 2D shaders take just the first two components of the
+   position and texture coordinates. */
+struct Vertex {
+    Vector3 position;
+    Vector3 normal;
+    Vector2 textureCoordinates;
+    Color4 color;
+};
+
+struct Vertex2D {
+    Vector2 position;
+    Vector2 textureCoordinates;
+};
+
+/* Grid of cells*cells quads spanning given rectangle in NDC */
+struct GridMesh {
+    explicit GridMesh(UnsignedInt cells, const Range2D& rectangle, bool twoDimensional);
+
+    Buffer vertices, indices;
+    Mesh mesh;
+};
+
+GridMesh::GridMesh(const UnsignedInt cells, const Range2D& rectangle, const bool twoDimensional): vertices{Buffer::TargetHint::Array}, indices{Buffer::TargetHint::ElementArray} {
+    std::vector<Vertex> data3D;
+    std::vector<Vertex2D> data2D;
+    for(UnsignedInt y = 0; y <= cells; ++y) for(UnsignedInt x = 0; x <= cells; ++x) {
+        const Vector2 t = Vector2{Float(x), Float(y)}/Float(cells);
+        const Vector2 position = rectangle.min() + t*rectangle.size();
+        if(twoDimensional) data2D.push_back({position, t});
+        else data3D.push_back({{position, 0.0f}, Vector3::zAxis(), t, Color4{t.x(), t.y(), 1.0f}});
+    }
+
+    std::vector<UnsignedInt> indexData;
+    indexData.reserve(cells*cells*6);
+    for(UnsignedInt y = 0; y != cells; ++y) for(UnsignedInt x = 0; x != cells; ++x) {
+        const UnsignedInt i = y*(cells + 1) + x;
+        for(UnsignedInt index: {i, i + 1, i + cells + 2, i, i + cells + 2, i + cells + 1})
+            indexData.push_back(index);
+    }
+
+    indices.setData(indexData, BufferUsage::StaticDraw);
+    mesh.setCount(indexData.size())
+        .setIndexBuffer(indices, 0, Mesh::IndexType::UnsignedInt, 0, (cells + 1)*(cells + 1) - 1);
+
+    if(twoDimensional) {
+        vertices.setData(data2D, BufferUsage::StaticDraw);
+        mesh.addVertexBuffer(vertices, 0,
+            Generic2D::Position{},
+            Generic2D::TextureCoordinates{});
+    } else {
+        vertices.setData(data3D, BufferUsage::StaticDraw);
+        mesh.addVertexBuffer(vertices, 0,
+            Generic3D::Position{},
+            Generic3D::Normal{},
+            Generic3D::TextureCoordinates{},
+            Generic3D::Color{Generic3D::Color::Components::Four});
+    }
+}
+
+/* Full-screen quad for fill rate benchmarks */
+const Range2D FullScreen{Vector2{-1.0f}, Vector2{1.0f}};
+
+/* Grid squeezed into a fraction of a pixel for vertex benchmarks */
+const Range2D SinglePixel{Vector2{-0.01f}, Vector2{0.01f}};
+constexpr Int VertexFramebufferSize = 64;
+
+/* Color framebuffer of given size, bound for drawing */
+struct TestFramebuffer {
+    explicit TestFramebuffer(Int size);
+
+    Renderbuffer color;
+    Framebuffer framebuffer;
+};
+
+TestFramebuffer::TestFramebuffer(const Int size): framebuffer{{{}, Vector2i{size}}} {
+    #ifndef MAGNUM_TARGET_GLES2
+    color.setStorage(RenderbufferFormat::RGBA8, Vector2i{size});
+    #else
+    color.setStorage(RenderbufferFormat::RGBA4, Vector2i{size});
+    #endif
+    framebuffer.attachRenderbuffer(Framebuffer::ColorAttachment{0}, color)
+        .clear(FramebufferClear::Color)
+        .bind();
+}
+
+/* Checkerboard with varying alpha so alpha mask and texture filtering have
+   something to do */
+Texture2D testTexture() {
+    constexpr Int Size = 256;
+    Containers::Array<Color4ub> data{Size*Size};
+    for(Int y = 0; y != Size; ++y) for(Int x = 0; x != Size; ++x)
+        data[y*Size + x] = ((x/16 + y/16) % 2) ?
+            Color4ub{255, 192, 128, UnsignedByte(x)} :
+            Color4ub{64, 128, 192, UnsignedByte(y)};
+
+    Texture2D texture;
+    texture.setMinificationFilter(Sampler::Filter::Linear)
+        .setMagnificationFilter(Sampler::Filter::Linear)
+        .setWrapping(Sampler::Wrapping::Repeat)
+        #ifndef MAGNUM_TARGET_GLES2
+        .setImage(0, TextureFormat::RGBA8, ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte, Vector2i{Size}, data});
+        #else
+        .setImage(0, TextureFormat::RGBA, ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte, Vector2i{Size}, data});
+        #endif
+    return texture;
+}
+
+}
+
+ShadersGLBenchmark::ShadersGLBenchmark() {
+    addInstancedBenchmarks({&ShadersGLBenchmark::phongFill}, BenchmarkBatchCount,
+        Containers::arraySize(PhongData)*Containers::arraySize(FillData), BenchmarkType::GpuTime);
+    addInstancedBenchmarks({&ShadersGLBenchmark::phongVertices}, BenchmarkBatchCount,
+        Containers::arraySize(PhongData)*Containers::arraySize(VertexData), BenchmarkType::GpuTime);
+
+    addInstancedBenchmarks({&ShadersGLBenchmark::flatFill,
+                            &ShadersGLBenchmark::flatVertices,
+                            &ShadersGLBenchmark::vertexColorFill,
+                            &ShadersGLBenchmark::vertexColorVertices,
+                            &ShadersGLBenchmark::vectorFill,
+                            &ShadersGLBenchmark::vectorVertices}, BenchmarkBatchCount,
+        Containers::arraySize(FillData), BenchmarkType::GpuTime);
+
+    addInstancedBenchmarks({&ShadersGLBenchmark::meshVisualizerFill}, BenchmarkBatchCount,
+        Containers::arraySize(MeshVisualizerData)*Containers::arraySize(FillData), BenchmarkType::GpuTime);
+    addInstancedBenchmarks({&ShadersGLBenchmark::meshVisualizerVertices}, BenchmarkBatchCount,
+        Containers::arraySize(MeshVisualizerData)*Containers::arraySize(VertexData), BenchmarkType::GpuTime);
+
+    addInstancedBenchmarks({&ShadersGLBenchmark::distanceFieldVectorFill}, BenchmarkBatchCount,
+        Containers::arraySize(DistanceFieldVectorData)*Containers::arraySize(FillData), BenchmarkType::GpuTime);
+    addInstancedBenchmarks({&ShadersGLBenchmark::distanceFieldVectorVertices}, BenchmarkBatchCount,
+        Containers::arraySize(DistanceFieldVectorData)*Containers::arraySize(VertexData), BenchmarkType::GpuTime);
+}
+
+void ShadersGLBenchmark::phongFill() {
+    if(!Context::current().isExtensionSupported<TimerQuery>())
+        CORRADE_SKIP(TimerQuery::string() + std::string(" is not supported"));
+
+    const auto& data = PhongData[testCaseInstanceId()/Containers::arraySize(FillData)];
+    const auto& fill = FillData[testCaseInstanceId()%Containers::arraySize(FillData)];
+    setTestCaseDescription(std::string{fill.name} + (*data.name ? ", " : "") + data.name);
+
+    TestFramebuffer framebuffer{fill.size};
+    GridMesh grid{1, FullScreen, false};
+    Texture2D texture = testTexture();
+
+    Phong shader{data.flags};
+    shader.setLightPosition({0.0f, 0.0f, 1.0f})
+        .setNormalMatrix({});
+    if(data.flags & Phong::Flag::AmbientTexture) shader.bindAmbientTexture(texture);
+    if(data.flags & Phong::Flag::DiffuseTexture) shader.bindDiffuseTexture(texture);
+    if(data.flags & Phong::Flag::SpecularTexture) shader.bindSpecularTexture(texture);
+    if(data.flags & Phong::Flag::AlphaMask) shader.setAlphaMask(0.5f);
+
+    CORRADE_BENCHMARK(BenchmarkRepeats)
+        for(std::size_t i = 0; i != Overdraw; ++i) grid.mesh.draw(shader);
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void ShadersGLBenchmark::phongVertices() {
+    if(!Context::current().isExtensionSupported<TimerQuery>())
+        CORRADE_SKIP(TimerQuery::string() + std::string(" is not supported"));
+
+    const auto& data = PhongData[testCaseInstanceId()/Containers::arraySize(VertexData)];
+    const auto& vertex = VertexData[testCaseInstanceId()%Containers::arraySize(VertexData)];
+    setTestCaseDescription(std::string{vertex.name} + (*data.name ? ", " : "") + data.name);
+
+    TestFramebuffer framebuffer{VertexFramebufferSize};
+    GridMesh grid{vertex.cells, SinglePixel, false};
+    Texture2D texture = testTexture();
+
+    Phong shader{data.flags};
+    shader.setLightPosition({0.0f, 0.0f, 1.0f})
+        .setNormalMatrix({});
+    if(data.flags & Phong::Flag::AmbientTexture) shader.bindAmbientTexture(texture);
+    if(data.flags & Phong::Flag::DiffuseTexture) shader.bindDiffuseTexture(texture);
+    if(data.flags & Phong::Flag::SpecularTexture) shader.bindSpecularTexture(texture);
+    if(data.flags & Phong::Flag::AlphaMask) shader.setAlphaMask(0.5f);
+
+    CORRADE_BENCHMARK(BenchmarkRepeats)
+        grid.mesh.draw(shader);
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void ShadersGLBenchmark::flatFill() {
+    if(!Context::current().isExtensionSupported<TimerQuery>())
+        CORRADE_SKIP(TimerQuery::string() + std::string(" is not supported"));
+
+    const auto& fill = FillData[testCaseInstanceId()];
+    setTestCaseDescription(fill.name);
+
+    TestFramebuffer framebuffer{fill.size};
+    GridMesh grid{1, FullScreen, false};
+    Texture2D texture = testTexture();
+
+    Flat3D shader{Flat3D::Flag::Textured};
+    shader.bindTexture(texture);
+
+    CORRADE_BENCHMARK(BenchmarkRepeats)
+        for(std::size_t i = 0; i != Overdraw; ++i) grid.mesh.draw(shader);
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void ShadersGLBenchmark::flatVertices() {
+    if(!Context::current().isExtensionSupported<TimerQuery>())
+        CORRADE_SKIP(TimerQuery::string() + std::string(" is not supported"));
+
+    /* Reusing the fill instance count for vertex data of the same size */
+    const auto& vertex = VertexData[testCaseInstanceId()];
+    setTestCaseDescription(vertex.name);
+
+    TestFramebuffer framebuffer{VertexFramebufferSize};
+    GridMesh grid{vertex.cells, SinglePixel, false};
+
+    Flat3D shader;
+    shader.setColor(Color4{0.5f});
+
+    CORRADE_BENCHMARK(BenchmarkRepeats)
+        grid.mesh.draw(shader);
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void ShadersGLBenchmark::vertexColorFill() {
+    if(!Context::current().isExtensionSupported<TimerQuery>())
+        CORRADE_SKIP(TimerQuery::string() + std::string(" is not supported"));
+
+    const auto& fill = FillData[testCaseInstanceId()];
+    setTestCaseDescription(fill.name);
+
+    TestFramebuffer framebuffer{fill.size};
+    GridMesh grid{1, FullScreen, false};
+
+    VertexColor3D shader;
+
+    CORRADE_BENCHMARK(BenchmarkRepeats)
+        for(std::size_t i = 0; i != Overdraw; ++i) grid.mesh.draw(shader);
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void ShadersGLBenchmark::vertexColorVertices() {
+    if(!Context::current().isExtensionSupported<TimerQuery>())
+        CORRADE_SKIP(TimerQuery::string() + std::string(" is not supported"));
+
+    const auto& vertex = VertexData[testCaseInstanceId()];
+    setTestCaseDescription(vertex.name);
+
+    TestFramebuffer framebuffer{VertexFramebufferSize};
+    GridMesh grid{vertex.cells, SinglePixel, false};
+
+    VertexColor3D shader;
+
+    CORRADE_BENCHMARK(BenchmarkRepeats)
+        grid.mesh.draw(shader);
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void ShadersGLBenchmark::meshVisualizerFill() {
+    if(!Context::current().isExtensionSupported<TimerQuery>())
+        CORRADE_SKIP(TimerQuery::string() + std::string(" is not supported"));
+
+    const auto& data = MeshVisualizerData[testCaseInstanceId()/Containers::arraySize(FillData)];
+    const auto& fill = FillData[testCaseInstanceId()%Containers::arraySize(FillData)];
+    setTestCaseDescription(std::string{fill.name} + (*data.name ? ", " : "") + data.name);
+
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    if((data.flags & MeshVisualizer::Flag::Wireframe) && !(data.flags & MeshVisualizer::Flag::NoGeometryShader)) {
+        #ifndef MAGNUM_TARGET_GLES
+        if(!Context::current().isExtensionSupported<Extensions::GL::ARB::geometry_shader4>())
+            CORRADE_SKIP(Extensions::GL::ARB::geometry_shader4::string() + std::string(" is not supported"));
+        #else
+        if(!Context::current().isExtensionSupported<Extensions::GL::EXT::geometry_shader>())
+            CORRADE_SKIP(Extensions::GL::EXT::geometry_shader::string() + std::string(" is not supported"));
+        #endif
+    }
+    #endif
+
+    TestFramebuffer framebuffer{fill.size};
+    GridMesh grid{1, FullScreen, false};
+
+    MeshVisualizer shader{data.flags};
+    shader.setColor(Color4{0.5f})
+        .setWireframeColor(Color4{1.0f});
+    if(data.flags & MeshVisualizer::Flag::Wireframe)
+        shader.setViewportSize(Vector2{Float(fill.size)});
+
+    CORRADE_BENCHMARK(BenchmarkRepeats)
+        for(std::size_t i = 0; i != Overdraw; ++i) grid.mesh.draw(shader);
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void ShadersGLBenchmark::meshVisualizerVertices() {
+    if(!Context::current().isExtensionSupported<TimerQuery>())
+        CORRADE_SKIP(TimerQuery::string() + std::string(" is not supported"));
+
+    const auto& data = MeshVisualizerData[testCaseInstanceId()/Containers::arraySize(VertexData)];
+    const auto& vertex = VertexData[testCaseInstanceId()%Containers::arraySize(VertexData)];
+    setTestCaseDescription(std::string{vertex.name} + (*data.name ? ", " : "") + data.name);
+
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    if((data.flags & MeshVisualizer::Flag::Wireframe) && !(data.flags & MeshVisualizer::Flag::NoGeometryShader)) {
+        #ifndef MAGNUM_TARGET_GLES
+        if(!Context::current().isExtensionSupported<Extensions::GL::ARB::geometry_shader4>())
+            CORRADE_SKIP(Extensions::GL::ARB::geometry_shader4::string() + std::string(" is not supported"));
+        #else
+        if(!Context::current().isExtensionSupported<Extensions::GL::EXT::geometry_shader>())
+            CORRADE_SKIP(Extensions::GL::EXT::geometry_shader::string() + std::string(" is not supported"));
+        #endif
+    }
+    #endif
+
+    TestFramebuffer framebuffer{VertexFramebufferSize};
+    GridMesh grid{vertex.cells, SinglePixel, false};
+
+    MeshVisualizer shader{data.flags};
+    shader.setColor(Color4{0.5f})
+        .setWireframeColor(Color4{1.0f});
+    if(data.flags & MeshVisualizer::Flag::Wireframe)
+        shader.setViewportSize(Vector2{Float(VertexFramebufferSize)});
+
+    CORRADE_BENCHMARK(BenchmarkRepeats)
+        grid.mesh.draw(shader);
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void ShadersGLBenchmark::vectorFill() {
+    if(!Context::current().isExtensionSupported<TimerQuery>())
+        CORRADE_SKIP(TimerQuery::string() + std::string(" is not supported"));
+
+    const auto& fill = FillData[testCaseInstanceId()];
+    setTestCaseDescription(fill.name);
+
+    TestFramebuffer framebuffer{fill.size};
+    GridMesh grid{1, FullScreen, true};
+    Texture2D texture = testTexture();
+
+    Vector2D shader;
+    shader.setColor(Color4{1.0f})
+        .setBackgroundColor(Color4{0.0f, 0.0f, 0.0f, 0.5f})
+        .bindVectorTexture(texture);
+
+    CORRADE_BENCHMARK(BenchmarkRepeats)
+        for(std::size_t i = 0; i != Overdraw; ++i) grid.mesh.draw(shader);
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void ShadersGLBenchmark::vectorVertices() {
+    if(!Context::current().isExtensionSupported<TimerQuery>())
+        CORRADE_SKIP(TimerQuery::string() + std::string(" is not supported"));
+
+    const auto& vertex = VertexData[testCaseInstanceId()];
+    setTestCaseDescription(vertex.name);
+
+    TestFramebuffer framebuffer{VertexFramebufferSize};
+    GridMesh grid{vertex.cells, SinglePixel, true};
+    Texture2D texture = testTexture();
+
+    Vector2D shader;
+    shader.bindVectorTexture(texture);
+
+    CORRADE_BENCHMARK(BenchmarkRepeats)
+        grid.mesh.draw(shader);
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void ShadersGLBenchmark::distanceFieldVectorFill() {
+    if(!Context::current().isExtensionSupported<TimerQuery>())
+        CORRADE_SKIP(TimerQuery::string() + std::string(" is not supported"));
+
+    const auto& data = DistanceFieldVectorData[testCaseInstanceId()/Containers::arraySize(FillData)];
+    const auto& fill = FillData[testCaseInstanceId()%Containers::arraySize(FillData)];
+    setTestCaseDescription(std::string{fill.name} + (*data.name ? ", " : "") + data.name);
+
+    TestFramebuffer framebuffer{fill.size};
+    GridMesh grid{1, FullScreen, true};
+    Texture2D texture = testTexture();
+
+    DistanceFieldVector2D shader{data.flags};
+    shader.setColor(Color4{1.0f})
+        .setOutlineColor(Color4{0.0f, 0.0f, 0.0f, 1.0f})
+        .setOutlineRange(0.5f, 0.3f)
+        .setSmoothness(0.05f)
+        .bindVectorTexture(texture);
+
+    CORRADE_BENCHMARK(BenchmarkRepeats)
+        for(std::size_t i = 0; i != Overdraw; ++i) grid.mesh.draw(shader);
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void ShadersGLBenchmark::distanceFieldVectorVertices() {
+    if(!Context::current().isExtensionSupported<TimerQuery>())
+        CORRADE_SKIP(TimerQuery::string() + std::string(" is not supported"));
+
+    const auto& data = DistanceFieldVectorData[testCaseInstanceId()/Containers::arraySize(VertexData)];
+    const auto& vertex = VertexData[testCaseInstanceId()%Containers::arraySize(VertexData)];
+    setTestCaseDescription(std::string{vertex.name} + (*data.name ? ", " : "") + data.name);
+
+    TestFramebuffer framebuffer{VertexFramebufferSize};
+    GridMesh grid{vertex.cells, SinglePixel, true};
+    Texture2D texture = testTexture();
+
+    DistanceFieldVector2D shader{data.flags};
+    shader.bindVectorTexture(texture);
+
+    CORRADE_BENCHMARK(BenchmarkRepeats)
+        grid.mesh.draw(shader);
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Shaders::Test::ShadersGLBenchmark)
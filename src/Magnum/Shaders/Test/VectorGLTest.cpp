@@ -23,7 +23,9 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include "Magnum/Context.h"
 #include "Magnum/OpenGLTester.h"
+#include "Magnum/Version.h"
 #include "Magnum/Shaders/Vector.h"
 
 namespace Magnum { namespace Shaders { namespace Test {
@@ -33,11 +35,20 @@ struct VectorGLTest: OpenGLTester {
 
     void compile2D();
     void compile3D();
+    #ifndef MAGNUM_TARGET_GLES2
+    void compileInstancedGlyphs2D();
+    void compileInstancedGlyphs3D();
+    #endif
 };
 
 VectorGLTest::VectorGLTest() {
     addTests({&VectorGLTest::compile2D,
-              &VectorGLTest::compile3D});
+              &VectorGLTest::compile3D,
+              #ifndef MAGNUM_TARGET_GLES2
+              &VectorGLTest::compileInstancedGlyphs2D,
+              &VectorGLTest::compileInstancedGlyphs3D
+              #endif
+              });
 }
 
 void VectorGLTest::compile2D() {
@@ -60,6 +71,40 @@ void VectorGLTest::compile3D() {
     }
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+void VectorGLTest::compileInstancedGlyphs2D() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isVersionSupported(Version::GL300))
+        CORRADE_SKIP("OpenGL 3.0 is not supported");
+    #endif
+
+    Shaders::Vector2D shader{Shaders::Vector2D::Flag::InstancedGlyphs};
+    CORRADE_VERIFY(shader.flags() == Shaders::Vector2D::Flag::InstancedGlyphs);
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+
+void VectorGLTest::compileInstancedGlyphs3D() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isVersionSupported(Version::GL300))
+        CORRADE_SKIP("OpenGL 3.0 is not supported");
+    #endif
+
+    Shaders::Vector3D shader{Shaders::Vector3D::Flag::InstancedGlyphs};
+    CORRADE_VERIFY(shader.flags() == Shaders::Vector3D::Flag::InstancedGlyphs);
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+#endif
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Shaders::Test::VectorGLTest)
@@ -23,7 +23,10 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
 #include "Magnum/OpenGLTester.h"
+#include "Magnum/Shader.h"
 #include "Magnum/Shaders/VertexColor.h"
 
 namespace Magnum { namespace Shaders { namespace Test {
@@ -33,11 +36,22 @@ struct VertexColorGLTest: OpenGLTester {
 
     void compile2D();
     void compile3D();
+
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    void compile2DShaderStorageBuffers();
+    void compile3DShaderStorageBuffers();
+    #endif
 };
 
 VertexColorGLTest::VertexColorGLTest() {
     addTests({&VertexColorGLTest::compile2D,
-              &VertexColorGLTest::compile3D});
+              &VertexColorGLTest::compile3D,
+
+              #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+              &VertexColorGLTest::compile2DShaderStorageBuffers,
+              &VertexColorGLTest::compile3DShaderStorageBuffers
+              #endif
+              });
 }
 
 void VertexColorGLTest::compile2D() {
@@ -60,6 +74,42 @@ void VertexColorGLTest::compile3D() {
     }
 }
 
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+void VertexColorGLTest::compile2DShaderStorageBuffers() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::shader_storage_buffer_object>())
+        CORRADE_SKIP(Extensions::GL::ARB::shader_storage_buffer_object::string() + std::string(" is not supported"));
+    #endif
+    if(Shader::maxShaderStorageBlocks(Shader::Type::Vertex) < 1)
+        CORRADE_SKIP("Shader storage buffers are not supported in vertex shaders");
+
+    Shaders::VertexColor2D shader{Shaders::VertexColor2D::Flag::ShaderStorageBuffers};
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+
+void VertexColorGLTest::compile3DShaderStorageBuffers() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::shader_storage_buffer_object>())
+        CORRADE_SKIP(Extensions::GL::ARB::shader_storage_buffer_object::string() + std::string(" is not supported"));
+    #endif
+    if(Shader::maxShaderStorageBlocks(Shader::Type::Vertex) < 1)
+        CORRADE_SKIP("Shader storage buffers are not supported in vertex shaders");
+
+    Shaders::VertexColor3D shader{Shaders::VertexColor3D::Flag::ShaderStorageBuffers};
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+#endif
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Shaders::Test::VertexColorGLTest)
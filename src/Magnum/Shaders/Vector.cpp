@@ -41,7 +41,7 @@ namespace {
     template<> constexpr const char* vertexShaderName<3>() { return "AbstractVector3D.vert"; }
 }
 
-template<UnsignedInt dimensions> Vector<dimensions>::Vector() {
+template<UnsignedInt dimensions> Vector<dimensions>::Vector(const Flags flags): _flags{flags} {
     #ifdef MAGNUM_BUILD_STATIC
     /* Import resources on static build, if not already */
     if(!Utility::Resource::hasGroup("MagnumShaders"))
@@ -50,7 +50,13 @@ template<UnsignedInt dimensions> Vector<dimensions>::Vector() {
     Utility::Resource rs("MagnumShaders");
 
     #ifndef MAGNUM_TARGET_GLES
-    const Version version = Context::current().supportedVersion({Version::GL320, Version::GL310, Version::GL300, Version::GL210});
+    /* gl_VertexID used by instanced glyphs needs GLSL 1.30 */
+    const Version version = flags & Flag::InstancedGlyphs ?
+        Context::current().supportedVersion({Version::GL320, Version::GL310, Version::GL300}) :
+        Context::current().supportedVersion({Version::GL320, Version::GL310, Version::GL300, Version::GL210});
+    #elif !defined(MAGNUM_TARGET_GLES2)
+    const Version version = flags & Flag::InstancedGlyphs ? Version::GLES300 :
+        Context::current().supportedVersion({Version::GLES300, Version::GLES200});
     #else
     const Version version = Context::current().supportedVersion({Version::GLES300, Version::GLES200});
     #endif
@@ -58,6 +64,9 @@ template<UnsignedInt dimensions> Vector<dimensions>::Vector() {
     Shader vert = Implementation::createCompatibilityShader(rs, version, Shader::Type::Vertex);
     Shader frag = Implementation::createCompatibilityShader(rs, version, Shader::Type::Fragment);
 
+    #ifndef MAGNUM_TARGET_GLES2
+    vert.addSource(flags & Flag::InstancedGlyphs ? "#define INSTANCED_GLYPHS\n" : "");
+    #endif
     vert.addSource(rs.get("generic.glsl"))
         .addSource(rs.get(vertexShaderName<dimensions>()));
     frag.addSource(rs.get("Vector.frag"));
@@ -72,8 +81,16 @@ template<UnsignedInt dimensions> Vector<dimensions>::Vector() {
     if(!Context::current().isVersionSupported(Version::GLES300))
     #endif
     {
-        AbstractShaderProgram::bindAttributeLocation(AbstractVector<dimensions>::Position::Location, "position");
-        AbstractShaderProgram::bindAttributeLocation(AbstractVector<dimensions>::TextureCoordinates::Location, "textureCoordinates");
+        #ifndef MAGNUM_TARGET_GLES2
+        if(flags & Flag::InstancedGlyphs) {
+            AbstractShaderProgram::bindAttributeLocation(AbstractVector<dimensions>::GlyphRectangle::Location, "glyphRectangle");
+            AbstractShaderProgram::bindAttributeLocation(AbstractVector<dimensions>::GlyphTextureRectangle::Location, "glyphTextureRectangle");
+        } else
+        #endif
+        {
+            AbstractShaderProgram::bindAttributeLocation(AbstractVector<dimensions>::Position::Location, "position");
+            AbstractShaderProgram::bindAttributeLocation(AbstractVector<dimensions>::TextureCoordinates::Location, "textureCoordinates");
+        }
     }
 
     CORRADE_INTERNAL_ASSERT_OUTPUT(AbstractShaderProgram::link());
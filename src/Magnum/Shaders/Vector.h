@@ -29,6 +29,8 @@
  * @brief Class @ref Magnum::Shaders::Vector, typedef @ref Magnum::Shaders::Vector2D, @ref Magnum::Shaders::Vector3D
  */
 
+#include <Corrade/Containers/EnumSet.h>
+
 #include "Magnum/DimensionTraits.h"
 #include "Magnum/Math/Color.h"
 #include "Magnum/Math/Matrix3.h"
@@ -38,6 +40,15 @@
 
 namespace Magnum { namespace Shaders {
 
+namespace Implementation {
+    enum class VectorFlag: UnsignedByte {
+        #ifndef MAGNUM_TARGET_GLES2
+        InstancedGlyphs = 1 << 0
+        #endif
+    };
+    typedef Containers::EnumSet<VectorFlag> VectorFlags;
+}
+
 /**
 @brief Vector shader
 
@@ -61,11 +72,55 @@ Common rendering setup:
 
 @snippet MagnumShaders.cpp Vector-usage2
 
+@section Shaders-Vector-instanced-glyphs Instanced glyphs
+
+With @ref Flag::InstancedGlyphs the shader expects one compact
+@ref GlyphRectangle and @ref GlyphTextureRectangle record per glyph instead of
+four vertices and six indices and expands it to a quad using
+@glsl gl_VertexID @ce. Such meshes are produced by
+@ref Text::Renderer::renderInstanced() and @ref Text::InstancedRenderer, see
+@ref Text-Renderer-instanced for more information.
+
 @see @ref shaders, @ref Vector2D, @ref Vector3D
 */
 template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Vector: public AbstractVector<dimensions> {
     public:
-        explicit Vector();
+        #ifdef DOXYGEN_GENERATING_OUTPUT
+        /**
+         * @brief Flag
+         *
+         * @see @ref Flags, @ref flags()
+         */
+        enum class Flag: UnsignedByte {
+            /**
+             * Take glyph quads from per-instance @ref GlyphRectangle and
+             * @ref GlyphTextureRectangle attributes instead of per-vertex
+             * @ref Position and @ref TextureCoordinates. See
+             * @ref Shaders-Vector-instanced-glyphs for more information.
+             * @requires_gl33 Extension @extension{ARB,instanced_arrays} and
+             *      GLSL 1.30
+             * @requires_gles30 Not available in OpenGL ES 2.0.
+             * @requires_webgl20 Not available in WebGL 1.0.
+             */
+            InstancedGlyphs = 1 << 0
+        };
+
+        /**
+         * @brief Flags
+         *
+         * @see @ref flags()
+         */
+        typedef Containers::EnumSet<Flag> Flags;
+        #else
+        typedef Implementation::VectorFlag Flag;
+        typedef Implementation::VectorFlags Flags;
+        #endif
+
+        /**
+         * @brief Constructor
+         * @param flags     Flags
+         */
+        explicit Vector(Flags flags = {});
 
         /**
          * @brief Construct without creating the underlying OpenGL object
@@ -84,6 +139,9 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Vector: public Abst
             #endif
             {}
 
+        /** @brief Flags */
+        Flags flags() const { return _flags; }
+
         /**
          * @brief Set transformation and projection matrix
          * @return Reference to self (for method chaining)
@@ -130,6 +188,7 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Vector: public Abst
         #endif
 
     private:
+        Flags _flags;
         Int _transformationProjectionMatrixUniform{0},
             _backgroundColorUniform{1},
             _colorUniform{2};
@@ -141,6 +200,8 @@ typedef Vector<2> Vector2D;
 /** @brief Three-dimensional vector shader */
 typedef Vector<3> Vector3D;
 
+CORRADE_ENUMSET_OPERATORS(Implementation::VectorFlags)
+
 }}
 
 #endif
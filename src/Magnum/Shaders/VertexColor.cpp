@@ -27,6 +27,7 @@
 
 #include <Corrade/Utility/Resource.h>
 
+#include "Magnum/Buffer.h"
 #include "Magnum/Context.h"
 #include "Magnum/Extensions.h"
 #include "Magnum/Shader.h"
@@ -41,7 +42,7 @@ namespace {
     template<> constexpr const char* vertexShaderName<3>() { return "VertexColor3D.vert"; }
 }
 
-template<UnsignedInt dimensions> VertexColor<dimensions>::VertexColor() {
+template<UnsignedInt dimensions> VertexColor<dimensions>::VertexColor(const Flags flags): _flags{flags} {
     #ifdef MAGNUM_BUILD_STATIC
     /* Import resources on static build, if not already */
     if(!Utility::Resource::hasGroup("MagnumShaders"))
@@ -50,7 +51,12 @@ template<UnsignedInt dimensions> VertexColor<dimensions>::VertexColor() {
     Utility::Resource rs("MagnumShaders");
 
     #ifndef MAGNUM_TARGET_GLES
-    const Version version = Context::current().supportedVersion({Version::GL320, Version::GL310, Version::GL300, Version::GL210});
+    /* Shader storage blocks need GLSL 4.30 */
+    const Version version = flags & Flag::ShaderStorageBuffers ? Version::GL430 :
+        Context::current().supportedVersion({Version::GL320, Version::GL310, Version::GL300, Version::GL210});
+    #elif !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    const Version version = flags & Flag::ShaderStorageBuffers ? Version::GLES310 :
+        Context::current().supportedVersion({Version::GLES300, Version::GLES200});
     #else
     const Version version = Context::current().supportedVersion({Version::GLES300, Version::GLES200});
     #endif
@@ -58,6 +64,10 @@ template<UnsignedInt dimensions> VertexColor<dimensions>::VertexColor() {
     Shader vert = Implementation::createCompatibilityShader(rs, version, Shader::Type::Vertex);
     Shader frag = Implementation::createCompatibilityShader(rs, version, Shader::Type::Fragment);
 
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    if(flags & Flag::ShaderStorageBuffers)
+        vert.addSource("#define SHADER_STORAGE_BUFFERS\n");
+    #endif
     vert.addSource(rs.get("generic.glsl"))
         .addSource(rs.get(vertexShaderName<dimensions>()));
     frag.addSource(rs.get("VertexColor.frag"));
@@ -82,14 +92,49 @@ template<UnsignedInt dimensions> VertexColor<dimensions>::VertexColor() {
     if(!Context::current().isExtensionSupported<Extensions::GL::ARB::explicit_uniform_location>(version))
     #endif
     {
-        _transformationProjectionMatrixUniform = uniformLocation("transformationProjectionMatrix");
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        if(flags & Flag::ShaderStorageBuffers)
+            _drawOffsetUniform = uniformLocation("drawOffset");
+        else
+        #endif
+        {
+            _transformationProjectionMatrixUniform = uniformLocation("transformationProjectionMatrix");
+        }
     }
 
     /* Set defaults in OpenGL ES (for desktop they are set in shader code itself) */
     #ifdef MAGNUM_TARGET_GLES
-    setTransformationProjectionMatrix(MatrixTypeFor<dimensions, Float>{});
+    #ifndef MAGNUM_TARGET_WEBGL
+    if(!(flags & Flag::ShaderStorageBuffers))
     #endif
+    {
+        setTransformationProjectionMatrix(MatrixTypeFor<dimensions, Float>{});
+    }
+    #endif
+}
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+template<UnsignedInt dimensions> VertexColor<dimensions>& VertexColor<dimensions>::setDrawOffset(const UnsignedInt offset) {
+    CORRADE_ASSERT(_flags & Flag::ShaderStorageBuffers,
+        "Shaders::VertexColor::setDrawOffset(): the shader was not created with shader storage buffers enabled", *this);
+    setUniform(_drawOffsetUniform, offset);
+    return *this;
+}
+
+template<UnsignedInt dimensions> VertexColor<dimensions>& VertexColor<dimensions>::bindDrawStorageBuffer(Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags & Flag::ShaderStorageBuffers,
+        "Shaders::VertexColor::bindDrawStorageBuffer(): the shader was not created with shader storage buffers enabled", *this);
+    buffer.bind(Buffer::Target::ShaderStorage, DrawStorageBufferBinding, offset, size);
+    return *this;
+}
+
+template<UnsignedInt dimensions> VertexColor<dimensions>& VertexColor<dimensions>::bindDrawStorageBuffer(Buffer& buffer) {
+    CORRADE_ASSERT(_flags & Flag::ShaderStorageBuffers,
+        "Shaders::VertexColor::bindDrawStorageBuffer(): the shader was not created with shader storage buffers enabled", *this);
+    buffer.bind(Buffer::Target::ShaderStorage, DrawStorageBufferBinding);
+    return *this;
 }
+#endif
 
 template class VertexColor<2>;
 template class VertexColor<3>;
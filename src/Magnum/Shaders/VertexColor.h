@@ -29,16 +29,33 @@
  * @brief Class @ref Magnum::Shaders::VertexColor
  */
 
+#include <Corrade/Containers/EnumSet.h>
+#include <Corrade/Utility/Assert.h>
+
 #include "Magnum/AbstractShaderProgram.h"
 #include "Magnum/DimensionTraits.h"
 #include "Magnum/Math/Color.h"
 #include "Magnum/Math/Matrix3.h"
 #include "Magnum/Math/Matrix4.h"
+#include "Magnum/Std140.h"
 #include "Magnum/Shaders/Generic.h"
 #include "Magnum/Shaders/visibility.h"
 
 namespace Magnum { namespace Shaders {
 
+namespace Implementation {
+    enum class VertexColorFlag: UnsignedByte {
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        ShaderStorageBuffers = 1 << 0
+        #endif
+    };
+    typedef Containers::EnumSet<VertexColorFlag> VertexColorFlags;
+
+    template<UnsignedInt> struct VertexColorDrawUniform;
+    template<> struct VertexColorDrawUniform<2> { typedef Std140::Matrix3 Type; };
+    template<> struct VertexColorDrawUniform<3> { typedef Matrix4 Type; };
+}
+
 /**
 @brief Vertex color shader
 
@@ -61,6 +78,16 @@ Common rendering setup:
 
 @snippet MagnumShaders.cpp VertexColor-usage2
 
+@section Shaders-VertexColor-shader-storage-buffers Shader storage buffers
+
+With @ref Flag::ShaderStorageBuffers the transformation and projection
+matrices of all draws are read from the @glsl VertexColorDraws @ce shader
+storage buffer, which is a tightly packed array of @ref DrawUniform ---
+@ref Std140::Matrix3 in 2D and @ref Magnum::Matrix4 "Matrix4" in 3D. Each draw
+selects its matrix with @ref setDrawOffset(), each instance of an instanced
+draw reads the matrix following the previous one. See
+@ref Shaders-Flat-shader-storage-buffers for a complete example.
+
 @see @ref shaders, @ref VertexColor2D, @ref VertexColor3D
 */
 template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT VertexColor: public AbstractShaderProgram {
@@ -82,7 +109,67 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT VertexColor: public
          */
         typedef typename Generic<dimensions>::Color Color;
 
-        explicit VertexColor();
+        #ifdef DOXYGEN_GENERATING_OUTPUT
+        /**
+         * @brief Flag
+         *
+         * @see @ref Flags, @ref flags()
+         */
+        enum class Flag: UnsignedByte {
+            /**
+             * Take the transformation and projection matrix from the
+             * @glsl VertexColorDraws @ce shader storage buffer instead of a
+             * uniform. See @ref Shaders-VertexColor-shader-storage-buffers
+             * for more information.
+             * @requires_gl43 Extension @extension{ARB,shader_storage_buffer_object}
+             * @requires_gles31 Shader storage buffers are not available in
+             *      OpenGL ES 3.0 and older.
+             * @requires_gles Shader storage buffers are not available in
+             *      WebGL.
+             */
+            ShaderStorageBuffers = 1 << 0
+        };
+
+        /**
+         * @brief Flags
+         *
+         * @see @ref flags()
+         */
+        typedef Containers::EnumSet<Flag> Flags;
+        #else
+        typedef Implementation::VertexColorFlag Flag;
+        typedef Implementation::VertexColorFlags Flags;
+        #endif
+
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        /**
+         * @brief Per-draw shader storage buffer item
+         *
+         * @ref Std140::Matrix3 in 2D, @ref Magnum::Matrix4 "Matrix4" in 3D.
+         * Used if @ref Flag::ShaderStorageBuffers is set.
+         */
+        #ifdef DOXYGEN_GENERATING_OUTPUT
+        typedef T DrawUniform;
+        #else
+        typedef typename Implementation::VertexColorDrawUniform<dimensions>::Type DrawUniform;
+        #endif
+
+        enum: UnsignedInt {
+            /**
+             * Shader storage buffer binding for the
+             * @glsl VertexColorDraws @ce block. Used if
+             * @ref Flag::ShaderStorageBuffers is set.
+             * @see @ref bindDrawStorageBuffer()
+             */
+            DrawStorageBufferBinding = 0
+        };
+        #endif
+
+        /**
+         * @brief Constructor
+         * @param flags     Flags
+         */
+        explicit VertexColor(Flags flags = {});
 
         /**
          * @brief Construct without creating the underlying OpenGL object
@@ -96,19 +183,83 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT VertexColor: public
          */
         explicit VertexColor(NoCreateT) noexcept: AbstractShaderProgram{NoCreate} {}
 
+        /** @brief Flags */
+        Flags flags() const { return _flags; }
+
         /**
          * @brief Set transformation and projection matrix
          * @return Reference to self (for method chaining)
          *
-         * Default is identity matrix.
+         * Default is identity matrix. Expects that
+         * @ref Flag::ShaderStorageBuffers is not set.
          */
         VertexColor<dimensions>& setTransformationProjectionMatrix(const MatrixTypeFor<dimensions, Float>& matrix) {
+            #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+            CORRADE_ASSERT(!(_flags & Flag::ShaderStorageBuffers),
+                "Shaders::VertexColor::setTransformationProjectionMatrix(): the shader was created with shader storage buffers enabled", *this);
+            #endif
             setUniform(_transformationProjectionMatrixUniform, matrix);
             return *this;
         }
 
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        /**
+         * @brief Set draw offset
+         * @return Reference to self (for method chaining)
+         *
+         * Index of the @ref DrawUniform in the buffer bound with
+         * @ref bindDrawStorageBuffer() used by the first instance of the
+         * draw, each following instance uses the next item. Expects that
+         * @ref Flag::ShaderStorageBuffers is set. Initial value is
+         * @cpp 0 @ce.
+         * @requires_gl43 Extension @extension{ARB,shader_storage_buffer_object}
+         * @requires_gles31 Shader storage buffers are not available in
+         *      OpenGL ES 3.0 and older.
+         * @requires_gles Shader storage buffers are not available in WebGL.
+         */
+        VertexColor<dimensions>& setDrawOffset(UnsignedInt offset);
+
+        /**
+         * @brief Bind a per-draw shader storage buffer range
+         * @param buffer    Buffer containing tightly packed @ref DrawUniform
+         *      items
+         * @param offset    Offset of the first item in @p buffer
+         * @param size      Size of the range
+         * @return Reference to self (for method chaining)
+         *
+         * Equivalent to calling @ref Buffer::bind(Buffer::Target, UnsignedInt, GLintptr, GLsizeiptr)
+         * with @ref Buffer::Target::ShaderStorage and
+         * @ref DrawStorageBufferBinding. Expects that
+         * @ref Flag::ShaderStorageBuffers is set. The @p offset is expected
+         * to be a multiple of @ref Buffer::shaderStorageOffsetAlignment().
+         * @requires_gl43 Extension @extension{ARB,shader_storage_buffer_object}
+         * @requires_gles31 Shader storage buffers are not available in
+         *      OpenGL ES 3.0 and older.
+         * @requires_gles Shader storage buffers are not available in WebGL.
+         */
+        VertexColor<dimensions>& bindDrawStorageBuffer(Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Bind a per-draw shader storage buffer
+         * @return Reference to self (for method chaining)
+         *
+         * Binds the whole @p buffer, which is expected to contain tightly
+         * packed @ref DrawUniform items. Expects that
+         * @ref Flag::ShaderStorageBuffers is set.
+         * @requires_gl43 Extension @extension{ARB,shader_storage_buffer_object}
+         * @requires_gles31 Shader storage buffers are not available in
+         *      OpenGL ES 3.0 and older.
+         * @requires_gles Shader storage buffers are not available in WebGL.
+         */
+        VertexColor<dimensions>& bindDrawStorageBuffer(Buffer& buffer);
+        #endif
+
     private:
+        Flags _flags;
         Int _transformationProjectionMatrixUniform{0};
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        Int _drawOffsetUniform{1};
+        #endif
 };
 
 /** @brief 2D vertex color shader */
@@ -117,6 +268,8 @@ typedef VertexColor<2> VertexColor2D;
 /** @brief 3D vertex color shader */
 typedef VertexColor<3> VertexColor3D;
 
+CORRADE_ENUMSET_OPERATORS(Implementation::VertexColorFlags)
+
 }}
 
 #endif
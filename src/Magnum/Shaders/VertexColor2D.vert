@@ -28,6 +28,7 @@
 #define out varying
 #endif
 
+#ifndef SHADER_STORAGE_BUFFERS
 #ifdef EXPLICIT_UNIFORM_LOCATION
 layout(location = 0)
 #endif
@@ -36,6 +37,16 @@ uniform highp mat3 transformationProjectionMatrix
     = mat3(1.0)
     #endif
     ;
+#else
+layout(std430, binding = 0) readonly buffer VertexColorDraws {
+    highp mat3 transformationProjectionMatrices[];
+};
+
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 1)
+#endif
+uniform highp uint drawOffset;
+#endif
 
 #ifdef EXPLICIT_ATTRIB_LOCATION
 layout(location = POSITION_ATTRIBUTE_LOCATION)
@@ -50,6 +61,11 @@ in lowp vec4 color;
 out lowp vec4 interpolatedColor;
 
 void main() {
+    #ifdef SHADER_STORAGE_BUFFERS
+    /* Each instance reads its own draw data */
+    highp mat3 transformationProjectionMatrix = transformationProjectionMatrices[drawOffset + uint(gl_InstanceID)];
+    #endif
+
     gl_Position.xywz = vec4(transformationProjectionMatrix*vec3(position, 1.0), 0.0);
     interpolatedColor = color;
 }
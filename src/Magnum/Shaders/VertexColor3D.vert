@@ -28,7 +28,16 @@
 #define out varying
 #endif
 
-#ifndef GL_ES
+#ifdef SHADER_STORAGE_BUFFERS
+layout(std430, binding = 0) readonly buffer VertexColorDraws {
+    highp mat4 transformationProjectionMatrices[];
+};
+
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 1)
+#endif
+uniform highp uint drawOffset;
+#elif !defined(GL_ES)
 #ifdef EXPLICIT_UNIFORM_LOCATION
 layout(location = 0) uniform mat4 transformationProjectionMatrix = mat4(1.0);
 #else
@@ -49,6 +58,11 @@ in lowp vec4 color;
 out lowp vec4 interpolatedColor;
 
 void main() {
+    #ifdef SHADER_STORAGE_BUFFERS
+    /* Each instance reads its own draw data */
+    highp mat4 transformationProjectionMatrix = transformationProjectionMatrices[drawOffset + uint(gl_InstanceID)];
+    #endif
+
     gl_Position = transformationProjectionMatrix*position;
     interpolatedColor = color;
 }
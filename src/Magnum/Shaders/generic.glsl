@@ -26,3 +26,7 @@
 #define POSITION_ATTRIBUTE_LOCATION 0
 #define TEXTURECOORDINATES_ATTRIBUTE_LOCATION 1
 #define NORMAL_ATTRIBUTE_LOCATION 2
+#define COLOR_ATTRIBUTE_LOCATION 3
+#define TRANSFORMATION_MATRIX_ATTRIBUTE_LOCATION 8
+#define JOINT_IDS_ATTRIBUTE_LOCATION 6
+#define WEIGHTS_ATTRIBUTE_LOCATION 7
@@ -33,8 +33,17 @@
 
 namespace Magnum { namespace Shapes {
 
-template<UnsignedInt dimensions> AbstractShape<dimensions>::AbstractShape(SceneGraph::AbstractObject<dimensions, Float>& object, ShapeGroup<dimensions>* group): SceneGraph::AbstractGroupedFeature<dimensions, AbstractShape<dimensions>, Float>(object, group) {
-    SceneGraph::AbstractFeature<dimensions, Float>::setCachedTransformations(SceneGraph::CachedTransformation::Absolute);
+template<UnsignedInt dimensions> AbstractShape<dimensions>::AbstractShape(SceneGraph::AbstractObject<dimensions, Float>& object, ShapeGroup<dimensions>* group): SceneGraph::AbstractGroupedFeature<dimensions, AbstractShape<dimensions>, Float>(object, group), _index{}, _moved{} {
+    SceneGraph::AbstractFeature<dimensions, Float>::setCachedTransformations(SceneGraph::CachedTransformation::Absolute|SceneGraph::CachedTransformation::AbsoluteTranslation);
+
+    /* Adding the shape changes the broad phase */
+    if(group) group->setDirty();
+}
+
+template<UnsignedInt dimensions> AbstractShape<dimensions>::~AbstractShape() {
+    /* Removing the shape changes the broad phase and the group might still
+       have it in the list of moved shapes */
+    if(group()) group()->setDirty();
 }
 
 template<UnsignedInt dimensions> ShapeGroup<dimensions>* AbstractShape<dimensions>::group() {
@@ -58,7 +67,7 @@ template<UnsignedInt dimensions> Collision<dimensions> AbstractShape<dimensions>
 }
 
 template<UnsignedInt dimensions> void AbstractShape<dimensions>::markDirty() {
-    if(group()) group()->setDirty();
+    if(group()) group()->markMoved(*this);
 }
 
 #ifndef DOXYGEN_GENERATING_OUTPUT
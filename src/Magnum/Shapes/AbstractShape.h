@@ -57,6 +57,7 @@ template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT AbstractShape: publi
     /* Otherwise it complains that this is not a function */
     template<UnsignedInt dimensions_> friend const Implementation::AbstractShape<dimensions_>& Implementation::getAbstractShape(const Shapes::AbstractShape<dimensions_>&);
     #endif
+    friend ShapeGroup<dimensions>;
 
     public:
         enum: UnsignedInt {
@@ -87,6 +88,13 @@ template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT AbstractShape: publi
          */
         explicit AbstractShape(SceneGraph::AbstractObject<dimensions, Float>& object, ShapeGroup<dimensions>* group = nullptr);
 
+        /**
+         * @brief Destructor
+         *
+         * Marks the group as dirty.
+         */
+        ~AbstractShape();
+
         /**
          * @brief Shape group containing this shape
          *
@@ -108,6 +116,9 @@ template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT AbstractShape: publi
         /**
          * @brief Collision with other shape
          *
+         * Returns contact position, separation normal and separation distance
+         * for every pair of shapes for which @ref collides() is implemented,
+         * so there's no need to test for collision occurence separately.
          * Default implementation returns empty collision.
          */
         Collision<dimensions> collision(const AbstractShape<dimensions>& other) const;
@@ -118,6 +129,10 @@ template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT AbstractShape: publi
 
     private:
         virtual const Implementation::AbstractShape<dimensions> MAGNUM_SHAPES_LOCAL & abstractTransformedShape() const = 0;
+
+        /* Used by ShapeGroup to track moved shapes */
+        UnsignedInt _index;
+        bool _moved;
 };
 
 /** @brief Base class for two-dimensional object shapes */
@@ -25,6 +25,8 @@
 
 #include "AxisAlignedBox.h"
 
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/Functions.h"
 #include "Magnum/Math/Matrix3.h"
 #include "Magnum/Math/Matrix4.h"
 #include "Magnum/Shapes/Point.h"
@@ -41,6 +43,29 @@ template<UnsignedInt dimensions> bool AxisAlignedBox<dimensions>::operator%(cons
            (other.position() < _max).all();
 }
 
+template<UnsignedInt dimensions> Collision<dimensions> AxisAlignedBox<dimensions>::operator/(const Point<dimensions>& other) const {
+    /* No collision occured */
+    if(!(*this % other)) return {};
+
+    /* Find the face nearest to the point, the box needs to be moved so the
+       face gets past the point */
+    const VectorTypeFor<dimensions, Float> toMin = other.position() - _min;
+    const VectorTypeFor<dimensions, Float> toMax = _max - other.position();
+    VectorTypeFor<dimensions, Float> separatingNormal;
+    Float distance = Math::Constants<Float>::inf();
+    for(std::size_t i = 0; i != dimensions; ++i) {
+        const Float face = Math::min(toMin[i], toMax[i]);
+        if(face >= distance) continue;
+
+        distance = face;
+        separatingNormal = {};
+        separatingNormal[i] = toMin[i] < toMax[i] ? 1.0f : -1.0f;
+    }
+
+    /* Collision position is on the point */
+    return Collision<dimensions>(other.position(), separatingNormal, distance);
+}
+
 #ifndef DOXYGEN_GENERATING_OUTPUT
 template class MAGNUM_SHAPES_EXPORT AxisAlignedBox<2>;
 template class MAGNUM_SHAPES_EXPORT AxisAlignedBox<3>;
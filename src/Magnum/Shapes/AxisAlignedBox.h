@@ -31,6 +31,7 @@
 
 #include "Magnum/DimensionTraits.h"
 #include "Magnum/Math/Vector3.h"
+#include "Magnum/Shapes/Collision.h"
 #include "Magnum/Shapes/Shapes.h"
 #include "Magnum/Shapes/visibility.h"
 
@@ -62,6 +63,16 @@ template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT AxisAlignedBox {
         /** @brief Transformed shape */
         AxisAlignedBox<dimensions> transformed(const MatrixTypeFor<dimensions, Float>& matrix) const;
 
+        /**
+         * @brief Translated shape
+         *
+         * Cheaper alternative to @ref transformed() for translation-only
+         * transformations.
+         */
+        AxisAlignedBox<dimensions> translated(const VectorTypeFor<dimensions, Float>& translation) const {
+            return AxisAlignedBox<dimensions>(_min + translation, _max + translation);
+        }
+
         /** @brief Minimal coordinates */
         constexpr VectorTypeFor<dimensions, Float> min() const {
             return _min;
@@ -85,6 +96,14 @@ template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT AxisAlignedBox {
         /** @brief Collision occurence with point */
         bool operator%(const Point<dimensions>& other) const;
 
+        /**
+         * @brief Collision with point
+         *
+         * Separation normal is perpendicular to the box face nearest to the
+         * point.
+         */
+        Collision<dimensions> operator/(const Point<dimensions>& other) const;
+
     private:
         VectorTypeFor<dimensions, Float> _min, _max;
 };
@@ -98,6 +117,9 @@ typedef AxisAlignedBox<3> AxisAlignedBox3D;
 /** @collisionoccurenceoperator{Point,AxisAlignedBox} */
 template<UnsignedInt dimensions> inline bool operator%(const Point<dimensions>& a, const AxisAlignedBox<dimensions>& b) { return b % a; }
 
+/** @collisionoperator{Point,AxisAlignedBox} */
+template<UnsignedInt dimensions> inline Collision<dimensions> operator/(const Point<dimensions>& a, const AxisAlignedBox<dimensions>& b) { return (b/a).flipped(); }
+
 }}
 
 #endif
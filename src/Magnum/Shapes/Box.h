@@ -64,6 +64,18 @@ template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT Box {
         /** @brief Transformed shape */
         Box<dimensions> transformed(const MatrixTypeFor<dimensions, Float>& matrix) const;
 
+        /**
+         * @brief Translated shape
+         *
+         * Cheaper alternative to @ref transformed() for translation-only
+         * transformations.
+         */
+        Box<dimensions> translated(const VectorTypeFor<dimensions, Float>& translation) const {
+            MatrixTypeFor<dimensions, Float> transformation = _transformation;
+            transformation.translation() += translation;
+            return Box<dimensions>(transformation);
+        }
+
         /** @brief Transformation */
         constexpr MatrixTypeFor<dimensions, Float> transformation() const {
             return _transformation;
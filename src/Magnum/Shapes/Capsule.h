@@ -31,6 +31,7 @@
 
 #include "Magnum/DimensionTraits.h"
 #include "Magnum/Math/Vector3.h"
+#include "Magnum/Shapes/Collision.h"
 #include "Magnum/Shapes/Shapes.h"
 #include "Magnum/Shapes/visibility.h"
 
@@ -64,6 +65,16 @@ template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT Capsule {
         /** @brief Transformed shape */
         Capsule<dimensions> transformed(const MatrixTypeFor<dimensions, Float>& matrix) const;
 
+        /**
+         * @brief Translated shape
+         *
+         * Cheaper alternative to @ref transformed() for translation-only
+         * transformations.
+         */
+        Capsule<dimensions> translated(const VectorTypeFor<dimensions, Float>& translation) const {
+            return Capsule<dimensions>(_a + translation, _b + translation, _radius);
+        }
+
         /** @brief Start point */
         constexpr VectorTypeFor<dimensions, Float> a() const {
             return _a;
@@ -93,9 +104,15 @@ template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT Capsule {
         /** @brief Collision occurence with point */
         bool operator%(const Point<dimensions>& other) const;
 
+        /** @brief Collision with point */
+        Collision<dimensions> operator/(const Point<dimensions>& other) const;
+
         /** @brief Collision occurence with sphere */
         bool operator%(const Sphere<dimensions>& other) const;
 
+        /** @brief Collision with sphere */
+        Collision<dimensions> operator/(const Sphere<dimensions>& other) const;
+
     private:
         VectorTypeFor<dimensions, Float> _a, _b;
         Float _radius;
@@ -110,9 +127,15 @@ typedef Capsule<3> Capsule3D;
 /** @collisionoccurenceoperator{Point,Capsule} */
 template<UnsignedInt dimensions> inline bool operator%(const Point<dimensions>& a, const Capsule<dimensions>& b) { return b % a; }
 
+/** @collisionoperator{Point,Capsule} */
+template<UnsignedInt dimensions> inline Collision<dimensions> operator/(const Point<dimensions>& a, const Capsule<dimensions>& b) { return (b/a).flipped(); }
+
 /** @collisionoccurenceoperator{Sphere,Capsule} */
 template<UnsignedInt dimensions> inline bool operator%(const Sphere<dimensions>& a, const Capsule<dimensions>& b) { return b % a; }
 
+/** @collisionoperator{Sphere,Capsule} */
+template<UnsignedInt dimensions> inline Collision<dimensions> operator/(const Sphere<dimensions>& a, const Capsule<dimensions>& b) { return (b/a).flipped(); }
+
 }}
 
 #endif
@@ -30,6 +30,7 @@
  */
 
 #include "Magnum/DimensionTraits.h"
+#include "Magnum/Math/Functions.h"
 #include "Magnum/Math/Vector2.h"
 #include "Magnum/Math/Vector3.h"
 
@@ -108,11 +109,13 @@ template<UnsignedInt dimensions> class Collision {
          *
          * Returns new collision object as if the collision occured between
          * flipped pair of objects, i.e. with flipped separation normal and
-         * contact position on surface of object A.
+         * contact position on surface of object A. If the separation
+         * distance is infinite (i.e., the objects can't be separated), the
+         * contact position is kept.
          * @see @ref position(), @ref separationNormal()
          */
         Collision<dimensions> flipped() const {
-            return Collision<dimensions>(_position - _separationDistance*_separationNormal, -_separationNormal, _separationDistance);
+            return Collision<dimensions>(Math::isInf(_separationDistance) ? _position : _position - _separationDistance*_separationNormal, -_separationNormal, _separationDistance);
         }
 
     private:
@@ -28,6 +28,8 @@
 #include <algorithm>
 #include <Corrade/Utility/Assert.h>
 
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/Functions.h"
 #include "Magnum/Shapes/Implementation/CollisionDispatch.h"
 
 namespace Magnum { namespace Shapes {
@@ -58,14 +60,28 @@ Shapes are merged together by concatenating its node and shape list and adding
 new node at the beginning with properly set `rightNode` and `rightShape`.
 Because these values are relative to parent, they don't need to be modified
 when concatenating.
+
+Collision evaluation implementation notes:
+
+After construction the tree is compiled into a flat instruction stream, which
+operates on a single boolean result. Leaf shapes are `Test` instructions, NOT
+nodes append a `Not` instruction after the code of their child and AND/OR nodes
+put a `JumpIfFalse` / `JumpIfTrue` instruction between code of their children,
+jumping past the right child for short-circuit evaluation. Code of each AND/OR
+node is additionally prefixed with a `Reject` instruction, which sets the
+result to false and jumps past the whole node if the tested shape is outside of
+bounds of the node. NOT nodes have infinite bounds, so they don't have any.
+
+Bounds of all shapes and nodes are cached in `_shapeBounds` and `_nodeBounds`
+and need to be updated with updateBounds() every time the shapes change.
 */
 
-template<UnsignedInt dimensions> Composition<dimensions>::Composition(const Composition<dimensions>& other): _shapes(other._shapes.size()), _nodes(other._nodes.size()) {
+template<UnsignedInt dimensions> Composition<dimensions>::Composition(const Composition<dimensions>& other): _shapes(other._shapes.size()), _nodes(other._nodes.size()), _program(other._program), _shapeBounds(other._shapeBounds), _nodeBounds(other._nodeBounds) {
     copyShapes(0, other);
     copyNodes(0, other);
 }
 
-template<UnsignedInt dimensions> Composition<dimensions>::Composition(Composition<dimensions>&& other): _shapes(std::move(other._shapes)), _nodes(std::move(other._nodes)) {
+template<UnsignedInt dimensions> Composition<dimensions>::Composition(Composition<dimensions>&& other): _shapes(std::move(other._shapes)), _nodes(std::move(other._nodes)), _program(std::move(other._program)), _shapeBounds(std::move(other._shapeBounds)), _nodeBounds(std::move(other._nodeBounds)) {
     other._shapes = nullptr;
     other._nodes = nullptr;
 }
@@ -87,6 +103,9 @@ template<UnsignedInt dimensions> Composition<dimensions>& Composition<dimensions
 
     copyShapes(0, other);
     copyNodes(0, other);
+    _program = other._program;
+    _shapeBounds = other._shapeBounds;
+    _nodeBounds = other._nodeBounds;
     return *this;
 }
 
@@ -94,6 +113,9 @@ template<UnsignedInt dimensions> Composition<dimensions>& Composition<dimensions
     using std::swap;
     swap(other._shapes, _shapes);
     swap(other._nodes, _nodes);
+    swap(other._program, _program);
+    swap(other._shapeBounds, _shapeBounds);
+    swap(other._nodeBounds, _nodeBounds);
     return *this;
 }
 
@@ -114,38 +136,142 @@ template<UnsignedInt dimensions> void Composition<dimensions>::copyNodes(std::si
     std::copy(other._nodes.begin(), other._nodes.end(), _nodes.begin()+offset);
 }
 
+template<UnsignedInt dimensions> Composition<dimensions> Composition<dimensions>::translated(const VectorTypeFor<dimensions, Float>& translation) const {
+    Composition<dimensions> out(*this);
+    for(Implementation::AbstractShape<dimensions> * const* i = _shapes.begin(), * const* o = out._shapes.begin(); i != _shapes.end(); ++i, ++o)
+        (*i)->translate(translation, *o);
+    out.updateBounds();
+    return out;
+}
+
 template<UnsignedInt dimensions> Composition<dimensions> Composition<dimensions>::transformed(const MatrixTypeFor<dimensions, Float>& matrix) const {
     Composition<dimensions> out(*this);
     for(Implementation::AbstractShape<dimensions> * const* i = _shapes.begin(), * const* o = out._shapes.begin(); i != _shapes.end(); ++i, ++o)
         (*i)->transform(matrix, *o);
+    out.updateBounds();
     return out;
 }
 
-template<UnsignedInt dimensions> bool Composition<dimensions>::collides(const Implementation::AbstractShape<dimensions>& a, const std::size_t node, const std::size_t shapeBegin, const std::size_t shapeEnd) const {
+namespace {
+
+template<UnsignedInt dimensions> inline bool intersects(const RangeTypeFor<dimensions, Float>& a, const RangeTypeFor<dimensions, Float>& b) {
+    return (a.min() <= b.max()).all() && (b.min() <= a.max()).all();
+}
+
+}
+
+template<UnsignedInt dimensions> bool Composition<dimensions>::collides(const Implementation::AbstractShape<dimensions>& a) const {
+    const RangeTypeFor<dimensions, Float> bounds = a.bounds();
+
+    bool result = false;
+    for(std::size_t i = 0; i < _program.size(); ) {
+        const Instruction& instruction = _program[i];
+        switch(instruction.opcode) {
+            case Opcode::Test:
+                result = intersects<dimensions>(bounds, _shapeBounds[instruction.operand]) &&
+                    Implementation::collides(a, *_shapes[instruction.operand]);
+                ++i;
+                break;
+            case Opcode::Reject:
+                if(intersects<dimensions>(bounds, _nodeBounds[instruction.operand])) ++i;
+                else {
+                    result = false;
+                    i = instruction.jump;
+                }
+                break;
+            case Opcode::Not:
+                result = !result;
+                ++i;
+                break;
+            case Opcode::JumpIfFalse:
+                i = result ? i + 1 : instruction.jump;
+                break;
+            case Opcode::JumpIfTrue:
+                i = result ? instruction.jump : i + 1;
+                break;
+        }
+    }
+
+    return result;
+}
+
+template<UnsignedInt dimensions> void Composition<dimensions>::compile() {
+    _program.clear();
+
     /* Empty group */
-    if(shapeBegin == shapeEnd) return false;
+    if(_shapes.empty()) return;
+
+    _program.reserve(_shapes.size() + 2*_nodes.size());
+    compile(0, 0, _shapes.size());
+    updateBounds();
+}
 
+template<UnsignedInt dimensions> void Composition<dimensions>::compile(const std::size_t node, const std::size_t shapeBegin, const std::size_t shapeEnd) {
     CORRADE_INTERNAL_ASSERT(node < _nodes.size() && shapeBegin < shapeEnd);
 
-    /* Collision on the left child. If the node is leaf one (no left child
-       exists), do it directly, recurse instead. */
-    const bool collidesLeft = (_nodes[node].rightNode == 0 || _nodes[node].rightNode == 2) ?
-        Implementation::collides(a, *_shapes[shapeBegin]) :
-        collides(a, node+1, shapeBegin, shapeBegin+_nodes[node].rightShape);
+    /* Reject the whole node early if outside of its bounds, the jump target
+       is patched at the end */
+    const std::size_t reject = _program.size();
+    if(_nodes[node].operation != CompositionOperation::Not)
+        _program.push_back({Opcode::Reject, UnsignedInt(node), 0});
+
+    /* Left child. If the node is leaf one (no left child exists), test the
+       shape directly, compile the subtree otherwise. */
+    if(_nodes[node].rightNode == 0 || _nodes[node].rightNode == 2)
+        _program.push_back({Opcode::Test, UnsignedInt(shapeBegin), 0});
+    else compile(node+1, shapeBegin, shapeBegin+_nodes[node].rightShape);
 
     /* NOT operation */
+    if(_nodes[node].operation == CompositionOperation::Not) {
+        _program.push_back({Opcode::Not, 0, 0});
+        return;
+    }
+
+    /* Short-circuit evaluation for AND/OR, jumping past the right child */
+    const std::size_t jump = _program.size();
+    _program.push_back({_nodes[node].operation == CompositionOperation::Or ?
+        Opcode::JumpIfTrue : Opcode::JumpIfFalse, 0, 0});
+
+    /* Right child, similar to the left child */
+    if(_nodes[node].rightNode < 2)
+        _program.push_back({Opcode::Test, UnsignedInt(shapeBegin+_nodes[node].rightShape), 0});
+    else compile(node+_nodes[node].rightNode-1, shapeBegin+_nodes[node].rightShape, shapeEnd);
+
+    _program[jump].jump = _program[reject].jump = _program.size();
+}
+
+template<UnsignedInt dimensions> void Composition<dimensions>::updateBounds() {
+    _shapeBounds.resize(_shapes.size());
+    for(std::size_t i = 0; i != _shapes.size(); ++i)
+        _shapeBounds[i] = _shapes[i]->bounds();
+
+    _nodeBounds.resize(_nodes.size());
+    if(!_shapes.empty()) updateBounds(0, 0, _shapes.size());
+}
+
+template<UnsignedInt dimensions> RangeTypeFor<dimensions, Float> Composition<dimensions>::updateBounds(const std::size_t node, const std::size_t shapeBegin, const std::size_t shapeEnd) {
+    CORRADE_INTERNAL_ASSERT(node < _nodes.size() && shapeBegin < shapeEnd);
+
+    const RangeTypeFor<dimensions, Float> left = (_nodes[node].rightNode == 0 || _nodes[node].rightNode == 2) ?
+        _shapeBounds[shapeBegin] :
+        updateBounds(node+1, shapeBegin, shapeBegin+_nodes[node].rightShape);
+
+    /* Everything outside of the child collides with its negation. The child
+       is still processed to have bounds of its subnodes updated. */
     if(_nodes[node].operation == CompositionOperation::Not)
-        return !collidesLeft;
+        return _nodeBounds[node] = {VectorTypeFor<dimensions, Float>{-Constants::inf()},
+                                    VectorTypeFor<dimensions, Float>{Constants::inf()}};
+
+    const RangeTypeFor<dimensions, Float> right = (_nodes[node].rightNode < 2) ?
+        _shapeBounds[shapeBegin+_nodes[node].rightShape] :
+        updateBounds(node+_nodes[node].rightNode-1, shapeBegin+_nodes[node].rightShape, shapeEnd);
 
-    /* Short-circuit evaluation for AND/OR */
-    if((_nodes[node].operation == CompositionOperation::Or) == collidesLeft)
-        return collidesLeft;
+    /* Anything colliding with both children collides with each of them, so
+       bounds of any child are sufficient. Pick the smaller one. */
+    if(_nodes[node].operation == CompositionOperation::And)
+        return _nodeBounds[node] = (left.size() < right.size()).all() ? left : right;
 
-    /* Now the collision result depends only on the right child. Similar to
-       collision on the left child. */
-    return (_nodes[node].rightNode < 2) ?
-        Implementation::collides(a, *_shapes[shapeBegin+_nodes[node].rightShape]) :
-        collides(a, node+_nodes[node].rightNode-1, shapeBegin+_nodes[node].rightShape, shapeEnd);
+    return _nodeBounds[node] = {Math::min(left.min(), right.min()), Math::max(left.max(), right.max())};
 }
 
 #ifndef DOXYGEN_GENERATING_OUTPUT
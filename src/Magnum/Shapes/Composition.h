@@ -31,6 +31,7 @@
 
 #include <type_traits>
 #include <utility>
+#include <vector>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Utility/Assert.h>
 
@@ -63,11 +64,19 @@ enum class CompositionOperation: UnsignedByte {
 @brief Composition of shapes
 
 Result of logical operations on shapes. See @ref shapes for brief introduction.
+
+On construction the operation tree is compiled into a flat instruction stream,
+which is then evaluated in a single loop without recursion. Bounds of all
+shapes and subtrees are cached, so shapes and whole subtrees that are outside
+of bounds of the tested shape are rejected without doing the actual collision
+test.
 */
 template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT Composition {
     friend Implementation::AbstractShape<dimensions>& Implementation::getAbstractShape<>(Composition<dimensions>&, std::size_t);
     friend const Implementation::AbstractShape<dimensions>& Implementation::getAbstractShape<>(const Composition<dimensions>&, std::size_t);
     friend Implementation::ShapeHelper<Composition<dimensions>>;
+    friend RangeTypeFor<dimensions, Float> Implementation::bounds<>(const Composition<dimensions>&);
+    friend Float Implementation::raycast<>(const Composition<dimensions>&, const VectorTypeFor<dimensions, Float>&, const VectorTypeFor<dimensions, Float>&, VectorTypeFor<dimensions, Float>&);
 
     public:
         enum: UnsignedInt {
@@ -131,6 +140,14 @@ template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT Composition {
         /** @brief Transformed shape */
         Composition<dimensions> transformed(const MatrixTypeFor<dimensions, Float>& matrix) const;
 
+        /**
+         * @brief Translated shape
+         *
+         * Cheaper alternative to @ref transformed() for translation-only
+         * transformations.
+         */
+        Composition<dimensions> translated(const VectorTypeFor<dimensions, Float>& translation) const;
+
         /** @brief Count of shapes in the hierarchy */
         std::size_t size() const { return _shapes.size(); }
 
@@ -155,11 +172,27 @@ template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT Composition {
             CompositionOperation operation;
         };
 
-        bool collides(const Implementation::AbstractShape<dimensions>& a) const {
-            return collides(a, 0, 0, _shapes.size());
-        }
+        enum class Opcode: UnsignedByte {
+            Test,           /* result = collision with shape `operand` */
+            Reject,         /* result = false and jump if outside bounds of
+                               node `operand` */
+            Not,            /* result = !result */
+            JumpIfFalse,    /* jump if result is false */
+            JumpIfTrue      /* jump if result is true */
+        };
+
+        struct Instruction {
+            Opcode opcode;
+            UnsignedInt operand, jump;
+        };
 
-        bool collides(const Implementation::AbstractShape<dimensions>& a, std::size_t node, std::size_t shapeBegin, std::size_t shapeEnd) const;
+        bool collides(const Implementation::AbstractShape<dimensions>& a) const;
+
+        void compile();
+        void compile(std::size_t node, std::size_t shapeBegin, std::size_t shapeEnd);
+
+        void updateBounds();
+        RangeTypeFor<dimensions, Float> updateBounds(std::size_t node, std::size_t shapeBegin, std::size_t shapeEnd);
 
         template<class T> constexpr static std::size_t shapeCount(const T&) {
             return 1;
@@ -185,6 +218,11 @@ template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT Composition {
 
         Containers::Array<Implementation::AbstractShape<dimensions>*> _shapes;
         Containers::Array<Node> _nodes;
+
+        /* Flattened tree and cached bounds, (re)built in compile() and
+           updateBounds() */
+        std::vector<Instruction> _program;
+        std::vector<RangeTypeFor<dimensions, Float>> _shapeBounds, _nodeBounds;
 };
 
 /** @brief Two-dimensional shape composition */
@@ -266,6 +304,7 @@ template<UnsignedInt dimensions> template<class T> Composition<dimensions>::Comp
     _nodes[0].rightShape = shapeCount(a);
     copyNodes(1, a);
     copyShapes(0, std::forward<T>(a));
+    compile();
 }
 
 template<UnsignedInt dimensions> template<class T, class U> Composition<dimensions>::Composition(CompositionOperation operation, T&& a, U&& b): _shapes(shapeCount(a) + shapeCount(b)), _nodes(nodeCount(a) + nodeCount(b) + 1) {
@@ -285,6 +324,7 @@ template<UnsignedInt dimensions> template<class T, class U> Composition<dimensio
     copyNodes(nodeCount(a) + 1, b);
     copyShapes(shapeCount(a), std::forward<U>(b));
     copyShapes(0, std::forward<T>(a));
+    compile();
 }
 
 template<UnsignedInt dimensions> template<class T> inline const T& Composition<dimensions>::get(std::size_t i) const {
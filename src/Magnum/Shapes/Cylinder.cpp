@@ -51,6 +51,43 @@ template<UnsignedInt dimensions> bool Cylinder<dimensions>::operator%(const Sphe
         Math::pow<2>(_radius+other.radius());
 }
 
+namespace {
+
+/* Collision of the cylinder with a point or a sphere around it, contact
+   position is on the surface of the other shape */
+template<UnsignedInt dimensions> Collision<dimensions> cylinderCollision(const VectorTypeFor<dimensions, Float>& a, const VectorTypeFor<dimensions, Float>& b, const Float radius, const VectorTypeFor<dimensions, Float>& position, const Float otherRadius) {
+    /* Closest point on the line */
+    const VectorTypeFor<dimensions, Float> direction = b - a;
+    const Float t = Math::dot(position - a, direction)/direction.dot();
+    const VectorTypeFor<dimensions, Float> separating = a + direction*t - position;
+    const Float dot = separating.dot();
+
+    /* No collision occured */
+    const Float minDistance = radius + otherRadius;
+    if(dot > Math::pow<2>(minDistance)) return {};
+
+    /* Actual distance from the axis */
+    const Float distance = Math::sqrt(dot);
+
+    /* Separating normal. If can't decide on direction, just move up. */
+    const VectorTypeFor<dimensions, Float> separatingNormal =
+        Math::TypeTraits<Float>::equals(dot, 0.0f) ?
+        VectorTypeFor<dimensions, Float>::yAxis() :
+        separating/distance;
+
+    return Collision<dimensions>(position + separatingNormal*otherRadius, separatingNormal, minDistance - distance);
+}
+
+}
+
+template<UnsignedInt dimensions> Collision<dimensions> Cylinder<dimensions>::operator/(const Point<dimensions>& other) const {
+    return cylinderCollision<dimensions>(_a, _b, _radius, other.position(), 0.0f);
+}
+
+template<UnsignedInt dimensions> Collision<dimensions> Cylinder<dimensions>::operator/(const Sphere<dimensions>& other) const {
+    return cylinderCollision<dimensions>(_a, _b, _radius, other.position(), other.radius());
+}
+
 #ifndef DOXYGEN_GENERATING_OUTPUT
 template class MAGNUM_SHAPES_EXPORT Cylinder<2>;
 template class MAGNUM_SHAPES_EXPORT Cylinder<3>;
@@ -31,6 +31,7 @@
 
 #include "Magnum/DimensionTraits.h"
 #include "Magnum/Math/Vector3.h"
+#include "Magnum/Shapes/Collision.h"
 #include "Magnum/Shapes/Shapes.h"
 #include "Magnum/Shapes/visibility.h"
 
@@ -64,6 +65,16 @@ template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT Cylinder {
         /** @brief Transformed shape */
         Cylinder<dimensions> transformed(const MatrixTypeFor<dimensions, Float>& matrix) const;
 
+        /**
+         * @brief Translated shape
+         *
+         * Cheaper alternative to @ref transformed() for translation-only
+         * transformations.
+         */
+        Cylinder<dimensions> translated(const VectorTypeFor<dimensions, Float>& translation) const {
+            return Cylinder<dimensions>(_a + translation, _b + translation, _radius);
+        }
+
         /** @brief First point */
         constexpr VectorTypeFor<dimensions, Float> a() const {
             return _a;
@@ -93,9 +104,15 @@ template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT Cylinder {
         /** @brief Collision occurence with point */
         bool operator%(const Point<dimensions>& other) const;
 
+        /** @brief Collision with point */
+        Collision<dimensions> operator/(const Point<dimensions>& other) const;
+
         /** @brief Collision occurence with sphere */
         bool operator%(const Sphere<dimensions>& other) const;
 
+        /** @brief Collision with sphere */
+        Collision<dimensions> operator/(const Sphere<dimensions>& other) const;
+
     private:
         VectorTypeFor<dimensions, Float> _a, _b;
         Float _radius;
@@ -110,9 +127,15 @@ typedef Cylinder<3> Cylinder3D;
 /** @collisionoccurenceoperator{Point,Cylinder} */
 template<UnsignedInt dimensions> inline bool operator%(const Point<dimensions>& a, const Cylinder<dimensions>& b) { return b % a; }
 
+/** @collisionoperator{Point,Cylinder} */
+template<UnsignedInt dimensions> inline Collision<dimensions> operator/(const Point<dimensions>& a, const Cylinder<dimensions>& b) { return (b/a).flipped(); }
+
 /** @collisionoccurenceoperator{Sphere,Cylinder} */
 template<UnsignedInt dimensions> inline bool operator%(const Sphere<dimensions>& a, const Cylinder<dimensions>& b) { return b % a; }
 
+/** @collisionoperator{Sphere,Cylinder} */
+template<UnsignedInt dimensions> inline Collision<dimensions> operator/(const Sphere<dimensions>& a, const Cylinder<dimensions>& b) { return (b/a).flipped(); }
+
 }}
 
 #endif
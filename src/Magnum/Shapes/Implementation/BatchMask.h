@@ -0,0 +1,74 @@
+#ifndef Magnum_Shapes_Implementation_BatchMask_h
+#define Magnum_Shapes_Implementation_BatchMask_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Magnum.h"
+
+namespace Magnum { namespace Shapes { namespace Implementation {
+
+/*
+Batch collision helpers:
+
+The batch kernels process the SoA data in blocks of 32 items. The test is
+first evaluated for the whole block into a byte array without any branches,
+which is a loop the compiler can vectorize, and the bytes are then packed into
+one 32-bit mask word. Bit `i % 32` of word `i / 32` is set if item `i`
+collides.
+*/
+
+enum: std::size_t { BatchBlockSize = 32 };
+
+inline std::size_t batchMaskSize(std::size_t count) {
+    return (count + BatchBlockSize - 1)/BatchBlockSize;
+}
+
+template<class Test> void batchMask(const std::size_t count, const Containers::ArrayView<UnsignedInt> mask, Test test) {
+    UnsignedByte hits[BatchBlockSize];
+    for(std::size_t block = 0, begin = 0; begin < count; ++block, begin += BatchBlockSize) {
+        const std::size_t end = begin + BatchBlockSize < count ? begin + BatchBlockSize : count;
+        test(begin, end, hits);
+
+        UnsignedInt bits = 0;
+        for(std::size_t i = 0; i != end - begin; ++i)
+            bits |= UnsignedInt(hits[i]) << i;
+        mask[block] = bits;
+    }
+}
+
+inline std::vector<UnsignedInt> batchMaskIndices(const Containers::ArrayView<const UnsignedInt> mask) {
+    std::vector<UnsignedInt> out;
+    for(std::size_t block = 0; block != mask.size(); ++block)
+        for(UnsignedInt bits = mask[block], i = 0; bits; bits >>= 1, ++i)
+            if(bits & 1) out.push_back(UnsignedInt(block*BatchBlockSize) + i);
+    return out;
+}
+
+}}}
+
+#endif
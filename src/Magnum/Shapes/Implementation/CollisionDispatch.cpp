@@ -66,14 +66,27 @@ template<> bool collides(const AbstractShape<2>& a, const AbstractShape<2>& b) {
 }
 
 template<> Collision<2> collision(const AbstractShape<2>& a, const AbstractShape<2>& b) {
-    if(a.type() < b.type()) return collision(b, a);
+    if(a.type() < b.type()) return collision(b, a).flipped();
 
     switch(UnsignedInt(a.type())*UnsignedInt(b.type())) {
         #define _c(aType, aClass, bType, bClass) \
             case UnsignedInt(ShapeDimensionTraits<2>::Type::aType)*UnsignedInt(ShapeDimensionTraits<2>::Type::bType): \
                 return static_cast<const Shape<aClass>&>(a).shape / static_cast<const Shape<bClass>&>(b).shape;
         _c(Sphere, Sphere2D, Point, Point2D)
+        _c(Sphere, Sphere2D, Line, Line2D)
+        _c(Sphere, Sphere2D, LineSegment, LineSegment2D)
         _c(Sphere, Sphere2D, Sphere, Sphere2D)
+
+        _c(InvertedSphere, InvertedSphere2D, Point, Point2D)
+        _c(InvertedSphere, InvertedSphere2D, Sphere, Sphere2D)
+
+        _c(Cylinder, Cylinder2D, Point, Point2D)
+        _c(Cylinder, Cylinder2D, Sphere, Sphere2D)
+
+        _c(Capsule, Capsule2D, Point, Point2D)
+        _c(Capsule, Capsule2D, Sphere, Sphere2D)
+
+        _c(AxisAlignedBox, AxisAlignedBox2D, Point, Point2D)
         #undef _c
     }
 
@@ -112,14 +125,30 @@ template<> bool collides(const AbstractShape<3>& a, const AbstractShape<3>& b) {
 }
 
 template<> Collision<3> collision(const AbstractShape<3>& a, const AbstractShape<3>& b) {
-    if(a.type() < b.type()) return collision(b, a);
+    if(a.type() < b.type()) return collision(b, a).flipped();
 
     switch(UnsignedInt(a.type())*UnsignedInt(b.type())) {
         #define _c(aType, aClass, bType, bClass) \
             case UnsignedInt(ShapeDimensionTraits<3>::Type::aType)*UnsignedInt(ShapeDimensionTraits<3>::Type::bType): \
                 return static_cast<const Shape<aClass>&>(a).shape / static_cast<const Shape<bClass>&>(b).shape;
         _c(Sphere, Sphere3D, Point, Point3D)
+        _c(Sphere, Sphere3D, Line, Line3D)
+        _c(Sphere, Sphere3D, LineSegment, LineSegment3D)
         _c(Sphere, Sphere3D, Sphere, Sphere3D)
+
+        _c(InvertedSphere, InvertedSphere3D, Point, Point3D)
+        _c(InvertedSphere, InvertedSphere3D, Sphere, Sphere3D)
+
+        _c(Cylinder, Cylinder3D, Point, Point3D)
+        _c(Cylinder, Cylinder3D, Sphere, Sphere3D)
+
+        _c(Capsule, Capsule3D, Point, Point3D)
+        _c(Capsule, Capsule3D, Sphere, Sphere3D)
+
+        _c(AxisAlignedBox, AxisAlignedBox3D, Point, Point3D)
+
+        _c(Plane, Plane, Line, Line3D)
+        _c(Plane, Plane, LineSegment, LineSegment3D)
         #undef _c
     }
 
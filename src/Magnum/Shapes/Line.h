@@ -61,6 +61,16 @@ template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT Line {
         /** @brief Transformed shape */
         Line<dimensions> transformed(const MatrixTypeFor<dimensions, Float>& matrix) const;
 
+        /**
+         * @brief Translated shape
+         *
+         * Cheaper alternative to @ref transformed() for translation-only
+         * transformations.
+         */
+        Line<dimensions> translated(const VectorTypeFor<dimensions, Float>& translation) const {
+            return Line<dimensions>(_a + translation, _b + translation);
+        }
+
         /** @brief First point */
         constexpr VectorTypeFor<dimensions, Float> a() const {
             return _a;
@@ -56,6 +56,16 @@ template<UnsignedInt dimensions> class LineSegment: public Line<dimensions> {
             return Line<dimensions>::transformed(matrix);
         }
 
+        /**
+         * @brief Translated shape
+         *
+         * Cheaper alternative to @ref transformed() for translation-only
+         * transformations.
+         */
+        LineSegment<dimensions> translated(const VectorTypeFor<dimensions, Float>& translation) const {
+            return Line<dimensions>::translated(translation);
+        }
+
     private:
         constexpr LineSegment(const Line<dimensions>& line): Line<dimensions>(line) {}
 };
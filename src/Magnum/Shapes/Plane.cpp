@@ -25,6 +25,8 @@
 
 #include "Plane.h"
 
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/Functions.h"
 #include "Magnum/Math/Matrix4.h"
 #include "Magnum/Math/Geometry/Intersection.h"
 #include "Magnum/Shapes/LineSegment.h"
@@ -51,4 +53,30 @@ bool Plane::operator%(const LineSegment3D& other) const {
     return t > 0.0f && t < 1.0f;
 }
 
+Collision3D Plane::operator/(const Line3D& other) const {
+    const Vector3 direction = other.b() - other.a();
+    const Float t = Intersection::planeLine(_position, _normal, other.a(), direction);
+
+    /* No collision occured, line parallel to the plane */
+    if(t == Constants::inf() || t == -Constants::inf()) return {};
+
+    /* Line lying in the plane */
+    const Vector3 position = t != t ? other.a() : other.a() + direction*t;
+    return Collision3D(position, _normal.normalized(), Constants::inf());
+}
+
+Collision3D Plane::operator/(const LineSegment3D& other) const {
+    if(!(*this % other)) return {};
+
+    /* Signed distances of the endpoints, the plane is moved past the closer
+       one, leaving the segment on the side of the farther one */
+    const Vector3 normal = _normal.normalized();
+    const Float distanceA = Math::dot(other.a() - _position, normal);
+    const Float distanceB = Math::dot(other.b() - _position, normal);
+    const Float distance = Math::abs(distanceA) < Math::abs(distanceB) ? distanceA : distanceB;
+    const Vector3 position = Math::abs(distanceA) < Math::abs(distanceB) ? other.a() : other.b();
+
+    return Collision3D(position, distance < 0.0f ? -normal : normal, Math::abs(distance));
+}
+
 }}
@@ -31,6 +31,7 @@
 
 #include "Magnum/Magnum.h"
 #include "Magnum/Math/Vector3.h"
+#include "Magnum/Shapes/Collision.h"
 #include "Magnum/Shapes/Shapes.h"
 #include "Magnum/Shapes/visibility.h"
 
@@ -61,6 +62,16 @@ class MAGNUM_SHAPES_EXPORT Plane {
         /** @brief Transformed shape */
         Plane transformed(const Matrix4& matrix) const;
 
+        /**
+         * @brief Translated shape
+         *
+         * Cheaper alternative to @ref transformed() for translation-only
+         * transformations.
+         */
+        Plane translated(const Vector3& translation) const {
+            return Plane(_position + translation, _normal);
+        }
+
         /** @brief Position */
         constexpr Vector3 position() const { return _position; }
 
@@ -80,9 +91,27 @@ class MAGNUM_SHAPES_EXPORT Plane {
         /** @brief Collision occurence with line */
         bool operator%(const Line3D& other) const;
 
+        /**
+         * @brief Collision with line
+         *
+         * Contact position is the intersection point, or the first line
+         * point if the line lies in the plane. The line can't be separated
+         * from the plane by movement along the normal, so the separation
+         * distance is infinite.
+         */
+        Collision3D operator/(const Line3D& other) const;
+
         /** @brief Collision occurence with line segment */
         bool operator%(const LineSegment3D& other) const;
 
+        /**
+         * @brief Collision with line segment
+         *
+         * Contact position is the segment endpoint closer to the plane, the
+         * plane is separated by moving it past that endpoint.
+         */
+        Collision3D operator/(const LineSegment3D& other) const;
+
     private:
         Vector3 _position, _normal;
 };
@@ -94,6 +123,13 @@ class MAGNUM_SHAPES_EXPORT Plane {
 */
 inline bool operator%(const Line3D& a, const Plane& b) { return b % a; }
 
+/** @relatesalso Line
+@brief Collision of @ref Line and @ref Plane
+
+@see @ref Plane::operator/(const Line3D&) const
+*/
+inline Collision3D operator/(const Line3D& a, const Plane& b) { return (b/a).flipped(); }
+
 /** @relatesalso LineSegment
 @brief Collision occurence of @ref LineSegment and @ref Plane
 
@@ -101,6 +137,13 @@ inline bool operator%(const Line3D& a, const Plane& b) { return b % a; }
 */
 inline bool operator%(const LineSegment3D& a, const Plane& b) { return b % a; }
 
+/** @relatesalso LineSegment
+@brief Collision of @ref LineSegment and @ref Plane
+
+@see @ref Plane::operator/(const LineSegment3D&) const
+*/
+inline Collision3D operator/(const LineSegment3D& a, const Plane& b) { return (b/a).flipped(); }
+
 
 }}
 
@@ -60,6 +60,16 @@ template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT Point {
         /** @brief Transformed shape */
         Point<dimensions> transformed(const MatrixTypeFor<dimensions, Float>& matrix) const;
 
+        /**
+         * @brief Translated shape
+         *
+         * Cheaper alternative to @ref transformed() for translation-only
+         * transformations.
+         */
+        Point<dimensions> translated(const VectorTypeFor<dimensions, Float>& translation) const {
+            return Point<dimensions>(_position + translation);
+        }
+
         /** @brief Position */
         constexpr VectorTypeFor<dimensions, Float> position() const {
             return _position;
@@ -0,0 +1,139 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "PointBatch.h"
+
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Shapes/AxisAlignedBox.h"
+#include "Magnum/Shapes/Point.h"
+#include "Magnum/Shapes/Sphere.h"
+#include "Magnum/Shapes/Implementation/BatchMask.h"
+
+namespace Magnum { namespace Shapes {
+
+template<UnsignedInt dimensions> PointBatch<dimensions>::PointBatch() = default;
+
+template<UnsignedInt dimensions> std::size_t PointBatch<dimensions>::maskSize() const {
+    return Implementation::batchMaskSize(size());
+}
+
+template<UnsignedInt dimensions> const std::vector<Float>& PointBatch<dimensions>::coordinates(const UnsignedInt dimension) const {
+    CORRADE_ASSERT(dimension < dimensions,
+        "Shapes::PointBatch::coordinates(): dimension" << dimension << "out of range for" << dimensions << "dimensions", _coordinates[0]);
+    return _coordinates[dimension];
+}
+
+template<UnsignedInt dimensions> VectorTypeFor<dimensions, Float> PointBatch<dimensions>::position(const std::size_t i) const {
+    CORRADE_ASSERT(i < size(),
+        "Shapes::PointBatch::position(): index" << i << "out of range for" << size() << "points", {});
+    VectorTypeFor<dimensions, Float> out;
+    for(UnsignedInt d = 0; d != dimensions; ++d)
+        out[d] = _coordinates[d][i];
+    return out;
+}
+
+template<UnsignedInt dimensions> PointBatch<dimensions>& PointBatch<dimensions>::setPosition(const std::size_t i, const VectorTypeFor<dimensions, Float>& position) {
+    CORRADE_ASSERT(i < size(),
+        "Shapes::PointBatch::setPosition(): index" << i << "out of range for" << size() << "points", *this);
+    for(UnsignedInt d = 0; d != dimensions; ++d)
+        _coordinates[d][i] = position[d];
+    return *this;
+}
+
+template<UnsignedInt dimensions> PointBatch<dimensions>& PointBatch<dimensions>::add(const Point<dimensions>& point) {
+    return add(point.position());
+}
+
+template<UnsignedInt dimensions> PointBatch<dimensions>& PointBatch<dimensions>::add(const VectorTypeFor<dimensions, Float>& position) {
+    for(UnsignedInt d = 0; d != dimensions; ++d)
+        _coordinates[d].push_back(position[d]);
+    return *this;
+}
+
+template<UnsignedInt dimensions> PointBatch<dimensions>& PointBatch<dimensions>::clear() {
+    for(std::vector<Float>& coordinates: _coordinates)
+        coordinates.clear();
+    return *this;
+}
+
+template<UnsignedInt dimensions> void PointBatch<dimensions>::collisionMask(const Sphere<dimensions>& sphere, const Containers::ArrayView<UnsignedInt> mask) const {
+    CORRADE_ASSERT(mask.size() >= maskSize(),
+        "Shapes::PointBatch::collisionMask(): expected at least" << maskSize() << "words but got" << mask.size(), );
+
+    const VectorTypeFor<dimensions, Float> center = sphere.position();
+    const Float radiusSquared = Math::pow<2>(sphere.radius());
+    Implementation::batchMask(size(), mask, [&](const std::size_t begin, const std::size_t end, UnsignedByte* const hits) {
+        Float distancesSquared[Implementation::BatchBlockSize]{};
+        for(UnsignedInt d = 0; d != dimensions; ++d) {
+            const Float* const coordinates = _coordinates[d].data() + begin;
+            const Float c = center[d];
+            for(std::size_t i = 0; i != end - begin; ++i)
+                distancesSquared[i] += Math::pow<2>(c - coordinates[i]);
+        }
+
+        for(std::size_t i = 0; i != end - begin; ++i)
+            hits[i] = distancesSquared[i] < radiusSquared;
+    });
+}
+
+template<UnsignedInt dimensions> void PointBatch<dimensions>::collisionMask(const AxisAlignedBox<dimensions>& box, const Containers::ArrayView<UnsignedInt> mask) const {
+    CORRADE_ASSERT(mask.size() >= maskSize(),
+        "Shapes::PointBatch::collisionMask(): expected at least" << maskSize() << "words but got" << mask.size(), );
+
+    const VectorTypeFor<dimensions, Float> min = box.min();
+    const VectorTypeFor<dimensions, Float> max = box.max();
+    Implementation::batchMask(size(), mask, [&](const std::size_t begin, const std::size_t end, UnsignedByte* const hits) {
+        for(std::size_t i = 0; i != end - begin; ++i)
+            hits[i] = 1;
+
+        for(UnsignedInt d = 0; d != dimensions; ++d) {
+            const Float* const coordinates = _coordinates[d].data() + begin;
+            const Float lo = min[d], hi = max[d];
+            for(std::size_t i = 0; i != end - begin; ++i)
+                hits[i] &= UnsignedByte(coordinates[i] >= lo) & UnsignedByte(coordinates[i] < hi);
+        }
+    });
+}
+
+template<UnsignedInt dimensions> std::vector<UnsignedInt> PointBatch<dimensions>::collisions(const Sphere<dimensions>& sphere) const {
+    std::vector<UnsignedInt> mask(maskSize());
+    collisionMask(sphere, {mask.data(), mask.size()});
+    return Implementation::batchMaskIndices({mask.data(), mask.size()});
+}
+
+template<UnsignedInt dimensions> std::vector<UnsignedInt> PointBatch<dimensions>::collisions(const AxisAlignedBox<dimensions>& box) const {
+    std::vector<UnsignedInt> mask(maskSize());
+    collisionMask(box, {mask.data(), mask.size()});
+    return Implementation::batchMaskIndices({mask.data(), mask.size()});
+}
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+template class MAGNUM_SHAPES_EXPORT PointBatch<2>;
+template class MAGNUM_SHAPES_EXPORT PointBatch<3>;
+#endif
+
+}}
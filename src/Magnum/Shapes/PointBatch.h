@@ -0,0 +1,175 @@
+#ifndef Magnum_Shapes_PointBatch_h
+#define Magnum_Shapes_PointBatch_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Shapes::PointBatch, typedef @ref Magnum::Shapes::PointBatch2D, @ref Magnum::Shapes::PointBatch3D
+ */
+
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/DimensionTraits.h"
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/Shapes/Shapes.h"
+#include "Magnum/Shapes/visibility.h"
+
+namespace Magnum { namespace Shapes {
+
+/**
+@brief Batch of points
+
+Stores positions of many points in a structure-of-arrays layout and tests all
+of them against one shape at once. The result is the same as testing each
+@ref Point separately with @ref Sphere::operator%(const Point<dimensions>&) const "Sphere::operator%()"
+or @ref AxisAlignedBox::operator%(const Point<dimensions>&) const "AxisAlignedBox::operator%()",
+but the tests are done in branch-free loops over contiguous arrays which the
+compiler is able to vectorize. Useful for e.g. trigger volumes, where a lot of
+points needs to be tested against a few shapes each frame.
+
+The result is either a bit mask or a list of indices of colliding points:
+
+@code{.cpp}
+Shapes::PointBatch3D points;
+for(const Vector3& position: positions) points.add(position);
+
+for(UnsignedInt i: points.collisions(Shapes::Sphere3D{center, radius})) {
+    // point i is inside the sphere
+}
+@endcode
+
+See @ref shapes for brief introduction.
+@see @ref PointBatch2D, @ref PointBatch3D, @ref SphereBatch
+*/
+template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT PointBatch {
+    public:
+        enum: UnsignedInt {
+            Dimensions = dimensions /**< Dimension count */
+        };
+
+        /**
+         * @brief Default constructor
+         *
+         * Creates an empty batch.
+         */
+        explicit PointBatch();
+
+        /** @brief Count of points in the batch */
+        std::size_t size() const { return _coordinates[0].size(); }
+
+        /** @brief Whether the batch is empty */
+        bool isEmpty() const { return _coordinates[0].empty(); }
+
+        /**
+         * @brief Size of the collision mask
+         *
+         * Count of 32-bit words needed for the collision mask, see
+         * @ref collisionMask().
+         */
+        std::size_t maskSize() const;
+
+        /**
+         * @brief Coordinates of all points
+         *
+         * Contiguous array of @p dimension -th coordinate of all points.
+         * Expects that @p dimension is less than @ref Dimensions.
+         */
+        const std::vector<Float>& coordinates(UnsignedInt dimension) const;
+
+        /** @brief Position of given point */
+        VectorTypeFor<dimensions, Float> position(std::size_t i) const;
+
+        /**
+         * @brief Set position of given point
+         * @return Reference to self (for method chaining)
+         */
+        PointBatch<dimensions>& setPosition(std::size_t i, const VectorTypeFor<dimensions, Float>& position);
+
+        /**
+         * @brief Add point to the batch
+         * @return Reference to self (for method chaining)
+         */
+        PointBatch<dimensions>& add(const Point<dimensions>& point);
+
+        /** @overload */
+        PointBatch<dimensions>& add(const VectorTypeFor<dimensions, Float>& position);
+
+        /**
+         * @brief Remove all points from the batch
+         * @return Reference to self (for method chaining)
+         */
+        PointBatch<dimensions>& clear();
+
+        /**
+         * @brief Collision mask with a sphere
+         *
+         * Sets bit @cpp i % 32 @ce of word @cpp i / 32 @ce of @p mask if
+         * point @cpp i @ce is inside @p sphere, unused bits of the last word
+         * are cleared. Expects that the mask has at least @ref maskSize()
+         * words.
+         * @see @ref Sphere::operator%(const Point<dimensions>&) const
+         */
+        void collisionMask(const Sphere<dimensions>& sphere, Containers::ArrayView<UnsignedInt> mask) const;
+
+        /**
+         * @brief Collision mask with an axis-aligned box
+         *
+         * Same as @ref collisionMask(const Sphere<dimensions>&, Containers::ArrayView<UnsignedInt>) const,
+         * but for an axis-aligned box.
+         * @see @ref AxisAlignedBox::operator%(const Point<dimensions>&) const
+         */
+        void collisionMask(const AxisAlignedBox<dimensions>& box, Containers::ArrayView<UnsignedInt> mask) const;
+
+        /**
+         * @brief Points colliding with a sphere
+         *
+         * Returns indices of all points inside @p sphere in ascending order.
+         * @see @ref collisionMask()
+         */
+        std::vector<UnsignedInt> collisions(const Sphere<dimensions>& sphere) const;
+
+        /**
+         * @brief Points colliding with an axis-aligned box
+         *
+         * Returns indices of all points inside @p box in ascending order.
+         * @see @ref collisionMask()
+         */
+        std::vector<UnsignedInt> collisions(const AxisAlignedBox<dimensions>& box) const;
+
+    private:
+        std::vector<Float> _coordinates[dimensions];
+};
+
+/** @brief Batch of two-dimensional points */
+typedef PointBatch<2> PointBatch2D;
+
+/** @brief Batch of three-dimensional points */
+typedef PointBatch<3> PointBatch3D;
+
+}}
+
+#endif
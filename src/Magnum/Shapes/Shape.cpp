@@ -41,6 +41,14 @@ template<UnsignedInt dimensions> void ShapeHelper<Composition<dimensions>>::tran
     CORRADE_INTERNAL_ASSERT(shape._shape.shape.size() == shape._transformedShape.shape.size());
     for(std::size_t i = 0; i != shape.shape().size(); ++i)
         shape._shape.shape._shapes[i]->transform(absoluteTransformationMatrix, shape._transformedShape.shape._shapes[i]);
+    shape._transformedShape.shape.updateBounds();
+}
+
+template<UnsignedInt dimensions> void ShapeHelper<Composition<dimensions>>::translate(Shapes::Shape<Composition<dimensions>>& shape, const VectorTypeFor<dimensions, Float>& absoluteTranslation) {
+    CORRADE_INTERNAL_ASSERT(shape._shape.shape.size() == shape._transformedShape.shape.size());
+    for(std::size_t i = 0; i != shape.shape().size(); ++i)
+        shape._shape.shape._shapes[i]->translate(absoluteTranslation, shape._transformedShape.shape._shapes[i]);
+    shape._transformedShape.shape.updateBounds();
 }
 
 template struct MAGNUM_SHAPES_EXPORT ShapeHelper<Composition<2>>;
@@ -111,6 +111,9 @@ template<class T> class Shape: public AbstractShape<T::Dimensions> {
         /** Applies transformation to associated shape. */
         void clean(const MatrixTypeFor<T::Dimensions, Float>& absoluteTransformationMatrix) override;
 
+        /** Applies translation to associated shape. */
+        void cleanTranslation(const VectorTypeFor<T::Dimensions, Float>& absoluteTranslation) override;
+
     private:
         const Implementation::AbstractShape<T::Dimensions>& abstractTransformedShape() const override {
             return _transformedShape;
@@ -134,6 +137,10 @@ template<class T> void Shape<T>::clean(const MatrixTypeFor<T::Dimensions, Float>
     Implementation::ShapeHelper<T>::transform(*this, absoluteTransformationMatrix);
 }
 
+template<class T> void Shape<T>::cleanTranslation(const VectorTypeFor<T::Dimensions, Float>& absoluteTranslation) {
+    Implementation::ShapeHelper<T>::translate(*this, absoluteTranslation);
+}
+
 namespace Implementation {
     template<class T> struct ShapeHelper {
         static void set(Shapes::Shape<T>& shape, const T& s) {
@@ -143,6 +150,10 @@ namespace Implementation {
         static void transform(Shapes::Shape<T>& shape, const MatrixTypeFor<T::Dimensions, Float>& absoluteTransformationMatrix) {
             shape._transformedShape.shape = shape._shape.shape.transformed(absoluteTransformationMatrix);
         }
+
+        static void translate(Shapes::Shape<T>& shape, const VectorTypeFor<T::Dimensions, Float>& absoluteTranslation) {
+            shape._transformedShape.shape = shape._shape.shape.translated(absoluteTranslation);
+        }
     };
 
     template<UnsignedInt dimensions> struct MAGNUM_SHAPES_EXPORT ShapeHelper<Composition<dimensions>> {
@@ -150,6 +161,7 @@ namespace Implementation {
         static void set(Shapes::Shape<Composition<dimensions>>& shape, Composition<dimensions>&& composition);
 
         static void transform(Shapes::Shape<Composition<dimensions>>& shape, const MatrixTypeFor<dimensions, Float>& absoluteTransformationMatrix);
+        static void translate(Shapes::Shape<Composition<dimensions>>& shape, const VectorTypeFor<dimensions, Float>& absoluteTranslation);
     };
 }
 
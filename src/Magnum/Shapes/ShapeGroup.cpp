@@ -25,34 +25,435 @@
 
 #include "ShapeGroup.h"
 
+#include <algorithm>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/Functions.h"
 #include "Magnum/Shapes/AbstractShape.h"
 
 namespace Magnum { namespace Shapes {
 
-template<UnsignedInt dimensions> void ShapeGroup<dimensions>::setClean() {
-    /* Clean all objects */
-    if(!this->isEmpty()) {
+namespace {
+
+template<UnsignedInt dimensions> inline bool overlaps(const RangeTypeFor<dimensions, Float>& a, const RangeTypeFor<dimensions, Float>& b) {
+    return (a.min() <= b.max()).all() && (b.min() <= a.max()).all();
+}
+
+template<UnsignedInt dimensions> inline bool isBounded(const RangeTypeFor<dimensions, Float>& range) {
+    for(UnsignedInt i = 0; i != dimensions; ++i)
+        if(Math::isInf(range.min()[i]) || Math::isInf(range.max()[i])) return false;
+    return true;
+}
+
+/* Distance along the ray to given bounds, zero if the origin is inside and
+   infinity if they are not hit */
+template<UnsignedInt dimensions> Float rayBounds(const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction, const RangeTypeFor<dimensions, Float>& range) {
+    Float enter = 0.0f, exit = Constants::inf();
+    for(UnsignedInt i = 0; i != dimensions; ++i) {
+        if(direction[i] == 0.0f) {
+            if(origin[i] < range.min()[i] || origin[i] > range.max()[i])
+                return Constants::inf();
+            continue;
+        }
+
+        const Float t0 = (range.min()[i] - origin[i])/direction[i];
+        const Float t1 = (range.max()[i] - origin[i])/direction[i];
+        enter = Math::max(enter, Math::min(t0, t1));
+        exit = Math::min(exit, Math::max(t0, t1));
+    }
+
+    return enter <= exit ? enter : Constants::inf();
+}
+
+}
+
+template<UnsignedInt dimensions> ShapeGroup<dimensions>& ShapeGroup<dimensions>::add(AbstractShape<dimensions>& shape) {
+    if(shape.group()) shape.group()->setDirty();
+    SceneGraph::FeatureGroup<dimensions, AbstractShape<dimensions>, Float>::add(shape);
+    shape._moved = false;
+    dirty = _rebuild = true;
+    return *this;
+}
+
+template<UnsignedInt dimensions> ShapeGroup<dimensions>& ShapeGroup<dimensions>::remove(AbstractShape<dimensions>& shape) {
+    SceneGraph::FeatureGroup<dimensions, AbstractShape<dimensions>, Float>::remove(shape);
+    shape._moved = false;
+    dirty = _rebuild = true;
+    return *this;
+}
+
+template<UnsignedInt dimensions> void ShapeGroup<dimensions>::markMoved(AbstractShape<dimensions>& shape) {
+    dirty = true;
+
+    /* Everything gets updated anyway */
+    if(_rebuild || shape._moved) return;
+
+    shape._moved = true;
+    _moved.push_back(&shape);
+}
+
+template<UnsignedInt dimensions> void ShapeGroup<dimensions>::setCleanInternal(ThreadPool* const pool) {
+    /* Shapes removed by their destruction mark the group as dirty, but check
+       the size just to be sure */
+    if(_bounds.size() != this->size()) _rebuild = true;
+
+    /* Clean all objects and update the whole broad phase. The list of moved
+       shapes might contain dangling pointers in this case, so it's not
+       touched. */
+    if(_rebuild) {
+        if(!this->isEmpty()) {
+            std::vector<std::reference_wrapper<SceneGraph::AbstractObject<dimensions, Float>>> objects;
+            objects.reserve(this->size());
+            for(std::size_t i = 0; i != this->size(); ++i)
+                objects.push_back((*this)[i].object());
+
+            if(pool) SceneGraph::AbstractObject<dimensions, Float>::setClean(objects, *pool);
+            else SceneGraph::AbstractObject<dimensions, Float>::setClean(objects);
+        }
+
+        updateBroadPhase();
+
+    /* Clean only objects of shapes that moved and update only them in the
+       broad phase */
+    } else if(!_moved.empty()) {
         std::vector<std::reference_wrapper<SceneGraph::AbstractObject<dimensions, Float>>> objects;
-        objects.reserve(this->size());
-        for(std::size_t i = 0; i != this->size(); ++i)
-            objects.push_back((*this)[i].object());
+        objects.reserve(_moved.size());
+        for(AbstractShape<dimensions>* shape: _moved)
+            objects.push_back(shape->object());
 
-        SceneGraph::AbstractObject<dimensions, Float>::setClean(objects);
+        if(pool) SceneGraph::AbstractObject<dimensions, Float>::setClean(objects, *pool);
+        else SceneGraph::AbstractObject<dimensions, Float>::setClean(objects);
+
+        for(AbstractShape<dimensions>* shape: _moved) {
+            shape->_moved = false;
+            updateBroadPhase(shape->_index);
+        }
     }
 
-    dirty = false;
+    _moved.clear();
+    dirty = _rebuild = false;
+}
+
+template<UnsignedInt dimensions> void ShapeGroup<dimensions>::updateBroadPhase() {
+    _bounds.resize(this->size());
+    for(std::size_t i = 0; i != this->size(); ++i) {
+        AbstractShape<dimensions>& shape = (*this)[i];
+        shape._index = UnsignedInt(i);
+        shape._moved = false;
+        _bounds[i] = Implementation::getAbstractShape(shape).bounds();
+    }
+
+    /* The group changed, sort from scratch along the axis with the largest
+       spread of bounded shapes */
+    if(_order.size() != _bounds.size()) {
+        VectorTypeFor<dimensions, Float> min{Constants::inf()}, max{-Constants::inf()};
+        for(const RangeTypeFor<dimensions, Float>& bounds: _bounds) {
+            if(!isBounded<dimensions>(bounds)) continue;
+            min = Math::min(min, bounds.center());
+            max = Math::max(max, bounds.center());
+        }
+
+        _axis = 0;
+        const VectorTypeFor<dimensions, Float> spread = max - min;
+        for(UnsignedInt i = 1; i != dimensions; ++i)
+            if(spread[i] > spread[_axis]) _axis = i;
+
+        _order.resize(_bounds.size());
+        for(std::size_t i = 0; i != _order.size(); ++i)
+            _order[i] = UnsignedInt(i);
+        std::sort(_order.begin(), _order.end(), [this](UnsignedInt a, UnsignedInt b) {
+            return _bounds[a].min()[_axis] < _bounds[b].min()[_axis];
+        });
+
+    /* Otherwise the previous order is nearly sorted if the shapes didn't move
+       much, insertion sort is linear in that case */
+    } else for(std::size_t i = 1; i < _order.size(); ++i) {
+        const UnsignedInt current = _order[i];
+        const Float key = _bounds[current].min()[_axis];
+        std::size_t j = i;
+        for(; j && _bounds[_order[j - 1]].min()[_axis] > key; --j)
+            _order[j] = _order[j - 1];
+        _order[j] = current;
+    }
+
+    _orderPosition.resize(_order.size());
+    for(std::size_t i = 0; i != _order.size(); ++i)
+        _orderPosition[_order[i]] = UnsignedInt(i);
+}
+
+template<UnsignedInt dimensions> void ShapeGroup<dimensions>::updateBroadPhase(const UnsignedInt index) {
+    _bounds[index] = Implementation::getAbstractShape((*this)[index]).bounds();
+
+    /* Move the shape to its new place in the sorted order, shifting the
+       shapes in between */
+    const Float key = _bounds[index].min()[_axis];
+    std::size_t position = _orderPosition[index];
+    for(; position && _bounds[_order[position - 1]].min()[_axis] > key; --position) {
+        _order[position] = _order[position - 1];
+        _orderPosition[_order[position]] = UnsignedInt(position);
+    }
+    for(; position + 1 < _order.size() && _bounds[_order[position + 1]].min()[_axis] < key; ++position) {
+        _order[position] = _order[position + 1];
+        _orderPosition[_order[position]] = UnsignedInt(position);
+    }
+    _order[position] = index;
+    _orderPosition[index] = UnsignedInt(position);
+}
+
+template<UnsignedInt dimensions> void ShapeGroup<dimensions>::collectCandidates(std::vector<std::pair<UnsignedInt, UnsignedInt>>& out) const {
+    /* Sweep along the sorted axis, for each shape test only shapes that start
+       before it ends */
+    for(std::size_t i = 0; i != _order.size(); ++i) {
+        const RangeTypeFor<dimensions, Float>& a = _bounds[_order[i]];
+        for(std::size_t j = i + 1; j != _order.size() && _bounds[_order[j]].min()[_axis] <= a.max()[_axis]; ++j) {
+            if(!overlaps<dimensions>(a, _bounds[_order[j]])) continue;
+            out.emplace_back(std::min(_order[i], _order[j]), std::max(_order[i], _order[j]));
+        }
+    }
+
+    std::sort(out.begin(), out.end());
+}
+
+template<UnsignedInt dimensions> void ShapeGroup<dimensions>::collectCandidates(const RangeTypeFor<dimensions, Float>& bounds, std::vector<UnsignedInt>& out) const {
+    /* Only shapes starting before the query ends along the sorted axis can
+       overlap it */
+    const std::size_t end = std::upper_bound(_order.begin(), _order.end(), bounds.max()[_axis], [this](Float value, UnsignedInt i) {
+        return value < _bounds[i].min()[_axis];
+    }) - _order.begin();
+
+    /* Ordered by position in the group to return the same results as without
+       the broad phase */
+    for(std::size_t i = 0; i != end; ++i)
+        if(overlaps<dimensions>(_bounds[_order[i]], bounds))
+            out.push_back(_order[i]);
+    std::sort(out.begin(), out.end());
 }
 
 template<UnsignedInt dimensions> AbstractShape<dimensions>* ShapeGroup<dimensions>::firstCollision(const AbstractShape<dimensions>& shape) {
     setClean();
-    for(std::size_t i = 0; i != this->size(); ++i)
+
+    /* Reusing the memory, as this is usually called for many shapes in a
+       row */
+    _candidates.clear();
+    collectCandidates(Implementation::getAbstractShape(shape).bounds(), _candidates);
+
+    for(UnsignedInt i: _candidates)
         if(&(*this)[i] != &shape && (*this)[i].collides(shape))
             return &(*this)[i];
 
     return nullptr;
 }
 
+template<UnsignedInt dimensions> auto ShapeGroup<dimensions>::collisionCandidates() -> std::vector<std::pair<AbstractShape<dimensions>*, AbstractShape<dimensions>*>> {
+    setClean();
+
+    std::vector<std::pair<UnsignedInt, UnsignedInt>> candidates;
+    collectCandidates(candidates);
+
+    std::vector<std::pair<AbstractShape<dimensions>*, AbstractShape<dimensions>*>> out;
+    out.reserve(candidates.size());
+    for(const std::pair<UnsignedInt, UnsignedInt>& candidate: candidates)
+        out.emplace_back(&(*this)[candidate.first], &(*this)[candidate.second]);
+    return out;
+}
+
+template<UnsignedInt dimensions> auto ShapeGroup<dimensions>::allCollisions() -> std::vector<std::pair<AbstractShape<dimensions>*, AbstractShape<dimensions>*>> {
+    setClean();
+
+    std::vector<std::pair<UnsignedInt, UnsignedInt>> candidates;
+    collectCandidates(candidates);
+
+    std::vector<std::pair<AbstractShape<dimensions>*, AbstractShape<dimensions>*>> out;
+    for(const std::pair<UnsignedInt, UnsignedInt>& candidate: candidates)
+        if((*this)[candidate.first].collides((*this)[candidate.second]))
+            out.emplace_back(&(*this)[candidate.first], &(*this)[candidate.second]);
+    return out;
+}
+
+template<UnsignedInt dimensions> auto ShapeGroup<dimensions>::allCollisions(ThreadPool& pool) -> std::vector<std::pair<AbstractShape<dimensions>*, AbstractShape<dimensions>*>> {
+    setClean();
+
+    std::vector<std::pair<UnsignedInt, UnsignedInt>> candidates;
+    collectCandidates(candidates);
+
+    /* Each job writes only its own range of results. Not using
+       std::vector<bool> as concurrent writes to it are not safe. */
+    std::vector<UnsignedByte> collided(candidates.size());
+    pool.parallelFor(candidates.size(), 256, [this, &candidates, &collided](std::size_t begin, std::size_t end) {
+        for(std::size_t i = begin; i != end; ++i)
+            collided[i] = (*this)[candidates[i].first].collides((*this)[candidates[i].second]);
+    });
+
+    std::vector<std::pair<AbstractShape<dimensions>*, AbstractShape<dimensions>*>> out;
+    for(std::size_t i = 0; i != candidates.size(); ++i)
+        if(collided[i])
+            out.emplace_back(&(*this)[candidates[i].first], &(*this)[candidates[i].second]);
+    return out;
+}
+
+template<UnsignedInt dimensions> auto ShapeGroup<dimensions>::allCollisions(ShapeGroup<dimensions>& other) -> std::vector<std::pair<AbstractShape<dimensions>*, AbstractShape<dimensions>*>> {
+    return allCollisionsInternal(other, nullptr);
+}
+
+template<UnsignedInt dimensions> auto ShapeGroup<dimensions>::allCollisions(ShapeGroup<dimensions>& other, ThreadPool& pool) -> std::vector<std::pair<AbstractShape<dimensions>*, AbstractShape<dimensions>*>> {
+    return allCollisionsInternal(other, &pool);
+}
+
+template<UnsignedInt dimensions> auto ShapeGroup<dimensions>::allCollisionsInternal(ShapeGroup<dimensions>& other, ThreadPool* const pool) -> std::vector<std::pair<AbstractShape<dimensions>*, AbstractShape<dimensions>*>> {
+    CORRADE_ASSERT(&other != this,
+        "Shapes::ShapeGroup::allCollisions(): can't collide the group with itself", {});
+
+    /* Cleaning touches the objects, do it before going parallel */
+    setCleanInternal(pool);
+    other.setCleanInternal(pool);
+
+    /* Shapes of this group are queried against the broad phase of the other
+       group, with results collected separately for each chunk */
+    constexpr std::size_t ChunkSize = 64;
+    std::vector<std::vector<std::pair<AbstractShape<dimensions>*, AbstractShape<dimensions>*>>> chunks((this->size() + ChunkSize - 1)/ChunkSize);
+    auto job = [this, &other, &chunks](std::size_t begin, std::size_t end) {
+        std::vector<std::pair<AbstractShape<dimensions>*, AbstractShape<dimensions>*>>& out = chunks[begin/ChunkSize];
+        std::vector<UnsignedInt> candidates;
+        for(std::size_t i = begin; i != end; ++i) {
+            candidates.clear();
+            other.collectCandidates(_bounds[i], candidates);
+            for(UnsignedInt j: candidates)
+                if((*this)[i].collides(other[j]))
+                    out.emplace_back(&(*this)[i], &other[j]);
+        }
+    };
+
+    if(pool) pool->parallelFor(this->size(), ChunkSize, job);
+    else for(std::size_t begin = 0; begin < this->size(); begin += ChunkSize)
+        job(begin, std::min(begin + ChunkSize, this->size()));
+
+    /* Concatenate the results in order */
+    std::size_t count = 0;
+    for(const auto& chunk: chunks) count += chunk.size();
+    std::vector<std::pair<AbstractShape<dimensions>*, AbstractShape<dimensions>*>> out;
+    out.reserve(count);
+    for(const auto& chunk: chunks) out.insert(out.end(), chunk.begin(), chunk.end());
+    return out;
+}
+
+template<UnsignedInt dimensions> void ShapeGroup<dimensions>::collectRaycastCandidates(const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction, const Float maxDistance, std::vector<std::pair<Float, UnsignedInt>>& out) const {
+    /* Only shapes starting before the ray ends along the sorted axis can be
+       hit */
+    Float rayMax = origin[_axis];
+    if(direction[_axis] > 0.0f) rayMax += direction[_axis]*maxDistance;
+    const std::size_t end = std::upper_bound(_order.begin(), _order.end(), rayMax, [this](Float value, UnsignedInt i) {
+        return value < _bounds[i].min()[_axis];
+    }) - _order.begin();
+
+    for(std::size_t i = 0; i != end; ++i) {
+        const Float distance = rayBounds<dimensions>(origin, direction, _bounds[_order[i]]);
+        if(distance <= maxDistance) out.emplace_back(distance, _order[i]);
+    }
+
+    /* Nearest bounds first */
+    std::sort(out.begin(), out.end());
+}
+
+template<UnsignedInt dimensions> RaycastHit<dimensions> ShapeGroup<dimensions>::raycast(const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction, const Float maxDistance) {
+    CORRADE_ASSERT(direction.dot() != 0.0f,
+        "Shapes::ShapeGroup::raycast(): zero direction", {});
+
+    setClean();
+
+    const VectorTypeFor<dimensions, Float> normalizedDirection = direction.normalized();
+    std::vector<std::pair<Float, UnsignedInt>> candidates;
+    collectRaycastCandidates(origin, normalizedDirection, maxDistance, candidates);
+
+    /* Shapes can't be hit closer than their bounds, so the search can stop
+       once the bounds are farther than the nearest hit */
+    RaycastHit<dimensions> hit;
+    for(const std::pair<Float, UnsignedInt>& candidate: candidates) {
+        if(candidate.first > hit.distance()) break;
+
+        VectorTypeFor<dimensions, Float> normal;
+        AbstractShape<dimensions>& shape = (*this)[candidate.second];
+        const Float distance = Implementation::getAbstractShape(shape).raycast(origin, normalizedDirection, normal);
+        if(distance <= maxDistance && distance < hit.distance())
+            hit = RaycastHit<dimensions>{shape, origin + normalizedDirection*distance, normal, distance};
+    }
+
+    return hit;
+}
+
+template<UnsignedInt dimensions> std::vector<RaycastHit<dimensions>> ShapeGroup<dimensions>::raycastAll(const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction, const Float maxDistance) {
+    CORRADE_ASSERT(direction.dot() != 0.0f,
+        "Shapes::ShapeGroup::raycastAll(): zero direction", {});
+
+    setClean();
+
+    const VectorTypeFor<dimensions, Float> normalizedDirection = direction.normalized();
+    std::vector<std::pair<Float, UnsignedInt>> candidates;
+    collectRaycastCandidates(origin, normalizedDirection, maxDistance, candidates);
+
+    std::vector<std::pair<std::pair<Float, UnsignedInt>, VectorTypeFor<dimensions, Float>>> hits;
+    for(const std::pair<Float, UnsignedInt>& candidate: candidates) {
+        VectorTypeFor<dimensions, Float> normal;
+        const Float distance = Implementation::getAbstractShape((*this)[candidate.second]).raycast(origin, normalizedDirection, normal);
+        if(distance <= maxDistance)
+            hits.push_back({{distance, candidate.second}, normal});
+    }
+
+    std::sort(hits.begin(), hits.end(), [](const std::pair<std::pair<Float, UnsignedInt>, VectorTypeFor<dimensions, Float>>& a, const std::pair<std::pair<Float, UnsignedInt>, VectorTypeFor<dimensions, Float>>& b) {
+        return a.first < b.first;
+    });
+
+    std::vector<RaycastHit<dimensions>> out;
+    out.reserve(hits.size());
+    for(const std::pair<std::pair<Float, UnsignedInt>, VectorTypeFor<dimensions, Float>>& hit: hits)
+        out.emplace_back((*this)[hit.first.second], origin + normalizedDirection*hit.first.first, hit.second, hit.first.first);
+    return out;
+}
+
 #ifndef DOXYGEN_GENERATING_OUTPUT
+template<UnsignedInt dimensions> std::vector<UnsignedInt> ShapeGroup<dimensions>::occluderCounts(const VectorTypeFor<dimensions, Float>& origin, const std::vector<VectorTypeFor<dimensions, Float>>& targets) {
+    return occluderCountsInternal(origin, targets, nullptr);
+}
+
+template<UnsignedInt dimensions> std::vector<UnsignedInt> ShapeGroup<dimensions>::occluderCounts(const VectorTypeFor<dimensions, Float>& origin, const std::vector<VectorTypeFor<dimensions, Float>>& targets, ThreadPool& pool) {
+    return occluderCountsInternal(origin, targets, &pool);
+}
+
+template<UnsignedInt dimensions> std::vector<UnsignedInt> ShapeGroup<dimensions>::occluderCountsInternal(const VectorTypeFor<dimensions, Float>& origin, const std::vector<VectorTypeFor<dimensions, Float>>& targets, ThreadPool* const pool) {
+    /* Cleaning touches the objects, do it only once and before going
+       parallel */
+    setCleanInternal(pool);
+
+    std::vector<UnsignedInt> counts(targets.size());
+    auto job = [this, &origin, &targets, &counts](std::size_t begin, std::size_t end) {
+        std::vector<std::pair<Float, UnsignedInt>> candidates;
+        for(std::size_t i = begin; i != end; ++i) {
+            const VectorTypeFor<dimensions, Float> direction = targets[i] - origin;
+            const Float length = direction.length();
+            if(length == 0.0f) continue;
+
+            const VectorTypeFor<dimensions, Float> normalizedDirection = direction/length;
+            candidates.clear();
+            collectRaycastCandidates(origin, normalizedDirection, length, candidates);
+
+            /* Hits at zero distance are shapes containing the origin */
+            UnsignedInt count = 0;
+            for(const std::pair<Float, UnsignedInt>& candidate: candidates) {
+                VectorTypeFor<dimensions, Float> normal;
+                const Float distance = Implementation::getAbstractShape((*this)[candidate.second]).raycast(origin, normalizedDirection, normal);
+                if(distance > 0.0f && distance < length) ++count;
+            }
+            counts[i] = count;
+        }
+    };
+
+    constexpr std::size_t ChunkSize = 16;
+    if(pool) pool->parallelFor(targets.size(), ChunkSize, job);
+    else job(0, targets.size());
+
+    return counts;
+}
+
 template class MAGNUM_SHAPES_EXPORT ShapeGroup<2>;
 template class MAGNUM_SHAPES_EXPORT ShapeGroup<3>;
 #endif
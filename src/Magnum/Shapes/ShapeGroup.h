@@ -29,10 +29,15 @@
  * @brief Class @ref Magnum::Shapes::ShapeGroup, typedef @ref Magnum::Shapes::ShapeGroup2D, @ref Magnum::Shapes::ShapeGroup3D
  */
 
+#include <utility>
 #include <vector>
 
+#include "Magnum/DimensionTraits.h"
+#include "Magnum/ThreadPool.h"
+#include "Magnum/Math/Range.h"
 #include "Magnum/SceneGraph/FeatureGroup.h"
 #include "Magnum/Shapes/AbstractShape.h"
+#include "Magnum/Shapes/RaycastHit.h"
 #include "Magnum/Shapes/visibility.h"
 
 namespace Magnum { namespace Shapes {
@@ -41,6 +46,50 @@ namespace Magnum { namespace Shapes {
 @brief Group of shapes
 
 See @ref Shape for more information. See @ref shapes for brief introduction.
+
+@section Shapes-ShapeGroup-broad-phase Broad phase
+
+Testing all shapes against each other is expensive for large groups, so the
+group maintains axis-aligned bounds of all transformed shapes sorted along one
+axis (sweep and prune). The bounds are updated in @ref setClean() and only
+shapes with overlapping bounds are tested for collision in
+@ref firstCollision() and @ref allCollisions(). Shapes that are not bounded
+(such as @ref Line, @ref Plane, @ref Cylinder or @ref InvertedSphere) are
+treated as overlapping with everything.
+
+The group keeps track of shapes that moved since the last @ref setClean(), so
+in a mostly static scene only the moved shapes are cleaned and only their
+bounds get updated and moved to the new place in the sorted order. All shapes
+are updated only after the group itself changes or after an explicit
+@ref setDirty() call.
+
+@code{.cpp}
+for(auto&& pair: shapes.allCollisions()) {
+    // resolve collision of pair.first and pair.second
+}
+@endcode
+
+@section Shapes-ShapeGroup-parallel Parallel collision detection
+
+Once the broad phase has found the candidate pairs, testing the pairs for
+collision is independent of each other. The
+@ref allCollisions(ThreadPool&) overload distributes the tests over threads
+of a @ref ThreadPool, which can be the same pool that's used for other
+per-frame work, such as @ref SceneGraph::AnimableGroup::step(Float, Float, ThreadPool&, ThreadPool::Schedule).
+The same is possible for collisions between shapes of two different groups
+with @ref allCollisions(ShapeGroup<dimensions>&, ThreadPool&). The groups are
+cleaned on the calling thread before the parallel part, each job collects
+results into its own buffer and the buffers are concatenated in order at the
+end, so the result is the same as with the serial versions.
+
+The broad phase is used also for @ref raycast() and @ref raycastAll(). Only
+shapes with bounds hit by the ray are tested and they are tested in order of
+distance to their bounds, so the nearest hit can be found without testing
+shapes that are farther away. For many segments from a single point, such as
+occlusion tests from a camera or a listener, use @ref occluderCounts(), which
+cleans the group only once and can distribute the segments over a
+@ref ThreadPool.
+
 @see @ref scenegraph, @ref ShapeGroup2D, @ref ShapeGroup3D
 */
 template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT ShapeGroup: public SceneGraph::FeatureGroup<dimensions, AbstractShape<dimensions>, Float> {
@@ -52,7 +101,7 @@ template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT ShapeGroup: public S
          *
          * Marks the group as dirty.
          */
-        explicit ShapeGroup(): dirty(true) {}
+        explicit ShapeGroup(): dirty(true), _rebuild(true), _axis(0) {}
 
         /**
          * @brief Whether the group is dirty
@@ -65,30 +114,177 @@ template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT ShapeGroup: public S
          *
          * If some body in the group changes its transformation, it sets dirty
          * status also on the group to indicate that the body and maybe also
-         * group state needs to be cleaned before computing collisions.
+         * group state needs to be cleaned before computing collisions. Calling
+         * this function explicitly causes all shapes to be updated in the
+         * next @ref setClean(), not just the ones that moved.
          * @see @ref setClean()
          */
-        void setDirty() { dirty = true; }
+        void setDirty() { dirty = _rebuild = true; }
+
+        /**
+         * @brief Add shape to the group
+         * @return Reference to self (for method chaining)
+         *
+         * Marks the group as dirty.
+         * @see @ref SceneGraph::FeatureGroup::add()
+         */
+        ShapeGroup<dimensions>& add(AbstractShape<dimensions>& shape);
+
+        /**
+         * @brief Remove shape from the group
+         * @return Reference to self (for method chaining)
+         *
+         * Marks the group as dirty.
+         * @see @ref SceneGraph::FeatureGroup::remove()
+         */
+        ShapeGroup<dimensions>& remove(AbstractShape<dimensions>& shape);
 
         /**
          * @brief Set the group and all bodies as clean
          *
          * This function is called before computing any collisions to ensure
-         * all objects are cleaned.
+         * all objects are cleaned. If the group was dirty, also updates the
+         * @ref Shapes-ShapeGroup-broad-phase "broad phase". If only some
+         * shapes moved since the last call, only objects of these are cleaned
+         * and only these are updated in the broad phase.
+         */
+        void setClean() { setCleanInternal(nullptr); }
+
+        /**
+         * @brief Set the group and all bodies as clean, computing the transformations in parallel
+         *
+         * Same as @ref setClean(), but the absolute transformations of the
+         * objects are computed on @p pool using the parallel
+         * @ref SceneGraph::AbstractObject::setClean() overload. Features are
+         * cleaned serially on the calling thread.
          */
-        void setClean();
+        void setClean(ThreadPool& pool) { setCleanInternal(&pool); }
 
         /**
          * @brief First collision of given shape with other shapes in the group
          *
-         * Returns first shape colliding with given one. If there aren't any
-         * collisions, returns @cpp nullptr @ce. Calls @ref setClean() before
-         * the operation.
+         * Returns first shape in the group colliding with given one. If there
+         * aren't any collisions, returns @cpp nullptr @ce. Calls
+         * @ref setClean() before the operation, only shapes with bounds
+         * overlapping the bounds of @p shape are tested.
          */
         AbstractShape<dimensions>* firstCollision(const AbstractShape<dimensions>& shape);
 
+        /**
+         * @brief Collision candidates
+         *
+         * Returns all pairs of shapes in the group with overlapping bounds,
+         * ordered by position of the shapes in the group, with the first
+         * shape of each pair being before the second. Calls @ref setClean()
+         * before the operation. The pairs don't necessarily collide, use
+         * @ref allCollisions() to get only the colliding ones.
+         */
+        std::vector<std::pair<AbstractShape<dimensions>*, AbstractShape<dimensions>*>> collisionCandidates();
+
+        /**
+         * @brief All collisions in the group
+         *
+         * Same as @ref collisionCandidates(), but returns only pairs that
+         * actually collide.
+         */
+        std::vector<std::pair<AbstractShape<dimensions>*, AbstractShape<dimensions>*>> allCollisions();
+
+        /**
+         * @brief All collisions in the group computed in parallel
+         *
+         * Same as @ref allCollisions(), but the candidate pairs are tested
+         * for collision concurrently using @ref ThreadPool::parallelFor().
+         * See @ref Shapes-ShapeGroup-parallel for more information.
+         */
+        std::vector<std::pair<AbstractShape<dimensions>*, AbstractShape<dimensions>*>> allCollisions(ThreadPool& pool);
+
+        /**
+         * @brief All collisions with shapes in another group
+         *
+         * Returns all pairs of colliding shapes where the first shape is from
+         * this group and the second from @p other, ordered by position of the
+         * first and then the second shape in their groups. Calls
+         * @ref setClean() on both groups before the operation, only shapes
+         * with overlapping bounds are tested. Expects that @p other is not
+         * this group, use @ref allCollisions() for that.
+         */
+        std::vector<std::pair<AbstractShape<dimensions>*, AbstractShape<dimensions>*>> allCollisions(ShapeGroup<dimensions>& other);
+
+        /**
+         * @brief All collisions with shapes in another group computed in parallel
+         *
+         * Same as @ref allCollisions(ShapeGroup<dimensions>&), but shapes of
+         * this group are distributed over threads using
+         * @ref ThreadPool::parallelFor(). See @ref Shapes-ShapeGroup-parallel
+         * for more information.
+         */
+        std::vector<std::pair<AbstractShape<dimensions>*, AbstractShape<dimensions>*>> allCollisions(ShapeGroup<dimensions>& other, ThreadPool& pool);
+
+        /**
+         * @brief Nearest shape hit by a ray
+         * @param origin        Ray origin
+         * @param direction     Ray direction. Doesn't need to be normalized,
+         *      but expected to be non-zero.
+         * @param maxDistance   Max distance along the ray
+         *
+         * Returns the nearest hit not farther than @p maxDistance in units of
+         * normalized @p direction. If no shape was hit, the returned hit
+         * evaluates to @cpp false @ce. Calls @ref setClean() before the
+         * operation. Points and lines in 3D are never hit, for compositions
+         * only points where the ray enters their subshapes are considered.
+         */
+        RaycastHit<dimensions> raycast(const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction, Float maxDistance = Constants::inf());
+
+        /**
+         * @brief All shapes hit by a ray
+         *
+         * Same as @ref raycast(), but returns hits of all shapes, sorted by
+         * distance. Hits with same distance are ordered by position of the
+         * shapes in the group.
+         */
+        std::vector<RaycastHit<dimensions>> raycastAll(const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction, Float maxDistance = Constants::inf());
+
+        /**
+         * @brief Count of shapes between a point and a list of targets
+         *
+         * For each of @p targets returns count of shapes hit by a line
+         * segment from @p origin to the target, useful for batched
+         * visibility or occlusion tests. Shapes containing @p origin are not
+         * counted, shapes containing the target are. Calls @ref setClean()
+         * once before the operation, the segments are then tested using the
+         * same broad phase as @ref raycast().
+         */
+        std::vector<UnsignedInt> occluderCounts(const VectorTypeFor<dimensions, Float>& origin, const std::vector<VectorTypeFor<dimensions, Float>>& targets);
+
+        /**
+         * @brief Count of shapes between a point and a list of targets computed in parallel
+         *
+         * Same as @ref occluderCounts(const VectorTypeFor<dimensions, Float>&, const std::vector<VectorTypeFor<dimensions, Float>>&),
+         * but the targets are distributed over threads using
+         * @ref ThreadPool::parallelFor(). See @ref Shapes-ShapeGroup-parallel
+         * for more information.
+         */
+        std::vector<UnsignedInt> occluderCounts(const VectorTypeFor<dimensions, Float>& origin, const std::vector<VectorTypeFor<dimensions, Float>>& targets, ThreadPool& pool);
+
     private:
-        bool dirty;
+        void markMoved(AbstractShape<dimensions>& shape);
+        void setCleanInternal(ThreadPool* pool);
+        void updateBroadPhase();
+        void updateBroadPhase(UnsignedInt index);
+        void collectCandidates(std::vector<std::pair<UnsignedInt, UnsignedInt>>& out) const;
+        void collectCandidates(const RangeTypeFor<dimensions, Float>& bounds, std::vector<UnsignedInt>& out) const;
+        std::vector<std::pair<AbstractShape<dimensions>*, AbstractShape<dimensions>*>> allCollisionsInternal(ShapeGroup<dimensions>& other, ThreadPool* pool);
+        void collectRaycastCandidates(const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction, Float maxDistance, std::vector<std::pair<Float, UnsignedInt>>& out) const;
+        std::vector<UnsignedInt> occluderCountsInternal(const VectorTypeFor<dimensions, Float>& origin, const std::vector<VectorTypeFor<dimensions, Float>>& targets, ThreadPool* pool);
+
+        bool dirty, _rebuild;
+        UnsignedInt _axis;
+        std::vector<AbstractShape<dimensions>*> _moved;
+        std::vector<RangeTypeFor<dimensions, Float>> _bounds;
+        std::vector<UnsignedInt> _order, _orderPosition;
+
+        /* Scratch storage for firstCollision() */
+        std::vector<UnsignedInt> _candidates;
 };
 
 /**
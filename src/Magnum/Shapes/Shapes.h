@@ -70,6 +70,10 @@ template<UnsignedInt> class LineSegment;
 typedef LineSegment<2> LineSegment2D;
 typedef LineSegment<3> LineSegment3D;
 
+template<UnsignedInt> class RaycastHit;
+typedef RaycastHit<2> RaycastHit2D;
+typedef RaycastHit<3> RaycastHit3D;
+
 template<class> class Shape;
 
 template<UnsignedInt> class ShapeGroup;
@@ -80,6 +84,10 @@ template<UnsignedInt> class Sphere;
 typedef Sphere<2> Sphere2D;
 typedef Sphere<3> Sphere3D;
 
+template<UnsignedInt> class SphereBatch;
+typedef SphereBatch<2> SphereBatch2D;
+typedef SphereBatch<3> SphereBatch3D;
+
 template<UnsignedInt> class InvertedSphere;
 typedef InvertedSphere<2> InvertedSphere2D;
 typedef InvertedSphere<3> InvertedSphere3D;
@@ -89,6 +97,10 @@ class Plane;
 template<UnsignedInt> class Point;
 typedef Point<2> Point2D;
 typedef Point<3> Point3D;
+
+template<UnsignedInt> class PointBatch;
+typedef PointBatch<2> PointBatch2D;
+typedef PointBatch<3> PointBatch3D;
 #endif
 
 }}
@@ -95,6 +95,43 @@ template<UnsignedInt dimensions> bool Sphere<dimensions>::operator%(const LineSe
     return Distance::lineSegmentPointSquared(other.a(), other.b(), _position) < Math::pow<2>(_radius);
 }
 
+namespace {
+
+/* Collision of a sphere with the closest point on some other shape */
+template<UnsignedInt dimensions> Collision<dimensions> sphereClosestPointCollision(const VectorTypeFor<dimensions, Float>& position, const Float radius, const VectorTypeFor<dimensions, Float>& closest) {
+    const VectorTypeFor<dimensions, Float> separating = position - closest;
+    const Float dot = separating.dot();
+
+    /* No collision occured */
+    if(dot > Math::pow<2>(radius)) return {};
+
+    /* Actual distance from the center */
+    const Float distance = Math::sqrt(dot);
+
+    /* Separating normal. If can't decide on direction, just move up. */
+    const VectorTypeFor<dimensions, Float> separatingNormal =
+        Math::TypeTraits<Float>::equals(dot, 0.0f) ?
+        VectorTypeFor<dimensions, Float>::yAxis() :
+        separating/distance;
+
+    /* Collision position is on the closest point */
+    return Collision<dimensions>(closest, separatingNormal, radius - distance);
+}
+
+}
+
+template<UnsignedInt dimensions> Collision<dimensions> Sphere<dimensions>::operator/(const Line<dimensions>& other) const {
+    const VectorTypeFor<dimensions, Float> direction = other.b() - other.a();
+    const Float t = Math::dot(_position - other.a(), direction)/direction.dot();
+    return sphereClosestPointCollision<dimensions>(_position, _radius, other.a() + direction*t);
+}
+
+template<UnsignedInt dimensions> Collision<dimensions> Sphere<dimensions>::operator/(const LineSegment<dimensions>& other) const {
+    const VectorTypeFor<dimensions, Float> direction = other.b() - other.a();
+    const Float t = Math::clamp(Math::dot(_position - other.a(), direction)/direction.dot(), 0.0f, 1.0f);
+    return sphereClosestPointCollision<dimensions>(_position, _radius, other.a() + direction*t);
+}
+
 template<UnsignedInt dimensions> bool Sphere<dimensions>::operator%(const Sphere<dimensions>& other) const {
     return (_position - other._position).dot() < Math::pow<2>(_radius + other._radius);
 }
@@ -65,6 +65,16 @@ template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT Sphere {
         /** @brief Transformed shape */
         Sphere<dimensions> transformed(const MatrixTypeFor<dimensions, Float>& matrix) const;
 
+        /**
+         * @brief Translated shape
+         *
+         * Cheaper alternative to @ref transformed() for translation-only
+         * transformations.
+         */
+        Sphere<dimensions> translated(const VectorTypeFor<dimensions, Float>& translation) const {
+            return Sphere<dimensions>(_position + translation, _radius);
+        }
+
         /** @brief Position */
         constexpr VectorTypeFor<dimensions, Float> position() const {
             return _position;
@@ -90,9 +100,25 @@ template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT Sphere {
         /** @brief Collision occurence with line */
         bool operator%(const Line<dimensions>& other) const;
 
+        /**
+         * @brief Collision with line
+         *
+         * Contact position is the point on the line closest to the sphere
+         * center.
+         */
+        Collision<dimensions> operator/(const Line<dimensions>& other) const;
+
         /** @brief Collision occurence with line segment */
         bool operator%(const LineSegment<dimensions>& other) const;
 
+        /**
+         * @brief Collision with line segment
+         *
+         * Contact position is the point on the line segment closest to the
+         * sphere center.
+         */
+        Collision<dimensions> operator/(const LineSegment<dimensions>& other) const;
+
         /** @brief Collision occurence with sphere */
         bool operator%(const Sphere<dimensions>& other) const;
 
@@ -142,6 +168,16 @@ template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT InvertedSphere:
             return Sphere<dimensions>::transformed(matrix);
         }
 
+        /**
+         * @brief Translated shape
+         *
+         * Cheaper alternative to @ref transformed() for translation-only
+         * transformations.
+         */
+        InvertedSphere<dimensions> translated(const VectorTypeFor<dimensions, Float>& translation) const {
+            return Sphere<dimensions>::translated(translation);
+        }
+
         using Sphere<dimensions>::position;
         using Sphere<dimensions>::setPosition;
         using Sphere<dimensions>::radius;
@@ -184,9 +220,15 @@ template<UnsignedInt dimensions> inline Collision<dimensions> operator/(const Po
 /** @collisionoccurenceoperator{Line,Sphere} */
 template<UnsignedInt dimensions> inline bool operator%(const Line<dimensions>& a, const Sphere<dimensions>& b) { return b % a; }
 
+/** @collisionoperator{Line,Sphere} */
+template<UnsignedInt dimensions> inline Collision<dimensions> operator/(const Line<dimensions>& a, const Sphere<dimensions>& b) { return (b/a).flipped(); }
+
 /** @collisionoccurenceoperator{LineSegment,Sphere} */
 template<UnsignedInt dimensions> inline bool operator%(const LineSegment<dimensions>& a, const Sphere<dimensions>& b) { return b % a; }
 
+/** @collisionoperator{LineSegment,Sphere} */
+template<UnsignedInt dimensions> inline Collision<dimensions> operator/(const LineSegment<dimensions>& a, const Sphere<dimensions>& b) { return (b/a).flipped(); }
+
 /** @collisionoccurenceoperator{Sphere,InvertedSphere} */
 template<UnsignedInt dimensions> inline bool operator%(const Sphere<dimensions>& a, const InvertedSphere<dimensions>& b) { return b % a; }
 
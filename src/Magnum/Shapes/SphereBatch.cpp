@@ -0,0 +1,125 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "SphereBatch.h"
+
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Shapes/Point.h"
+#include "Magnum/Shapes/Sphere.h"
+#include "Magnum/Shapes/Implementation/BatchMask.h"
+
+namespace Magnum { namespace Shapes {
+
+template<UnsignedInt dimensions> SphereBatch<dimensions>::SphereBatch() = default;
+
+template<UnsignedInt dimensions> std::size_t SphereBatch<dimensions>::maskSize() const {
+    return Implementation::batchMaskSize(size());
+}
+
+template<UnsignedInt dimensions> const std::vector<Float>& SphereBatch<dimensions>::coordinates(const UnsignedInt dimension) const {
+    CORRADE_ASSERT(dimension < dimensions,
+        "Shapes::SphereBatch::coordinates(): dimension" << dimension << "out of range for" << dimensions << "dimensions", _coordinates[0]);
+    return _coordinates[dimension];
+}
+
+template<UnsignedInt dimensions> Sphere<dimensions> SphereBatch<dimensions>::sphere(const std::size_t i) const {
+    CORRADE_ASSERT(i < size(),
+        "Shapes::SphereBatch::sphere(): index" << i << "out of range for" << size() << "spheres", {});
+    VectorTypeFor<dimensions, Float> position;
+    for(UnsignedInt d = 0; d != dimensions; ++d)
+        position[d] = _coordinates[d][i];
+    return {position, _radii[i]};
+}
+
+template<UnsignedInt dimensions> SphereBatch<dimensions>& SphereBatch<dimensions>::setSphere(const std::size_t i, const Sphere<dimensions>& sphere) {
+    CORRADE_ASSERT(i < size(),
+        "Shapes::SphereBatch::setSphere(): index" << i << "out of range for" << size() << "spheres", *this);
+    for(UnsignedInt d = 0; d != dimensions; ++d)
+        _coordinates[d][i] = sphere.position()[d];
+    _radii[i] = sphere.radius();
+    return *this;
+}
+
+template<UnsignedInt dimensions> SphereBatch<dimensions>& SphereBatch<dimensions>::add(const Sphere<dimensions>& sphere) {
+    for(UnsignedInt d = 0; d != dimensions; ++d)
+        _coordinates[d].push_back(sphere.position()[d]);
+    _radii.push_back(sphere.radius());
+    return *this;
+}
+
+template<UnsignedInt dimensions> SphereBatch<dimensions>& SphereBatch<dimensions>::clear() {
+    for(std::vector<Float>& coordinates: _coordinates)
+        coordinates.clear();
+    _radii.clear();
+    return *this;
+}
+
+template<UnsignedInt dimensions> void SphereBatch<dimensions>::collisionMask(const VectorTypeFor<dimensions, Float>& position, const Float radius, const Containers::ArrayView<UnsignedInt> mask) const {
+    CORRADE_ASSERT(mask.size() >= maskSize(),
+        "Shapes::SphereBatch::collisionMask(): expected at least" << maskSize() << "words but got" << mask.size(), );
+
+    Implementation::batchMask(size(), mask, [&](const std::size_t begin, const std::size_t end, UnsignedByte* const hits) {
+        Float distancesSquared[Implementation::BatchBlockSize]{};
+        for(UnsignedInt d = 0; d != dimensions; ++d) {
+            const Float* const coordinates = _coordinates[d].data() + begin;
+            const Float p = position[d];
+            for(std::size_t i = 0; i != end - begin; ++i)
+                distancesSquared[i] += Math::pow<2>(coordinates[i] - p);
+        }
+
+        const Float* const radii = _radii.data() + begin;
+        for(std::size_t i = 0; i != end - begin; ++i)
+            hits[i] = distancesSquared[i] < Math::pow<2>(radii[i] + radius);
+    });
+}
+
+template<UnsignedInt dimensions> void SphereBatch<dimensions>::collisionMask(const Point<dimensions>& point, const Containers::ArrayView<UnsignedInt> mask) const {
+    collisionMask(point.position(), 0.0f, mask);
+}
+
+template<UnsignedInt dimensions> void SphereBatch<dimensions>::collisionMask(const Sphere<dimensions>& sphere, const Containers::ArrayView<UnsignedInt> mask) const {
+    collisionMask(sphere.position(), sphere.radius(), mask);
+}
+
+template<UnsignedInt dimensions> std::vector<UnsignedInt> SphereBatch<dimensions>::collisions(const Point<dimensions>& point) const {
+    std::vector<UnsignedInt> mask(maskSize());
+    collisionMask(point, {mask.data(), mask.size()});
+    return Implementation::batchMaskIndices({mask.data(), mask.size()});
+}
+
+template<UnsignedInt dimensions> std::vector<UnsignedInt> SphereBatch<dimensions>::collisions(const Sphere<dimensions>& sphere) const {
+    std::vector<UnsignedInt> mask(maskSize());
+    collisionMask(sphere, {mask.data(), mask.size()});
+    return Implementation::batchMaskIndices({mask.data(), mask.size()});
+}
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+template class MAGNUM_SHAPES_EXPORT SphereBatch<2>;
+template class MAGNUM_SHAPES_EXPORT SphereBatch<3>;
+#endif
+
+}}
@@ -0,0 +1,176 @@
+#ifndef Magnum_Shapes_SphereBatch_h
+#define Magnum_Shapes_SphereBatch_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Shapes::SphereBatch, typedef @ref Magnum::Shapes::SphereBatch2D, @ref Magnum::Shapes::SphereBatch3D
+ */
+
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/DimensionTraits.h"
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/Shapes/Shapes.h"
+#include "Magnum/Shapes/visibility.h"
+
+namespace Magnum { namespace Shapes {
+
+/**
+@brief Batch of spheres
+
+Stores positions and radii of many spheres in a structure-of-arrays layout and
+tests all of them against one shape at once, similarly to @ref PointBatch. The
+result is the same as testing each @ref Sphere separately with
+@ref Sphere::operator%(const Point<dimensions>&) const "Sphere::operator%()".
+
+@code{.cpp}
+Shapes::SphereBatch3D triggers;
+for(const Trigger& trigger: level.triggers)
+    triggers.add({trigger.position, trigger.radius});
+
+for(UnsignedInt i: triggers.collisions(Shapes::Sphere3D{player.position(), 0.5f})) {
+    // player is inside trigger i
+}
+@endcode
+
+See @ref shapes for brief introduction.
+@see @ref SphereBatch2D, @ref SphereBatch3D
+*/
+template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT SphereBatch {
+    public:
+        enum: UnsignedInt {
+            Dimensions = dimensions /**< Dimension count */
+        };
+
+        /**
+         * @brief Default constructor
+         *
+         * Creates an empty batch.
+         */
+        explicit SphereBatch();
+
+        /** @brief Count of spheres in the batch */
+        std::size_t size() const { return _radii.size(); }
+
+        /** @brief Whether the batch is empty */
+        bool isEmpty() const { return _radii.empty(); }
+
+        /**
+         * @brief Size of the collision mask
+         *
+         * Count of 32-bit words needed for the collision mask, see
+         * @ref collisionMask().
+         */
+        std::size_t maskSize() const;
+
+        /**
+         * @brief Center coordinates of all spheres
+         *
+         * Contiguous array of @p dimension -th coordinate of all sphere
+         * centers. Expects that @p dimension is less than @ref Dimensions.
+         */
+        const std::vector<Float>& coordinates(UnsignedInt dimension) const;
+
+        /** @brief Radii of all spheres */
+        const std::vector<Float>& radii() const { return _radii; }
+
+        /** @brief Sphere at given index */
+        Sphere<dimensions> sphere(std::size_t i) const;
+
+        /**
+         * @brief Set sphere at given index
+         * @return Reference to self (for method chaining)
+         */
+        SphereBatch<dimensions>& setSphere(std::size_t i, const Sphere<dimensions>& sphere);
+
+        /**
+         * @brief Add sphere to the batch
+         * @return Reference to self (for method chaining)
+         */
+        SphereBatch<dimensions>& add(const Sphere<dimensions>& sphere);
+
+        /**
+         * @brief Remove all spheres from the batch
+         * @return Reference to self (for method chaining)
+         */
+        SphereBatch<dimensions>& clear();
+
+        /**
+         * @brief Collision mask with a point
+         *
+         * Sets bit @cpp i % 32 @ce of word @cpp i / 32 @ce of @p mask if
+         * @p point is inside sphere @cpp i @ce, unused bits of the last word
+         * are cleared. Expects that the mask has at least @ref maskSize()
+         * words.
+         * @see @ref Sphere::operator%(const Point<dimensions>&) const
+         */
+        void collisionMask(const Point<dimensions>& point, Containers::ArrayView<UnsignedInt> mask) const;
+
+        /**
+         * @brief Collision mask with a sphere
+         *
+         * Same as @ref collisionMask(const Point<dimensions>&, Containers::ArrayView<UnsignedInt>) const,
+         * but for a sphere.
+         * @see @ref Sphere::operator%(const Sphere<dimensions>&) const
+         */
+        void collisionMask(const Sphere<dimensions>& sphere, Containers::ArrayView<UnsignedInt> mask) const;
+
+        /**
+         * @brief Spheres colliding with a point
+         *
+         * Returns indices of all spheres containing @p point in ascending
+         * order.
+         * @see @ref collisionMask()
+         */
+        std::vector<UnsignedInt> collisions(const Point<dimensions>& point) const;
+
+        /**
+         * @brief Spheres colliding with a sphere
+         *
+         * Returns indices of all spheres colliding with @p sphere in
+         * ascending order.
+         * @see @ref collisionMask()
+         */
+        std::vector<UnsignedInt> collisions(const Sphere<dimensions>& sphere) const;
+
+    private:
+        void collisionMask(const VectorTypeFor<dimensions, Float>& position, Float radius, Containers::ArrayView<UnsignedInt> mask) const;
+
+        std::vector<Float> _coordinates[dimensions];
+        std::vector<Float> _radii;
+};
+
+/** @brief Batch of two-dimensional spheres */
+typedef SphereBatch<2> SphereBatch2D;
+
+/** @brief Batch of three-dimensional spheres */
+typedef SphereBatch<3> SphereBatch3D;
+
+}}
+
+#endif
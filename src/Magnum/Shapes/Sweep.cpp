@@ -0,0 +1,350 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Sweep.h"
+
+#include <utility>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Geometry/Distance.h"
+#include "Magnum/Shapes/AxisAlignedBox.h"
+#include "Magnum/Shapes/Box.h"
+#include "Magnum/Shapes/Capsule.h"
+#include "Magnum/Shapes/LineSegment.h"
+#include "Magnum/Shapes/Plane.h"
+#include "Magnum/Shapes/Sphere.h"
+
+using namespace Magnum::Math::Geometry;
+
+namespace Magnum { namespace Shapes {
+
+namespace {
+
+/* First time in [0, 1] at which point moving from origin by direction is
+   inside given sphere */
+template<UnsignedInt dimensions> Float raySphere(const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction, const VectorTypeFor<dimensions, Float>& center, const Float radius) {
+    const VectorTypeFor<dimensions, Float> w = origin - center;
+    const Float c = w.dot() - radius*radius;
+    if(c <= 0.0f) return 0.0f;
+
+    /* Not moving or moving away */
+    const Float a = direction.dot();
+    const Float b = Math::dot(w, direction);
+    if(a == 0.0f || b >= 0.0f) return Constants::inf();
+
+    const Float discriminant = b*b - a*c;
+    if(discriminant < 0.0f) return Constants::inf();
+
+    const Float t = (-b - std::sqrt(discriminant))/a;
+    return t <= 1.0f ? t : Constants::inf();
+}
+
+/* First time in [0, 1] at which point moving from origin by direction is
+   inside given capsule */
+template<UnsignedInt dimensions> Float rayCapsule(const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction, const VectorTypeFor<dimensions, Float>& a, const VectorTypeFor<dimensions, Float>& b, const Float radius) {
+    if(Distance::lineSegmentPointSquared(a, b, origin) <= radius*radius)
+        return 0.0f;
+
+    /* Hemispherical caps */
+    Float t = Math::min(raySphere<dimensions>(origin, direction, a, radius),
+                        raySphere<dimensions>(origin, direction, b, radius));
+
+    /* Cylindrical part, solved in the subspace perpendicular to the axis */
+    const VectorTypeFor<dimensions, Float> m = b - a;
+    const Float mm = m.dot();
+    if(mm == 0.0f) return t;
+
+    const VectorTypeFor<dimensions, Float> w = origin - a;
+    const VectorTypeFor<dimensions, Float> wPerpendicular = w - m*(Math::dot(w, m)/mm);
+    const VectorTypeFor<dimensions, Float> directionPerpendicular = direction - m*(Math::dot(direction, m)/mm);
+    const Float qa = directionPerpendicular.dot();
+    const Float qb = Math::dot(wPerpendicular, directionPerpendicular);
+    const Float qc = wPerpendicular.dot() - radius*radius;
+    const Float discriminant = qb*qb - qa*qc;
+    if(qa == 0.0f || qb >= 0.0f || discriminant < 0.0f) return t;
+
+    const Float tc = (-qb - std::sqrt(discriminant))/qa;
+    const Float s = Math::dot(w + direction*tc, m)/mm;
+    if(tc >= 0.0f && tc <= 1.0f && s >= 0.0f && s <= 1.0f)
+        t = Math::min(t, tc);
+    return t;
+}
+
+/* Time of impact of an object with given signed distance from the plane and
+   given extent along the plane normal */
+Float planeTimeOfImpact(const Float distance, const Float extent, const Float velocity) {
+    if(Math::abs(distance) <= extent) return 0.0f;
+    if(velocity == 0.0f) return Constants::inf();
+
+    const Float t = ((distance > 0.0f ? extent : -extent) - distance)/velocity;
+    return t >= 0.0f && t <= 1.0f ? t : Constants::inf();
+}
+
+/* Separating axes of a Minkowski sum of zonotopes (i.e., centrally symmetric
+   polytopes described by a center and a set of generators, such as boxes or
+   line segments). In 2D these are normals of the generators, in 3D cross
+   products of each pair of them. */
+template<UnsignedInt> struct SeparatingAxes;
+template<> struct SeparatingAxes<2> {
+    template<class F> static bool forEach(const Vector2* const generators, const std::size_t count, F f) {
+        for(std::size_t i = 0; i != count; ++i) {
+            if(!f(generators[i].perpendicular())) return false;
+            /* Covers the case when all generators are parallel */
+            if(!f(generators[i])) return false;
+        }
+        return true;
+    }
+};
+template<> struct SeparatingAxes<3> {
+    template<class F> static bool forEach(const Vector3* const generators, const std::size_t count, F f) {
+        for(std::size_t i = 0; i != count; ++i)
+            for(std::size_t j = i + 1; j != count; ++j)
+                if(!f(Math::cross(generators[i], generators[j]))) return false;
+        return true;
+    }
+};
+
+/* Time of impact of two zonotopes, the first moving by given displacement.
+   On each separating axis the projections overlap in some time interval,
+   the shapes touch when all of them overlap. As the axes are face normals of
+   the Minkowski difference, this is exact. */
+template<UnsignedInt dimensions> Float zonotopeTimeOfImpact(const VectorTypeFor<dimensions, Float>& centerDifference, const VectorTypeFor<dimensions, Float>* const generators, const std::size_t generatorCount, const VectorTypeFor<dimensions, Float>& displacement) {
+    Float enter = -Constants::inf();
+    Float exit = Constants::inf();
+    const bool overlaps = SeparatingAxes<dimensions>::forEach(generators, generatorCount, [&](const VectorTypeFor<dimensions, Float>& axis) {
+        if(axis.dot() == 0.0f) return true;
+
+        const Float distance = Math::dot(axis, centerDifference);
+        const Float velocity = Math::dot(axis, displacement);
+        Float extent = 0.0f;
+        for(std::size_t i = 0; i != generatorCount; ++i)
+            extent += Math::abs(Math::dot(axis, generators[i]));
+
+        if(velocity == 0.0f) return Math::abs(distance) <= extent;
+
+        Float t0 = (distance - extent)/velocity;
+        Float t1 = (distance + extent)/velocity;
+        if(t0 > t1) std::swap(t0, t1);
+        enter = Math::max(enter, t0);
+        exit = Math::min(exit, t1);
+        return enter <= exit && enter <= 1.0f && exit >= 0.0f;
+    });
+
+    if(!overlaps) return Constants::inf();
+    return Math::max(enter, 0.0f);
+}
+
+template<UnsignedInt dimensions> Float pointAxisAlignedBoxDistanceSquared(const VectorTypeFor<dimensions, Float>& min, const VectorTypeFor<dimensions, Float>& max, const VectorTypeFor<dimensions, Float>& point) {
+    return (point - Math::clamp(point, min, max)).dot();
+}
+
+/* Distance to a convex shape is convex along the line segment, so it's
+   minimized using golden-section search */
+template<UnsignedInt dimensions> Float lineSegmentAxisAlignedBoxDistance(const VectorTypeFor<dimensions, Float>& min, const VectorTypeFor<dimensions, Float>& max, const VectorTypeFor<dimensions, Float>& a, const VectorTypeFor<dimensions, Float>& b) {
+    constexpr Float InverseGoldenRatio = 0.6180339887f;
+
+    const VectorTypeFor<dimensions, Float> direction = b - a;
+    Float begin = 0.0f, end = 1.0f;
+    Float s0 = end - (end - begin)*InverseGoldenRatio;
+    Float s1 = begin + (end - begin)*InverseGoldenRatio;
+    Float d0 = pointAxisAlignedBoxDistanceSquared<dimensions>(min, max, a + direction*s0);
+    Float d1 = pointAxisAlignedBoxDistanceSquared<dimensions>(min, max, a + direction*s1);
+    for(UnsignedInt i = 0; i != 32; ++i) {
+        if(d0 < d1) {
+            end = s1;
+            s1 = s0;
+            d1 = d0;
+            s0 = end - (end - begin)*InverseGoldenRatio;
+            d0 = pointAxisAlignedBoxDistanceSquared<dimensions>(min, max, a + direction*s0);
+        } else {
+            begin = s0;
+            s0 = s1;
+            d0 = d1;
+            s1 = begin + (end - begin)*InverseGoldenRatio;
+            d1 = pointAxisAlignedBoxDistanceSquared<dimensions>(min, max, a + direction*s1);
+        }
+    }
+
+    /* The endpoints are not covered by the search */
+    return std::sqrt(Math::min(Math::min(d0, d1), Math::min(
+        pointAxisAlignedBoxDistanceSquared<dimensions>(min, max, a),
+        pointAxisAlignedBoxDistanceSquared<dimensions>(min, max, b))));
+}
+
+}
+
+Float timeOfImpact(const Sphere3D& sphere, const Vector3& displacement, const Plane& plane) {
+    return planeTimeOfImpact(Math::dot(plane.normal(), sphere.position() - plane.position()),
+        sphere.radius()*plane.normal().length(),
+        Math::dot(plane.normal(), displacement));
+}
+
+template<UnsignedInt dimensions> Float timeOfImpact(const Sphere<dimensions>& sphere, const VectorTypeFor<dimensions, Float>& displacement, const LineSegment<dimensions>& segment) {
+    return rayCapsule<dimensions>(sphere.position(), displacement, segment.a(), segment.b(), sphere.radius());
+}
+
+template<UnsignedInt dimensions> Float timeOfImpact(const Sphere<dimensions>& sphere, const VectorTypeFor<dimensions, Float>& displacement, const Capsule<dimensions>& capsule) {
+    return rayCapsule<dimensions>(sphere.position(), displacement, capsule.a(), capsule.b(), sphere.radius() + capsule.radius());
+}
+
+template<UnsignedInt dimensions> Float timeOfImpact(const Sphere<dimensions>& sphere, const VectorTypeFor<dimensions, Float>& displacement, const Box<dimensions>& box) {
+    /* Transform the sphere center and displacement into box-local coordinate
+       system, which is orthonormal with the box axes scaled to unit length */
+    const auto rotationScaling = box.transformation().rotationScaling();
+    const VectorTypeFor<dimensions, Float> relative = sphere.position() - box.transformation().translation();
+    VectorTypeFor<dimensions, Float> origin, direction, halfSize;
+    for(UnsignedInt i = 0; i != dimensions; ++i) {
+        const VectorTypeFor<dimensions, Float> axis = rotationScaling[i];
+        halfSize[i] = axis.length();
+        origin[i] = Math::dot(relative, axis)/halfSize[i];
+        direction[i] = Math::dot(displacement, axis)/halfSize[i];
+    }
+
+    /* Intersect with the box expanded by sphere radius */
+    Float enter = 0.0f, exit = 1.0f;
+    for(UnsignedInt i = 0; i != dimensions; ++i) {
+        const Float extent = halfSize[i] + sphere.radius();
+        if(direction[i] == 0.0f) {
+            if(Math::abs(origin[i]) > extent) return Constants::inf();
+            continue;
+        }
+
+        Float t0 = (-extent - origin[i])/direction[i];
+        Float t1 = (extent - origin[i])/direction[i];
+        if(t0 > t1) std::swap(t0, t1);
+        enter = Math::max(enter, t0);
+        exit = Math::min(exit, t1);
+        if(enter > exit) return Constants::inf();
+    }
+
+    /* If the hit point is in a face region of the expanded box, it's the
+       correct hit. Otherwise it's near an edge or vertex, where the expanded
+       box is rounded. */
+    const VectorTypeFor<dimensions, Float> point = origin + direction*enter;
+    VectorTypeFor<dimensions, Float> corner;
+    UnsignedInt outsideCount = 0, insideAxis = 0;
+    for(UnsignedInt i = 0; i != dimensions; ++i) {
+        corner[i] = point[i] < 0.0f ? -halfSize[i] : halfSize[i];
+        if(Math::abs(point[i]) > halfSize[i]) ++outsideCount;
+        else insideAxis = i;
+    }
+    if(outsideCount <= 1) return enter;
+
+    /* Near a vertex, the closest feature is one of the edges going out of it */
+    if(outsideCount == dimensions) {
+        Float t = Constants::inf();
+        for(UnsignedInt i = 0; i != dimensions; ++i) {
+            VectorTypeFor<dimensions, Float> other = corner;
+            other[i] = -other[i];
+            t = Math::min(t, rayCapsule<dimensions>(origin, direction, corner, other, sphere.radius()));
+        }
+        return t;
+    }
+
+    /* Near an edge (3D only) */
+    VectorTypeFor<dimensions, Float> a = corner, b = corner;
+    a[insideAxis] = -halfSize[insideAxis];
+    b[insideAxis] = halfSize[insideAxis];
+    return rayCapsule<dimensions>(origin, direction, a, b, sphere.radius());
+}
+
+Float timeOfImpact(const AxisAlignedBox3D& box, const Vector3& displacement, const Plane& plane) {
+    const Vector3 halfSize = (box.max() - box.min())*0.5f;
+    return planeTimeOfImpact(Math::dot(plane.normal(), (box.min() + box.max())*0.5f - plane.position()),
+        Math::dot(Math::abs(plane.normal()), halfSize),
+        Math::dot(plane.normal(), displacement));
+}
+
+template<UnsignedInt dimensions> Float timeOfImpact(const AxisAlignedBox<dimensions>& box, const VectorTypeFor<dimensions, Float>& displacement, const LineSegment<dimensions>& segment) {
+    const VectorTypeFor<dimensions, Float> halfSize = (box.max() - box.min())*0.5f;
+    VectorTypeFor<dimensions, Float> generators[dimensions + 1];
+    for(UnsignedInt i = 0; i != dimensions; ++i)
+        generators[i][i] = halfSize[i];
+    generators[dimensions] = (segment.b() - segment.a())*0.5f;
+
+    return zonotopeTimeOfImpact<dimensions>((segment.a() + segment.b() - box.min() - box.max())*0.5f,
+        generators, dimensions + 1, displacement);
+}
+
+template<UnsignedInt dimensions> Float timeOfImpact(const AxisAlignedBox<dimensions>& box, const VectorTypeFor<dimensions, Float>& displacement, const Capsule<dimensions>& capsule) {
+    /* Conservative advancement --- the box can't get closer than its
+       distance to the capsule by moving by the same amount. As the distance
+       is convex in time, the box won't ever hit the capsule if it didn't get
+       closer in the last step. */
+    const Float speed = displacement.length();
+    Float t = 0.0f;
+    Float distance = lineSegmentAxisAlignedBoxDistance<dimensions>(box.min(), box.max(), capsule.a(), capsule.b()) - capsule.radius();
+    for(UnsignedInt i = 0; i != 32; ++i) {
+        if(distance <= 0.0f) return t;
+        if(speed == 0.0f) return Constants::inf();
+
+        const Float step = distance/speed;
+        if(step < 1.0e-5f) return t;
+
+        const Float next = t + step;
+        if(next > 1.0f) return Constants::inf();
+
+        const VectorTypeFor<dimensions, Float> offset = displacement*next;
+        const Float nextDistance = lineSegmentAxisAlignedBoxDistance<dimensions>(box.min() + offset, box.max() + offset, capsule.a(), capsule.b()) - capsule.radius();
+        if(nextDistance >= distance) return Constants::inf();
+
+        t = next;
+        distance = nextDistance;
+    }
+
+    return t;
+}
+
+template<UnsignedInt dimensions> Float timeOfImpact(const AxisAlignedBox<dimensions>& box, const VectorTypeFor<dimensions, Float>& displacement, const Box<dimensions>& other) {
+    const VectorTypeFor<dimensions, Float> halfSize = (box.max() - box.min())*0.5f;
+    const auto rotationScaling = other.transformation().rotationScaling();
+    VectorTypeFor<dimensions, Float> generators[dimensions*2];
+    for(UnsignedInt i = 0; i != dimensions; ++i) {
+        generators[i][i] = halfSize[i];
+        generators[dimensions + i] = rotationScaling[i];
+    }
+
+    return zonotopeTimeOfImpact<dimensions>(other.transformation().translation() - (box.min() + box.max())*0.5f,
+        generators, dimensions*2, displacement);
+}
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+template MAGNUM_SHAPES_EXPORT Float timeOfImpact(const Sphere2D&, const Vector2&, const LineSegment2D&);
+template MAGNUM_SHAPES_EXPORT Float timeOfImpact(const Sphere3D&, const Vector3&, const LineSegment3D&);
+template MAGNUM_SHAPES_EXPORT Float timeOfImpact(const Sphere2D&, const Vector2&, const Capsule2D&);
+template MAGNUM_SHAPES_EXPORT Float timeOfImpact(const Sphere3D&, const Vector3&, const Capsule3D&);
+template MAGNUM_SHAPES_EXPORT Float timeOfImpact(const Sphere2D&, const Vector2&, const Box2D&);
+template MAGNUM_SHAPES_EXPORT Float timeOfImpact(const Sphere3D&, const Vector3&, const Box3D&);
+template MAGNUM_SHAPES_EXPORT Float timeOfImpact(const AxisAlignedBox2D&, const Vector2&, const LineSegment2D&);
+template MAGNUM_SHAPES_EXPORT Float timeOfImpact(const AxisAlignedBox3D&, const Vector3&, const LineSegment3D&);
+template MAGNUM_SHAPES_EXPORT Float timeOfImpact(const AxisAlignedBox2D&, const Vector2&, const Capsule2D&);
+template MAGNUM_SHAPES_EXPORT Float timeOfImpact(const AxisAlignedBox3D&, const Vector3&, const Capsule3D&);
+template MAGNUM_SHAPES_EXPORT Float timeOfImpact(const AxisAlignedBox2D&, const Vector2&, const Box2D&);
+template MAGNUM_SHAPES_EXPORT Float timeOfImpact(const AxisAlignedBox3D&, const Vector3&, const Box3D&);
+#endif
+
+}}
@@ -0,0 +1,115 @@
+#ifndef Magnum_Shapes_Sweep_h
+#define Magnum_Shapes_Sweep_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::Shapes::timeOfImpact()
+ */
+
+#include "Magnum/DimensionTraits.h"
+#include "Magnum/Magnum.h"
+#include "Magnum/Shapes/Shapes.h"
+#include "Magnum/Shapes/visibility.h"
+
+namespace Magnum { namespace Shapes {
+
+/**
+@{ @name Continuous collision detection
+
+Contrary to the @cpp % @ce operator, which tests overlap of two shapes at a
+single point in time, these functions move the first shape linearly by given
+@p displacement and return the first point of the movement at which the shapes
+touch, expressed as a fraction of the displacement in range
+@f$ [0, 1] @f$. If the shapes overlap already at the beginning, @cpp 0.0f @ce
+is returned. If they don't touch anywhere during the movement,
+@ref Constants::inf() is returned. The second shape is static, if both shapes
+are moving, pass their relative displacement.
+
+Compared to testing for overlap at multiple steps of the movement, the query
+is done just once and thin or small shapes can't be skipped over by
+fast-moving ones.
+
+@code{.cpp}
+const Float t = Shapes::timeOfImpact(sphere, velocity*delta, wall);
+if(t <= 1.0f) {
+    sphere.setPosition(sphere.position() + velocity*delta*t);
+    // ... resolve the collision
+} else sphere.setPosition(sphere.position() + velocity*delta);
+@endcode
+*/
+
+/**
+@brief Time of impact of a moving sphere with a plane
+
+The plane is treated as two-sided.
+*/
+MAGNUM_SHAPES_EXPORT Float timeOfImpact(const Sphere3D& sphere, const Vector3& displacement, const Plane& plane);
+
+/** @brief Time of impact of a moving sphere with a line segment */
+template<UnsignedInt dimensions> MAGNUM_SHAPES_EXPORT Float timeOfImpact(const Sphere<dimensions>& sphere, const VectorTypeFor<dimensions, Float>& displacement, const LineSegment<dimensions>& segment);
+
+/** @brief Time of impact of a moving sphere with a capsule */
+template<UnsignedInt dimensions> MAGNUM_SHAPES_EXPORT Float timeOfImpact(const Sphere<dimensions>& sphere, const VectorTypeFor<dimensions, Float>& displacement, const Capsule<dimensions>& capsule);
+
+/**
+@brief Time of impact of a moving sphere with a box
+
+The box transformation is expected to not contain any skew, i.e. it can
+contain only rotation, translation and (possibly non-uniform) scaling.
+*/
+template<UnsignedInt dimensions> MAGNUM_SHAPES_EXPORT Float timeOfImpact(const Sphere<dimensions>& sphere, const VectorTypeFor<dimensions, Float>& displacement, const Box<dimensions>& box);
+
+/**
+@brief Time of impact of a moving axis-aligned box with a plane
+
+The plane is treated as two-sided.
+*/
+MAGNUM_SHAPES_EXPORT Float timeOfImpact(const AxisAlignedBox3D& box, const Vector3& displacement, const Plane& plane);
+
+/** @brief Time of impact of a moving axis-aligned box with a line segment */
+template<UnsignedInt dimensions> MAGNUM_SHAPES_EXPORT Float timeOfImpact(const AxisAlignedBox<dimensions>& box, const VectorTypeFor<dimensions, Float>& displacement, const LineSegment<dimensions>& segment);
+
+/**
+@brief Time of impact of a moving axis-aligned box with a capsule
+
+Computed using conservative advancement, the returned time might thus be
+slightly smaller than the exact time of impact if the box only grazes the
+capsule.
+*/
+template<UnsignedInt dimensions> MAGNUM_SHAPES_EXPORT Float timeOfImpact(const AxisAlignedBox<dimensions>& box, const VectorTypeFor<dimensions, Float>& displacement, const Capsule<dimensions>& capsule);
+
+/**
+@brief Time of impact of a moving axis-aligned box with a box
+
+The box can have arbitrary transformation.
+*/
+template<UnsignedInt dimensions> MAGNUM_SHAPES_EXPORT Float timeOfImpact(const AxisAlignedBox<dimensions>& box, const VectorTypeFor<dimensions, Float>& displacement, const Box<dimensions>& other);
+
+/*@}*/
+
+}}
+
+#endif
@@ -58,6 +58,19 @@ void AxisAlignedBoxTest::collisionPoint() {
 
     VERIFY_NOT_COLLIDES(box, point1);
     VERIFY_COLLIDES(box, point2);
+
+    /* Collision, the nearest face is the back one */
+    const Shapes::Point3D point3({0.2f, 1.0f, -2.5f});
+    const Shapes::Collision3D collision = box/point3;
+    CORRADE_COMPARE(collision.position(), point3.position());
+    CORRADE_COMPARE(collision.separationNormal(), Vector3::zAxis());
+    CORRADE_COMPARE(collision.separationDistance(), 0.5f);
+
+    /* Collision, flipped */
+    CORRADE_COMPARE(collision.separationNormal(), -(point3/box).separationNormal());
+
+    /* No collision */
+    CORRADE_VERIFY(!(box/point1));
 }
 
 }}}
@@ -24,6 +24,7 @@
 */
 
 #include "Magnum/Magnum.h"
+#include "Magnum/Math/Constants.h"
 #include "Magnum/Math/Matrix3.h"
 #include "Magnum/Math/Matrix4.h"
 #include "Magnum/Shapes/Capsule.h"
@@ -67,6 +68,19 @@ void CapsuleTest::collisionPoint() {
     VERIFY_COLLIDES(capsule, point);
     VERIFY_COLLIDES(capsule, point1);
     VERIFY_NOT_COLLIDES(capsule, point2);
+
+    /* Collision */
+    const Shapes::Point3D point3({1.0f, -1.0f, 0.0f});
+    const Shapes::Collision3D collision = capsule/point3;
+    CORRADE_COMPARE(collision.position(), point3.position());
+    CORRADE_COMPARE(collision.separationNormal(), Vector3(-1.0f, 1.0f, 0.0f).normalized());
+    CORRADE_COMPARE(collision.separationDistance(), 2.0f - Constants::sqrt2());
+
+    /* Collision, flipped */
+    CORRADE_COMPARE(collision.separationNormal(), -(point3/capsule).separationNormal());
+
+    /* No collision */
+    CORRADE_VERIFY(!(capsule/point2));
 }
 
 void CapsuleTest::collisionSphere() {
@@ -78,6 +92,16 @@ void CapsuleTest::collisionSphere() {
     VERIFY_COLLIDES(capsule, sphere);
     VERIFY_COLLIDES(capsule, sphere1);
     VERIFY_NOT_COLLIDES(capsule, sphere2);
+
+    /* Collision, contact position is on the sphere surface */
+    const Shapes::Sphere3D sphere3({0.0f, 0.0f, 2.5f}, 1.0f);
+    const Shapes::Collision3D collision = capsule/sphere3;
+    CORRADE_COMPARE(collision.position(), Vector3(0.0f, 0.0f, 1.5f));
+    CORRADE_COMPARE(collision.separationNormal(), -Vector3::zAxis());
+    CORRADE_COMPARE(collision.separationDistance(), 0.5f);
+
+    /* No collision */
+    CORRADE_VERIFY(!(capsule/sphere2));
 }
 
 }}}
@@ -43,6 +43,7 @@ struct CompositionTest: TestSuite::Tester {
     void multipleUnary();
     void hierarchy();
     void empty();
+    void deepHierarchy();
 
     void copy();
     void move();
@@ -56,6 +57,7 @@ CompositionTest::CompositionTest() {
               &CompositionTest::multipleUnary,
               &CompositionTest::hierarchy,
               &CompositionTest::empty,
+              &CompositionTest::deepHierarchy,
 
               &CompositionTest::copy,
               &CompositionTest::move,
@@ -132,6 +134,34 @@ void CompositionTest::empty() {
     VERIFY_NOT_COLLIDES(a, Shapes::Sphere2D({}, 1.0f));
 }
 
+void CompositionTest::deepHierarchy() {
+    const Shapes::Sphere2D s1{{-3.0f, 0.0f}, 1.0f}, s2{{3.0f, 0.0f}, 1.0f},
+        s3{{-3.0f, 0.0f}, 0.5f}, s4{{0.0f, 3.0f}, 2.0f};
+    const Shapes::AxisAlignedBox2D b1{{-4.0f, -4.0f}, {0.0f, 4.0f}},
+        b2{{2.5f, -4.0f}, {4.0f, 0.5f}};
+
+    /* Mix of nested operations, with some subtrees far from each other so
+       they get rejected on bounds */
+    const Shapes::Composition2D a =
+        ((Shapes::Sphere2D{s1} && !Shapes::Sphere2D{s3}) || (Shapes::Sphere2D{s2} && Shapes::AxisAlignedBox2D{b2})) ||
+        (!(Shapes::Sphere2D{s4} || Shapes::Sphere2D{s2}) && Shapes::AxisAlignedBox2D{b1});
+    CORRADE_COMPARE(a.size(), 7);
+
+    std::size_t collisionCount = 0;
+    for(Int x = -10; x <= 10; ++x) for(Int y = -10; y <= 10; ++y) {
+        const Shapes::Point2D point{Vector2{Float(x), Float(y)}*0.45f};
+        const bool expected =
+            ((s1 % point && !(s3 % point)) || (s2 % point && b2 % point)) ||
+            (!(s4 % point || s2 % point) && b1 % point);
+        CORRADE_COMPARE(a % point, expected);
+        if(expected) ++collisionCount;
+    }
+
+    /* Verify that the test isn't trivial */
+    CORRADE_VERIFY(collisionCount > 0);
+    CORRADE_VERIFY(collisionCount < 21*21);
+}
+
 void CompositionTest::copy() {
     const Shapes::Composition3D a = Shapes::Sphere3D({}, 1.0f) &&
         (Shapes::Point3D(Vector3::xAxis(1.5f)) || !Shapes::AxisAlignedBox3D({}, Vector3(0.5f)));
@@ -140,12 +170,14 @@ void CompositionTest::copy() {
     const Shapes::Composition3D b(a);
     CORRADE_COMPARE(b.size(), 3);
     CORRADE_COMPARE(b.get<Shapes::AxisAlignedBox3D>(2).max(), Vector3(0.5f));
+    VERIFY_COLLIDES(b, Shapes::Sphere3D(Vector3::xAxis(1.5f), 0.6f));
 
     /* Copy assignment */
     Shapes::Composition3D c;
     c = a;
     CORRADE_COMPARE(c.size(), 3);
     CORRADE_COMPARE(c.get<Shapes::Point3D>(1).position(), Vector3::xAxis(1.5f));
+    VERIFY_COLLIDES(c, Shapes::Sphere3D(Vector3::xAxis(1.5f), 0.6f));
 }
 
 void CompositionTest::move() {
@@ -158,6 +190,8 @@ void CompositionTest::move() {
         CORRADE_COMPARE(a.size(), 0);
         CORRADE_COMPARE(b.size(), 3);
         CORRADE_COMPARE(b.get<Shapes::Point3D>(1).position(), Vector3::xAxis(1.5f));
+        VERIFY_COLLIDES(b, Shapes::Sphere3D(Vector3::xAxis(1.5f), 0.6f));
+        VERIFY_NOT_COLLIDES(a, Shapes::Sphere3D(Vector3::xAxis(1.5f), 0.6f));
     } {
         Shapes::Composition3D a = Shapes::Sphere3D({}, 1.0f) &&
             (Shapes::Point3D(Vector3::xAxis(1.5f)) || !Shapes::AxisAlignedBox3D({}, Vector3(0.5f)));
@@ -168,6 +202,7 @@ void CompositionTest::move() {
         CORRADE_COMPARE(a.size(), 0);
         CORRADE_COMPARE(b.size(), 3);
         CORRADE_COMPARE(b.get<Shapes::AxisAlignedBox3D>(2).max(), Vector3(0.5f));
+        VERIFY_COLLIDES(b, Shapes::Sphere3D(Vector3::xAxis(1.5f), 0.6f));
     }
 }
 
@@ -181,6 +216,11 @@ void CompositionTest::transformed() {
     CORRADE_COMPARE(b.get<Shapes::Point2D>(1).position(), Vector2(3.0f, -7.0f));
     CORRADE_COMPARE(b.get<Shapes::AxisAlignedBox2D>(2).min(), Vector2(1.5f, -7.0f));
     CORRADE_COMPARE(b.get<Shapes::AxisAlignedBox2D>(2).max(), Vector2(2.0f, -6.5f));
+
+    /* Cached bounds are updated as well, so the shape collides only at the
+       new position */
+    VERIFY_COLLIDES(b, Shapes::Sphere2D({3.0f, -7.0f}, 0.6f));
+    VERIFY_NOT_COLLIDES(b, Shapes::Sphere2D(Vector2::xAxis(1.5f), 0.6f));
 }
 
 }}}
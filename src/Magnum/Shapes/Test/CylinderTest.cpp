@@ -24,6 +24,7 @@
 */
 
 #include "Magnum/Magnum.h"
+#include "Magnum/Math/Constants.h"
 #include "Magnum/Math/Matrix3.h"
 #include "Magnum/Math/Matrix4.h"
 #include "Magnum/Shapes/Cylinder.h"
@@ -67,6 +68,19 @@ void CylinderTest::collisionPoint() {
     VERIFY_COLLIDES(cylinder, point);
     VERIFY_COLLIDES(cylinder, point1);
     VERIFY_NOT_COLLIDES(cylinder, point2);
+
+    /* Collision */
+    const Shapes::Point3D point3({1.0f, -1.0f, 0.0f});
+    const Shapes::Collision3D collision = cylinder/point3;
+    CORRADE_COMPARE(collision.position(), point3.position());
+    CORRADE_COMPARE(collision.separationNormal(), Vector3(-1.0f, 1.0f, 0.0f).normalized());
+    CORRADE_COMPARE(collision.separationDistance(), 2.0f - Constants::sqrt2());
+
+    /* Collision, flipped */
+    CORRADE_COMPARE(collision.separationNormal(), -(point3/cylinder).separationNormal());
+
+    /* No collision */
+    CORRADE_VERIFY(!(cylinder/point2));
 }
 
 void CylinderTest::collisionSphere() {
@@ -78,6 +92,16 @@ void CylinderTest::collisionSphere() {
     VERIFY_COLLIDES(cylinder, sphere);
     VERIFY_COLLIDES(cylinder, sphere1);
     VERIFY_NOT_COLLIDES(cylinder, sphere2);
+
+    /* Collision, contact position is on the sphere surface */
+    const Shapes::Sphere3D sphere3({0.0f, 0.0f, 2.5f}, 1.0f);
+    const Shapes::Collision3D collision = cylinder/sphere3;
+    CORRADE_COMPARE(collision.position(), Vector3(0.0f, 0.0f, 1.5f));
+    CORRADE_COMPARE(collision.separationNormal(), -Vector3::zAxis());
+    CORRADE_COMPARE(collision.separationDistance(), 0.5f);
+
+    /* No collision */
+    CORRADE_VERIFY(!(cylinder/sphere2));
 }
 
 }}}
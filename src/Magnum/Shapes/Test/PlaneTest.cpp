@@ -64,6 +64,23 @@ void PlaneTest::collisionLine() {
     VERIFY_COLLIDES(plane, line);
     VERIFY_COLLIDES(plane, line2);
     VERIFY_NOT_COLLIDES(plane, line3);
+
+    /* Collision, can't be separated */
+    const Shapes::Collision3D collision = plane/line2;
+    CORRADE_COMPARE(collision.position(), Vector3(0.5f, 0.0f, 0.0f));
+    CORRADE_COMPARE(collision.separationNormal(), Vector3::yAxis());
+    CORRADE_COMPARE(collision.separationDistance(), Constants::inf());
+
+    /* Collision, flipped */
+    const Shapes::Collision3D flipped = line2/plane;
+    CORRADE_COMPARE(flipped.position(), Vector3(0.5f, 0.0f, 0.0f));
+    CORRADE_COMPARE(flipped.separationNormal(), -Vector3::yAxis());
+
+    /* Line lying in the plane */
+    CORRADE_COMPARE((plane/line).position(), line.a());
+
+    /* No collision */
+    CORRADE_VERIFY(!(plane/line3));
 }
 
 void PlaneTest::collisionLineSegment() {
@@ -75,6 +92,15 @@ void PlaneTest::collisionLineSegment() {
     VERIFY_COLLIDES(plane, line);
     VERIFY_NOT_COLLIDES(plane, line2);
     VERIFY_NOT_COLLIDES(plane, line3);
+
+    /* Collision, the plane is moved past the nearer endpoint */
+    const Shapes::Collision3D collision = plane/line;
+    CORRADE_COMPARE(collision.position(), Vector3(0.0f, -0.1f, 0.0f));
+    CORRADE_COMPARE(collision.separationNormal(), -Vector3::yAxis());
+    CORRADE_COMPARE(collision.separationDistance(), 0.1f);
+
+    /* No collision */
+    CORRADE_VERIFY(!(plane/line2));
 }
 
 }}}
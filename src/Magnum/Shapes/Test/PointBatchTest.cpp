@@ -0,0 +1,164 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <vector>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+
+#include "Magnum/Shapes/AxisAlignedBox.h"
+#include "Magnum/Shapes/Point.h"
+#include "Magnum/Shapes/PointBatch.h"
+#include "Magnum/Shapes/Sphere.h"
+
+namespace Magnum { namespace Shapes { namespace Test {
+
+struct PointBatchTest: TestSuite::Tester {
+    explicit PointBatchTest();
+
+    void construct();
+    void setPosition();
+    void clear();
+
+    void collisionSphere();
+    void collisionAxisAlignedBox();
+    void collisionMask();
+    void collisionMatchesScalar();
+};
+
+PointBatchTest::PointBatchTest() {
+    addTests({&PointBatchTest::construct,
+              &PointBatchTest::setPosition,
+              &PointBatchTest::clear,
+
+              &PointBatchTest::collisionSphere,
+              &PointBatchTest::collisionAxisAlignedBox,
+              &PointBatchTest::collisionMask,
+              &PointBatchTest::collisionMatchesScalar});
+}
+
+void PointBatchTest::construct() {
+    Shapes::PointBatch3D batch;
+    CORRADE_VERIFY(batch.isEmpty());
+    CORRADE_COMPARE(batch.maskSize(), 0);
+
+    batch.add(Shapes::Point3D{{1.0f, 2.0f, 3.0f}})
+         .add({4.0f, 5.0f, 6.0f});
+    CORRADE_VERIFY(!batch.isEmpty());
+    CORRADE_COMPARE(batch.size(), 2);
+    CORRADE_COMPARE(batch.maskSize(), 1);
+    CORRADE_COMPARE(batch.position(1), (Vector3{4.0f, 5.0f, 6.0f}));
+    CORRADE_COMPARE_AS(batch.coordinates(1), (std::vector<Float>{2.0f, 5.0f}),
+        TestSuite::Compare::Container);
+}
+
+void PointBatchTest::setPosition() {
+    Shapes::PointBatch2D batch;
+    batch.add({1.0f, 2.0f})
+         .add({3.0f, 4.0f});
+
+    batch.setPosition(0, {-1.0f, -2.0f});
+    CORRADE_COMPARE(batch.position(0), (Vector2{-1.0f, -2.0f}));
+    CORRADE_COMPARE(batch.position(1), (Vector2{3.0f, 4.0f}));
+}
+
+void PointBatchTest::clear() {
+    Shapes::PointBatch2D batch;
+    batch.add({1.0f, 2.0f});
+    batch.clear();
+    CORRADE_VERIFY(batch.isEmpty());
+    CORRADE_VERIFY(batch.coordinates(0).empty());
+    CORRADE_VERIFY(batch.coordinates(1).empty());
+}
+
+void PointBatchTest::collisionSphere() {
+    Shapes::PointBatch3D batch;
+    batch.add({1.0f, 0.0f, 0.0f})
+         .add({2.5f, 0.0f, 0.0f})
+         .add({0.0f, 0.0f, 0.0f})
+         .add({1.0f, 1.0f, 1.0f})
+         .add({2.0f, 0.0f, 0.0f});
+
+    /* Only strictly inside, same as the scalar test */
+    CORRADE_COMPARE_AS(batch.collisions(Shapes::Sphere3D{{}, 2.0f}),
+        (std::vector<UnsignedInt>{0, 2, 3}),
+        TestSuite::Compare::Container);
+}
+
+void PointBatchTest::collisionAxisAlignedBox() {
+    Shapes::PointBatch2D batch;
+    batch.add({0.0f, 0.0f})
+         .add({1.0f, 0.5f})
+         .add({0.5f, 0.5f})
+         .add({-0.5f, 0.5f});
+
+    /* Min is inclusive, max exclusive, same as the scalar test */
+    CORRADE_COMPARE_AS(batch.collisions(Shapes::AxisAlignedBox2D{{}, {1.0f, 1.0f}}),
+        (std::vector<UnsignedInt>{0, 2}),
+        TestSuite::Compare::Container);
+}
+
+void PointBatchTest::collisionMask() {
+    /* 70 points on a line, the first 40 inside the sphere. The last word
+       has the unused bits cleared. */
+    Shapes::PointBatch2D batch;
+    for(std::size_t i = 0; i != 70; ++i)
+        batch.add({Float(i), 0.0f});
+    CORRADE_COMPARE(batch.maskSize(), 3);
+
+    std::vector<UnsignedInt> mask(3, 0xdeadbeef);
+    batch.collisionMask(Shapes::Sphere2D{{-0.5f, 0.0f}, 40.0f}, {mask.data(), mask.size()});
+    CORRADE_COMPARE_AS(mask, (std::vector<UnsignedInt>{0xffffffff, 0x000000ff, 0}),
+        TestSuite::Compare::Container);
+}
+
+void PointBatchTest::collisionMatchesScalar() {
+    /* Points on a grid, tested against shapes positioned at fractional
+       coordinates */
+    Shapes::PointBatch3D batch;
+    std::vector<Shapes::Point3D> points;
+    for(Int x = -5; x <= 5; ++x) for(Int y = -5; y <= 5; ++y) for(Int z = -5; z <= 5; ++z) {
+        points.emplace_back(Vector3{Float(x), Float(y), Float(z)}*0.7f);
+        batch.add(points.back());
+    }
+
+    const Shapes::Sphere3D sphere{{0.3f, -0.4f, 1.1f}, 2.3f};
+    const Shapes::AxisAlignedBox3D box{{-1.3f, -0.2f, -2.5f}, {2.1f, 1.4f, 0.7f}};
+    std::vector<UnsignedInt> expectedSphere, expectedBox;
+    for(std::size_t i = 0; i != points.size(); ++i) {
+        if(sphere % points[i]) expectedSphere.push_back(UnsignedInt(i));
+        if(box % points[i]) expectedBox.push_back(UnsignedInt(i));
+    }
+
+    CORRADE_VERIFY(!expectedSphere.empty());
+    CORRADE_VERIFY(!expectedBox.empty());
+    CORRADE_COMPARE_AS(batch.collisions(sphere), expectedSphere,
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(batch.collisions(box), expectedBox,
+        TestSuite::Compare::Container);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Shapes::Test::PointBatchTest)
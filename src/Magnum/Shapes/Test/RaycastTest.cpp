@@ -0,0 +1,241 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Shapes/AxisAlignedBox.h"
+#include "Magnum/Shapes/Box.h"
+#include "Magnum/Shapes/Capsule.h"
+#include "Magnum/Shapes/Composition.h"
+#include "Magnum/Shapes/Cylinder.h"
+#include "Magnum/Shapes/LineSegment.h"
+#include "Magnum/Shapes/Plane.h"
+#include "Magnum/Shapes/Point.h"
+#include "Magnum/Shapes/Sphere.h"
+
+namespace Magnum { namespace Shapes { namespace Test {
+
+struct RaycastTest: TestSuite::Tester {
+    explicit RaycastTest();
+
+    void point();
+    void line2D();
+    void line3D();
+    void lineSegment();
+    void sphere();
+    void invertedSphere();
+    void cylinder();
+    void capsule();
+    void axisAlignedBox();
+    void box();
+    void plane();
+    void composition();
+};
+
+RaycastTest::RaycastTest() {
+    addTests({&RaycastTest::point,
+              &RaycastTest::line2D,
+              &RaycastTest::line3D,
+              &RaycastTest::lineSegment,
+              &RaycastTest::sphere,
+              &RaycastTest::invertedSphere,
+              &RaycastTest::cylinder,
+              &RaycastTest::capsule,
+              &RaycastTest::axisAlignedBox,
+              &RaycastTest::box,
+              &RaycastTest::plane,
+              &RaycastTest::composition});
+}
+
+void RaycastTest::point() {
+    Vector3 normal;
+    CORRADE_COMPARE(Implementation::raycast(Shapes::Point3D{Vector3::xAxis(2.0f)}, {}, Vector3::xAxis(), normal), Constants::inf());
+}
+
+void RaycastTest::line2D() {
+    const Shapes::Line2D line{{3.0f, 0.0f}, {3.0f, 1.0f}};
+
+    Vector2 normal;
+    CORRADE_COMPARE(Implementation::raycast(line, {}, Vector2::xAxis(), normal), 3.0f);
+    CORRADE_COMPARE(normal, -Vector2::xAxis());
+
+    /* Normal is facing the ray */
+    CORRADE_COMPARE(Implementation::raycast(line, {5.0f, 7.0f}, -Vector2::xAxis(), normal), 2.0f);
+    CORRADE_COMPARE(normal, Vector2::xAxis());
+
+    /* Parallel, behind */
+    CORRADE_COMPARE(Implementation::raycast(line, {}, Vector2::yAxis(), normal), Constants::inf());
+    CORRADE_COMPARE(Implementation::raycast(line, {}, -Vector2::xAxis(), normal), Constants::inf());
+}
+
+void RaycastTest::line3D() {
+    Vector3 normal;
+    CORRADE_COMPARE(Implementation::raycast(Shapes::Line3D{{3.0f, 0.0f, 0.0f}, {3.0f, 1.0f, 0.0f}}, {}, Vector3::xAxis(), normal), Constants::inf());
+}
+
+void RaycastTest::lineSegment() {
+    const Shapes::LineSegment2D segment{{3.0f, -1.0f}, {3.0f, 1.0f}};
+
+    Vector2 normal;
+    CORRADE_COMPARE(Implementation::raycast(segment, {}, Vector2::xAxis(), normal), 3.0f);
+    CORRADE_COMPARE(normal, -Vector2::xAxis());
+    CORRADE_COMPARE(Implementation::raycast(segment, Vector2::yAxis(1.5f), Vector2::xAxis(), normal), Constants::inf());
+}
+
+void RaycastTest::sphere() {
+    const Shapes::Sphere3D sphere{{5.0f, 0.0f, 0.0f}, 2.0f};
+
+    Vector3 normal;
+    CORRADE_COMPARE(Implementation::raycast(sphere, {}, Vector3::xAxis(), normal), 3.0f);
+    CORRADE_COMPARE(normal, -Vector3::xAxis());
+
+    /* Grazing hit off-center */
+    CORRADE_COMPARE(Implementation::raycast(sphere, Vector3::yAxis(2.0f), Vector3::xAxis(), normal), 5.0f);
+    CORRADE_COMPARE(normal, Vector3::yAxis());
+
+    /* Inside */
+    CORRADE_COMPARE(Implementation::raycast(sphere, Vector3::xAxis(4.0f), Vector3::zAxis(), normal), 0.0f);
+    CORRADE_COMPARE(normal, -Vector3::zAxis());
+
+    /* Miss, behind */
+    CORRADE_COMPARE(Implementation::raycast(sphere, Vector3::yAxis(3.0f), Vector3::xAxis(), normal), Constants::inf());
+    CORRADE_COMPARE(Implementation::raycast(sphere, {}, -Vector3::xAxis(), normal), Constants::inf());
+}
+
+void RaycastTest::invertedSphere() {
+    const Shapes::InvertedSphere2D sphere{{}, 2.0f};
+
+    /* Hit from inside at the boundary */
+    Vector2 normal;
+    CORRADE_COMPARE(Implementation::raycast(sphere, {}, Vector2::xAxis(), normal), 2.0f);
+    CORRADE_COMPARE(normal, -Vector2::xAxis());
+
+    /* Outside is inside of the solid */
+    CORRADE_COMPARE(Implementation::raycast(sphere, Vector2::xAxis(3.0f), Vector2::xAxis(), normal), 0.0f);
+    CORRADE_COMPARE(normal, -Vector2::xAxis());
+}
+
+void RaycastTest::cylinder() {
+    const Shapes::Cylinder3D cylinder{{}, Vector3::yAxis(), 1.0f};
+
+    Vector3 normal;
+    CORRADE_COMPARE(Implementation::raycast(cylinder, {-5.0f, 100.0f, 0.0f}, Vector3::xAxis(), normal), 4.0f);
+    CORRADE_COMPARE(normal, -Vector3::xAxis());
+
+    /* Parallel to the axis */
+    CORRADE_COMPARE(Implementation::raycast(cylinder, {-5.0f, 0.0f, 0.0f}, Vector3::yAxis(), normal), Constants::inf());
+    CORRADE_COMPARE(Implementation::raycast(cylinder, {0.5f, 0.0f, 0.0f}, Vector3::yAxis(), normal), 0.0f);
+}
+
+void RaycastTest::capsule() {
+    const Shapes::Capsule3D capsule{{}, Vector3::yAxis(2.0f), 1.0f};
+
+    /* Cylindrical part */
+    Vector3 normal;
+    CORRADE_COMPARE(Implementation::raycast(capsule, {-5.0f, 1.0f, 0.0f}, Vector3::xAxis(), normal), 4.0f);
+    CORRADE_COMPARE(normal, -Vector3::xAxis());
+
+    /* Caps */
+    CORRADE_COMPARE(Implementation::raycast(capsule, Vector3::yAxis(10.0f), -Vector3::yAxis(), normal), 7.0f);
+    CORRADE_COMPARE(normal, Vector3::yAxis());
+    CORRADE_COMPARE(Implementation::raycast(capsule, -Vector3::yAxis(10.0f), Vector3::yAxis(), normal), 9.0f);
+    CORRADE_COMPARE(normal, -Vector3::yAxis());
+
+    /* Past the caps */
+    CORRADE_COMPARE(Implementation::raycast(capsule, {-5.0f, 3.5f, 0.0f}, Vector3::xAxis(), normal), Constants::inf());
+}
+
+void RaycastTest::axisAlignedBox() {
+    const Shapes::AxisAlignedBox3D box{{1.0f, -1.0f, -1.0f}, {3.0f, 1.0f, 1.0f}};
+
+    Vector3 normal;
+    CORRADE_COMPARE(Implementation::raycast(box, {}, Vector3::xAxis(), normal), 1.0f);
+    CORRADE_COMPARE(normal, -Vector3::xAxis());
+    CORRADE_COMPARE(Implementation::raycast(box, {2.0f, 5.0f, 0.0f}, -Vector3::yAxis(), normal), 4.0f);
+    CORRADE_COMPARE(normal, Vector3::yAxis());
+
+    /* Inside, miss */
+    CORRADE_COMPARE(Implementation::raycast(box, {2.0f, 0.0f, 0.0f}, Vector3::yAxis(), normal), 0.0f);
+    CORRADE_COMPARE(normal, -Vector3::yAxis());
+    CORRADE_COMPARE(Implementation::raycast(box, Vector3::yAxis(2.0f), Vector3::xAxis(), normal), Constants::inf());
+}
+
+void RaycastTest::box() {
+    /* Rotated and scaled */
+    const Shapes::Box2D box{Matrix3::translation({5.0f, 0.0f})*Matrix3::rotation(Deg(45.0f))*Matrix3::scaling(Vector2{1.0f, 2.0f})};
+
+    Vector2 normal;
+    CORRADE_COMPARE(Implementation::raycast(box, {}, Vector2::xAxis(), normal), 5.0f - Constants::sqrt2());
+    CORRADE_COMPARE(normal, Vector2(-1.0f, -1.0f).normalized());
+
+    /* Miss */
+    CORRADE_COMPARE(Implementation::raycast(box, Vector2::yAxis(5.0f), Vector2::xAxis(), normal), Constants::inf());
+}
+
+void RaycastTest::plane() {
+    const Shapes::Plane plane{Vector3::zAxis(3.0f), Vector3::zAxis(2.0f)};
+
+    /* The plane is two-sided */
+    Vector3 normal;
+    CORRADE_COMPARE(Implementation::raycast(plane, {}, Vector3::zAxis(), normal), 3.0f);
+    CORRADE_COMPARE(normal, -Vector3::zAxis());
+    CORRADE_COMPARE(Implementation::raycast(plane, Vector3::zAxis(5.0f), -Vector3::zAxis(), normal), 2.0f);
+    CORRADE_COMPARE(normal, Vector3::zAxis());
+
+    /* Parallel, behind */
+    CORRADE_COMPARE(Implementation::raycast(plane, {}, Vector3::xAxis(), normal), Constants::inf());
+    CORRADE_COMPARE(Implementation::raycast(plane, {}, -Vector3::zAxis(), normal), Constants::inf());
+}
+
+void RaycastTest::composition() {
+    /* Sphere with a hole in it */
+    const Shapes::Composition2D a = Shapes::Sphere2D{{}, 2.0f} && !Shapes::AxisAlignedBox2D{{-1.0f, -1.0f}, {1.0f, 1.0f}};
+
+    /* Entering the sphere */
+    Vector2 normal;
+    CORRADE_COMPARE(Implementation::raycast(a, Vector2::xAxis(-5.0f), Vector2::xAxis(), normal), 3.0f);
+    CORRADE_COMPARE(normal, -Vector2::xAxis());
+
+    /* Inside the solid part */
+    CORRADE_COMPARE(Implementation::raycast(a, Vector2::xAxis(1.5f), Vector2::xAxis(), normal), 0.0f);
+
+    /* Missing everything */
+    CORRADE_COMPARE(Implementation::raycast(a, Vector2::xAxis(5.0f), Vector2::yAxis(), normal), Constants::inf());
+
+    /* Entering the sphere is not entering the intersection, entering the box
+       is */
+    const Shapes::Composition2D b = Shapes::Sphere2D{{}, 2.0f} && Shapes::AxisAlignedBox2D{{1.0f, -1.0f}, {3.0f, 1.0f}};
+    CORRADE_COMPARE(Implementation::raycast(b, Vector2::xAxis(-5.0f), Vector2::xAxis(), normal), 6.0f);
+    CORRADE_COMPARE(normal, -Vector2::xAxis());
+
+    CORRADE_COMPARE(Implementation::raycast(Shapes::Composition2D{}, {}, Vector2::xAxis(), normal), Constants::inf());
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Shapes::Test::RaycastTest)
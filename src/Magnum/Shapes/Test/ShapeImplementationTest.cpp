@@ -26,6 +26,15 @@
 #include <sstream>
 #include <Corrade/TestSuite/Tester.h>
 
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Shapes/AxisAlignedBox.h"
+#include "Magnum/Shapes/Box.h"
+#include "Magnum/Shapes/Capsule.h"
+#include "Magnum/Shapes/Composition.h"
+#include "Magnum/Shapes/LineSegment.h"
+#include "Magnum/Shapes/Plane.h"
+#include "Magnum/Shapes/Point.h"
+#include "Magnum/Shapes/Sphere.h"
 #include "Magnum/Shapes/shapeImplementation.h"
 
 namespace Magnum { namespace Shapes { namespace Test {
@@ -34,10 +43,18 @@ struct ShapeImplementationTest: TestSuite::Tester {
     explicit ShapeImplementationTest();
 
     void debug();
+
+    void bounds();
+    void boundsUnbounded();
+    void boundsComposition();
 };
 
 ShapeImplementationTest::ShapeImplementationTest() {
-    addTests({&ShapeImplementationTest::debug});
+    addTests({&ShapeImplementationTest::debug,
+
+              &ShapeImplementationTest::bounds,
+              &ShapeImplementationTest::boundsUnbounded,
+              &ShapeImplementationTest::boundsComposition});
 }
 
 void ShapeImplementationTest::debug() {
@@ -50,6 +67,50 @@ void ShapeImplementationTest::debug() {
     CORRADE_COMPARE(o.str(), "Shapes::Shape3D::Type::Plane Shapes::Shape3D::Type(0xbe)\n");
 }
 
+void ShapeImplementationTest::bounds() {
+    CORRADE_COMPARE(Implementation::bounds(Shapes::Point3D{{1.0f, 2.0f, 3.0f}}),
+        (Range3D{{1.0f, 2.0f, 3.0f}, {1.0f, 2.0f, 3.0f}}));
+    CORRADE_COMPARE(Implementation::bounds(Shapes::LineSegment2D{{1.0f, -2.0f}, {-1.0f, 3.0f}}),
+        (Range2D{{-1.0f, -2.0f}, {1.0f, 3.0f}}));
+    CORRADE_COMPARE(Implementation::bounds(Shapes::Sphere3D{{1.0f, 2.0f, 3.0f}, 0.5f}),
+        (Range3D{{0.5f, 1.5f, 2.5f}, {1.5f, 2.5f, 3.5f}}));
+    CORRADE_COMPARE(Implementation::bounds(Shapes::Capsule2D{{1.0f, -2.0f}, {-1.0f, 3.0f}, 0.5f}),
+        (Range2D{{-1.5f, -2.5f}, {1.5f, 3.5f}}));
+    CORRADE_COMPARE(Implementation::bounds(Shapes::AxisAlignedBox3D{{-1.0f, 2.0f, -3.0f}, {1.0f, 3.0f, 3.0f}}),
+        (Range3D{{-1.0f, 2.0f, -3.0f}, {1.0f, 3.0f, 3.0f}}));
+
+    /* Unit box rotated by 45 degrees */
+    const Range2D box = Implementation::bounds(Shapes::Box2D{Matrix3::translation({1.0f, 2.0f})*Matrix3::rotation(Deg(45.0f))});
+    CORRADE_COMPARE(box.min(), (Vector2{1.0f, 2.0f} - Vector2{Constants::sqrt2()}));
+    CORRADE_COMPARE(box.max(), (Vector2{1.0f, 2.0f} + Vector2{Constants::sqrt2()}));
+}
+
+void ShapeImplementationTest::boundsUnbounded() {
+    const Range3D everything{Vector3{-Constants::inf()}, Vector3{Constants::inf()}};
+    CORRADE_COMPARE(Implementation::bounds(Shapes::Line3D{{}, Vector3::xAxis()}), everything);
+    CORRADE_COMPARE(Implementation::bounds(Shapes::InvertedSphere3D{{}, 1.0f}), everything);
+    CORRADE_COMPARE(Implementation::bounds(Shapes::Plane{{}, Vector3::yAxis()}), everything);
+}
+
+void ShapeImplementationTest::boundsComposition() {
+    /* Union of both */
+    CORRADE_COMPARE(Implementation::bounds(Shapes::Sphere2D({}, 1.0f) || Shapes::Point2D({3.0f, 4.0f})),
+        (Range2D{{-1.0f, -1.0f}, {3.0f, 4.0f}}));
+
+    /* The smaller one of both */
+    CORRADE_COMPARE(Implementation::bounds(Shapes::Sphere2D({}, 1.0f) && Shapes::Point2D({3.0f, 4.0f})),
+        (Range2D{{3.0f, 4.0f}, {3.0f, 4.0f}}));
+
+    /* Everything outside */
+    const Range2D everything{Vector2{-Constants::inf()}, Vector2{Constants::inf()}};
+    CORRADE_COMPARE(Implementation::bounds(!Shapes::Sphere2D({}, 1.0f)), everything);
+    CORRADE_COMPARE(Implementation::bounds(Shapes::Sphere2D({}, 1.0f) && !Shapes::Point2D({3.0f, 4.0f})),
+        (Range2D{{-1.0f, -1.0f}, {1.0f, 1.0f}}));
+
+    /* Empty */
+    CORRADE_COMPARE(Implementation::bounds(Shapes::Composition2D{}), Range2D{});
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Shapes::Test::ShapeImplementationTest)
@@ -23,9 +23,15 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <memory>
+#include <vector>
 #include <Corrade/TestSuite/Tester.h>
 
+#include "Magnum/ThreadPool.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Shapes/AxisAlignedBox.h"
 #include "Magnum/Shapes/Composition.h"
+#include "Magnum/Shapes/Line.h"
 #include "Magnum/Shapes/Point.h"
 #include "Magnum/Shapes/Shape.h"
 #include "Magnum/Shapes/ShapeGroup.h"
@@ -33,6 +39,7 @@
 #include "Magnum/SceneGraph/MatrixTransformation2D.h"
 #include "Magnum/SceneGraph/MatrixTransformation3D.h"
 #include "Magnum/SceneGraph/Scene.h"
+#include "Magnum/SceneGraph/TranslationTransformation.h"
 
 namespace Magnum { namespace Shapes { namespace Test {
 
@@ -40,9 +47,22 @@ struct ShapeTest: TestSuite::Tester {
     explicit ShapeTest();
 
     void clean();
+    void cleanTranslation();
+    void cleanParallel();
     void collides();
     void collision();
     void firstCollision();
+    void firstCollisionUnbounded();
+    void collisionCandidates();
+    void allCollisions();
+    void allCollisionsParallel();
+    void allCollisionsGroups();
+    void allCollisionsGroupsParallel();
+    void incrementalClean();
+    void raycast();
+    void raycastAll();
+    void occluderCounts();
+    void occluderCountsParallel();
     void shapeGroup();
 };
 
@@ -53,9 +73,22 @@ typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
 
 ShapeTest::ShapeTest() {
     addTests({&ShapeTest::clean,
+              &ShapeTest::cleanTranslation,
+              &ShapeTest::cleanParallel,
               &ShapeTest::collides,
               &ShapeTest::collision,
               &ShapeTest::firstCollision,
+              &ShapeTest::firstCollisionUnbounded,
+              &ShapeTest::collisionCandidates,
+              &ShapeTest::allCollisions,
+              &ShapeTest::allCollisionsParallel,
+              &ShapeTest::allCollisionsGroups,
+              &ShapeTest::allCollisionsGroupsParallel,
+              &ShapeTest::incrementalClean,
+              &ShapeTest::raycast,
+              &ShapeTest::raycastAll,
+              &ShapeTest::occluderCounts,
+              &ShapeTest::occluderCountsParallel,
               &ShapeTest::shapeGroup});
 }
 
@@ -99,6 +132,69 @@ void ShapeTest::clean() {
     CORRADE_VERIFY(b.isDirty());
 }
 
+void ShapeTest::cleanTranslation() {
+    typedef SceneGraph::Scene<SceneGraph::TranslationTransformation2D> Scene2Dt;
+    typedef SceneGraph::Object<SceneGraph::TranslationTransformation2D> Object2Dt;
+
+    Scene2Dt scene;
+    ShapeGroup2D shapes;
+
+    Object2Dt a(&scene);
+    a.translate({1.0f, -2.0f});
+    auto sphere = new Shapes::Shape<Shapes::Sphere2D>(a, {{0.5f, 0.5f}, 2.0f}, &shapes);
+
+    Object2Dt b(&a);
+    b.translate({3.0f, 0.0f});
+    auto composition = new Shapes::Shape<Shapes::Composition2D>(b,
+        Shapes::Sphere2D{{}, 1.0f} || Shapes::AxisAlignedBox2D{{1.0f, 1.0f}, {2.0f, 3.0f}}, &shapes);
+
+    /* Objects with translation-only transformation go through the cheaper
+       path, the result should be the same as with a matrix */
+    CORRADE_COMPARE(sphere->transformedShape().position(), (Vector2{1.5f, -1.5f}));
+    CORRADE_COMPARE(sphere->transformedShape().radius(), 2.0f);
+    CORRADE_COMPARE(composition->transformedShape().get<Shapes::Sphere2D>(0).position(), (Vector2{4.0f, -2.0f}));
+    CORRADE_COMPARE(composition->transformedShape().get<Shapes::AxisAlignedBox2D>(1).min(), (Vector2{5.0f, -1.0f}));
+    CORRADE_COMPARE(composition->transformedShape().get<Shapes::AxisAlignedBox2D>(1).max(), (Vector2{6.0f, 1.0f}));
+
+    /* Composition bounds are updated as well */
+    CORRADE_VERIFY(composition->transformedShape() % Shapes::Point2D({5.5f, 0.0f}));
+    CORRADE_VERIFY(!(composition->transformedShape() % Shapes::Point2D({1.5f, 2.0f})));
+}
+
+void ShapeTest::cleanParallel() {
+    ThreadPool pool{4};
+    Scene3D scene;
+    ShapeGroup3D shapes;
+
+    Object3D a(&scene);
+    a.scale(Vector3(-2.0f));
+    Object3D aa(&a);
+    aa.translate(Vector3::xAxis(1.0f));
+    auto shape = new Shapes::Shape<Shapes::Point3D>(aa, {{1.0f, -2.0f, 3.0f}}, &shapes);
+
+    Object3D b(&scene);
+    auto shapeB = new Shapes::Shape<Shapes::Point3D>(b, &shapes);
+
+    /* The whole group is cleaned with transformations computed in
+       parallel */
+    shapes.setClean(pool);
+    CORRADE_VERIFY(!shapes.isDirty());
+    CORRADE_VERIFY(!a.isDirty());
+    CORRADE_VERIFY(!aa.isDirty());
+    CORRADE_VERIFY(!b.isDirty());
+    CORRADE_COMPARE(shape->transformedShape().position(),
+        Vector3(-4.0f, 4.0f, -6.0f));
+
+    /* Only the moved shape gets cleaned afterwards */
+    b.translate(Vector3::yAxis(2.0f));
+    CORRADE_VERIFY(shapes.isDirty());
+    shapes.setClean(pool);
+    CORRADE_VERIFY(!shapes.isDirty());
+    CORRADE_VERIFY(!b.isDirty());
+    CORRADE_COMPARE(shapeB->transformedShape().position(),
+        Vector3(0.0f, 2.0f, 0.0f));
+}
+
 void ShapeTest::collides() {
     Scene3D scene;
     ShapeGroup3D shapes;
@@ -178,6 +274,12 @@ void ShapeTest::collision() {
         const Collision3D collision = aShape.collision(bShape);
         CORRADE_VERIFY(collision);
         CORRADE_COMPARE(collision.position(), Vector3(2.0f, -2.0f, 3.0f));
+
+        /* Reversed order gives flipped collision */
+        const Collision3D flipped = bShape.collision(aShape);
+        CORRADE_VERIFY(flipped);
+        CORRADE_COMPARE(flipped.position(), Vector3(2.5f, -2.0f, 3.0f));
+        CORRADE_COMPARE(flipped.separationNormal(), Vector3::xAxis());
     }
 }
 
@@ -206,6 +308,361 @@ void ShapeTest::firstCollision() {
     CORRADE_VERIFY(!shapes.isDirty());
 }
 
+void ShapeTest::firstCollisionUnbounded() {
+    Scene3D scene;
+    ShapeGroup3D shapes;
+
+    Object3D a(&scene);
+    Shape<Shapes::Sphere3D> aShape(a, {{100.0f, 5.0f, 0.0f}, 1.5f}, &shapes);
+
+    Object3D b(&scene);
+    Shape<Shapes::Line3D> bShape(b, {{}, Vector3::xAxis()}, &shapes);
+
+    /* Line is not bounded, so it gets tested even though its defining points
+       are far away from the sphere */
+    CORRADE_VERIFY(!shapes.firstCollision(aShape));
+    a.translate(Vector3::yAxis(-4.0f));
+    CORRADE_VERIFY(shapes.firstCollision(aShape) == &bShape);
+    CORRADE_VERIFY(shapes.firstCollision(bShape) == &aShape);
+}
+
+void ShapeTest::collisionCandidates() {
+    Scene3D scene;
+    ShapeGroup3D shapes;
+
+    Object3D a(&scene);
+    Shape<Shapes::Sphere3D> aShape(a, {{}, 1.0f}, &shapes);
+
+    /* Bounds overlap with a, but the shapes don't collide */
+    Object3D b(&scene);
+    Shape<Shapes::Point3D> bShape(b, {{0.9f, 0.9f, 0.9f}}, &shapes);
+
+    /* Far away from everything */
+    Object3D c(&scene);
+    Shape<Shapes::Sphere3D> cShape(c, {{10.0f, 0.0f, 0.0f}, 1.0f}, &shapes);
+
+    /* Colliding with a */
+    Object3D d(&scene);
+    Shape<Shapes::Point3D> dShape(d, {{0.0f, -0.5f, 0.0f}}, &shapes);
+
+    const auto candidates = shapes.collisionCandidates();
+    CORRADE_COMPARE(candidates.size(), 2);
+    CORRADE_VERIFY(candidates[0].first == &aShape);
+    CORRADE_VERIFY(candidates[0].second == &bShape);
+    CORRADE_VERIFY(candidates[1].first == &aShape);
+    CORRADE_VERIFY(candidates[1].second == &dShape);
+    CORRADE_VERIFY(!shapes.isDirty());
+
+    /* Move c onto b, the incremental update should pick that up */
+    c.translate(Vector3::xAxis(-9.5f));
+    CORRADE_VERIFY(shapes.isDirty());
+    const auto moved = shapes.collisionCandidates();
+    CORRADE_COMPARE(moved.size(), 5);
+}
+
+void ShapeTest::allCollisions() {
+    Scene2D scene;
+    ShapeGroup2D shapes;
+
+    /* Row of spheres, each touching only its neighbors */
+    std::vector<std::unique_ptr<Object2D>> objects;
+    for(std::size_t i = 0; i != 10; ++i) {
+        objects.emplace_back(new Object2D{&scene});
+        objects.back()->translate(Vector2::xAxis(i*1.5f));
+        new Shape<Shapes::Sphere2D>(*objects.back(), {{}, 1.0f}, &shapes);
+    }
+
+    const auto collisions = shapes.allCollisions();
+    CORRADE_COMPARE(collisions.size(), 9);
+    for(std::size_t i = 0; i != collisions.size(); ++i) {
+        CORRADE_VERIFY(collisions[i].first == &shapes[i]);
+        CORRADE_VERIFY(collisions[i].second == &shapes[i + 1]);
+    }
+
+    /* Removing a shape updates the group */
+    objects.pop_back();
+    CORRADE_COMPARE(shapes.allCollisions().size(), 8);
+}
+
+void ShapeTest::allCollisionsParallel() {
+    Scene2D scene;
+    ShapeGroup2D shapes;
+
+    /* Grid of spheres, each touching its four neighbors */
+    std::vector<std::unique_ptr<Object2D>> objects;
+    for(Int x = 0; x != 30; ++x) for(Int y = 0; y != 30; ++y) {
+        objects.emplace_back(new Object2D{&scene});
+        objects.back()->translate({x*1.5f, y*1.5f});
+        new Shape<Shapes::Sphere2D>(*objects.back(), {{}, 1.0f}, &shapes);
+    }
+
+    ThreadPool pool{4};
+    const auto collisions = shapes.allCollisions(pool);
+    CORRADE_COMPARE(collisions.size(), 2*30*29);
+    CORRADE_VERIFY(collisions == shapes.allCollisions());
+}
+
+void ShapeTest::allCollisionsGroups() {
+    Scene2D scene;
+    ShapeGroup2D a, b;
+
+    /* Two rows of spheres, each touching two spheres in the other row.
+       Collisions within the rows are not reported. */
+    std::vector<std::unique_ptr<Object2D>> objects;
+    for(std::size_t i = 0; i != 10; ++i) {
+        objects.emplace_back(new Object2D{&scene});
+        objects.back()->translate(Vector2::xAxis(i*1.5f));
+        new Shape<Shapes::Sphere2D>(*objects.back(), {{}, 1.0f}, &a);
+
+        objects.emplace_back(new Object2D{&scene});
+        objects.back()->translate({i*1.5f + 0.75f, 1.0f});
+        new Shape<Shapes::Sphere2D>(*objects.back(), {{}, 0.5f}, &b);
+    }
+
+    const auto collisions = a.allCollisions(b);
+    CORRADE_COMPARE(collisions.size(), 19);
+    for(std::size_t i = 0; i != collisions.size(); ++i) {
+        CORRADE_VERIFY(collisions[i].first == &a[(i + 1)/2]);
+        CORRADE_VERIFY(collisions[i].second == &b[i/2]);
+    }
+
+    /* Moving a shape of the other group is picked up */
+    objects.back()->translate(Vector2::yAxis(5.0f));
+    CORRADE_COMPARE(a.allCollisions(b).size(), 18);
+    CORRADE_VERIFY(!b.isDirty());
+}
+
+void ShapeTest::allCollisionsGroupsParallel() {
+    Scene3D scene;
+    ShapeGroup3D a, b;
+
+    /* Moving spheres against static points */
+    std::vector<std::unique_ptr<Object3D>> objects;
+    for(Int i = 0; i != 500; ++i) {
+        objects.emplace_back(new Object3D{&scene});
+        objects.back()->translate({Float(i%10), Float(i/10%10), Float(i/100)});
+        new Shape<Shapes::Point3D>(*objects.back(), {}, &a);
+
+        objects.emplace_back(new Object3D{&scene});
+        objects.back()->translate({Float(i%7), Float(i/7%7), Float(i/49%5)});
+        new Shape<Shapes::Sphere3D>(*objects.back(), {Vector3{0.25f}, 0.5f}, &b);
+    }
+
+    ThreadPool pool{4};
+    const auto collisions = a.allCollisions(b, pool);
+    CORRADE_VERIFY(!collisions.empty());
+    CORRADE_VERIFY(collisions == a.allCollisions(b));
+
+    /* Reversed order */
+    const auto reversed = b.allCollisions(a, pool);
+    CORRADE_COMPARE(reversed.size(), collisions.size());
+}
+
+void ShapeTest::incrementalClean() {
+    Scene2D scene;
+    ShapeGroup2D shapes;
+
+    /* Row of static spheres not touching each other */
+    std::vector<std::unique_ptr<Object2D>> objects;
+    for(std::size_t i = 0; i != 20; ++i) {
+        objects.emplace_back(new Object2D{&scene});
+        objects.back()->translate(Vector2::xAxis(i*2.0f));
+        new Shape<Shapes::Sphere2D>(*objects.back(), {{}, 0.5f}, &shapes);
+    }
+
+    /* A sphere moving over them */
+    Object2D moving{&scene};
+    moving.translate(Vector2::xAxis(-5.0f));
+    Shape<Shapes::Sphere2D> movingShape{moving, {{}, 0.5f}, &shapes};
+    CORRADE_VERIFY(shapes.allCollisions().empty());
+    CORRADE_VERIFY(!shapes.isDirty());
+
+    for(Int i = 0; i != 90; ++i) {
+        moving.translate(Vector2::xAxis(0.5f));
+        CORRADE_VERIFY(shapes.isDirty());
+        CORRADE_VERIFY(moving.isDirty());
+
+        const Float x = -5.0f + (i + 1)*0.5f;
+        std::size_t expected = 0;
+        for(std::size_t j = 0; j != 20; ++j)
+            if(Math::abs(x - j*2.0f) < 1.0f) ++expected;
+
+        const auto collisions = shapes.allCollisions();
+        CORRADE_COMPARE(collisions.size(), expected);
+        for(const auto& collision: collisions)
+            CORRADE_VERIFY(collision.second == &movingShape);
+        CORRADE_VERIFY(!shapes.isDirty());
+        CORRADE_VERIFY(!moving.isDirty());
+        CORRADE_COMPARE(movingShape.transformedShape().position(), Vector2::xAxis(x));
+    }
+
+    /* Move the sphere onto the first one, then destroy a moved shape before
+       cleaning the group */
+    moving.setTransformation({});
+    objects[5]->translate(Vector2::yAxis(0.25f));
+    objects.erase(objects.begin() + 5);
+    const auto collisions = shapes.allCollisions();
+    CORRADE_COMPARE(collisions.size(), 1);
+    CORRADE_VERIFY(collisions[0].first == &shapes[0]);
+    CORRADE_VERIFY(collisions[0].second == &movingShape);
+
+    /* A moved shape taken to another group gets tracked there */
+    ShapeGroup2D other;
+    moving.translate(Vector2::xAxis(2.0f));
+    other.add(movingShape);
+    CORRADE_VERIFY(shapes.allCollisions().empty());
+    CORRADE_VERIFY(other.allCollisions().empty());
+    moving.translate(Vector2::xAxis(2.0f));
+    CORRADE_VERIFY(other.isDirty());
+    CORRADE_VERIFY(!shapes.isDirty());
+    other.setClean();
+    CORRADE_VERIFY(!moving.isDirty());
+}
+
+void ShapeTest::raycast() {
+    Scene3D scene;
+    ShapeGroup3D shapes;
+
+    Object3D a(&scene);
+    Shape<Shapes::Sphere3D> aShape(a, {{}, 1.0f}, &shapes);
+    a.translate(Vector3::xAxis(10.0f));
+
+    Object3D b(&scene);
+    Shape<Shapes::AxisAlignedBox3D> bShape(b, {Vector3{-1.0f}, Vector3{1.0f}}, &shapes);
+    b.translate(Vector3::xAxis(5.0f));
+
+    /* Points are never hit */
+    Object3D c(&scene);
+    Shape<Shapes::Point3D> cShape(c, {{2.0f, 0.0f, 0.0f}}, &shapes);
+
+    /* Nearest shape is hit, direction doesn't need to be normalized */
+    RaycastHit3D hit = shapes.raycast({}, Vector3::xAxis(3.0f));
+    CORRADE_VERIFY(hit);
+    CORRADE_VERIFY(hit.shape() == &bShape);
+    CORRADE_COMPARE(hit.distance(), 4.0f);
+    CORRADE_COMPARE(hit.position(), Vector3::xAxis(4.0f));
+    CORRADE_COMPARE(hit.normal(), -Vector3::xAxis());
+
+    /* Max distance */
+    CORRADE_VERIFY(!shapes.raycast({}, Vector3::xAxis(), 3.5f));
+
+    /* Ray from the other side */
+    hit = shapes.raycast(Vector3::xAxis(20.0f), -Vector3::xAxis());
+    CORRADE_VERIFY(hit.shape() == &aShape);
+    CORRADE_COMPARE(hit.distance(), 9.0f);
+    CORRADE_COMPARE(hit.normal(), Vector3::xAxis());
+
+    /* Origin inside */
+    hit = shapes.raycast(Vector3::xAxis(10.0f), Vector3::yAxis());
+    CORRADE_VERIFY(hit.shape() == &aShape);
+    CORRADE_COMPARE(hit.distance(), 0.0f);
+    CORRADE_COMPARE(hit.normal(), -Vector3::yAxis());
+
+    /* Missing everything */
+    hit = shapes.raycast(Vector3::yAxis(5.0f), Vector3::xAxis());
+    CORRADE_VERIFY(!hit);
+    CORRADE_VERIFY(!hit.shape());
+    CORRADE_COMPARE(hit.distance(), Constants::inf());
+
+    /* Moved shapes are picked up */
+    b.translate(Vector3::yAxis(5.0f));
+    hit = shapes.raycast({}, Vector3::xAxis());
+    CORRADE_VERIFY(hit.shape() == &aShape);
+    CORRADE_COMPARE(hit.distance(), 9.0f);
+}
+
+void ShapeTest::raycastAll() {
+    Scene2D scene;
+    ShapeGroup2D shapes;
+
+    /* Row of spheres added in reverse order */
+    std::vector<std::unique_ptr<Object2D>> objects;
+    for(std::size_t i = 0; i != 10; ++i) {
+        objects.emplace_back(new Object2D{&scene});
+        objects.back()->translate(Vector2::xAxis(Float(10 - i)*3.0f));
+        new Shape<Shapes::Sphere2D>(*objects.back(), {{}, 1.0f}, &shapes);
+    }
+
+    /* Line crossing the ray, not bounded */
+    Object2D line{&scene};
+    Shape<Shapes::Line2D> lineShape{line, {{14.0f, -1.0f}, {14.0f, 1.0f}}, &shapes};
+
+    const std::vector<RaycastHit2D> hits = shapes.raycastAll({}, Vector2::xAxis(), 19.5f);
+    CORRADE_COMPARE(hits.size(), 7);
+    CORRADE_VERIFY(hits[0].shape() == &shapes[9]);
+    CORRADE_COMPARE(hits[0].distance(), 2.0f);
+
+    /* The line has the same distance as the sphere before it, ordered by
+       position in the group */
+    CORRADE_VERIFY(hits[4].shape() == &shapes[5]);
+    CORRADE_VERIFY(hits[5].shape() == &lineShape);
+    CORRADE_COMPARE(hits[5].distance(), 14.0f);
+    CORRADE_COMPARE(hits[5].normal(), -Vector2::xAxis());
+    for(std::size_t i = 1; i != hits.size(); ++i)
+        CORRADE_VERIFY(hits[i - 1].distance() <= hits[i].distance());
+    CORRADE_COMPARE(hits.back().distance(), 17.0f);
+
+    /* Nearest hit is the first one */
+    CORRADE_VERIFY(shapes.raycast({}, Vector2::xAxis()).shape() == hits[0].shape());
+}
+
+void ShapeTest::occluderCounts() {
+    Scene2D scene;
+    ShapeGroup2D shapes;
+
+    /* Two walls along the X axis and a box around the origin */
+    Object2D a{&scene}, b{&scene}, c{&scene};
+    a.translate(Vector2::xAxis(5.0f));
+    b.translate(Vector2::xAxis(10.0f));
+    Shape<Shapes::AxisAlignedBox2D> wallA{a, {{-0.5f, -2.0f}, {0.5f, 2.0f}}, &shapes};
+    Shape<Shapes::AxisAlignedBox2D> wallB{b, {{-0.5f, -2.0f}, {0.5f, 2.0f}}, &shapes};
+    Shape<Shapes::AxisAlignedBox2D> room{c, {{-1.0f, -1.0f}, {1.0f, 1.0f}}, &shapes};
+
+    const std::vector<UnsignedInt> counts = shapes.occluderCounts({}, {
+        {3.0f, 0.0f},   /* in front of both walls */
+        {7.0f, 0.0f},   /* between the walls */
+        {12.0f, 0.0f},  /* behind both walls */
+        {10.0f, 0.0f},  /* inside the second wall */
+        {12.0f, 10.0f}, /* diagonally above the walls */
+        {}              /* at the origin */
+    });
+
+    /* The box containing the origin is never counted */
+    CORRADE_COMPARE(counts, (std::vector<UnsignedInt>{0, 1, 2, 2, 0, 0}));
+
+    /* Counting from outside of the box counts it as well */
+    CORRADE_COMPARE(shapes.occluderCounts({-3.0f, 0.0f}, {{7.0f, 0.0f}}),
+        std::vector<UnsignedInt>{2});
+}
+
+void ShapeTest::occluderCountsParallel() {
+    Scene2D scene;
+    ShapeGroup2D shapes;
+
+    /* Grid of spheres */
+    std::vector<std::unique_ptr<Object2D>> objects;
+    for(Int x = 0; x != 20; ++x) for(Int y = 0; y != 20; ++y) {
+        objects.emplace_back(new Object2D{&scene});
+        objects.back()->translate({x*3.0f, y*3.0f});
+        new Shape<Shapes::Sphere2D>(*objects.back(), {{}, 1.0f}, &shapes);
+    }
+
+    std::vector<Vector2> targets;
+    for(Int x = 0; x != 30; ++x) for(Int y = 0; y != 30; ++y)
+        targets.emplace_back(x*2.0f + 0.5f, y*2.0f + 0.5f);
+
+    ThreadPool pool{4};
+    const std::vector<UnsignedInt> counts = shapes.occluderCounts({-5.0f, -7.0f}, targets, pool);
+    CORRADE_COMPARE(counts.size(), targets.size());
+    CORRADE_VERIFY(counts == shapes.occluderCounts({-5.0f, -7.0f}, targets));
+
+    /* Verify the counts against all hits of a ray */
+    for(std::size_t i = 0; i != targets.size(); i += 37) {
+        const Vector2 direction = targets[i] - Vector2{-5.0f, -7.0f};
+        CORRADE_COMPARE(counts[i], shapes.raycastAll({-5.0f, -7.0f}, direction, direction.length()).size());
+    }
+}
+
 void ShapeTest::shapeGroup() {
     Scene2D scene;
     ShapeGroup2D shapes;
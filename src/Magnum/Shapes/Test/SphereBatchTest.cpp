@@ -0,0 +1,147 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <vector>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+
+#include "Magnum/Shapes/Point.h"
+#include "Magnum/Shapes/Sphere.h"
+#include "Magnum/Shapes/SphereBatch.h"
+
+namespace Magnum { namespace Shapes { namespace Test {
+
+struct SphereBatchTest: TestSuite::Tester {
+    explicit SphereBatchTest();
+
+    void construct();
+    void setSphere();
+    void clear();
+
+    void collisionPoint();
+    void collisionSphere();
+    void collisionMatchesScalar();
+};
+
+SphereBatchTest::SphereBatchTest() {
+    addTests({&SphereBatchTest::construct,
+              &SphereBatchTest::setSphere,
+              &SphereBatchTest::clear,
+
+              &SphereBatchTest::collisionPoint,
+              &SphereBatchTest::collisionSphere,
+              &SphereBatchTest::collisionMatchesScalar});
+}
+
+void SphereBatchTest::construct() {
+    Shapes::SphereBatch3D batch;
+    CORRADE_VERIFY(batch.isEmpty());
+    CORRADE_COMPARE(batch.maskSize(), 0);
+
+    batch.add({{1.0f, 2.0f, 3.0f}, 0.5f})
+         .add({{4.0f, 5.0f, 6.0f}, 1.5f});
+    CORRADE_COMPARE(batch.size(), 2);
+    CORRADE_COMPARE(batch.maskSize(), 1);
+    CORRADE_COMPARE(batch.sphere(1).position(), (Vector3{4.0f, 5.0f, 6.0f}));
+    CORRADE_COMPARE(batch.sphere(1).radius(), 1.5f);
+    CORRADE_COMPARE_AS(batch.coordinates(2), (std::vector<Float>{3.0f, 6.0f}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(batch.radii(), (std::vector<Float>{0.5f, 1.5f}),
+        TestSuite::Compare::Container);
+}
+
+void SphereBatchTest::setSphere() {
+    Shapes::SphereBatch2D batch;
+    batch.add({{1.0f, 2.0f}, 0.5f})
+         .add({{3.0f, 4.0f}, 1.5f});
+
+    batch.setSphere(1, {{-1.0f, -2.0f}, 3.0f});
+    CORRADE_COMPARE(batch.sphere(0).position(), (Vector2{1.0f, 2.0f}));
+    CORRADE_COMPARE(batch.sphere(1).position(), (Vector2{-1.0f, -2.0f}));
+    CORRADE_COMPARE(batch.sphere(1).radius(), 3.0f);
+}
+
+void SphereBatchTest::clear() {
+    Shapes::SphereBatch2D batch;
+    batch.add({{1.0f, 2.0f}, 0.5f});
+    batch.clear();
+    CORRADE_VERIFY(batch.isEmpty());
+    CORRADE_VERIFY(batch.radii().empty());
+    CORRADE_VERIFY(batch.coordinates(0).empty());
+}
+
+void SphereBatchTest::collisionPoint() {
+    Shapes::SphereBatch2D batch;
+    batch.add({{}, 1.0f})
+         .add({{2.0f, 0.0f}, 1.0f})
+         .add({{1.5f, 0.0f}, 1.0f})
+         .add({{0.0f, 3.0f}, 2.0f});
+
+    CORRADE_COMPARE_AS(batch.collisions(Shapes::Point2D{{0.9f, 0.0f}}),
+        (std::vector<UnsignedInt>{0, 1, 2}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(batch.collisions(Shapes::Point2D{{0.0f, 1.0f}}),
+        (std::vector<UnsignedInt>{}),
+        TestSuite::Compare::Container);
+}
+
+void SphereBatchTest::collisionSphere() {
+    Shapes::SphereBatch3D batch;
+    batch.add({{}, 1.0f})
+         .add({{3.0f, 0.0f, 0.0f}, 1.0f})
+         .add({{0.0f, 0.0f, 2.5f}, 1.0f});
+
+    CORRADE_COMPARE_AS(batch.collisions(Shapes::Sphere3D{{0.0f, 0.0f, 1.5f}, 0.6f}),
+        (std::vector<UnsignedInt>{0, 2}),
+        TestSuite::Compare::Container);
+}
+
+void SphereBatchTest::collisionMatchesScalar() {
+    Shapes::SphereBatch3D batch;
+    std::vector<Shapes::Sphere3D> spheres;
+    for(Int x = 0; x != 10; ++x) for(Int y = 0; y != 10; ++y) for(Int z = 0; z != 5; ++z) {
+        spheres.emplace_back(Vector3{Float(x), Float(y), Float(z)}*1.3f, 0.1f*(x + y + z));
+        batch.add(spheres.back());
+    }
+
+    const Shapes::Point3D point{{4.1f, 5.3f, 2.2f}};
+    const Shapes::Sphere3D sphere{{6.2f, 2.1f, 3.3f}, 1.1f};
+    std::vector<UnsignedInt> expectedPoint, expectedSphere;
+    for(std::size_t i = 0; i != spheres.size(); ++i) {
+        if(spheres[i] % point) expectedPoint.push_back(UnsignedInt(i));
+        if(spheres[i] % sphere) expectedSphere.push_back(UnsignedInt(i));
+    }
+
+    CORRADE_VERIFY(!expectedPoint.empty());
+    CORRADE_VERIFY(!expectedSphere.empty());
+    CORRADE_COMPARE_AS(batch.collisions(point), expectedPoint,
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(batch.collisions(sphere), expectedSphere,
+        TestSuite::Compare::Container);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Shapes::Test::SphereBatchTest)
@@ -116,6 +116,19 @@ void SphereTest::collisionLine() {
 
     VERIFY_COLLIDES(sphere, line);
     VERIFY_NOT_COLLIDES(sphere, line2);
+
+    /* Collision */
+    const Shapes::Line3D line3({-5.0f, 2.0f, 4.0f}, {5.0f, 2.0f, 4.0f});
+    const Shapes::Collision3D collision = sphere/line3;
+    CORRADE_COMPARE(collision.position(), Vector3(1.0f, 2.0f, 4.0f));
+    CORRADE_COMPARE(collision.separationNormal(), -Vector3::zAxis());
+    CORRADE_COMPARE(collision.separationDistance(), 1.0f);
+
+    /* Collision, flipped */
+    CORRADE_COMPARE(collision.separationNormal(), -(line3/sphere).separationNormal());
+
+    /* No collision */
+    CORRADE_VERIFY(!(sphere/line2));
 }
 
 void SphereTest::collisionLineSegment() {
@@ -125,6 +138,15 @@ void SphereTest::collisionLineSegment() {
 
     VERIFY_COLLIDES(sphere, line);
     VERIFY_NOT_COLLIDES(sphere, line2);
+
+    /* Collision, contact position is the nearer endpoint */
+    const Shapes::Collision3D collision = sphere/line;
+    CORRADE_COMPARE(collision.position(), Vector3(1.0f, 2.0f, 4.9f));
+    CORRADE_COMPARE(collision.separationNormal(), -Vector3::zAxis());
+    CORRADE_COMPARE(collision.separationDistance(), 0.1f);
+
+    /* No collision */
+    CORRADE_VERIFY(!(sphere/line2));
 }
 
 void SphereTest::collisionSphere() {
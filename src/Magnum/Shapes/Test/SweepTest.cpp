@@ -0,0 +1,220 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Shapes/AxisAlignedBox.h"
+#include "Magnum/Shapes/Box.h"
+#include "Magnum/Shapes/Capsule.h"
+#include "Magnum/Shapes/LineSegment.h"
+#include "Magnum/Shapes/Plane.h"
+#include "Magnum/Shapes/Sphere.h"
+#include "Magnum/Shapes/Sweep.h"
+
+namespace Magnum { namespace Shapes { namespace Test {
+
+struct SweepTest: TestSuite::Tester {
+    explicit SweepTest();
+
+    void spherePlane();
+    void sphereLineSegment();
+    void sphereCapsule();
+    void sphereBox();
+    void sphereBoxRotated();
+
+    void axisAlignedBoxPlane();
+    void axisAlignedBoxLineSegment();
+    void axisAlignedBoxCapsule();
+    void axisAlignedBoxBox();
+};
+
+SweepTest::SweepTest() {
+    addTests({&SweepTest::spherePlane,
+              &SweepTest::sphereLineSegment,
+              &SweepTest::sphereCapsule,
+              &SweepTest::sphereBox,
+              &SweepTest::sphereBoxRotated,
+
+              &SweepTest::axisAlignedBoxPlane,
+              &SweepTest::axisAlignedBoxLineSegment,
+              &SweepTest::axisAlignedBoxCapsule,
+              &SweepTest::axisAlignedBoxBox});
+}
+
+void SweepTest::spherePlane() {
+    const Shapes::Plane plane{{}, Vector3::yAxis()};
+
+    /* From both sides */
+    CORRADE_COMPARE(Shapes::timeOfImpact(Shapes::Sphere3D{{0.0f, 5.0f, 0.0f}, 1.0f}, {0.0f, -10.0f, 0.0f}, plane), 0.4f);
+    CORRADE_COMPARE(Shapes::timeOfImpact(Shapes::Sphere3D{{0.0f, -5.0f, 0.0f}, 1.0f}, {3.0f, 8.0f, 0.0f}, plane), 0.5f);
+
+    /* Already touching */
+    CORRADE_COMPARE(Shapes::timeOfImpact(Shapes::Sphere3D{{0.0f, 0.5f, 0.0f}, 1.0f}, {0.0f, 10.0f, 0.0f}, plane), 0.0f);
+
+    /* Moving away, parallel or not far enough */
+    CORRADE_COMPARE(Shapes::timeOfImpact(Shapes::Sphere3D{{0.0f, 5.0f, 0.0f}, 1.0f}, {0.0f, 1.0f, 0.0f}, plane), Constants::inf());
+    CORRADE_COMPARE(Shapes::timeOfImpact(Shapes::Sphere3D{{0.0f, 5.0f, 0.0f}, 1.0f}, {10.0f, 0.0f, 0.0f}, plane), Constants::inf());
+    CORRADE_COMPARE(Shapes::timeOfImpact(Shapes::Sphere3D{{0.0f, 5.0f, 0.0f}, 1.0f}, {0.0f, -3.0f, 0.0f}, plane), Constants::inf());
+}
+
+void SweepTest::sphereLineSegment() {
+    const Shapes::LineSegment2D segment{{-1.0f, 0.0f}, {1.0f, 0.0f}};
+
+    /* Hitting the middle and the endpoint */
+    CORRADE_COMPARE(Shapes::timeOfImpact(Shapes::Sphere2D{{0.0f, 3.0f}, 0.5f}, {0.0f, -5.0f}, segment), 0.5f);
+    CORRADE_COMPARE(Shapes::timeOfImpact(Shapes::Sphere2D{{3.0f, 0.0f}, 0.5f}, {-5.0f, 0.0f}, segment), 0.3f);
+
+    /* Thin segment isn't skipped over even with a large displacement */
+    CORRADE_COMPARE(Shapes::timeOfImpact(Shapes::Sphere2D{{0.0f, 100.0f}, 0.5f}, {0.0f, -200.0f}, segment), 0.4975f);
+
+    /* Already touching */
+    CORRADE_COMPARE(Shapes::timeOfImpact(Shapes::Sphere2D{{0.5f, 0.25f}, 0.5f}, {0.0f, 5.0f}, segment), 0.0f);
+
+    /* Passing by */
+    CORRADE_COMPARE(Shapes::timeOfImpact(Shapes::Sphere2D{{-3.0f, 1.0f}, 0.5f}, {6.0f, 0.0f}, segment), Constants::inf());
+    CORRADE_COMPARE(Shapes::timeOfImpact(Shapes::Sphere2D{{3.0f, 3.0f}, 0.5f}, {1.0f, -5.0f}, segment), Constants::inf());
+}
+
+void SweepTest::sphereCapsule() {
+    const Shapes::Capsule3D capsule{{0.0f, 0.0f, -1.0f}, {0.0f, 0.0f, 1.0f}, 0.5f};
+
+    const Shapes::Sphere3D sphere{{4.0f, 0.0f, 0.0f}, 0.5f};
+    const Vector3 displacement{-4.0f, 0.0f, 0.0f};
+    const Float t = Shapes::timeOfImpact(sphere, displacement, capsule);
+    CORRADE_COMPARE(t, 0.75f);
+
+    /* Verify against static test right before and after the impact */
+    CORRADE_VERIFY(!(capsule % Shapes::Sphere3D{sphere.position() + displacement*(t - 0.01f), sphere.radius()}));
+    CORRADE_VERIFY(capsule % Shapes::Sphere3D(sphere.position() + displacement*(t + 0.01f), sphere.radius()));
+
+    /* Hitting the cap */
+    CORRADE_COMPARE(Shapes::timeOfImpact(Shapes::Sphere3D{{0.0f, 0.0f, 5.0f}, 0.5f}, {0.0f, 0.0f, -6.0f}, capsule), 0.5f);
+
+    /* Missing */
+    CORRADE_COMPARE(Shapes::timeOfImpact(Shapes::Sphere3D{{4.0f, 0.0f, 0.0f}, 0.5f}, {0.0f, 4.0f, 0.0f}, capsule), Constants::inf());
+}
+
+void SweepTest::sphereBox() {
+    /* Box in range [-2, 2] x [-1, 1] x [-1, 1] */
+    const Shapes::Box3D box{Matrix4::scaling({2.0f, 1.0f, 1.0f})};
+
+    /* Face */
+    CORRADE_COMPARE(Shapes::timeOfImpact(Shapes::Sphere3D{{5.0f, 0.0f, 0.0f}, 0.5f}, {-5.0f, 0.0f, 0.0f}, box), 0.5f);
+    CORRADE_COMPARE(Shapes::timeOfImpact(Shapes::Sphere3D{{1.5f, 4.0f, 0.0f}, 0.5f}, {0.0f, -5.0f, 0.0f}, box), 0.5f);
+
+    /* Vertex, the box expanded by the radius would be hit already at 0.8333 */
+    CORRADE_COMPARE(Shapes::timeOfImpact(Shapes::Sphere3D{{5.0f, 4.0f, 4.0f}, 0.5f}, {-3.0f, -3.0f, -3.0f}, box),
+        (Constants::sqrt3()*3.0f - 0.5f)/(Constants::sqrt3()*3.0f));
+
+    /* Already inside */
+    CORRADE_COMPARE(Shapes::timeOfImpact(Shapes::Sphere3D{{1.9f, 0.0f, 0.0f}, 0.5f}, {-5.0f, 0.0f, 0.0f}, box), 0.0f);
+
+    /* Missing the rounded corner of the expanded box */
+    CORRADE_COMPARE(Shapes::timeOfImpact(Shapes::Sphere3D{{2.45f, 1.45f, 5.0f}, 0.5f}, {0.0f, 0.0f, -10.0f}, box), Constants::inf());
+
+    /* Not far enough */
+    CORRADE_COMPARE(Shapes::timeOfImpact(Shapes::Sphere3D{{5.0f, 0.0f, 0.0f}, 0.5f}, {-2.0f, 0.0f, 0.0f}, box), Constants::inf());
+}
+
+void SweepTest::sphereBoxRotated() {
+    /* Unit square rotated by 45°, corner pointing to +X */
+    const Shapes::Box2D box{Matrix3::rotation(Deg(45.0f))};
+    CORRADE_COMPARE(Shapes::timeOfImpact(Shapes::Sphere2D{{5.0f, 0.0f}, 0.5f}, {-5.0f, 0.0f}, box),
+        (5.0f - Constants::sqrt2() - 0.5f)/5.0f);
+
+    /* Unit cube rotated by 45° around Z, edge pointing to +X */
+    const Shapes::Box3D box3D{Matrix4::rotationZ(Deg(45.0f))};
+    CORRADE_COMPARE(Shapes::timeOfImpact(Shapes::Sphere3D{{5.0f, 0.0f, 0.5f}, 0.5f}, {-5.0f, 0.0f, 0.0f}, box3D),
+        (5.0f - Constants::sqrt2() - 0.5f)/5.0f);
+}
+
+void SweepTest::axisAlignedBoxPlane() {
+    const Shapes::Plane plane{{}, Vector3::yAxis()};
+    const Shapes::AxisAlignedBox3D box{{-1.0f, 4.0f, -1.0f}, {1.0f, 6.0f, 1.0f}};
+
+    CORRADE_COMPARE(Shapes::timeOfImpact(box, {0.0f, -10.0f, 0.0f}, plane), 0.4f);
+    CORRADE_COMPARE(Shapes::timeOfImpact(box, {0.0f, 10.0f, 0.0f}, plane), Constants::inf());
+
+    /* Tilted plane, the corner touches it first */
+    const Shapes::Plane tilted{{}, Vector3{1.0f, 1.0f, 0.0f}.normalized()};
+    CORRADE_COMPARE(Shapes::timeOfImpact(box, {-2.0f, -2.0f, 0.0f}, tilted), 0.75f);
+}
+
+void SweepTest::axisAlignedBoxLineSegment() {
+    const Shapes::AxisAlignedBox2D box{{}, {1.0f, 1.0f}};
+    CORRADE_COMPARE(Shapes::timeOfImpact(box, {5.0f, 0.0f}, Shapes::LineSegment2D{{3.0f, -1.0f}, {3.0f, 2.0f}}), 0.4f);
+    CORRADE_COMPARE(Shapes::timeOfImpact(box, {5.0f, 0.0f}, Shapes::LineSegment2D{{3.0f, 2.0f}, {4.0f, 3.0f}}), Constants::inf());
+
+    /* Diagonal segment in 3D */
+    const Shapes::AxisAlignedBox3D box3D{{-3.5f, -0.5f, -0.5f}, {-2.5f, 0.5f, 0.5f}};
+    const Shapes::LineSegment3D segment{{0.0f, -1.0f, -1.0f}, {0.0f, 1.0f, 1.0f}};
+    CORRADE_COMPARE(Shapes::timeOfImpact(box3D, {5.0f, 0.0f, 0.0f}, segment), 0.5f);
+
+    /* Segment passing above the box */
+    const Shapes::LineSegment3D short3D{{0.0f, 1.0f, 0.0f}, {0.0f, 2.0f, 1.0f}};
+    CORRADE_COMPARE(Shapes::timeOfImpact(box3D, {5.0f, 0.0f, 0.0f}, short3D), Constants::inf());
+
+    /* Already overlapping */
+    CORRADE_COMPARE(Shapes::timeOfImpact(box3D, {5.0f, 0.0f, 0.0f}, Shapes::LineSegment3D{{-3.0f, 0.0f, 0.0f}, {5.0f, 0.0f, 0.0f}}), 0.0f);
+}
+
+void SweepTest::axisAlignedBoxCapsule() {
+    const Shapes::Capsule2D capsule{{0.0f, -1.0f}, {0.0f, 1.0f}, 0.5f};
+    const Shapes::AxisAlignedBox2D box{{-3.0f, -0.5f}, {-2.0f, 0.5f}};
+
+    CORRADE_COMPARE(Shapes::timeOfImpact(box, {4.0f, 0.0f}, capsule), 0.375f);
+    CORRADE_COMPARE(Shapes::timeOfImpact(box, {-4.0f, 0.0f}, capsule), Constants::inf());
+    CORRADE_COMPARE(Shapes::timeOfImpact(box, {4.0f, 5.0f}, capsule), Constants::inf());
+    CORRADE_COMPARE(Shapes::timeOfImpact(Shapes::AxisAlignedBox2D{{-0.5f, -0.5f}, {0.5f, 0.5f}}, {4.0f, 0.0f}, capsule), 0.0f);
+
+    /* Approaching the cap diagonally, the result is conservative */
+    const Float t = Shapes::timeOfImpact(Shapes::AxisAlignedBox3D{{-3.0f, 2.0f, -0.5f}, {-2.0f, 3.0f, 0.5f}}, {4.0f, -4.0f, 0.0f},
+        Shapes::Capsule3D{{0.0f, -1.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, 0.5f});
+    CORRADE_VERIFY(t > 0.0f);
+    CORRADE_VERIFY(t <= 1.0f);
+}
+
+void SweepTest::axisAlignedBoxBox() {
+    /* Unit square rotated by 45°, corner pointing to -X */
+    const Shapes::AxisAlignedBox2D box{{-3.0f, -0.5f}, {-2.0f, 0.5f}};
+    const Shapes::Box2D rotated{Matrix3::rotation(Deg(45.0f))};
+    CORRADE_COMPARE(Shapes::timeOfImpact(box, {4.0f, 0.0f}, rotated), (2.0f - Constants::sqrt2())/4.0f);
+    CORRADE_COMPARE(Shapes::timeOfImpact(box, {0.0f, 4.0f}, rotated), Constants::inf());
+
+    /* Cube rotated around Z, approached from above over the edge */
+    const Shapes::AxisAlignedBox3D box3D{{-0.5f, 3.0f, -0.5f}, {0.5f, 4.0f, 0.5f}};
+    const Shapes::Box3D rotated3D{Matrix4::rotationZ(Deg(45.0f))};
+    CORRADE_COMPARE(Shapes::timeOfImpact(box3D, {0.0f, -4.0f, 0.0f}, rotated3D), (3.0f - Constants::sqrt2())/4.0f);
+
+    /* Already overlapping */
+    CORRADE_COMPARE(Shapes::timeOfImpact(box3D, {0.0f, -4.0f, 0.0f}, Shapes::Box3D{Matrix4::translation({0.0f, 3.5f, 0.0f})}), 0.0f);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Shapes::Test::SweepTest)
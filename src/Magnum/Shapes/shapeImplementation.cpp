@@ -25,8 +25,23 @@
 
 #include "shapeImplementation.h"
 
+#include <algorithm>
 #include <Corrade/Utility/Debug.h>
 
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Shapes/AxisAlignedBox.h"
+#include "Magnum/Shapes/Box.h"
+#include "Magnum/Shapes/Capsule.h"
+#include "Magnum/Shapes/Composition.h"
+#include "Magnum/Shapes/Cylinder.h"
+#include "Magnum/Shapes/LineSegment.h"
+#include "Magnum/Shapes/Plane.h"
+#include "Magnum/Shapes/Point.h"
+#include "Magnum/Shapes/Sphere.h"
+
 namespace Magnum { namespace Shapes { namespace Implementation {
 
 Debug& operator<<(Debug& debug, ShapeDimensionTraits<2>::Type value) {
@@ -72,6 +87,345 @@ Debug& operator<<(Debug& debug, ShapeDimensionTraits<3>::Type value) {
     return debug << "Shapes::Shape3D::Type(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
 }
 
+namespace {
+
+template<UnsignedInt dimensions> inline RangeTypeFor<dimensions, Float> unbounded() {
+    return {VectorTypeFor<dimensions, Float>{-Constants::inf()},
+            VectorTypeFor<dimensions, Float>{Constants::inf()}};
+}
+
+}
+
+template<UnsignedInt dimensions> RangeTypeFor<dimensions, Float> bounds(const Shapes::Point<dimensions>& shape) {
+    return {shape.position(), shape.position()};
+}
+
+template<UnsignedInt dimensions> RangeTypeFor<dimensions, Float> bounds(const Shapes::Line<dimensions>&) {
+    return unbounded<dimensions>();
+}
+
+template<UnsignedInt dimensions> RangeTypeFor<dimensions, Float> bounds(const Shapes::LineSegment<dimensions>& shape) {
+    return {Math::min(shape.a(), shape.b()), Math::max(shape.a(), shape.b())};
+}
+
+template<UnsignedInt dimensions> RangeTypeFor<dimensions, Float> bounds(const Shapes::Sphere<dimensions>& shape) {
+    return {shape.position() - VectorTypeFor<dimensions, Float>{shape.radius()},
+            shape.position() + VectorTypeFor<dimensions, Float>{shape.radius()}};
+}
+
+template<UnsignedInt dimensions> RangeTypeFor<dimensions, Float> bounds(const Shapes::InvertedSphere<dimensions>&) {
+    return unbounded<dimensions>();
+}
+
+template<UnsignedInt dimensions> RangeTypeFor<dimensions, Float> bounds(const Shapes::Cylinder<dimensions>&) {
+    return unbounded<dimensions>();
+}
+
+template<UnsignedInt dimensions> RangeTypeFor<dimensions, Float> bounds(const Shapes::Capsule<dimensions>& shape) {
+    return {Math::min(shape.a(), shape.b()) - VectorTypeFor<dimensions, Float>{shape.radius()},
+            Math::max(shape.a(), shape.b()) + VectorTypeFor<dimensions, Float>{shape.radius()}};
+}
+
+template<UnsignedInt dimensions> RangeTypeFor<dimensions, Float> bounds(const Shapes::AxisAlignedBox<dimensions>& shape) {
+    return {Math::min(shape.min(), shape.max()), Math::max(shape.min(), shape.max())};
+}
+
+template<UnsignedInt dimensions> RangeTypeFor<dimensions, Float> bounds(const Shapes::Box<dimensions>& shape) {
+    /* Half extents of the transformed unit box are sums of absolute values of
+       the transformed axes */
+    const MatrixTypeFor<dimensions, Float> transformation = shape.transformation();
+    VectorTypeFor<dimensions, Float> halfExtents;
+    for(UnsignedInt i = 0; i != dimensions; ++i)
+        for(UnsignedInt j = 0; j != dimensions; ++j)
+            halfExtents[j] += Math::abs(transformation[i][j]);
+
+    const VectorTypeFor<dimensions, Float> center = transformation.translation();
+    return {center - halfExtents, center + halfExtents};
+}
+
+Range3D bounds(const Shapes::Plane&) {
+    return unbounded<3>();
+}
+
+template<UnsignedInt dimensions> RangeTypeFor<dimensions, Float> bounds(const Shapes::Composition<dimensions>& shape) {
+    if(!shape.size()) return {};
+    return shape._nodeBounds.front();
+}
+
+template MAGNUM_SHAPES_EXPORT Range2D bounds(const Shapes::Point<2>&);
+template MAGNUM_SHAPES_EXPORT Range3D bounds(const Shapes::Point<3>&);
+template MAGNUM_SHAPES_EXPORT Range2D bounds(const Shapes::Line<2>&);
+template MAGNUM_SHAPES_EXPORT Range3D bounds(const Shapes::Line<3>&);
+template MAGNUM_SHAPES_EXPORT Range2D bounds(const Shapes::LineSegment<2>&);
+template MAGNUM_SHAPES_EXPORT Range3D bounds(const Shapes::LineSegment<3>&);
+template MAGNUM_SHAPES_EXPORT Range2D bounds(const Shapes::Sphere<2>&);
+template MAGNUM_SHAPES_EXPORT Range3D bounds(const Shapes::Sphere<3>&);
+template MAGNUM_SHAPES_EXPORT Range2D bounds(const Shapes::InvertedSphere<2>&);
+template MAGNUM_SHAPES_EXPORT Range3D bounds(const Shapes::InvertedSphere<3>&);
+template MAGNUM_SHAPES_EXPORT Range2D bounds(const Shapes::Cylinder<2>&);
+template MAGNUM_SHAPES_EXPORT Range3D bounds(const Shapes::Cylinder<3>&);
+template MAGNUM_SHAPES_EXPORT Range2D bounds(const Shapes::Capsule<2>&);
+template MAGNUM_SHAPES_EXPORT Range3D bounds(const Shapes::Capsule<3>&);
+template MAGNUM_SHAPES_EXPORT Range2D bounds(const Shapes::AxisAlignedBox<2>&);
+template MAGNUM_SHAPES_EXPORT Range3D bounds(const Shapes::AxisAlignedBox<3>&);
+template MAGNUM_SHAPES_EXPORT Range2D bounds(const Shapes::Box<2>&);
+template MAGNUM_SHAPES_EXPORT Range3D bounds(const Shapes::Box<3>&);
+template MAGNUM_SHAPES_EXPORT Range2D bounds(const Shapes::Composition<2>&);
+template MAGNUM_SHAPES_EXPORT Range3D bounds(const Shapes::Composition<3>&);
+
+namespace {
+
+/* Distance to the first intersection of a ray with given sphere, zero if the
+   origin is inside */
+template<UnsignedInt dimensions> Float raySphere(const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction, const VectorTypeFor<dimensions, Float>& center, const Float radius) {
+    const VectorTypeFor<dimensions, Float> w = origin - center;
+    const Float c = w.dot() - radius*radius;
+    if(c <= 0.0f) return 0.0f;
+
+    const Float b = Math::dot(w, direction);
+    const Float discriminant = b*b - c;
+    if(b >= 0.0f || discriminant < 0.0f) return Constants::inf();
+
+    return -b - std::sqrt(discriminant);
+}
+
+/* Distance to the first intersection of a ray with infinite cylinder around
+   line going through a in direction m, zero if the origin is inside. Solved
+   in the subspace perpendicular to the axis. */
+template<UnsignedInt dimensions> Float rayCylinder(const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction, const VectorTypeFor<dimensions, Float>& a, const VectorTypeFor<dimensions, Float>& m, const Float radius) {
+    const Float mm = m.dot();
+    const VectorTypeFor<dimensions, Float> w = origin - a;
+    const VectorTypeFor<dimensions, Float> wPerpendicular = w - m*(Math::dot(w, m)/mm);
+    const VectorTypeFor<dimensions, Float> directionPerpendicular = direction - m*(Math::dot(direction, m)/mm);
+
+    const Float c = wPerpendicular.dot() - radius*radius;
+    if(c <= 0.0f) return 0.0f;
+
+    const Float qa = directionPerpendicular.dot();
+    const Float qb = Math::dot(wPerpendicular, directionPerpendicular);
+    const Float discriminant = qb*qb - qa*c;
+    if(qa == 0.0f || qb >= 0.0f || discriminant < 0.0f) return Constants::inf();
+
+    return (-qb - std::sqrt(discriminant))/qa;
+}
+
+/* Slab test against axis-aligned box, fills normal of the entered face or
+   negative direction if the origin is inside */
+template<UnsignedInt dimensions> Float raySlabs(const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction, const VectorTypeFor<dimensions, Float>& min, const VectorTypeFor<dimensions, Float>& max, VectorTypeFor<dimensions, Float>& normal) {
+    Float enter = -Constants::inf(), exit = Constants::inf();
+    UnsignedInt axis = 0;
+    Float sign = 0.0f;
+    for(UnsignedInt i = 0; i != dimensions; ++i) {
+        if(direction[i] == 0.0f) {
+            if(origin[i] < min[i] || origin[i] > max[i]) return Constants::inf();
+            continue;
+        }
+
+        Float t0 = (min[i] - origin[i])/direction[i];
+        Float t1 = (max[i] - origin[i])/direction[i];
+        Float s = -1.0f;
+        if(t0 > t1) {
+            std::swap(t0, t1);
+            s = 1.0f;
+        }
+
+        if(t0 > enter) {
+            enter = t0;
+            axis = i;
+            sign = s;
+        }
+        exit = Math::min(exit, t1);
+    }
+
+    if(enter > exit || exit < 0.0f) return Constants::inf();
+
+    if(enter <= 0.0f) {
+        normal = -direction;
+        return 0.0f;
+    }
+
+    normal = {};
+    normal[axis] = sign;
+    return enter;
+}
+
+/* Lines can be hit only in 2D */
+Float rayLine(const Vector2& origin, const Vector2& direction, const Vector2& a, const Vector2& b, const bool segment, Vector2& normal) {
+    const Vector2 m = b - a;
+    const Float denominator = Math::cross(direction, m);
+    if(denominator == 0.0f) return Constants::inf();
+
+    const Vector2 w = a - origin;
+    const Float t = Math::cross(w, m)/denominator;
+    const Float s = Math::cross(w, direction)/denominator;
+    if(t < 0.0f || (segment && (s < 0.0f || s > 1.0f))) return Constants::inf();
+
+    normal = m.perpendicular().normalized();
+    if(Math::dot(normal, direction) > 0.0f) normal = -normal;
+    return t;
+}
+
+Float rayLine(const Vector3&, const Vector3&, const Vector3&, const Vector3&, bool, Vector3&) {
+    return Constants::inf();
+}
+
+}
+
+template<UnsignedInt dimensions> Float raycast(const Shapes::Point<dimensions>&, const VectorTypeFor<dimensions, Float>&, const VectorTypeFor<dimensions, Float>&, VectorTypeFor<dimensions, Float>&) {
+    return Constants::inf();
+}
+
+template<UnsignedInt dimensions> Float raycast(const Shapes::Line<dimensions>& shape, const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction, VectorTypeFor<dimensions, Float>& normal) {
+    return rayLine(origin, direction, shape.a(), shape.b(), false, normal);
+}
+
+template<UnsignedInt dimensions> Float raycast(const Shapes::LineSegment<dimensions>& shape, const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction, VectorTypeFor<dimensions, Float>& normal) {
+    return rayLine(origin, direction, shape.a(), shape.b(), true, normal);
+}
+
+template<UnsignedInt dimensions> Float raycast(const Shapes::Sphere<dimensions>& shape, const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction, VectorTypeFor<dimensions, Float>& normal) {
+    const Float t = raySphere<dimensions>(origin, direction, shape.position(), shape.radius());
+    if(t == 0.0f) normal = -direction;
+    else if(t != Constants::inf()) normal = (origin + direction*t - shape.position()).normalized();
+    return t;
+}
+
+template<UnsignedInt dimensions> Float raycast(const Shapes::InvertedSphere<dimensions>& shape, const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction, VectorTypeFor<dimensions, Float>& normal) {
+    /* The solid part is outside of the sphere */
+    const VectorTypeFor<dimensions, Float> w = origin - shape.position();
+    const Float c = w.dot() - shape.radius()*shape.radius();
+    if(c >= 0.0f) {
+        normal = -direction;
+        return 0.0f;
+    }
+
+    /* Exiting the sphere from inside, the discriminant is always positive */
+    const Float b = Math::dot(w, direction);
+    const Float t = -b + std::sqrt(b*b - c);
+    normal = (shape.position() - origin - direction*t).normalized();
+    return t;
+}
+
+template<UnsignedInt dimensions> Float raycast(const Shapes::Cylinder<dimensions>& shape, const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction, VectorTypeFor<dimensions, Float>& normal) {
+    const VectorTypeFor<dimensions, Float> m = shape.b() - shape.a();
+    const Float t = rayCylinder<dimensions>(origin, direction, shape.a(), m, shape.radius());
+    if(t == 0.0f) normal = -direction;
+    else if(t != Constants::inf()) {
+        const VectorTypeFor<dimensions, Float> w = origin + direction*t - shape.a();
+        normal = (w - m*(Math::dot(w, m)/m.dot())).normalized();
+    }
+    return t;
+}
+
+template<UnsignedInt dimensions> Float raycast(const Shapes::Capsule<dimensions>& shape, const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction, VectorTypeFor<dimensions, Float>& normal) {
+    const VectorTypeFor<dimensions, Float> m = shape.b() - shape.a();
+    const Float mm = m.dot();
+
+    /* Hemispherical caps */
+    Float t = Math::min(raySphere<dimensions>(origin, direction, shape.a(), shape.radius()),
+                        raySphere<dimensions>(origin, direction, shape.b(), shape.radius()));
+
+    /* Cylindrical part, valid only between the caps */
+    if(t != 0.0f && mm != 0.0f) {
+        const Float tc = rayCylinder<dimensions>(origin, direction, shape.a(), m, shape.radius());
+        if(tc != Constants::inf()) {
+            const Float s = Math::dot(origin + direction*tc - shape.a(), m)/mm;
+            if(s >= 0.0f && s <= 1.0f) t = Math::min(t, tc);
+        }
+    }
+
+    if(t == 0.0f) normal = -direction;
+    else if(t != Constants::inf()) {
+        const VectorTypeFor<dimensions, Float> p = origin + direction*t;
+        const Float s = mm == 0.0f ? 0.0f : Math::clamp(Math::dot(p - shape.a(), m)/mm, 0.0f, 1.0f);
+        normal = (p - shape.a() - m*s).normalized();
+    }
+    return t;
+}
+
+template<UnsignedInt dimensions> Float raycast(const Shapes::AxisAlignedBox<dimensions>& shape, const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction, VectorTypeFor<dimensions, Float>& normal) {
+    return raySlabs<dimensions>(origin, direction, Math::min(shape.min(), shape.max()), Math::max(shape.min(), shape.max()), normal);
+}
+
+template<UnsignedInt dimensions> Float raycast(const Shapes::Box<dimensions>& shape, const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction, VectorTypeFor<dimensions, Float>& normal) {
+    /* The transformation is affine, so distances along the ray stay the same
+       in the box-local coordinate system */
+    const MatrixTypeFor<dimensions, Float> inverse = shape.transformation().inverted();
+    VectorTypeFor<dimensions, Float> localNormal;
+    const Float t = raySlabs<dimensions>(inverse.transformPoint(origin), inverse.transformVector(direction), VectorTypeFor<dimensions, Float>{-1.0f}, VectorTypeFor<dimensions, Float>{1.0f}, localNormal);
+
+    if(t == 0.0f) normal = -direction;
+    else if(t != Constants::inf())
+        normal = (inverse.rotationScaling().transposed()*localNormal).normalized();
+    return t;
+}
+
+Float raycast(const Shapes::Plane& shape, const Vector3& origin, const Vector3& direction, Vector3& normal) {
+    const Float denominator = Math::dot(shape.normal(), direction);
+    if(denominator == 0.0f) return Constants::inf();
+
+    const Float t = Math::dot(shape.position() - origin, shape.normal())/denominator;
+    if(t < 0.0f) return Constants::inf();
+
+    /* The plane is two-sided */
+    normal = shape.normal().normalized();
+    if(denominator > 0.0f) normal = -normal;
+    return t;
+}
+
+template<UnsignedInt dimensions> Float raycast(const Shapes::Composition<dimensions>& shape, const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction, VectorTypeFor<dimensions, Float>& normal) {
+    if(!shape.size()) return Constants::inf();
+
+    if(shape.collides(Shape<Shapes::Point<dimensions>>{origin})) {
+        normal = -direction;
+        return 0.0f;
+    }
+
+    /* Hits of all subshapes, ordered by distance */
+    std::vector<std::pair<Float, VectorTypeFor<dimensions, Float>>> hits;
+    for(std::size_t i = 0; i != shape.size(); ++i) {
+        VectorTypeFor<dimensions, Float> n;
+        const Float t = shape._shapes[i]->raycast(origin, direction, n);
+        if(t != Constants::inf()) hits.emplace_back(t, n);
+    }
+    std::sort(hits.begin(), hits.end(), [](const std::pair<Float, VectorTypeFor<dimensions, Float>>& a, const std::pair<Float, VectorTypeFor<dimensions, Float>>& b) {
+        return a.first < b.first;
+    });
+
+    /* First hit that gets the ray inside the whole composition */
+    for(const std::pair<Float, VectorTypeFor<dimensions, Float>>& hit: hits) {
+        const Float offset = Math::TypeTraits<Float>::epsilon()*Math::max(hit.first, 1.0f);
+        if(!shape.collides(Shape<Shapes::Point<dimensions>>{origin + direction*(hit.first + offset)}))
+            continue;
+
+        normal = hit.second;
+        return hit.first;
+    }
+
+    return Constants::inf();
+}
+
+template MAGNUM_SHAPES_EXPORT Float raycast(const Shapes::Point<2>&, const Vector2&, const Vector2&, Vector2&);
+template MAGNUM_SHAPES_EXPORT Float raycast(const Shapes::Point<3>&, const Vector3&, const Vector3&, Vector3&);
+template MAGNUM_SHAPES_EXPORT Float raycast(const Shapes::Line<2>&, const Vector2&, const Vector2&, Vector2&);
+template MAGNUM_SHAPES_EXPORT Float raycast(const Shapes::Line<3>&, const Vector3&, const Vector3&, Vector3&);
+template MAGNUM_SHAPES_EXPORT Float raycast(const Shapes::LineSegment<2>&, const Vector2&, const Vector2&, Vector2&);
+template MAGNUM_SHAPES_EXPORT Float raycast(const Shapes::LineSegment<3>&, const Vector3&, const Vector3&, Vector3&);
+template MAGNUM_SHAPES_EXPORT Float raycast(const Shapes::Sphere<2>&, const Vector2&, const Vector2&, Vector2&);
+template MAGNUM_SHAPES_EXPORT Float raycast(const Shapes::Sphere<3>&, const Vector3&, const Vector3&, Vector3&);
+template MAGNUM_SHAPES_EXPORT Float raycast(const Shapes::InvertedSphere<2>&, const Vector2&, const Vector2&, Vector2&);
+template MAGNUM_SHAPES_EXPORT Float raycast(const Shapes::InvertedSphere<3>&, const Vector3&, const Vector3&, Vector3&);
+template MAGNUM_SHAPES_EXPORT Float raycast(const Shapes::Cylinder<2>&, const Vector2&, const Vector2&, Vector2&);
+template MAGNUM_SHAPES_EXPORT Float raycast(const Shapes::Cylinder<3>&, const Vector3&, const Vector3&, Vector3&);
+template MAGNUM_SHAPES_EXPORT Float raycast(const Shapes::Capsule<2>&, const Vector2&, const Vector2&, Vector2&);
+template MAGNUM_SHAPES_EXPORT Float raycast(const Shapes::Capsule<3>&, const Vector3&, const Vector3&, Vector3&);
+template MAGNUM_SHAPES_EXPORT Float raycast(const Shapes::AxisAlignedBox<2>&, const Vector2&, const Vector2&, Vector2&);
+template MAGNUM_SHAPES_EXPORT Float raycast(const Shapes::AxisAlignedBox<3>&, const Vector3&, const Vector3&, Vector3&);
+template MAGNUM_SHAPES_EXPORT Float raycast(const Shapes::Box<2>&, const Vector2&, const Vector2&, Vector2&);
+template MAGNUM_SHAPES_EXPORT Float raycast(const Shapes::Box<3>&, const Vector3&, const Vector3&, Vector3&);
+template MAGNUM_SHAPES_EXPORT Float raycast(const Shapes::Composition<2>&, const Vector2&, const Vector2&, Vector2&);
+template MAGNUM_SHAPES_EXPORT Float raycast(const Shapes::Composition<3>&, const Vector3&, const Vector3&, Vector3&);
+
 template<UnsignedInt dimensions> AbstractShape<dimensions>::~AbstractShape() = default;
 template<UnsignedInt dimensions> AbstractShape<dimensions>::AbstractShape() = default;
 
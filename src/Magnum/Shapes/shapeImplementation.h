@@ -30,6 +30,7 @@
 
 #include "Magnum/DimensionTraits.h"
 #include "Magnum/Magnum.h"
+#include "Magnum/Math/Range.h"
 #include "Magnum/Shapes/Shapes.h"
 #include "Magnum/Shapes/visibility.h"
 
@@ -46,6 +47,9 @@ namespace Magnum { namespace Shapes { namespace Implementation {
     4.  Add the enum value to (documentation-only) enum in Composition
     5.  Update doc/shapes.dox with new type
 
+    6.  Add bounds() and raycast() overloads below and implement them in
+        shapeImplementation.cpp
+
     Adding new collision detection implementation:
 
     1.  Update Implementation/CollisionDispatch.cpp with newly implemented
@@ -150,6 +154,41 @@ template<UnsignedInt dimensions> struct TypeOf<Shapes::Composition<dimensions>>
     }
 };
 
+/* Axis-aligned bounds of a shape, used for broad-phase collision detection.
+   The bounds are conservative, unbounded shapes return a range spanning the
+   whole space. */
+
+template<UnsignedInt dimensions> MAGNUM_SHAPES_EXPORT RangeTypeFor<dimensions, Float> bounds(const Shapes::Point<dimensions>& shape);
+template<UnsignedInt dimensions> MAGNUM_SHAPES_EXPORT RangeTypeFor<dimensions, Float> bounds(const Shapes::Line<dimensions>& shape);
+template<UnsignedInt dimensions> MAGNUM_SHAPES_EXPORT RangeTypeFor<dimensions, Float> bounds(const Shapes::LineSegment<dimensions>& shape);
+template<UnsignedInt dimensions> MAGNUM_SHAPES_EXPORT RangeTypeFor<dimensions, Float> bounds(const Shapes::Sphere<dimensions>& shape);
+template<UnsignedInt dimensions> MAGNUM_SHAPES_EXPORT RangeTypeFor<dimensions, Float> bounds(const Shapes::InvertedSphere<dimensions>& shape);
+template<UnsignedInt dimensions> MAGNUM_SHAPES_EXPORT RangeTypeFor<dimensions, Float> bounds(const Shapes::Cylinder<dimensions>& shape);
+template<UnsignedInt dimensions> MAGNUM_SHAPES_EXPORT RangeTypeFor<dimensions, Float> bounds(const Shapes::Capsule<dimensions>& shape);
+template<UnsignedInt dimensions> MAGNUM_SHAPES_EXPORT RangeTypeFor<dimensions, Float> bounds(const Shapes::AxisAlignedBox<dimensions>& shape);
+template<UnsignedInt dimensions> MAGNUM_SHAPES_EXPORT RangeTypeFor<dimensions, Float> bounds(const Shapes::Box<dimensions>& shape);
+MAGNUM_SHAPES_EXPORT Range3D bounds(const Shapes::Plane& shape);
+template<UnsignedInt dimensions> MAGNUM_SHAPES_EXPORT RangeTypeFor<dimensions, Float> bounds(const Shapes::Composition<dimensions>& shape);
+
+/* Ray casting. Returns distance from origin along the normalized direction to
+   the point where the ray enters the shape and fills the surface normal at
+   that point, or returns infinity if the shape isn't hit. If the origin is
+   inside the shape, returns zero with normal opposite to the direction.
+   Points and 3D lines are never hit, as well as shapes parallel to the ray.
+   Only entry points of shapes are considered for compositions. */
+
+template<UnsignedInt dimensions> MAGNUM_SHAPES_EXPORT Float raycast(const Shapes::Point<dimensions>& shape, const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction, VectorTypeFor<dimensions, Float>& normal);
+template<UnsignedInt dimensions> MAGNUM_SHAPES_EXPORT Float raycast(const Shapes::Line<dimensions>& shape, const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction, VectorTypeFor<dimensions, Float>& normal);
+template<UnsignedInt dimensions> MAGNUM_SHAPES_EXPORT Float raycast(const Shapes::LineSegment<dimensions>& shape, const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction, VectorTypeFor<dimensions, Float>& normal);
+template<UnsignedInt dimensions> MAGNUM_SHAPES_EXPORT Float raycast(const Shapes::Sphere<dimensions>& shape, const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction, VectorTypeFor<dimensions, Float>& normal);
+template<UnsignedInt dimensions> MAGNUM_SHAPES_EXPORT Float raycast(const Shapes::InvertedSphere<dimensions>& shape, const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction, VectorTypeFor<dimensions, Float>& normal);
+template<UnsignedInt dimensions> MAGNUM_SHAPES_EXPORT Float raycast(const Shapes::Cylinder<dimensions>& shape, const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction, VectorTypeFor<dimensions, Float>& normal);
+template<UnsignedInt dimensions> MAGNUM_SHAPES_EXPORT Float raycast(const Shapes::Capsule<dimensions>& shape, const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction, VectorTypeFor<dimensions, Float>& normal);
+template<UnsignedInt dimensions> MAGNUM_SHAPES_EXPORT Float raycast(const Shapes::AxisAlignedBox<dimensions>& shape, const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction, VectorTypeFor<dimensions, Float>& normal);
+template<UnsignedInt dimensions> MAGNUM_SHAPES_EXPORT Float raycast(const Shapes::Box<dimensions>& shape, const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction, VectorTypeFor<dimensions, Float>& normal);
+MAGNUM_SHAPES_EXPORT Float raycast(const Shapes::Plane& shape, const Vector3& origin, const Vector3& direction, Vector3& normal);
+template<UnsignedInt dimensions> MAGNUM_SHAPES_EXPORT Float raycast(const Shapes::Composition<dimensions>& shape, const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction, VectorTypeFor<dimensions, Float>& normal);
+
 /* Polymorphic shape wrappers */
 
 template<UnsignedInt dimensions> struct MAGNUM_SHAPES_EXPORT AbstractShape {
@@ -159,6 +198,9 @@ template<UnsignedInt dimensions> struct MAGNUM_SHAPES_EXPORT AbstractShape {
     virtual typename ShapeDimensionTraits<dimensions>::Type MAGNUM_SHAPES_LOCAL type() const = 0;
     virtual AbstractShape<dimensions> MAGNUM_SHAPES_LOCAL * clone() const = 0;
     virtual void MAGNUM_SHAPES_LOCAL transform(const MatrixTypeFor<dimensions, Float>& matrix, AbstractShape<dimensions>* result) const = 0;
+    virtual void MAGNUM_SHAPES_LOCAL translate(const VectorTypeFor<dimensions, Float>& translation, AbstractShape<dimensions>* result) const = 0;
+    virtual RangeTypeFor<dimensions, Float> MAGNUM_SHAPES_LOCAL bounds() const = 0;
+    virtual Float MAGNUM_SHAPES_LOCAL raycast(const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction, VectorTypeFor<dimensions, Float>& normal) const = 0;
 };
 
 template<class T> struct Shape: AbstractShape<T::Dimensions> {
@@ -180,6 +222,19 @@ template<class T> struct Shape: AbstractShape<T::Dimensions> {
         CORRADE_INTERNAL_ASSERT(result->type() == type());
         static_cast<Shape<T>*>(result)->shape = shape.transformed(matrix);
     }
+
+    void translate(const VectorTypeFor<T::Dimensions, Float>& translation, AbstractShape<T::Dimensions>* result) const override {
+        CORRADE_INTERNAL_ASSERT(result->type() == type());
+        static_cast<Shape<T>*>(result)->shape = shape.translated(translation);
+    }
+
+    RangeTypeFor<T::Dimensions, Float> bounds() const override {
+        return Implementation::bounds(shape);
+    }
+
+    Float raycast(const VectorTypeFor<T::Dimensions, Float>& origin, const VectorTypeFor<T::Dimensions, Float>& direction, VectorTypeFor<T::Dimensions, Float>& normal) const override {
+        return Implementation::raycast(shape, origin, direction, normal);
+    }
 };
 
 }}}
@@ -0,0 +1,322 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "SparseTextureStreamer.h"
+
+#include <algorithm>
+#include <unordered_map>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Texture.h"
+#include "Magnum/TextureArray.h"
+#include "Magnum/TextureUploadQueue.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Vector3.h"
+
+namespace Magnum {
+
+namespace {
+
+struct Entry {
+    UnsignedInt lastUsed;
+    bool resident;
+};
+
+/* Upload IDs of the mip tail map to this key */
+constexpr UnsignedLong TailKey = ~UnsignedLong{};
+
+UnsignedLong pageKey(const SparseTextureStreamer::Page& page) {
+    return UnsignedLong(page.level) << 56 | UnsignedLong(page.layer) << 40 | UnsignedLong(page.position.y()) << 20 | UnsignedLong(page.position.x());
+}
+
+SparseTextureStreamer::Page pageFromKey(const UnsignedLong key) {
+    return {{Int(key & 0xfffff), Int((key >> 20) & 0xfffff)}, Int(key >> 56), Int((key >> 40) & 0xffff)};
+}
+
+}
+
+struct SparseTextureStreamer::State {
+    explicit State(Texture2D* texture, Texture2DArray* textureArray, TextureUploadQueue& queue): texture{texture}, textureArray{textureArray}, queue(queue) {}
+
+    Texture2D* texture;
+    Texture2DArray* textureArray;
+    TextureUploadQueue& queue;
+    Vector3i size;
+    Int levelCount, tailLevel;
+    Vector2i pageSize;
+    PixelFormat format;
+    PixelType type;
+    std::size_t maxResidentPages;
+    Decoder decoder;
+
+    std::unordered_map<UnsignedLong, Entry> pages;
+    std::unordered_map<UnsignedInt, UnsignedLong> uploads;
+    std::size_t residentCount{}, pendingCount{}, pendingTailUploads{};
+    UnsignedInt frame{1};
+
+    /* Resident pages not used in the current frame, sorted from the most
+       recently used, built lazily once per frame */
+    std::vector<std::pair<UnsignedInt, UnsignedLong>> evictionCandidates;
+    bool evictionCandidatesValid{};
+
+    /* One byte for every page of every level outside of the mip tail, for
+       all layers, and offsets of the levels in it */
+    Containers::Array<UnsignedByte> residency;
+    Containers::Array<std::size_t> residencyOffsets;
+    Containers::Array<char> minLevels;
+    bool minLevelsDirty{true};
+
+    Vector2i levelSize(Int level) const {
+        return Math::max(size.xy() >> level, Vector2i{1});
+    }
+
+    Vector2i pageCount(Int level) const {
+        return (levelSize(level) + pageSize - Vector2i{1})/pageSize;
+    }
+
+    UnsignedByte& residencyFor(const Page& page) {
+        return residency[residencyOffsets[page.layer*tailLevel + page.level] + page.position.y()*pageCount(page.level).x() + page.position.x()];
+    }
+
+    UnsignedInt upload(Int level, Int layer, const Vector2i& offset, const Vector2i& size, const Page& page);
+    void commitPage(const Page& page);
+    bool makeRoom();
+    void updateMinLevels();
+};
+
+UnsignedInt SparseTextureStreamer::State::upload(const Int level, const Int layer, const Vector2i& offset, const Vector2i& size, const Page& page) {
+    Decoder pageDecoder = decoder;
+    TextureUploadQueue::Decoder uploadDecoder = [pageDecoder, page](Containers::ArrayView<char> data) {
+        pageDecoder(page, data);
+    };
+
+    if(texture) {
+        texture->commitPages(level, offset, size);
+        return queue.enqueue(*texture, level, offset, format, type, size, std::move(uploadDecoder));
+    }
+
+    textureArray->commitPages(level, {offset, layer}, {size, 1});
+    return queue.enqueue(*textureArray, level, {offset, layer}, format, type, size, std::move(uploadDecoder));
+}
+
+void SparseTextureStreamer::State::commitPage(const Page& page) {
+    /* Pages on the level edge are cropped to the level size */
+    const Vector2i offset = page.position*pageSize;
+    const UnsignedInt id = upload(page.level, page.layer, offset, Math::min(pageSize, levelSize(page.level) - offset), page);
+
+    pages.emplace(pageKey(page), Entry{frame, false});
+    uploads.emplace(id, pageKey(page));
+    ++pendingCount;
+}
+
+bool SparseTextureStreamer::State::makeRoom() {
+    if(residentCount + pendingCount < maxResidentPages) return true;
+
+    if(!evictionCandidatesValid) {
+        evictionCandidates.clear();
+        for(const std::pair<const UnsignedLong, Entry>& page: pages)
+            if(page.second.resident && page.second.lastUsed != frame)
+                evictionCandidates.emplace_back(page.second.lastUsed, page.first);
+        std::sort(evictionCandidates.begin(), evictionCandidates.end(),
+            [](const std::pair<UnsignedInt, UnsignedLong>& a, const std::pair<UnsignedInt, UnsignedLong>& b) {
+                return a.first > b.first;
+            });
+        evictionCandidatesValid = true;
+    }
+
+    /* Pages requested again in this frame after building the list are
+       skipped */
+    while(!evictionCandidates.empty()) {
+        const UnsignedLong key = evictionCandidates.back().second;
+        evictionCandidates.pop_back();
+
+        auto found = pages.find(key);
+        if(found == pages.end() || found->second.lastUsed == frame) continue;
+
+        const Page page = pageFromKey(key);
+        const Vector2i offset = page.position*pageSize;
+        const Vector2i size = Math::min(pageSize, levelSize(page.level) - offset);
+        if(texture) texture->decommitPages(page.level, offset, size);
+        else textureArray->decommitPages(page.level, {offset, page.layer}, {size, 1});
+
+        residencyFor(page) = 0;
+        pages.erase(found);
+        --residentCount;
+        minLevelsDirty = true;
+        return true;
+    }
+
+    return false;
+}
+
+void SparseTextureStreamer::State::updateMinLevels() {
+    const Vector2i firstPageCount = pageCount(0);
+    const std::size_t firstPageCountTotal = firstPageCount.product();
+
+    for(Int layer = 0; layer != size.z(); ++layer) {
+        char* const out = minLevels + layer*firstPageCountTotal;
+
+        /* Start from the mip tail and go finer as long as the pages covering
+           the area are resident */
+        for(Int y = 0; y != firstPageCount.y(); ++y) for(Int x = 0; x != firstPageCount.x(); ++x) {
+            Int level = tailLevel;
+            while(level && residencyFor(Page{{x >> (level - 1), y >> (level - 1)}, level - 1, layer}))
+                --level;
+            out[y*firstPageCount.x() + x] = char(level);
+        }
+    }
+
+    minLevelsDirty = false;
+}
+
+SparseTextureStreamer::SparseTextureStreamer(Texture2D& texture, TextureUploadQueue& queue, const Vector2i& size, const Int levelCount, const Vector2i& pageSize, const PixelFormat format, const PixelType type, const std::size_t maxResidentPages, Decoder decoder): SparseTextureStreamer{&texture, nullptr, queue, {size, 1}, levelCount, pageSize, format, type, maxResidentPages, std::move(decoder)} {}
+
+SparseTextureStreamer::SparseTextureStreamer(Texture2DArray& texture, TextureUploadQueue& queue, const Vector3i& size, const Int levelCount, const Vector2i& pageSize, const PixelFormat format, const PixelType type, const std::size_t maxResidentPages, Decoder decoder): SparseTextureStreamer{nullptr, &texture, queue, size, levelCount, pageSize, format, type, maxResidentPages, std::move(decoder)} {}
+
+SparseTextureStreamer::SparseTextureStreamer(Texture2D* const texture, Texture2DArray* const textureArray, TextureUploadQueue& queue, const Vector3i& size, const Int levelCount, const Vector2i& pageSize, const PixelFormat format, const PixelType type, const std::size_t maxResidentPages, Decoder&& decoder): _state{new State{texture, textureArray, queue}} {
+    CORRADE_ASSERT(maxResidentPages, "SparseTextureStreamer: expected non-zero resident page count", );
+    CORRADE_ASSERT(Implementation::imageDataSize(ImageView2D{format, type, pageSize}) <= queue.slotSize(),
+        "SparseTextureStreamer: page data size" << Implementation::imageDataSize(ImageView2D{format, type, pageSize}) << "doesn't fit into slot size" << queue.slotSize(), );
+
+    State& state = *_state;
+    state.size = size;
+    state.levelCount = levelCount;
+    state.pageSize = pageSize;
+    state.format = format;
+    state.type = type;
+    state.maxResidentPages = maxResidentPages;
+    state.decoder = std::move(decoder);
+
+    /* Mip tail starts with the first level smaller than a page */
+    state.tailLevel = 0;
+    while(state.tailLevel != levelCount && (state.levelSize(state.tailLevel) >= pageSize).all())
+        ++state.tailLevel;
+
+    /* Residency bytes for all levels outside of the tail, for all layers */
+    state.residencyOffsets = Containers::Array<std::size_t>{std::size_t(state.tailLevel*size.z())};
+    std::size_t residencySize = 0;
+    for(Int layer = 0; layer != size.z(); ++layer) for(Int level = 0; level != state.tailLevel; ++level) {
+        state.residencyOffsets[layer*state.tailLevel + level] = residencySize;
+        residencySize += state.pageCount(level).product();
+    }
+    state.residency = Containers::Array<UnsignedByte>{Containers::ValueInit, residencySize};
+    state.minLevels = Containers::Array<char>{Containers::ValueInit, std::size_t(state.pageCount(0).product()*size.z())};
+
+    /* Commit and upload the whole mip tail */
+    for(Int layer = 0; layer != size.z(); ++layer) for(Int level = state.tailLevel; level != levelCount; ++level) {
+        const UnsignedInt id = state.upload(level, layer, {}, state.levelSize(level), Page{{}, level, layer});
+        state.uploads.emplace(id, TailKey);
+        ++state.pendingTailUploads;
+    }
+
+    state.updateMinLevels();
+}
+
+SparseTextureStreamer::~SparseTextureStreamer() = default;
+
+Vector2i SparseTextureStreamer::pageSize() const { return _state->pageSize; }
+
+Int SparseTextureStreamer::tailLevel() const { return _state->tailLevel; }
+
+std::size_t SparseTextureStreamer::maxResidentPages() const { return _state->maxResidentPages; }
+
+std::size_t SparseTextureStreamer::residentPageCount() const { return _state->residentCount; }
+
+std::size_t SparseTextureStreamer::pendingPageCount() const { return _state->pendingCount; }
+
+bool SparseTextureStreamer::isResident(const Page& page) const {
+    if(page.level >= _state->tailLevel) return !_state->pendingTailUploads;
+    return _state->residencyFor(page);
+}
+
+void SparseTextureStreamer::request(const Containers::ArrayView<const Page> pages) {
+    State& state = *_state;
+
+    for(const Page& page: pages) {
+        CORRADE_ASSERT(page.level >= 0 && page.level < state.levelCount && page.layer >= 0 && page.layer < state.size.z() && (page.position >= Vector2i{0}).all() && (page.position < state.pageCount(page.level)).all(),
+            "SparseTextureStreamer::request(): page" << page.position << "in level" << page.level << "and layer" << page.layer << "out of range", );
+
+        /* Go from the coarsest level so the fallbacks get committed first if
+           there's not enough room */
+        for(Int level = state.tailLevel - 1; level >= page.level; --level) {
+            const Page current{page.position >> (level - page.level), level, page.layer};
+
+            auto found = state.pages.find(pageKey(current));
+            if(found != state.pages.end()) {
+                found->second.lastUsed = state.frame;
+                continue;
+            }
+
+            if(!state.makeRoom()) break;
+            state.commitPage(current);
+        }
+    }
+}
+
+void SparseTextureStreamer::request(std::initializer_list<Page> pages) {
+    request(Containers::arrayView(pages.begin(), pages.size()));
+}
+
+void SparseTextureStreamer::update(const Containers::ArrayView<const UnsignedInt> completedUploads) {
+    State& state = *_state;
+
+    for(const UnsignedInt id: completedUploads) {
+        auto found = state.uploads.find(id);
+        if(found == state.uploads.end()) continue;
+
+        if(found->second == TailKey) --state.pendingTailUploads;
+        else {
+            state.pages.at(found->second).resident = true;
+            state.residencyFor(pageFromKey(found->second)) = 1;
+            --state.pendingCount;
+            ++state.residentCount;
+        }
+
+        state.uploads.erase(found);
+        state.minLevelsDirty = true;
+    }
+
+    if(state.minLevelsDirty) state.updateMinLevels();
+
+    ++state.frame;
+    state.evictionCandidatesValid = false;
+}
+
+void SparseTextureStreamer::update(const std::vector<UnsignedInt>& completedUploads) {
+    update(Containers::ArrayView<const UnsignedInt>{completedUploads.data(), completedUploads.size()});
+}
+
+ImageView2D SparseTextureStreamer::minLevelTable(const Int layer) const {
+    CORRADE_ASSERT(layer >= 0 && layer < _state->size.z(),
+        "SparseTextureStreamer::minLevelTable(): layer" << layer << "out of range for" << _state->size.z() << "layers", (ImageView2D{PixelFormat::RedInteger, PixelType::UnsignedByte, {}}));
+
+    const Vector2i pageCount = _state->pageCount(0);
+    return ImageView2D{PixelStorage{}.setAlignment(1), PixelFormat::RedInteger, PixelType::UnsignedByte, pageCount,
+        _state->minLevels.slice(layer*pageCount.product(), (layer + 1)*pageCount.product())};
+}
+
+}
@@ -0,0 +1,249 @@
+#ifndef Magnum_SparseTextureStreamer_h
+#define Magnum_SparseTextureStreamer_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef MAGNUM_TARGET_GLES
+/** @file
+ * @brief Class @ref Magnum::SparseTextureStreamer
+ */
+#endif
+
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/Math/Vector2.h"
+#include "Magnum/visibility.h"
+
+#ifndef MAGNUM_TARGET_GLES
+namespace Magnum {
+
+/**
+@brief Feedback-driven page streaming for sparse textures
+
+Keeps only the pages of a sparse @ref Texture2D or @ref Texture2DArray that
+are actually visible resident in video memory. The application renders page
+IDs needed by each visible texel into a feedback buffer (usually in low
+resolution), reads them back for example using @ref FramebufferReadback and
+passes them to @ref request(). Pages that aren't resident yet get committed
+with @ref Texture::commitPages() "commitPages()" and their data are decoded
+and uploaded through a @ref TextureUploadQueue. Coarser levels of each
+requested page are requested as well, so there's always a fallback to sample
+from. Once the number of resident pages reaches the limit, the least recently
+requested pages are decommitted again:
+
+@snippet Magnum.cpp SparseTextureStreamer-usage
+
+Levels smaller than one page in any direction form the mip tail, which is
+committed and uploaded as a whole in the constructor and stays resident for
+the whole lifetime of the instance.
+
+The streamer doesn't change any sampler state. To avoid sampling from pages
+that are not resident, the shader is expected to clamp the level of detail
+using @ref minLevelTable(), which contains the finest resident level for every
+page of the first level.
+
+@section SparseTextureStreamer-threading Threading
+
+All functions have to be called from the thread owning the GL context, only
+the decoder functions are executed on the worker threads of the
+@ref TextureUploadQueue. The texture and the queue have to be kept alive for
+the whole lifetime of the instance.
+
+@requires_extension Extension @extension{ARB,sparse_texture}
+@requires_gl44 Extension @extension{ARB,buffer_storage}
+@requires_gl Sparse textures are not available in OpenGL ES and WebGL.
+*/
+class MAGNUM_EXPORT SparseTextureStreamer {
+    public:
+        /** @brief Texture page */
+        struct Page {
+            /** @brief Page position in given level, in pages */
+            Vector2i position;
+
+            /** @brief Mip level */
+            Int level;
+
+            /** @brief Array layer, @cpp 0 @ce for non-array textures */
+            Int layer;
+        };
+
+        /**
+         * @brief Decoder function
+         *
+         * Gets the page to decode and a view on the mapped memory to write its
+         * pixel data to. The data are tightly packed with default
+         * @ref PixelStorage parameters and have the size of one page, except
+         * for pages on the level edge and for the mip tail, where they are
+         * cropped to the level size.
+         */
+        typedef std::function<void(const Page&, Containers::ArrayView<char>)> Decoder;
+
+        /**
+         * @brief Construct for a 2D texture
+         * @param texture       Sparse texture with allocated storage
+         * @param queue         Upload queue
+         * @param size          Size of the first texture level
+         * @param levelCount    Count of texture levels
+         * @param pageSize      Page size in pixels, see
+         *      @ref Texture::sparsePageSize()
+         * @param format        Format of decoded pixel data
+         * @param type          Data type of decoded pixel data
+         * @param maxResidentPages  Max count of resident pages outside of
+         *      the mip tail
+         * @param decoder       Function decoding page data
+         *
+         * Commits and enqueues an upload of the mip tail. Expects that the
+         * data size of one page fits into @ref TextureUploadQueue::slotSize()
+         * and that @p maxResidentPages is non-zero.
+         */
+        explicit SparseTextureStreamer(Texture2D& texture, TextureUploadQueue& queue, const Vector2i& size, Int levelCount, const Vector2i& pageSize, PixelFormat format, PixelType type, std::size_t maxResidentPages, Decoder decoder);
+
+        /**
+         * @brief Construct for a 2D texture array
+         *
+         * The last component of @p size is the layer count, each layer is
+         * streamed separately. Otherwise equivalent to
+         * @ref SparseTextureStreamer(Texture2D&, TextureUploadQueue&, const Vector2i&, Int, const Vector2i&, PixelFormat, PixelType, std::size_t, Decoder).
+         */
+        explicit SparseTextureStreamer(Texture2DArray& texture, TextureUploadQueue& queue, const Vector3i& size, Int levelCount, const Vector2i& pageSize, PixelFormat format, PixelType type, std::size_t maxResidentPages, Decoder decoder);
+
+        /** @brief Copying is not allowed */
+        SparseTextureStreamer(const SparseTextureStreamer&) = delete;
+
+        /** @brief Moving is not allowed */
+        SparseTextureStreamer(SparseTextureStreamer&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Doesn't decommit any pages, the texture stays as it is.
+         */
+        ~SparseTextureStreamer();
+
+        /** @brief Copying is not allowed */
+        SparseTextureStreamer& operator=(const SparseTextureStreamer&) = delete;
+
+        /** @brief Moving is not allowed */
+        SparseTextureStreamer& operator=(SparseTextureStreamer&&) = delete;
+
+        /** @brief Page size in pixels */
+        Vector2i pageSize() const;
+
+        /**
+         * @brief First level of the mip tail
+         *
+         * Equal to the level count if there's no mip tail.
+         */
+        Int tailLevel() const;
+
+        /** @brief Max count of resident pages outside of the mip tail */
+        std::size_t maxResidentPages() const;
+
+        /**
+         * @brief Count of resident pages
+         *
+         * Pages outside of the mip tail that are committed and have their
+         * upload complete.
+         */
+        std::size_t residentPageCount() const;
+
+        /**
+         * @brief Count of pending pages
+         *
+         * Pages that are committed but their upload is not complete yet.
+         */
+        std::size_t pendingPageCount() const;
+
+        /**
+         * @brief Whether given page is resident
+         *
+         * Pages in the mip tail are resident once the uploads from the
+         * constructor complete.
+         */
+        bool isResident(const Page& page) const;
+
+        /**
+         * @brief Request pages
+         *
+         * Marks @p pages and their coarser levels as used in the current
+         * frame. Pages that aren't committed yet get committed and their
+         * upload is enqueued, unless the count of resident and pending pages
+         * would exceed @ref maxResidentPages() even after evicting all pages
+         * unused in the current frame. Pages in the mip tail are ignored.
+         * Expects that all pages are inside the texture.
+         */
+        void request(Containers::ArrayView<const Page> pages);
+
+        /** @overload */
+        void request(std::initializer_list<Page> pages);
+
+        /**
+         * @brief Advance the streaming
+         * @param completedUploads  IDs returned by
+         *      @ref TextureUploadQueue::update()
+         *
+         * Marks pages whose upload is complete as resident, updates
+         * @ref minLevelTable() and advances to the next frame. IDs of
+         * uploads not issued by this instance are ignored, so the queue can be
+         * shared with other users.
+         */
+        void update(Containers::ArrayView<const UnsignedInt> completedUploads);
+
+        /** @overload */
+        void update(const std::vector<UnsignedInt>& completedUploads);
+
+        /**
+         * @brief Table of finest resident levels
+         * @param layer     Array layer
+         *
+         * One @ref PixelFormat::RedInteger / @ref PixelType::UnsignedByte
+         * value for each page of the first level, containing the finest
+         * level that's resident for the whole area of the page. Meant to be
+         * uploaded to a @ref TextureFormat::R8UI texture and used for
+         * clamping the level of detail in the shader. The view is valid until
+         * the next call to @ref update().
+         */
+        ImageView2D minLevelTable(Int layer = 0) const;
+
+    private:
+        struct State;
+
+        explicit SparseTextureStreamer(Texture2D* texture, Texture2DArray* textureArray, TextureUploadQueue& queue, const Vector3i& size, Int levelCount, const Vector2i& pageSize, PixelFormat format, PixelType type, std::size_t maxResidentPages, Decoder&& decoder);
+
+        std::unique_ptr<State> _state;
+};
+
+}
+#else
+#error this header is available only in desktop OpenGL build
+#endif
+
+#endif
@@ -0,0 +1,131 @@
+#ifndef Magnum_Std140_h
+#define Magnum_Std140_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+/** @file
+ * @brief Class @ref Magnum::Std140::Vector3, @ref Magnum::Std140::Matrix3, function @ref Magnum::Std140::alignedStride()
+ */
+
+#include <cstddef>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Math/Vector4.h"
+
+namespace Magnum { namespace Std140 {
+
+/**
+@brief Three-component vector in std140 layout
+
+Padded and aligned to 16 bytes, matching the layout of GLSL @glsl vec3 @ce
+in both @glsl std140 @ce and @glsl std430 @ce blocks. Implicitly convertible
+from and to @ref Magnum::Vector3 "Vector3". @glsl float @ce, @glsl vec2 @ce,
+@glsl vec4 @ce and @glsl mat4 @ce members don't need any wrapper, use
+@ref Magnum::Float "Float", @ref Magnum::Vector2 "Vector2",
+@ref Magnum::Vector4 "Vector4" and @ref Magnum::Matrix4 "Matrix4" directly
+and order the members so the 16-byte ones stay at multiples of 16.
+
+@see @ref Matrix3, @ref Shaders::FlatDrawUniform
+*/
+class alignas(16) Vector3 {
+    public:
+        /** @brief Default constructor */
+        constexpr /*implicit*/ Vector3() noexcept: _data{}, _padding{} {}
+
+        /** @brief Construct from a vector */
+        constexpr /*implicit*/ Vector3(const Magnum::Vector3& vector) noexcept: _data{vector}, _padding{} {}
+
+        /** @brief Convert to a vector */
+        constexpr /*implicit*/ operator Magnum::Vector3() const { return _data; }
+
+        /** @brief Underlying vector */
+        Magnum::Vector3& value() { return _data; }
+        constexpr const Magnum::Vector3& value() const { return _data; } /**< @overload */
+
+    private:
+        Magnum::Vector3 _data;
+        Float _padding;
+};
+
+/**
+@brief 3x3 matrix in std140 layout
+
+Each column is padded to 16 bytes, matching the layout of GLSL @glsl mat3 @ce
+in both @glsl std140 @ce and @glsl std430 @ce blocks. The type is 48 bytes in
+total, compared to 36 bytes of @ref Magnum::Matrix3 "Matrix3". Implicitly
+convertible from and to @ref Magnum::Matrix3 "Matrix3".
+@see @ref Vector3, @ref Shaders::FlatDrawUniform
+*/
+class alignas(16) Matrix3 {
+    public:
+        /** @brief Default constructor */
+        constexpr /*implicit*/ Matrix3() noexcept: _columns{} {}
+
+        /** @brief Construct from a matrix */
+        constexpr /*implicit*/ Matrix3(const Math::Matrix3x3<Float>& matrix) noexcept: _columns{
+            Vector4{Magnum::Vector3{matrix[0]}, 0.0f},
+            Vector4{Magnum::Vector3{matrix[1]}, 0.0f},
+            Vector4{Magnum::Vector3{matrix[2]}, 0.0f}} {}
+
+        /** @brief Convert to a matrix */
+        constexpr /*implicit*/ operator Magnum::Matrix3() const {
+            return {_columns[0].xyz(), _columns[1].xyz(), _columns[2].xyz()};
+        }
+
+        /**
+         * @brief Padded column
+         *
+         * The fourth component is ignored by GLSL.
+         */
+        Vector4& operator[](std::size_t col) { return _columns[col]; }
+        constexpr const Vector4& operator[](std::size_t col) const { return _columns[col]; } /**< @overload */
+
+    private:
+        Vector4 _columns[3];
+};
+
+/**
+@brief Stride of uniform buffer ranges
+
+Rounds @p size up to a multiple of @p alignment. When per-draw data are
+stored in consecutive ranges of a single uniform buffer and bound with
+@ref Buffer::bind(Buffer::Target, UnsignedInt, GLintptr, GLsizeiptr), the
+offsets have to be multiples of @ref Buffer::uniformOffsetAlignment(), so
+pass that value as @p alignment. For shader storage buffers use
+@ref Buffer::shaderStorageOffsetAlignment() instead. Expects that
+@p alignment is not zero.
+*/
+constexpr std::size_t alignedStride(std::size_t size, std::size_t alignment) {
+    return (size + alignment - 1)/alignment*alignment;
+}
+
+static_assert(sizeof(Vector3) == 16, "Improper size of Std140::Vector3");
+static_assert(sizeof(Matrix3) == 48, "Improper size of Std140::Matrix3");
+
+}}
+
+#endif
@@ -0,0 +1,89 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "StreamingBuffer.h"
+
+#include <Corrade/Utility/Assert.h>
+
+namespace Magnum {
+
+StreamingBuffer::StreamingBuffer(const std::size_t regionSize, const UnsignedInt regionCount, const Buffer::TargetHint targetHint): _buffer{targetHint}, _fences(regionCount), _regionSize{regionSize}, _regionOffset{0}, _currentRegion{0} {
+    CORRADE_ASSERT(regionCount >= 2,
+        "StreamingBuffer: expected at least two regions but got" << regionCount, );
+
+    _buffer.setStorage(regionSize*regionCount,
+        Buffer::StorageFlag::MapWrite|Buffer::StorageFlag::MapPersistent|Buffer::StorageFlag::MapCoherent);
+    _data = _buffer.map(0, regionSize*regionCount,
+        Buffer::MapFlag::Write|Buffer::MapFlag::Persistent|Buffer::MapFlag::Coherent);
+}
+
+StreamingBuffer::StreamingBuffer(StreamingBuffer&& other) noexcept: _buffer{std::move(other._buffer)}, _data{other._data}, _fences{std::move(other._fences)}, _regionSize{other._regionSize}, _regionOffset{other._regionOffset}, _currentRegion{other._currentRegion} {
+    other._data = nullptr;
+}
+
+StreamingBuffer::~StreamingBuffer() {
+    /* Moved out, nothing to do */
+    if(!_data) return;
+
+    _buffer.unmap();
+}
+
+StreamingBuffer& StreamingBuffer::operator=(StreamingBuffer&& other) noexcept {
+    using std::swap;
+    swap(_buffer, other._buffer);
+    swap(_data, other._data);
+    swap(_fences, other._fences);
+    swap(_regionSize, other._regionSize);
+    swap(_regionOffset, other._regionOffset);
+    swap(_currentRegion, other._currentRegion);
+    return *this;
+}
+
+std::pair<Containers::ArrayView<char>, GLintptr> StreamingBuffer::allocate(const std::size_t size, const std::size_t alignment) {
+    CORRADE_ASSERT(alignment,
+        "StreamingBuffer::allocate(): alignment can't be zero", {});
+
+    /* Align the absolute offset, as the region size doesn't need to be a
+       multiple of the alignment */
+    const std::size_t regionBegin = _currentRegion*_regionSize;
+    const std::size_t offset = (regionBegin + _regionOffset + alignment - 1)/alignment*alignment;
+    if(offset + size > regionBegin + _regionSize) return {nullptr, -1};
+
+    _regionOffset = offset + size - regionBegin;
+    return {_data.slice(offset, offset + size), GLintptr(offset)};
+}
+
+void StreamingBuffer::nextFrame() {
+    _fences[_currentRegion].insert();
+    _currentRegion = (_currentRegion + 1) % _fences.size();
+    _regionOffset = 0;
+
+    /* Wait until the GPU is done with the data written to this region
+       regionCount() frames ago */
+    Fence& fence = _fences[_currentRegion];
+    while(fence.clientWait(std::chrono::milliseconds{1}) == Fence::WaitResult::TimeoutExpired);
+}
+
+}
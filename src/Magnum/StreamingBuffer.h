@@ -0,0 +1,155 @@
+#ifndef Magnum_StreamingBuffer_h
+#define Magnum_StreamingBuffer_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef MAGNUM_TARGET_GLES
+/** @file
+ * @brief Class @ref Magnum::StreamingBuffer
+ */
+#endif
+
+#include <utility>
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Buffer.h"
+#include "Magnum/Fence.h"
+
+#ifndef MAGNUM_TARGET_GLES
+namespace Magnum {
+
+/**
+@brief Ring buffer for streaming per-frame data
+
+Allocates an immutable, persistently and coherently mapped @ref Buffer
+split into a fixed number of equally sized regions, by default three. Each
+frame the application sub-allocates vertex, instance or uniform data from
+the current region using @ref allocate(), writes them directly to the
+returned memory and uses the returned offset to bind the data:
+
+@snippet Magnum.cpp StreamingBuffer-usage
+
+At the end of the frame, @ref nextFrame() inserts a @ref Fence for the
+current region and advances to the next one, waiting for its fence first.
+With three regions the CPU can thus be up to two frames ahead of the GPU
+without ever overwriting data that are still being read and without
+orphaning or implicit synchronization in the driver.
+
+@requires_gl44 Extension @extension{ARB,buffer_storage}
+@requires_gl Persistent mapping is not available in OpenGL ES and WebGL.
+*/
+class MAGNUM_EXPORT StreamingBuffer {
+    public:
+        /**
+         * @brief Constructor
+         * @param regionSize    Size of one region in bytes
+         * @param regionCount   Count of regions
+         * @param targetHint    Target hint for the underlying buffer
+         *
+         * Allocates the buffer using @ref Buffer::setStorage() with
+         * @ref Buffer::StorageFlag::MapWrite,
+         * @ref Buffer::StorageFlag::MapPersistent and
+         * @ref Buffer::StorageFlag::MapCoherent and maps it for the whole
+         * lifetime of the instance. Expects that @p regionCount is at least
+         * two.
+         */
+        explicit StreamingBuffer(std::size_t regionSize, UnsignedInt regionCount = 3, Buffer::TargetHint targetHint = Buffer::TargetHint::Array);
+
+        /** @brief Copying is not allowed */
+        StreamingBuffer(const StreamingBuffer&) = delete;
+
+        /** @brief Move constructor */
+        StreamingBuffer(StreamingBuffer&&) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Unmaps the buffer.
+         */
+        ~StreamingBuffer();
+
+        /** @brief Copying is not allowed */
+        StreamingBuffer& operator=(const StreamingBuffer&) = delete;
+
+        /** @brief Move assignment */
+        StreamingBuffer& operator=(StreamingBuffer&&) noexcept;
+
+        /** @brief Underlying buffer */
+        Buffer& buffer() { return _buffer; }
+
+        /** @brief Size of one region in bytes */
+        std::size_t regionSize() const { return _regionSize; }
+
+        /** @brief Count of regions */
+        UnsignedInt regionCount() const { return _fences.size(); }
+
+        /** @brief Index of the region used in the current frame */
+        UnsignedInt currentRegion() const { return _currentRegion; }
+
+        /**
+         * @brief Bytes still available in the current region
+         *
+         * Not taking alignment into account.
+         */
+        std::size_t available() const { return _regionSize - _regionOffset; }
+
+        /**
+         * @brief Allocate memory from the current region
+         * @param size      Size in bytes
+         * @param alignment Alignment of the offset, for example
+         *      @ref Buffer::uniformOffsetAlignment() for uniform data
+         * @return Mapped memory to write to and its offset in @ref buffer(),
+         *      or an empty view and @cpp -1 @ce if there's not enough space
+         *      left in the current region
+         *
+         * The memory stays valid until @ref nextFrame() is called
+         * @ref regionCount() times.
+         */
+        std::pair<Containers::ArrayView<char>, GLintptr> allocate(std::size_t size, std::size_t alignment = 1);
+
+        /**
+         * @brief Advance to the next frame
+         *
+         * Inserts a fence after all commands using the current region, moves
+         * to the next region and blocks until the fence inserted into it
+         * @ref regionCount() frames ago is signaled.
+         * @see @ref Fence::insert(), @ref Fence::clientWait()
+         */
+        void nextFrame();
+
+    private:
+        Buffer _buffer;
+        Containers::ArrayView<char> _data;
+        Containers::Array<Fence> _fences;
+        std::size_t _regionSize, _regionOffset;
+        UnsignedInt _currentRegion;
+};
+
+}
+#else
+#error this header is available only in desktop OpenGL build
+#endif
+
+#endif
@@ -0,0 +1,188 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+#include <Corrade/TestSuite/Tester.h>
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include <thread>
+#endif
+
+#include "Magnum/AbstractAsyncResourceLoader.h"
+#include "Magnum/ResourceManager.h"
+
+namespace Magnum { namespace Test {
+
+struct AbstractAsyncResourceLoaderTest: TestSuite::Tester {
+    explicit AbstractAsyncResourceLoaderTest();
+
+    void load();
+    void priority();
+};
+
+typedef Magnum::ResourceManager<Int> ResourceManager;
+
+AbstractAsyncResourceLoaderTest::AbstractAsyncResourceLoaderTest() {
+    addTests({&AbstractAsyncResourceLoaderTest::load,
+              &AbstractAsyncResourceLoaderTest::priority});
+}
+
+namespace {
+
+class IntResourceLoader: public AbstractAsyncResourceLoader<Int, Int> {
+    public:
+        explicit IntResourceLoader(bool closed = false): _closed{closed} {}
+
+        ~IntResourceLoader() { stop(); }
+
+        /* Lets the decoding continue */
+        void open() {
+            {
+                std::unique_lock<std::mutex> lock{_mutex};
+                _closed = false;
+            }
+            _condition.notify_all();
+        }
+
+        /* Waits until the decoding of given count of resources started */
+        void waitForDecodeStart(std::size_t count) {
+            std::unique_lock<std::mutex> lock{_mutex};
+            _condition.wait(lock, [&]() { return _decoded.size() >= count; });
+        }
+
+        std::vector<ResourceKey> decoded() {
+            std::unique_lock<std::mutex> lock{_mutex};
+            return _decoded;
+        }
+
+        std::vector<ResourceKey> uploaded;
+
+    private:
+        Containers::Optional<Int> doDecode(ResourceKey key) override {
+            std::unique_lock<std::mutex> lock{_mutex};
+            _decoded.push_back(key);
+            _condition.notify_all();
+            _condition.wait(lock, [this]() { return !_closed; });
+
+            if(key == ResourceKey("world")) return {};
+            return Int(_decoded.size()*10);
+        }
+
+        void doUpload(ResourceKey key, Int&& decoded) override {
+            uploaded.push_back(key);
+            set(key, decoded, ResourceDataState::Final, ResourcePolicy::Resident);
+        }
+
+        std::string doName(ResourceKey) const override { return {}; }
+
+        std::mutex _mutex;
+        std::condition_variable _condition;
+        std::vector<ResourceKey> _decoded;
+        bool _closed;
+};
+
+void updateUntilFinished(IntResourceLoader& loader) {
+    while(loader.pendingCount()) {
+        loader.update();
+        #ifndef CORRADE_TARGET_EMSCRIPTEN
+        std::this_thread::yield();
+        #endif
+    }
+}
+
+}
+
+void AbstractAsyncResourceLoaderTest::load() {
+    ResourceManager rm;
+    IntResourceLoader* loader = new IntResourceLoader;
+    rm.setLoader(loader);
+
+    Resource<Int> hello = rm.get<Int>("hello");
+    Resource<Int> world = rm.get<Int>("world");
+    CORRADE_COMPARE(hello.state(), ResourceState::Loading);
+    CORRADE_COMPARE(world.state(), ResourceState::Loading);
+    CORRADE_COMPARE(loader->requestedCount(), 2);
+
+    updateUntilFinished(*loader);
+    CORRADE_COMPARE(hello.state(), ResourceState::Final);
+    CORRADE_VERIFY(*hello == 10 || *hello == 20);
+    CORRADE_COMPARE(world.state(), ResourceState::NotFound);
+    CORRADE_COMPARE(loader->uploaded, std::vector<ResourceKey>{"hello"});
+    CORRADE_COMPARE(loader->loadedCount(), 1);
+    CORRADE_COMPARE(loader->notFoundCount(), 1);
+}
+
+void AbstractAsyncResourceLoaderTest::priority() {
+    #ifdef CORRADE_TARGET_EMSCRIPTEN
+    CORRADE_SKIP("Threads are not supported on this platform.");
+    #else
+    ResourceManager rm;
+    IntResourceLoader* loader = new IntResourceLoader{true};
+    rm.setLoader(loader);
+
+    Resource<Int> first = rm.get<Int>("first");
+
+    /* Wait until the single worker is stuck decoding the first resource so
+       the rest is queued */
+    loader->waitForDecodeStart(1);
+    Resource<Int> low = rm.get<Int>("low");
+    Resource<Int> high = rm.get<Int>("high");
+    Resource<Int> middle = rm.get<Int>("middle");
+    CORRADE_COMPARE(loader->pendingCount(), 4);
+
+    loader->setPriority("high", 5.0f);
+    loader->updatePriorities([](ResourceKey key) {
+        if(key == ResourceKey("high")) return 3.0f;
+        if(key == ResourceKey("middle")) return 2.0f;
+        if(key == ResourceKey("low")) return 1.0f;
+        return 0.0f;
+    });
+
+    loader->open();
+    loader->waitForDecodeStart(4);
+    CORRADE_COMPARE(loader->decoded(), (std::vector<ResourceKey>{"first", "high", "middle", "low"}));
+
+    /* Nothing is queued anymore, so stopping waits for all decodes to finish.
+       Then upload in order of priority. */
+    loader->stop();
+    CORRADE_COMPARE(loader->pendingCount(), 4);
+    loader->update(2);
+    CORRADE_COMPARE(loader->uploaded, (std::vector<ResourceKey>{"high", "middle"}));
+    CORRADE_COMPARE(high.state(), ResourceState::Final);
+    CORRADE_COMPARE(middle.state(), ResourceState::Final);
+    CORRADE_COMPARE(low.state(), ResourceState::Loading);
+    CORRADE_COMPARE(loader->pendingCount(), 2);
+
+    updateUntilFinished(*loader);
+    CORRADE_COMPARE(loader->uploaded, (std::vector<ResourceKey>{"high", "middle", "first", "low"}));
+    CORRADE_COMPARE(*first, 10);
+    CORRADE_COMPARE(*low, 40);
+    #endif
+}
+
+}}
+
+CORRADE_TEST_MAIN(Magnum::Test::AbstractAsyncResourceLoaderTest)
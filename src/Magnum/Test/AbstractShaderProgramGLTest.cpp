@@ -24,6 +24,8 @@
 */
 
 #include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/Directory.h>
 #include <Corrade/Utility/Resource.h>
 #include <Corrade/TestSuite/Compare/Container.h>
 
@@ -37,6 +39,9 @@
 #endif
 #include "Magnum/PixelFormat.h"
 #include "Magnum/Shader.h"
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+#include "Magnum/ShaderProgramCache.h"
+#endif
 #include "Magnum/Texture.h"
 #include "Magnum/TextureFormat.h"
 #include "Magnum/Math/Matrix.h"
@@ -44,6 +49,8 @@
 #include "Magnum/Math/Color.h"
 #include "Magnum/OpenGLTester.h"
 
+#include "configure.h"
+
 namespace Magnum { namespace Test {
 
 struct AbstractShaderProgramGLTest: OpenGLTester {
@@ -62,6 +69,12 @@ struct AbstractShaderProgramGLTest: OpenGLTester {
     #ifndef MAGNUM_TARGET_GLES
     void createMultipleOutputsIndexed();
     #endif
+    void createAsync();
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    void binary();
+    void binaryInvalid();
+    void binaryCache();
+    #endif
 
     void uniformNotFound();
     void uniform();
@@ -92,6 +105,12 @@ AbstractShaderProgramGLTest::AbstractShaderProgramGLTest() {
               #ifndef MAGNUM_TARGET_GLES
               &AbstractShaderProgramGLTest::createMultipleOutputsIndexed,
               #endif
+              &AbstractShaderProgramGLTest::createAsync,
+              #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+              &AbstractShaderProgramGLTest::binary,
+              &AbstractShaderProgramGLTest::binaryInvalid,
+              &AbstractShaderProgramGLTest::binaryCache,
+              #endif
 
               &AbstractShaderProgramGLTest::uniformNotFound,
               &AbstractShaderProgramGLTest::uniform,
@@ -180,6 +199,13 @@ namespace {
         using AbstractShaderProgram::bindFragmentDataLocation;
         #endif
         using AbstractShaderProgram::link;
+        using AbstractShaderProgram::submitLink;
+        using AbstractShaderProgram::checkLink;
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        using AbstractShaderProgram::setRetrievableBinary;
+        using AbstractShaderProgram::binary;
+        using AbstractShaderProgram::setBinary;
+        #endif
         using AbstractShaderProgram::uniformLocation;
         #ifndef MAGNUM_TARGET_GLES2
         using AbstractShaderProgram::uniformBlockIndex;
@@ -356,6 +382,169 @@ void AbstractShaderProgramGLTest::createMultipleOutputsIndexed() {
 }
 #endif
 
+namespace {
+    constexpr Version ShaderVersion =
+        #ifndef MAGNUM_TARGET_GLES
+        #ifndef CORRADE_TARGET_APPLE
+        Version::GL210
+        #else
+        Version::GL310
+        #endif
+        #else
+        Version::GLES200
+        #endif
+        ;
+}
+
+void AbstractShaderProgramGLTest::createAsync() {
+    Utility::Resource rs("AbstractShaderProgramGLTest");
+
+    Shader vert(ShaderVersion, Shader::Type::Vertex);
+    vert.addSource(rs.get("MyShader.vert"));
+    Shader frag(ShaderVersion, Shader::Type::Fragment);
+    frag.addSource(rs.get("MyShader.frag"));
+
+    Shader::submitCompile({vert, frag});
+
+    MyPublicShader program;
+    program.attachShaders({vert, frag});
+    program.bindAttributeLocation(0, "position");
+    program.submitLink();
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /* Without KHR_parallel_shader_compile it's always finished, with it it
+       eventually has to finish */
+    while(!program.isLinkFinished()) {}
+    CORRADE_VERIFY(vert.isCompileFinished());
+    CORRADE_VERIFY(frag.isCompileFinished());
+
+    CORRADE_VERIFY(Shader::checkCompile({vert, frag}));
+    CORRADE_VERIFY(program.checkLink());
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(program.uniformLocation("matrix") >= 0);
+}
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+void AbstractShaderProgramGLTest::binary() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::get_program_binary>())
+        CORRADE_SKIP(Extensions::GL::ARB::get_program_binary::string() + std::string(" is not supported."));
+    #endif
+
+    Utility::Resource rs("AbstractShaderProgramGLTest");
+
+    Shader vert(ShaderVersion, Shader::Type::Vertex);
+    vert.addSource(rs.get("MyShader.vert"));
+    Shader frag(ShaderVersion, Shader::Type::Fragment);
+    frag.addSource(rs.get("MyShader.frag"));
+    CORRADE_VERIFY(Shader::compile({vert, frag}));
+
+    MyPublicShader program;
+    program.attachShaders({vert, frag});
+    program.bindAttributeLocation(0, "position");
+    program.setRetrievableBinary(true);
+    CORRADE_VERIFY(program.link());
+
+    std::pair<GLenum, Containers::Array<char>> binary = program.binary();
+    MAGNUM_VERIFY_NO_ERROR();
+    if(binary.second.empty())
+        CORRADE_SKIP("The driver doesn't provide any program binary formats.");
+
+    /* Without attaching any shaders */
+    MyPublicShader loaded;
+    CORRADE_VERIFY(loaded.setBinary(binary.first, binary.second));
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(loaded.uniformLocation("matrix") >= 0);
+    CORRADE_VERIFY(loaded.uniformLocation("color") >= 0);
+}
+
+void AbstractShaderProgramGLTest::binaryInvalid() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::get_program_binary>())
+        CORRADE_SKIP(Extensions::GL::ARB::get_program_binary::string() + std::string(" is not supported."));
+    #endif
+
+    MyPublicShader program;
+    CORRADE_VERIFY(!program.setBinary(0, nullptr));
+
+    /* Garbage in a possibly valid format is rejected without a GL error */
+    Int formatCount;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+    if(!formatCount) CORRADE_SKIP("No program binary formats supported.");
+
+    Containers::Array<Int> formats{std::size_t(formatCount)};
+    glGetIntegerv(GL_PROGRAM_BINARY_FORMATS, formats);
+    constexpr char garbage[64]{};
+    std::ostringstream out;
+    {
+        Error redirectError{&out};
+        CORRADE_VERIFY(!program.setBinary(formats[0], garbage));
+    }
+
+    CORRADE_COMPARE(out.str(), "");
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void AbstractShaderProgramGLTest::binaryCache() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::get_program_binary>())
+        CORRADE_SKIP(Extensions::GL::ARB::get_program_binary::string() + std::string(" is not supported."));
+    #endif
+
+    Utility::Resource rs("AbstractShaderProgramGLTest");
+
+    const std::string directory = Utility::Directory::join(ABSTRACTSHADERPROGRAMGLTEST_SAVE_DIR, "cache");
+    ShaderProgramCache cache{directory};
+    CORRADE_COMPARE(cache.directory(), directory);
+
+    Shader vert(ShaderVersion, Shader::Type::Vertex);
+    vert.addSource(rs.get("MyShader.vert"));
+    Shader frag(ShaderVersion, Shader::Type::Fragment);
+    frag.addSource(rs.get("MyShader.frag"));
+
+    /* Key depends on sources and on the shader order */
+    const std::string key = cache.key({vert, frag});
+    CORRADE_COMPARE(key, cache.key({vert, frag}));
+    CORRADE_VERIFY(key != cache.key({frag, vert}));
+    Shader frag2(ShaderVersion, Shader::Type::Fragment);
+    frag2.addSource(rs.get("MyShader.frag"))
+        .addSource("/* a comment */\n");
+    CORRADE_VERIFY(key != cache.key({vert, frag2}));
+
+    if(Utility::Directory::fileExists(Utility::Directory::join(directory, key)))
+        CORRADE_VERIFY(Utility::Directory::rm(Utility::Directory::join(directory, key)));
+
+    /* Cold start -- nothing in the cache */
+    CORRADE_VERIFY(cache.load(key).second.empty());
+
+    {
+        CORRADE_VERIFY(Shader::compile({vert, frag}));
+        MyPublicShader program;
+        program.attachShaders({vert, frag});
+        program.bindAttributeLocation(0, "position");
+        program.setRetrievableBinary(true);
+        CORRADE_VERIFY(program.link());
+
+        std::pair<GLenum, Containers::Array<char>> binary = program.binary();
+        if(binary.second.empty())
+            CORRADE_SKIP("The driver doesn't provide any program binary formats.");
+        CORRADE_VERIFY(cache.save(key, binary.first, binary.second));
+    }
+
+    /* Warm start -- no compilation needed */
+    std::pair<GLenum, Containers::Array<char>> binary = cache.load(key);
+    CORRADE_VERIFY(!binary.second.empty());
+    MyPublicShader program;
+    CORRADE_VERIFY(program.setBinary(binary.first, binary.second));
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(program.uniformLocation("matrix") >= 0);
+}
+#endif
+
 void AbstractShaderProgramGLTest::uniformNotFound() {
     MyPublicShader program;
 
@@ -58,6 +58,10 @@ struct BufferGLTest: OpenGLTester {
     void mapRange();
     void mapRangeExplicitFlush();
     #endif
+    #ifndef MAGNUM_TARGET_GLES
+    void storage();
+    void storageMapPersistent();
+    #endif
     #ifndef MAGNUM_TARGET_GLES2
     void copy();
     #endif
@@ -85,6 +89,10 @@ BufferGLTest::BufferGLTest() {
               &BufferGLTest::mapRange,
               &BufferGLTest::mapRangeExplicitFlush,
               #endif
+              #ifndef MAGNUM_TARGET_GLES
+              &BufferGLTest::storage,
+              &BufferGLTest::storageMapPersistent,
+              #endif
               #ifndef MAGNUM_TARGET_GLES2
               &BufferGLTest::copy,
               #endif
@@ -382,6 +390,65 @@ void BufferGLTest::mapRangeExplicitFlush() {
 }
 #endif
 
+#ifndef MAGNUM_TARGET_GLES
+void BufferGLTest::storage() {
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::buffer_storage>())
+        CORRADE_SKIP(Extensions::GL::ARB::buffer_storage::string() + std::string(" is not supported"));
+
+    constexpr Int data[] = {2, 7, 5, 13, 25};
+    Buffer buffer;
+    buffer.setStorage(data, Buffer::StorageFlag::DynamicStorage);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(buffer.size(), 5*4);
+
+    /* Dynamic storage allows subdata updates */
+    constexpr Int subData[] = {125, 3, 15};
+    buffer.setSubData(4, subData);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    constexpr Int expected[] = {2, 125, 3, 15, 25};
+    CORRADE_COMPARE_AS(Containers::arrayCast<Int>(buffer.data()),
+        Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+}
+
+void BufferGLTest::storageMapPersistent() {
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::buffer_storage>())
+        CORRADE_SKIP(Extensions::GL::ARB::buffer_storage::string() + std::string(" is not supported"));
+
+    Buffer buffer;
+    buffer.setStorage(5, Buffer::StorageFlag::MapWrite|Buffer::StorageFlag::MapPersistent);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(buffer.size(), 5);
+
+    Containers::ArrayView<char> contents = buffer.map(0, 5, Buffer::MapFlag::Write|Buffer::MapFlag::Persistent|Buffer::MapFlag::FlushExplicit);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(contents);
+
+    /* The buffer can be read by the GL while mapped */
+    contents[0] = 2;
+    contents[1] = 7;
+    contents[2] = 5;
+    contents[3] = 13;
+    contents[4] = 25;
+    buffer.flushMappedRange(0, 5);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    Buffer copy;
+    copy.setData({nullptr, 5}, BufferUsage::StaticCopy);
+    Buffer::copy(buffer, copy, 0, 0, 5);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    CORRADE_VERIFY(buffer.unmap());
+    MAGNUM_VERIFY_NO_ERROR();
+
+    constexpr char expected[] = {2, 7, 5, 13, 25};
+    CORRADE_COMPARE_AS(copy.data(),
+        Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+}
+#endif
+
 #ifndef MAGNUM_TARGET_GLES2
 void BufferGLTest::copy() {
     Buffer buffer1;
@@ -0,0 +1,210 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include <thread>
+#endif
+
+#include "Magnum/Buffer.h"
+#include "Magnum/CommandBuffer.h"
+#include "Magnum/OpenGLTester.h"
+
+namespace Magnum { namespace Test {
+
+struct CommandBufferGLTest: OpenGLTester {
+    explicit CommandBufferGLTest();
+
+    void replay();
+    void replaySorted();
+    void replayMultiple();
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    void replayMultipleRecordedInThreads();
+    #endif
+    void applyState();
+};
+
+CommandBufferGLTest::CommandBufferGLTest() {
+    addTests({&CommandBufferGLTest::replay,
+              &CommandBufferGLTest::replaySorted,
+              &CommandBufferGLTest::replayMultiple,
+              #ifndef CORRADE_TARGET_EMSCRIPTEN
+              &CommandBufferGLTest::replayMultipleRecordedInThreads,
+              #endif
+              &CommandBufferGLTest::applyState});
+}
+
+void CommandBufferGLTest::replay() {
+    Buffer buffer;
+    constexpr Int zero[]{0, 0, 0, 0};
+    buffer.setData(zero, BufferUsage::StaticDraw);
+
+    constexpr Int a[]{3, 4};
+    constexpr Int b[]{5};
+
+    CommandBuffer commands;
+    commands.setBufferSubData(buffer, 0, a)
+        .setBufferSubData(buffer, 3*4, b);
+    /* Nothing is executed during recording */
+    MAGNUM_VERIFY_NO_ERROR();
+
+    commands.replay();
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /** @todo How to verify the contents in ES? */
+    #ifndef MAGNUM_TARGET_GLES
+    constexpr Int expected[]{3, 4, 0, 5};
+    CORRADE_COMPARE_AS(Containers::arrayCast<Int>(buffer.data()),
+        Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+    #endif
+}
+
+void CommandBufferGLTest::replaySorted() {
+    Buffer buffer;
+    constexpr Int zero[]{0, 0};
+    buffer.setData(zero, BufferUsage::StaticDraw);
+
+    constexpr Int a[]{1, 1};
+    constexpr Int b[]{2};
+    constexpr Int c[]{3};
+
+    /* The segment with key 2 is recorded first but executed last, segments
+       with the same key are executed in recording order, so the last write
+       to the first element is from the second segment with key 1 */
+    CommandBuffer commands;
+    commands.begin(2).setBufferSubData(buffer, 0, a)
+        .begin(1).setBufferSubData(buffer, 4, b).setBufferSubData(buffer, 0, b)
+        .begin(1).setBufferSubData(buffer, 0, c)
+        .sort()
+        .replay();
+    MAGNUM_VERIFY_NO_ERROR();
+
+    #ifndef MAGNUM_TARGET_GLES
+    constexpr Int expected[]{1, 1};
+    CORRADE_COMPARE_AS(Containers::arrayCast<Int>(buffer.data()),
+        Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+    #endif
+
+    /* Remove the segment with key 2, the value from the last segment with
+       key 1 is now visible */
+    commands.clear()
+        .begin(1).setBufferSubData(buffer, 4, b).setBufferSubData(buffer, 0, b)
+        .begin(1).setBufferSubData(buffer, 0, c)
+        .sort()
+        .replay();
+    MAGNUM_VERIFY_NO_ERROR();
+
+    #ifndef MAGNUM_TARGET_GLES
+    constexpr Int expectedRemoved[]{3, 2};
+    CORRADE_COMPARE_AS(Containers::arrayCast<Int>(buffer.data()),
+        Containers::arrayView(expectedRemoved),
+        TestSuite::Compare::Container);
+    #endif
+}
+
+void CommandBufferGLTest::replayMultiple() {
+    Buffer buffer;
+    constexpr Int zero[]{0, 0};
+    buffer.setData(zero, BufferUsage::StaticDraw);
+
+    constexpr Int a[]{1};
+    constexpr Int b[]{2};
+    constexpr Int c[]{3};
+
+    CommandBuffer first, second;
+    first.begin(5).setBufferSubData(buffer, 0, c)
+        .begin(1).setBufferSubData(buffer, 4, a);
+    second.begin(3).setBufferSubData(buffer, 0, b)
+        .begin(1).setBufferSubData(buffer, 4, b);
+
+    /* Execution order is first:1, second:1, second:3, first:5 */
+    CommandBuffer::replay({first, second});
+    MAGNUM_VERIFY_NO_ERROR();
+
+    #ifndef MAGNUM_TARGET_GLES
+    constexpr Int expected[]{3, 2};
+    CORRADE_COMPARE_AS(Containers::arrayCast<Int>(buffer.data()),
+        Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+    #endif
+
+    /* The buffers are not modified by the replay */
+    CORRADE_COMPARE(first.sortKeys(), (std::vector<UnsignedLong>{5, 1}));
+}
+
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+void CommandBufferGLTest::replayMultipleRecordedInThreads() {
+    Buffer buffer;
+    constexpr Int zero[]{0, 0, 0, 0};
+    buffer.setData(zero, BufferUsage::StaticDraw);
+
+    /* Recording doesn't need a GL context */
+    CommandBuffer commands[4];
+    std::thread threads[4];
+    for(Int i = 0; i != 4; ++i) threads[i] = std::thread{[&buffer, &commands, i]() {
+        const Int value[]{i + 10};
+        commands[i].begin(4 - i).setBufferSubData(buffer, 0, value)
+            .setBufferSubData(buffer, i*4, value);
+    }};
+    for(std::thread& thread: threads) thread.join();
+
+    CommandBuffer::replay({commands[0], commands[1], commands[2], commands[3]});
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /* The first buffer has the highest key so it's executed last */
+    #ifndef MAGNUM_TARGET_GLES
+    constexpr Int expected[]{10, 11, 12, 13};
+    CORRADE_COMPARE_AS(Containers::arrayCast<Int>(buffer.data()),
+        Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+    #endif
+}
+#endif
+
+void CommandBufferGLTest::applyState() {
+    Renderer::StateBlock enable, disable;
+    enable.setFeature(Renderer::Feature::StencilTest, true);
+    disable.setFeature(Renderer::Feature::StencilTest, false);
+
+    CommandBuffer commands;
+    commands.begin(1).applyState(enable)
+        .begin(0).applyState(disable);
+
+    commands.replay();
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(glIsEnabled(GL_STENCIL_TEST));
+
+    commands.sort()
+        .replay();
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(!glIsEnabled(GL_STENCIL_TEST));
+}
+
+}}
+
+CORRADE_TEST_MAIN(Magnum::Test::CommandBufferGLTest)
@@ -0,0 +1,171 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Buffer.h"
+#include "Magnum/CommandBuffer.h"
+
+namespace Magnum { namespace Test {
+
+struct CommandBufferTest: TestSuite::Tester {
+    explicit CommandBufferTest();
+
+    void construct();
+    void constructCopy();
+    void constructMove();
+
+    void record();
+    void recordImplicitSegment();
+    void recordEmptySegment();
+    void clear();
+
+    void sort();
+};
+
+CommandBufferTest::CommandBufferTest() {
+    addTests({&CommandBufferTest::construct,
+              &CommandBufferTest::constructCopy,
+              &CommandBufferTest::constructMove,
+
+              &CommandBufferTest::record,
+              &CommandBufferTest::recordImplicitSegment,
+              &CommandBufferTest::recordEmptySegment,
+              &CommandBufferTest::clear,
+
+              &CommandBufferTest::sort});
+}
+
+void CommandBufferTest::construct() {
+    CommandBuffer commands;
+    CORRADE_VERIFY(commands.isEmpty());
+    CORRADE_COMPARE(commands.commandCount(), 0);
+    CORRADE_COMPARE(commands.segmentCount(), 0);
+    CORRADE_COMPARE(commands.dataSize(), 0);
+}
+
+void CommandBufferTest::constructCopy() {
+    CORRADE_VERIFY(!(std::is_constructible<CommandBuffer, const CommandBuffer&>{}));
+    CORRADE_VERIFY(!(std::is_assignable<CommandBuffer, const CommandBuffer&>{}));
+}
+
+void CommandBufferTest::constructMove() {
+    Renderer::StateBlock state;
+    CommandBuffer a;
+    a.begin(3)
+        .applyState(state);
+
+    CommandBuffer b{std::move(a)};
+    CORRADE_COMPARE(b.commandCount(), 1);
+    CORRADE_COMPARE(b.segmentCount(), 1);
+
+    CommandBuffer c;
+    c = std::move(b);
+    CORRADE_COMPARE(c.commandCount(), 1);
+    CORRADE_COMPARE(c.sortKeys(), std::vector<UnsignedLong>{3});
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<CommandBuffer>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<CommandBuffer>::value);
+}
+
+void CommandBufferTest::record() {
+    /* Recording doesn't touch GL, so it's possible to test with objects that
+       don't have any GL counterpart */
+    Buffer buffer{NoCreate};
+    Renderer::StateBlock state;
+    const Float data[]{1.0f, 2.5f, 3.0f};
+
+    CommandBuffer commands;
+    commands.begin(7)
+        .applyState(state)
+        .setBufferSubData(buffer, 16, data)
+        .begin(2)
+        .setBufferSubData(buffer, 0, data);
+
+    CORRADE_VERIFY(!commands.isEmpty());
+    CORRADE_COMPARE(commands.commandCount(), 3);
+    CORRADE_COMPARE(commands.segmentCount(), 2);
+    CORRADE_COMPARE(commands.sortKeys(), (std::vector<UnsignedLong>{7, 2}));
+    /* The data are copied */
+    CORRADE_COMPARE(commands.dataSize(), 2*sizeof(data));
+}
+
+void CommandBufferTest::recordImplicitSegment() {
+    Renderer::StateBlock state;
+
+    CommandBuffer commands;
+    commands.applyState(state)
+        .begin(5)
+        .applyState(state);
+
+    CORRADE_COMPARE(commands.commandCount(), 2);
+    CORRADE_COMPARE(commands.sortKeys(), (std::vector<UnsignedLong>{0, 5}));
+}
+
+void CommandBufferTest::recordEmptySegment() {
+    Renderer::StateBlock state;
+
+    /* Beginning a segment with no commands recorded replaces its key */
+    CommandBuffer commands;
+    commands.begin(5)
+        .begin(6)
+        .applyState(state)
+        .begin(1);
+
+    CORRADE_COMPARE(commands.commandCount(), 1);
+    CORRADE_COMPARE(commands.sortKeys(), (std::vector<UnsignedLong>{6, 1}));
+}
+
+void CommandBufferTest::clear() {
+    Buffer buffer{NoCreate};
+    const Int data[]{3, 4};
+
+    CommandBuffer commands;
+    commands.reserve(16, 4)
+        .begin(1)
+        .setBufferSubData(buffer, 0, data)
+        .clear();
+
+    CORRADE_VERIFY(commands.isEmpty());
+    CORRADE_COMPARE(commands.segmentCount(), 0);
+    CORRADE_COMPARE(commands.dataSize(), 0);
+}
+
+void CommandBufferTest::sort() {
+    Renderer::StateBlock state;
+
+    CommandBuffer commands;
+    commands.begin(30).applyState(state)
+        .begin(10).applyState(state).applyState(state)
+        .begin(20).applyState(state)
+        .sort();
+
+    CORRADE_COMPARE(commands.commandCount(), 4);
+    CORRADE_COMPARE(commands.sortKeys(), (std::vector<UnsignedLong>{10, 20, 30}));
+}
+
+}}
+
+CORRADE_TEST_MAIN(Magnum::Test::CommandBufferTest)
@@ -25,9 +25,19 @@
 
 #include <algorithm>
 
+#include "Magnum/Buffer.h"
 #include "Magnum/Context.h"
 #include "Magnum/Extensions.h"
 #include "Magnum/OpenGLTester.h"
+#ifdef MAGNUM_BUILD_STATISTICS
+#include "Magnum/Framebuffer.h"
+#include "Magnum/Texture.h"
+#include "Magnum/TextureFormat.h"
+#endif
+
+#if defined(MAGNUM_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+#include <thread>
+#endif
 
 namespace Magnum { namespace Test {
 
@@ -43,6 +53,16 @@ struct ContextGLTest: OpenGLTester {
     void supportedVersion();
     void isExtensionSupported();
     void isExtensionDisabled();
+    void supportedExtensions();
+
+    void makeCurrent();
+    #if defined(MAGNUM_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+    void makeCurrentThreadLocal();
+    #endif
+
+    #ifdef MAGNUM_BUILD_STATISTICS
+    void statistics();
+    #endif
 };
 
 ContextGLTest::ContextGLTest() {
@@ -54,7 +74,18 @@ ContextGLTest::ContextGLTest() {
               #endif
               &ContextGLTest::supportedVersion,
               &ContextGLTest::isExtensionSupported,
-              &ContextGLTest::isExtensionDisabled});
+              &ContextGLTest::isExtensionDisabled,
+              &ContextGLTest::supportedExtensions,
+
+              &ContextGLTest::makeCurrent,
+              #if defined(MAGNUM_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+              &ContextGLTest::makeCurrentThreadLocal,
+              #endif
+
+              #ifdef MAGNUM_BUILD_STATISTICS
+              &ContextGLTest::statistics
+              #endif
+              });
 }
 
 void ContextGLTest::constructCopyMove() {
@@ -139,6 +170,101 @@ void ContextGLTest::isExtensionDisabled() {
     #endif
 }
 
+void ContextGLTest::supportedExtensions() {
+    const std::vector<std::string> strings = Context::current().extensionStrings();
+    const std::vector<Extension>& extensions = Context::current().supportedExtensions();
+
+    /* Each extension is listed only once, is reported by the driver and is
+       not already in core */
+    std::vector<std::size_t> indices;
+    for(const Extension& extension: extensions) {
+        CORRADE_VERIFY(std::find(strings.begin(), strings.end(), extension.string()) != strings.end());
+        CORRADE_VERIFY(extension.coreVersion() == Version::None || !Context::current().isVersionSupported(extension.coreVersion()));
+        indices.push_back(extension.index());
+    }
+
+    std::sort(indices.begin(), indices.end());
+    CORRADE_VERIFY(std::unique(indices.begin(), indices.end()) == indices.end());
+}
+
+void ContextGLTest::makeCurrent() {
+    CORRADE_VERIFY(Context::hasCurrent());
+    Context& current = Context::current();
+
+    Context::makeCurrent(nullptr);
+    CORRADE_VERIFY(!Context::hasCurrent());
+
+    Context::makeCurrent(&current);
+    CORRADE_VERIFY(Context::hasCurrent());
+    CORRADE_COMPARE(&Context::current(), &current);
+}
+
+#if defined(MAGNUM_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+void ContextGLTest::makeCurrentThreadLocal() {
+    CORRADE_VERIFY(Context::hasCurrent());
+    Context& current = Context::current();
+
+    /* The context is not current in other threads and making it current
+       there doesn't affect this thread */
+    bool hasCurrentInThread = true;
+    bool isCurrentInThread = false;
+    std::thread{[&]() {
+        hasCurrentInThread = Context::hasCurrent();
+        Context::makeCurrent(&current);
+        isCurrentInThread = &Context::current() == &current;
+        Context::makeCurrent(nullptr);
+    }}.join();
+
+    CORRADE_VERIFY(!hasCurrentInThread);
+    CORRADE_VERIFY(isCurrentInThread);
+    CORRADE_VERIFY(Context::hasCurrent());
+    CORRADE_COMPARE(&Context::current(), &current);
+}
+#endif
+
+#ifdef MAGNUM_BUILD_STATISTICS
+void ContextGLTest::statistics() {
+    Context& context = Context::current();
+    context.resetStatistics();
+    CORRADE_COMPARE(context.statistics().drawCallCount, 0);
+    CORRADE_COMPARE(context.statistics().programSwitchCount, 0);
+    CORRADE_COMPARE(context.statistics().textureBindCount, 0);
+    CORRADE_COMPARE(context.statistics().bufferUploadSize, 0);
+    CORRADE_COMPARE(context.statistics().framebufferBindCount, 0);
+
+    /* Only uploads with actual data are counted */
+    const Float data[4]{};
+    Buffer buffer;
+    buffer.setData({nullptr, 32}, BufferUsage::StaticDraw);
+    CORRADE_COMPARE(context.statistics().bufferUploadSize, 0);
+    buffer.setData(data, BufferUsage::StaticDraw);
+    buffer.setSubData(4, Containers::ArrayView<const Float>{data, 2});
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(context.statistics().bufferUploadSize, 16 + 8);
+
+    /* Binding a texture to the same unit again is not counted */
+    Texture2D texture;
+    texture.bind(7);
+    texture.bind(7);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(context.statistics().textureBindCount, 1);
+
+    Texture2D color;
+    color.setStorage(1, TextureFormat::RGBA8, Vector2i{4});
+    Framebuffer framebuffer{{{}, Vector2i{4}}};
+    framebuffer.attachTexture(Framebuffer::ColorAttachment{0}, color, 0);
+    framebuffer.bind();
+    framebuffer.bind();
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(context.statistics().framebufferBindCount >= 1);
+
+    context.resetStatistics();
+    CORRADE_COMPARE(context.statistics().textureBindCount, 0);
+    CORRADE_COMPARE(context.statistics().bufferUploadSize, 0);
+    CORRADE_COMPARE(context.statistics().framebufferBindCount, 0);
+}
+#endif
+
 }}
 
 CORRADE_TEST_MAIN(Magnum::Test::ContextGLTest)
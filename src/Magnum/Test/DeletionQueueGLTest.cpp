@@ -0,0 +1,283 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <thread>
+#include <vector>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Buffer.h"
+#include "Magnum/Context.h"
+#include "Magnum/DeletionQueue.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/MemoryTracker.h"
+#include "Magnum/Mesh.h"
+#include "Magnum/OpenGLTester.h"
+#include "Magnum/Renderer.h"
+#include "Magnum/Texture.h"
+#include "Magnum/TextureFormat.h"
+
+namespace Magnum { namespace Test {
+
+struct DeletionQueueGLTest: OpenGLTester {
+    explicit DeletionQueueGLTest();
+
+    void construct();
+
+    void buffer();
+    void texture();
+    void mesh();
+    void notOwned();
+    void zeroId();
+    void fromThread();
+    void flush();
+
+    void debugType();
+};
+
+DeletionQueueGLTest::DeletionQueueGLTest() {
+    addTests({&DeletionQueueGLTest::construct,
+
+              &DeletionQueueGLTest::buffer,
+              &DeletionQueueGLTest::texture,
+              &DeletionQueueGLTest::mesh,
+              &DeletionQueueGLTest::notOwned,
+              &DeletionQueueGLTest::zeroId,
+              &DeletionQueueGLTest::fromThread,
+              &DeletionQueueGLTest::flush,
+
+              &DeletionQueueGLTest::debugType});
+}
+
+namespace {
+    /* Processes the queue until everything is deleted. The fence of the
+       batch is guaranteed to be signaled after glFinish(). */
+    std::size_t processAll(DeletionQueue& queue) {
+        std::size_t count = queue.process();
+        Renderer::finish();
+        return count + queue.process();
+    }
+}
+
+void DeletionQueueGLTest::construct() {
+    DeletionQueue& queue = Context::current().deletionQueue();
+
+    CORRADE_COMPARE(queue.pendingCount(), 0);
+    CORRADE_COMPARE(queue.inFlightCount(), 0);
+    CORRADE_COMPARE(queue.process(), 0);
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void DeletionQueueGLTest::buffer() {
+    DeletionQueue& queue = Context::current().deletionQueue();
+    MemoryTracker& tracker = Context::current().memoryTracker();
+
+    Buffer buffer;
+    buffer.setData({nullptr, 64}, BufferUsage::StaticDraw);
+    const GLuint id = buffer.id();
+    const std::size_t before = tracker.allocatedSize(MemoryObjectType::Buffer);
+
+    queue.add(std::move(buffer));
+    CORRADE_COMPARE(buffer.id(), 0);
+    CORRADE_COMPARE(queue.pendingCount(), 1);
+
+    /* The object is still alive until the queue is processed */
+    CORRADE_VERIFY(glIsBuffer(id));
+    CORRADE_COMPARE(tracker.allocatedSize(MemoryObjectType::Buffer), before);
+
+    CORRADE_COMPARE(processAll(queue), 1);
+    CORRADE_COMPARE(queue.pendingCount(), 0);
+    CORRADE_COMPARE(queue.inFlightCount(), 0);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(!glIsBuffer(id));
+    CORRADE_COMPARE(tracker.allocatedSize(MemoryObjectType::Buffer), before - 64);
+}
+
+void DeletionQueueGLTest::texture() {
+    DeletionQueue& queue = Context::current().deletionQueue();
+
+    Texture2D texture;
+    texture.setStorage(1,
+        #ifndef MAGNUM_TARGET_GLES2
+        TextureFormat::RGBA8,
+        #else
+        TextureFormat::RGBA,
+        #endif
+        {16, 16});
+    texture.bind(0);
+    const GLuint id = texture.id();
+
+    queue.add(std::move(texture));
+    CORRADE_COMPARE(texture.id(), 0);
+    CORRADE_COMPARE(queue.pendingCount(), 1);
+    CORRADE_VERIFY(glIsTexture(id));
+
+    CORRADE_COMPARE(processAll(queue), 1);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(!glIsTexture(id));
+
+    /* The binding was removed from the state tracker, so a new texture that
+       possibly reuses the ID gets bound again */
+    Texture2D another;
+    another.bind(0);
+    GLint bound;
+    glGetIntegerv(GL_TEXTURE_BINDING_2D, &bound);
+    CORRADE_COMPARE(GLuint(bound), another.id());
+}
+
+void DeletionQueueGLTest::mesh() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::vertex_array_object>())
+        CORRADE_SKIP(Extensions::GL::ARB::vertex_array_object::string() + std::string(" is not supported."));
+    #elif defined(MAGNUM_TARGET_GLES2)
+    if(!Context::current().isExtensionSupported<Extensions::GL::OES::vertex_array_object>())
+        CORRADE_SKIP(Extensions::GL::OES::vertex_array_object::string() + std::string(" is not supported."));
+    #endif
+
+    DeletionQueue& queue = Context::current().deletionQueue();
+
+    Mesh mesh;
+    const GLuint id = mesh.id();
+    CORRADE_VERIFY(id);
+
+    queue.add(std::move(mesh));
+    CORRADE_COMPARE(mesh.id(), 0);
+    CORRADE_COMPARE(queue.pendingCount(), 1);
+
+    CORRADE_COMPARE(processAll(queue), 1);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_VERIFY(!glIsVertexArray(id));
+    #else
+    CORRADE_VERIFY(!glIsVertexArrayOES(id));
+    #endif
+}
+
+void DeletionQueueGLTest::notOwned() {
+    DeletionQueue& queue = Context::current().deletionQueue();
+
+    GLuint id;
+    glGenBuffers(1, &id);
+
+    /* Wrapped object without DeleteOnDestruction is only released */
+    Buffer buffer = Buffer::wrap(id);
+    queue.add(std::move(buffer));
+    CORRADE_COMPARE(buffer.id(), 0);
+    CORRADE_COMPARE(queue.pendingCount(), 0);
+
+    CORRADE_COMPARE(processAll(queue), 0);
+
+    glDeleteBuffers(1, &id);
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void DeletionQueueGLTest::zeroId() {
+    DeletionQueue& queue = Context::current().deletionQueue();
+
+    queue.add(DeletionQueue::Type::Buffer, 0);
+    CORRADE_COMPARE(queue.pendingCount(), 0);
+}
+
+void DeletionQueueGLTest::fromThread() {
+    DeletionQueue& queue = Context::current().deletionQueue();
+
+    std::vector<Buffer> buffers;
+    std::vector<GLuint> ids;
+    for(std::size_t i = 0; i != 16; ++i) {
+        buffers.emplace_back();
+        buffers.back().setData({nullptr, 16}, BufferUsage::StaticDraw);
+        ids.push_back(buffers.back().id());
+    }
+
+    /* The workers don't touch GL at all, the context isn't current there */
+    std::thread a{[&]() {
+        for(std::size_t i = 0; i != 8; ++i) queue.add(std::move(buffers[i]));
+    }};
+    std::thread b{[&]() {
+        for(std::size_t i = 8; i != 16; ++i)
+            queue.add(DeletionQueue::Type::Buffer, buffers[i].release());
+    }};
+    a.join();
+    b.join();
+
+    CORRADE_COMPARE(queue.pendingCount(), 16);
+    CORRADE_COMPARE(processAll(queue), 16);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    for(GLuint id: ids) CORRADE_VERIFY(!glIsBuffer(id));
+}
+
+void DeletionQueueGLTest::flush() {
+    #ifndef MAGNUM_TARGET_GLES2
+    #ifndef MAGNUM_TARGET_GLES
+    const bool sync = Context::current().isExtensionSupported<Extensions::GL::ARB::sync>();
+    #else
+    const bool sync = true;
+    #endif
+    #else
+    const bool sync = false;
+    #endif
+
+    DeletionQueue& queue = Context::current().deletionQueue();
+
+    Buffer a, b;
+    const GLuint idA = a.id(), idB = b.id();
+
+    /* First one gets processed and waits on a fence (not finishing the
+       pipeline, so it's most probably not signaled yet), the second is still
+       pending */
+    queue.add(std::move(a));
+    const std::size_t processed = queue.process();
+    if(sync) {
+        CORRADE_COMPARE(processed + queue.inFlightCount(), 1);
+    } else {
+        CORRADE_COMPARE(processed, 1);
+        CORRADE_COMPARE(queue.inFlightCount(), 0);
+    }
+    queue.add(std::move(b));
+    CORRADE_COMPARE(queue.pendingCount(), 1);
+
+    CORRADE_COMPARE(queue.flush(), 2 - processed);
+    CORRADE_COMPARE(queue.pendingCount(), 0);
+    CORRADE_COMPARE(queue.inFlightCount(), 0);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(!glIsBuffer(idA));
+    CORRADE_VERIFY(!glIsBuffer(idB));
+}
+
+void DeletionQueueGLTest::debugType() {
+    std::ostringstream out;
+    Debug(&out) << DeletionQueue::Type::Texture << DeletionQueue::Type(0xde);
+    CORRADE_COMPARE(out.str(), "DeletionQueue::Type::Texture DeletionQueue::Type(0xde)\n");
+}
+
+}}
+
+CORRADE_TEST_MAIN(Magnum::Test::DeletionQueueGLTest)
@@ -0,0 +1,436 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/AbstractShaderProgram.h"
+#include "Magnum/Buffer.h"
+#include "Magnum/CommandBuffer.h"
+#include "Magnum/Context.h"
+#include "Magnum/DrawPacket.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/Framebuffer.h"
+#include "Magnum/Image.h"
+#include "Magnum/Mesh.h"
+#include "Magnum/MeshView.h"
+#include "Magnum/OpenGLTester.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Renderbuffer.h"
+#include "Magnum/RenderbufferFormat.h"
+#include "Magnum/Shader.h"
+#include "Magnum/Texture.h"
+#include "Magnum/Math/Color.h"
+
+namespace Magnum { namespace Test {
+
+struct DrawPacketGLTest: OpenGLTester {
+    explicit DrawPacketGLTest();
+
+    void construct();
+    void constructEmpty();
+    void constructMeshView();
+    void sortKey();
+
+    void submit();
+    void submitIndexed();
+    void submitMeshView();
+    void submitMultiple();
+    #ifndef MAGNUM_TARGET_GLES2
+    void submitUniformBuffers();
+    #endif
+    void commandBuffer();
+
+    void meshChangedAfter();
+};
+
+DrawPacketGLTest::DrawPacketGLTest() {
+    addTests({&DrawPacketGLTest::construct,
+              &DrawPacketGLTest::constructEmpty,
+              &DrawPacketGLTest::constructMeshView,
+              &DrawPacketGLTest::sortKey,
+
+              &DrawPacketGLTest::submit,
+              &DrawPacketGLTest::submitIndexed,
+              &DrawPacketGLTest::submitMeshView,
+              &DrawPacketGLTest::submitMultiple,
+              #ifndef MAGNUM_TARGET_GLES2
+              &DrawPacketGLTest::submitUniformBuffers,
+              #endif
+              &DrawPacketGLTest::commandBuffer,
+
+              &DrawPacketGLTest::meshChangedAfter});
+}
+
+namespace {
+    struct ColorShader: AbstractShaderProgram {
+        typedef Attribute<0, Vector3> Color;
+
+        explicit ColorShader();
+    };
+
+    ColorShader::ColorShader() {
+        #ifndef MAGNUM_TARGET_GLES
+        Shader vert(
+            #ifndef CORRADE_TARGET_APPLE
+            Version::GL210
+            #else
+            Version::GL310
+            #endif
+            , Shader::Type::Vertex);
+        Shader frag(
+            #ifndef CORRADE_TARGET_APPLE
+            Version::GL210
+            #else
+            Version::GL310
+            #endif
+            , Shader::Type::Fragment);
+        #elif defined(MAGNUM_TARGET_GLES2)
+        Shader vert(Version::GLES200, Shader::Type::Vertex);
+        Shader frag(Version::GLES200, Shader::Type::Fragment);
+        #else
+        Shader vert(Version::GLES300, Shader::Type::Vertex);
+        Shader frag(Version::GLES300, Shader::Type::Fragment);
+        #endif
+
+        vert.addSource(
+            "#if !defined(GL_ES) && __VERSION__ == 120\n"
+            "#define mediump\n"
+            "#endif\n"
+            "#if defined(GL_ES) || __VERSION__ == 120\n"
+            "#define in attribute\n"
+            "#define out varying\n"
+            "#endif\n"
+            "in mediump vec3 color;\n"
+            "out mediump vec3 interpolatedColor;\n"
+            "void main() {\n"
+            "    interpolatedColor = color;\n"
+            "    gl_Position = vec4(0.0, 0.0, 0.0, 1.0);\n"
+            "}\n");
+        frag.addSource(
+            "#if !defined(GL_ES) && __VERSION__ == 120\n"
+            "#define mediump\n"
+            "#endif\n"
+            "#if defined(GL_ES) || __VERSION__ == 120\n"
+            "#define in varying\n"
+            "#define result gl_FragColor\n"
+            "#endif\n"
+            "in mediump vec3 interpolatedColor;\n"
+            "#if !defined(GL_ES) && __VERSION__ >= 130\n"
+            "out mediump vec4 result;\n"
+            "#endif\n"
+            "void main() { result = vec4(interpolatedColor, 1.0); }\n");
+
+        CORRADE_INTERNAL_ASSERT_OUTPUT(Shader::compile({vert, frag}));
+
+        attachShaders({vert, frag});
+
+        bindAttributeLocation(Color::Location, "color");
+
+        CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+    }
+
+    /* Red, green, blue, so the result can be distinguished even with RGBA4
+       on ES2 */
+    constexpr Vector3 Colors[]{
+        {1.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f},
+        {0.0f, 0.0f, 1.0f}
+    };
+
+    struct Target {
+        explicit Target(): framebuffer{{{}, Vector2i{1}}} {
+            renderbuffer.setStorage(
+                #ifndef MAGNUM_TARGET_GLES2
+                RenderbufferFormat::RGBA8,
+                #else
+                RenderbufferFormat::RGBA4,
+                #endif
+                Vector2i{1});
+            framebuffer.attachRenderbuffer(Framebuffer::ColorAttachment(0), renderbuffer)
+                .bind();
+        }
+
+        Color4ub get() {
+            return framebuffer.read({{}, Vector2i{1}}, {PixelFormat::RGBA, PixelType::UnsignedByte}).data<Color4ub>()[0];
+        }
+
+        Renderbuffer renderbuffer;
+        Framebuffer framebuffer;
+    };
+}
+
+void DrawPacketGLTest::construct() {
+    ColorShader shader;
+    Mesh mesh{MeshPrimitive::Points};
+    mesh.setCount(3)
+        .setInstanceCount(2);
+
+    DrawPacket packet{mesh, shader};
+    CORRADE_VERIFY(!packet.isEmpty());
+    CORRADE_COMPARE(packet.shaderId(), shader.id());
+    CORRADE_COMPARE(packet.count(), 3);
+    CORRADE_COMPARE(packet.instanceCount(), 2);
+    CORRADE_COMPARE(packet.textures().size(), 0);
+
+    /* Direct VAO binding is used if the mesh has a VAO, except for instanced
+       draws on ES2 */
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_COMPARE(packet.meshId(), mesh.id());
+    #endif
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void DrawPacketGLTest::constructEmpty() {
+    ColorShader shader;
+    Mesh mesh;
+
+    DrawPacket packet{mesh, shader};
+    CORRADE_VERIFY(packet.isEmpty());
+
+    /* Submitting does nothing */
+    packet.submit();
+    DrawPacket::submit({packet, packet});
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void DrawPacketGLTest::constructMeshView() {
+    ColorShader shader;
+    Mesh mesh{MeshPrimitive::Points};
+    mesh.setCount(3);
+
+    MeshView view{mesh};
+    view.setCount(2)
+        .setBaseVertex(1);
+
+    DrawPacket packet{view, shader};
+    CORRADE_VERIFY(!packet.isEmpty());
+    CORRADE_COMPARE(packet.count(), 2);
+    CORRADE_COMPARE(packet.instanceCount(), 1);
+    CORRADE_COMPARE(packet.meshId(), mesh.id());
+}
+
+void DrawPacketGLTest::sortKey() {
+    ColorShader shader;
+    Texture2D texture;
+    Mesh mesh{MeshPrimitive::Points};
+    mesh.setCount(1);
+
+    DrawPacket packet{mesh, shader, TextureBindingSet{0, {&texture}}};
+    CORRADE_COMPARE(packet.textures().size(), 1);
+    CORRADE_COMPARE(packet.sortKey(),
+        (UnsignedLong(shader.id()) << 40)|
+        (UnsignedLong(texture.id()) << 20)|
+        UnsignedLong(mesh.id()));
+
+    /* Same shader and texture sort next to each other */
+    Mesh another{MeshPrimitive::Points};
+    another.setCount(1);
+    DrawPacket anotherPacket{another, shader, TextureBindingSet{0, {&texture}}};
+    CORRADE_COMPARE(anotherPacket.sortKey() >> 20, packet.sortKey() >> 20);
+}
+
+void DrawPacketGLTest::submit() {
+    Target target;
+
+    Buffer buffer;
+    buffer.setData(Colors, BufferUsage::StaticDraw);
+
+    ColorShader shader;
+    Mesh mesh{MeshPrimitive::Points};
+    mesh.setCount(1)
+        .setBaseVertex(1)
+        .addVertexBuffer(buffer, 0, ColorShader::Color{});
+
+    DrawPacket packet{mesh, shader};
+    packet.submit();
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(target.get(), (Color4ub{0, 255, 0, 255}));
+}
+
+void DrawPacketGLTest::submitIndexed() {
+    Target target;
+
+    Buffer buffer;
+    buffer.setData(Colors, BufferUsage::StaticDraw);
+
+    constexpr UnsignedShort indexData[]{0, 2, 1};
+    Buffer indices{Buffer::TargetHint::ElementArray};
+    indices.setData(indexData, BufferUsage::StaticDraw);
+
+    ColorShader shader;
+    Mesh mesh{MeshPrimitive::Points};
+    mesh.setCount(1)
+        .addVertexBuffer(buffer, 0, ColorShader::Color{})
+        .setIndexBuffer(indices, 2, Mesh::IndexType::UnsignedShort);
+
+    DrawPacket packet{mesh, shader};
+    packet.submit();
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(target.get(), (Color4ub{0, 0, 255, 255}));
+}
+
+void DrawPacketGLTest::submitMeshView() {
+    Target target;
+
+    Buffer buffer;
+    buffer.setData(Colors, BufferUsage::StaticDraw);
+
+    ColorShader shader;
+    Mesh mesh{MeshPrimitive::Points};
+    mesh.setCount(3)
+        .addVertexBuffer(buffer, 0, ColorShader::Color{});
+
+    MeshView view{mesh};
+    view.setCount(1)
+        .setBaseVertex(2);
+
+    DrawPacket packet{view, shader};
+    packet.submit();
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(target.get(), (Color4ub{0, 0, 255, 255}));
+}
+
+void DrawPacketGLTest::submitMultiple() {
+    Target target;
+
+    Buffer buffer;
+    buffer.setData(Colors, BufferUsage::StaticDraw);
+
+    ColorShader shader;
+    Mesh a{MeshPrimitive::Points}, b{MeshPrimitive::Points}, empty;
+    a.setCount(1)
+        .addVertexBuffer(buffer, 0, ColorShader::Color{});
+    b.setCount(1)
+        .setBaseVertex(1)
+        .addVertexBuffer(buffer, 0, ColorShader::Color{});
+
+    /* The last non-empty packet wins */
+    const DrawPacket packets[]{
+        DrawPacket{b, shader},
+        DrawPacket{a, shader},
+        DrawPacket{empty, shader}
+    };
+    DrawPacket::submit(packets);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(target.get(), (Color4ub{255, 0, 0, 255}));
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+void DrawPacketGLTest::submitUniformBuffers() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(Extensions::GL::ARB::uniform_buffer_object::string() + std::string(" is not available."));
+    #endif
+
+    Target target;
+
+    Buffer buffer;
+    buffer.setData(Colors, BufferUsage::StaticDraw);
+
+    Buffer uniforms{Buffer::TargetHint::Uniform}, other{Buffer::TargetHint::Uniform};
+    uniforms.setData({nullptr, 256}, BufferUsage::DynamicDraw);
+    other.setData({nullptr, 256}, BufferUsage::DynamicDraw);
+
+    ColorShader shader;
+    Mesh mesh{MeshPrimitive::Points};
+    mesh.setCount(1)
+        .addVertexBuffer(buffer, 0, ColorShader::Color{});
+
+    /* The second packet has the same binding as the first, so it's skipped,
+       the binding done by the first packet has to survive */
+    const DrawPacket packets[]{
+        DrawPacket{mesh, shader, TextureBindingSet{}, {{0, &other, 0, 16}}},
+        DrawPacket{mesh, shader, TextureBindingSet{}, {{0, &uniforms, 0, 16}}},
+        DrawPacket{mesh, shader, TextureBindingSet{}, {{0, &uniforms, 0, 16}}}
+    };
+    DrawPacket::submit(packets);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(target.get(), (Color4ub{255, 0, 0, 255}));
+
+    GLint bound;
+    glGetIntegeri_v(GL_UNIFORM_BUFFER_BINDING, 0, &bound);
+    CORRADE_COMPARE(GLuint(bound), uniforms.id());
+}
+#endif
+
+void DrawPacketGLTest::commandBuffer() {
+    Target target;
+
+    Buffer buffer;
+    buffer.setData(Colors, BufferUsage::StaticDraw);
+
+    ColorShader shader;
+    Mesh a{MeshPrimitive::Points}, b{MeshPrimitive::Points};
+    a.setCount(1)
+        .addVertexBuffer(buffer, 0, ColorShader::Color{});
+    b.setCount(1)
+        .setBaseVertex(2)
+        .addVertexBuffer(buffer, 0, ColorShader::Color{});
+
+    DrawPacket packetA{a, shader}, packetB{b, shader};
+
+    /* Segment with packet B is recorded first but has a higher key */
+    CommandBuffer commands;
+    commands.begin(2).draw(packetB)
+        .begin(1).draw(packetA)
+        .sort();
+    MAGNUM_VERIFY_NO_ERROR();
+
+    commands.replay();
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(target.get(), (Color4ub{0, 0, 255, 255}));
+}
+
+void DrawPacketGLTest::meshChangedAfter() {
+    Target target;
+
+    Buffer buffer;
+    buffer.setData(Colors, BufferUsage::StaticDraw);
+
+    ColorShader shader;
+    Mesh mesh{MeshPrimitive::Points};
+    mesh.setCount(1)
+        .setBaseVertex(1)
+        .addVertexBuffer(buffer, 0, ColorShader::Color{});
+
+    /* The packet captures the mesh properties on construction */
+    DrawPacket packet{mesh, shader};
+    mesh.setBaseVertex(2);
+    CORRADE_COMPARE(packet.count(), 1);
+
+    packet.submit();
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(target.get(), (Color4ub{0, 255, 0, 255}));
+}
+
+}}
+
+CORRADE_TEST_MAIN(Magnum::Test::DrawPacketGLTest)
@@ -0,0 +1,232 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/DynamicResolution.h"
+
+namespace Magnum { namespace Test {
+
+struct DynamicResolutionTest: TestSuite::Tester {
+    explicit DynamicResolutionTest();
+
+    void construct();
+    void setters();
+    void setInvalid();
+
+    void renderSize();
+    void renderSizeSmall();
+
+    void updateSlower();
+    void updateFaster();
+    void updateClamped();
+    void updateHysteresis();
+    void updateSmoothing();
+    void updateHeadroom();
+};
+
+DynamicResolutionTest::DynamicResolutionTest() {
+    addTests({&DynamicResolutionTest::construct,
+              &DynamicResolutionTest::setters,
+              &DynamicResolutionTest::setInvalid,
+
+              &DynamicResolutionTest::renderSize,
+              &DynamicResolutionTest::renderSizeSmall,
+
+              &DynamicResolutionTest::updateSlower,
+              &DynamicResolutionTest::updateFaster,
+              &DynamicResolutionTest::updateClamped,
+              &DynamicResolutionTest::updateHysteresis,
+              &DynamicResolutionTest::updateSmoothing,
+              &DynamicResolutionTest::updateHeadroom});
+}
+
+using namespace std::chrono;
+
+void DynamicResolutionTest::construct() {
+    DynamicResolution resolution{{1920, 1080}, milliseconds{16}};
+
+    CORRADE_COMPARE(resolution.outputSize(), (Vector2i{1920, 1080}));
+    CORRADE_COMPARE(resolution.targetFrameTime().count(), 16000000);
+    CORRADE_COMPARE(resolution.minScale(), 0.5f);
+    CORRADE_COMPARE(resolution.maxScale(), 1.0f);
+    CORRADE_COMPARE(resolution.smoothing(), 0.75f);
+    CORRADE_COMPARE(resolution.hysteresis(), 0.05f);
+    CORRADE_COMPARE(resolution.headroom(), 0.9f);
+    CORRADE_COMPARE(resolution.granularity(), 8);
+    CORRADE_COMPARE(resolution.scale(), 1.0f);
+    CORRADE_COMPARE(resolution.smoothedFrameTime().count(), 0);
+    CORRADE_COMPARE(resolution.renderSize(), (Vector2i{1920, 1080}));
+    CORRADE_COMPARE(resolution.viewport(), (Range2Di{{}, {1920, 1080}}));
+}
+
+void DynamicResolutionTest::setters() {
+    DynamicResolution resolution{{1920, 1080}, milliseconds{16}};
+    resolution.setOutputSize({1280, 720})
+        .setTargetFrameTime(milliseconds{33})
+        .setScaleRange(0.25f, 0.75f)
+        .setSmoothing(0.0f)
+        .setHysteresis(0.1f)
+        .setHeadroom(1.0f)
+        .setGranularity(16);
+
+    CORRADE_COMPARE(resolution.outputSize(), (Vector2i{1280, 720}));
+    CORRADE_COMPARE(resolution.targetFrameTime().count(), 33000000);
+    CORRADE_COMPARE(resolution.minScale(), 0.25f);
+    CORRADE_COMPARE(resolution.maxScale(), 0.75f);
+    CORRADE_COMPARE(resolution.smoothing(), 0.0f);
+    CORRADE_COMPARE(resolution.hysteresis(), 0.1f);
+    CORRADE_COMPARE(resolution.headroom(), 1.0f);
+    CORRADE_COMPARE(resolution.granularity(), 16);
+
+    /* Scale got clamped to the new range, 540 rounded up to 544 is clamped
+       back */
+    CORRADE_COMPARE(resolution.scale(), 0.75f);
+    CORRADE_COMPARE(resolution.renderSize(), (Vector2i{960, 540}));
+}
+
+void DynamicResolutionTest::setInvalid() {
+    DynamicResolution resolution{{1920, 1080}, milliseconds{16}};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    resolution.setScaleRange(0.0f, 1.0f);
+    resolution.setScaleRange(1.0f, 0.5f);
+    resolution.setSmoothing(1.0f);
+    resolution.setHeadroom(0.0f);
+    resolution.setGranularity(0);
+    CORRADE_COMPARE(out.str(),
+        "DynamicResolution::setScaleRange(): invalid range 0 1\n"
+        "DynamicResolution::setScaleRange(): invalid range 1 0.5\n"
+        "DynamicResolution::setSmoothing(): expected a value in range [0, 1) but got 1\n"
+        "DynamicResolution::setHeadroom(): expected a value in range (0, 1] but got 0\n"
+        "DynamicResolution::setGranularity(): expected a positive value but got 0\n");
+}
+
+void DynamicResolutionTest::renderSize() {
+    DynamicResolution resolution{{1000, 600}, milliseconds{16}};
+    resolution.setScaleRange(0.55f, 0.55f);
+
+    /* 550 gets rounded up to 552, but that's more than the maximal size, so
+       it's clamped back. 330 gets rounded down to 328. */
+    CORRADE_COMPARE(resolution.renderSize(), (Vector2i{550, 328}));
+}
+
+void DynamicResolutionTest::renderSizeSmall() {
+    DynamicResolution resolution{{4, 12}, milliseconds{16}};
+    resolution.setScaleRange(0.1f, 1.0f)
+        .setSmoothing(0.0f);
+    resolution.update(seconds{10});
+    CORRADE_COMPARE(resolution.scale(), 0.1f);
+
+    /* At least the granularity, but not more than the output */
+    CORRADE_COMPARE(resolution.renderSize(), (Vector2i{4, 8}));
+}
+
+void DynamicResolutionTest::updateSlower() {
+    DynamicResolution resolution{{1600, 800}, milliseconds{16}};
+    resolution.setSmoothing(0.0f)
+        .setHeadroom(1.0f);
+
+    /* Twice as slow as the target, so half the pixels */
+    CORRADE_VERIFY(resolution.update(milliseconds{32}));
+    CORRADE_COMPARE(resolution.scale(), 0.707107f);
+    CORRADE_COMPARE(resolution.renderSize(), (Vector2i{1128, 568}));
+
+    /* On target, nothing changes */
+    CORRADE_VERIFY(!resolution.update(milliseconds{16}));
+    CORRADE_COMPARE(resolution.scale(), 0.707107f);
+}
+
+void DynamicResolutionTest::updateFaster() {
+    DynamicResolution resolution{{1600, 800}, milliseconds{16}};
+    resolution.setSmoothing(0.0f)
+        .setHeadroom(1.0f)
+        .setScaleRange(0.25f, 2.0f);
+
+    /* Four times as fast as the target, so four times the pixels */
+    CORRADE_VERIFY(resolution.update(milliseconds{4}));
+    CORRADE_COMPARE(resolution.scale(), 2.0f);
+    CORRADE_COMPARE(resolution.renderSize(), (Vector2i{3200, 1600}));
+}
+
+void DynamicResolutionTest::updateClamped() {
+    DynamicResolution resolution{{1600, 800}, milliseconds{16}};
+    resolution.setSmoothing(0.0f);
+
+    CORRADE_VERIFY(resolution.update(milliseconds{1000}));
+    CORRADE_COMPARE(resolution.scale(), 0.5f);
+
+    CORRADE_VERIFY(resolution.update(milliseconds{1}));
+    CORRADE_COMPARE(resolution.scale(), 1.0f);
+
+    /* Already at maximum */
+    CORRADE_VERIFY(!resolution.update(milliseconds{1}));
+    CORRADE_COMPARE(resolution.scale(), 1.0f);
+}
+
+void DynamicResolutionTest::updateHysteresis() {
+    DynamicResolution resolution{{1600, 800}, milliseconds{16}};
+    resolution.setSmoothing(0.0f)
+        .setHeadroom(1.0f);
+
+    /* Ideal scale is 0.97, which is within the hysteresis */
+    CORRADE_VERIFY(!resolution.update(milliseconds{17}));
+    CORRADE_COMPARE(resolution.scale(), 1.0f);
+
+    /* Ideal scale is 0.94, which is not */
+    CORRADE_VERIFY(resolution.update(milliseconds{18}));
+    CORRADE_COMPARE(resolution.scale(), 0.942809f);
+}
+
+void DynamicResolutionTest::updateSmoothing() {
+    DynamicResolution resolution{{1600, 800}, milliseconds{16}};
+    resolution.setSmoothing(0.5f)
+        .setHysteresis(1.0f);
+
+    /* First measurement is taken as-is, next are averaged */
+    resolution.update(milliseconds{20});
+    CORRADE_COMPARE(resolution.smoothedFrameTime().count(), 20000000);
+    resolution.update(milliseconds{10});
+    CORRADE_COMPARE(resolution.smoothedFrameTime().count(), 15000000);
+
+    /* Hysteresis prevented any change */
+    CORRADE_COMPARE(resolution.scale(), 1.0f);
+}
+
+void DynamicResolutionTest::updateHeadroom() {
+    DynamicResolution resolution{{1600, 800}, milliseconds{16}};
+    resolution.setSmoothing(0.0f)
+        .setHeadroom(0.5f);
+
+    /* Exactly on target, but aiming at half of it */
+    CORRADE_VERIFY(resolution.update(milliseconds{16}));
+    CORRADE_COMPARE(resolution.scale(), 0.707107f);
+}
+
+}}
+
+CORRADE_TEST_MAIN(Magnum::Test::DynamicResolutionTest)
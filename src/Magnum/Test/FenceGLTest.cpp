@@ -0,0 +1,132 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <chrono>
+
+#include "Magnum/Buffer.h"
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/Fence.h"
+#include "Magnum/OpenGLTester.h"
+
+namespace Magnum { namespace Test {
+
+struct FenceGLTest: OpenGLTester {
+    explicit FenceGLTest();
+
+    void insert();
+    void clientWait();
+    void wait();
+    void constructMove();
+};
+
+FenceGLTest::FenceGLTest() {
+    addTests({&FenceGLTest::insert,
+              &FenceGLTest::clientWait,
+              &FenceGLTest::wait,
+              &FenceGLTest::constructMove});
+}
+
+void FenceGLTest::insert() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::sync>())
+        CORRADE_SKIP(Extensions::GL::ARB::sync::string() + std::string(" is not supported"));
+    #endif
+
+    Fence fence;
+    fence.insert();
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(!fence.isEmpty());
+
+    /* Inserting again replaces the previous object */
+    fence.insert();
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(!fence.isEmpty());
+}
+
+void FenceGLTest::clientWait() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::sync>())
+        CORRADE_SKIP(Extensions::GL::ARB::sync::string() + std::string(" is not supported"));
+    #endif
+
+    /* Empty fence is always signaled */
+    Fence fence;
+    CORRADE_VERIFY(fence.isSignaled());
+    CORRADE_COMPARE(fence.clientWait(std::chrono::nanoseconds{0}), Fence::WaitResult::AlreadySignaled);
+
+    constexpr char data[] = {2, 7, 5, 13, 25};
+    Buffer buffer;
+    buffer.setData(data, BufferUsage::StaticDraw);
+    fence.insert();
+
+    /* Waiting for a long time should eventually succeed */
+    const Fence::WaitResult result = fence.clientWait(std::chrono::seconds{5});
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(result == Fence::WaitResult::AlreadySignaled || result == Fence::WaitResult::ConditionSatisfied);
+    CORRADE_VERIFY(fence.isSignaled());
+}
+
+void FenceGLTest::wait() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::sync>())
+        CORRADE_SKIP(Extensions::GL::ARB::sync::string() + std::string(" is not supported"));
+    #endif
+
+    Fence fence;
+    /* Does nothing for an empty fence */
+    fence.wait();
+    MAGNUM_VERIFY_NO_ERROR();
+
+    fence.insert().wait();
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void FenceGLTest::constructMove() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::sync>())
+        CORRADE_SKIP(Extensions::GL::ARB::sync::string() + std::string(" is not supported"));
+    #endif
+
+    Fence a;
+    a.insert();
+    const GLsync id = a.id();
+
+    Fence b{std::move(a)};
+    CORRADE_VERIFY(a.isEmpty());
+    CORRADE_COMPARE(b.id(), id);
+
+    Fence c;
+    c.insert();
+    const GLsync cId = c.id();
+    c = std::move(b);
+    CORRADE_COMPARE(b.id(), cId);
+    CORRADE_COMPARE(c.id(), id);
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+}}
+
+CORRADE_TEST_MAIN(Magnum::Test::FenceGLTest)
@@ -0,0 +1,68 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Fence.h"
+
+namespace Magnum { namespace Test {
+
+struct FenceTest: TestSuite::Tester {
+    explicit FenceTest();
+
+    void construct();
+    void debugWaitResult();
+};
+
+FenceTest::FenceTest() {
+    addTests({&FenceTest::construct,
+              &FenceTest::debugWaitResult});
+}
+
+void FenceTest::construct() {
+    /* Doesn't call into GL, so it works without a context */
+    {
+        Fence fence;
+        CORRADE_VERIFY(fence.isEmpty());
+        CORRADE_VERIFY(!fence.id());
+
+        Fence b{std::move(fence)};
+        CORRADE_VERIFY(b.isEmpty());
+    }
+
+    CORRADE_VERIFY(true);
+}
+
+void FenceTest::debugWaitResult() {
+    std::ostringstream out;
+
+    Debug(&out) << Fence::WaitResult::ConditionSatisfied << Fence::WaitResult(0xdead);
+    CORRADE_COMPARE(out.str(), "Fence::WaitResult::ConditionSatisfied Fence::WaitResult(0xdead)\n");
+}
+
+}}
+
+CORRADE_TEST_MAIN(Magnum::Test::FenceTest)
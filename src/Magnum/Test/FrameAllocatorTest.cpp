@@ -0,0 +1,249 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstdint>
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/FrameAllocator.h"
+
+namespace Magnum { namespace Test {
+
+struct FrameAllocatorTest: TestSuite::Tester {
+    explicit FrameAllocatorTest();
+
+    void construct();
+    void current();
+
+    void allocate();
+    void allocateZeroSize();
+    void allocateAligned();
+    void allocateInvalidAlignment();
+    void allocateTyped();
+    void allocateGrow();
+
+    void reset();
+    void resetMergeBlocks();
+
+    void adapter();
+    void adapterNoAllocator();
+};
+
+FrameAllocatorTest::FrameAllocatorTest() {
+    addTests({&FrameAllocatorTest::construct,
+              &FrameAllocatorTest::current,
+
+              &FrameAllocatorTest::allocate,
+              &FrameAllocatorTest::allocateZeroSize,
+              &FrameAllocatorTest::allocateAligned,
+              &FrameAllocatorTest::allocateInvalidAlignment,
+              &FrameAllocatorTest::allocateTyped,
+              &FrameAllocatorTest::allocateGrow,
+
+              &FrameAllocatorTest::reset,
+              &FrameAllocatorTest::resetMergeBlocks,
+
+              &FrameAllocatorTest::adapter,
+              &FrameAllocatorTest::adapterNoAllocator});
+}
+
+void FrameAllocatorTest::construct() {
+    FrameAllocator allocator{1024};
+    CORRADE_COMPARE(allocator.capacity(), 1024);
+    CORRADE_COMPARE(allocator.blockCount(), 0);
+    CORRADE_COMPARE(allocator.usedSize(), 0);
+}
+
+void FrameAllocatorTest::current() {
+    CORRADE_VERIFY(!FrameAllocator::current());
+
+    {
+        /* Creating an allocator doesn't make it current */
+        FrameAllocator a;
+        CORRADE_VERIFY(!FrameAllocator::current());
+
+        CORRADE_COMPARE(&a.makeCurrent(), &a);
+        CORRADE_COMPARE(FrameAllocator::current(), &a);
+
+        /* Creating another one doesn't replace the current one, making it
+           current does */
+        {
+            FrameAllocator b;
+            CORRADE_COMPARE(FrameAllocator::current(), &a);
+
+            b.makeCurrent();
+            CORRADE_COMPARE(FrameAllocator::current(), &b);
+        }
+
+        /* The previous one isn't restored */
+        CORRADE_VERIFY(!FrameAllocator::current());
+
+        a.makeCurrent();
+        CORRADE_COMPARE(FrameAllocator::current(), &a);
+    }
+
+    CORRADE_VERIFY(!FrameAllocator::current());
+}
+
+void FrameAllocatorTest::allocate() {
+    FrameAllocator allocator{1024};
+
+    char* a = static_cast<char*>(allocator.allocate(100, 1));
+    char* b = static_cast<char*>(allocator.allocate(28, 1));
+    CORRADE_VERIFY(a);
+    CORRADE_COMPARE(b, a + 100);
+    CORRADE_COMPARE(allocator.blockCount(), 1);
+    CORRADE_COMPARE(allocator.usedSize(), 128);
+
+    /* The memory is usable */
+    for(std::size_t i = 0; i != 100; ++i) a[i] = char(i);
+    for(std::size_t i = 0; i != 28; ++i) b[i] = char(i);
+    CORRADE_COMPARE(a[99], char(99));
+}
+
+void FrameAllocatorTest::allocateZeroSize() {
+    FrameAllocator allocator;
+    CORRADE_VERIFY(!allocator.allocate(0));
+    CORRADE_COMPARE(allocator.blockCount(), 0);
+    CORRADE_COMPARE(allocator.usedSize(), 0);
+}
+
+void FrameAllocatorTest::allocateAligned() {
+    FrameAllocator allocator{1024};
+
+    allocator.allocate(3, 1);
+    void* a = allocator.allocate(4, 4);
+    void* b = allocator.allocate(1, 64);
+    CORRADE_COMPARE(reinterpret_cast<std::uintptr_t>(a) % 4, 0);
+    CORRADE_COMPARE(reinterpret_cast<std::uintptr_t>(b) % 64, 0);
+    CORRADE_VERIFY(allocator.usedSize() >= 8);
+}
+
+void FrameAllocatorTest::allocateInvalidAlignment() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    FrameAllocator allocator;
+    allocator.allocate(16, 0);
+    allocator.allocate(16, 12);
+    CORRADE_COMPARE(out.str(),
+        "FrameAllocator::allocate(): expected alignment to be a power of two but got 0\n"
+        "FrameAllocator::allocate(): expected alignment to be a power of two but got 12\n");
+}
+
+void FrameAllocatorTest::allocateTyped() {
+    struct Data {
+        Int a = 3;
+        Double b;
+    };
+
+    FrameAllocator allocator{1024};
+    allocator.allocate(1, 1);
+    Containers::ArrayView<Data> data = allocator.allocate<Data>(5);
+    CORRADE_COMPARE(data.size(), 5);
+    CORRADE_COMPARE(reinterpret_cast<std::uintptr_t>(data.data()) % alignof(Data), 0);
+    CORRADE_COMPARE(data[4].a, 3);
+}
+
+void FrameAllocatorTest::allocateGrow() {
+    FrameAllocator allocator{64};
+
+    char* a = static_cast<char*>(allocator.allocate(48, 1));
+    CORRADE_COMPARE(allocator.blockCount(), 1);
+
+    /* Doesn't fit into the first block, second is twice as large */
+    char* b = static_cast<char*>(allocator.allocate(48, 1));
+    CORRADE_COMPARE(allocator.blockCount(), 2);
+    CORRADE_COMPARE(allocator.capacity(), 64 + 128);
+    CORRADE_COMPARE(allocator.usedSize(), 96);
+
+    /* Previous allocation stays valid */
+    a[47] = 'a';
+    b[47] = 'b';
+    CORRADE_COMPARE(a[47], 'a');
+
+    /* Larger than twice the previous block */
+    allocator.allocate(1000, 1);
+    CORRADE_COMPARE(allocator.blockCount(), 3);
+    CORRADE_COMPARE(allocator.capacity(), 64 + 128 + 1000);
+}
+
+void FrameAllocatorTest::reset() {
+    FrameAllocator allocator{1024};
+
+    void* a = allocator.allocate(100);
+    allocator.reset();
+    CORRADE_COMPARE(allocator.usedSize(), 0);
+    CORRADE_COMPARE(allocator.blockCount(), 1);
+
+    /* The memory is reused */
+    CORRADE_COMPARE(allocator.allocate(100), a);
+}
+
+void FrameAllocatorTest::resetMergeBlocks() {
+    FrameAllocator allocator{64};
+
+    allocator.allocate(48, 1);
+    allocator.allocate(100, 1);
+    CORRADE_COMPARE(allocator.blockCount(), 2);
+
+    /* Everything from the previous frame fits into a single block now */
+    allocator.reset();
+    CORRADE_COMPARE(allocator.blockCount(), 1);
+    CORRADE_COMPARE(allocator.capacity(), 64 + 128);
+
+    allocator.allocate(48, 1);
+    allocator.allocate(100, 1);
+    CORRADE_COMPARE(allocator.blockCount(), 1);
+}
+
+void FrameAllocatorTest::adapter() {
+    FrameAllocator allocator{1024};
+
+    std::vector<Int, FrameAllocatorAdapter<Int>> vector{FrameAllocatorAdapter<Int>{&allocator}};
+    vector.reserve(10);
+    for(Int i = 0; i != 10; ++i) vector.push_back(i);
+    CORRADE_COMPARE(vector.get_allocator().allocator(), &allocator);
+    CORRADE_COMPARE(vector[9], 9);
+    CORRADE_COMPARE(allocator.usedSize(), 10*sizeof(Int));
+
+    /* Rebound adapters compare equal */
+    CORRADE_VERIFY(FrameAllocatorAdapter<Double>{vector.get_allocator()} == vector.get_allocator());
+    CORRADE_VERIFY(FrameAllocatorAdapter<Int>{nullptr} != vector.get_allocator());
+}
+
+void FrameAllocatorTest::adapterNoAllocator() {
+    CORRADE_VERIFY(!FrameAllocator::current());
+
+    /* Falls back to the system allocator */
+    std::vector<Int, FrameAllocatorAdapter<Int>> vector;
+    for(Int i = 0; i != 100; ++i) vector.push_back(i);
+    CORRADE_VERIFY(!vector.get_allocator().allocator());
+    CORRADE_COMPARE(vector[99], 99);
+}
+
+}}
+
+CORRADE_TEST_MAIN(Magnum::Test::FrameAllocatorTest)
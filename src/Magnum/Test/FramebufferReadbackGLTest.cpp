@@ -0,0 +1,234 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/Framebuffer.h"
+#include "Magnum/FramebufferReadback.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Renderbuffer.h"
+#include "Magnum/RenderbufferFormat.h"
+#include "Magnum/Renderer.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/OpenGLTester.h"
+
+namespace Magnum { namespace Test {
+
+struct FramebufferReadbackGLTest: OpenGLTester {
+    explicit FramebufferReadbackGLTest();
+
+    void construct();
+    void constructMove();
+
+    void read();
+    void readRingFull();
+    void readSizeChange();
+};
+
+FramebufferReadbackGLTest::FramebufferReadbackGLTest() {
+    addTests({&FramebufferReadbackGLTest::construct,
+              &FramebufferReadbackGLTest::constructMove,
+
+              &FramebufferReadbackGLTest::read,
+              &FramebufferReadbackGLTest::readRingFull,
+              &FramebufferReadbackGLTest::readSizeChange});
+}
+
+namespace {
+    struct Framebuffer4x4 {
+        explicit Framebuffer4x4() {
+            color.setStorage(RenderbufferFormat::RGBA8, Vector2i{4});
+            framebuffer.attachRenderbuffer(Framebuffer::ColorAttachment{0}, color);
+        }
+
+        void clear(const Color4ub& value) {
+            Renderer::setClearColor(Math::unpack<Color4>(value));
+            framebuffer.clear(FramebufferClear::Color);
+        }
+
+        Renderbuffer color;
+        Framebuffer framebuffer{{{}, Vector2i{4}}};
+    };
+}
+
+void FramebufferReadbackGLTest::construct() {
+    FramebufferReadback readback{PixelFormat::RGBA, PixelType::UnsignedByte, 4};
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(readback.slotCount(), 4);
+    CORRADE_COMPARE(readback.pendingCount(), 0);
+    CORRADE_VERIFY(!readback.isNextAvailable());
+    CORRADE_VERIFY(!readback.mapNext().data());
+}
+
+void FramebufferReadbackGLTest::constructMove() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::sync>())
+        CORRADE_SKIP(Extensions::GL::ARB::sync::string() + std::string(" is not supported."));
+    #endif
+
+    Framebuffer4x4 fb;
+    fb.clear({128, 64, 32, 17});
+
+    FramebufferReadback a{PixelFormat::RGBA, PixelType::UnsignedByte};
+    CORRADE_VERIFY(a.read(fb.framebuffer, {{}, Vector2i{4}}));
+
+    FramebufferReadback b{std::move(a)};
+    CORRADE_COMPARE(a.slotCount(), 0);
+    CORRADE_COMPARE(a.pendingCount(), 0);
+    CORRADE_COMPARE(b.slotCount(), 3);
+    CORRADE_COMPARE(b.pendingCount(), 1);
+
+    FramebufferReadback c{PixelFormat::RGBA, PixelType::UnsignedByte, 2};
+    c = std::move(b);
+    CORRADE_COMPARE(b.slotCount(), 2);
+    CORRADE_COMPARE(b.pendingCount(), 0);
+    CORRADE_COMPARE(c.slotCount(), 3);
+    CORRADE_COMPARE(c.pendingCount(), 1);
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void FramebufferReadbackGLTest::read() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::sync>())
+        CORRADE_SKIP(Extensions::GL::ARB::sync::string() + std::string(" is not supported."));
+    #endif
+
+    Framebuffer4x4 fb;
+    FramebufferReadback readback{PixelFormat::RGBA, PixelType::UnsignedByte};
+
+    fb.clear({128, 64, 32, 17});
+    CORRADE_VERIFY(readback.read(fb.framebuffer, Range2Di::fromSize({1, 1}, {2, 3})));
+    fb.clear({3, 5, 7, 9});
+    CORRADE_VERIFY(readback.read(fb.framebuffer, Range2Di::fromSize({1, 1}, {2, 3})));
+    CORRADE_COMPARE(readback.pendingCount(), 2);
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /* Make sure both reads are done so the test is deterministic */
+    Renderer::finish();
+
+    {
+        CORRADE_VERIFY(readback.isNextAvailable());
+        ImageView2D image = readback.mapNext();
+        MAGNUM_VERIFY_NO_ERROR();
+        CORRADE_VERIFY(image.data());
+        CORRADE_COMPARE(image.size(), (Vector2i{2, 3}));
+        CORRADE_COMPARE(image.data<Color4ub>()[0], (Color4ub{128, 64, 32, 17}));
+        CORRADE_COMPARE(image.data<Color4ub>()[5], (Color4ub{128, 64, 32, 17}));
+
+        /* Can't map another one until this one is released */
+        CORRADE_VERIFY(!readback.isNextAvailable());
+        CORRADE_VERIFY(!readback.mapNext().data());
+
+        readback.unmap();
+        MAGNUM_VERIFY_NO_ERROR();
+        CORRADE_COMPARE(readback.pendingCount(), 1);
+    } {
+        CORRADE_VERIFY(readback.isNextAvailable());
+        ImageView2D image = readback.mapNext();
+        MAGNUM_VERIFY_NO_ERROR();
+        CORRADE_COMPARE(image.data<Color4ub>()[0], (Color4ub{3, 5, 7, 9}));
+
+        readback.unmap();
+        MAGNUM_VERIFY_NO_ERROR();
+        CORRADE_COMPARE(readback.pendingCount(), 0);
+    }
+
+    CORRADE_VERIFY(!readback.isNextAvailable());
+}
+
+void FramebufferReadbackGLTest::readRingFull() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::sync>())
+        CORRADE_SKIP(Extensions::GL::ARB::sync::string() + std::string(" is not supported."));
+    #endif
+
+    Framebuffer4x4 fb;
+    FramebufferReadback readback{PixelFormat::RGBA, PixelType::UnsignedByte, 2};
+
+    fb.clear({1, 1, 1, 1});
+    CORRADE_VERIFY(readback.read(fb.framebuffer, {{}, Vector2i{4}}));
+    fb.clear({2, 2, 2, 2});
+    CORRADE_VERIFY(readback.read(fb.framebuffer, {{}, Vector2i{4}}));
+
+    /* Ring is full, the read is dropped */
+    fb.clear({3, 3, 3, 3});
+    CORRADE_VERIFY(!readback.read(fb.framebuffer, {{}, Vector2i{4}}));
+    CORRADE_COMPARE(readback.pendingCount(), 2);
+
+    Renderer::finish();
+    CORRADE_COMPARE(readback.mapNext().data<Color4ub>()[15], (Color4ub{1, 1, 1, 1}));
+    readback.unmap();
+
+    /* A slot is free again, wrap around */
+    CORRADE_VERIFY(readback.read(fb.framebuffer, {{}, Vector2i{4}}));
+    Renderer::finish();
+    CORRADE_COMPARE(readback.mapNext().data<Color4ub>()[15], (Color4ub{2, 2, 2, 2}));
+    readback.unmap();
+    CORRADE_COMPARE(readback.mapNext().data<Color4ub>()[15], (Color4ub{3, 3, 3, 3}));
+    readback.unmap();
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(readback.pendingCount(), 0);
+}
+
+void FramebufferReadbackGLTest::readSizeChange() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::sync>())
+        CORRADE_SKIP(Extensions::GL::ARB::sync::string() + std::string(" is not supported."));
+    #endif
+
+    Framebuffer4x4 fb;
+    FramebufferReadback readback{PixelFormat::RGBA, PixelType::UnsignedByte, 2};
+
+    fb.clear({128, 64, 32, 17});
+    readback.read(fb.framebuffer, {{}, Vector2i{1}});
+    readback.read(fb.framebuffer, {{}, Vector2i{4}});
+    Renderer::finish();
+
+    CORRADE_COMPARE(readback.mapNext().size(), Vector2i{1});
+    readback.unmap();
+
+    /* Slot gets reallocated for a larger rectangle */
+    readback.read(fb.framebuffer, {{}, {4, 2}});
+    Renderer::finish();
+
+    CORRADE_COMPARE(readback.mapNext().size(), Vector2i{4});
+    readback.unmap();
+    {
+        ImageView2D image = readback.mapNext();
+        CORRADE_COMPARE(image.size(), (Vector2i{4, 2}));
+        CORRADE_COMPARE(image.data<Color4ub>()[7], (Color4ub{128, 64, 32, 17}));
+    }
+    readback.unmap();
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+}}
+
+CORRADE_TEST_MAIN(Magnum::Test::FramebufferReadbackGLTest)
@@ -0,0 +1,435 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/TestSuite/Compare/Numeric.h>
+
+#include "Magnum/AbstractShaderProgram.h"
+#include "Magnum/Buffer.h"
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/Framebuffer.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/Mesh.h"
+#include "Magnum/OpenGLTester.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Renderbuffer.h"
+#include "Magnum/RenderbufferFormat.h"
+#include "Magnum/Shader.h"
+#include "Magnum/Texture.h"
+#include "Magnum/TextureFormat.h"
+#include "Magnum/Math/Color.h"
+
+namespace Magnum { namespace Test {
+
+/* Measures CPU overhead of the most frequently called wrapper APIs compared
+   to equivalent raw GL calls. The implementation path used by the wrappers
+   is shown in the test case description, run with for example
+   --magnum-disable-extensions "GL_ARB_direct_state_access GL_EXT_direct_state_access"
+   to benchmark the classic code paths on drivers that support DSA. */
+
+struct GLWrapperBenchmark: OpenGLTester {
+    explicit GLWrapperBenchmark();
+
+    void draw();
+    #ifndef MAGNUM_TARGET_GLES2
+    void drawRaw();
+    #endif
+
+    void setUniform();
+    void setUniformRaw();
+
+    void textureBind();
+    void textureBindCached();
+    void textureBindRaw();
+
+    void bufferSetSubData();
+    void bufferSetSubDataRaw();
+
+    #ifdef MAGNUM_BUILD_STATISTICS
+    void textureBindCacheMisses();
+
+    void statisticsBegin();
+    std::uint64_t textureBindCountEnd();
+    #endif
+
+    private:
+        #ifdef MAGNUM_BUILD_STATISTICS
+        UnsignedLong _textureBindCount;
+        #endif
+};
+
+using namespace Math::Literals;
+
+namespace {
+
+enum: std::size_t { BenchmarkRepeats = 1000 };
+
+struct ColorShader: AbstractShaderProgram {
+    explicit ColorShader();
+
+    ColorShader& setColor(const Color4& color) {
+        AbstractShaderProgram::setUniform(_colorUniform, color);
+        return *this;
+    }
+
+    Int colorUniform() const { return _colorUniform; }
+
+    private:
+        Int _colorUniform;
+};
+
+ColorShader::ColorShader() {
+    #ifndef MAGNUM_TARGET_GLES
+    Shader vert(
+        #ifndef CORRADE_TARGET_APPLE
+        Version::GL210
+        #else
+        Version::GL310
+        #endif
+        , Shader::Type::Vertex);
+    Shader frag(
+        #ifndef CORRADE_TARGET_APPLE
+        Version::GL210
+        #else
+        Version::GL310
+        #endif
+        , Shader::Type::Fragment);
+    #elif defined(MAGNUM_TARGET_GLES2)
+    Shader vert(Version::GLES200, Shader::Type::Vertex);
+    Shader frag(Version::GLES200, Shader::Type::Fragment);
+    #else
+    Shader vert(Version::GLES300, Shader::Type::Vertex);
+    Shader frag(Version::GLES300, Shader::Type::Fragment);
+    #endif
+
+    vert.addSource(
+        "#if !defined(GL_ES) && __VERSION__ == 120\n"
+        "#define mediump\n"
+        "#endif\n"
+        "#if defined(GL_ES) || __VERSION__ == 120\n"
+        "#define in attribute\n"
+        "#endif\n"
+        "in mediump vec2 position;\n"
+        "void main() {\n"
+        "    gl_Position = vec4(position, 0.0, 1.0);\n"
+        "}\n");
+    frag.addSource(
+        "#if !defined(GL_ES) && __VERSION__ == 120\n"
+        "#define mediump\n"
+        "#endif\n"
+        "#if defined(GL_ES) || __VERSION__ == 120\n"
+        "#define result gl_FragColor\n"
+        "#endif\n"
+        "uniform mediump vec4 color;\n"
+        "#if !defined(GL_ES) && __VERSION__ >= 130\n"
+        "out mediump vec4 result;\n"
+        "#endif\n"
+        "void main() { result = color; }\n");
+
+    CORRADE_INTERNAL_ASSERT_OUTPUT(Shader::compile({vert, frag}));
+
+    attachShaders({vert, frag});
+
+    bindAttributeLocation(0, "position");
+
+    CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+
+    _colorUniform = uniformLocation("color");
+}
+
+typedef Attribute<0, Vector2> Position;
+
+constexpr Vector2 TriangleData[]{{-1.0f, -1.0f}, {1.0f, -1.0f}, {0.0f, 1.0f}};
+
+const char* textureBindPath() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(Context::current().isExtensionSupported<Extensions::GL::ARB::direct_state_access>())
+        return Extensions::GL::ARB::direct_state_access::string();
+    if(Context::current().isExtensionSupported<Extensions::GL::ARB::multi_bind>())
+        return Extensions::GL::ARB::multi_bind::string();
+    if(Context::current().isExtensionSupported<Extensions::GL::EXT::direct_state_access>())
+        return Extensions::GL::EXT::direct_state_access::string();
+    #endif
+    return "classic";
+}
+
+const char* bufferPath() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(Context::current().isExtensionSupported<Extensions::GL::ARB::direct_state_access>())
+        return Extensions::GL::ARB::direct_state_access::string();
+    if(Context::current().isExtensionSupported<Extensions::GL::EXT::direct_state_access>())
+        return Extensions::GL::EXT::direct_state_access::string();
+    #endif
+    return "classic";
+}
+
+const char* uniformPath() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(Context::current().isExtensionSupported<Extensions::GL::ARB::separate_shader_objects>())
+        return Extensions::GL::ARB::separate_shader_objects::string();
+    if(Context::current().isExtensionSupported<Extensions::GL::EXT::direct_state_access>())
+        return Extensions::GL::EXT::direct_state_access::string();
+    #elif !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    if(Context::current().isVersionSupported(Version::GLES310))
+        return "OpenGL ES 3.1";
+    #endif
+    return "classic";
+}
+
+const char* meshPath() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(Context::current().isExtensionSupported<Extensions::GL::ARB::vertex_array_object>())
+        return Extensions::GL::ARB::vertex_array_object::string();
+    #elif defined(MAGNUM_TARGET_GLES2)
+    if(Context::current().isExtensionSupported<Extensions::GL::OES::vertex_array_object>())
+        return Extensions::GL::OES::vertex_array_object::string();
+    #else
+    return "VAO";
+    #endif
+    return "no VAO";
+}
+
+Texture2D texture() {
+    constexpr Color4ub data[]{0xff3366ff_rgba};
+    Texture2D texture;
+    texture.setImage(0, TextureFormat::RGBA, ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte, {1, 1}, data});
+    return texture;
+}
+
+}
+
+GLWrapperBenchmark::GLWrapperBenchmark() {
+    addBenchmarks({&GLWrapperBenchmark::draw,
+                   #ifndef MAGNUM_TARGET_GLES2
+                   &GLWrapperBenchmark::drawRaw,
+                   #endif
+
+                   &GLWrapperBenchmark::setUniform,
+                   &GLWrapperBenchmark::setUniformRaw,
+
+                   &GLWrapperBenchmark::textureBind,
+                   &GLWrapperBenchmark::textureBindCached,
+                   &GLWrapperBenchmark::textureBindRaw,
+
+                   &GLWrapperBenchmark::bufferSetSubData,
+                   &GLWrapperBenchmark::bufferSetSubDataRaw}, 10);
+
+    #ifdef MAGNUM_BUILD_STATISTICS
+    addCustomBenchmarks({&GLWrapperBenchmark::textureBindCacheMisses}, 10,
+        &GLWrapperBenchmark::statisticsBegin,
+        &GLWrapperBenchmark::textureBindCountEnd,
+        BenchmarkUnits::Count);
+    #endif
+}
+
+void GLWrapperBenchmark::draw() {
+    setTestCaseDescription(meshPath());
+
+    Renderbuffer renderbuffer;
+    renderbuffer.setStorage(RenderbufferFormat::RGBA4, Vector2i{1});
+    Framebuffer framebuffer{{{}, Vector2i{1}}};
+    framebuffer.attachRenderbuffer(Framebuffer::ColorAttachment{0}, renderbuffer)
+        .bind();
+
+    Buffer buffer;
+    buffer.setData(TriangleData, BufferUsage::StaticDraw);
+    Mesh mesh;
+    mesh.setCount(3)
+        .addVertexBuffer(buffer, 0, Position{});
+    ColorShader shader;
+
+    CORRADE_BENCHMARK(BenchmarkRepeats)
+        mesh.draw(shader);
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+void GLWrapperBenchmark::drawRaw() {
+    Renderbuffer renderbuffer;
+    renderbuffer.setStorage(RenderbufferFormat::RGBA4, Vector2i{1});
+    Framebuffer framebuffer{{{}, Vector2i{1}}};
+    framebuffer.attachRenderbuffer(Framebuffer::ColorAttachment{0}, renderbuffer)
+        .bind();
+
+    Buffer buffer;
+    buffer.setData(TriangleData, BufferUsage::StaticDraw);
+    ColorShader shader;
+
+    GLuint vao;
+    glGenVertexArrays(1, &vao);
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, buffer.id());
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+    glEnableVertexAttribArray(0);
+
+    /* Raw equivalent of what the wrapper does in the best case, binding the
+       program and the VAO every time */
+    CORRADE_BENCHMARK(BenchmarkRepeats) {
+        glUseProgram(shader.id());
+        glBindVertexArray(vao);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+    }
+
+    glBindVertexArray(0);
+    glDeleteVertexArrays(1, &vao);
+    Context::current().resetState(Context::State::Buffers|Context::State::Meshes|Context::State::Shaders);
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+#endif
+
+void GLWrapperBenchmark::setUniform() {
+    setTestCaseDescription(uniformPath());
+
+    ColorShader shader;
+
+    CORRADE_BENCHMARK(BenchmarkRepeats)
+        shader.setColor(0x3bd267ff_rgbaf);
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void GLWrapperBenchmark::setUniformRaw() {
+    ColorShader shader;
+    const Color4 color = 0x3bd267ff_rgbaf;
+
+    glUseProgram(shader.id());
+    CORRADE_BENCHMARK(BenchmarkRepeats)
+        glUniform4fv(shader.colorUniform(), 1, color.data());
+
+    Context::current().resetState(Context::State::Shaders);
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void GLWrapperBenchmark::textureBind() {
+    setTestCaseDescription(textureBindPath());
+
+    Texture2D a = texture();
+    Texture2D b = texture();
+
+    /* Alternating two textures so every bind reaches the driver */
+    CORRADE_BENCHMARK(BenchmarkRepeats) {
+        a.bind(0);
+        b.bind(0);
+    }
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void GLWrapperBenchmark::textureBindCached() {
+    setTestCaseDescription(textureBindPath());
+
+    Texture2D a = texture();
+    a.bind(0);
+
+    /* Every bind is a cache hit, measuring just the state tracker */
+    CORRADE_BENCHMARK(BenchmarkRepeats) {
+        a.bind(0);
+        a.bind(0);
+    }
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void GLWrapperBenchmark::textureBindRaw() {
+    Texture2D a = texture();
+    Texture2D b = texture();
+
+    CORRADE_BENCHMARK(BenchmarkRepeats) {
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, a.id());
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, b.id());
+    }
+
+    Context::current().resetState(Context::State::Textures);
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void GLWrapperBenchmark::bufferSetSubData() {
+    setTestCaseDescription(bufferPath());
+
+    constexpr Int data[16]{};
+    Buffer buffer;
+    buffer.setData(data, BufferUsage::DynamicDraw);
+
+    CORRADE_BENCHMARK(BenchmarkRepeats)
+        buffer.setSubData(0, data);
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void GLWrapperBenchmark::bufferSetSubDataRaw() {
+    constexpr Int data[16]{};
+    Buffer buffer;
+    buffer.setData(data, BufferUsage::DynamicDraw);
+
+    CORRADE_BENCHMARK(BenchmarkRepeats) {
+        glBindBuffer(GL_ARRAY_BUFFER, buffer.id());
+        glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(data), data);
+    }
+
+    Context::current().resetState(Context::State::Buffers);
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+#ifdef MAGNUM_BUILD_STATISTICS
+void GLWrapperBenchmark::statisticsBegin() {
+    _textureBindCount = Context::current().statistics().textureBindCount;
+}
+
+std::uint64_t GLWrapperBenchmark::textureBindCountEnd() {
+    return Context::current().statistics().textureBindCount - _textureBindCount;
+}
+
+void GLWrapperBenchmark::textureBindCacheMisses() {
+    /* Typical frame of eight draws, each binding one of four material
+       textures and a shared lightmap. Out of the 16 binds in each repeat only
+       the changed ones should reach the driver. */
+    Texture2D materials[]{texture(), texture(), texture(), texture()};
+    Texture2D lightmap = texture();
+
+    Context::current().resetStatistics();
+    UnsignedLong bindCount = 0;
+    CORRADE_BENCHMARK(1) for(std::size_t i = 0; i != 8; ++i) {
+        materials[i/2].bind(0);
+        lightmap.bind(1);
+        bindCount += 2;
+    }
+
+    CORRADE_COMPARE_AS(Context::current().statistics().textureBindCount, bindCount,
+        TestSuite::Compare::Less);
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+#endif
+
+}}
+
+CORRADE_TEST_MAIN(Magnum::Test::GLWrapperBenchmark)
@@ -0,0 +1,210 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/Image.h"
+#include "Magnum/MaterialTextureArray.h"
+#include "Magnum/OpenGLTester.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/TextureArray.h"
+#include "Magnum/TextureFormat.h"
+#include "Magnum/TextureUploadQueue.h"
+#include "Magnum/Math/Vector3.h"
+
+namespace Magnum { namespace Test {
+
+struct MaterialTextureArrayGLTest: OpenGLTester {
+    explicit MaterialTextureArrayGLTest();
+
+    void construct();
+
+    void add();
+    void addFull();
+    void remove();
+    void updateForeignIds();
+    void mipmaps();
+};
+
+MaterialTextureArrayGLTest::MaterialTextureArrayGLTest() {
+    addTests({&MaterialTextureArrayGLTest::construct,
+
+              &MaterialTextureArrayGLTest::add,
+              &MaterialTextureArrayGLTest::addFull,
+              &MaterialTextureArrayGLTest::remove,
+              &MaterialTextureArrayGLTest::updateForeignIds,
+              &MaterialTextureArrayGLTest::mipmaps});
+}
+
+namespace {
+    TextureUploadQueue::Decoder fill(const char value) {
+        return [value](Containers::ArrayView<char> data) {
+            std::fill(data.begin(), data.end(), value);
+        };
+    }
+}
+
+#define SKIP_IF_UNSUPPORTED()                                               \
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::buffer_storage>()) \
+        CORRADE_SKIP(Extensions::GL::ARB::buffer_storage::string() + std::string(" is not supported."));
+
+void MaterialTextureArrayGLTest::construct() {
+    SKIP_IF_UNSUPPORTED()
+
+    TextureUploadQueue queue{64};
+    MaterialTextureArray array{queue, TextureFormat::RGBA8, {4, 2}, 3, 2};
+    MAGNUM_VERIFY_NO_ERROR();
+
+    CORRADE_COMPARE(array.size(), (Vector2i{4, 2}));
+    CORRADE_COMPARE(array.layerCount(), 3);
+    CORRADE_COMPARE(array.levelCount(), 2);
+    CORRADE_COMPARE(array.allocatedLayerCount(), 0);
+    CORRADE_COMPARE(array.pendingLayerCount(), 0);
+    CORRADE_VERIFY(!array.isAllocated(0));
+    CORRADE_VERIFY(!array.isReady(0));
+    CORRADE_COMPARE(array.texture().imageSize(0), (Vector3i{4, 2, 3}));
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void MaterialTextureArrayGLTest::add() {
+    SKIP_IF_UNSUPPORTED()
+
+    TextureUploadQueue queue{64};
+    MaterialTextureArray array{queue, TextureFormat::RGBA8, {2, 2}, 3};
+
+    /* Layers are handed out from the lowest */
+    CORRADE_COMPARE(array.add(PixelFormat::RGBA, PixelType::UnsignedByte, fill(0x22)), 0);
+    CORRADE_COMPARE(array.add(PixelFormat::RGBA, PixelType::UnsignedByte, fill(0x44)), 1);
+    CORRADE_COMPARE(array.allocatedLayerCount(), 2);
+    CORRADE_COMPARE(array.pendingLayerCount(), 2);
+    CORRADE_VERIFY(array.isAllocated(1));
+    CORRADE_VERIFY(!array.isReady(1));
+
+    array.update(queue.finish());
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(array.allocatedLayerCount(), 2);
+    CORRADE_COMPARE(array.pendingLayerCount(), 0);
+    CORRADE_VERIFY(array.isReady(0));
+    CORRADE_VERIFY(array.isReady(1));
+    CORRADE_VERIFY(!array.isReady(2));
+
+    Image3D image = array.texture().image(0, {PixelFormat::RGBA, PixelType::UnsignedByte});
+    MAGNUM_VERIFY_NO_ERROR();
+
+    const auto pixels = Containers::arrayCast<UnsignedByte>(image.data());
+    CORRADE_COMPARE(pixels.size(), 48);
+    CORRADE_COMPARE(pixels[0], 0x22);
+    CORRADE_COMPARE(pixels[15], 0x22);
+    CORRADE_COMPARE(pixels[16], 0x44);
+    CORRADE_COMPARE(pixels[31], 0x44);
+}
+
+void MaterialTextureArrayGLTest::addFull() {
+    SKIP_IF_UNSUPPORTED()
+
+    TextureUploadQueue queue{64};
+    MaterialTextureArray array{queue, TextureFormat::RGBA8, {2, 2}, 2};
+
+    CORRADE_COMPARE(array.add(PixelFormat::RGBA, PixelType::UnsignedByte, fill(0x22)), 0);
+    CORRADE_COMPARE(array.add(PixelFormat::RGBA, PixelType::UnsignedByte, fill(0x44)), 1);
+    CORRADE_COMPARE(array.add(PixelFormat::RGBA, PixelType::UnsignedByte, fill(0x66)), -1);
+    CORRADE_COMPARE(array.pendingLayerCount(), 2);
+    CORRADE_COMPARE(queue.pendingCount(), 2);
+
+    array.update(queue.finish());
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void MaterialTextureArrayGLTest::remove() {
+    SKIP_IF_UNSUPPORTED()
+
+    TextureUploadQueue queue{64};
+    MaterialTextureArray array{queue, TextureFormat::RGBA8, {2, 2}, 3};
+
+    for(Int i = 0; i != 3; ++i)
+        CORRADE_COMPARE(array.add(PixelFormat::RGBA, PixelType::UnsignedByte, fill(0x22)), i);
+    array.update(queue.finish());
+
+    /* The lowest removed layer is reused first */
+    array.remove(2);
+    array.remove(0);
+    CORRADE_COMPARE(array.allocatedLayerCount(), 1);
+    CORRADE_VERIFY(!array.isAllocated(0));
+    CORRADE_VERIFY(!array.isReady(0));
+    CORRADE_VERIFY(array.isReady(1));
+
+    CORRADE_COMPARE(array.add(PixelFormat::RGBA, PixelType::UnsignedByte, fill(0x44)), 0);
+    CORRADE_COMPARE(array.add(PixelFormat::RGBA, PixelType::UnsignedByte, fill(0x44)), 2);
+    array.update(queue.finish());
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(array.allocatedLayerCount(), 3);
+}
+
+void MaterialTextureArrayGLTest::updateForeignIds() {
+    SKIP_IF_UNSUPPORTED()
+
+    Texture2DArray other;
+    other.setStorage(1, TextureFormat::RGBA8, {2, 2, 1});
+
+    /* Uploads of other users of the queue are ignored */
+    TextureUploadQueue queue{64};
+    MaterialTextureArray array{queue, TextureFormat::RGBA8, {2, 2}, 3};
+    queue.enqueue(other, 0, {}, PixelFormat::RGBA, PixelType::UnsignedByte, {2, 2}, fill(0x11));
+    array.add(PixelFormat::RGBA, PixelType::UnsignedByte, fill(0x22));
+
+    const std::vector<UnsignedInt> completed = queue.finish();
+    CORRADE_COMPARE(completed.size(), 2);
+    array.update(completed);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(array.pendingLayerCount(), 0);
+    CORRADE_VERIFY(array.isReady(0));
+}
+
+void MaterialTextureArrayGLTest::mipmaps() {
+    SKIP_IF_UNSUPPORTED()
+
+    TextureUploadQueue queue{64};
+    MaterialTextureArray array{queue, TextureFormat::RGBA8, {2, 2}, 2, 2};
+    array.add(PixelFormat::RGBA, PixelType::UnsignedByte, fill(0x40));
+    array.add(PixelFormat::RGBA, PixelType::UnsignedByte, fill(0x7f));
+    array.update(queue.finish());
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /* The second level got generated from the first */
+    Image3D image = array.texture().image(1, {PixelFormat::RGBA, PixelType::UnsignedByte});
+    MAGNUM_VERIFY_NO_ERROR();
+
+    const auto pixels = Containers::arrayCast<UnsignedByte>(image.data());
+    CORRADE_COMPARE(pixels.size(), 8);
+    CORRADE_COMPARE(pixels[0], 0x40);
+    CORRADE_COMPARE(pixels[4], 0x7f);
+}
+
+}}
+
+CORRADE_TEST_MAIN(Magnum::Test::MaterialTextureArrayGLTest)
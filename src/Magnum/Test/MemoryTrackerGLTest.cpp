@@ -0,0 +1,198 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/Buffer.h"
+#include "Magnum/Context.h"
+#include "Magnum/CubeMapTexture.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/MemoryTracker.h"
+#include "Magnum/OpenGLTester.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Renderbuffer.h"
+#include "Magnum/RenderbufferFormat.h"
+#include "Magnum/Texture.h"
+#include "Magnum/TextureFormat.h"
+
+namespace Magnum { namespace Test {
+
+struct MemoryTrackerGLTest: OpenGLTester {
+    explicit MemoryTrackerGLTest();
+
+    void buffer();
+    void texture();
+    void cubeMapTexture();
+    void renderbuffer();
+    #ifndef MAGNUM_TARGET_WEBGL
+    void label();
+    #endif
+
+    void driverMemory();
+};
+
+MemoryTrackerGLTest::MemoryTrackerGLTest() {
+    addTests({&MemoryTrackerGLTest::buffer,
+              &MemoryTrackerGLTest::texture,
+              &MemoryTrackerGLTest::cubeMapTexture,
+              &MemoryTrackerGLTest::renderbuffer,
+              #ifndef MAGNUM_TARGET_WEBGL
+              &MemoryTrackerGLTest::label,
+              #endif
+
+              &MemoryTrackerGLTest::driverMemory});
+}
+
+void MemoryTrackerGLTest::buffer() {
+    MemoryTracker& tracker = Context::current().memoryTracker();
+    const std::size_t before = tracker.allocatedSize(MemoryObjectType::Buffer);
+
+    {
+        Buffer buffer;
+        buffer.setData({nullptr, 1024}, BufferUsage::StaticDraw);
+        MAGNUM_VERIFY_NO_ERROR();
+        CORRADE_COMPARE(tracker.allocatedSize(MemoryObjectType::Buffer), before + 1024);
+
+        /* Reallocation replaces the previous size */
+        buffer.setData({nullptr, 256}, BufferUsage::StaticDraw);
+        CORRADE_COMPARE(tracker.allocatedSize(MemoryObjectType::Buffer), before + 256);
+
+        /* Subdata don't change the size */
+        const char data[16]{};
+        buffer.setSubData(0, data);
+        CORRADE_COMPARE(tracker.allocatedSize(MemoryObjectType::Buffer), before + 256);
+    }
+
+    CORRADE_COMPARE(tracker.allocatedSize(MemoryObjectType::Buffer), before);
+}
+
+void MemoryTrackerGLTest::texture() {
+    MemoryTracker& tracker = Context::current().memoryTracker();
+    const std::size_t before = tracker.allocatedSize(MemoryObjectType::Texture);
+
+    {
+        Texture2D texture;
+        texture.setStorage(3, TextureFormat::RGBA4, {16, 16});
+        MAGNUM_VERIFY_NO_ERROR();
+
+        /* 16x16 + 8x8 + 4x4 pixels, 2 bytes each */
+        CORRADE_COMPARE(tracker.allocatedSize(MemoryObjectType::Texture), before + (256 + 64 + 16)*2);
+    } {
+        Texture2D texture;
+        texture.setImage(0, TextureFormat::RGBA, ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte, {8, 4}});
+        texture.setImage(1, TextureFormat::RGBA, ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte, {4, 2}});
+        MAGNUM_VERIFY_NO_ERROR();
+        CORRADE_COMPARE(tracker.allocatedSize(MemoryObjectType::Texture), before + (32 + 8)*4);
+
+        /* Replacing a level */
+        texture.setImage(0, TextureFormat::RGBA, ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte, {16, 8}});
+        CORRADE_COMPARE(tracker.allocatedSize(MemoryObjectType::Texture), before + (128 + 8)*4);
+    }
+
+    CORRADE_COMPARE(tracker.allocatedSize(MemoryObjectType::Texture), before);
+}
+
+void MemoryTrackerGLTest::cubeMapTexture() {
+    MemoryTracker& tracker = Context::current().memoryTracker();
+    const std::size_t before = tracker.allocatedSize(MemoryObjectType::Texture);
+
+    {
+        CubeMapTexture texture;
+        texture.setStorage(2, TextureFormat::RGBA4, {8, 8});
+        MAGNUM_VERIFY_NO_ERROR();
+
+        /* Six faces of 8x8 + 4x4 pixels */
+        CORRADE_COMPARE(tracker.allocatedSize(MemoryObjectType::Texture), before + (64 + 16)*2*6);
+    } {
+        CubeMapTexture texture;
+        texture.setImage(CubeMapCoordinate::PositiveX, 0, TextureFormat::RGBA, ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte, {8, 8}});
+        texture.setImage(CubeMapCoordinate::NegativeZ, 0, TextureFormat::RGBA, ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte, {8, 8}});
+        MAGNUM_VERIFY_NO_ERROR();
+
+        /* Faces are tracked separately */
+        CORRADE_COMPARE(tracker.allocatedSize(MemoryObjectType::Texture), before + 64*4*2);
+    }
+
+    CORRADE_COMPARE(tracker.allocatedSize(MemoryObjectType::Texture), before);
+}
+
+void MemoryTrackerGLTest::renderbuffer() {
+    MemoryTracker& tracker = Context::current().memoryTracker();
+    const std::size_t before = tracker.allocatedSize(MemoryObjectType::Renderbuffer);
+
+    {
+        Renderbuffer renderbuffer;
+        renderbuffer.setStorage(RenderbufferFormat::RGBA4, {32, 16});
+        MAGNUM_VERIFY_NO_ERROR();
+        CORRADE_COMPARE(tracker.allocatedSize(MemoryObjectType::Renderbuffer), before + 32*16*2);
+    }
+
+    CORRADE_COMPARE(tracker.allocatedSize(MemoryObjectType::Renderbuffer), before);
+}
+
+#ifndef MAGNUM_TARGET_WEBGL
+void MemoryTrackerGLTest::label() {
+    /* No-Op version is tested in AbstractObjectGLTest */
+    if(!Context::current().isExtensionSupported<Extensions::GL::KHR::debug>() &&
+       !Context::current().isExtensionSupported<Extensions::GL::EXT::debug_label>())
+        CORRADE_SKIP("Required extension is not available");
+
+    MemoryTracker& tracker = Context::current().memoryTracker();
+
+    Buffer buffer;
+    buffer.setLabel("vertices")
+        .setData({nullptr, 512}, BufferUsage::StaticDraw);
+    Renderbuffer renderbuffer;
+    renderbuffer.setLabel("vertices");
+    renderbuffer.setStorage(RenderbufferFormat::RGBA4, {4, 4});
+    MAGNUM_VERIFY_NO_ERROR();
+
+    CORRADE_COMPARE(tracker.allocatedSize("vertices"), 512 + 32);
+}
+#endif
+
+void MemoryTrackerGLTest::driverMemory() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::NVX::gpu_memory_info>() &&
+       !Context::current().isExtensionSupported<Extensions::GL::ATI::meminfo>())
+    #endif
+    {
+        CORRADE_COMPARE(Context::current().memoryTracker().driverAvailableMemory(), 0);
+        CORRADE_COMPARE(Context::current().memoryTracker().driverTotalMemory(), 0);
+        CORRADE_SKIP("No driver memory query extension is available");
+    }
+
+    #ifndef MAGNUM_TARGET_GLES
+    const std::size_t available = Context::current().memoryTracker().driverAvailableMemory();
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(available > 0);
+
+    if(Context::current().isExtensionSupported<Extensions::GL::NVX::gpu_memory_info>())
+        CORRADE_VERIFY(Context::current().memoryTracker().driverTotalMemory() >= available);
+    #endif
+}
+
+}}
+
+CORRADE_TEST_MAIN(Magnum::Test::MemoryTrackerGLTest)
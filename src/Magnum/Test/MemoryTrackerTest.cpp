@@ -0,0 +1,215 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/MemoryTracker.h"
+#include "Magnum/TextureFormat.h"
+
+namespace Magnum { namespace Test {
+
+struct MemoryTrackerTest: TestSuite::Tester {
+    explicit MemoryTrackerTest();
+
+    void allocation();
+    void reallocation();
+    void slots();
+    void label();
+    void remove();
+    void peak();
+    void allocations();
+
+    void pixelSize();
+
+    void debugObjectType();
+};
+
+MemoryTrackerTest::MemoryTrackerTest() {
+    addTests({&MemoryTrackerTest::allocation,
+              &MemoryTrackerTest::reallocation,
+              &MemoryTrackerTest::slots,
+              &MemoryTrackerTest::label,
+              &MemoryTrackerTest::remove,
+              &MemoryTrackerTest::peak,
+              &MemoryTrackerTest::allocations,
+
+              &MemoryTrackerTest::pixelSize,
+
+              &MemoryTrackerTest::debugObjectType});
+}
+
+void MemoryTrackerTest::allocation() {
+    MemoryTracker tracker;
+    CORRADE_COMPARE(tracker.allocationCount(), 0);
+    CORRADE_COMPARE(tracker.allocatedSize(), 0);
+
+    tracker.setAllocation(MemoryObjectType::Buffer, 3, 1024);
+    tracker.setAllocation(MemoryObjectType::Texture, 3, 4096);
+    tracker.setAllocation(MemoryObjectType::Renderbuffer, 1, 256);
+
+    /* Same ID but different types are different objects */
+    CORRADE_COMPARE(tracker.allocationCount(), 3);
+    CORRADE_COMPARE(tracker.allocatedSize(), 5376);
+    CORRADE_COMPARE(tracker.allocatedSize(MemoryObjectType::Buffer), 1024);
+    CORRADE_COMPARE(tracker.allocatedSize(MemoryObjectType::Texture), 4096);
+    CORRADE_COMPARE(tracker.allocatedSize(MemoryObjectType::Renderbuffer), 256);
+}
+
+void MemoryTrackerTest::reallocation() {
+    MemoryTracker tracker;
+    tracker.setAllocation(MemoryObjectType::Buffer, 3, 1024);
+    tracker.setAllocation(MemoryObjectType::Buffer, 3, 512);
+
+    CORRADE_COMPARE(tracker.allocationCount(), 1);
+    CORRADE_COMPARE(tracker.allocatedSize(), 512);
+
+    /* Shrinking doesn't affect the peak, the previous allocation is released
+       before the new is made */
+    CORRADE_COMPARE(tracker.peakAllocatedSize(), 1024);
+    tracker.setAllocation(MemoryObjectType::Buffer, 3, 1536);
+    CORRADE_COMPARE(tracker.peakAllocatedSize(), 1536);
+}
+
+void MemoryTrackerTest::slots() {
+    MemoryTracker tracker;
+
+    /* Mip levels set one by one */
+    tracker.setSlotAllocation(MemoryObjectType::Texture, 1, 0, 64);
+    tracker.setSlotAllocation(MemoryObjectType::Texture, 1, 2, 4);
+    tracker.setSlotAllocation(MemoryObjectType::Texture, 1, 1, 16);
+    CORRADE_COMPARE(tracker.allocatedSize(), 84);
+
+    /* Replacing a level */
+    tracker.setSlotAllocation(MemoryObjectType::Texture, 1, 0, 32);
+    CORRADE_COMPARE(tracker.allocatedSize(), 52);
+
+    /* Replacing everything */
+    tracker.setAllocation(MemoryObjectType::Texture, 1, std::vector<std::size_t>{256, 64});
+    CORRADE_COMPARE(tracker.allocationCount(), 1);
+    CORRADE_COMPARE(tracker.allocatedSize(), 320);
+    CORRADE_COMPARE(tracker.allocatedSize(MemoryObjectType::Texture), 320);
+}
+
+void MemoryTrackerTest::label() {
+    MemoryTracker tracker;
+
+    /* Label set before the allocation is remembered */
+    tracker.setLabel(MemoryObjectType::Texture, 1, "shadow map");
+    CORRADE_COMPARE(tracker.allocationCount(), 0);
+    tracker.setAllocation(MemoryObjectType::Texture, 1, 4096);
+    tracker.setAllocation(MemoryObjectType::Buffer, 2, 1024);
+    tracker.setLabel(MemoryObjectType::Buffer, 2, "shadow map");
+    tracker.setAllocation(MemoryObjectType::Buffer, 3, 256);
+
+    CORRADE_COMPARE(tracker.allocatedSize("shadow map"), 5120);
+    CORRADE_COMPARE(tracker.allocatedSize(""), 256);
+    CORRADE_COMPARE(tracker.allocatedSize("terrain"), 0);
+}
+
+void MemoryTrackerTest::remove() {
+    MemoryTracker tracker;
+    tracker.setAllocation(MemoryObjectType::Buffer, 2, 1024);
+    tracker.setAllocation(MemoryObjectType::Buffer, 3, 256);
+    tracker.remove(MemoryObjectType::Buffer, 2);
+
+    CORRADE_COMPARE(tracker.allocationCount(), 1);
+    CORRADE_COMPARE(tracker.allocatedSize(), 256);
+    CORRADE_COMPARE(tracker.allocatedSize(MemoryObjectType::Buffer), 256);
+
+    /* Removing untracked objects is a no-op */
+    tracker.remove(MemoryObjectType::Texture, 17);
+    CORRADE_COMPARE(tracker.allocatedSize(), 256);
+}
+
+void MemoryTrackerTest::peak() {
+    MemoryTracker tracker;
+    tracker.setAllocation(MemoryObjectType::Buffer, 2, 1024);
+    tracker.setAllocation(MemoryObjectType::Texture, 3, 4096);
+    tracker.remove(MemoryObjectType::Texture, 3);
+    tracker.setAllocation(MemoryObjectType::Renderbuffer, 4, 512);
+
+    CORRADE_COMPARE(tracker.allocatedSize(), 1536);
+    CORRADE_COMPARE(tracker.peakAllocatedSize(), 5120);
+    CORRADE_COMPARE(tracker.peakAllocatedSize(MemoryObjectType::Buffer), 1024);
+    CORRADE_COMPARE(tracker.peakAllocatedSize(MemoryObjectType::Texture), 4096);
+    CORRADE_COMPARE(tracker.peakAllocatedSize(MemoryObjectType::Renderbuffer), 512);
+
+    tracker.resetPeakAllocatedSize();
+    CORRADE_COMPARE(tracker.peakAllocatedSize(), 1536);
+    CORRADE_COMPARE(tracker.peakAllocatedSize(MemoryObjectType::Texture), 0);
+}
+
+void MemoryTrackerTest::allocations() {
+    MemoryTracker tracker;
+    tracker.setAllocation(MemoryObjectType::Buffer, 2, 1024);
+    tracker.setAllocation(MemoryObjectType::Texture, 3, 4096);
+    tracker.setLabel(MemoryObjectType::Texture, 3, "atlas");
+    tracker.setAllocation(MemoryObjectType::Renderbuffer, 1, 1024);
+
+    /* Zero-sized allocations are not listed */
+    tracker.setAllocation(MemoryObjectType::Buffer, 5, 0);
+
+    const std::vector<MemoryTracker::Allocation> allocations = tracker.allocations();
+    CORRADE_COMPARE(allocations.size(), 3);
+    CORRADE_COMPARE(allocations[0].type, MemoryObjectType::Texture);
+    CORRADE_COMPARE(allocations[0].id, 3);
+    CORRADE_COMPARE(allocations[0].size, 4096);
+    CORRADE_COMPARE(allocations[0].label, "atlas");
+    /* Same size, sorted by type */
+    CORRADE_COMPARE(allocations[1].type, MemoryObjectType::Buffer);
+    CORRADE_COMPARE(allocations[1].id, 2);
+    CORRADE_COMPARE(allocations[2].type, MemoryObjectType::Renderbuffer);
+    CORRADE_COMPARE(allocations[2].label, "");
+}
+
+void MemoryTrackerTest::pixelSize() {
+    CORRADE_COMPARE(MemoryTracker::pixelSize(TextureFormat::RGBA), 4.0f);
+    CORRADE_COMPARE(MemoryTracker::pixelSize(TextureFormat::RGB565), 2.0f);
+    CORRADE_COMPARE(MemoryTracker::pixelSize(TextureFormat::CompressedRGBAS3tcDxt1), 0.5f);
+    CORRADE_COMPARE(MemoryTracker::pixelSize(TextureFormat::CompressedRGBAS3tcDxt5), 1.0f);
+    #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+    CORRADE_COMPARE(MemoryTracker::pixelSize(TextureFormat::R8), 1.0f);
+    CORRADE_COMPARE(MemoryTracker::pixelSize(TextureFormat::RGBA8), 4.0f);
+    #endif
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_COMPARE(MemoryTracker::pixelSize(TextureFormat::RGBA32F), 16.0f);
+    CORRADE_COMPARE(MemoryTracker::pixelSize(TextureFormat::RGB16F), 6.0f);
+    #endif
+    #ifndef MAGNUM_TARGET_WEBGL
+    CORRADE_COMPARE(MemoryTracker::pixelSize(TextureFormat::CompressedRGBAAstc8x8), 0.25f);
+    #endif
+}
+
+void MemoryTrackerTest::debugObjectType() {
+    std::ostringstream out;
+
+    Debug{&out} << MemoryObjectType::Renderbuffer << MemoryObjectType(0xde);
+    CORRADE_COMPARE(out.str(), "MemoryObjectType::Renderbuffer MemoryObjectType(0xde)\n");
+}
+
+}}
+
+CORRADE_TEST_MAIN(Magnum::Test::MemoryTrackerTest)
@@ -119,6 +119,11 @@ struct MeshGLTest: OpenGLTester {
     void unbindVAOWhenSettingIndexBufferData();
     void unbindVAOBeforeEnteringExternalSection();
 
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    void shareVertexFormat();
+    void shareVertexFormatIndexed();
+    #endif
+
     #ifndef MAGNUM_TARGET_GLES
     void setBaseVertex();
     #endif
@@ -144,6 +149,16 @@ struct MeshGLTest: OpenGLTester {
     #ifndef MAGNUM_TARGET_GLES
     void multiDrawBaseVertex();
     #endif
+    void multiDrawArrayView();
+
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    void drawIndirect();
+    void drawIndirectIndexed();
+    #endif
+    #ifndef MAGNUM_TARGET_GLES
+    void multiDrawIndirect();
+    void multiDrawIndirectCount();
+    #endif
 };
 
 MeshGLTest::MeshGLTest() {
@@ -221,6 +236,11 @@ MeshGLTest::MeshGLTest() {
               &MeshGLTest::unbindVAOWhenSettingIndexBufferData,
               &MeshGLTest::unbindVAOBeforeEnteringExternalSection,
 
+              #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+              &MeshGLTest::shareVertexFormat,
+              &MeshGLTest::shareVertexFormatIndexed,
+              #endif
+
               #ifndef MAGNUM_TARGET_GLES
               &MeshGLTest::setBaseVertex,
               #endif
@@ -248,7 +268,17 @@ MeshGLTest::MeshGLTest() {
               &MeshGLTest::multiDraw,
               &MeshGLTest::multiDrawIndexed,
               #ifndef MAGNUM_TARGET_GLES
-              &MeshGLTest::multiDrawBaseVertex
+              &MeshGLTest::multiDrawBaseVertex,
+              #endif
+              &MeshGLTest::multiDrawArrayView,
+
+              #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+              &MeshGLTest::drawIndirect,
+              &MeshGLTest::drawIndirectIndexed,
+              #endif
+              #ifndef MAGNUM_TARGET_GLES
+              &MeshGLTest::multiDrawIndirect,
+              &MeshGLTest::multiDrawIndirectCount
               #endif
               });
 }
@@ -1811,6 +1841,124 @@ void MeshGLTest::unbindVAOBeforeEnteringExternalSection() {
     CORRADE_COMPARE(value, 92);
 }
 
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+void MeshGLTest::shareVertexFormat() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::vertex_attrib_binding>())
+        CORRADE_SKIP(Extensions::GL::ARB::vertex_attrib_binding::string() + std::string(" is not available."));
+    #else
+    if(!Context::current().isVersionSupported(Version::GLES310))
+        CORRADE_SKIP("OpenGL ES 3.1 is not supported.");
+    #endif
+
+    const Float data[] = {
+        0.0f, 0.0f, /* Offset */
+
+        /* First vertex */
+        0.0f, 0.0f, 0.0f,
+            0.0f, 0.0f, 0.0f,
+                0.0f, 0.0f,
+
+        /* Second vertex */
+        Math::unpack<Float, UnsignedByte>(64),
+            Math::unpack<Float, UnsignedByte>(17),
+                Math::unpack<Float, UnsignedByte>(56),
+        Math::unpack<Float, UnsignedByte>(15),
+            Math::unpack<Float, UnsignedByte>(164),
+                Math::unpack<Float, UnsignedByte>(17),
+        Math::unpack<Float, UnsignedByte>(97),
+            Math::unpack<Float, UnsignedByte>(28)
+    };
+    Buffer buffer;
+    buffer.setData(data, BufferUsage::StaticDraw);
+
+    const Int count = Mesh::sharedVertexFormatCount();
+
+    Mesh a;
+    a.shareVertexFormat()
+        .addVertexBuffer(buffer, 2*4, MultipleShader::Position(),
+            MultipleShader::Normal(), MultipleShader::TextureCoordinates());
+
+    /* Same format, only different offset */
+    Mesh b;
+    b.shareVertexFormat()
+        .addVertexBuffer(buffer, 10*4, MultipleShader::Position(),
+            MultipleShader::Normal(), MultipleShader::TextureCoordinates());
+
+    CORRADE_VERIFY(a.isVertexFormatShared());
+    CORRADE_COMPARE(a.id(), 0);
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    const auto valueA = Checker(MultipleShader(), RenderbufferFormat::RGBA8, a)
+        .get<Color4ub>(PixelFormat::RGBA, PixelType::UnsignedByte);
+    const auto valueB = Checker(MultipleShader(), RenderbufferFormat::RGBA8, b)
+        .get<Color4ub>(PixelFormat::RGBA, PixelType::UnsignedByte);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(Mesh::sharedVertexFormatCount(), count + 1);
+    CORRADE_COMPARE(valueA, Color4ub(0, 0, 0, 255));
+    CORRADE_COMPARE(valueB, Color4ub(64 + 15 + 97, 17 + 164 + 28, 56 + 17, 255));
+
+    /* Different format gets a new VAO */
+    Mesh c;
+    c.shareVertexFormat()
+        .addVertexBuffer(buffer, 2*4, MultipleShader::Position(), 3*4,
+            MultipleShader::TextureCoordinates());
+    Checker(MultipleShader(), RenderbufferFormat::RGBA8, c);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(Mesh::sharedVertexFormatCount(), count + 2);
+}
+
+void MeshGLTest::shareVertexFormatIndexed() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::vertex_attrib_binding>())
+        CORRADE_SKIP(Extensions::GL::ARB::vertex_attrib_binding::string() + std::string(" is not available."));
+    #else
+    if(!Context::current().isVersionSupported(Version::GLES310))
+        CORRADE_SKIP("OpenGL ES 3.1 is not supported.");
+    #endif
+
+    Buffer vertices;
+    vertices.setData(indexedVertexData, BufferUsage::StaticDraw);
+
+    constexpr UnsignedShort indexData[] = { 2, 1, 0 };
+    Buffer indices{Buffer::TargetHint::ElementArray};
+    indices.setData(indexData, BufferUsage::StaticDraw);
+
+    constexpr UnsignedShort otherIndexData[] = { 0, 0, 1 };
+    Buffer otherIndices{Buffer::TargetHint::ElementArray};
+    otherIndices.setData(otherIndexData, BufferUsage::StaticDraw);
+
+    Mesh a;
+    a.shareVertexFormat()
+        .addVertexBuffer(vertices, 1*4, MultipleShader::Position(),
+            MultipleShader::Normal(), MultipleShader::TextureCoordinates())
+        .setIndexBuffer(indices, 2, Mesh::IndexType::UnsignedShort);
+
+    /* Index buffer is bound per-mesh even though the VAO is shared */
+    Mesh b;
+    b.shareVertexFormat()
+        .addVertexBuffer(vertices, 1*4, MultipleShader::Position(),
+            MultipleShader::Normal(), MultipleShader::TextureCoordinates())
+        .setIndexBuffer(otherIndices, 2, Mesh::IndexType::UnsignedShort);
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    const auto valueA = Checker(MultipleShader(), RenderbufferFormat::RGBA8, a)
+        .get<Color4ub>(PixelFormat::RGBA, PixelType::UnsignedByte);
+    const auto valueB = Checker(MultipleShader(), RenderbufferFormat::RGBA8, b)
+        .get<Color4ub>(PixelFormat::RGBA, PixelType::UnsignedByte);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(valueA, indexedResult);
+
+    /* The other mesh fetches the second vertex, whose sum is clamped */
+    CORRADE_COMPARE(valueB, Color4ub(255, 0, 0, 255));
+}
+#endif
+
 #ifndef MAGNUM_TARGET_GLES
 void MeshGLTest::setBaseVertex() {
     if(!Context::current().isExtensionSupported<Extensions::GL::ARB::draw_elements_base_vertex>())
@@ -2326,6 +2474,212 @@ void MeshGLTest::multiDrawBaseVertex() {
 }
 #endif
 
+namespace {
+    struct DrawChecker {
+        DrawChecker();
+
+        template<class T> T get(PixelFormat format, PixelType type);
+
+        Renderbuffer renderbuffer;
+        Framebuffer framebuffer;
+    };
+}
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+DrawChecker::DrawChecker(): framebuffer({{}, Vector2i(1)}) {
+    renderbuffer.setStorage(
+        #ifndef MAGNUM_TARGET_GLES2
+        RenderbufferFormat::RGBA8,
+        #else
+        RenderbufferFormat::RGBA4,
+        #endif
+        Vector2i(1));
+    framebuffer.attachRenderbuffer(Framebuffer::ColorAttachment(0), renderbuffer);
+    framebuffer.bind();
+}
+
+template<class T> T DrawChecker::get(PixelFormat format, PixelType type) {
+    return framebuffer.read({{}, Vector2i{1}}, {format, type}).data<T>()[0];
+}
+#endif
+
+void MeshGLTest::multiDrawArrayView() {
+    typedef Attribute<0, Float> Attribute;
+
+    const Float data[] = { 0.0f, -0.7f, Math::unpack<Float, UnsignedByte>(96) };
+    Buffer buffer;
+    buffer.setData(data, BufferUsage::StaticDraw);
+
+    Mesh mesh;
+    mesh.setPrimitive(MeshPrimitive::Points)
+        .addVertexBuffer(buffer, 4, Attribute());
+
+    /* Assemble the list at runtime, the last drawn view wins */
+    std::vector<MeshView> views;
+    for(Int i = 0; i != 3; ++i) {
+        views.emplace_back(mesh);
+        views.back().setCount(i == 0 ? 0 : 1)
+            .setBaseVertex(i == 1 ? 0 : 1);
+    }
+    const std::vector<std::reference_wrapper<MeshView>> list{views.begin(), views.end()};
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    DrawChecker checker;
+    MeshView::draw(FloatShader("float", "vec4(valueInterpolated, 0.0, 0.0, 0.0)"),
+        Containers::ArrayView<const std::reference_wrapper<MeshView>>{list.data(), list.size()});
+    const auto value = checker.get<UnsignedByte>(PixelFormat::RGBA, PixelType::UnsignedByte);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(value, 96);
+}
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+void MeshGLTest::drawIndirect() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::draw_indirect>())
+        CORRADE_SKIP(Extensions::GL::ARB::draw_indirect::string() + std::string(" is not available."));
+    #else
+    if(!Context::current().isVersionSupported(Version::GLES310))
+        CORRADE_SKIP("OpenGL ES 3.1 is not supported.");
+    #endif
+
+    typedef Attribute<0, Float> Attribute;
+
+    const Float data[] = { 0.0f, -0.7f, Math::unpack<Float, UnsignedByte>(96) };
+    Buffer buffer;
+    buffer.setData(data, BufferUsage::StaticDraw);
+
+    /* Count, instance count, first vertex, base instance */
+    const UnsignedInt command[] = { 1, 1, 1, 0 };
+    Buffer indirect{Buffer::TargetHint::DrawIndirect};
+    indirect.setData(command, BufferUsage::StaticDraw);
+
+    Mesh mesh;
+    mesh.setPrimitive(MeshPrimitive::Points)
+        .addVertexBuffer(buffer, 4, Attribute());
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    DrawChecker checker;
+    mesh.drawIndirect(FloatShader("float", "vec4(valueInterpolated, 0.0, 0.0, 0.0)"), indirect);
+    const auto value = checker.get<UnsignedByte>(PixelFormat::RGBA, PixelType::UnsignedByte);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(value, 96);
+}
+
+void MeshGLTest::drawIndirectIndexed() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::draw_indirect>())
+        CORRADE_SKIP(Extensions::GL::ARB::draw_indirect::string() + std::string(" is not available."));
+    #else
+    if(!Context::current().isVersionSupported(Version::GLES310))
+        CORRADE_SKIP("OpenGL ES 3.1 is not supported.");
+    #endif
+
+    Buffer vertices;
+    vertices.setData(indexedVertexData, BufferUsage::StaticDraw);
+
+    constexpr UnsignedShort indexData[] = { 2, 1, 0 };
+    Buffer indices{Buffer::TargetHint::ElementArray};
+    indices.setData(indexData, BufferUsage::StaticDraw);
+
+    /* Count, instance count, first index, base vertex, base instance. The
+       first index is relative to the start of the index buffer, the offset
+       passed to setIndexBuffer() is ignored. */
+    const UnsignedInt command[] = { 1, 1, 2, 0, 0 };
+    Buffer indirect{Buffer::TargetHint::DrawIndirect};
+    indirect.setData(command, BufferUsage::StaticDraw);
+
+    Mesh mesh;
+    mesh.setPrimitive(MeshPrimitive::Points)
+        .addVertexBuffer(vertices, 1*4,  MultipleShader::Position(),
+                         MultipleShader::Normal(), MultipleShader::TextureCoordinates())
+        .setIndexBuffer(indices, 2, Mesh::IndexType::UnsignedShort);
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    DrawChecker checker;
+    mesh.drawIndirect(MultipleShader{}, indirect);
+    const auto value = checker.get<Color4ub>(PixelFormat::RGBA, PixelType::UnsignedByte);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(value, indexedResult);
+}
+#endif
+
+#ifndef MAGNUM_TARGET_GLES
+void MeshGLTest::multiDrawIndirect() {
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::multi_draw_indirect>())
+        CORRADE_SKIP(Extensions::GL::ARB::multi_draw_indirect::string() + std::string(" is not available."));
+
+    typedef Attribute<0, Float> Attribute;
+
+    const Float data[] = { 0.0f, -0.7f, Math::unpack<Float, UnsignedByte>(96) };
+    Buffer buffer;
+    buffer.setData(data, BufferUsage::StaticDraw);
+
+    /* Padded to five values to test the stride, the last drawn command wins */
+    const UnsignedInt commands[] = {
+        1, 1, 0, 0, 0xdeadbeef,
+        1, 1, 1, 0, 0xdeadbeef
+    };
+    Buffer indirect{Buffer::TargetHint::DrawIndirect};
+    indirect.setData(commands, BufferUsage::StaticDraw);
+
+    Mesh mesh;
+    mesh.setPrimitive(MeshPrimitive::Points)
+        .addVertexBuffer(buffer, 4, Attribute());
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    DrawChecker checker;
+    mesh.drawIndirect(FloatShader("float", "vec4(valueInterpolated, 0.0, 0.0, 0.0)"), indirect, 0, 2, 5*4);
+    const auto value = checker.get<UnsignedByte>(PixelFormat::RGBA, PixelType::UnsignedByte);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(value, 96);
+}
+
+void MeshGLTest::multiDrawIndirectCount() {
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::indirect_parameters>())
+        CORRADE_SKIP(Extensions::GL::ARB::indirect_parameters::string() + std::string(" is not available."));
+
+    typedef Attribute<0, Float> Attribute;
+
+    const Float data[] = { 0.0f, -0.7f, Math::unpack<Float, UnsignedByte>(96) };
+    Buffer buffer;
+    buffer.setData(data, BufferUsage::StaticDraw);
+
+    /* The third command would overwrite the result if not skipped */
+    const UnsignedInt commands[] = {
+        1, 1, 0, 0,
+        1, 1, 1, 0,
+        1, 1, 0, 0
+    };
+    Buffer indirect{Buffer::TargetHint::DrawIndirect};
+    indirect.setData(commands, BufferUsage::StaticDraw);
+
+    const UnsignedInt count[] = { 0, 2 };
+    Buffer parameters{Buffer::TargetHint::Parameter};
+    parameters.setData(count, BufferUsage::StaticDraw);
+
+    Mesh mesh;
+    mesh.setPrimitive(MeshPrimitive::Points)
+        .addVertexBuffer(buffer, 4, Attribute());
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    DrawChecker checker;
+    mesh.drawIndirect(FloatShader("float", "vec4(valueInterpolated, 0.0, 0.0, 0.0)"), indirect, 0, parameters, 4, 3);
+    const auto value = checker.get<UnsignedByte>(PixelFormat::RGBA, PixelType::UnsignedByte);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(value, 96);
+}
+#endif
+
 }}
 
 CORRADE_TEST_MAIN(Magnum::Test::MeshGLTest)
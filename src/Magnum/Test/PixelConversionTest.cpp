@@ -0,0 +1,258 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelConversion.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/ThreadPool.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Packing.h"
+
+namespace Magnum { namespace Test {
+
+struct PixelConversionTest: TestSuite::Tester {
+    explicit PixelConversionTest();
+
+    void rgbToRgba();
+    void rgbaToRgb();
+    #ifndef MAGNUM_TARGET_WEBGL
+    void bgraToRgba();
+    #endif
+    #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+    void rgbaToRed();
+    #endif
+    void halfToFloat();
+    void floatToHalf();
+    void parallel();
+    void unsupported();
+
+    void swapRedBlue3();
+    void swapRedBlue4();
+    void swapRedBlueInvalid();
+
+    void premultiplyAlpha();
+    void premultiplyAlphaFloat();
+    void premultiplyAlphaInvalid();
+};
+
+PixelConversionTest::PixelConversionTest() {
+    addTests({&PixelConversionTest::rgbToRgba,
+              &PixelConversionTest::rgbaToRgb,
+              #ifndef MAGNUM_TARGET_WEBGL
+              &PixelConversionTest::bgraToRgba,
+              #endif
+              #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+              &PixelConversionTest::rgbaToRed,
+              #endif
+              &PixelConversionTest::halfToFloat,
+              &PixelConversionTest::floatToHalf,
+              &PixelConversionTest::parallel,
+              &PixelConversionTest::unsupported,
+
+              &PixelConversionTest::swapRedBlue3,
+              &PixelConversionTest::swapRedBlue4,
+              &PixelConversionTest::swapRedBlueInvalid,
+
+              &PixelConversionTest::premultiplyAlpha,
+              &PixelConversionTest::premultiplyAlphaFloat,
+              &PixelConversionTest::premultiplyAlphaInvalid});
+}
+
+void PixelConversionTest::rgbToRgba() {
+    /* Rows of 9 bytes padded to 12 with the default alignment */
+    const char data[] = {
+        1, 2, 3, 4, 5, 6, 7, 8, 9, 0, 0, 0,
+        10, 11, 12, 13, 14, 15, 16, 17, 18, 0, 0, 0
+    };
+    Image2D image = convertPixels(ImageView2D{PixelFormat::RGB, PixelType::UnsignedByte, {3, 2}, data}, PixelFormat::RGBA, PixelType::UnsignedByte);
+
+    CORRADE_COMPARE(image.format(), PixelFormat::RGBA);
+    CORRADE_COMPARE(image.type(), PixelType::UnsignedByte);
+    CORRADE_COMPARE(image.size(), (Vector2i{3, 2}));
+    const Color4ub expected[]{
+        {1, 2, 3, 255}, {4, 5, 6, 255}, {7, 8, 9, 255},
+        {10, 11, 12, 255}, {13, 14, 15, 255}, {16, 17, 18, 255}};
+    CORRADE_COMPARE_AS(Containers::arrayCast<const Color4ub>(image.data()),
+        Containers::arrayView(expected), TestSuite::Compare::Container);
+}
+
+void PixelConversionTest::rgbaToRgb() {
+    /* Wide enough to go through the batched code path */
+    Containers::Array<Color4ub> data{37};
+    for(std::size_t i = 0; i != data.size(); ++i)
+        data[i] = Color4ub(i, i*2, i*3, 255 - i);
+
+    Image2D image = convertPixels(ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte, {37, 1}, data}, PixelFormat::RGB, PixelType::UnsignedByte);
+
+    CORRADE_COMPARE(image.storage().alignment(), 1);
+    CORRADE_COMPARE(image.data().size(), 37*3);
+    for(std::size_t i = 0; i != data.size(); ++i) {
+        CORRADE_COMPARE(image.data<Color3ub>()[i], data[i].rgb());
+    }
+}
+
+#ifndef MAGNUM_TARGET_WEBGL
+void PixelConversionTest::bgraToRgba() {
+    Containers::Array<Color4ub> data{19};
+    for(std::size_t i = 0; i != data.size(); ++i)
+        data[i] = Color4ub(i, 100 + i, 200 + i, 50);
+
+    Image2D image = convertPixels(ImageView2D{PixelFormat::BGRA, PixelType::UnsignedByte, {19, 1}, data}, PixelFormat::RGBA, PixelType::UnsignedByte);
+
+    for(std::size_t i = 0; i != data.size(); ++i) {
+        CORRADE_COMPARE(image.data<Color4ub>()[i], Color4ub(200 + i, 100 + i, i, 50));
+    }
+}
+#endif
+
+#if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+void PixelConversionTest::rgbaToRed() {
+    const Color4ub data[]{{1, 2, 3, 4}, {5, 6, 7, 8}, {9, 10, 11, 12}, {13, 14, 15, 16}};
+    Image2D image = convertPixels(ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte, {2, 2}, data}, PixelFormat::Red, PixelType::UnsignedByte);
+
+    CORRADE_COMPARE(image.storage().alignment(), 1);
+    const char expected[]{1, 5, 9, 13};
+    CORRADE_COMPARE_AS(Containers::ArrayView<const char>{image.data()},
+        Containers::arrayView(expected), TestSuite::Compare::Container);
+}
+#endif
+
+void PixelConversionTest::halfToFloat() {
+    const UnsignedShort data[]{
+        Math::packHalf(1.0f), Math::packHalf(-2.5f), Math::packHalf(0.25f), Math::packHalf(0.0f),
+        Math::packHalf(3.0f), Math::packHalf(0.5f), Math::packHalf(-1.0f), Math::packHalf(8.0f)
+    };
+    Image2D image = convertPixels(ImageView2D{PixelFormat::RGBA, PixelType::HalfFloat, {1, 2}, data}, PixelFormat::RGBA, PixelType::Float);
+
+    CORRADE_COMPARE(image.type(), PixelType::Float);
+    const Float expected[]{1.0f, -2.5f, 0.25f, 0.0f, 3.0f, 0.5f, -1.0f, 8.0f};
+    CORRADE_COMPARE_AS(Containers::arrayCast<const Float>(image.data()),
+        Containers::arrayView(expected), TestSuite::Compare::Container);
+}
+
+void PixelConversionTest::floatToHalf() {
+    const Float data[]{1.0f, -2.5f, 0.25f, 0.0f};
+    Image2D image = convertPixels(ImageView2D{PixelFormat::RGBA, PixelType::Float, {1, 1}, data}, PixelFormat::RGBA, PixelType::HalfFloat);
+
+    CORRADE_COMPARE(image.type(), PixelType::HalfFloat);
+    CORRADE_COMPARE(image.data<UnsignedShort>()[1], Math::packHalf(-2.5f));
+    CORRADE_COMPARE(image.data<UnsignedShort>()[2], Math::packHalf(0.25f));
+}
+
+void PixelConversionTest::parallel() {
+    Containers::Array<char> data{64*3*48};
+    for(std::size_t i = 0; i != data.size(); ++i)
+        data[i] = char(i*31);
+    const ImageView2D view{PixelFormat::RGB, PixelType::UnsignedByte, {64, 48}, data};
+
+    ThreadPool pool{4};
+    Image2D a = convertPixels(view, PixelFormat::RGBA, PixelType::UnsignedByte);
+    Image2D b = convertPixels(view, PixelFormat::RGBA, PixelType::UnsignedByte, pool);
+    CORRADE_COMPARE_AS(Containers::ArrayView<const char>{b.data()},
+        Containers::ArrayView<const char>{a.data()}, TestSuite::Compare::Container);
+}
+
+void PixelConversionTest::unsupported() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    const Float data[4]{};
+    convertPixels(ImageView2D{PixelFormat::RGBA, PixelType::Float, {1, 1}, data}, PixelFormat::RGB, PixelType::Float);
+    CORRADE_COMPARE(out.str(), "convertPixels(): conversion from PixelFormat::RGBA PixelType::Float to PixelFormat::RGB PixelType::Float is not supported\n");
+}
+
+void PixelConversionTest::swapRedBlue3() {
+    char data[]{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18};
+    swapRedBlueInPlace(data, 3);
+    const char expected[]{3, 2, 1, 6, 5, 4, 9, 8, 7, 12, 11, 10, 15, 14, 13, 18, 17, 16};
+    CORRADE_COMPARE_AS(Containers::arrayView(data),
+        Containers::arrayView(expected), TestSuite::Compare::Container);
+}
+
+void PixelConversionTest::swapRedBlue4() {
+    Containers::Array<Color4ub> data{21};
+    for(std::size_t i = 0; i != data.size(); ++i)
+        data[i] = Color4ub(i, 50 + i, 100 + i, 150 + i);
+
+    swapRedBlueInPlace(Containers::arrayCast<char>(data), 4);
+    for(std::size_t i = 0; i != data.size(); ++i) {
+        CORRADE_COMPARE(data[i], Color4ub(100 + i, 50 + i, i, 150 + i));
+    }
+}
+
+void PixelConversionTest::swapRedBlueInvalid() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    char data[8]{};
+    swapRedBlueInPlace(data, 2);
+    swapRedBlueInPlace(data, 3);
+    CORRADE_COMPARE(out.str(),
+        "swapRedBlueInPlace(): expected pixel size 3 or 4 but got 2\n"
+        "swapRedBlueInPlace(): data size 8 is not divisible by pixel size 3\n");
+}
+
+void PixelConversionTest::premultiplyAlpha() {
+    Containers::Array<char> data{Containers::ValueInit, 8};
+    Containers::arrayCast<Color4ub>(data)[0] = {255, 128, 0, 128};
+    Containers::arrayCast<Color4ub>(data)[1] = {200, 100, 50, 0};
+    Image2D image{PixelFormat::RGBA, PixelType::UnsignedByte, {2, 1}, std::move(data)};
+
+    premultiplyAlphaInPlace(image);
+    CORRADE_COMPARE(image.data<Color4ub>()[0], (Color4ub{128, 64, 0, 128}));
+    CORRADE_COMPARE(image.data<Color4ub>()[1], (Color4ub{0, 0, 0, 0}));
+}
+
+void PixelConversionTest::premultiplyAlphaFloat() {
+    Containers::Array<char> data{Containers::ValueInit, 16};
+    Containers::arrayCast<Color4>(data)[0] = {1.0f, 0.5f, 0.25f, 0.5f};
+    Image2D image{PixelFormat::RGBA, PixelType::Float, {1, 1}, std::move(data)};
+
+    premultiplyAlphaInPlace(image);
+    CORRADE_COMPARE(image.data<Color4>()[0], (Color4{0.5f, 0.25f, 0.125f, 0.5f}));
+}
+
+void PixelConversionTest::premultiplyAlphaInvalid() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    Image2D a{PixelFormat::RGB, PixelType::UnsignedByte, {1, 1}, Containers::Array<char>{Containers::ValueInit, 4}};
+    Image2D b{PixelFormat::RGBA, PixelType::UnsignedShort, {1, 1}, Containers::Array<char>{Containers::ValueInit, 8}};
+    premultiplyAlphaInPlace(a);
+    premultiplyAlphaInPlace(b);
+    CORRADE_COMPARE(out.str(),
+        "premultiplyAlphaInPlace(): expected four-channel image but got PixelFormat::RGB\n"
+        "premultiplyAlphaInPlace(): expected unsigned byte or float image but got PixelType::UnsignedShort\n");
+}
+
+}}
+
+CORRADE_TEST_MAIN(Magnum::Test::PixelConversionTest)
@@ -0,0 +1,297 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/Context.h"
+#include "Magnum/DefaultFramebuffer.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/Framebuffer.h"
+#include "Magnum/Image.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Renderbuffer.h"
+#include "Magnum/RenderbufferFormat.h"
+#include "Magnum/Renderer.h"
+#include "Magnum/RenderPass.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/OpenGLTester.h"
+
+namespace Magnum { namespace Test {
+
+struct RenderPassGLTest: OpenGLTester {
+    explicit RenderPassGLTest();
+
+    void construct();
+    void setAttachment();
+
+    void clear();
+    void load();
+    void invalidate();
+    #ifndef MAGNUM_TARGET_GLES2
+    void invalidateRectangle();
+    #endif
+    void resetStatistics();
+
+    void defaultFramebuffer();
+};
+
+RenderPassGLTest::RenderPassGLTest() {
+    addTests({&RenderPassGLTest::construct,
+              &RenderPassGLTest::setAttachment,
+
+              &RenderPassGLTest::clear,
+              &RenderPassGLTest::load,
+              &RenderPassGLTest::invalidate,
+              #ifndef MAGNUM_TARGET_GLES2
+              &RenderPassGLTest::invalidateRectangle,
+              #endif
+              &RenderPassGLTest::resetStatistics,
+
+              &RenderPassGLTest::defaultFramebuffer});
+}
+
+namespace {
+    #ifndef MAGNUM_TARGET_GLES2
+    constexpr RenderbufferFormat ColorFormat = RenderbufferFormat::RGBA8;
+    #else
+    constexpr RenderbufferFormat ColorFormat = RenderbufferFormat::RGBA4;
+    #endif
+}
+
+void RenderPassGLTest::construct() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::framebuffer_object>())
+        CORRADE_SKIP(Extensions::GL::ARB::framebuffer_object::string() + std::string(" is not available."));
+    #endif
+
+    Framebuffer framebuffer{{{}, Vector2i{32}}};
+    RenderPass<Framebuffer> pass{framebuffer};
+
+    CORRADE_COMPARE(&pass.framebuffer(), &framebuffer);
+    CORRADE_COMPARE(pass.attachmentCount(), 0);
+    CORRADE_VERIFY(!pass.isInProgress());
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_COMPARE(pass.rectangle(), Range2Di{});
+    #endif
+    CORRADE_COMPARE(pass.skippedLoadPixelCount(), 0);
+    CORRADE_COMPARE(pass.skippedStorePixelCount(), 0);
+}
+
+void RenderPassGLTest::setAttachment() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::framebuffer_object>())
+        CORRADE_SKIP(Extensions::GL::ARB::framebuffer_object::string() + std::string(" is not available."));
+    #endif
+
+    Framebuffer framebuffer{{{}, Vector2i{32}}};
+    RenderPass<Framebuffer> pass{framebuffer};
+    pass.setAttachment(Framebuffer::ColorAttachment{0}, RenderPassLoadAction::Load, RenderPassStoreAction::Store)
+        .setAttachment(Framebuffer::InvalidationAttachment::Depth, RenderPassLoadAction::Clear, RenderPassStoreAction::DontCare);
+    CORRADE_COMPARE(pass.attachmentCount(), 2);
+
+    /* Setting the same attachment again replaces the actions */
+    pass.setAttachment(Framebuffer::ColorAttachment{0}, RenderPassLoadAction::DontCare, RenderPassStoreAction::Store);
+    CORRADE_COMPARE(pass.attachmentCount(), 2);
+}
+
+void RenderPassGLTest::clear() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::framebuffer_object>())
+        CORRADE_SKIP(Extensions::GL::ARB::framebuffer_object::string() + std::string(" is not available."));
+    #endif
+
+    Renderbuffer color;
+    color.setStorage(ColorFormat, Vector2i{32});
+    Renderbuffer depth;
+    depth.setStorage(RenderbufferFormat::DepthComponent16, Vector2i{32});
+
+    Framebuffer framebuffer{{{}, Vector2i{32}}};
+    framebuffer.attachRenderbuffer(Framebuffer::ColorAttachment{0}, color)
+               .attachRenderbuffer(Framebuffer::BufferAttachment::Depth, depth);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(framebuffer.checkStatus(FramebufferTarget::Draw), Framebuffer::Status::Complete);
+
+    RenderPass<Framebuffer> pass{framebuffer};
+    pass.setAttachment(Framebuffer::ColorAttachment{0}, RenderPassLoadAction::Clear, RenderPassStoreAction::Store)
+        .setAttachment(Framebuffer::InvalidationAttachment::Depth, RenderPassLoadAction::Clear, RenderPassStoreAction::DontCare);
+
+    Renderer::setClearColor(Math::unpack<Color4>(Color4ub{255, 0, 0, 255}));
+    CORRADE_COMPARE(&pass.begin(), &framebuffer);
+    CORRADE_VERIFY(pass.isInProgress());
+    pass.end();
+    CORRADE_VERIFY(!pass.isInProgress());
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /* Both attachments were cleared, only depth invalidated at the end */
+    CORRADE_COMPARE(pass.skippedLoadPixelCount(), 2*32*32);
+    CORRADE_COMPARE(pass.skippedStorePixelCount(), 32*32);
+
+    Image2D image = framebuffer.read({{}, Vector2i{1}}, {PixelFormat::RGBA, PixelType::UnsignedByte});
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(image.data<Color4ub>()[0], (Color4ub{255, 0, 0, 255}));
+}
+
+void RenderPassGLTest::load() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::framebuffer_object>())
+        CORRADE_SKIP(Extensions::GL::ARB::framebuffer_object::string() + std::string(" is not available."));
+    #endif
+
+    Renderbuffer color;
+    color.setStorage(ColorFormat, Vector2i{32});
+
+    Framebuffer framebuffer{{{}, Vector2i{32}}};
+    framebuffer.attachRenderbuffer(Framebuffer::ColorAttachment{0}, color);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(framebuffer.checkStatus(FramebufferTarget::Draw), Framebuffer::Status::Complete);
+
+    Renderer::setClearColor(Math::unpack<Color4>(Color4ub{0, 255, 0, 255}));
+    framebuffer.clear(FramebufferClear::Color);
+
+    /* Loaded attachment keeps its contents, even if the clear color
+       changes */
+    RenderPass<Framebuffer> pass{framebuffer};
+    pass.setAttachment(Framebuffer::ColorAttachment{0}, RenderPassLoadAction::Load, RenderPassStoreAction::Store);
+    Renderer::setClearColor(Math::unpack<Color4>(Color4ub{0, 0, 255, 255}));
+    pass.begin();
+    pass.end();
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(pass.skippedLoadPixelCount(), 0);
+    CORRADE_COMPARE(pass.skippedStorePixelCount(), 0);
+
+    Image2D image = framebuffer.read({{}, Vector2i{1}}, {PixelFormat::RGBA, PixelType::UnsignedByte});
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(image.data<Color4ub>()[0], (Color4ub{0, 255, 0, 255}));
+}
+
+void RenderPassGLTest::invalidate() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::framebuffer_object>())
+        CORRADE_SKIP(Extensions::GL::ARB::framebuffer_object::string() + std::string(" is not available."));
+    #endif
+
+    Renderbuffer color;
+    color.setStorage(ColorFormat, Vector2i{32});
+    Renderbuffer depth;
+    depth.setStorage(RenderbufferFormat::DepthComponent16, Vector2i{32});
+
+    Framebuffer framebuffer{{{}, Vector2i{32}}};
+    framebuffer.attachRenderbuffer(Framebuffer::ColorAttachment{0}, color)
+               .attachRenderbuffer(Framebuffer::BufferAttachment::Depth, depth);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(framebuffer.checkStatus(FramebufferTarget::Draw), Framebuffer::Status::Complete);
+
+    RenderPass<Framebuffer> pass{framebuffer};
+    pass.setAttachment(Framebuffer::ColorAttachment{0}, RenderPassLoadAction::DontCare, RenderPassStoreAction::DontCare)
+        .setAttachment(Framebuffer::InvalidationAttachment::Depth, RenderPassLoadAction::DontCare, RenderPassStoreAction::DontCare);
+
+    /* Statistics accumulate over multiple passes */
+    pass.begin();
+    pass.end();
+    pass.begin();
+    pass.end();
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(pass.skippedLoadPixelCount(), 2*2*32*32);
+    CORRADE_COMPARE(pass.skippedStorePixelCount(), 2*2*32*32);
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+void RenderPassGLTest::invalidateRectangle() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::framebuffer_object>())
+        CORRADE_SKIP(Extensions::GL::ARB::framebuffer_object::string() + std::string(" is not available."));
+    #endif
+
+    Renderbuffer color;
+    color.setStorage(ColorFormat, Vector2i{32});
+
+    Framebuffer framebuffer{{{}, Vector2i{32}}};
+    framebuffer.attachRenderbuffer(Framebuffer::ColorAttachment{0}, color);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(framebuffer.checkStatus(FramebufferTarget::Draw), Framebuffer::Status::Complete);
+
+    RenderPass<Framebuffer> pass{framebuffer};
+    pass.setAttachment(Framebuffer::ColorAttachment{0}, RenderPassLoadAction::Load, RenderPassStoreAction::DontCare)
+        .setRectangle(Range2Di::fromSize({8, 4}, {16, 8}));
+    CORRADE_COMPARE(pass.rectangle(), Range2Di::fromSize({8, 4}, {16, 8}));
+
+    pass.begin();
+    pass.end();
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(pass.skippedLoadPixelCount(), 0);
+    CORRADE_COMPARE(pass.skippedStorePixelCount(), 16*8);
+}
+#endif
+
+void RenderPassGLTest::resetStatistics() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::framebuffer_object>())
+        CORRADE_SKIP(Extensions::GL::ARB::framebuffer_object::string() + std::string(" is not available."));
+    #endif
+
+    Renderbuffer color;
+    color.setStorage(ColorFormat, Vector2i{32});
+
+    Framebuffer framebuffer{{{}, Vector2i{32}}};
+    framebuffer.attachRenderbuffer(Framebuffer::ColorAttachment{0}, color);
+
+    RenderPass<Framebuffer> pass{framebuffer};
+    pass.setAttachment(Framebuffer::ColorAttachment{0}, RenderPassLoadAction::Clear, RenderPassStoreAction::DontCare);
+    pass.begin();
+    pass.end();
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(pass.skippedLoadPixelCount(), 32*32);
+    CORRADE_COMPARE(pass.skippedStorePixelCount(), 32*32);
+
+    pass.resetStatistics();
+    CORRADE_COMPARE(pass.skippedLoadPixelCount(), 0);
+    CORRADE_COMPARE(pass.skippedStorePixelCount(), 0);
+}
+
+void RenderPassGLTest::defaultFramebuffer() {
+    RenderPass<DefaultFramebuffer> pass{Magnum::defaultFramebuffer};
+    pass.setAttachment(DefaultFramebuffer::InvalidationAttachment::Depth, RenderPassLoadAction::Clear, RenderPassStoreAction::DontCare)
+        .setAttachment(DefaultFramebuffer::InvalidationAttachment::Stencil, RenderPassLoadAction::DontCare, RenderPassStoreAction::DontCare);
+
+    CORRADE_COMPARE(&pass.begin(), &Magnum::defaultFramebuffer);
+    pass.end();
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    const UnsignedLong area = Magnum::defaultFramebuffer.viewport().size().product();
+    CORRADE_COMPARE(pass.skippedLoadPixelCount(), 2*area);
+    CORRADE_COMPARE(pass.skippedStorePixelCount(), 2*area);
+}
+
+}}
+
+CORRADE_TEST_MAIN(Magnum::Test::RenderPassGLTest)
@@ -0,0 +1,360 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/Framebuffer.h"
+#include "Magnum/Image.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Renderbuffer.h"
+#include "Magnum/RenderbufferFormat.h"
+#include "Magnum/Renderer.h"
+#include "Magnum/RenderTargetPool.h"
+#include "Magnum/Texture.h"
+#include "Magnum/TextureFormat.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/OpenGLTester.h"
+
+namespace Magnum { namespace Test {
+
+struct RenderTargetPoolGLTest: OpenGLTester {
+    explicit RenderTargetPoolGLTest();
+
+    void construct();
+    void constructMove();
+
+    void acquireTexture();
+    void acquireRenderbuffer();
+    void acquireRenderbufferMultisample();
+    void releaseNotFromPool();
+    void releaseTwice();
+
+    void nextFrame();
+    void nextFrameAcquired();
+
+    void resolve();
+};
+
+RenderTargetPoolGLTest::RenderTargetPoolGLTest() {
+    addTests({&RenderTargetPoolGLTest::construct,
+              &RenderTargetPoolGLTest::constructMove,
+
+              &RenderTargetPoolGLTest::acquireTexture,
+              &RenderTargetPoolGLTest::acquireRenderbuffer,
+              &RenderTargetPoolGLTest::acquireRenderbufferMultisample,
+              &RenderTargetPoolGLTest::releaseNotFromPool,
+              &RenderTargetPoolGLTest::releaseTwice,
+
+              &RenderTargetPoolGLTest::nextFrame,
+              &RenderTargetPoolGLTest::nextFrameAcquired,
+
+              &RenderTargetPoolGLTest::resolve});
+}
+
+namespace {
+    #ifndef MAGNUM_TARGET_GLES2
+    constexpr TextureFormat TextureFormatRGBA = TextureFormat::RGBA8;
+    constexpr RenderbufferFormat RenderbufferFormatRGBA = RenderbufferFormat::RGBA8;
+    #else
+    constexpr TextureFormat TextureFormatRGBA = TextureFormat::RGBA;
+    constexpr RenderbufferFormat RenderbufferFormatRGBA = RenderbufferFormat::RGBA4;
+    #endif
+}
+
+void RenderTargetPoolGLTest::construct() {
+    RenderTargetPool pool{3};
+
+    CORRADE_COMPARE(pool.maxUnusedFrames(), 3);
+    CORRADE_COMPARE(pool.frame(), 0);
+    CORRADE_COMPARE(pool.textureCount(), 0);
+    CORRADE_COMPARE(pool.renderbufferCount(), 0);
+    CORRADE_COMPARE(pool.acquiredTextureCount(), 0);
+    CORRADE_COMPARE(pool.acquiredRenderbufferCount(), 0);
+}
+
+void RenderTargetPoolGLTest::constructMove() {
+    RenderTargetPool a{5};
+    Texture2D& texture = a.acquireTexture(TextureFormatRGBA, Vector2i{16});
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    RenderTargetPool b{std::move(a)};
+    CORRADE_COMPARE(b.maxUnusedFrames(), 5);
+    CORRADE_COMPARE(b.textureCount(), 1);
+
+    RenderTargetPool c;
+    c = std::move(b);
+    CORRADE_COMPARE(c.maxUnusedFrames(), 5);
+    CORRADE_COMPARE(c.textureCount(), 1);
+
+    /* The texture is still the same object */
+    c.release(texture);
+    CORRADE_COMPARE(&c.acquireTexture(TextureFormatRGBA, Vector2i{16}), &texture);
+}
+
+void RenderTargetPoolGLTest::acquireTexture() {
+    RenderTargetPool pool;
+
+    Texture2D& a = pool.acquireTexture(TextureFormatRGBA, Vector2i{32});
+    Texture2D& b = pool.acquireTexture(TextureFormatRGBA, Vector2i{32});
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(&a != &b);
+    CORRADE_VERIFY(a.id() != b.id());
+    CORRADE_COMPARE(pool.textureCount(), 2);
+    CORRADE_COMPARE(pool.acquiredTextureCount(), 2);
+
+    /* A released texture is reused for the same format and size */
+    pool.release(a);
+    CORRADE_COMPARE(pool.acquiredTextureCount(), 1);
+    CORRADE_COMPARE(&pool.acquireTexture(TextureFormatRGBA, Vector2i{32}), &a);
+    CORRADE_COMPARE(pool.textureCount(), 2);
+    CORRADE_COMPARE(pool.acquiredTextureCount(), 2);
+
+    /* But not for a different size */
+    pool.release(b);
+    Texture2D& c = pool.acquireTexture(TextureFormatRGBA, {32, 16});
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(&c != &b);
+    CORRADE_COMPARE(pool.textureCount(), 3);
+    CORRADE_COMPARE(pool.acquiredTextureCount(), 2);
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_COMPARE(c.imageSize(0), (Vector2i{32, 16}));
+    #endif
+}
+
+void RenderTargetPoolGLTest::acquireRenderbuffer() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::framebuffer_object>())
+        CORRADE_SKIP(Extensions::GL::ARB::framebuffer_object::string() + std::string(" is not available."));
+    #endif
+
+    RenderTargetPool pool;
+
+    Renderbuffer& a = pool.acquireRenderbuffer(RenderbufferFormatRGBA, Vector2i{32});
+    Renderbuffer& b = pool.acquireRenderbuffer(RenderbufferFormat::DepthComponent16, Vector2i{32});
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(&a != &b);
+    CORRADE_COMPARE(pool.renderbufferCount(), 2);
+    CORRADE_COMPARE(pool.acquiredRenderbufferCount(), 2);
+
+    /* Released renderbuffer is not reused for a different format */
+    pool.release(b);
+    CORRADE_VERIFY(&pool.acquireRenderbuffer(RenderbufferFormatRGBA, Vector2i{32}) != &b);
+    CORRADE_COMPARE(pool.renderbufferCount(), 3);
+
+    /* But is for the same */
+    CORRADE_COMPARE(&pool.acquireRenderbuffer(RenderbufferFormat::DepthComponent16, Vector2i{32}), &b);
+    CORRADE_COMPARE(pool.renderbufferCount(), 3);
+    CORRADE_COMPARE(pool.acquiredRenderbufferCount(), 3);
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void RenderTargetPoolGLTest::acquireRenderbufferMultisample() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::framebuffer_object>())
+        CORRADE_SKIP(Extensions::GL::ARB::framebuffer_object::string() + std::string(" is not available."));
+    #elif defined(MAGNUM_TARGET_GLES2)
+    if(!Context::current().isExtensionSupported<Extensions::GL::ANGLE::framebuffer_multisample>() &&
+       !Context::current().isExtensionSupported<Extensions::GL::NV::framebuffer_multisample>())
+        CORRADE_SKIP("Required extension is not available.");
+    #endif
+
+    const Int samples = Math::min(Renderbuffer::maxSamples(), 4);
+    if(samples < 2) CORRADE_SKIP("Multisampled renderbuffers are not supported.");
+
+    RenderTargetPool pool;
+
+    Renderbuffer& a = pool.acquireRenderbuffer(RenderbufferFormatRGBA, Vector2i{32}, samples);
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /* Released renderbuffer is not reused for a different sample count */
+    pool.release(a);
+    CORRADE_VERIFY(&pool.acquireRenderbuffer(RenderbufferFormatRGBA, Vector2i{32}) != &a);
+    CORRADE_COMPARE(&pool.acquireRenderbuffer(RenderbufferFormatRGBA, Vector2i{32}, samples), &a);
+    CORRADE_COMPARE(pool.renderbufferCount(), 2);
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void RenderTargetPoolGLTest::releaseNotFromPool() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::framebuffer_object>())
+        CORRADE_SKIP(Extensions::GL::ARB::framebuffer_object::string() + std::string(" is not available."));
+    #endif
+
+    RenderTargetPool pool;
+    Texture2D texture;
+    Renderbuffer renderbuffer;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    pool.release(texture);
+    pool.release(renderbuffer);
+    CORRADE_COMPARE(out.str(),
+        "RenderTargetPool::release(): the texture is not from this pool\n"
+        "RenderTargetPool::release(): the renderbuffer is not from this pool\n");
+}
+
+void RenderTargetPoolGLTest::releaseTwice() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::framebuffer_object>())
+        CORRADE_SKIP(Extensions::GL::ARB::framebuffer_object::string() + std::string(" is not available."));
+    #endif
+
+    RenderTargetPool pool;
+    Texture2D& texture = pool.acquireTexture(TextureFormatRGBA, Vector2i{16});
+    Renderbuffer& renderbuffer = pool.acquireRenderbuffer(RenderbufferFormatRGBA, Vector2i{16});
+    pool.release(texture);
+    pool.release(renderbuffer);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    pool.release(texture);
+    pool.release(renderbuffer);
+    CORRADE_COMPARE(out.str(),
+        "RenderTargetPool::release(): the texture is already released\n"
+        "RenderTargetPool::release(): the renderbuffer is already released\n");
+}
+
+void RenderTargetPoolGLTest::nextFrame() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::framebuffer_object>())
+        CORRADE_SKIP(Extensions::GL::ARB::framebuffer_object::string() + std::string(" is not available."));
+    #endif
+
+    RenderTargetPool pool{1};
+    pool.release(pool.acquireTexture(TextureFormatRGBA, Vector2i{16}));
+    pool.release(pool.acquireRenderbuffer(RenderbufferFormatRGBA, Vector2i{16}));
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /* Unused for one frame, still kept */
+    pool.nextFrame();
+    CORRADE_COMPARE(pool.frame(), 1);
+    CORRADE_COMPARE(pool.textureCount(), 1);
+    CORRADE_COMPARE(pool.renderbufferCount(), 1);
+
+    /* Acquiring and releasing again resets the age */
+    pool.release(pool.acquireTexture(TextureFormatRGBA, Vector2i{16}));
+
+    /* Renderbuffer unused for two frames, deleted */
+    pool.nextFrame();
+    CORRADE_COMPARE(pool.frame(), 2);
+    CORRADE_COMPARE(pool.textureCount(), 1);
+    CORRADE_COMPARE(pool.renderbufferCount(), 0);
+
+    pool.nextFrame();
+    CORRADE_COMPARE(pool.textureCount(), 0);
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void RenderTargetPoolGLTest::nextFrameAcquired() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::framebuffer_object>())
+        CORRADE_SKIP(Extensions::GL::ARB::framebuffer_object::string() + std::string(" is not available."));
+    #endif
+
+    RenderTargetPool pool{0};
+    pool.acquireTexture(TextureFormatRGBA, Vector2i{16});
+    pool.acquireRenderbuffer(RenderbufferFormatRGBA, Vector2i{16});
+
+    /* Acquired targets are never deleted */
+    for(Int i = 0; i != 5; ++i) pool.nextFrame();
+    CORRADE_COMPARE(pool.textureCount(), 1);
+    CORRADE_COMPARE(pool.renderbufferCount(), 1);
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void RenderTargetPoolGLTest::resolve() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::framebuffer_object>())
+        CORRADE_SKIP(Extensions::GL::ARB::framebuffer_object::string() + std::string(" is not available."));
+    #elif defined(MAGNUM_TARGET_GLES2)
+    if(!Context::current().isExtensionSupported<Extensions::GL::ANGLE::framebuffer_multisample>() &&
+       !Context::current().isExtensionSupported<Extensions::GL::NV::framebuffer_multisample>())
+        CORRADE_SKIP("Required extension is not available.");
+    if(!Context::current().isExtensionSupported<Extensions::GL::NV::framebuffer_blit>() &&
+       !Context::current().isExtensionSupported<Extensions::GL::ANGLE::framebuffer_blit>())
+        CORRADE_SKIP("Required extension is not available.");
+    #endif
+
+    const Int samples = Math::min(Renderbuffer::maxSamples(), 4);
+    if(samples < 2) CORRADE_SKIP("Multisampled renderbuffers are not supported.");
+
+    RenderTargetPool pool;
+
+    Renderbuffer& color = pool.acquireRenderbuffer(RenderbufferFormatRGBA, Vector2i{32}, samples);
+    Framebuffer multisampled{{{}, Vector2i{32}}};
+    multisampled.attachRenderbuffer(Framebuffer::ColorAttachment{0}, color);
+
+    Renderbuffer& resolvedColor = pool.acquireRenderbuffer(RenderbufferFormatRGBA, Vector2i{32});
+    Framebuffer resolved{{{}, Vector2i{32}}};
+    resolved.attachRenderbuffer(Framebuffer::ColorAttachment{0}, resolvedColor);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(multisampled.checkStatus(FramebufferTarget::Draw), Framebuffer::Status::Complete);
+    CORRADE_COMPARE(resolved.checkStatus(FramebufferTarget::Draw), Framebuffer::Status::Complete);
+
+    Renderer::setClearColor(Math::unpack<Color4>(Color4ub(128, 64, 32, 17)));
+    multisampled.clear(FramebufferClear::Color);
+    Renderer::setClearColor({});
+    resolved.clear(FramebufferClear::Color);
+
+    RenderTargetPool::resolve(multisampled, resolved, FramebufferBlit::Color,
+        {Framebuffer::ColorAttachment{0}});
+    pool.release(color);
+
+    Image2D image = resolved.read({{}, Vector2i{1}}, {PixelFormat::RGBA, PixelType::UnsignedByte});
+
+    MAGNUM_VERIFY_NO_ERROR();
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_COMPARE(image.data<Color4ub>()[0], Color4ub(128, 64, 32, 17));
+    #else
+    /* RGBA4 on ES2 loses precision, check just that something got there */
+    CORRADE_VERIFY(image.data<Color4ub>()[0] != Color4ub());
+    #endif
+}
+
+}}
+
+CORRADE_TEST_MAIN(Magnum::Test::RenderTargetPoolGLTest)
@@ -0,0 +1,218 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/Context.h"
+#include "Magnum/OpenGLTester.h"
+#include "Magnum/Renderer.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Range.h"
+
+namespace Magnum { namespace Test {
+
+struct RendererGLTest: OpenGLTester {
+    explicit RendererGLTest();
+
+    void setFeature();
+    void setRedundant();
+    void setRedundantResetState();
+    void setStencilSeparate();
+
+    void applyStateBlock();
+    void applyStateBlockPartial();
+};
+
+RendererGLTest::RendererGLTest() {
+    addTests({&RendererGLTest::setFeature,
+              &RendererGLTest::setRedundant,
+              &RendererGLTest::setRedundantResetState,
+              &RendererGLTest::setStencilSeparate,
+
+              &RendererGLTest::applyStateBlock,
+              &RendererGLTest::applyStateBlockPartial});
+}
+
+void RendererGLTest::setFeature() {
+    Renderer::enable(Renderer::Feature::DepthTest);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(glIsEnabled(GL_DEPTH_TEST));
+
+    Renderer::setFeature(Renderer::Feature::DepthTest, false);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(!glIsEnabled(GL_DEPTH_TEST));
+
+    /* Changing the state behind Magnum's back and setting the same value
+       again is not propagated to GL */
+    glEnable(GL_DEPTH_TEST);
+    Renderer::disable(Renderer::Feature::DepthTest);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(glIsEnabled(GL_DEPTH_TEST));
+
+    Context::current().resetState(Context::State::Renderer);
+    Renderer::disable(Renderer::Feature::DepthTest);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(!glIsEnabled(GL_DEPTH_TEST));
+}
+
+void RendererGLTest::setRedundant() {
+    Renderer::setDepthFunction(Renderer::DepthFunction::Greater);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    GLint function;
+    glGetIntegerv(GL_DEPTH_FUNC, &function);
+    CORRADE_COMPARE(function, GL_GREATER);
+
+    /* Modify the state externally, a redundant call should not be submitted */
+    glDepthFunc(GL_LESS);
+    Renderer::setDepthFunction(Renderer::DepthFunction::Greater);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    glGetIntegerv(GL_DEPTH_FUNC, &function);
+    CORRADE_COMPARE(function, GL_LESS);
+
+    /* A different value is submitted */
+    Renderer::setDepthFunction(Renderer::DepthFunction::Equal);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    glGetIntegerv(GL_DEPTH_FUNC, &function);
+    CORRADE_COMPARE(function, GL_EQUAL);
+}
+
+void RendererGLTest::setRedundantResetState() {
+    Renderer::setClearColor(Color4{0.25f, 0.5f, 0.75f, 1.0f});
+    Renderer::setColorMask(true, false, true, true);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    glColorMask(true, true, true, true);
+
+    /* After resetting the state the values are submitted again */
+    Context::current().resetState(Context::State::Renderer);
+    Renderer::setClearColor(Color4{0.25f, 0.5f, 0.75f, 1.0f});
+    Renderer::setColorMask(true, false, true, true);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    Color4 color;
+    glGetFloatv(GL_COLOR_CLEAR_VALUE, color.data());
+    CORRADE_COMPARE(color, (Color4{0.25f, 0.5f, 0.75f, 1.0f}));
+
+    GLboolean mask[4];
+    glGetBooleanv(GL_COLOR_WRITEMASK, mask);
+    CORRADE_VERIFY(mask[0]);
+    CORRADE_VERIFY(!mask[1]);
+    CORRADE_VERIFY(mask[2]);
+    CORRADE_VERIFY(mask[3]);
+
+    /* Restore the default */
+    Renderer::setColorMask(true, true, true, true);
+}
+
+void RendererGLTest::setStencilSeparate() {
+    Renderer::setStencilMask(0xff);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /* Changing only the back face has to be submitted even though the front
+       face value stays the same */
+    Renderer::setStencilMask(Renderer::PolygonFacing::Back, 0x0f);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    GLint front, back;
+    glGetIntegerv(GL_STENCIL_WRITEMASK, &front);
+    glGetIntegerv(GL_STENCIL_BACK_WRITEMASK, &back);
+    CORRADE_COMPARE(front & 0xff, 0xff);
+    CORRADE_COMPARE(back & 0xff, 0x0f);
+
+    /* Setting both faces back has to be submitted as well */
+    Renderer::setStencilMask(0xff);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    glGetIntegerv(GL_STENCIL_BACK_WRITEMASK, &back);
+    CORRADE_COMPARE(back & 0xff, 0xff);
+}
+
+void RendererGLTest::applyStateBlock() {
+    Renderer::StateBlock block;
+    block.setFeature(Renderer::Feature::Blending, true)
+        .setFeature(Renderer::Feature::ScissorTest, true)
+        .setScissor({{1, 2}, {5, 7}})
+        .setDepthFunction(Renderer::DepthFunction::LessOrEqual)
+        .setBlendFunction(Renderer::BlendFunction::One, Renderer::BlendFunction::One);
+
+    Renderer::apply(block);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    CORRADE_VERIFY(glIsEnabled(GL_BLEND));
+    CORRADE_VERIFY(glIsEnabled(GL_SCISSOR_TEST));
+
+    GLint scissor[4];
+    glGetIntegerv(GL_SCISSOR_BOX, scissor);
+    CORRADE_COMPARE(scissor[0], 1);
+    CORRADE_COMPARE(scissor[1], 2);
+    CORRADE_COMPARE(scissor[2], 4);
+    CORRADE_COMPARE(scissor[3], 5);
+
+    GLint value;
+    glGetIntegerv(GL_DEPTH_FUNC, &value);
+    CORRADE_COMPARE(value, GL_LEQUAL);
+    glGetIntegerv(GL_BLEND_SRC_RGB, &value);
+    CORRADE_COMPARE(value, GL_ONE);
+    glGetIntegerv(GL_BLEND_DST_ALPHA, &value);
+    CORRADE_COMPARE(value, GL_ONE);
+
+    /* Restore the defaults */
+    Renderer::StateBlock defaults;
+    defaults.setFeature(Renderer::Feature::Blending, false)
+        .setFeature(Renderer::Feature::ScissorTest, false)
+        .setDepthFunction(Renderer::DepthFunction::Less);
+    Renderer::apply(defaults);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    CORRADE_VERIFY(!glIsEnabled(GL_BLEND));
+    CORRADE_VERIFY(!glIsEnabled(GL_SCISSOR_TEST));
+}
+
+void RendererGLTest::applyStateBlockPartial() {
+    Renderer::setDepthMask(false);
+    Renderer::setFeature(Renderer::Feature::FaceCulling, true);
+
+    /* Setting the feature twice overwrites the previous value, everything
+       that's not set is left untouched */
+    Renderer::StateBlock block;
+    block.setFeature(Renderer::Feature::FaceCulling, true)
+        .setFeature(Renderer::Feature::FaceCulling, false);
+    Renderer::apply(block);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    CORRADE_VERIFY(!glIsEnabled(GL_CULL_FACE));
+
+    GLboolean mask;
+    glGetBooleanv(GL_DEPTH_WRITEMASK, &mask);
+    CORRADE_VERIFY(!mask);
+
+    Renderer::setDepthMask(true);
+}
+
+}}
+
+CORRADE_TEST_MAIN(Magnum::Test::RendererGLTest)
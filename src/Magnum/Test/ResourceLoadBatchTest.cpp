@@ -0,0 +1,182 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <vector>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/AbstractResourceLoader.h"
+#include "Magnum/ResourceLoadBatch.h"
+#include "Magnum/ResourceManager.h"
+
+namespace Magnum { namespace Test {
+
+struct ResourceLoadBatchTest: TestSuite::Tester {
+    explicit ResourceLoadBatchTest();
+
+    void empty();
+    void dependencies();
+    void alreadyLoaded();
+    void dependencyOutOfRange();
+};
+
+typedef Magnum::ResourceManager<Int, Float> ResourceManager;
+
+ResourceLoadBatchTest::ResourceLoadBatchTest() {
+    addTests({&ResourceLoadBatchTest::empty,
+              &ResourceLoadBatchTest::dependencies,
+              &ResourceLoadBatchTest::alreadyLoaded,
+              &ResourceLoadBatchTest::dependencyOutOfRange});
+}
+
+namespace {
+
+/* Records the requests, the data are set later from the test */
+class IntResourceLoader: public AbstractResourceLoader<Int> {
+    public:
+        void finish(ResourceKey key, Int value) {
+            set(key, value, ResourceDataState::Final, ResourcePolicy::Resident);
+        }
+
+        void fail(ResourceKey key) { setNotFound(key); }
+
+        std::vector<std::vector<ResourceKey>> batches;
+
+    private:
+        void doLoad(ResourceKey key) override {
+            batches.push_back({key});
+        }
+
+        void doLoadBatch(Containers::ArrayView<const ResourceKey> keys) override {
+            batches.emplace_back(keys.begin(), keys.end());
+        }
+};
+
+/* Loads synchronously */
+class FloatResourceLoader: public AbstractResourceLoader<Float> {
+    void doLoad(ResourceKey key) override {
+        set(key, 1.5f, ResourceDataState::Final, ResourcePolicy::Resident);
+    }
+};
+
+}
+
+void ResourceLoadBatchTest::empty() {
+    ResourceLoadBatch batch;
+    Int called = 0;
+    batch.setFinishedCallback([&called]() { ++called; });
+    CORRADE_COMPARE(batch.count(), 0);
+    CORRADE_VERIFY(!batch.isFinished());
+
+    batch.update();
+    CORRADE_VERIFY(batch.isFinished());
+    CORRADE_COMPARE(called, 1);
+}
+
+void ResourceLoadBatchTest::dependencies() {
+    ResourceManager rm;
+    IntResourceLoader* intLoader = new IntResourceLoader;
+    FloatResourceLoader* floatLoader = new FloatResourceLoader;
+    rm.setLoader(intLoader)
+      .setLoader(floatLoader);
+
+    ResourceLoadBatch batch;
+    Int called = 0;
+    batch.setFinishedCallback([&called]() { ++called; });
+    const std::size_t a = batch.add<Int>(rm, "a");
+    const std::size_t b = batch.add<Int>(rm, "b");
+    const std::size_t c = batch.add<Float>(rm, "c", {a, b});
+    batch.add<Int>(rm, "d", {c});
+    CORRADE_COMPARE(batch.count(), 4);
+
+    /* Independent resources of the same type are requested at once, nothing
+       is requested before update() */
+    CORRADE_VERIFY(intLoader->batches.empty());
+    batch.update();
+    CORRADE_COMPARE(intLoader->batches.size(), 1);
+    CORRADE_COMPARE(intLoader->batches[0], (std::vector<ResourceKey>{"a", "b"}));
+    CORRADE_COMPARE(floatLoader->requestedCount(), 0);
+    CORRADE_COMPARE(batch.finishedCount(), 0);
+
+    /* Not all dependencies are loaded yet */
+    intLoader->finish("a", 3);
+    batch.update();
+    CORRADE_COMPARE(batch.finishedCount(), 1);
+    CORRADE_COMPARE(floatLoader->requestedCount(), 0);
+
+    /* The synchronously loaded resource unblocks the last one in the same
+       update */
+    intLoader->finish("b", 4);
+    batch.update();
+    CORRADE_COMPARE(batch.finishedCount(), 3);
+    CORRADE_COMPARE(floatLoader->requestedCount(), 1);
+    CORRADE_COMPARE(intLoader->batches.size(), 2);
+    CORRADE_COMPARE(intLoader->batches[1], std::vector<ResourceKey>{"d"});
+    CORRADE_VERIFY(!batch.isFinished());
+    CORRADE_COMPARE(called, 0);
+
+    /* Not found resources finish the batch as well, the callback is called
+       just once */
+    intLoader->fail("d");
+    batch.update();
+    CORRADE_VERIFY(batch.isFinished());
+    CORRADE_COMPARE(batch.finishedCount(), 4);
+    CORRADE_COMPARE(batch.notFoundCount(), 1);
+    CORRADE_COMPARE(called, 1);
+    batch.update();
+    CORRADE_COMPARE(called, 1);
+
+    /* The batch keeps the resources referenced */
+    CORRADE_COMPARE(rm.referenceCount<Float>("c"), 1);
+    CORRADE_COMPARE(*rm.get<Float>("c"), 1.5f);
+}
+
+void ResourceLoadBatchTest::alreadyLoaded() {
+    ResourceManager rm;
+    IntResourceLoader* loader = new IntResourceLoader;
+    rm.setLoader(loader);
+    rm.set<Int>("a", 3);
+
+    ResourceLoadBatch batch;
+    batch.add<Int>(rm, "a");
+    batch.update();
+    CORRADE_VERIFY(batch.isFinished());
+    CORRADE_VERIFY(loader->batches.empty());
+}
+
+void ResourceLoadBatchTest::dependencyOutOfRange() {
+    ResourceManager rm;
+    ResourceLoadBatch batch;
+    batch.add<Int>(rm, "a");
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    batch.add<Int>(rm, "b", {0, 2});
+    CORRADE_COMPARE(out.str(), "ResourceLoadBatch::add(): dependency 2 out of range for 1 resources\n");
+}
+
+}}
+
+CORRADE_TEST_MAIN(Magnum::Test::ResourceLoadBatchTest)
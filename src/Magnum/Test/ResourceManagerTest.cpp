@@ -24,7 +24,11 @@
 */
 
 #include <sstream>
+#include <vector>
 #include <Corrade/TestSuite/Tester.h>
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include <thread>
+#endif
 
 #include "Magnum/AbstractResourceLoader.h"
 #include "Magnum/ResourceManager.h"
@@ -45,6 +49,13 @@ struct ResourceManagerTest: TestSuite::Tester {
     void clear();
     void clearWhileReferenced();
     void loader();
+    void budget();
+    void budgetLoader();
+    void selfAssignment();
+    void pin();
+    void pinChanged();
+    void concurrent();
+    void concurrentSet();
 
     void debugResourceState();
 };
@@ -72,6 +83,13 @@ ResourceManagerTest::ResourceManagerTest() {
               &ResourceManagerTest::clear,
               &ResourceManagerTest::clearWhileReferenced,
               &ResourceManagerTest::loader,
+              &ResourceManagerTest::budget,
+              &ResourceManagerTest::budgetLoader,
+              &ResourceManagerTest::selfAssignment,
+              &ResourceManagerTest::pin,
+              &ResourceManagerTest::pinChanged,
+              &ResourceManagerTest::concurrent,
+              &ResourceManagerTest::concurrentSet,
 
               &ResourceManagerTest::debugResourceState});
 }
@@ -333,6 +351,202 @@ void ResourceManagerTest::loader() {
     CORRADE_COMPARE(Data::count, 0);
 }
 
+void ResourceManagerTest::budget() {
+    ResourceManager rm;
+    CORRADE_COMPARE(rm.budget<Int>(), ~std::size_t{});
+
+    rm.setBudget<Int>(100);
+    rm.set("a", 1, ResourceDataState::Mutable, ResourcePolicy::Budgeted, 40);
+    rm.set("b", 2, ResourceDataState::Mutable, ResourcePolicy::Budgeted, 40);
+    CORRADE_COMPARE(rm.budget<Int>(), 100);
+    CORRADE_COMPARE(rm.budgetUsage<Int>(), 80);
+
+    /* Sizes of non-budgeted resources are ignored */
+    rm.set("resident", 3, ResourceDataState::Final, ResourcePolicy::Resident, 1000);
+    CORRADE_COMPARE(rm.budgetUsage<Int>(), 80);
+
+    /* Accessing "a" makes "b" the least recently used one */
+    Resource<Int> a = rm.get<Int>("a");
+    CORRADE_COMPARE(*a, 1);
+    rm.set("c", 4, ResourceDataState::Mutable, ResourcePolicy::Budgeted, 40);
+    CORRADE_COMPARE(rm.budgetUsage<Int>(), 80);
+    CORRADE_COMPARE(rm.count<Int>(), 3);
+    CORRADE_COMPARE(rm.state<Int>("a"), ResourceState::Mutable);
+    CORRADE_COMPARE(rm.state<Int>("b"), ResourceState::NotLoaded);
+    CORRADE_COMPARE(rm.state<Int>("c"), ResourceState::Mutable);
+
+    /* Lowering the budget evicts right away, referenced resources stay in
+       the manager without data */
+    rm.setBudget<Int>(50);
+    CORRADE_COMPARE(rm.budgetUsage<Int>(), 40);
+    CORRADE_COMPARE(rm.count<Int>(), 3);
+    CORRADE_COMPARE(a.state(), ResourceState::NotLoaded);
+    CORRADE_COMPARE(rm.state<Int>("c"), ResourceState::Mutable);
+
+    /* Freeing removes the usage as well */
+    rm.free();
+    CORRADE_COMPARE(rm.budgetUsage<Int>(), 0);
+    CORRADE_COMPARE(rm.count<Int>(), 2);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    rm.set("final", 5, ResourceDataState::Final, ResourcePolicy::Budgeted, 10);
+    CORRADE_COMPARE(out.str(), "ResourceManager::set(): budgeted resource " + ResourceKey("final").hexString() + " can't be final\n");
+}
+
+void ResourceManagerTest::budgetLoader() {
+    class BudgetedResourceLoader: public AbstractResourceLoader<Int> {
+        public:
+            std::vector<ResourceKey> evicted;
+
+        private:
+            void doLoad(ResourceKey key) override {
+                set(key, 100, ResourceDataState::Mutable, ResourcePolicy::Budgeted, 100);
+            }
+
+            /* Replace "a" with a smaller version instead of unloading it */
+            void doEvict(ResourceKey key) override {
+                evicted.push_back(key);
+                if(key == ResourceKey("a"))
+                    set(key, 10, ResourceDataState::Mutable, ResourcePolicy::Budgeted, 10);
+                else unload(key);
+            }
+    };
+
+    ResourceManager rm;
+    BudgetedResourceLoader* loader = new BudgetedResourceLoader;
+    rm.setLoader(loader);
+    rm.setBudget<Int>(150);
+
+    Resource<Int> a = rm.get<Int>("a");
+    Resource<Int> b = rm.get<Int>("b");
+
+    /* Accesses between two set() calls are equally old, so advance the
+       clock to make the access to "a" newer than loading of "b" */
+    rm.set("resident", 0);
+    CORRADE_COMPARE(*a, 10);
+    CORRADE_COMPARE(rm.budgetUsage<Int>(), 110);
+
+    /* "b" is now the least recently used one */
+    Resource<Int> c = rm.get<Int>("c");
+    CORRADE_COMPARE(*c, 100);
+    CORRADE_COMPARE(b.state(), ResourceState::NotLoaded);
+    CORRADE_COMPARE(rm.budgetUsage<Int>(), 110);
+    CORRADE_COMPARE(loader->evicted, (std::vector<ResourceKey>{"a", "b"}));
+
+    /* Evicted resource is requested from the loader again */
+    Resource<Int> b2 = rm.get<Int>("b");
+    CORRADE_COMPARE(*b, 100);
+    CORRADE_COMPARE(c.state(), ResourceState::NotLoaded);
+    CORRADE_COMPARE(loader->requestedCount(), 4);
+    CORRADE_COMPARE(loader->evicted, (std::vector<ResourceKey>{"a", "b", "a", "c"}));
+    CORRADE_COMPARE(rm.budgetUsage<Int>(), 110);
+}
+
+void ResourceManagerTest::pin() {
+    ResourceManager rm;
+    Resource<Int> empty;
+    CORRADE_VERIFY(!static_cast<Int*>(empty.pin()));
+
+    Resource<Int> answer = rm.get<Int>("answer");
+    CORRADE_VERIFY(!static_cast<Int*>(answer.pin()));
+
+    rm.set("answer", 42, ResourceDataState::Mutable, ResourcePolicy::Resident);
+    const PinnedResource<Int> pinned = answer.pin();
+    CORRADE_COMPARE(*pinned, 42);
+    CORRADE_COMPARE(pinned.operator->(), static_cast<Int*>(answer));
+
+    /* Fallback is pinned as well */
+    rm.setFallback<Int>(-1);
+    CORRADE_COMPARE(*rm.get<Int>("fallback").pin(), -1);
+}
+
+void ResourceManagerTest::pinChanged() {
+    ResourceManager rm;
+    Resource<Int> answer = rm.get<Int>("answer");
+    rm.set("answer", 42, ResourceDataState::Mutable, ResourcePolicy::Resident);
+    const PinnedResource<Int> pinned = answer.pin();
+
+    rm.set("answer", 43, ResourceDataState::Mutable, ResourcePolicy::Resident);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    static_cast<Int*>(pinned);
+    CORRADE_COMPARE(out.str(), "PinnedResource: resource " + ResourceKey("answer").hexString() + " changed since it was pinned\n");
+
+    /* Pinning again picks up the new data */
+    CORRADE_COMPARE(*answer.pin(), 43);
+}
+
+void ResourceManagerTest::selfAssignment() {
+    ResourceManager rm;
+    rm.set<Int>("int", new Int{5}, ResourceDataState::Final, ResourcePolicy::ReferenceCounted);
+
+    /* The only reference assigned to itself shouldn't free the data */
+    Resource<Int> a = rm.get<Int>("int");
+    Resource<Int>& ref = a;
+    a = ref;
+    CORRADE_COMPARE(rm.referenceCount<Int>("int"), 1);
+    CORRADE_COMPARE(*a, 5);
+}
+
+void ResourceManagerTest::concurrent() {
+    #ifdef CORRADE_TARGET_EMSCRIPTEN
+    CORRADE_SKIP("Threads are not supported on this platform.");
+    #else
+    ResourceManager rm;
+    rm.set<Int>("shared", 1337);
+    Resource<Int> shared = rm.get<Int>("shared");
+
+    /* Each thread sets its own resources, reads them back, and creates and
+       destroys references to a shared one */
+    std::vector<std::thread> threads;
+    std::vector<Int> failures(4);
+    for(Int t = 0; t != 4; ++t) threads.emplace_back([&rm, &failures, t]() {
+        for(Int i = 0; i != 250; ++i) {
+            const ResourceKey key{std::size_t(t*1000 + i)};
+            rm.set<Int>(key, new Int{i}, ResourceDataState::Final, ResourcePolicy::Manual);
+
+            Resource<Int> own = rm.get<Int>(key);
+            Resource<Int> shared = rm.get<Int>("shared");
+            Resource<Int> copy = shared;
+            if(*own != i || *copy != 1337) ++failures[t];
+        }
+    });
+    for(std::thread& thread: threads) thread.join();
+
+    CORRADE_COMPARE(failures, (std::vector<Int>{0, 0, 0, 0}));
+    CORRADE_COMPARE(rm.count<Int>(), 1001);
+    CORRADE_COMPARE(rm.referenceCount<Int>("shared"), 1);
+    CORRADE_COMPARE(*shared, 1337);
+
+    /* Nothing references the per-thread resources anymore */
+    rm.free<Int>();
+    CORRADE_COMPARE(rm.count<Int>(), 1);
+    #endif
+}
+
+void ResourceManagerTest::concurrentSet() {
+    #ifdef CORRADE_TARGET_EMSCRIPTEN
+    CORRADE_SKIP("Threads are not supported on this platform.");
+    #else
+    ResourceManager rm;
+    Resource<Int> streamed = rm.get<Int>("streamed");
+    CORRADE_COMPARE(streamed.state(), ResourceState::NotLoaded);
+
+    /* A worker thread streams the data in, the resource picks them up once
+       its generation changes */
+    std::thread worker{[&rm]() {
+        rm.set<Int>("streamed", nullptr, ResourceDataState::Loading, ResourcePolicy::Resident);
+        rm.set<Int>("streamed", new Int{42}, ResourceDataState::Final, ResourcePolicy::Resident);
+    }};
+    worker.join();
+
+    CORRADE_COMPARE(streamed.state(), ResourceState::Final);
+    CORRADE_COMPARE(*streamed, 42);
+    #endif
+}
+
 void ResourceManagerTest::debugResourceState() {
     std::ostringstream out;
     Debug{&out} << ResourceState::Loading << ResourceState(0xbe);
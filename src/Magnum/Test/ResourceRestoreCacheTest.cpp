@@ -0,0 +1,151 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/Directory.h>
+
+#include "Magnum/PixelFormat.h"
+#include "Magnum/ResourceRestoreCache.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Test {
+
+struct ResourceRestoreCacheTest: TestSuite::Tester {
+    explicit ResourceRestoreCacheTest();
+
+    void construct();
+
+    void data();
+    void dataNotFound();
+    void dataEmpty();
+    void dataOverwrite();
+    void dataAnotherInstance();
+
+    void image();
+    void imageNotFound();
+    void imageInvalid();
+};
+
+ResourceRestoreCacheTest::ResourceRestoreCacheTest() {
+    addTests({&ResourceRestoreCacheTest::construct,
+
+              &ResourceRestoreCacheTest::data,
+              &ResourceRestoreCacheTest::dataNotFound,
+              &ResourceRestoreCacheTest::dataEmpty,
+              &ResourceRestoreCacheTest::dataOverwrite,
+              &ResourceRestoreCacheTest::dataAnotherInstance,
+
+              &ResourceRestoreCacheTest::image,
+              &ResourceRestoreCacheTest::imageNotFound,
+              &ResourceRestoreCacheTest::imageInvalid});
+}
+
+namespace {
+    constexpr char Data[] = {'\x0a', '\x0b', '\x0c', '\x0d', '\x0e', '\x0f', '\x10', '\x11'};
+}
+
+void ResourceRestoreCacheTest::construct() {
+    ResourceRestoreCache cache{RESOURCERESTORECACHETEST_SAVE_DIR};
+    CORRADE_COMPARE(cache.directory(), RESOURCERESTORECACHETEST_SAVE_DIR);
+}
+
+void ResourceRestoreCacheTest::data() {
+    ResourceRestoreCache cache{RESOURCERESTORECACHETEST_SAVE_DIR};
+    CORRADE_VERIFY(cache.save("data", Data));
+    CORRADE_VERIFY(Utility::Directory::fileExists(Utility::Directory::join(RESOURCERESTORECACHETEST_SAVE_DIR, "data")));
+
+    const Containers::ArrayView<const char> data = cache.data("data");
+    CORRADE_COMPARE(std::string(data.data(), data.size()),
+        std::string(Data, sizeof(Data)));
+
+    /* Second access returns the same view */
+    CORRADE_COMPARE(cache.data("data").data(), data.data());
+}
+
+void ResourceRestoreCacheTest::dataNotFound() {
+    ResourceRestoreCache cache{RESOURCERESTORECACHETEST_SAVE_DIR};
+    CORRADE_VERIFY(cache.data("nonexistent").empty());
+}
+
+void ResourceRestoreCacheTest::dataEmpty() {
+    ResourceRestoreCache cache{RESOURCERESTORECACHETEST_SAVE_DIR};
+    CORRADE_VERIFY(!cache.save("empty", nullptr));
+    CORRADE_VERIFY(cache.data("empty").empty());
+}
+
+void ResourceRestoreCacheTest::dataOverwrite() {
+    ResourceRestoreCache cache{RESOURCERESTORECACHETEST_SAVE_DIR};
+    CORRADE_VERIFY(cache.save("overwrite", Data));
+    CORRADE_COMPARE(cache.data("overwrite").size(), 8);
+
+    /* The previous mapping is released and the new contents returned */
+    CORRADE_VERIFY(cache.save("overwrite", Containers::ArrayView<const char>{Data + 2, 3}));
+    const Containers::ArrayView<const char> data = cache.data("overwrite");
+    CORRADE_COMPARE(std::string(data.data(), data.size()), std::string(Data + 2, 3));
+}
+
+void ResourceRestoreCacheTest::dataAnotherInstance() {
+    {
+        ResourceRestoreCache cache{RESOURCERESTORECACHETEST_SAVE_DIR};
+        CORRADE_VERIFY(cache.save("persistent", Data));
+    }
+
+    /* Simulates an application restart */
+    ResourceRestoreCache cache{RESOURCERESTORECACHETEST_SAVE_DIR};
+    const Containers::ArrayView<const char> data = cache.data("persistent");
+    CORRADE_COMPARE(std::string(data.data(), data.size()),
+        std::string(Data, sizeof(Data)));
+}
+
+void ResourceRestoreCacheTest::image() {
+    ResourceRestoreCache cache{RESOURCERESTORECACHETEST_SAVE_DIR};
+    CORRADE_VERIFY(cache.saveImage("image", CompressedImageView2D{
+        CompressedPixelFormat::RGBAS3tcDxt1, {4, 8}, Data}));
+
+    Containers::Optional<CompressedImageView2D> image = cache.image("image");
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->format(), CompressedPixelFormat::RGBAS3tcDxt1);
+    CORRADE_COMPARE(image->size(), (Vector2i{4, 8}));
+    CORRADE_COMPARE(std::string(image->data(), image->data().size()),
+        std::string(Data, sizeof(Data)));
+}
+
+void ResourceRestoreCacheTest::imageNotFound() {
+    ResourceRestoreCache cache{RESOURCERESTORECACHETEST_SAVE_DIR};
+    CORRADE_VERIFY(!cache.image("nonexistent"));
+}
+
+void ResourceRestoreCacheTest::imageInvalid() {
+    ResourceRestoreCache cache{RESOURCERESTORECACHETEST_SAVE_DIR};
+
+    /* Too short to contain the header and some data */
+    CORRADE_VERIFY(cache.save("short", Data));
+    CORRADE_VERIFY(!cache.image("short"));
+}
+
+}}
+
+CORRADE_TEST_MAIN(Magnum::Test::ResourceRestoreCacheTest)
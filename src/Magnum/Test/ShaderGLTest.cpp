@@ -52,6 +52,7 @@ struct ShaderGLTest: OpenGLTester {
     void compile();
     void compileUtf8();
     void compileNoVersion();
+    void compileAsync();
 };
 
 ShaderGLTest::ShaderGLTest() {
@@ -69,7 +70,8 @@ ShaderGLTest::ShaderGLTest() {
               &ShaderGLTest::addFile,
               &ShaderGLTest::compile,
               &ShaderGLTest::compileUtf8,
-              &ShaderGLTest::compileNoVersion});
+              &ShaderGLTest::compileNoVersion,
+              &ShaderGLTest::compileAsync});
 }
 
 void ShaderGLTest::construct() {
@@ -305,6 +307,36 @@ void ShaderGLTest::compileNoVersion() {
     CORRADE_VERIFY(shader.compile());
 }
 
+void ShaderGLTest::compileAsync() {
+    #ifndef MAGNUM_TARGET_GLES
+    constexpr Version v =
+        #ifndef CORRADE_TARGET_APPLE
+        Version::GL210
+        #else
+        Version::GL310
+        #endif
+        ;
+    #else
+    constexpr Version v = Version::GLES200;
+    #endif
+
+    Shader shader(v, Shader::Type::Fragment);
+    shader.addSource("void main() {}\n");
+    Shader shader2(v, Shader::Type::Fragment);
+    shader2.addSource("[fu] bleh error #:! stuff\n");
+
+    Shader::submitCompile({shader, shader2});
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /* Without KHR_parallel_shader_compile it's always finished, with it it
+       eventually has to finish */
+    while(!shader.isCompileFinished() || !shader2.isCompileFinished()) {}
+
+    CORRADE_VERIFY(Shader::checkCompile({shader}));
+    CORRADE_VERIFY(!Shader::checkCompile({shader2}));
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
 }}
 
 CORRADE_TEST_MAIN(Magnum::Test::ShaderGLTest)
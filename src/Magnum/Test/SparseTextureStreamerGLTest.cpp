@@ -0,0 +1,222 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/OpenGLTester.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/SparseTextureStreamer.h"
+#include "Magnum/Texture.h"
+#include "Magnum/TextureArray.h"
+#include "Magnum/TextureFormat.h"
+#include "Magnum/TextureUploadQueue.h"
+
+namespace Magnum { namespace Test {
+
+struct SparseTextureStreamerGLTest: OpenGLTester {
+    explicit SparseTextureStreamerGLTest();
+
+    void construct();
+    void constructArray();
+
+    void request();
+    void requestEvict();
+    void requestNoRoom();
+};
+
+SparseTextureStreamerGLTest::SparseTextureStreamerGLTest() {
+    addTests({&SparseTextureStreamerGLTest::construct,
+              &SparseTextureStreamerGLTest::constructArray,
+
+              &SparseTextureStreamerGLTest::request,
+              &SparseTextureStreamerGLTest::requestEvict,
+              &SparseTextureStreamerGLTest::requestNoRoom});
+}
+
+namespace {
+    void decodePage(const SparseTextureStreamer::Page&, Containers::ArrayView<char> data) {
+        for(char& i: data) i = 0x7f;
+    }
+}
+
+#define SKIP_IF_UNSUPPORTED()                                               \
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::sparse_texture>()) \
+        CORRADE_SKIP(Extensions::GL::ARB::sparse_texture::string() + std::string(" is not supported.")); \
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::buffer_storage>()) \
+        CORRADE_SKIP(Extensions::GL::ARB::buffer_storage::string() + std::string(" is not supported.")); \
+    if(!Texture2D::sparsePageSizeCount(TextureFormat::RGBA8))               \
+        CORRADE_SKIP("RGBA8 can't be used for sparse textures.");
+
+void SparseTextureStreamerGLTest::construct() {
+    SKIP_IF_UNSUPPORTED()
+
+    /* Four pages in each direction, the third level is the mip tail */
+    const Vector2i pageSize = Texture2D::sparsePageSize(TextureFormat::RGBA8);
+    Texture2D texture;
+    texture.setSparse()
+        .setStorage(4, TextureFormat::RGBA8, pageSize*4);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    TextureUploadQueue queue{std::size_t(pageSize.product()*4)};
+    SparseTextureStreamer streamer{texture, queue, pageSize*4, 4, pageSize, PixelFormat::RGBA, PixelType::UnsignedByte, 16, decodePage};
+    MAGNUM_VERIFY_NO_ERROR();
+
+    CORRADE_COMPARE(streamer.pageSize(), pageSize);
+    CORRADE_COMPARE(streamer.tailLevel(), 3);
+    CORRADE_COMPARE(streamer.maxResidentPages(), 16);
+    CORRADE_COMPARE(streamer.residentPageCount(), 0);
+    CORRADE_COMPARE(streamer.pendingPageCount(), 0);
+    CORRADE_VERIFY(!streamer.isResident({{}, 3, 0}));
+
+    /* The mip tail gets resident after the uploads complete */
+    streamer.update(queue.finish());
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(streamer.isResident({{}, 3, 0}));
+    CORRADE_VERIFY(!streamer.isResident({{}, 0, 0}));
+
+    const ImageView2D table = streamer.minLevelTable();
+    CORRADE_COMPARE(table.size(), Vector2i{4});
+    CORRADE_COMPARE(table.format(), PixelFormat::RedInteger);
+    for(char i: table.data()) CORRADE_COMPARE(Int(i), 3);
+}
+
+void SparseTextureStreamerGLTest::constructArray() {
+    SKIP_IF_UNSUPPORTED()
+
+    const Vector2i pageSize = Texture2DArray::sparsePageSize(TextureFormat::RGBA8).xy();
+    Texture2DArray texture;
+    texture.setSparse()
+        .setStorage(2, TextureFormat::RGBA8, {pageSize*2, 3});
+    MAGNUM_VERIFY_NO_ERROR();
+
+    TextureUploadQueue queue{std::size_t(pageSize.product()*4)};
+    SparseTextureStreamer streamer{texture, queue, {pageSize*2, 3}, 2, pageSize, PixelFormat::RGBA, PixelType::UnsignedByte, 16, decodePage};
+    streamer.update(queue.finish());
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /* Second level is exactly one page, so there's no mip tail */
+    CORRADE_COMPARE(streamer.tailLevel(), 2);
+
+    streamer.request({{{1, 0}, 0, 2}});
+    CORRADE_COMPARE(streamer.pendingPageCount(), 2);
+    streamer.update(queue.finish());
+    MAGNUM_VERIFY_NO_ERROR();
+
+    CORRADE_VERIFY(streamer.isResident({{1, 0}, 0, 2}));
+    CORRADE_VERIFY(streamer.isResident({{0, 0}, 1, 2}));
+    CORRADE_VERIFY(!streamer.isResident({{1, 0}, 0, 1}));
+    CORRADE_COMPARE(Int(streamer.minLevelTable(2).data()[1]), 0);
+    CORRADE_COMPARE(Int(streamer.minLevelTable(2).data()[0]), 1);
+    CORRADE_COMPARE(Int(streamer.minLevelTable(1).data()[1]), 2);
+}
+
+void SparseTextureStreamerGLTest::request() {
+    SKIP_IF_UNSUPPORTED()
+
+    const Vector2i pageSize = Texture2D::sparsePageSize(TextureFormat::RGBA8);
+    Texture2D texture;
+    texture.setSparse()
+        .setStorage(4, TextureFormat::RGBA8, pageSize*4);
+
+    TextureUploadQueue queue{std::size_t(pageSize.product()*4)};
+    SparseTextureStreamer streamer{texture, queue, pageSize*4, 4, pageSize, PixelFormat::RGBA, PixelType::UnsignedByte, 16, decodePage};
+    streamer.update(queue.finish());
+
+    /* Requesting a page requests also its coarser levels, requesting the
+       same page again does nothing */
+    streamer.request({{{3, 2}, 0, 0}, {{3, 2}, 0, 0}});
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(streamer.pendingPageCount(), 3);
+    CORRADE_COMPARE(streamer.residentPageCount(), 0);
+
+    streamer.update(queue.finish());
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(streamer.pendingPageCount(), 0);
+    CORRADE_COMPARE(streamer.residentPageCount(), 3);
+    CORRADE_VERIFY(streamer.isResident({{3, 2}, 0, 0}));
+    CORRADE_VERIFY(streamer.isResident({{1, 1}, 1, 0}));
+    CORRADE_VERIFY(streamer.isResident({{0, 0}, 2, 0}));
+
+    /* The requested page has level 0 resident, its neighbor shares the second
+       level, the rest only the third one */
+    const ImageView2D table = streamer.minLevelTable();
+    CORRADE_COMPARE(Int(table.data()[2*4 + 3]), 0);
+    CORRADE_COMPARE(Int(table.data()[2*4 + 2]), 1);
+    CORRADE_COMPARE(Int(table.data()[0]), 2);
+}
+
+void SparseTextureStreamerGLTest::requestEvict() {
+    SKIP_IF_UNSUPPORTED()
+
+    const Vector2i pageSize = Texture2D::sparsePageSize(TextureFormat::RGBA8);
+    Texture2D texture;
+    texture.setSparse()
+        .setStorage(4, TextureFormat::RGBA8, pageSize*4);
+
+    TextureUploadQueue queue{std::size_t(pageSize.product()*4)};
+    SparseTextureStreamer streamer{texture, queue, pageSize*4, 4, pageSize, PixelFormat::RGBA, PixelType::UnsignedByte, 4, decodePage};
+    streamer.update(queue.finish());
+
+    streamer.request({{{0, 0}, 0, 0}, {{1, 0}, 0, 0}});
+    streamer.update(queue.finish());
+    CORRADE_COMPARE(streamer.residentPageCount(), 4);
+
+    /* The least recently used page gets evicted in the next frame */
+    streamer.request({{{0, 0}, 0, 0}, {{0, 1}, 0, 0}});
+    streamer.update(queue.finish());
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(streamer.residentPageCount(), 4);
+    CORRADE_VERIFY(streamer.isResident({{0, 1}, 0, 0}));
+    CORRADE_VERIFY(!streamer.isResident({{1, 0}, 0, 0}));
+    CORRADE_COMPARE(Int(streamer.minLevelTable().data()[1]), 1);
+}
+
+void SparseTextureStreamerGLTest::requestNoRoom() {
+    SKIP_IF_UNSUPPORTED()
+
+    const Vector2i pageSize = Texture2D::sparsePageSize(TextureFormat::RGBA8);
+    Texture2D texture;
+    texture.setSparse()
+        .setStorage(4, TextureFormat::RGBA8, pageSize*4);
+
+    TextureUploadQueue queue{std::size_t(pageSize.product()*4)};
+    SparseTextureStreamer streamer{texture, queue, pageSize*4, 4, pageSize, PixelFormat::RGBA, PixelType::UnsignedByte, 2, decodePage};
+    streamer.update(queue.finish());
+
+    /* Only the coarser levels fit, pages used in the current frame are not
+       evicted */
+    streamer.request({{{0, 0}, 0, 0}});
+    streamer.update(queue.finish());
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(streamer.residentPageCount(), 2);
+    CORRADE_VERIFY(streamer.isResident({{0, 0}, 1, 0}));
+    CORRADE_VERIFY(!streamer.isResident({{0, 0}, 0, 0}));
+}
+
+}}
+
+CORRADE_TEST_MAIN(Magnum::Test::SparseTextureStreamerGLTest)
@@ -0,0 +1,108 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Std140.h"
+#include "Magnum/Math/Matrix3.h"
+
+namespace Magnum { namespace Test {
+
+struct Std140Test: TestSuite::Tester {
+    explicit Std140Test();
+
+    void vector3();
+    void matrix3();
+    void layout();
+    void alignedStride();
+};
+
+Std140Test::Std140Test() {
+    addTests({&Std140Test::vector3,
+              &Std140Test::matrix3,
+              &Std140Test::layout,
+              &Std140Test::alignedStride});
+}
+
+void Std140Test::vector3() {
+    constexpr Std140::Vector3 a = Vector3{1.0f, 2.0f, 3.0f};
+    constexpr Vector3 b = a;
+    CORRADE_COMPARE(b, (Vector3{1.0f, 2.0f, 3.0f}));
+
+    CORRADE_COMPARE(sizeof(Std140::Vector3), 16);
+    CORRADE_COMPARE(alignof(Std140::Vector3), 16);
+
+    /* Padding is zero-initialized */
+    CORRADE_COMPARE(reinterpret_cast<const Float*>(&a)[3], 0.0f);
+
+    Std140::Vector3 c;
+    c.value().y() = 5.0f;
+    CORRADE_COMPARE(Vector3{c}, (Vector3{0.0f, 5.0f, 0.0f}));
+}
+
+void Std140Test::matrix3() {
+    const Matrix3 m = Matrix3::rotation(Deg(35.0f))*Matrix3::translation({1.0f, -2.0f});
+    const Std140::Matrix3 a = m;
+    CORRADE_COMPARE(Matrix3{a}, m);
+
+    CORRADE_COMPARE(sizeof(Std140::Matrix3), 48);
+    CORRADE_COMPARE(alignof(Std140::Matrix3), 16);
+
+    /* Columns are padded to four components */
+    const Float* data = reinterpret_cast<const Float*>(&a);
+    CORRADE_COMPARE(data[4], m[1][0]);
+    CORRADE_COMPARE(data[8], m[2][0]);
+    CORRADE_COMPARE(data[10], m[2][2]);
+    CORRADE_COMPARE(data[11], 0.0f);
+    CORRADE_COMPARE(a[2].xyz(), m[2]);
+}
+
+void Std140Test::layout() {
+    /* A vec3 after a float gets aligned to 16 bytes, same as in GLSL */
+    struct Block {
+        Float a;
+        Std140::Vector3 b;
+        Std140::Matrix3 c;
+        Vector4 d;
+    };
+
+    CORRADE_COMPARE(offsetof(Block, b), 16);
+    CORRADE_COMPARE(offsetof(Block, c), 32);
+    CORRADE_COMPARE(offsetof(Block, d), 80);
+    CORRADE_COMPARE(sizeof(Block), 96);
+}
+
+void Std140Test::alignedStride() {
+    constexpr std::size_t a = Std140::alignedStride(80, 256);
+    CORRADE_COMPARE(a, 256);
+    CORRADE_COMPARE(Std140::alignedStride(256, 256), 256);
+    CORRADE_COMPARE(Std140::alignedStride(257, 256), 512);
+    CORRADE_COMPARE(Std140::alignedStride(80, 16), 80);
+    CORRADE_COMPARE(Std140::alignedStride(0, 16), 0);
+}
+
+}}
+
+CORRADE_TEST_MAIN(Magnum::Test::Std140Test)
@@ -0,0 +1,139 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/OpenGLTester.h"
+#include "Magnum/StreamingBuffer.h"
+
+namespace Magnum { namespace Test {
+
+struct StreamingBufferGLTest: OpenGLTester {
+    explicit StreamingBufferGLTest();
+
+    void construct();
+    void allocate();
+    void allocateAligned();
+    void nextFrame();
+};
+
+StreamingBufferGLTest::StreamingBufferGLTest() {
+    addTests({&StreamingBufferGLTest::construct,
+              &StreamingBufferGLTest::allocate,
+              &StreamingBufferGLTest::allocateAligned,
+              &StreamingBufferGLTest::nextFrame});
+}
+
+void StreamingBufferGLTest::construct() {
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::buffer_storage>())
+        CORRADE_SKIP(Extensions::GL::ARB::buffer_storage::string() + std::string(" is not supported"));
+
+    StreamingBuffer buffer{64};
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(buffer.regionSize(), 64);
+    CORRADE_COMPARE(buffer.regionCount(), 3);
+    CORRADE_COMPARE(buffer.currentRegion(), 0);
+    CORRADE_COMPARE(buffer.available(), 64);
+    CORRADE_COMPARE(buffer.buffer().size(), 3*64);
+}
+
+void StreamingBufferGLTest::allocate() {
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::buffer_storage>())
+        CORRADE_SKIP(Extensions::GL::ARB::buffer_storage::string() + std::string(" is not supported"));
+
+    StreamingBuffer buffer{16, 2};
+
+    std::pair<Containers::ArrayView<char>, GLintptr> a = buffer.allocate(10);
+    CORRADE_COMPARE(a.first.size(), 10);
+    CORRADE_COMPARE(a.second, 0);
+    CORRADE_COMPARE(buffer.available(), 6);
+
+    /* Not enough space left */
+    std::pair<Containers::ArrayView<char>, GLintptr> b = buffer.allocate(7);
+    CORRADE_VERIFY(!b.first);
+    CORRADE_COMPARE(b.second, -1);
+    CORRADE_COMPARE(buffer.available(), 6);
+
+    std::pair<Containers::ArrayView<char>, GLintptr> c = buffer.allocate(6);
+    CORRADE_COMPARE(c.first.size(), 6);
+    CORRADE_COMPARE(c.second, 10);
+    CORRADE_COMPARE(buffer.available(), 0);
+
+    /* Written data are visible to the GL */
+    for(std::size_t i = 0; i != 10; ++i) a.first[i] = char(i);
+    for(std::size_t i = 0; i != 6; ++i) c.first[i] = char(10 + i);
+    buffer.nextFrame();
+    MAGNUM_VERIFY_NO_ERROR();
+
+    Buffer copy;
+    copy.setData({nullptr, 16}, BufferUsage::StaticCopy);
+    Buffer::copy(buffer.buffer(), copy, 0, 0, 16);
+    constexpr char expected[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+    CORRADE_COMPARE_AS(copy.data(),
+        Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+}
+
+void StreamingBufferGLTest::allocateAligned() {
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::buffer_storage>())
+        CORRADE_SKIP(Extensions::GL::ARB::buffer_storage::string() + std::string(" is not supported"));
+
+    /* Region size not a multiple of the alignment */
+    StreamingBuffer buffer{20};
+
+    CORRADE_COMPARE(buffer.allocate(3).second, 0);
+    CORRADE_COMPARE(buffer.allocate(4, 8).second, 8);
+    CORRADE_COMPARE(buffer.available(), 8);
+
+    /* The second region starts at 20, the first aligned offset is 24 */
+    buffer.nextFrame();
+    CORRADE_COMPARE(buffer.allocate(4, 8).second, 24);
+    CORRADE_COMPARE(buffer.allocate(12, 8).second, -1);
+    CORRADE_COMPARE(buffer.allocate(12).second, 28);
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void StreamingBufferGLTest::nextFrame() {
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::buffer_storage>())
+        CORRADE_SKIP(Extensions::GL::ARB::buffer_storage::string() + std::string(" is not supported"));
+
+    StreamingBuffer buffer{16};
+    for(UnsignedInt i = 0; i != 7; ++i) {
+        CORRADE_COMPARE(buffer.currentRegion(), i % 3);
+        CORRADE_COMPARE(buffer.allocate(16).second, GLintptr((i % 3)*16));
+        buffer.nextFrame();
+        MAGNUM_VERIFY_NO_ERROR();
+    }
+
+    CORRADE_COMPARE(buffer.currentRegion(), 1);
+    CORRADE_COMPARE(buffer.available(), 16);
+}
+
+}}
+
+CORRADE_TEST_MAIN(Magnum::Test::StreamingBufferGLTest)
@@ -0,0 +1,149 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/Context.h"
+#include "Magnum/OpenGLTester.h"
+#include "Magnum/Texture.h"
+#include "Magnum/TextureBindingSet.h"
+
+namespace Magnum { namespace Test {
+
+struct TextureBindingSetGLTest: OpenGLTester {
+    explicit TextureBindingSetGLTest();
+
+    void construct();
+    void constructTextures();
+    void setTexture();
+
+    void bind();
+    void bindUnbind();
+    #ifdef MAGNUM_BUILD_STATISTICS
+    void bindOnlyDifferent();
+    #endif
+};
+
+TextureBindingSetGLTest::TextureBindingSetGLTest() {
+    addTests({&TextureBindingSetGLTest::construct,
+              &TextureBindingSetGLTest::constructTextures,
+              &TextureBindingSetGLTest::setTexture,
+
+              &TextureBindingSetGLTest::bind,
+              &TextureBindingSetGLTest::bindUnbind,
+              #ifdef MAGNUM_BUILD_STATISTICS
+              &TextureBindingSetGLTest::bindOnlyDifferent
+              #endif
+              });
+}
+
+void TextureBindingSetGLTest::construct() {
+    TextureBindingSet set{3};
+    CORRADE_COMPARE(set.firstTextureUnit(), 3);
+    CORRADE_COMPARE(set.size(), 0);
+
+    /* Binding an empty set does nothing */
+    set.bind();
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void TextureBindingSetGLTest::constructTextures() {
+    Texture2D a, b;
+    TextureBindingSet set{1, {&a, nullptr, &b}};
+    CORRADE_COMPARE(set.firstTextureUnit(), 1);
+    CORRADE_COMPARE(set.size(), 3);
+    CORRADE_VERIFY(set.textures()[0] == &a);
+    CORRADE_VERIFY(set.textures()[1] == nullptr);
+    CORRADE_VERIFY(set.textures()[2] == &b);
+}
+
+void TextureBindingSetGLTest::setTexture() {
+    Texture2D a, b;
+    TextureBindingSet set{2};
+    set.setTexture(4, &a);
+    CORRADE_COMPARE(set.size(), 3);
+    CORRADE_VERIFY(set.textures()[0] == nullptr);
+    CORRADE_VERIFY(set.textures()[1] == nullptr);
+    CORRADE_VERIFY(set.textures()[2] == &a);
+
+    set.setTexture(2, &b)
+       .setTexture(4, nullptr);
+    CORRADE_COMPARE(set.size(), 3);
+    CORRADE_VERIFY(set.textures()[0] == &b);
+    CORRADE_VERIFY(set.textures()[2] == nullptr);
+}
+
+void TextureBindingSetGLTest::bind() {
+    Texture2D a, b, c;
+    TextureBindingSet first{0, {&a, &b}};
+    TextureBindingSet second{0, {&a, &c, &b}};
+
+    first.bind();
+    second.bind();
+    first.bind();
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void TextureBindingSetGLTest::bindUnbind() {
+    Texture2D a, b;
+    TextureBindingSet set{0, {&a, &b}};
+    set.bind();
+
+    set.setTexture(0, nullptr);
+    set.bind();
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+#ifdef MAGNUM_BUILD_STATISTICS
+void TextureBindingSetGLTest::bindOnlyDifferent() {
+    Texture2D a, b, c, d;
+    TextureBindingSet first{0, {&a, &b, &c}};
+    TextureBindingSet second{0, {&a, &d, &c}};
+
+    first.bind();
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /* Binding the same set again does nothing */
+    Context::current().resetStatistics();
+    first.bind();
+    CORRADE_COMPARE(Context::current().statistics().textureBindCount, 0);
+
+    /* Only the middle unit is different */
+    second.bind();
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(Context::current().statistics().textureBindCount, 1);
+
+    /* Texture bound individually is taken into account as well */
+    Context::current().resetStatistics();
+    b.bind(1);
+    first.bind();
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(Context::current().statistics().textureBindCount, 1);
+}
+#endif
+
+}}
+
+CORRADE_TEST_MAIN(Magnum::Test::TextureBindingSetGLTest)
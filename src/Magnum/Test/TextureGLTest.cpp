@@ -78,6 +78,11 @@ struct TextureGLTest: OpenGLTester {
     void bindImage3D();
     #endif
 
+    #ifndef MAGNUM_TARGET_GLES
+    void bindlessHandle2D();
+    void bindlessHandleMove();
+    #endif
+
     #ifndef MAGNUM_TARGET_GLES
     void sampling1D();
     #endif
@@ -451,6 +456,11 @@ TextureGLTest::TextureGLTest() {
         &TextureGLTest::bindImage3D,
         #endif
 
+        #ifndef MAGNUM_TARGET_GLES
+        &TextureGLTest::bindlessHandle2D,
+        &TextureGLTest::bindlessHandleMove,
+        #endif
+
         #ifndef MAGNUM_TARGET_GLES
         &TextureGLTest::sampling1D,
         #endif
@@ -868,6 +878,71 @@ void TextureGLTest::bindImage3D() {
 }
 #endif
 
+#ifndef MAGNUM_TARGET_GLES
+void TextureGLTest::bindlessHandle2D() {
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::bindless_texture>())
+        CORRADE_SKIP(Extensions::GL::ARB::bindless_texture::string() + std::string(" is not supported."));
+
+    Texture2D texture;
+    texture.setStorage(1, TextureFormat::RGBA8, Vector2i{32});
+
+    const GLuint64 handle = texture.handle();
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(handle);
+    /* The handle is cached */
+    CORRADE_COMPARE(texture.handle(), handle);
+    CORRADE_VERIFY(!texture.isResident());
+
+    texture.makeResident();
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(texture.isResident());
+    CORRADE_VERIFY(glIsTextureHandleResidentARB(handle));
+
+    /* Making resident twice is not an error */
+    texture.makeResident();
+    MAGNUM_VERIFY_NO_ERROR();
+
+    texture.makeNonResident();
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(!texture.isResident());
+    CORRADE_VERIFY(!glIsTextureHandleResidentARB(handle));
+
+    texture.makeNonResident();
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /* Texture is destroyed with resident handle */
+    texture.makeResident();
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void TextureGLTest::bindlessHandleMove() {
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::bindless_texture>())
+        CORRADE_SKIP(Extensions::GL::ARB::bindless_texture::string() + std::string(" is not supported."));
+
+    Texture2D a, b;
+    a.setStorage(1, TextureFormat::RGBA8, Vector2i{32});
+    b.setStorage(1, TextureFormat::RGBA8, Vector2i{16});
+    AbstractTexture::makeResident({&a, nullptr, &b});
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(a.isResident());
+    CORRADE_VERIFY(b.isResident());
+
+    const GLuint64 handle = a.handle();
+    Texture2D c{std::move(a)};
+    CORRADE_VERIFY(!a.isResident());
+    CORRADE_VERIFY(c.isResident());
+    CORRADE_COMPARE(c.handle(), handle);
+
+    /* Move assignment swaps the residency state as well */
+    a = std::move(b);
+    CORRADE_VERIFY(a.isResident());
+    CORRADE_VERIFY(!b.isResident());
+
+    c.makeNonResident();
+    MAGNUM_VERIFY_NO_ERROR();
+}
+#endif
+
 #ifndef MAGNUM_TARGET_GLES
 void TextureGLTest::sampling1D() {
     Texture1D texture;
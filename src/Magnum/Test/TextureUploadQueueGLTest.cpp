@@ -0,0 +1,217 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/Image.h"
+#include "Magnum/OpenGLTester.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Texture.h"
+#include "Magnum/TextureArray.h"
+#include "Magnum/TextureFormat.h"
+#include "Magnum/TextureUploadQueue.h"
+
+namespace Magnum { namespace Test {
+
+struct TextureUploadQueueGLTest: OpenGLTester {
+    explicit TextureUploadQueueGLTest();
+
+    void construct();
+
+    void upload();
+    void uploadArray();
+    void uploadMoreThanSlots();
+    void uploadPixelStorage();
+};
+
+TextureUploadQueueGLTest::TextureUploadQueueGLTest() {
+    addTests({&TextureUploadQueueGLTest::construct,
+
+              &TextureUploadQueueGLTest::upload,
+              &TextureUploadQueueGLTest::uploadArray,
+              &TextureUploadQueueGLTest::uploadMoreThanSlots,
+              &TextureUploadQueueGLTest::uploadPixelStorage});
+}
+
+void TextureUploadQueueGLTest::construct() {
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::buffer_storage>())
+        CORRADE_SKIP(Extensions::GL::ARB::buffer_storage::string() + std::string(" is not supported."));
+
+    {
+        TextureUploadQueue queue{1024, 3, 2};
+        MAGNUM_VERIFY_NO_ERROR();
+        CORRADE_COMPARE(queue.slotSize(), 1024);
+        CORRADE_COMPARE(queue.slotCount(), 3);
+        CORRADE_COMPARE(queue.threadCount(), 2);
+        CORRADE_COMPARE(queue.pendingCount(), 0);
+        CORRADE_VERIFY(queue.update().empty());
+    }
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void TextureUploadQueueGLTest::upload() {
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::buffer_storage>())
+        CORRADE_SKIP(Extensions::GL::ARB::buffer_storage::string() + std::string(" is not supported."));
+
+    Texture2D texture;
+    texture.setStorage(1, TextureFormat::RGBA8, Vector2i{4});
+
+    /* The decoder runs on a worker thread, so no test macros there */
+    TextureUploadQueue queue{64};
+    std::size_t decodedSize{};
+    const UnsignedInt id = queue.enqueue(texture, 0, {2, 2},
+        PixelFormat::RGBA, PixelType::UnsignedByte, Vector2i{2},
+        [&decodedSize](Containers::ArrayView<char> data) {
+            decodedSize = data.size();
+            for(std::size_t i = 0; i != data.size(); ++i) data[i] = i;
+        });
+    CORRADE_COMPARE(queue.pendingCount(), 1);
+
+    const std::vector<UnsignedInt> completed = queue.finish();
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(completed, std::vector<UnsignedInt>{id});
+    CORRADE_COMPARE(queue.pendingCount(), 0);
+    CORRADE_COMPARE(decodedSize, 16);
+
+    Image2D image = texture.image(0, {PixelFormat::RGBA, PixelType::UnsignedByte});
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /* Last two pixels of the third and fourth row */
+    const auto pixels = Containers::arrayCast<UnsignedByte>(image.data());
+    constexpr UnsignedByte expected[]{
+        0, 1, 2, 3, 4, 5, 6, 7,
+        8, 9, 10, 11, 12, 13, 14, 15
+    };
+    CORRADE_COMPARE_AS(pixels.slice(40, 48), Containers::arrayView(expected).prefix(8),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(pixels.slice(56, 64), Containers::arrayView(expected).suffix(8),
+        TestSuite::Compare::Container);
+}
+
+void TextureUploadQueueGLTest::uploadArray() {
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::buffer_storage>())
+        CORRADE_SKIP(Extensions::GL::ARB::buffer_storage::string() + std::string(" is not supported."));
+
+    Texture2DArray texture;
+    texture.setStorage(1, TextureFormat::R8, {2, 2, 3});
+
+    TextureUploadQueue queue{64};
+    queue.enqueue(texture, 0, {0, 0, 1},
+        PixelStorage{}.setAlignment(1), PixelFormat::Red, PixelType::UnsignedByte, Vector2i{2},
+        [](Containers::ArrayView<char> data) {
+            std::fill(data.begin(), data.end(), 0x5a);
+        });
+    queue.finish();
+    MAGNUM_VERIFY_NO_ERROR();
+
+    Image3D image = texture.image(0, {PixelStorage{}.setAlignment(1), PixelFormat::Red, PixelType::UnsignedByte});
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /* Only the second layer is filled */
+    const auto pixels = Containers::arrayCast<UnsignedByte>(image.data());
+    CORRADE_COMPARE(pixels.size(), 12);
+    CORRADE_COMPARE(pixels[3], 0);
+    CORRADE_COMPARE(pixels[4], 0x5a);
+    CORRADE_COMPARE(pixels[7], 0x5a);
+    CORRADE_COMPARE(pixels[8], 0);
+}
+
+void TextureUploadQueueGLTest::uploadMoreThanSlots() {
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::buffer_storage>())
+        CORRADE_SKIP(Extensions::GL::ARB::buffer_storage::string() + std::string(" is not supported."));
+
+    Texture2D texture;
+    texture.setStorage(1, TextureFormat::RGBA8, {8, 1});
+
+    /* Eight uploads with just two slots, the rest waits in the queue */
+    TextureUploadQueue queue{4, 2, 2};
+    std::atomic<Int> decodedCount{0};
+    std::vector<UnsignedInt> ids;
+    for(Int i = 0; i != 8; ++i) ids.push_back(queue.enqueue(texture, 0, {i, 0},
+        PixelFormat::RGBA, PixelType::UnsignedByte, Vector2i{1},
+        [i, &decodedCount](Containers::ArrayView<char> data) {
+            std::fill(data.begin(), data.end(), char(i*10));
+            ++decodedCount;
+        }));
+    CORRADE_COMPARE(queue.pendingCount(), 8);
+
+    /* Poll until everything is done, as an application would do */
+    std::vector<UnsignedInt> completed;
+    while(queue.pendingCount()) {
+        const std::vector<UnsignedInt> current = queue.update();
+        completed.insert(completed.end(), current.begin(), current.end());
+        glFlush();
+    }
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(decodedCount, 8);
+
+    std::sort(completed.begin(), completed.end());
+    CORRADE_COMPARE(completed, ids);
+
+    Image2D image = texture.image(0, {PixelFormat::RGBA, PixelType::UnsignedByte});
+    MAGNUM_VERIFY_NO_ERROR();
+
+    const auto pixels = Containers::arrayCast<UnsignedByte>(image.data());
+    for(Int i = 0; i != 8; ++i) {
+        CORRADE_COMPARE(pixels[i*4], i*10);
+        CORRADE_COMPARE(pixels[i*4 + 3], i*10);
+    }
+}
+
+void TextureUploadQueueGLTest::uploadPixelStorage() {
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::buffer_storage>())
+        CORRADE_SKIP(Extensions::GL::ARB::buffer_storage::string() + std::string(" is not supported."));
+
+    Texture2D texture;
+    texture.setStorage(1, TextureFormat::RGBA8, Vector2i{1});
+
+    /* Skipping one pixel, so the decoder gets a two-pixel view */
+    TextureUploadQueue queue{64};
+    std::size_t decodedSize{};
+    queue.enqueue(texture, 0, {},
+        PixelStorage{}.setSkip({1, 0, 0}), PixelFormat::RGBA, PixelType::UnsignedByte, Vector2i{1},
+        [&decodedSize](Containers::ArrayView<char> data) {
+            decodedSize = data.size();
+            std::fill(data.begin(), data.begin() + 4, char(0x11));
+            std::fill(data.begin() + 4, data.end(), char(0x77));
+        });
+    queue.finish();
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(decodedSize, 8);
+
+    Image2D image = texture.image(0, {PixelFormat::RGBA, PixelType::UnsignedByte});
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(Containers::arrayCast<UnsignedByte>(image.data())[0], 0x77);
+}
+
+}}
+
+CORRADE_TEST_MAIN(Magnum::Test::TextureUploadQueueGLTest)
@@ -0,0 +1,174 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <atomic>
+#include <vector>
+#include <Corrade/TestSuite/Tester.h>
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include <thread>
+#endif
+
+#include "Magnum/ThreadPool.h"
+
+namespace Magnum { namespace Test {
+
+struct ThreadPoolTest: Corrade::TestSuite::Tester {
+    explicit ThreadPoolTest();
+
+    void construct();
+    void constructSingleThread();
+
+    void parallelFor();
+    void parallelForStatic();
+    void parallelForSingleThread();
+    void parallelForSingleChunk();
+    void parallelForEmpty();
+    void parallelForRepeated();
+};
+
+ThreadPoolTest::ThreadPoolTest() {
+    addTests({&ThreadPoolTest::construct,
+              &ThreadPoolTest::constructSingleThread,
+
+              &ThreadPoolTest::parallelFor,
+              &ThreadPoolTest::parallelForStatic,
+              &ThreadPoolTest::parallelForSingleThread,
+              &ThreadPoolTest::parallelForSingleChunk,
+              &ThreadPoolTest::parallelForEmpty,
+              &ThreadPoolTest::parallelForRepeated});
+}
+
+void ThreadPoolTest::construct() {
+    ThreadPool pool{4};
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    CORRADE_COMPARE(pool.threadCount(), 4);
+    #else
+    CORRADE_COMPARE(pool.threadCount(), 1);
+    #endif
+
+    ThreadPool defaultPool;
+    CORRADE_VERIFY(defaultPool.threadCount() >= 1);
+}
+
+void ThreadPoolTest::constructSingleThread() {
+    ThreadPool pool{1};
+    CORRADE_COMPARE(pool.threadCount(), 1);
+}
+
+void ThreadPoolTest::parallelFor() {
+    ThreadPool pool{4};
+
+    /* Each item has to be processed exactly once */
+    std::vector<Int> processed(1000);
+    pool.parallelFor(processed.size(), 7, [&processed](std::size_t begin, std::size_t end) {
+        for(std::size_t i = begin; i != end; ++i) ++processed[i];
+    });
+
+    for(std::size_t i = 0; i != processed.size(); ++i) {
+        CORRADE_COMPARE(processed[i], 1);
+        if(processed[i] != 1) break;
+    }
+}
+
+void ThreadPoolTest::parallelForStatic() {
+    #ifdef CORRADE_TARGET_EMSCRIPTEN
+    CORRADE_SKIP("Threads are not supported on this platform.");
+    #else
+    ThreadPool pool{3};
+
+    /* Record which thread processed which chunk, the assignment has to be the
+       same every time */
+    auto run = [&pool]() {
+        std::vector<std::thread::id> ids(30);
+        pool.parallelFor(ids.size()*10, 10, [&ids](std::size_t begin, std::size_t) {
+            ids[begin/10] = std::this_thread::get_id();
+        }, ThreadPool::Schedule::Static);
+        return ids;
+    };
+
+    const std::vector<std::thread::id> first = run();
+    const std::vector<std::thread::id> second = run();
+    CORRADE_VERIFY(first == second);
+
+    /* Round-robin, chunks of the calling thread go first */
+    for(std::size_t i = 0; i != first.size(); ++i) {
+        CORRADE_VERIFY(first[i] == first[i%3]);
+        if(i%3 == 0) CORRADE_VERIFY(first[i] == std::this_thread::get_id());
+        else CORRADE_VERIFY(first[i] != std::this_thread::get_id());
+    }
+    #endif
+}
+
+void ThreadPoolTest::parallelForSingleThread() {
+    ThreadPool pool{1};
+
+    /* Processed serially in order on the calling thread */
+    std::vector<std::size_t> begins;
+    pool.parallelFor(10, 3, [&begins](std::size_t begin, std::size_t) {
+        begins.push_back(begin);
+    });
+    CORRADE_VERIFY(begins == (std::vector<std::size_t>{0, 3, 6, 9}));
+}
+
+void ThreadPoolTest::parallelForSingleChunk() {
+    ThreadPool pool{4};
+
+    std::size_t calls = 0, begin = ~std::size_t{}, end = ~std::size_t{};
+    pool.parallelFor(5, 10, [&](std::size_t b, std::size_t e) {
+        ++calls;
+        begin = b;
+        end = e;
+    });
+    CORRADE_COMPARE(calls, 1);
+    CORRADE_COMPARE(begin, 0);
+    CORRADE_COMPARE(end, 5);
+}
+
+void ThreadPoolTest::parallelForEmpty() {
+    ThreadPool pool{4};
+
+    bool called = false;
+    pool.parallelFor(0, 10, [&called](std::size_t, std::size_t) {
+        called = true;
+    });
+    CORRADE_VERIFY(!called);
+}
+
+void ThreadPoolTest::parallelForRepeated() {
+    ThreadPool pool{4};
+
+    /* Waking up the workers many times in a row shouldn't deadlock or lose
+       any chunks */
+    std::atomic<std::size_t> sum{0};
+    for(std::size_t i = 0; i != 100; ++i)
+        pool.parallelFor(64, 1, [&sum](std::size_t begin, std::size_t end) {
+            sum += end - begin;
+        });
+    CORRADE_COMPARE(std::size_t(sum), 6400);
+}
+
+}}
+
+CORRADE_TEST_MAIN(Magnum::Test::ThreadPoolTest)
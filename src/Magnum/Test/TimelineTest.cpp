@@ -0,0 +1,188 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/System.h>
+
+#include "Magnum/FrameAllocator.h"
+#include "Magnum/Timeline.h"
+
+namespace Magnum { namespace Test {
+
+struct TimelineTest: TestSuite::Tester {
+    explicit TimelineTest();
+
+    void construct();
+    void frameHistory();
+    void frameHistoryDisabled();
+    void frameDurationPercentile();
+    void frameDurationPercentileOutOfRange();
+    void hitchCallback();
+    void frameAllocator();
+};
+
+TimelineTest::TimelineTest() {
+    addTests({&TimelineTest::construct,
+              &TimelineTest::frameHistory,
+              &TimelineTest::frameHistoryDisabled,
+              &TimelineTest::frameDurationPercentile,
+              &TimelineTest::frameDurationPercentileOutOfRange,
+              &TimelineTest::hitchCallback,
+              &TimelineTest::frameAllocator});
+}
+
+void TimelineTest::construct() {
+    Timeline timeline;
+    CORRADE_COMPARE(timeline.previousFrameDuration(), 0.0f);
+    CORRADE_COMPARE(timeline.frameCount(), 0);
+    CORRADE_COMPARE(timeline.frameHistorySize(), 0);
+
+    /* Stopped timeline doesn't count frames */
+    timeline.nextFrame();
+    CORRADE_COMPARE(timeline.frameCount(), 0);
+}
+
+void TimelineTest::frameHistory() {
+    Timeline timeline;
+    timeline.setFrameHistorySize(3);
+    CORRADE_COMPARE(timeline.frameHistorySize(), 3);
+
+    timeline.start();
+    CORRADE_VERIFY(timeline.frameHistory().empty());
+
+    Utility::System::sleep(20);
+    timeline.nextFrame();
+    timeline.nextFrame();
+    CORRADE_COMPARE(timeline.frameCount(), 2);
+
+    std::vector<Float> history = timeline.frameHistory();
+    CORRADE_COMPARE(history.size(), 2);
+    CORRADE_COMPARE_AS(history[0], 0.02f, TestSuite::Compare::GreaterOrEqual);
+    CORRADE_COMPARE_AS(history[1], 0.02f, TestSuite::Compare::Less);
+
+    /* The ring wraps around, the long frame falls out */
+    timeline.nextFrame();
+    timeline.nextFrame();
+    history = timeline.frameHistory();
+    CORRADE_COMPARE(history.size(), 3);
+    for(Float duration: history)
+        CORRADE_COMPARE_AS(duration, 0.02f, TestSuite::Compare::Less);
+
+    /* Restarting clears everything */
+    timeline.start();
+    CORRADE_COMPARE(timeline.frameCount(), 0);
+    CORRADE_VERIFY(timeline.frameHistory().empty());
+    CORRADE_COMPARE(timeline.frameDurationPercentile(100.0f), 0.0f);
+}
+
+void TimelineTest::frameHistoryDisabled() {
+    Timeline timeline;
+    timeline.start();
+    timeline.nextFrame();
+
+    CORRADE_COMPARE(timeline.frameCount(), 1);
+    CORRADE_VERIFY(timeline.frameHistory().empty());
+    CORRADE_COMPARE(timeline.frameDurationPercentile(50.0f), 0.0f);
+}
+
+void TimelineTest::frameDurationPercentile() {
+    Timeline timeline;
+    timeline.setFrameHistorySize(1);
+    timeline.start();
+
+    /* Three short frames, one long */
+    timeline.nextFrame();
+    timeline.nextFrame();
+    timeline.nextFrame();
+    Utility::System::sleep(30);
+    timeline.nextFrame();
+
+    CORRADE_COMPARE_AS(timeline.frameDurationPercentile(50.0f), 0.02f,
+        TestSuite::Compare::Less);
+    CORRADE_COMPARE_AS(timeline.frameDurationPercentile(100.0f), 0.03f,
+        TestSuite::Compare::GreaterOrEqual);
+    /* Bucket precision is better than 12.5% */
+    CORRADE_COMPARE_AS(timeline.frameDurationPercentile(100.0f),
+        timeline.frameHistory().back()*1.125f,
+        TestSuite::Compare::LessOrEqual);
+
+    timeline.resetFrameHistogram();
+    CORRADE_COMPARE(timeline.frameDurationPercentile(100.0f), 0.0f);
+    CORRADE_COMPARE(timeline.frameHistory().size(), 1);
+}
+
+void TimelineTest::frameDurationPercentileOutOfRange() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    Timeline timeline;
+    timeline.frameDurationPercentile(100.5f);
+    CORRADE_COMPARE(out.str(), "Timeline::frameDurationPercentile(): percentile 100.5 out of range\n");
+}
+
+void TimelineTest::hitchCallback() {
+    std::vector<UnsignedLong> hitches;
+    Timeline timeline;
+    timeline.setHitchCallback(0.02f, [](Float duration, UnsignedLong frame, void* userData) {
+        CORRADE_VERIFY(duration > 0.02f);
+        static_cast<std::vector<UnsignedLong>*>(userData)->push_back(frame);
+    }, &hitches);
+    timeline.start();
+
+    timeline.nextFrame();
+    Utility::System::sleep(30);
+    timeline.nextFrame();
+    timeline.nextFrame();
+    CORRADE_COMPARE(hitches, std::vector<UnsignedLong>{1});
+
+    /* Disabling */
+    timeline.setHitchCallback(0.0f, nullptr);
+    Utility::System::sleep(30);
+    timeline.nextFrame();
+    CORRADE_COMPARE(hitches, std::vector<UnsignedLong>{1});
+}
+
+void TimelineTest::frameAllocator() {
+    FrameAllocator allocator;
+    Timeline timeline;
+    CORRADE_VERIFY(!timeline.frameAllocator());
+    timeline.setFrameAllocator(&allocator);
+    CORRADE_COMPARE(timeline.frameAllocator(), &allocator);
+
+    /* Stopped timeline doesn't reset the allocator */
+    allocator.allocate(100);
+    timeline.nextFrame();
+    CORRADE_VERIFY(allocator.usedSize());
+
+    timeline.start();
+    timeline.nextFrame();
+    CORRADE_COMPARE(allocator.usedSize(), 0);
+}
+
+}}
+
+CORRADE_TEST_MAIN(Magnum::Test::TimelineTest)
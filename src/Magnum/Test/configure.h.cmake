@@ -24,3 +24,5 @@
 */
 
 #define SHADERGLTEST_FILES_DIR "${SHADERGLTEST_FILES_DIR}"
+#define ABSTRACTSHADERPROGRAMGLTEST_SAVE_DIR "${ABSTRACTSHADERPROGRAMGLTEST_SAVE_DIR}"
+#define RESOURCERESTORECACHETEST_SAVE_DIR "${RESOURCERESTORECACHETEST_SAVE_DIR}"
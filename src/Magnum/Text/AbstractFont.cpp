@@ -25,6 +25,9 @@
 
 #include "AbstractFont.h"
 
+#include <list>
+#include <mutex>
+#include <unordered_map>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Utility/Directory.h>
 #include <Corrade/Utility/Unicode.h>
@@ -38,6 +41,78 @@
 
 namespace Magnum { namespace Text {
 
+namespace Implementation {
+
+struct LayoutCacheKey {
+    const GlyphCache* cache;
+    Float size;
+    std::string text;
+
+    bool operator==(const LayoutCacheKey& other) const {
+        return cache == other.cache && size == other.size && text == other.text;
+    }
+};
+
+struct LayoutCacheKeyHash {
+    std::size_t operator()(const LayoutCacheKey& key) const {
+        std::size_t hash = std::hash<std::string>{}(key.text);
+        hash ^= std::hash<const GlyphCache*>{}(key.cache) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        hash ^= std::hash<Float>{}(key.size) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        return hash;
+    }
+};
+
+struct LayoutCacheGlyph {
+    Range2D quadPosition, textureCoordinates;
+    Vector2 advance;
+};
+
+typedef std::vector<LayoutCacheGlyph> LayoutCacheRun;
+
+struct LayoutCacheEntry {
+    UnsignedInt generation;
+    std::shared_ptr<const LayoutCacheRun> glyphs;
+    /* Position in the LRU list */
+    std::list<const LayoutCacheKey*>::iterator used;
+};
+
+struct LayoutCache {
+    std::size_t size{};
+    std::mutex mutex;
+    std::unordered_map<LayoutCacheKey, LayoutCacheEntry, LayoutCacheKeyHash> entries;
+    /* Most recently used first, pointing to keys in the map, which are
+       stable across rehashes */
+    std::list<const LayoutCacheKey*> used;
+
+    void shrink(std::size_t count) {
+        while(entries.size() > count) {
+            const auto found = entries.find(*used.back());
+            used.pop_back();
+            entries.erase(found);
+        }
+    }
+};
+
+}
+
+namespace {
+
+/* Layouter reading a run shared with the layout cache */
+class CachedLayouter: public AbstractLayouter {
+    public:
+        explicit CachedLayouter(std::shared_ptr<const Implementation::LayoutCacheRun> glyphs): AbstractLayouter(glyphs->size()), _glyphs{std::move(glyphs)} {}
+
+    private:
+        std::tuple<Range2D, Range2D, Vector2> doRenderGlyph(const UnsignedInt i) override {
+            const Implementation::LayoutCacheGlyph& glyph = (*_glyphs)[i];
+            return std::make_tuple(glyph.quadPosition, glyph.textureCoordinates, glyph.advance);
+        }
+
+        std::shared_ptr<const Implementation::LayoutCacheRun> _glyphs;
+};
+
+}
+
 std::string AbstractFont::pluginInterface() {
     return "cz.mosra.magnum.Text.AbstractFont/0.2.4";
 }
@@ -60,6 +135,8 @@ AbstractFont::AbstractFont(): _size(0.0f) {}
 
 AbstractFont::AbstractFont(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractPlugin{manager, plugin}, _size{0.0f}, _lineHeight{0.0f} {}
 
+AbstractFont::~AbstractFont() = default;
+
 bool AbstractFont::openData(const std::vector<std::pair<std::string, Containers::ArrayView<const char>>>& data, const Float size) {
     CORRADE_ASSERT(features() & Feature::OpenData,
         "Text::AbstractFont::openData(): feature not supported", false);
@@ -132,6 +209,9 @@ auto AbstractFont::doOpenFile(const std::string& filename, const Float size) ->
 }
 
 void AbstractFont::close() {
+    /* The remembered layouts are for the previous font */
+    clearLayoutCache();
+
     if(isOpened()) {
         doClose();
         _size = 0.0f;
@@ -161,10 +241,23 @@ void AbstractFont::fillGlyphCache(GlyphCache& cache, const std::string& characte
     doFillGlyphCache(cache, Utility::Unicode::utf32(characters));
 }
 
+void AbstractFont::fillGlyphCache(GlyphCache& cache, const std::string& characters, ThreadPool& pool) {
+    CORRADE_ASSERT(isOpened(),
+        "Text::AbstractFont::fillGlyphCache(): no font opened", );
+    CORRADE_ASSERT(!(features() & Feature::PreparedGlyphCache),
+        "Text::AbstractFont::fillGlyphCache(): feature not supported", );
+
+    doFillGlyphCacheParallel(cache, Utility::Unicode::utf32(characters), pool);
+}
+
 void AbstractFont::doFillGlyphCache(GlyphCache&, const std::u32string&) {
     CORRADE_ASSERT(false, "Text::AbstractFont::fillGlyphCache(): feature advertised but not implemented", );
 }
 
+void AbstractFont::doFillGlyphCacheParallel(GlyphCache& cache, const std::u32string& characters, ThreadPool&) {
+    doFillGlyphCache(cache, characters);
+}
+
 std::unique_ptr<GlyphCache> AbstractFont::createGlyphCache() {
     CORRADE_ASSERT(isOpened(),
         "Text::AbstractFont::createGlyphCache(): no font opened", nullptr);
@@ -182,7 +275,85 @@ std::unique_ptr<GlyphCache> AbstractFont::doCreateGlyphCache() {
 std::unique_ptr<AbstractLayouter> AbstractFont::layout(const GlyphCache& cache, const Float size, const std::string& text) {
     CORRADE_ASSERT(isOpened(), "Text::AbstractFont::layout(): no font opened", nullptr);
 
-    return doLayout(cache, size, text);
+    if(!_layoutCache || !_layoutCache->size)
+        return doLayout(cache, size, text);
+
+    Implementation::LayoutCache& layoutCache = *_layoutCache;
+    Implementation::LayoutCacheKey key{&cache, size, text};
+    {
+        std::lock_guard<std::mutex> lock{layoutCache.mutex};
+        auto found = layoutCache.entries.find(key);
+        if(found != layoutCache.entries.end()) {
+            /* Up-to-date, mark as most recently used */
+            if(found->second.generation == cache.generation()) {
+                layoutCache.used.splice(layoutCache.used.begin(), layoutCache.used, found->second.used);
+                return std::unique_ptr<AbstractLayouter>{new CachedLayouter{found->second.glyphs}};
+            }
+
+            /* Glyph cache contents changed since, lay out again */
+            layoutCache.used.erase(found->second.used);
+            layoutCache.entries.erase(found);
+        }
+    }
+
+    /* Lay out and record the glyph run. Done outside of the lock so other
+       threads aren't blocked by it. The generation is queried only after,
+       as the layouter might add glyphs to the cache. */
+    std::shared_ptr<Implementation::LayoutCacheRun> glyphs = std::make_shared<Implementation::LayoutCacheRun>();
+    {
+        std::unique_ptr<AbstractLayouter> layouter = doLayout(cache, size, text);
+        glyphs->reserve(layouter->glyphCount());
+        for(UnsignedInt i = 0; i != layouter->glyphCount(); ++i) {
+            Implementation::LayoutCacheGlyph glyph;
+            std::tie(glyph.quadPosition, glyph.textureCoordinates, glyph.advance) = layouter->doRenderGlyph(i);
+            glyphs->push_back(glyph);
+        }
+    }
+    const UnsignedInt generation = cache.generation();
+
+    {
+        std::lock_guard<std::mutex> lock{layoutCache.mutex};
+
+        /* Another thread might have laid out the same text meanwhile, keep
+           the existing entry in that case */
+        auto inserted = layoutCache.entries.emplace(std::move(key), Implementation::LayoutCacheEntry{generation, glyphs, {}});
+        if(inserted.second) {
+            layoutCache.used.push_front(&inserted.first->first);
+            inserted.first->second.used = layoutCache.used.begin();
+            layoutCache.shrink(layoutCache.size);
+        }
+    }
+
+    return std::unique_ptr<AbstractLayouter>{new CachedLayouter{std::move(glyphs)}};
+}
+
+std::size_t AbstractFont::layoutCacheSize() const {
+    return _layoutCache ? _layoutCache->size : 0;
+}
+
+AbstractFont& AbstractFont::setLayoutCacheSize(const std::size_t size) {
+    if(!size) {
+        _layoutCache = nullptr;
+        return *this;
+    }
+
+    if(!_layoutCache) _layoutCache.reset(new Implementation::LayoutCache);
+    std::lock_guard<std::mutex> lock{_layoutCache->mutex};
+    _layoutCache->size = size;
+    _layoutCache->shrink(size);
+    return *this;
+}
+
+std::size_t AbstractFont::layoutCacheCount() const {
+    if(!_layoutCache) return 0;
+    std::lock_guard<std::mutex> lock{_layoutCache->mutex};
+    return _layoutCache->entries.size();
+}
+
+void AbstractFont::clearLayoutCache() {
+    if(!_layoutCache) return;
+    std::lock_guard<std::mutex> lock{_layoutCache->mutex};
+    _layoutCache->shrink(0);
 }
 
 AbstractLayouter::AbstractLayouter(UnsignedInt glyphCount): _glyphCount(glyphCount) {}
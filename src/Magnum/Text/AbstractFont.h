@@ -42,6 +42,8 @@
 
 namespace Magnum { namespace Text {
 
+namespace Implementation { struct LayoutCache; }
+
 /**
 @brief Base for font plugins
 
@@ -56,6 +58,21 @@ First step is to open the font using @ref openData(), @ref openSingleData() or
 text rendering later, see @ref GlyphCache for more information. See
 @ref Renderer for information about text rendering.
 
+@section Text-AbstractFont-layout-cache Layout cache
+
+UI code usually lays out the same strings such as labels, numbers or menu
+items every frame. With @ref setLayoutCacheSize() the font remembers results
+of the most recent @ref layout() calls, keyed by the glyph cache, font size
+and the text, and returns a layouter reading from a shared immutable glyph run
+instead of calling @ref doLayout() again. When the cache is full, the least
+recently used entry is discarded. Entries are invalidated when the glyph cache
+changes its contents, as reported by @ref GlyphCache::generation(), and the
+whole cache is cleared when the font is closed. The cache is guarded by a
+mutex, so @ref layout() can still be called from more than one thread if the
+@ref doLayout() implementation is thread-safe.
+
+@snippet MagnumText.cpp AbstractFont-layout-cache
+
 @section Text-AbstractFont-subclassing Subclassing
 
 Plugin implements @ref doFeatures(), @ref doClose(), @ref doLayout(), either
@@ -133,6 +150,8 @@ class MAGNUM_TEXT_EXPORT AbstractFont: public PluginManager::AbstractPlugin {
         /** @brief Plugin manager constructor */
         explicit AbstractFont(PluginManager::AbstractManager& manager, const std::string& plugin);
 
+        ~AbstractFont();
+
         /** @brief Features supported by this font */
         Features features() const { return doFeatures(); }
 
@@ -243,6 +262,18 @@ class MAGNUM_TEXT_EXPORT AbstractFont: public PluginManager::AbstractPlugin {
          */
         void fillGlyphCache(GlyphCache& cache, const std::string& characters);
 
+        /**
+         * @brief Fill glyph cache with given character set using a thread pool
+         *
+         * Same as @ref fillGlyphCache(GlyphCache&, const std::string&), but
+         * allows the plugin to rasterize the glyphs in parallel on given
+         * thread pool. Plugins that don't support concurrent rasterization
+         * fill the cache serially on the calling thread. See
+         * @ref doFillGlyphCacheParallel()
+         * for details.
+         */
+        void fillGlyphCache(GlyphCache& cache, const std::string& characters, ThreadPool& pool);
+
         /**
          * @brief Create glyph cache
          *
@@ -265,6 +296,41 @@ class MAGNUM_TEXT_EXPORT AbstractFont: public PluginManager::AbstractPlugin {
          */
         std::unique_ptr<AbstractLayouter> layout(const GlyphCache& cache, Float size, const std::string& text);
 
+        /**
+         * @brief Layout cache size
+         *
+         * Max count of remembered layouts. Default is @cpp 0 @ce, meaning the
+         * cache is disabled.
+         * @see @ref setLayoutCacheSize(), @ref layoutCacheCount()
+         */
+        std::size_t layoutCacheSize() const;
+
+        /**
+         * @brief Set layout cache size
+         * @return Reference to self (for method chaining)
+         *
+         * If the cache contains more entries than @p size, the least recently
+         * used are discarded. Setting it to @cpp 0 @ce disables the cache and
+         * frees all remembered layouts. See @ref Text-AbstractFont-layout-cache
+         * for more information.
+         */
+        AbstractFont& setLayoutCacheSize(std::size_t size);
+
+        /**
+         * @brief Count of remembered layouts
+         *
+         * @see @ref layoutCacheSize(), @ref clearLayoutCache()
+         */
+        std::size_t layoutCacheCount() const;
+
+        /**
+         * @brief Clear the layout cache
+         *
+         * Discards all remembered layouts, keeping the cache size. Called
+         * implicitly from @ref close().
+         */
+        void clearLayoutCache();
+
     protected:
         /**
          * @brief Font metrics
@@ -352,6 +418,20 @@ class MAGNUM_TEXT_EXPORT AbstractFont: public PluginManager::AbstractPlugin {
          */
         virtual void doFillGlyphCache(GlyphCache& cache, const std::u32string& characters);
 
+        /**
+         * @brief Implementation for @ref fillGlyphCache(GlyphCache&, const std::string&, ThreadPool&)
+         *
+         * Default implementation calls
+         * @ref doFillGlyphCache(GlyphCache&, const std::u32string&). Plugins
+         * capable of rasterizing glyphs concurrently are expected to render
+         * the glyph images in parallel on @p pool, each thread with its own
+         * rasterizer state, then reserve space for all glyphs at once using
+         * @ref GlyphCache::reserve() and finally call
+         * @ref GlyphCache::insert() and @ref GlyphCache::setImage() on the
+         * calling thread, as the cache and its texture are not thread-safe.
+         */
+        virtual void doFillGlyphCacheParallel(GlyphCache& cache, const std::u32string& characters, ThreadPool& pool);
+
         /** @brief Implementation for @ref createGlyphCache() */
         virtual std::unique_ptr<GlyphCache> doCreateGlyphCache();
 
@@ -362,6 +442,7 @@ class MAGNUM_TEXT_EXPORT AbstractFont: public PluginManager::AbstractPlugin {
     private:
     #endif
         Float _size, _ascent, _descent, _lineHeight;
+        std::unique_ptr<Implementation::LayoutCache> _layoutCache;
 };
 
 CORRADE_ENUMSET_OPERATORS(AbstractFont::Features)
@@ -432,6 +513,9 @@ class MAGNUM_TEXT_EXPORT AbstractLayouter {
     #ifdef DOXYGEN_GENERATING_OUTPUT
     private:
     #endif
+        /* Records the glyph run for the layout cache */
+        friend AbstractFont;
+
         UnsignedInt _glyphCount;
 };
 
@@ -27,6 +27,7 @@
 
 #include "Magnum/Context.h"
 #include "Magnum/Extensions.h"
+#include "Magnum/Image.h"
 #include "Magnum/ImageView.h"
 #ifndef CORRADE_NO_ASSERT
 #include "Magnum/PixelFormat.h"
@@ -46,7 +47,7 @@ DistanceFieldGlyphCache::DistanceFieldGlyphCache(const Vector2i& originalSize, c
     #else
     GlyphCache(TextureFormat::RGB, originalSize, size, Vector2i(radius)),
     #endif
-    scale(Vector2(size)/Vector2(originalSize)), radius(radius)
+    scale(Vector2(size)/Vector2(originalSize)), radius(radius), pool{}
 {
     #ifndef MAGNUM_TARGET_GLES
     MAGNUM_ASSERT_EXTENSION_SUPPORTED(Extensions::GL::ARB::texture_rg);
@@ -80,6 +81,18 @@ void DistanceFieldGlyphCache::setImage(const Vector2i& offset, const ImageView2D
     }
     #endif
 
+    /* Compute the distance field on the CPU, if requested. Its output is
+       Luminance where the texture is RGB, use the GPU there. */
+    if(pool
+        #if defined(MAGNUM_TARGET_GLES) && defined(MAGNUM_TARGET_GLES2)
+        && internalFormat != TextureFormat::Luminance
+        #endif
+    ) {
+        const Image2D output = TextureTools::distanceField(image, image.size()*scale, radius, *pool);
+        texture().setSubImage(0, offset*scale, output);
+        return;
+    }
+
     Texture2D input;
     input.setWrapping(Sampler::Wrapping::ClampToEdge)
         .setMinificationFilter(Sampler::Filter::Linear)
@@ -68,11 +68,38 @@ class MAGNUM_TEXT_EXPORT DistanceFieldGlyphCache: public GlyphCache {
          */
         explicit DistanceFieldGlyphCache(const Vector2i& originalSize, const Vector2i& size, UnsignedInt radius);
 
+        /**
+         * @brief Thread pool for CPU distance field computation
+         *
+         * If @cpp nullptr @ce (the default), the distance field is computed
+         * on the GPU.
+         * @see @ref setThreadPool()
+         */
+        ThreadPool* threadPool() const { return pool; }
+
+        /**
+         * @brief Set thread pool for CPU distance field computation
+         * @return Reference to self (for method chaining)
+         *
+         * If set to non-null pool, @ref setImage() computes the distance
+         * field using @ref TextureTools::distanceField(const ImageView2D&, const Vector2i&, Int, ThreadPool&)
+         * and uploads the result, which is faster for large atlases and
+         * doesn't need any framebuffer rendering. The pool is expected to
+         * outlive all subsequent @ref setImage() calls. On OpenGL ES 2.0
+         * without @extension{EXT,texture_rg} and in WebGL 1.0 the GPU
+         * implementation is always used.
+         */
+        DistanceFieldGlyphCache& setThreadPool(ThreadPool* pool) {
+            this->pool = pool;
+            return *this;
+        }
+
         /**
          * @brief Set cache image
          *
          * Uploads image for one or more glyphs to given offset in original
-         * cache texture. The texture is then converted to distance field.
+         * cache texture. The texture is then converted to distance field,
+         * either on the GPU or on the CPU if @ref setThreadPool() was set.
          */
         void setImage(const Vector2i& offset, const ImageView2D& image) override;
 
@@ -87,6 +114,7 @@ class MAGNUM_TEXT_EXPORT DistanceFieldGlyphCache: public GlyphCache {
     private:
         const Vector2 scale;
         const UnsignedInt radius;
+        ThreadPool* pool;
 };
 
 }}
@@ -0,0 +1,263 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "DynamicGlyphCache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <tuple>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/Unicode.h>
+
+#include "Magnum/ImageView.h"
+#include "Magnum/Text/AbstractFont.h"
+
+namespace Magnum { namespace Text {
+
+namespace {
+    constexpr std::size_t NoShelf = ~std::size_t{};
+}
+
+DynamicGlyphCache::DynamicGlyphCache(const TextureFormat internalFormat, const Vector2i& size, const Vector2i& padding): GlyphCache{internalFormat, size, padding}, _frame{0}, _shelfTop{0}, _evictedGlyphCount{0}, _notFound{NoShelf, {}} {}
+
+DynamicGlyphCache::DynamicGlyphCache(const Vector2i& size, const Vector2i& padding): GlyphCache{size, padding}, _frame{0}, _shelfTop{0}, _evictedGlyphCount{0}, _notFound{NoShelf, {}} {}
+
+DynamicGlyphCache::~DynamicGlyphCache() = default;
+
+std::size_t DynamicGlyphCache::prepare(AbstractFont& font, const std::string& text) {
+    /* Mark glyphs already in the cache as used, collect the missing ones */
+    std::string missingCharacters;
+    std::vector<UnsignedInt> missingGlyphs;
+    for(std::size_t i = 0; i < text.size(); ) {
+        const std::size_t begin = i;
+        char32_t character;
+        std::tie(character, i) = Utility::Unicode::nextChar(text, i);
+
+        const UnsignedInt glyph = font.glyphId(character);
+        if(!glyph) continue;
+
+        auto found = _glyphs.find(glyph);
+        if(found != _glyphs.end()) {
+            found->second.frame = _frame;
+            _lru.splice(_lru.begin(), _lru, found->second.lru);
+        } else if(std::find(missingGlyphs.begin(), missingGlyphs.end(), glyph) == missingGlyphs.end()) {
+            missingGlyphs.push_back(glyph);
+            missingCharacters.append(text, begin, i - begin);
+        }
+    }
+
+    if(missingGlyphs.empty()) return 0;
+
+    /* Rasterize the missing glyphs, this calls reserve(), insert() and
+       setImage() */
+    font.fillGlyphCache(*this, missingCharacters);
+
+    /* The font might have filled also the "Not Found" glyph, replace the
+       previous one in that case */
+    const Range2Di notFoundRectangle = (*this)[0].second;
+    {
+        auto slot = std::find_if(_reserved.begin(), _reserved.end(), [&notFoundRectangle](const Slot& s) {
+            return s.rectangle == notFoundRectangle;
+        });
+        if(slot != _reserved.end()) {
+            deallocate(_notFound);
+            _notFound = *slot;
+            _reserved.erase(slot);
+        }
+    }
+
+    /* Pair the inserted glyphs with the reserved slots. Glyphs that the font
+       didn't insert are returned as the "Not Found" glyph. */
+    std::size_t count = 0;
+    for(const UnsignedInt glyph: missingGlyphs) {
+        const Range2Di rectangle = (*this)[glyph].second;
+        if(rectangle == notFoundRectangle) continue;
+
+        auto slot = std::find_if(_reserved.begin(), _reserved.end(), [&rectangle](const Slot& s) {
+            return s.rectangle == rectangle;
+        });
+        if(slot == _reserved.end()) continue;
+
+        _lru.push_front(glyph);
+        _glyphs.emplace(glyph, Glyph{*slot, _frame, _lru.begin()});
+        _reserved.erase(slot);
+        ++count;
+    }
+
+    /* Give back space that wasn't used for anything */
+    for(const Slot& slot: _reserved) deallocate(slot);
+    _reserved.clear();
+
+    return count;
+}
+
+std::vector<Range2Di> DynamicGlyphCache::reserve(const std::vector<Vector2i>& sizes) {
+    std::vector<Range2Di> out;
+    out.reserve(sizes.size());
+
+    for(const Vector2i& size: sizes) {
+        const Vector2i paddedSize = size + padding()*2;
+
+        /* Prefer shelves of similar height, then any shelf, then make space
+           by evicting least recently used glyphs */
+        Slot slot;
+        while(!allocate(paddedSize, false, slot) && !allocate(paddedSize, true, slot)) {
+            if(!evict()) {
+                CORRADE_ASSERT(false, "Text::DynamicGlyphCache::reserve(): cache too small to contain all glyphs used in current frame", {});
+                return {};
+            }
+        }
+
+        _reserved.push_back(slot);
+        if(slot.shelf != NoShelf) _dirty.push_back(slot.rectangle);
+        out.push_back(slot.rectangle.padded(-padding()));
+    }
+
+    return out;
+}
+
+void DynamicGlyphCache::setImage(const Vector2i& offset, const ImageView2D& image) {
+    const Range2Di imageRectangle = Range2Di::fromSize(offset, image.size());
+
+    Math::Vector2<std::size_t> dataOffset, dataSize;
+    std::size_t pixelSize;
+    std::tie(dataOffset, dataSize, pixelSize) = image.dataProperties();
+    const char* const data = image.data() + dataOffset.sum();
+
+    /* Upload only the dirty regions, cropped out of the image */
+    std::vector<Range2Di> remaining;
+    for(const Range2Di& rectangle: _dirty) {
+        if(!(rectangle.min() >= imageRectangle.min()).all() || !(rectangle.max() <= imageRectangle.max()).all()) {
+            remaining.push_back(rectangle);
+            continue;
+        }
+
+        const Vector2i size = rectangle.size();
+        const std::size_t rowSize = size.x()*pixelSize;
+        Containers::Array<char> region{std::size_t(size.y())*rowSize};
+        for(Int y = 0; y != size.y(); ++y)
+            std::memcpy(region + y*rowSize, data + (rectangle.min().y() - offset.y() + y)*dataSize.x() + (rectangle.min().x() - offset.x())*pixelSize, rowSize);
+
+        GlyphCache::setImage(rectangle.min(), ImageView2D{PixelStorage{}.setAlignment(1), image.format(), image.type(), size, region});
+    }
+
+    _dirty = std::move(remaining);
+}
+
+bool DynamicGlyphCache::allocate(const Vector2i& size, const bool allowWaste, Slot& out) {
+    /* Nothing to allocate for empty glyphs */
+    if(!size.product()) {
+        out = {NoShelf, {}};
+        return true;
+    }
+
+    /* Find the lowest shelf that has space for the glyph, unless allowed,
+       avoid shelves that are much higher than the glyph */
+    std::size_t best = NoShelf;
+    for(std::size_t i = 0; i != _shelves.size(); ++i) {
+        const Shelf& shelf = _shelves[i];
+        if(shelf.height < size.y() || (!allowWaste && shelf.height > size.y() + size.y()/2)) continue;
+        if(best != NoShelf && _shelves[best].height <= shelf.height) continue;
+
+        const bool fits = shelf.x + size.x() <= textureSize().x() ||
+            std::find_if(shelf.freeSpans.begin(), shelf.freeSpans.end(), [&size](const std::pair<Int, Int>& span) {
+                return span.second >= size.x();
+            }) != shelf.freeSpans.end();
+        if(fits) best = i;
+    }
+
+    /* Add a new shelf on top, if there's still space */
+    if(best == NoShelf) {
+        if(_shelfTop + size.y() > textureSize().y() || size.x() > textureSize().x())
+            return false;
+
+        best = _shelves.size();
+        _shelves.push_back({_shelfTop, size.y(), 0, 0, {}});
+        _shelfTop += size.y();
+    }
+
+    Shelf& shelf = _shelves[best];
+    auto span = std::find_if(shelf.freeSpans.begin(), shelf.freeSpans.end(), [&size](const std::pair<Int, Int>& span) {
+        return span.second >= size.x();
+    });
+    Int x;
+    if(span != shelf.freeSpans.end()) {
+        x = span->first;
+        span->first += size.x();
+        span->second -= size.x();
+        if(!span->second) shelf.freeSpans.erase(span);
+    } else {
+        x = shelf.x;
+        shelf.x += size.x();
+    }
+
+    ++shelf.glyphCount;
+    out = {best, Range2Di::fromSize({x, shelf.y}, size)};
+    return true;
+}
+
+void DynamicGlyphCache::deallocate(const Slot& slot) {
+    if(slot.shelf == NoShelf) return;
+
+    Shelf& shelf = _shelves[slot.shelf];
+    CORRADE_INTERNAL_ASSERT(shelf.glyphCount);
+
+    /* Whole shelf is free, it can be used for glyphs of any height that fits */
+    if(!--shelf.glyphCount) {
+        shelf.x = 0;
+        shelf.freeSpans.clear();
+
+        /* Give back the space of empty shelves on top */
+        while(!_shelves.empty() && !_shelves.back().glyphCount) {
+            _shelfTop = _shelves.back().y;
+            _shelves.pop_back();
+        }
+
+    /* Glyph at the end of the shelf */
+    } else if(slot.rectangle.right() == shelf.x)
+        shelf.x = slot.rectangle.left();
+
+    /* Glyph in the middle */
+    else shelf.freeSpans.emplace_back(slot.rectangle.left(), slot.rectangle.sizeX());
+}
+
+bool DynamicGlyphCache::evict() {
+    if(_lru.empty()) return false;
+
+    /* Glyphs used in current frame can't be evicted */
+    const UnsignedInt glyph = _lru.back();
+    auto found = _glyphs.find(glyph);
+    CORRADE_INTERNAL_ASSERT(found != _glyphs.end());
+    if(found->second.frame == _frame) return false;
+
+    deallocate(found->second.slot);
+    remove(glyph);
+    _glyphs.erase(found);
+    _lru.pop_back();
+    ++_evictedGlyphCount;
+    return true;
+}
+
+}}
@@ -0,0 +1,191 @@
+#ifndef Magnum_Text_DynamicGlyphCache_h
+#define Magnum_Text_DynamicGlyphCache_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Text::DynamicGlyphCache
+ */
+
+#include <list>
+#include <string>
+#include <unordered_map>
+
+#include "Magnum/Text/GlyphCache.h"
+#include "Magnum/Text/Text.h"
+
+namespace Magnum { namespace Text {
+
+/**
+@brief Glyph cache with on-demand glyph rasterization and eviction
+
+Unlike @ref GlyphCache, which is filled with all needed glyphs up front, this
+cache rasterizes glyphs only when they are first needed and replaces glyphs
+that weren't used for the longest time when there's no space left. Useful for
+languages with large character sets or user-generated content, where it's not
+possible to rasterize all glyphs beforehand.
+
+@section Text-DynamicGlyphCache-usage Usage
+
+Call @ref prepare() with the font and text before rendering the text. Glyphs
+not yet in the cache get rasterized using @ref AbstractFont::fillGlyphCache(),
+glyphs already in the cache are marked as used in current frame. Call
+@ref nextFrame() once each frame:
+
+@snippet MagnumText.cpp DynamicGlyphCache-usage
+
+The texture atlas is divided into horizontal shelves with height of the
+glyphs placed in them. Space freed by evicted glyphs is reused for new glyphs
+on the same shelf, a shelf is reused for glyphs of different height once all
+its glyphs are evicted. Only glyphs not used in current frame are evicted.
+Only the newly reserved regions are uploaded to the texture, even if the font
+plugin supplies an image of the whole cache.
+
+Text rendered before a glyph was evicted still refers to its original place
+in the texture atlas. If @ref evictedGlyphCount() changed, render again all
+texts drawn with glyphs that weren't passed to @ref prepare() in current
+frame.
+
+The font needs to support glyph cache filling, i.e. it can't have
+@ref AbstractFont::Feature::PreparedGlyphCache.
+*/
+class MAGNUM_TEXT_EXPORT DynamicGlyphCache: public GlyphCache {
+    public:
+        /**
+         * @brief Constructor
+         * @param internalFormat    Internal texture format
+         * @param size              Glyph cache texture size
+         * @param padding           Padding around every glyph
+         *
+         * See @ref GlyphCache::GlyphCache(TextureFormat, const Vector2i&, const Vector2i&)
+         * for more information.
+         */
+        explicit DynamicGlyphCache(TextureFormat internalFormat, const Vector2i& size, const Vector2i& padding = {});
+
+        /**
+         * @brief Constructor
+         *
+         * Sets internal texture format to red channel only. See
+         * @ref GlyphCache::GlyphCache(const Vector2i&, const Vector2i&) for
+         * more information.
+         */
+        explicit DynamicGlyphCache(const Vector2i& size, const Vector2i& padding = {});
+
+        ~DynamicGlyphCache();
+
+        /**
+         * @brief Current frame
+         *
+         * @see @ref nextFrame()
+         */
+        UnsignedInt frame() const { return _frame; }
+
+        /**
+         * @brief Count of evicted glyphs
+         *
+         * Total count of glyphs removed from the cache to make space for
+         * other glyphs.
+         */
+        std::size_t evictedGlyphCount() const { return _evictedGlyphCount; }
+
+        /**
+         * @brief Prepare glyphs for given text
+         * @return Count of newly rasterized glyphs
+         *
+         * Marks glyphs for all characters in @p text that are already in the
+         * cache as used in current frame and rasterizes the remaining ones
+         * using @ref AbstractFont::fillGlyphCache(). Characters mapped to
+         * glyph @cpp 0 @ce are ignored.
+         */
+        std::size_t prepare(AbstractFont& font, const std::string& text);
+
+        /**
+         * @brief Advance to next frame
+         *
+         * Glyphs not used by any @ref prepare() call since then can be
+         * evicted to make space for new glyphs.
+         */
+        void nextFrame() { ++_frame; }
+
+        /**
+         * @brief Reserve space for glyphs
+         *
+         * Unlike @ref GlyphCache::reserve() can be called on non-empty cache.
+         * If there's not enough space, glyphs that were used least recently
+         * are evicted. Expects that all glyphs used in current frame fit into
+         * the cache. Usually called from @ref AbstractFont::fillGlyphCache()
+         * during @ref prepare().
+         */
+        std::vector<Range2Di> reserve(const std::vector<Vector2i>& sizes) override;
+
+        /**
+         * @brief Set cache image
+         *
+         * Uploads only regions reserved since last call that are fully
+         * inside the image, the rest of the image is ignored.
+         */
+        void setImage(const Vector2i& offset, const ImageView2D& image) override;
+
+    private:
+        struct Shelf {
+            Int y, height, x;
+            UnsignedInt glyphCount;
+            /* Spans freed by evicted glyphs, offset and width */
+            std::vector<std::pair<Int, Int>> freeSpans;
+        };
+
+        struct Slot {
+            std::size_t shelf;
+            Range2Di rectangle;
+        };
+
+        struct Glyph {
+            Slot slot;
+            UnsignedInt frame;
+            std::list<UnsignedInt>::iterator lru;
+        };
+
+        bool MAGNUM_TEXT_LOCAL allocate(const Vector2i& size, bool allowWaste, Slot& out);
+        void MAGNUM_TEXT_LOCAL deallocate(const Slot& slot);
+        bool MAGNUM_TEXT_LOCAL evict();
+
+        UnsignedInt _frame;
+        Int _shelfTop;
+        std::size_t _evictedGlyphCount;
+        std::vector<Shelf> _shelves;
+        std::unordered_map<UnsignedInt, Glyph> _glyphs;
+        /* Most recently used glyph first */
+        std::list<UnsignedInt> _lru;
+        /* Slots reserved by last reserve() but not yet inserted, regions not
+           yet uploaded */
+        std::vector<Slot> _reserved;
+        /* Slot of the "Not Found" glyph, if filled by the font */
+        Slot _notFound;
+        std::vector<Range2Di> _dirty;
+};
+
+}}
+
+#endif
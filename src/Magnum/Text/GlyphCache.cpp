@@ -72,11 +72,11 @@ void GlyphCache::initialize(const TextureFormat internalFormat, const Vector2i&
         .setStorage(1, internalFormat, size);
 
     /* Default "Not Found" glyph */
-    glyphs.insert({0, {}});
+    glyphs.push_back({0, {}});
 }
 
 std::vector<Range2Di> GlyphCache::reserve(const std::vector<Vector2i>& sizes) {
-    CORRADE_ASSERT((glyphs.size() == 1 && glyphs.at(0) == std::pair<Vector2i, Range2Di>()),
+    CORRADE_ASSERT((glyphs.size() == 1 && glyphs[0].second == std::pair<Vector2i, Range2Di>()),
         "Text::GlyphCache::reserve(): reserving space in non-empty cache is not yet implemented", {});
     glyphs.reserve(glyphs.size() + sizes.size());
     return TextureTools::atlas(_size, sizes, _padding);
@@ -86,10 +86,31 @@ void GlyphCache::insert(const UnsignedInt glyph, const Vector2i& position, const
     const std::pair<Vector2i, Range2Di> glyphData = {position-_padding, rectangle.padded(_padding)};
 
     /* Overwriting "Not Found" glyph */
-    if(glyph == 0) glyphs[0] = glyphData;
+    if(glyph == 0) glyphs[0].second = glyphData;
 
     /* Inserting new glyph */
-    else CORRADE_INTERNAL_ASSERT_OUTPUT(glyphs.insert({glyph, glyphData}).second);
+    else {
+        CORRADE_INTERNAL_ASSERT(!glyphIndices[glyph]);
+        glyphIndices.set(glyph, glyphs.size());
+        glyphs.push_back({glyph, glyphData});
+    }
+
+    ++_generation;
+}
+
+void GlyphCache::remove(const UnsignedInt glyph) {
+    CORRADE_ASSERT(glyph != 0, "Text::GlyphCache::remove(): can't remove the \"Not Found\" glyph", );
+    const UnsignedInt index = glyphIndices[glyph];
+    if(!index) return;
+
+    /* Move the last glyph into the freed place to keep the data dense */
+    if(index != glyphs.size() - 1) {
+        glyphs[index] = glyphs.back();
+        glyphIndices.set(glyphs[index].first, index);
+    }
+    glyphs.pop_back();
+    glyphIndices.set(glyph, 0);
+    ++_generation;
 }
 
 void GlyphCache::setImage(const Vector2i& offset, const ImageView2D& image) {
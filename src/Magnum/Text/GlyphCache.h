@@ -30,7 +30,6 @@
  */
 
 #include <vector>
-#include <unordered_map>
 
 #include "Magnum/Math/Range.h"
 #include "Magnum/Texture.h"
@@ -38,6 +37,32 @@
 
 namespace Magnum { namespace Text {
 
+#ifndef DOXYGEN_GENERATING_OUTPUT
+namespace Implementation {
+    /* Two-level lookup table for mostly dense integer keys such as glyph IDs
+       or Unicode codepoints. Pages of 256 values are allocated only for
+       ranges that contain at least one value, a lookup is just two array
+       accesses. Value of 0 means the key is not present. */
+    class GlyphTable {
+        public:
+            UnsignedInt operator[](UnsignedInt key) const {
+                const std::size_t page = key >> 8;
+                return page < _pages.size() && !_pages[page].empty() ? _pages[page][key & 0xff] : 0;
+            }
+
+            void set(UnsignedInt key, UnsignedInt value) {
+                const std::size_t page = key >> 8;
+                if(page >= _pages.size()) _pages.resize(page + 1);
+                if(_pages[page].empty()) _pages[page].resize(256);
+                _pages[page][key & 0xff] = value;
+            }
+
+        private:
+            std::vector<std::vector<UnsignedInt>> _pages;
+    };
+}
+#endif
+
 /**
 @brief Glyph cache
 
@@ -109,6 +134,15 @@ class MAGNUM_TEXT_EXPORT GlyphCache {
         /** @brief Count of glyphs in the cache */
         std::size_t glyphCount() const { return glyphs.size(); }
 
+        /**
+         * @brief Cache generation
+         *
+         * Incremented every time a glyph is inserted or removed. Used by
+         * @ref AbstractFont to invalidate remembered layouts, see
+         * @ref Text-AbstractFont-layout-cache for more information.
+         */
+        UnsignedInt generation() const { return _generation; }
+
         /** @brief Cache texture */
         Texture2D& texture() { return _texture; }
 
@@ -127,17 +161,24 @@ class MAGNUM_TEXT_EXPORT GlyphCache {
          * @see @ref padding()
          */
         std::pair<Vector2i, Range2Di> operator[](UnsignedInt glyph) const {
-            auto it = glyphs.find(glyph);
-            return it == glyphs.end() ? glyphs.at(0) : it->second;
+            /* Glyphs that are not in the cache map to the "Not Found" glyph
+               at index 0 */
+            return glyphs[glyphIndices[glyph]].second;
         }
 
-        /** @brief Iterator access to cache data */
-        std::unordered_map<UnsignedInt, std::pair<Vector2i, Range2Di>>::const_iterator begin() const {
+        /**
+         * @brief Iterator access to cache data
+         *
+         * Iterates over pairs of glyph ID and glyph parameters. The
+         * @cpp 0 @ce glyph is always first, the remaining glyphs are in
+         * unspecified order.
+         */
+        std::vector<std::pair<UnsignedInt, std::pair<Vector2i, Range2Di>>>::const_iterator begin() const {
             return glyphs.begin();
         }
 
         /** @brief Iterator access to cache data */
-        std::unordered_map<UnsignedInt, std::pair<Vector2i, Range2Di>>::const_iterator end() const {
+        std::vector<std::pair<UnsignedInt, std::pair<Vector2i, Range2Di>>>::const_iterator end() const {
             return glyphs.end();
         }
 
@@ -153,9 +194,9 @@ class MAGNUM_TEXT_EXPORT GlyphCache {
          *
          * @attention Cache size must be large enough to contain all rendered
          *      glyphs.
-         * @see @ref padding()
+         * @see @ref padding(), @ref DynamicGlyphCache::reserve()
          */
-        std::vector<Range2Di> reserve(const std::vector<Vector2i>& sizes);
+        virtual std::vector<Range2Di> reserve(const std::vector<Vector2i>& sizes);
 
         /**
          * @brief Insert glyph to cache
@@ -182,13 +223,25 @@ class MAGNUM_TEXT_EXPORT GlyphCache {
          */
         virtual void setImage(const Vector2i& offset, const ImageView2D& image);
 
+    protected:
+        /**
+         * @brief Remove glyph from the cache
+         *
+         * Meant to be used by subclasses that reuse space in the texture
+         * atlas. Glyph @cpp 0 @ce can't be removed, removing a glyph that is
+         * not in the cache is a no-op.
+         */
+        void remove(UnsignedInt glyph);
+
     private:
         void MAGNUM_LOCAL initialize(TextureFormat internalFormat, const Vector2i& size);
 
         Vector2i _size, _padding;
         Texture2D _texture;
+        UnsignedInt _generation{};
 
-        std::unordered_map<UnsignedInt, std::pair<Vector2i, Range2Di>> glyphs;
+        std::vector<std::pair<UnsignedInt, std::pair<Vector2i, Range2Di>>> glyphs;
+        Implementation::GlyphTable glyphIndices;
 };
 
 }}
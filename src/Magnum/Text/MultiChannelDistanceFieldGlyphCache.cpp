@@ -0,0 +1,79 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MultiChannelDistanceFieldGlyphCache.h"
+
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/TextureFormat.h"
+#include "Magnum/TextureTools/DistanceField.h"
+
+namespace Magnum { namespace Text {
+
+MultiChannelDistanceFieldGlyphCache::MultiChannelDistanceFieldGlyphCache(const Vector2i& originalSize, const Vector2i& size, const UnsignedInt radius):
+    #ifndef MAGNUM_TARGET_GLES2
+    GlyphCache{TextureFormat::RGB8, originalSize, size, Vector2i(radius)},
+    #else
+    GlyphCache{TextureFormat::RGB, originalSize, size, Vector2i(radius)},
+    #endif
+    scale(Vector2(size)/Vector2(originalSize)), radius(radius) {}
+
+void MultiChannelDistanceFieldGlyphCache::setImage(const Vector2i& offset, const ImageView2D& image) {
+    #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+    CORRADE_ASSERT(image.format() == PixelFormat::Red,
+        "Text::MultiChannelDistanceFieldGlyphCache::setImage(): expected" << PixelFormat::Red << "but got" << image.format(), );
+    #else
+    CORRADE_ASSERT(image.format() == PixelFormat::Luminance,
+        "Text::MultiChannelDistanceFieldGlyphCache::setImage(): expected" << PixelFormat::Luminance << "but got" << image.format(), );
+    #endif
+
+    /* Compute single-channel distance field on the CPU */
+    const Vector2i size = image.size()*scale;
+    const Image2D distanceField = TextureTools::distanceField(image, size, radius);
+
+    /* Replicate it to all three channels. Output of distanceField() has rows
+       aligned to four bytes. */
+    const std::size_t inputStride = 4*((size.x() + 3)/4);
+    Containers::Array<char> data{Containers::NoInit, std::size_t(size.product())*3};
+    for(Int y = 0; y != size.y(); ++y) for(Int x = 0; x != size.x(); ++x) {
+        const char value = distanceField.data()[y*inputStride + x];
+        for(std::size_t i = 0; i != 3; ++i)
+            data[(y*size.x() + x)*3 + i] = value;
+    }
+
+    texture().setSubImage(0, offset*scale, ImageView2D{PixelStorage{}.setAlignment(1), PixelFormat::RGB, PixelType::UnsignedByte, size, data});
+}
+
+void MultiChannelDistanceFieldGlyphCache::setDistanceFieldImage(const Vector2i& offset, const ImageView2D& image) {
+    CORRADE_ASSERT(image.format() == PixelFormat::RGB,
+        "Text::MultiChannelDistanceFieldGlyphCache::setDistanceFieldImage(): expected" << PixelFormat::RGB << "but got" << image.format(), );
+
+    texture().setSubImage(0, offset, image);
+}
+
+}}
@@ -0,0 +1,102 @@
+#ifndef Magnum_Text_MultiChannelDistanceFieldGlyphCache_h
+#define Magnum_Text_MultiChannelDistanceFieldGlyphCache_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Text::MultiChannelDistanceFieldGlyphCache
+ */
+
+#include "Magnum/Text/GlyphCache.h"
+
+namespace Magnum { namespace Text {
+
+/**
+@brief Glyph cache with multi-channel distance field rendering
+
+Similar to @ref DistanceFieldGlyphCache, but the texture has three channels
+and is meant to be rendered with @ref Shaders::DistanceFieldVector with
+@ref Shaders::DistanceFieldVector::Flag::MultiChannel enabled. The shader
+takes a median of the three channels, which keeps glyph corners sharp even with
+a texture of much smaller resolution than a single-channel distance field
+would need.
+
+@section Text-MultiChannelDistanceFieldGlyphCache-usage Usage
+
+Multi-channel distance fields can't be reconstructed from binary glyph images,
+they need to be generated from glyph outlines, for example using
+*msdfgen* or a font plugin supporting it. Upload the precomputed
+images using @ref setDistanceFieldImage():
+
+@snippet MagnumText.cpp MultiChannelDistanceFieldGlyphCache-usage
+
+Binary images passed to @ref setImage(), for example by
+@ref AbstractFont::fillGlyphCache(), are converted to a single-channel
+distance field on the CPU using @ref TextureTools::distanceField(const ImageView2D&, const Vector2i&, Int)
+and replicated to all three channels. Such glyphs are rendered the same as with
+@ref DistanceFieldGlyphCache.
+*/
+class MAGNUM_TEXT_EXPORT MultiChannelDistanceFieldGlyphCache: public GlyphCache {
+    public:
+        /**
+         * @brief Constructor
+         * @param originalSize      Unscaled glyph cache texture size
+         * @param size              Actual glyph cache texture size
+         * @param radius            Distance field computation radius
+         *
+         * See @ref TextureTools::distanceField() for more information about
+         * the parameters. Sets internal texture format to
+         * @ref TextureFormat::RGB8, in OpenGL ES 2.0 and WebGL 1.0 to
+         * @ref TextureFormat::RGB.
+         */
+        explicit MultiChannelDistanceFieldGlyphCache(const Vector2i& originalSize, const Vector2i& size, UnsignedInt radius);
+
+        /**
+         * @brief Set cache image
+         *
+         * Uploads image for one or more glyphs to given offset in original
+         * cache texture. The image is converted to a single-channel distance
+         * field, which is then replicated to all three channels. Expects
+         * @ref PixelFormat::Red (@ref PixelFormat::Luminance in WebGL 1.0)
+         * and @ref PixelType::UnsignedByte.
+         */
+        void setImage(const Vector2i& offset, const ImageView2D& image) override;
+
+        /**
+         * @brief Set distance field cache image
+         *
+         * Uploads already computed multi-channel distance field image to given
+         * offset in distance field texture. Expects @ref PixelFormat::RGB.
+         */
+        void setDistanceFieldImage(const Vector2i& offset, const ImageView2D& image);
+
+    private:
+        const Vector2 scale;
+        const UnsignedInt radius;
+};
+
+}}
+
+#endif
@@ -25,12 +25,17 @@
 
 #include "Renderer.h"
 
+#include <algorithm>
+#include <numeric>
 #include <Corrade/Containers/Array.h>
 
 #include "Magnum/Context.h"
 #include "Magnum/Extensions.h"
+#include "Magnum/FrameAllocator.h"
 #include "Magnum/Mesh.h"
+#include "Magnum/ThreadPool.h"
 #include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Packing.h"
 #include "Magnum/Shaders/AbstractVector.h"
 #include "Magnum/Text/AbstractFont.h"
 
@@ -58,113 +63,156 @@ template<class T> void createIndices(void* output, const UnsignedInt glyphCount)
     }
 }
 
-struct Vertex {
-    Vector2 position, textureCoordinates;
-};
+typedef Implementation::RendererVertex Vertex;
+
+/* Lays out a single line, appends its vertices and returns its bounds */
+Range2D renderLineInternal(AbstractFont& font, const GlyphCache& cache, const Float size, const std::string& line, const Vector2& linePosition, const Alignment alignment, std::vector<Vertex>& vertices) {
+    const std::size_t lineFirstVertex = vertices.size();
+
+    /* Layout the line */
+    const auto layouter = font.layout(cache, size, line);
+
+    /* Verify that we don't reallocate anything. The only problem might
+       arise when the layouter decides to compose one character from more
+       than one glyph (i.e. accents). Will remove the assert when this
+       issue arises. */
+    CORRADE_INTERNAL_ASSERT(vertices.size() + layouter->glyphCount()*4 <= vertices.capacity());
+
+    /* Bounds of rendered line */
+    Range2D lineRectangle;
+
+    /* Render all glyphs */
+    Vector2 cursorPosition(linePosition);
+    for(UnsignedInt i = 0; i != layouter->glyphCount(); ++i) {
+        Range2D quadPosition, textureCoordinates;
+        std::tie(quadPosition, textureCoordinates) = layouter->renderGlyph(i, cursorPosition, lineRectangle);
+
+        /* 0---2
+           |   |
+           |   |
+           |   |
+           1---3 */
+
+        vertices.insert(vertices.end(), {
+            {quadPosition.topLeft(), textureCoordinates.topLeft()},
+            {quadPosition.bottomLeft(), textureCoordinates.bottomLeft()},
+            {quadPosition.topRight(), textureCoordinates.topRight()},
+            {quadPosition.bottomRight(), textureCoordinates.bottomRight()}
+        });
+    }
 
-std::tuple<std::vector<Vertex>, Range2D> renderVerticesInternal(AbstractFont& font, const GlyphCache& cache, const Float size, const std::string& text, const Alignment alignment) {
-    /* Output data, reserve memory as when the text would be ASCII-only. In
-       reality the actual vertex count will be smaller, but allocating more at
-       once is better than reallocating many times later. */
-    std::vector<Vertex> vertices;
-    vertices.reserve(text.size()*4);
+    /** @todo What about top-down text? */
 
-    /* Total rendered bounds, intial line position, line increment, last+1
-       vertex on previous line */
-    Range2D rectangle;
-    Vector2 linePosition;
-    const Vector2 lineAdvance = Vector2::yAxis(font.lineHeight()*size/font.size());
-    std::size_t lastLineLastVertex = 0;
+    /* Horizontally align the rendered line */
+    Float alignmentOffsetX = 0.0f;
+    if((UnsignedByte(alignment) & Implementation::AlignmentHorizontal) == Implementation::AlignmentCenter)
+        alignmentOffsetX = -lineRectangle.centerX();
+    else if((UnsignedByte(alignment) & Implementation::AlignmentHorizontal) == Implementation::AlignmentRight)
+        alignmentOffsetX = -lineRectangle.right();
 
-    /* Temp buffer so we don't allocate for each new line */
-    /**
-     * @todo C++1z: use std::string_view to avoid the one allocation and all
-     *      the copying altogether
-     */
-    std::string line;
-    line.reserve(text.size());
-
-    /* Render each line separately and align it horizontally */
-    std::size_t pos, prevPos = 0;
-    do {
-        /* Empty line, nothing to do (the rest is done below in while expression) */
-        if((pos = text.find('\n', prevPos)) == prevPos) continue;
+    /* Integer alignment */
+    if(UnsignedByte(alignment) & Implementation::AlignmentIntegral)
+        alignmentOffsetX = Math::round(alignmentOffsetX);
 
-        /* Copy the line into the temp buffer */
-        line.assign(text, prevPos, pos-prevPos);
+    /* Align positions and bounds on current line */
+    for(auto it = vertices.begin()+lineFirstVertex; it != vertices.end(); ++it)
+        it->position.x() += alignmentOffsetX;
+    return lineRectangle.translated(Vector2::xAxis(alignmentOffsetX));
+}
 
-        /* Layout the line */
-        const auto layouter = font.layout(cache, size, line);
-
-        /* Verify that we don't reallocate anything. The only problem might
-           arise when the layouter decides to compose one character from more
-           than one glyph (i.e. accents). Will remove the assert when this
-           issue arises. */
-        CORRADE_INTERNAL_ASSERT(vertices.size() + layouter->glyphCount()*4 <= vertices.capacity());
-
-        /* Bounds of rendered line */
-        Range2D lineRectangle;
-
-        /* Render all glyphs */
-        Vector2 cursorPosition(linePosition);
-        for(UnsignedInt i = 0; i != layouter->glyphCount(); ++i) {
-            Range2D quadPosition, textureCoordinates;
-            std::tie(quadPosition, textureCoordinates) = layouter->renderGlyph(i, cursorPosition, lineRectangle);
-
-            /* 0---2
-               |   |
-               |   |
-               |   |
-               1---3 */
-
-            vertices.insert(vertices.end(), {
-                {quadPosition.topLeft(), textureCoordinates.topLeft()},
-                {quadPosition.bottomLeft(), textureCoordinates.bottomLeft()},
-                {quadPosition.topRight(), textureCoordinates.topRight()},
-                {quadPosition.bottomRight(), textureCoordinates.bottomRight()}
-            });
-        }
+/* Add final line bounds to total bounds, similarly to AbstractFont::renderGlyph() */
+void addLineRectangle(Range2D& rectangle, const Range2D& lineRectangle) {
+    if(!rectangle.size().isZero()) {
+        rectangle.bottomLeft() = Math::min(rectangle.bottomLeft(), lineRectangle.bottomLeft());
+        rectangle.topRight() = Math::max(rectangle.topRight(), lineRectangle.topRight());
+    } else rectangle = lineRectangle;
+}
 
-        /** @todo What about top-down text? */
+Float verticalAlignmentOffset(const Range2D& rectangle, const Alignment alignment) {
+    Float alignmentOffsetY = 0.0f;
+    if((UnsignedByte(alignment) & Implementation::AlignmentVertical) == Implementation::AlignmentMiddle)
+        alignmentOffsetY = -rectangle.centerY();
+    else if((UnsignedByte(alignment) & Implementation::AlignmentVertical) == Implementation::AlignmentTop)
+        alignmentOffsetY = -rectangle.top();
 
-        /* Horizontally align the rendered line */
-        Float alignmentOffsetX = 0.0f;
-        if((UnsignedByte(alignment) & Implementation::AlignmentHorizontal) == Implementation::AlignmentCenter)
-            alignmentOffsetX = -lineRectangle.centerX();
-        else if((UnsignedByte(alignment) & Implementation::AlignmentHorizontal) == Implementation::AlignmentRight)
-            alignmentOffsetX = -lineRectangle.right();
+    /* Integer alignment */
+    if(UnsignedByte(alignment) & Implementation::AlignmentIntegral)
+        alignmentOffsetY = Math::round(alignmentOffsetY);
 
-        /* Integer alignment */
-        if(UnsignedByte(alignment) & Implementation::AlignmentIntegral)
-            alignmentOffsetX = Math::round(alignmentOffsetX);
+    return alignmentOffsetY;
+}
 
-        /* Align positions and bounds on current line */
-        lineRectangle = lineRectangle.translated(Vector2::xAxis(alignmentOffsetX));
-        for(auto it = vertices.begin()+lastLineLastVertex; it != vertices.end(); ++it)
-            it->position.x() += alignmentOffsetX;
+/* Non-empty line of the text and its position */
+struct LineRange {
+    std::size_t offset, size;
+    Vector2 position;
+};
 
-        /* Add final line bounds to total bounds, similarly to AbstractFont::renderGlyph() */
-        if(!rectangle.size().isZero()) {
-            rectangle.bottomLeft() = Math::min(rectangle.bottomLeft(), lineRectangle.bottomLeft());
-            rectangle.topRight() = Math::max(rectangle.topRight(), lineRectangle.topRight());
-        } else rectangle = lineRectangle;
+std::tuple<std::vector<Vertex>, Range2D> renderVerticesInternal(AbstractFont& font, const GlyphCache& cache, const Float size, const std::string& text, const Alignment alignment, ThreadPool* const pool = nullptr) {
+    /* Initial line position, line increment */
+    Vector2 linePosition;
+    const Vector2 lineAdvance = Vector2::yAxis(font.lineHeight()*size/font.size());
 
-    /* Move to next line */
+    /* Find all lines first so they can be laid out independently. Empty
+       lines are skipped, only the line position moves for them. */
+    std::vector<LineRange> lines;
+    std::size_t pos, prevPos = 0;
+    do {
+        if((pos = text.find('\n', prevPos)) == prevPos) continue;
+        lines.push_back({prevPos, (pos == std::string::npos ? text.size() : pos) - prevPos, linePosition});
     } while(prevPos = pos+1,
             linePosition -= lineAdvance,
-            lastLineLastVertex = vertices.size(),
             pos != std::string::npos);
 
-    /* Vertically align the rendered text */
-    Float alignmentOffsetY = 0.0f;
-    if((UnsignedByte(alignment) & Implementation::AlignmentVertical) == Implementation::AlignmentMiddle)
-        alignmentOffsetY = -rectangle.centerY();
-    else if((UnsignedByte(alignment) & Implementation::AlignmentVertical) == Implementation::AlignmentTop)
-        alignmentOffsetY = -rectangle.top();
+    /* Without a thread pool everything is a single chunk, otherwise the lines
+       are split into chunks laid out in parallel and concatenated in order
+       afterwards */
+    const std::size_t chunkSize = pool ? 64 : Math::max(lines.size(), std::size_t{1});
+    const std::size_t chunkCount = (lines.size() + chunkSize - 1)/chunkSize;
+    std::vector<std::vector<Vertex>> chunkVertices(chunkCount);
+    std::vector<Range2D> lineRectangles(lines.size());
+    const auto job = [&](const std::size_t begin, const std::size_t end) {
+        /* Temp buffer so we don't allocate for each new line */
+        std::string line;
+        for(std::size_t chunk = begin; chunk != end; ++chunk) {
+            const std::size_t lineBegin = chunk*chunkSize;
+            const std::size_t lineEnd = Math::min(lineBegin + chunkSize, lines.size());
+
+            /* Reserve memory as when the text would be ASCII-only. In reality
+               the actual vertex count will be smaller, but allocating more at
+               once is better than reallocating many times later. */
+            std::vector<Vertex>& vertices = chunkVertices[chunk];
+            vertices.reserve((lines[lineEnd - 1].offset + lines[lineEnd - 1].size - lines[lineBegin].offset)*4);
+
+            /* Render each line separately and align it horizontally */
+            for(std::size_t i = lineBegin; i != lineEnd; ++i) {
+                line.assign(text, lines[i].offset, lines[i].size);
+                lineRectangles[i] = renderLineInternal(font, cache, size, line, lines[i].position, alignment, vertices);
+            }
+        }
+    };
+    if(pool && chunkCount > 1) pool->parallelFor(chunkCount, 1, job);
+    else job(0, chunkCount);
 
-    /* Integer alignment */
-    if(UnsignedByte(alignment) & Implementation::AlignmentIntegral)
-        alignmentOffsetY = Math::round(alignmentOffsetY);
+    /* Total rendered bounds, added in the same order as the lines were */
+    Range2D rectangle;
+    for(const Range2D& lineRectangle: lineRectangles)
+        addLineRectangle(rectangle, lineRectangle);
+
+    /* Concatenate the chunks */
+    std::vector<Vertex> vertices;
+    if(chunkCount == 1) vertices = std::move(chunkVertices[0]);
+    else {
+        std::size_t vertexCount = 0;
+        for(const std::vector<Vertex>& chunk: chunkVertices)
+            vertexCount += chunk.size();
+        vertices.reserve(vertexCount);
+        for(const std::vector<Vertex>& chunk: chunkVertices)
+            vertices.insert(vertices.end(), chunk.begin(), chunk.end());
+    }
+
+    /* Vertically align the rendered text */
+    const Float alignmentOffsetY = verticalAlignmentOffset(rectangle, alignment);
 
     /* Align positions and bounds */
     rectangle = rectangle.translated(Vector2::yAxis(alignmentOffsetY));
@@ -196,11 +244,11 @@ std::pair<Containers::Array<char>, Mesh::IndexType> renderIndicesInternal(const
     return {std::move(indices), indexType};
 }
 
-std::tuple<Mesh, Range2D> renderInternal(AbstractFont& font, const GlyphCache& cache, Float size, const std::string& text, Buffer& vertexBuffer, Buffer& indexBuffer, BufferUsage usage, Alignment alignment) {
+std::tuple<Mesh, Range2D> renderInternal(AbstractFont& font, const GlyphCache& cache, Float size, const std::string& text, Buffer& vertexBuffer, Buffer& indexBuffer, BufferUsage usage, Alignment alignment, ThreadPool* const pool) {
     /* Render vertices and upload them */
     std::vector<Vertex> vertices;
     Range2D rectangle;
-    std::tie(vertices, rectangle) = renderVerticesInternal(font, cache, size, text, alignment);
+    std::tie(vertices, rectangle) = renderVerticesInternal(font, cache, size, text, alignment, pool);
     vertexBuffer.setData(vertices, usage);
 
     const UnsignedInt glyphCount = vertices.size()/4;
@@ -222,13 +270,22 @@ std::tuple<Mesh, Range2D> renderInternal(AbstractFont& font, const GlyphCache& c
     return std::make_tuple(std::move(mesh), rectangle);
 }
 
+template<UnsignedInt dimensions> std::tuple<Mesh, Range2D> renderMeshInternal(AbstractFont& font, const GlyphCache& cache, Float size, const std::string& text, Buffer& vertexBuffer, Buffer& indexBuffer, BufferUsage usage, Alignment alignment, ThreadPool* const pool) {
+    /* Finalize mesh configuration and return the result */
+    auto r = renderInternal(font, cache, size, text, vertexBuffer, indexBuffer, usage, alignment, pool);
+    Mesh& mesh = std::get<0>(r);
+    mesh.addVertexBuffer(vertexBuffer, 0,
+            typename Shaders::AbstractVector<dimensions>::Position(
+                Shaders::AbstractVector<dimensions>::Position::Components::Two),
+            typename Shaders::AbstractVector<dimensions>::TextureCoordinates());
+    return r;
 }
 
-std::tuple<std::vector<Vector2>, std::vector<Vector2>, std::vector<UnsignedInt>, Range2D> AbstractRenderer::render(AbstractFont& font, const GlyphCache& cache, Float size, const std::string& text, Alignment alignment) {
+std::tuple<std::vector<Vector2>, std::vector<Vector2>, std::vector<UnsignedInt>, Range2D> renderDataInternal(AbstractFont& font, const GlyphCache& cache, Float size, const std::string& text, Alignment alignment, ThreadPool* const pool) {
     /* Render vertices */
     std::vector<Vertex> vertices;
     Range2D rectangle;
-    std::tie(vertices, rectangle) = renderVerticesInternal(font, cache, size, text, alignment);
+    std::tie(vertices, rectangle) = renderVerticesInternal(font, cache, size, text, alignment, pool);
 
     /* Deinterleave the vertices */
     std::vector<Vector2> positions, textureCoordinates;
@@ -247,54 +304,134 @@ std::tuple<std::vector<Vector2>, std::vector<Vector2>, std::vector<UnsignedInt>,
     return std::make_tuple(std::move(positions), std::move(textureCoordinates), std::move(indices), rectangle);
 }
 
+std::tuple<std::vector<GlyphInstance>, Range2D> renderInstancesInternal(AbstractFont& font, const GlyphCache& cache, Float size, const std::string& text, Alignment alignment, ThreadPool* const pool) {
+    /* Render vertices */
+    std::vector<Vertex> vertices;
+    Range2D rectangle;
+    std::tie(vertices, rectangle) = renderVerticesInternal(font, cache, size, text, alignment, pool);
+
+    /* The quads are axis-aligned, so the bottom left and top right vertex
+       is enough to reconstruct each of them */
+    std::vector<GlyphInstance> instances;
+    instances.reserve(vertices.size()/4);
+    for(std::size_t i = 0; i != vertices.size(); i += 4) {
+        const Vertex& bottomLeft = vertices[i + 1];
+        const Vertex& topRight = vertices[i + 2];
+        instances.push_back({bottomLeft.position,
+            topRight.position - bottomLeft.position,
+            Math::pack<Math::Vector4<UnsignedShort>>(Vector4{
+                bottomLeft.textureCoordinates.x(), bottomLeft.textureCoordinates.y(),
+                topRight.textureCoordinates.x(), topRight.textureCoordinates.y()})});
+    }
+
+    return std::make_tuple(std::move(instances), rectangle);
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+/* Four-vertex triangle strip with one glyph per instance, the quad corners
+   are generated in the vertex shader from gl_VertexID */
+template<UnsignedInt dimensions> void configureInstancedMesh(Mesh& mesh, Buffer& instanceBuffer, const UnsignedInt glyphCount) {
+    typedef typename Shaders::AbstractVector<dimensions>::GlyphRectangle GlyphRectangle;
+    typedef typename Shaders::AbstractVector<dimensions>::GlyphTextureRectangle GlyphTextureRectangle;
+    mesh.setPrimitive(MeshPrimitive::TriangleStrip)
+        .setCount(4)
+        .setInstanceCount(glyphCount)
+        .addVertexBufferInstanced(instanceBuffer, 1, 0,
+            GlyphRectangle{},
+            GlyphTextureRectangle{GlyphTextureRectangle::DataType::UnsignedShort, GlyphTextureRectangle::DataOption::Normalized});
+}
+
+template<UnsignedInt dimensions> std::tuple<Mesh, Range2D> renderInstancedMeshInternal(AbstractFont& font, const GlyphCache& cache, Float size, const std::string& text, Buffer& instanceBuffer, BufferUsage usage, Alignment alignment, ThreadPool* const pool) {
+    std::vector<GlyphInstance> instances;
+    Range2D rectangle;
+    std::tie(instances, rectangle) = renderInstancesInternal(font, cache, size, text, alignment, pool);
+    instanceBuffer.setData(instances, usage);
+
+    Mesh mesh;
+    configureInstancedMesh<dimensions>(mesh, instanceBuffer, instances.size());
+    return std::make_tuple(std::move(mesh), rectangle);
+}
+#endif
+
+}
+
+std::tuple<std::vector<Vector2>, std::vector<Vector2>, std::vector<UnsignedInt>, Range2D> AbstractRenderer::render(AbstractFont& font, const GlyphCache& cache, Float size, const std::string& text, Alignment alignment) {
+    return renderDataInternal(font, cache, size, text, alignment, nullptr);
+}
+
+std::tuple<std::vector<Vector2>, std::vector<Vector2>, std::vector<UnsignedInt>, Range2D> AbstractRenderer::render(AbstractFont& font, const GlyphCache& cache, Float size, const std::string& text, Alignment alignment, ThreadPool& pool) {
+    return renderDataInternal(font, cache, size, text, alignment, &pool);
+}
+
+std::tuple<std::vector<GlyphInstance>, Range2D> AbstractRenderer::renderInstances(AbstractFont& font, const GlyphCache& cache, Float size, const std::string& text, Alignment alignment) {
+    return renderInstancesInternal(font, cache, size, text, alignment, nullptr);
+}
+
+std::tuple<std::vector<GlyphInstance>, Range2D> AbstractRenderer::renderInstances(AbstractFont& font, const GlyphCache& cache, Float size, const std::string& text, Alignment alignment, ThreadPool& pool) {
+    return renderInstancesInternal(font, cache, size, text, alignment, &pool);
+}
+
 template<UnsignedInt dimensions> std::tuple<Mesh, Range2D> Renderer<dimensions>::render(AbstractFont& font, const GlyphCache& cache, Float size, const std::string& text, Buffer& vertexBuffer, Buffer& indexBuffer, BufferUsage usage, Alignment alignment) {
-    /* Finalize mesh configuration and return the result */
-    auto r = renderInternal(font, cache, size, text, vertexBuffer, indexBuffer, usage, alignment);
-    Mesh& mesh = std::get<0>(r);
-    mesh.addVertexBuffer(vertexBuffer, 0,
-            typename Shaders::AbstractVector<dimensions>::Position(
-                Shaders::AbstractVector<dimensions>::Position::Components::Two),
-            typename Shaders::AbstractVector<dimensions>::TextureCoordinates());
-    return r;
+    return renderMeshInternal<dimensions>(font, cache, size, text, vertexBuffer, indexBuffer, usage, alignment, nullptr);
 }
 
+template<UnsignedInt dimensions> std::tuple<Mesh, Range2D> Renderer<dimensions>::render(AbstractFont& font, const GlyphCache& cache, Float size, const std::string& text, Buffer& vertexBuffer, Buffer& indexBuffer, BufferUsage usage, Alignment alignment, ThreadPool& pool) {
+    return renderMeshInternal<dimensions>(font, cache, size, text, vertexBuffer, indexBuffer, usage, alignment, &pool);
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+template<UnsignedInt dimensions> std::tuple<Mesh, Range2D> Renderer<dimensions>::renderInstanced(AbstractFont& font, const GlyphCache& cache, Float size, const std::string& text, Buffer& instanceBuffer, BufferUsage usage, Alignment alignment) {
+    return renderInstancedMeshInternal<dimensions>(font, cache, size, text, instanceBuffer, usage, alignment, nullptr);
+}
+
+template<UnsignedInt dimensions> std::tuple<Mesh, Range2D> Renderer<dimensions>::renderInstanced(AbstractFont& font, const GlyphCache& cache, Float size, const std::string& text, Buffer& instanceBuffer, BufferUsage usage, Alignment alignment, ThreadPool& pool) {
+    return renderInstancedMeshInternal<dimensions>(font, cache, size, text, instanceBuffer, usage, alignment, &pool);
+}
+#endif
+
 #if defined(MAGNUM_TARGET_GLES2) && !defined(CORRADE_TARGET_EMSCRIPTEN)
 AbstractRenderer::BufferMapImplementation AbstractRenderer::bufferMapImplementation = &AbstractRenderer::bufferMapImplementationFull;
 AbstractRenderer::BufferUnmapImplementation AbstractRenderer::bufferUnmapImplementation = &AbstractRenderer::bufferUnmapImplementationDefault;
 
-void* AbstractRenderer::bufferMapImplementationFull(Buffer& buffer, GLsizeiptr) {
-    return buffer.map(Buffer::MapAccess::WriteOnly);
+void* AbstractRenderer::bufferMapImplementationFull(Buffer& buffer, const GLintptr offset, GLsizeiptr, bool) {
+    char* const data = static_cast<char*>(buffer.map(Buffer::MapAccess::WriteOnly));
+    return data ? data + offset : nullptr;
 }
 #endif
 
 #if !defined(MAGNUM_TARGET_GLES2) || defined(CORRADE_TARGET_EMSCRIPTEN)
-inline void* AbstractRenderer::bufferMapImplementation(Buffer& buffer, GLsizeiptr length)
+inline void* AbstractRenderer::bufferMapImplementation(Buffer& buffer, const GLintptr offset, const GLsizeiptr length, const bool invalidateBuffer)
 #else
-void* AbstractRenderer::bufferMapImplementationRange(Buffer& buffer, GLsizeiptr length)
+void* AbstractRenderer::bufferMapImplementationRange(Buffer& buffer, const GLintptr offset, const GLsizeiptr length, const bool invalidateBuffer)
 #endif
 {
     #ifndef CORRADE_TARGET_EMSCRIPTEN
-    return buffer.map(0, length, Buffer::MapFlag::InvalidateBuffer|Buffer::MapFlag::Write);
+    return buffer.map(offset, length, (invalidateBuffer ? Buffer::MapFlag::InvalidateBuffer : Buffer::MapFlag::InvalidateRange)|Buffer::MapFlag::Write);
     #else
     static_cast<void>(length);
-    return &buffer == &_indexBuffer ? _indexBufferData : _vertexBufferData;
+    static_cast<void>(invalidateBuffer);
+    return (&buffer == &_indexBuffer ? _indexBufferData : _vertexBufferData).data() + offset;
     #endif
 }
 
 #if !defined(MAGNUM_TARGET_GLES2) || defined(CORRADE_TARGET_EMSCRIPTEN)
-inline void AbstractRenderer::bufferUnmapImplementation(Buffer& buffer)
+inline void AbstractRenderer::bufferUnmapImplementation(Buffer& buffer, const GLintptr offset, const GLsizeiptr length)
 #else
-void AbstractRenderer::bufferUnmapImplementationDefault(Buffer& buffer)
+void AbstractRenderer::bufferUnmapImplementationDefault(Buffer& buffer, const GLintptr offset, const GLsizeiptr length)
 #endif
 {
     #ifndef CORRADE_TARGET_EMSCRIPTEN
+    static_cast<void>(offset);
+    static_cast<void>(length);
     buffer.unmap();
     #else
-    buffer.setSubData(0, &buffer == &_indexBuffer ? _indexBufferData : _vertexBufferData);
+    /* Upload only the updated range */
+    const Containers::Array<UnsignedByte>& data = &buffer == &_indexBuffer ? _indexBufferData : _vertexBufferData;
+    buffer.setSubData(offset, Containers::ArrayView<const UnsignedByte>{data.data() + offset, std::size_t(length)});
     #endif
 }
 
-AbstractRenderer::AbstractRenderer(AbstractFont& font, const GlyphCache& cache, const Float size, const Alignment alignment): _vertexBuffer{Buffer::TargetHint::Array}, _indexBuffer{Buffer::TargetHint::ElementArray}, font(font), cache(cache), size(size), _alignment(alignment), _capacity(0) {
+AbstractRenderer::AbstractRenderer(AbstractFont& font, const GlyphCache& cache, const Float size, const Alignment alignment): _vertexBuffer{Buffer::TargetHint::Array}, _indexBuffer{Buffer::TargetHint::ElementArray}, font(font), cache(cache), size(size), _alignment(alignment), _capacity(0), _incremental(false), _alignmentOffsetY(0.0f), _threadPool(nullptr) {
     #ifndef MAGNUM_TARGET_GLES
     MAGNUM_ASSERT_EXTENSION_SUPPORTED(Extensions::GL::ARB::map_buffer_range);
     #elif defined(MAGNUM_TARGET_GLES2) && !defined(CORRADE_TARGET_EMSCRIPTEN)
@@ -347,18 +484,40 @@ void AbstractRenderer::reserve(const uint32_t glyphCount, const BufferUsage vert
         .setIndexBuffer(_indexBuffer, 0, indexType, 0, vertexCount);
 
     /* Prefill index buffer */
-    char* const indices = static_cast<char*>(bufferMapImplementation(_indexBuffer, indexData.size()));
+    char* const indices = static_cast<char*>(bufferMapImplementation(_indexBuffer, 0, indexData.size(), true));
     CORRADE_INTERNAL_ASSERT(indices);
     /** @todo Emscripten: it can be done without this copying altogether */
     std::copy(indexData.begin(), indexData.end(), indices);
-    bufferUnmapImplementation(_indexBuffer);
+    bufferUnmapImplementation(_indexBuffer, 0, indexData.size());
+
+    /* Vertex buffer contents are gone, everything has to be rendered again */
+    _lines.clear();
+}
+
+AbstractRenderer& AbstractRenderer::setIncremental(const bool enabled) {
+    _incremental = enabled;
+
+    /* Free the remembered data. When enabling, the first render uploads
+       everything. */
+    std::vector<Implementation::RendererLine>{}.swap(_lines);
+    return *this;
+}
+
+AbstractRenderer& AbstractRenderer::setThreadPool(ThreadPool* const pool) {
+    _threadPool = pool;
+    return *this;
 }
 
 void AbstractRenderer::render(const std::string& text) {
+    if(_incremental) {
+        renderIncremental(text);
+        return;
+    }
+
     /* Render vertex data */
     std::vector<Vertex> vertexData;
     _rectangle = {};
-    std::tie(vertexData, _rectangle) = renderVerticesInternal(font, cache, size, text, _alignment);
+    std::tie(vertexData, _rectangle) = renderVerticesInternal(font, cache, size, text, _alignment, _threadPool);
 
     const UnsignedInt glyphCount = vertexData.size()/4;
     const UnsignedInt vertexCount = glyphCount*4;
@@ -368,19 +527,301 @@ void AbstractRenderer::render(const std::string& text) {
         "Text::Renderer::render(): capacity" << _capacity << "too small to render" << glyphCount << "glyphs", );
 
     /* Interleave the data into mapped buffer*/
-    Containers::ArrayView<Vertex> vertices(static_cast<Vertex*>(bufferMapImplementation(_vertexBuffer,
-        vertexCount*sizeof(Vertex))), vertexCount);
+    Containers::ArrayView<Vertex> vertices(static_cast<Vertex*>(bufferMapImplementation(_vertexBuffer, 0,
+        vertexCount*sizeof(Vertex), true)), vertexCount);
     CORRADE_INTERNAL_ASSERT_OUTPUT(vertices);
     std::copy(vertexData.begin(), vertexData.end(), vertices.begin());
-    bufferUnmapImplementation(_vertexBuffer);
+    bufferUnmapImplementation(_vertexBuffer, 0, vertexCount*sizeof(Vertex));
 
     /* Update index count */
     _mesh.setCount(indexCount);
 }
 
+void AbstractRenderer::renderIncremental(const std::string& text) {
+    const Vector2 lineAdvance = Vector2::yAxis(font.lineHeight()*size/font.size());
+
+    /* Vertex range that needs to be uploaded */
+    std::size_t dirtyBegin = ~std::size_t{}, dirtyEnd = 0;
+
+    /* Go through all lines, lay out again only lines that changed since the
+       last time. Lines are compared by index, so inserting a line causes all
+       following lines to be laid out again. */
+    std::string line;
+    std::size_t lineId = 0, vertexCount = 0;
+    Vector2 linePosition;
+    std::size_t pos, prevPos = 0;
+    do {
+        pos = text.find('\n', prevPos);
+        line.assign(text, prevPos, pos-prevPos);
+
+        if(lineId == _lines.size()) _lines.push_back({{}, {}, {}, ~std::size_t{}});
+        Implementation::RendererLine& l = _lines[lineId];
+
+        /* The line changed, lay it out again */
+        bool dirty = false;
+        if(l.vertexOffset == ~std::size_t{} || l.text != line) {
+            l.text = line;
+            l.vertices.clear();
+            l.rectangle = {};
+            if(!line.empty()) {
+                l.vertices.reserve(line.size()*4);
+                l.rectangle = renderLineInternal(font, cache, size, line, linePosition, _alignment, l.vertices);
+            }
+            dirty = true;
+        }
+
+        /* The line didn't change but a line before it changed glyph count,
+           so it needs to be moved in the buffer */
+        if(l.vertexOffset != vertexCount) {
+            l.vertexOffset = vertexCount;
+            dirty = true;
+        }
+
+        if(dirty && !l.vertices.empty()) {
+            dirtyBegin = Math::min(dirtyBegin, vertexCount);
+            dirtyEnd = vertexCount + l.vertices.size();
+        }
+
+        vertexCount += l.vertices.size();
+
+    /* Move to next line */
+    } while(prevPos = pos+1,
+            linePosition -= lineAdvance,
+            ++lineId,
+            pos != std::string::npos);
+
+    /* Forget lines that are not in the text anymore */
+    _lines.erase(_lines.begin() + lineId, _lines.end());
+
+    const UnsignedInt glyphCount = vertexCount/4;
+    CORRADE_ASSERT(glyphCount <= _capacity,
+        "Text::Renderer::render(): capacity" << _capacity << "too small to render" << glyphCount << "glyphs", );
+
+    /* Total bounds. Empty lines are skipped the same way as in the full
+       rendering, except for the last one. */
+    Range2D rectangle;
+    for(const Implementation::RendererLine& l: _lines)
+        if(!l.text.empty() || &l == &_lines.back()) addLineRectangle(rectangle, l.rectangle);
+
+    /* If the vertical alignment changed, everything needs to be moved */
+    const Float alignmentOffsetY = verticalAlignmentOffset(rectangle, _alignment);
+    if(alignmentOffsetY != _alignmentOffsetY) {
+        _alignmentOffsetY = alignmentOffsetY;
+        dirtyBegin = 0;
+        dirtyEnd = vertexCount;
+    }
+    _rectangle = rectangle.translated(Vector2::yAxis(alignmentOffsetY));
+
+    /* Upload only the changed range, lines between two changed lines are
+       uploaded as well */
+    if(dirtyBegin < dirtyEnd) {
+        Containers::ArrayView<Vertex> vertices(static_cast<Vertex*>(bufferMapImplementation(_vertexBuffer,
+            dirtyBegin*sizeof(Vertex), (dirtyEnd - dirtyBegin)*sizeof(Vertex), false)), dirtyEnd - dirtyBegin);
+        CORRADE_INTERNAL_ASSERT_OUTPUT(vertices);
+        for(const Implementation::RendererLine& l: _lines) {
+            if(l.vertexOffset + l.vertices.size() <= dirtyBegin) continue;
+            if(l.vertexOffset >= dirtyEnd) break;
+
+            for(std::size_t i = 0; i != l.vertices.size(); ++i) {
+                Vertex& out = vertices[l.vertexOffset + i - dirtyBegin];
+                out = l.vertices[i];
+                out.position.y() += alignmentOffsetY;
+            }
+        }
+        bufferUnmapImplementation(_vertexBuffer, dirtyBegin*sizeof(Vertex), (dirtyEnd - dirtyBegin)*sizeof(Vertex));
+    }
+
+    /* Update index count */
+    _mesh.setCount(glyphCount*6);
+}
+
+namespace {
+
+template<UnsignedInt dimensions> struct BatchVertex {
+    VectorTypeFor<dimensions, Float> position;
+    Vector2 textureCoordinates;
+};
+
+inline Vector2 transformPosition(const Matrix3& transformation, const Vector2& position) {
+    return transformation.transformPoint(position);
+}
+
+inline Vector3 transformPosition(const Matrix4& transformation, const Vector2& position) {
+    return transformation.transformPoint({position, 0.0f});
+}
+
+inline bool colorLess(const Color4& a, const Color4& b) {
+    return std::lexicographical_compare(a.data(), a.data() + 4, b.data(), b.data() + 4);
+}
+
+}
+
+template<UnsignedInt dimensions> BatchRenderer<dimensions>::BatchRenderer(AbstractFont& font, const GlyphCache& cache, const Float size, const Alignment alignment): _font(font), _cache(cache), _size(size), _alignment(alignment), _vertexBuffer{Buffer::TargetHint::Array}, _indexBuffer{Buffer::TargetHint::ElementArray}, _capacity(0), _glyphCount(0), _dirty(false) {
+    _mesh.setPrimitive(MeshPrimitive::Triangles)
+        .addVertexBuffer(_vertexBuffer, 0,
+            typename Shaders::AbstractVector<dimensions>::Position(),
+            typename Shaders::AbstractVector<dimensions>::TextureCoordinates());
+}
+
+template<UnsignedInt dimensions> BatchRenderer<dimensions>::~BatchRenderer() = default;
+
+template<UnsignedInt dimensions> void BatchRenderer<dimensions>::reserve(const UnsignedInt glyphCount, const BufferUsage vertexBufferUsage, const BufferUsage indexBufferUsage) {
+    _capacity = glyphCount;
+
+    const UnsignedInt vertexCount = glyphCount*4;
+    _vertexBuffer.setData({nullptr, vertexCount*sizeof(BatchVertex<dimensions>)}, vertexBufferUsage);
+
+    /* The index buffer is shared by all labels, so it can be filled just
+       once */
+    Containers::Array<char> indexData;
+    Mesh::IndexType indexType;
+    std::tie(indexData, indexType) = renderIndicesInternal(glyphCount);
+    _indexBuffer.setData(indexData, indexBufferUsage);
+    _mesh.setCount(0)
+        .setIndexBuffer(_indexBuffer, 0, indexType, 0, vertexCount);
+
+    /* Vertex buffer contents are gone, everything has to be uploaded again */
+    _dirty = true;
+}
+
+template<UnsignedInt dimensions> UnsignedInt BatchRenderer<dimensions>::addLabel(const std::string& text, const MatrixTypeFor<dimensions, Float>& transformation, const Color4& color) {
+    Implementation::BatchRendererLabel<dimensions> label;
+    label.text = text;
+    std::tie(label.vertices, label.rectangle) = renderVerticesInternal(_font, _cache, _size, text, _alignment);
+    label.transformation = transformation;
+    label.color = color;
+    _labels.push_back(std::move(label));
+    _dirty = true;
+    return _labels.size() - 1;
+}
+
+template<UnsignedInt dimensions> BatchRenderer<dimensions>& BatchRenderer<dimensions>::setLabelText(const UnsignedInt id, const std::string& text) {
+    CORRADE_ASSERT(id < _labels.size(),
+        "Text::BatchRenderer::setLabelText(): index" << id << "out of range for" << _labels.size() << "labels", *this);
+    Implementation::BatchRendererLabel<dimensions>& label = _labels[id];
+    if(label.text == text) return *this;
+
+    label.text = text;
+    std::tie(label.vertices, label.rectangle) = renderVerticesInternal(_font, _cache, _size, text, _alignment);
+    _dirty = true;
+    return *this;
+}
+
+template<UnsignedInt dimensions> BatchRenderer<dimensions>& BatchRenderer<dimensions>::setLabelTransformation(const UnsignedInt id, const MatrixTypeFor<dimensions, Float>& transformation) {
+    CORRADE_ASSERT(id < _labels.size(),
+        "Text::BatchRenderer::setLabelTransformation(): index" << id << "out of range for" << _labels.size() << "labels", *this);
+    _labels[id].transformation = transformation;
+    _dirty = true;
+    return *this;
+}
+
+template<UnsignedInt dimensions> BatchRenderer<dimensions>& BatchRenderer<dimensions>::setLabelColor(const UnsignedInt id, const Color4& color) {
+    CORRADE_ASSERT(id < _labels.size(),
+        "Text::BatchRenderer::setLabelColor(): index" << id << "out of range for" << _labels.size() << "labels", *this);
+    _labels[id].color = color;
+    _dirty = true;
+    return *this;
+}
+
+template<UnsignedInt dimensions> Range2D BatchRenderer<dimensions>::labelRectangle(const UnsignedInt id) const {
+    CORRADE_ASSERT(id < _labels.size(),
+        "Text::BatchRenderer::labelRectangle(): index" << id << "out of range for" << _labels.size() << "labels", {});
+    return _labels[id].rectangle;
+}
+
+template<UnsignedInt dimensions> void BatchRenderer<dimensions>::clear() {
+    _labels.clear();
+    _dirty = true;
+}
+
+template<UnsignedInt dimensions> void BatchRenderer<dimensions>::update() {
+    if(!_dirty) return;
+
+    std::size_t vertexCount = 0;
+    for(const Implementation::BatchRendererLabel<dimensions>& label: _labels)
+        vertexCount += label.vertices.size();
+    const UnsignedInt glyphCount = vertexCount/4;
+    CORRADE_ASSERT(glyphCount <= _capacity,
+        "Text::BatchRenderer::update(): capacity" << _capacity << "too small to render" << glyphCount << "glyphs", );
+
+    /* Group the labels by color so each color needs just one draw call, keep
+       the original order among labels of the same color. The temporaries
+       are taken from the per-frame allocator, if there's any. */
+    std::vector<UnsignedInt, FrameAllocatorAdapter<UnsignedInt>> order(_labels.size(), 0);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [this](UnsignedInt a, UnsignedInt b) {
+        return colorLess(_labels[a].color, _labels[b].color);
+    });
+
+    /* Transform all vertices and collect draw ranges */
+    std::vector<BatchVertex<dimensions>, FrameAllocatorAdapter<BatchVertex<dimensions>>> vertices;
+    vertices.reserve(vertexCount);
+    _drawRanges.clear();
+    for(const UnsignedInt id: order) {
+        const Implementation::BatchRendererLabel<dimensions>& label = _labels[id];
+        if(label.vertices.empty()) continue;
+
+        if(_drawRanges.empty() || _drawRanges.back().color != label.color)
+            _drawRanges.push_back({label.color, UnsignedInt(vertices.size()/4), 0});
+
+        for(const Vertex& v: label.vertices)
+            vertices.push_back({transformPosition(label.transformation, v.position), v.textureCoordinates});
+        _drawRanges.back().glyphCount += label.vertices.size()/4;
+    }
+
+    /* Upload everything at once */
+    if(!vertices.empty()) _vertexBuffer.setSubData(0, {vertices.data(), vertices.size()});
+
+    _glyphCount = glyphCount;
+    _mesh.setCount(glyphCount*6);
+    _dirty = false;
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+template<UnsignedInt dimensions> InstancedRenderer<dimensions>::InstancedRenderer(AbstractFont& font, const GlyphCache& cache, const Float size, const Alignment alignment): _font(font), _cache(cache), _size(size), _alignment(alignment), _capacity(0), _threadPool(nullptr), _instanceBuffer{Buffer::TargetHint::Array} {
+    configureInstancedMesh<dimensions>(_mesh, _instanceBuffer, 0);
+}
+
+template<UnsignedInt dimensions> InstancedRenderer<dimensions>::~InstancedRenderer() = default;
+
+template<UnsignedInt dimensions> InstancedRenderer<dimensions>& InstancedRenderer<dimensions>::setThreadPool(ThreadPool* const pool) {
+    _threadPool = pool;
+    return *this;
+}
+
+template<UnsignedInt dimensions> void InstancedRenderer<dimensions>::reserve(const UnsignedInt glyphCount, const BufferUsage usage) {
+    _capacity = glyphCount;
+
+    /* Allocate the instance buffer, the rendered text is gone */
+    _instanceBuffer.setData({nullptr, glyphCount*sizeof(GlyphInstance)}, usage);
+    _mesh.setInstanceCount(0);
+    _rectangle = {};
+}
+
+template<UnsignedInt dimensions> void InstancedRenderer<dimensions>::render(const std::string& text) {
+    std::vector<GlyphInstance> instances;
+    Range2D rectangle;
+    std::tie(instances, rectangle) = renderInstancesInternal(_font, _cache, _size, text, _alignment, _threadPool);
+
+    CORRADE_ASSERT(instances.size() <= _capacity,
+        "Text::InstancedRenderer::render(): capacity" << _capacity << "too small to render" << instances.size() << "glyphs", );
+
+    /* Upload just the instances, there's no index buffer to update */
+    if(!instances.empty()) _instanceBuffer.setSubData(0, instances);
+    _mesh.setInstanceCount(instances.size());
+    _rectangle = rectangle;
+}
+#endif
+
 #ifndef DOXYGEN_GENERATING_OUTPUT
 template class MAGNUM_TEXT_EXPORT Renderer<2>;
 template class MAGNUM_TEXT_EXPORT Renderer<3>;
+template class MAGNUM_TEXT_EXPORT BatchRenderer<2>;
+template class MAGNUM_TEXT_EXPORT BatchRenderer<3>;
+#ifndef MAGNUM_TARGET_GLES2
+template class MAGNUM_TEXT_EXPORT InstancedRenderer<2>;
+template class MAGNUM_TEXT_EXPORT InstancedRenderer<3>;
+#endif
 #endif
 
 }}
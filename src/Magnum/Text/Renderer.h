@@ -26,17 +26,22 @@
 */
 
 /** @file Text/Renderer.h
- * @brief Class @ref Magnum::Text::AbstractRenderer, @ref Magnum::Text::Renderer, typedef @ref Magnum::Text::Renderer2D, @ref Magnum::Text::Renderer3D
+ * @brief Class @ref Magnum::Text::AbstractRenderer, @ref Magnum::Text::Renderer, @ref Magnum::Text::BatchRenderer, @ref Magnum::Text::InstancedRenderer, struct @ref Magnum::Text::GlyphInstance, typedef @ref Magnum::Text::Renderer2D, @ref Magnum::Text::Renderer3D, @ref Magnum::Text::BatchRenderer2D, @ref Magnum::Text::BatchRenderer3D, @ref Magnum::Text::InstancedRenderer2D, @ref Magnum::Text::InstancedRenderer3D
  */
 
 #include <string>
 #include <tuple>
 #include <vector>
+#include <Corrade/Utility/Assert.h>
 
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Math/Matrix4.h"
 #include "Magnum/Math/Range.h"
 #include "Magnum/Buffer.h"
 #include "Magnum/DimensionTraits.h"
 #include "Magnum/Mesh.h"
+#include "Magnum/MeshView.h"
 #include "Magnum/Text/Text.h"
 #include "Magnum/Text/Alignment.h"
 #include "Magnum/Text/visibility.h"
@@ -47,6 +52,57 @@
 
 namespace Magnum { namespace Text {
 
+#ifndef DOXYGEN_GENERATING_OUTPUT
+namespace Implementation {
+    struct RendererVertex {
+        Vector2 position, textureCoordinates;
+    };
+
+    /* Line kept for incremental rendering. Vertices are aligned
+       horizontally, but without the vertical alignment offset. */
+    struct RendererLine {
+        std::string text;
+        std::vector<RendererVertex> vertices;
+        Range2D rectangle;
+        std::size_t vertexOffset;
+    };
+
+    /* Label kept in a batch renderer, vertices are without the label
+       transformation applied */
+    template<UnsignedInt dimensions> struct BatchRendererLabel {
+        std::string text;
+        std::vector<RendererVertex> vertices;
+        Range2D rectangle;
+        MatrixTypeFor<dimensions, Float> transformation;
+        Color4 color;
+    };
+}
+#endif
+
+/**
+@brief Glyph instance
+
+One compact record per glyph, expanded to a quad in the vertex shader. Used by
+@ref AbstractRenderer::renderInstances(), @ref Renderer::renderInstanced() and
+@ref InstancedRenderer, see @ref Text-Renderer-instanced for more information.
+*/
+struct GlyphInstance {
+    /** @brief Bottom left corner of the glyph quad */
+    Vector2 position;
+
+    /** @brief Size of the glyph quad */
+    Vector2 size;
+
+    /**
+     * @brief Glyph texture coordinates
+     *
+     * Bottom left texture coordinates in the first two components, top right
+     * in the other two, packed to normalized 16-bit integers. That's
+     * precise enough for glyph cache textures of any practical size.
+     */
+    Math::Vector4<UnsignedShort> textureCoordinates;
+};
+
 /**
 @brief Base for text renderers
 
@@ -68,6 +124,39 @@ class MAGNUM_TEXT_EXPORT AbstractRenderer {
          */
         static std::tuple<std::vector<Vector2>, std::vector<Vector2>, std::vector<UnsignedInt>, Range2D> render(AbstractFont& font, const GlyphCache& cache, Float size, const std::string& text, Alignment alignment = Alignment::LineLeft);
 
+        /**
+         * @brief Render text using a thread pool
+         *
+         * Same as @ref render(AbstractFont&, const GlyphCache&, Float, const std::string&, Alignment),
+         * but the lines are laid out in parallel on threads of @p pool. See
+         * @ref Text-Renderer-threads for more information.
+         */
+        static std::tuple<std::vector<Vector2>, std::vector<Vector2>, std::vector<UnsignedInt>, Range2D> render(AbstractFont& font, const GlyphCache& cache, Float size, const std::string& text, Alignment alignment, ThreadPool& pool);
+
+        /**
+         * @brief Render text as glyph instances
+         * @param font          Font
+         * @param cache         Glyph cache
+         * @param size          Font size
+         * @param text          Text to render
+         * @param alignment     Text alignment
+         *
+         * Returns tuple with one @ref GlyphInstance per glyph and rectangle
+         * spanning the rendered text. The layout is the same as with
+         * @ref render(AbstractFont&, const GlyphCache&, Float, const std::string&, Alignment).
+         * See @ref Text-Renderer-instanced for more information.
+         */
+        static std::tuple<std::vector<GlyphInstance>, Range2D> renderInstances(AbstractFont& font, const GlyphCache& cache, Float size, const std::string& text, Alignment alignment = Alignment::LineLeft);
+
+        /**
+         * @brief Render text as glyph instances using a thread pool
+         *
+         * Same as @ref renderInstances(AbstractFont&, const GlyphCache&, Float, const std::string&, Alignment),
+         * but the lines are laid out in parallel on threads of @p pool. See
+         * @ref Text-Renderer-threads for more information.
+         */
+        static std::tuple<std::vector<GlyphInstance>, Range2D> renderInstances(AbstractFont& font, const GlyphCache& cache, Float size, const std::string& text, Alignment alignment, ThreadPool& pool);
+
         /**
          * @brief Capacity for rendered glyphs
          *
@@ -101,6 +190,50 @@ class MAGNUM_TEXT_EXPORT AbstractRenderer {
          */
         void reserve(UnsignedInt glyphCount, BufferUsage vertexBufferUsage, BufferUsage indexBufferUsage);
 
+        /**
+         * @brief Whether incremental rendering is enabled
+         *
+         * @see @ref setIncremental()
+         */
+        bool isIncremental() const { return _incremental; }
+
+        /**
+         * @brief Enable or disable incremental rendering
+         * @return Reference to self (for method chaining)
+         *
+         * If enabled, @ref render() remembers the laid out lines and on
+         * subsequent calls lays out again only lines that differ from the
+         * previous text. Only the vertex range that actually changed is then
+         * written to the vertex buffer. This is useful for large texts where
+         * only a small part changes between frames, at the cost of keeping a
+         * copy of the vertex data in memory. If a line changes its glyph
+         * count, all following lines need to be moved in the buffer; if the
+         * vertical alignment offset changes, the whole text is uploaded again.
+         *
+         * Disabling the incremental rendering frees the remembered data.
+         * Disabled by default.
+         */
+        AbstractRenderer& setIncremental(bool enabled);
+
+        /**
+         * @brief Thread pool used for layouting
+         *
+         * @see @ref setThreadPool()
+         */
+        ThreadPool* threadPool() const { return _threadPool; }
+
+        /**
+         * @brief Set thread pool used for layouting
+         * @return Reference to self (for method chaining)
+         *
+         * If set, @ref render() lays out the lines in parallel on threads of
+         * @p pool. See @ref Text-Renderer-threads for more information. The
+         * pool is not used if @ref setIncremental() "incremental rendering" is
+         * enabled. Pass @cpp nullptr @ce to lay out on the calling thread
+         * only, which is the default.
+         */
+        AbstractRenderer& setThreadPool(ThreadPool* pool);
+
         /**
          * @brief Render text
          *
@@ -108,7 +241,8 @@ class MAGNUM_TEXT_EXPORT AbstractRenderer {
          * filled with @ref reserve(). Rectangle spanning the rendered text is
          * available through @ref rectangle().
          *
-         * Initially no text is rendered.
+         * Initially no text is rendered. If @ref setIncremental() "incremental rendering"
+         * is enabled, only the changed lines are laid out and uploaded.
          * @attention The capacity must be large enough to contain all glyphs,
          *      see @ref reserve() for more information.
          */
@@ -136,11 +270,19 @@ class MAGNUM_TEXT_EXPORT AbstractRenderer {
         Alignment _alignment;
         UnsignedInt _capacity;
         Range2D _rectangle;
+        bool _incremental;
+        Float _alignmentOffsetY;
+        std::vector<Implementation::RendererLine> _lines;
+        ThreadPool* _threadPool;
+
+        MAGNUM_TEXT_LOCAL void renderIncremental(const std::string& text);
 
+        /* If invalidateBuffer is false, only the mapped range is
+           invalidated */
         #if defined(MAGNUM_TARGET_GLES2) && !defined(CORRADE_TARGET_EMSCRIPTEN)
-        typedef void*(*BufferMapImplementation)(Buffer&, GLsizeiptr);
-        static MAGNUM_TEXT_LOCAL void* bufferMapImplementationFull(Buffer& buffer, GLsizeiptr length);
-        static MAGNUM_TEXT_LOCAL void* bufferMapImplementationRange(Buffer& buffer, GLsizeiptr length);
+        typedef void*(*BufferMapImplementation)(Buffer&, GLintptr, GLsizeiptr, bool);
+        static MAGNUM_TEXT_LOCAL void* bufferMapImplementationFull(Buffer& buffer, GLintptr offset, GLsizeiptr length, bool invalidateBuffer);
+        static MAGNUM_TEXT_LOCAL void* bufferMapImplementationRange(Buffer& buffer, GLintptr offset, GLsizeiptr length, bool invalidateBuffer);
         static BufferMapImplementation bufferMapImplementation;
         #else
         #ifndef CORRADE_TARGET_EMSCRIPTEN
@@ -148,12 +290,12 @@ class MAGNUM_TEXT_EXPORT AbstractRenderer {
         #else
         MAGNUM_TEXT_LOCAL
         #endif
-        void* bufferMapImplementation(Buffer& buffer, GLsizeiptr length);
+        void* bufferMapImplementation(Buffer& buffer, GLintptr offset, GLsizeiptr length, bool invalidateBuffer);
         #endif
 
         #if defined(MAGNUM_TARGET_GLES2) && !defined(CORRADE_TARGET_EMSCRIPTEN)
-        typedef void(*BufferUnmapImplementation)(Buffer&);
-        static MAGNUM_TEXT_LOCAL void bufferUnmapImplementationDefault(Buffer& buffer);
+        typedef void(*BufferUnmapImplementation)(Buffer&, GLintptr, GLsizeiptr);
+        static MAGNUM_TEXT_LOCAL void bufferUnmapImplementationDefault(Buffer& buffer, GLintptr offset, GLsizeiptr length);
         static MAGNUM_TEXT_LOCAL BufferUnmapImplementation bufferUnmapImplementation;
         #else
         #ifndef CORRADE_TARGET_EMSCRIPTEN
@@ -161,7 +303,7 @@ class MAGNUM_TEXT_EXPORT AbstractRenderer {
         #else
         MAGNUM_TEXT_LOCAL
         #endif
-        void bufferUnmapImplementation(Buffer& buffer);
+        void bufferUnmapImplementation(Buffer& buffer, GLintptr offset, GLsizeiptr length);
         #endif
 };
 
@@ -190,6 +332,34 @@ that doesn't recreate everything on each text change:
 
 @snippet MagnumText.cpp Renderer-usage2
 
+@section Text-Renderer-threads Parallel layouting
+
+Each line of the text is laid out independently of the others. For large
+multi-line texts (such as logs or documents) the lines can be split into
+chunks laid out in parallel by passing a @ref ThreadPool to the static
+@ref render() overloads or to @ref setThreadPool(). The chunks are then
+concatenated in the original order, so the output is the same as when laid out
+on a single thread. The font is accessed from more than one thread at a time
+in this case, so its @ref AbstractFont::layout() implementation has to be
+thread-safe. That's the case for the @ref Text::MagnumFont "MagnumFont"
+plugin, but not necessarily for other plugins.
+
+@section Text-Renderer-instanced Instanced glyph rendering
+
+The default mesh layout uses four vertices with position and texture
+coordinates per glyph, which is 64 bytes of vertex data to upload for each
+glyph on every text change, together with an index buffer containing six
+indices per glyph. With @ref renderInstanced() or @ref InstancedRenderer each
+glyph is instead stored as a single 24-byte @ref GlyphInstance record and
+expanded to a quad in the vertex shader, and no index buffer is needed. Draw
+such meshes with @ref Shaders::Vector or @ref Shaders::DistanceFieldVector
+created with the `InstancedGlyphs` flag:
+
+@snippet MagnumText.cpp Renderer-instanced
+
+Instanced rendering needs @extension{ARB,instanced_arrays} and GLSL 1.30 on
+desktop OpenGL and is not available in OpenGL ES 2.0 and WebGL 1.0.
+
 @section Text-Renderer-required-opengl-functionality Required OpenGL functionality
 
 Mutable text rendering requires @extension{ARB,map_buffer_range} on desktop
@@ -219,6 +389,50 @@ template<UnsignedInt dimensions> class MAGNUM_TEXT_EXPORT Renderer: public Abstr
          */
         static std::tuple<Mesh, Range2D> render(AbstractFont& font, const GlyphCache& cache, Float size, const std::string& text, Buffer& vertexBuffer, Buffer& indexBuffer, BufferUsage usage, Alignment alignment = Alignment::LineLeft);
 
+        /**
+         * @brief Render text using a thread pool
+         *
+         * Same as @ref render(AbstractFont&, const GlyphCache&, Float, const std::string&, Buffer&, Buffer&, BufferUsage, Alignment),
+         * but the lines are laid out in parallel on threads of @p pool. See
+         * @ref Text-Renderer-threads for more information.
+         */
+        static std::tuple<Mesh, Range2D> render(AbstractFont& font, const GlyphCache& cache, Float size, const std::string& text, Buffer& vertexBuffer, Buffer& indexBuffer, BufferUsage usage, Alignment alignment, ThreadPool& pool);
+
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Render text as an instanced mesh
+         * @param font              Font
+         * @param cache             Glyph cache
+         * @param size              Font size
+         * @param text              Text to render
+         * @param instanceBuffer    Buffer where to store glyph instances
+         * @param usage             Usage of the instance buffer
+         * @param alignment         Text alignment
+         *
+         * Returns a non-indexed triangle strip mesh with four vertices and
+         * one instance per glyph, prepared for use with
+         * @ref Shaders::AbstractVector subclasses created with the
+         * `InstancedGlyphs` flag, and rectangle spanning the rendered text.
+         * See @ref Text-Renderer-instanced for more information.
+         * @requires_gl33 Extension @extension{ARB,instanced_arrays}
+         * @requires_gles30 Not available in OpenGL ES 2.0.
+         * @requires_webgl20 Not available in WebGL 1.0.
+         */
+        static std::tuple<Mesh, Range2D> renderInstanced(AbstractFont& font, const GlyphCache& cache, Float size, const std::string& text, Buffer& instanceBuffer, BufferUsage usage, Alignment alignment = Alignment::LineLeft);
+
+        /**
+         * @brief Render text as an instanced mesh using a thread pool
+         *
+         * Same as @ref renderInstanced(AbstractFont&, const GlyphCache&, Float, const std::string&, Buffer&, BufferUsage, Alignment),
+         * but the lines are laid out in parallel on threads of @p pool. See
+         * @ref Text-Renderer-threads for more information.
+         * @requires_gl33 Extension @extension{ARB,instanced_arrays}
+         * @requires_gles30 Not available in OpenGL ES 2.0.
+         * @requires_webgl20 Not available in WebGL 1.0.
+         */
+        static std::tuple<Mesh, Range2D> renderInstanced(AbstractFont& font, const GlyphCache& cache, Float size, const std::string& text, Buffer& instanceBuffer, BufferUsage usage, Alignment alignment, ThreadPool& pool);
+        #endif
+
         /**
          * @brief Constructor
          * @param font          Font
@@ -240,6 +454,311 @@ typedef Renderer<2> Renderer2D;
 /** @brief Three-dimensional text renderer */
 typedef Renderer<3> Renderer3D;
 
+/**
+@brief Batch text renderer
+
+Lays out many independent labels into a single vertex buffer sharing one
+index buffer, so the whole batch can be drawn with one draw call per distinct
+label color instead of one draw call per label as with @ref Renderer. Each
+label has its own text, transformation and color, all labels share the same
+font, glyph cache, size and alignment.
+
+@section Text-BatchRenderer-usage Usage
+
+Reserve capacity for all glyphs in the batch first, then add the labels,
+call @ref update() to upload the data and draw the batch with
+@ref Shaders::Vector or @ref Shaders::DistanceFieldVector:
+
+@snippet MagnumText.cpp BatchRenderer-usage
+
+Label text is laid out only when it changes, changes in label transformation
+or color are applied only by transforming the already laid out vertices again
+on the next @ref update() call. The vertices are transformed on the CPU, so
+the shader transformation should contain only the camera and projection
+matrix.
+
+The vector shaders have only a single color uniform, so labels are grouped by
+color in the vertex buffer and @ref draw() issues one draw call for each
+distinct color. Use as few distinct colors as possible to keep the draw call
+count low.
+
+@see @ref BatchRenderer2D, @ref BatchRenderer3D, @ref Renderer
+*/
+template<UnsignedInt dimensions> class MAGNUM_TEXT_EXPORT BatchRenderer {
+    public:
+        /**
+         * @brief Constructor
+         * @param font          Font
+         * @param cache         Glyph cache
+         * @param size          Font size
+         * @param alignment     Text alignment
+         */
+        explicit BatchRenderer(AbstractFont& font, const GlyphCache& cache, Float size, Alignment alignment = Alignment::LineLeft);
+        BatchRenderer(AbstractFont&, GlyphCache&&, Float, Alignment alignment = Alignment::LineLeft) = delete; /**< @overload */
+
+        /** @brief Copying is not allowed */
+        BatchRenderer(const BatchRenderer<dimensions>&) = delete;
+
+        /** @brief Copying is not allowed */
+        BatchRenderer<dimensions>& operator=(const BatchRenderer<dimensions>&) = delete;
+
+        ~BatchRenderer();
+
+        /**
+         * @brief Capacity for rendered glyphs
+         *
+         * @see @ref reserve()
+         */
+        UnsignedInt capacity() const { return _capacity; }
+
+        /**
+         * @brief Glyph count
+         *
+         * Count of glyphs in all labels at the time of last @ref update().
+         */
+        UnsignedInt glyphCount() const { return _glyphCount; }
+
+        /** @brief Label count */
+        std::size_t labelCount() const { return _labels.size(); }
+
+        /** @brief Vertex buffer */
+        Buffer& vertexBuffer() { return _vertexBuffer; }
+
+        /** @brief Index buffer */
+        Buffer& indexBuffer() { return _indexBuffer; }
+
+        /**
+         * @brief Mesh
+         *
+         * Contains all labels in the batch. Prefer to use @ref draw(), which
+         * sets the color for each group of labels.
+         */
+        Mesh& mesh() { return _mesh; }
+
+        /**
+         * @brief Reserve capacity for rendered glyphs
+         *
+         * Reallocates memory in buffers to hold @p glyphCount glyphs and
+         * prefills the index buffer. The vertex buffer contents are reset,
+         * so the data get uploaded again on next @ref update(). Initially
+         * zero capacity is reserved.
+         * @see @ref capacity()
+         */
+        void reserve(UnsignedInt glyphCount, BufferUsage vertexBufferUsage, BufferUsage indexBufferUsage);
+
+        /**
+         * @brief Add a label
+         * @param text              Label text
+         * @param transformation    Label transformation
+         * @param color             Label color
+         * @return ID of the label, to be used in @ref setLabelText(),
+         *      @ref setLabelTransformation() and @ref setLabelColor()
+         *
+         * The text is laid out immediately, the vertex buffer is updated on
+         * next @ref update() call.
+         */
+        UnsignedInt addLabel(const std::string& text, const MatrixTypeFor<dimensions, Float>& transformation, const Color4& color);
+
+        /**
+         * @brief Set label text
+         * @return Reference to self (for method chaining)
+         *
+         * The text is laid out again only if it differs from the previous
+         * one.
+         */
+        BatchRenderer<dimensions>& setLabelText(UnsignedInt id, const std::string& text);
+
+        /**
+         * @brief Set label transformation
+         * @return Reference to self (for method chaining)
+         */
+        BatchRenderer<dimensions>& setLabelTransformation(UnsignedInt id, const MatrixTypeFor<dimensions, Float>& transformation);
+
+        /**
+         * @brief Set label color
+         * @return Reference to self (for method chaining)
+         */
+        BatchRenderer<dimensions>& setLabelColor(UnsignedInt id, const Color4& color);
+
+        /**
+         * @brief Label rectangle
+         *
+         * Rectangle spanning the label text, without the label
+         * transformation applied.
+         */
+        Range2D labelRectangle(UnsignedInt id) const;
+
+        /** @brief Remove all labels */
+        void clear();
+
+        /**
+         * @brief Update the vertex buffer
+         *
+         * If any label changed since the last call, transforms vertices of
+         * all labels, groups them by color and uploads them in a single
+         * call. Expects that @ref capacity() is large enough to hold all
+         * glyphs. Temporary data are taken from
+         * @ref FrameAllocator::current(), if any allocator was made current
+         * using @ref FrameAllocator::makeCurrent().
+         */
+        void update();
+
+        /**
+         * @brief Draw the batch
+         * @return Count of issued draw calls
+         *
+         * Issues one draw call for each distinct label color, setting the
+         * color via @cpp shader.setColor() @ce. Expects that @ref update()
+         * was called after the last label change. The transformation
+         * projection matrix and vector texture have to be set on the shader
+         * beforehand.
+         */
+        template<class Shader> std::size_t draw(Shader& shader);
+
+    private:
+        struct DrawRange {
+            Color4 color;
+            UnsignedInt glyphOffset, glyphCount;
+        };
+
+        AbstractFont& _font;
+        const GlyphCache& _cache;
+        Float _size;
+        Alignment _alignment;
+        Buffer _vertexBuffer, _indexBuffer;
+        Mesh _mesh;
+        UnsignedInt _capacity, _glyphCount;
+        bool _dirty;
+        std::vector<Implementation::BatchRendererLabel<dimensions>> _labels;
+        std::vector<DrawRange> _drawRanges;
+};
+
+/** @brief Two-dimensional batch text renderer */
+typedef BatchRenderer<2> BatchRenderer2D;
+
+/** @brief Three-dimensional batch text renderer */
+typedef BatchRenderer<3> BatchRenderer3D;
+
+#ifndef MAGNUM_TARGET_GLES2
+/**
+@brief Instanced text renderer
+
+Mutable text renderer storing one @ref GlyphInstance per glyph instead of four
+vertices and six indices as @ref Renderer does, so each text change uploads
+less than half of the data and no index buffer is needed. The mesh has to be
+drawn with @ref Shaders::Vector or @ref Shaders::DistanceFieldVector created
+with the `InstancedGlyphs` flag. See @ref Text-Renderer-instanced for more
+information.
+@requires_gl33 Extension @extension{ARB,instanced_arrays}
+@requires_gles30 Not available in OpenGL ES 2.0.
+@requires_webgl20 Not available in WebGL 1.0.
+@see @ref InstancedRenderer2D, @ref InstancedRenderer3D
+*/
+template<UnsignedInt dimensions> class MAGNUM_TEXT_EXPORT InstancedRenderer {
+    public:
+        /**
+         * @brief Constructor
+         * @param font          Font
+         * @param cache         Glyph cache
+         * @param size          Font size
+         * @param alignment     Text alignment
+         */
+        explicit InstancedRenderer(AbstractFont& font, const GlyphCache& cache, Float size, Alignment alignment = Alignment::LineLeft);
+        InstancedRenderer(AbstractFont&, GlyphCache&&, Float, Alignment alignment = Alignment::LineLeft) = delete; /**< @overload */
+
+        /** @brief Copying is not allowed */
+        InstancedRenderer(const InstancedRenderer<dimensions>&) = delete;
+
+        /** @brief Copying is not allowed */
+        InstancedRenderer<dimensions>& operator=(const InstancedRenderer<dimensions>&) = delete;
+
+        ~InstancedRenderer();
+
+        /**
+         * @brief Capacity for rendered glyphs
+         *
+         * @see @ref reserve()
+         */
+        UnsignedInt capacity() const { return _capacity; }
+
+        /** @brief Rectangle spanning the rendered text */
+        Range2D rectangle() const { return _rectangle; }
+
+        /** @brief Instance buffer */
+        Buffer& instanceBuffer() { return _instanceBuffer; }
+
+        /** @brief Mesh */
+        Mesh& mesh() { return _mesh; }
+
+        /**
+         * @brief Thread pool used for layouting
+         *
+         * @see @ref setThreadPool()
+         */
+        ThreadPool* threadPool() const { return _threadPool; }
+
+        /**
+         * @brief Set thread pool used for layouting
+         * @return Reference to self (for method chaining)
+         *
+         * See @ref AbstractRenderer::setThreadPool() for more information.
+         */
+        InstancedRenderer<dimensions>& setThreadPool(ThreadPool* pool);
+
+        /**
+         * @brief Reserve capacity for rendered glyphs
+         *
+         * Reallocates memory in the instance buffer to hold @p glyphCount
+         * glyphs and resets the rendered text. Initially zero capacity is
+         * reserved.
+         * @see @ref capacity()
+         */
+        void reserve(UnsignedInt glyphCount, BufferUsage usage);
+
+        /**
+         * @brief Render text
+         *
+         * Lays out the text and uploads the glyph instances to the instance
+         * buffer. Rectangle spanning the rendered text is available through
+         * @ref rectangle(). Initially no text is rendered.
+         * @attention The capacity must be large enough to contain all glyphs,
+         *      see @ref reserve() for more information.
+         */
+        void render(const std::string& text);
+
+    private:
+        AbstractFont& _font;
+        const GlyphCache& _cache;
+        Float _size;
+        Alignment _alignment;
+        UnsignedInt _capacity;
+        Range2D _rectangle;
+        ThreadPool* _threadPool;
+        Buffer _instanceBuffer;
+        Mesh _mesh;
+};
+
+/** @brief Two-dimensional instanced text renderer */
+typedef InstancedRenderer<2> InstancedRenderer2D;
+
+/** @brief Three-dimensional instanced text renderer */
+typedef InstancedRenderer<3> InstancedRenderer3D;
+#endif
+
+template<UnsignedInt dimensions> template<class Shader> std::size_t BatchRenderer<dimensions>::draw(Shader& shader) {
+    CORRADE_ASSERT(!_dirty, "Text::BatchRenderer::draw(): the batch was changed since last update()", 0);
+
+    for(const DrawRange& range: _drawRanges) {
+        MeshView view{_mesh};
+        view.setCount(range.glyphCount*6)
+            .setIndexRange(range.glyphOffset*6, range.glyphOffset*4, (range.glyphOffset + range.glyphCount)*4);
+        shader.setColor(range.color);
+        view.draw(shader);
+    }
+
+    return _drawRanges.size();
+}
+
 }}
 
 #endif
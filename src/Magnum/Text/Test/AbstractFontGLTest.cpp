@@ -0,0 +1,300 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/OpenGLTester.h"
+#include "Magnum/ThreadPool.h"
+#include "Magnum/Text/AbstractFont.h"
+#include "Magnum/Text/GlyphCache.h"
+
+namespace Magnum { namespace Text { namespace Test {
+
+struct AbstractFontGLTest: OpenGLTester {
+    explicit AbstractFontGLTest();
+
+    void layoutCacheDisabled();
+    void layoutCache();
+    void layoutCacheKey();
+    void layoutCacheEvict();
+    void layoutCacheInvalidate();
+    void layoutCacheClose();
+
+    void fillGlyphCacheThreadPool();
+    void fillGlyphCacheThreadPoolParallel();
+};
+
+AbstractFontGLTest::AbstractFontGLTest() {
+    addTests({&AbstractFontGLTest::layoutCacheDisabled,
+              &AbstractFontGLTest::layoutCache,
+              &AbstractFontGLTest::layoutCacheKey,
+              &AbstractFontGLTest::layoutCacheEvict,
+              &AbstractFontGLTest::layoutCacheInvalidate,
+              &AbstractFontGLTest::layoutCacheClose,
+
+              &AbstractFontGLTest::fillGlyphCacheThreadPool,
+              &AbstractFontGLTest::fillGlyphCacheThreadPoolParallel});
+}
+
+namespace {
+
+/* Glyph ID is the character, texture coordinates are taken from the cache
+   so it's visible when the cache changes */
+class CacheLayouter: public AbstractLayouter {
+    public:
+        explicit CacheLayouter(const GlyphCache& cache, Float size, const std::string& text): AbstractLayouter(text.size()), _cache(cache), _size{size}, _text{text} {}
+
+    private:
+        std::tuple<Range2D, Range2D, Vector2> doRenderGlyph(const UnsignedInt i) override {
+            const Range2Di rectangle = _cache[UnsignedByte(_text[i])].second;
+            return std::make_tuple(Range2D{{}, Vector2{_size}}, Range2D{rectangle}, Vector2::xAxis(_size));
+        }
+
+        const GlyphCache& _cache;
+        Float _size;
+        std::string _text;
+};
+
+class CountingFont: public AbstractFont {
+    public:
+        explicit CountingFont(): layoutCount{}, opened{true} {}
+
+        std::size_t layoutCount;
+        bool opened;
+
+    private:
+        Features doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return opened; }
+        void doClose() override { opened = false; }
+
+        UnsignedInt doGlyphId(char32_t) override { return 0; }
+        Vector2 doGlyphAdvance(UnsignedInt) override { return {}; }
+
+        std::unique_ptr<AbstractLayouter> doLayout(const GlyphCache& cache, const Float size, const std::string& text) override {
+            ++layoutCount;
+            return std::unique_ptr<AbstractLayouter>{new CacheLayouter{cache, size, text}};
+        }
+};
+
+class FillingFont: public AbstractFont {
+    public:
+        explicit FillingFont(): serialCount{}, parallelCount{} {}
+
+        std::size_t serialCount, parallelCount;
+        std::u32string characters;
+
+    private:
+        Features doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        UnsignedInt doGlyphId(char32_t) override { return 0; }
+        Vector2 doGlyphAdvance(UnsignedInt) override { return {}; }
+
+        void doFillGlyphCache(GlyphCache&, const std::u32string& characters) override {
+            ++serialCount;
+            this->characters = characters;
+        }
+
+        std::unique_ptr<AbstractLayouter> doLayout(const GlyphCache&, Float, const std::string&) override {
+            return nullptr;
+        }
+};
+
+class ParallelFillingFont: public FillingFont {
+    private:
+        void doFillGlyphCacheParallel(GlyphCache&, const std::u32string& characters, ThreadPool&) override {
+            ++parallelCount;
+            this->characters = characters;
+        }
+};
+
+Range2D textureCoordinates(AbstractLayouter& layouter, UnsignedInt i) {
+    Vector2 cursorPosition;
+    Range2D rectangle;
+    return layouter.renderGlyph(i, cursorPosition, rectangle).second;
+}
+
+}
+
+void AbstractFontGLTest::layoutCacheDisabled() {
+    Text::GlyphCache cache{Vector2i{64}};
+    CountingFont font;
+    CORRADE_COMPARE(font.layoutCacheSize(), 0);
+
+    font.layout(cache, 1.0f, "ab");
+    font.layout(cache, 1.0f, "ab");
+    CORRADE_COMPARE(font.layoutCount, 2);
+    CORRADE_COMPARE(font.layoutCacheCount(), 0);
+}
+
+void AbstractFontGLTest::layoutCache() {
+    Text::GlyphCache cache{Vector2i{64}};
+    cache.insert('a', {}, {{1, 2}, {3, 4}});
+    cache.insert('b', {}, {{5, 6}, {7, 8}});
+
+    CountingFont font;
+    font.setLayoutCacheSize(4);
+    CORRADE_COMPARE(font.layoutCacheSize(), 4);
+
+    std::unique_ptr<AbstractLayouter> first = font.layout(cache, 2.0f, "ab");
+    CORRADE_COMPARE(font.layoutCount, 1);
+    CORRADE_COMPARE(font.layoutCacheCount(), 1);
+
+    /* The second layout is taken from the cache and gives the same result */
+    std::unique_ptr<AbstractLayouter> second = font.layout(cache, 2.0f, "ab");
+    CORRADE_COMPARE(font.layoutCount, 1);
+    CORRADE_COMPARE(font.layoutCacheCount(), 1);
+    CORRADE_COMPARE(second->glyphCount(), 2);
+
+    Vector2 cursorPosition;
+    Range2D rectangle;
+    CORRADE_COMPARE(second->renderGlyph(0, cursorPosition, rectangle).first, (Range2D{{}, Vector2{2.0f}}));
+    CORRADE_COMPARE(second->renderGlyph(1, cursorPosition, rectangle).first, (Range2D{{2.0f, 0.0f}, {4.0f, 2.0f}}));
+    CORRADE_COMPARE(cursorPosition, (Vector2{4.0f, 0.0f}));
+    CORRADE_COMPARE(textureCoordinates(*first, 1), textureCoordinates(*second, 1));
+    CORRADE_COMPARE(textureCoordinates(*second, 1), (Range2D{{5.0f, 6.0f}, {7.0f, 8.0f}}));
+}
+
+void AbstractFontGLTest::layoutCacheKey() {
+    Text::GlyphCache cache{Vector2i{64}}, another{Vector2i{64}};
+    CountingFont font;
+    font.setLayoutCacheSize(8);
+
+    /* Different text, size or glyph cache is a different entry */
+    font.layout(cache, 1.0f, "ab");
+    font.layout(cache, 1.0f, "ba");
+    font.layout(cache, 2.0f, "ab");
+    font.layout(another, 1.0f, "ab");
+    CORRADE_COMPARE(font.layoutCount, 4);
+    CORRADE_COMPARE(font.layoutCacheCount(), 4);
+
+    font.layout(another, 1.0f, "ab");
+    font.layout(cache, 2.0f, "ab");
+    CORRADE_COMPARE(font.layoutCount, 4);
+}
+
+void AbstractFontGLTest::layoutCacheEvict() {
+    Text::GlyphCache cache{Vector2i{64}};
+    CountingFont font;
+    font.setLayoutCacheSize(2);
+
+    font.layout(cache, 1.0f, "a");
+    font.layout(cache, 1.0f, "b");
+    /* Makes "a" the most recently used */
+    font.layout(cache, 1.0f, "a");
+    CORRADE_COMPARE(font.layoutCount, 2);
+
+    /* Evicts "b" */
+    font.layout(cache, 1.0f, "c");
+    CORRADE_COMPARE(font.layoutCount, 3);
+    CORRADE_COMPARE(font.layoutCacheCount(), 2);
+    font.layout(cache, 1.0f, "a");
+    CORRADE_COMPARE(font.layoutCount, 3);
+    font.layout(cache, 1.0f, "b");
+    CORRADE_COMPARE(font.layoutCount, 4);
+
+    /* Shrinking the cache evicts the least recently used "a" */
+    font.setLayoutCacheSize(1);
+    CORRADE_COMPARE(font.layoutCacheCount(), 1);
+    font.layout(cache, 1.0f, "b");
+    CORRADE_COMPARE(font.layoutCount, 4);
+
+    /* Disabling frees everything */
+    font.setLayoutCacheSize(0);
+    CORRADE_COMPARE(font.layoutCacheCount(), 0);
+    font.layout(cache, 1.0f, "b");
+    CORRADE_COMPARE(font.layoutCount, 5);
+}
+
+void AbstractFontGLTest::layoutCacheInvalidate() {
+    Text::GlyphCache cache{Vector2i{64}};
+    CountingFont font;
+    font.setLayoutCacheSize(4);
+
+    std::unique_ptr<AbstractLayouter> before = font.layout(cache, 1.0f, "a");
+    CORRADE_COMPARE(textureCoordinates(*before, 0), Range2D{});
+
+    /* Inserting a glyph makes the entry stale */
+    const UnsignedInt generation = cache.generation();
+    cache.insert('a', {}, {{1, 2}, {3, 4}});
+    CORRADE_VERIFY(cache.generation() != generation);
+
+    std::unique_ptr<AbstractLayouter> after = font.layout(cache, 1.0f, "a");
+    CORRADE_COMPARE(font.layoutCount, 2);
+    CORRADE_COMPARE(font.layoutCacheCount(), 1);
+    CORRADE_COMPARE(textureCoordinates(*after, 0), (Range2D{{1.0f, 2.0f}, {3.0f, 4.0f}}));
+
+    /* The previously returned layouter still has the old data */
+    CORRADE_COMPARE(textureCoordinates(*before, 0), Range2D{});
+
+    font.layout(cache, 1.0f, "a");
+    CORRADE_COMPARE(font.layoutCount, 2);
+}
+
+void AbstractFontGLTest::layoutCacheClose() {
+    Text::GlyphCache cache{Vector2i{64}};
+    CountingFont font;
+    font.setLayoutCacheSize(4);
+
+    font.layout(cache, 1.0f, "a");
+    CORRADE_COMPARE(font.layoutCacheCount(), 1);
+
+    /* The size is kept */
+    font.close();
+    CORRADE_COMPARE(font.layoutCacheCount(), 0);
+    CORRADE_COMPARE(font.layoutCacheSize(), 4);
+}
+
+void AbstractFontGLTest::fillGlyphCacheThreadPool() {
+    Text::GlyphCache cache{Vector2i{64}};
+    ThreadPool pool{2};
+
+    /* The default implementation delegates to the serial one */
+    FillingFont font;
+    font.fillGlyphCache(cache, "a\xc4\x9b", pool);
+    CORRADE_COMPARE(font.serialCount, 1);
+    CORRADE_COMPARE(font.parallelCount, 0);
+    CORRADE_VERIFY(font.characters == U"a\u011b");
+}
+
+void AbstractFontGLTest::fillGlyphCacheThreadPoolParallel() {
+    Text::GlyphCache cache{Vector2i{64}};
+    ThreadPool pool{2};
+
+    ParallelFillingFont font;
+    font.fillGlyphCache(cache, "a\xc4\x9b", pool);
+    CORRADE_COMPARE(font.serialCount, 0);
+    CORRADE_COMPARE(font.parallelCount, 1);
+    CORRADE_VERIFY(font.characters == U"a\u011b");
+
+    /* The serial overload is not affected */
+    font.fillGlyphCache(cache, "b");
+    CORRADE_COMPARE(font.serialCount, 1);
+    CORRADE_COMPARE(font.parallelCount, 1);
+    CORRADE_VERIFY(font.characters == U"b");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Text::Test::AbstractFontGLTest)
@@ -0,0 +1,202 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <tuple>
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/OpenGLTester.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Text/AbstractFont.h"
+#include "Magnum/Text/DynamicGlyphCache.h"
+
+namespace Magnum { namespace Text { namespace Test {
+
+struct DynamicGlyphCacheGLTest: OpenGLTester {
+    explicit DynamicGlyphCacheGLTest();
+
+    void prepare();
+    void evict();
+    void reuseShelf();
+    void tooSmall();
+};
+
+DynamicGlyphCacheGLTest::DynamicGlyphCacheGLTest() {
+    addTests({&DynamicGlyphCacheGLTest::prepare,
+              &DynamicGlyphCacheGLTest::evict,
+              &DynamicGlyphCacheGLTest::reuseShelf,
+              &DynamicGlyphCacheGLTest::tooSmall});
+}
+
+namespace {
+
+/* Glyph ID is the character, glyphs after 'x' are twice as high. Renders
+   the whole cache image like real font plugins do. */
+class TestFont: public Text::AbstractFont {
+    public:
+        explicit TestFont(): fillCount{} {}
+
+        std::size_t fillCount;
+
+    private:
+        Features doFeatures() const override { return {}; }
+
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        UnsignedInt doGlyphId(const char32_t character) override { return character; }
+        Vector2 doGlyphAdvance(UnsignedInt) override { return {}; }
+
+        std::unique_ptr<AbstractLayouter> doLayout(const GlyphCache&, Float, const std::string&) override {
+            return nullptr;
+        }
+
+        void doFillGlyphCache(GlyphCache& cache, const std::u32string& characters) override {
+            ++fillCount;
+
+            std::vector<Vector2i> sizes;
+            for(const char32_t c: characters)
+                sizes.push_back(c > U'x' ? Vector2i{8, 16} : Vector2i{8});
+            const std::vector<Range2Di> rectangles = cache.reserve(sizes);
+            if(rectangles.empty()) return;
+
+            Image2D image{PixelStorage{}.setAlignment(1), PixelFormat::Red, PixelType::UnsignedByte, cache.textureSize(), Containers::Array<char>{Containers::ValueInit, std::size_t(cache.textureSize().product())}};
+            for(std::size_t i = 0; i != rectangles.size(); ++i) {
+                cache.insert(characters[i], {}, rectangles[i]);
+                for(Int y = rectangles[i].bottom(); y != rectangles[i].top(); ++y)
+                    for(Int x = rectangles[i].left(); x != rectangles[i].right(); ++x)
+                        image.data()[y*cache.textureSize().x() + x] = char(characters[i]);
+            }
+            cache.setImage({}, image);
+        }
+};
+
+}
+
+void DynamicGlyphCacheGLTest::prepare() {
+    TestFont font;
+    Text::DynamicGlyphCache cache{{32, 32}};
+    MAGNUM_VERIFY_NO_ERROR();
+
+    CORRADE_COMPARE(cache.prepare(font, "abca"), 3);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(font.fillCount, 1);
+    CORRADE_COMPARE(cache.glyphCount(), 4);
+    CORRADE_COMPARE(cache['a'].second, Range2Di({0, 0}, {8, 8}));
+    CORRADE_COMPARE(cache['b'].second, Range2Di({8, 0}, {16, 8}));
+    CORRADE_COMPARE(cache['c'].second, Range2Di({16, 0}, {24, 8}));
+
+    /* Glyphs already in the cache are not rasterized again */
+    CORRADE_COMPARE(cache.prepare(font, "cab"), 0);
+    CORRADE_COMPARE(font.fillCount, 1);
+    CORRADE_COMPARE(cache.prepare(font, "bd"), 1);
+    CORRADE_COMPARE(font.fillCount, 2);
+    CORRADE_COMPARE(cache['d'].second, Range2Di({24, 0}, {32, 8}));
+    CORRADE_COMPARE(cache.evictedGlyphCount(), 0);
+
+    /** @todo How to verify this on ES? */
+    #ifndef MAGNUM_TARGET_GLES
+    Image2D image = cache.texture().image(0, Image2D{PixelStorage{}.setAlignment(1), PixelFormat::Red, PixelType::UnsignedByte});
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(image.data()[3*32 + 4], 'a');
+    CORRADE_COMPARE(image.data()[3*32 + 12], 'b');
+    CORRADE_COMPARE(image.data()[3*32 + 20], 'c');
+    CORRADE_COMPARE(image.data()[3*32 + 28], 'd');
+    #endif
+}
+
+void DynamicGlyphCacheGLTest::evict() {
+    TestFont font;
+    Text::DynamicGlyphCache cache{{16, 16}};
+
+    /* Fill the whole cache */
+    CORRADE_COMPARE(cache.prepare(font, "abcd"), 4);
+    CORRADE_COMPARE(cache.glyphCount(), 5);
+
+    /* Use some glyphs in next frame, the two least recently used ones get
+       evicted */
+    cache.nextFrame();
+    CORRADE_COMPARE(cache.prepare(font, "da"), 0);
+    CORRADE_COMPARE(cache.prepare(font, "ef"), 2);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(cache.evictedGlyphCount(), 2);
+    CORRADE_COMPARE(cache.glyphCount(), 5);
+
+    /* Evicted glyphs fall back to "Not Found", new glyphs are in their
+       place */
+    CORRADE_COMPARE(cache['b'].second, Range2Di{});
+    CORRADE_COMPARE(cache['c'].second, Range2Di{});
+    CORRADE_COMPARE(cache['a'].second, Range2Di({0, 0}, {8, 8}));
+    CORRADE_COMPARE(cache['d'].second, Range2Di({8, 8}, {16, 16}));
+    CORRADE_COMPARE(cache['e'].second, Range2Di({8, 0}, {16, 8}));
+    CORRADE_COMPARE(cache['f'].second, Range2Di({0, 8}, {8, 16}));
+
+    /** @todo How to verify this on ES? */
+    #ifndef MAGNUM_TARGET_GLES
+    Image2D image = cache.texture().image(0, Image2D{PixelStorage{}.setAlignment(1), PixelFormat::Red, PixelType::UnsignedByte});
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(image.data()[3*16 + 4], 'a');
+    CORRADE_COMPARE(image.data()[3*16 + 12], 'e');
+    CORRADE_COMPARE(image.data()[11*16 + 4], 'f');
+    CORRADE_COMPARE(image.data()[11*16 + 12], 'd');
+    #endif
+}
+
+void DynamicGlyphCacheGLTest::reuseShelf() {
+    TestFont font;
+    Text::DynamicGlyphCache cache{{16, 16}};
+
+    /* Two shelves of small glyphs */
+    CORRADE_COMPARE(cache.prepare(font, "abcd"), 4);
+
+    /* A high glyph needs both shelves to be emptied, which frees the space
+       for glyphs of any height */
+    cache.nextFrame();
+    CORRADE_COMPARE(cache.prepare(font, "y"), 1);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(cache.evictedGlyphCount(), 4);
+    CORRADE_COMPARE(cache['y'].second, Range2Di({0, 0}, {8, 16}));
+
+    /* The new shelf has space for another high glyph */
+    CORRADE_COMPARE(cache.prepare(font, "z"), 1);
+    CORRADE_COMPARE(cache.evictedGlyphCount(), 4);
+    CORRADE_COMPARE(cache['z'].second, Range2Di({8, 0}, {16, 16}));
+}
+
+void DynamicGlyphCacheGLTest::tooSmall() {
+    TestFont font;
+    Text::DynamicGlyphCache cache{{16, 16}};
+
+    /* Glyphs used in current frame can't be evicted */
+    std::ostringstream out;
+    Error redirectError{&out};
+    cache.prepare(font, "abcde");
+    CORRADE_COMPARE(out.str(), "Text::DynamicGlyphCache::reserve(): cache too small to contain all glyphs used in current frame\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Text::Test::DynamicGlyphCacheGLTest)
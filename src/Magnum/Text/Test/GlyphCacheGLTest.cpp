@@ -35,12 +35,18 @@ struct GlyphCacheGLTest: OpenGLTester {
 
     void initialize();
     void access();
+    void accessSparse();
+    void remove();
+    void generation();
     void reserve();
 };
 
 GlyphCacheGLTest::GlyphCacheGLTest() {
     addTests({&GlyphCacheGLTest::initialize,
               &GlyphCacheGLTest::access,
+              &GlyphCacheGLTest::accessSparse,
+              &GlyphCacheGLTest::remove,
+              &GlyphCacheGLTest::generation,
               &GlyphCacheGLTest::reserve});
 }
 
@@ -84,6 +90,82 @@ void GlyphCacheGLTest::access() {
     CORRADE_COMPARE(rectangle, Range2Di({10, 10}, {23, 45}));
 }
 
+void GlyphCacheGLTest::accessSparse() {
+    Text::GlyphCache cache(Vector2i(236));
+    cache.insert(3, {1, 2}, {{10, 10}, {20, 20}});
+    cache.insert(256, {3, 4}, {{20, 20}, {30, 30}});
+    cache.insert(70000, {5, 6}, {{30, 30}, {40, 40}});
+    CORRADE_COMPARE(cache.glyphCount(), 4);
+
+    /* Glyphs in different pages of the lookup table */
+    CORRADE_COMPARE(cache[3].second, Range2Di({10, 10}, {20, 20}));
+    CORRADE_COMPARE(cache[256].second, Range2Di({20, 20}, {30, 30}));
+    CORRADE_COMPARE(cache[70000].first, Vector2i(5, 6));
+
+    /* Not available glyphs in allocated pages, unallocated pages and out of
+       table range */
+    CORRADE_COMPARE(cache[4].second, Range2Di{});
+    CORRADE_COMPARE(cache[1000].second, Range2Di{});
+    CORRADE_COMPARE(cache[10000000].second, Range2Di{});
+
+    /* Glyph 0 is always first when iterating */
+    std::size_t count = 0;
+    for(const std::pair<UnsignedInt, std::pair<Vector2i, Range2Di>>& glyph: cache) {
+        if(!count) CORRADE_COMPARE(glyph.first, 0);
+        ++count;
+    }
+    CORRADE_COMPARE(count, 4);
+}
+
+void GlyphCacheGLTest::remove() {
+    struct RemovingGlyphCache: Text::GlyphCache {
+        using Text::GlyphCache::GlyphCache;
+        using Text::GlyphCache::remove;
+    } cache{Vector2i(236)};
+
+    cache.insert(3, {1, 2}, {{10, 10}, {20, 20}});
+    cache.insert(5, {3, 4}, {{20, 20}, {30, 30}});
+    cache.insert(7, {5, 6}, {{30, 30}, {40, 40}});
+
+    /* The last glyph gets moved into the place of the removed one */
+    cache.remove(3);
+    CORRADE_COMPARE(cache.glyphCount(), 3);
+    CORRADE_COMPARE(cache[3].second, Range2Di{});
+    CORRADE_COMPARE(cache[5].second, Range2Di({20, 20}, {30, 30}));
+    CORRADE_COMPARE(cache[7].second, Range2Di({30, 30}, {40, 40}));
+
+    /* Removing the last glyph and a glyph that isn't there */
+    cache.remove(7);
+    cache.remove(42);
+    CORRADE_COMPARE(cache.glyphCount(), 2);
+    CORRADE_COMPARE(cache[7].second, Range2Di{});
+    CORRADE_COMPARE(cache[5].second, Range2Di({20, 20}, {30, 30}));
+
+    /* Inserting a removed glyph again */
+    cache.insert(3, {1, 2}, {{10, 10}, {20, 20}});
+    CORRADE_COMPARE(cache[3].second, Range2Di({10, 10}, {20, 20}));
+}
+
+void GlyphCacheGLTest::generation() {
+    struct RemovingGlyphCache: Text::GlyphCache {
+        using Text::GlyphCache::GlyphCache;
+        using Text::GlyphCache::remove;
+    } cache{Vector2i(236)};
+    CORRADE_COMPARE(cache.generation(), 0);
+
+    /* Every insert and removal changes the generation */
+    cache.insert(0, {3, 5}, {{10, 10}, {23, 45}});
+    CORRADE_COMPARE(cache.generation(), 1);
+    cache.insert(3, {1, 2}, {{10, 10}, {20, 20}});
+    CORRADE_COMPARE(cache.generation(), 2);
+    cache.remove(3);
+    CORRADE_COMPARE(cache.generation(), 3);
+
+    /* Removing a glyph that isn't there doesn't */
+    cache.remove(42);
+    CORRADE_COMPARE(cache.generation(), 3);
+}
+
 void GlyphCacheGLTest::reserve() {
     Text::GlyphCache cache(Vector2i(236));
 
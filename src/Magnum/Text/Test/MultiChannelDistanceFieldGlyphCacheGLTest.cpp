@@ -0,0 +1,117 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/OpenGLTester.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Text/MultiChannelDistanceFieldGlyphCache.h"
+
+namespace Magnum { namespace Text { namespace Test {
+
+struct MultiChannelDistanceFieldGlyphCacheGLTest: OpenGLTester {
+    explicit MultiChannelDistanceFieldGlyphCacheGLTest();
+
+    void initialize();
+    void setImage();
+    void setDistanceFieldImage();
+};
+
+MultiChannelDistanceFieldGlyphCacheGLTest::MultiChannelDistanceFieldGlyphCacheGLTest() {
+    addTests({&MultiChannelDistanceFieldGlyphCacheGLTest::initialize,
+              &MultiChannelDistanceFieldGlyphCacheGLTest::setImage,
+              &MultiChannelDistanceFieldGlyphCacheGLTest::setDistanceFieldImage});
+}
+
+void MultiChannelDistanceFieldGlyphCacheGLTest::initialize() {
+    Text::MultiChannelDistanceFieldGlyphCache cache{{1024, 2048}, {128, 256}, 16};
+    MAGNUM_VERIFY_NO_ERROR();
+
+    CORRADE_COMPARE(cache.textureSize(), (Vector2i{128, 256}));
+    #ifndef MAGNUM_TARGET_GLES
+    CORRADE_COMPARE(cache.texture().imageSize(0), (Vector2i{128, 256}));
+    #endif
+}
+
+void MultiChannelDistanceFieldGlyphCacheGLTest::setImage() {
+    Text::MultiChannelDistanceFieldGlyphCache cache{{16, 16}, {8, 8}, 16};
+
+    /* Left half black, right half white */
+    Containers::Array<char> data{Containers::ValueInit, 16*16};
+    for(std::size_t y = 0; y != 16; ++y) for(std::size_t x = 8; x != 16; ++x)
+        data[y*16 + x] = char(255);
+
+    #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+    constexpr PixelFormat format = PixelFormat::Red;
+    #else
+    constexpr PixelFormat format = PixelFormat::Luminance;
+    #endif
+    cache.setImage({}, ImageView2D{format, PixelType::UnsignedByte, {16, 16}, data});
+    MAGNUM_VERIFY_NO_ERROR();
+
+    #ifndef MAGNUM_TARGET_GLES
+    Image2D image = cache.texture().image(0, Image2D{PixelStorage{}.setAlignment(1), PixelFormat::RGB, PixelType::UnsignedByte});
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /* All channels have the same value, ramping up across the edge */
+    const char* const pixels = image.data();
+    for(std::size_t x = 0; x != 8; ++x) {
+        CORRADE_ITERATION(x);
+        CORRADE_COMPARE(pixels[x*3 + 1], pixels[x*3]);
+        CORRADE_COMPARE(pixels[x*3 + 2], pixels[x*3]);
+        if(x) CORRADE_VERIFY(UnsignedByte(pixels[x*3]) > UnsignedByte(pixels[x*3 - 3]));
+    }
+    CORRADE_VERIFY(UnsignedByte(pixels[3*3]) < 128);
+    CORRADE_VERIFY(UnsignedByte(pixels[4*3]) > 128);
+    #endif
+}
+
+void MultiChannelDistanceFieldGlyphCacheGLTest::setDistanceFieldImage() {
+    Text::MultiChannelDistanceFieldGlyphCache cache{{32, 32}, {4, 4}, 4};
+
+    constexpr UnsignedByte data[] = {
+        10, 20, 30, 40, 50, 60,
+        70, 80, 90, 100, 110, 120
+    };
+    cache.setDistanceFieldImage({1, 2}, ImageView2D{PixelStorage{}.setAlignment(1), PixelFormat::RGB, PixelType::UnsignedByte, {2, 2}, data});
+    MAGNUM_VERIFY_NO_ERROR();
+
+    #ifndef MAGNUM_TARGET_GLES
+    Image2D image = cache.texture().image(0, Image2D{PixelStorage{}.setAlignment(1), PixelFormat::RGB, PixelType::UnsignedByte});
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /* Channels are kept as they are */
+    const char* const pixels = image.data();
+    CORRADE_COMPARE(UnsignedByte(pixels[(2*4 + 1)*3 + 0]), 10);
+    CORRADE_COMPARE(UnsignedByte(pixels[(2*4 + 1)*3 + 2]), 30);
+    CORRADE_COMPARE(UnsignedByte(pixels[(3*4 + 2)*3 + 1]), 110);
+    #endif
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Text::Test::MultiChannelDistanceFieldGlyphCacheGLTest)
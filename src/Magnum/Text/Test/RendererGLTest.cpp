@@ -28,28 +28,48 @@
 
 #include "Magnum/Context.h"
 #include "Magnum/Extensions.h"
+#include "Magnum/Math/Packing.h"
 #include "Magnum/OpenGLTester.h"
+#include "Magnum/ThreadPool.h"
 #include "Magnum/Text/AbstractFont.h"
 #include "Magnum/Text/Renderer.h"
 
 namespace Magnum { namespace Text { namespace Test {
 
+using namespace Math::Literals;
+
 struct RendererGLTest: OpenGLTester {
     explicit RendererGLTest();
 
     void renderData();
+    void renderDataThreaded();
     void renderMesh();
     void renderMeshIndexType();
     void mutableText();
+    void mutableTextIncremental();
+    void batch();
+    void renderInstances();
+    #ifndef MAGNUM_TARGET_GLES2
+    void renderInstancedMesh();
+    void mutableTextInstanced();
+    #endif
 
     void multiline();
 };
 
 RendererGLTest::RendererGLTest() {
     addTests({&RendererGLTest::renderData,
+              &RendererGLTest::renderDataThreaded,
               &RendererGLTest::renderMesh,
               &RendererGLTest::renderMeshIndexType,
               &RendererGLTest::mutableText,
+              &RendererGLTest::mutableTextIncremental,
+              &RendererGLTest::batch,
+              &RendererGLTest::renderInstances,
+              #ifndef MAGNUM_TARGET_GLES2
+              &RendererGLTest::renderInstancedMesh,
+              &RendererGLTest::mutableTextInstanced,
+              #endif
 
               &RendererGLTest::multiline});
 }
@@ -58,18 +78,18 @@ namespace {
 
 class TestLayouter: public Text::AbstractLayouter {
     public:
-        explicit TestLayouter(Float size, std::size_t glyphCount): AbstractLayouter(glyphCount), _size(size) {}
+        explicit TestLayouter(Float size, std::size_t glyphCount, Float textureScale): AbstractLayouter(glyphCount), _size(size), _textureScale{textureScale} {}
 
     private:
         std::tuple<Range2D, Range2D, Vector2> doRenderGlyph(UnsignedInt i) override {
             return std::make_tuple(
                 Range2D({}, Vector2(3.0f, 2.0f)*((i+1)*_size)),
-                Range2D::fromSize({i*6.0f, 0.0f}, {6.0f, 10.0f}),
+                Range2D::fromSize(Vector2{i*6.0f, 0.0f}*_textureScale, Vector2{6.0f, 10.0f}*_textureScale),
                 (Vector2::xAxis((i+1)*3.0f)+Vector2(1.0f, -1.0f))*_size
             );
         }
 
-        Float _size;
+        Float _size, _textureScale;
 };
 
 class TestFont: public Text::AbstractFont {
@@ -82,8 +102,12 @@ class TestFont: public Text::AbstractFont {
     Vector2 doGlyphAdvance(UnsignedInt) override { return {}; }
 
     std::unique_ptr<AbstractLayouter> doLayout(const GlyphCache&, const Float size, const std::string& text) override {
-        return std::unique_ptr<AbstractLayouter>(new TestLayouter(size, text.size()));
+        return std::unique_ptr<AbstractLayouter>(new TestLayouter(size, text.size(), textureScale));
     }
+
+    public:
+        /* Glyph instances need texture coordinates in the 0-1 range */
+        Float textureScale = 1.0f;
 };
 
 /* *static_cast<GlyphCache*>(nullptr) makes Clang Analyzer grumpy */
@@ -175,6 +199,36 @@ void RendererGLTest::renderData() {
     }));
 }
 
+void RendererGLTest::renderDataThreaded() {
+    TestFont font;
+
+    /* Enough lines to be split into many chunks, with some empty lines and
+       varying line lengths */
+    std::string text;
+    for(std::size_t i = 0; i != 500; ++i) {
+        if(i % 7 != 3) text.append(i % 5 + 1, 'a');
+        text += '\n';
+    }
+    text += "abc";
+
+    std::vector<Vector2> expectedPositions, expectedTextureCoordinates;
+    std::vector<UnsignedInt> expectedIndices;
+    Range2D expectedBounds;
+    std::tie(expectedPositions, expectedTextureCoordinates, expectedIndices, expectedBounds) = Text::AbstractRenderer::render(font, nullGlyphCache, 0.25f, text, Alignment::MiddleCenter);
+
+    ThreadPool pool{4};
+    std::vector<Vector2> positions, textureCoordinates;
+    std::vector<UnsignedInt> indices;
+    Range2D bounds;
+    std::tie(positions, textureCoordinates, indices, bounds) = Text::AbstractRenderer::render(font, nullGlyphCache, 0.25f, text, Alignment::MiddleCenter, pool);
+
+    /* The output is the same as when laid out on a single thread */
+    CORRADE_COMPARE(bounds, expectedBounds);
+    CORRADE_COMPARE_AS(positions, expectedPositions, TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(textureCoordinates, expectedTextureCoordinates, TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(indices, expectedIndices, TestSuite::Compare::Container);
+}
+
 void RendererGLTest::renderMesh() {
     TestFont font;
     Mesh mesh{NoCreate};
@@ -328,6 +382,335 @@ void RendererGLTest::mutableText() {
     #endif
 }
 
+namespace {
+
+class CountingLayouter: public Text::AbstractLayouter {
+    public:
+        explicit CountingLayouter(UnsignedInt glyphCount): AbstractLayouter(glyphCount) {}
+
+    private:
+        std::tuple<Range2D, Range2D, Vector2> doRenderGlyph(UnsignedInt i) override {
+            return std::make_tuple(Range2D({}, Vector2(1.0f + i)), Range2D({}, Vector2(1.0f)), Vector2::xAxis(2.0f));
+        }
+};
+
+class CountingFont: public Text::AbstractFont {
+    public:
+        explicit CountingFont(): layoutCount{}, _opened(false) {}
+
+        std::size_t layoutCount;
+
+    private:
+        Features doFeatures() const override { return {};  }
+
+        bool doIsOpened() const override { return _opened; }
+        void doClose() override { _opened = false; }
+
+        Metrics doOpenFile(const std::string&, Float) override {
+            _opened = true;
+            return {0.5f, 0.45f, -0.25f, 0.75f};
+        }
+
+        UnsignedInt doGlyphId(char32_t) override { return 0; }
+        Vector2 doGlyphAdvance(UnsignedInt) override { return {}; }
+
+        std::unique_ptr<AbstractLayouter> doLayout(const GlyphCache&, Float, const std::string& text) override {
+            ++layoutCount;
+            return std::unique_ptr<AbstractLayouter>(new CountingLayouter(text.size()));
+        }
+
+        bool _opened;
+};
+
+}
+
+void RendererGLTest::mutableTextIncremental() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::map_buffer_range>())
+        CORRADE_SKIP(Extensions::GL::ARB::map_buffer_range::string() + std::string(" is not supported"));
+    #elif defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    if(!Context::current().isExtensionSupported<Extensions::GL::EXT::map_buffer_range>() &&
+       !Context::current().isExtensionSupported<Extensions::GL::OES::mapbuffer>())
+        CORRADE_SKIP("No required extension is supported");
+    #endif
+
+    CountingFont font;
+    font.openFile({}, 0.0f);
+
+    /* Reference renderer, doing full layout every time */
+    Text::Renderer2D expected(font, nullGlyphCache, 2.0f, Alignment::MiddleCenter);
+    expected.reserve(32, BufferUsage::DynamicDraw, BufferUsage::StaticDraw);
+
+    Text::Renderer2D renderer(font, nullGlyphCache, 2.0f, Alignment::MiddleCenter);
+    CORRADE_VERIFY(!renderer.isIncremental());
+    renderer.setIncremental(true)
+        .reserve(32, BufferUsage::DynamicDraw, BufferUsage::StaticDraw);
+    CORRADE_VERIFY(renderer.isIncremental());
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /* First render lays out all non-empty lines */
+    font.layoutCount = 0;
+    renderer.render("abcd\nef\n\nghi");
+    CORRADE_COMPARE(font.layoutCount, 3);
+
+    /* Same text, nothing is laid out again */
+    font.layoutCount = 0;
+    renderer.render("abcd\nef\n\nghi");
+    CORRADE_COMPARE(font.layoutCount, 0);
+
+    /* Changing one line with the same glyph count lays out just that line */
+    renderer.render("abcd\nxy\n\nghi");
+    CORRADE_COMPARE(font.layoutCount, 1);
+    expected.render("abcd\nxy\n\nghi");
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(renderer.rectangle(), expected.rectangle());
+    CORRADE_COMPARE(renderer.mesh().count(), expected.mesh().count());
+
+    /** @todo How to verify this on ES? */
+    #ifndef MAGNUM_TARGET_GLES
+    {
+        Containers::Array<char> actualVertices = renderer.vertexBuffer().data();
+        Containers::Array<char> expectedVertices = expected.vertexBuffer().data();
+        CORRADE_COMPARE_AS(Containers::arrayCast<const Float>(actualVertices).prefix(9*16),
+            Containers::arrayCast<const Float>(expectedVertices).prefix(9*16),
+            TestSuite::Compare::Container);
+    }
+    #endif
+
+    /* Changing glyph count of the first line moves the rest, changing the
+       rectangle changes the vertical alignment */
+    font.layoutCount = 0;
+    renderer.render("abcdefg\nxy\n\nghi");
+    CORRADE_COMPARE(font.layoutCount, 1);
+    expected.render("abcdefg\nxy\n\nghi");
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(renderer.rectangle(), expected.rectangle());
+    CORRADE_COMPARE(renderer.mesh().count(), expected.mesh().count());
+
+    #ifndef MAGNUM_TARGET_GLES
+    {
+        Containers::Array<char> actualVertices = renderer.vertexBuffer().data();
+        Containers::Array<char> expectedVertices = expected.vertexBuffer().data();
+        CORRADE_COMPARE_AS(Containers::arrayCast<const Float>(actualVertices).prefix(12*16),
+            Containers::arrayCast<const Float>(expectedVertices).prefix(12*16),
+            TestSuite::Compare::Container);
+    }
+    #endif
+
+    /* Removing lines */
+    font.layoutCount = 0;
+    renderer.render("abcdefg");
+    CORRADE_COMPARE(font.layoutCount, 0);
+    expected.render("abcdefg");
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(renderer.rectangle(), expected.rectangle());
+    CORRADE_COMPARE(renderer.mesh().count(), expected.mesh().count());
+
+    #ifndef MAGNUM_TARGET_GLES
+    {
+        Containers::Array<char> actualVertices = renderer.vertexBuffer().data();
+        Containers::Array<char> expectedVertices = expected.vertexBuffer().data();
+        CORRADE_COMPARE_AS(Containers::arrayCast<const Float>(actualVertices).prefix(7*16),
+            Containers::arrayCast<const Float>(expectedVertices).prefix(7*16),
+            TestSuite::Compare::Container);
+    }
+    #endif
+
+    /* Reserving again discards the buffer contents, so everything is laid out
+       again */
+    renderer.reserve(32, BufferUsage::DynamicDraw, BufferUsage::StaticDraw);
+    renderer.render("abcdefg");
+    CORRADE_COMPARE(font.layoutCount, 1);
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void RendererGLTest::batch() {
+    TestFont font;
+    Text::BatchRenderer2D batch{font, nullGlyphCache, 0.25f};
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(batch.capacity(), 0);
+    CORRADE_COMPARE(batch.labelCount(), 0);
+
+    batch.reserve(4, BufferUsage::DynamicDraw, BufferUsage::StaticDraw);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(batch.capacity(), 4);
+
+    /* Two labels of the same color with a differently colored one between */
+    CORRADE_COMPARE(batch.addLabel("a", Matrix3::translation(Vector2::xAxis(10.0f)), 0xff0000ff_rgbaf), 0);
+    CORRADE_COMPARE(batch.addLabel("a", Matrix3::translation(Vector2::xAxis(20.0f)), 0x0000ffff_rgbaf), 1);
+    CORRADE_COMPARE(batch.addLabel("a", Matrix3::translation(Vector2::xAxis(30.0f)), 0xff0000ff_rgbaf), 2);
+    CORRADE_COMPARE(batch.labelCount(), 3);
+    CORRADE_COMPARE(batch.labelRectangle(1), Range2D({0.0f, 0.0f}, {0.75f, 0.5f}));
+
+    /* Nothing is uploaded until update() */
+    CORRADE_COMPARE(batch.glyphCount(), 0);
+    batch.update();
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(batch.glyphCount(), 3);
+    CORRADE_COMPARE(batch.mesh().count(), 18);
+
+    /* The labels are grouped by color */
+    /** @todo How to verify this on ES? */
+    #ifndef MAGNUM_TARGET_GLES
+    {
+        Containers::Array<char> vertices = batch.vertexBuffer().data();
+        CORRADE_COMPARE_AS(Containers::arrayCast<const Float>(vertices).prefix(48),
+            (Containers::Array<Float>{Containers::InPlaceInit, {
+                20.0f,  0.5f, 0.0f, 10.0f,
+                20.0f,  0.0f, 0.0f,  0.0f,
+                20.75f, 0.5f, 6.0f, 10.0f,
+                20.75f, 0.0f, 6.0f,  0.0f,
+
+                10.0f,  0.5f, 0.0f, 10.0f,
+                10.0f,  0.0f, 0.0f,  0.0f,
+                10.75f, 0.5f, 6.0f, 10.0f,
+                10.75f, 0.0f, 6.0f,  0.0f,
+
+                30.0f,  0.5f, 0.0f, 10.0f,
+                30.0f,  0.0f, 0.0f,  0.0f,
+                30.75f, 0.5f, 6.0f, 10.0f,
+                30.75f, 0.0f, 6.0f,  0.0f
+            }}), TestSuite::Compare::Container);
+    }
+    #endif
+
+    /* Change the color and text, the order follows the label IDs again */
+    batch.setLabelColor(1, 0xff0000ff_rgbaf)
+        .setLabelText(2, "ab");
+    batch.update();
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(batch.glyphCount(), 4);
+    CORRADE_COMPARE(batch.mesh().count(), 24);
+
+    /** @todo How to verify this on ES? */
+    #ifndef MAGNUM_TARGET_GLES
+    {
+        Containers::Array<char> vertices = batch.vertexBuffer().data();
+        CORRADE_COMPARE_AS(Containers::arrayCast<const Float>(vertices).prefix(16),
+            (Containers::Array<Float>{Containers::InPlaceInit, {
+                10.0f,  0.5f, 0.0f, 10.0f,
+                10.0f,  0.0f, 0.0f,  0.0f,
+                10.75f, 0.5f, 6.0f, 10.0f,
+                10.75f, 0.0f, 6.0f,  0.0f
+            }}), TestSuite::Compare::Container);
+    }
+    #endif
+
+    batch.clear();
+    batch.update();
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(batch.labelCount(), 0);
+    CORRADE_COMPARE(batch.glyphCount(), 0);
+}
+
+void RendererGLTest::renderInstances() {
+    TestFont font;
+    font.textureScale = 1.0f/20.0f;
+    std::vector<GlyphInstance> instances;
+    Range2D bounds;
+    std::tie(instances, bounds) = Text::AbstractRenderer::renderInstances(font, nullGlyphCache, 0.25f, "abc", Alignment::MiddleRightIntegral);
+
+    /* Same bounds as with renderData(), one record per glyph */
+    const Vector2 offset{-5.0f, 0.0f};
+    CORRADE_COMPARE(bounds, Range2D({0.0f, -0.5f}, {5.0f, 1.0f}).translated(offset));
+    CORRADE_COMPARE(instances.size(), 3);
+
+    const Vector2 positions[]{
+        Vector2{0.0f,   0.0f} + offset,
+        Vector2{1.0f,  -0.25f} + offset,
+        Vector2{2.75f, -0.5f} + offset
+    };
+    const Vector2 sizes[]{
+        {0.75f, 0.5f},
+        {1.5f,  1.0f},
+        {2.25f, 1.5f}
+    };
+    const Float s = font.textureScale;
+    for(std::size_t i = 0; i != 3; ++i) {
+        CORRADE_COMPARE(instances[i].position, positions[i]);
+        CORRADE_COMPARE(instances[i].size, sizes[i]);
+        CORRADE_COMPARE(instances[i].textureCoordinates,
+            Math::pack<Math::Vector4<UnsignedShort>>(Vector4{i*6.0f*s, 0.0f, i*6.0f*s + 6.0f*s, 10.0f*s}));
+    }
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+void RendererGLTest::renderInstancedMesh() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::instanced_arrays>())
+        CORRADE_SKIP(Extensions::GL::ARB::instanced_arrays::string() + std::string(" is not supported"));
+    #endif
+
+    TestFont font;
+    font.textureScale = 1.0f/20.0f;
+    Mesh mesh{NoCreate};
+    Buffer instanceBuffer{Buffer::TargetHint::Array};
+    Range2D bounds;
+    std::tie(mesh, bounds) = Text::Renderer3D::renderInstanced(font, nullGlyphCache,
+        0.25f, "abc", instanceBuffer, BufferUsage::StaticDraw, Alignment::TopCenter);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /* One four-vertex strip per glyph, no indices */
+    CORRADE_VERIFY(!mesh.isIndexed());
+    CORRADE_COMPARE(mesh.primitive(), MeshPrimitive::TriangleStrip);
+    CORRADE_COMPARE(mesh.count(), 4);
+    CORRADE_COMPARE(mesh.instanceCount(), 3);
+    CORRADE_COMPARE(bounds, Range2D({0.0f, -0.5f}, {5.0f, 1.0f}).translated({-2.5f, -1.0f}));
+
+    /** @todo How to verify this on ES? */
+    #ifndef MAGNUM_TARGET_GLES
+    /* Two 2D vectors and four 16-bit texture coordinates per glyph */
+    CORRADE_COMPARE(instanceBuffer.size(), 3*(4*4 + 4*2));
+    Containers::Array<char> data = instanceBuffer.data();
+    CORRADE_COMPARE_AS(Containers::arrayCast<const Float>(data).prefix(4),
+        (Containers::Array<Float>{Containers::InPlaceInit, {
+            -2.5f, -1.0f, 0.75f, 0.5f
+        }}), TestSuite::Compare::Container);
+    #endif
+}
+
+void RendererGLTest::mutableTextInstanced() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::instanced_arrays>())
+        CORRADE_SKIP(Extensions::GL::ARB::instanced_arrays::string() + std::string(" is not supported"));
+    #endif
+
+    TestFont font;
+    font.textureScale = 1.0f/20.0f;
+    Text::InstancedRenderer2D renderer{font, nullGlyphCache, 0.25f};
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(renderer.capacity(), 0);
+    CORRADE_COMPARE(renderer.rectangle(), Range2D());
+    CORRADE_COMPARE(renderer.mesh().count(), 4);
+    CORRADE_COMPARE(renderer.mesh().instanceCount(), 0);
+
+    renderer.reserve(4, BufferUsage::DynamicDraw);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(renderer.capacity(), 4);
+
+    renderer.render("abc");
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(renderer.rectangle(), Range2D({0.0f, -0.5f}, {5.0f, 1.0f}));
+    CORRADE_COMPARE(renderer.mesh().instanceCount(), 3);
+
+    /** @todo How to verify this on ES? */
+    #ifndef MAGNUM_TARGET_GLES
+    Containers::Array<char> data = renderer.instanceBuffer().data();
+    CORRADE_COMPARE(data.size(), 4*sizeof(GlyphInstance));
+    const GlyphInstance& second = Containers::arrayCast<const GlyphInstance>(data)[1];
+    CORRADE_COMPARE(second.position, (Vector2{1.0f, -0.25f}));
+    CORRADE_COMPARE(second.size, (Vector2{1.5f, 1.0f}));
+    CORRADE_COMPARE(second.textureCoordinates, Math::pack<Math::Vector4<UnsignedShort>>(Vector4{6.0f*font.textureScale, 0.0f, 6.0f*font.textureScale + 6.0f*font.textureScale, 10.0f*font.textureScale}));
+    #endif
+
+    /* Shorter text uploads fewer instances */
+    renderer.render("a");
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(renderer.mesh().instanceCount(), 1);
+    CORRADE_COMPARE(renderer.rectangle(), Range2D({0.0f, 0.0f}, {0.75f, 0.5f}));
+}
+#endif
+
 void RendererGLTest::multiline() {
     class Layouter: public Text::AbstractLayouter {
         public:
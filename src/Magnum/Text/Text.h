@@ -39,7 +39,9 @@ class AbstractFont;
 class AbstractFontConverter;
 class AbstractLayouter;
 class DistanceFieldGlyphCache;
+class DynamicGlyphCache;
 class GlyphCache;
+class MultiChannelDistanceFieldGlyphCache;
 
 enum class Alignment: UnsignedByte;
 
@@ -47,6 +49,15 @@ class AbstractRenderer;
 template<UnsignedInt> class Renderer;
 typedef Renderer<2> Renderer2D;
 typedef Renderer<3> Renderer3D;
+template<UnsignedInt> class BatchRenderer;
+typedef BatchRenderer<2> BatchRenderer2D;
+typedef BatchRenderer<3> BatchRenderer3D;
+#ifndef MAGNUM_TARGET_GLES2
+template<UnsignedInt> class InstancedRenderer;
+typedef InstancedRenderer<2> InstancedRenderer2D;
+typedef InstancedRenderer<3> InstancedRenderer3D;
+#endif
+struct GlyphInstance;
 #endif
 
 }}
@@ -23,13 +23,19 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <Corrade/Containers/Optional.h>
 #include <Corrade/PluginManager/Manager.h>
 #include <Corrade/Utility/Arguments.h>
 #include <Corrade/Utility/Directory.h>
 
 #include "Magnum/Text/AbstractFont.h"
 #include "Magnum/Text/AbstractFontConverter.h"
+#include "Magnum/Image.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Texture.h"
+#include "Magnum/ThreadPool.h"
 #include "Magnum/Text/DistanceFieldGlyphCache.h"
+#include "Magnum/TextureTools/Compression.h"
 #include "Magnum/Trade/AbstractImageConverter.h"
 
 #ifdef MAGNUM_TARGET_HEADLESS
@@ -68,6 +74,7 @@ namespace Magnum {
 magnum-fontconverter [--magnum-...] [-h|--help] --font FONT
     --converter CONVERTER [--plugin-dir DIR] [--characters CHARACTERS]
     [--font-size N] [--atlas-size "X Y"] [--output-size "X Y"] [--radius N]
+    [--compress FORMAT] [--compressed-output FILE] [--threads N]
     [--] input output
 @endcode
 
@@ -86,6 +93,17 @@ Arguments:
 -   `--output-size "X Y"` --- output atlas size. If set to zero size, distance
     field computation will not be used. (default: `"256 256"`)
 -   `--radius N` --- distance field computation radius (default: `24`)
+-   `--compress FORMAT` --- additionally save the glyph cache texture
+    compressed using @ref TextureTools::compressRedRgtc1() if `FORMAT` is
+    `rgtc1` or @ref TextureTools::compressR11Eac() if `FORMAT` is `r11eac`
+-   `--compressed-output FILE` --- where to save the compressed glyph cache
+    texture using @ref Trade::AnyImageConverter "AnyImageConverter", required
+    if `--compress` is set
+-   `--threads N` --- rasterize glyphs and compute the distance field on the
+    CPU using @p N threads, @cpp 0 @ce uses all hardware threads. If not set,
+    glyphs are rasterized serially and the distance field is computed on the
+    GPU. Glyph rasterization is parallelized only if the font plugin supports
+    it, see @ref Text::AbstractFont::fillGlyphCache(GlyphCache&, const std::string&, ThreadPool&).
 -   `--magnum-...` --- engine-specific options (see @ref Context for details)
 
 The resulting font files can be then used as specified in the documentation of
@@ -132,6 +150,9 @@ FontConverter::FontConverter(const Arguments& arguments): Platform::WindowlessAp
         .addOption("atlas-size", "2048 2048").setHelp("atlas-size", "glyph atlas size", "\"X Y\"")
         .addOption("output-size", "256 256").setHelp("output-size", "output atlas size. If set to zero size, distance field computation will not be used.", "\"X Y\"")
         .addOption("radius", "24").setHelp("radius", "distance field computation radius", "N")
+        .addOption("compress").setHelp("compress", "additionally save compressed glyph cache texture, either rgtc1 or r11eac", "FORMAT")
+        .addOption("compressed-output").setHelp("compressed-output", "compressed glyph cache texture output", "FILE")
+        .addOption("threads").setHelp("threads", "rasterize glyphs and compute the distance field on the CPU using given thread count, 0 for all hardware threads", "N")
         .addSkippedPrefix("magnum", "engine-specific options")
         .setHelp("Converts font to raster one of given atlas size.")
         .parse(arguments.argc, arguments.argv);
@@ -165,15 +186,24 @@ int FontConverter::exec() {
         return 3;
     }
 
+    /* Create thread pool, if requested */
+    std::unique_ptr<ThreadPool> pool;
+    if(!args.value("threads").empty()) {
+        pool.reset(new ThreadPool{args.value<UnsignedInt>("threads")});
+        Debug() << "Using" << pool->threadCount() << "threads";
+    }
+
     /* Create distance field glyph cache if radius is specified */
     std::unique_ptr<Text::GlyphCache> cache;
     if(!args.value<Vector2i>("output-size").isZero()) {
         Debug() << "Populating distance field glyph cache...";
 
-        cache.reset(new Text::DistanceFieldGlyphCache(
+        auto distanceFieldCache = new Text::DistanceFieldGlyphCache(
             args.value<Vector2i>("atlas-size"),
             args.value<Vector2i>("output-size"),
-            args.value<Int>("radius")));
+            args.value<Int>("radius"));
+        distanceFieldCache->setThreadPool(pool.get());
+        cache.reset(distanceFieldCache);
 
     /* Otherwise use normal cache */
     } else {
@@ -183,7 +213,8 @@ int FontConverter::exec() {
     }
 
     /* Fill the cache */
-    font->fillGlyphCache(*cache, args.value("characters"));
+    if(pool) font->fillGlyphCache(*cache, args.value("characters"), *pool);
+    else font->fillGlyphCache(*cache, args.value("characters"));
 
     Debug() << "Converting font...";
 
@@ -193,6 +224,31 @@ int FontConverter::exec() {
         std::exit(1);
     }
 
+    /* Save the compressed texture, if requested */
+    const std::string compression = args.value("compress");
+    if(!compression.empty()) {
+        if(args.value("compressed-output").empty()) {
+            Error() << "No compressed output file specified";
+            return 4;
+        }
+
+        const Image2D image = cache->texture().image(0, Image2D{PixelStorage{}.setAlignment(1), PixelFormat::Red, PixelType::UnsignedByte});
+        Containers::Optional<CompressedImage2D> compressed;
+        if(compression == "rgtc1") compressed = TextureTools::compressRedRgtc1(image);
+        else if(compression == "r11eac") compressed = TextureTools::compressR11Eac(image);
+        else {
+            Error() << "Unsupported compression format" << compression;
+            return 4;
+        }
+
+        Debug() << "Saving glyph cache texture compressed as" << compressed->format();
+        std::unique_ptr<Trade::AbstractImageConverter> imageConverter = imageConverterManager.loadAndInstantiate("AnyImageConverter");
+        if(!imageConverter || !imageConverter->exportToFile(*compressed, args.value("compressed-output"))) {
+            Error() << "Cannot save file" << args.value("compressed-output");
+            return 5;
+        }
+    }
+
     Debug() << "Done.";
 
     return 0;
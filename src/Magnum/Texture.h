@@ -144,6 +144,51 @@ template<UnsignedInt dimensions> class Texture: public AbstractTexture {
         static Int compressedBlockDataSize(TextureFormat format) {
             return AbstractTexture::compressedBlockDataSize(Implementation::textureTarget<dimensions>(), format);
         }
+
+        /**
+         * @brief Count of sparse page sizes
+         *
+         * Count of page sizes available for sparse textures in given
+         * @p format, zero if the format can't be used for sparse textures.
+         * Available only on 2D and 3D textures.
+         * @see @ref sparsePageSize(), @ref setSparse(),
+         *      @fn_gl_keyword{GetInternalformat} with
+         *      @def_gl_keyword{NUM_VIRTUAL_PAGE_SIZES_ARB}
+         * @requires_extension Extension @extension{ARB,sparse_texture}
+         * @requires_gl Sparse textures are not available in OpenGL ES or
+         *      WebGL.
+         */
+        #ifndef DOXYGEN_GENERATING_OUTPUT
+        template<UnsignedInt d = dimensions, class = typename std::enable_if<d != 1>::type>
+        #endif
+        static Int sparsePageSizeCount(TextureFormat format) {
+            return AbstractTexture::sparsePageSizeCount(Implementation::textureTarget<dimensions>(), format);
+        }
+
+        /**
+         * @brief Sparse page size
+         * @param format    Texture format
+         * @param index     Page size index, see @ref setSparsePageSizeIndex()
+         *
+         * Size of one page (in pixels) for sparse textures in given
+         * @p format. Offsets and sizes passed to @ref commitPages() and
+         * @ref decommitPages() have to be multiples of it. Expects that
+         * @p index is less than @ref sparsePageSizeCount(). Available only
+         * on 2D and 3D textures.
+         * @see @fn_gl_keyword{GetInternalformat} with
+         *      @def_gl_keyword{VIRTUAL_PAGE_SIZE_X_ARB},
+         *      @def_gl_keyword{VIRTUAL_PAGE_SIZE_Y_ARB},
+         *      @def_gl_keyword{VIRTUAL_PAGE_SIZE_Z_ARB}
+         * @requires_extension Extension @extension{ARB,sparse_texture}
+         * @requires_gl Sparse textures are not available in OpenGL ES or
+         *      WebGL.
+         */
+        #ifndef DOXYGEN_GENERATING_OUTPUT
+        template<UnsignedInt d = dimensions, class = typename std::enable_if<d != 1>::type>
+        #endif
+        static VectorTypeFor<dimensions, Int> sparsePageSize(TextureFormat format, Int index = 0) {
+            return VectorTypeFor<dimensions, Int>::pad(AbstractTexture::sparsePageSize(Implementation::textureTarget<dimensions>(), format, index));
+        }
         #endif
 
         /**
@@ -719,6 +764,68 @@ template<UnsignedInt dimensions> class Texture: public AbstractTexture {
             return *this;
         }
 
+        #ifndef MAGNUM_TARGET_GLES
+        /**
+         * @brief Make the texture sparse
+         * @return Reference to self (for method chaining)
+         *
+         * Has to be called before @ref setStorage(). A sparse texture
+         * doesn't have any physical memory backing its storage, which makes
+         * it possible to allocate textures much larger than the available
+         * video memory. The memory is then allocated for particular pages
+         * using @ref commitPages(). Sampling from pages that aren't committed
+         * returns undefined values. Because the committed memory isn't known
+         * upfront, sparse textures are not reported to @ref MemoryTracker.
+         * Available only on 2D and 3D textures.
+         *
+         * If neither @extension{ARB,direct_state_access} (part of OpenGL 4.5)
+         * nor @extension{EXT,direct_state_access} desktop extension is
+         * available, the texture is bound before the operation (if not
+         * already).
+         * @see @ref sparsePageSize(), @ref SparseTextureStreamer,
+         *      @fn_gl2_keyword{TextureParameter,TexParameter},
+         *      @fn_gl_extension_keyword{TextureParameter,EXT,direct_state_access},
+         *      eventually @fn_gl{ActiveTexture}, @fn_gl{BindTexture} and
+         *      @fn_gl_keyword{TexParameter} with
+         *      @def_gl_keyword{TEXTURE_SPARSE_ARB}
+         * @requires_extension Extension @extension{ARB,sparse_texture}
+         * @requires_gl Sparse textures are not available in OpenGL ES or
+         *      WebGL.
+         */
+        #ifndef DOXYGEN_GENERATING_OUTPUT
+        template<UnsignedInt d = dimensions, class = typename std::enable_if<d != 1>::type>
+        #endif
+        Texture<dimensions>& setSparse(bool sparse = true) {
+            AbstractTexture::setSparse(sparse);
+            return *this;
+        }
+
+        /**
+         * @brief Set sparse page size index
+         * @return Reference to self (for method chaining)
+         *
+         * Selects one of the @ref sparsePageSizeCount() page sizes. Has to
+         * be called before @ref setStorage(), initial value is @cpp 0 @ce.
+         * Available only on 2D and 3D textures. See @ref setSparse() for
+         * more information.
+         * @see @fn_gl2_keyword{TextureParameter,TexParameter},
+         *      @fn_gl_extension_keyword{TextureParameter,EXT,direct_state_access},
+         *      eventually @fn_gl{ActiveTexture}, @fn_gl{BindTexture} and
+         *      @fn_gl_keyword{TexParameter} with
+         *      @def_gl_keyword{VIRTUAL_PAGE_SIZE_INDEX_ARB}
+         * @requires_extension Extension @extension{ARB,sparse_texture}
+         * @requires_gl Sparse textures are not available in OpenGL ES or
+         *      WebGL.
+         */
+        #ifndef DOXYGEN_GENERATING_OUTPUT
+        template<UnsignedInt d = dimensions, class = typename std::enable_if<d != 1>::type>
+        #endif
+        Texture<dimensions>& setSparsePageSizeIndex(Int index) {
+            AbstractTexture::setSparsePageSizeIndex(index);
+            return *this;
+        }
+        #endif
+
         #ifndef MAGNUM_TARGET_GLES2
         /**
          * @brief Image size in given mip level
@@ -1262,6 +1369,57 @@ template<UnsignedInt dimensions> class Texture: public AbstractTexture {
             DataHelper<dimensions>::invalidateSubImage(*this, level, offset, size);
         }
 
+        #ifndef MAGNUM_TARGET_GLES
+        /**
+         * @brief Commit sparse texture pages
+         * @param level             Mip level
+         * @param offset            Offset into the texture
+         * @param size              Size of the committed region
+         *
+         * Allocates physical memory for all pages in given region of a
+         * texture made sparse using @ref setSparse(). The @p offset and
+         * @p size have to be multiples of @ref sparsePageSize() or extend to
+         * the edge of given level. Contents of the newly committed pages are
+         * undefined. Available only on 2D and 3D textures.
+         *
+         * If @extension{EXT,direct_state_access} desktop extension is not
+         * available, the texture is bound before the operation (if not
+         * already).
+         * @see @ref decommitPages(),
+         *      @fn_gl_extension_keyword{TexturePageCommitment,EXT,direct_state_access},
+         *      eventually @fn_gl{ActiveTexture}, @fn_gl{BindTexture} and
+         *      @fn_gl_keyword{TexPageCommitmentARB}
+         * @requires_extension Extension @extension{ARB,sparse_texture}
+         * @requires_gl Sparse textures are not available in OpenGL ES or
+         *      WebGL.
+         */
+        #ifndef DOXYGEN_GENERATING_OUTPUT
+        template<UnsignedInt d = dimensions, class = typename std::enable_if<d != 1>::type>
+        #endif
+        void commitPages(Int level, const VectorTypeFor<dimensions, Int>& offset, const VectorTypeFor<dimensions, Int>& size) {
+            pageCommitment(level, Vector3i::pad(offset), Vector3i::pad(size, 1), true);
+        }
+
+        /**
+         * @brief Decommit sparse texture pages
+         * @param level             Mip level
+         * @param offset            Offset into the texture
+         * @param size              Size of the decommitted region
+         *
+         * Frees physical memory of all pages in given region, otherwise
+         * equivalent to @ref commitPages().
+         * @requires_extension Extension @extension{ARB,sparse_texture}
+         * @requires_gl Sparse textures are not available in OpenGL ES or
+         *      WebGL.
+         */
+        #ifndef DOXYGEN_GENERATING_OUTPUT
+        template<UnsignedInt d = dimensions, class = typename std::enable_if<d != 1>::type>
+        #endif
+        void decommitPages(Int level, const VectorTypeFor<dimensions, Int>& offset, const VectorTypeFor<dimensions, Int>& size) {
+            pageCommitment(level, Vector3i::pad(offset), Vector3i::pad(size, 1), false);
+        }
+        #endif
+
         /* Overloads to remove WTF-factor from method chaining order */
         #if !defined(DOXYGEN_GENERATING_OUTPUT) && !defined(MAGNUM_TARGET_WEBGL)
         Texture<dimensions>& setLabel(const std::string& label) {
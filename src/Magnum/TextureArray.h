@@ -128,6 +128,39 @@ template<UnsignedInt dimensions> class TextureArray: public AbstractTexture {
         static Int compressedBlockDataSize(TextureFormat format) {
             return AbstractTexture::compressedBlockDataSize(Implementation::textureArrayTarget<dimensions>(), format);
         }
+
+        /**
+         * @brief @copybrief Texture::sparsePageSizeCount()
+         *
+         * See @ref Texture::sparsePageSizeCount() for more information.
+         * Available only on 2D texture arrays.
+         * @requires_extension Extension @extension{ARB,sparse_texture}
+         * @requires_gl Sparse textures are not available in OpenGL ES or
+         *      WebGL.
+         */
+        #ifndef DOXYGEN_GENERATING_OUTPUT
+        template<UnsignedInt d = dimensions, class = typename std::enable_if<d == 2>::type>
+        #endif
+        static Int sparsePageSizeCount(TextureFormat format) {
+            return AbstractTexture::sparsePageSizeCount(Implementation::textureArrayTarget<dimensions>(), format);
+        }
+
+        /**
+         * @brief @copybrief Texture::sparsePageSize()
+         *
+         * The last component is the page depth in layers. See
+         * @ref Texture::sparsePageSize() for more information. Available only
+         * on 2D texture arrays.
+         * @requires_extension Extension @extension{ARB,sparse_texture}
+         * @requires_gl Sparse textures are not available in OpenGL ES or
+         *      WebGL.
+         */
+        #ifndef DOXYGEN_GENERATING_OUTPUT
+        template<UnsignedInt d = dimensions, class = typename std::enable_if<d == 2>::type>
+        #endif
+        static VectorTypeFor<dimensions+1, Int> sparsePageSize(TextureFormat format, Int index = 0) {
+            return AbstractTexture::sparsePageSize(Implementation::textureArrayTarget<dimensions>(), format, index);
+        }
         #endif
 
         /**
@@ -448,6 +481,44 @@ template<UnsignedInt dimensions> class TextureArray: public AbstractTexture {
             return *this;
         }
 
+        #ifndef MAGNUM_TARGET_GLES
+        /**
+         * @brief @copybrief Texture::setSparse()
+         * @return Reference to self (for method chaining)
+         *
+         * See @ref Texture::setSparse() for more information. Available only
+         * on 2D texture arrays.
+         * @requires_extension Extension @extension{ARB,sparse_texture}
+         * @requires_gl Sparse textures are not available in OpenGL ES or
+         *      WebGL.
+         */
+        #ifndef DOXYGEN_GENERATING_OUTPUT
+        template<UnsignedInt d = dimensions, class = typename std::enable_if<d == 2>::type>
+        #endif
+        TextureArray<dimensions>& setSparse(bool sparse = true) {
+            AbstractTexture::setSparse(sparse);
+            return *this;
+        }
+
+        /**
+         * @brief @copybrief Texture::setSparsePageSizeIndex()
+         * @return Reference to self (for method chaining)
+         *
+         * See @ref Texture::setSparsePageSizeIndex() for more information.
+         * Available only on 2D texture arrays.
+         * @requires_extension Extension @extension{ARB,sparse_texture}
+         * @requires_gl Sparse textures are not available in OpenGL ES or
+         *      WebGL.
+         */
+        #ifndef DOXYGEN_GENERATING_OUTPUT
+        template<UnsignedInt d = dimensions, class = typename std::enable_if<d == 2>::type>
+        #endif
+        TextureArray<dimensions>& setSparsePageSizeIndex(Int index) {
+            AbstractTexture::setSparsePageSizeIndex(index);
+            return *this;
+        }
+        #endif
+
         #ifndef MAGNUM_TARGET_WEBGL
         /**
          * @brief @copybrief Texture::imageSize()
@@ -806,6 +877,41 @@ template<UnsignedInt dimensions> class TextureArray: public AbstractTexture {
             DataHelper<dimensions+1>::invalidateSubImage(*this, level, offset, size);
         }
 
+        #ifndef MAGNUM_TARGET_GLES
+        /**
+         * @brief @copybrief Texture::commitPages()
+         *
+         * The last component of @p offset and @p size is the layer range.
+         * See @ref Texture::commitPages() for more information. Available
+         * only on 2D texture arrays.
+         * @requires_extension Extension @extension{ARB,sparse_texture}
+         * @requires_gl Sparse textures are not available in OpenGL ES or
+         *      WebGL.
+         */
+        #ifndef DOXYGEN_GENERATING_OUTPUT
+        template<UnsignedInt d = dimensions, class = typename std::enable_if<d == 2>::type>
+        #endif
+        void commitPages(Int level, const VectorTypeFor<dimensions+1, Int>& offset, const VectorTypeFor<dimensions+1, Int>& size) {
+            pageCommitment(level, offset, size, true);
+        }
+
+        /**
+         * @brief @copybrief Texture::decommitPages()
+         *
+         * See @ref Texture::decommitPages() for more information. Available
+         * only on 2D texture arrays.
+         * @requires_extension Extension @extension{ARB,sparse_texture}
+         * @requires_gl Sparse textures are not available in OpenGL ES or
+         *      WebGL.
+         */
+        #ifndef DOXYGEN_GENERATING_OUTPUT
+        template<UnsignedInt d = dimensions, class = typename std::enable_if<d == 2>::type>
+        #endif
+        void decommitPages(Int level, const VectorTypeFor<dimensions+1, Int>& offset, const VectorTypeFor<dimensions+1, Int>& size) {
+            pageCommitment(level, offset, size, false);
+        }
+        #endif
+
         /* Overloads to remove WTF-factor from method chaining order */
         #if !defined(DOXYGEN_GENERATING_OUTPUT) && !defined(MAGNUM_TARGET_WEBGL)
         TextureArray<dimensions>& setLabel(const std::string& label) {
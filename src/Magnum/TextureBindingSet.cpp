@@ -0,0 +1,72 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "TextureBindingSet.h"
+
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/AbstractTexture.h"
+#include "Magnum/Context.h"
+#include "Magnum/Implementation/State.h"
+#include "Magnum/Implementation/TextureState.h"
+
+namespace Magnum {
+
+TextureBindingSet::TextureBindingSet(const Int firstTextureUnit, std::initializer_list<AbstractTexture*> textures): _firstTextureUnit{firstTextureUnit}, _textures{textures} {
+    CORRADE_ASSERT(firstTextureUnit >= 0 && firstTextureUnit + _textures.size() <= Context::current().state().texture->bindings.size(),
+        "TextureBindingSet: units" << firstTextureUnit << "to" << firstTextureUnit + Int(_textures.size()) << "out of range for" << Context::current().state().texture->bindings.size() << "texture units", );
+}
+
+TextureBindingSet& TextureBindingSet::setTexture(const Int textureUnit, AbstractTexture* const texture) {
+    CORRADE_ASSERT(textureUnit >= _firstTextureUnit && std::size_t(textureUnit) < Context::current().state().texture->bindings.size(),
+        "TextureBindingSet::setTexture(): unit" << textureUnit << "out of range for a set starting at" << _firstTextureUnit << "and" << Context::current().state().texture->bindings.size() << "texture units", *this);
+
+    const std::size_t index = textureUnit - _firstTextureUnit;
+    if(index >= _textures.size()) _textures.resize(index + 1, nullptr);
+    _textures[index] = texture;
+    return *this;
+}
+
+void TextureBindingSet::bind() const {
+    Implementation::TextureState& textureState = *Context::current().state().texture;
+
+    /* Find the range of units that differ from the state tracker */
+    std::size_t first = _textures.size(), last = 0;
+    for(std::size_t i = 0; i != _textures.size(); ++i) {
+        const GLuint id = _textures[i] ? _textures[i]->id() : 0;
+        if(textureState.bindings[_firstTextureUnit + i].second == id) continue;
+
+        if(first == _textures.size()) first = i;
+        last = i;
+    }
+
+    /* Nothing to do */
+    if(first == _textures.size()) return;
+
+    /* State tracker is updated in the implementations */
+    textureState.bindMultiImplementation(_firstTextureUnit + first, {_textures.data() + first, last - first + 1});
+}
+
+}
@@ -0,0 +1,127 @@
+#ifndef Magnum_TextureBindingSet_h
+#define Magnum_TextureBindingSet_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::TextureBindingSet
+ */
+
+#include <initializer_list>
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/visibility.h"
+
+namespace Magnum {
+
+/**
+@brief Texture binding set
+
+Set of textures bound to a contiguous range of texture units, for example all
+textures of a single material. Unlike calling @ref AbstractTexture::bind(Int)
+for each texture separately or @ref AbstractTexture::bind(Int, std::initializer_list<AbstractTexture*>)
+for the whole range, @ref bind() compares the set against textures currently
+bound in the state tracker and binds only the range between the first and the
+last differing unit. If @extension{ARB,multi_bind} is available, switching
+between two materials is thus at most a single @fn_gl{BindTextures} call, and
+no call at all if the textures are already bound.
+
+@code{.cpp}
+TextureBindingSet material{0, {&diffuse, &specular, &normal}};
+
+// each draw
+material.bind();
+mesh.draw(shader);
+@endcode
+
+Units set to @cpp nullptr @ce are unbound. The set only references the
+textures, they have to stay alive for as long as the set is used.
+*/
+class MAGNUM_EXPORT TextureBindingSet {
+    public:
+        /**
+         * @brief Constructor
+         * @param firstTextureUnit  First texture unit of the set
+         *
+         * Creates an empty set, use @ref setTexture() to fill it.
+         */
+        explicit TextureBindingSet(Int firstTextureUnit = 0): _firstTextureUnit{firstTextureUnit} {}
+
+        /**
+         * @brief Construct with textures
+         * @param firstTextureUnit  First texture unit of the set
+         * @param textures          Textures for consecutive units starting
+         *      at @p firstTextureUnit, @cpp nullptr @ce means the unit is
+         *      unbound
+         */
+        explicit TextureBindingSet(Int firstTextureUnit, std::initializer_list<AbstractTexture*> textures);
+
+        /** @brief First texture unit of the set */
+        Int firstTextureUnit() const { return _firstTextureUnit; }
+
+        /** @brief Count of texture units in the set */
+        std::size_t size() const { return _textures.size(); }
+
+        /** @brief Textures in the set */
+        Containers::ArrayView<AbstractTexture* const> textures() const {
+            return {_textures.data(), _textures.size()};
+        }
+
+        /**
+         * @brief Set texture for given unit
+         * @param textureUnit   Texture unit, not smaller than
+         *      @ref firstTextureUnit()
+         * @param texture       Texture or @cpp nullptr @ce to unbind the
+         *      unit
+         * @return Reference to self (for method chaining)
+         *
+         * The set is enlarged with unbound units if @p textureUnit is past
+         * its end. Expects that the unit is in range of
+         * @ref Shader::maxCombinedTextureImageUnits().
+         */
+        TextureBindingSet& setTexture(Int textureUnit, AbstractTexture* texture);
+
+        /**
+         * @brief Bind the set
+         *
+         * Binds textures in the range between the first and last unit that
+         * differs from currently bound textures, if any. Without
+         * @extension{ARB,multi_bind} the units are bound one by one, skipping
+         * the ones that are already bound.
+         * @see @fn_gl_keyword{BindTextures}, eventually
+         *      @fn_gl_keyword{ActiveTexture} and @fn_gl_keyword{BindTexture}
+         */
+        void bind() const;
+
+    private:
+        Int _firstTextureUnit;
+        std::vector<AbstractTexture*> _textures;
+};
+
+}
+
+#endif
@@ -25,36 +25,168 @@
 
 #include "Atlas.h"
 
+#include <algorithm>
+#include <numeric>
+#include <Corrade/Containers/EnumSet.hpp>
+#include <Corrade/Utility/Debug.h>
+
 #include "Magnum/Math/Functions.h"
-#include "Magnum/Math/Range.h"
 
 namespace Magnum { namespace TextureTools {
 
-std::vector<Range2Di> atlas(const Vector2i& atlasSize, const std::vector<Vector2i>& sizes, const Vector2i& padding) {
-    if(sizes.empty()) return {};
+namespace {
+    inline Vector2i flipped(const Vector2i& size) { return {size.y(), size.x()}; }
+}
 
-    /* Size of largest texture */
-    Vector2i maxSize;
-    for(const Vector2i& size: sizes)
-        maxSize = Math::max(maxSize, size);
+AtlasPacker::AtlasPacker(const Vector2i& pageSize, const Vector2i& padding, const Flags flags): _pageSize{pageSize}, _padding{padding}, _flags{flags} {
+    _pages.push_back({{0, 0, pageSize.x()}});
+}
 
-    std::vector<Range2Di> atlas;
+bool AtlasPacker::find(const std::vector<Segment>& skyline, const Vector2i& size, Int& x, Int& y) const {
+    bool found = false;
+    Int bestTop{};
+    for(std::size_t i = 0; i != skyline.size(); ++i) {
+        /* Segments are sorted by X, so no further segment can fit either */
+        const Int left = skyline[i].x;
+        if(left + size.x() > _pageSize.x()) break;
+
+        /* The rectangle has to lie on the highest segment it spans */
+        Int bottom = skyline[i].y;
+        for(std::size_t j = i + 1; j != skyline.size() && skyline[j].x < left + size.x(); ++j)
+            bottom = Math::max(bottom, skyline[j].y);
+
+        /* Lowest top edge wins, segments are traversed from the left so for
+           equal tops the leftmost one stays */
+        const Int top = bottom + size.y();
+        if(top > _pageSize.y() || (found && top >= bestTop)) continue;
+
+        found = true;
+        bestTop = top;
+        x = left;
+        y = bottom;
+    }
+
+    return found;
+}
+
+void AtlasPacker::place(std::vector<Segment>& skyline, const Range2Di& rectangle) {
+    /* The rectangle always starts at a beginning of some segment */
+    auto it = std::find_if(skyline.begin(), skyline.end(), [&rectangle](const Segment& segment) {
+        return segment.x == rectangle.left();
+    });
+    CORRADE_INTERNAL_ASSERT(it != skyline.end());
+    it = skyline.insert(it, {rectangle.left(), rectangle.top(), rectangle.sizeX()});
+
+    /* Remove or shorten segments covered by the rectangle */
+    const Int right = rectangle.right();
+    auto next = it + 1;
+    while(next != skyline.end() && next->x < right) {
+        if(next->x + next->width <= right) {
+            next = skyline.erase(next);
+            continue;
+        }
 
-    /* Columns and rows */
-    const Vector2i paddedSize = maxSize+2*padding;
-    const Vector2i gridSize = atlasSize/paddedSize;
-    if(std::size_t(gridSize.product()) < sizes.size()) {
-        Error() << "TextureTools::atlas(): requested atlas size" << atlasSize
-                << "is too small to fit" << sizes.size() << paddedSize
-                << "textures. Generated atlas will be empty.";
-        return atlas;
+        next->width -= right - next->x;
+        next->x = right;
+        break;
     }
 
-    /** @todo actual magic implementation, not this joke */
+    /* Merge neighbors of the same height */
+    for(std::size_t i = 1; i < skyline.size(); ) {
+        if(skyline[i - 1].y == skyline[i].y) {
+            skyline[i - 1].width += skyline[i].width;
+            skyline.erase(skyline.begin() + i);
+        } else ++i;
+    }
+}
+
+std::tuple<Int, Range2Di, bool> AtlasPacker::add(const Vector2i& size) {
+    const Vector2i paddedSize = size + 2*_padding;
+
+    /* Nothing to pack for empty rectangles */
+    if(!paddedSize.product()) return std::make_tuple(0, Range2Di::fromSize(_padding, size), false);
+
+    const bool tryRotated = (_flags & Flag::AllowRotation) && paddedSize.x() != paddedSize.y();
+
+    /* Pick first page where the rectangle fits, possibly adding a new one */
+    for(std::size_t page = 0; page <= _pages.size(); ++page) {
+        if(page == _pages.size()) {
+            /* Not adding a new page if it wouldn't fit there either */
+            if(!(_flags & Flag::MultiplePages) ||
+               (!(paddedSize <= _pageSize).all() && !(tryRotated && (flipped(paddedSize) <= _pageSize).all())))
+                break;
+
+            _pages.push_back({{0, 0, _pageSize.x()}});
+        }
+
+        std::vector<Segment>& skyline = _pages[page];
+        Int x, y, rotatedX, rotatedY;
+        const bool found = find(skyline, paddedSize, x, y);
+        const bool foundRotated = tryRotated && find(skyline, flipped(paddedSize), rotatedX, rotatedY);
+        if(!found && !foundRotated) continue;
 
+        /* Rotate only if it gets lower or equally low and more to the left */
+        const bool rotated = foundRotated && (!found ||
+            rotatedY + paddedSize.x() < y + paddedSize.y() ||
+            (rotatedY + paddedSize.x() == y + paddedSize.y() && rotatedX < x));
+        const Vector2i placedPaddedSize = rotated ? flipped(paddedSize) : paddedSize;
+        const Vector2i position = rotated ? Vector2i{rotatedX, rotatedY} : Vector2i{x, y};
+
+        place(skyline, Range2Di::fromSize(position, placedPaddedSize));
+        return std::make_tuple(Int(page), Range2Di::fromSize(position + _padding, rotated ? flipped(size) : size), rotated);
+    }
+
+    return std::make_tuple(-1, Range2Di{}, false);
+}
+
+std::vector<std::tuple<Int, Range2Di, bool>> AtlasPacker::add(const std::vector<Vector2i>& sizes) {
+    /* Pack higher rectangles first, wider first among the same height */
+    std::vector<std::size_t> order(sizes.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&sizes](std::size_t a, std::size_t b) {
+        return sizes[a].y() > sizes[b].y() || (sizes[a].y() == sizes[b].y() && sizes[a].x() > sizes[b].x());
+    });
+
+    std::vector<std::tuple<Int, Range2Di, bool>> out(sizes.size());
+    for(const std::size_t i: order) out[i] = add(sizes[i]);
+    return out;
+}
+
+Debug& operator<<(Debug& debug, const AtlasPacker::Flag value) {
+    switch(value) {
+        #define _c(v) case AtlasPacker::Flag::v: return debug << "TextureTools::AtlasPacker::Flag::" #v;
+        _c(AllowRotation)
+        _c(MultiplePages)
+        #undef _c
+    }
+
+    return debug << "TextureTools::AtlasPacker::Flag(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
+}
+
+Debug& operator<<(Debug& debug, const AtlasPacker::Flags value) {
+    return Containers::enumSetDebugOutput(debug, value, "TextureTools::AtlasPacker::Flags{}", {
+        AtlasPacker::Flag::AllowRotation,
+        AtlasPacker::Flag::MultiplePages});
+}
+
+std::vector<Range2Di> atlas(const Vector2i& atlasSize, const std::vector<Vector2i>& sizes, const Vector2i& padding) {
+    if(sizes.empty()) return {};
+
+    AtlasPacker packer{atlasSize, padding};
+    const std::vector<std::tuple<Int, Range2Di, bool>> packed = packer.add(sizes);
+
+    std::vector<Range2Di> atlas;
     atlas.reserve(sizes.size());
-    for(std::size_t i = 0; i != sizes.size(); ++i)
-        atlas.push_back(Range2Di::fromSize(Vector2i(i%gridSize.x(), i/gridSize.x())*paddedSize+padding, sizes[i]));
+    for(const std::tuple<Int, Range2Di, bool>& i: packed) {
+        if(std::get<0>(i) == -1) {
+            Error() << "TextureTools::atlas(): requested atlas size" << atlasSize
+                    << "is too small to fit" << sizes.size()
+                    << "textures. Generated atlas will be empty.";
+            return {};
+        }
+
+        atlas.push_back(std::get<1>(i));
+    }
 
     return atlas;
 }
@@ -26,17 +26,134 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::TextureTools::atlas()
+ * @brief Class @ref Magnum::TextureTools::AtlasPacker, function @ref Magnum::TextureTools::atlas()
  */
 
+#include <tuple>
 #include <vector>
+#include <Corrade/Containers/EnumSet.h>
 
 #include "Magnum/Magnum.h"
-#include "Magnum/Math/Vector2.h"
+#include "Magnum/Math/Range.h"
 #include "Magnum/TextureTools/visibility.h"
 
 namespace Magnum { namespace TextureTools {
 
+/**
+@brief Texture atlas packer
+
+Packs rectangles of varying size into one or more atlas pages using the
+skyline bottom-left algorithm. Each page keeps a skyline --- the top edge of
+already packed rectangles --- and every new rectangle is placed on the
+skyline so its top edge is as low as possible, preferring positions more on
+the left. Compared to packing into a uniform grid this wastes much less space
+when the sizes vary a lot.
+
+Rectangles can be packed one by one with @ref add(const Vector2i&), for
+example when new glyphs or sprites are needed at runtime, or all at once with
+@ref add(const std::vector<Vector2i>&), which packs the largest rectangles
+first for a tighter result:
+
+@snippet MagnumTextureTools.cpp AtlasPacker
+
+Padding is added twice to each size and the atlas is laid out so the padding
+doesn't overlap. Returned rectangles are without the padding.
+@see @ref atlas()
+*/
+class MAGNUM_TEXTURETOOLS_EXPORT AtlasPacker {
+    public:
+        /**
+         * @brief Flag
+         *
+         * @see @ref Flags, @ref AtlasPacker()
+         */
+        enum class Flag: UnsignedByte {
+            /**
+             * Allow rotating the rectangles by 90° if they fit better. The
+             * caller is then responsible for storing the texture data rotated.
+             */
+            AllowRotation = 1 << 0,
+
+            /**
+             * Allow creating new pages if a rectangle doesn't fit into any
+             * existing page. If not set, only a single page is used.
+             */
+            MultiplePages = 1 << 1
+        };
+
+        /**
+         * @brief Flags
+         *
+         * @see @ref AtlasPacker()
+         */
+        typedef Containers::EnumSet<Flag> Flags;
+
+        /**
+         * @brief Constructor
+         * @param pageSize  Size of each atlas page
+         * @param padding   Padding around each rectangle
+         * @param flags     Flags
+         *
+         * Initially there's one empty page.
+         */
+        explicit AtlasPacker(const Vector2i& pageSize, const Vector2i& padding = {}, Flags flags = {});
+
+        /** @brief Page size */
+        Vector2i pageSize() const { return _pageSize; }
+
+        /** @brief Padding */
+        Vector2i padding() const { return _padding; }
+
+        /** @brief Flags */
+        Flags flags() const { return _flags; }
+
+        /** @brief Page count */
+        std::size_t pageCount() const { return _pages.size(); }
+
+        /**
+         * @brief Add a rectangle
+         * @return Page index, rectangle in given page and whether the
+         *      rectangle was rotated
+         *
+         * If the rectangle was rotated, the returned rectangle size is
+         * @p size with the coordinates swapped. If the rectangle doesn't
+         * fit, returns @cpp -1 @ce as the page index and an empty
+         * rectangle.
+         */
+        std::tuple<Int, Range2Di, bool> add(const Vector2i& size);
+
+        /**
+         * @brief Add rectangles
+         *
+         * Packs the rectangles in order of decreasing height, which gives
+         * better results than adding them one by one with
+         * @ref add(const Vector2i&). The returned values are in the same
+         * order as @p sizes. If any of the rectangles doesn't fit, its page
+         * index is @cpp -1 @ce.
+         */
+        std::vector<std::tuple<Int, Range2Di, bool>> add(const std::vector<Vector2i>& sizes);
+
+    private:
+        struct Segment {
+            Int x, y, width;
+        };
+
+        bool find(const std::vector<Segment>& skyline, const Vector2i& size, Int& x, Int& y) const;
+        void place(std::vector<Segment>& skyline, const Range2Di& rectangle);
+
+        Vector2i _pageSize, _padding;
+        Flags _flags;
+        std::vector<std::vector<Segment>> _pages;
+};
+
+CORRADE_ENUMSET_OPERATORS(AtlasPacker::Flags)
+
+/** @debugoperatorclassenum{AtlasPacker,AtlasPacker::Flag} */
+MAGNUM_TEXTURETOOLS_EXPORT Debug& operator<<(Debug& debug, AtlasPacker::Flag value);
+
+/** @debugoperatorclassenum{AtlasPacker,AtlasPacker::Flags} */
+MAGNUM_TEXTURETOOLS_EXPORT Debug& operator<<(Debug& debug, AtlasPacker::Flags value);
+
 /**
 @brief Pack textures into texture atlas
 @param atlasSize    Size of resulting atlas
@@ -49,6 +166,10 @@ into required size, empty vector is returned.
 Padding is added twice to each size and the atlas is laid out so the padding
 don't overlap. Returned sizes are the same as original sizes, i.e. without the
 padding.
+
+The textures are packed using @ref AtlasPacker::add(const std::vector<Vector2i>&)
+on a single page without rotation, see @ref AtlasPacker for more information
+and for incremental packing, rotation and multi-page atlases.
 */
 std::vector<Range2Di> MAGNUM_TEXTURETOOLS_EXPORT atlas(const Vector2i& atlasSize, const std::vector<Vector2i>& sizes, const Vector2i& padding = Vector2i());
 
@@ -0,0 +1,664 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Compression.h"
+
+#include <tuple>
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/ThreadPool.h"
+
+namespace Magnum { namespace TextureTools {
+
+namespace {
+
+/* Calls the encoder for each 4x4 block of the first channel of the image,
+   edge blocks are padded by repeating last row and column */
+template<class Encoder> Containers::Array<char> compressBlocks(const ImageView2D& image, Encoder encoder) {
+    const Vector2i blockCount = (image.size() + Vector2i{3})/4;
+    Containers::Array<char> data{Containers::ValueInit, std::size_t(blockCount.product()*8)};
+    if(!image.size().product()) return data;
+
+    Math::Vector2<std::size_t> dataOffset, dataSize;
+    std::size_t pixelSize;
+    std::tie(dataOffset, dataSize, pixelSize) = image.dataProperties();
+    const char* const pixels = image.data() + dataOffset.sum();
+
+    UnsignedByte block[16];
+    char* out = data.begin();
+    for(Int by = 0; by != blockCount.y(); ++by) for(Int bx = 0; bx != blockCount.x(); ++bx) {
+        for(Int y = 0; y != 4; ++y) for(Int x = 0; x != 4; ++x) {
+            const std::size_t px = Math::min(bx*4 + x, image.size().x() - 1);
+            const std::size_t py = Math::min(by*4 + y, image.size().y() - 1);
+            block[y*4 + x] = UnsignedByte(pixels[py*dataSize.x() + px*pixelSize]);
+        }
+
+        encoder(block, out);
+        out += 8;
+    }
+
+    return data;
+}
+
+/* Calls the encoder for each 4x4 block of RGB or RGBA image, texels are
+   passed as RGBA with alpha set to 255 for RGB images. Rows of blocks are
+   distributed on the pool, if any. */
+template<class Encoder> Containers::Array<char> compressColorBlocks(const ImageView2D& image, const std::size_t blockDataSize, Encoder encoder, ThreadPool* const pool) {
+    const Vector2i blockCount = (image.size() + Vector2i{3})/4;
+    Containers::Array<char> data{Containers::ValueInit, std::size_t(blockCount.product())*blockDataSize};
+    if(!image.size().product()) return data;
+
+    Math::Vector2<std::size_t> dataOffset, dataSize;
+    std::size_t pixelSize;
+    std::tie(dataOffset, dataSize, pixelSize) = image.dataProperties();
+    const char* const pixels = image.data() + dataOffset.sum();
+
+    auto encodeRows = [&](const std::size_t begin, const std::size_t end) {
+        UnsignedByte block[16][4];
+        for(std::size_t by = begin; by != end; ++by) for(Int bx = 0; bx != blockCount.x(); ++bx) {
+            for(Int y = 0; y != 4; ++y) for(Int x = 0; x != 4; ++x) {
+                const std::size_t px = Math::min(bx*4 + x, image.size().x() - 1);
+                const std::size_t py = Math::min(Int(by)*4 + y, image.size().y() - 1);
+                const char* const texel = pixels + py*dataSize.x() + px*pixelSize;
+                for(std::size_t c = 0; c != 4; ++c)
+                    block[y*4 + x][c] = c < pixelSize ? UnsignedByte(texel[c]) : 255;
+            }
+
+            encoder(block, data.begin() + (by*blockCount.x() + bx)*blockDataSize);
+        }
+    };
+
+    if(pool) pool->parallelFor(blockCount.y(), 1, encodeRows);
+    else encodeRows(0, blockCount.y());
+
+    return data;
+}
+
+void encodeRgtc1Block(const UnsignedByte(&block)[16], char* const out) {
+    UnsignedByte min = block[0], max = block[0];
+    for(UnsignedByte value: block) {
+        min = Math::min(min, value);
+        max = Math::max(max, value);
+    }
+
+    /* With red0 > red1 the block uses eight values: the two endpoints
+       followed by six interpolated ones. If the block is flat, all indices
+       are zero and thus point to red0. */
+    out[0] = char(max);
+    out[1] = char(min);
+    if(max == min) return;
+
+    Float palette[8];
+    palette[0] = max;
+    palette[1] = min;
+    for(Int i = 2; i != 8; ++i)
+        palette[i] = ((8 - i)*Float(max) + (i - 1)*Float(min))/7.0f;
+
+    /* Indices are stored little-endian in the remaining 48 bits, texels in
+       row-major order */
+    UnsignedLong indices = 0;
+    for(Int i = 0; i != 16; ++i) {
+        UnsignedLong best = 0;
+        Float bestError = Math::abs(palette[0] - block[i]);
+        for(Int j = 1; j != 8; ++j) {
+            const Float error = Math::abs(palette[j] - block[i]);
+            if(error < bestError) {
+                best = j;
+                bestError = error;
+            }
+        }
+        indices |= best << (3*i);
+    }
+
+    for(Int i = 0; i != 6; ++i)
+        out[2 + i] = char((indices >> (8*i)) & 0xff);
+}
+
+UnsignedShort packRgb565(const Vector3& color) {
+    const Vector3 clamped = Math::clamp(color, 0.0f, 255.0f);
+    return UnsignedShort(Int(clamped.x()*31.0f/255.0f + 0.5f) << 11 |
+                         Int(clamped.y()*63.0f/255.0f + 0.5f) << 5 |
+                         Int(clamped.z()*31.0f/255.0f + 0.5f));
+}
+
+Vector3 unpackRgb565(const UnsignedShort color) {
+    const Int r = color >> 11, g = (color >> 5) & 0x3f, b = color & 0x1f;
+    return {Float(r << 3 | r >> 2), Float(g << 2 | g >> 4), Float(b << 3 | b >> 2)};
+}
+
+/* Squared error of the block for given packed endpoints, fills the indices.
+   The endpoints are ordered so the block is always in the four-color mode. */
+Float bc1BlockError(const Vector3(&colors)[16], UnsignedShort& color0, UnsignedShort& color1, UnsignedInt& indices) {
+    if(color0 < color1) std::swap(color0, color1);
+
+    const Vector3 palette[]{
+        unpackRgb565(color0),
+        unpackRgb565(color1),
+        (unpackRgb565(color0)*2.0f + unpackRgb565(color1))/3.0f,
+        (unpackRgb565(color0) + unpackRgb565(color1)*2.0f)/3.0f
+    };
+
+    Float error = 0.0f;
+    indices = 0;
+    for(Int i = 0; i != 16; ++i) {
+        UnsignedInt best = 0;
+        Float bestError = (palette[0] - colors[i]).dot();
+        /* If both endpoints are the same, the decoder uses the three-color
+           mode, keep all indices at zero */
+        if(color0 != color1) for(UnsignedInt j = 1; j != 4; ++j) {
+            const Float e = (palette[j] - colors[i]).dot();
+            if(e < bestError) {
+                best = j;
+                bestError = e;
+            }
+        }
+
+        indices |= best << (2*i);
+        error += bestError;
+    }
+
+    return error;
+}
+
+void encodeBc1ColorBlock(const UnsignedByte(&block)[16][4], const CompressionQuality quality, char* const out) {
+    Vector3 colors[16];
+    Vector3 mean, min{255.0f}, max{0.0f};
+    for(Int i = 0; i != 16; ++i) {
+        colors[i] = Vector3{Float(block[i][0]), Float(block[i][1]), Float(block[i][2])};
+        mean += colors[i];
+        min = Math::min(min, colors[i]);
+        max = Math::max(max, colors[i]);
+    }
+    mean /= 16.0f;
+
+    Vector3 endpoint0, endpoint1;
+    if(quality == CompressionQuality::Fast) {
+        /* Bounding box diagonal, flipped so it goes along the correlation of
+           the channels */
+        Float covarianceRG = 0.0f, covarianceRB = 0.0f;
+        for(const Vector3& color: colors) {
+            const Vector3 d = color - mean;
+            covarianceRG += d.x()*d.y();
+            covarianceRB += d.x()*d.z();
+        }
+        endpoint0 = max;
+        endpoint1 = min;
+        if(covarianceRG < 0.0f) std::swap(endpoint0.y(), endpoint1.y());
+        if(covarianceRB < 0.0f) std::swap(endpoint0.z(), endpoint1.z());
+
+    } else {
+        /* Principal axis of the colors using a power iteration on the
+           covariance matrix, endpoints are the extreme projections on it */
+        Float covariance[6]{};
+        for(const Vector3& color: colors) {
+            const Vector3 d = color - mean;
+            covariance[0] += d.x()*d.x();
+            covariance[1] += d.x()*d.y();
+            covariance[2] += d.x()*d.z();
+            covariance[3] += d.y()*d.y();
+            covariance[4] += d.y()*d.z();
+            covariance[5] += d.z()*d.z();
+        }
+
+        Vector3 axis = max - min;
+        for(Int i = 0; i != 8; ++i) {
+            axis = Vector3{
+                covariance[0]*axis.x() + covariance[1]*axis.y() + covariance[2]*axis.z(),
+                covariance[1]*axis.x() + covariance[3]*axis.y() + covariance[4]*axis.z(),
+                covariance[2]*axis.x() + covariance[4]*axis.y() + covariance[5]*axis.z()};
+            const Float length = axis.length();
+            if(length < 1.0e-6f) break;
+            axis /= length;
+        }
+
+        Float minProjection = 0.0f, maxProjection = 0.0f;
+        if(axis.dot() > 1.0e-6f) for(const Vector3& color: colors) {
+            const Float projection = Math::dot(color - mean, axis);
+            minProjection = Math::min(minProjection, projection);
+            maxProjection = Math::max(maxProjection, projection);
+        }
+        endpoint0 = mean + axis*maxProjection;
+        endpoint1 = mean + axis*minProjection;
+    }
+
+    UnsignedShort color0 = packRgb565(endpoint0), color1 = packRgb565(endpoint1);
+    UnsignedInt indices;
+    Float error = bc1BlockError(colors, color0, color1, indices);
+
+    /* Refit the endpoints to the chosen indices using least squares */
+    if(quality == CompressionQuality::High) for(Int iteration = 0; iteration != 2 && color0 != color1; ++iteration) {
+        constexpr Float Weights[]{1.0f, 0.0f, 2.0f/3.0f, 1.0f/3.0f};
+        Float aa = 0.0f, bb = 0.0f, ab = 0.0f;
+        Vector3 ax, bx;
+        for(Int i = 0; i != 16; ++i) {
+            const Float a = Weights[(indices >> (2*i)) & 0x3];
+            const Float b = 1.0f - a;
+            aa += a*a;
+            bb += b*b;
+            ab += a*b;
+            ax += colors[i]*a;
+            bx += colors[i]*b;
+        }
+
+        const Float determinant = aa*bb - ab*ab;
+        if(Math::abs(determinant) < 1.0e-6f) break;
+
+        UnsignedShort refined0 = packRgb565((ax*bb - bx*ab)/determinant);
+        UnsignedShort refined1 = packRgb565((bx*aa - ax*ab)/determinant);
+        UnsignedInt refinedIndices;
+        const Float refinedError = bc1BlockError(colors, refined0, refined1, refinedIndices);
+        if(refinedError >= error) break;
+
+        color0 = refined0;
+        color1 = refined1;
+        indices = refinedIndices;
+        error = refinedError;
+    }
+
+    /* All values are stored little-endian */
+    out[0] = char(color0 & 0xff);
+    out[1] = char(color0 >> 8);
+    out[2] = char(color1 & 0xff);
+    out[3] = char(color1 >> 8);
+    for(Int i = 0; i != 4; ++i)
+        out[4 + i] = char((indices >> (8*i)) & 0xff);
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+constexpr Int EacModifiers[16][8]{
+    {-3, -6,  -9, -15, 2, 5, 8, 14},
+    {-3, -7, -10, -13, 2, 6, 9, 12},
+    {-2, -5,  -8, -13, 1, 4, 7, 12},
+    {-2, -4,  -6, -13, 1, 3, 5, 12},
+    {-3, -6,  -8, -12, 2, 5, 7, 11},
+    {-3, -7,  -9, -11, 2, 6, 8, 10},
+    {-4, -7,  -8, -11, 3, 6, 7, 10},
+    {-3, -5,  -8, -11, 2, 4, 7, 10},
+    {-2, -6,  -8, -10, 1, 5, 7,  9},
+    {-2, -5,  -8, -10, 1, 4, 7,  9},
+    {-2, -4,  -8, -10, 1, 3, 7,  9},
+    {-2, -5,  -7, -10, 1, 4, 6,  9},
+    {-3, -4,  -7, -10, 2, 3, 6,  9},
+    {-1, -2,  -3, -10, 0, 1, 2,  9},
+    {-4, -6,  -8,  -9, 3, 5, 7,  8},
+    {-3, -5,  -7,  -9, 2, 4, 6,  8}
+};
+
+/* Squared error of the block for given parameters, fills the indices */
+Float eacBlockError(const Float(&values)[16], const Int base, const Int multiplier, const Int table, UnsignedLong& indices) {
+    Float palette[8];
+    for(Int i = 0; i != 8; ++i)
+        palette[i] = Math::clamp(base*8 + 4 + EacModifiers[table][i]*multiplier*8, 0, 2047);
+
+    Float error = 0.0f;
+    indices = 0;
+    for(Int i = 0; i != 16; ++i) {
+        UnsignedLong best = 0;
+        Float bestError = Math::pow<2>(palette[0] - values[i]);
+        for(Int j = 1; j != 8; ++j) {
+            const Float e = Math::pow<2>(palette[j] - values[i]);
+            if(e < bestError) {
+                best = j;
+                bestError = e;
+            }
+        }
+
+        /* Texels are stored in column-major order, the first one in the
+           highest bits */
+        const Int x = i%4, y = i/4;
+        indices |= best << (45 - 3*(x*4 + y));
+        error += bestError;
+    }
+
+    return error;
+}
+
+void encodeR11EacBlock(const UnsignedByte(&block)[16], char* const out) {
+    /* Work in the 11-bit range the decoder outputs */
+    Float values[16];
+    Float min = 2047.0f, max = 0.0f;
+    for(Int i = 0; i != 16; ++i) {
+        values[i] = block[i]*2047.0f/255.0f;
+        min = Math::min(min, values[i]);
+        max = Math::max(max, values[i]);
+    }
+
+    UnsignedLong bestBits = 0;
+    Float bestError = Constants::inf();
+    for(Int table = 0; table != 16; ++table) {
+        const Int lowest = EacModifiers[table][3];
+        const Int highest = EacModifiers[table][7];
+
+        /* Try multipliers and bases around the ones that map the table span
+           exactly onto the value range */
+        const Float idealMultiplier = (max - min)/(8.0f*(highest - lowest));
+        const Int multiplierBegin = Math::clamp(Int(idealMultiplier), 1, 15);
+        const Int multiplierEnd = Math::min(multiplierBegin + 2, 16);
+        for(Int multiplier = multiplierBegin; multiplier != multiplierEnd; ++multiplier) {
+            const Float idealBase = ((min + max)*0.5f - (lowest + highest)*multiplier*4.0f - 4.0f)/8.0f;
+            const Int baseBegin = Math::clamp(Int(idealBase) - 1, 0, 255);
+            const Int baseEnd = Math::min(Int(idealBase) + 3, 256);
+            for(Int base = baseBegin; base < baseEnd; ++base) {
+                UnsignedLong indices;
+                const Float error = eacBlockError(values, base, multiplier, table, indices);
+                if(error < bestError) {
+                    bestError = error;
+                    bestBits = UnsignedLong(base) << 56 | UnsignedLong(multiplier) << 52 | UnsignedLong(table) << 48 | indices;
+                }
+            }
+        }
+    }
+
+    /* The block is stored big-endian */
+    for(Int i = 0; i != 8; ++i)
+        out[i] = char((bestBits >> (56 - 8*i)) & 0xff);
+}
+
+void encodeEacAlphaBlock(const UnsignedByte(&block)[16][4], const CompressionQuality quality, char* const out) {
+    Int min = 255, max = 0;
+    for(Int i = 0; i != 16; ++i) {
+        min = Math::min(min, Int(block[i][3]));
+        max = Math::max(max, Int(block[i][3]));
+    }
+
+    /* Flat block, zero multiplier makes all indices decode to the base */
+    if(min == max) {
+        out[0] = char(min);
+        for(Int i = 1; i != 8; ++i) out[i] = 0;
+        return;
+    }
+
+    const Int tableStep = quality == CompressionQuality::Fast ? 4 : 1;
+    const Int searchRadius = quality == CompressionQuality::High ? 2 : 1;
+
+    UnsignedLong bestBits = 0;
+    Int bestError = 0x7fffffff;
+    for(Int table = 0; table < 16; table += tableStep) {
+        const Int lowest = EacModifiers[table][3];
+        const Int highest = EacModifiers[table][7];
+
+        const Int idealMultiplier = Int((max - min)/Float(highest - lowest) + 0.5f);
+        for(Int multiplier = Math::max(idealMultiplier - searchRadius + 1, 1); multiplier <= Math::min(idealMultiplier + searchRadius, 15); ++multiplier) {
+            const Int idealBase = Int((min + max)*0.5f - (lowest + highest)*multiplier*0.5f + 0.5f);
+            for(Int base = Math::max(idealBase - searchRadius, 0); base <= Math::min(idealBase + searchRadius, 255); ++base) {
+                Int palette[8];
+                for(Int i = 0; i != 8; ++i)
+                    palette[i] = Math::clamp(base + EacModifiers[table][i]*multiplier, 0, 255);
+
+                Int error = 0;
+                UnsignedLong indices = 0;
+                for(Int i = 0; i != 16; ++i) {
+                    UnsignedLong best = 0;
+                    Int bestTexelError = Math::pow<2>(palette[0] - block[i][3]);
+                    for(Int j = 1; j != 8; ++j) {
+                        const Int e = Math::pow<2>(palette[j] - block[i][3]);
+                        if(e < bestTexelError) {
+                            best = j;
+                            bestTexelError = e;
+                        }
+                    }
+
+                    /* Same texel order as in R11 EAC */
+                    const Int x = i%4, y = i/4;
+                    indices |= best << (45 - 3*(x*4 + y));
+                    error += bestTexelError;
+                }
+
+                if(error < bestError) {
+                    bestError = error;
+                    bestBits = UnsignedLong(base) << 56 | UnsignedLong(multiplier) << 52 | UnsignedLong(table) << 48 | indices;
+                }
+            }
+        }
+    }
+
+    for(Int i = 0; i != 8; ++i)
+        out[i] = char((bestBits >> (56 - 8*i)) & 0xff);
+}
+
+constexpr Int EtcModifiers[8][4]{
+    { 2,   8,  -2,   -8},
+    { 5,  17,  -5,  -17},
+    { 9,  29,  -9,  -29},
+    {13,  42, -13,  -42},
+    {18,  60, -18,  -60},
+    {24,  80, -24,  -80},
+    {33, 106, -33, -106},
+    {47, 183, -47, -183}
+};
+
+/* Texels of the two subblocks, for non-flipped (left and right half) and
+   flipped (top and bottom half) blocks, in row-major order */
+constexpr Int EtcSubblocks[2][2][8]{
+    {{0, 1, 4, 5, 8, 9, 12, 13}, {2, 3, 6, 7, 10, 11, 14, 15}},
+    {{0, 1, 2, 3, 4, 5, 6, 7}, {8, 9, 10, 11, 12, 13, 14, 15}}
+};
+
+/* Finds the best table for given subblock base color, returns its squared
+   error and adds the texel indices to the index bits */
+Int etcSubblockError(const UnsignedByte(&block)[16][4], const Int(&texels)[8], const Vector3i& base, UnsignedInt& table, UnsignedInt& indices) {
+    Int bestError = 0x7fffffff;
+    UnsignedInt bestIndices = 0;
+    for(UnsignedInt t = 0; t != 8; ++t) {
+        Int error = 0;
+        UnsignedInt tableIndices = 0;
+        for(const Int i: texels) {
+            UnsignedInt best = 0;
+            Int bestTexelError = 0x7fffffff;
+            for(UnsignedInt j = 0; j != 4; ++j) {
+                Int e = 0;
+                for(Int c = 0; c != 3; ++c)
+                    e += Math::pow<2>(Math::clamp(base[c] + EtcModifiers[t][j], 0, 255) - block[i][c]);
+                if(e < bestTexelError) {
+                    best = j;
+                    bestTexelError = e;
+                }
+            }
+
+            /* Texels are in column-major order, the most significant index
+               bits in the upper half */
+            const Int p = (i%4)*4 + i/4;
+            tableIndices |= (best >> 1) << (16 + p) | (best & 1) << p;
+            error += bestTexelError;
+        }
+
+        if(error < bestError) {
+            bestError = error;
+            bestIndices = tableIndices;
+            table = t;
+        }
+    }
+
+    indices |= bestIndices;
+    return bestError;
+}
+
+void encodeEtc2ColorBlock(const UnsignedByte(&block)[16][4], const CompressionQuality quality, char* const out) {
+    UnsignedLong bestBits = 0;
+    Int bestError = 0x7fffffff;
+
+    const Int offsetRadius = quality == CompressionQuality::High ? 1 : 0;
+    for(UnsignedInt flip = 0; flip != (quality == CompressionQuality::Fast ? 1 : 2); ++flip) {
+        Vector3 average[2];
+        for(Int s = 0; s != 2; ++s) {
+            for(const Int i: EtcSubblocks[flip][s])
+                average[s] += Vector3{Float(block[i][0]), Float(block[i][1]), Float(block[i][2])};
+            average[s] /= 8.0f;
+        }
+
+        /* Differential mode with 5-bit base colors and a 3-bit signed delta
+           first, individual mode with 4-bit base colors then. The
+           differential mode is used only if the delta fits, otherwise the
+           block would be decoded in one of the ETC2-specific modes. */
+        for(UnsignedInt differential = 1; differential != UnsignedInt(-1); --differential) {
+            const Int maxValue = differential ? 31 : 15;
+            for(Int offset0 = -offsetRadius; offset0 <= offsetRadius; ++offset0) for(Int offset1 = -offsetRadius; offset1 <= offsetRadius; ++offset1) {
+                Vector3i quantized[2];
+                for(Int s = 0; s != 2; ++s)
+                    quantized[s] = Math::clamp(Vector3i{average[s]*Float(maxValue)/255.0f + Vector3{0.5f}} + Vector3i{s ? offset1 : offset0}, 0, maxValue);
+
+                const Vector3i delta = quantized[1] - quantized[0];
+                if(differential && (delta.min() < -4 || delta.max() > 3)) continue;
+
+                Vector3i base[2];
+                for(Int s = 0; s != 2; ++s) for(Int c = 0; c != 3; ++c)
+                    base[s][c] = differential ?
+                        quantized[s][c] << 3 | quantized[s][c] >> 2 :
+                        quantized[s][c]*17;
+
+                UnsignedInt tables[2], indices = 0;
+                const Int error =
+                    etcSubblockError(block, EtcSubblocks[flip][0], base[0], tables[0], indices) +
+                    etcSubblockError(block, EtcSubblocks[flip][1], base[1], tables[1], indices);
+                if(error >= bestError) continue;
+
+                UnsignedLong bits = UnsignedLong(tables[0]) << 37 | UnsignedLong(tables[1]) << 34 | UnsignedLong(differential) << 33 | UnsignedLong(flip) << 32 | indices;
+                for(Int c = 0; c != 3; ++c) {
+                    const Int shift = 59 - 8*c;
+                    if(differential)
+                        bits |= UnsignedLong(quantized[0][c]) << shift | UnsignedLong(delta[c] & 0x7) << (shift - 3);
+                    else
+                        bits |= UnsignedLong(quantized[0][c]) << (shift + 1) | UnsignedLong(quantized[1][c]) << (shift - 3);
+                }
+
+                bestError = error;
+                bestBits = bits;
+            }
+
+            /* Good enough, skip the individual mode for fast compression */
+            if(quality == CompressionQuality::Fast && bestError != 0x7fffffff) break;
+        }
+    }
+
+    /* The block is stored big-endian */
+    for(Int i = 0; i != 8; ++i)
+        out[i] = char((bestBits >> (56 - 8*i)) & 0xff);
+}
+#endif
+
+CompressedImage2D compressBc1Internal(const ImageView2D& image, const CompressionQuality quality, ThreadPool* const pool) {
+    CORRADE_ASSERT(image.type() == PixelType::UnsignedByte && (image.pixelSize() == 3 || image.pixelSize() == 4),
+        "TextureTools::compressRgbBc1(): expected a three- or four-channel image with" << PixelType::UnsignedByte << "but got" << image.format() << "and" << image.type(), (CompressedImage2D{CompressedPixelFormat::RGBS3tcDxt1, {}, nullptr}));
+
+    return CompressedImage2D{CompressedPixelFormat::RGBS3tcDxt1, image.size(), compressColorBlocks(image, 8, [quality](const UnsignedByte(&block)[16][4], char* const out) {
+        encodeBc1ColorBlock(block, quality, out);
+    }, pool)};
+}
+
+CompressedImage2D compressBc3Internal(const ImageView2D& image, const CompressionQuality quality, ThreadPool* const pool) {
+    CORRADE_ASSERT(image.type() == PixelType::UnsignedByte && (image.pixelSize() == 3 || image.pixelSize() == 4),
+        "TextureTools::compressRgbaBc3(): expected a three- or four-channel image with" << PixelType::UnsignedByte << "but got" << image.format() << "and" << image.type(), (CompressedImage2D{CompressedPixelFormat::RGBAS3tcDxt5, {}, nullptr}));
+
+    return CompressedImage2D{CompressedPixelFormat::RGBAS3tcDxt5, image.size(), compressColorBlocks(image, 16, [quality](const UnsignedByte(&block)[16][4], char* const out) {
+        /* Alpha block has the same layout as RGTC1 */
+        UnsignedByte alpha[16];
+        for(Int i = 0; i != 16; ++i) alpha[i] = block[i][3];
+        encodeRgtc1Block(alpha, out);
+        encodeBc1ColorBlock(block, quality, out + 8);
+    }, pool)};
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+CompressedImage2D compressEtc2Internal(const ImageView2D& image, const CompressionQuality quality, ThreadPool* const pool) {
+    CORRADE_ASSERT(image.type() == PixelType::UnsignedByte && (image.pixelSize() == 3 || image.pixelSize() == 4),
+        "TextureTools::compressRgb8Etc2(): expected a three- or four-channel image with" << PixelType::UnsignedByte << "but got" << image.format() << "and" << image.type(), (CompressedImage2D{CompressedPixelFormat::RGB8Etc2, {}, nullptr}));
+
+    return CompressedImage2D{CompressedPixelFormat::RGB8Etc2, image.size(), compressColorBlocks(image, 8, [quality](const UnsignedByte(&block)[16][4], char* const out) {
+        encodeEtc2ColorBlock(block, quality, out);
+    }, pool)};
+}
+
+CompressedImage2D compressEtc2EacInternal(const ImageView2D& image, const CompressionQuality quality, ThreadPool* const pool) {
+    CORRADE_ASSERT(image.type() == PixelType::UnsignedByte && (image.pixelSize() == 3 || image.pixelSize() == 4),
+        "TextureTools::compressRgba8Etc2Eac(): expected a three- or four-channel image with" << PixelType::UnsignedByte << "but got" << image.format() << "and" << image.type(), (CompressedImage2D{CompressedPixelFormat::RGBA8Etc2Eac, {}, nullptr}));
+
+    return CompressedImage2D{CompressedPixelFormat::RGBA8Etc2Eac, image.size(), compressColorBlocks(image, 16, [quality](const UnsignedByte(&block)[16][4], char* const out) {
+        encodeEacAlphaBlock(block, quality, out);
+        encodeEtc2ColorBlock(block, quality, out + 8);
+    }, pool)};
+}
+#endif
+
+}
+
+#ifndef MAGNUM_TARGET_GLES
+CompressedImage2D compressRedRgtc1(const ImageView2D& image) {
+    CORRADE_ASSERT(image.type() == PixelType::UnsignedByte,
+        "TextureTools::compressRedRgtc1(): expected an image with" << PixelType::UnsignedByte << "but got" << image.type(), (CompressedImage2D{CompressedPixelFormat::RedRgtc1, {}, nullptr}));
+
+    return CompressedImage2D{CompressedPixelFormat::RedRgtc1, image.size(), compressBlocks(image, encodeRgtc1Block)};
+}
+#endif
+
+#ifndef MAGNUM_TARGET_GLES2
+CompressedImage2D compressR11Eac(const ImageView2D& image) {
+    CORRADE_ASSERT(image.type() == PixelType::UnsignedByte,
+        "TextureTools::compressR11Eac(): expected an image with" << PixelType::UnsignedByte << "but got" << image.type(), (CompressedImage2D{CompressedPixelFormat::R11Eac, {}, nullptr}));
+
+    return CompressedImage2D{CompressedPixelFormat::R11Eac, image.size(), compressBlocks(image, encodeR11EacBlock)};
+}
+#endif
+
+CompressedImage2D compressRgbBc1(const ImageView2D& image, const CompressionQuality quality) {
+    return compressBc1Internal(image, quality, nullptr);
+}
+
+CompressedImage2D compressRgbBc1(const ImageView2D& image, const CompressionQuality quality, ThreadPool& pool) {
+    return compressBc1Internal(image, quality, &pool);
+}
+
+CompressedImage2D compressRgbaBc3(const ImageView2D& image, const CompressionQuality quality) {
+    return compressBc3Internal(image, quality, nullptr);
+}
+
+CompressedImage2D compressRgbaBc3(const ImageView2D& image, const CompressionQuality quality, ThreadPool& pool) {
+    return compressBc3Internal(image, quality, &pool);
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+CompressedImage2D compressRgb8Etc2(const ImageView2D& image, const CompressionQuality quality) {
+    return compressEtc2Internal(image, quality, nullptr);
+}
+
+CompressedImage2D compressRgb8Etc2(const ImageView2D& image, const CompressionQuality quality, ThreadPool& pool) {
+    return compressEtc2Internal(image, quality, &pool);
+}
+
+CompressedImage2D compressRgba8Etc2Eac(const ImageView2D& image, const CompressionQuality quality) {
+    return compressEtc2EacInternal(image, quality, nullptr);
+}
+
+CompressedImage2D compressRgba8Etc2Eac(const ImageView2D& image, const CompressionQuality quality, ThreadPool& pool) {
+    return compressEtc2EacInternal(image, quality, &pool);
+}
+#endif
+
+}}
@@ -0,0 +1,227 @@
+#ifndef Magnum_TextureTools_Compression_h
+#define Magnum_TextureTools_Compression_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Enum @ref Magnum::TextureTools::CompressionQuality, function @ref Magnum::TextureTools::compressRedRgtc1(), @ref Magnum::TextureTools::compressR11Eac(), @ref Magnum::TextureTools::compressRgbBc1(), @ref Magnum::TextureTools::compressRgbaBc3(), @ref Magnum::TextureTools::compressRgb8Etc2(), @ref Magnum::TextureTools::compressRgba8Etc2Eac()
+ */
+
+#include "Magnum/Magnum.h"
+
+#include "Magnum/TextureTools/visibility.h"
+
+namespace Magnum { namespace TextureTools {
+
+/**
+@brief Compression quality
+
+Trades compression speed for the resulting image quality in
+@ref compressRgbBc1(), @ref compressRgbaBc3(), @ref compressRgb8Etc2() and
+@ref compressRgba8Etc2Eac().
+*/
+enum class CompressionQuality: UnsignedByte {
+    /**
+     * Fastest compression, suitable for data generated every frame. BC1
+     * endpoints are taken from the bounding box of block colors, ETC2 tries
+     * only one block orientation.
+     */
+    Fast,
+
+    /**
+     * Balanced compression. BC1 endpoints are fit along the principal axis
+     * of block colors, ETC2 tries both block orientations and both base
+     * color modes.
+     */
+    Normal,
+
+    /**
+     * Slowest compression. In addition to @ref CompressionQuality::Normal,
+     * BC1 endpoints are refined with a least-squares fit and ETC2 searches
+     * also base colors next to the ideal ones.
+     */
+    High
+};
+
+#ifndef MAGNUM_TARGET_GLES
+/**
+@brief Compress a single-channel image to RGTC1
+@return Image with @ref CompressedPixelFormat::RedRgtc1
+
+Encodes the first channel of @p image into 4x4 blocks of 8 bytes each, which
+is a quarter of the memory needed by the same image in @ref TextureFormat::R8
+and is directly usable with @ref Texture2D::setCompressedImage(). The format is
+known as BC4 in Direct3D. Blocks going over the image edge are filled by
+repeating the last row and column.
+
+Each block stores its minimal and maximal value and interpolates six values
+in between, so smooth gradients such as distance fields produced by
+@ref distanceField() compress with very little error.
+
+Expects that @p image has @ref PixelType::UnsignedByte.
+@requires_gl RGTC texture compression is not available in OpenGL ES or WebGL.
+    Use @ref compressR11Eac() there instead.
+@see @ref magnum-distancefieldconverter "magnum-distancefieldconverter"
+*/
+CompressedImage2D MAGNUM_TEXTURETOOLS_EXPORT compressRedRgtc1(const ImageView2D& image);
+#endif
+
+#ifndef MAGNUM_TARGET_GLES2
+/**
+@brief Compress a single-channel image to EAC R11
+@return Image with @ref CompressedPixelFormat::R11Eac
+
+Encodes the first channel of @p image into 4x4 blocks of 8 bytes each, the
+same size as with @ref compressRedRgtc1(). Blocks going over the image edge
+are filled by repeating the last row and column.
+
+Unlike RGTC1, EAC stores a base value, a multiplier and an index into one of
+sixteen predefined modifier tables for each block. The encoder tries the
+multipliers and base values nearest to the ideal fit of each table and picks
+the combination with the smallest squared error, which makes it noticeably
+slower than @ref compressRedRgtc1().
+
+Expects that @p image has @ref PixelType::UnsignedByte.
+@requires_gl43 Extension @extension{ARB,ES3_compatibility}
+@requires_gles30 ETC2/EAC texture compression is not available in OpenGL ES
+    2.0.
+*/
+CompressedImage2D MAGNUM_TEXTURETOOLS_EXPORT compressR11Eac(const ImageView2D& image);
+#endif
+
+/**
+@brief Compress a RGB image to BC1
+@return Image with @ref CompressedPixelFormat::RGBS3tcDxt1
+
+Encodes the first three channels of @p image into 4x4 blocks of 8 bytes each,
+which is one sixth of the memory needed by the same image in
+@ref TextureFormat::RGB8. The format is known as DXT1 or S3TC as well. Alpha
+channel, if present, is ignored. Blocks going over the image edge are filled
+by repeating the last row and column.
+
+Each block stores two endpoint colors in RGB565 and interpolates two more
+colors in between, the endpoint selection depends on @p quality. Expects that
+@p image has three or four channels of @ref PixelType::UnsignedByte.
+@requires_extension Extension @extension{EXT,texture_compression_s3tc}
+@requires_es_extension Extension @extension2{EXT,texture_compression_s3tc,texture_compression_s3tc}
+@requires_webgl_extension Extension @webgl_extension{WEBGL,compressed_texture_s3tc}
+@see @ref compressRgbBc1(const ImageView2D&, CompressionQuality, ThreadPool&)
+*/
+CompressedImage2D MAGNUM_TEXTURETOOLS_EXPORT compressRgbBc1(const ImageView2D& image, CompressionQuality quality = CompressionQuality::Normal);
+
+/**
+@brief Compress a RGB image to BC1 using a thread pool
+
+Same as @ref compressRgbBc1(const ImageView2D&, CompressionQuality), but rows
+of blocks are compressed in parallel on @p pool.
+*/
+CompressedImage2D MAGNUM_TEXTURETOOLS_EXPORT compressRgbBc1(const ImageView2D& image, CompressionQuality quality, ThreadPool& pool);
+
+/**
+@brief Compress a RGBA image to BC3
+@return Image with @ref CompressedPixelFormat::RGBAS3tcDxt5
+
+Encodes @p image into 4x4 blocks of 16 bytes each, a quarter of the memory
+needed by the same image in @ref TextureFormat::RGBA8. The format is known as
+DXT5 as well. Each block consists of an alpha block encoded the same way as
+in @ref compressRedRgtc1() followed by a color block encoded the same way as
+in @ref compressRgbBc1(). Images with three channels are compressed with
+opaque alpha.
+
+Expects that @p image has three or four channels of
+@ref PixelType::UnsignedByte.
+@requires_extension Extension @extension{EXT,texture_compression_s3tc}
+@requires_es_extension Extension @extension2{EXT,texture_compression_s3tc,texture_compression_s3tc}
+@requires_webgl_extension Extension @webgl_extension{WEBGL,compressed_texture_s3tc}
+@see @ref compressRgbaBc3(const ImageView2D&, CompressionQuality, ThreadPool&)
+*/
+CompressedImage2D MAGNUM_TEXTURETOOLS_EXPORT compressRgbaBc3(const ImageView2D& image, CompressionQuality quality = CompressionQuality::Normal);
+
+/**
+@brief Compress a RGBA image to BC3 using a thread pool
+
+Same as @ref compressRgbaBc3(const ImageView2D&, CompressionQuality), but rows
+of blocks are compressed in parallel on @p pool.
+*/
+CompressedImage2D MAGNUM_TEXTURETOOLS_EXPORT compressRgbaBc3(const ImageView2D& image, CompressionQuality quality, ThreadPool& pool);
+
+#ifndef MAGNUM_TARGET_GLES2
+/**
+@brief Compress a RGB image to ETC2
+@return Image with @ref CompressedPixelFormat::RGB8Etc2
+
+Encodes the first three channels of @p image into 4x4 blocks of 8 bytes each.
+Alpha channel, if present, is ignored. Blocks going over the image edge are
+filled by repeating the last row and column.
+
+The encoder uses only the individual and differential modes shared with ETC1,
+so the output is decodable by ETC1 decoders as well. Each block is split into
+two halves, each with a base color and an index into one of eight predefined
+intensity modifier tables. Expects that @p image has three or four channels of
+@ref PixelType::UnsignedByte.
+@requires_gl43 Extension @extension{ARB,ES3_compatibility}
+@requires_gles30 ETC2 texture compression is not available in OpenGL ES 2.0.
+@see @ref compressRgb8Etc2(const ImageView2D&, CompressionQuality, ThreadPool&)
+*/
+CompressedImage2D MAGNUM_TEXTURETOOLS_EXPORT compressRgb8Etc2(const ImageView2D& image, CompressionQuality quality = CompressionQuality::Normal);
+
+/**
+@brief Compress a RGB image to ETC2 using a thread pool
+
+Same as @ref compressRgb8Etc2(const ImageView2D&, CompressionQuality), but
+rows of blocks are compressed in parallel on @p pool.
+*/
+CompressedImage2D MAGNUM_TEXTURETOOLS_EXPORT compressRgb8Etc2(const ImageView2D& image, CompressionQuality quality, ThreadPool& pool);
+
+/**
+@brief Compress a RGBA image to ETC2 with an EAC alpha
+@return Image with @ref CompressedPixelFormat::RGBA8Etc2Eac
+
+Encodes @p image into 4x4 blocks of 16 bytes each. Each block consists of an
+8-bit EAC alpha block followed by a color block encoded the same way as in
+@ref compressRgb8Etc2(). Images with three channels are compressed with opaque
+alpha.
+
+Expects that @p image has three or four channels of
+@ref PixelType::UnsignedByte.
+@requires_gl43 Extension @extension{ARB,ES3_compatibility}
+@requires_gles30 ETC2/EAC texture compression is not available in OpenGL ES
+    2.0.
+@see @ref compressRgba8Etc2Eac(const ImageView2D&, CompressionQuality, ThreadPool&)
+*/
+CompressedImage2D MAGNUM_TEXTURETOOLS_EXPORT compressRgba8Etc2Eac(const ImageView2D& image, CompressionQuality quality = CompressionQuality::Normal);
+
+/**
+@brief Compress a RGBA image to ETC2 with an EAC alpha using a thread pool
+
+Same as @ref compressRgba8Etc2Eac(const ImageView2D&, CompressionQuality), but
+rows of blocks are compressed in parallel on @p pool.
+*/
+CompressedImage2D MAGNUM_TEXTURETOOLS_EXPORT compressRgba8Etc2Eac(const ImageView2D& image, CompressionQuality quality, ThreadPool& pool);
+#endif
+
+}}
+
+#endif
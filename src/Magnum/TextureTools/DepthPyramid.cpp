@@ -0,0 +1,354 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "DepthPyramid.h"
+
+#include <vector>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+#include <Corrade/Utility/Resource.h>
+
+#include "Magnum/AbstractShaderProgram.h"
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/Framebuffer.h"
+#include "Magnum/ImageFormat.h"
+#include "Magnum/Mesh.h"
+#include "Magnum/Renderer.h"
+#include "Magnum/Shader.h"
+#include "Magnum/Texture.h"
+#include "Magnum/TextureFormat.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Shaders/Implementation/CreateCompatibilityShader.h"
+
+#ifdef MAGNUM_BUILD_STATIC
+static void importTextureToolResources() {
+    CORRADE_RESOURCE_INITIALIZE(MagnumTextureTools_RCS)
+}
+#endif
+
+namespace Magnum { namespace TextureTools {
+
+namespace {
+
+enum: Int {
+    SourceTextureUnit = 0,
+    DestinationImageUnit = 0
+};
+
+const char* reductionDefine(const DepthPyramid::Reduction reduction) {
+    switch(reduction) {
+        case DepthPyramid::Reduction::Max: return "#define MAX\n";
+        case DepthPyramid::Reduction::Min: return "#define MIN\n";
+        case DepthPyramid::Reduction::MinMax: return "#define MIN_MAX\n";
+    }
+
+    CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+#ifndef MAGNUM_TARGET_WEBGL
+class DepthPyramidComputeShader: public AbstractShaderProgram {
+    public:
+        explicit DepthPyramidComputeShader(DepthPyramid::Reduction reduction);
+
+        DepthPyramidComputeShader& setSource(Int level, bool reduce) {
+            setUniform(0, level);
+            setUniform(1, reduce ? 1 : 0);
+            return *this;
+        }
+};
+
+DepthPyramidComputeShader::DepthPyramidComputeShader(const DepthPyramid::Reduction reduction) {
+    #ifdef MAGNUM_BUILD_STATIC
+    /* Import resources on static build, if not already */
+    if(!Utility::Resource::hasGroup("MagnumTextureTools"))
+        importTextureToolResources();
+    #endif
+    Utility::Resource rs("MagnumTextureTools");
+
+    #ifndef MAGNUM_TARGET_GLES
+    Shader comp = Shaders::Implementation::createCompatibilityShader(rs, Version::GL430, Shader::Type::Compute);
+    #else
+    Shader comp = Shaders::Implementation::createCompatibilityShader(rs, Version::GLES310, Shader::Type::Compute);
+    #endif
+    comp.addSource(reductionDefine(reduction))
+        .addSource(rs.get("DepthPyramid.glsl"))
+        .addSource(rs.get("DepthPyramid.comp"));
+
+    CORRADE_INTERNAL_ASSERT_OUTPUT(comp.compile());
+
+    attachShader(comp);
+
+    CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+}
+#endif
+
+class DepthPyramidShader: public AbstractShaderProgram {
+    public:
+        explicit DepthPyramidShader(DepthPyramid::Reduction reduction);
+
+        DepthPyramidShader& setSource(Int level, bool reduce) {
+            setUniform(sourceLevelUniform, level);
+            setUniform(reduceUniform, reduce ? 1 : 0);
+            return *this;
+        }
+
+        DepthPyramidShader& setDestinationSize(const Vector2i& size) {
+            setUniform(destinationSizeUniform, size);
+            return *this;
+        }
+
+    private:
+        Int sourceLevelUniform,
+            reduceUniform,
+            destinationSizeUniform;
+};
+
+DepthPyramidShader::DepthPyramidShader(const DepthPyramid::Reduction reduction) {
+    #ifdef MAGNUM_BUILD_STATIC
+    /* Import resources on static build, if not already */
+    if(!Utility::Resource::hasGroup("MagnumTextureTools"))
+        importTextureToolResources();
+    #endif
+    Utility::Resource rs("MagnumTextureTools");
+
+    #ifndef MAGNUM_TARGET_GLES
+    const Version v = Context::current().supportedVersion({Version::GL320, Version::GL300});
+    #else
+    const Version v = Version::GLES300;
+    #endif
+
+    Shader vert = Shaders::Implementation::createCompatibilityShader(rs, v, Shader::Type::Vertex);
+    Shader frag = Shaders::Implementation::createCompatibilityShader(rs, v, Shader::Type::Fragment);
+
+    vert.addSource(rs.get("FullScreenTriangle.glsl"))
+        .addSource(rs.get("DepthPyramid.vert"));
+    frag.addSource(reductionDefine(reduction))
+        .addSource(rs.get("DepthPyramid.glsl"))
+        .addSource(rs.get("DepthPyramid.frag"));
+
+    CORRADE_INTERNAL_ASSERT_OUTPUT(Shader::compile({vert, frag}));
+
+    attachShaders({vert, frag});
+
+    CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+
+    sourceLevelUniform = uniformLocation("sourceLevel");
+    reduceUniform = uniformLocation("reduce");
+    destinationSizeUniform = uniformLocation("destinationSize");
+    setUniform(uniformLocation("source"), SourceTextureUnit);
+}
+
+bool isComputeSupported(const DepthPyramid::Reduction reduction) {
+    #ifndef MAGNUM_TARGET_GLES
+    static_cast<void>(reduction);
+    return Context::current().isExtensionSupported<Extensions::GL::ARB::compute_shader>() &&
+        Context::current().isExtensionSupported<Extensions::GL::ARB::shader_image_load_store>();
+    #elif !defined(MAGNUM_TARGET_WEBGL)
+    /* There's no two-channel float image format in ES */
+    return reduction != DepthPyramid::Reduction::MinMax &&
+        Context::current().isVersionSupported(Version::GLES310);
+    #else
+    static_cast<void>(reduction);
+    return false;
+    #endif
+}
+
+}
+
+struct DepthPyramid::State {
+    explicit State(Reduction reduction, Path path): reduction{reduction}, path{path}, texture{NoCreate} {}
+
+    Reduction reduction;
+    Path path;
+    Vector2i size;
+    Int levelCount;
+    Texture2D texture;
+
+    /* Only one of these is used, depending on the path */
+    #ifndef MAGNUM_TARGET_WEBGL
+    std::unique_ptr<DepthPyramidComputeShader> computeShader;
+    #endif
+    std::unique_ptr<DepthPyramidShader> shader;
+    std::unique_ptr<Mesh> mesh;
+    std::vector<Framebuffer> framebuffers;
+};
+
+auto DepthPyramid::defaultPath(const Reduction reduction) -> Path {
+    return isComputeSupported(reduction) ? Path::Compute : Path::Fragment;
+}
+
+DepthPyramid::DepthPyramid(const Vector2i& size, const Reduction reduction): DepthPyramid{size, reduction, defaultPath(reduction)} {}
+
+DepthPyramid::DepthPyramid(const Vector2i& size, const Reduction reduction, const Path path): _state{new State{reduction, path}} {
+    #ifndef MAGNUM_TARGET_GLES
+    MAGNUM_ASSERT_EXTENSION_SUPPORTED(Extensions::GL::ARB::framebuffer_object);
+    #endif
+    CORRADE_ASSERT(path != Path::Compute || isComputeSupported(reduction),
+        "TextureTools::DepthPyramid: compute path is not supported for" << reduction, );
+
+    #ifndef MAGNUM_TARGET_WEBGL
+    if(path == Path::Compute)
+        _state->computeShader.reset(new DepthPyramidComputeShader{reduction});
+    else
+    #endif
+    {
+        _state->shader.reset(new DepthPyramidShader{reduction});
+
+        /* The vertices are generated from gl_VertexID */
+        _state->mesh.reset(new Mesh);
+        _state->mesh->setPrimitive(MeshPrimitive::Triangles)
+            .setCount(3);
+    }
+
+    setSize(size);
+}
+
+DepthPyramid::~DepthPyramid() = default;
+
+auto DepthPyramid::reduction() const -> Reduction { return _state->reduction; }
+
+auto DepthPyramid::path() const -> Path { return _state->path; }
+
+Vector2i DepthPyramid::size() const { return _state->size; }
+
+Int DepthPyramid::levelCount() const { return _state->levelCount; }
+
+Texture2D& DepthPyramid::texture() { return _state->texture; }
+
+DepthPyramid& DepthPyramid::setSize(const Vector2i& size) {
+    CORRADE_ASSERT(size.product(),
+        "TextureTools::DepthPyramid::setSize(): expected non-zero size, got" << size, *this);
+    if(_state->size == size) return *this;
+
+    _state->size = size;
+    _state->levelCount = Math::log2(size.max()) + 1;
+
+    /* Immutable storage can't be resized, create a new texture */
+    _state->texture = Texture2D{};
+    _state->texture.setMinificationFilter(Sampler::Filter::Nearest, Sampler::Mipmap::Nearest)
+        .setMagnificationFilter(Sampler::Filter::Nearest)
+        .setWrapping(Sampler::Wrapping::ClampToEdge)
+        .setStorage(_state->levelCount, _state->reduction == Reduction::MinMax ? TextureFormat::RG32F : TextureFormat::R32F, size);
+
+    /* Framebuffers for the fragment path, one for each level */
+    _state->framebuffers.clear();
+    if(_state->path == Path::Fragment) {
+        _state->framebuffers.reserve(_state->levelCount);
+        for(Int level = 0; level != _state->levelCount; ++level) {
+            _state->framebuffers.emplace_back(Range2Di{{}, Math::max(size >> level, Vector2i{1})});
+            _state->framebuffers.back().attachTexture(Framebuffer::ColorAttachment{0}, _state->texture, level);
+        }
+    }
+
+    return *this;
+}
+
+DepthPyramid& DepthPyramid::update(Texture2D& depth) {
+    #ifndef MAGNUM_TARGET_WEBGL
+    if(_state->path == Path::Compute) {
+        /* Level zero is a plain copy of the depth texture, each next level
+           reads the previous one. The levels don't overlap in memory, so the
+           same texture can be sampled and written at the same time. */
+        #ifndef MAGNUM_TARGET_GLES
+        const ImageFormat format = _state->reduction == Reduction::MinMax ? ImageFormat::RG32F : ImageFormat::R32F;
+        #else
+        const ImageFormat format = ImageFormat::R32F;
+        #endif
+        for(Int level = 0; level != _state->levelCount; ++level) {
+            const Vector2i levelSize = Math::max(_state->size >> level, Vector2i{1});
+            if(level == 0) {
+                depth.bind(SourceTextureUnit);
+                _state->computeShader->setSource(0, false);
+            } else {
+                _state->texture.bind(SourceTextureUnit);
+                _state->computeShader->setSource(level - 1, true);
+            }
+
+            _state->texture.bindImage(DestinationImageUnit, level, ImageAccess::WriteOnly, format);
+            _state->computeShader->dispatchCompute({(Vector2ui{levelSize} + Vector2ui{7})/8u, 1});
+            Renderer::setMemoryBarrier(Renderer::MemoryBarrier::TextureFetch|Renderer::MemoryBarrier::ShaderImageAccess);
+        }
+
+        return *this;
+    }
+    #endif
+
+    /* Rendering into a level while sampling the same texture is a feedback
+       loop unless the rendered level is outside of the sampled range, so the
+       sampled range is restricted to the previous level. texelFetch() level
+       is then relative to the base level. */
+    for(Int level = 0; level != _state->levelCount; ++level) {
+        const Vector2i levelSize = Math::max(_state->size >> level, Vector2i{1});
+        if(level == 0) {
+            depth.bind(SourceTextureUnit);
+            _state->shader->setSource(0, false);
+        } else {
+            _state->texture.setBaseLevel(level - 1)
+                .setMaxLevel(level - 1)
+                .bind(SourceTextureUnit);
+            _state->shader->setSource(0, true);
+        }
+
+        Framebuffer& framebuffer = _state->framebuffers[level];
+        framebuffer.bind();
+        CORRADE_ASSERT(framebuffer.checkStatus(FramebufferTarget::Draw) == Framebuffer::Status::Complete,
+            "TextureTools::DepthPyramid::update(): can't render into level" << level << Debug::nospace << ", unexpected framebuffer status" << framebuffer.checkStatus(FramebufferTarget::Draw), *this);
+
+        _state->shader->setDestinationSize(levelSize);
+        _state->mesh->draw(*_state->shader);
+    }
+
+    /* Make the whole pyramid accessible again */
+    _state->texture.setBaseLevel(0)
+        .setMaxLevel(_state->levelCount - 1);
+
+    return *this;
+}
+
+Debug& operator<<(Debug& debug, const DepthPyramid::Reduction value) {
+    switch(value) {
+        #define _c(v) case DepthPyramid::Reduction::v: return debug << "TextureTools::DepthPyramid::Reduction::" #v;
+        _c(Max)
+        _c(Min)
+        _c(MinMax)
+        #undef _c
+    }
+
+    return debug << "TextureTools::DepthPyramid::Reduction(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
+}
+
+Debug& operator<<(Debug& debug, const DepthPyramid::Path value) {
+    switch(value) {
+        #define _c(v) case DepthPyramid::Path::v: return debug << "TextureTools::DepthPyramid::Path::" #v;
+        _c(Compute)
+        _c(Fragment)
+        #undef _c
+    }
+
+    return debug << "TextureTools::DepthPyramid::Path(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
+}
+
+}}
@@ -0,0 +1,57 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/* Takes min and max depth of a 2x2 block of the source level. For odd source
+   sizes the last row and column include the remaining texels as well, so the
+   result stays conservative. Level zero is just a copy of the depth texture. */
+highp vec4 reduceDepth(highp sampler2D source, highp int sourceLevel, bool reduce, highp ivec2 position, highp ivec2 destinationSize) {
+    highp vec2 minMax;
+    if(!reduce) {
+        minMax = texelFetch(source, position, sourceLevel).rr;
+    } else {
+        highp ivec2 sourceSize = textureSize(source, sourceLevel);
+        highp ivec2 first = position*2;
+        highp ivec2 last = min(first + ivec2(1) + ivec2(equal(position, destinationSize - ivec2(1)))*(sourceSize & ivec2(1)), sourceSize - ivec2(1));
+        minMax = vec2(1.0, 0.0);
+        for(highp int y = first.y; y <= last.y; ++y) {
+            for(highp int x = first.x; x <= last.x; ++x) {
+                #ifdef MIN_MAX
+                highp vec2 value = texelFetch(source, ivec2(x, y), sourceLevel).rg;
+                #else
+                highp vec2 value = texelFetch(source, ivec2(x, y), sourceLevel).rr;
+                #endif
+                minMax = vec2(min(minMax.x, value.x), max(minMax.y, value.y));
+            }
+        }
+    }
+
+    #if defined(MIN_MAX)
+    return vec4(minMax, 0.0, 0.0);
+    #elif defined(MIN)
+    return vec4(minMax.x);
+    #else
+    return vec4(minMax.y);
+    #endif
+}
@@ -0,0 +1,240 @@
+#ifndef Magnum_TextureTools_DepthPyramid_h
+#define Magnum_TextureTools_DepthPyramid_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::TextureTools::DepthPyramid
+ */
+
+#include "Magnum/configure.h"
+
+#ifndef MAGNUM_TARGET_GLES2
+#include <memory>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Vector2.h"
+#include "Magnum/TextureTools/visibility.h"
+
+namespace Magnum { namespace TextureTools {
+
+/**
+@brief Hierarchical depth pyramid
+
+Builds a full mip chain from a depth texture, each level containing the
+farthest, nearest or both depths of a 2x2 block of the previous one. For odd
+sizes the last row and column include the remaining texels as well, so the
+pyramid stays conservative. Level zero is a plain copy of the depth texture.
+Useful for hierarchical Z occlusion culling with
+@ref Shaders::DrawCulling::Flag::HierarchicalZ or for screen-space effects
+that need a coarse min/max depth.
+
+@code{.cpp}
+Texture2D depth;
+depth.setMinificationFilter(Sampler::Filter::Nearest)
+    .setMagnificationFilter(Sampler::Filter::Nearest)
+    .setStorage(1, TextureFormat::DepthComponent32F, size);
+Framebuffer framebuffer{{{}, size}};
+framebuffer.attachTexture(Framebuffer::BufferAttachment::Depth, depth, 0);
+
+TextureTools::DepthPyramid pyramid{size};
+
+// draw the scene into framebuffer ...
+
+pyramid.update(depth);
+culling.bindDepthPyramid(pyramid.texture());
+@endcode
+
+### Implementation
+
+If compute shaders and image load/store are available, each level is built
+with a single compute dispatch followed by a memory barrier. Otherwise a
+fullscreen triangle is rendered into each level, with base and max level of
+the pyramid texture temporarily restricted to the previous level to avoid a
+rendering feedback loop. The fragment path leaves the pyramid level
+framebuffer bound and the viewport set to size of the last level. Blending,
+depth test and color mask affect the fragment path, so make sure they are in
+default state before calling @ref update().
+
+The depth texture is read using @glsl texelFetch() @ce, it's thus expected to
+have depth comparison disabled. The pyramid is stored in
+@ref TextureFormat::R32F or, for @ref Reduction::MinMax, in
+@ref TextureFormat::RG32F with nearest depth in the red and farthest depth in
+the green channel.
+
+@requires_gl30 Extension @extension{ARB,framebuffer_object} and GLSL 1.30
+@requires_gles30 Texture base and max level are not available in
+    OpenGL ES 2.0.
+@requires_es_extension Extension @extension{EXT,color_buffer_float} in
+    OpenGL ES 3.0 and WebGL 2.0 for the fragment path, as floating-point
+    formats are not renderable otherwise.
+*/
+class MAGNUM_TEXTURETOOLS_EXPORT DepthPyramid {
+    public:
+        /**
+         * @brief Depth reduction
+         *
+         * @see @ref reduction()
+         */
+        enum class Reduction: UnsignedByte {
+            /**
+             * Farthest depth of each block with @ref TextureFormat::R32F.
+             * Suitable for occlusion culling with the default
+             * @ref Renderer::DepthFunction::Less.
+             */
+            Max,
+
+            /** Nearest depth of each block with @ref TextureFormat::R32F. */
+            Min,
+
+            /**
+             * Nearest depth in the red and farthest depth in the green
+             * channel of @ref TextureFormat::RG32F. Image load/store in
+             * OpenGL ES doesn't support two-channel formats, so this always
+             * uses @ref Path::Fragment there.
+             */
+            MinMax
+        };
+
+        /**
+         * @brief Implementation path
+         *
+         * @see @ref path()
+         */
+        enum class Path: UnsignedByte {
+            /**
+             * Compute shader writing the levels through image load/store.
+             * @requires_gl43 Extension @extension{ARB,compute_shader}
+             * @requires_gl42 Extension @extension{ARB,shader_image_load_store}
+             * @requires_gles31 Compute shaders are not available in
+             *      OpenGL ES 3.0 and older.
+             * @requires_gles Compute shaders are not available in WebGL.
+             */
+            Compute,
+
+            /** Fullscreen triangle rendered into each level */
+            Fragment
+        };
+
+        /**
+         * @brief Default implementation path
+         *
+         * Returns @ref Path::Compute if compute shaders and image load/store
+         * are supported and @p reduction can be written through them,
+         * @ref Path::Fragment otherwise.
+         */
+        static Path defaultPath(Reduction reduction);
+
+        /**
+         * @brief Constructor
+         * @param size          Size of the depth texture
+         * @param reduction     Depth reduction
+         *
+         * Uses @ref defaultPath(). The pyramid texture is allocated with
+         * @cpp Math::log2(size.max()) + 1 @ce levels and nearest filtering.
+         */
+        explicit DepthPyramid(const Vector2i& size, Reduction reduction = Reduction::Max);
+
+        /**
+         * @brief Construct with explicit implementation path
+         *
+         * Expects that @ref Path::Compute is used only if supported for
+         * given @p reduction, see @ref defaultPath().
+         */
+        explicit DepthPyramid(const Vector2i& size, Reduction reduction, Path path);
+
+        /** @brief Copying is not allowed */
+        DepthPyramid(const DepthPyramid&) = delete;
+
+        /** @brief Moving is not allowed */
+        DepthPyramid(DepthPyramid&&) = delete;
+
+        ~DepthPyramid();
+
+        /** @brief Copying is not allowed */
+        DepthPyramid& operator=(const DepthPyramid&) = delete;
+
+        /** @brief Moving is not allowed */
+        DepthPyramid& operator=(DepthPyramid&&) = delete;
+
+        /** @brief Depth reduction */
+        Reduction reduction() const;
+
+        /** @brief Implementation path */
+        Path path() const;
+
+        /** @brief Size of level zero */
+        Vector2i size() const;
+
+        /** @brief Level count */
+        Int levelCount() const;
+
+        /**
+         * @brief Pyramid texture
+         *
+         * The texture is recreated on @ref setSize(), don't keep references
+         * to it across size changes.
+         */
+        Texture2D& texture();
+
+        /**
+         * @brief Set size of level zero
+         * @return Reference to self (for method chaining)
+         *
+         * Reallocates the pyramid texture if @p size differs from current
+         * size, contents of the pyramid are undefined until next
+         * @ref update().
+         */
+        DepthPyramid& setSize(const Vector2i& size);
+
+        /**
+         * @brief Update the pyramid
+         * @param depth     Depth texture of the same size as the pyramid,
+         *      usually attached as @ref Framebuffer::BufferAttachment::Depth
+         * @return Reference to self (for method chaining)
+         *
+         * Builds all pyramid levels from level zero of @p depth. After the
+         * call the pyramid can be immediately sampled.
+         */
+        DepthPyramid& update(Texture2D& depth);
+
+    private:
+        struct State;
+
+        std::unique_ptr<State> _state;
+};
+
+/** @debugoperatorclassenum{DepthPyramid,DepthPyramid::Reduction} */
+MAGNUM_TEXTURETOOLS_EXPORT Debug& operator<<(Debug& debug, DepthPyramid::Reduction value);
+
+/** @debugoperatorclassenum{DepthPyramid,DepthPyramid::Path} */
+MAGNUM_TEXTURETOOLS_EXPORT Debug& operator<<(Debug& debug, DepthPyramid::Path value);
+
+}}
+#else
+#error this header is not available in OpenGL ES 2.0 build
+#endif
+
+#endif
@@ -25,9 +25,19 @@
 
 #include "DistanceField.h"
 
+#include <cmath>
+#include <functional>
+#include <tuple>
+#include <vector>
+#include <Corrade/Containers/Array.h>
 #include <Corrade/Utility/Resource.h>
 
+#include "Magnum/Math/Functions.h"
 #include "Magnum/Math/Range.h"
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/ThreadPool.h"
 #include "Magnum/AbstractShaderProgram.h"
 #include "Magnum/Buffer.h"
 #include "Magnum/Context.h"
@@ -211,5 +221,134 @@ void distanceField(Texture2D& input, Texture2D& output, const Range2Di& rectangl
     /* Draw the mesh */
     mesh.draw(shader);
 }
+namespace {
+
+constexpr Float Infinity = 1.0e20f;
+
+/* Squared distance transform of a sampled function `f` of `count` samples
+   with given stride, done in-place in linear time. `v`, `z` and `d` are
+   scratch buffers of at least `count`, `count + 1` and `count` items. */
+void distanceTransform(Float* const f, const std::size_t stride, const Int count, Int* const v, Float* const z, Float* const d) {
+    Int k = 0;
+    v[0] = 0;
+    z[0] = -Infinity;
+    z[1] = Infinity;
+
+    /* Lower envelope of parabolas rooted at each sample */
+    for(Int q = 1; q != count; ++q) {
+        const Float fq = f[q*stride] + Float(q*q);
+        Float s;
+        for(;;) {
+            const Int r = v[k];
+            s = (fq - f[r*stride] - Float(r*r))/Float(2*(q - r));
+            if(s > z[k]) break;
+            --k;
+        }
+
+        ++k;
+        v[k] = q;
+        z[k] = s;
+        z[k + 1] = Infinity;
+    }
+
+    /* Sample the envelope */
+    k = 0;
+    for(Int q = 0; q != count; ++q) {
+        while(z[k + 1] < Float(q)) ++k;
+        d[q] = Float((q - v[k])*(q - v[k])) + f[v[k]*stride];
+    }
+
+    for(Int q = 0; q != count; ++q) f[q*stride] = d[q];
+}
+
+Image2D distanceFieldInternal(const ImageView2D& input, const Vector2i& outputSize, const Int radius, ThreadPool* const pool) {
+    CORRADE_ASSERT(input.type() == PixelType::UnsignedByte,
+        "TextureTools::distanceField(): expected an image with" << PixelType::UnsignedByte << "but got" << input.type(), (Image2D{PixelFormat::RGBA, PixelType::UnsignedByte}));
+    CORRADE_ASSERT(radius > 0,
+        "TextureTools::distanceField(): expected positive radius but got" << radius, (Image2D{PixelFormat::RGBA, PixelType::UnsignedByte}));
+
+    #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+    constexpr PixelFormat outputFormat = PixelFormat::Red;
+    #else
+    constexpr PixelFormat outputFormat = PixelFormat::Luminance;
+    #endif
+
+    /* Row stride of the output with default four-byte alignment */
+    const std::size_t outputStride = 4*((outputSize.x() + 3)/4);
+    Containers::Array<char> outputData{Containers::ValueInit, outputStride*outputSize.y()};
+    if(!input.size().product() || !outputSize.product())
+        return Image2D{outputFormat, PixelType::UnsignedByte, outputSize, std::move(outputData)};
+
+    const Int width = input.size().x();
+    const Int height = input.size().y();
+    const auto run = [pool](const std::size_t count, const std::function<void(std::size_t, std::size_t)>& job) {
+        if(pool) pool->parallelFor(count, 16, job);
+        else job(0, count);
+    };
+
+    /* Initialize squared distances to nearest white pixel and to nearest
+       black pixel. Pixels of the given color have zero distance to it. */
+    Math::Vector2<std::size_t> dataOffset, dataSize;
+    std::size_t pixelSize;
+    std::tie(dataOffset, dataSize, pixelSize) = input.dataProperties();
+    const char* const inputPixels = input.data() + dataOffset.sum();
+    std::vector<bool> white(width*height);
+    std::vector<Float> toWhite(width*height), toBlack(width*height);
+    for(Int y = 0; y != height; ++y) for(Int x = 0; x != width; ++x) {
+        const std::size_t i = y*width + x;
+        white[i] = UnsignedByte(inputPixels[y*dataSize.x() + x*pixelSize]) > 127;
+        toWhite[i] = white[i] ? 0.0f : Infinity;
+        toBlack[i] = white[i] ? Infinity : 0.0f;
+    }
+
+    /* Transform all columns, then all rows. Each line is independent. */
+    const Int maxSize = Math::max(width, height);
+    run(width, [&](const std::size_t begin, const std::size_t end) {
+        std::vector<Int> v(maxSize);
+        std::vector<Float> z(maxSize + 1), d(maxSize);
+        for(std::size_t x = begin; x != end; ++x) {
+            distanceTransform(toWhite.data() + x, width, height, v.data(), z.data(), d.data());
+            distanceTransform(toBlack.data() + x, width, height, v.data(), z.data(), d.data());
+        }
+    });
+    run(height, [&](const std::size_t begin, const std::size_t end) {
+        std::vector<Int> v(maxSize);
+        std::vector<Float> z(maxSize + 1), d(maxSize);
+        for(std::size_t y = begin; y != end; ++y) {
+            distanceTransform(toWhite.data() + y*width, 1, width, v.data(), z.data(), d.data());
+            distanceTransform(toBlack.data() + y*width, 1, width, v.data(), z.data(), d.data());
+        }
+    });
+
+    /* Sample the distances at output pixel centers. The distance is measured
+       between pixel centers, subtract half a pixel to have the edge exactly
+       between two pixels of opposite color. */
+    const Vector2 scaling = Vector2{input.size()}/Vector2{outputSize};
+    run(outputSize.y(), [&](const std::size_t begin, const std::size_t end) {
+        for(std::size_t oy = begin; oy != end; ++oy) {
+            const Int y = Math::min(Int((oy + 0.5f)*scaling.y()), height - 1);
+            for(Int ox = 0; ox != outputSize.x(); ++ox) {
+                const Int x = Math::min(Int((ox + 0.5f)*scaling.x()), width - 1);
+                const std::size_t i = y*width + x;
+                const Float distance = white[i] ?
+                    std::sqrt(toBlack[i]) - 0.5f : 0.5f - std::sqrt(toWhite[i]);
+                const Float value = Math::clamp(0.5f + distance/(2.0f*radius), 0.0f, 1.0f);
+                outputData[oy*outputStride + ox] = char(UnsignedByte(value*255.0f + 0.5f));
+            }
+        }
+    });
+
+    return Image2D{outputFormat, PixelType::UnsignedByte, outputSize, std::move(outputData)};
+}
+
+}
+
+Image2D distanceField(const ImageView2D& input, const Vector2i& outputSize, const Int radius) {
+    return distanceFieldInternal(input, outputSize, radius, nullptr);
+}
+
+Image2D distanceField(const ImageView2D& input, const Vector2i& outputSize, const Int radius, ThreadPool& pool) {
+    return distanceFieldInternal(input, outputSize, radius, &pool);
+}
 
 }}
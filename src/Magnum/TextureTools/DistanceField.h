@@ -29,9 +29,7 @@
  * @brief Function @ref Magnum::TextureTools::distanceField()
  */
 
-#ifndef MAGNUM_TARGET_GLES
 #include "Magnum/Math/Vector2.h"
-#endif
 #include "Magnum/Magnum.h"
 
 #include "Magnum/TextureTools/visibility.h"
@@ -93,6 +91,8 @@ http://www.valvesoftware.com/publications/2007/SIGGRAPH2007_AlphaTestedMagnifica
 
 @bug ES (and maybe GL < 3.20) implementation behaves slightly different
     (jaggies, visible e.g. when rendering outlined fonts)
+
+@see @ref distanceField(const ImageView2D&, const Vector2i&, Int)
 */
 #ifndef MAGNUM_TARGET_GLES
 void MAGNUM_TEXTURETOOLS_EXPORT distanceField(Texture2D& input, Texture2D& output, const Range2Di& rectangle, Int radius, const Vector2i& imageSize = Vector2i());
@@ -100,6 +100,52 @@ void MAGNUM_TEXTURETOOLS_EXPORT distanceField(Texture2D& input, Texture2D& outpu
 void MAGNUM_TEXTURETOOLS_EXPORT distanceField(Texture2D& input, Texture2D& output, const Range2Di& rectangle, Int radius, const Vector2i& imageSize);
 #endif
 
+/**
+@brief Create signed distance field on the CPU
+@param input        Input image
+@param outputSize   Size of the output image
+@param radius       Distance in @p input pixels that is mapped to the whole
+    output value range
+@return Image of @p outputSize with @ref PixelFormat::Red and
+    @ref PixelType::UnsignedByte (@ref PixelFormat::Luminance in WebGL 1.0)
+
+Variant of @ref distanceField(Texture2D&, Texture2D&, const Range2Di&, Int, const Vector2i&)
+that doesn't need any GPU context, useful for offline processing e.g. on
+headless build machines. Output values have the same meaning as in the GPU
+implementation --- @cpp 0.5 @ce on edges, going toward @cpp 1.0 @ce inside
+white areas and toward @cpp 0.0 @ce inside black areas, saturating at
+@p radius.
+
+Expects that @p input has @ref PixelType::UnsignedByte, only the first channel
+is taken into account and values above @cpp 127 @ce are treated as white.
+
+### The algorithm
+
+Instead of searching a @p radius-sized neighborhood for each pixel, exact
+Euclidean distances to nearest pixel of opposite color are calculated for the
+whole @p input image using two separable passes of a linear-time squared
+distance transform, first over all columns and then over all rows. The time
+complexity is thus @f$ \mathcal{O}(n) @f$ in the pixel count and doesn't
+depend on @p radius. The output is then point-sampled from the full-resolution
+distance map.
+
+Based on: *Pedro F. Felzenszwalb, Daniel P. Huttenlocher - Distance Transforms
+of Sampled Functions, Theory of Computing, Vol. 8, 2012,
+http://cs.brown.edu/people/pfelzens/papers/dt-final.pdf*
+
+@see @ref distanceField(const ImageView2D&, const Vector2i&, Int, ThreadPool&)
+*/
+Image2D MAGNUM_TEXTURETOOLS_EXPORT distanceField(const ImageView2D& input, const Vector2i& outputSize, Int radius);
+
+/**
+@brief Create signed distance field on the CPU using a thread pool
+
+Same as @ref distanceField(const ImageView2D&, const Vector2i&, Int), but the
+column and row passes as well as the output sampling are split among threads
+of @p pool. The result is the same regardless of thread count.
+*/
+Image2D MAGNUM_TEXTURETOOLS_EXPORT distanceField(const ImageView2D& input, const Vector2i& outputSize, Int radius, ThreadPool& pool);
+
 }}
 
 #endif
@@ -0,0 +1,399 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "EnvironmentFilter.h"
+
+#include <vector>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+#include <Corrade/Utility/Resource.h>
+
+#include "Magnum/AbstractShaderProgram.h"
+#include "Magnum/Context.h"
+#include "Magnum/CubeMapTexture.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/Framebuffer.h"
+#include "Magnum/ImageFormat.h"
+#include "Magnum/Mesh.h"
+#include "Magnum/Renderer.h"
+#include "Magnum/Shader.h"
+#include "Magnum/Texture.h"
+#include "Magnum/TextureFormat.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Shaders/Implementation/CreateCompatibilityShader.h"
+
+#ifdef MAGNUM_BUILD_STATIC
+static void importTextureToolResources() {
+    CORRADE_RESOURCE_INITIALIZE(MagnumTextureTools_RCS)
+}
+#endif
+
+namespace Magnum { namespace TextureTools {
+
+namespace {
+
+enum: Int {
+    SourceTextureUnit = 0,
+    DestinationImageUnit = 0
+};
+
+enum class Pass: UnsignedByte {
+    Coefficients,
+    Irradiance,
+    Specular
+};
+
+const char* passDefine(const Pass pass) {
+    switch(pass) {
+        case Pass::Coefficients: return "#define COEFFICIENTS\n";
+        case Pass::Irradiance: return "#define IRRADIANCE\n";
+        case Pass::Specular: return "#define SPECULAR\n";
+    }
+
+    CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+constexpr CubeMapCoordinate Faces[]{
+    CubeMapCoordinate::PositiveX,
+    CubeMapCoordinate::NegativeX,
+    CubeMapCoordinate::PositiveY,
+    CubeMapCoordinate::NegativeY,
+    CubeMapCoordinate::PositiveZ,
+    CubeMapCoordinate::NegativeZ
+};
+
+#ifndef MAGNUM_TARGET_WEBGL
+class EnvironmentFilterComputeShader: public AbstractShaderProgram {
+    public:
+        explicit EnvironmentFilterComputeShader(Pass pass);
+
+        EnvironmentFilterComputeShader& setSpecular(Float roughness, UnsignedInt sampleCount) {
+            setUniform(0, roughness);
+            setUniform(1, Int(sampleCount));
+            return *this;
+        }
+};
+
+EnvironmentFilterComputeShader::EnvironmentFilterComputeShader(const Pass pass) {
+    #ifdef MAGNUM_BUILD_STATIC
+    /* Import resources on static build, if not already */
+    if(!Utility::Resource::hasGroup("MagnumTextureTools"))
+        importTextureToolResources();
+    #endif
+    Utility::Resource rs("MagnumTextureTools");
+
+    #ifndef MAGNUM_TARGET_GLES
+    Shader comp = Shaders::Implementation::createCompatibilityShader(rs, Version::GL430, Shader::Type::Compute);
+    #else
+    Shader comp = Shaders::Implementation::createCompatibilityShader(rs, Version::GLES310, Shader::Type::Compute);
+    #endif
+    comp.addSource(passDefine(pass))
+        .addSource(rs.get("EnvironmentFilter.glsl"))
+        .addSource(rs.get("EnvironmentFilter.comp"));
+
+    CORRADE_INTERNAL_ASSERT_OUTPUT(comp.compile());
+
+    attachShader(comp);
+
+    CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+}
+#endif
+
+class EnvironmentFilterShader: public AbstractShaderProgram {
+    public:
+        explicit EnvironmentFilterShader(Pass pass);
+
+        EnvironmentFilterShader& setDestination(Int face, Int size) {
+            setUniform(faceUniform, face);
+            setUniform(sizeUniform, size);
+            return *this;
+        }
+
+        EnvironmentFilterShader& setSpecular(Float roughness, UnsignedInt sampleCount) {
+            setUniform(roughnessUniform, roughness);
+            setUniform(sampleCountUniform, Int(sampleCount));
+            return *this;
+        }
+
+    private:
+        Int faceUniform{-1},
+            sizeUniform{-1},
+            roughnessUniform{-1},
+            sampleCountUniform{-1};
+};
+
+EnvironmentFilterShader::EnvironmentFilterShader(const Pass pass) {
+    #ifdef MAGNUM_BUILD_STATIC
+    /* Import resources on static build, if not already */
+    if(!Utility::Resource::hasGroup("MagnumTextureTools"))
+        importTextureToolResources();
+    #endif
+    Utility::Resource rs("MagnumTextureTools");
+
+    #ifndef MAGNUM_TARGET_GLES
+    const Version v = Context::current().supportedVersion({Version::GL320, Version::GL300});
+    #else
+    const Version v = Version::GLES300;
+    #endif
+
+    Shader vert = Shaders::Implementation::createCompatibilityShader(rs, v, Shader::Type::Vertex);
+    Shader frag = Shaders::Implementation::createCompatibilityShader(rs, v, Shader::Type::Fragment);
+
+    vert.addSource(rs.get("FullScreenTriangle.glsl"))
+        .addSource(rs.get("EnvironmentFilter.vert"));
+    frag.addSource(passDefine(pass))
+        .addSource(rs.get("EnvironmentFilter.glsl"))
+        .addSource(rs.get("EnvironmentFilter.frag"));
+
+    CORRADE_INTERNAL_ASSERT_OUTPUT(Shader::compile({vert, frag}));
+
+    attachShaders({vert, frag});
+
+    CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+
+    if(pass == Pass::Coefficients) {
+        setUniform(uniformLocation("environment"), SourceTextureUnit);
+        return;
+    }
+
+    faceUniform = uniformLocation("face");
+    sizeUniform = uniformLocation("size");
+    if(pass == Pass::Irradiance) {
+        setUniform(uniformLocation("coefficients"), SourceTextureUnit);
+    } else {
+        roughnessUniform = uniformLocation("roughness");
+        sampleCountUniform = uniformLocation("sampleCount");
+        setUniform(uniformLocation("environment"), SourceTextureUnit);
+    }
+}
+
+bool isComputeSupported() {
+    #ifndef MAGNUM_TARGET_GLES
+    return Context::current().isExtensionSupported<Extensions::GL::ARB::compute_shader>() &&
+        Context::current().isExtensionSupported<Extensions::GL::ARB::shader_image_load_store>();
+    #elif !defined(MAGNUM_TARGET_WEBGL)
+    return Context::current().isVersionSupported(Version::GLES310);
+    #else
+    return false;
+    #endif
+}
+
+}
+
+struct EnvironmentFilter::State {
+    explicit State(Path path): path{path} {}
+
+    Path path;
+    Int specularSize,
+        specularLevelCount,
+        irradianceSize;
+    UnsignedInt sampleCount{64};
+    CubeMapTexture specular, irradiance;
+    Texture2D coefficients;
+
+    /* Only one of these sets is used, depending on the path. The shaders
+       are indexed with Pass. */
+    #ifndef MAGNUM_TARGET_WEBGL
+    std::vector<EnvironmentFilterComputeShader> computeShaders;
+    #endif
+    std::vector<EnvironmentFilterShader> shaders;
+    std::unique_ptr<Mesh> mesh;
+    /* Coefficients, then six irradiance faces, then six specular faces for
+       each level */
+    std::vector<Framebuffer> framebuffers;
+};
+
+auto EnvironmentFilter::defaultPath() -> Path {
+    return isComputeSupported() ? Path::Compute : Path::Fragment;
+}
+
+EnvironmentFilter::EnvironmentFilter(const Int specularSize, const Int specularLevelCount, const Int irradianceSize): EnvironmentFilter{specularSize, specularLevelCount, irradianceSize, defaultPath()} {}
+
+EnvironmentFilter::EnvironmentFilter(const Int specularSize, const Int specularLevelCount, const Int irradianceSize, const Path path): _state{new State{path}} {
+    #ifndef MAGNUM_TARGET_GLES
+    MAGNUM_ASSERT_EXTENSION_SUPPORTED(Extensions::GL::ARB::framebuffer_object);
+    #endif
+    CORRADE_ASSERT(path != Path::Compute || isComputeSupported(),
+        "TextureTools::EnvironmentFilter: compute path is not supported", );
+    CORRADE_ASSERT(specularSize > 0 && irradianceSize > 0,
+        "TextureTools::EnvironmentFilter: expected non-zero sizes, got" << specularSize << "and" << irradianceSize, );
+    CORRADE_ASSERT(specularLevelCount > 0 && specularLevelCount <= Math::log2(specularSize) + 1,
+        "TextureTools::EnvironmentFilter: expected 1 to" << Math::log2(specularSize) + 1 << "levels for size" << specularSize << "but got" << specularLevelCount, );
+
+    State& state = *_state;
+    state.specularSize = specularSize;
+    state.specularLevelCount = specularLevelCount;
+    state.irradianceSize = irradianceSize;
+
+    state.specular.setMinificationFilter(Sampler::Filter::Linear, Sampler::Mipmap::Linear)
+        .setMagnificationFilter(Sampler::Filter::Linear)
+        .setWrapping(Sampler::Wrapping::ClampToEdge)
+        .setStorage(specularLevelCount, TextureFormat::RGBA16F, Vector2i{specularSize});
+    state.irradiance.setMinificationFilter(Sampler::Filter::Linear)
+        .setMagnificationFilter(Sampler::Filter::Linear)
+        .setWrapping(Sampler::Wrapping::ClampToEdge)
+        .setStorage(1, TextureFormat::RGBA16F, Vector2i{irradianceSize});
+    state.coefficients.setMinificationFilter(Sampler::Filter::Nearest)
+        .setMagnificationFilter(Sampler::Filter::Nearest)
+        .setWrapping(Sampler::Wrapping::ClampToEdge)
+        .setStorage(1, TextureFormat::RGBA32F, {9, 1});
+
+    #ifndef MAGNUM_TARGET_WEBGL
+    if(path == Path::Compute) {
+        state.computeShaders.reserve(3);
+        for(Pass pass: {Pass::Coefficients, Pass::Irradiance, Pass::Specular})
+            state.computeShaders.emplace_back(pass);
+        return;
+    }
+    #endif
+
+    state.shaders.reserve(3);
+    for(Pass pass: {Pass::Coefficients, Pass::Irradiance, Pass::Specular})
+        state.shaders.emplace_back(pass);
+
+    /* The vertices are generated from gl_VertexID */
+    state.mesh.reset(new Mesh);
+    state.mesh->setPrimitive(MeshPrimitive::Triangles)
+        .setCount(3);
+
+    state.framebuffers.reserve(7 + 6*specularLevelCount);
+    state.framebuffers.emplace_back(Range2Di{{}, {9, 1}});
+    state.framebuffers.back().attachTexture(Framebuffer::ColorAttachment{0}, state.coefficients, 0);
+    for(CubeMapCoordinate face: Faces) {
+        state.framebuffers.emplace_back(Range2Di{{}, Vector2i{irradianceSize}});
+        state.framebuffers.back().attachCubeMapTexture(Framebuffer::ColorAttachment{0}, state.irradiance, face, 0);
+    }
+    for(Int level = 0; level != specularLevelCount; ++level) {
+        for(CubeMapCoordinate face: Faces) {
+            state.framebuffers.emplace_back(Range2Di{{}, Vector2i{Math::max(specularSize >> level, 1)}});
+            state.framebuffers.back().attachCubeMapTexture(Framebuffer::ColorAttachment{0}, state.specular, face, level);
+        }
+    }
+}
+
+EnvironmentFilter::~EnvironmentFilter() = default;
+
+auto EnvironmentFilter::path() const -> Path { return _state->path; }
+
+Int EnvironmentFilter::specularSize() const { return _state->specularSize; }
+
+Int EnvironmentFilter::specularLevelCount() const { return _state->specularLevelCount; }
+
+Int EnvironmentFilter::irradianceSize() const { return _state->irradianceSize; }
+
+UnsignedInt EnvironmentFilter::sampleCount() const { return _state->sampleCount; }
+
+EnvironmentFilter& EnvironmentFilter::setSampleCount(const UnsignedInt count) {
+    CORRADE_ASSERT(count,
+        "TextureTools::EnvironmentFilter::setSampleCount(): expected non-zero sample count", *this);
+    _state->sampleCount = count;
+    return *this;
+}
+
+CubeMapTexture& EnvironmentFilter::specular() { return _state->specular; }
+
+CubeMapTexture& EnvironmentFilter::irradiance() { return _state->irradiance; }
+
+Texture2D& EnvironmentFilter::irradianceCoefficients() { return _state->coefficients; }
+
+EnvironmentFilter& EnvironmentFilter::update(CubeMapTexture& environment) {
+    State& state = *_state;
+
+    /* Roughness of given specular level */
+    auto roughness = [&state](Int level) {
+        return state.specularLevelCount == 1 ? 0.0f : Float(level)/Float(state.specularLevelCount - 1);
+    };
+
+    #ifndef MAGNUM_TARGET_WEBGL
+    if(state.path == Path::Compute) {
+        /* Coefficients in a single work group, then the irradiance evaluated
+           from them. The specular levels depend only on the environment. */
+        environment.bind(SourceTextureUnit);
+        state.coefficients.bindImage(DestinationImageUnit, 0, ImageAccess::WriteOnly, ImageFormat::RGBA32F);
+        state.computeShaders[Int(Pass::Coefficients)].dispatchCompute({1, 1, 1});
+        Renderer::setMemoryBarrier(Renderer::MemoryBarrier::TextureFetch);
+
+        state.coefficients.bind(SourceTextureUnit);
+        state.irradiance.bindImageLayered(DestinationImageUnit, 0, ImageAccess::WriteOnly, ImageFormat::RGBA16F);
+        state.computeShaders[Int(Pass::Irradiance)].dispatchCompute({(UnsignedInt(state.irradianceSize) + 7)/8, (UnsignedInt(state.irradianceSize) + 7)/8, 6});
+
+        environment.bind(SourceTextureUnit);
+        for(Int level = 0; level != state.specularLevelCount; ++level) {
+            const UnsignedInt levelSize = Math::max(state.specularSize >> level, 1);
+            state.specular.bindImageLayered(DestinationImageUnit, level, ImageAccess::WriteOnly, ImageFormat::RGBA16F);
+            state.computeShaders[Int(Pass::Specular)].setSpecular(roughness(level), state.sampleCount)
+                .dispatchCompute({(levelSize + 7)/8, (levelSize + 7)/8, 6});
+        }
+
+        Renderer::setMemoryBarrier(Renderer::MemoryBarrier::TextureFetch|Renderer::MemoryBarrier::ShaderImageAccess);
+        return *this;
+    }
+    #endif
+
+    std::size_t framebuffer = 0;
+    auto draw = [&state, &framebuffer](EnvironmentFilterShader& shader) {
+        Framebuffer& target = state.framebuffers[framebuffer++];
+        target.bind();
+        CORRADE_ASSERT(target.checkStatus(FramebufferTarget::Draw) == Framebuffer::Status::Complete,
+            "TextureTools::EnvironmentFilter::update(): can't render into framebuffer" << framebuffer - 1 << Debug::nospace << ", unexpected framebuffer status" << target.checkStatus(FramebufferTarget::Draw), false);
+        state.mesh->draw(shader);
+        return true;
+    };
+
+    environment.bind(SourceTextureUnit);
+    if(!draw(state.shaders[Int(Pass::Coefficients)])) return *this;
+
+    state.coefficients.bind(SourceTextureUnit);
+    EnvironmentFilterShader& irradianceShader = state.shaders[Int(Pass::Irradiance)];
+    for(Int face = 0; face != 6; ++face) {
+        irradianceShader.setDestination(face, state.irradianceSize);
+        if(!draw(irradianceShader)) return *this;
+    }
+
+    environment.bind(SourceTextureUnit);
+    EnvironmentFilterShader& specularShader = state.shaders[Int(Pass::Specular)];
+    for(Int level = 0; level != state.specularLevelCount; ++level) {
+        specularShader.setSpecular(roughness(level), state.sampleCount);
+        for(Int face = 0; face != 6; ++face) {
+            specularShader.setDestination(face, Math::max(state.specularSize >> level, 1));
+            if(!draw(specularShader)) return *this;
+        }
+    }
+
+    return *this;
+}
+
+Debug& operator<<(Debug& debug, const EnvironmentFilter::Path value) {
+    switch(value) {
+        #define _c(v) case EnvironmentFilter::Path::v: return debug << "TextureTools::EnvironmentFilter::Path::" #v;
+        _c(Compute)
+        _c(Fragment)
+        #undef _c
+    }
+
+    return debug << "TextureTools::EnvironmentFilter::Path(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
+}
+
+}}
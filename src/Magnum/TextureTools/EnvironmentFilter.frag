@@ -0,0 +1,62 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+out highp vec4 fragmentColor;
+
+#ifdef COEFFICIENTS
+uniform highp samplerCube environment;
+
+/* Each fragment of the 9x1 target projects one coefficient */
+void main() {
+    highp int coefficient = int(gl_FragCoord.x);
+    highp float lod = coefficientLod(environment);
+    highp vec3 sum = vec3(0.0);
+    for(highp int i = 0; i != COEFFICIENT_SAMPLE_COUNT; ++i) {
+        highp vec3 direction;
+        highp vec3 radiance = coefficientSample(environment, lod, i, direction);
+        sum += radiance*shBasis(coefficient, direction);
+    }
+    fragmentColor = vec4(sum, 1.0);
+}
+#else
+uniform highp int face;
+uniform highp int size;
+
+#ifdef IRRADIANCE
+uniform highp sampler2D coefficients;
+
+void main() {
+    fragmentColor = vec4(irradiance(coefficients, cubeDirection(face, ivec2(gl_FragCoord.xy), size)), 1.0);
+}
+#else
+uniform highp samplerCube environment;
+uniform highp float roughness;
+uniform highp int sampleCount;
+
+void main() {
+    fragmentColor = vec4(prefilterSpecular(environment, cubeDirection(face, ivec2(gl_FragCoord.xy), size), roughness, sampleCount), 1.0);
+}
+#endif
+#endif
@@ -0,0 +1,140 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#define PI 3.1415926535897932
+
+/* Edge length of cube map faces sampled for spherical harmonics projection */
+#define COEFFICIENT_FACE_SIZE 16
+#define COEFFICIENT_SAMPLE_COUNT (6*COEFFICIENT_FACE_SIZE*COEFFICIENT_FACE_SIZE)
+
+/* Direction of given cube map face texel, with the face in the usual +X, -X,
+   +Y, -Y, +Z, -Z order and texture coordinates in the [-1, 1] range */
+highp vec3 cubeDirection(highp int face, highp vec2 uv) {
+    if(face == 0) return normalize(vec3( 1.0, -uv.y, -uv.x));
+    if(face == 1) return normalize(vec3(-1.0, -uv.y,  uv.x));
+    if(face == 2) return normalize(vec3( uv.x,  1.0,  uv.y));
+    if(face == 3) return normalize(vec3( uv.x, -1.0, -uv.y));
+    if(face == 4) return normalize(vec3( uv.x, -uv.y,  1.0));
+    return normalize(vec3(-uv.x, -uv.y, -1.0));
+}
+
+highp vec3 cubeDirection(highp int face, highp ivec2 position, highp int size) {
+    return cubeDirection(face, (vec2(position) + vec2(0.5))*2.0/float(size) - vec2(1.0));
+}
+
+/* Real spherical harmonics basis up to the second band */
+highp float shBasis(highp int i, highp vec3 d) {
+    if(i == 0) return 0.282095;
+    if(i == 1) return 0.488603*d.y;
+    if(i == 2) return 0.488603*d.z;
+    if(i == 3) return 0.488603*d.x;
+    if(i == 4) return 1.092548*d.x*d.y;
+    if(i == 5) return 1.092548*d.y*d.z;
+    if(i == 6) return 0.315392*(3.0*d.z*d.z - 1.0);
+    if(i == 7) return 1.092548*d.x*d.z;
+    return 0.546274*(d.x*d.x - d.y*d.y);
+}
+
+/* Radiance of one texel of a coarse environment level weighted by its solid
+   angle, direction of the texel is returned in the output argument */
+highp vec3 coefficientSample(highp samplerCube environment, highp float lod, highp int i, out highp vec3 direction) {
+    highp int face = i/(COEFFICIENT_FACE_SIZE*COEFFICIENT_FACE_SIZE);
+    highp int texel = i - face*COEFFICIENT_FACE_SIZE*COEFFICIENT_FACE_SIZE;
+    highp vec2 uv = (vec2(texel - (texel/COEFFICIENT_FACE_SIZE)*COEFFICIENT_FACE_SIZE, texel/COEFFICIENT_FACE_SIZE) + vec2(0.5))*2.0/float(COEFFICIENT_FACE_SIZE) - vec2(1.0);
+    direction = cubeDirection(face, uv);
+
+    highp float distanceSquared = 1.0 + dot(uv, uv);
+    highp float solidAngle = 4.0/(float(COEFFICIENT_FACE_SIZE*COEFFICIENT_FACE_SIZE)*distanceSquared*sqrt(distanceSquared));
+    return textureLod(environment, direction, lod).rgb*solidAngle;
+}
+
+/* Level of the environment closest to COEFFICIENT_FACE_SIZE */
+highp float coefficientLod(highp samplerCube environment) {
+    return max(log2(float(textureSize(environment, 0).x)/float(COEFFICIENT_FACE_SIZE)), 0.0);
+}
+
+/* Irradiance divided by pi from the radiance coefficients, using the cosine
+   lobe convolution constants of Ramamoorthi and Hanrahan */
+highp vec3 irradiance(highp sampler2D coefficients, highp vec3 d) {
+    highp vec3 result = vec3(0.0);
+    for(highp int i = 0; i != 9; ++i) {
+        highp float band = i == 0 ? 1.0 : i < 4 ? 2.0/3.0 : 0.25;
+        result += band*texelFetch(coefficients, ivec2(i, 0), 0).rgb*shBasis(i, d);
+    }
+    return max(result, vec3(0.0));
+}
+
+highp vec2 hammersley(highp uint i, highp uint count) {
+    highp uint bits = (i << 16u) | (i >> 16u);
+    bits = ((bits & 0x55555555u) << 1u) | ((bits & 0xaaaaaaaau) >> 1u);
+    bits = ((bits & 0x33333333u) << 2u) | ((bits & 0xccccccccu) >> 2u);
+    bits = ((bits & 0x0f0f0f0fu) << 4u) | ((bits & 0xf0f0f0f0u) >> 4u);
+    bits = ((bits & 0x00ff00ffu) << 8u) | ((bits & 0xff00ff00u) >> 8u);
+    return vec2(float(i)/float(count), float(bits)*2.3283064365386963e-10);
+}
+
+highp vec3 importanceSampleGgx(highp vec2 xi, highp float alpha, highp vec3 n) {
+    highp float phi = 2.0*PI*xi.x;
+    highp float cosTheta = sqrt((1.0 - xi.y)/(1.0 + (alpha*alpha - 1.0)*xi.y));
+    highp float sinTheta = sqrt(1.0 - cosTheta*cosTheta);
+
+    highp vec3 up = abs(n.z) < 0.999 ? vec3(0.0, 0.0, 1.0) : vec3(1.0, 0.0, 0.0);
+    highp vec3 tangentX = normalize(cross(up, n));
+    highp vec3 tangentY = cross(n, tangentX);
+    return tangentX*sinTheta*cos(phi) + tangentY*sinTheta*sin(phi) + n*cosTheta;
+}
+
+/* GGX-prefiltered radiance with the view direction equal to the normal.
+   Each sample is taken from an environment level matching its solid angle,
+   so a few dozen samples are enough to avoid aliasing. */
+highp vec3 prefilterSpecular(highp samplerCube environment, highp vec3 n, highp float roughness, highp int sampleCount) {
+    if(roughness == 0.0) return textureLod(environment, n, 0.0).rgb;
+
+    highp float alpha = roughness*roughness;
+    highp float alphaSquared = alpha*alpha;
+    highp float size = float(textureSize(environment, 0).x);
+    highp float texelSolidAngle = 4.0*PI/(6.0*size*size);
+
+    highp vec3 color = vec3(0.0);
+    highp float weight = 0.0;
+    for(highp int i = 0; i < sampleCount; ++i) {
+        highp vec3 h = importanceSampleGgx(hammersley(uint(i), uint(sampleCount)), alpha, n);
+        highp float nDotH = max(dot(n, h), 0.0);
+        highp vec3 l = 2.0*nDotH*h - n;
+        highp float nDotL = dot(n, l);
+        if(nDotL <= 0.0) continue;
+
+        /* With the view equal to the normal, the sample PDF is D(h)/4 */
+        highp float d = nDotH*nDotH*(alphaSquared - 1.0) + 1.0;
+        highp float pdf = alphaSquared/(4.0*PI*d*d);
+        highp float sampleSolidAngle = 1.0/(float(sampleCount)*pdf + 0.0001);
+        highp float lod = max(0.5*log2(sampleSolidAngle/texelSolidAngle) + 1.0, 0.0);
+
+        color += textureLod(environment, l, lod).rgb*nDotL;
+        weight += nDotL;
+    }
+
+    return color/max(weight, 0.0001);
+}
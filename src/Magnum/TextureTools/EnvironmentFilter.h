@@ -0,0 +1,228 @@
+#ifndef Magnum_TextureTools_EnvironmentFilter_h
+#define Magnum_TextureTools_EnvironmentFilter_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::TextureTools::EnvironmentFilter
+ */
+
+#include "Magnum/configure.h"
+
+#ifndef MAGNUM_TARGET_GLES2
+#include <memory>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/TextureTools/visibility.h"
+
+namespace Magnum { namespace TextureTools {
+
+/**
+@brief Environment map prefiltering for image-based lighting
+
+Produces a prefiltered specular cube map and a diffuse irradiance cube map
+from an environment cube map on the GPU, fast enough to refresh dynamic
+probes at runtime:
+
+-   Each level of @ref specular() contains the environment convolved with
+    the GGX distribution for roughness @cpp level/(levelCount - 1) @ce, with
+    level zero being a copy of the environment. The convolution is done with
+    importance sampling, where each sample is taken from an environment level
+    matching its solid angle, so @ref sampleCount() in the order of tens is
+    enough to avoid aliasing.
+-   The environment is projected to nine radiance coefficients of second
+    order spherical harmonics, stored as @ref TextureFormat::RGBA32F in
+    @ref irradianceCoefficients(). From these, @ref irradiance() is
+    evaluated as the irradiance divided by @f$ \pi @f$, so the diffuse
+    contribution is just the value multiplied by the albedo. Shaders that
+    need the irradiance only for a few directions can evaluate the
+    coefficients directly instead.
+
+@code{.cpp}
+CubeMapTexture environment;
+environment.setMinificationFilter(Sampler::Filter::Linear, Sampler::Mipmap::Linear)
+    .setMagnificationFilter(Sampler::Filter::Linear)
+    .setStorage(Math::log2(256) + 1, TextureFormat::RGBA16F, Vector2i{256});
+
+TextureTools::EnvironmentFilter filter{128, 6};
+
+// render the probe into environment ...
+
+environment.generateMipmap();
+filter.update(environment);
+@endcode
+
+The environment is expected to have a complete mip chain with trilinear
+filtering, as both the specular prefiltering and the coefficient projection
+sample from its coarser levels. On desktop GL,
+@ref Renderer::Feature::SeamlessCubeMapTexture should be enabled to avoid
+seams in the rough levels.
+
+### Implementation
+
+If compute shaders and image load/store are available, each level of each
+output is written with a single compute dispatch and the coefficients are
+summed with a shared memory reduction in a single work group. Otherwise a
+fullscreen triangle is rendered into each face of each level. The fragment
+path leaves the last rendered framebuffer bound and the viewport set to its
+size. Blending, depth test and color mask affect the fragment path, so make
+sure they are in default state before calling @ref update().
+
+@requires_gl30 Extension @extension{ARB,framebuffer_object} and GLSL 1.30
+@requires_gles30 Integer operations and texture LOD queries are not
+    available in OpenGL ES 2.0.
+@requires_es_extension Extension @extension{EXT,color_buffer_float} in
+    OpenGL ES 3.0 and WebGL 2.0 for the fragment path, as floating-point
+    formats are not renderable otherwise.
+*/
+class MAGNUM_TEXTURETOOLS_EXPORT EnvironmentFilter {
+    public:
+        /**
+         * @brief Implementation path
+         *
+         * @see @ref path()
+         */
+        enum class Path: UnsignedByte {
+            /**
+             * Compute shaders writing the levels through image load/store.
+             * @requires_gl43 Extension @extension{ARB,compute_shader}
+             * @requires_gl42 Extension @extension{ARB,shader_image_load_store}
+             * @requires_gles31 Compute shaders are not available in
+             *      OpenGL ES 3.0 and older.
+             * @requires_gles Compute shaders are not available in WebGL.
+             */
+            Compute,
+
+            /** Fullscreen triangle rendered into each face of each level */
+            Fragment
+        };
+
+        /**
+         * @brief Default implementation path
+         *
+         * Returns @ref Path::Compute if compute shaders and image load/store
+         * are supported, @ref Path::Fragment otherwise.
+         */
+        static Path defaultPath();
+
+        /**
+         * @brief Constructor
+         * @param specularSize          Size of the specular cube map
+         * @param specularLevelCount    Level count of the specular cube map
+         * @param irradianceSize        Size of the irradiance cube map
+         *
+         * Uses @ref defaultPath(). The cube maps are allocated as
+         * @ref TextureFormat::RGBA16F with linear filtering. Expects that
+         * the sizes are non-zero and that @p specularLevelCount is at least
+         * one and not larger than @cpp Math::log2(specularSize) + 1 @ce.
+         */
+        explicit EnvironmentFilter(Int specularSize, Int specularLevelCount, Int irradianceSize = 32);
+
+        /**
+         * @brief Construct with explicit implementation path
+         *
+         * Expects that @ref Path::Compute is used only if supported, see
+         * @ref defaultPath().
+         */
+        explicit EnvironmentFilter(Int specularSize, Int specularLevelCount, Int irradianceSize, Path path);
+
+        /** @brief Copying is not allowed */
+        EnvironmentFilter(const EnvironmentFilter&) = delete;
+
+        /** @brief Moving is not allowed */
+        EnvironmentFilter(EnvironmentFilter&&) = delete;
+
+        ~EnvironmentFilter();
+
+        /** @brief Copying is not allowed */
+        EnvironmentFilter& operator=(const EnvironmentFilter&) = delete;
+
+        /** @brief Moving is not allowed */
+        EnvironmentFilter& operator=(EnvironmentFilter&&) = delete;
+
+        /** @brief Implementation path */
+        Path path() const;
+
+        /** @brief Size of the specular cube map */
+        Int specularSize() const;
+
+        /** @brief Level count of the specular cube map */
+        Int specularLevelCount() const;
+
+        /** @brief Size of the irradiance cube map */
+        Int irradianceSize() const;
+
+        /** @brief Count of samples for each texel of the specular levels */
+        UnsignedInt sampleCount() const;
+
+        /**
+         * @brief Set count of samples for each texel of the specular levels
+         * @return Reference to self (for method chaining)
+         *
+         * Default is @cpp 64 @ce. Expects that the count is non-zero.
+         */
+        EnvironmentFilter& setSampleCount(UnsignedInt count);
+
+        /** @brief Prefiltered specular cube map */
+        CubeMapTexture& specular();
+
+        /** @brief Irradiance cube map */
+        CubeMapTexture& irradiance();
+
+        /**
+         * @brief Spherical harmonics coefficients
+         *
+         * A 9x1 texture with radiance coefficients of the bands zero to two
+         * in the RGB channels, in the usual @f$ (l, m) @f$ order of
+         * @f$ (0, 0), (1, -1), (1, 0), (1, 1), (2, -2) \ldots (2, 2) @f$.
+         */
+        Texture2D& irradianceCoefficients();
+
+        /**
+         * @brief Update the filtered maps
+         * @param environment   Environment cube map with a complete mip
+         *      chain
+         * @return Reference to self (for method chaining)
+         *
+         * After the call the @ref specular(), @ref irradiance() and
+         * @ref irradianceCoefficients() textures can be immediately sampled.
+         */
+        EnvironmentFilter& update(CubeMapTexture& environment);
+
+    private:
+        struct State;
+
+        std::unique_ptr<State> _state;
+};
+
+/** @debugoperatorclassenum{EnvironmentFilter,EnvironmentFilter::Path} */
+MAGNUM_TEXTURETOOLS_EXPORT Debug& operator<<(Debug& debug, EnvironmentFilter::Path value);
+
+}}
+#else
+#error this header is not available in OpenGL ES 2.0 build
+#endif
+
+#endif
@@ -0,0 +1,301 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Resample.h"
+
+#include <cmath>
+#include <functional>
+#include <tuple>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/ThreadPool.h"
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/Functions.h"
+
+namespace Magnum { namespace TextureTools {
+
+namespace {
+
+/* Rows in one parallel job */
+constexpr std::size_t RowChunkSize = 16;
+
+constexpr Float KaiserRadius = 3.0f;
+constexpr Float KaiserAlpha = 4.0f;
+
+/* Per-axis filter weights. Output pixel i is a weighted sum of count[i]
+   input pixels starting at begin[i], weights of pixels outside of the edge
+   are added to the edge pixel. */
+struct Kernel {
+    std::vector<Int> begin, count;
+    std::vector<Float> weights;
+    Int maxCount;
+};
+
+Float sinc(Float x) {
+    if(x == 0.0f) return 1.0f;
+    x *= Constants::pi();
+    return std::sin(x)/x;
+}
+
+/* Modified Bessel function of the first kind, order zero */
+Float besselI0(const Float x) {
+    Float sum = 1.0f, term = 1.0f;
+    for(Int k = 1; term > sum*1.0e-7f; ++k) {
+        const Float a = x/(2.0f*k);
+        term *= a*a;
+        sum += term;
+    }
+    return sum;
+}
+
+Float kaiser(const Float t) {
+    if(std::abs(t) >= KaiserRadius) return 0.0f;
+    const Float r = t/KaiserRadius;
+    return besselI0(KaiserAlpha*std::sqrt(1.0f - r*r))/besselI0(KaiserAlpha);
+}
+
+Kernel computeKernel(const Int inputSize, const Int outputSize, const ResampleFilter filter) {
+    const Float scale = Float(inputSize)/outputSize;
+    const Float stretch = Math::max(scale, 1.0f);
+    const Float radius = filter == ResampleFilter::Box ? scale*0.5f : KaiserRadius*stretch;
+
+    Kernel kernel;
+    kernel.maxCount = Int(std::ceil(2.0f*radius)) + 3;
+    kernel.begin.resize(outputSize);
+    kernel.count.resize(outputSize);
+    kernel.weights.assign(std::size_t(outputSize)*kernel.maxCount, 0.0f);
+
+    for(Int i = 0; i != outputSize; ++i) {
+        const Float center = (i + 0.5f)*scale;
+        const Int first = Int(std::floor(center - radius)) - 1;
+        const Int last = Int(std::ceil(center + radius));
+        const Int begin = Math::clamp(first, 0, inputSize - 1);
+        const Int end = Math::clamp(last, 0, inputSize - 1) + 1;
+        kernel.begin[i] = begin;
+        kernel.count[i] = end - begin;
+
+        Float* const weights = kernel.weights.data() + std::size_t(i)*kernel.maxCount;
+        Float sum = 0.0f;
+        for(Int j = first; j <= last; ++j) {
+            Float weight;
+            if(filter == ResampleFilter::Box)
+                weight = Math::max(0.0f, Math::min(j + 1.0f, center + radius) - Math::max(Float(j), center - radius));
+            else {
+                const Float t = (j + 0.5f - center)/stretch;
+                weight = sinc(t)*kaiser(t);
+            }
+
+            weights[Math::clamp(j, 0, inputSize - 1) - begin] += weight;
+            sum += weight;
+        }
+
+        for(Int j = 0; j != kernel.count[i]; ++j) weights[j] /= sum;
+    }
+
+    return kernel;
+}
+
+Float srgbToLinear(const Float value) {
+    return value <= 0.04045f ? value/12.92f : std::pow((value + 0.055f)/1.055f, 2.4f);
+}
+
+Float linearToSrgb(const Float value) {
+    return value <= 0.0031308f ? value*12.92f : 1.055f*std::pow(value, 1.0f/2.4f) - 0.055f;
+}
+
+void forRows(ThreadPool* const pool, const std::size_t rows, const std::function<void(std::size_t, std::size_t)>& job) {
+    if(pool) pool->parallelFor(rows, RowChunkSize, job);
+    else job(0, rows);
+}
+
+std::size_t channelCount(const ImageView2D& image) {
+    CORRADE_ASSERT(image.type() == PixelType::UnsignedByte || image.type() == PixelType::Float,
+        "TextureTools::resample(): expected an image with UnsignedByte or Float type but got" << image.type(), {});
+    const std::size_t channels = image.pixelSize()/(image.type() == PixelType::Float ? 4 : 1);
+    CORRADE_ASSERT(channels >= 1 && channels <= 4,
+        "TextureTools::resample(): expected one to four channels but got" << channels, {});
+    return channels;
+}
+
+/* Converts the image to tightly packed floats, in linear space if sRGB */
+std::vector<Float> decode(const ImageView2D& image, const std::size_t channels, const ResampleFlags flags, ThreadPool* const pool) {
+    Math::Vector2<std::size_t> dataOffset, dataSize;
+    std::size_t pixelSize;
+    std::tie(dataOffset, dataSize, pixelSize) = image.dataProperties();
+    const char* const pixels = image.data() + dataOffset.sum();
+    const std::size_t rowSize = image.size().x()*channels;
+    const std::size_t colorChannels = (flags & ResampleFlag::Srgb) ? Math::min(channels, std::size_t(3)) : 0;
+
+    Float byteToFloat[256];
+    for(std::size_t i = 0; i != 256; ++i)
+        byteToFloat[i] = i/255.0f;
+    Float srgbByteToFloat[256];
+    for(std::size_t i = 0; i != 256; ++i)
+        srgbByteToFloat[i] = srgbToLinear(i/255.0f);
+
+    std::vector<Float> out(rowSize*image.size().y());
+    forRows(pool, image.size().y(), [&](const std::size_t begin, const std::size_t end) {
+        for(std::size_t y = begin; y != end; ++y) {
+            const char* const in = pixels + y*dataSize.x();
+            Float* const o = out.data() + y*rowSize;
+            if(image.type() == PixelType::UnsignedByte) {
+                for(std::size_t i = 0; i != rowSize; ++i) {
+                    const UnsignedByte value = in[i];
+                    o[i] = (i % channels < colorChannels ? srgbByteToFloat : byteToFloat)[value];
+                }
+            } else {
+                const Float* const values = reinterpret_cast<const Float*>(in);
+                for(std::size_t i = 0; i != rowSize; ++i)
+                    o[i] = i % channels < colorChannels ? srgbToLinear(values[i]) : values[i];
+            }
+        }
+    });
+
+    return out;
+}
+
+/* Converts tightly packed floats back to an image with default storage */
+Image2D encode(const std::vector<Float>& data, const Vector2i& size, const PixelFormat format, const PixelType type, const std::size_t channels, const ResampleFlags flags, ThreadPool* const pool) {
+    const std::size_t pixelSize = channels*(type == PixelType::Float ? 4 : 1);
+    /* Default pixel storage has four-byte row alignment */
+    const std::size_t stride = (size.x()*pixelSize + 3)/4*4;
+    const std::size_t rowSize = size.x()*channels;
+    const std::size_t colorChannels = (flags & ResampleFlag::Srgb) ? Math::min(channels, std::size_t(3)) : 0;
+
+    Containers::Array<char> out{Containers::ValueInit, stride*size.y()};
+    forRows(pool, size.y(), [&](const std::size_t begin, const std::size_t end) {
+        for(std::size_t y = begin; y != end; ++y) {
+            const Float* const in = data.data() + y*rowSize;
+            char* const o = out.data() + y*stride;
+            if(type == PixelType::UnsignedByte) {
+                for(std::size_t i = 0; i != rowSize; ++i) {
+                    const Float value = i % channels < colorChannels ? linearToSrgb(in[i]) : in[i];
+                    o[i] = char(UnsignedByte(Math::clamp(value, 0.0f, 1.0f)*255.0f + 0.5f));
+                }
+            } else {
+                Float* const values = reinterpret_cast<Float*>(o);
+                for(std::size_t i = 0; i != rowSize; ++i)
+                    values[i] = i % channels < colorChannels ? linearToSrgb(in[i]) : in[i];
+            }
+        }
+    });
+
+    return Image2D{format, type, size, std::move(out)};
+}
+
+std::vector<Float> resampleLinear(const std::vector<Float>& data, const Vector2i& inputSize, const Vector2i& outputSize, const std::size_t channels, const ResampleFilter filter, ThreadPool* const pool) {
+    const Kernel horizontal = computeKernel(inputSize.x(), outputSize.x(), filter);
+    const Kernel vertical = computeKernel(inputSize.y(), outputSize.y(), filter);
+    const std::size_t inputRowSize = inputSize.x()*channels;
+    const std::size_t outputRowSize = outputSize.x()*channels;
+
+    /* Horizontal pass over all input rows */
+    std::vector<Float> intermediate(outputRowSize*inputSize.y());
+    forRows(pool, inputSize.y(), [&](const std::size_t begin, const std::size_t end) {
+        for(std::size_t y = begin; y != end; ++y) {
+            const Float* const in = data.data() + y*inputRowSize;
+            Float* const out = intermediate.data() + y*outputRowSize;
+            for(Int x = 0; x != outputSize.x(); ++x) {
+                const Float* const weights = horizontal.weights.data() + std::size_t(x)*horizontal.maxCount;
+                const Float* const pixels = in + horizontal.begin[x]*channels;
+                Float sum[4]{};
+                for(Int k = 0; k != horizontal.count[x]; ++k)
+                    for(std::size_t c = 0; c != channels; ++c)
+                        sum[c] += weights[k]*pixels[k*channels + c];
+                for(std::size_t c = 0; c != channels; ++c)
+                    out[x*channels + c] = sum[c];
+            }
+        }
+    });
+
+    /* Vertical pass, whole rows are accumulated at once so the inner loop has
+       no dependencies and can be vectorized */
+    std::vector<Float> out(outputRowSize*outputSize.y());
+    forRows(pool, outputSize.y(), [&](const std::size_t begin, const std::size_t end) {
+        for(std::size_t y = begin; y != end; ++y) {
+            const Float* const weights = vertical.weights.data() + y*vertical.maxCount;
+            Float* const o = out.data() + y*outputRowSize;
+            for(Int k = 0; k != vertical.count[y]; ++k) {
+                const Float weight = weights[k];
+                const Float* const in = intermediate.data() + (vertical.begin[y] + k)*outputRowSize;
+                for(std::size_t i = 0; i != outputRowSize; ++i)
+                    o[i] += weight*in[i];
+            }
+        }
+    });
+
+    return out;
+}
+
+Image2D resampleInternal(const ImageView2D& image, const Vector2i& size, const ResampleFilter filter, const ResampleFlags flags, ThreadPool* const pool) {
+    CORRADE_ASSERT(size.product() && image.size().product(),
+        "TextureTools::resample(): expected non-zero sizes but got" << image.size() << "and" << size, (Image2D{image.format(), image.type()}));
+    const std::size_t channels = channelCount(image);
+
+    const std::vector<Float> data = decode(image, channels, flags, pool);
+    return encode(resampleLinear(data, image.size(), size, channels, filter, pool), size, image.format(), image.type(), channels, flags, pool);
+}
+
+std::vector<Image2D> generateMipmapsInternal(const ImageView2D& image, const ResampleFilter filter, const ResampleFlags flags, ThreadPool* const pool) {
+    CORRADE_ASSERT(image.size().product(),
+        "TextureTools::generateMipmaps(): expected a non-empty image", {});
+    const std::size_t channels = channelCount(image);
+
+    std::vector<Image2D> levels;
+    Vector2i size = image.size();
+    std::vector<Float> data = decode(image, channels, flags, pool);
+    while(size != Vector2i{1}) {
+        const Vector2i nextSize = Math::max(size/2, Vector2i{1});
+        data = resampleLinear(data, size, nextSize, channels, filter, pool);
+        levels.push_back(encode(data, nextSize, image.format(), image.type(), channels, flags, pool));
+        size = nextSize;
+    }
+
+    return levels;
+}
+
+}
+
+Image2D resample(const ImageView2D& image, const Vector2i& size, const ResampleFilter filter, const ResampleFlags flags) {
+    return resampleInternal(image, size, filter, flags, nullptr);
+}
+
+Image2D resample(const ImageView2D& image, const Vector2i& size, const ResampleFilter filter, const ResampleFlags flags, ThreadPool& pool) {
+    return resampleInternal(image, size, filter, flags, &pool);
+}
+
+std::vector<Image2D> generateMipmaps(const ImageView2D& image, const ResampleFilter filter, const ResampleFlags flags) {
+    return generateMipmapsInternal(image, filter, flags, nullptr);
+}
+
+std::vector<Image2D> generateMipmaps(const ImageView2D& image, const ResampleFilter filter, const ResampleFlags flags, ThreadPool& pool) {
+    return generateMipmapsInternal(image, filter, flags, &pool);
+}
+
+}}
@@ -0,0 +1,149 @@
+#ifndef Magnum_TextureTools_Resample_h
+#define Magnum_TextureTools_Resample_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::TextureTools::resample(), @ref Magnum::TextureTools::generateMipmaps(), enum @ref Magnum::TextureTools::ResampleFilter, @ref Magnum::TextureTools::ResampleFlag, enum set @ref Magnum::TextureTools::ResampleFlags
+ */
+
+#include <vector>
+#include <Corrade/Containers/EnumSet.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/TextureTools/visibility.h"
+
+namespace Magnum { namespace TextureTools {
+
+/**
+@brief Resampling filter
+
+@see @ref resample(), @ref generateMipmaps()
+*/
+enum class ResampleFilter: UnsignedByte {
+    /**
+     * Box filter. Each output pixel is an average of the input pixels it
+     * covers, weighted by the covered area. Fast, for power-of-two
+     * downsampling equivalent to what drivers usually do.
+     */
+    Box,
+
+    /**
+     * Kaiser-windowed sinc with a radius of three output pixels. Keeps more
+     * detail than @ref ResampleFilter::Box and produces less aliasing, at a
+     * cost of slower processing and mild ringing on sharp edges.
+     */
+    Kaiser
+};
+
+/**
+@brief Resampling flag
+
+@see @ref ResampleFlags, @ref resample(), @ref generateMipmaps()
+*/
+enum class ResampleFlag: UnsignedByte {
+    /**
+     * Treat the data as sRGB-encoded. The first three channels are converted
+     * to linear space before filtering and back to sRGB afterwards, the
+     * fourth channel is filtered as-is. Without this flag, sRGB data get
+     * noticeably darker with each downsampled level.
+     */
+    Srgb = 1 << 0
+};
+
+/**
+@brief Resampling flags
+
+@see @ref resample(), @ref generateMipmaps()
+*/
+typedef Containers::EnumSet<ResampleFlag> ResampleFlags;
+
+CORRADE_ENUMSET_OPERATORS(ResampleFlags)
+
+/**
+@brief Resample an image
+@param image    Input image
+@param size     Output size
+@param filter   Filter
+@param flags    Flags
+
+Returns a new image of @p size with the same format and type as @p image and
+default @ref PixelStorage. The filtering is separable, first done in the
+horizontal and then in the vertical direction, with pixels outside of the
+image edge clamped. Expects that @p image has @ref PixelType::UnsignedByte or
+@ref PixelType::Float with up to four channels and that @p size is not zero.
+@see @ref generateMipmaps()
+*/
+MAGNUM_TEXTURETOOLS_EXPORT Image2D resample(const ImageView2D& image, const Vector2i& size, ResampleFilter filter = ResampleFilter::Box, ResampleFlags flags = {});
+
+/**
+@brief Resample an image in parallel
+
+Same as @ref resample(const ImageView2D&, const Vector2i&, ResampleFilter, ResampleFlags),
+but each pass is split into blocks of rows processed on @p pool.
+*/
+MAGNUM_TEXTURETOOLS_EXPORT Image2D resample(const ImageView2D& image, const Vector2i& size, ResampleFilter filter, ResampleFlags flags, ThreadPool& pool);
+
+/**
+@brief Generate a mipmap chain
+@param image    Base level
+@param filter   Filter
+@param flags    Flags
+
+Returns levels from @cpp 1 @ce down to a @cpp {1, 1} @ce image, each half the
+size of the previous one, rounded down. The base level is not included. Each
+level is filtered from the previous one, which is kept in full floating-point
+precision, so there's no accumulated quantization error. The result can be
+uploaded directly using @ref Texture::setSubImage() or saved with an image
+converter to ship the mip levels together with the asset:
+
+@code{.cpp}
+Image2D image = ...;
+std::vector<Image2D> levels = TextureTools::generateMipmaps(image,
+    TextureTools::ResampleFilter::Kaiser, TextureTools::ResampleFlag::Srgb);
+
+Texture2D texture;
+texture.setStorage(levels.size() + 1, TextureFormat::SRGB8Alpha8, image.size())
+    .setSubImage(0, {}, image);
+for(std::size_t i = 0; i != levels.size(); ++i)
+    texture.setSubImage(i + 1, {}, levels[i]);
+@endcode
+
+Expects the same as @ref resample().
+*/
+MAGNUM_TEXTURETOOLS_EXPORT std::vector<Image2D> generateMipmaps(const ImageView2D& image, ResampleFilter filter = ResampleFilter::Box, ResampleFlags flags = {});
+
+/**
+@brief Generate a mipmap chain in parallel
+
+Same as @ref generateMipmaps(const ImageView2D&, ResampleFilter, ResampleFlags),
+but each pass of each level is split into blocks of rows processed on
+@p pool.
+*/
+MAGNUM_TEXTURETOOLS_EXPORT std::vector<Image2D> generateMipmaps(const ImageView2D& image, ResampleFilter filter, ResampleFlags flags, ThreadPool& pool);
+
+}}
+
+#endif
@@ -24,6 +24,7 @@
 */
 
 #include <sstream>
+#include <tuple>
 #include <Corrade/TestSuite/Tester.h>
 
 #include "Magnum/Math/Range.h"
@@ -38,13 +39,29 @@ struct AtlasTest: TestSuite::Tester {
     void createPadding();
     void createEmpty();
     void createTooSmall();
+
+    void packerIncremental();
+    void packerRotation();
+    void packerMultiplePages();
+    void packerBatch();
+
+    void debugFlag();
+    void debugFlags();
 };
 
 AtlasTest::AtlasTest() {
     addTests({&AtlasTest::create,
               &AtlasTest::createPadding,
               &AtlasTest::createEmpty,
-              &AtlasTest::createTooSmall});
+              &AtlasTest::createTooSmall,
+
+              &AtlasTest::packerIncremental,
+              &AtlasTest::packerRotation,
+              &AtlasTest::packerMultiplePages,
+              &AtlasTest::packerBatch,
+
+              &AtlasTest::debugFlag,
+              &AtlasTest::debugFlags});
 }
 
 void AtlasTest::create() {
@@ -54,11 +71,12 @@ void AtlasTest::create() {
         {23, 25}
     });
 
+    /* The highest is placed first, the others next to it */
     CORRADE_COMPARE(atlas.size(), 3);
     CORRADE_COMPARE(atlas, (std::vector<Range2Di>{
-        Range2Di::fromSize({0, 0}, {12, 18}),
-        Range2Di::fromSize({32, 0}, {32, 15}),
-        Range2Di::fromSize({0, 25}, {23, 25})}));
+        Range2Di::fromSize({23, 0}, {12, 18}),
+        Range2Di::fromSize({23, 18}, {32, 15}),
+        Range2Di::fromSize({0, 0}, {23, 25})}));
 }
 
 void AtlasTest::createPadding() {
@@ -70,9 +88,9 @@ void AtlasTest::createPadding() {
 
     CORRADE_COMPARE(atlas.size(), 3);
     CORRADE_COMPARE(atlas, (std::vector<Range2Di>{
-        Range2Di::fromSize({2, 1}, {8, 16}),
-        Range2Di::fromSize({34, 1}, {28, 13}),
-        Range2Di::fromSize({2, 26}, {19, 23})}));
+        Range2Di::fromSize({25, 1}, {8, 16}),
+        Range2Di::fromSize({25, 19}, {28, 13}),
+        Range2Di::fromSize({2, 1}, {19, 23})}));
 }
 
 void AtlasTest::createEmpty() {
@@ -84,13 +102,130 @@ void AtlasTest::createTooSmall() {
     std::ostringstream o;
     Error redirectError{&o};
 
-    std::vector<Range2Di> atlas = TextureTools::atlas({64, 32}, {
+    std::vector<Range2Di> atlas = TextureTools::atlas({32, 32}, {
         {8, 16},
         {21, 13},
         {19, 29}
     }, {2, 1});
     CORRADE_VERIFY(atlas.empty());
-    CORRADE_COMPARE(o.str(), "TextureTools::atlas(): requested atlas size Vector(64, 32) is too small to fit 3 Vector(25, 31) textures. Generated atlas will be empty.\n");
+    CORRADE_COMPARE(o.str(), "TextureTools::atlas(): requested atlas size Vector(32, 32) is too small to fit 3 textures. Generated atlas will be empty.\n");
+}
+
+void AtlasTest::packerIncremental() {
+    Int page;
+    Range2Di rectangle;
+    bool rotated;
+
+    AtlasPacker packer{{16, 16}};
+    CORRADE_COMPARE(packer.pageCount(), 1);
+
+    std::tie(page, rectangle, rotated) = packer.add({8, 8});
+    CORRADE_COMPARE(page, 0);
+    CORRADE_COMPARE(rectangle, Range2Di({0, 0}, {8, 8}));
+    CORRADE_COMPARE(rotated, false);
+    std::tie(page, rectangle, rotated) = packer.add({8, 4});
+    CORRADE_COMPARE(page, 0);
+    CORRADE_COMPARE(rectangle, Range2Di({8, 0}, {16, 4}));
+    CORRADE_COMPARE(rotated, false);
+
+    /* Placed on the lower part of the skyline */
+    std::tie(page, rectangle, rotated) = packer.add({8, 4});
+    CORRADE_COMPARE(page, 0);
+    CORRADE_COMPARE(rectangle, Range2Di({8, 4}, {16, 8}));
+    CORRADE_COMPARE(rotated, false);
+
+    /* The skyline is flat again */
+    std::tie(page, rectangle, rotated) = packer.add({16, 8});
+    CORRADE_COMPARE(page, 0);
+    CORRADE_COMPARE(rectangle, Range2Di({0, 8}, {16, 16}));
+    CORRADE_COMPARE(rotated, false);
+
+    /* Full */
+    std::tie(page, rectangle, rotated) = packer.add({1, 1});
+    CORRADE_COMPARE(page, -1);
+    CORRADE_COMPARE(rectangle, Range2Di{});
+    CORRADE_COMPARE(rotated, false);
+    CORRADE_COMPARE(packer.pageCount(), 1);
+}
+
+void AtlasTest::packerRotation() {
+    Int page;
+    Range2Di rectangle;
+    bool rotated;
+
+    AtlasPacker packer{{16, 8}, {}, AtlasPacker::Flag::AllowRotation};
+    std::tie(page, rectangle, rotated) = packer.add({16, 4});
+    CORRADE_COMPARE(page, 0);
+    CORRADE_COMPARE(rectangle, Range2Di({0, 0}, {16, 4}));
+    CORRADE_COMPARE(rotated, false);
+
+    /* Fits only if rotated, the rectangle is returned rotated */
+    std::tie(page, rectangle, rotated) = packer.add({4, 8});
+    CORRADE_COMPARE(page, 0);
+    CORRADE_COMPARE(rectangle, Range2Di({0, 4}, {8, 8}));
+    CORRADE_COMPARE(rotated, true);
+
+    /* Without rotation it doesn't fit */
+    AtlasPacker noRotation{{16, 8}};
+    noRotation.add({16, 4});
+    std::tie(page, rectangle, rotated) = noRotation.add({4, 8});
+    CORRADE_COMPARE(page, -1);
+    CORRADE_COMPARE(rectangle, Range2Di{});
+    CORRADE_COMPARE(rotated, false);
+}
+
+void AtlasTest::packerMultiplePages() {
+    Int page;
+    Range2Di rectangle;
+    bool rotated;
+
+    AtlasPacker packer{{8, 8}, {}, AtlasPacker::Flag::MultiplePages};
+    std::tie(page, rectangle, rotated) = packer.add({8, 8});
+    CORRADE_COMPARE(page, 0);
+    CORRADE_COMPARE(rectangle, Range2Di({0, 0}, {8, 8}));
+    CORRADE_COMPARE(rotated, false);
+    std::tie(page, rectangle, rotated) = packer.add({4, 4});
+    CORRADE_COMPARE(page, 1);
+    CORRADE_COMPARE(rectangle, Range2Di({0, 0}, {4, 4}));
+    CORRADE_COMPARE(rotated, false);
+    std::tie(page, rectangle, rotated) = packer.add({4, 4});
+    CORRADE_COMPARE(page, 1);
+    CORRADE_COMPARE(rectangle, Range2Di({4, 0}, {8, 4}));
+    CORRADE_COMPARE(rotated, false);
+    CORRADE_COMPARE(packer.pageCount(), 2);
+
+    /* Doesn't fit even into an empty page, no new page is added */
+    std::tie(page, rectangle, rotated) = packer.add({16, 1});
+    CORRADE_COMPARE(page, -1);
+    CORRADE_COMPARE(rectangle, Range2Di{});
+    CORRADE_COMPARE(rotated, false);
+    CORRADE_COMPARE(packer.pageCount(), 2);
+}
+
+void AtlasTest::packerBatch() {
+    AtlasPacker packer{{16, 16}};
+
+    /* Placed from the highest, returned in original order */
+    const std::vector<std::tuple<Int, Range2Di, bool>> packed = packer.add(std::vector<Vector2i>{{4, 4}, {16, 8}, {8, 8}});
+    CORRADE_COMPARE(packed.size(), 3);
+    CORRADE_COMPARE(std::get<0>(packed[0]), 0);
+    CORRADE_COMPARE(std::get<1>(packed[0]), Range2Di({8, 8}, {12, 12}));
+    CORRADE_COMPARE(std::get<1>(packed[1]), Range2Di({0, 0}, {16, 8}));
+    CORRADE_COMPARE(std::get<1>(packed[2]), Range2Di({0, 8}, {8, 16}));
+}
+
+void AtlasTest::debugFlag() {
+    std::ostringstream out;
+
+    Debug{&out} << AtlasPacker::Flag::AllowRotation << AtlasPacker::Flag(0xf0);
+    CORRADE_COMPARE(out.str(), "TextureTools::AtlasPacker::Flag::AllowRotation TextureTools::AtlasPacker::Flag(0xf0)\n");
+}
+
+void AtlasTest::debugFlags() {
+    std::ostringstream out;
+
+    Debug{&out} << (AtlasPacker::Flag::AllowRotation|AtlasPacker::Flag::MultiplePages) << AtlasPacker::Flags{};
+    CORRADE_COMPARE(out.str(), "TextureTools::AtlasPacker::Flag::AllowRotation|TextureTools::AtlasPacker::Flag::MultiplePages TextureTools::AtlasPacker::Flags{}\n");
 }
 
 }}}
@@ -0,0 +1,585 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/ThreadPool.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/TextureTools/Compression.h"
+
+namespace Magnum { namespace TextureTools { namespace Test {
+
+struct CompressionTest: TestSuite::Tester {
+    explicit CompressionTest();
+
+    #ifndef MAGNUM_TARGET_GLES
+    void rgtc1();
+    void rgtc1Flat();
+    void rgtc1Padding();
+    void rgtc1InvalidType();
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES2
+    void r11Eac();
+    void r11EacFlat();
+    void r11EacPadding();
+    void r11EacInvalidType();
+    #endif
+
+    void bc1();
+    void bc1Quality();
+    void bc1Flat();
+    void bc3();
+    void bc1InvalidType();
+
+    #ifndef MAGNUM_TARGET_GLES2
+    void etc2();
+    void etc2Flat();
+    void etc2Eac();
+    void etc2InvalidType();
+    #endif
+
+    void threaded();
+};
+
+CompressionTest::CompressionTest() {
+    #ifndef MAGNUM_TARGET_GLES
+    addTests({&CompressionTest::rgtc1,
+              &CompressionTest::rgtc1Flat,
+              &CompressionTest::rgtc1Padding,
+              &CompressionTest::rgtc1InvalidType});
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES2
+    addTests({&CompressionTest::r11Eac,
+              &CompressionTest::r11EacFlat,
+              &CompressionTest::r11EacPadding,
+              &CompressionTest::r11EacInvalidType});
+    #endif
+
+    addTests({&CompressionTest::bc1,
+              &CompressionTest::bc1Quality,
+              &CompressionTest::bc1Flat,
+              &CompressionTest::bc3,
+              &CompressionTest::bc1InvalidType});
+
+    #ifndef MAGNUM_TARGET_GLES2
+    addTests({&CompressionTest::etc2,
+              &CompressionTest::etc2Flat,
+              &CompressionTest::etc2Eac,
+              &CompressionTest::etc2InvalidType});
+    #endif
+
+    addTests({&CompressionTest::threaded});
+}
+
+namespace {
+    #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+    constexpr PixelFormat Format = PixelFormat::Red;
+    #else
+    constexpr PixelFormat Format = PixelFormat::Luminance;
+    #endif
+
+    constexpr UnsignedByte GradientData[] = {
+          0,  17,  34,  51,
+         68,  85, 102, 119,
+        136, 153, 170, 187,
+        204, 221, 238, 255
+    };
+
+    constexpr UnsignedByte NarrowGradientData[] = {
+        100, 104, 108, 112,
+        116, 120, 124, 128,
+        132, 136, 140, 144,
+        148, 152, 156, 160
+    };
+
+    constexpr UnsignedByte FlatData[] = {
+        77, 77, 77, 77,
+        77, 77, 77, 77,
+        77, 77, 77, 77,
+        77, 77, 77, 77
+    };
+
+    /* 5x2 image, rows padded to four bytes */
+    constexpr UnsignedByte PaddingData[] = {
+        10, 20, 30, 40, 200, 0, 0, 0,
+        50, 60, 70, 80, 200, 0, 0, 0
+    };
+
+    /* 4x4 RGBA image with colors on a line in the RGB space */
+    constexpr UnsignedByte ColorLineData[] = {
+        100, 100, 160, 255,  104, 102, 156, 238,  108, 104, 152, 221,  112, 106, 148, 204,
+        116, 108, 144, 187,  120, 110, 140, 170,  124, 112, 136, 153,  128, 114, 132, 136,
+        132, 116, 128, 119,  136, 118, 124, 102,  140, 120, 120,  85,  144, 122, 116,  68,
+        148, 124, 112,  51,  152, 126, 108,  34,  156, 128, 104,  17,  160, 130, 100,   0
+    };
+
+    /* 4x4 RGB image with a gray gradient */
+    constexpr UnsignedByte GrayGradientData[] = {
+        100, 100, 100,  102, 102, 102,  104, 104, 104,  106, 106, 106,
+        108, 108, 108,  110, 110, 110,  112, 112, 112,  114, 114, 114,
+        116, 116, 116,  118, 118, 118,  120, 120, 120,  122, 122, 122,
+        124, 124, 124,  126, 126, 126,  128, 128, 128,  130, 130, 130
+    };
+
+    /* 4x4 RGB image with a single color */
+    constexpr UnsignedByte FlatColorData[] = {
+        77, 77, 77,  77, 77, 77,  77, 77, 77,  77, 77, 77,
+        77, 77, 77,  77, 77, 77,  77, 77, 77,  77, 77, 77,
+        77, 77, 77,  77, 77, 77,  77, 77, 77,  77, 77, 77,
+        77, 77, 77,  77, 77, 77,  77, 77, 77,  77, 77, 77
+    };
+
+    void decodeRgtc1(const char* const data, UnsignedByte(&out)[16]) {
+        const Float red0 = UnsignedByte(data[0]), red1 = UnsignedByte(data[1]);
+        UnsignedLong indices = 0;
+        for(Int i = 0; i != 6; ++i)
+            indices |= UnsignedLong(UnsignedByte(data[2 + i])) << (8*i);
+
+        for(Int i = 0; i != 16; ++i) {
+            const Int index = (indices >> (3*i)) & 0x7;
+            Float value;
+            if(index == 0) value = red0;
+            else if(index == 1) value = red1;
+            else if(red0 > red1) value = ((8 - index)*red0 + (index - 1)*red1)/7.0f;
+            else if(index == 6) value = 0.0f;
+            else if(index == 7) value = 255.0f;
+            else value = ((6 - index)*red0 + (index - 1)*red1)/5.0f;
+            out[i] = UnsignedByte(value + 0.5f);
+        }
+    }
+
+    Vector3i decodeRgb565(const Int color) {
+        const Int r = color >> 11, g = (color >> 5) & 0x3f, b = color & 0x1f;
+        return {r << 3 | r >> 2, g << 2 | g >> 4, b << 3 | b >> 2};
+    }
+
+    void decodeBc1(const char* const data, UnsignedByte(&out)[16][3]) {
+        const Int color0 = UnsignedByte(data[0]) | UnsignedByte(data[1]) << 8;
+        const Int color1 = UnsignedByte(data[2]) | UnsignedByte(data[3]) << 8;
+        const Vector3i c0 = decodeRgb565(color0), c1 = decodeRgb565(color1);
+        Vector3i palette[4]{c0, c1};
+        if(color0 > color1) {
+            palette[2] = (c0*2 + c1 + Vector3i{1})/3;
+            palette[3] = (c0 + c1*2 + Vector3i{1})/3;
+        } else {
+            palette[2] = (c0 + c1)/2;
+            palette[3] = {};
+        }
+
+        for(Int i = 0; i != 16; ++i) {
+            const Int index = (UnsignedByte(data[4 + i/4]) >> (2*(i%4))) & 0x3;
+            for(Int c = 0; c != 3; ++c) out[i][c] = UnsignedByte(palette[index][c]);
+        }
+    }
+
+    #ifndef MAGNUM_TARGET_GLES2
+    constexpr Int EacModifiers[16][8]{
+        {-3, -6,  -9, -15, 2, 5, 8, 14},
+        {-3, -7, -10, -13, 2, 6, 9, 12},
+        {-2, -5,  -8, -13, 1, 4, 7, 12},
+        {-2, -4,  -6, -13, 1, 3, 5, 12},
+        {-3, -6,  -8, -12, 2, 5, 7, 11},
+        {-3, -7,  -9, -11, 2, 6, 8, 10},
+        {-4, -7,  -8, -11, 3, 6, 7, 10},
+        {-3, -5,  -8, -11, 2, 4, 7, 10},
+        {-2, -6,  -8, -10, 1, 5, 7,  9},
+        {-2, -5,  -8, -10, 1, 4, 7,  9},
+        {-2, -4,  -8, -10, 1, 3, 7,  9},
+        {-2, -5,  -7, -10, 1, 4, 6,  9},
+        {-3, -4,  -7, -10, 2, 3, 6,  9},
+        {-1, -2,  -3, -10, 0, 1, 2,  9},
+        {-4, -6,  -8,  -9, 3, 5, 7,  8},
+        {-3, -5,  -7,  -9, 2, 4, 6,  8}
+    };
+
+    void decodeR11Eac(const char* const data, UnsignedByte(&out)[16]) {
+        UnsignedLong bits = 0;
+        for(Int i = 0; i != 8; ++i)
+            bits = bits << 8 | UnsignedByte(data[i]);
+
+        const Int base = bits >> 56;
+        const Int multiplier = (bits >> 52) & 0xf;
+        const Int table = (bits >> 48) & 0xf;
+        for(Int i = 0; i != 16; ++i) {
+            const Int x = i%4, y = i/4;
+            const Int index = (bits >> (45 - 3*(x*4 + y))) & 0x7;
+            const Int modifier = EacModifiers[table][index];
+            const Int value = Math::clamp(base*8 + 4 + (multiplier ? modifier*multiplier*8 : modifier), 0, 2047);
+            out[i] = UnsignedByte(value*255.0f/2047.0f + 0.5f);
+        }
+    }
+
+    void decodeEacAlpha(const char* const data, UnsignedByte(&out)[16]) {
+        UnsignedLong bits = 0;
+        for(Int i = 0; i != 8; ++i)
+            bits = bits << 8 | UnsignedByte(data[i]);
+
+        const Int base = bits >> 56;
+        const Int multiplier = (bits >> 52) & 0xf;
+        const Int table = (bits >> 48) & 0xf;
+        for(Int i = 0; i != 16; ++i) {
+            const Int x = i%4, y = i/4;
+            const Int index = (bits >> (45 - 3*(x*4 + y))) & 0x7;
+            out[i] = UnsignedByte(Math::clamp(base + EacModifiers[table][index]*multiplier, 0, 255));
+        }
+    }
+
+    /* Decodes only the individual and differential modes */
+    void decodeEtc2(const char* const data, UnsignedByte(&out)[16][3]) {
+        constexpr Int EtcModifiers[8][4]{
+            { 2,   8,  -2,   -8},
+            { 5,  17,  -5,  -17},
+            { 9,  29,  -9,  -29},
+            {13,  42, -13,  -42},
+            {18,  60, -18,  -60},
+            {24,  80, -24,  -80},
+            {33, 106, -33, -106},
+            {47, 183, -47, -183}
+        };
+
+        UnsignedLong bits = 0;
+        for(Int i = 0; i != 8; ++i)
+            bits = bits << 8 | UnsignedByte(data[i]);
+
+        const bool differential = (bits >> 33) & 1;
+        const bool flip = (bits >> 32) & 1;
+        Vector3i base[2];
+        for(Int c = 0; c != 3; ++c) {
+            const Int shift = 59 - 8*c;
+            if(differential) {
+                const Int value = (bits >> shift) & 0x1f;
+                Int delta = (bits >> (shift - 3)) & 0x7;
+                if(delta >= 4) delta -= 8;
+                base[0][c] = value << 3 | value >> 2;
+                base[1][c] = (value + delta) << 3 | (value + delta) >> 2;
+            } else {
+                base[0][c] = ((bits >> (shift + 1)) & 0xf)*17;
+                base[1][c] = ((bits >> (shift - 3)) & 0xf)*17;
+            }
+        }
+
+        const Int tables[]{Int((bits >> 37) & 0x7), Int((bits >> 34) & 0x7)};
+        for(Int i = 0; i != 16; ++i) {
+            const Int x = i%4, y = i/4;
+            const Int subblock = flip ? y >= 2 : x >= 2;
+            const Int p = x*4 + y;
+            const Int index = ((bits >> (16 + p)) & 1) << 1 | ((bits >> p) & 1);
+            for(Int c = 0; c != 3; ++c)
+                out[i][c] = UnsignedByte(Math::clamp(base[subblock][c] + EtcModifiers[tables[subblock]][index], 0, 255));
+        }
+    }
+    #endif
+
+    Int maxColorDifference(const UnsignedByte(&a)[16][3], const UnsignedByte* const b, const std::size_t pixelSize) {
+        Int difference = 0;
+        for(Int i = 0; i != 16; ++i) for(Int c = 0; c != 3; ++c)
+            difference = Math::max(difference, Math::abs(Int(a[i][c]) - Int(b[i*pixelSize + c])));
+        return difference;
+    }
+
+    Int colorError(const UnsignedByte(&a)[16][3], const UnsignedByte* const b, const std::size_t pixelSize) {
+        Int error = 0;
+        for(Int i = 0; i != 16; ++i) for(Int c = 0; c != 3; ++c)
+            error += Math::pow<2>(Int(a[i][c]) - Int(b[i*pixelSize + c]));
+        return error;
+    }
+
+    Int maxDifference(const UnsignedByte(&a)[16], const UnsignedByte* const b) {
+        Int difference = 0;
+        for(Int i = 0; i != 16; ++i)
+            difference = Math::max(difference, Math::abs(Int(a[i]) - Int(b[i])));
+        return difference;
+    }
+}
+
+#ifndef MAGNUM_TARGET_GLES
+void CompressionTest::rgtc1() {
+    const CompressedImage2D output = compressRedRgtc1(ImageView2D{Format, PixelType::UnsignedByte, {4, 4}, GradientData});
+
+    CORRADE_COMPARE(output.format(), CompressedPixelFormat::RedRgtc1);
+    CORRADE_COMPARE(output.size(), (Vector2i{4, 4}));
+    CORRADE_COMPARE(output.data().size(), 8);
+
+    /* Endpoints are the block extremes, the six interpolated values are
+       255/7 apart */
+    CORRADE_COMPARE(UnsignedByte(output.data()[0]), 255);
+    CORRADE_COMPARE(UnsignedByte(output.data()[1]), 0);
+
+    UnsignedByte decoded[16];
+    decodeRgtc1(output.data(), decoded);
+    CORRADE_VERIFY(maxDifference(decoded, GradientData) < 19);
+}
+
+void CompressionTest::rgtc1Flat() {
+    const CompressedImage2D output = compressRedRgtc1(ImageView2D{Format, PixelType::UnsignedByte, {4, 4}, FlatData});
+
+    UnsignedByte decoded[16];
+    decodeRgtc1(output.data(), decoded);
+    CORRADE_COMPARE(maxDifference(decoded, FlatData), 0);
+}
+
+void CompressionTest::rgtc1Padding() {
+    const CompressedImage2D output = compressRedRgtc1(ImageView2D{Format, PixelType::UnsignedByte, {5, 2}, PaddingData});
+
+    CORRADE_COMPARE(output.size(), (Vector2i{5, 2}));
+    CORRADE_COMPARE(output.data().size(), 16);
+
+    /* The second block contains just the repeated last column */
+    UnsignedByte decoded[16];
+    decodeRgtc1(output.data() + 8, decoded);
+    for(UnsignedByte value: decoded) CORRADE_COMPARE(value, 200);
+
+    /* Last two rows of the first block repeat the second row */
+    decodeRgtc1(output.data(), decoded);
+    CORRADE_COMPARE(decoded[12], decoded[4]);
+    CORRADE_COMPARE(decoded[15], decoded[7]);
+    CORRADE_COMPARE(decoded[7], 80);
+}
+
+void CompressionTest::rgtc1InvalidType() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    const UnsignedShort data[16]{};
+    compressRedRgtc1(ImageView2D{Format, PixelType::UnsignedShort, {4, 4}, data});
+    CORRADE_COMPARE(out.str(), "TextureTools::compressRedRgtc1(): expected an image with PixelType::UnsignedByte but got PixelType::UnsignedShort\n");
+}
+#endif
+
+#ifndef MAGNUM_TARGET_GLES2
+void CompressionTest::r11Eac() {
+    const CompressedImage2D output = compressR11Eac(ImageView2D{Format, PixelType::UnsignedByte, {4, 4}, NarrowGradientData});
+
+    CORRADE_COMPARE(output.format(), CompressedPixelFormat::R11Eac);
+    CORRADE_COMPARE(output.size(), (Vector2i{4, 4}));
+    CORRADE_COMPARE(output.data().size(), 8);
+
+    UnsignedByte decoded[16];
+    decodeR11Eac(output.data(), decoded);
+    CORRADE_VERIFY(maxDifference(decoded, NarrowGradientData) < 5);
+
+    /* Full range is much coarser because of the fixed modifier tables */
+    const CompressedImage2D full = compressR11Eac(ImageView2D{Format, PixelType::UnsignedByte, {4, 4}, GradientData});
+    decodeR11Eac(full.data(), decoded);
+    CORRADE_VERIFY(maxDifference(decoded, GradientData) < 17);
+}
+
+void CompressionTest::r11EacFlat() {
+    const CompressedImage2D output = compressR11Eac(ImageView2D{Format, PixelType::UnsignedByte, {4, 4}, FlatData});
+
+    UnsignedByte decoded[16];
+    decodeR11Eac(output.data(), decoded);
+    CORRADE_COMPARE(maxDifference(decoded, FlatData), 0);
+}
+
+void CompressionTest::r11EacPadding() {
+    const CompressedImage2D output = compressR11Eac(ImageView2D{Format, PixelType::UnsignedByte, {5, 2}, PaddingData});
+
+    CORRADE_COMPARE(output.size(), (Vector2i{5, 2}));
+    CORRADE_COMPARE(output.data().size(), 16);
+
+    UnsignedByte decoded[16];
+    decodeR11Eac(output.data() + 8, decoded);
+    for(UnsignedByte value: decoded) CORRADE_COMPARE(value, 200);
+}
+
+void CompressionTest::r11EacInvalidType() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    const UnsignedShort data[16]{};
+    compressR11Eac(ImageView2D{Format, PixelType::UnsignedShort, {4, 4}, data});
+    CORRADE_COMPARE(out.str(), "TextureTools::compressR11Eac(): expected an image with PixelType::UnsignedByte but got PixelType::UnsignedShort\n");
+}
+#endif
+
+void CompressionTest::bc1() {
+    const CompressedImage2D output = compressRgbBc1(ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte, {4, 4}, ColorLineData});
+
+    CORRADE_COMPARE(output.format(), CompressedPixelFormat::RGBS3tcDxt1);
+    CORRADE_COMPARE(output.size(), (Vector2i{4, 4}));
+    CORRADE_COMPARE(output.data().size(), 8);
+
+    /* The colors lie on a line, so the four palette entries should cover it
+       well. Alpha is ignored. */
+    UnsignedByte decoded[16][3];
+    decodeBc1(output.data(), decoded);
+    CORRADE_VERIFY(maxColorDifference(decoded, ColorLineData, 4) < 16);
+}
+
+void CompressionTest::bc1Quality() {
+    const ImageView2D image{PixelFormat::RGBA, PixelType::UnsignedByte, {4, 4}, ColorLineData};
+
+    UnsignedByte decoded[16][3];
+    decodeBc1(compressRgbBc1(image, CompressionQuality::Fast).data(), decoded);
+    const Int fastError = colorError(decoded, ColorLineData, 4);
+    decodeBc1(compressRgbBc1(image, CompressionQuality::High).data(), decoded);
+    const Int highError = colorError(decoded, ColorLineData, 4);
+
+    CORRADE_VERIFY(maxColorDifference(decoded, ColorLineData, 4) < 16);
+    CORRADE_VERIFY(highError <= fastError);
+}
+
+void CompressionTest::bc1Flat() {
+    const CompressedImage2D output = compressRgbBc1(ImageView2D{PixelFormat::RGB, PixelType::UnsignedByte, {4, 4}, FlatColorData});
+
+    /* Only the RGB565 quantization error is there */
+    UnsignedByte decoded[16][3];
+    decodeBc1(output.data(), decoded);
+    CORRADE_VERIFY(maxColorDifference(decoded, FlatColorData, 3) <= 4);
+}
+
+void CompressionTest::bc3() {
+    const CompressedImage2D output = compressRgbaBc3(ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte, {4, 4}, ColorLineData});
+
+    CORRADE_COMPARE(output.format(), CompressedPixelFormat::RGBAS3tcDxt5);
+    CORRADE_COMPARE(output.size(), (Vector2i{4, 4}));
+    CORRADE_COMPARE(output.data().size(), 16);
+
+    UnsignedByte alpha[16], expectedAlpha[16];
+    for(Int i = 0; i != 16; ++i) expectedAlpha[i] = ColorLineData[i*4 + 3];
+    decodeRgtc1(output.data(), alpha);
+    CORRADE_VERIFY(maxDifference(alpha, expectedAlpha) < 19);
+
+    UnsignedByte decoded[16][3];
+    decodeBc1(output.data() + 8, decoded);
+    CORRADE_VERIFY(maxColorDifference(decoded, ColorLineData, 4) < 16);
+
+    /* RGB images are opaque */
+    const CompressedImage2D opaque = compressRgbaBc3(ImageView2D{PixelFormat::RGB, PixelType::UnsignedByte, {4, 4}, GrayGradientData});
+    decodeRgtc1(opaque.data(), alpha);
+    for(UnsignedByte value: alpha) CORRADE_COMPARE(value, 255);
+}
+
+void CompressionTest::bc1InvalidType() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    const UnsignedShort data[48]{};
+    compressRgbBc1(ImageView2D{PixelFormat::RGB, PixelType::UnsignedShort, {4, 4}, data});
+    compressRgbaBc3(ImageView2D{PixelFormat::RGB, PixelType::UnsignedShort, {4, 4}, data});
+    CORRADE_COMPARE(out.str(),
+        "TextureTools::compressRgbBc1(): expected a three- or four-channel image with PixelType::UnsignedByte but got PixelFormat::RGB and PixelType::UnsignedShort\n"
+        "TextureTools::compressRgbaBc3(): expected a three- or four-channel image with PixelType::UnsignedByte but got PixelFormat::RGB and PixelType::UnsignedShort\n");
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+void CompressionTest::etc2() {
+    const CompressedImage2D output = compressRgb8Etc2(ImageView2D{PixelFormat::RGB, PixelType::UnsignedByte, {4, 4}, GrayGradientData});
+
+    CORRADE_COMPARE(output.format(), CompressedPixelFormat::RGB8Etc2);
+    CORRADE_COMPARE(output.size(), (Vector2i{4, 4}));
+    CORRADE_COMPARE(output.data().size(), 8);
+
+    /* The encoder uses only ETC1-compatible modes */
+    UnsignedByte decoded[16][3];
+    decodeEtc2(output.data(), decoded);
+    CORRADE_VERIFY(maxColorDifference(decoded, GrayGradientData, 3) < 8);
+
+    /* Higher quality shouldn't be worse */
+    const Int normalError = colorError(decoded, GrayGradientData, 3);
+    decodeEtc2(compressRgb8Etc2(ImageView2D{PixelFormat::RGB, PixelType::UnsignedByte, {4, 4}, GrayGradientData}, CompressionQuality::High).data(), decoded);
+    CORRADE_VERIFY(colorError(decoded, GrayGradientData, 3) <= normalError);
+}
+
+void CompressionTest::etc2Flat() {
+    const CompressedImage2D output = compressRgb8Etc2(ImageView2D{PixelFormat::RGB, PixelType::UnsignedByte, {4, 4}, FlatColorData});
+
+    UnsignedByte decoded[16][3];
+    decodeEtc2(output.data(), decoded);
+    CORRADE_VERIFY(maxColorDifference(decoded, FlatColorData, 3) <= 1);
+}
+
+void CompressionTest::etc2Eac() {
+    const CompressedImage2D output = compressRgba8Etc2Eac(ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte, {4, 4}, ColorLineData});
+
+    CORRADE_COMPARE(output.format(), CompressedPixelFormat::RGBA8Etc2Eac);
+    CORRADE_COMPARE(output.size(), (Vector2i{4, 4}));
+    CORRADE_COMPARE(output.data().size(), 16);
+
+    /* The alpha is a full-range gradient, coarse because of the fixed
+       modifier tables */
+    UnsignedByte alpha[16], expectedAlpha[16];
+    for(Int i = 0; i != 16; ++i) expectedAlpha[i] = ColorLineData[i*4 + 3];
+    decodeEacAlpha(output.data(), alpha);
+    CORRADE_VERIFY(maxDifference(alpha, expectedAlpha) < 20);
+
+    /* Flat opaque alpha is exact */
+    const CompressedImage2D opaque = compressRgba8Etc2Eac(ImageView2D{PixelFormat::RGB, PixelType::UnsignedByte, {4, 4}, GrayGradientData});
+    decodeEacAlpha(opaque.data(), alpha);
+    for(UnsignedByte value: alpha) CORRADE_COMPARE(value, 255);
+
+    UnsignedByte decoded[16][3];
+    decodeEtc2(opaque.data() + 8, decoded);
+    CORRADE_VERIFY(maxColorDifference(decoded, GrayGradientData, 3) < 8);
+}
+
+void CompressionTest::etc2InvalidType() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    const UnsignedByte data[16]{};
+    compressRgb8Etc2(ImageView2D{PixelFormat::RG, PixelType::UnsignedByte, {2, 4}, data});
+    compressRgba8Etc2Eac(ImageView2D{PixelFormat::RG, PixelType::UnsignedByte, {2, 4}, data});
+    CORRADE_COMPARE(out.str(),
+        "TextureTools::compressRgb8Etc2(): expected a three- or four-channel image with PixelType::UnsignedByte but got PixelFormat::RG and PixelType::UnsignedByte\n"
+        "TextureTools::compressRgba8Etc2Eac(): expected a three- or four-channel image with PixelType::UnsignedByte but got PixelFormat::RG and PixelType::UnsignedByte\n");
+}
+#endif
+
+void CompressionTest::threaded() {
+    /* 9x7 image to have partial blocks on both edges */
+    Containers::Array<UnsignedByte> data{9*7*4};
+    for(std::size_t i = 0; i != data.size(); ++i)
+        data[i] = UnsignedByte(i*37 % 251);
+    const ImageView2D image{PixelFormat::RGBA, PixelType::UnsignedByte, {9, 7}, data};
+
+    ThreadPool pool{4};
+
+    const CompressedImage2D bc3 = compressRgbaBc3(image);
+    const CompressedImage2D bc3Threaded = compressRgbaBc3(image, CompressionQuality::Normal, pool);
+    CORRADE_COMPARE(bc3Threaded.data().size(), 3*2*16);
+    CORRADE_COMPARE(std::string(bc3Threaded.data(), bc3Threaded.data().size()),
+                    std::string(bc3.data(), bc3.data().size()));
+
+    #ifndef MAGNUM_TARGET_GLES2
+    const CompressedImage2D etc2 = compressRgba8Etc2Eac(image);
+    const CompressedImage2D etc2Threaded = compressRgba8Etc2Eac(image, CompressionQuality::Normal, pool);
+    CORRADE_COMPARE(std::string(etc2Threaded.data(), etc2Threaded.data().size()),
+                    std::string(etc2.data(), etc2.data().size()));
+    #endif
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::TextureTools::Test::CompressionTest)
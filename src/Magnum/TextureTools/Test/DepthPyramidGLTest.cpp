@@ -0,0 +1,277 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <vector>
+
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/Framebuffer.h"
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/OpenGLTester.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Texture.h"
+#include "Magnum/TextureFormat.h"
+#include "Magnum/Math/Vector4.h"
+#include "Magnum/TextureTools/DepthPyramid.h"
+
+namespace Magnum { namespace TextureTools { namespace Test {
+
+struct DepthPyramidGLTest: OpenGLTester {
+    explicit DepthPyramidGLTest();
+
+    void construct();
+    void setSize();
+
+    void maxCompute();
+    void maxFragment();
+    void minCompute();
+    void minFragment();
+    void minMaxCompute();
+    void minMaxFragment();
+
+    void debugReduction();
+    void debugPath();
+};
+
+DepthPyramidGLTest::DepthPyramidGLTest() {
+    addTests({&DepthPyramidGLTest::construct,
+              &DepthPyramidGLTest::setSize,
+
+              &DepthPyramidGLTest::maxCompute,
+              &DepthPyramidGLTest::maxFragment,
+              &DepthPyramidGLTest::minCompute,
+              &DepthPyramidGLTest::minFragment,
+              &DepthPyramidGLTest::minMaxCompute,
+              &DepthPyramidGLTest::minMaxFragment,
+
+              &DepthPyramidGLTest::debugReduction,
+              &DepthPyramidGLTest::debugPath});
+}
+
+namespace {
+    /* Odd sizes, the last column and row of each level have to include the
+       remaining texels */
+    const Float DepthData[15]{
+        0.1f, 0.2f, 0.1f, 0.1f, 0.1f,
+        0.1f, 0.1f, 0.1f, 0.1f, 0.1f,
+        0.3f, 0.1f, 0.1f, 0.1f, 0.4f};
+
+    const Float InvertedDepthData[15]{
+        0.9f, 0.8f, 0.9f, 0.9f, 0.9f,
+        0.9f, 0.9f, 0.9f, 0.9f, 0.9f,
+        0.7f, 0.9f, 0.9f, 0.9f, 0.6f};
+
+    bool checkFragmentSupport() {
+        #ifndef MAGNUM_TARGET_GLES
+        return Context::current().isVersionSupported(Version::GL300);
+        #else
+        return Context::current().isExtensionSupported<Extensions::GL::EXT::color_buffer_float>();
+        #endif
+    }
+
+    Texture2D depthTexture(const Float* data) {
+        Texture2D depth;
+        depth.setMinificationFilter(Sampler::Filter::Nearest)
+            .setMagnificationFilter(Sampler::Filter::Nearest)
+            .setStorage(1, TextureFormat::DepthComponent32F, {5, 3})
+            .setSubImage(0, {}, ImageView2D{PixelFormat::DepthComponent, PixelType::Float, {5, 3}, {data, 15*sizeof(Float)}});
+        return depth;
+    }
+
+    /* Texture::image() is not available on ES, read through a framebuffer */
+    std::vector<Vector4> readLevel(DepthPyramid& pyramid, const Int level) {
+        const Vector2i size = Math::max(pyramid.size() >> level, Vector2i{1});
+        Framebuffer framebuffer{{{}, size}};
+        framebuffer.attachTexture(Framebuffer::ColorAttachment{0}, pyramid.texture(), level);
+        Image2D image = framebuffer.read(framebuffer.viewport(), {PixelFormat::RGBA, PixelType::Float});
+        return {image.data<Vector4>(), image.data<Vector4>() + size.product()};
+    }
+}
+
+void DepthPyramidGLTest::construct() {
+    if(!checkFragmentSupport())
+        CORRADE_SKIP("Floating-point render targets are not supported.");
+
+    DepthPyramid pyramid{{640, 300}};
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(pyramid.reduction(), DepthPyramid::Reduction::Max);
+    CORRADE_COMPARE(pyramid.path(), DepthPyramid::defaultPath(DepthPyramid::Reduction::Max));
+    CORRADE_COMPARE(pyramid.size(), (Vector2i{640, 300}));
+    CORRADE_COMPARE(pyramid.levelCount(), 10);
+    CORRADE_VERIFY(pyramid.texture().id());
+}
+
+void DepthPyramidGLTest::setSize() {
+    if(!checkFragmentSupport())
+        CORRADE_SKIP("Floating-point render targets are not supported.");
+
+    DepthPyramid pyramid{{16, 16}, DepthPyramid::Reduction::Max, DepthPyramid::Path::Fragment};
+    CORRADE_COMPARE(pyramid.levelCount(), 5);
+
+    pyramid.setSize({5, 3});
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(pyramid.size(), (Vector2i{5, 3}));
+    CORRADE_COMPARE(pyramid.levelCount(), 3);
+
+    Texture2D depth = depthTexture(DepthData);
+    pyramid.update(depth);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(readLevel(pyramid, 2)[0].x(), 0.4f);
+}
+
+namespace {
+    void verifyMax(DepthPyramid& pyramid) {
+        const std::vector<Vector4> level0 = readLevel(pyramid, 0);
+        CORRADE_COMPARE(level0.size(), 15);
+        CORRADE_COMPARE(level0[1].x(), 0.2f);
+        CORRADE_COMPARE(level0[14].x(), 0.4f);
+
+        const std::vector<Vector4> level1 = readLevel(pyramid, 1);
+        CORRADE_COMPARE(level1.size(), 2);
+        CORRADE_COMPARE(level1[0].x(), 0.3f);
+        CORRADE_COMPARE(level1[1].x(), 0.4f);
+
+        const std::vector<Vector4> level2 = readLevel(pyramid, 2);
+        CORRADE_COMPARE(level2.size(), 1);
+        CORRADE_COMPARE(level2[0].x(), 0.4f);
+    }
+
+    void verifyMin(DepthPyramid& pyramid) {
+        const std::vector<Vector4> level1 = readLevel(pyramid, 1);
+        CORRADE_COMPARE(level1[0].x(), 0.7f);
+        CORRADE_COMPARE(level1[1].x(), 0.6f);
+
+        const std::vector<Vector4> level2 = readLevel(pyramid, 2);
+        CORRADE_COMPARE(level2[0].x(), 0.6f);
+    }
+
+    void verifyMinMax(DepthPyramid& pyramid) {
+        const std::vector<Vector4> level0 = readLevel(pyramid, 0);
+        CORRADE_COMPARE(level0[14].xy(), (Vector2{0.4f, 0.4f}));
+
+        const std::vector<Vector4> level1 = readLevel(pyramid, 1);
+        CORRADE_COMPARE(level1[0].xy(), (Vector2{0.1f, 0.3f}));
+        CORRADE_COMPARE(level1[1].xy(), (Vector2{0.1f, 0.4f}));
+
+        const std::vector<Vector4> level2 = readLevel(pyramid, 2);
+        CORRADE_COMPARE(level2[0].xy(), (Vector2{0.1f, 0.4f}));
+    }
+}
+
+void DepthPyramidGLTest::maxCompute() {
+    if(DepthPyramid::defaultPath(DepthPyramid::Reduction::Max) != DepthPyramid::Path::Compute)
+        CORRADE_SKIP("Compute shaders or image load/store are not supported.");
+
+    Texture2D depth = depthTexture(DepthData);
+    DepthPyramid pyramid{{5, 3}, DepthPyramid::Reduction::Max, DepthPyramid::Path::Compute};
+    pyramid.update(depth);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    verifyMax(pyramid);
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void DepthPyramidGLTest::maxFragment() {
+    if(!checkFragmentSupport())
+        CORRADE_SKIP("Floating-point render targets are not supported.");
+
+    Texture2D depth = depthTexture(DepthData);
+    DepthPyramid pyramid{{5, 3}, DepthPyramid::Reduction::Max, DepthPyramid::Path::Fragment};
+    pyramid.update(depth);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    verifyMax(pyramid);
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void DepthPyramidGLTest::minCompute() {
+    if(DepthPyramid::defaultPath(DepthPyramid::Reduction::Min) != DepthPyramid::Path::Compute)
+        CORRADE_SKIP("Compute shaders or image load/store are not supported.");
+
+    Texture2D depth = depthTexture(InvertedDepthData);
+    DepthPyramid pyramid{{5, 3}, DepthPyramid::Reduction::Min, DepthPyramid::Path::Compute};
+    pyramid.update(depth);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    verifyMin(pyramid);
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void DepthPyramidGLTest::minFragment() {
+    if(!checkFragmentSupport())
+        CORRADE_SKIP("Floating-point render targets are not supported.");
+
+    Texture2D depth = depthTexture(InvertedDepthData);
+    DepthPyramid pyramid{{5, 3}, DepthPyramid::Reduction::Min, DepthPyramid::Path::Fragment};
+    pyramid.update(depth);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    verifyMin(pyramid);
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void DepthPyramidGLTest::minMaxCompute() {
+    if(DepthPyramid::defaultPath(DepthPyramid::Reduction::MinMax) != DepthPyramid::Path::Compute)
+        CORRADE_SKIP("Compute path is not supported for min/max reduction.");
+
+    Texture2D depth = depthTexture(DepthData);
+    DepthPyramid pyramid{{5, 3}, DepthPyramid::Reduction::MinMax, DepthPyramid::Path::Compute};
+    pyramid.update(depth);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    verifyMinMax(pyramid);
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void DepthPyramidGLTest::minMaxFragment() {
+    if(!checkFragmentSupport())
+        CORRADE_SKIP("Floating-point render targets are not supported.");
+
+    Texture2D depth = depthTexture(DepthData);
+    DepthPyramid pyramid{{5, 3}, DepthPyramid::Reduction::MinMax, DepthPyramid::Path::Fragment};
+    pyramid.update(depth);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    verifyMinMax(pyramid);
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void DepthPyramidGLTest::debugReduction() {
+    std::ostringstream out;
+    Debug{&out} << DepthPyramid::Reduction::MinMax << DepthPyramid::Reduction(0xde);
+    CORRADE_COMPARE(out.str(), "TextureTools::DepthPyramid::Reduction::MinMax TextureTools::DepthPyramid::Reduction(0xde)\n");
+}
+
+void DepthPyramidGLTest::debugPath() {
+    std::ostringstream out;
+    Debug{&out} << DepthPyramid::Path::Fragment << DepthPyramid::Path(0xde);
+    CORRADE_COMPARE(out.str(), "TextureTools::DepthPyramid::Path::Fragment TextureTools::DepthPyramid::Path(0xde)\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::TextureTools::Test::DepthPyramidGLTest)
@@ -0,0 +1,157 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/ThreadPool.h"
+#include "Magnum/TextureTools/DistanceField.h"
+
+namespace Magnum { namespace TextureTools { namespace Test {
+
+struct DistanceFieldTest: TestSuite::Tester {
+    explicit DistanceFieldTest();
+
+    void cpu();
+    void cpuDiagonal();
+    void cpuScaled();
+    void cpuThreaded();
+    void cpuInvalidType();
+};
+
+DistanceFieldTest::DistanceFieldTest() {
+    addTests({&DistanceFieldTest::cpu,
+              &DistanceFieldTest::cpuDiagonal,
+              &DistanceFieldTest::cpuScaled,
+              &DistanceFieldTest::cpuThreaded,
+              &DistanceFieldTest::cpuInvalidType});
+}
+
+namespace {
+    #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+    constexpr PixelFormat Format = PixelFormat::Red;
+    #else
+    constexpr PixelFormat Format = PixelFormat::Luminance;
+    #endif
+
+    /* Left half black, right half white */
+    constexpr UnsignedByte HalfData[] = {
+        0, 0, 0, 0, 255, 255, 255, 255,
+        0, 0, 0, 0, 255, 255, 255, 255,
+        0, 0, 0, 0, 255, 255, 255, 255,
+        0, 0, 0, 0, 255, 255, 255, 255
+    };
+}
+
+void DistanceFieldTest::cpu() {
+    const ImageView2D input{Format, PixelType::UnsignedByte, {8, 4}, HalfData};
+    const Image2D output = TextureTools::distanceField(input, {8, 4}, 4);
+
+    CORRADE_COMPARE(output.format(), Format);
+    CORRADE_COMPARE(output.type(), PixelType::UnsignedByte);
+    CORRADE_COMPARE(output.size(), (Vector2i{8, 4}));
+
+    /* Linear ramp across the edge, 0.5 is exactly between the two middle
+       pixels */
+    constexpr UnsignedByte expected[] = {16, 48, 80, 112, 143, 175, 207, 239};
+    for(std::size_t y = 0; y != 4; ++y) for(std::size_t x = 0; x != 8; ++x) {
+        CORRADE_ITERATION(y*8 + x);
+        CORRADE_COMPARE(Int(UnsignedByte(output.data()[y*8 + x])), Int(expected[x]));
+    }
+}
+
+void DistanceFieldTest::cpuDiagonal() {
+    /* A single white pixel in the center */
+    constexpr UnsignedByte data[] = {
+        0, 0,   0, 0, 0,
+        0, 0,   0, 0, 0,
+        0, 0, 255, 0, 0,
+        0, 0,   0, 0, 0,
+        0, 0,   0, 0, 0
+    };
+    const ImageView2D input{PixelStorage{}.setAlignment(1), Format, PixelType::UnsignedByte, {5, 5}, data};
+    const Image2D output = TextureTools::distanceField(input, {5, 5}, 2);
+
+    /* Output rows are four-byte aligned. Distances are exact Euclidean, not
+       Manhattan or Chebyshev. */
+    const char* const pixels = output.data();
+    CORRADE_COMPARE(Int(UnsignedByte(pixels[2*8 + 2])), 159);
+    CORRADE_COMPARE(Int(UnsignedByte(pixels[1*8 + 2])), 96);
+    CORRADE_COMPARE(Int(UnsignedByte(pixels[1*8 + 1])), 69);
+    CORRADE_COMPARE(Int(UnsignedByte(pixels[0*8 + 2])), 32);
+    CORRADE_COMPARE(Int(UnsignedByte(pixels[0*8 + 0])), 0);
+}
+
+void DistanceFieldTest::cpuScaled() {
+    const ImageView2D input{Format, PixelType::UnsignedByte, {8, 4}, HalfData};
+    const Image2D output = TextureTools::distanceField(input, {4, 2}, 4);
+
+    CORRADE_COMPARE(output.size(), (Vector2i{4, 2}));
+
+    /* Every second input pixel is sampled */
+    constexpr UnsignedByte expected[] = {48, 112, 175, 239};
+    for(std::size_t y = 0; y != 2; ++y) for(std::size_t x = 0; x != 4; ++x) {
+        CORRADE_ITERATION(y*4 + x);
+        CORRADE_COMPARE(Int(UnsignedByte(output.data()[y*4 + x])), Int(expected[x]));
+    }
+}
+
+void DistanceFieldTest::cpuThreaded() {
+    /* Concentric rings */
+    Containers::Array<char> data{Containers::NoInit, 128*96};
+    for(Int y = 0; y != 96; ++y) for(Int x = 0; x != 128; ++x)
+        data[y*128 + x] = ((x - 64)*(x - 64) + (y - 48)*(y - 48))/128 % 2 ? char(255) : char(0);
+    const ImageView2D input{Format, PixelType::UnsignedByte, {128, 96}, data};
+
+    const Image2D expected = TextureTools::distanceField(input, {64, 48}, 8);
+    ThreadPool pool{4};
+    const Image2D actual = TextureTools::distanceField(input, {64, 48}, 8, pool);
+
+    CORRADE_COMPARE(actual.size(), expected.size());
+    CORRADE_COMPARE_AS(Containers::ArrayView<const char>{actual.data()},
+        Containers::ArrayView<const char>{expected.data()},
+        TestSuite::Compare::Container);
+}
+
+void DistanceFieldTest::cpuInvalidType() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    const Float data[4]{};
+    TextureTools::distanceField(ImageView2D{Format, PixelType::Float, {2, 2}, data}, {2, 2}, 4);
+    TextureTools::distanceField(ImageView2D{Format, PixelType::UnsignedByte, {4, 1}, HalfData}, {4, 1}, 0);
+    CORRADE_COMPARE(out.str(),
+        "TextureTools::distanceField(): expected an image with PixelType::UnsignedByte but got PixelType::Float\n"
+        "TextureTools::distanceField(): expected positive radius but got 0\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::TextureTools::Test::DistanceFieldTest)
@@ -0,0 +1,273 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <vector>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+
+#include "Magnum/Context.h"
+#include "Magnum/CubeMapTexture.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/Framebuffer.h"
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/OpenGLTester.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Texture.h"
+#include "Magnum/TextureFormat.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/TextureTools/EnvironmentFilter.h"
+
+namespace Magnum { namespace TextureTools { namespace Test {
+
+struct EnvironmentFilterGLTest: OpenGLTester {
+    explicit EnvironmentFilterGLTest();
+
+    void construct();
+    void setSampleCount();
+
+    void constantCompute();
+    void constantFragment();
+    void directionalCompute();
+    void directionalFragment();
+
+    void debugPath();
+};
+
+EnvironmentFilterGLTest::EnvironmentFilterGLTest() {
+    addTests({&EnvironmentFilterGLTest::construct,
+              &EnvironmentFilterGLTest::setSampleCount,
+
+              &EnvironmentFilterGLTest::constantCompute,
+              &EnvironmentFilterGLTest::constantFragment,
+              &EnvironmentFilterGLTest::directionalCompute,
+              &EnvironmentFilterGLTest::directionalFragment,
+
+              &EnvironmentFilterGLTest::debugPath});
+}
+
+namespace {
+    constexpr CubeMapCoordinate Faces[]{
+        CubeMapCoordinate::PositiveX,
+        CubeMapCoordinate::NegativeX,
+        CubeMapCoordinate::PositiveY,
+        CubeMapCoordinate::NegativeY,
+        CubeMapCoordinate::PositiveZ,
+        CubeMapCoordinate::NegativeZ
+    };
+
+    bool checkFragmentSupport() {
+        #ifndef MAGNUM_TARGET_GLES
+        return Context::current().isVersionSupported(Version::GL300);
+        #else
+        return Context::current().isExtensionSupported<Extensions::GL::EXT::color_buffer_float>();
+        #endif
+    }
+
+    /* 32x32 environment with a full mip chain, each face filled with a
+       single color */
+    CubeMapTexture environmentTexture(const Color4ub(&colors)[6]) {
+        CubeMapTexture environment;
+        environment.setMinificationFilter(Sampler::Filter::Linear, Sampler::Mipmap::Linear)
+            .setMagnificationFilter(Sampler::Filter::Linear)
+            .setWrapping(Sampler::Wrapping::ClampToEdge)
+            .setStorage(6, TextureFormat::RGBA8, Vector2i{32});
+
+        Containers::Array<Color4ub> data{32*32};
+        for(std::size_t face = 0; face != 6; ++face) {
+            for(Color4ub& i: data) i = colors[face];
+            environment.setSubImage(Faces[face], 0, {}, ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte, Vector2i{32}, data});
+        }
+        environment.generateMipmap();
+        return environment;
+    }
+
+    /* CubeMapTexture::image() is not available on ES, read through a
+       framebuffer */
+    std::vector<Vector4> readFace(CubeMapTexture& texture, const CubeMapCoordinate face, const Int level, const Int size) {
+        Framebuffer framebuffer{{{}, Vector2i{size}}};
+        framebuffer.attachCubeMapTexture(Framebuffer::ColorAttachment{0}, texture, face, level);
+        Image2D image = framebuffer.read(framebuffer.viewport(), {PixelFormat::RGBA, PixelType::Float});
+        return {image.data<Vector4>(), image.data<Vector4>() + size*size};
+    }
+
+    std::vector<Vector4> readCoefficients(Texture2D& texture) {
+        Framebuffer framebuffer{{{}, {9, 1}}};
+        framebuffer.attachTexture(Framebuffer::ColorAttachment{0}, texture, 0);
+        Image2D image = framebuffer.read(framebuffer.viewport(), {PixelFormat::RGBA, PixelType::Float});
+        return {image.data<Vector4>(), image.data<Vector4>() + 9};
+    }
+
+    const Color4ub ConstantColors[6]{
+        {64, 128, 192, 255}, {64, 128, 192, 255}, {64, 128, 192, 255},
+        {64, 128, 192, 255}, {64, 128, 192, 255}, {64, 128, 192, 255}};
+
+    /* Only the +Y face is lit */
+    const Color4ub DirectionalColors[6]{
+        {0, 0, 0, 255}, {0, 0, 0, 255}, {255, 255, 255, 255},
+        {0, 0, 0, 255}, {0, 0, 0, 255}, {0, 0, 0, 255}};
+
+    void verifyConstant(EnvironmentFilter& filter) {
+        const Vector3 color = Math::unpack<Vector3>(Color3ub{64, 128, 192});
+
+        /* Only the constant coefficient is non-zero, equal to the radiance
+           integrated with the zeroth basis function */
+        {
+            const std::vector<Vector4> coefficients = readCoefficients(filter.irradianceCoefficients());
+            CORRADE_COMPARE_AS(Math::abs(coefficients[0].xyz() - color*2.0f*Math::sqrt(Constants::pi())).max(), 0.02f, TestSuite::Compare::Less);
+            for(std::size_t i = 1; i != 9; ++i)
+                CORRADE_COMPARE_AS(Math::abs(coefficients[i].xyz()).max(), 0.02f, TestSuite::Compare::Less);
+        }
+
+        /* Constant radiance produces the same irradiance over pi and the same
+           prefiltered color in every direction on every level */
+        for(CubeMapCoordinate face: Faces) {
+            const std::vector<Vector4> irradiance = readFace(filter.irradiance(), face, 0, filter.irradianceSize());
+            CORRADE_COMPARE_AS(Math::abs(irradiance.front().xyz() - color).max(), 0.02f, TestSuite::Compare::Less);
+            CORRADE_COMPARE_AS(Math::abs(irradiance.back().xyz() - color).max(), 0.02f, TestSuite::Compare::Less);
+
+            for(Int level = 0; level != filter.specularLevelCount(); ++level) {
+                const std::vector<Vector4> specular = readFace(filter.specular(), face, level, Math::max(filter.specularSize() >> level, 1));
+                CORRADE_COMPARE_AS(Math::abs(specular.front().xyz() - color).max(), 0.02f, TestSuite::Compare::Less);
+                CORRADE_COMPARE_AS(Math::abs(specular.back().xyz() - color).max(), 0.02f, TestSuite::Compare::Less);
+            }
+        }
+    }
+
+    void verifyDirectional(EnvironmentFilter& filter) {
+        /* Pointing up, the irradiance is large, pointing down it's nearly
+           zero and sideways it's in between */
+        const Float up = readFace(filter.irradiance(), CubeMapCoordinate::PositiveY, 0, filter.irradianceSize())[filter.irradianceSize()*filter.irradianceSize()/2 + filter.irradianceSize()/2].x();
+        const Float side = readFace(filter.irradiance(), CubeMapCoordinate::PositiveX, 0, filter.irradianceSize())[filter.irradianceSize()*filter.irradianceSize()/2 + filter.irradianceSize()/2].x();
+        const Float down = readFace(filter.irradiance(), CubeMapCoordinate::NegativeY, 0, filter.irradianceSize())[filter.irradianceSize()*filter.irradianceSize()/2 + filter.irradianceSize()/2].x();
+        CORRADE_COMPARE_AS(up, side, TestSuite::Compare::Greater);
+        CORRADE_COMPARE_AS(side, down, TestSuite::Compare::Greater);
+        CORRADE_COMPARE_AS(down, 0.05f, TestSuite::Compare::Less);
+
+        /* The smooth level is a copy of the environment, the rough level
+           spreads the light to the neighbor faces */
+        const Int size = filter.specularSize();
+        CORRADE_COMPARE_AS(Math::abs(readFace(filter.specular(), CubeMapCoordinate::PositiveY, 0, size)[size*size/2 + size/2].x() - 1.0f), 0.01f, TestSuite::Compare::Less);
+        CORRADE_COMPARE_AS(Math::abs(readFace(filter.specular(), CubeMapCoordinate::NegativeY, 0, size)[size*size/2 + size/2].x()), 0.01f, TestSuite::Compare::Less);
+
+        const Int last = filter.specularLevelCount() - 1;
+        const Int lastSize = Math::max(size >> last, 1);
+        const std::vector<Vector4> roughSide = readFace(filter.specular(), CubeMapCoordinate::PositiveX, last, lastSize);
+        CORRADE_COMPARE_AS(roughSide[lastSize*lastSize/2 + lastSize/2].x(), 0.05f, TestSuite::Compare::Greater);
+    }
+}
+
+void EnvironmentFilterGLTest::construct() {
+    if(!checkFragmentSupport())
+        CORRADE_SKIP("Floating-point render targets are not supported.");
+
+    EnvironmentFilter filter{64, 4};
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(filter.path(), EnvironmentFilter::defaultPath());
+    CORRADE_COMPARE(filter.specularSize(), 64);
+    CORRADE_COMPARE(filter.specularLevelCount(), 4);
+    CORRADE_COMPARE(filter.irradianceSize(), 32);
+    CORRADE_COMPARE(filter.sampleCount(), 64);
+    CORRADE_VERIFY(filter.specular().id());
+    CORRADE_VERIFY(filter.irradiance().id());
+    CORRADE_VERIFY(filter.irradianceCoefficients().id());
+}
+
+void EnvironmentFilterGLTest::setSampleCount() {
+    if(!checkFragmentSupport())
+        CORRADE_SKIP("Floating-point render targets are not supported.");
+
+    EnvironmentFilter filter{16, 2, 8, EnvironmentFilter::Path::Fragment};
+    filter.setSampleCount(16);
+    CORRADE_COMPARE(filter.sampleCount(), 16);
+
+    CubeMapTexture environment = environmentTexture(ConstantColors);
+    filter.update(environment);
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void EnvironmentFilterGLTest::constantCompute() {
+    if(EnvironmentFilter::defaultPath() != EnvironmentFilter::Path::Compute)
+        CORRADE_SKIP("Compute shaders or image load/store are not supported.");
+
+    CubeMapTexture environment = environmentTexture(ConstantColors);
+    EnvironmentFilter filter{16, 5, 8, EnvironmentFilter::Path::Compute};
+    filter.update(environment);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    verifyConstant(filter);
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void EnvironmentFilterGLTest::constantFragment() {
+    if(!checkFragmentSupport())
+        CORRADE_SKIP("Floating-point render targets are not supported.");
+
+    CubeMapTexture environment = environmentTexture(ConstantColors);
+    EnvironmentFilter filter{16, 5, 8, EnvironmentFilter::Path::Fragment};
+    filter.update(environment);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    verifyConstant(filter);
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void EnvironmentFilterGLTest::directionalCompute() {
+    if(EnvironmentFilter::defaultPath() != EnvironmentFilter::Path::Compute)
+        CORRADE_SKIP("Compute shaders or image load/store are not supported.");
+
+    CubeMapTexture environment = environmentTexture(DirectionalColors);
+    EnvironmentFilter filter{32, 4, 8, EnvironmentFilter::Path::Compute};
+    filter.update(environment);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    verifyDirectional(filter);
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void EnvironmentFilterGLTest::directionalFragment() {
+    if(!checkFragmentSupport())
+        CORRADE_SKIP("Floating-point render targets are not supported.");
+
+    CubeMapTexture environment = environmentTexture(DirectionalColors);
+    EnvironmentFilter filter{32, 4, 8, EnvironmentFilter::Path::Fragment};
+    filter.update(environment);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    verifyDirectional(filter);
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void EnvironmentFilterGLTest::debugPath() {
+    std::ostringstream out;
+    Debug{&out} << EnvironmentFilter::Path::Fragment << EnvironmentFilter::Path(0xde);
+    CORRADE_COMPARE(out.str(), "TextureTools::EnvironmentFilter::Path::Fragment TextureTools::EnvironmentFilter::Path(0xde)\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::TextureTools::Test::EnvironmentFilterGLTest)
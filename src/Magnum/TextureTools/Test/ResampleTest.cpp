@@ -0,0 +1,189 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/ThreadPool.h"
+#include "Magnum/Math/Vector4.h"
+#include "Magnum/TextureTools/Resample.h"
+
+namespace Magnum { namespace TextureTools { namespace Test {
+
+struct ResampleTest: TestSuite::Tester {
+    explicit ResampleTest();
+
+    void box();
+    void boxNonPowerOfTwo();
+    void srgb();
+    void kaiserFlat();
+    void kaiserGradient();
+    void floatType();
+    void parallel();
+
+    void mipmaps();
+    void mipmapsSinglePixel();
+};
+
+ResampleTest::ResampleTest() {
+    addTests({&ResampleTest::box,
+              &ResampleTest::boxNonPowerOfTwo,
+              &ResampleTest::srgb,
+              &ResampleTest::kaiserFlat,
+              &ResampleTest::kaiserGradient,
+              &ResampleTest::floatType,
+              &ResampleTest::parallel,
+
+              &ResampleTest::mipmaps,
+              &ResampleTest::mipmapsSinglePixel});
+}
+
+namespace {
+    typedef Math::Vector4<UnsignedByte> Vector4ub;
+}
+
+void ResampleTest::box() {
+    constexpr Vector4ub data[]{
+        {0, 10, 20, 255}, {20, 30, 40, 255}, {100, 0, 0, 0}, {200, 0, 0, 0},
+        {40, 50, 60, 255}, {60, 70, 80, 255}, {100, 0, 0, 0}, {200, 0, 0, 0}
+    };
+    Image2D out = resample(ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte, {4, 2}, data}, {2, 1});
+
+    CORRADE_COMPARE(out.size(), (Vector2i{2, 1}));
+    CORRADE_COMPARE(out.format(), PixelFormat::RGBA);
+    CORRADE_COMPARE(out.type(), PixelType::UnsignedByte);
+    const Vector4ub* pixels = reinterpret_cast<const Vector4ub*>(out.data().data());
+    CORRADE_COMPARE(pixels[0], (Vector4ub{30, 40, 50, 255}));
+    CORRADE_COMPARE(pixels[1], (Vector4ub{150, 0, 0, 0}));
+}
+
+void ResampleTest::boxNonPowerOfTwo() {
+    constexpr Vector4ub data[]{
+        {30, 0, 0, 0}, {60, 0, 0, 0}, {90, 0, 0, 0}
+    };
+    Image2D out = resample(ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte, {3, 1}, data}, {1, 1});
+
+    /* All three pixels contribute the same */
+    CORRADE_COMPARE(reinterpret_cast<const Vector4ub*>(out.data().data())[0], (Vector4ub{60, 0, 0, 0}));
+}
+
+void ResampleTest::srgb() {
+    constexpr Vector4ub data[]{
+        {0, 0, 0, 0}, {255, 255, 255, 255}
+    };
+    const ImageView2D image{PixelFormat::RGBA, PixelType::UnsignedByte, {2, 1}, data};
+
+    /* Without the flag the colors are averaged directly */
+    Image2D out = resample(image, {1, 1});
+    CORRADE_COMPARE(reinterpret_cast<const Vector4ub*>(out.data().data())[0], (Vector4ub{128, 128, 128, 128}));
+
+    /* With the flag the colors are averaged in linear space and are thus
+       brighter, alpha stays linear */
+    Image2D outSrgb = resample(image, {1, 1}, ResampleFilter::Box, ResampleFlag::Srgb);
+    CORRADE_COMPARE(reinterpret_cast<const Vector4ub*>(outSrgb.data().data())[0], (Vector4ub{188, 188, 188, 128}));
+}
+
+void ResampleTest::kaiserFlat() {
+    Vector4ub data[8*8];
+    for(Vector4ub& i: data) i = {100, 150, 200, 250};
+    Image2D out = resample(ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte, {8, 8}, data}, {3, 5}, ResampleFilter::Kaiser);
+
+    /* The weights are normalized, so a flat image stays flat */
+    CORRADE_COMPARE(out.size(), (Vector2i{3, 5}));
+    const Vector4ub* pixels = reinterpret_cast<const Vector4ub*>(out.data().data());
+    for(std::size_t i = 0; i != 3*5; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(pixels[i], (Vector4ub{100, 150, 200, 250}));
+    }
+}
+
+void ResampleTest::kaiserGradient() {
+    Vector4ub data[16];
+    for(std::size_t i = 0; i != 16; ++i)
+        data[i] = {UnsignedByte(i*16), 0, 0, 255};
+    Image2D out = resample(ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte, {16, 1}, data}, {4, 1}, ResampleFilter::Kaiser);
+
+    /* Monotonic gradient stays monotonic */
+    const Vector4ub* pixels = reinterpret_cast<const Vector4ub*>(out.data().data());
+    CORRADE_VERIFY(pixels[0].x() < pixels[1].x());
+    CORRADE_VERIFY(pixels[1].x() < pixels[2].x());
+    CORRADE_VERIFY(pixels[2].x() < pixels[3].x());
+    CORRADE_COMPARE(pixels[3].w(), 255);
+}
+
+void ResampleTest::floatType() {
+    constexpr Vector4 data[]{
+        {0.0f, 1.0f, 2.0f, 3.0f}, {2.0f, 3.0f, 4.0f, 5.0f}
+    };
+    Image2D out = resample(ImageView2D{PixelFormat::RGBA, PixelType::Float, {2, 1}, data}, {1, 1});
+
+    CORRADE_COMPARE(out.type(), PixelType::Float);
+    CORRADE_COMPARE(reinterpret_cast<const Vector4*>(out.data().data())[0], (Vector4{1.0f, 2.0f, 3.0f, 4.0f}));
+}
+
+void ResampleTest::parallel() {
+    Vector4ub data[64*48];
+    for(std::size_t i = 0; i != 64*48; ++i)
+        data[i] = {UnsignedByte(i*7), UnsignedByte(i*13), UnsignedByte(i), UnsignedByte(i*3)};
+    const ImageView2D image{PixelFormat::RGBA, PixelType::UnsignedByte, {64, 48}, data};
+
+    ThreadPool pool{4};
+    Image2D expected = resample(image, {20, 13}, ResampleFilter::Kaiser, ResampleFlag::Srgb);
+    Image2D actual = resample(image, {20, 13}, ResampleFilter::Kaiser, ResampleFlag::Srgb, pool);
+
+    const Vector4ub* expectedPixels = reinterpret_cast<const Vector4ub*>(expected.data().data());
+    const Vector4ub* actualPixels = reinterpret_cast<const Vector4ub*>(actual.data().data());
+    for(std::size_t i = 0; i != 20*13; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(actualPixels[i], expectedPixels[i]);
+    }
+}
+
+void ResampleTest::mipmaps() {
+    Vector4ub data[8*4];
+    for(Vector4ub& i: data) i = {10, 20, 30, 40};
+    std::vector<Image2D> levels = generateMipmaps(ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte, {8, 4}, data}, ResampleFilter::Box, ResampleFlag::Srgb);
+
+    CORRADE_COMPARE(levels.size(), 3);
+    CORRADE_COMPARE(levels[0].size(), (Vector2i{4, 2}));
+    CORRADE_COMPARE(levels[1].size(), (Vector2i{2, 1}));
+    CORRADE_COMPARE(levels[2].size(), (Vector2i{1, 1}));
+    CORRADE_COMPARE(reinterpret_cast<const Vector4ub*>(levels[2].data().data())[0], (Vector4ub{10, 20, 30, 40}));
+}
+
+void ResampleTest::mipmapsSinglePixel() {
+    constexpr Vector4ub data[]{{1, 2, 3, 4}};
+    std::vector<Image2D> levels = generateMipmaps(ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte, {1, 1}, data});
+
+    /* The base level is not included */
+    CORRADE_VERIFY(levels.empty());
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::TextureTools::Test::ResampleTest)
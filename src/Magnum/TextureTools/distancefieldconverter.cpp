@@ -23,6 +23,8 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <atomic>
+#include <chrono>
 #include <Corrade/Utility/Arguments.h>
 #include <Corrade/Utility/Directory.h>
 #include <Corrade/PluginManager/Manager.h>
@@ -32,7 +34,10 @@
 #include "Magnum/PixelFormat.h"
 #include "Magnum/Renderer.h"
 #include "Magnum/Texture.h"
+#include "Magnum/ThreadPool.h"
 #include "Magnum/TextureFormat.h"
+#include "Magnum/Implementation/converterBatch.h"
+#include "Magnum/TextureTools/Compression.h"
 #include "Magnum/TextureTools/DistanceField.h"
 #include "Magnum/Trade/AbstractImporter.h"
 #include "Magnum/Trade/AbstractImageConverter.h"
@@ -71,20 +76,33 @@ namespace Magnum {
 
 @code{.sh}
 magnum-distancefieldconverter [--magnum-...] [-h|--help] [--importer IMPORTER]
-    [--converter CONVERTER] [--plugin-dir DIR] --output-size "X Y" --radius N
-    [--] input output
+    [--converter CONVERTER] [--plugin-dir DIR] [--cpu] [--compress FORMAT]
+    [--batch] [--threads N] --output-size "X Y" --radius N [--] input output
 @endcode
 
 Arguments:
 
--   `input` --- input image
--   `output` --- output image
+-   `input` --- input image or a batch manifest if `--batch` is set
+-   `output` --- output image or an output directory if `--batch` is set
 -   `-h`, `--help` --- display help message and exit
 -   `--importer IMPORTER` --- image importer plugin (default:
     @ref Trade::AnyImageImporter "AnyImageImporter")
 -   `--converter CONVERTER` --- image converter plugin (default:
     @ref Trade::AnyImageConverter "AnyImageConverter")
 -   `--plugin-dir DIR` --- override base plugin dir
+-   `--cpu` --- compute the distance field on the CPU using
+    @ref TextureTools::distanceField(const ImageView2D&, const Vector2i&, Int, ThreadPool&)
+    instead of the GPU. No GPU context is created in that case, so it can be
+    used on headless machines.
+-   `--compress FORMAT` --- compress the output using
+    @ref TextureTools::compressRedRgtc1() if `FORMAT` is `rgtc1` or
+    @ref TextureTools::compressR11Eac() if `FORMAT` is `r11eac`. The
+    converter plugin has to support saving compressed images, e.g. to a KTX or
+    DDS file.
+-   `--batch` --- convert all files listed in the `input` manifest, see
+    @ref magnum-distancefieldconverter-batch
+-   `--threads N` --- count of threads used for the CPU conversion (default:
+    `0`, which means the count of hardware threads)
 -   `--output-size "X Y"` --- size of output image
 -   `--radius N` --- distance field computation radius
 -   `--magnum-...` --- engine-specific options (see @ref Context for details)
@@ -106,6 +124,17 @@ This will open monochrome `logo-src.png` image using any plugin that can open
 PNG files and converts it to 256x256 distance field `logo.png` using any plugin
 that can write PNG files.
 
+@section magnum-distancefieldconverter-batch Batch conversion
+
+With `--batch`, the `input` is a manifest listing an input and an output file
+on each line, in the same format as described in
+@ref magnum-imageconverter-batch, and the plugins are loaded only once for all
+files. With `--cpu`, the files are processed concurrently on a
+@ref ThreadPool, each thread with its own importer and converter instance and
+computing the distance field of a single file at a time. On the GPU, the files
+are converted one after another. At the end the count of converted files and
+the throughput is printed.
+
 */
 
 namespace TextureTools {
@@ -117,22 +146,30 @@ class DistanceFieldConverter: public Platform::WindowlessApplication {
         int exec() override;
 
     private:
+        int convert(Trade::AbstractImporter& importer, Trade::AbstractImageConverter& converter, const std::string& input, const std::string& output, ThreadPool* pool, std::size_t& dataSize);
+        int save(Trade::AbstractImageConverter& converter, const Image2D& result, const std::string& output);
+
         Utility::Arguments args;
+        std::mutex _managerMutex;
 };
 
 DistanceFieldConverter::DistanceFieldConverter(const Arguments& arguments): Platform::WindowlessApplication{arguments, NoCreate} {
-    args.addArgument("input").setHelp("input", "input image")
-        .addArgument("output").setHelp("output", "output image")
+    args.addArgument("input").setHelp("input", "input image or a batch manifest")
+        .addArgument("output").setHelp("output", "output image or an output directory")
         .addOption("importer", "AnyImageImporter").setHelp("importer", "image importer plugin")
         .addOption("converter", "AnyImageConverter").setHelp("converter", "image converter plugin")
         .addOption("plugin-dir").setHelp("plugin-dir", "override base plugin dir", "DIR")
+        .addBooleanOption("cpu").setHelp("cpu", "compute the distance field on the CPU, without a GPU context")
+        .addOption("compress").setHelp("compress", "compress the output, either rgtc1 or r11eac", "FORMAT")
+        .addBooleanOption("batch").setHelp("batch", "convert all files listed in the input manifest")
+        .addOption("threads", "0").setHelp("threads", "count of threads used for the CPU conversion", "N")
         .addNamedArgument("output-size").setHelp("output-size", "size of output image", "\"X Y\"")
         .addNamedArgument("radius").setHelp("radius", "distance field computation radius", "N")
         .addSkippedPrefix("magnum", "engine-specific options")
         .setHelp("Converts red channel of an image to distance field representation.")
         .parse(arguments.argc, arguments.argv);
 
-    createContext();
+    if(!args.isSet("cpu")) createContext();
 }
 
 int DistanceFieldConverter::exec() {
@@ -150,11 +187,105 @@ int DistanceFieldConverter::exec() {
     std::unique_ptr<Trade::AbstractImageConverter> converter = converterManager.loadAndInstantiate(args.value("converter"));
     if(!converter) return 2;
 
+    /* Only the CPU conversion uses the pool, a single-threaded pool doesn't
+       spawn any threads */
+    ThreadPool pool{args.isSet("cpu") ? args.value<UnsignedInt>("threads") : 1};
+
+    /* Single file */
+    if(!args.isSet("batch")) {
+        std::size_t dataSize;
+        return convert(*importer, *converter, args.value("input"), args.value("output"), &pool, dataSize);
+    }
+
+    /* Batch conversion */
+    Containers::Optional<std::vector<Implementation::BatchEntry>> entries = Implementation::parseBatchManifest(args.value("input"), args.value("output"));
+    if(!entries) return 3;
+    Utility::Directory::mkpath(args.value("output"));
+
+    std::atomic<std::size_t> succeeded{0}, failed{0}, dataSize{0};
+    const auto begin = std::chrono::steady_clock::now();
+
+    /* On the GPU there's just one context, process the files one after
+       another */
+    if(!args.isSet("cpu")) {
+        for(const Implementation::BatchEntry& entry: *entries) {
+            std::size_t size;
+            if(convert(*importer, *converter, entry.input, entry.output, nullptr, size)) {
+                ++failed;
+                continue;
+            }
+
+            ++succeeded;
+            dataSize += size;
+        }
+
+    /* On the CPU process the files concurrently, every thread takes its own
+       plugin instances from the list and returns them after it finishes
+       processing its chunk of files */
+    } else {
+        std::vector<std::pair<std::unique_ptr<Trade::AbstractImporter>, std::unique_ptr<Trade::AbstractImageConverter>>> instances;
+        instances.emplace_back(std::move(importer), std::move(converter));
+        for(UnsignedInt i = 1; i < pool.threadCount(); ++i)
+            instances.emplace_back(importerManager.instantiate(args.value("importer")), converterManager.instantiate(args.value("converter")));
+
+        std::mutex instanceMutex;
+        pool.parallelFor(entries->size(), 1, [&](const std::size_t first, const std::size_t last) {
+            std::pair<std::unique_ptr<Trade::AbstractImporter>, std::unique_ptr<Trade::AbstractImageConverter>> instance;
+            {
+                std::lock_guard<std::mutex> lock{instanceMutex};
+                instance = std::move(instances.back());
+                instances.pop_back();
+            }
+
+            for(std::size_t i = first; i != last; ++i) {
+                std::size_t size;
+                if(convert(*instance.first, *instance.second, (*entries)[i].input, (*entries)[i].output, nullptr, size)) {
+                    ++failed;
+                    continue;
+                }
+
+                ++succeeded;
+                dataSize += size;
+            }
+
+            std::lock_guard<std::mutex> lock{instanceMutex};
+            instances.push_back(std::move(instance));
+        });
+    }
+
+    Implementation::printBatchSummary(succeeded, failed, dataSize, std::chrono::duration<Double>(std::chrono::steady_clock::now() - begin).count());
+    return failed ? 5 : 0;
+}
+
+int DistanceFieldConverter::convert(Trade::AbstractImporter& importer, Trade::AbstractImageConverter& converter, const std::string& input, const std::string& output, ThreadPool* const pool, std::size_t& dataSize) {
     /* Open input file */
     Containers::Optional<Trade::ImageData2D> image;
-    if(!importer->openFile(args.value("input")) || !(image = importer->image2D(0))) {
-        Error() << "Cannot open file" << args.value("input");
-        return 3;
+    {
+        std::unique_lock<std::mutex> lock = Implementation::lockIfProxyPlugin(_managerMutex, args.value("importer"));
+        if(!importer.openFile(input) || !(image = importer.image2D(0))) {
+            Error() << "Cannot open file" << input;
+            return 3;
+        }
+        importer.close();
+    }
+    dataSize = image->data().size();
+
+    /* Do it on the CPU, if requested. Without a pool the conversion is
+       running concurrently with other files, be quiet in that case. */
+    if(args.isSet("cpu")) {
+        if(image->type() != PixelType::UnsignedByte) {
+            Error() << "Unsupported image type" << image->type();
+            return 4;
+        }
+
+        if(pool) {
+            Debug() << "Converting image of size" << image->size() << "to distance field on the CPU...";
+            const Image2D result = TextureTools::distanceField(*image, args.value<Vector2i>("output-size"), args.value<Int>("radius"), *pool);
+            return save(converter, result, output);
+        }
+
+        const Image2D result = TextureTools::distanceField(*image, args.value<Vector2i>("output-size"), args.value<Int>("radius"));
+        return save(converter, result, output);
     }
 
     /* Decide about internal format */
@@ -168,28 +299,64 @@ int DistanceFieldConverter::exec() {
     }
 
     /* Input texture */
-    Texture2D input;
-    input.setMinificationFilter(Sampler::Filter::Linear)
+    Texture2D inputTexture;
+    inputTexture.setMinificationFilter(Sampler::Filter::Linear)
         .setMagnificationFilter(Sampler::Filter::Linear)
         .setWrapping(Sampler::Wrapping::ClampToEdge)
         .setStorage(1, internalFormat, image->size())
         .setSubImage(0, {}, *image);
 
     /* Output texture */
-    Texture2D output;
-    output.setStorage(1, TextureFormat::R8, args.value<Vector2i>("output-size"));
+    Texture2D outputTexture;
+    outputTexture.setStorage(1, TextureFormat::R8, args.value<Vector2i>("output-size"));
 
     CORRADE_INTERNAL_ASSERT(Renderer::error() == Renderer::Error::NoError);
 
     /* Do it */
-    Debug() << "Converting image of size" << image->size() << "to distance field...";
-    TextureTools::distanceField(input, output, {{}, args.value<Vector2i>("output-size")}, args.value<Int>("radius"), image->size());
+    if(pool) Debug() << "Converting image of size" << image->size() << "to distance field...";
+    TextureTools::distanceField(inputTexture, outputTexture, {{}, args.value<Vector2i>("output-size")}, args.value<Int>("radius"), image->size());
 
     /* Save image */
     Image2D result(PixelFormat::Red, PixelType::UnsignedByte);
-    output.image(0, result);
-    if(!converter->exportToFile(result, args.value("output"))) {
-        Error() << "Cannot save file" << args.value("output");
+    outputTexture.image(0, result);
+    return save(converter, result, output);
+}
+
+int DistanceFieldConverter::save(Trade::AbstractImageConverter& converter, const Image2D& result, const std::string& output) {
+    const std::string compression = args.value("compress");
+
+    /* Uncompressed output */
+    if(compression.empty()) {
+        std::unique_lock<std::mutex> lock = Implementation::lockIfProxyPlugin(_managerMutex, args.value("converter"));
+        if(!converter.exportToFile(result, output)) {
+            Error() << "Cannot save file" << output;
+            return 5;
+        }
+
+        return 0;
+    }
+
+    Containers::Optional<CompressedImage2D> compressed;
+    #ifndef MAGNUM_TARGET_GLES
+    if(compression == "rgtc1") compressed = TextureTools::compressRedRgtc1(result);
+    #endif
+    #ifndef MAGNUM_TARGET_GLES2
+    if(compression == "r11eac") compressed = TextureTools::compressR11Eac(result);
+    #endif
+    if(!compressed) {
+        Error() << "Unsupported compression format" << compression;
+        return 6;
+    }
+
+    if(!(converter.features() & Trade::AbstractImageConverter::Feature::ConvertCompressedFile)) {
+        Error() << "Converter" << args.value("converter") << "can't save compressed images";
+        return 6;
+    }
+
+    Debug() << "Saving the output compressed as" << compressed->format();
+    std::unique_lock<std::mutex> lock = Implementation::lockIfProxyPlugin(_managerMutex, args.value("converter"));
+    if(!converter.exportToFile(*compressed, output)) {
+        Error() << "Cannot save file" << output;
         return 5;
     }
 
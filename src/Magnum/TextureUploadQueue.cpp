@@ -0,0 +1,272 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "TextureUploadQueue.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Buffer.h"
+#include "Magnum/BufferImage.h"
+#include "Magnum/Fence.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/Texture.h"
+#include "Magnum/TextureArray.h"
+
+namespace Magnum {
+
+namespace {
+
+struct Upload {
+    UnsignedInt id;
+    Texture2D* texture;
+    Texture2DArray* textureArray;
+    Int level;
+    Vector3i offset;
+    PixelStorage storage;
+    PixelFormat format;
+    PixelType type;
+    Vector2i size;
+    std::size_t dataSize;
+    TextureUploadQueue::Decoder decoder;
+};
+
+enum class SlotState: UnsignedByte {
+    Free,
+    Decoding,
+    Decoded,
+    Uploaded
+};
+
+struct Slot {
+    Buffer buffer{Buffer::TargetHint::PixelUnpack};
+    Containers::ArrayView<char> data;
+    Fence fence;
+    Upload upload;
+    /* Guarded by the mutex */
+    SlotState state{SlotState::Free};
+};
+
+}
+
+struct TextureUploadQueue::State {
+    std::size_t slotSize;
+    std::vector<Slot> slots;
+
+    /* Uploads waiting for a free slot, accessed only from the GL thread */
+    std::deque<Upload> waiting;
+    UnsignedInt nextId{1};
+    std::size_t pending{};
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wakeUp, decoded;
+    /* Slots to decode, guarded by the mutex */
+    std::deque<std::size_t> decodeQueue;
+    bool stop{};
+
+    void assignWaiting();
+};
+
+void TextureUploadQueue::State::assignWaiting() {
+    bool assigned = false;
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        for(std::size_t i = 0; i != slots.size() && !waiting.empty(); ++i) {
+            if(slots[i].state != SlotState::Free) continue;
+
+            slots[i].upload = std::move(waiting.front());
+            waiting.pop_front();
+            slots[i].state = SlotState::Decoding;
+            decodeQueue.push_back(i);
+            assigned = true;
+        }
+    }
+
+    if(assigned) wakeUp.notify_all();
+}
+
+TextureUploadQueue::TextureUploadQueue(const std::size_t slotSize, const UnsignedInt slotCount, const UnsignedInt threadCount): _state{new State} {
+    CORRADE_ASSERT(slotCount, "TextureUploadQueue: expected at least one slot", );
+    CORRADE_ASSERT(threadCount, "TextureUploadQueue: expected at least one thread", );
+
+    State& state = *_state;
+    state.slotSize = slotSize;
+    state.slots.resize(slotCount);
+    for(Slot& slot: state.slots) {
+        slot.buffer.setStorage(slotSize,
+            Buffer::StorageFlag::MapWrite|Buffer::StorageFlag::MapPersistent|Buffer::StorageFlag::MapCoherent);
+        slot.data = slot.buffer.map(0, slotSize,
+            Buffer::MapFlag::Write|Buffer::MapFlag::Persistent|Buffer::MapFlag::Coherent);
+    }
+
+    state.workers.reserve(threadCount);
+    for(UnsignedInt i = 0; i != threadCount; ++i) state.workers.emplace_back([&state]() {
+        std::unique_lock<std::mutex> lock{state.mutex};
+        for(;;) {
+            state.wakeUp.wait(lock, [&state]() {
+                return state.stop || !state.decodeQueue.empty();
+            });
+            if(state.stop) return;
+
+            Slot& slot = state.slots[state.decodeQueue.front()];
+            state.decodeQueue.pop_front();
+
+            /* The GL thread doesn't touch the slot while it's decoding */
+            lock.unlock();
+            slot.upload.decoder(slot.data.prefix(slot.upload.dataSize));
+            lock.lock();
+
+            slot.state = SlotState::Decoded;
+            state.decoded.notify_all();
+        }
+    });
+}
+
+TextureUploadQueue::~TextureUploadQueue() {
+    {
+        std::lock_guard<std::mutex> lock{_state->mutex};
+        _state->stop = true;
+    }
+    _state->wakeUp.notify_all();
+    for(std::thread& worker: _state->workers) worker.join();
+
+    for(Slot& slot: _state->slots) slot.buffer.unmap();
+}
+
+std::size_t TextureUploadQueue::slotSize() const { return _state->slotSize; }
+
+UnsignedInt TextureUploadQueue::slotCount() const { return _state->slots.size(); }
+
+UnsignedInt TextureUploadQueue::threadCount() const { return _state->workers.size(); }
+
+std::size_t TextureUploadQueue::pendingCount() const { return _state->pending; }
+
+UnsignedInt TextureUploadQueue::enqueue(Texture2D& texture, const Int level, const Vector2i& offset, const PixelStorage& storage, const PixelFormat format, const PixelType type, const Vector2i& size, Decoder decoder) {
+    return enqueueInternal(&texture, nullptr, level, {offset, 0}, storage, format, type, size, std::move(decoder));
+}
+
+UnsignedInt TextureUploadQueue::enqueue(Texture2DArray& texture, const Int level, const Vector3i& offset, const PixelStorage& storage, const PixelFormat format, const PixelType type, const Vector2i& size, Decoder decoder) {
+    return enqueueInternal(nullptr, &texture, level, offset, storage, format, type, size, std::move(decoder));
+}
+
+UnsignedInt TextureUploadQueue::enqueueInternal(Texture2D* const texture, Texture2DArray* const textureArray, const Int level, const Vector3i& offset, const PixelStorage& storage, const PixelFormat format, const PixelType type, const Vector2i& size, Decoder&& decoder) {
+    State& state = *_state;
+
+    const std::size_t dataSize = Implementation::imageDataSize(ImageView2D{storage, format, type, size});
+    CORRADE_ASSERT(dataSize <= state.slotSize,
+        "TextureUploadQueue::enqueue(): image data size" << dataSize << "doesn't fit into slot size" << state.slotSize, {});
+
+    const UnsignedInt id = state.nextId++;
+    state.waiting.push_back({id, texture, textureArray, level, offset, storage, format, type, size, dataSize, std::move(decoder)});
+    ++state.pending;
+    state.assignWaiting();
+    return id;
+}
+
+std::vector<UnsignedInt> TextureUploadQueue::update() {
+    State& state = *_state;
+    std::vector<UnsignedInt> completed;
+
+    for(Slot& slot: state.slots) {
+        SlotState slotState;
+        {
+            std::lock_guard<std::mutex> lock{state.mutex};
+            slotState = slot.state;
+        }
+
+        /* Submit the decoded data. The buffer is temporarily moved into the
+           image and then taken back, the mapping stays intact. */
+        if(slotState == SlotState::Decoded) {
+            const Upload& upload = slot.upload;
+            if(upload.texture) {
+                BufferImage2D image{upload.storage, upload.format, upload.type, upload.size, std::move(slot.buffer), upload.dataSize};
+                upload.texture->setSubImage(upload.level, upload.offset.xy(), image);
+                slot.buffer = std::move(image.buffer());
+            } else {
+                BufferImage3D image{upload.storage, upload.format, upload.type, {upload.size, 1}, std::move(slot.buffer), upload.dataSize};
+                upload.textureArray->setSubImage(upload.level, upload.offset, image);
+                slot.buffer = std::move(image.buffer());
+            }
+
+            slot.fence.insert();
+            slotState = SlotState::Uploaded;
+
+            std::lock_guard<std::mutex> lock{state.mutex};
+            slot.state = slotState;
+
+        /* Retire slots that the GPU is done with */
+        } else if(slotState == SlotState::Uploaded && slot.fence.isSignaled()) {
+            completed.push_back(slot.upload.id);
+            slot.upload.decoder = nullptr;
+            --state.pending;
+
+            std::lock_guard<std::mutex> lock{state.mutex};
+            slot.state = SlotState::Free;
+        }
+    }
+
+    state.assignWaiting();
+    return completed;
+}
+
+std::vector<UnsignedInt> TextureUploadQueue::finish() {
+    State& state = *_state;
+    std::vector<UnsignedInt> completed;
+
+    while(state.pending) {
+        const std::vector<UnsignedInt> current = update();
+        completed.insert(completed.end(), current.begin(), current.end());
+        if(!state.pending) break;
+
+        /* Wait for the GPU on the uploaded slots, which also flushes the
+           command stream, and for the decoders on the others */
+        bool anyUploaded = false;
+        for(Slot& slot: state.slots) {
+            SlotState slotState;
+            {
+                std::lock_guard<std::mutex> lock{state.mutex};
+                slotState = slot.state;
+            }
+            if(slotState != SlotState::Uploaded) continue;
+
+            slot.fence.clientWait(std::chrono::milliseconds{1});
+            anyUploaded = true;
+        }
+
+        if(!anyUploaded) {
+            std::unique_lock<std::mutex> lock{state.mutex};
+            state.decoded.wait_for(lock, std::chrono::milliseconds{1});
+        }
+    }
+
+    return completed;
+}
+
+}
@@ -0,0 +1,211 @@
+#ifndef Magnum_TextureUploadQueue_h
+#define Magnum_TextureUploadQueue_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef MAGNUM_TARGET_GLES
+/** @file
+ * @brief Class @ref Magnum::TextureUploadQueue
+ */
+#endif
+
+#include <functional>
+#include <memory>
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/PixelStorage.h"
+#include "Magnum/visibility.h"
+
+#ifndef MAGNUM_TARGET_GLES
+namespace Magnum {
+
+/**
+@brief Asynchronous texture upload queue
+
+Uploads texture data through a fixed set of persistently mapped pixel unpack
+buffers without stalling the thread owning the GL context. Each upload gets
+assigned a free buffer slot and a decoder function, which is then executed on
+a worker thread and writes the pixel data directly to the mapped memory. Once
+the decoding is done, @ref update() called on the GL thread issues
+@ref Texture::setSubImage() "setSubImage()" from the buffer using
+@ref BufferImage and inserts a @ref Fence after it. When the fence is
+signaled, the slot is reused for another upload and the upload is reported
+as complete:
+
+@snippet Magnum.cpp TextureUploadQueue-usage
+
+If there is no free slot, the upload waits in the queue until a slot is
+retired in a later @ref update() call. The slot count thus bounds the memory
+used for staging and the slot size has to be large enough for the largest
+uploaded image.
+
+@section TextureUploadQueue-threading Threading
+
+All functions have to be called from the thread owning the GL context, only
+the decoder functions are executed on the worker threads. The decoder gets
+the mapped memory of the slot, cropped to the data size of the image, and
+must not access any GL state. The textures have to be kept alive until the
+upload is reported as complete.
+
+@requires_gl44 Extension @extension{ARB,buffer_storage}
+@requires_gl Persistent mapping is not available in OpenGL ES and WebGL.
+*/
+class MAGNUM_EXPORT TextureUploadQueue {
+    public:
+        /**
+         * @brief Decoder function
+         *
+         * Gets a view on the mapped memory to write the pixel data to.
+         */
+        typedef std::function<void(Containers::ArrayView<char>)> Decoder;
+
+        /**
+         * @brief Constructor
+         * @param slotSize      Size of one staging buffer in bytes
+         * @param slotCount     Count of staging buffers
+         * @param threadCount   Count of decoding worker threads
+         *
+         * Allocates @p slotCount buffers with @ref Buffer::setStorage()
+         * using @ref Buffer::StorageFlag::MapWrite,
+         * @ref Buffer::StorageFlag::MapPersistent and
+         * @ref Buffer::StorageFlag::MapCoherent and maps them for the whole
+         * lifetime of the instance. Expects that both @p slotCount and
+         * @p threadCount are non-zero.
+         */
+        explicit TextureUploadQueue(std::size_t slotSize, UnsignedInt slotCount = 4, UnsignedInt threadCount = 1);
+
+        /** @brief Copying is not allowed */
+        TextureUploadQueue(const TextureUploadQueue&) = delete;
+
+        /** @brief Moving is not allowed */
+        TextureUploadQueue(TextureUploadQueue&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Waits for the decoders that are currently executing, stops the
+         * worker threads and unmaps the buffers. Uploads that haven't been
+         * submitted yet are discarded.
+         */
+        ~TextureUploadQueue();
+
+        /** @brief Copying is not allowed */
+        TextureUploadQueue& operator=(const TextureUploadQueue&) = delete;
+
+        /** @brief Moving is not allowed */
+        TextureUploadQueue& operator=(TextureUploadQueue&&) = delete;
+
+        /** @brief Size of one staging buffer in bytes */
+        std::size_t slotSize() const;
+
+        /** @brief Count of staging buffers */
+        UnsignedInt slotCount() const;
+
+        /** @brief Count of decoding worker threads */
+        UnsignedInt threadCount() const;
+
+        /**
+         * @brief Count of pending uploads
+         *
+         * Uploads that were enqueued but not yet reported as complete by
+         * @ref update() or @ref finish().
+         */
+        std::size_t pendingCount() const;
+
+        /**
+         * @brief Enqueue a texture upload
+         * @param texture   Texture to upload to
+         * @param level     Mip level
+         * @param offset    Offset where to put data in the texture
+         * @param storage   Storage of pixel data
+         * @param format    Format of pixel data
+         * @param type      Data type of pixel data
+         * @param size      Image size
+         * @param decoder   Function writing the pixel data
+         * @return Upload ID, unique for the lifetime of the queue
+         *
+         * Expects that the image data size is not larger than
+         * @ref slotSize(). If a slot is free, the decoding starts
+         * immediately.
+         */
+        UnsignedInt enqueue(Texture2D& texture, Int level, const Vector2i& offset, const PixelStorage& storage, PixelFormat format, PixelType type, const Vector2i& size, Decoder decoder);
+
+        /** @overload
+         * Similar to the above, but uses default @ref PixelStorage parameters.
+         */
+        UnsignedInt enqueue(Texture2D& texture, Int level, const Vector2i& offset, PixelFormat format, PixelType type, const Vector2i& size, Decoder decoder) {
+            return enqueue(texture, level, offset, {}, format, type, size, std::move(decoder));
+        }
+
+        /**
+         * @brief Enqueue a texture array layer upload
+         *
+         * Uploads a single layer at @cpp offset.z() @ce, otherwise
+         * equivalent to @ref enqueue(Texture2D&, Int, const Vector2i&, const PixelStorage&, PixelFormat, PixelType, const Vector2i&, Decoder).
+         */
+        UnsignedInt enqueue(Texture2DArray& texture, Int level, const Vector3i& offset, const PixelStorage& storage, PixelFormat format, PixelType type, const Vector2i& size, Decoder decoder);
+
+        /** @overload
+         * Similar to the above, but uses default @ref PixelStorage parameters.
+         */
+        UnsignedInt enqueue(Texture2DArray& texture, Int level, const Vector3i& offset, PixelFormat format, PixelType type, const Vector2i& size, Decoder decoder) {
+            return enqueue(texture, level, offset, {}, format, type, size, std::move(decoder));
+        }
+
+        /**
+         * @brief Advance the uploads
+         * @return IDs of uploads completed in this call
+         *
+         * Submits uploads of all slots that finished decoding, retires slots
+         * whose fence is signaled and assigns waiting uploads to the free
+         * slots. Doesn't block, meant to be called once per frame.
+         */
+        std::vector<UnsignedInt> update();
+
+        /**
+         * @brief Finish all uploads
+         * @return IDs of uploads completed in this call
+         *
+         * Calls @ref update() until all pending uploads are complete, waiting
+         * for the decoders and fences in between.
+         */
+        std::vector<UnsignedInt> finish();
+
+    private:
+        struct State;
+
+        UnsignedInt enqueueInternal(Texture2D* texture, Texture2DArray* textureArray, Int level, const Vector3i& offset, const PixelStorage& storage, PixelFormat format, PixelType type, const Vector2i& size, Decoder&& decoder);
+
+        std::unique_ptr<State> _state;
+};
+
+}
+#else
+#error this header is available only in desktop OpenGL build
+#endif
+
+#endif
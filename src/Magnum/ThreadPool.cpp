@@ -0,0 +1,165 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <Corrade/Utility/Assert.h>
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#endif
+
+namespace Magnum {
+
+struct ThreadPool::State {
+    void runChunks(UnsignedInt threadId);
+
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wakeUp, finished;
+    UnsignedLong generation{};
+    UnsignedInt pending{};
+    bool stop{};
+
+    std::atomic<std::size_t> nextChunk{};
+    #endif
+
+    /* Current job */
+    const std::function<void(std::size_t, std::size_t)>* job{};
+    std::size_t count{}, chunkSize{}, chunkCount{};
+    Schedule schedule{};
+};
+
+void ThreadPool::State::runChunks(const UnsignedInt threadId) {
+    auto run = [this](const std::size_t chunk) {
+        const std::size_t begin = chunk*chunkSize;
+        (*job)(begin, std::min(begin + chunkSize, count));
+    };
+
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    if(schedule == Schedule::Dynamic) {
+        for(std::size_t chunk; (chunk = nextChunk.fetch_add(1)) < chunkCount; )
+            run(chunk);
+    } else {
+        const std::size_t threadCount = workers.size() + 1;
+        for(std::size_t chunk = threadId; chunk < chunkCount; chunk += threadCount)
+            run(chunk);
+    }
+    #else
+    static_cast<void>(threadId);
+    for(std::size_t chunk = 0; chunk != chunkCount; ++chunk)
+        run(chunk);
+    #endif
+}
+
+ThreadPool::ThreadPool(UnsignedInt threadCount): _state{new State} {
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    if(!threadCount) threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+
+    _state->workers.reserve(threadCount - 1);
+    for(UnsignedInt i = 1; i < threadCount; ++i) _state->workers.emplace_back([this, i]() {
+        State& state = *_state;
+        std::unique_lock<std::mutex> lock{state.mutex};
+        UnsignedLong seenGeneration = 0;
+        for(;;) {
+            state.wakeUp.wait(lock, [&state, seenGeneration]() {
+                return state.stop || state.generation != seenGeneration;
+            });
+            if(state.stop) return;
+            seenGeneration = state.generation;
+
+            lock.unlock();
+            state.runChunks(i);
+            lock.lock();
+
+            if(!--state.pending) state.finished.notify_one();
+        }
+    });
+    #else
+    static_cast<void>(threadCount);
+    #endif
+}
+
+ThreadPool::~ThreadPool() {
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    {
+        std::lock_guard<std::mutex> lock{_state->mutex};
+        _state->stop = true;
+    }
+    _state->wakeUp.notify_all();
+    for(std::thread& worker: _state->workers) worker.join();
+    #endif
+}
+
+UnsignedInt ThreadPool::threadCount() const {
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    return UnsignedInt(_state->workers.size() + 1);
+    #else
+    return 1;
+    #endif
+}
+
+void ThreadPool::parallelFor(const std::size_t count, const std::size_t chunkSize, const std::function<void(std::size_t, std::size_t)>& job, const Schedule schedule) {
+    CORRADE_ASSERT(chunkSize, "ThreadPool::parallelFor(): chunk size can't be zero", );
+    if(!count) return;
+
+    State& state = *_state;
+    state.job = &job;
+    state.count = count;
+    state.chunkSize = chunkSize;
+    state.chunkCount = (count + chunkSize - 1)/chunkSize;
+    state.schedule = schedule;
+
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    /* Nothing to parallelize, don't bother waking up the workers */
+    if(state.workers.empty() || state.chunkCount == 1) {
+        for(std::size_t begin = 0; begin < count; begin += chunkSize)
+            job(begin, std::min(begin + chunkSize, count));
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock{state.mutex};
+        state.nextChunk = 0;
+        state.pending = state.workers.size();
+        ++state.generation;
+    }
+    state.wakeUp.notify_all();
+
+    state.runChunks(0);
+
+    std::unique_lock<std::mutex> lock{state.mutex};
+    state.finished.wait(lock, [&state]() { return !state.pending; });
+    #else
+    state.runChunks(0);
+    #endif
+}
+
+}
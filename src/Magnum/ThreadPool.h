@@ -0,0 +1,156 @@
+#ifndef Magnum_ThreadPool_h
+#define Magnum_ThreadPool_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::ThreadPool
+ */
+
+#include <functional>
+#include <memory>
+
+#include "Magnum/Types.h"
+#include "Magnum/visibility.h"
+
+namespace Magnum {
+
+/**
+@brief Thread pool
+
+Persistent set of worker threads for running data-parallel jobs. The work is
+split into chunks of given size and distributed among the workers and the
+calling thread, which participates in the work as well. The function returns
+after all chunks are processed.
+
+@code{.cpp}
+ThreadPool pool;
+
+std::vector<Vector3> positions = ...;
+pool.parallelFor(positions.size(), 1024, [&](std::size_t begin, std::size_t end) {
+    for(std::size_t i = begin; i != end; ++i)
+        positions[i] = transformation.transformPoint(positions[i]);
+});
+@endcode
+
+The pool is not tied to any particular subsystem, it's used for example by
+@ref SceneGraph::AnimableGroup::step(Float, Float, ThreadPool&, ThreadPool::Schedule).
+
+@section ThreadPool-scheduling Scheduling
+
+With @ref Schedule::Dynamic, idle threads claim the next unprocessed chunk,
+so threads that finished their work early take over chunks that would
+otherwise wait for a busy thread. This balances the load when the chunks take
+different amounts of time. With @ref Schedule::Static, chunk @f$ i @f$ is
+always processed by thread @f$ i \bmod n @f$, in increasing order, so the
+assignment of work to threads is the same on every run. It's useful for
+reproducing issues in jobs that aren't entirely independent and for
+deterministic replays.
+
+@section ThreadPool-limitations Limitations
+
+It's not allowed to call @ref parallelFor() from inside a job or from more than
+one thread at a time. On platforms without thread support (such as
+@ref CORRADE_TARGET_EMSCRIPTEN "Emscripten") the pool has no workers and all
+jobs run serially on the calling thread.
+*/
+class MAGNUM_EXPORT ThreadPool {
+    public:
+        /**
+         * @brief Job scheduling
+         *
+         * @see @ref parallelFor()
+         */
+        enum class Schedule: UnsignedByte {
+            /** Chunks are claimed by threads as they become idle */
+            Dynamic,
+
+            /** Chunks are assigned to threads in a round-robin fashion */
+            Static
+        };
+
+        /**
+         * @brief Constructor
+         * @param threadCount   Count of threads including the calling thread.
+         *      If @cpp 0 @ce, @ref std::thread::hardware_concurrency() is
+         *      used.
+         *
+         * Spawns @cpp threadCount - 1 @ce worker threads, which wait for jobs
+         * submitted through @ref parallelFor().
+         */
+        explicit ThreadPool(UnsignedInt threadCount = 0);
+
+        /** @brief Copying is not allowed */
+        ThreadPool(const ThreadPool&) = delete;
+
+        /** @brief Moving is not allowed */
+        ThreadPool(ThreadPool&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Joins all worker threads.
+         */
+        ~ThreadPool();
+
+        /** @brief Copying is not allowed */
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        /** @brief Moving is not allowed */
+        ThreadPool& operator=(ThreadPool&&) = delete;
+
+        /**
+         * @brief Count of threads
+         *
+         * Including the calling thread. Always @cpp 1 @ce on platforms
+         * without thread support.
+         */
+        UnsignedInt threadCount() const;
+
+        /**
+         * @brief Run a job in parallel
+         * @param count         Count of items to process
+         * @param chunkSize     Count of items in one chunk
+         * @param job           Job processing items in range
+         *      @cpp [begin, end) @ce
+         * @param schedule      Scheduling of chunks
+         *
+         * Splits the range @cpp [0, count) @ce into chunks of @p chunkSize
+         * items (the last one might be smaller) and calls @p job for each of
+         * them, concurrently on the worker threads and the calling thread.
+         * Returns after all chunks were processed. If there's just one chunk,
+         * it's processed on the calling thread without waking up the workers.
+         * Expects that @p chunkSize is not zero.
+         */
+        void parallelFor(std::size_t count, std::size_t chunkSize, const std::function<void(std::size_t, std::size_t)>& job, Schedule schedule = Schedule::Dynamic);
+
+    private:
+        struct State;
+        std::unique_ptr<State> _state;
+};
+
+}
+
+#endif
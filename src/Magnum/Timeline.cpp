@@ -25,20 +25,48 @@
 
 #include "Timeline.h"
 
+#include <algorithm>
+#include <Corrade/Utility/Assert.h>
 #include <Corrade/Utility/Debug.h>
 #include <Corrade/Utility/System.h>
 
+#include "Magnum/FrameAllocator.h"
 #include "Magnum/Magnum.h"
+#include "Magnum/Math/Functions.h"
 
 using namespace std::chrono;
 
 namespace Magnum {
 
+namespace {
+
+/* Eight linear sub-buckets for each power of two, values below 8 get a bucket
+   each. 32-bit microseconds thus need (32 - 2)*8 buckets. */
+constexpr std::size_t HistogramBucketCount = 240;
+
+std::size_t histogramBucket(const UnsignedInt microseconds) {
+    if(microseconds < 8) return microseconds;
+    const UnsignedInt log = Math::log2(microseconds);
+    return (log - 2)*8 + ((microseconds >> (log - 3)) & 7);
+}
+
+/* Exclusive upper bound of values in given bucket */
+UnsignedLong histogramBucketEnd(const std::size_t bucket) {
+    if(bucket < 8) return bucket + 1;
+    return UnsignedLong(9 + bucket % 8) << (bucket/8 - 1);
+}
+
+}
+
 void Timeline::start() {
     running = true;
     _startTime = high_resolution_clock::now();
     _previousFrameTime = _startTime;
     _previousFrameDuration = 0;
+    _frameCount = 0;
+    std::fill(_history.begin(), _history.end(), 0);
+    _historyPosition = 0;
+    resetFrameHistogram();
 }
 
 void Timeline::stop() {
@@ -55,10 +83,71 @@ void Timeline::nextFrame() {
     auto duration = UnsignedInt(duration_cast<microseconds>(now-_previousFrameTime).count());
     _previousFrameDuration = duration/1e6f;
     _previousFrameTime = now;
+
+    if(!_history.empty()) {
+        _history[_historyPosition] = duration;
+        _historyPosition = (_historyPosition + 1) % _history.size();
+        ++_histogram[histogramBucket(duration)];
+    }
+
+    if(_hitchCallback && duration > _hitchThreshold)
+        _hitchCallback(_previousFrameDuration, _frameCount, _hitchUserData);
+
+    if(_frameAllocator) _frameAllocator->reset();
+
+    ++_frameCount;
 }
 
 Float Timeline::previousFrameTime() const {
     return duration_cast<microseconds>(_previousFrameTime-_startTime).count()/1e6f;
 }
 
+Timeline& Timeline::setFrameHistorySize(const std::size_t size) {
+    _history.assign(size, 0);
+    _historyPosition = 0;
+    _histogram.assign(size ? HistogramBucketCount : 0, 0);
+    return *this;
+}
+
+std::vector<Float> Timeline::frameHistory() const {
+    const std::size_t count = std::min(UnsignedLong(_history.size()), _frameCount);
+    std::vector<Float> out;
+    out.reserve(count);
+    /* Oldest frame is at the current position if the ring is full */
+    const std::size_t begin = count == _history.size() ? _historyPosition : 0;
+    for(std::size_t i = 0; i != count; ++i)
+        out.push_back(_history[(begin + i) % _history.size()]/1e6f);
+    return out;
+}
+
+Float Timeline::frameDurationPercentile(const Float percentile) const {
+    CORRADE_ASSERT(percentile >= 0.0f && percentile <= 100.0f,
+        "Timeline::frameDurationPercentile(): percentile" << percentile << "out of range", {});
+
+    UnsignedLong total = 0;
+    for(UnsignedInt i: _histogram) total += i;
+    if(!total) return 0.0f;
+
+    /* Smallest bucket containing the requested count of frames */
+    const UnsignedLong target = std::max(UnsignedLong(1), UnsignedLong(percentile*0.01f*total + 0.5f));
+    UnsignedLong sum = 0;
+    for(std::size_t i = 0; i != _histogram.size(); ++i) {
+        sum += _histogram[i];
+        if(sum >= target) return histogramBucketEnd(i)/1e6f;
+    }
+
+    return histogramBucketEnd(_histogram.size() - 1)/1e6f; /* LCOV_EXCL_LINE */
+}
+
+void Timeline::resetFrameHistogram() {
+    std::fill(_histogram.begin(), _histogram.end(), 0);
+}
+
+Timeline& Timeline::setHitchCallback(const Float threshold, const HitchCallback callback, void* const userData) {
+    _hitchThreshold = UnsignedInt(threshold*1e6f);
+    _hitchCallback = callback;
+    _hitchUserData = userData;
+    return *this;
+}
+
 }
@@ -30,8 +30,9 @@
  */
 
 #include <chrono>
+#include <vector>
 
-#include "Magnum/Types.h"
+#include "Magnum/Magnum.h"
 #include "Magnum/visibility.h"
 
 namespace Magnum {
@@ -85,6 +86,25 @@ void MyApplication::drawEvent() {
     timeline.nextFrame();
 }
 @endcode
+
+@section Timeline-frame-statistics Frame history and hitch detection
+
+Calling @ref setFrameHistorySize() with a non-zero value makes the timeline
+remember durations of the last few frames, available through
+@ref frameHistory(), and additionally put all frame durations into a
+histogram with logarithmically spaced buckets, similar to
+[HdrHistogram](http://hdrhistogram.org/). The histogram has a fixed size
+independent of frame count, keeps relative precision of about 12% across the
+whole microsecond-to-minutes range and can be queried for duration
+percentiles using @ref frameDurationPercentile(). Recording a frame is just a
+few integer operations.
+
+To catch rare hitches, use @ref setHitchCallback(). The callback is called
+from @ref nextFrame() for every frame longer than given threshold, before
+anything else is reset for the next frame, so it can for example query the
+state of a @ref DebugTools::Profiler to attribute the hitch:
+
+@snippet MagnumDebugTools.cpp Timeline-hitchCallback
 */
 class MAGNUM_EXPORT Timeline {
     public:
@@ -94,7 +114,16 @@ class MAGNUM_EXPORT Timeline {
          * Creates stopped timeline.
          * @see @ref start()
          */
-        explicit Timeline(): _previousFrameDuration(0), running(false) {}
+        explicit Timeline(): _previousFrameDuration(0), running(false), _frameCount{}, _historyPosition{}, _hitchThreshold{}, _hitchCallback{}, _hitchUserData{}, _frameAllocator{} {}
+
+        /**
+         * @brief Hitch callback
+         *
+         * The parameters are duration of the frame in seconds, index of the
+         * frame since @ref start() and user data passed to
+         * @ref setHitchCallback().
+         */
+        typedef void(*HitchCallback)(Float, UnsignedLong, void*);
 
         /**
          * @brief Start timeline
@@ -134,12 +163,99 @@ class MAGNUM_EXPORT Timeline {
          */
         Float previousFrameDuration() const { return _previousFrameDuration; }
 
+        /**
+         * @brief Count of frames since the timeline was started
+         *
+         * @see @ref start(), @ref nextFrame()
+         */
+        UnsignedLong frameCount() const { return _frameCount; }
+
+        /** @brief Frame history size */
+        std::size_t frameHistorySize() const { return _history.size(); }
+
+        /**
+         * @brief Set frame history size
+         * @return Reference to self (for method chaining)
+         *
+         * If non-zero, durations of last @p size frames are remembered and
+         * all frame durations are recorded into a histogram. Setting it to
+         * @cpp 0 @ce (the default) disables both. Changing the size clears
+         * the history and the histogram. See
+         * @ref Timeline-frame-statistics for more information.
+         */
+        Timeline& setFrameHistorySize(std::size_t size);
+
+        /**
+         * @brief Frame history
+         *
+         * Durations of at most @ref frameHistorySize() last frames in seconds,
+         * oldest first.
+         */
+        std::vector<Float> frameHistory() const;
+
+        /**
+         * @brief Frame duration percentile
+         *
+         * Returns duration in seconds that @p percentile percent of frames
+         * recorded in the histogram didn't exceed, with the histogram bucket
+         * precision. Expects that @p percentile is in range
+         * @f$ [0, 100] @f$. Returns @cpp 0.0f @ce if the frame history is
+         * disabled or no frame was recorded yet.
+         * @see @ref setFrameHistorySize(), @ref resetFrameHistogram()
+         */
+        Float frameDurationPercentile(Float percentile) const;
+
+        /**
+         * @brief Reset frame histogram
+         *
+         * Frame history is kept.
+         */
+        void resetFrameHistogram();
+
+        /**
+         * @brief Set hitch callback
+         * @return Reference to self (for method chaining)
+         *
+         * The @p callback is called from @ref nextFrame() for each frame
+         * longer than @p threshold seconds. Pass @cpp nullptr @ce to disable
+         * it. See @ref Timeline-frame-statistics for more information.
+         */
+        Timeline& setHitchCallback(Float threshold, HitchCallback callback, void* userData = nullptr);
+
+        /** @brief Frame allocator */
+        FrameAllocator* frameAllocator() const { return _frameAllocator; }
+
+        /**
+         * @brief Set frame allocator
+         * @return Reference to self (for method chaining)
+         *
+         * If non-null, the @p allocator is reset with
+         * @ref FrameAllocator::reset() at the end of every
+         * @ref nextFrame(). The allocator is expected to outlive the
+         * timeline or be unset before being destroyed. Default is
+         * @cpp nullptr @ce.
+         */
+        Timeline& setFrameAllocator(FrameAllocator* allocator) {
+            _frameAllocator = allocator;
+            return *this;
+        }
+
     private:
         std::chrono::high_resolution_clock::time_point _startTime;
         std::chrono::high_resolution_clock::time_point _previousFrameTime;
         Float _previousFrameDuration;
 
         bool running;
+
+        UnsignedLong _frameCount;
+        std::vector<UnsignedInt> _history;
+        std::size_t _historyPosition;
+        std::vector<UnsignedInt> _histogram;
+
+        UnsignedInt _hitchThreshold;
+        HitchCallback _hitchCallback;
+        void* _hitchUserData;
+        FrameAllocator* _frameAllocator;
 };
 
 }
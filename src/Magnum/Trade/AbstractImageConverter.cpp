@@ -25,6 +25,9 @@
 
 #include "AbstractImageConverter.h"
 
+#include <algorithm>
+#include <fstream>
+#include <string>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Utility/Assert.h>
 #include <Corrade/Utility/Directory.h>
@@ -93,9 +96,21 @@ Containers::Array<char> AbstractImageConverter::exportToData(const ImageView2D&
     return doExportToData(image);
 }
 
-Containers::Array<char> AbstractImageConverter::doExportToData(const ImageView2D&) {
-    CORRADE_ASSERT(false, "Trade::AbstractImageConverter::exportToData(): feature advertised but not implemented", nullptr);
-    return nullptr;
+Containers::Array<char> AbstractImageConverter::doExportToData(const ImageView2D& image) {
+    /* Feature::ConvertStream shares bits with Feature::ConvertData, so
+       checking for any overlapping bit is not enough */
+    CORRADE_ASSERT((features() & Feature::ConvertStream) == Feature::ConvertStream,
+        "Trade::AbstractImageConverter::exportToData(): feature advertised but not implemented", nullptr);
+
+    std::string out;
+    if(!doExportToStream(image, [&out](Containers::ArrayView<const char> chunk) {
+        out.append(chunk.data(), chunk.size());
+        return true;
+    })) return nullptr;
+
+    Containers::Array<char> data{out.size()};
+    std::copy(out.begin(), out.end(), data.begin());
+    return data;
 }
 
 Containers::Array<char> AbstractImageConverter::exportToData(const CompressedImageView2D& image) {
@@ -114,6 +129,18 @@ Containers::Array<char> AbstractImageConverter::exportToData(const ImageData2D&
     return image.isCompressed() ? exportToData(CompressedImageView2D(image)) : exportToData(ImageView2D(image));
 }
 
+bool AbstractImageConverter::exportToStream(const ImageView2D& image, const StreamWriter& writer) {
+    CORRADE_ASSERT((features() & Feature::ConvertStream) == Feature::ConvertStream,
+        "Trade::AbstractImageConverter::exportToStream(): feature not supported", {});
+
+    return doExportToStream(image, writer);
+}
+
+bool AbstractImageConverter::doExportToStream(const ImageView2D&, const StreamWriter&) {
+    CORRADE_ASSERT(false, "Trade::AbstractImageConverter::exportToStream(): feature advertised but not implemented", {});
+    return false;
+}
+
 bool AbstractImageConverter::exportToFile(const ImageView2D& image, const std::string& filename) {
     CORRADE_ASSERT(features() & Feature::ConvertFile,
         "Trade::AbstractImageConverter::exportToFile(): feature not supported", {});
@@ -122,6 +149,26 @@ bool AbstractImageConverter::exportToFile(const ImageView2D& image, const std::s
 }
 
 bool AbstractImageConverter::doExportToFile(const ImageView2D& image, const std::string& filename) {
+    /* Write the chunks directly to the file if streaming is supported */
+    if((features() & Feature::ConvertStream) == Feature::ConvertStream) {
+        std::ofstream file{filename, std::ofstream::binary};
+        if(!file.good()) {
+            Error() << "Trade::AbstractImageConverter::exportToFile(): cannot write to file" << filename;
+            return false;
+        }
+
+        bool written = true;
+        if(!doExportToStream(image, [&file, &written](Containers::ArrayView<const char> chunk) {
+            file.write(chunk.data(), chunk.size());
+            return written = file.good();
+        })) {
+            if(!written) Error() << "Trade::AbstractImageConverter::exportToFile(): cannot write to file" << filename;
+            return false;
+        }
+
+        return true;
+    }
+
     CORRADE_ASSERT(features() & Feature::ConvertData, "Trade::AbstractImageConverter::exportToFile(): not implemented", false);
 
     const auto data = doExportToData(image);
@@ -29,6 +29,7 @@
  * @brief Class @ref Magnum::Trade::AbstractImageConverter
  */
 
+#include <functional>
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/PluginManager/AbstractManagingPlugin.h>
 
@@ -67,6 +68,14 @@ checked by the implementation:
     @ref Feature::ConvertData is supported.
 -   The function @ref doExportToData(const CompressedImageView2D&) is called
     only if @ref Feature::ConvertCompressedData is supported.
+-   The function @ref doExportToStream() is called only if
+    @ref Feature::ConvertStream is supported.
+
+If the plugin supports @ref Feature::ConvertStream, it's enough to implement
+just @ref doExportToStream() --- the default implementations of
+@ref doExportToData(const ImageView2D&) and
+@ref doExportToFile(const ImageView2D&, const std::string&) are then built on
+top of it, the latter without ever having the whole encoded file in memory.
 
 @attention @ref Corrade::Containers::Array instances returned from the plugin
     should *not* use anything else than the default deleter, otherwise this can
@@ -104,7 +113,13 @@ class MAGNUM_TRADE_EXPORT AbstractImageConverter: public PluginManager::Abstract
              * @ref exportToData(const CompressedImageView2D&). Implies
              * @ref Feature::ConvertCompressedFile.
              */
-            ConvertCompressedData = ConvertCompressedFile|(1 << 4)
+            ConvertCompressedData = ConvertCompressedFile|(1 << 4),
+
+            /**
+             * Exporting to a sequence of data chunks with
+             * @ref exportToStream(). Implies @ref Feature::ConvertData.
+             */
+            ConvertStream = ConvertData|(1 << 5)
         };
 
         /**
@@ -114,6 +129,15 @@ class MAGNUM_TRADE_EXPORT AbstractImageConverter: public PluginManager::Abstract
          */
         typedef Containers::EnumSet<Feature> Features;
 
+        /**
+         * @brief Stream writer
+         *
+         * Called by @ref exportToStream() with consecutive chunks of the
+         * encoded output. The data are valid only for the duration of the
+         * call. Return `false` to abort the export.
+         */
+        typedef std::function<bool(Containers::ArrayView<const char>)> StreamWriter;
+
         /**
          * @brief Plugin interface
          *
@@ -201,6 +225,18 @@ class MAGNUM_TRADE_EXPORT AbstractImageConverter: public PluginManager::Abstract
          */
         Containers::Array<char> exportToData(const ImageData2D& image);
 
+        /**
+         * @brief Export image to a stream of data chunks
+         *
+         * Available only if @ref Feature::ConvertStream is supported. Passes
+         * the encoded output to @p writer in consecutive chunks instead of
+         * materializing it all at once. Returns `true` on success, `false` if
+         * the conversion failed or if @p writer returned `false`.
+         * @see @ref features(), @ref exportToData(const ImageView2D&),
+         *      @ref exportToFile(const ImageView2D&, const std::string&)
+         */
+        bool exportToStream(const ImageView2D& image, const StreamWriter& writer);
+
         /**
          * @brief Export image to file
          *
@@ -247,16 +283,26 @@ class MAGNUM_TRADE_EXPORT AbstractImageConverter: public PluginManager::Abstract
         /** @brief Implementation of @ref exportToCompressedImage() */
         virtual Containers::Optional<CompressedImage2D> doExportToCompressedImage(const ImageView2D& image);
 
-        /** @brief Implementation of @ref exportToData(const ImageView2D&) */
+        /**
+         * @brief Implementation of @ref exportToData(const ImageView2D&)
+         *
+         * If @ref Feature::ConvertStream is supported, default implementation
+         * calls @ref doExportToStream() and concatenates the chunks.
+         */
         virtual Containers::Array<char> doExportToData(const ImageView2D& image);
 
         /** @brief Implementation of @ref exportToData(const CompressedImageView2D&) */
         virtual Containers::Array<char> doExportToData(const CompressedImageView2D& image);
 
+        /** @brief Implementation of @ref exportToStream() */
+        virtual bool doExportToStream(const ImageView2D& image, const StreamWriter& writer);
+
         /**
          * @brief Implementation of @ref exportToFile(const ImageView2D&, const std::string&)
          *
-         * If @ref Feature::ConvertData is supported, default implementation
+         * If @ref Feature::ConvertStream is supported, default implementation
+         * calls @ref doExportToStream() and writes the chunks to given file as
+         * they arrive. Otherwise, if @ref Feature::ConvertData is supported,
          * calls @ref doExportToData(const ImageView2D&) and saves the result
          * to given file.
          */
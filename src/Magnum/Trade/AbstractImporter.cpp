@@ -25,6 +25,7 @@
 
 #include "AbstractImporter.h"
 
+#include <tuple>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/PluginManager/Manager.h>
 #include <Corrade/Utility/Assert.h>
@@ -34,12 +35,14 @@
 #include "Magnum/Trade/CameraData.h"
 #include "Magnum/Trade/ImageData.h"
 #include "Magnum/Trade/LightData.h"
+#include "Magnum/Trade/MeshData.h"
 #include "Magnum/Trade/MeshData2D.h"
 #include "Magnum/Trade/MeshData3D.h"
 #include "Magnum/Trade/ObjectData2D.h"
 #include "Magnum/Trade/ObjectData3D.h"
 #include "Magnum/Trade/SceneData.h"
 #include "Magnum/Trade/TextureData.h"
+#include "Magnum/Implementation/mapFile.h"
 
 #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
 #include "Magnum/Trade/configure.h"
@@ -48,7 +51,7 @@
 namespace Magnum { namespace Trade {
 
 std::string AbstractImporter::pluginInterface() {
-    return "cz.mosra.magnum.Trade.AbstractImporter/0.3";
+    return "cz.mosra.magnum.Trade.AbstractImporter/0.3.1";
 }
 
 #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
@@ -71,6 +74,9 @@ AbstractImporter::AbstractImporter(PluginManager::Manager<AbstractImporter>& man
 
 AbstractImporter::AbstractImporter(PluginManager::AbstractManager& manager, const std::string& plugin): PluginManager::AbstractManagingPlugin<AbstractImporter>{manager, plugin} {}
 
+/* The derived destructor is already done with the mapping at this point */
+AbstractImporter::~AbstractImporter() { unmapFile(); }
+
 bool AbstractImporter::openData(Containers::ArrayView<const char> data) {
     CORRADE_ASSERT(features() & Feature::OpenData,
         "Trade::AbstractImporter::openData(): feature not supported", {});
@@ -84,6 +90,19 @@ void AbstractImporter::doOpenData(Containers::ArrayView<const char>) {
     CORRADE_ASSERT(false, "Trade::AbstractImporter::openData(): feature advertised but not implemented", );
 }
 
+bool AbstractImporter::openMemory(Containers::ArrayView<const char> memory) {
+    CORRADE_ASSERT((features() & Feature::OpenMemory) == Feature::OpenMemory,
+        "Trade::AbstractImporter::openMemory(): feature not supported", {});
+
+    close();
+    doOpenMemory(memory);
+    return isOpened();
+}
+
+void AbstractImporter::doOpenMemory(Containers::ArrayView<const char> memory) {
+    doOpenData(memory);
+}
+
 bool AbstractImporter::openState(const void* state, const std::string& filePath) {
     CORRADE_ASSERT(features() & Feature::OpenState,
         "Trade::AbstractImporter::OpenState(): feature not supported", {});
@@ -106,6 +125,17 @@ bool AbstractImporter::openFile(const std::string& filename) {
 void AbstractImporter::doOpenFile(const std::string& filename) {
     CORRADE_ASSERT(features() & Feature::OpenData, "Trade::AbstractImporter::openFile(): not implemented", );
 
+    /* Map the file, if the importer can work with it directly. If the
+       opening fails, the mapping is not needed anymore. */
+    if((features() & Feature::OpenMemory) == Feature::OpenMemory) {
+        std::tie(_mappedData, _mappedSize) = Magnum::Implementation::mapFile(filename);
+        if(_mappedData) {
+            doOpenMemory({_mappedData, _mappedSize});
+            if(!isOpened()) unmapFile();
+            return;
+        }
+    }
+
     /* Open file */
     if(!Utility::Directory::fileExists(filename)) {
         Error() << "Trade::AbstractImporter::openFile(): cannot open file" << filename;
@@ -115,11 +145,29 @@ void AbstractImporter::doOpenFile(const std::string& filename) {
     doOpenData(Utility::Directory::read(filename));
 }
 
+namespace {
+    void nonOwnedArrayDeleter(char*, std::size_t) {}
+}
+
+Containers::Array<char> AbstractImporter::nonOwnedArray(const Containers::ArrayView<const char> data) {
+    return Containers::Array<char>{const_cast<char*>(data.data()), data.size(), nonOwnedArrayDeleter};
+}
+
 void AbstractImporter::close() {
     if(isOpened()) {
         doClose();
         CORRADE_INTERNAL_ASSERT(!isOpened());
     }
+
+    unmapFile();
+}
+
+void AbstractImporter::unmapFile() {
+    if(!_mappedData) return;
+
+    Magnum::Implementation::unmapFile(_mappedData, _mappedSize);
+    _mappedData = nullptr;
+    _mappedSize = 0;
 }
 
 Int AbstractImporter::defaultScene() {
@@ -339,6 +387,21 @@ Containers::Optional<MeshData3D> AbstractImporter::mesh3D(const UnsignedInt id)
 
 Containers::Optional<MeshData3D> AbstractImporter::doMesh3D(UnsignedInt) { return Containers::NullOpt; }
 
+UnsignedInt AbstractImporter::meshCount() const {
+    CORRADE_ASSERT(isOpened(), "Trade::AbstractImporter::meshCount(): no file opened", {});
+    return doMeshCount();
+}
+
+UnsignedInt AbstractImporter::doMeshCount() const { return 0; }
+
+Containers::Optional<MeshData> AbstractImporter::mesh(const UnsignedInt id) {
+    CORRADE_ASSERT(isOpened(), "Trade::AbstractImporter::mesh(): no file opened", {});
+    CORRADE_ASSERT(id < doMeshCount(), "Trade::AbstractImporter::mesh(): index out of range", {});
+    return doMesh(id);
+}
+
+Containers::Optional<MeshData> AbstractImporter::doMesh(UnsignedInt) { return Containers::NullOpt; }
+
 UnsignedInt AbstractImporter::materialCount() const {
     CORRADE_ASSERT(isOpened(), "Trade::AbstractImporter::materialCount(): no file opened", {});
     return doMaterialCount();
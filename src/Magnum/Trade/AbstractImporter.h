@@ -72,6 +72,8 @@ checked by the implementation:
     called only if there is any file opened.
 -   The @ref doOpenData() function is called only if @ref Feature::OpenData is
     supported.
+-   The @ref doOpenMemory() function is called only if
+    @ref Feature::OpenMemory is supported.
 -   The @ref doOpenState() function is called only if @ref Feature::OpenState
     is supported.
 -   All `do*()` implementations working on an opened file are called only if
@@ -80,9 +82,10 @@ checked by the implementation:
     the ID is from valid range.
 
 @attention @ref Corrade::Containers::Array instances returned from the plugin
-    should *not* use anything else than the default deleter, otherwise this can
-    cause dangling function pointer call on array destruction if the plugin
-    gets unloaded before the array is destroyed.
+    should *not* use anything else than the default deleter or the deleter of
+    @ref nonOwnedArray(), otherwise this can cause dangling function pointer
+    call on array destruction if the plugin gets unloaded before the array is
+    destroyed.
 
 @todo How to handle casting from std::unique_ptr<> in more convenient way?
 */
@@ -98,7 +101,15 @@ class MAGNUM_TRADE_EXPORT AbstractImporter: public PluginManager::AbstractManagi
             OpenData = 1 << 0,
 
             /** Opening already loaded state using @ref openState() */
-            OpenState = 1 << 1
+            OpenState = 1 << 1,
+
+            /**
+             * Opening data that stays in scope using @ref openMemory(),
+             * without copying it. If supported, @ref openFile() maps the file
+             * into memory instead of reading it. Implies
+             * @ref Feature::OpenData.
+             */
+            OpenMemory = OpenData|(1 << 2)
         };
 
         /** @brief Set of features supported by this importer */
@@ -108,7 +119,7 @@ class MAGNUM_TRADE_EXPORT AbstractImporter: public PluginManager::AbstractManagi
          * @brief Plugin interface
          *
          * @code{.cpp}
-         * "cz.mosra.magnum.Trade.AbstractImporter/0.3"
+         * "cz.mosra.magnum.Trade.AbstractImporter/0.3.1"
          * @endcode
          */
         static std::string pluginInterface();
@@ -139,6 +150,8 @@ class MAGNUM_TRADE_EXPORT AbstractImporter: public PluginManager::AbstractManagi
         /** @brief Plugin manager constructor */
         explicit AbstractImporter(PluginManager::AbstractManager& manager, const std::string& plugin);
 
+        ~AbstractImporter();
+
         /** @brief Features supported by this importer */
         Features features() const { return doFeatures(); }
 
@@ -155,6 +168,19 @@ class MAGNUM_TRADE_EXPORT AbstractImporter: public PluginManager::AbstractManagi
          */
         bool openData(Containers::ArrayView<const char> data);
 
+        /**
+         * @brief Open memory
+         *
+         * Closes previous file, if it was opened, and tries to open given
+         * memory. Unlike @ref openData(), the importer doesn't make a copy
+         * of @p memory and may reference it until the file is closed, so the
+         * memory is expected to stay in scope and unchanged until then.
+         * Available only if @ref Feature::OpenMemory is supported. Returns
+         * @cpp true @ce on success, @cpp false @ce otherwise.
+         * @see @ref features(), @ref openFile()
+         */
+        bool openMemory(Containers::ArrayView<const char> memory);
+
         /**
          * @brief Open already loaded state
          * @param state     Pointer to importer-specific state
@@ -176,6 +202,11 @@ class MAGNUM_TRADE_EXPORT AbstractImporter: public PluginManager::AbstractManagi
          *
          * Closes previous file, if it was opened, and tries to open given
          * file. Returns @cpp true @ce on success, @cpp false @ce otherwise.
+         *
+         * If @ref Feature::OpenMemory is supported and the platform allows
+         * it, the file is memory-mapped instead of being read into memory,
+         * avoiding a copy and keeping only the actually accessed parts of it
+         * in physical memory. The mapping is released on @ref close().
          * @see @ref features(), @ref openData()
          */
         bool openFile(const std::string& filename);
@@ -387,6 +418,24 @@ class MAGNUM_TRADE_EXPORT AbstractImporter: public PluginManager::AbstractManagi
          */
         Containers::Optional<MeshData3D> mesh3D(UnsignedInt id);
 
+        /**
+         * @brief Compact mesh count
+         *
+         * Count of meshes available through @ref mesh(). Importers that
+         * provide meshes only as @ref MeshData2D or @ref MeshData3D return
+         * @cpp 0 @ce.
+         */
+        UnsignedInt meshCount() const;
+
+        /**
+         * @brief Compact mesh
+         * @param id        Mesh ID, from range [0, @ref meshCount()).
+         *
+         * Returns given mesh or @ref Containers::NullOpt if importing failed.
+         * @see @ref mesh2D(), @ref mesh3D()
+         */
+        Containers::Optional<MeshData> mesh(UnsignedInt id);
+
         /** @brief Material count */
         UnsignedInt materialCount() const;
 
@@ -543,14 +592,43 @@ class MAGNUM_TRADE_EXPORT AbstractImporter: public PluginManager::AbstractManagi
         /**
          * @brief Implementation for @ref openFile()
          *
-         * If @ref Feature::OpenData is supported, default implementation opens
-         * the file and calls @ref Magnum::Trade::AbstractImporter::doOpenData() "doOpenData()"
+         * If @ref Feature::OpenMemory is supported, default implementation
+         * maps the file into memory and calls
+         * @ref Magnum::Trade::AbstractImporter::doOpenMemory() "doOpenMemory()"
+         * with the mapping. Otherwise, or if the file can't be mapped and
+         * @ref Feature::OpenData is supported, it reads the file and calls
+         * @ref Magnum::Trade::AbstractImporter::doOpenData() "doOpenData()"
          * with its contents. It is allowed to call this function from your
          * @ref Magnum::Trade::AbstractImporter::doOpenFile() "doOpenFile()"
          * implementation.
          */
         virtual void doOpenFile(const std::string& filename);
 
+        /**
+         * @brief Whether the opened data are a file mapping
+         *
+         * Returns @cpp true @ce if the data passed to
+         * @ref Magnum::Trade::AbstractImporter::doOpenMemory() "doOpenMemory()"
+         * are a mapping made by the default @ref doOpenFile() implementation,
+         * which is released on @ref close(). Returns @cpp false @ce if the
+         * memory was passed by the user through @ref openMemory() or if
+         * there's no mapping.
+         */
+        bool isFileMapped() const { return _mappedData; }
+
+        /**
+         * @brief Wrap memory in a non-owning array
+         *
+         * Returns an array pointing to @p data with a deleter that does
+         * nothing. The deleter is defined in the Trade library, so the
+         * array can be safely returned from a plugin that gets unloaded
+         * before the array is destroyed. Meant for returning data that
+         * reference memory passed to @ref openMemory() without copying. The
+         * memory is not expected to be modified through the array.
+         * @see @ref isFileMapped()
+         */
+        static Containers::Array<char> nonOwnedArray(Containers::ArrayView<const char> data);
+
     #ifndef DOXYGEN_GENERATING_OUTPUT
     private:
     #else
@@ -565,6 +643,14 @@ class MAGNUM_TRADE_EXPORT AbstractImporter: public PluginManager::AbstractManagi
         /** @brief Implementation for @ref openData() */
         virtual void doOpenData(Containers::ArrayView<const char> data);
 
+        /**
+         * @brief Implementation for @ref openMemory()
+         *
+         * Default implementation calls @ref doOpenData(). It's allowed to
+         * keep @p memory referenced until @ref doClose() is called.
+         */
+        virtual void doOpenMemory(Containers::ArrayView<const char> memory);
+
         /** @brief Implementation for @ref openState() */
         virtual void doOpenState(const void* state, const std::string& filePath);
 
@@ -746,6 +832,16 @@ class MAGNUM_TRADE_EXPORT AbstractImporter: public PluginManager::AbstractManagi
         /** @brief Implementation for @ref mesh3D() */
         virtual Containers::Optional<MeshData3D> doMesh3D(UnsignedInt id);
 
+        /**
+         * @brief Implementation for @ref meshCount()
+         *
+         * Default implementation returns @cpp 0 @ce.
+         */
+        virtual UnsignedInt doMeshCount() const;
+
+        /** @brief Implementation for @ref mesh() */
+        virtual Containers::Optional<MeshData> doMesh(UnsignedInt id);
+
         /**
          * @brief Implementation for @ref materialCount()
          *
@@ -868,6 +964,13 @@ class MAGNUM_TRADE_EXPORT AbstractImporter: public PluginManager::AbstractManagi
 
         /** @brief Implementation for @ref importerState() */
         virtual const void* doImporterState() const;
+
+    private:
+        void unmapFile();
+
+        /* File mapped by the default doOpenFile() implementation */
+        const char* _mappedData{};
+        std::size_t _mappedSize{};
 };
 
 CORRADE_ENUMSET_OPERATORS(AbstractImporter::Features)
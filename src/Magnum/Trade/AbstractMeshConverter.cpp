@@ -0,0 +1,98 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "AbstractMeshConverter.h"
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Directory.h>
+
+#include "Magnum/Trade/MeshData.h"
+
+#ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+#include "Magnum/Trade/configure.h"
+#endif
+
+namespace Magnum { namespace Trade {
+
+std::string AbstractMeshConverter::pluginInterface() {
+    return "cz.mosra.magnum.Trade.AbstractMeshConverter/0.1";
+}
+
+#ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+std::vector<std::string> AbstractMeshConverter::pluginSearchPaths() {
+    return {
+        #ifdef CORRADE_IS_DEBUG_BUILD
+        "magnum-d/meshconverters",
+        Utility::Directory::join(MAGNUM_PLUGINS_DEBUG_DIR, "meshconverters")
+        #else
+        "magnum/meshconverters",
+        Utility::Directory::join(MAGNUM_PLUGINS_DIR, "meshconverters")
+        #endif
+    };
+}
+#endif
+
+AbstractMeshConverter::AbstractMeshConverter() = default;
+
+AbstractMeshConverter::AbstractMeshConverter(PluginManager::Manager<AbstractMeshConverter>& manager): PluginManager::AbstractManagingPlugin<AbstractMeshConverter>{manager} {}
+
+AbstractMeshConverter::AbstractMeshConverter(PluginManager::AbstractManager& manager, const std::string& plugin): PluginManager::AbstractManagingPlugin<AbstractMeshConverter>{manager, plugin} {}
+
+Containers::Array<char> AbstractMeshConverter::exportToData(const MeshData& mesh) {
+    CORRADE_ASSERT(features() & Feature::ConvertData,
+        "Trade::AbstractMeshConverter::exportToData(): feature not supported", nullptr);
+
+    return doExportToData(mesh);
+}
+
+Containers::Array<char> AbstractMeshConverter::doExportToData(const MeshData&) {
+    CORRADE_ASSERT(false, "Trade::AbstractMeshConverter::exportToData(): feature advertised but not implemented", nullptr);
+    return nullptr;
+}
+
+bool AbstractMeshConverter::exportToFile(const MeshData& mesh, const std::string& filename) {
+    CORRADE_ASSERT(features() & Feature::ConvertFile,
+        "Trade::AbstractMeshConverter::exportToFile(): feature not supported", {});
+
+    return doExportToFile(mesh, filename);
+}
+
+bool AbstractMeshConverter::doExportToFile(const MeshData& mesh, const std::string& filename) {
+    CORRADE_ASSERT(features() & Feature::ConvertData, "Trade::AbstractMeshConverter::exportToFile(): not implemented", false);
+
+    const auto data = doExportToData(mesh);
+    if(!data) return false;
+
+    /* Open file */
+    if(!Utility::Directory::write(filename, data)) {
+        Error() << "Trade::AbstractMeshConverter::exportToFile(): cannot write to file" << filename;
+        return false;
+    }
+
+    return true;
+}
+
+}}
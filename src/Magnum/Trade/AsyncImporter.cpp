@@ -0,0 +1,254 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "AsyncImporter.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include <thread>
+#endif
+
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/ImageData.h"
+#include "Magnum/Trade/MeshData3D.h"
+#include "Magnum/Trade/SceneData.h"
+
+namespace Magnum { namespace Trade {
+
+struct AsyncImporter::Entry {
+    UnsignedInt id;
+    Job job;
+    std::function<void()> completion;
+    JobContext context;
+};
+
+struct AsyncImporter::State {
+    UnsignedInt nextId{1};
+    std::size_t pending{};
+
+    /* Entries are moved between the lists only on one side or the other of
+       the mutex, the running entry itself is accessed by the worker without
+       it */
+    std::deque<std::unique_ptr<Entry>> waiting;
+    std::unique_ptr<Entry> running;
+    std::vector<std::unique_ptr<Entry>> finished;
+
+    std::mutex mutex;
+    std::condition_variable wakeUp, done;
+    bool stop{};
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    std::thread worker;
+    #endif
+};
+
+namespace {
+
+typedef std::unique_lock<std::mutex> Lock;
+
+template<class T> UnsignedInt enqueueData(AsyncImporter& async, Containers::Optional<T>(AbstractImporter::*function)(UnsignedInt), const UnsignedInt id, std::function<void(Containers::Optional<T>&&)>&& completion) {
+    std::shared_ptr<Containers::Optional<T>> result{new Containers::Optional<T>};
+    return async.enqueue([function, id, result](AbstractImporter& importer, AsyncImporter::JobContext&) {
+        *result = (importer.*function)(id);
+    }, [completion, result]() {
+        if(completion) completion(std::move(*result));
+    });
+}
+
+}
+
+AsyncImporter::AsyncImporter(AbstractImporter& importer): _importer(importer), _state{new State} {
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    State& state = *_state;
+    state.worker = std::thread{[&state, &importer]() {
+        std::unique_lock<std::mutex> lock{state.mutex};
+        for(;;) {
+            state.wakeUp.wait(lock, [&state]() {
+                return state.stop || !state.waiting.empty();
+            });
+            if(state.stop) return;
+
+            state.running = std::move(state.waiting.front());
+            state.waiting.pop_front();
+
+            /* The calling thread only sets the cancellation flag while the
+               job is running */
+            Entry& entry = *state.running;
+            lock.unlock();
+            entry.job(importer, entry.context);
+            entry.context._progress = 1.0f;
+            lock.lock();
+
+            state.finished.push_back(std::move(state.running));
+            state.done.notify_all();
+        }
+    }};
+    #endif
+}
+
+AsyncImporter::~AsyncImporter() {
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    {
+        std::lock_guard<std::mutex> lock{_state->mutex};
+        _state->stop = true;
+        if(_state->running) _state->running->context._cancelled = true;
+    }
+    _state->wakeUp.notify_all();
+    _state->worker.join();
+    #endif
+}
+
+std::size_t AsyncImporter::pendingCount() const { return _state->pending; }
+
+UnsignedInt AsyncImporter::enqueue(Job job, std::function<void()> completion) {
+    State& state = *_state;
+    const UnsignedInt id = state.nextId++;
+    ++state.pending;
+
+    std::unique_ptr<Entry> entry{new Entry};
+    entry->id = id;
+    entry->job = std::move(job);
+    entry->completion = std::move(completion);
+
+    {
+        Lock lock{state.mutex};
+        state.waiting.push_back(std::move(entry));
+    }
+    state.wakeUp.notify_one();
+
+    return id;
+}
+
+UnsignedInt AsyncImporter::openFile(const std::string& filename, std::function<void(bool)> completion) {
+    std::shared_ptr<bool> result{new bool{}};
+    return enqueue([filename, result](AbstractImporter& importer, JobContext&) {
+        *result = importer.openFile(filename);
+    }, [completion, result]() {
+        if(completion) completion(*result);
+    });
+}
+
+UnsignedInt AsyncImporter::scene(const UnsignedInt id, std::function<void(Containers::Optional<SceneData>&&)> completion) {
+    return enqueueData(*this, &AbstractImporter::scene, id, std::move(completion));
+}
+
+UnsignedInt AsyncImporter::mesh3D(const UnsignedInt id, std::function<void(Containers::Optional<MeshData3D>&&)> completion) {
+    return enqueueData(*this, &AbstractImporter::mesh3D, id, std::move(completion));
+}
+
+UnsignedInt AsyncImporter::image2D(const UnsignedInt id, std::function<void(Containers::Optional<ImageData2D>&&)> completion) {
+    return enqueueData(*this, &AbstractImporter::image2D, id, std::move(completion));
+}
+
+Float AsyncImporter::progress(const UnsignedInt id) const {
+    Lock lock{_state->mutex};
+    for(const std::unique_ptr<Entry>& entry: _state->waiting)
+        if(entry->id == id) return 0.0f;
+    if(_state->running && _state->running->id == id)
+        return _state->running->context._progress;
+    return 1.0f;
+}
+
+bool AsyncImporter::cancel(const UnsignedInt id) {
+    State& state = *_state;
+    Lock lock{state.mutex};
+
+    /* Waiting jobs are simply removed */
+    for(auto it = state.waiting.begin(); it != state.waiting.end(); ++it) {
+        if((*it)->id != id) continue;
+        state.waiting.erase(it);
+        --state.pending;
+        return true;
+    }
+
+    /* Running and finished jobs are marked and then dropped in update() */
+    Entry* entry = nullptr;
+    if(state.running && state.running->id == id)
+        entry = state.running.get();
+    else for(const std::unique_ptr<Entry>& finished: state.finished)
+        if(finished->id == id) entry = finished.get();
+    if(!entry || entry->context._cancelled) return false;
+
+    entry->context._cancelled = true;
+    --state.pending;
+    return true;
+}
+
+std::vector<UnsignedInt> AsyncImporter::update() {
+    State& state = *_state;
+
+    /* Without threads execute one waiting job here */
+    #ifdef CORRADE_TARGET_EMSCRIPTEN
+    if(!state.waiting.empty()) {
+        state.running = std::move(state.waiting.front());
+        state.waiting.pop_front();
+        state.running->job(_importer, state.running->context);
+        state.running->context._progress = 1.0f;
+        state.finished.push_back(std::move(state.running));
+    }
+    #endif
+
+    std::vector<std::unique_ptr<Entry>> finished;
+    {
+        Lock lock{state.mutex};
+        std::swap(finished, state.finished);
+    }
+
+    /* The callbacks may enqueue new jobs, so they're called without the lock
+       held */
+    std::vector<UnsignedInt> completed;
+    for(const std::unique_ptr<Entry>& entry: finished) {
+        if(entry->context._cancelled) continue;
+
+        --state.pending;
+        completed.push_back(entry->id);
+        if(entry->completion) entry->completion();
+    }
+
+    return completed;
+}
+
+std::vector<UnsignedInt> AsyncImporter::finish() {
+    State& state = *_state;
+    std::vector<UnsignedInt> completed;
+
+    for(;;) {
+        const std::vector<UnsignedInt> current = update();
+        completed.insert(completed.end(), current.begin(), current.end());
+
+        Lock lock{state.mutex};
+        if(state.waiting.empty() && !state.running && state.finished.empty())
+            break;
+
+        #ifndef CORRADE_TARGET_EMSCRIPTEN
+        state.done.wait(lock, [&state]() { return !state.finished.empty(); });
+        #endif
+    }
+
+    return completed;
+}
+
+}}
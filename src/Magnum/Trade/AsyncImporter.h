@@ -0,0 +1,275 @@
+#ifndef Magnum_Trade_AsyncImporter_h
+#define Magnum_Trade_AsyncImporter_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Trade::AsyncImporter, @ref Magnum::Trade::AsyncImporter::JobContext
+ */
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include <Corrade/Containers/Optional.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Trade/Trade.h"
+#include "Magnum/Trade/visibility.h"
+
+namespace Magnum { namespace Trade {
+
+/**
+@brief Asynchronous importer
+
+Runs import jobs on an existing @ref AbstractImporter instance on a worker
+thread, so the calling thread doesn't block while the files are parsed. Each
+job gets an ID and an optional completion callback. The callbacks are called
+from @ref update() on the thread that enqueued the jobs, once the job is done:
+
+@code{.cpp}
+std::unique_ptr<Trade::AbstractImporter> importer = manager.instantiate("AnySceneImporter");
+Trade::AsyncImporter async{*importer};
+
+async.openFile("level.obj");
+async.mesh3D(0, [&](Containers::Optional<Trade::MeshData3D>&& mesh) {
+    // add the mesh to the scene ...
+});
+
+// in the main loop
+async.update();
+@endcode
+
+The jobs are executed in the order they were enqueued, so a job can depend on
+the importer state left by previous jobs, such as the file opened by
+@ref openFile(). Custom jobs can be enqueued with @ref enqueue(), they get a
+@ref JobContext through which they can report progress and check for
+cancellation.
+
+@section Trade-AsyncImporter-cancellation Progress and cancellation
+
+Progress of a particular job can be queried using @ref progress(). The jobs
+created with @ref openFile(), @ref scene(), @ref mesh3D() and @ref image2D()
+report only start and end, as importer plugins don't provide finer progress
+information. A job can be cancelled using @ref cancel(). If it's still waiting
+in the queue, it's removed and never executed. If it's already running, it
+runs until the job function returns (custom jobs can return early by checking
+@ref JobContext::isCancelled()) and its result is discarded without calling
+the completion callback. Cancelling a running @ref openFile() job thus still
+leaves the file opened in the importer.
+
+@section Trade-AsyncImporter-threading Threading
+
+All functions have to be called from the same thread, only the job functions
+are executed on the worker thread. The importer is accessed from the worker
+thread and thus it must not be used directly for as long as there are any
+jobs enqueued --- call @ref finish() before doing so. On platforms without
+thread support (such as @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten") each
+@ref update() call executes one waiting job on the calling thread.
+@see @ref TextureUploadQueue
+*/
+class MAGNUM_TRADE_EXPORT AsyncImporter {
+    public:
+        class JobContext;
+
+        /**
+         * @brief Job function
+         *
+         * Called on the worker thread with the importer and the job context.
+         */
+        typedef std::function<void(AbstractImporter&, JobContext&)> Job;
+
+        /**
+         * @brief Constructor
+         * @param importer      Importer to run the jobs on
+         *
+         * Spawns the worker thread. The importer is expected to stay alive
+         * for the whole lifetime of this instance.
+         */
+        explicit AsyncImporter(AbstractImporter& importer);
+
+        /** @brief Copying is not allowed */
+        AsyncImporter(const AsyncImporter&) = delete;
+
+        /** @brief Moving is not allowed */
+        AsyncImporter(AsyncImporter&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Cancels all jobs, waits for the currently running job to finish and
+         * stops the worker thread. No completion callbacks are called.
+         */
+        ~AsyncImporter();
+
+        /** @brief Copying is not allowed */
+        AsyncImporter& operator=(const AsyncImporter&) = delete;
+
+        /** @brief Moving is not allowed */
+        AsyncImporter& operator=(AsyncImporter&&) = delete;
+
+        /** @brief Importer the jobs are run on */
+        AbstractImporter& importer() { return _importer; }
+
+        /**
+         * @brief Count of pending jobs
+         *
+         * Jobs that were enqueued but not yet reported as complete by
+         * @ref update() or @ref finish() and weren't cancelled.
+         */
+        std::size_t pendingCount() const;
+
+        /**
+         * @brief Enqueue a custom job
+         * @param job           Job function
+         * @param completion    Function called from @ref update() after
+         *      the job is done. Can be empty.
+         * @return Job ID, unique for the lifetime of the instance
+         */
+        UnsignedInt enqueue(Job job, std::function<void()> completion = {});
+
+        /**
+         * @brief Enqueue opening a file
+         *
+         * Calls @ref AbstractImporter::openFile() on the worker thread and
+         * passes its result to @p completion.
+         */
+        UnsignedInt openFile(const std::string& filename, std::function<void(bool)> completion = {});
+
+        /**
+         * @brief Enqueue importing a scene
+         *
+         * Calls @ref AbstractImporter::scene() on the worker thread and
+         * passes its result to @p completion.
+         */
+        UnsignedInt scene(UnsignedInt id, std::function<void(Containers::Optional<SceneData>&&)> completion);
+
+        /**
+         * @brief Enqueue importing a three-dimensional mesh
+         *
+         * Calls @ref AbstractImporter::mesh3D() on the worker thread and
+         * passes its result to @p completion.
+         */
+        UnsignedInt mesh3D(UnsignedInt id, std::function<void(Containers::Optional<MeshData3D>&&)> completion);
+
+        /**
+         * @brief Enqueue importing a two-dimensional image
+         *
+         * Calls @ref AbstractImporter::image2D() on the worker thread and
+         * passes its result to @p completion.
+         */
+        UnsignedInt image2D(UnsignedInt id, std::function<void(Containers::Optional<ImageData2D>&&)> completion);
+
+        /**
+         * @brief Job progress
+         *
+         * Returns @cpp 0.0f @ce for jobs waiting in the queue, progress
+         * reported through @ref JobContext::setProgress() for the running
+         * job and @cpp 1.0f @ce for finished, reported, cancelled or unknown
+         * jobs.
+         */
+        Float progress(UnsignedInt id) const;
+
+        /**
+         * @brief Cancel a job
+         *
+         * Returns @cpp true @ce if the job was waiting or running, its
+         * completion callback won't be called and it's not counted in
+         * @ref pendingCount() anymore. Returns @cpp false @ce if the job was
+         * already reported as complete, cancelled or is unknown. See
+         * @ref Trade-AsyncImporter-cancellation for more information.
+         */
+        bool cancel(UnsignedInt id);
+
+        /**
+         * @brief Report finished jobs
+         *
+         * Calls completion callbacks of jobs that finished since the last
+         * call and returns their IDs in the order they were executed. Doesn't
+         * block.
+         */
+        std::vector<UnsignedInt> update();
+
+        /**
+         * @brief Finish all jobs
+         *
+         * Calls @ref update() until all jobs are done, including cancelled
+         * jobs that are still running, and returns IDs of all jobs that
+         * were reported as complete. After this function returns, the
+         * importer can be safely used directly.
+         */
+        std::vector<UnsignedInt> finish();
+
+    private:
+        struct Entry;
+        struct State;
+
+        AbstractImporter& _importer;
+        std::unique_ptr<State> _state;
+};
+
+/**
+@brief Job context
+
+Passed to @ref AsyncImporter::Job functions on the worker thread.
+*/
+class AsyncImporter::JobContext {
+    public:
+        /** @brief Constructor */
+        explicit JobContext() = default;
+
+        /** @brief Copying is not allowed */
+        JobContext(const JobContext&) = delete;
+
+        /** @brief Copying is not allowed */
+        JobContext& operator=(const JobContext&) = delete;
+
+        /**
+         * @brief Set job progress
+         *
+         * Expected to be in range @f$ [0, 1] @f$, queryable through
+         * @ref AsyncImporter::progress().
+         */
+        void setProgress(Float progress) { _progress = progress; }
+
+        /**
+         * @brief Whether the job was cancelled
+         *
+         * Long-running jobs are encouraged to check this periodically and
+         * return early if set, as their result is discarded anyway.
+         */
+        bool isCancelled() const { return _cancelled; }
+
+    private:
+        friend AsyncImporter;
+
+        std::atomic<Float> _progress{0.0f};
+        std::atomic<bool> _cancelled{false};
+};
+
+}}
+
+#endif
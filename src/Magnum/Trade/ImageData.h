@@ -49,6 +49,11 @@ property and are convertible to @ref CompressedImageView.
 Uncompressed image is interchangeable with @ref Image, @ref ImageView or
 @ref BufferImage, compressed with @ref CompressedImage, @ref CompressedImageView
 or @ref CompressedBufferImage.
+
+The data array can have a custom deleter, which allows the importers to return
+images referencing memory passed to @ref AbstractImporter::openMemory() without
+copying them. See @ref AbstractImporter::nonOwnedArray() and documentation of
+particular importer plugins for more information.
 @see @ref ImageData1D, @ref ImageData2D, @ref ImageData3D
 */
 template<UnsignedInt dimensions> class ImageData {
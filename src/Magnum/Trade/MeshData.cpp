@@ -0,0 +1,229 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MeshData.h"
+
+#include <cstring>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Math/Color.h"
+#include "Magnum/Trade/MeshData2D.h"
+#include "Magnum/Trade/MeshData3D.h"
+
+namespace Magnum { namespace Trade {
+
+namespace {
+
+/* Copies an attribute array into interleaved vertex data */
+template<class T> void interleaveInto(Containers::Array<char>& data, const std::vector<T>& in, const std::size_t offset, const std::size_t stride) {
+    for(std::size_t i = 0; i != in.size(); ++i)
+        std::memcpy(data + offset + i*stride, &in[i], sizeof(T));
+}
+
+Containers::Array<char> copyIndices(const std::vector<UnsignedInt>& indices) {
+    Containers::Array<char> out{indices.size()*sizeof(UnsignedInt)};
+    if(!indices.empty()) std::memcpy(out, indices.data(), out.size());
+    return out;
+}
+
+}
+
+std::size_t MeshAttributeData::size() const {
+    std::size_t components = UnsignedInt(_components);
+    #ifndef MAGNUM_TARGET_GLES
+    if(_components == DynamicAttribute::Components::BGRA)
+        components = 4;
+    #endif
+
+    switch(_dataType) {
+        case DynamicAttribute::DataType::UnsignedByte:
+        case DynamicAttribute::DataType::Byte:
+            return components;
+        case DynamicAttribute::DataType::UnsignedShort:
+        case DynamicAttribute::DataType::Short:
+        #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+        case DynamicAttribute::DataType::HalfFloat:
+        #endif
+            return 2*components;
+        case DynamicAttribute::DataType::UnsignedInt:
+        case DynamicAttribute::DataType::Int:
+        case DynamicAttribute::DataType::Float:
+            return 4*components;
+        #ifndef MAGNUM_TARGET_GLES
+        case DynamicAttribute::DataType::Double:
+            return 8*components;
+        case DynamicAttribute::DataType::UnsignedInt10f11f11fRev:
+        #endif
+        #ifndef MAGNUM_TARGET_GLES2
+        case DynamicAttribute::DataType::UnsignedInt2101010Rev:
+        case DynamicAttribute::DataType::Int2101010Rev:
+        #endif
+            return 4;
+    }
+
+    return 0;
+}
+
+MeshData::MeshData(const MeshPrimitive primitive, Containers::Array<char>&& indexData, const Mesh::IndexType indexType, Containers::Array<char>&& vertexData, std::vector<MeshAttributeData> attributes, const UnsignedInt vertexCount, const void* const importerState): _primitive{primitive}, _indexType{indexType}, _vertexCount{vertexCount}, _indexData{std::move(indexData)}, _vertexData{std::move(vertexData)}, _attributes{std::move(attributes)}, _importerState{importerState} {
+    CORRADE_ASSERT(_indexData.empty() || _indexData.size() % Mesh::indexSize(indexType) == 0,
+        "Trade::MeshData: index data size" << _indexData.size() << "is not divisible by size of" << indexType, );
+    #ifndef CORRADE_NO_ASSERT
+    for(std::size_t i = 0; i != _attributes.size(); ++i) {
+        const MeshAttributeData& attribute = _attributes[i];
+        CORRADE_ASSERT(!vertexCount || attribute.offset() + (vertexCount - 1)*attribute.stride() + attribute.size() <= _vertexData.size(),
+            "Trade::MeshData: attribute" << i << "doesn't fit into" << _vertexData.size() << "bytes of vertex data", );
+    }
+    #endif
+}
+
+MeshData::MeshData(const MeshData2D& other): MeshData{other.primitive(), copyIndices(other.isIndexed() ? other.indices() : std::vector<UnsignedInt>{}), Mesh::IndexType::UnsignedInt, nullptr, {}, UnsignedInt(other.positions(0).size()), other.importerState()} {
+    std::size_t stride = sizeof(Vector2);
+    if(other.hasTextureCoords2D()) stride += sizeof(Vector2);
+    if(other.hasColors()) stride += sizeof(Color4);
+
+    _vertexData = Containers::Array<char>{Containers::ValueInit, _vertexCount*stride};
+    std::size_t offset = 0;
+    _attributes.emplace_back(MeshAttributeName::Position,
+        DynamicAttribute::Kind::Generic, DynamicAttribute::Components::Two,
+        DynamicAttribute::DataType::Float, offset, stride);
+    interleaveInto(_vertexData, other.positions(0), offset, stride);
+    offset += sizeof(Vector2);
+
+    if(other.hasTextureCoords2D()) {
+        _attributes.emplace_back(MeshAttributeName::TextureCoordinates,
+            DynamicAttribute::Kind::Generic, DynamicAttribute::Components::Two,
+            DynamicAttribute::DataType::Float, offset, stride);
+        interleaveInto(_vertexData, other.textureCoords2D(0), offset, stride);
+        offset += sizeof(Vector2);
+    }
+
+    if(other.hasColors()) {
+        _attributes.emplace_back(MeshAttributeName::Color,
+            DynamicAttribute::Kind::Generic, DynamicAttribute::Components::Four,
+            DynamicAttribute::DataType::Float, offset, stride);
+        interleaveInto(_vertexData, other.colors(0), offset, stride);
+    }
+}
+
+MeshData::MeshData(const MeshData3D& other): MeshData{other.primitive(), copyIndices(other.isIndexed() ? other.indices() : std::vector<UnsignedInt>{}), Mesh::IndexType::UnsignedInt, nullptr, {}, UnsignedInt(other.positions(0).size()), other.importerState()} {
+    std::size_t stride = sizeof(Vector3);
+    if(other.hasNormals()) stride += sizeof(Vector3);
+    if(other.hasTextureCoords2D()) stride += sizeof(Vector2);
+    if(other.hasColors()) stride += sizeof(Color4);
+
+    _vertexData = Containers::Array<char>{Containers::ValueInit, _vertexCount*stride};
+    std::size_t offset = 0;
+    _attributes.emplace_back(MeshAttributeName::Position,
+        DynamicAttribute::Kind::Generic, DynamicAttribute::Components::Three,
+        DynamicAttribute::DataType::Float, offset, stride);
+    interleaveInto(_vertexData, other.positions(0), offset, stride);
+    offset += sizeof(Vector3);
+
+    if(other.hasNormals()) {
+        _attributes.emplace_back(MeshAttributeName::Normal,
+            DynamicAttribute::Kind::Generic, DynamicAttribute::Components::Three,
+            DynamicAttribute::DataType::Float, offset, stride);
+        interleaveInto(_vertexData, other.normals(0), offset, stride);
+        offset += sizeof(Vector3);
+    }
+
+    if(other.hasTextureCoords2D()) {
+        _attributes.emplace_back(MeshAttributeName::TextureCoordinates,
+            DynamicAttribute::Kind::Generic, DynamicAttribute::Components::Two,
+            DynamicAttribute::DataType::Float, offset, stride);
+        interleaveInto(_vertexData, other.textureCoords2D(0), offset, stride);
+        offset += sizeof(Vector2);
+    }
+
+    if(other.hasColors()) {
+        _attributes.emplace_back(MeshAttributeName::Color,
+            DynamicAttribute::Kind::Generic, DynamicAttribute::Components::Four,
+            DynamicAttribute::DataType::Float, offset, stride);
+        interleaveInto(_vertexData, other.colors(0), offset, stride);
+    }
+}
+
+MeshData::MeshData(MeshData&&) noexcept = default;
+
+MeshData::~MeshData() = default;
+
+MeshData& MeshData::operator=(MeshData&&) noexcept = default;
+
+Mesh::IndexType MeshData::indexType() const {
+    CORRADE_ASSERT(isIndexed(), "Trade::MeshData::indexType(): the mesh is not indexed", {});
+    return _indexType;
+}
+
+UnsignedInt MeshData::indexCount() const {
+    return isIndexed() ? _indexData.size()/Mesh::indexSize(_indexType) : 0;
+}
+
+std::vector<UnsignedInt> MeshData::indices() const {
+    CORRADE_ASSERT(isIndexed(), "Trade::MeshData::indices(): the mesh is not indexed", {});
+
+    std::vector<UnsignedInt> out(indexCount());
+    for(std::size_t i = 0; i != out.size(); ++i) switch(_indexType) {
+        case Mesh::IndexType::UnsignedByte:
+            out[i] = reinterpret_cast<const UnsignedByte*>(_indexData.data())[i];
+            break;
+        case Mesh::IndexType::UnsignedShort:
+            out[i] = reinterpret_cast<const UnsignedShort*>(_indexData.data())[i];
+            break;
+        case Mesh::IndexType::UnsignedInt:
+            out[i] = reinterpret_cast<const UnsignedInt*>(_indexData.data())[i];
+            break;
+    }
+
+    return out;
+}
+
+const MeshAttributeData& MeshData::attribute(const UnsignedInt id) const {
+    CORRADE_ASSERT(id < _attributes.size(), "Trade::MeshData::attribute(): index" << id << "out of range for" << _attributes.size() << "attributes", _attributes[0]);
+    return _attributes[id];
+}
+
+Int MeshData::attributeId(const MeshAttributeName name) const {
+    for(std::size_t i = 0; i != _attributes.size(); ++i)
+        if(_attributes[i].name() == name) return i;
+    return -1;
+}
+
+Debug& operator<<(Debug& debug, const MeshAttributeName value) {
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case MeshAttributeName::value: return debug << "Trade::MeshAttributeName::" #value;
+        _c(Position)
+        _c(Normal)
+        _c(TextureCoordinates)
+        _c(Color)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "Trade::MeshAttributeName(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
+}
+
+}}
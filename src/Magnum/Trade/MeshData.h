@@ -0,0 +1,279 @@
+#ifndef Magnum_Trade_MeshData_h
+#define Magnum_Trade_MeshData_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Trade::MeshData, @ref Magnum::Trade::MeshAttributeData, enum @ref Magnum::Trade::MeshAttributeName
+ */
+
+#include <vector>
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Mesh.h"
+#include "Magnum/Trade/Trade.h"
+#include "Magnum/Trade/visibility.h"
+
+namespace Magnum { namespace Trade {
+
+/**
+@brief Mesh attribute name
+
+@see @ref MeshAttributeData
+*/
+enum class MeshAttributeName: UnsignedByte {
+    /** Position, bound to @ref Shaders::Generic::Position */
+    Position,
+
+    /** Normal, bound to @ref Shaders::Generic::Normal */
+    Normal,
+
+    /**
+     * Texture coordinates, bound to
+     * @ref Shaders::Generic::TextureCoordinates
+     */
+    TextureCoordinates,
+
+    /** Vertex color, bound to @ref Shaders::Generic::Color */
+    Color
+};
+
+/** @debugoperatorenum{Magnum::Trade::MeshAttributeName} */
+MAGNUM_TRADE_EXPORT Debug& operator<<(Debug& debug, MeshAttributeName value);
+
+/**
+@brief Mesh attribute data
+
+Describes location of one attribute in the vertex data of @ref MeshData. The
+attribute data type is described the same way as in @ref DynamicAttribute, so
+it can be passed to @ref Mesh::addVertexBuffer() without any conversion.
+*/
+class MAGNUM_TRADE_EXPORT MeshAttributeData {
+    public:
+        /**
+         * @brief Constructor
+         * @param name          Attribute name
+         * @param kind          Attribute kind
+         * @param components    Component count
+         * @param dataType      Component data type
+         * @param offset        Offset of the first element in the vertex
+         *      data
+         * @param stride        Distance between the elements in bytes
+         */
+        constexpr explicit MeshAttributeData(MeshAttributeName name, DynamicAttribute::Kind kind, DynamicAttribute::Components components, DynamicAttribute::DataType dataType, std::size_t offset, std::size_t stride) noexcept: _name{name}, _kind{kind}, _components{components}, _dataType{dataType}, _offset{offset}, _stride{stride} {}
+
+        /** @brief Attribute name */
+        constexpr MeshAttributeName name() const { return _name; }
+
+        /** @brief Attribute kind */
+        constexpr DynamicAttribute::Kind kind() const { return _kind; }
+
+        /** @brief Component count */
+        constexpr DynamicAttribute::Components components() const { return _components; }
+
+        /** @brief Component data type */
+        constexpr DynamicAttribute::DataType dataType() const { return _dataType; }
+
+        /** @brief Offset of the first element in the vertex data */
+        constexpr std::size_t offset() const { return _offset; }
+
+        /** @brief Distance between the elements in bytes */
+        constexpr std::size_t stride() const { return _stride; }
+
+        /**
+         * @brief Size of one element in bytes
+         *
+         * Calculated from @ref components() and @ref dataType(). Returns
+         * @cpp 0 @ce if the data type is not known, which can be used for
+         * validating attribute descriptions coming from untrusted sources.
+         */
+        std::size_t size() const;
+
+    private:
+        MeshAttributeName _name;
+        DynamicAttribute::Kind _kind;
+        DynamicAttribute::Components _components;
+        DynamicAttribute::DataType _dataType;
+        std::size_t _offset, _stride;
+};
+
+/**
+@brief Mesh data
+
+Unlike @ref MeshData2D and @ref MeshData3D, which store each attribute in a
+separate @ref std::vector of 32-bit floats, the vertex data of all attributes
+are in a single contiguous array and the index data in another one. The
+attributes can have arbitrary types and can be interleaved or planar, their
+layout is described by a list of @ref MeshAttributeData. The data can thus be
+uploaded to a @ref Buffer with a single @ref Buffer::setData() call without
+any conversion, see @ref MeshTools::compile(const Trade::MeshData&, BufferUsage).
+
+@code{.cpp}
+struct Vertex {
+    Vector3 position;
+    Math::Vector2<UnsignedShort> textureCoordinates;
+};
+Containers::Array<char> vertexData{vertexCount*sizeof(Vertex)};
+// fill the data ...
+
+Trade::MeshData data{MeshPrimitive::Triangles, nullptr, {},
+    std::move(vertexData), {
+        Trade::MeshAttributeData{Trade::MeshAttributeName::Position,
+            DynamicAttribute::Kind::Generic,
+            DynamicAttribute::Components::Three,
+            DynamicAttribute::DataType::Float,
+            offsetof(Vertex, position), sizeof(Vertex)},
+        Trade::MeshAttributeData{Trade::MeshAttributeName::TextureCoordinates,
+            DynamicAttribute::Kind::GenericNormalized,
+            DynamicAttribute::Components::Two,
+            DynamicAttribute::DataType::UnsignedShort,
+            offsetof(Vertex, textureCoordinates), sizeof(Vertex)}
+    }, vertexCount};
+@endcode
+
+Existing @ref MeshData2D and @ref MeshData3D can be converted using
+@ref MeshData(const MeshData2D&) and @ref MeshData(const MeshData3D&).
+*/
+class MAGNUM_TRADE_EXPORT MeshData {
+    public:
+        /**
+         * @brief Constructor
+         * @param primitive     Primitive
+         * @param indexData     Index data. If empty, the mesh is not
+         *      indexed.
+         * @param indexType     Index type. Ignored if @p indexData is
+         *      empty.
+         * @param vertexData    Vertex data
+         * @param attributes    Description of attributes in @p vertexData
+         * @param vertexCount   Vertex count
+         * @param importerState Importer-specific state
+         *
+         * Expects that the index data size is divisible by size of
+         * @p indexType and that all attributes fit into @p vertexData.
+         */
+        explicit MeshData(MeshPrimitive primitive, Containers::Array<char>&& indexData, Mesh::IndexType indexType, Containers::Array<char>&& vertexData, std::vector<MeshAttributeData> attributes, UnsignedInt vertexCount, const void* importerState = nullptr);
+
+        /**
+         * @brief Construct from two-dimensional mesh data
+         *
+         * Interleaves the first position, texture coordinate and color array
+         * of @p other as 32-bit floats and copies the indices as
+         * @ref Mesh::IndexType::UnsignedInt.
+         */
+        explicit MeshData(const MeshData2D& other);
+
+        /**
+         * @brief Construct from three-dimensional mesh data
+         *
+         * Interleaves the first position, normal, texture coordinate and
+         * color array of @p other as 32-bit floats and copies the indices as
+         * @ref Mesh::IndexType::UnsignedInt.
+         */
+        explicit MeshData(const MeshData3D& other);
+
+        /** @brief Copying is not allowed */
+        MeshData(const MeshData&) = delete;
+
+        /** @brief Move constructor */
+        MeshData(MeshData&&) noexcept;
+
+        ~MeshData();
+
+        /** @brief Copying is not allowed */
+        MeshData& operator=(const MeshData&) = delete;
+
+        /** @brief Move assignment */
+        MeshData& operator=(MeshData&&) noexcept;
+
+        /** @brief Primitive */
+        MeshPrimitive primitive() const { return _primitive; }
+
+        /** @brief Whether the mesh is indexed */
+        bool isIndexed() const { return !_indexData.empty(); }
+
+        /**
+         * @brief Index type
+         *
+         * Expects that the mesh is indexed.
+         */
+        Mesh::IndexType indexType() const;
+
+        /** @brief Index count */
+        UnsignedInt indexCount() const;
+
+        /** @brief Raw index data */
+        Containers::ArrayView<const char> indexData() const { return _indexData; }
+
+        /**
+         * @brief Indices as 32-bit integers
+         *
+         * Expects that the mesh is indexed. Converts the indices from
+         * @ref indexType() to @ref UnsignedInt.
+         */
+        std::vector<UnsignedInt> indices() const;
+
+        /** @brief Vertex count */
+        UnsignedInt vertexCount() const { return _vertexCount; }
+
+        /** @brief Raw vertex data */
+        Containers::ArrayView<char> vertexData() { return _vertexData; }
+        Containers::ArrayView<const char> vertexData() const { return _vertexData; } /**< @overload */
+
+        /** @brief Attribute count */
+        UnsignedInt attributeCount() const { return _attributes.size(); }
+
+        /** @brief Attribute description */
+        const MeshAttributeData& attribute(UnsignedInt id) const;
+
+        /**
+         * @brief ID of a named attribute
+         *
+         * Returns ID of the first attribute with given @p name or
+         * @cpp -1 @ce if there's no such attribute.
+         */
+        Int attributeId(MeshAttributeName name) const;
+
+        /** @brief Whether the mesh has given attribute */
+        bool hasAttribute(MeshAttributeName name) const { return attributeId(name) != -1; }
+
+        /**
+         * @brief Importer-specific state
+         *
+         * See @ref AbstractImporter::importerState() for more information.
+         */
+        const void* importerState() const { return _importerState; }
+
+    private:
+        MeshPrimitive _primitive;
+        Mesh::IndexType _indexType;
+        UnsignedInt _vertexCount;
+        Containers::Array<char> _indexData, _vertexData;
+        std::vector<MeshAttributeData> _attributes;
+        const void* _importerState;
+};
+
+}}
+
+#endif
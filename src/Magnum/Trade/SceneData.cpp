@@ -25,9 +25,22 @@
 
 #include "SceneData.h"
 
+#include <Corrade/Utility/Assert.h>
+
 namespace Magnum { namespace Trade {
 
-SceneData::SceneData(std::vector<UnsignedInt> children2D, std::vector<UnsignedInt> children3D, const void* const importerState): _children2D{std::move(children2D)}, _children3D{std::move(children3D)}, _importerState{importerState} {}
+SceneData::SceneData(std::vector<UnsignedInt> children2D, std::vector<UnsignedInt> children3D, const void* const importerState): _children2D{std::move(children2D)}, _children3D{std::move(children3D)}, _flat3D{false}, _importerState{importerState} {}
+
+SceneData::SceneData(std::vector<UnsignedInt> children2D, std::vector<UnsignedInt> objects3D, std::vector<Int> parents3D, std::vector<Matrix4> transformations3D, std::vector<Int> meshes3D, std::vector<Int> materials3D, const void* const importerState): _children2D{std::move(children2D)}, _objects3D{std::move(objects3D)}, _parents3D{std::move(parents3D)}, _transformations3D{std::move(transformations3D)}, _meshes3D{std::move(meshes3D)}, _materials3D{std::move(materials3D)}, _flat3D{true}, _importerState{importerState} {
+    CORRADE_ASSERT(_parents3D.size() == _objects3D.size() && _transformations3D.size() == _objects3D.size() && _meshes3D.size() == _objects3D.size() && _materials3D.size() == _objects3D.size(),
+        "Trade::SceneData: expected" << _objects3D.size() << "items in all 3D arrays but got" << _parents3D.size() << _transformations3D.size() << _meshes3D.size() << _materials3D.size(), );
+
+    for(std::size_t i = 0; i != _parents3D.size(); ++i) {
+        CORRADE_ASSERT(_parents3D[i] < Int(i),
+            "Trade::SceneData: parent" << _parents3D[i] << "of object" << i << "is not stored before it", );
+        if(_parents3D[i] < 0) _children3D.push_back(_objects3D[i]);
+    }
+}
 
 SceneData::SceneData(SceneData&&)
     #if !defined(__GNUC__) || __GNUC__*100 + __GNUC_MINOR__ != 409
@@ -32,13 +32,44 @@
 #include <string>
 #include <vector>
 
-#include "Magnum/Types.h"
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Matrix4.h"
 #include "Magnum/Trade/visibility.h"
 
 namespace Magnum { namespace Trade {
 
 /**
 @brief Scene data
+
+Either lists only IDs of top-level objects, which are then fetched one by one
+through @ref AbstractImporter::object2D() and @ref AbstractImporter::object3D(),
+or additionally contains the whole 3D hierarchy in flat arrays.
+
+@section Trade-SceneData-flat Flat 3D scene representation
+
+Scenes created with the @ref SceneData(std::vector<UnsignedInt>, std::vector<UnsignedInt>, std::vector<Int>, std::vector<Matrix4>, std::vector<Int>, std::vector<Int>, const void*)
+constructor describe all 3D objects with a set of arrays of the same size
+instead of a tree of @ref ObjectData3D instances. For an object at index
+@cpp i @ce, @ref objects3D() contains its ID,
+@ref parents3D() index of its parent in the same arrays or @cpp -1 @ce for
+top-level objects, @ref transformations3D() its transformation relative to
+the parent and @ref meshes3D() together with @ref materials3D() the mesh and
+material ID or @cpp -1 @ce if the object has no mesh or material. Every parent
+is stored before all its children, so the whole scene can be instantiated in a
+single pass over the arrays without any additional importer calls. If the
+objects are moreover in depth-first order, creating them in the same order
+with the array constructor of @ref SceneGraph::FlatHierarchy results in a hierarchy where object at index @cpp i @ce of the arrays is at
+index @cpp i + 1 @ce:
+
+@code{.cpp}
+Containers::Optional<Trade::SceneData> data = importer.scene(0);
+if(data->hasFlatObjects3D()) {
+    Scene3D scene;
+    SceneGraph::FlatHierarchy<SceneGraph::MatrixTransformation3D> hierarchy{
+        scene, data->parents3D(), data->transformations3D()};
+    // attach drawables to hierarchy.object(i + 1) based on data->meshes3D()[i]
+}
+@endcode
 */
 class MAGNUM_TRADE_EXPORT SceneData {
     public:
@@ -50,6 +81,24 @@ class MAGNUM_TRADE_EXPORT SceneData {
          */
         explicit SceneData(std::vector<UnsignedInt> children2D, std::vector<UnsignedInt> children3D, const void* importerState = nullptr);
 
+        /**
+         * @brief Construct with a flat 3D hierarchy
+         * @param children2D        Two-dimensional child objects
+         * @param objects3D         Three-dimensional object IDs
+         * @param parents3D         Parent indices into @p objects3D or
+         *      @cpp -1 @ce for top-level objects
+         * @param transformations3D Transformations relative to parents
+         * @param meshes3D          Mesh IDs or @cpp -1 @ce
+         * @param materials3D       Material IDs or @cpp -1 @ce
+         * @param importerState     Importer-specific state
+         *
+         * All 3D arrays are expected to have the same size and every parent
+         * index is expected to be smaller than index of the object itself.
+         * The @ref children3D() list is populated from objects without a
+         * parent. See @ref Trade-SceneData-flat for more information.
+         */
+        explicit SceneData(std::vector<UnsignedInt> children2D, std::vector<UnsignedInt> objects3D, std::vector<Int> parents3D, std::vector<Matrix4> transformations3D, std::vector<Int> meshes3D, std::vector<Int> materials3D, const void* importerState = nullptr);
+
         /** @brief Copying is not allowed */
         SceneData(const SceneData&) = delete;
 
@@ -82,6 +131,55 @@ class MAGNUM_TRADE_EXPORT SceneData {
         /** @brief Three-dimensional child objects */
         const std::vector<UnsignedInt>& children3D() const { return _children3D; }
 
+        /**
+         * @brief Whether the scene contains a flat 3D hierarchy
+         *
+         * Returns @cpp true @ce if the scene was created with the flat
+         * constructor, even if it contains no objects.
+         * @see @ref Trade-SceneData-flat
+         */
+        bool hasFlatObjects3D() const { return _flat3D; }
+
+        /**
+         * @brief Three-dimensional object IDs
+         *
+         * Empty if @ref hasFlatObjects3D() is @cpp false @ce.
+         * @see @ref AbstractImporter::object3DName()
+         */
+        const std::vector<UnsignedInt>& objects3D() const { return _objects3D; }
+
+        /**
+         * @brief Parent indices of three-dimensional objects
+         *
+         * Indices into @ref objects3D(), @cpp -1 @ce for top-level objects.
+         * Empty if @ref hasFlatObjects3D() is @cpp false @ce.
+         */
+        const std::vector<Int>& parents3D() const { return _parents3D; }
+
+        /**
+         * @brief Transformations of three-dimensional objects
+         *
+         * Relative to parent. Empty if @ref hasFlatObjects3D() is
+         * @cpp false @ce.
+         */
+        const std::vector<Matrix4>& transformations3D() const { return _transformations3D; }
+
+        /**
+         * @brief Mesh IDs of three-dimensional objects
+         *
+         * @cpp -1 @ce for objects without a mesh. Empty if
+         * @ref hasFlatObjects3D() is @cpp false @ce.
+         */
+        const std::vector<Int>& meshes3D() const { return _meshes3D; }
+
+        /**
+         * @brief Material IDs of three-dimensional objects
+         *
+         * @cpp -1 @ce for objects without a material. Empty if
+         * @ref hasFlatObjects3D() is @cpp false @ce.
+         */
+        const std::vector<Int>& materials3D() const { return _materials3D; }
+
         /**
          * @brief Importer-specific state
          *
@@ -91,7 +189,13 @@ class MAGNUM_TRADE_EXPORT SceneData {
 
     private:
         std::vector<UnsignedInt> _children2D,
-            _children3D;
+            _children3D,
+            _objects3D;
+        std::vector<Int> _parents3D;
+        std::vector<Matrix4> _transformations3D;
+        std::vector<Int> _meshes3D,
+            _materials3D;
+        bool _flat3D;
         const void* _importerState;
 };
 
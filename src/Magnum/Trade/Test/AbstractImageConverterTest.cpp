@@ -23,6 +23,7 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <sstream>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
@@ -43,6 +44,9 @@ class AbstractImageConverterTest: public TestSuite::Tester {
         explicit AbstractImageConverterTest();
 
         void exportToFile();
+        void exportToDataStream();
+        void exportToFileStream();
+        void exportToStreamNotSupported();
 
         void exportToDataImageData();
         void exportToFileImageData();
@@ -50,6 +54,9 @@ class AbstractImageConverterTest: public TestSuite::Tester {
 
 AbstractImageConverterTest::AbstractImageConverterTest() {
     addTests({&AbstractImageConverterTest::exportToFile,
+              &AbstractImageConverterTest::exportToDataStream,
+              &AbstractImageConverterTest::exportToFileStream,
+              &AbstractImageConverterTest::exportToStreamNotSupported,
 
               &AbstractImageConverterTest::exportToDataImageData,
               &AbstractImageConverterTest::exportToFileImageData});
@@ -82,6 +89,61 @@ void AbstractImageConverterTest::exportToFile() {
 
 namespace {
 
+class StreamExporter: public Trade::AbstractImageConverter {
+    private:
+        Features doFeatures() const override { return Feature::ConvertStream; }
+
+        bool doExportToStream(const ImageView2D& image, const StreamWriter& writer) override {
+            const char header[]{'H', char(image.size().x())};
+            const char body[]{char(image.size().y()), 'E'};
+            return writer(header) && writer(body);
+        };
+};
+
+}
+
+void AbstractImageConverterTest::exportToDataStream() {
+    /* doExportToData() should concatenate output of doExportToStream() */
+    StreamExporter exporter;
+    ImageView2D image(PixelFormat::RGBA, PixelType::UnsignedByte, {0xfe, 0xed}, {nullptr, 0xfe*0xed*4});
+    CORRADE_COMPARE_AS(exporter.exportToData(image),
+        (Containers::Array<char>{Containers::InPlaceInit, {'H', '\xfe', '\xed', 'E'}}),
+        TestSuite::Compare::Container);
+}
+
+void AbstractImageConverterTest::exportToFileStream() {
+    /* Remove previous file */
+    Utility::Directory::rm(Utility::Directory::join(TRADE_TEST_OUTPUT_DIR, "image.out"));
+
+    /* doExportToFile() should write output of doExportToStream() */
+    StreamExporter exporter;
+    ImageView2D image(PixelFormat::RGBA, PixelType::UnsignedByte, {0xfe, 0xed}, {nullptr, 0xfe*0xed*4});
+    CORRADE_VERIFY(exporter.exportToFile(image, Utility::Directory::join(TRADE_TEST_OUTPUT_DIR, "image.out")));
+    CORRADE_COMPARE_AS(Utility::Directory::join(TRADE_TEST_OUTPUT_DIR, "image.out"),
+        "H\xFE\xED" "E", TestSuite::Compare::FileToString);
+}
+
+void AbstractImageConverterTest::exportToStreamNotSupported() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    class DataExporter: public Trade::AbstractImageConverter {
+        private:
+            Features doFeatures() const override { return Feature::ConvertData; }
+    };
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    DataExporter exporter;
+    ImageView2D image(PixelFormat::RGBA, PixelType::UnsignedByte, {}, nullptr);
+    CORRADE_VERIFY(!exporter.exportToStream(image, [](Containers::ArrayView<const char>) { return true; }));
+    CORRADE_COMPARE(out.str(), "Trade::AbstractImageConverter::exportToStream(): feature not supported\n");
+}
+
+namespace {
+
 class ImageDataExporter: public Trade::AbstractImageConverter {
     private:
         Features doFeatures() const override { return Feature::ConvertData|Feature::ConvertCompressedData; }
@@ -23,6 +23,7 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <sstream>
 #include <Corrade/Containers/ArrayView.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/Utility/Directory.h>
@@ -38,10 +39,38 @@ class AbstractImporterTest: public TestSuite::Tester {
         explicit AbstractImporterTest();
 
         void openFile();
+        void openMemory();
+        void openMemoryNotSupported();
+        void openFileMapped();
 };
 
 AbstractImporterTest::AbstractImporterTest() {
-    addTests({&AbstractImporterTest::openFile});
+    addTests({&AbstractImporterTest::openFile,
+              &AbstractImporterTest::openMemory,
+              &AbstractImporterTest::openMemoryNotSupported,
+              &AbstractImporterTest::openFileMapped});
+}
+
+namespace {
+    class MemoryImporter: public Trade::AbstractImporter {
+        public:
+            Containers::ArrayView<const char> memory;
+            bool copied{};
+
+        private:
+            Features doFeatures() const override { return Feature::OpenMemory; }
+            bool doIsOpened() const override { return memory.data(); }
+            void doClose() override { memory = nullptr; }
+
+            void doOpenData(Containers::ArrayView<const char> data) override {
+                copied = true;
+                doOpenMemory(data);
+            }
+
+            void doOpenMemory(Containers::ArrayView<const char> data) override {
+                if(data.size() == 1 && data[0] == '\xa5') memory = data;
+            }
+    };
 }
 
 void AbstractImporterTest::openFile() {
@@ -68,6 +97,51 @@ void AbstractImporterTest::openFile() {
     CORRADE_VERIFY(importer.isOpened());
 }
 
+void AbstractImporterTest::openMemory() {
+    const char data[]{'\xa5'};
+
+    /* The memory should be passed through without copying */
+    MemoryImporter importer;
+    CORRADE_VERIFY(importer.openMemory(data));
+    CORRADE_VERIFY(!importer.copied);
+    CORRADE_COMPARE(static_cast<const void*>(importer.memory.data()), static_cast<const void*>(data));
+
+    importer.close();
+    CORRADE_VERIFY(!importer.isOpened());
+}
+
+void AbstractImporterTest::openMemoryNotSupported() {
+    class DataImporter: public Trade::AbstractImporter {
+        Features doFeatures() const override { return Feature::OpenData; }
+        bool doIsOpened() const override { return false; }
+        void doClose() override {}
+        void doOpenData(Containers::ArrayView<const char>) override {}
+    };
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    DataImporter importer;
+    const char data[]{'\xa5'};
+    importer.openMemory(data);
+    CORRADE_COMPARE(out.str(), "Trade::AbstractImporter::openMemory(): feature not supported\n");
+}
+
+void AbstractImporterTest::openFileMapped() {
+    MemoryImporter importer;
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(TRADE_TEST_DIR, "file.bin")));
+    CORRADE_COMPARE(importer.memory.size(), 1);
+    CORRADE_COMPARE(importer.memory[0], '\xa5');
+
+    /* On platforms with memory mapping the file shouldn't be read */
+    #if (defined(CORRADE_TARGET_UNIX) && !defined(CORRADE_TARGET_EMSCRIPTEN)) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+    CORRADE_VERIFY(!importer.copied);
+    #endif
+
+    /* Closing releases the mapping */
+    importer.close();
+    CORRADE_VERIFY(!importer.isOpened());
+}
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Trade::Test::AbstractImporterTest)
@@ -0,0 +1,92 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/FileToString.h>
+#include <Corrade/Utility/Directory.h>
+
+#include "Magnum/Trade/AbstractMeshConverter.h"
+#include "Magnum/Trade/MeshData.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Trade { namespace Test {
+
+struct AbstractMeshConverterTest: TestSuite::Tester {
+    explicit AbstractMeshConverterTest();
+
+    void exportToFile();
+    void exportToFileNotWritable();
+};
+
+AbstractMeshConverterTest::AbstractMeshConverterTest() {
+    addTests({&AbstractMeshConverterTest::exportToFile,
+              &AbstractMeshConverterTest::exportToFileNotWritable});
+
+    /* Create testing dir */
+    Utility::Directory::mkpath(TRADE_TEST_OUTPUT_DIR);
+}
+
+namespace {
+
+class DataExporter: public Trade::AbstractMeshConverter {
+    private:
+        Features doFeatures() const override { return Feature::ConvertData; }
+
+        Containers::Array<char> doExportToData(const MeshData& mesh) override {
+            return Containers::Array<char>{Containers::InPlaceInit,
+                {char(mesh.vertexCount()), char(mesh.attributeCount())}};
+        };
+};
+
+}
+
+void AbstractMeshConverterTest::exportToFile() {
+    /* Remove previous file */
+    Utility::Directory::rm(Utility::Directory::join(TRADE_TEST_OUTPUT_DIR, "mesh.out"));
+
+    /* doExportToFile() should call doExportToData() */
+    DataExporter exporter;
+    MeshData mesh{MeshPrimitive::Points, nullptr, {}, nullptr, {}, 0x4d};
+    CORRADE_VERIFY(exporter.exportToFile(mesh, Utility::Directory::join(TRADE_TEST_OUTPUT_DIR, "mesh.out")));
+    CORRADE_COMPARE_AS(Utility::Directory::join(TRADE_TEST_OUTPUT_DIR, "mesh.out"),
+        std::string("\x4d\x00", 2), TestSuite::Compare::FileToString);
+}
+
+void AbstractMeshConverterTest::exportToFileNotWritable() {
+    DataExporter exporter;
+    MeshData mesh{MeshPrimitive::Points, nullptr, {}, nullptr, {}, 0};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!exporter.exportToFile(mesh, "/nonexistent/mesh.out"));
+    CORRADE_COMPARE(out.str(), "Trade::AbstractMeshConverter::exportToFile(): cannot write to file /nonexistent/mesh.out\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::AbstractMeshConverterTest)
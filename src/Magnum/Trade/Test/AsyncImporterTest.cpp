@@ -0,0 +1,241 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <atomic>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Vector2.h"
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/AsyncImporter.h"
+#include "Magnum/Trade/ImageData.h"
+
+namespace Magnum { namespace Trade { namespace Test {
+
+struct AsyncImporterTest: TestSuite::Tester {
+    explicit AsyncImporterTest();
+
+    void openImage();
+    void customJob();
+    void order();
+    void progress();
+    void cancelWaiting();
+    void cancelRunning();
+    void destructWithPending();
+};
+
+AsyncImporterTest::AsyncImporterTest() {
+    addTests({&AsyncImporterTest::openImage,
+              &AsyncImporterTest::customJob,
+              &AsyncImporterTest::order,
+              &AsyncImporterTest::progress,
+              &AsyncImporterTest::cancelWaiting,
+              &AsyncImporterTest::cancelRunning,
+              &AsyncImporterTest::destructWithPending});
+}
+
+namespace {
+    class Importer: public AbstractImporter {
+        Features doFeatures() const override { return Feature::OpenData; }
+        bool doIsOpened() const override { return _opened; }
+        void doClose() override { _opened = false; }
+
+        void doOpenData(Containers::ArrayView<const char> data) override {
+            _opened = data.size() == 1 && data[0] == '\xa5';
+        }
+
+        UnsignedInt doImage2DCount() const override { return 1; }
+        Containers::Optional<ImageData2D> doImage2D(UnsignedInt) override {
+            Containers::Array<char> data{Containers::ValueInit, 4};
+            data[2] = '\x37';
+            return ImageData2D{PixelFormat::RGBA, PixelType::UnsignedByte, {1, 1}, std::move(data)};
+        }
+
+        bool _opened{};
+    };
+
+    /* Blocks the worker thread until released from the test */
+    struct Gate {
+        std::atomic<bool> entered{false}, released{false};
+
+        AsyncImporter::Job job() {
+            return [this](AbstractImporter&, AsyncImporter::JobContext& context) {
+                context.setProgress(0.5f);
+                entered = true;
+                while(!released && !context.isCancelled()) {}
+            };
+        }
+
+        void waitForEnter() { while(!entered) {} }
+    };
+}
+
+void AsyncImporterTest::openImage() {
+    Importer importer;
+    AsyncImporter async{importer};
+
+    const char data[]{'\xa5'};
+    bool opened = false;
+    async.enqueue([&data](AbstractImporter& jobImporter, AsyncImporter::JobContext&) {
+        jobImporter.openData(data);
+    }, [&importer, &opened]() { opened = importer.isOpened(); });
+
+    Containers::Optional<ImageData2D> image;
+    const UnsignedInt id = async.image2D(0, [&image](Containers::Optional<ImageData2D>&& result) {
+        image = std::move(result);
+    });
+    CORRADE_COMPARE(async.pendingCount(), 2);
+
+    CORRADE_COMPARE(async.finish(), (std::vector<UnsignedInt>{1, id}));
+    CORRADE_COMPARE(async.pendingCount(), 0);
+    CORRADE_VERIFY(opened);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->size(), Vector2i{1});
+    CORRADE_COMPARE(image->data()[2], '\x37');
+}
+
+void AsyncImporterTest::customJob() {
+    Importer importer;
+    AsyncImporter async{importer};
+
+    Int result = 0;
+    async.enqueue([&result](AbstractImporter&, AsyncImporter::JobContext&) {
+        result = 42;
+    });
+
+    /* Calling update() until there's nothing pending */
+    std::vector<UnsignedInt> completed;
+    while(async.pendingCount()) {
+        const std::vector<UnsignedInt> current = async.update();
+        completed.insert(completed.end(), current.begin(), current.end());
+    }
+
+    CORRADE_COMPARE(completed, std::vector<UnsignedInt>{1});
+    CORRADE_COMPARE(result, 42);
+}
+
+void AsyncImporterTest::order() {
+    Importer importer;
+    AsyncImporter async{importer};
+
+    std::vector<Int> executed, reported;
+    for(Int i = 0; i != 5; ++i) {
+        async.enqueue([&executed, i](AbstractImporter&, AsyncImporter::JobContext&) {
+            executed.push_back(i);
+        }, [&reported, i]() { reported.push_back(i); });
+    }
+
+    CORRADE_COMPARE(async.finish(), (std::vector<UnsignedInt>{1, 2, 3, 4, 5}));
+    CORRADE_COMPARE(executed, (std::vector<Int>{0, 1, 2, 3, 4}));
+    CORRADE_COMPARE(reported, (std::vector<Int>{0, 1, 2, 3, 4}));
+}
+
+void AsyncImporterTest::progress() {
+    #ifdef CORRADE_TARGET_EMSCRIPTEN
+    CORRADE_SKIP("Jobs can't run concurrently without thread support.");
+    #else
+    Importer importer;
+    AsyncImporter async{importer};
+
+    Gate gate;
+    const UnsignedInt running = async.enqueue(gate.job());
+    const UnsignedInt waiting = async.enqueue([](AbstractImporter&, AsyncImporter::JobContext&) {});
+    gate.waitForEnter();
+
+    CORRADE_COMPARE(async.progress(running), 0.5f);
+    CORRADE_COMPARE(async.progress(waiting), 0.0f);
+
+    gate.released = true;
+    async.finish();
+    CORRADE_COMPARE(async.progress(running), 1.0f);
+    CORRADE_COMPARE(async.progress(waiting), 1.0f);
+    #endif
+}
+
+void AsyncImporterTest::cancelWaiting() {
+    #ifdef CORRADE_TARGET_EMSCRIPTEN
+    CORRADE_SKIP("Jobs can't run concurrently without thread support.");
+    #else
+    Importer importer;
+    AsyncImporter async{importer};
+
+    Gate gate;
+    const UnsignedInt running = async.enqueue(gate.job());
+    bool executed = false, reported = false;
+    const UnsignedInt waiting = async.enqueue([&executed](AbstractImporter&, AsyncImporter::JobContext&) {
+        executed = true;
+    }, [&reported]() { reported = true; });
+    gate.waitForEnter();
+
+    CORRADE_VERIFY(async.cancel(waiting));
+    CORRADE_VERIFY(!async.cancel(waiting));
+    CORRADE_COMPARE(async.pendingCount(), 1);
+
+    gate.released = true;
+    CORRADE_COMPARE(async.finish(), std::vector<UnsignedInt>{running});
+    CORRADE_VERIFY(!executed);
+    CORRADE_VERIFY(!reported);
+    #endif
+}
+
+void AsyncImporterTest::cancelRunning() {
+    #ifdef CORRADE_TARGET_EMSCRIPTEN
+    CORRADE_SKIP("Jobs can't run concurrently without thread support.");
+    #else
+    Importer importer;
+    AsyncImporter async{importer};
+
+    Gate gate;
+    bool reported = false;
+    const UnsignedInt running = async.enqueue(gate.job(), [&reported]() { reported = true; });
+    gate.waitForEnter();
+
+    /* The job returns early as it checks the cancellation flag */
+    CORRADE_VERIFY(async.cancel(running));
+    CORRADE_COMPARE(async.pendingCount(), 0);
+    CORRADE_VERIFY(async.finish().empty());
+    CORRADE_VERIFY(!reported);
+    CORRADE_VERIFY(!gate.released);
+    #endif
+}
+
+void AsyncImporterTest::destructWithPending() {
+    Importer importer;
+    bool reported = false;
+    {
+        AsyncImporter async{importer};
+        for(std::size_t i = 0; i != 2; ++i) async.enqueue([](AbstractImporter&, AsyncImporter::JobContext&) {}, [&reported]() {
+            reported = true;
+        });
+    }
+
+    /* No callbacks are called from the destructor */
+    CORRADE_VERIFY(!reported);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::AsyncImporterTest)
@@ -0,0 +1,308 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstddef>
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Color.h"
+#include "Magnum/Trade/MeshData.h"
+#include "Magnum/Trade/MeshData2D.h"
+#include "Magnum/Trade/MeshData3D.h"
+
+namespace Magnum { namespace Trade { namespace Test {
+
+struct MeshDataTest: TestSuite::Tester {
+    explicit MeshDataTest();
+
+    void attributeSize();
+    void attributeSizeUnknownType();
+
+    void construct();
+    void constructNonIndexed();
+    void constructInvalidIndexData();
+    void constructAttributeOutOfBounds();
+    void constructMove();
+
+    void fromMeshData2D();
+    void fromMeshData3D();
+
+    void indicesNotIndexed();
+    void attributeOutOfRange();
+
+    void debugAttributeName();
+};
+
+MeshDataTest::MeshDataTest() {
+    addTests({&MeshDataTest::attributeSize,
+              &MeshDataTest::attributeSizeUnknownType,
+
+              &MeshDataTest::construct,
+              &MeshDataTest::constructNonIndexed,
+              &MeshDataTest::constructInvalidIndexData,
+              &MeshDataTest::constructAttributeOutOfBounds,
+              &MeshDataTest::constructMove,
+
+              &MeshDataTest::fromMeshData2D,
+              &MeshDataTest::fromMeshData3D,
+
+              &MeshDataTest::indicesNotIndexed,
+              &MeshDataTest::attributeOutOfRange,
+
+              &MeshDataTest::debugAttributeName});
+}
+
+using namespace Math::Literals;
+
+namespace {
+    struct Vertex {
+        Vector3 position;
+        Math::Vector2<UnsignedShort> textureCoordinates;
+    };
+
+    Trade::MeshData indexedMesh(const void* importerState = nullptr) {
+        Containers::Array<char> indexData{3*sizeof(UnsignedShort)};
+        auto indices = reinterpret_cast<UnsignedShort*>(indexData.data());
+        indices[0] = 2;
+        indices[1] = 0;
+        indices[2] = 1;
+
+        Containers::Array<char> vertexData{3*sizeof(Vertex)};
+        auto vertices = reinterpret_cast<Vertex*>(vertexData.data());
+        vertices[0] = {{1.0f, 2.0f, 3.0f}, {0, 65535}};
+        vertices[1] = {{4.0f, 5.0f, 6.0f}, {32767, 0}};
+        vertices[2] = {{7.0f, 8.0f, 9.0f}, {65535, 65535}};
+
+        return Trade::MeshData{MeshPrimitive::Triangles,
+            std::move(indexData), Mesh::IndexType::UnsignedShort,
+            std::move(vertexData), {
+                MeshAttributeData{MeshAttributeName::Position,
+                    DynamicAttribute::Kind::Generic,
+                    DynamicAttribute::Components::Three,
+                    DynamicAttribute::DataType::Float,
+                    offsetof(Vertex, position), sizeof(Vertex)},
+                MeshAttributeData{MeshAttributeName::TextureCoordinates,
+                    DynamicAttribute::Kind::GenericNormalized,
+                    DynamicAttribute::Components::Two,
+                    DynamicAttribute::DataType::UnsignedShort,
+                    offsetof(Vertex, textureCoordinates), sizeof(Vertex)}
+            }, 3, importerState};
+    }
+}
+
+void MeshDataTest::attributeSize() {
+    CORRADE_COMPARE((MeshAttributeData{MeshAttributeName::Position,
+        DynamicAttribute::Kind::Generic, DynamicAttribute::Components::Three,
+        DynamicAttribute::DataType::Float, 0, 12}.size()), 12);
+    CORRADE_COMPARE((MeshAttributeData{MeshAttributeName::TextureCoordinates,
+        DynamicAttribute::Kind::GenericNormalized, DynamicAttribute::Components::Two,
+        DynamicAttribute::DataType::UnsignedShort, 0, 4}.size()), 4);
+    CORRADE_COMPARE((MeshAttributeData{MeshAttributeName::Color,
+        DynamicAttribute::Kind::GenericNormalized, DynamicAttribute::Components::Four,
+        DynamicAttribute::DataType::UnsignedByte, 0, 4}.size()), 4);
+}
+
+void MeshDataTest::attributeSizeUnknownType() {
+    CORRADE_COMPARE((MeshAttributeData{MeshAttributeName::Position,
+        DynamicAttribute::Kind::Generic, DynamicAttribute::Components::Three,
+        DynamicAttribute::DataType(0xdead), 0, 12}.size()), 0);
+}
+
+void MeshDataTest::construct() {
+    const int a{};
+    const Trade::MeshData data = indexedMesh(&a);
+
+    CORRADE_COMPARE(data.primitive(), MeshPrimitive::Triangles);
+    CORRADE_VERIFY(data.isIndexed());
+    CORRADE_COMPARE(data.indexType(), Mesh::IndexType::UnsignedShort);
+    CORRADE_COMPARE(data.indexCount(), 3);
+    CORRADE_COMPARE(data.indexData().size(), 6);
+    CORRADE_COMPARE(data.indices(), (std::vector<UnsignedInt>{2, 0, 1}));
+
+    CORRADE_COMPARE(data.vertexCount(), 3);
+    CORRADE_COMPARE(data.vertexData().size(), 3*sizeof(Vertex));
+    CORRADE_COMPARE(data.attributeCount(), 2);
+    CORRADE_COMPARE(data.attribute(1).name(), MeshAttributeName::TextureCoordinates);
+    CORRADE_VERIFY(data.attribute(1).kind() == DynamicAttribute::Kind::GenericNormalized);
+    CORRADE_VERIFY(data.attribute(1).components() == DynamicAttribute::Components::Two);
+    CORRADE_VERIFY(data.attribute(1).dataType() == DynamicAttribute::DataType::UnsignedShort);
+    CORRADE_COMPARE(data.attribute(1).offset(), offsetof(Vertex, textureCoordinates));
+    CORRADE_COMPARE(data.attribute(1).stride(), sizeof(Vertex));
+
+    CORRADE_COMPARE(data.attributeId(MeshAttributeName::Position), 0);
+    CORRADE_COMPARE(data.attributeId(MeshAttributeName::TextureCoordinates), 1);
+    CORRADE_COMPARE(data.attributeId(MeshAttributeName::Normal), -1);
+    CORRADE_VERIFY(data.hasAttribute(MeshAttributeName::Position));
+    CORRADE_VERIFY(!data.hasAttribute(MeshAttributeName::Color));
+
+    CORRADE_COMPARE(reinterpret_cast<const Vertex*>(data.vertexData().data())[1].position, (Vector3{4.0f, 5.0f, 6.0f}));
+    CORRADE_COMPARE(data.importerState(), &a);
+}
+
+void MeshDataTest::constructNonIndexed() {
+    /* Planar layout */
+    Containers::Array<char> vertexData{2*sizeof(Vector2) + 2*sizeof(Color4ub)};
+    const Trade::MeshData data{MeshPrimitive::Lines, nullptr, {},
+        std::move(vertexData), {
+            MeshAttributeData{MeshAttributeName::Position,
+                DynamicAttribute::Kind::Generic,
+                DynamicAttribute::Components::Two,
+                DynamicAttribute::DataType::Float,
+                0, sizeof(Vector2)},
+            MeshAttributeData{MeshAttributeName::Color,
+                DynamicAttribute::Kind::GenericNormalized,
+                DynamicAttribute::Components::Four,
+                DynamicAttribute::DataType::UnsignedByte,
+                2*sizeof(Vector2), sizeof(Color4ub)}
+        }, 2};
+
+    CORRADE_VERIFY(!data.isIndexed());
+    CORRADE_COMPARE(data.indexCount(), 0);
+    CORRADE_COMPARE(data.vertexCount(), 2);
+    CORRADE_COMPARE(data.attributeId(MeshAttributeName::Color), 1);
+}
+
+void MeshDataTest::constructInvalidIndexData() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    Trade::MeshData{MeshPrimitive::Points, Containers::Array<char>{3}, Mesh::IndexType::UnsignedShort, nullptr, {}, 0};
+    CORRADE_COMPARE(out.str(), "Trade::MeshData: index data size 3 is not divisible by size of Mesh::IndexType::UnsignedShort\n");
+}
+
+void MeshDataTest::constructAttributeOutOfBounds() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    /* The last vector ends one byte past the data */
+    Trade::MeshData{MeshPrimitive::Points, nullptr, {},
+        Containers::Array<char>{3*sizeof(Vector3) - 1}, {
+            MeshAttributeData{MeshAttributeName::Position,
+                DynamicAttribute::Kind::Generic,
+                DynamicAttribute::Components::Three,
+                DynamicAttribute::DataType::Float,
+                0, sizeof(Vector3)}
+        }, 3};
+    CORRADE_COMPARE(out.str(), "Trade::MeshData: attribute 0 doesn't fit into 35 bytes of vertex data\n");
+}
+
+void MeshDataTest::constructMove() {
+    Trade::MeshData a = indexedMesh();
+    const void* vertexData = a.vertexData().data();
+
+    Trade::MeshData b{std::move(a)};
+    CORRADE_COMPARE(b.indexCount(), 3);
+    CORRADE_COMPARE(b.attributeCount(), 2);
+    CORRADE_COMPARE(static_cast<const void*>(b.vertexData().data()), vertexData);
+
+    Trade::MeshData c{MeshPrimitive::Points, nullptr, {}, nullptr, {}, 0};
+    c = std::move(b);
+    CORRADE_COMPARE(c.primitive(), MeshPrimitive::Triangles);
+    CORRADE_COMPARE(c.vertexCount(), 3);
+    CORRADE_COMPARE(static_cast<const void*>(c.vertexData().data()), vertexData);
+}
+
+void MeshDataTest::fromMeshData2D() {
+    const Trade::MeshData data{MeshData2D{MeshPrimitive::Triangles, {},
+        {{{0.5f, 1.0f}, {-1.0f, 0.3f}}},
+        {{{0.0f, 0.25f}, {0.3f, 0.7f}}},
+        {{0xff98ab_rgbf, 0xff3366_rgbf}}}};
+
+    CORRADE_VERIFY(!data.isIndexed());
+    CORRADE_COMPARE(data.vertexCount(), 2);
+    CORRADE_COMPARE(data.attributeCount(), 3);
+    CORRADE_COMPARE(data.attribute(0).name(), MeshAttributeName::Position);
+    CORRADE_VERIFY(data.attribute(0).components() == DynamicAttribute::Components::Two);
+    CORRADE_COMPARE(data.attribute(1).name(), MeshAttributeName::TextureCoordinates);
+    CORRADE_COMPARE(data.attribute(1).offset(), sizeof(Vector2));
+    CORRADE_COMPARE(data.attribute(2).name(), MeshAttributeName::Color);
+    CORRADE_COMPARE(data.attribute(2).offset(), 2*sizeof(Vector2));
+    CORRADE_COMPARE(data.attribute(2).stride(), 2*sizeof(Vector2) + sizeof(Color4));
+
+    const char* vertices = data.vertexData().data();
+    const std::size_t stride = data.attribute(0).stride();
+    CORRADE_COMPARE(*reinterpret_cast<const Vector2*>(vertices + stride), (Vector2{-1.0f, 0.3f}));
+    CORRADE_COMPARE(*reinterpret_cast<const Vector2*>(vertices + stride + sizeof(Vector2)), (Vector2{0.3f, 0.7f}));
+    CORRADE_COMPARE(*reinterpret_cast<const Color4*>(vertices + stride + 2*sizeof(Vector2)), 0xff3366_rgbf);
+}
+
+void MeshDataTest::fromMeshData3D() {
+    const Trade::MeshData data{MeshData3D{MeshPrimitive::Lines, {1, 0},
+        {{{0.5f, 1.0f, 0.1f}, {-1.0f, 0.3f, -1.0f}}},
+        {{{0.0f, 1.0f, 0.0f}, {-1.0f, 0.0f, 0.0f}}},
+        {},
+        {{0xff98ab_rgbf, 0xff3366_rgbf}}}};
+
+    CORRADE_VERIFY(data.isIndexed());
+    CORRADE_COMPARE(data.indexType(), Mesh::IndexType::UnsignedInt);
+    CORRADE_COMPARE(data.indices(), (std::vector<UnsignedInt>{1, 0}));
+
+    /* No texture coordinates */
+    CORRADE_COMPARE(data.vertexCount(), 2);
+    CORRADE_COMPARE(data.attributeCount(), 3);
+    CORRADE_COMPARE(data.attribute(1).name(), MeshAttributeName::Normal);
+    CORRADE_COMPARE(data.attribute(1).offset(), sizeof(Vector3));
+    CORRADE_COMPARE(data.attribute(2).name(), MeshAttributeName::Color);
+    CORRADE_COMPARE(data.attribute(2).offset(), 2*sizeof(Vector3));
+    CORRADE_VERIFY(data.attribute(2).components() == DynamicAttribute::Components::Four);
+    CORRADE_COMPARE(data.attribute(2).stride(), 2*sizeof(Vector3) + sizeof(Color4));
+
+    const char* vertices = data.vertexData().data();
+    const std::size_t stride = data.attribute(0).stride();
+    CORRADE_COMPARE(*reinterpret_cast<const Vector3*>(vertices + stride), (Vector3{-1.0f, 0.3f, -1.0f}));
+    CORRADE_COMPARE(*reinterpret_cast<const Vector3*>(vertices + stride + sizeof(Vector3)), (Vector3{-1.0f, 0.0f, 0.0f}));
+    CORRADE_COMPARE(*reinterpret_cast<const Color4*>(vertices + stride + 2*sizeof(Vector3)), 0xff3366_rgbf);
+}
+
+void MeshDataTest::indicesNotIndexed() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    const Trade::MeshData data{MeshPrimitive::Points, nullptr, {}, nullptr, {}, 0};
+    data.indexType();
+    data.indices();
+    CORRADE_COMPARE(out.str(),
+        "Trade::MeshData::indexType(): the mesh is not indexed\n"
+        "Trade::MeshData::indices(): the mesh is not indexed\n");
+}
+
+void MeshDataTest::attributeOutOfRange() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    const Trade::MeshData data = indexedMesh();
+    data.attribute(2);
+    CORRADE_COMPARE(out.str(), "Trade::MeshData::attribute(): index 2 out of range for 2 attributes\n");
+}
+
+void MeshDataTest::debugAttributeName() {
+    std::ostringstream out;
+    Debug{&out} << MeshAttributeName::TextureCoordinates << MeshAttributeName(0xdf);
+    CORRADE_COMPARE(out.str(), "Trade::MeshAttributeName::TextureCoordinates Trade::MeshAttributeName(0xdf)\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::MeshDataTest)
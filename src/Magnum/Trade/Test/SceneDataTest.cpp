@@ -23,7 +23,10 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <sstream>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
 
 #include "Magnum/Trade/SceneData.h"
 #include "Magnum/Magnum.h"
@@ -34,12 +37,18 @@ struct SceneDataTest: TestSuite::Tester {
     explicit SceneDataTest();
 
     void construct();
+    void constructFlat();
+    void constructFlatWrongSize();
+    void constructFlatWrongOrder();
     void constructCopy();
     void constructMove();
 };
 
 SceneDataTest::SceneDataTest() {
     addTests({&SceneDataTest::construct,
+              &SceneDataTest::constructFlat,
+              &SceneDataTest::constructFlatWrongSize,
+              &SceneDataTest::constructFlatWrongOrder,
               &SceneDataTest::constructCopy,
               &SceneDataTest::constructMove});
 }
@@ -51,6 +60,50 @@ void SceneDataTest::construct() {
     CORRADE_COMPARE(data.children2D(), (std::vector<UnsignedInt>{0, 1, 4}));
     CORRADE_COMPARE(data.children3D(), (std::vector<UnsignedInt>{2, 5}));
     CORRADE_COMPARE(data.importerState(), &a);
+    CORRADE_VERIFY(!data.hasFlatObjects3D());
+    CORRADE_VERIFY(data.objects3D().empty());
+    CORRADE_VERIFY(data.parents3D().empty());
+}
+
+void SceneDataTest::constructFlat() {
+    const int a{};
+    const SceneData data{{3}, {7, 2, 5, 4}, {-1, 0, 1, -1}, {
+            Matrix4::translation(Vector3::xAxis(1.0f)), Matrix4{},
+            Matrix4::scaling(Vector3{2.0f}), Matrix4{}},
+        {-1, 0, 1, 0}, {-1, 2, -1, 2}, &a};
+
+    CORRADE_VERIFY(data.hasFlatObjects3D());
+    CORRADE_COMPARE(data.children2D(), (std::vector<UnsignedInt>{3}));
+    CORRADE_COMPARE(data.children3D(), (std::vector<UnsignedInt>{7, 4}));
+    CORRADE_COMPARE_AS(data.objects3D(), (std::vector<UnsignedInt>{7, 2, 5, 4}), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(data.parents3D(), (std::vector<Int>{-1, 0, 1, -1}), TestSuite::Compare::Container);
+    CORRADE_COMPARE(data.transformations3D().size(), 4);
+    CORRADE_COMPARE(data.transformations3D()[2], Matrix4::scaling(Vector3{2.0f}));
+    CORRADE_COMPARE_AS(data.meshes3D(), (std::vector<Int>{-1, 0, 1, 0}), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(data.materials3D(), (std::vector<Int>{-1, 2, -1, 2}), TestSuite::Compare::Container);
+    CORRADE_COMPARE(data.importerState(), &a);
+}
+
+void SceneDataTest::constructFlatWrongSize() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    SceneData data{{}, {0, 1}, {-1, 0}, {Matrix4{}}, {-1, -1}, {-1, -1}};
+    CORRADE_COMPARE(out.str(), "Trade::SceneData: expected 2 items in all 3D arrays but got 2 1 2 2\n");
+}
+
+void SceneDataTest::constructFlatWrongOrder() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    SceneData data{{}, {0, 1}, {1, -1}, {Matrix4{}, Matrix4{}}, {-1, -1}, {-1, -1}};
+    CORRADE_COMPARE(out.str(), "Trade::SceneData: parent 1 of object 0 is not stored before it\n");
 }
 
 void SceneDataTest::constructCopy() {
@@ -36,7 +36,9 @@ namespace Magnum { namespace Trade {
 #ifndef DOXYGEN_GENERATING_OUTPUT
 class AbstractImageConverter;
 class AbstractImporter;
+class AbstractMeshConverter;
 class AbstractMaterialData;
+class AsyncImporter;
 class CameraData;
 
 template<UnsignedInt> class ImageData;
@@ -45,6 +47,9 @@ typedef ImageData<2> ImageData2D;
 typedef ImageData<3> ImageData3D;
 
 class LightData;
+enum class MeshAttributeName: UnsignedByte;
+class MeshAttributeData;
+class MeshData;
 class MeshData2D;
 class MeshData3D;
 class MeshObjectData2D;
@@ -23,11 +23,15 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <atomic>
+#include <chrono>
 #include <Corrade/PluginManager/Manager.h>
 #include <Corrade/Utility/Arguments.h>
 #include <Corrade/Utility/Directory.h>
 
 #include "Magnum/PixelFormat.h"
+#include "Magnum/ThreadPool.h"
+#include "Magnum/Implementation/converterBatch.h"
 #include "Magnum/Trade/AbstractImporter.h"
 #include "Magnum/Trade/AbstractImageConverter.h"
 #include "Magnum/Trade/ImageData.h"
@@ -43,19 +47,23 @@ namespace Magnum {
 
 @code{.sh}
 magnum-imageconverter [-h|--help] [--importer IMPORTER] [--converter CONVERTER]
-    [--plugin-dir DIR] [--] input output
+    [--plugin-dir DIR] [--batch] [--threads N] [--] input output
 @endcode
 
 Arguments:
 
--   `input` --- input image
--   `output` --- output image
+-   `input` --- input image or a batch manifest if `--batch` is set
+-   `output` --- output image or an output directory if `--batch` is set
 -   `-h`, `--help` --- display this help message and exit
 -   `--importer IMPORTER` --- image importer plugin (default:
     @ref Trade::AnyImageImporter "AnyImageImporter")
 -   `--converter CONVERTER` --- image converter plugin (default:
     @ref Trade::AnyImageConverter "AnyImageConverter")
 -   `--plugin-dir DIR` --- override base plugin dir
+-   `--batch` --- convert all files listed in the `input` manifest, see
+    @ref magnum-imageconverter-batch
+-   `--threads N` --- count of threads used in batch mode (default: `0`,
+    which means the count of hardware threads)
 
 @section magnum-imageconverter-example Example usage
 
@@ -65,19 +73,83 @@ Converting a JPEG file to a PNG:
 magnum-imageconverter image.jpg image.png
 @endcode
 
+@section magnum-imageconverter-batch Batch conversion
+
+Converting many files by calling the utility once for every file spends most
+of the time starting the process and loading the plugins. With `--batch`, the
+`input` is a manifest that lists an input and an output file on each line,
+separated by a tab or by a space. Empty lines and lines starting with `#` are
+ignored, relative output paths are taken relative to the `output` directory:
+
+@code{.sh}
+# Input           Output
+src/grass.jpg     grass.png
+src/stone.jpg     stone.png
+@endcode
+
+The plugins are loaded once and every thread of a @ref ThreadPool keeps its
+own importer and converter instance for all files it processes. At the end
+the count of converted files and the throughput is printed.
+
+@code{.sh}
+ls src/*.jpg | sed 's/.*\/\(.*\)\.jpg/&\t\1.png/' > manifest.txt
+magnum-imageconverter --batch manifest.txt textures/
+@endcode
+
+The @ref Trade::AnyImageImporter "AnyImageImporter" and
+@ref Trade::AnyImageConverter "AnyImageConverter" plugins instantiate the
+concrete plugin through the shared plugin manager for every file, which is not
+thread-safe, so calls to them are serialized. For the best throughput, specify
+the concrete plugins using `--importer` and `--converter`.
+
 */
 
 }
 
 using namespace Magnum;
 
+namespace {
+
+/* Converts a single file, returns the error code or 0 on success */
+int convert(Trade::AbstractImporter& importer, Trade::AbstractImageConverter& converter, const Utility::Arguments& args, const std::string& input, const std::string& output, std::mutex& managerMutex, std::size_t& dataSize, const bool verbose) {
+    /* Open input file */
+    Containers::Optional<Trade::ImageData2D> image;
+    {
+        std::unique_lock<std::mutex> lock = Implementation::lockIfProxyPlugin(managerMutex, args.value("importer"));
+        if(!importer.openFile(input) || !(image = importer.image2D(0))) {
+            Error() << "Cannot open file" << input;
+            return 3;
+        }
+        importer.close();
+    }
+
+    if(verbose)
+        Debug() << "Converting image of size" << image->size() << Debug::nospace << ", format" << image->format() << "and type"  << image->type() << "to" << output;
+
+    /* Save output file */
+    {
+        std::unique_lock<std::mutex> lock = Implementation::lockIfProxyPlugin(managerMutex, args.value("converter"));
+        if(!converter.exportToFile(*image, output)) {
+            Error() << "Cannot save file" << output;
+            return 4;
+        }
+    }
+
+    dataSize = image->data().size();
+    return 0;
+}
+
+}
+
 int main(int argc, char** argv) {
     Utility::Arguments args;
-    args.addArgument("input").setHelp("input", "input image")
-        .addArgument("output").setHelp("output", "output image")
+    args.addArgument("input").setHelp("input", "input image or a batch manifest")
+        .addArgument("output").setHelp("output", "output image or an output directory")
         .addOption("importer", "AnyImageImporter").setHelp("importer", "image importer plugin")
         .addOption("converter", "AnyImageConverter").setHelp("converter", "image converter plugin")
         .addOption("plugin-dir").setHelp("plugin-dir", "override base plugin dir", "DIR")
+        .addBooleanOption("batch").setHelp("batch", "convert all files listed in the input manifest")
+        .addOption("threads", "0").setHelp("threads", "count of threads used in batch mode", "N")
         .setHelp("Converts images of different formats.")
         .parse(argc, argv);
 
@@ -95,18 +167,53 @@ int main(int argc, char** argv) {
     std::unique_ptr<Trade::AbstractImageConverter> converter = converterManager.loadAndInstantiate(args.value("converter"));
     if(!converter) return 2;
 
-    /* Open input file */
-    Containers::Optional<Trade::ImageData2D> image;
-    if(!importer->openFile(args.value("input")) || !(image = importer->image2D(0))) {
-        Error() << "Cannot open file" << args.value("input");
-        return 3;
-    }
+    std::mutex managerMutex;
 
-    Debug() << "Converting image of size" << image->size() << Debug::nospace << ", format" << image->format() << "and type"  << image->type() << "to" << args.value("output");
-
-    /* Save output file */
-    if(!converter->exportToFile(*image, args.value("output"))) {
-        Error() << "Cannot save file" << args.value("output");
-        return 4;
+    /* Single file */
+    if(!args.isSet("batch")) {
+        std::size_t dataSize;
+        return convert(*importer, *converter, args, args.value("input"), args.value("output"), managerMutex, dataSize, true);
     }
+
+    /* Batch conversion */
+    Containers::Optional<std::vector<Implementation::BatchEntry>> entries = Implementation::parseBatchManifest(args.value("input"), args.value("output"));
+    if(!entries) return 3;
+    Utility::Directory::mkpath(args.value("output"));
+
+    /* Every thread takes its own plugin instances from the list and returns
+       them after it finishes processing its chunk of files */
+    ThreadPool pool{args.value<UnsignedInt>("threads")};
+    std::vector<std::pair<std::unique_ptr<Trade::AbstractImporter>, std::unique_ptr<Trade::AbstractImageConverter>>> instances;
+    instances.emplace_back(std::move(importer), std::move(converter));
+    for(UnsignedInt i = 1; i < pool.threadCount(); ++i)
+        instances.emplace_back(importerManager.instantiate(args.value("importer")), converterManager.instantiate(args.value("converter")));
+
+    std::mutex instanceMutex;
+    std::atomic<std::size_t> succeeded{0}, failed{0}, dataSize{0};
+    const auto begin = std::chrono::steady_clock::now();
+    pool.parallelFor(entries->size(), 1, [&](const std::size_t first, const std::size_t last) {
+        std::pair<std::unique_ptr<Trade::AbstractImporter>, std::unique_ptr<Trade::AbstractImageConverter>> instance;
+        {
+            std::lock_guard<std::mutex> lock{instanceMutex};
+            instance = std::move(instances.back());
+            instances.pop_back();
+        }
+
+        for(std::size_t i = first; i != last; ++i) {
+            std::size_t size;
+            if(convert(*instance.first, *instance.second, args, (*entries)[i].input, (*entries)[i].output, managerMutex, size, false)) {
+                ++failed;
+                continue;
+            }
+
+            ++succeeded;
+            dataSize += size;
+        }
+
+        std::lock_guard<std::mutex> lock{instanceMutex};
+        instances.push_back(std::move(instance));
+    });
+
+    Implementation::printBatchSummary(succeeded, failed, dataSize, std::chrono::duration<Double>(std::chrono::steady_clock::now() - begin).count());
+    return failed ? 4 : 0;
 }
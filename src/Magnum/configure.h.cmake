@@ -28,6 +28,7 @@
 #cmakedefine MAGNUM_BUILD_DEPRECATED
 #cmakedefine MAGNUM_BUILD_STATIC
 #cmakedefine MAGNUM_BUILD_MULTITHREADED
+#cmakedefine MAGNUM_BUILD_STATISTICS
 #cmakedefine MAGNUM_TARGET_GLES
 #cmakedefine MAGNUM_TARGET_GLES2
 #cmakedefine MAGNUM_TARGET_GLES3
@@ -25,6 +25,8 @@
 
 #include "AnyImporter.h"
 
+#include <algorithm>
+#include <fstream>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/PluginManager/Manager.h>
 #include <Corrade/Utility/Assert.h>
@@ -32,6 +34,55 @@
 
 namespace Magnum { namespace Audio {
 
+namespace {
+
+/* File signatures, checked before the extension */
+struct Signature {
+    std::size_t offset;
+    const char* magic;
+    std::size_t size;
+    const char* plugin;
+};
+
+constexpr Signature Signatures[]{
+    {0, "OggS", 4, "VorbisAudioImporter"},
+    {8, "WAVE", 4, "WavAudioImporter"},
+    {0, "fLaC", 4, "FlacAudioImporter"}
+};
+
+/* Size of the file prefix needed to check all signatures */
+constexpr std::size_t SignaturePrefixSize = 12;
+
+std::string pluginForSignature(const std::string& filename) {
+    /* Read just the beginning of the file. If it can't be opened, the prefix
+       is empty and the detection falls back to the extension. The concrete
+       plugin then reports the error. */
+    std::ifstream file{filename, std::ifstream::binary};
+    char prefix[SignaturePrefixSize];
+    file.read(prefix, SignaturePrefixSize);
+    const std::size_t prefixSize = file.gcount();
+
+    for(const Signature& signature: Signatures)
+        if(signature.offset + signature.size <= prefixSize && std::equal(signature.magic, signature.magic + signature.size, prefix + signature.offset))
+            return signature.plugin;
+
+    return {};
+}
+
+/* Detects file type from its extension */
+std::string pluginForExtension(const std::string& filename) {
+    if(Utility::String::endsWith(filename, ".ogg"))
+        return "VorbisAudioImporter";
+    else if(Utility::String::endsWith(filename, ".wav"))
+        return "WavAudioImporter";
+    else if(Utility::String::endsWith(filename, ".flac"))
+        return "FlacAudioImporter";
+
+    return {};
+}
+
+}
+
 AnyImporter::AnyImporter(PluginManager::Manager<AbstractImporter>& manager): AbstractImporter{manager} {}
 
 AnyImporter::AnyImporter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractImporter{manager, plugin} {}
@@ -40,39 +91,44 @@ AnyImporter::~AnyImporter() = default;
 
 auto AnyImporter::doFeatures() const -> Features { return {}; }
 
-bool AnyImporter::doIsOpened() const { return !!_in; }
+bool AnyImporter::doIsOpened() const { return _in; }
 
-void AnyImporter::doClose() { _in = nullptr; }
+void AnyImporter::doClose() {
+    /* Keep the instance around for subsequent files of the same type */
+    _in->close();
+    _in = nullptr;
+}
 
 void AnyImporter::doOpenFile(const std::string& filename) {
     CORRADE_INTERNAL_ASSERT(manager());
 
-    /* Detect type from extension */
-    std::string plugin;
-    if(Utility::String::endsWith(filename, ".ogg"))
-        plugin = "VorbisAudioImporter";
-    else if(Utility::String::endsWith(filename, ".wav"))
-        plugin = "WavAudioImporter";
-    else if(Utility::String::endsWith(filename, ".flac"))
-        plugin = "FlacAudioImporter";
-    else {
+    /* Detect type from file signature, if that's not conclusive from
+       extension */
+    std::string plugin = pluginForSignature(filename);
+    if(plugin.empty()) plugin = pluginForExtension(filename);
+    if(plugin.empty()) {
         Error() << "Audio::AnyImporter::openFile(): cannot determine type of file" << filename;
         return;
     }
 
-    /* Try to load the plugin */
-    if(!(manager()->load(plugin) & PluginManager::LoadState::Loaded)) {
-        Error() << "Audio::AnyImporter::openFile(): cannot load" << plugin << "plugin";
-        return;
+    /* Reuse an instance from previous files of the same type or try to load
+       the plugin and instantiate it */
+    auto found = _importers.find(plugin);
+    if(found == _importers.end()) {
+        if(!(manager()->load(plugin) & PluginManager::LoadState::Loaded)) {
+            Error() << "Audio::AnyImporter::openFile(): cannot load" << plugin << "plugin";
+            return;
+        }
+
+        found = _importers.emplace(plugin, static_cast<PluginManager::Manager<AbstractImporter>*>(manager())->instantiate(plugin)).first;
     }
 
     /* Try to open the file (error output should be printed by the plugin
        itself) */
-    std::unique_ptr<AbstractImporter> importer = static_cast<PluginManager::Manager<AbstractImporter>*>(manager())->instantiate(plugin);
-    if(!importer->openFile(filename)) return;
+    if(!found->second->openFile(filename)) return;
 
-    /* Success, save the instance */
-    _in = std::move(importer);
+    /* Success, remember the instance */
+    _in = found->second.get();
 }
 
 Buffer::Format AnyImporter::doFormat() const { return _in->format(); }
@@ -81,7 +137,11 @@ UnsignedInt AnyImporter::doFrequency() const { return _in->frequency(); }
 
 Containers::Array<char> AnyImporter::doData() { return _in->data(); }
 
+std::size_t AnyImporter::doFrameCount() { return _in->frameCount(); }
+
+Containers::Array<char> AnyImporter::doReadFrames(const std::size_t offset, const std::size_t count) { return _in->readFrames(offset, count); }
+
 }}
 
 CORRADE_PLUGIN_REGISTER(AnyAudioImporter, Magnum::Audio::AnyImporter,
-    "cz.mosra.magnum.Audio.AbstractImporter/0.1")
+    "cz.mosra.magnum.Audio.AbstractImporter/0.2")
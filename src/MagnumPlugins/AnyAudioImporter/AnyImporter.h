@@ -30,6 +30,7 @@
  */
 
 #include <memory>
+#include <unordered_map>
 #include <Magnum/Audio/AbstractImporter.h>
 
 #include "MagnumPlugins/AnyAudioImporter/configure.h"
@@ -55,8 +56,12 @@ namespace Magnum { namespace Audio {
 /**
 @brief Any audio importer plugin
 
-Detects file type based on file extension, loads corresponding plugin and then
-tries to open the file with it.
+Detects file type based on file signature or, if the signature is not
+conclusive, file extension, loads corresponding plugin and then tries to open
+the file with it. Only the first few bytes of the file are read for the
+detection. Instances of the concrete plugins are kept for the whole lifetime
+of the importer, so opening more files of the same type loads and instantiates
+the plugin only once.
 
 This plugin depends on the @ref Audio library and is built if
 `WITH_ANYAUDIOIMPORTER` is enabled when building Magnum. To use as a dynamic
@@ -95,8 +100,11 @@ class MAGNUM_ANYAUDIOIMPORTER_EXPORT AnyImporter: public AbstractImporter {
         MAGNUM_ANYAUDIOIMPORTER_LOCAL Buffer::Format doFormat() const override;
         MAGNUM_ANYAUDIOIMPORTER_LOCAL UnsignedInt doFrequency() const override;
         MAGNUM_ANYAUDIOIMPORTER_LOCAL Containers::Array<char> doData() override;
+        MAGNUM_ANYAUDIOIMPORTER_LOCAL std::size_t doFrameCount() override;
+        MAGNUM_ANYAUDIOIMPORTER_LOCAL Containers::Array<char> doReadFrames(std::size_t offset, std::size_t count) override;
 
-        std::unique_ptr<AbstractImporter> _in;
+        std::unordered_map<std::string, std::unique_ptr<AbstractImporter>> _importers;
+        AbstractImporter* _in{};
 };
 
 }}
@@ -37,6 +37,8 @@ struct AnyImporterTest: TestSuite::Tester {
     explicit AnyImporterTest();
 
     void wav();
+    void wavMisnamed();
+    void reopen();
 
     void unknown();
 
@@ -46,6 +48,8 @@ struct AnyImporterTest: TestSuite::Tester {
 
 AnyImporterTest::AnyImporterTest() {
     addTests({&AnyImporterTest::wav,
+              &AnyImporterTest::wavMisnamed,
+              &AnyImporterTest::reopen,
 
               &AnyImporterTest::unknown});
 
@@ -72,6 +76,38 @@ void AnyImporterTest::wav() {
     CORRADE_COMPARE(importer->frequency(), 96000);
 }
 
+void AnyImporterTest::wavMisnamed() {
+    if(!(_manager.loadState("WavAudioImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("WavAudioImporter plugin not enabled, cannot test");
+
+    /* The extension is unknown, the file is detected from the contents */
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("AnyAudioImporter");
+    CORRADE_VERIFY(importer->openFile(WAV_MISNAMED_FILE));
+    CORRADE_COMPARE(importer->format(), Buffer::Format::Stereo8);
+    CORRADE_COMPARE(importer->frequency(), 96000);
+}
+
+void AnyImporterTest::reopen() {
+    if(!(_manager.loadState("WavAudioImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("WavAudioImporter plugin not enabled, cannot test");
+
+    /* The second open reuses the WavAudioImporter instance */
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("AnyAudioImporter");
+    CORRADE_VERIFY(importer->openFile(WAV_FILE));
+    importer->close();
+    CORRADE_VERIFY(!importer->isOpened());
+    CORRADE_VERIFY(importer->openFile(WAV_MISNAMED_FILE));
+    CORRADE_COMPARE(importer->format(), Buffer::Format::Stereo8);
+
+    /* A failed open leaves the importer closed */
+    std::ostringstream output;
+    {
+        Error redirectError{&output};
+        CORRADE_VERIFY(!importer->openFile("sound.mid"));
+    }
+    CORRADE_VERIFY(!importer->isOpened());
+}
+
 void AnyImporterTest::unknown() {
     std::ostringstream output;
     Error redirectError{&output};
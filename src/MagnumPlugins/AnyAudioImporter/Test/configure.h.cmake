@@ -26,3 +26,4 @@
 #cmakedefine ANYAUDIOIMPORTER_PLUGIN_FILENAME "${ANYAUDIOIMPORTER_PLUGIN_FILENAME}"
 #cmakedefine WAVAUDIOIMPORTER_PLUGIN_FILENAME "${WAVAUDIOIMPORTER_PLUGIN_FILENAME}"
 #define WAV_FILE "${WAV_FILE}"
+#define WAV_MISNAMED_FILE "${WAV_MISNAMED_FILE}"
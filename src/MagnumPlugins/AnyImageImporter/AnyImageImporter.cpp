@@ -25,6 +25,8 @@
 
 #include "AnyImageImporter.h"
 
+#include <algorithm>
+#include <fstream>
 #include <Corrade/PluginManager/Manager.h>
 #include <Corrade/Utility/Assert.h>
 #include <Corrade/Utility/String.h>
@@ -32,90 +34,155 @@
 
 namespace Magnum { namespace Trade {
 
-AnyImageImporter::AnyImageImporter(PluginManager::Manager<AbstractImporter>& manager): AbstractImporter{manager} {}
-
-AnyImageImporter::AnyImageImporter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractImporter{manager, plugin} {}
-
-AnyImageImporter::~AnyImageImporter() = default;
-
-auto AnyImageImporter::doFeatures() const -> Features { return {}; }
-
-bool AnyImageImporter::doIsOpened() const { return !!_in; }
-
-void AnyImageImporter::doClose() {
-    _in = nullptr;
+namespace {
+
+/* File signatures, checked before the extension */
+struct Signature {
+    std::size_t offset;
+    const char* magic;
+    std::size_t size;
+    const char* plugin;
+};
+
+constexpr Signature Signatures[]{
+    {0, "\x89PNG\r\n\x1a\n", 8, "PngImporter"},
+    {0, "\xff\xd8\xff", 3, "JpegImporter"},
+    {0, "\xabKTX 11\xbb\r\n\x1a\n", 12, "KtxImporter"},
+    {0, "DDS ", 4, "DdsImporter"},
+    {0, "GIF87a", 6, "GifImporter"},
+    {0, "GIF89a", 6, "GifImporter"},
+    {0, "\x76\x2f\x31\x01", 4, "OpenExrImporter"},
+    {0, "#?RADIANCE", 10, "HdrImporter"},
+    {0, "#?RGBE", 6, "HdrImporter"},
+    {0, "\0\0\0\x0cjP  \r\n\x87\n", 12, "Jpeg2000Importer"},
+    {0, "8BPS", 4, "PsdImporter"},
+    {0, "II*\0", 4, "TiffImporter"},
+    {0, "MM\0*", 4, "TiffImporter"},
+    {0, "BM", 2, "BmpImporter"}
+};
+
+/* Size of the file prefix needed to check all signatures */
+constexpr std::size_t SignaturePrefixSize = 16;
+
+std::string pluginForSignature(const std::string& filename) {
+    /* Read just the beginning of the file. If it can't be opened, the prefix
+       is empty and the detection falls back to the extension. The concrete
+       plugin then reports the error. */
+    std::ifstream file{filename, std::ifstream::binary};
+    char prefix[SignaturePrefixSize];
+    file.read(prefix, SignaturePrefixSize);
+    const std::size_t prefixSize = file.gcount();
+
+    for(const Signature& signature: Signatures)
+        if(signature.offset + signature.size <= prefixSize && std::equal(signature.magic, signature.magic + signature.size, prefix + signature.offset))
+            return signature.plugin;
+
+    return {};
 }
 
-void AnyImageImporter::doOpenFile(const std::string& filename) {
-    CORRADE_INTERNAL_ASSERT(manager());
-
-    /* Detect type from extension */
-    std::string plugin;
+/* Detects file type from its extension */
+std::string pluginForExtension(const std::string& filename) {
     if(Utility::String::endsWith(filename, ".bmp"))
-        plugin = "BmpImporter";
+        return "BmpImporter";
     else if(Utility::String::endsWith(filename, ".dds"))
-        plugin = "DdsImporter";
+        return "DdsImporter";
     else if(Utility::String::endsWith(filename, ".exr"))
-        plugin = "OpenExrImporter";
+        return "OpenExrImporter";
     else if(Utility::String::endsWith(filename, ".gif"))
-        plugin = "GifImporter";
+        return "GifImporter";
     else if(Utility::String::endsWith(filename, ".hdr"))
-        plugin = "HdrImporter";
+        return "HdrImporter";
     else if(Utility::String::endsWith(filename, ".jpg") ||
             Utility::String::endsWith(filename, ".jpeg") ||
             Utility::String::endsWith(filename, ".jpe") )
-        plugin = "JpegImporter";
+        return "JpegImporter";
     else if(Utility::String::endsWith(filename, ".jp2"))
-        plugin = "Jpeg2000Importer";
+        return "Jpeg2000Importer";
+    else if(Utility::String::endsWith(filename, ".ktx"))
+        return "KtxImporter";
     else if(Utility::String::endsWith(filename, ".mng"))
-        plugin = "MngImporter";
+        return "MngImporter";
     else if(Utility::String::endsWith(filename, ".pbm"))
-        plugin = "PbmImporter";
+        return "PbmImporter";
     else if(Utility::String::endsWith(filename, ".pcx"))
-        plugin = "PcxImporter";
+        return "PcxImporter";
     else if(Utility::String::endsWith(filename, ".pgm"))
-        plugin = "PgmImporter";
+        return "PgmImporter";
     else if(Utility::String::endsWith(filename, ".pic"))
-        plugin = "PicImporter";
+        return "PicImporter";
     else if(Utility::String::endsWith(filename, ".pnm"))
-        plugin = "PnmImporter";
+        return "PnmImporter";
     else if(Utility::String::endsWith(filename, ".png"))
-        plugin = "PngImporter";
+        return "PngImporter";
     else if(Utility::String::endsWith(filename, ".ppm"))
-        plugin = "PpmImporter";
+        return "PpmImporter";
     else if(Utility::String::endsWith(filename, ".psd"))
-        plugin = "PsdImporter";
+        return "PsdImporter";
     else if(Utility::String::endsWith(filename, ".sgi") ||
             Utility::String::endsWith(filename, ".bw") ||
             Utility::String::endsWith(filename, ".rgb") ||
             Utility::String::endsWith(filename, ".rgba"))
-        plugin = "SgiImporter";
+        return "SgiImporter";
     else if(Utility::String::endsWith(filename, ".tif") ||
             Utility::String::endsWith(filename, ".tiff"))
-        plugin = "TiffImporter";
+        return "TiffImporter";
     else if(Utility::String::endsWith(filename, ".tga") ||
             Utility::String::endsWith(filename, ".vda") ||
             Utility::String::endsWith(filename, ".icb") ||
             Utility::String::endsWith(filename, ".vst"))
-        plugin = "TgaImporter";
-    else {
+        return "TgaImporter";
+
+    return {};
+}
+
+}
+
+AnyImageImporter::AnyImageImporter(PluginManager::Manager<AbstractImporter>& manager): AbstractImporter{manager} {}
+
+AnyImageImporter::AnyImageImporter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractImporter{manager, plugin} {}
+
+AnyImageImporter::~AnyImageImporter() = default;
+
+auto AnyImageImporter::doFeatures() const -> Features { return {}; }
+
+bool AnyImageImporter::doIsOpened() const { return _in; }
+
+void AnyImageImporter::doClose() {
+    /* Keep the instance around for subsequent files of the same type */
+    _in->close();
+    _in = nullptr;
+}
+
+void AnyImageImporter::doOpenFile(const std::string& filename) {
+    CORRADE_INTERNAL_ASSERT(manager());
+
+    /* Detect type from file signature, if that's not conclusive from
+       extension */
+    std::string plugin = pluginForSignature(filename);
+    if(plugin.empty()) plugin = pluginForExtension(filename);
+    if(plugin.empty()) {
         Error() << "Trade::AnyImageImporter::openFile(): cannot determine type of file" << filename;
         return;
     }
 
-    /* Try to load the plugin */
-    if(!(manager()->load(plugin) & PluginManager::LoadState::Loaded)) {
-        Error() << "Trade::AnyImageImporter::openFile(): cannot load" << plugin << "plugin";
-        return;
+    /* Reuse an instance from previous files of the same type or try to load
+       the plugin and instantiate it */
+    auto found = _importers.find(plugin);
+    if(found == _importers.end()) {
+        if(!(manager()->load(plugin) & PluginManager::LoadState::Loaded)) {
+            Error() << "Trade::AnyImageImporter::openFile(): cannot load" << plugin << "plugin";
+            return;
+        }
+
+        found = _importers.emplace(plugin, static_cast<PluginManager::Manager<AbstractImporter>*>(manager())->instantiate(plugin)).first;
     }
 
     /* Try to open the file (error output should be printed by the plugin
        itself) */
-    std::unique_ptr<AbstractImporter> importer = static_cast<PluginManager::Manager<AbstractImporter>*>(manager())->instantiate(plugin);
-    if(!importer->openFile(filename)) return;
+    if(!found->second->openFile(filename)) return;
 
-    /* Success, save the instance */
-    _in = std::move(importer);
+    /* Success, remember the instance */
+    _in = found->second.get();
 }
 
 UnsignedInt AnyImageImporter::doImage2DCount() const { return _in->image2DCount(); }
@@ -125,4 +192,4 @@ Containers::Optional<ImageData2D> AnyImageImporter::doImage2D(const UnsignedInt
 }}
 
 CORRADE_PLUGIN_REGISTER(AnyImageImporter, Magnum::Trade::AnyImageImporter,
-    "cz.mosra.magnum.Trade.AbstractImporter/0.3")
+    "cz.mosra.magnum.Trade.AbstractImporter/0.3.1")
@@ -29,6 +29,7 @@
  * @brief Class @ref Magnum::Trade::AnyImageImporter
  */
 
+#include <unordered_map>
 #include <Magnum/Trade/AbstractImporter.h>
 
 #include "MagnumPlugins/AnyImageImporter/configure.h"
@@ -54,8 +55,12 @@ namespace Magnum { namespace Trade {
 /**
 @brief Any image importer plugin
 
-Detects file type based on file extension, loads corresponding plugin and then
-tries to open the file with it.
+Detects file type based on file signature or, if the signature is not
+conclusive, file extension, loads corresponding plugin and then tries to open
+the file with it. Only the first few bytes of the file are read for the
+detection. Instances of the concrete plugins are kept for the whole lifetime
+of the importer, so opening more files of the same type loads and instantiates
+the plugin only once.
 
 This plugin depends on the @ref Trade library and is built if
 `WITH_ANYIMAGEIMPORTER` is enabled when building Magnum. To use as a dynamic
@@ -78,6 +83,8 @@ Supported formats:
     other plugin that provides it
 -   JPEG 2000 (`*.jp2`), loaded with any plugin that provides
     `Jpeg2000Importer`
+-   Khronos Texture (`*.ktx`), loaded with @ref KtxImporter or any other
+    plugin that provides it
 -   Multiple-image Network Graphics (`*.mng`), loaded with any plugin that
     provides `MngImporter`
 -   Portable Bitmap (`*.pbm`), loaded with any plugin that provides `PbmImporter`
@@ -119,7 +126,8 @@ class MAGNUM_ANYIMAGEIMPORTER_EXPORT AnyImageImporter: public AbstractImporter {
         MAGNUM_ANYIMAGEIMPORTER_LOCAL UnsignedInt doImage2DCount() const override;
         MAGNUM_ANYIMAGEIMPORTER_LOCAL Containers::Optional<ImageData2D> doImage2D(UnsignedInt id) override;
 
-        std::unique_ptr<AbstractImporter> _in;
+        std::unordered_map<std::string, std::unique_ptr<AbstractImporter>> _importers;
+        AbstractImporter* _in{};
 };
 
 }}
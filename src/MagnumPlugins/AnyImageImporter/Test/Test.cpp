@@ -38,6 +38,9 @@ struct AnyImageImporterTest: TestSuite::Tester {
     explicit AnyImageImporterTest();
 
     void tga();
+    void ktx();
+    void ktxMisnamed();
+    void reopen();
 
     void unknown();
 
@@ -47,6 +50,9 @@ struct AnyImageImporterTest: TestSuite::Tester {
 
 AnyImageImporterTest::AnyImageImporterTest() {
     addTests({&AnyImageImporterTest::tga,
+              &AnyImageImporterTest::ktx,
+              &AnyImageImporterTest::ktxMisnamed,
+              &AnyImageImporterTest::reopen,
 
               &AnyImageImporterTest::unknown});
 
@@ -59,6 +65,9 @@ AnyImageImporterTest::AnyImageImporterTest() {
     #ifdef TGAIMPORTER_PLUGIN_FILENAME
     CORRADE_INTERNAL_ASSERT(_manager.load(TGAIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
     #endif
+    #ifdef KTXIMPORTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT(_manager.load(KTXIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
 }
 
 void AnyImageImporterTest::tga() {
@@ -74,6 +83,55 @@ void AnyImageImporterTest::tga() {
     CORRADE_COMPARE(image->size(), Vector2i(2, 3));
 }
 
+void AnyImageImporterTest::ktx() {
+    if(!(_manager.loadState("KtxImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("KtxImporter plugin not enabled, cannot test");
+
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("AnyImageImporter");
+    CORRADE_VERIFY(importer->openFile(KTX_FILE));
+
+    /* The compressed data and all mip levels get through */
+    CORRADE_COMPARE(importer->image2DCount(), 4);
+    Containers::Optional<ImageData2D> image = importer->image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_VERIFY(image->isCompressed());
+    CORRADE_COMPARE(image->size(), Vector2i(8, 4));
+}
+
+void AnyImageImporterTest::ktxMisnamed() {
+    if(!(_manager.loadState("KtxImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("KtxImporter plugin not enabled, cannot test");
+
+    /* The extension is unknown, the file is detected from the contents */
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("AnyImageImporter");
+    CORRADE_VERIFY(importer->openFile(KTX_MISNAMED_FILE));
+    Containers::Optional<ImageData2D> image = importer->image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->size(), Vector2i(8, 4));
+}
+
+void AnyImageImporterTest::reopen() {
+    if(!(_manager.loadState("TgaImporter") & PluginManager::LoadState::Loaded) ||
+       !(_manager.loadState("KtxImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("TgaImporter or KtxImporter plugin not enabled, cannot test");
+
+    /* Switching between file types and back to an already instantiated
+       plugin */
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("AnyImageImporter");
+    CORRADE_VERIFY(importer->openFile(TGA_FILE));
+    CORRADE_VERIFY(importer->openFile(KTX_FILE));
+    CORRADE_COMPARE(importer->image2DCount(), 4);
+    CORRADE_VERIFY(importer->openFile(TGA_FILE));
+    CORRADE_COMPARE(importer->image2DCount(), 1);
+
+    Containers::Optional<ImageData2D> image = importer->image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->size(), Vector2i(2, 3));
+
+    importer->close();
+    CORRADE_VERIFY(!importer->isOpened());
+}
+
 void AnyImageImporterTest::unknown() {
     std::ostringstream output;
     Error redirectError{&output};
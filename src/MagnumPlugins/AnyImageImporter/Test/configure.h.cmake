@@ -25,4 +25,7 @@
 
 #cmakedefine ANYIMAGEIMPORTER_PLUGIN_FILENAME "${ANYIMAGEIMPORTER_PLUGIN_FILENAME}"
 #cmakedefine TGAIMPORTER_PLUGIN_FILENAME "${TGAIMPORTER_PLUGIN_FILENAME}"
+#cmakedefine KTXIMPORTER_PLUGIN_FILENAME "${KTXIMPORTER_PLUGIN_FILENAME}"
 #define TGA_FILE "${TGA_FILE}"
+#define KTX_FILE "${KTX_FILE}"
+#define KTX_MISNAMED_FILE "${KTX_MISNAMED_FILE}"
@@ -25,6 +25,8 @@
 
 #include "AnySceneImporter.h"
 
+#include <algorithm>
+#include <fstream>
 #include <Corrade/PluginManager/Manager.h>
 #include <Corrade/Utility/Assert.h>
 #include <Corrade/Utility/String.h>
@@ -32,6 +34,7 @@
 #include <Magnum/Trade/CameraData.h>
 #include <Magnum/Trade/ImageData.h>
 #include <Magnum/Trade/LightData.h>
+#include <Magnum/Trade/MeshData.h>
 #include <Magnum/Trade/MeshData2D.h>
 #include <Magnum/Trade/MeshData3D.h>
 #include <Magnum/Trade/ObjectData2D.h>
@@ -41,98 +44,156 @@
 
 namespace Magnum { namespace Trade {
 
-AnySceneImporter::AnySceneImporter(PluginManager::Manager<AbstractImporter>& manager): AbstractImporter{manager} {}
-
-AnySceneImporter::AnySceneImporter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractImporter{manager, plugin} {}
-
-AnySceneImporter::~AnySceneImporter() = default;
-
-auto AnySceneImporter::doFeatures() const -> Features { return {}; }
-
-bool AnySceneImporter::doIsOpened() const { return !!_in; }
-
-void AnySceneImporter::doClose() {
-    _in = nullptr;
+namespace {
+
+/* File signatures, checked before the extension. Text-based formats usually
+   don't have any reliable signature, these are detected by extension only. */
+struct Signature {
+    std::size_t offset;
+    const char* magic;
+    std::size_t size;
+    const char* plugin;
+};
+
+constexpr Signature Signatures[]{
+    {0, "glTF", 4, "GltfImporter"},
+    {0, "ply\n", 4, "StanfordImporter"},
+    {0, "ply\r\n", 5, "StanfordImporter"},
+    {0, "Kaydara FBX Binary", 18, "FbxImporter"},
+    {0, "BLENDER", 7, "BlenderImporter"},
+    {0, "MGNM", 4, "MagnumMeshImporter"}
+};
+
+/* Size of the file prefix needed to check all signatures */
+constexpr std::size_t SignaturePrefixSize = 32;
+
+std::string pluginForSignature(const std::string& filename) {
+    /* Read just the beginning of the file. If it can't be opened, the prefix
+       is empty and the detection falls back to the extension. The concrete
+       plugin then reports the error. */
+    std::ifstream file{filename, std::ifstream::binary};
+    char prefix[SignaturePrefixSize];
+    file.read(prefix, SignaturePrefixSize);
+    const std::size_t prefixSize = file.gcount();
+
+    for(const Signature& signature: Signatures)
+        if(signature.offset + signature.size <= prefixSize && std::equal(signature.magic, signature.magic + signature.size, prefix + signature.offset))
+            return signature.plugin;
+
+    return {};
 }
 
-void AnySceneImporter::doOpenFile(const std::string& filename) {
-    CORRADE_INTERNAL_ASSERT(manager());
-
-    /* Detect type from extension */
-    std::string plugin;
+/* Detects file type from its extension */
+std::string pluginForExtension(const std::string& filename) {
     if(Utility::String::endsWith(filename, ".3ds") ||
        Utility::String::endsWith(filename, ".ase"))
-        plugin = "3dsImporter";
+        return "3dsImporter";
     else if(Utility::String::endsWith(filename, ".ac"))
-        plugin = "Ac3dImporter";
+        return "Ac3dImporter";
     else if(Utility::String::endsWith(filename, ".blend"))
-        plugin = "BlenderImporter";
+        return "BlenderImporter";
     else if(Utility::String::endsWith(filename, ".bvh"))
-        plugin = "BvhImporter";
+        return "BvhImporter";
     else if(Utility::String::endsWith(filename, ".csm"))
-        plugin = "CsmImporter";
+        return "CsmImporter";
     else if(Utility::String::endsWith(filename, ".dae"))
-        plugin = "ColladaImporter";
+        return "ColladaImporter";
     else if(Utility::String::endsWith(filename, ".x"))
-        plugin = "DirectXImporter";
+        return "DirectXImporter";
     else if(Utility::String::endsWith(filename, ".dxf"))
-        plugin = "DxfImporter";
+        return "DxfImporter";
     else if(Utility::String::endsWith(filename, ".fbx"))
-        plugin = "FbxImporter";
+        return "FbxImporter";
     else if(Utility::String::endsWith(filename, ".gltf") ||
             Utility::String::endsWith(filename, ".glb"))
-        plugin = "GltfImporter";
+        return "GltfImporter";
     else if(Utility::String::endsWith(filename, ".ifc"))
-        plugin = "IfcImporter";
+        return "IfcImporter";
     else if(Utility::String::endsWith(filename, ".irrmesh") ||
             Utility::String::endsWith(filename, ".irr"))
-        plugin = "IrrlichtImporter";
+        return "IrrlichtImporter";
     else if(Utility::String::endsWith(filename, ".lwo") ||
             Utility::String::endsWith(filename, ".lws"))
-        plugin = "LightWaveImporter";
+        return "LightWaveImporter";
+    else if(Utility::String::endsWith(filename, ".magnum-mesh"))
+        return "MagnumMeshImporter";
     else if(Utility::String::endsWith(filename, ".lxo"))
-        plugin = "ModoImporter";
+        return "ModoImporter";
     else if(Utility::String::endsWith(filename, ".ms3d"))
-        plugin = "MilkshapeImporter";
+        return "MilkshapeImporter";
     else if(Utility::String::endsWith(filename, ".obj"))
-        plugin = "ObjImporter";
+        return "ObjImporter";
     else if(Utility::String::endsWith(filename, ".xml"))
-        plugin = "OgreImporter";
+        return "OgreImporter";
     else if(Utility::String::endsWith(filename, ".ogex"))
-        plugin = "OpenGexImporter";
+        return "OpenGexImporter";
     else if(Utility::String::endsWith(filename, ".ply"))
-        plugin = "StanfordImporter";
+        return "StanfordImporter";
     else if(Utility::String::endsWith(filename, ".stl"))
-        plugin = "StlImporter";
+        return "StlImporter";
     else if(Utility::String::endsWith(filename, ".cob") ||
             Utility::String::endsWith(filename, ".scn"))
-        plugin = "TrueSpaceImporter";
+        return "TrueSpaceImporter";
     else if(Utility::String::endsWith(filename, ".3d"))
-        plugin = "UnrealImporter";
+        return "UnrealImporter";
     else if(Utility::String::endsWith(filename, ".smd") ||
             Utility::String::endsWith(filename, ".vta"))
-        plugin = "ValveImporter";
+        return "ValveImporter";
     else if(Utility::String::endsWith(filename, ".xgl") ||
             Utility::String::endsWith(filename, ".zgl"))
-        plugin = "XglImporter";
-    else {
+        return "XglImporter";
+
+    return {};
+}
+
+}
+
+AnySceneImporter::AnySceneImporter(PluginManager::Manager<AbstractImporter>& manager): AbstractImporter{manager} {}
+
+AnySceneImporter::AnySceneImporter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractImporter{manager, plugin} {}
+
+AnySceneImporter::~AnySceneImporter() = default;
+
+auto AnySceneImporter::doFeatures() const -> Features { return {}; }
+
+bool AnySceneImporter::doIsOpened() const { return _in; }
+
+void AnySceneImporter::doClose() {
+    /* Keep the instance around for subsequent files of the same type */
+    _in->close();
+    _in = nullptr;
+}
+
+void AnySceneImporter::doOpenFile(const std::string& filename) {
+    CORRADE_INTERNAL_ASSERT(manager());
+
+    /* Detect type from file signature, if that's not conclusive from
+       extension */
+    std::string plugin = pluginForSignature(filename);
+    if(plugin.empty()) plugin = pluginForExtension(filename);
+    if(plugin.empty()) {
         Error() << "Trade::AnySceneImporter::openFile(): cannot determine type of file" << filename;
         return;
     }
 
-    /* Try to load the plugin */
-    if(!(manager()->load(plugin) & PluginManager::LoadState::Loaded)) {
-        Error() << "Trade::AnySceneImporter::openFile(): cannot load" << plugin << "plugin";
-        return;
+    /* Reuse an instance from previous files of the same type or try to load
+       the plugin and instantiate it */
+    auto found = _importers.find(plugin);
+    if(found == _importers.end()) {
+        if(!(manager()->load(plugin) & PluginManager::LoadState::Loaded)) {
+            Error() << "Trade::AnySceneImporter::openFile(): cannot load" << plugin << "plugin";
+            return;
+        }
+
+        found = _importers.emplace(plugin, static_cast<PluginManager::Manager<AbstractImporter>*>(manager())->instantiate(plugin)).first;
     }
 
     /* Try to open the file (error output should be printed by the plugin
        itself) */
-    std::unique_ptr<AbstractImporter> importer = static_cast<PluginManager::Manager<AbstractImporter>*>(manager())->instantiate(plugin);
-    if(!importer->openFile(filename)) return;
+    if(!found->second->openFile(filename)) return;
 
-    /* Success, save the instance */
-    _in = std::move(importer);
+    /* Success, remember the instance */
+    _in = found->second.get();
 }
 
 Int AnySceneImporter::doDefaultScene() { return _in->defaultScene(); }
@@ -172,6 +233,9 @@ Int AnySceneImporter::doMesh3DForName(const std::string& name) { return _in->mes
 std::string AnySceneImporter::doMesh3DName(const UnsignedInt id) { return _in->mesh3DName(id); }
 Containers::Optional<MeshData3D> AnySceneImporter::doMesh3D(const UnsignedInt id) { return _in->mesh3D(id); }
 
+UnsignedInt AnySceneImporter::doMeshCount() const { return _in->meshCount(); }
+Containers::Optional<MeshData> AnySceneImporter::doMesh(const UnsignedInt id) { return _in->mesh(id); }
+
 UnsignedInt AnySceneImporter::doMaterialCount() const { return _in->materialCount(); }
 Int AnySceneImporter::doMaterialForName(const std::string& name) { return _in->materialForName(name); }
 std::string AnySceneImporter::doMaterialName(const UnsignedInt id) { return _in->materialName(id); }
@@ -200,4 +264,4 @@ Containers::Optional<ImageData3D> AnySceneImporter::doImage3D(const UnsignedInt
 }}
 
 CORRADE_PLUGIN_REGISTER(AnySceneImporter, Magnum::Trade::AnySceneImporter,
-    "cz.mosra.magnum.Trade.AbstractImporter/0.3")
+    "cz.mosra.magnum.Trade.AbstractImporter/0.3.1")
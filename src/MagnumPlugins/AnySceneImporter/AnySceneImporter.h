@@ -29,6 +29,7 @@
  * @brief Class @ref Magnum::Trade::AnySceneImporter
  */
 
+#include <unordered_map>
 #include <Magnum/Trade/AbstractImporter.h>
 
 #include "MagnumPlugins/AnySceneImporter/configure.h"
@@ -54,8 +55,13 @@ namespace Magnum { namespace Trade {
 /**
 @brief Any scene importer plugin
 
-Detects file type based on file extension, loads corresponding plugin and then
-tries to open the file with it.
+Detects file type based on file signature or, if the signature is not
+conclusive, file extension, loads corresponding plugin and then tries to open
+the file with it. Only the first few bytes of the file are read for the
+detection. Binary glTF, FBX, Blender, Stanford PLY and Magnum mesh files are
+detected by their signature, remaining formats only by extension. Instances of
+the concrete plugins are kept for the whole lifetime of the importer, so opening
+more files of the same type loads and instantiates the plugin only once.
 
 This plugin depends on the @ref Trade library and is built if
 `WITH_ANYSCENEIMPORTER` is enabled when building Magnum. To use as a dynamic
@@ -88,6 +94,8 @@ Supported formats:
     provides `IrrlichtImporter`
 -   LightWave, LightWave Scene (`*.lwo`, `*.lws`), loaded with any plugin that
     provides `LightWaveImporter`
+-   Magnum mesh blob (`*.magnum-mesh`), loaded with @ref MagnumMeshImporter
+    or any other plugin that provides it
 -   Modo (`*.lxo`), loaded with any plugin that provides `ModoImporter`
 -   Milkshape 3D (`*.ms3d`), loaded with any plugin that provides
     `MilkshapeImporter`
@@ -162,6 +170,9 @@ class MAGNUM_ANYSCENEIMPORTER_EXPORT AnySceneImporter: public AbstractImporter {
         MAGNUM_ANYSCENEIMPORTER_LOCAL std::string doMesh3DName(UnsignedInt id) override;
         MAGNUM_ANYSCENEIMPORTER_LOCAL Containers::Optional<MeshData3D> doMesh3D(UnsignedInt id) override;
 
+        MAGNUM_ANYSCENEIMPORTER_LOCAL UnsignedInt doMeshCount() const override;
+        MAGNUM_ANYSCENEIMPORTER_LOCAL Containers::Optional<MeshData> doMesh(UnsignedInt id) override;
+
         MAGNUM_ANYSCENEIMPORTER_LOCAL UnsignedInt doMaterialCount() const override;
         MAGNUM_ANYSCENEIMPORTER_LOCAL Int doMaterialForName(const std::string& name) override;
         MAGNUM_ANYSCENEIMPORTER_LOCAL std::string doMaterialName(UnsignedInt id) override;
@@ -187,7 +198,8 @@ class MAGNUM_ANYSCENEIMPORTER_EXPORT AnySceneImporter: public AbstractImporter {
         MAGNUM_ANYSCENEIMPORTER_LOCAL std::string doImage3DName(UnsignedInt id) override;
         MAGNUM_ANYSCENEIMPORTER_LOCAL Containers::Optional<ImageData3D> doImage3D(UnsignedInt id) override;
 
-        std::unique_ptr<AbstractImporter> _in;
+        std::unordered_map<std::string, std::unique_ptr<AbstractImporter>> _importers;
+        AbstractImporter* _in{};
 };
 
 }}
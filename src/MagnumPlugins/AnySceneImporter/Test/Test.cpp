@@ -39,6 +39,7 @@ struct AnySceneImporterTest: TestSuite::Tester {
     explicit AnySceneImporterTest();
 
     void obj();
+    void reopen();
 
     void unknown();
 
@@ -48,6 +49,7 @@ struct AnySceneImporterTest: TestSuite::Tester {
 
 AnySceneImporterTest::AnySceneImporterTest() {
     addTests({&AnySceneImporterTest::obj,
+              &AnySceneImporterTest::reopen,
 
               &AnySceneImporterTest::unknown});
 
@@ -75,6 +77,22 @@ void AnySceneImporterTest::obj() {
     CORRADE_COMPARE(mesh->positions(0).size(), 3);
 }
 
+void AnySceneImporterTest::reopen() {
+    if(!(_manager.loadState("ObjImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("ObjImporter plugin not enabled, cannot test");
+
+    /* The second open reuses the ObjImporter instance */
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("AnySceneImporter");
+    CORRADE_VERIFY(importer->openFile(OBJ_FILE));
+    importer->close();
+    CORRADE_VERIFY(!importer->isOpened());
+    CORRADE_VERIFY(importer->openFile(OBJ_FILE));
+
+    Containers::Optional<MeshData3D> mesh = importer->mesh3D(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->positions(0).size(), 3);
+}
+
 void AnySceneImporterTest::unknown() {
     std::ostringstream output;
     Error redirectError{&output};
@@ -0,0 +1,59 @@
+#ifndef Magnum_Trade_KtxHeader_h
+#define Magnum_Trade_KtxHeader_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/Types.h"
+
+namespace Magnum { namespace Trade { namespace Implementation {
+
+/* KTX 1.1 file header. All fields are in the endianness of the machine that
+   wrote the file, which is detected from the endianness field. */
+struct KtxHeader {
+    char            identifier[12];     /* See KtxIdentifier below */
+    UnsignedInt     endianness;         /* 0x04030201 */
+    UnsignedInt     glType;             /* 0 for compressed data */
+    UnsignedInt     glTypeSize;         /* 1 for compressed data */
+    UnsignedInt     glFormat;           /* 0 for compressed data */
+    UnsignedInt     glInternalFormat;   /* Compressed format */
+    UnsignedInt     glBaseInternalFormat;
+    UnsignedInt     pixelWidth;
+    UnsignedInt     pixelHeight;        /* 0 for 1D images */
+    UnsignedInt     pixelDepth;         /* 0 for 1D and 2D images */
+    UnsignedInt     numberOfArrayElements; /* 0 for non-array textures */
+    UnsignedInt     numberOfFaces;      /* 6 for cube maps, 1 otherwise */
+    UnsignedInt     numberOfMipmapLevels; /* 0 if mips should be generated */
+    UnsignedInt     bytesOfKeyValueData;
+};
+
+static_assert(sizeof(KtxHeader) == 64, "KtxHeader size is not 64 bytes");
+
+constexpr char KtxIdentifier[12]{'\xAB', 'K', 'T', 'X', ' ', '1', '1', '\xBB', '\r', '\n', '\x1A', '\n'};
+
+constexpr UnsignedInt KtxEndianness = 0x04030201;
+
+}}}
+
+#endif
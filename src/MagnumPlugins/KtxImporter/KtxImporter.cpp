@@ -0,0 +1,155 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "KtxImporter.h"
+
+#include <algorithm>
+#include <cstring>
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Trade/ImageData.h"
+#include "MagnumPlugins/KtxImporter/KtxHeader.h"
+
+namespace Magnum { namespace Trade {
+
+KtxImporter::KtxImporter() = default;
+
+KtxImporter::KtxImporter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractImporter{manager, plugin} {}
+
+KtxImporter::~KtxImporter() = default;
+
+auto KtxImporter::doFeatures() const -> Features { return Feature::OpenMemory; }
+
+bool KtxImporter::doIsOpened() const { return !_levels.empty(); }
+
+void KtxImporter::doClose() {
+    _levels.clear();
+    _data = nullptr;
+}
+
+void KtxImporter::doOpenData(const Containers::ArrayView<const char> data) {
+    _data = Containers::Array<char>{data.size()};
+    std::copy(data.begin(), data.end(), _data.begin());
+    if(!parse(_data)) _data = nullptr;
+}
+
+void KtxImporter::doOpenMemory(const Containers::ArrayView<const char> memory) {
+    parse(memory);
+}
+
+bool KtxImporter::parse(const Containers::ArrayView<const char> data) {
+    /* Check if the file is long enough */
+    if(data.size() < sizeof(Implementation::KtxHeader)) {
+        Error() << "Trade::KtxImporter::openData(): the file is too short:" << data.size() << "bytes";
+        return false;
+    }
+
+    const Implementation::KtxHeader& header = *reinterpret_cast<const Implementation::KtxHeader*>(data.data());
+
+    if(std::memcmp(header.identifier, Implementation::KtxIdentifier, sizeof(Implementation::KtxIdentifier)) != 0) {
+        Error() << "Trade::KtxImporter::openData(): invalid file signature";
+        return false;
+    }
+
+    /* The file is written in the endianness of the machine that created it.
+       Compressed data are byte streams and so would be fine, but the header
+       would need swapping. */
+    if(header.endianness != Implementation::KtxEndianness) {
+        Error() << "Trade::KtxImporter::openData(): the file has different endianness than the machine";
+        return false;
+    }
+
+    if(header.glType != 0 || header.glFormat != 0 || header.glInternalFormat == 0) {
+        Error() << "Trade::KtxImporter::openData(): uncompressed files are not supported";
+        return false;
+    }
+
+    if(header.pixelWidth == 0 || header.pixelHeight == 0 || header.pixelDepth != 0 || header.numberOfArrayElements != 0 || header.numberOfFaces != 1) {
+        Error() << "Trade::KtxImporter::openData(): only 2D images are supported";
+        return false;
+    }
+
+    /* Skip the key/value data */
+    std::size_t offset = sizeof(Implementation::KtxHeader) + std::size_t(header.bytesOfKeyValueData);
+    if(data.size() < offset) {
+        Error() << "Trade::KtxImporter::openData(): the file is too short:" << data.size() << "bytes, expected at least" << offset;
+        return false;
+    }
+
+    /* Zero mip levels means the mips should be generated, there's just the
+       base level in the file */
+    const Vector2i size{Int(header.pixelWidth), Int(header.pixelHeight)};
+    const UnsignedInt levelCount = std::max(header.numberOfMipmapLevels, 1u);
+    std::vector<Level> levels;
+    levels.reserve(levelCount);
+    for(UnsignedInt i = 0; i != levelCount; ++i) {
+        if(data.size() < offset + 4) {
+            Error() << "Trade::KtxImporter::openData(): the file is too short:" << data.size() << "bytes, expected at least" << offset + 4;
+            return false;
+        }
+
+        UnsignedInt imageSize;
+        std::memcpy(&imageSize, data + offset, 4);
+        offset += 4;
+
+        if(data.size() < offset + imageSize) {
+            Error() << "Trade::KtxImporter::openData(): the file is too short:" << data.size() << "bytes, expected at least" << offset + imageSize;
+            return false;
+        }
+
+        levels.push_back({Math::max(size >> Int(i), 1), data.slice(offset, offset + imageSize)});
+
+        /* Each level is padded to four bytes */
+        offset += (imageSize + 3) & ~3;
+    }
+
+    _format = CompressedPixelFormat(header.glInternalFormat);
+    _levels = std::move(levels);
+    return true;
+}
+
+UnsignedInt KtxImporter::doImage2DCount() const { return _levels.size(); }
+
+Containers::Optional<ImageData2D> KtxImporter::doImage2D(const UnsignedInt id) {
+    const Level& level = _levels[id];
+
+    /* Compressed data need no conversion, so if the memory was passed by the
+       user, reference it directly instead of making a copy */
+    Containers::Array<char> data;
+    if(!_data && !isFileMapped())
+        data = nonOwnedArray(level.data);
+    else {
+        data = Containers::Array<char>{level.data.size()};
+        std::copy(level.data.begin(), level.data.end(), data.begin());
+    }
+
+    return ImageData2D{_format, level.size, std::move(data)};
+}
+
+}}
+
+CORRADE_PLUGIN_REGISTER(KtxImporter, Magnum::Trade::KtxImporter,
+    "cz.mosra.magnum.Trade.AbstractImporter/0.3.1")
@@ -0,0 +1,134 @@
+#ifndef Magnum_Trade_KtxImporter_h
+#define Magnum_Trade_KtxImporter_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Trade::KtxImporter
+ */
+
+#include <vector>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/VisibilityMacros.h>
+
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Vector2.h"
+#include "Magnum/Trade/AbstractImporter.h"
+
+#include "MagnumPlugins/KtxImporter/configure.h"
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+#ifndef MAGNUM_KTXIMPORTER_BUILD_STATIC
+    #ifdef KtxImporter_EXPORTS
+        #define MAGNUM_KTXIMPORTER_EXPORT CORRADE_VISIBILITY_EXPORT
+    #else
+        #define MAGNUM_KTXIMPORTER_EXPORT CORRADE_VISIBILITY_IMPORT
+    #endif
+#else
+    #define MAGNUM_KTXIMPORTER_EXPORT CORRADE_VISIBILITY_STATIC
+#endif
+#define MAGNUM_KTXIMPORTER_LOCAL CORRADE_VISIBILITY_LOCAL
+#else
+#define MAGNUM_KTXIMPORTER_EXPORT
+#define MAGNUM_KTXIMPORTER_LOCAL
+#endif
+
+namespace Magnum { namespace Trade {
+
+/**
+@brief KTX importer plugin
+
+Supports Khronos Texture (`*.ktx`) version 1.1 files containing compressed 2D
+images. The compressed payload is imported as-is, without any decoding, so
+BCn (S3TC, RGTC, BPTC), ETC2/EAC and ASTC data can be uploaded directly to the
+GPU.
+
+This plugin depends on the @ref Trade library and is built if `WITH_KTXIMPORTER`
+is enabled when building Magnum. To use as a dynamic plugin, you need to load
+the @cpp "KtxImporter" @ce plugin from `MAGNUM_PLUGINS_IMPORTER_DIR`. To use as
+a static plugin or use this as a dependency of another plugin with CMake, you
+need to request the `KtxImporter` component of the `Magnum` package and link to
+the `Magnum::KtxImporter` target. See @ref building, @ref cmake and
+@ref plugins for more information.
+
+Each mip level in the file is imported as a separate image, starting with the
+base level, so @ref image2DCount() is equal to the mip level count. The images
+are compressed, with @ref ImageData::compressedFormat() set directly from the
+`glInternalFormat` field of the file header. The format value is not checked
+against @ref CompressedPixelFormat, unsupported formats are reported by the
+driver on upload. A complete mip chain can be uploaded for example like this:
+
+@code{.cpp}
+Texture2D texture;
+Containers::Optional<Trade::ImageData2D> image = importer->image2D(0);
+texture.setStorage(importer->image2DCount(), TextureFormat(GLenum(image->compressedFormat())), image->size());
+for(UnsignedInt level = 0; level != importer->image2DCount(); ++level)
+    texture.setCompressedSubImage(level, {}, *importer->image2D(level));
+@endcode
+
+Uncompressed data, 1D, 3D, array and cube map textures are not supported, nor
+are files with endianness different from the machine endianness. The
+key/value metadata are skipped.
+
+The plugin supports @ref Feature::OpenMemory, files opened with
+@ref openFile() are memory-mapped and the compressed data are copied directly
+from the mapping. Images from memory passed to @ref openMemory() aren't copied
+at all --- the returned image data reference the memory directly and stay
+valid as long as the memory does, even after the importer is closed.
+*/
+class MAGNUM_KTXIMPORTER_EXPORT KtxImporter: public AbstractImporter {
+    public:
+        /** @brief Default constructor */
+        explicit KtxImporter();
+
+        /** @brief Plugin manager constructor */
+        explicit KtxImporter(PluginManager::AbstractManager& manager, const std::string& plugin);
+
+        ~KtxImporter();
+
+    private:
+        struct Level {
+            Vector2i size;
+            Containers::ArrayView<const char> data;
+        };
+
+        Features MAGNUM_KTXIMPORTER_LOCAL doFeatures() const override;
+        bool MAGNUM_KTXIMPORTER_LOCAL doIsOpened() const override;
+        void MAGNUM_KTXIMPORTER_LOCAL doOpenData(Containers::ArrayView<const char> data) override;
+        void MAGNUM_KTXIMPORTER_LOCAL doOpenMemory(Containers::ArrayView<const char> memory) override;
+        void MAGNUM_KTXIMPORTER_LOCAL doClose() override;
+        UnsignedInt MAGNUM_KTXIMPORTER_LOCAL doImage2DCount() const override;
+        Containers::Optional<ImageData2D> MAGNUM_KTXIMPORTER_LOCAL doImage2D(UnsignedInt id) override;
+
+        bool MAGNUM_KTXIMPORTER_LOCAL parse(Containers::ArrayView<const char> data);
+
+        Containers::Array<char> _data;
+        CompressedPixelFormat _format;
+        std::vector<Level> _levels;
+};
+
+}}
+
+#endif
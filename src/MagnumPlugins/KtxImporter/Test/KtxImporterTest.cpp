@@ -0,0 +1,230 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/PluginManager/Manager.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/Directory.h>
+
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/ImageData.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Trade { namespace Test {
+
+struct KtxImporterTest: TestSuite::Tester {
+    explicit KtxImporterTest();
+
+    void invalid();
+
+    void openData();
+    void openFile();
+    void openMemory();
+    void zeroMipLevels();
+
+    /* Explicitly forbid system-wide plugin dependencies */
+    PluginManager::Manager<AbstractImporter> _manager{"nonexistent"};
+};
+
+namespace {
+
+enum: std::size_t { InvalidDataCount = 10 };
+
+/* Each case patches a single byte of the valid file (or truncates it, if the
+   size is less than the file size) */
+struct {
+    const char* name;
+    std::size_t offset;
+    char value;
+    std::size_t size;
+    const char* message;
+} InvalidData[InvalidDataCount]{
+    {"too short", 0, '\xab', 63,
+        "the file is too short: 63 bytes"},
+    {"invalid signature", 1, 'k', 188,
+        "invalid file signature"},
+    {"different endianness", 12, 0x04, 188,
+        "the file has different endianness than the machine"},
+    {"uncompressed", 16, 0x01, 188,
+        "uncompressed files are not supported"},
+    {"3D", 44, 0x01, 188,
+        "only 2D images are supported"},
+    {"array", 48, 0x01, 188,
+        "only 2D images are supported"},
+    {"cube map", 52, 0x06, 188,
+        "only 2D images are supported"},
+    {"key/value data too long", 60, '\xff', 188,
+        "the file is too short: 188 bytes, expected at least 319"},
+    {"level size truncated", 0, '\xab', 170,
+        "the file is too short: 170 bytes, expected at least 172"},
+    {"level data truncated", 0, '\xab', 187,
+        "the file is too short: 187 bytes, expected at least 188"}
+};
+
+const Vector2i LevelSizes[]{{8, 4}, {4, 2}, {2, 1}, {1, 1}};
+
+/* Levels contain consecutive bytes starting at these values */
+const char LevelData[]{'\x00', '\x40', '\x50', '\x60'};
+
+/* Offsets of level data in the file */
+const std::size_t LevelOffsets[]{96, 132, 152, 172};
+
+void verifyImage(const ImageData2D& image, UnsignedInt level) {
+    CORRADE_VERIFY(image.isCompressed());
+    CORRADE_COMPARE(image.compressedFormat(), CompressedPixelFormat::RGBAS3tcDxt5);
+    CORRADE_COMPARE(image.size(), LevelSizes[level]);
+
+    std::vector<char> expected(level ? 16 : 32);
+    for(std::size_t i = 0; i != expected.size(); ++i)
+        expected[i] = LevelData[level] + i;
+    CORRADE_COMPARE_AS((std::vector<char>{image.data().begin(), image.data().end()}), expected,
+        TestSuite::Compare::Container);
+}
+
+}
+
+KtxImporterTest::KtxImporterTest() {
+    addInstancedTests({&KtxImporterTest::invalid}, InvalidDataCount);
+
+    addTests({&KtxImporterTest::openData,
+              &KtxImporterTest::openFile,
+              &KtxImporterTest::openMemory,
+              &KtxImporterTest::zeroMipLevels});
+
+    /* Load the plugin directly from the build tree. Otherwise it's static and
+       already loaded. */
+    #ifdef KTXIMPORTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT(_manager.load(KTXIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+}
+
+void KtxImporterTest::invalid() {
+    #ifdef CORRADE_TARGET_BIG_ENDIAN
+    CORRADE_SKIP("The test file is little-endian.");
+    #endif
+
+    const auto& data = InvalidData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Array<char> file = Utility::Directory::read(Utility::Directory::join(KTXIMPORTER_TEST_DIR, "file.ktx"));
+    CORRADE_COMPARE(file.size(), 188);
+    file[data.offset] = data.value;
+
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("KtxImporter");
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->openData(file.prefix(data.size)));
+    CORRADE_COMPARE(out.str(), std::string{"Trade::KtxImporter::openData(): "} + data.message + "\n");
+}
+
+void KtxImporterTest::openData() {
+    #ifdef CORRADE_TARGET_BIG_ENDIAN
+    CORRADE_SKIP("The test file is little-endian.");
+    #endif
+
+    const Containers::Array<char> file = Utility::Directory::read(Utility::Directory::join(KTXIMPORTER_TEST_DIR, "file.ktx"));
+
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("KtxImporter");
+    CORRADE_VERIFY(importer->openData(file));
+    CORRADE_COMPARE(importer->image2DCount(), 4);
+
+    for(UnsignedInt i = 0; i != importer->image2DCount(); ++i) {
+        CORRADE_ITERATION(i);
+
+        Containers::Optional<ImageData2D> image = importer->image2D(i);
+        CORRADE_VERIFY(image);
+        verifyImage(*image, i);
+
+        /* The data get copied */
+        CORRADE_VERIFY(image->data().data() != file + LevelOffsets[i]);
+    }
+}
+
+void KtxImporterTest::openFile() {
+    #ifdef CORRADE_TARGET_BIG_ENDIAN
+    CORRADE_SKIP("The test file is little-endian.");
+    #endif
+
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("KtxImporter");
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(KTXIMPORTER_TEST_DIR, "file.ktx")));
+    CORRADE_COMPARE(importer->image2DCount(), 4);
+
+    Containers::Optional<ImageData2D> image = importer->image2D(1);
+    CORRADE_VERIFY(image);
+
+    /* The data are copied out of the file mapping, so they stay valid after
+       closing */
+    importer->close();
+    verifyImage(*image, 1);
+}
+
+void KtxImporterTest::openMemory() {
+    #ifdef CORRADE_TARGET_BIG_ENDIAN
+    CORRADE_SKIP("The test file is little-endian.");
+    #endif
+
+    const Containers::Array<char> file = Utility::Directory::read(Utility::Directory::join(KTXIMPORTER_TEST_DIR, "file.ktx"));
+
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("KtxImporter");
+    CORRADE_VERIFY(importer->openMemory(file));
+    CORRADE_COMPARE(importer->image2DCount(), 4);
+
+    Containers::Optional<ImageData2D> image = importer->image2D(2);
+    CORRADE_VERIFY(image);
+
+    /* The data reference the memory directly and stay valid after closing */
+    importer->close();
+    CORRADE_VERIFY(image->data().data() == file + LevelOffsets[2]);
+    verifyImage(*image, 2);
+}
+
+void KtxImporterTest::zeroMipLevels() {
+    #ifdef CORRADE_TARGET_BIG_ENDIAN
+    CORRADE_SKIP("The test file is little-endian.");
+    #endif
+
+    Containers::Array<char> file = Utility::Directory::read(Utility::Directory::join(KTXIMPORTER_TEST_DIR, "file.ktx"));
+    CORRADE_COMPARE(file.size(), 188);
+    file[56] = 0;
+
+    /* Only the base level is imported, the rest of the file is ignored */
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("KtxImporter");
+    CORRADE_VERIFY(importer->openData(file));
+    CORRADE_COMPARE(importer->image2DCount(), 1);
+
+    Containers::Optional<ImageData2D> image = importer->image2D(0);
+    CORRADE_VERIFY(image);
+    verifyImage(*image, 0);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::KtxImporterTest)
@@ -0,0 +1,65 @@
+#ifndef Magnum_Text_MagnumFont_BinaryFormat_h
+#define Magnum_Text_MagnumFont_BinaryFormat_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Range.h"
+
+namespace Magnum { namespace Text { namespace Implementation {
+
+/* Binary MagnumFont file, little-endian. Consists of the header, followed by
+   glyphCount MagnumFontBinaryGlyph structures, charCount
+   MagnumFontBinaryChar structures and imageSize.x()*imageSize.y() bytes of
+   single-channel glyph cache image with rows tightly packed. All parts are
+   four-byte aligned so they can be used directly from a memory-mapped
+   file. */
+struct MagnumFontBinaryHeader {
+    char magic[4];              /* "MGNF" */
+    UnsignedInt version;        /* 1 */
+    Float fontSize, ascent, descent, lineHeight;
+    Vector2i originalImageSize, padding, imageSize;
+    UnsignedInt glyphCount, charCount;
+};
+
+struct MagnumFontBinaryGlyph {
+    Vector2 advance;
+    Vector2i position;
+    Range2Di rectangle;
+};
+
+struct MagnumFontBinaryChar {
+    UnsignedInt unicode, glyph;
+};
+
+static_assert(sizeof(MagnumFontBinaryHeader) == 56, "Improper size of binary font header");
+static_assert(sizeof(MagnumFontBinaryGlyph) == 32, "Improper size of binary font glyph");
+static_assert(sizeof(MagnumFontBinaryChar) == 8, "Improper size of binary font char");
+
+constexpr char MagnumFontBinaryMagic[4]{'M', 'G', 'N', 'F'};
+
+}}}
+
+#endif
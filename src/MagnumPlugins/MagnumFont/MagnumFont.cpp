@@ -25,23 +25,28 @@
 
 #include "MagnumFont.h"
 
+#include <cstring>
+#include <fstream>
 #include <sstream>
-#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Containers/Array.h>
 #include <Corrade/Utility/Configuration.h>
 #include <Corrade/Utility/Directory.h>
 #include <Corrade/Utility/Unicode.h>
 
+#include "Magnum/PixelFormat.h"
 #include "Magnum/Text/GlyphCache.h"
 #include "Magnum/Trade/ImageData.h"
+#include "MagnumPlugins/MagnumFont/BinaryFormat.h"
 #include "MagnumPlugins/TgaImporter/TgaImporter.h"
 
 namespace Magnum { namespace Text {
 
 struct MagnumFont::Data {
-    Utility::Configuration conf;
     Trade::ImageData2D image;
-    std::unordered_map<char32_t, UnsignedInt> glyphId;
+    Vector2i originalImageSize, padding;
+    Implementation::GlyphTable glyphId;
     std::vector<Vector2> glyphAdvance;
+    std::vector<std::pair<Vector2i, Range2Di>> glyphs;
 };
 
 namespace {
@@ -70,7 +75,11 @@ auto MagnumFont::doFeatures() const -> Features { return Feature::OpenData|Featu
 bool MagnumFont::doIsOpened() const { return _opened; }
 
 auto MagnumFont::doOpenData(const std::vector<std::pair<std::string, Containers::ArrayView<const char>>>& data, const Float) -> Metrics {
-    /* We need just the configuration file and image file */
+    /* Binary font is a single file */
+    if(data.size() == 1 && data[0].second.size() >= sizeof(Implementation::MagnumFontBinaryMagic) && std::memcmp(data[0].second.data(), Implementation::MagnumFontBinaryMagic, sizeof(Implementation::MagnumFontBinaryMagic)) == 0)
+        return openBinaryInternal(data[0].second, "Text::MagnumFont::openData():");
+
+    /* Otherwise we need just the configuration file and image file */
     if(data.size() != 2) {
         Error() << "Text::MagnumFont::openData(): wanted two files, got" << data.size();
         return {};
@@ -115,6 +124,17 @@ auto MagnumFont::doOpenData(const std::vector<std::pair<std::string, Containers:
 }
 
 auto MagnumFont::doOpenFile(const std::string& filename, Float) -> Metrics {
+    /* Binary font, detected by its magic */
+    {
+        std::ifstream in{filename, std::ios::binary};
+        char magic[sizeof(Implementation::MagnumFontBinaryMagic)];
+        if(in.read(magic, sizeof(magic)) && std::memcmp(magic, Implementation::MagnumFontBinaryMagic, sizeof(magic)) == 0) {
+            in.close();
+            const Containers::Array<char> data = Utility::Directory::read(filename);
+            return openBinaryInternal({data.data(), data.size()}, "Text::MagnumFont::openFile():");
+        }
+    }
+
     /* Open the configuration file */
     Utility::Configuration conf(filename, Utility::Configuration::Flag::ReadOnly|Utility::Configuration::Flag::SkipComments);
     if(!conf.isValid() || conf.isEmpty()) {
@@ -147,26 +167,97 @@ auto MagnumFont::doOpenFile(const std::string& filename, Float) -> Metrics {
 
 auto MagnumFont::openInternal(Utility::Configuration&& conf, Trade::ImageData2D&& image) -> Metrics {
     /* Everything okay, save the data internally */
-    _opened = new Data{std::move(conf), std::move(image), std::unordered_map<char32_t, UnsignedInt>{}, {}};
+    _opened = new Data{std::move(image),
+        conf.value<Vector2i>("originalImageSize"),
+        conf.value<Vector2i>("padding"),
+        Implementation::GlyphTable{}, {}, {}};
 
-    /* Glyph advances */
-    const std::vector<Utility::ConfigurationGroup*> glyphs = _opened->conf.groups("glyph");
+    /* Glyph advances and their positions in the cache */
+    const std::vector<Utility::ConfigurationGroup*> glyphs = conf.groups("glyph");
     _opened->glyphAdvance.reserve(glyphs.size());
-    for(const Utility::ConfigurationGroup* const g: glyphs)
+    _opened->glyphs.reserve(glyphs.size());
+    for(const Utility::ConfigurationGroup* const g: glyphs) {
         _opened->glyphAdvance.push_back(g->value<Vector2>("advance"));
+        _opened->glyphs.emplace_back(g->value<Vector2i>("position"), g->value<Range2Di>("rectangle"));
+    }
 
     /* Fill character->glyph map */
-    const std::vector<Utility::ConfigurationGroup*> chars = _opened->conf.groups("char");
+    const std::vector<Utility::ConfigurationGroup*> chars = conf.groups("char");
     for(const Utility::ConfigurationGroup* const c: chars) {
         const UnsignedInt glyphId = c->value<UnsignedInt>("glyph");
         CORRADE_INTERNAL_ASSERT(glyphId < _opened->glyphAdvance.size());
-        _opened->glyphId.emplace(c->value<char32_t>("unicode"), glyphId);
+        _opened->glyphId.set(c->value<char32_t>("unicode"), glyphId);
+    }
+
+    return {conf.value<Float>("fontSize"),
+            conf.value<Float>("ascent"),
+            conf.value<Float>("descent"),
+            conf.value<Float>("lineHeight")};
+}
+
+auto MagnumFont::openBinaryInternal(const Containers::ArrayView<const char> data, const char* const messagePrefix) -> Metrics {
+    #ifdef CORRADE_TARGET_BIG_ENDIAN
+    static_cast<void>(data);
+    Error() << messagePrefix << "binary fonts are not supported on big-endian platforms";
+    return {};
+    #else
+    /* Check the header */
+    if(data.size() < sizeof(Implementation::MagnumFontBinaryHeader)) {
+        Error() << messagePrefix << "binary file too short, expected at least" << sizeof(Implementation::MagnumFontBinaryHeader) << "bytes but got" << data.size();
+        return {};
+    }
+    Implementation::MagnumFontBinaryHeader header;
+    std::memcpy(&header, data.data(), sizeof(header));
+    if(header.version != 1) {
+        Error() << messagePrefix << "unsupported binary file version, expected 1 but got" << header.version;
+        return {};
+    }
+
+    /* Check the total size */
+    const std::size_t glyphOffset = sizeof(Implementation::MagnumFontBinaryHeader);
+    const std::size_t charOffset = glyphOffset + header.glyphCount*sizeof(Implementation::MagnumFontBinaryGlyph);
+    const std::size_t imageOffset = charOffset + header.charCount*sizeof(Implementation::MagnumFontBinaryChar);
+    const std::size_t imageDataSize = std::size_t(header.imageSize.product());
+    if(data.size() != imageOffset + imageDataSize) {
+        Error() << messagePrefix << "binary file size mismatch, expected" << imageOffset + imageDataSize << "bytes but got" << data.size();
+        return {};
+    }
+
+    /* Glyph data, copied as a whole */
+    std::vector<Implementation::MagnumFontBinaryGlyph> glyphs(header.glyphCount);
+    std::vector<Implementation::MagnumFontBinaryChar> chars(header.charCount);
+    std::memcpy(glyphs.data(), data.data() + glyphOffset, glyphs.size()*sizeof(Implementation::MagnumFontBinaryGlyph));
+    std::memcpy(chars.data(), data.data() + charOffset, chars.size()*sizeof(Implementation::MagnumFontBinaryChar));
+    for(const Implementation::MagnumFontBinaryChar& c: chars) if(c.glyph >= header.glyphCount) {
+        Error() << messagePrefix << "glyph" << c.glyph << "out of range for" << header.glyphCount << "glyphs";
+        return {};
+    }
+
+    /* Glyph cache image */
+    Containers::Array<char> imageData{Containers::NoInit, imageDataSize};
+    std::memcpy(imageData.data(), data.data() + imageOffset, imageDataSize);
+    #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+    constexpr PixelFormat format = PixelFormat::Red;
+    #else
+    constexpr PixelFormat format = PixelFormat::Luminance;
+    #endif
+
+    /* Everything okay, save the data internally */
+    _opened = new Data{
+        Trade::ImageData2D{PixelStorage{}.setAlignment(1), format, PixelType::UnsignedByte, header.imageSize, std::move(imageData)},
+        header.originalImageSize, header.padding,
+        Implementation::GlyphTable{}, {}, {}};
+    _opened->glyphAdvance.reserve(glyphs.size());
+    _opened->glyphs.reserve(glyphs.size());
+    for(const Implementation::MagnumFontBinaryGlyph& g: glyphs) {
+        _opened->glyphAdvance.push_back(g.advance);
+        _opened->glyphs.emplace_back(g.position, g.rectangle);
     }
+    for(const Implementation::MagnumFontBinaryChar& c: chars)
+        _opened->glyphId.set(c.unicode, c.glyph);
 
-    return {_opened->conf.value<Float>("fontSize"),
-            _opened->conf.value<Float>("ascent"),
-            _opened->conf.value<Float>("descent"),
-            _opened->conf.value<Float>("lineHeight")};
+    return {header.fontSize, header.ascent, header.descent, header.lineHeight};
+    #endif
 }
 
 void MagnumFont::doClose() {
@@ -175,8 +266,7 @@ void MagnumFont::doClose() {
 }
 
 UnsignedInt MagnumFont::doGlyphId(const char32_t character) {
-    auto it = _opened->glyphId.find(character);
-    return it != _opened->glyphId.end() ? it->second : 0;
+    return _opened->glyphId[character];
 }
 
 Vector2 MagnumFont::doGlyphAdvance(const UnsignedInt glyph) {
@@ -186,15 +276,14 @@ Vector2 MagnumFont::doGlyphAdvance(const UnsignedInt glyph) {
 std::unique_ptr<GlyphCache> MagnumFont::doCreateGlyphCache() {
     /* Set cache image */
     std::unique_ptr<GlyphCache> cache(new Text::GlyphCache(
-        _opened->conf.value<Vector2i>("originalImageSize"),
+        _opened->originalImageSize,
         _opened->image.size(),
-        _opened->conf.value<Vector2i>("padding")));
+        _opened->padding));
     cache->setImage({}, _opened->image);
 
     /* Fill glyph map */
-    const std::vector<Utility::ConfigurationGroup*> glyphs = _opened->conf.groups("glyph");
-    for(std::size_t i = 0; i != glyphs.size(); ++i)
-        cache->insert(i, glyphs[i]->value<Vector2i>("position"), glyphs[i]->value<Range2Di>("rectangle"));
+    for(std::size_t i = 0; i != _opened->glyphs.size(); ++i)
+        cache->insert(i, _opened->glyphs[i].first, _opened->glyphs[i].second);
 
     return cache;
 }
@@ -206,8 +295,7 @@ std::unique_ptr<AbstractLayouter> MagnumFont::doLayout(const GlyphCache& cache,
     for(std::size_t i = 0; i != text.size(); ) {
         UnsignedInt codepoint;
         std::tie(codepoint, i) = Utility::Unicode::nextChar(text, i);
-        const auto it = _opened->glyphId.find(codepoint);
-        glyphs.push_back(it == _opened->glyphId.end() ? 0 : it->second);
+        glyphs.push_back(_opened->glyphId[codepoint]);
     }
 
     return std::unique_ptr<MagnumFontLayouter>(new MagnumFontLayouter(_opened->glyphAdvance, cache, this->size(), size, std::move(glyphs)));
@@ -121,6 +121,23 @@ rectangle=45 0 44 25
 
 # ...
 @endcode
+
+@section Text-MagnumFont-binary Binary format
+
+Besides the above, the plugin can open a single-file binary variant of the
+font, which can be produced by @ref MagnumFontConverter when given a filename
+ending with `.magnumfont`. The binary file contains the same information,
+including the glyph cache image, is recognized by its `MGNF` magic and is
+loaded with just a few copies and no parsing, which makes it suitable for
+fast application startup. It's loaded either using @ref openFile() or
+passing a single file to @ref openData().
+
+The file is little-endian and consists of a header with font metrics, glyph
+cache image size, padding and glyph and character count, an array of glyph
+advances, positions and rectangles, an array of UTF-32 codepoint and glyph ID
+pairs and finally the tightly packed single-channel glyph cache image. All
+parts are four-byte aligned. Binary fonts are not supported on big-endian
+platforms.
 */
 class MAGNUM_MAGNUMFONT_EXPORT MagnumFont: public AbstractFont {
     public:
@@ -147,6 +164,7 @@ class MAGNUM_MAGNUMFONT_EXPORT MagnumFont: public AbstractFont {
         MAGNUM_MAGNUMFONT_LOCAL std::unique_ptr<AbstractLayouter> doLayout(const GlyphCache& cache, Float size, const std::string& text) override;
 
         MAGNUM_MAGNUMFONT_LOCAL Metrics openInternal(Utility::Configuration&& conf, Trade::ImageData2D&& image);
+        MAGNUM_MAGNUMFONT_LOCAL Metrics openBinaryInternal(Containers::ArrayView<const char> data, const char* messagePrefix);
 
         Data* _opened;
 };
@@ -23,13 +23,16 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <cstring>
 #include <sstream>
+#include <Corrade/Containers/Array.h>
 #include <Corrade/Utility/Directory.h>
 
 #include "Magnum/OpenGLTester.h"
 #include "Magnum/Text/AbstractFont.h"
 #include "Magnum/Text/GlyphCache.h"
 #include "Magnum/Trade/AbstractImporter.h"
+#include "MagnumPlugins/MagnumFont/BinaryFormat.h"
 
 #include "configure.h"
 
@@ -42,6 +45,8 @@ struct MagnumFontGLTest: OpenGLTester {
     void properties();
     void layout();
     void createGlyphCache();
+    void openBinary();
+    void openBinaryInvalid();
 
     /* Explicitly forbid system-wide plugin dependencies */
     PluginManager::Manager<Trade::AbstractImporter> _importerManager{"nonexistent"};
@@ -52,7 +57,9 @@ MagnumFontGLTest::MagnumFontGLTest() {
     addTests({&MagnumFontGLTest::nonexistent,
               &MagnumFontGLTest::properties,
               &MagnumFontGLTest::layout,
-              &MagnumFontGLTest::createGlyphCache});
+              &MagnumFontGLTest::createGlyphCache,
+              &MagnumFontGLTest::openBinary,
+              &MagnumFontGLTest::openBinaryInvalid});
 
     /* Load the plugins directly from the build tree. Otherwise they're static
        and already loaded. */
@@ -141,6 +148,92 @@ void MagnumFontGLTest::createGlyphCache() {
     /** @todo properly test contents */
 }
 
+namespace {
+
+/* Same contents as font.conf, with a 4x2 image */
+Containers::Array<char> binaryFont() {
+    Implementation::MagnumFontBinaryHeader header{};
+    std::memcpy(header.magic, Implementation::MagnumFontBinaryMagic, sizeof(header.magic));
+    header.version = 1;
+    header.fontSize = 16.0f;
+    header.ascent = 25.0f;
+    header.descent = -10.0f;
+    header.lineHeight = 39.7333f;
+    header.originalImageSize = Vector2i{1536};
+    header.padding = Vector2i{24};
+    header.imageSize = {4, 2};
+    header.glyphCount = 3;
+    header.charCount = 4;
+
+    const Implementation::MagnumFontBinaryGlyph glyphs[]{
+        {{8.0f, 0.0f}, {24, 24}, {{24, 24}, {-24, -24}}},
+        {{12.0f, 0.0f}, {25, 12}, {{16, 4}, {64, 32}}},
+        {{23.0f, 0.0f}, {25, 34}, {{0, 8}, {16, 128}}}
+    };
+    const Implementation::MagnumFontBinaryChar chars[]{
+        {U'W', 2}, {U'a', 0}, {U'e', 1}, {U'v', 0}
+    };
+    const char image[]{0, 1, 2, 3, 4, 5, 6, 7};
+
+    Containers::Array<char> data{sizeof(header) + sizeof(glyphs) + sizeof(chars) + sizeof(image)};
+    std::memcpy(data.data(), &header, sizeof(header));
+    std::memcpy(data.data() + sizeof(header), glyphs, sizeof(glyphs));
+    std::memcpy(data.data() + sizeof(header) + sizeof(glyphs), chars, sizeof(chars));
+    std::memcpy(data.data() + sizeof(header) + sizeof(glyphs) + sizeof(chars), image, sizeof(image));
+    return data;
+}
+
+}
+
+void MagnumFontGLTest::openBinary() {
+    #ifdef CORRADE_TARGET_BIG_ENDIAN
+    CORRADE_SKIP("Binary fonts are not supported on big-endian platforms.");
+    #endif
+
+    std::unique_ptr<AbstractFont> font = _fontManager.instantiate("MagnumFont");
+
+    const Containers::Array<char> data = binaryFont();
+    CORRADE_VERIFY(font->openData({{"font.magnumfont", {data.data(), data.size()}}}, 0.0f));
+    CORRADE_COMPARE(font->size(), 16.0f);
+    CORRADE_COMPARE(font->ascent(), 25.0f);
+    CORRADE_COMPARE(font->descent(), -10.0f);
+    CORRADE_COMPARE(font->lineHeight(), 39.7333f);
+    CORRADE_COMPARE(font->glyphId(U'W'), 2);
+    CORRADE_COMPARE(font->glyphId(U'e'), 1);
+    CORRADE_COMPARE(font->glyphId(U'x'), 0);
+    CORRADE_COMPARE(font->glyphAdvance(font->glyphId(U'W')), Vector2(23.0f, 0.0f));
+
+    std::unique_ptr<GlyphCache> cache = font->createGlyphCache();
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(cache);
+    CORRADE_COMPARE(cache->glyphCount(), 3);
+    CORRADE_COMPARE(cache->textureSize(), Vector2i(1536));
+    CORRADE_COMPARE(cache->padding(), Vector2i(24));
+    CORRADE_COMPARE((*cache)[2].first, (Vector2i{25, 34}));
+    CORRADE_COMPARE((*cache)[2].second, Range2Di({0, 8}, {16, 128}));
+}
+
+void MagnumFontGLTest::openBinaryInvalid() {
+    #ifdef CORRADE_TARGET_BIG_ENDIAN
+    CORRADE_SKIP("Binary fonts are not supported on big-endian platforms.");
+    #endif
+
+    std::unique_ptr<AbstractFont> font = _fontManager.instantiate("MagnumFont");
+
+    Containers::Array<char> data = binaryFont();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!font->openData({{"font.magnumfont", {data.data(), 24}}}, 0.0f));
+    CORRADE_VERIFY(!font->openData({{"font.magnumfont", {data.data(), data.size() - 1}}}, 0.0f));
+    data[4] = 2;
+    CORRADE_VERIFY(!font->openData({{"font.magnumfont", {data.data(), data.size()}}}, 0.0f));
+    CORRADE_COMPARE(out.str(),
+        "Text::MagnumFont::openData(): binary file too short, expected at least 56 bytes but got 24\n"
+        "Text::MagnumFont::openData(): binary file size mismatch, expected 192 bytes but got 191\n"
+        "Text::MagnumFont::openData(): unsupported binary file version, expected 1 but got 2\n");
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Text::Test::MagnumFontGLTest)
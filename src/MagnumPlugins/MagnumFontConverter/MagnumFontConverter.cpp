@@ -25,15 +25,20 @@
 
 #include "MagnumFontConverter.h"
 
+#include <algorithm>
+#include <cstring>
 #include <sstream>
+#include <unordered_map>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Utility/Configuration.h>
 #include <Corrade/Utility/Directory.h>
+#include <Corrade/Utility/String.h>
 
 #include "Magnum/Image.h"
 #include "Magnum/PixelFormat.h"
 #include "Magnum/Text/GlyphCache.h"
 #include "Magnum/Text/AbstractFont.h"
+#include "MagnumPlugins/MagnumFont/BinaryFormat.h"
 #include "MagnumPlugins/TgaImageConverter/TgaImageConverter.h"
 
 namespace Magnum { namespace Text {
@@ -47,6 +52,10 @@ auto MagnumFontConverter::doFeatures() const -> Features {
 }
 
 std::vector<std::pair<std::string, Containers::Array<char>>> MagnumFontConverter::doExportFontToData(AbstractFont& font, GlyphCache& cache, const std::string& filename, const std::u32string& characters) const {
+    /* Binary format, if requested */
+    if(Utility::String::endsWith(filename, ".magnumfont"))
+        return exportBinaryFontToData(font, cache, filename, characters);
+
     Utility::Configuration configuration;
 
     configuration.setValue("version", 1);
@@ -59,12 +68,18 @@ std::vector<std::pair<std::string, Containers::Array<char>>> MagnumFontConverter
     configuration.setValue("lineHeight", font.lineHeight());
 
     /* Compress glyph IDs so the glyphs are in consecutive array, glyph 0
-       should stay at position 0 */
+       should stay at position 0. The glyph cache is in unspecified order, so
+       sort the IDs to have the output deterministic. */
+    std::vector<UnsignedInt> glyphIds;
+    glyphIds.reserve(cache.glyphCount());
+    for(const std::pair<UnsignedInt, std::pair<Vector2i, Range2Di>>& glyph: cache)
+        glyphIds.push_back(glyph.first);
+    std::sort(glyphIds.begin(), glyphIds.end());
     std::unordered_map<UnsignedInt, UnsignedInt> glyphIdMap;
     glyphIdMap.reserve(cache.glyphCount());
     glyphIdMap.emplace(0, 0);
-    for(const std::pair<UnsignedInt, std::pair<Vector2i, Range2Di>>& glyph: cache)
-        glyphIdMap.emplace(glyph.first, glyphIdMap.size());
+    for(const UnsignedInt glyphId: glyphIds)
+        glyphIdMap.emplace(glyphId, glyphIdMap.size());
 
     /** @todo Save only glyphs contained in @p characters */
 
@@ -112,6 +127,82 @@ std::vector<std::pair<std::string, Containers::Array<char>>> MagnumFontConverter
     return out;
 }
 
+std::vector<std::pair<std::string, Containers::Array<char>>> MagnumFontConverter::exportBinaryFontToData(AbstractFont& font, GlyphCache& cache, const std::string& filename, const std::u32string& characters) const {
+    #ifdef CORRADE_TARGET_BIG_ENDIAN
+    static_cast<void>(font);
+    static_cast<void>(cache);
+    static_cast<void>(filename);
+    static_cast<void>(characters);
+    Error() << "Text::MagnumFontConverter::exportFontToData(): binary fonts are not supported on big-endian platforms";
+    return {};
+    #else
+    /* Compress glyph IDs the same way as above */
+    std::vector<UnsignedInt> glyphIds;
+    glyphIds.reserve(cache.glyphCount());
+    for(const std::pair<UnsignedInt, std::pair<Vector2i, Range2Di>>& glyph: cache)
+        glyphIds.push_back(glyph.first);
+    std::sort(glyphIds.begin(), glyphIds.end());
+    std::unordered_map<UnsignedInt, UnsignedInt> glyphIdMap;
+    glyphIdMap.reserve(cache.glyphCount());
+    glyphIdMap.emplace(0, 0);
+    for(const UnsignedInt glyphId: glyphIds)
+        glyphIdMap.emplace(glyphId, glyphIdMap.size());
+    std::vector<UnsignedInt> inverseGlyphIdMap(glyphIdMap.size());
+    for(const std::pair<UnsignedInt, UnsignedInt>& map: glyphIdMap)
+        inverseGlyphIdMap[map.second] = map.first;
+
+    /* Tightly packed cache image */
+    Image2D image{PixelStorage{}.setAlignment(1), PixelFormat::Red, PixelType::UnsignedByte};
+    cache.texture().image(0, image);
+
+    /* Header */
+    Implementation::MagnumFontBinaryHeader header{};
+    std::memcpy(header.magic, Implementation::MagnumFontBinaryMagic, sizeof(header.magic));
+    header.version = 1;
+    header.fontSize = font.size();
+    header.ascent = font.ascent();
+    header.descent = font.descent();
+    header.lineHeight = font.lineHeight();
+    header.originalImageSize = cache.textureSize();
+    header.padding = cache.padding();
+    header.imageSize = image.size();
+    header.glyphCount = inverseGlyphIdMap.size();
+    header.charCount = characters.size();
+
+    const std::size_t glyphOffset = sizeof(Implementation::MagnumFontBinaryHeader);
+    const std::size_t charOffset = glyphOffset + header.glyphCount*sizeof(Implementation::MagnumFontBinaryGlyph);
+    const std::size_t imageOffset = charOffset + header.charCount*sizeof(Implementation::MagnumFontBinaryChar);
+    Containers::Array<char> data{Containers::ValueInit, imageOffset + std::size_t(image.size().product())};
+    std::memcpy(data.data(), &header, sizeof(header));
+
+    /* Glyph properties in order which preserves their IDs, without padding
+       as in the text format */
+    for(std::size_t i = 0; i != inverseGlyphIdMap.size(); ++i) {
+        const std::pair<Vector2i, Range2Di> glyph = cache[inverseGlyphIdMap[i]];
+        const Implementation::MagnumFontBinaryGlyph out{
+            font.glyphAdvance(inverseGlyphIdMap[i]),
+            glyph.first + cache.padding(),
+            glyph.second.padded(-cache.padding())};
+        std::memcpy(data.data() + glyphOffset + i*sizeof(out), &out, sizeof(out));
+    }
+
+    /* Character->glyph map, unknown glyphs mapped to glyph 0 */
+    for(std::size_t i = 0; i != characters.size(); ++i) {
+        const auto found = glyphIdMap.find(font.glyphId(characters[i]));
+        const Implementation::MagnumFontBinaryChar out{UnsignedInt(characters[i]),
+            found == glyphIdMap.end() ? 0 : found->second};
+        std::memcpy(data.data() + charOffset + i*sizeof(out), &out, sizeof(out));
+    }
+
+    /* Cache image */
+    std::copy(image.data().begin(), image.data().end(), data.begin() + imageOffset);
+
+    std::vector<std::pair<std::string, Containers::Array<char>>> out;
+    out.emplace_back(filename, std::move(data));
+    return out;
+    #endif
+}
+
 }}
 
 CORRADE_PLUGIN_REGISTER(MagnumFontConverter, Magnum::Text::MagnumFontConverter,
@@ -54,8 +54,10 @@ namespace Magnum { namespace Text {
 /**
 @brief MagnumFont converter plugin
 
-Expects filename prefix, creates two files, `prefix.conf` and `prefix.tga`. See
-@ref MagnumFont for more information about the font.
+Expects filename prefix, creates two files, `prefix.conf` and `prefix.tga`. If
+the filename ends with `.magnumfont`, a single file in the binary format is
+created instead. See @ref MagnumFont and @ref Text-MagnumFont-binary for more
+information about the font.
 
 This plugin is available only on desktop OpenGL, as it uses @ref Texture::image()
 to read back the generated data. It depends on the @ref Text library and the
@@ -79,6 +81,7 @@ class MAGNUM_MAGNUMFONTCONVERTER_EXPORT MagnumFontConverter: public Text::Abstra
     private:
         MAGNUM_MAGNUMFONTCONVERTER_LOCAL Features doFeatures() const override;
         MAGNUM_MAGNUMFONTCONVERTER_LOCAL std::vector<std::pair<std::string, Containers::Array<char>>> doExportFontToData(AbstractFont& font, GlyphCache& cache, const std::string& filename, const std::u32string& characters) const override;
+        MAGNUM_MAGNUMFONTCONVERTER_LOCAL std::vector<std::pair<std::string, Containers::Array<char>>> exportBinaryFontToData(AbstractFont& font, GlyphCache& cache, const std::string& filename, const std::u32string& characters) const;
 };
 
 }}
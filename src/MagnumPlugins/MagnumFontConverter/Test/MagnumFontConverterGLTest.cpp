@@ -23,6 +23,8 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <cstring>
+#include <Corrade/Containers/Array.h>
 #include <Corrade/Utility/Directory.h>
 #include <Corrade/TestSuite/Compare/File.h>
 
@@ -37,6 +39,7 @@
 #include "Magnum/Trade/AbstractImageConverter.h"
 #include "Magnum/Trade/AbstractImporter.h"
 #include "Magnum/Trade/ImageData.h"
+#include "MagnumPlugins/MagnumFont/BinaryFormat.h"
 
 #include "configure.h"
 
@@ -46,6 +49,7 @@ struct MagnumFontConverterGLTest: OpenGLTester {
     explicit MagnumFontConverterGLTest();
 
     void exportFont();
+    void exportFontBinary();
 
     /* Explicitly forbid system-wide plugin dependencies */
     PluginManager::Manager<Trade::AbstractImageConverter> _imageConverterManager{"nonexistent"};
@@ -54,7 +58,8 @@ struct MagnumFontConverterGLTest: OpenGLTester {
 };
 
 MagnumFontConverterGLTest::MagnumFontConverterGLTest() {
-    addTests({&MagnumFontConverterGLTest::exportFont});
+    addTests({&MagnumFontConverterGLTest::exportFont,
+              &MagnumFontConverterGLTest::exportFontBinary});
 
     /* Load the plugins directly from the build tree. Otherwise they are static
        and already loaded. */
@@ -68,47 +73,53 @@ MagnumFontConverterGLTest::MagnumFontConverterGLTest() {
     #endif
 }
 
-void MagnumFontConverterGLTest::exportFont() {
-    /* Remove previously created files */
-    Utility::Directory::rm(Utility::Directory::join(MAGNUMFONTCONVERTER_TEST_WRITE_DIR, "font.conf"));
-    Utility::Directory::rm(Utility::Directory::join(MAGNUMFONTCONVERTER_TEST_WRITE_DIR, "font.tga"));
-
-    /* Fake font with fake cache */
-    class FakeFont: public Text::AbstractFont {
-        public:
-            explicit FakeFont(): _opened(false) {}
-
-        private:
-            void doClose() { _opened = false; }
-            bool doIsOpened() const { return _opened; }
-            Metrics doOpenFile(const std::string&, Float) {
-                _opened = true;
-                return {16.0f, 25.0f, -10.0f, 39.7333f};
+namespace {
+
+/* Fake font */
+class FakeFont: public Text::AbstractFont {
+    public:
+        explicit FakeFont(): _opened(false) {}
+
+    private:
+        void doClose() { _opened = false; }
+        bool doIsOpened() const { return _opened; }
+        Metrics doOpenFile(const std::string&, Float) {
+            _opened = true;
+            return {16.0f, 25.0f, -10.0f, 39.7333f};
+        }
+        Features doFeatures() const { return {}; }
+        std::unique_ptr<AbstractLayouter> doLayout(const GlyphCache&, Float, const std::string&) { return nullptr; }
+
+        UnsignedInt doGlyphId(const char32_t character) {
+            switch(character) {
+                case 'W': return 2;
+                case 'e': return 1;
             }
-            Features doFeatures() const { return {}; }
-            std::unique_ptr<AbstractLayouter> doLayout(const GlyphCache&, Float, const std::string&) { return nullptr; }
 
-            UnsignedInt doGlyphId(const char32_t character) {
-                switch(character) {
-                    case 'W': return 2;
-                    case 'e': return 1;
-                }
+            return 0;
+        }
 
-                return 0;
+        Vector2 doGlyphAdvance(const UnsignedInt glyph) {
+            switch(glyph) {
+                case 0: return {8, 0};
+                case 1: return {12, 0};
+                case 2: return {23, 0};
             }
 
-            Vector2 doGlyphAdvance(const UnsignedInt glyph) {
-                switch(glyph) {
-                    case 0: return {8, 0};
-                    case 1: return {12, 0};
-                    case 2: return {23, 0};
-                }
+            CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+        }
 
-                CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
-            }
+        bool _opened;
+};
+
+}
+
+void MagnumFontConverterGLTest::exportFont() {
+    /* Remove previously created files */
+    Utility::Directory::rm(Utility::Directory::join(MAGNUMFONTCONVERTER_TEST_WRITE_DIR, "font.conf"));
+    Utility::Directory::rm(Utility::Directory::join(MAGNUMFONTCONVERTER_TEST_WRITE_DIR, "font.tga"));
 
-            bool _opened;
-    } font;
+    FakeFont font;
     font.openFile({}, {});
 
     /* Create fake cache */
@@ -122,7 +133,6 @@ void MagnumFontConverterGLTest::exportFont() {
     converter->exportFontToFile(font, cache, Utility::Directory::join(MAGNUMFONTCONVERTER_TEST_WRITE_DIR, "font"), "Wave");
 
     /* Verify font parameters */
-    /** @todo This might behave differently elsewhere due to unspecified order of glyphs in cache */
     CORRADE_COMPARE_AS(Utility::Directory::join(MAGNUMFONTCONVERTER_TEST_WRITE_DIR, "font.conf"),
                        Utility::Directory::join(MAGNUMFONT_TEST_DIR, "font.conf"),
                        TestSuite::Compare::File);
@@ -140,6 +150,55 @@ void MagnumFontConverterGLTest::exportFont() {
     CORRADE_COMPARE(image->type(), PixelType::UnsignedByte);
 }
 
+void MagnumFontConverterGLTest::exportFontBinary() {
+    #ifdef CORRADE_TARGET_BIG_ENDIAN
+    CORRADE_SKIP("Binary fonts are not supported on big-endian platforms.");
+    #endif
+
+    const std::string filename = Utility::Directory::join(MAGNUMFONTCONVERTER_TEST_WRITE_DIR, "font.magnumfont");
+    Utility::Directory::rm(filename);
+
+    FakeFont font;
+    font.openFile({}, {});
+
+    MAGNUM_ASSERT_EXTENSION_SUPPORTED(Extensions::GL::ARB::texture_rg);
+    GlyphCache cache(TextureFormat::R8, Vector2i(1536), Vector2i(256), Vector2i(24));
+    cache.insert(font.glyphId(U'W'), {25, 34}, {{0, 8}, {16, 128}});
+    cache.insert(font.glyphId(U'e'), {25, 12}, {{16, 4}, {64, 32}});
+
+    std::unique_ptr<AbstractFontConverter> converter = _fontConverterManager.instantiate("MagnumFontConverter");
+    CORRADE_VERIFY(converter->exportFontToFile(font, cache, filename, "Wave"));
+
+    /* Single file with header, three glyphs, four characters and the image */
+    const Containers::Array<char> data = Utility::Directory::read(filename);
+    CORRADE_COMPARE(data.size(), sizeof(Implementation::MagnumFontBinaryHeader) + 3*sizeof(Implementation::MagnumFontBinaryGlyph) + 4*sizeof(Implementation::MagnumFontBinaryChar) + 256*256);
+
+    Implementation::MagnumFontBinaryHeader header;
+    std::memcpy(&header, data.data(), sizeof(header));
+    CORRADE_COMPARE(std::string(header.magic, 4), "MGNF");
+    CORRADE_COMPARE(header.version, 1);
+    CORRADE_COMPARE(header.fontSize, 16.0f);
+    CORRADE_COMPARE(header.lineHeight, 39.7333f);
+    CORRADE_COMPARE(header.originalImageSize, Vector2i(1536));
+    CORRADE_COMPARE(header.padding, Vector2i(24));
+    CORRADE_COMPARE(header.imageSize, Vector2i(256));
+    CORRADE_COMPARE(header.glyphCount, 3);
+    CORRADE_COMPARE(header.charCount, 4);
+
+    /* Glyph 'W' is the last one, without padding, same as in font.conf */
+    Implementation::MagnumFontBinaryGlyph glyph;
+    std::memcpy(&glyph, data.data() + sizeof(header) + 2*sizeof(glyph), sizeof(glyph));
+    CORRADE_COMPARE(glyph.advance, Vector2(23.0f, 0.0f));
+    CORRADE_COMPARE(glyph.position, (Vector2i{25, 34}));
+    CORRADE_COMPARE(glyph.rectangle, Range2Di({0, 8}, {16, 128}));
+
+    /* 'W' maps to it */
+    Implementation::MagnumFontBinaryChar character;
+    std::memcpy(&character, data.data() + sizeof(header) + 3*sizeof(glyph), sizeof(character));
+    CORRADE_COMPARE(character.unicode, U'W');
+    CORRADE_COMPARE(character.glyph, 2);
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Text::Test::MagnumFontConverterGLTest)
@@ -0,0 +1,105 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MagnumMeshConverter.h"
+
+#include <cstring>
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Trade/MeshData.h"
+#include "MagnumPlugins/MagnumMeshImporter/BinaryFormat.h"
+
+namespace Magnum { namespace Trade {
+
+namespace {
+
+std::size_t alignOffset(const std::size_t offset) {
+    return (offset + Implementation::MagnumMeshBinaryAlignment - 1)/Implementation::MagnumMeshBinaryAlignment*Implementation::MagnumMeshBinaryAlignment;
+}
+
+}
+
+MagnumMeshConverter::MagnumMeshConverter() = default;
+
+MagnumMeshConverter::MagnumMeshConverter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractMeshConverter{manager, plugin} {}
+
+auto MagnumMeshConverter::doFeatures() const -> Features { return Feature::ConvertData; }
+
+Containers::Array<char> MagnumMeshConverter::doExportToData(const MeshData& mesh) {
+    if(mesh.attributeCount() > 0xffff) {
+        Error() << "Trade::MagnumMeshConverter::exportToData(): too many attributes:" << mesh.attributeCount();
+        return nullptr;
+    }
+
+    const std::size_t indexDataOffset = alignOffset(sizeof(Implementation::MagnumMeshBinaryHeader) + mesh.attributeCount()*sizeof(Implementation::MagnumMeshBinaryAttribute));
+    const std::size_t vertexDataOffset = alignOffset(indexDataOffset + mesh.indexData().size());
+    const std::size_t size = vertexDataOffset + mesh.vertexData().size();
+    if(size > 0xffffffffull) {
+        Error() << "Trade::MagnumMeshConverter::exportToData(): the mesh data are too large:" << size << "bytes";
+        return nullptr;
+    }
+
+    /* Zero-initialized so the padding is deterministic */
+    Containers::Array<char> data{Containers::ValueInit, size};
+
+    Implementation::MagnumMeshBinaryHeader header;
+    std::memcpy(header.magic, Implementation::MagnumMeshBinaryMagic, 4);
+    header.version = Implementation::MagnumMeshBinaryVersion;
+    header.endianness = Implementation::MagnumMeshBinaryEndianness;
+    header.attributeCount = mesh.attributeCount();
+    header.alignment = Implementation::MagnumMeshBinaryAlignment;
+    header.primitive = UnsignedInt(mesh.primitive());
+    header.indexType = mesh.isIndexed() ? UnsignedInt(mesh.indexType()) : 0;
+    header.vertexCount = mesh.vertexCount();
+    header.indexDataOffset = indexDataOffset;
+    header.indexDataSize = mesh.indexData().size();
+    header.vertexDataOffset = vertexDataOffset;
+    header.vertexDataSize = mesh.vertexData().size();
+    std::memcpy(data.data(), &header, sizeof(header));
+
+    for(UnsignedInt i = 0; i != mesh.attributeCount(); ++i) {
+        const MeshAttributeData& attribute = mesh.attribute(i);
+        Implementation::MagnumMeshBinaryAttribute a;
+        a.name = UnsignedByte(attribute.name());
+        a.kind = UnsignedByte(attribute.kind());
+        a.components = UnsignedShort(attribute.components());
+        a.dataType = UnsignedInt(attribute.dataType());
+        a.offset = attribute.offset();
+        a.stride = attribute.stride();
+        std::memcpy(data.data() + sizeof(header) + i*sizeof(a), &a, sizeof(a));
+    }
+
+    if(!mesh.indexData().empty())
+        std::memcpy(data.data() + indexDataOffset, mesh.indexData().data(), mesh.indexData().size());
+    if(!mesh.vertexData().empty())
+        std::memcpy(data.data() + vertexDataOffset, mesh.vertexData().data(), mesh.vertexData().size());
+
+    return data;
+}
+
+}}
+
+CORRADE_PLUGIN_REGISTER(MagnumMeshConverter, Magnum::Trade::MagnumMeshConverter,
+    "cz.mosra.magnum.Trade.AbstractMeshConverter/0.1")
@@ -0,0 +1,97 @@
+#ifndef MagnumPlugins_MagnumMeshConverter_MagnumMeshConverter_h
+#define MagnumPlugins_MagnumMeshConverter_MagnumMeshConverter_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Trade::MagnumMeshConverter
+ */
+
+#include "Magnum/Trade/AbstractMeshConverter.h"
+
+#include "MagnumPlugins/MagnumMeshConverter/configure.h"
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+#ifndef MAGNUM_MAGNUMMESHCONVERTER_BUILD_STATIC
+    #ifdef MagnumMeshConverter_EXPORTS
+        #define MAGNUM_MAGNUMMESHCONVERTER_EXPORT CORRADE_VISIBILITY_EXPORT
+    #else
+        #define MAGNUM_MAGNUMMESHCONVERTER_EXPORT CORRADE_VISIBILITY_IMPORT
+    #endif
+#else
+    #define MAGNUM_MAGNUMMESHCONVERTER_EXPORT CORRADE_VISIBILITY_STATIC
+#endif
+#define MAGNUM_MAGNUMMESHCONVERTER_LOCAL CORRADE_VISIBILITY_LOCAL
+#else
+#define MAGNUM_MAGNUMMESHCONVERTER_EXPORT
+#define MAGNUM_MAGNUMMESHCONVERTER_LOCAL
+#endif
+
+namespace Magnum { namespace Trade {
+
+/**
+@brief Magnum mesh converter plugin
+
+Creates binary Magnum mesh files (`*.magnum-mesh`) from @ref MeshData of any
+index type and attribute layout. The files can be loaded back with
+@ref MagnumMeshImporter with no parsing, see its documentation for details
+about the format. Typical use is caching meshes after an expensive
+processing:
+
+@code{.cpp}
+Containers::Optional<Trade::MeshData3D> data = importer->mesh3D(0);
+// MeshTools::removeDuplicates(), MeshTools::tipsify() ...
+
+Trade::MeshData mesh{*data};
+converter->exportToFile(mesh, "mesh.magnum-mesh");
+@endcode
+
+The file is written in the byte order of the current platform.
+
+This plugin depends on the @ref Trade library and is built if
+`WITH_MAGNUMMESHCONVERTER` is enabled when building Magnum. To use as a
+dynamic plugin, you need to load the @cpp "MagnumMeshConverter" @ce plugin
+from `MAGNUM_PLUGINS_MESHCONVERTER_DIR`. To use as a static plugin or as a
+dependency of another plugin with CMake, you need to request the
+`MagnumMeshConverter` component of the `Magnum` package and link to the
+`Magnum::MagnumMeshConverter` target. See @ref building, @ref cmake and
+@ref plugins for more information.
+*/
+class MAGNUM_MAGNUMMESHCONVERTER_EXPORT MagnumMeshConverter: public AbstractMeshConverter {
+    public:
+        /** @brief Default constructor */
+        explicit MagnumMeshConverter();
+
+        /** @brief Plugin manager constructor */
+        explicit MagnumMeshConverter(PluginManager::AbstractManager& manager, const std::string& plugin);
+
+    private:
+        Features MAGNUM_MAGNUMMESHCONVERTER_LOCAL doFeatures() const override;
+        Containers::Array<char> MAGNUM_MAGNUMMESHCONVERTER_LOCAL doExportToData(const MeshData& mesh) override;
+};
+
+}}
+
+#endif
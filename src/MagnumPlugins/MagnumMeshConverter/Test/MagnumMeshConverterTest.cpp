@@ -0,0 +1,145 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/StringToFile.h>
+#include <Corrade/Utility/Directory.h>
+
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/AbstractMeshConverter.h"
+#include "Magnum/Trade/MeshData.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Trade { namespace Test {
+
+struct MagnumMeshConverterTest: TestSuite::Tester {
+    explicit MagnumMeshConverterTest();
+
+    void exportToData();
+    void exportNonIndexed();
+
+    /* Explicitly forbid system-wide plugin dependencies */
+    PluginManager::Manager<AbstractMeshConverter> _converterManager{"nonexistent"};
+    PluginManager::Manager<AbstractImporter> _importerManager{"nonexistent"};
+};
+
+MagnumMeshConverterTest::MagnumMeshConverterTest() {
+    addTests({&MagnumMeshConverterTest::exportToData,
+              &MagnumMeshConverterTest::exportNonIndexed});
+
+    /* Load the plugins directly from the build tree. Otherwise they're static
+       and already loaded. */
+    #ifdef MAGNUMMESHCONVERTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT(_converterManager.load(MAGNUMMESHCONVERTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+    #ifdef MAGNUMMESHIMPORTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT(_importerManager.load(MAGNUMMESHIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+}
+
+namespace {
+
+struct Vertex {
+    Vector3 position;
+    Math::Vector2<UnsignedShort> textureCoordinates;
+};
+
+std::vector<MeshAttributeData> attributes() {
+    return {
+        MeshAttributeData{MeshAttributeName::Position,
+            DynamicAttribute::Kind::Generic,
+            DynamicAttribute::Components::Three,
+            DynamicAttribute::DataType::Float,
+            offsetof(Vertex, position), sizeof(Vertex)},
+        MeshAttributeData{MeshAttributeName::TextureCoordinates,
+            DynamicAttribute::Kind::GenericNormalized,
+            DynamicAttribute::Components::Two,
+            DynamicAttribute::DataType::UnsignedShort,
+            offsetof(Vertex, textureCoordinates), sizeof(Vertex)}};
+}
+
+Containers::Array<char> vertexData() {
+    Containers::Array<char> data{3*sizeof(Vertex)};
+    auto vertices = reinterpret_cast<Vertex*>(data.data());
+    vertices[0] = {{1.0f, 2.0f, 3.0f}, {0, 65535}};
+    vertices[1] = {{4.0f, 5.0f, 6.0f}, {32767, 0}};
+    vertices[2] = {{7.0f, 8.0f, 9.0f}, {65535, 65535}};
+    return data;
+}
+
+}
+
+void MagnumMeshConverterTest::exportToData() {
+    #ifdef CORRADE_TARGET_BIG_ENDIAN
+    CORRADE_SKIP("The test file is little-endian.");
+    #endif
+
+    Containers::Array<char> indexData{3*sizeof(UnsignedShort)};
+    auto indices = reinterpret_cast<UnsignedShort*>(indexData.data());
+    indices[0] = 2;
+    indices[1] = 0;
+    indices[2] = 1;
+
+    const MeshData mesh{MeshPrimitive::Triangles,
+        std::move(indexData), Mesh::IndexType::UnsignedShort,
+        vertexData(), attributes(), 3};
+
+    std::unique_ptr<AbstractMeshConverter> converter = _converterManager.instantiate("MagnumMeshConverter");
+    const Containers::Array<char> data = converter->exportToData(mesh);
+    CORRADE_COMPARE_AS((std::string{data, data.size()}),
+        Utility::Directory::join(MAGNUMMESHIMPORTER_TEST_DIR, "mesh.magnum-mesh"),
+        TestSuite::Compare::StringToFile);
+}
+
+void MagnumMeshConverterTest::exportNonIndexed() {
+    const MeshData mesh{MeshPrimitive::LineStrip, nullptr, {},
+        vertexData(), attributes(), 3};
+
+    std::unique_ptr<AbstractMeshConverter> converter = _converterManager.instantiate("MagnumMeshConverter");
+    const Containers::Array<char> data = converter->exportToData(mesh);
+    CORRADE_VERIFY(data);
+
+    if(!(_importerManager.loadState("MagnumMeshImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("MagnumMeshImporter plugin not enabled, can't test the result");
+
+    std::unique_ptr<AbstractImporter> importer = _importerManager.instantiate("MagnumMeshImporter");
+    CORRADE_VERIFY(importer->openData(data));
+    Containers::Optional<MeshData> imported = importer->mesh(0);
+    CORRADE_VERIFY(imported);
+    CORRADE_COMPARE(imported->primitive(), MeshPrimitive::LineStrip);
+    CORRADE_VERIFY(!imported->isIndexed());
+    CORRADE_COMPARE(imported->vertexCount(), 3);
+    CORRADE_COMPARE(imported->attributeCount(), 2);
+    CORRADE_COMPARE(imported->attribute(1).offset(), offsetof(Vertex, textureCoordinates));
+    CORRADE_COMPARE(reinterpret_cast<const Vertex*>(imported->vertexData().data())[2].position, (Vector3{7.0f, 8.0f, 9.0f}));
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::MagnumMeshConverterTest)
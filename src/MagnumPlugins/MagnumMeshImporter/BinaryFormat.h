@@ -0,0 +1,76 @@
+#ifndef Magnum_Trade_MagnumMeshImporter_BinaryFormat_h
+#define Magnum_Trade_MagnumMeshImporter_BinaryFormat_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/Magnum.h"
+
+namespace Magnum { namespace Trade { namespace Implementation {
+
+/* Binary Magnum mesh file. Consists of the header, followed by
+   attributeCount MagnumMeshBinaryAttribute structures, indexDataSize bytes of
+   index data and vertexDataSize bytes of vertex data. Index and vertex data
+   offsets are relative to the file start and aligned to the alignment value
+   in the header, so the data can be used directly from a memory-mapped file.
+   All values are in the byte order of the machine the file was written on,
+   which is recorded in the header. Enum values are stored as their underlying
+   GL values. */
+struct MagnumMeshBinaryHeader {
+    char magic[4];              /* "MGNM" */
+    UnsignedByte version;       /* 1 */
+    char endianness;            /* 'L' for little-endian, 'B' for big-endian */
+    UnsignedShort attributeCount;
+    UnsignedInt alignment;      /* MagnumMeshBinaryAlignment */
+    UnsignedInt primitive;      /* MeshPrimitive */
+    UnsignedInt indexType;      /* Mesh::IndexType, 0 if not indexed */
+    UnsignedInt vertexCount;
+    UnsignedInt indexDataOffset, indexDataSize;
+    UnsignedInt vertexDataOffset, vertexDataSize;
+};
+
+struct MagnumMeshBinaryAttribute {
+    UnsignedByte name;          /* MeshAttributeName */
+    UnsignedByte kind;          /* DynamicAttribute::Kind */
+    UnsignedShort components;   /* DynamicAttribute::Components */
+    UnsignedInt dataType;       /* DynamicAttribute::DataType */
+    UnsignedInt offset, stride;
+};
+
+static_assert(sizeof(MagnumMeshBinaryHeader) == 40, "Improper size of binary mesh header");
+static_assert(sizeof(MagnumMeshBinaryAttribute) == 16, "Improper size of binary mesh attribute");
+
+constexpr char MagnumMeshBinaryMagic[4]{'M', 'G', 'N', 'M'};
+constexpr UnsignedByte MagnumMeshBinaryVersion = 1;
+constexpr UnsignedInt MagnumMeshBinaryAlignment = 16;
+
+#ifndef CORRADE_TARGET_BIG_ENDIAN
+constexpr char MagnumMeshBinaryEndianness = 'L';
+#else
+constexpr char MagnumMeshBinaryEndianness = 'B';
+#endif
+
+}}}
+
+#endif
@@ -0,0 +1,195 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MagnumMeshImporter.h"
+
+#include <algorithm>
+#include <cstring>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Containers/Optional.h>
+
+#include "Magnum/Trade/MeshData.h"
+#include "MagnumPlugins/MagnumMeshImporter/BinaryFormat.h"
+
+namespace Magnum { namespace Trade {
+
+namespace {
+
+bool isValidComponents(const UnsignedShort components) {
+    #ifndef MAGNUM_TARGET_GLES
+    if(components == UnsignedShort(DynamicAttribute::Components::BGRA))
+        return true;
+    #endif
+    return components >= 1 && components <= 4;
+}
+
+constexpr DynamicAttribute::Kind LastKind =
+    #ifndef MAGNUM_TARGET_GLES
+    DynamicAttribute::Kind::Long
+    #elif !defined(MAGNUM_TARGET_GLES2)
+    DynamicAttribute::Kind::Integral
+    #else
+    DynamicAttribute::Kind::GenericNormalized
+    #endif
+    ;
+
+}
+
+MagnumMeshImporter::MagnumMeshImporter() = default;
+
+MagnumMeshImporter::MagnumMeshImporter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractImporter{manager, plugin} {}
+
+MagnumMeshImporter::~MagnumMeshImporter() = default;
+
+auto MagnumMeshImporter::doFeatures() const -> Features { return Feature::OpenMemory; }
+
+bool MagnumMeshImporter::doIsOpened() const { return _in.data(); }
+
+void MagnumMeshImporter::doClose() {
+    _in = nullptr;
+    _data = nullptr;
+}
+
+void MagnumMeshImporter::doOpenData(const Containers::ArrayView<const char> data) {
+    _data = Containers::Array<char>{data.size()};
+    std::copy(data.begin(), data.end(), _data.begin());
+    _in = _data;
+}
+
+void MagnumMeshImporter::doOpenMemory(const Containers::ArrayView<const char> memory) {
+    _in = memory;
+}
+
+UnsignedInt MagnumMeshImporter::doMeshCount() const { return 1; }
+
+Containers::Optional<MeshData> MagnumMeshImporter::doMesh(UnsignedInt) {
+    /* The input doesn't need to be aligned, so copy the header and attributes
+       out instead of casting the data */
+    Implementation::MagnumMeshBinaryHeader header;
+    if(_in.size() < sizeof(header)) {
+        Error() << "Trade::MagnumMeshImporter::mesh(): the file is too short:" << _in.size() << "bytes";
+        return Containers::NullOpt;
+    }
+    std::memcpy(&header, _in.data(), sizeof(header));
+
+    if(std::memcmp(header.magic, Implementation::MagnumMeshBinaryMagic, 4) != 0) {
+        Error() << "Trade::MagnumMeshImporter::mesh(): invalid file signature";
+        return Containers::NullOpt;
+    }
+
+    if(header.version != Implementation::MagnumMeshBinaryVersion) {
+        Error() << "Trade::MagnumMeshImporter::mesh(): unsupported file version" << UnsignedInt(header.version);
+        return Containers::NullOpt;
+    }
+
+    if(header.endianness != Implementation::MagnumMeshBinaryEndianness) {
+        Error() << "Trade::MagnumMeshImporter::mesh(): the file is" << (header.endianness == 'B' ? "big-endian" : header.endianness == 'L' ? "little-endian" : "of unknown byte order") << Debug::nospace << ", expected" << (Implementation::MagnumMeshBinaryEndianness == 'B' ? "big-endian" : "little-endian");
+        return Containers::NullOpt;
+    }
+
+    /* The alignment has to be a power of two and both data offsets have to
+       respect it */
+    if(!header.alignment || (header.alignment & (header.alignment - 1)) || header.indexDataOffset % header.alignment || header.vertexDataOffset % header.alignment) {
+        Error() << "Trade::MagnumMeshImporter::mesh(): invalid data alignment";
+        return Containers::NullOpt;
+    }
+
+    /* Check that everything fits into the file */
+    const std::size_t expectedSize = std::max({
+        sizeof(header) + header.attributeCount*sizeof(Implementation::MagnumMeshBinaryAttribute),
+        std::size_t(header.indexDataOffset) + header.indexDataSize,
+        std::size_t(header.vertexDataOffset) + header.vertexDataSize});
+    if(_in.size() < expectedSize) {
+        Error() << "Trade::MagnumMeshImporter::mesh(): the file is too short:" << _in.size() << "bytes, expected" << expectedSize;
+        return Containers::NullOpt;
+    }
+
+    const auto indexType = Mesh::IndexType(header.indexType);
+    if(header.indexDataSize) {
+        if(indexType != Mesh::IndexType::UnsignedByte &&
+           indexType != Mesh::IndexType::UnsignedShort &&
+           indexType != Mesh::IndexType::UnsignedInt) {
+            Error() << "Trade::MagnumMeshImporter::mesh(): unsupported index type" << indexType;
+            return Containers::NullOpt;
+        }
+
+        if(header.indexDataSize % Mesh::indexSize(indexType)) {
+            Error() << "Trade::MagnumMeshImporter::mesh(): index data size" << header.indexDataSize << "is not divisible by size of" << indexType;
+            return Containers::NullOpt;
+        }
+    }
+
+    std::vector<MeshAttributeData> attributes;
+    attributes.reserve(header.attributeCount);
+    for(std::size_t i = 0; i != header.attributeCount; ++i) {
+        Implementation::MagnumMeshBinaryAttribute a;
+        std::memcpy(&a, _in.data() + sizeof(header) + i*sizeof(a), sizeof(a));
+
+        const MeshAttributeData attribute{MeshAttributeName(a.name),
+            DynamicAttribute::Kind(a.kind),
+            DynamicAttribute::Components(a.components),
+            DynamicAttribute::DataType(a.dataType), a.offset, a.stride};
+        if(a.name > UnsignedByte(MeshAttributeName::Color) ||
+           a.kind > UnsignedByte(LastKind) ||
+           !isValidComponents(a.components) || !attribute.size()) {
+            Error() << "Trade::MagnumMeshImporter::mesh(): invalid attribute" << i;
+            return Containers::NullOpt;
+        }
+
+        if(header.vertexCount && attribute.offset() + (header.vertexCount - 1)*attribute.stride() + attribute.size() > header.vertexDataSize) {
+            Error() << "Trade::MagnumMeshImporter::mesh(): attribute" << i << "doesn't fit into" << header.vertexDataSize << "bytes of vertex data";
+            return Containers::NullOpt;
+        }
+
+        attributes.push_back(attribute);
+    }
+
+    const Containers::ArrayView<const char> indexData = _in.slice(header.indexDataOffset, header.indexDataOffset + header.indexDataSize);
+    const Containers::ArrayView<const char> vertexData = _in.slice(header.vertexDataOffset, header.vertexDataOffset + header.vertexDataSize);
+
+    /* Reference the data directly if they come from user memory, which
+       outlives the importer, and are aligned as the file expects. Data from
+       openData() or from a file mapping are gone after close(), so these and
+       unaligned data get copied. */
+    Containers::Array<char> indices, vertices;
+    if(!_data && !isFileMapped() && reinterpret_cast<std::uintptr_t>(_in.data()) % header.alignment == 0) {
+        indices = nonOwnedArray(indexData);
+        vertices = nonOwnedArray(vertexData);
+    } else {
+        indices = Containers::Array<char>{indexData.size()};
+        std::copy(indexData.begin(), indexData.end(), indices.begin());
+        vertices = Containers::Array<char>{vertexData.size()};
+        std::copy(vertexData.begin(), vertexData.end(), vertices.begin());
+    }
+
+    return MeshData{MeshPrimitive(header.primitive), std::move(indices),
+        indexType, std::move(vertices), std::move(attributes),
+        header.vertexCount};
+}
+
+}}
+
+CORRADE_PLUGIN_REGISTER(MagnumMeshImporter, Magnum::Trade::MagnumMeshImporter,
+    "cz.mosra.magnum.Trade.AbstractImporter/0.3.1")
@@ -0,0 +1,126 @@
+#ifndef MagnumPlugins_MagnumMeshImporter_MagnumMeshImporter_h
+#define MagnumPlugins_MagnumMeshImporter_MagnumMeshImporter_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Trade::MagnumMeshImporter
+ */
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/VisibilityMacros.h>
+
+#include "Magnum/Trade/AbstractImporter.h"
+
+#include "MagnumPlugins/MagnumMeshImporter/configure.h"
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+#ifndef MAGNUM_MAGNUMMESHIMPORTER_BUILD_STATIC
+    #ifdef MagnumMeshImporter_EXPORTS
+        #define MAGNUM_MAGNUMMESHIMPORTER_EXPORT CORRADE_VISIBILITY_EXPORT
+    #else
+        #define MAGNUM_MAGNUMMESHIMPORTER_EXPORT CORRADE_VISIBILITY_IMPORT
+    #endif
+#else
+    #define MAGNUM_MAGNUMMESHIMPORTER_EXPORT CORRADE_VISIBILITY_STATIC
+#endif
+#define MAGNUM_MAGNUMMESHIMPORTER_LOCAL CORRADE_VISIBILITY_LOCAL
+#else
+#define MAGNUM_MAGNUMMESHIMPORTER_EXPORT
+#define MAGNUM_MAGNUMMESHIMPORTER_LOCAL
+#endif
+
+namespace Magnum { namespace Trade {
+
+/**
+@brief Magnum mesh importer plugin
+
+Imports binary Magnum mesh files (`*.magnum-mesh`) produced by
+@ref MagnumMeshConverter. The format stores one @ref MeshData with arbitrary
+index type and attribute layout exactly as it is in memory, so it's suitable
+for caching already processed meshes --- the result of e.g.
+@ref MeshTools::removeDuplicates(), @ref MeshTools::tipsify() and
+@ref MeshTools::compressIndices() can be loaded back with no parsing and no
+processing at all.
+
+This plugin depends on the @ref Trade library and is built if
+`WITH_MAGNUMMESHIMPORTER` is enabled when building Magnum. To use as a dynamic
+plugin, you need to load the @cpp "MagnumMeshImporter" @ce plugin from
+`MAGNUM_PLUGINS_IMPORTER_DIR`. To use as a static plugin or as a dependency of
+another plugin with CMake, you need to request the `MagnumMeshImporter`
+component of the `Magnum` package and link to the `Magnum::MagnumMeshImporter`
+target. See @ref building, @ref cmake and @ref plugins for more information.
+
+The mesh is available through @ref mesh(), @ref mesh2DCount() and
+@ref mesh3DCount() are always zero.
+
+@section Trade-MagnumMeshImporter-format File format
+
+The file starts with a 40-byte header containing the `MGNM` magic, format
+version, a byte order tag (`L` or `B`), attribute count, data alignment, mesh
+primitive, index type, vertex count and offsets and sizes of the index and
+vertex data. It's followed by a 16-byte description of each attribute (name,
+kind, component count, data type, offset and stride) and finally the raw
+index and vertex data, both starting at an offset aligned to 16 bytes. Enum
+values are stored as their underlying GL values and all values are in the
+byte order of the machine that produced the file --- files with a different
+byte order are rejected instead of being converted.
+
+@section Trade-MagnumMeshImporter-zero-copy Zero-copy import
+
+The plugin supports @ref Feature::OpenMemory. If the memory passed to
+@ref openMemory() is aligned to 16 bytes, the imported mesh references the
+index and vertex data in it directly, without any copy, and stays valid as
+long as the memory does, even after the importer is closed. Files opened with
+@ref openFile() are memory-mapped and the index and vertex data are copied
+directly from the mapping, data passed to @ref openData() and unaligned
+memory are always copied.
+*/
+class MAGNUM_MAGNUMMESHIMPORTER_EXPORT MagnumMeshImporter: public AbstractImporter {
+    public:
+        /** @brief Default constructor */
+        explicit MagnumMeshImporter();
+
+        /** @brief Plugin manager constructor */
+        explicit MagnumMeshImporter(PluginManager::AbstractManager& manager, const std::string& plugin);
+
+        ~MagnumMeshImporter();
+
+    private:
+        Features MAGNUM_MAGNUMMESHIMPORTER_LOCAL doFeatures() const override;
+        bool MAGNUM_MAGNUMMESHIMPORTER_LOCAL doIsOpened() const override;
+        void MAGNUM_MAGNUMMESHIMPORTER_LOCAL doOpenData(Containers::ArrayView<const char> data) override;
+        void MAGNUM_MAGNUMMESHIMPORTER_LOCAL doOpenMemory(Containers::ArrayView<const char> memory) override;
+        void MAGNUM_MAGNUMMESHIMPORTER_LOCAL doClose() override;
+        UnsignedInt MAGNUM_MAGNUMMESHIMPORTER_LOCAL doMeshCount() const override;
+        Containers::Optional<MeshData> MAGNUM_MAGNUMMESHIMPORTER_LOCAL doMesh(UnsignedInt id) override;
+
+        Containers::Array<char> _data;
+        Containers::ArrayView<const char> _in;
+};
+
+}}
+
+#endif
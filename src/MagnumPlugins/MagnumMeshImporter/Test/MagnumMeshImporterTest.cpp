@@ -0,0 +1,247 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/Directory.h>
+
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/MeshData.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Trade { namespace Test {
+
+struct MagnumMeshImporterTest: TestSuite::Tester {
+    explicit MagnumMeshImporterTest();
+
+    void invalid();
+
+    void openData();
+    void openFile();
+    void openMemory();
+    void openMemoryUnaligned();
+
+    /* Explicitly forbid system-wide plugin dependencies */
+    PluginManager::Manager<AbstractImporter> _manager{"nonexistent"};
+};
+
+namespace {
+
+enum: std::size_t { InvalidDataCount = 9 };
+
+/* Each case patches a single byte of the valid file (or truncates it, if the
+   offset is past the size) */
+struct {
+    const char* name;
+    std::size_t offset;
+    char value;
+    std::size_t size;
+    const char* message;
+} InvalidData[InvalidDataCount]{
+    {"too short", 0, 'M', 39,
+        "the file is too short: 39 bytes"},
+    {"invalid signature", 3, 'F', 144,
+        "invalid file signature"},
+    {"unsupported version", 4, 2, 144,
+        "unsupported file version 2"},
+    {"different byte order", 5, 'B', 144,
+        "the file is big-endian, expected little-endian"},
+    {"invalid alignment", 8, 12, 144,
+        "invalid data alignment"},
+    {"data too short", 0, 'M', 143,
+        "the file is too short: 143 bytes, expected 144"},
+    {"invalid index type", 16, 0x06, 144,
+        "unsupported index type Mesh::IndexType(0x1406)"},
+    {"invalid attribute", 41, 5, 144,
+        "invalid attribute 0"},
+    {"attribute out of bounds", 48, 5, 144,
+        "attribute 0 doesn't fit into 48 bytes of vertex data"}
+};
+
+struct Vertex {
+    Vector3 position;
+    Math::Vector2<UnsignedShort> textureCoordinates;
+};
+
+void verifyMesh(const MeshData& mesh) {
+    CORRADE_COMPARE(mesh.primitive(), MeshPrimitive::Triangles);
+    CORRADE_VERIFY(mesh.isIndexed());
+    CORRADE_COMPARE(mesh.indexType(), Mesh::IndexType::UnsignedShort);
+    CORRADE_COMPARE(mesh.indices(), (std::vector<UnsignedInt>{2, 0, 1}));
+
+    CORRADE_COMPARE(mesh.vertexCount(), 3);
+    CORRADE_COMPARE(mesh.vertexData().size(), 3*sizeof(Vertex));
+    CORRADE_COMPARE(mesh.attributeCount(), 2);
+
+    const MeshAttributeData& position = mesh.attribute(0);
+    CORRADE_COMPARE(position.name(), MeshAttributeName::Position);
+    CORRADE_VERIFY(position.kind() == DynamicAttribute::Kind::Generic);
+    CORRADE_VERIFY(position.components() == DynamicAttribute::Components::Three);
+    CORRADE_VERIFY(position.dataType() == DynamicAttribute::DataType::Float);
+    CORRADE_COMPARE(position.offset(), 0);
+    CORRADE_COMPARE(position.stride(), sizeof(Vertex));
+
+    const MeshAttributeData& textureCoordinates = mesh.attribute(1);
+    CORRADE_COMPARE(textureCoordinates.name(), MeshAttributeName::TextureCoordinates);
+    CORRADE_VERIFY(textureCoordinates.kind() == DynamicAttribute::Kind::GenericNormalized);
+    CORRADE_VERIFY(textureCoordinates.components() == DynamicAttribute::Components::Two);
+    CORRADE_VERIFY(textureCoordinates.dataType() == DynamicAttribute::DataType::UnsignedShort);
+    CORRADE_COMPARE(textureCoordinates.offset(), 12);
+    CORRADE_COMPARE(textureCoordinates.stride(), sizeof(Vertex));
+
+    const auto vertices = reinterpret_cast<const Vertex*>(mesh.vertexData().data());
+    CORRADE_COMPARE(vertices[0].position, (Vector3{1.0f, 2.0f, 3.0f}));
+    CORRADE_COMPARE(vertices[1].textureCoordinates, (Math::Vector2<UnsignedShort>{32767, 0}));
+    CORRADE_COMPARE(vertices[2].position, (Vector3{7.0f, 8.0f, 9.0f}));
+}
+
+}
+
+MagnumMeshImporterTest::MagnumMeshImporterTest() {
+    addInstancedTests({&MagnumMeshImporterTest::invalid}, InvalidDataCount);
+
+    addTests({&MagnumMeshImporterTest::openData,
+              &MagnumMeshImporterTest::openFile,
+              &MagnumMeshImporterTest::openMemory,
+              &MagnumMeshImporterTest::openMemoryUnaligned});
+
+    /* Load the plugin directly from the build tree. Otherwise it's static and
+       already loaded. */
+    #ifdef MAGNUMMESHIMPORTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT(_manager.load(MAGNUMMESHIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+}
+
+void MagnumMeshImporterTest::invalid() {
+    #ifdef CORRADE_TARGET_BIG_ENDIAN
+    CORRADE_SKIP("The test file is little-endian.");
+    #endif
+
+    const auto& data = InvalidData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Array<char> file = Utility::Directory::read(Utility::Directory::join(MAGNUMMESHIMPORTER_TEST_DIR, "mesh.magnum-mesh"));
+    CORRADE_COMPARE(file.size(), 144);
+    file[data.offset] = data.value;
+
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("MagnumMeshImporter");
+    CORRADE_VERIFY(importer->openData(file.prefix(data.size)));
+    CORRADE_COMPARE(importer->meshCount(), 1);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->mesh(0));
+    CORRADE_COMPARE(out.str(), std::string{"Trade::MagnumMeshImporter::mesh(): "} + data.message + "\n");
+}
+
+void MagnumMeshImporterTest::openData() {
+    #ifdef CORRADE_TARGET_BIG_ENDIAN
+    CORRADE_SKIP("The test file is little-endian.");
+    #endif
+
+    const Containers::Array<char> file = Utility::Directory::read(Utility::Directory::join(MAGNUMMESHIMPORTER_TEST_DIR, "mesh.magnum-mesh"));
+
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("MagnumMeshImporter");
+    CORRADE_VERIFY(importer->openData(file));
+
+    Containers::Optional<MeshData> mesh = importer->mesh(0);
+    CORRADE_VERIFY(mesh);
+    verifyMesh(*mesh);
+
+    /* The data get copied */
+    CORRADE_VERIFY(mesh->indexData().data() != file + 80);
+    CORRADE_VERIFY(mesh->vertexData().data() != file + 96);
+}
+
+void MagnumMeshImporterTest::openFile() {
+    #ifdef CORRADE_TARGET_BIG_ENDIAN
+    CORRADE_SKIP("The test file is little-endian.");
+    #endif
+
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("MagnumMeshImporter");
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(MAGNUMMESHIMPORTER_TEST_DIR, "mesh.magnum-mesh")));
+
+    Containers::Optional<MeshData> mesh = importer->mesh(0);
+    CORRADE_VERIFY(mesh);
+
+    /* The data are copied out of the file mapping, so they stay valid after
+       closing */
+    importer->close();
+    verifyMesh(*mesh);
+}
+
+void MagnumMeshImporterTest::openMemory() {
+    #ifdef CORRADE_TARGET_BIG_ENDIAN
+    CORRADE_SKIP("The test file is little-endian.");
+    #endif
+
+    const Containers::Array<char> file = Utility::Directory::read(Utility::Directory::join(MAGNUMMESHIMPORTER_TEST_DIR, "mesh.magnum-mesh"));
+    CORRADE_COMPARE(file.size(), 144);
+    alignas(16) char memory[144];
+    std::copy(file.begin(), file.end(), memory);
+
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("MagnumMeshImporter");
+    CORRADE_VERIFY(importer->openMemory(memory));
+
+    Containers::Optional<MeshData> mesh = importer->mesh(0);
+    CORRADE_VERIFY(mesh);
+
+    /* The data reference the memory directly and stay valid after closing */
+    importer->close();
+    CORRADE_VERIFY(mesh->indexData().data() == memory + 80);
+    CORRADE_VERIFY(mesh->vertexData().data() == memory + 96);
+    verifyMesh(*mesh);
+}
+
+void MagnumMeshImporterTest::openMemoryUnaligned() {
+    #ifdef CORRADE_TARGET_BIG_ENDIAN
+    CORRADE_SKIP("The test file is little-endian.");
+    #endif
+
+    const Containers::Array<char> file = Utility::Directory::read(Utility::Directory::join(MAGNUMMESHIMPORTER_TEST_DIR, "mesh.magnum-mesh"));
+    CORRADE_COMPARE(file.size(), 144);
+    alignas(16) char memory[145];
+    std::copy(file.begin(), file.end(), memory + 1);
+
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("MagnumMeshImporter");
+    CORRADE_VERIFY(importer->openMemory({memory + 1, 144}));
+
+    Containers::Optional<MeshData> mesh = importer->mesh(0);
+    CORRADE_VERIFY(mesh);
+
+    /* Unaligned data get copied */
+    CORRADE_VERIFY(mesh->indexData().data() != memory + 81);
+    CORRADE_VERIFY(mesh->vertexData().data() != memory + 97);
+    verifyMesh(*mesh);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::MagnumMeshImporterTest)
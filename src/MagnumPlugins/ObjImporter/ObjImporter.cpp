@@ -25,52 +25,191 @@
 
 #include "ObjImporter.h"
 
-#include <fstream>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <limits>
-#include <sstream>
+#include <tuple>
 #include <unordered_map>
-#include <Corrade/Containers/ArrayView.h>
-#include <Corrade/Utility/String.h>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/PluginManager/Manager.h>
+#include <Corrade/Utility/Directory.h>
 
 #include "Magnum/Mesh.h"
+#include "Magnum/ThreadPool.h"
 #include "Magnum/MeshTools/CombineIndexedArrays.h"
 #include "Magnum/MeshTools/Duplicate.h"
 #include "Magnum/Math/Color.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Matrix4.h"
 #include "Magnum/Trade/MeshData3D.h"
+#include "Magnum/Trade/MeshObjectData3D.h"
+#include "Magnum/Trade/PhongMaterialData.h"
+#include "Magnum/Trade/TextureData.h"
 
 namespace Magnum { namespace Trade {
 
 struct ObjImporter::File {
     std::unordered_map<std::string, UnsignedInt> meshesForName;
     std::vector<std::string> meshNames;
-    std::vector<std::tuple<std::streampos, std::streampos, UnsignedInt, UnsignedInt, UnsignedInt>> meshes;
-    std::unique_ptr<std::istream> in;
+    std::vector<std::tuple<std::size_t, std::size_t, UnsignedInt, UnsignedInt, UnsignedInt>> meshes;
+    Containers::Array<char> ownedData;
+    Containers::ArrayView<const char> data;
+
+    /* Set only if opened from a file, material libraries are relative to
+       it */
+    Containers::Optional<std::string> directory;
+    std::vector<std::string> materialLibraries;
+    /* Material name for each mesh, empty if none */
+    std::vector<std::string> meshMaterials;
+
+    /* Filled lazily by parseMaterials() */
+    bool materialsParsed{};
+    std::vector<Implementation::ObjMaterial> materials;
+    std::unordered_map<std::string, UnsignedInt> materialsForName;
+    std::vector<std::string> textures;
+    std::unordered_map<std::string, UnsignedInt> texturesForName;
 };
 
 namespace {
 
-void ignoreLine(std::istream& in) {
-    in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+/* The parser works directly on the file data. All functions take a pointer to
+   the current position and the end of the data and return pointer after what
+   they consumed, nothing is allocated per line or per token. */
+
+inline bool isWhitespace(const char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\f' || c == '\v';
 }
 
-template<std::size_t size> Math::Vector<size, Float> extractFloatData(const std::string& str, Float* extra = nullptr) {
-    std::vector<std::string> data = Utility::String::splitWithoutEmptyParts(str, ' ');
-    if(data.size() < size || data.size() > size + (extra ? 1 : 0)) {
-        Error() << "Trade::ObjImporter::mesh3D(): invalid float array size";
-        throw 0;
+inline const char* skipWhitespace(const char* it, const char* const end) {
+    while(it != end && isWhitespace(*it)) ++it;
+    return it;
+}
+
+inline const char* skipToken(const char* it, const char* const end) {
+    while(it != end && !isWhitespace(*it)) ++it;
+    return it;
+}
+
+/* Returns end of the line, without the newline character */
+inline const char* findLineEnd(const char* it, const char* const end) {
+    while(it != end && *it != '\n') ++it;
+    return it;
+}
+
+/* Returns the line with whitespace trimmed from both sides */
+inline std::pair<const char*, const char*> trimmed(const char* begin, const char* end) {
+    begin = skipWhitespace(begin, end);
+    while(end != begin && isWhitespace(*(end - 1))) --end;
+    return {begin, end};
+}
+
+inline bool equals(const char* const begin, const char* const end, const char* const string) {
+    const std::size_t size = std::strlen(string);
+    return std::size_t(end - begin) == size && std::memcmp(begin, string, size) == 0;
+}
+
+/* Errors are not printed directly where they happen, as the chunks may be
+   parsed on multiple threads. The message is without the function prefix,
+   as the same helpers are used for both meshes and materials. */
+struct ParseError {
+    const char* message;
+};
+
+void numericError() {
+    throw ParseError{"error while converting numeric data"};
+}
+
+/* Parses a whole token as a float. Mantissa is accumulated in an integer and
+   scaled by an exactly representable power of ten, which is correctly
+   rounded for all values that fit into 19 significant digits in the range
+   where the power is exact. Going through a double makes the final rounding
+   to float exact in practice. */
+Float parseFloat(const char* it, const char* const end) {
+    constexpr Double Powers[]{1.0e0, 1.0e1, 1.0e2, 1.0e3, 1.0e4, 1.0e5, 1.0e6,
+        1.0e7, 1.0e8, 1.0e9, 1.0e10, 1.0e11, 1.0e12, 1.0e13, 1.0e14, 1.0e15,
+        1.0e16, 1.0e17, 1.0e18, 1.0e19, 1.0e20, 1.0e21, 1.0e22};
+
+    bool negative = false;
+    if(it != end && (*it == '-' || *it == '+')) negative = *it++ == '-';
+
+    UnsignedLong mantissa = 0;
+    Int digits = 0, exponent = 0;
+    bool anyDigits = false;
+    for(; it != end && *it >= '0' && *it <= '9'; ++it, anyDigits = true) {
+        if(digits < 19) {
+            mantissa = mantissa*10 + (*it - '0');
+            if(mantissa) ++digits;
+        } else ++exponent;
+    }
+    if(it != end && *it == '.') for(++it; it != end && *it >= '0' && *it <= '9'; ++it, anyDigits = true) {
+        if(digits < 19) {
+            mantissa = mantissa*10 + (*it - '0');
+            if(mantissa) ++digits;
+            --exponent;
+        }
+    }
+    if(!anyDigits) numericError();
+
+    if(it != end && (*it == 'e' || *it == 'E')) {
+        ++it;
+        bool negativeExponent = false;
+        if(it != end && (*it == '-' || *it == '+')) negativeExponent = *it++ == '-';
+        if(it == end || *it < '0' || *it > '9') numericError();
+        Int explicitExponent = 0;
+        for(; it != end && *it >= '0' && *it <= '9'; ++it)
+            if(explicitExponent < 10000) explicitExponent = explicitExponent*10 + (*it - '0');
+        exponent += negativeExponent ? -explicitExponent : explicitExponent;
+    }
+
+    /* Garbage after the number */
+    if(it != end) numericError();
+
+    Double value = Double(mantissa);
+    if(exponent < 0) value = exponent >= -22 ? value/Powers[-exponent] : value*std::pow(10.0, exponent);
+    else if(exponent > 0) value = exponent <= 22 ? value*Powers[exponent] : value*std::pow(10.0, exponent);
+    return Float(negative ? -value : value);
+}
+
+UnsignedInt parseIndex(const char* it, const char* const end) {
+    if(it == end) numericError();
+
+    UnsignedLong value = 0;
+    for(; it != end; ++it) {
+        if(*it < '0' || *it > '9') numericError();
+        value = value*10 + (*it - '0');
+        if(value > std::numeric_limits<UnsignedInt>::max()) numericError();
+    }
+
+    return UnsignedInt(value);
+}
+
+template<std::size_t size> Math::Vector<size, Float> extractFloatData(const char* it, const char* const end, Float* extra = nullptr) {
+    /* Count the tokens first so size errors take precedence over conversion
+       errors */
+    std::size_t count = 0;
+    for(const char* i = skipWhitespace(it, end); i != end; i = skipWhitespace(skipToken(i, end), end))
+        ++count;
+    if(count < size || count > size + (extra ? 1 : 0)) {
+        throw ParseError{"invalid float array size"};
     }
 
     Math::Vector<size, Float> output;
 
-    for(std::size_t i = 0; i != size; ++i)
-        output[i] = std::stof(data[i]);
+    for(std::size_t i = 0; i != count; ++i) {
+        it = skipWhitespace(it, end);
+        const char* const tokenEnd = skipToken(it, end);
+        const Float value = parseFloat(it, tokenEnd);
+        it = tokenEnd;
 
-    if(data.size() == size+1) {
-        /* This should be obvious from the first if, but add this just to make
-           Clang Analyzer happy */
-        CORRADE_INTERNAL_ASSERT(extra);
+        if(i < size) output[i] = value;
+        else {
+            /* This should be obvious from the first if, but add this just to
+               make Clang Analyzer happy */
+            CORRADE_INTERNAL_ASSERT(extra);
 
-        *extra = std::stof(data.back());
+            *extra = value;
+        }
     }
 
     return output;
@@ -86,6 +225,300 @@ template<class T> void reindex(const std::vector<UnsignedInt>& indices, std::vec
     data = MeshTools::duplicate(indices, data);
 }
 
+/* Parsed contents of a part of the mesh. Indices are absolute, so chunks
+   can be parsed independently and then just concatenated. */
+struct Chunk {
+    Containers::Optional<MeshPrimitive> primitive;
+    std::vector<Vector3> positions;
+    std::vector<std::vector<Vector2>> textureCoordinates;
+    std::vector<std::vector<Vector3>> normals;
+    std::vector<UnsignedInt> positionIndices;
+    std::vector<UnsignedInt> textureCoordinateIndices;
+    std::vector<UnsignedInt> normalIndices;
+};
+
+/* Returns false on error, printing the message only if report is set */
+bool parseChunk(const char* const begin, const char* const end, const UnsignedInt positionIndexOffset, const UnsignedInt textureCoordinateIndexOffset, const UnsignedInt normalIndexOffset, const bool report, Chunk& chunk) {
+    Containers::Optional<MeshPrimitive>& primitive = chunk.primitive;
+    std::vector<Vector3>& positions = chunk.positions;
+    std::vector<std::vector<Vector2>>& textureCoordinates = chunk.textureCoordinates;
+    std::vector<std::vector<Vector3>>& normals = chunk.normals;
+    std::vector<UnsignedInt>& positionIndices = chunk.positionIndices;
+    std::vector<UnsignedInt>& textureCoordinateIndices = chunk.textureCoordinateIndices;
+    std::vector<UnsignedInt>& normalIndices = chunk.normalIndices;
+
+    try { for(const char* lineBegin = begin; lineBegin < end; ) {
+        /* Get the line */
+        const char* const lineEnd = findLineEnd(lineBegin, end);
+        const std::pair<const char*, const char*> line = trimmed(lineBegin, lineEnd);
+        lineBegin = lineEnd == end ? end : lineEnd + 1;
+
+        /* Ignore empty lines and comments */
+        if(line.first == line.second || *line.first == '#') continue;
+
+        /* Split the line into keyword and contents */
+        const char* const keywordBegin = line.first;
+        const char* const keywordEnd = skipToken(keywordBegin, line.second);
+        const char* const contents = skipWhitespace(keywordEnd, line.second);
+        const char* const contentsEnd = line.second;
+
+        /* Vertex position */
+        if(equals(keywordBegin, keywordEnd, "v")) {
+            Float extra{1.0f};
+            const Vector3 data = extractFloatData<3>(contents, contentsEnd, &extra);
+            if(!Math::TypeTraits<Float>::equals(extra, 1.0f)) {
+                if(report) Error() << "Trade::ObjImporter::mesh3D(): homogeneous coordinates are not supported";
+                return false;
+            }
+
+            positions.push_back(data);
+
+        /* Texture coordinate */
+        } else if(equals(keywordBegin, keywordEnd, "vt")) {
+            Float extra{0.0f};
+            const auto data = extractFloatData<2>(contents, contentsEnd, &extra);
+            if(!Math::TypeTraits<Float>::equals(extra, 0.0f)) {
+                if(report) Error() << "Trade::ObjImporter::mesh3D(): 3D texture coordinates are not supported";
+                return false;
+            }
+
+            if(textureCoordinates.empty()) textureCoordinates.emplace_back();
+            textureCoordinates.front().emplace_back(data);
+
+        /* Normal */
+        } else if(equals(keywordBegin, keywordEnd, "vn")) {
+            if(normals.empty()) normals.emplace_back();
+            normals.front().emplace_back(extractFloatData<3>(contents, contentsEnd));
+
+        /* Indices */
+        } else if(keywordEnd - keywordBegin == 1 && (*keywordBegin == 'p' || *keywordBegin == 'l' || *keywordBegin == 'f')) {
+            const char keyword = *keywordBegin;
+
+            /* Count the index tuples */
+            std::size_t indexTupleCount = 0;
+            for(const char* i = contents; i != contentsEnd; i = skipWhitespace(skipToken(i, contentsEnd), contentsEnd))
+                ++indexTupleCount;
+
+            /* Points */
+            if(keyword == 'p') {
+                /* Check that we don't mix the primitives in one mesh */
+                if(primitive && primitive != MeshPrimitive::Points) {
+                    if(report) Error() << "Trade::ObjImporter::mesh3D(): mixed primitive" << *primitive << "and" << MeshPrimitive::Points;
+                    return false;
+                }
+
+                /* Check vertex count per primitive */
+                if(indexTupleCount != 1) {
+                    if(report) Error() << "Trade::ObjImporter::mesh3D(): wrong index count for point";
+                    return false;
+                }
+
+                primitive = MeshPrimitive::Points;
+
+            /* Lines */
+            } else if(keyword == 'l') {
+                /* Check that we don't mix the primitives in one mesh */
+                if(primitive && primitive != MeshPrimitive::Lines) {
+                    if(report) Error() << "Trade::ObjImporter::mesh3D(): mixed primitive" << *primitive << "and" << MeshPrimitive::Lines;
+                    return false;
+                }
+
+                /* Check vertex count per primitive */
+                if(indexTupleCount != 2) {
+                    if(report) Error() << "Trade::ObjImporter::mesh3D(): wrong index count for line";
+                    return false;
+                }
+
+                primitive = MeshPrimitive::Lines;
+
+            /* Faces */
+            } else if(keyword == 'f') {
+                /* Check that we don't mix the primitives in one mesh */
+                if(primitive && primitive != MeshPrimitive::Triangles) {
+                    if(report) Error() << "Trade::ObjImporter::mesh3D(): mixed primitive" << *primitive << "and" << MeshPrimitive::Triangles;
+                    return false;
+                }
+
+                /* Check vertex count per primitive */
+                if(indexTupleCount < 3) {
+                    if(report) Error() << "Trade::ObjImporter::mesh3D(): wrong index count for triangle";
+                    return false;
+                } else if(indexTupleCount != 3) {
+                    if(report) Error() << "Trade::ObjImporter::mesh3D(): polygons are not supported";
+                    return false;
+                }
+
+                primitive = MeshPrimitive::Triangles;
+
+            } else CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+
+            for(const char* tupleBegin = contents; tupleBegin != contentsEnd; ) {
+                const char* const tupleEnd = skipToken(tupleBegin, contentsEnd);
+
+                /* Split the tuple on slashes */
+                const char* parts[4]{tupleBegin};
+                std::size_t partCount = 1;
+                for(const char* i = tupleBegin; i != tupleEnd; ++i) if(*i == '/') {
+                    if(partCount == 3) {
+                        if(report) Error() << "Trade::ObjImporter::mesh3D(): invalid index data";
+                        return false;
+                    }
+                    parts[partCount++] = i + 1;
+                }
+                parts[partCount] = tupleEnd + 1;
+
+                /* Position indices */
+                positionIndices.push_back(parseIndex(parts[0], parts[1] - 1) - positionIndexOffset);
+
+                /* Texture coordinates */
+                if(partCount == 2 || (partCount == 3 && parts[2] - 1 != parts[1]))
+                    textureCoordinateIndices.push_back(parseIndex(parts[1], parts[2] - 1) - textureCoordinateIndexOffset);
+
+                /* Normal indices */
+                if(partCount == 3)
+                    normalIndices.push_back(parseIndex(parts[2], parts[3] - 1) - normalIndexOffset);
+
+                tupleBegin = skipWhitespace(tupleEnd, contentsEnd);
+            }
+
+        /* Ignore unsupported keywords, error out on unknown keywords */
+        } else if(![&](){
+            /* Using lambda to emulate for-else construct like in Python */
+            for(const char* expected: {"mtllib", "usemtl", "g", "s"})
+                if(equals(keywordBegin, keywordEnd, expected)) return true;
+            return false;
+        }()) {
+            if(report) Error() << "Trade::ObjImporter::mesh3D(): unknown keyword" << std::string{keywordBegin, keywordEnd};
+            return false;
+        }
+
+    }} catch(const ParseError& error) {
+        if(report) Error() << "Trade::ObjImporter::mesh3D():" << error.message;
+        return false;
+    }
+
+    return true;
+}
+
+
+/* Chunks smaller than this are not worth the threading overhead */
+constexpr std::size_t MinChunkSize = 256*1024;
+
+template<class T> void append(std::vector<std::vector<T>>& to, std::vector<std::vector<T>>& from) {
+    if(from.empty()) return;
+    if(to.empty()) to = std::move(from);
+    else to.front().insert(to.front().end(), from.front().begin(), from.front().end());
+}
+
+template<class T> void append(std::vector<T>& to, const std::vector<T>& from) {
+    to.insert(to.end(), from.begin(), from.end());
+}
+
+std::string parseTextureFilename(const std::string& directory, const char* const contents, const char* const contentsEnd) {
+    if(contents == contentsEnd)
+        throw ParseError{"missing texture filename"};
+    if(*contents == '-')
+        throw ParseError{"texture options are not supported"};
+
+    return Utility::Directory::join(directory, std::string{contents, contentsEnd});
+}
+
+/* Parses a MTL material library, texture paths are made relative to the
+   library location. Prints a message and returns NullOpt on error. */
+Containers::Optional<std::vector<Implementation::ObjMaterial>> parseMaterialLibrary(const std::string& filename) {
+    if(!Utility::Directory::fileExists(filename)) {
+        Error() << "Trade::ObjImporter: cannot open material library" << filename;
+        return Containers::NullOpt;
+    }
+
+    const Containers::Array<char> data = Utility::Directory::read(filename);
+    const std::string directory = Utility::Directory::path(filename);
+    std::vector<Implementation::ObjMaterial> materials;
+
+    try { for(const char* lineBegin = data.begin(), *end = data.end(); lineBegin < end; ) {
+        /* Get the line */
+        const char* const lineEnd = findLineEnd(lineBegin, end);
+        const std::pair<const char*, const char*> line = trimmed(lineBegin, lineEnd);
+        lineBegin = lineEnd == end ? end : lineEnd + 1;
+
+        /* Ignore empty lines and comments */
+        if(line.first == line.second || *line.first == '#') continue;
+
+        /* Split the line into keyword and contents */
+        const char* const keywordBegin = line.first;
+        const char* const keywordEnd = skipToken(keywordBegin, line.second);
+        const char* const contents = skipWhitespace(keywordEnd, line.second);
+        const char* const contentsEnd = line.second;
+
+        /* New material, the defaults are the same as in Shaders::Phong */
+        if(equals(keywordBegin, keywordEnd, "newmtl")) {
+            if(contents == contentsEnd) throw ParseError{"missing material name"};
+            materials.push_back(Implementation::ObjMaterial{std::string{contents, contentsEnd}, Color3{0.0f}, Color3{1.0f}, Color3{1.0f}, 80.0f, {}, {}, {}});
+            continue;
+        }
+
+        /* Ignore unsupported properties */
+        if([&](){
+            /* Using lambda to emulate for-else construct like in Python */
+            for(const char* expected: {"Ke", "Ni", "d", "Tr", "Tf", "illum", "map_d", "map_Ns", "map_Ke", "map_Bump", "map_bump", "bump", "disp", "decal", "refl"})
+                if(equals(keywordBegin, keywordEnd, expected)) return true;
+            return false;
+        }()) continue;
+
+        /* Error out on unknown keywords */
+        if(!equals(keywordBegin, keywordEnd, "Ka") &&
+           !equals(keywordBegin, keywordEnd, "Kd") &&
+           !equals(keywordBegin, keywordEnd, "Ks") &&
+           !equals(keywordBegin, keywordEnd, "Ns") &&
+           !equals(keywordBegin, keywordEnd, "map_Ka") &&
+           !equals(keywordBegin, keywordEnd, "map_Kd") &&
+           !equals(keywordBegin, keywordEnd, "map_Ks")) {
+            Error() << "Trade::ObjImporter: unknown keyword" << std::string{keywordBegin, keywordEnd} << "in material library" << filename;
+            return Containers::NullOpt;
+        }
+
+        /* All remaining properties need a material */
+        if(materials.empty()) throw ParseError{"material property before newmtl"};
+        Implementation::ObjMaterial& material = materials.back();
+
+        if(equals(keywordBegin, keywordEnd, "Ka"))
+            material.ambientColor = Color3{extractFloatData<3>(contents, contentsEnd)};
+        else if(equals(keywordBegin, keywordEnd, "Kd"))
+            material.diffuseColor = Color3{extractFloatData<3>(contents, contentsEnd)};
+        else if(equals(keywordBegin, keywordEnd, "Ks"))
+            material.specularColor = Color3{extractFloatData<3>(contents, contentsEnd)};
+        else if(equals(keywordBegin, keywordEnd, "Ns"))
+            material.shininess = extractFloatData<1>(contents, contentsEnd)[0];
+        else if(equals(keywordBegin, keywordEnd, "map_Ka"))
+            material.ambientTexture = parseTextureFilename(directory, contents, contentsEnd);
+        else if(equals(keywordBegin, keywordEnd, "map_Kd"))
+            material.diffuseTexture = parseTextureFilename(directory, contents, contentsEnd);
+        else if(equals(keywordBegin, keywordEnd, "map_Ks"))
+            material.specularTexture = parseTextureFilename(directory, contents, contentsEnd);
+        else CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+
+    }} catch(const ParseError& error) {
+        Error() << "Trade::ObjImporter:" << error.message << "in material library" << filename;
+        return Containers::NullOpt;
+    }
+
+    return std::move(materials);
+}
+
+/* Makes a copy with data owned by the caller, as the original data deleter
+   may come from another plugin */
+ImageData2D copyImage(const ImageData2D& image) {
+    Containers::Array<char> data{Containers::NoInit, image.data().size()};
+    std::copy(image.data().begin(), image.data().end(), data.begin());
+
+    if(image.isCompressed()) return ImageData2D{
+        #ifndef MAGNUM_TARGET_GLES
+        image.compressedStorage(),
+        #endif
+        image.compressedFormat(), image.size(), std::move(data)};
+    return ImageData2D{image.storage(), image.format(), image.type(), image.size(), std::move(data)};
+}
+
 }
 
 ObjImporter::ObjImporter() = default;
@@ -94,31 +527,35 @@ ObjImporter::ObjImporter(PluginManager::AbstractManager& manager, const std::str
 
 ObjImporter::~ObjImporter() = default;
 
-auto ObjImporter::doFeatures() const -> Features { return Feature::OpenData; }
+auto ObjImporter::doFeatures() const -> Features { return Feature::OpenMemory; }
 
 void ObjImporter::doClose() { _file.reset(); }
 
 bool ObjImporter::doIsOpened() const { return !!_file; }
 
-void ObjImporter::doOpenFile(const std::string& filename) {
-    std::unique_ptr<std::istream> in{new std::ifstream{filename, std::ios::binary}};
-    if(!in->good()) {
-        Error() << "Trade::ObjImporter::openFile(): cannot open file" << filename;
-        return;
-    }
-
+void ObjImporter::doOpenData(Containers::ArrayView<const char> data) {
     _file.reset(new File);
-    _file->in = std::move(in);
+    _file->ownedData = Containers::Array<char>{Containers::NoInit, data.size()};
+    std::copy(data.begin(), data.end(), _file->ownedData.begin());
+    _file->data = _file->ownedData;
+
     parseMeshNames();
 }
 
-void ObjImporter::doOpenData(Containers::ArrayView<const char> data) {
+void ObjImporter::doOpenMemory(Containers::ArrayView<const char> memory) {
     _file.reset(new File);
-    _file->in.reset(new std::istringstream{{data.begin(), data.size()}});
+    _file->data = memory;
 
     parseMeshNames();
 }
 
+void ObjImporter::doOpenFile(const std::string& filename) {
+    AbstractImporter::doOpenFile(filename);
+
+    /* Remember the location for material libraries */
+    if(_file) _file->directory = Utility::Directory::path(filename);
+}
+
 void ObjImporter::parseMeshNames() {
     /* First mesh starts at the beginning, its indices start from 1. The end
        offset will be updated to proper value later. */
@@ -132,25 +569,32 @@ void ObjImporter::parseMeshNames() {
     bool thisIsFirstMeshAndItHasNoData = true;
     _file->meshNames.emplace_back();
 
-    while(_file->in->good()) {
-        /* The previous object might end at the beginning of this line */
-        const std::streampos end = _file->in->tellg();
+    /* The material state persists across meshes, only the first usemtl in
+       each mesh is taken into account */
+    std::string currentMaterial;
+    bool meshHasMaterial = false;
+    _file->meshMaterials.emplace_back();
 
-        /* Comment line */
-        if(_file->in->peek() == '#') {
-            ignoreLine(*_file->in);
-            continue;
-        }
+    const char* const begin = _file->data.begin();
+    const char* const end = _file->data.end();
+    for(const char* lineBegin = begin; lineBegin != end; ) {
+        const char* const lineEnd = findLineEnd(lineBegin, end);
+        const char* const nextLine = lineEnd == end ? end : lineEnd + 1;
+
+        /* The previous object might end at the beginning of this line */
+        const std::size_t lineOffset = lineBegin - begin;
 
-        /* Parse the keyword */
-        std::string keyword;
-        *_file->in >> keyword;
+        /* Parse the keyword, comment lines and empty lines have none */
+        const char* const keywordBegin = skipWhitespace(lineBegin, lineEnd);
+        const char* const keywordEnd = skipToken(keywordBegin, lineEnd);
+        lineBegin = nextLine;
+        if(keywordBegin == keywordEnd || *keywordBegin == '#') continue;
 
         /* Mesh name */
-        if(keyword == "o") {
-            std::string name;
-            std::getline(*_file->in, name);
-            name = Utility::String::trim(name);
+        if(equals(keywordBegin, keywordEnd, "o")) {
+            const std::pair<const char*, const char*> nameRange = trimmed(keywordEnd, lineEnd);
+            std::string name{nameRange.first, nameRange.second};
+            const std::size_t nextLineOffset = nextLine - begin;
 
             /* This is the name of first mesh */
             if(thisIsFirstMeshAndItHasNoData) {
@@ -162,54 +606,68 @@ void ObjImporter::parseMeshNames() {
                 _file->meshNames.back() = std::move(name);
 
                 /* Update its begin offset to be more precise */
-                std::get<0>(_file->meshes.back()) = _file->in->tellg();
+                std::get<0>(_file->meshes.back()) = nextLineOffset;
 
             /* Otherwise this is a name of new mesh */
             } else {
                 /* Set end of the previous one */
-                std::get<1>(_file->meshes.back()) = end;
+                std::get<1>(_file->meshes.back()) = lineOffset;
 
                 /* Save name and offset of the new one. The end offset will be
                    updated later. */
                 if(!name.empty())
                     _file->meshesForName.emplace(name, _file->meshes.size());
                 _file->meshNames.emplace_back(std::move(name));
-                _file->meshes.emplace_back(_file->in->tellg(), 0, positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset);
+                _file->meshes.emplace_back(nextLineOffset, 0, positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset);
+                _file->meshMaterials.push_back(currentMaterial);
+                meshHasMaterial = false;
             }
 
-            continue;
+        /* Material libraries, parsed later on demand */
+        } else if(equals(keywordBegin, keywordEnd, "mtllib")) {
+            for(const char* i = skipWhitespace(keywordEnd, lineEnd); i != lineEnd; ) {
+                const char* const libraryEnd = skipToken(i, lineEnd);
+                std::string library{i, libraryEnd};
+                if(std::find(_file->materialLibraries.begin(), _file->materialLibraries.end(), library) == _file->materialLibraries.end())
+                    _file->materialLibraries.push_back(std::move(library));
+                i = skipWhitespace(libraryEnd, lineEnd);
+            }
+
+        /* Material used by the following faces */
+        } else if(equals(keywordBegin, keywordEnd, "usemtl")) {
+            const std::pair<const char*, const char*> nameRange = trimmed(keywordEnd, lineEnd);
+            currentMaterial = std::string{nameRange.first, nameRange.second};
+            if(!meshHasMaterial) {
+                _file->meshMaterials.back() = currentMaterial;
+                meshHasMaterial = true;
+            }
 
         /* If there are any data/indices before the first name, it means that
            the first object is unnamed. We need to check for them. */
 
         /* Vertex data, update index offset for the following meshes */
-        } else if(keyword == "v") {
+        } else if(equals(keywordBegin, keywordEnd, "v")) {
             ++positionIndexOffset;
             thisIsFirstMeshAndItHasNoData = false;
-        } else if(keyword == "vt") {
+        } else if(equals(keywordBegin, keywordEnd, "vt")) {
             ++textureCoordinateIndexOffset;
             thisIsFirstMeshAndItHasNoData = false;
-        } else if(keyword == "vn") {
+        } else if(equals(keywordBegin, keywordEnd, "vn")) {
             ++normalIndexOffset;
             thisIsFirstMeshAndItHasNoData = false;
 
         /* Index data, just mark that we found something for first unnamed
            object */
-        } else if(thisIsFirstMeshAndItHasNoData) for(const std::string& data: {"p", "l", "f"}) {
-            if(keyword == data) {
-                thisIsFirstMeshAndItHasNoData = false;
-                break;
-            }
+        } else if(thisIsFirstMeshAndItHasNoData && (
+            equals(keywordBegin, keywordEnd, "p") ||
+            equals(keywordBegin, keywordEnd, "l") ||
+            equals(keywordBegin, keywordEnd, "f"))) {
+            thisIsFirstMeshAndItHasNoData = false;
         }
-
-        /* Ignore the rest of the line */
-        ignoreLine(*_file->in);
     }
 
     /* Set end of the last object */
-    _file->in->clear();
-    _file->in->seekg(0, std::ios::end);
-    std::get<1>(_file->meshes.back()) = _file->in->tellg();
+    std::get<1>(_file->meshes.back()) = _file->data.size();
 }
 
 UnsignedInt ObjImporter::doMesh3DCount() const { return _file->meshes.size(); }
@@ -224,164 +682,75 @@ std::string ObjImporter::doMesh3DName(UnsignedInt id) {
 }
 
 Containers::Optional<MeshData3D> ObjImporter::doMesh3D(UnsignedInt id) {
-    /* Seek the file, set mesh parsing parameters */
-    std::streampos begin, end;
+    /* Set mesh parsing parameters */
+    std::size_t beginOffset, endOffset;
     UnsignedInt positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset;
-    std::tie(begin, end, positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset) = _file->meshes[id];
-    _file->in->seekg(begin);
-
-    Containers::Optional<MeshPrimitive> primitive;
-    std::vector<Vector3> positions;
-    std::vector<std::vector<Vector2>> textureCoordinates;
-    std::vector<std::vector<Vector3>> normals;
-    std::vector<UnsignedInt> positionIndices;
-    std::vector<UnsignedInt> textureCoordinateIndices;
-    std::vector<UnsignedInt> normalIndices;
-
-    try { while(_file->in->good() && _file->in->tellg() < end) {
-        /* Ignore comments */
-        if(_file->in->peek() == '#') {
-            ignoreLine(*_file->in);
-            continue;
+    std::tie(beginOffset, endOffset, positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset) = _file->meshes[id];
+    const char* const data = _file->data.begin();
+
+    /* Split the mesh at line boundaries into chunks, if there's a thread pool
+       and enough data */
+    std::vector<std::size_t> chunkOffsets{beginOffset};
+    if(_threadPool && endOffset - beginOffset >= 2*MinChunkSize) {
+        const std::size_t chunkSize = Math::max(MinChunkSize, (endOffset - beginOffset)/(4*_threadPool->threadCount()));
+        for(std::size_t offset = beginOffset + chunkSize; offset < endOffset; offset += chunkSize) {
+            offset = findLineEnd(data + offset, data + endOffset) - data;
+            if(offset == endOffset) break;
+            chunkOffsets.push_back(++offset);
         }
+    }
+    chunkOffsets.push_back(endOffset);
+
+    /* Parse the chunks. If any of them fails, parse the whole mesh again on
+       this thread to report the first error, same as with sequential
+       parsing. */
+    std::vector<Chunk> chunks(chunkOffsets.size() - 1);
+    if(chunks.size() == 1) {
+        if(!parseChunk(data + beginOffset, data + endOffset, positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset, true, chunks[0]))
+            return Containers::NullOpt;
+    } else {
+        std::vector<char> failed(chunks.size());
+        _threadPool->parallelFor(chunks.size(), 1, [&](const std::size_t begin, const std::size_t end) {
+            for(std::size_t i = begin; i != end; ++i)
+                failed[i] = !parseChunk(data + chunkOffsets[i], data + chunkOffsets[i + 1], positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset, false, chunks[i]);
+        });
+
+        if(std::find(failed.begin(), failed.end(), true) != failed.end()) {
+            Chunk chunk;
+            CORRADE_INTERNAL_ASSERT_OUTPUT(!parseChunk(data + beginOffset, data + endOffset, positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset, true, chunk));
+            return Containers::NullOpt;
+        }
+    }
 
-        /* Get the line */
-        std::string line;
-        std::getline(*_file->in, line);
-        line = Utility::String::trim(line);
-
-        /* Ignore empty lines */
-        if(line.empty()) continue;
-
-        /* Split the line into keyword and contents */
-        const std::size_t keywordEnd = line.find(' ');
-        const std::string keyword = line.substr(0, keywordEnd);
-        const std::string contents = keywordEnd != std::string::npos ?
-            Utility::String::ltrim(line.substr(keywordEnd+1)) : "";
-
-        /* Vertex position */
-        if(keyword == "v") {
-            Float extra{1.0f};
-            const Vector3 data = extractFloatData<3>(contents, &extra);
-            if(!Math::TypeTraits<Float>::equals(extra, 1.0f)) {
-                Error() << "Trade::ObjImporter::mesh3D(): homogeneous coordinates are not supported";
-                return Containers::NullOpt;
-            }
-
-            positions.push_back(data);
-
-        /* Texture coordinate */
-        } else if(keyword == "vt") {
-            Float extra{0.0f};
-            const auto data = extractFloatData<2>(contents, &extra);
-            if(!Math::TypeTraits<Float>::equals(extra, 0.0f)) {
-                Error() << "Trade::ObjImporter::mesh3D(): 3D texture coordinates are not supported";
+    /* Merge the chunks in order */
+    Chunk& merged = chunks.front();
+    for(std::size_t i = 1; i != chunks.size(); ++i) {
+        Chunk& chunk = chunks[i];
+        if(chunk.primitive) {
+            /* Check that we don't mix the primitives in one mesh */
+            if(merged.primitive && merged.primitive != chunk.primitive) {
+                Error() << "Trade::ObjImporter::mesh3D(): mixed primitive" << *merged.primitive << "and" << *chunk.primitive;
                 return Containers::NullOpt;
             }
-
-            if(textureCoordinates.empty()) textureCoordinates.emplace_back();
-            textureCoordinates.front().emplace_back(data);
-
-        /* Normal */
-        } else if(keyword == "vn") {
-            if(normals.empty()) normals.emplace_back();
-            normals.front().emplace_back(extractFloatData<3>(contents));
-
-        /* Indices */
-        } else if(keyword == "p" || keyword == "l" || keyword == "f") {
-            const std::vector<std::string> indexTuples = Utility::String::splitWithoutEmptyParts(contents, ' ');
-
-            /* Points */
-            if(keyword == "p") {
-                /* Check that we don't mix the primitives in one mesh */
-                if(primitive && primitive != MeshPrimitive::Points) {
-                    Error() << "Trade::ObjImporter::mesh3D(): mixed primitive" << *primitive << "and" << MeshPrimitive::Points;
-                    return Containers::NullOpt;
-                }
-
-                /* Check vertex count per primitive */
-                if(indexTuples.size() != 1) {
-                    Error() << "Trade::ObjImporter::mesh3D(): wrong index count for point";
-                    return Containers::NullOpt;
-                }
-
-                primitive = MeshPrimitive::Points;
-
-            /* Lines */
-            } else if(keyword == "l") {
-                /* Check that we don't mix the primitives in one mesh */
-                if(primitive && primitive != MeshPrimitive::Lines) {
-                    Error() << "Trade::ObjImporter::mesh3D(): mixed primitive" << *primitive << "and" << MeshPrimitive::Lines;
-                    return Containers::NullOpt;
-                }
-
-                /* Check vertex count per primitive */
-                if(indexTuples.size() != 2) {
-                    Error() << "Trade::ObjImporter::mesh3D(): wrong index count for line";
-                    return Containers::NullOpt;
-                }
-
-                primitive = MeshPrimitive::Lines;
-
-            /* Faces */
-            } else if(keyword == "f") {
-                /* Check that we don't mix the primitives in one mesh */
-                if(primitive && primitive != MeshPrimitive::Triangles) {
-                    Error() << "Trade::ObjImporter::mesh3D(): mixed primitive" << *primitive << "and" << MeshPrimitive::Triangles;
-                    return Containers::NullOpt;
-                }
-
-                /* Check vertex count per primitive */
-                if(indexTuples.size() < 3) {
-                    Error() << "Trade::ObjImporter::mesh3D(): wrong index count for triangle";
-                    return Containers::NullOpt;
-                } else if(indexTuples.size() != 3) {
-                    Error() << "Trade::ObjImporter::mesh3D(): polygons are not supported";
-                    return Containers::NullOpt;
-                }
-
-                primitive = MeshPrimitive::Triangles;
-
-            } else CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
-
-            for(const std::string& indexTuple: indexTuples) {
-                std::vector<std::string> indices = Utility::String::split(indexTuple, '/');
-                if(indices.size() > 3) {
-                    Error() << "Trade::ObjImporter::mesh3D(): invalid index data";
-                    return Containers::NullOpt;
-                }
-
-                /* Position indices */
-                positionIndices.push_back(std::stoul(indices[0]) - positionIndexOffset);
-
-                /* Texture coordinates */
-                if(indices.size() == 2 || (indices.size() == 3 && !indices[1].empty()))
-                    textureCoordinateIndices.push_back(std::stoul(indices[1]) - textureCoordinateIndexOffset);
-
-                /* Normal indices */
-                if(indices.size() == 3)
-                    normalIndices.push_back(std::stoul(indices[2]) - normalIndexOffset);
-            }
-
-        /* Ignore unsupported keywords, error out on unknown keywords */
-        } else if(![&keyword](){
-            /* Using lambda to emulate for-else construct like in Python */
-            for(const std::string expected: {"mtllib", "usemtl", "g", "s"})
-                if(keyword == expected) return true;
-            return false;
-        }()) {
-            Error() << "Trade::ObjImporter::mesh3D(): unknown keyword" << keyword;
-            return Containers::NullOpt;
+            merged.primitive = chunk.primitive;
         }
 
-    }} catch(std::exception) {
-        Error() << "Trade::ObjImporter::mesh3D(): error while converting numeric data";
-        return Containers::NullOpt;
-    } catch(...) {
-        /* Error message already printed */
-        return Containers::NullOpt;
+        append(merged.positions, chunk.positions);
+        append(merged.textureCoordinates, chunk.textureCoordinates);
+        append(merged.normals, chunk.normals);
+        append(merged.positionIndices, chunk.positionIndices);
+        append(merged.textureCoordinateIndices, chunk.textureCoordinateIndices);
+        append(merged.normalIndices, chunk.normalIndices);
     }
 
+    Containers::Optional<MeshPrimitive>& primitive = merged.primitive;
+    std::vector<Vector3>& positions = merged.positions;
+    std::vector<std::vector<Vector2>>& textureCoordinates = merged.textureCoordinates;
+    std::vector<std::vector<Vector3>>& normals = merged.normals;
+    std::vector<UnsignedInt>& positionIndices = merged.positionIndices;
+    std::vector<UnsignedInt>& textureCoordinateIndices = merged.textureCoordinateIndices;
+    std::vector<UnsignedInt>& normalIndices = merged.normalIndices;
+
     /* There should be at least indexed position data */
     if(positions.empty() || positionIndices.empty()) {
         Error() << "Trade::ObjImporter::mesh3D(): incomplete position data";
@@ -443,7 +812,183 @@ Containers::Optional<MeshData3D> ObjImporter::doMesh3D(UnsignedInt id) {
     return MeshData3D{*primitive, std::move(indices), {std::move(positions)}, std::move(normals), std::move(textureCoordinates), {}, nullptr};
 }
 
+UnsignedInt ObjImporter::doObject3DCount() const { return _file->meshes.size(); }
+
+Int ObjImporter::doObject3DForName(const std::string& name) {
+    return doMesh3DForName(name);
+}
+
+std::string ObjImporter::doObject3DName(UnsignedInt id) {
+    return _file->meshNames[id];
+}
+
+std::unique_ptr<ObjectData3D> ObjImporter::doObject3D(UnsignedInt id) {
+    parseMaterials();
+
+    /* Materials not found in any library are ignored */
+    Int material = -1;
+    if(!_file->meshMaterials[id].empty()) {
+        const auto found = _file->materialsForName.find(_file->meshMaterials[id]);
+        if(found != _file->materialsForName.end()) material = found->second;
+    }
+
+    return std::unique_ptr<ObjectData3D>{new MeshObjectData3D{{}, {}, id, material}};
+}
+
+void ObjImporter::parseMaterials() const {
+    if(_file->materialsParsed) return;
+    _file->materialsParsed = true;
+
+    if(_file->materialLibraries.empty()) return;
+    if(!_file->directory) {
+        Warning() << "Trade::ObjImporter: material libraries can be loaded only from files opened with openFile(), ignoring";
+        return;
+    }
+
+    for(const std::string& library: _file->materialLibraries) {
+        const std::string filename = Utility::Directory::join(*_file->directory, library);
+
+        /* Take the library from the cache or parse it and put it there. The
+           failures are cached as well. */
+        Containers::Optional<std::vector<Implementation::ObjMaterial>> parsed;
+        const Containers::Optional<std::vector<Implementation::ObjMaterial>>* materials;
+        if(_materialCache) {
+            auto found = _materialCache->_libraries.find(filename);
+            if(found == _materialCache->_libraries.end())
+                found = _materialCache->_libraries.emplace(filename, parseMaterialLibrary(filename)).first;
+            materials = &found->second;
+        } else {
+            parsed = parseMaterialLibrary(filename);
+            materials = &parsed;
+        }
+
+        /* Error already printed, skip the library */
+        if(!*materials) continue;
+
+        for(const Implementation::ObjMaterial& material: **materials) {
+            /* If more libraries have a material of the same name, the first
+               one is used */
+            if(!_file->materialsForName.emplace(material.name, _file->materials.size()).second)
+                continue;
+            _file->materials.push_back(material);
+
+            /* Each unique texture file is one texture */
+            for(const std::string* texture: {&material.ambientTexture, &material.diffuseTexture, &material.specularTexture})
+                if(!texture->empty() && _file->texturesForName.emplace(*texture, _file->textures.size()).second)
+                    _file->textures.push_back(*texture);
+        }
+    }
+}
+
+UnsignedInt ObjImporter::doMaterialCount() const {
+    parseMaterials();
+    return _file->materials.size();
+}
+
+Int ObjImporter::doMaterialForName(const std::string& name) {
+    parseMaterials();
+    const auto found = _file->materialsForName.find(name);
+    return found == _file->materialsForName.end() ? -1 : found->second;
+}
+
+std::string ObjImporter::doMaterialName(const UnsignedInt id) {
+    return _file->materials[id].name;
+}
+
+std::unique_ptr<AbstractMaterialData> ObjImporter::doMaterial(const UnsignedInt id) {
+    const Implementation::ObjMaterial& material = _file->materials[id];
+
+    PhongMaterialData::Flags flags;
+    if(!material.ambientTexture.empty())
+        flags |= PhongMaterialData::Flag::AmbientTexture;
+    if(!material.diffuseTexture.empty())
+        flags |= PhongMaterialData::Flag::DiffuseTexture;
+    if(!material.specularTexture.empty())
+        flags |= PhongMaterialData::Flag::SpecularTexture;
+
+    std::unique_ptr<PhongMaterialData> data{new PhongMaterialData{flags, material.shininess}};
+    if(flags & PhongMaterialData::Flag::AmbientTexture)
+        data->ambientTexture() = _file->texturesForName[material.ambientTexture];
+    else data->ambientColor() = material.ambientColor;
+    if(flags & PhongMaterialData::Flag::DiffuseTexture)
+        data->diffuseTexture() = _file->texturesForName[material.diffuseTexture];
+    else data->diffuseColor() = material.diffuseColor;
+    if(flags & PhongMaterialData::Flag::SpecularTexture)
+        data->specularTexture() = _file->texturesForName[material.specularTexture];
+    else data->specularColor() = material.specularColor;
+
+    return std::move(data);
+}
+
+UnsignedInt ObjImporter::doTextureCount() const {
+    parseMaterials();
+    return _file->textures.size();
+}
+
+Int ObjImporter::doTextureForName(const std::string& name) {
+    parseMaterials();
+    const auto found = _file->texturesForName.find(name);
+    return found == _file->texturesForName.end() ? -1 : found->second;
+}
+
+std::string ObjImporter::doTextureName(const UnsignedInt id) {
+    return _file->textures[id];
+}
+
+Containers::Optional<TextureData> ObjImporter::doTexture(const UnsignedInt id) {
+    /* Each texture has its own image */
+    return TextureData{TextureData::Type::Texture2D,
+        Sampler::Filter::Linear, Sampler::Filter::Linear, Sampler::Mipmap::Linear,
+        Sampler::Wrapping::Repeat, id};
+}
+
+UnsignedInt ObjImporter::doImage2DCount() const { return doTextureCount(); }
+
+Int ObjImporter::doImage2DForName(const std::string& name) {
+    return doTextureForName(name);
+}
+
+std::string ObjImporter::doImage2DName(const UnsignedInt id) {
+    return _file->textures[id];
+}
+
+Containers::Optional<ImageData2D> ObjImporter::doImage2D(const UnsignedInt id) {
+    const std::string& filename = _file->textures[id];
+    if(!_materialCache) return loadImage(filename);
+
+    /* Take the image from the cache */
+    const auto found = _materialCache->_images.find(filename);
+    if(found != _materialCache->_images.end()) {
+        if(!found->second) return Containers::NullOpt;
+        return copyImage(*found->second);
+    }
+
+    /* Or load it and put a copy into the cache. The failures are cached as
+       well. */
+    Containers::Optional<ImageData2D> image = loadImage(filename);
+    if(image) _materialCache->_images.emplace(filename, copyImage(*image));
+    else _materialCache->_images.emplace(filename, Containers::NullOpt);
+    return image;
+}
+
+Containers::Optional<ImageData2D> ObjImporter::loadImage(const std::string& filename) {
+    if(!manager()) {
+        Error() << "Trade::ObjImporter::image2D(): the plugin must be instantiated with access to plugin manager in order to load images";
+        return Containers::NullOpt;
+    }
+
+    if(!(manager()->load("AnyImageImporter") & PluginManager::LoadState::Loaded)) {
+        Error() << "Trade::ObjImporter::image2D(): cannot load AnyImageImporter plugin";
+        return Containers::NullOpt;
+    }
+
+    /* Error output should be printed by the plugin itself */
+    std::unique_ptr<AbstractImporter> importer = static_cast<PluginManager::Manager<AbstractImporter>*>(manager())->instantiate("AnyImageImporter");
+    if(!importer->openFile(filename)) return Containers::NullOpt;
+    return importer->image2D(0);
+}
+
 }}
 
 CORRADE_PLUGIN_REGISTER(ObjImporter, Magnum::Trade::ObjImporter,
-    "cz.mosra.magnum.Trade.AbstractImporter/0.3")
+    "cz.mosra.magnum.Trade.AbstractImporter/0.3.1")
@@ -29,7 +29,13 @@
  * @brief Class @ref Magnum::Trade::ObjImporter
  */
 
+#include <unordered_map>
+#include <vector>
+#include <Corrade/Containers/Optional.h>
+
+#include "Magnum/Math/Color.h"
 #include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/ImageData.h"
 
 #include "MagnumPlugins/ObjImporter/configure.h"
 
@@ -51,6 +57,61 @@
 
 namespace Magnum { namespace Trade {
 
+class ObjImporter;
+
+namespace Implementation {
+    struct ObjMaterial {
+        std::string name;
+        Color3 ambientColor, diffuseColor, specularColor;
+        Float shininess;
+        /* Paths of texture files, empty if the material has a color */
+        std::string ambientTexture, diffuseTexture, specularTexture;
+    };
+}
+
+/**
+@brief Material cache for @ref ObjImporter
+
+Keeps parsed MTL material libraries and loaded texture images, so OBJ files
+sharing the same material library don't parse it or load its images again.
+Usually there's one cache for all importer instances coming from the same
+plugin manager:
+
+@code{.cpp}
+Trade::ObjMaterialCache cache;
+
+std::unique_ptr<Trade::AbstractImporter> a = manager.loadAndInstantiate("ObjImporter");
+std::unique_ptr<Trade::AbstractImporter> b = manager.loadAndInstantiate("ObjImporter");
+static_cast<Trade::ObjImporter&>(*a).setMaterialCache(&cache);
+static_cast<Trade::ObjImporter&>(*b).setMaterialCache(&cache);
+@endcode
+
+The libraries and images are identified by their path. Failures are cached as
+well, so a missing file is reported only once. The cache doesn't watch the
+files for changes, use @ref clear() to discard it. It's not thread-safe, the
+importers using it should be accessed from a single thread.
+*/
+class ObjMaterialCache {
+    public:
+        /** @brief Count of cached material libraries */
+        std::size_t libraryCount() const { return _libraries.size(); }
+
+        /** @brief Count of cached images */
+        std::size_t imageCount() const { return _images.size(); }
+
+        /** @brief Discard all cached libraries and images */
+        void clear() {
+            _libraries.clear();
+            _images.clear();
+        }
+
+    private:
+        friend ObjImporter;
+
+        std::unordered_map<std::string, Containers::Optional<std::vector<Implementation::ObjMaterial>>> _libraries;
+        std::unordered_map<std::string, Containers::Optional<ImageData2D>> _images;
+};
+
 /**
 @brief OBJ importer plugin
 
@@ -59,6 +120,7 @@ Loads Wavefront OBJ (`*.obj`) files, with the following supported features:
 -   multiple objects
 -   vertex positions, normals and 2D texture coordinates
 -   triangles, lines and points
+-   Phong materials from MTL libraries and their textures
 
 This plugin depends on the @ref Trade library and is built if `WITH_OBJIMPORTER`
 is enabled when building Magnum. To use as a dynamic plugin, you need to load
@@ -70,8 +132,65 @@ for more information.
 
 @section Trade-ObjImporter-limitations Behavior and limitations
 
-Polygons (quads etc.), automatic normal generation and material properties are
-currently not supported.
+Polygons (quads etc.) and automatic normal generation are currently not
+supported.
+
+The file is parsed in place, without any per-line or per-token allocations.
+The plugin supports @ref Feature::OpenMemory, so files opened with
+@ref openFile() are memory-mapped instead of being read into memory. Numbers are expected to be in plain decimal notation
+with an optional exponent, @cpp nan @ce and @cpp inf @ce are not supported.
+Negative (relative) indices are not supported either.
+
+@section Trade-ObjImporter-threads Multithreaded parsing
+
+Meshes larger than a few hundred kilobytes can be parsed in parallel by
+passing a @ref ThreadPool to @ref setThreadPool():
+
+@code{.cpp}
+ThreadPool pool;
+std::unique_ptr<Trade::AbstractImporter> importer = manager.loadAndInstantiate("ObjImporter");
+static_cast<Trade::ObjImporter&>(*importer).setThreadPool(&pool);
+@endcode
+
+The mesh is split into chunks at line boundaries, each chunk is parsed on its
+own and the results are then concatenated in order. Because OBJ indices are
+absolute, there's nothing to adjust when merging. The result, including
+reported errors, is the same as with sequential parsing.
+
+Parsing a mesh doesn't modify any importer state, so @ref mesh3D() can also be
+called concurrently from multiple threads for different meshes of the same
+file, as long as the file isn't closed or reopened in the meantime. That
+doesn't apply to the material, texture and image accessors.
+
+@section Trade-ObjImporter-materials Materials
+
+Material libraries referenced by `mtllib` are parsed lazily on the first call
+to any of the material, texture, image or object accessors, which means
+importing just the meshes doesn't touch them at all. Libraries are looked up
+relative to the OBJ file and thus are available only for files opened with
+@ref openFile(). Each material is imported as @ref PhongMaterialData:
+
+-   `Ka`, `Kd` and `Ks` set the ambient, diffuse and specular color, defaults
+    are the same as in @ref Shaders::Phong, i.e. @cpp 0x000000_rgbf @ce,
+    @cpp 0xffffff_rgbf @ce and @cpp 0xffffff_rgbf @ce
+-   `Ns` sets the shininess, default is @cpp 80.0f @ce
+-   `map_Ka`, `map_Kd` and `map_Ks` set the ambient, diffuse and specular
+    texture instead of the color, texture options are not supported
+
+Other MTL properties such as `d`, `illum` or `map_Bump` are ignored. Each
+unique texture file is exposed as a 2D @ref TextureData with linear filtering
+and repeat wrapping, referencing an image of the same index, which is loaded
+using @ref AnyImageImporter "AnyImageImporter". The textures and images are
+named by paths of the files.
+
+Material assignment is exposed through objects --- there's one
+@ref MeshObjectData3D for each mesh, with the same name and with the material
+set by the first `usemtl` in the mesh or inherited from the previous mesh.
+Failures are printed and the library or the image is skipped, the remaining
+data are still imported.
+
+Use @ref setMaterialCache() to share parsed libraries and loaded images among
+multiple importer instances, see @ref ObjMaterialCache for details.
 */
 class MAGNUM_OBJIMPORTER_EXPORT ObjImporter: public AbstractImporter {
     public:
@@ -83,6 +202,50 @@ class MAGNUM_OBJIMPORTER_EXPORT ObjImporter: public AbstractImporter {
 
         ~ObjImporter();
 
+        /**
+         * @brief Thread pool used for parsing
+         *
+         * @see @ref setThreadPool()
+         */
+        ThreadPool* threadPool() const { return _threadPool; }
+
+        /**
+         * @brief Set thread pool used for parsing
+         * @return Reference to self (for method chaining)
+         *
+         * If set, large meshes are split into chunks at line boundaries and
+         * the chunks are parsed in parallel on threads of @p pool. See
+         * @ref Trade-ObjImporter-threads for more information. Pass
+         * @cpp nullptr @ce to parse on the calling thread only, which is the
+         * default.
+         */
+        ObjImporter& setThreadPool(ThreadPool* pool) {
+            _threadPool = pool;
+            return *this;
+        }
+
+        /**
+         * @brief Material cache
+         *
+         * @see @ref setMaterialCache()
+         */
+        ObjMaterialCache* materialCache() const { return _materialCache; }
+
+        /**
+         * @brief Set material cache
+         * @return Reference to self (for method chaining)
+         *
+         * If set, material libraries and images are taken from @p cache
+         * and newly parsed or loaded ones are added to it. See
+         * @ref Trade-ObjImporter-materials for more information. Affects only
+         * libraries and images that weren't imported yet. Pass
+         * @cpp nullptr @ce to disable the caching, which is the default.
+         */
+        ObjImporter& setMaterialCache(ObjMaterialCache* cache) {
+            _materialCache = cache;
+            return *this;
+        }
+
     private:
         struct File;
 
@@ -90,6 +253,7 @@ class MAGNUM_OBJIMPORTER_EXPORT ObjImporter: public AbstractImporter {
 
         MAGNUM_OBJIMPORTER_LOCAL bool doIsOpened() const override;
         MAGNUM_OBJIMPORTER_LOCAL void doOpenData(Containers::ArrayView<const char> data) override;
+        MAGNUM_OBJIMPORTER_LOCAL void doOpenMemory(Containers::ArrayView<const char> memory) override;
         MAGNUM_OBJIMPORTER_LOCAL void doOpenFile(const std::string& filename) override;
         MAGNUM_OBJIMPORTER_LOCAL void doClose() override;
 
@@ -98,9 +262,35 @@ class MAGNUM_OBJIMPORTER_EXPORT ObjImporter: public AbstractImporter {
         MAGNUM_OBJIMPORTER_LOCAL std::string doMesh3DName(UnsignedInt id) override;
         MAGNUM_OBJIMPORTER_LOCAL Containers::Optional<MeshData3D> doMesh3D(UnsignedInt id) override;
 
+        MAGNUM_OBJIMPORTER_LOCAL UnsignedInt doObject3DCount() const override;
+        MAGNUM_OBJIMPORTER_LOCAL Int doObject3DForName(const std::string& name) override;
+        MAGNUM_OBJIMPORTER_LOCAL std::string doObject3DName(UnsignedInt id) override;
+        MAGNUM_OBJIMPORTER_LOCAL std::unique_ptr<ObjectData3D> doObject3D(UnsignedInt id) override;
+
+        MAGNUM_OBJIMPORTER_LOCAL UnsignedInt doMaterialCount() const override;
+        MAGNUM_OBJIMPORTER_LOCAL Int doMaterialForName(const std::string& name) override;
+        MAGNUM_OBJIMPORTER_LOCAL std::string doMaterialName(UnsignedInt id) override;
+        MAGNUM_OBJIMPORTER_LOCAL std::unique_ptr<AbstractMaterialData> doMaterial(UnsignedInt id) override;
+
+        MAGNUM_OBJIMPORTER_LOCAL UnsignedInt doTextureCount() const override;
+        MAGNUM_OBJIMPORTER_LOCAL Int doTextureForName(const std::string& name) override;
+        MAGNUM_OBJIMPORTER_LOCAL std::string doTextureName(UnsignedInt id) override;
+        MAGNUM_OBJIMPORTER_LOCAL Containers::Optional<TextureData> doTexture(UnsignedInt id) override;
+
+        MAGNUM_OBJIMPORTER_LOCAL UnsignedInt doImage2DCount() const override;
+        MAGNUM_OBJIMPORTER_LOCAL Int doImage2DForName(const std::string& name) override;
+        MAGNUM_OBJIMPORTER_LOCAL std::string doImage2DName(UnsignedInt id) override;
+        MAGNUM_OBJIMPORTER_LOCAL Containers::Optional<ImageData2D> doImage2D(UnsignedInt id) override;
+
         MAGNUM_OBJIMPORTER_LOCAL void parseMeshNames();
+        /* Const because it's lazily called from the const count queries,
+           modifies only the File contents */
+        MAGNUM_OBJIMPORTER_LOCAL void parseMaterials() const;
+        MAGNUM_OBJIMPORTER_LOCAL Containers::Optional<ImageData2D> loadImage(const std::string& filename);
 
         std::unique_ptr<File> _file;
+        ThreadPool* _threadPool{};
+        ObjMaterialCache* _materialCache{};
 };
 
 }}
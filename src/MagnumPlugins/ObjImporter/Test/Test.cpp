@@ -28,9 +28,15 @@
 #include <Corrade/Utility/Directory.h>
 
 #include "Magnum/Mesh.h"
+#include "Magnum/ThreadPool.h"
 #include "Magnum/Math/Vector3.h"
 #include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/ImageData.h"
 #include "Magnum/Trade/MeshData3D.h"
+#include "Magnum/Trade/MeshObjectData3D.h"
+#include "Magnum/Trade/PhongMaterialData.h"
+#include "Magnum/Trade/TextureData.h"
+#include "MagnumPlugins/ObjImporter/ObjImporter.h"
 
 #include "configure.h"
 
@@ -89,6 +95,22 @@ struct ObjImporterTest: TestSuite::Tester {
     void unsupportedKeyword();
     void unknownKeyword();
 
+    void numberFormats();
+
+    void threaded();
+    void threadedError();
+    void threadedMixedPrimitives();
+
+    void materials();
+    void materialTextures();
+    void materialObjects();
+    void materialsOpenData();
+    void materialLibraryInvalid();
+    void materialCache();
+    void materialCacheImage();
+
+    void benchmarkTextureCoordinatesNormals();
+
     /* Explicitly forbid system-wide plugin dependencies */
     PluginManager::Manager<AbstractImporter> _manager{"nonexistent"};
 };
@@ -141,7 +163,23 @@ ObjImporterTest::ObjImporterTest() {
               &ObjImporterTest::wrongNormalIndexCount,
 
               &ObjImporterTest::unsupportedKeyword,
-              &ObjImporterTest::unknownKeyword});
+              &ObjImporterTest::unknownKeyword,
+
+              &ObjImporterTest::numberFormats,
+
+              &ObjImporterTest::threaded,
+              &ObjImporterTest::threadedError,
+              &ObjImporterTest::threadedMixedPrimitives,
+
+              &ObjImporterTest::materials,
+              &ObjImporterTest::materialTextures,
+              &ObjImporterTest::materialObjects,
+              &ObjImporterTest::materialsOpenData,
+              &ObjImporterTest::materialLibraryInvalid,
+              &ObjImporterTest::materialCache,
+              &ObjImporterTest::materialCacheImage});
+
+    addBenchmarks({&ObjImporterTest::benchmarkTextureCoordinatesNormals}, 3);
 
     #ifdef OBJIMPORTER_PLUGIN_FILENAME
     CORRADE_INTERNAL_ASSERT(_manager.load(OBJIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
@@ -738,6 +776,313 @@ void ObjImporterTest::unknownKeyword() {
     CORRADE_COMPARE(out.str(), "Trade::ObjImporter::mesh3D(): unknown keyword bleh\n");
 }
 
+void ObjImporterTest::numberFormats() {
+    /* Exponents, explicit signs, missing leading zeros, tabs and CRLF line
+       endings */
+    const char file[] =
+        "o Formats\r\n"
+        "v 1.5e2 -0.25 +3\r\n"
+        "v\t.5\t1E-1  -2.5e+1 \r\n"
+        "v 0.001 1000000 0\r\n"
+        "l 1 2\r\n"
+        "l 3 1\r\n";
+
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("ObjImporter");
+    CORRADE_VERIFY(importer->openData({file, sizeof(file) - 1}));
+    CORRADE_COMPARE(importer->mesh3DCount(), 1);
+    CORRADE_COMPARE(importer->mesh3DName(0), "Formats");
+
+    const Containers::Optional<MeshData3D> data = importer->mesh3D(0);
+    CORRADE_VERIFY(data);
+    CORRADE_COMPARE(data->primitive(), MeshPrimitive::Lines);
+    CORRADE_COMPARE(data->positions(0), (std::vector<Vector3>{
+        {150.0f, -0.25f, 3.0f},
+        {0.5f, 0.1f, -25.0f},
+        {0.001f, 1000000.0f, 0.0f}
+    }));
+    CORRADE_COMPARE(data->indices(), (std::vector<UnsignedInt>{
+        0, 1, 2, 0
+    }));
+}
+
+namespace {
+    /* A grid with texture coordinates and normals. A 128x128 grid is about
+       1.7 MB of text, enough to be split into several chunks. */
+    std::string gridFile(const Int gridSize) {
+        std::ostringstream out;
+        for(Int y = 0; y <= gridSize; ++y)
+            for(Int x = 0; x <= gridSize; ++x)
+                out << "v " << x*0.125f << " " << y*0.125f << " " << ((x*7 + y*3) % 11)*0.1f << "\n";
+        for(Int y = 0; y <= gridSize; ++y)
+            for(Int x = 0; x <= gridSize; ++x)
+                out << "vt " << Float(x)/gridSize << " " << Float(y)/gridSize << "\n";
+        out << "vn 0 0 1\n";
+        for(Int y = 0; y != gridSize; ++y) for(Int x = 0; x != gridSize; ++x) {
+            const Int i = y*(gridSize + 1) + x + 1;
+            const Int j = i + gridSize + 1;
+            out << "f " << i << "/" << i << "/1 " << i + 1 << "/" << i + 1 << "/1 " << j + 1 << "/" << j + 1 << "/1\n"
+                << "f " << i << "/" << i << "/1 " << j + 1 << "/" << j + 1 << "/1 " << j << "/" << j << "/1\n";
+        }
+        return out.str();
+    }
+}
+
+void ObjImporterTest::threaded() {
+    const std::string file = gridFile(128);
+
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("ObjImporter");
+    CORRADE_VERIFY(importer->openData({file.data(), file.size()}));
+    const Containers::Optional<MeshData3D> expected = importer->mesh3D(0);
+    CORRADE_VERIFY(expected);
+
+    ThreadPool pool{4};
+    static_cast<ObjImporter&>(*importer).setThreadPool(&pool);
+    CORRADE_COMPARE(static_cast<ObjImporter&>(*importer).threadPool(), &pool);
+    const Containers::Optional<MeshData3D> data = importer->mesh3D(0);
+    CORRADE_VERIFY(data);
+    CORRADE_COMPARE(data->primitive(), MeshPrimitive::Triangles);
+    CORRADE_COMPARE(data->indices().size(), 128*128*6);
+    CORRADE_COMPARE(data->indices(), expected->indices());
+    CORRADE_COMPARE(data->positions(0), expected->positions(0));
+    CORRADE_COMPARE(data->textureCoords2D(0), expected->textureCoords2D(0));
+    CORRADE_COMPARE(data->normals(0), expected->normals(0));
+}
+
+void ObjImporterTest::threadedError() {
+    /* Two errors in different chunks, only the first one should be reported */
+    const std::string file = gridFile(128) + "vt bleh 1\n" + "vn 1 2\n" + gridFile(16);
+
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("ObjImporter");
+    ThreadPool pool{4};
+    static_cast<ObjImporter&>(*importer).setThreadPool(&pool);
+    CORRADE_VERIFY(importer->openData({file.data(), file.size()}));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->mesh3D(0));
+    CORRADE_COMPARE(out.str(), "Trade::ObjImporter::mesh3D(): error while converting numeric data\n");
+}
+
+void ObjImporterTest::threadedMixedPrimitives() {
+    /* The first chunk has just triangles, the last one just a point */
+    const std::string file = gridFile(128) + "p 1\n";
+
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("ObjImporter");
+    ThreadPool pool{4};
+    static_cast<ObjImporter&>(*importer).setThreadPool(&pool);
+    CORRADE_VERIFY(importer->openData({file.data(), file.size()}));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->mesh3D(0));
+    CORRADE_COMPARE(out.str(), "Trade::ObjImporter::mesh3D(): mixed primitive MeshPrimitive::Triangles and MeshPrimitive::Points\n");
+}
+
+void ObjImporterTest::materials() {
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("ObjImporter");
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(OBJIMPORTER_TEST_DIR, "materials.obj")));
+
+    /* Importing meshes doesn't need the materials */
+    CORRADE_VERIFY(importer->mesh3D(0));
+
+    CORRADE_COMPARE(importer->materialCount(), 3);
+    CORRADE_COMPARE(importer->materialName(0), "Plain");
+    CORRADE_COMPARE(importer->materialForName("Textured"), 1);
+    CORRADE_COMPARE(importer->materialForName("Nonexistent"), -1);
+
+    {
+        std::unique_ptr<AbstractMaterialData> material = importer->material(0);
+        CORRADE_VERIFY(material);
+        CORRADE_COMPARE(material->type(), MaterialType::Phong);
+
+        auto& phong = static_cast<const PhongMaterialData&>(*material);
+        CORRADE_COMPARE(phong.flags(), PhongMaterialData::Flags{});
+        CORRADE_COMPARE(phong.ambientColor(), (Color3{0.1f, 0.2f, 0.3f}));
+        CORRADE_COMPARE(phong.diffuseColor(), (Color3{0.4f, 0.5f, 0.6f}));
+        CORRADE_COMPARE(phong.specularColor(), (Color3{0.7f, 0.8f, 0.9f}));
+        CORRADE_COMPARE(phong.shininess(), 32.0f);
+    } {
+        std::unique_ptr<AbstractMaterialData> material = importer->material(1);
+        CORRADE_VERIFY(material);
+
+        auto& phong = static_cast<const PhongMaterialData&>(*material);
+        CORRADE_COMPARE(phong.flags(), PhongMaterialData::Flag::AmbientTexture|PhongMaterialData::Flag::DiffuseTexture|PhongMaterialData::Flag::SpecularTexture);
+        CORRADE_COMPARE(phong.ambientTexture(), 0);
+        CORRADE_COMPARE(phong.diffuseTexture(), 1);
+        /* The same file is the same texture */
+        CORRADE_COMPARE(phong.specularTexture(), 1);
+    } {
+        /* Defaults are the same as in Shaders::Phong */
+        std::unique_ptr<AbstractMaterialData> material = importer->material(2);
+        CORRADE_VERIFY(material);
+
+        auto& phong = static_cast<const PhongMaterialData&>(*material);
+        CORRADE_COMPARE(phong.flags(), PhongMaterialData::Flags{});
+        CORRADE_COMPARE(phong.ambientColor(), Color3{0.0f});
+        CORRADE_COMPARE(phong.diffuseColor(), Color3{1.0f});
+        CORRADE_COMPARE(phong.specularColor(), Color3{1.0f});
+        CORRADE_COMPARE(phong.shininess(), 80.0f);
+    }
+}
+
+void ObjImporterTest::materialTextures() {
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("ObjImporter");
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(OBJIMPORTER_TEST_DIR, "materials.obj")));
+
+    const std::string ambient = Utility::Directory::join(OBJIMPORTER_TEST_DIR, "ambient.tga");
+    const std::string diffuse = Utility::Directory::join(OBJIMPORTER_TEST_DIR, "diffuse.tga");
+    CORRADE_COMPARE(importer->textureCount(), 2);
+    CORRADE_COMPARE(importer->textureName(0), ambient);
+    CORRADE_COMPARE(importer->textureForName(diffuse), 1);
+
+    const Containers::Optional<TextureData> texture = importer->texture(1);
+    CORRADE_VERIFY(texture);
+    CORRADE_COMPARE(texture->type(), TextureData::Type::Texture2D);
+    CORRADE_COMPARE(texture->minificationFilter(), Sampler::Filter::Linear);
+    CORRADE_COMPARE(texture->magnificationFilter(), Sampler::Filter::Linear);
+    CORRADE_COMPARE(texture->mipmapFilter(), Sampler::Mipmap::Linear);
+    CORRADE_COMPARE(texture->wrapping(), Array3D<Sampler::Wrapping>{Sampler::Wrapping::Repeat});
+    CORRADE_COMPARE(texture->image(), 1);
+
+    CORRADE_COMPARE(importer->image2DCount(), 2);
+    CORRADE_COMPARE(importer->image2DName(1), diffuse);
+    CORRADE_COMPARE(importer->image2DForName(ambient), 0);
+}
+
+void ObjImporterTest::materialObjects() {
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("ObjImporter");
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(OBJIMPORTER_TEST_DIR, "materials.obj")));
+
+    CORRADE_COMPARE(importer->object3DCount(), 4);
+    CORRADE_COMPARE(importer->object3DName(2), "Third");
+    CORRADE_COMPARE(importer->object3DForName("Second"), 1);
+
+    /* The material is set by the first usemtl, inherited from the previous
+       mesh if there's none and ignored if it's not found */
+    const Int expected[]{1, 1, 0, -1};
+    for(UnsignedInt i = 0; i != 4; ++i) {
+        std::unique_ptr<ObjectData3D> object = importer->object3D(i);
+        CORRADE_VERIFY(object);
+        CORRADE_COMPARE(object->instanceType(), ObjectInstanceType3D::Mesh);
+        CORRADE_COMPARE(object->instance(), i);
+        CORRADE_COMPARE(static_cast<MeshObjectData3D&>(*object).material(), expected[i]);
+    }
+}
+
+void ObjImporterTest::materialsOpenData() {
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("ObjImporter");
+    const Containers::Array<char> data = Utility::Directory::read(Utility::Directory::join(OBJIMPORTER_TEST_DIR, "materials.obj"));
+    CORRADE_VERIFY(importer->openData(data));
+
+    /* The library location is unknown */
+    std::ostringstream out;
+    Warning redirectWarning{&out};
+    CORRADE_COMPARE(importer->materialCount(), 0);
+    CORRADE_COMPARE(importer->textureCount(), 0);
+    CORRADE_COMPARE(out.str(), "Trade::ObjImporter: material libraries can be loaded only from files opened with openFile(), ignoring\n");
+}
+
+void ObjImporterTest::materialLibraryInvalid() {
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("ObjImporter");
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(OBJIMPORTER_TEST_DIR, "invalidMaterials.obj")));
+
+    /* Failed libraries are skipped, the remaining are used */
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_COMPARE(importer->materialCount(), 3);
+    CORRADE_COMPARE(importer->materialForName("Plain"), 0);
+    CORRADE_COMPARE(out.str(),
+        "Trade::ObjImporter: unknown keyword bleh in material library " + Utility::Directory::join(OBJIMPORTER_TEST_DIR, "unknownKeyword.mtl") + "\n"
+        "Trade::ObjImporter: texture options are not supported in material library " + Utility::Directory::join(OBJIMPORTER_TEST_DIR, "textureOptions.mtl") + "\n"
+        "Trade::ObjImporter: cannot open material library " + Utility::Directory::join(OBJIMPORTER_TEST_DIR, "nonexistent.mtl") + "\n");
+}
+
+void ObjImporterTest::materialCache() {
+    ObjMaterialCache cache;
+
+    std::unique_ptr<AbstractImporter> a = _manager.instantiate("ObjImporter");
+    std::unique_ptr<AbstractImporter> b = _manager.instantiate("ObjImporter");
+    static_cast<ObjImporter&>(*a).setMaterialCache(&cache);
+    static_cast<ObjImporter&>(*b).setMaterialCache(&cache);
+    CORRADE_COMPARE(static_cast<ObjImporter&>(*a).materialCache(), &cache);
+    CORRADE_VERIFY(a->openFile(Utility::Directory::join(OBJIMPORTER_TEST_DIR, "invalidMaterials.obj")));
+    CORRADE_VERIFY(b->openFile(Utility::Directory::join(OBJIMPORTER_TEST_DIR, "invalidMaterials.obj")));
+
+    /* The libraries are parsed only for the first importer, including the
+       errors */
+    std::ostringstream out;
+    {
+        Error redirectError{&out};
+        CORRADE_COMPARE(a->materialCount(), 3);
+    }
+    CORRADE_COMPARE(cache.libraryCount(), 4);
+    CORRADE_VERIFY(!out.str().empty());
+
+    out.str({});
+    {
+        Error redirectError{&out};
+        CORRADE_COMPARE(b->materialCount(), 3);
+    }
+    CORRADE_COMPARE(cache.libraryCount(), 4);
+    CORRADE_COMPARE(out.str(), "");
+
+    std::unique_ptr<AbstractMaterialData> material = b->material(b->materialForName("Plain"));
+    CORRADE_VERIFY(material);
+    CORRADE_COMPARE(static_cast<PhongMaterialData&>(*material).shininess(), 32.0f);
+
+    /* Clearing makes the libraries parsed again */
+    cache.clear();
+    CORRADE_COMPARE(cache.libraryCount(), 0);
+    CORRADE_VERIFY(b->openFile(Utility::Directory::join(OBJIMPORTER_TEST_DIR, "materials.obj")));
+    CORRADE_COMPARE(b->materialCount(), 3);
+    CORRADE_COMPARE(cache.libraryCount(), 1);
+}
+
+void ObjImporterTest::materialCacheImage() {
+    ObjMaterialCache cache;
+
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("ObjImporter");
+    static_cast<ObjImporter&>(*importer).setMaterialCache(&cache);
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(OBJIMPORTER_TEST_DIR, "materials.obj")));
+
+    /* System-wide plugins are forbidden, so the image can't be loaded */
+    std::ostringstream out;
+    {
+        Error redirectError{&out};
+        CORRADE_VERIFY(!importer->image2D(0));
+    }
+    CORRADE_VERIFY(!out.str().empty());
+    CORRADE_COMPARE(cache.imageCount(), 1);
+
+    /* The failure is cached, no second attempt */
+    out.str({});
+    {
+        Error redirectError{&out};
+        CORRADE_VERIFY(!importer->image2D(0));
+    }
+    CORRADE_COMPARE(out.str(), "");
+    CORRADE_COMPARE(cache.imageCount(), 1);
+}
+
+void ObjImporterTest::benchmarkTextureCoordinatesNormals() {
+    /* A 256x256 grid with texture coordinates and normals, about 7 MB of
+       text */
+    constexpr Int gridSize = 256;
+    const std::string file = gridFile(gridSize);
+    setTestCaseDescription(std::to_string((gridSize + 1)*(gridSize + 1)) + " vertices, " + std::to_string(file.size()/1024) + " kB");
+
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("ObjImporter");
+    Containers::Optional<MeshData3D> data;
+    CORRADE_BENCHMARK(1) {
+        CORRADE_VERIFY(importer->openData({file.data(), file.size()}));
+        data = importer->mesh3D(0);
+    }
+
+    CORRADE_VERIFY(data);
+    CORRADE_COMPARE(data->indices().size(), gridSize*gridSize*6);
+    CORRADE_COMPARE(data->positions(0).size(), (gridSize + 1)*(gridSize + 1));
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Trade::Test::ObjImporterTest)
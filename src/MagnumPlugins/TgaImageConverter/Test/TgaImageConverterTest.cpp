@@ -24,10 +24,12 @@
 */
 
 #include <sstream>
+#include <string>
 #include <tuple>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
 #include <Corrade/Utility/Directory.h>
 
 #include "Magnum/Image.h"
@@ -35,6 +37,7 @@
 #include "Magnum/Trade/ImageData.h"
 #include "Magnum/Trade/AbstractImageConverter.h"
 #include "Magnum/Trade/AbstractImporter.h"
+#include "MagnumPlugins/TgaImageConverter/TgaImageConverter.h"
 
 #include "configure.h"
 
@@ -49,6 +52,14 @@ struct TgaImageConverterTest: TestSuite::Tester {
     void rgb();
     void rgba();
 
+    void rleRgb();
+    void rleRgba();
+    void rleGrayscale();
+
+    void stream();
+    void streamRle();
+    void streamAbort();
+
     /* Explicitly forbid system-wide plugin dependencies */
     PluginManager::Manager<AbstractImageConverter> _converterManager{"nonexistent"};
     PluginManager::Manager<AbstractImporter> _importerManager{"nonexistent"};
@@ -79,6 +90,20 @@ namespace {
         5, 6, 7, 8, 6, 7, 8, 9
     };
     const ImageView2D OriginalRGBA{PixelFormat::RGBA, PixelType::UnsignedByte, {2, 3}, OriginalDataRGBA};
+
+    /* Long runs that exceed the packet size, raw pixels and runs of two */
+    constexpr char OriginalDataGrayscale[] = {
+        1, 2, 3, 3, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 5,
+        4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+        6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 22
+    };
+    const ImageView2D OriginalGrayscale{PixelStorage{}.setAlignment(1),
+        #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+        PixelFormat::Red,
+        #else
+        PixelFormat::Luminance,
+        #endif
+        PixelType::UnsignedByte, {18, 3}, OriginalDataGrayscale};
 }
 
 TgaImageConverterTest::TgaImageConverterTest() {
@@ -86,7 +111,15 @@ TgaImageConverterTest::TgaImageConverterTest() {
               &TgaImageConverterTest::wrongType,
 
               &TgaImageConverterTest::rgb,
-              &TgaImageConverterTest::rgba});
+              &TgaImageConverterTest::rgba,
+
+              &TgaImageConverterTest::rleRgb,
+              &TgaImageConverterTest::rleRgba,
+              &TgaImageConverterTest::rleGrayscale,
+
+              &TgaImageConverterTest::stream,
+              &TgaImageConverterTest::streamRle,
+              &TgaImageConverterTest::streamAbort});
 
     /* Load the plugin directly from the build tree. Otherwise it's static and
        already loaded. */
@@ -115,9 +148,9 @@ void TgaImageConverterTest::wrongFormat() {
     const auto data = converter->exportToData(image);
     CORRADE_VERIFY(!data);
     #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
-    CORRADE_COMPARE(out.str(), "Trade::TgaImageConverter::exportToData(): unsupported color format PixelFormat::RG\n");
+    CORRADE_COMPARE(out.str(), "Trade::TgaImageConverter::exportToStream(): unsupported color format PixelFormat::RG\n");
     #else
-    CORRADE_COMPARE(out.str(), "Trade::TgaImageConverter::exportToData(): unsupported color format PixelFormat::LuminanceAlpha\n");
+    CORRADE_COMPARE(out.str(), "Trade::TgaImageConverter::exportToStream(): unsupported color format PixelFormat::LuminanceAlpha\n");
     #endif
 }
 
@@ -136,7 +169,7 @@ void TgaImageConverterTest::wrongType() {
     std::unique_ptr<AbstractImageConverter> converter = _converterManager.instantiate("TgaImageConverter");
     const auto data = converter->exportToData(image);
     CORRADE_VERIFY(!data);
-    CORRADE_COMPARE(out.str(), "Trade::TgaImageConverter::exportToData(): unsupported color type PixelType::Float\n");
+    CORRADE_COMPARE(out.str(), "Trade::TgaImageConverter::exportToStream(): unsupported color type PixelType::Float\n");
 }
 
 void TgaImageConverterTest::rgb() {
@@ -181,6 +214,157 @@ void TgaImageConverterTest::rgba() {
         TestSuite::Compare::Container);
 }
 
+void TgaImageConverterTest::rleRgb() {
+    std::unique_ptr<AbstractImageConverter> converter = _converterManager.instantiate("TgaImageConverter");
+    static_cast<TgaImageConverter&>(*converter).setRleCompression(true);
+    CORRADE_VERIFY(static_cast<TgaImageConverter&>(*converter).rleCompression());
+    const auto data = converter->exportToData(OriginalRGB);
+    CORRADE_VERIFY(data);
+    CORRADE_COMPARE(data[2], 10);
+
+    if(!(_importerManager.loadState("TgaImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("TgaImporter plugin not enabled, can't test the result");
+
+    std::unique_ptr<AbstractImporter> importer = _importerManager.instantiate("TgaImporter");
+    CORRADE_VERIFY(importer->openData(data));
+    Containers::Optional<Trade::ImageData2D> converted = importer->image2D(0);
+    CORRADE_VERIFY(converted);
+
+    CORRADE_COMPARE(converted->size(), Vector2i(2, 3));
+    CORRADE_COMPARE(converted->format(), PixelFormat::RGB);
+    CORRADE_COMPARE_AS(converted->data(), Containers::arrayView(ConvertedDataRGB),
+        TestSuite::Compare::Container);
+}
+
+void TgaImageConverterTest::rleRgba() {
+    std::unique_ptr<AbstractImageConverter> converter = _converterManager.instantiate("TgaImageConverter");
+    static_cast<TgaImageConverter&>(*converter).setRleCompression(true);
+    const auto data = converter->exportToData(OriginalRGBA);
+    CORRADE_VERIFY(data);
+    CORRADE_COMPARE(data[2], 10);
+
+    if(!(_importerManager.loadState("TgaImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("TgaImporter plugin not enabled, can't test the result");
+
+    std::unique_ptr<AbstractImporter> importer = _importerManager.instantiate("TgaImporter");
+    CORRADE_VERIFY(importer->openData(data));
+    Containers::Optional<Trade::ImageData2D> converted = importer->image2D(0);
+    CORRADE_VERIFY(converted);
+
+    CORRADE_COMPARE(converted->size(), Vector2i(2, 3));
+    CORRADE_COMPARE(converted->format(), PixelFormat::RGBA);
+    CORRADE_COMPARE_AS(converted->data(), Containers::arrayView(OriginalDataRGBA),
+        TestSuite::Compare::Container);
+}
+
+void TgaImageConverterTest::rleGrayscale() {
+    std::unique_ptr<AbstractImageConverter> converter = _converterManager.instantiate("TgaImageConverter");
+    static_cast<TgaImageConverter&>(*converter).setRleCompression(true);
+    const auto data = converter->exportToData(OriginalGrayscale);
+    CORRADE_VERIFY(data);
+
+    /* Every row is encoded separately */
+    const char expected[] = {
+        0, 0, 11, 0, 0, 0, 0, 0, 0, 0, 0, 0, 18, 0, 3, 0, 8, 0,
+        '\x01', 1, 2, '\x81', 3, '\x8c', 4, '\x00', 5,
+        '\x91', 4,
+        '\x0f', 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, '\x81', 22
+    };
+    CORRADE_COMPARE_AS(data, Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+
+    if(!(_importerManager.loadState("TgaImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("TgaImporter plugin not enabled, can't test the result");
+
+    std::unique_ptr<AbstractImporter> importer = _importerManager.instantiate("TgaImporter");
+    CORRADE_VERIFY(importer->openData(data));
+    Containers::Optional<Trade::ImageData2D> converted = importer->image2D(0);
+    CORRADE_VERIFY(converted);
+
+    CORRADE_COMPARE(converted->size(), Vector2i(18, 3));
+    CORRADE_COMPARE_AS(converted->data(), Containers::arrayView(OriginalDataGrayscale),
+        TestSuite::Compare::Container);
+}
+
+void TgaImageConverterTest::stream() {
+    /* Big enough to be split into more than one batch of rows */
+    Containers::Array<char> pixels{512*200*3};
+    for(std::size_t i = 0; i != pixels.size(); ++i)
+        pixels[i] = char(i*7);
+    const ImageView2D image{PixelFormat::RGB, PixelType::UnsignedByte, {512, 200}, pixels};
+
+    std::unique_ptr<AbstractImageConverter> converter = _converterManager.instantiate("TgaImageConverter");
+    CORRADE_VERIFY(converter->features() & AbstractImageConverter::Feature::ConvertStream);
+
+    std::string streamed;
+    std::size_t chunkCount = 0;
+    CORRADE_VERIFY(converter->exportToStream(image, [&](Containers::ArrayView<const char> chunk) {
+        streamed.append(chunk.data(), chunk.size());
+        ++chunkCount;
+        return true;
+    }));
+
+    /* Header and at least two batches of rows */
+    CORRADE_COMPARE_AS(chunkCount, std::size_t{3}, TestSuite::Compare::GreaterOrEqual);
+
+    const auto data = converter->exportToData(image);
+    CORRADE_COMPARE(streamed.size(), data.size());
+    CORRADE_COMPARE_AS(Containers::ArrayView<const char>(streamed.data(), streamed.size()),
+        Containers::ArrayView<const char>{data}, TestSuite::Compare::Container);
+
+    /* Swizzled pixel data after the 18-byte header */
+    CORRADE_COMPARE(streamed.size(), 18 + pixels.size());
+    CORRADE_COMPARE(streamed[18], pixels[2]);
+    CORRADE_COMPARE(streamed[18 + 1], pixels[1]);
+    CORRADE_COMPARE(streamed[18 + 2], pixels[0]);
+    CORRADE_COMPARE(streamed[streamed.size() - 1], pixels[pixels.size() - 3]);
+}
+
+void TgaImageConverterTest::streamRle() {
+    /* Rows with runs spanning the whole row */
+    Containers::Array<char> pixels{Containers::ValueInit, 4*256*100};
+    for(std::size_t y = 0; y != 100; ++y)
+        for(std::size_t x = 0; x != 256*4; ++x)
+            pixels[y*256*4 + x] = char(y);
+    const ImageView2D image{PixelFormat::RGBA, PixelType::UnsignedByte, {256, 100}, pixels};
+
+    std::unique_ptr<AbstractImageConverter> converter = _converterManager.instantiate("TgaImageConverter");
+    static_cast<TgaImageConverter&>(*converter).setRleCompression(true);
+
+    std::string streamed;
+    CORRADE_VERIFY(converter->exportToStream(image, [&](Containers::ArrayView<const char> chunk) {
+        streamed.append(chunk.data(), chunk.size());
+        return true;
+    }));
+
+    /* Two full-length run packets for every row */
+    CORRADE_COMPARE(streamed.size(), 18 + 100*2*5);
+
+    if(!(_importerManager.loadState("TgaImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("TgaImporter plugin not enabled, can't test the result");
+
+    std::unique_ptr<AbstractImporter> importer = _importerManager.instantiate("TgaImporter");
+    CORRADE_VERIFY(importer->openData({streamed.data(), streamed.size()}));
+    Containers::Optional<Trade::ImageData2D> converted = importer->image2D(0);
+    CORRADE_VERIFY(converted);
+
+    CORRADE_COMPARE(converted->size(), Vector2i(256, 100));
+    CORRADE_COMPARE_AS(converted->data(), Containers::ArrayView<const char>{pixels},
+        TestSuite::Compare::Container);
+}
+
+void TgaImageConverterTest::streamAbort() {
+    std::unique_ptr<AbstractImageConverter> converter = _converterManager.instantiate("TgaImageConverter");
+
+    /* The export stops right after the writer fails */
+    std::size_t chunkCount = 0;
+    CORRADE_VERIFY(!converter->exportToStream(OriginalRGBA, [&](Containers::ArrayView<const char>) {
+        ++chunkCount;
+        return false;
+    }));
+    CORRADE_COMPARE(chunkCount, 1);
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Trade::Test::TgaImageConverterTest)
@@ -26,26 +26,66 @@
 #include "TgaImageConverter.h"
 
 #include <algorithm>
-#include <fstream>
 #include <tuple>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Utility/Endianness.h>
 
 #include "Magnum/Image.h"
+#include "Magnum/PixelConversion.h"
 #include "Magnum/PixelFormat.h"
-#include "Magnum/Math/Swizzle.h"
-#include "Magnum/Math/Vector4.h"
 #include "MagnumPlugins/TgaImporter/TgaHeader.h"
 
 namespace Magnum { namespace Trade {
 
+namespace {
+
+/* Encodes given rows into RLE packets. Packets don't cross row boundaries, as
+   recommended by the TGA 2.0 specification. Returns size of the output. */
+std::size_t encodeRle(const char* const in, const Vector2i& size, const std::size_t pixelSize, char* const out) {
+    const auto equal = [pixelSize](const char* a, const char* b) {
+        return std::equal(a, a + pixelSize, b);
+    };
+
+    char* o = out;
+    for(std::int_fast32_t y = 0; y != size.y(); ++y) {
+        const char* const rowEnd = in + (y + 1)*size.x()*pixelSize;
+        for(const char* i = in + y*size.x()*pixelSize; i != rowEnd; ) {
+            /* Run of repeated pixels */
+            std::size_t count = 1;
+            while(count != 128 && i + count*pixelSize != rowEnd && equal(i, i + count*pixelSize))
+                ++count;
+            if(count > 1) {
+                *o++ = char(0x80|(count - 1));
+                o = std::copy_n(i, pixelSize, o);
+                i += count*pixelSize;
+                continue;
+            }
+
+            /* Raw pixels up to the next run of at least two */
+            const char* rawEnd = i + pixelSize;
+            while(std::size_t(rawEnd - i) != 128*pixelSize && rawEnd != rowEnd && !(rawEnd + pixelSize != rowEnd && equal(rawEnd, rawEnd + pixelSize)))
+                rawEnd += pixelSize;
+            *o++ = char((rawEnd - i)/pixelSize - 1);
+            o = std::copy(i, rawEnd, o);
+            i = rawEnd;
+        }
+    }
+
+    return o - out;
+}
+
+/* Approximate size of the uncompressed pixel data processed at once */
+constexpr std::size_t BatchSize = 65536;
+
+}
+
 TgaImageConverter::TgaImageConverter() = default;
 
 TgaImageConverter::TgaImageConverter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractImageConverter{manager, plugin} {}
 
-auto TgaImageConverter::doFeatures() const -> Features { return Feature::ConvertData; }
+auto TgaImageConverter::doFeatures() const -> Features { return Feature::ConvertStream; }
 
-Containers::Array<char> TgaImageConverter::doExportToData(const ImageView2D& image) {
+bool TgaImageConverter::doExportToStream(const ImageView2D& image, const StreamWriter& writer) {
     if(image.format() != PixelFormat::RGB &&
        image.format() != PixelFormat::RGBA
        #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
@@ -56,25 +96,22 @@ Containers::Array<char> TgaImageConverter::doExportToData(const ImageView2D& ima
        #endif
        )
     {
-        Error() << "Trade::TgaImageConverter::exportToData(): unsupported color format" << image.format();
-        return nullptr;
+        Error() << "Trade::TgaImageConverter::exportToStream(): unsupported color format" << image.format();
+        return false;
     }
 
     if(image.type() != PixelType::UnsignedByte) {
-        Error() << "Trade::TgaImageConverter::exportToData(): unsupported color type" << image.type();
-        return nullptr;
+        Error() << "Trade::TgaImageConverter::exportToStream(): unsupported color type" << image.type();
+        return false;
     }
 
-    /* Initialize data buffer */
-    const auto pixelSize = UnsignedByte(image.pixelSize());
-    Containers::Array<char> data{Containers::ValueInit, sizeof(Implementation::TgaHeader) + pixelSize*image.size().product()};
-
     /* Fill header */
-    auto header = reinterpret_cast<Implementation::TgaHeader*>(data.begin());
+    const auto pixelSize = UnsignedByte(image.pixelSize());
+    Implementation::TgaHeader header{};
     switch(image.format()) {
         case PixelFormat::RGB:
         case PixelFormat::RGBA:
-            header->imageType = 2;
+            header.imageType = _rleCompression ? 10 : 2;
             break;
         #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
         case PixelFormat::Red:
@@ -82,36 +119,46 @@ Containers::Array<char> TgaImageConverter::doExportToData(const ImageView2D& ima
         #ifdef MAGNUM_TARGET_GLES2
         case PixelFormat::Luminance:
         #endif
-            header->imageType = 3;
+            header.imageType = _rleCompression ? 11 : 3;
             break;
         default: CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
     }
-    header->bpp = pixelSize*8;
-    header->width = UnsignedShort(Utility::Endianness::littleEndian(image.size().x()));
-    header->height = UnsignedShort(Utility::Endianness::littleEndian(image.size().y()));
+    header.bpp = pixelSize*8;
+    header.width = UnsignedShort(Utility::Endianness::littleEndian(image.size().x()));
+    header.height = UnsignedShort(Utility::Endianness::littleEndian(image.size().y()));
+    if(!writer({reinterpret_cast<const char*>(&header), sizeof(Implementation::TgaHeader)}))
+        return false;
 
     /* Image data pointer including skip */
     const char* imageData = image.data() + std::get<0>(image.dataProperties()).sum();
-
-    /* Fill data or copy them row by row if we need to drop the padding */
     const std::size_t rowSize = image.size().x()*pixelSize;
     const std::size_t rowStride = std::get<1>(image.dataProperties()).x();
-    if(rowStride != rowSize) {
-        for(std::int_fast32_t y = 0; y != image.size().y(); ++y)
-            std::copy_n(imageData + y*rowStride, rowSize, data.begin() + sizeof(Implementation::TgaHeader) + y*rowSize);
-    } else std::copy_n(imageData, pixelSize*image.size().product(), data.begin() + sizeof(Implementation::TgaHeader));
-
-    if(image.format() == PixelFormat::RGB) {
-        auto pixels = reinterpret_cast<Math::Vector3<UnsignedByte>*>(data.begin()+sizeof(Implementation::TgaHeader));
-        std::transform(pixels, pixels + image.size().product(), pixels,
-            [](Math::Vector3<UnsignedByte> pixel) { return Math::swizzle<'b', 'g', 'r'>(pixel); });
-    } else if(image.format() == PixelFormat::RGBA) {
-        auto pixels = reinterpret_cast<Math::Vector4<UnsignedByte>*>(data.begin()+sizeof(Implementation::TgaHeader));
-        std::transform(pixels, pixels + image.size().product(), pixels,
-            [](Math::Vector4<UnsignedByte> pixel) { return Math::swizzle<'b', 'g', 'r', 'a'>(pixel); });
+    if(!rowSize || !image.size().y()) return true;
+
+    /* Process the image in batches of rows so only a small buffer is needed
+       for the swizzled and encoded output. For RLE the buffer is big enough
+       for the worst case, a packet header for every pixel. */
+    const std::size_t batchRows = std::min(std::max(BatchSize/rowSize, std::size_t{1}), std::size_t(image.size().y()));
+    Containers::Array<char> pixels{rowSize*batchRows};
+    Containers::Array<char> encoded{_rleCompression ? (pixelSize + 1)*image.size().x()*batchRows : 0};
+    for(std::size_t y = 0; y < std::size_t(image.size().y()); y += batchRows) {
+        const std::size_t rows = std::min(batchRows, std::size_t(image.size().y()) - y);
+
+        /* Copy the rows, dropping the padding */
+        for(std::size_t i = 0; i != rows; ++i)
+            std::copy_n(imageData + (y + i)*rowStride, rowSize, pixels.begin() + i*rowSize);
+
+        /* Convert RGB(A) to BGR(A) */
+        if(image.format() == PixelFormat::RGB || image.format() == PixelFormat::RGBA)
+            swapRedBlueInPlace(pixels.prefix(rows*rowSize), pixelSize);
+
+        if(_rleCompression) {
+            const std::size_t encodedSize = encodeRle(pixels, {image.size().x(), Int(rows)}, pixelSize, encoded);
+            if(!writer(encoded.prefix(encodedSize))) return false;
+        } else if(!writer(pixels.prefix(rows*rowSize))) return false;
     }
 
-    return data;
+    return true;
 }
 
 }}
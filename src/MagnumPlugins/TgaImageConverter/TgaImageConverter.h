@@ -59,6 +59,13 @@ Creates Truevision TGA (`*.tga`) files from images with format
 @ref PixelFormat::Luminance in OpenGL ES 2.0 and WebGL 1.0) and type
 @ref PixelType::UnsignedByte.
 
+The converter supports @ref Trade::AbstractImageConverter::exportToStream().
+The image is swizzled and encoded in batches of rows and passed to the writer
+in chunks of roughly 64 kB, so neither
+@ref Trade::AbstractImageConverter::exportToStream() nor
+@ref Trade::AbstractImageConverter::exportToFile() need to have the whole
+encoded file in memory.
+
 This plugin depends on the @ref Trade library and is built if
 `WITH_TGAIMAGECONVERTER` is enabled when building Magnum. To use as a dynamic
 plugin, you need to load the @cpp "TgaImageConverter" @ce plugin from
@@ -67,6 +74,17 @@ dependency of another plugin with CMake, you need to request the
 `TgaImageConverter` component of the `Magnum` package and link to the
 `Magnum::TgaImageConverter` target. See @ref building, @ref cmake and
 @ref plugins for more information.
+
+@section Trade-TgaImageConverter-rle RLE compression
+
+The output is uncompressed by default. Call @ref setRleCompression() to
+produce RLE-compressed files instead, which are usually considerably smaller
+for images with large areas of the same color:
+
+@code{.cpp}
+std::unique_ptr<Trade::AbstractImageConverter> converter = manager.instantiate("TgaImageConverter");
+static_cast<Trade::TgaImageConverter&>(*converter).setRleCompression(true);
+@endcode
 */
 class MAGNUM_TGAIMAGECONVERTER_EXPORT TgaImageConverter: public AbstractImageConverter {
     public:
@@ -76,9 +94,30 @@ class MAGNUM_TGAIMAGECONVERTER_EXPORT TgaImageConverter: public AbstractImageCon
         /** @brief Plugin manager constructor */
         explicit TgaImageConverter(PluginManager::AbstractManager& manager, const std::string& plugin);
 
+        /**
+         * @brief Whether RLE compression is enabled
+         *
+         * @see @ref setRleCompression()
+         */
+        bool rleCompression() const { return _rleCompression; }
+
+        /**
+         * @brief Enable or disable RLE compression
+         * @return Reference to self (for method chaining)
+         *
+         * If enabled, the image is saved RLE-compressed, with packets not
+         * crossing row boundaries. Disabled by default.
+         */
+        TgaImageConverter& setRleCompression(bool enabled) {
+            _rleCompression = enabled;
+            return *this;
+        }
+
     private:
         Features MAGNUM_TGAIMAGECONVERTER_LOCAL doFeatures() const override;
-        Containers::Array<char> MAGNUM_TGAIMAGECONVERTER_LOCAL doExportToData(const ImageView2D& image) override;
+        bool MAGNUM_TGAIMAGECONVERTER_LOCAL doExportToStream(const ImageView2D& image, const StreamWriter& writer) override;
+
+        bool _rleCompression{};
 };
 
 }}
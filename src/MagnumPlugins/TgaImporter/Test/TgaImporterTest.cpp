@@ -24,7 +24,7 @@
 */
 
 #include <sstream>
-#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Containers/Array.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
 #include <Corrade/Utility/Directory.h>
@@ -41,6 +41,7 @@ struct TgaImporterTest: TestSuite::Tester {
     explicit TgaImporterTest();
 
     void openShort();
+    void openShortData();
     void paletted();
     void compressed();
 
@@ -50,15 +51,25 @@ struct TgaImporterTest: TestSuite::Tester {
 
     void grayscaleBits8();
     void grayscaleBits16();
+    void grayscaleMemory();
+
+    void rleColorBits24();
+    void rleColorBits32();
+    void rleGrayscale();
+    void rleTooShort();
 
     void useTwice();
 
+    void benchmarkColorBits24();
+    void benchmarkColorBits32();
+
     /* Explicitly forbid system-wide plugin dependencies */
     PluginManager::Manager<AbstractImporter> _manager{"nonexistent"};
 };
 
 TgaImporterTest::TgaImporterTest() {
     addTests({&TgaImporterTest::openShort,
+              &TgaImporterTest::openShortData,
               &TgaImporterTest::paletted,
               &TgaImporterTest::compressed,
 
@@ -68,9 +79,18 @@ TgaImporterTest::TgaImporterTest() {
 
               &TgaImporterTest::grayscaleBits8,
               &TgaImporterTest::grayscaleBits16,
+              &TgaImporterTest::grayscaleMemory,
+
+              &TgaImporterTest::rleColorBits24,
+              &TgaImporterTest::rleColorBits32,
+              &TgaImporterTest::rleGrayscale,
+              &TgaImporterTest::rleTooShort,
 
               &TgaImporterTest::useTwice});
 
+    addBenchmarks({&TgaImporterTest::benchmarkColorBits24,
+                   &TgaImporterTest::benchmarkColorBits32}, 3);
+
     /* Load the plugin directly from the build tree. Otherwise it's static and
        already loaded. */
     #ifdef TGAIMPORTER_PLUGIN_FILENAME
@@ -89,6 +109,22 @@ void TgaImporterTest::openShort() {
     CORRADE_COMPARE(debug.str(), "Trade::TgaImporter::image2D(): the file is too short: 17 bytes\n");
 }
 
+void TgaImporterTest::openShortData() {
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("TgaImporter");
+    const char data[] = {
+        0, 0, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 3, 0, 8, 0,
+        1, 2,
+        3, 4,
+        5
+    };
+    CORRADE_VERIFY(importer->openData(data));
+
+    std::ostringstream debug;
+    Error redirectError{&debug};
+    CORRADE_VERIFY(!importer->image2D(0));
+    CORRADE_COMPARE(debug.str(), "Trade::TgaImporter::image2D(): the file is too short: 23 bytes, expected 24\n");
+}
+
 void TgaImporterTest::paletted() {
     std::unique_ptr<AbstractImporter> importer = _manager.instantiate("TgaImporter");
     const char data[] = { 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
@@ -207,6 +243,121 @@ void TgaImporterTest::grayscaleBits16() {
     CORRADE_COMPARE(debug.str(), "Trade::TgaImporter::image2D(): unsupported grayscale bits-per-pixel: 16\n");
 }
 
+void TgaImporterTest::grayscaleMemory() {
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("TgaImporter");
+    const char data[] = {
+        0, 0, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 3, 0, 8, 0,
+        1, 2,
+        3, 4,
+        5, 6
+    };
+    CORRADE_VERIFY(importer->openMemory(data));
+
+    /* The data should reference the memory directly */
+    Containers::Optional<Trade::ImageData2D> image = importer->image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->size(), Vector2i(2, 3));
+    CORRADE_COMPARE(static_cast<const void*>(image->data().data()), static_cast<const void*>(data + 18));
+    CORRADE_COMPARE(image->data().size(), 6);
+
+    /* And stay valid after the importer is closed */
+    importer->close();
+    CORRADE_COMPARE_AS(image->data(), Containers::arrayView(data).suffix(18),
+        TestSuite::Compare::Container);
+}
+
+void TgaImporterTest::rleColorBits24() {
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("TgaImporter");
+    const char data[] = {
+        0, 0, 10, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 3, 0, 24, 0,
+        /* Run of three pixels, crossing the row boundary */
+        '\x82', 1, 2, 3,
+        /* Raw packet of three pixels */
+        '\x02', 3, 4, 5, 4, 5, 6, 5, 6, 7
+    };
+    const char pixels[] = {
+        3, 2, 1, 3, 2, 1,
+        3, 2, 1, 5, 4, 3,
+        6, 5, 4, 7, 6, 5
+    };
+    CORRADE_VERIFY(importer->openData(data));
+
+    Containers::Optional<Trade::ImageData2D> image = importer->image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->storage().alignment(), 1);
+    CORRADE_COMPARE(image->format(), PixelFormat::RGB);
+    CORRADE_COMPARE(image->size(), Vector2i(2, 3));
+    CORRADE_COMPARE(image->type(), PixelType::UnsignedByte);
+    CORRADE_COMPARE_AS(image->data(), Containers::arrayView(pixels),
+        TestSuite::Compare::Container);
+}
+
+void TgaImporterTest::rleColorBits32() {
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("TgaImporter");
+    const char data[] = {
+        0, 0, 10, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 3, 0, 32, 0,
+        '\x00', 1, 2, 3, 4,
+        /* The last run is longer than the image, it gets clipped */
+        '\x89', 5, 6, 7, 8
+    };
+    const char pixels[] = {
+        3, 2, 1, 4, 7, 6, 5, 8,
+        7, 6, 5, 8, 7, 6, 5, 8,
+        7, 6, 5, 8, 7, 6, 5, 8
+    };
+    CORRADE_VERIFY(importer->openData(data));
+
+    Containers::Optional<Trade::ImageData2D> image = importer->image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->storage().alignment(), 4);
+    CORRADE_COMPARE(image->format(), PixelFormat::RGBA);
+    CORRADE_COMPARE(image->size(), Vector2i(2, 3));
+    CORRADE_COMPARE(image->type(), PixelType::UnsignedByte);
+    CORRADE_COMPARE_AS(image->data(), Containers::arrayView(pixels),
+        TestSuite::Compare::Container);
+}
+
+void TgaImporterTest::rleGrayscale() {
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("TgaImporter");
+    const char data[] = {
+        0, 0, 11, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 3, 0, 8, 0,
+        '\x01', 1, 2,
+        '\x83', 3
+    };
+    const char pixels[] = {
+        1, 2,
+        3, 3,
+        3, 3
+    };
+    CORRADE_VERIFY(importer->openMemory(data));
+
+    Containers::Optional<Trade::ImageData2D> image = importer->image2D(0);
+    CORRADE_VERIFY(image);
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_COMPARE(image->format(), PixelFormat::Red);
+    #else
+    CORRADE_COMPARE(image->format(), PixelFormat::Luminance);
+    #endif
+    CORRADE_COMPARE(image->size(), Vector2i(2, 3));
+    CORRADE_COMPARE_AS(image->data(), Containers::arrayView(pixels),
+        TestSuite::Compare::Container);
+}
+
+void TgaImporterTest::rleTooShort() {
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("TgaImporter");
+    const char data[] = {
+        0, 0, 11, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 3, 0, 8, 0,
+        '\x01', 1, 2,
+        '\x02', 3, 4
+    };
+    CORRADE_VERIFY(importer->openData(data));
+
+    std::ostringstream debug;
+    Error redirectError{&debug};
+    CORRADE_VERIFY(!importer->image2D(0));
+    CORRADE_COMPARE(debug.str(), "Trade::TgaImporter::image2D(): the RLE data are too short\n");
+}
+
 void TgaImporterTest::useTwice() {
     std::unique_ptr<AbstractImporter> importer = _manager.instantiate("TgaImporter");
     CORRADE_VERIFY(importer->openFile(Utility::Directory::join(TGAIMPORTER_TEST_DIR, "file.tga")));
@@ -223,6 +374,56 @@ void TgaImporterTest::useTwice() {
     }
 }
 
+namespace {
+
+/* Uncompressed 8K image with given bits per pixel */
+Containers::Array<char> image8K(const char bitsPerPixel) {
+    const std::size_t dataSize = 7680*4320*bitsPerPixel/8;
+    Containers::Array<char> data{Containers::ValueInit, 18 + dataSize};
+    data[2] = 2;
+    data[12] = char(7680 & 0xff);
+    data[13] = char(7680 >> 8);
+    data[14] = char(4320 & 0xff);
+    data[15] = char(4320 >> 8);
+    data[16] = bitsPerPixel;
+    for(std::size_t i = 0; i != dataSize; ++i) data[18 + i] = char(i*7);
+    return data;
+}
+
+}
+
+void TgaImporterTest::benchmarkColorBits24() {
+    setTestCaseDescription("7680x4320, 99.5 MB");
+
+    const Containers::Array<char> data = image8K(24);
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("TgaImporter");
+    CORRADE_VERIFY(importer->openData(data));
+
+    Containers::Optional<Trade::ImageData2D> image;
+    CORRADE_BENCHMARK(1)
+        image = importer->image2D(0);
+
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->size(), (Vector2i{7680, 4320}));
+    CORRADE_COMPARE(image->format(), PixelFormat::RGB);
+}
+
+void TgaImporterTest::benchmarkColorBits32() {
+    setTestCaseDescription("7680x4320, 132.7 MB");
+
+    const Containers::Array<char> data = image8K(32);
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("TgaImporter");
+    CORRADE_VERIFY(importer->openData(data));
+
+    Containers::Optional<Trade::ImageData2D> image;
+    CORRADE_BENCHMARK(1)
+        image = importer->image2D(0);
+
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->size(), (Vector2i{7680, 4320}));
+    CORRADE_COMPARE(image->format(), PixelFormat::RGBA);
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Trade::Test::TgaImporterTest)
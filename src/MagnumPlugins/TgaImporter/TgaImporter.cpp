@@ -31,9 +31,9 @@
 #include <Corrade/Utility/Endianness.h>
 #include <Corrade/Containers/ArrayView.h>
 
+#include "Magnum/PixelConversion.h"
 #include "Magnum/PixelFormat.h"
-#include "Magnum/Math/Swizzle.h"
-#include "Magnum/Math/Vector4.h"
+#include "Magnum/Math/Vector2.h"
 #include "Magnum/Trade/ImageData.h"
 #include "MagnumPlugins/TgaImporter/TgaHeader.h"
 
@@ -50,15 +50,23 @@ TgaImporter::TgaImporter(PluginManager::AbstractManager& manager, const std::str
 
 TgaImporter::~TgaImporter() = default;
 
-auto TgaImporter::doFeatures() const -> Features { return Feature::OpenData; }
+auto TgaImporter::doFeatures() const -> Features { return Feature::OpenMemory; }
 
-bool TgaImporter::doIsOpened() const { return _in; }
+bool TgaImporter::doIsOpened() const { return _in.data(); }
 
-void TgaImporter::doClose() { _in = nullptr; }
+void TgaImporter::doClose() {
+    _in = nullptr;
+    _data = nullptr;
+}
 
 void TgaImporter::doOpenData(const Containers::ArrayView<const char> data) {
-    _in = Containers::Array<char>{data.size()};
-    std::copy(data.begin(), data.end(), _in.begin());
+    _data = Containers::Array<char>{data.size()};
+    std::copy(data.begin(), data.end(), _data.begin());
+    _in = _data;
+}
+
+void TgaImporter::doOpenMemory(const Containers::ArrayView<const char> memory) {
+    _in = memory;
 }
 
 UnsignedInt TgaImporter::doImage2DCount() const { return 1; }
@@ -84,7 +92,7 @@ Containers::Optional<ImageData2D> TgaImporter::doImage2D(UnsignedInt) {
     }
 
     /* Color */
-    if(header.imageType == 2) {
+    if(header.imageType == 2 || header.imageType == 10) {
         switch(header.bpp) {
             case 24:
                 format = PixelFormat::RGB;
@@ -98,7 +106,7 @@ Containers::Optional<ImageData2D> TgaImporter::doImage2D(UnsignedInt) {
         }
 
     /* Grayscale */
-    } else if(header.imageType == 3) {
+    } else if(header.imageType == 3 || header.imageType == 11) {
         #if defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
         format = Context::hasCurrent() && Context::current().isExtensionSupported<Extensions::GL::EXT::texture_rg>() ?
             PixelFormat::Red : PixelFormat::Luminance;
@@ -118,23 +126,74 @@ Containers::Optional<ImageData2D> TgaImporter::doImage2D(UnsignedInt) {
         return Containers::NullOpt;
     }
 
-    Containers::Array<char> data{std::size_t(size.product())*header.bpp/8};
-    std::copy_n(_in + sizeof(Implementation::TgaHeader), data.size(), data.begin());
+    const std::size_t pixelSize = header.bpp/8;
+    const std::size_t dataSize = std::size_t(size.product())*pixelSize;
+    Containers::Array<char> data;
+
+    /* RLE-compressed data. Packets are allowed to cross row boundaries, the
+       last one is clipped to the image size. */
+    if(header.imageType & 8) {
+        data = Containers::Array<char>{dataSize};
+        const char* in = _in.begin() + sizeof(Implementation::TgaHeader);
+        for(std::size_t out = 0; out != dataSize; ) {
+            if(in == _in.end()) {
+                Error() << "Trade::TgaImporter::image2D(): the RLE data are too short";
+                return Containers::NullOpt;
+            }
+
+            const UnsignedByte packet = *in++;
+            const std::size_t count = std::min((std::size_t(packet & 0x7f) + 1)*pixelSize, dataSize - out);
+
+            /* Run-length packet, a single pixel repeated */
+            if(packet & 0x80) {
+                if(std::size_t(_in.end() - in) < pixelSize) {
+                    Error() << "Trade::TgaImporter::image2D(): the RLE data are too short";
+                    return Containers::NullOpt;
+                }
+
+                for(std::size_t i = 0; i != count; i += pixelSize)
+                    std::copy_n(in, pixelSize, data.begin() + out + i);
+                in += pixelSize;
+
+            /* Raw packet */
+            } else {
+                if(std::size_t(_in.end() - in) < count) {
+                    Error() << "Trade::TgaImporter::image2D(): the RLE data are too short";
+                    return Containers::NullOpt;
+                }
+
+                std::copy_n(in, count, data.begin() + out);
+                in += count;
+            }
+
+            out += count;
+        }
+
+    /* Check that the uncompressed pixel data are complete */
+    } else if(_in.size() < sizeof(Implementation::TgaHeader) + dataSize) {
+        Error() << "Trade::TgaImporter::image2D(): the file is too short:" << _in.size() << "bytes, expected" << sizeof(Implementation::TgaHeader) + dataSize;
+        return Containers::NullOpt;
+
+    /* Uncompressed grayscale data need no conversion, so if the memory was
+       passed by the user, reference it directly instead of making a copy */
+    } else {
+        const Containers::ArrayView<const char> pixelData = _in.slice(sizeof(Implementation::TgaHeader), sizeof(Implementation::TgaHeader) + dataSize);
+        if(header.imageType == 3 && !_data && !isFileMapped())
+            data = nonOwnedArray(pixelData);
+        else {
+            data = Containers::Array<char>{dataSize};
+            std::copy(pixelData.begin(), pixelData.end(), data.begin());
+        }
+    }
 
     /* Adjust pixel storage if row size is not four byte aligned */
     PixelStorage storage;
     if((size.x()*header.bpp/8)%4 != 0)
         storage.setAlignment(1);
 
-    if(format == PixelFormat::RGB) {
-        auto pixels = reinterpret_cast<Math::Vector3<UnsignedByte>*>(data.data());
-        std::transform(pixels, pixels + size.product(), pixels,
-            [](Math::Vector3<UnsignedByte> pixel) { return Math::swizzle<'b', 'g', 'r'>(pixel); });
-    } else if(format == PixelFormat::RGBA) {
-        auto pixels = reinterpret_cast<Math::Vector4<UnsignedByte>*>(data.data());
-        std::transform(pixels, pixels + size.product(), pixels,
-            [](Math::Vector4<UnsignedByte> pixel) { return Math::swizzle<'b', 'g', 'r', 'a'>(pixel); });
-    }
+    /* Convert BGR(A) to RGB(A) */
+    if(format == PixelFormat::RGB || format == PixelFormat::RGBA)
+        swapRedBlueInPlace(data, pixelSize);
 
     return ImageData2D{storage, format, PixelType::UnsignedByte, size, std::move(data)};
 }
@@ -142,4 +201,4 @@ Containers::Optional<ImageData2D> TgaImporter::doImage2D(UnsignedInt) {
 }}
 
 CORRADE_PLUGIN_REGISTER(TgaImporter, Magnum::Trade::TgaImporter,
-    "cz.mosra.magnum.Trade.AbstractImporter/0.3")
+    "cz.mosra.magnum.Trade.AbstractImporter/0.3.1")
@@ -57,8 +57,8 @@ namespace Magnum { namespace Trade {
 /**
 @brief TGA importer plugin
 
-Supports Truevision TGA (`*.tga`, `*.vda`, `*.icb`, `*.vst`) uncompressed BGR,
-BGRA or grayscale images with 8 bits per channel.
+Supports Truevision TGA (`*.tga`, `*.vda`, `*.icb`, `*.vst`) uncompressed or
+RLE-compressed BGR, BGRA or grayscale images with 8 bits per channel.
 
 This plugin depends on the @ref Trade library and is built if `WITH_TGAIMPORTER`
 is enabled when building Magnum. To use as a dynamic plugin, you need to load
@@ -77,6 +77,15 @@ if the data require it.
 In OpenGL ES 2.0, if @extension{EXT,texture_rg} is not supported and in
 WebGL 1.0, grayscale images use @ref PixelFormat::Luminance instead of
 @ref PixelFormat::Red.
+
+The plugin supports @ref Feature::OpenMemory, files opened with
+@ref openFile() are memory-mapped and the pixel data are copied directly from
+the mapping. Uncompressed grayscale images from memory passed to @ref openMemory() need no
+conversion and so they aren't copied at all --- the returned image data
+reference the memory directly and stay valid as long as the memory does, even
+after the importer is closed. Color images are always copied, as the pixel
+data need to be converted from BGR(A) to RGB(A), RLE-compressed images are
+decoded into a newly allocated array.
 */
 class MAGNUM_TGAIMPORTER_EXPORT TgaImporter: public AbstractImporter {
     public:
@@ -92,11 +101,13 @@ class MAGNUM_TGAIMPORTER_EXPORT TgaImporter: public AbstractImporter {
         Features MAGNUM_TGAIMPORTER_LOCAL doFeatures() const override;
         bool MAGNUM_TGAIMPORTER_LOCAL doIsOpened() const override;
         void MAGNUM_TGAIMPORTER_LOCAL doOpenData(Containers::ArrayView<const char> data) override;
+        void MAGNUM_TGAIMPORTER_LOCAL doOpenMemory(Containers::ArrayView<const char> memory) override;
         void MAGNUM_TGAIMPORTER_LOCAL doClose() override;
         UnsignedInt MAGNUM_TGAIMPORTER_LOCAL doImage2DCount() const override;
         Containers::Optional<ImageData2D> MAGNUM_TGAIMPORTER_LOCAL doImage2D(UnsignedInt id) override;
 
-        Containers::Array<char> _in;
+        Containers::Array<char> _data;
+        Containers::ArrayView<const char> _in;
 };
 
 }}
@@ -24,11 +24,13 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <cstring>
 #include <sstream>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
 #include <Corrade/Utility/Directory.h>
+#include <Corrade/Utility/Endianness.h>
 
 #include "Magnum/Audio/AbstractImporter.h"
 
@@ -72,6 +74,11 @@ struct WavImporterTest: TestSuite::Tester {
     void surround51Channel16();
     void surround71Channel24();
 
+    void readFrames();
+    void openMemory();
+
+    void benchmarkStereo16();
+
     /* Explicitly forbid system-wide plugin dependencies */
     PluginManager::Manager<AbstractImporter> _manager{"nonexistent"};
 };
@@ -108,7 +115,12 @@ WavImporterTest::WavImporterTest() {
               &WavImporterTest::stereo64f,
 
               &WavImporterTest::surround51Channel16,
-              &WavImporterTest::surround71Channel24});
+              &WavImporterTest::surround71Channel24,
+
+              &WavImporterTest::readFrames,
+              &WavImporterTest::openMemory});
+
+    addBenchmarks({&WavImporterTest::benchmarkStereo16}, 3);
 
     /* Load the plugin directly from the build tree. Otherwise it's static and
        already loaded. */
@@ -421,6 +433,79 @@ void WavImporterTest::surround71Channel24() {
     CORRADE_COMPARE(out.str(), "Audio::WavImporter::openData(): unsupported format Audio::WavAudioFormat::Extensible\n");
 }
 
+namespace {
+
+template<class T> void write(char*& out, T value) {
+    value = Utility::Endianness::littleEndian(value);
+    std::memcpy(out, &value, sizeof(T));
+    out += sizeof(T);
+}
+
+}
+
+void WavImporterTest::readFrames() {
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(WAVAUDIOIMPORTER_TEST_DIR, "mono8.wav")));
+
+    CORRADE_COMPARE(importer->frameSize(), 1);
+    CORRADE_COMPARE(importer->frameCount(), 2136);
+
+    CORRADE_COMPARE_AS(importer->readFrames(0, 4),
+        (Containers::Array<char>{Containers::InPlaceInit, {127, 127, 127, 127}}),
+        TestSuite::Compare::Container<Containers::ArrayView<const char>>);
+
+    /* The range is clamped at the end */
+    const Containers::Array<char> data = importer->data();
+    CORRADE_COMPARE_AS(importer->readFrames(2130, 100),
+        data.suffix(2130),
+        TestSuite::Compare::Container<Containers::ArrayView<const char>>);
+    CORRADE_COMPARE(importer->readFrames(2136, 100).size(), 0);
+}
+
+void WavImporterTest::openMemory() {
+    const Containers::Array<char> file = Utility::Directory::read(Utility::Directory::join(WAVAUDIOIMPORTER_TEST_DIR, "stereo16.wav"));
+
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
+    CORRADE_VERIFY(importer->openMemory(file));
+
+    CORRADE_COMPARE(importer->format(), Buffer::Format::Stereo16);
+    CORRADE_COMPARE(importer->frameSize(), 4);
+    CORRADE_COMPARE(importer->frameCount(), 1);
+    CORRADE_COMPARE_AS(importer->readFrames(0, 1),
+        (Containers::Array<char>{Containers::InPlaceInit, {39, 79, 39, 79}}),
+        TestSuite::Compare::Container<Containers::ArrayView<const char>>);
+}
+
+void WavImporterTest::benchmarkStereo16() {
+    /* Five minutes of 48 kHz 16-bit stereo, 57.6 MB */
+    constexpr UnsignedInt frequency = 48000;
+    constexpr UnsignedInt dataSize = 5*60*frequency*4;
+    setTestCaseDescription("57.6 MB");
+
+    Containers::Array<char> file{44 + dataSize};
+    char* out = file.data();
+    std::memcpy(out, "RIFF", 4); out += 4;
+    write<UnsignedInt>(out, 36 + dataSize);
+    std::memcpy(out, "WAVEfmt ", 8); out += 8;
+    write<UnsignedInt>(out, 16);
+    write<UnsignedShort>(out, 1);
+    write<UnsignedShort>(out, 2);
+    write<UnsignedInt>(out, frequency);
+    write<UnsignedInt>(out, frequency*4);
+    write<UnsignedShort>(out, 4);
+    write<UnsignedShort>(out, 16);
+    std::memcpy(out, "data", 4); out += 4;
+    write<UnsignedInt>(out, dataSize);
+    for(std::size_t i = 0; i != dataSize; ++i) out[i] = char(i*7);
+
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
+    CORRADE_BENCHMARK(1)
+        CORRADE_VERIFY(importer->openData(file));
+
+    CORRADE_COMPARE(importer->format(), Buffer::Format::Stereo16);
+    CORRADE_COMPARE(importer->data().size(), dataSize);
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Audio::Test::WavImporterTest)
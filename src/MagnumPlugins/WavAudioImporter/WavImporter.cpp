@@ -43,11 +43,21 @@ WavImporter::WavImporter() = default;
 
 WavImporter::WavImporter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractImporter{manager, plugin} {}
 
-auto WavImporter::doFeatures() const -> Features { return Feature::OpenData; }
+auto WavImporter::doFeatures() const -> Features { return Feature::OpenMemory; }
 
-bool WavImporter::doIsOpened() const { return _data; }
+bool WavImporter::doIsOpened() const { return _samples.data(); }
 
 void WavImporter::doOpenData(Containers::ArrayView<const char> data) {
+    /* Keep only the sample data */
+    doOpenMemory(data);
+    if(!_samples) return;
+
+    _data = Containers::Array<char>(_samples.size());
+    std::copy(_samples.begin(), _samples.end(), _data.begin());
+    _samples = _data;
+}
+
+void WavImporter::doOpenMemory(Containers::ArrayView<const char> data) {
     /* Check file size */
     if(data.size() < sizeof(WavHeaderChunk) + sizeof(WavFormatChunk) + sizeof(RiffChunk)) {
         Error() << "Audio::WavImporter::openData(): the file is too short:" << data.size() << "bytes";
@@ -210,26 +220,36 @@ void WavImporter::doOpenData(Containers::ArrayView<const char> data) {
     /** @todo Convert the data from little endian too */
     CORRADE_INTERNAL_ASSERT(!Utility::Endianness::isBigEndian());
 
-    /* Copy the data */
-    const char* dataChunkPtr = reinterpret_cast<const char*>(dataChunk + 1);
-    _data = Containers::Array<char>(dataChunkSize);
-    std::copy(dataChunkPtr, dataChunkPtr+dataChunkSize, _data.begin());
-    return;
+    /* Reference the data, the samples are decoded on access */
+    _samples = {reinterpret_cast<const char*>(dataChunk + 1), dataChunkSize};
+    _frameSize = formatChunk->blockAlign;
 }
 
-void WavImporter::doClose() { _data = nullptr; }
+void WavImporter::doClose() {
+    _samples = nullptr;
+    _data = nullptr;
+}
 
 Buffer::Format WavImporter::doFormat() const { return _format; }
 
 UnsignedInt WavImporter::doFrequency() const { return _frequency; }
 
 Containers::Array<char> WavImporter::doData() {
-    Containers::Array<char> copy(_data.size());
-    std::copy(_data.begin(), _data.end(), copy.begin());
+    Containers::Array<char> copy(_samples.size());
+    std::copy(_samples.begin(), _samples.end(), copy.begin());
+    return copy;
+}
+
+std::size_t WavImporter::doFrameCount() { return _samples.size()/_frameSize; }
+
+Containers::Array<char> WavImporter::doReadFrames(const std::size_t offset, const std::size_t count) {
+    const Containers::ArrayView<const char> frames = _samples.slice(offset*_frameSize, (offset + count)*_frameSize);
+    Containers::Array<char> copy(frames.size());
+    std::copy(frames.begin(), frames.end(), copy.begin());
     return copy;
 }
 
 }}
 
 CORRADE_PLUGIN_REGISTER(WavAudioImporter, Magnum::Audio::WavImporter,
-    "cz.mosra.magnum.Audio.AbstractImporter/0.1")
+    "cz.mosra.magnum.Audio.AbstractImporter/0.2")
@@ -76,6 +76,12 @@ a dependency of another plugin with CMake, you need to request the
 
 @section Audio-WavImporter-limitations Behavior and limitations
 
+The plugin supports @ref Feature::OpenMemory. Files opened with
+@ref openFile() are memory-mapped and @ref readFrames() copies just the
+requested range out of the mapping, so long files can be streamed from disk
+without having them whole in memory. Data passed to @ref openData() are
+validated and only the sample data are kept.
+
 Multi-channel formats are not supported.
 */
 class MAGNUM_WAVAUDIOIMPORTER_EXPORT WavImporter: public AbstractImporter {
@@ -90,13 +96,18 @@ class MAGNUM_WAVAUDIOIMPORTER_EXPORT WavImporter: public AbstractImporter {
         MAGNUM_WAVAUDIOIMPORTER_LOCAL Features doFeatures() const override;
         MAGNUM_WAVAUDIOIMPORTER_LOCAL bool doIsOpened() const override;
         MAGNUM_WAVAUDIOIMPORTER_LOCAL void doOpenData(Containers::ArrayView<const char> data) override;
+        MAGNUM_WAVAUDIOIMPORTER_LOCAL void doOpenMemory(Containers::ArrayView<const char> data) override;
         MAGNUM_WAVAUDIOIMPORTER_LOCAL void doClose() override;
 
         MAGNUM_WAVAUDIOIMPORTER_LOCAL Buffer::Format doFormat() const override;
         MAGNUM_WAVAUDIOIMPORTER_LOCAL UnsignedInt doFrequency() const override;
         MAGNUM_WAVAUDIOIMPORTER_LOCAL Containers::Array<char> doData() override;
+        MAGNUM_WAVAUDIOIMPORTER_LOCAL std::size_t doFrameCount() override;
+        MAGNUM_WAVAUDIOIMPORTER_LOCAL Containers::Array<char> doReadFrames(std::size_t offset, std::size_t count) override;
 
         Containers::Array<char> _data;
+        Containers::ArrayView<const char> _samples;
+        UnsignedInt _frameSize;
         Buffer::Format _format;
         UnsignedInt _frequency;
 };